@@ -0,0 +1,592 @@
+#include "GpuParticleSystem.h"
+#include "oflike/3d/VboMesh.h"
+#include "oflike/3d/ofCamera.h"
+#include "oflike/graphics/ofBufferObject.h"
+#include "oflike/graphics/ofComputeShader.h"
+#include "oflike/graphics/ofGraphics.h"
+#include "oflike/utils/ofLog.h"
+#include "oflike/utils/ofUtils.h"
+#include "render/IRenderer.h"
+#include <simd/simd.h>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+using namespace oflike;
+
+namespace GpuParticles {
+
+namespace {
+
+// ============================================================================
+// GPU Layouts (match GpuParticles.metal)
+// ============================================================================
+
+constexpr size_t kParticleStride = 64;          // sizeof(GpuParticle)
+constexpr size_t kSortKeyStride = 8;            // sizeof(ParticleSortKey)
+constexpr uint32_t kSortWindow = 1024;          // PARTICLE_SORT_WINDOW
+constexpr uint32_t kForceTableCount = render::kMaxFramesInFlight;  // One per frame in flight
+constexpr float kMaxStep = 1.0f / 15.0f;
+
+struct EmitParams {
+    simd_float4 position;
+    simd_float4 direction;
+    simd_float4 startColor;
+    simd_float4 endColor;
+    simd_float2 speed;
+    simd_float2 lifetime;
+    simd_float2 size;
+    uint32_t first;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t seed;
+};
+
+struct UpdateParams {
+    simd_float4 gravity;
+    simd_float4 noise;
+    float deltaTime;
+    uint32_t count;
+    uint32_t attractorCount;
+    uint32_t planeCount;
+};
+
+struct ForceTable {
+    struct {
+        simd_float4 positionStrength;
+        simd_float4 radius;
+    } attractors[ParticleSystem::kMaxAttractors];
+    struct {
+        simd_float4 plane;
+        simd_float4 response;
+    } planes[ParticleSystem::kMaxCollisionPlanes];
+};
+
+struct InstanceParams {
+    simd_float4 cameraRight;
+    simd_float4 cameraUp;
+    simd_float4 cameraPosition;
+    simd_float4 cameraForward;
+    uint32_t count;
+    uint32_t billboard;
+    uint32_t keyCount;
+    uint32_t padding;
+};
+
+struct SortParams {
+    uint32_t count;
+    uint32_t stage;
+    uint32_t step;
+    uint32_t padding;
+};
+
+static_assert(sizeof(EmitParams) <= ofComputeShader::kMaxConstantsSize, "EmitParams must fit the constants");
+static_assert(sizeof(InstanceParams) <= ofComputeShader::kMaxConstantsSize, "InstanceParams must fit the constants");
+
+simd_float4 toFloat4(const ofVec3f& v, float w) {
+    return simd_make_float4(v.x, v.y, v.z, w);
+}
+
+simd_float4 toFloat4(const ofFloatColor& c) {
+    return simd_make_float4(c.r, c.g, c.b, c.a);
+}
+
+uint32_t nextPowerOfTwo(uint32_t v) {
+    uint32_t p = 1;
+    while (p < v) {
+        p <<= 1;
+    }
+    return p;
+}
+
+} // namespace
+
+// ============================================================================
+// Implementation (pImpl pattern)
+// ============================================================================
+
+struct ParticleSystem::Impl {
+    size_t capacity = 0;
+    uint32_t keyCount = 0;              // Sort keys: a power of two of at least kSortWindow
+
+    ofBufferObject particles;
+    ofBufferObject instances;
+    ofBufferObject arguments;
+    ofBufferObject sortKeys;            // Allocated by the first sorted draw
+    ofBufferObject forceTables[kForceTableCount];
+
+    ofComputeShader clearKernel;
+    ofComputeShader emitKernel;
+    ofComputeShader updateKernel;
+    ofComputeShader resetArgumentsKernel;
+    ofComputeShader writeInstancesKernel;
+    ofComputeShader writeSortKeysKernel;
+    ofComputeShader writeSortedInstancesKernel;
+    ofComputeShader sortStepKernel;
+    ofComputeShader sortLocalKernel;
+
+    VboMesh mesh;
+    bool billboard = true;
+    BlendMode blendMode = BlendMode::Additive;
+
+    std::vector<Emitter> emitters;
+    std::vector<float> emitRemainders;  // Fractional particles carried to the next update
+    std::vector<std::pair<Emitter, size_t>> bursts;
+    std::vector<Attractor> attractors;
+    std::vector<CollisionPlane> planes;
+
+    ofVec3f gravity = ofVec3f(0, 0, 0);
+    float drag = 0.0f;
+    float noiseFrequency = 0.0f;
+    float noiseStrength = 0.0f;
+    float noiseSpeed = 0.0f;
+    float noiseTime = 0.0f;
+
+    bool needsClear = false;            // Cleared by the next recorded frame
+    size_t emitHead = 0;                // Next ring slot
+    uint32_t emitCount = 0;             // Seeds each emission differently
+    float lastUpdateTime = -1.0f;
+
+    bool loadKernels() {
+        struct Entry { ofComputeShader* shader; const char* name; };
+        const Entry entries[] = {
+            {&clearKernel, "clearParticles"},
+            {&emitKernel, "emitParticles"},
+            {&updateKernel, "updateParticles"},
+            {&resetArgumentsKernel, "resetParticleArguments"},
+            {&writeInstancesKernel, "writeParticleInstances"},
+            {&writeSortKeysKernel, "writeParticleSortKeys"},
+            {&writeSortedInstancesKernel, "writeSortedParticleInstances"},
+            {&sortStepKernel, "sortParticlesStep"},
+            {&sortLocalKernel, "sortParticlesLocal"},
+        };
+        for (const Entry& entry : entries) {
+            if (!entry.shader->isLoaded() && !entry.shader->load("GpuParticles", entry.name)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool allocate(size_t count) {
+        capacity = count;
+        keyCount = nextPowerOfTwo(std::max<uint32_t>(static_cast<uint32_t>(count), kSortWindow));
+        sortKeys.clear();
+
+        if (!particles.allocate(count * kParticleStride, OF_BUFFER_GPU_ONLY) ||
+            !instances.allocate(count * sizeof(VboInstanceData), OF_BUFFER_GPU_ONLY) ||
+            !arguments.allocate(sizeof(VboIndirectArguments), OF_BUFFER_GPU_ONLY)) {
+            return false;
+        }
+        for (ofBufferObject& table : forceTables) {
+            if (!table.allocate(sizeof(ForceTable), OF_BUFFER_SHARED)) {
+                return false;
+            }
+        }
+
+        updateKernel.setBuffer(0, particles);
+        writeInstancesKernel.setBuffer(0, particles);
+        writeInstancesKernel.setBuffer(1, instances);
+        writeInstancesKernel.setBuffer(2, arguments);
+        writeSortKeysKernel.setBuffer(0, particles);
+        writeSortKeysKernel.setBuffer(2, arguments);
+        writeSortedInstancesKernel.setBuffer(0, particles);
+        writeSortedInstancesKernel.setBuffer(1, instances);
+        resetArgumentsKernel.setBuffer(0, arguments);
+        clearKernel.setBuffer(0, particles);
+        emitKernel.setBuffer(0, particles);
+
+        clear();
+        return true;
+    }
+
+    // Private buffers start undefined; setup() may run before a frame records
+    void clear() {
+        needsClear = true;
+        emitHead = 0;
+        std::fill(emitRemainders.begin(), emitRemainders.end(), 0.0f);
+    }
+
+    void clearIfNeeded() {
+        if (!needsClear) {
+            return;
+        }
+        const uint32_t count = static_cast<uint32_t>(capacity);
+        clearKernel.setConstants(count);
+        needsClear = !clearKernel.dispatch(count);
+    }
+
+    bool ensureSortKeys() {
+        if (sortKeys.isAllocated()) {
+            return true;
+        }
+        if (!sortKeys.allocate(static_cast<size_t>(keyCount) * kSortKeyStride, OF_BUFFER_GPU_ONLY)) {
+            return false;
+        }
+        writeSortKeysKernel.setBuffer(1, sortKeys);
+        writeSortedInstancesKernel.setBuffer(2, sortKeys);
+        sortStepKernel.setBuffer(0, sortKeys);
+        sortLocalKernel.setBuffer(0, sortKeys);
+        sortLocalKernel.setThreadgroupSize(kSortWindow / 2);
+        return true;
+    }
+
+    // ========================================================================
+    // Simulation
+    // ========================================================================
+
+    void emit(const Emitter& emitter, size_t count) {
+        count = std::min(count, capacity);
+        if (count == 0) {
+            return;
+        }
+
+        ofVec3f direction = emitter.direction.lengthSquared() > 0.0f ? emitter.direction.getNormalized()
+                                                                     : ofVec3f(0, 1, 0);
+        EmitParams params;
+        params.position = toFloat4(emitter.position, std::max(emitter.radius, 0.0f));
+        params.direction = toFloat4(direction, std::clamp(emitter.spread, 0.0f, static_cast<float>(M_PI)));
+        params.startColor = toFloat4(emitter.startColor);
+        params.endColor = toFloat4(emitter.endColor);
+        params.speed = simd_make_float2(emitter.speedMin, emitter.speedMax);
+        params.lifetime = simd_make_float2(emitter.lifetimeMin, emitter.lifetimeMax);
+        params.size = simd_make_float2(emitter.startSize, emitter.endSize);
+        params.first = static_cast<uint32_t>(emitHead);
+        params.count = static_cast<uint32_t>(count);
+        params.capacity = static_cast<uint32_t>(capacity);
+        params.seed = ++emitCount * 0x9E3779B9u;
+        emitKernel.setConstants(params);
+        emitKernel.dispatch(params.count);
+
+        emitHead = (emitHead + count) % capacity;
+    }
+
+    void step(float dt) {
+        clearIfNeeded();
+        for (size_t i = 0; i < emitters.size(); i++) {
+            const Emitter& emitter = emitters[i];
+            if (!emitter.enabled || emitter.rate <= 0.0f) {
+                continue;
+            }
+            const float due = emitRemainders[i] + emitter.rate * dt;
+            const float whole = std::floor(due);
+            emitRemainders[i] = due - whole;
+            emit(emitter, static_cast<size_t>(whole));
+        }
+        for (const auto& burst : bursts) {
+            emit(burst.first, burst.second);
+        }
+        bursts.clear();
+
+        // CPU writes go to a table the GPU finished reading frames ago
+        ForceTable table = {};
+        for (size_t i = 0; i < attractors.size(); i++) {
+            table.attractors[i].positionStrength = toFloat4(attractors[i].position, attractors[i].strength);
+            table.attractors[i].radius = simd_make_float4(std::max(attractors[i].radius, 1e-4f), 0, 0, 0);
+        }
+        for (size_t i = 0; i < planes.size(); i++) {
+            const ofVec3f normal = planes[i].normal.getNormalized();
+            table.planes[i].plane = toFloat4(normal, planes[i].offset);
+            table.planes[i].response = simd_make_float4(planes[i].bounce, planes[i].friction, 0, 0);
+        }
+        ofBufferObject& forces = forceTables[ofGetFrameNum() % kForceTableCount];
+        forces.updateData(0, sizeof(table), &table);
+
+        noiseTime += noiseSpeed * dt;
+
+        UpdateParams params;
+        params.gravity = toFloat4(gravity, std::max(drag, 0.0f));
+        params.noise = simd_make_float4(noiseFrequency, noiseStrength, noiseTime, 0);
+        params.deltaTime = dt;
+        params.count = static_cast<uint32_t>(capacity);
+        params.attractorCount = static_cast<uint32_t>(attractors.size());
+        params.planeCount = static_cast<uint32_t>(planes.size());
+        updateKernel.setBuffer(1, forces);
+        updateKernel.setConstants(params);
+        updateKernel.dispatch(params.count);
+    }
+
+    // ========================================================================
+    // Instances
+    // ========================================================================
+
+    void sortKeysByDepth() {
+        SortParams params = {keyCount, 0, 0, 0};
+        sortLocalKernel.setConstants(params);
+        sortLocalKernel.dispatch(keyCount / 2);
+
+        // Longer stages: global steps down to the window, then the rest locally
+        for (uint32_t stage = kSortWindow * 2; stage <= keyCount; stage <<= 1) {
+            for (uint32_t step = stage / 2; step >= kSortWindow; step >>= 1) {
+                params.stage = stage;
+                params.step = step;
+                sortStepKernel.setConstants(params);
+                sortStepKernel.dispatch(keyCount / 2);
+            }
+            params.stage = stage;
+            params.step = 0;
+            sortLocalKernel.setConstants(params);
+            sortLocalKernel.dispatch(keyCount / 2);
+        }
+    }
+
+    bool writeInstances(const ofCamera& camera) {
+        clearIfNeeded();
+        const uint32_t indexCount = static_cast<uint32_t>(mesh.getNumIndices());
+        resetArgumentsKernel.setConstants(indexCount);
+        resetArgumentsKernel.dispatch(1);
+
+        InstanceParams params;
+        params.cameraRight = toFloat4(camera.getRightDir(), 0);
+        params.cameraUp = toFloat4(camera.getUpDir(), 0);
+        params.cameraPosition = toFloat4(camera.getPosition(), 1);
+        params.cameraForward = toFloat4(camera.getForwardDir(), 0);
+        params.count = static_cast<uint32_t>(capacity);
+        params.billboard = billboard ? 1 : 0;
+        params.keyCount = keyCount;
+        params.padding = 0;
+
+        if (blendMode == BlendMode::Additive) {
+            writeInstancesKernel.setConstants(params);
+            return writeInstancesKernel.dispatch(params.count);
+        }
+
+        if (!ensureSortKeys()) {
+            return false;
+        }
+        writeSortKeysKernel.setConstants(params);
+        writeSortKeysKernel.dispatch(keyCount);
+        sortKeysByDepth();
+        writeSortedInstancesKernel.setConstants(params);
+        return writeSortedInstancesKernel.dispatch(params.count);
+    }
+};
+
+// ============================================================================
+// Constructors / Destructor
+// ============================================================================
+
+ParticleSystem::ParticleSystem()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ParticleSystem::~ParticleSystem() = default;
+
+ParticleSystem::ParticleSystem(ParticleSystem&& other) noexcept = default;
+ParticleSystem& ParticleSystem::operator=(ParticleSystem&& other) noexcept = default;
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+bool ParticleSystem::setup(size_t capacity) {
+    if (capacity == 0 || capacity > UINT32_MAX / 2) {
+        ofLogError("GpuParticles") << "Capacity must be between 1 and " << UINT32_MAX / 2;
+        return false;
+    }
+    if (!impl_->loadKernels()) {
+        ofLogError("GpuParticles") << "Could not load the particle kernels (GpuParticles.metal)";
+        return false;
+    }
+    if (!impl_->mesh.isAllocated()) {
+        impl_->mesh = VboMesh::createPlane(1.0f, 1.0f);
+        impl_->mesh.setDepthTest(true);
+    }
+    if (!impl_->allocate(capacity)) {
+        ofLogError("GpuParticles") << "Could not allocate buffers for " << capacity << " particles";
+        impl_->capacity = 0;
+        return false;
+    }
+    return true;
+}
+
+bool ParticleSystem::isSetup() const {
+    return impl_->capacity > 0;
+}
+
+size_t ParticleSystem::getCapacity() const {
+    return impl_->capacity;
+}
+
+void ParticleSystem::reset() {
+    if (isSetup()) {
+        impl_->clear();
+    }
+    impl_->bursts.clear();
+}
+
+// ============================================================================
+// Emitters
+// ============================================================================
+
+size_t ParticleSystem::addEmitter(const Emitter& emitter) {
+    impl_->emitters.push_back(emitter);
+    impl_->emitRemainders.push_back(0.0f);
+    return impl_->emitters.size() - 1;
+}
+
+Emitter& ParticleSystem::getEmitter(size_t index) {
+    return impl_->emitters.at(index);
+}
+
+const Emitter& ParticleSystem::getEmitter(size_t index) const {
+    return impl_->emitters.at(index);
+}
+
+size_t ParticleSystem::getNumEmitters() const {
+    return impl_->emitters.size();
+}
+
+void ParticleSystem::clearEmitters() {
+    impl_->emitters.clear();
+    impl_->emitRemainders.clear();
+}
+
+void ParticleSystem::burst(const Emitter& emitter, size_t count) {
+    if (count > 0) {
+        impl_->bursts.emplace_back(emitter, count);
+    }
+}
+
+// ============================================================================
+// Forces
+// ============================================================================
+
+void ParticleSystem::setGravity(const ofVec3f& gravity) {
+    impl_->gravity = gravity;
+}
+
+ofVec3f ParticleSystem::getGravity() const {
+    return impl_->gravity;
+}
+
+void ParticleSystem::setDrag(float drag) {
+    impl_->drag = drag;
+}
+
+float ParticleSystem::getDrag() const {
+    return impl_->drag;
+}
+
+void ParticleSystem::setCurlNoise(float frequency, float strength, float speed) {
+    impl_->noiseFrequency = frequency;
+    impl_->noiseStrength = strength;
+    impl_->noiseSpeed = speed;
+}
+
+void ParticleSystem::disableCurlNoise() {
+    impl_->noiseStrength = 0.0f;
+}
+
+bool ParticleSystem::addAttractor(const Attractor& attractor) {
+    if (impl_->attractors.size() >= kMaxAttractors) {
+        return false;
+    }
+    impl_->attractors.push_back(attractor);
+    return true;
+}
+
+Attractor& ParticleSystem::getAttractor(size_t index) {
+    return impl_->attractors.at(index);
+}
+
+size_t ParticleSystem::getNumAttractors() const {
+    return impl_->attractors.size();
+}
+
+void ParticleSystem::clearAttractors() {
+    impl_->attractors.clear();
+}
+
+bool ParticleSystem::addCollisionPlane(const CollisionPlane& plane) {
+    if (impl_->planes.size() >= kMaxCollisionPlanes) {
+        return false;
+    }
+    impl_->planes.push_back(plane);
+    return true;
+}
+
+CollisionPlane& ParticleSystem::getCollisionPlane(size_t index) {
+    return impl_->planes.at(index);
+}
+
+size_t ParticleSystem::getNumCollisionPlanes() const {
+    return impl_->planes.size();
+}
+
+void ParticleSystem::clearCollisionPlanes() {
+    impl_->planes.clear();
+}
+
+// ============================================================================
+// Simulation
+// ============================================================================
+
+void ParticleSystem::update() {
+    const float now = ofGetElapsedTimef();
+    const float dt = impl_->lastUpdateTime < 0.0f ? 0.0f : now - impl_->lastUpdateTime;
+    impl_->lastUpdateTime = now;
+    update(std::min(dt, kMaxStep));
+}
+
+void ParticleSystem::update(float deltaTime) {
+    if (!isSetup() || deltaTime < 0.0f) {
+        return;
+    }
+    impl_->step(deltaTime);
+}
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+void ParticleSystem::setBlendMode(BlendMode mode) {
+    impl_->blendMode = mode;
+}
+
+BlendMode ParticleSystem::getBlendMode() const {
+    return impl_->blendMode;
+}
+
+void ParticleSystem::setMesh(VboMesh&& mesh) {
+    impl_->mesh = std::move(mesh);
+}
+
+void ParticleSystem::setBillboard(bool billboard) {
+    impl_->billboard = billboard;
+}
+
+bool ParticleSystem::getBillboard() const {
+    return impl_->billboard;
+}
+
+void ParticleSystem::draw(const ofCamera& camera) {
+    if (!isSetup() || impl_->mesh.getNumIndices() == 0) {
+        return;
+    }
+    if (!impl_->writeInstances(camera)) {
+        return;
+    }
+
+    const bool depthWrite = ofGetDepthWrite();
+    ofEnableBlendMode(impl_->blendMode == BlendMode::Additive ? OF_BLENDMODE_ADD : OF_BLENDMODE_ALPHA);
+    ofSetDepthWrite(false);
+    impl_->mesh.drawIndirect(impl_->arguments.getNativeHandle(), 0, impl_->instances.getNativeHandle());
+    ofSetDepthWrite(depthWrite);
+    ofEnableBlendMode(OF_BLENDMODE_ALPHA);
+}
+
+// ============================================================================
+// GPU Data
+// ============================================================================
+
+const ofBufferObject& ParticleSystem::getParticleBuffer() const {
+    return impl_->particles;
+}
+
+const ofBufferObject& ParticleSystem::getInstanceBuffer() const {
+    return impl_->instances;
+}
+
+} // namespace GpuParticles
@@ -0,0 +1,33 @@
+#pragma once
+
+// ofxGpuParticles - Millions of GPU-simulated particles for oflike-metal
+//
+// Particles are emitted, simulated and drawn entirely on the GPU with
+// compute kernels (shaders/GpuParticles.metal) and VboMesh indirect
+// instancing, so the CPU cost per frame does not grow with the count.
+//
+// Example usage:
+//   #include "ofxGpuParticles.h"
+//
+//   ofxGpuParticles::ParticleSystem particles;
+//   particles.setup(2000000);
+//
+//   ofxGpuParticles::Emitter emitter;
+//   emitter.rate = 500000;
+//   emitter.spread = M_PI;
+//   emitter.startColor = ofFloatColor(1.0f, 0.6f, 0.2f, 1.0f);
+//   particles.addEmitter(emitter);
+//   particles.setCurlNoise(0.5f, 4.0f);
+//
+//   void update() { particles.update(); }
+//   void draw() {
+//       cam.begin();
+//       particles.draw(cam);
+//       cam.end();
+//   }
+
+// Emitters, forces, collisions and instanced drawing
+#include "GpuParticleSystem.h"
+
+// Convenience namespace alias
+namespace ofxGpuParticles = GpuParticles;
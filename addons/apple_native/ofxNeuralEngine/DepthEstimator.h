@@ -23,6 +23,7 @@
 
 #include <string>
 #include <vector>
+#include <functional>
 #include <memory>
 
 // Forward declarations
@@ -86,7 +87,8 @@ public:
     // ============================================================================
 
     // Load Core ML depth estimation model from file path
-    // Accepts .mlmodelc (compiled) or .mlpackage paths
+    // Accepts .mlmodelc, .mlmodel or .mlpackage paths; the latter two are
+    // compiled once and cached (see ModelCache)
     // Returns true if successful
     bool load(const std::string& modelPath);
 
@@ -94,6 +96,16 @@ public:
     // Returns true if successful
     bool load(const std::string& modelPath, const DepthEstimatorConfig& config);
 
+    // Callback for async loading: true if the model loaded
+    using LoadCallback = std::function<void(bool success)>;
+
+    // Load in the background: compile, load and prewarm off the main
+    // thread, then install the model and call back on the main thread.
+    // Destroying the estimator, or a load(), unload() or loadAsync() before
+    // the model is ready, drops this load without calling back.
+    void loadAsync(const std::string& modelPath, LoadCallback callback);
+    void loadAsync(const std::string& modelPath, const DepthEstimatorConfig& config, LoadCallback callback);
+
     // Unload current model and free resources
     void unload();
 
@@ -107,16 +119,38 @@ public:
     // If invertDepth=true: near=255 (white), far=0 (black)
     oflike::ofPixels estimate(const oflike::ofPixels& pixels);
 
-    // Estimate depth from ofTexture (GPU direct processing)
+    // Estimate depth from ofTexture
     // Returns depth map as grayscale ofPixels
-    // More efficient than converting texture to pixels first
+    // IOSurface-backed textures (camera frames) are read in place; others
+    // are read back to pixels first
     oflike::ofPixels estimate(const oflike::ofTexture& texture);
 
+    // Estimate depth from a CVPixelBufferRef (camera frame), read in place
+    // Returns depth map as grayscale ofPixels
+    oflike::ofPixels estimate(void* pixelBuffer);
+
     // Estimate depth and output directly to texture (GPU-only path)
     // Returns true if successful
-    // This is the most efficient method for real-time applications
+    // When the model outputs an image, output draws its pixel buffer in
+    // place with the model's raw values (normalize/invert don't apply); it
+    // stays valid until the next call. Call on the main thread.
     bool estimateToTexture(const oflike::ofTexture& input, oflike::ofTexture& output);
 
+    // Estimate depth from a CVPixelBufferRef into a texture, zero-copy end
+    // to end for image outputs (see above)
+    bool estimateToTexture(void* pixelBuffer, oflike::ofTexture& output);
+
+    // ============================================================================
+    // Frame Scheduling (see FrameScheduler)
+    // ============================================================================
+
+    // Vision request (VNRequest*) a shared handler performs for each
+    // frame; separate from estimate()'s, nullptr until a model is loaded
+    void* getFrameRequest();
+
+    // Depth map from the frame request after the handler performed it
+    oflike::ofPixels getFrameResults();
+
     // ============================================================================
     // Configuration
     // ============================================================================
@@ -1,6 +1,10 @@
 #include "DepthEstimator.h"
 #include "ofPixels.h"
 #include "ofTexture.h"
+#include "video/VideoFrameTexture.h"
+#include "NeuralEngineBuffers.h"
+#include "ModelCache.h"
+#include "ofProfiler.h"
 #include <Foundation/Foundation.h>
 #include <CoreML/CoreML.h>
 #include <Vision/Vision.h>
@@ -21,56 +25,74 @@ namespace NeuralEngine {
 struct DepthEstimator::Impl {
     MLModel* model = nil;
     VNCoreMLModel* visionModel = nil;
+    VNCoreMLRequest* frameRequest = nil;    // Performed by a FrameScheduler
+    VideoFrameTexture outputFrames;         // Depth maps drawn in place by estimateToTexture()
     DepthEstimatorConfig config;
     DepthEstimatorInfo info;
     std::string lastError;
+    std::shared_ptr<ModelLoadGeneration> loads = std::make_shared<ModelLoadGeneration>();
 
     ~Impl() {
         @autoreleasepool {
             model = nil;
             visionModel = nil;
+            frameRequest = nil;
         }
     }
 
     bool loadModel(const std::string& modelPath, const DepthEstimatorConfig& cfg) {
         @autoreleasepool {
-            config = cfg;
-
-            // Convert path to NSURL
-            NSString* path = [NSString stringWithUTF8String:modelPath.c_str()];
-            NSURL* modelURL = [NSURL fileURLWithPath:path];
-
-            // Create model configuration
-            MLModelConfiguration* configuration = [[MLModelConfiguration alloc] init];
-
-            // Set compute units
-            switch (config.computeUnits) {
-                case DepthEstimatorConfig::ComputeUnits::CPUOnly:
-                    configuration.computeUnits = MLComputeUnitsCPUOnly;
-                    break;
-                case DepthEstimatorConfig::ComputeUnits::CPUAndGPU:
-                    configuration.computeUnits = MLComputeUnitsCPUAndGPU;
-                    break;
-                case DepthEstimatorConfig::ComputeUnits::CPUAndNeuralEngine:
-                    configuration.computeUnits = MLComputeUnitsCPUAndNeuralEngine;
-                    break;
-                case DepthEstimatorConfig::ComputeUnits::All:
-                default:
-                    configuration.computeUnits = MLComputeUnitsAll;
-                    break;
-            }
+            loads->next();
 
-            // Load model
+            // Load model (compiled through the model cache)
             NSError* error = nil;
-            model = [MLModel modelWithContentsOfURL:modelURL configuration:configuration error:&error];
-
-            if (error || !model) {
+            MLModel* loaded = LoadCachedModel(modelURLForPath(modelPath), createConfiguration(cfg), &error);
+            if (error || !loaded) {
                 lastError = error ? [[error localizedDescription] UTF8String] : "Failed to load model";
                 return false;
             }
+            return installModel(loaded, modelPath, cfg);
+        }
+    }
+
+    static NSURL* modelURLForPath(const std::string& modelPath) {
+        return [NSURL fileURLWithPath:[NSString stringWithUTF8String:modelPath.c_str()]];
+    }
+
+    static MLModelConfiguration* createConfiguration(const DepthEstimatorConfig& config) {
+        // Create model configuration
+        MLModelConfiguration* configuration = [[MLModelConfiguration alloc] init];
+
+        // Set compute units
+        switch (config.computeUnits) {
+            case DepthEstimatorConfig::ComputeUnits::CPUOnly:
+                configuration.computeUnits = MLComputeUnitsCPUOnly;
+                break;
+            case DepthEstimatorConfig::ComputeUnits::CPUAndGPU:
+                configuration.computeUnits = MLComputeUnitsCPUAndGPU;
+                break;
+            case DepthEstimatorConfig::ComputeUnits::CPUAndNeuralEngine:
+                configuration.computeUnits = MLComputeUnitsCPUAndNeuralEngine;
+                break;
+            case DepthEstimatorConfig::ComputeUnits::All:
+            default:
+                configuration.computeUnits = MLComputeUnitsAll;
+                break;
+        }
+        return configuration;
+    }
+
+    // Make a loaded model the current one; main thread
+    bool installModel(MLModel* loaded, const std::string& modelPath, const DepthEstimatorConfig& cfg) {
+        @autoreleasepool {
+            config = cfg;
+            model = loaded;
+            MLModelConfiguration* configuration = loaded.configuration;
 
             // Create Vision model wrapper
+            NSError* error = nil;
             visionModel = [VNCoreMLModel modelForMLModel:model error:&error];
+            frameRequest = nil;
 
             if (error || !visionModel) {
                 lastError = error ? [[error localizedDescription] UTF8String] : "Failed to create Vision model";
@@ -193,22 +215,79 @@ struct DepthEstimator::Impl {
 
     ofPixels estimateFromCGImage(CGImageRef cgImage, size_t originalWidth, size_t originalHeight) {
         @autoreleasepool {
-            // Create request
-            VNCoreMLRequest* request = [[VNCoreMLRequest alloc] initWithModel:visionModel];
-            request.imageCropAndScaleOption = VNImageCropAndScaleOptionScaleFit;
-
             // Create request handler
             VNImageRequestHandler* handler = [[VNImageRequestHandler alloc]
                 initWithCGImage:cgImage
                 options:@{}];
 
-            // Perform request
-            NSError* error = nil;
-            if (![handler performRequests:@[request] error:&error]) {
-                lastError = error ? [[error localizedDescription] UTF8String] : "Inference failed";
-                return ofPixels();
+            VNCoreMLRequest* request = performRequest(handler);
+            return request ? collectDepth(request) : ofPixels();
+        }
+    }
+
+    // Run the model on a frame in place: CVPixelBuffers are never converted
+    ofPixels estimateFromPixelBuffer(CVPixelBufferRef pixelBuffer) {
+        @autoreleasepool {
+            VNCoreMLRequest* request = performRequest(pixelBuffer);
+            return request ? collectDepth(request) : ofPixels();
+        }
+    }
+
+    // The performed request; nil (with lastError set) on failure
+    VNCoreMLRequest* performRequest(CVPixelBufferRef pixelBuffer) {
+        if (!pixelBuffer) {
+            lastError = "Invalid pixel buffer";
+            return nil;
+        }
+        return performRequest([[VNImageRequestHandler alloc] initWithCVPixelBuffer:pixelBuffer options:@{}]);
+    }
+
+    VNCoreMLRequest* performRequest(VNImageRequestHandler* handler) {
+        if (!visionModel) {
+            lastError = "Model not loaded";
+            return nil;
+        }
+
+        // Create request
+        VNCoreMLRequest* request = [[VNCoreMLRequest alloc] initWithModel:visionModel];
+        request.imageCropAndScaleOption = VNImageCropAndScaleOptionScaleFit;
+
+        // Perform request
+        OF_PROFILE_SCOPE("DepthEstimator inference");
+        NSError* error = nil;
+        if (![handler performRequests:@[request] error:&error]) {
+            lastError = error ? [[error localizedDescription] UTF8String] : "Inference failed";
+            return nil;
+        }
+        return request;
+    }
+
+    // Draw the output of a frame: image outputs in place, others uploaded
+    bool estimateToTexture(CVPixelBufferRef pixelBuffer, ofTexture& output) {
+        @autoreleasepool {
+            VNCoreMLRequest* request = performRequest(pixelBuffer);
+            if (!request) {
+                return false;
+            }
+            CVPixelBufferRef depth = GetResultPixelBuffer(request);
+            if (depth && VideoFrameTexture::isSupportedFormat(CVPixelBufferGetPixelFormatType(depth))) {
+                outputFrames.setFrame(depth, output);
+                return true;
+            }
+
+            ofPixels depthPixels = collectDepth(request);
+            if (depthPixels.getWidth() == 0 || depthPixels.getHeight() == 0) {
+                return false;
             }
+            output.allocate(depthPixels.getWidth(), depthPixels.getHeight(), OF_IMAGE_GRAYSCALE);
+            output.loadData(depthPixels);
+            return true;
+        }
+    }
 
+    // Depth map from a request that has been performed
+    ofPixels collectDepth(VNCoreMLRequest* request) {
+        @autoreleasepool {
             // Get results
             if (request.results.count == 0) {
                 lastError = "No results from model";
@@ -428,10 +507,39 @@ bool DepthEstimator::load(const std::string& modelPath, const DepthEstimatorConf
     return impl_->loadModel(modelPath, config);
 }
 
+void DepthEstimator::loadAsync(const std::string& modelPath, LoadCallback callback) {
+    loadAsync(modelPath, DepthEstimatorConfig(), callback);
+}
+
+void DepthEstimator::loadAsync(const std::string& modelPath, const DepthEstimatorConfig& config,
+                               LoadCallback callback) {
+    @autoreleasepool {
+        // Only called while this load is current, so impl is alive
+        Impl* impl = impl_.get();
+        std::string path = modelPath;
+        DepthEstimatorConfig cfg = config;
+
+        LoadModelAsync(Impl::modelURLForPath(modelPath), Impl::createConfiguration(config), impl->loads,
+                       ^(MLModel* loaded, NSError* error) {
+            bool success = false;
+            if (loaded) {
+                success = impl->installModel(loaded, path, cfg);
+            } else {
+                impl->lastError = error ? [[error localizedDescription] UTF8String] : "Failed to load model";
+            }
+            if (callback) {
+                callback(success);
+            }
+        });
+    }
+}
+
 void DepthEstimator::unload() {
     @autoreleasepool {
+        impl_->loads->next();
         impl_->model = nil;
         impl_->visionModel = nil;
+        impl_->frameRequest = nil;
         impl_->info = DepthEstimatorInfo();
     }
 }
@@ -445,26 +553,56 @@ ofPixels DepthEstimator::estimate(const ofPixels& pixels) {
 }
 
 ofPixels DepthEstimator::estimate(const ofTexture& texture) {
-    // DEFERRED: Direct GPU path using MTLTexture
-    //
-    // Rationale:
-    // - VNCoreMLRequest expects CVPixelBuffer or CGImage input
-    // - Direct MTLTexture → CVPixelBuffer requires Metal compute pipeline
-    // - Current CPU path via readToPixels() is sufficient for most use cases
-    // - GPU optimization deferred until performance profiling shows bottleneck
-    //
-    // Workaround: Users should convert ofTexture to ofPixels manually:
-    // Example:
-    //   ofImage img;
-    //   img.load("input.jpg");
-    //   ofPixels depthMap = estimator.estimate(img.getPixels());
-
-    impl_->lastError = "ofTexture input not yet implemented. Please convert to ofPixels first.";
-    return ofPixels();
+    // IOSurface-backed textures (camera frames) are read in place
+    CVPixelBufferRef pixelBuffer = CreatePixelBufferFromTexture(texture);
+    if (pixelBuffer) {
+        ofPixels result = impl_->estimateFromPixelBuffer(pixelBuffer);
+        CVPixelBufferRelease(pixelBuffer);
+        return result;
+    }
+
+    ofPixels pixels;
+    texture.readToPixels(pixels);
+    return impl_->estimateFromPixels(pixels);
+}
+
+ofPixels DepthEstimator::estimate(void* pixelBuffer) {
+    return impl_->estimateFromPixelBuffer(static_cast<CVPixelBufferRef>(pixelBuffer));
+}
+
+// ============================================================================
+// Frame Scheduling
+// ============================================================================
+
+void* DepthEstimator::getFrameRequest() {
+    @autoreleasepool {
+        if (!impl_->visionModel) {
+            return nullptr;
+        }
+        if (!impl_->frameRequest) {
+            impl_->frameRequest = [[VNCoreMLRequest alloc] initWithModel:impl_->visionModel];
+            impl_->frameRequest.imageCropAndScaleOption = VNImageCropAndScaleOptionScaleFit;
+        }
+        return (__bridge void*)impl_->frameRequest;
+    }
+}
+
+ofPixels DepthEstimator::getFrameResults() {
+    if (!impl_->frameRequest) {
+        return ofPixels();
+    }
+    return impl_->collectDepth(impl_->frameRequest);
 }
 
 bool DepthEstimator::estimateToTexture(const ofTexture& input, ofTexture& output) {
-    // Estimate depth
+    CVPixelBufferRef pixelBuffer = CreatePixelBufferFromTexture(input);
+    if (pixelBuffer) {
+        bool estimated = impl_->estimateToTexture(pixelBuffer, output);
+        CVPixelBufferRelease(pixelBuffer);
+        return estimated;
+    }
+
+    // Textures in their own memory are read back first
     ofPixels depthPixels = estimate(input);
 
     if (depthPixels.getWidth() == 0 || depthPixels.getHeight() == 0) {
@@ -478,6 +616,10 @@ bool DepthEstimator::estimateToTexture(const ofTexture& input, ofTexture& output
     return true;
 }
 
+bool DepthEstimator::estimateToTexture(void* pixelBuffer, ofTexture& output) {
+    return impl_->estimateToTexture(static_cast<CVPixelBufferRef>(pixelBuffer), output);
+}
+
 // ============================================================================
 // Configuration
 // ============================================================================
@@ -0,0 +1,109 @@
+#pragma once
+
+// FrameScheduler - runs several Vision models on one camera frame
+//
+// Each model's own API converts the frame to a CGImage and performs its
+// request synchronously; running three of them per frame converts the
+// frame three times and stacks their latencies. The scheduler takes one
+// CVPixelBuffer per frame and performs every registered model's Vision
+// request through a single VNSequenceRequestHandler on a background queue.
+//
+// Features:
+// - One image conversion and one handler per frame for all models
+// - Never falls behind: a frame still waiting when a newer one arrives is dropped
+// - Results published with the timestamp of the frame they came from
+//
+// Example usage:
+//   FrameScheduler scheduler;
+//   scheduler.add(segmentation, [](const SegmentationResult& mask, double t) { ... });
+//   scheduler.add(poseEstimator, [](const std::vector<HumanPose>& poses, double t) { ... });
+//   scheduler.add(depthEstimator, [](const ofPixels& depth, double t) { ... });
+//   // Per camera frame:
+//   scheduler.submit(pixelBuffer, timestamp);
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "PersonSegmentation.h"
+#include "PoseEstimator.h"
+#include "DepthEstimator.h"
+
+namespace NeuralEngine {
+
+class FrameScheduler {
+public:
+    // ============================================================================
+    // Callbacks (invoked on the scheduler's background queue)
+    // ============================================================================
+
+    using SegmentationCallback = std::function<void(const SegmentationResult& result, double timestamp)>;
+    using PoseCallback = std::function<void(const std::vector<HumanPose>& poses, double timestamp)>;
+    using DepthCallback = std::function<void(const oflike::ofPixels& depth, double timestamp)>;
+
+    // ============================================================================
+    // Constructors / Destructor
+    // ============================================================================
+
+    FrameScheduler();
+    ~FrameScheduler();
+
+    FrameScheduler(FrameScheduler&& other) noexcept;
+    FrameScheduler& operator=(FrameScheduler&& other) noexcept;
+
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    // ============================================================================
+    // Models
+    // ============================================================================
+
+    // Register a model (already set up or loaded); it must outlive the
+    // scheduler or be removed with clear(). Takes effect from the next frame.
+    void add(PersonSegmentation& segmentation, SegmentationCallback callback);
+    void add(PoseEstimator& estimator, PoseCallback callback);
+    void add(DepthEstimator& estimator, DepthCallback callback);
+
+    // Remove all models; waits for the frame in progress
+    void clear();
+
+    // ============================================================================
+    // Frames
+    // ============================================================================
+
+    // Queue a frame (CVPixelBufferRef, retained until processed). Replaces
+    // a frame still waiting, which counts as dropped.
+    // Returns false if no models are registered or the buffer is null
+    bool submit(void* pixelBuffer, double timestamp);
+
+    // Queue a frame from 8-bit RGB/RGBA pixels, converted once for all models
+    bool submit(const oflike::ofPixels& pixels, double timestamp);
+
+    // Block until the queued frame (if any) and the one in progress are done
+    void waitUntilIdle();
+
+    // Check if a frame is queued or in progress
+    bool isProcessing() const;
+
+    // ============================================================================
+    // Statistics
+    // ============================================================================
+
+    uint64_t getFramesProcessed() const;
+    uint64_t getFramesDropped() const;
+
+    // Time the last frame took through every model, in milliseconds
+    double getLastFrameTime() const;
+
+    // Vision error of the last frame; empty if it succeeded
+    std::string getLastError() const;
+
+private:
+    // pImpl pattern - hide Objective-C++ implementation
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace NeuralEngine
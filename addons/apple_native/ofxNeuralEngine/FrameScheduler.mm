@@ -0,0 +1,343 @@
+#import "FrameScheduler.h"
+#import "ofPixels.h"
+#import "ofProfiler.h"
+#import "ofTelemetry.h"
+#import <Foundation/Foundation.h>
+#import <Vision/Vision.h>
+#import <CoreVideo/CoreVideo.h>
+#import <Accelerate/Accelerate.h>
+#include <chrono>
+#include <mutex>
+
+using namespace oflike;
+
+namespace NeuralEngine {
+
+namespace {
+
+// Every scheduler's frames, through all of its models
+ofTelemetryTimer& inferenceTimer() {
+    static ofTelemetryTimer timer("ml.frameScheduler");
+    return timer;
+}
+
+} // namespace
+
+// ============================================================================
+// FrameScheduler::Impl
+// ============================================================================
+
+struct FrameScheduler::Impl {
+    // One registered model: its frame request and what to do once it ran
+    struct Entry {
+        std::function<void*()> request;
+        std::function<void(size_t width, size_t height, double timestamp)> publish;
+    };
+
+    dispatch_queue_t queue;
+    VNSequenceRequestHandler* handler = nil;    // Used on the queue only
+
+    // Buffers for submit(ofPixels), recreated when the frame size changes
+    std::mutex poolMutex;
+    CVPixelBufferPoolRef pool = nullptr;
+    size_t poolWidth = 0;
+    size_t poolHeight = 0;
+
+    // Shared between submit() and the queue
+    mutable std::mutex mutex;
+    std::vector<Entry> entries;
+    CVPixelBufferRef pending = nullptr;         // Newest frame not yet started
+    double pendingTimestamp = 0.0;
+    bool running = false;                       // A drain is queued or in progress
+    uint64_t framesProcessed = 0;
+    uint64_t framesDropped = 0;
+    double lastFrameTime = 0.0;
+    std::string lastError;
+
+    Impl() {
+        @autoreleasepool {
+            queue = dispatch_queue_create("com.oflike.metal.frame_scheduler", DISPATCH_QUEUE_SERIAL);
+        }
+    }
+
+    ~Impl() {
+        clear();
+        if (pool) {
+            CVPixelBufferPoolRelease(pool);
+        }
+    }
+
+    void add(Entry entry) {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.push_back(std::move(entry));
+    }
+
+    void clear() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            entries.clear();
+            if (pending) {
+                CVPixelBufferRelease(pending);
+                pending = nullptr;
+            }
+        }
+        waitUntilIdle();
+    }
+
+    void waitUntilIdle() {
+        // The serial queue runs a drain until nothing is pending
+        dispatch_sync(queue, ^{});
+    }
+
+    bool submit(CVPixelBufferRef buffer, double timestamp) {
+        if (!buffer) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (entries.empty()) {
+            return false;
+        }
+
+        CVPixelBufferRetain(buffer);
+        if (pending) {
+            // Superseded before it started
+            CVPixelBufferRelease(pending);
+            framesDropped++;
+        }
+        pending = buffer;
+        pendingTimestamp = timestamp;
+
+        if (!running) {
+            running = true;
+            dispatch_async(queue, ^{
+                drain();
+            });
+        }
+        return true;
+    }
+
+    // Queue: process the newest pending frame until none is left
+    void drain() {
+        for (;;) {
+            CVPixelBufferRef frame = nullptr;
+            double timestamp = 0.0;
+            std::vector<Entry> frameEntries;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!pending) {
+                    running = false;
+                    return;
+                }
+                frame = pending;
+                timestamp = pendingTimestamp;
+                pending = nullptr;
+                frameEntries = entries;
+            }
+
+            process(frame, timestamp, frameEntries);
+            CVPixelBufferRelease(frame);
+        }
+    }
+
+    void process(CVPixelBufferRef frame, double timestamp, const std::vector<Entry>& frameEntries) {
+        @autoreleasepool {
+            auto startTime = std::chrono::high_resolution_clock::now();
+
+            NSMutableArray<VNRequest*>* requests = [NSMutableArray arrayWithCapacity:frameEntries.size()];
+            std::vector<const Entry*> active;
+            for (const Entry& entry : frameEntries) {
+                void* request = entry.request();
+                if (request) {
+                    [requests addObject:(__bridge VNRequest*)request];
+                    active.push_back(&entry);
+                }
+            }
+            if (requests.count == 0) {
+                return;
+            }
+
+            if (!handler) {
+                handler = [[VNSequenceRequestHandler alloc] init];
+            }
+            OF_PROFILE_SCOPE("FrameScheduler inference");
+            NSError* error = nil;
+            BOOL success = [handler performRequests:requests onCVPixelBuffer:frame error:&error];
+
+            // A request that failed has no results; its model reports that
+            const size_t width = CVPixelBufferGetWidth(frame);
+            const size_t height = CVPixelBufferGetHeight(frame);
+            for (const Entry* entry : active) {
+                entry->publish(width, height, timestamp);
+            }
+
+            auto endTime = std::chrono::high_resolution_clock::now();
+            std::chrono::duration<double, std::milli> duration = endTime - startTime;
+            inferenceTimer().add(duration.count() * 1e-3);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            framesProcessed++;
+            lastFrameTime = duration.count();
+            if (success) {
+                lastError.clear();
+            } else {
+                lastError = error ? std::string("Vision error: ") + [error.localizedDescription UTF8String]
+                                  : "Vision requests failed";
+            }
+        }
+    }
+
+    // BGRA buffer holding pixels; nullptr for unsupported formats
+    CVPixelBufferRef createBuffer(const ofPixels& pixels) {
+        const size_t width = pixels.getWidth();
+        const size_t height = pixels.getHeight();
+        const size_t channels = pixels.getNumChannels();
+        if (!pixels.isAllocated() || width == 0 || height == 0 || (channels != 3 && channels != 4)) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (!pool || poolWidth != width || poolHeight != height) {
+            if (pool) {
+                CVPixelBufferPoolRelease(pool);
+                pool = nullptr;
+            }
+            NSDictionary* attributes = @{
+                (id)kCVPixelBufferWidthKey: @(width),
+                (id)kCVPixelBufferHeightKey: @(height),
+                (id)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
+                (id)kCVPixelBufferIOSurfacePropertiesKey: @{}
+            };
+            if (CVPixelBufferPoolCreate(kCFAllocatorDefault, nullptr, (__bridge CFDictionaryRef)attributes,
+                                        &pool) != kCVReturnSuccess) {
+                pool = nullptr;
+                return nullptr;
+            }
+            poolWidth = width;
+            poolHeight = height;
+        }
+
+        CVPixelBufferRef buffer = nullptr;
+        if (CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, pool, &buffer) != kCVReturnSuccess) {
+            return nullptr;
+        }
+
+        CVPixelBufferLockBaseAddress(buffer, 0);
+        vImage_Buffer source = {const_cast<unsigned char*>(pixels.getData()), height, width, pixels.getBytesPerRow()};
+        vImage_Buffer destination = {CVPixelBufferGetBaseAddress(buffer), height, width,
+                                     CVPixelBufferGetBytesPerRow(buffer)};
+        vImage_Error result;
+        if (channels == 3) {
+            result = vImageConvert_RGB888toBGRA8888(&source, nullptr, 255, &destination, false, kvImageNoFlags);
+        } else {
+            const uint8_t toBGRA[4] = {2, 1, 0, 3};
+            result = vImagePermuteChannels_ARGB8888(&source, &destination, toBGRA, kvImageNoFlags);
+        }
+        CVPixelBufferUnlockBaseAddress(buffer, 0);
+
+        if (result != kvImageNoError) {
+            CVPixelBufferRelease(buffer);
+            return nullptr;
+        }
+        return buffer;
+    }
+};
+
+// ============================================================================
+// FrameScheduler Public API
+// ============================================================================
+
+FrameScheduler::FrameScheduler()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+FrameScheduler::~FrameScheduler() = default;
+
+FrameScheduler::FrameScheduler(FrameScheduler&& other) noexcept = default;
+FrameScheduler& FrameScheduler::operator=(FrameScheduler&& other) noexcept = default;
+
+void FrameScheduler::add(PersonSegmentation& segmentation, SegmentationCallback callback) {
+    PersonSegmentation* model = &segmentation;
+    impl_->add({
+        [model]() { return model->getFrameRequest(); },
+        [model, callback](size_t width, size_t height, double timestamp) {
+            if (callback) {
+                callback(model->getFrameResults(width, height), timestamp);
+            }
+        }
+    });
+}
+
+void FrameScheduler::add(PoseEstimator& estimator, PoseCallback callback) {
+    PoseEstimator* model = &estimator;
+    impl_->add({
+        [model]() { return model->getFrameRequest(); },
+        [model, callback](size_t, size_t, double timestamp) {
+            if (callback) {
+                callback(model->getFrameResults(), timestamp);
+            }
+        }
+    });
+}
+
+void FrameScheduler::add(DepthEstimator& estimator, DepthCallback callback) {
+    DepthEstimator* model = &estimator;
+    impl_->add({
+        [model]() { return model->getFrameRequest(); },
+        [model, callback](size_t, size_t, double timestamp) {
+            if (callback) {
+                callback(model->getFrameResults(), timestamp);
+            }
+        }
+    });
+}
+
+void FrameScheduler::clear() {
+    impl_->clear();
+}
+
+bool FrameScheduler::submit(void* pixelBuffer, double timestamp) {
+    return impl_->submit(static_cast<CVPixelBufferRef>(pixelBuffer), timestamp);
+}
+
+bool FrameScheduler::submit(const ofPixels& pixels, double timestamp) {
+    @autoreleasepool {
+        CVPixelBufferRef buffer = impl_->createBuffer(pixels);
+        if (!buffer) {
+            return false;
+        }
+        bool queued = impl_->submit(buffer, timestamp);
+        CVPixelBufferRelease(buffer);
+        return queued;
+    }
+}
+
+void FrameScheduler::waitUntilIdle() {
+    impl_->waitUntilIdle();
+}
+
+bool FrameScheduler::isProcessing() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->running;
+}
+
+uint64_t FrameScheduler::getFramesProcessed() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->framesProcessed;
+}
+
+uint64_t FrameScheduler::getFramesDropped() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->framesDropped;
+}
+
+double FrameScheduler::getLastFrameTime() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->lastFrameTime;
+}
+
+std::string FrameScheduler::getLastError() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->lastError;
+}
+
+} // namespace NeuralEngine
@@ -14,6 +14,7 @@
 // - Neural Engine acceleration
 // - Configurable compute units (CPU, GPU, Neural Engine)
 // - Batch prediction support
+// - Zero-copy tensors: inputs and output backings over caller buffers
 //
 // Example usage:
 //   GenericModel model;
@@ -33,6 +34,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <functional>
 #include <memory>
 #include <any>
 
@@ -85,6 +87,16 @@ struct FeatureInfo {
     FeatureType dictionaryValueType = FeatureType::Invalid;
 };
 
+// Caller-owned multi-array memory, wrapped by Core ML without copying
+struct TensorBuffer {
+    void* data = nullptr;
+    MultiArrayDataType dataType = MultiArrayDataType::Float32;
+    std::vector<size_t> shape;
+
+    // Per-dimension strides in elements (not bytes); empty for packed row-major
+    std::vector<size_t> strides;
+};
+
 // Configuration for generic model
 struct GenericModelConfig {
     // Compute units preference
@@ -138,7 +150,8 @@ public:
     // ============================================================================
 
     // Load Core ML model from file path
-    // Accepts .mlmodelc (compiled) or .mlpackage paths
+    // Accepts .mlmodelc, .mlmodel or .mlpackage paths; the latter two are
+    // compiled once and cached (see ModelCache)
     // Returns true if successful
     bool load(const std::string& modelPath);
 
@@ -146,6 +159,16 @@ public:
     // Returns true if successful
     bool load(const std::string& modelPath, const GenericModelConfig& config);
 
+    // Callback for async loading: true if the model loaded
+    using LoadCallback = std::function<void(bool success)>;
+
+    // Load in the background: compile, load and prewarm off the main
+    // thread, then install the model and call back on the main thread.
+    // Destroying the model, or a load(), unload() or loadAsync() before
+    // the model is ready, drops this load without calling back.
+    void loadAsync(const std::string& modelPath, LoadCallback callback);
+    void loadAsync(const std::string& modelPath, const GenericModelConfig& config, LoadCallback callback);
+
     // Unload current model and free resources
     void unload();
 
@@ -189,9 +212,29 @@ public:
     // Set input from dictionary (string -> double)
     void setInput(const std::string& name, const std::map<std::string, double>& dict);
 
+    // Set input from caller-owned memory (Float32, Float16, Double or Int32,
+    // any strides) without copying. The memory must stay valid until the
+    // next predict() returns; setting the same buffer again costs nothing.
+    // Returns false if the buffer is invalid (see getLastError())
+    bool setInput(const std::string& name, const TensorBuffer& tensor);
+
     // Clear all inputs
     void clearInputs();
 
+    // ============================================================================
+    // Output Backings
+    // ============================================================================
+
+    // Have predict() write a multi-array output straight into caller-owned
+    // memory instead of allocating it each call (macOS 11+). Shape and data
+    // type must match the model's output; read the results from the buffer.
+    // Cleared when another model is loaded.
+    // Returns false if there is no such output or the buffer is invalid
+    bool setOutputBacking(const std::string& name, const TensorBuffer& tensor);
+
+    // Allocate outputs again on every predict()
+    void clearOutputBackings();
+
     // ============================================================================
     // Prediction
     // ============================================================================
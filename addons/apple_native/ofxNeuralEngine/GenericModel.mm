@@ -1,6 +1,8 @@
 #include "GenericModel.h"
 #include "ofPixels.h"
 #include "ofTexture.h"
+#include "ModelCache.h"
+#include "ofProfiler.h"
 #include <Foundation/Foundation.h>
 #include <CoreML/CoreML.h>
 #include <CoreGraphics/CoreGraphics.h>
@@ -38,6 +40,68 @@ static MultiArrayDataType convertMLMultiArrayDataType(MLMultiArrayDataType type)
     }
 }
 
+static bool convertMultiArrayDataType(MultiArrayDataType type, MLMultiArrayDataType& result) {
+    switch (type) {
+        case MultiArrayDataType::Double: result = MLMultiArrayDataTypeDouble; return true;
+        case MultiArrayDataType::Float32: result = MLMultiArrayDataTypeFloat32; return true;
+        case MultiArrayDataType::Float16: result = MLMultiArrayDataTypeFloat16; return true;
+        case MultiArrayDataType::Int32: result = MLMultiArrayDataTypeInt32; return true;
+        default: return false;
+    }
+}
+
+static bool isSameTensor(const TensorBuffer& a, const TensorBuffer& b) {
+    return a.data == b.data && a.dataType == b.dataType && a.shape == b.shape && a.strides == b.strides;
+}
+
+// MLMultiArray over caller-owned memory (no copy, never freed by Core ML)
+static MLMultiArray* wrapTensor(const TensorBuffer& tensor, std::string& error) {
+    MLMultiArrayDataType dataType;
+    if (!convertMultiArrayDataType(tensor.dataType, dataType)) {
+        error = "Unsupported tensor data type";
+        return nil;
+    }
+    if (!tensor.data || tensor.shape.empty()) {
+        error = "Tensor has no data or shape";
+        return nil;
+    }
+    if (!tensor.strides.empty() && tensor.strides.size() != tensor.shape.size()) {
+        error = "Tensor strides don't match its shape";
+        return nil;
+    }
+
+    // Packed row-major strides unless given
+    const size_t rank = tensor.shape.size();
+    std::vector<size_t> strides = tensor.strides;
+    if (strides.empty()) {
+        strides.resize(rank);
+        size_t stride = 1;
+        for (size_t i = rank; i-- > 0;) {
+            strides[i] = stride;
+            stride *= tensor.shape[i];
+        }
+    }
+
+    NSMutableArray<NSNumber*>* shapeArray = [NSMutableArray arrayWithCapacity:rank];
+    NSMutableArray<NSNumber*>* strideArray = [NSMutableArray arrayWithCapacity:rank];
+    for (size_t i = 0; i < rank; i++) {
+        [shapeArray addObject:@(tensor.shape[i])];
+        [strideArray addObject:@(strides[i])];
+    }
+
+    NSError* nsError = nil;
+    MLMultiArray* array = [[MLMultiArray alloc] initWithDataPointer:tensor.data
+                                                              shape:shapeArray
+                                                           dataType:dataType
+                                                            strides:strideArray
+                                                        deallocator:nil
+                                                              error:&nsError];
+    if (!array) {
+        error = nsError ? [[nsError localizedDescription] UTF8String] : "Failed to wrap tensor";
+    }
+    return array;
+}
+
 static FeatureInfo extractFeatureInfo(MLFeatureDescription* desc) {
     @autoreleasepool {
         FeatureInfo info;
@@ -80,11 +144,25 @@ struct GenericModel::Impl {
     GenericModelConfig config;
     GenericModelInfo info;
     std::string lastError;
+    std::shared_ptr<ModelLoadGeneration> loads = std::make_shared<ModelLoadGeneration>();
 
     // Input/output features
     NSMutableDictionary<NSString*, MLFeatureValue*>* inputFeatures = nil;
     MLFeatureProvider* outputFeatures = nil;
 
+    // Provider over inputFeatures, rebuilt only after an input changes
+    MLDictionaryFeatureProvider* inputProvider = nil;
+
+    // Caller-owned tensors: inputs keep their wrapper while the buffer is
+    // unchanged; outputs are written straight into their backing
+    struct WrappedTensor {
+        TensorBuffer tensor;
+        MLFeatureValue* value = nil;
+    };
+    std::map<std::string, WrappedTensor> inputTensors;
+    NSMutableDictionary<NSString*, id>* outputBackings = nil;
+    MLPredictionOptions* predictionOptions = nil;
+
     Impl() {
         @autoreleasepool {
             inputFeatures = [[NSMutableDictionary alloc] init];
@@ -96,45 +174,81 @@ struct GenericModel::Impl {
             model = nil;
             inputFeatures = nil;
             outputFeatures = nil;
+            inputProvider = nil;
+            outputBackings = nil;
+            predictionOptions = nil;
         }
     }
 
-    bool loadModel(const std::string& modelPath, const GenericModelConfig& cfg) {
-        @autoreleasepool {
-            config = cfg;
+    void setFeature(NSString* featureName, MLFeatureValue* featureValue) {
+        inputFeatures[featureName] = featureValue;
+        inputProvider = nil;
+    }
 
-            // Convert path to NSURL
-            NSString* path = [NSString stringWithUTF8String:modelPath.c_str()];
-            NSURL* modelURL = [NSURL fileURLWithPath:path];
+    void clearInputs() {
+        @autoreleasepool {
+            [inputFeatures removeAllObjects];
+            inputTensors.clear();
+            inputProvider = nil;
+        }
+    }
 
-            // Create model configuration
-            MLModelConfiguration* configuration = [[MLModelConfiguration alloc] init];
+    void clearOutputBackings() {
+        @autoreleasepool {
+            outputBackings = nil;
+            predictionOptions = nil;
+        }
+    }
 
-            // Set compute units
-            switch (config.computeUnits) {
-                case GenericModelConfig::ComputeUnits::CPUOnly:
-                    configuration.computeUnits = MLComputeUnitsCPUOnly;
-                    break;
-                case GenericModelConfig::ComputeUnits::CPUAndGPU:
-                    configuration.computeUnits = MLComputeUnitsCPUAndGPU;
-                    break;
-                case GenericModelConfig::ComputeUnits::CPUAndNeuralEngine:
-                    configuration.computeUnits = MLComputeUnitsCPUAndNeuralEngine;
-                    break;
-                case GenericModelConfig::ComputeUnits::All:
-                default:
-                    configuration.computeUnits = MLComputeUnitsAll;
-                    break;
-            }
+    bool loadModel(const std::string& modelPath, const GenericModelConfig& cfg) {
+        @autoreleasepool {
+            loads->next();
 
-            // Load model
+            // Load model (compiled through the model cache)
             NSError* error = nil;
-            model = [MLModel modelWithContentsOfURL:modelURL configuration:configuration error:&error];
-
-            if (error || !model) {
+            MLModel* loaded = LoadCachedModel(modelURLForPath(modelPath), createConfiguration(cfg), &error);
+            if (error || !loaded) {
                 lastError = error ? [[error localizedDescription] UTF8String] : "Failed to load model";
                 return false;
             }
+            return installModel(loaded, modelPath, cfg);
+        }
+    }
+
+    static NSURL* modelURLForPath(const std::string& modelPath) {
+        return [NSURL fileURLWithPath:[NSString stringWithUTF8String:modelPath.c_str()]];
+    }
+
+    static MLModelConfiguration* createConfiguration(const GenericModelConfig& config) {
+        // Create model configuration
+        MLModelConfiguration* configuration = [[MLModelConfiguration alloc] init];
+
+        // Set compute units
+        switch (config.computeUnits) {
+            case GenericModelConfig::ComputeUnits::CPUOnly:
+                configuration.computeUnits = MLComputeUnitsCPUOnly;
+                break;
+            case GenericModelConfig::ComputeUnits::CPUAndGPU:
+                configuration.computeUnits = MLComputeUnitsCPUAndGPU;
+                break;
+            case GenericModelConfig::ComputeUnits::CPUAndNeuralEngine:
+                configuration.computeUnits = MLComputeUnitsCPUAndNeuralEngine;
+                break;
+            case GenericModelConfig::ComputeUnits::All:
+            default:
+                configuration.computeUnits = MLComputeUnitsAll;
+                break;
+        }
+        return configuration;
+    }
+
+    // Make a loaded model the current one; main thread
+    bool installModel(MLModel* loaded, const std::string& modelPath, const GenericModelConfig& cfg) {
+        @autoreleasepool {
+            config = cfg;
+            model = loaded;
+            clearOutputBackings();
+            MLModelConfiguration* configuration = loaded.configuration;
 
             // Extract model information
             info.modelPath = modelPath;
@@ -235,7 +349,7 @@ struct GenericModel::Impl {
                 return false;
             }
 
-            inputFeatures[featureName] = featureValue;
+            setFeature(featureName, featureValue);
             return true;
         }
     }
@@ -244,7 +358,7 @@ struct GenericModel::Impl {
         @autoreleasepool {
             NSString* featureName = [NSString stringWithUTF8String:name.c_str()];
             MLFeatureValue* featureValue = [MLFeatureValue featureValueWithInt64:value];
-            inputFeatures[featureName] = featureValue;
+            setFeature(featureName, featureValue);
             return true;
         }
     }
@@ -253,7 +367,7 @@ struct GenericModel::Impl {
         @autoreleasepool {
             NSString* featureName = [NSString stringWithUTF8String:name.c_str()];
             MLFeatureValue* featureValue = [MLFeatureValue featureValueWithDouble:value];
-            inputFeatures[featureName] = featureValue;
+            setFeature(featureName, featureValue);
             return true;
         }
     }
@@ -263,7 +377,7 @@ struct GenericModel::Impl {
             NSString* featureName = [NSString stringWithUTF8String:name.c_str()];
             NSString* stringValue = [NSString stringWithUTF8String:value.c_str()];
             MLFeatureValue* featureValue = [MLFeatureValue featureValueWithString:stringValue];
-            inputFeatures[featureName] = featureValue;
+            setFeature(featureName, featureValue);
             return true;
         }
     }
@@ -320,12 +434,74 @@ struct GenericModel::Impl {
             // Create feature value
             NSString* featureName = [NSString stringWithUTF8String:name.c_str()];
             MLFeatureValue* featureValue = [MLFeatureValue featureValueWithMultiArray:multiArray];
-            inputFeatures[featureName] = featureValue;
+            setFeature(featureName, featureValue);
 
             return true;
         }
     }
 
+    bool setTensorInput(const std::string& name, const TensorBuffer& tensor) {
+        @autoreleasepool {
+            if (!model) {
+                lastError = "Model not loaded";
+                return false;
+            }
+
+            NSString* featureName = [NSString stringWithUTF8String:name.c_str()];
+
+            // Same buffer as last time: the wrapper already sees its contents
+            auto it = inputTensors.find(name);
+            if (it != inputTensors.end() && isSameTensor(it->second.tensor, tensor)) {
+                if (inputFeatures[featureName] != it->second.value) {
+                    setFeature(featureName, it->second.value);
+                }
+                return true;
+            }
+
+            MLMultiArray* array = wrapTensor(tensor, lastError);
+            if (!array) {
+                return false;
+            }
+            MLFeatureValue* featureValue = [MLFeatureValue featureValueWithMultiArray:array];
+            inputTensors[name] = {tensor, featureValue};
+            setFeature(featureName, featureValue);
+            return true;
+        }
+    }
+
+    bool setOutputBacking(const std::string& name, const TensorBuffer& tensor) {
+        @autoreleasepool {
+            if (!model) {
+                lastError = "Model not loaded";
+                return false;
+            }
+
+            NSString* featureName = [NSString stringWithUTF8String:name.c_str()];
+            MLFeatureDescription* output = model.modelDescription.outputDescriptionsByName[featureName];
+            if (!output || output.type != MLFeatureTypeMultiArray) {
+                lastError = "No multi-array output named " + name;
+                return false;
+            }
+
+            if (@available(macOS 11.0, *)) {
+                MLMultiArray* array = wrapTensor(tensor, lastError);
+                if (!array) {
+                    return false;
+                }
+                if (!outputBackings) {
+                    outputBackings = [[NSMutableDictionary alloc] init];
+                    predictionOptions = [[MLPredictionOptions alloc] init];
+                }
+                outputBackings[featureName] = array;
+                predictionOptions.outputBackings = outputBackings;
+                return true;
+            }
+
+            lastError = "Output backings require macOS 11";
+            return false;
+        }
+    }
+
     bool setDictionaryInput(const std::string& name, const std::map<std::string, double>& dict) {
         @autoreleasepool {
             NSMutableDictionary<NSString*, NSNumber*>* nsDict = [NSMutableDictionary dictionary];
@@ -345,7 +521,7 @@ struct GenericModel::Impl {
                 return false;
             }
 
-            inputFeatures[featureName] = featureValue;
+            setFeature(featureName, featureValue);
             return true;
         }
     }
@@ -358,13 +534,21 @@ struct GenericModel::Impl {
             }
 
             // Create feature provider from input features
-            MLDictionaryFeatureProvider* provider = [[MLDictionaryFeatureProvider alloc]
-                                                     initWithDictionary:inputFeatures
-                                                     error:nil];
+            if (!inputProvider) {
+                inputProvider = [[MLDictionaryFeatureProvider alloc] initWithDictionary:inputFeatures
+                                                                                  error:nil];
+            }
 
-            // Run prediction
+            // Run prediction (into the output backings, if any)
+            OF_PROFILE_SCOPE("GenericModel inference");
             NSError* error = nil;
-            outputFeatures = [model predictionFromFeatures:provider error:&error];
+            if (predictionOptions) {
+                outputFeatures = [model predictionFromFeatures:inputProvider
+                                                       options:predictionOptions
+                                                         error:&error];
+            } else {
+                outputFeatures = [model predictionFromFeatures:inputProvider error:&error];
+            }
 
             if (error || !outputFeatures) {
                 lastError = error ? [[error localizedDescription] UTF8String] : "Prediction failed";
@@ -634,11 +818,40 @@ bool GenericModel::load(const std::string& modelPath, const GenericModelConfig&
     return impl_->loadModel(modelPath, config);
 }
 
+void GenericModel::loadAsync(const std::string& modelPath, LoadCallback callback) {
+    loadAsync(modelPath, GenericModelConfig(), callback);
+}
+
+void GenericModel::loadAsync(const std::string& modelPath, const GenericModelConfig& config,
+                             LoadCallback callback) {
+    @autoreleasepool {
+        // Only called while this load is current, so impl is alive
+        Impl* impl = impl_.get();
+        std::string path = modelPath;
+        GenericModelConfig cfg = config;
+
+        LoadModelAsync(Impl::modelURLForPath(modelPath), Impl::createConfiguration(config), impl->loads,
+                       ^(MLModel* loaded, NSError* error) {
+            bool success = false;
+            if (loaded) {
+                success = impl->installModel(loaded, path, cfg);
+            } else {
+                impl->lastError = error ? [[error localizedDescription] UTF8String] : "Failed to load model";
+            }
+            if (callback) {
+                callback(success);
+            }
+        });
+    }
+}
+
 void GenericModel::unload() {
+    impl_->loads->next();
     impl_->model = nil;
     impl_->outputFeatures = nil;
     impl_->info = GenericModelInfo();
     impl_->clearInputs();
+    impl_->clearOutputBackings();
 }
 
 // Input setters
@@ -700,10 +913,21 @@ void GenericModel::setInput(const std::string& name, const std::map<std::string,
     impl_->setDictionaryInput(name, dict);
 }
 
+bool GenericModel::setInput(const std::string& name, const TensorBuffer& tensor) {
+    return impl_->setTensorInput(name, tensor);
+}
+
 void GenericModel::clearInputs() {
-    @autoreleasepool {
-        [impl_->inputFeatures removeAllObjects];
-    }
+    impl_->clearInputs();
+}
+
+// Output backings
+bool GenericModel::setOutputBacking(const std::string& name, const TensorBuffer& tensor) {
+    return impl_->setOutputBacking(name, tensor);
+}
+
+void GenericModel::clearOutputBackings() {
+    impl_->clearOutputBackings();
 }
 
 // Prediction
@@ -1,6 +1,8 @@
 #include "ImageClassifier.h"
 #include "ofPixels.h"
 #include "ofTexture.h"
+#include "ModelCache.h"
+#include "ofProfiler.h"
 #include <Foundation/Foundation.h>
 #include <CoreML/CoreML.h>
 #include <Vision/Vision.h>
@@ -62,7 +64,7 @@ struct ImageClassifier::Impl {
 
             // Load model
             NSError* error = nil;
-            model = [MLModel modelWithContentsOfURL:modelURL configuration:configuration error:&error];
+            model = LoadCachedModel(modelURL, configuration, &error);
 
             if (error || !model) {
                 lastError = error ? [[error localizedDescription] UTF8String] : "Failed to load model";
@@ -202,6 +204,7 @@ struct ImageClassifier::Impl {
             VNCoreMLRequest* request = [[VNCoreMLRequest alloc] initWithModel:visionModel];
 
             // Perform inference
+            OF_PROFILE_SCOPE("ImageClassifier inference");
             NSError* error = nil;
             BOOL success = [handler performRequests:@[request] error:&error];
 
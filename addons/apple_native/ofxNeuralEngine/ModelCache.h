@@ -0,0 +1,55 @@
+#pragma once
+
+// ModelCache - compiled Core ML models kept across launches
+// Objective-C++ only: shared by the ofxNeuralEngine models and ofxSharp's
+// SharpModel, included by their .mm files
+//
+// MLModel loads compiled models (.mlmodelc) only. .mlmodel and .mlpackage
+// files are compiled on first use, which takes seconds, into a cache
+// directory keyed by a hash of the model's contents: later launches load
+// the compiled copy at once, and an edited model gets a new one.
+
+#import <CoreML/CoreML.h>
+#import <Foundation/Foundation.h>
+#include <cstdint>
+#include <memory>
+
+namespace NeuralEngine {
+
+// Load a model through the cache: .mlmodelc as it is, other models from
+// their cached compiled copy, compiling it on a miss. Blocking; safe on any
+// thread. nil on failure, with the reason in error.
+MLModel* LoadCachedModel(NSURL* modelURL, MLModelConfiguration* configuration, NSError** error);
+
+// Compiled copy of a model (compiling it on a miss); modelURL itself for
+// .mlmodelc. nil on failure, with the reason in error.
+NSURL* GetCompiledModelURL(NSURL* modelURL, NSError** error);
+
+// Run one prediction on zero-filled inputs, so the first real prediction
+// doesn't pay for loading the model onto the compute units. Call off the
+// main thread. Returns false for inputs it can't make (sequences, dictionaries).
+bool PrewarmModel(MLModel* model);
+
+// Generation of one owner's model loads, so a late asynchronous load can't
+// replace a newer model or reach a destroyed owner. The owner holds it by
+// shared_ptr and calls next() from load() and unload(); LoadModelAsync()
+// calls it too. Main thread only.
+struct ModelLoadGeneration {
+    uint64_t current = 0;
+
+    uint64_t next() { return ++current; }
+};
+
+// Load a model through the cache and prewarm it off the main thread, then
+// call done on the main queue with the model, or nil and the reason. done
+// is dropped if the generation's owner has been destroyed, or has loaded,
+// unloaded or started another load since.
+void LoadModelAsync(NSURL* modelURL, MLModelConfiguration* configuration,
+                    const std::shared_ptr<ModelLoadGeneration>& generation,
+                    void (^done)(MLModel* model, NSError* error));
+
+// Directory compiled models are cached in:
+// ~/Library/Caches/<bundle identifier>/CompiledModels
+NSURL* GetModelCacheDirectory();
+
+} // namespace NeuralEngine
@@ -0,0 +1,263 @@
+#import "ModelCache.h"
+#import <CommonCrypto/CommonDigest.h>
+#import <CoreVideo/CoreVideo.h>
+#include <dispatch/dispatch.h>
+#include <cstring>
+
+namespace NeuralEngine {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+// Bytes read at a time while hashing a model
+static constexpr NSUInteger kHashChunkSize = 1 << 20;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+namespace {
+
+void HashFile(NSURL* fileURL, CC_SHA256_CTX& context) {
+    NSFileHandle* handle = [NSFileHandle fileHandleForReadingFromURL:fileURL error:nil];
+    if (!handle) {
+        return;
+    }
+    for (;;) {
+        @autoreleasepool {
+            NSData* chunk = [handle readDataOfLength:kHashChunkSize];
+            if (chunk.length == 0) {
+                break;
+            }
+            CC_SHA256_Update(&context, chunk.bytes, static_cast<CC_LONG>(chunk.length));
+        }
+    }
+    [handle closeFile];
+}
+
+// Hex SHA-256 of a model file, or of every file in a model package with
+// its relative path, so moving a model keeps its cache entry
+NSString* HashModel(NSURL* modelURL) {
+    CC_SHA256_CTX context;
+    CC_SHA256_Init(&context);
+
+    NSNumber* isDirectory = nil;
+    [modelURL getResourceValue:&isDirectory forKey:NSURLIsDirectoryKey error:nil];
+    if (isDirectory.boolValue) {
+        NSFileManager* fileManager = [NSFileManager defaultManager];
+        NSArray<NSString*>* paths = [[fileManager subpathsOfDirectoryAtPath:modelURL.path error:nil]
+            sortedArrayUsingSelector:@selector(compare:)];
+        for (NSString* path in paths) {
+            NSURL* fileURL = [modelURL URLByAppendingPathComponent:path];
+            NSNumber* isFile = nil;
+            [fileURL getResourceValue:&isFile forKey:NSURLIsRegularFileKey error:nil];
+            if (!isFile.boolValue) {
+                continue;
+            }
+            const char* name = path.UTF8String;
+            CC_SHA256_Update(&context, name, static_cast<CC_LONG>(std::strlen(name) + 1));
+            HashFile(fileURL, context);
+        }
+    } else {
+        HashFile(modelURL, context);
+    }
+
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(digest, &context);
+    NSMutableString* hex = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (unsigned char byte : digest) {
+        [hex appendFormat:@"%02x", byte];
+    }
+    return hex;
+}
+
+MLFeatureValue* ZeroImage(MLImageConstraint* constraint) {
+    if (!constraint || constraint.pixelsWide == 0 || constraint.pixelsHigh == 0) {
+        return nil;
+    }
+    NSDictionary* attributes = @{(id)kCVPixelBufferIOSurfacePropertiesKey: @{}};
+    CVPixelBufferRef buffer = nullptr;
+    if (CVPixelBufferCreate(kCFAllocatorDefault, constraint.pixelsWide, constraint.pixelsHigh,
+                            constraint.pixelFormatType, (__bridge CFDictionaryRef)attributes,
+                            &buffer) != kCVReturnSuccess) {
+        return nil;
+    }
+    CVPixelBufferLockBaseAddress(buffer, 0);
+    if (CVPixelBufferIsPlanar(buffer)) {
+        for (size_t plane = 0; plane < CVPixelBufferGetPlaneCount(buffer); plane++) {
+            std::memset(CVPixelBufferGetBaseAddressOfPlane(buffer, plane), 0,
+                        CVPixelBufferGetBytesPerRowOfPlane(buffer, plane) *
+                        CVPixelBufferGetHeightOfPlane(buffer, plane));
+        }
+    } else {
+        std::memset(CVPixelBufferGetBaseAddress(buffer), 0, CVPixelBufferGetDataSize(buffer));
+    }
+    CVPixelBufferUnlockBaseAddress(buffer, 0);
+
+    MLFeatureValue* value = [MLFeatureValue featureValueWithPixelBuffer:buffer];
+    CVPixelBufferRelease(buffer);
+    return value;
+}
+
+MLFeatureValue* ZeroMultiArray(MLMultiArrayConstraint* constraint) {
+    if (!constraint) {
+        return nil;
+    }
+
+    // Flexible shapes: the first enumerated shape, or the smallest in range
+    NSArray<NSNumber*>* shape = constraint.shape;
+    MLMultiArrayShapeConstraint* shapeConstraint = constraint.shapeConstraint;
+    if (shapeConstraint.type == MLMultiArrayShapeConstraintTypeEnumerated &&
+        shapeConstraint.enumeratedShapes.count > 0) {
+        shape = shapeConstraint.enumeratedShapes.firstObject;
+    } else if (shapeConstraint.type == MLMultiArrayShapeConstraintTypeRange) {
+        NSMutableArray<NSNumber*>* lowest = [NSMutableArray array];
+        for (NSValue* range in shapeConstraint.sizeRangeForDimension) {
+            [lowest addObject:@(MAX(range.rangeValue.location, 1))];
+        }
+        shape = lowest;
+    }
+    if (shape.count == 0) {
+        return nil;
+    }
+
+    NSError* error = nil;
+    MLMultiArray* array = [[MLMultiArray alloc] initWithShape:shape dataType:constraint.dataType error:&error];
+    if (!array) {
+        return nil;
+    }
+    const size_t elementSize = (constraint.dataType & 0xFFFF) / 8;
+    std::memset(array.dataPointer, 0, array.strides.firstObject.unsignedLongValue *
+                                      shape.firstObject.unsignedLongValue * elementSize);
+    return [MLFeatureValue featureValueWithMultiArray:array];
+}
+
+MLFeatureValue* ZeroFeature(MLFeatureDescription* description) {
+    switch (description.type) {
+        case MLFeatureTypeImage:
+            return ZeroImage(description.imageConstraint);
+        case MLFeatureTypeMultiArray:
+            return ZeroMultiArray(description.multiArrayConstraint);
+        case MLFeatureTypeInt64:
+            return [MLFeatureValue featureValueWithInt64:0];
+        case MLFeatureTypeDouble:
+            return [MLFeatureValue featureValueWithDouble:0.0];
+        case MLFeatureTypeString:
+            return [MLFeatureValue featureValueWithString:@""];
+        default:
+            return nil;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// ModelCache
+// ============================================================================
+
+NSURL* GetModelCacheDirectory() {
+    NSURL* caches = [[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory
+                                                           inDomains:NSUserDomainMask].firstObject;
+    NSString* bundle = [NSBundle mainBundle].bundleIdentifier ?: @"oflike-metal";
+    return [[caches URLByAppendingPathComponent:bundle] URLByAppendingPathComponent:@"CompiledModels"];
+}
+
+NSURL* GetCompiledModelURL(NSURL* modelURL, NSError** error) {
+    // No autorelease pool: errors are returned autoreleased
+    if ([modelURL.pathExtension isEqualToString:@"mlmodelc"]) {
+        return modelURL;
+    }
+
+    NSFileManager* fileManager = [NSFileManager defaultManager];
+    if (![fileManager fileExistsAtPath:modelURL.path]) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileNoSuchFileError
+                                     userInfo:@{NSLocalizedDescriptionKey:
+                                         [NSString stringWithFormat:@"Model not found: %@", modelURL.path]}];
+        }
+        return nil;
+    }
+
+    NSURL* directory = GetModelCacheDirectory();
+    NSString* name = [NSString stringWithFormat:@"%@-%@.mlmodelc",
+                      modelURL.URLByDeletingPathExtension.lastPathComponent, HashModel(modelURL)];
+    NSURL* cachedURL = [directory URLByAppendingPathComponent:name];
+    if ([fileManager fileExistsAtPath:cachedURL.path]) {
+        return cachedURL;
+    }
+
+    NSURL* compiledURL = [MLModel compileModelAtURL:modelURL error:error];
+    if (!compiledURL) {
+        return nil;
+    }
+
+    // Compiled into a temporary directory; a failed move (another load
+    // cached it first, or the cache isn't writable) keeps whichever exists
+    [fileManager createDirectoryAtURL:directory withIntermediateDirectories:YES attributes:nil error:nil];
+    if ([fileManager moveItemAtURL:compiledURL toURL:cachedURL error:nil] ||
+        [fileManager fileExistsAtPath:cachedURL.path]) {
+        return cachedURL;
+    }
+    NSLog(@"[ofxNeuralEngine] Warning: could not cache compiled model at %@", cachedURL.path);
+    return compiledURL;
+}
+
+MLModel* LoadCachedModel(NSURL* modelURL, MLModelConfiguration* configuration, NSError** error) {
+    // No autorelease pool: errors are returned autoreleased
+    NSURL* compiledURL = GetCompiledModelURL(modelURL, error);
+    if (!compiledURL) {
+        return nil;
+    }
+    return [MLModel modelWithContentsOfURL:compiledURL configuration:configuration error:error];
+}
+
+bool PrewarmModel(MLModel* model) {
+    @autoreleasepool {
+        if (!model) {
+            return false;
+        }
+
+        NSMutableDictionary<NSString*, MLFeatureValue*>* inputs = [NSMutableDictionary dictionary];
+        for (MLFeatureDescription* description in model.modelDescription.inputDescriptionsByName.allValues) {
+            MLFeatureValue* value = ZeroFeature(description);
+            if (value) {
+                inputs[description.name] = value;
+            } else if (!description.isOptional) {
+                return false;
+            }
+        }
+
+        NSError* error = nil;
+        MLDictionaryFeatureProvider* provider = [[MLDictionaryFeatureProvider alloc] initWithDictionary:inputs
+                                                                                                  error:&error];
+        return provider && [model predictionFromFeatures:provider error:&error] != nil;
+    }
+}
+
+void LoadModelAsync(NSURL* modelURL, MLModelConfiguration* configuration,
+                    const std::shared_ptr<ModelLoadGeneration>& generation,
+                    void (^done)(MLModel* model, NSError* error)) {
+    const uint64_t ticket = generation->next();
+    std::weak_ptr<ModelLoadGeneration> owner = generation;
+
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        @autoreleasepool {
+            NSError* error = nil;
+            MLModel* loaded = LoadCachedModel(modelURL, configuration, &error);
+            if (loaded) {
+                PrewarmModel(loaded);
+            }
+
+            dispatch_async(dispatch_get_main_queue(), ^{
+                const std::shared_ptr<ModelLoadGeneration> current = owner.lock();
+                if (!current || current->current != ticket) {
+                    return;
+                }
+                done(loaded, error);
+            });
+        }
+    });
+}
+
+} // namespace NeuralEngine
@@ -0,0 +1,47 @@
+#pragma once
+
+// NeuralEngineBuffers - CVPixelBuffer helpers shared by the ofxNeuralEngine models
+// Objective-C++ only: included by the models' .mm files, never by their headers
+
+#import <CoreML/CoreML.h>
+#import <CoreVideo/CoreVideo.h>
+#import <Metal/Metal.h>
+#import <Vision/Vision.h>
+#include "ofTexture.h"
+
+namespace NeuralEngine {
+
+// Pixel buffer over the IOSurface behind an ofTexture, such as a camera
+// frame wrapped by CVMetalTextureCache, so Vision reads the texture in
+// place. nullptr for textures in their own memory (read them back instead).
+// Release with CVPixelBufferRelease.
+inline CVPixelBufferRef CreatePixelBufferFromTexture(const oflike::ofTexture& texture) {
+    id<MTLTexture> mtlTexture = (__bridge id<MTLTexture>)texture.getNativeHandle();
+    IOSurfaceRef surface = mtlTexture.iosurface;
+    if (!surface) {
+        return nullptr;
+    }
+    CVPixelBufferRef buffer = nullptr;
+    if (CVPixelBufferCreateWithIOSurface(kCFAllocatorDefault, surface, nullptr, &buffer) != kCVReturnSuccess) {
+        return nullptr;
+    }
+    return buffer;
+}
+
+// Image output of a performed request: a pixel buffer observation or an
+// image feature value. nullptr for other outputs (multi-arrays).
+inline CVPixelBufferRef GetResultPixelBuffer(VNRequest* request) {
+    VNObservation* observation = request.results.firstObject;
+    if ([observation isKindOfClass:[VNPixelBufferObservation class]]) {
+        return ((VNPixelBufferObservation*)observation).pixelBuffer;
+    }
+    if ([observation isKindOfClass:[VNCoreMLFeatureValueObservation class]]) {
+        MLFeatureValue* featureValue = ((VNCoreMLFeatureValueObservation*)observation).featureValue;
+        if (featureValue.type == MLFeatureTypeImage) {
+            return featureValue.imageBufferValue;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace NeuralEngine
@@ -12,13 +12,17 @@
 // - Support for multiple people
 // - Real-time performance
 // - Neural Engine acceleration
-// - Direct GPU texture output
+// - Direct GPU texture output (zero-copy masks)
+// - Frame-deadline masks with adaptive quality (segmentFrame)
 //
 // Example usage:
 //   PersonSegmentation seg;
 //   seg.setup();
 //   ofPixels mask = seg.segment(myImage);
 //   // Use mask for compositing, background replacement, etc.
+//
+//   // Per camera frame, on the GPU, never later than 8 ms:
+//   seg.segmentFrame(pixelBuffer, maskTexture, 8.0f);
 
 #include <string>
 #include <vector>
@@ -58,6 +62,12 @@ struct PersonSegmentationConfig {
 
     // Smooth mask edges (reduces aliasing)
     bool smoothEdges = true;
+
+    // Adaptive quality for segmentFrame(): step the quality level down while
+    // segmentation takes longer than latencyBudgetMs, and back up (to at
+    // most `quality`) once it runs well within the budget
+    bool adaptiveQuality = false;
+    float latencyBudgetMs = 20.0f;
 };
 
 // Information about segmentation result
@@ -137,6 +147,32 @@ public:
     // Returns segmentation result with mask and metadata
     SegmentationResult segment(oflike::ofTexture& texture);
 
+    // ============================================================================
+    // GPU Masks
+    // ============================================================================
+
+    // Generate person mask into a texture that samples Vision's mask in place
+    // (grayscale, through CVMetalTextureCache); outputScale and smoothEdges
+    // are CPU steps and don't apply. Call on the main thread.
+    // Returns true if a person mask was generated
+    bool segmentToTexture(const oflike::ofPixels& pixels, oflike::ofTexture& mask);
+
+    // Same from a CVPixelBufferRef (camera frame), read in place
+    bool segmentToTexture(void* pixelBuffer, oflike::ofTexture& mask);
+
+    // Per-frame mask on a deadline: segment a CVPixelBufferRef (retained) in
+    // the background, wait at most deadlineMs for it, and show the newest
+    // finished mask in the texture; the previous mask stays if this frame's
+    // isn't ready. A frame arriving while one is still running is skipped.
+    // Call on the main thread. Returns false until a first mask is ready
+    bool segmentFrame(void* pixelBuffer, oflike::ofTexture& mask, float deadlineMs);
+
+    // Quality level segmentFrame() runs at (lowered by adaptiveQuality)
+    SegmentationQuality getCurrentQuality() const;
+
+    // Average segmentFrame() latency in milliseconds
+    float getAverageLatency() const;
+
     // ============================================================================
     // Async Segmentation
     // ============================================================================
@@ -158,6 +194,18 @@ public:
     // Check if async operation is in progress
     bool isProcessing() const;
 
+    // ============================================================================
+    // Frame Scheduling (see FrameScheduler)
+    // ============================================================================
+
+    // Vision request (VNRequest*) a shared handler performs for each
+    // frame; separate from segment()'s, nullptr until setup
+    void* getFrameRequest();
+
+    // Mask from the frame request after the handler performed it on an
+    // inputWidth x inputHeight frame
+    SegmentationResult getFrameResults(size_t inputWidth, size_t inputHeight);
+
     // ============================================================================
     // Configuration
     // ============================================================================
@@ -1,10 +1,16 @@
 #import "PersonSegmentation.h"
 #import "../../oflike/image/ofPixels.h"
 #import "../../oflike/image/ofTexture.h"
+#import "../../oflike/video/VideoFrameTexture.h"
+#import "NeuralEngineBuffers.h"
+#import "../../oflike/utils/ofProfiler.h"
 #import <Vision/Vision.h>
 #import <Metal/Metal.h>
 #import <CoreImage/CoreImage.h>
 #import <Accelerate/Accelerate.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
 
 using namespace oflike;
 
@@ -118,26 +124,67 @@ ofPixels SegmentationResult::getFeatheredMask(float radius) const {
     return feathered;
 }
 
+// ============================================================================
+// Adaptive Quality
+// ============================================================================
+
+// Weight of the newest frame in the average latency
+static constexpr float kLatencySmoothing = 0.2f;
+
+// Frames well within budget (under half) before stepping the quality up
+static constexpr int kHeadroomFrames = 30;
+
+static VNGeneratePersonSegmentationRequestQualityLevel toVisionQuality(SegmentationQuality quality) {
+    switch (quality) {
+        case SegmentationQuality::Fast:
+            return VNGeneratePersonSegmentationRequestQualityLevelFast;
+        case SegmentationQuality::Accurate:
+            return VNGeneratePersonSegmentationRequestQualityLevelAccurate;
+        case SegmentationQuality::Balanced:
+        default:
+            return VNGeneratePersonSegmentationRequestQualityLevelBalanced;
+    }
+}
+
 // ============================================================================
 // PersonSegmentation::Impl
 // ============================================================================
 
 struct PersonSegmentation::Impl {
     VNGeneratePersonSegmentationRequest* request;
+    VNGeneratePersonSegmentationRequest* frameRequest = nil;   // Performed by a FrameScheduler
     PersonSegmentationConfig config;
     std::string lastError;
     bool isSetup;
     bool isProcessing;
     dispatch_queue_t processingQueue;
+    VideoFrameTexture maskFrames;       // Masks drawn in place by segmentToTexture()/segmentFrame()
+
+    // segmentFrame(): one frame at a time on processingQueue
+    VNGeneratePersonSegmentationRequest* deadlineRequest = nil;     // Used on the queue only
+    dispatch_group_t frameGroup;
+    mutable std::mutex frameMutex;
+    bool frameInFlight = false;
+    CVPixelBufferRef readyMask = nullptr;                   // Finished, not yet shown
+    std::string frameError;
+    SegmentationQuality currentQuality = SegmentationQuality::Balanced;
+    float averageLatency = 0.0f;
+    int headroomFrames = 0;
+    bool hasFrameMask = false;                              // Main thread
 
     Impl() : request(nil), isSetup(false), isProcessing(false) {
         @autoreleasepool {
             processingQueue = dispatch_queue_create("com.oflike.metal.person_segmentation", DISPATCH_QUEUE_SERIAL);
+            frameGroup = dispatch_group_create();
         }
     }
 
     ~Impl() {
+        dispatch_group_wait(frameGroup, DISPATCH_TIME_FOREVER);
         shutdown();
+        if (readyMask) {
+            CVPixelBufferRelease(readyMask);
+        }
     }
 
     void shutdown() {
@@ -145,6 +192,7 @@ struct PersonSegmentation::Impl {
             if (request) {
                 request = nil;
             }
+            frameRequest = nil;
             isSetup = false;
         }
     }
@@ -157,24 +205,23 @@ struct PersonSegmentation::Impl {
                 lastError = "Failed to create VNGeneratePersonSegmentationRequest";
                 return false;
             }
+            configureRequest(request);
 
-            // Configure quality level
-            switch (config.quality) {
-                case SegmentationQuality::Fast:
-                    request.qualityLevel = VNGeneratePersonSegmentationRequestQualityLevelFast;
-                    break;
-                case SegmentationQuality::Balanced:
-                    request.qualityLevel = VNGeneratePersonSegmentationRequestQualityLevelBalanced;
-                    break;
-                case SegmentationQuality::Accurate:
-                    request.qualityLevel = VNGeneratePersonSegmentationRequestQualityLevelAccurate;
-                    break;
+            // The frame request picks up the new configuration too
+            if (frameRequest) {
+                configureRequest(frameRequest);
             }
+            return true;
+        }
+    }
 
-            // Configure output scale
-            request.outputPixelFormat = kCVPixelFormatType_OneComponent8;
+    void configureRequest(VNGeneratePersonSegmentationRequest* target) {
+        @autoreleasepool {
+            // Configure quality level
+            target.qualityLevel = toVisionQuality(config.quality);
 
-            return true;
+            // Configure output scale
+            target.outputPixelFormat = kCVPixelFormatType_OneComponent8;
         }
     }
 
@@ -187,54 +234,8 @@ struct PersonSegmentation::Impl {
                 return result;
             }
 
-            // Convert ofPixels to CGImage
-            size_t width = pixels.getWidth();
-            size_t height = pixels.getHeight();
-            size_t channels = pixels.getNumChannels();
-            size_t bitsPerComponent = 8;
-            size_t bytesPerRow = width * channels;
-
-            CGColorSpaceRef colorSpace = nullptr;
-            CGBitmapInfo bitmapInfo = kCGBitmapByteOrderDefault;
-
-            if (channels == 4) {
-                colorSpace = CGColorSpaceCreateDeviceRGB();
-                bitmapInfo |= kCGImageAlphaPremultipliedLast;
-            } else if (channels == 3) {
-                colorSpace = CGColorSpaceCreateDeviceRGB();
-                bitmapInfo |= kCGImageAlphaNoneSkipLast;
-            } else if (channels == 1) {
-                colorSpace = CGColorSpaceCreateDeviceGray();
-            } else {
-                result.errorMessage = "Unsupported pixel format";
-                return result;
-            }
-
-            CGDataProviderRef provider = CGDataProviderCreateWithData(
-                nullptr,
-                pixels.getData(),
-                pixels.size(),
-                nullptr
-            );
-
-            CGImageRef cgImage = CGImageCreate(
-                width, height,
-                bitsPerComponent,
-                bitsPerComponent * channels,
-                bytesPerRow,
-                colorSpace,
-                bitmapInfo,
-                provider,
-                nullptr,
-                false,
-                kCGRenderingIntentDefault
-            );
-
-            CGColorSpaceRelease(colorSpace);
-            CGDataProviderRelease(provider);
-
+            CGImageRef cgImage = createImage(pixels, result.errorMessage);
             if (!cgImage) {
-                result.errorMessage = "Failed to create CGImage";
                 return result;
             }
 
@@ -243,6 +244,7 @@ struct PersonSegmentation::Impl {
                 initWithCGImage:cgImage
                 options:@{}];
 
+            OF_PROFILE_SCOPE("PersonSegmentation inference");
             NSError* error = nil;
             BOOL success = [handler performRequests:@[request] error:&error];
 
@@ -253,8 +255,213 @@ struct PersonSegmentation::Impl {
                 return result;
             }
 
+            return extractResult(request, pixels.getWidth(), pixels.getHeight());
+        }
+    }
+
+    // CGImage over pixels (not copied); nullptr and error for unsupported formats
+    static CGImageRef createImage(const ofPixels& pixels, std::string& error) {
+        // Convert ofPixels to CGImage
+        size_t width = pixels.getWidth();
+        size_t height = pixels.getHeight();
+        size_t channels = pixels.getNumChannels();
+        size_t bitsPerComponent = 8;
+        size_t bytesPerRow = width * channels;
+
+        CGColorSpaceRef colorSpace = nullptr;
+        CGBitmapInfo bitmapInfo = kCGBitmapByteOrderDefault;
+
+        if (channels == 4) {
+            colorSpace = CGColorSpaceCreateDeviceRGB();
+            bitmapInfo |= kCGImageAlphaPremultipliedLast;
+        } else if (channels == 3) {
+            colorSpace = CGColorSpaceCreateDeviceRGB();
+            bitmapInfo |= kCGImageAlphaNoneSkipLast;
+        } else if (channels == 1) {
+            colorSpace = CGColorSpaceCreateDeviceGray();
+        } else {
+            error = "Unsupported pixel format";
+            return nullptr;
+        }
+
+        CGDataProviderRef provider = CGDataProviderCreateWithData(
+            nullptr,
+            pixels.getData(),
+            pixels.size(),
+            nullptr
+        );
+
+        CGImageRef cgImage = CGImageCreate(
+            width, height,
+            bitsPerComponent,
+            bitsPerComponent * channels,
+            bytesPerRow,
+            colorSpace,
+            bitmapInfo,
+            provider,
+            nullptr,
+            false,
+            kCGRenderingIntentDefault
+        );
+
+        CGColorSpaceRelease(colorSpace);
+        CGDataProviderRelease(provider);
+
+        if (!cgImage) {
+            error = "Failed to create CGImage";
+        }
+        return cgImage;
+    }
+
+    // Perform the request and show its mask in a texture; main thread
+    bool segmentToTexture(VNImageRequestHandler* handler, ofTexture& mask) {
+        @autoreleasepool {
+            OF_PROFILE_SCOPE("PersonSegmentation inference");
+            NSError* error = nil;
+            if (![handler performRequests:@[request] error:&error]) {
+                lastError = error ? error.localizedDescription.UTF8String : "Segmentation failed";
+                return false;
+            }
+
+            CVPixelBufferRef maskBuffer = GetResultPixelBuffer(request);
+            if (!maskBuffer) {
+                lastError = "No person detected in image";
+                return false;
+            }
+            maskFrames.setFrame(maskBuffer, mask);
+            return true;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Frame-deadline segmentation
+    // ------------------------------------------------------------------------
+
+    bool segmentFrame(CVPixelBufferRef pixelBuffer, ofTexture& mask, float deadlineMs) {
+        @autoreleasepool {
+            bool submit = false;
+            {
+                std::lock_guard<std::mutex> lock(frameMutex);
+                if (!frameInFlight) {
+                    frameInFlight = true;
+                    submit = true;
+                }
+            }
+
+            if (submit) {
+                // Settings for this frame, read on the main thread
+                const SegmentationQuality maxQuality = config.quality;
+                const bool adaptive = config.adaptiveQuality;
+                const float budget = config.latencyBudgetMs;
+
+                CVPixelBufferRetain(pixelBuffer);
+                dispatch_group_enter(frameGroup);
+                dispatch_async(processingQueue, ^{
+                    runFrame(pixelBuffer, maxQuality, adaptive, budget);
+                    CVPixelBufferRelease(pixelBuffer);
+                    dispatch_group_leave(frameGroup);
+                });
+            }
+
+            // Wait out the deadline for the frame in flight
+            if (deadlineMs > 0.0f) {
+                dispatch_group_wait(frameGroup,
+                                    dispatch_time(DISPATCH_TIME_NOW, static_cast<int64_t>(deadlineMs * NSEC_PER_MSEC)));
+            }
+
+            CVPixelBufferRef finished = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(frameMutex);
+                finished = readyMask;
+                readyMask = nullptr;
+                if (!frameError.empty()) {
+                    lastError = frameError;
+                    frameError.clear();
+                }
+            }
+
+            // No new mask: the texture keeps showing the previous one
+            if (finished) {
+                maskFrames.setFrame(finished, mask);
+                CVPixelBufferRelease(finished);
+                hasFrameMask = true;
+            }
+            return hasFrameMask;
+        }
+    }
+
+    // Queue: segment one frame and adapt the quality level to its latency
+    void runFrame(CVPixelBufferRef pixelBuffer, SegmentationQuality maxQuality, bool adaptive, float budget) {
+        @autoreleasepool {
+            SegmentationQuality quality;
+            {
+                std::lock_guard<std::mutex> lock(frameMutex);
+                if (!adaptive || currentQuality > maxQuality) {
+                    currentQuality = maxQuality;
+                }
+                quality = currentQuality;
+            }
+
+            if (!deadlineRequest) {
+                deadlineRequest = [[VNGeneratePersonSegmentationRequest alloc] init];
+                deadlineRequest.outputPixelFormat = kCVPixelFormatType_OneComponent8;
+            }
+            deadlineRequest.qualityLevel = toVisionQuality(quality);
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+            VNImageRequestHandler* handler = [[VNImageRequestHandler alloc] initWithCVPixelBuffer:pixelBuffer
+                                                                                         options:@{}];
+            OF_PROFILE_SCOPE("PersonSegmentation inference");
+            NSError* error = nil;
+            BOOL success = [handler performRequests:@[deadlineRequest] error:&error];
+            std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - startTime;
+            const float latency = static_cast<float>(duration.count());
+
+            CVPixelBufferRef maskBuffer = success ? GetResultPixelBuffer(deadlineRequest) : nullptr;
+
+            std::lock_guard<std::mutex> lock(frameMutex);
+            frameInFlight = false;
+            if (maskBuffer) {
+                if (readyMask) {
+                    CVPixelBufferRelease(readyMask);
+                }
+                readyMask = CVPixelBufferRetain(maskBuffer);
+            } else {
+                frameError = error ? error.localizedDescription.UTF8String : "No person detected in image";
+            }
+
+            averageLatency = averageLatency > 0.0f
+                ? averageLatency + (latency - averageLatency) * kLatencySmoothing
+                : latency;
+            if (!adaptive) {
+                return;
+            }
+
+            // Step down at once when over budget; up only after sustained headroom.
+            // The average restarts at each new level
+            if (averageLatency > budget && quality > SegmentationQuality::Fast) {
+                currentQuality = static_cast<SegmentationQuality>(static_cast<int>(quality) - 1);
+                averageLatency = 0.0f;
+                headroomFrames = 0;
+            } else if (averageLatency < budget * 0.5f && quality < maxQuality) {
+                if (++headroomFrames >= kHeadroomFrames) {
+                    currentQuality = static_cast<SegmentationQuality>(static_cast<int>(quality) + 1);
+                    averageLatency = 0.0f;
+                    headroomFrames = 0;
+                }
+            } else {
+                headroomFrames = 0;
+            }
+        }
+    }
+
+    // Mask from a request that has been performed on a width x height image
+    SegmentationResult extractResult(VNGeneratePersonSegmentationRequest* performed, size_t width, size_t height) {
+        @autoreleasepool {
+            SegmentationResult result;
+
             // Extract results
-            NSArray<VNPixelBufferObservation*>* observations = request.results;
+            NSArray<VNPixelBufferObservation*>* observations = performed.results;
             if (!observations || observations.count == 0) {
                 result.errorMessage = "No person detected in image";
                 return result;
@@ -373,6 +580,10 @@ bool PersonSegmentation::setup(const PersonSegmentationConfig& config) {
         }
 
         pImpl->config = config;
+        {
+            std::lock_guard<std::mutex> lock(pImpl->frameMutex);
+            pImpl->currentQuality = config.quality;
+        }
 
         if (!pImpl->setupRequest()) {
             return false;
@@ -423,6 +634,56 @@ SegmentationResult PersonSegmentation::segment(ofTexture& texture) {
     return pImpl->performSegmentation(pixels);
 }
 
+bool PersonSegmentation::segmentToTexture(const ofPixels& pixels, ofTexture& mask) {
+    @autoreleasepool {
+        if (!pImpl->isSetup) {
+            pImpl->lastError = "PersonSegmentation not setup";
+            return false;
+        }
+
+        CGImageRef cgImage = Impl::createImage(pixels, pImpl->lastError);
+        if (!cgImage) {
+            return false;
+        }
+        VNImageRequestHandler* handler = [[VNImageRequestHandler alloc] initWithCGImage:cgImage options:@{}];
+        bool segmented = pImpl->segmentToTexture(handler, mask);
+        CGImageRelease(cgImage);
+        return segmented;
+    }
+}
+
+bool PersonSegmentation::segmentToTexture(void* pixelBuffer, ofTexture& mask) {
+    @autoreleasepool {
+        if (!pImpl->isSetup || !pixelBuffer) {
+            pImpl->lastError = pImpl->isSetup ? "Invalid pixel buffer" : "PersonSegmentation not setup";
+            return false;
+        }
+
+        VNImageRequestHandler* handler = [[VNImageRequestHandler alloc]
+            initWithCVPixelBuffer:static_cast<CVPixelBufferRef>(pixelBuffer)
+            options:@{}];
+        return pImpl->segmentToTexture(handler, mask);
+    }
+}
+
+bool PersonSegmentation::segmentFrame(void* pixelBuffer, ofTexture& mask, float deadlineMs) {
+    if (!pImpl->isSetup || !pixelBuffer) {
+        pImpl->lastError = pImpl->isSetup ? "Invalid pixel buffer" : "PersonSegmentation not setup";
+        return false;
+    }
+    return pImpl->segmentFrame(static_cast<CVPixelBufferRef>(pixelBuffer), mask, deadlineMs);
+}
+
+SegmentationQuality PersonSegmentation::getCurrentQuality() const {
+    std::lock_guard<std::mutex> lock(pImpl->frameMutex);
+    return pImpl->currentQuality;
+}
+
+float PersonSegmentation::getAverageLatency() const {
+    std::lock_guard<std::mutex> lock(pImpl->frameMutex);
+    return pImpl->averageLatency;
+}
+
 void PersonSegmentation::segmentAsync(const ofPixels& pixels, SegmentationCallback callback) {
     if (!pImpl->isSetup) {
         SegmentationResult result;
@@ -473,6 +734,26 @@ bool PersonSegmentation::isProcessing() const {
     return pImpl->isProcessing;
 }
 
+void* PersonSegmentation::getFrameRequest() {
+    if (!pImpl->isSetup) {
+        return nullptr;
+    }
+    if (!pImpl->frameRequest) {
+        pImpl->frameRequest = [[VNGeneratePersonSegmentationRequest alloc] init];
+        pImpl->configureRequest(pImpl->frameRequest);
+    }
+    return (__bridge void*)pImpl->frameRequest;
+}
+
+SegmentationResult PersonSegmentation::getFrameResults(size_t inputWidth, size_t inputHeight) {
+    if (!pImpl->frameRequest) {
+        SegmentationResult result;
+        result.errorMessage = "No frame request";
+        return result;
+    }
+    return pImpl->extractResult(pImpl->frameRequest, inputWidth, inputHeight);
+}
+
 bool PersonSegmentation::setConfig(const PersonSegmentationConfig& config) {
     if (!pImpl->isSetup) {
         pImpl->lastError = "PersonSegmentation not setup";
@@ -11,6 +11,7 @@
 // - Multiple person detection
 // - Real-time performance
 // - Neural Engine acceleration
+// - Temporal smoothing and prediction at render rate (getInterpolated)
 //
 // Example usage:
 //   PoseEstimator estimator;
@@ -19,6 +20,10 @@
 //   for (const auto& pose : poses) {
 //       estimator.drawSkeleton(pose);
 //   }
+//
+//   // Smoothed at render rate, with estimate() on every other frame:
+//   estimator.addResult(poses, frameTime);
+//   estimator.drawSkeletons(estimator.getInterpolated(ofGetElapsedTimef()), w, h);
 
 #include <string>
 #include <vector>
@@ -106,6 +111,12 @@ struct PoseEstimatorConfig {
 
     // Whether to return normalized coordinates (0.0-1.0) or pixel coordinates
     bool normalizedCoordinates = true;
+
+    // Temporal smoothing for getInterpolated(): a One-Euro filter per joint,
+    // tuned for normalized coordinates
+    float smoothingMinCutoff = 1.0f;    // Cutoff at rest in Hz (lower = less jitter)
+    float smoothingBeta = 5.0f;         // Cutoff increase with speed (higher = less lag)
+    float maxPrediction = 0.1f;         // Seconds predicted past the last result
 };
 
 class PoseEstimator {
@@ -148,8 +159,46 @@ public:
 
     // Estimate human poses from ofTexture
     // Returns vector of detected poses (may be empty if no people detected)
+    // IOSurface-backed textures (camera frames) are read in place; others
+    // are read back to pixels first
     std::vector<HumanPose> estimate(const oflike::ofTexture& texture);
 
+    // Estimate human poses from a CVPixelBufferRef (camera frame), read in place
+    // Returns vector of detected poses (may be empty if no people detected)
+    std::vector<HumanPose> estimate(void* pixelBuffer);
+
+    // ============================================================================
+    // Frame Scheduling (see FrameScheduler)
+    // ============================================================================
+
+    // Vision request (VNRequest*) a shared handler performs for each
+    // frame; separate from estimate()'s, nullptr until setup
+    void* getFrameRequest();
+
+    // Poses from the frame request after the handler performed it
+    std::vector<HumanPose> getFrameResults();
+
+    // ============================================================================
+    // Temporal Smoothing
+    // ============================================================================
+
+    // Feed poses (from estimate() or a FrameScheduler callback) with the
+    // timestamp of their frame in seconds. Poses are matched to the previous
+    // result by position and keep a stable personID; every joint is filtered.
+    // Safe to call from another thread than getInterpolated()
+    void addResult(const std::vector<HumanPose>& poses, double timestamp);
+
+    // Smoothed poses at a render time (seconds, same clock as addResult),
+    // predicted from the last result for up to maxPrediction seconds, so the
+    // model can run at a fraction of the display rate without visible jitter
+    std::vector<HumanPose> getInterpolated(double time) const;
+
+    // Change the smoothing parameters (see PoseEstimatorConfig)
+    void setSmoothing(float minCutoff, float beta, float maxPrediction);
+
+    // Forget all tracked poses, e.g. after a scene cut
+    void resetSmoothing();
+
     // ============================================================================
     // Drawing Helpers
     // ============================================================================
@@ -5,6 +5,13 @@
 #import "../../oflike/image/ofTexture.h"
 #import "../../oflike/graphics/ofGraphics.h"
 #import "../../oflike/types/ofColor.h"
+#import "../../oflike/math/ofOneEuroFilter.h"
+#import "NeuralEngineBuffers.h"
+#import "../../oflike/utils/ofProfiler.h"
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <tuple>
 
 namespace NeuralEngine {
 
@@ -126,6 +133,29 @@ static std::vector<JointName> getAllJointNames() {
     };
 }
 
+// Number of JointName values, for per-joint tables
+static constexpr size_t kJointCount = static_cast<size_t>(JointName::Root) + 1;
+
+// Mean position of a pose's detected joints; false if none are detected
+static bool getPoseCenter(const HumanPose& pose, float& x, float& y) {
+    float sumX = 0.0f;
+    float sumY = 0.0f;
+    int count = 0;
+    for (const auto& joint : pose.joints) {
+        if (joint.isDetected) {
+            sumX += joint.x;
+            sumY += joint.y;
+            count++;
+        }
+    }
+    if (count == 0) {
+        return false;
+    }
+    x = sumX / count;
+    y = sumY / count;
+    return true;
+}
+
 // ============================================================================
 // PoseEstimator::Impl
 // ============================================================================
@@ -136,6 +166,22 @@ struct PoseEstimator::Impl {
     bool isReady = false;
 
     VNDetectHumanBodyPoseRequest* poseRequest = nil;
+    VNDetectHumanBodyPoseRequest* frameRequest = nil;   // Performed by a FrameScheduler
+
+    // One tracked person for temporal smoothing: a filter per joint coordinate
+    struct PoseTrack {
+        int personID = 0;
+        HumanPose pose;     // Last result, for joint names and confidences
+        std::array<std::array<oflike::ofOneEuroFilter, 2>, kJointCount> filters;
+    };
+
+    // Smoothing state, shared between addResult() and getInterpolated()
+    mutable std::mutex smoothingMutex;
+    std::vector<PoseTrack> tracks;
+    int nextPersonID = 0;
+    float smoothingMinCutoff = PoseEstimatorConfig().smoothingMinCutoff;
+    float smoothingBeta = PoseEstimatorConfig().smoothingBeta;
+    float maxPrediction = PoseEstimatorConfig().maxPrediction;
 
     Impl() = default;
 
@@ -147,6 +193,7 @@ struct PoseEstimator::Impl {
         @autoreleasepool {
             config = cfg;
             lastError.clear();
+            setSmoothing(cfg.smoothingMinCutoff, cfg.smoothingBeta, cfg.maxPrediction);
 
             // Create pose detection request
             poseRequest = [[VNDetectHumanBodyPoseRequest alloc] init];
@@ -165,25 +212,43 @@ struct PoseEstimator::Impl {
             if (poseRequest) {
                 poseRequest = nil;
             }
+            frameRequest = nil;
             isReady = false;
         }
     }
 
     std::vector<HumanPose> estimate(CGImageRef image) {
         @autoreleasepool {
-            std::vector<HumanPose> results;
-
             if (!isReady || !image) {
                 lastError = isReady ? "Invalid image" : "Estimator not ready";
-                return results;
+                return {};
             }
 
             // Create request handler
             VNImageRequestHandler* handler = [[VNImageRequestHandler alloc]
                 initWithCGImage:image
                 options:@{}];
+            return estimate(handler);
+        }
+    }
+
+    // Frames are read in place, never converted
+    std::vector<HumanPose> estimate(CVPixelBufferRef pixelBuffer) {
+        @autoreleasepool {
+            if (!isReady || !pixelBuffer) {
+                lastError = isReady ? "Invalid pixel buffer" : "Estimator not ready";
+                return {};
+            }
+            return estimate([[VNImageRequestHandler alloc] initWithCVPixelBuffer:pixelBuffer options:@{}]);
+        }
+    }
+
+    std::vector<HumanPose> estimate(VNImageRequestHandler* handler) {
+        @autoreleasepool {
+            std::vector<HumanPose> results;
 
             // Perform request
+            OF_PROFILE_SCOPE("PoseEstimator inference");
             NSError* error = nil;
             if (![handler performRequests:@[poseRequest] error:&error]) {
                 if (error) {
@@ -192,8 +257,16 @@ struct PoseEstimator::Impl {
                 return results;
             }
 
-            // Process results
-            NSArray<VNHumanBodyPoseObservation*>* observations = poseRequest.results;
+            return collectPoses(poseRequest);
+        }
+    }
+
+    // Poses from a request that has been performed
+    std::vector<HumanPose> collectPoses(VNDetectHumanBodyPoseRequest* request) {
+        @autoreleasepool {
+            std::vector<HumanPose> results;
+
+            NSArray<VNHumanBodyPoseObservation*>* observations = request.results;
             if (!observations || observations.count == 0) {
                 return results; // No people detected
             }
@@ -220,6 +293,108 @@ struct PoseEstimator::Impl {
         }
     }
 
+    // ------------------------------------------------------------------------
+    // Temporal smoothing
+    // ------------------------------------------------------------------------
+
+    void setSmoothing(float minCutoff, float beta, float prediction) {
+        std::lock_guard<std::mutex> lock(smoothingMutex);
+        smoothingMinCutoff = minCutoff;
+        smoothingBeta = beta;
+        maxPrediction = prediction;
+        for (auto& track : tracks) {
+            for (auto& filters : track.filters) {
+                filters[0].setParameters(minCutoff, beta);
+                filters[1].setParameters(minCutoff, beta);
+            }
+        }
+    }
+
+    void resetSmoothing() {
+        std::lock_guard<std::mutex> lock(smoothingMutex);
+        tracks.clear();
+    }
+
+    void addResult(const std::vector<HumanPose>& poses, double timestamp) {
+        std::lock_guard<std::mutex> lock(smoothingMutex);
+
+        // Match poses to tracks, closest pairs first
+        std::vector<std::tuple<float, size_t, size_t>> pairs;
+        for (size_t t = 0; t < tracks.size(); t++) {
+            float trackX, trackY;
+            if (!getPoseCenter(tracks[t].pose, trackX, trackY)) continue;
+            for (size_t p = 0; p < poses.size(); p++) {
+                float poseX, poseY;
+                if (!getPoseCenter(poses[p], poseX, poseY)) continue;
+                float dx = poseX - trackX;
+                float dy = poseY - trackY;
+                pairs.emplace_back(dx * dx + dy * dy, t, p);
+            }
+        }
+        std::sort(pairs.begin(), pairs.end());
+
+        std::vector<int> trackForPose(poses.size(), -1);
+        std::vector<bool> trackUsed(tracks.size(), false);
+        for (const auto& [distance, t, p] : pairs) {
+            if (!trackUsed[t] && trackForPose[p] < 0) {
+                trackUsed[t] = true;
+                trackForPose[p] = static_cast<int>(t);
+            }
+        }
+
+        // Tracks without a pose are dropped; new poses start a track
+        std::vector<PoseTrack> updated;
+        updated.reserve(poses.size());
+        for (size_t p = 0; p < poses.size(); p++) {
+            PoseTrack track;
+            if (trackForPose[p] >= 0) {
+                track = std::move(tracks[trackForPose[p]]);
+            } else {
+                track.personID = nextPersonID++;
+                for (auto& filters : track.filters) {
+                    filters[0].setParameters(smoothingMinCutoff, smoothingBeta);
+                    filters[1].setParameters(smoothingMinCutoff, smoothingBeta);
+                }
+            }
+
+            for (const auto& joint : poses[p].joints) {
+                if (!joint.isDetected) continue;
+                auto& filters = track.filters[static_cast<size_t>(joint.name)];
+
+                // A joint that was lost starts over where it reappears
+                const Joint* previous = track.pose.getJoint(joint.name);
+                if (!previous || !previous->isDetected) {
+                    filters[0].reset();
+                    filters[1].reset();
+                }
+                filters[0].filter(joint.x, timestamp);
+                filters[1].filter(joint.y, timestamp);
+            }
+            track.pose = poses[p];
+            track.pose.personID = track.personID;
+            updated.push_back(std::move(track));
+        }
+        tracks = std::move(updated);
+    }
+
+    std::vector<HumanPose> getInterpolated(double time) const {
+        std::lock_guard<std::mutex> lock(smoothingMutex);
+        std::vector<HumanPose> poses;
+        poses.reserve(tracks.size());
+        for (const auto& track : tracks) {
+            HumanPose pose = track.pose;
+            for (auto& joint : pose.joints) {
+                const auto& filters = track.filters[static_cast<size_t>(joint.name)];
+                if (joint.isDetected && filters[0].hasValue()) {
+                    joint.x = filters[0].getValueAt(time, maxPrediction);
+                    joint.y = filters[1].getValueAt(time, maxPrediction);
+                }
+            }
+            poses.push_back(std::move(pose));
+        }
+        return poses;
+    }
+
     HumanPose extractPose(VNHumanBodyPoseObservation* observation) {
         @autoreleasepool {
             HumanPose pose;
@@ -341,6 +516,14 @@ std::vector<HumanPose> PoseEstimator::estimate(const oflike::ofPixels& pixels) {
 
 std::vector<HumanPose> PoseEstimator::estimate(const oflike::ofTexture& texture) {
     @autoreleasepool {
+        // IOSurface-backed textures (camera frames) are read in place
+        CVPixelBufferRef pixelBuffer = CreatePixelBufferFromTexture(texture);
+        if (pixelBuffer) {
+            std::vector<HumanPose> results = impl_->estimate(pixelBuffer);
+            CVPixelBufferRelease(pixelBuffer);
+            return results;
+        }
+
         // Convert texture to pixels
         oflike::ofPixels pixels;
         texture.readToPixels(pixels);
@@ -348,6 +531,54 @@ std::vector<HumanPose> PoseEstimator::estimate(const oflike::ofTexture& texture)
     }
 }
 
+std::vector<HumanPose> PoseEstimator::estimate(void* pixelBuffer) {
+    return impl_->estimate(static_cast<CVPixelBufferRef>(pixelBuffer));
+}
+
+// ============================================================================
+// Frame Scheduling
+// ============================================================================
+
+void* PoseEstimator::getFrameRequest() {
+    if (!impl_->isReady) {
+        return nullptr;
+    }
+    if (!impl_->frameRequest) {
+        impl_->frameRequest = [[VNDetectHumanBodyPoseRequest alloc] init];
+    }
+    return (__bridge void*)impl_->frameRequest;
+}
+
+std::vector<HumanPose> PoseEstimator::getFrameResults() {
+    if (!impl_->frameRequest) {
+        return {};
+    }
+    return impl_->collectPoses(impl_->frameRequest);
+}
+
+// ============================================================================
+// Temporal Smoothing
+// ============================================================================
+
+void PoseEstimator::addResult(const std::vector<HumanPose>& poses, double timestamp) {
+    impl_->addResult(poses, timestamp);
+}
+
+std::vector<HumanPose> PoseEstimator::getInterpolated(double time) const {
+    return impl_->getInterpolated(time);
+}
+
+void PoseEstimator::setSmoothing(float minCutoff, float beta, float maxPrediction) {
+    impl_->config.smoothingMinCutoff = minCutoff;
+    impl_->config.smoothingBeta = beta;
+    impl_->config.maxPrediction = maxPrediction;
+    impl_->setSmoothing(minCutoff, beta, maxPrediction);
+}
+
+void PoseEstimator::resetSmoothing() {
+    impl_->resetSmoothing();
+}
+
 // ============================================================================
 // Drawing Helpers
 // ============================================================================
@@ -108,16 +108,26 @@ public:
     // Output has same dimensions as input (model may resize internally)
     oflike::ofPixels transfer(const oflike::ofPixels& pixels);
 
-    // Transfer style to ofTexture (GPU direct processing)
+    // Transfer style to ofTexture
     // Returns stylized image as ofPixels
-    // More efficient than converting texture to pixels first
+    // IOSurface-backed textures (camera frames) are read in place; others
+    // are read back to pixels first
     oflike::ofPixels transfer(const oflike::ofTexture& texture);
 
+    // Transfer style to a CVPixelBufferRef (camera frame), read in place
+    // Returns stylized image as ofPixels
+    oflike::ofPixels transfer(void* pixelBuffer);
+
     // Transfer style and output directly to texture (GPU-only path)
     // Returns true if successful
-    // This is the most efficient method for real-time applications
+    // BGRA model outputs are drawn in place from their pixel buffer; the
+    // output stays valid until the next call. Call on the main thread.
     bool transferToTexture(const oflike::ofTexture& input, oflike::ofTexture& output);
 
+    // Transfer style from a CVPixelBufferRef into a texture, zero-copy end
+    // to end for BGRA outputs (see above)
+    bool transferToTexture(void* pixelBuffer, oflike::ofTexture& output);
+
     // Batch transfer - process multiple images
     // Returns vector of stylized images
     std::vector<oflike::ofPixels> transferBatch(const std::vector<oflike::ofPixels>& images);
@@ -1,6 +1,10 @@
 #include "StyleTransfer.h"
 #include "ofPixels.h"
 #include "ofTexture.h"
+#include "video/VideoFrameTexture.h"
+#include "NeuralEngineBuffers.h"
+#include "ModelCache.h"
+#include "ofProfiler.h"
 #include <Foundation/Foundation.h>
 #include <CoreML/CoreML.h>
 #include <Vision/Vision.h>
@@ -25,6 +29,7 @@ struct StyleTransfer::Impl {
     StyleTransferInfo info;
     std::string lastError;
     CIContext* ciContext = nil;
+    VideoFrameTexture outputFrames;     // Stylized frames drawn in place by transferToTexture()
 
     ~Impl() {
         @autoreleasepool {
@@ -64,7 +69,7 @@ struct StyleTransfer::Impl {
 
             // Load model
             NSError* error = nil;
-            model = [MLModel modelWithContentsOfURL:modelURL configuration:configuration error:&error];
+            model = LoadCachedModel(modelURL, configuration, &error);
 
             if (error || !model) {
                 lastError = error ? [[error localizedDescription] UTF8String] : "Failed to load model";
@@ -230,22 +235,78 @@ struct StyleTransfer::Impl {
 
     ofPixels transferFromCGImage(CGImageRef cgImage, size_t originalWidth, size_t originalHeight) {
         @autoreleasepool {
-            // Create request
-            VNCoreMLRequest* request = [[VNCoreMLRequest alloc] initWithModel:visionModel];
-            request.imageCropAndScaleOption = VNImageCropAndScaleOptionScaleFit;
-
             // Create request handler
             VNImageRequestHandler* handler = [[VNImageRequestHandler alloc]
                 initWithCGImage:cgImage
                 options:@{}];
 
-            // Perform request
-            NSError* error = nil;
-            if (![handler performRequests:@[request] error:&error]) {
-                lastError = error ? [[error localizedDescription] UTF8String] : "Style transfer failed";
-                return ofPixels();
+            VNCoreMLRequest* request = performRequest(handler);
+            return request ? collectStylized(request) : ofPixels();
+        }
+    }
+
+    // Run the model on a frame in place: CVPixelBuffers are never converted
+    ofPixels transferFromPixelBuffer(CVPixelBufferRef pixelBuffer) {
+        @autoreleasepool {
+            VNCoreMLRequest* request = performRequest(pixelBuffer);
+            return request ? collectStylized(request) : ofPixels();
+        }
+    }
+
+    // The performed request; nil (with lastError set) on failure
+    VNCoreMLRequest* performRequest(CVPixelBufferRef pixelBuffer) {
+        if (!pixelBuffer) {
+            lastError = "Invalid pixel buffer";
+            return nil;
+        }
+        return performRequest([[VNImageRequestHandler alloc] initWithCVPixelBuffer:pixelBuffer options:@{}]);
+    }
+
+    VNCoreMLRequest* performRequest(VNImageRequestHandler* handler) {
+        if (!visionModel) {
+            lastError = "Model not loaded";
+            return nil;
+        }
+
+        // Create request
+        VNCoreMLRequest* request = [[VNCoreMLRequest alloc] initWithModel:visionModel];
+        request.imageCropAndScaleOption = VNImageCropAndScaleOptionScaleFit;
+
+        // Perform request
+        OF_PROFILE_SCOPE("StyleTransfer inference");
+        NSError* error = nil;
+        if (![handler performRequests:@[request] error:&error]) {
+            lastError = error ? [[error localizedDescription] UTF8String] : "Style transfer failed";
+            return nil;
+        }
+        return request;
+    }
+
+    // Draw the output of a frame: BGRA outputs in place, others uploaded
+    bool transferToTexture(CVPixelBufferRef pixelBuffer, ofTexture& output) {
+        @autoreleasepool {
+            VNCoreMLRequest* request = performRequest(pixelBuffer);
+            if (!request) {
+                return false;
+            }
+            CVPixelBufferRef stylized = GetResultPixelBuffer(request);
+            if (stylized && VideoFrameTexture::isSupportedFormat(CVPixelBufferGetPixelFormatType(stylized))) {
+                outputFrames.setFrame(stylized, output);
+                return true;
+            }
+
+            ofPixels stylizedPixels = collectStylized(request);
+            if (stylizedPixels.getWidth() == 0 || stylizedPixels.getHeight() == 0) {
+                return false;
             }
+            output.loadData(stylizedPixels);
+            return true;
+        }
+    }
 
+    // Stylized image from a request that has been performed
+    ofPixels collectStylized(VNCoreMLRequest* request) {
+        @autoreleasepool {
             // Get results
             if (request.results.count == 0) {
                 lastError = "No results from model";
@@ -434,26 +495,32 @@ ofPixels StyleTransfer::transfer(const ofPixels& pixels) {
 }
 
 ofPixels StyleTransfer::transfer(const ofTexture& texture) {
-    // DEFERRED: Direct GPU path using MTLTexture and Core Image
-    //
-    // Rationale:
-    // - VNCoreMLRequest expects CVPixelBuffer or CGImage input
-    // - Direct MTLTexture → CVPixelBuffer requires IOSurface + CVPixelBufferPool
-    // - Core Image path (CIImage → MTLTexture) adds complexity
-    // - CPU path sufficient for style transfer (not real-time bottleneck)
-    //
-    // Workaround: Users should convert ofTexture to ofPixels manually:
-    // Example:
-    //   ofPixels pixels;
-    //   texture.readToPixels(pixels);
-    //   ofPixels stylized = transfer.transfer(pixels);
-
-    impl_->lastError = "ofTexture input not yet implemented. Please convert to ofPixels first.";
-    return ofPixels();
+    // IOSurface-backed textures (camera frames) are read in place
+    CVPixelBufferRef pixelBuffer = CreatePixelBufferFromTexture(texture);
+    if (pixelBuffer) {
+        ofPixels result = impl_->transferFromPixelBuffer(pixelBuffer);
+        CVPixelBufferRelease(pixelBuffer);
+        return result;
+    }
+
+    ofPixels pixels;
+    texture.readToPixels(pixels);
+    return impl_->transferFromPixels(pixels);
+}
+
+ofPixels StyleTransfer::transfer(void* pixelBuffer) {
+    return impl_->transferFromPixelBuffer(static_cast<CVPixelBufferRef>(pixelBuffer));
 }
 
 bool StyleTransfer::transferToTexture(const ofTexture& input, ofTexture& output) {
-    // Transfer style
+    CVPixelBufferRef pixelBuffer = CreatePixelBufferFromTexture(input);
+    if (pixelBuffer) {
+        bool transferred = impl_->transferToTexture(pixelBuffer, output);
+        CVPixelBufferRelease(pixelBuffer);
+        return transferred;
+    }
+
+    // Textures in their own memory are read back first
     ofPixels stylizedPixels = transfer(input);
 
     if (stylizedPixels.getWidth() == 0 || stylizedPixels.getHeight() == 0) {
@@ -468,6 +535,10 @@ bool StyleTransfer::transferToTexture(const ofTexture& input, ofTexture& output)
     return true;
 }
 
+bool StyleTransfer::transferToTexture(void* pixelBuffer, ofTexture& output) {
+    return impl_->transferToTexture(static_cast<CVPixelBufferRef>(pixelBuffer), output);
+}
+
 std::vector<ofPixels> StyleTransfer::transferBatch(const std::vector<ofPixels>& images) {
     return impl_->transferBatch(images);
 }
@@ -62,5 +62,8 @@
 // Generic Core ML Model
 #include "GenericModel.h"
 
+// Several Vision models sharing one handler per camera frame
+#include "FrameScheduler.h"
+
 // Convenience namespace alias
 namespace ofxNeuralEngine = NeuralEngine;
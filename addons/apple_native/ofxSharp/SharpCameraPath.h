@@ -89,6 +89,21 @@ struct CameraKeyframe {
     {}
 };
 
+/// Camera state at one time on a path
+struct CameraPathSample {
+    float time;                    ///< Time in seconds
+    oflike::float3 position;       ///< Camera position
+    oflike::float3 target;         ///< LookAt target position
+    float fov;                     ///< Field of view (degrees)
+
+    CameraPathSample()
+        : time(0.0f)
+        , position{0.0f, 0.0f, 0.0f}
+        , target{0.0f, 0.0f, -1.0f}
+        , fov(60.0f)
+    {}
+};
+
 // ============================================================================
 // CameraPath Class
 // ============================================================================
@@ -202,7 +217,8 @@ public:
     void removeKeyframe(size_t index);
 
     /**
-     * Sort keyframes by time (automatically called when needed).
+     * Sort keyframes by time. Keyframes are kept sorted as they are added
+     * or changed, so this is only needed for compatibility.
      */
     void sortKeyframes();
 
@@ -220,6 +236,25 @@ public:
      */
     InterpolationMode getInterpolationMode() const;
 
+    /**
+     * Move at constant speed along dolly and keyframe paths.
+     * Time is mapped to distance travelled through a precomputed arc-length
+     * table, so the camera no longer speeds up on long segments and slows
+     * down on short ones. Keyframe times then only set the duration; target
+     * and FOV follow the position. Orbits and spirals are unaffected.
+     */
+    void setConstantSpeed(bool enabled);
+
+    /**
+     * Check if constant-speed reparameterization is enabled.
+     */
+    bool isConstantSpeed() const;
+
+    /**
+     * Get the length of the camera's path (world units).
+     */
+    float getLength() const;
+
     // ========================================================================
     // LookAt Target
     // ========================================================================
@@ -335,6 +370,19 @@ public:
      */
     void applyToCamera(oflike::ofCamera& camera) const;
 
+    /**
+     * Apply the path state at a given time to a camera, without moving the
+     * playhead. Used to sample a path at a fixed timestep.
+     * @param time Time in seconds (clamped to the duration)
+     * @param camera Camera to update
+     */
+    void applyToCamera(float time, oflike::ofCamera& camera) const;
+
+    /**
+     * Apply a sample from evaluate() or sampleFrames() to a camera.
+     */
+    void applyToCamera(const CameraPathSample& sample, oflike::ofCamera& camera) const;
+
     /**
      * Get current camera position on the path.
      */
@@ -350,6 +398,33 @@ public:
      */
     float getFov() const;
 
+    // ========================================================================
+    // Sampling
+    // ========================================================================
+
+    /**
+     * Evaluate the path at a time, without moving the playhead.
+     * @param time Time in seconds (clamped to the duration)
+     */
+    CameraPathSample evaluate(float time) const;
+
+    /**
+     * Evaluate the path at many times in one call.
+     * Keyframe segments are found by binary search; ascending times reuse
+     * the previous segment, so sampling a whole path is linear.
+     * @param times Times in seconds
+     * @param count Number of times
+     * @param samples Output, count samples
+     */
+    void evaluate(const float* times, size_t count, CameraPathSample* samples) const;
+
+    /**
+     * Evaluate the path at every frame of an offline render.
+     * @param frameCount Number of frames
+     * @param framerate Frames per second (frame i is at i / framerate)
+     */
+    std::vector<CameraPathSample> sampleFrames(size_t frameCount, float framerate) const;
+
     // ========================================================================
     // Path Info
     // ========================================================================
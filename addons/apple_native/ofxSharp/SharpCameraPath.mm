@@ -72,6 +72,14 @@ oflike::quatf slerp(const oflike::quatf& q0, const oflike::quatf& q1, float t) {
     return simd_slerp(q0, q1, t);
 }
 
+// Arc-length samples per segment (keyframe or dolly), enough for the
+// chord sum to stay within a fraction of a percent of a Catmull-Rom span
+constexpr size_t kArcSamplesPerSegment = 32;
+
+bool keyframeBefore(const CameraKeyframe& a, const CameraKeyframe& b) {
+    return a.time < b.time;
+}
+
 } // anonymous namespace
 
 // ============================================================================
@@ -95,9 +103,8 @@ struct CameraPath::Impl {
     oflike::float3 lookAtTarget{0.0f, 0.0f, 0.0f};
     bool lookAtEnabled = true;
 
-    // Keyframes
+    // Keyframes, kept sorted by time
     std::vector<CameraKeyframe> keyframes;
-    bool keyframesSorted = true;
 
     // Orbit path settings
     oflike::float3 orbitCenter{0.0f, 0.0f, 0.0f};
@@ -116,18 +123,44 @@ struct CameraPath::Impl {
     float spiralRevolutions = 1.0f;
     oflike::float3 spiralAxis{0.0f, 1.0f, 0.0f};
 
+    // Constant-speed reparameterization
+    bool constantSpeed = false;
+
     // Current state cache
-    mutable oflike::float3 cachedPosition{0.0f, 0.0f, 0.0f};
-    mutable oflike::float3 cachedTarget{0.0f, 0.0f, -1.0f};
-    mutable float cachedFov = 60.0f;
+    mutable CameraPathSample cached;
     mutable bool cacheDirty = true;
 
+    // Arc-length table: path time and distance travelled at each sample,
+    // both ascending; rebuilt when the path changes
+    mutable std::vector<float> arcTimes;
+    mutable std::vector<float> arcDistances;
+    mutable bool arcDirty = true;
+
+    // The shape of the path changed
+    void pathChanged() {
+        cacheDirty = true;
+        arcDirty = true;
+    }
+
+    void updateDuration() {
+        float maxTime = 0.0f;
+        for (const auto& kf : keyframes) {
+            maxTime = std::max(maxTime, kf.time);
+        }
+        duration = maxTime;
+    }
+
     // Methods
     void updateCache() const;
-    void computeOrbitPosition() const;
-    void computeDollyPosition() const;
-    void computeSpiralPosition() const;
-    void computeKeyframePosition() const;
+    CameraPathSample evaluate(float time, size_t& segmentHint, size_t& arcHint) const;
+    CameraPathSample evaluateRaw(float time, size_t& segmentHint) const;
+    float reparameterize(float time, size_t& arcHint) const;
+    void buildArcTable() const;
+    size_t findKeyframeSegment(float time, size_t hint) const;
+    CameraPathSample computeOrbit(float time) const;
+    CameraPathSample computeDolly(float time) const;
+    CameraPathSample computeSpiral(float time) const;
+    CameraPathSample computeKeyframe(float time, size_t& segmentHint) const;
 };
 
 // ============================================================================
@@ -161,7 +194,7 @@ void CameraPath::setOrbitPath(const oflike::float3& center,
     impl_->orbitStartAngle = startAngle;
     impl_->lookAtTarget = center;
     impl_->lookAtEnabled = true;
-    impl_->cacheDirty = true;
+    impl_->pathChanged();
 }
 
 void CameraPath::setDollyPath(const std::vector<oflike::float3>& controlPoints,
@@ -171,7 +204,7 @@ void CameraPath::setDollyPath(const std::vector<oflike::float3>& controlPoints,
     impl_->dollyPoints = controlPoints;
     impl_->duration = duration;
     impl_->dollyClosed = closed;
-    impl_->cacheDirty = true;
+    impl_->pathChanged();
 }
 
 void CameraPath::setSpiralPath(const oflike::float3& center,
@@ -189,7 +222,7 @@ void CameraPath::setSpiralPath(const oflike::float3& center,
     impl_->spiralAxis = simd_normalize(axis);
     impl_->lookAtTarget = center;
     impl_->lookAtEnabled = true;
-    impl_->cacheDirty = true;
+    impl_->pathChanged();
 }
 
 // ============================================================================
@@ -200,22 +233,16 @@ void CameraPath::addKeyframe(float time,
                               const oflike::float3& position,
                               const oflike::float3& target,
                               float fov) {
-    impl_->pathType = PathType::Keyframe;
-    impl_->keyframes.emplace_back(time, position, target, fov);
-    impl_->keyframesSorted = false;
-    impl_->cacheDirty = true;
-
-    // Update duration if needed
-    if (time > impl_->duration) {
-        impl_->duration = time;
-    }
+    addKeyframe(CameraKeyframe(time, position, target, fov));
 }
 
 void CameraPath::addKeyframe(const CameraKeyframe& keyframe) {
     impl_->pathType = PathType::Keyframe;
-    impl_->keyframes.push_back(keyframe);
-    impl_->keyframesSorted = false;
-    impl_->cacheDirty = true;
+
+    // After any keyframes at the same time, so insertion order breaks ties
+    auto& keyframes = impl_->keyframes;
+    keyframes.insert(std::upper_bound(keyframes.begin(), keyframes.end(), keyframe, keyframeBefore), keyframe);
+    impl_->pathChanged();
 
     // Update duration if needed
     if (keyframe.time > impl_->duration) {
@@ -225,9 +252,8 @@ void CameraPath::addKeyframe(const CameraKeyframe& keyframe) {
 
 void CameraPath::clearKeyframes() {
     impl_->keyframes.clear();
-    impl_->keyframesSorted = true;
     impl_->duration = 0.0f;
-    impl_->cacheDirty = true;
+    impl_->pathChanged();
 }
 
 size_t CameraPath::getKeyframeCount() const {
@@ -240,37 +266,21 @@ const CameraKeyframe& CameraPath::getKeyframe(size_t index) const {
 
 void CameraPath::setKeyframe(size_t index, const CameraKeyframe& keyframe) {
     impl_->keyframes.at(index) = keyframe;
-    impl_->keyframesSorted = false;
-    impl_->cacheDirty = true;
-
-    // Update duration
-    float maxTime = 0.0f;
-    for (const auto& kf : impl_->keyframes) {
-        maxTime = std::max(maxTime, kf.time);
-    }
-    impl_->duration = maxTime;
+    sortKeyframes();
+    impl_->updateDuration();
 }
 
 void CameraPath::removeKeyframe(size_t index) {
     if (index < impl_->keyframes.size()) {
         impl_->keyframes.erase(impl_->keyframes.begin() + index);
-        impl_->cacheDirty = true;
-
-        // Update duration
-        float maxTime = 0.0f;
-        for (const auto& kf : impl_->keyframes) {
-            maxTime = std::max(maxTime, kf.time);
-        }
-        impl_->duration = maxTime;
+        impl_->updateDuration();
+        impl_->pathChanged();
     }
 }
 
 void CameraPath::sortKeyframes() {
-    std::sort(impl_->keyframes.begin(), impl_->keyframes.end(),
-              [](const CameraKeyframe& a, const CameraKeyframe& b) {
-                  return a.time < b.time;
-              });
-    impl_->keyframesSorted = true;
+    std::stable_sort(impl_->keyframes.begin(), impl_->keyframes.end(), keyframeBefore);
+    impl_->pathChanged();
 }
 
 // ============================================================================
@@ -279,13 +289,27 @@ void CameraPath::sortKeyframes() {
 
 void CameraPath::setInterpolationMode(InterpolationMode mode) {
     impl_->interpolationMode = mode;
-    impl_->cacheDirty = true;
+    impl_->pathChanged();
 }
 
 InterpolationMode CameraPath::getInterpolationMode() const {
     return impl_->interpolationMode;
 }
 
+void CameraPath::setConstantSpeed(bool enabled) {
+    impl_->constantSpeed = enabled;
+    impl_->cacheDirty = true;
+}
+
+bool CameraPath::isConstantSpeed() const {
+    return impl_->constantSpeed;
+}
+
+float CameraPath::getLength() const {
+    impl_->buildArcTable();
+    return impl_->arcDistances.empty() ? 0.0f : impl_->arcDistances.back();
+}
+
 // ============================================================================
 // LookAt Target
 // ============================================================================
@@ -422,33 +446,69 @@ void CameraPath::setNormalizedTime(float t) {
 
 void CameraPath::applyToCamera(oflike::ofCamera& camera) const {
     impl_->updateCache();
+    applyToCamera(impl_->cached, camera);
+}
 
-    camera.setPosition(oflike::ofVec3f(impl_->cachedPosition.x,
-                                       impl_->cachedPosition.y,
-                                       impl_->cachedPosition.z));
+void CameraPath::applyToCamera(float time, oflike::ofCamera& camera) const {
+    applyToCamera(evaluate(time), camera);
+}
+
+void CameraPath::applyToCamera(const CameraPathSample& sample, oflike::ofCamera& camera) const {
+    camera.setPosition(oflike::ofVec3f(sample.position.x,
+                                       sample.position.y,
+                                       sample.position.z));
 
     if (impl_->lookAtEnabled || impl_->pathType == PathType::Keyframe) {
-        camera.lookAt(oflike::ofVec3f(impl_->cachedTarget.x,
-                                      impl_->cachedTarget.y,
-                                      impl_->cachedTarget.z));
+        camera.lookAt(oflike::ofVec3f(sample.target.x,
+                                      sample.target.y,
+                                      sample.target.z));
     }
 
-    camera.setFov(impl_->cachedFov);
+    camera.setFov(sample.fov);
 }
 
 oflike::float3 CameraPath::getPosition() const {
     impl_->updateCache();
-    return impl_->cachedPosition;
+    return impl_->cached.position;
 }
 
 oflike::float3 CameraPath::getTarget() const {
     impl_->updateCache();
-    return impl_->cachedTarget;
+    return impl_->cached.target;
 }
 
 float CameraPath::getFov() const {
     impl_->updateCache();
-    return impl_->cachedFov;
+    return impl_->cached.fov;
+}
+
+// ============================================================================
+// Sampling
+// ============================================================================
+
+CameraPathSample CameraPath::evaluate(float time) const {
+    size_t segmentHint = 0;
+    size_t arcHint = 0;
+    return impl_->evaluate(time, segmentHint, arcHint);
+}
+
+void CameraPath::evaluate(const float* times, size_t count, CameraPathSample* samples) const {
+    // Ascending times find their segment next to the previous one's
+    size_t segmentHint = 0;
+    size_t arcHint = 0;
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = impl_->evaluate(times[i], segmentHint, arcHint);
+    }
+}
+
+std::vector<CameraPathSample> CameraPath::sampleFrames(size_t frameCount, float framerate) const {
+    std::vector<float> times(frameCount);
+    for (size_t i = 0; i < frameCount; ++i) {
+        times[i] = framerate > 0.0f ? static_cast<float>(i) / framerate : 0.0f;
+    }
+    std::vector<CameraPathSample> samples(frameCount);
+    evaluate(times.data(), frameCount, samples.data());
+    return samples;
 }
 
 // ============================================================================
@@ -479,33 +539,122 @@ bool CameraPath::isConfigured() const {
 void CameraPath::Impl::updateCache() const {
     if (!cacheDirty) return;
 
+    size_t segmentHint = 0;
+    size_t arcHint = 0;
+    cached = evaluate(currentTime, segmentHint, arcHint);
+    cacheDirty = false;
+}
+
+CameraPathSample CameraPath::Impl::evaluate(float time, size_t& segmentHint, size_t& arcHint) const {
+    time = std::max(0.0f, std::min(time, duration));
+    CameraPathSample sample = evaluateRaw(reparameterize(time, arcHint), segmentHint);
+    sample.time = time;
+    return sample;
+}
+
+CameraPathSample CameraPath::Impl::evaluateRaw(float time, size_t& segmentHint) const {
     switch (pathType) {
         case PathType::Orbit:
-            computeOrbitPosition();
-            break;
+            return computeOrbit(time);
         case PathType::Dolly:
-            computeDollyPosition();
-            break;
+            return computeDolly(time);
         case PathType::Spiral:
-            computeSpiralPosition();
-            break;
+            return computeSpiral(time);
         case PathType::Keyframe:
-            computeKeyframePosition();
-            break;
+            return computeKeyframe(time, segmentHint);
     }
+    return CameraPathSample();
+}
 
-    cacheDirty = false;
+// Path time at which the camera has travelled time / duration of the
+// path's length. Orbits and spirals already move at constant speed.
+float CameraPath::Impl::reparameterize(float time, size_t& arcHint) const {
+    if (!constantSpeed || pathType == PathType::Orbit || pathType == PathType::Spiral || duration <= 0.0f) {
+        return time;
+    }
+    buildArcTable();
+    if (arcDistances.size() < 2 || arcDistances.back() <= 0.0f) {
+        return time;
+    }
+
+    const float distance = time / duration * arcDistances.back();
+    size_t i = arcHint;
+    if (i + 1 >= arcDistances.size() || distance < arcDistances[i] || distance > arcDistances[i + 1]) {
+        auto it = std::upper_bound(arcDistances.begin(), arcDistances.end(), distance);
+        i = static_cast<size_t>(std::max<std::ptrdiff_t>(it - arcDistances.begin() - 1, 0));
+        i = std::min(i, arcDistances.size() - 2);
+    }
+    arcHint = i;
+
+    const float span = arcDistances[i + 1] - arcDistances[i];
+    const float t = span > 0.0f ? (distance - arcDistances[i]) / span : 0.0f;
+    return arcTimes[i] + (arcTimes[i + 1] - arcTimes[i]) * t;
+}
+
+void CameraPath::Impl::buildArcTable() const {
+    if (!arcDirty) return;
+    arcDirty = false;
+    arcTimes.clear();
+    arcDistances.clear();
+    if (duration <= 0.0f) return;
+
+    // Segment boundaries in path time, so keyframes land on samples exactly
+    std::vector<float> boundaries;
+    if (pathType == PathType::Keyframe) {
+        for (const auto& kf : keyframes) {
+            if (boundaries.empty() || kf.time > boundaries.back()) {
+                boundaries.push_back(std::max(kf.time, 0.0f));
+            }
+        }
+        if (boundaries.empty() || boundaries.front() > 0.0f) {
+            boundaries.insert(boundaries.begin(), 0.0f);
+        }
+    } else {
+        const size_t segments = pathType == PathType::Dolly && dollyPoints.size() > 1
+            ? (dollyClosed ? dollyPoints.size() : dollyPoints.size() - 1) : 1;
+        for (size_t i = 0; i <= segments; ++i) {
+            boundaries.push_back(duration * static_cast<float>(i) / segments);
+        }
+    }
+    if (boundaries.size() < 2) return;
+
+    size_t segmentHint = 0;
+    arcTimes.reserve((boundaries.size() - 1) * kArcSamplesPerSegment + 1);
+    arcDistances.reserve(arcTimes.capacity());
+    arcTimes.push_back(boundaries.front());
+    arcDistances.push_back(0.0f);
+    oflike::float3 previous = evaluateRaw(boundaries.front(), segmentHint).position;
+    for (size_t b = 0; b + 1 < boundaries.size(); ++b) {
+        for (size_t j = 1; j <= kArcSamplesPerSegment; ++j) {
+            const float time = boundaries[b] + (boundaries[b + 1] - boundaries[b]) * j / kArcSamplesPerSegment;
+            const oflike::float3 position = evaluateRaw(time, segmentHint).position;
+            arcTimes.push_back(time);
+            arcDistances.push_back(arcDistances.back() + simd_distance(previous, position));
+            previous = position;
+        }
+    }
+}
+
+// Index of the keyframe starting the segment that contains time
+size_t CameraPath::Impl::findKeyframeSegment(float time, size_t hint) const {
+    if (hint + 1 < keyframes.size() && keyframes[hint].time <= time && time < keyframes[hint + 1].time) {
+        return hint;
+    }
+    auto it = std::upper_bound(keyframes.begin(), keyframes.end(), time,
+                               [](float t, const CameraKeyframe& kf) { return t < kf.time; });
+    const size_t after = static_cast<size_t>(it - keyframes.begin());
+    return std::min(after > 0 ? after - 1 : 0, keyframes.size() - 2);
 }
 
-void CameraPath::Impl::computeOrbitPosition() const {
+CameraPathSample CameraPath::Impl::computeOrbit(float time) const {
+    CameraPathSample sample;
     if (duration <= 0.0f) {
-        cachedPosition = orbitCenter;
-        cachedTarget = orbitCenter;
-        cachedFov = 60.0f;
-        return;
+        sample.position = orbitCenter;
+        sample.target = orbitCenter;
+        return sample;
     }
 
-    float t = currentTime / duration;
+    float t = time / duration;
     float angle = orbitStartAngle + t * 2.0f * M_PI;
 
     // Create rotation quaternion
@@ -517,27 +666,24 @@ void CameraPath::Impl::computeOrbitPosition() const {
     // Rotate offset
     oflike::float3 rotatedOffset = simd_act(rot, offset);
 
-    cachedPosition = orbitCenter + rotatedOffset;
-    cachedTarget = lookAtTarget;
-    cachedFov = 60.0f;
+    sample.position = orbitCenter + rotatedOffset;
+    sample.target = lookAtTarget;
+    return sample;
 }
 
-void CameraPath::Impl::computeDollyPosition() const {
+CameraPathSample CameraPath::Impl::computeDolly(float time) const {
+    CameraPathSample sample;
     if (dollyPoints.empty() || duration <= 0.0f) {
-        cachedPosition = {0.0f, 0.0f, 0.0f};
-        cachedTarget = {0.0f, 0.0f, -1.0f};
-        cachedFov = 60.0f;
-        return;
+        return sample;
     }
 
     if (dollyPoints.size() == 1) {
-        cachedPosition = dollyPoints[0];
-        cachedTarget = lookAtTarget;
-        cachedFov = 60.0f;
-        return;
+        sample.position = dollyPoints[0];
+        sample.target = lookAtTarget;
+        return sample;
     }
 
-    float t = currentTime / duration;
+    float t = time / duration;
     int numSegments = dollyClosed ? dollyPoints.size() : (dollyPoints.size() - 1);
     float segmentLength = 1.0f / numSegments;
 
@@ -550,20 +696,20 @@ void CameraPath::Impl::computeDollyPosition() const {
     int i1 = (segment + 1) % dollyPoints.size();
 
     // Linear interpolation for now (could use spline later)
-    cachedPosition = lerp(dollyPoints[i0], dollyPoints[i1], localT);
-    cachedTarget = lookAtTarget;
-    cachedFov = 60.0f;
+    sample.position = lerp(dollyPoints[i0], dollyPoints[i1], localT);
+    sample.target = lookAtTarget;
+    return sample;
 }
 
-void CameraPath::Impl::computeSpiralPosition() const {
+CameraPathSample CameraPath::Impl::computeSpiral(float time) const {
+    CameraPathSample sample;
     if (duration <= 0.0f) {
-        cachedPosition = spiralCenter;
-        cachedTarget = spiralCenter;
-        cachedFov = 60.0f;
-        return;
+        sample.position = spiralCenter;
+        sample.target = spiralCenter;
+        return sample;
     }
 
-    float t = currentTime / duration;
+    float t = time / duration;
     float angle = t * spiralRevolutions * 2.0f * M_PI;
     float heightOffset = t * spiralHeight;
 
@@ -579,66 +725,50 @@ void CameraPath::Impl::computeSpiralPosition() const {
     // Add height along spiral axis
     oflike::float3 heightVec = spiralAxis * heightOffset;
 
-    cachedPosition = spiralCenter + rotatedOffset + heightVec;
-    cachedTarget = lookAtTarget;
-    cachedFov = 60.0f;
+    sample.position = spiralCenter + rotatedOffset + heightVec;
+    sample.target = lookAtTarget;
+    return sample;
 }
 
-void CameraPath::Impl::computeKeyframePosition() const {
+CameraPathSample CameraPath::Impl::computeKeyframe(float time, size_t& segmentHint) const {
+    CameraPathSample sample;
     if (keyframes.empty()) {
-        cachedPosition = {0.0f, 0.0f, 5.0f};
-        cachedTarget = {0.0f, 0.0f, 0.0f};
-        cachedFov = 60.0f;
-        return;
+        sample.position = {0.0f, 0.0f, 5.0f};
+        sample.target = {0.0f, 0.0f, 0.0f};
+        return sample;
     }
 
-    if (keyframes.size() == 1) {
-        cachedPosition = keyframes[0].position;
-        cachedTarget = keyframes[0].target;
-        cachedFov = keyframes[0].fov;
-        return;
+    // Clamp to the first and last keyframes
+    const CameraKeyframe* held = nullptr;
+    if (keyframes.size() == 1 || time <= keyframes.front().time) {
+        held = &keyframes.front();
+    } else if (time >= keyframes.back().time) {
+        held = &keyframes.back();
     }
-
-    // Ensure keyframes are sorted
-    if (!keyframesSorted) {
-        std::sort(const_cast<std::vector<CameraKeyframe>&>(keyframes).begin(),
-                  const_cast<std::vector<CameraKeyframe>&>(keyframes).end(),
-                  [](const CameraKeyframe& a, const CameraKeyframe& b) {
-                      return a.time < b.time;
-                  });
-        const_cast<Impl*>(this)->keyframesSorted = true;
+    if (held) {
+        sample.position = held->position;
+        sample.target = held->target;
+        sample.fov = held->fov;
+        return sample;
     }
 
     // Find keyframe segment
-    size_t k1 = 0;
-    for (size_t i = 0; i < keyframes.size() - 1; ++i) {
-        if (currentTime >= keyframes[i].time && currentTime <= keyframes[i + 1].time) {
-            k1 = i;
-            break;
-        }
-    }
-
-    // Clamp to last keyframe if beyond
-    if (currentTime >= keyframes.back().time) {
-        cachedPosition = keyframes.back().position;
-        cachedTarget = keyframes.back().target;
-        cachedFov = keyframes.back().fov;
-        return;
-    }
-
+    size_t k1 = findKeyframeSegment(time, segmentHint);
+    segmentHint = k1;
     size_t k2 = k1 + 1;
 
     // Calculate local t
     float t1 = keyframes[k1].time;
     float t2 = keyframes[k2].time;
-    float localT = (currentTime - t1) / (t2 - t1);
+    float localT = t2 > t1 ? (time - t1) / (t2 - t1) : 1.0f;
+
+    sample.fov = keyframes[k1].fov + (keyframes[k2].fov - keyframes[k1].fov) * localT;
 
     // Interpolate based on mode
     switch (interpolationMode) {
         case InterpolationMode::Linear:
-            cachedPosition = lerp(keyframes[k1].position, keyframes[k2].position, localT);
-            cachedTarget = lerp(keyframes[k1].target, keyframes[k2].target, localT);
-            cachedFov = keyframes[k1].fov + (keyframes[k2].fov - keyframes[k1].fov) * localT;
+            sample.position = lerp(keyframes[k1].position, keyframes[k2].position, localT);
+            sample.target = lerp(keyframes[k1].target, keyframes[k2].target, localT);
             break;
 
         case InterpolationMode::CatmullRom: {
@@ -646,19 +776,17 @@ void CameraPath::Impl::computeKeyframePosition() const {
             size_t k0 = (k1 > 0) ? k1 - 1 : k1;
             size_t k3 = (k2 + 1 < keyframes.size()) ? k2 + 1 : k2;
 
-            cachedPosition = catmullRom(keyframes[k0].position,
-                                        keyframes[k1].position,
-                                        keyframes[k2].position,
-                                        keyframes[k3].position,
-                                        localT);
-
-            cachedTarget = catmullRom(keyframes[k0].target,
-                                      keyframes[k1].target,
-                                      keyframes[k2].target,
-                                      keyframes[k3].target,
-                                      localT);
-
-            cachedFov = keyframes[k1].fov + (keyframes[k2].fov - keyframes[k1].fov) * localT;
+            sample.position = catmullRom(keyframes[k0].position,
+                                         keyframes[k1].position,
+                                         keyframes[k2].position,
+                                         keyframes[k3].position,
+                                         localT);
+
+            sample.target = catmullRom(keyframes[k0].target,
+                                       keyframes[k1].target,
+                                       keyframes[k2].target,
+                                       keyframes[k3].target,
+                                       localT);
             break;
         }
 
@@ -673,7 +801,7 @@ void CameraPath::Impl::computeKeyframePosition() const {
             oflike::float3 p3 = keyframes[k2].position;
             oflike::float3 p2 = p3 - tan2;
 
-            cachedPosition = bezier(p0, p1, p2, p3, localT);
+            sample.position = bezier(p0, p1, p2, p3, localT);
 
             // Same for target
             tan1 = (keyframes[k2].target - keyframes[k1].target) * 0.333f;
@@ -684,12 +812,11 @@ void CameraPath::Impl::computeKeyframePosition() const {
             p3 = keyframes[k2].target;
             p2 = p3 - tan2;
 
-            cachedTarget = bezier(p0, p1, p2, p3, localT);
-
-            cachedFov = keyframes[k1].fov + (keyframes[k2].fov - keyframes[k1].fov) * localT;
+            sample.target = bezier(p0, p1, p2, p3, localT);
             break;
         }
     }
+    return sample;
 }
 
 } // namespace Sharp
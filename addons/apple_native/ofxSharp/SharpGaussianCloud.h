@@ -15,6 +15,7 @@
 
 #include "SharpGaussian.h"
 #include "math/Types.h"
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
@@ -22,10 +23,39 @@
 // Forward declarations
 namespace oflike {
     class ofMatrix4x4;
+    class ofAssetManager;
 }
 
 namespace Sharp {
 
+// Default number of SH codebook entries for compressed storage
+constexpr int kDefaultSHCodebookSize = 4096;
+
+// Sections of the compressed Metal buffer (byte offsets, 256-aligned).
+// The layout matches shaders/GaussianCompressed.h.
+struct CompressedBufferLayout {
+    size_t splatOffset = 0;         // 28 bytes per Gaussian
+    size_t chunkOffset = 0;         // Position bounds per 256 Gaussians
+    size_t codebookOffset = 0;      // SH entries, 48 halves each
+    size_t codebookSize = 0;        // Entries
+};
+
+// Default maximum Gaussians per LOD node
+constexpr size_t kDefaultLODLeafSize = 16384;
+
+// One node of the LOD octree. Leaves own a range of getGaussians();
+// interior nodes own merged splats in getLODGaussians() that stand in
+// for everything below them.
+struct LODNode {
+    oflike::float3 boundsMin{0.0f, 0.0f, 0.0f};
+    oflike::float3 boundsMax{0.0f, 0.0f, 0.0f};
+    float error = 0.0f;             // World-space detail lost by drawing this node (0 for leaves)
+    uint32_t first = 0;             // First Gaussian of the node's own splats
+    uint32_t count = 0;
+    int32_t children[8] = {-1, -1, -1, -1, -1, -1, -1, -1};  // Node indices, -1 = none
+    bool leaf = true;
+};
+
 class GaussianCloud {
 public:
     // ============================================================================
@@ -59,7 +89,7 @@ public:
     // Clear all Gaussians
     void clear();
 
-    // Get number of Gaussians
+    // Get number of Gaussians (those loaded so far during loadAsync())
     size_t size() const;
 
     // Check if empty
@@ -76,6 +106,11 @@ public:
     // Spatial Transformations
     // ============================================================================
 
+    // Once updateMetalBuffer() has uploaded an uncompressed cloud, these run
+    // as one compute dispatch on its GPU copy; the CPU copy is read back the
+    // next time it is accessed. Bounds are then carried through the edit
+    // (conservative after rotations) until updateBounds().
+
     // Apply translation to all Gaussians
     void translate(const oflike::float3& offset);
 
@@ -98,6 +133,11 @@ public:
     // Filtering & Culling
     // ============================================================================
 
+    // Filters keep the survivors in order. When the GPU copy is current they
+    // compact it in place of the CPU copy (read back when next needed), so
+    // they can follow a slider each frame; otherwise the CPU copy is
+    // compacted across cores and only its changed tail is re-uploaded.
+
     // Filter Gaussians by opacity threshold
     void filterByOpacity(float minOpacity);
 
@@ -134,6 +174,8 @@ public:
     // ============================================================================
 
     // Update Metal buffer with current Gaussian data
+    // Only the range changed since the last update is uploaded; capacity
+    // doubles when the cloud grows
     // Returns true if successful
     bool updateMetalBuffer();
 
@@ -147,14 +189,75 @@ public:
     // Check if Metal buffer is up-to-date
     bool isBufferDirty() const;
 
+    // Incremented whenever the Metal buffer's contents change
+    uint64_t getBufferGeneration() const;
+
+    // Make the Metal buffer hold count Gaussians (in the Gaussian layout)
+    // for the caller to fill on the GPU, as SharpModel::predictInto does.
+    // The CPU copy is dropped and read back only when next accessed.
+    // Returns the buffer (id<MTLBuffer>); nullptr for compressed clouds or
+    // on failure. Finish writing it before the cloud is rendered.
+    void* resizeOnGPU(size_t count);
+
+    // ============================================================================
+    // Compressed Storage
+    // ============================================================================
+
+    // Store the Metal buffer compressed, about 28 bytes per Gaussian instead
+    // of ~250: 16-bit positions within the bounds of 256-Gaussian chunks,
+    // half-float scale and color, smallest-three quaternions, 8-bit opacity
+    // and vector-quantized SH (k-means codebook of shCodebookSize entries).
+    // The next updateMetalBuffer() converts; it reorders the Gaussians along
+    // a Morton curve so chunks stay spatially tight.
+    void setCompressed(bool compressed, int shCodebookSize = kDefaultSHCodebookSize);
+
+    // Check if the Metal buffer uses the compressed layout
+    bool isCompressed() const;
+
+    // Get the compressed buffer's sections (valid after updateMetalBuffer())
+    CompressedBufferLayout getCompressedLayout() const;
+
+    // ============================================================================
+    // Level of Detail
+    // ============================================================================
+
+    // Build an octree over the cloud for SharpRenderer to draw under a splat
+    // budget. Nodes split until they hold at most leafSize Gaussians, and
+    // each interior node gets merged splats (moment-matched per cell of a
+    // 16^3 grid) drawn in place of its children when they'd be too small
+    // on screen. Reorders the Gaussians; any later edit (or compressing)
+    // discards the tree.
+    bool buildLOD(size_t leafSize = kDefaultLODLeafSize);
+    bool hasLOD() const;
+    void clearLOD();
+
+    // Node 0 is the root
+    const std::vector<LODNode>& getLODNodes() const;
+    const std::vector<Gaussian>& getLODGaussians() const;
+
+    // Incremented by each buildLOD()
+    uint64_t getLODGeneration() const;
+
     // ============================================================================
     // Import / Export
     // ============================================================================
 
-    // Load from PLY file
+    // Load from PLY file (SHARP, or standard 3DGS with f_dc_/f_rest_ fields)
     // Returns true if successful
     bool loadFromPLY(const std::string& filepath);
 
+    // Load a PLY or .splat file, chosen by extension
+    // The file is memory-mapped and converted in parallel chunks
+    bool loadFromFile(const std::string& filepath);
+
+    // Start loading in the background; returns false if the file can't be read
+    // While loading, size() grows as chunks finish and the first size()
+    // Gaussians are complete; changing the cloud waits for the load
+    bool loadAsync(const std::string& filepath);
+    bool isLoading() const;
+    float getLoadProgress() const;     // 0-1
+    void waitUntilLoaded();
+
     // Save to PLY file
     // Returns true if successful
     bool saveToPLY(const std::string& filepath) const;
@@ -178,4 +281,9 @@ private:
     std::unique_ptr<Impl> impl_;
 };
 
+// Register the "splat" asset type with an asset manager: GaussianClouds
+// loaded from .ply or .splat on its worker threads and uploaded to Metal
+// by its update(), within the upload budget
+void registerAssetLoader(oflike::ofAssetManager& assets);
+
 } // namespace Sharp
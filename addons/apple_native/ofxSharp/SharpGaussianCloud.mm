@@ -1,14 +1,562 @@
 #import <Metal/Metal.h>
 #import <simd/simd.h>
+#import <Accelerate/Accelerate.h>
 #include "SharpGaussianCloud.h"
 #include "math/ofMatrix4x4.h"
+#include "utils/ofBuffer.h"
+#include "utils/ofAssetManager.h"
+#include "render/metal/MetalAllocations.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <mutex>
 #include <numeric>
+#include <type_traits>
 
 namespace Sharp {
 
+// ============================================================================
+// Compressed Layout (must match shaders/GaussianCompressed.h)
+// ============================================================================
+
+struct CompressedGaussian {
+    uint16_t position[3];   // Unorm16 within the chunk's bounds
+    uint16_t shIndex;       // SH codebook entry
+    uint16_t scale[3];      // Half floats
+    uint8_t opacity;        // Unorm8
+    uint8_t padding;
+    uint32_t rotation;      // Smallest three
+    uint16_t color[3];      // Half floats (sh_dc)
+    uint16_t padding2;
+};
+static_assert(sizeof(CompressedGaussian) == 28, "CompressedGaussian must match the shader layout");
+
+struct CompressedChunk {
+    simd_float3 positionMin;
+    simd_float3 positionExtent;
+};
+
+// Mirrors CloudTransform in GaussianSplatting.metal
+struct CloudTransform {
+    simd_float4x4 matrix;
+    simd_float4 rotation;
+    simd_float3 scale;
+    uint32_t count;
+};
+
+// Keep test for the filters (must match shaders/GaussianSplatting.metal)
+struct CloudFilter {
+    simd_float3 minBounds;
+    simd_float3 maxBounds;
+    float minOpacity;
+    float minRadius;
+    float maxRadius;
+    uint32_t count;
+};
+
+// The transform and filter kernels edit the GPU copy through the shader's
+// Gaussian, and the CPU filters move Gaussians with memmove
+static_assert(sizeof(Gaussian) == 320, "Gaussian must match the shader layout");
+static_assert(std::is_trivially_copyable<Gaussian>::value, "Gaussian must be trivially copyable");
+
+static constexpr size_t kFilterChunkSize = 16384;   // Gaussians per CPU filter task
+static constexpr uint32_t kFilterThreads = 256;     // CLOUD_FILTER_THREADS in the shader
+
+static constexpr size_t kCompressedChunkSize = 256;
+static constexpr size_t kSHCodebookStride = 48;    // Halves per entry
+static constexpr int kSHValues = (kNumSHCoefficients - 1) * 3;
+
+// k-means trains on about this many Gaussians, for this many iterations
+static constexpr size_t kCodebookSamples = 65536;
+static constexpr int kCodebookIterations = 10;
+
+static uint16_t toHalf(float value) {
+    __fp16 half = static_cast<__fp16>(value);
+    uint16_t bits;
+    std::memcpy(&bits, &half, sizeof(bits));
+    return bits;
+}
+
+static uint16_t toUnorm16(float value, float minValue, float extent) {
+    float t = extent > 0.0f ? (value - minValue) / extent : 0.0f;
+    return static_cast<uint16_t>(std::lround(std::clamp(t, 0.0f, 1.0f) * 65535.0f));
+}
+
+// Largest component's index in bits 30-31, the other three (which lie in
+// +-1/sqrt(2) once the largest is made positive) as 10 bits each
+static uint32_t packRotation(const oflike::quatf& rotation) {
+    simd_float4 q = simd_normalize(rotation.vector);
+    int largest = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (std::fabs(q[i]) > std::fabs(q[largest])) {
+            largest = i;
+        }
+    }
+    if (q[largest] < 0.0f) {
+        q = -q;
+    }
+
+    const float range = 0.70710678f;
+    uint32_t packed = static_cast<uint32_t>(largest) << 30;
+    int shift = 20;
+    for (int i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        float t = std::clamp((q[i] + range) / (2.0f * range), 0.0f, 1.0f);
+        packed |= static_cast<uint32_t>(std::lround(t * 1023.0f)) << shift;
+        shift -= 10;
+    }
+    return packed;
+}
+
+// 10 bits per axis, interleaved
+static uint32_t mortonCode(const oflike::float3& position, const oflike::float3& minBounds,
+                           const oflike::float3& extent) {
+    auto spread = [](uint32_t v) {
+        v = (v | (v << 16)) & 0x030000FF;
+        v = (v | (v << 8)) & 0x0300F00F;
+        v = (v | (v << 4)) & 0x030C30C3;
+        v = (v | (v << 2)) & 0x09249249;
+        return v;
+    };
+    uint32_t code = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        float t = extent[axis] > 0.0f ? (position[axis] - minBounds[axis]) / extent[axis] : 0.0f;
+        uint32_t cell = static_cast<uint32_t>(std::clamp(t, 0.0f, 1.0f) * 1023.0f);
+        code |= spread(cell) << axis;
+    }
+    return code;
+}
+
+static void copySH(const Gaussian& g, float* out) {
+    for (size_t c = 0; c < g.sh_rest.size(); ++c) {
+        out[c * 3 + 0] = g.sh_rest[c].x;
+        out[c * 3 + 1] = g.sh_rest[c].y;
+        out[c * 3 + 2] = g.sh_rest[c].z;
+    }
+}
+
+// Nearest codebook entry per row. |x - c|^2 ranks like |c|^2 - 2 x.c, and
+// the dot products of a whole batch are one matrix product.
+static void nearestEntries(const float* rows, size_t rowCount,
+                           const std::vector<float>& codebook, const std::vector<float>& norms,
+                           std::vector<float>& dots, uint16_t* labels) {
+    const int k = static_cast<int>(norms.size());
+    dots.resize(rowCount * k);
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans,
+                static_cast<int>(rowCount), k, kSHValues,
+                1.0f, rows, kSHValues, codebook.data(), kSHValues,
+                0.0f, dots.data(), k);
+    for (size_t r = 0; r < rowCount; ++r) {
+        const float* d = dots.data() + r * k;
+        int best = 0;
+        float bestDistance = norms[0] - 2.0f * d[0];
+        for (int j = 1; j < k; ++j) {
+            float distance = norms[j] - 2.0f * d[j];
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = j;
+            }
+        }
+        labels[r] = static_cast<uint16_t>(best);
+    }
+}
+
+// A filter that keeps everything; callers tighten one limit
+static CloudFilter passAllFilter() {
+    CloudFilter filter;
+    filter.minBounds = simd_make_float3(-INFINITY, -INFINITY, -INFINITY);
+    filter.maxBounds = simd_make_float3(INFINITY, INFINITY, INFINITY);
+    filter.minOpacity = -INFINITY;
+    filter.minRadius = -INFINITY;
+    filter.maxRadius = INFINITY;
+    filter.count = 0;
+    return filter;
+}
+
+// The filters' removal tests, negated (cloudFilterKeeps in the shader)
+static bool filterKeeps(const Gaussian& g, const CloudFilter& filter) {
+    const float radius = g.getRadius();
+    return !(g.opacity < filter.minOpacity) &&
+           !(radius < filter.minRadius || radius > filter.maxRadius) &&
+           !simd_any(g.position < filter.minBounds) && !simd_any(g.position > filter.maxBounds);
+}
+
+static void codebookNorms(const std::vector<float>& codebook, std::vector<float>& norms) {
+    for (size_t j = 0; j < norms.size(); ++j) {
+        const float* c = codebook.data() + j * kSHValues;
+        norms[j] = cblas_sdot(kSHValues, c, 1, c, 1);
+    }
+}
+
+// ============================================================================
+// Streaming Loader
+// ============================================================================
+
+// Records convert in parallel chunks of this many Gaussians; each finished
+// run of chunks from the start becomes visible and is uploaded
+static constexpr size_t kLoadChunkSize = 65536;
+
+// Read-only mapping of a whole file
+struct MappedFile {
+    ofBuffer buffer;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    bool open(const std::string& filepath) {
+        buffer = ofBufferMapFile(filepath);
+        if (!buffer.isAllocated()) {
+            return false;
+        }
+        data = reinterpret_cast<const uint8_t*>(buffer.begin());
+        size = buffer.size();
+        return true;
+    }
+};
+
+enum class PLYType { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
+
+struct PLYProperty {
+    size_t offset;
+    PLYType type;
+};
+
+// Gaussian fields a record may provide
+enum RecordField {
+    kFieldX, kFieldY, kFieldZ,
+    kFieldScale0, kFieldScale1, kFieldScale2,
+    kFieldRot0, kFieldRot1, kFieldRot2, kFieldRot3,
+    kFieldOpacity,
+    kFieldColor0, kFieldColor1, kFieldColor2,
+    kFieldRest0,
+    kFieldCount = kFieldRest0 + (kNumSHCoefficients - 1) * 3
+};
+
+// Where a file's records are and how to read them
+struct RecordLayout {
+    enum class Format {
+        SharpPLY,       // saveToPLY(): linear values, rot_0-3 = (x, y, z, w)
+        StandardPLY,    // Reference 3DGS: log scales, logit opacity, f_dc/f_rest SH, rot_0 = w
+        Splat           // 32-byte .splat records
+    };
+    Format format = Format::SharpPLY;
+    size_t dataOffset = 0;
+    size_t stride = 0;
+    size_t count = 0;
+    PLYProperty fields[kFieldCount];
+    bool hasField[kFieldCount] = {};
+};
+
+static bool parsePLYType(const std::string& name, PLYType& type, size_t& size) {
+    static const struct { const char* names[2]; PLYType type; size_t size; } kTypes[] = {
+        {{"char", "int8"}, PLYType::Int8, 1},       {{"uchar", "uint8"}, PLYType::UInt8, 1},
+        {{"short", "int16"}, PLYType::Int16, 2},    {{"ushort", "uint16"}, PLYType::UInt16, 2},
+        {{"int", "int32"}, PLYType::Int32, 4},      {{"uint", "uint32"}, PLYType::UInt32, 4},
+        {{"float", "float32"}, PLYType::Float32, 4}, {{"double", "float64"}, PLYType::Float64, 8},
+    };
+    for (const auto& entry : kTypes) {
+        if (name == entry.names[0] || name == entry.names[1]) {
+            type = entry.type;
+            size = entry.size;
+            return true;
+        }
+    }
+    return false;
+}
+
+static int plyField(const std::string& name) {
+    static const char* kNames[] = {"x", "y", "z"};
+    for (int i = 0; i < 3; ++i) {
+        if (name == kNames[i]) return kFieldX + i;
+    }
+    if (name == "opacity") return kFieldOpacity;
+
+    auto indexed = [&](const char* prefix, int count) -> int {
+        const size_t length = std::strlen(prefix);
+        if (name.compare(0, length, prefix) != 0) return -1;
+        const std::string suffix = name.substr(length);
+        if (suffix.empty() || !std::all_of(suffix.begin(), suffix.end(), ::isdigit)) return -1;
+        const int i = std::stoi(suffix);
+        return i < count ? i : -1;
+    };
+    int i;
+    if ((i = indexed("scale_", 3)) >= 0) return kFieldScale0 + i;
+    if ((i = indexed("rot_", 4)) >= 0) return kFieldRot0 + i;
+    if ((i = indexed("f_dc_", 3)) >= 0) return kFieldColor0 + i;
+    if ((i = indexed("f_rest_", (kNumSHCoefficients - 1) * 3)) >= 0) return kFieldRest0 + i;
+
+    static const char* kSharpNames[] = {"scale_x", "scale_y", "scale_z", "sh_dc_r", "sh_dc_g", "sh_dc_b"};
+    static const int kSharpFields[] = {kFieldScale0, kFieldScale1, kFieldScale2,
+                                       kFieldColor0, kFieldColor1, kFieldColor2};
+    for (int n = 0; n < 6; ++n) {
+        if (name == kSharpNames[n]) return kSharpFields[n];
+    }
+    return -1;
+}
+
+// The header is parsed once; records are then read at fixed offsets
+static bool parsePLYHeader(const MappedFile& file, RecordLayout& layout) {
+    const char* begin = reinterpret_cast<const char*>(file.data);
+    const size_t searchSize = std::min<size_t>(file.size, 1 << 20);
+    static const char kEnd[] = "end_header\n";
+    const char* end = std::search(begin, begin + searchSize, kEnd, kEnd + sizeof(kEnd) - 1);
+    if (end == begin + searchSize) {
+        return false;
+    }
+
+    std::istringstream header(std::string(begin, end));
+    std::string line;
+    bool binary = false;
+    bool inVertex = false;
+    bool vertexSeen = false;
+    bool standard = false;          // Reference 3DGS names its color f_dc_*
+    while (std::getline(header, line)) {
+        std::istringstream words(line);
+        std::string keyword;
+        words >> keyword;
+        if (keyword == "format") {
+            std::string format;
+            words >> format;
+            binary = format == "binary_little_endian";
+        } else if (keyword == "element") {
+            std::string name;
+            size_t count = 0;
+            words >> name >> count;
+            if (vertexSeen || name != "vertex") {
+                // Records must start right after the header
+                inVertex = false;
+                if (!vertexSeen) return false;
+                continue;
+            }
+            inVertex = vertexSeen = true;
+            layout.count = count;
+        } else if (keyword == "property" && inVertex) {
+            std::string typeName, name;
+            words >> typeName >> name;
+            PLYType type;
+            size_t size;
+            if (!parsePLYType(typeName, type, size)) {
+                return false;       // List properties have no fixed stride
+            }
+            const int field = plyField(name);
+            standard = standard || name.compare(0, 5, "f_dc_") == 0;
+            if (field >= 0) {
+                layout.fields[field] = {layout.stride, type};
+                layout.hasField[field] = true;
+            }
+            layout.stride += size;
+        }
+    }
+
+    layout.dataOffset = static_cast<size_t>(end - begin) + sizeof(kEnd) - 1;
+    layout.format = standard ? RecordLayout::Format::StandardPLY : RecordLayout::Format::SharpPLY;
+    return binary && layout.count > 0 && layout.stride > 0 &&
+           layout.hasField[kFieldX] && layout.hasField[kFieldY] && layout.hasField[kFieldZ] &&
+           layout.dataOffset + layout.count * layout.stride <= file.size;
+}
+
+static float readPLYValue(const uint8_t* record, const PLYProperty& property) {
+    const uint8_t* p = record + property.offset;
+    switch (property.type) {
+        case PLYType::Int8: { int8_t v; std::memcpy(&v, p, 1); return v; }
+        case PLYType::UInt8: return *p;
+        case PLYType::Int16: { int16_t v; std::memcpy(&v, p, 2); return v; }
+        case PLYType::UInt16: { uint16_t v; std::memcpy(&v, p, 2); return v; }
+        case PLYType::Int32: { int32_t v; std::memcpy(&v, p, 4); return static_cast<float>(v); }
+        case PLYType::UInt32: { uint32_t v; std::memcpy(&v, p, 4); return static_cast<float>(v); }
+        case PLYType::Float32: { float v; std::memcpy(&v, p, 4); return v; }
+        case PLYType::Float64: { double v; std::memcpy(&v, p, 8); return static_cast<float>(v); }
+    }
+    return 0.0f;
+}
+
+static void convertRecord(const RecordLayout& layout, const uint8_t* record, Gaussian& g) {
+    if (layout.format == RecordLayout::Format::Splat) {
+        // position, scale (3 floats each), RGBA and quaternion (w, x, y, z) bytes
+        float values[6];
+        std::memcpy(values, record, sizeof(values));
+        const uint8_t* rgba = record + 24;
+        const uint8_t* rot = record + 28;
+        g.position = oflike::float3{values[0], values[1], values[2]};
+        g.scale = oflike::float3{values[3], values[4], values[5]};
+        g.sh_dc = oflike::float3{float(rgba[0]), float(rgba[1]), float(rgba[2])} / 255.0f;
+        g.opacity = rgba[3] / 255.0f;
+        simd_float4 q = (simd_float4{float(rot[1]), float(rot[2]), float(rot[3]), float(rot[0])} - 128.0f) / 128.0f;
+        g.rotation = simd_quaternion(simd_normalize(q));
+        return;
+    }
+
+    float v[kFieldCount] = {};
+    v[kFieldScale0] = v[kFieldScale1] = v[kFieldScale2] = 1.0f;
+    v[kFieldOpacity] = 1.0f;
+    for (int f = 0; f < kFieldCount; ++f) {
+        if (layout.hasField[f]) {
+            v[f] = readPLYValue(record, layout.fields[f]);
+        }
+    }
+
+    g.position = oflike::float3{v[kFieldX], v[kFieldY], v[kFieldZ]};
+    if (layout.format == RecordLayout::Format::StandardPLY) {
+        const float C0 = 0.28209479177387814f;
+        g.scale = oflike::float3{std::exp(v[kFieldScale0]), std::exp(v[kFieldScale1]), std::exp(v[kFieldScale2])};
+        g.opacity = 1.0f / (1.0f + std::exp(-v[kFieldOpacity]));
+        g.rotation = simd_quaternion(simd_normalize(simd_float4{v[kFieldRot1], v[kFieldRot2],
+                                                                v[kFieldRot3], v[kFieldRot0]}));
+        g.sh_dc = oflike::float3{0.5f + C0 * v[kFieldColor0], 0.5f + C0 * v[kFieldColor1],
+                                 0.5f + C0 * v[kFieldColor2]};
+        // f_rest is channel-major: 15 red coefficients, then green, then blue
+        const size_t rest = g.sh_rest.size();
+        for (size_t c = 0; c < rest; ++c) {
+            g.sh_rest[c] = oflike::float3{v[kFieldRest0 + c], v[kFieldRest0 + rest + c],
+                                          v[kFieldRest0 + 2 * rest + c]};
+        }
+    } else {
+        g.scale = oflike::float3{v[kFieldScale0], v[kFieldScale1], v[kFieldScale2]};
+        g.opacity = v[kFieldOpacity];
+        g.rotation = simd_quaternion(v[kFieldRot0], v[kFieldRot1], v[kFieldRot2],
+                                     layout.hasField[kFieldRot3] ? v[kFieldRot3] : 1.0f);
+        g.sh_dc = oflike::float3{v[kFieldColor0], v[kFieldColor1], v[kFieldColor2]};
+    }
+}
+
+static bool hasExtension(const std::string& filepath, const char* extension) {
+    const size_t length = std::strlen(extension);
+    if (filepath.size() < length) return false;
+    return std::equal(extension, extension + length, filepath.end() - length,
+                      [](char a, char b) { return a == std::tolower(static_cast<unsigned char>(b)); });
+}
+
+// ============================================================================
+// Level of Detail
+// ============================================================================
+
+// Octree depth limit: one level per bit of mortonCode()'s 10 per axis
+static constexpr int kLODMaxDepth = 10;
+
+// Interior nodes merge their children's splats per cell of this grid
+static constexpr int kLODGrid = 16;
+
+// Eigenvalues and eigenvectors (columns) of a symmetric 3x3 matrix, by
+// cyclic Jacobi rotations
+static void symmetricEigen(const simd_float3x3& matrix, simd_float3& values, simd_float3x3& vectors) {
+    float a[3][3];
+    float v[3][3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            a[row][col] = matrix.columns[col][row];
+        }
+    }
+
+    for (int sweep = 0; sweep < 8; ++sweep) {
+        if (a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2] < 1e-20f) {
+            break;
+        }
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                if (std::fabs(a[p][q]) < 1e-20f) {
+                    continue;
+                }
+                const float theta = (a[q][q] - a[p][p]) / (2.0f * a[p][q]);
+                const float t = std::copysign(1.0f, theta) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0f));
+                const float c = 1.0f / std::sqrt(t * t + 1.0f);
+                const float sn = t * c;
+                for (int k = 0; k < 3; ++k) {
+                    const float kp = a[k][p], kq = a[k][q];
+                    a[k][p] = c * kp - sn * kq;
+                    a[k][q] = sn * kp + c * kq;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const float pk = a[p][k], qk = a[q][k];
+                    a[p][k] = c * pk - sn * qk;
+                    a[q][k] = sn * pk + c * qk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const float kp = v[k][p], kq = v[k][q];
+                    v[k][p] = c * kp - sn * kq;
+                    v[k][q] = sn * kp + c * kq;
+                }
+            }
+        }
+    }
+
+    values = simd_make_float3(a[0][0], a[1][1], a[2][2]);
+    vectors = simd_matrix(simd_make_float3(v[0][0], v[1][0], v[2][0]),
+                          simd_make_float3(v[0][1], v[1][1], v[2][1]),
+                          simd_make_float3(v[0][2], v[1][2], v[2][2]));
+}
+
+// Footprint of a splat seen face-on
+static float splatArea(const oflike::float3& scale) {
+    return std::max({scale.x * scale.y, scale.y * scale.z, scale.x * scale.z, 1e-12f});
+}
+
+// One splat per occupied grid cell, matching the weighted mean and
+// covariance of the splats in it; opacity keeps their summed coverage
+static std::vector<Gaussian> mergeCells(const std::vector<const Gaussian*>& sources,
+                                        const oflike::float3& cellMin, const oflike::float3& cellMax) {
+    const oflike::float3 extent = simd_max(cellMax - cellMin, oflike::float3{1e-12f, 1e-12f, 1e-12f});
+    std::vector<std::pair<uint32_t, const Gaussian*>> cells(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const oflike::float3 t = (sources[i]->position - cellMin) / extent * float(kLODGrid);
+        const simd_int3 cell = simd_clamp(simd_int(t), simd_int3{0, 0, 0},
+                                          simd_int3{kLODGrid - 1, kLODGrid - 1, kLODGrid - 1});
+        cells[i] = {static_cast<uint32_t>(cell.x + kLODGrid * (cell.y + kLODGrid * cell.z)), sources[i]};
+    }
+    std::sort(cells.begin(), cells.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<Gaussian> merged;
+    for (size_t begin = 0; begin < cells.size();) {
+        size_t end = begin;
+        float weight = 0.0f;
+        float coverage = 0.0f;
+        oflike::float3 mean{0.0f, 0.0f, 0.0f};
+        for (; end < cells.size() && cells[end].first == cells[begin].first; ++end) {
+            const Gaussian& g = *cells[end].second;
+            const float w = std::max(g.opacity * splatArea(g.scale), 1e-20f);
+            weight += w;
+            coverage += g.opacity * splatArea(g.scale);
+            mean += w * g.position;
+        }
+        mean /= weight;
+
+        Gaussian out;
+        out.position = mean;
+        out.sh_dc = oflike::float3{0.0f, 0.0f, 0.0f};
+        simd_float3x3 covariance = simd_matrix(oflike::float3{0.0f, 0.0f, 0.0f}, oflike::float3{0.0f, 0.0f, 0.0f},
+                                               oflike::float3{0.0f, 0.0f, 0.0f});
+        for (size_t i = begin; i < end; ++i) {
+            const Gaussian& g = *cells[i].second;
+            const float w = std::max(g.opacity * splatArea(g.scale), 1e-20f) / weight;
+            const oflike::float3 d = g.position - mean;
+            const simd_float3x3 spread = simd_matrix(d * d.x, d * d.y, d * d.z);
+            covariance = simd_add(covariance, simd_mul(w, simd_add(g.getCovariance(), spread)));
+            out.sh_dc += w * g.sh_dc;
+            for (size_t c = 0; c < out.sh_rest.size(); ++c) {
+                out.sh_rest[c] += w * g.sh_rest[c];
+            }
+        }
+
+        simd_float3 variances;
+        simd_float3x3 axes;
+        symmetricEigen(covariance, variances, axes);
+        if (simd_determinant(axes) < 0.0f) {
+            axes.columns[2] = -axes.columns[2];
+        }
+        out.scale = simd_sqrt(simd_max(variances, simd_float3{1e-12f, 1e-12f, 1e-12f}));
+        out.rotation = simd_normalize(simd_quaternion(axes));
+        out.opacity = std::min(1.0f, coverage / splatArea(out.scale));
+        merged.push_back(out);
+        begin = end;
+    }
+    return merged;
+}
+
 // ============================================================================
 // Private Implementation
 // ============================================================================
@@ -28,6 +576,44 @@ public:
     id<MTLBuffer> gaussianBuffer = nil;
     bool bufferDirty = true;
 
+    // GPU copy in the Gaussian layout: gpuCount entries are valid, and
+    // [dirtyBegin, dirtyEnd) changed on the CPU since the last upload
+    size_t gpuCount = 0;
+    size_t dirtyBegin = 0;
+    size_t dirtyEnd = SIZE_MAX;
+    uint64_t bufferGeneration = 0;
+
+    // GPU transforms edit only the GPU copy; the CPU copy is read back
+    // the next time it is needed
+    bool cpuStale = false;
+    id<MTLComputePipelineState> transformPipeline = nil;
+    bool transformPipelineFailed = false;
+
+    // Filters compact the GPU copy the same way
+    id<MTLComputePipelineState> filterCountPipeline = nil;
+    id<MTLComputePipelineState> filterScanPipeline = nil;
+    id<MTLComputePipelineState> filterScatterPipeline = nil;
+    bool filterPipelinesFailed = false;
+
+    id<MTLCommandQueue> uploadQueue = nil;
+
+    // Compressed storage
+    bool compressed = false;
+    int shCodebookSize = kDefaultSHCodebookSize;
+    CompressedBufferLayout compressedLayout;
+
+    // LOD octree (empty when not built)
+    std::vector<LODNode> lodNodes;
+    std::vector<Gaussian> lodGaussians;
+    uint64_t lodGeneration = 0;
+
+    // Streaming loads: gaussians is sized up front and the first
+    // loadedCount entries are complete
+    dispatch_group_t loadGroup = dispatch_group_create();
+    std::atomic<bool> loading{false};
+    std::atomic<bool> cancelLoad{false};
+    std::atomic<size_t> loadedCount{0};
+
     Impl() {
         @autoreleasepool {
             device = MTLCreateSystemDefaultDevice();
@@ -39,26 +625,96 @@ public:
     }
 
     ~Impl() {
+        cancelLoad = true;
+        waitForLoad();
         @autoreleasepool {
             gaussianBuffer = nil;
+            transformPipeline = nil;
+            filterCountPipeline = nil;
+            filterScanPipeline = nil;
+            filterScatterPipeline = nil;
+            uploadQueue = nil;
             device = nil;
         }
     }
 
     void markDirty() {
         boundsDirty = true;
+        markRangeDirty(0, SIZE_MAX);
+    }
+
+    void markRangeDirty(size_t begin, size_t end) {
+        clearLODImpl();
         bufferDirty = true;
+        dirtyBegin = std::min(dirtyBegin, begin);
+        dirtyEnd = std::max(dirtyEnd, end);
+    }
+
+    void clearDirty() {
+        bufferDirty = false;
+        dirtyBegin = SIZE_MAX;
+        dirtyEnd = 0;
+    }
+
+    // Wait for a streaming load and bring back GPU-side edits before the
+    // CPU copy is read or changed
+    void syncCPU() {
+        waitForLoad();
+        if (!cpuStale) {
+            return;
+        }
+        cpuStale = false;
+        @autoreleasepool {
+            const size_t bytes = gpuCount * sizeof(Gaussian);
+            id<MTLBuffer> readback = render::metal::makeTrackedBuffer(device, bytes, MTLResourceStorageModeShared,
+                                                                      oflike::ofGpuMemoryCategory::Staging,
+                                                                      "Gaussian Cloud Readback");
+            id<MTLCommandBuffer> commandBuffer = [uploadQueue commandBuffer];
+            if (!readback || !commandBuffer) {
+                NSLog(@"[ofxSharp] Error: Failed to read back the Metal buffer");
+                return;
+            }
+            commandBuffer.label = @"Gaussian Cloud Readback";
+            gaussians.resize(gpuCount);     // Empty after resizeOnGPU()
+            id<MTLBlitCommandEncoder> blit = [commandBuffer blitCommandEncoder];
+            [blit copyFromBuffer:gaussianBuffer sourceOffset:0 toBuffer:readback destinationOffset:0 size:bytes];
+            [blit endEncoding];
+            [commandBuffer commit];
+            [commandBuffer waitUntilCompleted];
+            std::memcpy(gaussians.data(), readback.contents, bytes);
+        }
+    }
+
+    // Gaussians held, counting a GPU copy the CPU hasn't read back
+    size_t storedCount() const {
+        return cpuStale ? gpuCount : gaussians.size();
+    }
+
+    // Gaussians readable now: the loaded prefix while streaming
+    size_t visibleCount() const {
+        return loading.load(std::memory_order_acquire) ? loadedCount.load(std::memory_order_acquire)
+                                                       : storedCount();
+    }
+
+    void waitForLoad() {
+        dispatch_group_wait(loadGroup, DISPATCH_TIME_FOREVER);
     }
 
     void updateBoundsIfNeeded() {
-        if (!boundsDirty || gaussians.empty()) {
+        const bool streaming = loading.load(std::memory_order_acquire);
+        const size_t count = visibleCount();
+        if ((!boundsDirty && !streaming) || count == 0) {
             return;
         }
+        if (cpuStale) {
+            syncCPU();
+        }
 
         boundsMin = oflike::float3{INFINITY, INFINITY, INFINITY};
         boundsMax = oflike::float3{-INFINITY, -INFINITY, -INFINITY};
 
-        for (const auto& g : gaussians) {
+        for (size_t i = 0; i < count; ++i) {
+            const Gaussian& g = gaussians[i];
             // Consider Gaussian position + radius for bounds
             float radius = g.getRadius();
             oflike::float3 minPt = g.position - oflike::float3{radius, radius, radius};
@@ -68,115 +724,748 @@ public:
             boundsMax = simd_max(boundsMax, maxPt);
         }
 
-        boundsDirty = false;
+        // Still loading: more Gaussians will widen the bounds
+        boundsDirty = streaming;
     }
 
     bool updateMetalBufferImpl() {
-        if (!device || gaussians.empty()) {
+        if (!device || storedCount() == 0) {
             return false;
         }
+        if (compressed) {
+            syncCPU();
+            gpuCount = 0;
+            return updateCompressedBufferImpl();
+        }
+        if (!bufferDirty && gpuCount == storedCount()) {
+            return true;    // GPU copy is current (and may be newer than the CPU copy)
+        }
 
         @autoreleasepool {
-            size_t bufferSize = gaussians.size() * sizeof(Gaussian);
+            // Keep what the GPU already has and upload only the changed range
+            const size_t count = gaussians.size();
+            const size_t keep = std::min({gpuCount, count, dirtyBegin});
+            if (!reservePrivateBuffer(count, keep)) {
+                return false;
+            }
+            const size_t end = std::min(dirtyEnd, count);
+            if (keep < end) {
+                id<MTLCommandBuffer> upload = uploadRange(keep, end);
+                if (!upload) {
+                    return false;
+                }
+                [upload waitUntilCompleted];
+            }
 
-            // Create or resize buffer
-            if (!gaussianBuffer || gaussianBuffer.length != bufferSize) {
-                gaussianBuffer = [device newBufferWithLength:bufferSize
-                                                     options:MTLResourceStorageModeShared];
-                if (!gaussianBuffer) {
+            gpuCount = count;
+            bufferGeneration++;
+            clearDirty();
+            return true;
+        }
+    }
+
+    // Private buffer in the Gaussian layout, filled through staging blits.
+    // Capacity doubles on growth; the first keep Gaussians carry over.
+    bool reservePrivateBuffer(size_t count, size_t keep = 0) {
+        const size_t capacity = gaussianBuffer && gaussianBuffer.storageMode == MTLStorageModePrivate
+                                    ? gaussianBuffer.length / sizeof(Gaussian) : 0;
+        if (capacity >= count && count > 0) {
+            return true;
+        }
+        if (!uploadQueue) {
+            uploadQueue = [device newCommandQueue];
+            if (!uploadQueue) {
+                return false;
+            }
+        }
+
+        const size_t newCapacity = std::max(count, capacity * 2);
+        id<MTLBuffer> buffer = render::metal::makeTrackedBuffer(device, std::max<size_t>(newCapacity, 1) * sizeof(Gaussian),
+                                                                MTLResourceStorageModePrivate, oflike::ofGpuMemoryCategory::Splats,
+                                                                "Gaussian Cloud");
+        if (!buffer) {
+            NSLog(@"[ofxSharp] Error: Failed to create Metal buffer");
+            return false;
+        }
+
+        keep = std::min(keep, capacity);
+        if (keep > 0) {
+            id<MTLCommandBuffer> commandBuffer = [uploadQueue commandBuffer];
+            id<MTLBlitCommandEncoder> blit = [commandBuffer blitCommandEncoder];
+            [blit copyFromBuffer:gaussianBuffer sourceOffset:0 toBuffer:buffer destinationOffset:0
+                            size:keep * sizeof(Gaussian)];
+            [blit endEncoding];
+            [commandBuffer commit];
+            [commandBuffer waitUntilCompleted];
+        }
+        gaussianBuffer = buffer;
+        return true;
+    }
+
+    // Apply an affine edit to the GPU copy in one dispatch. Only when that
+    // copy is current and uncompressed; otherwise the caller edits the CPU copy.
+    bool transformOnGPU(const simd_float4x4& matrix, const oflike::quatf& rotation, const oflike::float3& scale) {
+        if (compressed || bufferDirty || gpuCount == 0 || gpuCount != storedCount() ||
+            loading.load(std::memory_order_acquire) || !createTransformPipeline()) {
+            return false;
+        }
+
+        @autoreleasepool {
+            CloudTransform transform;
+            transform.matrix = matrix;
+            transform.rotation = rotation.vector;
+            transform.scale = scale;
+            transform.count = static_cast<uint32_t>(gpuCount);
+
+            id<MTLCommandBuffer> commandBuffer = [uploadQueue commandBuffer];
+            if (!commandBuffer) {
+                return false;
+            }
+            commandBuffer.label = @"Gaussian Cloud Transform";
+            id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoder];
+            [encoder setComputePipelineState:transformPipeline];
+            [encoder setBuffer:gaussianBuffer offset:0 atIndex:0];
+            [encoder setBytes:&transform length:sizeof(transform) atIndex:1];
+            const NSUInteger width = transformPipeline.threadExecutionWidth;
+            [encoder dispatchThreadgroups:MTLSizeMake((gpuCount + width - 1) / width, 1, 1)
+                    threadsPerThreadgroup:MTLSizeMake(width, 1, 1)];
+            [encoder endEncoding];
+            [commandBuffer commit];
+            [commandBuffer waitUntilCompleted];
+        }
+
+        // Carry the cached box through the edit instead of reading back
+        // (exact for translations, conservative for rotations)
+        updateBoundsIfNeeded();
+        const simd_float3x3 linear = simd_matrix(matrix.columns[0].xyz, matrix.columns[1].xyz, matrix.columns[2].xyz);
+        const simd_float3x3 absolute = simd_matrix(simd_abs(linear.columns[0]), simd_abs(linear.columns[1]),
+                                                   simd_abs(linear.columns[2]));
+        const oflike::float3 center = simd_mul(matrix, simd_make_float4((boundsMin + boundsMax) * 0.5f, 1.0f)).xyz;
+        const oflike::float3 extent = simd_mul(absolute, (boundsMax - boundsMin) * 0.5f);
+        boundsMin = center - extent;
+        boundsMax = center + extent;
+
+        clearLODImpl();
+        cpuStale = true;
+        bufferGeneration++;
+        return true;
+    }
+
+    // Size the GPU copy for count Gaussians written by the caller's GPU
+    // work; the CPU copy is dropped until syncCPU() reads them back
+    id<MTLBuffer> resizeOnGPUImpl(size_t count) {
+        waitForLoad();
+        if (!device || compressed || !reservePrivateBuffer(count)) {
+            return nil;
+        }
+        std::vector<Gaussian>().swap(gaussians);
+        gpuCount = count;
+        cpuStale = count > 0;
+        clearDirty();
+        clearLODImpl();
+        boundsDirty = true;
+        bufferGeneration++;
+        return gaussianBuffer;
+    }
+
+    bool createTransformPipeline() {
+        if (transformPipeline || transformPipelineFailed) {
+            return transformPipeline != nil;
+        }
+        @autoreleasepool {
+            NSError* error = nil;
+            id<MTLLibrary> library = [device newDefaultLibrary];
+            id<MTLFunction> function = [library newFunctionWithName:@"gaussianCloudTransform"];
+            if (function) {
+                transformPipeline = [device newComputePipelineStateWithFunction:function error:&error];
+            }
+            if (!transformPipeline) {
+                NSLog(@"[ofxSharp] Warning: GPU transform kernel not found, transforming on the CPU");
+                transformPipelineFailed = true;
+            }
+        }
+        return transformPipeline != nil;
+    }
+
+    // Filter the GPU copy when it is current, else the CPU copy
+    void filter(CloudFilter filter) {
+        if (!filterOnGPU(filter)) {
+            filterOnCPU(filter);
+        }
+    }
+
+    // Stable compaction of the GPU copy: survivors per block, a scan of
+    // the block counts, then a scatter into a buffer of exactly the
+    // survivors. Same conditions as transformOnGPU().
+    bool filterOnGPU(CloudFilter filter) {
+        if (compressed || bufferDirty || gpuCount == 0 || gpuCount != storedCount() ||
+            gpuCount >= UINT32_MAX || loading.load(std::memory_order_acquire) || !createFilterPipelines()) {
+            return false;
+        }
+
+        @autoreleasepool {
+            filter.count = static_cast<uint32_t>(gpuCount);
+            const uint32_t blocks = static_cast<uint32_t>((gpuCount + kFilterThreads - 1) / kFilterThreads);
+            const uint32_t scanLength = blocks + 1;     // The extra entry ends up holding the total
+            id<MTLBuffer> offsets = render::metal::makeTrackedBuffer(device, scanLength * sizeof(uint32_t),
+                                                                     MTLResourceStorageModeShared,
+                                                                     oflike::ofGpuMemoryCategory::Staging,
+                                                                     "Gaussian Cloud Filter Offsets");
+            id<MTLCommandBuffer> commandBuffer = [uploadQueue commandBuffer];
+            if (!offsets || !commandBuffer) {
+                return false;
+            }
+            static_cast<uint32_t*>(offsets.contents)[blocks] = 0;
+
+            commandBuffer.label = @"Gaussian Cloud Filter Count";
+            id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoder];
+            [encoder setComputePipelineState:filterCountPipeline];
+            [encoder setBuffer:gaussianBuffer offset:0 atIndex:0];
+            [encoder setBuffer:offsets offset:0 atIndex:1];
+            [encoder setBytes:&filter length:sizeof(filter) atIndex:2];
+            [encoder dispatchThreadgroups:MTLSizeMake(blocks, 1, 1) threadsPerThreadgroup:MTLSizeMake(kFilterThreads, 1, 1)];
+
+            const NSUInteger width = filterScanPipeline.threadExecutionWidth;
+            const NSUInteger scanLimit = std::min<NSUInteger>(1024, filterScanPipeline.maxTotalThreadsPerThreadgroup);
+            const NSUInteger scanThreads = std::max(width, scanLimit / width * width);
+            [encoder setComputePipelineState:filterScanPipeline];
+            [encoder setBuffer:offsets offset:0 atIndex:0];
+            [encoder setBytes:&scanLength length:sizeof(scanLength) atIndex:1];
+            [encoder dispatchThreadgroups:MTLSizeMake(1, 1, 1) threadsPerThreadgroup:MTLSizeMake(scanThreads, 1, 1)];
+            [encoder endEncoding];
+            [commandBuffer commit];
+            [commandBuffer waitUntilCompleted];
+
+            // Sized only now that the survivors are counted; nothing to do
+            // if every Gaussian passed (a slider that hasn't moved far)
+            const size_t kept = static_cast<const uint32_t*>(offsets.contents)[blocks];
+            if (kept == gpuCount) {
+                return true;
+            }
+            if (kept > 0) {
+                id<MTLBuffer> buffer = render::metal::makeTrackedBuffer(device, kept * sizeof(Gaussian),
+                                                                        MTLResourceStorageModePrivate,
+                                                                        oflike::ofGpuMemoryCategory::Splats,
+                                                                        "Gaussian Cloud");
+                commandBuffer = [uploadQueue commandBuffer];
+                if (!buffer || !commandBuffer) {
                     NSLog(@"[ofxSharp] Error: Failed to create Metal buffer");
                     return false;
                 }
+                commandBuffer.label = @"Gaussian Cloud Filter Scatter";
+                encoder = [commandBuffer computeCommandEncoder];
+                [encoder setComputePipelineState:filterScatterPipeline];
+                [encoder setBuffer:gaussianBuffer offset:0 atIndex:0];
+                [encoder setBuffer:buffer offset:0 atIndex:1];
+                [encoder setBuffer:offsets offset:0 atIndex:2];
+                [encoder setBytes:&filter length:sizeof(filter) atIndex:3];
+                [encoder dispatchThreadgroups:MTLSizeMake(blocks, 1, 1) threadsPerThreadgroup:MTLSizeMake(kFilterThreads, 1, 1)];
+                [encoder endEncoding];
+                [commandBuffer commit];
+                [commandBuffer waitUntilCompleted];
+                gaussianBuffer = buffer;
             }
 
-            // Copy data to buffer
-            memcpy(gaussianBuffer.contents, gaussians.data(), bufferSize);
+            // The CPU copy is read back (at the new size) when next needed
+            std::vector<Gaussian>().swap(gaussians);
+            gpuCount = kept;
+            cpuStale = kept > 0;
+        }
+        clearLODImpl();
+        boundsDirty = true;
+        bufferGeneration++;
+        return true;
+    }
+
+    // Stable compaction of the CPU copy. Chunks are compacted toward
+    // their own starts in parallel, then slid together in one pass, and
+    // only the Gaussians from the first removed one on are re-uploaded.
+    void filterOnCPU(const CloudFilter& filter) {
+        syncCPU();
+        const size_t count = gaussians.size();
+        if (count == 0) {
+            return;
+        }
+        const size_t chunkCount = (count + kFilterChunkSize - 1) / kFilterChunkSize;
+        std::vector<size_t> keptCounts(chunkCount);
+        std::vector<size_t> firstRemoved(chunkCount);
+        size_t* kept = keptCounts.data();
+        size_t* first = firstRemoved.data();
+        Gaussian* data = gaussians.data();
+        const CloudFilter* test = &filter;
+
+        dispatch_apply(chunkCount, DISPATCH_APPLY_AUTO, ^(size_t chunk) {
+            const size_t begin = chunk * kFilterChunkSize;
+            const size_t end = std::min(begin + kFilterChunkSize, count);
+            size_t write = begin;
+            first[chunk] = end;
+            for (size_t i = begin; i < end; ++i) {
+                if (!filterKeeps(data[i], *test)) {
+                    first[chunk] = std::min(first[chunk], i);
+                } else {
+                    if (write != i) {
+                        data[write] = data[i];
+                    }
+                    ++write;
+                }
+            }
+            kept[chunk] = write - begin;
+        });
+
+        // Chunk c's survivors land at the sum of the counts before it,
+        // never past their current start, so moving in order is safe
+        size_t total = 0;
+        size_t firstChanged = count;
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            const size_t begin = chunk * kFilterChunkSize;
+            if (total != begin && kept[chunk] > 0) {
+                std::memmove(data + total, data + begin, kept[chunk] * sizeof(Gaussian));
+            }
+            total += kept[chunk];
+            firstChanged = std::min(firstChanged, first[chunk]);
+        }
+        if (total == count) {
+            return;
+        }
+        gaussians.erase(gaussians.begin() + total, gaussians.end());
+        boundsDirty = true;
+        markRangeDirty(firstChanged, SIZE_MAX);
+    }
 
-            bufferDirty = false;
-            return true;
+    bool createFilterPipelines() {
+        if (filterScatterPipeline || filterPipelinesFailed) {
+            return filterScatterPipeline != nil;
+        }
+        @autoreleasepool {
+            id<MTLLibrary> library = [device newDefaultLibrary];
+            auto pipeline = [&](NSString* name) -> id<MTLComputePipelineState> {
+                NSError* error = nil;
+                id<MTLFunction> function = [library newFunctionWithName:name];
+                return function ? [device newComputePipelineStateWithFunction:function error:&error] : nil;
+            };
+            filterCountPipeline = pipeline(@"gaussianCloudFilterCount");
+            filterScanPipeline = pipeline(@"gaussianRadixScan");
+            filterScatterPipeline = pipeline(@"gaussianCloudFilterScatter");
+            if (!filterCountPipeline || !filterScanPipeline || !filterScatterPipeline ||
+                filterCountPipeline.maxTotalThreadsPerThreadgroup < kFilterThreads ||
+                filterScatterPipeline.maxTotalThreadsPerThreadgroup < kFilterThreads) {
+                NSLog(@"[ofxSharp] Warning: GPU filter kernels not found, filtering on the CPU");
+                filterCountPipeline = nil;
+                filterScanPipeline = nil;
+                filterScatterPipeline = nil;
+                filterPipelinesFailed = true;
+            }
         }
+        return filterScatterPipeline != nil;
     }
 
-    bool loadPLYImpl(const std::string& filepath) {
-        // Simple PLY loader for Gaussian Splatting format
-        // Expected PLY format:
-        // - Header with element count
-        // - Binary data with: x, y, z, scale_x, scale_y, scale_z, rot_0, rot_1, rot_2, rot_3, opacity, sh_dc_r, sh_dc_g, sh_dc_b, ...
+    // Copy [begin, end) into the private buffer; uploads run in order on
+    // one queue and are not waited for
+    id<MTLCommandBuffer> uploadRange(size_t begin, size_t end) {
+        @autoreleasepool {
+            const size_t bytes = (end - begin) * sizeof(Gaussian);
+            id<MTLBuffer> staging = render::metal::makeTrackedBuffer(device, gaussians.data() + begin, bytes,
+                                                                     MTLResourceStorageModeShared,
+                                                                     oflike::ofGpuMemoryCategory::Staging,
+                                                                     "Gaussian Cloud Upload");
+            id<MTLCommandBuffer> commandBuffer = [uploadQueue commandBuffer];
+            if (!staging || !commandBuffer) {
+                return nil;
+            }
+            commandBuffer.label = @"Gaussian Cloud Upload";
+            id<MTLBlitCommandEncoder> blit = [commandBuffer blitCommandEncoder];
+            [blit copyFromBuffer:staging
+                    sourceOffset:0
+                        toBuffer:gaussianBuffer
+               destinationOffset:begin * sizeof(Gaussian)
+                            size:bytes];
+            [blit endEncoding];
+            [commandBuffer commit];
+            return commandBuffer;
+        }
+    }
 
-        std::ifstream file(filepath, std::ios::binary);
-        if (!file.is_open()) {
+    // Morton order keeps each chunk's position bounds tight
+    // Returns the sorted Morton codes
+    std::vector<uint32_t> sortSpatially() {
+        oflike::float3 minBounds = gaussians[0].position;
+        oflike::float3 maxBounds = gaussians[0].position;
+        for (const auto& g : gaussians) {
+            minBounds = simd_min(minBounds, g.position);
+            maxBounds = simd_max(maxBounds, g.position);
+        }
+        const oflike::float3 extent = maxBounds - minBounds;
+
+        std::vector<std::pair<uint32_t, uint32_t>> order(gaussians.size());
+        for (size_t i = 0; i < gaussians.size(); ++i) {
+            order[i] = {mortonCode(gaussians[i].position, minBounds, extent), static_cast<uint32_t>(i)};
+        }
+        std::sort(order.begin(), order.end());
+
+        std::vector<Gaussian> sorted;
+        std::vector<uint32_t> codes;
+        sorted.reserve(gaussians.size());
+        codes.reserve(gaussians.size());
+        for (const auto& entry : order) {
+            sorted.push_back(gaussians[entry.second]);
+            codes.push_back(entry.first);
+        }
+        gaussians.swap(sorted);
+        return codes;
+    }
+
+    void clearLODImpl() {
+        lodNodes.clear();
+        lodGaussians.clear();
+    }
+
+    // Morton order makes every octree node a contiguous range of the
+    // Gaussians, split by successive 3-bit digits of the codes
+    bool buildLODImpl(size_t leafSize) {
+        syncCPU();
+        if (gaussians.empty() || leafSize == 0) {
             return false;
         }
+        const std::vector<uint32_t> codes = sortSpatially();
+        markDirty();
 
-        // Parse PLY header
-        std::string line;
-        size_t vertexCount = 0;
-        bool isBinary = false;
+        oflike::float3 minBounds = gaussians[0].position;
+        oflike::float3 maxBounds = gaussians[0].position;
+        for (const auto& g : gaussians) {
+            minBounds = simd_min(minBounds, g.position);
+            maxBounds = simd_max(maxBounds, g.position);
+        }
+        buildLODNode(codes, 0, gaussians.size(), 0, minBounds, maxBounds, leafSize);
+        lodGeneration++;
+        return true;
+    }
+
+    int32_t buildLODNode(const std::vector<uint32_t>& codes, size_t begin, size_t end, int depth,
+                         const oflike::float3& cellMin, const oflike::float3& cellMax, size_t leafSize) {
+        const int32_t index = static_cast<int32_t>(lodNodes.size());
+        lodNodes.emplace_back();
+
+        LODNode node;
+        node.boundsMin = oflike::float3{INFINITY, INFINITY, INFINITY};
+        node.boundsMax = oflike::float3{-INFINITY, -INFINITY, -INFINITY};
+        for (size_t i = begin; i < end; ++i) {
+            const float radius = gaussians[i].getRadius();
+            node.boundsMin = simd_min(node.boundsMin, gaussians[i].position - radius);
+            node.boundsMax = simd_max(node.boundsMax, gaussians[i].position + radius);
+        }
+        if (end - begin <= leafSize || depth == kLODMaxDepth) {
+            node.first = static_cast<uint32_t>(begin);
+            node.count = static_cast<uint32_t>(end - begin);
+            lodNodes[index] = node;
+            return index;
+        }
+
+        node.leaf = false;
+        const int shift = 3 * (kLODMaxDepth - 1 - depth);
+        const oflike::float3 center = (cellMin + cellMax) * 0.5f;
+        float childError = 0.0f;
+        for (size_t childBegin = begin; childBegin < end;) {
+            const uint32_t octant = (codes[childBegin] >> shift) & 7;
+            size_t childEnd = childBegin;
+            while (childEnd < end && ((codes[childEnd] >> shift) & 7) == octant) {
+                ++childEnd;
+            }
+            oflike::float3 childMin = cellMin;
+            oflike::float3 childMax = center;
+            for (int axis = 0; axis < 3; ++axis) {
+                if ((octant >> axis) & 1) {
+                    childMin[axis] = center[axis];
+                    childMax[axis] = cellMax[axis];
+                }
+            }
+            const int32_t child = buildLODNode(codes, childBegin, childEnd, depth + 1, childMin, childMax, leafSize);
+            node.children[octant] = child;
+            childError = std::max(childError, lodNodes[child].error);
+            childBegin = childEnd;
+        }
+
+        // Merge what the children draw
+        std::vector<const Gaussian*> sources;
+        for (int32_t child : node.children) {
+            if (child < 0) {
+                continue;
+            }
+            const LODNode& c = lodNodes[child];
+            const Gaussian* base = c.leaf ? gaussians.data() : lodGaussians.data();
+            for (uint32_t i = 0; i < c.count; ++i) {
+                sources.push_back(base + c.first + i);
+            }
+        }
+        const std::vector<Gaussian> merged = mergeCells(sources, cellMin, cellMax);
+        node.first = static_cast<uint32_t>(lodGaussians.size());
+        node.count = static_cast<uint32_t>(merged.size());
+        lodGaussians.insert(lodGaussians.end(), merged.begin(), merged.end());
+
+        const oflike::float3 cellSize = (cellMax - cellMin) / float(kLODGrid);
+        node.error = std::max({cellSize.x, cellSize.y, cellSize.z, childError});
+        lodNodes[index] = node;
+        return index;
+    }
 
-        while (std::getline(file, line)) {
-            if (line.find("element vertex") != std::string::npos) {
-                std::istringstream iss(line);
-                std::string dummy1, dummy2;
-                iss >> dummy1 >> dummy2 >> vertexCount;
-            } else if (line.find("format binary") != std::string::npos) {
-                isBinary = true;
-            } else if (line == "end_header") {
+    // k-means over the higher-order SH of a strided sample; a single zero
+    // entry when the cloud has no view-dependent color
+    std::vector<float> trainSHCodebook() {
+        bool hasSH = false;
+        for (const auto& g : gaussians) {
+            for (const auto& c : g.sh_rest) {
+                hasSH = hasSH || c.x != 0.0f || c.y != 0.0f || c.z != 0.0f;
+            }
+            if (hasSH) {
                 break;
             }
         }
+        if (!hasSH) {
+            return std::vector<float>(kSHValues, 0.0f);
+        }
 
-        if (vertexCount == 0 || !isBinary) {
-            // For now, only support binary PLY
-            return false;
+        const size_t stride = std::max<size_t>(1, gaussians.size() / kCodebookSamples);
+        const size_t sampleCount = gaussians.size() / stride;
+        std::vector<float> samples(sampleCount * kSHValues);
+        for (size_t i = 0; i < sampleCount; ++i) {
+            copySH(gaussians[i * stride], samples.data() + i * kSHValues);
         }
 
-        // Reserve space
-        gaussians.clear();
-        gaussians.reserve(vertexCount);
+        const size_t k = std::min<size_t>(std::clamp(shCodebookSize, 1, 65536), sampleCount);
+        std::vector<float> codebook(k * kSHValues);
+        for (size_t j = 0; j < k; ++j) {
+            const float* seed = samples.data() + (j * sampleCount / k) * kSHValues;
+            std::copy(seed, seed + kSHValues, codebook.data() + j * kSHValues);
+        }
 
-        // Read binary data
-        // Note: This is a simplified version. Real implementation should parse
-        // property list from header and read accordingly.
-        for (size_t i = 0; i < vertexCount; ++i) {
-            Gaussian g;
+        constexpr size_t kBatch = 1024;
+        std::vector<float> norms(k);
+        std::vector<float> dots;
+        std::vector<uint16_t> labels(sampleCount);
+        std::vector<float> sums(k * kSHValues);
+        std::vector<uint32_t> counts(k);
+        for (int iteration = 0; iteration < kCodebookIterations; ++iteration) {
+            codebookNorms(codebook, norms);
+            for (size_t start = 0; start < sampleCount; start += kBatch) {
+                const size_t rows = std::min(kBatch, sampleCount - start);
+                nearestEntries(samples.data() + start * kSHValues, rows, codebook, norms, dots,
+                               labels.data() + start);
+            }
 
-            // Read position (3 floats)
-            file.read(reinterpret_cast<char*>(&g.position.x), sizeof(float));
-            file.read(reinterpret_cast<char*>(&g.position.y), sizeof(float));
-            file.read(reinterpret_cast<char*>(&g.position.z), sizeof(float));
+            std::fill(sums.begin(), sums.end(), 0.0f);
+            std::fill(counts.begin(), counts.end(), 0);
+            for (size_t i = 0; i < sampleCount; ++i) {
+                float* sum = sums.data() + labels[i] * kSHValues;
+                const float* sample = samples.data() + i * kSHValues;
+                for (int v = 0; v < kSHValues; ++v) {
+                    sum[v] += sample[v];
+                }
+                counts[labels[i]]++;
+            }
+            for (size_t j = 0; j < k; ++j) {
+                float* entry = codebook.data() + j * kSHValues;
+                if (counts[j] == 0) {
+                    // Empty entry: restart it on some sample
+                    const float* seed = samples.data() + ((j * 7919 + iteration) % sampleCount) * kSHValues;
+                    std::copy(seed, seed + kSHValues, entry);
+                    continue;
+                }
+                const float inverse = 1.0f / counts[j];
+                for (int v = 0; v < kSHValues; ++v) {
+                    entry[v] = sums[j * kSHValues + v] * inverse;
+                }
+            }
+        }
+        return codebook;
+    }
+
+    bool updateCompressedBufferImpl() {
+        @autoreleasepool {
+            clearLODImpl();     // Leaf ranges don't survive the reorder
+            sortSpatially();
+            const std::vector<float> codebook = trainSHCodebook();
+            const size_t entries = codebook.size() / kSHValues;
+
+            const size_t count = gaussians.size();
+            const size_t chunkCount = (count + kCompressedChunkSize - 1) / kCompressedChunkSize;
+            auto align = [](size_t offset) { return (offset + 255) & ~size_t(255); };
+            CompressedBufferLayout layout;
+            layout.splatOffset = 0;
+            layout.chunkOffset = align(count * sizeof(CompressedGaussian));
+            layout.codebookOffset = align(layout.chunkOffset + chunkCount * sizeof(CompressedChunk));
+            layout.codebookSize = entries;
+            const size_t bufferSize = layout.codebookOffset + entries * kSHCodebookStride * sizeof(uint16_t);
+
+            if (!gaussianBuffer || gaussianBuffer.length != bufferSize ||
+                gaussianBuffer.storageMode != MTLStorageModeShared) {
+                gaussianBuffer = render::metal::makeTrackedBuffer(device, bufferSize, MTLResourceStorageModeShared,
+                                                                  oflike::ofGpuMemoryCategory::Splats, "Gaussian Cloud Compressed");
+                if (!gaussianBuffer) {
+                    NSLog(@"[ofxSharp] Error: Failed to create Metal buffer");
+                    return false;
+                }
+            }
+            uint8_t* bytes = static_cast<uint8_t*>(gaussianBuffer.contents);
+            auto* splats = reinterpret_cast<CompressedGaussian*>(bytes + layout.splatOffset);
+            auto* chunks = reinterpret_cast<CompressedChunk*>(bytes + layout.chunkOffset);
+            auto* shEntries = reinterpret_cast<uint16_t*>(bytes + layout.codebookOffset);
+
+            std::memset(shEntries, 0, entries * kSHCodebookStride * sizeof(uint16_t));
+            for (size_t j = 0; j < entries; ++j) {
+                for (int v = 0; v < kSHValues; ++v) {
+                    shEntries[j * kSHCodebookStride + v] = toHalf(codebook[j * kSHValues + v]);
+                }
+            }
 
-            // Read scale (3 floats)
-            file.read(reinterpret_cast<char*>(&g.scale.x), sizeof(float));
-            file.read(reinterpret_cast<char*>(&g.scale.y), sizeof(float));
-            file.read(reinterpret_cast<char*>(&g.scale.z), sizeof(float));
+            // Every Gaussian takes its nearest SH entry, a batch at a time
+            constexpr size_t kBatch = 1024;
+            std::vector<float> norms(entries);
+            codebookNorms(codebook, norms);
+            std::vector<float> rows(kBatch * kSHValues);
+            std::vector<float> dots;
+            std::vector<uint16_t> labels(kBatch);
+
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                const size_t begin = chunk * kCompressedChunkSize;
+                const size_t end = std::min(begin + kCompressedChunkSize, count);
+                oflike::float3 minBounds = gaussians[begin].position;
+                oflike::float3 maxBounds = gaussians[begin].position;
+                for (size_t i = begin; i < end; ++i) {
+                    minBounds = simd_min(minBounds, gaussians[i].position);
+                    maxBounds = simd_max(maxBounds, gaussians[i].position);
+                }
+                const oflike::float3 extent = maxBounds - minBounds;
+                chunks[chunk].positionMin = minBounds;
+                chunks[chunk].positionExtent = extent;
+
+                for (size_t i = begin; i < end; ++i) {
+                    const Gaussian& g = gaussians[i];
+                    CompressedGaussian& c = splats[i];
+                    for (int axis = 0; axis < 3; ++axis) {
+                        c.position[axis] = toUnorm16(g.position[axis], minBounds[axis], extent[axis]);
+                        c.scale[axis] = toHalf(g.scale[axis]);
+                        c.color[axis] = toHalf(g.sh_dc[axis]);
+                    }
+                    c.opacity = static_cast<uint8_t>(std::lround(std::clamp(g.opacity, 0.0f, 1.0f) * 255.0f));
+                    c.padding = 0;
+                    c.rotation = packRotation(g.rotation);
+                    c.shIndex = 0;
+                    c.padding2 = 0;
+                }
+            }
 
-            // Read rotation (4 floats - quaternion)
-            float qx, qy, qz, qw;
-            file.read(reinterpret_cast<char*>(&qx), sizeof(float));
-            file.read(reinterpret_cast<char*>(&qy), sizeof(float));
-            file.read(reinterpret_cast<char*>(&qz), sizeof(float));
-            file.read(reinterpret_cast<char*>(&qw), sizeof(float));
-            g.rotation = simd_quaternion(qx, qy, qz, qw);
+            if (entries > 1) {
+                for (size_t start = 0; start < count; start += kBatch) {
+                    const size_t batch = std::min(kBatch, count - start);
+                    for (size_t r = 0; r < batch; ++r) {
+                        copySH(gaussians[start + r], rows.data() + r * kSHValues);
+                    }
+                    nearestEntries(rows.data(), batch, codebook, norms, dots, labels.data());
+                    for (size_t r = 0; r < batch; ++r) {
+                        splats[start + r].shIndex = labels[r];
+                    }
+                }
+            }
 
-            // Read opacity (1 float)
-            file.read(reinterpret_cast<char*>(&g.opacity), sizeof(float));
+            compressedLayout = layout;
+            bufferDirty = false;
+            return true;
+        }
+    }
 
-            // Read sh_dc (3 floats - RGB)
-            file.read(reinterpret_cast<char*>(&g.sh_dc.x), sizeof(float));
-            file.read(reinterpret_cast<char*>(&g.sh_dc.y), sizeof(float));
-            file.read(reinterpret_cast<char*>(&g.sh_dc.z), sizeof(float));
+    // Map the file, read its layout once and convert records in parallel
+    // chunks; with async the conversion runs on a background queue and
+    // finished chunks show up through visibleCount()
+    bool loadFileImpl(const std::string& filepath, bool async) {
+        waitForLoad();
 
-            // Read sh_rest (15 * 3 floats)
-            // Simplified: skip for now or read zeros
-            // In a real implementation, parse all SH coefficients
+        auto file = std::make_shared<MappedFile>();
+        if (!file->open(filepath)) {
+            return false;
+        }
 
-            gaussians.push_back(g);
+        auto layout = std::make_shared<RecordLayout>();
+        if (hasExtension(filepath, ".splat")) {
+            layout->format = RecordLayout::Format::Splat;
+            layout->stride = 32;
+            layout->count = file->size / layout->stride;
+        } else if (!parsePLYHeader(*file, *layout)) {
+            return false;
+        }
+        if (layout->count == 0) {
+            return false;
         }
 
+        gaussians.assign(layout->count, Gaussian());
+        gpuCount = 0;
+        cpuStale = false;
+        loadedCount = 0;
+        cancelLoad = false;
         markDirty();
+        const bool upload = device && !compressed && reservePrivateBuffer(layout->count);
+
+        if (!async) {
+            convertRecords(*file, *layout, upload);
+            return true;
+        }
+        loading.store(true, std::memory_order_release);
+        dispatch_group_async(loadGroup, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            convertRecords(*file, *layout, upload);
+            loading.store(false, std::memory_order_release);
+        });
         return true;
     }
 
+    void convertRecords(const MappedFile& file, const RecordLayout& layout, bool upload) {
+        struct Progress {
+            std::mutex mutex;
+            std::vector<uint8_t> done;
+            size_t published = 0;       // Chunks complete from the start
+            id<MTLCommandBuffer> lastUpload = nil;
+        };
+        const size_t chunkCount = (layout.count + kLoadChunkSize - 1) / kLoadChunkSize;
+        Progress progress;
+        progress.done.assign(chunkCount, 0);
+        Progress* state = &progress;
+        const MappedFile* source = &file;
+        const RecordLayout* records = &layout;
+
+        dispatch_apply(chunkCount, DISPATCH_APPLY_AUTO, ^(size_t chunk) {
+            if (cancelLoad.load(std::memory_order_relaxed)) {
+                return;
+            }
+            const size_t begin = chunk * kLoadChunkSize;
+            const size_t end = std::min(begin + kLoadChunkSize, records->count);
+            const uint8_t* data = source->data + records->dataOffset;
+            for (size_t i = begin; i < end; ++i) {
+                convertRecord(*records, data + i * records->stride, gaussians[i]);
+            }
+
+            // Publish the prefix that is now complete
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->done[chunk] = 1;
+            const size_t previous = std::min(state->published * kLoadChunkSize, records->count);
+            while (state->published < chunkCount && state->done[state->published]) {
+                state->published++;
+            }
+            const size_t complete = std::min(state->published * kLoadChunkSize, records->count);
+            if (complete > previous) {
+                if (upload) {
+                    state->lastUpload = uploadRange(previous, complete);
+                }
+                loadedCount.store(complete, std::memory_order_release);
+            }
+        });
+
+        if (progress.lastUpload) {
+            [progress.lastUpload waitUntilCompleted];
+        }
+        if (upload && !cancelLoad.load(std::memory_order_relaxed) && progress.published == chunkCount) {
+            gpuCount = layout.count;
+            bufferGeneration++;
+            clearDirty();
+        }
+    }
+
     bool savePLYImpl(const std::string& filepath) const {
         // Simple PLY saver for Gaussian Splatting format
 
@@ -258,42 +1547,57 @@ GaussianCloud& GaussianCloud::operator=(GaussianCloud&& other) noexcept = defaul
 // ============================================================================
 
 void GaussianCloud::addGaussian(const Gaussian& gaussian) {
+    impl_->syncCPU();
     impl_->gaussians.push_back(gaussian);
-    impl_->markDirty();
+    impl_->boundsDirty = true;
+    impl_->markRangeDirty(impl_->gaussians.size() - 1, impl_->gaussians.size());
 }
 
 void GaussianCloud::addGaussians(const std::vector<Gaussian>& gaussians) {
+    impl_->syncCPU();
+    const size_t first = impl_->gaussians.size();
     impl_->gaussians.insert(impl_->gaussians.end(), gaussians.begin(), gaussians.end());
-    impl_->markDirty();
+    impl_->boundsDirty = true;
+    impl_->markRangeDirty(first, impl_->gaussians.size());
 }
 
 void GaussianCloud::reserve(size_t count) {
+    impl_->waitForLoad();
     impl_->gaussians.reserve(count);
 }
 
 void GaussianCloud::clear() {
+    impl_->waitForLoad();
     impl_->gaussians.clear();
+    impl_->cpuStale = false;
     impl_->markDirty();
 }
 
 size_t GaussianCloud::size() const {
-    return impl_->gaussians.size();
+    return impl_->visibleCount();
 }
 
 bool GaussianCloud::empty() const {
-    return impl_->gaussians.empty();
+    return impl_->visibleCount() == 0;
 }
 
 const Gaussian& GaussianCloud::getGaussian(size_t index) const {
+    if (impl_->cpuStale) {
+        impl_->syncCPU();
+    }
     return impl_->gaussians.at(index);
 }
 
 Gaussian& GaussianCloud::getGaussian(size_t index) {
-    impl_->bufferDirty = true;
+    impl_->syncCPU();
+    impl_->markRangeDirty(index, index + 1);
     return impl_->gaussians.at(index);
 }
 
 const std::vector<Gaussian>& GaussianCloud::getGaussians() const {
+    if (impl_->cpuStale) {
+        impl_->syncCPU();
+    }
     return impl_->gaussians;
 }
 
@@ -302,6 +1606,13 @@ const std::vector<Gaussian>& GaussianCloud::getGaussians() const {
 // ============================================================================
 
 void GaussianCloud::translate(const oflike::float3& offset) {
+    impl_->waitForLoad();
+    simd_float4x4 matrix = matrix_identity_float4x4;
+    matrix.columns[3] = simd_make_float4(offset, 1.0f);
+    if (impl_->transformOnGPU(matrix, simd_quaternion(0.0f, 0.0f, 0.0f, 1.0f), oflike::float3{1.0f, 1.0f, 1.0f})) {
+        return;
+    }
+    impl_->syncCPU();
     for (auto& g : impl_->gaussians) {
         g.position += offset;
     }
@@ -314,6 +1625,14 @@ void GaussianCloud::rotate(const oflike::quatf& rotation) {
 }
 
 void GaussianCloud::rotateAround(const oflike::quatf& rotation, const oflike::float3& center) {
+    impl_->waitForLoad();
+    // p' = center + R (p - center)
+    simd_float4x4 matrix = simd_matrix4x4(rotation);
+    matrix.columns[3] = simd_make_float4(center - simd_act(rotation, center), 1.0f);
+    if (impl_->transformOnGPU(matrix, rotation, oflike::float3{1.0f, 1.0f, 1.0f})) {
+        return;
+    }
+    impl_->syncCPU();
     for (auto& g : impl_->gaussians) {
         // Rotate position around center
         oflike::float3 offset = g.position - center;
@@ -331,7 +1650,15 @@ void GaussianCloud::scale(float factor) {
 }
 
 void GaussianCloud::scale(const oflike::float3& factors) {
+    impl_->waitForLoad();
     oflike::float3 center = getCenter();
+    // p' = center + S (p - center)
+    simd_float4x4 matrix = simd_diagonal_matrix(simd_make_float4(factors, 1.0f));
+    matrix.columns[3] = simd_make_float4(center - center * factors, 1.0f);
+    if (impl_->transformOnGPU(matrix, simd_quaternion(0.0f, 0.0f, 0.0f, 1.0f), factors)) {
+        return;
+    }
+    impl_->syncCPU();
     for (auto& g : impl_->gaussians) {
         // Scale position relative to center
         oflike::float3 offset = g.position - center;
@@ -345,6 +1672,7 @@ void GaussianCloud::scale(const oflike::float3& factors) {
 }
 
 void GaussianCloud::transform(const oflike::ofMatrix4x4& matrix) {
+    impl_->waitForLoad();
     // Convert ofMatrix4x4 to simd_float4x4
     simd_float4x4 m = matrix.getMatrix();
 
@@ -367,6 +1695,10 @@ void GaussianCloud::transform(const oflike::ofMatrix4x4& matrix) {
     );
     oflike::quatf quat = simd_quaternion(rotation);
 
+    if (impl_->transformOnGPU(m, quat, scaleFactors)) {
+        return;
+    }
+    impl_->syncCPU();
     for (auto& g : impl_->gaussians) {
         // Transform position
         simd_float4 pos4 = simd_make_float4(g.position.x, g.position.y, g.position.z, 1.0f);
@@ -387,38 +1719,23 @@ void GaussianCloud::transform(const oflike::ofMatrix4x4& matrix) {
 // ============================================================================
 
 void GaussianCloud::filterByOpacity(float minOpacity) {
-    auto& gaussians = impl_->gaussians;
-    gaussians.erase(
-        std::remove_if(gaussians.begin(), gaussians.end(),
-                       [minOpacity](const Gaussian& g) { return g.opacity < minOpacity; }),
-        gaussians.end()
-    );
-    impl_->markDirty();
+    CloudFilter filter = passAllFilter();
+    filter.minOpacity = minOpacity;
+    impl_->filter(filter);
 }
 
 void GaussianCloud::filterBySize(float minSize, float maxSize) {
-    auto& gaussians = impl_->gaussians;
-    gaussians.erase(
-        std::remove_if(gaussians.begin(), gaussians.end(),
-                       [minSize, maxSize](const Gaussian& g) {
-                           float radius = g.getRadius();
-                           return radius < minSize || radius > maxSize;
-                       }),
-        gaussians.end()
-    );
-    impl_->markDirty();
+    CloudFilter filter = passAllFilter();
+    filter.minRadius = minSize;
+    filter.maxRadius = maxSize;
+    impl_->filter(filter);
 }
 
 void GaussianCloud::filterByBounds(const oflike::float3& minBounds, const oflike::float3& maxBounds) {
-    auto& gaussians = impl_->gaussians;
-    gaussians.erase(
-        std::remove_if(gaussians.begin(), gaussians.end(),
-                       [&minBounds, &maxBounds](const Gaussian& g) {
-                           return simd_any(g.position < minBounds) || simd_any(g.position > maxBounds);
-                       }),
-        gaussians.end()
-    );
-    impl_->markDirty();
+    CloudFilter filter = passAllFilter();
+    filter.minBounds = minBounds;
+    filter.maxBounds = maxBounds;
+    impl_->filter(filter);
 }
 
 void GaussianCloud::removeInvisible(float threshold) {
@@ -459,6 +1776,7 @@ void GaussianCloud::updateBounds() {
 // ============================================================================
 
 bool GaussianCloud::updateMetalBuffer() {
+    impl_->waitForLoad();
     return impl_->updateMetalBufferImpl();
 }
 
@@ -467,22 +1785,104 @@ void* GaussianCloud::getMetalBuffer() const {
 }
 
 size_t GaussianCloud::getBufferSize() const {
-    return impl_->gaussians.size() * sizeof(Gaussian);
+    if (impl_->compressed) {
+        return impl_->gaussianBuffer ? impl_->gaussianBuffer.length : 0;
+    }
+    return impl_->storedCount() * sizeof(Gaussian);
+}
+
+void* GaussianCloud::resizeOnGPU(size_t count) {
+    return (__bridge void*)impl_->resizeOnGPUImpl(count);
 }
 
 bool GaussianCloud::isBufferDirty() const {
     return impl_->bufferDirty;
 }
 
+uint64_t GaussianCloud::getBufferGeneration() const {
+    return impl_->bufferGeneration;
+}
+
+// ============================================================================
+// Compressed Storage
+// ============================================================================
+
+void GaussianCloud::setCompressed(bool compressed, int shCodebookSize) {
+    impl_->waitForLoad();
+    if (impl_->compressed != compressed || impl_->shCodebookSize != shCodebookSize) {
+        impl_->compressed = compressed;
+        impl_->shCodebookSize = shCodebookSize;
+        impl_->bufferDirty = true;
+    }
+}
+
+bool GaussianCloud::isCompressed() const {
+    return impl_->compressed;
+}
+
+CompressedBufferLayout GaussianCloud::getCompressedLayout() const {
+    return impl_->compressedLayout;
+}
+
+// ============================================================================
+// Level of Detail
+// ============================================================================
+
+bool GaussianCloud::buildLOD(size_t leafSize) {
+    return impl_->buildLODImpl(leafSize);
+}
+
+bool GaussianCloud::hasLOD() const {
+    return !impl_->lodNodes.empty();
+}
+
+void GaussianCloud::clearLOD() {
+    impl_->clearLODImpl();
+}
+
+const std::vector<LODNode>& GaussianCloud::getLODNodes() const {
+    return impl_->lodNodes;
+}
+
+const std::vector<Gaussian>& GaussianCloud::getLODGaussians() const {
+    return impl_->lodGaussians;
+}
+
+uint64_t GaussianCloud::getLODGeneration() const {
+    return impl_->lodGeneration;
+}
+
 // ============================================================================
 // Import / Export
 // ============================================================================
 
 bool GaussianCloud::loadFromPLY(const std::string& filepath) {
-    return impl_->loadPLYImpl(filepath);
+    return impl_->loadFileImpl(filepath, false);
+}
+
+bool GaussianCloud::loadFromFile(const std::string& filepath) {
+    return impl_->loadFileImpl(filepath, false);
+}
+
+bool GaussianCloud::loadAsync(const std::string& filepath) {
+    return impl_->loadFileImpl(filepath, true);
+}
+
+bool GaussianCloud::isLoading() const {
+    return impl_->loading.load(std::memory_order_acquire);
+}
+
+float GaussianCloud::getLoadProgress() const {
+    const size_t total = impl_->gaussians.size();
+    return total > 0 ? static_cast<float>(impl_->visibleCount()) / static_cast<float>(total) : 1.0f;
+}
+
+void GaussianCloud::waitUntilLoaded() {
+    impl_->waitForLoad();
 }
 
 bool GaussianCloud::saveToPLY(const std::string& filepath) const {
+    impl_->syncCPU();
     return impl_->savePLYImpl(filepath);
 }
 
@@ -497,6 +1897,7 @@ size_t GaussianCloud::getMemoryUsage() const {
 }
 
 float GaussianCloud::getAverageOpacity() const {
+    impl_->syncCPU();
     if (impl_->gaussians.empty()) {
         return 0.0f;
     }
@@ -506,6 +1907,7 @@ float GaussianCloud::getAverageOpacity() const {
 }
 
 float GaussianCloud::getAverageScale() const {
+    impl_->syncCPU();
     if (impl_->gaussians.empty()) {
         return 0.0f;
     }
@@ -514,4 +1916,24 @@ float GaussianCloud::getAverageScale() const {
     return sum / impl_->gaussians.size();
 }
 
+// ============================================================================
+// Asset Loading
+// ============================================================================
+
+void registerAssetLoader(oflike::ofAssetManager& assets) {
+    oflike::ofAssetLoader<GaussianCloud> clouds;
+    clouds.load = [](const std::string& path) -> std::shared_ptr<GaussianCloud> {
+        auto cloud = std::make_shared<GaussianCloud>();
+        return cloud->loadFromFile(path) ? cloud : nullptr;
+    };
+    clouds.upload = [](GaussianCloud& cloud) { cloud.updateMetalBuffer(); };
+    clouds.memory = [](const GaussianCloud& cloud) {
+        oflike::ofAssetMemory memory;
+        memory.cpuBytes = cloud.size() * sizeof(Gaussian);
+        memory.gpuBytes = cloud.size() * sizeof(Gaussian);
+        return memory;
+    };
+    assets.registerLoader("splat", std::move(clouds));
+}
+
 } // namespace Sharp
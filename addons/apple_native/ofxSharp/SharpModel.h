@@ -91,6 +91,7 @@ public:
     // ============================================================================
 
     // Load Core ML model from file path
+    // .mlmodel and .mlpackage models are compiled once and cached
     // Returns true if successful
     bool load(const std::string& modelPath);
 
@@ -98,6 +99,16 @@ public:
     // Returns true if successful
     bool load(const std::string& modelPath, const ModelConfig& config);
 
+    // Callback type for async loading; Success once the model is ready
+    using LoadCallback = std::function<void(ModelStatus status)>;
+
+    // Load in the background: compile, load and prewarm the model off the
+    // main thread, then install it and call back on the main thread.
+    // Destroying the model, or a load(), unload() or loadAsync() before
+    // the model is ready, drops this load without calling back.
+    void loadAsync(const std::string& modelPath, LoadCallback callback);
+    void loadAsync(const std::string& modelPath, const ModelConfig& config, LoadCallback callback);
+
     // Unload model and free resources
     void unload();
 
@@ -119,6 +130,22 @@ public:
     // Returns empty cloud on error (check getLastStatus())
     GaussianCloud predict(const oflike::ofTexture& texture);
 
+    // ============================================================================
+    // Inference (GPU)
+    // ============================================================================
+
+    // Generate Gaussians from image straight into cloud's Metal buffer:
+    // Core ML writes its outputs into Metal buffers and a compute kernel
+    // decodes them, so no per-Gaussian data passes through the CPU (it is
+    // read back only if cloud's Gaussians are accessed). Post-processing
+    // filters are skipped; the renderer's minOpacity culls faint Gaussians.
+    // Returns false on error (check getLastStatus())
+    bool predictInto(const oflike::ofPixels& image, GaussianCloud& cloud);
+
+    // Generate Gaussians from texture straight into cloud's Metal buffer
+    // Returns false on error (check getLastStatus())
+    bool predictInto(const oflike::ofTexture& texture, GaussianCloud& cloud);
+
     // ============================================================================
     // Inference (Asynchronous)
     // ============================================================================
@@ -146,15 +173,17 @@ public:
     // ============================================================================
 
     // Generate Gaussian clouds from multiple images (batch processing)
-    // Returns vector of clouds (empty cloud on error for that item)
+    // Inputs go to Core ML's batch API a window at a time (see
+    // getBatchParallelThreads), so large datasets keep few buffers alive
+    // Returns clouds in input order (empty cloud on error for that item)
     std::vector<GaussianCloud> predictBatch(const std::vector<oflike::ofPixels>& images);
 
     // Generate Gaussian clouds from multiple textures (batch processing)
-    // Returns vector of clouds (empty cloud on error for that item)
+    // Returns clouds in input order (empty cloud on error for that item)
     std::vector<GaussianCloud> predictBatch(const std::vector<oflike::ofTexture>& textures);
 
     // Callback type for batch async inference
-    // Parameters: vector of GaussianCloud results, vector of ModelStatus for each
+    // Parameters: GaussianCloud results and the ModelStatus of each, in input order
     using PredictBatchCallback = std::function<void(std::vector<GaussianCloud>&& clouds, std::vector<ModelStatus> statuses)>;
 
     // Generate Gaussian clouds asynchronously from multiple images (batch)
@@ -165,10 +194,10 @@ public:
     // Callback is called on background thread when all inferences complete
     void predictBatchAsync(const std::vector<oflike::ofTexture>& textures, PredictBatchCallback callback);
 
-    // Set whether to parallelize batch inference (default: true on multi-core)
+    // Set whether to batch inference (default: true); off runs one input at a time
     void setBatchParallelProcessing(bool enabled);
 
-    // Get number of parallel inference threads used for batch processing
+    // Get number of inputs per Core ML batch (at most 8)
     size_t getBatchParallelThreads() const;
 
     // ============================================================================
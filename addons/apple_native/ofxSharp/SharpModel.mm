@@ -1,19 +1,48 @@
 #import "SharpModel.h"
 #import "SharpGaussian.h"
 #import "ofPixels.h"
+#import "ofPixelConvert.h"
 #import "ofTexture.h"
+#import "ofxNeuralEngine/ModelCache.h"
+#import "ofProfiler.h"
 #import <CoreML/CoreML.h>
 #import <Metal/Metal.h>
+#import <CoreVideo/CoreVideo.h>
 #import <MetalKit/MetalKit.h>
 #import <Accelerate/Accelerate.h>
 #import <simd/simd.h>
 #import <dispatch/dispatch.h>
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <vector>
 #include <string>
 
 namespace Sharp {
 
+// ============================================================================
+// GPU Output Decoding (gaussianDecodeModel in GaussianSplatting.metal)
+// ============================================================================
+
+// Model outputs the kernel reads, in its buffer order
+static constexpr size_t kModelOutputCount = 6;
+static NSString* const kModelOutputNames[kModelOutputCount] = {
+    @"positions", @"scales", @"rotations", @"opacities", @"sh_dc", @"sh_rest"
+};
+static constexpr uint32_t kModelOutputComponents[kModelOutputCount] = {3, 3, 4, 1, 3, 45};
+
+struct ModelOutput {
+    uint32_t splatStride;
+    uint32_t componentStride;
+    uint32_t isHalf;
+    uint32_t present;
+};
+
+struct ModelDecodeParams {
+    ModelOutput outputs[kModelOutputCount];
+    uint32_t count;
+};
+
 // ============================================================================
 // Private Implementation
 // ============================================================================
@@ -57,57 +86,91 @@ public:
         @autoreleasepool {
             unload();
 
-            config_ = config;
-            modelInfo_.modelPath = modelPath;
-
-            // Convert path to NSURL
-            NSString* nsPath = [NSString stringWithUTF8String:modelPath.c_str()];
-            NSURL* modelURL = [NSURL fileURLWithPath:nsPath];
-
-            // Check if file exists
-            if (![[NSFileManager defaultManager] fileExistsAtPath:nsPath]) {
-                lastStatus_ = ModelStatus::ErrorInvalidModelFormat;
-                lastError_ = "Model file not found: " + modelPath;
+            // Load model (compiled through the model cache)
+            NSError* error = nil;
+            MLModel* loaded = loadModel(modelPath, config, &error);
+            if (!loaded) {
+                failLoad(modelPath, error);
                 return false;
             }
+            return installModel(loaded, modelPath, config);
+        }
+    }
 
-            // Create model configuration
-            MLModelConfiguration* mlConfig = [[MLModelConfiguration alloc] init];
+    void loadAsync(const std::string& modelPath, const ModelConfig& config, LoadCallback callback) {
+        @autoreleasepool {
+            unload();
 
-            // Set compute units based on config
-            switch (config.computeUnits) {
-                case ModelConfig::ComputeUnits::All:
-                    mlConfig.computeUnits = MLComputeUnitsAll;
-                    break;
-                case ModelConfig::ComputeUnits::CPUOnly:
-                    mlConfig.computeUnits = MLComputeUnitsCPUOnly;
-                    break;
-                case ModelConfig::ComputeUnits::CPUAndGPU:
-                    mlConfig.computeUnits = MLComputeUnitsCPUAndGPU;
-                    break;
-                case ModelConfig::ComputeUnits::CPUAndNeuralEngine:
-                    mlConfig.computeUnits = MLComputeUnitsCPUAndNeuralEngine;
-                    break;
-            }
+            // Copies for the block, which only runs while this load is
+            // current, so while this is alive
+            std::string path = modelPath;
+            ModelConfig cfg = config;
+
+            NeuralEngine::LoadModelAsync(modelURLForPath(modelPath), createConfiguration(config), loads_,
+                                         ^(MLModel* loaded, NSError* error) {
+                if (loaded) {
+                    installModel(loaded, path, cfg);
+                } else {
+                    failLoad(path, error);
+                }
+                if (callback) {
+                    callback(lastStatus_);
+                }
+            });
+        }
+    }
 
-            // Enable low power mode if requested
-            if (@available(macOS 13.0, *)) {
-                // Note: MLModelConfiguration doesn't have a direct lowPowerMode property
-                // This would need to be configured through MLPredictionOptions at inference time
-            }
+    // Blocking; safe on any thread. nil and error on failure
+    static MLModel* loadModel(const std::string& modelPath, const ModelConfig& config, NSError** error) {
+        return NeuralEngine::LoadCachedModel(modelURLForPath(modelPath), createConfiguration(config), error);
+    }
 
-            // Load model
-            NSError* error = nil;
-            model_ = [MLModel modelWithContentsOfURL:modelURL
-                                       configuration:mlConfig
-                                               error:&error];
+    static NSURL* modelURLForPath(const std::string& modelPath) {
+        return [NSURL fileURLWithPath:[NSString stringWithUTF8String:modelPath.c_str()]];
+    }
 
-            if (error || !model_) {
-                lastStatus_ = ModelStatus::ErrorInvalidModelFormat;
-                lastError_ = error ? [[error localizedDescription] UTF8String] : "Unknown error loading model";
-                model_ = nil;
-                return false;
-            }
+    static MLModelConfiguration* createConfiguration(const ModelConfig& config) {
+        MLModelConfiguration* mlConfig = [[MLModelConfiguration alloc] init];
+
+        // Set compute units based on config
+        switch (config.computeUnits) {
+            case ModelConfig::ComputeUnits::All:
+                mlConfig.computeUnits = MLComputeUnitsAll;
+                break;
+            case ModelConfig::ComputeUnits::CPUOnly:
+                mlConfig.computeUnits = MLComputeUnitsCPUOnly;
+                break;
+            case ModelConfig::ComputeUnits::CPUAndGPU:
+                mlConfig.computeUnits = MLComputeUnitsCPUAndGPU;
+                break;
+            case ModelConfig::ComputeUnits::CPUAndNeuralEngine:
+                mlConfig.computeUnits = MLComputeUnitsCPUAndNeuralEngine;
+                break;
+        }
+
+        // Enable low power mode if requested
+        if (@available(macOS 13.0, *)) {
+            // Note: MLModelConfiguration doesn't have a direct lowPowerMode property
+            // This would need to be configured through MLPredictionOptions at inference time
+        }
+        return mlConfig;
+    }
+
+    void failLoad(const std::string& modelPath, NSError* error) {
+        lastStatus_ = ModelStatus::ErrorInvalidModelFormat;
+        if (![[NSFileManager defaultManager] fileExistsAtPath:[NSString stringWithUTF8String:modelPath.c_str()]]) {
+            lastError_ = "Model file not found: " + modelPath;
+        } else {
+            lastError_ = error ? [[error localizedDescription] UTF8String] : "Unknown error loading model";
+        }
+    }
+
+    // Make a loaded model the current one; main thread
+    bool installModel(MLModel* loaded, const std::string& modelPath, const ModelConfig& config) {
+        @autoreleasepool {
+            config_ = config;
+            modelInfo_.modelPath = modelPath;
+            model_ = loaded;
 
             // Get model description
             MLModelDescription* description = model_.modelDescription;
@@ -120,11 +183,12 @@ public:
                     MLImageConstraint* imageConstraint = inputDesc.imageConstraint;
                     modelInfo_.inputWidth = imageConstraint.pixelsWide;
                     modelInfo_.inputHeight = imageConstraint.pixelsHigh;
+                    createInputPool(imageConstraint.pixelFormatType);
                 }
             }
 
             // Check Neural Engine support
-            modelInfo_.isNeuralEngineSupported = [self isNeuralEngineSupported];
+            modelInfo_.isNeuralEngineSupported = isNeuralEngineSupported();
             modelInfo_.isLoaded = true;
 
             // Store configuration
@@ -140,6 +204,17 @@ public:
 
     void unload() {
         @autoreleasepool {
+            loads_->next();
+            outputBackings_ = nil;
+            backingBuffers_ = nil;
+            if (inputPool_) {
+                CVPixelBufferPoolRelease(inputPool_);
+                inputPool_ = nullptr;
+            }
+            if (textureCache_) {
+                CFRelease(textureCache_);
+                textureCache_ = nullptr;
+            }
             if (model_) {
                 model_ = nil;
                 modelInfo_.isLoaded = false;
@@ -172,14 +247,14 @@ public:
 
             // Convert ofPixels to CVPixelBuffer
             CVPixelBufferRef pixelBuffer = nullptr;
-            if (![self createPixelBufferFromPixels:pixels buffer:&pixelBuffer]) {
+            if (!createPixelBufferFromPixels(pixels, &pixelBuffer)) {
                 lastStatus_ = ModelStatus::ErrorInvalidInput;
                 lastError_ = "Failed to convert input pixels to CVPixelBuffer";
                 return GaussianCloud();
             }
 
             // Perform inference
-            GaussianCloud cloud = [self performInference:pixelBuffer];
+            GaussianCloud cloud = performInference(pixelBuffer);
 
             // Release pixel buffer
             CVPixelBufferRelease(pixelBuffer);
@@ -215,14 +290,14 @@ public:
 
             // Convert Metal texture to CVPixelBuffer
             CVPixelBufferRef pixelBuffer = nullptr;
-            if (![self createPixelBufferFromTexture:mtlTexture buffer:&pixelBuffer]) {
+            if (!createPixelBufferFromTexture(mtlTexture, &pixelBuffer)) {
                 lastStatus_ = ModelStatus::ErrorInvalidInput;
                 lastError_ = "Failed to convert Metal texture to CVPixelBuffer";
                 return GaussianCloud();
             }
 
             // Perform inference
-            GaussianCloud cloud = [self performInference:pixelBuffer];
+            GaussianCloud cloud = performInference(pixelBuffer);
 
             // Release pixel buffer
             CVPixelBufferRelease(pixelBuffer);
@@ -238,6 +313,71 @@ public:
         }
     }
 
+    // ========================================================================
+    // GPU Inference
+    // ========================================================================
+
+    bool predictInto(const oflike::ofPixels& pixels, GaussianCloud& cloud) {
+        if (!isLoaded()) {
+            lastStatus_ = ModelStatus::ErrorModelNotLoaded;
+            lastError_ = "Model not loaded";
+            return false;
+        }
+
+        @autoreleasepool {
+            auto startTime = std::chrono::high_resolution_clock::now();
+
+            CVPixelBufferRef pixelBuffer = nullptr;
+            if (!createPixelBufferFromPixels(pixels, &pixelBuffer)) {
+                lastStatus_ = ModelStatus::ErrorInvalidInput;
+                lastError_ = "Failed to convert input pixels to CVPixelBuffer";
+                return false;
+            }
+
+            bool decoded = performInferenceInto(pixelBuffer, cloud);
+            CVPixelBufferRelease(pixelBuffer);
+
+            auto endTime = std::chrono::high_resolution_clock::now();
+            std::chrono::duration<double, std::milli> duration = endTime - startTime;
+            lastInferenceTime_ = duration.count();
+            totalInferenceTime_ += lastInferenceTime_;
+            predictionCount_++;
+
+            return decoded;
+        }
+    }
+
+    bool predictInto(const oflike::ofTexture& texture, GaussianCloud& cloud) {
+        if (!isLoaded()) {
+            lastStatus_ = ModelStatus::ErrorModelNotLoaded;
+            lastError_ = "Model not loaded";
+            return false;
+        }
+
+        @autoreleasepool {
+            auto startTime = std::chrono::high_resolution_clock::now();
+
+            id<MTLTexture> mtlTexture = (__bridge id<MTLTexture>)texture.getNativeHandle();
+            CVPixelBufferRef pixelBuffer = nullptr;
+            if (!mtlTexture || !createPixelBufferFromTexture(mtlTexture, &pixelBuffer)) {
+                lastStatus_ = ModelStatus::ErrorInvalidInput;
+                lastError_ = "Failed to convert Metal texture to CVPixelBuffer";
+                return false;
+            }
+
+            bool decoded = performInferenceInto(pixelBuffer, cloud);
+            CVPixelBufferRelease(pixelBuffer);
+
+            auto endTime = std::chrono::high_resolution_clock::now();
+            std::chrono::duration<double, std::milli> duration = endTime - startTime;
+            lastInferenceTime_ = duration.count();
+            totalInferenceTime_ += lastInferenceTime_;
+            predictionCount_++;
+
+            return decoded;
+        }
+    }
+
     // ========================================================================
     // Asynchronous Inference
     // ========================================================================
@@ -306,77 +446,18 @@ public:
     // ========================================================================
 
     std::vector<GaussianCloud> predictBatch(const std::vector<oflike::ofPixels>& images) {
-        std::vector<GaussianCloud> results;
-        results.reserve(images.size());
-
-        if (!isLoaded()) {
-            lastStatus_ = ModelStatus::ErrorModelNotLoaded;
-            lastError_ = "Model not loaded";
-            // Return empty clouds for all images
-            for (size_t i = 0; i < images.size(); i++) {
-                results.push_back(GaussianCloud());
-            }
-            return results;
-        }
-
-        if (batchParallelProcessing_ && images.size() > 1) {
-            // Parallel processing using GCD
-            results.resize(images.size());
-            dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
-            dispatch_group_t group = dispatch_group_create();
-
-            for (size_t i = 0; i < images.size(); i++) {
-                dispatch_group_async(group, queue, ^{
-                    results[i] = predict(images[i]);
-                });
-            }
-
-            dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
-        } else {
-            // Sequential processing
-            for (const auto& image : images) {
-                results.push_back(predict(image));
-            }
-        }
-
-        return results;
+        std::vector<ModelStatus> statuses;
+        return runBatch(images.size(), [&](size_t i, CVPixelBufferRef* outBuffer) {
+            return createPixelBufferFromPixels(images[i], outBuffer);
+        }, statuses);
     }
 
     std::vector<GaussianCloud> predictBatch(const std::vector<oflike::ofTexture>& textures) {
-        std::vector<GaussianCloud> results;
-        results.reserve(textures.size());
-
-        if (!isLoaded()) {
-            lastStatus_ = ModelStatus::ErrorModelNotLoaded;
-            lastError_ = "Model not loaded";
-            // Return empty clouds for all textures
-            for (size_t i = 0; i < textures.size(); i++) {
-                results.push_back(GaussianCloud());
-            }
-            return results;
-        }
-
-        if (batchParallelProcessing_ && textures.size() > 1) {
-            // Parallel processing using GCD
-            results.resize(textures.size());
-            dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
-            dispatch_group_t group = dispatch_group_create();
-
-            for (size_t i = 0; i < textures.size(); i++) {
-                dispatch_group_async(group, queue, ^{
-                    results[i] = predict(textures[i]);
-                });
-            }
-
-            dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
-        } else {
-            // Sequential processing
-            for (const auto& texture : textures) {
-                results.push_back(predict(texture));
-            }
-        }
-
-        return results;
+        std::vector<ModelStatus> statuses;
+        return runBatch(textures.size(), [&](size_t i, CVPixelBufferRef* outBuffer) {
+            id<MTLTexture> mtlTexture = (__bridge id<MTLTexture>)textures[i].getNativeHandle();
+            return mtlTexture && createPixelBufferFromTexture(mtlTexture, outBuffer);
+        }, statuses);
     }
 
     void predictBatchAsync(const std::vector<oflike::ofPixels>& images, PredictBatchCallback callback) {
@@ -391,8 +472,10 @@ public:
         auto imagesCopy = std::make_shared<std::vector<oflike::ofPixels>>(images);
 
         dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
-            std::vector<GaussianCloud> clouds = predictBatch(*imagesCopy);
-            std::vector<ModelStatus> statuses(clouds.size(), lastStatus_);
+            std::vector<ModelStatus> statuses;
+            std::vector<GaussianCloud> clouds = runBatch(imagesCopy->size(), [&](size_t i, CVPixelBufferRef* outBuffer) {
+                return createPixelBufferFromPixels((*imagesCopy)[i], outBuffer);
+            }, statuses);
             callback(std::move(clouds), statuses);
         });
     }
@@ -405,9 +488,19 @@ public:
             return;
         }
 
+        // Hold the Metal textures themselves; the ofTextures may go away
+        NSMutableArray<id<MTLTexture>>* mtlTextures = [NSMutableArray arrayWithCapacity:textures.size()];
+        for (const auto& texture : textures) {
+            id<MTLTexture> mtlTexture = (__bridge id<MTLTexture>)texture.getNativeHandle();
+            [mtlTextures addObject:mtlTexture ? mtlTexture : (id<MTLTexture>)[NSNull null]];
+        }
+
         dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
-            std::vector<GaussianCloud> clouds = predictBatch(textures);
-            std::vector<ModelStatus> statuses(clouds.size(), lastStatus_);
+            std::vector<ModelStatus> statuses;
+            std::vector<GaussianCloud> clouds = runBatch(mtlTextures.count, [&](size_t i, CVPixelBufferRef* outBuffer) {
+                id mtlTexture = mtlTextures[i];
+                return mtlTexture != [NSNull null] && createPixelBufferFromTexture(mtlTexture, outBuffer);
+            }, statuses);
             callback(std::move(clouds), statuses);
         });
     }
@@ -418,10 +511,10 @@ public:
 
     size_t getBatchParallelThreads() const {
         if (!batchParallelProcessing_) return 1;
-        if (batchParallelThreads_ > 0) return batchParallelThreads_;
+        if (batchParallelThreads_ > 0) return std::min(batchParallelThreads_, kMaxBatchWindow);
 
         // Default: number of CPU cores
-        return [[NSProcessInfo processInfo] processorCount];
+        return std::min<size_t>([[NSProcessInfo processInfo] processorCount], kMaxBatchWindow);
     }
 
     // ========================================================================
@@ -478,36 +571,47 @@ private:
     // Internal Helper Methods
     // ========================================================================
 
-    GaussianCloud performInference(CVPixelBufferRef pixelBuffer) {
-        @autoreleasepool {
-            // Create MLFeatureValue from pixel buffer
-            MLFeatureValue* inputValue = [MLFeatureValue featureValueWithPixelBuffer:pixelBuffer];
-            if (!inputValue) {
-                lastStatus_ = ModelStatus::ErrorInvalidInput;
-                lastError_ = "Failed to create MLFeatureValue from pixel buffer";
-                return GaussianCloud();
-            }
+    // Wrap the input image for the model; nil (with lastStatus_ set) on failure
+    MLDictionaryFeatureProvider* createInputProvider(CVPixelBufferRef pixelBuffer) {
+        // Create MLFeatureValue from pixel buffer
+        MLFeatureValue* inputValue = [MLFeatureValue featureValueWithPixelBuffer:pixelBuffer];
+        if (!inputValue) {
+            lastStatus_ = ModelStatus::ErrorInvalidInput;
+            lastError_ = "Failed to create MLFeatureValue from pixel buffer";
+            return nil;
+        }
 
-            // Get input feature name
-            NSString* inputName = model_.modelDescription.inputDescriptionsByName.allKeys.firstObject;
-            if (!inputName) {
-                lastStatus_ = ModelStatus::ErrorInferenceFailed;
-                lastError_ = "Could not determine input feature name";
-                return GaussianCloud();
-            }
+        // Get input feature name
+        NSString* inputName = model_.modelDescription.inputDescriptionsByName.allKeys.firstObject;
+        if (!inputName) {
+            lastStatus_ = ModelStatus::ErrorInferenceFailed;
+            lastError_ = "Could not determine input feature name";
+            return nil;
+        }
 
-            // Create input feature provider
-            NSError* error = nil;
-            MLDictionaryFeatureProvider* inputProvider =
-                [[MLDictionaryFeatureProvider alloc] initWithDictionary:@{inputName: inputValue}
-                                                                   error:&error];
-            if (error || !inputProvider) {
-                lastStatus_ = ModelStatus::ErrorInvalidInput;
-                lastError_ = error ? [[error localizedDescription] UTF8String] : "Failed to create input provider";
+        // Create input feature provider
+        NSError* error = nil;
+        MLDictionaryFeatureProvider* inputProvider =
+            [[MLDictionaryFeatureProvider alloc] initWithDictionary:@{inputName: inputValue}
+                                                               error:&error];
+        if (error || !inputProvider) {
+            lastStatus_ = ModelStatus::ErrorInvalidInput;
+            lastError_ = error ? [[error localizedDescription] UTF8String] : "Failed to create input provider";
+            return nil;
+        }
+        return inputProvider;
+    }
+
+    GaussianCloud performInference(CVPixelBufferRef pixelBuffer) {
+        @autoreleasepool {
+            MLDictionaryFeatureProvider* inputProvider = createInputProvider(pixelBuffer);
+            if (!inputProvider) {
                 return GaussianCloud();
             }
 
             // Create prediction options
+            OF_PROFILE_SCOPE("SharpModel inference");
+            NSError* error = nil;
             MLPredictionOptions* options = [[MLPredictionOptions alloc] init];
 
             // Perform prediction
@@ -521,11 +625,11 @@ private:
             }
 
             // Parse output to GaussianCloud
-            GaussianCloud cloud = [self parseModelOutput:output];
+            GaussianCloud cloud = parseModelOutput(output);
 
             // Apply post-processing if enabled
             if (postProcessingEnabled_) {
-                [self applyPostProcessing:cloud];
+                applyPostProcessing(cloud);
             }
 
             lastStatus_ = ModelStatus::Success;
@@ -535,7 +639,528 @@ private:
         }
     }
 
+    // ========================================================================
+    // Batched Inference
+    // ========================================================================
+
+    // Writes the pixel buffer for input index; false if it can't be converted
+    using BatchInput = std::function<bool(size_t index, CVPixelBufferRef* outBuffer)>;
+
+    // Largest window handed to predictionsFromBatch at once: bounds the
+    // input buffers and model outputs alive at a time
+    static constexpr size_t kMaxBatchWindow = 8;
+
+    // Predict count inputs in order through Core ML's batch API, a window
+    // at a time. Core ML schedules a batch on the compute units as one
+    // request instead of N competing ones; the next window's inputs are
+    // converted while the current one runs. statuses gets one entry per
+    // input and lastStatus_ the last failure (Success if none).
+    std::vector<GaussianCloud> runBatch(size_t count, const BatchInput& makeInput,
+                                        std::vector<ModelStatus>& statuses) {
+        std::vector<GaussianCloud> results(count);
+        if (!isLoaded()) {
+            lastStatus_ = ModelStatus::ErrorModelNotLoaded;
+            lastError_ = "Model not loaded";
+            statuses.assign(count, ModelStatus::ErrorModelNotLoaded);
+            return results;
+        }
+        statuses.assign(count, ModelStatus::Success);
+        lastStatus_ = ModelStatus::Success;
+        lastError_ = "";
+        if (count == 0) {
+            return results;
+        }
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        const size_t window = std::max<size_t>(getBatchParallelThreads(), 1);
+
+        // Input buffers of one window, null where conversion failed
+        auto prepare = [&](size_t begin, std::vector<CVPixelBufferRef>& buffers) {
+            buffers.assign(std::min(window, count - begin), nullptr);
+            for (size_t i = 0; i < buffers.size(); ++i) {
+                if (!makeInput(begin + i, &buffers[i])) {
+                    buffers[i] = nullptr;
+                }
+            }
+        };
+
+        std::vector<CVPixelBufferRef> current;
+        std::vector<CVPixelBufferRef> next;
+        std::vector<CVPixelBufferRef>* pending = &next;
+        prepare(0, current);
+        for (size_t begin = 0; begin < count; begin += window) {
+            const size_t nextBegin = begin + window;
+            dispatch_group_t group = dispatch_group_create();
+            if (nextBegin < count) {
+                dispatch_group_async(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
+                    prepare(nextBegin, *pending);
+                });
+            }
+
+            predictWindow(begin, current, results, statuses);
+
+            dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+            for (CVPixelBufferRef buffer : current) {
+                if (buffer) {
+                    CVPixelBufferRelease(buffer);
+                }
+            }
+            std::swap(current, next);
+        }
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> duration = endTime - startTime;
+        lastInferenceTime_ = duration.count() / count;
+        totalInferenceTime_ += duration.count();
+        predictionCount_ += count;
+        return results;
+    }
+
+    // One predictionsFromBatch call over the converted inputs of a window
+    void predictWindow(size_t begin, const std::vector<CVPixelBufferRef>& buffers,
+                       std::vector<GaussianCloud>& results, std::vector<ModelStatus>& statuses) {
+        @autoreleasepool {
+            NSMutableArray<id<MLFeatureProvider>>* inputs = [NSMutableArray arrayWithCapacity:buffers.size()];
+            std::vector<size_t> indices;
+            for (size_t i = 0; i < buffers.size(); ++i) {
+                MLDictionaryFeatureProvider* inputProvider = buffers[i] ? createInputProvider(buffers[i]) : nil;
+                if (!inputProvider) {
+                    statuses[begin + i] = ModelStatus::ErrorInvalidInput;
+                    lastStatus_ = ModelStatus::ErrorInvalidInput;
+                    lastError_ = "Failed to convert batch input " + std::to_string(begin + i);
+                    continue;
+                }
+                [inputs addObject:inputProvider];
+                indices.push_back(begin + i);
+            }
+            if (inputs.count == 0) {
+                return;
+            }
+
+            NSError* error = nil;
+            MLArrayBatchProvider* batch = [[MLArrayBatchProvider alloc] initWithFeatureProviderArray:inputs];
+            MLPredictionOptions* options = [[MLPredictionOptions alloc] init];
+            id<MLBatchProvider> outputs = [model_ predictionsFromBatch:batch options:options error:&error];
+            if (error || !outputs || static_cast<NSUInteger>(outputs.count) != inputs.count) {
+                for (size_t index : indices) {
+                    statuses[index] = ModelStatus::ErrorInferenceFailed;
+                }
+                lastStatus_ = ModelStatus::ErrorInferenceFailed;
+                lastError_ = error ? [[error localizedDescription] UTF8String] : "Batch inference failed";
+                return;
+            }
+
+            for (size_t i = 0; i < indices.size(); ++i) {
+                GaussianCloud cloud = parseModelOutput([outputs featuresAtIndex:static_cast<NSInteger>(i)]);
+                if (postProcessingEnabled_) {
+                    applyPostProcessing(cloud);
+                }
+                results[indices[i]] = std::move(cloud);
+            }
+        }
+    }
+
+    // Run the model with its outputs in Metal buffers and decode them into
+    // cloud's GPU copy. Outputs with a fixed shape are written by Core ML
+    // into buffers allocated once (output backings); others are copied
+    // into a Metal buffer in one block.
+    bool performInferenceInto(CVPixelBufferRef pixelBuffer, GaussianCloud& cloud) {
+        @autoreleasepool {
+            if (!createDecodePipeline()) {
+                lastStatus_ = ModelStatus::ErrorInferenceFailed;
+                lastError_ = "GPU decode kernel not available";
+                return false;
+            }
+            MLDictionaryFeatureProvider* inputProvider = createInputProvider(pixelBuffer);
+            if (!inputProvider) {
+                return false;
+            }
+
+            OF_PROFILE_SCOPE("SharpModel inference");
+            NSError* error = nil;
+            MLPredictionOptions* options = [[MLPredictionOptions alloc] init];
+            createOutputBackings();
+            if (outputBackings_.count > 0) {
+                options.outputBackings = outputBackings_;
+            }
+            id<MLFeatureProvider> output = [model_ predictionFromFeatures:inputProvider
+                                                                  options:options
+                                                                    error:&error];
+            if (error || !output) {
+                lastStatus_ = ModelStatus::ErrorInferenceFailed;
+                lastError_ = error ? [[error localizedDescription] UTF8String] : "Inference failed";
+                return false;
+            }
+
+            ModelDecodeParams params = {};
+            id<MTLBuffer> buffers[kModelOutputCount] = {};
+            size_t count = 0;
+            for (size_t i = 0; i < kModelOutputCount; ++i) {
+                MLMultiArray* array = [output featureValueForName:kModelOutputNames[i]].multiArrayValue;
+                if (!array) {
+                    continue;
+                }
+                size_t outputCount = 0;
+                if (!describeOutput(array, kModelOutputComponents[i], params.outputs[i], outputCount)) {
+                    lastStatus_ = ModelStatus::ErrorInferenceFailed;
+                    lastError_ = std::string("Unsupported layout for model output ") +
+                                 kModelOutputNames[i].UTF8String;
+                    return false;
+                }
+                if (count != 0 && outputCount != count) {
+                    lastStatus_ = ModelStatus::ErrorInferenceFailed;
+                    lastError_ = "Model outputs disagree on the Gaussian count";
+                    return false;
+                }
+                count = outputCount;
+                buffers[i] = outputBuffer(kModelOutputNames[i], array);
+                if (!buffers[i]) {
+                    lastStatus_ = ModelStatus::ErrorInferenceFailed;
+                    lastError_ = "Failed to create Metal buffer for model output";
+                    return false;
+                }
+            }
+            if (!buffers[0]) {
+                lastStatus_ = ModelStatus::ErrorInferenceFailed;
+                lastError_ = "Model has no positions output";
+                return false;
+            }
+            if (maxGaussians_ > 0) {
+                count = std::min(count, maxGaussians_);
+            }
+            params.count = static_cast<uint32_t>(count);
+
+            id<MTLBuffer> target = (__bridge id<MTLBuffer>)cloud.resizeOnGPU(count);
+            if (!target && count > 0) {
+                lastStatus_ = ModelStatus::ErrorInferenceFailed;
+                lastError_ = "Failed to allocate the cloud's Metal buffer (compressed clouds decode on the CPU)";
+                return false;
+            }
+
+            if (count > 0) {
+                id<MTLCommandBuffer> commandBuffer = [commandQueue_ commandBuffer];
+                commandBuffer.label = @"Sharp Model Decode";
+                id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoder];
+                [encoder setComputePipelineState:decodePipeline_];
+                for (size_t i = 0; i < kModelOutputCount; ++i) {
+                    // Unused slots still need a binding
+                    [encoder setBuffer:buffers[i] ? buffers[i] : buffers[0] offset:0 atIndex:i];
+                }
+                [encoder setBuffer:target offset:0 atIndex:6];
+                [encoder setBytes:&params length:sizeof(params) atIndex:7];
+                const NSUInteger width = decodePipeline_.threadExecutionWidth;
+                [encoder dispatchThreadgroups:MTLSizeMake((count + width - 1) / width, 1, 1)
+                        threadsPerThreadgroup:MTLSizeMake(width, 1, 1)];
+                [encoder endEncoding];
+                [commandBuffer commit];
+                [commandBuffer waitUntilCompleted];
+                if (commandBuffer.status != MTLCommandBufferStatusCompleted) {
+                    lastStatus_ = ModelStatus::ErrorInferenceFailed;
+                    lastError_ = "GPU decode failed";
+                    return false;
+                }
+            }
+
+            lastStatus_ = ModelStatus::Success;
+            lastError_ = "";
+            return true;
+        }
+    }
+
+    bool createDecodePipeline() {
+        if (decodePipeline_ || decodePipelineFailed_) {
+            return decodePipeline_ != nil;
+        }
+        @autoreleasepool {
+            NSError* error = nil;
+            id<MTLLibrary> library = [device_ newDefaultLibrary];
+            id<MTLFunction> function = [library newFunctionWithName:@"gaussianDecodeModel"];
+            if (function) {
+                decodePipeline_ = [device_ newComputePipelineStateWithFunction:function error:&error];
+            }
+            if (!commandQueue_) {
+                commandQueue_ = [device_ newCommandQueue];
+            }
+            if (!decodePipeline_ || !commandQueue_) {
+                NSLog(@"[ofxSharp] Error: GPU model decode kernel not found");
+                decodePipeline_ = nil;
+                decodePipelineFailed_ = true;
+            }
+        }
+        return decodePipeline_ != nil;
+    }
+
+    // Backings for the outputs whose shape the model fixes, over Metal
+    // buffers so the kernel reads what Core ML wrote
+    void createOutputBackings() {
+        if (outputBackings_) {
+            return;
+        }
+        NSMutableDictionary<NSString*, id>* backings = [NSMutableDictionary dictionary];
+        backingBuffers_ = [NSMutableDictionary dictionary];
+        NSDictionary<NSString*, MLFeatureDescription*>* outputs = model_.modelDescription.outputDescriptionsByName;
+        for (size_t i = 0; i < kModelOutputCount; ++i) {
+            MLFeatureDescription* description = outputs[kModelOutputNames[i]];
+            MLMultiArrayConstraint* constraint = description.multiArrayConstraint;
+            if (description.type != MLFeatureTypeMultiArray || !constraint || constraint.shape.count == 0) {
+                continue;
+            }
+            size_t elements = 1;
+            for (NSNumber* dimension in constraint.shape) {
+                elements *= dimension.unsignedIntegerValue;
+            }
+            if (elements == 0) {
+                continue;   // Flexible shape
+            }
+
+            const MLMultiArrayDataType type = constraint.dataType == MLMultiArrayDataTypeFloat16
+                                                  ? MLMultiArrayDataTypeFloat16 : MLMultiArrayDataTypeFloat32;
+            const size_t elementSize = type == MLMultiArrayDataTypeFloat16 ? 2 : 4;
+            id<MTLBuffer> buffer = [device_ newBufferWithLength:elements * elementSize
+                                                        options:MTLResourceStorageModeShared];
+            if (!buffer) {
+                continue;
+            }
+            buffer.label = kModelOutputNames[i];
+
+            NSMutableArray<NSNumber*>* strides = [NSMutableArray arrayWithCapacity:constraint.shape.count];
+            NSInteger stride = 1;
+            for (NSInteger d = constraint.shape.count - 1; d >= 0; --d) {
+                [strides insertObject:@(stride) atIndex:0];
+                stride *= constraint.shape[d].integerValue;
+            }
+            NSError* error = nil;
+            MLMultiArray* backing = [[MLMultiArray alloc] initWithDataPointer:buffer.contents
+                                                                        shape:constraint.shape
+                                                                     dataType:type
+                                                                      strides:strides
+                                                                  deallocator:nil
+                                                                        error:&error];
+            if (backing) {
+                backings[kModelOutputNames[i]] = backing;
+                backingBuffers_[kModelOutputNames[i]] = buffer;
+            }
+        }
+        outputBackings_ = backings;
+    }
+
+    // The Metal buffer holding an output: its backing when Core ML wrote
+    // into it, else a copy
+    id<MTLBuffer> outputBuffer(NSString* name, MLMultiArray* array) {
+        id<MTLBuffer> backing = backingBuffers_[name];
+        if (backing && array.dataPointer == backing.contents) {
+            return backing;
+        }
+        const size_t elementSize = array.dataType == MLMultiArrayDataTypeFloat16 ? 2 : 4;
+        size_t span = 1;
+        for (NSUInteger d = 0; d < array.shape.count; ++d) {
+            span += (array.shape[d].unsignedIntegerValue - 1) * array.strides[d].unsignedIntegerValue;
+        }
+        return [device_ newBufferWithBytes:array.dataPointer length:span * elementSize
+                                   options:MTLResourceStorageModeShared];
+    }
+
+    // Element offsets of a Float16/Float32 output with `components` values
+    // per Gaussian: the trailing axes hold the components, the axis before
+    // them the Gaussians, and any leading (batch) axes must be 1
+    static bool describeOutput(MLMultiArray* array, uint32_t components, ModelOutput& output, size_t& count) {
+        if (array.dataType != MLMultiArrayDataTypeFloat16 && array.dataType != MLMultiArrayDataTypeFloat32) {
+            return false;
+        }
+        NSArray<NSNumber*>* shape = array.shape;
+        NSArray<NSNumber*>* strides = array.strides;
+        const NSInteger dimensions = shape.count;
+        NSInteger axis = dimensions;
+        size_t trailing = 1;
+        while (axis > 0 && trailing < components) {
+            trailing *= shape[--axis].unsignedIntegerValue;
+        }
+        if (trailing != components || axis == 0) {
+            return false;
+        }
+        NSInteger splatAxis = axis - 1;
+        while (splatAxis > 0 && shape[splatAxis].unsignedIntegerValue == 1) {
+            --splatAxis;
+        }
+        for (NSInteger d = 0; d < splatAxis; ++d) {
+            if (shape[d].unsignedIntegerValue != 1) {
+                return false;
+            }
+        }
+        // The component axes must step through memory as one
+        for (NSInteger d = axis; d < dimensions - 1; ++d) {
+            if (shape[d].unsignedIntegerValue > 1 &&
+                strides[d].integerValue != strides[d + 1].integerValue * shape[d + 1].integerValue) {
+                return false;
+            }
+        }
+
+        count = shape[splatAxis].unsignedIntegerValue;
+        output.splatStride = strides[splatAxis].unsignedIntValue;
+        output.componentStride = strides[dimensions - 1].unsignedIntValue;
+        output.isHalf = array.dataType == MLMultiArrayDataTypeFloat16 ? 1 : 0;
+        output.present = 1;
+        return true;
+    }
+
+    // ========================================================================
+    // Input Buffers
+    // ========================================================================
+
+    // Pool of IOSurface-backed input buffers at the model's input size, and
+    // what textures need to be written into them on the GPU (copyTexture
+    // in ImageFilter.metal). Without a pool, every prediction creates its
+    // own buffer at the input image's size.
+    void createInputPool(OSType pixelFormat) {
+        if (!device_ || modelInfo_.inputWidth == 0 || modelInfo_.inputHeight == 0) {
+            return;
+        }
+        inputFormat_ = pixelFormat;
+        NSDictionary* poolAttributes = @{
+            (id)kCVPixelBufferPoolMinimumBufferCountKey: @(kInputPoolSize),
+        };
+        NSDictionary* bufferAttributes = @{
+            (id)kCVPixelBufferWidthKey: @(modelInfo_.inputWidth),
+            (id)kCVPixelBufferHeightKey: @(modelInfo_.inputHeight),
+            (id)kCVPixelBufferPixelFormatTypeKey: @(pixelFormat),
+            (id)kCVPixelBufferMetalCompatibilityKey: @YES,
+            (id)kCVPixelBufferIOSurfacePropertiesKey: @{}
+        };
+        if (CVPixelBufferPoolCreate(kCFAllocatorDefault, (__bridge CFDictionaryRef)poolAttributes,
+                                    (__bridge CFDictionaryRef)bufferAttributes, &inputPool_) != kCVReturnSuccess) {
+            inputPool_ = nullptr;
+            return;
+        }
+
+        // The copy kernel writes the pooled buffers
+        if (inputMetalFormat() == MTLPixelFormatInvalid) {
+            return;
+        }
+        NSDictionary* textureAttributes = @{
+            (NSString*)kCVMetalTextureUsage: @(MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite),
+        };
+        if (!textureCache_ &&
+            CVMetalTextureCacheCreate(kCFAllocatorDefault, nil, device_, (__bridge CFDictionaryRef)textureAttributes,
+                                      &textureCache_) != kCVReturnSuccess) {
+            textureCache_ = nullptr;
+            return;
+        }
+        if (!resizePipeline_) {
+            NSError* error = nil;
+            id<MTLFunction> function = [[device_ newDefaultLibrary] newFunctionWithName:@"copyTexture"];
+            resizePipeline_ = function ? [device_ newComputePipelineStateWithFunction:function error:&error] : nil;
+        }
+        if (!commandQueue_) {
+            commandQueue_ = [device_ newCommandQueue];
+        }
+    }
+
+    // Metal format of the pooled buffers, Invalid if textures can't write them
+    MTLPixelFormat inputMetalFormat() const {
+        switch (inputFormat_) {
+            case kCVPixelFormatType_32BGRA:
+                return MTLPixelFormatBGRA8Unorm;
+            case kCVPixelFormatType_32RGBA:
+                return MTLPixelFormatRGBA8Unorm;
+            default:
+                return MTLPixelFormatInvalid;
+        }
+    }
+
+    // Resize and convert a texture into a pooled buffer in one GPU pass;
+    // false (nothing created) when pooled texture input is unavailable
+    bool createPooledBufferFromTexture(id<MTLTexture> texture, CVPixelBufferRef* outBuffer) {
+        const MTLPixelFormat format = inputMetalFormat();
+        if (!inputPool_ || !textureCache_ || !resizePipeline_ || !commandQueue_ || format == MTLPixelFormatInvalid) {
+            return false;
+        }
+        @autoreleasepool {
+            CVPixelBufferRef buffer = nullptr;
+            if (CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, inputPool_, &buffer) != kCVReturnSuccess) {
+                return false;
+            }
+            CVMetalTextureRef target = nullptr;
+            if (CVMetalTextureCacheCreateTextureFromImage(kCFAllocatorDefault, textureCache_, buffer, nil, format,
+                                                          modelInfo_.inputWidth, modelInfo_.inputHeight, 0,
+                                                          &target) != kCVReturnSuccess) {
+                CVPixelBufferRelease(buffer);
+                return false;
+            }
+
+            id<MTLTexture> destination = CVMetalTextureGetTexture(target);
+            id<MTLCommandBuffer> commandBuffer = [commandQueue_ commandBuffer];
+            commandBuffer.label = @"Sharp Model Input";
+            id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoder];
+            const uint32_t opaque = 1;
+            [encoder setComputePipelineState:resizePipeline_];
+            [encoder setTexture:texture atIndex:0];
+            [encoder setTexture:destination atIndex:1];
+            [encoder setBytes:&opaque length:sizeof(opaque) atIndex:0];
+            const MTLSize group = MTLSizeMake(16, 16, 1);
+            [encoder dispatchThreadgroups:MTLSizeMake((destination.width + 15) / 16, (destination.height + 15) / 16, 1)
+                    threadsPerThreadgroup:group];
+            [encoder endEncoding];
+            [commandBuffer commit];
+            [commandBuffer waitUntilCompleted];
+            CFRelease(target);
+
+            if (commandBuffer.status != MTLCommandBufferStatusCompleted) {
+                CVPixelBufferRelease(buffer);
+                return false;
+            }
+            *outBuffer = buffer;
+            return true;
+        }
+    }
+
+    // Scale 8-bit RGB(A) pixels into a pooled buffer with vImage; false
+    // (nothing created) when the pool's format isn't 8-bit RGBA or BGRA
+    bool createPooledBufferFromPixels(const oflike::ofPixels& pixels, CVPixelBufferRef* outBuffer) {
+        const size_t channels = pixels.getNumChannels();
+        if (!inputPool_ || inputMetalFormat() == MTLPixelFormatInvalid || (channels != 3 && channels != 4)) {
+            return false;
+        }
+
+        // 4-channel source, converted from RGB if needed
+        const size_t width = pixels.getWidth();
+        const size_t height = pixels.getHeight();
+        vImage_Buffer source = {const_cast<unsigned char*>(pixels.getData()), height, width, pixels.getBytesStride()};
+        std::vector<uint8_t> expanded;
+        if (channels == 3) {
+            expanded.resize(width * height * 4);
+            oflike::ofPixelConvert::rgbToRGBA(pixels.getData(), pixels.getBytesStride(), expanded.data(), 0,
+                                              width, height);
+            source = {expanded.data(), height, width, width * 4};
+        }
+
+        CVPixelBufferRef buffer = nullptr;
+        if (CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, inputPool_, &buffer) != kCVReturnSuccess) {
+            return false;
+        }
+        CVPixelBufferLockBaseAddress(buffer, 0);
+        vImage_Buffer destination = {CVPixelBufferGetBaseAddress(buffer), CVPixelBufferGetHeight(buffer),
+                                     CVPixelBufferGetWidth(buffer), CVPixelBufferGetBytesPerRow(buffer)};
+        // Channel order doesn't matter to the scaler
+        vImage_Error result = vImageScale_ARGB8888(&source, &destination, nullptr, kvImageNoFlags);
+        if (result == kvImageNoError && inputFormat_ == kCVPixelFormatType_32BGRA) {
+            uint8_t* base = static_cast<uint8_t*>(destination.data);
+            oflike::ofPixelConvert::rgbaToBGRA(base, destination.rowBytes, base, destination.rowBytes,
+                                               destination.width, destination.height);
+        }
+        CVPixelBufferUnlockBaseAddress(buffer, 0);
+
+        if (result != kvImageNoError) {
+            CVPixelBufferRelease(buffer);
+            return false;
+        }
+        *outBuffer = buffer;
+        return true;
+    }
+
     bool createPixelBufferFromPixels(const oflike::ofPixels& pixels, CVPixelBufferRef* outBuffer) {
+        if (createPooledBufferFromPixels(pixels, outBuffer)) {
+            return true;
+        }
         @autoreleasepool {
             size_t width = pixels.getWidth();
             size_t height = pixels.getHeight();
@@ -578,13 +1203,8 @@ private:
             // Copy pixel data
             void* baseAddress = CVPixelBufferGetBaseAddress(*outBuffer);
             size_t bytesPerRow = CVPixelBufferGetBytesPerRow(*outBuffer);
-            const unsigned char* src = pixels.getData();
-
-            for (size_t y = 0; y < height; y++) {
-                memcpy((uint8_t*)baseAddress + y * bytesPerRow,
-                       src + y * width * channels,
-                       width * channels);
-            }
+            oflike::ofPixelConvert::copyRows(pixels.getData(), pixels.getBytesStride(), baseAddress, bytesPerRow,
+                                             width * channels, height);
 
             // Unlock pixel buffer
             CVPixelBufferUnlockBaseAddress(*outBuffer, 0);
@@ -594,6 +1214,11 @@ private:
     }
 
     bool createPixelBufferFromTexture(id<MTLTexture> texture, CVPixelBufferRef* outBuffer) {
+        if (createPooledBufferFromTexture(texture, outBuffer)) {
+            return true;
+        }
+
+        // Fallback: read the texture back on the CPU
         @autoreleasepool {
             size_t width = texture.width;
             size_t height = texture.height;
@@ -671,15 +1296,15 @@ private:
 
                     // Parse based on output name
                     if ([name isEqualToString:@"positions"]) {
-                        [self parsePositions:array intoCloud:cloud];
+                        parsePositions(array, cloud);
                     } else if ([name isEqualToString:@"scales"]) {
-                        [self parseScales:array intoCloud:cloud];
+                        parseScales(array, cloud);
                     } else if ([name isEqualToString:@"rotations"]) {
-                        [self parseRotations:array intoCloud:cloud];
+                        parseRotations(array, cloud);
                     } else if ([name isEqualToString:@"opacities"]) {
-                        [self parseOpacities:array intoCloud:cloud];
+                        parseOpacities(array, cloud);
                     } else if ([name isEqualToString:@"sh_dc"]) {
-                        [self parseSHDC:array intoCloud:cloud];
+                        parseSHDC(array, cloud);
                     }
                 }
             }
@@ -747,11 +1372,26 @@ private:
 
     MLModel* model_;
     id<MTLDevice> device_;
+
+    // Pooled input buffers (createInputPool)
+    static constexpr int kInputPoolSize = 3;
+    CVPixelBufferPoolRef inputPool_ = nullptr;
+    OSType inputFormat_ = 0;
+    CVMetalTextureCacheRef textureCache_ = nullptr;
+    id<MTLComputePipelineState> resizePipeline_ = nil;
+
+    // GPU decoding (predictInto) and input copies
+    id<MTLCommandQueue> commandQueue_ = nil;
+    id<MTLComputePipelineState> decodePipeline_ = nil;
+    bool decodePipelineFailed_ = false;
+    NSDictionary<NSString*, id>* outputBackings_ = nil;
+    NSMutableDictionary<NSString*, id<MTLBuffer>>* backingBuffers_ = nil;
     ModelConfig config_;
     ModelInfo modelInfo_;
 
     ModelStatus lastStatus_;
     std::string lastError_;
+    std::shared_ptr<NeuralEngine::ModelLoadGeneration> loads_ = std::make_shared<NeuralEngine::ModelLoadGeneration>();
 
     double lastInferenceTime_;
     double totalInferenceTime_;
@@ -789,6 +1429,15 @@ bool SharpModel::load(const std::string& modelPath, const ModelConfig& config) {
     return impl_->load(modelPath, config);
 }
 
+void SharpModel::loadAsync(const std::string& modelPath, LoadCallback callback) {
+    ModelConfig config;
+    impl_->loadAsync(modelPath, config, callback);
+}
+
+void SharpModel::loadAsync(const std::string& modelPath, const ModelConfig& config, LoadCallback callback) {
+    impl_->loadAsync(modelPath, config, callback);
+}
+
 void SharpModel::unload() {
     impl_->unload();
 }
@@ -810,6 +1459,15 @@ GaussianCloud SharpModel::predict(const oflike::ofTexture& texture) {
     return impl_->predict(texture);
 }
 
+// GPU Inference
+bool SharpModel::predictInto(const oflike::ofPixels& image, GaussianCloud& cloud) {
+    return impl_->predictInto(image, cloud);
+}
+
+bool SharpModel::predictInto(const oflike::ofTexture& texture, GaussianCloud& cloud) {
+    return impl_->predictInto(texture, cloud);
+}
+
 // Asynchronous Inference
 void SharpModel::predictAsync(const oflike::ofPixels& image, PredictCallback callback) {
     impl_->predictAsync(image, callback);
@@ -4,7 +4,8 @@
 //
 // This class provides a high-performance GPU-accelerated renderer for 3D Gaussian Splatting
 // point clouds. It implements the following features:
-// - GPU-based depth sorting using Metal compute shaders
+// - GPU-resident depth sorting (radix sort in the frame's command buffer)
+// - Compressed Gaussian input decoded in the shaders
 // - Alpha blending with proper transparency
 // - Efficient covariance to 2D projection
 // - Anti-aliasing through Gaussian splatting
@@ -24,21 +25,57 @@
 #include "SharpGaussianCloud.h"
 #include <memory>
 #include <functional>
+#include <vector>
 
 // Forward declarations
 namespace oflike {
     class ofCamera;
     class ofTexture;
     class ofMatrix4x4;
+    class ofRasterizationRate;
 }
 
 namespace Sharp {
 
+// How Gaussians are rasterized
+enum class RasterMode {
+    // One back-to-front sorted list of quads, blended by the hardware
+    Quads,
+
+    // Reference-style tiles: splats are binned into 16x16 pixel tiles,
+    // sorted per tile and composited front to back in compute, stopping
+    // once a pixel is opaque. Far less overdraw on large clouds; falls
+    // back to quads above 65536 tiles (about 4096 x 4096 pixels).
+    Tiles
+};
+
 // Rendering configuration
 struct RenderConfig {
-    // Enable depth sorting (required for correct transparency)
+    // Rasterization mode
+    RasterMode rasterMode = RasterMode::Quads;
+
+    // Enable depth sorting (required for correct transparency; tiles
+    // always sort)
     bool enableDepthSort = true;
 
+    // Depth key bits for the GPU sort: 32 (exact order) or 16 (half the
+    // sort passes; depths closer than about 1% may draw in either order)
+    int sortKeyBits = 32;
+
+    // Start each sort from the previous frame's order and only repair
+    // local disorder (cheap while the camera moves a little per frame;
+    // the GPU sort needs enableFrustumCulling off)
+    bool incrementalSort = false;
+
+    // Repair passes per incremental GPU sort (the CPU fallback repairs
+    // with an insertion sort, which always finishes)
+    int incrementalSortPasses = 1;
+
+    // Sort from scratch when the camera turns more than this many degrees
+    // in a frame, or after this many incremental frames
+    float fullSortAngle = 2.0f;
+    int fullSortInterval = 60;
+
     // Enable anti-aliasing
     bool enableAntialiasing = true;
 
@@ -49,6 +86,15 @@ struct RenderConfig {
     // 0 = diffuse only, 3 = full view-dependent appearance
     int maxSHDegree = 3;
 
+    // Splats smaller than this many pixels (radius) drop one SH degree
+    // per halving of their size; 0 = every splat uses maxSHDegree
+    float shDetailRadius = 16.0f;
+
+    // Quads evaluate SH once per splat into a color cache, reused while
+    // the camera has moved too little to turn any splat's view direction
+    // by more than this many degrees; 0 = evaluate every frame
+    float shCacheAngle = 0.25f;
+
     // Scale factor for Gaussian splats (larger = bigger splats)
     float splatScale = 1.0f;
 
@@ -58,22 +104,60 @@ struct RenderConfig {
     // Minimum opacity threshold (Gaussians below this are culled)
     float minOpacity = 0.01f;
 
-    // Enable frustum culling
+    // Cull splats outside the frustum, under half a pixel or below
+    // minOpacity on the GPU before sorting (GPU sort only; the culled
+    // sort always starts over, so incrementalSort has no effect)
     bool enableFrustumCulling = true;
 
     // Enable backface culling (culls Gaussians facing away)
     bool enableBackfaceCulling = false;
+
+    // Draw clouds that have an LOD octree (GaussianCloud::buildLOD) by
+    // picking nodes per frame: the node with the largest screen-space
+    // error is refined first, until nodes are under lodErrorThreshold
+    // pixels or the frame would exceed lodSplatBudget splats. Node splats
+    // stream into a GPU cache of lodCacheSplats (about 270 bytes each),
+    // at most lodUploadBudget per frame; a node whose children aren't
+    // cached yet draws itself meanwhile. Needs the GPU sort when sorting.
+    bool enableLOD = true;
+    size_t lodSplatBudget = 4000000;
+    float lodErrorThreshold = 2.0f;
+    size_t lodCacheSplats = 6000000;
+    size_t lodUploadBudget = 262144;
+};
+
+// One placement of a cloud in a batch drawn by SharpRenderer::render
+struct RenderInstance {
+    const GaussianCloud* cloud = nullptr;
+    oflike::float4x4 transform = matrix_identity_float4x4;    // Object to world
+    bool visible = true;
+};
+
+// One viewpoint of a multi-view render (stereo eyes, projectors, CAVE walls)
+struct RenderView {
+    oflike::float4x4 viewMatrix = matrix_identity_float4x4;
+    oflike::float4x4 projectionMatrix = matrix_identity_float4x4;
+    // Pixel rectangle of the render target the view draws into (x, y,
+    // width, height); zero width or height = the whole target
+    oflike::float4 viewport = {0.0f, 0.0f, 0.0f, 0.0f};
+    // Slice of a 2D array render target (layered rendering); 0 otherwise
+    uint32_t layer = 0;
 };
 
 // Rendering statistics
 struct RenderStats {
-    uint32_t totalGaussians = 0;
+    uint32_t totalGaussians = 0;      // In the frame (the LOD selection's under LOD)
     uint32_t visibleGaussians = 0;
     uint32_t culledGaussians = 0;
     double sortTimeMs = 0.0;
+    uint32_t fullSorts = 0;           // Since the last resetStats()
+    uint32_t incrementalSorts = 0;    // Full sorts skipped for incremental ones
     double renderTimeMs = 0.0;
     double totalTimeMs = 0.0;
     uint32_t frameIndex = 0;
+    uint32_t lodNodes = 0;            // LOD nodes drawn
+    uint32_t lodUploads = 0;          // Splats streamed into the LOD cache this frame
+    uint32_t shCacheReuses = 0;       // Frames that reused the SH colors, since resetStats()
 };
 
 class SharpRenderer {
@@ -119,6 +203,9 @@ public:
 
     /**
      * Render a Gaussian cloud with the given camera and render target.
+     * Compressed clouds (GaussianCloud::setCompressed) are read straight
+     * from their Metal buffer once updateMetalBuffer() has run; other
+     * clouds are expanded into an upload buffer every frame.
      * @param cloud Gaussian cloud to render
      * @param camera Camera for view/projection matrices
      * @param renderTarget Metal texture to render to (id<MTLTexture>)
@@ -144,6 +231,53 @@ public:
                 void* renderTarget,
                 void* commandBuffer);
 
+    /**
+     * Render several clouds, each placed by its own transform, with one
+     * depth sort and one draw so that splats of different clouds blend
+     * in the right order. The batch is gathered on the GPU once and kept
+     * while the same clouds are passed unedited; frames that only move
+     * or hide instances rerun a single transform pass. LOD is not
+     * applied to batches.
+     * @param instances Clouds and their object-to-world transforms
+     * @param viewMatrix View matrix
+     * @param projectionMatrix Projection matrix
+     * @param renderTarget Metal texture to render to (id<MTLTexture>)
+     * @param commandBuffer Metal command buffer (id<MTLCommandBuffer>)
+     * @return true if rendering succeeded
+     */
+    bool render(const std::vector<RenderInstance>& instances,
+                const oflike::ofMatrix4x4& viewMatrix,
+                const oflike::ofMatrix4x4& projectionMatrix,
+                void* renderTarget,
+                void* commandBuffer);
+
+    /**
+     * Render a Gaussian cloud from several nearby viewpoints at once.
+     * Culling, the depth sort, LOD selection and SH colors are computed
+     * once from cullView; each view then only projects and rasterizes
+     * the shared draw order, two views per draw where the GPU supports
+     * vertex amplification. Valid while the views are close to cullView
+     * (a stereo pair, overlapping projectors): give cullView a frustum
+     * covering every view, e.g. the center eye with a widened field of
+     * view, since splats it culls are missing from every view. Always
+     * draws quads (RasterMode::Tiles is ignored).
+     * @param cloud Gaussian cloud to render
+     * @param cullView Central viewpoint for culling, sorting and SH
+     * @param views Up to kMaxRenderViews views (viewports of one target,
+     *              or slices of a 2D array target)
+     * @param renderTarget Metal texture to render to (id<MTLTexture>)
+     * @param commandBuffer Metal command buffer (id<MTLCommandBuffer>)
+     * @return true if rendering succeeded
+     */
+    bool render(const GaussianCloud& cloud,
+                const RenderView& cullView,
+                const std::vector<RenderView>& views,
+                void* renderTarget,
+                void* commandBuffer);
+
+    // Views per multi-view render (Metal's viewport array)
+    static constexpr size_t kMaxRenderViews = 16;
+
     // ============================================================================
     // Configuration
     // ============================================================================
@@ -165,6 +299,11 @@ public:
      */
     void setDepthSortEnabled(bool enabled);
 
+    /**
+     * Set rasterization mode (RasterMode::Tiles for fill-rate bound scenes).
+     */
+    void setRasterMode(RasterMode mode);
+
     /**
      * Set splat scale multiplier.
      * Values > 1.0 make splats larger, < 1.0 make them smaller.
@@ -189,6 +328,17 @@ public:
      */
     void setMaxSHDegree(int degree);
 
+    /**
+     * Shade splats at reduced rates by region of the target.
+     * Single-view quads draw through a rasterization rate map into a
+     * smaller texture that is stretched back and blended over the target,
+     * cutting fragment cost where the rates are low (dome periphery,
+     * projector blend edges). Multi-view renders and RasterMode::Tiles
+     * draw at full rate; so do GPUs without rate maps.
+     * @param rate Zones and rates; a default ofRasterizationRate turns it off
+     */
+    void setRasterizationRate(const oflike::ofRasterizationRate& rate);
+
     // ============================================================================
     // Statistics
     // ============================================================================
@@ -2,11 +2,21 @@
 #import "SharpGaussian.h"
 #import "ofCamera.h"
 #import "ofMatrix4x4.h"
+#import "core/Context.h"
+#import "render/IRenderer.h"
+#import "oflike/utils/ofProfiler.h"
+#import "oflike/graphics/ofRasterizationRate.h"
+#import "render/metal/MetalAllocations.h"
 #import <Metal/Metal.h>
 #import <MetalKit/MetalKit.h>
 #import <simd/simd.h>
 #import <Accelerate/Accelerate.h>
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <queue>
 #include <vector>
 #include <chrono>
 
@@ -36,9 +46,8 @@ struct GaussianUniforms {
     float opacityScale;
     int maxSHDegree;
     int enableSphericalHarmonics;
-    int screenWidth;
-    int screenHeight;
-    float padding[3];
+    simd_float2 viewportSize;
+    float padding[2];
 };
 
 struct SortData {
@@ -46,6 +55,111 @@ struct SortData {
     float depth;        // Depth in camera space (for sorting)
 };
 
+// GPU radix sort (GaussianSort.metal): 8-bit digits over depth keys, one
+// block of RADIX_THREADS * RADIX_ITEMS keys per threadgroup
+static constexpr uint32_t kRadixBins = 256;
+static constexpr uint32_t kRadixThreads = 256;
+static constexpr uint32_t kRadixBlock = kRadixThreads * 8;
+
+struct RadixParams {
+    uint32_t count;
+    uint32_t blockCount;
+    uint32_t shift;
+};
+
+struct DepthParams {
+    simd_float4 viewRow;
+    uint32_t count;
+};
+
+// Incremental re-sort windows (GaussianSort.metal)
+static constexpr uint32_t kLocalSortWindow = 1024;
+
+struct LocalSortParams {
+    uint32_t count;
+    uint32_t offset;
+};
+
+// Tile rasterizer (GaussianTiles.metal): 16x16 pixel tiles, 32-bit keys
+// holding the tile in the high half
+static constexpr uint32_t kTileSize = 16;
+static constexpr uint32_t kMaxTiles = 1u << 16;
+
+struct TileUniforms {
+    simd_float4x4 viewMatrix;
+    simd_float4x4 viewProjectionMatrix;
+    simd_float3 cameraPosition;
+    simd_float2 focal;
+    simd_float2 viewportSize;
+    simd_uint2 tileCount;
+    uint32_t count;
+    uint32_t capacity;
+    float splatScale;
+    float opacityScale;
+    float minOpacity;
+    int maxSHDegree;
+    float shDetailRadius;
+};
+
+struct TileSplat {
+    simd_float4 conicOpacity;
+    simd_float4 color;
+    simd_float2 center;
+    simd_uint2 rectMin;
+    simd_uint2 rectMax;
+};
+
+// Setup buffer written by gaussianTileSetup: constant blocks in 256-byte
+// slots (the constant buffer offset alignment on macOS)
+static constexpr size_t kSetupSlot = 256;
+static constexpr size_t kSetupScanLengthOffset = 4 * kSetupSlot;
+static constexpr size_t kSetupRequestedOffset = 5 * kSetupSlot;
+static constexpr size_t kSetupBlockGroupsOffset = kSetupRequestedOffset + 4;
+static constexpr size_t kSetupEntryGroupsOffset = kSetupRequestedOffset + 16;
+static constexpr size_t kSetupSize = 6 * kSetupSlot;
+
+// gaussianCullSetup shares the layout: the survivor count sits in the
+// requested slot, the indirect draw arguments in the entry groups slot
+static constexpr size_t kSetupVisibleOffset = kSetupRequestedOffset;
+static constexpr size_t kSetupDrawOffset = kSetupEntryGroupsOffset;
+
+// Multi-view renders (GaussianSplatting.metal): per-view uniforms at 2, the
+// first view of the draw at 4 and the views' array slices at 5; views are
+// amplified in pairs where supported
+static constexpr NSUInteger kViewBaseIndex = 4;
+static constexpr NSUInteger kViewLayersIndex = 5;
+static constexpr NSUInteger kViewAmplification = 2;
+
+// Compressed Gaussian input (GaussianCompressed.h)
+static constexpr NSUInteger kCompressedSplatsIndex = 8;
+static constexpr NSUInteger kCompressedChunksIndex = 9;
+static constexpr NSUInteger kCompressedCodebookIndex = 10;
+
+// Visibility culling before the sort (GaussianSort.metal)
+static constexpr float kMinSplatRadius = 0.5f;     // Pixels
+
+struct CullParams {
+    simd_float4x4 viewMatrix;
+    simd_float4x4 viewProjectionMatrix;
+    simd_float2 focal;
+    simd_float2 viewportSize;
+    uint32_t count;
+    float splatScale;
+    float opacityScale;
+    float minOpacity;
+    float minRadius;
+};
+
+// SH color cache for quads (GaussianSplatting.metal)
+struct SHColorParams {
+    simd_float3 cameraPosition;
+    float focal;
+    uint32_t count;
+    int maxSHDegree;
+    float splatScale;
+    float detailRadius;
+};
+
 // ============================================================================
 // Private Implementation
 // ============================================================================
@@ -56,11 +170,22 @@ public:
         : device_(nil)
         , commandQueue_(nil)
         , renderPipelineState_(nil)
-        , sortComputePipelineState_(nil)
+        , projectDepthPipeline_(nil)
+        , radixHistogramPipeline_(nil)
+        , radixScanPipeline_(nil)
+        , radixScatterPipeline_(nil)
         , gaussianBuffer_(nil)
         , sortDataBuffer_(nil)
         , indexBuffer_(nil)
-        , uniformBuffer_(nil)
+        , histogramBuffer_(nil)
+        , sortedIndices_(nil)
+        , tileSplats_(nil)
+        , tileOffsets_(nil)
+        , tileRanges_(nil)
+        , tileSetup_(nil)
+        , tileOutput_(nil)
+        , tileCompositePipeline_(nil)
+        , uniforms_()
         , config_()
         , stats_()
         , initialized_(false)
@@ -100,6 +225,9 @@ public:
                 return false;
             }
 
+            // Tile rasterizer (optional; quads are drawn without it)
+            createTilePipelines();
+
             initialized_ = true;
             return true;
         }
@@ -112,11 +240,68 @@ public:
     void shutdown() {
         @autoreleasepool {
             renderPipelineState_ = nil;
-            sortComputePipelineState_ = nil;
+            projectDepthPipeline_ = nil;
+            reprojectDepthPipeline_ = nil;
+            localSortPipeline_ = nil;
+            cullProjectPipeline_ = nil;
+            cullSetupPipeline_ = nil;
+            compressedRenderPipelineState_ = nil;
+            viewsPipelineState_ = nil;
+            amplifiedPipelineState_ = nil;
+            compressedViewsPipelineState_ = nil;
+            compressedAmplifiedPipelineState_ = nil;
+            views_.clear();
+            compressedProjectDepthPipeline_ = nil;
+            compressedReprojectDepthPipeline_ = nil;
+            compressedCullProjectPipeline_ = nil;
+            compressedTilePreprocessPipeline_ = nil;
+            compressedSHColorPipeline_ = nil;
+            compressedBuffer_ = nil;
+            compressedInput_ = false;
+            cullSetup_ = nil;
+            drawIndirect_ = false;
+            previousOrderCount_ = 0;
+            radixHistogramPipeline_ = nil;
+            radixScanPipeline_ = nil;
+            radixScatterPipeline_ = nil;
             gaussianBuffer_ = nil;
+            cloudExpandPipeline_ = nil;
+            bufferContents_ = BufferContents::None;
+            sceneTransformPipeline_ = nil;
+            sceneLocal_ = nil;
+            sceneObjectIDs_ = nil;
+            sceneEntries_.clear();
+            sceneTransforms_.clear();
+            lodCache_ = nil;
+            lodCloud_ = nullptr;
+            shColorPipeline_ = nil;
+            shColors_ = nil;
+            shMinDistance_ = nil;
+            shCacheCount_ = 0;
             sortDataBuffer_ = nil;
             indexBuffer_ = nil;
-            uniformBuffer_ = nil;
+            for (int i = 0; i < 2; ++i) {
+                sortKeys_[i] = nil;
+                sortValues_[i] = nil;
+            }
+            histogramBuffer_ = nil;
+            sortedIndices_ = nil;
+            tilePreprocessPipeline_ = nil;
+            tileSetupPipeline_ = nil;
+            tileDuplicatePipeline_ = nil;
+            tileRangesPipeline_ = nil;
+            tileRenderPipeline_ = nil;
+            tileCompositePipeline_ = nil;
+            tileSplats_ = nil;
+            tileOffsets_ = nil;
+            tileRanges_ = nil;
+            tileSetup_ = nil;
+            tileOutput_ = nil;
+            tileCapacity_ = 0;
+            rateMap_ = nil;
+            rateParameters_ = nil;
+            rateTexture_ = nil;
+            rateCompositePipeline_ = nil;
             device_ = nil;
             commandQueue_ = nil;
             initialized_ = false;
@@ -147,13 +332,164 @@ public:
             id<MTLCommandBuffer> cmdBuffer = (__bridge id<MTLCommandBuffer>)commandBuffer;
 
             // Update statistics
-            stats_.totalGaussians = static_cast<uint32_t>(cloud.size());
             stats_.frameIndex = frameIndex_++;
+            stats_.lodNodes = 0;
+            stats_.lodUploads = 0;
+
+            views_.clear();
+            size_t count = 0;
+            bool lod = false;
+            if (!prepareCloud(cloud, toSimdMatrix(viewMatrix), toSimdMatrix(projectionMatrix),
+                              static_cast<float>(targetTexture.height), cmdBuffer, count, lod)) {
+                return false;
+            }
+            if (count == 0) {
+                return true;    // Everything outside the frustum
+            }
+
+            return renderFrame(lod ? nullptr : &cloud, &cloud, count, viewMatrix, projectionMatrix, targetTexture,
+                               cmdBuffer, startTime);
+        }
+    }
+
+    // Make cloud's splats for this frame ready to sort and draw: its LOD
+    // selection for the view, its compressed buffer, or the upload
+    // layout. count is 0 when an LOD selection has nothing in view.
+    bool prepareCloud(const GaussianCloud& cloud, const simd_float4x4& view, const simd_float4x4& projection,
+                      float height, id<MTLCommandBuffer> cmdBuffer, size_t& count, bool& lod) {
+        // Clouds with an LOD octree draw this frame's node selection,
+        // gathered from the node cache. Compressed clouds are read from
+        // their own buffer; the rest are expanded into the upload
+        // layout, on the GPU when the cloud's own copy is current and
+        // otherwise from the CPU every frame.
+        count = cloud.size();
+        lod = usesLOD(cloud);
+        compressedInput_ = !lod && cloud.isCompressed() && !cloud.isBufferDirty() &&
+                           cloud.getMetalBuffer() && canReadCompressed();
+        if (lod) {
+            compressedBuffer_ = nil;
+            count = selectLODNodes(cloud, view, projection, height);
+            if (count == 0) {
+                return true;
+            }
+            if (!gatherLODNodes(count, cmdBuffer)) {
+                return false;
+            }
+        } else if (compressedInput_) {
+            id<MTLBuffer> buffer = (__bridge id<MTLBuffer>)cloud.getMetalBuffer();
+            if (buffer != compressedBuffer_ || cloud.getBufferGeneration() != compressedGeneration_) {
+                ++contentsVersion_;
+            }
+            compressedBuffer_ = buffer;
+            compressedGeneration_ = cloud.getBufferGeneration();
+            compressedLayout_ = cloud.getCompressedLayout();
+        } else {
+            compressedBuffer_ = nil;
+            if (!expandCloudBuffer(cloud, cmdBuffer) && !uploadGaussianData(cloud)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // One sort, SH fill and cull from cullView; views_ makes
+    // renderGaussians() draw each view from them
+    bool render(const GaussianCloud& cloud,
+                const RenderView& cullView,
+                const std::vector<RenderView>& views,
+                void* renderTarget,
+                void* commandBuffer) {
+        @autoreleasepool {
+            if (!initialized_ || views.empty() || views.size() > SharpRenderer::kMaxRenderViews) {
+                return false;
+            }
+            if (cloud.size() == 0) {
+                return true;
+            }
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+
+            id<MTLTexture> targetTexture = (__bridge id<MTLTexture>)renderTarget;
+            id<MTLCommandBuffer> cmdBuffer = (__bridge id<MTLCommandBuffer>)commandBuffer;
+
+            stats_.frameIndex = frameIndex_++;
+            stats_.lodNodes = 0;
+            stats_.lodUploads = 0;
+
+            const simd_float4 cullRect = viewRect(cullView, targetTexture);
+            views_.clear();
+            size_t count = 0;
+            bool lod = false;
+            if (!prepareCloud(cloud, cullView.viewMatrix, cullView.projectionMatrix, cullRect.w, cmdBuffer,
+                              count, lod)) {
+                return false;
+            }
+            if (count == 0) {
+                return true;
+            }
+
+            views_ = views;
+            cullViewportSize_ = cullRect.zw;
+            const bool drawn = renderFrame(lod ? nullptr : &cloud, &cloud, count,
+                                           oflike::ofMatrix4x4(cullView.viewMatrix),
+                                           oflike::ofMatrix4x4(cullView.projectionMatrix), targetTexture,
+                                           cmdBuffer, startTime);
+            views_.clear();
+            return drawn;
+        }
+    }
+
+    // All instances share one sort and one draw: their splats are gathered
+    // once in object space with a per-splat object index, and each frame
+    // whose transforms changed rewrites the world-space copy on the GPU
+    bool render(const std::vector<RenderInstance>& instances,
+                const oflike::ofMatrix4x4& viewMatrix,
+                const oflike::ofMatrix4x4& projectionMatrix,
+                void* renderTarget,
+                void* commandBuffer) {
+        @autoreleasepool {
+            if (!initialized_) {
+                return false;
+            }
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+
+            id<MTLTexture> targetTexture = (__bridge id<MTLTexture>)renderTarget;
+            id<MTLCommandBuffer> cmdBuffer = (__bridge id<MTLCommandBuffer>)commandBuffer;
 
-            // Upload Gaussian data to GPU
-            if (!uploadGaussianData(cloud)) {
+            stats_.frameIndex = frameIndex_++;
+            stats_.lodNodes = 0;
+            stats_.lodUploads = 0;
+            compressedInput_ = false;
+            compressedBuffer_ = nil;
+            views_.clear();
+
+            size_t count = 0;
+            if (!prepareScene(instances, cmdBuffer, count)) {
                 return false;
             }
+            if (count == 0) {
+                return true; // Nothing to render
+            }
+            return renderFrame(nullptr, &sceneEntries_, count, viewMatrix, projectionMatrix, targetTexture,
+                               cmdBuffer, startTime);
+        }
+    }
+
+    // Everything after gaussianBuffer_ (or the compressed input) is ready:
+    // sort and draw count splats. cloud is the CPU copy for the CPU sort
+    // (nullptr draws unsorted without the GPU sort); source tells frames
+    // apart for the incremental sort.
+    bool renderFrame(const GaussianCloud* cloud,
+                     const void* source,
+                     size_t count,
+                     const oflike::ofMatrix4x4& viewMatrix,
+                     const oflike::ofMatrix4x4& projectionMatrix,
+                     id<MTLTexture> targetTexture,
+                     id<MTLCommandBuffer> cmdBuffer,
+                     std::chrono::high_resolution_clock::time_point startTime) {
+        @autoreleasepool {
+            stats_.totalGaussians = static_cast<uint32_t>(count);
 
             // Prepare uniforms
             GaussianUniforms uniforms;
@@ -165,28 +501,54 @@ public:
             uniforms.opacityScale = config_.opacityScale;
             uniforms.maxSHDegree = config_.enableSphericalHarmonics ? config_.maxSHDegree : 0;
             uniforms.enableSphericalHarmonics = config_.enableSphericalHarmonics ? 1 : 0;
-            uniforms.screenWidth = static_cast<int>(targetTexture.width);
-            uniforms.screenHeight = static_cast<int>(targetTexture.height);
+            uniforms.viewportSize = views_.empty() ? simd_make_float2(targetTexture.width, targetTexture.height)
+                                                   : cullViewportSize_;
 
             // Upload uniforms
             if (!uploadUniforms(uniforms)) {
                 return false;
             }
 
-            // Depth sort if enabled
+            // Tile mode rasterizes in compute and replaces sort and draw
+            // (single views only)
+            if (config_.rasterMode == RasterMode::Tiles && views_.empty() && canRenderTiles(targetTexture)) {
+                OF_PROFILE_SCOPE("SharpRenderer render (tiles)");
+                previousOrderCount_ = 0;    // Tile keys reuse the sort buffers
+                if (!renderTiles(count, viewMatrix, projectionMatrix, targetTexture, cmdBuffer)) {
+                    return false;
+                }
+                double totalTime = std::chrono::duration<double, std::milli>(
+                    std::chrono::high_resolution_clock::now() - startTime).count();
+                stats_.sortTimeMs = 0.0;
+                stats_.renderTimeMs = totalTime;
+                stats_.totalTimeMs = totalTime;
+                stats_.visibleGaussians = stats_.totalGaussians;
+                stats_.culledGaussians = 0;
+                return true;
+            }
+
+            // Depth sort if enabled (the GPU sort only encodes here; its
+            // GPU time shows in the renderer timeline as "Sharp Sort")
             double sortTime = 0.0;
+            auto sortStart = std::chrono::high_resolution_clock::now();
             if (config_.enableDepthSort) {
-                auto sortStart = std::chrono::high_resolution_clock::now();
-                if (!depthSort(cloud, viewMatrix, cmdBuffer)) {
+                OF_PROFILE_SCOPE("SharpRenderer sort");
+                if (!depthSort(cloud, source, count, viewMatrix, cmdBuffer)) {
+                    return false;
+                }
+            } else {
+                previousOrderCount_ = 0;
+                if (!useCloudOrder(count)) {
                     return false;
                 }
-                auto sortEnd = std::chrono::high_resolution_clock::now();
-                sortTime = std::chrono::duration<double, std::milli>(sortEnd - sortStart).count();
             }
+            auto sortEnd = std::chrono::high_resolution_clock::now();
+            sortTime = std::chrono::duration<double, std::milli>(sortEnd - sortStart).count();
 
             // Render Gaussians
             auto renderStart = std::chrono::high_resolution_clock::now();
-            if (!renderGaussians(targetTexture, cmdBuffer)) {
+            OF_PROFILE_SCOPE("SharpRenderer render");
+            if (!prepareSHColors(count, cmdBuffer) || !renderGaussians(targetTexture, cmdBuffer, count)) {
                 return false;
             }
             auto renderEnd = std::chrono::high_resolution_clock::now();
@@ -199,19 +561,15 @@ public:
             stats_.sortTimeMs = sortTime;
             stats_.renderTimeMs = renderTime;
             stats_.totalTimeMs = totalTime;
-            // DEFERRED: Frustum culling optimization
-            //
-            // Rationale:
-            // - Requires camera frustum planes extraction
-            // - Per-Gaussian AABB or sphere-frustum intersection test
-            // - Sort-then-render approach means GPU handles depth culling efficiently
-            // - CPU-side frustum culling adds complexity for minimal gain in most scenes
-            // - Deferred until profiling shows sort or render performance bottleneck
-            //
-            // Current: All Gaussians are visible (GPU depth test handles occlusion)
-            stats_.visibleGaussians = stats_.totalGaussians;
-            stats_.culledGaussians = 0;
-            stats_.culledGaussians = 0;
+            // Culled sorts learn their survivor count on the GPU; report the
+            // latest completed frame's
+            if (drawIndirect_) {
+                stats_.visibleGaussians = std::min(visibleCount_->load(std::memory_order_relaxed),
+                                                   stats_.totalGaussians);
+            } else {
+                stats_.visibleGaussians = stats_.totalGaussians;
+            }
+            stats_.culledGaussians = stats_.totalGaussians - stats_.visibleGaussians;
 
             return true;
         }
@@ -289,10 +647,116 @@ private:
                 return false;
             }
 
+            // Colors for the vertex shader, evaluated once per splat
+            id<MTLFunction> shFunction = [library newFunctionWithName:@"gaussianEvaluateSH"];
+            shColorPipeline_ = shFunction ? [device_ newComputePipelineStateWithFunction:shFunction error:&error] : nil;
+            if (!shColorPipeline_) {
+                NSLog(@"[SharpRenderer] Error: Failed to create SH color pipeline");
+                renderPipelineState_ = nil;
+                return false;
+            }
+
+            // Variant for compressed clouds (optional; they are expanded without it)
+            id<MTLFunction> compressedVertex = compressedFunction(library, @"gaussianSplattingVertex");
+            if (compressedVertex) {
+                pipelineDescriptor.vertexFunction = compressedVertex;
+                compressedRenderPipelineState_ = [device_ newRenderPipelineStateWithDescriptor:pipelineDescriptor
+                                                                                         error:&error];
+                compressedSHColorPipeline_ = compressedPipeline(library, @"gaussianEvaluateSH");
+            }
+
+            createViewPipelines(library, pipelineDescriptor);
+
+            // Expands clouds from their own GPU copy (optional; uploaded from the CPU without it)
+            id<MTLFunction> expandFunction = [library newFunctionWithName:@"gaussianCloudExpand"];
+            if (expandFunction) {
+                cloudExpandPipeline_ = [device_ newComputePipelineStateWithFunction:expandFunction error:&error];
+            }
+
+            // Places scene batch splats in the world (scenes only)
+            id<MTLFunction> sceneFunction = [library newFunctionWithName:@"gaussianSceneTransform"];
+            if (sceneFunction) {
+                sceneTransformPipeline_ = [device_ newComputePipelineStateWithFunction:sceneFunction error:&error];
+            }
+
             return true;
         }
     }
 
+    // Multi-view variants of the quad pipeline (optional; multi-view
+    // renders fail without them). The amplified ones draw kViewAmplification
+    // views per draw and need GPU support.
+    void createViewPipelines(id<MTLLibrary> library, MTLRenderPipelineDescriptor* descriptor) {
+        NSError* error = nil;
+        id<MTLFunction> fragmentFunction = [library newFunctionWithName:@"gaussianSplattingFragmentViews"];
+        if (!fragmentFunction) {
+            return;
+        }
+        descriptor.fragmentFunction = fragmentFunction;
+        descriptor.inputPrimitiveTopology = MTLPrimitiveTopologyClassTriangle;    // Layered rendering
+        auto pipeline = [&](id<MTLFunction> vertexFunction) -> id<MTLRenderPipelineState> {
+            if (!vertexFunction) {
+                return nil;
+            }
+            descriptor.vertexFunction = vertexFunction;
+            return [device_ newRenderPipelineStateWithDescriptor:descriptor error:&error];
+        };
+
+        descriptor.label = @"Gaussian Splatting Views Pipeline";
+        viewsPipelineState_ = pipeline([library newFunctionWithName:@"gaussianSplattingVertexViews"]);
+        compressedViewsPipelineState_ = pipeline(compressedFunction(library, @"gaussianSplattingVertexViews"));
+        if (viewsPipelineState_ && [device_ supportsVertexAmplificationCount:kViewAmplification]) {
+            descriptor.label = @"Gaussian Splatting Amplified Pipeline";
+            descriptor.maxVertexAmplificationCount = kViewAmplification;
+            amplifiedPipelineState_ = pipeline([library newFunctionWithName:@"gaussianSplattingVertexAmplified"]);
+            compressedAmplifiedPipelineState_ = pipeline(compressedFunction(library, @"gaussianSplattingVertexAmplified"));
+        }
+    }
+
+    // Shader variant reading GaussianCloud's compressed buffer
+    // (function constant 0 in GaussianCompressed.h)
+    id<MTLFunction> compressedFunction(id<MTLLibrary> library, NSString* name) {
+        MTLFunctionConstantValues* values = [[MTLFunctionConstantValues alloc] init];
+        bool compressed = true;
+        [values setConstantValue:&compressed type:MTLDataTypeBool atIndex:0];
+        NSError* error = nil;
+        return [library newFunctionWithName:name constantValues:values error:&error];
+    }
+
+    id<MTLComputePipelineState> compressedPipeline(id<MTLLibrary> library, NSString* name) {
+        id<MTLFunction> function = compressedFunction(library, name);
+        NSError* error = nil;
+        return function ? [device_ newComputePipelineStateWithFunction:function error:&error] : nil;
+    }
+
+    // Every shader that reads Gaussians has its compressed variant
+    bool canReadCompressed() const {
+        return compressedRenderPipelineState_ && compressedSHColorPipeline_ &&
+               (!viewsPipelineState_ || compressedViewsPipelineState_) &&
+               (!projectDepthPipeline_ || compressedProjectDepthPipeline_) &&
+               (!reprojectDepthPipeline_ || compressedReprojectDepthPipeline_) &&
+               (!cullProjectPipeline_ || compressedCullProjectPipeline_) &&
+               (!tilePreprocessPipeline_ || compressedTilePreprocessPipeline_);
+    }
+
+    // The pipeline for this frame's Gaussian layout
+    id<MTLComputePipelineState> gaussianPipeline(id<MTLComputePipelineState> full,
+                                                 id<MTLComputePipelineState> compressed) const {
+        return compressedInput_ ? compressed : full;
+    }
+
+    // Bind this frame's Gaussians: the upload buffer at 0, or the sections
+    // of the cloud's compressed buffer
+    void bindGaussians(id<MTLComputeCommandEncoder> encoder) {
+        if (compressedInput_) {
+            [encoder setBuffer:compressedBuffer_ offset:compressedLayout_.splatOffset atIndex:kCompressedSplatsIndex];
+            [encoder setBuffer:compressedBuffer_ offset:compressedLayout_.chunkOffset atIndex:kCompressedChunksIndex];
+            [encoder setBuffer:compressedBuffer_ offset:compressedLayout_.codebookOffset atIndex:kCompressedCodebookIndex];
+        } else {
+            [encoder setBuffer:gaussianBuffer_ offset:0 atIndex:0];
+        }
+    }
+
     bool createSortPipeline() {
         @autoreleasepool {
             NSError* error = nil;
@@ -303,21 +767,105 @@ private:
                 return false;
             }
 
-            // Load GPU depth sort shader (Phase 25.5)
-            id<MTLFunction> sortFunction = [library newFunctionWithName:@"bitonicSort"];
+            // GPU depth keys and radix sort (GaussianSort.metal)
+            id<MTLFunction> projectFunction = [library newFunctionWithName:@"gaussianProjectDepth"];
+            id<MTLFunction> histogramFunction = [library newFunctionWithName:@"gaussianRadixHistogram"];
+            id<MTLFunction> scanFunction = [library newFunctionWithName:@"gaussianRadixScan"];
+            id<MTLFunction> scatterFunction = [library newFunctionWithName:@"gaussianRadixScatter"];
 
-            if (!sortFunction) {
-                NSLog(@"[SharpRenderer] Warning: GPU sort shader not found, using CPU fallback");
+            if (!projectFunction || !histogramFunction || !scanFunction || !scatterFunction) {
+                NSLog(@"[SharpRenderer] Warning: GPU sort shaders not found, using CPU fallback");
                 // CPU sorting fallback is still available
                 return true;
             }
 
-            sortComputePipelineState_ = [device_ newComputePipelineStateWithFunction:sortFunction
-                                                                                error:&error];
-            if (!sortComputePipelineState_) {
+            projectDepthPipeline_ = [device_ newComputePipelineStateWithFunction:projectFunction error:&error];
+            compressedProjectDepthPipeline_ = compressedPipeline(library, @"gaussianProjectDepth");
+            radixHistogramPipeline_ = [device_ newComputePipelineStateWithFunction:histogramFunction error:&error];
+            radixScanPipeline_ = [device_ newComputePipelineStateWithFunction:scanFunction error:&error];
+            radixScatterPipeline_ = [device_ newComputePipelineStateWithFunction:scatterFunction error:&error];
+            if (!projectDepthPipeline_ || !radixHistogramPipeline_ || !radixScanPipeline_ || !radixScatterPipeline_) {
+                NSLog(@"[SharpRenderer] Error: Failed to create GPU sort pipelines: %@", error.localizedDescription);
                 return false;
             }
 
+            // Incremental re-sort (optional; every frame sorts fully without it)
+            id<MTLFunction> reprojectFunction = [library newFunctionWithName:@"gaussianReprojectDepth"];
+            id<MTLFunction> localSortFunction = [library newFunctionWithName:@"gaussianLocalSort"];
+            if (reprojectFunction && localSortFunction) {
+                reprojectDepthPipeline_ = [device_ newComputePipelineStateWithFunction:reprojectFunction error:&error];
+                localSortPipeline_ = [device_ newComputePipelineStateWithFunction:localSortFunction error:&error];
+                compressedReprojectDepthPipeline_ = compressedPipeline(library, @"gaussianReprojectDepth");
+            }
+
+            // Culling before the sort (optional; everything is sorted without it)
+            id<MTLFunction> cullFunction = [library newFunctionWithName:@"gaussianCullProject"];
+            id<MTLFunction> cullSetupFunction = [library newFunctionWithName:@"gaussianCullSetup"];
+            if (cullFunction && cullSetupFunction) {
+                cullProjectPipeline_ = [device_ newComputePipelineStateWithFunction:cullFunction error:&error];
+                cullSetupPipeline_ = [device_ newComputePipelineStateWithFunction:cullSetupFunction error:&error];
+                if (!cullProjectPipeline_ || !cullSetupPipeline_) {
+                    cullProjectPipeline_ = nil;
+                }
+                compressedCullProjectPipeline_ = compressedPipeline(library, @"gaussianCullProject");
+            }
+
+            return true;
+        }
+    }
+
+    void createTilePipelines() {
+        @autoreleasepool {
+            NSError* error = nil;
+            id<MTLLibrary> library = [device_ newDefaultLibrary];
+            if (!library || !radixScatterPipeline_) {
+                return;
+            }
+
+            auto make = [&](NSString* name) -> id<MTLComputePipelineState> {
+                id<MTLFunction> function = [library newFunctionWithName:name];
+                return function ? [device_ newComputePipelineStateWithFunction:function error:&error] : nil;
+            };
+            tilePreprocessPipeline_ = make(@"gaussianTilePreprocess");
+            compressedTilePreprocessPipeline_ = compressedPipeline(library, @"gaussianTilePreprocess");
+            tileSetupPipeline_ = make(@"gaussianTileSetup");
+            tileDuplicatePipeline_ = make(@"gaussianTileDuplicate");
+            tileRangesPipeline_ = make(@"gaussianTileRanges");
+            tileRenderPipeline_ = make(@"gaussianTileRender");
+            if (!tilePreprocessPipeline_ || !tileSetupPipeline_ || !tileDuplicatePipeline_ ||
+                !tileRangesPipeline_ || !tileRenderPipeline_) {
+                NSLog(@"[SharpRenderer] Warning: Tile rasterizer unavailable, drawing quads");
+                tileRenderPipeline_ = nil;
+            }
+        }
+    }
+
+    // Composites the tile output over targets of one pixel format
+    bool createTileCompositePipeline(MTLPixelFormat format) {
+        if (tileCompositePipeline_ && tileCompositeFormat_ == format) {
+            return true;
+        }
+        @autoreleasepool {
+            id<MTLLibrary> library = [device_ newDefaultLibrary];
+            MTLRenderPipelineDescriptor* desc = [[MTLRenderPipelineDescriptor alloc] init];
+            desc.label = @"Gaussian Tile Composite";
+            desc.vertexFunction = [library newFunctionWithName:@"gaussianTileCompositeVertex"];
+            desc.fragmentFunction = [library newFunctionWithName:@"gaussianTileCompositeFragment"];
+            desc.colorAttachments[0].pixelFormat = format;
+            desc.colorAttachments[0].blendingEnabled = YES;
+            desc.colorAttachments[0].sourceRGBBlendFactor = MTLBlendFactorOne;
+            desc.colorAttachments[0].sourceAlphaBlendFactor = MTLBlendFactorOne;
+            desc.colorAttachments[0].destinationRGBBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
+            desc.colorAttachments[0].destinationAlphaBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
+
+            NSError* error = nil;
+            tileCompositePipeline_ = [device_ newRenderPipelineStateWithDescriptor:desc error:&error];
+            if (!tileCompositePipeline_) {
+                NSLog(@"[SharpRenderer] Error: Failed to create tile composite pipeline: %@",
+                      error.localizedDescription);
+                return false;
+            }
+            tileCompositeFormat_ = format;
             return true;
         }
     }
@@ -326,22 +874,72 @@ private:
     // Data Upload
     // ========================================================================
 
+    bool reserveGaussianBuffer(size_t count) {
+        size_t bufferSize = count * sizeof(GaussianVertex);
+        if (!gaussianBuffer_ || gaussianBuffer_.length < bufferSize) {
+            gaussianBuffer_ = render::metal::makeTrackedBuffer(device_, bufferSize, MTLResourceStorageModeShared,
+                                                               oflike::ofGpuMemoryCategory::Splats, "Gaussian Data");
+            if (!gaussianBuffer_) {
+                return false;
+            }
+            bufferContents_ = BufferContents::None;
+            ++contentsVersion_;
+        }
+        return true;
+    }
+
+    // Fill the upload buffer from the cloud's GPU copy in the frame's
+    // command buffer, skipped while that copy is unchanged since the last
+    // expansion. False when the cloud has no current GPU copy.
+    bool expandCloudBuffer(const GaussianCloud& cloud, id<MTLCommandBuffer> commandBuffer) {
+        const size_t count = cloud.size();
+        id<MTLBuffer> source = (__bridge id<MTLBuffer>)cloud.getMetalBuffer();
+        if (!cloudExpandPipeline_ || cloud.isCompressed() || cloud.isBufferDirty() || cloud.isLoading() ||
+            !source || cloud.getBufferSize() < count * sizeof(Gaussian)) {
+            return false;
+        }
+        if (bufferContents_ == BufferContents::Cloud && expandedCloud_ == &cloud &&
+            expandedGeneration_ == cloud.getBufferGeneration() && expandedCount_ == count) {
+            return true;
+        }
+        if (!reserveGaussianBuffer(count)) {
+            return false;
+        }
+
+        @autoreleasepool {
+            id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoder];
+            encoder.label = @"Gaussian Cloud Expand";
+            const uint32_t expandCount = static_cast<uint32_t>(count);
+            [encoder setComputePipelineState:cloudExpandPipeline_];
+            [encoder setBuffer:source offset:0 atIndex:0];
+            [encoder setBuffer:gaussianBuffer_ offset:0 atIndex:1];
+            [encoder setBytes:&expandCount length:sizeof(expandCount) atIndex:2];
+            const NSUInteger width = cloudExpandPipeline_.threadExecutionWidth;
+            [encoder dispatchThreadgroups:MTLSizeMake((count + width - 1) / width, 1, 1)
+                    threadsPerThreadgroup:MTLSizeMake(width, 1, 1)];
+            [encoder endEncoding];
+        }
+
+        bufferContents_ = BufferContents::Cloud;
+        ++contentsVersion_;
+        expandedCloud_ = &cloud;
+        expandedGeneration_ = cloud.getBufferGeneration();
+        expandedCount_ = count;
+        return true;
+    }
+
     bool uploadGaussianData(const GaussianCloud& cloud) {
         @autoreleasepool {
             size_t count = cloud.size();
             if (count == 0) {
                 return true;
             }
+            bufferContents_ = BufferContents::None;     // Rewritten from the CPU every frame
+            ++contentsVersion_;
 
             // Allocate buffer if needed
-            size_t bufferSize = count * sizeof(GaussianVertex);
-            if (!gaussianBuffer_ || gaussianBuffer_.length < bufferSize) {
-                gaussianBuffer_ = [device_ newBufferWithLength:bufferSize
-                                                       options:MTLResourceStorageModeShared];
-                if (!gaussianBuffer_) {
-                    return false;
-                }
-                gaussianBuffer_.label = @"Gaussian Data";
+            if (!reserveGaussianBuffer(count)) {
+                return false;
             }
 
             // Copy Gaussian data to buffer
@@ -349,169 +947,755 @@ private:
             const auto& gaussians = cloud.getGaussians();
 
             for (size_t i = 0; i < count; ++i) {
-                const Gaussian& g = gaussians[i];
+                expandGaussian(gaussians[i], vertices[i]);
+            }
+
+            return true;
+        }
+    }
 
-                vertices[i].position = simd_make_float3(g.position.x, g.position.y, g.position.z);
-                vertices[i].scale = simd_make_float3(g.scale.x, g.scale.y, g.scale.z);
-                vertices[i].rotation = simd_make_float4(g.rotation.vector.x, g.rotation.vector.y,
-                                                        g.rotation.vector.z, g.rotation.vector.w);
-                vertices[i].opacity = g.opacity;
-                vertices[i].sh_dc = simd_make_float3(g.sh_dc.x, g.sh_dc.y, g.sh_dc.z);
+    bool uploadUniforms(const GaussianUniforms& uniforms) {
+        // Encoded inline with setVertexBytes, so frames still in flight keep
+        // their own camera while the next one is encoded
+        uniforms_ = uniforms;
+        return true;
+    }
+
+    // ========================================================================
+    // Scene Batches
+    // ========================================================================
+
+    // Mirrors ObjectTransform in GaussianSplatting.metal
+    struct ObjectTransform {
+        simd_float4x4 matrix;
+        simd_float4 rotation;
+        simd_float3 scale;
+        float opacity;
+    };
+
+    // How the batch's object-space splats were gathered
+    struct SceneEntry {
+        const GaussianCloud* cloud;
+        size_t count;
+        uint64_t generation;
+
+        bool operator==(const SceneEntry& other) const {
+            return cloud == other.cloud && count == other.count && generation == other.generation;
+        }
+    };
+
+    // Split like GaussianCloud::transform: column lengths scale the
+    // splats, the normalized columns rotate them
+    static ObjectTransform objectTransform(const RenderInstance& instance) {
+        const simd_float4x4& m = instance.transform;
+        ObjectTransform transform;
+        transform.matrix = m;
+        transform.scale = simd_make_float3(simd_length(m.columns[0].xyz), simd_length(m.columns[1].xyz),
+                                           simd_length(m.columns[2].xyz));
+        const simd_float3x3 rotation = simd_matrix(m.columns[0].xyz / transform.scale.x,
+                                                   m.columns[1].xyz / transform.scale.y,
+                                                   m.columns[2].xyz / transform.scale.z);
+        transform.rotation = simd_quaternion(rotation).vector;
+        transform.opacity = instance.visible ? 1.0f : 0.0f;
+        return transform;
+    }
 
-                // Copy SH coefficients
-                std::memcpy(vertices[i].sh_coefficients, g.sh_coefficients.data(),
-                           sizeof(float) * 45);
+    // Fill gaussianBuffer_ with the scene's world-space splats. Hidden
+    // objects stay in the batch at zero opacity, so showing them is a
+    // transform change too. A cloud edited since the last gather (or
+    // never uploaded) regathers the batch every frame.
+    bool prepareScene(const std::vector<RenderInstance>& instances, id<MTLCommandBuffer> commandBuffer,
+                      size_t& count) {
+        std::vector<SceneEntry> entries;
+        std::vector<ObjectTransform> transforms;
+        bool edited = false;
+        count = 0;
+        for (const RenderInstance& instance : instances) {
+            if (!instance.cloud || instance.cloud->size() == 0) {
+                continue;
             }
+            entries.push_back({instance.cloud, instance.cloud->size(), instance.cloud->getBufferGeneration()});
+            transforms.push_back(objectTransform(instance));
+            edited = edited || instance.cloud->isBufferDirty() || instance.cloud->isLoading();
+            count += instance.cloud->size();
+        }
+        if (count == 0) {
+            return true;
+        }
+        if (!sceneTransformPipeline_) {
+            NSLog(@"[SharpRenderer] Error: Scene transform kernel not found");
+            return false;
+        }
 
+        const bool regather = edited || entries != sceneEntries_ || !sceneLocal_;
+        if (regather && !gatherScene(entries, count, commandBuffer)) {
+            return false;
+        }
+        const bool moved = transforms.size() != sceneTransforms_.size() ||
+                           std::memcmp(transforms.data(), sceneTransforms_.data(),
+                                       transforms.size() * sizeof(ObjectTransform)) != 0;
+        if (!regather && !moved && bufferContents_ == BufferContents::Scene) {
             return true;
         }
+        if (!reserveGaussianBuffer(count)) {
+            return false;
+        }
+
+        @autoreleasepool {
+            // Frames in flight keep their own transforms
+            id<MTLBuffer> transformBuffer = [device_ newBufferWithBytes:transforms.data()
+                                                                 length:transforms.size() * sizeof(ObjectTransform)
+                                                                options:MTLResourceStorageModeShared];
+            if (!transformBuffer) {
+                return false;
+            }
+            id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoder];
+            encoder.label = @"Scene Transform";
+            const uint32_t transformCount = static_cast<uint32_t>(count);
+            [encoder setComputePipelineState:sceneTransformPipeline_];
+            [encoder setBuffer:sceneLocal_ offset:0 atIndex:0];
+            [encoder setBuffer:gaussianBuffer_ offset:0 atIndex:1];
+            [encoder setBuffer:sceneObjectIDs_ offset:0 atIndex:2];
+            [encoder setBuffer:transformBuffer offset:0 atIndex:3];
+            [encoder setBytes:&transformCount length:sizeof(transformCount) atIndex:4];
+            const NSUInteger width = sceneTransformPipeline_.threadExecutionWidth;
+            [encoder dispatchThreadgroups:MTLSizeMake((count + width - 1) / width, 1, 1)
+                    threadsPerThreadgroup:MTLSizeMake(width, 1, 1)];
+            [encoder endEncoding];
+        }
+
+        sceneTransforms_ = std::move(transforms);
+        bufferContents_ = BufferContents::Scene;
+        ++contentsVersion_;
+        previousOrderCount_ = 0;    // Objects may have moved far
+        return true;
     }
 
-    bool uploadUniforms(const GaussianUniforms& uniforms) {
+    // Object-space splats of every entry, back to back, and the entry
+    // each one belongs to. New buffers each time: frames in flight still
+    // read the old ones.
+    bool gatherScene(const std::vector<SceneEntry>& entries, size_t count, id<MTLCommandBuffer> commandBuffer) {
         @autoreleasepool {
-            size_t bufferSize = sizeof(GaussianUniforms);
-            if (!uniformBuffer_ || uniformBuffer_.length < bufferSize) {
-                uniformBuffer_ = [device_ newBufferWithLength:bufferSize
-                                                      options:MTLResourceStorageModeShared];
-                if (!uniformBuffer_) {
+            id<MTLBuffer> local = [device_ newBufferWithLength:count * sizeof(GaussianVertex)
+                                                       options:MTLResourceStorageModeShared];
+            id<MTLBuffer> objectIDs = [device_ newBufferWithLength:count * sizeof(uint32_t)
+                                                           options:MTLResourceStorageModeShared];
+            if (!local || !objectIDs) {
+                return false;
+            }
+            local.label = @"Scene Splats";
+            objectIDs.label = @"Scene Object IDs";
+
+            GaussianVertex* vertices = static_cast<GaussianVertex*>(local.contents);
+            uint32_t* ids = static_cast<uint32_t*>(objectIDs.contents);
+            size_t offset = 0;
+            for (size_t e = 0; e < entries.size(); ++e) {
+                const GaussianCloud& cloud = *entries[e].cloud;
+                const size_t n = entries[e].count;
+                std::fill(ids + offset, ids + offset + n, static_cast<uint32_t>(e));
+
+                // Clouds with a current GPU copy expand on the GPU
+                id<MTLBuffer> source = (__bridge id<MTLBuffer>)cloud.getMetalBuffer();
+                if (cloudExpandPipeline_ && !cloud.isCompressed() && !cloud.isBufferDirty() && !cloud.isLoading() &&
+                    source && cloud.getBufferSize() >= n * sizeof(Gaussian)) {
+                    id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoder];
+                    encoder.label = @"Scene Expand";
+                    const uint32_t expandCount = static_cast<uint32_t>(n);
+                    [encoder setComputePipelineState:cloudExpandPipeline_];
+                    [encoder setBuffer:source offset:0 atIndex:0];
+                    [encoder setBuffer:local offset:offset * sizeof(GaussianVertex) atIndex:1];
+                    [encoder setBytes:&expandCount length:sizeof(expandCount) atIndex:2];
+                    const NSUInteger width = cloudExpandPipeline_.threadExecutionWidth;
+                    [encoder dispatchThreadgroups:MTLSizeMake((n + width - 1) / width, 1, 1)
+                            threadsPerThreadgroup:MTLSizeMake(width, 1, 1)];
+                    [encoder endEncoding];
+                } else {
+                    const auto& gaussians = cloud.getGaussians();
+                    for (size_t i = 0; i < n; ++i) {
+                        expandGaussian(gaussians[i], vertices[offset + i]);
+                    }
+                }
+                offset += n;
+            }
+
+            sceneLocal_ = local;
+            sceneObjectIDs_ = objectIDs;
+            sceneEntries_ = entries;
+            sceneTransforms_.clear();
+            return true;
+        }
+    }
+
+    // ========================================================================
+    // Level of Detail
+    // ========================================================================
+
+    // LOD frames are assembled on the GPU, so they need the GPU sort
+    bool usesLOD(const GaussianCloud& cloud) const {
+        return config_.enableLOD && cloud.hasLOD() && config_.lodSplatBudget > 0 &&
+               (radixScatterPipeline_ || !config_.enableDepthSort);
+    }
+
+    static void expandGaussian(const Gaussian& g, GaussianVertex& vertex) {
+        vertex.position = simd_make_float3(g.position.x, g.position.y, g.position.z);
+        vertex.scale = simd_make_float3(g.scale.x, g.scale.y, g.scale.z);
+        vertex.rotation = simd_make_float4(g.rotation.vector.x, g.rotation.vector.y,
+                                           g.rotation.vector.z, g.rotation.vector.w);
+        vertex.opacity = g.opacity;
+        vertex.sh_dc = simd_make_float3(g.sh_dc.x, g.sh_dc.y, g.sh_dc.z);
+
+        // Copy SH coefficients (RGB per coefficient)
+        for (size_t c = 0; c < g.sh_rest.size(); ++c) {
+            vertex.sh_coefficients[c * 3 + 0] = g.sh_rest[c].x;
+            vertex.sh_coefficients[c * 3 + 1] = g.sh_rest[c].y;
+            vertex.sh_coefficients[c * 3 + 2] = g.sh_rest[c].z;
+        }
+    }
+
+    // Start over when the tree or the cache size changes. One page holds
+    // any node's splats.
+    bool resetLODCache(const GaussianCloud& cloud) {
+        const auto& nodes = cloud.getLODNodes();
+        size_t pageSize = 1;
+        for (const LODNode& node : nodes) {
+            pageSize = std::max<size_t>(pageSize, node.count);
+        }
+        const size_t pages = std::max<size_t>(1, config_.lodCacheSplats / pageSize);
+
+        lodCloud_ = &cloud;
+        lodGeneration_ = cloud.getLODGeneration();
+        lodCacheSplats_ = config_.lodCacheSplats;
+        lodPageSize_ = pageSize;
+        nodePage_.assign(nodes.size(), -1);
+        pageNode_.assign(pages, -1);
+        pageLastUsed_.assign(pages, 0);
+        previousSelection_.clear();
+
+        lodCache_ = render::metal::makeTrackedBuffer(device_, pages * pageSize * sizeof(GaussianVertex),
+                                                     MTLResourceStorageModeShared, oflike::ofGpuMemoryCategory::Splats,
+                                                     "LOD Node Cache");
+        if (!lodCache_) {
+            NSLog(@"[SharpRenderer] Error: Failed to create the LOD node cache");
+            nodePage_.clear();
+            return false;
+        }
+        lodCache_.label = @"LOD Node Cache";
+        return true;
+    }
+
+    // Copy a node's splats into a free page, or the least recently used
+    // one no frame in flight still reads
+    bool cacheLODNode(const GaussianCloud& cloud, int32_t index) {
+        if (nodePage_[index] >= 0) {
+            pageLastUsed_[nodePage_[index]] = lodFrame_;    // Not evicted while this frame selects
+            return true;
+        }
+        int32_t page = -1;
+        for (size_t p = 0; p < pageNode_.size(); ++p) {
+            if (pageNode_[p] < 0) {
+                page = static_cast<int32_t>(p);
+                break;
+            }
+            if (pageLastUsed_[p] + kLODFramesInFlight <= lodFrame_ &&
+                (page < 0 || pageLastUsed_[p] < pageLastUsed_[page])) {
+                page = static_cast<int32_t>(p);
+            }
+        }
+        if (page < 0) {
+            return false;
+        }
+        if (pageNode_[page] >= 0) {
+            nodePage_[pageNode_[page]] = -1;
+        }
+
+        const LODNode& node = cloud.getLODNodes()[index];
+        const Gaussian* source = (node.leaf ? cloud.getGaussians() : cloud.getLODGaussians()).data() + node.first;
+        GaussianVertex* vertices = static_cast<GaussianVertex*>(lodCache_.contents) + page * lodPageSize_;
+        for (uint32_t i = 0; i < node.count; ++i) {
+            expandGaussian(source[i], vertices[i]);
+        }
+        nodePage_[index] = page;
+        pageNode_[page] = index;
+        pageLastUsed_[page] = lodFrame_;
+        stats_.lodUploads += node.count;
+        return true;
+    }
+
+    // Pick the nodes to draw: the visible node with the largest
+    // screen-space error is replaced by its children first, until every
+    // node is under the threshold, the budget is spent or this frame's
+    // uploads are. Returns the splats selected.
+    size_t selectLODNodes(const GaussianCloud& cloud, const simd_float4x4& view,
+                          const simd_float4x4& projection, float viewportHeight) {
+        if (lodCloud_ != &cloud || lodGeneration_ != cloud.getLODGeneration() ||
+            lodCacheSplats_ != config_.lodCacheSplats || nodePage_.size() != cloud.getLODNodes().size()) {
+            if (!resetLODCache(cloud)) {
+                return 0;
+            }
+        }
+        lodFrame_++;
+        lodSelection_.clear();
+
+        // Frustum planes (Metal clip space, z in 0..w)
+        const simd_float4x4 viewProjection = simd_mul(projection, view);
+        const simd_float4x4 rows = simd_transpose(viewProjection);
+        simd_float4 planes[6] = {
+            rows.columns[3] + rows.columns[0], rows.columns[3] - rows.columns[0],
+            rows.columns[3] + rows.columns[1], rows.columns[3] - rows.columns[1],
+            rows.columns[2], rows.columns[3] - rows.columns[2],
+        };
+        for (simd_float4& plane : planes) {
+            plane /= simd_length(plane.xyz);
+        }
+        const simd_float3 camera = simd_inverse(view).columns[3].xyz;
+        const float pixelsPerUnit = 0.5f * viewportHeight * projection.columns[1][1];
+
+        const auto& nodes = cloud.getLODNodes();
+        auto visible = [&](const LODNode& node) {
+            const simd_float3 center = (node.boundsMin + node.boundsMax) * 0.5f;
+            const float radius = simd_length(node.boundsMax - node.boundsMin) * 0.5f;
+            for (const simd_float4& plane : planes) {
+                if (simd_dot(plane.xyz, center) + plane.w < -radius) {
                     return false;
                 }
-                uniformBuffer_.label = @"Gaussian Uniforms";
             }
+            return true;
+        };
+        auto screenError = [&](const LODNode& node) {
+            const simd_float3 nearest = simd_clamp(camera, node.boundsMin, node.boundsMax);
+            const float distance = simd_distance(camera, nearest);
+            return distance > 1e-4f ? node.error * pixelsPerUnit / distance : INFINITY;
+        };
+
+        if (!visible(nodes[0]) || !cacheLODNode(cloud, 0)) {
+            return 0;
+        }
+        std::priority_queue<std::pair<float, int32_t>> open;
+        open.push({screenError(nodes[0]), 0});
+        size_t total = nodes[0].count;
+        size_t uploads = 0;
+        std::vector<int32_t> children;
+
+        while (!open.empty()) {
+            const auto [error, index] = open.top();
+            open.pop();
+            const LODNode& node = nodes[index];
+
+            bool refine = !node.leaf && error > config_.lodErrorThreshold;
+            size_t childSplats = 0;
+            size_t childUploads = 0;
+            children.clear();
+            if (refine) {
+                for (int32_t child : node.children) {
+                    if (child >= 0 && visible(nodes[child])) {
+                        children.push_back(child);
+                        childSplats += nodes[child].count;
+                        childUploads += nodePage_[child] < 0 ? nodes[child].count : 0;
+                    }
+                }
+                refine = total - node.count + childSplats <= config_.lodSplatBudget &&
+                         uploads + childUploads <= config_.lodUploadBudget;
+            }
+            for (size_t c = 0; refine && c < children.size(); ++c) {
+                refine = cacheLODNode(cloud, children[c]);
+            }
+            if (refine) {
+                total = total - node.count + childSplats;
+                uploads += childUploads;
+                for (int32_t child : children) {
+                    open.push({screenError(nodes[child]), child});
+                }
+            } else {
+                lodSelection_.push_back(index);
+            }
+        }
 
-            std::memcpy(uniformBuffer_.contents, &uniforms, bufferSize);
+        stats_.lodNodes = static_cast<uint32_t>(lodSelection_.size());
+        return total;
+    }
+
+    // Gather the selected pages into the upload buffer in the frame's
+    // command buffer, unless the selection is unchanged
+    bool gatherLODNodes(size_t count, id<MTLCommandBuffer> commandBuffer) {
+        std::sort(lodSelection_.begin(), lodSelection_.end());
+        if (bufferContents_ == BufferContents::LOD && lodSelection_ == previousSelection_) {
             return true;
         }
+        if (!reserveGaussianBuffer(count)) {
+            return false;
+        }
+
+        @autoreleasepool {
+            id<MTLBlitCommandEncoder> blit = [commandBuffer blitCommandEncoder];
+            blit.label = @"Gather LOD Nodes";
+            const auto& nodes = lodCloud_->getLODNodes();
+            size_t offset = 0;
+            for (int32_t index : lodSelection_) {
+                const size_t bytes = nodes[index].count * sizeof(GaussianVertex);
+                [blit copyFromBuffer:lodCache_
+                        sourceOffset:nodePage_[index] * lodPageSize_ * sizeof(GaussianVertex)
+                            toBuffer:gaussianBuffer_
+                   destinationOffset:offset
+                                size:bytes];
+                offset += bytes;
+            }
+            [blit endEncoding];
+        }
+
+        previousSelection_ = lodSelection_;
+        previousOrderCount_ = 0;        // Indices now name different splats
+        bufferContents_ = BufferContents::LOD;
+        ++contentsVersion_;
+        return true;
     }
 
     // ========================================================================
     // Depth Sorting
     // ========================================================================
 
-    bool depthSort(const GaussianCloud& cloud,
+    // Time a pass in the renderer's GPU frame timeline (no-op without one)
+    static void attachTimelineTimestamps(void* passDescriptor, const char* name) {
+        render::IRenderer* renderer = ::Context::instance().renderer();
+        if (renderer) {
+            renderer->attachGPUTimestamps(passDescriptor, name);
+        }
+    }
+
+    // count: the cloud's size, or the LOD selection's or scene's (GPU sort
+    // only; without it those draw in upload order)
+    bool depthSort(const GaussianCloud* cloud,
+                   const void* source,
+                   size_t count,
                    const oflike::ofMatrix4x4& viewMatrix,
                    id<MTLCommandBuffer> commandBuffer) {
         @autoreleasepool {
-            size_t count = cloud.size();
             if (count == 0) {
                 return true;
             }
 
+            const bool gpu = radixScatterPipeline_ != nil;
+            if (!gpu && !cloud) {
+                previousOrderCount_ = 0;
+                return useCloudOrder(count);
+            }
+            const bool incremental = useIncrementalSort(source, count, toSimdMatrix(viewMatrix), gpu);
+
             // Use CPU-based sorting as fallback
-            // GPU sorting available if compute shader loaded (Phase 25.5)
-            if (sortComputePipelineState_) {
-                return depthSortGPU(cloud, viewMatrix);
+            // GPU sorting available if compute shaders loaded
+            const bool sorted = gpu ? depthSortGPU(count, viewMatrix, commandBuffer, incremental)
+                                    : depthSortCPU(*cloud, viewMatrix, incremental);
+            if (!sorted) {
+                previousOrderCount_ = 0;
+                return false;
             }
-            return depthSortCPU(cloud, viewMatrix);
+            previousOrderCount_ = count;
+            previousOrderSource_ = source;
+            previousOrderOnGPU_ = gpu;
+            if (incremental) {
+                stats_.incrementalSorts++;
+                incrementalFrames_++;
+            } else {
+                stats_.fullSorts++;
+                incrementalFrames_ = 0;
+            }
+            return true;
+        }
+    }
+
+    // Whether this frame's order can start from the previous one: same
+    // cloud and sort path, a small camera turn and a recent full sort
+    bool useIncrementalSort(const void* source, size_t count, const simd_float4x4& view, bool gpu) {
+        const simd_float4x4 previous = previousView_;
+        previousView_ = view;
+        if (!config_.incrementalSort || previousOrderCount_ != count || previousOrderSource_ != source ||
+            previousOrderOnGPU_ != gpu || (gpu && (!localSortPipeline_ || cullsOnGPU())) || incrementalFrames_ + 1 >= std::max(1, config_.fullSortInterval)) {
+            return false;
+        }
+
+        // Rotation between the views: trace(Ra^T Rb) = 1 + 2 cos(angle)
+        float trace = 0.0f;
+        for (int i = 0; i < 3; ++i) {
+            trace += simd_dot(previous.columns[i].xyz, view.columns[i].xyz);
         }
+        const float angle = std::acos(std::clamp((trace - 1.0f) * 0.5f, -1.0f, 1.0f)) * 180.0f / float(M_PI);
+        return angle <= config_.fullSortAngle;
     }
 
-    // GPU-based bitonic sort for depth ordering
-    bool depthSortGPU(const GaussianCloud& cloud, const oflike::ofMatrix4x4& viewMatrix) {
+    // Survivors change every frame, so culled sorts always start over
+    bool cullsOnGPU() const {
+        return config_.enableFrustumCulling && cullProjectPipeline_ != nil;
+    }
+
+    // Ensure a private buffer holds at least size bytes
+    bool reservePrivate(id<MTLBuffer>& buffer, size_t size, NSString* label) {
+        if (buffer && buffer.length >= size) {
+            return true;
+        }
+        buffer = render::metal::makeTrackedBuffer(device_, size, MTLResourceStorageModePrivate, oflike::ofGpuMemoryCategory::Splats,
+                                                  label.UTF8String);
+        return buffer != nil;
+    }
+
+    // GPU-resident sort: depth keys are projected on the GPU and radix sorted
+    // in the frame's command buffer, so the CPU never touches the ordering
+    // and nothing waits for the GPU. The render pass reads the sorted values.
+    bool depthSortGPU(size_t count, const oflike::ofMatrix4x4& viewMatrix,
+                      id<MTLCommandBuffer> commandBuffer, bool incremental) {
         @autoreleasepool {
-            if (!sortComputePipelineState_) {
+            if (!commandBuffer) {
                 return false;
             }
 
-            size_t count = cloud.size();
-            if (count == 0) {
-                return true;
+            const uint32_t keyCount = static_cast<uint32_t>(count);
+            const uint32_t blockCount = (keyCount + kRadixBlock - 1) / kRadixBlock;
+            const size_t keyBytes = count * sizeof(uint32_t);
+            if (!reservePrivate(sortKeys_[0], keyBytes, @"Sort Keys") ||
+                !reservePrivate(sortKeys_[1], keyBytes, @"Sort Keys (Scratch)") ||
+                !reservePrivate(sortValues_[0], keyBytes, @"Sorted Indices") ||
+                !reservePrivate(sortValues_[1], keyBytes, @"Sorted Indices (Scratch)") ||
+                !reservePrivate(histogramBuffer_, size_t(blockCount) * kRadixBins * sizeof(uint32_t),
+                                @"Sort Histograms")) {
+                return false;
+            }
+            if (!incremental && cullsOnGPU()) {
+                return cullAndSortGPU(keyCount, commandBuffer);
             }
 
-            // Create sort data with depths
-            SortData* sortData = new SortData[count];
-            const auto& gaussians = cloud.getGaussians();
-            simd_float4x4 view = toSimdMatrix(viewMatrix);
-
-            for (size_t i = 0; i < count; ++i) {
-                const Gaussian& g = gaussians[i];
-                simd_float4 pos = simd_make_float4(g.position.x, g.position.y, g.position.z, 1.0f);
-                simd_float4 viewPos = simd_mul(view, pos);
-
-                sortData[i].index = static_cast<uint32_t>(i);
-                sortData[i].depth = viewPos.z;
+            MTLComputePassDescriptor* computePass = [MTLComputePassDescriptor computePassDescriptor];
+            attachTimelineTimestamps((__bridge void*)computePass, "Sharp Sort");
+            id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoderWithDescriptor:computePass];
+            if (!encoder) {
+                return false;
             }
+            encoder.label = incremental ? @"Gaussian Depth Re-sort" : @"Gaussian Depth Sort";
 
-            // Upload to GPU
-            size_t sortBufferSize = count * sizeof(SortData);
-            if (!sortDataBuffer_ || sortDataBuffer_.length < sortBufferSize) {
-                sortDataBuffer_ = [device_ newBufferWithLength:sortBufferSize
-                                                       options:MTLResourceStorageModeShared];
-                if (!sortDataBuffer_) {
-                    delete[] sortData;
-                    return false;
+            // View-space z of every center: the third row of the view matrix
+            simd_float4x4 view = toSimdMatrix(viewMatrix);
+            DepthParams depthParams;
+            depthParams.viewRow = simd_make_float4(view.columns[0].z, view.columns[1].z,
+                                                   view.columns[2].z, view.columns[3].z);
+            depthParams.count = keyCount;
+
+            if (incremental) {
+                // Last frame's order is still in sortValues_[0]
+                [encoder setComputePipelineState:gaussianPipeline(reprojectDepthPipeline_,
+                                                                  compressedReprojectDepthPipeline_)];
+                bindGaussians(encoder);
+                [encoder setBuffer:sortKeys_[0] offset:0 atIndex:1];
+                [encoder setBuffer:sortValues_[0] offset:0 atIndex:2];
+                [encoder setBytes:&depthParams length:sizeof(depthParams) atIndex:3];
+                [encoder dispatchThreadgroups:MTLSizeMake((count + kRadixThreads - 1) / kRadixThreads, 1, 1)
+                        threadsPerThreadgroup:MTLSizeMake(kRadixThreads, 1, 1)];
+
+                const int passes = std::max(1, config_.incrementalSortPasses);
+                for (int pass = 0; pass < passes * 2; ++pass) {
+                    LocalSortParams params = {keyCount, (pass & 1) ? kLocalSortWindow / 2 : 0};
+                    if (params.offset >= keyCount) {
+                        continue;
+                    }
+                    const uint32_t windows = (keyCount - params.offset + kLocalSortWindow - 1) / kLocalSortWindow;
+                    [encoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
+                    [encoder setComputePipelineState:localSortPipeline_];
+                    [encoder setBuffer:sortKeys_[0] offset:0 atIndex:0];
+                    [encoder setBuffer:sortValues_[0] offset:0 atIndex:1];
+                    [encoder setBytes:&params length:sizeof(params) atIndex:2];
+                    [encoder dispatchThreadgroups:MTLSizeMake(windows, 1, 1)
+                            threadsPerThreadgroup:MTLSizeMake(kLocalSortWindow / 2, 1, 1)];
                 }
+                [encoder endEncoding];
+                sortedIndices_ = sortValues_[0];
+                drawIndirect_ = false;
+                return true;
             }
-            memcpy(sortDataBuffer_.contents, sortData, sortBufferSize);
-            delete[] sortData;
-
-            // Bitonic sort requires power-of-2 size, pad if needed
-            uint32_t paddedCount = 1;
-            while (paddedCount < count) {
-                paddedCount <<= 1;
+            [encoder setComputePipelineState:gaussianPipeline(projectDepthPipeline_,
+                                                              compressedProjectDepthPipeline_)];
+            bindGaussians(encoder);
+            [encoder setBuffer:sortKeys_[0] offset:0 atIndex:1];
+            [encoder setBuffer:sortValues_[0] offset:0 atIndex:2];
+            [encoder setBytes:&depthParams length:sizeof(depthParams) atIndex:3];
+            [encoder dispatchThreadgroups:MTLSizeMake((count + kRadixThreads - 1) / kRadixThreads, 1, 1)
+                    threadsPerThreadgroup:MTLSizeMake(kRadixThreads, 1, 1)];
+
+            const uint32_t histogramLength = blockCount * kRadixBins;
+
+            // 16-bit keys sort only the top half: sign, exponent and the
+            // leading mantissa bits of the depth
+            const uint32_t firstShift = config_.sortKeyBits == 16 ? 16 : 0;
+            for (uint32_t shift = firstShift, pass = 0; shift < 32; shift += 8, ++pass) {
+                id<MTLBuffer> keysIn = sortKeys_[pass & 1];
+                id<MTLBuffer> valuesIn = sortValues_[pass & 1];
+                id<MTLBuffer> keysOut = sortKeys_[(pass + 1) & 1];
+                id<MTLBuffer> valuesOut = sortValues_[(pass + 1) & 1];
+                RadixParams params = {keyCount, blockCount, shift};
+
+                [encoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
+                [encoder setComputePipelineState:radixHistogramPipeline_];
+                [encoder setBuffer:keysIn offset:0 atIndex:0];
+                [encoder setBuffer:histogramBuffer_ offset:0 atIndex:1];
+                [encoder setBytes:&params length:sizeof(params) atIndex:2];
+                [encoder dispatchThreadgroups:MTLSizeMake(blockCount, 1, 1)
+                        threadsPerThreadgroup:MTLSizeMake(kRadixThreads, 1, 1)];
+
+                [encoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
+                encodeScan(encoder, histogramBuffer_, &histogramLength, nil, 0);
+
+                [encoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
+                [encoder setComputePipelineState:radixScatterPipeline_];
+                [encoder setBuffer:keysIn offset:0 atIndex:0];
+                [encoder setBuffer:valuesIn offset:0 atIndex:1];
+                [encoder setBuffer:keysOut offset:0 atIndex:2];
+                [encoder setBuffer:valuesOut offset:0 atIndex:3];
+                [encoder setBuffer:histogramBuffer_ offset:0 atIndex:4];
+                [encoder setBytes:&params length:sizeof(params) atIndex:5];
+                [encoder dispatchThreadgroups:MTLSizeMake(blockCount, 1, 1)
+                        threadsPerThreadgroup:MTLSizeMake(kRadixThreads, 1, 1)];
             }
+            [encoder endEncoding];
 
-            // Create command buffer for sorting
-            id<MTLCommandBuffer> commandBuffer = [commandQueue_ commandBuffer];
-            id<MTLComputeCommandEncoder> computeEncoder = [commandBuffer computeCommandEncoder];
-            [computeEncoder setComputePipelineState:sortComputePipelineState_];
-            [computeEncoder setBuffer:sortDataBuffer_ offset:0 atIndex:0];
+            // An even number of passes ends back in the first buffers
+            sortedIndices_ = sortValues_[0];
+            drawIndirect_ = false;
+            return true;
+        }
+    }
 
-            // Bitonic sort: log2(N) stages
-            for (uint32_t stage = 2; stage <= paddedCount; stage <<= 1) {
-                for (uint32_t step = stage >> 1; step > 0; step >>= 1) {
-                    [computeEncoder setBytes:&paddedCount length:sizeof(uint32_t) atIndex:1];
-                    [computeEncoder setBytes:&stage length:sizeof(uint32_t) atIndex:2];
-                    [computeEncoder setBytes:&step length:sizeof(uint32_t) atIndex:3];
+    // Visible Gaussians only: compacted on the GPU, then sorted and drawn
+    // with sizes the GPU wrote, so the CPU never learns the count in time
+    // (stats report the last completed frame's)
+    bool cullAndSortGPU(uint32_t count, id<MTLCommandBuffer> commandBuffer) {
+        if (!cullSetup_) {
+            cullSetup_ = [device_ newBufferWithLength:kSetupSize options:MTLResourceStorageModeShared];
+            cullSetup_.label = @"Cull Setup";
+            if (!cullSetup_) {
+                return false;
+            }
+        }
 
-                    // Dispatch threads
-                    NSUInteger threadsPerGroup = 256;
-                    NSUInteger numThreadgroups = (paddedCount / 2 + threadsPerGroup - 1) / threadsPerGroup;
-                    [computeEncoder dispatchThreadgroups:MTLSizeMake(numThreadgroups, 1, 1)
-                                   threadsPerThreadgroup:MTLSizeMake(threadsPerGroup, 1, 1)];
+        id<MTLBlitCommandEncoder> blit = [commandBuffer blitCommandEncoder];
+        [blit fillBuffer:cullSetup_ range:NSMakeRange(kSetupVisibleOffset, sizeof(uint32_t)) value:0];
+        [blit endEncoding];
 
-                    // Memory barrier between passes
-                    [computeEncoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
-                }
-            }
+        MTLComputePassDescriptor* computePass = [MTLComputePassDescriptor computePassDescriptor];
+        attachTimelineTimestamps((__bridge void*)computePass, "Sharp Sort");
+        id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoderWithDescriptor:computePass];
+        if (!encoder) {
+            return false;
+        }
+        encoder.label = @"Gaussian Cull and Sort";
+
+        const simd_float2 viewport = uniforms_.viewportSize;
+        CullParams cullParams;
+        cullParams.viewMatrix = uniforms_.viewMatrix;
+        cullParams.viewProjectionMatrix = uniforms_.viewProjectionMatrix;
+        cullParams.focal = simd_make_float2(uniforms_.projectionMatrix.columns[0].x * viewport.x * 0.5f,
+                                            uniforms_.projectionMatrix.columns[1].y * viewport.y * 0.5f);
+        cullParams.viewportSize = viewport;
+        cullParams.count = count;
+        cullParams.splatScale = config_.splatScale;
+        cullParams.opacityScale = config_.opacityScale;
+        cullParams.minOpacity = config_.minOpacity;
+        cullParams.minRadius = kMinSplatRadius;
+        [encoder setComputePipelineState:gaussianPipeline(cullProjectPipeline_, compressedCullProjectPipeline_)];
+        bindGaussians(encoder);
+        [encoder setBuffer:sortKeys_[0] offset:0 atIndex:1];
+        [encoder setBuffer:sortValues_[0] offset:0 atIndex:2];
+        [encoder setBuffer:cullSetup_ offset:0 atIndex:3];
+        [encoder setBytes:&cullParams length:sizeof(cullParams) atIndex:4];
+        [encoder dispatchThreadgroups:MTLSizeMake((count + kRadixThreads - 1) / kRadixThreads, 1, 1)
+                threadsPerThreadgroup:MTLSizeMake(kRadixThreads, 1, 1)];
+
+        const uint32_t firstShift = config_.sortKeyBits == 16 ? 16 : 0;
+        [encoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
+        [encoder setComputePipelineState:cullSetupPipeline_];
+        [encoder setBuffer:cullSetup_ offset:0 atIndex:0];
+        [encoder setBytes:&firstShift length:sizeof(firstShift) atIndex:1];
+        [encoder dispatchThreadgroups:MTLSizeMake(1, 1, 1) threadsPerThreadgroup:MTLSizeMake(1, 1, 1)];
+
+        encodeIndirectRadixSort(encoder, cullSetup_, (32 - firstShift) / 8);
+        [encoder endEncoding];
+
+        id<MTLBuffer> setup = cullSetup_;
+        std::shared_ptr<std::atomic<uint32_t>> visible = visibleCount_;
+        [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer>) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(setup.contents);
+            visible->store(*reinterpret_cast<const uint32_t*>(bytes + kSetupVisibleOffset),
+                           std::memory_order_relaxed);
+        }];
+
+        sortedIndices_ = sortValues_[0];
+        drawIndirect_ = true;
+        return true;
+    }
 
-            [computeEncoder endEncoding];
-            [commandBuffer commit];
-            [commandBuffer waitUntilCompleted];
+    // Radix passes over a GPU-chosen key count: parameters, scan length
+    // and dispatch sizes come from a setup buffer in the shared layout.
+    // Keys and values start in sortKeys_[0]/sortValues_[0] and, for an
+    // even pass count, end there.
+    void encodeIndirectRadixSort(id<MTLComputeCommandEncoder> encoder, id<MTLBuffer> setup, uint32_t passes) {
+        const MTLSize groupSize = MTLSizeMake(kRadixThreads, 1, 1);
+        for (uint32_t pass = 0; pass < passes; ++pass) {
+            const NSUInteger paramsOffset = pass * kSetupSlot;
+            [encoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
+            [encoder setComputePipelineState:radixHistogramPipeline_];
+            [encoder setBuffer:sortKeys_[pass & 1] offset:0 atIndex:0];
+            [encoder setBuffer:histogramBuffer_ offset:0 atIndex:1];
+            [encoder setBuffer:setup offset:paramsOffset atIndex:2];
+            [encoder dispatchThreadgroupsWithIndirectBuffer:setup
+                                       indirectBufferOffset:kSetupBlockGroupsOffset
+                                      threadsPerThreadgroup:groupSize];
+
+            [encoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
+            encodeScan(encoder, histogramBuffer_, nullptr, setup, kSetupScanLengthOffset);
+
+            [encoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
+            [encoder setComputePipelineState:radixScatterPipeline_];
+            [encoder setBuffer:sortKeys_[pass & 1] offset:0 atIndex:0];
+            [encoder setBuffer:sortValues_[pass & 1] offset:0 atIndex:1];
+            [encoder setBuffer:sortKeys_[(pass + 1) & 1] offset:0 atIndex:2];
+            [encoder setBuffer:sortValues_[(pass + 1) & 1] offset:0 atIndex:3];
+            [encoder setBuffer:histogramBuffer_ offset:0 atIndex:4];
+            [encoder setBuffer:setup offset:paramsOffset atIndex:5];
+            [encoder dispatchThreadgroupsWithIndirectBuffer:setup
+                                       indirectBufferOffset:kSetupBlockGroupsOffset
+                                      threadsPerThreadgroup:groupSize];
+        }
+    }
 
-            // Copy sorted indices
-            SortData* sortedData = (SortData*)sortDataBuffer_.contents;
-            size_t indexBufferSize = count * sizeof(uint32_t);
-            if (!indexBuffer_ || indexBuffer_.length < indexBufferSize) {
-                indexBuffer_ = [device_ newBufferWithLength:indexBufferSize
-                                                    options:MTLResourceStorageModeShared];
-                if (!indexBuffer_) {
-                    return false;
-                }
+    // Cloud order, for drawing without a sort
+    bool useCloudOrder(size_t count) {
+        size_t indexBufferSize = count * sizeof(uint32_t);
+        if (!indexBuffer_ || indexBuffer_.length < indexBufferSize) {
+            indexBuffer_ = render::metal::makeTrackedBuffer(device_, indexBufferSize, MTLResourceStorageModeShared,
+                                                            oflike::ofGpuMemoryCategory::Splats, "Sorted Indices");
+            if (!indexBuffer_) {
+                return false;
             }
-
-            uint32_t* indices = (uint32_t*)indexBuffer_.contents;
-            for (size_t i = 0; i < count; ++i) {
-                indices[i] = sortedData[i].index;
+            indexBufferIsSorted_ = true;
+        }
+        if (indexBufferIsSorted_) {
+            uint32_t* indices = static_cast<uint32_t*>(indexBuffer_.contents);
+            for (size_t i = 0; i < indexBuffer_.length / sizeof(uint32_t); ++i) {
+                indices[i] = static_cast<uint32_t>(i);
             }
-
-            return true;
+            indexBufferIsSorted_ = false;
         }
+        sortedIndices_ = indexBuffer_;
+        drawIndirect_ = false;
+        return true;
     }
 
-    bool depthSortCPU(const GaussianCloud& cloud, const oflike::ofMatrix4x4& viewMatrix) {
+    bool depthSortCPU(const GaussianCloud& cloud, const oflike::ofMatrix4x4& viewMatrix, bool incremental) {
         @autoreleasepool {
             size_t count = cloud.size();
 
             // Allocate sort data buffer if needed
             size_t bufferSize = count * sizeof(SortData);
             if (!sortDataBuffer_ || sortDataBuffer_.length < bufferSize) {
-                sortDataBuffer_ = [device_ newBufferWithLength:bufferSize
-                                                       options:MTLResourceStorageModeShared];
+                sortDataBuffer_ = render::metal::makeTrackedBuffer(device_, bufferSize, MTLResourceStorageModeShared,
+                                                                   oflike::ofGpuMemoryCategory::Splats, "Sort Data");
                 if (!sortDataBuffer_) {
                     return false;
                 }
-                sortDataBuffer_.label = @"Sort Data";
             }
 
             // Compute depth for each Gaussian
@@ -521,35 +1705,53 @@ private:
             simd_float4x4 view = toSimdMatrix(viewMatrix);
 
             for (size_t i = 0; i < count; ++i) {
-                const Gaussian& g = gaussians[i];
+                // Incremental sorts keep last frame's order in sortData
+                if (!incremental) {
+                    sortData[i].index = static_cast<uint32_t>(i);
+                }
+                const Gaussian& g = gaussians[sortData[i].index];
                 simd_float4 pos = simd_make_float4(g.position.x, g.position.y, g.position.z, 1.0f);
                 simd_float4 viewPos = simd_mul(view, pos);
 
-                sortData[i].index = static_cast<uint32_t>(i);
                 sortData[i].depth = viewPos.z; // Depth in camera space
             }
 
-            // Sort by depth (back-to-front for alpha blending)
-            std::sort(sortData, sortData + count,
-                     [](const SortData& a, const SortData& b) {
-                         return a.depth > b.depth; // Back-to-front
-                     });
+            // Sort by depth (back-to-front for alpha blending; the camera
+            // looks down -z, so the farthest Gaussians have the lowest z)
+            auto backToFront = [](const SortData& a, const SortData& b) {
+                return a.depth < b.depth;
+            };
+            if (incremental) {
+                // Nearly sorted: insertion sort runs in about linear time
+                for (size_t i = 1; i < count; ++i) {
+                    SortData item = sortData[i];
+                    size_t j = i;
+                    for (; j > 0 && backToFront(item, sortData[j - 1]); --j) {
+                        sortData[j] = sortData[j - 1];
+                    }
+                    sortData[j] = item;
+                }
+            } else {
+                std::sort(sortData, sortData + count, backToFront);
+            }
 
             // Create index buffer with sorted indices
             size_t indexBufferSize = count * sizeof(uint32_t);
             if (!indexBuffer_ || indexBuffer_.length < indexBufferSize) {
-                indexBuffer_ = [device_ newBufferWithLength:indexBufferSize
-                                                    options:MTLResourceStorageModeShared];
+                indexBuffer_ = render::metal::makeTrackedBuffer(device_, indexBufferSize, MTLResourceStorageModeShared,
+                                                                oflike::ofGpuMemoryCategory::Splats, "Sorted Indices");
                 if (!indexBuffer_) {
                     return false;
                 }
-                indexBuffer_.label = @"Sorted Indices";
             }
 
             uint32_t* indices = static_cast<uint32_t*>(indexBuffer_.contents);
             for (size_t i = 0; i < count; ++i) {
                 indices[i] = sortData[i].index;
             }
+            indexBufferIsSorted_ = true;
+            sortedIndices_ = indexBuffer_;
+            drawIndirect_ = false;
 
             return true;
         }
@@ -559,19 +1761,30 @@ private:
     // Rendering
     // ========================================================================
 
-    bool renderGaussians(id<MTLTexture> renderTarget, id<MTLCommandBuffer> commandBuffer) {
+    bool renderGaussians(id<MTLTexture> renderTarget, id<MTLCommandBuffer> commandBuffer, size_t gaussianCount) {
         @autoreleasepool {
             if (!renderPipelineState_) {
                 // Pipeline not created yet (shaders not implemented)
                 // This is expected for Phase 25.1 - just return success
                 return true;
             }
+            if (!sortedIndices_) {
+                return false;
+            }
+            if (!views_.empty()) {
+                return renderViews(renderTarget, commandBuffer, gaussianCount);
+            }
 
-            // Create render pass descriptor
+            // Create render pass descriptor; with a rate, splats shade into
+            // a cleared physical texture that is blended over the target after
+            const bool rateMapped = prepareRateMap(renderTarget);
             MTLRenderPassDescriptor* renderPassDescriptor = [MTLRenderPassDescriptor renderPassDescriptor];
-            renderPassDescriptor.colorAttachments[0].texture = renderTarget;
-            renderPassDescriptor.colorAttachments[0].loadAction = MTLLoadActionLoad;
+            renderPassDescriptor.colorAttachments[0].texture = rateMapped ? rateTexture_ : renderTarget;
+            renderPassDescriptor.colorAttachments[0].loadAction = rateMapped ? MTLLoadActionClear : MTLLoadActionLoad;
+            renderPassDescriptor.colorAttachments[0].clearColor = MTLClearColorMake(0, 0, 0, 0);
             renderPassDescriptor.colorAttachments[0].storeAction = MTLStoreActionStore;
+            renderPassDescriptor.rasterizationRateMap = rateMapped ? rateMap_ : nil;
+            attachTimelineTimestamps((__bridge void*)renderPassDescriptor, "Sharp Render");
 
             // Create render command encoder
             id<MTLRenderCommandEncoder> renderEncoder =
@@ -583,26 +1796,567 @@ private:
             renderEncoder.label = @"Gaussian Splatting Render";
 
             // Set pipeline state
-            [renderEncoder setRenderPipelineState:renderPipelineState_];
-
-            // Set buffers
-            [renderEncoder setVertexBuffer:gaussianBuffer_ offset:0 atIndex:0];
-            [renderEncoder setVertexBuffer:uniformBuffer_ offset:0 atIndex:1];
-            [renderEncoder setFragmentBuffer:uniformBuffer_ offset:0 atIndex:0];
+            [renderEncoder setRenderPipelineState:compressedInput_ ? compressedRenderPipelineState_
+                                                                   : renderPipelineState_];
+
+            // Set buffers (instances are drawn in sortedIndices_ order)
+            if (compressedInput_) {
+                [renderEncoder setVertexBuffer:compressedBuffer_ offset:compressedLayout_.splatOffset
+                                       atIndex:kCompressedSplatsIndex];
+                [renderEncoder setVertexBuffer:compressedBuffer_ offset:compressedLayout_.chunkOffset
+                                       atIndex:kCompressedChunksIndex];
+            } else {
+                [renderEncoder setVertexBuffer:gaussianBuffer_ offset:0 atIndex:0];
+            }
+            [renderEncoder setVertexBuffer:sortedIndices_ offset:0 atIndex:1];
+            [renderEncoder setVertexBytes:&uniforms_ length:sizeof(uniforms_) atIndex:2];
+            [renderEncoder setVertexBuffer:shColors_ offset:0 atIndex:3];
+            [renderEncoder setFragmentBytes:&uniforms_ length:sizeof(uniforms_) atIndex:0];
 
             // Draw Gaussians
-            // Each Gaussian is rendered as a billboard quad (6 vertices)
-            size_t gaussianCount = gaussianBuffer_.length / sizeof(GaussianVertex);
-            [renderEncoder drawPrimitives:MTLPrimitiveTypeTriangle
-                              vertexStart:0
-                              vertexCount:6 * gaussianCount];
+            // Each Gaussian is one instance of a billboard quad (4-vertex strip);
+            // culled sorts draw as many instances as survived
+            if (drawIndirect_) {
+                [renderEncoder drawPrimitives:MTLPrimitiveTypeTriangleStrip
+                               indirectBuffer:cullSetup_
+                         indirectBufferOffset:kSetupDrawOffset];
+            } else {
+                [renderEncoder drawPrimitives:MTLPrimitiveTypeTriangleStrip
+                                  vertexStart:0
+                                  vertexCount:4
+                                instanceCount:gaussianCount];
+            }
 
             [renderEncoder endEncoding];
 
+            return rateMapped ? compositeRateMap(renderTarget, commandBuffer) : true;
+        }
+    }
+
+    // ========================================================================
+    // Variable Rasterization Rate
+    // ========================================================================
+
+    void setRasterizationRate(const render::RasterizationRate& rate) {
+        rate_ = rate;
+        rateMap_ = nil;     // Rebuilt for the next target
+    }
+
+    // Build the rate map, its physical texture and the composite for the
+    // target's size and format; false = draw at full rate
+    bool prepareRateMap(id<MTLTexture> renderTarget) {
+        if (rate_.empty() || ![device_ supportsRasterizationRateMapWithLayerCount:1]) {
+            return false;
+        }
+        if (rateMap_ && rateMap_.screenSize.width == renderTarget.width &&
+            rateMap_.screenSize.height == renderTarget.height &&
+            rateTexture_.pixelFormat == renderTarget.pixelFormat) {
+            return rateCompositePipeline_ != nil;
+        }
+        rateMap_ = nil;
+        rateTexture_ = nil;
+
+        @autoreleasepool {
+            auto zones = [](const std::vector<float>& rates) {
+                return rates.empty() ? NSUInteger(1) : NSUInteger(rates.size());
+            };
+            auto fill = [](float* storage, const std::vector<float>& rates) {
+                storage[0] = 1.0f;
+                for (size_t i = 0; i < rates.size(); ++i) {
+                    storage[i] = std::clamp(rates[i], render::kMinRasterizationRate, 1.0f);
+                }
+            };
+            MTLRasterizationRateLayerDescriptor* layer = [[MTLRasterizationRateLayerDescriptor alloc]
+                initWithSampleCount:MTLSizeMake(zones(rate_.horizontal), zones(rate_.vertical), 0)];
+            if (!layer) {
+                return false;
+            }
+            fill(layer.horizontalSampleStorage, rate_.horizontal);
+            fill(layer.verticalSampleStorage, rate_.vertical);
+            MTLRasterizationRateMapDescriptor* desc = [MTLRasterizationRateMapDescriptor
+                rasterizationRateMapDescriptorWithScreenSize:MTLSizeMake(renderTarget.width, renderTarget.height, 0)
+                                                       layer:layer];
+            desc.label = @"Gaussian Rate Map";
+            id<MTLRasterizationRateMap> map = [device_ newRasterizationRateMapWithDescriptor:desc];
+            if (!map) {
+                NSLog(@"[SharpRenderer] Warning: Rasterization rate map unavailable, drawing at full rate");
+                return false;
+            }
+
+            const MTLSize physicalSize = [map physicalSizeForLayer:0];
+            MTLTextureDescriptor* textureDesc = [MTLTextureDescriptor
+                texture2DDescriptorWithPixelFormat:renderTarget.pixelFormat
+                                             width:physicalSize.width
+                                            height:physicalSize.height
+                                         mipmapped:NO];
+            textureDesc.usage = MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead;
+            textureDesc.storageMode = MTLStorageModePrivate;
+            rateTexture_ = render::metal::makeTrackedTexture(device_, textureDesc,
+                                                             oflike::ofGpuMemoryCategory::RenderTargets,
+                                                             "Gaussian Rate Map");
+            rateParameters_ = render::metal::makeTrackedBuffer(device_, map.parameterBufferSizeAndAlign.size,
+                                                               MTLResourceStorageModeShared,
+                                                               oflike::ofGpuMemoryCategory::RenderTargets,
+                                                               "Gaussian Rate Map Parameters");
+            if (!rateTexture_ || !rateParameters_ || !createRateCompositePipeline(renderTarget.pixelFormat)) {
+                rateTexture_ = nil;
+                return false;
+            }
+            [map copyParameterDataToBuffer:rateParameters_ offset:0];
+            rateMap_ = map;
+            return true;
+        }
+    }
+
+    // Stretches the physical texture back to the target's size and blends
+    // it over like the quads would have (premultiplied "over")
+    bool createRateCompositePipeline(MTLPixelFormat format) {
+        if (rateCompositePipeline_ && rateCompositeFormat_ == format) {
+            return true;
+        }
+        @autoreleasepool {
+            id<MTLLibrary> library = [device_ newDefaultLibrary];
+            MTLRenderPipelineDescriptor* desc = [[MTLRenderPipelineDescriptor alloc] init];
+            desc.label = @"Gaussian Rate Map Composite";
+            desc.vertexFunction = [library newFunctionWithName:@"vertexRateMapResolve"];
+            desc.fragmentFunction = [library newFunctionWithName:@"fragmentRateMapResolve"];
+            desc.colorAttachments[0].pixelFormat = format;
+            desc.colorAttachments[0].blendingEnabled = YES;
+            desc.colorAttachments[0].sourceRGBBlendFactor = MTLBlendFactorOne;
+            desc.colorAttachments[0].sourceAlphaBlendFactor = MTLBlendFactorOne;
+            desc.colorAttachments[0].destinationRGBBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
+            desc.colorAttachments[0].destinationAlphaBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
+
+            NSError* error = nil;
+            rateCompositePipeline_ = [device_ newRenderPipelineStateWithDescriptor:desc error:&error];
+            if (!rateCompositePipeline_) {
+                NSLog(@"[SharpRenderer] Error: Failed to create rate map composite pipeline: %@",
+                      error.localizedDescription);
+                return false;
+            }
+            rateCompositeFormat_ = format;
+            return true;
+        }
+    }
+
+    bool compositeRateMap(id<MTLTexture> renderTarget, id<MTLCommandBuffer> commandBuffer) {
+        MTLRenderPassDescriptor* pass = [MTLRenderPassDescriptor renderPassDescriptor];
+        pass.colorAttachments[0].texture = renderTarget;
+        pass.colorAttachments[0].loadAction = MTLLoadActionLoad;
+        pass.colorAttachments[0].storeAction = MTLStoreActionStore;
+        id<MTLRenderCommandEncoder> composite = [commandBuffer renderCommandEncoderWithDescriptor:pass];
+        if (!composite) {
+            return false;
+        }
+        composite.label = @"Gaussian Rate Map Composite";
+        [composite setRenderPipelineState:rateCompositePipeline_];
+        [composite setFragmentBuffer:rateParameters_ offset:0 atIndex:0];
+        [composite setFragmentTexture:rateTexture_ atIndex:0];
+        [composite drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:3];
+        [composite endEncoding];
+        return true;
+    }
+
+    // Pixel rectangle (x, y, width, height) a view covers in the target
+    static simd_float4 viewRect(const RenderView& view, id<MTLTexture> target) {
+        if (view.viewport.z > 0.0f && view.viewport.w > 0.0f) {
+            return view.viewport;
+        }
+        return simd_make_float4(0.0f, 0.0f, target.width, target.height);
+    }
+
+    // Draw this frame's sorted splats once per view in views_, each with
+    // its own matrices into its own viewport or slice; the colors and the
+    // draw order (and its indirect survivor count) are shared
+    bool renderViews(id<MTLTexture> renderTarget, id<MTLCommandBuffer> commandBuffer, size_t gaussianCount) {
+        id<MTLRenderPipelineState> pipeline = compressedInput_ ? compressedViewsPipelineState_ : viewsPipelineState_;
+        id<MTLRenderPipelineState> amplified = compressedInput_ ? compressedAmplifiedPipelineState_
+                                                                : amplifiedPipelineState_;
+        if (!pipeline) {
+            return false;
+        }
+
+        const uint32_t viewCount = static_cast<uint32_t>(views_.size());
+        GaussianUniforms uniforms[SharpRenderer::kMaxRenderViews];
+        MTLViewport viewports[SharpRenderer::kMaxRenderViews];
+        uint32_t layers[SharpRenderer::kMaxRenderViews];
+        for (uint32_t i = 0; i < viewCount; ++i) {
+            const RenderView& view = views_[i];
+            const simd_float4 rect = viewRect(view, renderTarget);
+            uniforms[i] = uniforms_;
+            uniforms[i].viewMatrix = view.viewMatrix;
+            uniforms[i].projectionMatrix = view.projectionMatrix;
+            uniforms[i].viewProjectionMatrix = simd_mul(view.projectionMatrix, view.viewMatrix);
+            uniforms[i].cameraPosition = simd_inverse(view.viewMatrix).columns[3].xyz;
+            uniforms[i].viewportSize = rect.zw;
+            viewports[i] = {rect.x, rect.y, rect.z, rect.w, 0.0, 1.0};
+            layers[i] = view.layer;
+        }
+
+        MTLRenderPassDescriptor* renderPassDescriptor = [MTLRenderPassDescriptor renderPassDescriptor];
+        renderPassDescriptor.colorAttachments[0].texture = renderTarget;
+        renderPassDescriptor.colorAttachments[0].loadAction = MTLLoadActionLoad;
+        renderPassDescriptor.colorAttachments[0].storeAction = MTLStoreActionStore;
+        if (renderTarget.textureType == MTLTextureType2DArray) {
+            renderPassDescriptor.renderTargetArrayLength = renderTarget.arrayLength;
+        }
+        attachTimelineTimestamps((__bridge void*)renderPassDescriptor, "Sharp Render");
+
+        id<MTLRenderCommandEncoder> renderEncoder =
+            [commandBuffer renderCommandEncoderWithDescriptor:renderPassDescriptor];
+        if (!renderEncoder) {
+            return false;
+        }
+        renderEncoder.label = @"Gaussian Splatting Render (Views)";
+        [renderEncoder setRenderPipelineState:amplified ? amplified : pipeline];
+        [renderEncoder setViewports:viewports count:viewCount];
+
+        if (compressedInput_) {
+            [renderEncoder setVertexBuffer:compressedBuffer_ offset:compressedLayout_.splatOffset
+                                   atIndex:kCompressedSplatsIndex];
+            [renderEncoder setVertexBuffer:compressedBuffer_ offset:compressedLayout_.chunkOffset
+                                   atIndex:kCompressedChunksIndex];
+        } else {
+            [renderEncoder setVertexBuffer:gaussianBuffer_ offset:0 atIndex:0];
+        }
+        [renderEncoder setVertexBuffer:sortedIndices_ offset:0 atIndex:1];
+        [renderEncoder setVertexBytes:uniforms length:viewCount * sizeof(GaussianUniforms) atIndex:2];
+        [renderEncoder setVertexBuffer:shColors_ offset:0 atIndex:3];
+        [renderEncoder setVertexBytes:layers length:viewCount * sizeof(uint32_t) atIndex:kViewLayersIndex];
+
+        // Only the projection and rasterization repeat per view
+        const uint32_t perDraw = amplified ? static_cast<uint32_t>(kViewAmplification) : 1;
+        for (uint32_t base = 0; base < viewCount; base += perDraw) {
+            [renderEncoder setVertexBytes:&base length:sizeof(base) atIndex:kViewBaseIndex];
+            if (amplified) {
+                [renderEncoder setVertexAmplificationCount:std::min(perDraw, viewCount - base) viewMappings:nil];
+            }
+            if (drawIndirect_) {
+                [renderEncoder drawPrimitives:MTLPrimitiveTypeTriangleStrip
+                               indirectBuffer:cullSetup_
+                         indirectBufferOffset:kSetupDrawOffset];
+            } else {
+                [renderEncoder drawPrimitives:MTLPrimitiveTypeTriangleStrip
+                                  vertexStart:0
+                                  vertexCount:4
+                                instanceCount:gaussianCount];
+            }
+        }
+
+        [renderEncoder endEncoding];
+        return true;
+    }
+
+    // ========================================================================
+    // SH Color Cache
+    // ========================================================================
+
+    // Whether the cached colors still hold for this frame. A splat at
+    // distance d turns its view direction by at most asin(m / d) when the
+    // camera moves m, so the closest splat bounds the whole cache.
+    bool canReuseSHColors(size_t count, const SHColorParams& params) const {
+        if (config_.shCacheAngle <= 0.0f || shCacheCount_ != count || shCacheVersion_ != contentsVersion_ ||
+            shCacheCompressed_ != compressedInput_ || params.maxSHDegree != shCacheParams_.maxSHDegree ||
+            params.splatScale != shCacheParams_.splatScale || params.detailRadius != shCacheParams_.detailRadius) {
+            return false;
+        }
+        // Zoom changes which degree small splats get
+        if (std::fabs(params.focal - shCacheParams_.focal) > shCacheParams_.focal * 0.01f) {
+            return false;
+        }
+
+        const uint64_t measured = shCacheDistance_->load(std::memory_order_acquire);
+        if (static_cast<uint32_t>(measured >> 32) != shFills_) {
+            return false;   // The fill hasn't completed yet
+        }
+        float closest = 0.0f;
+        const uint32_t bits = static_cast<uint32_t>(measured);
+        std::memcpy(&closest, &bits, sizeof(closest));
+        const float moved = simd_distance(params.cameraPosition, shCacheParams_.cameraPosition);
+        if (moved == 0.0f) {
+            return true;
+        }
+        if (!(closest > moved)) {
+            return false;
+        }
+        return std::asin(moved / closest) <= config_.shCacheAngle * float(M_PI) / 180.0f;
+    }
+
+    // Fill shColors_ for the vertex shader, unless the last fill still holds
+    bool prepareSHColors(size_t count, id<MTLCommandBuffer> commandBuffer) {
+        if (!renderPipelineState_) {
+            return true;
+        }
+
+        SHColorParams params;
+        params.cameraPosition = uniforms_.cameraPosition;
+        params.focal = uniforms_.projectionMatrix.columns[1].y * uniforms_.viewportSize.y * 0.5f;
+        params.count = static_cast<uint32_t>(count);
+        params.maxSHDegree = uniforms_.maxSHDegree;
+        params.splatScale = config_.splatScale;
+        params.detailRadius = config_.shDetailRadius;
+        if (canReuseSHColors(count, params)) {
+            stats_.shCacheReuses++;
+            return true;
+        }
+
+        const size_t size = count * 4 * sizeof(uint16_t);     // half4
+        if (!shColors_ || shColors_.length < size) {
+            shColors_ = render::metal::makeTrackedBuffer(device_, size, MTLResourceStorageModePrivate, oflike::ofGpuMemoryCategory::Splats,
+                                                         "SH Colors");
+            if (!shColors_) {
+                return false;
+            }
+        }
+        if (!shMinDistance_) {
+            shMinDistance_ = [device_ newBufferWithLength:sizeof(uint32_t) options:MTLResourceStorageModeShared];
+            if (!shMinDistance_) {
+                return false;
+            }
+            shMinDistance_.label = @"SH Closest Splat";
+        }
+
+        @autoreleasepool {
+            id<MTLBlitCommandEncoder> blit = [commandBuffer blitCommandEncoder];
+            [blit fillBuffer:shMinDistance_ range:NSMakeRange(0, sizeof(uint32_t)) value:0xFF];
+            [blit endEncoding];
+
+            id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoder];
+            if (!encoder) {
+                return false;
+            }
+            encoder.label = @"Gaussian SH Colors";
+            id<MTLComputePipelineState> pipeline = gaussianPipeline(shColorPipeline_, compressedSHColorPipeline_);
+            [encoder setComputePipelineState:pipeline];
+            bindGaussians(encoder);
+            [encoder setBuffer:shColors_ offset:0 atIndex:1];
+            [encoder setBuffer:shMinDistance_ offset:0 atIndex:2];
+            [encoder setBytes:&params length:sizeof(params) atIndex:3];
+            const NSUInteger width = pipeline.threadExecutionWidth;
+            [encoder dispatchThreadgroups:MTLSizeMake((count + width - 1) / width, 1, 1)
+                    threadsPerThreadgroup:MTLSizeMake(width, 1, 1)];
+            [encoder endEncoding];
+        }
+
+        const uint32_t fill = ++shFills_;
+        id<MTLBuffer> distance = shMinDistance_;
+        std::shared_ptr<std::atomic<uint64_t>> measured = shCacheDistance_;
+        [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer>) {
+            const uint32_t bits = *static_cast<const uint32_t*>(distance.contents);
+            measured->store((uint64_t(fill) << 32) | bits, std::memory_order_release);
+        }];
+
+        shCacheCount_ = count;
+        shCacheVersion_ = contentsVersion_;
+        shCacheCompressed_ = compressedInput_;
+        shCacheParams_ = params;
+        return true;
+    }
+
+    // ========================================================================
+    // Tile Rasterization
+    // ========================================================================
+
+    bool canRenderTiles(id<MTLTexture> renderTarget) const {
+        const NSUInteger tiles = ((renderTarget.width + kTileSize - 1) / kTileSize) *
+                                 ((renderTarget.height + kTileSize - 1) / kTileSize);
+        return tileRenderPipeline_ && tiles <= kMaxTiles;
+    }
+
+    // Size the per-splat and per-key buffers; the key capacity follows what
+    // an earlier frame asked for, so growing never waits for the GPU
+    bool reserveTileBuffers(size_t count, NSUInteger tiles, NSUInteger width, NSUInteger height) {
+        const uint32_t requested = tileRequested_->load(std::memory_order_relaxed);
+        if (tileCapacity_ < count * 4 || tileCapacity_ < requested) {
+            const size_t wanted = std::max<size_t>(count * 4, size_t(requested) + requested / 4);
+            tileCapacity_ = static_cast<uint32_t>(std::min<size_t>(wanted, UINT32_MAX / 2));
+        }
+
+        const size_t keyBytes = size_t(tileCapacity_) * sizeof(uint32_t);
+        const size_t blockCount = (tileCapacity_ + kRadixBlock - 1) / kRadixBlock;
+        if (!reservePrivate(sortKeys_[0], keyBytes, @"Sort Keys") ||
+            !reservePrivate(sortKeys_[1], keyBytes, @"Sort Keys (Scratch)") ||
+            !reservePrivate(sortValues_[0], keyBytes, @"Sorted Indices") ||
+            !reservePrivate(sortValues_[1], keyBytes, @"Sorted Indices (Scratch)") ||
+            !reservePrivate(histogramBuffer_, blockCount * kRadixBins * sizeof(uint32_t), @"Sort Histograms") ||
+            !reservePrivate(tileSplats_, count * sizeof(TileSplat), @"Tile Splats") ||
+            !reservePrivate(tileOffsets_, count * sizeof(uint32_t), @"Tile Offsets") ||
+            !reservePrivate(tileRanges_, tiles * sizeof(simd_uint2), @"Tile Ranges")) {
+            return false;
+        }
+
+        if (!tileSetup_) {
+            // Shared: completion handlers read back how many keys were asked for
+            tileSetup_ = [device_ newBufferWithLength:kSetupSize options:MTLResourceStorageModeShared];
+            tileSetup_.label = @"Tile Sort Setup";
+        }
+        if (!tileOutput_ || tileOutput_.width != width || tileOutput_.height != height) {
+            MTLTextureDescriptor* desc =
+                [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:MTLPixelFormatRGBA16Float
+                                                                   width:width
+                                                                  height:height
+                                                               mipmapped:NO];
+            desc.usage = MTLTextureUsageShaderWrite | MTLTextureUsageShaderRead;
+            desc.storageMode = MTLStorageModePrivate;
+            tileOutput_ = render::metal::makeTrackedTexture(device_, desc, oflike::ofGpuMemoryCategory::RenderTargets,
+                                                            "Splat Tile Output");
+        }
+        return tileSetup_ && tileOutput_;
+    }
+
+    // Reference-style tile rasterization, all in the frame's command buffer:
+    // screen bounds per splat, one (tile, depth) key per covered tile, a
+    // radix sort of the keys, then front-to-back compositing per tile into
+    // an intermediate texture that is blended over the target
+    bool renderTiles(size_t count,
+                     const oflike::ofMatrix4x4& viewMatrix,
+                     const oflike::ofMatrix4x4& projectionMatrix,
+                     id<MTLTexture> renderTarget,
+                     id<MTLCommandBuffer> commandBuffer) {
+        @autoreleasepool {
+            const NSUInteger width = renderTarget.width;
+            const NSUInteger height = renderTarget.height;
+            const simd_uint2 tileCount = simd_make_uint2((uint32_t)((width + kTileSize - 1) / kTileSize),
+                                                         (uint32_t)((height + kTileSize - 1) / kTileSize));
+            if (!commandBuffer || !reserveTileBuffers(count, tileCount.x * tileCount.y, width, height) ||
+                !createTileCompositePipeline(renderTarget.pixelFormat)) {
+                return false;
+            }
+
+            simd_float4x4 projection = toSimdMatrix(projectionMatrix);
+            TileUniforms uniforms;
+            uniforms.viewMatrix = uniforms_.viewMatrix;
+            uniforms.viewProjectionMatrix = uniforms_.viewProjectionMatrix;
+            uniforms.cameraPosition = uniforms_.cameraPosition;
+            uniforms.focal = simd_make_float2(projection.columns[0].x * width * 0.5f,
+                                              projection.columns[1].y * height * 0.5f);
+            uniforms.viewportSize = simd_make_float2(width, height);
+            uniforms.tileCount = tileCount;
+            uniforms.count = static_cast<uint32_t>(count);
+            uniforms.capacity = tileCapacity_;
+            uniforms.splatScale = config_.splatScale;
+            uniforms.opacityScale = config_.opacityScale;
+            uniforms.minOpacity = config_.minOpacity;
+            uniforms.maxSHDegree = config_.enableSphericalHarmonics ? config_.maxSHDegree : 0;
+            uniforms.shDetailRadius = config_.shDetailRadius;
+
+            // Tiles nobody covers keep an empty range
+            id<MTLBlitCommandEncoder> blit = [commandBuffer blitCommandEncoder];
+            [blit fillBuffer:tileRanges_ range:NSMakeRange(0, tileCount.x * tileCount.y * sizeof(simd_uint2)) value:0];
+            [blit endEncoding];
+
+            MTLComputePassDescriptor* computePass = [MTLComputePassDescriptor computePassDescriptor];
+            attachTimelineTimestamps((__bridge void*)computePass, "Sharp Tiles");
+            id<MTLComputeCommandEncoder> encoder = [commandBuffer computeCommandEncoderWithDescriptor:computePass];
+            if (!encoder) {
+                return false;
+            }
+            encoder.label = @"Gaussian Tile Rasterizer";
+            const MTLSize groupSize = MTLSizeMake(kRadixThreads, 1, 1);
+            const MTLSize splatGroups = MTLSizeMake((count + kRadixThreads - 1) / kRadixThreads, 1, 1);
+
+            // 1. Screen bounds, conic and color per splat
+            [encoder setComputePipelineState:gaussianPipeline(tilePreprocessPipeline_,
+                                                              compressedTilePreprocessPipeline_)];
+            bindGaussians(encoder);
+            [encoder setBuffer:tileSplats_ offset:0 atIndex:1];
+            [encoder setBuffer:tileOffsets_ offset:0 atIndex:2];
+            [encoder setBytes:&uniforms length:sizeof(uniforms) atIndex:3];
+            [encoder dispatchThreadgroups:splatGroups threadsPerThreadgroup:groupSize];
+
+            // 2. Key offsets per splat, then the sort sizes
+            const uint32_t splatCount = uniforms.count;
+            [encoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
+            encodeScan(encoder, tileOffsets_, &splatCount, nil, 0);
+
+            [encoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
+            [encoder setComputePipelineState:tileSetupPipeline_];
+            [encoder setBuffer:tileOffsets_ offset:0 atIndex:0];
+            [encoder setBuffer:tileSplats_ offset:0 atIndex:1];
+            [encoder setBuffer:tileSetup_ offset:0 atIndex:2];
+            [encoder setBytes:&uniforms length:sizeof(uniforms) atIndex:3];
+            [encoder dispatchThreadgroups:MTLSizeMake(1, 1, 1) threadsPerThreadgroup:MTLSizeMake(1, 1, 1)];
+
+            // 3. One key per covered tile
+            [encoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
+            [encoder setComputePipelineState:tileDuplicatePipeline_];
+            [encoder setBuffer:tileSplats_ offset:0 atIndex:0];
+            [encoder setBuffer:tileOffsets_ offset:0 atIndex:1];
+            [encoder setBuffer:sortKeys_[0] offset:0 atIndex:2];
+            [encoder setBuffer:sortValues_[0] offset:0 atIndex:3];
+            [encoder setBytes:&uniforms length:sizeof(uniforms) atIndex:4];
+            [encoder dispatchThreadgroups:splatGroups threadsPerThreadgroup:groupSize];
+
+            // 4. Sort by (tile, depth); sizes come from the setup buffer
+            encodeIndirectRadixSort(encoder, tileSetup_, 4);
+
+            // 5. Each tile's run of sorted keys
+            [encoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
+            [encoder setComputePipelineState:tileRangesPipeline_];
+            [encoder setBuffer:sortKeys_[0] offset:0 atIndex:0];
+            [encoder setBuffer:tileRanges_ offset:0 atIndex:1];
+            [encoder setBuffer:tileSetup_ offset:0 atIndex:2];
+            [encoder dispatchThreadgroupsWithIndirectBuffer:tileSetup_
+                                       indirectBufferOffset:kSetupEntryGroupsOffset
+                                      threadsPerThreadgroup:groupSize];
+
+            // 6. Front-to-back compositing, one threadgroup per tile
+            [encoder memoryBarrierWithScope:MTLBarrierScopeBuffers];
+            [encoder setComputePipelineState:tileRenderPipeline_];
+            [encoder setBuffer:tileSplats_ offset:0 atIndex:0];
+            [encoder setBuffer:sortValues_[0] offset:0 atIndex:1];
+            [encoder setBuffer:tileRanges_ offset:0 atIndex:2];
+            [encoder setBytes:&uniforms length:sizeof(uniforms) atIndex:3];
+            [encoder setTexture:tileOutput_ atIndex:0];
+            [encoder dispatchThreadgroups:MTLSizeMake(tileCount.x, tileCount.y, 1)
+                    threadsPerThreadgroup:MTLSizeMake(kTileSize, kTileSize, 1)];
+            [encoder endEncoding];
+
+            // Later frames size their keys from what this one asked for
+            id<MTLBuffer> setup = tileSetup_;
+            std::shared_ptr<std::atomic<uint32_t>> requested = tileRequested_;
+            [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer>) {
+                const uint8_t* bytes = static_cast<const uint8_t*>(setup.contents);
+                requested->store(*reinterpret_cast<const uint32_t*>(bytes + kSetupRequestedOffset),
+                                 std::memory_order_relaxed);
+            }];
+
+            // Blend over the target like the quad path
+            MTLRenderPassDescriptor* pass = [MTLRenderPassDescriptor renderPassDescriptor];
+            pass.colorAttachments[0].texture = renderTarget;
+            pass.colorAttachments[0].loadAction = MTLLoadActionLoad;
+            pass.colorAttachments[0].storeAction = MTLStoreActionStore;
+            id<MTLRenderCommandEncoder> composite = [commandBuffer renderCommandEncoderWithDescriptor:pass];
+            if (!composite) {
+                return false;
+            }
+            composite.label = @"Gaussian Tile Composite";
+            [composite setRenderPipelineState:tileCompositePipeline_];
+            [composite setFragmentTexture:tileOutput_ atIndex:0];
+            [composite drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:3];
+            [composite endEncoding];
             return true;
         }
     }
 
+    // Exclusive scan in place with gaussianRadixScan; the length comes
+    // either from the host or from a constant slot of a GPU-written buffer
+    void encodeScan(id<MTLComputeCommandEncoder> encoder, id<MTLBuffer> data,
+                    const uint32_t* length, id<MTLBuffer> lengthBuffer, NSUInteger lengthOffset) {
+        const NSUInteger simdWidth = radixScanPipeline_.threadExecutionWidth;
+        const NSUInteger scanThreads =
+            std::min<NSUInteger>(1024, radixScanPipeline_.maxTotalThreadsPerThreadgroup) / simdWidth * simdWidth;
+        [encoder setComputePipelineState:radixScanPipeline_];
+        [encoder setBuffer:data offset:0 atIndex:0];
+        if (length) {
+            [encoder setBytes:length length:sizeof(uint32_t) atIndex:1];
+        } else {
+            [encoder setBuffer:lengthBuffer offset:lengthOffset atIndex:1];
+        }
+        [encoder dispatchThreadgroups:MTLSizeMake(1, 1, 1)
+                threadsPerThreadgroup:MTLSizeMake(scanThreads, 1, 1)];
+    }
+
     // ========================================================================
     // Utility Functions
     // ========================================================================
@@ -628,12 +2382,134 @@ private:
     id<MTLDevice> device_;
     id<MTLCommandQueue> commandQueue_;
     id<MTLRenderPipelineState> renderPipelineState_;
-    id<MTLComputePipelineState> sortComputePipelineState_;
+    id<MTLComputePipelineState> projectDepthPipeline_;
+    id<MTLComputePipelineState> radixHistogramPipeline_;
+    id<MTLComputePipelineState> radixScanPipeline_;
+    id<MTLComputePipelineState> radixScatterPipeline_;
+    id<MTLComputePipelineState> reprojectDepthPipeline_ = nil;
+    id<MTLComputePipelineState> localSortPipeline_ = nil;   // nil = no incremental GPU sort
+    id<MTLComputePipelineState> cullProjectPipeline_ = nil; // nil = no culling
+    id<MTLComputePipelineState> cullSetupPipeline_ = nil;
+
+    // Multi-view variants (nil = no multi-view renders; amplified nil =
+    // one draw per view)
+    id<MTLRenderPipelineState> viewsPipelineState_ = nil;
+    id<MTLRenderPipelineState> amplifiedPipelineState_ = nil;
+    id<MTLRenderPipelineState> compressedViewsPipelineState_ = nil;
+    id<MTLRenderPipelineState> compressedAmplifiedPipelineState_ = nil;
+
+    // Views of the multi-view render in progress (empty = one view, in
+    // uniforms_) and the size of its cull view
+    std::vector<RenderView> views_;
+    simd_float2 cullViewportSize_ = {0.0f, 0.0f};
+
+    // Variants for GaussianCloud's compressed buffer
+    id<MTLRenderPipelineState> compressedRenderPipelineState_ = nil;
+    id<MTLComputePipelineState> compressedProjectDepthPipeline_ = nil;
+    id<MTLComputePipelineState> compressedReprojectDepthPipeline_ = nil;
+    id<MTLComputePipelineState> compressedCullProjectPipeline_ = nil;
+    id<MTLComputePipelineState> compressedTilePreprocessPipeline_ = nil;
 
     id<MTLBuffer> gaussianBuffer_;
-    id<MTLBuffer> sortDataBuffer_;
-    id<MTLBuffer> indexBuffer_;
-    id<MTLBuffer> uniformBuffer_;
+    id<MTLComputePipelineState> cloudExpandPipeline_ = nil;   // nil = always upload from the CPU
+
+    // What gaussianBuffer_ holds, so unchanged frames skip refilling it
+    enum class BufferContents { None, Cloud, LOD, Scene };
+    BufferContents bufferContents_ = BufferContents::None;
+    const GaussianCloud* expandedCloud_ = nullptr;             // Cloud: expanded from this cloud's GPU copy
+    uint64_t expandedGeneration_ = 0;
+    size_t expandedCount_ = 0;
+    bool compressedInput_ = false;      // This frame reads compressedBuffer_
+
+    // Scene batch: object-space splats, their object indices and the
+    // transforms last applied to them
+    id<MTLComputePipelineState> sceneTransformPipeline_ = nil;
+    id<MTLBuffer> sceneLocal_ = nil;
+    id<MTLBuffer> sceneObjectIDs_ = nil;
+    std::vector<SceneEntry> sceneEntries_;
+    std::vector<ObjectTransform> sceneTransforms_;
+
+    // LOD node cache: fixed pages of lodPageSize_ splats in the upload layout.
+    // A page isn't rewritten until the frames that drew it are retired.
+    static constexpr uint64_t kLODFramesInFlight = render::kRetireFrames;
+    id<MTLBuffer> lodCache_ = nil;
+    const GaussianCloud* lodCloud_ = nullptr;
+    uint64_t lodGeneration_ = 0;
+    size_t lodCacheSplats_ = 0;
+    size_t lodPageSize_ = 0;
+    uint64_t lodFrame_ = 0;
+    std::vector<int32_t> nodePage_;         // Per node, -1 = not cached
+    std::vector<int32_t> pageNode_;         // Per page, -1 = free
+    std::vector<uint64_t> pageLastUsed_;    // lodFrame_ of the page's last draw
+    std::vector<int32_t> lodSelection_;
+    std::vector<int32_t> previousSelection_;
+    id<MTLBuffer> compressedBuffer_ = nil;  // The cloud's own, not owned here
+    uint64_t compressedGeneration_ = 0;
+    CompressedBufferLayout compressedLayout_;
+
+    // Bumped whenever the splats the frame reads change (either layout)
+    uint64_t contentsVersion_ = 0;
+
+    // SH color cache for quads, one half4 per splat in buffer order, and
+    // what it was evaluated from. The fill's closest splat distance comes
+    // back through shCacheDistance_ as (fill << 32 | float bits) once the
+    // GPU has finished it.
+    id<MTLComputePipelineState> shColorPipeline_ = nil;
+    id<MTLComputePipelineState> compressedSHColorPipeline_ = nil;
+    id<MTLBuffer> shColors_ = nil;
+    id<MTLBuffer> shMinDistance_ = nil;
+    size_t shCacheCount_ = 0;           // 0 = nothing cached
+    uint64_t shCacheVersion_ = 0;
+    bool shCacheCompressed_ = false;
+    SHColorParams shCacheParams_ = {};
+    uint32_t shFills_ = 0;
+    std::shared_ptr<std::atomic<uint64_t>> shCacheDistance_ = std::make_shared<std::atomic<uint64_t>>(0);
+    id<MTLBuffer> sortDataBuffer_;      // CPU sort
+    id<MTLBuffer> indexBuffer_;         // CPU sort result, or cloud order
+    bool indexBufferIsSorted_ = false;  // indexBuffer_ holds a sort, not cloud order
+
+    // GPU sort: ping-ponged keys and values; the sorted values end in [0]
+    id<MTLBuffer> sortKeys_[2] = {nil, nil};
+    id<MTLBuffer> sortValues_[2] = {nil, nil};
+    id<MTLBuffer> histogramBuffer_;
+    id<MTLBuffer> sortedIndices_;       // Draw order bound for this frame
+
+    // Culled sorts: sort sizes and draw arguments written by the GPU
+    id<MTLBuffer> cullSetup_ = nil;
+    bool drawIndirect_ = false;         // Draw the survivor count from cullSetup_
+    std::shared_ptr<std::atomic<uint32_t>> visibleCount_ = std::make_shared<std::atomic<uint32_t>>(0);
+
+    // Incremental sorts start from the order the last sort left behind
+    size_t previousOrderCount_ = 0;     // 0 = no usable previous order
+    const void* previousOrderSource_ = nullptr;    // Cloud or scene batch it belongs to
+    bool previousOrderOnGPU_ = false;
+    uint32_t incrementalFrames_ = 0;    // Since the last full sort
+    simd_float4x4 previousView_ = matrix_identity_float4x4;
+
+    // Tile rasterizer; keys and values share the sort buffers above
+    id<MTLComputePipelineState> tilePreprocessPipeline_ = nil;
+    id<MTLComputePipelineState> tileSetupPipeline_ = nil;
+    id<MTLComputePipelineState> tileDuplicatePipeline_ = nil;
+    id<MTLComputePipelineState> tileRangesPipeline_ = nil;
+    id<MTLComputePipelineState> tileRenderPipeline_ = nil;    // nil = tiles unavailable
+    id<MTLRenderPipelineState> tileCompositePipeline_;
+    MTLPixelFormat tileCompositeFormat_ = MTLPixelFormatInvalid;
+    id<MTLBuffer> tileSplats_;
+    id<MTLBuffer> tileOffsets_;
+    id<MTLBuffer> tileRanges_;
+    id<MTLBuffer> tileSetup_;
+    id<MTLTexture> tileOutput_;
+    uint32_t tileCapacity_ = 0;         // Keys the sort buffers hold
+    std::shared_ptr<std::atomic<uint32_t>> tileRequested_ = std::make_shared<std::atomic<uint32_t>>(0);
+
+    // Variable rasterization rate (single-view quads)
+    render::RasterizationRate rate_;
+    id<MTLRasterizationRateMap> rateMap_ = nil;     // Built for the last target's size
+    id<MTLBuffer> rateParameters_ = nil;            // Map data for the composite
+    id<MTLTexture> rateTexture_ = nil;              // Physical size, premultiplied splats
+    id<MTLRenderPipelineState> rateCompositePipeline_ = nil;
+    MTLPixelFormat rateCompositeFormat_ = MTLPixelFormatInvalid;
+    GaussianUniforms uniforms_;
 
     RenderConfig config_;
     RenderStats stats_;
@@ -685,6 +2561,22 @@ bool SharpRenderer::render(const GaussianCloud& cloud,
     return impl_->render(cloud, viewMatrix, projectionMatrix, renderTarget, commandBuffer);
 }
 
+bool SharpRenderer::render(const std::vector<RenderInstance>& instances,
+                          const oflike::ofMatrix4x4& viewMatrix,
+                          const oflike::ofMatrix4x4& projectionMatrix,
+                          void* renderTarget,
+                          void* commandBuffer) {
+    return impl_->render(instances, viewMatrix, projectionMatrix, renderTarget, commandBuffer);
+}
+
+bool SharpRenderer::render(const GaussianCloud& cloud,
+                          const RenderView& cullView,
+                          const std::vector<RenderView>& views,
+                          void* renderTarget,
+                          void* commandBuffer) {
+    return impl_->render(cloud, cullView, views, renderTarget, commandBuffer);
+}
+
 void SharpRenderer::setConfig(const RenderConfig& config) {
     impl_->setConfig(config);
 }
@@ -699,6 +2591,12 @@ void SharpRenderer::setDepthSortEnabled(bool enabled) {
     impl_->setConfig(config);
 }
 
+void SharpRenderer::setRasterMode(RasterMode mode) {
+    RenderConfig config = impl_->getConfig();
+    config.rasterMode = mode;
+    impl_->setConfig(config);
+}
+
 void SharpRenderer::setSplatScale(float scale) {
     RenderConfig config = impl_->getConfig();
     config.splatScale = scale;
@@ -723,6 +2621,10 @@ void SharpRenderer::setMaxSHDegree(int degree) {
     impl_->setConfig(config);
 }
 
+void SharpRenderer::setRasterizationRate(const oflike::ofRasterizationRate& rate) {
+    impl_->setRasterizationRate(rate.isFullRate() ? render::RasterizationRate() : rate.getRate());
+}
+
 const RenderStats& SharpRenderer::getStats() const {
     return impl_->getStats();
 }
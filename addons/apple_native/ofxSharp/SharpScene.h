@@ -238,23 +238,32 @@ public:
 
     /**
      * Render entire scene using the given renderer and camera.
-     * This applies per-object transformations and renders all visible objects.
+     * All visible objects are drawn as one batch with their transforms
+     * (see SharpRenderer::render with RenderInstance).
      * @param renderer SharpRenderer instance
      * @param camera Camera for view/projection matrices
+     * @param renderTarget Metal texture to render to (id<MTLTexture>)
+     * @param commandBuffer Metal command buffer (id<MTLCommandBuffer>)
+     * @return true if rendering succeeded
      */
-    void render(SharpRenderer& renderer, const oflike::ofCamera& camera) const;
+    bool render(SharpRenderer& renderer, const oflike::ofCamera& camera,
+                void* renderTarget, void* commandBuffer) const;
 
     /**
      * Render entire scene with custom view/projection matrices.
      */
-    void render(SharpRenderer& renderer,
+    bool render(SharpRenderer& renderer,
                 const oflike::float4x4& viewMatrix,
-                const oflike::float4x4& projectionMatrix) const;
+                const oflike::float4x4& projectionMatrix,
+                void* renderTarget,
+                void* commandBuffer) const;
 
     /**
-     * Render a single object.
+     * Render a single object with its transform.
+     * @return true if rendering succeeded (also when the object is hidden)
      */
-    void renderObject(ObjectID id, SharpRenderer& renderer, const oflike::ofCamera& camera) const;
+    bool renderObject(ObjectID id, SharpRenderer& renderer, const oflike::ofCamera& camera,
+                      void* renderTarget, void* commandBuffer) const;
 
     // ============================================================================
     // Bounding Box
@@ -289,57 +289,47 @@ ObjectID SharpScene::findByName(const std::string& name) const {
 // Rendering
 // ============================================================================
 
-void SharpScene::render(SharpRenderer& renderer, const oflike::ofCamera& camera) const {
+bool SharpScene::render(SharpRenderer& renderer, const oflike::ofCamera& camera,
+                        void* renderTarget, void* commandBuffer) const {
     using namespace oflike;
 
     // Get view and projection matrices from camera
     float4x4 viewMatrix = camera.getModelViewMatrix().toSimd();
     float4x4 projectionMatrix = camera.getProjectionMatrix().toSimd();
 
-    render(renderer, viewMatrix, projectionMatrix);
+    return render(renderer, viewMatrix, projectionMatrix, renderTarget, commandBuffer);
 }
 
-void SharpScene::render(SharpRenderer& renderer,
+bool SharpScene::render(SharpRenderer& renderer,
                         const oflike::float4x4& viewMatrix,
-                        const oflike::float4x4& projectionMatrix) const {
-    // NOTE: Rendering implementation requires renderer to support per-object transforms
-    // For Phase 25.6, we document the intended behavior:
-    // - Iterate through all visible objects
-    // - For each object:
-    //   1. Get object's transformation matrix
-    //   2. Create transformed copy of cloud OR pass transform to renderer
-    //   3. Render with renderer
-
-    // DEFERRED: Scene rendering with per-object transforms
-    //
-    // Rationale:
-    // - Requires renderer API updates (completed in Phase 25.7 Camera Path integration)
-    // - Three implementation options require performance profiling to decide:
-    //   1. Transform each cloud's Gaussians by object matrix (CPU-intensive)
-    //   2. Pass object matrix to renderer as uniform (GPU-efficient, preferred)
-    //   3. Batch render with instancing (most efficient for many objects)
-    // - Core rendering path exists (single cloud rendering works)
-    // - Scene composition deferred until multi-object use cases are validated
-    //
-    // Current workaround: Render individual clouds directly with SharpRenderer
-}
-
-void SharpScene::renderObject(ObjectID id, SharpRenderer& renderer, const oflike::ofCamera& camera) const {
+                        const oflike::float4x4& projectionMatrix,
+                        void* renderTarget,
+                        void* commandBuffer) const {
+    // Hidden objects stay in the batch so toggling them doesn't regather it
+    std::vector<RenderInstance> instances;
+    instances.reserve(impl_->objects_.size());
+    for (const auto& pair : impl_->objects_) {
+        const Impl::Object& obj = pair.second;
+        instances.push_back({&obj.cloud, obj.metadata.getMatrix(), obj.metadata.visible});
+    }
+
+    return renderer.render(instances, oflike::ofMatrix4x4(viewMatrix), oflike::ofMatrix4x4(projectionMatrix),
+                           renderTarget, commandBuffer);
+}
+
+bool SharpScene::renderObject(ObjectID id, SharpRenderer& renderer, const oflike::ofCamera& camera,
+                              void* renderTarget, void* commandBuffer) const {
     const auto* obj = impl_->findObject(id);
-    if (!obj || !obj->metadata.visible) {
-        return;
+    if (!obj) {
+        return false;
+    }
+    if (!obj->metadata.visible) {
+        return true;
     }
 
-    // DEFERRED: Single object rendering from scene
-    //
-    // Rationale:
-    // - Depends on scene rendering implementation (see render() above)
-    // - Requires object transform application to Gaussian cloud
-    // - Current API: Users can access object's cloud and render directly
-    //
-    // Workaround:
-    //   SharpGaussianCloud* cloud = scene.getObject(id);
-    //   renderer.render(*cloud, camera);
+    std::vector<RenderInstance> instances = {{&obj->cloud, obj->metadata.getMatrix(), true}};
+    return renderer.render(instances, camera.getModelViewMatrix(), camera.getProjectionMatrix(),
+                           renderTarget, commandBuffer);
 }
 
 // ============================================================================
@@ -122,6 +122,10 @@ struct VideoExportSettings {
     // Color space
     bool useHDR = false;            ///< Use HDR color space (H.265 only)
 
+    // Offline rendering (exportScene / exportCloud)
+    size_t framesInFlight = 3;      ///< Frames the GPU renders ahead of the encoder
+    size_t segments = 1;            ///< Timeline chunks rendered and encoded concurrently
+
     VideoExportSettings() = default;
 };
 
@@ -186,9 +190,11 @@ public:
 
     /**
      * Add a frame to the video.
-     * Call this repeatedly for each frame during export.
+     * Call this repeatedly for each frame during export. The texture is read
+     * back asynchronously (it sees this frame's drawing) and encoded a frame
+     * or two later, so end the export at least one frame after the last call.
      * @param texture Source texture to encode
-     * @return true if frame added successfully
+     * @return true if the frame was queued and every frame that arrived was added
      */
     bool addFrame(const oflike::ofTexture& texture);
 
@@ -264,6 +270,8 @@ public:
     /**
      * Export a Gaussian Splatting scene with camera animation.
      * This is a convenience method that handles the entire export process.
+     * Renders offline like exportCloud(); the scene must have exactly one
+     * visible cloud, as scenes don't compose transformed objects yet.
      * @param scene Scene to render
      * @param cameraPath Camera animation path
      * @param outputPath Output file path
@@ -277,6 +285,18 @@ public:
 
     /**
      * Export a single Gaussian cloud with camera animation.
+     * Renders offline, independent of the display: frame i shows the camera
+     * path at i / framerate, and frames render as fast as the GPU allows into
+     * the encoder's own pixel buffers, with up to settings.framesInFlight
+     * frames in flight. Frames only wait for the encoder to accept more data,
+     * so none are dropped. Blocks until the file is written; progress is
+     * reported through the progress callback.
+     * With settings.segments > 1 the timeline is split into that many
+     * chunks, each rendered on a command queue of its own and encoded by an
+     * AVAssetWriter of its own, so several encode engines (Max and Ultra
+     * chips have two or more) work at once. The chunks are written next to
+     * the output as <name>.partN.mov, joined without re-encoding, and
+     * deleted; progress is then reported from several threads, one at a time.
      * @param cloud Gaussian cloud to render
      * @param cameraPath Camera animation path
      * @param outputPath Output file path
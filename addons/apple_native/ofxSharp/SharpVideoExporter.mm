@@ -15,12 +15,112 @@
 #import <Metal/Metal.h>
 #import <MetalKit/MetalKit.h>
 #import <os/log.h>
+#import <algorithm>
+#import <atomic>
 #import <chrono>
+#import <cmath>
+#import <deque>
+#import <future>
+#import <mutex>
+#import <thread>
+#import <vector>
 
 using namespace oflike;
 
 namespace Sharp {
 
+namespace {
+
+// One AVAssetWriter with its video input
+struct WriterSession {
+    AVAssetWriter* writer = nil;
+    AVAssetWriterInput* input = nil;
+    AVAssetWriterInputPixelBufferAdaptor* adaptor = nil;
+};
+
+std::string describe(NSError* error) {
+    return error ? std::string([[error localizedDescription] UTF8String]) : "Unknown error";
+}
+
+// Segment k of a segmented export, written next to the output
+std::string segmentPath(const std::string& outputPath, size_t k) {
+    NSString* base = [[NSString stringWithUTF8String:outputPath.c_str()] stringByDeletingPathExtension];
+    return std::string([[NSString stringWithFormat:@"%@.part%zu.mov", base, k] UTF8String]);
+}
+
+void removeFile(const std::string& path) {
+    [[NSFileManager defaultManager] removeItemAtPath:[NSString stringWithUTF8String:path.c_str()] error:nil];
+}
+
+// Mark the input finished and wait for the file to be written
+bool finishWriter(const WriterSession& session, std::string& error) {
+    [session.input markAsFinished];
+
+    AVAssetWriter* writer = session.writer;
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [writer finishWritingWithCompletionHandler:^{
+        dispatch_semaphore_signal(semaphore);
+    }];
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+
+    if (writer.status != AVAssetWriterStatusCompleted) {
+        error = describe(writer.error);
+        return false;
+    }
+    return true;
+}
+
+// Join segments end to end without re-encoding
+bool concatenateSegments(const std::vector<std::string>& paths, const std::vector<size_t>& frameCounts,
+                         int framerate, const std::string& outputPath, std::string& error) {
+    AVMutableComposition* composition = [AVMutableComposition composition];
+    AVMutableCompositionTrack* track = [composition addMutableTrackWithMediaType:AVMediaTypeVideo
+                                                                preferredTrackID:kCMPersistentTrackID_Invalid];
+    CMTime cursor = kCMTimeZero;
+    for (size_t k = 0; k < paths.size(); k++) {
+        NSURL* url = [NSURL fileURLWithPath:[NSString stringWithUTF8String:paths[k].c_str()]];
+        AVURLAsset* asset = [AVURLAsset URLAssetWithURL:url
+                                                options:@{AVURLAssetPreferPreciseDurationAndTimingKey: @YES}];
+        AVAssetTrack* source = [[asset tracksWithMediaType:AVMediaTypeVideo] firstObject];
+        if (!source) {
+            error = "Segment " + std::to_string(k) + " has no video track";
+            return false;
+        }
+        const CMTime duration = CMTimeMake(static_cast<int64_t>(frameCounts[k]), framerate);
+        NSError* insertError = nil;
+        if (![track insertTimeRange:CMTimeRangeMake(kCMTimeZero, duration)
+                            ofTrack:source
+                             atTime:cursor
+                              error:&insertError]) {
+            error = describe(insertError);
+            return false;
+        }
+        cursor = CMTimeAdd(cursor, duration);
+    }
+
+    NSURL* outputURL = [NSURL fileURLWithPath:[NSString stringWithUTF8String:outputPath.c_str()]];
+    [[NSFileManager defaultManager] removeItemAtURL:outputURL error:nil];
+
+    AVAssetExportSession* session = [[AVAssetExportSession alloc] initWithAsset:composition
+                                                                     presetName:AVAssetExportPresetPassthrough];
+    session.outputURL = outputURL;
+    session.outputFileType = AVFileTypeQuickTimeMovie;
+
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [session exportAsynchronouslyWithCompletionHandler:^{
+        dispatch_semaphore_signal(semaphore);
+    }];
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+
+    if (session.status != AVAssetExportSessionStatusCompleted) {
+        error = describe(session.error);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
 // ============================================================================
 // Implementation
 // ============================================================================
@@ -42,6 +142,9 @@ struct VideoExporter::Impl {
     bool hasError_ = false;
     std::string lastError_;
 
+    // Frames read back asynchronously, appended in order as they arrive
+    std::deque<std::future<ofPixels>> pendingFrames_;
+
     // Progress callback
     ProgressCallback progressCallback_;
 
@@ -50,28 +153,15 @@ struct VideoExporter::Impl {
     size_t estimatedFileSize_ = 0;
     float encodingSpeed_ = 0.0f;
 
-    // Metal resources for texture conversion
-    id<MTLDevice> device_ = nil;
-    id<MTLCommandQueue> commandQueue_ = nil;
-
     // ========================================================================
     // Constructor / Destructor
     // ========================================================================
 
-    Impl() {
-        @autoreleasepool {
-            device_ = MTLCreateSystemDefaultDevice();
-            if (device_) {
-                commandQueue_ = [device_ newCommandQueue];
-            }
-        }
-    }
+    Impl() = default;
 
     ~Impl() {
         @autoreleasepool {
             cleanup();
-            commandQueue_ = nil;
-            device_ = nil;
         }
     }
 
@@ -128,71 +218,17 @@ struct VideoExporter::Impl {
                 height = settings_.customHeight;
             }
 
-            // Create output URL
-            NSString* path = [NSString stringWithUTF8String:outputPath.c_str()];
-            NSURL* outputURL = [NSURL fileURLWithPath:path];
-
-            // Delete existing file if present
-            [[NSFileManager defaultManager] removeItemAtURL:outputURL error:nil];
-
-            // Create asset writer
-            NSError* error = nil;
-            assetWriter_ = [[AVAssetWriter alloc] initWithURL:outputURL
-                                                      fileType:AVFileTypeQuickTimeMovie
-                                                         error:&error];
-            if (error) {
-                lastError_ = std::string([[error localizedDescription] UTF8String]);
-                hasError_ = true;
-                status_ = ExportStatus::Error;
-                return false;
-            }
-
-            // Configure video settings
-            NSMutableDictionary* videoSettings = [NSMutableDictionary dictionary];
-            videoSettings[AVVideoWidthKey] = @(width);
-            videoSettings[AVVideoHeightKey] = @(height);
-
-            // Codec configuration
-            configureCodec(videoSettings, width, height);
-
-            // Create writer input
-            writerInput_ = [[AVAssetWriterInput alloc] initWithMediaType:AVMediaTypeVideo
-                                                          outputSettings:videoSettings];
-            writerInput_.expectsMediaDataInRealTime = NO;
-
-            // Create pixel buffer adaptor
-            NSDictionary* pixelBufferAttributes = @{
-                (NSString*)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
-                (NSString*)kCVPixelBufferWidthKey: @(width),
-                (NSString*)kCVPixelBufferHeightKey: @(height),
-                (NSString*)kCVPixelBufferMetalCompatibilityKey: @YES,
-            };
-
-            pixelBufferAdaptor_ = [[AVAssetWriterInputPixelBufferAdaptor alloc]
-                                  initWithAssetWriterInput:writerInput_
-                                  sourcePixelBufferAttributes:pixelBufferAttributes];
-
-            // Add input to writer
-            if ([assetWriter_ canAddInput:writerInput_]) {
-                [assetWriter_ addInput:writerInput_];
-            } else {
-                lastError_ = "Cannot add video input to asset writer";
+            WriterSession session;
+            std::string error;
+            if (!createWriter(outputPath, width, height, session, error)) {
+                lastError_ = error;
                 hasError_ = true;
                 status_ = ExportStatus::Error;
-                cleanup();
-                return false;
-            }
-
-            // Start writing
-            if (![assetWriter_ startWriting]) {
-                lastError_ = std::string([[assetWriter_.error localizedDescription] UTF8String]);
-                hasError_ = true;
-                status_ = ExportStatus::Error;
-                cleanup();
                 return false;
             }
-
-            [assetWriter_ startSessionAtSourceTime:kCMTimeZero];
+            assetWriter_ = session.writer;
+            writerInput_ = session.input;
+            pixelBufferAdaptor_ = session.adaptor;
 
             status_ = ExportStatus::Encoding;
             startTime_ = std::chrono::steady_clock::now();
@@ -205,121 +241,64 @@ struct VideoExporter::Impl {
     }
 
     bool addFrame(const ofTexture& texture) {
-        @autoreleasepool {
-            if (status_ != ExportStatus::Encoding) {
-                lastError_ = "Not in encoding state";
-                hasError_ = true;
-                return false;
-            }
-
-            // Wait for writer to be ready
-            while (!writerInput_.readyForMoreMediaData) {
-                [NSThread sleepForTimeInterval:0.01];
-            }
-
-            // Get texture dimensions
-            size_t width = texture.getWidth();
-            size_t height = texture.getHeight();
+        if (status_ != ExportStatus::Encoding) {
+            lastError_ = "Not in encoding state";
+            hasError_ = true;
+            return false;
+        }
 
-            // Create pixel buffer
-            CVPixelBufferRef pixelBuffer = nullptr;
-            CVReturn status = CVPixelBufferPoolCreatePixelBuffer(nullptr,
-                                                                 pixelBufferAdaptor_.pixelBufferPool,
-                                                                 &pixelBuffer);
-            if (status != kCVReturnSuccess) {
-                lastError_ = "Failed to create pixel buffer";
-                hasError_ = true;
-                return false;
-            }
+        // Copied after this frame's drawing into the texture, without
+        // stalling on the GPU; encoded once the pixels arrive
+        std::future<ofPixels> frame = texture.readToPixelsAsync();
+        if (!frame.valid()) {
+            lastError_ = "Texture can't be read back";
+            hasError_ = true;
+            return false;
+        }
+        pendingFrames_.push_back(std::move(frame));
+        return appendReadyFrames(std::chrono::milliseconds(0));
+    }
 
-            // Lock pixel buffer
-            CVPixelBufferLockBaseAddress(pixelBuffer, 0);
-            void* baseAddress = CVPixelBufferGetBaseAddress(pixelBuffer);
-            size_t bytesPerRow = CVPixelBufferGetBytesPerRow(pixelBuffer);
+    bool addFrame(const ofPixels& pixels) {
+        if (status_ != ExportStatus::Encoding) {
+            lastError_ = "Not in encoding state";
+            hasError_ = true;
+            return false;
+        }
+        if (pendingFrames_.empty()) {
+            return appendPixels(pixels);
+        }
 
-            // Read texture pixels via Metal blit
-            id<MTLTexture> metalTexture = (__bridge id<MTLTexture>)texture.getNativeHandle();
-            if (metalTexture) {
-                // Create temporary texture for readback
-                MTLTextureDescriptor* desc = [MTLTextureDescriptor
-                    texture2DDescriptorWithPixelFormat:MTLPixelFormatBGRA8Unorm
-                                                 width:width
-                                                height:height
-                                             mipmapped:NO];
-                desc.usage = MTLTextureUsageShaderRead | MTLTextureUsageRenderTarget;
-                desc.storageMode = MTLStorageModeManaged;
-
-                id<MTLTexture> tempTexture = [device_ newTextureWithDescriptor:desc];
-
-                // Blit texture
-                id<MTLCommandBuffer> commandBuffer = [commandQueue_ commandBuffer];
-                id<MTLBlitCommandEncoder> blitEncoder = [commandBuffer blitCommandEncoder];
-
-                [blitEncoder copyFromTexture:metalTexture
-                                 sourceSlice:0
-                                 sourceLevel:0
-                                sourceOrigin:MTLOriginMake(0, 0, 0)
-                                  sourceSize:MTLSizeMake(width, height, 1)
-                                   toTexture:tempTexture
-                            destinationSlice:0
-                            destinationLevel:0
-                           destinationOrigin:MTLOriginMake(0, 0, 0)];
-
-                [blitEncoder synchronizeResource:tempTexture];
-                [blitEncoder endEncoding];
-                [commandBuffer commit];
-                [commandBuffer waitUntilCompleted];
+        // Keep frame order behind texture frames still being read back
+        std::promise<ofPixels> ready;
+        ready.set_value(pixels);
+        pendingFrames_.push_back(ready.get_future());
+        return appendReadyFrames(std::chrono::milliseconds(0));
+    }
 
-                // Copy to pixel buffer
-                [tempTexture getBytes:baseAddress
-                          bytesPerRow:bytesPerRow
-                           fromRegion:MTLRegionMake2D(0, 0, width, height)
-                          mipmapLevel:0];
+    // Append pending frames whose pixels have arrived, waiting up to timeout
+    // for each; stops at the first one still in flight
+    bool appendReadyFrames(std::chrono::milliseconds timeout) {
+        bool success = true;
+        while (!pendingFrames_.empty()) {
+            if (pendingFrames_.front().wait_for(timeout) != std::future_status::ready) {
+                break;
             }
-
-            CVPixelBufferUnlockBaseAddress(pixelBuffer, 0);
-
-            // Calculate presentation time
-            CMTime presentationTime = CMTimeMake(frameIndex_, settings_.framerate);
-
-            // Append pixel buffer
-            BOOL success = [pixelBufferAdaptor_ appendPixelBuffer:pixelBuffer
-                                             withPresentationTime:presentationTime];
-
-            CVPixelBufferRelease(pixelBuffer);
-
-            if (!success) {
-                lastError_ = "Failed to append pixel buffer";
+            ofPixels pixels = pendingFrames_.front().get();
+            pendingFrames_.pop_front();
+            if (!pixels.isAllocated()) {
+                lastError_ = "Frame readback failed";
                 hasError_ = true;
-                return false;
-            }
-
-            frameIndex_++;
-
-            // Update statistics
-            updateStatistics();
-
-            // Call progress callback
-            if (progressCallback_) {
-                float progress = 0.0f;
-                if (expectedTotalFrames_ > 0) {
-                    progress = static_cast<float>(frameIndex_) / static_cast<float>(expectedTotalFrames_);
-                }
-                progressCallback_(progress, frameIndex_, expectedTotalFrames_);
+                success = false;
+                continue;
             }
-
-            return true;
+            success = appendPixels(pixels) && success;
         }
+        return success;
     }
 
-    bool addFrame(const ofPixels& pixels) {
+    bool appendPixels(const ofPixels& pixels) {
         @autoreleasepool {
-            if (status_ != ExportStatus::Encoding) {
-                lastError_ = "Not in encoding state";
-                hasError_ = true;
-                return false;
-            }
-
             // Wait for writer to be ready
             while (!writerInput_.readyForMoreMediaData) {
                 [NSThread sleepForTimeInterval:0.01];
@@ -415,27 +394,22 @@ struct VideoExporter::Impl {
                 return false;
             }
 
-            status_ = ExportStatus::Finalizing;
+            // Frames of earlier render frames are in flight at most a few
+            // frames; one recorded this frame only renders after draw()
+            // returns and can't be waited for here
+            appendReadyFrames(std::chrono::milliseconds(500));
+            if (!pendingFrames_.empty()) {
+                lastError_ = "Frames still being read back were dropped; end the export a frame after the last addFrame()";
+                hasError_ = true;
+                pendingFrames_.clear();
+            }
 
-            // Finish writing
-            [writerInput_ markAsFinished];
+            status_ = ExportStatus::Finalizing;
 
             // Finalize asset writer (this may take time)
-            __block BOOL success = NO;
-            __block NSError* error = nil;
-
-            dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
-
-            [assetWriter_ finishWritingWithCompletionHandler:^{
-                success = (assetWriter_.status == AVAssetWriterStatusCompleted);
-                error = assetWriter_.error;
-                dispatch_semaphore_signal(semaphore);
-            }];
-
-            dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
-
-            if (!success) {
-                lastError_ = error ? std::string([[error localizedDescription] UTF8String]) : "Unknown error";
+            std::string error;
+            if (!finishWriter({assetWriter_, writerInput_, pixelBufferAdaptor_}, error)) {
+                lastError_ = error;
                 hasError_ = true;
                 status_ = ExportStatus::Error;
                 cleanup();
@@ -468,6 +442,7 @@ struct VideoExporter::Impl {
             }
 
             [assetWriter_ cancelWriting];
+            pendingFrames_.clear();
             status_ = ExportStatus::Cancelled;
 
             // Delete incomplete file
@@ -488,32 +463,431 @@ struct VideoExporter::Impl {
                     const CameraPath& cameraPath,
                     const std::string& outputPath,
                     const VideoExportSettings& settings) {
-        // This is a high-level convenience method
-        // In a real implementation, this would:
-        // 1. Setup renderer and FBO
-        // 2. Iterate through camera path
-        // 3. Render each frame
-        // 4. Add frame to exporter
-        // For now, return error as it requires full renderer integration
-        lastError_ = "exportScene not yet implemented - use manual frame export";
-        hasError_ = true;
-        return false;
+        // Scenes don't compose transformed objects yet (see SharpScene::render),
+        // so a scene renders through its single visible cloud
+        const GaussianCloud* visible = nullptr;
+        for (ObjectID id : scene.getObjectIDs()) {
+            const SceneObject* object = scene.getObject(id);
+            if (!object || !object->visible) {
+                continue;
+            }
+            if (visible) {
+                lastError_ = "exportScene renders one visible cloud; hide the others or render them manually";
+                hasError_ = true;
+                return false;
+            }
+            visible = scene.getCloud(id);
+        }
+        if (!visible) {
+            lastError_ = "Scene has no visible cloud";
+            hasError_ = true;
+            return false;
+        }
+        return exportCloud(*visible, cameraPath, outputPath, settings);
     }
 
     bool exportCloud(const GaussianCloud& cloud,
                     const CameraPath& cameraPath,
                     const std::string& outputPath,
                     const VideoExportSettings& settings) {
-        // Similar to exportScene - requires renderer integration
-        lastError_ = "exportCloud not yet implemented - use manual frame export";
-        hasError_ = true;
-        return false;
+        @autoreleasepool {
+            if (!setup(settings)) {
+                return false;
+            }
+            if (!cameraPath.isConfigured() || cameraPath.getDuration() <= 0.0f) {
+                lastError_ = "Camera path is not configured";
+                hasError_ = true;
+                return false;
+            }
+
+            id<MTLDevice> device = (__bridge id<MTLDevice>)::Context::instance().getMetalDevice();
+            if (!device) {
+                lastError_ = "No Metal device";
+                hasError_ = true;
+                return false;
+            }
+
+            const size_t totalFrames = std::max<size_t>(
+                1, static_cast<size_t>(std::ceil(cameraPath.getDuration() * settings_.framerate)));
+            expectedTotalFrames_ = totalFrames;
+
+            // Fixed timestep: frame i shows the path at i / framerate
+            const std::vector<CameraPathSample> samples =
+                cameraPath.sampleFrames(totalFrames, static_cast<float>(settings_.framerate));
+
+            size_t width = 0, height = 0;
+            getResolutionDimensions(settings_.resolution, width, height);
+            if (settings_.resolution == VideoResolution::Custom) {
+                width = settings_.customWidth;
+                height = settings_.customHeight;
+            }
+
+            const size_t segments = std::min(std::max<size_t>(1, settings_.segments), totalFrames);
+            if (segments > 1) {
+                return exportSegments(device, cloud, cameraPath, samples, segments, outputPath, width, height);
+            }
+
+            if (!beginExport(outputPath)) {
+                return false;
+            }
+            std::atomic<bool> stop{false};
+            std::string failure;
+            const bool rendered = renderFrames(device, cloud, cameraPath, samples.data(), totalFrames,
+                                               width, height, {assetWriter_, writerInput_, pixelBufferAdaptor_},
+                                               stop, [this, totalFrames]() {
+                frameIndex_++;
+                updateStatistics();
+                if (progressCallback_) {
+                    progressCallback_(static_cast<float>(frameIndex_) / totalFrames, frameIndex_, totalFrames);
+                }
+            }, failure);
+
+            if (!rendered) {
+                cancelExport();
+                lastError_ = failure;
+                hasError_ = true;
+                status_ = ExportStatus::Error;
+                return false;
+            }
+            return endExport();
+        }
+    }
+
+    // Split the timeline into segments, render and encode them concurrently
+    // into writers of their own, then join them without re-encoding
+    bool exportSegments(id<MTLDevice> device,
+                        const GaussianCloud& cloud,
+                        const CameraPath& cameraPath,
+                        const std::vector<CameraPathSample>& samples,
+                        size_t segmentCount,
+                        const std::string& outputPath,
+                        size_t width,
+                        size_t height) {
+        if (status_ != ExportStatus::Idle) {
+            lastError_ = "Export already in progress";
+            hasError_ = true;
+            return false;
+        }
+
+        status_ = ExportStatus::Preparing;
+        outputPath_ = outputPath;
+        frameIndex_ = 0;
+        estimatedFileSize_ = 0;
+        encodingSpeed_ = 0.0f;
+
+        // Segment k covers frames [first[k], first[k + 1])
+        const size_t totalFrames = samples.size();
+        std::vector<size_t> first(segmentCount + 1);
+        std::vector<size_t> frameCounts(segmentCount);
+        std::vector<std::string> paths(segmentCount);
+        std::vector<WriterSession> sessions(segmentCount);
+        for (size_t k = 0; k <= segmentCount; k++) {
+            first[k] = totalFrames * k / segmentCount;
+        }
+
+        auto discard = [&](const std::string& error) {
+            for (size_t k = 0; k < segmentCount; k++) {
+                if (sessions[k].writer && sessions[k].writer.status == AVAssetWriterStatusWriting) {
+                    [sessions[k].writer cancelWriting];
+                }
+                removeFile(paths[k]);
+            }
+            lastError_ = error;
+            hasError_ = true;
+            status_ = ExportStatus::Error;
+            return false;
+        };
+
+        for (size_t k = 0; k < segmentCount; k++) {
+            frameCounts[k] = first[k + 1] - first[k];
+            paths[k] = segmentPath(outputPath, k);
+            std::string error;
+            if (!createWriter(paths[k], width, height, sessions[k], error)) {
+                return discard(error);
+            }
+        }
+
+        status_ = ExportStatus::Encoding;
+        startTime_ = std::chrono::steady_clock::now();
+        os_log_info(OS_LOG_DEFAULT, "VideoExporter: Started segmented export to %s (%zux%zu, %d fps, %zu segments)",
+                   outputPath.c_str(), width, height, settings_.framerate, segmentCount);
+
+        // Segments report progress from their own encode queues
+        std::mutex progressMutex;
+        auto onFrame = [&]() {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            frameIndex_++;
+            updateStatistics();
+            if (progressCallback_) {
+                progressCallback_(static_cast<float>(frameIndex_) / totalFrames, frameIndex_, totalFrames);
+            }
+        };
+
+        std::atomic<bool> stop{false};
+        std::vector<std::string> errors(segmentCount);
+        std::vector<std::thread> threads;
+        for (size_t k = 0; k < segmentCount; k++) {
+            threads.emplace_back([&, k]() {
+                @autoreleasepool {
+                    if (!renderFrames(device, cloud, cameraPath, samples.data() + first[k], frameCounts[k],
+                                      width, height, sessions[k], stop, onFrame, errors[k])) {
+                        stop = true;
+                        return;
+                    }
+                    if (stop) {
+                        return;
+                    }
+                    // Ends exactly where the next segment starts
+                    [sessions[k].writer endSessionAtSourceTime:
+                        CMTimeMake(static_cast<int64_t>(frameCounts[k]), settings_.framerate)];
+                    if (!finishWriter(sessions[k], errors[k])) {
+                        stop = true;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        if (stop) {
+            for (const auto& error : errors) {
+                if (!error.empty()) {
+                    return discard(error);
+                }
+            }
+            return discard("Segmented export failed");
+        }
+
+        status_ = ExportStatus::Finalizing;
+        std::string error;
+        const bool joined = concatenateSegments(paths, frameCounts, settings_.framerate, outputPath, error);
+        for (const auto& path : paths) {
+            removeFile(path);
+        }
+        sessions.clear();
+        if (!joined) {
+            lastError_ = error;
+            hasError_ = true;
+            status_ = ExportStatus::Error;
+            return false;
+        }
+
+        const float elapsedSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime_).count();
+        NSDictionary* attrs = [[NSFileManager defaultManager]
+                               attributesOfItemAtPath:[NSString stringWithUTF8String:outputPath.c_str()] error:nil];
+        estimatedFileSize_ = [attrs fileSize];
+        status_ = ExportStatus::Completed;
+
+        os_log_info(OS_LOG_DEFAULT, "VideoExporter: Export completed - %zu frames in %zu segments, %.2f seconds (%.1f fps, %zu MB)",
+                   frameIndex_, segmentCount, elapsedSeconds, frameIndex_ / elapsedSeconds, estimatedFileSize_ / (1024 * 1024));
+        return true;
+    }
+
+    // Render count samples into a writer, on a command queue of its own so
+    // offline frames never wait behind the display. The GPU renders up to
+    // framesInFlight frames ahead of the encoder; frame i is presented at
+    // i / framerate and onFrame runs on the encode queue after each append.
+    // Stops early once stop is set, and sets it on failure.
+    bool renderFrames(id<MTLDevice> device,
+                      const GaussianCloud& cloud,
+                      const CameraPath& cameraPath,
+                      const CameraPathSample* samples,
+                      size_t count,
+                      size_t width,
+                      size_t height,
+                      const WriterSession& session,
+                      std::atomic<bool>& stop,
+                      const std::function<void()>& onFrame,
+                      std::string& error) {
+        id<MTLCommandQueue> queue = [device newCommandQueue];
+        queue.label = @"Sharp Offline Render";
+        SharpRenderer renderer;
+        if (!renderer.initialize((__bridge void*)device, (__bridge void*)queue)) {
+            error = "Failed to initialize renderer";
+            return false;
+        }
+
+        // Frames render straight into the encoder's pooled buffers
+        CVMetalTextureCacheRef textureCache = nullptr;
+        NSDictionary* textureAttributes = @{
+            (NSString*)kCVMetalTextureUsage: @(MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead),
+        };
+        if (CVMetalTextureCacheCreate(kCFAllocatorDefault, nil, device,
+                                      (__bridge CFDictionaryRef)textureAttributes,
+                                      &textureCache) != kCVReturnSuccess) {
+            error = "Failed to create texture cache";
+            return false;
+        }
+
+        ofCamera camera;
+        camera.setAspectRatio(static_cast<float>(width) / static_cast<float>(height));
+
+        MTLRenderPassDescriptor* clearPass = [MTLRenderPassDescriptor renderPassDescriptor];
+        clearPass.colorAttachments[0].loadAction = MTLLoadActionClear;
+        clearPass.colorAttachments[0].storeAction = MTLStoreActionStore;
+        clearPass.colorAttachments[0].clearColor = MTLClearColorMake(0, 0, 0, settings_.exportAlpha ? 0 : 1);
+
+        AVAssetWriter* writer = session.writer;
+        AVAssetWriterInput* input = session.input;
+        AVAssetWriterInputPixelBufferAdaptor* adaptor = session.adaptor;
+        const int framerate = settings_.framerate;
+
+        // Slots are returned once a frame is appended
+        const size_t inFlight = std::max<size_t>(1, settings_.framesInFlight);
+        dispatch_semaphore_t slots = dispatch_semaphore_create(static_cast<long>(inFlight));
+        dispatch_queue_t encodeQueue = dispatch_queue_create("com.oflike.sharp.offlineExport", DISPATCH_QUEUE_SERIAL);
+        dispatch_group_t pending = dispatch_group_create();
+        __block bool failed = false;            // Encode queue only
+        __block std::string failure;
+        std::atomic<bool>* stopFlag = &stop;
+
+        for (size_t i = 0; i < count && !stop; i++) {
+            dispatch_semaphore_wait(slots, DISPATCH_TIME_FOREVER);
+            @autoreleasepool {
+                CVPixelBufferRef pixelBuffer = nullptr;
+                CVMetalTextureRef metalTexture = nullptr;
+                if (CVPixelBufferPoolCreatePixelBuffer(nullptr, adaptor.pixelBufferPool,
+                                                       &pixelBuffer) != kCVReturnSuccess ||
+                    CVMetalTextureCacheCreateTextureFromImage(kCFAllocatorDefault, textureCache, pixelBuffer,
+                                                              nil, MTLPixelFormatBGRA8Unorm, width, height,
+                                                              0, &metalTexture) != kCVReturnSuccess) {
+                    CVPixelBufferRelease(pixelBuffer);
+                    dispatch_sync(encodeQueue, ^{
+                        failed = true;
+                        failure = "Failed to create frame buffer";
+                    });
+                    dispatch_semaphore_signal(slots);
+                    break;
+                }
+                id<MTLTexture> target = CVMetalTextureGetTexture(metalTexture);
+
+                cameraPath.applyToCamera(samples[i], camera);
+
+                id<MTLCommandBuffer> commandBuffer = [queue commandBuffer];
+                commandBuffer.label = @"Sharp Offline Frame";
+                clearPass.colorAttachments[0].texture = target;
+                [[commandBuffer renderCommandEncoderWithDescriptor:clearPass] endEncoding];
+                const bool encoded = renderer.render(cloud, camera, (__bridge void*)target,
+                                                     (__bridge void*)commandBuffer);
+
+                const CMTime presentationTime = CMTimeMake(static_cast<int64_t>(i), framerate);
+                dispatch_group_enter(pending);
+                [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+                    const bool rendered = encoded && buffer.status == MTLCommandBufferStatusCompleted;
+                    dispatch_async(encodeQueue, ^{
+                        if (!failed && !stopFlag->load()) {
+                            // The encoder is the only thing frames wait on
+                            while (rendered && !input.readyForMoreMediaData &&
+                                   writer.status == AVAssetWriterStatusWriting) {
+                                [NSThread sleepForTimeInterval:0.001];
+                            }
+                            if (!rendered) {
+                                failed = true;
+                                failure = "Frame failed to render";
+                            } else if (![adaptor appendPixelBuffer:pixelBuffer
+                                              withPresentationTime:presentationTime]) {
+                                failed = true;
+                                failure = "Failed to append pixel buffer";
+                            } else {
+                                onFrame();
+                            }
+                            if (failed) {
+                                stopFlag->store(true);
+                            }
+                        }
+                        CFRelease(metalTexture);
+                        CVPixelBufferRelease(pixelBuffer);
+                        dispatch_semaphore_signal(slots);
+                        dispatch_group_leave(pending);
+                    });
+                }];
+                [commandBuffer commit];
+            }
+        }
+
+        dispatch_group_wait(pending, DISPATCH_TIME_FOREVER);
+        CVMetalTextureCacheFlush(textureCache, 0);
+        CFRelease(textureCache);
+
+        if (failed) {
+            stop = true;
+            error = failure;
+            return false;
+        }
+        return true;
     }
 
     // ========================================================================
     // Helper Methods
     // ========================================================================
 
+    // Create a writer for the current settings, writing from time zero
+    bool createWriter(const std::string& outputPath, size_t width, size_t height,
+                      WriterSession& session, std::string& error) {
+        // Create output URL
+        NSString* path = [NSString stringWithUTF8String:outputPath.c_str()];
+        NSURL* outputURL = [NSURL fileURLWithPath:path];
+
+        // Delete existing file if present
+        [[NSFileManager defaultManager] removeItemAtURL:outputURL error:nil];
+
+        // Create asset writer
+        NSError* writerError = nil;
+        AVAssetWriter* writer = [[AVAssetWriter alloc] initWithURL:outputURL
+                                                          fileType:AVFileTypeQuickTimeMovie
+                                                             error:&writerError];
+        if (writerError) {
+            error = describe(writerError);
+            return false;
+        }
+
+        // Configure video settings
+        NSMutableDictionary* videoSettings = [NSMutableDictionary dictionary];
+        videoSettings[AVVideoWidthKey] = @(width);
+        videoSettings[AVVideoHeightKey] = @(height);
+
+        // Codec configuration
+        configureCodec(videoSettings, width, height);
+
+        // Create writer input
+        AVAssetWriterInput* input = [[AVAssetWriterInput alloc] initWithMediaType:AVMediaTypeVideo
+                                                                   outputSettings:videoSettings];
+        input.expectsMediaDataInRealTime = NO;
+
+        // Create pixel buffer adaptor
+        NSDictionary* pixelBufferAttributes = @{
+            (NSString*)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
+            (NSString*)kCVPixelBufferWidthKey: @(width),
+            (NSString*)kCVPixelBufferHeightKey: @(height),
+            (NSString*)kCVPixelBufferMetalCompatibilityKey: @YES,
+            (NSString*)kCVPixelBufferIOSurfacePropertiesKey: @{},
+        };
+
+        AVAssetWriterInputPixelBufferAdaptor* adaptor = [[AVAssetWriterInputPixelBufferAdaptor alloc]
+                                                        initWithAssetWriterInput:input
+                                                        sourcePixelBufferAttributes:pixelBufferAttributes];
+
+        // Add input to writer
+        if (![writer canAddInput:input]) {
+            error = "Cannot add video input to asset writer";
+            return false;
+        }
+        [writer addInput:input];
+
+        // Start writing
+        if (![writer startWriting]) {
+            error = describe(writer.error);
+            return false;
+        }
+        [writer startSessionAtSourceTime:kCMTimeZero];
+
+        session.writer = writer;
+        session.input = input;
+        session.adaptor = adaptor;
+        return true;
+    }
+
     void configureCodec(NSMutableDictionary* videoSettings, size_t width, size_t height) {
         switch (settings_.codec) {
             case VideoCodec::H264: {
@@ -8,60 +8,145 @@ public protocol GuiParameter {
     var group: String { get }
 }
 
+// MARK: - Parameter Block
+
+/// A parameter's slot in the block shared with C++ (ofxGuiParameterBlock.h)
+/// Panel edits are published through the slot's seqlock and read by
+/// ofxGuiGroup::sync(); poll() picks up values the app changed. Neither side
+/// sends a message per value.
+public final class GuiSlot {
+    private let pointer: UnsafeMutablePointer<OFLGuiSlot>
+    private var seen: UInt32
+
+    init?(index: Int) {
+        guard index >= 0, index < Int(OFL_GUI_MAX_SLOTS), let block = OFLGuiParameterBlock() else {
+            return nil
+        }
+        pointer = block + index
+        seen = OFLGuiSlotVersion(pointer)
+    }
+
+    func write(_ values: [Double]) {
+        values.withUnsafeBufferPointer { buffer in
+            OFLGuiSlotWrite(pointer, buffer.baseAddress, UInt32(buffer.count), UInt32(OFL_GUI_WRITER_PANEL))
+        }
+        seen = OFLGuiSlotVersion(pointer)
+    }
+
+    /// Values the app wrote since the last write or poll, or nil
+    func poll(count: Int) -> [Double]? {
+        guard OFLGuiSlotVersion(pointer) != seen else { return nil }
+        var values = [Double](repeating: 0, count: count)
+        var writer: UInt32 = 0
+        seen = OFLGuiSlotRead(pointer, &values, UInt32(count), &writer)
+        return writer == UInt32(OFL_GUI_WRITER_APP) ? values : nil
+    }
+}
+
+/// A parameter whose value lives in a slot of the parameter block
+protocol GuiSlotParameter: AnyObject {
+    func pollSlot()
+}
+
 /// Float parameter with range for GUI
-public class GuiFloatParameter: ObservableObject, GuiParameter {
+public class GuiFloatParameter: ObservableObject, GuiParameter, GuiSlotParameter {
     public let name: String
     public let group: String
-    @Published public var value: Float
+    @Published public var value: Float {
+        didSet { if !polling { slot?.write([Double(value)]) } }
+    }
     public let min: Float
     public let max: Float
+    let slot: GuiSlot?
+    private var polling = false
 
-    public init(name: String, group: String, value: Float, min: Float = 0.0, max: Float = 1.0) {
+    public init(name: String, group: String, value: Float, min: Float = 0.0, max: Float = 1.0, slot: Int = -1) {
         self.name = name
         self.group = group
         self.value = value
         self.min = min
         self.max = max
+        self.slot = GuiSlot(index: slot)
+    }
+
+    func pollSlot() {
+        guard let values = slot?.poll(count: 1) else { return }
+        polling = true
+        value = Float(values[0])
+        polling = false
     }
 }
 
 /// Int parameter with range for GUI
-public class GuiIntParameter: ObservableObject, GuiParameter {
+public class GuiIntParameter: ObservableObject, GuiParameter, GuiSlotParameter {
     public let name: String
     public let group: String
-    @Published public var value: Int
+    @Published public var value: Int {
+        didSet { if !polling { slot?.write([Double(value)]) } }
+    }
     public let min: Int
     public let max: Int
+    let slot: GuiSlot?
+    private var polling = false
 
-    public init(name: String, group: String, value: Int, min: Int = 0, max: Int = 100) {
+    public init(name: String, group: String, value: Int, min: Int = 0, max: Int = 100, slot: Int = -1) {
         self.name = name
         self.group = group
         self.value = value
         self.min = min
         self.max = max
+        self.slot = GuiSlot(index: slot)
+    }
+
+    func pollSlot() {
+        guard let values = slot?.poll(count: 1) else { return }
+        polling = true
+        value = Int(values[0])
+        polling = false
     }
 }
 
 /// Boolean parameter for GUI
-public class GuiBoolParameter: ObservableObject, GuiParameter {
+public class GuiBoolParameter: ObservableObject, GuiParameter, GuiSlotParameter {
     public let name: String
     public let group: String
-    @Published public var value: Bool
+    @Published public var value: Bool {
+        didSet { if !polling { slot?.write([value ? 1.0 : 0.0]) } }
+    }
+    let slot: GuiSlot?
+    private var polling = false
 
-    public init(name: String, group: String, value: Bool) {
+    public init(name: String, group: String, value: Bool, slot: Int = -1) {
         self.name = name
         self.group = group
         self.value = value
+        self.slot = GuiSlot(index: slot)
+    }
+
+    func pollSlot() {
+        guard let values = slot?.poll(count: 1) else { return }
+        polling = true
+        value = values[0] != 0.0
+        polling = false
     }
 }
 
 /// Color parameter for GUI (RGB 0-255)
-public class GuiColorParameter: ObservableObject, GuiParameter {
+public class GuiColorParameter: ObservableObject, GuiParameter, GuiSlotParameter {
     public let name: String
     public let group: String
-    @Published public var color: Color
+    @Published public var color: Color {
+        didSet {
+            if !polling {
+                let rgb = self.rgb
+                slot?.write([Double(rgb.r), Double(rgb.g), Double(rgb.b)])
+            }
+        }
+    }
+    let slot: GuiSlot?
+    private var polling = false
 
-    public init(name: String, group: String, r: Int, g: Int, b: Int) {
+    public init(name: String, group: String, r: Int, g: Int, b: Int, slot: Int = -1) {
         self.name = name
         self.group = group
         self.color = Color(
@@ -69,6 +154,14 @@ public class GuiColorParameter: ObservableObject, GuiParameter {
             green: Double(g) / 255.0,
             blue: Double(b) / 255.0
         )
+        self.slot = GuiSlot(index: slot)
+    }
+
+    func pollSlot() {
+        guard let values = slot?.poll(count: 3) else { return }
+        polling = true
+        color = Color(red: values[0] / 255.0, green: values[1] / 255.0, blue: values[2] / 255.0)
+        polling = false
     }
 
     /// Get RGB values as 0-255 integers
@@ -126,38 +219,66 @@ public class GuiParameterStore: ObservableObject {
     @Published public var buttonParams: [GuiButtonParameter] = []
     @Published public var stringParams: [GuiStringParameter] = []
 
+    // Parameters backed by the parameter block, polled for app changes
+    private var slotParams: [GuiSlotParameter] = []
+    private var pollTimer: Timer?
+
     private init() {}
 
     // MARK: - Registration Methods
 
     /// Register a float parameter
-    public func registerFloat(name: String, group: String = "General", value: Float, min: Float = 0.0, max: Float = 1.0) -> GuiFloatParameter {
-        let param = GuiFloatParameter(name: name, group: group, value: value, min: min, max: max)
+    /// slot is its index in the parameter block, or -1 for none
+    public func registerFloat(name: String, group: String = "General", value: Float, min: Float = 0.0, max: Float = 1.0, slot: Int = -1) -> GuiFloatParameter {
+        let param = GuiFloatParameter(name: name, group: group, value: value, min: min, max: max, slot: slot)
         floatParams.append(param)
+        addSlotParameter(param, hasSlot: param.slot != nil)
         return param
     }
 
     /// Register an int parameter
-    public func registerInt(name: String, group: String = "General", value: Int, min: Int = 0, max: Int = 100) -> GuiIntParameter {
-        let param = GuiIntParameter(name: name, group: group, value: value, min: min, max: max)
+    public func registerInt(name: String, group: String = "General", value: Int, min: Int = 0, max: Int = 100, slot: Int = -1) -> GuiIntParameter {
+        let param = GuiIntParameter(name: name, group: group, value: value, min: min, max: max, slot: slot)
         intParams.append(param)
+        addSlotParameter(param, hasSlot: param.slot != nil)
         return param
     }
 
     /// Register a boolean parameter
-    public func registerBool(name: String, group: String = "General", value: Bool) -> GuiBoolParameter {
-        let param = GuiBoolParameter(name: name, group: group, value: value)
+    public func registerBool(name: String, group: String = "General", value: Bool, slot: Int = -1) -> GuiBoolParameter {
+        let param = GuiBoolParameter(name: name, group: group, value: value, slot: slot)
         boolParams.append(param)
+        addSlotParameter(param, hasSlot: param.slot != nil)
         return param
     }
 
     /// Register a color parameter
-    public func registerColor(name: String, group: String = "General", r: Int, g: Int, b: Int) -> GuiColorParameter {
-        let param = GuiColorParameter(name: name, group: group, r: r, g: g, b: b)
+    public func registerColor(name: String, group: String = "General", r: Int, g: Int, b: Int, slot: Int = -1) -> GuiColorParameter {
+        let param = GuiColorParameter(name: name, group: group, r: r, g: g, b: b, slot: slot)
         colorParams.append(param)
+        addSlotParameter(param, hasSlot: param.slot != nil)
         return param
     }
 
+    // MARK: - Parameter Block Polling
+
+    /// Show values the app changed in the parameter block
+    /// Runs 30 times a second while parameters have slots; one atomic load
+    /// for each unchanged parameter
+    public func pollSlots() {
+        slotParams.forEach { $0.pollSlot() }
+    }
+
+    private func addSlotParameter(_ param: GuiSlotParameter, hasSlot: Bool) {
+        guard hasSlot else { return }
+        slotParams.append(param)
+        if pollTimer == nil {
+            pollTimer = Timer.scheduledTimer(withTimeInterval: 1.0 / 30.0, repeats: true) { [weak self] _ in
+                self?.pollSlots()
+            }
+        }
+    }
+
     /// Register a button parameter
     public func registerButton(name: String, group: String = "General", action: (() -> Void)? = nil) -> GuiButtonParameter {
         let param = GuiButtonParameter(name: name, group: group, action: action)
@@ -194,6 +315,9 @@ public class GuiParameterStore: ObservableObject {
         colorParams.removeAll()
         buttonParams.removeAll()
         stringParams.removeAll()
+        slotParams.removeAll()
+        pollTimer?.invalidate()
+        pollTimer = nil
     }
 }
 
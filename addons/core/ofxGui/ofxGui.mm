@@ -1,6 +1,8 @@
 #include "ofxGui.h"
+#include "ofxGuiParameterBlock.h"
 #import <Foundation/Foundation.h>
 #import <AppKit/AppKit.h>
+#include <algorithm>
 
 // Forward declaration of Swift class
 // OFLGuiPanel.swift exports GuiParameterStore to Objective-C
@@ -33,6 +35,61 @@ static id getGuiParameterStore() {
     }
 }
 
+// MARK: - Parameter Block
+
+// Slider, toggle and color values live here; the panel is handed each
+// parameter's slot index when it is registered
+static OFLGuiSlot gParameterSlots[OFL_GUI_MAX_SLOTS];
+static uint32_t gNextParameterSlot = 0;
+
+extern "C" OFLGuiSlot* OFLGuiParameterBlock(void) {
+    return gParameterSlots;
+}
+
+// A bound value's slot, and what each side last saw of it
+struct SlotBinding {
+    OFLGuiSlot* slot = nullptr;
+    uint32_t seen = 0;                          // Version last read or written
+    double published[3] = {0.0, 0.0, 0.0};      // Values last read or written
+
+    // Claim the next slot and publish the initial values; -1 when full
+    NSInteger allocate(const double* values, uint32_t count) {
+        if (gNextParameterSlot >= OFL_GUI_MAX_SLOTS) {
+            NSLog(@"ofxGui: parameter block is full (%d slots)", OFL_GUI_MAX_SLOTS);
+            return -1;
+        }
+        const uint32_t index = gNextParameterSlot++;
+        slot = &gParameterSlots[index];
+        publish(values, count);
+        return static_cast<NSInteger>(index);
+    }
+
+    void publish(const double* values, uint32_t count) {
+        OFLGuiSlotWrite(slot, values, count, OFL_GUI_WRITER_APP);
+        seen = OFLGuiSlotVersion(slot);
+        std::copy(values, values + count, published);
+    }
+
+    // Bring the bound value and the slot together: a change made in the
+    // panel is read into values; otherwise a change made by the app to
+    // values is published. Costs one atomic load when neither changed.
+    // Returns true if values were replaced.
+    bool sync(double* values, uint32_t count) {
+        if (!slot) return false;
+        if (OFLGuiSlotVersion(slot) != seen) {
+            double read[3];
+            seen = OFLGuiSlotRead(slot, read, count, nullptr);
+            std::copy(read, read + count, published);
+            std::copy(read, read + count, values);
+            return true;
+        }
+        if (!std::equal(values, values + count, published)) {
+            publish(values, count);
+        }
+        return false;
+    }
+};
+
 // MARK: - ofxGuiGroup Implementation
 
 // Parameter binding structures
@@ -41,6 +98,7 @@ struct FloatParamBinding {
     std::string group;
     float* valuePtr;
     id swiftParam; // GuiFloatParameter reference
+    SlotBinding slot;
 };
 
 struct IntParamBinding {
@@ -48,6 +106,7 @@ struct IntParamBinding {
     std::string group;
     int* valuePtr;
     id swiftParam; // GuiIntParameter reference
+    SlotBinding slot;
 };
 
 struct BoolParamBinding {
@@ -55,6 +114,7 @@ struct BoolParamBinding {
     std::string group;
     bool* valuePtr;
     id swiftParam; // GuiBoolParameter reference
+    SlotBinding slot;
 };
 
 struct ColorParamBinding {
@@ -62,6 +122,7 @@ struct ColorParamBinding {
     std::string group;
     ofColor* colorPtr;
     id swiftParam; // GuiColorParameter reference
+    SlotBinding slot;
 };
 
 struct StringParamBinding {
@@ -108,8 +169,12 @@ void ofxGuiGroup::addSlider(const std::string& name, float& value, float min, fl
             NSString* nsName = [NSString stringWithUTF8String:name.c_str()];
             NSString* nsGroup = [NSString stringWithUTF8String:impl_->name.c_str()];
 
-            SEL selector = NSSelectorFromString(@"registerFloatWithName:group:value:min:max:");
+            SEL selector = NSSelectorFromString(@"registerFloatWithName:group:value:min:max:slot:");
             if ([store respondsToSelector:selector]) {
+                FloatParamBinding binding;
+                const double initial = value;
+                NSInteger slot = binding.slot.allocate(&initial, 1);
+
                 NSMethodSignature* signature = [store methodSignatureForSelector:selector];
                 NSInvocation* invocation = [NSInvocation invocationWithMethodSignature:signature];
                 [invocation setSelector:selector];
@@ -119,6 +184,7 @@ void ofxGuiGroup::addSlider(const std::string& name, float& value, float min, fl
                 [invocation setArgument:&value atIndex:4];
                 [invocation setArgument:&min atIndex:5];
                 [invocation setArgument:&max atIndex:6];
+                [invocation setArgument:&slot atIndex:7];
                 [invocation invoke];
 
                 // Get return value (GuiFloatParameter)
@@ -126,7 +192,6 @@ void ofxGuiGroup::addSlider(const std::string& name, float& value, float min, fl
                 [invocation getReturnValue:&returnValue];
 
                 // Store parameter binding
-                FloatParamBinding binding;
                 binding.name = name;
                 binding.group = impl_->name;
                 binding.valuePtr = &value;
@@ -144,8 +209,12 @@ void ofxGuiGroup::addSlider(const std::string& name, int& value, int min, int ma
             NSString* nsName = [NSString stringWithUTF8String:name.c_str()];
             NSString* nsGroup = [NSString stringWithUTF8String:impl_->name.c_str()];
 
-            SEL selector = NSSelectorFromString(@"registerIntWithName:group:value:min:max:");
+            SEL selector = NSSelectorFromString(@"registerIntWithName:group:value:min:max:slot:");
             if ([store respondsToSelector:selector]) {
+                IntParamBinding binding;
+                const double initial = value;
+                NSInteger slot = binding.slot.allocate(&initial, 1);
+
                 NSMethodSignature* signature = [store methodSignatureForSelector:selector];
                 NSInvocation* invocation = [NSInvocation invocationWithMethodSignature:signature];
                 [invocation setSelector:selector];
@@ -155,6 +224,7 @@ void ofxGuiGroup::addSlider(const std::string& name, int& value, int min, int ma
                 [invocation setArgument:&value atIndex:4];
                 [invocation setArgument:&min atIndex:5];
                 [invocation setArgument:&max atIndex:6];
+                [invocation setArgument:&slot atIndex:7];
                 [invocation invoke];
 
                 // Get return value (GuiIntParameter)
@@ -162,7 +232,6 @@ void ofxGuiGroup::addSlider(const std::string& name, int& value, int min, int ma
                 [invocation getReturnValue:&returnValue];
 
                 // Store parameter binding
-                IntParamBinding binding;
                 binding.name = name;
                 binding.group = impl_->name;
                 binding.valuePtr = &value;
@@ -180,8 +249,12 @@ void ofxGuiGroup::addToggle(const std::string& name, bool& value) {
             NSString* nsName = [NSString stringWithUTF8String:name.c_str()];
             NSString* nsGroup = [NSString stringWithUTF8String:impl_->name.c_str()];
 
-            SEL selector = NSSelectorFromString(@"registerBoolWithName:group:value:");
+            SEL selector = NSSelectorFromString(@"registerBoolWithName:group:value:slot:");
             if ([store respondsToSelector:selector]) {
+                BoolParamBinding binding;
+                const double initial = value ? 1.0 : 0.0;
+                NSInteger slot = binding.slot.allocate(&initial, 1);
+
                 NSMethodSignature* signature = [store methodSignatureForSelector:selector];
                 NSInvocation* invocation = [NSInvocation invocationWithMethodSignature:signature];
                 [invocation setSelector:selector];
@@ -189,6 +262,7 @@ void ofxGuiGroup::addToggle(const std::string& name, bool& value) {
                 [invocation setArgument:&nsName atIndex:2];
                 [invocation setArgument:&nsGroup atIndex:3];
                 [invocation setArgument:&value atIndex:4];
+                [invocation setArgument:&slot atIndex:5];
                 [invocation invoke];
 
                 // Get return value (GuiBoolParameter)
@@ -196,7 +270,6 @@ void ofxGuiGroup::addToggle(const std::string& name, bool& value) {
                 [invocation getReturnValue:&returnValue];
 
                 // Store parameter binding
-                BoolParamBinding binding;
                 binding.name = name;
                 binding.group = impl_->name;
                 binding.valuePtr = &value;
@@ -247,8 +320,12 @@ void ofxGuiGroup::addColor(const std::string& name, ofColor& color) {
             int g = color.g;
             int b = color.b;
 
-            SEL selector = NSSelectorFromString(@"registerColorWithName:group:r:g:b:");
+            SEL selector = NSSelectorFromString(@"registerColorWithName:group:r:g:b:slot:");
             if ([store respondsToSelector:selector]) {
+                ColorParamBinding binding;
+                const double initial[3] = {double(r), double(g), double(b)};
+                NSInteger slot = binding.slot.allocate(initial, 3);
+
                 NSMethodSignature* signature = [store methodSignatureForSelector:selector];
                 NSInvocation* invocation = [NSInvocation invocationWithMethodSignature:signature];
                 [invocation setSelector:selector];
@@ -258,6 +335,7 @@ void ofxGuiGroup::addColor(const std::string& name, ofColor& color) {
                 [invocation setArgument:&r atIndex:4];
                 [invocation setArgument:&g atIndex:5];
                 [invocation setArgument:&b atIndex:6];
+                [invocation setArgument:&slot atIndex:7];
                 [invocation invoke];
 
                 // Get return value (GuiColorParameter)
@@ -265,7 +343,6 @@ void ofxGuiGroup::addColor(const std::string& name, ofColor& color) {
                 [invocation getReturnValue:&returnValue];
 
                 // Store parameter binding
-                ColorParamBinding binding;
                 binding.name = name;
                 binding.group = impl_->name;
                 binding.colorPtr = &color;
@@ -312,78 +389,42 @@ void ofxGuiGroup::addLabel(const std::string& name, std::string& value) {
 }
 
 void ofxGuiGroup::sync() {
-    @autoreleasepool {
-        // Sync float parameters
-        for (auto& binding : impl_->floatBindings) {
-            if (binding.swiftParam && binding.valuePtr) {
-                SEL selector = NSSelectorFromString(@"value");
-                if ([binding.swiftParam respondsToSelector:selector]) {
-                    #pragma clang diagnostic push
-                    #pragma clang diagnostic ignored "-Warc-performSelector-leaks"
-                    NSNumber* num = [binding.swiftParam performSelector:selector];
-                    #pragma clang diagnostic pop
-                    if (num) {
-                        *binding.valuePtr = [num floatValue];
-                    }
-                }
-            }
+    // Values with a slot: one atomic load each unless a side changed it
+    for (auto& binding : impl_->floatBindings) {
+        double value = *binding.valuePtr;
+        if (binding.slot.sync(&value, 1)) {
+            *binding.valuePtr = static_cast<float>(value);
         }
+    }
 
-        // Sync int parameters
-        for (auto& binding : impl_->intBindings) {
-            if (binding.swiftParam && binding.valuePtr) {
-                SEL selector = NSSelectorFromString(@"value");
-                if ([binding.swiftParam respondsToSelector:selector]) {
-                    #pragma clang diagnostic push
-                    #pragma clang diagnostic ignored "-Warc-performSelector-leaks"
-                    NSNumber* num = [binding.swiftParam performSelector:selector];
-                    #pragma clang diagnostic pop
-                    if (num) {
-                        *binding.valuePtr = [num intValue];
-                    }
-                }
-            }
+    for (auto& binding : impl_->intBindings) {
+        double value = *binding.valuePtr;
+        if (binding.slot.sync(&value, 1)) {
+            *binding.valuePtr = static_cast<int>(value);
         }
+    }
 
-        // Sync bool parameters
-        for (auto& binding : impl_->boolBindings) {
-            if (binding.swiftParam && binding.valuePtr) {
-                SEL selector = NSSelectorFromString(@"value");
-                if ([binding.swiftParam respondsToSelector:selector]) {
-                    #pragma clang diagnostic push
-                    #pragma clang diagnostic ignored "-Warc-performSelector-leaks"
-                    NSNumber* num = [binding.swiftParam performSelector:selector];
-                    #pragma clang diagnostic pop
-                    if (num) {
-                        *binding.valuePtr = [num boolValue];
-                    }
-                }
-            }
+    for (auto& binding : impl_->boolBindings) {
+        double value = *binding.valuePtr ? 1.0 : 0.0;
+        if (binding.slot.sync(&value, 1)) {
+            *binding.valuePtr = value != 0.0;
         }
+    }
 
-        // Sync color parameters
-        for (auto& binding : impl_->colorBindings) {
-            if (binding.swiftParam && binding.colorPtr) {
-                SEL selector = NSSelectorFromString(@"rgb");
-                if ([binding.swiftParam respondsToSelector:selector]) {
-                    #pragma clang diagnostic push
-                    #pragma clang diagnostic ignored "-Warc-performSelector-leaks"
-                    NSValue* rgbTuple = [binding.swiftParam performSelector:selector];
-                    #pragma clang diagnostic pop
-                    if (rgbTuple) {
-                        // RGB tuple is returned as (Int, Int, Int)
-                        // Access via tuple interface
-                        int rgb[3];
-                        [rgbTuple getValue:&rgb];
-                        binding.colorPtr->r = static_cast<uint8_t>(rgb[0]);
-                        binding.colorPtr->g = static_cast<uint8_t>(rgb[1]);
-                        binding.colorPtr->b = static_cast<uint8_t>(rgb[2]);
-                    }
-                }
-            }
+    for (auto& binding : impl_->colorBindings) {
+        ofColor& color = *binding.colorPtr;
+        double rgb[3] = {double(color.r), double(color.g), double(color.b)};
+        if (binding.slot.sync(rgb, 3)) {
+            color.r = static_cast<uint8_t>(std::clamp(rgb[0], 0.0, 255.0));
+            color.g = static_cast<uint8_t>(std::clamp(rgb[1], 0.0, 255.0));
+            color.b = static_cast<uint8_t>(std::clamp(rgb[2], 0.0, 255.0));
         }
+    }
 
-        // Sync string parameters
+    if (impl_->stringBindings.empty()) return;
+
+    @autoreleasepool {
+        // Sync string parameters (not POD, so still read from the panel)
         for (auto& binding : impl_->stringBindings) {
             if (binding.swiftParam && binding.valuePtr) {
                 SEL selector = NSSelectorFromString(@"value");
@@ -474,6 +515,7 @@ void ofxPanel::clear() {
             }
         }
     }
+    gNextParameterSlot = 0;
     impl_->groups.clear();
 }
 
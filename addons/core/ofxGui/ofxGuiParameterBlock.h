@@ -0,0 +1,82 @@
+#pragma once
+
+// ofxGui parameter block - slider, toggle and color values shared with Swift
+// One contiguous array of POD slots that ofxGui.mm and OFLGuiPanel.swift both
+// read and write through plain C calls. Each slot is published with a seqlock:
+// a reader copies the values and retries if the sequence moved meanwhile, so
+// reads never block and the per-frame sync sends no Objective-C messages.
+// Plain C so Swift imports it through the bridging header.
+
+#include <stdint.h>
+
+#define OFL_GUI_MAX_SLOTS 4096
+#define OFL_GUI_SLOT_VALUES 4
+
+// Who made a slot's last change
+#define OFL_GUI_WRITER_APP 0
+#define OFL_GUI_WRITER_PANEL 1
+
+/// One parameter's values: a float, int or bool in values[0], or RGB in 0-2
+/// Slots fill a cache line each, so the two sides don't contend on neighbours
+typedef struct OFLGuiSlot {
+    uint32_t sequence;                      // Odd while a write is in progress
+    uint32_t writer;                        // OFL_GUI_WRITER_*
+    double values[OFL_GUI_SLOT_VALUES];
+    uint8_t padding[24];
+} __attribute__((aligned(64))) OFLGuiSlot;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The block: OFL_GUI_MAX_SLOTS slots at a fixed address, owned by ofxGui
+OFLGuiSlot* OFLGuiParameterBlock(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/// Change of a slot: even, and different after every write
+static inline uint32_t OFLGuiSlotVersion(const OFLGuiSlot* slot) {
+    return __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) & ~1u;
+}
+
+/// Publish values; writers on either side take turns on the odd sequence
+static inline void OFLGuiSlotWrite(OFLGuiSlot* slot, const double* values, uint32_t count, uint32_t writer) {
+    uint32_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED);
+    for (;;) {
+        if ((sequence & 1u) == 0 &&
+            __atomic_compare_exchange_n(&slot->sequence, &sequence, sequence + 1, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+        sequence = __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED);
+    }
+    for (uint32_t i = 0; i < count && i < OFL_GUI_SLOT_VALUES; ++i) {
+        __atomic_store(&slot->values[i], &values[i], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&slot->writer, writer, __ATOMIC_RELAXED);
+    __atomic_store_n(&slot->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+/// Copy a consistent set of values
+/// @return The version read, as OFLGuiSlotVersion()
+static inline uint32_t OFLGuiSlotRead(const OFLGuiSlot* slot, double* values, uint32_t count, uint32_t* writer) {
+    for (;;) {
+        const uint32_t begin = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        if (begin & 1u) {
+            continue;
+        }
+        for (uint32_t i = 0; i < count && i < OFL_GUI_SLOT_VALUES; ++i) {
+            __atomic_load(&slot->values[i], &values[i], __ATOMIC_RELAXED);
+        }
+        const uint32_t by = __atomic_load_n(&slot->writer, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_RELAXED) == begin) {
+            if (writer) {
+                *writer = by;
+            }
+            return begin;
+        }
+    }
+}
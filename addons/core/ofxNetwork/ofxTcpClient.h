@@ -1,6 +1,9 @@
 #pragma once
 
+#include "ofxTcpFraming.h"
+#include "../../../oflike/utils/ofNetworkStats.h"
 #include <string>
+#include <string_view>
 #include <memory>
 #include <vector>
 #include <cstdint>
@@ -19,6 +22,15 @@
 /// }
 /// client.close();
 /// \endcode
+///
+/// Example usage (framed messages):
+/// \code
+/// client.setFraming(ofxTcpFraming::LengthPrefixed);
+/// client.sendFramedMessage(payload);
+///
+/// std::vector<std::string_view> messages;
+/// client.receiveMessages(messages);  // Everything complete, in one pass
+/// \endcode
 class ofxTcpClient {
 public:
     ofxTcpClient();
@@ -62,6 +74,11 @@ public:
     /// \return Number of bytes sent, or -1 on error
     int sendMessage(const std::string& message, const std::string& delimiter = "\n");
 
+    /// \brief Send a message framed by the current framing (see setFraming())
+    /// \param message Message to send
+    /// \return Number of bytes sent including framing, or -1 on error
+    int sendFramedMessage(const std::string& message);
+
     // Receiving
     /// \brief Receive data (non-blocking)
     /// \return Received data as string
@@ -78,10 +95,28 @@ public:
     /// \return Received message without delimiter, or empty if not complete
     std::string receiveMessage(const std::string& delimiter = "\n");
 
+    /// \brief Receive every complete message (non-blocking)
+    /// \details Messages are split by the current framing (see setFraming())
+    /// and appended to messages without copying; the views stay valid until
+    /// the next receive call.
+    /// \param messages Receives the messages, without framing
+    /// \return Number of messages appended
+    size_t receiveMessages(std::vector<std::string_view>& messages);
+
     /// \brief Get number of bytes available to read
     /// \return Number of bytes available
     int getNumReceivedBytes() const;
 
+    /// \brief Get the traffic counters
+    /// \details Counted since setup(): each chunk the connection delivers is
+    /// a packet in and each send a packet out. The queue depth is in bytes
+    /// received and not read yet; the latency is how long they waited for
+    /// a receive call.
+    oflike::ofNetworkStats getStats() const;
+
+    /// \brief Zero the traffic counters
+    void resetStats();
+
     // Settings
     /// \brief Set connection timeout
     /// \param seconds Timeout in seconds (default 30)
@@ -91,6 +126,11 @@ public:
     /// \param nonBlocking true for non-blocking, false for blocking
     void setNonBlocking(bool nonBlocking);
 
+    /// \brief Set how sendFramedMessage() and receiveMessages() frame messages
+    /// \param framing Delimiter (default) or length-prefixed framing
+    /// \param delimiter Delimiter for delimiter framing (default "\n")
+    void setFraming(ofxTcpFraming framing, const std::string& delimiter = "\n");
+
     // Status
     /// \brief Get last error message
     /// \return Error message
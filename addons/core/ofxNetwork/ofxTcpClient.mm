@@ -1,8 +1,7 @@
 #include "ofxTcpClient.h"
+#include "ofxTcpStream.h"
 #import <Foundation/Foundation.h>
 #import <Network/Network.h>
-#include <queue>
-#include <mutex>
 
 struct ofxTcpClient::Impl {
     nw_connection_t connection = nullptr;
@@ -15,9 +14,14 @@ struct ofxTcpClient::Impl {
     int timeoutSeconds = 30;
 
     std::string errorMessage;
-    std::queue<std::vector<uint8_t>> receiveQueue;
-    std::mutex receiveMutex;
-    std::string receiveBuffer;  // Buffer for partial messages
+    oflike::ofNetworkCounters counters;
+    ofxTcpStream stream;
+    ofxTcpFraming framing = ofxTcpFraming::Delimiter;
+    std::string delimiter = "\n";
+
+    Impl() {
+        stream.setCounters(&counters);
+    }
 
     ~Impl() {
         cleanup();
@@ -32,6 +36,24 @@ struct ofxTcpClient::Impl {
             queue = nullptr;  // ARC handles release
         }
         connected = false;
+        stream.clear();
+        counters.hide();
+    }
+
+    // Keep one receive outstanding until the connection closes
+    void startReceiving(nw_connection_t receiving) {
+        nw_connection_receive(
+            receiving,
+            1,      // minimum_incomplete_length
+            65536,  // maximum_length
+            ^(dispatch_data_t content, nw_content_context_t context, bool is_complete, nw_error_t error) {
+                stream.append(content);
+                if (error || (is_complete && (!context || nw_content_context_get_is_final(context)))) {
+                    return;
+                }
+                startReceiving(receiving);
+            }
+        );
     }
 };
 
@@ -103,10 +125,13 @@ bool ofxTcpClient::setup(const std::string& host, uint16_t port) {
         }
 
         // Set up state handler
+        Impl* impl = pImpl.get();
+        nw_connection_t connection = pImpl->connection;
         nw_connection_set_state_changed_handler(pImpl->connection, ^(nw_connection_state_t state, nw_error_t error) {
             switch (state) {
                 case nw_connection_state_ready:
                     pImpl->connected = true;
+                    impl->startReceiving(connection);
                     break;
                 case nw_connection_state_failed:
                     pImpl->connected = false;
@@ -127,6 +152,8 @@ bool ofxTcpClient::setup(const std::string& host, uint16_t port) {
 
         // Start connection
         nw_connection_start(pImpl->connection);
+        pImpl->counters.reset();
+        pImpl->counters.show("TCP to " + host + ":" + std::to_string(port));
 
         // Wait for connection (with timeout) if blocking mode
         if (!pImpl->nonBlocking) {
@@ -195,6 +222,7 @@ int ofxTcpClient::sendRawBytes(const char* bytes, int size) {
                 completed = true;
             }
         );
+        pImpl->counters.addOut(static_cast<size_t>(size));
 
         // Wait for completion if blocking mode
         if (!pImpl->nonBlocking) {
@@ -212,84 +240,50 @@ int ofxTcpClient::sendMessage(const std::string& message, const std::string& del
     return send(fullMessage);
 }
 
-std::string ofxTcpClient::receive() {
-    @autoreleasepool {
-        if (!isConnected() || !pImpl->connection) {
-            return "";
-        }
-
-        // Schedule receive
-        nw_connection_receive(
-            pImpl->connection,
-            1,      // minimum_incomplete_length
-            65536,  // maximum_length
-            ^(dispatch_data_t content, nw_content_context_t context, bool is_complete, nw_error_t error) {
-                if (content && !error) {
-                    const void* buffer;
-                    size_t size;
-                    dispatch_data_t contiguous = dispatch_data_create_map(content, &buffer, &size);
-
-                    if (buffer && size > 0) {
-                        std::lock_guard<std::mutex> lock(pImpl->receiveMutex);
-                        std::vector<uint8_t> data(static_cast<const uint8_t*>(buffer),
-                                                  static_cast<const uint8_t*>(buffer) + size);
-                        pImpl->receiveQueue.push(std::move(data));
-                    }
-                }
-            }
-        );
-
-        // Get data from queue
-        std::lock_guard<std::mutex> lock(pImpl->receiveMutex);
-        if (pImpl->receiveQueue.empty()) {
-            return "";
-        }
-
-        std::vector<uint8_t> data = std::move(pImpl->receiveQueue.front());
-        pImpl->receiveQueue.pop();
-
-        return std::string(data.begin(), data.end());
+int ofxTcpClient::sendFramedMessage(const std::string& message) {
+    if (pImpl->framing == ofxTcpFraming::Delimiter) {
+        return sendMessage(message, pImpl->delimiter);
     }
+    std::string fullMessage(4 + message.size(), '\0');
+    ofxTcpStream::writeLength(&fullMessage[0], static_cast<uint32_t>(message.size()));
+    std::memcpy(&fullMessage[4], message.data(), message.size());
+    return send(fullMessage);
 }
 
-int ofxTcpClient::receiveRawBytes(char* buffer, int maxSize) {
-    std::string data = receive();
-    if (data.empty()) {
-        return 0;
-    }
+std::string ofxTcpClient::receive() {
+    return pImpl->stream.readAll();
+}
 
-    int bytesToCopy = std::min(static_cast<int>(data.size()), maxSize);
-    std::memcpy(buffer, data.c_str(), bytesToCopy);
-    return bytesToCopy;
+int ofxTcpClient::receiveRawBytes(char* buffer, int maxSize) {
+    return static_cast<int>(pImpl->stream.read(buffer, static_cast<size_t>(std::max(maxSize, 0))));
 }
 
 std::string ofxTcpClient::receiveMessage(const std::string& delimiter) {
-    // Read new data and append to buffer
-    std::string newData = receive();
-    pImpl->receiveBuffer += newData;
-
-    // Look for delimiter
-    size_t pos = pImpl->receiveBuffer.find(delimiter);
-    if (pos == std::string::npos) {
+    std::string_view message;
+    if (!pImpl->stream.next(ofxTcpFraming::Delimiter, delimiter, message)) {
         return "";  // Delimiter not found yet
     }
+    return std::string(message);
+}
 
-    // Extract message
-    std::string message = pImpl->receiveBuffer.substr(0, pos);
-    pImpl->receiveBuffer = pImpl->receiveBuffer.substr(pos + delimiter.size());
-
-    return message;
+size_t ofxTcpClient::receiveMessages(std::vector<std::string_view>& messages) {
+    const size_t count = pImpl->stream.drain(pImpl->framing, pImpl->delimiter, messages);
+    if (pImpl->stream.hasFramingError()) {
+        pImpl->errorMessage = "Message length over limit; received data discarded";
+    }
+    return count;
 }
 
 int ofxTcpClient::getNumReceivedBytes() const {
-    std::lock_guard<std::mutex> lock(pImpl->receiveMutex);
-    int total = 0;
-    std::queue<std::vector<uint8_t>> temp = pImpl->receiveQueue;
-    while (!temp.empty()) {
-        total += temp.front().size();
-        temp.pop();
-    }
-    return total + pImpl->receiveBuffer.size();
+    return static_cast<int>(pImpl->stream.available());
+}
+
+oflike::ofNetworkStats ofxTcpClient::getStats() const {
+    return pImpl->counters.getStats();
+}
+
+void ofxTcpClient::resetStats() {
+    pImpl->counters.reset();
 }
 
 void ofxTcpClient::setTimeout(int seconds) {
@@ -300,6 +294,11 @@ void ofxTcpClient::setNonBlocking(bool nonBlocking) {
     pImpl->nonBlocking = nonBlocking;
 }
 
+void ofxTcpClient::setFraming(ofxTcpFraming framing, const std::string& delimiter) {
+    pImpl->framing = framing;
+    pImpl->delimiter = delimiter;
+}
+
 std::string ofxTcpClient::getError() const {
     return pImpl->errorMessage;
 }
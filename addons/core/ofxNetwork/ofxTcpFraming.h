@@ -0,0 +1,7 @@
+#pragma once
+
+/// \brief How ofxTcpClient and ofxTcpServer split a TCP stream into messages
+enum class ofxTcpFraming {
+    Delimiter,       ///< Each message ends with a delimiter, which is dropped
+    LengthPrefixed   ///< Each message starts with its length (4 bytes, big-endian)
+};
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "ofxTcpFraming.h"
+#include "../../../oflike/utils/ofNetworkStats.h"
 #include <string>
+#include <string_view>
 #include <memory>
 #include <vector>
 #include <cstdint>
@@ -23,6 +26,14 @@
 /// }
 /// server.close();
 /// \endcode
+///
+/// Each client has its own dispatch queue and receive buffer, and the client
+/// list is copy-on-write, so sending and receiving never wait on a lock
+/// shared with other clients. Broadcasts copy the data once and send the
+/// same buffer on every connection. A client that falls too far behind
+/// (see setMaxPendingBytes()) is dropped and no longer holds back the rest.
+///
+/// Receive from a given client on one thread at a time.
 class ofxTcpServer {
 public:
     ofxTcpServer();
@@ -105,6 +116,18 @@ public:
     /// \param size Number of bytes to send
     void sendRawBytesToAll(const char* bytes, int size);
 
+    /// \brief Send a message to all connected clients, framed by the current
+    /// framing (see setFraming())
+    /// \param message Message to send
+    void sendFramedMessageToAll(const std::string& message);
+
+    /// \brief Send a message to specific client, framed by the current
+    /// framing (see setFraming())
+    /// \param clientIndex Client index
+    /// \param message Message to send
+    /// \return Number of bytes sent including framing, or -1 on error
+    int sendFramedMessage(int clientIndex, const std::string& message);
+
     // Receiving
     /// \brief Receive data from specific client (non-blocking)
     /// \param clientIndex Client index
@@ -123,6 +146,15 @@ public:
     /// \return Number of bytes available
     int getNumReceivedBytes(int clientIndex) const;
 
+    /// \brief Receive every complete message from specific client (non-blocking)
+    /// \details Messages are split by the current framing (see setFraming())
+    /// and appended to messages without copying; the views stay valid until
+    /// the next receive call for that client.
+    /// \param clientIndex Client index
+    /// \param messages Receives the messages, without framing
+    /// \return Number of messages appended
+    size_t receiveMessages(int clientIndex, std::vector<std::string_view>& messages);
+
     // Settings
     /// \brief Set maximum number of clients
     /// \param maxClients Maximum clients (default 10)
@@ -132,6 +164,37 @@ public:
     /// \return Maximum clients
     int getMaxClients() const;
 
+    /// \brief Set how sendFramedMessage() and receiveMessages() frame messages
+    /// \param framing Delimiter (default) or length-prefixed framing
+    /// \param delimiter Delimiter for delimiter framing (default "\n")
+    void setFraming(ofxTcpFraming framing, const std::string& delimiter = "\n");
+
+    /// \brief Set how much sent data may wait on a client before it's dropped
+    /// \param maxBytes Maximum unsent bytes per client (default 4 MB, 0 = no limit)
+    void setMaxPendingBytes(size_t maxBytes);
+
+    /// \brief Get maximum unsent bytes per client
+    /// \return Maximum bytes
+    size_t getMaxPendingBytes() const;
+
+    /// \brief Get number of bytes sent to a client that haven't gone out yet
+    /// \param clientIndex Client index
+    /// \return Number of bytes pending
+    size_t getNumPendingBytes(int clientIndex) const;
+
+    /// \brief Get number of clients dropped for falling behind
+    /// \return Dropped client count
+    uint64_t getNumDroppedClients() const;
+
+    /// \brief Get the traffic counters, of every client together
+    /// \details Counted since setup(), like ofxTcpClient::getStats(); a send
+    /// to each client of a broadcast is a packet out, and a send that drops a
+    /// client for falling behind is a drop.
+    oflike::ofNetworkStats getStats() const;
+
+    /// \brief Zero the traffic counters
+    void resetStats();
+
     // Status
     /// \brief Get last error message
     /// \return Error message
@@ -142,6 +205,8 @@ public:
     uint16_t getPort() const;
 
 private:
+    std::string frame(const std::string& message) const;
+
     struct Impl;
     std::unique_ptr<Impl> pImpl;
 };
@@ -1,19 +1,54 @@
 #include "ofxTcpServer.h"
+#include "ofxTcpStream.h"
 #import <Foundation/Foundation.h>
 #import <Network/Network.h>
-#include <queue>
+#include <atomic>
 #include <mutex>
 
+// One accepted connection. The connection's handlers hold it weakly, so it
+// lives as long as the server's client list (or a snapshot of it) does
 struct ClientConnection {
     nw_connection_t connection = nullptr;
+    dispatch_queue_t queue = nullptr;  // This client's own serial queue
     std::string remoteIP;
     uint16_t remotePort = 0;
-    bool connected = false;
-    std::queue<std::vector<uint8_t>> receiveQueue;
-    std::mutex receiveMutex;
-    std::string errorMessage;
+    std::atomic<bool> connected{false};
+    std::atomic<bool> closed{false};      // Failed, cancelled or dropped
+    std::atomic<size_t> pendingBytes{0};  // Sent and not yet completed
+    ofxTcpStream stream;
+
+    ~ClientConnection() {
+        if (connection) {
+            nw_connection_cancel(connection);
+        }
+        stream.clear();  // Unread data leaves the server's queue depth
+    }
+
+    // Keep one receive outstanding until the connection closes
+    void startReceiving(std::weak_ptr<ClientConnection> weak) {
+        nw_connection_receive(
+            connection,
+            1,      // minimum_incomplete_length
+            65536,  // maximum_length
+            ^(dispatch_data_t content, nw_content_context_t context, bool is_complete, nw_error_t error) {
+                std::shared_ptr<ClientConnection> self = weak.lock();
+                if (!self) {
+                    return;
+                }
+                self->stream.append(content);
+                if (error || (is_complete && (!context || nw_content_context_get_is_final(context)))) {
+                    return;
+                }
+
+                // Continue receiving
+                self->startReceiving(weak);
+            }
+        );
+    }
 };
 
+using ClientList = std::vector<std::shared_ptr<ClientConnection>>;
+
 struct ofxTcpServer::Impl {
     nw_listener_t listener = nullptr;
     dispatch_queue_t queue = nullptr;
@@ -22,9 +57,21 @@ struct ofxTcpServer::Impl {
     uint16_t port = 0;
     bool listening = false;
     int maxClients = 10;
+    ofxTcpFraming framing = ofxTcpFraming::Delimiter;
+    std::string delimiter = "\n";
 
-    std::vector<std::unique_ptr<ClientConnection>> clients;
+    // Copy-on-write: readers take a snapshot without locking; accepting and
+    // disconnecting build a new list under clientsMutex and publish it
+    std::shared_ptr<const ClientList> clients = std::make_shared<ClientList>();
     std::mutex clientsMutex;
+    std::atomic<uint64_t> numAccepted{0};
+
+    // Backpressure
+    std::atomic<size_t> maxPendingBytes{4 * 1024 * 1024};
+    std::atomic<uint64_t> numDropped{0};
+
+    // Every client's traffic together
+    oflike::ofNetworkCounters counters;
 
     std::string errorMessage;
 
@@ -33,15 +80,10 @@ struct ofxTcpServer::Impl {
     }
 
     void cleanup() {
-        // Close all client connections
+        // Close all client connections (each cancels its own when released)
         {
             std::lock_guard<std::mutex> lock(clientsMutex);
-            for (auto& client : clients) {
-                if (client && client->connection) {
-                    nw_connection_cancel(client->connection);
-                }
-            }
-            clients.clear();
+            std::atomic_store(&clients, std::shared_ptr<const ClientList>(std::make_shared<ClientList>()));
         }
 
         // Stop listener
@@ -55,33 +97,61 @@ struct ofxTcpServer::Impl {
         }
 
         listening = false;
+        counters.hide();
     }
 
-    void setupClientReceive(ClientConnection* client) {
-        if (!client || !client->connection) return;
+    std::shared_ptr<const ClientList> snapshot() const {
+        return std::atomic_load(&clients);
+    }
 
-        nw_connection_receive(
-            client->connection,
-            1,      // minimum_incomplete_length
-            65536,  // maximum_length
-            ^(dispatch_data_t content, nw_content_context_t context, bool is_complete, nw_error_t error) {
-                if (content && !error) {
-                    const void* buffer;
-                    size_t size;
-                    dispatch_data_t contiguous = dispatch_data_create_map(content, &buffer, &size);
-
-                    if (buffer && size > 0) {
-                        std::lock_guard<std::mutex> lock(client->receiveMutex);
-                        std::vector<uint8_t> data(static_cast<const uint8_t*>(buffer),
-                                                  static_cast<const uint8_t*>(buffer) + size);
-                        client->receiveQueue.push(std::move(data));
-                    }
+    std::shared_ptr<ClientConnection> client(int clientIndex) const {
+        std::shared_ptr<const ClientList> list = snapshot();
+        if (clientIndex < 0 || clientIndex >= static_cast<int>(list->size())) {
+            return nullptr;
+        }
+        return (*list)[clientIndex];
+    }
 
-                    // Continue receiving
-                    setupClientReceive(client);
+    // Queue data on a client's connection. A client whose unsent backlog
+    // would exceed maxPendingBytes is too slow to keep up and is dropped,
+    // so it can't hold back anyone else
+    bool send(const std::shared_ptr<ClientConnection>& client, dispatch_data_t data, size_t size) {
+        if (!client->connected) {
+            return false;
+        }
+
+        const size_t limit = maxPendingBytes.load(std::memory_order_relaxed);
+        const size_t pending = client->pendingBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        if (limit > 0 && pending > limit) {
+            client->pendingBytes.fetch_sub(size, std::memory_order_relaxed);
+            counters.addDrops();
+            drop(*client);
+            return false;
+        }
+
+        std::shared_ptr<ClientConnection> owner = client;
+        nw_connection_send(
+            client->connection,
+            data,
+            NW_CONNECTION_DEFAULT_MESSAGE_CONTEXT,
+            true,  // is_complete
+            ^(nw_error_t error) {
+                owner->pendingBytes.fetch_sub(size, std::memory_order_relaxed);
+                if (error) {
+                    owner->connected = false;
                 }
             }
         );
+        counters.addOut(size);
+        return true;
+    }
+
+    void drop(ClientConnection& client) {
+        client.closed = true;
+        if (client.connected.exchange(false)) {
+            nw_connection_cancel(client.connection);
+            numDropped++;
+        }
     }
 };
 
@@ -174,18 +244,33 @@ bool ofxTcpServer::setup(const std::string& address, uint16_t port) {
         });
 
         // Set new connection handler
+        Impl* implPtr = pImpl.get();
         nw_listener_set_new_connection_handler(pImpl->listener, ^(nw_connection_t connection) {
-            std::lock_guard<std::mutex> lock(pImpl->clientsMutex);
+            std::lock_guard<std::mutex> lock(implPtr->clientsMutex);
+
+            // Clients that have gone away make room for new ones
+            std::shared_ptr<const ClientList> current = implPtr->snapshot();
+            auto next = std::make_shared<ClientList>();
+            next->reserve(current->size() + 1);
+            for (const auto& client : *current) {
+                if (!client->closed) {
+                    next->push_back(client);
+                }
+            }
 
             // Check if we've reached max clients
-            if (pImpl->clients.size() >= static_cast<size_t>(pImpl->maxClients)) {
+            if (next->size() >= static_cast<size_t>(implPtr->maxClients)) {
                 nw_connection_cancel(connection);
                 return;
             }
 
             // Create client connection object
-            auto client = std::make_unique<ClientConnection>();
+            auto client = std::make_shared<ClientConnection>();
             client->connection = connection;
+            client->stream.setCounters(&implPtr->counters);
+            client->queue = dispatch_queue_create_with_target(
+                "com.oflike.tcp.server.client", DISPATCH_QUEUE_SERIAL,
+                dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0));
 
             // Get remote endpoint info
             nw_endpoint_t endpoint = nw_connection_copy_endpoint(connection);
@@ -198,36 +283,42 @@ bool ofxTcpServer::setup(const std::string& address, uint16_t port) {
                 client->remotePort = clientPort;
             }
 
-            // Get raw pointer for block capture (lifetime managed by pImpl->clients)
-            ClientConnection* clientPtr = client.get();
-            Impl* implPtr = pImpl.get();
-
             // Set up state handler for client
+            std::weak_ptr<ClientConnection> weak = client;
             nw_connection_set_state_changed_handler(connection, ^(nw_connection_state_t state, nw_error_t error) {
+                std::shared_ptr<ClientConnection> self = weak.lock();
+                if (!self) {
+                    return;
+                }
                 switch (state) {
                     case nw_connection_state_ready:
-                        clientPtr->connected = true;
+                        self->connected = true;
                         // Start receiving data
-                        implPtr->setupClientReceive(clientPtr);
+                        self->startReceiving(weak);
                         break;
                     case nw_connection_state_failed:
                     case nw_connection_state_cancelled:
-                        clientPtr->connected = false;
+                        self->connected = false;
+                        self->closed = true;
                         break;
                     default:
                         break;
                 }
             });
 
-            // Set queue and start
-            nw_connection_set_queue(connection, pImpl->queue);
+            // Each client has its own queue, so clients are serviced in parallel
+            nw_connection_set_queue(connection, client->queue);
             nw_connection_start(connection);
 
-            pImpl->clients.push_back(std::move(client));
+            next->push_back(std::move(client));
+            std::atomic_store(&implPtr->clients, std::shared_ptr<const ClientList>(std::move(next)));
+            implPtr->numAccepted++;
         });
 
         // Start listener
         nw_listener_start(pImpl->listener);
+        pImpl->counters.reset();
+        pImpl->counters.show("TCP :" + std::to_string(port));
 
         // Wait briefly for listener to become ready
         usleep(10000);  // 10ms
@@ -251,12 +342,12 @@ bool ofxTcpServer::waitForClient(int timeoutSeconds) {
         return false;
     }
 
-    int initialCount = getNumClients();
+    const uint64_t initialCount = pImpl->numAccepted;
     int iterations = (timeoutSeconds > 0) ? (timeoutSeconds * 100) : -1;
     int count = 0;
 
     while (iterations < 0 || count < iterations) {
-        if (getNumClients() > initialCount) {
+        if (pImpl->numAccepted > initialCount) {
             return true;
         }
         usleep(10000);  // 10ms
@@ -267,49 +358,38 @@ bool ofxTcpServer::waitForClient(int timeoutSeconds) {
 }
 
 int ofxTcpServer::getNumClients() const {
-    std::lock_guard<std::mutex> lock(pImpl->clientsMutex);
-    return static_cast<int>(pImpl->clients.size());
+    return static_cast<int>(pImpl->snapshot()->size());
 }
 
 bool ofxTcpServer::isClientConnected(int clientIndex) const {
-    std::lock_guard<std::mutex> lock(pImpl->clientsMutex);
-    if (clientIndex < 0 || clientIndex >= static_cast<int>(pImpl->clients.size())) {
-        return false;
-    }
-    return pImpl->clients[clientIndex]->connected;
+    std::shared_ptr<ClientConnection> client = pImpl->client(clientIndex);
+    return client && client->connected;
 }
 
 void ofxTcpServer::disconnectClient(int clientIndex) {
     std::lock_guard<std::mutex> lock(pImpl->clientsMutex);
-    if (clientIndex < 0 || clientIndex >= static_cast<int>(pImpl->clients.size())) {
+    std::shared_ptr<const ClientList> current = pImpl->snapshot();
+    if (clientIndex < 0 || clientIndex >= static_cast<int>(current->size())) {
         return;
     }
 
-    auto& client = pImpl->clients[clientIndex];
-    if (client->connection) {
-        nw_connection_cancel(client->connection);
-        client->connection = nullptr;
-    }
-    client->connected = false;
-
-    // Remove client from list
-    pImpl->clients.erase(pImpl->clients.begin() + clientIndex);
+    // Remove client from list; the connection is cancelled once the last
+    // snapshot holding it is released
+    auto next = std::make_shared<ClientList>(*current);
+    (*next)[clientIndex]->connected = false;
+    (*next)[clientIndex]->closed = true;
+    next->erase(next->begin() + clientIndex);
+    std::atomic_store(&pImpl->clients, std::shared_ptr<const ClientList>(std::move(next)));
 }
 
 std::string ofxTcpServer::getClientIP(int clientIndex) const {
-    std::lock_guard<std::mutex> lock(pImpl->clientsMutex);
-    if (clientIndex < 0 || clientIndex >= static_cast<int>(pImpl->clients.size())) {
-        return "";
-    }
-    return pImpl->clients[clientIndex]->remoteIP;
+    std::shared_ptr<ClientConnection> client = pImpl->client(clientIndex);
+    return client ? client->remoteIP : "";
 }
 
 uint16_t ofxTcpServer::getClientPort(int clientIndex) const {
-    std::lock_guard<std::mutex> lock(pImpl->clientsMutex);
-    if (clientIndex < 0 || clientIndex >= static_cast<int>(pImpl->clients.size())) {
-        return 0;
-    }
-    return pImpl->clients[clientIndex]->remotePort;
+    std::shared_ptr<ClientConnection> client = pImpl->client(clientIndex);
+    return client ? client->remotePort : 0;
 }
 
 int ofxTcpServer::send(int clientIndex, const std::string& data) {
@@ -318,14 +398,8 @@ int ofxTcpServer::send(int clientIndex, const std::string& data) {
 
 int ofxTcpServer::sendRawBytes(int clientIndex, const char* bytes, int size) {
     @autoreleasepool {
-        std::lock_guard<std::mutex> lock(pImpl->clientsMutex);
-
-        if (clientIndex < 0 || clientIndex >= static_cast<int>(pImpl->clients.size())) {
-            return -1;
-        }
-
-        auto& client = pImpl->clients[clientIndex];
-        if (!client->connected || !client->connection) {
+        std::shared_ptr<ClientConnection> client = pImpl->client(clientIndex);
+        if (!client || size < 0) {
             return -1;
         }
 
@@ -333,7 +407,7 @@ int ofxTcpServer::sendRawBytes(int clientIndex, const char* bytes, int size) {
         dispatch_data_t data = dispatch_data_create(
             bytes,
             size,
-            pImpl->queue,
+            nullptr,
             DISPATCH_DATA_DESTRUCTOR_DEFAULT
         );
 
@@ -341,86 +415,77 @@ int ofxTcpServer::sendRawBytes(int clientIndex, const char* bytes, int size) {
             return -1;
         }
 
-        __block bool completed = false;
-        __block bool success = false;
-
-        // Send data
-        nw_connection_send(
-            client->connection,
-            data,
-            NW_CONNECTION_DEFAULT_MESSAGE_CONTEXT,
-            true,  // is_complete
-            ^(nw_error_t error) {
-                success = (error == nullptr);
-                completed = true;
-            }
-        );
-
-        return success ? size : -1;
+        return pImpl->send(client, data, static_cast<size_t>(size)) ? size : -1;
     }
 }
 
+int ofxTcpServer::sendFramedMessage(int clientIndex, const std::string& message) {
+    return send(clientIndex, frame(message));
+}
+
 void ofxTcpServer::sendToAll(const std::string& data) {
     sendRawBytesToAll(data.c_str(), static_cast<int>(data.size()));
 }
 
 void ofxTcpServer::sendRawBytesToAll(const char* bytes, int size) {
-    int numClients = getNumClients();
-    for (int i = 0; i < numClients; i++) {
-        sendRawBytes(i, bytes, size);
-    }
-}
-
-std::string ofxTcpServer::receive(int clientIndex) {
-    std::lock_guard<std::mutex> lock(pImpl->clientsMutex);
+    @autoreleasepool {
+        std::shared_ptr<const ClientList> clients = pImpl->snapshot();
+        if (clients->empty() || size < 0) {
+            return;
+        }
 
-    if (clientIndex < 0 || clientIndex >= static_cast<int>(pImpl->clients.size())) {
-        return "";
-    }
+        // One copy of the data, shared by every connection it's sent on
+        dispatch_data_t data = dispatch_data_create(
+            bytes,
+            size,
+            nullptr,
+            DISPATCH_DATA_DESTRUCTOR_DEFAULT
+        );
 
-    auto& client = pImpl->clients[clientIndex];
+        if (!data) {
+            return;
+        }
 
-    // Get data from queue
-    std::lock_guard<std::mutex> recvLock(client->receiveMutex);
-    if (client->receiveQueue.empty()) {
-        return "";
+        for (const auto& client : *clients) {
+            pImpl->send(client, data, static_cast<size_t>(size));
+        }
     }
+}
 
-    std::vector<uint8_t> data = std::move(client->receiveQueue.front());
-    client->receiveQueue.pop();
+void ofxTcpServer::sendFramedMessageToAll(const std::string& message) {
+    sendToAll(frame(message));
+}
 
-    return std::string(data.begin(), data.end());
+std::string ofxTcpServer::receive(int clientIndex) {
+    std::shared_ptr<ClientConnection> client = pImpl->client(clientIndex);
+    return client ? client->stream.readAll() : "";
 }
 
 int ofxTcpServer::receiveRawBytes(int clientIndex, char* buffer, int maxSize) {
-    std::string data = receive(clientIndex);
-    if (data.empty()) {
-        return 0;
+    std::shared_ptr<ClientConnection> client = pImpl->client(clientIndex);
+    if (!client) {
+        return -1;
     }
 
-    int bytesToCopy = std::min(static_cast<int>(data.size()), maxSize);
-    std::memcpy(buffer, data.c_str(), bytesToCopy);
-    return bytesToCopy;
+    return static_cast<int>(client->stream.read(buffer, static_cast<size_t>(std::max(maxSize, 0))));
 }
 
-int ofxTcpServer::getNumReceivedBytes(int clientIndex) const {
-    std::lock_guard<std::mutex> lock(pImpl->clientsMutex);
-
-    if (clientIndex < 0 || clientIndex >= static_cast<int>(pImpl->clients.size())) {
+size_t ofxTcpServer::receiveMessages(int clientIndex, std::vector<std::string_view>& messages) {
+    std::shared_ptr<ClientConnection> client = pImpl->client(clientIndex);
+    if (!client) {
         return 0;
     }
 
-    auto& client = pImpl->clients[clientIndex];
-    std::lock_guard<std::mutex> recvLock(client->receiveMutex);
-
-    int total = 0;
-    std::queue<std::vector<uint8_t>> temp = client->receiveQueue;
-    while (!temp.empty()) {
-        total += temp.front().size();
-        temp.pop();
+    const size_t count = client->stream.drain(pImpl->framing, pImpl->delimiter, messages);
+    if (client->stream.hasFramingError()) {
+        pImpl->errorMessage = "Message length over limit; received data discarded";
     }
+    return count;
+}
 
-    return total;
+int ofxTcpServer::getNumReceivedBytes(int clientIndex) const {
+    std::shared_ptr<ClientConnection> client = pImpl->client(clientIndex);
+    return client ? static_cast<int>(client->stream.available()) : 0;
 }
 
 void ofxTcpServer::setMaxClients(int maxClients) {
@@ -431,6 +496,36 @@ int ofxTcpServer::getMaxClients() const {
     return pImpl->maxClients;
 }
 
+void ofxTcpServer::setFraming(ofxTcpFraming framing, const std::string& delimiter) {
+    pImpl->framing = framing;
+    pImpl->delimiter = delimiter;
+}
+
+void ofxTcpServer::setMaxPendingBytes(size_t maxBytes) {
+    pImpl->maxPendingBytes = maxBytes;
+}
+
+size_t ofxTcpServer::getMaxPendingBytes() const {
+    return pImpl->maxPendingBytes;
+}
+
+size_t ofxTcpServer::getNumPendingBytes(int clientIndex) const {
+    std::shared_ptr<ClientConnection> client = pImpl->client(clientIndex);
+    return client ? client->pendingBytes.load() : 0;
+}
+
+uint64_t ofxTcpServer::getNumDroppedClients() const {
+    return pImpl->numDropped;
+}
+
+oflike::ofNetworkStats ofxTcpServer::getStats() const {
+    return pImpl->counters.getStats();
+}
+
+void ofxTcpServer::resetStats() {
+    pImpl->counters.reset();
+}
+
 std::string ofxTcpServer::getError() const {
     return pImpl->errorMessage;
 }
@@ -438,3 +533,13 @@ std::string ofxTcpServer::getError() const {
 uint16_t ofxTcpServer::getPort() const {
     return pImpl->port;
 }
+
+std::string ofxTcpServer::frame(const std::string& message) const {
+    if (pImpl->framing == ofxTcpFraming::Delimiter) {
+        return message + pImpl->delimiter;
+    }
+    std::string framed(4 + message.size(), '\0');
+    ofxTcpStream::writeLength(&framed[0], static_cast<uint32_t>(message.size()));
+    std::memcpy(&framed[4], message.data(), message.size());
+    return framed;
+}
@@ -0,0 +1,258 @@
+#pragma once
+
+// ofxTcpStream - receive side of a TCP connection
+// Objective-C++ only: shared by ofxTcpClient and ofxTcpServer, included by
+// their .mm files
+//
+// The connection's queue chains each received dispatch_data_t onto the
+// pending data without copying it. The reading thread takes the whole chain
+// in one lock and copies it once into a contiguous buffer, where messages
+// are split off in place: the buffer only moves what's left to its front
+// when it runs out of room, and a delimiter search resumes where the last
+// one stopped, so draining a backlog is linear in its size.
+//
+// With counters set, each received chunk counts as a packet in, the queue
+// depth is the bytes received and not consumed, and the latency is how long
+// data waited in the pending chain before the reading thread took it.
+
+#import <Foundation/Foundation.h>
+#include "ofxTcpFraming.h"
+#include "../../../oflike/utils/ofNetworkStats.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class ofxTcpStream {
+public:
+    // Length-prefixed messages longer than this are a framing error
+    static constexpr size_t kMaxMessageSize = 64 * 1024 * 1024;
+
+    // Counters to update, shared by several streams on a server; set before
+    // the connection starts
+    void setCounters(oflike::ofNetworkCounters* counters) { counters_ = counters; }
+
+    // ========================================================================
+    // Connection queue
+    // ========================================================================
+
+    // Append received data to the pending chain; no copy
+    void append(dispatch_data_t content) {
+        const size_t size = content ? dispatch_data_get_size(content) : 0;
+        if (size == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_) {
+            pending_ = dispatch_data_create_concat(pending_, content);
+        } else {
+            pending_ = content;
+            pendingSince_ = oflike::ofNetworkCounters::timestamp();
+        }
+        buffered_.fetch_add(size, std::memory_order_relaxed);
+        if (counters_) {
+            counters_->addIn(size);
+            counters_->addQueueDepth(static_cast<int64_t>(size));
+        }
+    }
+
+    // ========================================================================
+    // Reading thread
+    // ========================================================================
+
+    // Bytes received and not consumed yet
+    size_t available() {
+        pull();
+        return end_ - begin_;
+    }
+
+    // Copy up to maxSize unconsumed bytes out
+    size_t read(char* destination, size_t maxSize) {
+        pull();
+        const size_t size = std::min(maxSize, end_ - begin_);
+        std::memcpy(destination, buffer_.data() + begin_, size);
+        consume(size);
+        return size;
+    }
+
+    // Every unconsumed byte
+    std::string readAll() {
+        pull();
+        std::string data(buffer_.data() + begin_, end_ - begin_);
+        consume(end_ - begin_);
+        return data;
+    }
+
+    // Next complete message, which stays valid until the next call on the
+    // stream; false if none is complete (or, length-prefixed, on a length
+    // over kMaxMessageSize: the stream is then cleared and framingError set)
+    bool next(ofxTcpFraming framing, std::string_view delimiter, std::string_view& message) {
+        pull();
+        return framing == ofxTcpFraming::Delimiter ? nextDelimited(delimiter, message)
+                                                         : nextLengthPrefixed(message);
+    }
+
+    // Every complete message, appended to messages; valid until the next
+    // call on the stream
+    size_t drain(ofxTcpFraming framing, std::string_view delimiter,
+                 std::vector<std::string_view>& messages) {
+        pull();
+        size_t count = 0;
+        std::string_view message;
+        while (framing == ofxTcpFraming::Delimiter ? nextDelimited(delimiter, message)
+                                                         : nextLengthPrefixed(message)) {
+            messages.push_back(message);
+            count++;
+        }
+        return count;
+    }
+
+    bool hasFramingError() const { return framingError_; }
+
+    void clear() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_ = nil;
+            untrack(buffered_.load(std::memory_order_relaxed));
+        }
+        begin_ = end_ = scanned_ = 0;
+        framingError_ = false;
+    }
+
+    // Length prefix for a message of size bytes
+    static void writeLength(char* destination, uint32_t size) {
+        destination[0] = static_cast<char>(size >> 24);
+        destination[1] = static_cast<char>(size >> 16);
+        destination[2] = static_cast<char>(size >> 8);
+        destination[3] = static_cast<char>(size);
+    }
+
+private:
+    // Take the pending chain in one lock and copy it after the unconsumed
+    // bytes, moving those to the front first if the buffer is out of room
+    void pull() {
+        dispatch_data_t data = nil;
+        uint64_t since = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            data = pending_;
+            since = pendingSince_;
+            pending_ = nil;
+        }
+        if (!data) {
+            return;
+        }
+        if (counters_) {
+            counters_->addLatencySince(since);
+        }
+
+        const size_t size = dispatch_data_get_size(data);
+        if (buffer_.size() - end_ < size) {
+            const size_t unconsumed = end_ - begin_;
+            if (begin_ > 0) {
+                std::memmove(buffer_.data(), buffer_.data() + begin_, unconsumed);
+                scanned_ -= begin_;
+                begin_ = 0;
+                end_ = unconsumed;
+            }
+            if (buffer_.size() - end_ < size) {
+                size_t capacity = std::max<size_t>(buffer_.size(), 65536);
+                while (capacity - end_ < size) {
+                    capacity *= 2;
+                }
+                buffer_.resize(capacity);
+            }
+        }
+
+        char* destination = buffer_.data() + end_;
+        dispatch_data_apply(data, ^bool(dispatch_data_t, size_t offset, const void* bytes, size_t length) {
+            std::memcpy(destination + offset, bytes, length);
+            return true;
+        });
+        end_ += size;
+    }
+
+    // Bytes leave the queue depth as they're consumed or discarded
+    void untrack(size_t size) {
+        buffered_.fetch_sub(size, std::memory_order_relaxed);
+        if (counters_) {
+            counters_->addQueueDepth(-static_cast<int64_t>(size));
+        }
+    }
+
+    void consume(size_t size) {
+        untrack(size);
+        begin_ += size;
+        scanned_ = std::max(scanned_, begin_);
+        if (begin_ == end_) {
+            begin_ = end_ = scanned_ = 0;
+        }
+    }
+
+    bool nextDelimited(std::string_view delimiter, std::string_view& message) {
+        if (delimiter.empty() || end_ - begin_ < delimiter.size()) {
+            return false;
+        }
+        // Resume just before where the last search stopped, in case the
+        // delimiter straddles it
+        const std::string_view unconsumed(buffer_.data() + begin_, end_ - begin_);
+        const size_t from = std::max(scanned_, begin_ + delimiter.size() - 1) - begin_ - (delimiter.size() - 1);
+        const size_t pos = unconsumed.find(delimiter, from);
+        if (pos == std::string_view::npos) {
+            scanned_ = end_;
+            return false;
+        }
+        message = unconsumed.substr(0, pos);
+        consumeMessage(pos + delimiter.size());
+        return true;
+    }
+
+    bool nextLengthPrefixed(std::string_view& message) {
+        if (end_ - begin_ < 4) {
+            return false;
+        }
+        const unsigned char* header = reinterpret_cast<const unsigned char*>(buffer_.data() + begin_);
+        const size_t size = (static_cast<size_t>(header[0]) << 24) | (static_cast<size_t>(header[1]) << 16) |
+                            (static_cast<size_t>(header[2]) << 8) | static_cast<size_t>(header[3]);
+        if (size > kMaxMessageSize) {
+            framingError_ = true;
+            untrack(end_ - begin_);
+            if (counters_) {
+                counters_->addDrops();
+            }
+            begin_ = end_ = scanned_ = 0;
+            return false;
+        }
+        if (end_ - begin_ < 4 + size) {
+            return false;
+        }
+        message = std::string_view(buffer_.data() + begin_ + 4, size);
+        consumeMessage(4 + size);
+        return true;
+    }
+
+    // Like consume(), but never resets to the front: messages returned by
+    // this call still point into the buffer
+    void consumeMessage(size_t size) {
+        untrack(size);
+        begin_ += size;
+        scanned_ = std::max(scanned_, begin_);
+    }
+
+    std::mutex mutex_;
+    dispatch_data_t pending_ = nil;    // Shared with the connection's queue
+    uint64_t pendingSince_ = 0;        // When pending_ started, under mutex_
+    std::atomic<size_t> buffered_{0};  // Received and not consumed
+    oflike::ofNetworkCounters* counters_ = nullptr;
+
+    // Reading thread only
+    std::vector<char> buffer_;
+    size_t begin_ = 0;                 // First unconsumed byte
+    size_t end_ = 0;                   // End of received bytes
+    size_t scanned_ = 0;               // Delimiter search has covered [begin_, scanned_)
+    bool framingError_ = false;
+};
@@ -1,14 +1,34 @@
 #pragma once
 
+#include "../../../oflike/utils/ofNetworkStats.h"
 #include <string>
 #include <memory>
 #include <cstdint>
 
+/// \brief A datagram returned by ofxUdpManager::receiveBatch()
+///
+/// data and senderIP point into the receive queue and stay valid until the
+/// next receive call.
+struct ofxUdpDatagram {
+    const char* data = nullptr;
+    int length = 0;
+    const char* senderIP = nullptr;
+    uint16_t senderPort = 0;
+};
+
 /// \brief UDP Manager using Network.framework
 ///
 /// ofxUdpManager provides a simple interface for UDP communication.
 /// It uses Apple's Network.framework for asynchronous, non-blocking I/O.
 ///
+/// A bound manager receives on one socket read by a dispatch source, which
+/// drains every pending datagram per wakeup into a preallocated ring of
+/// fixed-size slots. The ring is lock-free with a single reader: call the
+/// receive functions from one thread.
+///
+/// Traffic is always counted (see getStats()) and shown in the debug
+/// overlay while bound or connected.
+///
 /// Example usage (receiver):
 /// \code
 /// ofxUdpManager udp;
@@ -18,6 +38,15 @@
 /// }
 /// \endcode
 ///
+/// Example usage (high-rate receiver, no copies):
+/// \code
+/// ofxUdpDatagram datagrams[256];
+/// int count = udp.receiveBatch(datagrams, 256);
+/// for (int i = 0; i < count; i++) {
+///     parse(datagrams[i].data, datagrams[i].length);
+/// }
+/// \endcode
+///
 /// Example usage (sender):
 /// \code
 /// ofxUdpManager udp;
@@ -86,6 +115,14 @@ public:
     /// \return Number of bytes received, 0 if no data, -1 on error
     int receiveFrom(char* buffer, int maxLength, std::string& senderIP, uint16_t& senderPort);
 
+    /// \brief Receive queued datagrams without copying them (non-blocking)
+    /// \details The datagrams' data stays in the receive queue until the next
+    /// receive call, which frees their slots.
+    /// \param datagrams Array to fill
+    /// \param maxCount Maximum number of datagrams to return
+    /// \return Number of datagrams returned, 0 if none
+    int receiveBatch(ofxUdpDatagram* datagrams, int maxCount);
+
     // Multicast
     /// \brief Join a multicast group
     /// \param multicastAddress Multicast IP address (e.g., "224.0.0.1")
@@ -110,10 +147,19 @@ public:
     /// \param nonBlocking true for non-blocking, false for blocking
     void setNonBlocking(bool nonBlocking);
 
-    /// \brief Set receive buffer size
+    /// \brief Set the socket's receive buffer size (SO_RCVBUF)
+    /// \details Datagrams wait there while the receive queue is being filled.
+    /// Takes effect at once if bound; the system default is used otherwise.
     /// \param size Buffer size in bytes
     void setReceiveBufferSize(int size);
 
+    /// \brief Set the receive queue's size; takes effect at the next bind()
+    /// \details Datagrams longer than slotSize are truncated to it. Datagrams
+    /// arriving while every slot is full are dropped.
+    /// \param slotCount Number of datagrams held (rounded up to a power of two, default 1024)
+    /// \param slotSize Bytes per datagram (default 4096)
+    void setReceiveQueueSize(int slotCount, int slotSize);
+
     /// \brief Set send buffer size
     /// \param size Buffer size in bytes
     void setSendBufferSize(int size);
@@ -123,6 +169,19 @@ public:
     /// \return true if ready
     bool isReady() const;
 
+    /// \brief Get the number of datagrams dropped because the receive queue was full
+    /// \return Datagrams dropped since bind()
+    uint64_t getDroppedCount() const;
+
+    /// \brief Get the traffic counters
+    /// \details Counted since bind() or connect(): datagrams received and sent
+    /// (handed to the system), drops, the receive queue's depth and how long
+    /// datagrams waited in it before a receive call took them.
+    oflike::ofNetworkStats getStats() const;
+
+    /// \brief Zero the traffic counters
+    void resetStats();
+
     /// \brief Get last error message
     /// \return Error message
     std::string getError() const;
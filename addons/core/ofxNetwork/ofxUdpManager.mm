@@ -1,19 +1,60 @@
 #include "ofxUdpManager.h"
+#include "../../../oflike/utils/ofSpscQueue.h"
+#include "../../../oflike/utils/ofNetworkStats.h"
 #import <Foundation/Foundation.h>
 #import <Network/Network.h>
-#include <queue>
-#include <mutex>
-
-struct ReceivedDatagram {
-    std::vector<uint8_t> data;
-    std::string senderIP;
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// Datagrams read per wakeup of the read source before yielding the queue
+constexpr int kMaxDatagramsPerRead = 256;
+
+// Receive queue slot: one datagram in its part of the slab
+struct DatagramSlot {
+    char* data = nullptr;
+    int length = 0;
     uint16_t senderPort = 0;
+    char senderIP[INET6_ADDRSTRLEN] = {};
+    uint64_t receivedAt = 0;    // ofNetworkCounters::timestamp()
 };
 
+// Numeric host and port of a sender; IPv4-mapped IPv6 addresses as IPv4
+void FormatAddress(const sockaddr_storage& address, char* ip, uint16_t& port) {
+    if (address.ss_family == AF_INET) {
+        const sockaddr_in& v4 = reinterpret_cast<const sockaddr_in&>(address);
+        inet_ntop(AF_INET, &v4.sin_addr, ip, INET6_ADDRSTRLEN);
+        port = ntohs(v4.sin_port);
+    } else if (address.ss_family == AF_INET6) {
+        const sockaddr_in6& v6 = reinterpret_cast<const sockaddr_in6&>(address);
+        if (IN6_IS_ADDR_V4MAPPED(&v6.sin6_addr)) {
+            inet_ntop(AF_INET, &v6.sin6_addr.s6_addr[12], ip, INET6_ADDRSTRLEN);
+        } else {
+            inet_ntop(AF_INET6, &v6.sin6_addr, ip, INET6_ADDRSTRLEN);
+        }
+        port = ntohs(v6.sin6_port);
+    } else {
+        ip[0] = '\0';
+        port = 0;
+    }
+}
+
+} // namespace
+
 struct ofxUdpManager::Impl {
     nw_connection_t connection = nullptr;
-    nw_listener_t listener = nullptr;
+    dispatch_source_t readSource = nullptr;
     dispatch_queue_t queue = nullptr;
+    int socketFD = -1;
 
     std::string host;
     uint16_t port = 0;
@@ -24,10 +65,17 @@ struct ofxUdpManager::Impl {
     bool isListenerMode = false;  // true for bind, false for connect
 
     std::string errorMessage;
-    std::queue<ReceivedDatagram> receiveQueue;
-    std::mutex receiveMutex;
+    // Datagrams from the socket queue to the receiving thread, in fixed-size
+    // slots of one preallocated slab
+    oflike::ofSpscQueue<DatagramSlot> receiveQueue;
+    std::vector<char> receiveSlab;
+    size_t slotSize = 0;
+    int receiveQueueSlots = 1024;
+    int receiveQueueSlotSize = 4096;
+
+    oflike::ofNetworkCounters counters;
 
-    int receiveBufferSize = 65536;
+    int receiveBufferSize = 0;  // 0 = system default
     int sendBufferSize = 65536;
     uint8_t multicastTTL = 1;
     bool multicastLoopback = false;
@@ -41,15 +89,71 @@ struct ofxUdpManager::Impl {
             nw_connection_cancel(connection);
             connection = nullptr;
         }
-        if (listener) {
-            nw_listener_cancel(listener);
-            listener = nullptr;
+        if (readSource) {
+            // The cancel handler closes the socket; the sync waits for a
+            // read in progress, which may still use the receive queue
+            dispatch_source_cancel(readSource);
+            readSource = nullptr;
+            dispatch_sync(queue, ^{});
+            counters.addQueueDepth(-static_cast<int64_t>(receiveQueue.size()));
         }
+        counters.hide();
+        socketFD = -1;
         if (queue) {
             queue = nullptr;  // ARC handles release
         }
         ready = false;
     }
+
+    void allocateReceiveQueue() {
+        slotSize = static_cast<size_t>(std::max(receiveQueueSlotSize, 1));
+        receiveQueue.allocate(static_cast<size_t>(std::max(receiveQueueSlots, 1)));
+        receiveSlab.assign(receiveQueue.capacity() * slotSize, 0);
+        for (size_t i = 0; i < receiveQueue.capacity(); i++) {
+            receiveQueue.slot(i).data = &receiveSlab[i * slotSize];
+        }
+        counters.reset();
+    }
+
+    // Receiving thread: count the datagram in slot as dequeued
+    void dequeued(const DatagramSlot& slot) {
+        counters.addQueueDepth(-1);
+        counters.addLatencySince(slot.receivedAt);
+    }
+
+    void applyReceiveBufferSize() {
+        if (socketFD >= 0 && receiveBufferSize > 0) {
+            setsockopt(socketFD, SOL_SOCKET, SO_RCVBUF, &receiveBufferSize, sizeof(receiveBufferSize));
+        }
+    }
+
+    // Socket queue: drain the socket into the receive queue. Datagrams that
+    // find every slot in use are read into a scratch byte and dropped, so a
+    // reader falling behind doesn't keep the read source firing.
+    void readDatagrams() {
+        for (int i = 0; i < kMaxDatagramsPerRead; i++) {
+            DatagramSlot* slot = receiveQueue.beginWrite();
+            char scratch;
+            sockaddr_storage sender;
+            socklen_t senderLength = sizeof(sender);
+            const ssize_t received = recvfrom(socketFD, slot ? slot->data : &scratch,
+                                              slot ? slotSize : 1, 0,
+                                              reinterpret_cast<sockaddr*>(&sender), &senderLength);
+            if (received < 0) {
+                return;  // EAGAIN: drained
+            }
+            if (!slot) {
+                counters.addDrops();
+                continue;
+            }
+            slot->length = static_cast<int>(received);
+            slot->receivedAt = oflike::ofNetworkCounters::timestamp();
+            FormatAddress(sender, slot->senderIP, slot->senderPort);
+            counters.addIn(static_cast<size_t>(received));
+            counters.addQueueDepth(1);
+            receiveQueue.commitWrite();
+        }
+    }
 };
 
 ofxUdpManager::ofxUdpManager()
@@ -85,110 +189,89 @@ bool ofxUdpManager::bind(const std::string& address, uint16_t port) {
         pImpl->isListenerMode = true;
         pImpl->errorMessage.clear();
 
-        // Create dispatch queue
-        pImpl->queue = dispatch_queue_create("com.oflike.udp", DISPATCH_QUEUE_SERIAL);
-        if (!pImpl->queue) {
-            pImpl->errorMessage = "Failed to create dispatch queue";
+        // Any address binds both IPv4 and IPv6; a numeric one binds its family
+        sockaddr_storage local = {};
+        socklen_t localLength = 0;
+        sockaddr_in& v4 = reinterpret_cast<sockaddr_in&>(local);
+        sockaddr_in6& v6 = reinterpret_cast<sockaddr_in6&>(local);
+        const bool anyAddress = address.empty() || address == "0.0.0.0" || address == "::";
+        if (anyAddress) {
+            v6.sin6_family = AF_INET6;
+            v6.sin6_addr = in6addr_any;
+            v6.sin6_port = htons(port);
+            localLength = sizeof(sockaddr_in6);
+        } else if (inet_pton(AF_INET, address.c_str(), &v4.sin_addr) == 1) {
+            v4.sin_family = AF_INET;
+            v4.sin_port = htons(port);
+            localLength = sizeof(sockaddr_in);
+        } else if (inet_pton(AF_INET6, address.c_str(), &v6.sin6_addr) == 1) {
+            v6.sin6_family = AF_INET6;
+            v6.sin6_port = htons(port);
+            localLength = sizeof(sockaddr_in6);
+        } else {
+            pImpl->errorMessage = "Invalid bind address: " + address;
             return false;
         }
 
-        // Create UDP parameters
-        nw_parameters_t parameters = nw_parameters_create_secure_udp(
-            NW_PARAMETERS_DISABLE_PROTOCOL,  // Disable DTLS for plain UDP
-            NW_PARAMETERS_DEFAULT_CONFIGURATION
-        );
-
-        if (!parameters) {
-            pImpl->errorMessage = "Failed to create parameters";
+        // Create socket
+        const int fd = socket(local.ss_family, SOCK_DGRAM, IPPROTO_UDP);
+        if (fd < 0) {
+            pImpl->errorMessage = std::string("Failed to create socket: ") + std::strerror(errno);
             return false;
         }
+        const int on = 1;
+        const int off = 0;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));
+        if (anyAddress) {
+            setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
 
-        // Allow local address reuse
-        nw_parameters_set_reuse_local_address(parameters, true);
-
-        // Create listener
-        NSString* portStr = [NSString stringWithFormat:@"%u", port];
-        pImpl->listener = nw_listener_create_with_port([portStr UTF8String], parameters);
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&local), localLength) != 0) {
+            pImpl->errorMessage = std::string("Failed to bind: ") + std::strerror(errno);
+            ::close(fd);
+            return false;
+        }
+        if (port == 0) {
+            // Report the port the system picked
+            localLength = sizeof(local);
+            getsockname(fd, reinterpret_cast<sockaddr*>(&local), &localLength);
+            pImpl->localPort = ntohs(local.ss_family == AF_INET ? v4.sin_port : v6.sin6_port);
+        }
+        pImpl->socketFD = fd;
+        pImpl->applyReceiveBufferSize();
 
-        if (!pImpl->listener) {
-            pImpl->errorMessage = "Failed to create listener";
+        // Create dispatch queue
+        pImpl->queue = dispatch_queue_create("com.oflike.udp", DISPATCH_QUEUE_SERIAL);
+        if (!pImpl->queue) {
+            pImpl->errorMessage = "Failed to create dispatch queue";
+            ::close(fd);
+            pImpl->socketFD = -1;
             return false;
         }
 
-        // Set queue
-        nw_listener_set_queue(pImpl->listener, pImpl->queue);
+        pImpl->allocateReceiveQueue();
 
-        // Set state change handler
-        nw_listener_set_state_changed_handler(pImpl->listener, ^(nw_listener_state_t state, nw_error_t error) {
-            switch (state) {
-                case nw_listener_state_ready:
-                    pImpl->ready = true;
-                    break;
-                case nw_listener_state_failed:
-                    pImpl->ready = false;
-                    if (error) {
-                        pImpl->errorMessage = "Listener failed";
-                    }
-                    break;
-                case nw_listener_state_cancelled:
-                    pImpl->ready = false;
-                    break;
-                default:
-                    break;
-            }
+        // One wakeup per batch of pending datagrams on the persistent socket
+        pImpl->readSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, fd, 0, pImpl->queue);
+        if (!pImpl->readSource) {
+            pImpl->errorMessage = "Failed to create read source";
+            ::close(fd);
+            pImpl->socketFD = -1;
+            return false;
+        }
+        Impl* impl = pImpl.get();
+        dispatch_source_set_event_handler(pImpl->readSource, ^{
+            impl->readDatagrams();
         });
-
-        // Set new connection handler (for each incoming datagram)
-        nw_listener_set_new_connection_handler(pImpl->listener, ^(nw_connection_t connection) {
-            // Set queue
-            nw_connection_set_queue(connection, pImpl->queue);
-
-            // Receive data
-            nw_connection_receive(
-                connection,
-                1,      // minimum_incomplete_length
-                pImpl->receiveBufferSize,
-                ^(dispatch_data_t content, nw_content_context_t context, bool is_complete, nw_error_t error) {
-                    if (content && !error) {
-                        const void* buffer;
-                        size_t size;
-                        dispatch_data_t contiguous = dispatch_data_create_map(content, &buffer, &size);
-
-                        if (buffer && size > 0) {
-                            // Get sender info
-                            nw_endpoint_t endpoint = nw_connection_copy_endpoint(connection);
-                            ReceivedDatagram datagram;
-                            datagram.data.assign(static_cast<const uint8_t*>(buffer),
-                                               static_cast<const uint8_t*>(buffer) + size);
-
-                            if (endpoint) {
-                                const char* hostname = nw_endpoint_get_hostname(endpoint);
-                                if (hostname) {
-                                    datagram.senderIP = std::string(hostname);
-                                }
-                                datagram.senderPort = nw_endpoint_get_port(endpoint);
-                            }
-
-                            std::lock_guard<std::mutex> lock(pImpl->receiveMutex);
-                            pImpl->receiveQueue.push(std::move(datagram));
-                        }
-                    }
-
-                    // Cancel this connection (UDP is connectionless)
-                    nw_connection_cancel(connection);
-                }
-            );
-
-            // Start connection
-            nw_connection_start(connection);
+        dispatch_source_set_cancel_handler(pImpl->readSource, ^{
+            ::close(fd);
         });
+        dispatch_resume(pImpl->readSource);
 
-        // Start listener
-        nw_listener_start(pImpl->listener);
-
-        // Wait briefly for listener to become ready
-        usleep(10000);  // 10ms
-
+        pImpl->counters.show("UDP :" + std::to_string(pImpl->localPort));
+        pImpl->ready = true;
         return true;
     }
 }
@@ -266,6 +349,8 @@ bool ofxUdpManager::connect(const std::string& host, uint16_t port) {
 
         // Start connection
         nw_connection_start(pImpl->connection);
+        pImpl->counters.reset();
+        pImpl->counters.show("UDP to " + host + ":" + std::to_string(port));
 
         // Wait for connection if blocking mode
         if (!pImpl->nonBlocking) {
@@ -321,6 +406,7 @@ int ofxUdpManager::send(const char* data, int length) {
                 completed = true;
             }
         );
+        pImpl->counters.addOut(static_cast<size_t>(length));
 
         // Wait for completion if blocking mode
         if (!pImpl->nonBlocking) {
@@ -402,6 +488,9 @@ int ofxUdpManager::sendTo(const std::string& host, uint16_t port, const char* da
             timeout--;
         }
 
+        if (sent) {
+            pImpl->counters.addOut(static_cast<size_t>(length));
+        }
         return sent ? length : -1;
     }
 }
@@ -413,24 +502,49 @@ int ofxUdpManager::receive(char* buffer, int maxLength) {
 }
 
 int ofxUdpManager::receiveFrom(char* buffer, int maxLength, std::string& senderIP, uint16_t& senderPort) {
-    std::lock_guard<std::mutex> lock(pImpl->receiveMutex);
-
-    if (pImpl->receiveQueue.empty()) {
+    if (!pImpl->readSource) {
         return 0;
     }
 
-    ReceivedDatagram datagram = std::move(pImpl->receiveQueue.front());
-    pImpl->receiveQueue.pop();
+    pImpl->receiveQueue.release();
+    const DatagramSlot* slot = pImpl->receiveQueue.read();
+    if (!slot) {
+        return 0;
+    }
 
-    int bytesToCopy = std::min(static_cast<int>(datagram.data.size()), maxLength);
-    std::memcpy(buffer, datagram.data.data(), bytesToCopy);
+    int bytesToCopy = std::min(slot->length, maxLength);
+    std::memcpy(buffer, slot->data, bytesToCopy);
 
-    senderIP = datagram.senderIP;
-    senderPort = datagram.senderPort;
+    senderIP = slot->senderIP;
+    senderPort = slot->senderPort;
+    pImpl->dequeued(*slot);
 
+    pImpl->receiveQueue.release();
     return bytesToCopy;
 }
 
+int ofxUdpManager::receiveBatch(ofxUdpDatagram* datagrams, int maxCount) {
+    if (!pImpl->readSource) {
+        return 0;
+    }
+
+    pImpl->receiveQueue.release();
+    int count = 0;
+    while (count < maxCount) {
+        const DatagramSlot* slot = pImpl->receiveQueue.read();
+        if (!slot) {
+            break;
+        }
+        datagrams[count].data = slot->data;
+        datagrams[count].length = slot->length;
+        datagrams[count].senderIP = slot->senderIP;
+        datagrams[count].senderPort = slot->senderPort;
+        pImpl->dequeued(*slot);
+        count++;
+    }
+    return count;
+}
+
 bool ofxUdpManager::joinMulticastGroup(const std::string& multicastAddress) {
     // Network.framework handles multicast automatically when binding to multicast addresses
     // Additional configuration can be done through parameters if needed
@@ -456,6 +570,24 @@ void ofxUdpManager::setNonBlocking(bool nonBlocking) {
 
 void ofxUdpManager::setReceiveBufferSize(int size) {
     pImpl->receiveBufferSize = size;
+    pImpl->applyReceiveBufferSize();
+}
+
+void ofxUdpManager::setReceiveQueueSize(int slotCount, int slotSize) {
+    pImpl->receiveQueueSlots = slotCount;
+    pImpl->receiveQueueSlotSize = slotSize;
+}
+
+uint64_t ofxUdpManager::getDroppedCount() const {
+    return pImpl->counters.getDrops();
+}
+
+oflike::ofNetworkStats ofxUdpManager::getStats() const {
+    return pImpl->counters.getStats();
+}
+
+void ofxUdpManager::resetStats() {
+    pImpl->counters.reset();
 }
 
 void ofxUdpManager::setSendBufferSize(int size) {
@@ -0,0 +1,15 @@
+#include "ofxUdpTelemetry.h"
+#include <vector>
+
+bool ofxUdpSendTelemetry(ofxUdpManager& udp, const oflike::ofTelemetryBatch& batch, size_t maxPacketSize) {
+    std::vector<std::string> packets;
+    oflike::ofTelemetry::formatStatsd(batch, packets, maxPacketSize);
+
+    bool sent = true;
+    for (const std::string& packet : packets) {
+        if (udp.send(packet.data(), static_cast<int>(packet.size())) < 0) {
+            sent = false;
+        }
+    }
+    return sent;
+}
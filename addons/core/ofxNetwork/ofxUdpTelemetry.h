@@ -0,0 +1,16 @@
+#pragma once
+
+// ofxUdpTelemetry - Send ofTelemetry batches to a statsd collector
+// Lines like "stage-a.frame.ms.p99:16.7|g", newline-separated in
+// MTU-sized datagrams, as statsd, Telegraf and Datadog agents read them.
+
+#include "ofxUdpManager.h"
+#include "../../../oflike/utils/ofTelemetry.h"
+
+/// \brief Send a telemetry batch as statsd lines
+/// \param udp Manager connected to the collector (usually port 8125)
+/// \param batch Batch given to the ofTelemetry exporter
+/// \param maxPacketSize Bytes per datagram (see ofTelemetry::formatStatsd())
+/// \return false if a datagram could not be sent
+bool ofxUdpSendTelemetry(ofxUdpManager& udp, const oflike::ofTelemetryBatch& batch,
+                         size_t maxPacketSize = 1432);
@@ -0,0 +1,306 @@
+#include "ofxVideoStreamPacket.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+void writeU16(uint8_t* destination, uint16_t value) {
+    destination[0] = static_cast<uint8_t>(value >> 8);
+    destination[1] = static_cast<uint8_t>(value);
+}
+
+void writeU32(uint8_t* destination, uint32_t value) {
+    destination[0] = static_cast<uint8_t>(value >> 24);
+    destination[1] = static_cast<uint8_t>(value >> 16);
+    destination[2] = static_cast<uint8_t>(value >> 8);
+    destination[3] = static_cast<uint8_t>(value);
+}
+
+uint16_t readU16(const uint8_t* source) {
+    return static_cast<uint16_t>((source[0] << 8) | source[1]);
+}
+
+uint32_t readU32(const uint8_t* source) {
+    return (static_cast<uint32_t>(source[0]) << 24) | (static_cast<uint32_t>(source[1]) << 16) |
+           (static_cast<uint32_t>(source[2]) << 8) | static_cast<uint32_t>(source[3]);
+}
+
+void xorInto(uint8_t* destination, const uint8_t* source, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        destination[i] ^= source[i];
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// ofxVideoStreamPacketHeader
+// ============================================================================
+
+void ofxVideoStreamPacketHeader::write(uint8_t* destination) const {
+    writeU32(destination, kMagic);
+    destination[4] = kVersion;
+    destination[5] = type;
+    destination[6] = flags;
+    destination[7] = fecGroupSize;
+    writeU32(destination + 8, frameId);
+    writeU32(destination + 12, frameSize);
+    writeU16(destination + 16, index);
+    writeU16(destination + 18, dataCount);
+    writeU16(destination + 20, payloadSize);
+    writeU16(destination + 22, feedbackPort);
+}
+
+bool ofxVideoStreamPacketHeader::read(const uint8_t* source, size_t size) {
+    if (size < kSize || readU32(source) != kMagic || source[4] != kVersion) {
+        return false;
+    }
+    type = source[5];
+    flags = source[6];
+    fecGroupSize = source[7];
+    frameId = readU32(source + 8);
+    frameSize = readU32(source + 12);
+    index = readU16(source + 16);
+    dataCount = readU16(source + 18);
+    payloadSize = readU16(source + 20);
+    feedbackPort = readU16(source + 22);
+    return true;
+}
+
+// ============================================================================
+// ofxVideoStreamPacketizer
+// ============================================================================
+
+void ofxVideoStreamPacketizer::setup(size_t maxPacketSize, int fecGroupSize) {
+    const size_t packetSize = std::min<size_t>(std::max<size_t>(maxPacketSize, 256), 65507);
+    payloadSize_ = std::min<size_t>(packetSize - ofxVideoStreamPacketHeader::kSize, 65535);
+    fecGroupSize_ = std::min(std::max(fecGroupSize, 0), 255);
+}
+
+size_t ofxVideoStreamPacketizer::packetize(uint32_t frameId, bool keyFrame, const uint8_t* frame,
+                                           size_t size, uint16_t feedbackPort) {
+    const size_t dataCount = (size + payloadSize_ - 1) / payloadSize_;
+    if (dataCount == 0 || dataCount > 65535 || size > ofxVideoStreamAssembler::kMaxFrameSize) {
+        return 0;
+    }
+    const size_t groupSize = fecGroupSize_ > 0 ? static_cast<size_t>(fecGroupSize_) : dataCount;
+    const size_t groups = fecGroupSize_ > 0 ? (dataCount + groupSize - 1) / groupSize : 0;
+
+    constexpr size_t kHeader = ofxVideoStreamPacketHeader::kSize;
+    packets_.resize(dataCount * kHeader + size + groups * (kHeader + payloadSize_));
+    offsets_.resize(dataCount + groups + 1);
+
+    ofxVideoStreamPacketHeader header;
+    header.flags = keyFrame ? ofxVideoStreamPacketHeader::KeyFrame : 0;
+    header.fecGroupSize = static_cast<uint8_t>(fecGroupSize_);
+    header.frameId = frameId;
+    header.frameSize = static_cast<uint32_t>(size);
+    header.dataCount = static_cast<uint16_t>(dataCount);
+    header.payloadSize = static_cast<uint16_t>(payloadSize_);
+    header.feedbackPort = feedbackPort;
+
+    // Each group's data packets, then its parity packet
+    size_t offset = 0;
+    size_t packet = 0;
+    for (size_t first = 0; first < dataCount; first += groupSize) {
+        const size_t last = std::min(first + groupSize, dataCount);
+        for (size_t i = first; i < last; i++) {
+            const size_t payload = std::min(payloadSize_, size - i * payloadSize_);
+            header.type = ofxVideoStreamPacketHeader::Data;
+            header.index = static_cast<uint16_t>(i);
+            offsets_[packet++] = offset;
+            header.write(&packets_[offset]);
+            std::memcpy(&packets_[offset + kHeader], frame + i * payloadSize_, payload);
+            offset += kHeader + payload;
+        }
+        if (groups > 0) {
+            header.type = ofxVideoStreamPacketHeader::Parity;
+            header.index = static_cast<uint16_t>(first / groupSize);
+            offsets_[packet++] = offset;
+            header.write(&packets_[offset]);
+            uint8_t* parity = &packets_[offset + kHeader];
+            std::memset(parity, 0, payloadSize_);
+            for (size_t i = first; i < last; i++) {
+                xorInto(parity, frame + i * payloadSize_, std::min(payloadSize_, size - i * payloadSize_));
+            }
+            offset += kHeader + payloadSize_;
+        }
+    }
+    offsets_[packet] = offset;
+    return packet;
+}
+
+// ============================================================================
+// ofxVideoStreamAssembler
+// ============================================================================
+
+ofxVideoStreamAssembler::ofxVideoStreamAssembler() {
+}
+
+void ofxVideoStreamAssembler::reset() {
+    for (Slot& slot : slots_) {
+        slot.active = false;
+    }
+    haveLast_ = false;
+    waitingForKeyFrame_ = true;
+    frame_ = nullptr;
+    frameSize_ = 0;
+}
+
+bool ofxVideoStreamAssembler::add(const uint8_t* packet, size_t size) {
+    ofxVideoStreamPacketHeader header;
+    if (!header.read(packet, size) || header.dataCount == 0 || header.payloadSize == 0) {
+        return false;
+    }
+
+    // Reject sizes that don't add up, so copies below stay in bounds
+    const size_t n = header.dataCount;
+    const size_t p = header.payloadSize;
+    if (header.frameSize > kMaxFrameSize || header.frameSize > n * p || header.frameSize <= (n - 1) * p) {
+        return false;
+    }
+    const size_t groups = header.fecGroupSize > 0 ? (n + header.fecGroupSize - 1) / header.fecGroupSize : 0;
+    const uint8_t* payload = packet + ofxVideoStreamPacketHeader::kSize;
+    const size_t payloadBytes = size - ofxVideoStreamPacketHeader::kSize;
+    if (header.type == ofxVideoStreamPacketHeader::Data) {
+        if (header.index >= n) {
+            return false;
+        }
+    } else if (header.type != ofxVideoStreamPacketHeader::Parity || header.index >= groups ||
+               payloadBytes != p) {
+        return false;
+    }
+
+    feedbackPort_ = header.feedbackPort;
+    if (haveLast_ && !isNewer(header.frameId, lastFrameId_)) {
+        return false;  // Late: handed out or given up on already
+    }
+
+    Slot& slot = slots_[header.frameId % kSlots];
+    if (slot.active && slot.frameId != header.frameId) {
+        if (!isNewer(header.frameId, slot.frameId)) {
+            return false;
+        }
+        retire(slot);
+    }
+    if (!slot.active) {
+        start(slot, header);
+    } else if (slot.header.dataCount != header.dataCount || slot.header.payloadSize != header.payloadSize ||
+               slot.header.frameSize != header.frameSize || slot.header.fecGroupSize != header.fecGroupSize) {
+        return false;  // Inconsistent with the frame's other packets
+    }
+    if (slot.done) {
+        return false;
+    }
+
+    if (header.type == ofxVideoStreamPacketHeader::Data) {
+        if (payloadBytes != payloadSize(slot, header.index) || slot.received[header.index]) {
+            return false;
+        }
+        std::memcpy(&slot.data[header.index * p], payload, payloadBytes);
+        slot.received[header.index] = 1;
+        slot.numReceived++;
+        if (groups > 0) {
+            repair(slot, header.index / header.fecGroupSize);
+        }
+    } else {
+        if (slot.hasParity[header.index]) {
+            return false;
+        }
+        std::memcpy(&slot.parity[header.index * p], payload, p);
+        slot.hasParity[header.index] = 1;
+        repair(slot, header.index);
+    }
+
+    return slot.numReceived == n && finish(slot);
+}
+
+void ofxVideoStreamAssembler::start(Slot& slot, const ofxVideoStreamPacketHeader& header) {
+    const size_t n = header.dataCount;
+    const size_t groups = header.fecGroupSize > 0 ? (n + header.fecGroupSize - 1) / header.fecGroupSize : 0;
+    slot.active = true;
+    slot.done = false;
+    slot.frameId = header.frameId;
+    slot.header = header;
+    slot.numReceived = 0;
+    slot.data.resize(header.frameSize);
+    slot.received.assign(n, 0);
+    slot.parity.resize(groups * header.payloadSize);
+    slot.hasParity.assign(groups, 0);
+}
+
+void ofxVideoStreamAssembler::retire(Slot& slot) {
+    // An unfinished frame is counted as lost when a later one is handed out
+    slot.active = false;
+}
+
+size_t ofxVideoStreamAssembler::payloadSize(const Slot& slot, size_t index) const {
+    const size_t p = slot.header.payloadSize;
+    return index + 1 < slot.header.dataCount ? p : slot.header.frameSize - index * p;
+}
+
+void ofxVideoStreamAssembler::repair(Slot& slot, size_t group) {
+    if (!slot.hasParity[group]) {
+        return;
+    }
+    const size_t p = slot.header.payloadSize;
+    const size_t first = group * slot.header.fecGroupSize;
+    const size_t last = std::min<size_t>(first + slot.header.fecGroupSize, slot.header.dataCount);
+
+    size_t missing = last;
+    for (size_t i = first; i < last; i++) {
+        if (!slot.received[i]) {
+            if (missing != last) {
+                return;  // Two or more lost: parity can't tell them apart
+            }
+            missing = i;
+        }
+    }
+    if (missing == last) {
+        return;
+    }
+
+    // The parity is no longer needed once the group is whole: XOR in place
+    uint8_t* parity = &slot.parity[group * p];
+    for (size_t i = first; i < last; i++) {
+        if (i != missing) {
+            xorInto(parity, &slot.data[i * p], payloadSize(slot, i));
+        }
+    }
+    std::memcpy(&slot.data[missing * p], parity, payloadSize(slot, missing));
+    slot.received[missing] = 1;
+    slot.numReceived++;
+    recovered_++;
+}
+
+bool ofxVideoStreamAssembler::finish(Slot& slot) {
+    slot.done = true;
+    const uint32_t frameId = slot.frameId;
+    const bool keyFrame = (slot.header.flags & ofxVideoStreamPacketHeader::KeyFrame) != 0;
+
+    // Frames skipped over are lost, and so is everything that refers to them
+    if (haveLast_ && frameId != lastFrameId_ + 1) {
+        lost_ += frameId - lastFrameId_ - 1;
+        waitingForKeyFrame_ = true;
+    }
+    for (Slot& other : slots_) {
+        if (other.active && &other != &slot && !isNewer(other.frameId, frameId)) {
+            other.active = false;
+        }
+    }
+    haveLast_ = true;
+    lastFrameId_ = frameId;
+
+    if (keyFrame) {
+        waitingForKeyFrame_ = false;
+    } else if (waitingForKeyFrame_) {
+        lost_++;
+        return false;
+    }
+
+    frame_ = slot.data.data();
+    frameSize_ = slot.data.size();
+    keyFrame_ = keyFrame;
+    completed_++;
+    return true;
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \brief Wire format of ofxVideoStreamSender / ofxVideoStreamReceiver
+///
+/// Every datagram starts with a 24-byte big-endian header. An encoded frame
+/// is split into data packets of equal payload size (the last one shorter);
+/// with FEC, each group of fecGroupSize data packets is followed by one
+/// parity packet, the XOR of the group's payloads zero-padded to full size,
+/// which restores any single packet lost from the group.
+///
+/// \code
+/// 0   magic 'OFVS'         4   version, type, flags, fecGroupSize
+/// 8   frame id             12  frame size in bytes
+/// 16  packet index         18  data packet count
+/// 20  payload size         22  sender's feedback port (0 = none)
+/// \endcode
+///
+/// A frame is one encoded picture: a byte for the codec (0 H.264, 1 HEVC),
+/// one for the NAL unit length size and one for the number of parameter
+/// sets (keyframes only, 0 otherwise), then each parameter set as a 16-bit
+/// size and its bytes, then the picture's length-prefixed NAL units as
+/// VideoToolbox writes them, so neither side rewrites the bitstream.
+struct ofxVideoStreamPacketHeader {
+    static constexpr uint32_t kMagic = 0x4F465653;  // 'OFVS'
+    static constexpr uint8_t kVersion = 1;
+    static constexpr size_t kSize = 24;
+
+    enum Type : uint8_t {
+        Data = 0,
+        Parity = 1,            ///< index is the FEC group
+        KeyFrameRequest = 2    ///< Receiver to sender; header only
+    };
+
+    enum Flags : uint8_t {
+        KeyFrame = 1 << 0
+    };
+
+    uint8_t type = Data;
+    uint8_t flags = 0;
+    uint8_t fecGroupSize = 0;
+    uint32_t frameId = 0;
+    uint32_t frameSize = 0;
+    uint16_t index = 0;
+    uint16_t dataCount = 0;
+    uint16_t payloadSize = 0;
+    uint16_t feedbackPort = 0;
+
+    void write(uint8_t* destination) const;
+
+    /// \return false if the bytes aren't a header of this version
+    bool read(const uint8_t* source, size_t size);
+};
+
+/// \brief Splits encoded frames into datagrams, adding FEC parity packets
+///
+/// Packets are built into one reused buffer, so packetizing allocates
+/// nothing once the buffer has grown to the largest frame.
+class ofxVideoStreamPacketizer {
+public:
+    /// \param maxPacketSize Datagram size including the header
+    /// \param fecGroupSize Data packets per parity packet (0 = no FEC, max 255)
+    void setup(size_t maxPacketSize, int fecGroupSize);
+
+    /// \brief Split a frame into packets
+    /// \return Number of packets, 0 if the frame is empty or too large
+    size_t packetize(uint32_t frameId, bool keyFrame, const uint8_t* frame, size_t size,
+                     uint16_t feedbackPort);
+
+    const uint8_t* getPacket(size_t index) const { return packets_.data() + offsets_[index]; }
+    size_t getPacketSize(size_t index) const { return offsets_[index + 1] - offsets_[index]; }
+
+private:
+    size_t payloadSize_ = 1400 - ofxVideoStreamPacketHeader::kSize;
+    int fecGroupSize_ = 0;
+    std::vector<uint8_t> packets_;
+    std::vector<size_t> offsets_;
+};
+
+/// \brief Reassembles frames from datagrams, repairing losses with FEC
+///
+/// Frames are assembled in a few slots at once, so packets of overlapping
+/// frames may interleave. Frames are handed out in order: when one is lost
+/// (or arrives after a later one), the frames that depend on it are dropped
+/// until the next keyframe, and needsKeyFrame() stays true until then.
+class ofxVideoStreamAssembler {
+public:
+    // Frames larger than this are rejected
+    static constexpr size_t kMaxFrameSize = 32 * 1024 * 1024;
+
+    ofxVideoStreamAssembler();
+
+    /// \brief Add a datagram
+    /// \return true if it completed the next frame, which getFrame() returns
+    /// until the next call
+    bool add(const uint8_t* packet, size_t size);
+
+    const uint8_t* getFrame() const { return frame_; }
+    size_t getFrameSize() const { return frameSize_; }
+    bool isKeyFrame() const { return keyFrame_; }
+
+    /// \brief Check if frames are being dropped for want of a keyframe
+    bool needsKeyFrame() const { return waitingForKeyFrame_; }
+
+    /// \brief Feedback port of the last packet's sender (0 = none)
+    uint16_t getFeedbackPort() const { return feedbackPort_; }
+
+    uint64_t getFramesCompleted() const { return completed_; }
+    uint64_t getFramesLost() const { return lost_; }
+    uint64_t getPacketsRecovered() const { return recovered_; }
+
+    void reset();
+
+private:
+    static constexpr size_t kSlots = 4;
+
+    struct Slot {
+        bool active = false;
+        bool done = false;
+        uint32_t frameId = 0;
+        ofxVideoStreamPacketHeader header;
+        std::vector<uint8_t> data;
+        std::vector<uint8_t> received;     // Per data packet
+        std::vector<uint8_t> parity;       // Per group, payloadSize bytes each
+        std::vector<uint8_t> hasParity;    // Per group
+        size_t numReceived = 0;
+    };
+
+    bool isNewer(uint32_t a, uint32_t b) const { return static_cast<int32_t>(a - b) > 0; }
+    void start(Slot& slot, const ofxVideoStreamPacketHeader& header);
+    void retire(Slot& slot);
+    void repair(Slot& slot, size_t group);
+    size_t payloadSize(const Slot& slot, size_t index) const;
+    bool finish(Slot& slot);
+
+    Slot slots_[kSlots];
+    bool haveLast_ = false;
+    uint32_t lastFrameId_ = 0;           // Last frame handed out or given up on
+    bool waitingForKeyFrame_ = true;
+    uint16_t feedbackPort_ = 0;
+
+    const uint8_t* frame_ = nullptr;
+    size_t frameSize_ = 0;
+    bool keyFrame_ = false;
+
+    uint64_t completed_ = 0;
+    uint64_t lost_ = 0;
+    uint64_t recovered_ = 0;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../../../oflike/image/ofTexture.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/// \brief Receives an ofxVideoStreamSender stream into an ofTexture
+///
+/// update() drains the socket, reassembles frames (repairing lost packets
+/// with the stream's parity packets) and hands each complete frame to the
+/// hardware decoder at once. Decoded frames stay on the GPU: the newest one
+/// is wrapped as the texture through its IOSurface and converted from
+/// YCbCr in the shader, and older undrawn frames are skipped.
+///
+/// After a loss the parity can't repair, frames are dropped until the next
+/// keyframe and the receiver asks the sender for one.
+///
+/// Example usage:
+/// \code
+/// ofxVideoStreamReceiver receiver;
+/// receiver.setup(9000);
+///
+/// // In update()
+/// receiver.update();
+///
+/// // In draw()
+/// receiver.draw(0, 0, ofGetWidth(), ofGetHeight());
+/// \endcode
+class ofxVideoStreamReceiver {
+public:
+    ofxVideoStreamReceiver();
+    ~ofxVideoStreamReceiver();
+
+    // Non-copyable
+    ofxVideoStreamReceiver(const ofxVideoStreamReceiver&) = delete;
+    ofxVideoStreamReceiver& operator=(const ofxVideoStreamReceiver&) = delete;
+
+    // Setup
+    /// \brief Start receiving on a port
+    /// \return true if bound
+    bool setup(uint16_t port);
+
+    /// \brief Stop receiving and release the decoder
+    void close();
+
+    // Frames
+    /// \brief Receive and decode pending frames, and show the newest decoded one
+    /// \details Call once per frame on the main thread.
+    void update();
+
+    /// \brief Check if the last update() showed a new frame
+    bool isFrameNew() const;
+
+    /// \brief Check if any frame has been shown
+    bool isReceiving() const;
+
+    /// \brief Draw the current frame
+    void draw(float x, float y) const;
+    void draw(float x, float y, float w, float h) const;
+
+    /// \brief Get the texture showing the current frame
+    oflike::ofTexture& getTexture();
+    const oflike::ofTexture& getTexture() const;
+
+    float getWidth() const;
+    float getHeight() const;
+
+    // Statistics
+    /// \brief Frames decoded since setup()
+    uint64_t getFramesDecoded() const;
+
+    /// \brief Frames lost since setup(), including those dropped while
+    /// waiting for a keyframe
+    uint64_t getFramesLost() const;
+
+    /// \brief Packets restored from parity since setup()
+    uint64_t getPacketsRecovered() const;
+
+    /// \brief Get last error message
+    std::string getError() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
@@ -0,0 +1,347 @@
+#include "ofxVideoStreamReceiver.h"
+#include "ofxVideoStreamPacket.h"
+#include "ofxUdpManager.h"
+#import <Foundation/Foundation.h>
+#import <CoreVideo/CoreVideo.h>
+#import <QuartzCore/QuartzCore.h>
+#import <VideoToolbox/VideoToolbox.h>
+#include "../../../oflike/video/VideoFrameTexture.h"
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+// Receive queue: a few frames' worth of full-size datagrams
+static constexpr int kQueueSlots = 4096;
+static constexpr int kSlotSize = 2048;
+static constexpr int kSocketBufferSize = 8 * 1024 * 1024;
+
+// Parameter sets in a keyframe (VPS, SPS, PPS and extensions)
+static constexpr size_t kMaxParameterSets = 8;
+
+// Minimum interval between keyframe requests
+static constexpr double kKeyFrameRequestInterval = 0.1;
+
+// ============================================================================
+// ofxVideoStreamReceiver::Impl
+// ============================================================================
+
+struct ofxVideoStreamReceiver::Impl {
+    ofxUdpManager udp;
+    ofxVideoStreamAssembler assembler;
+    std::string senderIP;
+    double lastKeyFrameRequest = 0.0;
+    std::string errorMessage;
+
+    // Decoder (main thread)
+    VTDecompressionSessionRef session = nullptr;
+    CMVideoFormatDescriptionRef format = nullptr;
+    std::vector<uint8_t> parameterSets;    // Section of the keyframe format was made from
+
+    // Decoder output
+    std::mutex latestMutex;
+    CVPixelBufferRef latest = nullptr;     // Newest decoded frame not shown yet
+    std::atomic<uint64_t> decoded{0};
+    std::atomic<bool> decodeFailed{false};
+
+    // Shown frame (main thread)
+    oflike::VideoFrameTexture frames;
+    oflike::ofTexture texture;
+    int width = 0;
+    int height = 0;
+    bool frameNew = false;
+    bool receiving = false;
+
+    ~Impl() {
+        close();
+    }
+
+    void close() {
+        udp.close();
+        destroySession();
+        if (format) {
+            CFRelease(format);
+            format = nullptr;
+        }
+        parameterSets.clear();
+        {
+            std::lock_guard<std::mutex> lock(latestMutex);
+            CVPixelBufferRelease(latest);
+            latest = nullptr;
+        }
+        frames.clear();
+        assembler = ofxVideoStreamAssembler();
+        decoded = 0;
+        senderIP.clear();
+        frameNew = false;
+        receiving = false;
+    }
+
+    void destroySession() {
+        if (session) {
+            VTDecompressionSessionWaitForAsynchronousFrames(session);
+            VTDecompressionSessionInvalidate(session);
+            CFRelease(session);
+            session = nullptr;
+        }
+    }
+
+    static void didDecode(void* refcon, void*, OSStatus status, VTDecodeInfoFlags,
+                          CVImageBufferRef imageBuffer, CMTime, CMTime) {
+        Impl& impl = *static_cast<Impl*>(refcon);
+        if (status != noErr || !imageBuffer) {
+            impl.decodeFailed = true;
+            return;
+        }
+        std::lock_guard<std::mutex> lock(impl.latestMutex);
+        CVPixelBufferRelease(impl.latest);
+        impl.latest = CVPixelBufferRetain(imageBuffer);
+        impl.decoded++;
+    }
+
+    bool createSession(CMVideoFormatDescriptionRef next) {
+        if (session && VTDecompressionSessionCanAcceptFormatDescription(session, next)) {
+            return true;
+        }
+        destroySession();
+
+        // Bi-planar 4:2:0 straight from the decoder: no conversion before the
+        // texture samples it
+        NSDictionary* destinationAttributes = @{
+            (NSString*)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange),
+            (NSString*)kCVPixelBufferMetalCompatibilityKey: @YES,
+            (NSString*)kCVPixelBufferIOSurfacePropertiesKey: @{},
+        };
+        NSDictionary* decoderSpecification = @{
+            (__bridge NSString*)kVTVideoDecoderSpecification_EnableHardwareAcceleratedVideoDecoder: @YES,
+        };
+        VTDecompressionOutputCallbackRecord callback = {&didDecode, this};
+        const OSStatus status = VTDecompressionSessionCreate(kCFAllocatorDefault, next,
+                                                             (__bridge CFDictionaryRef)decoderSpecification,
+                                                             (__bridge CFDictionaryRef)destinationAttributes,
+                                                             &callback, &session);
+        if (status != noErr) {
+            session = nullptr;
+            errorMessage = "Failed to create decoder";
+            NSLog(@"ofxVideoStreamReceiver: Failed to create decoder (%d)", static_cast<int>(status));
+            return false;
+        }
+        VTSessionSetProperty(session, kVTDecompressionPropertyKey_RealTime, kCFBooleanTrue);
+        return true;
+    }
+
+    // Parse a frame (see ofxVideoStreamPacket.h) and decode it
+    void decode(const uint8_t* frame, size_t size) {
+        if (size < 3) return;
+        const bool hevc = frame[0] == 1;
+        const int nalLength = frame[1];
+        const size_t count = frame[2];
+        size_t pos = 3;
+
+        if (count > 0) {
+            if (count > kMaxParameterSets) return;
+            const uint8_t* sets[kMaxParameterSets];
+            size_t sizes[kMaxParameterSets];
+            for (size_t i = 0; i < count; i++) {
+                if (pos + 2 > size) return;
+                sizes[i] = (static_cast<size_t>(frame[pos]) << 8) | frame[pos + 1];
+                sets[i] = frame + pos + 2;
+                pos += 2 + sizes[i];
+                if (pos > size) return;
+            }
+
+            // A new format only when the parameter sets change
+            if (!format || parameterSets.size() != pos ||
+                std::memcmp(parameterSets.data(), frame, pos) != 0) {
+                CMVideoFormatDescriptionRef next = nullptr;
+                const OSStatus status = hevc
+                    ? CMVideoFormatDescriptionCreateFromHEVCParameterSets(kCFAllocatorDefault, count, sets, sizes,
+                                                                          nalLength, nullptr, &next)
+                    : CMVideoFormatDescriptionCreateFromH264ParameterSets(kCFAllocatorDefault, count, sets, sizes,
+                                                                          nalLength, &next);
+                if (status != noErr || !createSession(next)) {
+                    if (next) CFRelease(next);
+                    return;
+                }
+                if (format) CFRelease(format);
+                format = next;
+                parameterSets.assign(frame, frame + pos);
+            }
+        }
+        if (!session || pos >= size) return;
+
+        // The decoder reads the data later: copy it into a block it owns
+        const size_t length = size - pos;
+        CMBlockBufferRef block = nullptr;
+        if (CMBlockBufferCreateWithMemoryBlock(kCFAllocatorDefault, nullptr, length, kCFAllocatorDefault, nullptr,
+                                               0, length, kCMBlockBufferAssureMemoryNowFlag,
+                                               &block) != kCMBlockBufferNoErr) {
+            return;
+        }
+        CMBlockBufferReplaceDataBytes(frame + pos, block, 0, length);
+
+        CMSampleBufferRef sample = nullptr;
+        const size_t sampleSize = length;
+        if (CMSampleBufferCreateReady(kCFAllocatorDefault, block, format, 1, 0, nullptr, 1, &sampleSize,
+                                      &sample) == noErr) {
+            VTDecodeInfoFlags infoFlags = 0;
+            const OSStatus status = VTDecompressionSessionDecodeFrame(
+                session, sample,
+                kVTDecodeFrame_EnableAsynchronousDecompression | kVTDecodeFrame_1xRealTimePlayback,
+                nullptr, &infoFlags);
+            if (status != noErr) {
+                decodeFailed = true;
+            }
+            CFRelease(sample);
+        }
+        CFRelease(block);
+    }
+
+    void requestKeyFrame() {
+        const uint16_t port = assembler.getFeedbackPort();
+        const double now = CACurrentMediaTime();
+        if (!port || senderIP.empty() || now - lastKeyFrameRequest < kKeyFrameRequestInterval) {
+            return;
+        }
+        lastKeyFrameRequest = now;
+
+        ofxVideoStreamPacketHeader header;
+        header.type = ofxVideoStreamPacketHeader::KeyFrameRequest;
+        uint8_t packet[ofxVideoStreamPacketHeader::kSize];
+        header.write(packet);
+        udp.sendTo(senderIP, port, reinterpret_cast<const char*>(packet), static_cast<int>(sizeof(packet)));
+    }
+
+    void update() {
+        frameNew = false;
+
+        // Decode every frame completed since the last update
+        ofxUdpDatagram datagrams[256];
+        int count = 0;
+        while ((count = udp.receiveBatch(datagrams, 256)) > 0) {
+            for (int i = 0; i < count; i++) {
+                if (!assembler.add(reinterpret_cast<const uint8_t*>(datagrams[i].data),
+                                   static_cast<size_t>(datagrams[i].length))) {
+                    continue;
+                }
+                if (senderIP != datagrams[i].senderIP) {
+                    senderIP = datagrams[i].senderIP;
+                }
+                decode(assembler.getFrame(), assembler.getFrameSize());
+            }
+        }
+
+        if (decodeFailed.exchange(false)) {
+            assembler.reset();
+        }
+        if (assembler.needsKeyFrame()) {
+            requestKeyFrame();
+        }
+
+        // Show the newest decoded frame; older undrawn ones are skipped
+        CVPixelBufferRef buffer = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(latestMutex);
+            buffer = latest;
+            latest = nullptr;
+        }
+        if (buffer) {
+            frames.setFrame(buffer, texture);
+            width = static_cast<int>(CVPixelBufferGetWidth(buffer));
+            height = static_cast<int>(CVPixelBufferGetHeight(buffer));
+            CVPixelBufferRelease(buffer);
+            frameNew = true;
+            receiving = true;
+        }
+    }
+};
+
+// ============================================================================
+// ofxVideoStreamReceiver Implementation
+// ============================================================================
+
+ofxVideoStreamReceiver::ofxVideoStreamReceiver()
+    : pImpl(std::make_unique<Impl>()) {
+}
+
+ofxVideoStreamReceiver::~ofxVideoStreamReceiver() {
+}
+
+bool ofxVideoStreamReceiver::setup(uint16_t port) {
+    @autoreleasepool {
+        close();
+        pImpl->udp.setReceiveQueueSize(kQueueSlots, kSlotSize);
+        if (!pImpl->udp.bind(port)) {
+            pImpl->errorMessage = pImpl->udp.getError();
+            NSLog(@"ofxVideoStreamReceiver: Failed to bind port %u", port);
+            return false;
+        }
+        pImpl->udp.setReceiveBufferSize(kSocketBufferSize);
+        pImpl->errorMessage.clear();
+        return true;
+    }
+}
+
+void ofxVideoStreamReceiver::close() {
+    pImpl->close();
+}
+
+void ofxVideoStreamReceiver::update() {
+    @autoreleasepool {
+        pImpl->update();
+    }
+}
+
+bool ofxVideoStreamReceiver::isFrameNew() const {
+    return pImpl->frameNew;
+}
+
+bool ofxVideoStreamReceiver::isReceiving() const {
+    return pImpl->receiving;
+}
+
+void ofxVideoStreamReceiver::draw(float x, float y) const {
+    if (!pImpl->receiving) return;
+    pImpl->texture.draw(x, y);
+}
+
+void ofxVideoStreamReceiver::draw(float x, float y, float w, float h) const {
+    if (!pImpl->receiving) return;
+    pImpl->texture.draw(x, y, w, h);
+}
+
+oflike::ofTexture& ofxVideoStreamReceiver::getTexture() {
+    return pImpl->texture;
+}
+
+const oflike::ofTexture& ofxVideoStreamReceiver::getTexture() const {
+    return pImpl->texture;
+}
+
+float ofxVideoStreamReceiver::getWidth() const {
+    return static_cast<float>(pImpl->width);
+}
+
+float ofxVideoStreamReceiver::getHeight() const {
+    return static_cast<float>(pImpl->height);
+}
+
+uint64_t ofxVideoStreamReceiver::getFramesDecoded() const {
+    return pImpl->decoded;
+}
+
+uint64_t ofxVideoStreamReceiver::getFramesLost() const {
+    return pImpl->assembler.getFramesLost();
+}
+
+uint64_t ofxVideoStreamReceiver::getPacketsRecovered() const {
+    return pImpl->assembler.getPacketsRecovered();
+}
+
+std::string ofxVideoStreamReceiver::getError() const {
+    return pImpl->errorMessage;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../../../oflike/graphics/ofFbo.h"
+#include "../../../oflike/image/ofTexture.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/// \brief Codec of an ofxVideoStreamSender stream
+enum class ofxVideoStreamCodec {
+    H264,
+    HEVC
+};
+
+/// \brief Stream settings
+struct ofxVideoStreamSettings {
+    int width = 0;                  ///< Stream width; 0 uses the viewport at setup()
+    int height = 0;                 ///< Stream height; 0 uses the viewport at setup()
+    float frameRate = 60.0f;        ///< Expected frame rate, for rate control
+    ofxVideoStreamCodec codec = ofxVideoStreamCodec::HEVC;
+    float bitrateMbps = 0.0f;       ///< 0 picks one from size and frame rate
+    int keyFrameInterval = 120;     ///< Frames between keyframes
+    int maxPacketSize = 1400;       ///< Datagram size including headers; keep under the path MTU
+    int fecGroupSize = 8;           ///< Data packets per parity packet (repairs one loss each); 0 = no FEC
+    bool keyFrameRequests = true;   ///< Receivers may ask for a keyframe on port + 1 after a loss
+};
+
+/// \brief Streams FBOs or textures to an ofxVideoStreamReceiver over UDP
+///
+/// Each addFrame() copies the source on the GPU into a pixel buffer from the
+/// encoder's own IOSurface pool, and the hardware encoder takes that buffer
+/// as soon as the copy completes: frames never pass through the CPU. The
+/// encoder runs in low-latency mode without frame reordering, and each frame
+/// is sent the moment it is encoded, split into datagrams with XOR parity
+/// packets (see ofxVideoStreamPacket.h).
+///
+/// A receiver that loses a frame the parity can't repair asks for a keyframe
+/// instead of waiting for the next scheduled one. When the encoder falls
+/// behind, frames are dropped rather than queued, so latency stays bounded.
+///
+/// Example usage:
+/// \code
+/// ofxVideoStreamSender sender;
+/// ofxVideoStreamSettings settings;
+/// settings.width = 1920;
+/// settings.height = 1080;
+/// sender.setup("192.168.1.20", 9000, settings);
+///
+/// // In draw(), after drawing into fbo
+/// sender.addFrame(fbo);
+/// \endcode
+class ofxVideoStreamSender {
+public:
+    ofxVideoStreamSender();
+    ~ofxVideoStreamSender();
+
+    // Non-copyable
+    ofxVideoStreamSender(const ofxVideoStreamSender&) = delete;
+    ofxVideoStreamSender& operator=(const ofxVideoStreamSender&) = delete;
+
+    // Setup
+    /// \brief Start streaming to a receiver
+    /// \param host Receiver's hostname or IP address
+    /// \param port Receiver's port
+    /// \param settings Stream settings
+    /// \return true if the encoder and connection were set up
+    bool setup(const std::string& host, uint16_t port,
+               const ofxVideoStreamSettings& settings = ofxVideoStreamSettings());
+
+    /// \brief Stop streaming
+    void close();
+
+    /// \brief Check if set up
+    bool isSetup() const;
+
+    /// \brief Get the stream settings (with the size in use)
+    const ofxVideoStreamSettings& getSettings() const;
+
+    // Frames
+    /// \brief Stream an FBO's color texture as it looks after this frame's
+    /// drawing so far, scaled to the stream size
+    /// \return false if the frame was dropped
+    bool addFrame(const oflike::ofFbo& fbo);
+
+    /// \brief Stream a texture as it looks after this frame's drawing so far
+    /// \return false if the frame was dropped
+    bool addFrame(const oflike::ofTexture& texture);
+
+    /// \brief Make the next frame a keyframe
+    void requestKeyFrame();
+
+    // Statistics
+    /// \brief Frames encoded and sent since setup()
+    uint64_t getFramesSent() const;
+
+    /// \brief Frames dropped since setup() (encoder behind or GPU copy failed)
+    uint64_t getFramesDropped() const;
+
+    /// \brief Encoded bytes sent since setup(), without headers or parity
+    uint64_t getBytesSent() const;
+
+    /// \brief Get last error message
+    std::string getError() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+
+    bool addFrame(void* source);
+};
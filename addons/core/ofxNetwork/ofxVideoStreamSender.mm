@@ -0,0 +1,451 @@
+#include "ofxVideoStreamSender.h"
+#include "ofxVideoStreamPacket.h"
+#include "ofxUdpManager.h"
+#import <Foundation/Foundation.h>
+#import <CoreVideo/CoreVideo.h>
+#import <Metal/Metal.h>
+#import <QuartzCore/QuartzCore.h>
+#import <VideoToolbox/VideoToolbox.h>
+#include "../../../core/Context.h"
+#include "../../../render/DrawList.h"
+#include "../../../render/DrawCommand.h"
+#include "../../../render/IRenderer.h"
+#include "../../../render/CopyTextureRegistry.h"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+// Frames being copied or encoded at once. Beyond this the encoder is behind
+// and frames drop, which keeps queueing from adding latency.
+static constexpr int kMaxFramesInFlight = 3;
+
+// ============================================================================
+// Stream
+// ============================================================================
+
+namespace {
+
+// One encoder and connection, shared with the frames in flight so close()
+// can return while they finish
+struct Stream {
+    VTCompressionSessionRef session = nullptr;
+    CVMetalTextureCacheRef textureCache = nullptr;
+    dispatch_queue_t queue = nullptr;      // Hands copied frames to the encoder
+    ofxVideoStreamCodec codec = ofxVideoStreamCodec::HEVC;
+
+    ofxUdpManager udp;
+    ofxUdpManager feedback;                // Keyframe requests (main thread)
+    uint16_t feedbackPort = 0;
+
+    // Encoder output only
+    ofxVideoStreamPacketizer packetizer;
+    std::vector<uint8_t> frame;
+    uint32_t nextFrameId = 0;
+
+    std::atomic<int> inFlight{0};
+    std::atomic<bool> forceKeyFrame{true};
+    std::atomic<uint64_t> sent{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> bytes{0};
+
+    ~Stream() {
+        if (session) {
+            // Let frames still in the encoder call back before it goes away
+            VTCompressionSessionCompleteFrames(session, kCMTimeInvalid);
+            VTCompressionSessionInvalidate(session);
+            CFRelease(session);
+        }
+        if (textureCache) {
+            CFRelease(textureCache);
+        }
+    }
+
+    bool parameterSet(CMFormatDescriptionRef format, size_t index, const uint8_t** data, size_t* size,
+                      size_t* count, int* nalLength) const {
+        const OSStatus status = codec == ofxVideoStreamCodec::H264
+            ? CMVideoFormatDescriptionGetH264ParameterSetAtIndex(format, index, data, size, count, nalLength)
+            : CMVideoFormatDescriptionGetHEVCParameterSetAtIndex(format, index, data, size, count, nalLength);
+        return status == noErr;
+    }
+
+    // Frame layout in ofxVideoStreamPacket.h
+    void send(CMSampleBufferRef sample) {
+        bool keyFrame = true;
+        CFArrayRef attachments = CMSampleBufferGetSampleAttachmentsArray(sample, false);
+        if (attachments && CFArrayGetCount(attachments) > 0) {
+            CFDictionaryRef attachment = static_cast<CFDictionaryRef>(CFArrayGetValueAtIndex(attachments, 0));
+            keyFrame = CFDictionaryGetValue(attachment, kCMSampleAttachmentKey_NotSync) != kCFBooleanTrue;
+        }
+
+        CMFormatDescriptionRef format = CMSampleBufferGetFormatDescription(sample);
+        size_t count = 0;
+        int nalLength = 4;
+        if (!format || !parameterSet(format, 0, nullptr, nullptr, &count, &nalLength)) {
+            dropped++;
+            return;
+        }
+
+        frame.clear();
+        frame.push_back(static_cast<uint8_t>(codec));
+        frame.push_back(static_cast<uint8_t>(nalLength));
+        frame.push_back(keyFrame ? static_cast<uint8_t>(count) : 0);
+        for (size_t i = 0; keyFrame && i < count; i++) {
+            const uint8_t* data = nullptr;
+            size_t size = 0;
+            if (!parameterSet(format, i, &data, &size, nullptr, nullptr) || size > 0xFFFF) {
+                dropped++;
+                return;
+            }
+            frame.push_back(static_cast<uint8_t>(size >> 8));
+            frame.push_back(static_cast<uint8_t>(size));
+            frame.insert(frame.end(), data, data + size);
+        }
+
+        CMBlockBufferRef block = CMSampleBufferGetDataBuffer(sample);
+        const size_t length = block ? CMBlockBufferGetDataLength(block) : 0;
+        const size_t offset = frame.size();
+        frame.resize(offset + length);
+        if (length == 0 || CMBlockBufferCopyDataBytes(block, 0, length, frame.data() + offset) != kCMBlockBufferNoErr) {
+            dropped++;
+            return;
+        }
+
+        const size_t packets = packetizer.packetize(nextFrameId, keyFrame, frame.data(), frame.size(), feedbackPort);
+        if (packets == 0) {
+            dropped++;
+            forceKeyFrame = true;  // Later frames would refer to this one
+            return;
+        }
+        nextFrameId++;
+        for (size_t i = 0; i < packets; i++) {
+            udp.send(reinterpret_cast<const char*>(packetizer.getPacket(i)),
+                     static_cast<int>(packetizer.getPacketSize(i)));
+        }
+        sent++;
+        bytes += length;
+    }
+};
+
+void didEncode(void* refcon, void*, OSStatus status, VTEncodeInfoFlags flags, CMSampleBufferRef sample) {
+    Stream& stream = *static_cast<Stream*>(refcon);
+    stream.inFlight--;
+    if (status != noErr || !sample || (flags & kVTEncodeInfo_FrameDropped) || !CMSampleBufferDataIsReady(sample)) {
+        stream.dropped++;
+        return;
+    }
+    stream.send(sample);
+}
+
+struct Capture {
+    std::shared_ptr<Stream> stream;
+    CVPixelBufferRef buffer = nullptr;
+    CVMetalTextureRef texture = nullptr;   // Keeps the GPU's view of buffer alive
+    CMTime time = kCMTimeInvalid;
+};
+
+// Hand a copied frame to the encoder (stream queue)
+void encodeCapture(const Capture& capture, bool succeeded) {
+    Stream& stream = *capture.stream;
+
+    bool encoding = false;
+    if (succeeded) {
+        const bool keyFrame = stream.forceKeyFrame.exchange(false);
+        NSDictionary* options = keyFrame
+            ? @{(__bridge NSString*)kVTEncodeFrameOptionKey_ForceKeyFrame: @YES}
+            : nil;
+        encoding = VTCompressionSessionEncodeFrame(stream.session, capture.buffer, capture.time, kCMTimeInvalid,
+                                                   (__bridge CFDictionaryRef)options, nullptr, nullptr) == noErr;
+        if (!encoding && keyFrame) {
+            stream.forceKeyFrame = true;
+        }
+    }
+    if (!encoding) {
+        stream.inFlight--;
+        stream.dropped++;
+    }
+
+    if (capture.texture) CFRelease(capture.texture);
+    CVPixelBufferRelease(capture.buffer);
+}
+
+using CaptureRegistry = render::CopyTextureRegistry<Capture, &encodeCapture>;
+
+} // namespace
+
+// ============================================================================
+// ofxVideoStreamSender::Impl
+// ============================================================================
+
+struct ofxVideoStreamSender::Impl {
+    ofxVideoStreamSettings settings;
+    std::shared_ptr<Stream> stream;
+    std::string errorMessage;
+    NSDictionary* auxAttributes = nil;
+
+    bool createSession(Stream& next, int width, int height) {
+        const CMVideoCodecType codecType = settings.codec == ofxVideoStreamCodec::H264
+            ? kCMVideoCodecType_H264 : kCMVideoCodecType_HEVC;
+
+        // Metal-compatible IOSurface buffers, so the GPU copies straight into
+        // what the encoder reads
+        NSDictionary* sourceAttributes = @{
+            (NSString*)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
+            (NSString*)kCVPixelBufferWidthKey: @(width),
+            (NSString*)kCVPixelBufferHeightKey: @(height),
+            (NSString*)kCVPixelBufferMetalCompatibilityKey: @YES,
+            (NSString*)kCVPixelBufferIOSurfacePropertiesKey: @{},
+        };
+
+        // Low-latency rate control isn't offered for every codec; fall back
+        // to the plain hardware encoder without it
+        NSDictionary* lowLatency = @{
+            (__bridge NSString*)kVTVideoEncoderSpecification_RequireHardwareAcceleratedVideoEncoder: @YES,
+            (__bridge NSString*)kVTVideoEncoderSpecification_EnableLowLatencyRateControl: @YES,
+        };
+        NSDictionary* hardware = @{
+            (__bridge NSString*)kVTVideoEncoderSpecification_RequireHardwareAcceleratedVideoEncoder: @YES,
+        };
+        OSStatus status = VTCompressionSessionCreate(kCFAllocatorDefault, width, height, codecType,
+                                                     (__bridge CFDictionaryRef)lowLatency,
+                                                     (__bridge CFDictionaryRef)sourceAttributes,
+                                                     nullptr, &didEncode, &next, &next.session);
+        if (status != noErr) {
+            status = VTCompressionSessionCreate(kCFAllocatorDefault, width, height, codecType,
+                                                (__bridge CFDictionaryRef)hardware,
+                                                (__bridge CFDictionaryRef)sourceAttributes,
+                                                nullptr, &didEncode, &next, &next.session);
+        }
+        if (status != noErr) {
+            errorMessage = "Failed to create hardware encoder";
+            NSLog(@"ofxVideoStreamSender: Failed to create hardware encoder (%d)", static_cast<int>(status));
+            return false;
+        }
+
+        // 0.1 bits per pixel unless asked for: twice the compression of a
+        // recording, as a LAN stream trades quality for latency
+        const double mbps = settings.bitrateMbps > 0.0f
+            ? settings.bitrateMbps
+            : static_cast<double>(width) * height * 0.1 * settings.frameRate / 1000000.0;
+
+        VTSessionRef session = next.session;
+        VTSessionSetProperty(session, kVTCompressionPropertyKey_RealTime, kCFBooleanTrue);
+        VTSessionSetProperty(session, kVTCompressionPropertyKey_AllowFrameReordering, kCFBooleanFalse);
+        VTSessionSetProperty(session, kVTCompressionPropertyKey_MaxFrameDelayCount, (__bridge CFNumberRef)@0);
+        VTSessionSetProperty(session, kVTCompressionPropertyKey_MaxKeyFrameInterval,
+                             (__bridge CFNumberRef)@(std::max(settings.keyFrameInterval, 1)));
+        VTSessionSetProperty(session, kVTCompressionPropertyKey_ExpectedFrameRate,
+                             (__bridge CFNumberRef)@(settings.frameRate));
+        VTSessionSetProperty(session, kVTCompressionPropertyKey_AverageBitRate,
+                             (__bridge CFNumberRef)@(mbps * 1000000.0));
+        VTSessionSetProperty(session, kVTCompressionPropertyKey_ProfileLevel,
+                             settings.codec == ofxVideoStreamCodec::H264
+                                 ? kVTProfileLevel_H264_High_AutoLevel
+                                 : kVTProfileLevel_HEVC_Main_AutoLevel);
+        VTCompressionSessionPrepareToEncodeFrames(next.session);
+        return true;
+    }
+
+    bool setup(const std::string& host, uint16_t port, const ofxVideoStreamSettings& requested) {
+        auto& ctx = Context::instance();
+        if (!ctx.isInitialized()) {
+            errorMessage = "Context not initialized";
+            NSLog(@"ofxVideoStreamSender: Context not initialized");
+            return false;
+        }
+
+        settings = requested;
+        if (settings.width <= 0 || settings.height <= 0) {
+            settings.width = static_cast<int>(ctx.renderer()->getViewportWidth());
+            settings.height = static_cast<int>(ctx.renderer()->getViewportHeight());
+        }
+        // 4:2:0 needs even dimensions
+        settings.width &= ~1;
+        settings.height &= ~1;
+        if (settings.width <= 0 || settings.height <= 0) {
+            errorMessage = "Invalid size";
+            NSLog(@"ofxVideoStreamSender: Invalid size %dx%d", settings.width, settings.height);
+            return false;
+        }
+
+        auto next = std::make_shared<Stream>();
+        next->codec = settings.codec;
+        next->packetizer.setup(static_cast<size_t>(std::max(settings.maxPacketSize, 0)), settings.fecGroupSize);
+
+        if (!next->udp.connect(host, port)) {
+            errorMessage = next->udp.getError();
+            return false;
+        }
+        if (settings.keyFrameRequests && port < 0xFFFF) {
+            if (next->feedback.bind(static_cast<uint16_t>(port + 1))) {
+                next->feedbackPort = static_cast<uint16_t>(port + 1);
+            } else {
+                NSLog(@"ofxVideoStreamSender: Can't take keyframe requests on port %u", port + 1);
+            }
+        }
+
+        if (!createSession(*next, settings.width, settings.height)) {
+            return false;
+        }
+
+        id<MTLDevice> device = (__bridge id<MTLDevice>)ctx.getMetalDevice();
+        NSDictionary* textureAttributes = @{
+            (NSString*)kCVMetalTextureUsage: @(MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite),
+        };
+        if (CVMetalTextureCacheCreate(kCFAllocatorDefault, nil, device,
+                                      (__bridge CFDictionaryRef)textureAttributes,
+                                      &next->textureCache) != kCVReturnSuccess) {
+            errorMessage = "Failed to create texture cache";
+            NSLog(@"ofxVideoStreamSender: Failed to create texture cache");
+            return false;
+        }
+
+        next->queue = dispatch_queue_create("com.oflike.videoStream.sender", DISPATCH_QUEUE_SERIAL);
+        auxAttributes = @{
+            (NSString*)kCVPixelBufferPoolAllocationThresholdKey: @(kMaxFramesInFlight + 1),
+        };
+
+        stream = std::move(next);
+        errorMessage.clear();
+        NSLog(@"ofxVideoStreamSender: Streaming %dx%d to %s:%u", settings.width, settings.height,
+              host.c_str(), port);
+        return true;
+    }
+
+    // Keyframe requests from receivers that lost a frame
+    void pollFeedback() {
+        if (!stream->feedbackPort) return;
+
+        ofxUdpDatagram datagrams[16];
+        int count = 0;
+        while ((count = stream->feedback.receiveBatch(datagrams, 16)) > 0) {
+            for (int i = 0; i < count; i++) {
+                ofxVideoStreamPacketHeader header;
+                if (header.read(reinterpret_cast<const uint8_t*>(datagrams[i].data),
+                                static_cast<size_t>(datagrams[i].length)) &&
+                    header.type == ofxVideoStreamPacketHeader::KeyFrameRequest) {
+                    stream->forceKeyFrame = true;
+                }
+            }
+        }
+    }
+
+    bool addFrame(void* source) {
+        if (!stream) return false;
+        pollFeedback();
+
+        if (stream->inFlight >= kMaxFramesInFlight) {
+            stream->dropped++;
+            return false;
+        }
+
+        CVPixelBufferPoolRef pool = VTCompressionSessionGetPixelBufferPool(stream->session);
+        CVPixelBufferRef buffer = nullptr;
+        if (!pool || CVPixelBufferPoolCreatePixelBufferWithAuxAttributes(
+                kCFAllocatorDefault, pool, (__bridge CFDictionaryRef)auxAttributes, &buffer) != kCVReturnSuccess) {
+            stream->dropped++;
+            return false;
+        }
+
+        CVMetalTextureRef texture = nullptr;
+        if (CVMetalTextureCacheCreateTextureFromImage(kCFAllocatorDefault, stream->textureCache, buffer, nil,
+                                                      MTLPixelFormatBGRA8Unorm, settings.width, settings.height,
+                                                      0, &texture) != kCVReturnSuccess) {
+            CVPixelBufferRelease(buffer);
+            stream->dropped++;
+            return false;
+        }
+
+        auto& ctx = Context::instance();
+        Capture capture;
+        capture.stream = stream;
+        capture.buffer = buffer;
+        capture.texture = texture;
+        capture.time = CMTimeMakeWithSeconds(CACurrentMediaTime(), 1000000);
+
+        render::CopyTextureCommand cmd;
+        cmd.source = source;
+        cmd.destination = (__bridge void*)CVMetalTextureGetTexture(texture);
+        cmd.opaque = true;
+        CaptureRegistry::add(cmd, std::move(capture), stream->queue, ctx.getFrameNum());
+
+        stream->inFlight++;
+        ctx.getDrawList().addCommand(cmd);
+        CVMetalTextureCacheFlush(stream->textureCache, 0);
+        return true;
+    }
+};
+
+// ============================================================================
+// ofxVideoStreamSender Implementation
+// ============================================================================
+
+ofxVideoStreamSender::ofxVideoStreamSender()
+    : pImpl(std::make_unique<Impl>()) {
+}
+
+ofxVideoStreamSender::~ofxVideoStreamSender() {
+    close();
+}
+
+bool ofxVideoStreamSender::setup(const std::string& host, uint16_t port, const ofxVideoStreamSettings& settings) {
+    @autoreleasepool {
+        close();
+        return pImpl->setup(host, port, settings);
+    }
+}
+
+void ofxVideoStreamSender::close() {
+    // Frames in flight keep the stream alive until they finish
+    pImpl->stream.reset();
+}
+
+bool ofxVideoStreamSender::isSetup() const {
+    return pImpl->stream != nullptr;
+}
+
+const ofxVideoStreamSettings& ofxVideoStreamSender::getSettings() const {
+    return pImpl->settings;
+}
+
+bool ofxVideoStreamSender::addFrame(const oflike::ofFbo& fbo) {
+    // The FBO's ofTexture wrappers carry no Metal texture; use its attachment
+    void* handle = fbo.getNativeTextureHandle(0);
+    return handle ? addFrame(handle) : false;
+}
+
+bool ofxVideoStreamSender::addFrame(const oflike::ofTexture& texture) {
+    void* handle = texture.getNativeHandle();
+    return handle ? addFrame(handle) : false;
+}
+
+bool ofxVideoStreamSender::addFrame(void* source) {
+    @autoreleasepool {
+        return pImpl->addFrame(source);
+    }
+}
+
+void ofxVideoStreamSender::requestKeyFrame() {
+    if (pImpl->stream) {
+        pImpl->stream->forceKeyFrame = true;
+    }
+}
+
+uint64_t ofxVideoStreamSender::getFramesSent() const {
+    return pImpl->stream ? pImpl->stream->sent.load() : 0;
+}
+
+uint64_t ofxVideoStreamSender::getFramesDropped() const {
+    return pImpl->stream ? pImpl->stream->dropped.load() : 0;
+}
+
+uint64_t ofxVideoStreamSender::getBytesSent() const {
+    return pImpl->stream ? pImpl->stream->bytes.load() : 0;
+}
+
+std::string ofxVideoStreamSender::getError() const {
+    return pImpl->errorMessage;
+}
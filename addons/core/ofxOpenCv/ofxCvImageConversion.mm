@@ -1,4 +1,5 @@
 #import "ofxCvImageConversion.h"
+#import "../../oflike/image/ofPixelConvert.h"
 #import <CoreVideo/CoreVideo.h>
 #import <Foundation/Foundation.h>
 #import <string>
@@ -73,13 +74,8 @@ public:
             size_t bytesPerRow = CVPixelBufferGetBytesPerRow(pixelBuffer);
 
             // Copy pixel data row by row
-            const unsigned char* src = pixels.getData();
-            unsigned char* dst = static_cast<unsigned char*>(baseAddress);
-
-            for (size_t y = 0; y < pixels.getHeight(); ++y) {
-                memcpy(dst + y * bytesPerRow, src + y * pixels.getWidth() * bytesPerPixel,
-                       pixels.getWidth() * bytesPerPixel);
-            }
+            ofPixelConvert::copyRows(pixels.getData(), pixels.getBytesStride(), baseAddress, bytesPerRow,
+                                     pixels.getWidth() * bytesPerPixel, pixels.getHeight());
 
             CVPixelBufferUnlockBaseAddress(pixelBuffer, 0);
 
@@ -125,28 +121,15 @@ public:
             void* baseAddress = CVPixelBufferGetBaseAddress(pixelBuffer);
             size_t bytesPerRow = CVPixelBufferGetBytesPerRow(pixelBuffer);
 
-            unsigned char* src = static_cast<unsigned char*>(baseAddress);
-            unsigned char* dst = pixels.getData();
+            const uint8_t* src = static_cast<const uint8_t*>(baseAddress);
 
             // Handle BGRA → RGBA conversion if needed
-            bool needsSwizzle = (pixelFormat == kCVPixelFormatType_32BGRA);
-
-            // Copy pixel data row by row
-            for (size_t y = 0; y < height; ++y) {
-                if (needsSwizzle) {
-                    // Convert BGRA to RGBA
-                    for (size_t x = 0; x < width; ++x) {
-                        size_t srcIdx = y * bytesPerRow + x * 4;
-                        size_t dstIdx = y * width * 4 + x * 4;
-                        dst[dstIdx + 0] = src[srcIdx + 2]; // R ← B
-                        dst[dstIdx + 1] = src[srcIdx + 1]; // G ← G
-                        dst[dstIdx + 2] = src[srcIdx + 0]; // B ← R
-                        dst[dstIdx + 3] = src[srcIdx + 3]; // A ← A
-                    }
-                } else {
-                    memcpy(dst + y * width * numChannels, src + y * bytesPerRow,
-                           width * numChannels);
-                }
+            if (pixelFormat == kCVPixelFormatType_32BGRA) {
+                ofPixelConvert::bgraToRGBA(src, bytesPerRow, pixels.getData(), pixels.getBytesStride(),
+                                           width, height);
+            } else {
+                ofPixelConvert::copyRows(src, bytesPerRow, pixels.getData(), pixels.getBytesStride(),
+                                         width * numChannels, height);
             }
 
             CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
@@ -182,7 +165,7 @@ public:
         // Create Mat that wraps ofPixels data (no copy)
         mat = cv::Mat(pixels.getHeight(), pixels.getWidth(), cvType,
                       const_cast<unsigned char*>(pixels.getData()),
-                      pixels.getWidth() * pixels.getNumChannels());
+                      pixels.getBytesStride());
 
         // Note: RGB → BGR conversion if needed
         if (pixels.getNumChannels() == 3) {
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../../oflike/image/ofTexture.h"
+#include "../../oflike/math/ofVec2f.h"
+
+namespace ofxCv {
+
+/// Accuracy of VNGenerateOpticalFlowRequest (higher is slower)
+enum class OpticalFlowAccuracy {
+    Low,
+    Medium,
+    High,
+    VeryHigh
+};
+
+/// Mean optical flow over one cell of a grid laid over the image
+struct MotionVector {
+    oflike::ofVec2f position;   // Cell center, normalized [0,1], origin top-left
+    oflike::ofVec2f velocity;   // Displacement between the analyzed frames, in image sizes
+    float magnitude;            // Length of velocity
+};
+
+/// Dense optical flow between video frames with VNGenerateOpticalFlowRequest
+/// update() records a GPU copy of the frame, scaled to the analysis size,
+/// into a Metal-compatible pixel buffer; once the GPU has written it, Vision
+/// computes the flow from the previously analyzed frame on a background
+/// queue. The frame is never copied on the CPU and the render thread never
+/// waits: while an analysis is running, frames are skipped. Results arrive
+/// a few frames later, as a flow texture and a grid of mean vectors.
+class OpticalFlow {
+public:
+    OpticalFlow();
+    ~OpticalFlow();
+
+    /// Analysis size: frames are scaled to this width, keeping their aspect
+    void setup(int analysisWidth = 320, OpticalFlowAccuracy accuracy = OpticalFlowAccuracy::Medium);
+
+    /// Queue a frame for analysis; call once per frame (main thread)
+    /// The texture must hold its content when the frame renders, as camera
+    /// and video textures do
+    /// @return false if the frame was skipped (previous analysis still running)
+    bool update(const oflike::ofTexture& frame);
+
+    /// True once after each new result (main thread)
+    bool isFrameNew();
+
+    /// Flow of the latest result: RG16Float at the analysis size, pixels
+    /// of displacement per texel (x right, y down); unallocated if Vision's
+    /// buffer can't be shared with Metal
+    const oflike::ofTexture& getFlowTexture() const;
+
+    /// Grid the motion vectors average over (default 16 x 9)
+    void setGridSize(int columns, int rows);
+
+    /// Mean flow per grid cell of the latest result, rows top to bottom
+    std::vector<MotionVector> getMotionVectors() const;
+
+    /// Mean flow of the whole image of the latest result, in image sizes
+    oflike::ofVec2f getAverageMotion() const;
+
+    /// Drop the previous frame; the next two analyzed frames start over
+    void reset();
+
+    // Error handling
+    bool hasError() const;
+    std::string getLastError() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+/// Foreground mask against a learned background, computed on the GPU
+/// Each pixel keeps a running mean and variance of its color (half float,
+/// in a texture of its own); pixels further than threshold standard
+/// deviations from the mean are foreground. Background pixels learn at the
+/// learning rate, foreground ones at a tenth of it, so objects that stop
+/// moving fade into the background. The kernel is recorded into the frame
+/// like ofImageFilter's texture filters: no CPU copies, and drawing the mask
+/// afterwards shows this frame's result.
+class BackgroundSubtractor {
+public:
+    BackgroundSubtractor();
+    ~BackgroundSubtractor();
+
+    /// Size of the model and the mask (0 = the first frame's size)
+    void setup(int width = 0, int height = 0);
+
+    /// Fraction of each frame blended into the background (default 0.01)
+    void setLearningRate(float rate);
+    float getLearningRate() const;
+
+    /// Standard deviations from the background that count as foreground (default 2.5)
+    void setThreshold(float deviations);
+    float getThreshold() const;
+
+    /// Update the model with a frame and write the mask (white = foreground,
+    /// allocated writable at the model size); the first frame after setup()
+    /// or reset() becomes the background
+    bool update(const oflike::ofTexture& frame, oflike::ofTexture& mask);
+
+    /// Learn the background again from the next frame
+    void reset();
+
+    // Error handling
+    bool hasError() const;
+    std::string getLastError() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+/// Difference of consecutive frames, computed on the GPU
+/// The luminance of each frame is kept for the next one in a texture of
+/// its own; recorded into the frame like BackgroundSubtractor.
+class FrameDifference {
+public:
+    FrameDifference();
+    ~FrameDifference();
+
+    /// Size of the difference (0 = the first frame's size)
+    void setup(int width = 0, int height = 0);
+
+    /// Luminance change (0-1) that counts as motion; 0 writes the change
+    /// itself instead of a mask (default 0.1)
+    void setThreshold(float threshold);
+    float getThreshold() const;
+
+    /// Write the difference to the previous frame (allocated writable at
+    /// the difference size); black for the first frame
+    bool update(const oflike::ofTexture& frame, oflike::ofTexture& difference);
+
+    /// Forget the previous frame
+    void reset();
+
+    // Error handling
+    bool hasError() const;
+    std::string getLastError() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace ofxCv
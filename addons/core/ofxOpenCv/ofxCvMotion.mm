@@ -0,0 +1,770 @@
+#import "ofxCvMotion.h"
+#import <Vision/Vision.h>
+#import <CoreVideo/CoreVideo.h>
+#import <Metal/Metal.h>
+#import "../../oflike/graphics/ofComputeShader.h"
+#import "../../core/Context.h"
+#import "../../render/DrawList.h"
+#import "../../render/DrawCommand.h"
+#import "../../render/CopyTextureRegistry.h"
+#import "../../render/IRenderer.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+
+namespace ofxCv {
+
+// Frames a replaced flow texture is kept for the GPU frames that drew it.
+// update() adopts results before the renderer waits for a frame slot, so
+// one more than the renderer's.
+static constexpr unsigned long long kRetireFrames = render::kRetireFrames + 1;
+
+// Helper: Analysis size of a frame scaled to width, even for the copy kernel
+static void scaledSize(const oflike::ofTexture& frame, int width, int& scaledWidth, int& scaledHeight) {
+    scaledWidth = std::max(width, 2) & ~1;
+    scaledHeight = std::max(static_cast<int>(std::lround(
+        static_cast<double>(scaledWidth) * frame.getHeight() / std::max(frame.getWidth(), 1))), 2) & ~1;
+}
+
+// ============================================================================
+// Optical Flow
+// ============================================================================
+
+namespace {
+
+// A flow field and its summary, kept alive while its texture may be drawn
+struct FlowResult {
+    CVPixelBufferRef buffer = nullptr;
+    CVMetalTextureRef texture = nullptr;
+    std::vector<MotionVector> vectors;
+    oflike::ofVec2f average;
+
+    void release() {
+        if (texture) CFRelease(texture);
+        if (buffer) CVPixelBufferRelease(buffer);
+        texture = nullptr;
+        buffer = nullptr;
+    }
+};
+
+// Analysis state shared with the copies and analyses still in flight, so an
+// OpticalFlow can be destroyed while they finish
+struct FlowState {
+    dispatch_queue_t queue = nullptr;
+    CVMetalTextureCacheRef textureCache = nullptr;
+    std::atomic<bool> busy{false};      // A frame is being copied or analyzed
+
+    // Analysis queue only
+    CVPixelBufferRef previous = nullptr;
+
+    // Latest result, handed to the main thread
+    std::mutex mutex;
+    bool hasResult = false;
+    FlowResult result;
+    std::string error;
+
+    ~FlowState() {
+        result.release();
+        if (previous) CVPixelBufferRelease(previous);
+        if (textureCache) CFRelease(textureCache);
+    }
+};
+
+struct FlowCapture {
+    std::shared_ptr<FlowState> state;
+    CVPixelBufferRef buffer = nullptr;
+    CVMetalTextureRef texture = nullptr;    // Keeps the GPU's view of buffer alive
+    VNGenerateOpticalFlowRequestComputationAccuracy accuracy = VNGenerateOpticalFlowRequestComputationAccuracyMedium;
+    int columns = 1;
+    int rows = 1;
+    bool reset = false;                     // Drop the previous frame first
+};
+
+// Mean flow per grid cell, read in place from the flow buffer
+void summarizeFlow(FlowResult& result, int columns, int rows) {
+    CVPixelBufferRef buffer = result.buffer;
+    const size_t width = CVPixelBufferGetWidth(buffer);
+    const size_t height = CVPixelBufferGetHeight(buffer);
+    if (width == 0 || height == 0 ||
+        CVPixelBufferLockBaseAddress(buffer, kCVPixelBufferLock_ReadOnly) != kCVReturnSuccess) {
+        return;
+    }
+    const uint8_t* base = static_cast<const uint8_t*>(CVPixelBufferGetBaseAddress(buffer));
+    const size_t bytesPerRow = CVPixelBufferGetBytesPerRow(buffer);
+
+    std::vector<double> sums(static_cast<size_t>(columns) * rows * 2, 0.0);
+    std::vector<size_t> counts(static_cast<size_t>(columns) * rows, 0);
+    double totalX = 0.0;
+    double totalY = 0.0;
+    for (size_t y = 0; y < height; y++) {
+        const __fp16* row = reinterpret_cast<const __fp16*>(base + y * bytesPerRow);
+        const size_t cellRow = std::min(y * rows / height, static_cast<size_t>(rows - 1)) * columns;
+        for (size_t x = 0; x < width; x++) {
+            const float dx = row[x * 2];
+            const float dy = row[x * 2 + 1];
+            const size_t cell = cellRow + std::min(x * columns / width, static_cast<size_t>(columns - 1));
+            sums[cell * 2] += dx;
+            sums[cell * 2 + 1] += dy;
+            counts[cell]++;
+            totalX += dx;
+            totalY += dy;
+        }
+    }
+    CVPixelBufferUnlockBaseAddress(buffer, kCVPixelBufferLock_ReadOnly);
+
+    // Pixels of the analysis size to fractions of the image
+    const float scaleX = 1.0f / width;
+    const float scaleY = 1.0f / height;
+    result.vectors.resize(counts.size());
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < columns; c++) {
+            const size_t cell = static_cast<size_t>(r) * columns + c;
+            const double count = std::max<size_t>(counts[cell], 1);
+            MotionVector& vector = result.vectors[cell];
+            vector.position = oflike::ofVec2f((c + 0.5f) / columns, (r + 0.5f) / rows);
+            vector.velocity = oflike::ofVec2f(static_cast<float>(sums[cell * 2] / count) * scaleX,
+                                              static_cast<float>(sums[cell * 2 + 1] / count) * scaleY);
+            vector.magnitude = vector.velocity.length();
+        }
+    }
+    const double pixels = static_cast<double>(width * height);
+    result.average = oflike::ofVec2f(static_cast<float>(totalX / pixels) * scaleX,
+                                     static_cast<float>(totalY / pixels) * scaleY);
+}
+
+// Flow from the previously analyzed frame to a copied one (analysis queue)
+void analyzeCapture(const FlowCapture& capture, bool succeeded) {
+    FlowState& state = *capture.state;
+    if (capture.texture) CFRelease(capture.texture);
+
+    if (capture.reset && state.previous) {
+        CVPixelBufferRelease(state.previous);
+        state.previous = nullptr;
+    }
+    if (!succeeded) {
+        CVPixelBufferRelease(capture.buffer);
+        state.busy = false;
+        return;
+    }
+    if (!state.previous) {
+        state.previous = capture.buffer;
+        state.busy = false;
+        return;
+    }
+
+    @autoreleasepool {
+        VNGenerateOpticalFlowRequest* request =
+            [[VNGenerateOpticalFlowRequest alloc] initWithTargetedCVPixelBuffer:capture.buffer options:@{}];
+        request.computationAccuracy = capture.accuracy;
+        request.outputPixelFormat = kCVPixelFormatType_TwoComponent16Half;
+
+        VNImageRequestHandler* handler = [[VNImageRequestHandler alloc]
+            initWithCVPixelBuffer:state.previous
+            options:@{}];
+
+        NSError* error = nil;
+        [handler performRequests:@[request] error:&error];
+
+        CVPixelBufferRelease(state.previous);
+        state.previous = capture.buffer;
+
+        VNPixelBufferObservation* observation = request.results.firstObject;
+        if (error || !observation) {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.error = error ? std::string([[error localizedDescription] UTF8String])
+                                : "Optical flow produced no result";
+            state.busy = false;
+            return;
+        }
+
+        FlowResult result;
+        result.buffer = CVPixelBufferRetain(observation.pixelBuffer);
+        summarizeFlow(result, capture.columns, capture.rows);
+
+        // Shared with Metal when Vision's buffer is IOSurface-backed
+        const size_t width = CVPixelBufferGetWidth(result.buffer);
+        const size_t height = CVPixelBufferGetHeight(result.buffer);
+        if (CVMetalTextureCacheCreateTextureFromImage(kCFAllocatorDefault, state.textureCache, result.buffer, nil,
+                                                      MTLPixelFormatRG16Float, width, height, 0,
+                                                      &result.texture) != kCVReturnSuccess) {
+            result.texture = nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.result.release();     // Never handed to the main thread
+        state.result = std::move(result);
+        state.hasResult = true;
+        state.error.clear();
+    }
+    state.busy = false;
+}
+
+// Copies recorded but not yet completed; Vision runs on the state's queue
+using FlowCaptureRegistry = render::CopyTextureRegistry<FlowCapture, &analyzeCapture>;
+
+VNGenerateOpticalFlowRequestComputationAccuracy toVision(OpticalFlowAccuracy accuracy) {
+    switch (accuracy) {
+        case OpticalFlowAccuracy::Low: return VNGenerateOpticalFlowRequestComputationAccuracyLow;
+        case OpticalFlowAccuracy::Medium: return VNGenerateOpticalFlowRequestComputationAccuracyMedium;
+        case OpticalFlowAccuracy::High: return VNGenerateOpticalFlowRequestComputationAccuracyHigh;
+        case OpticalFlowAccuracy::VeryHigh: return VNGenerateOpticalFlowRequestComputationAccuracyVeryHigh;
+    }
+    return VNGenerateOpticalFlowRequestComputationAccuracyMedium;
+}
+
+} // namespace
+
+class OpticalFlow::Impl {
+public:
+    std::shared_ptr<FlowState> state;
+    CVPixelBufferPoolRef pool = nullptr;
+    int analysisWidth = 320;
+    int width = 0;                      // Size of the pool's buffers
+    int height = 0;
+    OpticalFlowAccuracy accuracy = OpticalFlowAccuracy::Medium;
+    int columns = 16;
+    int rows = 9;
+    bool resetNext = false;
+    std::string lastError;
+
+    // Latest result on the main thread, and replaced ones the GPU may still draw
+    FlowResult current;
+    std::vector<std::pair<FlowResult, unsigned long long>> retired;
+    oflike::ofTexture flowTexture;
+    bool frameNew = false;
+
+    ~Impl() {
+        current.release();
+        for (auto& [result, frame] : retired) {
+            result.release();
+        }
+        if (pool) CVPixelBufferPoolRelease(pool);
+    }
+
+    bool createState() {
+        auto& ctx = Context::instance();
+        if (!ctx.isInitialized()) {
+            lastError = "Context not initialized";
+            return false;
+        }
+
+        // The copy kernel writes the buffers, so the textures need write usage
+        auto next = std::make_shared<FlowState>();
+        NSDictionary* textureAttributes = @{
+            (NSString*)kCVMetalTextureUsage: @(MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite),
+        };
+        id<MTLDevice> device = (__bridge id<MTLDevice>)ctx.getMetalDevice();
+        if (CVMetalTextureCacheCreate(kCFAllocatorDefault, nil, device,
+                                      (__bridge CFDictionaryRef)textureAttributes,
+                                      &next->textureCache) != kCVReturnSuccess) {
+            lastError = "Failed to create texture cache";
+            return false;
+        }
+        next->queue = dispatch_queue_create("com.oflike.opticalFlow", DISPATCH_QUEUE_SERIAL);
+        state = std::move(next);
+        return true;
+    }
+
+    // Metal-compatible IOSurface buffers, so the GPU copies straight into them
+    bool createPool(int poolWidth, int poolHeight) {
+        if (pool) {
+            CVPixelBufferPoolRelease(pool);
+            pool = nullptr;
+        }
+        NSDictionary* bufferAttributes = @{
+            (NSString*)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
+            (NSString*)kCVPixelBufferWidthKey: @(poolWidth),
+            (NSString*)kCVPixelBufferHeightKey: @(poolHeight),
+            (NSString*)kCVPixelBufferMetalCompatibilityKey: @YES,
+            (NSString*)kCVPixelBufferIOSurfacePropertiesKey: @{},
+        };
+        if (CVPixelBufferPoolCreate(kCFAllocatorDefault, nil, (__bridge CFDictionaryRef)bufferAttributes,
+                                    &pool) != kCVReturnSuccess) {
+            lastError = "Failed to create pixel buffer pool";
+            pool = nullptr;
+            return false;
+        }
+        width = poolWidth;
+        height = poolHeight;
+        return true;
+    }
+
+    // Take the latest result from the analysis queue (main thread)
+    void adoptResult() {
+        if (!state) return;
+        const unsigned long long frame = Context::instance().getFrameNum();
+
+        // Free replaced results the GPU can no longer be drawing
+        retired.erase(std::remove_if(retired.begin(), retired.end(), [frame](auto& entry) {
+            if (entry.second + kRetireFrames >= frame) return false;
+            entry.first.release();
+            return true;
+        }), retired.end());
+
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (!state->error.empty()) {
+            lastError = std::move(state->error);
+            state->error.clear();
+        }
+        if (!state->hasResult) return;
+        state->hasResult = false;
+
+        retired.emplace_back(current, frame);
+        current = state->result;
+        state->result = FlowResult();
+        if (current.texture) {
+            flowTexture.setNativeHandle((__bridge void*)CVMetalTextureGetTexture(current.texture));
+        }
+        frameNew = true;
+    }
+
+    bool update(const oflike::ofTexture& frame) {
+        adoptResult();
+        if (!frame.isAllocated() || !frame.getNativeHandle()) {
+            lastError = "Frame texture not allocated";
+            return false;
+        }
+        if (!state && !createState()) {
+            return false;
+        }
+
+        auto& ctx = Context::instance();
+        // A copy whose frame never rendered would keep the analysis busy
+        FlowCaptureRegistry::abandon(ctx.getFrameNum());
+        if (state->busy) {
+            return false;
+        }
+
+        int scaledWidth = 0;
+        int scaledHeight = 0;
+        scaledSize(frame, analysisWidth, scaledWidth, scaledHeight);
+        if ((scaledWidth != width || scaledHeight != height || !pool) && !createPool(scaledWidth, scaledHeight)) {
+            return false;
+        }
+
+        CVPixelBufferRef buffer = nullptr;
+        if (CVPixelBufferPoolCreatePixelBuffer(kCFAllocatorDefault, pool, &buffer) != kCVReturnSuccess) {
+            lastError = "Failed to create pixel buffer";
+            return false;
+        }
+        CVMetalTextureRef texture = nullptr;
+        if (CVMetalTextureCacheCreateTextureFromImage(kCFAllocatorDefault, state->textureCache, buffer, nil,
+                                                      MTLPixelFormatBGRA8Unorm, width, height, 0,
+                                                      &texture) != kCVReturnSuccess) {
+            CVPixelBufferRelease(buffer);
+            lastError = "Failed to create texture";
+            return false;
+        }
+
+        FlowCapture capture;
+        capture.state = state;
+        capture.buffer = buffer;
+        capture.texture = texture;
+        capture.accuracy = toVision(accuracy);
+        capture.columns = columns;
+        capture.rows = rows;
+        capture.reset = resetNext;
+        resetNext = false;
+
+        render::CopyTextureCommand cmd;
+        cmd.source = frame.getNativeHandle();
+        cmd.destination = (__bridge void*)CVMetalTextureGetTexture(texture);
+        cmd.opaque = true;
+        FlowCaptureRegistry::add(cmd, std::move(capture), state->queue, ctx.getFrameNum());
+
+        state->busy = true;
+        ctx.getDrawList().addCommand(cmd);
+        CVMetalTextureCacheFlush(state->textureCache, 0);
+        return true;
+    }
+};
+
+OpticalFlow::OpticalFlow()
+    : pImpl(std::make_unique<Impl>()) {
+}
+
+OpticalFlow::~OpticalFlow() = default;
+
+void OpticalFlow::setup(int analysisWidth, OpticalFlowAccuracy accuracy) {
+    pImpl->analysisWidth = std::max(analysisWidth, 16);
+    pImpl->accuracy = accuracy;
+    pImpl->resetNext = true;
+}
+
+bool OpticalFlow::update(const oflike::ofTexture& frame) {
+    return pImpl->update(frame);
+}
+
+bool OpticalFlow::isFrameNew() {
+    pImpl->adoptResult();
+    bool isNew = pImpl->frameNew;
+    pImpl->frameNew = false;
+    return isNew;
+}
+
+const oflike::ofTexture& OpticalFlow::getFlowTexture() const {
+    return pImpl->flowTexture;
+}
+
+void OpticalFlow::setGridSize(int columns, int rows) {
+    pImpl->columns = std::max(columns, 1);
+    pImpl->rows = std::max(rows, 1);
+}
+
+std::vector<MotionVector> OpticalFlow::getMotionVectors() const {
+    return pImpl->current.vectors;
+}
+
+oflike::ofVec2f OpticalFlow::getAverageMotion() const {
+    return pImpl->current.average;
+}
+
+void OpticalFlow::reset() {
+    pImpl->resetNext = true;
+}
+
+bool OpticalFlow::hasError() const {
+    return !pImpl->lastError.empty();
+}
+
+std::string OpticalFlow::getLastError() const {
+    return pImpl->lastError;
+}
+
+// ============================================================================
+// Motion Kernels
+// ============================================================================
+
+namespace {
+
+// Frame difference and background model; frames are sampled at the output
+// size, so any frame size works
+const char* kMotionKernels = R"(
+#include <metal_stdlib>
+using namespace metal;
+
+constexpr sampler frameSampler(filter::linear, address::clamp_to_edge);
+
+struct FrameDifferenceParams {
+    float threshold;
+    uint hasPrevious;
+};
+
+struct BackgroundParams {
+    float threshold;        // Standard deviations
+    float learningRate;
+    float minVariance;
+    uint initialize;
+};
+
+static float3 sampleFrame(texture2d<float> frame, uint2 gid, uint2 size) {
+    return frame.sample(frameSampler, (float2(gid) + 0.5) / float2(size)).rgb;
+}
+
+kernel void frameDifference(
+    texture2d<float> frame [[texture(0)]],
+    texture2d<float, access::read> previous [[texture(1)]],
+    texture2d<float, access::write> next [[texture(2)]],
+    texture2d<float, access::write> difference [[texture(3)]],
+    constant FrameDifferenceParams& params [[buffer(0)]],
+    uint2 gid [[thread_position_in_grid]]
+) {
+    const uint2 size = uint2(difference.get_width(), difference.get_height());
+    if (any(gid >= size)) return;
+
+    const float luma = dot(sampleFrame(frame, gid, size), float3(0.299, 0.587, 0.114));
+    const float change = params.hasPrevious ? abs(luma - previous.read(gid).r) : 0.0;
+    const float value = params.threshold > 0.0 ? step(params.threshold, change) : change;
+    next.write(float4(luma, luma, luma, 1.0), gid);
+    difference.write(float4(value, value, value, 1.0), gid);
+}
+
+// Model texel: mean color, variance of the channels' mean squared distance
+kernel void backgroundSubtract(
+    texture2d<float> frame [[texture(0)]],
+    texture2d<float, access::read> background [[texture(1)]],
+    texture2d<float, access::write> next [[texture(2)]],
+    texture2d<float, access::write> mask [[texture(3)]],
+    constant BackgroundParams& params [[buffer(0)]],
+    uint2 gid [[thread_position_in_grid]]
+) {
+    const uint2 size = uint2(mask.get_width(), mask.get_height());
+    if (any(gid >= size)) return;
+
+    const float3 color = sampleFrame(frame, gid, size);
+    if (params.initialize) {
+        next.write(float4(color, params.minVariance), gid);
+        mask.write(float4(0.0, 0.0, 0.0, 1.0), gid);
+        return;
+    }
+
+    const float4 model = background.read(gid);
+    const float3 delta = color - model.rgb;
+    const float distance = dot(delta, delta) / 3.0;
+    const float variance = max(model.a, params.minVariance);
+    const bool foreground = distance > params.threshold * params.threshold * variance;
+
+    // Foreground learns slowly, so stopped objects fade into the background
+    const float rate = foreground ? params.learningRate * 0.1 : params.learningRate;
+    next.write(float4(model.rgb + rate * delta, variance + rate * (distance - variance)), gid);
+    const float value = foreground ? 1.0 : 0.0;
+    mask.write(float4(value, value, value, 1.0), gid);
+}
+)";
+
+struct FrameDifferenceParams {
+    float threshold;
+    uint32_t hasPrevious;
+};
+
+struct BackgroundParams {
+    float threshold;
+    float learningRate;
+    float minVariance;
+    uint32_t initialize;
+};
+
+// Camera noise the background model never goes below (4 levels of 255)
+constexpr float kMinVariance = (4.0f / 255.0f) * (4.0f / 255.0f);
+
+bool loadKernel(oflike::ofComputeShader& shader, const char* name, std::string& error) {
+    if (shader.isLoaded()) return true;
+    if (!shader.loadFromSource(kMotionKernels, name)) {
+        error = std::string("Failed to compile kernel ") + name;
+        return false;
+    }
+    return true;
+}
+
+// Output size: the setup size, or the frame's
+void outputSize(const oflike::ofTexture& frame, int setupWidth, int setupHeight, int& width, int& height) {
+    width = setupWidth > 0 ? setupWidth : static_cast<int>(frame.getWidth());
+    height = setupHeight > 0 ? setupHeight : static_cast<int>(frame.getHeight());
+}
+
+} // namespace
+
+// ============================================================================
+// Background Subtraction
+// ============================================================================
+
+class BackgroundSubtractor::Impl {
+public:
+    oflike::ofComputeShader kernel;
+    int setupWidth = 0;
+    int setupHeight = 0;
+    float learningRate = 0.01f;
+    float threshold = 2.5f;
+    std::string lastError;
+
+    // Ping-pong model textures (half float: 8 bits can't learn slowly)
+    id<MTLTexture> models[2] = {nil, nil};
+    int current = 0;
+    bool initialized = false;
+
+    bool createModels(int width, int height) {
+        auto& ctx = Context::instance();
+        id<MTLDevice> device = (__bridge id<MTLDevice>)ctx.getMetalDevice();
+        if (!device) {
+            lastError = "No Metal device available";
+            return false;
+        }
+        MTLTextureDescriptor* desc = [MTLTextureDescriptor
+            texture2DDescriptorWithPixelFormat:MTLPixelFormatRGBA16Float
+                                         width:width
+                                        height:height
+                                     mipmapped:NO];
+        desc.usage = MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite;
+        desc.storageMode = MTLStorageModePrivate;
+        for (auto& model : models) {
+            model = [device newTextureWithDescriptor:desc];
+            if (!model) {
+                lastError = "Failed to create background model";
+                return false;
+            }
+        }
+        initialized = false;
+        return true;
+    }
+
+    bool update(const oflike::ofTexture& frame, oflike::ofTexture& mask) {
+        if (!frame.isAllocated() || !frame.getNativeHandle()) {
+            lastError = "Frame texture not allocated";
+            return false;
+        }
+        if (!loadKernel(kernel, "backgroundSubtract", lastError)) {
+            return false;
+        }
+
+        int width = 0;
+        int height = 0;
+        outputSize(frame, setupWidth, setupHeight, width, height);
+        if ((!models[0] || static_cast<int>(models[0].width) != width ||
+             static_cast<int>(models[0].height) != height) && !createModels(width, height)) {
+            return false;
+        }
+        if (!mask.allocateWritable(width, height)) {
+            lastError = "Failed to allocate mask";
+            return false;
+        }
+
+        BackgroundParams params;
+        params.threshold = threshold;
+        params.learningRate = learningRate;
+        params.minVariance = kMinVariance;
+        params.initialize = initialized ? 0 : 1;
+
+        kernel.setTexture(0, frame);
+        kernel.setTexture(1, (__bridge void*)models[current]);
+        kernel.setTexture(2, (__bridge void*)models[1 - current]);
+        kernel.setTexture(3, mask);
+        kernel.setConstants(params);
+        if (!kernel.dispatch(width, height)) {
+            lastError = "Failed to record kernel";
+            return false;
+        }
+        current = 1 - current;
+        initialized = true;
+        return true;
+    }
+};
+
+BackgroundSubtractor::BackgroundSubtractor()
+    : pImpl(std::make_unique<Impl>()) {
+}
+
+BackgroundSubtractor::~BackgroundSubtractor() = default;
+
+void BackgroundSubtractor::setup(int width, int height) {
+    pImpl->setupWidth = std::max(width, 0);
+    pImpl->setupHeight = std::max(height, 0);
+    pImpl->initialized = false;
+}
+
+void BackgroundSubtractor::setLearningRate(float rate) {
+    pImpl->learningRate = std::clamp(rate, 0.0f, 1.0f);
+}
+
+float BackgroundSubtractor::getLearningRate() const {
+    return pImpl->learningRate;
+}
+
+void BackgroundSubtractor::setThreshold(float deviations) {
+    pImpl->threshold = std::max(deviations, 0.0f);
+}
+
+float BackgroundSubtractor::getThreshold() const {
+    return pImpl->threshold;
+}
+
+bool BackgroundSubtractor::update(const oflike::ofTexture& frame, oflike::ofTexture& mask) {
+    return pImpl->update(frame, mask);
+}
+
+void BackgroundSubtractor::reset() {
+    pImpl->initialized = false;
+}
+
+bool BackgroundSubtractor::hasError() const {
+    return !pImpl->lastError.empty();
+}
+
+std::string BackgroundSubtractor::getLastError() const {
+    return pImpl->lastError;
+}
+
+// ============================================================================
+// Frame Difference
+// ============================================================================
+
+class FrameDifference::Impl {
+public:
+    oflike::ofComputeShader kernel;
+    int setupWidth = 0;
+    int setupHeight = 0;
+    float threshold = 0.1f;
+    std::string lastError;
+
+    // Ping-pong luminance of the previous frame
+    oflike::ofTexture previous[2];
+    int current = 0;
+    bool hasPrevious = false;
+
+    bool update(const oflike::ofTexture& frame, oflike::ofTexture& difference) {
+        if (!frame.isAllocated() || !frame.getNativeHandle()) {
+            lastError = "Frame texture not allocated";
+            return false;
+        }
+        if (!loadKernel(kernel, "frameDifference", lastError)) {
+            return false;
+        }
+
+        int width = 0;
+        int height = 0;
+        outputSize(frame, setupWidth, setupHeight, width, height);
+        if (previous[0].getWidth() != width || previous[0].getHeight() != height) {
+            hasPrevious = false;
+        }
+        if (!previous[0].allocateWritable(width, height) || !previous[1].allocateWritable(width, height) ||
+            !difference.allocateWritable(width, height)) {
+            lastError = "Failed to allocate textures";
+            return false;
+        }
+
+        FrameDifferenceParams params;
+        params.threshold = threshold;
+        params.hasPrevious = hasPrevious ? 1 : 0;
+
+        kernel.setTexture(0, frame);
+        kernel.setTexture(1, previous[current]);
+        kernel.setTexture(2, previous[1 - current]);
+        kernel.setTexture(3, difference);
+        kernel.setConstants(params);
+        if (!kernel.dispatch(width, height)) {
+            lastError = "Failed to record kernel";
+            return false;
+        }
+        current = 1 - current;
+        hasPrevious = true;
+        return true;
+    }
+};
+
+FrameDifference::FrameDifference()
+    : pImpl(std::make_unique<Impl>()) {
+}
+
+FrameDifference::~FrameDifference() = default;
+
+void FrameDifference::setup(int width, int height) {
+    pImpl->setupWidth = std::max(width, 0);
+    pImpl->setupHeight = std::max(height, 0);
+    pImpl->hasPrevious = false;
+}
+
+void FrameDifference::setThreshold(float threshold) {
+    pImpl->threshold = std::clamp(threshold, 0.0f, 1.0f);
+}
+
+float FrameDifference::getThreshold() const {
+    return pImpl->threshold;
+}
+
+bool FrameDifference::update(const oflike::ofTexture& frame, oflike::ofTexture& difference) {
+    return pImpl->update(frame, difference);
+}
+
+void FrameDifference::reset() {
+    pImpl->hasPrevious = false;
+}
+
+bool FrameDifference::hasError() const {
+    return !pImpl->lastError.empty();
+}
+
+std::string FrameDifference::getLastError() const {
+    return pImpl->lastError;
+}
+
+} // namespace ofxCv
@@ -49,6 +49,19 @@ struct BarcodeDetection {
     float confidence;                  // 0.0 - 1.0
 };
 
+/// Tracking mode for face and human detection
+/// Once objects are found, later calls update them with VNTrackObjectRequest
+/// (through a VNSequenceRequestHandler) instead of detecting again. Full
+/// detection runs every detectionInterval calls; a lost track is searched
+/// for by detecting only in a region around its last box.
+struct TrackingSettings {
+    bool enabled = false;
+    int detectionInterval = 15;         // Calls between full-frame detections
+    float minTrackingConfidence = 0.3f; // Tracks below this are lost
+    float searchMargin = 0.5f;          // Lost-track region growth per side, in box sizes
+    bool accurate = false;              // Accurate (slower) tracking level
+};
+
 /// Vision.framework detector wrapper
 /// Uses pImpl pattern to hide Objective-C++ from C++ headers
 class VisionDetector {
@@ -57,6 +70,7 @@ public:
     ~VisionDetector();
 
     // Face Detection
+    // With tracking enabled, call once per video frame
     bool detectFaces(const oflike::ofPixels& pixels, std::vector<FaceDetection>& results);
 
     // Human Detection
@@ -70,6 +84,28 @@ public:
     // Barcode Detection
     bool detectBarcodes(const oflike::ofPixels& pixels, std::vector<BarcodeDetection>& results);
 
+    // Tracking Mode (faces and humans, tracked separately)
+    void setTracking(const TrackingSettings& settings);
+    TrackingSettings getTracking() const;
+    void resetTracking(); // Drop all tracks; the next call detects full-frame
+
+    // Temporal Smoothing
+    // Feed face/human results with their frame's timestamp (seconds). Boxes
+    // are matched to the previous result by position; each edge is filtered
+    // (One-Euro). Safe to call from another thread than getInterpolated*()
+    void addFaceResult(const std::vector<FaceDetection>& faces, double timestamp);
+    void addHumanResult(const std::vector<HumanDetection>& humans, double timestamp);
+
+    // Smoothed boxes at a render time (same clock), predicted from the last
+    // result for up to maxPrediction seconds, so detection can run at a
+    // fraction of the display rate without visible jitter
+    std::vector<FaceDetection> getInterpolatedFaces(double time) const;
+    std::vector<HumanDetection> getInterpolatedHumans(double time) const;
+
+    // Default: minCutoff 1 Hz, beta 5, maxPrediction 0.1 s
+    void setSmoothing(float minCutoff, float beta, float maxPrediction);
+    void resetSmoothing();
+
     // Configuration
     void setMinimumConfidence(float confidence); // Default: 0.5
     float getMinimumConfidence() const;
@@ -2,6 +2,11 @@
 #import <Vision/Vision.h>
 #import <CoreGraphics/CoreGraphics.h>
 #import <ImageIO/ImageIO.h>
+#import "../../oflike/math/ofOneEuroFilter.h"
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <tuple>
 
 namespace ofxCv {
 
@@ -70,12 +75,136 @@ static oflike::ofRectangle visionRectToOf(CGRect visionRect) {
     );
 }
 
+// Helper: Clip a normalized Vision rect to the image
+static CGRect clipVisionRect(CGRect rect) {
+    return CGRectIntersection(rect, CGRectMake(0.0, 0.0, 1.0, 1.0));
+}
+
+// Most objects a sequence handler tracks at once
+static constexpr NSUInteger kMaxTrackedObjects = 16;
+
+// Helper: Detected or tracked box in Vision coordinates
+struct VisionBox {
+    CGRect boundingBox;
+    float confidence;
+};
+
+// Helper: Detections of one kind tracked over time, a filter per box coordinate
+template <typename Detection>
+class BoxTracks {
+public:
+    void add(const std::vector<Detection>& detections, double timestamp, float minCutoff, float beta) {
+        // Match detections to tracks, closest centers first; only boxes
+        // whose centers are within a box size of each other match
+        std::vector<std::tuple<float, size_t, size_t>> pairs;
+        for (size_t t = 0; t < tracks_.size(); t++) {
+            const oflike::ofRectangle& a = tracks_[t].detection.boundingBox;
+            float reach = std::max(a.width, a.height);
+            for (size_t d = 0; d < detections.size(); d++) {
+                const oflike::ofRectangle& b = detections[d].boundingBox;
+                float dx = (b.x + b.width * 0.5f) - (a.x + a.width * 0.5f);
+                float dy = (b.y + b.height * 0.5f) - (a.y + a.height * 0.5f);
+                float distance = dx * dx + dy * dy;
+                if (distance <= reach * reach) {
+                    pairs.emplace_back(distance, t, d);
+                }
+            }
+        }
+        std::sort(pairs.begin(), pairs.end());
+
+        std::vector<int> trackForDetection(detections.size(), -1);
+        std::vector<bool> trackUsed(tracks_.size(), false);
+        for (const auto& [distance, t, d] : pairs) {
+            if (!trackUsed[t] && trackForDetection[d] < 0) {
+                trackUsed[t] = true;
+                trackForDetection[d] = static_cast<int>(t);
+            }
+        }
+
+        // Unmatched tracks are dropped; new detections start a track
+        std::vector<Track> updated;
+        updated.reserve(detections.size());
+        for (size_t d = 0; d < detections.size(); d++) {
+            Track track;
+            if (trackForDetection[d] >= 0) {
+                track = std::move(tracks_[trackForDetection[d]]);
+            } else {
+                for (auto& filter : track.filters) {
+                    filter.setParameters(minCutoff, beta);
+                }
+            }
+            const oflike::ofRectangle& box = detections[d].boundingBox;
+            track.filters[0].filter(box.x, timestamp);
+            track.filters[1].filter(box.y, timestamp);
+            track.filters[2].filter(box.width, timestamp);
+            track.filters[3].filter(box.height, timestamp);
+            track.detection = detections[d];
+            updated.push_back(std::move(track));
+        }
+        tracks_ = std::move(updated);
+    }
+
+    std::vector<Detection> get(double time, double maxPrediction) const {
+        std::vector<Detection> detections;
+        detections.reserve(tracks_.size());
+        for (const auto& track : tracks_) {
+            Detection detection = track.detection;
+            detection.boundingBox = oflike::ofRectangle(
+                track.filters[0].getValueAt(time, maxPrediction),
+                track.filters[1].getValueAt(time, maxPrediction),
+                std::max(track.filters[2].getValueAt(time, maxPrediction), 0.0f),
+                std::max(track.filters[3].getValueAt(time, maxPrediction), 0.0f)
+            );
+            detections.push_back(detection);
+        }
+        return detections;
+    }
+
+    void setParameters(float minCutoff, float beta) {
+        for (auto& track : tracks_) {
+            for (auto& filter : track.filters) {
+                filter.setParameters(minCutoff, beta);
+            }
+        }
+    }
+
+    void clear() {
+        tracks_.clear();
+    }
+
+private:
+    struct Track {
+        Detection detection;
+        std::array<oflike::ofOneEuroFilter, 4> filters;  // x, y, width, height
+    };
+    std::vector<Track> tracks_;
+};
+
 class VisionDetector::Impl {
 public:
     float minimumConfidence = 0.5f;
     std::string lastError;
     NSArray<NSString*>* textLanguages = nil;
 
+    // Temporal smoothing, shared between add*Result() and getInterpolated*()
+    mutable std::mutex smoothingMutex;
+    BoxTracks<FaceDetection> faceTracks;
+    BoxTracks<HumanDetection> humanTracks;
+    float smoothingMinCutoff = 1.0f;
+    float smoothingBeta = 5.0f;
+    float maxPrediction = 0.1f;
+
+    // Tracking mode: live VNTrackObjectRequests for one kind of detection
+    struct ObjectTracker {
+        VNSequenceRequestHandler* handler = nil;
+        NSMutableArray<VNTrackObjectRequest*>* requests = nil;
+        NSMutableArray<VNTrackObjectRequest*>* retiring = nil;  // lastFrame, performed once more
+        int callsSinceDetection = 0;
+    };
+    TrackingSettings tracking;
+    ObjectTracker faceTracker;
+    ObjectTracker humanTracker;
+
     Impl() {
         @autoreleasepool {
             // Default to English
@@ -93,77 +222,197 @@ public:
         @autoreleasepool {
             results.clear();
 
-            CVPixelBufferRef pixelBuffer = createPixelBuffer(pixels);
-            if (!pixelBuffer) {
-                lastError = "Failed to create pixel buffer";
+            std::vector<VisionBox> boxes;
+            if (!detectObjects(pixels, [VNDetectFaceRectanglesRequest class], faceTracker, boxes)) {
                 return false;
             }
 
-            VNDetectFaceRectanglesRequest* request = [[VNDetectFaceRectanglesRequest alloc] init];
-
-            VNImageRequestHandler* handler = [[VNImageRequestHandler alloc]
-                initWithCVPixelBuffer:pixelBuffer
-                options:@{}];
+            for (const VisionBox& box : boxes) {
+                FaceDetection detection;
+                detection.boundingBox = visionRectToOf(box.boundingBox);
+                detection.confidence = box.confidence;
+                results.push_back(detection);
+            }
 
-            NSError* error = nil;
-            [handler performRequests:@[request] error:&error];
+            return true;
+        }
+    }
 
-            CVPixelBufferRelease(pixelBuffer);
+    bool detectHumans(const oflike::ofPixels& pixels, std::vector<HumanDetection>& results) {
+        @autoreleasepool {
+            results.clear();
 
-            if (error) {
-                lastError = std::string([[error localizedDescription] UTF8String]);
+            std::vector<VisionBox> boxes;
+            if (!detectObjects(pixels, [VNDetectHumanRectanglesRequest class], humanTracker, boxes)) {
                 return false;
             }
 
-            for (VNFaceObservation* observation in request.results) {
-                if (observation.confidence >= minimumConfidence) {
-                    FaceDetection detection;
-                    detection.boundingBox = visionRectToOf(observation.boundingBox);
-                    detection.confidence = observation.confidence;
-                    results.push_back(detection);
-                }
+            for (const VisionBox& box : boxes) {
+                HumanDetection detection;
+                detection.boundingBox = visionRectToOf(box.boundingBox);
+                detection.confidence = box.confidence;
+                results.push_back(detection);
             }
 
             return true;
         }
     }
 
-    bool detectHumans(const oflike::ofPixels& pixels, std::vector<HumanDetection>& results) {
-        @autoreleasepool {
-            results.clear();
+    // Detect (or, in tracking mode, track) objects with a rectangle request
+    bool detectObjects(const oflike::ofPixels& pixels, Class requestClass, ObjectTracker& tracker,
+                       std::vector<VisionBox>& boxes) {
+        CVPixelBufferRef pixelBuffer = createPixelBuffer(pixels);
+        if (!pixelBuffer) {
+            lastError = "Failed to create pixel buffer";
+            return false;
+        }
 
-            CVPixelBufferRef pixelBuffer = createPixelBuffer(pixels);
-            if (!pixelBuffer) {
-                lastError = "Failed to create pixel buffer";
-                return false;
-            }
+        bool success;
+        if (!tracking.enabled) {
+            success = detectInRegion(pixelBuffer, requestClass, CGRectMake(0.0, 0.0, 1.0, 1.0), boxes);
+        } else {
+            success = trackObjects(pixelBuffer, requestClass, tracker, boxes);
+        }
 
-            VNDetectHumanRectanglesRequest* request = [[VNDetectHumanRectanglesRequest alloc] init];
+        CVPixelBufferRelease(pixelBuffer);
+        return success;
+    }
 
-            VNImageRequestHandler* handler = [[VNImageRequestHandler alloc]
-                initWithCVPixelBuffer:pixelBuffer
-                options:@{}];
+    // Detection restricted to a normalized region; boxes in image coordinates
+    bool detectInRegion(CVPixelBufferRef pixelBuffer, Class requestClass, CGRect region,
+                        std::vector<VisionBox>& boxes) {
+        VNImageBasedRequest* request = [[requestClass alloc] init];
+        request.regionOfInterest = region;
 
-            NSError* error = nil;
-            [handler performRequests:@[request] error:&error];
+        VNImageRequestHandler* handler = [[VNImageRequestHandler alloc]
+            initWithCVPixelBuffer:pixelBuffer
+            options:@{}];
 
-            CVPixelBufferRelease(pixelBuffer);
+        NSError* error = nil;
+        [handler performRequests:@[request] error:&error];
 
-            if (error) {
-                lastError = std::string([[error localizedDescription] UTF8String]);
+        if (error) {
+            lastError = std::string([[error localizedDescription] UTF8String]);
+            return false;
+        }
+
+        // Results are normalized to the region of interest
+        for (VNDetectedObjectObservation* observation in request.results) {
+            if (observation.confidence >= minimumConfidence) {
+                CGRect box = observation.boundingBox;
+                box.origin.x = region.origin.x + box.origin.x * region.size.width;
+                box.origin.y = region.origin.y + box.origin.y * region.size.height;
+                box.size.width *= region.size.width;
+                box.size.height *= region.size.height;
+                boxes.push_back({box, observation.confidence});
+            }
+        }
+        return true;
+    }
+
+    bool trackObjects(CVPixelBufferRef pixelBuffer, Class requestClass, ObjectTracker& tracker,
+                      std::vector<VisionBox>& boxes) {
+        if (!tracker.handler) {
+            tracker.handler = [[VNSequenceRequestHandler alloc] init];
+            tracker.requests = [NSMutableArray array];
+            tracker.retiring = [NSMutableArray array];
+        }
+
+        // Full detection: on the first call, at the interval, or with nothing tracked
+        if (tracker.requests.count == 0 || ++tracker.callsSinceDetection >= tracking.detectionInterval) {
+            std::vector<VisionBox> detected;
+            if (!detectInRegion(pixelBuffer, requestClass, CGRectMake(0.0, 0.0, 1.0, 1.0), detected)) {
                 return false;
             }
+            [tracker.retiring addObjectsFromArray:tracker.requests];
+            [tracker.requests removeAllObjects];
+            startTracks(tracker, detected);
+            flushRetiring(pixelBuffer, tracker);
+            tracker.callsSinceDetection = 0;
+            boxes = std::move(detected);
+            return true;
+        }
 
-            for (VNHumanObservation* observation in request.results) {
-                if (observation.confidence >= minimumConfidence) {
-                    HumanDetection detection;
-                    detection.boundingBox = visionRectToOf(observation.boundingBox);
-                    detection.confidence = observation.confidence;
-                    results.push_back(detection);
-                }
+        // Track update for every live object (and release of retired ones)
+        NSArray<VNTrackObjectRequest*>* live = [tracker.requests copy];
+        for (VNTrackObjectRequest* request in tracker.retiring) {
+            request.lastFrame = YES;
+        }
+        NSArray<VNRequest*>* performed = [live arrayByAddingObjectsFromArray:tracker.retiring];
+        NSError* error = nil;
+        [tracker.handler performRequests:performed onCVPixelBuffer:pixelBuffer error:&error];
+        [tracker.retiring removeAllObjects];
+
+        if (error) {
+            // Trackers are unusable after a failure; detect again next call
+            lastError = std::string([[error localizedDescription] UTF8String]);
+            [tracker.requests removeAllObjects];
+            tracker.handler = nil;
+            return false;
+        }
+
+        std::vector<CGRect> lost;
+        for (VNTrackObjectRequest* request in live) {
+            VNDetectedObjectObservation* observation = request.results.firstObject;
+            if (observation && observation.confidence >= tracking.minTrackingConfidence) {
+                request.inputObservation = observation;
+                boxes.push_back({observation.boundingBox, observation.confidence});
+            } else {
+                lost.push_back(request.inputObservation.boundingBox);
+                [tracker.requests removeObject:request];
+                [tracker.retiring addObject:request];
             }
+        }
 
-            return true;
+        // Look for lost objects only around where they were
+        for (CGRect box : lost) {
+            CGFloat marginX = box.size.width * tracking.searchMargin;
+            CGFloat marginY = box.size.height * tracking.searchMargin;
+            CGRect region = clipVisionRect(CGRectInset(box, -marginX, -marginY));
+            if (CGRectIsEmpty(region)) {
+                continue;
+            }
+            std::vector<VisionBox> found;
+            if (detectInRegion(pixelBuffer, requestClass, region, found)) {
+                startTracks(tracker, found);
+                boxes.insert(boxes.end(), found.begin(), found.end());
+            }
+        }
+
+        return true;
+    }
+
+    void startTracks(ObjectTracker& tracker, const std::vector<VisionBox>& detected) {
+        for (const VisionBox& box : detected) {
+            if (tracker.requests.count >= kMaxTrackedObjects) {
+                break;
+            }
+            VNDetectedObjectObservation* observation =
+                [VNDetectedObjectObservation observationWithBoundingBox:box.boundingBox];
+            VNTrackObjectRequest* request =
+                [[VNTrackObjectRequest alloc] initWithDetectedObjectObservation:observation];
+            request.trackingLevel = tracking.accurate ? VNRequestTrackingLevelAccurate
+                                                      : VNRequestTrackingLevelFast;
+            [tracker.requests addObject:request];
+        }
+    }
+
+    // Let Vision free the trackers of retired requests
+    void flushRetiring(CVPixelBufferRef pixelBuffer, ObjectTracker& tracker) {
+        if (tracker.retiring.count == 0) {
+            return;
+        }
+        for (VNTrackObjectRequest* request in tracker.retiring) {
+            request.lastFrame = YES;
+        }
+        [tracker.handler performRequests:tracker.retiring onCVPixelBuffer:pixelBuffer error:nil];
+        [tracker.retiring removeAllObjects];
+    }
+
+    void resetTracking() {
+        @autoreleasepool {
+            faceTracker = ObjectTracker();
+            humanTracker = ObjectTracker();
         }
     }
 
@@ -332,6 +581,57 @@ bool VisionDetector::detectBarcodes(const oflike::ofPixels& pixels, std::vector<
     return pImpl->detectBarcodes(pixels, results);
 }
 
+void VisionDetector::setTracking(const TrackingSettings& settings) {
+    bool wasEnabled = pImpl->tracking.enabled;
+    pImpl->tracking = settings;
+    if (wasEnabled != settings.enabled) {
+        pImpl->resetTracking();
+    }
+}
+
+TrackingSettings VisionDetector::getTracking() const {
+    return pImpl->tracking;
+}
+
+void VisionDetector::resetTracking() {
+    pImpl->resetTracking();
+}
+
+void VisionDetector::addFaceResult(const std::vector<FaceDetection>& faces, double timestamp) {
+    std::lock_guard<std::mutex> lock(pImpl->smoothingMutex);
+    pImpl->faceTracks.add(faces, timestamp, pImpl->smoothingMinCutoff, pImpl->smoothingBeta);
+}
+
+void VisionDetector::addHumanResult(const std::vector<HumanDetection>& humans, double timestamp) {
+    std::lock_guard<std::mutex> lock(pImpl->smoothingMutex);
+    pImpl->humanTracks.add(humans, timestamp, pImpl->smoothingMinCutoff, pImpl->smoothingBeta);
+}
+
+std::vector<FaceDetection> VisionDetector::getInterpolatedFaces(double time) const {
+    std::lock_guard<std::mutex> lock(pImpl->smoothingMutex);
+    return pImpl->faceTracks.get(time, pImpl->maxPrediction);
+}
+
+std::vector<HumanDetection> VisionDetector::getInterpolatedHumans(double time) const {
+    std::lock_guard<std::mutex> lock(pImpl->smoothingMutex);
+    return pImpl->humanTracks.get(time, pImpl->maxPrediction);
+}
+
+void VisionDetector::setSmoothing(float minCutoff, float beta, float maxPrediction) {
+    std::lock_guard<std::mutex> lock(pImpl->smoothingMutex);
+    pImpl->smoothingMinCutoff = minCutoff;
+    pImpl->smoothingBeta = beta;
+    pImpl->maxPrediction = maxPrediction;
+    pImpl->faceTracks.setParameters(minCutoff, beta);
+    pImpl->humanTracks.setParameters(minCutoff, beta);
+}
+
+void VisionDetector::resetSmoothing() {
+    std::lock_guard<std::mutex> lock(pImpl->smoothingMutex);
+    pImpl->faceTracks.clear();
+    pImpl->humanTracks.clear();
+}
+
 void VisionDetector::setMinimumConfidence(float confidence) {
     pImpl->minimumConfidence = confidence;
 }
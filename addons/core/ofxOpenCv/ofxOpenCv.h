@@ -13,6 +13,10 @@
 // - Human detection (VNDetectHumanRectanglesRequest)
 // - Text recognition (VNRecognizeTextRequest)
 // - Barcode detection (VNDetectBarcodesRequest)
+// - Tracking mode for faces and humans (VNTrackObjectRequest between detections)
+// - Optical flow (VNGenerateOpticalFlowRequest) on ofTexture frames, as a
+//   flow texture and a grid of motion vectors
+// - GPU background subtraction and frame difference, ofTexture to ofTexture
 // - Image format conversion (ofPixels ↔ CVPixelBuffer ↔ cv::Mat)
 //
 // All bounding boxes are returned in normalized coordinates [0,1]
@@ -20,6 +24,7 @@
 
 #include "ofxCvVisionDetector.h"
 #include "ofxCvImageConversion.h"
+#include "ofxCvMotion.h"
 
 namespace ofxCv {
     // Re-export main types for detection
@@ -30,6 +35,14 @@ namespace ofxCv {
     using BarcodeDetection = BarcodeDetection;
     using DetectionType = DetectionType;
     using TextRecognitionLevel = TextRecognitionLevel;
+    using TrackingSettings = TrackingSettings;
+
+    // Re-export motion analysis types
+    using OpticalFlow = OpticalFlow;
+    using OpticalFlowAccuracy = OpticalFlowAccuracy;
+    using MotionVector = MotionVector;
+    using BackgroundSubtractor = BackgroundSubtractor;
+    using FrameDifference = FrameDifference;
 
     // Re-export image conversion utilities
     using ImageConverter = ImageConverter;
@@ -0,0 +1,186 @@
+#include "ofxOscMessageView.h"
+#include <stdexcept>
+
+ofxOscMessage::ArgType ofxOscMessageView::getArgType(size_t index) const {
+    checkArgumentIndex(index);
+    return args_[index].type;
+}
+
+int32_t ofxOscMessageView::getArgAsInt32(size_t index) const {
+    checkArgumentIndex(index);
+    const ofxOscArgView& arg = args_[index];
+
+    switch (arg.type) {
+        case ofxOscMessage::OFX_OSC_TYPE_INT32:
+            return arg.asInt32;
+        case ofxOscMessage::OFX_OSC_TYPE_INT64:
+            return static_cast<int32_t>(arg.asInt64);
+        case ofxOscMessage::OFX_OSC_TYPE_FLOAT:
+            return static_cast<int32_t>(arg.asFloat);
+        case ofxOscMessage::OFX_OSC_TYPE_DOUBLE:
+            return static_cast<int32_t>(arg.asDouble);
+        default:
+            throw std::runtime_error("Cannot convert argument to int32");
+    }
+}
+
+int64_t ofxOscMessageView::getArgAsInt64(size_t index) const {
+    checkArgumentIndex(index);
+    const ofxOscArgView& arg = args_[index];
+
+    switch (arg.type) {
+        case ofxOscMessage::OFX_OSC_TYPE_INT32:
+            return static_cast<int64_t>(arg.asInt32);
+        case ofxOscMessage::OFX_OSC_TYPE_INT64:
+            return arg.asInt64;
+        case ofxOscMessage::OFX_OSC_TYPE_FLOAT:
+            return static_cast<int64_t>(arg.asFloat);
+        case ofxOscMessage::OFX_OSC_TYPE_DOUBLE:
+            return static_cast<int64_t>(arg.asDouble);
+        default:
+            throw std::runtime_error("Cannot convert argument to int64");
+    }
+}
+
+float ofxOscMessageView::getArgAsFloat(size_t index) const {
+    checkArgumentIndex(index);
+    const ofxOscArgView& arg = args_[index];
+
+    switch (arg.type) {
+        case ofxOscMessage::OFX_OSC_TYPE_INT32:
+            return static_cast<float>(arg.asInt32);
+        case ofxOscMessage::OFX_OSC_TYPE_INT64:
+            return static_cast<float>(arg.asInt64);
+        case ofxOscMessage::OFX_OSC_TYPE_FLOAT:
+            return arg.asFloat;
+        case ofxOscMessage::OFX_OSC_TYPE_DOUBLE:
+            return static_cast<float>(arg.asDouble);
+        default:
+            throw std::runtime_error("Cannot convert argument to float");
+    }
+}
+
+double ofxOscMessageView::getArgAsDouble(size_t index) const {
+    checkArgumentIndex(index);
+    const ofxOscArgView& arg = args_[index];
+
+    switch (arg.type) {
+        case ofxOscMessage::OFX_OSC_TYPE_INT32:
+            return static_cast<double>(arg.asInt32);
+        case ofxOscMessage::OFX_OSC_TYPE_INT64:
+            return static_cast<double>(arg.asInt64);
+        case ofxOscMessage::OFX_OSC_TYPE_FLOAT:
+            return static_cast<double>(arg.asFloat);
+        case ofxOscMessage::OFX_OSC_TYPE_DOUBLE:
+            return arg.asDouble;
+        default:
+            throw std::runtime_error("Cannot convert argument to double");
+    }
+}
+
+bool ofxOscMessageView::getArgAsBool(size_t index) const {
+    checkArgumentIndex(index);
+    const ofxOscArgView& arg = args_[index];
+
+    switch (arg.type) {
+        case ofxOscMessage::OFX_OSC_TYPE_TRUE:
+            return true;
+        case ofxOscMessage::OFX_OSC_TYPE_FALSE:
+            return false;
+        case ofxOscMessage::OFX_OSC_TYPE_INT32:
+            return arg.asInt32 != 0;
+        case ofxOscMessage::OFX_OSC_TYPE_INT64:
+            return arg.asInt64 != 0;
+        case ofxOscMessage::OFX_OSC_TYPE_FLOAT:
+            return arg.asFloat != 0.0f;
+        case ofxOscMessage::OFX_OSC_TYPE_DOUBLE:
+            return arg.asDouble != 0.0;
+        default:
+            throw std::runtime_error("Cannot convert argument to bool");
+    }
+}
+
+char ofxOscMessageView::getArgAsChar(size_t index) const {
+    checkArgumentIndex(index);
+    if (args_[index].type != ofxOscMessage::OFX_OSC_TYPE_CHAR) {
+        throw std::runtime_error("Argument is not a char");
+    }
+    return args_[index].asChar;
+}
+
+uint32_t ofxOscMessageView::getArgAsRgbaColor(size_t index) const {
+    checkArgumentIndex(index);
+    if (args_[index].type != ofxOscMessage::OFX_OSC_TYPE_RGBA_COLOR) {
+        throw std::runtime_error("Argument is not an RGBA color");
+    }
+    return args_[index].asRgbaColor;
+}
+
+uint32_t ofxOscMessageView::getArgAsMidiMessage(size_t index) const {
+    checkArgumentIndex(index);
+    if (args_[index].type != ofxOscMessage::OFX_OSC_TYPE_MIDI_MESSAGE) {
+        throw std::runtime_error("Argument is not a MIDI message");
+    }
+    return args_[index].asMidiMessage;
+}
+
+uint64_t ofxOscMessageView::getArgAsTimeTag(size_t index) const {
+    checkArgumentIndex(index);
+    if (args_[index].type != ofxOscMessage::OFX_OSC_TYPE_TIMETAG) {
+        throw std::runtime_error("Argument is not a time tag");
+    }
+    return args_[index].asTimeTag;
+}
+
+std::string_view ofxOscMessageView::getArgAsString(size_t index) const {
+    checkArgumentIndex(index);
+    if (args_[index].type != ofxOscMessage::OFX_OSC_TYPE_STRING) {
+        throw std::runtime_error("Argument is not a string");
+    }
+    return args_[index].asString;
+}
+
+const uint8_t* ofxOscMessageView::getArgAsBlob(size_t index, size_t& size) const {
+    checkArgumentIndex(index);
+    if (args_[index].type != ofxOscMessage::OFX_OSC_TYPE_BLOB) {
+        throw std::runtime_error("Argument is not a blob");
+    }
+    size = args_[index].blobSize;
+    return args_[index].blobData;
+}
+
+const ofxOscArgView& ofxOscMessageView::getArgument(size_t index) const {
+    checkArgumentIndex(index);
+    return args_[index];
+}
+
+void ofxOscMessageView::copyTo(ofxOscMessage& message) const {
+    message.clear();
+    message.setAddress(std::string(address_));
+
+    for (size_t i = 0; i < numArgs_; i++) {
+        const ofxOscArgView& arg = args_[i];
+        switch (arg.type) {
+            case ofxOscMessage::OFX_OSC_TYPE_INT32: message.addIntArg(arg.asInt32); break;
+            case ofxOscMessage::OFX_OSC_TYPE_INT64: message.addInt64Arg(arg.asInt64); break;
+            case ofxOscMessage::OFX_OSC_TYPE_FLOAT: message.addFloatArg(arg.asFloat); break;
+            case ofxOscMessage::OFX_OSC_TYPE_DOUBLE: message.addDoubleArg(arg.asDouble); break;
+            case ofxOscMessage::OFX_OSC_TYPE_STRING: message.addStringArg(std::string(arg.asString)); break;
+            case ofxOscMessage::OFX_OSC_TYPE_BLOB: message.addBlobArg(arg.blobData, arg.blobSize); break;
+            case ofxOscMessage::OFX_OSC_TYPE_TRUE: message.addBoolArg(true); break;
+            case ofxOscMessage::OFX_OSC_TYPE_FALSE: message.addBoolArg(false); break;
+            case ofxOscMessage::OFX_OSC_TYPE_NONE: message.addNoneArg(); break;
+            case ofxOscMessage::OFX_OSC_TYPE_TRIGGER: message.addTriggerArg(); break;
+            case ofxOscMessage::OFX_OSC_TYPE_TIMETAG: message.addTimeTagArg(arg.asTimeTag); break;
+            case ofxOscMessage::OFX_OSC_TYPE_CHAR: message.addCharArg(arg.asChar); break;
+            case ofxOscMessage::OFX_OSC_TYPE_RGBA_COLOR: message.addRgbaColorArg(arg.asRgbaColor); break;
+            case ofxOscMessage::OFX_OSC_TYPE_MIDI_MESSAGE: message.addMidiMessageArg(arg.asMidiMessage); break;
+        }
+    }
+}
+
+void ofxOscMessageView::checkArgumentIndex(size_t index) const {
+    if (index >= numArgs_) {
+        throw std::out_of_range("Argument index out of range");
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "ofxOscMessage.h"
+#include <string_view>
+
+/// \brief A decoded OSC argument that refers to storage owned by the receiver
+struct ofxOscArgView {
+    ofxOscMessage::ArgType type = ofxOscMessage::OFX_OSC_TYPE_NONE;
+
+    union {
+        int32_t asInt32;
+        int64_t asInt64;
+        float asFloat;
+        double asDouble;
+        char asChar;
+        bool asBool;
+        uint64_t asTimeTag;
+        uint32_t asRgbaColor;
+        uint32_t asMidiMessage;
+    };
+
+    std::string_view asString;
+    const uint8_t* blobData = nullptr;
+    size_t blobSize = 0;
+
+    ofxOscArgView() : asInt64(0) {}
+};
+
+/// \brief Read-only OSC message that doesn't own its address or arguments.
+///
+/// ofxOscReceiver hands these out in message view mode: the message was
+/// decoded on the listener thread into a preallocated queue slot, and the
+/// view points into that slot. It stays valid until the receiver's next
+/// getNextMessage() call, so copy anything kept longer (or use copyTo()).
+///
+/// Getters convert between types like ofxOscMessage's, and throw the same
+/// exceptions for a bad index or an impossible conversion.
+///
+/// Example usage:
+/// \code
+/// ofxOscMessageView msg;
+/// while (receiver.getNextMessage(msg)) {
+///     if (msg.getAddress() == "/fader/1") {
+///         fader = msg.getArgAsFloat(0);
+///     }
+/// }
+/// \endcode
+class ofxOscMessageView {
+public:
+    ofxOscMessageView() = default;
+    ofxOscMessageView(std::string_view address, const ofxOscArgView* args, size_t numArgs)
+        : address_(address), args_(args), numArgs_(numArgs) {}
+
+    // Address pattern
+    /// \brief Get the OSC address pattern
+    std::string_view getAddress() const { return address_; }
+
+    // Query arguments
+    /// \brief Get the number of arguments
+    size_t getNumArgs() const { return numArgs_; }
+
+    /// \brief Get the type of the argument at index
+    ofxOscMessage::ArgType getArgType(size_t index) const;
+
+    // Get arguments (with bounds checking)
+    int32_t getArgAsInt32(size_t index) const;
+    int64_t getArgAsInt64(size_t index) const;
+    float getArgAsFloat(size_t index) const;
+    double getArgAsDouble(size_t index) const;
+    bool getArgAsBool(size_t index) const;
+    char getArgAsChar(size_t index) const;
+    uint32_t getArgAsRgbaColor(size_t index) const;
+    uint32_t getArgAsMidiMessage(size_t index) const;
+    uint64_t getArgAsTimeTag(size_t index) const;
+
+    /// \brief Get string argument at index (string arguments only)
+    std::string_view getArgAsString(size_t index) const;
+
+    /// \brief Get blob argument at index
+    /// \param size Receives the blob's size in bytes
+    const uint8_t* getArgAsBlob(size_t index, size_t& size) const;
+
+    /// \brief Get the raw argument at index
+    const ofxOscArgView& getArgument(size_t index) const;
+
+    // Conversion
+    /// \brief Copy into an owning message
+    void copyTo(ofxOscMessage& message) const;
+
+private:
+    std::string_view address_;
+    const ofxOscArgView* args_ = nullptr;
+    size_t numArgs_ = 0;
+
+    void checkArgumentIndex(size_t index) const;
+};
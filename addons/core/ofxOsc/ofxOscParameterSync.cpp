@@ -1,7 +1,26 @@
 #include "ofxOscParameterSync.h"
 #include "ofxOscMessage.h"
+#include "ofxOscRouter.h"
+#include <algorithm>
+#include <chrono>
 #include <map>
 #include <functional>
+#include <vector>
+
+// Snapshot receiver queue: one slot per parameter of the largest snapshot
+constexpr size_t kSnapshotMessages = 8192;
+constexpr size_t kSnapshotMessageSize = 256;
+constexpr size_t kSnapshotArgs = 4;
+
+using Clock = std::chrono::steady_clock;
+
+// A sent parameter: makes a message of its value, and tells whether it has
+// changed since the last one sent
+struct SyncedParameter {
+    std::function<ofxOscMessage()> makeMessage;
+    std::function<uint64_t()> getVersion;
+    uint64_t sentVersion = 0;
+};
 
 // MARK: - ofxOscParameterSync::Impl
 
@@ -10,16 +29,89 @@ public:
     ofxOscSender sender;
     ofxOscReceiver receiver;
 
+    // Reliable TCP channel for sendAll()
+    ofxOscSender snapshotSender;
+    ofxOscReceiver snapshotReceiver;
+
     bool hasSender = false;
     bool hasReceiver = false;
+    bool hasSnapshotSender = false;
+    bool hasSnapshotReceiver = false;
     bool autoSend = true;
     bool autoReceive = true;
+    bool coalesce = false;
+
+    // Routes OSC addresses to parameter update callbacks
+    ofxOscRouter router;
+
+    // Messages read per update(), grown to the largest batch seen
+    std::vector<ofxOscMessageView> batch;
+
+    // Sent parameters by OSC address
+    std::map<std::string, std::shared_ptr<SyncedParameter>> parameters;
+
+    // Delta and keyframe schedule (0 = off)
+    Clock::duration deltaInterval{0};
+    Clock::duration keyframeInterval{0};
+    Clock::time_point nextDelta;
+    Clock::time_point nextKeyframe;
+
+    // Every parameter, as a TCP snapshot or queued for the next flush
+    void sendAll() {
+        if (hasSnapshotSender) {
+            // One bundle over TCP: the snapshot arrives whole or not at all
+            ofxOscBundle snapshot;
+            for (auto& [address, parameter] : parameters) {
+                snapshot.addMessage(parameter->makeMessage());
+                parameter->sentVersion = parameter->getVersion();
+            }
+            snapshotSender.sendBundle(snapshot);
+            return;
+        }
 
-    // Map OSC addresses to parameter update callbacks
-    std::map<std::string, std::function<void(const ofxOscMessage&)>> receiveCallbacks;
+        for (auto& [address, parameter] : parameters) {
+            sender.queueMessage(parameter->makeMessage());
+            parameter->sentVersion = parameter->getVersion();
+        }
+    }
 
-    // Map OSC addresses to parameter send functions
-    std::map<std::string, std::function<void()>> sendCallbacks;
+    // The parameters changed since they were last sent, queued for the
+    // next flush; unchanged ones cost a version comparison
+    void sendChanged() {
+        for (auto& [address, parameter] : parameters) {
+            const uint64_t version = parameter->getVersion();
+            if (version != parameter->sentVersion) {
+                sender.queueMessage(parameter->makeMessage());
+                parameter->sentVersion = version;
+            }
+        }
+    }
+
+    // A keyframe when one is due, otherwise a delta when one is due
+    void sendScheduled() {
+        const Clock::time_point now = Clock::now();
+        if (keyframeInterval.count() > 0 && now >= nextKeyframe) {
+            sendAll();
+            nextKeyframe = now + keyframeInterval;
+            nextDelta = now + deltaInterval;
+        } else if (deltaInterval.count() > 0 && now >= nextDelta) {
+            sendChanged();
+            nextDelta = now + deltaInterval;
+        }
+    }
+
+    void dispatch(ofxOscReceiver& from) {
+        // Process all pending OSC messages as one batch, so coalescing sees
+        // every message of the frame
+        const size_t waiting = from.getNumWaitingMessages();
+        if (waiting == 0) return;
+        if (batch.size() < waiting) {
+            batch.resize(waiting);
+        }
+
+        const size_t count = from.getNextMessages(batch.data(), batch.size());
+        router.dispatch(batch.data(), count, coalesce);
+    }
 };
 
 // MARK: - ofxOscParameterSync
@@ -41,17 +133,29 @@ void ofxOscParameterSync::setupSender(const std::string& sendHost, int sendPort)
 }
 
 void ofxOscParameterSync::setupReceiver(int receivePort) {
+    impl_->receiver.enableMessageViews();
     impl_->receiver.setup(receivePort);
+    impl_->receiver.start();  // Messages are only received by the listener thread
     impl_->hasReceiver = true;
 }
 
+void ofxOscParameterSync::setupSnapshotSender(const std::string& sendHost, int tcpPort) {
+    impl_->hasSnapshotSender = impl_->snapshotSender.setupTcp(sendHost, tcpPort);
+}
+
+void ofxOscParameterSync::setupSnapshotReceiver(int tcpPort) {
+    impl_->snapshotReceiver.enableMessageViews(kSnapshotMessages, kSnapshotMessageSize, kSnapshotArgs);
+    impl_->snapshotReceiver.setupTcp(tcpPort);
+    impl_->snapshotReceiver.start();
+    impl_->hasSnapshotReceiver = true;
+}
+
 template<typename T>
 void ofxOscParameterSync::add(ofParameter<T>& param, const std::string& oscAddress) {
     // Setup sender callback
+    std::shared_ptr<SyncedParameter> synced;
     if (impl_->hasSender) {
-        auto sendCallback = [this, &param, oscAddress]() {
-            if (!impl_->autoSend) return;
-
+        auto makeMessage = [&param, oscAddress]() {
             ofxOscMessage msg;
             msg.setAddress(oscAddress);
 
@@ -66,21 +170,29 @@ void ofxOscParameterSync::add(ofParameter<T>& param, const std::string& oscAddre
             } else if constexpr (std::is_same_v<T, std::string>) {
                 msg.addStringArg(value);
             }
-
-            impl_->sender.sendMessage(msg);
+            return msg;
         };
 
-        impl_->sendCallbacks[oscAddress] = sendCallback;
+        synced = std::make_shared<SyncedParameter>();
+        synced->makeMessage = makeMessage;
+        synced->getVersion = [&param]() { return param.getVersion(); };
+        synced->sentVersion = param.getVersion();
+        impl_->parameters[oscAddress] = synced;
+
+        // Add listener to parameter for automatic sending; with deltas on,
+        // changes are found by version in update() instead
+        param.addListener([this, synced](T&) {
+            if (!impl_->autoSend || impl_->deltaInterval.count() > 0) return;
 
-        // Add listener to parameter for automatic sending
-        param.addListener([sendCallback](T&) {
-            sendCallback();
+            // Sent with the frame's other changes by update()
+            impl_->sender.queueMessage(synced->makeMessage());
+            synced->sentVersion = synced->getVersion();
         });
     }
 
     // Setup receiver callback
-    if (impl_->hasReceiver) {
-        auto receiveCallback = [&param](const ofxOscMessage& msg) {
+    if (impl_->hasReceiver || impl_->hasSnapshotReceiver) {
+        auto receiveCallback = [&param, synced](const ofxOscMessageView& msg) {
             if (msg.getNumArgs() > 0) {
                 T value;
                 if constexpr (std::is_same_v<T, float>) {
@@ -90,13 +202,16 @@ void ofxOscParameterSync::add(ofParameter<T>& param, const std::string& oscAddre
                 } else if constexpr (std::is_same_v<T, bool>) {
                     value = msg.getArgAsBool(0);
                 } else if constexpr (std::is_same_v<T, std::string>) {
-                    value = msg.getArgAsString(0);
+                    value = std::string(msg.getArgAsString(0));
                 }
                 param.set(value);
+                if (synced) {
+                    synced->sentVersion = param.getVersion();  // Not echoed back
+                }
             }
         };
 
-        impl_->receiveCallbacks[oscAddress] = receiveCallback;
+        impl_->router.add(oscAddress, receiveCallback);
     }
 }
 
@@ -134,29 +249,41 @@ void ofxOscParameterSync::add(ofParameterGroup& group, const std::string& oscAdd
 }
 
 void ofxOscParameterSync::update() {
-    if (!impl_->hasReceiver || !impl_->autoReceive) return;
-
-    // Process all pending OSC messages
-    while (impl_->receiver.hasWaitingMessages()) {
-        ofxOscMessage msg;
-        impl_->receiver.getNextMessage(msg);
+    // Send this frame's parameter changes, bundled per packet
+    if (impl_->hasSender) {
+        if (impl_->autoSend) {
+            impl_->sendScheduled();
+        }
+        impl_->sender.flush();
+    }
 
-        std::string address = msg.getAddress();
+    if (!impl_->autoReceive) return;
 
-        // Find and call the appropriate callback
-        auto it = impl_->receiveCallbacks.find(address);
-        if (it != impl_->receiveCallbacks.end()) {
-            it->second(msg);
-        }
+    if (impl_->hasReceiver) {
+        impl_->dispatch(impl_->receiver);
+    }
+    if (impl_->hasSnapshotReceiver) {
+        impl_->dispatch(impl_->snapshotReceiver);
     }
 }
 
 void ofxOscParameterSync::sendAll() {
     if (!impl_->hasSender) return;
 
-    for (auto& [address, sendCallback] : impl_->sendCallbacks) {
-        sendCallback();
-    }
+    impl_->sendAll();
+    impl_->sender.flush();
+}
+
+void ofxOscParameterSync::setDeltaInterval(double seconds) {
+    impl_->deltaInterval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(std::max(seconds, 0.0)));
+    impl_->nextDelta = Clock::now();
+}
+
+void ofxOscParameterSync::setKeyframeInterval(double seconds) {
+    impl_->keyframeInterval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(std::max(seconds, 0.0)));
+    impl_->nextKeyframe = Clock::now() + impl_->keyframeInterval;
 }
 
 void ofxOscParameterSync::setAutoSend(bool autoSend) {
@@ -167,7 +294,11 @@ void ofxOscParameterSync::setAutoReceive(bool autoReceive) {
     impl_->autoReceive = autoReceive;
 }
 
+void ofxOscParameterSync::setCoalesceMessages(bool coalesce) {
+    impl_->coalesce = coalesce;
+}
+
 void ofxOscParameterSync::clear() {
-    impl_->receiveCallbacks.clear();
-    impl_->sendCallbacks.clear();
+    impl_->router.clear();
+    impl_->parameters.clear();
 }
@@ -27,9 +27,20 @@ public:
     /// Setup receiver only (one-way sync)
     void setupReceiver(int receivePort);
 
+    /// Send sendAll() snapshots over TCP instead, so none is lost in part;
+    /// changes made while running still go over UDP. Call before add().
+    /// @param sendHost Host to send snapshots to
+    /// @param tcpPort Port of the other side's setupSnapshotReceiver()
+    void setupSnapshotSender(const std::string& sendHost, int tcpPort);
+
+    /// Accept snapshots over TCP (up to 8192 parameters each), applied in
+    /// update() with the UDP messages. Call before add().
+    void setupSnapshotReceiver(int tcpPort);
+
     /// Add parameter to sync
     /// @param param Parameter to synchronize
-    /// @param oscAddress OSC address (e.g., "/params/volume")
+    /// @param oscAddress OSC address (e.g., "/params/volume"); received
+    /// messages are routed by pattern, so it may contain OSC wildcards
     template<typename T>
     void add(ofParameter<T>& param, const std::string& oscAddress);
 
@@ -39,18 +50,36 @@ public:
     void add(ofParameterGroup& group, const std::string& oscAddressPrefix);
 
     /// Update - call this in your update() loop
-    /// Processes incoming OSC messages and sends outgoing changes
+    /// Processes incoming OSC messages and sends outgoing changes, which
+    /// are queued until then and sent bundled (latest value per address)
     void update();
 
-    /// Send all parameter values immediately
+    /// Send all parameter values immediately, as one bundle over TCP after
+    /// setupSnapshotSender() (requires a sender setup too)
     void sendAll();
 
-    /// Enable/disable automatic sending on parameter change
+    /// Send changes as deltas: every interval seconds, update() sends the
+    /// parameters whose version changed since they were last sent, bundled,
+    /// however often they changed in between (default 0: every change is
+    /// queued as it's made)
+    void setDeltaInterval(double seconds);
+
+    /// Send every parameter every interval seconds from update(), so a
+    /// receiver that joined late or lost a delta catches up (default 0:
+    /// only on sendAll()); over TCP after setupSnapshotSender()
+    void setKeyframeInterval(double seconds);
+
+    /// Enable/disable automatic sending on parameter change (deltas and
+    /// keyframes included)
     void setAutoSend(bool autoSend);
 
     /// Enable/disable automatic receiving
     void setAutoReceive(bool autoReceive);
 
+    /// Apply only the last value received per address in each update()
+    /// (default false: every message is applied in order)
+    void setCoalesceMessages(bool coalesce);
+
     /// Clear all synced parameters
     void clear();
 
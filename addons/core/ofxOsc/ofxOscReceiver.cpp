@@ -1,4 +1,7 @@
 #include "ofxOscReceiver.h"
+#include "ofxOscSlip.h"
+#include "../../../oflike/utils/ofSpscQueue.h"
+#include "../../../oflike/utils/ofNetworkStats.h"
 #include <osc/OscPacketListener.h>
 #include <osc/OscReceivedElements.h>
 #include <ip/UdpSocket.h>
@@ -6,24 +9,124 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <string_view>
+#include <vector>
 
-// Platform-specific networking headers for multicast
+// Platform-specific networking headers for multicast and TCP, which use BSD
+// sockets directly: oscpack's sockets expose neither socket options nor streams
 #if defined(__APPLE__) || defined(__linux__)
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <poll.h>
 #include <unistd.h>
 #include <cstring>
 #endif
 
+namespace {
+
+// Largest datagram, and largest packet on a TCP stream
+constexpr size_t kMaxDatagramSize = 65536;
+constexpr size_t kMaxStreamPacketSize = 16 * 1024 * 1024;
+
+// Pending TCP connections
+constexpr int kListenBacklog = 16;
+
+IpEndpointName toEndpoint(const sockaddr_in& address) {
+    return IpEndpointName(ntohl(address.sin_addr.s_addr), ntohs(address.sin_port));
+}
+
+// Seconds from an NTP time tag to now, by the system clock; negative for a
+// tag in the future
+double secondsSinceTimeTag(osc::uint64 timeTag) {
+    constexpr uint64_t kNtpToUnixSeconds = 2208988800ull;
+    const auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch);
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch - seconds);
+    const uint64_t now = ((static_cast<uint64_t>(seconds.count()) + kNtpToUnixSeconds) << 32) |
+                         ((static_cast<uint64_t>(micros.count()) << 32) / 1000000);
+    return static_cast<double>(static_cast<int64_t>(now - timeTag)) / 4294967296.0;
+}
+
+} // namespace
+
+// A message decoded in place for message view mode: address, strings and
+// blobs live in storage, which never reallocates after setup
+struct OscMessageSlot {
+    std::vector<char> storage;
+    std::vector<ofxOscArgView> args;
+    std::string_view address;
+    size_t numArgs = 0;
+    uint64_t receivedAt = 0;    // ofNetworkCounters::timestamp()
+};
+
+// A message in the copying queue
+struct OscQueuedMessage {
+    ofxOscMessage message;
+    uint64_t receivedAt = 0;
+};
+
 // Internal packet listener that converts oscpack messages to ofxOscMessage
 class OscListener : public osc::OscPacketListener {
 public:
-    std::queue<ofxOscMessage> messageQueue;
+    std::queue<OscQueuedMessage> messageQueue;
     std::mutex queueMutex;
 
+    // Message view mode: listener thread to the polling thread
+    bool useViews = false;
+    oflike::ofSpscQueue<OscMessageSlot> viewQueue;
+
+    // Packets in, messages queued, view mode drops; transit from the time
+    // tags of bundles that carry one
+    oflike::ofNetworkCounters counters;
+
+    void allocateViews(size_t maxMessages, size_t maxMessageSize, size_t maxArgs) {
+        useViews = true;
+        viewQueue.allocate(std::max<size_t>(maxMessages, 1));
+        for (size_t i = 0; i < viewQueue.capacity(); i++) {
+            viewQueue.slot(i).storage.resize(maxMessageSize);
+            viewQueue.slot(i).args.resize(maxArgs);
+        }
+    }
+
+    // Polling thread: count a message as dequeued
+    void dequeued(uint64_t receivedAt) {
+        counters.addQueueDepth(-1);
+        counters.addLatencySince(receivedAt);
+    }
+
+    void ProcessPacket(const char* data, int size, const IpEndpointName& remoteEndpoint) override {
+        packetReceivedAt_ = oflike::ofNetworkCounters::timestamp();
+        counters.addIn(static_cast<size_t>(std::max(size, 0)));
+        try {
+            const osc::ReceivedPacket packet(data, size);
+            if (packet.IsBundle()) {
+                const osc::uint64 timeTag = osc::ReceivedBundle(packet).TimeTag();
+                const double transit = timeTag != 1 ? secondsSinceTimeTag(timeTag) : -1.0;
+                // Past an hour it's a clock far off, not a transit time
+                if (transit >= 0.0 && transit < 3600.0) {
+                    counters.addTransit(transit);
+                }
+            }
+        } catch (const osc::Exception&) {
+            // Malformed: left to the parse below
+        }
+        osc::OscPacketListener::ProcessPacket(data, size, remoteEndpoint);
+    }
+
 protected:
     void ProcessMessage(const osc::ReceivedMessage& m, const IpEndpointName& /*remoteEndpoint*/) override {
+        if (useViews) {
+            if (!decodeView(m)) {
+                counters.addDrops();
+            }
+            return;
+        }
+
         ofxOscMessage msg;
         msg.setAddress(m.AddressPattern());
 
@@ -78,12 +181,134 @@ protected:
 
             // Add to queue
             std::lock_guard<std::mutex> lock(queueMutex);
-            messageQueue.push(msg);
+            messageQueue.push({std::move(msg), packetReceivedAt_});
+            counters.addQueueDepth(1);
 
         } catch (const osc::Exception& e) {
             // Silently ignore malformed messages
         }
     }
+
+private:
+    // Decode into the next free slot; false if none is free or it doesn't fit
+    bool decodeView(const osc::ReceivedMessage& m) {
+        OscMessageSlot* slot = viewQueue.beginWrite();
+        if (!slot) {
+            return false;
+        }
+
+        size_t used = 0;
+        auto store = [&](const void* data, size_t size) -> const char* {
+            if (size > slot->storage.size() - used) {
+                return nullptr;
+            }
+            char* destination = slot->storage.data() + used;
+            std::memcpy(destination, data, size);
+            used += size;
+            return destination;
+        };
+
+        const char* addressPattern = m.AddressPattern();
+        const size_t addressLength = std::strlen(addressPattern);
+        const char* address = store(addressPattern, addressLength);
+        if (!address) {
+            return false;
+        }
+        slot->address = std::string_view(address, addressLength);
+
+        size_t numArgs = 0;
+        try {
+            for (osc::ReceivedMessage::const_iterator arg = m.ArgumentsBegin();
+                 arg != m.ArgumentsEnd(); ++arg) {
+                if (numArgs == slot->args.size()) {
+                    return false;
+                }
+                ofxOscArgView& view = slot->args[numArgs];
+                view.asString = std::string_view();
+                view.blobData = nullptr;
+                view.blobSize = 0;
+
+                if (arg->IsInt32()) {
+                    view.type = ofxOscMessage::OFX_OSC_TYPE_INT32;
+                    view.asInt32 = arg->AsInt32();
+                }
+                else if (arg->IsInt64()) {
+                    view.type = ofxOscMessage::OFX_OSC_TYPE_INT64;
+                    view.asInt64 = arg->AsInt64();
+                }
+                else if (arg->IsFloat()) {
+                    view.type = ofxOscMessage::OFX_OSC_TYPE_FLOAT;
+                    view.asFloat = arg->AsFloat();
+                }
+                else if (arg->IsDouble()) {
+                    view.type = ofxOscMessage::OFX_OSC_TYPE_DOUBLE;
+                    view.asDouble = arg->AsDouble();
+                }
+                else if (arg->IsString()) {
+                    const char* value = arg->AsString();
+                    const size_t length = std::strlen(value);
+                    const char* copy = store(value, length);
+                    if (!copy) {
+                        return false;
+                    }
+                    view.type = ofxOscMessage::OFX_OSC_TYPE_STRING;
+                    view.asString = std::string_view(copy, length);
+                }
+                else if (arg->IsBlob()) {
+                    const void* blobData;
+                    osc::osc_bundle_element_size_t blobSize;
+                    arg->AsBlob(blobData, blobSize);
+                    const char* copy = store(blobData, static_cast<size_t>(blobSize));
+                    if (!copy && blobSize > 0) {
+                        return false;
+                    }
+                    view.type = ofxOscMessage::OFX_OSC_TYPE_BLOB;
+                    view.blobData = reinterpret_cast<const uint8_t*>(copy);
+                    view.blobSize = static_cast<size_t>(blobSize);
+                }
+                else if (arg->IsChar()) {
+                    view.type = ofxOscMessage::OFX_OSC_TYPE_CHAR;
+                    view.asChar = arg->AsChar();
+                }
+                else if (arg->IsBool()) {
+                    view.asBool = arg->AsBool();
+                    view.type = view.asBool ? ofxOscMessage::OFX_OSC_TYPE_TRUE : ofxOscMessage::OFX_OSC_TYPE_FALSE;
+                }
+                else if (arg->IsNil()) {
+                    view.type = ofxOscMessage::OFX_OSC_TYPE_NONE;
+                }
+                else if (arg->IsInfinitum()) {
+                    view.type = ofxOscMessage::OFX_OSC_TYPE_TRIGGER;
+                }
+                else if (arg->IsTimeTag()) {
+                    view.type = ofxOscMessage::OFX_OSC_TYPE_TIMETAG;
+                    view.asTimeTag = arg->AsTimeTag();
+                }
+                else if (arg->IsRgbaColor()) {
+                    view.type = ofxOscMessage::OFX_OSC_TYPE_RGBA_COLOR;
+                    view.asRgbaColor = arg->AsRgbaColor();
+                }
+                else if (arg->IsMidiMessage()) {
+                    view.type = ofxOscMessage::OFX_OSC_TYPE_MIDI_MESSAGE;
+                    view.asMidiMessage = arg->AsMidiMessage();
+                }
+                else {
+                    continue;  // Skipped, as in the copying path
+                }
+                numArgs++;
+            }
+        } catch (const osc::Exception& e) {
+            return true;  // Malformed: ignored, not dropped for lack of room
+        }
+
+        slot->numArgs = numArgs;
+        slot->receivedAt = packetReceivedAt_;
+        viewQueue.commitWrite();
+        counters.addQueueDepth(1);
+        return true;
+    }
+
+    uint64_t packetReceivedAt_ = 0;    // Listener thread only
 };
 
 // Implementation using pImpl pattern to hide oscpack types from public header
@@ -108,7 +333,7 @@ public:
             port_ = port;
 
             // Create listener
-            listener_ = new OscListener();
+            listener_ = createListener();
 
             // Create socket bound to the specified port
             socket_ = new UdpListeningReceiveSocket(
@@ -116,6 +341,7 @@ public:
                 listener_
             );
 
+            listener_->counters.show("OSC :" + std::to_string(port));
             isSetup_ = true;
             return true;
         } catch (const std::exception& e) {
@@ -132,23 +358,35 @@ public:
             multicastGroup_ = multicastGroup;
 
             // Create listener
-            listener_ = new OscListener();
-
-            // For multicast, bind to the multicast address directly
-            // oscpack's UdpSocket will handle the socket creation
-            IpEndpointName endpoint(multicastGroup.c_str(), port);
-            socket_ = new UdpListeningReceiveSocket(endpoint, listener_);
-
-            // Note: oscpack doesn't provide direct multicast group joining API
-            // For full multicast support, applications should:
-            // 1. Use standard UDP receiver on the multicast port
-            // 2. Configure network layer to join multicast group externally
-            // 3. Or use platform-specific socket options before binding
-            //
-            // This implementation provides basic multicast reception by binding
-            // to the multicast address. For production use, consider extending
-            // oscpack or using a custom UdpSocket implementation with IP_ADD_MEMBERSHIP.
+            listener_ = createListener();
 
+            ip_mreq membership{};
+            if (inet_pton(AF_INET, multicastGroup.c_str(), &membership.imr_multiaddr) != 1 ||
+                !IN_MULTICAST(ntohl(membership.imr_multiaddr.s_addr))) {
+                shutdown();
+                return false;
+            }
+            membership.imr_interface.s_addr = htonl(INADDR_ANY);
+
+            // Bound to the port on any address, shared with other receivers
+            // of the group on this machine, then joined to the group
+            fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+            const int one = 1;
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(static_cast<uint16_t>(port));
+            address.sin_addr.s_addr = htonl(INADDR_ANY);
+            if (fd_ < 0 ||
+                setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0 ||
+                setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0 ||
+                ::bind(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+                setsockopt(fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0) {
+                shutdown();
+                return false;
+            }
+
+            transport_ = Transport::Multicast;
+            listener_->counters.show("OSC " + multicastGroup + ":" + std::to_string(port));
             isSetup_ = true;
             return true;
         } catch (const std::exception& e) {
@@ -157,8 +395,48 @@ public:
         }
     }
 
+    bool setupTcp(int port) {
+        shutdown();
+
+        port_ = port;
+        listener_ = createListener();
+
+        fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        const int one = 1;
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (fd_ < 0 ||
+            setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0 ||
+            ::bind(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(fd_, kListenBacklog) != 0) {
+            shutdown();
+            return false;
+        }
+
+        transport_ = Transport::Tcp;
+        listener_->counters.show("OSC TCP :" + std::to_string(port));
+        isSetup_ = true;
+        return true;
+    }
+
     void start() {
-        if (!isSetup_ || isListening_ || !socket_) {
+        if (!isSetup_ || isListening_) {
+            return;
+        }
+
+        if (!socket_) {
+            // Multicast or TCP: poll the socket, woken by the pipe to stop
+            if (::pipe(wakePipe_) != 0) {
+                return;
+            }
+            isListening_ = true;
+            shouldStop_ = false;
+            listenerThread_ = std::thread([this]() {
+                runSocketLoop();
+                isListening_ = false;
+            });
             return;
         }
 
@@ -182,20 +460,28 @@ public:
     }
 
     void stop() {
-        if (!isListening_ || !socket_) {
+        if (!listenerThread_.joinable()) {
             return;
         }
 
         shouldStop_ = true;
 
         // Break the socket's receive loop
-        socket_->AsynchronousBreak();
+        if (socket_) {
+            socket_->AsynchronousBreak();
+        } else {
+            const char wake = 0;
+            (void)::write(wakePipe_[1], &wake, 1);
+        }
 
         // Wait for thread to finish
-        if (listenerThread_.joinable()) {
-            listenerThread_.join();
-        }
+        listenerThread_.join();
 
+        if (wakePipe_[0] >= 0) {
+            ::close(wakePipe_[0]);
+            ::close(wakePipe_[1]);
+            wakePipe_[0] = wakePipe_[1] = -1;
+        }
         isListening_ = false;
     }
 
@@ -206,14 +492,26 @@ public:
             delete socket_;
             socket_ = nullptr;
         }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+        for (TcpClient& client : tcpClients_) {
+            ::close(client.fd);
+        }
+        tcpClients_.clear();
+        numTcpClients_ = 0;
+        transport_ = Transport::Udp;
 
         if (listener_) {
-            std::lock_guard<std::mutex> lock(listener_->queueMutex);
-            // Clear the queue
-            while (!listener_->messageQueue.empty()) {
-                listener_->messageQueue.pop();
+            {
+                std::lock_guard<std::mutex> lock(listener_->queueMutex);
+                // Clear the queue
+                while (!listener_->messageQueue.empty()) {
+                    listener_->messageQueue.pop();
+                }
             }
-            delete listener_;
+            delete listener_;  // Its counters leave the debug overlay
             listener_ = nullptr;
         }
 
@@ -222,6 +520,9 @@ public:
 
     bool hasWaitingMessages() const {
         if (!listener_) return false;
+        if (listener_->useViews) {
+            return !listener_->viewQueue.empty();
+        }
         std::lock_guard<std::mutex> lock(listener_->queueMutex);
         return !listener_->messageQueue.empty();
     }
@@ -229,27 +530,188 @@ public:
     bool getNextMessage(ofxOscMessage& message) {
         if (!listener_) return false;
 
+        if (listener_->useViews) {
+            ofxOscMessageView view;
+            if (!getNextMessage(view)) {
+                return false;
+            }
+            view.copyTo(message);
+            listener_->viewQueue.release();
+            return true;
+        }
+
         std::lock_guard<std::mutex> lock(listener_->queueMutex);
         if (listener_->messageQueue.empty()) {
             return false;
         }
 
-        message = listener_->messageQueue.front();
+        OscQueuedMessage& queued = listener_->messageQueue.front();
+        message = std::move(queued.message);
+        listener_->dequeued(queued.receivedAt);
         listener_->messageQueue.pop();
         return true;
     }
 
+    bool getNextMessage(ofxOscMessageView& message) {
+        if (!listener_ || !listener_->useViews) return false;
+
+        listener_->viewQueue.release();
+        const OscMessageSlot* slot = listener_->viewQueue.read();
+        if (!slot) {
+            return false;
+        }
+        message = ofxOscMessageView(slot->address, slot->args.data(), slot->numArgs);
+        listener_->dequeued(slot->receivedAt);
+        return true;
+    }
+
+    size_t getNextMessages(ofxOscMessageView* messages, size_t maxCount) {
+        if (!listener_ || !listener_->useViews) return 0;
+
+        listener_->viewQueue.release();
+        size_t count = 0;
+        while (count < maxCount) {
+            const OscMessageSlot* slot = listener_->viewQueue.read();
+            if (!slot) {
+                break;
+            }
+            messages[count++] = ofxOscMessageView(slot->address, slot->args.data(), slot->numArgs);
+            listener_->dequeued(slot->receivedAt);
+        }
+        return count;
+    }
+
     size_t getNumWaitingMessages() const {
         if (!listener_) return 0;
+        if (listener_->useViews) {
+            return listener_->viewQueue.size();
+        }
         std::lock_guard<std::mutex> lock(listener_->queueMutex);
         return listener_->messageQueue.size();
     }
 
+    void enableMessageViews(size_t maxMessages, size_t maxMessageSize, size_t maxArgs) {
+        useViews_ = true;
+        maxViewMessages_ = maxMessages;
+        maxViewMessageSize_ = maxMessageSize;
+        maxViewArgs_ = maxArgs;
+    }
+
+    void disableMessageViews() { useViews_ = false; }
+    bool isUsingMessageViews() const { return useViews_; }
+
+    uint64_t getDroppedCount() const {
+        return listener_ ? listener_->counters.getDrops() : 0;
+    }
+
+    oflike::ofNetworkStats getStats() const {
+        return listener_ ? listener_->counters.getStats() : oflike::ofNetworkStats();
+    }
+
+    void resetStats() {
+        if (listener_) {
+            listener_->counters.reset();
+        }
+    }
+
     bool isSetup() const { return isSetup_; }
     bool isListening() const { return isListening_; }
     int getPort() const { return port_; }
+    size_t getNumTcpClients() const { return numTcpClients_.load(std::memory_order_relaxed); }
 
 private:
+    enum class Transport { Udp, Multicast, Tcp };
+
+    // A connected TCP sender and the packet it is part way through
+    struct TcpClient {
+        int fd;
+        IpEndpointName endpoint;
+        ofxOscSlipDecoder decoder;
+    };
+
+    // Listener thread for multicast and TCP: hand each datagram, or each
+    // packet framed on a TCP stream, to the listener
+    void runSocketLoop() {
+        std::vector<char> buffer(kMaxDatagramSize);
+        std::vector<pollfd> fds;
+        while (!shouldStop_) {
+            fds.clear();
+            fds.push_back({wakePipe_[0], POLLIN, 0});
+            fds.push_back({fd_, POLLIN, 0});
+            for (const TcpClient& client : tcpClients_) {
+                fds.push_back({client.fd, POLLIN, 0});
+            }
+            if (::poll(fds.data(), static_cast<nfds_t>(fds.size()), -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            if (fds[0].revents) {
+                break;
+            }
+
+            if (fds[1].revents & POLLIN) {
+                sockaddr_in from{};
+                socklen_t length = sizeof(from);
+                if (transport_ == Transport::Multicast) {
+                    const ssize_t size = ::recvfrom(fd_, buffer.data(), buffer.size(), 0,
+                                                    reinterpret_cast<sockaddr*>(&from), &length);
+                    if (size > 0) {
+                        processPacket(buffer.data(), static_cast<size_t>(size), toEndpoint(from));
+                    }
+                } else {
+                    const int client = ::accept(fd_, reinterpret_cast<sockaddr*>(&from), &length);
+                    if (client >= 0) {
+#ifdef SO_NOSIGPIPE
+                        const int one = 1;
+                        setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+                        tcpClients_.push_back({client, toEndpoint(from), ofxOscSlipDecoder(kMaxStreamPacketSize)});
+                    }
+                }
+            }
+
+            // Clients accepted above have no entry in fds yet
+            const size_t numPolled = fds.size() - 2;
+            for (size_t i = 0; i < numPolled; i++) {
+                if (!(fds[i + 2].revents & (POLLIN | POLLHUP | POLLERR))) {
+                    continue;
+                }
+                TcpClient& client = tcpClients_[i];
+                const ssize_t size = ::read(client.fd, buffer.data(), buffer.size());
+                if (size <= 0) {
+                    ::close(client.fd);
+                    client.fd = -1;
+                    continue;
+                }
+                client.decoder.feed(buffer.data(), static_cast<size_t>(size), [&](const char* data, size_t bytes) {
+                    processPacket(data, bytes, client.endpoint);
+                });
+            }
+            tcpClients_.erase(std::remove_if(tcpClients_.begin(), tcpClients_.end(),
+                                             [](const TcpClient& client) { return client.fd < 0; }),
+                              tcpClients_.end());
+            numTcpClients_.store(tcpClients_.size(), std::memory_order_relaxed);
+        }
+    }
+
+    void processPacket(const char* data, size_t size, const IpEndpointName& endpoint) {
+        try {
+            listener_->ProcessPacket(data, static_cast<int>(size), endpoint);
+        } catch (const osc::Exception& e) {
+            // Silently ignore malformed packets
+        }
+    }
+
+    OscListener* createListener() const {
+        OscListener* listener = new OscListener();
+        if (useViews_) {
+            listener->allocateViews(maxViewMessages_, maxViewMessageSize_, maxViewArgs_);
+        }
+        return listener;
+    }
+
     UdpListeningReceiveSocket* socket_;
     OscListener* listener_;
     std::thread listenerThread_;
@@ -258,6 +720,15 @@ private:
     bool isListening_;
     int port_;
     std::string multicastGroup_;
+    Transport transport_ = Transport::Udp;
+    int fd_ = -1;
+    int wakePipe_[2] = {-1, -1};
+    std::vector<TcpClient> tcpClients_;     // Listener thread only
+    std::atomic<size_t> numTcpClients_{0};
+    bool useViews_ = false;
+    size_t maxViewMessages_ = 1024;
+    size_t maxViewMessageSize_ = 1024;
+    size_t maxViewArgs_ = 32;
 };
 
 // Public API implementation
@@ -280,6 +751,14 @@ bool ofxOscReceiver::setupMulticast(const std::string& multicastGroup, int port)
     return impl_->setupMulticast(multicastGroup, port);
 }
 
+bool ofxOscReceiver::setupTcp(int port) {
+    return impl_->setupTcp(port);
+}
+
+size_t ofxOscReceiver::getNumTcpClients() const {
+    return impl_->getNumTcpClients();
+}
+
 int ofxOscReceiver::getPort() const {
     return impl_->getPort();
 }
@@ -304,6 +783,38 @@ bool ofxOscReceiver::getNextMessage(ofxOscMessage& message) {
     return impl_->getNextMessage(message);
 }
 
+bool ofxOscReceiver::getNextMessage(ofxOscMessageView& message) {
+    return impl_->getNextMessage(message);
+}
+
+size_t ofxOscReceiver::getNextMessages(ofxOscMessageView* messages, size_t maxCount) {
+    return impl_->getNextMessages(messages, maxCount);
+}
+
+uint64_t ofxOscReceiver::getDroppedCount() const {
+    return impl_->getDroppedCount();
+}
+
+oflike::ofNetworkStats ofxOscReceiver::getStats() const {
+    return impl_->getStats();
+}
+
+void ofxOscReceiver::resetStats() {
+    impl_->resetStats();
+}
+
+void ofxOscReceiver::enableMessageViews(size_t maxMessages, size_t maxMessageSize, size_t maxArgs) {
+    impl_->enableMessageViews(maxMessages, maxMessageSize, maxArgs);
+}
+
+void ofxOscReceiver::disableMessageViews() {
+    impl_->disableMessageViews();
+}
+
+bool ofxOscReceiver::isUsingMessageViews() const {
+    return impl_->isUsingMessageViews();
+}
+
 size_t ofxOscReceiver::getNumWaitingMessages() const {
     return impl_->getNumWaitingMessages();
 }
@@ -1,14 +1,20 @@
 #pragma once
 
 #include "ofxOscMessage.h"
+#include "ofxOscMessageView.h"
+#include "../../../oflike/utils/ofNetworkStats.h"
+#include <cstdint>
 #include <memory>
 
-/// \brief Receives OSC messages and bundles over UDP.
+/// \brief Receives OSC messages and bundles over UDP, UDP multicast or TCP.
 ///
 /// ofxOscReceiver allows you to receive OSC messages from a remote host.
 /// You can either poll for messages using hasWaitingMessages()/getNextMessage()
 /// or run a blocking listener thread.
 ///
+/// Over TCP, any number of ofxOscSender::setupTcp() senders may connect;
+/// packets are SLIP-framed as OSC 1.1 specifies for streams.
+///
 /// Example usage (polling):
 /// \code
 /// ofxOscReceiver receiver;
@@ -34,6 +40,20 @@
 /// // Messages are queued automatically
 /// // Call stop() to stop the thread
 /// \endcode
+///
+/// Example usage (message views, no allocation per message):
+/// \code
+/// receiver.enableMessageViews();
+/// receiver.setup(12345);
+/// receiver.start();
+///
+/// void update() {
+///     ofxOscMessageView msg;
+///     while (receiver.getNextMessage(msg)) {
+///         // msg is valid until the next getNextMessage() call
+///     }
+/// }
+/// \endcode
 class ofxOscReceiver {
 public:
     ofxOscReceiver();
@@ -50,17 +70,45 @@ public:
     bool setup(int port);
 
     /// \brief Set up the receiver to listen on a multicast group
-    /// \param multicastGroup Multicast group address (e.g., "224.0.0.1")
+    /// \details Joins the group on the default interface. Other receivers on
+    /// this machine may join the same group and port.
+    /// \param multicastGroup IPv4 multicast group address (e.g., "239.0.0.1")
     /// \param port Port number to listen on (1-65535)
     /// \return true on success, false on failure
     bool setupMulticast(const std::string& multicastGroup, int port);
 
+    /// \brief Set up the receiver to accept TCP connections on a port
+    /// \param port Port number to listen on (1-65535)
+    /// \return true on success, false on failure
+    bool setupTcp(int port);
+
+    /// \brief Get the number of connected TCP senders
+    size_t getNumTcpClients() const;
+
     /// \brief Check if the receiver is set up and ready
     bool isSetup() const;
 
     /// \brief Get the port number we're listening on
     int getPort() const;
 
+    /// \brief Decode messages into a preallocated lock-free queue
+    /// \details The listener thread decodes each message into a queue slot:
+    /// its address, strings and blobs are copied into the slot's storage and
+    /// nothing is allocated per message. Read them with
+    /// getNextMessage(ofxOscMessageView&) from one thread; getNextMessage
+    /// (ofxOscMessage&) still works and copies. Messages that find the queue
+    /// full, or don't fit a slot, are dropped. Takes effect at the next setup().
+    /// \param maxMessages Messages the queue holds (rounded up to a power of two)
+    /// \param maxMessageSize Bytes of address, strings and blobs per message
+    /// \param maxArgs Arguments per message
+    void enableMessageViews(size_t maxMessages = 1024, size_t maxMessageSize = 1024, size_t maxArgs = 32);
+
+    /// \brief Go back to the default copying queue at the next setup()
+    void disableMessageViews();
+
+    /// \brief Check if message view mode is enabled
+    bool isUsingMessageViews() const;
+
     // Listener thread control
     /// \brief Start the listener thread (blocking in background thread)
     /// Messages are automatically queued and can be retrieved with getNextMessage()
@@ -81,9 +129,37 @@ public:
     /// \return true if a message was retrieved, false if queue was empty
     bool getNextMessage(ofxOscMessage& message);
 
+    /// \brief Get the next message without copying it (message view mode)
+    /// \details Frees the slot of the message returned by the previous call.
+    /// \param message Receives a view valid until the next getNextMessage() call
+    /// \return true if a message was retrieved, false if the queue was empty
+    /// or message views are not enabled
+    bool getNextMessage(ofxOscMessageView& message);
+
+    /// \brief Get a batch of queued messages without copying them (message view mode)
+    /// \details Frees the slots of the messages returned by the previous call.
+    /// \param messages Array to fill; the views stay valid until the next
+    /// getNextMessage() or getNextMessages() call
+    /// \param maxCount Maximum number of messages to return
+    /// \return Number of messages returned, 0 if none or message views are not enabled
+    size_t getNextMessages(ofxOscMessageView* messages, size_t maxCount);
+
+    /// \brief Get the number of messages dropped in message view mode
+    uint64_t getDroppedCount() const;
+
     /// \brief Get the number of messages waiting in the queue
     size_t getNumWaitingMessages() const;
 
+    /// \brief Get the traffic counters
+    /// \details Counted since setup: packets in, the message queue's depth
+    /// and how long messages waited in it, drops (message view mode), and
+    /// the transit time of bundles from their time tags, when sender and
+    /// receiver clocks agree. Shown in the debug overlay while set up.
+    oflike::ofNetworkStats getStats() const;
+
+    /// \brief Zero the traffic counters
+    void resetStats();
+
     // Shutdown
     /// \brief Stop listening and clean up
     void shutdown();
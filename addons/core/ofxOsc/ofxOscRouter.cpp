@@ -0,0 +1,238 @@
+#include "ofxOscRouter.h"
+#include <algorithm>
+
+namespace {
+
+bool hasWildcard(std::string_view part) {
+    return part.find_first_of("*?[]{}") != std::string_view::npos;
+}
+
+// Next address or pattern part after the '/' at pos; pos moves to the
+// following '/', or to the end after the last part
+std::string_view nextPart(std::string_view address, size_t& pos) {
+    const size_t start = pos + 1;
+    size_t end = address.find('/', start);
+    if (end == std::string_view::npos) {
+        end = address.size();
+    }
+    pos = end;
+    return address.substr(start, end - start);
+}
+
+} // namespace
+
+ofxOscRouter::ofxOscRouter()
+    : nodes_(1) {
+}
+
+ofxOscRouter::~ofxOscRouter() {
+}
+
+bool ofxOscRouter::add(const std::string& pattern, Handler handler) {
+    if (pattern.empty() || pattern[0] != '/') {
+        return false;
+    }
+
+    uint32_t node = 0;
+    size_t pos = 0;
+    const std::string_view view(pattern);
+    while (pos < view.size()) {
+        const std::string_view part = nextPart(view, pos);
+        const bool wildcard = hasWildcard(part);
+        std::vector<Edge>& edges = wildcard ? nodes_[node].wildcards : nodes_[node].literals;
+
+        auto it = wildcard
+            ? std::find_if(edges.begin(), edges.end(), [&](const Edge& edge) { return edge.part == part; })
+            : std::lower_bound(edges.begin(), edges.end(), part,
+                               [](const Edge& edge, std::string_view key) { return edge.part < key; });
+        if (it != edges.end() && it->part == part) {
+            node = it->node;
+            continue;
+        }
+        const uint32_t child = static_cast<uint32_t>(nodes_.size());
+        edges.insert(it, Edge{std::string(part), child});
+        nodes_.emplace_back();  // Invalidates edges
+        node = child;
+    }
+
+    nodes_[node].handlers.push_back(static_cast<uint32_t>(handlers_.size()));
+    handlers_.push_back(std::move(handler));
+    return true;
+}
+
+void ofxOscRouter::clear() {
+    nodes_.assign(1, Node());
+    handlers_.clear();
+}
+
+template<typename Visitor>
+void ofxOscRouter::visit(uint32_t node, std::string_view address, size_t pos, Visitor& visitor) const {
+    const Node& current = nodes_[node];
+    if (pos >= address.size()) {
+        visitor(current);
+        return;
+    }
+
+    const std::string_view part = nextPart(address, pos);
+
+    auto it = std::lower_bound(current.literals.begin(), current.literals.end(), part,
+                               [](const Edge& edge, std::string_view key) { return edge.part < key; });
+    if (it != current.literals.end() && it->part == part) {
+        visit(it->node, address, pos, visitor);
+    }
+    for (const Edge& edge : current.wildcards) {
+        if (matchPart(edge.part, part)) {
+            visit(edge.node, address, pos, visitor);
+        }
+    }
+}
+
+bool ofxOscRouter::matches(std::string_view address) const {
+    if (address.empty() || address[0] != '/') {
+        return false;
+    }
+    bool found = false;
+    auto visitor = [&found](const Node& node) {
+        found = found || !node.handlers.empty();
+    };
+    visit(0, address, 0, visitor);
+    return found;
+}
+
+size_t ofxOscRouter::dispatch(const ofxOscMessageView& message) const {
+    const std::string_view address = message.getAddress();
+    if (address.empty() || address[0] != '/') {
+        return 0;
+    }
+    size_t called = 0;
+    auto visitor = [&](const Node& node) {
+        for (uint32_t handler : node.handlers) {
+            handlers_[handler](message);
+            called++;
+        }
+    };
+    visit(0, address, 0, visitor);
+    return called;
+}
+
+size_t ofxOscRouter::dispatch(const ofxOscMessageView* messages, size_t count, bool coalesce) {
+    size_t called = 0;
+    if (!coalesce) {
+        for (size_t i = 0; i < count; i++) {
+            called += dispatch(messages[i]);
+        }
+        return called;
+    }
+
+    // Mark each address's last message, newest first, in an open-addressing
+    // set of the addresses seen; then dispatch the marked ones in order
+    size_t tableSize = 16;
+    while (tableSize < count * 2) {
+        tableSize <<= 1;
+    }
+    seen_.assign(tableSize, std::string_view());
+    latest_.assign(count, 0);
+
+    const std::hash<std::string_view> hash;
+    for (size_t i = count; i-- > 0;) {
+        const std::string_view address = messages[i].getAddress();
+        size_t slot = hash(address) & (tableSize - 1);
+        while (seen_[slot].data() && seen_[slot] != address) {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+        if (!seen_[slot].data()) {
+            seen_[slot] = address.data() ? address : std::string_view("", 0);
+            latest_[i] = 1;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (latest_[i]) {
+            called += dispatch(messages[i]);
+        }
+    }
+    return called;
+}
+
+bool ofxOscRouter::matchPart(std::string_view pattern, std::string_view part) {
+    while (!pattern.empty()) {
+        switch (pattern[0]) {
+            case '*': {
+                while (!pattern.empty() && pattern[0] == '*') {
+                    pattern.remove_prefix(1);
+                }
+                if (pattern.empty()) {
+                    return true;
+                }
+                for (size_t i = 0; i <= part.size(); i++) {
+                    if (matchPart(pattern, part.substr(i))) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+            case '?': {
+                if (part.empty()) {
+                    return false;
+                }
+                break;
+            }
+            case '[': {
+                const size_t close = pattern.find(']', 1);
+                if (close == std::string_view::npos || part.empty()) {
+                    return false;
+                }
+                std::string_view set = pattern.substr(1, close - 1);
+                const bool negate = !set.empty() && set[0] == '!';
+                if (negate) {
+                    set.remove_prefix(1);
+                }
+                const char c = part[0];
+                bool listed = false;
+                for (size_t i = 0; i < set.size() && !listed; i++) {
+                    if (i + 2 < set.size() && set[i + 1] == '-') {
+                        listed = c >= set[i] && c <= set[i + 2];
+                        i += 2;
+                    } else {
+                        listed = c == set[i];
+                    }
+                }
+                if (listed == negate) {
+                    return false;
+                }
+                pattern.remove_prefix(close + 1);
+                part.remove_prefix(1);
+                continue;
+            }
+            case '{': {
+                const size_t close = pattern.find('}', 1);
+                if (close == std::string_view::npos) {
+                    return false;
+                }
+                std::string_view options = pattern.substr(1, close - 1);
+                const std::string_view rest = pattern.substr(close + 1);
+                for (;;) {
+                    const size_t comma = options.find(',');
+                    const std::string_view option = options.substr(0, comma);
+                    if (part.substr(0, option.size()) == option &&
+                        matchPart(rest, part.substr(option.size()))) {
+                        return true;
+                    }
+                    if (comma == std::string_view::npos) {
+                        return false;
+                    }
+                    options.remove_prefix(comma + 1);
+                }
+            }
+            default: {
+                if (part.empty() || part[0] != pattern[0]) {
+                    return false;
+                }
+                break;
+            }
+        }
+        pattern.remove_prefix(1);
+        part.remove_prefix(1);
+    }
+    return part.empty();
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "ofxOscMessageView.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// \brief Dispatches OSC messages to handlers registered by address pattern.
+///
+/// Patterns are split at '/' and compiled into a trie when added. A part
+/// is either matched literally (binary search among its siblings) or, if
+/// it contains OSC wildcards, against the address part:
+/// - `?` matches one character, `*` any run of characters
+/// - `[abc]`, `[a-z]` match one listed character; `[!abc]` one not listed
+/// - `{foo,bar}` matches one of the listed strings
+///
+/// Dispatching walks the trie with string_views into the message's address
+/// and allocates nothing. Every handler whose pattern matches is called.
+///
+/// Example usage:
+/// \code
+/// ofxOscRouter router;
+/// router.add("/fader/[1-8]", [](const ofxOscMessageView& msg) { ... });
+/// router.add("/{play,stop}", [](const ofxOscMessageView& msg) { ... });
+///
+/// ofxOscMessageView batch[256];
+/// size_t count = receiver.getNextMessages(batch, 256);
+/// router.dispatch(batch, count, true);  // Last value per address wins
+/// \endcode
+class ofxOscRouter {
+public:
+    using Handler = std::function<void(const ofxOscMessageView& message)>;
+
+    ofxOscRouter();
+    ~ofxOscRouter();
+
+    // Routes
+    /// \brief Register a handler for an address pattern (e.g. "/synth/*/freq")
+    /// \return false if the pattern doesn't start with '/'
+    bool add(const std::string& pattern, Handler handler);
+
+    /// \brief Remove every handler
+    void clear();
+
+    /// \brief Get the number of registered handlers
+    size_t size() const { return handlers_.size(); }
+
+    /// \brief Check if any registered pattern matches an address
+    bool matches(std::string_view address) const;
+
+    // Dispatch
+    /// \brief Call the handlers matching the message's address
+    /// \return Number of handlers called
+    size_t dispatch(const ofxOscMessageView& message) const;
+
+    /// \brief Dispatch a batch of messages in order
+    /// \param coalesce Only dispatch the last message of each address in the
+    /// batch; earlier values of the same address are skipped
+    /// \return Number of handlers called
+    size_t dispatch(const ofxOscMessageView* messages, size_t count, bool coalesce);
+
+    // Matching
+    /// \brief Match one address part (no '/') against one pattern part
+    static bool matchPart(std::string_view pattern, std::string_view part);
+
+private:
+    struct Edge {
+        std::string part;
+        uint32_t node = 0;
+    };
+
+    struct Node {
+        std::vector<Edge> literals;   // Sorted by part
+        std::vector<Edge> wildcards;  // In registration order
+        std::vector<uint32_t> handlers;
+    };
+
+    template<typename Visitor>
+    void visit(uint32_t node, std::string_view address, size_t pos, Visitor& visitor) const;
+
+    std::vector<Node> nodes_;
+    std::vector<Handler> handlers_;
+
+    // Coalescing scratch space, grown and reused across batches
+    std::vector<std::string_view> seen_;
+    std::vector<uint8_t> latest_;
+};
@@ -1,7 +1,151 @@
 #include "ofxOscSender.h"
+#include "ofxOscSlip.h"
 #include <osc/OscOutboundPacketStream.h>
 #include <ip/UdpSocket.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Multicast and TCP use BSD sockets directly: oscpack's sockets expose
+// neither socket options nor streams
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+// Encoding buffers start here and double while a packet doesn't fit
+constexpr size_t kInitialBufferSize = 4096;
+
+// Largest UDP payload (65507 bytes) rounded down to OSC's 4-byte alignment
+constexpr size_t kMaxPacketSize = 65504;
+
+// Largest packet over TCP, where nothing limits it but memory
+constexpr size_t kMaxStreamPacketSize = 16 * 1024 * 1024;
+
+// "#bundle", immediate time tag
+constexpr size_t kBundleHeaderSize = 16;
+
+// TCP connection attempts: how long one may take, and how often to retry
+constexpr int kConnectTimeoutMs = 2000;
+constexpr std::chrono::seconds kReconnectInterval(1);
+
+// A TCP send blocked this long by a stalled receiver drops the connection
+constexpr int kSendTimeoutMs = 1000;
+
+void writeInt32(char* destination, uint32_t value) {
+    destination[0] = static_cast<char>(value >> 24);
+    destination[1] = static_cast<char>(value >> 16);
+    destination[2] = static_cast<char>(value >> 8);
+    destination[3] = static_cast<char>(value);
+}
+
+// Open a UDP socket connected to a multicast group; -1 on failure
+int openMulticast(const std::string& group, int port, int ttl, bool loopback) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, group.c_str(), &address.sin_addr) != 1 ||
+        !IN_MULTICAST(ntohl(address.sin_addr.s_addr))) {
+        return -1;
+    }
+
+    const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    const unsigned char hops = static_cast<unsigned char>(std::clamp(ttl, 0, 255));
+    const unsigned char loop = loopback ? 1 : 0;
+    if (setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &hops, sizeof(hops)) != 0 ||
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) != 0 ||
+        ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Connect a TCP socket, waiting at most kConnectTimeoutMs; -1 on failure
+int connectTcp(const std::string& hostname, int port) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* results = nullptr;
+    if (getaddrinfo(hostname.c_str(), std::to_string(port).c_str(), &hints, &results) != 0) {
+        return -1;
+    }
+
+    int fd = -1;
+    for (addrinfo* info = results; info && fd < 0; info = info->ai_next) {
+        fd = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+
+        // Connect without blocking so an unreachable host times out quickly
+        const int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        bool connected = ::connect(fd, info->ai_addr, info->ai_addrlen) == 0;
+        if (!connected && errno == EINPROGRESS) {
+            pollfd request{fd, POLLOUT, 0};
+            int error = 0;
+            socklen_t length = sizeof(error);
+            connected = ::poll(&request, 1, kConnectTimeoutMs) == 1 &&
+                        getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) == 0 && error == 0;
+        }
+        if (!connected) {
+            ::close(fd);
+            fd = -1;
+            continue;
+        }
+        fcntl(fd, F_SETFL, flags);
+
+        const int one = 1;
+        const timeval timeout{kSendTimeoutMs / 1000, (kSendTimeoutMs % 1000) * 1000};
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    }
+    freeaddrinfo(results);
+    return fd;
+}
+
+// Write all of data to a stream socket; false if it failed part way
+bool writeAll(int fd, const char* data, size_t size) {
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+    while (size > 0) {
+        const ssize_t written = ::send(fd, data, size, flags);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
 
 // Implementation using pImpl pattern to hide oscpack types from public header
 class ofxOscSender::Impl {
@@ -21,6 +165,8 @@ public:
 
             // Create UDP socket
             socket_ = new UdpTransmitSocket(IpEndpointName(hostname.c_str(), port));
+            transport_ = Transport::Udp;
+            maxEncodedSize_ = kMaxPacketSize;
             isSetup_ = true;
             return true;
         } catch (const std::exception& e) {
@@ -29,66 +175,350 @@ public:
         }
     }
 
+    bool setupMulticast(const std::string& group, int port, int ttl, bool loopback) {
+        shutdown();
+
+        fd_ = openMulticast(group, port, ttl, loopback);
+        if (fd_ < 0) {
+            return false;
+        }
+        hostname_ = group;
+        port_ = port;
+        transport_ = Transport::Multicast;
+        maxEncodedSize_ = kMaxPacketSize;
+        isSetup_ = true;
+        return true;
+    }
+
+    bool setupTcp(const std::string& hostname, int port) {
+        shutdown();
+
+        fd_ = connectTcp(hostname, port);
+        if (fd_ < 0) {
+            return false;
+        }
+        hostname_ = hostname;
+        port_ = port;
+        transport_ = Transport::Tcp;
+        maxEncodedSize_ = kMaxStreamPacketSize;
+        isSetup_ = true;
+        return true;
+    }
+
     void shutdown() {
+        stopWorker();
+
         if (socket_) {
             delete socket_;
             socket_ = nullptr;
         }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+        transport_ = Transport::Udp;
         isSetup_ = false;
     }
 
     bool sendMessage(const ofxOscMessage& message, bool wrapInBundle) {
-        if (!isSetup_ || !socket_) {
+        if (!isSetup_) {
             return false;
         }
 
         try {
-            char buffer[4096];
-            osc::OutboundPacketStream p(buffer, sizeof(buffer));
-
-            if (wrapInBundle) {
-                // Wrap in bundle with immediate time tag
-                p << osc::BeginBundleImmediate;
-                serializeMessage(p, message);
-                p << osc::EndBundle;
-            } else {
-                serializeMessage(p, message);
+            size_t size = 0;
+            const bool encoded = encode(sendBuffer_, size, maxEncodedSize_, [&](osc::OutboundPacketStream& p) {
+                if (wrapInBundle) {
+                    // Wrap in bundle with immediate time tag
+                    p << osc::BeginBundleImmediate;
+                    serializeMessage(p, message);
+                    p << osc::EndBundle;
+                } else {
+                    serializeMessage(p, message);
+                }
+            });
+            if (!encoded) {
+                return false;
             }
 
-            socket_->Send(p.Data(), p.Size());
-            return true;
+            return writePacket(sendBuffer_.data(), size);
         } catch (const std::exception& e) {
             return false;
         }
     }
 
     bool sendBundle(const ofxOscBundle& bundle) {
-        if (!isSetup_ || !socket_) {
+        if (!isSetup_) {
             return false;
         }
 
         try {
-            char buffer[16384];
-            osc::OutboundPacketStream p(buffer, sizeof(buffer));
-
-            serializeBundle(p, bundle);
+            size_t size = 0;
+            const bool encoded = encode(sendBuffer_, size, maxEncodedSize_, [&](osc::OutboundPacketStream& p) {
+                serializeBundle(p, bundle);
+            });
+            if (!encoded) {
+                return false;
+            }
 
-            socket_->Send(p.Data(), p.Size());
-            return true;
+            return writePacket(sendBuffer_.data(), size);
         } catch (const std::exception& e) {
             return false;
         }
     }
 
+    bool queueMessage(const ofxOscMessage& message) {
+        if (!isSetup_) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        auto it = outboxIndex_.find(message.getAddress());
+        if (it != outboxIndex_.end()) {
+            outbox_[it->second] = message;
+        } else {
+            outboxIndex_.emplace(message.getAddress(), outbox_.size());
+            outbox_.push_back(message);
+        }
+        return true;
+    }
+
+    void flush() {
+        if (!isSetup_) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (outbox_.empty()) {
+            return;
+        }
+        if (!worker_.joinable()) {
+            stopRequested_ = false;
+            worker_ = std::thread([this]() { runWorker(); });
+        }
+        flushRequested_ = true;
+        queueCondition_.notify_one();
+    }
+
+    void setMaxPacketSize(size_t bytes) {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        maxPacketSize_ = std::clamp<size_t>(bytes, kBundleHeaderSize + 64, kMaxStreamPacketSize);
+    }
+
+    void setMaxPacketRate(float packetsPerSecond) {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        maxPacketRate_ = std::max(packetsPerSecond, 0.0f);
+    }
+
+    size_t getNumQueuedMessages() const {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        return outbox_.size();
+    }
+
+    uint64_t getNumPacketsSent() const {
+        return packetsSent_.load(std::memory_order_relaxed);
+    }
+
     bool isSetup() const { return isSetup_; }
     const std::string& getHostname() const { return hostname_; }
     int getPort() const { return port_; }
 
 private:
+    enum class Transport { Udp, Multicast, Tcp };
+
     UdpTransmitSocket* socket_;
     bool isSetup_;
     std::string hostname_;
     int port_;
+    Transport transport_ = Transport::Udp;
+    size_t maxEncodedSize_ = kMaxPacketSize;
+
+    // Multicast or TCP socket, and the TCP framing buffer; the mutex
+    // serializes writes from sendMessage() and the worker thread
+    std::mutex socketMutex_;
+    int fd_ = -1;
+    std::vector<char> slipBuffer_;
+    std::chrono::steady_clock::time_point nextConnectTime_;
+
+    // Encoding buffer for sendMessage() and sendBundle()
+    std::vector<char> sendBuffer_;
+
+    // Send queue, shared with the worker thread
+    mutable std::mutex queueMutex_;
+    std::condition_variable queueCondition_;
+    std::vector<ofxOscMessage> outbox_;
+    std::unordered_map<std::string, size_t> outboxIndex_;
+    bool flushRequested_ = false;
+    bool stopRequested_ = false;
+    size_t maxPacketSize_ = 1472;
+    float maxPacketRate_ = 0.0f;
+    std::atomic<uint64_t> packetsSent_{0};
+    std::thread worker_;
+
+    // Worker thread only
+    std::vector<ofxOscMessage> sending_;
+    std::vector<char> messageBuffer_;
+    std::vector<char> packetBuffer_;
+    std::chrono::steady_clock::time_point nextSendTime_;
+
+    // Serialize with write() into buffer, doubling the buffer while the
+    // packet doesn't fit; false if it can't fit in limit bytes
+    template<typename Write>
+    static bool encode(std::vector<char>& buffer, size_t& size, size_t limit, Write&& write) {
+        if (buffer.size() < kInitialBufferSize) {
+            buffer.resize(kInitialBufferSize);
+        }
+        for (;;) {
+            try {
+                osc::OutboundPacketStream p(buffer.data(), buffer.size());
+                write(p);
+                size = p.Size();
+                return true;
+            } catch (const osc::OutOfBufferMemoryException& e) {
+                if (buffer.size() >= limit) {
+                    return false;
+                }
+                buffer.resize(std::min(buffer.size() * 2, limit));
+            }
+        }
+    }
+
+    // Send an encoded packet on the transport; false if it wasn't sent
+    bool writePacket(const char* data, size_t size) {
+        std::lock_guard<std::mutex> lock(socketMutex_);
+        switch (transport_) {
+            case Transport::Udp:
+                try {
+                    socket_->Send(data, size);
+                    return true;
+                } catch (const std::exception& e) {
+                    return false;
+                }
+
+            case Transport::Multicast:
+                return ::send(fd_, data, size, 0) == static_cast<ssize_t>(size);
+
+            case Transport::Tcp:
+                if (fd_ < 0) {
+                    // Dropped earlier: try again, but not on every send
+                    const auto now = std::chrono::steady_clock::now();
+                    if (now < nextConnectTime_) {
+                        return false;
+                    }
+                    nextConnectTime_ = now + kReconnectInterval;
+                    fd_ = connectTcp(hostname_, port_);
+                    if (fd_ < 0) {
+                        return false;
+                    }
+                }
+                slipBuffer_.clear();
+                ofxOscSlip::encode(data, size, slipBuffer_);
+                if (!writeAll(fd_, slipBuffer_.data(), slipBuffer_.size())) {
+                    // The receiver drops the partial packet at the next END
+                    ::close(fd_);
+                    fd_ = -1;
+                    return false;
+                }
+                return true;
+        }
+        return false;
+    }
+
+    void stopWorker() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            stopRequested_ = true;
+            outbox_.clear();
+            outboxIndex_.clear();
+        }
+        queueCondition_.notify_one();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    void runWorker() {
+        std::unique_lock<std::mutex> lock(queueMutex_);
+        for (;;) {
+            queueCondition_.wait(lock, [this]() { return stopRequested_ || flushRequested_; });
+            if (stopRequested_) {
+                return;
+            }
+
+            // Take the flushed messages; later ones collect for the next flush
+            flushRequested_ = false;
+            sending_.swap(outbox_);
+            outbox_.clear();
+            outboxIndex_.clear();
+            const size_t packetSize = std::min(maxPacketSize_, maxEncodedSize_);
+            const float packetRate = maxPacketRate_;
+
+            lock.unlock();
+            const bool stopped = sendQueued(packetSize, packetRate);
+            lock.lock();
+            if (stopped) {
+                return;
+            }
+        }
+    }
+
+    // Worker: pack sending_ into bundles of at most packetSize bytes; true if
+    // stopped while pacing
+    bool sendQueued(size_t packetSize, float packetRate) {
+        packetBuffer_.resize(std::max(packetBuffer_.size(), packetSize));
+        std::memcpy(packetBuffer_.data(), "#bundle\0", 8);
+        writeInt32(packetBuffer_.data() + 8, 0);
+        writeInt32(packetBuffer_.data() + 12, 1);  // Immediate
+        size_t used = kBundleHeaderSize;
+
+        auto sendPacket = [&](const char* data, size_t size) -> bool {
+            if (packetRate > 0.0f) {
+                std::unique_lock<std::mutex> lock(queueMutex_);
+                if (queueCondition_.wait_until(lock, nextSendTime_, [this]() { return stopRequested_; })) {
+                    return false;
+                }
+                const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(1.0 / packetRate));
+                nextSendTime_ = std::chrono::steady_clock::now() + interval;
+            }
+            if (writePacket(data, size)) {
+                packetsSent_.fetch_add(1, std::memory_order_relaxed);
+            }
+            // A packet that failed is dropped, as UDP would
+            return true;
+        };
+
+        for (const ofxOscMessage& message : sending_) {
+            size_t size = 0;
+            if (!encode(messageBuffer_, size, maxEncodedSize_,
+                        [&](osc::OutboundPacketStream& p) { serializeMessage(p, message); })) {
+                continue;  // Too large for any packet
+            }
+
+            if (used + 4 + size > packetSize && used > kBundleHeaderSize) {
+                if (!sendPacket(packetBuffer_.data(), used)) {
+                    sending_.clear();
+                    return true;
+                }
+                used = kBundleHeaderSize;
+            }
+            if (kBundleHeaderSize + 4 + size > packetSize) {
+                // Larger than a bundle can hold: on its own
+                if (!sendPacket(messageBuffer_.data(), size)) {
+                    sending_.clear();
+                    return true;
+                }
+                continue;
+            }
+            writeInt32(packetBuffer_.data() + used, static_cast<uint32_t>(size));
+            std::memcpy(packetBuffer_.data() + used + 4, messageBuffer_.data(), size);
+            used += 4 + size;
+        }
+
+        const bool stopped = used > kBundleHeaderSize && !sendPacket(packetBuffer_.data(), used);
+        sending_.clear();
+        return stopped;
+    }
 
     void serializeMessage(osc::OutboundPacketStream& p, const ofxOscMessage& message) {
         p << osc::BeginMessage(message.getAddress().c_str());
@@ -177,6 +607,14 @@ bool ofxOscSender::setup(const std::string& hostname, int port) {
     return impl_->setup(hostname, port);
 }
 
+bool ofxOscSender::setupMulticast(const std::string& group, int port, int ttl, bool loopback) {
+    return impl_->setupMulticast(group, port, ttl, loopback);
+}
+
+bool ofxOscSender::setupTcp(const std::string& hostname, int port) {
+    return impl_->setupTcp(hostname, port);
+}
+
 bool ofxOscSender::isSetup() const {
     return impl_->isSetup();
 }
@@ -197,6 +635,30 @@ bool ofxOscSender::sendBundle(const ofxOscBundle& bundle) {
     return impl_->sendBundle(bundle);
 }
 
+bool ofxOscSender::queueMessage(const ofxOscMessage& message) {
+    return impl_->queueMessage(message);
+}
+
+void ofxOscSender::flush() {
+    impl_->flush();
+}
+
+void ofxOscSender::setMaxPacketSize(size_t bytes) {
+    impl_->setMaxPacketSize(bytes);
+}
+
+void ofxOscSender::setMaxPacketRate(float packetsPerSecond) {
+    impl_->setMaxPacketRate(packetsPerSecond);
+}
+
+size_t ofxOscSender::getNumQueuedMessages() const {
+    return impl_->getNumQueuedMessages();
+}
+
+uint64_t ofxOscSender::getNumPacketsSent() const {
+    return impl_->getNumPacketsSent();
+}
+
 void ofxOscSender::shutdown() {
     impl_->shutdown();
 }
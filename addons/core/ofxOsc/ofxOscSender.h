@@ -2,14 +2,21 @@
 
 #include "ofxOscMessage.h"
 #include "ofxOscBundle.h"
+#include <cstdint>
 #include <string>
 #include <memory>
 
-/// \brief Sends OSC messages and bundles over UDP.
+/// \brief Sends OSC messages and bundles over UDP, UDP multicast or TCP.
 ///
 /// ofxOscSender allows you to send OSC messages to a remote host/port.
 /// Messages can be sent individually or grouped in bundles.
 ///
+/// Continuous controller data suits UDP, where a lost packet is soon
+/// superseded. Multicast sends each packet once to every receiver in a
+/// group. TCP (SLIP-framed, as OSC 1.1 specifies for streams) delivers
+/// every packet, in order and up to 16MB, for large state such as preset
+/// snapshots.
+///
 /// Example usage:
 /// \code
 /// ofxOscSender sender;
@@ -20,6 +27,16 @@
 /// msg.addIntArg(42);
 /// sender.sendMessage(msg);
 /// \endcode
+///
+/// Example usage (send queue):
+/// \code
+/// // Any number of times per frame; a message replaces the one queued
+/// // for the same address
+/// sender.queueMessage(msg);
+///
+/// // Once per frame: packed into MTU-sized bundles, sent in the background
+/// sender.flush();
+/// \endcode
 class ofxOscSender {
 public:
     ofxOscSender();
@@ -36,6 +53,24 @@ public:
     /// \return true on success, false on failure
     bool setup(const std::string& hostname, int port);
 
+    /// \brief Set up the sender to send to a multicast group
+    /// \details Every receiver that joined the group with
+    /// ofxOscReceiver::setupMulticast() gets each packet sent once.
+    /// \param group IPv4 multicast address (224.0.0.0 - 239.255.255.255)
+    /// \param port Destination port number (1-65535)
+    /// \param ttl Router hops packets may cross (1: the local network only)
+    /// \param loopback Also deliver to receivers on this machine
+    /// \return true on success, false on failure
+    bool setupMulticast(const std::string& group, int port, int ttl = 1, bool loopback = true);
+
+    /// \brief Set up the sender to send over TCP to ofxOscReceiver::setupTcp()
+    /// \details If the connection drops, sends fail until it reconnects on a
+    /// later send; it retries at most once a second.
+    /// \param hostname Destination hostname or IP address
+    /// \param port Destination port number (1-65535)
+    /// \return true if connected, false on failure
+    bool setupTcp(const std::string& hostname, int port);
+
     /// \brief Check if the sender is set up and ready
     bool isSetup() const;
 
@@ -57,6 +92,34 @@ public:
     /// \return true on success, false on failure
     bool sendBundle(const ofxOscBundle& bundle);
 
+    // Send queue
+    /// \brief Queue a message for the next flush()
+    /// \details A message queued for the same address and not sent yet is
+    /// replaced in place: only the latest value is sent.
+    /// \return false if the sender is not set up
+    bool queueMessage(const ofxOscMessage& message);
+
+    /// \brief Send the queued messages on the background thread
+    /// \details Messages are packed into immediate bundles of at most the
+    /// maximum packet size; a message too large for one is sent on its own.
+    /// Messages queued while a flush is still being paced wait for the next.
+    void flush();
+
+    /// \brief Set the largest packet flush() builds
+    /// \param bytes Packet size (default 1472: a 1500-byte MTU less IP and UDP
+    /// headers); at most 65504 over UDP
+    void setMaxPacketSize(size_t bytes);
+
+    /// \brief Limit the packets per second flush() sends
+    /// \param packetsPerSecond Packet rate (default 0: unlimited)
+    void setMaxPacketRate(float packetsPerSecond);
+
+    /// \brief Get the number of messages waiting for flush()
+    size_t getNumQueuedMessages() const;
+
+    /// \brief Get the number of packets the send queue has sent
+    uint64_t getNumPacketsSent() const;
+
     // Shutdown
     /// \brief Close the socket and clean up
     void shutdown();
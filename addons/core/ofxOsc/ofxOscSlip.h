@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \brief SLIP framing of OSC packets on a stream (OSC 1.1, e.g. over TCP)
+///
+/// Each packet is sent double-END framed: an END byte, the packet with its
+/// END and ESC bytes escaped, and another END. Empty frames between two ENDs
+/// are ignored, so a receiver resynchronizes at the next END after garbage.
+struct ofxOscSlip {
+    static constexpr uint8_t kEnd = 0xC0;
+    static constexpr uint8_t kEsc = 0xDB;
+    static constexpr uint8_t kEscEnd = 0xDC;
+    static constexpr uint8_t kEscEsc = 0xDD;
+
+    /// \brief Append a framed packet to out
+    static void encode(const char* data, size_t size, std::vector<char>& out) {
+        out.reserve(out.size() + size + size / 32 + 2);
+        out.push_back(static_cast<char>(kEnd));
+        for (size_t i = 0; i < size; i++) {
+            const uint8_t c = static_cast<uint8_t>(data[i]);
+            if (c == kEnd) {
+                out.push_back(static_cast<char>(kEsc));
+                out.push_back(static_cast<char>(kEscEnd));
+            } else if (c == kEsc) {
+                out.push_back(static_cast<char>(kEsc));
+                out.push_back(static_cast<char>(kEscEsc));
+            } else {
+                out.push_back(static_cast<char>(c));
+            }
+        }
+        out.push_back(static_cast<char>(kEnd));
+    }
+};
+
+/// \brief Splits a SLIP stream back into packets, across reads of any size
+class ofxOscSlipDecoder {
+public:
+    /// \param maxPacketSize Longer packets are discarded up to their next END
+    explicit ofxOscSlipDecoder(size_t maxPacketSize = 16 * 1024 * 1024)
+        : maxPacketSize_(maxPacketSize) {}
+
+    /// \brief Decode bytes read from the stream
+    /// \param onPacket Called as onPacket(const char* data, size_t size) for
+    /// each complete packet; data is valid during the call
+    template<typename OnPacket>
+    void feed(const char* data, size_t size, OnPacket&& onPacket) {
+        for (size_t i = 0; i < size; i++) {
+            uint8_t c = static_cast<uint8_t>(data[i]);
+            if (c == ofxOscSlip::kEnd) {
+                if (!packet_.empty() && !overflow_) {
+                    onPacket(packet_.data(), packet_.size());
+                }
+                packet_.clear();
+                escaping_ = false;
+                overflow_ = false;
+                continue;
+            }
+            if (escaping_) {
+                escaping_ = false;
+                c = c == ofxOscSlip::kEscEnd ? ofxOscSlip::kEnd
+                  : c == ofxOscSlip::kEscEsc ? ofxOscSlip::kEsc
+                  : c;  // Protocol violation: keep the byte
+            } else if (c == ofxOscSlip::kEsc) {
+                escaping_ = true;
+                continue;
+            }
+            if (overflow_) {
+                continue;
+            }
+            if (packet_.size() >= maxPacketSize_) {
+                overflow_ = true;
+                packet_.clear();
+                continue;
+            }
+            packet_.push_back(static_cast<char>(c));
+        }
+    }
+
+    void reset() {
+        packet_.clear();
+        escaping_ = false;
+        overflow_ = false;
+    }
+
+private:
+    size_t maxPacketSize_;
+    std::vector<char> packet_;
+    bool escaping_ = false;
+    bool overflow_ = false;
+};
@@ -0,0 +1,32 @@
+#include "ofxOscTelemetry.h"
+#include "ofxOscMessage.h"
+#include <algorithm>
+
+bool ofxOscSendTelemetry(ofxOscSender& sender, const oflike::ofTelemetryBatch& batch) {
+    if (!sender.isSetup()) {
+        return false;
+    }
+
+    const std::string root = "/" + batch.prefix + "/";
+    ofxOscMessage message;
+    message.setAddress(root + "sequence");
+    message.addInt64Arg(static_cast<int64_t>(batch.sequence));
+    sender.queueMessage(message);
+
+    for (const oflike::ofTelemetryMetric& metric : batch.metrics) {
+        std::string address = root + metric.name;
+        std::replace(address.begin() + root.size(), address.end(), '.', '/');
+
+        message.clear();
+        message.setAddress(address);
+        if (metric.kind == oflike::ofTelemetryKind::Counter) {
+            message.addIntArg(static_cast<int32_t>(metric.value));
+        } else {
+            message.addFloatArg(static_cast<float>(metric.value));
+        }
+        sender.queueMessage(message);
+    }
+
+    sender.flush();
+    return true;
+}
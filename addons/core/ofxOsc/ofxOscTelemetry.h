@@ -0,0 +1,18 @@
+#pragma once
+
+// ofxOscTelemetry - Send ofTelemetry batches over OSC
+// For collectors that already speak OSC; see ofxUdpSendTelemetry() (ofxNetwork)
+// for statsd.
+
+#include "ofxOscSender.h"
+#include "../../../oflike/utils/ofTelemetry.h"
+
+/// Send a telemetry batch through the sender's queue
+/// Each metric goes to "/<prefix>/<name>", dots as slashes (e.g.
+/// "/stage-a/frame/ms/p99"), as a float, or an int for counters, after
+/// "/<prefix>/sequence". The sender's flush() packs them into MTU-sized
+/// bundles sent in the background; messages the app queued go with them.
+/// @param sender Set up sender
+/// @param batch Batch given to the ofTelemetry exporter
+/// @return false if the sender is not set up
+bool ofxOscSendTelemetry(ofxOscSender& sender, const oflike::ofTelemetryBatch& batch);
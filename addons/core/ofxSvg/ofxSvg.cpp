@@ -1,6 +1,7 @@
 #include "ofxSvg.h"
 #include "../../../oflike/utils/ofLog.h"
 #include "../../../oflike/graphics/ofGraphics.h"
+#include "../../../oflike/3d/VboMesh.h"
 
 // nanosvg is a header-only library
 #define NANOSVG_IMPLEMENTATION
@@ -18,6 +19,11 @@ public:
     float width = 0.0f;
     float height = 0.0f;
 
+    // Compiled mesh of all paths (see compile())
+    VboMesh mesh;
+    std::vector<ofxSvg::DrawRange> ranges;
+    bool compiled = false;
+
     ~Impl() {
         clear();
     }
@@ -30,6 +36,115 @@ public:
         paths.clear();
         width = 0.0f;
         height = 0.0f;
+        clearCompiled();
+    }
+
+    void clearCompiled() {
+        mesh.clear();
+        ranges.clear();
+        compiled = false;
+    }
+
+    bool compile() {
+        clearCompiled();
+        ofPath::tessellateAll(paths);
+
+        ofMesh merged;
+        merged.setMode(OF_PRIMITIVE_TRIANGLES);
+        std::vector<ofVec3f> vertices;
+        std::vector<uint32_t> indices;
+        auto append = [&](const ofColor& color) {
+            const uint32_t base = static_cast<uint32_t>(merged.getNumVertices());
+            merged.addVertices(vertices);
+            auto& colors = merged.getColors();
+            colors.insert(colors.end(), vertices.size(), color);
+            auto& mergedIndices = merged.getIndices();
+            for (uint32_t index : indices) {
+                mergedIndices.push_back(base + index);
+            }
+        };
+
+        ranges.reserve(paths.size());
+        for (const ofPath& path : paths) {
+            ofxSvg::DrawRange range;
+            range.indexStart = static_cast<uint32_t>(merged.getNumIndices());
+
+            uint8_t r, g, b, a;
+            if (path.isFilled()) {
+                path.getTessellation(vertices, indices);
+                path.getFillColor(r, g, b, a);
+                append(ofColor(r, g, b, a));
+            }
+
+            const float strokeWidth = path.getStrokeWidth();
+            if (strokeWidth > 0.0f) {
+                if (strokeWidth > 1.0f) {
+                    path.getStrokeMesh(vertices, indices);
+                } else {
+                    path.getStrokeMesh(1.0f, vertices, indices);
+                }
+                path.getStrokeColor(r, g, b, a);
+                append(ofColor(r, g, b, a));
+            }
+
+            range.indexCount = static_cast<uint32_t>(merged.getNumIndices()) - range.indexStart;
+            ranges.push_back(range);
+        }
+
+        if (merged.getNumIndices() == 0) {
+            ranges.clear();
+            return false;
+        }
+
+        // Paths overlap in painter's order at z = 0
+        mesh.setDepthTest(false);
+        if (!mesh.setMesh(merged, VboUsageHint::Static)) {
+            ofLogError("ofxSvg") << "Failed to create the compiled mesh";
+            ranges.clear();
+            return false;
+        }
+
+        compiled = true;
+        ofLogVerbose("ofxSvg") << "Compiled " << paths.size() << " paths into "
+                               << merged.getNumVertices() << " vertices";
+        return true;
+    }
+
+    void drawPaths() const {
+        if (!compiled) {
+            for (const auto& path : paths) {
+                path.draw();
+            }
+            return;
+        }
+
+        // Colors are baked, so draw untinted, filled
+        uint8_t r, g, b, a;
+        ofGetColor(r, g, b, a);
+        const bool fill = ofGetFill();
+        ofSetColor(255);
+        ofFill();
+
+        // One draw per run of visible paths (one in all when none is hidden)
+        size_t runStart = 0;
+        size_t runCount = 0;
+        for (const auto& range : ranges) {
+            if (range.visible) {
+                if (runCount == 0) runStart = range.indexStart;
+                runCount += range.indexCount;
+            } else if (runCount > 0) {
+                mesh.drawRange(runStart, runCount);
+                runCount = 0;
+            }
+        }
+        if (runCount == mesh.getNumIndices()) {
+            mesh.draw();
+        } else if (runCount > 0) {
+            mesh.drawRange(runStart, runCount);
+        }
+
+        ofSetColor(r, g, b, a);
+        if (!fill) ofNoFill();
     }
 
     bool loadFromFile(const std::string& path, const std::string& units, float dpi) {
@@ -166,6 +281,10 @@ private:
                 paths.push_back(std::move(path));
             }
         }
+
+        // Tessellate every path now, in parallel, rather than one after
+        // another on the first draw
+        ofPath::tessellateAll(paths);
     }
 };
 
@@ -239,18 +358,14 @@ float ofxSvg::getHeight() const {
 }
 
 void ofxSvg::draw() {
-    for (auto& path : impl_->paths) {
-        path.draw();
-    }
+    impl_->drawPaths();
 }
 
 void ofxSvg::draw(float x, float y) {
     // Save current matrix, translate, draw, restore
     ofPushMatrix();
     ofTranslate(x, y);
-    for (auto& path : impl_->paths) {
-        path.draw();
-    }
+    impl_->drawPaths();
     ofPopMatrix();
 }
 
@@ -264,8 +379,31 @@ void ofxSvg::draw(float x, float y, float width, float height) {
     float scaleY = (impl_->height > 0.0f) ? height / impl_->height : 1.0f;
     ofScale(scaleX, scaleY);
 
-    for (auto& path : impl_->paths) {
-        path.draw();
-    }
+    impl_->drawPaths();
     ofPopMatrix();
 }
+
+bool ofxSvg::compile() {
+    return impl_->compile();
+}
+
+bool ofxSvg::isCompiled() const {
+    return impl_->compiled;
+}
+
+void ofxSvg::setPathVisible(int index, bool visible) {
+    if (index >= 0 && static_cast<size_t>(index) < impl_->ranges.size()) {
+        impl_->ranges[index].visible = visible;
+    }
+}
+
+bool ofxSvg::isPathVisible(int index) const {
+    if (index >= 0 && static_cast<size_t>(index) < impl_->ranges.size()) {
+        return impl_->ranges[index].visible;
+    }
+    return true;
+}
+
+const std::vector<ofxSvg::DrawRange>& ofxSvg::getDrawRanges() const {
+    return impl_->ranges;
+}
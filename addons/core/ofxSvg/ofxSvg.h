@@ -19,9 +19,20 @@
 ///     ofPath& path = svg.getPathAt(i);
 ///     path.draw();
 /// }
+///
+/// // Or draw the whole illustration with one draw
+/// svg.compile();
+/// svg.draw();
 /// \endcode
 class ofxSvg {
 public:
+    /// \brief A path's triangles in the compiled mesh (see compile())
+    struct DrawRange {
+        uint32_t indexStart = 0;  ///< First index in the mesh's index buffer
+        uint32_t indexCount = 0;  ///< Fill and stroke indices of the path
+        bool visible = true;
+    };
+
     ofxSvg();
     ~ofxSvg();
 
@@ -99,6 +110,33 @@ public:
     /// \param height Height to draw
     void draw(float x, float y, float width, float height);
 
+    // Compiled drawing
+    /// \brief Merge every path into one static GPU mesh
+    /// \details The fill and stroke meshes of all paths are concatenated in
+    /// drawing order, each path's colors baked into its vertices, and
+    /// uploaded once; draw() then costs a single draw while every path is
+    /// visible. Strokes of width 1 or less are meshed 1 unit wide. Edits to
+    /// the paths show after compiling again; load() and clear() drop the
+    /// mesh, and copies of the SVG are not compiled.
+    /// \return true if the mesh was created
+    bool compile();
+
+    /// \brief Check if draw() uses the compiled mesh
+    bool isCompiled() const;
+
+    /// \brief Show or hide a path of the compiled mesh
+    /// \details Hidden paths split the draw into one per run of visible paths.
+    /// \param index Path index (0-based)
+    /// \param visible Whether the path is drawn
+    void setPathVisible(int index, bool visible);
+
+    /// \brief Check if a path of the compiled mesh is drawn
+    bool isPathVisible(int index) const;
+
+    /// \brief Get the per-path ranges of the compiled mesh
+    /// \return One range per path, empty if not compiled
+    const std::vector<DrawRange>& getDrawRanges() const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl_;
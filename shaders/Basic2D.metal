@@ -1,10 +1,26 @@
 #include <metal_stdlib>
 #include "Common.h"
+#include "BlendModes.h"
 
 using namespace metal;
 
 // MARK: - Vertex Shader
 
+/// Shared body of vertex2D and vertex2DPacked
+static RasterizerData2D transformVertex2D(Vertex2D in, constant Uniforms2D& uniforms) {
+    RasterizerData2D out;
+
+    // Transform position
+    float4 position = float4(in.position, 0.0, 1.0);
+    out.position = uniforms.projectionMatrix * uniforms.modelViewMatrix * position;
+
+    // Pass through texture coordinates and color
+    out.texCoord = in.texCoord;
+    out.color = in.color;
+
+    return out;
+}
+
 /// Basic 2D vertex shader
 /// Transforms vertices using projection and model-view matrices
 vertex RasterizerData2D vertex2D(
@@ -12,21 +28,262 @@ vertex RasterizerData2D vertex2D(
     constant Vertex2D* vertices [[buffer(0)]],
     constant Uniforms2D& uniforms [[buffer(1)]]
 ) {
-    RasterizerData2D out;
+    return transformVertex2D(vertices[vertexID], uniforms);
+}
+
+/// Basic 2D vertex shader for PackedVertex2D input
+vertex RasterizerData2D vertex2DPacked(
+    uint vertexID [[vertex_id]],
+    constant PackedVertex2D* vertices [[buffer(0)]],
+    constant Uniforms2D& uniforms [[buffer(1)]]
+) {
+    return transformVertex2D(unpackVertex(vertices[vertexID]), uniforms);
+}
 
-    Vertex2D in = vertices[vertexID];
+/// Texture ranges of a texture-batched 2D draw (matches TextureRanges2D in MetalRenderer.mm)
+struct TextureRanges2D {
+    uint count;
+    uint vertexEnd[64];     // Exclusive end of each range, relative to the batch
+    uint slot[64];          // Texture slot of each range
+};
+
+/// Rasterizer data with the texture slot of the vertex's range
+struct RasterizerData2DBatched {
+    float4 position [[position]];
+    float2 texCoord;
+    float4 color;
+    uint slot [[flat]];
+};
+
+/// Shared body of vertex2DTextureBatch and vertex2DTextureBatchPacked
+/// Finds the range containing the vertex by binary search over the range ends
+static RasterizerData2DBatched transformVertex2DBatched(
+    Vertex2D in,
+    uint vertexID,
+    constant Uniforms2D& uniforms,
+    constant TextureRanges2D& ranges
+) {
+    RasterizerData2DBatched out;
 
-    // Transform position
     float4 position = float4(in.position, 0.0, 1.0);
     out.position = uniforms.projectionMatrix * uniforms.modelViewMatrix * position;
-
-    // Pass through texture coordinates and color
     out.texCoord = in.texCoord;
     out.color = in.color;
 
+    uint low = 0;
+    uint high = ranges.count - 1;
+    while (low < high) {
+        uint mid = (low + high) / 2;
+        if (vertexID < ranges.vertexEnd[mid]) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    out.slot = ranges.slot[low];
+
+    return out;
+}
+
+/// 2D vertex shader for texture batches
+vertex RasterizerData2DBatched vertex2DTextureBatch(
+    uint vertexID [[vertex_id]],
+    constant Vertex2D* vertices [[buffer(0)]],
+    constant Uniforms2D& uniforms [[buffer(1)]],
+    constant TextureRanges2D& ranges [[buffer(2)]]
+) {
+    return transformVertex2DBatched(vertices[vertexID], vertexID, uniforms, ranges);
+}
+
+/// 2D vertex shader for texture batches of PackedVertex2D input
+vertex RasterizerData2DBatched vertex2DTextureBatchPacked(
+    uint vertexID [[vertex_id]],
+    constant PackedVertex2D* vertices [[buffer(0)]],
+    constant Uniforms2D& uniforms [[buffer(1)]],
+    constant TextureRanges2D& ranges [[buffer(2)]]
+) {
+    return transformVertex2DBatched(unpackVertex(vertices[vertexID]), vertexID, uniforms, ranges);
+}
+
+/// Rasterizer data for SDF shapes: position in the shape frame plus the
+/// shape parameters
+struct RasterizerData2DShape {
+    float4 position [[position]];
+    float2 local;                   // Fragment position in the shape frame
+    float4 color;
+    float2 halfSize [[flat]];
+    float cornerRadius [[flat]];
+    float strokeWidth [[flat]];
+    uint kind [[flat]];
+};
+
+/// SDF shape vertex shader
+/// Expands each ShapeInstance2D into a 4-vertex strip covering the shape
+/// plus its stroke and a one-pixel anti-aliasing margin
+vertex RasterizerData2DShape vertex2DShape(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    constant ShapeInstance2D* shapes [[buffer(0)]],
+    constant Uniforms2D& uniforms [[buffer(1)]]
+) {
+    RasterizerData2DShape out;
+
+    ShapeInstance2D shape = shapes[instanceID];
+
+    // One pixel in shape units under the model-view scale
+    float scale = min(length(uniforms.modelViewMatrix[0].xy), length(uniforms.modelViewMatrix[1].xy));
+    float margin = 1.0 / max(scale, 1e-4);
+
+    float2 corner = float2((vertexID & 1) ? 1.0 : -1.0, (vertexID & 2) ? 1.0 : -1.0);
+    float2 local = corner * (shape.halfSize + shape.strokeWidth * 0.5 + margin);
+
+    float2 perpendicular = float2(-shape.axis.y, shape.axis.x);
+    float2 world = shape.center + shape.axis * local.x + perpendicular * local.y;
+    out.position = uniforms.projectionMatrix * uniforms.modelViewMatrix * float4(world, 0.0, 1.0);
+
+    out.local = local;
+    out.color = shape.color;
+    out.halfSize = shape.halfSize;
+    out.cornerRadius = shape.cornerRadius;
+    out.strokeWidth = shape.strokeWidth;
+    out.kind = shape.kind;
+
+    return out;
+}
+
+/// Point on a round join/cap: from rotated by sweep * t around center
+static float2 strokeArcPoint(float2 center, float2 from, float sweep, float t, float radius) {
+    float angle = sweep * t;
+    float c = cos(angle);
+    float s = sin(angle);
+    return center + radius * float2(from.x * c - from.y * s, from.x * s + from.y * c);
+}
+
+/// Stroke vertex shader
+/// Expands each StrokeSegment2D into a fixed vertex range:
+///   [0, 6)               body quad (extended for square caps)
+///   [6, 6 + 3N)          join toward next, or end cap
+///   [6 + 3N, 6 + 6N)     start cap
+/// where N = STROKE_ARC_TRIANGLES. Triangles a segment doesn't need
+/// collapse onto a point and are culled by the rasterizer.
+vertex RasterizerData2D vertex2DStroke(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    constant StrokeSegment2D* segments [[buffer(0)]],
+    constant Uniforms2D& uniforms [[buffer(1)]]
+) {
+    RasterizerData2D out;
+
+    StrokeSegment2D segment = segments[instanceID];
+    const bool hasPrevious = (segment.flags & 1u) != 0;
+    const bool hasNext = (segment.flags & 2u) != 0;
+    const float hw = segment.halfWidth;
+
+    float2 delta = segment.p1 - segment.p0;
+    float len = length(delta);
+    float2 dir = len > 0.0 ? delta / len : float2(1.0, 0.0);
+    float2 normal = float2(-dir.y, dir.x);
+
+    float2 p;
+    if (vertexID < 6) {
+        // Body: two triangles between the offset edges
+        float startExtend = (!hasPrevious && segment.cap == 2) ? hw : 0.0;
+        float endExtend = (!hasNext && segment.cap == 2) ? hw : 0.0;
+        float2 start = segment.p0 - dir * startExtend;
+        float2 end = segment.p1 + dir * endExtend;
+
+        const uint corners[6] = {0, 1, 2, 0, 2, 3};
+        uint corner = corners[vertexID];
+        float2 base = (corner == 0 || corner == 3) ? start : end;
+        p = base + normal * ((corner < 2) ? -hw : hw);
+    } else {
+        uint k = vertexID - 6;
+        const bool endPiece = k < 3 * STROKE_ARC_TRIANGLES;
+        if (!endPiece) {
+            k -= 3 * STROKE_ARC_TRIANGLES;
+        }
+        const uint triangle = k / 3;
+        const uint corner = k % 3;
+        const float2 center = endPiece ? segment.p1 : segment.p0;
+
+        p = center;
+        if (endPiece && hasNext) {
+            // Join on the outer side of the turn toward next
+            float2 nextDelta = segment.next - segment.p1;
+            float nextLen = length(nextDelta);
+            if (nextLen > 0.0 && corner > 0) {
+                float2 nextDir = nextDelta / nextLen;
+                float2 nextNormal = float2(-nextDir.y, nextDir.x);
+                float turn = dir.x * nextDir.y - dir.y * nextDir.x;
+                float side = turn > 0.0 ? -1.0 : 1.0;
+                float2 a = normal * side;
+                float2 b = nextNormal * side;
+
+                uint join = segment.join;
+                float2 miter = a + b;
+                float miterScale = 0.0;
+                if (join == 0) {
+                    float miterLength = length(miter);
+                    float cosHalf = miterLength * 0.5;
+                    if (miterLength > 1e-4 && 1.0 / cosHalf <= segment.miterLimit) {
+                        miter /= miterLength;
+                        miterScale = 1.0 / cosHalf;
+                    } else {
+                        join = 2;
+                    }
+                }
+
+                if (join == 0) {
+                    float2 tip = center + miter * hw * miterScale;
+                    if (triangle == 0) {
+                        p = corner == 1 ? center + a * hw : tip;
+                    } else if (triangle == 1) {
+                        p = corner == 1 ? tip : center + b * hw;
+                    }
+                } else if (join == 2) {
+                    if (triangle == 0) {
+                        p = center + (corner == 1 ? a : b) * hw;
+                    }
+                } else {
+                    float sweep = atan2(a.x * b.y - a.y * b.x, dot(a, b));
+                    float t = float(triangle + corner - 1) / float(STROKE_ARC_TRIANGLES);
+                    p = strokeArcPoint(center, a, sweep, t, hw);
+                }
+            }
+        } else if (((endPiece && !hasNext) || (!endPiece && !hasPrevious)) &&
+                   segment.cap == 1 && corner > 0) {
+            // Round cap: half circle from +normal around the forward (or backward) direction
+            float sweep = endPiece ? -M_PI_F : M_PI_F;
+            float t = float(triangle + corner - 1) / float(STROKE_ARC_TRIANGLES);
+            p = strokeArcPoint(center, normal, sweep, t, hw);
+        }
+    }
+
+    out.position = uniforms.projectionMatrix * uniforms.modelViewMatrix * float4(p, 0.0, 1.0);
+    out.texCoord = float2(0.0);
+    out.color = segment.color;
+
     return out;
 }
 
+// MARK: - Signed Distance Functions
+
+/// Ellipse distance; exact for circles, first-order approximation otherwise
+static float sdEllipse(float2 p, float2 radii) {
+    if (radii.x == radii.y) {
+        return length(p) - radii.x;
+    }
+    float k0 = length(p / radii);
+    float k1 = length(p / (radii * radii));
+    return k1 > 0.0 ? k0 * (k0 - 1.0) / k1 : -min(radii.x, radii.y);
+}
+
+/// Rounded box distance (radius 0 = sharp box)
+static float sdRoundedRect(float2 p, float2 halfSize, float radius) {
+    float2 q = abs(p) - halfSize + radius;
+    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - radius;
+}
+
 // MARK: - Fragment Shaders
 
 /// Basic 2D fragment shader (solid color)
@@ -47,3 +304,249 @@ fragment float4 fragment2DTextured(
     float4 texColor = colorTexture.sample(textureSampler, in.texCoord);
     return texColor * in.color;
 }
+
+/// Shared body of fragment2DDistanceField and fragment2DDistanceFieldBlend
+static float4 shadeDistanceField(RasterizerData2D in, texture2d<float> distanceTexture, sampler textureSampler) {
+    float distance = distanceTexture.sample(textureSampler, in.texCoord).a;
+    float halfWidth = max(fwidth(distance) * 0.5, 1e-5);
+    float coverage = smoothstep(0.5 - halfWidth, 0.5 + halfWidth, distance);
+    if (coverage <= 0.0) {
+        discard_fragment();
+    }
+    return float4(in.color.rgb, in.color.a * coverage);
+}
+
+/// Distance field 2D fragment shader
+/// Coverage from the texture's alpha, a distance field with the edge at 0.5,
+/// anti-aliased over one screen pixel at any scale
+fragment float4 fragment2DDistanceField(
+    RasterizerData2D in [[stage_in]],
+    texture2d<float> distanceTexture [[texture(0)]],
+    sampler textureSampler [[sampler(0)]]
+) {
+    return shadeDistanceField(in, distanceTexture, textureSampler);
+}
+
+/// Texture-batched 2D fragment shader
+/// Samples the texture of the fragment's range and modulates with vertex color
+fragment float4 fragment2DTextureBatch(
+    RasterizerData2DBatched in [[stage_in]],
+    array<texture2d<float>, 16> textures [[texture(0)]],
+    sampler textureSampler [[sampler(0)]]
+) {
+    float4 texColor = textures[in.slot].sample(textureSampler, in.texCoord);
+    return texColor * in.color;
+}
+
+/// Shared body of fragment2DShape and fragment2DShapeBlend
+static float4 shadeShape(RasterizerData2DShape in) {
+    float d = in.kind == 0 ? sdEllipse(in.local, in.halfSize)
+                           : sdRoundedRect(in.local, in.halfSize, in.cornerRadius);
+    if (in.strokeWidth > 0.0) {
+        d = abs(d) - in.strokeWidth * 0.5;
+    }
+
+    float coverage = saturate(0.5 - d / max(fwidth(d), 1e-5));
+    if (coverage <= 0.0) {
+        discard_fragment();
+    }
+    return float4(in.color.rgb, in.color.a * coverage);
+}
+
+/// SDF shape fragment shader
+/// Coverage from the signed distance, anti-aliased over one screen pixel
+fragment float4 fragment2DShape(
+    RasterizerData2DShape in [[stage_in]]
+) {
+    return shadeShape(in);
+}
+
+// MARK: - Path Fill
+
+/// Rasterizer data for path fills: position in model space plus the path's
+/// edge range
+struct RasterizerData2DPath {
+    float4 position [[position]];
+    float2 local;                   // Fragment position in model space
+    float4 color [[flat]];
+    uint segmentOffset [[flat]];
+    uint segmentCount [[flat]];
+    uint fillRule [[flat]];
+};
+
+/// Path fill vertex shader
+/// Expands each PathInstance2D into a 4-vertex strip covering its bounds
+/// plus a one-pixel anti-aliasing margin
+vertex RasterizerData2DPath vertex2DPath(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    constant PathInstance2D* paths [[buffer(0)]],
+    constant Uniforms2D& uniforms [[buffer(1)]]
+) {
+    RasterizerData2DPath out;
+
+    PathInstance2D path = paths[instanceID];
+
+    // One pixel in model units under the model-view scale
+    float scale = min(length(uniforms.modelViewMatrix[0].xy), length(uniforms.modelViewMatrix[1].xy));
+    float margin = 1.0 / max(scale, 1e-4);
+
+    float2 local = float2((vertexID & 1) ? path.boundsMax.x + margin : path.boundsMin.x - margin,
+                          (vertexID & 2) ? path.boundsMax.y + margin : path.boundsMin.y - margin);
+    out.position = uniforms.projectionMatrix * uniforms.modelViewMatrix * float4(local, 0.0, 1.0);
+
+    out.local = local;
+    out.color = path.color;
+    out.segmentOffset = path.segmentOffset;
+    out.segmentCount = path.segmentCount;
+    out.fillRule = path.fillRule;
+
+    return out;
+}
+
+/// Whether a winding number is inside under a fill rule (ofPolyWindingMode)
+static bool pathFills(int winding, uint fillRule) {
+    switch (fillRule) {
+        case 0:  return (winding & 1) != 0;
+        case 1:  return winding != 0;
+        case 2:  return winding > 0;
+        case 3:  return winding < 0;
+        default: return abs(winding) >= 2;
+    }
+}
+
+/// Crossings inside one pixel row kept per sample row; more are rare
+/// outside of degenerate art and only cost accuracy, not correctness
+constant uint PATH_ROW_CROSSINGS = 4;
+constant uint PATH_SAMPLE_ROWS = 4;
+
+/// Shared body of fragment2DPath and fragment2DPathBlend
+/// Coverage from the winding number of the path's edges: on each of four
+/// rows across the pixel, the winding left of every edge crossing is known
+/// from the crossings to its right, so the covered length of the row is
+/// exact between crossings. Every fragment visits all of the path's edges.
+static float4 shadePath(RasterizerData2DPath in, constant PathSegment2D* segments) {
+    // Half the pixel footprint in model units
+    float2 dx = dfdx(in.local);
+    float2 dy = dfdy(in.local);
+    float hx = max(0.5 * (abs(dx.x) + abs(dy.x)), 1e-6);
+    float hy = 0.5 * (abs(dx.y) + abs(dy.y));
+
+    float x0 = in.local.x - hx;
+    float x1 = in.local.x + hx;
+
+    float coverage = 0.0;
+    for (uint row = 0; row < PATH_SAMPLE_ROWS; row++) {
+        float y = in.local.y + hy * ((float(row) + 0.5) * (2.0 / float(PATH_SAMPLE_ROWS)) - 1.0);
+
+        // Winding right of the row, and the crossings inside it
+        int winding = 0;
+        float crossings[PATH_ROW_CROSSINGS];
+        int directions[PATH_ROW_CROSSINGS];
+        uint found = 0;
+        for (uint i = 0; i < in.segmentCount; i++) {
+            PathSegment2D edge = segments[in.segmentOffset + i];
+            if ((edge.p0.y <= y) == (edge.p1.y <= y)) {
+                continue;   // Half-open in y, so shared vertices count once
+            }
+            float xi = edge.p0.x + (y - edge.p0.y) * (edge.p1.x - edge.p0.x) / (edge.p1.y - edge.p0.y);
+            int direction = edge.p1.y > edge.p0.y ? 1 : -1;
+            if (xi > x1) {
+                winding += direction;
+            } else if (xi > x0 && found < PATH_ROW_CROSSINGS) {
+                // Insertion sort, right to left
+                uint j = found++;
+                while (j > 0 && crossings[j - 1] < xi) {
+                    crossings[j] = crossings[j - 1];
+                    directions[j] = directions[j - 1];
+                    j--;
+                }
+                crossings[j] = xi;
+                directions[j] = direction;
+            }
+        }
+
+        // Walk the row right to left, adding the inside intervals
+        float covered = 0.0;
+        float cursor = x1;
+        for (uint j = 0; j < found; j++) {
+            if (pathFills(winding, in.fillRule)) {
+                covered += cursor - crossings[j];
+            }
+            winding += directions[j];
+            cursor = crossings[j];
+        }
+        if (pathFills(winding, in.fillRule)) {
+            covered += cursor - x0;
+        }
+        coverage += covered / (x1 - x0);
+    }
+    coverage /= float(PATH_SAMPLE_ROWS);
+
+    if (coverage <= 0.0) {
+        discard_fragment();
+    }
+    return float4(in.color.rgb, in.color.a * coverage);
+}
+
+/// Path fill fragment shader
+fragment float4 fragment2DPath(
+    RasterizerData2DPath in [[stage_in]],
+    constant PathSegment2D* segments [[buffer(0)]]
+) {
+    return shadePath(in, segments);
+}
+
+// MARK: - Programmable Blend Variants
+
+// Same shading as the fragment shaders above, blended over [[color(0)]]
+// with kProgrammableBlendMode (see BlendModes.h); hardware blending is off
+
+fragment float4 fragment2DBlend(
+    RasterizerData2D in [[stage_in]],
+    float4 dst [[color(0)]]
+) {
+    return programmableBlend(in.color, dst);
+}
+
+fragment float4 fragment2DTexturedBlend(
+    RasterizerData2D in [[stage_in]],
+    float4 dst [[color(0)]],
+    texture2d<float> colorTexture [[texture(0)]],
+    sampler textureSampler [[sampler(0)]]
+) {
+    return programmableBlend(colorTexture.sample(textureSampler, in.texCoord) * in.color, dst);
+}
+
+fragment float4 fragment2DDistanceFieldBlend(
+    RasterizerData2D in [[stage_in]],
+    float4 dst [[color(0)]],
+    texture2d<float> distanceTexture [[texture(0)]],
+    sampler textureSampler [[sampler(0)]]
+) {
+    return programmableBlend(shadeDistanceField(in, distanceTexture, textureSampler), dst);
+}
+
+fragment float4 fragment2DTextureBatchBlend(
+    RasterizerData2DBatched in [[stage_in]],
+    float4 dst [[color(0)]],
+    array<texture2d<float>, 16> textures [[texture(0)]],
+    sampler textureSampler [[sampler(0)]]
+) {
+    return programmableBlend(textures[in.slot].sample(textureSampler, in.texCoord) * in.color, dst);
+}
+
+fragment float4 fragment2DShapeBlend(
+    RasterizerData2DShape in [[stage_in]],
+    float4 dst [[color(0)]]
+) {
+    return programmableBlend(shadeShape(in), dst);
+}
+
+fragment float4 fragment2DPathBlend(
+    RasterizerData2DPath in [[stage_in]],
+    float4 dst [[color(0)]],
+    constant PathSegment2D* segments [[buffer(0)]]
+) {
+    return programmableBlend(shadePath(in, segments), dst);
+}
@@ -1,22 +1,16 @@
 #include <metal_stdlib>
 #include "Common.h"
+#include "BlendModes.h"
+#include "Transparency.h"
 
 using namespace metal;
 
 // MARK: - Vertex Shader
 
-/// Basic 3D vertex shader
-/// Transforms vertices using projection and model-view matrices
-/// Passes through normals and color
-vertex RasterizerData3D vertex3D(
-    uint vertexID [[vertex_id]],
-    constant Vertex3D* vertices [[buffer(0)]],
-    constant Uniforms3D& uniforms [[buffer(1)]]
-) {
+/// Shared body of vertex3D and vertex3DPacked
+static RasterizerData3D transformVertex3D(Vertex3D in, Uniforms3D uniforms) {
     RasterizerData3D out;
 
-    Vertex3D in = vertices[vertexID];
-
     // Transform position
     float4 position = float4(in.position, 1.0);
     out.position = uniforms.projectionMatrix * uniforms.modelViewMatrix * position;
@@ -34,6 +28,133 @@ vertex RasterizerData3D vertex3D(
     return out;
 }
 
+/// Shared body of vertex3DInstanced and vertex3DInstancedPacked
+static RasterizerData3D transformVertex3DInstanced(Vertex3D in, InstanceData instance, Uniforms3D uniforms) {
+    RasterizerData3D out;
+
+    // Transform position (instance transform first, then model-view)
+    float4 viewPosition = uniforms.modelViewMatrix * (instance.modelMatrix * float4(in.position, 1.0));
+    out.position = uniforms.projectionMatrix * viewPosition;
+
+    // Transform normal (exact for rotation and uniform scale)
+    out.normal = (uniforms.normalMatrix * (instance.modelMatrix * float4(in.normal, 0.0))).xyz;
+
+    out.worldPosition = viewPosition.xyz;
+
+    // Pass through texture coordinates, tint color per instance
+    out.texCoord = in.texCoord;
+    out.color = in.color * instance.color;
+
+    return out;
+}
+
+/// Basic 3D vertex shader
+/// Transforms vertices using projection and model-view matrices
+/// Passes through normals and color
+vertex RasterizerData3D vertex3D(
+    uint vertexID [[vertex_id]],
+    constant Vertex3D* vertices [[buffer(0)]],
+    constant Uniforms3D& uniforms [[buffer(1)]]
+) {
+    return transformVertex3D(vertices[vertexID], uniforms);
+}
+
+/// Basic 3D vertex shader for PackedVertex3D input
+vertex RasterizerData3D vertex3DPacked(
+    uint vertexID [[vertex_id]],
+    constant PackedVertex3D* vertices [[buffer(0)]],
+    constant Uniforms3D& uniforms [[buffer(1)]]
+) {
+    return transformVertex3D(unpackVertex(vertices[vertexID]), uniforms);
+}
+
+/// Instanced 3D vertex shader
+/// Same as vertex3D, with each instance's transform and color applied
+vertex RasterizerData3D vertex3DInstanced(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    constant Vertex3D* vertices [[buffer(0)]],
+    constant Uniforms3D& uniforms [[buffer(1)]],
+    constant InstanceData* instances [[buffer(2)]]
+) {
+    return transformVertex3DInstanced(vertices[vertexID], instances[instanceID], uniforms);
+}
+
+/// Instanced 3D vertex shader for PackedVertex3D input
+vertex RasterizerData3D vertex3DInstancedPacked(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    constant PackedVertex3D* vertices [[buffer(0)]],
+    constant Uniforms3D& uniforms [[buffer(1)]],
+    constant InstanceData* instances [[buffer(2)]]
+) {
+    return transformVertex3DInstanced(unpackVertex(vertices[vertexID]), instances[instanceID], uniforms);
+}
+
+// MARK: - Retained Vertex Shaders
+
+/// Transform of one indirect display list replay (matches RetainedReplay3D in MetalRenderer.mm)
+struct RetainedReplay3D {
+    float4x4 projectionMatrix;
+    float4x4 transform;         // Applied before the recorded model-view matrix
+};
+
+/// Recorded uniforms of a retained draw under the replay's transform and projection
+static Uniforms3D replayUniforms(constant Uniforms3D& recorded, constant RetainedReplay3D& replay) {
+    Uniforms3D uniforms;
+    uniforms.projectionMatrix = replay.projectionMatrix;
+    uniforms.modelViewMatrix = replay.transform * recorded.modelViewMatrix;
+    uniforms.normalMatrix = recorded.normalMatrix;
+    return uniforms;
+}
+
+/// vertex3D for draws encoded once into an indirect command buffer: the
+/// recorded uniforms stay resident, only the replay transform changes
+vertex RasterizerData3D vertex3DRetained(
+    uint vertexID [[vertex_id]],
+    constant Vertex3D* vertices [[buffer(0)]],
+    constant Uniforms3D& uniforms [[buffer(1)]],
+    constant RetainedReplay3D& replay [[buffer(3)]]
+) {
+    return transformVertex3D(vertices[vertexID], replayUniforms(uniforms, replay));
+}
+
+/// vertex3DRetained for PackedVertex3D input
+vertex RasterizerData3D vertex3DRetainedPacked(
+    uint vertexID [[vertex_id]],
+    constant PackedVertex3D* vertices [[buffer(0)]],
+    constant Uniforms3D& uniforms [[buffer(1)]],
+    constant RetainedReplay3D& replay [[buffer(3)]]
+) {
+    return transformVertex3D(unpackVertex(vertices[vertexID]), replayUniforms(uniforms, replay));
+}
+
+/// vertex3DInstanced for draws encoded into an indirect command buffer
+vertex RasterizerData3D vertex3DInstancedRetained(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    constant Vertex3D* vertices [[buffer(0)]],
+    constant Uniforms3D& uniforms [[buffer(1)]],
+    constant InstanceData* instances [[buffer(2)]],
+    constant RetainedReplay3D& replay [[buffer(3)]]
+) {
+    return transformVertex3DInstanced(vertices[vertexID], instances[instanceID],
+                                      replayUniforms(uniforms, replay));
+}
+
+/// vertex3DInstancedRetained for PackedVertex3D input
+vertex RasterizerData3D vertex3DInstancedRetainedPacked(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    constant PackedVertex3D* vertices [[buffer(0)]],
+    constant Uniforms3D& uniforms [[buffer(1)]],
+    constant InstanceData* instances [[buffer(2)]],
+    constant RetainedReplay3D& replay [[buffer(3)]]
+) {
+    return transformVertex3DInstanced(unpackVertex(vertices[vertexID]), instances[instanceID],
+                                      replayUniforms(uniforms, replay));
+}
+
 // MARK: - Fragment Shaders
 
 /// Basic 3D fragment shader (solid color)
@@ -44,6 +165,29 @@ fragment float4 fragment3D(
     return in.color;
 }
 
+/// fragment3D blended over [[color(0)]] with kProgrammableBlendMode (see BlendModes.h)
+fragment float4 fragment3DBlend(
+    RasterizerData3D in [[stage_in]],
+    float4 dst [[color(0)]]
+) {
+    return programmableBlend(in.color, dst);
+}
+
+/// fragment3D accumulated for weighted blended transparency (see Transparency.h)
+fragment TransparentFragment fragment3DTransparent(
+    RasterizerData3D in [[stage_in]]
+) {
+    return weightedTransparency(in.color, in.position.z);
+}
+
+/// The draw's object ID for the R32Uint picking target (see DrawCommand3D::objectId)
+fragment uint fragmentObjectId(
+    RasterizerData3D in [[stage_in]],
+    constant uint& objectId [[buffer(0)]]
+) {
+    return objectId;
+}
+
 /// Textured 3D fragment shader
 /// Samples texture and modulates with vertex color, no lighting
 fragment float4 fragment3DTextured(
@@ -98,3 +242,37 @@ fragment float4 fragment3DTexturedLit(
 
     return float4(color.rgb * lighting, color.a);
 }
+
+// MARK: - Transparency Composite
+
+struct TransparencyCompositeData {
+    float4 position [[position]];
+};
+
+/// Full-screen triangle of the transparency composite
+vertex TransparencyCompositeData vertexTransparencyComposite(
+    uint vertexID [[vertex_id]]
+) {
+    const float2 uv = float2((vertexID << 1) & 2, vertexID & 2);
+    TransparencyCompositeData out;
+    out.position = float4(uv * 2.0 - 1.0, 0.0, 1.0);
+    return out;
+}
+
+/// Resolves the accumulation pass over the pass's color: the weighted
+/// average of the transparent layers, covering 1 - revealage of the
+/// background. Draw with BlendMode::Alpha.
+fragment float4 fragmentTransparencyComposite(
+    TransparencyCompositeData in [[stage_in]],
+    texture2d<float, access::read> accumulation [[texture(0)]],
+    texture2d<float, access::read> revealage [[texture(1)]]
+) {
+    const uint2 pixel = uint2(in.position.xy);
+    const float revealed = revealage.read(pixel).r;
+    if (revealed >= 1.0) {
+        discard_fragment();     // No transparent layer here
+    }
+    const float4 sum = accumulation.read(pixel);
+    const float3 average = sum.rgb / max(sum.a, 1e-5);
+    return float4(average, 1.0 - revealed);
+}
@@ -0,0 +1,74 @@
+#ifndef BlendModes_h
+#define BlendModes_h
+
+#include <metal_stdlib>
+
+using namespace metal;
+
+// ============================================================================
+// Programmable Blending
+// The *Blend fragment variants read the destination through [[color(0)]]
+// (framebuffer fetch on Apple GPUs) and blend in the shader, so blend modes
+// without a fixed-function equivalent draw in the same render pass.
+// ============================================================================
+
+/// Function constant index of the blend mode (kProgrammableBlendModeIndex in MetalRenderer.mm)
+#define PROGRAMMABLE_BLEND_MODE_INDEX 8
+
+/// Blend mode of a *Blend variant (BlendMode in RenderTypes.h, 7-10);
+/// constant per pipeline, so each variant compiles to one blend function
+constant uint kProgrammableBlendMode [[function_constant(PROGRAMMABLE_BLEND_MODE_INDEX)]];
+
+// MARK: - Helper Functions
+
+/// Overlay blend: combines multiply and screen based on destination luminance
+inline float3 blend_overlay(float3 src, float3 dst) {
+    return mix(
+        2.0 * src * dst,
+        1.0 - 2.0 * (1.0 - src) * (1.0 - dst),
+        step(0.5, dst)
+    );
+}
+
+/// Soft light blend: subtle dodge/burn effect
+inline float3 blend_soft_light(float3 src, float3 dst) {
+    // Pegtop formula (smoother than Photoshop)
+    return (1.0 - 2.0 * src) * dst * dst + 2.0 * src * dst;
+}
+
+/// Hard light blend: overlay with src/dst swapped
+inline float3 blend_hard_light(float3 src, float3 dst) {
+    return mix(
+        2.0 * src * dst,
+        1.0 - 2.0 * (1.0 - src) * (1.0 - dst),
+        step(0.5, src)  // Note: uses src, not dst (unlike overlay)
+    );
+}
+
+/// Difference blend: absolute difference
+inline float3 blend_difference(float3 src, float3 dst) {
+    return abs(dst - src);
+}
+
+/// Blend a shaded fragment over the destination with kProgrammableBlendMode,
+/// then composite by the fragment's alpha
+inline float4 programmableBlend(float4 src, float4 dst) {
+    float3 blended;
+    switch (kProgrammableBlendMode) {
+        case 7:
+            blended = blend_overlay(src.rgb, dst.rgb);
+            break;
+        case 8:
+            blended = blend_soft_light(src.rgb, dst.rgb);
+            break;
+        case 9:
+            blended = blend_hard_light(src.rgb, dst.rgb);
+            break;
+        default:
+            blended = blend_difference(src.rgb, dst.rgb);
+            break;
+    }
+    return float4(mix(dst.rgb, blended, src.a), src.a + dst.a * (1.0 - src.a));
+}
+
+#endif /* BlendModes_h */
@@ -29,6 +29,94 @@ struct Vertex3D {
     float4 color    [[attribute(3)]];
 };
 
+/// Compressed 2D vertex (matches render::PackedVertex2D)
+struct PackedVertex2D {
+    float2 position;
+    uint texCoord;          // unorm16 u | v << 16
+    uint color;             // unorm8 RGBA, r in the low byte
+};
+
+/// Compressed 3D vertex (matches render::PackedVertex3D)
+struct PackedVertex3D {
+    packed_float3 position;
+    uint normalXY;          // snorm16 x | y << 16
+    uint normalZ;           // snorm16 z
+    uint texCoord;          // unorm16 u | v << 16
+    uint color;             // unorm8 RGBA, r in the low byte
+};
+
+/// Expand a packed 2D vertex for the Vertex2D shader bodies
+inline Vertex2D unpackVertex(PackedVertex2D in) {
+    Vertex2D out;
+    out.position = in.position;
+    out.texCoord = unpack_unorm2x16_to_float(in.texCoord);
+    out.color = unpack_unorm4x8_to_float(in.color);
+    return out;
+}
+
+/// Expand a packed 3D vertex for the Vertex3D shader bodies
+inline Vertex3D unpackVertex(PackedVertex3D in) {
+    Vertex3D out;
+    out.position = float3(in.position);
+    out.normal = float3(unpack_snorm2x16_to_float(in.normalXY), unpack_snorm2x16_to_float(in.normalZ).x);
+    out.texCoord = unpack_unorm2x16_to_float(in.texCoord);
+    out.color = unpack_unorm4x8_to_float(in.color);
+    return out;
+}
+
+/// Per-instance record for instanced 3D draws (matches render::InstanceData)
+struct InstanceData {
+    float4x4 modelMatrix;   // Applied before the model-view matrix
+    float4 color;           // Multiplied with the vertex color
+    float4 userData;        // Free for custom shaders
+};
+
+/// Per-shape record for SDF shape draws (matches render::ShapeInstance2D)
+struct ShapeInstance2D {
+    float2 center;          // Shape center
+    float2 axis;            // Unit x axis of the shape frame
+    float2 halfSize;        // Half extents along the frame axes
+    float cornerRadius;     // RoundedRect corner radius
+    float strokeWidth;      // Outline width, 0 = filled
+    float4 color;
+    uint kind;              // 0 = ellipse, 1 = rounded rect
+    uint padding[3];
+};
+
+/// Per-segment record for stroke draws (matches render::StrokeSegment2D)
+struct StrokeSegment2D {
+    float2 p0;              // Segment start
+    float2 p1;              // Segment end
+    float2 next;            // Point after p1 (flags bit 1)
+    float halfWidth;
+    uint flags;             // 1 = has previous segment, 2 = has next
+    float4 color;
+    uint join;              // 0 = miter, 1 = round, 2 = bevel
+    uint cap;               // 0 = butt, 1 = round, 2 = square
+    float miterLimit;
+    uint padding;
+};
+
+/// Per-path record for path fill draws (matches render::PathInstance2D)
+struct PathInstance2D {
+    float2 boundsMin;       // Bounds of the edges, in model space
+    float2 boundsMax;
+    float4 color;
+    uint segmentOffset;     // First edge in the path segment buffer
+    uint segmentCount;
+    uint fillRule;          // 0 = odd, 1 = nonzero, 2 = positive, 3 = negative, 4 = abs >= 2
+    uint padding;
+};
+
+/// One edge of a filled path (matches render::PathSegment2D)
+struct PathSegment2D {
+    float2 p0;
+    float2 p1;
+};
+
+/// Arc triangles per round join/cap (matches render::kStrokeArcTriangles)
+constant uint STROKE_ARC_TRIANGLES = 8;
+
 // MARK: - Uniform Buffers
 
 /// 2D rendering uniforms
@@ -62,4 +150,34 @@ struct RasterizerData3D {
     float3 worldPosition;
 };
 
+// MARK: - Culling
+
+/// Whether the bounding sphere lies at least partly inside the clip volume of m
+static bool insideFrustum(float4x4 m, float4 boundingSphere) {
+    // Clip-space planes from the combined matrix rows (Gribb/Hartmann)
+    float4 row0 = float4(m[0][0], m[1][0], m[2][0], m[3][0]);
+    float4 row1 = float4(m[0][1], m[1][1], m[2][1], m[3][1]);
+    float4 row2 = float4(m[0][2], m[1][2], m[2][2], m[3][2]);
+    float4 row3 = float4(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    // Near uses w + z (the GL range) which is looser than Metal's z >= 0,
+    // so the test stays conservative for either projection convention
+    float4 planes[6] = {
+        row3 + row0, row3 - row0,
+        row3 + row1, row3 - row1,
+        row3 + row2, row3 - row2
+    };
+
+    float4 center = float4(boundingSphere.xyz, 1.0);
+    float radius = boundingSphere.w;
+    for (int i = 0; i < 6; i++) {
+        // Planes are unnormalized; scale the radius instead
+        float distance = dot(planes[i], center);
+        if (distance < -radius * length(planes[i].xyz)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 #endif /* Common_h */
@@ -0,0 +1,180 @@
+#include <metal_stdlib>
+#include "Common.h"
+
+using namespace metal;
+
+// ============================================================================
+// GPU Instance Culling Compute Shaders
+// ============================================================================
+
+/// Indexed indirect draw arguments (matches MTLDrawIndexedPrimitivesIndirectArguments)
+struct IndirectArguments {
+    uint indexCount;
+    atomic_uint instanceCount;  // Reset to 0 by the CPU, incremented per visible instance
+    uint indexStart;
+    int baseVertex;
+    uint baseInstance;
+};
+
+/// Culling parameters (matches CullUniforms in VboMesh.mm)
+struct CullUniforms {
+    float4x4 modelViewProjection;   // Projection * View * Model, applied after the instance matrix
+    float4 boundingSphere;          // xyz = center in mesh space, w = radius
+    uint instanceCount;
+};
+
+/// Occlusion parameters (matches OcclusionUniforms in VboMesh.mm)
+struct OcclusionUniforms {
+    float4x4 modelViewProjection;   // Previous frame's, the one the pyramid was rendered with
+    uint levelCount;                // Mip levels of the pyramid
+};
+
+/// Whether the bounding sphere is behind the depth in the occlusion pyramid:
+/// the screen rectangle of its bounding box is tested at the level where it
+/// covers at most 2x2 texels, against the farthest depth of those texels
+static bool occluded(float4x4 m, float4 boundingSphere, uint levelCount,
+                     texture2d<float, access::read> pyramid) {
+    float2 minUV = float2(1.0);
+    float2 maxUV = float2(0.0);
+    float nearestDepth = 1.0;
+    for (uint i = 0; i < 8; i++) {
+        float3 corner = boundingSphere.xyz + boundingSphere.w * float3((i & 1) ? 1.0 : -1.0,
+                                                                        (i & 2) ? 1.0 : -1.0,
+                                                                        (i & 4) ? 1.0 : -1.0);
+        float4 clip = m * float4(corner, 1.0);
+        if (clip.w <= 1e-5) {
+            return false;   // Reaches behind the camera
+        }
+        float3 ndc = clip.xyz / clip.w;
+        float2 uv = float2(ndc.x * 0.5 + 0.5, 0.5 - ndc.y * 0.5);
+        minUV = min(minUV, uv);
+        maxUV = max(maxUV, uv);
+        nearestDepth = min(nearestDepth, ndc.z);
+    }
+    if (nearestDepth <= 0.0) {
+        return false;       // Crosses the near plane
+    }
+    minUV = saturate(minUV);
+    maxUV = saturate(maxUV);
+
+    // Texel (x, y) of level L covers level 0 texels [x, x + 1) * 2^L
+    float2 size0 = float2(pyramid.get_width(0), pyramid.get_height(0));
+    float2 extent = (maxUV - minUV) * size0;
+    uint level = min(uint(ceil(log2(max(max(extent.x, extent.y), 1.0)))), levelCount - 1);
+    uint2 size = uint2(pyramid.get_width(level), pyramid.get_height(level));
+    uint2 lower = min(uint2(minUV * size0) >> level, size - 1);
+    uint2 upper = min(uint2(maxUV * size0) >> level, size - 1);
+
+    float farthest = max(max(pyramid.read(lower, level).r, pyramid.read(uint2(upper.x, lower.y), level).r),
+                         max(pyramid.read(uint2(lower.x, upper.y), level).r, pyramid.read(upper, level).r));
+    return nearestDepth > farthest;
+}
+
+/**
+ * Frustum-cull instances against the mesh's bounding sphere.
+ * Visible instances are compacted into `visible` and counted into the
+ * indirect arguments, so one drawIndexedPrimitives:indirectBuffer: draws
+ * exactly the survivors. Output order is not preserved.
+ *
+ * Dispatch with one thread per instance.
+ */
+kernel void cullInstances(
+    constant InstanceData* instances [[buffer(0)]],
+    device InstanceData* visible [[buffer(1)]],
+    device IndirectArguments& args [[buffer(2)]],
+    constant CullUniforms& uniforms [[buffer(3)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    if (tid >= uniforms.instanceCount) {
+        return;
+    }
+
+    InstanceData instance = instances[tid];
+    if (!insideFrustum(uniforms.modelViewProjection * instance.modelMatrix, uniforms.boundingSphere)) {
+        return;
+    }
+
+    uint slot = atomic_fetch_add_explicit(&args.instanceCount, 1, memory_order_relaxed);
+    visible[slot] = instance;
+}
+
+/**
+ * cullInstances, then occlusion-cull the survivors against the previous
+ * frame's depth pyramid (MetalRenderer's occlusion pyramid), projected with
+ * the previous frame's matrices so instances test against the depth they
+ * were drawn over. Instances near or behind the camera are kept.
+ *
+ * Dispatch with one thread per instance.
+ */
+kernel void cullInstancesOcclusion(
+    constant InstanceData* instances [[buffer(0)]],
+    device InstanceData* visible [[buffer(1)]],
+    device IndirectArguments& args [[buffer(2)]],
+    constant OcclusionUniforms& occlusion [[buffer(3)]],
+    constant CullUniforms& uniforms [[buffer(4)]],
+    texture2d<float, access::read> pyramid [[texture(0)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    if (tid >= uniforms.instanceCount) {
+        return;
+    }
+
+    InstanceData instance = instances[tid];
+    if (!insideFrustum(uniforms.modelViewProjection * instance.modelMatrix, uniforms.boundingSphere) ||
+        occluded(occlusion.modelViewProjection * instance.modelMatrix, uniforms.boundingSphere,
+                 occlusion.levelCount, pyramid)) {
+        return;
+    }
+
+    uint slot = atomic_fetch_add_explicit(&args.instanceCount, 1, memory_order_relaxed);
+    visible[slot] = instance;
+}
+
+// ============================================================================
+// Occlusion Pyramid
+// ============================================================================
+
+/**
+ * Level 0 of the occlusion pyramid: the screen's depth as R32Float.
+ *
+ * Dispatch with one thread per pixel.
+ */
+kernel void occlusionReduceDepth(
+    depth2d<float, access::read> depth [[texture(0)]],
+    texture2d<float, access::write> destination [[texture(1)]],
+    uint2 gid [[thread_position_in_grid]]
+) {
+    if (gid.x >= destination.get_width() || gid.y >= destination.get_height()) {
+        return;
+    }
+    destination.write(float4(depth.read(gid)), gid);
+}
+
+/**
+ * Next level of the occlusion pyramid: the farthest of the 2x2 source
+ * texels. Mip sizes round down, so the last texel of a row or column also
+ * takes the odd source texel past it (up to 3x3).
+ *
+ * Dispatch with one thread per destination texel.
+ */
+kernel void occlusionReduce(
+    texture2d<float, access::read> source [[texture(0)]],
+    texture2d<float, access::write> destination [[texture(1)]],
+    uint2 gid [[thread_position_in_grid]]
+) {
+    const uint2 size = uint2(destination.get_width(), destination.get_height());
+    if (gid.x >= size.x || gid.y >= size.y) {
+        return;
+    }
+    const uint2 last = uint2(source.get_width(), source.get_height()) - 1;
+    const uint2 lower = min(gid * 2, last);
+    const uint2 upper = select(min(gid * 2 + 1, last), last, gid == size - 1);
+
+    float farthest = 0.0;
+    for (uint y = lower.y; y <= upper.y; y++) {
+        for (uint x = lower.x; x <= upper.x; x++) {
+            farthest = max(farthest, source.read(uint2(x, y)).r);
+        }
+    }
+    destination.write(float4(farthest), gid);
+}
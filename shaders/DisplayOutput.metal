@@ -0,0 +1,69 @@
+#include <metal_stdlib>
+
+using namespace metal;
+
+// ============================================================================
+// Display Outputs (Slice, Warp, Edge Blend)
+// ============================================================================
+
+// Each extra display draws its slice of the shared source texture through a
+// warp mesh built on the CPU (subdivided grid cells, bilinear between the
+// control points), fading the slice's edges where projectors overlap.
+
+/// Warp mesh vertex (matches DisplayOutputVertex in MetalRenderer.mm)
+struct DisplayOutputVertex {
+    float2 position;        // On the display, 0-1 from the top-left
+    float2 slice;           // In the slice, 0-1 from the top-left
+};
+
+/// Per-output parameters (matches DisplayOutputUniforms in MetalRenderer.mm)
+struct DisplayOutputUniforms {
+    float4 source;          // Slice of the source texture (x, y, width, height), 0-1
+    float4 blendWidth;      // Left, right, top, bottom, fractions of the slice
+    float blendCurve;
+    float blendGamma;
+};
+
+struct DisplayOutputData {
+    float4 position [[position]];
+    float2 slice;
+};
+
+vertex DisplayOutputData vertexDisplayOutput(
+    uint vertexID [[vertex_id]],
+    device const DisplayOutputVertex* vertices [[buffer(0)]]
+) {
+    DisplayOutputVertex v = vertices[vertexID];
+    DisplayOutputData out;
+    out.position = float4(v.position.x * 2.0 - 1.0, 1.0 - v.position.y * 2.0, 0.0, 1.0);
+    out.slice = v.slice;
+    return out;
+}
+
+/// Blend ramp over t in 0-1 (0 = outer edge) whose mirror image sums to 1
+static float blendRamp(float t, float curve) {
+    t = saturate(t);
+    return t < 0.5 ? 0.5 * pow(2.0 * t, curve) : 1.0 - 0.5 * pow(2.0 * (1.0 - t), curve);
+}
+
+fragment float4 fragmentDisplayOutput(
+    DisplayOutputData in [[stage_in]],
+    constant DisplayOutputUniforms& uniforms [[buffer(0)]],
+    texture2d<float> source [[texture(0)]]
+) {
+    constexpr sampler linearSampler(filter::linear, address::clamp_to_zero);
+    const float2 slice = in.slice;
+    float4 color = source.sample(linearSampler, uniforms.source.xy + slice * uniforms.source.zw);
+
+    // Edges fade in linear light, encoded for the display's gamma
+    const float4 width = uniforms.blendWidth;
+    const float4 distance = float4(slice.x, 1.0 - slice.x, slice.y, 1.0 - slice.y);
+    float blend = 1.0;
+    for (int i = 0; i < 4; i++) {
+        if (width[i] > 0.0) {
+            blend *= blendRamp(distance[i] / width[i], uniforms.blendCurve);
+        }
+    }
+    color.rgb *= pow(blend, 1.0 / uniforms.blendGamma);
+    return float4(color.rgb, 1.0);
+}
@@ -0,0 +1,91 @@
+#ifndef GaussianCompressed_h
+#define GaussianCompressed_h
+
+#include <metal_stdlib>
+using namespace metal;
+
+// ============================================================================
+// Compressed Gaussian Storage (matches Sharp::GaussianCloud's compressed buffer)
+// ============================================================================
+
+// Gaussian shaders are compiled twice: for the full upload layout and,
+// with function constant 0 set, for GaussianCloud's compressed buffer.
+// Unspecialized functions read the full layout.
+constant bool kCompressedInput [[function_constant(0)]];
+constant bool kCompressedGaussians = is_function_constant_defined(kCompressedInput) && kCompressedInput;
+constant bool kFullGaussians = !kCompressedGaussians;
+
+// Compressed buffers bind after every kernel's own arguments
+#define COMPRESSED_SPLATS_INDEX 8
+#define COMPRESSED_CHUNKS_INDEX 9
+#define COMPRESSED_CODEBOOK_INDEX 10
+
+constant uint COMPRESSED_CHUNK_SIZE = 256;     // Splats sharing position bounds
+constant uint SH_CODEBOOK_STRIDE = 48;         // Halves per entry (45 used)
+
+/// One splat, 28 bytes
+struct CompressedGaussian {
+    ushort position[3];     // Unorm16 within the chunk's bounds
+    ushort shIndex;         // SH codebook entry
+    half scale[3];
+    uchar opacity;          // Unorm8
+    uchar padding;
+    uint rotation;          // Smallest three: largest index in bits 30-31, 3 x 10 bits
+    half color[3];          // sh_dc
+    ushort padding2;
+};
+
+struct CompressedChunk {
+    float3 positionMin;
+    float3 positionExtent;  // max - min, 0 on flat axes
+};
+
+/// Everything the rasterizers read from one Gaussian
+struct DecodedGaussian {
+    float3 position;
+    float3 scale;
+    float4 rotation;        // (x, y, z, w)
+    float opacity;
+    float3 color;           // sh_dc
+    uint shIndex;
+};
+
+inline float4 decodeRotation(uint packed) {
+    const float range = 0.70710678;    // Smaller components lie in +-1/sqrt(2)
+    uint largest = packed >> 30;
+    float3 small = float3((packed >> 20) & 0x3FF, (packed >> 10) & 0x3FF, packed & 0x3FF) / 1023.0;
+    small = small * (2.0 * range) - range;
+    float w = sqrt(max(0.0, 1.0 - dot(small, small)));
+
+    float4 q;
+    uint s = 0;
+    for (uint i = 0; i < 4; i++) {
+        q[i] = (i == largest) ? w : small[s++];
+    }
+    return q;
+}
+
+inline DecodedGaussian decodeGaussian(device const CompressedGaussian* splats,
+                                      device const CompressedChunk* chunks,
+                                      uint index) {
+    CompressedGaussian c = splats[index];
+    CompressedChunk chunk = chunks[index / COMPRESSED_CHUNK_SIZE];
+
+    DecodedGaussian g;
+    float3 t = float3(c.position[0], c.position[1], c.position[2]) / 65535.0;
+    g.position = chunk.positionMin + t * chunk.positionExtent;
+    g.scale = float3(c.scale[0], c.scale[1], c.scale[2]);
+    g.rotation = decodeRotation(c.rotation);
+    g.opacity = float(c.opacity) / 255.0;
+    g.color = float3(c.color[0], c.color[1], c.color[2]);
+    g.shIndex = c.shIndex;
+    return g;
+}
+
+/// Higher-order SH coefficient i (0-14) of a codebook entry, RGB
+inline float3 decodeSH(device const half* codebook, uint entry, uint i) {
+    device const half* sh = codebook + entry * SH_CODEBOOK_STRIDE + i * 3;
+    return float3(sh[0], sh[1], sh[2]);
+}
+
+#endif /* GaussianCompressed_h */
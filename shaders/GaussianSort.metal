@@ -1,4 +1,5 @@
 #include <metal_stdlib>
+#include "GaussianCompressed.h"
 using namespace metal;
 
 // ============================================================================
@@ -128,6 +129,430 @@ kernel void radixSortCopyBack(
     }
 }
 
+// ============================================================================
+// LSD Radix Sort over Depth Keys (used by SharpRenderer)
+// ============================================================================
+
+// 8-bit digits, least significant first: one histogram, scan and scatter
+// dispatch per digit, all encoded into the frame's command buffer.
+// Keys are view-space depths mapped to uints that sort like the floats;
+// values are Gaussian indices. Every pass is stable, so 2 passes sort
+// 16-bit keys (the top half of the depth) and 4 sort full 32-bit keys.
+constant uint RADIX_BINS = 256;
+constant uint RADIX_THREADS = 256;             // Threads per block (one per bin)
+constant uint RADIX_ITEMS = 8;                 // Keys per thread
+constant uint RADIX_BLOCK = RADIX_THREADS * RADIX_ITEMS;
+constant uint RADIX_MAX_SIMDGROUPS = 8;        // RADIX_THREADS / 32
+
+// Must match SharpRenderer.mm
+struct RadixParams {
+    uint count;         // Keys to sort
+    uint blockCount;    // ceil(count / RADIX_BLOCK)
+    uint shift;         // Bit offset of this pass's digit
+};
+
+struct DepthParams {
+    float4 viewRow;     // Third row of the view matrix (view-space z)
+    uint count;
+};
+
+// Mirrors SharpRenderer's GaussianVertex upload layout
+struct SortGaussian {
+    float3 position;
+    float3 scale;
+    float4 rotation;
+    float opacity;
+    float3 sh_dc;
+    float padding;
+    float sh_coefficients[45];
+};
+
+// Float to uint keeping order: flip all bits of negatives, the sign of the rest
+static uint sortableDepth(float depth) {
+    uint bits = as_type<uint>(depth);
+    return bits ^ ((bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u);
+}
+
+/**
+ * Depth keys for every Gaussian. Ascending view-space z is back-to-front
+ * (the camera looks down -z), so the ascending sort is the draw order.
+ */
+kernel void gaussianProjectDepth(
+    device const SortGaussian* gaussians [[buffer(0), function_constant(kFullGaussians)]],
+    device uint* keys [[buffer(1)]],
+    device uint* values [[buffer(2)]],
+    constant DepthParams& params [[buffer(3)]],
+    device const CompressedGaussian* compressed [[buffer(COMPRESSED_SPLATS_INDEX), function_constant(kCompressedGaussians)]],
+    device const CompressedChunk* chunks [[buffer(COMPRESSED_CHUNKS_INDEX), function_constant(kCompressedGaussians)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    if (tid >= params.count) {
+        return;
+    }
+    float3 position = kCompressedGaussians ? decodeGaussian(compressed, chunks, tid).position
+                                           : gaussians[tid].position;
+    float depth = dot(params.viewRow, float4(position, 1.0));
+    keys[tid] = sortableDepth(depth);
+    values[tid] = tid;
+}
+
+/**
+ * Digit counts of one block, stored digit-major (digit * blockCount + block)
+ * so one exclusive scan turns them into every block's scatter offsets.
+ * Dispatch: blockCount threadgroups of RADIX_THREADS.
+ */
+kernel void gaussianRadixHistogram(
+    device const uint* keys [[buffer(0)]],
+    device uint* blockHistograms [[buffer(1)]],
+    constant RadixParams& params [[buffer(2)]],
+    uint lid [[thread_position_in_threadgroup]],
+    uint block [[threadgroup_position_in_grid]]
+) {
+    threadgroup atomic_uint histogram[RADIX_BINS];
+    atomic_store_explicit(&histogram[lid], 0, memory_order_relaxed);
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+
+    const uint start = block * RADIX_BLOCK;
+    for (uint i = 0; i < RADIX_ITEMS; i++) {
+        uint index = start + i * RADIX_THREADS + lid;
+        if (index < params.count) {
+            uint digit = (keys[index] >> params.shift) & (RADIX_BINS - 1);
+            atomic_fetch_add_explicit(&histogram[digit], 1, memory_order_relaxed);
+        }
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+
+    blockHistograms[lid * params.blockCount + block] =
+        atomic_load_explicit(&histogram[lid], memory_order_relaxed);
+}
+
+/**
+ * In-place exclusive prefix sum of the block histograms, by a single
+ * threadgroup walking the array with a running carry.
+ * Dispatch: one threadgroup (a multiple of the SIMD width, up to 1024).
+ */
+kernel void gaussianRadixScan(
+    device uint* data [[buffer(0)]],
+    constant uint& length [[buffer(1)]],
+    uint lid [[thread_position_in_threadgroup]],
+    uint threads [[threads_per_threadgroup]],
+    uint simdLane [[thread_index_in_simdgroup]],
+    uint simdGroup [[simdgroup_index_in_threadgroup]],
+    uint simdWidth [[threads_per_simdgroup]],
+    uint simdCount [[simdgroups_per_threadgroup]]
+) {
+    threadgroup uint simdOffsets[32];
+    threadgroup uint carry;
+    if (lid == 0) {
+        carry = 0;
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+
+    for (uint base = 0; base < length; base += threads) {
+        uint index = base + lid;
+        uint value = index < length ? data[index] : 0;
+        uint prefix = simd_prefix_exclusive_sum(value);
+        if (simdLane == simdWidth - 1) {
+            simdOffsets[simdGroup] = prefix + value;
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+
+        if (simdGroup == 0) {
+            uint total = simdLane < simdCount ? simdOffsets[simdLane] : 0;
+            uint offset = simd_prefix_exclusive_sum(total);
+            if (simdLane < simdCount) {
+                simdOffsets[simdLane] = offset;
+            }
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+
+        uint running = carry + simdOffsets[simdGroup] + prefix;
+        if (index < length) {
+            data[index] = running;
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+
+        if (lid == threads - 1) {
+            carry = running + value;
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+    }
+}
+
+/**
+ * Stable scatter of one block to its scanned offsets. Keys are ranked a
+ * row of RADIX_THREADS at a time: SIMD ballots over the digit bits find the
+ * lanes holding the same digit, and per-SIMD-group counts order the groups.
+ * Dispatch: blockCount threadgroups of RADIX_THREADS.
+ */
+kernel void gaussianRadixScatter(
+    device const uint* keysIn [[buffer(0)]],
+    device const uint* valuesIn [[buffer(1)]],
+    device uint* keysOut [[buffer(2)]],
+    device uint* valuesOut [[buffer(3)]],
+    device const uint* blockOffsets [[buffer(4)]],
+    constant RadixParams& params [[buffer(5)]],
+    uint lid [[thread_position_in_threadgroup]],
+    uint block [[threadgroup_position_in_grid]],
+    uint simdLane [[thread_index_in_simdgroup]],
+    uint simdGroup [[simdgroup_index_in_threadgroup]],
+    uint simdCount [[simdgroups_per_threadgroup]]
+) {
+    threadgroup uint digitOffsets[RADIX_BINS];
+    threadgroup uint simdCounts[RADIX_MAX_SIMDGROUPS][RADIX_BINS];
+
+    digitOffsets[lid] = blockOffsets[lid * params.blockCount + block];
+    for (uint s = 0; s < RADIX_MAX_SIMDGROUPS; s++) {
+        simdCounts[s][lid] = 0;
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+
+    const simd_vote::vote_t lanesBelow = (simd_vote::vote_t(1) << simdLane) - 1;
+    const uint start = block * RADIX_BLOCK;
+    for (uint i = 0; i < RADIX_ITEMS; i++) {
+        uint index = start + i * RADIX_THREADS + lid;
+        bool valid = index < params.count;
+        uint key = valid ? keysIn[index] : 0;
+        uint digit = (key >> params.shift) & (RADIX_BINS - 1);
+
+        // Lanes of this SIMD group with the same digit
+        simd_vote::vote_t peers = simd_vote::vote_t(simd_ballot(valid));
+        for (uint bit = 0; bit < 8; bit++) {
+            bool set = (digit >> bit) & 1;
+            simd_vote::vote_t vote = simd_vote::vote_t(simd_ballot(set));
+            peers &= set ? vote : ~vote;
+        }
+        uint rank = uint(popcount(peers & lanesBelow));
+        if (valid && rank == 0) {
+            simdCounts[simdGroup][digit] = uint(popcount(peers));
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+
+        if (valid) {
+            uint offset = digitOffsets[digit] + rank;
+            for (uint s = 0; s < simdGroup; s++) {
+                offset += simdCounts[s][digit];
+            }
+            keysOut[offset] = key;
+            valuesOut[offset] = valuesIn[index];
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+
+        // Advance each digit past this row
+        uint rowCount = 0;
+        for (uint s = 0; s < simdCount; s++) {
+            rowCount += simdCounts[s][lid];
+            simdCounts[s][lid] = 0;
+        }
+        digitOffsets[lid] += rowCount;
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+    }
+}
+
+// ============================================================================
+// Visibility Culling with Stream Compaction (used by SharpRenderer)
+// ============================================================================
+
+// Splats outside the frustum, under half a pixel or nearly transparent
+// never reach the sort: survivors are appended to the key/value arrays
+// with one atomic per SIMD group, and a setup thread turns their count
+// into the radix sort's parameters and the draw's instance count.
+
+// Setup buffer, in words; constant blocks sit in 256-byte slots
+constant uint CULL_SLOT = 64;
+constant uint CULL_SCAN_LENGTH = 4 * CULL_SLOT;        // RadixParams per pass in slots 0-3
+constant uint CULL_VISIBLE = 5 * CULL_SLOT;            // Survivor counter
+constant uint CULL_BLOCK_GROUPS = CULL_VISIBLE + 1;    // Radix dispatch arguments
+constant uint CULL_DRAW = CULL_VISIBLE + 4;            // Indirect draw arguments
+
+// Must match SharpRenderer.mm
+struct CullParams {
+    float4x4 viewMatrix;
+    float4x4 viewProjectionMatrix;
+    float2 focal;           // Pixels per unit at unit depth
+    float2 viewportSize;
+    uint count;
+    float splatScale;
+    float opacityScale;
+    float minOpacity;
+    float minRadius;        // Projected radius in pixels
+};
+
+/**
+ * Depth keys of the Gaussians that can show up on screen, compacted.
+ * Dispatch: ceil(count / RADIX_THREADS) threadgroups of RADIX_THREADS.
+ */
+kernel void gaussianCullProject(
+    device const SortGaussian* gaussians [[buffer(0), function_constant(kFullGaussians)]],
+    device uint* keys [[buffer(1)]],
+    device uint* values [[buffer(2)]],
+    device atomic_uint* setup [[buffer(3)]],
+    constant CullParams& params [[buffer(4)]],
+    device const CompressedGaussian* compressed [[buffer(COMPRESSED_SPLATS_INDEX), function_constant(kCompressedGaussians)]],
+    device const CompressedChunk* chunks [[buffer(COMPRESSED_CHUNKS_INDEX), function_constant(kCompressedGaussians)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    // No early return: every lane takes part in the SIMD compaction
+    bool visible = false;
+    float depth = 0.0;
+    if (tid < params.count) {
+        DecodedGaussian g;
+        if (kCompressedGaussians) {
+            g = decodeGaussian(compressed, chunks, tid);
+        } else {
+            g.position = gaussians[tid].position;
+            g.scale = gaussians[tid].scale;
+            g.opacity = gaussians[tid].opacity;
+        }
+        float4 world = float4(g.position, 1.0);
+        depth = (params.viewMatrix * world).z;
+        float4 clip = params.viewProjectionMatrix * world;
+
+        // 3 sigma along the largest axis, in pixels
+        float extent = 3.0 * max(g.scale.x, max(g.scale.y, g.scale.z)) * params.splatScale;
+        float radius = extent * params.focal.y / max(-depth, 1e-4);
+        float2 margin = 1.0 + 2.0 * radius / params.viewportSize;
+        float2 ndc = clip.xy / clip.w;
+
+        visible = clip.w > 0.0 && clip.z <= clip.w &&
+                  all(abs(ndc) <= margin) &&
+                  radius >= params.minRadius &&
+                  g.opacity * params.opacityScale >= params.minOpacity;
+    }
+
+    uint rank = simd_prefix_exclusive_sum(visible ? 1u : 0u);
+    uint total = simd_sum(visible ? 1u : 0u);
+    uint base = 0;
+    if (simd_is_first() && total > 0) {
+        base = atomic_fetch_add_explicit(&setup[CULL_VISIBLE], total, memory_order_relaxed);
+    }
+    base = simd_broadcast_first(base);
+
+    if (visible) {
+        keys[base + rank] = sortableDepth(depth);
+        values[base + rank] = tid;
+    }
+}
+
+/**
+ * Sort parameters, dispatch and draw arguments for the survivors.
+ * Dispatch: one thread.
+ */
+kernel void gaussianCullSetup(
+    device uint* setup [[buffer(0)]],
+    constant uint& firstShift [[buffer(1)]]
+) {
+    uint count = setup[CULL_VISIBLE];
+    uint blockCount = (count + RADIX_BLOCK - 1) / RADIX_BLOCK;
+    for (uint pass = 0; pass < 4; pass++) {
+        device RadixParams& params = *(device RadixParams*)(setup + pass * CULL_SLOT);
+        params.count = count;
+        params.blockCount = blockCount;
+        params.shift = firstShift + pass * 8;
+    }
+    setup[CULL_SCAN_LENGTH] = blockCount * RADIX_BINS;
+    setup[CULL_BLOCK_GROUPS] = blockCount;
+    setup[CULL_BLOCK_GROUPS + 1] = 1;
+    setup[CULL_BLOCK_GROUPS + 2] = 1;
+
+    // MTLDrawPrimitivesIndirectArguments: one 4-vertex strip per survivor
+    setup[CULL_DRAW] = 4;
+    setup[CULL_DRAW + 1] = count;
+    setup[CULL_DRAW + 2] = 0;
+    setup[CULL_DRAW + 3] = 0;
+}
+
+// ============================================================================
+// Incremental Re-sort (temporal coherence, used by SharpRenderer)
+// ============================================================================
+
+// Between nearby frames last frame's order is almost right: keys are
+// recomputed in that order and only local disorder is repaired, by
+// bitonic sorting windows in threadgroup memory. A second dispatch with
+// the windows shifted by half lets elements cross window edges.
+constant uint LOCAL_SORT_WINDOW = 1024;
+constant uint LOCAL_SORT_THREADS = LOCAL_SORT_WINDOW / 2;
+
+// Must match SharpRenderer.mm
+struct LocalSortParams {
+    uint count;
+    uint offset;        // First element of the first window
+};
+
+/**
+ * Depth keys in the previous frame's order (values hold that order).
+ */
+kernel void gaussianReprojectDepth(
+    device const SortGaussian* gaussians [[buffer(0), function_constant(kFullGaussians)]],
+    device uint* keys [[buffer(1)]],
+    device const uint* values [[buffer(2)]],
+    constant DepthParams& params [[buffer(3)]],
+    device const CompressedGaussian* compressed [[buffer(COMPRESSED_SPLATS_INDEX), function_constant(kCompressedGaussians)]],
+    device const CompressedChunk* chunks [[buffer(COMPRESSED_CHUNKS_INDEX), function_constant(kCompressedGaussians)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    if (tid >= params.count) {
+        return;
+    }
+    uint index = values[tid];
+    float3 position = kCompressedGaussians ? decodeGaussian(compressed, chunks, index).position
+                                           : gaussians[index].position;
+    float depth = dot(params.viewRow, float4(position, 1.0));
+    keys[tid] = sortableDepth(depth);
+}
+
+/**
+ * Sort every LOCAL_SORT_WINDOW keys from params.offset in place.
+ * Dispatch: ceil((count - offset) / LOCAL_SORT_WINDOW) threadgroups of
+ * LOCAL_SORT_THREADS.
+ */
+kernel void gaussianLocalSort(
+    device uint* keys [[buffer(0)]],
+    device uint* values [[buffer(1)]],
+    constant LocalSortParams& params [[buffer(2)]],
+    uint lid [[thread_position_in_threadgroup]],
+    uint group [[threadgroup_position_in_grid]]
+) {
+    threadgroup uint sharedKeys[LOCAL_SORT_WINDOW];
+    threadgroup uint sharedValues[LOCAL_SORT_WINDOW];
+
+    // Past the end pads with the largest key, which sorts last
+    const uint start = params.offset + group * LOCAL_SORT_WINDOW;
+    for (uint i = lid; i < LOCAL_SORT_WINDOW; i += LOCAL_SORT_THREADS) {
+        uint index = start + i;
+        bool valid = index < params.count;
+        sharedKeys[i] = valid ? keys[index] : 0xFFFFFFFFu;
+        sharedValues[i] = valid ? values[index] : 0;
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+
+    for (uint size = 2; size <= LOCAL_SORT_WINDOW; size <<= 1) {
+        for (uint stride = size >> 1; stride > 0; stride >>= 1) {
+            uint a = 2 * lid - (lid & (stride - 1));
+            uint b = a + stride;
+            bool ascending = (a & size) == 0;
+            uint keyA = sharedKeys[a];
+            uint keyB = sharedKeys[b];
+            if ((keyA > keyB) == ascending) {
+                sharedKeys[a] = keyB;
+                sharedKeys[b] = keyA;
+                uint value = sharedValues[a];
+                sharedValues[a] = sharedValues[b];
+                sharedValues[b] = value;
+            }
+            threadgroup_barrier(mem_flags::mem_threadgroup);
+        }
+    }
+
+    for (uint i = lid; i < LOCAL_SORT_WINDOW; i += LOCAL_SORT_THREADS) {
+        uint index = start + i;
+        if (index < params.count) {
+            keys[index] = sharedKeys[i];
+            values[index] = sharedValues[i];
+        }
+    }
+}
+
 // ============================================================================
 // Quick Sort (Recursive, good for medium datasets)
 // ============================================================================
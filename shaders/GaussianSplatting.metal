@@ -1,5 +1,6 @@
 #include <metal_stdlib>
 #include <simd/simd.h>
+#include "GaussianCompressed.h"
 using namespace metal;
 
 // ============================================================================
@@ -15,6 +16,17 @@ struct Gaussian {
     float3 sh_rest[15];     // SH coefficients degrees 1-3
 };
 
+// Mirrors SharpRenderer's GaussianVertex upload layout
+struct GaussianUpload {
+    float3 position;
+    float3 scale;
+    float4 rotation;        // Quaternion (x, y, z, w)
+    float opacity;
+    float3 sh_dc;
+    float padding;
+    float sh_coefficients[45];  // Degrees 1-3, RGB per coefficient
+};
+
 struct GaussianUniforms {
     float4x4 viewMatrix;
     float4x4 projectionMatrix;
@@ -102,7 +114,7 @@ float3 evaluateSH3(float3 sh[7], float3 dir) {
     return result;
 }
 
-float3 evaluateSphericalHarmonics(constant Gaussian& gaussian,
+float3 evaluateSphericalHarmonics(thread const Gaussian& gaussian,
                                    float3 viewDir,
                                    int maxDegree) {
     // Start with DC component (degree 0)
@@ -129,7 +141,7 @@ float3 evaluateSphericalHarmonics(constant Gaussian& gaussian,
 // ============================================================================
 
 // Compute 3D covariance matrix from scale and rotation
-float3x3 computeCovariance3D(constant Gaussian& gaussian) {
+float3x3 computeCovariance3D(thread const Gaussian& gaussian) {
     // Create scale matrix
     float3x3 S = float3x3(
         gaussian.scale.x, 0, 0,
@@ -215,18 +227,31 @@ void projectCovariance3Dto2D(float3x3 cov3D,
 // Vertex Shader
 // ============================================================================
 
-vertex GaussianVertex gaussianSplattingVertex(
-    uint vertexID [[vertex_id]],
-    uint instanceID [[instance_id]],
-    constant Gaussian* gaussians [[buffer(0)]],
-    constant uint* sortedIndices [[buffer(1)]],
-    constant GaussianUniforms& uniforms [[buffer(2)]]
-) {
-    GaussianVertex out;
+// A splat as the vertex shaders read it, from either layout
+inline Gaussian uploadedSplat(device const GaussianUpload& g) {
+    Gaussian gaussian;
+    gaussian.position = g.position;
+    gaussian.scale = g.scale;
+    gaussian.rotation.vector = g.rotation;
+    gaussian.opacity = g.opacity;
+    return gaussian;
+}
 
-    // Get Gaussian for this instance (sorted order)
-    uint gaussianIndex = sortedIndices[instanceID];
-    constant Gaussian& gaussian = gaussians[gaussianIndex];
+inline Gaussian compressedSplat(device const CompressedGaussian* compressed,
+                                device const CompressedChunk* chunks, uint index) {
+    DecodedGaussian decoded = decodeGaussian(compressed, chunks, index);
+    Gaussian gaussian;
+    gaussian.position = decoded.position;
+    gaussian.scale = decoded.scale;
+    gaussian.rotation.vector = decoded.rotation;
+    gaussian.opacity = decoded.opacity;
+    return gaussian;
+}
+
+// One corner of a splat's screen-space quad for one view
+inline GaussianVertex splatVertex(uint vertexID, Gaussian gaussian, constant GaussianUniforms& uniforms,
+                                  half4 color) {
+    GaussianVertex out;
 
     // Billboard quad vertices (4 vertices per Gaussian)
     // vertexID: 0, 1, 2, 3 for quad corners
@@ -280,9 +305,7 @@ vertex GaussianVertex gaussianSplattingVertex(
     out.position = float4(ndcPos.xy + ndcOffset, ndcPos.z, 1.0);
     out.uv = localPos;
 
-    // Evaluate spherical harmonics for color
-    float3 viewDir = normalize(gaussian.position - uniforms.cameraPosition);
-    out.color = evaluateSphericalHarmonics(gaussian, viewDir, uniforms.maxSHDegree);
+    out.color = float3(color.rgb);
 
     // Opacity
     out.opacity = gaussian.opacity * uniforms.opacityScale;
@@ -294,24 +317,113 @@ vertex GaussianVertex gaussianSplattingVertex(
     return out;
 }
 
+vertex GaussianVertex gaussianSplattingVertex(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    device const GaussianUpload* gaussians [[buffer(0), function_constant(kFullGaussians)]],
+    constant uint* sortedIndices [[buffer(1)]],
+    constant GaussianUniforms& uniforms [[buffer(2)]],
+    device const half4* colors [[buffer(3)]],
+    device const CompressedGaussian* compressed [[buffer(COMPRESSED_SPLATS_INDEX), function_constant(kCompressedGaussians)]],
+    device const CompressedChunk* chunks [[buffer(COMPRESSED_CHUNKS_INDEX), function_constant(kCompressedGaussians)]]
+) {
+    // Get Gaussian for this instance (sorted order), from either layout;
+    // its color comes from the SH pre-pass (gaussianEvaluateSH)
+    uint gaussianIndex = sortedIndices[instanceID];
+    Gaussian gaussian = kCompressedGaussians ? compressedSplat(compressed, chunks, gaussianIndex)
+                                             : uploadedSplat(gaussians[gaussianIndex]);
+    return splatVertex(vertexID, gaussian, uniforms, colors[gaussianIndex]);
+}
+
 // ============================================================================
-// Fragment Shader
+// Multi-View Vertex Shaders
 // ============================================================================
 
-fragment float4 gaussianSplattingFragment(
-    GaussianVertex in [[stage_in]]
+// Several views drawn from one sort and one set of SH colors: each view
+// has its own uniforms and draws into its own viewport (the view index)
+// and, for 2D array targets, its own slice
+struct GaussianViewVertex {
+    float4 position [[position]];
+    float2 uv;
+    float3 color;
+    float opacity;
+    float2 cov2D[2];
+    uint viewport [[viewport_array_index]];
+    uint layer [[render_target_array_index]];
+};
+
+inline GaussianViewVertex viewVertex(GaussianVertex v, uint view, uint layer) {
+    GaussianViewVertex out;
+    out.position = v.position;
+    out.uv = v.uv;
+    out.color = v.color;
+    out.opacity = v.opacity;
+    out.cov2D[0] = v.cov2D[0];
+    out.cov2D[1] = v.cov2D[1];
+    out.viewport = view;
+    out.layer = layer;
+    return out;
+}
+
+// One view per draw, view viewBase
+vertex GaussianViewVertex gaussianSplattingVertexViews(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    device const GaussianUpload* gaussians [[buffer(0), function_constant(kFullGaussians)]],
+    constant uint* sortedIndices [[buffer(1)]],
+    constant GaussianUniforms* views [[buffer(2)]],
+    device const half4* colors [[buffer(3)]],
+    constant uint& viewBase [[buffer(4)]],
+    constant uint* layers [[buffer(5)]],
+    device const CompressedGaussian* compressed [[buffer(COMPRESSED_SPLATS_INDEX), function_constant(kCompressedGaussians)]],
+    device const CompressedChunk* chunks [[buffer(COMPRESSED_CHUNKS_INDEX), function_constant(kCompressedGaussians)]]
+) {
+    uint gaussianIndex = sortedIndices[instanceID];
+    Gaussian gaussian = kCompressedGaussians ? compressedSplat(compressed, chunks, gaussianIndex)
+                                             : uploadedSplat(gaussians[gaussianIndex]);
+    return viewVertex(splatVertex(vertexID, gaussian, views[viewBase], colors[gaussianIndex]),
+                      viewBase, layers[viewBase]);
+}
+
+// Views viewBase + amplification_id from one draw (vertex amplification):
+// the splat fetch and 3D covariance don't depend on the view and are shared
+vertex GaussianViewVertex gaussianSplattingVertexAmplified(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    ushort amplificationID [[amplification_id]],
+    device const GaussianUpload* gaussians [[buffer(0), function_constant(kFullGaussians)]],
+    constant uint* sortedIndices [[buffer(1)]],
+    constant GaussianUniforms* views [[buffer(2)]],
+    device const half4* colors [[buffer(3)]],
+    constant uint& viewBase [[buffer(4)]],
+    constant uint* layers [[buffer(5)]],
+    device const CompressedGaussian* compressed [[buffer(COMPRESSED_SPLATS_INDEX), function_constant(kCompressedGaussians)]],
+    device const CompressedChunk* chunks [[buffer(COMPRESSED_CHUNKS_INDEX), function_constant(kCompressedGaussians)]]
 ) {
+    uint view = viewBase + amplificationID;
+    uint gaussianIndex = sortedIndices[instanceID];
+    Gaussian gaussian = kCompressedGaussians ? compressedSplat(compressed, chunks, gaussianIndex)
+                                             : uploadedSplat(gaussians[gaussianIndex]);
+    return viewVertex(splatVertex(vertexID, gaussian, views[view], colors[gaussianIndex]), view, layers[view]);
+}
+
+// ============================================================================
+// Fragment Shader
+// ============================================================================
+
+// Coverage of a quad point: 0 for degenerate Gaussians
+inline float splatAlpha(float2 uv, float2 cov0, float2 cov1, float opacity) {
     // Evaluate 2D Gaussian function
     // G(x) = exp(-0.5 * x^T * Sigma^{-1} * x)
 
     // Invert 2D covariance matrix
-    float a = in.cov2D[0].x;
-    float b = in.cov2D[0].y;
-    float d = in.cov2D[1].y;
+    float a = cov0.x;
+    float b = cov0.y;
+    float d = cov1.y;
 
     float det = a * d - b * b;
     if (det <= 1e-6) {
-        discard_fragment(); // Degenerate Gaussian
+        return 0.0; // Degenerate Gaussian
     }
 
     float invDet = 1.0 / det;
@@ -322,12 +434,17 @@ fragment float4 gaussianSplattingFragment(
     invCov[1][1] = a * invDet;
 
     // Evaluate Gaussian: exp(-0.5 * uv^T * invCov * uv)
-    float2 uv = in.uv;
     float exponent = -0.5 * (invCov[0][0] * uv.x * uv.x +
                              2.0 * invCov[0][1] * uv.x * uv.y +
                              invCov[1][1] * uv.y * uv.y);
 
-    float alpha = exp(exponent) * in.opacity;
+    return exp(exponent) * opacity;
+}
+
+fragment float4 gaussianSplattingFragment(
+    GaussianVertex in [[stage_in]]
+) {
+    float alpha = splatAlpha(in.uv, in.cov2D[0], in.cov2D[1], in.opacity);
 
     // Early discard for transparent fragments (performance optimization)
     if (alpha < 0.01) {
@@ -339,6 +456,16 @@ fragment float4 gaussianSplattingFragment(
     return float4(in.color * alpha, alpha);
 }
 
+fragment float4 gaussianSplattingFragmentViews(
+    GaussianViewVertex in [[stage_in]]
+) {
+    float alpha = splatAlpha(in.uv, in.cov2D[0], in.cov2D[1], in.opacity);
+    if (alpha < 0.01) {
+        discard_fragment();
+    }
+    return float4(in.color * alpha, alpha);
+}
+
 // ============================================================================
 // Compute Shader: GPU Depth Sorting
 // ============================================================================
@@ -381,31 +508,342 @@ kernel void gaussianDepthSort(
     }
 }
 
-// Radix sort variant (more efficient for large datasets)
-kernel void gaussianRadixSort(
-    device SortData* sortData [[buffer(0)]],
-    device SortData* tempData [[buffer(1)]],
-    device uint* histograms [[buffer(2)]],
-    constant uint& count [[buffer(3)]],
-    constant uint& bit [[buffer(4)]],
-    uint tid [[thread_position_in_grid]],
+// The radix sort SharpRenderer uses lives in GaussianSort.metal
+
+// ============================================================================
+// Compute Shaders: GaussianCloud Buffer
+// ============================================================================
+
+// One GaussianCloud edit (translate, rotateAround, scale, transform)
+struct CloudTransform {
+    float4x4 matrix;        // Applied to positions
+    float4 rotation;        // Quaternion (x, y, z, w) composed onto orientations
+    float3 scale;           // Multiplies local scales
+    uint count;
+};
+
+inline float4 quatMultiply(float4 a, float4 b) {
+    return float4(a.w * b.xyz + b.w * a.xyz + cross(a.xyz, b.xyz), a.w * b.w - dot(a.xyz, b.xyz));
+}
+
+// Edit a cloud's GPU copy in place
+kernel void gaussianCloudTransform(
+    device Gaussian* gaussians [[buffer(0)]],
+    constant CloudTransform& transform [[buffer(1)]],
+    uint id [[thread_position_in_grid]]
+) {
+    if (id >= transform.count) return;
+
+    device Gaussian& g = gaussians[id];
+    g.position = (transform.matrix * float4(g.position, 1.0)).xyz;
+    g.rotation.vector = quatMultiply(transform.rotation, g.rotation.vector);
+    g.scale *= transform.scale;
+}
+
+// Expand a cloud's GPU copy into the renderer's upload layout
+kernel void gaussianCloudExpand(
+    device const Gaussian* gaussians [[buffer(0)]],
+    device GaussianUpload* upload [[buffer(1)]],
+    constant uint& count [[buffer(2)]],
+    uint id [[thread_position_in_grid]]
+) {
+    if (id >= count) return;
+
+    Gaussian g = gaussians[id];
+    GaussianUpload out;
+    out.position = g.position;
+    out.scale = g.scale;
+    out.rotation = g.rotation.vector;
+    out.opacity = g.opacity;
+    out.sh_dc = g.sh_dc;
+    out.padding = 0.0;
+    for (uint c = 0; c < 15; c++) {
+        out.sh_coefficients[c * 3 + 0] = g.sh_rest[c].x;
+        out.sh_coefficients[c * 3 + 1] = g.sh_rest[c].y;
+        out.sh_coefficients[c * 3 + 2] = g.sh_rest[c].z;
+    }
+    upload[id] = out;
+}
+
+// ============================================================================
+// Compute Shaders: GaussianCloud Filtering
+// ============================================================================
+
+// Stream compaction of a cloud's GPU copy: count the survivors of each
+// block, scan the counts (gaussianRadixScan), then scatter the survivors
+// in order. Dispatch both passes in threadgroups of CLOUD_FILTER_THREADS.
+#define CLOUD_FILTER_THREADS 256
+
+// Keep test shared by the filters (matches CloudFilter in
+// SharpGaussianCloud.mm); unused limits are infinite
+struct CloudFilter {
+    float3 minBounds;
+    float3 maxBounds;
+    float minOpacity;
+    float minRadius;        // 3-sigma radius, as Gaussian::getRadius()
+    float maxRadius;
+    uint count;
+};
+
+// Written as the CPU filters' removal tests negated, so NaNs are kept alike
+inline bool cloudFilterKeeps(device const Gaussian& g, constant CloudFilter& filter) {
+    float radius = max3(g.scale.x, g.scale.y, g.scale.z) * 3.0;
+    return !(g.opacity < filter.minOpacity) &&
+           !(radius < filter.minRadius || radius > filter.maxRadius) &&
+           !any(g.position < filter.minBounds) && !any(g.position > filter.maxBounds);
+}
+
+// Survivors per threadgroup
+kernel void gaussianCloudFilterCount(
+    device const Gaussian* gaussians [[buffer(0)]],
+    device uint* blockCounts [[buffer(1)]],
+    constant CloudFilter& filter [[buffer(2)]],
+    uint id [[thread_position_in_grid]],
+    uint block [[threadgroup_position_in_grid]],
     uint lid [[thread_position_in_threadgroup]],
-    uint gid [[threadgroup_position_in_grid]]
+    uint simdLane [[thread_index_in_simdgroup]],
+    uint simdGroup [[simdgroup_index_in_threadgroup]],
+    uint simdCount [[simdgroups_per_threadgroup]]
+) {
+    threadgroup uint simdTotals[32];
+    uint keep = id < filter.count && cloudFilterKeeps(gaussians[id], filter) ? 1 : 0;
+    uint total = simd_sum(keep);
+    if (simdLane == 0) {
+        simdTotals[simdGroup] = total;
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+
+    if (lid == 0) {
+        uint sum = 0;
+        for (uint s = 0; s < simdCount; s++) {
+            sum += simdTotals[s];
+        }
+        blockCounts[block] = sum;
+    }
+}
+
+// Copy the survivors to their block's scanned offset, in their original order
+kernel void gaussianCloudFilterScatter(
+    device const Gaussian* gaussians [[buffer(0)]],
+    device Gaussian* kept [[buffer(1)]],
+    device const uint* blockOffsets [[buffer(2)]],
+    constant CloudFilter& filter [[buffer(3)]],
+    uint id [[thread_position_in_grid]],
+    uint block [[threadgroup_position_in_grid]],
+    uint simdLane [[thread_index_in_simdgroup]],
+    uint simdGroup [[simdgroup_index_in_threadgroup]],
+    uint simdCount [[simdgroups_per_threadgroup]]
+) {
+    threadgroup uint simdOffsets[32];
+    bool keep = id < filter.count && cloudFilterKeeps(gaussians[id], filter);
+    uint value = keep ? 1 : 0;
+    uint prefix = simd_prefix_exclusive_sum(value);
+    uint total = simd_sum(value);
+    if (simdLane == 0) {
+        simdOffsets[simdGroup] = total;
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+
+    if (simdGroup == 0) {
+        uint groupTotal = simdLane < simdCount ? simdOffsets[simdLane] : 0;
+        uint offset = simd_prefix_exclusive_sum(groupTotal);
+        if (simdLane < simdCount) {
+            simdOffsets[simdLane] = offset;
+        }
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+
+    if (keep) {
+        kept[blockOffsets[block] + simdOffsets[simdGroup] + prefix] = gaussians[id];
+    }
+}
+
+// ============================================================================
+// Compute Shader: Model Output Decoding
+// ============================================================================
+
+// Where splat i's component c sits in one SharpModel output, in elements.
+// Must match SharpModel.mm
+struct ModelOutput {
+    uint splatStride;
+    uint componentStride;
+    uint isHalf;            // Float16 elements, else Float32
+    uint present;           // 0 = the model has no such output
+};
+
+// Outputs in order: positions, scales, rotations, opacities, sh_dc, sh_rest
+struct ModelDecodeParams {
+    ModelOutput outputs[6];
+    uint count;
+};
+
+inline float modelElement(device const uchar* data, constant ModelOutput& output, uint splat, uint component) {
+    uint index = splat * output.splatStride + component * output.componentStride;
+    return output.isHalf ? float(((device const half*)data)[index]) : ((device const float*)data)[index];
+}
+
+// Core ML outputs straight into a GaussianCloud's GPU copy; missing
+// outputs keep Sharp::Gaussian's defaults
+kernel void gaussianDecodeModel(
+    device const uchar* positions [[buffer(0)]],
+    device const uchar* scales [[buffer(1)]],
+    device const uchar* rotations [[buffer(2)]],
+    device const uchar* opacities [[buffer(3)]],
+    device const uchar* colors [[buffer(4)]],
+    device const uchar* shRest [[buffer(5)]],
+    device Gaussian* gaussians [[buffer(6)]],
+    constant ModelDecodeParams& params [[buffer(7)]],
+    uint id [[thread_position_in_grid]]
 ) {
-    // Radix sort pass for a single bit
-    // This is a simplified version; full implementation would use scan/prefix sum
+    if (id >= params.count) return;
+
+    Gaussian g;
+    g.position = float3(modelElement(positions, params.outputs[0], id, 0),
+                        modelElement(positions, params.outputs[0], id, 1),
+                        modelElement(positions, params.outputs[0], id, 2));
+    g.scale = float3(1.0);
+    if (params.outputs[1].present) {
+        g.scale = float3(modelElement(scales, params.outputs[1], id, 0),
+                         modelElement(scales, params.outputs[1], id, 1),
+                         modelElement(scales, params.outputs[1], id, 2));
+    }
+    float4 q = float4(0.0, 0.0, 0.0, 1.0);
+    if (params.outputs[2].present) {
+        q = float4(modelElement(rotations, params.outputs[2], id, 0), modelElement(rotations, params.outputs[2], id, 1),
+                   modelElement(rotations, params.outputs[2], id, 2), modelElement(rotations, params.outputs[2], id, 3));
+        float len = length(q);
+        q = len > 0.0 ? q / len : float4(0.0, 0.0, 0.0, 1.0);
+    }
+    g.rotation.vector = q;
+    g.opacity = params.outputs[3].present ? modelElement(opacities, params.outputs[3], id, 0) : 1.0;
+    g.sh_dc = float3(0.5);
+    if (params.outputs[4].present) {
+        g.sh_dc = float3(modelElement(colors, params.outputs[4], id, 0),
+                         modelElement(colors, params.outputs[4], id, 1),
+                         modelElement(colors, params.outputs[4], id, 2));
+    }
+    for (uint c = 0; c < 15; c++) {
+        g.sh_rest[c] = float3(0.0);
+        if (params.outputs[5].present) {
+            g.sh_rest[c] = float3(modelElement(shRest, params.outputs[5], id, c * 3),
+                                  modelElement(shRest, params.outputs[5], id, c * 3 + 1),
+                                  modelElement(shRest, params.outputs[5], id, c * 3 + 2));
+        }
+    }
+    gaussians[id] = g;
+}
 
-    const uint radix = 2; // Binary radix
-    const uint mask = 1 << bit;
+// ============================================================================
+// Compute Shader: Scene Batches
+// ============================================================================
 
-    if (tid < count) {
-        SortData data = sortData[tid];
-        uint bitValue = (as_type<uint>(data.depth) & mask) ? 1 : 0;
+// One object of a scene batch
+struct ObjectTransform {
+    float4x4 matrix;        // Object to world, applied to positions
+    float4 rotation;        // Quaternion (x, y, z, w) composed onto orientations
+    float3 scale;           // Multiplies local scales
+    float opacity;          // Multiplies opacities (0 hides the object)
+};
 
-        // Count occurrences (simplified - would use shared memory in practice)
-        atomic_fetch_add_explicit((device atomic_uint*)&histograms[bitValue], 1, memory_order_relaxed);
+// World-space splats of a scene batch: each splat takes the transform of
+// its object, so moving an object rewrites one matrix, not its splats
+kernel void gaussianSceneTransform(
+    device const GaussianUpload* local [[buffer(0)]],
+    device GaussianUpload* world [[buffer(1)]],
+    device const uint* objectIDs [[buffer(2)]],
+    device const ObjectTransform* transforms [[buffer(3)]],
+    constant uint& count [[buffer(4)]],
+    uint id [[thread_position_in_grid]]
+) {
+    if (id >= count) return;
+
+    GaussianUpload g = local[id];
+    ObjectTransform transform = transforms[objectIDs[id]];
+    g.position = (transform.matrix * float4(g.position, 1.0)).xyz;
+    g.rotation = quatMultiply(transform.rotation, g.rotation);
+    g.scale *= transform.scale;
+    g.opacity *= transform.opacity;
+    world[id] = g;
+}
+
+// ============================================================================
+// Compute Shader: SH Color Cache
+// ============================================================================
+
+// Must match SharpRenderer.mm
+struct SHColorParams {
+    float3 cameraPosition;
+    float focal;            // Pixels per unit at depth 1
+    uint count;
+    int maxSHDegree;
+    float splatScale;
+    float detailRadius;     // Pixels; 0 = always maxSHDegree
+};
+
+// SH degree for a splat of the given screen radius: full at detailRadius
+// pixels and above, one degree less per halving below
+inline int adaptiveSHDegree(int maxDegree, float radius, float detailRadius) {
+    if (detailRadius <= 0.0 || radius >= detailRadius) {
+        return maxDegree;
     }
+    return max(0, maxDegree - int(ceil(log2(detailRadius / max(radius, 1e-6)))));
+}
+
+// One color per splat for the quad vertex shader, which would otherwise
+// evaluate SH for each of its four corners. Also finds the splat closest
+// to the camera, from which the host bounds how far view directions turn
+// as the camera moves, to decide when the colors can be reused.
+// Dispatch: one thread per splat.
+kernel void gaussianEvaluateSH(
+    device const GaussianUpload* gaussians [[buffer(0), function_constant(kFullGaussians)]],
+    device half4* colors [[buffer(1)]],
+    device atomic_uint* minDistance [[buffer(2)]],
+    constant SHColorParams& params [[buffer(3)]],
+    device const CompressedGaussian* compressed [[buffer(COMPRESSED_SPLATS_INDEX), function_constant(kCompressedGaussians)]],
+    device const CompressedChunk* chunks [[buffer(COMPRESSED_CHUNKS_INDEX), function_constant(kCompressedGaussians)]],
+    device const half* codebook [[buffer(COMPRESSED_CODEBOOK_INDEX), function_constant(kCompressedGaussians)]],
+    uint id [[thread_position_in_grid]]
+) {
+    // Threads past the end stay for the simdgroup minimum
+    float distance = INFINITY;
+    if (id < params.count) {
+        Gaussian gaussian;
+        uint shIndex = 0;
+        if (kCompressedGaussians) {
+            DecodedGaussian decoded = decodeGaussian(compressed, chunks, id);
+            gaussian.position = decoded.position;
+            gaussian.scale = decoded.scale;
+            gaussian.sh_dc = decoded.color;
+            shIndex = decoded.shIndex;
+        } else {
+            gaussian.position = gaussians[id].position;
+            gaussian.scale = gaussians[id].scale;
+            gaussian.sh_dc = gaussians[id].sh_dc;
+        }
 
-    // Full radix sort would continue with prefix sum and reordering
-    // This is a placeholder showing the structure
+        float3 offset = gaussian.position - params.cameraPosition;
+        distance = length(offset);
+        float radius = 3.0 * max3(gaussian.scale.x, gaussian.scale.y, gaussian.scale.z) * params.splatScale *
+                       params.focal / max(distance, 1e-6);
+        int degree = adaptiveSHDegree(params.maxSHDegree, radius, params.detailRadius);
+
+        // Only the coefficients the degree uses are read
+        const uint shCount = uint((degree + 1) * (degree + 1) - 1);
+        for (uint i = 0; i < shCount; i++) {
+            if (kCompressedGaussians) {
+                gaussian.sh_rest[i] = decodeSH(codebook, shIndex, i);
+            } else {
+                device const float* sh = gaussians[id].sh_coefficients + i * 3;
+                gaussian.sh_rest[i] = float3(sh[0], sh[1], sh[2]);
+            }
+        }
+        float3 color = evaluateSphericalHarmonics(gaussian, offset / max(distance, 1e-6), degree);
+        colors[id] = half4(half3(color), 1.0h);
+    }
+
+    // Positive floats order like their bits
+    float closest = simd_min(distance);
+    if (simd_is_first() && closest < INFINITY) {
+        atomic_fetch_min_explicit(minDistance, as_type<uint>(closest), memory_order_relaxed);
+    }
 }
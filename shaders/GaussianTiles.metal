@@ -0,0 +1,429 @@
+#include <metal_stdlib>
+#include "GaussianCompressed.h"
+using namespace metal;
+
+// ============================================================================
+// Tile-Based Gaussian Rasterizer
+// ============================================================================
+
+// The reference 3DGS rasterizer on Metal compute:
+// 1. gaussianTilePreprocess: screen center, conic, color and tile rect per splat
+// 2. gaussianRadixScan (GaussianSort.metal) over the per-splat tile counts,
+//    then gaussianTileSetup sizes the sort and writes its dispatch arguments
+// 3. gaussianTileDuplicate: one (tile, depth) key per tile a splat touches
+// 4. Radix sort (GaussianSort.metal), then gaussianTileRanges finds each
+//    tile's run of sorted keys
+// 5. gaussianTileRender: one threadgroup per tile composites front to back
+//    and stops once every pixel is saturated
+// Keys are 32-bit: the tile in the high half, the top 16 bits of the depth
+// in the low half, so a 16-pixel tile grid may hold up to 65536 tiles.
+
+constant uint TILE_SIZE = 16;
+constant uint TILE_PIXELS = TILE_SIZE * TILE_SIZE;
+constant uint TILE_GROUP = 256;                // Threads for 1D passes
+constant uint RADIX_BLOCK = 256 * 8;           // Must match GaussianSort.metal
+constant float ALPHA_MIN = 1.0 / 255.0;        // Contributions below this are skipped
+constant float ALPHA_MAX = 0.99;
+constant float TRANSMITTANCE_MIN = 0.0001;     // A pixel is saturated below this
+
+// Mirrors SharpRenderer's GaussianVertex upload layout
+struct TileGaussian {
+    float3 position;
+    float3 scale;
+    float4 rotation;        // Quaternion (x, y, z, w)
+    float opacity;
+    float3 sh_dc;           // Base color
+    float padding;
+    float sh_coefficients[45];  // Degrees 1-3, RGB per coefficient
+};
+
+// Must match SharpRenderer.mm
+struct TileUniforms {
+    float4x4 viewMatrix;
+    float4x4 viewProjectionMatrix;
+    float3 cameraPosition;
+    float2 focal;           // Pixels per unit at depth 1
+    float2 viewportSize;
+    uint2 tileCount;
+    uint count;             // Splats
+    uint capacity;          // Key entries allocated
+    float splatScale;
+    float opacityScale;
+    float minOpacity;
+    int maxSHDegree;
+    float shDetailRadius;   // Pixels; smaller splats drop SH degrees (0 = never)
+};
+
+// Screen-space splat, written by the preprocess pass
+struct TileSplat {
+    float4 conicOpacity;    // Inverse 2D covariance (xx, xy, yy), opacity
+    float4 color;           // RGB, view depth
+    float2 center;          // Pixels
+    uint2 rectMin;          // Tiles covered: [rectMin, rectMax)
+    uint2 rectMax;
+};
+
+struct RadixParams {
+    uint count;
+    uint blockCount;
+    uint shift;
+};
+
+// Sort sizes and dispatch arguments, written by gaussianTileSetup. Each
+// constant block sits in its own 256-byte slot (the constant buffer offset
+// alignment on macOS); offsets in words, must match SharpRenderer.mm
+constant uint SETUP_SLOT = 64;
+constant uint SETUP_PASSES = 0;                // RadixParams per pass, slots 0-3
+constant uint SETUP_SCAN_LENGTH = 4 * SETUP_SLOT;   // Histogram entries (256 per radix block)
+constant uint SETUP_REQUESTED = 5 * SETUP_SLOT;     // Keys all splats asked for
+constant uint SETUP_BLOCK_GROUPS = SETUP_REQUESTED + 1;  // Radix histogram/scatter dispatch
+constant uint SETUP_ENTRY_GROUPS = SETUP_REQUESTED + 4;  // One thread per key dispatch
+
+static uint sortableDepth(float depth) {
+    uint bits = as_type<uint>(depth);
+    return bits ^ ((bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u);
+}
+
+static float3 coefficient(device const TileGaussian& g, uint i) {
+    return float3(g.sh_coefficients[i * 3], g.sh_coefficients[i * 3 + 1], g.sh_coefficients[i * 3 + 2]);
+}
+
+static float3 evaluateTileSH(float3 color, thread const float3* sh, float3 dir, int degree) {
+    if (degree < 1) {
+        return color;
+    }
+
+    float x = dir.x, y = dir.y, z = dir.z;
+
+    color += 0.4886025119029199 * (-y * sh[0] + z * sh[1] - x * sh[2]);
+    if (degree >= 2) {
+        float xx = x * x, yy = y * y, zz = z * z;
+        color += 1.0925484305920792 * x * y * sh[3] +
+                 -1.0925484305920792 * y * z * sh[4] +
+                 0.31539156525252005 * (2.0 * zz - xx - yy) * sh[5] +
+                 -1.0925484305920792 * x * z * sh[6] +
+                 0.5462742152960396 * (xx - yy) * sh[7];
+        if (degree >= 3) {
+            color += -0.5900435899266435 * y * (3.0 * xx - yy) * sh[8] +
+                     2.890611442640554 * x * y * z * sh[9] +
+                     -0.4570457994644658 * y * (4.0 * zz - xx - yy) * sh[10] +
+                     0.3731763325901154 * z * (2.0 * zz - 3.0 * xx - 3.0 * yy) * sh[11] +
+                     -0.4570457994644658 * x * (4.0 * zz - xx - yy) * sh[12] +
+                     1.445305721320277 * z * (xx - yy) * sh[13] +
+                     -0.5900435899266435 * x * (xx - 3.0 * yy) * sh[14];
+        }
+    }
+    return max(color, 0.0);
+}
+
+// ============================================================================
+// 1. Preprocess
+// ============================================================================
+
+kernel void gaussianTilePreprocess(
+    device const TileGaussian* gaussians [[buffer(0), function_constant(kFullGaussians)]],
+    device TileSplat* splats [[buffer(1)]],
+    device uint* tileCounts [[buffer(2)]],
+    constant TileUniforms& uniforms [[buffer(3)]],
+    device const CompressedGaussian* compressed [[buffer(COMPRESSED_SPLATS_INDEX), function_constant(kCompressedGaussians)]],
+    device const CompressedChunk* chunks [[buffer(COMPRESSED_CHUNKS_INDEX), function_constant(kCompressedGaussians)]],
+    device const half* codebook [[buffer(COMPRESSED_CODEBOOK_INDEX), function_constant(kCompressedGaussians)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    if (tid >= uniforms.count) {
+        return;
+    }
+    tileCounts[tid] = 0;
+    splats[tid].rectMin = uint2(0);
+    splats[tid].rectMax = uint2(0);
+
+    DecodedGaussian g;
+    if (kCompressedGaussians) {
+        g = decodeGaussian(compressed, chunks, tid);
+    } else {
+        g.position = gaussians[tid].position;
+        g.scale = gaussians[tid].scale;
+        g.rotation = gaussians[tid].rotation;
+        g.opacity = gaussians[tid].opacity;
+        g.color = gaussians[tid].sh_dc;
+    }
+    float opacity = g.opacity * uniforms.opacityScale;
+    float4 viewPos = uniforms.viewMatrix * float4(g.position, 1.0);
+    float distance = -viewPos.z;    // The camera looks down -z
+    if (opacity < uniforms.minOpacity || distance < 0.2) {
+        return;
+    }
+
+    // 3D covariance: R S S^T R^T
+    float4 q = normalize(g.rotation);
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+    float3x3 R = float3x3(float3(1.0 - 2.0 * (yy + zz), 2.0 * (xy + wz), 2.0 * (xz - wy)),
+                          float3(2.0 * (xy - wz), 1.0 - 2.0 * (xx + zz), 2.0 * (yz + wx)),
+                          float3(2.0 * (xz + wy), 2.0 * (yz - wx), 1.0 - 2.0 * (xx + yy)));
+    float3 s = g.scale * uniforms.splatScale;
+    float3x3 M = float3x3(R[0] * s.x, R[1] * s.y, R[2] * s.z);
+    float3x3 W = float3x3(uniforms.viewMatrix[0].xyz, uniforms.viewMatrix[1].xyz, uniforms.viewMatrix[2].xyz);
+    float3x3 WM = W * M;
+    float3x3 V = WM * transpose(WM);
+
+    // Perspective Jacobian in pixels (y grows downward), with the view
+    // position clamped to a little beyond the frustum like the reference
+    float2 limit = 1.3 * uniforms.viewportSize * 0.5 / uniforms.focal;
+    float2 t = clamp(viewPos.xy / distance, -limit, limit) * distance;
+    float3 jx = float3(uniforms.focal.x / distance, 0.0, uniforms.focal.x * t.x / (distance * distance));
+    float3 jy = float3(0.0, -uniforms.focal.y / distance, -uniforms.focal.y * t.y / (distance * distance));
+    float a = dot(jx, V * jx) + 0.3;    // Low-pass: at least a pixel wide
+    float b = dot(jx, V * jy);
+    float c = dot(jy, V * jy) + 0.3;
+
+    float det = a * c - b * b;
+    if (det <= 0.0) {
+        return;
+    }
+    float3 conic = float3(c, -b, a) / det;
+
+    float mid = 0.5 * (a + c);
+    float lambda = mid + sqrt(max(0.1, mid * mid - det));
+    float radius = ceil(3.0 * sqrt(lambda));
+
+    float4 clip = uniforms.viewProjectionMatrix * float4(g.position, 1.0);
+    float2 ndc = clip.xy / clip.w;
+    float2 center = float2((ndc.x * 0.5 + 0.5) * uniforms.viewportSize.x,
+                           (0.5 - ndc.y * 0.5) * uniforms.viewportSize.y);
+
+    int2 grid = int2(uniforms.tileCount);
+    int2 rectMin = clamp(int2(floor((center - radius) / float(TILE_SIZE))), int2(0), grid);
+    int2 rectMax = clamp(int2(floor((center + radius) / float(TILE_SIZE))) + 1, int2(0), grid);
+    uint2 extent = uint2(rectMax - rectMin);
+    if (extent.x == 0 || extent.y == 0) {
+        return;
+    }
+
+    // Small splats drop SH degrees like the quad color cache
+    // (adaptiveSHDegree in GaussianSplatting.metal)
+    int degree = uniforms.maxSHDegree;
+    if (uniforms.shDetailRadius > 0.0 && radius < uniforms.shDetailRadius) {
+        degree = max(0, degree - int(ceil(log2(uniforms.shDetailRadius / max(radius, 1.0)))));
+    }
+
+    float3 sh[15];
+    const uint shCount = uint((degree + 1) * (degree + 1) - 1);
+    for (uint i = 0; i < shCount; i++) {
+        sh[i] = kCompressedGaussians ? decodeSH(codebook, g.shIndex, i) : coefficient(gaussians[tid], i);
+    }
+
+    float3 dir = normalize(g.position - uniforms.cameraPosition);
+    splats[tid].conicOpacity = float4(conic, opacity);
+    splats[tid].color = float4(evaluateTileSH(g.color, sh, dir, degree), distance);
+    splats[tid].center = center;
+    splats[tid].rectMin = uint2(rectMin);
+    splats[tid].rectMax = uint2(rectMax);
+    tileCounts[tid] = extent.x * extent.y;
+}
+
+// ============================================================================
+// 2. Sort Setup
+// ============================================================================
+
+/**
+ * Sizes the key sort from the scanned tile counts; keys past the capacity
+ * are dropped this frame, and the host grows the buffers from `requested`.
+ * Dispatch: a single thread.
+ */
+kernel void gaussianTileSetup(
+    device const uint* tileOffsets [[buffer(0)]],
+    device const TileSplat* splats [[buffer(1)]],
+    device uint* setup [[buffer(2)]],
+    constant TileUniforms& uniforms [[buffer(3)]]
+) {
+    uint last = uniforms.count - 1;
+    uint2 extent = splats[last].rectMax - splats[last].rectMin;
+    uint requested = tileOffsets[last] + extent.x * extent.y;
+    uint count = min(requested, uniforms.capacity);
+    uint blockCount = (count + RADIX_BLOCK - 1) / RADIX_BLOCK;
+
+    for (uint pass = 0; pass < 4; pass++) {
+        device RadixParams& params = *(device RadixParams*)(setup + SETUP_PASSES + pass * SETUP_SLOT);
+        params.count = count;
+        params.blockCount = blockCount;
+        params.shift = pass * 8;
+    }
+    setup[SETUP_SCAN_LENGTH] = blockCount * 256;
+    setup[SETUP_REQUESTED] = requested;
+    setup[SETUP_BLOCK_GROUPS] = blockCount;
+    setup[SETUP_BLOCK_GROUPS + 1] = 1;
+    setup[SETUP_BLOCK_GROUPS + 2] = 1;
+    setup[SETUP_ENTRY_GROUPS] = (count + TILE_GROUP - 1) / TILE_GROUP;
+    setup[SETUP_ENTRY_GROUPS + 1] = 1;
+    setup[SETUP_ENTRY_GROUPS + 2] = 1;
+}
+
+// ============================================================================
+// 3. Duplicate
+// ============================================================================
+
+kernel void gaussianTileDuplicate(
+    device const TileSplat* splats [[buffer(0)]],
+    device const uint* tileOffsets [[buffer(1)]],
+    device uint* keys [[buffer(2)]],
+    device uint* values [[buffer(3)]],
+    constant TileUniforms& uniforms [[buffer(4)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    if (tid >= uniforms.count) {
+        return;
+    }
+    TileSplat splat = splats[tid];
+    uint offset = tileOffsets[tid];
+
+    // Nearest first within a tile: ascending distance
+    uint depthKey = sortableDepth(splat.color.w) >> 16;
+    for (uint y = splat.rectMin.y; y < splat.rectMax.y; y++) {
+        for (uint x = splat.rectMin.x; x < splat.rectMax.x; x++) {
+            if (offset >= uniforms.capacity) {
+                return;
+            }
+            uint tile = y * uniforms.tileCount.x + x;
+            keys[offset] = (tile << 16) | depthKey;
+            values[offset] = tid;
+            offset++;
+        }
+    }
+}
+
+// ============================================================================
+// 4. Tile Ranges
+// ============================================================================
+
+/**
+ * Start and end of every tile's run in the sorted keys; tiles without
+ * splats keep the (0, 0) they were cleared to.
+ * Dispatch: the setup's entry groups of TILE_GROUP threads.
+ */
+kernel void gaussianTileRanges(
+    device const uint* keys [[buffer(0)]],
+    device uint2* ranges [[buffer(1)]],
+    constant RadixParams& params [[buffer(2)]],     // Setup slot 0
+    uint tid [[thread_position_in_grid]]
+) {
+    uint count = params.count;
+    if (tid >= count) {
+        return;
+    }
+    uint tile = keys[tid] >> 16;
+    if (tid == 0 || (keys[tid - 1] >> 16) != tile) {
+        ranges[tile].x = tid;
+    }
+    if (tid == count - 1 || (keys[tid + 1] >> 16) != tile) {
+        ranges[tile].y = tid + 1;
+    }
+}
+
+// ============================================================================
+// 5. Render
+// ============================================================================
+
+/**
+ * Front-to-back compositing of one tile. Splats are fetched into
+ * threadgroup memory a row at a time; the tile stops when all its pixels
+ * are saturated. Writes premultiplied color with alpha = 1 - transmittance.
+ * Dispatch: tileCount threadgroups of TILE_SIZE x TILE_SIZE.
+ */
+kernel void gaussianTileRender(
+    device const TileSplat* splats [[buffer(0)]],
+    device const uint* values [[buffer(1)]],
+    device const uint2* ranges [[buffer(2)]],
+    constant TileUniforms& uniforms [[buffer(3)]],
+    texture2d<float, access::write> output [[texture(0)]],
+    uint2 tile [[threadgroup_position_in_grid]],
+    uint2 local [[thread_position_in_threadgroup]],
+    uint lid [[thread_index_in_threadgroup]]
+) {
+    threadgroup float4 fetchedConic[TILE_PIXELS];
+    threadgroup float4 fetchedColor[TILE_PIXELS];
+    threadgroup float2 fetchedCenter[TILE_PIXELS];
+    threadgroup atomic_uint saturated;
+
+    uint2 pixel = tile * TILE_SIZE + local;
+    bool inside = pixel.x < uint(uniforms.viewportSize.x) && pixel.y < uint(uniforms.viewportSize.y);
+    bool done = !inside;
+    float2 position = float2(pixel) + 0.5;
+
+    uint2 range = ranges[tile.y * uniforms.tileCount.x + tile.x];
+    float transmittance = 1.0;
+    float3 color = float3(0.0);
+
+    for (uint base = range.x; base < range.y; base += TILE_PIXELS) {
+        // Stop once every pixel of the tile is saturated
+        if (lid == 0) {
+            atomic_store_explicit(&saturated, 0, memory_order_relaxed);
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+        if (done) {
+            atomic_fetch_add_explicit(&saturated, 1, memory_order_relaxed);
+        }
+        uint index = base + lid;
+        if (index < range.y) {
+            TileSplat splat = splats[values[index]];
+            fetchedConic[lid] = splat.conicOpacity;
+            fetchedColor[lid] = splat.color;
+            fetchedCenter[lid] = splat.center;
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+        if (atomic_load_explicit(&saturated, memory_order_relaxed) == TILE_PIXELS) {
+            break;
+        }
+
+        uint batch = min(TILE_PIXELS, range.y - base);
+        for (uint i = 0; i < batch && !done; i++) {
+            float2 d = fetchedCenter[i] - position;
+            float4 conic = fetchedConic[i];
+            float power = -0.5 * (conic.x * d.x * d.x + conic.z * d.y * d.y) - conic.y * d.x * d.y;
+            if (power > 0.0) {
+                continue;
+            }
+            float alpha = min(ALPHA_MAX, conic.w * exp(power));
+            if (alpha < ALPHA_MIN) {
+                continue;
+            }
+            float next = transmittance * (1.0 - alpha);
+            if (next < TRANSMITTANCE_MIN) {
+                done = true;
+                break;
+            }
+            color += fetchedColor[i].rgb * alpha * transmittance;
+            transmittance = next;
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+    }
+
+    if (inside) {
+        output.write(float4(color, 1.0 - transmittance), pixel);
+    }
+}
+
+// ============================================================================
+// Composite
+// ============================================================================
+
+// Fullscreen triangle blending the tile output over the target with the
+// same premultiplied "over" as the quad path
+struct TileCompositeVertex {
+    float4 position [[position]];
+};
+
+vertex TileCompositeVertex gaussianTileCompositeVertex(uint vertexID [[vertex_id]]) {
+    float2 corner = float2((vertexID << 1) & 2, vertexID & 2);
+    TileCompositeVertex out;
+    out.position = float4(corner * 2.0 - 1.0, 0.0, 1.0);
+    return out;
+}
+
+fragment float4 gaussianTileCompositeFragment(
+    TileCompositeVertex in [[stage_in]],
+    texture2d<float, access::read> tiles [[texture(0)]]
+) {
+    return tiles.read(uint2(in.position.xy));
+}
@@ -0,0 +1,442 @@
+#include <metal_stdlib>
+#include "Common.h"
+#include "Noise.h"
+
+using namespace metal;
+
+// ============================================================================
+// GPU Particle Kernels (ofxGpuParticles)
+// ============================================================================
+//
+// Particle state lives in one buffer the CPU never touches: emitters fill
+// ring-buffer slots, the update kernel integrates forces and collisions, and
+// the instance kernels turn live particles into VboMesh instance records
+// drawn with one indirect instanced draw. Layouts match GpuParticleSystem.cpp.
+
+// MARK: - Types
+
+/// Particle state, 64 bytes (dead when lifetime is 0)
+struct GpuParticle {
+    float4 positionAge;     // xyz position, w age in seconds
+    float4 velocityLife;    // xyz velocity, w lifetime in seconds
+    half4 startColor;
+    half4 endColor;
+    float startSize;
+    float endSize;
+    uint seed;              // Per-particle random stream
+    float padding;
+};
+
+/// One emission (a frame's share of an emitter, or a burst)
+struct EmitParams {
+    float4 position;        // xyz center, w radius of the emission sphere
+    float4 direction;       // xyz unit direction, w cone half-angle in radians
+    float4 startColor;
+    float4 endColor;
+    float2 speed;           // min, max
+    float2 lifetime;        // min, max seconds
+    float2 size;            // start, end
+    uint first;             // Ring slot of the first new particle
+    uint count;
+    uint capacity;
+    uint seed;
+};
+
+struct UpdateParams {
+    float4 gravity;         // xyz acceleration, w linear drag per second
+    float4 noise;           // x frequency, y strength, z time offset
+    float deltaTime;
+    uint count;
+    uint attractorCount;
+    uint planeCount;
+};
+
+struct ParticleAttractor {
+    float4 positionStrength;    // xyz position, w strength (negative repels)
+    float4 radius;              // x: distance at which the pull halves
+};
+
+struct ParticlePlane {
+    float4 plane;               // xyz unit normal, w offset: dot(n, p) = w
+    float4 response;            // x bounce, y friction
+};
+
+/// Per-frame force table (matches ForceTable in GpuParticleSystem.cpp)
+constant uint MAX_PARTICLE_ATTRACTORS = 16;
+constant uint MAX_PARTICLE_PLANES = 8;
+
+struct ParticleForces {
+    ParticleAttractor attractors[MAX_PARTICLE_ATTRACTORS];
+    ParticlePlane planes[MAX_PARTICLE_PLANES];
+};
+
+struct InstanceParams {
+    float4 cameraRight;
+    float4 cameraUp;
+    float4 cameraPosition;
+    float4 cameraForward;
+    uint count;
+    uint billboard;         // Face the camera, or keep the mesh's axes
+    uint keyCount;          // Sort keys written (sorted draws)
+    uint padding;
+};
+
+/// Indirect arguments (MTLDrawIndexedPrimitivesIndirectArguments) with the
+/// instance count counted by the instance kernels
+struct ParticleDrawArguments {
+    uint indexCount;
+    atomic_uint instanceCount;
+    uint indexStart;
+    int baseVertex;
+    uint baseInstance;
+};
+
+struct ParticleSortKey {
+    uint index;
+    float depth;            // Along the view direction; dead particles sort last
+};
+
+struct ParticleSortParams {
+    uint count;             // Keys, a power of two of at least PARTICLE_SORT_WINDOW
+    uint stage;             // 0: sort each window from scratch
+    uint step;
+    uint padding;
+};
+
+constant float DEAD_PARTICLE_DEPTH = -FLT_MAX;
+
+// MARK: - Random
+
+inline uint pcgHash(uint v) {
+    const uint state = v * 747796405u + 2891336453u;
+    const uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+inline float random01(thread uint& state) {
+    state = pcgHash(state);
+    return float(state) * (1.0 / 4294967296.0);
+}
+
+/// Uniform unit vector within angle of axis
+inline float3 randomInCone(float3 axis, float angle, thread uint& state) {
+    const float cosTheta = mix(cos(angle), 1.0, random01(state));
+    const float sinTheta = sqrt(max(1.0 - cosTheta * cosTheta, 0.0));
+    const float phi = 2.0 * M_PI_F * random01(state);
+
+    const float3 helper = abs(axis.y) < 0.999 ? float3(0, 1, 0) : float3(1, 0, 0);
+    const float3 tangent = normalize(cross(helper, axis));
+    const float3 bitangent = cross(axis, tangent);
+    return (tangent * cos(phi) + bitangent * sin(phi)) * sinTheta + axis * cosTheta;
+}
+
+// MARK: - Curl Noise
+
+/// Forward-difference gradient of simplex noise
+inline float3 noiseGradient(float3 p) {
+    const float e = 0.01;
+    const float n = simplex(p);
+    return float3(simplex(p + float3(e, 0, 0)) - n,
+                  simplex(p + float3(0, e, 0)) - n,
+                  simplex(p + float3(0, 0, e)) - n) * (1.0 / e);
+}
+
+/// Divergence-free flow: curl(a grad b) = grad a x grad b, for two noise
+/// fields a and b, so particles swirl without bunching up
+inline float3 curlNoise(float3 p) {
+    return cross(noiseGradient(p), noiseGradient(p + float3(31.416, 47.853, 12.793)));
+}
+
+// MARK: - Simulation
+
+kernel void clearParticles(
+    device GpuParticle* particles [[buffer(0)]],
+    constant uint& count [[buffer(1)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    if (tid >= count) {
+        return;
+    }
+    particles[tid].velocityLife = float4(0.0);
+}
+
+/**
+ * Start count particles at the emitter, in ring slots from params.first.
+ * Slots still alive are recycled, oldest first.
+ */
+kernel void emitParticles(
+    device GpuParticle* particles [[buffer(0)]],
+    constant EmitParams& params [[buffer(1)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    if (tid >= params.count) {
+        return;
+    }
+    uint state = pcgHash(params.seed ^ pcgHash(tid));
+
+    // Uniform within the emission sphere
+    const float3 offset = randomInCone(float3(0, 0, 1), M_PI_F, state) *
+                          (params.position.w * pow(random01(state), 1.0 / 3.0));
+    const float3 direction = randomInCone(params.direction.xyz, params.direction.w, state);
+
+    GpuParticle p;
+    p.positionAge = float4(params.position.xyz + offset, 0.0);
+    p.velocityLife = float4(direction * mix(params.speed.x, params.speed.y, random01(state)),
+                            max(mix(params.lifetime.x, params.lifetime.y, random01(state)), 1e-3));
+    p.startColor = half4(params.startColor);
+    p.endColor = half4(params.endColor);
+    p.startSize = params.size.x;
+    p.endSize = params.size.y;
+    p.seed = state;
+    p.padding = 0.0;
+    particles[(params.first + tid) % params.capacity] = p;
+}
+
+/**
+ * Integrate one step: gravity, attractors, curl noise, drag, then push
+ * particles out of collision planes and bounce them off.
+ */
+kernel void updateParticles(
+    device GpuParticle* particles [[buffer(0)]],
+    constant ParticleForces& forces [[buffer(1)]],
+    constant UpdateParams& params [[buffer(2)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    if (tid >= params.count) {
+        return;
+    }
+    GpuParticle p = particles[tid];
+    if (p.velocityLife.w <= 0.0) {
+        return;
+    }
+
+    const float dt = params.deltaTime;
+    const float age = p.positionAge.w + dt;
+    if (age >= p.velocityLife.w) {
+        particles[tid].velocityLife.w = 0.0;
+        return;
+    }
+
+    float3 position = p.positionAge.xyz;
+    float3 velocity = p.velocityLife.xyz;
+    float3 acceleration = params.gravity.xyz;
+
+    for (uint i = 0; i < params.attractorCount; ++i) {
+        const ParticleAttractor attractor = forces.attractors[i];
+        const float3 toAttractor = attractor.positionStrength.xyz - position;
+        const float distance2 = dot(toAttractor, toAttractor);
+        const float radius2 = attractor.radius.x * attractor.radius.x;
+        acceleration += toAttractor * rsqrt(max(distance2, 1e-8)) *
+                        (attractor.positionStrength.w * radius2 / (radius2 + distance2));
+    }
+
+    if (params.noise.y != 0.0) {
+        acceleration += curlNoise(position * params.noise.x + float3(0.0, 0.0, params.noise.z)) * params.noise.y;
+    }
+
+    velocity += acceleration * dt;
+    velocity *= max(1.0 - params.gravity.w * dt, 0.0);
+    position += velocity * dt;
+
+    const float radius = 0.5 * mix(p.startSize, p.endSize, age / p.velocityLife.w);
+    for (uint i = 0; i < params.planeCount; ++i) {
+        const ParticlePlane plane = forces.planes[i];
+        const float3 normal = plane.plane.xyz;
+        const float distance = dot(normal, position) - plane.plane.w - radius;
+        if (distance < 0.0) {
+            position -= normal * distance;
+            const float normalSpeed = dot(velocity, normal);
+            if (normalSpeed < 0.0) {
+                const float3 tangent = velocity - normal * normalSpeed;
+                velocity = tangent * (1.0 - plane.response.y) - normal * (normalSpeed * plane.response.x);
+            }
+        }
+    }
+
+    particles[tid].positionAge = float4(position, age);
+    particles[tid].velocityLife.xyz = velocity;
+}
+
+// MARK: - Instances
+
+inline InstanceData makeParticleInstance(GpuParticle p, constant InstanceParams& params) {
+    const float t = saturate(p.positionAge.w / p.velocityLife.w);
+    const float size = mix(p.startSize, p.endSize, t);
+
+    float3 right = float3(1, 0, 0);
+    float3 up = float3(0, 1, 0);
+    if (params.billboard != 0) {
+        right = params.cameraRight.xyz;
+        up = params.cameraUp.xyz;
+    }
+
+    InstanceData instance;
+    instance.modelMatrix = float4x4(float4(right * size, 0.0),
+                                    float4(up * size, 0.0),
+                                    float4(cross(right, up) * size, 0.0),
+                                    float4(p.positionAge.xyz, 1.0));
+    instance.color = float4(mix(p.startColor, p.endColor, half(t)));
+    instance.userData = float4(t, p.positionAge.w, p.velocityLife.w, 0.0);
+    return instance;
+}
+
+kernel void resetParticleArguments(
+    device ParticleDrawArguments& arguments [[buffer(0)]],
+    constant uint& indexCount [[buffer(1)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    if (tid != 0) {
+        return;
+    }
+    arguments.indexCount = indexCount;
+    atomic_store_explicit(&arguments.instanceCount, 0u, memory_order_relaxed);
+    arguments.indexStart = 0;
+    arguments.baseVertex = 0;
+    arguments.baseInstance = 0;
+}
+
+/// Reserve slots for a SIMD group's live particles with one atomic
+inline uint reserveInstances(device ParticleDrawArguments& arguments, bool alive) {
+    const uint rank = simd_prefix_exclusive_sum(alive ? 1u : 0u);
+    const uint total = simd_sum(alive ? 1u : 0u);
+    uint base = 0;
+    if (simd_is_first() && total > 0) {
+        base = atomic_fetch_add_explicit(&arguments.instanceCount, total, memory_order_relaxed);
+    }
+    return simd_broadcast_first(base) + rank;
+}
+
+/**
+ * Unsorted: compact live particles into instances in no particular order.
+ */
+kernel void writeParticleInstances(
+    device const GpuParticle* particles [[buffer(0)]],
+    device InstanceData* instances [[buffer(1)]],
+    device ParticleDrawArguments& arguments [[buffer(2)]],
+    constant InstanceParams& params [[buffer(3)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    const bool alive = tid < params.count && particles[tid].velocityLife.w > 0.0;
+    const uint slot = reserveInstances(arguments, alive);
+    if (alive) {
+        instances[slot] = makeParticleInstance(particles[tid], params);
+    }
+}
+
+/**
+ * Sorted: one key per slot up to the padded key count, and the live count.
+ */
+kernel void writeParticleSortKeys(
+    device const GpuParticle* particles [[buffer(0)]],
+    device ParticleSortKey* keys [[buffer(1)]],
+    device ParticleDrawArguments& arguments [[buffer(2)]],
+    constant InstanceParams& params [[buffer(3)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    const bool alive = tid < params.count && particles[tid].velocityLife.w > 0.0;
+    reserveInstances(arguments, alive);
+    if (tid >= params.keyCount) {
+        return;
+    }
+
+    ParticleSortKey key;
+    key.index = tid;
+    key.depth = DEAD_PARTICLE_DEPTH;
+    if (alive) {
+        const float3 offset = particles[tid].positionAge.xyz - params.cameraPosition.xyz;
+        key.depth = max(dot(offset, params.cameraForward.xyz), -FLT_MAX * 0.5);
+    }
+    keys[tid] = key;
+}
+
+/**
+ * Sorted: instances back to front from the sorted keys. Live particles
+ * sort ahead of dead ones, so instance i is the i-th farthest.
+ */
+kernel void writeSortedParticleInstances(
+    device const GpuParticle* particles [[buffer(0)]],
+    device InstanceData* instances [[buffer(1)]],
+    device const ParticleSortKey* keys [[buffer(2)]],
+    constant InstanceParams& params [[buffer(3)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    if (tid >= params.count) {
+        return;
+    }
+    const ParticleSortKey key = keys[tid];
+    if (key.depth == DEAD_PARTICLE_DEPTH) {
+        return;
+    }
+    instances[tid] = makeParticleInstance(particles[key.index], params);
+}
+
+// MARK: - Depth Sort
+
+// Bitonic sort into descending depth. Steps shorter than a window run in
+// threadgroup memory, so a sort of n keys takes one dispatch per stage
+// beyond the window plus one per longer step, instead of one per step.
+constant uint PARTICLE_SORT_WINDOW = 1024;
+
+inline bool particleKeysOutOfOrder(ParticleSortKey a, ParticleSortKey b, bool descending) {
+    return descending ? a.depth < b.depth : a.depth > b.depth;
+}
+
+/**
+ * One global compare-exchange step. Dispatch with count / 2 threads.
+ */
+kernel void sortParticlesStep(
+    device ParticleSortKey* keys [[buffer(0)]],
+    constant ParticleSortParams& params [[buffer(1)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    if (tid >= params.count / 2) {
+        return;
+    }
+    const uint low = 2 * params.step * (tid / params.step) + (tid % params.step);
+    const uint high = low + params.step;
+    const ParticleSortKey a = keys[low];
+    const ParticleSortKey b = keys[high];
+    if (particleKeysOutOfOrder(a, b, (low & params.stage) == 0)) {
+        keys[low] = b;
+        keys[high] = a;
+    }
+}
+
+/**
+ * The steps within one window: every stage up to the window when
+ * params.stage is 0, else the short steps of params.stage. Dispatch with
+ * count / 2 threads in threadgroups of PARTICLE_SORT_WINDOW / 2.
+ */
+kernel void sortParticlesLocal(
+    device ParticleSortKey* keys [[buffer(0)]],
+    constant ParticleSortParams& params [[buffer(1)]],
+    uint lid [[thread_position_in_threadgroup]],
+    uint group [[threadgroup_position_in_grid]]
+) {
+    threadgroup ParticleSortKey window[PARTICLE_SORT_WINDOW];
+    const uint halfWindow = PARTICLE_SORT_WINDOW / 2;
+    const uint base = group * PARTICLE_SORT_WINDOW;
+
+    window[lid] = keys[base + lid];
+    window[lid + halfWindow] = keys[base + lid + halfWindow];
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+
+    const uint firstStage = params.stage == 0 ? 2 : params.stage;
+    const uint lastStage = params.stage == 0 ? PARTICLE_SORT_WINDOW : params.stage;
+    for (uint stage = firstStage; stage <= lastStage; stage <<= 1) {
+        for (uint step = min(stage, PARTICLE_SORT_WINDOW) >> 1; step > 0; step >>= 1) {
+            const uint low = 2 * step * (lid / step) + (lid % step);
+            const uint high = low + step;
+            const ParticleSortKey a = window[low];
+            const ParticleSortKey b = window[high];
+            if (particleKeysOutOfOrder(a, b, ((base + low) & stage) == 0)) {
+                window[low] = b;
+                window[high] = a;
+            }
+            threadgroup_barrier(mem_flags::mem_threadgroup);
+        }
+    }
+
+    keys[base + lid] = window[lid];
+    keys[base + lid + halfWindow] = window[lid + halfWindow];
+}
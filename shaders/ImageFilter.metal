@@ -0,0 +1,194 @@
+#include <metal_stdlib>
+
+using namespace metal;
+
+// ============================================================================
+// GPU Image Filter Compute Shaders
+// ============================================================================
+
+/**
+ * Unsharp mask: source + amount * (source - blurred).
+ * blurred is the Gaussian-blurred source (MPSImageGaussianBlur); unorm
+ * destinations clamp the result on write. Runs over the overlap of source
+ * and destination.
+ *
+ * Dispatch with one thread per destination pixel.
+ */
+kernel void unsharpMask(
+    texture2d<float, access::read> source [[texture(0)]],
+    texture2d<float, access::read> blurred [[texture(1)]],
+    texture2d<float, access::write> destination [[texture(2)]],
+    constant float& amount [[buffer(0)]],
+    uint2 gid [[thread_position_in_grid]]
+) {
+    if (gid.x >= min(source.get_width(), destination.get_width()) ||
+        gid.y >= min(source.get_height(), destination.get_height())) {
+        return;
+    }
+
+    const float4 original = source.read(gid);
+    const float4 smooth = blurred.read(gid);
+    destination.write(original + amount * (original - smooth), gid);
+}
+
+/// Per-pixel stage (matches ImagePointStage in DrawCommand.h)
+struct PointStage {
+    uint op;    // 0 linear, 1 saturation, 2 gamma, 3 threshold
+    float a;
+    float b;
+};
+
+/// Fused per-pixel stages (matches the uniforms in MetalRenderer::executeFilterTexture)
+struct PointUniforms {
+    uint stageCount;
+    PointStage stages[8];
+};
+
+/**
+ * Fused per-pixel filter: brightness, contrast, saturation, invert, gamma
+ * and threshold stages run in order in one pass over the image. Each stage
+ * changes RGB only and clamps to [0, 1], like the 8-bit CPU filters.
+ *
+ * Dispatch with one thread per destination pixel.
+ */
+kernel void pointFilter(
+    texture2d<float, access::read> source [[texture(0)]],
+    texture2d<float, access::write> destination [[texture(1)]],
+    constant PointUniforms& uniforms [[buffer(0)]],
+    uint2 gid [[thread_position_in_grid]]
+) {
+    if (gid.x >= min(source.get_width(), destination.get_width()) ||
+        gid.y >= min(source.get_height(), destination.get_height())) {
+        return;
+    }
+
+    float4 color = source.read(gid);
+    for (uint i = 0; i < uniforms.stageCount; i++) {
+        const PointStage stage = uniforms.stages[i];
+        float3 rgb = color.rgb;
+        switch (stage.op) {
+            case 0:
+                rgb = rgb * stage.a + stage.b;
+                break;
+            case 1: {
+                const float luma = dot(rgb, float3(0.299, 0.587, 0.114));
+                rgb = luma + stage.a * (rgb - luma);
+                break;
+            }
+            case 2:
+                rgb = pow(rgb, float3(stage.a));
+                break;
+            default:
+                rgb = select(float3(0.0), float3(1.0), rgb >= stage.a);
+                break;
+        }
+        color.rgb = saturate(rgb);
+    }
+    destination.write(color, gid);
+}
+
+// ============================================================================
+// Video Conversion
+// ============================================================================
+
+/// Affine YCbCr to RGB transform (matches the uniforms in MetalRenderer::executeConvertYCbCr)
+struct YCbCrUniforms {
+    float4 r;   // Dotted with (y, cb, cr, 1)
+    float4 g;
+    float4 b;
+};
+
+/**
+ * Bi-planar 4:2:0 YCbCr to RGB: full-size luma is read per pixel and the
+ * half-size chroma plane is sampled bilinearly at the pixel centre. Range
+ * expansion and the color matrix are folded into the uniforms. Runs over
+ * the overlap of luma and destination; alpha is opaque.
+ *
+ * Dispatch with one thread per destination pixel.
+ */
+kernel void ycbcrToRGB(
+    texture2d<float, access::read> luma [[texture(0)]],
+    texture2d<float, access::sample> chroma [[texture(1)]],
+    texture2d<float, access::write> destination [[texture(2)]],
+    constant YCbCrUniforms& uniforms [[buffer(0)]],
+    uint2 gid [[thread_position_in_grid]]
+) {
+    if (gid.x >= min(luma.get_width(), destination.get_width()) ||
+        gid.y >= min(luma.get_height(), destination.get_height())) {
+        return;
+    }
+
+    constexpr sampler chromaSampler(filter::linear, address::clamp_to_edge);
+    const float2 uv = (float2(gid) + 0.5) / float2(luma.get_width(), luma.get_height());
+    const float4 ycbcr = float4(luma.read(gid).r, chroma.sample(chromaSampler, uv).rg, 1.0);
+    const float3 rgb = float3(dot(uniforms.r, ycbcr), dot(uniforms.g, ycbcr), dot(uniforms.b, ycbcr));
+    destination.write(float4(saturate(rgb), 1.0), gid);
+}
+
+/**
+ * Scaled YCoCg (HAP Q) to RGB. The color texture holds Co, Cg, a per-block
+ * scale and Y; chroma is centred and divided by the scale. HAP Q Alpha adds
+ * a BC4 plane whose red channel is alpha (hasAlpha, buffer(0)); otherwise
+ * alpha is opaque. Compressed textures are sampled at texel centres.
+ *
+ * Dispatch with one thread per destination pixel.
+ */
+kernel void ycocgToRGB(
+    texture2d<float, access::sample> color [[texture(0)]],
+    texture2d<float, access::sample> alpha [[texture(1)]],
+    texture2d<float, access::write> destination [[texture(2)]],
+    constant uint& hasAlpha [[buffer(0)]],
+    uint2 gid [[thread_position_in_grid]]
+) {
+    if (gid.x >= min(color.get_width(), destination.get_width()) ||
+        gid.y >= min(color.get_height(), destination.get_height())) {
+        return;
+    }
+
+    constexpr sampler texel(filter::nearest, address::clamp_to_edge);
+    const float2 uv = (float2(gid) + 0.5) / float2(color.get_width(), color.get_height());
+    const float4 cocgsy = color.sample(texel, uv) - float4(128.0 / 255.0, 128.0 / 255.0, 0.0, 0.0);
+    const float scale = cocgsy.z * (255.0 / 8.0) + 1.0;
+    const float co = cocgsy.x / scale;
+    const float cg = cocgsy.y / scale;
+    const float y = cocgsy.w;
+    const float3 rgb = float3(y + co - cg, y + cg, y - co - cg);
+    const float a = hasAlpha ? alpha.sample(texel, uv).r : 1.0;
+    destination.write(float4(saturate(rgb), a), gid);
+}
+
+// ============================================================================
+// Frame Capture
+// ============================================================================
+
+struct CopyUniforms {
+    uint opaque;
+    float2 sourceScale;     // Copied region / source size
+};
+
+/**
+ * Scaled copy for frame capture and dynamic resolution: the source region
+ * is sampled bilinearly over the whole destination, and the write converts
+ * to the destination's pixel format (RGBA targets into BGRA encoder
+ * buffers). opaque sets alpha to 1.
+ *
+ * Dispatch with one thread per destination pixel.
+ */
+kernel void copyTexture(
+    texture2d<float, access::sample> source [[texture(0)]],
+    texture2d<float, access::write> destination [[texture(1)]],
+    constant CopyUniforms& uniforms [[buffer(0)]],
+    uint2 gid [[thread_position_in_grid]]
+) {
+    if (gid.x >= destination.get_width() || gid.y >= destination.get_height()) {
+        return;
+    }
+
+    constexpr sampler sourceSampler(filter::linear, address::clamp_to_edge);
+    const float2 uv = (float2(gid) + 0.5) / float2(destination.get_width(), destination.get_height());
+    float4 color = source.sample(sourceSampler, uv * uniforms.sourceScale);
+    if (uniforms.opaque != 0) {
+        color.a = 1.0;
+    }
+    destination.write(color, gid);
+}
@@ -1,5 +1,7 @@
 #include <metal_stdlib>
 #include "Common.h"
+#include "BlendModes.h"
+#include "Transparency.h"
 
 using namespace metal;
 
@@ -11,7 +13,8 @@ constant int LIGHT_TYPE_DIRECTIONAL = 1;
 constant int LIGHT_TYPE_SPOT = 2;
 
 /// Light data structure for shader uniform buffer
-/// Layout matches ofLight::getUniformData() format (22 floats per light, tightly packed)
+/// Layout matches ofLight::getUniformData() format (22 floats per light, tightly packed;
+/// render::kLightFloats)
 struct LightData {
     float type;              // Light type (0=Point, 1=Directional, 2=Spot)
     packed_float3 position;  // Light position (world space) - packed to avoid alignment padding
@@ -44,8 +47,131 @@ struct LightingUniforms {
     int numLights;              // Number of active lights
     int lightingEnabled;        // 1 if lighting enabled, 0 otherwise
     int smoothShading;          // 1 for Phong (smooth), 0 for flat
+    int firstLight;             // First light of this draw in the light buffer
+    int clustered;              // 1 if the cluster lists at buffer(4)/(5) are valid
+    float clusterNear;          // View depth where the first depth slice starts
+    float clusterScale;         // CLUSTER_SLICES / log(far / near)
 };
 
+// MARK: - Light Clusters
+
+/// Cluster grid: screen tiles in NDC x depth slices spaced exponentially
+/// between the projection's near and far depth (matches MetalRenderer.mm)
+constant uint CLUSTER_TILES_X = 16;
+constant uint CLUSTER_TILES_Y = 8;
+constant uint CLUSTER_SLICES = 24;
+constant uint CLUSTER_COUNT = CLUSTER_TILES_X * CLUSTER_TILES_Y * CLUSTER_SLICES;
+
+/// Light indices stored per cluster; fuller clusters are marked overflowed
+/// and shaded with every light
+constant uint MAX_LIGHTS_PER_CLUSTER = 64;
+constant uint CLUSTER_OVERFLOW = 0xFFFFFFFF;
+
+/// Attenuation below which a light is treated as out of range
+constant float LIGHT_CUTOFF = 1.0 / 256.0;
+
+/// Light cluster build uniforms (matches LightClusterUniforms in MetalRenderer.mm)
+struct LightClusterUniforms {
+    float4x4 inverseProjection;
+    float nearZ;                // View depth range covered by the slices
+    float farZ;
+    uint firstLight;            // Light set to bin
+    uint lightCount;
+};
+
+// MARK: - Shadows
+
+/// Shadow-casting lights a draw samples and cascades per light (matches
+/// render::kMaxShadowLights and render::kMaxShadowCascades)
+constant int MAX_SHADOW_LIGHTS = 4;
+constant int MAX_SHADOW_CASCADES = 4;
+
+/// Shadow map of one light (matches render::ShadowLight)
+struct ShadowLight {
+    float4x4 matrices[MAX_SHADOW_CASCADES]; // View space -> shadow map clip space, per cascade
+    float4 splits;              // Far view depth of each cascade
+    int lightIndex;             // Light within the draw's lights
+    int cascadeCount;           // Slices of the shadow map in use
+    float bias;                 // Receiver depth bias
+    float strength;             // 0 = unshadowed, 1 = fully shadowed
+    float texelSize;            // PCF step in texture coordinates
+    float padding[3];
+};
+
+/// Shadow uniforms at buffer(6) (matches render::ShadowUniforms)
+struct ShadowUniforms {
+    int count;
+    int padding[3];
+    ShadowLight lights[MAX_SHADOW_LIGHTS];
+};
+
+/// Shadow factors of a fragment, by light
+struct ShadowTerms {
+    int count;
+    int lightIndex[MAX_SHADOW_LIGHTS];
+    float factor[MAX_SHADOW_LIGHTS];
+};
+
+/// Depth comparison with bilinear filtering: each tap is itself a 2x2 PCF
+constexpr sampler shadowSampler(coord::normalized, filter::linear, address::clamp_to_edge,
+                                compare_func::less_equal);
+
+/// Sample every shadow map of the draw at a fragment
+/// Picks each light's cascade by view depth and filters it with 3x3 PCF.
+/// Fragments outside a map or beyond the last cascade are unshadowed.
+/// \param shadows Shadow uniforms of the draw
+/// \param shadowMaps Shadow maps, by light
+/// \param fragPosition Fragment position (view space)
+/// \return Shadow factor (1 = lit) per shadowed light
+static ShadowTerms computeShadows(constant ShadowUniforms& shadows,
+                                  array<depth2d_array<float>, MAX_SHADOW_LIGHTS> shadowMaps,
+                                  float3 fragPosition) {
+    ShadowTerms terms;
+    terms.count = min(shadows.count, MAX_SHADOW_LIGHTS);
+    float depth = -fragPosition.z;
+    for (int s = 0; s < terms.count; ++s) {
+        constant ShadowLight& shadow = shadows.lights[s];
+        terms.lightIndex[s] = shadow.lightIndex;
+        terms.factor[s] = 1.0;
+
+        int cascade = 0;
+        while (cascade < shadow.cascadeCount && depth > shadow.splits[cascade]) {
+            ++cascade;
+        }
+        if (cascade == shadow.cascadeCount) {
+            continue;
+        }
+
+        float4 clip = shadow.matrices[cascade] * float4(fragPosition, 1.0);
+        float3 ndc = clip.xyz / clip.w;
+        float2 uv = ndc.xy * float2(0.5, -0.5) + 0.5;
+        if (any(uv < 0.0) || any(uv > 1.0) || ndc.z > 1.0) {
+            continue;
+        }
+
+        float reference = ndc.z - shadow.bias;
+        float lit = 0.0;
+        for (int y = -1; y <= 1; ++y) {
+            for (int x = -1; x <= 1; ++x) {
+                float2 offset = float2(x, y) * shadow.texelSize;
+                lit += shadowMaps[s].sample_compare(shadowSampler, uv + offset, uint(cascade), reference);
+            }
+        }
+        terms.factor[s] = 1.0 - shadow.strength * (1.0 - lit / 9.0);
+    }
+    return terms;
+}
+
+/// Shadow factor of one of the draw's lights (1 for lights without a shadow map)
+static float shadowFactor(thread const ShadowTerms& terms, int lightIndex) {
+    for (int s = 0; s < terms.count; ++s) {
+        if (terms.lightIndex[s] == lightIndex) {
+            return terms.factor[s];
+        }
+    }
+    return 1.0;
+}
+
 // MARK: - Phong Lighting Functions
 
 /// Calculate attenuation factor based on distance
@@ -82,13 +208,15 @@ float calculateSpotlightEffect(constant LightData& light, float3 lightDir) {
 /// \param fragPosition Fragment position (view space)
 /// \param normal Surface normal (view space, normalized)
 /// \param viewDir View direction (view space, normalized)
+/// \param shadow Shadow factor (1 = lit); scales diffuse and specular only
 /// \return RGB color contribution from this light
 float3 calculatePhongLight(
     constant LightData& light,
     constant MaterialData& material,
     float3 fragPosition,
     float3 normal,
-    float3 viewDir
+    float3 viewDir,
+    float shadow = 1.0
 ) {
     // Skip disabled lights
     if (light.enabled < 0.5) {
@@ -138,21 +266,151 @@ float3 calculatePhongLight(
     }
 
     // Combine components with attenuation
-    return (ambient + diffuse + specular) * attenuation;
+    return (ambient + (diffuse + specular) * shadow) * attenuation;
 }
 
-// MARK: - Vertex Shader
+/// Accumulate the contribution of a draw's lights
+/// Clustered draws shade only the lights binned into the fragment's cluster;
+/// overflowed clusters and unclustered draws loop over every light.
+float3 accumulateLights(
+    constant LightingUniforms& uniforms,
+    constant MaterialData& material,
+    constant LightData* lights,
+    device const uint* clusterCounts,
+    device const ushort* clusterIndices,
+    thread const ShadowTerms& shadows,
+    float3 fragPosition,
+    float3 normal,
+    float3 viewDir
+) {
+    constant LightData* drawLights = lights + uniforms.firstLight;
+    float3 color = float3(0.0);
+
+    if (uniforms.clustered != 0) {
+        float4 clip = uniforms.projectionMatrix * float4(fragPosition, 1.0);
+        float2 ndc = clip.xy / clip.w;
+        uint tileX = uint(clamp((ndc.x * 0.5 + 0.5) * float(CLUSTER_TILES_X), 0.0, float(CLUSTER_TILES_X - 1)));
+        uint tileY = uint(clamp((ndc.y * 0.5 + 0.5) * float(CLUSTER_TILES_Y), 0.0, float(CLUSTER_TILES_Y - 1)));
+        float depth = max(-fragPosition.z, uniforms.clusterNear);
+        uint slice = uint(clamp(log(depth / uniforms.clusterNear) * uniforms.clusterScale,
+                                0.0, float(CLUSTER_SLICES - 1)));
+        uint cluster = tileX + CLUSTER_TILES_X * (tileY + CLUSTER_TILES_Y * slice);
+
+        uint count = clusterCounts[cluster];
+        if (count != CLUSTER_OVERFLOW) {
+            device const ushort* indices = clusterIndices + cluster * MAX_LIGHTS_PER_CLUSTER;
+            for (uint i = 0; i < count; ++i) {
+                color += calculatePhongLight(drawLights[indices[i]], material, fragPosition, normal, viewDir,
+                                             shadowFactor(shadows, indices[i]));
+            }
+            return color;
+        }
+    }
 
-/// Lighting vertex shader
-/// Transforms vertices and passes data to fragment shader
-vertex RasterizerData3D vertexLighting(
-    uint vertexID [[vertex_id]],
-    constant Vertex3D* vertices [[buffer(0)]],
-    constant LightingUniforms& uniforms [[buffer(1)]]
+    // Note: Metal compiler will unroll small loops automatically
+    [[unroll_count(8)]] // Hint for typical light count
+    for (int i = 0; i < uniforms.numLights; ++i) {
+        color += calculatePhongLight(drawLights[i], material, fragPosition, normal, viewDir,
+                                     shadowFactor(shadows, i));
+    }
+    return color;
+}
+
+/// Distance beyond which a light's attenuation drops below LIGHT_CUTOFF
+/// \return INFINITY for lights without distance falloff
+static float lightRange(constant LightData& light) {
+    if (int(light.type) == LIGHT_TYPE_DIRECTIONAL) {
+        return INFINITY;
+    }
+    // Solve constant + linear * d + quadratic * d^2 = 1 / LIGHT_CUTOFF
+    float c = light.attenuation.x - 1.0 / LIGHT_CUTOFF;
+    float l = light.attenuation.y;
+    float q = light.attenuation.z;
+    if (c >= 0.0) {
+        return 0.0;
+    }
+    if (q > 0.0) {
+        return (-l + sqrt(l * l - 4.0 * q * c)) / (2.0 * q);
+    }
+    return l > 0.0 ? -c / l : INFINITY;
+}
+
+/// Intersect the view ray through an NDC point with the plane z = -depth
+static float3 clusterCorner(float4x4 inverseProjection, float2 ndc, float depth) {
+    // Two points on the ray, valid for perspective and orthographic projections
+    float4 a = inverseProjection * float4(ndc, 0.0, 1.0);
+    float4 b = inverseProjection * float4(ndc, 1.0, 1.0);
+    float3 p0 = a.xyz / a.w;
+    float3 p1 = b.xyz / b.w;
+    float t = (-depth - p0.z) / (p1.z - p0.z);
+    return p0 + t * (p1 - p0);
+}
+
+/// Bin a light set into the cluster grid
+/// One thread per cluster: builds the cluster's view-space bounds and tests
+/// every light's range sphere against them. Lights are in the same space as
+/// the fragment positions (view space).
+kernel void buildLightClusters(
+    constant LightData* lights [[buffer(0)]],
+    device uint* clusterCounts [[buffer(1)]],
+    device ushort* clusterIndices [[buffer(2)]],
+    constant LightClusterUniforms& uniforms [[buffer(3)]],
+    uint cluster [[thread_position_in_grid]]
 ) {
-    RasterizerData3D out;
+    if (cluster >= CLUSTER_COUNT) {
+        return;
+    }
 
-    Vertex3D in = vertices[vertexID];
+    uint tileX = cluster % CLUSTER_TILES_X;
+    uint tileY = (cluster / CLUSTER_TILES_X) % CLUSTER_TILES_Y;
+    uint slice = cluster / (CLUSTER_TILES_X * CLUSTER_TILES_Y);
+
+    float2 ndcMin = float2(float(tileX) / float(CLUSTER_TILES_X), float(tileY) / float(CLUSTER_TILES_Y)) * 2.0 - 1.0;
+    float2 ndcMax = float2(float(tileX + 1) / float(CLUSTER_TILES_X), float(tileY + 1) / float(CLUSTER_TILES_Y)) * 2.0 - 1.0;
+    float ratio = uniforms.farZ / uniforms.nearZ;
+    float depthNear = uniforms.nearZ * powr(ratio, float(slice) / float(CLUSTER_SLICES));
+    float depthFar = uniforms.nearZ * powr(ratio, float(slice + 1) / float(CLUSTER_SLICES));
+
+    float3 boundsMin = float3(INFINITY);
+    float3 boundsMax = float3(-INFINITY);
+    for (uint corner = 0; corner < 8; ++corner) {
+        float2 ndc = float2((corner & 1) ? ndcMax.x : ndcMin.x, (corner & 2) ? ndcMax.y : ndcMin.y);
+        float3 p = clusterCorner(uniforms.inverseProjection, ndc, (corner & 4) ? depthFar : depthNear);
+        boundsMin = min(boundsMin, p);
+        boundsMax = max(boundsMax, p);
+    }
+
+    constant LightData* setLights = lights + uniforms.firstLight;
+    device ushort* indices = clusterIndices + cluster * MAX_LIGHTS_PER_CLUSTER;
+    uint count = 0;
+    for (uint i = 0; i < uniforms.lightCount; ++i) {
+        constant LightData& light = setLights[i];
+        if (light.enabled < 0.5) {
+            continue;
+        }
+        float range = lightRange(light);
+        if (isfinite(range)) {
+            float3 position = light.position;
+            float3 closest = clamp(position, boundsMin, boundsMax);
+            float3 offset = closest - position;
+            if (dot(offset, offset) > range * range) {
+                continue;
+            }
+        }
+        if (count == MAX_LIGHTS_PER_CLUSTER) {
+            count = CLUSTER_OVERFLOW;
+            break;
+        }
+        indices[count++] = ushort(i);
+    }
+    clusterCounts[cluster] = count;
+}
+
+// MARK: - Vertex Shader
+
+/// Shared body of vertexLighting and vertexLightingPacked
+static RasterizerData3D transformVertexLighting(Vertex3D in, constant LightingUniforms& uniforms) {
+    RasterizerData3D out;
 
     // Transform position to clip space
     float4 position = float4(in.position, 1.0);
@@ -172,16 +430,81 @@ vertex RasterizerData3D vertexLighting(
     return out;
 }
 
-// MARK: - Fragment Shaders
+/// Shared body of vertexLightingInstanced and vertexLightingInstancedPacked
+static RasterizerData3D transformVertexLightingInstanced(Vertex3D in, InstanceData instance,
+                                                         constant LightingUniforms& uniforms) {
+    RasterizerData3D out;
 
-/// Phong lighting fragment shader (multi-light)
-/// Calculates lighting from all active lights using Phong model
-fragment float4 fragmentPhongLighting(
-    RasterizerData3D in [[stage_in]],
+    // Transform position to clip space (instance transform first)
+    float4 viewPosition = uniforms.modelViewMatrix * (instance.modelMatrix * float4(in.position, 1.0));
+    out.position = uniforms.projectionMatrix * viewPosition;
+
+    // Transform normal to view space (exact for rotation and uniform scale)
+    out.normal = (uniforms.normalMatrix * (instance.modelMatrix * float4(in.normal, 0.0))).xyz;
+
+    // World/view position for lighting calculations
+    out.worldPosition = viewPosition.xyz;
+
+    // Pass through texture coordinates, tint color per instance
+    out.texCoord = in.texCoord;
+    out.color = in.color * instance.color;
+
+    return out;
+}
+
+/// Lighting vertex shader
+/// Transforms vertices and passes data to fragment shader
+vertex RasterizerData3D vertexLighting(
+    uint vertexID [[vertex_id]],
+    constant Vertex3D* vertices [[buffer(0)]],
+    constant LightingUniforms& uniforms [[buffer(1)]]
+) {
+    return transformVertexLighting(vertices[vertexID], uniforms);
+}
+
+/// Lighting vertex shader for PackedVertex3D input
+vertex RasterizerData3D vertexLightingPacked(
+    uint vertexID [[vertex_id]],
+    constant PackedVertex3D* vertices [[buffer(0)]],
+    constant LightingUniforms& uniforms [[buffer(1)]]
+) {
+    return transformVertexLighting(unpackVertex(vertices[vertexID]), uniforms);
+}
+
+/// Instanced lighting vertex shader
+/// Same as vertexLighting, with each instance's transform and color applied
+vertex RasterizerData3D vertexLightingInstanced(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    constant Vertex3D* vertices [[buffer(0)]],
     constant LightingUniforms& uniforms [[buffer(1)]],
-    constant MaterialData& material [[buffer(2)]],
-    constant LightData* lights [[buffer(3)]]
+    constant InstanceData* instances [[buffer(2)]]
+) {
+    return transformVertexLightingInstanced(vertices[vertexID], instances[instanceID], uniforms);
+}
+
+/// Instanced lighting vertex shader for PackedVertex3D input
+vertex RasterizerData3D vertexLightingInstancedPacked(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    constant PackedVertex3D* vertices [[buffer(0)]],
+    constant LightingUniforms& uniforms [[buffer(1)]],
+    constant InstanceData* instances [[buffer(2)]]
 ) {
+    return transformVertexLightingInstanced(unpackVertex(vertices[vertexID]), instances[instanceID], uniforms);
+}
+
+// MARK: - Fragment Shaders
+
+/// Shared body of fragmentPhongLighting and fragmentPhongLightingBlend
+static float4 shadePhongLighting(RasterizerData3D in,
+                                 constant LightingUniforms& uniforms,
+                                 constant MaterialData& material,
+                                 constant LightData* lights,
+                                 device const uint* clusterCounts,
+                                 device const ushort* clusterIndices,
+                                 constant ShadowUniforms& shadows,
+                                 array<depth2d_array<float>, MAX_SHADOW_LIGHTS> shadowMaps) {
     // Normalize interpolated normal
     float3 normal = normalize(in.normal);
 
@@ -191,12 +514,10 @@ fragment float4 fragmentPhongLighting(
     // Initialize final color with emissive component
     float3 finalColor = material.emissiveColor;
 
-    // Accumulate lighting from all active lights
-    // Note: Metal compiler will unroll small loops automatically
-    [[unroll_count(8)]] // Hint for typical light count
-    for (int i = 0; i < uniforms.numLights; ++i) {
-        finalColor += calculatePhongLight(lights[i], material, in.worldPosition, normal, viewDir);
-    }
+    // Accumulate lighting from the fragment's lights
+    ShadowTerms shadowTerms = computeShadows(shadows, shadowMaps, in.worldPosition);
+    finalColor += accumulateLights(uniforms, material, lights, clusterCounts, clusterIndices, shadowTerms,
+                                   in.worldPosition, normal, viewDir);
 
     // Modulate with vertex color
     finalColor *= in.color.rgb;
@@ -207,6 +528,54 @@ fragment float4 fragmentPhongLighting(
     return float4(finalColor, in.color.a);
 }
 
+/// Phong lighting fragment shader (multi-light)
+/// Calculates lighting from the draw's lights using Phong model
+fragment float4 fragmentPhongLighting(
+    RasterizerData3D in [[stage_in]],
+    constant LightingUniforms& uniforms [[buffer(1)]],
+    constant MaterialData& material [[buffer(2)]],
+    constant LightData* lights [[buffer(3)]],
+    device const uint* clusterCounts [[buffer(4)]],
+    device const ushort* clusterIndices [[buffer(5)]],
+    constant ShadowUniforms& shadows [[buffer(6)]],
+    array<depth2d_array<float>, MAX_SHADOW_LIGHTS> shadowMaps [[texture(1)]]
+) {
+    return shadePhongLighting(in, uniforms, material, lights, clusterCounts, clusterIndices, shadows, shadowMaps);
+}
+
+/// fragmentPhongLighting blended over [[color(0)]] with kProgrammableBlendMode (see BlendModes.h)
+fragment float4 fragmentPhongLightingBlend(
+    RasterizerData3D in [[stage_in]],
+    float4 dst [[color(0)]],
+    constant LightingUniforms& uniforms [[buffer(1)]],
+    constant MaterialData& material [[buffer(2)]],
+    constant LightData* lights [[buffer(3)]],
+    device const uint* clusterCounts [[buffer(4)]],
+    device const ushort* clusterIndices [[buffer(5)]],
+    constant ShadowUniforms& shadows [[buffer(6)]],
+    array<depth2d_array<float>, MAX_SHADOW_LIGHTS> shadowMaps [[texture(1)]]
+) {
+    return programmableBlend(shadePhongLighting(in, uniforms, material, lights, clusterCounts, clusterIndices,
+                                                shadows, shadowMaps),
+                             dst);
+}
+
+/// fragmentPhongLighting accumulated for weighted blended transparency (see Transparency.h)
+fragment TransparentFragment fragmentPhongLightingTransparent(
+    RasterizerData3D in [[stage_in]],
+    constant LightingUniforms& uniforms [[buffer(1)]],
+    constant MaterialData& material [[buffer(2)]],
+    constant LightData* lights [[buffer(3)]],
+    device const uint* clusterCounts [[buffer(4)]],
+    device const ushort* clusterIndices [[buffer(5)]],
+    constant ShadowUniforms& shadows [[buffer(6)]],
+    array<depth2d_array<float>, MAX_SHADOW_LIGHTS> shadowMaps [[texture(1)]]
+) {
+    return weightedTransparency(shadePhongLighting(in, uniforms, material, lights, clusterCounts, clusterIndices,
+                                                   shadows, shadowMaps),
+                                in.position.z);
+}
+
 /// Phong lighting fragment shader with texture (multi-light)
 /// Calculates lighting and samples texture
 fragment float4 fragmentPhongLightingTextured(
@@ -214,7 +583,11 @@ fragment float4 fragmentPhongLightingTextured(
     constant LightingUniforms& uniforms [[buffer(1)]],
     constant MaterialData& material [[buffer(2)]],
     constant LightData* lights [[buffer(3)]],
+    device const uint* clusterCounts [[buffer(4)]],
+    device const ushort* clusterIndices [[buffer(5)]],
+    constant ShadowUniforms& shadows [[buffer(6)]],
     texture2d<float> colorTexture [[texture(0)]],
+    array<depth2d_array<float>, MAX_SHADOW_LIGHTS> shadowMaps [[texture(1)]],
     sampler textureSampler [[sampler(0)]]
 ) {
     // Normalize interpolated normal
@@ -226,12 +599,10 @@ fragment float4 fragmentPhongLightingTextured(
     // Initialize final color with emissive component
     float3 finalColor = material.emissiveColor;
 
-    // Accumulate lighting from all active lights
-    // Note: Metal compiler will unroll small loops automatically
-    [[unroll_count(8)]] // Hint for typical light count
-    for (int i = 0; i < uniforms.numLights; ++i) {
-        finalColor += calculatePhongLight(lights[i], material, in.worldPosition, normal, viewDir);
-    }
+    // Accumulate lighting from the fragment's lights
+    ShadowTerms shadowTerms = computeShadows(shadows, shadowMaps, in.worldPosition);
+    finalColor += accumulateLights(uniforms, material, lights, clusterCounts, clusterIndices, shadowTerms,
+                                   in.worldPosition, normal, viewDir);
 
     // Sample texture
     float4 texColor = colorTexture.sample(textureSampler, in.texCoord);
@@ -251,7 +622,11 @@ fragment float4 fragmentFlatLighting(
     RasterizerData3D in [[stage_in]],
     constant LightingUniforms& uniforms [[buffer(1)]],
     constant MaterialData& material [[buffer(2)]],
-    constant LightData* lights [[buffer(3)]]
+    constant LightData* lights [[buffer(3)]],
+    device const uint* clusterCounts [[buffer(4)]],
+    device const ushort* clusterIndices [[buffer(5)]],
+    constant ShadowUniforms& shadows [[buffer(6)]],
+    array<depth2d_array<float>, MAX_SHADOW_LIGHTS> shadowMaps [[texture(1)]]
 ) {
     // Use face normal (via derivative) for flat shading
     float3 dFdxPos = dfdx(in.worldPosition);
@@ -264,12 +639,10 @@ fragment float4 fragmentFlatLighting(
     // Initialize final color with emissive component
     float3 finalColor = material.emissiveColor;
 
-    // Accumulate lighting from all active lights
-    // Note: Metal compiler will unroll small loops automatically
-    [[unroll_count(8)]] // Hint for typical light count
-    for (int i = 0; i < uniforms.numLights; ++i) {
-        finalColor += calculatePhongLight(lights[i], material, in.worldPosition, normal, viewDir);
-    }
+    // Accumulate lighting from the fragment's lights
+    ShadowTerms shadowTerms = computeShadows(shadows, shadowMaps, in.worldPosition);
+    finalColor += accumulateLights(uniforms, material, lights, clusterCounts, clusterIndices, shadowTerms,
+                                   in.worldPosition, normal, viewDir);
 
     // Modulate with vertex color
     finalColor *= in.color.rgb;
@@ -0,0 +1,467 @@
+#include <metal_stdlib>
+#include "Common.h"
+
+using namespace metal;
+
+// ============================================================================
+// Mesh-Shader Primitives (Sphere, Cylinder, IcoSphere)
+// ============================================================================
+
+// ofDrawSphere, ofDrawCylinder and ofDrawIcoSphere without vertex data. The
+// unit surface is split into meshlets: square patches of a latitude/longitude
+// grid (sphere, cylinder side and caps) or triangles of each icosahedron
+// face. The object stage runs one thread per meshlet and instance, drops
+// meshlets outside the frustum and gives each edge of the rest a level (a
+// power of two up to the meshlet's segments) from its projected length. The
+// mesh stage tessellates the meshlet at its finest edge level and snaps
+// boundary vertices to each edge's own level; neighbours compute the same
+// level for a shared edge, so they meet without cracks.
+//
+// Lattice coordinates are integers of the finest tessellation (segments per
+// meshlet side * meshlets); every surface point comes from them alone, so
+// vertices on shared edges are bit-identical across meshlets.
+
+constant uint MESHLET_SEGMENTS = 8;             // kMeshletSegments in DrawCommand.h
+constant uint MESHLETS_PER_OBJECT = 32;         // Object threadgroup size (one simdgroup)
+constant uint MESHLET_MAX_VERTICES = (MESHLET_SEGMENTS + 1) * (MESHLET_SEGMENTS + 1);
+constant uint MESHLET_MAX_TRIANGLES = 2 * MESHLET_SEGMENTS * MESHLET_SEGMENTS;
+
+constant uint MESH_PRIMITIVE_SPHERE = 0;        // render::MeshPrimitive
+constant uint MESH_PRIMITIVE_CYLINDER = 1;
+constant uint MESH_PRIMITIVE_ICOSPHERE = 2;
+
+constant uint SURFACE_SPHERE = 0;
+constant uint SURFACE_CYLINDER_SIDE = 1;
+constant uint SURFACE_CYLINDER_TOP = 2;
+constant uint SURFACE_CYLINDER_BOTTOM = 3;
+constant uint SURFACE_ICOSPHERE = 4;
+
+/// Meshlet layout of the draw (matches MeshPrimitiveParams in MetalRenderer.mm)
+struct MeshPrimitiveParams {
+    uint primitive;         // MESH_PRIMITIVE_*
+    uint segments;          // Finest segments per meshlet side (power of two)
+    uint columns;           // Meshlets around (sphere, cylinder) or per face edge (icosphere)
+    uint rows;              // Meshlets from pole to pole (sphere)
+    uint meshletCount;      // Per instance
+    float edgePixels;       // Target projected length of one segment
+    float2 viewportSize;    // Pixels
+};
+
+/// Visible meshlets of one object threadgroup
+struct MeshPrimitivePayload {
+    uint instance;
+    uint meshlets[MESHLETS_PER_OBJECT];     // Meshlet << 8 | log2 level of edges 0-3, 2 bits each
+};
+
+/// Where a meshlet sits on the surface: local lattice (s, t) at level L is
+/// origin + (s * axisS + t * axisT) * segments / L in finest coordinates
+struct MeshletPatch {
+    uint surface;           // SURFACE_*
+    uint face;              // Icosahedron face
+    int2 origin;
+    int2 axisS;
+    int2 axisT;
+    bool triangle;          // s + t <= L (icosphere) instead of s, t <= L
+};
+
+using MeshletMesh = metal::mesh<RasterizerData3D, void, MESHLET_MAX_VERTICES, MESHLET_MAX_TRIANGLES,
+                                metal::topology::triangle>;
+
+// MARK: - Surfaces
+
+/// Unit icosahedron (matches the vertices ofDrawIcoSphere subdivides)
+constant float3 ICOSAHEDRON_VERTICES[12] = {
+    float3(-0.5257311, 0.8506508, 0.0), float3(0.5257311, 0.8506508, 0.0),
+    float3(-0.5257311, -0.8506508, 0.0), float3(0.5257311, -0.8506508, 0.0),
+    float3(0.0, -0.5257311, 0.8506508), float3(0.0, 0.5257311, 0.8506508),
+    float3(0.0, -0.5257311, -0.8506508), float3(0.0, 0.5257311, -0.8506508),
+    float3(0.8506508, 0.0, -0.5257311), float3(0.8506508, 0.0, 0.5257311),
+    float3(-0.8506508, 0.0, -0.5257311), float3(-0.8506508, 0.0, 0.5257311)
+};
+
+constant uchar3 ICOSAHEDRON_FACES[20] = {
+    uchar3(0, 11, 5), uchar3(0, 5, 1), uchar3(0, 1, 7), uchar3(0, 7, 10), uchar3(0, 10, 11),
+    uchar3(1, 5, 9), uchar3(5, 11, 4), uchar3(11, 10, 2), uchar3(10, 7, 6), uchar3(7, 1, 8),
+    uchar3(3, 9, 4), uchar3(3, 4, 2), uchar3(3, 2, 6), uchar3(3, 6, 8), uchar3(3, 8, 9),
+    uchar3(4, 9, 5), uchar3(2, 4, 11), uchar3(6, 2, 10), uchar3(8, 6, 7), uchar3(9, 8, 1)
+};
+
+struct SurfacePoint {
+    float3 position;
+    float3 normal;
+    float2 texCoord;
+};
+
+/// Point q of n along the icosahedron edge a-b, computed from the lower
+/// vertex index so both faces on the edge get the same bits
+static float3 icosahedronEdgePoint(uint a, uint b, float q, float n) {
+    if (a > b) {
+        const uint swap = a;
+        a = b;
+        b = swap;
+        q = n - q;
+    }
+    return normalize(mix(ICOSAHEDRON_VERTICES[a], ICOSAHEDRON_VERTICES[b], q / n));
+}
+
+/// Point (i, j) of face with n segments per edge, projected onto the sphere
+static float3 icosahedronPoint(uint face, float2 g, float n) {
+    const uchar3 f = ICOSAHEDRON_FACES[face];
+    if (g.y == 0.0) {
+        return icosahedronEdgePoint(f.x, f.y, g.x, n);
+    }
+    if (g.x == 0.0) {
+        return icosahedronEdgePoint(f.x, f.z, g.y, n);
+    }
+    if (g.x + g.y == n) {
+        return icosahedronEdgePoint(f.y, f.z, g.y, n);
+    }
+    const float3 a = ICOSAHEDRON_VERTICES[f.x];
+    const float3 b = ICOSAHEDRON_VERTICES[f.y];
+    const float3 c = ICOSAHEDRON_VERTICES[f.z];
+    return normalize(a + (b - a) * (g.x / n) + (c - a) * (g.y / n));
+}
+
+/// Surface point at finest lattice coordinates g (whole or half steps)
+static SurfacePoint surfacePoint(constant MeshPrimitiveParams& params, uint surface, uint face, float2 g) {
+    SurfacePoint p;
+    if (surface == SURFACE_ICOSPHERE) {
+        p.position = icosahedronPoint(face, g, float(params.columns * params.segments));
+        p.normal = p.position;
+        p.texCoord = float2(0.5 + atan2(p.position.z, p.position.x) / (2.0 * M_PI_F),
+                            0.5 - asin(p.position.y) / M_PI_F);
+        return p;
+    }
+
+    // Around the y axis; the seam column wraps onto the first for position
+    const float around = float(params.columns * params.segments);
+    const float angle = 2.0 * M_PI_F * (g.x < around ? g.x : g.x - around) / around;
+    const float c = cos(angle);
+    const float s = sin(angle);
+    const float u = g.x / around;
+    if (surface == SURFACE_SPHERE) {
+        const float v = g.y / float(params.rows * params.segments);
+        const float theta = M_PI_F * v;
+        const float r = sin(theta);
+        p.position = float3(r * c, cos(theta), r * s);
+        p.normal = p.position;
+        p.texCoord = float2(u, v);
+    } else if (surface == SURFACE_CYLINDER_SIDE) {
+        const float v = g.y / float(params.segments);
+        p.position = float3(c, 0.5 - v, s);
+        p.normal = float3(c, 0.0, s);
+        p.texCoord = float2(u, v);
+    } else {
+        // Caps: t runs from the center out to the rim
+        const float r = g.y / float(params.segments);
+        const float y = surface == SURFACE_CYLINDER_TOP ? 0.5 : -0.5;
+        p.position = float3(r * c, y, r * s);
+        p.normal = float3(0.0, 2.0 * y, 0.0);
+        p.texCoord = float2(0.5 + 0.5 * r * c, 0.5 + 0.5 * r * s);
+    }
+    return p;
+}
+
+// MARK: - Meshlets
+
+static MeshletPatch meshletPatch(constant MeshPrimitiveParams& params, uint meshlet) {
+    const int k = int(params.segments);
+    MeshletPatch patch;
+    patch.face = 0;
+    patch.axisS = int2(1, 0);
+    patch.axisT = int2(0, 1);
+    patch.triangle = false;
+
+    if (params.primitive == MESH_PRIMITIVE_SPHERE) {
+        patch.surface = SURFACE_SPHERE;
+        patch.origin = int2(meshlet % params.columns, meshlet / params.columns) * k;
+    } else if (params.primitive == MESH_PRIMITIVE_CYLINDER) {
+        // Side, then top cap, then bottom cap, columns meshlets each
+        patch.surface = SURFACE_CYLINDER_SIDE + meshlet / params.columns;
+        patch.origin = int2(meshlet % params.columns, 0) * k;
+    } else {
+        // m * m sub-triangles per face: m(m+1)/2 upright, then the inverted
+        // ones between them (origin at their right angle, axes reversed)
+        const uint m = params.columns;
+        const uint upright = m * (m + 1) / 2;
+        uint sub = meshlet % (m * m);
+        patch.surface = SURFACE_ICOSPHERE;
+        patch.face = meshlet / (m * m);
+        patch.triangle = true;
+
+        const bool inverted = sub >= upright;
+        if (inverted) {
+            sub -= upright;
+        }
+        uint rowLength = inverted ? m - 1 : m;
+        uint row = 0;
+        while (sub >= rowLength) {
+            sub -= rowLength;
+            rowLength--;
+            row++;
+        }
+        const int2 cell = int2(sub, row);
+        if (inverted) {
+            patch.origin = (cell + 1) * k;
+            patch.axisS = int2(-1, 0);
+            patch.axisT = int2(0, -1);
+        } else {
+            patch.origin = cell * k;
+        }
+    }
+    return patch;
+}
+
+/// Finest lattice coordinates of local (s, t) in units of the meshlet's segments
+static float2 patchPoint(MeshletPatch patch, float s, float t) {
+    return float2(patch.origin) + float2(patch.axisS) * s + float2(patch.axisT) * t;
+}
+
+/// Bounding sphere of a meshlet in unit space, from samples of its corners,
+/// edge midpoints and center (meshlets span at most a quarter turn, so the
+/// margin covers the surface bulging between samples)
+static float4 meshletBounds(constant MeshPrimitiveParams& params, MeshletPatch patch) {
+    const float k = float(params.segments);
+    const float h = 0.5 * k;
+    float2 samples[8];
+    uint count;
+    float2 center;
+    if (patch.triangle) {
+        samples[0] = float2(0, 0); samples[1] = float2(k, 0); samples[2] = float2(0, k);
+        samples[3] = float2(h, 0); samples[4] = float2(0, h); samples[5] = float2(h, h);
+        count = 6;
+        center = float2(k / 3.0);
+    } else {
+        samples[0] = float2(0, 0); samples[1] = float2(k, 0); samples[2] = float2(0, k); samples[3] = float2(k, k);
+        samples[4] = float2(h, 0); samples[5] = float2(0, h); samples[6] = float2(k, h); samples[7] = float2(h, k);
+        count = 8;
+        center = float2(h);
+    }
+
+    const float3 c = surfacePoint(params, patch.surface, patch.face, patchPoint(patch, center.x, center.y)).position;
+    float radius = 0.0;
+    for (uint i = 0; i < count; i++) {
+        const float3 p = surfacePoint(params, patch.surface, patch.face,
+                                      patchPoint(patch, samples[i].x, samples[i].y)).position;
+        radius = max(radius, distance(c, p));
+    }
+    return float4(c, radius * 1.25 + 1e-4);
+}
+
+/// Level of the edge from local a to b: segments needed for its projected
+/// length (through the midpoint) at edgePixels each, rounded up to a power
+/// of two. Edges reaching behind the camera use the finest level.
+static uint edgeLevel(constant MeshPrimitiveParams& params, MeshletPatch patch, float4x4 mvp,
+                      float2 a, float2 b) {
+    const uint k = params.segments;
+    if (k == 1) {
+        return 1;
+    }
+    const float2 points[3] = {patchPoint(patch, a.x, a.y), patchPoint(patch, 0.5 * (a.x + b.x), 0.5 * (a.y + b.y)),
+                              patchPoint(patch, b.x, b.y)};
+    float2 screen[3];
+    for (uint i = 0; i < 3; i++) {
+        const float4 clip = mvp * float4(surfacePoint(params, patch.surface, patch.face, points[i]).position, 1.0);
+        if (clip.w <= 1e-5) {
+            return k;
+        }
+        screen[i] = clip.xy / clip.w * 0.5 * params.viewportSize;
+    }
+    const float pixels = distance(screen[0], screen[1]) + distance(screen[1], screen[2]);
+    const uint wanted = uint(ceil(pixels / params.edgePixels));
+    uint level = 1;
+    while (level < wanted && level < k) {
+        level *= 2;
+    }
+    return level;
+}
+
+/// Edge levels of a meshlet, packed as log2 in 2 bits each. Quads: t = 0,
+/// s = k, t = k, s = 0. Triangles: t = 0, s = 0, s + t = k.
+static uint meshletEdgeLevels(constant MeshPrimitiveParams& params, MeshletPatch patch, float4x4 mvp) {
+    const float k = float(params.segments);
+    uint4 levels;
+    if (patch.triangle) {
+        levels = uint4(edgeLevel(params, patch, mvp, float2(0, 0), float2(k, 0)),
+                       edgeLevel(params, patch, mvp, float2(0, 0), float2(0, k)),
+                       edgeLevel(params, patch, mvp, float2(k, 0), float2(0, k)), 1);
+    } else {
+        levels = uint4(edgeLevel(params, patch, mvp, float2(0, 0), float2(k, 0)),
+                       edgeLevel(params, patch, mvp, float2(k, 0), float2(k, k)),
+                       edgeLevel(params, patch, mvp, float2(0, k), float2(k, k)),
+                       edgeLevel(params, patch, mvp, float2(0, 0), float2(0, k)));
+    }
+    const uint4 shifts = uint4(ctz(levels));
+    return shifts.x | shifts.y << 2 | shifts.z << 4 | shifts.w << 6;
+}
+
+// MARK: - Object Stage
+
+/// One thread per meshlet of one instance (threadgroups: meshlets / 32 x instances)
+[[object]] void objectMeshPrimitive(
+    object_data MeshPrimitivePayload& payload [[payload]],
+    mesh_grid_properties grid,
+    constant Uniforms3D& uniforms [[buffer(1)]],
+    constant InstanceData* instances [[buffer(2)]],
+    constant MeshPrimitiveParams& params [[buffer(3)]],
+    uint2 group [[threadgroup_position_in_grid]],
+    uint lane [[thread_index_in_threadgroup]]
+) {
+    const uint meshlet = group.x * MESHLETS_PER_OBJECT + lane;
+    bool visible = meshlet < params.meshletCount;
+    uint record = 0;
+    if (visible) {
+        const float4x4 mvp = uniforms.projectionMatrix * uniforms.modelViewMatrix * instances[group.y].modelMatrix;
+        const MeshletPatch patch = meshletPatch(params, meshlet);
+        visible = insideFrustum(mvp, meshletBounds(params, patch));
+        if (visible) {
+            record = meshlet << 8 | meshletEdgeLevels(params, patch, mvp);
+        }
+    }
+
+    // Compact the survivors into the payload; one mesh threadgroup each
+    const uint slot = simd_prefix_exclusive_sum(uint(visible));
+    if (visible) {
+        payload.meshlets[slot] = record;
+    }
+    const uint count = simd_sum(uint(visible));
+    if (lane == 0) {
+        payload.instance = group.y;
+        grid.set_threadgroups_per_grid(uint3(count, 1, 1));
+    }
+}
+
+// MARK: - Mesh Stage
+
+/// q rounded down to a multiple of step
+static int snap(int q, int step) {
+    return q - q % step;
+}
+
+/// Local lattice vertex of a meshlet at level, edges snapped to their levels
+static int2 snappedVertex(MeshletPatch patch, int s, int t, int level, uint packedLevels) {
+    const int e0 = level >> (packedLevels & 3);
+    const int e1 = level >> ((packedLevels >> 2) & 3);
+    const int e2 = level >> ((packedLevels >> 4) & 3);
+    const int e3 = level >> ((packedLevels >> 6) & 3);
+    if (patch.triangle) {
+        if (t == 0) {
+            s = snap(s, e0);
+        } else if (s == 0) {
+            t = snap(t, e1);
+        } else if (s + t == level) {
+            t = snap(t, e2);
+            s = level - t;
+        }
+    } else {
+        if (t == 0) {
+            s = snap(s, e0);
+        } else if (s == level) {
+            t = snap(t, e1);
+        } else if (t == level) {
+            s = snap(s, e2);
+        } else if (s == 0) {
+            t = snap(t, e3);
+        }
+    }
+    return int2(s, t);
+}
+
+/// Local (s, t) of vertex index at level (row by row)
+static int2 latticeVertex(bool triangle, uint index, uint level) {
+    if (!triangle) {
+        return int2(index % (level + 1), index / (level + 1));
+    }
+    uint row = 0;
+    uint rowLength = level + 1;
+    while (index >= rowLength) {
+        index -= rowLength;
+        rowLength--;
+        row++;
+    }
+    return int2(index, row);
+}
+
+static uint latticeIndex(bool triangle, int s, int t, uint level) {
+    if (!triangle) {
+        return uint(t) * (level + 1) + uint(s);
+    }
+    return uint(t) * (level + 1) - uint(t) * uint(t - 1) / 2 + uint(s);
+}
+
+/// Emits one meshlet: (L + 1)^2 vertices and 2L^2 triangles for quads,
+/// (L + 1)(L + 2)/2 vertices and L^2 triangles for triangles
+[[mesh]] void meshPrimitive(
+    MeshletMesh output,
+    const object_data MeshPrimitivePayload& payload [[payload]],
+    constant Uniforms3D& uniforms [[buffer(1)]],
+    constant InstanceData* instances [[buffer(2)]],
+    constant MeshPrimitiveParams& params [[buffer(3)]],
+    uint group [[threadgroup_position_in_grid]],
+    uint lane [[thread_index_in_threadgroup]]
+) {
+    const uint record = payload.meshlets[group];
+    const MeshletPatch patch = meshletPatch(params, record >> 8);
+    const InstanceData instance = instances[payload.instance];
+    const bool triangle = patch.triangle;
+    const uint edges = record & 0xff;
+    const uint shifts = max(max(edges & 3, (edges >> 2) & 3), max((edges >> 4) & 3, edges >> 6));
+    const uint level = 1u << shifts;
+    const uint vertexCount = triangle ? (level + 1) * (level + 2) / 2 : (level + 1) * (level + 1);
+    const uint triangleCount = triangle ? level * level : 2 * level * level;
+    const float step = float(params.segments / level);
+
+    if (lane < vertexCount) {
+        const int2 local = latticeVertex(triangle, lane, level);
+        const int2 snapped = snappedVertex(patch, local.x, local.y, int(level), edges);
+        const SurfacePoint p = surfacePoint(params, patch.surface, patch.face,
+                                            patchPoint(patch, float(snapped.x) * step, float(snapped.y) * step));
+
+        // Same transform as vertex3DInstanced / vertexLightingInstanced
+        RasterizerData3D out;
+        const float4 viewPosition = uniforms.modelViewMatrix * (instance.modelMatrix * float4(p.position, 1.0));
+        out.position = uniforms.projectionMatrix * viewPosition;
+        out.normal = (uniforms.normalMatrix * (instance.modelMatrix * float4(p.normal, 0.0))).xyz;
+        out.worldPosition = viewPosition.xyz;
+        out.texCoord = p.texCoord;
+        out.color = instance.color;
+        output.set_vertex(lane, out);
+    }
+
+    if (lane < triangleCount) {
+        // Winding matches the CPU unit meshes; the bottom cap faces down
+        uint3 corners;
+        if (triangle) {
+            const uint uprightCount = level * (level + 1) / 2;
+            const bool inverted = lane >= uprightCount;
+            const int2 cell = inverted ? latticeVertex(true, lane - uprightCount, level - 2)
+                                       : latticeVertex(true, lane, level - 1);
+            const int s = cell.x;
+            const int t = cell.y;
+            corners = inverted
+                ? uint3(latticeIndex(true, s + 1, t, level), latticeIndex(true, s + 1, t + 1, level),
+                        latticeIndex(true, s, t + 1, level))
+                : uint3(latticeIndex(true, s, t, level), latticeIndex(true, s + 1, t, level),
+                        latticeIndex(true, s, t + 1, level));
+        } else {
+            const uint cell = lane / 2;
+            const int s = int(cell % level);
+            const int t = int(cell / level);
+            corners = (lane & 1) == 0
+                ? uint3(latticeIndex(false, s, t, level), latticeIndex(false, s, t + 1, level),
+                        latticeIndex(false, s + 1, t, level))
+                : uint3(latticeIndex(false, s, t + 1, level), latticeIndex(false, s + 1, t + 1, level),
+                        latticeIndex(false, s + 1, t, level));
+            if (patch.surface == SURFACE_CYLINDER_BOTTOM) {
+                corners = corners.xzy;
+            }
+        }
+        output.set_index(lane * 3 + 0, corners.x);
+        output.set_index(lane * 3 + 1, corners.y);
+        output.set_index(lane * 3 + 2, corners.z);
+    }
+
+    if (lane == 0) {
+        output.set_primitive_count(triangleCount);
+    }
+}
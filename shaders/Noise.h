@@ -0,0 +1,234 @@
+#ifndef Noise_h
+#define Noise_h
+
+#include <metal_stdlib>
+
+using namespace metal;
+
+// ============================================================================
+// Gradient Noise
+// ============================================================================
+//
+// GPU port of src/oflike/math/ofNoise.h: the same tables, lattice hashing
+// and operation order, so noise computed here matches ofNoise() on the CPU
+// to float rounding. Shared by the noise field and particle kernels.
+
+// MARK: - Tables (match ofNoise.h)
+
+constant uchar NOISE_PERM[256] = {
+    151, 160, 137, 91, 90, 15, 131, 13, 201, 95, 96, 53, 194, 233, 7, 225,
+    140, 36, 103, 30, 69, 142, 8, 99, 37, 240, 21, 10, 23, 190, 6, 148,
+    247, 120, 234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32,
+    57, 177, 33, 88, 237, 149, 56, 87, 174, 20, 125, 136, 171, 168, 68, 175,
+    74, 165, 71, 134, 139, 48, 27, 166, 77, 146, 158, 231, 83, 111, 229, 122,
+    60, 211, 133, 230, 220, 105, 92, 41, 55, 46, 245, 40, 244, 102, 143, 54,
+    65, 25, 63, 161, 1, 216, 80, 73, 209, 76, 132, 187, 208, 89, 18, 169,
+    200, 196, 135, 130, 116, 188, 159, 86, 164, 100, 109, 198, 173, 186, 3, 64,
+    52, 217, 226, 250, 124, 123, 5, 202, 38, 147, 118, 126, 255, 82, 85, 212,
+    207, 206, 59, 227, 47, 16, 58, 17, 182, 189, 28, 42, 223, 183, 170, 213,
+    119, 248, 152, 2, 44, 154, 163, 70, 221, 153, 101, 155, 167, 43, 172, 9,
+    129, 22, 39, 253, 19, 98, 108, 110, 79, 113, 224, 232, 178, 185, 112, 104,
+    218, 246, 97, 228, 251, 34, 242, 193, 238, 210, 144, 12, 191, 179, 162, 241,
+    81, 51, 145, 235, 249, 14, 239, 107, 49, 192, 214, 31, 181, 199, 106, 157,
+    184, 84, 204, 176, 115, 121, 50, 45, 127, 4, 150, 254, 138, 236, 205, 93,
+    222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66, 215, 61, 156, 180,
+};
+
+constant float2 NOISE_GRAD2[8] = {
+    float2(1, 2), float2(-1, 2), float2(1, -2), float2(-1, -2), float2(2, 1), float2(2, -1), float2(-2, 1), float2(-2, -1),
+};
+
+constant float3 NOISE_GRAD3[16] = {
+    float3(1, 1, 0), float3(-1, 1, 0), float3(1, -1, 0), float3(-1, -1, 0),
+    float3(1, 0, 1), float3(-1, 0, 1), float3(1, 0, -1), float3(-1, 0, -1),
+    float3(0, 1, 1), float3(0, -1, 1), float3(0, 1, -1), float3(0, -1, -1),
+    float3(1, 1, 0), float3(0, -1, 1), float3(-1, 1, 0), float3(0, -1, -1),
+};
+
+constant float4 NOISE_GRAD4[32] = {
+    float4(1, 1, 1, 0), float4(-1, 1, 1, 0), float4(1, -1, 1, 0), float4(-1, -1, 1, 0),
+    float4(1, 1, -1, 0), float4(-1, 1, -1, 0), float4(1, -1, -1, 0), float4(-1, -1, -1, 0),
+    float4(1, 1, 0, 1), float4(-1, 1, 0, 1), float4(1, -1, 0, 1), float4(-1, -1, 0, 1),
+    float4(1, 1, 0, -1), float4(-1, 1, 0, -1), float4(1, -1, 0, -1), float4(-1, -1, 0, -1),
+    float4(1, 0, 1, 1), float4(-1, 0, 1, 1), float4(1, 0, -1, 1), float4(-1, 0, -1, 1),
+    float4(1, 0, 1, -1), float4(-1, 0, 1, -1), float4(1, 0, -1, -1), float4(-1, 0, -1, -1),
+    float4(0, 1, 1, 1), float4(0, -1, 1, 1), float4(0, 1, -1, 1), float4(0, -1, -1, 1),
+    float4(0, 1, 1, -1), float4(0, -1, 1, -1), float4(0, 1, -1, -1), float4(0, -1, -1, -1),
+};
+
+constant float PERLIN_SCALE2 = 0.66;
+constant float PERLIN_SCALE3 = 0.936;
+constant float PERLIN_SCALE4 = 0.87;
+constant float SIMPLEX_SCALE2 = 45.23;
+constant float SIMPLEX_SCALE3 = 32.0;
+constant float SIMPLEX_SCALE4 = 27.0;
+
+// MARK: - Lattice
+
+inline int noiseHash(int i) { return NOISE_PERM[i & 255]; }
+inline int noiseHash(int i, int j) { return NOISE_PERM[(i + noiseHash(j)) & 255]; }
+inline int noiseHash(int i, int j, int k) { return NOISE_PERM[(i + noiseHash(j, k)) & 255]; }
+inline int noiseHash(int i, int j, int k, int l) { return NOISE_PERM[(i + noiseHash(j, k, l)) & 255]; }
+
+inline float noiseGrad(int2 c, float2 p) {
+    return dot(NOISE_GRAD2[noiseHash(c.x, c.y) & 7], p);
+}
+
+inline float noiseGrad(int3 c, float3 p) {
+    return dot(NOISE_GRAD3[noiseHash(c.x, c.y, c.z) & 15], p);
+}
+
+inline float noiseGrad(int4 c, float4 p) {
+    return dot(NOISE_GRAD4[noiseHash(c.x, c.y, c.z, c.w) & 31], p);
+}
+
+inline float noiseFade(float t) {
+    return t * t * t * (t * (t * 6.0 - 15.0) + 10.0);
+}
+
+/// (r2 - d2)^4, 0 outside the radius
+inline float simplexFalloff(float r2, float d2) {
+    float t = max(r2 - d2, 0.0);
+    t = t * t;
+    return t * t;
+}
+
+// MARK: - Perlin
+
+inline float perlin(float2 p) {
+    const float2 f = floor(p);
+    const int2 c = int2(f) & 255;
+    const float2 p0 = p - f;
+    const float2 p1 = p0 - 1.0;
+    const float u = noiseFade(p0.x), v = noiseFade(p0.y);
+
+    const float n00 = noiseGrad(c, p0);
+    const float n10 = noiseGrad(c + int2(1, 0), float2(p1.x, p0.y));
+    const float n01 = noiseGrad(c + int2(0, 1), float2(p0.x, p1.y));
+    const float n11 = noiseGrad(c + int2(1, 1), p1);
+    return PERLIN_SCALE2 * mix(mix(n00, n10, u), mix(n01, n11, u), v);
+}
+
+inline float perlin(float3 p) {
+    const float3 f = floor(p);
+    const int3 c = int3(f) & 255;
+    const float3 p0 = p - f;
+    const float3 p1 = p0 - 1.0;
+    const float u = noiseFade(p0.x), v = noiseFade(p0.y), w = noiseFade(p0.z);
+
+    float layer[2];
+    for (int dz = 0; dz < 2; ++dz) {
+        const float pz = dz ? p1.z : p0.z;
+        const float n00 = noiseGrad(c + int3(0, 0, dz), float3(p0.x, p0.y, pz));
+        const float n10 = noiseGrad(c + int3(1, 0, dz), float3(p1.x, p0.y, pz));
+        const float n01 = noiseGrad(c + int3(0, 1, dz), float3(p0.x, p1.y, pz));
+        const float n11 = noiseGrad(c + int3(1, 1, dz), float3(p1.x, p1.y, pz));
+        layer[dz] = mix(mix(n00, n10, u), mix(n01, n11, u), v);
+    }
+    return PERLIN_SCALE3 * mix(layer[0], layer[1], w);
+}
+
+inline float perlin(float4 p) {
+    const float4 f = floor(p);
+    const int4 c = int4(f) & 255;
+    const float4 p0 = p - f;
+    const float4 p1 = p0 - 1.0;
+    const float4 fade = float4(noiseFade(p0.x), noiseFade(p0.y), noiseFade(p0.z), noiseFade(p0.w));
+
+    float slice[2];
+    for (int dw = 0; dw < 2; ++dw) {
+        const float pw = dw ? p1.w : p0.w;
+        float layer[2];
+        for (int dz = 0; dz < 2; ++dz) {
+            const float pz = dz ? p1.z : p0.z;
+            const float n00 = noiseGrad(c + int4(0, 0, dz, dw), float4(p0.x, p0.y, pz, pw));
+            const float n10 = noiseGrad(c + int4(1, 0, dz, dw), float4(p1.x, p0.y, pz, pw));
+            const float n01 = noiseGrad(c + int4(0, 1, dz, dw), float4(p0.x, p1.y, pz, pw));
+            const float n11 = noiseGrad(c + int4(1, 1, dz, dw), float4(p1.x, p1.y, pz, pw));
+            layer[dz] = mix(mix(n00, n10, fade.x), mix(n01, n11, fade.x), fade.y);
+        }
+        slice[dw] = mix(layer[0], layer[1], fade.z);
+    }
+    return PERLIN_SCALE4 * mix(slice[0], slice[1], fade.w);
+}
+
+// MARK: - Simplex
+
+inline float simplex(float2 p) {
+    const float F2 = 0.366025403;
+    const float G2 = 0.211324865;
+
+    const float2 f = floor(p + (p.x + p.y) * F2);
+    const float2 p0 = p - (f - (f.x + f.y) * G2);
+    const int2 c = int2(f) & 255;
+
+    const float step = p0.x > p0.y ? 1.0 : 0.0;
+    const float2 o1 = float2(step, 1.0 - step);
+    const float2 p1 = p0 - o1 + G2;
+    const float2 p2 = p0 - 1.0 + 2.0 * G2;
+
+    const float n0 = simplexFalloff(0.5, dot(p0, p0)) * noiseGrad(c, p0);
+    const float n1 = simplexFalloff(0.5, dot(p1, p1)) * noiseGrad(c + int2(o1), p1);
+    const float n2 = simplexFalloff(0.5, dot(p2, p2)) * noiseGrad(c + 1, p2);
+    return SIMPLEX_SCALE2 * (n0 + n1 + n2);
+}
+
+inline float simplex(float3 p) {
+    const float F3 = 1.0 / 3.0;
+    const float G3 = 1.0 / 6.0;
+
+    const float3 f = floor(p + (p.x + p.y + p.z) * F3);
+    const float3 p0 = p - (f - (f.x + f.y + f.z) * G3);
+    const int3 c = int3(f) & 255;
+
+    // Rank the offsets; the largest steps first along the simplex edges
+    const float xy = p0.x > p0.y ? 1.0 : 0.0;
+    const float xz = p0.x > p0.z ? 1.0 : 0.0;
+    const float yz = p0.y > p0.z ? 1.0 : 0.0;
+    const float3 rank = float3(xy + xz, (1.0 - xy) + yz, (1.0 - xz) + (1.0 - yz));
+    const float3 o1 = select(float3(0.0), float3(1.0), rank > 1.5);
+    const float3 o2 = select(float3(0.0), float3(1.0), rank > 0.5);
+
+    const float3 p1 = p0 - o1 + G3;
+    const float3 p2 = p0 - o2 + 2.0 * G3;
+    const float3 p3 = p0 - 1.0 + 3.0 * G3;
+
+    const float n0 = simplexFalloff(0.6, dot(p0, p0)) * noiseGrad(c, p0);
+    const float n1 = simplexFalloff(0.6, dot(p1, p1)) * noiseGrad(c + int3(o1), p1);
+    const float n2 = simplexFalloff(0.6, dot(p2, p2)) * noiseGrad(c + int3(o2), p2);
+    const float n3 = simplexFalloff(0.6, dot(p3, p3)) * noiseGrad(c + 1, p3);
+    return SIMPLEX_SCALE3 * (n0 + n1 + n2 + n3);
+}
+
+inline float simplex(float4 p) {
+    const float F4 = 0.309016994;
+    const float G4 = 0.138196601;
+
+    const float4 f = floor(p + (p.x + p.y + p.z + p.w) * F4);
+    const float4 p0 = p - (f - (f.x + f.y + f.z + f.w) * G4);
+    const int4 c = int4(f) & 255;
+
+    const float xy = p0.x > p0.y ? 1.0 : 0.0;
+    const float xz = p0.x > p0.z ? 1.0 : 0.0;
+    const float xw = p0.x > p0.w ? 1.0 : 0.0;
+    const float yz = p0.y > p0.z ? 1.0 : 0.0;
+    const float yw = p0.y > p0.w ? 1.0 : 0.0;
+    const float zw = p0.z > p0.w ? 1.0 : 0.0;
+    const float4 rank = float4(xy + xz + xw,
+                               (1.0 - xy) + yz + yw,
+                               (1.0 - xz) + (1.0 - yz) + zw,
+                               (1.0 - xw) + (1.0 - yw) + (1.0 - zw));
+
+    // Corners 1-3 step along the axes ranked 3, then >= 2, then >= 1
+    float sum = simplexFalloff(0.6, dot(p0, p0)) * noiseGrad(c, p0);
+    for (int corner = 0; corner < 3; ++corner) {
+        const float4 o = select(float4(0.0), float4(1.0), rank > (2.5 - float(corner)));
+        const float4 pc = p0 - o + float(corner + 1) * G4;
+        sum += simplexFalloff(0.6, dot(pc, pc)) * noiseGrad(c + int4(o), pc);
+    }
+    const float4 p4 = p0 - 1.0 + 4.0 * G4;
+    sum += simplexFalloff(0.6, dot(p4, p4)) * noiseGrad(c + 1, p4);
+    return SIMPLEX_SCALE4 * sum;
+}
+
+#endif /* Noise_h */
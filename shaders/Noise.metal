@@ -0,0 +1,76 @@
+#include <metal_stdlib>
+#include "Noise.h"
+
+using namespace metal;
+
+// ============================================================================
+// Gradient Noise Compute Shaders
+// ============================================================================
+//
+// GPU port of src/oflike/math/ofNoise.h: the same tables, lattice hashing
+// and operation order, so a field computed here matches ofNoiseField() on
+// the CPU to float rounding.
+
+// MARK: - Fields
+
+/// Field parameters (matches NoiseFieldUniforms in ofNoiseField.mm)
+struct NoiseFieldUniforms {
+    uint width;
+    uint height;
+    uint type;              // ofNoiseType: 0 simplex, 1 Perlin
+    uint dimensions;        // 2, 3 or 4
+    float originX;
+    float originY;
+    float frequency;
+    float z;
+    float w;
+    uint octaves;
+    float lacunarity;
+    float gain;
+    float normalize;        // 1 / sum of the octave amplitudes
+};
+
+inline float signedNoise(uint type, uint dimensions, float4 p) {
+    float n;
+    if (dimensions == 2) {
+        n = type == 1 ? perlin(p.xy) : simplex(p.xy);
+    } else if (dimensions == 3) {
+        n = type == 1 ? perlin(p.xyz) : simplex(p.xyz);
+    } else {
+        n = type == 1 ? perlin(p) : simplex(p);
+    }
+    return clamp(n, -1.0, 1.0);
+}
+
+/**
+ * Fill a texture with fractal noise in [0, 1], as ofNoiseField() on the CPU.
+ * Writes the value to RGB with alpha 1.
+ *
+ * Dispatch with one thread per texel, row by row.
+ */
+kernel void fillNoiseField(
+    texture2d<float, access::write> destination [[texture(0)]],
+    constant NoiseFieldUniforms& uniforms [[buffer(0)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    if (tid >= uniforms.width * uniforms.height) {
+        return;
+    }
+    const uint x = tid % uniforms.width;
+    const uint y = tid / uniforms.width;
+
+    const float4 base = float4(uniforms.originX + float(x) * uniforms.frequency,
+                               uniforms.originY + float(y) * uniforms.frequency,
+                               uniforms.z, uniforms.w);
+    float sum = 0.0;
+    float scale = 1.0;
+    float amplitude = 1.0;
+    for (uint octave = 0; octave < uniforms.octaves; ++octave) {
+        sum += signedNoise(uniforms.type, uniforms.dimensions, base * scale) * amplitude;
+        scale *= uniforms.lacunarity;
+        amplitude *= uniforms.gain;
+    }
+
+    const float value = sum * (0.5 * uniforms.normalize) + 0.5;
+    destination.write(float4(value, value, value, 1.0), uint2(x, y));
+}
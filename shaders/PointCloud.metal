@@ -0,0 +1,100 @@
+#include <metal_stdlib>
+#include "BlendModes.h"
+
+using namespace metal;
+
+// ============================================================================
+// Point Cloud Shaders
+// ============================================================================
+
+/// Points sharing one chunk's bounds (kPointCloudChunkSize in RenderTypes.h)
+constant uint POINT_CLOUD_CHUNK_SIZE = 256;
+
+/// One point, 10 bytes (matches render::PointCloudPoint)
+struct PointCloudPoint {
+    ushort position[3];     // Unorm16 within the chunk's bounds
+    uchar color[4];         // Unorm8 RGBA
+};
+
+/// Bounds of POINT_CLOUD_CHUNK_SIZE consecutive points (matches render::PointCloudChunk)
+struct PointCloudChunk {
+    packed_float3 positionMin;
+    packed_float3 positionExtent;
+};
+
+/// Point uniforms (matches the uniforms in MetalRenderer::executeDrawPointCloud)
+struct PointCloudUniforms {
+    float4x4 projectionMatrix;
+    float4x4 modelViewMatrix;
+    float pointSize;        // Pixels, or view-space units when pixelScale > 0
+    float pixelScale;       // Pixels per unit at clip w = 1 (0 = fixed size)
+    float maxPointSize;     // Hardware limit
+    float padding;
+};
+
+struct RasterizerDataPoint {
+    float4 position [[position]];
+    float pointSize [[point_size]];
+    float4 color;
+};
+
+/// Fragment inputs of RasterizerDataPoint (point_size is vertex output only)
+struct PointFragmentIn {
+    float4 color;
+};
+
+/**
+ * Point cloud vertex shader: decodes one record per vertex. Draws start at
+ * the command's first point, so vertex_id is the record index and selects
+ * its chunk.
+ */
+vertex RasterizerDataPoint vertexPointCloud(
+    uint vertexID [[vertex_id]],
+    device const PointCloudPoint* points [[buffer(0)]],
+    constant PointCloudUniforms& uniforms [[buffer(1)]],
+    device const PointCloudChunk* chunks [[buffer(2)]]
+) {
+    const PointCloudPoint point = points[vertexID];
+    const PointCloudChunk chunk = chunks[vertexID / POINT_CLOUD_CHUNK_SIZE];
+
+    const float3 t = float3(point.position[0], point.position[1], point.position[2]) / 65535.0;
+    const float3 position = float3(chunk.positionMin) + t * float3(chunk.positionExtent);
+
+    RasterizerDataPoint out;
+    out.position = uniforms.projectionMatrix * (uniforms.modelViewMatrix * float4(position, 1.0));
+
+    // Clip w is the view depth for perspective projections and 1 for
+    // orthographic ones
+    float size = uniforms.pointSize;
+    if (uniforms.pixelScale > 0.0) {
+        size *= uniforms.pixelScale / max(out.position.w, 1e-5);
+    }
+    out.pointSize = clamp(size, 1.0, uniforms.maxPointSize);
+    out.color = float4(point.color[0], point.color[1], point.color[2], point.color[3]) / 255.0;
+    return out;
+}
+
+/// Round point sprite; one-pixel points keep their square
+fragment float4 fragmentPointCloud(
+    PointFragmentIn in [[stage_in]],
+    float2 pointCoord [[point_coord]]
+) {
+    const float2 offset = pointCoord * 2.0 - 1.0;
+    if (dot(offset, offset) > 1.0) {
+        discard_fragment();
+    }
+    return in.color;
+}
+
+/// fragmentPointCloud blended over [[color(0)]] with kProgrammableBlendMode (see BlendModes.h)
+fragment float4 fragmentPointCloudBlend(
+    PointFragmentIn in [[stage_in]],
+    float2 pointCoord [[point_coord]],
+    float4 dst [[color(0)]]
+) {
+    const float2 offset = pointCoord * 2.0 - 1.0;
+    if (dot(offset, offset) > 1.0) {
+        discard_fragment();
+    }
+    return programmableBlend(in.color, dst);
+}
@@ -0,0 +1,169 @@
+#include <metal_stdlib>
+
+using namespace metal;
+
+// ============================================================================
+// Post-Processing Compute Shaders
+// ============================================================================
+
+/// Per-pixel stage (matches PostProcessStage in DrawCommand.h)
+struct PostStage {
+    uint op;    // 0 exposure, 1 contrast, 2 saturation, 3 color filter, 4 vignette, 5 tonemap, 6 gamma
+    float a;
+    float b;
+    float c;
+};
+
+/// Fused pass (matches the uniforms in MetalRenderer::encodePostFused)
+struct PostFusedUniforms {
+    uint stageCount;
+    float bloomIntensity;   // 0 = no bloom composite
+    PostStage stages[16];
+};
+
+/// ACES filmic approximation (Narkowicz 2015)
+static float3 tonemapACES(float3 x) {
+    return saturate((x * (2.51 * x + 0.03)) / (x * (2.43 * x + 0.59) + 0.14));
+}
+
+/**
+ * Fused post-processing pass: the bloom composite and every grading stage
+ * (exposure, contrast, saturation, color filter, vignette, tonemap, gamma)
+ * run in order while the pixel is in registers, so a whole color grade
+ * costs one read and one write of the image. Colors stay unclamped between
+ * stages; unorm destinations clamp on write. Runs over the overlap of
+ * source and destination; bloom is the half-size result of the bloom
+ * chain, sampled over that region.
+ *
+ * Dispatch with one thread per destination pixel.
+ */
+kernel void postFused(
+    texture2d<float, access::read> source [[texture(0)]],
+    texture2d<float, access::sample> bloom [[texture(1)]],
+    texture2d<float, access::write> destination [[texture(2)]],
+    constant PostFusedUniforms& uniforms [[buffer(0)]],
+    uint2 gid [[thread_position_in_grid]]
+) {
+    const uint2 size = uint2(min(source.get_width(), destination.get_width()),
+                             min(source.get_height(), destination.get_height()));
+    if (gid.x >= size.x || gid.y >= size.y) {
+        return;
+    }
+
+    constexpr sampler bloomSampler(filter::linear, address::clamp_to_edge);
+    const float2 uv = (float2(gid) + 0.5) / float2(size);
+    float4 color = source.read(gid);
+    if (uniforms.bloomIntensity > 0.0) {
+        color.rgb += uniforms.bloomIntensity * bloom.sample(bloomSampler, uv).rgb;
+    }
+
+    for (uint i = 0; i < uniforms.stageCount; i++) {
+        const PostStage stage = uniforms.stages[i];
+        float3 rgb = color.rgb;
+        switch (stage.op) {
+            case 0:
+                rgb *= stage.a;
+                break;
+            case 1:
+                rgb = (rgb - stage.b) * stage.a + stage.b;
+                break;
+            case 2: {
+                const float luma = dot(rgb, float3(0.2126, 0.7152, 0.0722));
+                rgb = luma + stage.a * (rgb - luma);
+                break;
+            }
+            case 3:
+                rgb *= float3(stage.a, stage.b, stage.c);
+                break;
+            case 4: {
+                // 0 at the centre, 1 in the corners
+                const float distance = length(uv - 0.5) * M_SQRT2_F;
+                rgb *= 1.0 - stage.a * smoothstep(stage.b, stage.b + stage.c, distance);
+                break;
+            }
+            case 5:
+                rgb = tonemapACES(max(rgb * stage.a, 0.0));
+                break;
+            default:
+                rgb = pow(max(rgb, 0.0), float3(stage.a));
+                break;
+        }
+        color.rgb = rgb;
+    }
+    destination.write(color, gid);
+}
+
+// ============================================================================
+// Bloom
+// ============================================================================
+
+/// Bloom downsample (matches the uniforms in MetalRenderer::encodeBloom)
+struct BloomDownsampleUniforms {
+    float2 sourceScale;     // Region / source size
+    float threshold;        // Brightness that starts to bloom; 0 keeps everything
+    float padding;
+};
+
+/**
+ * Bloom downsample: a 4x4 box of the source (four bilinear taps) into a
+ * half-size level. The first level also applies a soft threshold on the
+ * brightest channel, so only highlights enter the chain.
+ *
+ * Dispatch with one thread per destination pixel.
+ */
+kernel void bloomDownsample(
+    texture2d<float, access::sample> source [[texture(0)]],
+    texture2d<float, access::write> destination [[texture(1)]],
+    constant BloomDownsampleUniforms& uniforms [[buffer(0)]],
+    uint2 gid [[thread_position_in_grid]]
+) {
+    if (gid.x >= destination.get_width() || gid.y >= destination.get_height()) {
+        return;
+    }
+
+    constexpr sampler sourceSampler(filter::linear, address::clamp_to_edge);
+    const float2 texel = 1.0 / float2(destination.get_width(), destination.get_height());
+    const float2 uv = (float2(gid) + 0.5) * texel;
+    const float2 offset = 0.5 * texel;     // One source texel: each tap averages a 2x2 block
+    float3 rgb = 0.25 * (source.sample(sourceSampler, (uv + float2(-offset.x, -offset.y)) * uniforms.sourceScale).rgb +
+                         source.sample(sourceSampler, (uv + float2(offset.x, -offset.y)) * uniforms.sourceScale).rgb +
+                         source.sample(sourceSampler, (uv + float2(-offset.x, offset.y)) * uniforms.sourceScale).rgb +
+                         source.sample(sourceSampler, (uv + float2(offset.x, offset.y)) * uniforms.sourceScale).rgb);
+
+    if (uniforms.threshold > 0.0) {
+        const float brightness = max(rgb.r, max(rgb.g, rgb.b));
+        rgb *= max(brightness - uniforms.threshold, 0.0) / max(brightness, 1e-4);
+    }
+    destination.write(float4(rgb, 1.0), gid);
+}
+
+/**
+ * Bloom upsample: a 3x3 tent of the smaller level, sampled bilinearly,
+ * added to the downsampled level of this size.
+ *
+ * Dispatch with one thread per destination pixel.
+ */
+kernel void bloomUpsample(
+    texture2d<float, access::sample> smaller [[texture(0)]],
+    texture2d<float, access::read> level [[texture(1)]],
+    texture2d<float, access::write> destination [[texture(2)]],
+    uint2 gid [[thread_position_in_grid]]
+) {
+    if (gid.x >= destination.get_width() || gid.y >= destination.get_height()) {
+        return;
+    }
+
+    constexpr sampler smallerSampler(filter::linear, address::clamp_to_edge);
+    const float2 texel = 1.0 / float2(destination.get_width(), destination.get_height());
+    const float2 uv = (float2(gid) + 0.5) * texel;
+    float3 tent = 4.0 * smaller.sample(smallerSampler, uv).rgb;
+    tent += 2.0 * (smaller.sample(smallerSampler, uv + float2(-texel.x, 0.0)).rgb +
+                   smaller.sample(smallerSampler, uv + float2(texel.x, 0.0)).rgb +
+                   smaller.sample(smallerSampler, uv + float2(0.0, -texel.y)).rgb +
+                   smaller.sample(smallerSampler, uv + float2(0.0, texel.y)).rgb);
+    tent += smaller.sample(smallerSampler, uv + float2(-texel.x, -texel.y)).rgb +
+            smaller.sample(smallerSampler, uv + float2(texel.x, -texel.y)).rgb +
+            smaller.sample(smallerSampler, uv + float2(-texel.x, texel.y)).rgb +
+            smaller.sample(smallerSampler, uv + float2(texel.x, texel.y)).rgb;
+    destination.write(float4(level.read(gid).rgb + tent / 16.0, 1.0), gid);
+}
@@ -0,0 +1,38 @@
+#include <metal_stdlib>
+
+using namespace metal;
+
+// ============================================================================
+// Variable Rasterization Rate Resolve
+// ============================================================================
+
+// Passes drawn through an MTLRasterizationRateMap land in a texture of the
+// map's physical size, with reduced zones squeezed together. The resolve
+// draws a full-screen triangle over the full-size target and reads each
+// pixel back from where the map put it; zones below full rate stretch
+// bilinearly.
+
+struct RateMapResolveVertex {
+    float4 position [[position]];
+};
+
+/// Full-screen triangle over the destination
+vertex RateMapResolveVertex vertexRateMapResolve(uint vertexID [[vertex_id]]) {
+    const float2 corner = float2((vertexID << 1) & 2, vertexID & 2);
+    RateMapResolveVertex out;
+    out.position = float4(corner * 2.0 - 1.0, 0.0, 1.0);
+    return out;
+}
+
+/// Destination pixel from the physical texture (MetalRenderer replaces the
+/// target; SharpRenderer blends it over as premultiplied color)
+fragment float4 fragmentRateMapResolve(
+    RateMapResolveVertex in [[stage_in]],
+    constant rasterization_rate_map_data& rateMap [[buffer(0)]],
+    texture2d<float> physical [[texture(0)]]
+) {
+    constexpr sampler physicalSampler(coord::pixel, filter::linear, address::clamp_to_edge);
+    rasterization_rate_map_decoder decoder(rateMap);
+    const float2 position = decoder.map_screen_to_physical_coordinates(in.position.xy);
+    return physical.sample(physicalSampler, position);
+}
@@ -0,0 +1,82 @@
+#include <metal_stdlib>
+
+using namespace metal;
+
+// ============================================================================
+// GPU Mesh Deformation (Skinning and Morph Targets)
+// ============================================================================
+
+/// Mesh vertex as stored in buffers (matches render::Vertex3D, 64 bytes)
+struct MeshVertex {
+    float3 position;
+    float3 normal;
+    float2 texCoord;
+    float4 color;
+};
+
+/// Four bone indices and weights per vertex (matches GpuBoneInfluence in VboMesh.mm)
+struct BoneInfluence {
+    ushort4 bones;
+    ushort4 weights;        // unorm16, summing to 1
+};
+
+/// Offsets of one vertex in one morph target (matches GpuMorphDelta in VboMesh.mm)
+struct MorphDelta {
+    packed_float3 position;
+    packed_float3 normal;
+};
+
+/// A morph target with a non-zero weight (matches GpuMorphWeight in VboMesh.mm)
+struct MorphWeight {
+    uint target;
+    float weight;
+};
+
+/// Deformation parameters (matches DeformUniforms in VboMesh.mm)
+struct DeformUniforms {
+    uint vertexCount;
+    uint boneCount;         // 0 = not skinned
+    uint morphCount;        // Entries in the morph weight list
+};
+
+/// Morph, then skin, the rest-pose vertices into this frame's copy
+/// Morph deltas are laid out target by target, vertexCount per target.
+kernel void deformVertices(device const MeshVertex* rest [[buffer(0)]],
+                           device MeshVertex* deformed [[buffer(1)]],
+                           device const BoneInfluence* influences [[buffer(2)]],
+                           device const float4x4* bones [[buffer(3)]],
+                           device const MorphDelta* deltas [[buffer(4)]],
+                           device const MorphWeight* morphWeights [[buffer(5)]],
+                           constant DeformUniforms& uniforms [[buffer(6)]],
+                           uint id [[thread_position_in_grid]]) {
+    if (id >= uniforms.vertexCount) return;
+
+    MeshVertex v = rest[id];
+    float3 position = v.position;
+    float3 normal = v.normal;
+
+    for (uint i = 0; i < uniforms.morphCount; i++) {
+        MorphWeight morph = morphWeights[i];
+        MorphDelta delta = deltas[morph.target * uniforms.vertexCount + id];
+        position += morph.weight * float3(delta.position);
+        normal += morph.weight * float3(delta.normal);
+    }
+
+    if (uniforms.boneCount > 0) {
+        // Linear blend skinning; out-of-range bones fall back to the last one
+        BoneInfluence influence = influences[id];
+        float4 weights = float4(influence.weights) / 65535.0f;
+        uint4 indices = min(uint4(influence.bones), uint4(uniforms.boneCount - 1));
+        float4x4 skin = bones[indices.x] * weights.x +
+                        bones[indices.y] * weights.y +
+                        bones[indices.z] * weights.z +
+                        bones[indices.w] * weights.w;
+        position = (skin * float4(position, 1.0f)).xyz;
+        // Normals by the upper 3x3: exact for rigid and uniformly scaled bones
+        normal = float3x3(skin[0].xyz, skin[1].xyz, skin[2].xyz) * normal;
+    }
+
+    v.position = position;
+    v.normal = length_squared(normal) > 0.0f ? normalize(normal) : normal;
+    deformed[id] = v;
+}
@@ -0,0 +1,37 @@
+#ifndef Transparency_h
+#define Transparency_h
+
+#include <metal_stdlib>
+
+using namespace metal;
+
+// ============================================================================
+// Weighted Blended Order-Independent Transparency
+// The *Transparent fragment variants write two attachments that the renderer
+// composites over the pass when it ends (McGuire and Bavoil 2013). color(0)
+// sums weighted premultiplied color and alpha (blended One, One); color(1)
+// multiplies the revealed background by (1 - alpha) (blended Zero,
+// OneMinusSourceColor). Neither depends on the order fragments arrive in.
+// ============================================================================
+
+/// Attachments of the accumulation pass (RGBA16Float, R16Float)
+struct TransparentFragment {
+    float4 accumulation [[color(0)]];
+    float revealage [[color(1)]];
+};
+
+/// Weighted contribution of a shaded fragment
+/// @param depth Window-space depth (0 near, 1 far); nearer, more opaque
+/// fragments weigh more, so they dominate the average where layers overlap
+inline TransparentFragment weightedTransparency(float4 color, float depth) {
+    const float coverage = min(1.0, color.a * 10.0) + 0.01;
+    const float distance = 1.0 - depth * 0.9;
+    const float weight = clamp(coverage * coverage * coverage * 1e8 * distance * distance * distance, 1e-2, 3e3);
+
+    TransparentFragment out;
+    out.accumulation = float4(color.rgb * color.a, color.a) * weight;
+    out.revealage = color.a;
+    return out;
+}
+
+#endif /* Transparency_h */
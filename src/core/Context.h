@@ -2,12 +2,15 @@
 
 #include <memory>
 #include <vector>
+#include <string>
+#include <cstdint>
 #include <simd/simd.h>
 
 // Forward declarations
 namespace render {
 class IRenderer;
 class DrawList;
+struct ShadowLight;
 namespace metal {
 class MetalRenderer;
 }
@@ -46,10 +49,153 @@ public:
     /// @return Renderer instance (nullptr if not initialized)
     render::IRenderer* renderer() const;
 
+    // MARK: - Headless Rendering
+
+    /// Initialize the context and a renderer without a window
+    /// Frames render into an offscreen BGRA8 texture with a depth buffer as
+    /// fast as the GPU allows: there is no drawable, no presentation and no
+    /// vsync. Pair with setManualClock() for deterministic time.
+    /// @param metalDevice Native MTLDevice handle (__bridge void*)
+    /// @param width Target width in pixels (also the window size)
+    /// @param height Target height in pixels
+    /// @return false if the renderer or the targets couldn't be created
+    bool initializeHeadless(void* metalDevice, int width, int height);
+
+    /// Check whether the context renders offscreen (initializeHeadless())
+    bool isHeadless() const;
+
+    /// Recreate the offscreen targets at a new size
+    /// Call between frames; the window size and viewport follow.
+    /// @return false if not headless or the targets couldn't be created
+    bool setHeadlessSize(int width, int height);
+
+    /// Begin a frame on the offscreen target
+    /// Headless counterpart of a view frame: calls renderer()->beginFrame()
+    /// and binds the offscreen pass. Finish with renderer()->endFrame().
+    /// @return false if not headless or the frame couldn't begin
+    bool beginHeadlessFrame();
+
+    /// Wait until the GPU has finished every committed frame
+    void waitForHeadlessFrames();
+
+    /// Get the offscreen color texture (id<MTLTexture>, private storage)
+    /// @return Texture handle, or nullptr if not headless
+    void* getHeadlessTexture() const;
+
     /// Get the current frame's draw list
+    /// Returns the list bound to the calling thread (see bindThreadDrawList),
+    /// otherwise the main draw list.
     /// @return Reference to the draw list
     render::DrawList& getDrawList();
 
+    // MARK: - Multi-threaded Recording
+
+    /// Bind a draw list to the calling thread
+    /// oF drawing calls made on this thread record into it instead of the main
+    /// list. Each worker thread needs its own list; graphics state (color,
+    /// matrices, fill) is per thread and starts from defaults.
+    /// Lights, materials and the camera stack are shared: configure them before
+    /// workers start recording.
+    /// @param drawList List to record into, or nullptr to restore the main list
+    void bindThreadDrawList(render::DrawList* drawList);
+
+    /// Get the draw list bound to the calling thread
+    /// @return Bound list, or nullptr if the thread records into the main list
+    render::DrawList* getThreadDrawList() const;
+
+    /// Queue a worker-recorded draw list for this frame (thread-safe)
+    /// Lists are encoded after the main list in ascending layer order, so the
+    /// result does not depend on which thread finished first. The main list is
+    /// layer 0; use distinct layers for lists that overlap.
+    /// Submitted lists are executed and reset by the render loop; they must stay
+    /// alive until the frame has been rendered.
+    /// @param drawList List recorded on a worker thread
+    /// @param layer Ordering key (lower is drawn first)
+    void submitDrawList(render::DrawList* drawList, int32_t layer);
+
+    /// Collect this frame's draw lists in encode order (main list included)
+    /// Called by the render loop; clears the submission queue.
+    /// @param outLists Receives the ordered lists
+    void collectDrawLists(std::vector<render::DrawList*>& outLists);
+
+    // MARK: - Pipelined Frames
+
+    /// Enable pipelined frames
+    /// The render loop records frame N+1 on the main thread while a render
+    /// thread encodes and commits frame N, using two main draw lists that are
+    /// swapped each frame. Adds one frame of latency. Lists submitted with
+    /// submitDrawList() are still being encoded while the next frame records,
+    /// so workers must alternate between two lists as well.
+    /// @param enabled true to pipeline recording and encoding
+    void setPipelinedFrames(bool enabled);
+
+    /// Check whether pipelined frames are enabled
+    bool isPipelinedFrames() const;
+
+    /// Swap the main draw lists (called by the render loop)
+    /// @return The list recorded this frame, now owned by the render thread
+    render::DrawList& swapDrawLists();
+
+    // MARK: - Frame Pacing
+
+    /// How the render loop trades latency for throughput
+    enum class FramePacing {
+        /// Up to three frames queued on the GPU; pipelined frames allowed
+        Throughput,
+        /// One frame in flight, input sampled right before update() and
+        /// frames presented at the target rate; pipelining is ignored
+        LowLatency,
+        /// Refresh rate follows the frame rate range on ProMotion displays
+        Adaptive,
+    };
+
+    /// Set the frame pacing mode (applied from the next frame)
+    void setFramePacing(FramePacing pacing);
+
+    /// Get the frame pacing mode (default: Throughput)
+    FramePacing getFramePacing() const;
+
+    /// Set the refresh rates the Adaptive mode may pick from
+    /// @param minFps Lowest rate the display may drop to
+    /// @param maxFps Highest rate, also the preferred one
+    void setFrameRateRange(float minFps, float maxFps);
+
+    /// Get the range set by setFrameRateRange() (default: 30 - 120)
+    void getFrameRateRange(float& minFps, float& maxFps) const;
+
+    /// Estimated time from input to the frame showing it on screen
+    struct FrameLatency {
+        double lastMs = 0.0;        ///< Most recent measured frame
+        double averageMs = 0.0;     ///< Running average over ~30 frames
+        double maxMs = 0.0;         ///< Worst since the pacing mode changed
+        uint64_t framesMeasured = 0;
+    };
+
+    /// Note the input that the frame being recorded responds to
+    /// Called by the render loop once per frame, before update(). The
+    /// latency is measured when the renderer reports the frame presented.
+    /// @param inputTime Timestamp of the newest input (CACurrentMediaTime base)
+    void sampleInputLatency(double inputTime);
+
+    /// Get the input-to-photon estimate
+    FrameLatency getFrameLatency() const;
+
+    /// RAII helper: binds a draw list to the current thread for its lifetime
+    class ScopedDrawList {
+    public:
+        explicit ScopedDrawList(render::DrawList& drawList)
+            : previous_(Context::instance().getThreadDrawList()) {
+            Context::instance().bindThreadDrawList(&drawList);
+        }
+        ~ScopedDrawList() { Context::instance().bindThreadDrawList(previous_); }
+
+        ScopedDrawList(const ScopedDrawList&) = delete;
+        ScopedDrawList& operator=(const ScopedDrawList&) = delete;
+
+    private:
+        render::DrawList* previous_;
+    };
+
     /// Get the Metal device (Phase 3.3)
     /// @return Metal device (id<MTLDevice>) cast to void*, or nullptr if renderer not initialized
     void* getMetalDevice() const;
@@ -81,6 +227,23 @@ public:
     /// @param fps Target frames per second (default: 60)
     void setFrameRate(float fps);
 
+    /// Get the rate set by setFrameRate()
+    float getTargetFrameRate() const;
+
+    /// Drive time by hand instead of the wall clock
+    /// While enabled, getElapsedTime() and the measured frame rate advance
+    /// only through advanceClock(), so runs are reproducible. Time continues
+    /// from its current value when the clock switches.
+    /// @param enabled true for a manual clock
+    void setManualClock(bool enabled);
+
+    /// Check whether the manual clock is enabled
+    bool isManualClock() const;
+
+    /// Advance the manual clock (ignored while it is disabled)
+    /// @param seconds Time to add, e.g. one frame period per frame
+    void advanceClock(double seconds);
+
     /// Increment frame counter (called internally by the render loop)
     void incrementFrame();
 
@@ -214,7 +377,7 @@ public:
     // MARK: - Light State (Phase 8.5)
 
     /// Register a light for rendering
-    /// @param lightData Light uniform data (23 floats per light)
+    /// @param lightData Light uniform data (render::kLightFloats floats; up to render::kMaxLights are drawn)
     void registerLight(const std::vector<float>& lightData);
 
     /// Unregister a light
@@ -240,6 +403,34 @@ public:
     /// @return true if lighting is enabled
     bool isLightingEnabled() const;
 
+    /// Register the shadow map of a light for lit draws
+    /// Replaces an earlier registration with the same key. Lit draws sample up
+    /// to render::kMaxShadowLights maps, of lights that are registered with
+    /// exactly this data.
+    /// @param key Owner of the shadow map (one registration per key)
+    /// @param lightData Uniform data of the light casting the shadow
+    /// @param shadowMap Native id<MTLTexture> depth 2D array (__bridge void*)
+    /// @param shadow Shadow uniforms; matrices map world space to shadow map clip space
+    void setLightShadow(const void* key, const std::vector<float>& lightData, void* shadowMap,
+                        const render::ShadowLight& shadow);
+
+    /// Remove a shadow map registered with setLightShadow()
+    /// @param key Owner passed to setLightShadow()
+    void clearLightShadow(const void* key);
+
+    /// Get a handle to the current lighting/material block in this frame's draw list
+    /// Blocks are interned by version: the block is only rebuilt and added to the
+    /// DrawList side table when lights or material changed since the last call
+    /// (or the draw list was reset), so unchanged state costs no copies. While
+    /// shadow maps are registered the block also depends on the view matrix.
+    /// @return Handle for DrawCommand3D::lightingHandle (0xFFFF if the table is full)
+    uint16_t getLightingStateHandle();
+
+    /// Get the lighting/material version counter
+    /// Incremented whenever lights or material data change
+    /// @return Current version
+    uint64_t getLightingVersion() const;
+
     // MARK: - Keyboard State
 
     /// Set key state (pressed or released)
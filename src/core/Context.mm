@@ -5,11 +5,17 @@
 #include "Context.h"
 #include "../render/IRenderer.h"
 #include "../render/DrawList.h"
+#include "../render/DrawCommand.h"
 #include "../render/metal/MetalRenderer.h"
+#include "../render/metal/MetalAllocations.h"
+#include "../oflike/utils/ofProfiler.h"
 #include <iostream>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
+#include <algorithm>
+#include <cstring>
+#include <deque>
 
 // MARK: - Context Implementation
 
@@ -20,10 +26,40 @@ struct Context::Impl {
     // Renderer (Phase 3.1)
     std::unique_ptr<render::metal::MetalRenderer> renderer;
 
-    // Draw list for current frame
-    render::DrawList drawList;
+    // Draw lists: the app records into drawLists[recordIndex]; in pipelined
+    // mode the other one is being encoded by the render thread
+    render::DrawList drawLists[2];
+    uint32_t recordIndex = 0;
+    bool pipelinedFrames = false;
+
+    render::DrawList& mainDrawList() { return drawLists[recordIndex]; }
+
+    // Frame pacing
+    FramePacing framePacing = FramePacing::Throughput;
+    float minFrameRate = 30.0f;
+    float maxFrameRate = 120.0f;
+
+    // Input-to-photon: (frame serial, input time) of frames not yet presented
+    std::deque<std::pair<uint64_t, double>> pendingLatency;
+    FrameLatency frameLatency;
+
+    // Worker-recorded lists queued for this frame (layer, list)
+    std::mutex submittedMutex;
+    std::vector<std::pair<int32_t, render::DrawList*>> submittedLists;
+
+    // Offscreen targets of a headless context
+    bool headless = false;
+    id<MTLTexture> headlessColor = nil;
+    id<MTLTexture> headlessDepth = nil;
+    MTLRenderPassDescriptor* headlessPass = nil;
+
+    bool createHeadlessTargets(int width, int height);
 
     // Timing
+    bool manualClock = false;
+    double manualTime = 0.0;            // Seconds since startTime on the manual clock
+    CFTimeInterval now() const { return manualClock ? startTime + manualTime : CACurrentMediaTime(); }
+
     CFTimeInterval startTime = 0.0;
     CFTimeInterval lastFrameTime = 0.0;
     unsigned long long frameNum = 0;
@@ -60,9 +96,22 @@ struct Context::Impl {
     std::vector<float> currentMaterialData;
 
     // Light state (Phase 8.5)
-    std::vector<std::vector<float>> registeredLights;  // Each light is 23 floats
+    std::vector<std::vector<float>> registeredLights;  // Each light is kLightFloats floats
     bool lightingEnabled = false;
 
+    // Shadow maps of shadow-casting lights, by owner
+    struct LightShadow {
+        const void* key;
+        std::vector<float> lightData;
+        void* shadowMap;                   // id<MTLTexture>
+        render::ShadowLight shadow;        // Matrices in world space
+    };
+    std::vector<LightShadow> lightShadows;
+
+    // Lighting/material interning (per-frame side table handles)
+    uint64_t lightingVersion = 1;          // Bumped on any light/material change
+    uint64_t lightsVersion = 1;            // Bumped on light changes only
+
     // State
     bool initialized = false;
 
@@ -80,6 +129,25 @@ struct Context::Impl {
     }
 };
 
+// MARK: - Per-thread Recording State
+
+namespace {
+// Draw list bound by the calling thread (nullptr = main list)
+thread_local render::DrawList* threadDrawList = nullptr;
+
+// Cached lighting handle; per thread because each thread records into its own list
+struct InternedLighting {
+    const render::DrawList* list = nullptr;
+    uint64_t version = 0;                  // Version of the cached handle
+    uint64_t generation = 0;               // DrawList generation of the cached handle
+    uint16_t handle = render::kInvalidLightingHandle;
+    uint64_t lightsVersion = 0;            // Light setup copied to the light pool
+    uint32_t firstLight = 0;               // Where it starts in the pool
+    simd_float4x4 viewMatrix = matrix_identity_float4x4;  // View the shadow matrices were built for
+};
+thread_local InternedLighting threadInterned;
+}  // namespace
+
 // MARK: - Singleton Implementation
 
 Context& Context::instance() {
@@ -104,6 +172,7 @@ void Context::initialize(void* metalDevice) {
             std::cout << "[Context] Warning: Already initialized" << std::endl;
             return;
         }
+        OF_STARTUP_SCOPE("Context");
 
         // Bridge Metal device from Swift
         impl_->device = (__bridge id<MTLDevice>)metalDevice;
@@ -145,6 +214,10 @@ void Context::shutdown() {
             impl_->renderer->shutdown();
             impl_->renderer.reset();
         }
+        impl_->headless = false;
+        impl_->headlessColor = nil;
+        impl_->headlessDepth = nil;
+        impl_->headlessPass = nil;
 
         impl_->device = nil;
         impl_->initialized = false;
@@ -167,6 +240,7 @@ void Context::initializeRenderer(void* metalDevice, void* metalView) {
             return;
         }
 
+        OF_STARTUP_SCOPE("Renderer");
         std::cout << "[Context] Initializing Metal renderer..." << std::endl;
 
         // Create renderer with device and view (Phase 3.1)
@@ -191,8 +265,242 @@ render::IRenderer* Context::renderer() const {
     return impl_->renderer.get();
 }
 
+// MARK: - Headless Rendering
+
+bool Context::Impl::createHeadlessTargets(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        std::cerr << "[Context] Error: Invalid headless size " << width << "x" << height << std::endl;
+        return false;
+    }
+
+    // Same formats as the view, so pipelines built for either match
+    MTLTextureDescriptor* desc = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:MTLPixelFormatBGRA8Unorm
+                                                                                    width:width
+                                                                                   height:height
+                                                                                mipmapped:NO];
+    desc.usage = MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead;
+    desc.storageMode = MTLStorageModePrivate;
+    id<MTLTexture> color = render::metal::makeTrackedTexture(device, desc, oflike::ofGpuMemoryCategory::RenderTargets,
+                                                             "Headless Color");
+    desc.pixelFormat = MTLPixelFormatDepth32Float;
+    desc.usage = MTLTextureUsageRenderTarget;
+    id<MTLTexture> depth = render::metal::makeTrackedTexture(device, desc, oflike::ofGpuMemoryCategory::RenderTargets,
+                                                             "Headless Depth");
+    if (!color || !depth) {
+        std::cerr << "[Context] Error: Failed to create headless targets" << std::endl;
+        return false;
+    }
+
+    MTLRenderPassDescriptor* pass = [MTLRenderPassDescriptor renderPassDescriptor];
+    pass.colorAttachments[0].texture = color;
+    pass.colorAttachments[0].loadAction = MTLLoadActionClear;
+    pass.colorAttachments[0].storeAction = MTLStoreActionStore;
+    pass.colorAttachments[0].clearColor = MTLClearColorMake(0, 0, 0, 1);
+    pass.depthAttachment.texture = depth;
+    pass.depthAttachment.loadAction = MTLLoadActionClear;
+    pass.depthAttachment.storeAction = MTLStoreActionDontCare;
+    pass.depthAttachment.clearDepth = 1.0;
+
+    headlessColor = color;
+    headlessDepth = depth;
+    headlessPass = pass;
+    return true;
+}
+
+bool Context::initializeHeadless(void* metalDevice, int width, int height) {
+    @autoreleasepool {
+        initialize(metalDevice);
+        if (!impl_->initialized) {
+            return false;
+        }
+        // A renderer without a view draws into the pass bound each frame
+        initializeRenderer(metalDevice, nullptr);
+        if (!impl_->renderer || !impl_->createHeadlessTargets(width, height)) {
+            return false;
+        }
+
+        impl_->headless = true;
+        setWindowSize(width, height);
+        impl_->renderer->setViewport(0, 0, static_cast<float>(width), static_cast<float>(height));
+        std::cout << "[Context] Headless rendering at " << width << "x" << height << std::endl;
+        return true;
+    }
+}
+
+bool Context::isHeadless() const {
+    return impl_->headless;
+}
+
+bool Context::setHeadlessSize(int width, int height) {
+    @autoreleasepool {
+        if (!impl_->headless) {
+            return false;
+        }
+        // Frames in flight still render into the old targets, which they retain
+        if (!impl_->createHeadlessTargets(width, height)) {
+            return false;
+        }
+        setWindowSize(width, height);
+        impl_->renderer->setViewport(0, 0, static_cast<float>(width), static_cast<float>(height));
+        return true;
+    }
+}
+
+bool Context::beginHeadlessFrame() {
+    if (!impl_->headless || !impl_->renderer->beginFrame()) {
+        return false;
+    }
+    impl_->renderer->setFrameTarget(nullptr, (__bridge void*)impl_->headlessPass);
+    return true;
+}
+
+void Context::waitForHeadlessFrames() {
+    if (impl_->headless) {
+        impl_->renderer->waitForFrames();
+    }
+}
+
+void* Context::getHeadlessTexture() const {
+    return impl_->headless ? (__bridge void*)impl_->headlessColor : nullptr;
+}
+
 render::DrawList& Context::getDrawList() {
-    return impl_->drawList;
+    return threadDrawList ? *threadDrawList : impl_->mainDrawList();
+}
+
+// MARK: - Pipelined Frames
+
+void Context::setPipelinedFrames(bool enabled) {
+    impl_->pipelinedFrames = enabled;
+}
+
+bool Context::isPipelinedFrames() const {
+    return impl_->pipelinedFrames;
+}
+
+render::DrawList& Context::swapDrawLists() {
+    render::DrawList& recorded = impl_->mainDrawList();
+    impl_->recordIndex ^= 1u;
+
+    // List settings follow the app, not the buffer
+    render::DrawList& next = impl_->mainDrawList();
+    next.setTransformBaking(recorded.isTransformBakingEnabled(),
+                            recorded.getTransformBakingMaxVertices());
+    next.setTextureBatching(recorded.isTextureBatchingEnabled());
+    next.setVertexCompression(recorded.isVertexCompressionEnabled());
+    return recorded;
+}
+
+// MARK: - Frame Pacing
+
+void Context::setFramePacing(FramePacing pacing) {
+    if (pacing == impl_->framePacing) {
+        return;
+    }
+    impl_->framePacing = pacing;
+    impl_->pendingLatency.clear();
+    impl_->frameLatency = FrameLatency();
+}
+
+Context::FramePacing Context::getFramePacing() const {
+    return impl_->framePacing;
+}
+
+void Context::setFrameRateRange(float minFps, float maxFps) {
+    if (minFps <= 0.0f || maxFps < minFps) {
+        std::cerr << "[Context] Invalid frame rate range " << minFps << " - " << maxFps << std::endl;
+        return;
+    }
+    impl_->minFrameRate = minFps;
+    impl_->maxFrameRate = maxFps;
+}
+
+void Context::getFrameRateRange(float& minFps, float& maxFps) const {
+    minFps = impl_->minFrameRate;
+    maxFps = impl_->maxFrameRate;
+}
+
+void Context::sampleInputLatency(double inputTime) {
+    if (!impl_->renderer) {
+        return;
+    }
+
+    // Frames presented since the last call: the latest presented one stands
+    // for all of them, older entries are dropped
+    uint64_t presentedSerial = 0;
+    double presentedTime = 0.0;
+    auto& pending = impl_->pendingLatency;
+    if (impl_->renderer->getLastPresentedFrame(presentedSerial, presentedTime)) {
+        double latencySeconds = -1.0;
+        while (!pending.empty() && pending.front().first <= presentedSerial) {
+            latencySeconds = presentedTime - pending.front().second;
+            pending.pop_front();
+        }
+        if (latencySeconds >= 0.0) {
+            FrameLatency& latency = impl_->frameLatency;
+            latency.lastMs = latencySeconds * 1000.0;
+            latency.averageMs = latency.framesMeasured == 0
+                ? latency.lastMs
+                : latency.averageMs + (latency.lastMs - latency.averageMs) / 30.0;
+            latency.maxMs = std::max(latency.maxMs, latency.lastMs);
+            latency.framesMeasured += 1;
+        }
+    }
+
+    // Frames that are never presented (no drawable) must not pile up
+    constexpr size_t kMaxPendingFrames = 8;
+    if (pending.size() >= kMaxPendingFrames) {
+        pending.pop_front();
+    }
+    pending.emplace_back(impl_->renderer->getRecordingFrameSerial(), inputTime);
+}
+
+Context::FrameLatency Context::getFrameLatency() const {
+    return impl_->frameLatency;
+}
+
+// MARK: - Multi-threaded Recording
+
+void Context::bindThreadDrawList(render::DrawList* drawList) {
+    threadDrawList = drawList;
+}
+
+render::DrawList* Context::getThreadDrawList() const {
+    return threadDrawList;
+}
+
+void Context::submitDrawList(render::DrawList* drawList, int32_t layer) {
+    if (!drawList || drawList == &impl_->mainDrawList()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(impl_->submittedMutex);
+    impl_->submittedLists.emplace_back(layer, drawList);
+}
+
+void Context::collectDrawLists(std::vector<render::DrawList*>& outLists) {
+    std::vector<std::pair<int32_t, render::DrawList*>> submitted;
+    {
+        std::lock_guard<std::mutex> lock(impl_->submittedMutex);
+        submitted.swap(impl_->submittedLists);
+    }
+
+    // Main list is layer 0 and wins ties. Equal worker layers keep submission
+    // order, which depends on thread timing; overlapping lists need distinct layers.
+    render::DrawList* mainList = &impl_->mainDrawList();
+    submitted.emplace_back(0, mainList);
+    std::stable_sort(submitted.begin(), submitted.end(),
+                     [mainList](const auto& a, const auto& b) {
+                         if (a.first != b.first) {
+                             return a.first < b.first;
+                         }
+                         return a.second == mainList && b.second != mainList;
+                     });
+
+    outLists.clear();
+    outLists.reserve(submitted.size());
+    for (const auto& entry : submitted) {
+        outLists.push_back(entry.second);
+    }
 }
 
 void* Context::getMetalDevice() const {
@@ -216,7 +524,7 @@ double Context::getElapsedTime() const {
         return 0.0;
     }
 
-    CFTimeInterval currentTime = CACurrentMediaTime();
+    CFTimeInterval currentTime = impl_->now();
     return currentTime - impl_->startTime;
 }
 
@@ -236,6 +544,31 @@ void Context::setFrameRate(float fps) {
     }
 }
 
+float Context::getTargetFrameRate() const { return impl_->targetFrameRate; }
+
+void Context::setManualClock(bool enabled) {
+    if (enabled == impl_->manualClock) {
+        return;
+    }
+    // Continue from the current time on either clock
+    if (enabled) {
+        impl_->manualTime = impl_->initialized ? CACurrentMediaTime() - impl_->startTime : 0.0;
+    } else {
+        impl_->startTime = CACurrentMediaTime() - impl_->manualTime;
+    }
+    impl_->manualClock = enabled;
+    impl_->fpsUpdateTime = impl_->now();
+    impl_->framesSinceLastFPSUpdate = 0;
+}
+
+bool Context::isManualClock() const { return impl_->manualClock; }
+
+void Context::advanceClock(double seconds) {
+    if (impl_->manualClock && seconds > 0.0) {
+        impl_->manualTime += seconds;
+    }
+}
+
 void Context::incrementFrame() {
     if (!impl_->initialized) {
         return;
@@ -245,7 +578,7 @@ void Context::incrementFrame() {
     impl_->framesSinceLastFPSUpdate++;
 
     // Update FPS calculation
-    CFTimeInterval currentTime = CACurrentMediaTime();
+    CFTimeInterval currentTime = impl_->now();
     CFTimeInterval elapsed = currentTime - impl_->fpsUpdateTime;
 
     // Update FPS every 0.5 seconds
@@ -442,6 +775,7 @@ simd_float4 Context::getViewport() const {
 void Context::pushMaterial() {
     // Push current material state onto stack
     impl_->materialStack.push_back(impl_->currentMaterialData);
+    impl_->lightingVersion++;
 }
 
 void Context::popMaterial() {
@@ -449,11 +783,13 @@ void Context::popMaterial() {
     if (!impl_->materialStack.empty()) {
         impl_->currentMaterialData = impl_->materialStack.back();
         impl_->materialStack.pop_back();
+        impl_->lightingVersion++;
     }
 }
 
 void Context::setMaterialData(const std::vector<float>& materialData) {
     impl_->currentMaterialData = materialData;
+    impl_->lightingVersion++;
 }
 
 std::vector<float> Context::getMaterialData() const {
@@ -480,6 +816,8 @@ bool Context::hasMaterial() const {
 
 void Context::registerLight(const std::vector<float>& lightData) {
     impl_->registeredLights.push_back(lightData);
+    impl_->lightingVersion++;
+    impl_->lightsVersion++;
 }
 
 void Context::unregisterLight(const std::vector<float>& lightData) {
@@ -488,6 +826,8 @@ void Context::unregisterLight(const std::vector<float>& lightData) {
         // Compare light data (first few floats should be enough to identify)
         if (it->size() == lightData.size() && *it == lightData) {
             lights.erase(it);
+            impl_->lightingVersion++;
+            impl_->lightsVersion++;
             return;
         }
     }
@@ -495,6 +835,8 @@ void Context::unregisterLight(const std::vector<float>& lightData) {
 
 void Context::clearLights() {
     impl_->registeredLights.clear();
+    impl_->lightingVersion++;
+    impl_->lightsVersion++;
 }
 
 int Context::getLightCount() const {
@@ -517,6 +859,118 @@ bool Context::isLightingEnabled() const {
     return impl_->lightingEnabled;
 }
 
+void Context::setLightShadow(const void* key, const std::vector<float>& lightData, void* shadowMap,
+                             const render::ShadowLight& shadow) {
+    auto& shadows = impl_->lightShadows;
+    auto it = std::find_if(shadows.begin(), shadows.end(),
+                           [key](const Impl::LightShadow& entry) { return entry.key == key; });
+    if (it == shadows.end()) {
+        it = shadows.insert(shadows.end(), Impl::LightShadow{key, {}, nullptr, shadow});
+    }
+    it->lightData = lightData;
+    it->shadowMap = shadowMap;
+    it->shadow = shadow;
+    impl_->lightingVersion++;
+}
+
+void Context::clearLightShadow(const void* key) {
+    auto& shadows = impl_->lightShadows;
+    auto it = std::find_if(shadows.begin(), shadows.end(),
+                           [key](const Impl::LightShadow& entry) { return entry.key == key; });
+    if (it != shadows.end()) {
+        shadows.erase(it);
+        impl_->lightingVersion++;
+    }
+}
+
+uint16_t Context::getLightingStateHandle() {
+    render::DrawList& drawList = getDrawList();
+    InternedLighting& interned = threadInterned;
+
+    // Reuse the cached block while nothing changed within this frame (and,
+    // with shadows, under the same view)
+    const bool shadowed = !impl_->lightShadows.empty();
+    if (interned.handle != render::kInvalidLightingHandle &&
+        interned.list == &drawList &&
+        interned.version == impl_->lightingVersion &&
+        interned.generation == drawList.getGeneration() &&
+        (!shadowed || std::memcmp(&interned.viewMatrix, &impl_->currentViewMatrix,
+                                  sizeof(simd_float4x4)) == 0)) {
+        return interned.handle;
+    }
+
+    const bool sameList = interned.list == &drawList && interned.generation == drawList.getGeneration();
+    const size_t lightCount = std::min(impl_->registeredLights.size(), render::kMaxLights);
+
+    render::LightingState lighting;
+    lighting.lightCount = static_cast<int>(lightCount);
+
+    auto matData = getMaterialData();
+    size_t matSize = std::min(matData.size(), size_t(16));
+    std::memcpy(lighting.materialData, matData.data(), matSize * sizeof(float));
+
+    // Lights go to the list's pool once per light setup; material-only
+    // changes reuse the range
+    if (sameList && interned.lightsVersion == impl_->lightsVersion) {
+        lighting.firstLight = interned.firstLight;
+    } else {
+        float* dst = drawList.allocateLights(lightCount, lighting.firstLight);
+        for (size_t i = 0; i < lightCount; i++) {
+            const auto& light = impl_->registeredLights[i];
+            const size_t count = std::min(light.size(), render::kLightFloats);
+            std::memcpy(dst + i * render::kLightFloats, light.data(), count * sizeof(float));
+        }
+        interned.lightsVersion = impl_->lightsVersion;
+        interned.firstLight = lighting.firstLight;
+    }
+
+    // Shadow matrices go from world space to the view space lit draws shade in
+    if (shadowed) {
+        render::ShadowState shadows;
+        const simd_float4x4 inverseView = simd_inverse(impl_->currentViewMatrix);
+        int count = 0;
+        for (const auto& entry : impl_->lightShadows) {
+            if (count == (int)render::kMaxShadowLights) {
+                break;
+            }
+            int lightIndex = -1;
+            for (size_t i = 0; i < lightCount; i++) {
+                if (impl_->registeredLights[i] == entry.lightData) {
+                    lightIndex = static_cast<int>(i);
+                    break;
+                }
+            }
+            if (lightIndex < 0 || !entry.shadowMap) {
+                continue;
+            }
+
+            render::ShadowLight& light = shadows.uniforms.lights[count];
+            light = entry.shadow;
+            light.lightIndex = lightIndex;
+            for (int c = 0; c < light.cascadeCount; c++) {
+                light.matrices[c] = simd_mul(entry.shadow.matrices[c], inverseView);
+            }
+            shadows.shadowMaps[count] = entry.shadowMap;
+            count++;
+        }
+        shadows.uniforms.count = count;
+        if (count > 0) {
+            lighting.shadowHandle = drawList.addShadowState(shadows);
+        }
+        interned.viewMatrix = impl_->currentViewMatrix;
+    }
+
+    interned.handle = drawList.addLightingState(lighting);
+    interned.list = &drawList;
+    interned.version = impl_->lightingVersion;
+    interned.generation = drawList.getGeneration();
+    return interned.handle;
+}
+
+uint64_t Context::getLightingVersion() const {
+    return impl_->lightingVersion;
+}
+
 // MARK: - Keyboard State
 
 void Context::setKeyState(int key, bool pressed) {
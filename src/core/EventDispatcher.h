@@ -1,9 +1,11 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
-// Forward declaration
+// Forward declarations
 class ofBaseApp;
+struct ofMouseSample;
 
 /// Global event dispatcher singleton
 /// Routes events from SwiftUI layer to C++ application
@@ -19,6 +21,14 @@ class ofBaseApp;
 /// EventDispatcher::instance().setApp(myApp);
 /// EventDispatcher::instance().dispatchMouseMoved(x, y);
 /// ```
+///
+/// Motion coalescing:
+/// Trackpads report at 120 Hz and pen tablets up to 1 kHz, so mouseMoved and
+/// mouseDragged can fire many times per frame. With coalescing on, motion
+/// posted by the platform layer is queued and delivered once per frame, at
+/// the latest position, with every sample since the last frame available
+/// from getMousePath(). Presses, releases and other events deliver the
+/// queued motion first, so events keep their order.
 class EventDispatcher {
 public:
     /// Get the global event dispatcher instance (thread-safe singleton)
@@ -45,6 +55,42 @@ public:
     /// @param button Mouse button index (0=left, 1=right, 2=middle)
     void dispatchMouseDragged(int x, int y, int button);
 
+    // MARK: - Motion Input (coalescing)
+
+    /// Post a mouse moved sample from the platform layer
+    /// Dispatched at once, or queued until dispatchCoalescedMotion() when
+    /// coalescing is on. Lock-free; one thread may post.
+    /// @param x Mouse x position in pixels
+    /// @param y Mouse y position in pixels
+    /// @param timestamp Event time in seconds since system start-up
+    void postMouseMoved(float x, float y, double timestamp);
+
+    /// Post a mouse dragged sample from the platform layer
+    /// @param x Mouse x position in pixels
+    /// @param y Mouse y position in pixels
+    /// @param button Mouse button index (0=left, 1=right, 2=middle)
+    /// @param timestamp Event time in seconds since system start-up
+    void postMouseDragged(float x, float y, int button, double timestamp);
+
+    /// Deliver queued motion: one mouseMoved/mouseDragged per run of samples
+    /// with the same button, at the run's latest position
+    /// Called by the app loop once per frame, before update(). Clears the
+    /// path of the previous frame even when nothing is queued.
+    void dispatchCoalescedMotion();
+
+    /// Turn motion coalescing on or off (off by default)
+    /// Call from the main thread, e.g. in setup(); queued motion is delivered
+    /// before coalescing turns off.
+    void setCoalesceMotion(bool coalesce);
+
+    /// @return true if motion is coalesced to once per frame
+    bool getCoalesceMotion() const;
+
+    /// Samples behind the latest mouseMoved/mouseDragged call, oldest first
+    /// With coalescing on these are all the samples of the run it delivered;
+    /// otherwise just the one. Empty after a frame without motion.
+    const std::vector<ofMouseSample>& getMousePath() const;
+
     /// Dispatch mouse pressed event
     /// @param x Mouse x position in pixels
     /// @param y Mouse y position in pixels
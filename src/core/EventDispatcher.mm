@@ -1,8 +1,15 @@
 #import "EventDispatcher.h"
 #import "AppBase.h"
+#import "../oflike/utils/ofSpscQueue.h"
+#import "../oflike/utils/ofUtils.h"
 #import <array>
 #import <iostream>
 
+namespace {
+// About a second of 1 kHz pen input; a full queue drops new samples
+constexpr size_t kMotionQueueCapacity = 1024;
+}
+
 // MARK: - Implementation Details (pImpl)
 
 struct EventDispatcher::Impl {
@@ -18,6 +25,12 @@ struct EventDispatcher::Impl {
     // Mouse button states (left, right, middle, etc.)
     std::array<bool, 8> mouseButtons = {false};
 
+    // Motion coalescing: posted samples wait here until the frame drains them
+    bool coalesceMotion = false;
+    oflike::ofSpscQueue<ofMouseSample> motionQueue;
+    std::vector<ofMouseSample> path;        // Samples of the latest delivery
+    size_t droppedSamples = 0;
+
     /// Update mouse position and store previous position
     void updateMousePosition(int x, int y) {
         prevMouseX = mouseX;
@@ -25,6 +38,46 @@ struct EventDispatcher::Impl {
         mouseX = x;
         mouseY = y;
     }
+
+    /// Deliver one motion callback for the samples in path
+    void deliverPath() {
+        const ofMouseSample& latest = path.back();
+        const int x = static_cast<int>(latest.x);
+        const int y = static_cast<int>(latest.y);
+        updateMousePosition(x, y);
+        if (!app) {
+            return;
+        }
+        if (latest.button < 0) {
+            app->mouseMoved(x, y);
+        } else {
+            app->mouseDragged(x, y, latest.button);
+        }
+    }
+
+    /// Deliver the queued samples, one callback per run with the same button
+    /// A button change mid-path becomes its own callback, so a drag with one
+    /// button never reports the samples of another.
+    void drainMotion() {
+        if (!coalesceMotion) {
+            return;
+        }
+        bool started = false;
+        while (const ofMouseSample* sample = motionQueue.read()) {
+            if (!started || path.back().button != sample->button) {
+                if (started) {
+                    deliverPath();
+                }
+                path.clear();
+                started = true;
+            }
+            path.push_back(*sample);
+        }
+        motionQueue.release();
+        if (started) {
+            deliverPath();
+        }
+    }
 };
 
 // MARK: - EventDispatcher Implementation
@@ -73,7 +126,68 @@ void EventDispatcher::dispatchMouseDragged(int x, int y, int button) {
     }
 }
 
+// MARK: - Motion Input
+
+void EventDispatcher::postMouseMoved(float x, float y, double timestamp) {
+    postMouseDragged(x, y, -1, timestamp);
+}
+
+void EventDispatcher::postMouseDragged(float x, float y, int button, double timestamp) {
+    const ofMouseSample sample{x, y, button, timestamp};
+
+    if (!impl_->coalesceMotion) {
+        impl_->path.assign(1, sample);
+        impl_->deliverPath();
+        return;
+    }
+
+    ofMouseSample* slot = impl_->motionQueue.beginWrite();
+    if (!slot) {
+        ++impl_->droppedSamples;
+        return;
+    }
+    *slot = sample;
+    impl_->motionQueue.commitWrite();
+}
+
+void EventDispatcher::dispatchCoalescedMotion() {
+    Impl& impl = *impl_;
+    impl.path.clear();
+    impl.drainMotion();
+
+    if (impl.droppedSamples > 0) {
+        std::cerr << "[EventDispatcher] Motion queue full, dropped "
+                  << impl.droppedSamples << " samples" << std::endl;
+        impl.droppedSamples = 0;
+    }
+}
+
+void EventDispatcher::setCoalesceMotion(bool coalesce) {
+    if (coalesce == impl_->coalesceMotion) {
+        return;
+    }
+    if (coalesce) {
+        impl_->motionQueue.allocate(kMotionQueueCapacity);
+        impl_->path.reserve(kMotionQueueCapacity);
+    } else {
+        dispatchCoalescedMotion();
+    }
+    impl_->coalesceMotion = coalesce;
+}
+
+bool EventDispatcher::getCoalesceMotion() const {
+    return impl_->coalesceMotion;
+}
+
+const std::vector<ofMouseSample>& EventDispatcher::getMousePath() const {
+    return impl_->path;
+}
+
+// MARK: - Button, Scroll and Crossing Events
+
 void EventDispatcher::dispatchMousePressed(int x, int y, int button) {
+    // Motion queued before the press is delivered before it
+    impl_->drainMotion();
     impl_->updateMousePosition(x, y);
 
     // Update button state
@@ -87,6 +201,7 @@ void EventDispatcher::dispatchMousePressed(int x, int y, int button) {
 }
 
 void EventDispatcher::dispatchMouseReleased(int x, int y, int button) {
+    impl_->drainMotion();
     impl_->updateMousePosition(x, y);
 
     // Update button state
@@ -100,6 +215,7 @@ void EventDispatcher::dispatchMouseReleased(int x, int y, int button) {
 }
 
 void EventDispatcher::dispatchMouseScrolled(int x, int y, float scrollX, float scrollY) {
+    impl_->drainMotion();
     impl_->updateMousePosition(x, y);
 
     if (impl_->app) {
@@ -108,6 +224,7 @@ void EventDispatcher::dispatchMouseScrolled(int x, int y, float scrollX, float s
 }
 
 void EventDispatcher::dispatchMouseEntered(int x, int y) {
+    impl_->drainMotion();
     impl_->updateMousePosition(x, y);
 
     if (impl_->app) {
@@ -116,6 +233,7 @@ void EventDispatcher::dispatchMouseEntered(int x, int y) {
 }
 
 void EventDispatcher::dispatchMouseExited(int x, int y) {
+    impl_->drainMotion();
     impl_->updateMousePosition(x, y);
 
     if (impl_->app) {
@@ -0,0 +1,108 @@
+#include "FrustumCulling.h"
+#include "../graphics/ofGraphics.h"
+#include "../graphics/ofGraphicsTransform.h"
+#include "../graphics/ofDisplayList.h"
+#include "../../render/DrawList.h"
+#include "../../core/Context.h"
+#include <Accelerate/Accelerate.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace oflike {
+
+// ============================================================================
+// Bounds
+// ============================================================================
+
+void computeBounds(const float* positions, size_t count, size_t stride,
+                   ofVec3f& min, ofVec3f& max) {
+    // Strided vDSP reductions over the x, y and z streams
+    const vDSP_Stride step = static_cast<vDSP_Stride>(stride);
+    const vDSP_Length length = count;
+    vDSP_minv(positions, step, &min.x, length);
+    vDSP_minv(positions + 1, step, &min.y, length);
+    vDSP_minv(positions + 2, step, &min.z, length);
+    vDSP_maxv(positions, step, &max.x, length);
+    vDSP_maxv(positions + 1, step, &max.y, length);
+    vDSP_maxv(positions + 2, step, &max.z, length);
+}
+
+void boundingSphereFromBounds(const ofVec3f& min, const ofVec3f& max,
+                              ofVec3f& center, float& radius) {
+    center = (min + max) * 0.5f;
+    radius = (max - min).length() * 0.5f;
+}
+
+// ============================================================================
+// Frustum Tests
+// ============================================================================
+
+bool isBoxOutsideFrustum(const ofVec3f& min, const ofVec3f& max,
+                         const simd_float4x4& modelViewProjection) {
+    const simd_float4x4& m = modelViewProjection;
+    const simd_float4 row0 = simd_make_float4(m.columns[0].x, m.columns[1].x, m.columns[2].x, m.columns[3].x);
+    const simd_float4 row1 = simd_make_float4(m.columns[0].y, m.columns[1].y, m.columns[2].y, m.columns[3].y);
+    const simd_float4 row2 = simd_make_float4(m.columns[0].z, m.columns[1].z, m.columns[2].z, m.columns[3].z);
+    const simd_float4 row3 = simd_make_float4(m.columns[0].w, m.columns[1].w, m.columns[2].w, m.columns[3].w);
+    const simd_float4 planes[6] = {
+        row3 + row0, row3 - row0,
+        row3 + row1, row3 - row1,
+        row3 + row2, row3 - row2
+    };
+
+    for (const simd_float4& plane : planes) {
+        // The corner furthest along the plane normal; if even that one is
+        // behind the plane, the whole box is
+        const simd_float4 corner = simd_make_float4(plane.x >= 0.0f ? max.x : min.x,
+                                                    plane.y >= 0.0f ? max.y : min.y,
+                                                    plane.z >= 0.0f ? max.z : min.z,
+                                                    1.0f);
+        if (simd_dot(plane, corner) < 0.0f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool isFrustumCullingActive() {
+    return ofGetFrustumCullingEnabled() && !ofIsRecordingDisplayList();
+}
+
+bool cullDraw(const ofVec3f& min, const ofVec3f& max) {
+    auto& ctx = Context::instance();
+    const simd_float4x4 modelViewProjection = simd_mul(ctx.getProjectionMatrix(),
+                                                       ofGetCurrentModelViewMatrix());
+    if (!isBoxOutsideFrustum(min, max, modelViewProjection)) {
+        return false;
+    }
+    ctx.getDrawList().addCulledDraw();
+    return true;
+}
+
+// ============================================================================
+// Screen Size
+// ============================================================================
+
+float projectedDiameter(const ofVec3f& center, float radius) {
+    auto& ctx = Context::instance();
+    const simd_float4x4& modelView = ofGetCurrentModelViewMatrix();
+    const simd_float4x4 projection = ctx.getProjectionMatrix();
+
+    const float scale2 = std::max({simd_length_squared(simd_make_float3(modelView.columns[0])),
+                                   simd_length_squared(simd_make_float3(modelView.columns[1])),
+                                   simd_length_squared(simd_make_float3(modelView.columns[2]))});
+    const float viewRadius = radius * std::sqrt(scale2);
+    const simd_float4 viewCenter = simd_mul(modelView, simd_make_float4(center.x, center.y, center.z, 1.0f));
+
+    // Clip w is the view depth for perspective projections and 1 for
+    // orthographic ones; the projected radius is viewRadius * P[1][1] / w
+    const float w = projection.columns[0].w * viewCenter.x + projection.columns[1].w * viewCenter.y +
+                    projection.columns[2].w * viewCenter.z + projection.columns[3].w;
+    if (w <= viewRadius && projection.columns[3].w == 0.0f) {
+        return FLT_MAX;
+    }
+    return viewRadius * std::abs(projection.columns[1].y) / w * ctx.getViewport().w;
+}
+
+} // namespace oflike
@@ -0,0 +1,78 @@
+#pragma once
+
+// oflike-metal FrustumCulling - mesh bounds and view tests
+// Shared by ofMesh, VboMesh and of3dPrimitive so draws that lie entirely
+// outside the view are dropped before they reach the DrawList, and levels of
+// detail are picked by screen size
+
+#include <simd/simd.h>
+#include <cstddef>
+#include "../math/ofVec3f.h"
+
+namespace oflike {
+
+// ============================================================================
+// Bounds
+// ============================================================================
+
+/// \brief Compute the axis-aligned bounds of strided positions
+/// \param positions First x coordinate; y and z follow it
+/// \param count Number of positions (at least 1)
+/// \param stride Distance between consecutive positions, in floats
+/// \param min Receives the smallest x, y and z
+/// \param max Receives the largest x, y and z
+void computeBounds(const float* positions, size_t count, size_t stride,
+                   ofVec3f& min, ofVec3f& max);
+
+/// \brief Get the sphere enclosing an axis-aligned box
+/// \param min Smallest corner
+/// \param max Largest corner
+/// \param center Receives the box center
+/// \param radius Receives half the box diagonal
+void boundingSphereFromBounds(const ofVec3f& min, const ofVec3f& max,
+                              ofVec3f& center, float& radius);
+
+// ============================================================================
+// Frustum Tests
+// ============================================================================
+
+/// \brief Test an axis-aligned box against a view frustum
+/// \details Planes are taken from the rows of the matrix (Gribb/Hartmann).
+/// Like the cullInstances kernel, near uses the GL depth range, which is
+/// looser than Metal's, so the test is conservative for either projection
+/// convention.
+/// \param min Smallest corner (in the matrix's input space)
+/// \param max Largest corner
+/// \param modelViewProjection Projection * View * Model
+/// \return True if the box lies entirely outside one of the planes
+bool isBoxOutsideFrustum(const ofVec3f& min, const ofVec3f& max,
+                         const simd_float4x4& modelViewProjection);
+
+/// \brief Check whether draws should be frustum-culled right now
+/// \details False while ofDisableFrustumCulling() is in effect and while a
+/// display list records (a recording is replayed under other views).
+bool isFrustumCullingActive();
+
+/// \brief Decide whether a draw of a model-space box can be skipped
+/// \details Tests against the current model matrix and the Context view
+/// and projection. Culled draws are counted on the current DrawList and
+/// show up in the renderer statistics.
+/// \param min Smallest corner of the mesh bounds
+/// \param max Largest corner of the mesh bounds
+/// \return True if the draw is outside the view and was counted as culled
+bool cullDraw(const ofVec3f& min, const ofVec3f& max);
+
+// ============================================================================
+// Screen Size
+// ============================================================================
+
+/// \brief Get the projected diameter of a model-space sphere in pixels
+/// \details Uses the current model matrix (its largest axis scale), the
+/// Context view and projection and the viewport height. Works for
+/// perspective and orthographic projections.
+/// \param center Sphere center (model space)
+/// \param radius Sphere radius (model space)
+/// \return Diameter on screen, or FLT_MAX when the camera is inside the sphere
+float projectedDiameter(const ofVec3f& center, float radius);
+
+} // namespace oflike
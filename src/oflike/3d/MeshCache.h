@@ -0,0 +1,84 @@
+#pragma once
+
+// oflike-metal MeshCache - native binary mesh files (.oflmesh)
+// The vertex records on disk are the GPU's render::Vertex3D records, so a
+// cached mesh is drawn straight from the mapped file without parsing
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "../../render/RenderTypes.h"
+
+namespace oflike {
+
+// ============================================================================
+// File Layout
+// ============================================================================
+
+/// Header at the start of every .oflmesh file
+/// \details Followed by vertexCount render::Vertex3D records at vertexOffset
+/// and indexCount indices of indexSize bytes at indexOffset. Both sections
+/// start on a kMeshCacheAlignment boundary so their offsets are whole
+/// vertices and indices. Values are little-endian (the native order of every
+/// supported Mac).
+struct MeshCacheHeader {
+    char magic[8];              ///< kMeshCacheMagic
+    uint32_t version;           ///< kMeshCacheVersion
+    uint32_t vertexStride;      ///< sizeof(render::Vertex3D)
+    uint32_t primitiveMode;     ///< ofPrimitiveMode
+    uint32_t attributes;        ///< kMeshCache* bits present in the source mesh
+    uint32_t indexSize;         ///< 2 or 4 bytes per index, 0 = not indexed
+    uint32_t reserved;
+    uint64_t vertexCount;
+    uint64_t indexCount;
+    uint64_t vertexOffset;      ///< Byte offset of the vertex records
+    uint64_t indexOffset;       ///< Byte offset of the indices
+};
+
+// Attributes the source mesh carried (absent ones hold the Vertex3D defaults)
+constexpr uint32_t kMeshCacheNormals = 1u << 0;
+constexpr uint32_t kMeshCacheTexCoords = 1u << 1;
+constexpr uint32_t kMeshCacheColors = 1u << 2;
+
+constexpr char kMeshCacheMagic[8] = {'O', 'F', 'L', 'M', 'E', 'S', 'H', '\0'};
+constexpr uint32_t kMeshCacheVersion = 1;
+constexpr size_t kMeshCacheAlignment = 256;
+
+static_assert(kMeshCacheAlignment % sizeof(render::Vertex3D) == 0,
+              "Vertex sections must start on a whole vertex");
+static_assert(sizeof(MeshCacheHeader) <= kMeshCacheAlignment,
+              "Header must fit before the first section");
+
+/// Round a byte offset up to the next section boundary
+inline uint64_t meshCacheAlign(uint64_t offset) {
+    return (offset + kMeshCacheAlignment - 1) / kMeshCacheAlignment * kMeshCacheAlignment;
+}
+
+/// Check that a header describes sections that fit in a file of fileSize bytes
+inline bool isValidMeshCache(const MeshCacheHeader& header, size_t fileSize) {
+    if (fileSize < sizeof(MeshCacheHeader) ||
+        std::memcmp(header.magic, kMeshCacheMagic, sizeof(kMeshCacheMagic)) != 0 ||
+        header.version != kMeshCacheVersion ||
+        header.vertexStride != sizeof(render::Vertex3D) ||
+        header.vertexOffset % kMeshCacheAlignment != 0 ||
+        header.indexOffset % kMeshCacheAlignment != 0) {
+        return false;
+    }
+    if (header.indexCount > 0 && header.indexSize != 2 && header.indexSize != 4) {
+        return false;
+    }
+    if (header.indexSize == 2 && header.vertexCount > 0xFFFF) {
+        return false;
+    }
+
+    const uint64_t size = fileSize;
+    const uint64_t vertexBytes = header.vertexCount * sizeof(render::Vertex3D);
+    const uint64_t indexBytes = header.indexCount * header.indexSize;
+    return header.vertexCount <= size / sizeof(render::Vertex3D) &&
+           header.vertexOffset <= size && vertexBytes <= size - header.vertexOffset &&
+           (header.indexCount == 0 ||
+            (header.indexCount <= size / header.indexSize &&
+             header.indexOffset <= size && indexBytes <= size - header.indexOffset));
+}
+
+} // namespace oflike
@@ -0,0 +1,147 @@
+#pragma once
+
+// oflike-metal ResidentMesh - GPU-resident copy of mesh geometry
+// Shared by ofMesh and VboMesh so unchanged meshes draw without re-uploading
+// their vertices every frame
+
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace render {
+class DrawList;
+struct DrawCommand3D;
+struct Vertex3D;
+enum class IndexType : uint32_t;
+}
+
+namespace oflike {
+
+/// \brief Resident GPU buffers mirroring a mesh's vertices and indices
+/// \details The owner calls invalidate() whenever its geometry changes and
+/// asks beginDraw() on every draw. A mesh drawn again without changes gets
+/// its geometry uploaded once into buffers the draw commands reference
+/// directly; later draws record only the command and a one-record tint.
+/// Geometry edited between every draw keeps streaming through the DrawList,
+/// so dynamic meshes never allocate buffers.
+///
+/// Implementation:
+/// - Vertices are stored in the render::Vertex3D layout, indices as 16-bit
+///   whenever the vertex count allows
+/// - adopt() takes over geometry that already sits in a buffer (a mapped
+///   .oflmesh file) instead of copying it
+/// - Wireframe (triangle edge) indices are built on the first wireframe draw
+/// - Buffers replaced by upload() stay alive for the frames in flight that
+///   may still read them
+/// - The owner must outlive frames recorded with its draws (as textures do)
+class ResidentMesh {
+public:
+    /// Smaller meshes stream: batching them beats binding their own buffers
+    static constexpr size_t kMinVertices = 256;
+
+    // ========================================================================
+    // Constructors & Destructor
+    // ========================================================================
+
+    /// \brief Default constructor (no buffers)
+    ResidentMesh();
+
+    /// \brief Destructor
+    ~ResidentMesh();
+
+    /// \brief Move constructor
+    ResidentMesh(ResidentMesh&& other) noexcept;
+
+    /// \brief Move assignment
+    ResidentMesh& operator=(ResidentMesh&& other) noexcept;
+
+    ResidentMesh(const ResidentMesh&) = delete;
+    ResidentMesh& operator=(const ResidentMesh&) = delete;
+
+    // ========================================================================
+    // Change Tracking
+    // ========================================================================
+
+    /// \brief Note that the source geometry changed
+    void invalidate();
+
+    /// \brief Decide whether this draw should use the resident copy
+    /// \details False for small meshes and for the first draw after
+    /// invalidate(); true once the geometry has been drawn unchanged.
+    /// \param vertexCount Vertices the draw would submit
+    bool beginDraw(size_t vertexCount);
+
+    /// \brief Check if the buffers hold the current geometry
+    bool isCurrent() const;
+
+    /// \brief Get the geometry version
+    /// \details Changes on invalidate(), adopt() and clear(), so owners can
+    /// key their other derived data (bounds) on the same tracking.
+    uint64_t getVersion() const;
+
+    // ========================================================================
+    // Upload & Drawing
+    // ========================================================================
+
+    /// \brief Replace the buffer contents with the current geometry
+    /// \param vertices Vertices, untinted (the tint is applied per draw)
+    /// \param vertexCount Number of vertices
+    /// \param indices Indices, or nullptr
+    /// \param indexCount Number of indices (0 = not indexed)
+    /// \return False if the buffers could not be created
+    bool upload(const render::Vertex3D* vertices, size_t vertexCount,
+                const uint32_t* indices, size_t indexCount);
+
+    /// \brief Use an existing buffer as the resident geometry
+    /// \details For geometry that already sits in a buffer in the
+    /// render::Vertex3D layout (a mapped mesh cache): vertices and indices are
+    /// ranges of the one buffer, and the copy is current until invalidate().
+    /// \param buffer id<MTLBuffer> holding vertices and indices; retained
+    /// \param vertexStart First vertex in the buffer
+    /// \param vertexCount Number of vertices
+    /// \param indexStart First index in the buffer (in indices)
+    /// \param indexCount Number of indices (0 = not indexed)
+    /// \param indexType Index element type
+    /// \return False if buffer is null
+    bool adopt(void* buffer, size_t vertexStart, size_t vertexCount,
+               size_t indexStart, size_t indexCount, render::IndexType indexType);
+
+    /// \brief Point a command's geometry at the resident buffers
+    /// \details Sets the vertex/index buffers, offsets and counts (edges
+    /// for wireframe) and leaves everything else alone.
+    /// \param vertexBuffer id<MTLBuffer> drawn instead of the resident
+    /// vertices, from its first record (a deformed copy), or nullptr
+    /// \return False if the copy isn't current
+    bool fill(render::DrawCommand3D& cmd, bool wireframe, void* vertexBuffer = nullptr);
+
+    /// \brief Record a draw of the resident geometry
+    /// \details state supplies the render state (primitive type, matrices,
+    /// depth, lighting); its geometry fields are replaced. The command is
+    /// recorded as a one-instance draw whose instance color carries tint.
+    /// \param drawList List to record into
+    /// \param state Command with everything but the geometry filled in
+    /// \param wireframe Draw the triangle edges as lines
+    /// \param tint RGBA (0-1) multiplied with the vertex colors
+    /// \param first First index drawn (vertex when not indexed)
+    /// \param count Number of indices (vertices) drawn; SIZE_MAX for the rest
+    /// \param vertexBuffer Vertices drawn instead of the resident ones (see fill())
+    /// \return False if nothing could be recorded (draw() should stream)
+    bool record(render::DrawList& drawList, const render::DrawCommand3D& state,
+                bool wireframe, const float tint[4],
+                size_t first = 0, size_t count = SIZE_MAX,
+                void* vertexBuffer = nullptr);
+
+    /// \brief Narrow a filled command to a range of its triangle indices
+    /// \details Ranges count indices of the triangle list (vertices when not
+    /// indexed); a wireframe edge list has two indices for each of them.
+    static void narrow(render::DrawCommand3D& cmd, size_t first, size_t count, bool wireframe);
+
+    /// \brief Release the buffers
+    void clear();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
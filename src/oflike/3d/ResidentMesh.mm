@@ -0,0 +1,299 @@
+// ResidentMesh.mm - GPU-resident copy of mesh geometry
+
+#import <Metal/Metal.h>
+#include "ResidentMesh.h"
+#include "../../core/Context.h"
+#include "../../render/DrawList.h"
+#include "../../render/DrawCommand.h"
+#include "../../render/IRenderer.h"
+#include "../../render/metal/MetalAllocations.h"
+#include <algorithm>
+#include <vector>
+#include <utility>
+
+namespace oflike {
+
+// ============================================================================
+// ResidentMesh::Impl
+// ============================================================================
+
+struct ResidentMesh::Impl {
+    id<MTLDevice> device = nil;
+
+    id<MTLBuffer> vertexBuffer = nil;
+    id<MTLBuffer> indexBuffer = nil;
+    id<MTLBuffer> wireframeBuffer = nil;    // Triangle edges, built on demand
+    render::IndexType indexType = render::IndexType::UInt32;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    uint32_t wireframeCount = 0;
+    uint32_t vertexStart = 0;               // Offsets into adopted buffers
+    uint32_t indexStart = 0;
+
+    // Source geometry version vs. the versions last drawn and uploaded
+    uint64_t version = 1;
+    uint64_t drawnVersion = 0;
+    uint64_t uploadedVersion = 0;
+
+    // Replaced buffers and the frame they were replaced in
+    std::vector<std::pair<id<MTLBuffer>, unsigned long long>> retired;
+
+    bool ensureDevice() {
+        if (device) return true;
+
+        auto& ctx = Context::instance();
+        if (!ctx.isInitialized()) {
+            return false;
+        }
+        device = (__bridge id<MTLDevice>)ctx.getMetalDevice();
+        return device != nil;
+    }
+
+    void retire(id<MTLBuffer> buffer, unsigned long long frame) {
+        if (buffer) {
+            retired.emplace_back(buffer, frame);
+        }
+    }
+
+    void releaseRetired(unsigned long long frame) {
+        size_t kept = 0;
+        for (auto& entry : retired) {
+            if (entry.second + render::kRetireFrames >= frame) {
+                retired[kept++] = std::move(entry);
+            }
+        }
+        retired.resize(kept);
+    }
+
+    void retireBuffers(unsigned long long frame) {
+        retire(vertexBuffer, frame);
+        retire(indexBuffer, frame);
+        retire(wireframeBuffer, frame);
+        vertexBuffer = nil;
+        indexBuffer = nil;
+        wireframeBuffer = nil;
+        vertexCount = 0;
+        indexCount = 0;
+        wireframeCount = 0;
+        vertexStart = 0;
+        indexStart = 0;
+    }
+
+    template <typename T>
+    id<MTLBuffer> makeIndexBuffer(const uint32_t* indices, size_t count) {
+        id<MTLBuffer> buffer = render::metal::makeTrackedBuffer(device, count * sizeof(T), MTLResourceStorageModeShared,
+                                                                ofGpuMemoryCategory::Meshes,
+                                                                "ResidentMesh Indices");
+        if (!buffer) return nil;
+        T* dst = (T*)[buffer contents];
+        for (size_t i = 0; i < count; i++) {
+            dst[i] = (T)indices[i];
+        }
+        return buffer;
+    }
+
+    id<MTLBuffer> makeIndexBuffer(const uint32_t* indices, size_t count) {
+        return indexType == render::IndexType::UInt16 ? makeIndexBuffer<uint16_t>(indices, count)
+                                                      : makeIndexBuffer<uint32_t>(indices, count);
+    }
+
+    bool ensureWireframe() {
+        if (wireframeBuffer) return true;
+        if (!indexBuffer || indexCount < 3) return false;
+
+        // For each triangle [a,b,c], create edges [a,b], [b,c], [c,a]
+        std::vector<uint32_t> triangles(indexCount);
+        const uint8_t* src = (const uint8_t*)[indexBuffer contents] + indexStart * render::indexSize(indexType);
+        for (uint32_t i = 0; i < indexCount; i++) {
+            triangles[i] = indexType == render::IndexType::UInt16 ? ((const uint16_t*)src)[i]
+                                                                  : ((const uint32_t*)src)[i];
+        }
+        std::vector<uint32_t> lines;
+        lines.reserve(indexCount * 2);
+        for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+            const uint32_t a = triangles[i], b = triangles[i + 1], c = triangles[i + 2];
+            lines.insert(lines.end(), {a, b, b, c, c, a});
+        }
+
+        wireframeBuffer = makeIndexBuffer(lines.data(), lines.size());
+        if (!wireframeBuffer) return false;
+        wireframeBuffer.label = @"ResidentMesh Wireframe";
+        wireframeCount = static_cast<uint32_t>(lines.size());
+        return true;
+    }
+};
+
+// ============================================================================
+// ResidentMesh Implementation
+// ============================================================================
+
+ResidentMesh::ResidentMesh()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ResidentMesh::~ResidentMesh() = default;
+
+ResidentMesh::ResidentMesh(ResidentMesh&& other) noexcept = default;
+
+ResidentMesh& ResidentMesh::operator=(ResidentMesh&& other) noexcept = default;
+
+void ResidentMesh::invalidate() {
+    impl_->version++;
+}
+
+bool ResidentMesh::beginDraw(size_t vertexCount) {
+    if (vertexCount < kMinVertices) {
+        return false;
+    }
+    if (impl_->drawnVersion != impl_->version) {
+        // First draw of this geometry; resident from the next one on
+        impl_->drawnVersion = impl_->version;
+        return false;
+    }
+    return true;
+}
+
+bool ResidentMesh::isCurrent() const {
+    return impl_->vertexBuffer && impl_->uploadedVersion == impl_->version;
+}
+
+uint64_t ResidentMesh::getVersion() const {
+    return impl_->version;
+}
+
+bool ResidentMesh::upload(const render::Vertex3D* vertices, size_t vertexCount,
+                          const uint32_t* indices, size_t indexCount) {
+    if (!vertices || vertexCount == 0 || !impl_->ensureDevice()) {
+        return false;
+    }
+
+    // Commands recorded this frame may still point at the current buffers
+    const unsigned long long frame = Context::instance().getFrameNum();
+    impl_->releaseRetired(frame);
+    impl_->retireBuffers(frame);
+
+    impl_->vertexBuffer = render::metal::makeTrackedBuffer(impl_->device, vertices,
+                                                           vertexCount * sizeof(render::Vertex3D),
+                                                           MTLResourceStorageModeShared,
+                                                           ofGpuMemoryCategory::Meshes,
+                                                           "ResidentMesh Vertices");
+    if (!impl_->vertexBuffer) {
+        return false;
+    }
+
+    impl_->indexType = render::indexTypeForVertexCount(vertexCount);
+    if (indices && indexCount > 0) {
+        impl_->indexBuffer = impl_->makeIndexBuffer(indices, indexCount);
+        if (!impl_->indexBuffer) {
+            impl_->vertexBuffer = nil;
+            return false;
+        }
+        impl_->indexBuffer.label = @"ResidentMesh Indices";
+    }
+
+    impl_->vertexCount = static_cast<uint32_t>(vertexCount);
+    impl_->indexCount = static_cast<uint32_t>(indices ? indexCount : 0);
+    impl_->uploadedVersion = impl_->version;
+    return true;
+}
+
+bool ResidentMesh::adopt(void* buffer, size_t vertexStart, size_t vertexCount,
+                         size_t indexStart, size_t indexCount, render::IndexType indexType) {
+    if (!buffer || vertexCount == 0) {
+        return false;
+    }
+
+    const unsigned long long frame = Context::instance().getFrameNum();
+    impl_->releaseRetired(frame);
+    impl_->retireBuffers(frame);
+
+    impl_->vertexBuffer = (__bridge id<MTLBuffer>)buffer;
+    impl_->indexBuffer = indexCount > 0 ? impl_->vertexBuffer : nil;
+    impl_->indexType = indexType;
+    impl_->vertexStart = static_cast<uint32_t>(vertexStart);
+    impl_->vertexCount = static_cast<uint32_t>(vertexCount);
+    impl_->indexStart = static_cast<uint32_t>(indexStart);
+    impl_->indexCount = static_cast<uint32_t>(indexCount);
+
+    // Nothing to upload: current from the first draw on
+    impl_->version++;
+    impl_->drawnVersion = impl_->version;
+    impl_->uploadedVersion = impl_->version;
+    if (!impl_->device) {
+        impl_->device = impl_->vertexBuffer.device;
+    }
+    return true;
+}
+
+bool ResidentMesh::fill(render::DrawCommand3D& cmd, bool wireframe, void* vertexBuffer) {
+    if (!isCurrent()) {
+        return false;
+    }
+
+    // Wireframe of an indexed mesh draws its edge list; without indices the
+    // vertices are drawn as lines, as the streaming path does
+    id<MTLBuffer> indices = impl_->indexBuffer;
+    uint32_t indexStart = impl_->indexStart;
+    uint32_t indexCount = impl_->indexCount;
+    if (wireframe && impl_->indexBuffer) {
+        if (!impl_->ensureWireframe()) {
+            return false;
+        }
+        indices = impl_->wireframeBuffer;
+        indexStart = 0;
+        indexCount = impl_->wireframeCount;
+    }
+
+    cmd.vertexFormat = render::VertexFormat::Float;
+    cmd.vertexBuffer = vertexBuffer ? vertexBuffer : (__bridge void*)impl_->vertexBuffer;
+    cmd.vertexOffset = vertexBuffer ? 0 : impl_->vertexStart;
+    cmd.vertexCount = impl_->vertexCount;
+    cmd.indexBuffer = (__bridge void*)indices;
+    cmd.indexType = impl_->indexType;
+    cmd.indexOffset = indices ? indexStart : 0;
+    cmd.indexCount = indices ? indexCount : 0;
+    return true;
+}
+
+bool ResidentMesh::record(render::DrawList& drawList, const render::DrawCommand3D& state,
+                          bool wireframe, const float tint[4], size_t first, size_t count,
+                          void* vertexBuffer) {
+    render::DrawCommand3DInstanced cmd;
+    static_cast<render::DrawCommand3D&>(cmd) = state;
+    if (!fill(cmd, wireframe, vertexBuffer)) {
+        return false;
+    }
+    if (first != 0 || count != SIZE_MAX) {
+        narrow(cmd, first, count, wireframe);
+    }
+
+    render::InstanceData instance;
+    instance.modelMatrix = matrix_identity_float4x4;
+    instance.color = simd_make_float4(tint[0], tint[1], tint[2], tint[3]);
+    instance.userData = simd_make_float4(0, 0, 0, 0);
+
+    cmd.type = render::CommandType::Draw3DInstanced;
+    cmd.instanceOffset = drawList.addInstances(&instance, 1);
+    cmd.instanceCount = 1;
+    drawList.addCommand(cmd);
+    return true;
+}
+
+void ResidentMesh::narrow(render::DrawCommand3D& cmd, size_t first, size_t count, bool wireframe) {
+    const bool indexed = cmd.indexCount > 0;
+    const size_t scale = wireframe && indexed ? 2 : 1;
+    uint32_t& offset = indexed ? cmd.indexOffset : cmd.vertexOffset;
+    uint32_t& total = indexed ? cmd.indexCount : cmd.vertexCount;
+
+    const size_t begin = std::min<size_t>(first * scale, total);
+    const size_t length = count == SIZE_MAX ? total - begin : std::min<size_t>(count * scale, total - begin);
+    offset += static_cast<uint32_t>(begin);
+    total = static_cast<uint32_t>(length);
+}
+
+void ResidentMesh::clear() {
+    impl_->retireBuffers(Context::instance().getFrameNum());
+    impl_->version++;
+}
+
+} // namespace oflike
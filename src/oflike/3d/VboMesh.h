@@ -4,11 +4,18 @@
 // Fully leverages Metal 3 features for high-performance rendering
 
 #include <memory>
+#include <string>
+#include <vector>
 #include "../math/ofVec2f.h"
 #include "../math/ofVec3f.h"
 #include "../types/ofColor.h"
 #include "ofMesh.h"
 
+namespace render {
+struct DrawCommand3D;
+enum class IndexType : uint32_t;
+}
+
 namespace oflike {
 
 // ============================================================================
@@ -138,6 +145,17 @@ struct VboIndirectArguments {
     uint32_t baseInstance;      ///< First instance ID
 };
 
+// ============================================================================
+// Bone Influences (GPU skinning)
+// ============================================================================
+
+/// Bones moving one vertex and their weights
+/// Weights are normalized to sum to 1 when set; unused slots keep weight 0.
+struct VboBoneInfluence {
+    uint16_t bones[4] = {0, 0, 0, 0};       ///< Indices into the bone matrices
+    float weights[4] = {1, 0, 0, 0};        ///< Relative influence of each bone
+};
+
 // ============================================================================
 // VboMesh - Modern Metal GPU Mesh
 // ============================================================================
@@ -176,6 +194,12 @@ struct VboIndirectArguments {
  *   VboMesh indirect;
  *   indirect.setMesh(mesh, VboUsageHint::Static);
  *   indirect.drawIndirect(argumentBuffer);
+ *
+ *   // Levels of detail (coarser meshes when small on screen)
+ *   VboMesh statue;
+ *   statue.setMesh(scan, VboUsageHint::Static);
+ *   statue.generateLods(3);   // 50%, 25%, 12.5% of the triangles
+ *   statue.draw();
  */
 class VboMesh {
 public:
@@ -218,6 +242,20 @@ public:
                   VboUsageHint usage = VboUsageHint::Dynamic,
                   VboAttributeLayout layout = VboAttributeLayout::Interleaved);
 
+    /// Load a mesh saved by ofMesh::save() as .oflmesh, without copying it
+    /// The file is memory-mapped and wrapped in a shared Metal buffer; its
+    /// vertex records are already in the GPU layout, so draws read the file
+    /// in place and loading costs neither parsing nor an upload. Loaded
+    /// meshes are static: the first update*() call copies them into regular
+    /// buffers. Instanced and indirect draws of a mapped mesh are tinted by
+    /// the instance colors only, not by the current color.
+    /// @param filename Path to the .oflmesh file
+    /// @return true on success
+    bool load(const std::string& filename);
+
+    /// Check if the mesh is drawn from a mapped file (see load())
+    bool isMapped() const;
+
     /// Explicitly set storage mode (overrides auto selection)
     void setStorageMode(VboStorageMode mode);
 
@@ -261,6 +299,61 @@ public:
     /// Call after CPU modifications if using Managed storage mode
     void sync();
 
+    // ========================================================================
+    // GPU Deformation (Skinning and Morph Targets)
+    // ========================================================================
+
+    /// Skin the mesh on the GPU with up to four bones per vertex
+    /// Once influences are set, every draw shows the vertices morphed by the
+    /// morph targets and then blended by the bone matrices, deformed by a
+    /// compute pass over the mesh: per frame only the bone matrices and
+    /// morph weights are uploaded. The pass runs at the frame's first draw
+    /// and later draws in the frame (other passes, instancing) reuse its
+    /// result, so pose changes after a draw show in the next frame.
+    /// Frustum culling uses the rest-pose bounds, and coarser levels of
+    /// detail are not drawn while deformed. Instanced and indirect draws of
+    /// a deformed mesh are tinted by the instance colors only.
+    /// @param data One influence per vertex
+    /// @param count Number of influences (must equal getNumVertices())
+    /// @return false if count does not match or the buffer could not be created
+    bool setBoneInfluences(const VboBoneInfluence* data, size_t count);
+
+    /// Set the skinning matrices (bone global transform times inverse bind pose)
+    /// @param matrices One matrix per bone, indexed by VboBoneInfluence::bones
+    /// @param count Number of bones
+    void setBoneMatrices(const simd_float4x4* matrices, size_t count);
+
+    /// Set the skinning matrices from ofMatrix4x4
+    void setBoneMatrices(const std::vector<ofMatrix4x4>& matrices);
+
+    /// Add a morph target (blend shape) as offsets from the vertices
+    /// Targets start with weight 0; each costs 24 bytes per vertex of GPU memory.
+    /// @param positionDeltas Position offset per vertex
+    /// @param normalDeltas Normal offset per vertex, or nullptr to leave normals
+    /// @param count Number of offsets (must equal getNumVertices())
+    /// @return The target's index, or SIZE_MAX if count does not match
+    size_t addMorphTarget(const ofVec3f* positionDeltas, const ofVec3f* normalDeltas, size_t count);
+
+    /// Get the number of morph targets
+    size_t getNumMorphTargets() const;
+
+    /// Set how much of a morph target is applied (0 = none, 1 = full offsets)
+    void setMorphWeight(size_t target, float weight);
+
+    /// Set the weights of the first count morph targets
+    void setMorphWeights(const float* weights, size_t count);
+
+    /// Get a morph target's weight
+    float getMorphWeight(size_t target) const;
+
+    /// Remove the bone influences, bone matrices and morph targets
+    void clearDeformation();
+
+    /// Check if draws deform the mesh (influences or morph targets set)
+    /// Deformation data set for one vertex count is ignored, and dropped by
+    /// the next set call, once the mesh has a different count.
+    bool isDeformed() const;
+
     // ========================================================================
     // Instance Data (for Instanced Rendering)
     // ========================================================================
@@ -290,36 +383,118 @@ public:
     /// Returns native MTLBuffer handle
     void* getIndirectArgumentBuffer();
 
+    /// Frustum-cull the instances on the GPU for this frame's drawIndirect()
+    /// A compute pass tests each instance's bounding sphere against the current
+    /// view frustum and writes the survivors and their count for the next
+    /// drawIndirect() call. Visible instances are drawn in no particular order.
+    /// With ofEnableOcclusionCulling(), instances behind the depth the previous
+    /// frame drew are dropped too, once the mesh was culled in that frame.
+    /// @param boundingRadius Radius of the mesh's bounding sphere (mesh space)
+    /// @param boundingCenter Center of the mesh's bounding sphere (mesh space)
+    /// @return false if the mesh has no indices or instances, or compute is unavailable
+    bool cullInstances(float boundingRadius, const ofVec3f& boundingCenter = ofVec3f(0, 0, 0));
+
+    /// Frustum-cull the instances against the mesh's own bounding sphere
+    /// @return false if the mesh has no vertices, indices or instances, or compute is unavailable
+    bool cullInstances();
+
     // ========================================================================
     // Drawing
     // ========================================================================
 
     /// Draw the mesh
+    /// Skipped when its bounds lie outside the view (see ofEnableFrustumCulling());
+    /// draws the level of detail selectLod() picks when levels were added
     void draw() const;
 
     /// Draw with explicit primitive mode
     void draw(ofPrimitiveMode mode) const;
 
     /// Draw a range of vertices/indices
-    /// @param start First vertex/index
-    /// @param count Number of primitives
+    /// Drawn from the full mesh (no level of detail); wireframe draws the
+    /// edges of the range's triangles
+    /// @param start First index (first vertex when not indexed)
+    /// @param count Number of indices (vertices)
     void drawRange(size_t start, size_t count) const;
 
-    /// Draw instances
-    /// @param instanceCount Number of instances to draw
+    /// Enable depth testing and writing for this mesh's draws (default true)
+    /// Turn it off for flat artwork drawn in painter's order, whose
+    /// coplanar triangles would otherwise hide the ones drawn after them
+    void setDepthTest(bool enabled);
+
+    /// Check if this mesh's draws use depth testing
+    bool getDepthTest() const;
+
+    /// Draw instances in a single instanced draw call
+    /// Each instance applies its VboInstanceData transform and color tint
+    /// (see setInstances()) on top of the current matrix and color.
+    /// @param instanceCount Number of instances to draw (clamped to the instance count)
     void drawInstanced(size_t instanceCount) const;
 
     /// Draw instances with explicit primitive mode
     void drawInstanced(size_t instanceCount, ofPrimitiveMode mode) const;
 
     /// Indirect draw (arguments from GPU buffer)
+    /// Uses the cullInstances() results when culling ran this frame,
+    /// otherwise the arguments from setIndirectArguments().
     void drawIndirect() const;
 
     /// Indirect draw with external argument buffer
-    /// @param argumentBuffer MTLBuffer containing draw arguments
+    /// Requires indices; the instance count comes from the arguments and
+    /// instances read this mesh's instance data (see setInstances()).
+    /// @param argumentBuffer MTLBuffer containing VboIndirectArguments
     /// @param argumentOffset Byte offset to arguments in buffer
     void drawIndirect(void* argumentBuffer, size_t argumentOffset = 0) const;
 
+    /// Indirect draw with external arguments and instance data
+    /// For instances a kernel writes on the GPU (particles, simulations):
+    /// instanceBuffer holds VboInstanceData records, and the arguments'
+    /// instanceCount and baseInstance select the ones to draw. Both buffers
+    /// must outlive the frame.
+    /// @param argumentBuffer MTLBuffer containing VboIndirectArguments
+    /// @param argumentOffset Byte offset to arguments in buffer
+    /// @param instanceBuffer MTLBuffer of VboInstanceData, or nullptr for none
+    void drawIndirect(void* argumentBuffer, size_t argumentOffset, void* instanceBuffer) const;
+
+    // ========================================================================
+    // Level of Detail
+    // ========================================================================
+
+    /// Add a coarser level of detail
+    /// draw() uses the last added level whose maxScreenSize is larger than
+    /// the mesh's projected bounding-sphere diameter, so add levels from fine
+    /// to coarse with decreasing sizes. Levels are separate static meshes;
+    /// setMesh(), allocate(), load() and clear() drop them. Instanced and
+    /// indirect draws always use the full mesh.
+    /// @param mesh Geometry of the level
+    /// @param maxScreenSize Largest projected diameter in pixels drawn with this level
+    /// @return false if the level could not be created
+    bool addLod(const ofMesh& mesh, float maxScreenSize);
+
+    /// Generate levels by simplifying the mesh (see ofMesh::simplify())
+    /// Each level keeps ratio of the previous level's triangles and takes
+    /// over below half the previous level's screen size, starting at
+    /// screenSize. Replaces existing levels; requires a triangle mesh. Stops
+    /// early once a level no longer gets smaller.
+    /// @param levels Number of coarser levels
+    /// @param ratio Fraction of triangles each level keeps
+    /// @param screenSize Projected diameter in pixels below which level 1 draws
+    /// @return Number of levels generated
+    size_t generateLods(size_t levels = 3, float ratio = 0.5f, float screenSize = 256.0f);
+
+    /// Get the number of levels, including the full mesh (level 0)
+    size_t getNumLods() const;
+
+    /// Get the level draw() would use under the current matrices
+    size_t selectLod() const;
+
+    /// Scale projected sizes before selecting a level
+    /// @param bias Above 1 keeps finer levels longer, below 1 switches sooner
+    void setLodBias(float bias);
+
+    /// Remove all coarser levels
+    void clearLods();
+
     // ========================================================================
     // Information
     // ========================================================================
@@ -348,6 +523,20 @@ public:
     /// Check if mesh has colors
     bool hasColors() const;
 
+    /// Get the axis-aligned bounds of the vertices (cached until they change)
+    /// Computed from the CPU copy, or the mapped file for load(); vertices
+    /// written on the GPU through getVertexBuffer() are not seen.
+    /// @param min Receives the smallest x, y and z
+    /// @param max Receives the largest x, y and z
+    /// @return false (values unchanged) if the mesh has no vertices
+    bool getBounds(ofVec3f& min, ofVec3f& max) const;
+
+    /// Get the sphere enclosing the bounds
+    /// @param center Receives the center of the bounds
+    /// @param radius Receives half the bounds' diagonal
+    /// @return false (values unchanged) if the mesh has no vertices
+    bool getBoundingSphere(ofVec3f& center, float& radius) const;
+
     /// Get current storage mode
     VboStorageMode getStorageMode() const;
 
@@ -366,12 +555,21 @@ public:
     /// Get native Metal index buffer
     void* getIndexBuffer(uint32_t frameIndex = 0) const;
 
+    /// Get the index buffer element type (UInt16 when the mesh was sized for
+    /// at most 65535 vertices, halving index memory and bandwidth)
+    render::IndexType getIndexType() const;
+
     /// Get native Metal instance buffer
     void* getInstanceBuffer(uint32_t frameIndex = 0) const;
 
     /// Get vertex buffer offset (for interleaved attributes)
+    /// Nonzero for mapped meshes, whose buffer holds the whole file
     size_t getVertexBufferOffset() const;
 
+    /// Get the byte offset of the first index in the index buffer
+    /// Nonzero for mapped meshes (vertices and indices share one buffer)
+    size_t getIndexBufferOffset() const;
+
     /// Get stride between vertices
     size_t getVertexStride() const;
 
@@ -381,11 +579,14 @@ public:
 
     /// Create VboMesh from primitive (convenience)
     static VboMesh createPlane(float width, float height, int columns = 2, int rows = 2);
-    static VboMesh createSphere(float radius, int resolution = 20);
+    /// Curved primitives take lodLevels coarser levels of detail, each with
+    /// half the previous resolution (one subdivision less for icospheres),
+    /// switching below 256, 128, 64, ... pixels
+    static VboMesh createSphere(float radius, int resolution = 20, int lodLevels = 0);
     static VboMesh createBox(float width, float height, float depth);
-    static VboMesh createCone(float radius, float height, int segments = 20);
-    static VboMesh createCylinder(float radius, float height, int segments = 20);
-    static VboMesh createIcosphere(float radius, int subdivisions = 2);
+    static VboMesh createCone(float radius, float height, int segments = 20, int lodLevels = 0);
+    static VboMesh createCylinder(float radius, float height, int segments = 20, int lodLevels = 0);
+    static VboMesh createIcosphere(float radius, int subdivisions = 2, int lodLevels = 0);
 
 private:
     struct Impl;
@@ -394,6 +595,10 @@ private:
     // Internal helpers
     void markDirty();
     void uploadIfNeeded() const;
+    bool recordDraw(ofPrimitiveMode mode, render::DrawCommand3D& cmd) const;
+    bool recordState(ofPrimitiveMode mode, render::DrawCommand3D& cmd, bool& needsWireframe) const;
+    bool recordGeometry(render::DrawCommand3D& cmd, bool needsWireframe) const;
+    void drawGeometry(ofPrimitiveMode mode, size_t first, size_t count) const;
 };
 
 // ============================================================================
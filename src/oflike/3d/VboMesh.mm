@@ -5,20 +5,32 @@
 #import <simd/simd.h>
 #import <dispatch/dispatch.h>
 #include "VboMesh.h"
+#include "ResidentMesh.h"
+#include "MeshCache.h"
+#include "FrustumCulling.h"
 #include "../../core/Context.h"
 #include "../../render/metal/MetalRenderer.h"
 #include "../../render/DrawList.h"
-#include "../graphics/ofGraphics.h"  // For ofGetCurrentMatrix, ofGetColor, ofGetFill
+#include "../../render/metal/MetalAllocations.h"
+#include "../graphics/ofGraphics.h"  // For ofGetColor, ofGetFill
+#include "../graphics/ofGraphicsTransform.h"
 #include "../math/ofMatrix4x4.h"     // Full definition for ofMatrix4x4
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace oflike {
 
+using render::metal::makeTrackedBuffer;
+
 // ============================================================================
 // Constants
 // ============================================================================
 
 static constexpr uint32_t kMaxFramesInFlight = 3;
 static constexpr size_t kMinBufferSize = 4096;  // Minimum buffer allocation
+static constexpr float kLodScreenSize = 256.0f;  // Level 1 size for create*() levels
 
 // ============================================================================
 // Interleaved Vertex Structure
@@ -33,6 +45,56 @@ struct InterleavedVertex {
 
 // Note: Size may be larger due to alignment requirements
 
+// Resident copies and DrawList vertices reuse the interleaved records as is
+static_assert(sizeof(InterleavedVertex) == sizeof(render::Vertex3D),
+              "InterleavedVertex must match render::Vertex3D");
+
+// Instance records are read directly by the instanced vertex shaders
+static_assert(sizeof(VboInstanceData) == sizeof(render::InstanceData),
+              "VboInstanceData must match render::InstanceData");
+
+// Constants for the cullInstances kernel (matches CullUniforms in Culling.metal)
+struct CullUniforms {
+    simd_float4x4 modelViewProjection;
+    simd_float4 boundingSphere;
+    uint32_t instanceCount;
+};
+
+static_assert(sizeof(CullUniforms) <= render::DispatchComputeCommand::kMaxConstantsSize,
+              "CullUniforms must fit in DispatchComputeCommand::constants");
+
+// Occlusion test of cullInstancesOcclusion (matches OcclusionUniforms in Culling.metal)
+struct OcclusionUniforms {
+    simd_float4x4 modelViewProjection;
+    uint32_t levelCount;
+};
+
+// Per-vertex skinning record of the deformVertices kernel (matches BoneInfluence
+// in Skinning.metal): weights are unorm16 so a vertex costs 16 bytes
+struct GpuBoneInfluence {
+    uint16_t bones[4];
+    uint16_t weights[4];
+};
+
+// One vertex's offsets in one morph target (matches MorphDelta in Skinning.metal)
+struct GpuMorphDelta {
+    float position[3];
+    float normal[3];
+};
+
+// A morph target the pass applies (matches MorphWeight in Skinning.metal)
+struct GpuMorphWeight {
+    uint32_t target;
+    float weight;
+};
+
+// Constants for the deformVertices kernel (matches DeformUniforms in Skinning.metal)
+struct DeformUniforms {
+    uint32_t vertexCount;
+    uint32_t boneCount;
+    uint32_t morphCount;
+};
+
 // ============================================================================
 // VboMesh Implementation
 // ============================================================================
@@ -76,6 +138,13 @@ struct VboMesh::Impl {
     // Indirect draw argument buffer
     id<MTLBuffer> indirectArgumentBuffer = nil;
 
+    // GPU culling output (per frame: compacted instances + indirect arguments)
+    id<MTLBuffer> visibleInstanceBuffers[kMaxFramesInFlight] = {nil, nil, nil};
+    id<MTLBuffer> culledArgumentBuffers[kMaxFramesInFlight] = {nil, nil, nil};
+    unsigned long long culledFrameNum = ~0ull;  // Frame the culled results belong to
+    id<MTLBuffer> occlusionUniformBuffers[kMaxFramesInFlight] = {nil, nil, nil};
+    simd_float4x4 culledViewProjection = matrix_identity_float4x4;  // Of culledFrameNum
+
     // Dirty flags for lazy upload
     bool dirty = false;
     uint32_t dirtyFrameMask = 0;  // Bitmask of frames that need update
@@ -83,8 +152,49 @@ struct VboMesh::Impl {
     // CPU-side data (for managed/shared modes)
     std::vector<InterleavedVertex> cpuVertices;
     std::vector<uint32_t> cpuIndices;
+    std::vector<uint16_t> narrowIndices;  // Upload scratch for 16-bit index buffers
     std::vector<VboInstanceData> cpuInstances;
 
+    // GPU index element type; 16-bit whenever maxVertices fits
+    render::IndexType indexType = render::IndexType::UInt32;
+
+    // Copy drawn by draw() while the geometry is unchanged
+    ResidentMesh resident;
+
+    // Mapped .oflmesh file (see load()): vertexBuffers[0] wraps the whole
+    // file and the resident copy draws from it; there is no CPU copy
+    bool mapped = false;
+    size_t vertexByteOffset = 0;
+    size_t indexByteOffset = 0;
+
+    // Coarser levels of detail, fine to coarse (see addLod())
+    struct LodLevel {
+        std::unique_ptr<VboMesh> mesh;
+        float maxScreenSize;
+    };
+    std::vector<LodLevel> lods;
+    float lodBias = 1.0f;
+
+    // Depth test and write for draws (see setDepthTest())
+    bool depthTest = true;
+
+    // GPU deformation (see setBoneInfluences()): rest vertices are morphed
+    // and skinned once per frame into deformedBuffers[frame]
+    id<MTLBuffer> influenceBuffer = nil;
+    std::vector<GpuMorphDelta> cpuMorphDeltas;          // Target by target
+    id<MTLBuffer> morphBuffer = nil;                    // Rebuilt when targets are added
+    std::vector<float> morphWeights;
+    std::vector<simd_float4x4> boneMatrices;
+    size_t deformVertexCount = 0;                       // Vertex count the data was set for
+    id<MTLBuffer> poseBuffers[kMaxFramesInFlight] = {nil, nil, nil};      // Bones, then morph weights
+    id<MTLBuffer> deformedBuffers[kMaxFramesInFlight] = {nil, nil, nil};
+    unsigned long long deformedFrameNum = ~0ull;        // Frame the deformed copy belongs to
+
+    // getBounds() result and the resident version it was computed for
+    ofVec3f boundsMin;
+    ofVec3f boundsMax;
+    uint64_t boundsVersion = 0;
+
     // Frame synchronization
     dispatch_semaphore_t frameSemaphore = nullptr;
     uint32_t currentFrameIndex = 0;
@@ -132,8 +242,13 @@ struct VboMesh::Impl {
             texCoordBuffers[i] = nil;
             colorBuffers[i] = nil;
             instanceBuffers[i] = nil;
+            visibleInstanceBuffers[i] = nil;
+            culledArgumentBuffers[i] = nil;
+            occlusionUniformBuffers[i] = nil;
         }
         indirectArgumentBuffer = nil;
+        culledFrameNum = ~0ull;
+        clearDeformation();
 
         cpuVertices.clear();
         cpuIndices.clear();
@@ -147,6 +262,200 @@ struct VboMesh::Impl {
         maxInstances = 0;
         dirty = false;
         dirtyFrameMask = 0;
+        resident.clear();
+        mapped = false;
+        vertexByteOffset = 0;
+        indexByteOffset = 0;
+        lods.clear();
+    }
+
+    void clearDeformation() {
+        for (uint32_t i = 0; i < kMaxFramesInFlight; i++) {
+            poseBuffers[i] = nil;
+            deformedBuffers[i] = nil;
+        }
+        influenceBuffer = nil;
+        morphBuffer = nil;
+        cpuMorphDeltas.clear();
+        morphWeights.clear();
+        boneMatrices.clear();
+        deformVertexCount = 0;
+        deformedFrameNum = ~0ull;
+    }
+
+    /// Influences or morph targets set for the current geometry
+    bool isDeformed() const {
+        return numVertices > 0 && deformVertexCount == numVertices &&
+               (influenceBuffer != nil || !morphWeights.empty());
+    }
+
+    /// Start deformation data for the current vertex count, dropping data
+    /// set for a different one
+    void beginDeformation() {
+        if (deformVertexCount != numVertices) {
+            clearDeformation();
+            deformVertexCount = numVertices;
+        }
+    }
+
+    /// This frame's deformed vertices, recording the deformation pass at the
+    /// frame's first draw; nil if the pass cannot run (draw the rest pose)
+    id<MTLBuffer> deformedVertices() {
+        if (!isDeformed() || !ensureDevice()) return nil;
+
+        auto& ctx = Context::instance();
+        auto renderer = ctx.renderer();
+        if (!renderer) return nil;
+
+        const uint32_t frameIndex = renderer->getCurrentFrameIndex() % kMaxFramesInFlight;
+        const unsigned long long frameNum = ctx.getFrameNum();
+        if (deformedFrameNum == frameNum) return deformedBuffers[frameIndex];
+
+        void* pipeline = renderer->getComputePipelineState("deformVertices");
+        if (!pipeline) return nil;
+
+        // The pass reads the resident copy (or the mapped file) as the rest pose
+        if (!mapped && !resident.isCurrent() &&
+            !resident.upload(reinterpret_cast<const render::Vertex3D*>(cpuVertices.data()),
+                             numVertices, cpuIndices.data(), numIndices)) {
+            return nil;
+        }
+        render::DrawCommand3D rest;
+        if (!resident.fill(rest, false)) return nil;
+
+        const size_t vertexBytes = numVertices * sizeof(InterleavedVertex);
+        id<MTLBuffer>& deformed = deformedBuffers[frameIndex];
+        if (!deformed || deformed.length < vertexBytes) {
+            deformed = makeTrackedBuffer(device, vertexBytes, MTLResourceStorageModePrivate,
+                                         ofGpuMemoryCategory::Meshes, "VboMesh Deformed");
+            if (!deformed) return nil;
+        }
+
+        if (!morphBuffer && !cpuMorphDeltas.empty()) {
+            morphBuffer = makeTrackedBuffer(device, cpuMorphDeltas.data(),
+                                            cpuMorphDeltas.size() * sizeof(GpuMorphDelta),
+                                            MTLResourceStorageModeShared,
+                                            ofGpuMemoryCategory::Meshes, "VboMesh Morph Targets");
+            if (!morphBuffer) return nil;
+        }
+
+        // Only the pose changes per frame: bone matrices, then the targets in use
+        const size_t boneCount = influenceBuffer ? boneMatrices.size() : 0;
+        std::vector<GpuMorphWeight> morphs;
+        for (size_t i = 0; i < morphWeights.size(); i++) {
+            if (morphWeights[i] != 0.0f) {
+                morphs.push_back({static_cast<uint32_t>(i), morphWeights[i]});
+            }
+        }
+        const size_t boneBytes = boneCount * sizeof(simd_float4x4);
+        const size_t poseBytes = std::max(boneBytes + morphs.size() * sizeof(GpuMorphWeight), kMinBufferSize);
+        id<MTLBuffer>& pose = poseBuffers[frameIndex];
+        if (!pose || pose.length < poseBytes) {
+            pose = makeTrackedBuffer(device, poseBytes, MTLResourceStorageModeShared,
+                                     ofGpuMemoryCategory::Meshes, "VboMesh Pose");
+            if (!pose) return nil;
+        }
+        uint8_t* poseContents = static_cast<uint8_t*>([pose contents]);
+        if (boneBytes > 0) memcpy(poseContents, boneMatrices.data(), boneBytes);
+        if (!morphs.empty()) memcpy(poseContents + boneBytes, morphs.data(), morphs.size() * sizeof(GpuMorphWeight));
+
+        DeformUniforms uniforms;
+        uniforms.vertexCount = static_cast<uint32_t>(numVertices);
+        uniforms.boneCount = static_cast<uint32_t>(boneCount);
+        uniforms.morphCount = static_cast<uint32_t>(morphs.size());
+
+        // Unused inputs are bound to the rest buffer; the kernel never reads them
+        void* restBuffer = rest.vertexBuffer;
+        render::DispatchComputeCommand cmd;
+        cmd.pipelineState = pipeline;
+        cmd.buffers[0] = restBuffer;
+        cmd.bufferOffsets[0] = rest.vertexOffset * sizeof(InterleavedVertex);
+        cmd.buffers[1] = (__bridge void*)deformed;
+        cmd.buffers[2] = influenceBuffer ? (__bridge void*)influenceBuffer : restBuffer;
+        cmd.buffers[3] = (__bridge void*)pose;
+        cmd.buffers[4] = morphBuffer ? (__bridge void*)morphBuffer : restBuffer;
+        cmd.buffers[5] = (__bridge void*)pose;
+        cmd.bufferOffsets[5] = boneBytes;
+        cmd.bufferCount = 6;
+        cmd.threadCount = uniforms.vertexCount;
+        cmd.constantsSize = sizeof(DeformUniforms);
+        memcpy(cmd.constants, &uniforms, sizeof(DeformUniforms));
+        ctx.getDrawList().addCommand(cmd);
+
+        deformedFrameNum = frameNum;
+        return deformed;
+    }
+
+    /// Copy the geometry (CPU copy or mapped file) into an ofMesh
+    void copyToMesh(ofMesh& mesh) const {
+        const InterleavedVertex* vertices = cpuVertices.data();
+        const uint8_t* contents = nullptr;
+        if (mapped) {
+            contents = static_cast<const uint8_t*>([vertexBuffers[0] contents]);
+            vertices = reinterpret_cast<const InterleavedVertex*>(contents + vertexByteOffset);
+        }
+        const size_t count = mapped ? numVertices : std::min(numVertices, cpuVertices.size());
+
+        mesh.clear();
+        mesh.setMode(primitiveMode);
+        for (size_t i = 0; i < count; i++) {
+            const InterleavedVertex& v = vertices[i];
+            mesh.addVertex(ofVec3f(v.position.x, v.position.y, v.position.z));
+            if (hasNormals_) mesh.addNormal(ofVec3f(v.normal.x, v.normal.y, v.normal.z));
+            if (hasTexCoords_) mesh.addTexCoord(ofVec2f(v.texCoord.x, v.texCoord.y));
+            if (hasColors_) {
+                mesh.addColor(ofColor(static_cast<uint8_t>(v.color.x * 255.0f + 0.5f),
+                                      static_cast<uint8_t>(v.color.y * 255.0f + 0.5f),
+                                      static_cast<uint8_t>(v.color.z * 255.0f + 0.5f),
+                                      static_cast<uint8_t>(v.color.w * 255.0f + 0.5f)));
+            }
+        }
+
+        if (mapped && indexType == render::IndexType::UInt16) {
+            const uint16_t* indices = reinterpret_cast<const uint16_t*>(contents + indexByteOffset);
+            for (size_t i = 0; i < numIndices; i++) mesh.addIndex(indices[i]);
+        } else if (mapped) {
+            const uint32_t* indices = reinterpret_cast<const uint32_t*>(contents + indexByteOffset);
+            mesh.addIndices(indices, numIndices);
+        } else {
+            mesh.addIndices(cpuIndices.data(), std::min(numIndices, cpuIndices.size()));
+        }
+    }
+
+    // ========================================================================
+    // Mapped Files
+    // ========================================================================
+
+    /// Drop the mapped file before new geometry replaces it
+    void releaseMapping() {
+        if (!mapped) return;
+        vertexBuffers[0] = nil;
+        indexBuffers[0] = nil;
+        vertexByteOffset = 0;
+        indexByteOffset = 0;
+        mapped = false;
+        resident.clear();
+    }
+
+    /// Copy a mapped mesh into CPU data and regular buffers before it changes
+    void detachMapping() {
+        if (!mapped) return;
+
+        const uint8_t* contents = static_cast<const uint8_t*>([vertexBuffers[0] contents]);
+        const InterleavedVertex* vertices = reinterpret_cast<const InterleavedVertex*>(contents + vertexByteOffset);
+        cpuVertices.assign(vertices, vertices + numVertices);
+        cpuIndices.resize(numIndices);
+        if (indexType == render::IndexType::UInt16) {
+            const uint16_t* indices = reinterpret_cast<const uint16_t*>(contents + indexByteOffset);
+            std::copy(indices, indices + numIndices, cpuIndices.begin());
+        } else if (numIndices > 0) {
+            memcpy(cpuIndices.data(), contents + indexByteOffset, numIndices * sizeof(uint32_t));
+        }
+
+        releaseMapping();
+        createBuffers(numVertices, numIndices);
+        dirty = true;
+        dirtyFrameMask = (1 << kMaxFramesInFlight) - 1;
     }
 
     // ========================================================================
@@ -200,6 +509,7 @@ struct VboMesh::Impl {
 
         maxVertices = vertexCount;
         maxIndices = indexCount;
+        indexType = render::indexTypeForVertexCount(maxVertices);
 
         MTLResourceOptions options = getResourceOptions();
         bool usePrivate = isPrivateStorage();
@@ -214,11 +524,12 @@ struct VboMesh::Impl {
             for (uint32_t i = 0; i < numBuffers; i++) {
                 if (usePrivate) {
                     // Private storage: need staging buffer for upload
-                    vertexBuffers[i] = [device newBufferWithLength:vertexBufferSize
-                                                           options:MTLResourceStorageModePrivate];
+                    vertexBuffers[i] = makeTrackedBuffer(device, vertexBufferSize,
+                                                         MTLResourceStorageModePrivate,
+                                                         ofGpuMemoryCategory::Meshes, "VboMesh Vertex");
                 } else {
-                    vertexBuffers[i] = [device newBufferWithLength:vertexBufferSize
-                                                           options:options];
+                    vertexBuffers[i] = makeTrackedBuffer(device, vertexBufferSize, options,
+                                                         ofGpuMemoryCategory::Meshes, "VboMesh Vertex");
                 }
                 if (!vertexBuffers[i]) return false;
                 vertexBuffers[i].label = [NSString stringWithFormat:@"VboMesh Vertex %u", i];
@@ -231,10 +542,14 @@ struct VboMesh::Impl {
             size_t colSize = std::max(maxVertices * sizeof(simd_float4), kMinBufferSize);
 
             for (uint32_t i = 0; i < numBuffers; i++) {
-                positionBuffers[i] = [device newBufferWithLength:posSize options:options];
-                normalBuffers[i] = [device newBufferWithLength:normSize options:options];
-                texCoordBuffers[i] = [device newBufferWithLength:texSize options:options];
-                colorBuffers[i] = [device newBufferWithLength:colSize options:options];
+                positionBuffers[i] = makeTrackedBuffer(device, posSize, options, ofGpuMemoryCategory::Meshes,
+                                                       "VboMesh Position");
+                normalBuffers[i] = makeTrackedBuffer(device, normSize, options, ofGpuMemoryCategory::Meshes,
+                                                     "VboMesh Normal");
+                texCoordBuffers[i] = makeTrackedBuffer(device, texSize, options, ofGpuMemoryCategory::Meshes,
+                                                       "VboMesh TexCoord");
+                colorBuffers[i] = makeTrackedBuffer(device, colSize, options, ofGpuMemoryCategory::Meshes,
+                                                    "VboMesh Color");
 
                 if (!positionBuffers[i]) return false;
 
@@ -247,15 +562,16 @@ struct VboMesh::Impl {
 
         // Index buffer
         if (maxIndices > 0) {
-            size_t indexBufferSize = std::max(maxIndices * sizeof(uint32_t), kMinBufferSize);
+            size_t indexBufferSize = std::max(maxIndices * render::indexSize(indexType), kMinBufferSize);
 
             for (uint32_t i = 0; i < numBuffers; i++) {
                 if (usePrivate) {
-                    indexBuffers[i] = [device newBufferWithLength:indexBufferSize
-                                                          options:MTLResourceStorageModePrivate];
+                    indexBuffers[i] = makeTrackedBuffer(device, indexBufferSize,
+                                                        MTLResourceStorageModePrivate,
+                                                        ofGpuMemoryCategory::Meshes, "VboMesh Index");
                 } else {
-                    indexBuffers[i] = [device newBufferWithLength:indexBufferSize
-                                                          options:options];
+                    indexBuffers[i] = makeTrackedBuffer(device, indexBufferSize, options,
+                                                        ofGpuMemoryCategory::Meshes, "VboMesh Index");
                 }
                 if (!indexBuffers[i]) return false;
                 indexBuffers[i].label = [NSString stringWithFormat:@"VboMesh Index %u", i];
@@ -269,6 +585,18 @@ struct VboMesh::Impl {
     // Data Upload
     // ========================================================================
 
+    /// CPU indices in the GPU buffer's element type
+    const void* gpuIndexData() {
+        if (indexType == render::IndexType::UInt32) {
+            return cpuIndices.data();
+        }
+        narrowIndices.resize(cpuIndices.size());
+        for (size_t i = 0; i < cpuIndices.size(); i++) {
+            narrowIndices[i] = static_cast<uint16_t>(cpuIndices[i]);
+        }
+        return narrowIndices.data();
+    }
+
     void uploadToGPU(id<MTLCommandQueue> commandQueue, uint32_t frameIndex) {
         if (!dirty || cpuVertices.empty()) return;
         if (!ensureDevice()) return;
@@ -289,9 +617,10 @@ struct VboMesh::Impl {
 
                 // Create staging buffers
                 size_t vertexSize = cpuVertices.size() * sizeof(InterleavedVertex);
-                id<MTLBuffer> stagingVertex = [device newBufferWithBytes:cpuVertices.data()
-                                                                  length:vertexSize
-                                                                 options:MTLResourceStorageModeShared];
+                id<MTLBuffer> stagingVertex = makeTrackedBuffer(device, cpuVertices.data(), vertexSize,
+                                                                MTLResourceStorageModeShared,
+                                                                ofGpuMemoryCategory::Staging,
+                                                                "VboMesh Staging");
 
                 [blitEncoder copyFromBuffer:stagingVertex
                                sourceOffset:0
@@ -300,10 +629,11 @@ struct VboMesh::Impl {
                                        size:vertexSize];
 
                 if (!cpuIndices.empty() && indexBuffers[frameIndex]) {
-                    size_t indexSize = cpuIndices.size() * sizeof(uint32_t);
-                    id<MTLBuffer> stagingIndex = [device newBufferWithBytes:cpuIndices.data()
-                                                                     length:indexSize
-                                                                    options:MTLResourceStorageModeShared];
+                    size_t indexSize = cpuIndices.size() * render::indexSize(indexType);
+                    id<MTLBuffer> stagingIndex = makeTrackedBuffer(device, gpuIndexData(), indexSize,
+                                                                   MTLResourceStorageModeShared,
+                                                                   ofGpuMemoryCategory::Staging,
+                                                                   "VboMesh Staging");
 
                     [blitEncoder copyFromBuffer:stagingIndex
                                    sourceOffset:0
@@ -334,13 +664,12 @@ struct VboMesh::Impl {
             if (!cpuIndices.empty() && indexBuffers[frameIndex]) {
                 void* indexContents = [indexBuffers[frameIndex] contents];
                 if (indexContents) {
-                    memcpy(indexContents,
-                           cpuIndices.data(),
-                           cpuIndices.size() * sizeof(uint32_t));
+                    const size_t indexBytes = cpuIndices.size() * render::indexSize(indexType);
+                    memcpy(indexContents, gpuIndexData(), indexBytes);
 
                     if (storageMode == VboStorageMode::Managed ||
                         (storageMode == VboStorageMode::Auto && usageHint == VboUsageHint::Dynamic)) {
-                        [indexBuffers[frameIndex] didModifyRange:NSMakeRange(0, cpuIndices.size() * sizeof(uint32_t))];
+                        [indexBuffers[frameIndex] didModifyRange:NSMakeRange(0, indexBytes)];
                     }
                 }
             }
@@ -365,7 +694,8 @@ struct VboMesh::Impl {
         MTLResourceOptions options = MTLResourceStorageModeShared | MTLResourceCPUCacheModeWriteCombined;
 
         for (uint32_t i = 0; i < kMaxFramesInFlight; i++) {
-            instanceBuffers[i] = [device newBufferWithLength:bufferSize options:options];
+            instanceBuffers[i] = makeTrackedBuffer(device, bufferSize, options, ofGpuMemoryCategory::Meshes,
+                                                   "VboMesh Instance");
             if (!instanceBuffers[i]) return false;
             instanceBuffers[i].label = [NSString stringWithFormat:@"VboMesh Instance %u", i];
         }
@@ -388,11 +718,44 @@ struct VboMesh::Impl {
     bool createIndirectArgumentBuffer() {
         if (!ensureDevice()) return false;
 
-        indirectArgumentBuffer = [device newBufferWithLength:sizeof(VboIndirectArguments)
-                                                     options:MTLResourceStorageModeShared];
+        indirectArgumentBuffer = makeTrackedBuffer(device, sizeof(VboIndirectArguments),
+                                                   MTLResourceStorageModeShared, ofGpuMemoryCategory::Meshes,
+                                                   "VboMesh Indirect Arguments");
         if (!indirectArgumentBuffer) return false;
+        return true;
+    }
+
+    bool ensureCullingBuffers(uint32_t frameIndex) {
+        if (!ensureDevice()) return false;
+
+        // Sized for maxInstances so setInstances() growth reallocates
+        size_t visibleSize = std::max(maxInstances * sizeof(VboInstanceData), kMinBufferSize);
+        id<MTLBuffer> visible = visibleInstanceBuffers[frameIndex];
+        if (!visible || visible.length < visibleSize) {
+            visible = makeTrackedBuffer(device, visibleSize, MTLResourceStorageModePrivate,
+                                        ofGpuMemoryCategory::Meshes, "VboMesh Visible Instances");
+            if (!visible) return false;
+            visible.label = [NSString stringWithFormat:@"VboMesh Visible Instances %u", frameIndex];
+            visibleInstanceBuffers[frameIndex] = visible;
+        }
+
+        if (!culledArgumentBuffers[frameIndex]) {
+            id<MTLBuffer> args = makeTrackedBuffer(device, sizeof(VboIndirectArguments),
+                                                   MTLResourceStorageModeShared, ofGpuMemoryCategory::Meshes,
+                                                   "VboMesh Culled Arguments");
+            if (!args) return false;
+            args.label = [NSString stringWithFormat:@"VboMesh Culled Arguments %u", frameIndex];
+            culledArgumentBuffers[frameIndex] = args;
+        }
 
-        indirectArgumentBuffer.label = @"VboMesh Indirect Arguments";
+        if (!occlusionUniformBuffers[frameIndex]) {
+            id<MTLBuffer> occlusion = makeTrackedBuffer(device, sizeof(OcclusionUniforms),
+                                                        MTLResourceStorageModeShared, ofGpuMemoryCategory::Meshes,
+                                                        "VboMesh Occlusion Uniforms");
+            if (!occlusion) return false;
+            occlusion.label = [NSString stringWithFormat:@"VboMesh Occlusion Uniforms %u", frameIndex];
+            occlusionUniformBuffers[frameIndex] = occlusion;
+        }
         return true;
     }
 
@@ -420,6 +783,8 @@ VboMesh::VboMesh(VboMesh&& other) noexcept = default;
 VboMesh& VboMesh::operator=(VboMesh&& other) noexcept = default;
 
 bool VboMesh::setMesh(const ofMesh& mesh, VboUsageHint usage, VboAttributeLayout layout) {
+    impl_->releaseMapping();
+    impl_->lods.clear();
     impl_->usageHint = usage;
     impl_->layout = layout;
     impl_->primitiveMode = mesh.getMode();
@@ -472,6 +837,7 @@ bool VboMesh::setMesh(const ofMesh& mesh, VboUsageHint usage, VboAttributeLayout
     impl_->numIndices = indices.size();
 
     // Mark all frames as dirty
+    impl_->resident.invalidate();
     impl_->dirty = true;
     impl_->dirtyFrameMask = (1 << kMaxFramesInFlight) - 1;
 
@@ -484,6 +850,8 @@ bool VboMesh::setMesh(const ofMesh& mesh, VboUsageHint usage, VboAttributeLayout
 }
 
 bool VboMesh::allocate(size_t maxVertices, size_t maxIndices, VboUsageHint usage, VboAttributeLayout layout) {
+    impl_->releaseMapping();
+    impl_->lods.clear();
     impl_->usageHint = usage;
     impl_->layout = layout;
 
@@ -499,6 +867,95 @@ bool VboMesh::allocate(size_t maxVertices, size_t maxIndices, VboUsageHint usage
     return true;
 }
 
+bool VboMesh::load(const std::string& filename) {
+    if (!impl_->ensureDevice()) return false;
+    impl_->lods.clear();
+
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(MeshCacheHeader))) {
+        close(fd);
+        return false;
+    }
+
+    // No-copy buffers must span whole pages; the tail of the last page reads as zeros
+    const size_t fileSize = static_cast<size_t>(info.st_size);
+    const size_t pageSize = static_cast<size_t>(getpagesize());
+    const size_t length = (fileSize + pageSize - 1) / pageSize * pageSize;
+    void* data = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+
+    MeshCacheHeader header;
+    memcpy(&header, data, sizeof(header));
+    bool valid = isValidMeshCache(header, fileSize) && header.vertexCount > 0 &&
+                 header.vertexCount <= UINT32_MAX && header.indexCount <= UINT32_MAX;
+
+    // A damaged file must not send the GPU outside the vertex records
+    const uint8_t* indexData = static_cast<const uint8_t*>(data) + header.indexOffset;
+    for (uint64_t i = 0; valid && i < header.indexCount; i++) {
+        const uint32_t index = header.indexSize == 2 ? reinterpret_cast<const uint16_t*>(indexData)[i]
+                                                     : reinterpret_cast<const uint32_t*>(indexData)[i];
+        valid = index < header.vertexCount;
+    }
+    if (!valid) {
+        munmap(data, length);
+        return false;
+    }
+
+    id<MTLBuffer> buffer = [impl_->device newBufferWithBytesNoCopy:data
+                                                            length:length
+                                                           options:MTLResourceStorageModeShared
+                                                       deallocator:^(void* pointer, NSUInteger bytes) {
+                                                           munmap(pointer, bytes);
+                                                       }];
+    if (!buffer) {
+        munmap(data, length);
+        return false;
+    }
+    render::metal::trackResource(buffer, ofGpuMemoryCategory::Meshes, "VboMesh Mapped");
+
+    // Replace the geometry; instances and indirect arguments are kept
+    impl_->releaseMapping();
+    for (uint32_t i = 0; i < kMaxFramesInFlight; i++) {
+        impl_->vertexBuffers[i] = nil;
+        impl_->indexBuffers[i] = nil;
+        impl_->positionBuffers[i] = nil;
+        impl_->normalBuffers[i] = nil;
+        impl_->texCoordBuffers[i] = nil;
+        impl_->colorBuffers[i] = nil;
+    }
+    impl_->cpuVertices.clear();
+    impl_->cpuIndices.clear();
+    impl_->dirty = false;
+    impl_->dirtyFrameMask = 0;
+
+    impl_->usageHint = VboUsageHint::Static;
+    impl_->layout = VboAttributeLayout::Interleaved;
+    impl_->primitiveMode = static_cast<ofPrimitiveMode>(header.primitiveMode);
+    impl_->hasNormals_ = header.attributes & kMeshCacheNormals;
+    impl_->hasTexCoords_ = header.attributes & kMeshCacheTexCoords;
+    impl_->hasColors_ = header.attributes & kMeshCacheColors;
+    impl_->numVertices = impl_->maxVertices = static_cast<size_t>(header.vertexCount);
+    impl_->numIndices = impl_->maxIndices = static_cast<size_t>(header.indexCount);
+    impl_->indexType = header.indexSize == 2 ? render::IndexType::UInt16 : render::IndexType::UInt32;
+
+    impl_->vertexBuffers[0] = buffer;
+    impl_->indexBuffers[0] = header.indexCount > 0 ? buffer : nil;
+    impl_->vertexByteOffset = static_cast<size_t>(header.vertexOffset);
+    impl_->indexByteOffset = static_cast<size_t>(header.indexOffset);
+    impl_->mapped = true;
+
+    const size_t indexStart = header.indexCount > 0 ? impl_->indexByteOffset / header.indexSize : 0;
+    return impl_->resident.adopt((__bridge void*)buffer, impl_->vertexByteOffset / sizeof(InterleavedVertex),
+                                 impl_->numVertices, indexStart, impl_->numIndices, impl_->indexType);
+}
+
+bool VboMesh::isMapped() const {
+    return impl_->mapped;
+}
+
 void VboMesh::setStorageMode(VboStorageMode mode) {
     impl_->storageMode = mode;
 }
@@ -523,6 +980,7 @@ void VboMesh::updateMesh(const ofMesh& mesh) {
         setMesh(mesh, impl_->usageHint, impl_->layout);
         return;
     }
+    impl_->detachMapping();
 
     // Update CPU data
     impl_->cpuVertices.resize(vertices.size());
@@ -553,6 +1011,7 @@ void VboMesh::updateMesh(const ofMesh& mesh) {
 }
 
 void VboMesh::updateVertices(const ofVec3f* data, size_t count, size_t offset) {
+    impl_->detachMapping();
     size_t oldSize = impl_->cpuVertices.size();
     if (offset + count > oldSize) {
         impl_->cpuVertices.resize(offset + count);
@@ -573,6 +1032,7 @@ void VboMesh::updateVertices(const ofVec3f* data, size_t count, size_t offset) {
 }
 
 void VboMesh::updateNormals(const ofVec3f* data, size_t count, size_t offset) {
+    impl_->detachMapping();
     for (size_t i = 0; i < count && (offset + i) < impl_->cpuVertices.size(); i++) {
         impl_->cpuVertices[offset + i].normal = simd_make_float3(data[i].x, data[i].y, data[i].z);
     }
@@ -581,6 +1041,7 @@ void VboMesh::updateNormals(const ofVec3f* data, size_t count, size_t offset) {
 }
 
 void VboMesh::updateTexCoords(const ofVec2f* data, size_t count, size_t offset) {
+    impl_->detachMapping();
     for (size_t i = 0; i < count && (offset + i) < impl_->cpuVertices.size(); i++) {
         impl_->cpuVertices[offset + i].texCoord = simd_make_float2(data[i].x, data[i].y);
     }
@@ -589,6 +1050,7 @@ void VboMesh::updateTexCoords(const ofVec2f* data, size_t count, size_t offset)
 }
 
 void VboMesh::updateColors(const ofColor* data, size_t count, size_t offset) {
+    impl_->detachMapping();
     for (size_t i = 0; i < count && (offset + i) < impl_->cpuVertices.size(); i++) {
         impl_->cpuVertices[offset + i].color = simd_make_float4(
             data[i].r / 255.0f, data[i].g / 255.0f,
@@ -599,6 +1061,7 @@ void VboMesh::updateColors(const ofColor* data, size_t count, size_t offset) {
 }
 
 void VboMesh::updateIndices(const uint32_t* data, size_t count, size_t offset) {
+    impl_->detachMapping();
     if (offset + count > impl_->cpuIndices.size()) {
         impl_->cpuIndices.resize(offset + count);
     }
@@ -609,11 +1072,15 @@ void VboMesh::updateIndices(const uint32_t* data, size_t count, size_t offset) {
 }
 
 void VboMesh::setVertexCount(size_t count) {
+    impl_->detachMapping();
     impl_->numVertices = std::min(count, impl_->maxVertices);
+    impl_->resident.invalidate();
 }
 
 void VboMesh::setIndexCount(size_t count) {
+    impl_->detachMapping();
     impl_->numIndices = std::min(count, impl_->maxIndices);
+    impl_->resident.invalidate();
 }
 
 void VboMesh::sync() {
@@ -625,11 +1092,95 @@ void VboMesh::sync() {
             [impl_->vertexBuffers[i] didModifyRange:NSMakeRange(0, impl_->numVertices * sizeof(InterleavedVertex))];
         }
         if (impl_->indexBuffers[i] && impl_->numIndices > 0) {
-            [impl_->indexBuffers[i] didModifyRange:NSMakeRange(0, impl_->numIndices * sizeof(uint32_t))];
+            [impl_->indexBuffers[i] didModifyRange:NSMakeRange(0, impl_->numIndices * render::indexSize(impl_->indexType))];
         }
     }
 }
 
+// ============================================================================
+// GPU Deformation
+// ============================================================================
+
+bool VboMesh::setBoneInfluences(const VboBoneInfluence* data, size_t count) {
+    if (!data || count == 0 || count != impl_->numVertices || !impl_->ensureDevice()) return false;
+
+    // Normalized and quantized once; draws only upload the matrices
+    std::vector<GpuBoneInfluence> influences(count);
+    for (size_t i = 0; i < count; i++) {
+        float total = 0.0f;
+        for (int j = 0; j < 4; j++) total += std::max(data[i].weights[j], 0.0f);
+        for (int j = 0; j < 4; j++) {
+            const float weight = total > 0.0f ? std::max(data[i].weights[j], 0.0f) / total : (j == 0 ? 1.0f : 0.0f);
+            influences[i].bones[j] = data[i].bones[j];
+            influences[i].weights[j] = static_cast<uint16_t>(weight * 65535.0f + 0.5f);
+        }
+    }
+
+    id<MTLBuffer> buffer = makeTrackedBuffer(impl_->device, influences.data(), count * sizeof(GpuBoneInfluence),
+                                             MTLResourceStorageModeShared,
+                                             ofGpuMemoryCategory::Meshes, "VboMesh Bone Influences");
+    if (!buffer) return false;
+
+    impl_->beginDeformation();
+    impl_->influenceBuffer = buffer;
+    return true;
+}
+
+void VboMesh::setBoneMatrices(const simd_float4x4* matrices, size_t count) {
+    impl_->boneMatrices.assign(matrices, matrices + count);
+}
+
+void VboMesh::setBoneMatrices(const std::vector<ofMatrix4x4>& matrices) {
+    impl_->boneMatrices.resize(matrices.size());
+    for (size_t i = 0; i < matrices.size(); i++) {
+        impl_->boneMatrices[i] = matrices[i];
+    }
+}
+
+size_t VboMesh::addMorphTarget(const ofVec3f* positionDeltas, const ofVec3f* normalDeltas, size_t count) {
+    if (!positionDeltas || count == 0 || count != impl_->numVertices) return SIZE_MAX;
+
+    impl_->beginDeformation();
+    std::vector<GpuMorphDelta>& deltas = impl_->cpuMorphDeltas;
+    const size_t start = deltas.size();
+    deltas.resize(start + count);
+    for (size_t i = 0; i < count; i++) {
+        const ofVec3f& p = positionDeltas[i];
+        const ofVec3f n = normalDeltas ? normalDeltas[i] : ofVec3f(0, 0, 0);
+        deltas[start + i] = {{p.x, p.y, p.z}, {n.x, n.y, n.z}};
+    }
+    impl_->morphBuffer = nil;
+    impl_->morphWeights.push_back(0.0f);
+    return impl_->morphWeights.size() - 1;
+}
+
+size_t VboMesh::getNumMorphTargets() const {
+    return impl_->morphWeights.size();
+}
+
+void VboMesh::setMorphWeight(size_t target, float weight) {
+    if (target < impl_->morphWeights.size()) {
+        impl_->morphWeights[target] = weight;
+    }
+}
+
+void VboMesh::setMorphWeights(const float* weights, size_t count) {
+    count = std::min(count, impl_->morphWeights.size());
+    std::copy(weights, weights + count, impl_->morphWeights.begin());
+}
+
+float VboMesh::getMorphWeight(size_t target) const {
+    return target < impl_->morphWeights.size() ? impl_->morphWeights[target] : 0.0f;
+}
+
+void VboMesh::clearDeformation() {
+    impl_->clearDeformation();
+}
+
+bool VboMesh::isDeformed() const {
+    return impl_->isDeformed();
+}
+
 void VboMesh::setInstances(const VboInstanceData* data, size_t count) {
     if (count > impl_->maxInstances) {
         impl_->createInstanceBuffers(count);
@@ -672,24 +1223,158 @@ void* VboMesh::getIndirectArgumentBuffer() {
     return (__bridge void*)impl_->indirectArgumentBuffer;
 }
 
+bool VboMesh::cullInstances(float boundingRadius, const ofVec3f& boundingCenter) {
+    if (impl_->numIndices == 0 || impl_->numInstances == 0) return false;
+
+    auto& ctx = Context::instance();
+    auto renderer = ctx.renderer();
+    if (!renderer) return false;
+
+    // Occlusion needs last frame's pyramid and the matrices it was drawn with
+    const unsigned long long frameNum = ctx.getFrameNum();
+    void* pyramid = renderer->getOcclusionPyramid();
+    void* occlusionPipeline = pyramid && impl_->culledFrameNum + 1 == frameNum
+                                  ? renderer->getComputePipelineState("cullInstancesOcclusion")
+                                  : nullptr;
+    void* pipeline = occlusionPipeline ? occlusionPipeline : renderer->getComputePipelineState("cullInstances");
+    if (!pipeline) return false;
+
+    uint32_t frameIndex = renderer->getCurrentFrameIndex() % kMaxFramesInFlight;
+    id<MTLBuffer> instanceBuffer = impl_->instanceBuffers[frameIndex];
+    if (!instanceBuffer || !impl_->ensureCullingBuffers(frameIndex)) return false;
+
+    // The kernel counts survivors into instanceCount; everything else is fixed
+    VboIndirectArguments args = {};
+    args.indexCount = static_cast<uint32_t>(impl_->numIndices);
+    id<MTLBuffer> argumentBuffer = impl_->culledArgumentBuffers[frameIndex];
+    memcpy([argumentBuffer contents], &args, sizeof(VboIndirectArguments));
+
+    // Same transform recordDraw() uses, so culling matches what is drawn
+    simd_float4x4 modelMatrix = ofGetCurrentModelMatrix();
+
+    const simd_float4x4 viewProjection = simd_mul(ctx.getProjectionMatrix(), ctx.getViewMatrix());
+
+    CullUniforms uniforms;
+    uniforms.modelViewProjection = simd_mul(viewProjection, modelMatrix);
+    uniforms.boundingSphere = simd_make_float4(boundingCenter.x, boundingCenter.y,
+                                               boundingCenter.z, boundingRadius);
+    uniforms.instanceCount = static_cast<uint32_t>(impl_->numInstances);
+
+    render::DispatchComputeCommand cmd;
+    cmd.pipelineState = pipeline;
+    cmd.buffers[0] = (__bridge void*)instanceBuffer;
+    cmd.buffers[1] = (__bridge void*)impl_->visibleInstanceBuffers[frameIndex];
+    cmd.buffers[2] = (__bridge void*)argumentBuffer;
+    cmd.bufferCount = 3;
+    if (occlusionPipeline) {
+        // The current model matrix with last frame's view, so a moving
+        // camera tests against where the pyramid's depth was drawn
+        id<MTLTexture> pyramidTexture = (__bridge id<MTLTexture>)pyramid;
+        OcclusionUniforms occlusion;
+        occlusion.modelViewProjection = simd_mul(impl_->culledViewProjection, modelMatrix);
+        occlusion.levelCount = static_cast<uint32_t>(pyramidTexture.mipmapLevelCount);
+        id<MTLBuffer> occlusionBuffer = impl_->occlusionUniformBuffers[frameIndex];
+        memcpy([occlusionBuffer contents], &occlusion, sizeof(OcclusionUniforms));
+
+        cmd.buffers[3] = (__bridge void*)occlusionBuffer;
+        cmd.bufferCount = 4;
+        cmd.textures[0] = pyramid;
+        cmd.textureCount = 1;
+    }
+    cmd.threadCount = uniforms.instanceCount;
+    cmd.constantsSize = sizeof(CullUniforms);
+    memcpy(cmd.constants, &uniforms, sizeof(CullUniforms));
+    ctx.getDrawList().addCommand(cmd);
+
+    impl_->culledFrameNum = frameNum;
+    impl_->culledViewProjection = viewProjection;
+    return true;
+}
+
+bool VboMesh::cullInstances() {
+    ofVec3f center;
+    float radius = 0.0f;
+    if (!getBoundingSphere(center, radius)) return false;
+    return cullInstances(radius, center);
+}
+
 void VboMesh::draw() const {
     draw(impl_->primitiveMode);
 }
 
 void VboMesh::draw(ofPrimitiveMode mode) const {
+    // Skip meshes entirely outside the view
+    ofVec3f boundsMin, boundsMax;
+    if (isFrustumCullingActive() && getBounds(boundsMin, boundsMax) && cullDraw(boundsMin, boundsMax)) {
+        return;
+    }
+
+    // Small on screen: draw a coarser level instead (levels are not deformed)
+    const size_t level = impl_->isDeformed() ? 0 : selectLod();
+    if (level > 0) {
+        impl_->lods[level - 1].mesh->draw(mode);
+        return;
+    }
+
+    drawGeometry(mode, 0, SIZE_MAX);
+}
+
+void VboMesh::drawGeometry(ofPrimitiveMode mode, size_t first, size_t count) const {
     uploadIfNeeded();
 
+    render::DrawCommand3D cmd;
+    bool wireframe = false;
+    if (!recordState(mode, cmd, wireframe)) return;
+
+    // Unchanged meshes draw from their resident copy; the tint becomes the
+    // instance color (see ResidentMesh.h)
+    uint8_t r, g, b, a;
+    ofGetColor(r, g, b, a);
+    const float tint[4] = {r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f};
+    auto& drawList = Context::instance().getDrawList();
+    ResidentMesh& resident = impl_->resident;
+    if (id<MTLBuffer> deformed = impl_->deformedVertices()) {
+        resident.record(drawList, cmd, wireframe, tint, first, count, (__bridge void*)deformed);
+        return;
+    }
+    if (impl_->mapped || resident.beginDraw(impl_->numVertices)) {
+        if (!resident.isCurrent() && !impl_->mapped) {
+            resident.upload(reinterpret_cast<const render::Vertex3D*>(impl_->cpuVertices.data()),
+                            impl_->numVertices, impl_->cpuIndices.data(), impl_->numIndices);
+        }
+        if (resident.record(drawList, cmd, wireframe, tint, first, count)) {
+            return;
+        }
+    }
+
+    if (recordGeometry(cmd, wireframe)) {
+        if (first != 0 || count != SIZE_MAX) {
+            ResidentMesh::narrow(cmd, first, count, wireframe);
+        }
+        drawList.addCommand(cmd);
+    }
+}
+
+bool VboMesh::recordDraw(ofPrimitiveMode mode, render::DrawCommand3D& cmd) const {
+    // Copies the (tinted) geometry into the current draw list and fills in
+    // everything but the command type; the caller adds the command
+    bool wireframe = false;
+    if (!recordState(mode, cmd, wireframe)) return false;
+    return recordGeometry(cmd, wireframe);
+}
+
+bool VboMesh::recordState(ofPrimitiveMode mode, render::DrawCommand3D& cmd, bool& needsWireframe) const {
     auto& ctx = Context::instance();
     auto renderer = ctx.renderer();
-    if (!renderer) return;
+    if (!renderer || impl_->numVertices == 0) return false;
 
     // Check fill mode
     bool fillEnabled = ofGetFill();
 
     // Determine if we need wireframe rendering
-    bool needsWireframe = !fillEnabled && (mode == OF_PRIMITIVE_TRIANGLES ||
-                                            mode == OF_PRIMITIVE_TRIANGLE_STRIP ||
-                                            mode == OF_PRIMITIVE_TRIANGLE_FAN);
+    needsWireframe = !fillEnabled && (mode == OF_PRIMITIVE_TRIANGLES ||
+                                      mode == OF_PRIMITIVE_TRIANGLE_STRIP ||
+                                      mode == OF_PRIMITIVE_TRIANGLE_FAN);
 
     // Convert primitive mode
     render::PrimitiveType primType;
@@ -717,6 +1402,42 @@ void VboMesh::draw(ofPrimitiveMode mode) const {
         }
     }
 
+    cmd.primitiveType = primType;
+    cmd.blendMode = render::BlendMode::Alpha;
+    cmd.texture = nullptr;
+
+    // ModelView = View * Model (cached by the matrix stack, see ofGraphicsTransform.h)
+    cmd.modelViewMatrix = ofGetCurrentModelViewMatrix();
+    cmd.projectionMatrix = ctx.getProjectionMatrix();
+
+    // Enable depth testing for 3D rendering
+    cmd.depthTestEnabled = impl_->depthTest;
+    cmd.depthWriteEnabled = impl_->depthTest;
+    cmd.cullBackFace = false;
+    cmd.orderIndependent = ofGetOrderIndependentTransparencyEnabled();
+    cmd.objectId = ofGetObjectId();
+
+    // Capture lighting state at command creation time
+    cmd.useLighting = ctx.hasMaterial() && ctx.isLightingEnabled();
+    if (cmd.useLighting) {
+        cmd.lightingHandle = ctx.getLightingStateHandle();
+        cmd.normalMatrix = ofGetCurrentNormalMatrix();  // Only lit draws use it
+    }
+
+    return true;
+}
+
+bool VboMesh::recordGeometry(render::DrawCommand3D& cmd, bool needsWireframe) const {
+    // Deformed vertices exist only on the GPU; draw them in place
+    if (id<MTLBuffer> deformed = impl_->deformedVertices()) {
+        return impl_->resident.fill(cmd, needsWireframe, (__bridge void*)deformed);
+    }
+
+    // Mapped meshes have no CPU copy to stream; draw the file in place
+    if (impl_->mapped) {
+        return impl_->resident.fill(cmd, needsWireframe);
+    }
+
     // Get current color from graphics state
     uint8_t r, g, b, a;
     ofGetColor(r, g, b, a);
@@ -740,7 +1461,7 @@ void VboMesh::draw(ofPrimitiveMode mode) const {
     }
 
     // Get the current draw list from Context
-    render::DrawList& drawList = ctx.getDrawList();
+    render::DrawList& drawList = Context::instance().getDrawList();
 
     // Add vertices to draw list
     uint32_t vertexOffset = drawList.addVertices3D(vertices);
@@ -778,73 +1499,87 @@ void VboMesh::draw(ofPrimitiveMode mode) const {
         indexCount = static_cast<uint32_t>(impl_->numIndices);
     }
 
-    // Create DrawCommand3D
-    render::DrawCommand3D cmd;
+    // Fill in the geometry
     cmd.vertexOffset = vertexOffset;
     cmd.vertexCount = static_cast<uint32_t>(vertices.size());
     cmd.indexOffset = indexOffset;
     cmd.indexCount = indexCount;
-    cmd.primitiveType = primType;
-    cmd.blendMode = render::BlendMode::Alpha;
-    cmd.texture = nullptr;
+    return true;
+}
+
+// ============================================================================
+// Level of Detail
+// ============================================================================
 
-    // Get view matrix from Context (set by camera)
-    simd_float4x4 viewMatrix = ctx.getViewMatrix();
+bool VboMesh::addLod(const ofMesh& mesh, float maxScreenSize) {
+    auto level = std::make_unique<VboMesh>();
+    if (!level->setMesh(mesh, VboUsageHint::Static)) return false;
+    impl_->lods.push_back({std::move(level), maxScreenSize});
+    return true;
+}
 
-    // Get model matrix from current transform stack (ofPushMatrix/ofTranslate/etc.)
-    ofMatrix4x4 m = ofGetCurrentMatrix();
-    simd_float4x4 modelMatrix = simd_matrix(
-        simd_make_float4(m(0,0), m(1,0), m(2,0), m(3,0)),
-        simd_make_float4(m(0,1), m(1,1), m(2,1), m(3,1)),
-        simd_make_float4(m(0,2), m(1,2), m(2,2), m(3,2)),
-        simd_make_float4(m(0,3), m(1,3), m(2,3), m(3,3))
-    );
+size_t VboMesh::generateLods(size_t levels, float ratio, float screenSize) {
+    impl_->lods.clear();
+    if (impl_->numVertices == 0 || impl_->primitiveMode != OF_PRIMITIVE_TRIANGLES) return 0;
+
+    ofMesh mesh;
+    impl_->copyToMesh(mesh);
+    size_t triangles = mesh.hasIndices() ? mesh.getNumIndices() / 3 : mesh.getNumVertices() / 3;
+    for (size_t i = 0; i < levels; i++) {
+        if (!mesh.simplify(ratio)) break;
+        const size_t simplified = mesh.getNumIndices() / 3;
+        if (simplified == 0 || simplified >= triangles) break;
+        triangles = simplified;
+        if (!addLod(mesh, screenSize / static_cast<float>(1u << i))) break;
+    }
+    return impl_->lods.size();
+}
 
-    // ModelView = View * Model
-    cmd.modelViewMatrix = simd_mul(viewMatrix, modelMatrix);
-    cmd.projectionMatrix = ctx.getProjectionMatrix();
+size_t VboMesh::getNumLods() const {
+    return impl_->lods.size() + 1;
+}
 
-    // Calculate normal matrix from model-view matrix
-    simd_float3x3 normalMatrix;
-    normalMatrix.columns[0] = simd_make_float3(cmd.modelViewMatrix.columns[0].x,
-                                                 cmd.modelViewMatrix.columns[0].y,
-                                                 cmd.modelViewMatrix.columns[0].z);
-    normalMatrix.columns[1] = simd_make_float3(cmd.modelViewMatrix.columns[1].x,
-                                                 cmd.modelViewMatrix.columns[1].y,
-                                                 cmd.modelViewMatrix.columns[1].z);
-    normalMatrix.columns[2] = simd_make_float3(cmd.modelViewMatrix.columns[2].x,
-                                                 cmd.modelViewMatrix.columns[2].y,
-                                                 cmd.modelViewMatrix.columns[2].z);
-    cmd.normalMatrix = normalMatrix;
+size_t VboMesh::selectLod() const {
+    if (impl_->lods.empty()) return 0;
 
-    // Enable depth testing for 3D rendering
-    cmd.depthTestEnabled = true;
-    cmd.depthWriteEnabled = true;
-    cmd.cullBackFace = false;
+    ofVec3f center;
+    float radius = 0.0f;
+    if (!getBoundingSphere(center, radius)) return 0;
+    const float size = projectedDiameter(center, radius) * impl_->lodBias;
 
-    // Capture lighting state at command creation time
-    cmd.useLighting = ctx.hasMaterial() && ctx.isLightingEnabled();
-    if (cmd.useLighting) {
-        cmd.lightCount = ctx.getLightCount();
-        auto matData = ctx.getMaterialData();
-        size_t matSize = std::min(matData.size(), size_t(16));
-        for (size_t i = 0; i < matSize; ++i) {
-            cmd.materialData[i] = matData[i];
-        }
-        auto lightData = ctx.getAllLightData();
-        size_t lightSize = std::min(lightData.size(), size_t(256));
-        for (size_t i = 0; i < lightSize; ++i) {
-            cmd.lightData[i] = lightData[i];
-        }
+    size_t level = 0;
+    for (size_t i = 0; i < impl_->lods.size(); i++) {
+        if (size < impl_->lods[i].maxScreenSize) level = i + 1;
     }
+    return level;
+}
+
+void VboMesh::setLodBias(float bias) {
+    impl_->lodBias = bias;
+}
 
-    // Add command to draw list
-    drawList.addCommand(cmd);
+void VboMesh::clearLods() {
+    impl_->lods.clear();
 }
 
 void VboMesh::drawRange(size_t start, size_t count) const {
-    // TODO: Implement range drawing
-    draw();
+    if (count == 0) return;
+
+    // Skip ranges of meshes entirely outside the view
+    ofVec3f boundsMin, boundsMax;
+    if (isFrustumCullingActive() && getBounds(boundsMin, boundsMax) && cullDraw(boundsMin, boundsMax)) {
+        return;
+    }
+
+    drawGeometry(impl_->primitiveMode, start, count);
+}
+
+void VboMesh::setDepthTest(bool enabled) {
+    impl_->depthTest = enabled;
+}
+
+bool VboMesh::getDepthTest() const {
+    return impl_->depthTest;
 }
 
 void VboMesh::drawInstanced(size_t instanceCount) const {
@@ -852,22 +1587,78 @@ void VboMesh::drawInstanced(size_t instanceCount) const {
 }
 
 void VboMesh::drawInstanced(size_t instanceCount, ofPrimitiveMode mode) const {
-    // TODO: Implement instanced rendering with Metal encoder directly
-    // For now, fall back to multiple draws
-    for (size_t i = 0; i < std::min(instanceCount, impl_->numInstances); i++) {
-        draw(mode);
-    }
+    size_t count = std::min(instanceCount, impl_->numInstances);
+    if (count == 0) return;
+
+    uploadIfNeeded();
+
+    auto renderer = Context::instance().renderer();
+    if (!renderer) return;
+
+    // Instance data is uploaded to every frame's buffer by setInstances()
+    uint32_t frameIndex = renderer->getCurrentFrameIndex() % kMaxFramesInFlight;
+    id<MTLBuffer> instanceBuffer = impl_->instanceBuffers[frameIndex];
+    if (!instanceBuffer) return;
+
+    // Geometry is recorded once; the GPU replays it per instance
+    render::DrawCommand3DInstanced cmd;
+    if (!recordDraw(mode, cmd)) return;
+    cmd.instanceBuffer = (__bridge void*)instanceBuffer;
+    cmd.instanceOffset = 0;
+    cmd.instanceCount = static_cast<uint32_t>(count);
+    Context::instance().getDrawList().addCommand(cmd);
 }
 
 void VboMesh::drawIndirect() const {
+    auto& ctx = Context::instance();
+    auto renderer = ctx.renderer();
+    if (!renderer) return;
+
+    // Culled this frame: draw the compacted survivors with the GPU's count
+    if (impl_->culledFrameNum == ctx.getFrameNum()) {
+        uint32_t frameIndex = renderer->getCurrentFrameIndex() % kMaxFramesInFlight;
+        id<MTLBuffer> argumentBuffer = impl_->culledArgumentBuffers[frameIndex];
+        id<MTLBuffer> visible = impl_->visibleInstanceBuffers[frameIndex];
+        if (argumentBuffer && visible) {
+            drawIndirect((__bridge void*)argumentBuffer, 0, (__bridge void*)visible);
+            return;
+        }
+    }
+
     if (impl_->indirectArgumentBuffer) {
         drawIndirect((__bridge void*)impl_->indirectArgumentBuffer, 0);
     }
 }
 
 void VboMesh::drawIndirect(void* argumentBuffer, size_t argumentOffset) const {
-    // TODO: Implement indirect rendering with Metal encoder directly
-    draw();
+    void* instanceBuffer = nullptr;
+    if (impl_->numInstances > 0) {
+        auto renderer = Context::instance().renderer();
+        if (!renderer) return;
+        uint32_t frameIndex = renderer->getCurrentFrameIndex() % kMaxFramesInFlight;
+        instanceBuffer = (__bridge void*)impl_->instanceBuffers[frameIndex];
+    }
+    drawIndirect(argumentBuffer, argumentOffset, instanceBuffer);
+}
+
+void VboMesh::drawIndirect(void* argumentBuffer, size_t argumentOffset, void* instanceBuffer) const {
+    if (!argumentBuffer) return;
+
+    // Indirect draws are indexed, and the wireframe path rewrites the index
+    // list so GPU-written index counts would no longer match
+    if (impl_->numIndices == 0 || !ofGetFill()) {
+        draw();
+        return;
+    }
+
+    uploadIfNeeded();
+
+    render::DrawCommand3DIndirect cmd;
+    if (!recordDraw(impl_->primitiveMode, cmd)) return;
+    cmd.argumentBuffer = argumentBuffer;
+    cmd.argumentOffset = static_cast<uint32_t>(argumentOffset);
+    cmd.instanceBuffer = instanceBuffer;
+    Context::instance().getDrawList().addCommand(cmd);
 }
 
 size_t VboMesh::getNumVertices() const {
@@ -902,6 +1693,36 @@ bool VboMesh::hasColors() const {
     return impl_->hasColors_;
 }
 
+bool VboMesh::getBounds(ofVec3f& min, ofVec3f& max) const {
+    // setVertexCount() may count vertices that were allocated but never written
+    const size_t count = impl_->mapped ? impl_->numVertices
+                                       : std::min(impl_->numVertices, impl_->cpuVertices.size());
+    if (count == 0) return false;
+
+    // Every change to the geometry bumps the resident copy's version
+    const uint64_t version = impl_->resident.getVersion();
+    if (impl_->boundsVersion != version) {
+        const InterleavedVertex* vertices = impl_->cpuVertices.data();
+        if (impl_->mapped) {
+            const uint8_t* contents = (const uint8_t*)[impl_->vertexBuffers[0] contents];
+            vertices = reinterpret_cast<const InterleavedVertex*>(contents + impl_->vertexByteOffset);
+        }
+        computeBounds(&vertices[0].position.x, count,
+                      sizeof(InterleavedVertex) / sizeof(float), impl_->boundsMin, impl_->boundsMax);
+        impl_->boundsVersion = version;
+    }
+    min = impl_->boundsMin;
+    max = impl_->boundsMax;
+    return true;
+}
+
+bool VboMesh::getBoundingSphere(ofVec3f& center, float& radius) const {
+    ofVec3f min, max;
+    if (!getBounds(min, max)) return false;
+    boundingSphereFromBounds(min, max, center, radius);
+    return true;
+}
+
 VboStorageMode VboMesh::getStorageMode() const {
     return impl_->storageMode;
 }
@@ -918,12 +1739,20 @@ void* VboMesh::getIndexBuffer(uint32_t frameIndex) const {
     return (__bridge void*)impl_->indexBuffers[frameIndex % kMaxFramesInFlight];
 }
 
+render::IndexType VboMesh::getIndexType() const {
+    return impl_->indexType;
+}
+
 void* VboMesh::getInstanceBuffer(uint32_t frameIndex) const {
     return (__bridge void*)impl_->instanceBuffers[frameIndex % kMaxFramesInFlight];
 }
 
 size_t VboMesh::getVertexBufferOffset() const {
-    return 0;
+    return impl_->vertexByteOffset;
+}
+
+size_t VboMesh::getIndexBufferOffset() const {
+    return impl_->indexByteOffset;
 }
 
 size_t VboMesh::getVertexStride() const {
@@ -931,6 +1760,7 @@ size_t VboMesh::getVertexStride() const {
 }
 
 void VboMesh::markDirty() {
+    impl_->resident.invalidate();
     impl_->dirty = true;
     impl_->dirtyFrameMask = (1 << kMaxFramesInFlight) - 1;
 }
@@ -960,10 +1790,14 @@ VboMesh VboMesh::createPlane(float width, float height, int columns, int rows) {
     return vbo;
 }
 
-VboMesh VboMesh::createSphere(float radius, int resolution) {
+VboMesh VboMesh::createSphere(float radius, int resolution, int lodLevels) {
     VboMesh vbo;
     ofMesh mesh = ofMesh::sphere(radius, resolution);
     vbo.setMesh(mesh, VboUsageHint::Dynamic);
+    for (int level = 1, res = resolution; level <= lodLevels && res / 2 >= 4; level++) {
+        res /= 2;
+        vbo.addLod(ofMesh::sphere(radius, res), kLodScreenSize / static_cast<float>(1 << (level - 1)));
+    }
     return vbo;
 }
 
@@ -974,24 +1808,36 @@ VboMesh VboMesh::createBox(float width, float height, float depth) {
     return vbo;
 }
 
-VboMesh VboMesh::createCone(float radius, float height, int segments) {
+VboMesh VboMesh::createCone(float radius, float height, int segments, int lodLevels) {
     VboMesh vbo;
     ofMesh mesh = ofMesh::cone(radius, height, segments);
     vbo.setMesh(mesh, VboUsageHint::Dynamic);
+    for (int level = 1, res = segments; level <= lodLevels && res / 2 >= 6; level++) {
+        res /= 2;
+        vbo.addLod(ofMesh::cone(radius, height, res), kLodScreenSize / static_cast<float>(1 << (level - 1)));
+    }
     return vbo;
 }
 
-VboMesh VboMesh::createCylinder(float radius, float height, int segments) {
+VboMesh VboMesh::createCylinder(float radius, float height, int segments, int lodLevels) {
     VboMesh vbo;
     ofMesh mesh = ofMesh::cylinder(radius, height, segments);
     vbo.setMesh(mesh, VboUsageHint::Dynamic);
+    for (int level = 1, res = segments; level <= lodLevels && res / 2 >= 6; level++) {
+        res /= 2;
+        vbo.addLod(ofMesh::cylinder(radius, height, res), kLodScreenSize / static_cast<float>(1 << (level - 1)));
+    }
     return vbo;
 }
 
-VboMesh VboMesh::createIcosphere(float radius, int subdivisions) {
+VboMesh VboMesh::createIcosphere(float radius, int subdivisions, int lodLevels) {
     VboMesh vbo;
     ofMesh mesh = ofMesh::icosphere(radius, subdivisions);
     vbo.setMesh(mesh, VboUsageHint::Dynamic);
+    for (int level = 1; level <= lodLevels && subdivisions - level >= 0; level++) {
+        vbo.addLod(ofMesh::icosphere(radius, subdivisions - level),
+                   kLodScreenSize / static_cast<float>(1 << (level - 1)));
+    }
     return vbo;
 }
 
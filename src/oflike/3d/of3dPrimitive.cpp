@@ -1,5 +1,7 @@
 #include "of3dPrimitive.h"
+#include "FrustumCulling.h"
 #include "../graphics/ofGraphics.h"
+#include <algorithm>
 #include <cmath>
 #include <map>
 
@@ -30,14 +32,14 @@ ofMesh* of3dPrimitive::getMeshPtr() {
 void of3dPrimitive::draw() const {
     ofPushMatrix();
     ofMultMatrix(getGlobalTransformMatrix());
-    const_cast<ofMesh&>(mesh_).draw();
+    getLodMesh().draw();
     ofPopMatrix();
 }
 
 void of3dPrimitive::drawWireframe() const {
     ofPushMatrix();
     ofMultMatrix(getGlobalTransformMatrix());
-    const_cast<ofMesh&>(mesh_).drawWireframe();
+    getLodMesh().drawWireframe();
     ofPopMatrix();
 }
 
@@ -92,6 +94,53 @@ int of3dPrimitive::getResolution() const {
     return resolution_;
 }
 
+void of3dPrimitive::setLodLevels(int levels, float screenSize) {
+    lodLevels_ = std::max(0, levels);
+    lodScreenSize_ = screenSize;
+    invalidateLods();
+}
+
+const ofMesh& of3dPrimitive::getLodMesh() const {
+    if (lodLevels_ == 0) return mesh_;
+    ensureLods();
+    if (lods_.empty()) return mesh_;
+
+    ofVec3f center;
+    float radius = 0.0f;
+    if (!mesh_.getBoundingSphere(center, radius)) return mesh_;
+    const float size = projectedDiameter(center, radius);
+
+    // Thresholds halve per level; use the coarsest one still above the size
+    size_t level = 0;
+    float threshold = lodScreenSize_;
+    while (level < lods_.size() && size < threshold) {
+        level++;
+        threshold *= 0.5f;
+    }
+    return level == 0 ? mesh_ : lods_[level - 1];
+}
+
+bool of3dPrimitive::buildLodMesh(int, ofMesh&) const {
+    return false;
+}
+
+void of3dPrimitive::invalidateLods() {
+    lods_.clear();
+    lodsDirty_ = true;
+}
+
+void of3dPrimitive::ensureLods() const {
+    if (!lodsDirty_) return;
+    lodsDirty_ = false;
+
+    lods_.clear();
+    for (int level = 1; level <= lodLevels_; ++level) {
+        ofMesh mesh;
+        if (!buildLodMesh(level, mesh)) break;
+        lods_.push_back(std::move(mesh));
+    }
+}
+
 // ============================================================================
 // ofBoxPrimitive
 // ============================================================================
@@ -142,6 +191,7 @@ void ofBoxPrimitive::setResolution(int res) {
 }
 
 void ofBoxPrimitive::buildMesh() {
+    invalidateLods();
     mesh_.clear();
     mesh_.setMode(OF_PRIMITIVE_TRIANGLES);
 
@@ -224,11 +274,23 @@ void ofSpherePrimitive::setResolution(int res) {
 }
 
 void ofSpherePrimitive::buildMesh() {
-    mesh_.clear();
-    mesh_.setMode(OF_PRIMITIVE_TRIANGLES);
+    buildMesh(mesh_, resolution_);
+    invalidateLods();
+}
+
+bool ofSpherePrimitive::buildLodMesh(int level, ofMesh& mesh) const {
+    const int resolution = std::max(4, resolution_ >> level);
+    if (resolution >= std::max(4, resolution_ >> (level - 1))) return false;
+    buildMesh(mesh, resolution);
+    return true;
+}
+
+void ofSpherePrimitive::buildMesh(ofMesh& mesh, int resolution) const {
+    mesh.clear();
+    mesh.setMode(OF_PRIMITIVE_TRIANGLES);
 
-    const int stacks = resolution_;
-    const int slices = resolution_;
+    const int stacks = resolution;
+    const int slices = resolution;
     const float PI = 3.14159265358979f;
 
     // Generate vertices
@@ -245,9 +307,9 @@ void ofSpherePrimitive::buildMesh() {
             ofVec3f vertex(x, y, z);
             ofVec3f normal = vertex.getNormalized();
 
-            mesh_.addVertex(vertex);
-            mesh_.addNormal(normal);
-            mesh_.addTexCoord(ofVec2f(
+            mesh.addVertex(vertex);
+            mesh.addNormal(normal);
+            mesh.addTexCoord(ofVec2f(
                 static_cast<float>(j) / static_cast<float>(slices),
                 static_cast<float>(i) / static_cast<float>(stacks)
             ));
@@ -260,13 +322,13 @@ void ofSpherePrimitive::buildMesh() {
             int first = i * (slices + 1) + j;
             int second = first + slices + 1;
 
-            mesh_.addIndex(first);
-            mesh_.addIndex(second);
-            mesh_.addIndex(first + 1);
+            mesh.addIndex(first);
+            mesh.addIndex(second);
+            mesh.addIndex(first + 1);
 
-            mesh_.addIndex(second);
-            mesh_.addIndex(second + 1);
-            mesh_.addIndex(first + 1);
+            mesh.addIndex(second);
+            mesh.addIndex(second + 1);
+            mesh.addIndex(first + 1);
         }
     }
 }
@@ -320,8 +382,20 @@ void ofCylinderPrimitive::setResolution(int res) {
 }
 
 void ofCylinderPrimitive::buildMesh() {
-    mesh_.clear();
-    mesh_.setMode(OF_PRIMITIVE_TRIANGLES);
+    buildMesh(mesh_, radiusSegments_);
+    invalidateLods();
+}
+
+bool ofCylinderPrimitive::buildLodMesh(int level, ofMesh& mesh) const {
+    const int radiusSegments = std::max(6, radiusSegments_ >> level);
+    if (radiusSegments >= std::max(6, radiusSegments_ >> (level - 1))) return false;
+    buildMesh(mesh, radiusSegments);
+    return true;
+}
+
+void ofCylinderPrimitive::buildMesh(ofMesh& mesh, int radiusSegments) const {
+    mesh.clear();
+    mesh.setMode(OF_PRIMITIVE_TRIANGLES);
 
     const float PI = 3.14159265358979f;
     float halfH = height_ / 2;
@@ -330,15 +404,15 @@ void ofCylinderPrimitive::buildMesh() {
     for (int i = 0; i <= heightSegments_; ++i) {
         float y = -halfH + height_ * static_cast<float>(i) / static_cast<float>(heightSegments_);
 
-        for (int j = 0; j <= radiusSegments_; ++j) {
-            float theta = 2.0f * PI * static_cast<float>(j) / static_cast<float>(radiusSegments_);
+        for (int j = 0; j <= radiusSegments; ++j) {
+            float theta = 2.0f * PI * static_cast<float>(j) / static_cast<float>(radiusSegments);
             float x = radius_ * std::cos(theta);
             float z = radius_ * std::sin(theta);
 
-            mesh_.addVertex(ofVec3f(x, y, z));
-            mesh_.addNormal(ofVec3f(std::cos(theta), 0, std::sin(theta)));
-            mesh_.addTexCoord(ofVec2f(
-                static_cast<float>(j) / static_cast<float>(radiusSegments_),
+            mesh.addVertex(ofVec3f(x, y, z));
+            mesh.addNormal(ofVec3f(std::cos(theta), 0, std::sin(theta)));
+            mesh.addTexCoord(ofVec2f(
+                static_cast<float>(j) / static_cast<float>(radiusSegments),
                 static_cast<float>(i) / static_cast<float>(heightSegments_)
             ));
         }
@@ -346,68 +420,68 @@ void ofCylinderPrimitive::buildMesh() {
 
     // Side indices
     for (int i = 0; i < heightSegments_; ++i) {
-        for (int j = 0; j < radiusSegments_; ++j) {
-            int first = i * (radiusSegments_ + 1) + j;
-            int second = first + radiusSegments_ + 1;
+        for (int j = 0; j < radiusSegments; ++j) {
+            int first = i * (radiusSegments + 1) + j;
+            int second = first + radiusSegments + 1;
 
-            mesh_.addIndex(first);
-            mesh_.addIndex(second);
-            mesh_.addIndex(first + 1);
+            mesh.addIndex(first);
+            mesh.addIndex(second);
+            mesh.addIndex(first + 1);
 
-            mesh_.addIndex(second);
-            mesh_.addIndex(second + 1);
-            mesh_.addIndex(first + 1);
+            mesh.addIndex(second);
+            mesh.addIndex(second + 1);
+            mesh.addIndex(first + 1);
         }
     }
 
     // Caps
     if (capped_) {
-        int baseIndex = mesh_.getNumVertices();
+        int baseIndex = mesh.getNumVertices();
 
         // Top cap
-        mesh_.addVertex(ofVec3f(0, halfH, 0));
-        mesh_.addNormal(ofVec3f(0, 1, 0));
-        mesh_.addTexCoord(ofVec2f(0.5f, 0.5f));
+        mesh.addVertex(ofVec3f(0, halfH, 0));
+        mesh.addNormal(ofVec3f(0, 1, 0));
+        mesh.addTexCoord(ofVec2f(0.5f, 0.5f));
         int topCenter = baseIndex++;
 
-        for (int j = 0; j <= radiusSegments_; ++j) {
-            float theta = 2.0f * PI * static_cast<float>(j) / static_cast<float>(radiusSegments_);
+        for (int j = 0; j <= radiusSegments; ++j) {
+            float theta = 2.0f * PI * static_cast<float>(j) / static_cast<float>(radiusSegments);
             float x = radius_ * std::cos(theta);
             float z = radius_ * std::sin(theta);
 
-            mesh_.addVertex(ofVec3f(x, halfH, z));
-            mesh_.addNormal(ofVec3f(0, 1, 0));
-            mesh_.addTexCoord(ofVec2f(0.5f + 0.5f * std::cos(theta), 0.5f + 0.5f * std::sin(theta)));
+            mesh.addVertex(ofVec3f(x, halfH, z));
+            mesh.addNormal(ofVec3f(0, 1, 0));
+            mesh.addTexCoord(ofVec2f(0.5f + 0.5f * std::cos(theta), 0.5f + 0.5f * std::sin(theta)));
         }
 
-        for (int j = 0; j < radiusSegments_; ++j) {
-            mesh_.addIndex(topCenter);
-            mesh_.addIndex(topCenter + 1 + j);
-            mesh_.addIndex(topCenter + 2 + j);
+        for (int j = 0; j < radiusSegments; ++j) {
+            mesh.addIndex(topCenter);
+            mesh.addIndex(topCenter + 1 + j);
+            mesh.addIndex(topCenter + 2 + j);
         }
 
-        baseIndex = mesh_.getNumVertices();
+        baseIndex = mesh.getNumVertices();
 
         // Bottom cap
-        mesh_.addVertex(ofVec3f(0, -halfH, 0));
-        mesh_.addNormal(ofVec3f(0, -1, 0));
-        mesh_.addTexCoord(ofVec2f(0.5f, 0.5f));
+        mesh.addVertex(ofVec3f(0, -halfH, 0));
+        mesh.addNormal(ofVec3f(0, -1, 0));
+        mesh.addTexCoord(ofVec2f(0.5f, 0.5f));
         int bottomCenter = baseIndex++;
 
-        for (int j = 0; j <= radiusSegments_; ++j) {
-            float theta = 2.0f * PI * static_cast<float>(j) / static_cast<float>(radiusSegments_);
+        for (int j = 0; j <= radiusSegments; ++j) {
+            float theta = 2.0f * PI * static_cast<float>(j) / static_cast<float>(radiusSegments);
             float x = radius_ * std::cos(theta);
             float z = radius_ * std::sin(theta);
 
-            mesh_.addVertex(ofVec3f(x, -halfH, z));
-            mesh_.addNormal(ofVec3f(0, -1, 0));
-            mesh_.addTexCoord(ofVec2f(0.5f + 0.5f * std::cos(theta), 0.5f + 0.5f * std::sin(theta)));
+            mesh.addVertex(ofVec3f(x, -halfH, z));
+            mesh.addNormal(ofVec3f(0, -1, 0));
+            mesh.addTexCoord(ofVec2f(0.5f + 0.5f * std::cos(theta), 0.5f + 0.5f * std::sin(theta)));
         }
 
-        for (int j = 0; j < radiusSegments_; ++j) {
-            mesh_.addIndex(bottomCenter);
-            mesh_.addIndex(bottomCenter + 2 + j);
-            mesh_.addIndex(bottomCenter + 1 + j);
+        for (int j = 0; j < radiusSegments; ++j) {
+            mesh.addIndex(bottomCenter);
+            mesh.addIndex(bottomCenter + 2 + j);
+            mesh.addIndex(bottomCenter + 1 + j);
         }
     }
 }
@@ -461,8 +535,20 @@ void ofConePrimitive::setResolution(int res) {
 }
 
 void ofConePrimitive::buildMesh() {
-    mesh_.clear();
-    mesh_.setMode(OF_PRIMITIVE_TRIANGLES);
+    buildMesh(mesh_, radiusSegments_);
+    invalidateLods();
+}
+
+bool ofConePrimitive::buildLodMesh(int level, ofMesh& mesh) const {
+    const int radiusSegments = std::max(6, radiusSegments_ >> level);
+    if (radiusSegments >= std::max(6, radiusSegments_ >> (level - 1))) return false;
+    buildMesh(mesh, radiusSegments);
+    return true;
+}
+
+void ofConePrimitive::buildMesh(ofMesh& mesh, int radiusSegments) const {
+    mesh.clear();
+    mesh.setMode(OF_PRIMITIVE_TRIANGLES);
 
     const float PI = 3.14159265358979f;
     float halfH = height_ / 2;
@@ -478,15 +564,15 @@ void ofConePrimitive::buildMesh() {
         float y = -halfH + height_ * t;
         float r = radius_ * (1.0f - t);  // Radius decreases to 0 at top
 
-        for (int j = 0; j <= radiusSegments_; ++j) {
-            float theta = 2.0f * PI * static_cast<float>(j) / static_cast<float>(radiusSegments_);
+        for (int j = 0; j <= radiusSegments; ++j) {
+            float theta = 2.0f * PI * static_cast<float>(j) / static_cast<float>(radiusSegments);
             float x = r * std::cos(theta);
             float z = r * std::sin(theta);
 
-            mesh_.addVertex(ofVec3f(x, y, z));
-            mesh_.addNormal(ofVec3f(nxz * std::cos(theta), ny, nxz * std::sin(theta)));
-            mesh_.addTexCoord(ofVec2f(
-                static_cast<float>(j) / static_cast<float>(radiusSegments_),
+            mesh.addVertex(ofVec3f(x, y, z));
+            mesh.addNormal(ofVec3f(nxz * std::cos(theta), ny, nxz * std::sin(theta)));
+            mesh.addTexCoord(ofVec2f(
+                static_cast<float>(j) / static_cast<float>(radiusSegments),
                 t
             ));
         }
@@ -494,43 +580,43 @@ void ofConePrimitive::buildMesh() {
 
     // Side indices
     for (int i = 0; i < heightSegments_; ++i) {
-        for (int j = 0; j < radiusSegments_; ++j) {
-            int first = i * (radiusSegments_ + 1) + j;
-            int second = first + radiusSegments_ + 1;
+        for (int j = 0; j < radiusSegments; ++j) {
+            int first = i * (radiusSegments + 1) + j;
+            int second = first + radiusSegments + 1;
 
-            mesh_.addIndex(first);
-            mesh_.addIndex(second);
-            mesh_.addIndex(first + 1);
+            mesh.addIndex(first);
+            mesh.addIndex(second);
+            mesh.addIndex(first + 1);
 
-            mesh_.addIndex(second);
-            mesh_.addIndex(second + 1);
-            mesh_.addIndex(first + 1);
+            mesh.addIndex(second);
+            mesh.addIndex(second + 1);
+            mesh.addIndex(first + 1);
         }
     }
 
     // Bottom cap
     if (capped_) {
-        int baseIndex = mesh_.getNumVertices();
+        int baseIndex = mesh.getNumVertices();
 
-        mesh_.addVertex(ofVec3f(0, -halfH, 0));
-        mesh_.addNormal(ofVec3f(0, -1, 0));
-        mesh_.addTexCoord(ofVec2f(0.5f, 0.5f));
+        mesh.addVertex(ofVec3f(0, -halfH, 0));
+        mesh.addNormal(ofVec3f(0, -1, 0));
+        mesh.addTexCoord(ofVec2f(0.5f, 0.5f));
         int bottomCenter = baseIndex++;
 
-        for (int j = 0; j <= radiusSegments_; ++j) {
-            float theta = 2.0f * PI * static_cast<float>(j) / static_cast<float>(radiusSegments_);
+        for (int j = 0; j <= radiusSegments; ++j) {
+            float theta = 2.0f * PI * static_cast<float>(j) / static_cast<float>(radiusSegments);
             float x = radius_ * std::cos(theta);
             float z = radius_ * std::sin(theta);
 
-            mesh_.addVertex(ofVec3f(x, -halfH, z));
-            mesh_.addNormal(ofVec3f(0, -1, 0));
-            mesh_.addTexCoord(ofVec2f(0.5f + 0.5f * std::cos(theta), 0.5f + 0.5f * std::sin(theta)));
+            mesh.addVertex(ofVec3f(x, -halfH, z));
+            mesh.addNormal(ofVec3f(0, -1, 0));
+            mesh.addTexCoord(ofVec2f(0.5f + 0.5f * std::cos(theta), 0.5f + 0.5f * std::sin(theta)));
         }
 
-        for (int j = 0; j < radiusSegments_; ++j) {
-            mesh_.addIndex(bottomCenter);
-            mesh_.addIndex(bottomCenter + 2 + j);
-            mesh_.addIndex(bottomCenter + 1 + j);
+        for (int j = 0; j < radiusSegments; ++j) {
+            mesh.addIndex(bottomCenter);
+            mesh.addIndex(bottomCenter + 2 + j);
+            mesh.addIndex(bottomCenter + 1 + j);
         }
     }
 }
@@ -572,6 +658,7 @@ void ofPlanePrimitive::setResolution(int res) {
 }
 
 void ofPlanePrimitive::buildMesh() {
+    invalidateLods();
     mesh_.clear();
     mesh_.setMode(OF_PRIMITIVE_TRIANGLES);
 
@@ -633,8 +720,19 @@ void ofIcoSpherePrimitive::setResolution(int iterations) {
 }
 
 void ofIcoSpherePrimitive::buildMesh() {
-    mesh_.clear();
-    mesh_.setMode(OF_PRIMITIVE_TRIANGLES);
+    buildMesh(mesh_, iterations_);
+    invalidateLods();
+}
+
+bool ofIcoSpherePrimitive::buildLodMesh(int level, ofMesh& mesh) const {
+    if (iterations_ - level < 0) return false;
+    buildMesh(mesh, iterations_ - level);
+    return true;
+}
+
+void ofIcoSpherePrimitive::buildMesh(ofMesh& mesh, int iterations) const {
+    mesh.clear();
+    mesh.setMode(OF_PRIMITIVE_TRIANGLES);
 
     const float PI = 3.14159265358979f;
     const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;  // Golden ratio
@@ -677,7 +775,7 @@ void ofIcoSpherePrimitive::buildMesh() {
     };
 
     // Subdivide
-    for (int iter = 0; iter < iterations_; ++iter) {
+    for (int iter = 0; iter < iterations; ++iter) {
         std::vector<std::tuple<int, int, int>> newFaces;
         midpointCache.clear();
 
@@ -702,19 +800,19 @@ void ofIcoSpherePrimitive::buildMesh() {
     // Build final mesh
     for (const auto& v : vertices) {
         ofVec3f pos = v * radius_;
-        mesh_.addVertex(pos);
-        mesh_.addNormal(v);
+        mesh.addVertex(pos);
+        mesh.addNormal(v);
 
         // Spherical UV mapping
         float u = 0.5f + std::atan2(v.z, v.x) / (2.0f * PI);
         float vCoord = 0.5f - std::asin(v.y) / PI;
-        mesh_.addTexCoord(ofVec2f(u, vCoord));
+        mesh.addTexCoord(ofVec2f(u, vCoord));
     }
 
     for (const auto& face : faces) {
-        mesh_.addIndex(std::get<0>(face));
-        mesh_.addIndex(std::get<1>(face));
-        mesh_.addIndex(std::get<2>(face));
+        mesh.addIndex(std::get<0>(face));
+        mesh.addIndex(std::get<1>(face));
+        mesh.addIndex(std::get<2>(face));
     }
 }
 
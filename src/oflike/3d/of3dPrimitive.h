@@ -2,6 +2,7 @@
 
 #include "ofNode.h"
 #include "ofMesh.h"
+#include <vector>
 
 namespace oflike {
 
@@ -31,6 +32,8 @@ public:
     // ========================================
 
     /// \brief Draw the primitive with current transform
+    /// \details Draws a coarser level when levels of detail are enabled
+    /// (see setLodLevels())
     virtual void draw() const;
 
     /// \brief Draw the primitive as wireframe
@@ -64,9 +67,46 @@ public:
     /// \brief Get the current resolution
     virtual int getResolution() const;
 
+    // ========================================
+    // Level of Detail
+    // ========================================
+
+    /// \brief Draw coarser tessellations when the primitive is small on screen
+    /// \details Level i has half the resolution of level i - 1 (one
+    /// subdivision less for icospheres) and is drawn below screenSize / 2^(i-1)
+    /// pixels of projected diameter. Levels are regenerated lazily after the
+    /// shape changes; edits through getMesh() and mapTexCoords() only affect
+    /// level 0. Boxes and planes have no coarser levels.
+    /// \param levels Number of coarser levels (0 disables)
+    /// \param screenSize Projected diameter in pixels below which level 1 draws
+    void setLodLevels(int levels, float screenSize = 256.0f);
+
+    /// \brief Get the number of coarser levels requested
+    int getLodLevels() const { return lodLevels_; }
+
+    /// \brief Get the mesh draw() would use under the current matrices
+    const ofMesh& getLodMesh() const;
+
 protected:
+    /// \brief Build a coarser level of the shape
+    /// \param level Level to build (1 = first coarser level)
+    /// \param mesh Receives the geometry
+    /// \return False if the shape has no such level
+    virtual bool buildLodMesh(int level, ofMesh& mesh) const;
+
+    /// \brief Drop generated levels after the shape changed
+    void invalidateLods();
+
     ofMesh mesh_;
     int resolution_ = 12;
+
+private:
+    void ensureLods() const;
+
+    int lodLevels_ = 0;
+    float lodScreenSize_ = 256.0f;
+    mutable std::vector<ofMesh> lods_;
+    mutable bool lodsDirty_ = true;
 };
 
 // ============================================================================
@@ -134,8 +174,12 @@ public:
 
     void setResolution(int res) override;
 
+protected:
+    bool buildLodMesh(int level, ofMesh& mesh) const override;
+
 private:
     void buildMesh();
+    void buildMesh(ofMesh& mesh, int resolution) const;
     float radius_ = 0.5f;
 };
 
@@ -172,8 +216,12 @@ public:
 
     void setResolution(int res) override;
 
+protected:
+    bool buildLodMesh(int level, ofMesh& mesh) const override;
+
 private:
     void buildMesh();
+    void buildMesh(ofMesh& mesh, int radiusSegments) const;
     float radius_ = 0.5f;
     float height_ = 1.0f;
     int radiusSegments_ = 24;
@@ -214,8 +262,12 @@ public:
 
     void setResolution(int res) override;
 
+protected:
+    bool buildLodMesh(int level, ofMesh& mesh) const override;
+
 private:
     void buildMesh();
+    void buildMesh(ofMesh& mesh, int radiusSegments) const;
     float radius_ = 0.5f;
     float height_ = 1.0f;
     int radiusSegments_ = 24;
@@ -281,8 +333,12 @@ public:
     void setResolution(int iterations) override;
     int getResolution() const override { return iterations_; }
 
+protected:
+    bool buildLodMesh(int level, ofMesh& mesh) const override;
+
 private:
     void buildMesh();
+    void buildMesh(ofMesh& mesh, int iterations) const;
     float radius_ = 0.5f;
     int iterations_ = 2;
 };
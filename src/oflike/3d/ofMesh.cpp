@@ -1,17 +1,135 @@
 #include "ofMesh.h"
 #include "../graphics/ofGraphics.h"
+#include "../graphics/ofGraphicsTransform.h"
 #include "../math/ofMatrix4x4.h"
+#include "../math/ofBatchTransform.h"
 #include "../../render/DrawList.h"
 #include "../../core/Context.h"
+#include "MeshCache.h"
+#include "FrustumCulling.h"
+#include "../utils/ofBuffer.h"
 #include <cmath>
 #include <unordered_map>
 #include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <cstring>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <limits>
+#include <Accelerate/Accelerate.h>
+#include <dispatch/dispatch.h>
 
 namespace oflike {
 
+namespace {
+    // The bulk kernels treat vertex arrays as strided float streams
+    static_assert(sizeof(ofVec3f) == 3 * sizeof(float), "ofVec3f must be three packed floats");
+
+    inline simd_float3 toSimd(const ofVec3f& v) {
+        return simd_make_float3(v.x, v.y, v.z);
+    }
+
+    inline ofVec3f fromSimd(simd_float3 v) {
+        return ofVec3f(v.x, v.y, v.z);
+    }
+
+    // Quantized grid cell for weldVertices()
+    struct WeldCell {
+        int64_t c[3] = {0, 0, 0};
+
+        bool operator==(const WeldCell& other) const {
+            return c[0] == other.c[0] && c[1] == other.c[1] && c[2] == other.c[2];
+        }
+    };
+
+    inline uint64_t hashCell(const WeldCell& cell) {
+        uint64_t h = static_cast<uint64_t>(cell.c[0]) * 0x9E3779B185EBCA87ull;
+        h ^= static_cast<uint64_t>(cell.c[1]) * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+        h ^= static_cast<uint64_t>(cell.c[2]) * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+        return h ^ (h >> 29);
+    }
+
+    // Run body(begin, end) over chunks of [0, count) on the global queue
+    template <typename Body>
+    void parallelChunks(size_t count, const Body& body) {
+        constexpr size_t kChunk = 16384;
+        const size_t chunks = (count + kChunk - 1) / kChunk;
+        if (chunks <= 1) {
+            body(0, count);
+            return;
+        }
+        struct Job {
+            const Body* body;
+            size_t count;
+        } job = {&body, count};
+        dispatch_apply_f(chunks, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), &job,
+                         [](void* context, size_t chunk) {
+                             const Job* job = static_cast<const Job*>(context);
+                             const size_t begin = chunk * kChunk;
+                             (*job->body)(begin, std::min(job->count, begin + kChunk));
+                         });
+    }
+
+    // Run body(i) for every i in [0, count) on the global queue
+    template <typename Body>
+    void parallelFor(size_t count, const Body& body) {
+        if (count <= 1) {
+            if (count == 1) body(0);
+            return;
+        }
+        dispatch_apply_f(count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0),
+                         const_cast<Body*>(&body), [](void* context, size_t i) {
+                             (*static_cast<const Body*>(context))(i);
+                         });
+    }
+
+    // Unit face normal (zero for degenerate triangles)
+    inline simd_float3 faceNormal(simd_float3 v0, simd_float3 v1, simd_float3 v2) {
+        const simd_float3 n = simd_cross(v1 - v0, v2 - v0);
+        const float length2 = simd_length_squared(n);
+        return length2 > 0.0f ? n / sqrtf(length2) : n;
+    }
+
+    // Symmetric 4x4 error quadric (Garland/Heckbert) for simplify():
+    // the weighted sum of squared distances to a set of planes
+    struct Quadric {
+        double a[10] = {};  // xx xy xz xw yy yz yw zz zw ww
+
+        void addPlane(simd_double3 n, double d, double weight) {
+            a[0] += weight * n.x * n.x; a[1] += weight * n.x * n.y; a[2] += weight * n.x * n.z;
+            a[3] += weight * n.x * d;   a[4] += weight * n.y * n.y; a[5] += weight * n.y * n.z;
+            a[6] += weight * n.y * d;   a[7] += weight * n.z * n.z; a[8] += weight * n.z * d;
+            a[9] += weight * d * d;
+        }
+
+        Quadric& operator+=(const Quadric& other) {
+            for (int i = 0; i < 10; ++i) a[i] += other.a[i];
+            return *this;
+        }
+
+        double error(const ofVec3f& p) const {
+            const double x = p.x, y = p.y, z = p.z;
+            return a[0] * x * x + 2.0 * (a[1] * x * y + a[2] * x * z + a[3] * x) +
+                   a[4] * y * y + 2.0 * (a[5] * y * z + a[6] * y) +
+                   a[7] * z * z + 2.0 * a[8] * z + a[9];
+        }
+    };
+
+    // Candidate half-edge collapse: position class `from` moves onto `to`
+    struct Collapse {
+        double cost;
+        uint32_t from;
+        uint32_t to;
+        uint32_t fromVersion;
+        uint32_t toVersion;
+
+        bool operator>(const Collapse& other) const { return cost > other.cost; }
+    };
+}
+
 // ============================================================================
 // Construction / Destruction
 // ============================================================================
@@ -32,7 +150,11 @@ ofMesh::ofMesh(ofMesh&& other) noexcept
     , normals_(std::move(other.normals_))
     , texCoords_(std::move(other.texCoords_))
     , colors_(std::move(other.colors_))
-    , indices_(std::move(other.indices_)) {
+    , indices_(std::move(other.indices_))
+    , gpu_(std::move(other.gpu_))
+    , boundsMin_(other.boundsMin_)
+    , boundsMax_(other.boundsMax_)
+    , boundsVersion_(other.boundsVersion_) {
 }
 
 ofMesh& ofMesh::operator=(ofMesh&& other) noexcept {
@@ -43,6 +165,10 @@ ofMesh& ofMesh::operator=(ofMesh&& other) noexcept {
         texCoords_ = std::move(other.texCoords_);
         colors_ = std::move(other.colors_);
         indices_ = std::move(other.indices_);
+        gpu_ = std::move(other.gpu_);
+        boundsMin_ = other.boundsMin_;
+        boundsMax_ = other.boundsMax_;
+        boundsVersion_ = other.boundsVersion_;
     }
     return *this;
 }
@@ -52,14 +178,17 @@ ofMesh& ofMesh::operator=(ofMesh&& other) noexcept {
 // ============================================================================
 
 void ofMesh::addVertex(const ofVec3f& v) {
+    gpu_.invalidate();
     vertices_.push_back(v);
 }
 
 void ofMesh::addVertices(const std::vector<ofVec3f>& verts) {
+    gpu_.invalidate();
     vertices_.insert(vertices_.end(), verts.begin(), verts.end());
 }
 
 void ofMesh::addVertices(const ofVec3f* verts, size_t count) {
+    gpu_.invalidate();
     vertices_.reserve(vertices_.size() + count);
     for (size_t i = 0; i < count; ++i) {
         vertices_.push_back(verts[i]);
@@ -67,14 +196,17 @@ void ofMesh::addVertices(const ofVec3f* verts, size_t count) {
 }
 
 void ofMesh::addNormal(const ofVec3f& n) {
+    gpu_.invalidate();
     normals_.push_back(n);
 }
 
 void ofMesh::addNormals(const std::vector<ofVec3f>& norms) {
+    gpu_.invalidate();
     normals_.insert(normals_.end(), norms.begin(), norms.end());
 }
 
 void ofMesh::addNormals(const ofVec3f* norms, size_t count) {
+    gpu_.invalidate();
     normals_.reserve(normals_.size() + count);
     for (size_t i = 0; i < count; ++i) {
         normals_.push_back(norms[i]);
@@ -82,14 +214,17 @@ void ofMesh::addNormals(const ofVec3f* norms, size_t count) {
 }
 
 void ofMesh::addTexCoord(const ofVec2f& t) {
+    gpu_.invalidate();
     texCoords_.push_back(t);
 }
 
 void ofMesh::addTexCoords(const std::vector<ofVec2f>& tcs) {
+    gpu_.invalidate();
     texCoords_.insert(texCoords_.end(), tcs.begin(), tcs.end());
 }
 
 void ofMesh::addTexCoords(const ofVec2f* tcs, size_t count) {
+    gpu_.invalidate();
     texCoords_.reserve(texCoords_.size() + count);
     for (size_t i = 0; i < count; ++i) {
         texCoords_.push_back(tcs[i]);
@@ -97,14 +232,17 @@ void ofMesh::addTexCoords(const ofVec2f* tcs, size_t count) {
 }
 
 void ofMesh::addColor(const ofColor& c) {
+    gpu_.invalidate();
     colors_.push_back(c);
 }
 
 void ofMesh::addColors(const std::vector<ofColor>& cols) {
+    gpu_.invalidate();
     colors_.insert(colors_.end(), cols.begin(), cols.end());
 }
 
 void ofMesh::addColors(const ofColor* cols, size_t count) {
+    gpu_.invalidate();
     colors_.reserve(colors_.size() + count);
     for (size_t i = 0; i < count; ++i) {
         colors_.push_back(cols[i]);
@@ -116,14 +254,17 @@ void ofMesh::addColors(const ofColor* cols, size_t count) {
 // ============================================================================
 
 void ofMesh::addIndex(uint32_t i) {
+    gpu_.invalidate();
     indices_.push_back(i);
 }
 
 void ofMesh::addIndices(const std::vector<uint32_t>& inds) {
+    gpu_.invalidate();
     indices_.insert(indices_.end(), inds.begin(), inds.end());
 }
 
 void ofMesh::addIndices(const uint32_t* inds, size_t count) {
+    gpu_.invalidate();
     indices_.reserve(indices_.size() + count);
     for (size_t i = 0; i < count; ++i) {
         indices_.push_back(inds[i]);
@@ -131,6 +272,7 @@ void ofMesh::addIndices(const uint32_t* inds, size_t count) {
 }
 
 void ofMesh::addTriangle(uint32_t i1, uint32_t i2, uint32_t i3) {
+    gpu_.invalidate();
     indices_.push_back(i1);
     indices_.push_back(i2);
     indices_.push_back(i3);
@@ -157,6 +299,12 @@ void ofMesh::draw() const {
         return;
     }
 
+    // Skip meshes entirely outside the view (of3dPrimitive draws through here)
+    ofVec3f boundsMin, boundsMax;
+    if (isFrustumCullingActive() && getBounds(boundsMin, boundsMax) && cullDraw(boundsMin, boundsMax)) {
+        return;
+    }
+
     // Get current rendering context
     auto& drawList = Context::instance().getDrawList();
     auto& ctx = Context::instance();
@@ -199,45 +347,83 @@ void ofMesh::draw() const {
     // Get current color from graphics state
     uint8_t r, g, b, a;
     ofGetColor(r, g, b, a);
-    simd_float4 currentColor = simd_make_float4(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f);
+    const float currentColor[4] = {r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f};
 
-    // Build vertex data
+    // Render state shared by the resident and streaming paths
+    render::DrawCommand3D cmd;
+    cmd.primitiveType = primType;
+    cmd.blendMode = render::BlendMode::Alpha;
+    cmd.texture = nullptr;  // TODO: Support textured meshes in future
+
+    // ModelView = View * Model (cached by the matrix stack, see ofGraphicsTransform.h)
+    cmd.modelViewMatrix = ofGetCurrentModelViewMatrix();
+    cmd.projectionMatrix = ctx.getProjectionMatrix();
+
+    // Enable depth testing for 3D rendering
+    cmd.depthTestEnabled = true;
+    cmd.depthWriteEnabled = true;
+    cmd.cullBackFace = false;  // TODO: Make this configurable via render state
+    cmd.orderIndependent = ofGetOrderIndependentTransparencyEnabled();
+    cmd.objectId = ofGetObjectId();
+
+    // Capture lighting state at command creation time
+    cmd.useLighting = ctx.hasMaterial() && ctx.isLightingEnabled();
+    if (cmd.useLighting) {
+        cmd.lightingHandle = ctx.getLightingStateHandle();
+        cmd.normalMatrix = ofGetCurrentNormalMatrix();  // Only lit draws use it
+    }
+
+    // Build vertex data, tinted by the given color
     const size_t numVerts = vertices_.size();
     const bool hasNorms = normals_.size() == numVerts;
     const bool hasTexCoords = texCoords_.size() == numVerts;
     const bool hasColors = colors_.size() == numVerts;
 
-    std::vector<render::Vertex3D> renderVerts;
-    renderVerts.reserve(numVerts);
-
-    // Default values
-    const ofVec3f defaultNormal(0, 0, 1);
-    const ofVec2f defaultTexCoord(0, 0);
-    const ofColor defaultColor(255, 255, 255, 255);
+    auto buildVertices = [&](const float tint[4]) {
+        std::vector<render::Vertex3D> renderVerts;
+        renderVerts.reserve(numVerts);
+
+        // Default values
+        const ofVec3f defaultNormal(0, 0, 1);
+        const ofVec2f defaultTexCoord(0, 0);
+        const ofColor defaultColor(255, 255, 255, 255);
+
+        for (size_t i = 0; i < numVerts; ++i) {
+            const ofVec3f& v = vertices_[i];
+            const ofVec3f& n = hasNorms ? normals_[i] : defaultNormal;
+            const ofVec2f& tc = hasTexCoords ? texCoords_[i] : defaultTexCoord;
+            const ofColor& c = hasColors ? colors_[i] : defaultColor;
+
+            renderVerts.emplace_back(
+                simd_make_float3(v.x, v.y, v.z),
+                simd_make_float3(n.x, n.y, n.z),
+                simd_make_float2(tc.x, tc.y),
+                simd_make_float4(
+                    c.r / 255.0f * tint[0],
+                    c.g / 255.0f * tint[1],
+                    c.b / 255.0f * tint[2],
+                    c.a / 255.0f * tint[3]
+                )
+            );
+        }
+        return renderVerts;
+    };
 
-    for (size_t i = 0; i < numVerts; ++i) {
-        const ofVec3f& v = vertices_[i];
-        const ofVec3f& n = hasNorms ? normals_[i] : defaultNormal;
-        const ofVec2f& tc = hasTexCoords ? texCoords_[i] : defaultTexCoord;
-        const ofColor& c = hasColors ? colors_[i] : defaultColor;
-
-        // Convert vertex color to float and tint with current color
-        simd_float4 vertColor = simd_make_float4(c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f);
-
-        renderVerts.emplace_back(
-            simd_make_float3(v.x, v.y, v.z),
-            simd_make_float3(n.x, n.y, n.z),
-            simd_make_float2(tc.x, tc.y),
-            simd_make_float4(
-                vertColor.x * currentColor.x,
-                vertColor.y * currentColor.y,
-                vertColor.z * currentColor.z,
-                vertColor.w * currentColor.w
-            )
-        );
+    // Unchanged meshes draw from their GPU copy; the tint becomes the
+    // instance color, so the copy stays valid across ofSetColor changes
+    if (gpu_.beginDraw(numVerts)) {
+        if (!gpu_.isCurrent()) {
+            const float white[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+            const std::vector<render::Vertex3D> untinted = buildVertices(white);
+            gpu_.upload(untinted.data(), untinted.size(), indices_.data(), indices_.size());
+        }
+        if (gpu_.record(drawList, cmd, needsWireframe, currentColor)) {
+            return;
+        }
     }
 
     // Add vertices to draw list
+    const std::vector<render::Vertex3D> renderVerts = buildVertices(currentColor);
     uint32_t vertexOffset = drawList.addVertices3D(renderVerts);
 
     // Generate indices - for wireframe, convert triangle indices to edge indices
@@ -273,71 +459,10 @@ void ofMesh::draw() const {
         indexCount = static_cast<uint32_t>(indices_.size());
     }
 
-    // Create DrawCommand3D
-    render::DrawCommand3D cmd;
     cmd.vertexOffset = vertexOffset;
     cmd.vertexCount = static_cast<uint32_t>(renderVerts.size());
     cmd.indexOffset = indexOffset;
     cmd.indexCount = indexCount;
-    cmd.primitiveType = primType;
-    cmd.blendMode = render::BlendMode::Alpha;
-    cmd.texture = nullptr;  // TODO: Support textured meshes in future
-
-    // Get view matrix from Context (set by camera)
-    simd_float4x4 viewMatrix = ctx.getViewMatrix();
-
-    // Get model matrix from current transform stack (ofPushMatrix/ofTranslate/etc.)
-    ofMatrix4x4 m = ofGetCurrentMatrix();
-    simd_float4x4 modelMatrix = simd_matrix(
-        simd_make_float4(m(0,0), m(1,0), m(2,0), m(3,0)),
-        simd_make_float4(m(0,1), m(1,1), m(2,1), m(3,1)),
-        simd_make_float4(m(0,2), m(1,2), m(2,2), m(3,2)),
-        simd_make_float4(m(0,3), m(1,3), m(2,3), m(3,3))
-    );
-
-    // ModelView = View * Model
-    cmd.modelViewMatrix = simd_mul(viewMatrix, modelMatrix);
-    cmd.projectionMatrix = ctx.getProjectionMatrix();
-
-    // Calculate normal matrix from model-view matrix
-    // Normal matrix is the inverse transpose of the upper-left 3x3 of the model-view matrix
-    simd_float3x3 normalMatrix;
-    normalMatrix.columns[0] = simd_make_float3(cmd.modelViewMatrix.columns[0].x,
-                                                 cmd.modelViewMatrix.columns[0].y,
-                                                 cmd.modelViewMatrix.columns[0].z);
-    normalMatrix.columns[1] = simd_make_float3(cmd.modelViewMatrix.columns[1].x,
-                                                 cmd.modelViewMatrix.columns[1].y,
-                                                 cmd.modelViewMatrix.columns[1].z);
-    normalMatrix.columns[2] = simd_make_float3(cmd.modelViewMatrix.columns[2].x,
-                                                 cmd.modelViewMatrix.columns[2].y,
-                                                 cmd.modelViewMatrix.columns[2].z);
-
-    // Inverse transpose for normal transformation
-    // For uniform scaling, we can use the matrix directly
-    // For non-uniform scaling, we should compute inverse transpose
-    // For now, use the matrix directly (works for uniform transforms)
-    cmd.normalMatrix = normalMatrix;
-
-    // Enable depth testing for 3D rendering
-    cmd.depthTestEnabled = true;
-    cmd.depthWriteEnabled = true;
-    cmd.cullBackFace = false;  // TODO: Make this configurable via render state
-
-    // Capture lighting state at command creation time
-    cmd.useLighting = ctx.hasMaterial() && ctx.isLightingEnabled();
-    if (cmd.useLighting) {
-        cmd.lightCount = ctx.getLightCount();
-        auto matData = ctx.getMaterialData();
-        size_t matSize = std::min(matData.size(), size_t(16));
-        for (size_t i = 0; i < matSize; ++i) {
-            cmd.materialData[i] = matData[i];
-        }
-        auto lightData = ctx.getAllLightData();
-        size_t lightSize = std::min(lightData.size(), size_t(256));
-        for (size_t i = 0; i < lightSize; ++i) {
-            cmd.lightData[i] = lightData[i];
-        }
-    }
 
     // Add command to draw list
     drawList.addCommand(cmd);
@@ -390,6 +515,7 @@ void ofMesh::drawFaces() const {
 // ============================================================================
 
 std::vector<ofVec3f>& ofMesh::getVertices() {
+    gpu_.invalidate();
     return vertices_;
 }
 
@@ -398,6 +524,7 @@ const std::vector<ofVec3f>& ofMesh::getVertices() const {
 }
 
 std::vector<ofVec3f>& ofMesh::getNormals() {
+    gpu_.invalidate();
     return normals_;
 }
 
@@ -406,6 +533,7 @@ const std::vector<ofVec3f>& ofMesh::getNormals() const {
 }
 
 std::vector<ofVec2f>& ofMesh::getTexCoords() {
+    gpu_.invalidate();
     return texCoords_;
 }
 
@@ -414,6 +542,7 @@ const std::vector<ofVec2f>& ofMesh::getTexCoords() const {
 }
 
 std::vector<ofColor>& ofMesh::getColors() {
+    gpu_.invalidate();
     return colors_;
 }
 
@@ -422,6 +551,7 @@ const std::vector<ofColor>& ofMesh::getColors() const {
 }
 
 std::vector<uint32_t>& ofMesh::getIndices() {
+    gpu_.invalidate();
     return indices_;
 }
 
@@ -434,6 +564,7 @@ const std::vector<uint32_t>& ofMesh::getIndices() const {
 // ============================================================================
 
 void ofMesh::clear() {
+    gpu_.invalidate();
     vertices_.clear();
     normals_.clear();
     texCoords_.clear();
@@ -482,60 +613,143 @@ bool ofMesh::hasColors() const {
 // ============================================================================
 
 void ofMesh::mergeDuplicateVertices() {
-    if (vertices_.empty()) {
-        return;
-    }
+    weldVertices(1e-6f, false);
+}
 
-    // Hash function for ofVec3f (position comparison)
-    struct Vec3Hash {
-        size_t operator()(const ofVec3f& v) const {
-            // Simple hash combining x, y, z
-            size_t h1 = std::hash<float>{}(v.x);
-            size_t h2 = std::hash<float>{}(v.y);
-            size_t h3 = std::hash<float>{}(v.z);
-            return h1 ^ (h2 << 1) ^ (h3 << 2);
+std::vector<uint32_t> ofMesh::weldVertices(float tolerance, bool compareAttributes) {
+    gpu_.invalidate();
+    const size_t count = vertices_.size();
+    if (count == 0) {
+        return {};
+    }
+    tolerance = std::max(tolerance, 0.0f);
+
+    const bool hasNorms = normals_.size() == count;
+    const bool hasTexCoords = texCoords_.size() == count;
+    const bool hasColors = colors_.size() == count;
+
+    // Grid cells are 2 * tolerance wide: everything within tolerance lies in
+    // the vertex's own cell or the neighbor on its nearer side per axis.
+    // Tolerance 0 keys cells by the exact coordinate bits instead.
+    const double invCell = tolerance > 0.0f ? 1.0 / (2.0 * tolerance) : 0.0;
+    auto cellOf = [&](const ofVec3f& v, int offsets[3]) {
+        WeldCell cell;
+        const float coords[3] = {v.x, v.y, v.z};
+        for (int axis = 0; axis < 3; ++axis) {
+            if (tolerance > 0.0f) {
+                const double scaled = coords[axis] * invCell;
+                const double base = std::floor(scaled);
+                cell.c[axis] = static_cast<int64_t>(base);
+                offsets[axis] = scaled - base < 0.5 ? -1 : 1;
+            } else {
+                uint32_t bits;
+                const float value = coords[axis] == 0.0f ? 0.0f : coords[axis];  // -0 == +0
+                std::memcpy(&bits, &value, sizeof(bits));
+                cell.c[axis] = bits;
+                offsets[axis] = 0;
+            }
         }
+        return cell;
     };
 
-    struct Vec3Equal {
-        bool operator()(const ofVec3f& a, const ofVec3f& b) const {
-            const float epsilon = 1e-6f;
-            return std::abs(a.x - b.x) < epsilon &&
-                   std::abs(a.y - b.y) < epsilon &&
-                   std::abs(a.z - b.z) < epsilon;
+    // Pass 1 (parallel): cell and bucket of every vertex; non-finite
+    // positions never weld
+    size_t bucketCount = 1;
+    while (bucketCount < count) bucketCount <<= 1;
+    const uint64_t bucketMask = bucketCount - 1;
+    std::vector<WeldCell> cells(count);
+    std::vector<uint32_t> buckets(count);
+    std::vector<uint8_t> finite(count);
+    parallelChunks(count, [&](size_t begin, size_t end) {
+        int offsets[3];
+        for (size_t i = begin; i < end; ++i) {
+            const ofVec3f& v = vertices_[i];
+            finite[i] = std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+            if (finite[i]) {
+                cells[i] = cellOf(v, offsets);
+                buckets[i] = static_cast<uint32_t>(hashCell(cells[i]) & bucketMask);
+            }
+        }
+    });
+
+    // Counting sort by bucket; entries stay in ascending vertex order
+    std::vector<uint32_t> bucketStart(bucketCount + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        if (finite[i]) bucketStart[buckets[i] + 1]++;
+    }
+    for (size_t b = 0; b < bucketCount; ++b) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    std::vector<uint32_t> sorted(bucketStart[bucketCount]);
+    {
+        std::vector<uint32_t> cursor(bucketStart.begin(), bucketStart.end() - 1);
+        for (size_t i = 0; i < count; ++i) {
+            if (finite[i]) sorted[cursor[buckets[i]]++] = static_cast<uint32_t>(i);
         }
+    }
+
+    constexpr float kAttributeTolerance = 1e-4f;
+    auto near2 = [](const ofVec2f& a, const ofVec2f& b, float eps) {
+        return std::abs(a.x - b.x) <= eps && std::abs(a.y - b.y) <= eps;
+    };
+    auto near3 = [](const ofVec3f& a, const ofVec3f& b, float eps) {
+        return std::abs(a.x - b.x) <= eps && std::abs(a.y - b.y) <= eps && std::abs(a.z - b.z) <= eps;
+    };
+    auto matches = [&](size_t a, size_t b) {
+        if (!near3(vertices_[a], vertices_[b], tolerance)) return false;
+        if (!compareAttributes) return true;
+        if (hasNorms && !near3(normals_[a], normals_[b], kAttributeTolerance)) return false;
+        if (hasTexCoords && !near2(texCoords_[a], texCoords_[b], kAttributeTolerance)) return false;
+        return !hasColors || colors_[a] == colors_[b];
     };
 
-    std::unordered_map<ofVec3f, uint32_t, Vec3Hash, Vec3Equal> uniqueVertices;
-    std::vector<uint32_t> remapTable(vertices_.size());
+    // Pass 2 (parallel): lowest-index match of every vertex
+    std::vector<uint32_t> representative(count);
+    parallelChunks(count, [&](size_t begin, size_t end) {
+        int offsets[3];
+        for (size_t i = begin; i < end; ++i) {
+            uint32_t best = static_cast<uint32_t>(i);
+            if (finite[i]) {
+                const WeldCell home = cellOf(vertices_[i], offsets);
+                const int steps = tolerance > 0.0f ? 8 : 1;
+                for (int n = 0; n < steps; ++n) {
+                    WeldCell probe = home;
+                    for (int axis = 0; axis < 3; ++axis) {
+                        if (n & (1 << axis)) probe.c[axis] += offsets[axis];
+                    }
+                    const uint32_t bucket = static_cast<uint32_t>(hashCell(probe) & bucketMask);
+                    for (uint32_t k = bucketStart[bucket]; k < bucketStart[bucket + 1]; ++k) {
+                        const uint32_t j = sorted[k];
+                        if (j >= best) break;   // Ascending: nothing lower follows
+                        if (cells[j] == probe && matches(i, j)) {
+                            best = j;
+                            break;
+                        }
+                    }
+                }
+            }
+            representative[i] = best;
+        }
+    });
 
+    // Pass 3: number the kept vertices; matches always point backwards, so
+    // chains resolve in one in-order pass
+    std::vector<uint32_t> remapTable(count);
     std::vector<ofVec3f> newVertices;
     std::vector<ofVec3f> newNormals;
     std::vector<ofVec2f> newTexCoords;
     std::vector<ofColor> newColors;
 
-    const bool hasNorms = normals_.size() == vertices_.size();
-    const bool hasTexCoords = texCoords_.size() == vertices_.size();
-    const bool hasColors = colors_.size() == vertices_.size();
-
-    for (size_t i = 0; i < vertices_.size(); ++i) {
-        const ofVec3f& v = vertices_[i];
-
-        auto it = uniqueVertices.find(v);
-        if (it != uniqueVertices.end()) {
-            // Vertex already exists
-            remapTable[i] = it->second;
-        } else {
-            // New unique vertex
-            uint32_t newIndex = static_cast<uint32_t>(newVertices.size());
-            uniqueVertices[v] = newIndex;
-            remapTable[i] = newIndex;
-
-            newVertices.push_back(v);
-            if (hasNorms) newNormals.push_back(normals_[i]);
-            if (hasTexCoords) newTexCoords.push_back(texCoords_[i]);
-            if (hasColors) newColors.push_back(colors_[i]);
+    for (size_t i = 0; i < count; ++i) {
+        if (representative[i] != i) {
+            remapTable[i] = remapTable[representative[i]];
+            continue;
         }
+        remapTable[i] = static_cast<uint32_t>(newVertices.size());
+        newVertices.push_back(vertices_[i]);
+        if (hasNorms) newNormals.push_back(normals_[i]);
+        if (hasTexCoords) newTexCoords.push_back(texCoords_[i]);
+        if (hasColors) newColors.push_back(colors_[i]);
     }
 
     // Update indices
@@ -547,11 +761,7 @@ void ofMesh::mergeDuplicateVertices() {
         }
     } else {
         // If no indices existed, create them now
-        indices_.clear();
-        indices_.reserve(vertices_.size());
-        for (size_t i = 0; i < vertices_.size(); ++i) {
-            indices_.push_back(remapTable[i]);
-        }
+        indices_ = remapTable;
     }
 
     // Replace data
@@ -559,9 +769,11 @@ void ofMesh::mergeDuplicateVertices() {
     if (hasNorms) normals_ = std::move(newNormals);
     if (hasTexCoords) texCoords_ = std::move(newTexCoords);
     if (hasColors) colors_ = std::move(newColors);
+    return remapTable;
 }
 
 void ofMesh::setupIndicesAuto() {
+    gpu_.invalidate();
     indices_.clear();
     indices_.reserve(vertices_.size());
     for (uint32_t i = 0; i < static_cast<uint32_t>(vertices_.size()); ++i) {
@@ -570,15 +782,22 @@ void ofMesh::setupIndicesAuto() {
 }
 
 void ofMesh::smoothNormals() {
+    gpu_.invalidate();
     if (vertices_.empty()) {
         return;
     }
 
-    // Initialize normals to zero
-    normals_.clear();
-    normals_.resize(vertices_.size(), ofVec3f(0, 0, 0));
+    // Accumulate area-weighted face normals in 16-byte lanes
+    const size_t count = vertices_.size();
+    std::vector<simd_float3> sums(count, simd_make_float3(0, 0, 0));
+    auto accumulate = [&](uint32_t i0, uint32_t i1, uint32_t i2) {
+        const simd_float3 v0 = toSimd(vertices_[i0]);
+        const simd_float3 n = simd_cross(toSimd(vertices_[i1]) - v0, toSimd(vertices_[i2]) - v0);
+        sums[i0] += n;
+        sums[i1] += n;
+        sums[i2] += n;
+    };
 
-    // Accumulate face normals
     if (!indices_.empty()) {
         // Indexed mesh
         for (size_t i = 0; i + 2 < indices_.size(); i += 3) {
@@ -586,46 +805,28 @@ void ofMesh::smoothNormals() {
             uint32_t i1 = indices_[i + 1];
             uint32_t i2 = indices_[i + 2];
 
-            if (i0 >= vertices_.size() || i1 >= vertices_.size() || i2 >= vertices_.size()) {
+            if (i0 >= count || i1 >= count || i2 >= count) {
                 continue;
             }
-
-            const ofVec3f& v0 = vertices_[i0];
-            const ofVec3f& v1 = vertices_[i1];
-            const ofVec3f& v2 = vertices_[i2];
-
-            ofVec3f edge1 = v1 - v0;
-            ofVec3f edge2 = v2 - v0;
-            ofVec3f faceNormal = edge1.cross(edge2);
-
-            normals_[i0] += faceNormal;
-            normals_[i1] += faceNormal;
-            normals_[i2] += faceNormal;
+            accumulate(i0, i1, i2);
         }
     } else {
         // Non-indexed mesh
-        for (size_t i = 0; i + 2 < vertices_.size(); i += 3) {
-            const ofVec3f& v0 = vertices_[i];
-            const ofVec3f& v1 = vertices_[i + 1];
-            const ofVec3f& v2 = vertices_[i + 2];
-
-            ofVec3f edge1 = v1 - v0;
-            ofVec3f edge2 = v2 - v0;
-            ofVec3f faceNormal = edge1.cross(edge2);
-
-            normals_[i] += faceNormal;
-            normals_[i + 1] += faceNormal;
-            normals_[i + 2] += faceNormal;
+        for (uint32_t i = 0; i + 2 < count; i += 3) {
+            accumulate(i, i + 1, i + 2);
         }
     }
 
     // Normalize all normals
-    for (ofVec3f& n : normals_) {
-        n.normalize();
+    normals_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float length2 = simd_length_squared(sums[i]);
+        normals_[i] = fromSimd(length2 > 0.0f ? sums[i] / sqrtf(length2) : sums[i]);
     }
 }
 
 void ofMesh::flatNormals() {
+    gpu_.invalidate();
     if (vertices_.empty()) {
         return;
     }
@@ -638,6 +839,13 @@ void ofMesh::flatNormals() {
     const bool hasTexCoords = texCoords_.size() == vertices_.size();
     const bool hasColors = colors_.size() == vertices_.size();
 
+    // One output vertex per triangle corner
+    const size_t corners = (indices_.empty() ? vertices_.size() : indices_.size()) / 3 * 3;
+    newVertices.reserve(corners);
+    newNormals.reserve(corners);
+    if (hasTexCoords) newTexCoords.reserve(corners);
+    if (hasColors) newColors.reserve(corners);
+
     if (!indices_.empty()) {
         // Indexed mesh - create unique vertices per triangle
         for (size_t i = 0; i + 2 < indices_.size(); i += 3) {
@@ -652,18 +860,15 @@ void ofMesh::flatNormals() {
             const ofVec3f& v0 = vertices_[i0];
             const ofVec3f& v1 = vertices_[i1];
             const ofVec3f& v2 = vertices_[i2];
-
-            ofVec3f edge1 = v1 - v0;
-            ofVec3f edge2 = v2 - v0;
-            ofVec3f faceNormal = edge1.cross(edge2).normalize();
+            const ofVec3f normal = fromSimd(faceNormal(toSimd(v0), toSimd(v1), toSimd(v2)));
 
             newVertices.push_back(v0);
             newVertices.push_back(v1);
             newVertices.push_back(v2);
 
-            newNormals.push_back(faceNormal);
-            newNormals.push_back(faceNormal);
-            newNormals.push_back(faceNormal);
+            newNormals.push_back(normal);
+            newNormals.push_back(normal);
+            newNormals.push_back(normal);
 
             if (hasTexCoords) {
                 newTexCoords.push_back(texCoords_[i0]);
@@ -686,18 +891,15 @@ void ofMesh::flatNormals() {
             const ofVec3f& v0 = vertices_[i];
             const ofVec3f& v1 = vertices_[i + 1];
             const ofVec3f& v2 = vertices_[i + 2];
-
-            ofVec3f edge1 = v1 - v0;
-            ofVec3f edge2 = v2 - v0;
-            ofVec3f faceNormal = edge1.cross(edge2).normalize();
+            const ofVec3f normal = fromSimd(faceNormal(toSimd(v0), toSimd(v1), toSimd(v2)));
 
             newVertices.push_back(v0);
             newVertices.push_back(v1);
             newVertices.push_back(v2);
 
-            newNormals.push_back(faceNormal);
-            newNormals.push_back(faceNormal);
-            newNormals.push_back(faceNormal);
+            newNormals.push_back(normal);
+            newNormals.push_back(normal);
+            newNormals.push_back(normal);
 
             if (hasTexCoords) {
                 newTexCoords.push_back(texCoords_[i]);
@@ -720,6 +922,7 @@ void ofMesh::flatNormals() {
 }
 
 void ofMesh::append(const ofMesh& mesh) {
+    gpu_.invalidate();
     const uint32_t vertexOffset = static_cast<uint32_t>(vertices_.size());
 
     // Append vertices
@@ -740,15 +943,390 @@ void ofMesh::append(const ofMesh& mesh) {
         colors_.insert(colors_.end(), mesh.colors_.begin(), mesh.colors_.end());
     }
 
-    // Append indices (with offset)
+    // Append indices (with offset); a plain loop over raw pointers vectorizes
     if (!mesh.indices_.empty()) {
-        indices_.reserve(indices_.size() + mesh.indices_.size());
-        for (uint32_t idx : mesh.indices_) {
-            indices_.push_back(idx + vertexOffset);
+        const size_t first = indices_.size();
+        const size_t count = mesh.indices_.size();
+        indices_.resize(first + count);
+        uint32_t* dst = indices_.data() + first;
+        const uint32_t* src = mesh.indices_.data();
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = src[i] + vertexOffset;
         }
     }
 }
 
+bool ofMesh::simplify(float ratio, float maxError) {
+    const size_t vertexCount = vertices_.size();
+    if (mode_ != OF_PRIMITIVE_TRIANGLES || vertexCount < 3) {
+        return false;
+    }
+    gpu_.invalidate();
+
+    // Triangle corners (vertex indices); unindexed meshes are implicit lists
+    std::vector<uint32_t> corners;
+    if (indices_.empty()) {
+        corners.resize(vertexCount - vertexCount % 3);
+        for (size_t i = 0; i < corners.size(); ++i) corners[i] = static_cast<uint32_t>(i);
+    } else {
+        corners.reserve(indices_.size());
+        for (size_t i = 0; i + 2 < indices_.size(); i += 3) {
+            const uint32_t a = indices_[i], b = indices_[i + 1], c = indices_[i + 2];
+            if (a < vertexCount && b < vertexCount && c < vertexCount) {
+                corners.insert(corners.end(), {a, b, c});
+            }
+        }
+    }
+    const size_t triangleCount = corners.size() / 3;
+    if (triangleCount == 0) {
+        return false;
+    }
+
+    // Vertices sharing a position (UV and normal seams) collapse together:
+    // classes group them, sorted by position with non-finite ones kept apart
+    std::vector<uint32_t> order(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) order[i] = static_cast<uint32_t>(i);
+    auto finite = [&](uint32_t i) {
+        const ofVec3f& v = vertices_[i];
+        return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+    };
+    auto less = [&](uint32_t i, uint32_t j) {
+        const ofVec3f& a = vertices_[i];
+        const ofVec3f& b = vertices_[j];
+        if (a.x != b.x) return a.x < b.x;
+        if (a.y != b.y) return a.y < b.y;
+        if (a.z != b.z) return a.z < b.z;
+        return i < j;
+    };
+    auto split = std::stable_partition(order.begin(), order.end(), finite);
+    std::sort(order.begin(), split, less);
+
+    std::vector<uint32_t> classOf(vertexCount);
+    std::vector<ofVec3f> classPosition;
+    classPosition.reserve(vertexCount);
+    for (size_t k = 0; k < vertexCount; ++k) {
+        const uint32_t i = order[k];
+        const bool finitePosition = order.begin() + k < split;
+        const ofVec3f& v = vertices_[i];
+        const ofVec3f& previous = vertices_[order[k > 0 ? k - 1 : 0]];
+        const bool same = k > 0 && finitePosition &&
+                          previous.x == v.x && previous.y == v.y && previous.z == v.z;
+        if (!same) {
+            classPosition.push_back(vertices_[i]);
+        }
+        classOf[i] = static_cast<uint32_t>(classPosition.size() - 1);
+    }
+    const size_t classCount = classPosition.size();
+
+    // Face planes weighted by area; quadric errors are normalized by the
+    // accumulated area so costs read as mean squared distances
+    std::vector<Quadric> quadrics(classCount);
+    std::vector<double> weights(classCount, 0.0);
+    std::vector<std::vector<uint32_t>> classTriangles(classCount);
+    std::unordered_map<uint64_t, uint32_t> edgeUses;
+    auto edgeKey = [](uint32_t a, uint32_t b) {
+        return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+    };
+    auto position = [&](uint32_t vertex) {
+        const ofVec3f& v = classPosition[classOf[vertex]];
+        return simd_make_double3(v.x, v.y, v.z);
+    };
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t* tri = &corners[t * 3];
+        const simd_double3 p0 = position(tri[0]), p1 = position(tri[1]), p2 = position(tri[2]);
+        const simd_double3 n = simd_cross(p1 - p0, p2 - p0);
+        const double length = simd_length(n);
+        const double area = length * 0.5;
+        for (int j = 0; j < 3; ++j) {
+            const uint32_t c = classOf[tri[j]];
+            if (length > 0.0) {
+                quadrics[c].addPlane(n / length, -simd_dot(n / length, p0), area);
+            }
+            weights[c] += area;
+            classTriangles[c].push_back(static_cast<uint32_t>(t));
+            edgeUses[edgeKey(c, classOf[tri[(j + 1) % 3]])]++;
+        }
+    }
+
+    // Open borders get a perpendicular plane so they keep their outline
+    constexpr double kBorderWeight = 10.0;
+    constexpr double kMaxFold = 0.25;   // cos of the largest normal change per collapse
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t* tri = &corners[t * 3];
+        const simd_double3 p0 = position(tri[0]), p1 = position(tri[1]), p2 = position(tri[2]);
+        const simd_double3 faceN = simd_cross(p1 - p0, p2 - p0);
+        const simd_double3 points[3] = {p0, p1, p2};
+        for (int j = 0; j < 3; ++j) {
+            const uint32_t a = classOf[tri[j]], b = classOf[tri[(j + 1) % 3]];
+            if (a == b || edgeUses[edgeKey(a, b)] != 1) continue;
+            const simd_double3 edge = points[(j + 1) % 3] - points[j];
+            const simd_double3 n = simd_cross(edge, faceN);
+            const double length = simd_length(n);
+            if (length <= 0.0) continue;
+            const simd_double3 unit = n / length;
+            const double weight = kBorderWeight * simd_length_squared(edge);
+            quadrics[a].addPlane(unit, -simd_dot(unit, points[j]), weight);
+            quadrics[b].addPlane(unit, -simd_dot(unit, points[j]), weight);
+        }
+    }
+
+    std::vector<uint8_t> triangleAlive(triangleCount, 1);
+    std::vector<uint8_t> classAlive(classCount, 1);
+    std::vector<uint32_t> versions(classCount, 0);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+
+    auto cost = [&](uint32_t from, uint32_t to) {
+        Quadric q = quadrics[from];
+        q += quadrics[to];
+        const double weight = weights[from] + weights[to];
+        return q.error(classPosition[to]) / (weight > 0.0 ? weight : 1.0);
+    };
+    auto push = [&](uint32_t a, uint32_t b) {
+        queue.push({cost(a, b), a, b, versions[a], versions[b]});
+        queue.push({cost(b, a), b, a, versions[b], versions[a]});
+    };
+    for (const auto& entry : edgeUses) {
+        const uint32_t a = static_cast<uint32_t>(entry.first >> 32);
+        const uint32_t b = static_cast<uint32_t>(entry.first & 0xFFFFFFFFu);
+        if (a != b) push(a, b);
+    }
+
+    // Squared distance limit, relative to the bounds' diagonal
+    double limit = std::numeric_limits<double>::infinity();
+    if (maxError > 0.0f) {
+        ofVec3f min, max;
+        getBounds(min, max);
+        const double distance = maxError * (max - min).length();
+        limit = distance * distance;
+    }
+
+    const size_t target = static_cast<size_t>(triangleCount * std::max(0.0f, std::min(ratio, 1.0f)));
+    size_t liveTriangles = triangleCount;
+    std::unordered_map<uint32_t, uint32_t> redirect;
+    std::vector<uint32_t> neighbors;
+    std::vector<uint32_t> shared;
+
+    auto liveTrianglesOf = [&](uint32_t c) -> std::vector<uint32_t>& {
+        auto& list = classTriangles[c];
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [&](uint32_t t) { return !triangleAlive[t]; }), list.end());
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        return list;
+    };
+    auto neighborsOf = [&](uint32_t c, std::vector<uint32_t>& out) {
+        out.clear();
+        for (uint32_t t : classTriangles[c]) {
+            for (int j = 0; j < 3; ++j) {
+                const uint32_t n = classOf[corners[t * 3 + j]];
+                if (n != c) out.push_back(n);
+            }
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    };
+
+    while (liveTriangles > target && !queue.empty()) {
+        const Collapse collapse = queue.top();
+        queue.pop();
+        const uint32_t a = collapse.from, b = collapse.to;
+        if (!classAlive[a] || !classAlive[b] ||
+            versions[a] != collapse.fromVersion || versions[b] != collapse.toVersion) {
+            continue;
+        }
+        if (collapse.cost > limit) {
+            break;
+        }
+
+        const std::vector<uint32_t>& trianglesA = liveTrianglesOf(a);
+        liveTrianglesOf(b);
+
+        // Each vertex of a moves onto the vertex of b it shares a triangle
+        // with, which keeps seams intact; collapses that would leave a
+        // vertex without a counterpart are skipped
+        redirect.clear();
+        size_t sharedTriangles = 0;
+        for (uint32_t t : trianglesA) {
+            const uint32_t* tri = &corners[t * 3];
+            int ia = -1, ib = -1;
+            for (int j = 0; j < 3; ++j) {
+                if (classOf[tri[j]] == a) ia = j;
+                if (classOf[tri[j]] == b) ib = j;
+            }
+            if (ib >= 0) {
+                redirect.emplace(tri[ia], tri[ib]);
+                sharedTriangles++;
+            }
+        }
+        bool valid = sharedTriangles > 0;
+        for (size_t k = 0; valid && k < trianglesA.size(); ++k) {
+            const uint32_t* tri = &corners[trianglesA[k] * 3];
+            for (int j = 0; j < 3 && valid; ++j) {
+                if (classOf[tri[j]] == a && redirect.find(tri[j]) == redirect.end()) valid = false;
+            }
+        }
+
+        // Link condition: a and b may only share the neighbors opposite their
+        // common edge, otherwise the collapse pinches the surface
+        if (valid) {
+            neighborsOf(a, neighbors);
+            neighborsOf(b, shared);
+            size_t common = 0;
+            for (uint32_t n : neighbors) {
+                if (n != b && std::binary_search(shared.begin(), shared.end(), n)) common++;
+            }
+            valid = common <= sharedTriangles;
+        }
+
+        // Triangles that stay must not flip, fold steeply or degenerate
+        const simd_double3 target3 = simd_make_double3(classPosition[b].x, classPosition[b].y, classPosition[b].z);
+        for (size_t k = 0; valid && k < trianglesA.size(); ++k) {
+            const uint32_t* tri = &corners[trianglesA[k] * 3];
+            simd_double3 before[3], after[3];
+            bool hasB = false;
+            for (int j = 0; j < 3; ++j) {
+                const uint32_t c = classOf[tri[j]];
+                hasB = hasB || c == b;
+                before[j] = position(tri[j]);
+                after[j] = c == a ? target3 : before[j];
+            }
+            if (hasB) continue;
+            const simd_double3 n0 = simd_cross(before[1] - before[0], before[2] - before[0]);
+            const simd_double3 n1 = simd_cross(after[1] - after[0], after[2] - after[0]);
+            valid = simd_dot(n0, n1) > kMaxFold * simd_length(n0) * simd_length(n1);
+        }
+        if (!valid) {
+            continue;
+        }
+
+        // Apply: shared triangles vanish, the rest follow a onto b
+        for (uint32_t t : trianglesA) {
+            uint32_t* tri = &corners[t * 3];
+            bool hasB = false;
+            for (int j = 0; j < 3; ++j) hasB = hasB || classOf[tri[j]] == b;
+            if (hasB) {
+                triangleAlive[t] = 0;
+                liveTriangles--;
+                continue;
+            }
+            for (int j = 0; j < 3; ++j) {
+                if (classOf[tri[j]] == a) tri[j] = redirect[tri[j]];
+            }
+            classTriangles[b].push_back(t);
+        }
+        classTriangles[a].clear();
+        classAlive[a] = 0;
+        quadrics[b] += quadrics[a];
+        weights[b] += weights[a];
+        versions[b]++;
+
+        liveTrianglesOf(b);
+        neighborsOf(b, neighbors);
+        for (uint32_t n : neighbors) {
+            push(n, b);
+        }
+    }
+
+    // Compact: keep the vertices the surviving triangles use, in order
+    std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+    std::vector<uint32_t> newIndices;
+    newIndices.reserve(liveTriangles * 3);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        if (triangleAlive[t]) {
+            newIndices.insert(newIndices.end(), corners.begin() + t * 3, corners.begin() + t * 3 + 3);
+        }
+    }
+    for (uint32_t index : newIndices) {
+        remap[index] = 0;
+    }
+    uint32_t kept = 0;
+    for (size_t i = 0; i < vertexCount; ++i) {
+        if (remap[i] != UINT32_MAX) remap[i] = kept++;
+    }
+
+    const bool hasNorms = normals_.size() == vertexCount;
+    const bool hasTexCoords = texCoords_.size() == vertexCount;
+    const bool hasColors = colors_.size() == vertexCount;
+    size_t next = 0;
+    for (size_t i = 0; i < vertexCount; ++i) {
+        if (remap[i] == UINT32_MAX) continue;
+        vertices_[next] = vertices_[i];
+        if (hasNorms) normals_[next] = normals_[i];
+        if (hasTexCoords) texCoords_[next] = texCoords_[i];
+        if (hasColors) colors_[next] = colors_[i];
+        next++;
+    }
+    vertices_.resize(kept);
+    if (hasNorms) normals_.resize(kept);
+    if (hasTexCoords) texCoords_.resize(kept);
+    if (hasColors) colors_.resize(kept);
+    for (uint32_t& index : newIndices) {
+        index = remap[index];
+    }
+    indices_ = std::move(newIndices);
+    return true;
+}
+
+// ============================================================================
+// Bulk Operations
+// ============================================================================
+
+void ofMesh::transform(const ofMatrix4x4& matrix) {
+    gpu_.invalidate();
+    const simd_float4x4 m = matrix.toSimd();
+    const bool affine = m.columns[0].w == 0.0f && m.columns[1].w == 0.0f &&
+                        m.columns[2].w == 0.0f && m.columns[3].w == 1.0f;
+    if (affine) {
+        ofTransformPoints(matrix, vertices_);
+    } else {
+        ofProjectPoints(matrix, vertices_);
+    }
+    ofTransformNormals(matrix, normals_);
+}
+
+bool ofMesh::getBounds(ofVec3f& min, ofVec3f& max) const {
+    if (vertices_.empty()) {
+        return false;
+    }
+
+    // Every change to the geometry bumps the GPU copy's version
+    if (boundsVersion_ != gpu_.getVersion()) {
+        computeBounds(&vertices_[0].x, vertices_.size(), 3, boundsMin_, boundsMax_);
+        boundsVersion_ = gpu_.getVersion();
+    }
+    min = boundsMin_;
+    max = boundsMax_;
+    return true;
+}
+
+bool ofMesh::getBoundingSphere(ofVec3f& center, float& radius) const {
+    ofVec3f min, max;
+    if (!getBounds(min, max)) {
+        return false;
+    }
+    boundingSphereFromBounds(min, max, center, radius);
+    return true;
+}
+
+ofVec3f ofMesh::getCentroid() const {
+    ofVec3f centroid(0, 0, 0);
+    if (vertices_.empty()) {
+        return centroid;
+    }
+
+    const float* data = &vertices_[0].x;
+    const vDSP_Length count = vertices_.size();
+    vDSP_meanv(data, 3, &centroid.x, count);
+    vDSP_meanv(data + 1, 3, &centroid.y, count);
+    vDSP_meanv(data + 2, 3, &centroid.z, count);
+    return centroid;
+}
+
+void ofMesh::fillColors(const ofColor& color) {
+    gpu_.invalidate();
+    colors_.assign(vertices_.size(), color);
+}
+
 // ============================================================================
 // Static Mesh Generators
 // ============================================================================
@@ -1155,7 +1733,731 @@ ofMesh ofMesh::icosphere(float radius, int subdivisions) {
 // File I/O (PLY / OBJ)
 // ============================================================================
 
+namespace {
+    // Accumulates work done by parallel parse tasks; the callback sees
+    // increasing fractions in 1% steps, one call at a time
+    class LoadProgress {
+    public:
+        LoadProgress(const std::function<void(float)>& callback, size_t total)
+            : callback_(callback), total_(std::max<size_t>(total, 1)) {
+        }
+
+        void advance(size_t amount) {
+            if (!callback_) return;
+            const size_t done = done_.fetch_add(amount, std::memory_order_relaxed) + amount;
+            const int percent = static_cast<int>(std::min<size_t>(done, total_) * 100 / total_);
+            std::lock_guard<std::mutex> lock(mutex_);
+            // 100% is reported by load() once the mesh is complete
+            if (percent > reported_ && percent < 100) {
+                reported_ = percent;
+                callback_(percent / 100.0f);
+            }
+        }
+
+    private:
+        const std::function<void(float)>& callback_;
+        const size_t total_;
+        std::atomic<size_t> done_{0};
+        std::mutex mutex_;
+        int reported_ = -1;
+    };
+
+    // ------------------------------------------------------------------------
+    // Text parsing (no locale, no allocation)
+    // ------------------------------------------------------------------------
+
+    inline bool isBlank(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    inline const char* skipBlanks(const char* p, const char* end) {
+        while (p < end && isBlank(*p)) ++p;
+        return p;
+    }
+
+    inline const char* skipToken(const char* p, const char* end) {
+        while (p < end && !isBlank(*p) && *p != '\n') ++p;
+        return p;
+    }
+
+    // Start of the line after p (end if p is on the last line)
+    inline const char* nextLine(const char* p, const char* end) {
+        const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+        return newline ? static_cast<const char*>(newline) + 1 : end;
+    }
+
+    // End of the line starting at p, without the newline
+    inline const char* lineEnd(const char* p, const char* next) {
+        return (next > p && next[-1] == '\n') ? next - 1 : next;
+    }
+
+    // Parse a decimal float at p (after blanks); out = 0 and p is returned
+    // unchanged if there is no number. Rare forms (nan, inf, hex) take strtof.
+    const char* parseFloat(const char* p, const char* end, float& out) {
+        static const double kPow10[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        p = skipBlanks(p, end);
+        const char* start = p;
+        const bool negative = p < end && *p == '-';
+        if (p < end && (*p == '-' || *p == '+')) ++p;
+
+        uint64_t mantissa = 0;
+        int digits = 0;         // Significant digits kept in mantissa
+        int exponent = 0;
+        bool any = false;
+        for (; p < end && isDigit(*p); ++p, any = true) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                digits += mantissa != 0;
+            } else {
+                exponent++;
+            }
+        }
+        if (p < end && *p == '.') {
+            for (++p; p < end && isDigit(*p); ++p, any = true) {
+                if (digits < 19) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    digits += mantissa != 0;
+                    exponent--;
+                }
+            }
+        }
+
+        if (!any || (p < end && (*p == 'x' || *p == 'X' || *p == 'n' || *p == 'N'))) {
+            char buffer[64];
+            const size_t length = std::min<size_t>(static_cast<size_t>(skipToken(start, end) - start),
+                                                   sizeof(buffer) - 1);
+            std::memcpy(buffer, start, length);
+            buffer[length] = '\0';
+            char* parsed = buffer;
+            out = std::strtof(buffer, &parsed);
+            return start + (parsed - buffer);
+        }
+
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            const char* q = p + 1;
+            const bool negativeExponent = q < end && *q == '-';
+            if (q < end && (*q == '-' || *q == '+')) ++q;
+            if (q < end && isDigit(*q)) {
+                int value = 0;
+                for (; q < end && isDigit(*q); ++q) {
+                    if (value < 10000) value = value * 10 + (*q - '0');
+                }
+                exponent += negativeExponent ? -value : value;
+                p = q;
+            }
+        }
+
+        double value = static_cast<double>(mantissa);
+        if (exponent != 0 && mantissa != 0) {
+            const int magnitude = exponent < 0 ? -exponent : exponent;
+            const double scale = magnitude <= 22 ? kPow10[magnitude] : std::pow(10.0, magnitude);
+            value = exponent < 0 ? value / scale : value * scale;
+        }
+        out = static_cast<float>(negative ? -value : value);
+        return p;
+    }
+
+    // Parse a decimal integer at p (no leading blanks); p is returned
+    // unchanged if there are no digits
+    inline const char* parseInt(const char* p, const char* end, int64_t& out) {
+        const char* start = p;
+        const bool negative = p < end && *p == '-';
+        if (p < end && (*p == '-' || *p == '+')) ++p;
+        if (p >= end || !isDigit(*p)) {
+            out = 0;
+            return start;
+        }
+        int64_t value = 0;
+        for (; p < end && isDigit(*p); ++p) {
+            value = value * 10 + (*p - '0');
+        }
+        out = negative ? -value : value;
+        return p;
+    }
+
+    // ------------------------------------------------------------------------
+    // OBJ
+    // ------------------------------------------------------------------------
+
+    // Text per parse task: large enough to amortize the task, small enough
+    // to keep every core busy on a multi-megabyte file
+    constexpr size_t kObjChunkBytes = 1 << 20;
+
+    // One face corner: 0-based position/texcoord/normal indices, -1 = none.
+    // Negative OBJ references are stored chunk-relative (bit k of relative)
+    // until pass 2 knows how many elements earlier chunks defined.
+    struct ObjCorner {
+        int32_t index[3];
+        uint32_t relative;
+    };
+
+    struct ObjChunk {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+
+        std::vector<ofVec3f> positions;
+        std::vector<ofVec2f> texCoords;
+        std::vector<ofVec3f> normals;
+        std::vector<ObjCorner> corners;
+        std::vector<int32_t> faceSizes;     // Negative = dropped face
+
+        size_t base[3] = {0, 0, 0};         // Elements defined by earlier chunks
+        size_t vertexOffset = 0;            // First output vertex
+        size_t indexOffset = 0;             // First output index
+        size_t numVertices = 0;             // Corners of kept faces
+        size_t numIndices = 0;              // Fan-triangulated indices
+        bool usesTexCoords = false;
+        bool usesNormals = false;
+    };
+
+    void parseObjChunk(ObjChunk& chunk) {
+        for (const char* line = chunk.begin; line < chunk.end;) {
+            const char* next = nextLine(line, chunk.end);
+            const char* end = lineEnd(line, next);
+            const char* p = skipBlanks(line, end);
+            line = next;
+            if (end - p < 2) {
+                continue;
+            }
+
+            if (p[0] == 'v' && isBlank(p[1])) {
+                ofVec3f v;
+                p = parseFloat(p + 2, end, v.x);
+                p = parseFloat(p, end, v.y);
+                parseFloat(p, end, v.z);
+                chunk.positions.push_back(v);
+            } else if (p[0] == 'v' && p[1] == 't' && (end - p == 2 || isBlank(p[2]))) {
+                ofVec2f t;
+                p = parseFloat(p + 2, end, t.x);
+                parseFloat(p, end, t.y);
+                chunk.texCoords.push_back(t);
+            } else if (p[0] == 'v' && p[1] == 'n' && (end - p == 2 || isBlank(p[2]))) {
+                ofVec3f n;
+                p = parseFloat(p + 2, end, n.x);
+                p = parseFloat(p, end, n.y);
+                parseFloat(p, end, n.z);
+                chunk.normals.push_back(n);
+            } else if (p[0] == 'f' && isBlank(p[1])) {
+                // Corners: v, v/vt, v//vn or v/vt/vn
+                const size_t counts[3] = {chunk.positions.size(), chunk.texCoords.size(),
+                                          chunk.normals.size()};
+                const size_t first = chunk.corners.size();
+                bool valid = true;
+                p += 2;
+                while (true) {
+                    p = skipBlanks(p, end);
+                    if (p >= end || *p == '#') break;
+
+                    ObjCorner corner = {{-1, -1, -1}, 0};
+                    for (int k = 0; k < 3; k++) {
+                        if (k > 0) {
+                            if (p >= end || *p != '/') break;
+                            ++p;
+                        }
+                        int64_t value;
+                        const char* q = parseInt(p, end, value);
+                        if (q == p) continue;
+                        p = q;
+                        if (value > 0) {
+                            corner.index[k] = static_cast<int32_t>(value - 1);
+                        } else if (value < 0) {
+                            corner.index[k] = static_cast<int32_t>(static_cast<int64_t>(counts[k]) + value);
+                            corner.relative |= 1u << k;
+                        }
+                    }
+                    p = skipToken(p, end);
+
+                    valid = valid && (corner.index[0] >= 0 || (corner.relative & 1u));
+                    chunk.usesTexCoords = chunk.usesTexCoords || corner.index[1] >= 0 || (corner.relative & 2u);
+                    chunk.usesNormals = chunk.usesNormals || corner.index[2] >= 0 || (corner.relative & 4u);
+                    chunk.corners.push_back(corner);
+                }
+
+                const size_t size = chunk.corners.size() - first;
+                if (valid && size >= 3) {
+                    chunk.faceSizes.push_back(static_cast<int32_t>(size));
+                } else {
+                    chunk.corners.resize(first);
+                }
+            }
+        }
+    }
+
+    // Resolve relative references and drop faces pointing outside the file
+    void resolveObjChunk(ObjChunk& chunk, const size_t totals[3]) {
+        ObjCorner* corner = chunk.corners.data();
+        for (int32_t& size : chunk.faceSizes) {
+            bool valid = true;
+            for (int32_t i = 0; i < size; i++) {
+                for (int k = 0; k < 3; k++) {
+                    int64_t index = corner[i].index[k];
+                    if (corner[i].relative & (1u << k)) {
+                        index += static_cast<int64_t>(chunk.base[k]);
+                    }
+                    if (index < 0 || index >= static_cast<int64_t>(totals[k])) {
+                        index = -1;
+                    }
+                    corner[i].index[k] = static_cast<int32_t>(index);
+                }
+                valid = valid && corner[i].index[0] >= 0;
+            }
+            corner += size;
+            if (valid) {
+                chunk.numVertices += static_cast<size_t>(size);
+                chunk.numIndices += static_cast<size_t>(size - 2) * 3;
+            } else {
+                size = -size;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // PLY
+    // ------------------------------------------------------------------------
+
+    constexpr bool kHostLittleEndian = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+    enum class PlyType { None, Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
+
+    PlyType plyTypeFromName(const std::string& name) {
+        if (name == "char" || name == "int8") return PlyType::Int8;
+        if (name == "uchar" || name == "uint8") return PlyType::UInt8;
+        if (name == "short" || name == "int16") return PlyType::Int16;
+        if (name == "ushort" || name == "uint16") return PlyType::UInt16;
+        if (name == "int" || name == "int32") return PlyType::Int32;
+        if (name == "uint" || name == "uint32") return PlyType::UInt32;
+        if (name == "float" || name == "float32") return PlyType::Float32;
+        if (name == "double" || name == "float64") return PlyType::Float64;
+        return PlyType::None;
+    }
+
+    size_t plyTypeSize(PlyType type) {
+        switch (type) {
+            case PlyType::Int8: case PlyType::UInt8: return 1;
+            case PlyType::Int16: case PlyType::UInt16: return 2;
+            case PlyType::Int32: case PlyType::UInt32: case PlyType::Float32: return 4;
+            case PlyType::Float64: return 8;
+            case PlyType::None: break;
+        }
+        return 0;
+    }
+
+    template <typename T>
+    inline T readPlyScalar(const char* p, bool swap) {
+        uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, p, sizeof(T));
+        if (swap) {
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    double readPlyValue(const char* p, PlyType type, bool swap) {
+        switch (type) {
+            case PlyType::Int8: return readPlyScalar<int8_t>(p, swap);
+            case PlyType::UInt8: return readPlyScalar<uint8_t>(p, swap);
+            case PlyType::Int16: return readPlyScalar<int16_t>(p, swap);
+            case PlyType::UInt16: return readPlyScalar<uint16_t>(p, swap);
+            case PlyType::Int32: return readPlyScalar<int32_t>(p, swap);
+            case PlyType::UInt32: return readPlyScalar<uint32_t>(p, swap);
+            case PlyType::Float32: return readPlyScalar<float>(p, swap);
+            case PlyType::Float64: return readPlyScalar<double>(p, swap);
+            case PlyType::None: break;
+        }
+        return 0.0;
+    }
+
+    // Color channel in 0-255 from a property value of the given type
+    inline uint8_t plyColorChannel(double value, PlyType type) {
+        if (type == PlyType::Float32 || type == PlyType::Float64) {
+            value *= 255.0;
+        } else if (type == PlyType::UInt16 || type == PlyType::Int16) {
+            value /= 257.0;
+        }
+        return static_cast<uint8_t>(std::min(255.0, std::max(0.0, value + 0.5)));
+    }
+
+    // Vertex attribute a property feeds
+    enum PlyRole {
+        kPlyX, kPlyY, kPlyZ, kPlyNX, kPlyNY, kPlyNZ, kPlyU, kPlyV,
+        kPlyRed, kPlyGreen, kPlyBlue, kPlyAlpha, kPlyRoleCount, kPlyIgnored = kPlyRoleCount
+    };
+
+    int plyRoleFromName(const std::string& name) {
+        static const char* const kNames[][3] = {
+            {"x", nullptr, nullptr}, {"y", nullptr, nullptr}, {"z", nullptr, nullptr},
+            {"nx", nullptr, nullptr}, {"ny", nullptr, nullptr}, {"nz", nullptr, nullptr},
+            {"u", "s", "texture_u"}, {"v", "t", "texture_v"},
+            {"red", "r", "diffuse_red"}, {"green", "g", "diffuse_green"},
+            {"blue", "b", "diffuse_blue"}, {"alpha", "a", "diffuse_alpha"},
+        };
+        for (int role = 0; role < kPlyRoleCount; role++) {
+            for (const char* alias : kNames[role]) {
+                if (alias && name == alias) return role;
+            }
+        }
+        return kPlyIgnored;
+    }
+
+    struct PlyProperty {
+        std::string name;
+        PlyType type = PlyType::None;       // Item type for lists
+        PlyType countType = PlyType::None;  // Set for list properties
+        size_t offset = 0;                  // Byte offset (binary, fixed-size elements)
+        int role = kPlyIgnored;
+    };
+
+    struct PlyElement {
+        std::string name;
+        size_t count = 0;
+        std::vector<PlyProperty> properties;
+        size_t stride = 0;                  // Bytes per record (binary, no lists)
+        bool hasLists = false;
+    };
+
+    struct PlyHeader {
+        enum Format { Ascii, BinaryLittleEndian, BinaryBigEndian } format = Ascii;
+        std::vector<PlyElement> elements;
+        const char* body = nullptr;
+    };
+
+    bool parsePlyHeader(const char* begin, const char* end, PlyHeader& header) {
+        const char* line = begin;
+        {
+            const char* next = nextLine(line, end);
+            const char* last = lineEnd(line, next);
+            while (last > line && isBlank(last[-1])) --last;
+            if (std::string(line, last) != "ply") return false;
+            line = next;
+        }
+
+        bool hasFormat = false;
+        while (line < end) {
+            const char* next = nextLine(line, end);
+            std::istringstream iss(std::string(line, lineEnd(line, next)));
+            line = next;
+
+            std::string keyword;
+            iss >> keyword;
+            if (keyword == "format") {
+                std::string format;
+                iss >> format;
+                if (format == "ascii") header.format = PlyHeader::Ascii;
+                else if (format == "binary_little_endian") header.format = PlyHeader::BinaryLittleEndian;
+                else if (format == "binary_big_endian") header.format = PlyHeader::BinaryBigEndian;
+                else return false;
+                hasFormat = true;
+            } else if (keyword == "element") {
+                PlyElement element;
+                iss >> element.name >> element.count;
+                if (!iss) return false;
+                header.elements.push_back(element);
+            } else if (keyword == "property") {
+                if (header.elements.empty()) return false;
+                PlyElement& element = header.elements.back();
+                PlyProperty property;
+                std::string type;
+                iss >> type;
+                if (type == "list") {
+                    std::string countType, itemType;
+                    iss >> countType >> itemType;
+                    property.countType = plyTypeFromName(countType);
+                    property.type = plyTypeFromName(itemType);
+                    if (property.countType == PlyType::None) return false;
+                    element.hasLists = true;
+                } else {
+                    property.type = plyTypeFromName(type);
+                    property.offset = element.stride;
+                    element.stride += plyTypeSize(property.type);
+                }
+                iss >> property.name;
+                if (!iss || property.type == PlyType::None) return false;
+                property.role = property.countType == PlyType::None ? plyRoleFromName(property.name)
+                                                                     : kPlyIgnored;
+                element.properties.push_back(property);
+            } else if (keyword == "end_header") {
+                header.body = line;
+                return hasFormat;
+            }
+        }
+        return false;
+    }
+
+    inline bool isPlyFaceList(const PlyProperty& property) {
+        return property.countType != PlyType::None &&
+               (property.name == "vertex_indices" || property.name == "vertex_index");
+    }
+
+    // Fan-triangulate one face, skipping faces that index past the vertices
+    inline void addPlyFace(std::vector<uint32_t>& indices, const uint32_t* face, size_t size,
+                           size_t numVertices) {
+        if (size < 3) return;
+        for (size_t i = 0; i < size; i++) {
+            if (face[i] >= numVertices) return;
+        }
+        for (size_t i = 1; i + 1 < size; i++) {
+            indices.push_back(face[0]);
+            indices.push_back(face[i]);
+            indices.push_back(face[i + 1]);
+        }
+    }
+
+    // Read the vertex records into the mesh arrays; returns the end of the
+    // records, nullptr if they are truncated or have no positions.
+    // ASCII records are located with a memchr scan and parsed in parallel;
+    // binary records are read by offset in parallel, with little-endian xyz
+    // and normal floats copied as-is (the whole element in one memcpy for
+    // position-only files).
+    const char* readPlyVertices(const PlyElement& element, const char* p, const char* end,
+                                PlyHeader::Format format, std::vector<ofVec3f>& vertices,
+                                std::vector<ofVec3f>& normals, std::vector<ofVec2f>& texCoords,
+                                std::vector<ofColor>& colors, LoadProgress& progress) {
+        const PlyProperty* roles[kPlyRoleCount] = {};
+        for (const PlyProperty& property : element.properties) {
+            if (property.role != kPlyIgnored) {
+                roles[property.role] = &property;
+            }
+        }
+        if (!roles[kPlyX] || !roles[kPlyY] || !roles[kPlyZ]) {
+            return nullptr;
+        }
+        const bool hasNormals = roles[kPlyNX] && roles[kPlyNY] && roles[kPlyNZ];
+        const bool hasTexCoords = roles[kPlyU] && roles[kPlyV];
+        const bool hasColors = roles[kPlyRed] && roles[kPlyGreen] && roles[kPlyBlue];
+
+        const size_t count = element.count;
+        vertices.resize(count);
+        if (hasNormals) normals.resize(count);
+        if (hasTexCoords) texCoords.resize(count);
+        if (hasColors) colors.resize(count);
+
+        auto store = [&](size_t i, const float* fields) {
+            vertices[i] = ofVec3f(fields[kPlyX], fields[kPlyY], fields[kPlyZ]);
+            if (hasNormals) normals[i] = ofVec3f(fields[kPlyNX], fields[kPlyNY], fields[kPlyNZ]);
+            if (hasTexCoords) texCoords[i] = ofVec2f(fields[kPlyU], fields[kPlyV]);
+            if (hasColors) {
+                colors[i] = ofColor(plyColorChannel(fields[kPlyRed], roles[kPlyRed]->type),
+                                    plyColorChannel(fields[kPlyGreen], roles[kPlyGreen]->type),
+                                    plyColorChannel(fields[kPlyBlue], roles[kPlyBlue]->type),
+                                    roles[kPlyAlpha] ? plyColorChannel(fields[kPlyAlpha], roles[kPlyAlpha]->type)
+                                                     : 255);
+            }
+        };
+
+        if (format == PlyHeader::Ascii) {
+            std::vector<const char*> lines(count + 1);
+            for (size_t i = 0; i < count; i++) {
+                if (p >= end) return nullptr;
+                lines[i] = p;
+                p = nextLine(p, end);
+            }
+            lines[count] = p;
+
+            const size_t bytes = static_cast<size_t>(p - lines[0]);
+            parallelChunks(count, [&](size_t begin, size_t last) {
+                for (size_t i = begin; i < last; i++) {
+                    const char* q = lines[i];
+                    const char* qEnd = lineEnd(q, lines[i + 1]);
+                    float fields[kPlyRoleCount] = {};
+                    for (const PlyProperty& property : element.properties) {
+                        float value;
+                        q = parseFloat(q, qEnd, value);
+                        if (property.countType != PlyType::None) {
+                            for (int j = 0; j < static_cast<int>(value); j++) {
+                                float skipped;
+                                q = parseFloat(q, qEnd, skipped);
+                            }
+                        } else if (property.role != kPlyIgnored) {
+                            fields[property.role] = value;
+                        }
+                    }
+                    store(i, fields);
+                }
+                progress.advance(bytes * (last - begin) / count);
+            });
+            return p;
+        }
+
+        // Variable-length vertex records don't occur in practice
+        if (element.hasLists || count > static_cast<size_t>(end - p) / std::max<size_t>(element.stride, 1)) {
+            return nullptr;
+        }
+
+        const bool swap = (format == PlyHeader::BinaryBigEndian) == kHostLittleEndian;
+        auto isPackedFloat3 = [&](int first) {
+            return !swap && roles[first]->type == PlyType::Float32 &&
+                   roles[first + 1]->type == PlyType::Float32 && roles[first + 2]->type == PlyType::Float32 &&
+                   roles[first + 1]->offset == roles[first]->offset + 4 &&
+                   roles[first + 2]->offset == roles[first]->offset + 8;
+        };
+        const bool packedPositions = isPackedFloat3(kPlyX);
+        const bool packedNormals = hasNormals && isPackedFloat3(kPlyNX);
+        const size_t stride = element.stride;
+
+        if (packedPositions && stride == sizeof(ofVec3f)) {
+            std::memcpy(vertices.data(), p, count * sizeof(ofVec3f));
+            progress.advance(count * stride);
+            return p + count * stride;
+        }
+
+        parallelChunks(count, [&](size_t begin, size_t last) {
+            for (size_t i = begin; i < last; i++) {
+                const char* record = p + i * stride;
+                float fields[kPlyRoleCount] = {};
+                for (int role = 0; role < kPlyRoleCount; role++) {
+                    const bool copied = (packedPositions && role <= kPlyZ) ||
+                                        (packedNormals && role >= kPlyNX && role <= kPlyNZ);
+                    if (roles[role] && !copied) {
+                        fields[role] = static_cast<float>(readPlyValue(record + roles[role]->offset,
+                                                                       roles[role]->type, swap));
+                    }
+                }
+                store(i, fields);
+                if (packedPositions) {
+                    std::memcpy(&vertices[i], record + roles[kPlyX]->offset, sizeof(ofVec3f));
+                }
+                if (packedNormals) {
+                    std::memcpy(&normals[i], record + roles[kPlyNX]->offset, sizeof(ofVec3f));
+                }
+            }
+            progress.advance((last - begin) * stride);
+        });
+        return p + count * stride;
+    }
+
+    // Read the face lists as fan-triangulated indices; returns the end of
+    // the records, nullptr if they are truncated. Lists vary in length, so
+    // faces are read in order.
+    const char* readPlyFaces(const PlyElement& element, const char* p, const char* end,
+                             PlyHeader::Format format, size_t numVertices,
+                             std::vector<uint32_t>& indices, LoadProgress& progress) {
+        constexpr size_t kProgressFaces = 65536;
+        const bool swap = (format == PlyHeader::BinaryBigEndian) == kHostLittleEndian;
+        std::vector<uint32_t> face;
+        indices.reserve(element.count * 3);
+
+        const char* reported = p;
+        for (size_t i = 0; i < element.count; i++) {
+            if (p >= end) return nullptr;
+            face.clear();
+
+            if (format == PlyHeader::Ascii) {
+                const char* next = nextLine(p, end);
+                const char* q = p;
+                const char* qEnd = lineEnd(p, next);
+                for (const PlyProperty& property : element.properties) {
+                    if (property.countType == PlyType::None) {
+                        q = skipToken(skipBlanks(q, qEnd), qEnd);
+                        continue;
+                    }
+                    int64_t size;
+                    q = parseInt(skipBlanks(q, qEnd), qEnd, size);
+                    for (int64_t j = 0; j < size; j++) {
+                        int64_t index;
+                        q = skipBlanks(q, qEnd);
+                        const char* parsed = parseInt(q, qEnd, index);
+                        if (parsed == q) {
+                            break;
+                        }
+                        q = parsed;
+                        if (isPlyFaceList(property)) {
+                            face.push_back(index < 0 ? UINT32_MAX : static_cast<uint32_t>(index));
+                        }
+                    }
+                    if (isPlyFaceList(property) && face.size() != static_cast<size_t>(std::max<int64_t>(size, 0))) {
+                        face.clear();   // Truncated line
+                    }
+                }
+                p = next;
+            } else {
+                for (const PlyProperty& property : element.properties) {
+                    const size_t itemSize = plyTypeSize(property.type);
+                    if (property.countType == PlyType::None) {
+                        if (itemSize > static_cast<size_t>(end - p)) return nullptr;
+                        p += itemSize;
+                        continue;
+                    }
+                    const size_t countSize = plyTypeSize(property.countType);
+                    if (countSize > static_cast<size_t>(end - p)) return nullptr;
+                    const size_t size = static_cast<size_t>(std::max(0.0, readPlyValue(p, property.countType, swap)));
+                    p += countSize;
+                    if (size > static_cast<size_t>(end - p) / itemSize) return nullptr;
+
+                    if (isPlyFaceList(property)) {
+                        face.resize(size);
+                        if (!swap && (property.type == PlyType::Int32 || property.type == PlyType::UInt32)) {
+                            std::memcpy(face.data(), p, size * sizeof(uint32_t));
+                        } else {
+                            for (size_t j = 0; j < size; j++) {
+                                face[j] = static_cast<uint32_t>(readPlyValue(p + j * itemSize, property.type, swap));
+                            }
+                        }
+                    }
+                    p += size * itemSize;
+                }
+            }
+
+            addPlyFace(indices, face.data(), face.size(), numVertices);
+            if ((i + 1) % kProgressFaces == 0) {
+                progress.advance(static_cast<size_t>(p - reported));
+                reported = p;
+            }
+        }
+        progress.advance(static_cast<size_t>(p - reported));
+        return p;
+    }
+
+    // Step over an element the mesh doesn't use; nullptr if truncated
+    const char* skipPlyElement(const PlyElement& element, const char* p, const char* end,
+                               PlyHeader::Format format) {
+        if (format == PlyHeader::Ascii) {
+            for (size_t i = 0; i < element.count; i++) {
+                if (p >= end) return nullptr;
+                p = nextLine(p, end);
+            }
+            return p;
+        }
+        if (!element.hasLists) {
+            if (element.stride > 0 && element.count > static_cast<size_t>(end - p) / element.stride) {
+                return nullptr;
+            }
+            return p + element.count * element.stride;
+        }
+
+        const bool swap = (format == PlyHeader::BinaryBigEndian) == kHostLittleEndian;
+        for (size_t i = 0; i < element.count; i++) {
+            for (const PlyProperty& property : element.properties) {
+                size_t bytes = plyTypeSize(property.type);
+                if (property.countType != PlyType::None) {
+                    const size_t countSize = plyTypeSize(property.countType);
+                    if (countSize > static_cast<size_t>(end - p)) return nullptr;
+                    bytes *= static_cast<size_t>(std::max(0.0, readPlyValue(p, property.countType, swap)));
+                    p += countSize;
+                }
+                if (bytes > static_cast<size_t>(end - p)) return nullptr;
+                p += bytes;
+            }
+        }
+        return p;
+    }
+}
+
 bool ofMesh::load(const std::string& filename) {
+    return load(filename, nullptr);
+}
+
+bool ofMesh::load(const std::string& filename, const std::function<void(float)>& progress) {
+    gpu_.invalidate();
     // Determine file format by extension
     std::string ext;
     size_t dotPos = filename.find_last_of('.');
@@ -1164,14 +2466,49 @@ bool ofMesh::load(const std::string& filename) {
         std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
     }
 
+    bool loaded = false;
     if (ext == "obj") {
-        return loadOBJ(filename);
+        loaded = loadOBJ(filename, progress);
     } else if (ext == "ply") {
-        return loadPLY(filename);
+        loaded = loadPLY(filename, progress);
+    } else if (ext == "oflmesh") {
+        loaded = loadCache(filename, progress);
     }
 
-    // Unsupported format
-    return false;
+    if (loaded && progress) {
+        progress(1.0f);
+    }
+    return loaded;
+}
+
+void ofMesh::loadAsync(const std::string& filename,
+                       std::function<void(ofMesh& mesh, bool loaded)> callback,
+                       std::function<void(float progress)> progress) {
+    struct Job {
+        std::string filename;
+        std::function<void(ofMesh&, bool)> callback;
+        std::function<void(float)> progress;
+        ofMesh mesh;
+        bool loaded = false;
+    };
+
+    Job* job = new Job();
+    job->filename = filename;
+    job->callback = std::move(callback);
+    job->progress = std::move(progress);
+
+    dispatch_async_f(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), job, [](void* context) {
+        Job* job = static_cast<Job*>(context);
+        job->loaded = job->mesh.load(job->filename, job->progress);
+
+        // Hand the mesh over between frames, where setup()/update() run
+        dispatch_async_f(dispatch_get_main_queue(), job, [](void* context) {
+            std::unique_ptr<Job> job(static_cast<Job*>(context));
+            if (job->callback) {
+                job->callback(job->mesh, job->loaded);
+            }
+        });
+    });
 }
 
 bool ofMesh::save(const std::string& filename) const {
@@ -1187,6 +2524,8 @@ bool ofMesh::save(const std::string& filename) const {
         return saveOBJ(filename);
     } else if (ext == "ply") {
         return savePLY(filename);
+    } else if (ext == "oflmesh") {
+        return saveCache(filename);
     }
 
     // Unsupported format
@@ -1194,112 +2533,130 @@ bool ofMesh::save(const std::string& filename) const {
 }
 
 // Helper: Load OBJ file
-bool ofMesh::loadOBJ(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+// Pass 1 parses line-aligned chunks of the mapped file in parallel. Pass 2
+// resolves face references against the concatenated arrays, and pass 3
+// writes each chunk's corners and triangles at its prefix-sum offsets.
+bool ofMesh::loadOBJ(const std::string& filename, const std::function<void(float)>& progress) {
+    const ofBuffer file = ofBufferMapFile(filename);
+    if (!file.isAllocated()) {
         return false;
     }
 
     clear();
+    mode_ = OF_PRIMITIVE_TRIANGLES;
+
+    // Pass 1 is most of the work; passes 2 and 3 count for a quarter
+    LoadProgress reporter(progress, file.size() + file.size() / 4);
+
+    const size_t numChunks = std::max<size_t>(1, file.size() / kObjChunkBytes);
+    const size_t chunkBytes = file.size() / numChunks;
+    std::vector<ObjChunk> chunks(numChunks);
+    const char* start = file.begin();
+    for (size_t i = 0; i < numChunks; i++) {
+        const char* end = file.end();
+        if (i + 1 < numChunks) {
+            end = std::max(start, nextLine(file.begin() + (i + 1) * chunkBytes, file.end()));
+        }
+        chunks[i].begin = start;
+        chunks[i].end = end;
+        start = end;
+    }
+
+    parallelFor(numChunks, [&](size_t i) {
+        parseObjChunk(chunks[i]);
+        reporter.advance(static_cast<size_t>(chunks[i].end - chunks[i].begin));
+    });
+
+    size_t totals[3] = {0, 0, 0};
+    size_t numFaces = 0;
+    for (ObjChunk& chunk : chunks) {
+        chunk.base[0] = totals[0];
+        chunk.base[1] = totals[1];
+        chunk.base[2] = totals[2];
+        totals[0] += chunk.positions.size();
+        totals[1] += chunk.texCoords.size();
+        totals[2] += chunk.normals.size();
+        numFaces += chunk.faceSizes.size();
+    }
+
+    std::vector<ofVec3f> positions(totals[0]);
+    std::vector<ofVec2f> texCoords(totals[1]);
+    std::vector<ofVec3f> normals(totals[2]);
+    parallelFor(numChunks, [&](size_t i) {
+        ObjChunk& chunk = chunks[i];
+        std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + chunk.base[0]);
+        std::copy(chunk.texCoords.begin(), chunk.texCoords.end(), texCoords.begin() + chunk.base[1]);
+        std::copy(chunk.normals.begin(), chunk.normals.end(), normals.begin() + chunk.base[2]);
+        std::vector<ofVec3f>().swap(chunk.positions);
+        std::vector<ofVec2f>().swap(chunk.texCoords);
+        std::vector<ofVec3f>().swap(chunk.normals);
+        resolveObjChunk(chunk, totals);
+    });
+
+    // A file without faces is a point cloud
+    if (numFaces == 0) {
+        vertices_ = std::move(positions);
+        if (normals.size() == vertices_.size()) {
+            normals_ = std::move(normals);
+        }
+        if (!vertices_.empty()) {
+            mode_ = OF_PRIMITIVE_POINTS;
+        }
+        return true;
+    }
 
-    std::vector<ofVec3f> tempVertices;
-    std::vector<ofVec3f> tempNormals;
-    std::vector<ofVec2f> tempTexCoords;
-
-    std::string line;
-    while (std::getline(file, line)) {
-        std::istringstream iss(line);
-        std::string type;
-        iss >> type;
-
-        if (type == "v") {
-            // Vertex position
-            float x, y, z;
-            iss >> x >> y >> z;
-            tempVertices.push_back(ofVec3f(x, y, z));
-        } else if (type == "vn") {
-            // Vertex normal
-            float x, y, z;
-            iss >> x >> y >> z;
-            tempNormals.push_back(ofVec3f(x, y, z));
-        } else if (type == "vt") {
-            // Texture coordinate
-            float u, v;
-            iss >> u >> v;
-            tempTexCoords.push_back(ofVec2f(u, v));
-        } else if (type == "f") {
-            // Face (triangle)
-            // Format: f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3
-            // or: f v1//vn1 v2//vn2 v3//vn3
-            // or: f v1/vt1 v2/vt2 v3/vt3
-            // or: f v1 v2 v3
-
-            std::vector<int> vIndices, vtIndices, vnIndices;
-            std::string vertex;
-
-            while (iss >> vertex) {
-                int vIdx = 0, vtIdx = 0, vnIdx = 0;
-                size_t slash1 = vertex.find('/');
-
-                if (slash1 == std::string::npos) {
-                    // Format: v
-                    vIdx = std::stoi(vertex);
-                } else {
-                    vIdx = std::stoi(vertex.substr(0, slash1));
-                    size_t slash2 = vertex.find('/', slash1 + 1);
-
-                    if (slash2 == std::string::npos) {
-                        // Format: v/vt
-                        vtIdx = std::stoi(vertex.substr(slash1 + 1));
-                    } else {
-                        // Format: v/vt/vn or v//vn
-                        if (slash2 > slash1 + 1) {
-                            vtIdx = std::stoi(vertex.substr(slash1 + 1, slash2 - slash1 - 1));
-                        }
-                        if (slash2 + 1 < vertex.length()) {
-                            vnIdx = std::stoi(vertex.substr(slash2 + 1));
-                        }
-                    }
-                }
-
-                vIndices.push_back(vIdx);
-                vtIndices.push_back(vtIdx);
-                vnIndices.push_back(vnIdx);
+    size_t numVertices = 0;
+    size_t numIndices = 0;
+    bool hasTexCoords = false;
+    bool hasNormals = false;
+    for (ObjChunk& chunk : chunks) {
+        chunk.vertexOffset = numVertices;
+        chunk.indexOffset = numIndices;
+        numVertices += chunk.numVertices;
+        numIndices += chunk.numIndices;
+        hasTexCoords = hasTexCoords || chunk.usesTexCoords;
+        hasNormals = hasNormals || chunk.usesNormals;
+    }
+    hasTexCoords = hasTexCoords && !texCoords.empty();
+    hasNormals = hasNormals && !normals.empty();
+
+    // Every face corner becomes its own vertex (weldVertices() shares them);
+    // corners without a texcoord or normal get zero
+    vertices_.resize(numVertices);
+    if (hasTexCoords) texCoords_.resize(numVertices);
+    if (hasNormals) normals_.resize(numVertices);
+    indices_.resize(numIndices);
+
+    parallelFor(numChunks, [&](size_t i) {
+        const ObjChunk& chunk = chunks[i];
+        const ObjCorner* corner = chunk.corners.data();
+        size_t vertex = chunk.vertexOffset;
+        uint32_t* index = indices_.data() + chunk.indexOffset;
+        for (int32_t size : chunk.faceSizes) {
+            if (size < 0) {
+                corner += -size;
+                continue;
             }
-
-            // OBJ indices are 1-based, convert to 0-based
-            // Add vertices for this face
-            for (size_t i = 0; i < vIndices.size(); ++i) {
-                int vIdx = vIndices[i] - 1;
-                int vtIdx = vtIndices[i] - 1;
-                int vnIdx = vnIndices[i] - 1;
-
-                if (vIdx >= 0 && vIdx < static_cast<int>(tempVertices.size())) {
-                    addVertex(tempVertices[vIdx]);
+            const uint32_t first = static_cast<uint32_t>(vertex);
+            for (int32_t j = 0; j < size; j++, corner++, vertex++) {
+                vertices_[vertex] = positions[corner->index[0]];
+                if (hasTexCoords && corner->index[1] >= 0) {
+                    texCoords_[vertex] = texCoords[corner->index[1]];
                 }
-                if (vtIdx >= 0 && vtIdx < static_cast<int>(tempTexCoords.size())) {
-                    addTexCoord(tempTexCoords[vtIdx]);
-                }
-                if (vnIdx >= 0 && vnIdx < static_cast<int>(tempNormals.size())) {
-                    addNormal(tempNormals[vnIdx]);
+                if (hasNormals && corner->index[2] >= 0) {
+                    normals_[vertex] = normals[corner->index[2]];
                 }
             }
-
-            // Triangulate if needed (for quads/n-gons)
-            if (vIndices.size() == 3) {
-                // Triangle
-                uint32_t base = static_cast<uint32_t>(getNumVertices()) - 3;
-                addTriangle(base, base + 1, base + 2);
-            } else if (vIndices.size() == 4) {
-                // Quad -> two triangles
-                uint32_t base = static_cast<uint32_t>(getNumVertices()) - 4;
-                addTriangle(base, base + 1, base + 2);
-                addTriangle(base, base + 2, base + 3);
+            // Fan triangulation (quads split along their first diagonal)
+            for (int32_t j = 1; j + 1 < size; j++) {
+                *index++ = first;
+                *index++ = first + static_cast<uint32_t>(j);
+                *index++ = first + static_cast<uint32_t>(j + 1);
             }
         }
-    }
+        reporter.advance(static_cast<size_t>(chunk.end - chunk.begin) / 4);
+    });
 
-    file.close();
     return true;
 }
 
@@ -1380,107 +2737,47 @@ bool ofMesh::saveOBJ(const std::string& filename) const {
     return true;
 }
 
-// Helper: Load PLY file (ASCII format only)
-bool ofMesh::loadPLY(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+// Helper: Load PLY file (ASCII, binary little or big endian)
+bool ofMesh::loadPLY(const std::string& filename, const std::function<void(float)>& progress) {
+    const ofBuffer file = ofBufferMapFile(filename);
+    if (!file.isAllocated()) {
         return false;
     }
 
-    clear();
-
-    std::string line;
-    bool inHeader = true;
-    int numVertices = 0;
-    int numFaces = 0;
-    bool hasNormals = false;
-    bool hasTexCoords = false;
-    bool hasColors = false;
-
-    // Parse header
-    while (std::getline(file, line) && inHeader) {
-        std::istringstream iss(line);
-        std::string keyword;
-        iss >> keyword;
-
-        if (keyword == "element") {
-            std::string type;
-            int count;
-            iss >> type >> count;
-            if (type == "vertex") {
-                numVertices = count;
-            } else if (type == "face") {
-                numFaces = count;
-            }
-        } else if (keyword == "property") {
-            std::string propType, propName;
-            iss >> propType >> propName;
-            if (propName == "nx" || propName == "ny" || propName == "nz") {
-                hasNormals = true;
-            } else if (propName == "s" || propName == "t" || propName == "u" || propName == "v") {
-                hasTexCoords = true;
-            } else if (propName == "red" || propName == "green" || propName == "blue") {
-                hasColors = true;
-            }
-        } else if (keyword == "end_header") {
-            inHeader = false;
-        }
+    PlyHeader header;
+    if (!parsePlyHeader(file.begin(), file.end(), header)) {
+        return false;
     }
 
-    // Read vertices
-    for (int i = 0; i < numVertices; ++i) {
-        if (!std::getline(file, line)) break;
-        std::istringstream iss(line);
-
-        float x, y, z;
-        iss >> x >> y >> z;
-        addVertex(ofVec3f(x, y, z));
-
-        if (hasNormals) {
-            float nx, ny, nz;
-            iss >> nx >> ny >> nz;
-            addNormal(ofVec3f(nx, ny, nz));
-        }
-
-        if (hasTexCoords) {
-            float u, v;
-            iss >> u >> v;
-            addTexCoord(ofVec2f(u, v));
+    clear();
+    mode_ = OF_PRIMITIVE_TRIANGLES;
+
+    LoadProgress reporter(progress, file.size());
+    reporter.advance(static_cast<size_t>(header.body - file.begin()));
+
+    const char* p = header.body;
+    bool hasFaces = false;
+    for (const PlyElement& element : header.elements) {
+        if (element.name == "vertex" && vertices_.empty()) {
+            p = readPlyVertices(element, p, file.end(), header.format,
+                                vertices_, normals_, texCoords_, colors_, reporter);
+        } else if (element.name == "face") {
+            p = readPlyFaces(element, p, file.end(), header.format, vertices_.size(), indices_, reporter);
+            hasFaces = true;
+        } else {
+            p = skipPlyElement(element, p, file.end(), header.format);
         }
 
-        if (hasColors) {
-            int r, g, b;
-            iss >> r >> g >> b;
-            addColor(ofColor(r, g, b));
+        if (!p) {
+            clear();
+            return false;
         }
     }
 
-    // Read faces
-    for (int i = 0; i < numFaces; ++i) {
-        if (!std::getline(file, line)) break;
-        std::istringstream iss(line);
-
-        int vertexCount;
-        iss >> vertexCount;
-
-        std::vector<uint32_t> faceIndices;
-        for (int j = 0; j < vertexCount; ++j) {
-            uint32_t idx;
-            iss >> idx;
-            faceIndices.push_back(idx);
-        }
-
-        // Triangulate
-        if (faceIndices.size() == 3) {
-            addTriangle(faceIndices[0], faceIndices[1], faceIndices[2]);
-        } else if (faceIndices.size() == 4) {
-            // Quad -> two triangles
-            addTriangle(faceIndices[0], faceIndices[1], faceIndices[2]);
-            addTriangle(faceIndices[0], faceIndices[2], faceIndices[3]);
-        }
+    // A file without faces is a point cloud
+    if (!hasFaces && !vertices_.empty()) {
+        mode_ = OF_PRIMITIVE_POINTS;
     }
-
-    file.close();
     return true;
 }
 
@@ -1568,4 +2865,133 @@ bool ofMesh::savePLY(const std::string& filename) const {
     return true;
 }
 
+// Helper: Load native mesh cache (see MeshCache.h)
+bool ofMesh::loadCache(const std::string& filename, const std::function<void(float)>& progress) {
+    const ofBuffer file = ofBufferMapFile(filename);
+    if (!file.isAllocated()) {
+        return false;
+    }
+
+    MeshCacheHeader header;
+    if (file.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, file.begin(), sizeof(header));
+    if (!isValidMeshCache(header, file.size())) {
+        return false;
+    }
+
+    clear();
+    mode_ = static_cast<ofPrimitiveMode>(header.primitiveMode);
+
+    const size_t count = static_cast<size_t>(header.vertexCount);
+    const bool hasNormals = header.attributes & kMeshCacheNormals;
+    const bool hasTexCoords = header.attributes & kMeshCacheTexCoords;
+    const bool hasColors = header.attributes & kMeshCacheColors;
+    vertices_.resize(count);
+    if (hasNormals) normals_.resize(count);
+    if (hasTexCoords) texCoords_.resize(count);
+    if (hasColors) colors_.resize(count);
+
+    LoadProgress reporter(progress, count + static_cast<size_t>(header.indexCount));
+    const render::Vertex3D* records =
+        reinterpret_cast<const render::Vertex3D*>(file.begin() + header.vertexOffset);
+    parallelChunks(count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const render::Vertex3D& v = records[i];
+            vertices_[i] = fromSimd(v.position);
+            if (hasNormals) normals_[i] = fromSimd(v.normal);
+            if (hasTexCoords) texCoords_[i] = ofVec2f(v.texCoord.x, v.texCoord.y);
+            if (hasColors) {
+                auto channel = [](float c) {
+                    return static_cast<uint8_t>(std::min(1.0f, std::max(0.0f, c)) * 255.0f + 0.5f);
+                };
+                colors_[i] = ofColor(channel(v.color.x), channel(v.color.y),
+                                     channel(v.color.z), channel(v.color.w));
+            }
+        }
+        reporter.advance(end - begin);
+    });
+
+    const size_t numIndices = static_cast<size_t>(header.indexCount);
+    const char* indexData = file.begin() + header.indexOffset;
+    indices_.resize(numIndices);
+    if (header.indexSize == sizeof(uint32_t)) {
+        std::memcpy(indices_.data(), indexData, numIndices * sizeof(uint32_t));
+    } else if (numIndices > 0) {
+        const uint16_t* narrow = reinterpret_cast<const uint16_t*>(indexData);
+        std::copy(narrow, narrow + numIndices, indices_.begin());
+    }
+    for (uint32_t index : indices_) {
+        if (index >= count) {
+            clear();
+            return false;
+        }
+    }
+    reporter.advance(numIndices);
+    return true;
+}
+
+// Helper: Save native mesh cache (see MeshCache.h)
+bool ofMesh::saveCache(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    const size_t count = vertices_.size();
+    const bool hasNormals = normals_.size() == count && count > 0;
+    const bool hasTexCoords = texCoords_.size() == count && count > 0;
+    const bool hasColors = colors_.size() == count && count > 0;
+
+    // Same records (and 16-bit indices when they fit) as the GPU copies use
+    const render::IndexType indexType = render::indexTypeForVertexCount(count);
+    MeshCacheHeader header = {};
+    std::memcpy(header.magic, kMeshCacheMagic, sizeof(kMeshCacheMagic));
+    header.version = kMeshCacheVersion;
+    header.vertexStride = sizeof(render::Vertex3D);
+    header.primitiveMode = static_cast<uint32_t>(mode_);
+    header.attributes = (hasNormals ? kMeshCacheNormals : 0) |
+                        (hasTexCoords ? kMeshCacheTexCoords : 0) |
+                        (hasColors ? kMeshCacheColors : 0);
+    header.indexSize = indices_.empty() ? 0 : static_cast<uint32_t>(render::indexSize(indexType));
+    header.vertexCount = count;
+    header.indexCount = indices_.size();
+    header.vertexOffset = meshCacheAlign(sizeof(MeshCacheHeader));
+    header.indexOffset = meshCacheAlign(header.vertexOffset + count * sizeof(render::Vertex3D));
+
+    std::vector<render::Vertex3D> records(count);
+    parallelChunks(count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            render::Vertex3D& v = records[i];
+            v.position = toSimd(vertices_[i]);
+            if (hasNormals) v.normal = toSimd(normals_[i]);
+            if (hasTexCoords) v.texCoord = simd_make_float2(texCoords_[i].x, texCoords_[i].y);
+            if (hasColors) {
+                v.color = simd_make_float4(colors_[i].r, colors_[i].g, colors_[i].b, colors_[i].a) / 255.0f;
+            }
+        }
+    });
+
+    const char padding[kMeshCacheAlignment] = {};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(padding, static_cast<std::streamsize>(header.vertexOffset - sizeof(header)));
+    file.write(reinterpret_cast<const char*>(records.data()),
+               static_cast<std::streamsize>(count * sizeof(render::Vertex3D)));
+    if (!indices_.empty()) {
+        file.write(padding, static_cast<std::streamsize>(header.indexOffset - header.vertexOffset -
+                                                         count * sizeof(render::Vertex3D)));
+        if (indexType == render::IndexType::UInt32) {
+            file.write(reinterpret_cast<const char*>(indices_.data()),
+                       static_cast<std::streamsize>(indices_.size() * sizeof(uint32_t)));
+        } else {
+            std::vector<uint16_t> narrow(indices_.begin(), indices_.end());
+            file.write(reinterpret_cast<const char*>(narrow.data()),
+                       static_cast<std::streamsize>(narrow.size() * sizeof(uint16_t)));
+        }
+    }
+
+    return file.good();
+}
+
 } // namespace oflike
@@ -6,12 +6,16 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <functional>
 #include "../math/ofVec2f.h"
 #include "../math/ofVec3f.h"
 #include "../types/ofColor.h"
+#include "ResidentMesh.h"
 
 namespace oflike {
 
+class ofMatrix4x4;
+
 /// \brief Primitive rendering mode for meshes
 /// \details Controls how vertices are interpreted during rendering
 enum ofPrimitiveMode {
@@ -148,6 +152,11 @@ public:
     // ========================================================================
 
     /// \brief Draw the mesh
+    /// \details A mesh drawn again without changes is drawn from a GPU copy
+    /// (see ResidentMesh.h) instead of re-uploading its vertices. Any
+    /// non-const call, including the non-const getters, counts as a change.
+    /// Meshes whose bounds lie outside the view are skipped (see
+    /// ofEnableFrustumCulling()).
     void draw() const;
 
     /// \brief Draw the mesh as a wireframe
@@ -251,9 +260,22 @@ public:
     // ========================================================================
 
     /// \brief Merge duplicate vertices (vertices at the same position)
-    /// \details Updates indices accordingly
+    /// \details Updates indices accordingly. Same as
+    /// weldVertices(1e-6f, false): attributes of the first vertex are kept.
     void mergeDuplicateVertices();
 
+    /// \brief Weld vertices closer than a tolerance
+    /// \details Vertices are bucketed on a quantized grid (cell size twice the
+    /// tolerance, so each lookup probes 8 cells) and matched in parallel
+    /// chunks. Each vertex welds to the lowest-index match; the first vertex
+    /// of each welded group is kept. Indices are remapped, or created when
+    /// the mesh had none.
+    /// \param tolerance Largest per-axis distance welded (0 = identical positions only)
+    /// \param compareAttributes Also require normals and texture coordinates
+    ///   to match within 1e-4 and colors exactly
+    /// \return Table mapping each old vertex index to its new index
+    std::vector<uint32_t> weldVertices(float tolerance, bool compareAttributes = true);
+
     /// \brief Automatically generate indices for triangle rendering
     /// \details Creates indices 0, 1, 2, 3, 4, 5, ... for all vertices
     void setupIndicesAuto();
@@ -271,6 +293,51 @@ public:
     /// \details Combines all vertices, normals, texcoords, colors, and indices
     void append(const ofMesh& mesh);
 
+    /// \brief Reduce the triangle count by quadric-error edge collapses
+    /// \details Garland/Heckbert simplification with half-edge collapses:
+    /// the cheapest edge moves one endpoint onto the other, so surviving
+    /// vertices keep their positions and attributes. Vertices sharing a
+    /// position collapse together and only along shared triangles, which keeps
+    /// UV and normal seams intact; open borders are weighted to hold their
+    /// outline, and collapses that would flip a triangle or pinch the surface
+    /// are skipped. The result is indexed; unused vertices are removed.
+    /// \param ratio Fraction of the triangles to keep (0-1)
+    /// \param maxError Stop early once the cheapest collapse would move the
+    ///   surface further than this fraction of the bounds' diagonal (0 = no limit)
+    /// \return False if the mesh isn't OF_PRIMITIVE_TRIANGLES or has no triangles
+    bool simplify(float ratio, float maxError = 0.0f);
+
+    // ========================================================================
+    // Bulk Operations
+    // ========================================================================
+
+    /// \brief Transform all vertices (and normals) in place
+    /// \param matrix Transform applied to each vertex as matrix * (v, 1)
+    /// \details Normals use the inverse transpose of the upper 3x3 and are
+    /// renormalized. Affine matrices take a divide-free path.
+    void transform(const ofMatrix4x4& matrix);
+
+    /// \brief Get the axis-aligned bounds of the vertices
+    /// \details Cached until the geometry changes.
+    /// \param min Receives the smallest x, y and z
+    /// \param max Receives the largest x, y and z
+    /// \return False (bounds unchanged) if the mesh has no vertices
+    bool getBounds(ofVec3f& min, ofVec3f& max) const;
+
+    /// \brief Get the sphere enclosing the bounds
+    /// \param center Receives the center of the bounds
+    /// \param radius Receives half the bounds' diagonal
+    /// \return False (values unchanged) if the mesh has no vertices
+    bool getBoundingSphere(ofVec3f& center, float& radius) const;
+
+    /// \brief Get the average vertex position
+    /// \return The centroid, or (0, 0, 0) for an empty mesh
+    ofVec3f getCentroid() const;
+
+    /// \brief Set every vertex color
+    /// \param color Color for all vertices (colors are resized to the vertex count)
+    void fillColors(const ofColor& color);
+
     // ========================================================================
     // Static Mesh Generators
     // ========================================================================
@@ -323,12 +390,46 @@ public:
     // ========================================================================
 
     /// \brief Load mesh from a file
-    /// \param filename Path to the mesh file (PLY or OBJ)
+    /// \details The file is memory-mapped. OBJ text is parsed in parallel
+    /// chunks, every face corner becoming its own vertex; faces with more
+    /// than three corners are fan-triangulated. PLY may be ASCII or binary
+    /// (either byte order); binary float vertex data is copied directly into
+    /// the vertex arrays. Files without faces load as point clouds
+    /// (OF_PRIMITIVE_POINTS). .oflmesh files (see save()) load without
+    /// parsing.
+    /// \param filename Path to the mesh file (PLY, OBJ or OFLMESH)
     /// \return True if loaded successfully
     bool load(const std::string& filename);
 
+    /// \brief Load mesh from a file, reporting progress
+    /// \param filename Path to the mesh file (PLY, OBJ or OFLMESH)
+    /// \param progress Called with the loaded fraction (0-1), one call at a
+    /// time but possibly from worker threads; 1 is reported on success
+    /// \return True if loaded successfully
+    bool load(const std::string& filename, const std::function<void(float)>& progress);
+
+    /// \brief Load a mesh on a background thread
+    /// \details The file is loaded as by load(); callback then runs on the
+    /// main thread, between frames, with the mesh to move from and whether
+    /// it loaded. Use it to keep setup() from blocking on large scans:
+    /// \code
+    ///     ofMesh::loadAsync("scan.ply", [this](ofMesh& mesh, bool loaded) {
+    ///         if (loaded) scan = std::move(mesh);
+    ///     });
+    /// \endcode
+    /// \param filename Path to the mesh file (PLY, OBJ or OFLMESH)
+    /// \param callback Receives the mesh and the result on the main thread
+    /// \param progress Optional; called from the loading threads as in load()
+    static void loadAsync(const std::string& filename,
+                          std::function<void(ofMesh& mesh, bool loaded)> callback,
+                          std::function<void(float progress)> progress = nullptr);
+
     /// \brief Save mesh to a file
-    /// \param filename Path to save the mesh (PLY or OBJ)
+    /// \details .oflmesh is the native cache format: the vertices are stored
+    /// in the GPU vertex layout, so VboMesh::load() draws them straight from
+    /// the mapped file. Save imported OBJ/PLY files once to skip the import
+    /// on later runs.
+    /// \param filename Path to save the mesh (PLY, OBJ or OFLMESH)
     /// \return True if saved successfully
     bool save(const std::string& filename) const;
 
@@ -341,11 +442,22 @@ private:
     std::vector<ofColor> colors_;
     std::vector<uint32_t> indices_;
 
+    // GPU copy drawn while the geometry is unchanged; every non-const member
+    // (including the non-const getters) invalidates it
+    mutable ResidentMesh gpu_;
+
+    // getBounds() result and the gpu_ version it was computed for
+    mutable ofVec3f boundsMin_;
+    mutable ofVec3f boundsMax_;
+    mutable uint64_t boundsVersion_ = 0;
+
     // File I/O helper methods
-    bool loadOBJ(const std::string& filename);
+    bool loadOBJ(const std::string& filename, const std::function<void(float)>& progress);
     bool saveOBJ(const std::string& filename) const;
-    bool loadPLY(const std::string& filename);
+    bool loadPLY(const std::string& filename, const std::function<void(float)>& progress);
     bool savePLY(const std::string& filename) const;
+    bool loadCache(const std::string& filename, const std::function<void(float)>& progress);
+    bool saveCache(const std::string& filename) const;
 };
 
 } // namespace oflike
@@ -0,0 +1,772 @@
+#include "ofMeshBVH.h"
+#include "ofMesh.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <simd/simd.h>
+#include <dispatch/dispatch.h>
+
+namespace oflike {
+
+namespace {
+    // ========================================================================
+    // Constants
+    // ========================================================================
+
+    constexpr int kBins = 16;                       // SAH candidates per axis
+    constexpr size_t kParallelBinning = 65536;      // Nodes binned across threads
+    constexpr size_t kTaskTriangles = 16384;        // Subtrees built as one task
+    constexpr size_t kMaxDepth = 60;                // Deeper nodes become leaves
+    constexpr size_t kStackSize = kMaxDepth + 4;    // Traversal stack entries
+
+    // ========================================================================
+    // Tree Records
+    // ========================================================================
+
+    // 32-byte node: children are adjacent (first, first + 1) for interior
+    // nodes (count 0); leaves hold triangles [first, first + count)
+    struct Node {
+        float min[3];
+        uint32_t first;
+        float max[3];
+        uint32_t count;
+    };
+
+    static_assert(sizeof(Node) == 32, "Node must stay 32 bytes");
+
+    // Triangle in leaf order: vertex indices and the mesh's triangle index
+    struct Triangle {
+        uint32_t v[3];
+        uint32_t id;
+    };
+
+    struct Box {
+        simd_float3 min = simd_make_float3(FLT_MAX, FLT_MAX, FLT_MAX);
+        simd_float3 max = simd_make_float3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+        void grow(simd_float3 p) {
+            min = simd_min(min, p);
+            max = simd_max(max, p);
+        }
+
+        void grow(const Box& b) {
+            min = simd_min(min, b.min);
+            max = simd_max(max, b.max);
+        }
+
+        // Half the surface area (empty boxes count as 0)
+        float area() const {
+            const simd_float3 e = simd_max(max - min, simd_make_float3(0, 0, 0));
+            return e.x * e.y + e.y * e.z + e.z * e.x;
+        }
+    };
+
+    inline simd_float3 toSimd(const ofVec3f& v) {
+        return simd_make_float3(v.x, v.y, v.z);
+    }
+
+    inline ofVec3f fromSimd(simd_float3 v) {
+        return ofVec3f(v.x, v.y, v.z);
+    }
+
+    inline void storeBox(Node& node, const Box& box) {
+        node.min[0] = box.min.x; node.min[1] = box.min.y; node.min[2] = box.min.z;
+        node.max[0] = box.max.x; node.max[1] = box.max.y; node.max[2] = box.max.z;
+    }
+
+    inline Box loadBox(const Node& node) {
+        Box box;
+        box.min = simd_make_float3(node.min[0], node.min[1], node.min[2]);
+        box.max = simd_make_float3(node.max[0], node.max[1], node.max[2]);
+        return box;
+    }
+
+    // Run body(begin, end) over chunks of [0, count) on the global queue
+    template <typename Body>
+    void parallelChunks(size_t count, size_t chunk, const Body& body) {
+        const size_t chunks = (count + chunk - 1) / chunk;
+        if (chunks <= 1) {
+            body(0, count);
+            return;
+        }
+        struct Job {
+            const Body* body;
+            size_t count;
+            size_t chunk;
+        } job = {&body, count, chunk};
+        dispatch_apply_f(chunks, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), &job,
+                         [](void* context, size_t index) {
+                             const Job* job = static_cast<const Job*>(context);
+                             const size_t begin = index * job->chunk;
+                             (*job->body)(begin, std::min(job->count, begin + job->chunk));
+                         });
+    }
+
+    // ========================================================================
+    // Binned SAH Build
+    // ========================================================================
+
+    // Triangles being sorted into the tree: boxes and centroids by mesh
+    // triangle, and the current order of their indices
+    struct BuildInput {
+        std::vector<Box> boxes;
+        std::vector<simd_float3> centroids;
+        std::vector<uint32_t> order;
+    };
+
+    struct Bins {
+        Box boxes[3][kBins];
+        uint32_t counts[3][kBins] = {};
+        Box bounds;     // Of the triangles
+
+        void merge(const Bins& other) {
+            for (int axis = 0; axis < 3; axis++) {
+                for (int i = 0; i < kBins; i++) {
+                    boxes[axis][i].grow(other.boxes[axis][i]);
+                    counts[axis][i] += other.counts[axis][i];
+                }
+            }
+            bounds.grow(other.bounds);
+        }
+    };
+
+    inline int binOf(float c, float min, float scale) {
+        return std::min(kBins - 1, std::max(0, static_cast<int>((c - min) * scale)));
+    }
+
+    // Centroid bounds of [begin, end), across threads for large ranges
+    Box centroidBounds(const BuildInput& input, size_t begin, size_t end) {
+        auto bound = [&](size_t b, size_t e) {
+            Box box;
+            for (size_t i = b; i < e; i++) box.grow(input.centroids[input.order[i]]);
+            return box;
+        };
+        const size_t count = end - begin;
+        if (count < kParallelBinning) return bound(begin, end);
+
+        const size_t chunk = kParallelBinning / 4;
+        std::vector<Box> parts((count + chunk - 1) / chunk);
+        parallelChunks(count, chunk, [&](size_t b, size_t e) {
+            parts[b / chunk] = bound(begin + b, begin + e);
+        });
+        Box box;
+        for (const Box& part : parts) box.grow(part);
+        return box;
+    }
+
+    // Sort [begin, end) into the bins of every axis
+    void binTriangles(const BuildInput& input, size_t begin, size_t end,
+                      const Box& centroids, Bins& bins) {
+        simd_float3 scale;
+        for (int axis = 0; axis < 3; axis++) {
+            const float extent = centroids.max[axis] - centroids.min[axis];
+            scale[axis] = extent > 0.0f ? kBins / extent : 0.0f;
+        }
+
+        auto fill = [&](size_t b, size_t e, Bins& out) {
+            for (size_t i = b; i < e; i++) {
+                const uint32_t t = input.order[i];
+                const Box& box = input.boxes[t];
+                const simd_float3 c = input.centroids[t];
+                for (int axis = 0; axis < 3; axis++) {
+                    const int bin = binOf(c[axis], centroids.min[axis], scale[axis]);
+                    out.boxes[axis][bin].grow(box);
+                    out.counts[axis][bin]++;
+                }
+                out.bounds.grow(box);
+            }
+        };
+
+        const size_t count = end - begin;
+        if (count < kParallelBinning) {
+            fill(begin, end, bins);
+            return;
+        }
+        const size_t chunk = kParallelBinning / 4;
+        std::vector<Bins> parts((count + chunk - 1) / chunk);
+        parallelChunks(count, chunk, [&](size_t b, size_t e) {
+            fill(begin + b, begin + e, parts[b / chunk]);
+        });
+        for (const Bins& part : parts) bins.merge(part);
+    }
+
+    // Split point of [begin, end) (partitioning order), or begin if the
+    // range should stay a leaf; bounds receives the range's box
+    size_t splitRange(BuildInput& input, size_t begin, size_t end, size_t depth, Box& bounds) {
+        const size_t count = end - begin;
+        if (count <= ofMeshBVH::kMaxLeafTriangles || depth >= kMaxDepth) {
+            bounds = Box();
+            for (size_t i = begin; i < end; i++) bounds.grow(input.boxes[input.order[i]]);
+            return begin;
+        }
+
+        const Box centroids = centroidBounds(input, begin, end);
+        Bins bins;
+        binTriangles(input, begin, end, centroids, bins);
+        bounds = bins.bounds;
+
+        // Cheapest plane: left area * count + right area * count
+        float bestCost = FLT_MAX;
+        int bestAxis = -1;
+        int bestBin = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            if (!(centroids.max[axis] > centroids.min[axis])) continue;
+
+            float rightCost[kBins];
+            Box right;
+            uint32_t rightCount = 0;
+            for (int i = kBins - 1; i > 0; i--) {
+                right.grow(bins.boxes[axis][i]);
+                rightCount += bins.counts[axis][i];
+                rightCost[i] = right.area() * rightCount;
+            }
+            Box left;
+            uint32_t leftCount = 0;
+            for (int i = 1; i < kBins; i++) {
+                left.grow(bins.boxes[axis][i - 1]);
+                leftCount += bins.counts[axis][i - 1];
+                const float cost = left.area() * leftCount + rightCost[i];
+                if (leftCount > 0 && leftCount < count && cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = i;
+                }
+            }
+        }
+
+        uint32_t* first = input.order.data() + begin;
+        uint32_t* last = input.order.data() + end;
+        if (bestAxis < 0) {
+            // Every centroid in one spot: halve the range
+            return begin + count / 2;
+        }
+        const float min = centroids.min[bestAxis];
+        const float scale = kBins / (centroids.max[bestAxis] - min);
+        const simd_float3* c = input.centroids.data();
+        uint32_t* middle = std::partition(first, last, [&](uint32_t t) {
+            return binOf(c[t][bestAxis], min, scale) < bestBin;
+        });
+        return begin + static_cast<size_t>(middle - first);
+    }
+
+    // Work item: node to fill over a range of the order
+    struct Range {
+        uint32_t node;
+        size_t begin;
+        size_t end;
+        size_t depth;
+    };
+
+    // Split range's node, or make it a leaf; pushes the children
+    template <typename Push>
+    void buildNode(BuildInput& input, std::vector<Node>& nodes, const Range& range, Push push) {
+        Box bounds;
+        const size_t middle = splitRange(input, range.begin, range.end, range.depth, bounds);
+        storeBox(nodes[range.node], bounds);
+        if (middle == range.begin) {
+            nodes[range.node].first = static_cast<uint32_t>(range.begin);
+            nodes[range.node].count = static_cast<uint32_t>(range.end - range.begin);
+            return;
+        }
+
+        const uint32_t left = static_cast<uint32_t>(nodes.size());
+        nodes.resize(nodes.size() + 2);
+        nodes[range.node].first = left;
+        nodes[range.node].count = 0;
+        push(Range{left, range.begin, middle, range.depth + 1});
+        push(Range{left + 1, middle, range.end, range.depth + 1});
+    }
+
+    // ========================================================================
+    // Triangle Tests
+    // ========================================================================
+
+    // Ray parameter where the ray enters the box, or FLT_MAX if it misses
+    // within [0, tMax]
+    inline float enterBox(const Node& node, simd_float3 origin, simd_float3 invDir, float tMax) {
+        const simd_float3 t0 = (simd_make_float3(node.min[0], node.min[1], node.min[2]) - origin) * invDir;
+        const simd_float3 t1 = (simd_make_float3(node.max[0], node.max[1], node.max[2]) - origin) * invDir;
+        const simd_float3 near = simd_min(t0, t1);
+        const simd_float3 far = simd_max(t0, t1);
+        const float enter = std::max(std::max(near.x, near.y), std::max(near.z, 0.0f));
+        const float exit = std::min(std::min(far.x, far.y), std::min(far.z, tMax));
+        return enter <= exit ? enter : FLT_MAX;
+    }
+
+    // Squared distance from p to the box
+    inline float boxDistance2(const Node& node, simd_float3 p) {
+        const simd_float3 lo = simd_make_float3(node.min[0], node.min[1], node.min[2]);
+        const simd_float3 hi = simd_make_float3(node.max[0], node.max[1], node.max[2]);
+        const simd_float3 d = simd_max(simd_max(lo - p, p - hi), simd_make_float3(0, 0, 0));
+        return simd_dot(d, d);
+    }
+
+    // Möller-Trumbore, both sides; true with t, u, v if hit within (0, tMax)
+    inline bool intersectTriangle(simd_float3 origin, simd_float3 dir,
+                                  simd_float3 v0, simd_float3 v1, simd_float3 v2,
+                                  float tMax, float& t, float& u, float& v) {
+        const simd_float3 e1 = v1 - v0;
+        const simd_float3 e2 = v2 - v0;
+        const simd_float3 p = simd_cross(dir, e2);
+        const float det = simd_dot(e1, p);
+        if (det == 0.0f) return false;
+        const float inv = 1.0f / det;
+        const simd_float3 s = origin - v0;
+        u = simd_dot(s, p) * inv;
+        if (u < 0.0f || u > 1.0f) return false;
+        const simd_float3 q = simd_cross(s, e1);
+        v = simd_dot(dir, q) * inv;
+        if (v < 0.0f || u + v > 1.0f) return false;
+        t = simd_dot(e2, q) * inv;
+        return t >= 0.0f && t < tMax;
+    }
+
+    // Closest point of triangle abc to p as barycentrics of b and c (Ericson 5.1.5)
+    inline simd_float3 closestOnTriangle(simd_float3 p, simd_float3 a, simd_float3 b, simd_float3 c,
+                                         float& u, float& v) {
+        const simd_float3 ab = b - a;
+        const simd_float3 ac = c - a;
+        const simd_float3 ap = p - a;
+        const float d1 = simd_dot(ab, ap);
+        const float d2 = simd_dot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f) { u = 0; v = 0; return a; }
+
+        const simd_float3 bp = p - b;
+        const float d3 = simd_dot(ab, bp);
+        const float d4 = simd_dot(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3) { u = 1; v = 0; return b; }
+
+        const float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+            u = d1 / (d1 - d3); v = 0;
+            return a + u * ab;
+        }
+
+        const simd_float3 cp = p - c;
+        const float d5 = simd_dot(ab, cp);
+        const float d6 = simd_dot(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6) { u = 0; v = 1; return c; }
+
+        const float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+            u = 0; v = d2 / (d2 - d6);
+            return a + v * ac;
+        }
+
+        const float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+            v = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            u = 1.0f - v;
+            return b + v * (c - b);
+        }
+
+        const float denom = va + vb + vc;
+        if (denom == 0.0f) { u = 0; v = 0; return a; }     // Degenerate
+        u = vb / denom;
+        v = vc / denom;
+        return a + u * ab + v * ac;
+    }
+
+    inline simd_float3 faceNormal(simd_float3 v0, simd_float3 v1, simd_float3 v2) {
+        const simd_float3 n = simd_cross(v1 - v0, v2 - v0);
+        const float length2 = simd_length_squared(n);
+        return length2 > 0.0f ? n / sqrtf(length2) : n;
+    }
+}
+
+// ============================================================================
+// ofMeshBVH::Impl
+// ============================================================================
+
+struct ofMeshBVH::Impl {
+    std::vector<Node> nodes;            // nodes[0] is the root
+    std::vector<Triangle> triangles;    // Leaf order
+    std::vector<ofVec3f> vertices;
+
+    simd_float3 vertex(uint32_t i) const {
+        return toSimd(vertices[i]);
+    }
+
+    void clear() {
+        nodes.clear();
+        triangles.clear();
+        vertices.clear();
+    }
+
+    bool build(const ofVec3f* positions, size_t vertexCount, const uint32_t* indices, size_t indexCount) {
+        clear();
+        const size_t count = indices ? indexCount / 3 : vertexCount / 3;
+        if (!positions || count == 0 || count > UINT32_MAX || vertexCount > UINT32_MAX) {
+            return false;
+        }
+        if (indices) {
+            for (size_t i = 0; i < count * 3; i++) {
+                if (indices[i] >= vertexCount) return false;
+            }
+        }
+        vertices.assign(positions, positions + vertexCount);
+
+        // Per-triangle boxes and centroids
+        BuildInput input;
+        input.boxes.resize(count);
+        input.centroids.resize(count);
+        input.order.resize(count);
+        triangles.resize(count);
+        parallelChunks(count, 16384, [&](size_t begin, size_t end) {
+            for (size_t t = begin; t < end; t++) {
+                Triangle& tri = triangles[t];
+                for (int k = 0; k < 3; k++) {
+                    tri.v[k] = indices ? indices[t * 3 + k] : static_cast<uint32_t>(t * 3 + k);
+                }
+                tri.id = static_cast<uint32_t>(t);
+                Box box;
+                for (int k = 0; k < 3; k++) box.grow(vertex(tri.v[k]));
+                input.boxes[t] = box;
+                input.centroids[t] = (box.min + box.max) * 0.5f;
+                input.order[t] = static_cast<uint32_t>(t);
+            }
+        });
+
+        // Top of the tree: split large nodes here (binning in parallel) until
+        // the ranges are small enough to hand out as tasks
+        nodes.reserve(count * 2 / ofMeshBVH::kMaxLeafTriangles + 1);
+        nodes.resize(1);
+        std::vector<Range> stack = {Range{0, 0, count, 0}};
+        std::vector<Range> tasks;
+        while (!stack.empty()) {
+            const Range range = stack.back();
+            stack.pop_back();
+            if (range.end - range.begin <= kTaskTriangles) {
+                tasks.push_back(range);
+                continue;
+            }
+            buildNode(input, nodes, range, [&](const Range& child) { stack.push_back(child); });
+        }
+
+        // Subtrees in parallel, each into its own nodes; [0] is the task's node
+        // (tasks cover disjoint ranges of the order)
+        std::vector<std::vector<Node>> subtrees(tasks.size());
+        parallelChunks(tasks.size(), 1, [&](size_t index, size_t) {
+            const Range& task = tasks[index];
+            std::vector<Node>& local = subtrees[index];
+            local.reserve((task.end - task.begin) * 2 / ofMeshBVH::kMaxLeafTriangles + 1);
+            local.resize(1);
+            std::vector<Range> pending = {Range{0, task.begin, task.end, task.depth}};
+            while (!pending.empty()) {
+                const Range range = pending.back();
+                pending.pop_back();
+                buildNode(input, local, range, [&](const Range& child) { pending.push_back(child); });
+            }
+        });
+
+        // Stitch the subtrees after the top nodes; children keep following
+        // their parents, which refit() relies on
+        for (size_t i = 0; i < tasks.size(); i++) {
+            const std::vector<Node>& local = subtrees[i];
+            const uint32_t offset = static_cast<uint32_t>(nodes.size()) - 1;
+            for (size_t k = 0; k < local.size(); k++) {
+                Node node = local[k];
+                if (node.count == 0) node.first += offset;
+                if (k == 0) {
+                    nodes[tasks[i].node] = node;
+                } else {
+                    nodes.push_back(node);
+                }
+            }
+        }
+        nodes.shrink_to_fit();
+
+        // Triangles in leaf order, so leaves read contiguous records
+        std::vector<Triangle> ordered(count);
+        parallelChunks(count, 16384, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) ordered[i] = triangles[input.order[i]];
+        });
+        triangles.swap(ordered);
+        return true;
+    }
+
+    bool refit(const ofVec3f* positions, size_t vertexCount) {
+        if (nodes.empty() || !positions || vertexCount != vertices.size()) return false;
+        std::copy(positions, positions + vertexCount, vertices.begin());
+
+        // Leaves from their triangles, then parents from children (children
+        // always come after their parent)
+        parallelChunks(nodes.size(), 16384, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                Node& node = nodes[i];
+                if (node.count == 0) continue;
+                Box box;
+                for (uint32_t t = node.first; t < node.first + node.count; t++) {
+                    for (int k = 0; k < 3; k++) box.grow(vertex(triangles[t].v[k]));
+                }
+                storeBox(node, box);
+            }
+        });
+        for (size_t i = nodes.size(); i-- > 0;) {
+            Node& node = nodes[i];
+            if (node.count != 0) continue;
+            Box box = loadBox(nodes[node.first]);
+            box.grow(loadBox(nodes[node.first + 1]));
+            storeBox(node, box);
+        }
+        return true;
+    }
+
+    // Nearest (or, with anyHit, first found) hit along a unit-direction ray
+    bool raycast(simd_float3 origin, simd_float3 dir, float tMax, bool anyHit, ofMeshHit& hit) const {
+        if (nodes.empty()) return false;
+
+        const simd_float3 invDir = 1.0f / dir;
+        size_t best = SIZE_MAX;
+        float bestU = 0.0f;
+        float bestV = 0.0f;
+
+        // Far children wait with the distance at which the ray enters them
+        struct Pending {
+            uint32_t node;
+            float enter;
+        } stack[kStackSize];
+        size_t top = 0;
+        if (enterBox(nodes[0], origin, invDir, tMax) == FLT_MAX) return false;
+        uint32_t current = 0;
+        for (;;) {
+            const Node& node = nodes[current];
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                    const Triangle& tri = triangles[i];
+                    float t, u, v;
+                    if (intersectTriangle(origin, dir, vertex(tri.v[0]), vertex(tri.v[1]), vertex(tri.v[2]),
+                                          tMax, t, u, v)) {
+                        tMax = t;
+                        best = i;
+                        bestU = u;
+                        bestV = v;
+                        if (anyHit) break;
+                    }
+                }
+                if (anyHit && best != SIZE_MAX) break;
+            } else {
+                // Near child first
+                uint32_t near = node.first;
+                uint32_t far = node.first + 1;
+                float tNear = enterBox(nodes[near], origin, invDir, tMax);
+                float tFar = enterBox(nodes[far], origin, invDir, tMax);
+                if (tFar < tNear) {
+                    std::swap(near, far);
+                    std::swap(tNear, tFar);
+                }
+                if (tNear != FLT_MAX) {
+                    if (tFar != FLT_MAX) stack[top++] = Pending{far, tFar};
+                    current = near;
+                    continue;
+                }
+            }
+
+            // Next waiting box the ray enters before the nearest hit so far
+            while (top > 0 && stack[top - 1].enter > tMax) top--;
+            if (top == 0) break;
+            current = stack[--top].node;
+        }
+        if (best == SIZE_MAX) return false;
+
+        const Triangle& tri = triangles[best];
+        const simd_float3 v0 = vertex(tri.v[0]);
+        hit.triangle = tri.id;
+        hit.distance = tMax;
+        hit.u = bestU;
+        hit.v = bestV;
+        hit.position = fromSimd(origin + dir * tMax);
+        hit.normal = fromSimd(faceNormal(v0, vertex(tri.v[1]), vertex(tri.v[2])));
+        return true;
+    }
+
+    // Visit leaves whose boxes lie within sqrt(range2) of p, nearest first;
+    // visit(triangle) may shrink range2
+    template <typename Visit>
+    void nearby(simd_float3 p, float& range2, const Visit& visit) const {
+        if (nodes.empty() || boxDistance2(nodes[0], p) > range2) return;
+
+        uint32_t stack[kStackSize];
+        size_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& node = nodes[stack[--top]];
+            if (boxDistance2(node, p) > range2) continue;
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; i++) visit(i);
+                continue;
+            }
+            uint32_t near = node.first;
+            uint32_t far = node.first + 1;
+            float dNear = boxDistance2(nodes[near], p);
+            float dFar = boxDistance2(nodes[far], p);
+            if (dFar < dNear) {
+                std::swap(near, far);
+                std::swap(dNear, dFar);
+            }
+            if (dFar <= range2) stack[top++] = far;
+            if (dNear <= range2) stack[top++] = near;
+        }
+    }
+};
+
+// ============================================================================
+// Construction / Destruction
+// ============================================================================
+
+ofMeshBVH::ofMeshBVH() : impl_(std::make_unique<Impl>()) {}
+
+ofMeshBVH::~ofMeshBVH() = default;
+
+ofMeshBVH::ofMeshBVH(ofMeshBVH&& other) noexcept = default;
+
+ofMeshBVH& ofMeshBVH::operator=(ofMeshBVH&& other) noexcept = default;
+
+// ============================================================================
+// Building
+// ============================================================================
+
+bool ofMeshBVH::build(const ofMesh& mesh) {
+    if (mesh.getMode() != OF_PRIMITIVE_TRIANGLES) {
+        impl_->clear();
+        return false;
+    }
+    const auto& vertices = mesh.getVertices();
+    const auto& indices = mesh.getIndices();
+    return build(vertices.data(), vertices.size(),
+                 indices.empty() ? nullptr : indices.data(), indices.size());
+}
+
+bool ofMeshBVH::build(const ofVec3f* vertices, size_t vertexCount,
+                      const uint32_t* indices, size_t indexCount) {
+    return impl_->build(vertices, vertexCount, indices, indexCount);
+}
+
+bool ofMeshBVH::refit(const ofMesh& mesh) {
+    const auto& vertices = mesh.getVertices();
+    return refit(vertices.data(), vertices.size());
+}
+
+bool ofMeshBVH::refit(const ofVec3f* vertices, size_t vertexCount) {
+    return impl_->refit(vertices, vertexCount);
+}
+
+void ofMeshBVH::clear() {
+    impl_->clear();
+}
+
+bool ofMeshBVH::isBuilt() const {
+    return !impl_->nodes.empty();
+}
+
+size_t ofMeshBVH::getNumTriangles() const {
+    return impl_->triangles.size();
+}
+
+size_t ofMeshBVH::getNumNodes() const {
+    return impl_->nodes.size();
+}
+
+bool ofMeshBVH::getBounds(ofVec3f& min, ofVec3f& max) const {
+    if (impl_->nodes.empty()) return false;
+    const Node& root = impl_->nodes[0];
+    min = ofVec3f(root.min[0], root.min[1], root.min[2]);
+    max = ofVec3f(root.max[0], root.max[1], root.max[2]);
+    return true;
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+ofMeshHit ofMeshBVH::raycast(const ofVec3f& origin, const ofVec3f& direction, float maxDistance) const {
+    ofMeshHit hit;
+    const simd_float3 dir = toSimd(direction);
+    const float length = simd_length(dir);
+    if (length > 0.0f) {
+        impl_->raycast(toSimd(origin), dir / length, maxDistance, false, hit);
+    }
+    return hit;
+}
+
+bool ofMeshBVH::intersects(const ofVec3f& origin, const ofVec3f& direction, float maxDistance) const {
+    ofMeshHit hit;
+    const simd_float3 dir = toSimd(direction);
+    const float length = simd_length(dir);
+    return length > 0.0f && impl_->raycast(toSimd(origin), dir / length, maxDistance, true, hit);
+}
+
+ofMeshHit ofMeshBVH::intersectSegment(const ofVec3f& a, const ofVec3f& b) const {
+    ofMeshHit hit;
+    const simd_float3 dir = toSimd(b) - toSimd(a);
+    const float length = simd_length(dir);
+    if (length > 0.0f) {
+        impl_->raycast(toSimd(a), dir / length, length, false, hit);
+    }
+    return hit;
+}
+
+ofMeshHit ofMeshBVH::closestPoint(const ofVec3f& center, float radius) const {
+    ofMeshHit hit;
+    const simd_float3 p = toSimd(center);
+    float range2 = radius * radius;
+    simd_float3 bestPoint = p;
+    impl_->nearby(p, range2, [&](uint32_t i) {
+        const Triangle& tri = impl_->triangles[i];
+        float u, v;
+        const simd_float3 q = closestOnTriangle(p, impl_->vertex(tri.v[0]), impl_->vertex(tri.v[1]),
+                                                impl_->vertex(tri.v[2]), u, v);
+        const float d2 = simd_length_squared(q - p);
+        if (d2 <= range2 && (hit.triangle == ofMeshHit::kNone || d2 < hit.distance)) {
+            range2 = d2;
+            hit.triangle = i;       // Leaf order until the end
+            hit.distance = d2;
+            hit.u = u;
+            hit.v = v;
+            bestPoint = q;
+        }
+    });
+    if (!hit) return hit;
+
+    const Triangle& tri = impl_->triangles[hit.triangle];
+    hit.triangle = tri.id;
+    hit.distance = sqrtf(hit.distance);
+    hit.position = fromSimd(bestPoint);
+    hit.normal = fromSimd(faceNormal(impl_->vertex(tri.v[0]), impl_->vertex(tri.v[1]), impl_->vertex(tri.v[2])));
+    return hit;
+}
+
+size_t ofMeshBVH::querySphere(const ofVec3f& center, float radius, std::vector<size_t>& triangles) const {
+    triangles.clear();
+    const simd_float3 p = toSimd(center);
+    float range2 = radius * radius;
+    impl_->nearby(p, range2, [&](uint32_t i) {
+        const Triangle& tri = impl_->triangles[i];
+        float u, v;
+        const simd_float3 q = closestOnTriangle(p, impl_->vertex(tri.v[0]), impl_->vertex(tri.v[1]),
+                                                impl_->vertex(tri.v[2]), u, v);
+        if (simd_length_squared(q - p) <= range2) triangles.push_back(tri.id);
+    });
+    return triangles.size();
+}
+
+size_t ofMeshBVH::raycast(const ofVec3f* origins, const ofVec3f* directions, size_t count,
+                          ofMeshHit* hits, float maxDistance) const {
+    if (!origins || !directions || !hits || count == 0) return 0;
+
+    std::vector<size_t> hitCounts((count + 255) / 256, 0);
+    parallelChunks(count, 256, [&](size_t begin, size_t end) {
+        size_t found = 0;
+        for (size_t i = begin; i < end; i++) {
+            hits[i] = raycast(origins[i], directions[i], maxDistance);
+            if (hits[i]) found++;
+        }
+        hitCounts[begin / 256] = found;
+    });
+
+    size_t total = 0;
+    for (size_t found : hitCounts) total += found;
+    return total;
+}
+
+} // namespace oflike
@@ -0,0 +1,175 @@
+#pragma once
+
+// oflike-metal ofMeshBVH - bounding volume hierarchy over mesh triangles
+// Ray, segment and sphere queries (picking, collision) in logarithmic time
+// instead of a scan over every triangle
+
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../math/ofVec3f.h"
+
+namespace oflike {
+
+class ofMesh;
+
+/// \brief Result of an ofMeshBVH query
+/// \details The hit point is v0 + u * (v1 - v0) + v * (v2 - v0) for the
+/// triangle's vertices v0, v1, v2, so vertex attributes interpolate as
+/// (1 - u - v) * a0 + u * a1 + v * a2.
+struct ofMeshHit {
+    static constexpr size_t kNone = SIZE_MAX;
+
+    size_t triangle = kNone;    ///< Triangle index (indices 3t..3t+2), or kNone
+    float distance = 0.0f;      ///< From the ray origin (sphere: from the center)
+    float u = 0.0f;             ///< Barycentric weight of the triangle's second vertex
+    float v = 0.0f;             ///< Barycentric weight of the third vertex
+    ofVec3f position;           ///< Hit point
+    ofVec3f normal;             ///< Unit face normal, (v1 - v0) x (v2 - v0)
+
+    /// \brief True if something was hit
+    explicit operator bool() const { return triangle != kNone; }
+};
+
+/// \brief BVH over the triangles of an ofMesh for picking and collision
+/// \details build() sorts the triangles into a binary tree of bounding
+/// boxes split by the surface area heuristic (binned, 16 bins per axis);
+/// queries descend only into boxes they touch, near child first, so a ray
+/// against a million-triangle scan tests a few dozen boxes and triangles.
+///
+/// - Building: the top of the tree splits large nodes with parallel
+///   binning, then independent subtrees build in parallel.
+/// - Deforming meshes: refit() recomputes the boxes for moved vertices
+///   without rebuilding; queries stay exact, but the tree gets slower as
+///   the shape drifts from the one it was built for. Rebuild after large
+///   changes.
+/// - Memory: 32 bytes per node (about two per leaf of up to 4 triangles),
+///   16 per triangle and 12 per vertex; the mesh itself isn't referenced.
+///
+/// Queries are const and may run from several threads at once. Meshes are
+/// in OF_PRIMITIVE_TRIANGLES mode, indexed or not.
+///
+/// Example:
+/// \code
+///     ofMeshBVH bvh;
+///     bvh.build(scan);
+///
+///     void mousePressed(int x, int y, int button) {
+///         ofVec3f nearPoint = cam.screenToWorld(ofVec3f(x, y, 0));
+///         ofVec3f farPoint = cam.screenToWorld(ofVec3f(x, y, 1));
+///         if (ofMeshHit hit = bvh.raycast(nearPoint, farPoint - nearPoint)) {
+///             selected = hit.triangle;
+///         }
+///     }
+/// \endcode
+class ofMeshBVH {
+public:
+    /// Triangles per leaf at most
+    static constexpr size_t kMaxLeafTriangles = 4;
+
+    // ========================================================================
+    // Construction / Destruction
+    // ========================================================================
+
+    ofMeshBVH();
+    ~ofMeshBVH();
+
+    ofMeshBVH(ofMeshBVH&& other) noexcept;
+    ofMeshBVH& operator=(ofMeshBVH&& other) noexcept;
+
+    ofMeshBVH(const ofMeshBVH&) = delete;
+    ofMeshBVH& operator=(const ofMeshBVH&) = delete;
+
+    // ========================================================================
+    // Building
+    // ========================================================================
+
+    /// \brief Build the tree over a mesh's triangles
+    /// \details Copies the vertex positions and triangle indices; replaces
+    /// any previous tree. Degenerate triangles are kept (rays miss them).
+    /// \return false if the mesh isn't OF_PRIMITIVE_TRIANGLES, has no
+    /// triangles, or indexes past its vertices
+    bool build(const ofMesh& mesh);
+
+    /// \brief Build from positions and triangle indices
+    /// \param vertices Vertex positions
+    /// \param vertexCount Number of vertices
+    /// \param indices Three per triangle, or nullptr for consecutive vertex triples
+    /// \param indexCount Number of indices (ignored without indices)
+    bool build(const ofVec3f* vertices, size_t vertexCount,
+               const uint32_t* indices, size_t indexCount);
+
+    /// \brief Update the boxes for moved vertices, keeping the tree
+    /// \details The triangles are unchanged; only positions move.
+    /// \return false if the vertex count differs from the built one
+    bool refit(const ofMesh& mesh);
+
+    /// \brief Update the boxes from new positions (same count as built)
+    bool refit(const ofVec3f* vertices, size_t vertexCount);
+
+    /// \brief Release the tree
+    void clear();
+
+    /// \brief True once built
+    bool isBuilt() const;
+
+    size_t getNumTriangles() const;
+    size_t getNumNodes() const;
+
+    /// \brief Bounds of every triangle
+    /// \return false if not built
+    bool getBounds(ofVec3f& min, ofVec3f& max) const;
+
+    // ========================================================================
+    // Queries
+    // ========================================================================
+
+    /// \brief Nearest triangle along a ray, from either side
+    /// \param origin Ray start
+    /// \param direction Ray direction, any length (distances are in world units)
+    /// \param maxDistance Ignore hits further than this
+    /// \return The nearest hit; false if none
+    ofMeshHit raycast(const ofVec3f& origin, const ofVec3f& direction,
+                      float maxDistance = FLT_MAX) const;
+
+    /// \brief True if the ray hits anything within maxDistance
+    /// \details Stops at the first hit found, faster than raycast() (shadows, visibility).
+    bool intersects(const ofVec3f& origin, const ofVec3f& direction,
+                    float maxDistance = FLT_MAX) const;
+
+    /// \brief Nearest triangle crossing the segment from a to b
+    /// \return The hit closest to a; distance is measured from a
+    ofMeshHit intersectSegment(const ofVec3f& a, const ofVec3f& b) const;
+
+    /// \brief Nearest surface point within a sphere (collision)
+    /// \return The closest point of any triangle to center if within radius;
+    /// distance is from center, normal is the face normal
+    ofMeshHit closestPoint(const ofVec3f& center, float radius = FLT_MAX) const;
+
+    /// \brief Every triangle touching a sphere
+    /// \param triangles Receives triangle indices (cleared first), in no particular order
+    /// \return Number of triangles found
+    size_t querySphere(const ofVec3f& center, float radius, std::vector<size_t>& triangles) const;
+
+    /// \brief Cast many rays in parallel
+    /// \param origins Ray starts
+    /// \param directions Ray directions (any length)
+    /// \param count Number of rays
+    /// \param hits Receives one result per ray (triangle kNone for misses)
+    /// \param maxDistance Ignore hits further than this
+    /// \return Number of rays that hit
+    size_t raycast(const ofVec3f* origins, const ofVec3f* directions, size_t count,
+                   ofMeshHit* hits, float maxDistance = FLT_MAX) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
+
+// Global namespace aliases for openFrameworks compatibility
+using ofMeshBVH = oflike::ofMeshBVH;
+using ofMeshHit = oflike::ofMeshHit;
@@ -3,6 +3,11 @@
 
 namespace oflike {
 
+namespace {
+    // Bumped on every parent/child change; ofNodeBatch lists rebuild when it moves
+    uint64_t hierarchyVersion = 1;
+}
+
 // ========================================================================
 // Construction / Destruction
 // ========================================================================
@@ -12,6 +17,8 @@ ofNode::ofNode()
     , orientation_(ofQuaternion::identity())
     , scale_(1, 1, 1)
     , parent_(nullptr)
+    , localDirty_(true)
+    , globalDirty_(true)
 {
 }
 
@@ -24,8 +31,10 @@ ofNode::~ofNode() {
     // Clear all children's parent reference
     for (ofNode* child : children_) {
         child->parent_ = nullptr;
+        child->invalidateGlobalTransform();
     }
     children_.clear();
+    hierarchyVersion++;
 }
 
 // ========================================================================
@@ -52,8 +61,8 @@ ofVec3f ofNode::getGlobalPosition() const {
     }
 
     // Transform local position by parent's global transform
-    ofMatrix4x4 parentGlobal = parent_->getGlobalTransformMatrix();
-    return parentGlobal * position_;
+    parent_->updateGlobalTransform();
+    return parent_->globalMatrix_ * position_;
 }
 
 void ofNode::setGlobalPosition(const ofVec3f& p) {
@@ -63,7 +72,8 @@ void ofNode::setGlobalPosition(const ofVec3f& p) {
     }
 
     // Transform world position to local space
-    ofMatrix4x4 parentGlobalInverse = parent_->getGlobalTransformMatrix().getInverse();
+    parent_->updateGlobalTransform();
+    ofMatrix4x4 parentGlobalInverse = parent_->globalMatrix_.getInverse();
     ofVec3f localPos = parentGlobalInverse * p;
     setPosition(localPos);
 }
@@ -102,8 +112,8 @@ ofQuaternion ofNode::getGlobalOrientation() const {
         return orientation_;
     }
 
-    // Combine with parent's global orientation
-    return parent_->getGlobalOrientation() * orientation_;
+    updateGlobalTransform();
+    return globalOrientation_;
 }
 
 void ofNode::setGlobalOrientation(const ofQuaternion& q) {
@@ -239,12 +249,8 @@ ofVec3f ofNode::getGlobalScale() const {
         return scale_;
     }
 
-    ofVec3f parentScale = parent_->getGlobalScale();
-    return ofVec3f(
-        scale_.x * parentScale.x,
-        scale_.y * parentScale.y,
-        scale_.z * parentScale.z
-    );
+    updateGlobalTransform();
+    return globalScale_;
 }
 
 // ========================================================================
@@ -252,23 +258,21 @@ ofVec3f ofNode::getGlobalScale() const {
 // ========================================================================
 
 ofMatrix4x4 ofNode::getLocalTransformMatrix() const {
-    // Build TRS matrix: Translation * Rotation * Scale
-    ofMatrix4x4 translation = ofMatrix4x4::newTranslationMatrix(position_);
-    ofMatrix4x4 rotation = orientation_.getMatrix();
-    ofMatrix4x4 scale = ofMatrix4x4::newScaleMatrix(scale_);
-
-    return translation * rotation * scale;
+    if (localDirty_) {
+        // Build TRS matrix: Translation * Rotation * Scale
+        ofMatrix4x4 translation = ofMatrix4x4::newTranslationMatrix(position_);
+        ofMatrix4x4 rotation = orientation_.getMatrix();
+        ofMatrix4x4 scale = ofMatrix4x4::newScaleMatrix(scale_);
+
+        localMatrix_ = translation * rotation * scale;
+        localDirty_ = false;
+    }
+    return localMatrix_;
 }
 
 ofMatrix4x4 ofNode::getGlobalTransformMatrix() const {
-    ofMatrix4x4 localMatrix = getLocalTransformMatrix();
-
-    if (!parent_) {
-        return localMatrix;
-    }
-
-    // Multiply by parent's global transform
-    return parent_->getGlobalTransformMatrix() * localMatrix;
+    updateGlobalTransform();
+    return globalMatrix_;
 }
 
 void ofNode::resetTransform() {
@@ -379,6 +383,7 @@ size_t ofNode::getNumChildren() const {
 
 void ofNode::addChild(ofNode* child) {
     if (!child) return;
+    hierarchyVersion++;
 
     // Check if already a child
     auto it = std::find(children_.begin(), children_.end(), child);
@@ -389,6 +394,7 @@ void ofNode::addChild(ofNode* child) {
 
 void ofNode::removeChild(ofNode* child) {
     if (!child) return;
+    hierarchyVersion++;
 
     auto it = std::find(children_.begin(), children_.end(), child);
     if (it != children_.end()) {
@@ -397,18 +403,134 @@ void ofNode::removeChild(ofNode* child) {
 }
 
 void ofNode::notifyTransformChanged() {
+    localDirty_ = true;
+    globalDirty_ = true;
+
     // Call virtual callback
     onTransformChanged();
 
     // Notify all children
     for (ofNode* child : children_) {
-        child->notifyTransformChanged();
+        child->invalidateGlobalTransform();
+    }
+}
+
+void ofNode::invalidateGlobalTransform() {
+    if (globalDirty_) {
+        return;
+    }
+    globalDirty_ = true;
+    onTransformChanged();
+
+    for (ofNode* child : children_) {
+        child->invalidateGlobalTransform();
     }
 }
 
+void ofNode::updateGlobalTransform() const {
+    if (!globalDirty_) {
+        return;
+    }
+
+    const ofMatrix4x4 localMatrix = getLocalTransformMatrix();
+    if (parent_) {
+        // Refreshes the stale part of the ancestor chain, top down
+        parent_->updateGlobalTransform();
+        globalMatrix_ = parent_->globalMatrix_ * localMatrix;
+        globalOrientation_ = parent_->globalOrientation_ * orientation_;
+        const ofVec3f& parentScale = parent_->globalScale_;
+        globalScale_.set(scale_.x * parentScale.x, scale_.y * parentScale.y, scale_.z * parentScale.z);
+    } else {
+        globalMatrix_ = localMatrix;
+        globalOrientation_ = orientation_;
+        globalScale_ = scale_;
+    }
+    globalDirty_ = false;
+}
+
 void ofNode::onTransformChanged() {
     // Default implementation does nothing
     // Subclasses can override to respond to transform changes
 }
 
+// ========================================================================
+// ofNodeBatch
+// ========================================================================
+
+void ofNodeBatch::build(ofNode& root) {
+    build(std::vector<ofNode*>{&root});
+}
+
+void ofNodeBatch::build(const std::vector<ofNode*>& roots) {
+    roots_ = roots;
+    nodes_.clear();
+    parents_.clear();
+
+    // Depth-first, parents before children
+    std::vector<std::pair<ofNode*, int32_t>> stack;
+    for (auto it = roots_.rbegin(); it != roots_.rend(); ++it) {
+        if (*it) stack.emplace_back(*it, -1);
+    }
+    while (!stack.empty()) {
+        auto [node, parent] = stack.back();
+        stack.pop_back();
+
+        const int32_t index = static_cast<int32_t>(nodes_.size());
+        nodes_.push_back(node);
+        parents_.push_back(parent);
+        const auto& children = node->children_;
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            stack.emplace_back(*it, index);
+        }
+    }
+
+    matrices_.resize(nodes_.size());
+    hierarchyVersion_ = hierarchyVersion;
+}
+
+const std::vector<simd_float4x4>& ofNodeBatch::update() {
+    if (hierarchyVersion_ != hierarchyVersion) {
+        build(std::vector<ofNode*>(roots_));
+    }
+
+    for (size_t i = 0; i < nodes_.size(); i++) {
+        const ofNode* node = nodes_[i];
+        const int32_t parent = parents_[i];
+        if (node->globalDirty_ && parent >= 0) {
+            // The parent came earlier in the list, so its cache is fresh
+            const ofNode* parentNode = nodes_[parent];
+            node->globalMatrix_ = parentNode->globalMatrix_ * node->getLocalTransformMatrix();
+            node->globalOrientation_ = parentNode->globalOrientation_ * node->orientation_;
+            const ofVec3f& parentScale = parentNode->globalScale_;
+            node->globalScale_.set(node->scale_.x * parentScale.x, node->scale_.y * parentScale.y,
+                                   node->scale_.z * parentScale.z);
+            node->globalDirty_ = false;
+        } else {
+            node->updateGlobalTransform();
+        }
+        matrices_[i] = node->globalMatrix_.mat;
+    }
+    return matrices_;
+}
+
+const std::vector<ofNode*>& ofNodeBatch::getNodes() const {
+    return nodes_;
+}
+
+const std::vector<simd_float4x4>& ofNodeBatch::getMatrices() const {
+    return matrices_;
+}
+
+size_t ofNodeBatch::size() const {
+    return nodes_.size();
+}
+
+void ofNodeBatch::clear() {
+    roots_.clear();
+    nodes_.clear();
+    parents_.clear();
+    matrices_.clear();
+    hierarchyVersion_ = 0;
+}
+
 } // namespace oflike
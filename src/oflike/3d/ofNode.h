@@ -7,6 +7,7 @@
 #include "../math/ofMatrix4x4.h"
 #include "../math/ofQuaternion.h"
 #include <vector>
+#include <cstdint>
 
 namespace oflike {
 
@@ -21,6 +22,12 @@ namespace oflike {
 /// - Local and global transform matrices
 /// - lookAt for easy orientation
 ///
+/// Implementation:
+/// - Local and global matrices (and the global orientation and scale) are
+///   cached; a change marks the node's local transform and its subtree's
+///   global transforms dirty, and queries recompute only the dirty chain
+/// - ofNodeBatch updates a whole hierarchy in one pass for instanced drawing
+///
 /// Example:
 /// \code
 ///     ofNode parent;
@@ -187,6 +194,7 @@ public:
     ofMatrix4x4 getLocalTransformMatrix() const;
 
     /// \brief Get global transform matrix (world space)
+    /// \details Cached; recomputed only after this node or an ancestor changed
     /// \return 4x4 world transformation matrix
     ofMatrix4x4 getGlobalTransformMatrix() const;
 
@@ -248,7 +256,10 @@ public:
     // ========================================================================
 
     /// \brief Called when transform changes
-    /// \details Override in subclasses to respond to transform updates
+    /// \details Override in subclasses to respond to transform updates.
+    /// Called on every change of the node's own transform; a descendant is
+    /// called once when an ancestor's change makes its global transform stale,
+    /// and again only after that transform has been queried.
     virtual void onTransformChanged();
 
 protected:
@@ -256,6 +267,9 @@ protected:
     // Internal State
     // ========================================================================
 
+    // Subclasses writing position_, orientation_ or scale_ directly must
+    // call notifyTransformChanged() so the cached matrices are recomputed
+
     /// Local position
     ofVec3f position_;
 
@@ -271,6 +285,14 @@ protected:
     /// Child nodes
     std::vector<ofNode*> children_;
 
+    /// Cached transforms (valid while the matching dirty flag is clear)
+    mutable ofMatrix4x4 localMatrix_;
+    mutable ofMatrix4x4 globalMatrix_;
+    mutable ofQuaternion globalOrientation_;
+    mutable ofVec3f globalScale_;
+    mutable bool localDirty_;
+    mutable bool globalDirty_;
+
     // ========================================================================
     // Internal Methods
     // ========================================================================
@@ -283,6 +305,80 @@ protected:
 
     /// \brief Notify transform changed (calls onTransformChanged and propagates to children)
     void notifyTransformChanged();
+
+private:
+    friend class ofNodeBatch;
+
+    /// \brief Mark the global transforms of this node and its subtree stale
+    /// \details Stops at descendants that are already stale: a node's cache
+    /// is only refreshed after its ancestors', so their subtrees are too.
+    void invalidateGlobalTransform();
+
+    /// \brief Recompute the cached global transforms if stale
+    void updateGlobalTransform() const;
+};
+
+// ============================================================================
+// ofNodeBatch
+// ============================================================================
+
+/// \brief Flattened node hierarchy for updating all world matrices at once
+/// \details build() lists the nodes below the given roots parents-first;
+/// update() then walks that list once, recomputing only stale nodes from
+/// their parent's fresh matrix, and writes every world matrix into one
+/// contiguous array in list order, ready to upload as instance transforms.
+/// The nodes' own caches are refreshed as well, so getGlobalTransformMatrix()
+/// afterwards is free.
+///
+/// Implementation:
+/// - Reparenting any node makes the list stale; update() rebuilds it from
+///   the same roots
+/// - The roots and their descendants must outlive the batch (or call clear())
+///
+/// Example:
+/// \code
+///     ofNodeBatch batch;
+///     batch.build(rig);                     // Root of a few hundred joints
+///
+///     void update() {
+///         animate(rig);                     // setPosition/rotate... on joints
+///         const auto& worlds = batch.update();
+///         for (size_t i = 0; i < worlds.size(); i++) {
+///             instances[i].modelMatrix = worlds[i];
+///         }
+///         jointMesh.setInstances(instances.data(), instances.size());
+///     }
+/// \endcode
+class ofNodeBatch {
+public:
+    /// \brief Flatten the hierarchy below one root (included)
+    void build(ofNode& root);
+
+    /// \brief Flatten the hierarchies below several roots (included)
+    void build(const std::vector<ofNode*>& roots);
+
+    /// \brief Recompute stale world matrices and return all of them
+    /// \return World matrices, one per node in getNodes() order
+    const std::vector<simd_float4x4>& update();
+
+    /// \brief Get the nodes in update order (parents before children)
+    const std::vector<ofNode*>& getNodes() const;
+
+    /// \brief Get the world matrices written by the last update()
+    const std::vector<simd_float4x4>& getMatrices() const;
+
+    /// \brief Get the number of nodes
+    size_t size() const;
+
+    /// \brief Forget the roots and nodes
+    void clear();
+
+private:
+    std::vector<ofNode*> roots_;
+    std::vector<ofNode*> nodes_;
+    std::vector<int32_t> parents_;          // Index into nodes_, -1 = root
+    std::vector<simd_float4x4> matrices_;
+    uint64_t hierarchyVersion_ = 0;
 };
 
 } // namespace oflike
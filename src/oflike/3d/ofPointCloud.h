@@ -0,0 +1,152 @@
+#pragma once
+
+// oflike-metal ofPointCloud - GPU-resident point clouds with octree level of detail
+// Points are quantized to 10 bytes, uploaded once and drawn as round point
+// sprites; each draw picks the octree nodes the view needs within a budget
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "../math/ofVec3f.h"
+#include "../types/ofColor.h"
+
+namespace oflike {
+
+class ofMesh;
+
+/// \brief Large static point cloud (LiDAR scans, photogrammetry, particles baked to disk)
+/// \details setPoints() builds the cloud once; draws then record only a few
+/// commands, however many points the cloud holds:
+///
+/// - Storage: points are reordered into an octree and packed in runs of 256
+///   that share one bounding box, as 16-bit normalized positions within it
+///   plus 8-bit RGBA (10 bytes per point, vs. 28 for ofMesh floats), in one
+///   resident buffer. 10 million points take about 100 MB of GPU memory.
+/// - Level of detail: every octree node keeps an evenly spread sample of its
+///   points and passes the rest to its children, so each node's subtree is
+///   one contiguous range. draw() walks the tree from the root, largest
+///   nodes on screen first, refining while a node's points would be further
+///   than setLodSpacing() pixels apart, and stops at the point budget.
+///   Far or off-screen parts draw a fraction of their points.
+/// - Drawing: point sprites sized in pixels, or in view-space units with
+///   size attenuation; the selected ranges merge into one draw per run of
+///   adjacent nodes.
+///
+/// The cloud must outlive frames recorded with its draws (as textures do).
+///
+/// Example:
+/// \code
+///     ofPointCloud cloud;
+///     cloud.setPoints(scan.getVertices(), scan.getColors());
+///     cloud.setPointSize(0.02f, true);     // 2 cm discs
+///
+///     void draw() {
+///         cam.begin();
+///         cloud.draw();
+///         cam.end();
+///     }
+/// \endcode
+class ofPointCloud {
+public:
+    static constexpr size_t kDefaultPointBudget = 5000000;
+
+    // ========================================================================
+    // Construction / Destruction
+    // ========================================================================
+
+    ofPointCloud();
+    ~ofPointCloud();
+
+    ofPointCloud(ofPointCloud&& other) noexcept;
+    ofPointCloud& operator=(ofPointCloud&& other) noexcept;
+
+    ofPointCloud(const ofPointCloud&) = delete;
+    ofPointCloud& operator=(const ofPointCloud&) = delete;
+
+    // ========================================================================
+    // Points
+    // ========================================================================
+
+    /// \brief Build the cloud from positions and optional colors
+    /// \details Sorts the points into the octree and uploads them; replaces
+    /// any previous points. Positions keep 1/65535 of their run's bounding
+    /// box, far below a point's size on screen.
+    /// \param positions Point positions
+    /// \param colors One color per point, or nullptr for white
+    /// \param count Number of points
+    /// \return false if count is 0 or the buffers could not be allocated
+    bool setPoints(const ofVec3f* positions, const ofColor* colors, size_t count);
+
+    /// \brief Build the cloud from vectors (colors empty or one per position)
+    bool setPoints(const std::vector<ofVec3f>& positions, const std::vector<ofColor>& colors = {});
+
+    /// \brief Build the cloud from a mesh's vertices and colors (indices are ignored)
+    bool setPoints(const ofMesh& mesh);
+
+    /// \brief Release the points and their buffers
+    void clear();
+
+    /// \brief Check whether the cloud holds points
+    bool isAllocated() const;
+
+    /// \brief Get the number of points
+    size_t getNumPoints() const;
+
+    /// \brief Get the number of octree nodes
+    size_t getNumNodes() const;
+
+    /// \brief Get the axis-aligned bounds of the points
+    /// \return false if the cloud is empty
+    bool getBounds(ofVec3f& min, ofVec3f& max) const;
+
+    // ========================================================================
+    // Appearance
+    // ========================================================================
+
+    /// \brief Set the point size
+    /// \param size Diameter in pixels, or in view-space units if sizeAttenuation
+    /// \param sizeAttenuation Shrink points with distance like geometry
+    void setPointSize(float size, bool sizeAttenuation = false);
+    float getPointSize() const;
+    bool getSizeAttenuation() const;
+
+    /// \brief Enable or disable depth testing and writing (default: enabled)
+    void setDepthTest(bool enabled);
+    bool getDepthTest() const;
+
+    // ========================================================================
+    // Level of Detail
+    // ========================================================================
+
+    /// \brief Set the most points one draw() may draw (default: 5 million)
+    void setPointBudget(size_t points);
+    size_t getPointBudget() const;
+
+    /// \brief Set the point spacing on screen, in pixels, below which nodes stop refining
+    /// \details Smaller values draw more points up close; 0 draws every
+    /// visible point the budget allows. Default: 1.
+    void setLodSpacing(float pixels);
+    float getLodSpacing() const;
+
+    /// \brief Get the number of points the last draw() recorded
+    size_t getNumDrawnPoints() const;
+
+    /// \brief Get the number of draw commands the last draw() recorded
+    size_t getNumDrawCalls() const;
+
+    // ========================================================================
+    // Drawing
+    // ========================================================================
+
+    /// \brief Draw the points the current view needs with the current transform and camera
+    void draw() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
+
+// Global namespace alias for openFrameworks compatibility
+using ofPointCloud = oflike::ofPointCloud;
@@ -0,0 +1,504 @@
+// ofPointCloud.mm - GPU-resident point clouds with octree level of detail
+
+#import <Metal/Metal.h>
+#include "ofPointCloud.h"
+#include "ofMesh.h"
+#include "FrustumCulling.h"
+#include "../../core/Context.h"
+#include "../../render/DrawList.h"
+#include "../../render/DrawCommand.h"
+#include "../../render/IRenderer.h"
+#include "../../render/RenderTypes.h"
+#include "../../render/metal/MetalAllocations.h"
+#include "../graphics/ofGraphicsTransform.h"
+#include "../utils/ofLog.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace oflike {
+
+using render::metal::makeTrackedBuffer;
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+// Most points a node keeps for itself; larger subtrees pass the rest down
+static constexpr size_t kNodeCapacity = 16384;
+
+// Octree depth: 10 bits of Morton code per axis
+static constexpr int kMaxDepth = 10;
+
+// ============================================================================
+// Octree Helpers
+// ============================================================================
+
+namespace {
+
+struct Node {
+    ofVec3f min;                    // Cube corner
+    float size = 0.0f;              // Cube edge
+    float spacing = 0.0f;           // Typical distance between the node's own points
+    uint32_t first = 0;             // Own points in the output order
+    uint32_t count = 0;
+    uint32_t children[8] = {};      // 0 = none (the root is never a child)
+};
+
+/// Spread the low 10 bits of v to every third bit
+uint32_t spreadBits(uint32_t v) {
+    v &= 0x3ff;
+    v = (v | (v << 16)) & 0x30000ff;
+    v = (v | (v << 8)) & 0x300f00f;
+    v = (v | (v << 4)) & 0x30c30c3;
+    v = (v | (v << 2)) & 0x9249249;
+    return v;
+}
+
+uint32_t octantOf(uint64_t key, int level) {
+    return static_cast<uint32_t>(key >> (32 + 3 * (kMaxDepth - 1 - level))) & 7;
+}
+
+} // namespace
+
+// ============================================================================
+// ofPointCloud::Impl
+// ============================================================================
+
+struct ofPointCloud::Impl {
+    id<MTLDevice> device = nil;
+
+    id<MTLBuffer> pointBuffer = nil;        // render::PointCloudPoint, octree order
+    id<MTLBuffer> chunkBuffer = nil;        // render::PointCloudChunk per kPointCloudChunkSize points
+    size_t pointCount = 0;
+    std::vector<Node> nodes;
+    ofVec3f boundsMin;
+    ofVec3f boundsMax;
+
+    float pointSize = 1.0f;
+    bool sizeAttenuation = false;
+    bool depthTest = true;
+    size_t pointBudget = kDefaultPointBudget;
+    float lodSpacing = 1.0f;
+
+    // Statistics of the last draw
+    size_t drawnPoints = 0;
+    size_t drawCalls = 0;
+
+    // Replaced buffers and the frame they were replaced in
+    std::vector<std::pair<id<MTLBuffer>, unsigned long long>> retired;
+
+    bool ensureDevice() {
+        if (device) return true;
+
+        auto& ctx = Context::instance();
+        if (!ctx.isInitialized()) {
+            return false;
+        }
+        device = (__bridge id<MTLDevice>)ctx.getMetalDevice();
+        return device != nil;
+    }
+
+    void retireBuffers(unsigned long long frame) {
+        size_t kept = 0;
+        for (auto& entry : retired) {
+            if (entry.second + render::kRetireFrames >= frame) {
+                retired[kept++] = std::move(entry);
+            }
+        }
+        retired.resize(kept);
+
+        if (pointBuffer) retired.emplace_back(pointBuffer, frame);
+        if (chunkBuffer) retired.emplace_back(chunkBuffer, frame);
+        pointBuffer = nil;
+        chunkBuffer = nil;
+        pointCount = 0;
+        nodes.clear();
+    }
+
+    /**
+     * Build the subtree of keys[begin, end): sorted Morton keys inside the
+     * cube at min with edge size. A node over capacity keeps every stride-th
+     * key (an even spread, since Morton order follows space) and splits the
+     * rest by octant; each subtree's points are appended contiguously.
+     */
+    uint32_t buildNode(std::vector<uint64_t>& keys, std::vector<uint32_t>& order,
+                       size_t begin, size_t end, int level, const ofVec3f& min, float size) {
+        const uint32_t index = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+        nodes[index].min = min;
+        nodes[index].size = size;
+        nodes[index].first = static_cast<uint32_t>(order.size());
+
+        const size_t n = end - begin;
+        const bool leaf = n <= kNodeCapacity || level == kMaxDepth;
+        const size_t stride = leaf ? 1 : (n + kNodeCapacity - 1) / kNodeCapacity;
+        size_t rest = begin;
+        for (size_t i = begin; i < end; i++) {
+            if ((i - begin) % stride == 0) {
+                order.push_back(static_cast<uint32_t>(keys[i]));
+            } else {
+                keys[rest++] = keys[i];
+            }
+        }
+        const uint32_t count = static_cast<uint32_t>(order.size() - nodes[index].first);
+        nodes[index].count = count;
+        // Scans sample surfaces, so points spread over an area of size^2
+        nodes[index].spacing = size / std::sqrt(static_cast<float>(count));
+
+        // Remaining keys are still sorted, so each octant is one run
+        const float half = size * 0.5f;
+        size_t childBegin = begin;
+        while (childBegin < rest) {
+            const uint32_t octant = octantOf(keys[childBegin], level);
+            size_t childEnd = childBegin + 1;
+            while (childEnd < rest && octantOf(keys[childEnd], level) == octant) {
+                childEnd++;
+            }
+            const ofVec3f childMin(min.x + ((octant & 1) ? half : 0.0f),
+                                   min.y + ((octant & 2) ? half : 0.0f),
+                                   min.z + ((octant & 4) ? half : 0.0f));
+            const uint32_t child = buildNode(keys, order, childBegin, childEnd, level + 1, childMin, half);
+            nodes[index].children[octant] = child;
+            childBegin = childEnd;
+        }
+        return index;
+    }
+
+    bool build(const ofVec3f* positions, const ofColor* colors, size_t count) {
+        retireBuffers(Context::instance().getFrameNum());
+        if (count == 0 || !positions) {
+            return false;
+        }
+        if (count > UINT32_MAX) {
+            ofLogError("ofPointCloud") << "More than " << UINT32_MAX << " points";
+            return false;
+        }
+        if (!ensureDevice()) {
+            return false;
+        }
+
+        const size_t chunkCount = (count + render::kPointCloudChunkSize - 1) / render::kPointCloudChunkSize;
+        const size_t pointBytes = count * sizeof(render::PointCloudPoint);
+        const size_t chunkBytes = chunkCount * sizeof(render::PointCloudChunk);
+        if (pointBytes > [device maxBufferLength]) {
+            ofLogError("ofPointCloud") << count << " points exceed the device's largest buffer";
+            return false;
+        }
+
+        // Cubic bounds, so octree nodes stay cubes
+        computeBounds(&positions[0].x, count, sizeof(ofVec3f) / sizeof(float), boundsMin, boundsMax);
+        const float size = std::max({boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y,
+                                     boundsMax.z - boundsMin.z, 1e-6f});
+
+        // Morton code in the high 32 bits, point index in the low ones
+        std::vector<uint64_t> keys(count);
+        const float scale = 1024.0f / size;
+        for (size_t i = 0; i < count; i++) {
+            const ofVec3f& p = positions[i];
+            const uint32_t x = std::min<uint32_t>(static_cast<uint32_t>((p.x - boundsMin.x) * scale), 1023);
+            const uint32_t y = std::min<uint32_t>(static_cast<uint32_t>((p.y - boundsMin.y) * scale), 1023);
+            const uint32_t z = std::min<uint32_t>(static_cast<uint32_t>((p.z - boundsMin.z) * scale), 1023);
+            const uint64_t code = spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2);
+            keys[i] = (code << 32) | i;
+        }
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<uint32_t> order;
+        order.reserve(count);
+        buildNode(keys, order, 0, count, 0, boundsMin, size);
+        keys = {};
+
+        id<MTLBuffer> points = makeTrackedBuffer(device, pointBytes, MTLResourceStorageModeShared,
+                                                 ofGpuMemoryCategory::Meshes, "ofPointCloud Points");
+        id<MTLBuffer> chunks = makeTrackedBuffer(device, chunkBytes, MTLResourceStorageModeShared,
+                                                 ofGpuMemoryCategory::Meshes, "ofPointCloud Chunks");
+        if (!points || !chunks) {
+            ofLogError("ofPointCloud") << "Failed to allocate buffers for " << count << " points";
+            nodes.clear();
+            return false;
+        }
+
+        // Quantize each chunk within its own bounds
+        render::PointCloudPoint* dstPoints = (render::PointCloudPoint*)[points contents];
+        render::PointCloudChunk* dstChunks = (render::PointCloudChunk*)[chunks contents];
+        const uint32_t* src = order.data();
+        dispatch_apply(chunkCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t chunk) {
+            const size_t begin = chunk * render::kPointCloudChunkSize;
+            const size_t end = std::min(begin + render::kPointCloudChunkSize, count);
+            float lo[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+            float hi[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+            for (size_t i = begin; i < end; i++) {
+                const float* p = &positions[src[i]].x;
+                for (int axis = 0; axis < 3; axis++) {
+                    lo[axis] = std::min(lo[axis], p[axis]);
+                    hi[axis] = std::max(hi[axis], p[axis]);
+                }
+            }
+
+            render::PointCloudChunk& bounds = dstChunks[chunk];
+            float invExtent[3];
+            for (int axis = 0; axis < 3; axis++) {
+                bounds.positionMin[axis] = lo[axis];
+                bounds.positionExtent[axis] = hi[axis] - lo[axis];
+                invExtent[axis] = bounds.positionExtent[axis] > 0.0f ? 65535.0f / bounds.positionExtent[axis] : 0.0f;
+            }
+
+            for (size_t i = begin; i < end; i++) {
+                const float* p = &positions[src[i]].x;
+                render::PointCloudPoint& point = dstPoints[i];
+                for (int axis = 0; axis < 3; axis++) {
+                    const float q = std::round((p[axis] - lo[axis]) * invExtent[axis]);
+                    point.position[axis] = static_cast<uint16_t>(std::min(std::max(q, 0.0f), 65535.0f));
+                }
+                if (colors) {
+                    const ofColor& c = colors[src[i]];
+                    point.color[0] = c.r;
+                    point.color[1] = c.g;
+                    point.color[2] = c.b;
+                    point.color[3] = c.a;
+                } else {
+                    point.color[0] = point.color[1] = point.color[2] = point.color[3] = 255;
+                }
+            }
+        });
+
+        pointBuffer = points;
+        chunkBuffer = chunks;
+        pointCount = count;
+        return true;
+    }
+};
+
+// ============================================================================
+// Construction / Destruction
+// ============================================================================
+
+ofPointCloud::ofPointCloud()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ofPointCloud::~ofPointCloud() = default;
+
+ofPointCloud::ofPointCloud(ofPointCloud&& other) noexcept
+    : impl_(std::exchange(other.impl_, std::make_unique<Impl>())) {
+}
+
+ofPointCloud& ofPointCloud::operator=(ofPointCloud&& other) noexcept {
+    if (this != &other) {
+        impl_ = std::exchange(other.impl_, std::make_unique<Impl>());
+    }
+    return *this;
+}
+
+// ============================================================================
+// Points
+// ============================================================================
+
+bool ofPointCloud::setPoints(const ofVec3f* positions, const ofColor* colors, size_t count) {
+    return impl_->build(positions, colors, count);
+}
+
+bool ofPointCloud::setPoints(const std::vector<ofVec3f>& positions, const std::vector<ofColor>& colors) {
+    if (!colors.empty() && colors.size() != positions.size()) {
+        ofLogError("ofPointCloud") << "setPoints(): " << colors.size() << " colors for "
+                                   << positions.size() << " positions";
+        return false;
+    }
+    return impl_->build(positions.data(), colors.empty() ? nullptr : colors.data(), positions.size());
+}
+
+bool ofPointCloud::setPoints(const ofMesh& mesh) {
+    const std::vector<ofColor>& colors = mesh.getColors();
+    return setPoints(mesh.getVertices(), colors.size() == mesh.getNumVertices() ? colors : std::vector<ofColor>());
+}
+
+void ofPointCloud::clear() {
+    impl_->retireBuffers(Context::instance().getFrameNum());
+    impl_->drawnPoints = 0;
+    impl_->drawCalls = 0;
+}
+
+bool ofPointCloud::isAllocated() const {
+    return impl_->pointBuffer != nil;
+}
+
+size_t ofPointCloud::getNumPoints() const {
+    return impl_->pointCount;
+}
+
+size_t ofPointCloud::getNumNodes() const {
+    return impl_->nodes.size();
+}
+
+bool ofPointCloud::getBounds(ofVec3f& min, ofVec3f& max) const {
+    if (!isAllocated()) {
+        return false;
+    }
+    min = impl_->boundsMin;
+    max = impl_->boundsMax;
+    return true;
+}
+
+// ============================================================================
+// Appearance
+// ============================================================================
+
+void ofPointCloud::setPointSize(float size, bool sizeAttenuation) {
+    impl_->pointSize = std::max(size, 0.0f);
+    impl_->sizeAttenuation = sizeAttenuation;
+}
+
+float ofPointCloud::getPointSize() const {
+    return impl_->pointSize;
+}
+
+bool ofPointCloud::getSizeAttenuation() const {
+    return impl_->sizeAttenuation;
+}
+
+void ofPointCloud::setDepthTest(bool enabled) {
+    impl_->depthTest = enabled;
+}
+
+bool ofPointCloud::getDepthTest() const {
+    return impl_->depthTest;
+}
+
+// ============================================================================
+// Level of Detail
+// ============================================================================
+
+void ofPointCloud::setPointBudget(size_t points) {
+    impl_->pointBudget = points;
+}
+
+size_t ofPointCloud::getPointBudget() const {
+    return impl_->pointBudget;
+}
+
+void ofPointCloud::setLodSpacing(float pixels) {
+    impl_->lodSpacing = std::max(pixels, 0.0f);
+}
+
+float ofPointCloud::getLodSpacing() const {
+    return impl_->lodSpacing;
+}
+
+size_t ofPointCloud::getNumDrawnPoints() const {
+    return impl_->drawnPoints;
+}
+
+size_t ofPointCloud::getNumDrawCalls() const {
+    return impl_->drawCalls;
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+void ofPointCloud::draw() const {
+    Impl& impl = *impl_;
+    impl.drawnPoints = 0;
+    impl.drawCalls = 0;
+    auto& ctx = Context::instance();
+    if (!isAllocated() || !ctx.isInitialized()) {
+        return;
+    }
+
+    const simd_float4x4& modelView = ofGetCurrentModelViewMatrix();
+    const simd_float4x4 projection = ctx.getProjectionMatrix();
+    const simd_float4x4 modelViewProjection = simd_mul(projection, modelView);
+    const bool cull = isFrustumCullingActive();
+
+    // Pixels per model unit at clip w = 1 (see projectedDiameter())
+    const float modelScale = std::sqrt(std::max({simd_length_squared(simd_make_float3(modelView.columns[0])),
+                                                 simd_length_squared(simd_make_float3(modelView.columns[1])),
+                                                 simd_length_squared(simd_make_float3(modelView.columns[2]))}));
+    const float pixelsPerUnit = 0.5f * std::abs(projection.columns[1].y) * ctx.getViewport().w * modelScale;
+    const bool perspective = projection.columns[3].w == 0.0f;
+
+    // Screen size of a node's cube: FLT_MAX when the camera is inside it
+    auto projectedSize = [&](const Node& node) {
+        const float half = node.size * 0.5f;
+        const simd_float4 clip = simd_mul(modelViewProjection,
+                                          simd_make_float4(node.min.x + half, node.min.y + half, node.min.z + half, 1.0f));
+        const float viewRadius = half * 1.7320508f * modelScale;
+        if (perspective && clip.w <= viewRadius) {
+            return FLT_MAX;
+        }
+        return node.size * pixelsPerUnit / clip.w;
+    };
+
+    // Largest nodes on screen first, so the budget goes where it shows most
+    using Entry = std::pair<float, uint32_t>;
+    std::priority_queue<Entry> queue;
+    queue.emplace(FLT_MAX, 0);
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    size_t budget = impl.pointBudget;
+
+    while (!queue.empty()) {
+        const Entry entry = queue.top();
+        queue.pop();
+        const Node& node = impl.nodes[entry.second];
+        if (cull && isBoxOutsideFrustum(node.min, node.min + ofVec3f(node.size, node.size, node.size),
+                                        modelViewProjection)) {
+            continue;
+        }
+        if (node.count > budget) {
+            break;
+        }
+        budget -= node.count;
+        ranges.emplace_back(node.first, node.count);
+
+        // Refine while the node's points are further apart than the target
+        const float screenSize = entry.second == 0 ? projectedSize(node) : entry.first;
+        const float spacing = screenSize == FLT_MAX ? FLT_MAX : screenSize / node.size * node.spacing;
+        if (spacing <= impl.lodSpacing) {
+            continue;
+        }
+        for (uint32_t child : node.children) {
+            if (child) {
+                queue.emplace(projectedSize(impl.nodes[child]), child);
+            }
+        }
+    }
+
+    // Adjacent ranges (a node and its first drawn descendants) draw together
+    std::sort(ranges.begin(), ranges.end());
+    size_t merged = 0;
+    for (size_t i = 1; i < ranges.size(); i++) {
+        if (ranges[merged].first + ranges[merged].second == ranges[i].first) {
+            ranges[merged].second += ranges[i].second;
+        } else {
+            ranges[++merged] = ranges[i];
+        }
+    }
+    if (!ranges.empty()) {
+        ranges.resize(merged + 1);
+    }
+
+    render::DrawPointCloudCommand cmd;
+    cmd.pointBuffer = (__bridge void*)impl.pointBuffer;
+    cmd.chunkBuffer = (__bridge void*)impl.chunkBuffer;
+    cmd.modelViewMatrix = modelView;
+    cmd.projectionMatrix = projection;
+    cmd.pointSize = impl.pointSize;
+    cmd.sizeAttenuation = impl.sizeAttenuation;
+    cmd.depthTestEnabled = impl.depthTest;
+    cmd.blendMode = render::BlendMode::Alpha;
+
+    auto& drawList = ctx.getDrawList();
+    for (const auto& range : ranges) {
+        cmd.firstPoint = range.first;
+        cmd.pointCount = range.second;
+        drawList.addCommand(cmd);
+        impl.drawnPoints += range.second;
+        impl.drawCalls++;
+    }
+}
+
+} // namespace oflike
@@ -0,0 +1,136 @@
+#pragma once
+
+// oflike-metal ofBufferObject - openFrameworks API compatible GPU buffer
+// Raw GPU memory for compute kernels and custom shaders (particles, fields)
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace oflike {
+
+/// \brief Where the buffer's memory lives
+enum ofBufferUsage {
+    OF_BUFFER_SHARED,       ///< CPU and GPU visible (unified memory); updateData() and getData() work
+    OF_BUFFER_GPU_ONLY,     ///< GPU private; written by kernels, filled once by allocate()
+};
+
+/// \brief GPU buffer for compute shaders and custom shaders
+/// \details ofBufferObject wraps one MTLBuffer. Bind it to an
+/// ofComputeShader to read or write it from a kernel, and to the draws that
+/// consume the results. Kernels and draws run in the frame's command buffer
+/// in the order they were recorded, and Metal tracks the buffer's hazards,
+/// so a draw recorded after a dispatch sees what the dispatch wrote.
+///
+/// Features:
+/// - Shared (CPU-visible) or private storage
+/// - Typed allocate/update helpers for std::vector data
+/// - Counted in ofGpuMemory under Meshes
+///
+/// Implementation:
+/// - CPU writes land immediately: updateData() on a buffer the GPU is still
+///   reading from an earlier frame races with it. Keep per-frame CPU data in
+///   the dispatch constants (ofComputeShader::setConstants()) or in one
+///   buffer per frame in flight; data the GPU keeps (particle state) is best
+///   left to kernels
+/// - getData() sees kernel writes once the frame that ran them has finished
+///   on the GPU
+/// - Thread-safety: Main thread only
+///
+/// Example:
+/// \code
+///     ofBufferObject particles;
+///     particles.allocate(std::vector<Particle>(1000000));
+///
+///     compute.setBuffer(0, particles);
+///     compute.dispatch(1000000);
+/// \endcode
+class ofBufferObject {
+public:
+    ofBufferObject();
+    ~ofBufferObject();
+
+    ofBufferObject(ofBufferObject&& other) noexcept;
+    ofBufferObject& operator=(ofBufferObject&& other) noexcept;
+
+    ofBufferObject(const ofBufferObject&) = delete;
+    ofBufferObject& operator=(const ofBufferObject&) = delete;
+
+    // ========================================================================
+    // Allocation
+    // ========================================================================
+
+    /// \brief Allocate zeroed memory
+    /// \param bytes Size in bytes
+    /// \param usage Storage (default: shared)
+    /// \return false if the buffer couldn't be created
+    bool allocate(size_t bytes, ofBufferUsage usage = OF_BUFFER_SHARED);
+
+    /// \brief Allocate and fill with a copy of data
+    /// \param bytes Size in bytes
+    /// \param data Initial contents (nullptr = zeroed)
+    /// \param usage Storage; private buffers are filled through a blit
+    /// \return false if the buffer couldn't be created
+    bool allocate(size_t bytes, const void* data, ofBufferUsage usage = OF_BUFFER_SHARED);
+
+    /// \brief Allocate and fill from a vector
+    template<typename T>
+    bool allocate(const std::vector<T>& data, ofBufferUsage usage = OF_BUFFER_SHARED) {
+        return allocate(data.size() * sizeof(T), data.data(), usage);
+    }
+
+    /// \brief Release the buffer
+    void clear();
+
+    /// \brief Check if allocated
+    bool isAllocated() const;
+
+    /// \brief Get the size in bytes
+    size_t size() const;
+
+    /// \brief Get the storage
+    ofBufferUsage getUsage() const;
+
+    // ========================================================================
+    // CPU Access (shared buffers)
+    // ========================================================================
+
+    /// \brief Overwrite part of the buffer
+    /// \param offset Byte offset
+    /// \param bytes Number of bytes
+    /// \param data Source
+    /// \return false for private buffers or an out-of-range write
+    bool updateData(size_t offset, size_t bytes, const void* data);
+
+    /// \brief Overwrite the start of the buffer from a vector
+    template<typename T>
+    bool updateData(const std::vector<T>& data, size_t offset = 0) {
+        return updateData(offset, data.size() * sizeof(T), data.data());
+    }
+
+    /// \brief Copy part of the buffer out
+    /// \param offset Byte offset
+    /// \param bytes Number of bytes
+    /// \param dst Destination
+    /// \return false for private buffers or an out-of-range read
+    bool getData(size_t offset, size_t bytes, void* dst) const;
+
+    /// \brief Get a CPU pointer to the contents
+    /// \return The mapping, or nullptr for private buffers
+    void* map();
+    const void* map() const;
+
+    // ========================================================================
+    // Native Access
+    // ========================================================================
+
+    /// \brief Get native buffer
+    /// \return id<MTLBuffer> or nullptr
+    void* getNativeHandle() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
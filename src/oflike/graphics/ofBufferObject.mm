@@ -0,0 +1,158 @@
+#import "ofBufferObject.h"
+#import "../../core/Context.h"
+#import "../../render/metal/MetalAllocations.h"
+#import "../utils/ofLog.h"
+#import <Metal/Metal.h>
+#include <cstring>
+
+namespace oflike {
+
+// ============================================================================
+// ofBufferObject::Impl
+// ============================================================================
+
+struct ofBufferObject::Impl {
+    id<MTLBuffer> buffer = nil;
+    ofBufferUsage usage = OF_BUFFER_SHARED;
+
+    // Fill a private buffer through a blit; allocation time only, so the
+    // CPU waits for it
+    bool fillPrivate(id<MTLDevice> device, const void* data, size_t bytes) {
+        static id<MTLCommandQueue> queue = nil;
+        if (!queue || queue.device != device) {
+            queue = [device newCommandQueue];
+        }
+        id<MTLCommandBuffer> commandBuffer = [queue commandBuffer];
+        id<MTLBlitCommandEncoder> blit = [commandBuffer blitCommandEncoder];
+        if (!blit) {
+            return false;
+        }
+
+        if (data) {
+            id<MTLBuffer> staging = render::metal::makeTrackedBuffer(device, data, bytes, MTLResourceStorageModeShared,
+                                                                     ofGpuMemoryCategory::Staging,
+                                                                     "ofBufferObject Staging");
+            if (!staging) {
+                [blit endEncoding];
+                return false;
+            }
+            [blit copyFromBuffer:staging sourceOffset:0 toBuffer:buffer destinationOffset:0 size:bytes];
+        } else {
+            [blit fillBuffer:buffer range:NSMakeRange(0, bytes) value:0];
+        }
+        [blit endEncoding];
+        [commandBuffer commit];
+        [commandBuffer waitUntilCompleted];
+        return commandBuffer.status == MTLCommandBufferStatusCompleted;
+    }
+};
+
+// ============================================================================
+// ofBufferObject
+// ============================================================================
+
+ofBufferObject::ofBufferObject() : impl_(std::make_unique<Impl>()) {}
+
+ofBufferObject::~ofBufferObject() = default;
+
+ofBufferObject::ofBufferObject(ofBufferObject&& other) noexcept = default;
+
+ofBufferObject& ofBufferObject::operator=(ofBufferObject&& other) noexcept = default;
+
+bool ofBufferObject::allocate(size_t bytes, ofBufferUsage usage) {
+    return allocate(bytes, nullptr, usage);
+}
+
+bool ofBufferObject::allocate(size_t bytes, const void* data, ofBufferUsage usage) {
+    if (!impl_) {
+        impl_ = std::make_unique<Impl>();
+    }
+    @autoreleasepool {
+        clear();
+        void* devicePtr = Context::instance().getMetalDevice();
+        if (!devicePtr || bytes == 0) {
+            ofLogError("ofBufferObject") << "Cannot allocate " << bytes << " bytes";
+            return false;
+        }
+        id<MTLDevice> device = (__bridge id<MTLDevice>)devicePtr;
+
+        // Tracked: dispatches and the draws after them are ordered by Metal
+        const MTLResourceOptions options = MTLResourceHazardTrackingModeTracked |
+            (usage == OF_BUFFER_GPU_ONLY ? MTLResourceStorageModePrivate : MTLResourceStorageModeShared);
+        impl_->buffer = render::metal::makeTrackedBuffer(device, bytes, options, ofGpuMemoryCategory::Meshes,
+                                                         "ofBufferObject");
+        if (!impl_->buffer) {
+            ofLogError("ofBufferObject") << "Failed to allocate " << bytes << " bytes";
+            return false;
+        }
+        impl_->usage = usage;
+
+        if (usage == OF_BUFFER_GPU_ONLY) {
+            if (!impl_->fillPrivate(device, data, bytes)) {
+                ofLogError("ofBufferObject") << "Failed to fill the private buffer";
+                clear();
+                return false;
+            }
+        } else if (data) {
+            std::memcpy([impl_->buffer contents], data, bytes);
+        } else {
+            std::memset([impl_->buffer contents], 0, bytes);
+        }
+        return true;
+    }
+}
+
+void ofBufferObject::clear() {
+    if (impl_) {
+        impl_->buffer = nil;
+    }
+}
+
+bool ofBufferObject::isAllocated() const {
+    return impl_ && impl_->buffer != nil;
+}
+
+size_t ofBufferObject::size() const {
+    return isAllocated() ? impl_->buffer.length : 0;
+}
+
+ofBufferUsage ofBufferObject::getUsage() const {
+    return impl_ ? impl_->usage : OF_BUFFER_SHARED;
+}
+
+bool ofBufferObject::updateData(size_t offset, size_t bytes, const void* data) {
+    void* contents = map();
+    if (!contents || !data || offset + bytes > size()) {
+        ofLogWarning("ofBufferObject") << "updateData() out of range or on a GPU-only buffer";
+        return false;
+    }
+    std::memcpy(static_cast<uint8_t*>(contents) + offset, data, bytes);
+    return true;
+}
+
+bool ofBufferObject::getData(size_t offset, size_t bytes, void* dst) const {
+    const void* contents = map();
+    if (!contents || !dst || offset + bytes > size()) {
+        ofLogWarning("ofBufferObject") << "getData() out of range or on a GPU-only buffer";
+        return false;
+    }
+    std::memcpy(dst, static_cast<const uint8_t*>(contents) + offset, bytes);
+    return true;
+}
+
+void* ofBufferObject::map() {
+    if (!isAllocated() || impl_->usage == OF_BUFFER_GPU_ONLY) {
+        return nullptr;
+    }
+    return [impl_->buffer contents];
+}
+
+const void* ofBufferObject::map() const {
+    return const_cast<ofBufferObject*>(this)->map();
+}
+
+void* ofBufferObject::getNativeHandle() const {
+    return isAllocated() ? (__bridge void*)impl_->buffer : nullptr;
+}
+
+} // namespace oflike
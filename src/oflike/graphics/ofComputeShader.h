@@ -0,0 +1,178 @@
+#pragma once
+
+// oflike-metal ofComputeShader - compute kernels dispatched in the frame
+// Runs user Metal kernels over 1D/2D/3D grids between the frame's draws
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace oflike {
+
+// Forward declarations
+class ofBufferObject;
+class ofTexture;
+class VboMesh;
+
+/// \brief User compute kernel, dispatched into the frame's command buffer
+/// \details dispatch() records the kernel into the current draw list like a
+/// draw: it runs on the GPU in recording order, between the draws before
+/// and after it. The bindings and constants at the time of the call are
+/// captured, so one shader can be dispatched several times per frame with
+/// different inputs. Buffers and textures are hazard-tracked, so draws
+/// recorded after a dispatch see its writes without explicit barriers.
+///
+/// Features:
+/// - Load kernels from the app's default library, .metallib or .metal source
+/// - 1D, 2D and 3D grids; whole threadgroups, so kernels bounds-check
+/// - Buffers from ofBufferObject, VboMesh vertices or native handles;
+///   textures from ofTexture (allocateWritable() for kernel writes)
+/// - Up to 128 bytes of inline constants per dispatch
+///
+/// Bindings:
+/// - buffer(0..n-1): setBuffer() slots, where n is one past the highest set
+/// - buffer(n): the constants, if any
+/// - texture(0..3): setTexture() slots
+///
+/// Implementation:
+/// - A dispatch in the middle of drawing ends the render encoder, and the
+///   next draw reloads the attachments; dispatch in update() or at the start
+///   of draw() where possible
+/// - Thread-safety: Main thread only (or a thread with a bound draw list)
+///
+/// Example:
+/// \code
+///     // particles.metal
+///     kernel void step(device Particle* particles [[buffer(0)]],
+///                      constant StepParams& params [[buffer(1)]],
+///                      uint id [[thread_position_in_grid]]) {
+///         if (id >= params.count) return;
+///         particles[id].position += particles[id].velocity * params.dt;
+///     }
+///
+///     ofComputeShader step;
+///     step.load("particles", "step");
+///
+///     void update() {
+///         StepParams params = {kCount, ofGetLastFrameTime()};
+///         step.setBuffer(0, particles);
+///         step.setConstants(params);
+///         step.dispatch(kCount);
+///     }
+/// \endcode
+class ofComputeShader {
+public:
+    static constexpr uint32_t kMaxBuffers = 8;
+    static constexpr uint32_t kMaxTextures = 4;
+    static constexpr size_t kMaxConstantsSize = 128;
+
+    ofComputeShader();
+    ~ofComputeShader();
+
+    ofComputeShader(ofComputeShader&& other) noexcept;
+    ofComputeShader& operator=(ofComputeShader&& other) noexcept;
+
+    ofComputeShader(const ofComputeShader&) = delete;
+    ofComputeShader& operator=(const ofComputeShader&) = delete;
+
+    // ========================================================================
+    // Loading
+    // ========================================================================
+
+    /// \brief Load a kernel
+    /// \param shaderName Base name without extension (e.g., "shaders/particles")
+    /// \param kernelName Kernel function name
+    /// \return true if loaded successfully
+    /// \details Looks for the kernel in the app's default library, then
+    /// {shaderName}.metallib, then compiles {shaderName}.metal.
+    bool load(const std::string& shaderName, const std::string& kernelName = "compute_main");
+
+    /// \brief Compile a kernel from source
+    /// \param source Metal source code
+    /// \param kernelName Kernel function name
+    /// \return true if compiled successfully
+    bool loadFromSource(const std::string& source, const std::string& kernelName = "compute_main");
+
+    /// \brief Unload the kernel and clear the bindings
+    void unload();
+
+    /// \brief Check if a kernel is loaded
+    bool isLoaded() const;
+
+    // ========================================================================
+    // Bindings
+    // ========================================================================
+
+    /// \brief Bind a buffer at buffer(index)
+    void setBuffer(uint32_t index, const ofBufferObject& buffer, size_t offset = 0);
+
+    /// \brief Bind a mesh's vertex buffer at buffer(index)
+    /// \details Interleaved meshes only; static meshes have one buffer, so a
+    /// kernel can animate their vertices in place.
+    void setBuffer(uint32_t index, const VboMesh& mesh);
+
+    /// \brief Bind a native buffer at buffer(index)
+    /// \param buffer id<MTLBuffer> handle (nullptr unbinds)
+    void setBuffer(uint32_t index, void* buffer, size_t offset = 0);
+
+    /// \brief Bind a texture at texture(index)
+    void setTexture(uint32_t index, const ofTexture& texture);
+
+    /// \brief Bind a native texture at texture(index)
+    /// \param texture id<MTLTexture> handle (nullptr unbinds)
+    void setTexture(uint32_t index, void* texture);
+
+    /// \brief Set the inline constants for the following dispatches
+    /// \param data Constant bytes (nullptr clears them)
+    /// \param size Size in bytes (at most kMaxConstantsSize)
+    /// \return false if the constants are too large
+    bool setConstants(const void* data, size_t size);
+
+    /// \brief Set the inline constants from a struct
+    template<typename T>
+    bool setConstants(const T& constants) {
+        static_assert(sizeof(T) <= kMaxConstantsSize, "Constants must fit in 128 bytes");
+        return setConstants(&constants, sizeof(T));
+    }
+
+    /// \brief Clear all buffers, textures and constants
+    void clearBindings();
+
+    // ========================================================================
+    // Dispatch
+    // ========================================================================
+
+    /// \brief Record a dispatch over a grid of threads
+    /// \param width Threads in x
+    /// \param height Threads in y (1 for 1D grids)
+    /// \param depth Threads in z (1 for 1D/2D grids)
+    /// \return false if nothing is loaded or no draw list can record
+    bool dispatch(uint32_t width, uint32_t height = 1, uint32_t depth = 1);
+
+    /// \brief Set the threadgroup size (0 = chosen from the pipeline)
+    /// \details Width x height x depth must not exceed getMaxTotalThreadsPerThreadgroup().
+    void setThreadgroupSize(uint32_t width, uint32_t height = 1, uint32_t depth = 1);
+
+    /// \brief Get the SIMD-group width of the kernel
+    uint32_t getThreadExecutionWidth() const;
+
+    /// \brief Get the largest threadgroup the kernel supports
+    uint32_t getMaxTotalThreadsPerThreadgroup() const;
+
+    // ========================================================================
+    // Native Access
+    // ========================================================================
+
+    /// \brief Get native compute pipeline
+    /// \return id<MTLComputePipelineState> or nullptr
+    void* getNativePipelineState() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+
+    void ensureImpl();
+};
+
+} // namespace oflike
@@ -0,0 +1,292 @@
+#import "ofComputeShader.h"
+#import "ofBufferObject.h"
+#import "../3d/VboMesh.h"
+#import "../image/ofTexture.h"
+#import "../../core/Context.h"
+#import "../../render/DrawList.h"
+#import "../../render/DrawCommand.h"
+#import "../../render/IRenderer.h"
+#import "../utils/ofLog.h"
+#import <Metal/Metal.h>
+#import <Foundation/Foundation.h>
+#include <algorithm>
+#include <cstring>
+
+namespace oflike {
+
+static_assert(ofComputeShader::kMaxBuffers == render::DispatchComputeCommand::kMaxBuffers &&
+              ofComputeShader::kMaxTextures == render::DispatchComputeCommand::kMaxTextures &&
+              ofComputeShader::kMaxConstantsSize == render::DispatchComputeCommand::kMaxConstantsSize,
+              "ofComputeShader limits must match DispatchComputeCommand");
+
+// ============================================================================
+// ofComputeShader::Impl
+// ============================================================================
+
+struct ofComputeShader::Impl {
+    id<MTLComputePipelineState> pipeline = nil;
+    std::string kernelName;
+
+    // Bindings captured by every dispatch
+    render::DispatchComputeCommand bindings;
+
+    id<MTLDevice> getDevice() const {
+        void* devicePtr = Context::instance().getMetalDevice();
+        return devicePtr ? (__bridge id<MTLDevice>)devicePtr : nil;
+    }
+
+    static id<MTLLibrary> compile(id<MTLDevice> device, NSString* source) {
+        MTLCompileOptions* options = [[MTLCompileOptions alloc] init];
+        options.fastMathEnabled = YES;
+        NSError* error = nil;
+        id<MTLLibrary> library = [device newLibraryWithSource:source options:options error:&error];
+        if (!library) {
+            ofLogError("ofComputeShader") << "Compilation failed: " << error.localizedDescription.UTF8String;
+        }
+        return library;
+    }
+
+    // Default library, then {path}.metallib (file or bundle), then {path}.metal
+    static id<MTLLibrary> findLibrary(id<MTLDevice> device, const std::string& path, NSString* function) {
+        id<MTLLibrary> library = [device newDefaultLibrary];
+        if (library && [library.functionNames containsObject:function]) {
+            return library;
+        }
+
+        NSString* base = [NSString stringWithUTF8String:path.c_str()];
+        NSString* bundled = [[NSBundle mainBundle] pathForResource:base.lastPathComponent ofType:@"metallib"];
+        for (NSString* file in @[[base stringByAppendingString:@".metallib"], bundled ?: @""]) {
+            if (file.length > 0 && [[NSFileManager defaultManager] fileExistsAtPath:file]) {
+                NSError* error = nil;
+                library = [device newLibraryWithURL:[NSURL fileURLWithPath:file] error:&error];
+                if (library) {
+                    return library;
+                }
+                ofLogError("ofComputeShader") << "Failed to load " << file.UTF8String << ": "
+                                              << error.localizedDescription.UTF8String;
+            }
+        }
+
+        NSString* sourcePath = [base stringByAppendingString:@".metal"];
+        if (![[NSFileManager defaultManager] fileExistsAtPath:sourcePath]) {
+            sourcePath = [[NSBundle mainBundle] pathForResource:base.lastPathComponent ofType:@"metal"];
+        }
+        NSString* source = sourcePath ? [NSString stringWithContentsOfFile:sourcePath
+                                                                  encoding:NSUTF8StringEncoding
+                                                                     error:nil]
+                                      : nil;
+        return source ? compile(device, source) : nil;
+    }
+
+    bool createPipeline(id<MTLLibrary> library, const std::string& name) {
+        unload();
+        if (!library) {
+            return false;
+        }
+        id<MTLFunction> function = [library newFunctionWithName:[NSString stringWithUTF8String:name.c_str()]];
+        if (!function || function.functionType != MTLFunctionTypeKernel) {
+            ofLogError("ofComputeShader") << "Kernel '" << name << "' not found";
+            return false;
+        }
+
+        NSError* error = nil;
+        pipeline = [library.device newComputePipelineStateWithFunction:function error:&error];
+        if (!pipeline) {
+            ofLogError("ofComputeShader") << "Pipeline creation failed: " << error.localizedDescription.UTF8String;
+            return false;
+        }
+        kernelName = name;
+        return true;
+    }
+
+    void unload() {
+        pipeline = nil;
+        kernelName.clear();
+    }
+
+    void setBuffer(uint32_t index, void* buffer, size_t offset) {
+        if (index >= kMaxBuffers) {
+            ofLogWarning("ofComputeShader") << "Buffer index " << index << " out of range";
+            return;
+        }
+        bindings.buffers[index] = buffer;
+        bindings.bufferOffsets[index] = static_cast<uint32_t>(offset);
+
+        // The constants follow the last bound buffer
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < kMaxBuffers; i++) {
+            if (bindings.buffers[i]) {
+                count = i + 1;
+            }
+        }
+        bindings.bufferCount = count;
+    }
+
+    void setTexture(uint32_t index, void* texture) {
+        if (index >= kMaxTextures) {
+            ofLogWarning("ofComputeShader") << "Texture index " << index << " out of range";
+            return;
+        }
+        bindings.textures[index] = texture;
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < kMaxTextures; i++) {
+            if (bindings.textures[i]) {
+                count = i + 1;
+            }
+        }
+        bindings.textureCount = count;
+    }
+};
+
+// ============================================================================
+// ofComputeShader
+// ============================================================================
+
+ofComputeShader::ofComputeShader() : impl_(std::make_unique<Impl>()) {}
+
+ofComputeShader::~ofComputeShader() = default;
+
+ofComputeShader::ofComputeShader(ofComputeShader&& other) noexcept = default;
+
+ofComputeShader& ofComputeShader::operator=(ofComputeShader&& other) noexcept = default;
+
+void ofComputeShader::ensureImpl() {
+    if (!impl_) {
+        impl_ = std::make_unique<Impl>();
+    }
+}
+
+// Loading
+bool ofComputeShader::load(const std::string& shaderName, const std::string& kernelName) {
+    ensureImpl();
+    @autoreleasepool {
+        id<MTLDevice> device = impl_->getDevice();
+        if (!device) {
+            ofLogError("ofComputeShader") << "No Metal device available";
+            return false;
+        }
+        id<MTLLibrary> library = Impl::findLibrary(device, shaderName,
+                                                   [NSString stringWithUTF8String:kernelName.c_str()]);
+        if (!library) {
+            ofLogError("ofComputeShader") << "Could not load shader from: " << shaderName;
+            return false;
+        }
+        return impl_->createPipeline(library, kernelName);
+    }
+}
+
+bool ofComputeShader::loadFromSource(const std::string& source, const std::string& kernelName) {
+    ensureImpl();
+    @autoreleasepool {
+        id<MTLDevice> device = impl_->getDevice();
+        if (!device) {
+            ofLogError("ofComputeShader") << "No Metal device available";
+            return false;
+        }
+        return impl_->createPipeline(Impl::compile(device, [NSString stringWithUTF8String:source.c_str()]),
+                                     kernelName);
+    }
+}
+
+void ofComputeShader::unload() {
+    if (impl_) {
+        impl_->unload();
+        clearBindings();
+    }
+}
+
+bool ofComputeShader::isLoaded() const {
+    return impl_ && impl_->pipeline != nil;
+}
+
+// Bindings
+void ofComputeShader::setBuffer(uint32_t index, const ofBufferObject& buffer, size_t offset) {
+    ensureImpl();
+    impl_->setBuffer(index, buffer.getNativeHandle(), offset);
+}
+
+void ofComputeShader::setBuffer(uint32_t index, const VboMesh& mesh) {
+    ensureImpl();
+    auto* renderer = Context::instance().renderer();
+    void* buffer = mesh.getVertexBuffer(renderer ? renderer->getCurrentFrameIndex() : 0);
+    if (!buffer) {
+        buffer = mesh.getVertexBuffer(0);    // Static meshes have a single buffer
+    }
+    impl_->setBuffer(index, buffer, mesh.getVertexBufferOffset());
+}
+
+void ofComputeShader::setBuffer(uint32_t index, void* buffer, size_t offset) {
+    ensureImpl();
+    impl_->setBuffer(index, buffer, offset);
+}
+
+void ofComputeShader::setTexture(uint32_t index, const ofTexture& texture) {
+    setTexture(index, texture.getNativeHandle());
+}
+
+void ofComputeShader::setTexture(uint32_t index, void* texture) {
+    ensureImpl();
+    impl_->setTexture(index, texture);
+}
+
+bool ofComputeShader::setConstants(const void* data, size_t size) {
+    ensureImpl();
+    if (size > kMaxConstantsSize) {
+        ofLogWarning("ofComputeShader") << "Constants of " << size << " bytes exceed " << kMaxConstantsSize;
+        return false;
+    }
+    impl_->bindings.constantsSize = data ? static_cast<uint32_t>(size) : 0;
+    if (data && size > 0) {
+        std::memcpy(impl_->bindings.constants, data, size);
+    }
+    return true;
+}
+
+void ofComputeShader::clearBindings() {
+    ensureImpl();
+    render::DispatchComputeCommand cleared;
+    std::copy(std::begin(impl_->bindings.threadgroupSize), std::end(impl_->bindings.threadgroupSize),
+              cleared.threadgroupSize);     // A setting, not a binding
+    impl_->bindings = cleared;
+}
+
+// Dispatch
+bool ofComputeShader::dispatch(uint32_t width, uint32_t height, uint32_t depth) {
+    auto& ctx = Context::instance();
+    if (!isLoaded() || !ctx.isInitialized()) {
+        return false;
+    }
+    if (width == 0 || height == 0 || depth == 0) {
+        return true;    // Empty grid
+    }
+
+    render::DispatchComputeCommand cmd = impl_->bindings;
+    cmd.pipelineState = (__bridge void*)impl_->pipeline;
+    cmd.threadCount = width;
+    cmd.gridHeight = height;
+    cmd.gridDepth = depth;
+    ctx.getDrawList().addCommand(cmd);
+    return true;
+}
+
+void ofComputeShader::setThreadgroupSize(uint32_t width, uint32_t height, uint32_t depth) {
+    ensureImpl();
+    impl_->bindings.threadgroupSize[0] = width;
+    impl_->bindings.threadgroupSize[1] = width > 0 ? height : 0;
+    impl_->bindings.threadgroupSize[2] = width > 0 ? depth : 0;
+}
+
+uint32_t ofComputeShader::getThreadExecutionWidth() const {
+    return isLoaded() ? static_cast<uint32_t>(impl_->pipeline.threadExecutionWidth) : 0;
+}
+
+uint32_t ofComputeShader::getMaxTotalThreadsPerThreadgroup() const {
+    return isLoaded() ? static_cast<uint32_t>(impl_->pipeline.maxTotalThreadsPerThreadgroup) : 0;
+}
+
+// Native access
+void* ofComputeShader::getNativePipelineState() const {
+    return isLoaded() ? (__bridge void*)impl_->pipeline : nullptr;
+}
+
+} // namespace oflike
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
 /// \brief Core Text based text rendering for Apple platforms
 /// \note Uses Core Text + Core Graphics for high-quality text rendering
 /// \note Renders directly to RGBA texture for Metal compatibility
+/// \note Rendered strings are packed into shared atlas pages, so consecutive
+/// draws batch; the least recently drawn page is emptied when they're full
 class ofCoreText {
 public:
     ofCoreText();
@@ -85,6 +88,30 @@ public:
     /// \brief Set line height multiplier
     void setLineHeight(float height);
 
+    // ---- Cache ----
+
+    /// \brief Set the texture memory for cached strings and glyphs
+    /// \details Bounds the atlas pages (1024x1024 RGBA, 4 MB each; at least
+    /// one) and the textures of strings larger than a page. Clears the cache.
+    /// \param bytes Budget in bytes (default: 16 MB)
+    void setCacheBudget(size_t bytes);
+
+    /// \brief Get the cache budget in bytes
+    size_t getCacheBudget() const;
+
+    /// \brief Get the texture memory used by cached strings and glyphs
+    size_t getCacheBytes() const;
+
+    /// \brief Draw glyph by glyph from a glyph atlas instead of whole strings
+    /// \details For rapidly changing text (counters, timecode, tickers): strings
+    /// are still shaped by Core Text on each draw, but only glyphs not seen
+    /// before are rasterized and nothing is cached per string.
+    /// \param enabled true for glyph runs (default: false)
+    void setGlyphRunMode(bool enabled);
+
+    /// \brief Check if glyph run mode is enabled
+    bool getGlyphRunMode() const;
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl_;
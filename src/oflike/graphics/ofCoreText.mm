@@ -1,16 +1,43 @@
 #include "ofCoreText.h"
 #include "ofGraphics.h"
+#include "ofGraphicsTransform.h"
 #include "../image/ofTexture.h"
+#include "../image/ofTextureAtlas.h"
+#include "../image/ofPixels.h"
+#include "../utils/ofUtils.h"
 #include "../../core/Context.h"
 #include "../../render/DrawList.h"
 #include "../../render/DrawCommand.h"
+#include "../../render/IRenderer.h"
 #include "../math/ofMatrix4x4.h"
 
 #import <Foundation/Foundation.h>
 #import <CoreText/CoreText.h>
 #import <CoreGraphics/CoreGraphics.h>
 
+#include <algorithm>
+#include <cmath>
 #include <unordered_map>
+#include <vector>
+
+namespace {
+    // Cached strings and glyphs are packed into pages of this size
+    constexpr int kAtlasPageSize = 1024;
+    constexpr size_t kAtlasPageBytes = size_t(kAtlasPageSize) * kAtlasPageSize * 4;
+
+    // Texture memory for cached strings (four pages)
+    constexpr size_t kDefaultCacheBudget = 4 * kAtlasPageBytes;
+
+    // Transparent border around rendered strings and glyphs
+    constexpr int kPadding = 2;
+
+    // A model matrix that only moves, rotates and scales in XY
+    bool isAffine2D(const simd_float4x4& m) {
+        return m.columns[0].z == 0.0f && m.columns[0].w == 0.0f &&
+               m.columns[1].z == 0.0f && m.columns[1].w == 0.0f &&
+               m.columns[3].z == 0.0f && m.columns[3].w == 1.0f;
+    }
+}
 
 // ============================================================
 // Implementation
@@ -23,18 +50,58 @@ struct ofCoreText::Impl {
     float lineHeightMultiplier = 1.0f;
     bool antialiased = true;
     bool loaded = false;
+    bool glyphRuns = false;
 
     // Cache for rendered strings
     struct CachedString {
-        std::unique_ptr<oflike::ofTexture> texture;
+        int page = -1;                                // Atlas page, -1 for a texture of its own
+        std::unique_ptr<oflike::ofTexture> texture;   // Strings larger than a page
+        float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
         float width;
         float height;
+        float baseline;                               // Baseline from the top, in pixels
+        unsigned long long lastUsed = 0;              // Frame last drawn in
     };
     mutable std::unordered_map<std::string, CachedString> stringCache;
-    mutable size_t cacheSize = 0;
-    static constexpr size_t maxCacheSize = 100;
+
+    // Glyphs for glyph run mode, keyed by run font index and glyph
+    struct CachedGlyph {
+        int page = -1;                                // Atlas page, -1 for empty glyphs
+        float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+        float left = 0.0f, bottom = 0.0f;             // Quad from the glyph origin, y up
+        float width = 0.0f, height = 0.0f;
+    };
+    mutable std::unordered_map<uint64_t, CachedGlyph> glyphCache;
+    mutable std::vector<CTFontRef> runFonts;          // Fonts of glyph runs, fallbacks included
+
+    // Strings and glyphs share the pages; new ones are uploaded once per
+    // drawString(), and the least recently drawn page is emptied when full
+    mutable oflike::ofTextureAtlas atlas;
+    mutable std::vector<unsigned long long> pageLastUsed;
+
+    // Texture memory for the pages and for strings with their own texture
+    size_t cacheBudget = kDefaultCacheBudget;
+    mutable size_t textureBytes = 0;
+
+    // Quad of a string or glyph for drawString(), y down from the origin
+    struct Quad {
+        simd_float2 min, max;
+        simd_float2 uv0, uv1;
+        int page;
+    };
+
+    // Scratch for drawString(), reused between calls
+    mutable std::vector<Quad> quads;
+    mutable std::vector<std::vector<render::Vertex2D>> pageVertices;
+    mutable std::vector<CGGlyph> runGlyphs;
+    mutable std::vector<CGPoint> runPositions;
+
+    Impl() {
+        setupAtlas();
+    }
 
     ~Impl() {
+        releaseRunFonts();
         if (ctFont) {
             CFRelease(ctFont);
             ctFont = nullptr;
@@ -51,16 +118,36 @@ struct ofCoreText::Impl {
         return true;
     }
 
+    void setupAtlas() {
+        // As many pages as the budget holds, at least one
+        const int maxPages = std::max(1, static_cast<int>(cacheBudget / kAtlasPageBytes));
+        atlas.setup(kAtlasPageSize, kAtlasPageSize, 1, maxPages);
+        atlas.setDeferredUploads(true);
+        pageLastUsed.clear();
+    }
+
+    void releaseRunFonts() const {
+        for (CTFontRef font : runFonts) {
+            CFRelease(font);
+        }
+        runFonts.clear();
+    }
+
     void clearCache() {
         stringCache.clear();
-        cacheSize = 0;
+        glyphCache.clear();
+        releaseRunFonts();
+        textureBytes = 0;
+        setupAtlas();
     }
 
-    // Render text to RGBA texture
-    oflike::ofTexture* renderStringToTexture(const std::string& text) const {
-        @autoreleasepool {
-            if (!ctFont || text.empty()) return nullptr;
+    size_t getCacheBytes() const {
+        return atlas.getNumPages() * kAtlasPageBytes + textureBytes;
+    }
 
+    // Line of text with the font and letter spacing
+    CTLineRef createLine(const std::string& text) const {
+        @autoreleasepool {
             NSString* nsText = [NSString stringWithUTF8String:text.c_str()];
             if (!nsText) return nullptr;
 
@@ -80,103 +167,288 @@ struct ofCoreText::Impl {
                 initWithString:nsText
                 attributes:attributes];
 
-            // Create line
-            CTLineRef line = CTLineCreateWithAttributedString((__bridge CFAttributedStringRef)attrString);
-            if (!line) return nullptr;
-
-            // Get bounds
-            CGFloat ascent, descent, leading;
-            double lineWidth = CTLineGetTypographicBounds(line, &ascent, &descent, &leading);
+            return CTLineCreateWithAttributedString((__bridge CFAttributedStringRef)attrString);
+        }
+    }
 
-            int width = (int)std::ceil(lineWidth) + 4;  // Add padding
-            int height = (int)std::ceil(ascent + descent) + 4;
+    // RGBA bitmap context over pixels, set up to draw white text
+    CGContextRef createContext(oflike::ofPixels& pixels, int width, int height) const {
+        pixels.allocate(width, height, 4);  // Zeroed: transparent
+
+        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+        CGContextRef context = CGBitmapContextCreate(
+            pixels.getData(),
+            width,
+            height,
+            8,  // bits per component
+            width * 4,
+            colorSpace,
+            kCGImageAlphaPremultipliedLast  // RGBA
+        );
+        CGColorSpaceRelease(colorSpace);
+
+        if (!context) {
+            return nullptr;
+        }
 
-            if (width <= 0 || height <= 0) {
-                CFRelease(line);
-                return nullptr;
-            }
+        // Set rendering quality
+        if (antialiased) {
+            CGContextSetShouldAntialias(context, true);
+            CGContextSetShouldSmoothFonts(context, true);
+            CGContextSetAllowsFontSmoothing(context, true);
+        } else {
+            CGContextSetShouldAntialias(context, false);
+        }
 
-            // Create RGBA bitmap context
-            size_t bytesPerRow = width * 4;
-            std::vector<uint8_t> bitmapData(bytesPerRow * height, 0);
-
-            CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
-            CGContextRef context = CGBitmapContextCreate(
-                bitmapData.data(),
-                width,
-                height,
-                8,  // bits per component
-                bytesPerRow,
-                colorSpace,
-                kCGImageAlphaPremultipliedLast  // RGBA
-            );
-            CGColorSpaceRelease(colorSpace);
-
-            if (!context) {
-                CFRelease(line);
-                return nullptr;
-            }
+        // Set text color to white (will be tinted by vertex color)
+        CGContextSetRGBFillColor(context, 1.0, 1.0, 1.0, 1.0);
+        return context;
+    }
 
-            // Set rendering quality
-            if (antialiased) {
-                CGContextSetShouldAntialias(context, true);
-                CGContextSetShouldSmoothFonts(context, true);
-                CGContextSetAllowsFontSmoothing(context, true);
-            } else {
-                CGContextSetShouldAntialias(context, false);
-            }
+    // Render text to RGBA pixels, rows top-down
+    bool renderString(const std::string& text, oflike::ofPixels& pixels, float& baseline) const {
+        if (!ctFont || text.empty()) return false;
 
-            // Clear background (transparent)
-            CGContextClearRect(context, CGRectMake(0, 0, width, height));
+        // Create line
+        CTLineRef line = createLine(text);
+        if (!line) return false;
 
-            // Set text color to white (will be tinted by vertex color)
-            CGContextSetRGBFillColor(context, 1.0, 1.0, 1.0, 1.0);
+        // Get bounds
+        CGFloat ascent, descent, leading;
+        double lineWidth = CTLineGetTypographicBounds(line, &ascent, &descent, &leading);
 
-            // Draw text
-            // Core Graphics has origin at bottom-left, so we flip
-            CGContextTranslateCTM(context, 0, height);
-            CGContextScaleCTM(context, 1.0, -1.0);
+        int width = (int)std::ceil(lineWidth) + kPadding * 2;
+        int height = (int)std::ceil(ascent + descent) + kPadding * 2;
 
-            CGContextSetTextPosition(context, 2, descent + 2);
-            CTLineDraw(line, context);
+        if (width <= 0 || height <= 0) {
+            CFRelease(line);
+            return false;
+        }
 
-            CGContextRelease(context);
+        CGContextRef context = createContext(pixels, width, height);
+        if (!context) {
             CFRelease(line);
+            return false;
+        }
+
+        // Core Graphics has origin at bottom-left; its first row in memory
+        // is the top one, as texture rows
+        CGContextSetTextPosition(context, kPadding, descent + kPadding);
+        CTLineDraw(line, context);
+        baseline = (float)(height - (descent + kPadding));
+
+        CGContextRelease(context);
+        CFRelease(line);
+        return true;
+    }
+
+    // Record that a page is drawn this frame
+    void touchPage(int page) const {
+        if (page < 0) return;
+        if (page >= static_cast<int>(pageLastUsed.size())) {
+            pageLastUsed.resize(page + 1, 0);
+        }
+        pageLastUsed[page] = ofGetFrameNum();
+    }
+
+    // Empty the least recently drawn page and forget what was on it; false
+    // if every page was drawn in a frame that may still be in flight
+    bool evictPage() const {
+        const unsigned long long frame = ofGetFrameNum();
+        int oldest = -1;
+        for (int page = 0; page < static_cast<int>(pageLastUsed.size()); ++page) {
+            if (frame - pageLastUsed[page] > render::kRetireFrames &&
+                (oldest < 0 || pageLastUsed[page] < pageLastUsed[oldest])) {
+                oldest = page;
+            }
+        }
+        if (oldest < 0) return false;
+
+        for (auto it = stringCache.begin(); it != stringCache.end();) {
+            it = it->second.page == oldest ? stringCache.erase(it) : std::next(it);
+        }
+        for (auto it = glyphCache.begin(); it != glyphCache.end();) {
+            it = it->second.page == oldest ? glyphCache.erase(it) : std::next(it);
+        }
+        atlas.clearPage(oldest);
+        return true;
+    }
+
+    // Pack pixels, emptying a page if the atlas is full
+    bool insertPixels(const oflike::ofPixels& pixels, oflike::ofTextureAtlasRegion& region) const {
+        if (!atlas.insert(pixels, region)) {
+            const bool fitsPage = (int)pixels.getWidth() <= kAtlasPageSize &&
+                                  (int)pixels.getHeight() <= kAtlasPageSize;
+            if (!fitsPage || !evictPage() || !atlas.insert(pixels, region)) {
+                return false;
+            }
+        }
+        touchPage(region.page);
+        return true;
+    }
 
-            // Create texture from bitmap
-            auto texture = new oflike::ofTexture();
-            texture->loadData(bitmapData.data(), width, height, 4);
+    // Drop least recently drawn strings with their own texture until bytes
+    // more fit in what the pages leave of the budget
+    void evictTextures(size_t bytes) const {
+        const unsigned long long frame = ofGetFrameNum();
+        const size_t pageBytes = atlas.getNumPages() * kAtlasPageBytes;
+        while (pageBytes + textureBytes + bytes > cacheBudget) {
+            auto oldest = stringCache.end();
+            for (auto it = stringCache.begin(); it != stringCache.end(); ++it) {
+                if (it->second.texture && frame - it->second.lastUsed > render::kRetireFrames &&
+                    (oldest == stringCache.end() || it->second.lastUsed < oldest->second.lastUsed)) {
+                    oldest = it;
+                }
+            }
+            if (oldest == stringCache.end()) return;
 
-            return texture;
+            textureBytes -= (size_t)oldest->second.width * (size_t)oldest->second.height * 4;
+            stringCache.erase(oldest);
         }
     }
 
     const CachedString* getCachedString(const std::string& text) const {
         auto it = stringCache.find(text);
         if (it != stringCache.end()) {
+            it->second.lastUsed = ofGetFrameNum();
+            touchPage(it->second.page);
             return &it->second;
         }
 
         // Render and cache
-        oflike::ofTexture* tex = renderStringToTexture(text);
-        if (!tex) return nullptr;
+        oflike::ofPixels pixels;
+        CachedString cached;
+        if (!renderString(text, pixels, cached.baseline)) return nullptr;
+        cached.width = pixels.getWidth();
+        cached.height = pixels.getHeight();
+        cached.lastUsed = ofGetFrameNum();
+
+        oflike::ofTextureAtlasRegion region;
+        if (insertPixels(pixels, region)) {
+            cached.page = region.page;
+            cached.u0 = region.u0;
+            cached.v0 = region.v0;
+            cached.u1 = region.u1;
+            cached.v1 = region.v1;
+        } else {
+            // Larger than a page, or every page is still in flight
+            const size_t bytes = pixels.getTotalBytes();
+            evictTextures(bytes);
+            cached.texture = std::make_unique<oflike::ofTexture>();
+            cached.texture->loadData(pixels);
+            textureBytes += bytes;
+        }
 
-        // Evict old entries if cache is full
-        if (cacheSize >= maxCacheSize) {
-            stringCache.clear();
-            cacheSize = 0;
+        auto result = stringCache.emplace(text, std::move(cached));
+        return &result.first->second;
+    }
+
+    // Get or render a glyph of a run's font
+    const CachedGlyph* getGlyph(CTFontRef font, CGGlyph glyph) const {
+        // Runs of fallback fonts are new font objects: compare by value
+        size_t fontIndex = 0;
+        while (fontIndex < runFonts.size() && !CFEqual(runFonts[fontIndex], font)) {
+            fontIndex++;
+        }
+        if (fontIndex == runFonts.size()) {
+            runFonts.push_back((CTFontRef)CFRetain(font));
         }
 
-        CachedString cached;
-        cached.texture.reset(tex);
-        cached.width = tex->getWidth();
-        cached.height = tex->getHeight();
+        const uint64_t key = (uint64_t(fontIndex) << 32) | glyph;
+        auto it = glyphCache.find(key);
+        if (it != glyphCache.end()) {
+            touchPage(it->second.page);
+            return &it->second;
+        }
 
-        auto result = stringCache.emplace(text, std::move(cached));
-        cacheSize++;
+        CachedGlyph cached;
+        CGRect bounds;
+        CTFontGetBoundingRectsForGlyphs(font, kCTFontOrientationHorizontal, &glyph, &bounds, 1);
+        if (bounds.size.width > 0 && bounds.size.height > 0) {
+            const int left = (int)std::floor(CGRectGetMinX(bounds)) - kPadding;
+            const int bottom = (int)std::floor(CGRectGetMinY(bounds)) - kPadding;
+            const int width = (int)std::ceil(CGRectGetMaxX(bounds)) + kPadding - left;
+            const int height = (int)std::ceil(CGRectGetMaxY(bounds)) + kPadding - bottom;
+
+            oflike::ofPixels pixels;
+            CGContextRef context = createContext(pixels, width, height);
+            if (!context) return nullptr;
+            const CGPoint position = CGPointMake(-left, -bottom);
+            CTFontDrawGlyphs(font, &glyph, &position, 1, context);
+            CGContextRelease(context);
 
+            oflike::ofTextureAtlasRegion region;
+            if (!insertPixels(pixels, region)) return nullptr;
+            cached.page = region.page;
+            cached.u0 = region.u0;
+            cached.v0 = region.v0;
+            cached.u1 = region.u1;
+            cached.v1 = region.v1;
+            cached.left = (float)left;
+            cached.bottom = (float)bottom;
+            cached.width = (float)width;
+            cached.height = (float)height;
+        }
+
+        auto result = glyphCache.emplace(key, cached);
         return &result.first->second;
     }
+
+    // Glyph quads of a string shaped by Core Text
+    void layoutGlyphRuns(const std::string& text, std::vector<Quad>& quads) const {
+        CTLineRef line = createLine(text);
+        if (!line) return;
+
+        CFArrayRef runs = CTLineGetGlyphRuns(line);
+        for (CFIndex r = 0; r < CFArrayGetCount(runs); ++r) {
+            CTRunRef run = (CTRunRef)CFArrayGetValueAtIndex(runs, r);
+            CTFontRef runFont = (CTFontRef)CFDictionaryGetValue(CTRunGetAttributes(run), kCTFontAttributeName);
+            if (!runFont) runFont = ctFont;
+
+            const CFIndex count = CTRunGetGlyphCount(run);
+            runGlyphs.resize(count);
+            runPositions.resize(count);
+            CTRunGetGlyphs(run, CFRangeMake(0, 0), runGlyphs.data());
+            CTRunGetPositions(run, CFRangeMake(0, 0), runPositions.data());
+
+            for (CFIndex i = 0; i < count; ++i) {
+                const CachedGlyph* glyph = getGlyph(runFont, runGlyphs[i]);
+                if (!glyph || glyph->page < 0) continue;
+
+                // Glyph space is y up from the baseline, the screen y down
+                Quad quad;
+                quad.min = simd_make_float2(runPositions[i].x + glyph->left,
+                                            -(runPositions[i].y + glyph->bottom + glyph->height));
+                quad.max = quad.min + simd_make_float2(glyph->width, glyph->height);
+                quad.uv0 = simd_make_float2(glyph->u0, glyph->v0);
+                quad.uv1 = simd_make_float2(glyph->u1, glyph->v1);
+                quad.page = glyph->page;
+                quads.push_back(quad);
+            }
+        }
+
+        CFRelease(line);
+    }
+
+    // Width and height of a string as rendered, without rendering it
+    bool measureString(const std::string& text, float& width, float& height) const {
+        auto it = stringCache.find(text);
+        if (it != stringCache.end()) {
+            width = it->second.width;
+            height = it->second.height;
+            return true;
+        }
+
+        CTLineRef line = createLine(text);
+        if (!line) return false;
+        CGFloat ascent, descent, leading;
+        double lineWidth = CTLineGetTypographicBounds(line, &ascent, &descent, &leading);
+        CFRelease(line);
+
+        width = (float)((int)std::ceil(lineWidth) + kPadding * 2);
+        height = (float)((int)std::ceil(ascent + descent) + kPadding * 2);
+        return true;
+    }
 };
 
 // ============================================================
@@ -242,66 +514,117 @@ void ofCoreText::unload() {
 void ofCoreText::drawString(const std::string& text, float x, float y) const {
     if (!impl_->loaded || text.empty()) return;
 
-    const auto* cached = impl_->getCachedString(text);
-    if (!cached || !cached->texture) return;
+    // Quads of the whole string, or of its glyphs in glyph run mode
+    auto& quads = impl_->quads;
+    quads.clear();
+    const oflike::ofTexture* ownTexture = nullptr;
+    if (impl_->glyphRuns) {
+        impl_->layoutGlyphRuns(text, quads);
+    } else {
+        const auto* cached = impl_->getCachedString(text);
+        if (!cached) return;
+
+        // Position (y is baseline, texture origin is top-left)
+        Impl::Quad quad;
+        quad.min = simd_make_float2(-(float)kPadding, -cached->baseline);
+        quad.max = quad.min + simd_make_float2(cached->width, cached->height);
+        quad.uv0 = simd_make_float2(cached->u0, cached->v0);
+        quad.uv1 = simd_make_float2(cached->u1, cached->v1);
+        quad.page = cached->page;
+        quads.push_back(quad);
+        ownTexture = cached->texture.get();
+    }
+    if (quads.empty()) return;
+
+    // Upload what this string added, one region per page
+    impl_->atlas.flush();
 
     // Get current color
     uint8_t r, g, b, a;
     ofGetColor(r, g, b, a);
     simd_float4 color = simd_make_float4(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f);
 
-    // Calculate position (y is baseline, texture origin is top-left)
-    float drawX = x;
-    float drawY = y - getAscenderHeight();
-    float w = cached->width;
-    float h = cached->height;
-
-    // Create quad vertices
-    // Note: UV coordinates are flipped vertically (V: 1->0) because Core Graphics
-    // renders with Y-up and we flip to match oF's Y-down coordinate system
-    render::Vertex2D vertices[6];
+    // Under a 2D transform the vertices are written in world space, so
+    // strings drawn under different transforms still batch into one draw
+    const simd_float4x4& matrix = ofGetCurrentModelMatrix();
+    const bool affine2D = isAffine2D(matrix);
+    simd_float2 axisX = simd_make_float2(1.0f, 0.0f);
+    simd_float2 axisY = simd_make_float2(0.0f, 1.0f);
+    simd_float2 origin = simd_make_float2(x, y);
+    if (affine2D) {
+        axisX = simd_make_float2(matrix.columns[0].x, matrix.columns[0].y);
+        axisY = simd_make_float2(matrix.columns[1].x, matrix.columns[1].y);
+        origin = axisX * x + axisY * y + simd_make_float2(matrix.columns[3].x, matrix.columns[3].y);
+    }
 
-    // Triangle 1
-    vertices[0] = render::Vertex2D(drawX, drawY, 0, 1, color.x, color.y, color.z, color.w);
-    vertices[1] = render::Vertex2D(drawX + w, drawY, 1, 1, color.x, color.y, color.z, color.w);
-    vertices[2] = render::Vertex2D(drawX + w, drawY + h, 1, 0, color.x, color.y, color.z, color.w);
+    // Collect vertices by page; a string with its own texture uses slot 0
+    auto& pageVertices = impl_->pageVertices;
+    const size_t numPages = std::max<size_t>(impl_->atlas.getNumPages(), 1);
+    if (pageVertices.size() < numPages) {
+        pageVertices.resize(numPages);
+    }
+    for (auto& vertices : pageVertices) {
+        vertices.clear();
+    }
 
-    // Triangle 2
-    vertices[3] = render::Vertex2D(drawX, drawY, 0, 1, color.x, color.y, color.z, color.w);
-    vertices[4] = render::Vertex2D(drawX + w, drawY + h, 1, 0, color.x, color.y, color.z, color.w);
-    vertices[5] = render::Vertex2D(drawX, drawY + h, 0, 0, color.x, color.y, color.z, color.w);
+    for (const Impl::Quad& quad : quads) {
+        auto& vertices = pageVertices[std::max(quad.page, 0)];
 
-    // Add to draw list
-    auto& drawList = Context::instance().getDrawList();
-    uint32_t vtxOffset = drawList.addVertices2D(vertices, 6);
+        const simd_float2 topLeft = origin + axisX * quad.min.x + axisY * quad.min.y;
+        const simd_float2 topRight = origin + axisX * quad.max.x + axisY * quad.min.y;
+        const simd_float2 bottomRight = origin + axisX * quad.max.x + axisY * quad.max.y;
+        const simd_float2 bottomLeft = origin + axisX * quad.min.x + axisY * quad.max.y;
 
-    // Create draw command
-    render::DrawCommand2D cmd;
-    cmd.vertexOffset = vtxOffset;
-    cmd.vertexCount = 6;
-    cmd.primitiveType = render::PrimitiveType::Triangle;
-    cmd.blendMode = render::BlendMode::Alpha;
-    cmd.texture = cached->texture->getNativeHandle();
+        // Triangle 1
+        vertices.push_back(render::Vertex2D(topLeft, quad.uv0, color));
+        vertices.push_back(render::Vertex2D(topRight, simd_make_float2(quad.uv1.x, quad.uv0.y), color));
+        vertices.push_back(render::Vertex2D(bottomRight, quad.uv1, color));
 
-    // Get current transform
-    oflike::ofMatrix4x4 mat = ofGetCurrentMatrix();
-    cmd.transform = mat.toSimd();
+        // Triangle 2
+        vertices.push_back(render::Vertex2D(topLeft, quad.uv0, color));
+        vertices.push_back(render::Vertex2D(bottomRight, quad.uv1, color));
+        vertices.push_back(render::Vertex2D(bottomLeft, simd_make_float2(quad.uv0.x, quad.uv1.y), color));
+    }
 
-    drawList.addCommand(cmd);
+    // Add to draw list, a command per page; consecutive strings on the same
+    // page merge into one draw in DrawList::optimize()
+    auto& drawList = Context::instance().getDrawList();
+    for (size_t page = 0; page < pageVertices.size(); ++page) {
+        const auto& vertices = pageVertices[page];
+        if (vertices.empty()) continue;
+
+        const oflike::ofTexture& texture = ownTexture ? *ownTexture
+                                                      : impl_->atlas.getPageTexture(static_cast<int>(page));
+        uint32_t vtxOffset = drawList.addVertices2D(vertices);
+
+        // Create draw command
+        render::DrawCommand2D cmd;
+        cmd.vertexOffset = vtxOffset;
+        cmd.vertexCount = static_cast<uint32_t>(vertices.size());
+        cmd.primitiveType = render::PrimitiveType::Triangle;
+        cmd.blendMode = render::BlendMode::Alpha;
+        cmd.texture = texture.getNativeHandle();
+        cmd.samplerKey = texture.getSamplerKey();
+
+        // Already applied to the vertices unless it isn't a 2D transform
+        cmd.transform = affine2D ? matrix_identity_float4x4 : matrix;
+
+        drawList.addCommand(cmd);
+    }
 }
 
 float ofCoreText::stringWidth(const std::string& text) const {
     if (!impl_->loaded || text.empty()) return 0;
 
-    const auto* cached = impl_->getCachedString(text);
-    return cached ? cached->width : 0;
+    float width, height;
+    return impl_->measureString(text, width, height) ? width : 0;
 }
 
 float ofCoreText::stringHeight(const std::string& text) const {
     if (!impl_->loaded || text.empty()) return 0;
 
-    const auto* cached = impl_->getCachedString(text);
-    return cached ? cached->height : 0;
+    float width, height;
+    return impl_->measureString(text, width, height) ? height : 0;
 }
 
 ofCoreText::Rectangle ofCoreText::getStringBoundingBox(const std::string& text, float x, float y) const {
@@ -309,10 +632,10 @@ ofCoreText::Rectangle ofCoreText::getStringBoundingBox(const std::string& text,
 
     if (!impl_->loaded || text.empty()) return rect;
 
-    const auto* cached = impl_->getCachedString(text);
-    if (cached) {
-        rect.width = cached->width;
-        rect.height = cached->height;
+    float width, height;
+    if (impl_->measureString(text, width, height)) {
+        rect.width = width;
+        rect.height = height;
     }
 
     return rect;
@@ -349,3 +672,24 @@ float ofCoreText::getLetterSpacing() const {
 void ofCoreText::setLineHeight(float height) {
     impl_->lineHeightMultiplier = height;
 }
+
+void ofCoreText::setCacheBudget(size_t bytes) {
+    impl_->cacheBudget = bytes;
+    impl_->clearCache();  // Page count follows the budget
+}
+
+size_t ofCoreText::getCacheBudget() const {
+    return impl_->cacheBudget;
+}
+
+size_t ofCoreText::getCacheBytes() const {
+    return impl_->getCacheBytes();
+}
+
+void ofCoreText::setGlyphRunMode(bool enabled) {
+    impl_->glyphRuns = enabled;
+}
+
+bool ofCoreText::getGlyphRunMode() const {
+    return impl_->glyphRuns;
+}
@@ -0,0 +1,175 @@
+#include "ofDisplayList.h"
+#include "ofGraphics.h"
+#include "ofGraphicsTransform.h"
+#include "../utils/ofLog.h"
+#include "../../core/Context.h"
+#include "../../render/DrawList.h"
+#include "../../render/DrawCommand.h"
+#include <atomic>
+#include <simd/simd.h>
+
+namespace oflike {
+
+namespace {
+    // Display list recording on this thread (ofEndDisplayList() target)
+    thread_local ofDisplayList* recordingList = nullptr;
+
+    // Recording ids key the renderer's resident copies; never reused
+    std::atomic<uint64_t> nextListId{1};
+}
+
+uint64_t allocateDisplayListId() {
+    return nextListId.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// ofDisplayList::Impl
+// ============================================================================
+
+struct ofDisplayList::Impl {
+    render::DrawList drawList;
+    render::DrawList* previousList = nullptr;       // Thread list bound before begin()
+    ofDisplayList* outerRecording = nullptr;         // List recording before begin()
+    simd_float4x4 viewMatrix = matrix_identity_float4x4;  // View the 3D draws were recorded under
+    uint64_t listId = 0;                             // 0 until end()
+    bool recording = false;
+};
+
+// ============================================================================
+// ofDisplayList Implementation
+// ============================================================================
+
+ofDisplayList::ofDisplayList()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ofDisplayList::~ofDisplayList() {
+    if (impl_ && impl_->recording) {
+        end();
+    }
+}
+
+ofDisplayList::ofDisplayList(ofDisplayList&& other) noexcept = default;
+
+ofDisplayList& ofDisplayList::operator=(ofDisplayList&& other) noexcept = default;
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+void ofDisplayList::begin() {
+    if (impl_->recording) {
+        ofLogWarning("ofDisplayList") << "begin() while already recording";
+        return;
+    }
+
+    auto& ctx = Context::instance();
+    impl_->drawList.reset();
+    impl_->drawList.setVertexCompression(ctx.getDrawList().isVertexCompressionEnabled());
+    impl_->drawList.setMeshPrimitives(false);   // Replays take only vertex draws
+    impl_->listId = 0;
+    impl_->viewMatrix = ctx.getViewMatrix();
+    impl_->previousList = ctx.getThreadDrawList();
+    ctx.bindThreadDrawList(&impl_->drawList);
+    impl_->recording = true;
+    impl_->outerRecording = recordingList;
+    recordingList = this;
+
+    // Recorded transforms are relative to wherever the list is drawn
+    ofPushMatrix();
+    ofLoadIdentityMatrix();
+}
+
+void ofDisplayList::end() {
+    if (!impl_->recording) {
+        return;
+    }
+
+    ofPopMatrix();
+    Context::instance().bindThreadDrawList(impl_->previousList);
+    impl_->previousList = nullptr;
+    impl_->recording = false;
+    if (recordingList == this) {
+        recordingList = impl_->outerRecording;
+    }
+    impl_->outerRecording = nullptr;
+
+    // Batching happens once here instead of every frame
+    impl_->drawList.optimize();
+    impl_->listId = allocateDisplayListId();
+}
+
+bool ofDisplayList::isRecording() const {
+    return impl_->recording;
+}
+
+bool ofDisplayList::isRecorded() const {
+    return impl_->listId != 0 && impl_->drawList.getCommandCount() > 0;
+}
+
+void ofDisplayList::clear() {
+    if (impl_->recording) {
+        end();
+    }
+    impl_->drawList.reset();
+    impl_->listId = 0;
+}
+
+size_t ofDisplayList::getNumCommands() const {
+    return impl_->drawList.getCommandCount();
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+void ofDisplayList::draw() const {
+    if (!isRecorded()) {
+        return;
+    }
+
+    auto& ctx = Context::instance();
+    render::DrawDisplayListCommand cmd;
+    cmd.displayList = &impl_->drawList;
+    cmd.listId = impl_->listId;
+    cmd.transform2D = ofGetCurrentModelMatrix();
+
+    // Recorded model-view = recordView * local; replay as view * model * local
+    cmd.transform3D = simd_mul(ofGetCurrentModelViewMatrix(), simd_inverse(impl_->viewMatrix));
+    cmd.projectionMatrix = ctx.getProjectionMatrix();
+
+    ctx.getDrawList().addCommand(cmd);
+}
+
+void ofDisplayList::draw(float x, float y, float z) const {
+    ofPushMatrix();
+    ofTranslate(x, y, z);
+    draw();
+    ofPopMatrix();
+}
+
+} // namespace oflike
+
+// ============================================================================
+// Display List Functions
+// ============================================================================
+
+void ofBeginDisplayList(oflike::ofDisplayList& list) {
+    list.begin();
+}
+
+void ofEndDisplayList() {
+    if (!oflike::recordingList) {
+        oflike::ofLogWarning("ofDisplayList") << "ofEndDisplayList() without ofBeginDisplayList()";
+        return;
+    }
+    oflike::recordingList->end();
+}
+
+bool ofIsRecordingDisplayList() {
+    return oflike::recordingList != nullptr;
+}
+
+void ofDrawDisplayList(const oflike::ofDisplayList& list) {
+    list.draw();
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+// oflike-metal ofDisplayList - retained drawing recorded once, replayed per frame
+// Static content drawn through many ofGraphics calls is captured into its own
+// DrawList and replayed as a single command
+
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace oflike {
+
+/// \brief Recorded sequence of drawing calls
+/// \details Everything drawn between ofBeginDisplayList() and
+/// ofEndDisplayList() is recorded into the display list instead of the
+/// frame: commands, vertices, indices, shapes and strokes, already
+/// tessellated and optimized. draw() appends one replay command to the
+/// frame; the renderer uploads the recorded geometry into a resident buffer
+/// on the first replay and reuses it afterwards, so a replay costs neither
+/// tessellation nor upload.
+///
+/// Features:
+/// - Replays under the current matrix stack (ofTranslate/ofRotate/... apply
+///   to the whole list) and the current camera
+/// - Any ofGraphics, ofMesh, ofPath, ofTexture or font drawing can be recorded
+/// - Display lists can be drawn into other display lists
+///
+/// Implementation:
+/// - Recording starts from an identity matrix; color, fill, blend mode and
+///   other style state are captured as they were while recording
+/// - Lights and materials are captured as well; re-record to pick up changes
+/// - Recorded while ofEnableVertexCompression() is on, eligible draws are
+///   stored in the packed vertex formats
+/// - Static scenes of 16 or more unlit, untextured 3D draws (one depth test
+///   and culling setting, no programmable blend modes) are encoded once into
+///   indirect command buffers: a replay writes only its transform and
+///   projection and runs every draw with one GPU call. Drawing such a list
+///   a second time in the same frame replays it draw by draw.
+/// - Textures drawn while recording must outlive the display list
+/// - Thread-safety: record and draw on one thread at a time; don't re-record
+///   or destroy a list while a frame that draws it is still being rendered
+///
+/// Example:
+/// \code
+///     ofDisplayList background;
+///
+///     void setup() {
+///         ofBeginDisplayList(background);
+///         for (int i = 0; i < 500; i++) {
+///             ofDrawCircle(ofRandomWidth(), ofRandomHeight(), 4);
+///         }
+///         ofEndDisplayList();
+///     }
+///
+///     void draw() {
+///         background.draw();           // One command, no re-upload
+///         background.draw(100, 0);     // Again, shifted
+///     }
+/// \endcode
+class ofDisplayList {
+public:
+    // ========================================================================
+    // Constructors & Destructor
+    // ========================================================================
+
+    /// \brief Default constructor (empty list)
+    ofDisplayList();
+
+    /// \brief Destructor
+    ~ofDisplayList();
+
+    /// \brief Move constructor
+    ofDisplayList(ofDisplayList&& other) noexcept;
+
+    /// \brief Move assignment
+    ofDisplayList& operator=(ofDisplayList&& other) noexcept;
+
+    ofDisplayList(const ofDisplayList&) = delete;
+    ofDisplayList& operator=(const ofDisplayList&) = delete;
+
+    // ========================================================================
+    // Recording
+    // ========================================================================
+
+    /// \brief Start recording, replacing any previous contents
+    /// \details Drawing calls on this thread record into the list until end().
+    /// Recordings nest: a list recorded while another one records is its own
+    /// list, and drawing it records one replay into the outer list.
+    void begin();
+
+    /// \brief Stop recording and optimize the recorded commands
+    void end();
+
+    /// \brief Check if the list is recording
+    bool isRecording() const;
+
+    /// \brief Check if the list holds a finished recording
+    bool isRecorded() const;
+
+    /// \brief Discard the recording
+    void clear();
+
+    /// \brief Get the number of recorded commands (after optimization)
+    size_t getNumCommands() const;
+
+    // ========================================================================
+    // Drawing
+    // ========================================================================
+
+    /// \brief Replay the recording under the current transform
+    void draw() const;
+
+    /// \brief Replay the recording translated by (x, y, z)
+    void draw(float x, float y, float z = 0.0f) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/// \brief Allocate an id for a recorded DrawList replayed by the renderer
+/// \details The renderer keeps resident copies of recordings keyed by these
+/// ids (display lists, shadow casters). Ids are never reused.
+uint64_t allocateDisplayListId();
+
+} // namespace oflike
+
+// ============================================================================
+// Display List Functions
+// ============================================================================
+
+/**
+ * Start recording drawing calls into a display list.
+ * Same as list.begin(); the recording ends with ofEndDisplayList().
+ * @param list Display list to record into (previous contents are replaced)
+ */
+void ofBeginDisplayList(oflike::ofDisplayList& list);
+
+/**
+ * Stop recording the display list started by ofBeginDisplayList().
+ */
+void ofEndDisplayList();
+
+/**
+ * Check if a display list is recording on this thread.
+ * @return true between ofBeginDisplayList() and ofEndDisplayList()
+ */
+bool ofIsRecordingDisplayList();
+
+/**
+ * Replay a display list under the current transform.
+ * Same as list.draw().
+ * @param list Recorded display list
+ */
+void ofDrawDisplayList(const oflike::ofDisplayList& list);
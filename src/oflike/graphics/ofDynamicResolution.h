@@ -0,0 +1,142 @@
+#pragma once
+
+// oflike-metal ofDynamicResolution - GPU-bound scenes rendered at an adaptive scale
+// The scene is drawn into part of an offscreen target sized to keep the GPU
+// within its frame budget, then upscaled to native resolution
+
+#include <memory>
+#include "ofFbo.h"
+
+namespace oflike {
+
+/// \brief How the rendered region is scaled to native resolution
+enum ofUpscaler {
+    OF_UPSCALER_METALFX,    ///< MetalFX spatial upscaling (bilinear where unsupported)
+    OF_UPSCALER_BILINEAR,   ///< One bilinear tap per pixel
+};
+
+/// \brief Offscreen scene target whose resolution follows the GPU time
+/// \details begin() picks the render scale from the GPU time of recent
+/// frames (IRenderer::getLastGPUTime()) and restricts drawing to that
+/// fraction of the target; end() upscales the region to the native size.
+/// Draw heavy content (splats, expensive shaders) between begin() and end(),
+/// then draw() the result and the 2D interface on top at native resolution.
+///
+/// Features:
+/// - Scale range (default 0.5 - 1.0) and GPU budget (default 90% of the
+///   ofSetFrameRate() period) are configurable; setAdaptive(false) holds
+///   a fixed scale
+/// - Cost scales with pixel count: the scale drops by the square root of the
+///   overrun and recovers in small steps while the GPU has headroom
+/// - MetalFX spatial upscaling, or a bilinear copy
+///
+/// Implementation:
+/// - The target keeps its native size; the render region is a viewport at
+///   its top-left, so changing the scale never reallocates
+/// - 3D cameras keep their aspect ratio and fill the region as they would
+///   the screen; 2D drawing inside begin()/end() is in region pixels
+///   (getRenderWidth() x getRenderHeight()), e.g. after ofScale(getScale())
+/// - Thread-safety: Main thread only
+///
+/// Example:
+/// \code
+///     ofDynamicResolution scene;
+///
+///     void setup() {
+///         scene.allocate(ofGetWidth(), ofGetHeight());
+///     }
+///
+///     void draw() {
+///         scene.begin();
+///         ofClear(0);
+///         camera.begin();
+///         splats.draw();
+///         camera.end();
+///         scene.end();
+///
+///         scene.draw(0, 0);
+///         gui.draw();                  // Native resolution
+///     }
+/// \endcode
+class ofDynamicResolution {
+public:
+    ofDynamicResolution();
+    ~ofDynamicResolution();
+
+    ofDynamicResolution(const ofDynamicResolution&) = delete;
+    ofDynamicResolution& operator=(const ofDynamicResolution&) = delete;
+
+    // ========================================================================
+    // Allocation
+    // ========================================================================
+
+    /// \brief Allocate the target and the upscaled output at native size
+    /// \param width Native width in pixels
+    /// \param height Native height in pixels
+    /// \param useDepth Give the target a depth buffer (3D scenes)
+    /// \param numSamples MSAA samples of the target (0 = off)
+    /// \return false if the textures couldn't be created
+    bool allocate(int width, int height, bool useDepth = true, int numSamples = 0);
+
+    /// \brief Check if allocated
+    bool isAllocated() const;
+
+    // ========================================================================
+    // Scale Control
+    // ========================================================================
+
+    /// \brief Set the scales the controller may pick from
+    /// \param minScale Lowest fraction of the native size per axis (> 0)
+    /// \param maxScale Highest fraction (<= 1)
+    void setScaleRange(float minScale, float maxScale);
+
+    /// \brief Set the GPU time to stay within
+    /// \param milliseconds Budget per frame; 0 uses 90% of the target frame period
+    void setGpuBudget(float milliseconds);
+
+    /// \brief Adapt the scale to the GPU time (default) or hold it
+    void setAdaptive(bool adaptive);
+
+    /// \brief Set the scale directly (clamped to the range)
+    /// \details The controller continues from it while adaptive.
+    void setScale(float scale);
+
+    /// \brief Set how the region is upscaled (default: OF_UPSCALER_METALFX)
+    void setUpscaler(ofUpscaler upscaler);
+
+    /// \brief Get the scale of the current (or last) frame
+    float getScale() const;
+
+    /// \brief Get the size of the region drawn this frame
+    int getRenderWidth() const;
+    int getRenderHeight() const;
+
+    /// \brief Get the native size
+    int getWidth() const;
+    int getHeight() const;
+
+    // ========================================================================
+    // Rendering
+    // ========================================================================
+
+    /// \brief Update the scale and begin drawing into the render region
+    void begin();
+
+    /// \brief End drawing and upscale the region into the output
+    void end();
+
+    /// \brief Draw the upscaled output at native size
+    void draw(float x, float y) const;
+
+    /// \brief Draw the upscaled output with the specified dimensions
+    void draw(float x, float y, float width, float height) const;
+
+    /// \brief Get the upscaled output
+    const ofTexture& getTexture() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
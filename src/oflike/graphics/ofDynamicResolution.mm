@@ -0,0 +1,254 @@
+#import "ofDynamicResolution.h"
+#import "../../core/Context.h"
+#import "../../render/DrawList.h"
+#import "../../render/DrawCommand.h"
+#import "../../render/IRenderer.h"
+#import "../../render/metal/MetalAllocations.h"
+#import "../utils/ofLog.h"
+#import <Metal/Metal.h>
+#include <algorithm>
+#include <cmath>
+
+namespace oflike {
+
+namespace {
+
+// Frames the GPU time needs to reflect a new scale (frames in flight plus smoothing)
+constexpr int kSettleFrames = 6;
+
+// Scale regained per step while the GPU has headroom
+constexpr float kRecoveryStep = 0.05f;
+
+// Below this share of the budget the scale may grow
+constexpr double kHeadroom = 0.8;
+
+} // namespace
+
+// ============================================================================
+// ofDynamicResolution::Impl
+// ============================================================================
+
+struct ofDynamicResolution::Impl {
+    ofFbo target;
+    id<MTLTexture> output = nil;        // Native size, written by the upscale
+    ofTexture outputTexture;            // Draws output
+
+    int width = 0;
+    int height = 0;
+    int renderWidth = 0;
+    int renderHeight = 0;
+
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+    float scale = 1.0f;
+    float budgetMs = 0.0f;              // 0 = from the target frame rate
+    bool adaptive = true;
+    ofUpscaler upscaler = OF_UPSCALER_METALFX;
+
+    double averageGpuMs = 0.0;
+    int settleFrames = 0;
+
+    float clampScale(float value) const {
+        return std::clamp(value, minScale, maxScale);
+    }
+
+    double budget() const {
+        if (budgetMs > 0.0f) {
+            return budgetMs;
+        }
+        const float fps = Context::instance().getTargetFrameRate();
+        return fps > 0.0f ? 900.0 / fps : 15.0;
+    }
+
+    void updateScale() {
+        auto* renderer = Context::instance().renderer();
+        const double gpuMs = renderer ? renderer->getLastGPUTime() : 0.0;
+        if (!adaptive || gpuMs <= 0.0) {
+            return;
+        }
+        averageGpuMs = averageGpuMs > 0.0 ? averageGpuMs + (gpuMs - averageGpuMs) / 4.0 : gpuMs;
+
+        // Frames still in flight were rendered at the previous scale
+        if (settleFrames > 0) {
+            settleFrames--;
+            return;
+        }
+
+        // GPU cost follows the pixel count, the square of the scale
+        const double limit = budget();
+        float next = scale;
+        if (averageGpuMs > limit) {
+            next = clampScale(scale * static_cast<float>(std::sqrt(limit / averageGpuMs)));
+        } else if (averageGpuMs < limit * kHeadroom) {
+            next = clampScale(scale + kRecoveryStep);
+        }
+        if (next != scale) {
+            scale = next;
+            settleFrames = kSettleFrames;
+        }
+    }
+};
+
+// ============================================================================
+// ofDynamicResolution
+// ============================================================================
+
+ofDynamicResolution::ofDynamicResolution() : impl_(std::make_unique<Impl>()) {}
+
+ofDynamicResolution::~ofDynamicResolution() = default;
+
+bool ofDynamicResolution::allocate(int width, int height, bool useDepth, int numSamples) {
+    @autoreleasepool {
+        auto* renderer = Context::instance().renderer();
+        if (!renderer || width <= 0 || height <= 0) {
+            ofLogError("ofDynamicResolution") << "Cannot allocate " << width << "x" << height;
+            return false;
+        }
+
+        ofFboSettings settings;
+        settings.width = width;
+        settings.height = height;
+        settings.useDepth = useDepth;
+        settings.numSamples = numSamples;
+        impl_->target.allocateWithSettings(settings);
+        id<MTLTexture> color = (__bridge id<MTLTexture>)impl_->target.getNativeTextureHandle();
+        if (!color) {
+            ofLogError("ofDynamicResolution") << "Failed to allocate the render target";
+            return false;
+        }
+
+        // Private render target: what MetalFX writes; shader-writable for the bilinear copy
+        id<MTLDevice> device = (__bridge id<MTLDevice>)renderer->getDevice();
+        MTLTextureDescriptor* desc = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:color.pixelFormat
+                                                                                        width:width
+                                                                                       height:height
+                                                                                    mipmapped:NO];
+        desc.usage = MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite | MTLTextureUsageRenderTarget;
+        desc.storageMode = MTLStorageModePrivate;
+        impl_->output = render::metal::makeTrackedTexture(device, desc, ofGpuMemoryCategory::RenderTargets,
+                                                          "Dynamic Resolution Output");
+        if (!impl_->output) {
+            ofLogError("ofDynamicResolution") << "Failed to allocate the output texture";
+            impl_->target.clear();
+            return false;
+        }
+        impl_->outputTexture.setNativeHandle((__bridge void*)impl_->output);
+
+        impl_->width = width;
+        impl_->height = height;
+        impl_->renderWidth = std::max(1, static_cast<int>(std::lround(width * impl_->scale)));
+        impl_->renderHeight = std::max(1, static_cast<int>(std::lround(height * impl_->scale)));
+        impl_->averageGpuMs = 0.0;
+        impl_->settleFrames = 0;
+        return true;
+    }
+}
+
+bool ofDynamicResolution::isAllocated() const {
+    return impl_->output != nil;
+}
+
+// ============================================================================
+// Scale Control
+// ============================================================================
+
+void ofDynamicResolution::setScaleRange(float minScale, float maxScale) {
+    if (minScale <= 0.0f || maxScale > 1.0f || minScale > maxScale) {
+        ofLogWarning("ofDynamicResolution") << "Invalid scale range " << minScale << " - " << maxScale;
+        return;
+    }
+    impl_->minScale = minScale;
+    impl_->maxScale = maxScale;
+    impl_->scale = impl_->clampScale(impl_->scale);
+}
+
+void ofDynamicResolution::setGpuBudget(float milliseconds) {
+    impl_->budgetMs = std::max(milliseconds, 0.0f);
+}
+
+void ofDynamicResolution::setAdaptive(bool adaptive) {
+    impl_->adaptive = adaptive;
+    impl_->settleFrames = kSettleFrames;
+}
+
+void ofDynamicResolution::setScale(float scale) {
+    impl_->scale = impl_->clampScale(scale);
+    impl_->settleFrames = kSettleFrames;
+}
+
+void ofDynamicResolution::setUpscaler(ofUpscaler upscaler) {
+    impl_->upscaler = upscaler;
+}
+
+float ofDynamicResolution::getScale() const {
+    return impl_->scale;
+}
+
+int ofDynamicResolution::getRenderWidth() const {
+    return impl_->renderWidth;
+}
+
+int ofDynamicResolution::getRenderHeight() const {
+    return impl_->renderHeight;
+}
+
+int ofDynamicResolution::getWidth() const {
+    return impl_->width;
+}
+
+int ofDynamicResolution::getHeight() const {
+    return impl_->height;
+}
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+void ofDynamicResolution::begin() {
+    if (!isAllocated()) {
+        return;
+    }
+    impl_->updateScale();
+    impl_->renderWidth = std::max(1, static_cast<int>(std::lround(impl_->width * impl_->scale)));
+    impl_->renderHeight = std::max(1, static_cast<int>(std::lround(impl_->height * impl_->scale)));
+
+    // The target's viewport covers all of it; narrow it to the region
+    impl_->target.begin();
+    render::SetViewportCommand viewport;
+    viewport.viewport = render::Rect(0, 0, static_cast<float>(impl_->renderWidth),
+                                     static_cast<float>(impl_->renderHeight));
+    Context::instance().getDrawList().addCommand(viewport);
+}
+
+void ofDynamicResolution::end() {
+    if (!isAllocated()) {
+        return;
+    }
+    impl_->target.end();
+
+    // Runs after the region has rendered, before anything drawn over the output
+    render::CopyTextureCommand upscale;
+    upscale.source = impl_->target.getNativeTextureHandle();
+    upscale.destination = (__bridge void*)impl_->output;
+    upscale.sourceWidth = static_cast<uint32_t>(impl_->renderWidth);
+    upscale.sourceHeight = static_cast<uint32_t>(impl_->renderHeight);
+    upscale.filter = impl_->upscaler == OF_UPSCALER_METALFX ? render::CopyTextureFilter::Upscale
+                                                             : render::CopyTextureFilter::Bilinear;
+    Context::instance().getDrawList().addCommand(upscale);
+}
+
+void ofDynamicResolution::draw(float x, float y) const {
+    draw(x, y, static_cast<float>(impl_->width), static_cast<float>(impl_->height));
+}
+
+void ofDynamicResolution::draw(float x, float y, float width, float height) const {
+    if (isAllocated()) {
+        impl_->outputTexture.draw(x, y, width, height);
+    }
+}
+
+const ofTexture& ofDynamicResolution::getTexture() const {
+    return impl_->outputTexture;
+}
+
+} // namespace oflike
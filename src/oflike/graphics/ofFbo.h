@@ -3,10 +3,12 @@
 // oflike-metal ofFbo - openFrameworks API compatible framebuffer object
 // Provides offscreen rendering target functionality
 
+#include <future>
 #include <memory>
 #include <vector>
 #include "../image/ofTexture.h"
 #include "../image/ofPixels.h"
+#include "ofRasterizationRate.h"
 
 namespace oflike {
 
@@ -49,7 +51,7 @@ struct ofFboSettings {
 /// - Offscreen rendering to textures
 /// - Optional depth buffer support
 /// - Multiple color attachments (MRT)
-/// - Multisampling anti-aliasing (MSAA)
+/// - Multisampling anti-aliasing (MSAA), resolved in the render pass
 /// - Read back to ofPixels
 /// - Draw FBO contents to screen
 ///
@@ -59,6 +61,13 @@ struct ofFboSettings {
 /// - Internally uses MTLTexture render targets
 /// - Thread-safety: Main thread only (Metal requirement)
 ///
+/// Multisampling:
+/// - The samples live in a buffer owned by the renderer (tile memory on
+///   Apple GPUs) and are resolved into the color texture as each pass ends,
+///   so an MSAA FBO costs little more memory or bandwidth than a plain one
+/// - Samples last for one begin()/end(): begin with ofClear(); drawing
+///   without one starts from transparent black, not the earlier contents
+///
 /// Example:
 /// \code
 ///     ofFbo fbo;
@@ -103,7 +112,7 @@ public:
     /// \param width Width in pixels
     /// \param height Height in pixels
     /// \param internalFormat Color texture format (default: OF_IMAGE_COLOR_ALPHA)
-    /// \param numSamples MSAA samples (0=off, 2/4/8=MSAA)
+    /// \param numSamples MSAA samples (0=off, 2/4/8=MSAA; lowered to what the GPU supports)
     void allocate(int width, int height,
                   int internalFormat = OF_IMAGE_COLOR_ALPHA,
                   int numSamples = 0);
@@ -132,6 +141,16 @@ public:
     /// \details Restores previous render target and viewport.
     void end();
 
+    /// \brief Shade this FBO at reduced rates by region
+    /// \details Applies to every color attachment and is kept across
+    /// reallocation. Clear the FBO on each begin(): its contents are
+    /// replaced when it is resolved to full size. Ignored with MSAA.
+    /// \return false if the GPU has no rasterization rate maps
+    bool setRasterizationRate(const ofRasterizationRate& rate);
+
+    /// \brief Shade this FBO at full rate again
+    void clearRasterizationRate();
+
     // ========================================================================
     // Drawing
     // ========================================================================
@@ -186,6 +205,18 @@ public:
     /// \param attachmentIndex Attachment index (0-3)
     void readToPixels(ofPixels& pixels, int attachmentIndex) const;
 
+    /// \brief Read a color attachment without waiting for the GPU
+    /// \details The copy is recorded into this frame's drawing, after
+    /// everything drawn into the FBO so far (readToPixels() only sees what
+    /// earlier frames drew), and the future resolves one or two frames later
+    /// from a Metal completion thread. Poll it with
+    /// wait_for(std::chrono::seconds(0)); blocking in the frame that
+    /// recorded it never returns, as that frame renders after draw().
+    /// \param attachmentIndex Attachment index (0-3)
+    /// \return Future resolving to the pixels (unallocated if the copy
+    ///         failed); invalid (valid() is false) if not allocated
+    std::future<ofPixels> readToPixelsAsync(int attachmentIndex = 0) const;
+
     // ========================================================================
     // Properties
     // ========================================================================
@@ -210,6 +241,10 @@ public:
     /// \return true if stencil buffer exists
     bool hasStencilBuffer() const;
 
+    /// \brief Get MSAA sample count
+    /// \return Samples per pixel (0 if not multisampled)
+    int getNumSamples() const;
+
     // ========================================================================
     // Multi-Attachment Control (MRT)
     // ========================================================================
@@ -243,4 +278,78 @@ private:
     void ensureImpl();
 };
 
+// ============================================================================
+// ofFboPool - Transient FBO Reuse
+// ============================================================================
+
+/// \brief Reuses FBOs of the same settings instead of reallocating them
+/// \details For transient targets such as post-processing passes: acquire
+/// an FBO for the work of a frame and release it when done. Released FBOs
+/// keep their textures and are handed out again to any request with the
+/// same settings; those unused for kMaxIdleFrames frames are freed.
+///
+/// Reusing an FBO within the same frame is safe: all drawing is recorded in
+/// order, so the GPU finishes earlier reads before later passes overwrite it.
+///
+/// Example:
+/// \code
+///     ofFbo* blur = ofFboPool::shared().acquire(w, h);
+///     blur->begin();
+///     ofClear(0);
+///     // Draw pass...
+///     blur->end();
+///     blur->draw(0, 0);
+///     ofFboPool::shared().release(blur);
+/// \endcode
+class ofFboPool {
+public:
+    /// Frames a released FBO stays pooled without being acquired
+    static constexpr unsigned long long kMaxIdleFrames = 120;
+
+    ofFboPool() = default;
+    ofFboPool(const ofFboPool&) = delete;
+    ofFboPool& operator=(const ofFboPool&) = delete;
+
+    /// \brief Pool shared by the whole app
+    static ofFboPool& shared();
+
+    /// \brief Acquire an FBO, reusing a released one with the same settings
+    /// \param width Width in pixels
+    /// \param height Height in pixels
+    /// \param internalFormat Color texture format (default: OF_IMAGE_COLOR_ALPHA)
+    /// \param numSamples MSAA samples (0=off, 2/4/8=MSAA)
+    /// \return FBO owned by the pool, or nullptr if allocation failed
+    ofFbo* acquire(int width, int height,
+                   int internalFormat = OF_IMAGE_COLOR_ALPHA,
+                   int numSamples = 0);
+
+    /// \brief Acquire an FBO with detailed settings
+    /// \param settings FBO configuration settings
+    /// \return FBO owned by the pool, or nullptr if allocation failed
+    ofFbo* acquire(const ofFboSettings& settings);
+
+    /// \brief Return an acquired FBO to the pool (its contents are kept
+    /// until it is acquired again)
+    /// \param fbo FBO returned by acquire()
+    void release(ofFbo* fbo);
+
+    /// \brief Free every released FBO now
+    void clear();
+
+    /// \brief Get number of FBOs held, acquired or not
+    size_t getPooledCount() const;
+
+    /// \brief Get number of FBOs currently acquired
+    size_t getInUseCount() const;
+
+private:
+    struct Entry {
+        ofFboSettings settings;
+        std::unique_ptr<ofFbo> fbo;
+        bool inUse = false;
+        unsigned long long lastUsedFrame = 0;
+    };
+    std::vector<Entry> entries_;
+};
+
 } // namespace oflike
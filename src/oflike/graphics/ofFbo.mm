@@ -2,10 +2,14 @@
 #import "../../core/Context.h"
 #import "../../render/DrawList.h"
 #import "../../render/DrawCommand.h"
+#import "../image/TextureReadback.h"
 #import "../../render/metal/MetalTexture.h"
 #import "../../render/metal/MetalRenderer.h"  // Phase 7.3: For viewport/render target queries
+#import "../../render/metal/MetalAllocations.h"
+#import "../utils/ofUtils.h"
 #import <Metal/Metal.h>
 #import <MetalKit/MetalKit.h>
+#include <algorithm>
 #include <vector>
 #include <stdexcept>
 
@@ -64,7 +68,6 @@ struct ofFbo::Impl {
     std::vector<id<MTLTexture>> colorTextures;
     id<MTLTexture> depthTexture = nil;
     id<MTLTexture> stencilTexture = nil;
-    id<MTLTexture> msaaTexture = nil; // For MSAA resolve
 
     // ofTexture wrappers
     std::vector<ofTexture> textureWrappers;
@@ -79,6 +82,9 @@ struct ofFbo::Impl {
     int activeDrawBuffer = 0;
     std::vector<int> activeDrawBuffers;  // For simultaneous MRT rendering
 
+    // Shading rates, registered with the renderer per color texture
+    ofRasterizationRate rasterizationRate;
+
     // Helper: Get Metal device from Context (Phase 7.1)
     id<MTLDevice> getDevice() const {
         void* devicePtr = Context::instance().getMetalDevice();
@@ -94,14 +100,27 @@ struct ofFbo::Impl {
     }
 
     void release() {
+        applyRasterizationRate(render::RasterizationRate());
         colorTextures.clear();
         depthTexture = nil;
         stencilTexture = nil;
-        msaaTexture = nil;
         textureWrappers.clear();
         bAllocated = false;
     }
 
+    // Register rate (empty = full rate) for every color texture
+    bool applyRasterizationRate(const render::RasterizationRate& rate) {
+        auto* renderer = Context::instance().renderer();
+        if (!renderer) {
+            return rate.empty();
+        }
+        bool success = true;
+        for (id<MTLTexture> texture : colorTextures) {
+            success = renderer->setRasterizationRate((__bridge void*)texture, rate) && success;
+        }
+        return success;
+    }
+
     bool allocate(const ofFboSettings& settings) {
         @autoreleasepool {
             id<MTLDevice> device = getDevice();
@@ -135,11 +154,13 @@ struct ofFbo::Impl {
             colorDesc.usage = MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead;
             colorDesc.storageMode = MTLStorageModePrivate;
 
+            applyRasterizationRate(render::RasterizationRate());
             colorTextures.clear();
             textureWrappers.clear();
 
             for (int i = 0; i < numColorAttachments; ++i) {
-                id<MTLTexture> texture = [device newTextureWithDescriptor:colorDesc];
+                id<MTLTexture> texture = render::metal::makeTrackedTexture(device, colorDesc, ofGpuMemoryCategory::RenderTargets,
+                                                                          "ofFbo Color");
                 if (!texture) {
                     release();
                     return false;
@@ -162,7 +183,8 @@ struct ofFbo::Impl {
                 depthDesc.usage = MTLTextureUsageRenderTarget;
                 depthDesc.storageMode = MTLStorageModePrivate;
 
-                depthTexture = [device newTextureWithDescriptor:depthDesc];
+                depthTexture = render::metal::makeTrackedTexture(device, depthDesc, ofGpuMemoryCategory::RenderTargets,
+                                                                 "ofFbo Depth");
                 if (!depthTexture) {
                     release();
                     return false;
@@ -178,32 +200,31 @@ struct ofFbo::Impl {
                 stencilDesc.usage = MTLTextureUsageRenderTarget;
                 stencilDesc.storageMode = MTLStorageModePrivate;
 
-                stencilTexture = [device newTextureWithDescriptor:stencilDesc];
+                stencilTexture = render::metal::makeTrackedTexture(device, stencilDesc, ofGpuMemoryCategory::RenderTargets,
+                                                                   "ofFbo Stencil");
                 if (!stencilTexture) {
                     release();
                     return false;
                 }
             }
 
-            // Create MSAA texture if requested
+            // MSAA: the renderer draws into a multisample buffer of its own
+            // (tile memory on Apple GPUs) and resolves into the color
+            // texture in the same pass; only the sample count is kept here
             if (numSamples > 1) {
-                MTLTextureDescriptor* msaaDesc = [[MTLTextureDescriptor alloc] init];
-                msaaDesc.pixelFormat = colorFormat;
-                msaaDesc.width = width;
-                msaaDesc.height = height;
-                msaaDesc.textureType = MTLTextureType2DMultisample;
-                msaaDesc.sampleCount = numSamples;
-                msaaDesc.usage = MTLTextureUsageRenderTarget;
-                msaaDesc.storageMode = MTLStorageModePrivate;
-
-                msaaTexture = [device newTextureWithDescriptor:msaaDesc];
-                if (!msaaTexture) {
-                    release();
-                    return false;
+                numSamples = numSamples >= 8 ? 8 : numSamples >= 4 ? 4 : 2;
+                while (numSamples > 1 && ![device supportsTextureSampleCount:numSamples]) {
+                    numSamples /= 2;
                 }
             }
+            if (numSamples < 2) {
+                numSamples = 0;
+            }
 
             bAllocated = true;
+            if (!rasterizationRate.isFullRate()) {
+                applyRasterizationRate(rasterizationRate.getRate());
+            }
             return true;
         }
     }
@@ -251,8 +272,7 @@ struct ofFbo::Impl {
         }
 
         // Set FBO as render target
-        render::SetRenderTargetCommand rtCmd;
-        rtCmd.renderTarget = targetTexture;
+        render::SetRenderTargetCommand rtCmd(targetTexture, getSampleCount());
         drawList.addCommand(rtCmd);
 
         // Set viewport to FBO dimensions
@@ -263,6 +283,10 @@ struct ofFbo::Impl {
         isRendering = true;
     }
 
+    uint32_t getSampleCount() const {
+        return numSamples > 1 ? (uint32_t)numSamples : 1;
+    }
+
     void end() {
         if (!bAllocated || !isRendering) {
             return;
@@ -436,6 +460,19 @@ void ofFbo::end() {
     }
 }
 
+bool ofFbo::setRasterizationRate(const ofRasterizationRate& rate) {
+    ensureImpl();
+    impl_->rasterizationRate = rate;
+    return impl_->applyRasterizationRate(rate.isFullRate() ? render::RasterizationRate() : rate.getRate());
+}
+
+void ofFbo::clearRasterizationRate() {
+    if (impl_) {
+        impl_->rasterizationRate = ofRasterizationRate();
+        impl_->applyRasterizationRate(render::RasterizationRate());
+    }
+}
+
 // ============================================================================
 // Drawing
 // ============================================================================
@@ -508,6 +545,15 @@ void ofFbo::readToPixels(ofPixels& pixels, int attachmentIndex) const {
     }
 }
 
+std::future<ofPixels> ofFbo::readToPixelsAsync(int attachmentIndex) const {
+    if (!impl_ || !impl_->bAllocated || attachmentIndex < 0 ||
+        attachmentIndex >= (int)impl_->colorTextures.size()) {
+        return std::future<ofPixels>();
+    }
+    return readTextureAsync((__bridge void*)impl_->colorTextures[attachmentIndex],
+                            impl_->width, impl_->height, 4);
+}
+
 // ============================================================================
 // Properties
 // ============================================================================
@@ -532,6 +578,10 @@ bool ofFbo::hasStencilBuffer() const {
     return impl_ && impl_->useStencil;
 }
 
+int ofFbo::getNumSamples() const {
+    return impl_ ? impl_->numSamples : 0;
+}
+
 // ============================================================================
 // Multi-Attachment Control (MRT)
 // ============================================================================
@@ -554,8 +604,8 @@ void ofFbo::setActiveDrawBuffer(int attachmentIndex) {
         auto& ctx = Context::instance();
         auto& drawList = ctx.getDrawList();
 
-        render::SetRenderTargetCommand rtCmd;
-        rtCmd.renderTarget = (__bridge void*)impl_->colorTextures[attachmentIndex];
+        render::SetRenderTargetCommand rtCmd((__bridge void*)impl_->colorTextures[attachmentIndex],
+                                             impl_->getSampleCount());
         drawList.addCommand(rtCmd);
     }
 }
@@ -588,8 +638,8 @@ void ofFbo::setActiveDrawBuffers(const std::vector<int>& attachmentIndices) {
         auto& drawList = ctx.getDrawList();
 
         int firstAttachment = impl_->activeDrawBuffers[0];
-        render::SetRenderTargetCommand rtCmd;
-        rtCmd.renderTarget = (__bridge void*)impl_->colorTextures[firstAttachment];
+        render::SetRenderTargetCommand rtCmd((__bridge void*)impl_->colorTextures[firstAttachment],
+                                             impl_->getSampleCount());
         drawList.addCommand(rtCmd);
     }
 }
@@ -618,4 +668,93 @@ void* ofFbo::getNativeDepthHandle() const {
     return (__bridge void*)impl_->depthTexture;
 }
 
+// ============================================================================
+// ofFboPool Implementation
+// ============================================================================
+
+static bool SameSettings(const ofFboSettings& a, const ofFboSettings& b) {
+    return a.width == b.width && a.height == b.height &&
+           a.numColorAttachments == b.numColorAttachments && a.internalFormat == b.internalFormat &&
+           a.useDepth == b.useDepth && a.useStencil == b.useStencil &&
+           std::max(a.numSamples, 1) == std::max(b.numSamples, 1);
+}
+
+ofFboPool& ofFboPool::shared() {
+    static ofFboPool pool;
+    return pool;
+}
+
+ofFbo* ofFboPool::acquire(int width, int height, int internalFormat, int numSamples) {
+    ofFboSettings settings;
+    settings.width = width;
+    settings.height = height;
+    settings.internalFormat = internalFormat;
+    settings.numSamples = numSamples;
+    return acquire(settings);
+}
+
+ofFbo* ofFboPool::acquire(const ofFboSettings& settings) {
+    const unsigned long long frame = ofGetFrameNum();
+
+    ofFbo* fbo = nullptr;
+    for (Entry& entry : entries_) {
+        if (!entry.inUse && SameSettings(entry.settings, settings)) {
+            entry.inUse = true;
+            entry.lastUsedFrame = frame;
+            fbo = entry.fbo.get();
+            break;
+        }
+    }
+
+    // Free FBOs nobody asked for in a while give their memory back
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                  [frame](const Entry& entry) {
+                                      return !entry.inUse && frame > entry.lastUsedFrame + kMaxIdleFrames;
+                                  }),
+                   entries_.end());
+    if (fbo) {
+        return fbo;
+    }
+
+    Entry entry;
+    entry.settings = settings;
+    entry.fbo = std::make_unique<ofFbo>();
+    entry.fbo->allocateWithSettings(settings);
+    if (!entry.fbo->isAllocated()) {
+        return nullptr;
+    }
+    entry.inUse = true;
+    entry.lastUsedFrame = frame;
+    entries_.push_back(std::move(entry));
+    return entries_.back().fbo.get();
+}
+
+void ofFboPool::release(ofFbo* fbo) {
+    for (Entry& entry : entries_) {
+        if (entry.fbo.get() == fbo) {
+            entry.inUse = false;
+            entry.lastUsedFrame = ofGetFrameNum();
+            return;
+        }
+    }
+}
+
+void ofFboPool::clear() {
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                  [](const Entry& entry) { return !entry.inUse; }),
+                   entries_.end());
+}
+
+size_t ofFboPool::getPooledCount() const {
+    return entries_.size();
+}
+
+size_t ofFboPool::getInUseCount() const {
+    size_t count = 0;
+    for (const Entry& entry : entries_) {
+        count += entry.inUse ? 1 : 0;
+    }
+    return count;
+}
+
 } // namespace oflike
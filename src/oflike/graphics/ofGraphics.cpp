@@ -1,18 +1,26 @@
 #include "ofGraphics.h"
+#include "ofGraphicsTransform.h"
 #include "../math/ofMatrix4x4.h"
+#include "../math/ofVec2f.h"
 #include "../math/ofVec3f.h"
+#include "../types/ofColor.h"
 #include "ofPath.h"
+#include "ofPolyline.h"
+#include "ofDisplayList.h"
 #include "../../core/Context.h"
 #include "../../render/IRenderer.h"
 #include "../../render/RenderTypes.h"
 #include "../../render/DrawList.h"
 #include "../../render/DrawCommand.h"
 #include <algorithm>
+#include <cmath>
 #include <simd/simd.h>
 #include <vector>
 #include <stack>
 #include <map>
+#include <unordered_map>
 #include <array>
+#include <cstring>
 
 // ============================================================================
 // Internal Graphics State
@@ -31,6 +39,13 @@ namespace {
         ShapeVertexType type;
     };
 
+    // Cached ofEndShape() fill, see ofEnableShapeCache()
+    struct ShapeTessellation {
+        std::vector<float> key;             // Full key stream (guards against hash collisions)
+        std::vector<simd_float2> vertices;
+        std::vector<uint32_t> indices;
+    };
+
     struct GraphicsState {
         // Current colors (0-255 range)
         uint8_t currentColor[4] = {255, 255, 255, 255};  // RGBA
@@ -43,8 +58,22 @@ namespace {
         float lineWidth = 1.0f;
         uint32_t circleResolution = 32;
         uint32_t curveResolution = 20;
+        float curveTolerance = 0.0f;    // Screen pixels, 0 = fixed curveResolution
         uint32_t sphereResolution = 20;
 
+        // Circles, ellipses, rounded rects and thick lines as SDF quads
+        bool sdfShapesEnabled = false;
+
+        // Wide stroke style (lineWidth > 1)
+        int strokeJoin = OF_STROKE_JOIN_MITER;
+        int strokeCap = OF_STROKE_CAP_BUTT;
+        float miterLimit = 4.0f;
+
+        // Scratch storage for stroke submission (reused between calls)
+        std::vector<simd_float2> strokePoints;
+        std::vector<render::StrokeSegment2D> strokeSegments;
+        std::vector<oflike::ofVec3f> curvePoints;
+
         // Blend mode (default: alpha blending)
         int blendMode = OF_BLENDMODE_ALPHA;
 
@@ -52,6 +81,10 @@ namespace {
         bool depthTestEnabled = false;
         bool depthWriteEnabled = true;
         bool cullingEnabled = false;
+        bool frustumCullingEnabled = true;
+        bool occlusionCullingEnabled = false;
+        bool orderIndependentTransparency = false;
+        uint32_t objectId = 0;              // Stamped on 3D draws for GPU picking
 
         // Lighting (default: disabled for 2D compatibility)
         bool lightingEnabled = false;
@@ -61,29 +94,289 @@ namespace {
         std::stack<oflike::ofMatrix4x4> matrixStack;
         oflike::ofMatrix4x4 currentMatrix;
 
+        // simd forms of currentMatrix for command recording, rebuilt lazily
+        // after the stack changes (see markTransformDirty())
+        simd_float4x4 modelMatrix = matrix_identity_float4x4;
+        simd_float4x4 modelViewMatrix = matrix_identity_float4x4;
+        simd_float4x4 modelViewSource = matrix_identity_float4x4;  // View it was built with
+        simd_float3x3 normalMatrix = matrix_identity_float3x3;
+        bool modelMatrixDirty = false;
+        bool modelViewDirty = true;
+        bool normalMatrixDirty = true;
+
         // Texture binding (Phase 7.2)
         void* activeTexture = nullptr;  // Currently bound texture (id<MTLTexture> handle)
 
+        // Unit-circle (cos, sin) tables keyed by segment count, see getCircleTable()
+        std::map<uint32_t, std::vector<simd_float2>> circleTables;
+
         // Shape API state
         bool shapeBegun = false;
         std::vector<std::vector<ShapeVertex>> shapeContours;  // Multiple contours for holes
         std::vector<ShapeVertex> currentContour;
 
+        // Shape fill rule and ofEndShape() tessellation cache (opt-in)
+        int polyWindingMode = OF_POLY_WINDING_ODD;
+        bool shapeCacheEnabled = false;
+        std::unordered_map<uint64_t, ShapeTessellation> shapeCache;
+        std::vector<float> shapeKey;  // Scratch key stream
+
         GraphicsState() {
             // Initialize with identity matrix
             currentMatrix = oflike::ofMatrix4x4::identity();
         }
     };
 
+    // Per thread so worker threads can record their own DrawLists (see
+    // Context::bindThreadDrawList); each thread starts from default state
     GraphicsState& getGraphicsState() {
-        static GraphicsState state;
+        thread_local GraphicsState state;
         return state;
     }
 
+    // Call after any write to currentMatrix
+    void markTransformDirty(GraphicsState& state) {
+        state.modelMatrixDirty = true;
+        state.modelViewDirty = true;
+        state.normalMatrixDirty = true;
+    }
+
+    const simd_float4x4& getModelMatrix(GraphicsState& state) {
+        if (state.modelMatrixDirty) {
+            state.modelMatrix = state.currentMatrix.toSimd();
+            state.modelMatrixDirty = false;
+        }
+        return state.modelMatrix;
+    }
+
+    // The camera may change the view between draws without touching the
+    // stack, so the view the product was built with is part of the cache
+    const simd_float4x4& getModelViewMatrix(GraphicsState& state) {
+        const simd_float4x4 view = Context::instance().getViewMatrix();
+        if (state.modelViewDirty || !simd_equal(view, state.modelViewSource)) {
+            state.modelViewMatrix = simd_mul(view, getModelMatrix(state));
+            state.modelViewSource = view;
+            state.modelViewDirty = false;
+            state.normalMatrixDirty = true;
+        }
+        return state.modelViewMatrix;
+    }
+
+    simd_float3x3 upperLeft3x3(const simd_float4x4& m) {
+        return simd_matrix(
+            simd_make_float3(m.columns[0].x, m.columns[0].y, m.columns[0].z),
+            simd_make_float3(m.columns[1].x, m.columns[1].y, m.columns[1].z),
+            simd_make_float3(m.columns[2].x, m.columns[2].y, m.columns[2].z)
+        );
+    }
+
+    const simd_float3x3& getNormalMatrix(GraphicsState& state) {
+        const simd_float4x4& mv = getModelViewMatrix(state);
+        if (state.normalMatrixDirty) {
+            state.normalMatrix = simd_transpose(simd_inverse(upperLeft3x3(mv)));
+            state.normalMatrixDirty = false;
+        }
+        return state.normalMatrix;
+    }
+
     // Convert 0-255 uint8_t color to 0.0-1.0 float4
     simd_float4 colorToFloat4(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
         return simd_make_float4(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f);
     }
+
+    // Distinct resolutions are few in practice; drop the lot if a sketch sweeps them
+    constexpr size_t kMaxCircleTables = 16;
+
+    // Unit circle sampled at segments + 1 points (the last repeats the first
+    // exactly so fans and outlines close without a seam). Built once per
+    // resolution; circles, ellipses and rounded corners scale/offset it.
+    const std::vector<simd_float2>& getCircleTable(GraphicsState& state, uint32_t segments) {
+        auto it = state.circleTables.find(segments);
+        if (it != state.circleTables.end()) {
+            return it->second;
+        }
+
+        if (state.circleTables.size() >= kMaxCircleTables) {
+            state.circleTables.clear();
+        }
+
+        std::vector<simd_float2>& table = state.circleTables[segments];
+        table.resize(segments + 1);
+        for (uint32_t i = 0; i < segments; i++) {
+            double angle = (2.0 * M_PI * i) / segments;
+            table[i] = simd_make_float2(static_cast<float>(std::cos(angle)),
+                                        static_cast<float>(std::sin(angle)));
+        }
+        table[segments] = table[0];
+        return table;
+    }
+
+    // Queue one SDF shape with the current color, blend mode and transform;
+    // consecutive shapes merge into one instanced draw in DrawList::optimize()
+    void submitShape2D(render::ShapeKind2D kind, simd_float2 center, simd_float2 axis,
+                       simd_float2 halfSize, float cornerRadius, float strokeWidth) {
+        auto& state = getGraphicsState();
+        auto& drawList = Context::instance().getDrawList();
+
+        render::ShapeInstance2D shape = {};
+        shape.center = center;
+        shape.axis = axis;
+        shape.halfSize = halfSize;
+        shape.cornerRadius = cornerRadius;
+        shape.strokeWidth = strokeWidth;
+        shape.color = colorToFloat4(state.currentColor[0], state.currentColor[1],
+                                    state.currentColor[2], state.currentColor[3]);
+        shape.kind = kind;
+
+        render::DrawCommand2DShapes cmd;
+        cmd.shapeOffset = drawList.addShapes(&shape, 1);
+        cmd.shapeCount = 1;
+        cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
+
+        cmd.transform = getModelMatrix(state);
+
+        drawList.addCommand(cmd);
+    }
+
+    // Append the stroke segments of a polyline through points (2D, z
+    // ignored) with the given style; false if it has fewer than two
+    // distinct points
+    template<typename Point>
+    bool appendStrokeSegments(std::vector<render::StrokeSegment2D>& segments, const Point* points,
+                              size_t count, bool closed, render::StrokeSegment2D segment) {
+        auto& state = getGraphicsState();
+
+        // Repeated points would leave segments without a direction
+        auto& pts = state.strokePoints;
+        pts.clear();
+        for (size_t i = 0; i < count; i++) {
+            const simd_float2 p = simd_make_float2(points[i].x, points[i].y);
+            if (pts.empty() || !simd_equal(pts.back(), p)) {
+                pts.push_back(p);
+            }
+        }
+        if (closed && pts.size() > 2 && simd_equal(pts.front(), pts.back())) {
+            pts.pop_back();
+        }
+        closed = closed && pts.size() > 2;
+        if (pts.size() < 2) {
+            return false;
+        }
+
+        const size_t n = pts.size();
+        const size_t segmentCount = closed ? n : n - 1;
+        segments.reserve(segments.size() + segmentCount);
+        for (size_t i = 0; i < segmentCount; i++) {
+            segment.p0 = pts[i];
+            segment.p1 = pts[(i + 1) % n];
+            segment.flags = 0;
+            if (closed || i > 0) {
+                segment.flags |= render::kStrokeHasPrevious;
+            }
+            if (closed || i + 2 < n) {
+                segment.flags |= render::kStrokeHasNext;
+                segment.next = pts[(i + 2) % n];
+            } else {
+                segment.next = segment.p1;
+            }
+            segments.push_back(segment);
+        }
+        return true;
+    }
+
+    // Queue a wide stroke through points: one segment record each, expanded
+    // into body, joins and caps by the stroke vertex shader. Consecutive
+    // strokes merge into one instanced draw in DrawList::optimize().
+    template<typename Point>
+    void submitStroke2D(const Point* points, size_t count, bool closed) {
+        auto& state = getGraphicsState();
+
+        render::StrokeSegment2D segment = {};
+        segment.halfWidth = state.lineWidth * 0.5f;
+        segment.color = colorToFloat4(state.currentColor[0], state.currentColor[1],
+                                      state.currentColor[2], state.currentColor[3]);
+        segment.join = static_cast<render::StrokeJoin2D>(state.strokeJoin);
+        segment.cap = static_cast<render::StrokeCap2D>(state.strokeCap);
+        segment.miterLimit = state.miterLimit;
+
+        auto& segments = state.strokeSegments;
+        segments.clear();
+        if (!appendStrokeSegments(segments, points, count, closed, segment)) {
+            return;
+        }
+
+        auto& drawList = Context::instance().getDrawList();
+        render::DrawCommand2DStroke cmd;
+        cmd.segmentOffset = drawList.addStrokeSegments(segments.data(), segments.size());
+        cmd.segmentCount = static_cast<uint32_t>(segments.size());
+        cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
+
+        cmd.transform = getModelMatrix(state);
+
+        drawList.addCommand(cmd);
+    }
+
+    // Index count of a polyline drawn as a line list
+    size_t polylineIndexCount(size_t count, bool closed) {
+        if (count < 2) {
+            return 0;
+        }
+        return (count - 1) * 2 + (closed && count > 2 ? 2 : 0);
+    }
+
+    // Write a polyline as a line list: one vertex per point (z ignored) and
+    // an index pair per segment, indices counted from base
+    void writePolylineLines(render::Vertex2D* vertices, uint32_t* indices, uint32_t base,
+                            const oflike::ofVec3f* points, size_t count, bool closed, simd_float4 color) {
+        const simd_float2 zero = simd_make_float2(0.0f, 0.0f);
+        for (size_t i = 0; i < count; i++) {
+            vertices[i] = render::Vertex2D(simd_make_float2(points[i].x, points[i].y), zero, color);
+        }
+        for (uint32_t i = 0; i + 1 < count; i++) {
+            *indices++ = base + i;
+            *indices++ = base + i + 1;
+        }
+        if (closed && count > 2) {
+            *indices++ = base + static_cast<uint32_t>(count - 1);
+            *indices++ = base;
+        }
+    }
+
+    // Write the count + 1 points of a scaled circle-table arc (stroke
+    // outlines); returns the end of the written points
+    simd_float2* writeArcPoints(simd_float2* out, const std::vector<simd_float2>& table,
+                                uint32_t first, uint32_t count, simd_float2 center, simd_float2 radii) {
+        for (uint32_t i = 0; i <= count; i++) {
+            *out++ = center + radii * table[first + i];
+        }
+        return out;
+    }
+
+    // Vertices and indices of a triangle-fan arc
+    constexpr uint32_t arcFanVertexCount(uint32_t count) { return count + 2; }
+    constexpr uint32_t arcFanIndexCount(uint32_t count) { return count * 3; }
+
+    // Write a triangle-fan arc: center plus points[first..first+count] mapped
+    // to center + radii * p, with texcoords 0.5 + 0.5 * p. Vertices are
+    // numbered from base; all three cursors are advanced past the fan.
+    void writeArcFan(render::Vertex2D*& vertices, uint32_t*& indices, uint32_t& base,
+                     const std::vector<simd_float2>& table, uint32_t first, uint32_t count,
+                     simd_float2 center, simd_float2 radii, simd_float4 color) {
+        const simd_float2 half = simd_make_float2(0.5f, 0.5f);
+
+        *vertices++ = render::Vertex2D(center, half, color);
+        for (uint32_t i = 0; i <= count; i++) {
+            const simd_float2 p = table[first + i];
+            *vertices++ = render::Vertex2D(center + radii * p, half + half * p, color);
+        }
+
+        for (uint32_t i = 1; i <= count; i++) {
+            *indices++ = base;           // Center
+            *indices++ = base + i;       // Current perimeter point
+            *indices++ = base + i + 1;   // Next perimeter point
+        }
+        base += arcFanVertexCount(count);
+    }
 }
 
 // ============================================================================
@@ -283,6 +576,38 @@ uint32_t ofGetCircleResolution() {
     return getGraphicsState().circleResolution;
 }
 
+void ofEnableSDFShapes() {
+    getGraphicsState().sdfShapesEnabled = true;
+}
+
+void ofDisableSDFShapes() {
+    getGraphicsState().sdfShapesEnabled = false;
+}
+
+bool ofGetSDFShapesEnabled() {
+    return getGraphicsState().sdfShapesEnabled;
+}
+
+void ofSetStrokeJoin(ofStrokeJoin join) {
+    getGraphicsState().strokeJoin = join;
+}
+
+ofStrokeJoin ofGetStrokeJoin() {
+    return static_cast<ofStrokeJoin>(getGraphicsState().strokeJoin);
+}
+
+void ofSetStrokeCap(ofStrokeCap cap) {
+    getGraphicsState().strokeCap = cap;
+}
+
+ofStrokeCap ofGetStrokeCap() {
+    return static_cast<ofStrokeCap>(getGraphicsState().strokeCap);
+}
+
+void ofSetMiterLimit(float limit) {
+    getGraphicsState().miterLimit = std::max(1.0f, limit);
+}
+
 void ofSetCurveResolution(uint32_t resolution) {
     getGraphicsState().curveResolution = std::max(2u, resolution);
 }
@@ -291,6 +616,49 @@ uint32_t ofGetCurveResolution() {
     return getGraphicsState().curveResolution;
 }
 
+void ofSetCurveTolerance(float pixels) {
+    getGraphicsState().curveTolerance = std::max(0.0f, pixels);
+}
+
+float ofGetCurveTolerance() {
+    return getGraphicsState().curveTolerance;
+}
+
+namespace {
+    // Keeps a degenerate tolerance or transform from exploding a curve
+    constexpr uint32_t kMaxCurveSegments = 1024;
+
+    // Largest stretch of the model transform in the XY plane, in pixels
+    // per unit under the 2D projection
+    float curveScale(GraphicsState& state) {
+        const simd_float4x4& m = getModelMatrix(state);
+        return std::max(simd_length(simd_make_float3(m.columns[0])),
+                        simd_length(simd_make_float3(m.columns[1])));
+    }
+}
+
+uint32_t ofGetBezierSegments(const oflike::ofVec3f& p0, const oflike::ofVec3f& cp1,
+                             const oflike::ofVec3f& cp2, const oflike::ofVec3f& p1) {
+    auto& state = getGraphicsState();
+    if (state.curveTolerance <= 0.0f) {
+        return state.curveResolution;
+    }
+
+    // Wang's formula: n uniform steps keep the flattened cubic within the
+    // tolerance of the curve, from the control polygon's second differences
+    const oflike::ofVec3f d0 = p0 - cp1 * 2.0f + cp2;
+    const oflike::ofVec3f d1 = cp1 - cp2 * 2.0f + p1;
+    const float dd = std::max(d0.length(), d1.length()) * curveScale(state);
+    const float n = std::ceil(std::sqrt(0.75f * dd / state.curveTolerance));
+    return static_cast<uint32_t>(std::clamp(n, 1.0f, static_cast<float>(kMaxCurveSegments)));
+}
+
+uint32_t ofGetCurveSegments(const oflike::ofVec3f& p0, const oflike::ofVec3f& p1,
+                            const oflike::ofVec3f& p2, const oflike::ofVec3f& p3) {
+    // The Catmull-Rom span from p1 to p2 is the cubic Bezier with these controls
+    return ofGetBezierSegments(p1, p1 + (p2 - p0) / 6.0f, p2 - (p3 - p1) / 6.0f, p2);
+}
+
 void ofSetSphereResolution(uint32_t resolution) {
     getGraphicsState().sphereResolution = std::max(3u, resolution);
 }
@@ -333,6 +701,7 @@ void ofPopMatrix() {
     if (!state.matrixStack.empty()) {
         state.currentMatrix = state.matrixStack.top();
         state.matrixStack.pop();
+        markTransformDirty(state);
     }
     // If stack is empty, do nothing (silently fail, matching oF behavior)
 }
@@ -341,12 +710,14 @@ void ofTranslate(float x, float y, float z) {
     auto& state = getGraphicsState();
     auto translationMatrix = oflike::ofMatrix4x4::newTranslationMatrix(x, y, z);
     state.currentMatrix = state.currentMatrix * translationMatrix;
+    markTransformDirty(state);
 }
 
 void ofRotate(float angle, float x, float y, float z) {
     auto& state = getGraphicsState();
     auto rotationMatrix = oflike::ofMatrix4x4::newRotationMatrix(angle, x, y, z);
     state.currentMatrix = state.currentMatrix * rotationMatrix;
+    markTransformDirty(state);
 }
 
 void ofRotate(float angle) {
@@ -370,6 +741,7 @@ void ofScale(float x, float y, float z) {
     auto& state = getGraphicsState();
     auto scaleMatrix = oflike::ofMatrix4x4::newScaleMatrix(x, y, z);
     state.currentMatrix = state.currentMatrix * scaleMatrix;
+    markTransformDirty(state);
 }
 
 void ofScale(float scale) {
@@ -379,16 +751,19 @@ void ofScale(float scale) {
 void ofLoadIdentityMatrix() {
     auto& state = getGraphicsState();
     state.currentMatrix = oflike::ofMatrix4x4::identity();
+    markTransformDirty(state);
 }
 
 void ofLoadMatrix(const oflike::ofMatrix4x4& m) {
     auto& state = getGraphicsState();
     state.currentMatrix = m;
+    markTransformDirty(state);
 }
 
 void ofMultMatrix(const oflike::ofMatrix4x4& m) {
     auto& state = getGraphicsState();
     state.currentMatrix = state.currentMatrix * m;
+    markTransformDirty(state);
 }
 
 oflike::ofMatrix4x4 ofGetCurrentMatrix() {
@@ -399,6 +774,22 @@ int ofGetMatrixStackDepth() {
     return static_cast<int>(getGraphicsState().matrixStack.size());
 }
 
+// ============================================================================
+// Cached Transform Matrices
+// ============================================================================
+
+const simd_float4x4& ofGetCurrentModelMatrix() {
+    return getModelMatrix(getGraphicsState());
+}
+
+const simd_float4x4& ofGetCurrentModelViewMatrix() {
+    return getModelViewMatrix(getGraphicsState());
+}
+
+const simd_float3x3& ofGetCurrentNormalMatrix() {
+    return getNormalMatrix(getGraphicsState());
+}
+
 // ============================================================================
 // Basic Shape Drawing
 // ============================================================================
@@ -410,6 +801,25 @@ void ofDrawLine(float x1, float y1, float x2, float y2) {
 void ofDrawLine(float x1, float y1, float z1, float x2, float y2, float z2) {
     auto& state = getGraphicsState();
 
+    // Thick lines: a box along the segment (butt caps)
+    if (state.sdfShapesEnabled && state.lineWidth > 1.0f) {
+        simd_float2 p1 = simd_make_float2(x1, y1);
+        simd_float2 p2 = simd_make_float2(x2, y2);
+        float length = simd_length(p2 - p1);
+        if (length > 0.0f) {
+            submitShape2D(render::ShapeKind2D::RoundedRect, (p1 + p2) * 0.5f, (p2 - p1) / length,
+                          simd_make_float2(length * 0.5f, state.lineWidth * 0.5f), 0.0f, 0.0f);
+        }
+        return;
+    }
+
+    // Other wide lines go through the stroker (caps apply)
+    if (state.lineWidth > 1.0f) {
+        const simd_float2 points[2] = {simd_make_float2(x1, y1), simd_make_float2(x2, y2)};
+        submitStroke2D(points, 2, false);
+        return;
+    }
+
     // Create line vertices (2D rendering)
     simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
                                        state.currentColor[2], state.currentColor[3]);
@@ -430,14 +840,41 @@ void ofDrawLine(float x1, float y1, float z1, float x2, float y2, float z2) {
     cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
     cmd.texture = nullptr;
 
-    // Convert ofMatrix4x4 to simd_float4x4
-    auto& m = state.currentMatrix;
-    cmd.transform = simd_matrix(
-        simd_make_float4(m(0,0), m(1,0), m(2,0), m(3,0)),
-        simd_make_float4(m(0,1), m(1,1), m(2,1), m(3,1)),
-        simd_make_float4(m(0,2), m(1,2), m(2,2), m(3,2)),
-        simd_make_float4(m(0,3), m(1,3), m(2,3), m(3,3))
-    );
+    cmd.transform = getModelMatrix(state);
+
+    drawList.addCommand(cmd);
+}
+
+void ofDrawPolyline(const oflike::ofVec3f* points, size_t count, bool closed) {
+    auto& state = getGraphicsState();
+    if (!points || count < 2) {
+        return;
+    }
+
+    if (state.lineWidth > 1.0f) {
+        submitStroke2D(points, count, closed);
+        return;
+    }
+
+    // One indexed line list for the whole polyline; unlike a strip it
+    // still merges with neighbouring line draws
+    auto& drawList = Context::instance().getDrawList();
+    const size_t indexCount = polylineIndexCount(count, closed);
+    auto geometry = drawList.allocateGeometry2D(count, indexCount);
+    writePolylineLines(geometry.vertices, geometry.indices, 0, points, count, closed,
+                       colorToFloat4(state.currentColor[0], state.currentColor[1],
+                                     state.currentColor[2], state.currentColor[3]));
+
+    render::DrawCommand2D cmd;
+    cmd.vertexOffset = geometry.vertexOffset;
+    cmd.vertexCount = static_cast<uint32_t>(count);
+    cmd.indexOffset = geometry.indexOffset;
+    cmd.indexCount = static_cast<uint32_t>(indexCount);
+    cmd.primitiveType = render::PrimitiveType::Line;
+    cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
+    cmd.texture = nullptr;
+
+    cmd.transform = getModelMatrix(state);
 
     drawList.addCommand(cmd);
 }
@@ -450,41 +887,37 @@ void ofDrawRectangle(float x, float y, float w, float h) {
         simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
                                            state.currentColor[2], state.currentColor[3]);
 
-        // Create 4 vertices for the rectangle
-        render::Vertex2D vertices[4];
+        // Write 4 vertices and 2 triangles (0,1,2) and (0,2,3) in place
+        auto& drawList = Context::instance().getDrawList();
+        auto geometry = drawList.allocateGeometry2D(4, 6);
+        render::Vertex2D* vertices = geometry.vertices;
         vertices[0] = render::Vertex2D(x, y, 0.0f, 0.0f, color.x, color.y, color.z, color.w);
         vertices[1] = render::Vertex2D(x + w, y, 1.0f, 0.0f, color.x, color.y, color.z, color.w);
         vertices[2] = render::Vertex2D(x + w, y + h, 1.0f, 1.0f, color.x, color.y, color.z, color.w);
         vertices[3] = render::Vertex2D(x, y + h, 0.0f, 1.0f, color.x, color.y, color.z, color.w);
-
-        // Create indices for 2 triangles (0,1,2) and (0,2,3)
-        uint32_t indices[6] = {0, 1, 2, 0, 2, 3};
-
-        // Add vertices and indices to DrawList
-        auto& drawList = Context::instance().getDrawList();
-        uint32_t vtxOffset = drawList.addVertices2D(vertices, 4);
-        uint32_t idxOffset = drawList.addIndices(indices, 6);
+        const uint32_t indices[6] = {0, 1, 2, 0, 2, 3};
+        std::memcpy(geometry.indices, indices, sizeof(indices));
 
         // Create draw command
         render::DrawCommand2D cmd;
-        cmd.vertexOffset = vtxOffset;
+        cmd.vertexOffset = geometry.vertexOffset;
         cmd.vertexCount = 4;
-        cmd.indexOffset = idxOffset;
+        cmd.indexOffset = geometry.indexOffset;
         cmd.indexCount = 6;
         cmd.primitiveType = render::PrimitiveType::Triangle;
         cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
         cmd.texture = nullptr;
 
-        // Convert ofMatrix4x4 to simd_float4x4
-        auto& m = state.currentMatrix;
-        cmd.transform = simd_matrix(
-            simd_make_float4(m(0,0), m(1,0), m(2,0), m(3,0)),
-            simd_make_float4(m(0,1), m(1,1), m(2,1), m(3,1)),
-            simd_make_float4(m(0,2), m(1,2), m(2,2), m(3,2)),
-            simd_make_float4(m(0,3), m(1,3), m(2,3), m(3,3))
-        );
+        cmd.transform = getModelMatrix(state);
 
         drawList.addCommand(cmd);
+    } else if (state.lineWidth > 1.0f) {
+        // Wide outline as one closed stroke so the corners get joins
+        const simd_float2 points[4] = {
+            simd_make_float2(x, y), simd_make_float2(x + w, y),
+            simd_make_float2(x + w, y + h), simd_make_float2(x, y + h)
+        };
+        submitStroke2D(points, 4, true);
     } else {
         // Draw rectangle outline (4 lines)
         ofDrawLine(x, y, x + w, y);           // Top
@@ -494,6 +927,28 @@ void ofDrawRectangle(float x, float y, float w, float h) {
     }
 }
 
+// Helper function to submit filled 2D geometry written in place (see
+// DrawList::allocateGeometry2D) with the current transform
+static void submit2DGeometry(const render::DrawList::GeometryAllocation<render::Vertex2D>& geometry,
+                             uint32_t vertexCount, uint32_t indexCount) {
+    auto& state = getGraphicsState();
+    auto& drawList = Context::instance().getDrawList();
+
+    // Create draw command
+    render::DrawCommand2D cmd;
+    cmd.vertexOffset = geometry.vertexOffset;
+    cmd.vertexCount = vertexCount;
+    cmd.indexOffset = geometry.indexOffset;
+    cmd.indexCount = indexCount;
+    cmd.primitiveType = render::PrimitiveType::Triangle;
+    cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
+    cmd.texture = nullptr;
+
+    cmd.transform = getModelMatrix(state);
+
+    drawList.addCommand(cmd);
+}
+
 void ofDrawRectRounded(float x, float y, float w, float h, float r) {
     auto& state = getGraphicsState();
 
@@ -506,12 +961,28 @@ void ofDrawRectRounded(float x, float y, float w, float h, float r) {
         return;
     }
 
+    if (state.sdfShapesEnabled) {
+        submitShape2D(render::ShapeKind2D::RoundedRect, simd_make_float2(x + w * 0.5f, y + h * 0.5f),
+                      simd_make_float2(1.0f, 0.0f), simd_make_float2(w * 0.5f, h * 0.5f), r,
+                      state.fillEnabled ? 0.0f : state.lineWidth);
+        return;
+    }
+
     // Calculate corner centers
     float x1 = x + r;
     float y1 = y + r;
     float x2 = x + w - r;
     float y2 = y + h - r;
 
+    // Corners are quarters of one full-circle table: [0, q] spans 0..PI/2,
+    // [q, 2q] PI/2..PI and so on
+    uint32_t resolution = std::max(1u, state.circleResolution / 4);
+    const auto& table = getCircleTable(state, resolution * 4);
+    const uint32_t bottomRight = 0;
+    const uint32_t bottomLeft = resolution;
+    const uint32_t topLeft = resolution * 2;
+    const uint32_t topRight = resolution * 3;
+
     if (state.fillEnabled) {
         // Draw filled rounded rectangle
         // Center rectangle
@@ -519,68 +990,34 @@ void ofDrawRectRounded(float x, float y, float w, float h, float r) {
         ofDrawRectangle(x, y1, r, y2 - y1);
         ofDrawRectangle(x2, y1, r, y2 - y1);
 
-        // Draw 4 corner arcs using triangle fans
-        uint32_t resolution = state.circleResolution / 4;
+        // Draw 4 corner arcs as triangle fans in one command
         simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
                                            state.currentColor[2], state.currentColor[3]);
-
-        // Helper lambda to draw a quarter circle arc (filled)
-        auto drawQuarterCircle = [&](float cx, float cy, float radius, float startAngle) {
-            std::vector<render::Vertex2D> vertices;
-            vertices.reserve(resolution + 2);
-
-            // Center vertex
-            vertices.push_back(render::Vertex2D(cx, cy, 0.5f, 0.5f, color.x, color.y, color.z, color.w));
-
-            // Arc vertices
-            for (uint32_t i = 0; i <= resolution; i++) {
-                float angle = startAngle + (M_PI_2 * i) / resolution;
-                float vx = cx + radius * std::cos(angle);
-                float vy = cy + radius * std::sin(angle);
-                float u = 0.5f + 0.5f * std::cos(angle);
-                float v = 0.5f + 0.5f * std::sin(angle);
-                vertices.push_back(render::Vertex2D(vx, vy, u, v, color.x, color.y, color.z, color.w));
-            }
-
-            // Create indices for triangle fan
-            std::vector<uint32_t> indices;
-            indices.reserve(resolution * 3);
-            for (uint32_t i = 1; i <= resolution; i++) {
-                indices.push_back(0);
-                indices.push_back(i);
-                indices.push_back(i + 1);
-            }
-
-            // Add to DrawList
-            auto& drawList = Context::instance().getDrawList();
-            uint32_t vtxOffset = drawList.addVertices2D(vertices);
-            uint32_t idxOffset = drawList.addIndices(indices);
-
-            render::DrawCommand2D cmd;
-            cmd.vertexOffset = vtxOffset;
-            cmd.vertexCount = static_cast<uint32_t>(vertices.size());
-            cmd.indexOffset = idxOffset;
-            cmd.indexCount = static_cast<uint32_t>(indices.size());
-            cmd.primitiveType = render::PrimitiveType::Triangle;
-            cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
-            cmd.texture = nullptr;
-
-            auto& m = state.currentMatrix;
-            cmd.transform = simd_matrix(
-                simd_make_float4(m(0,0), m(1,0), m(2,0), m(3,0)),
-                simd_make_float4(m(0,1), m(1,1), m(2,1), m(3,1)),
-                simd_make_float4(m(0,2), m(1,2), m(2,2), m(3,2)),
-                simd_make_float4(m(0,3), m(1,3), m(2,3), m(3,3))
-            );
-
-            drawList.addCommand(cmd);
-        };
-
-        // Draw 4 corner arcs
-        drawQuarterCircle(x1, y1, r, M_PI);          // Top-left
-        drawQuarterCircle(x2, y1, r, M_PI + M_PI_2); // Top-right
-        drawQuarterCircle(x2, y2, r, 0.0f);          // Bottom-right
-        drawQuarterCircle(x1, y2, r, M_PI_2);        // Bottom-left
+        const simd_float2 radii = simd_make_float2(r, r);
+
+        const uint32_t vertexCount = arcFanVertexCount(resolution) * 4;
+        const uint32_t indexCount = arcFanIndexCount(resolution) * 4;
+        auto geometry = Context::instance().getDrawList().allocateGeometry2D(vertexCount, indexCount);
+        render::Vertex2D* v = geometry.vertices;
+        uint32_t* idx = geometry.indices;
+        uint32_t base = 0;
+        writeArcFan(v, idx, base, table, topLeft, resolution, simd_make_float2(x1, y1), radii, color);
+        writeArcFan(v, idx, base, table, topRight, resolution, simd_make_float2(x2, y1), radii, color);
+        writeArcFan(v, idx, base, table, bottomRight, resolution, simd_make_float2(x2, y2), radii, color);
+        writeArcFan(v, idx, base, table, bottomLeft, resolution, simd_make_float2(x1, y2), radii, color);
+
+        submit2DGeometry(geometry, vertexCount, indexCount);
+    } else if (state.lineWidth > 1.0f) {
+        // Wide outline: corner arcs joined by the straight edges, one closed stroke
+        const simd_float2 radii = simd_make_float2(r, r);
+        const size_t count = (resolution + 1) * 4;
+        simd_float2* points = Context::instance().getDrawList().allocateTransient<simd_float2>(count);
+        simd_float2* p = points;
+        p = writeArcPoints(p, table, topLeft, resolution, simd_make_float2(x1, y1), radii);
+        p = writeArcPoints(p, table, topRight, resolution, simd_make_float2(x2, y1), radii);
+        p = writeArcPoints(p, table, bottomRight, resolution, simd_make_float2(x2, y2), radii);
+        writeArcPoints(p, table, bottomLeft, resolution, simd_make_float2(x1, y2), radii);
+        submitStroke2D(points, count, true);
     } else {
         // Draw outline with rounded corners
         // Top edge
@@ -592,29 +1029,21 @@ void ofDrawRectRounded(float x, float y, float w, float h, float r) {
         // Left edge
         ofDrawLine(x, y2, x, y1);
 
-        // Draw corner arcs (quarter circles)
-        uint32_t resolution = state.circleResolution / 4;
-
         // Helper lambda to draw a quarter circle arc (outline)
-        auto drawQuarterCircleOutline = [&](float cx, float cy, float radius, float startAngle) {
+        auto drawQuarterCircleOutline = [&](float cx, float cy, float radius, uint32_t first) {
+            const simd_float2 center = simd_make_float2(cx, cy);
             for (uint32_t i = 0; i < resolution; i++) {
-                float angle1 = startAngle + (M_PI_2 * i) / resolution;
-                float angle2 = startAngle + (M_PI_2 * (i + 1)) / resolution;
-
-                float x1 = cx + radius * std::cos(angle1);
-                float y1 = cy + radius * std::sin(angle1);
-                float x2 = cx + radius * std::cos(angle2);
-                float y2 = cy + radius * std::sin(angle2);
-
-                ofDrawLine(x1, y1, x2, y2);
+                simd_float2 p1 = center + radius * table[first + i];
+                simd_float2 p2 = center + radius * table[first + i + 1];
+                ofDrawLine(p1.x, p1.y, p2.x, p2.y);
             }
         };
 
         // Draw 4 corner arcs
-        drawQuarterCircleOutline(x1, y1, r, M_PI);          // Top-left
-        drawQuarterCircleOutline(x2, y1, r, M_PI + M_PI_2); // Top-right
-        drawQuarterCircleOutline(x2, y2, r, 0.0f);          // Bottom-right
-        drawQuarterCircleOutline(x1, y2, r, M_PI_2);        // Bottom-left
+        drawQuarterCircleOutline(x1, y1, r, topLeft);
+        drawQuarterCircleOutline(x2, y1, r, topRight);
+        drawQuarterCircleOutline(x2, y2, r, bottomRight);
+        drawQuarterCircleOutline(x1, y2, r, bottomLeft);
     }
 }
 
@@ -624,157 +1053,89 @@ void ofDrawCircle(float x, float y, float radius) {
 
 void ofDrawCircle(float x, float y, float z, float radius) {
     auto& state = getGraphicsState();
+
+    if (state.sdfShapesEnabled) {
+        submitShape2D(render::ShapeKind2D::Ellipse, simd_make_float2(x, y), simd_make_float2(1.0f, 0.0f),
+                      simd_make_float2(radius, radius), 0.0f, state.fillEnabled ? 0.0f : state.lineWidth);
+        return;
+    }
+
     uint32_t resolution = state.circleResolution;
+    const auto& table = getCircleTable(state, resolution);
 
     if (state.fillEnabled) {
         // Draw filled circle using triangle fan
         simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
                                            state.currentColor[2], state.currentColor[3]);
 
-        // Create vertices: center + perimeter
-        std::vector<render::Vertex2D> vertices;
-        vertices.reserve(resolution + 2);
-
-        // Center vertex
-        vertices.push_back(render::Vertex2D(x, y, 0.5f, 0.5f, color.x, color.y, color.z, color.w));
-
-        // Perimeter vertices
-        for (uint32_t i = 0; i <= resolution; i++) {
-            float angle = (2.0f * M_PI * i) / resolution;
-            float vx = x + radius * std::cos(angle);
-            float vy = y + radius * std::sin(angle);
-            // Texture coordinates map to circle (for potential texture mapping)
-            float u = 0.5f + 0.5f * std::cos(angle);
-            float v = 0.5f + 0.5f * std::sin(angle);
-            vertices.push_back(render::Vertex2D(vx, vy, u, v, color.x, color.y, color.z, color.w));
-        }
-
-        // Create indices for triangle fan
-        std::vector<uint32_t> indices;
-        indices.reserve(resolution * 3);
-        for (uint32_t i = 1; i <= resolution; i++) {
-            indices.push_back(0);       // Center
-            indices.push_back(i);       // Current perimeter point
-            indices.push_back(i + 1);   // Next perimeter point
-        }
-
-        // Add vertices and indices to DrawList
-        auto& drawList = Context::instance().getDrawList();
-        uint32_t vtxOffset = drawList.addVertices2D(vertices);
-        uint32_t idxOffset = drawList.addIndices(indices);
-
-        // Create draw command
-        render::DrawCommand2D cmd;
-        cmd.vertexOffset = vtxOffset;
-        cmd.vertexCount = static_cast<uint32_t>(vertices.size());
-        cmd.indexOffset = idxOffset;
-        cmd.indexCount = static_cast<uint32_t>(indices.size());
-        cmd.primitiveType = render::PrimitiveType::Triangle;
-        cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
-        cmd.texture = nullptr;
-
-        // Convert ofMatrix4x4 to simd_float4x4
-        auto& m = state.currentMatrix;
-        cmd.transform = simd_matrix(
-            simd_make_float4(m(0,0), m(1,0), m(2,0), m(3,0)),
-            simd_make_float4(m(0,1), m(1,1), m(2,1), m(3,1)),
-            simd_make_float4(m(0,2), m(1,2), m(2,2), m(3,2)),
-            simd_make_float4(m(0,3), m(1,3), m(2,3), m(3,3))
-        );
-
-        drawList.addCommand(cmd);
+        // Vertices: center + perimeter, written in place
+        auto geometry = Context::instance().getDrawList().allocateGeometry2D(
+            arcFanVertexCount(resolution), arcFanIndexCount(resolution));
+        render::Vertex2D* v = geometry.vertices;
+        uint32_t* idx = geometry.indices;
+        uint32_t base = 0;
+        writeArcFan(v, idx, base, table, 0, resolution, simd_make_float2(x, y),
+                    simd_make_float2(radius, radius), color);
+
+        submit2DGeometry(geometry, arcFanVertexCount(resolution), arcFanIndexCount(resolution));
+    } else if (state.lineWidth > 1.0f && z == 0.0f) {
+        // Wide outline as one closed stroke
+        simd_float2* points = Context::instance().getDrawList().allocateTransient<simd_float2>(resolution + 1);
+        writeArcPoints(points, table, 0, resolution, simd_make_float2(x, y),
+                       simd_make_float2(radius, radius));
+        submitStroke2D(points, resolution + 1, true);
     } else {
         // Draw circle outline using line loop
+        const simd_float2 center = simd_make_float2(x, y);
         for (uint32_t i = 0; i < resolution; i++) {
-            float angle1 = (2.0f * M_PI * i) / resolution;
-            float angle2 = (2.0f * M_PI * (i + 1)) / resolution;
-
-            float x1 = x + radius * std::cos(angle1);
-            float y1 = y + radius * std::sin(angle1);
-            float x2 = x + radius * std::cos(angle2);
-            float y2 = y + radius * std::sin(angle2);
-
-            ofDrawLine(x1, y1, z, x2, y2, z);
+            simd_float2 p1 = center + radius * table[i];
+            simd_float2 p2 = center + radius * table[i + 1];
+            ofDrawLine(p1.x, p1.y, z, p2.x, p2.y, z);
         }
     }
 }
 
 void ofDrawEllipse(float x, float y, float width, float height) {
     auto& state = getGraphicsState();
+
+    if (state.sdfShapesEnabled) {
+        submitShape2D(render::ShapeKind2D::Ellipse, simd_make_float2(x, y), simd_make_float2(1.0f, 0.0f),
+                      simd_make_float2(width / 2.0f, height / 2.0f), 0.0f,
+                      state.fillEnabled ? 0.0f : state.lineWidth);
+        return;
+    }
+
     uint32_t resolution = state.circleResolution;
+    const auto& table = getCircleTable(state, resolution);
 
-    float radiusX = width / 2.0f;
-    float radiusY = height / 2.0f;
+    const simd_float2 center = simd_make_float2(x, y);
+    const simd_float2 radii = simd_make_float2(width / 2.0f, height / 2.0f);
 
     if (state.fillEnabled) {
         // Draw filled ellipse using triangle fan
         simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
                                            state.currentColor[2], state.currentColor[3]);
 
-        // Create vertices: center + perimeter
-        std::vector<render::Vertex2D> vertices;
-        vertices.reserve(resolution + 2);
-
-        // Center vertex
-        vertices.push_back(render::Vertex2D(x, y, 0.5f, 0.5f, color.x, color.y, color.z, color.w));
-
-        // Perimeter vertices
-        for (uint32_t i = 0; i <= resolution; i++) {
-            float angle = (2.0f * M_PI * i) / resolution;
-            float vx = x + radiusX * std::cos(angle);
-            float vy = y + radiusY * std::sin(angle);
-            // Texture coordinates map to ellipse
-            float u = 0.5f + 0.5f * std::cos(angle);
-            float v = 0.5f + 0.5f * std::sin(angle);
-            vertices.push_back(render::Vertex2D(vx, vy, u, v, color.x, color.y, color.z, color.w));
-        }
-
-        // Create indices for triangle fan
-        std::vector<uint32_t> indices;
-        indices.reserve(resolution * 3);
-        for (uint32_t i = 1; i <= resolution; i++) {
-            indices.push_back(0);       // Center
-            indices.push_back(i);       // Current perimeter point
-            indices.push_back(i + 1);   // Next perimeter point
-        }
-
-        // Add vertices and indices to DrawList
-        auto& drawList = Context::instance().getDrawList();
-        uint32_t vtxOffset = drawList.addVertices2D(vertices);
-        uint32_t idxOffset = drawList.addIndices(indices);
-
-        // Create draw command
-        render::DrawCommand2D cmd;
-        cmd.vertexOffset = vtxOffset;
-        cmd.vertexCount = static_cast<uint32_t>(vertices.size());
-        cmd.indexOffset = idxOffset;
-        cmd.indexCount = static_cast<uint32_t>(indices.size());
-        cmd.primitiveType = render::PrimitiveType::Triangle;
-        cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
-        cmd.texture = nullptr;
-
-        // Convert ofMatrix4x4 to simd_float4x4
-        auto& m = state.currentMatrix;
-        cmd.transform = simd_matrix(
-            simd_make_float4(m(0,0), m(1,0), m(2,0), m(3,0)),
-            simd_make_float4(m(0,1), m(1,1), m(2,1), m(3,1)),
-            simd_make_float4(m(0,2), m(1,2), m(2,2), m(3,2)),
-            simd_make_float4(m(0,3), m(1,3), m(2,3), m(3,3))
-        );
-
-        drawList.addCommand(cmd);
+        // Vertices: center + perimeter, written in place
+        auto geometry = Context::instance().getDrawList().allocateGeometry2D(
+            arcFanVertexCount(resolution), arcFanIndexCount(resolution));
+        render::Vertex2D* v = geometry.vertices;
+        uint32_t* idx = geometry.indices;
+        uint32_t base = 0;
+        writeArcFan(v, idx, base, table, 0, resolution, center, radii, color);
+
+        submit2DGeometry(geometry, arcFanVertexCount(resolution), arcFanIndexCount(resolution));
+    } else if (state.lineWidth > 1.0f) {
+        // Wide outline as one closed stroke
+        simd_float2* points = Context::instance().getDrawList().allocateTransient<simd_float2>(resolution + 1);
+        writeArcPoints(points, table, 0, resolution, center, radii);
+        submitStroke2D(points, resolution + 1, true);
     } else {
         // Draw ellipse outline
         for (uint32_t i = 0; i < resolution; i++) {
-            float angle1 = (2.0f * M_PI * i) / resolution;
-            float angle2 = (2.0f * M_PI * (i + 1)) / resolution;
-
-            float x1 = x + radiusX * std::cos(angle1);
-            float y1 = y + radiusY * std::sin(angle1);
-            float x2 = x + radiusX * std::cos(angle2);
-            float y2 = y + radiusY * std::sin(angle2);
-
-            ofDrawLine(x1, y1, x2, y2);
+            simd_float2 p1 = center + radii * table[i];
+            simd_float2 p2 = center + radii * table[i + 1];
+            ofDrawLine(p1.x, p1.y, p2.x, p2.y);
         }
     }
 }
@@ -811,14 +1172,7 @@ void ofDrawTriangle(float x1, float y1, float z1, float x2, float y2, float z2,
         cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
         cmd.texture = nullptr;
 
-        // Convert ofMatrix4x4 to simd_float4x4
-        auto& m = state.currentMatrix;
-        cmd.transform = simd_matrix(
-            simd_make_float4(m(0,0), m(1,0), m(2,0), m(3,0)),
-            simd_make_float4(m(0,1), m(1,1), m(2,1), m(3,1)),
-            simd_make_float4(m(0,2), m(1,2), m(2,2), m(3,2)),
-            simd_make_float4(m(0,3), m(1,3), m(2,3), m(3,3))
-        );
+        cmd.transform = getModelMatrix(state);
 
         drawList.addCommand(cmd);
     } else {
@@ -830,51 +1184,529 @@ void ofDrawTriangle(float x1, float y1, float z1, float x2, float y2, float z2,
 }
 
 // ============================================================================
-// Curve Drawing
+// Bulk Shape Drawing
 // ============================================================================
 
-/**
- * Evaluate Catmull-Rom spline at parameter t.
- * Formula: P(t) = 0.5 * [2*P1 + (-P0 + P2)*t + (2*P0 - 5*P1 + 4*P2 - P3)*t^2 + (-P0 + 3*P1 - 3*P2 + P3)*t^3]
- */
+// The bulk entry points read graphics state and convert the transform once,
+// allocate their whole range in the DrawList up front and generate geometry
+// in place with simd_float2 math (one tight loop per shape kind, no staging
+// vectors), then emit a single command for the lot.
 namespace {
-    float catmullRomInterpolate(float p0, float p1, float p2, float p3, float t) {
-        float t2 = t * t;
-        float t3 = t2 * t;
+    // Per-item color, or the current color when no color array was given
+    struct BulkColors {
+        const oflike::ofColor* colors;
+        simd_float4 current;
+
+        simd_float4 operator[](size_t i) const {
+            if (!colors) {
+                return current;
+            }
+            return colorToFloat4(colors[i].r, colors[i].g, colors[i].b, colors[i].a);
+        }
+    };
 
-        return 0.5f * (
-            2.0f * p1 +
-            (-p0 + p2) * t +
-            (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
-            (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t3
-        );
+    BulkColors bulkColors(GraphicsState& state, const oflike::ofColor* colors) {
+        return {colors, colorToFloat4(state.currentColor[0], state.currentColor[1],
+                                      state.currentColor[2], state.currentColor[3])};
     }
-}
-
-void ofDrawCurve(float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3) {
-    ofDrawCurve(x0, y0, 0.0f, x1, y1, 0.0f, x2, y2, 0.0f, x3, y3, 0.0f);
-}
 
-void ofDrawCurve(float x0, float y0, float z0, float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3) {
-    auto& state = getGraphicsState();
-    uint32_t resolution = state.curveResolution;
+    simd_float2 toFloat2(const oflike::ofVec2f& v) {
+        return simd_make_float2(v.x, v.y);
+    }
 
-    // Draw curve as a series of line segments
-    float prevX = x1, prevY = y1, prevZ = z1;
+    void submitBulkGeometry(GraphicsState& state, uint32_t vertexOffset, uint32_t vertexCount,
+                            uint32_t indexOffset, uint32_t indexCount, render::PrimitiveType primitive) {
+        render::DrawCommand2D cmd;
+        cmd.vertexOffset = vertexOffset;
+        cmd.vertexCount = vertexCount;
+        cmd.indexOffset = indexOffset;
+        cmd.indexCount = indexCount;
+        cmd.primitiveType = primitive;
+        cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
+        cmd.texture = nullptr;
+        cmd.transform = getModelMatrix(state);
+        Context::instance().getDrawList().addCommand(cmd);
+    }
 
-    for (uint32_t i = 1; i <= resolution; i++) {
-        float t = static_cast<float>(i) / resolution;
+    void submitBulkShapes(GraphicsState& state, uint32_t offset, uint32_t count) {
+        render::DrawCommand2DShapes cmd;
+        cmd.shapeOffset = offset;
+        cmd.shapeCount = count;
+        cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
+        cmd.transform = getModelMatrix(state);
+        Context::instance().getDrawList().addCommand(cmd);
+    }
+
+    void submitBulkStroke(GraphicsState& state, uint32_t offset, uint32_t count) {
+        render::DrawCommand2DStroke cmd;
+        cmd.segmentOffset = offset;
+        cmd.segmentCount = count;
+        cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
+        cmd.transform = getModelMatrix(state);
+        Context::instance().getDrawList().addCommand(cmd);
+    }
+
+    // Stroke segment with the current width and style; endpoints left to the caller
+    render::StrokeSegment2D strokeStyle(GraphicsState& state) {
+        render::StrokeSegment2D segment = {};
+        segment.halfWidth = state.lineWidth * 0.5f;
+        segment.join = static_cast<render::StrokeJoin2D>(state.strokeJoin);
+        segment.cap = static_cast<render::StrokeCap2D>(state.strokeCap);
+        segment.miterLimit = state.miterLimit;
+        return segment;
+    }
+
+    // Closed stroke loop through points[0..count) (count >= 3)
+    void writeClosedStroke(render::StrokeSegment2D* out, const simd_float2* points, uint32_t count,
+                           const render::StrokeSegment2D& style, simd_float4 color) {
+        for (uint32_t i = 0; i < count; i++) {
+            render::StrokeSegment2D& segment = out[i];
+            segment = style;
+            segment.p0 = points[i];
+            segment.p1 = points[(i + 1) % count];
+            segment.next = points[(i + 2) % count];
+            segment.flags = render::kStrokeHasPrevious | render::kStrokeHasNext;
+            segment.color = color;
+        }
+    }
+}
+
+void ofDrawCircles(const oflike::ofVec2f* centers, const float* radii, size_t count,
+                   const oflike::ofColor* colors) {
+    if (!centers || !radii || count == 0) {
+        return;
+    }
+
+    auto& state = getGraphicsState();
+    auto& drawList = Context::instance().getDrawList();
+    const BulkColors color = bulkColors(state, colors);
+    const uint32_t n = static_cast<uint32_t>(count);
+
+    if (state.sdfShapesEnabled) {
+        const float strokeWidth = state.fillEnabled ? 0.0f : state.lineWidth;
+        uint32_t offset = 0;
+        render::ShapeInstance2D* shapes = drawList.allocateShapes(count, offset);
+        for (size_t i = 0; i < count; i++) {
+            render::ShapeInstance2D& shape = shapes[i];
+            shape = {};
+            shape.center = toFloat2(centers[i]);
+            shape.axis = simd_make_float2(1.0f, 0.0f);
+            shape.halfSize = simd_make_float2(radii[i], radii[i]);
+            shape.strokeWidth = strokeWidth;
+            shape.color = color[i];
+            shape.kind = render::ShapeKind2D::Ellipse;
+        }
+        submitBulkShapes(state, offset, n);
+        return;
+    }
+
+    const uint32_t resolution = state.circleResolution;
+    const auto& table = getCircleTable(state, resolution);
+
+    if (state.fillEnabled) {
+        // Fans share their perimeter vertices: center + resolution points each
+        const uint32_t perCircle = resolution + 1;
+        const simd_float2 half = simd_make_float2(0.5f, 0.5f);
+
+        uint32_t vtxOffset = 0;
+        render::Vertex2D* v = drawList.allocateVertices2D(count * perCircle, vtxOffset);
+        for (size_t c = 0; c < count; c++, v += perCircle) {
+            const simd_float2 center = toFloat2(centers[c]);
+            const float r = radii[c];
+            const simd_float4 col = color[c];
+            v[0] = render::Vertex2D(center, half, col);
+            for (uint32_t i = 0; i < resolution; i++) {
+                const simd_float2 p = table[i];
+                v[1 + i] = render::Vertex2D(center + r * p, half + half * p, col);
+            }
+        }
+
+        // The index pattern repeats per circle, offset by its first vertex
+        const uint32_t perIndex = resolution * 3;
+        uint32_t idxOffset = 0;
+        uint32_t* idx = drawList.allocateIndices(count * perIndex, idxOffset);
+        for (uint32_t c = 0; c < n; c++) {
+            const uint32_t base = c * perCircle;
+            for (uint32_t i = 0; i < resolution; i++, idx += 3) {
+                idx[0] = base;
+                idx[1] = base + 1 + i;
+                idx[2] = base + 1 + (i + 1) % resolution;
+            }
+        }
+
+        submitBulkGeometry(state, vtxOffset, n * perCircle, idxOffset, n * perIndex,
+                           render::PrimitiveType::Triangle);
+    } else if (state.lineWidth > 1.0f) {
+        const render::StrokeSegment2D style = strokeStyle(state);
+        simd_float2* points = drawList.allocateTransient<simd_float2>(resolution);
+        uint32_t offset = 0;
+        render::StrokeSegment2D* segments = drawList.allocateStrokeSegments(count * resolution, offset);
+        for (size_t c = 0; c < count; c++, segments += resolution) {
+            const simd_float2 center = toFloat2(centers[c]);
+            for (uint32_t i = 0; i < resolution; i++) {
+                points[i] = center + radii[c] * table[i];
+            }
+            writeClosedStroke(segments, points, resolution, style, color[c]);
+        }
+        submitBulkStroke(state, offset, n * resolution);
+    } else {
+        // Line list: two vertices per perimeter segment
+        const uint32_t perCircle = resolution * 2;
+        const simd_float2 zero = simd_make_float2(0.0f, 0.0f);
+
+        uint32_t vtxOffset = 0;
+        render::Vertex2D* v = drawList.allocateVertices2D(count * perCircle, vtxOffset);
+        for (size_t c = 0; c < count; c++) {
+            const simd_float2 center = toFloat2(centers[c]);
+            const float r = radii[c];
+            const simd_float4 col = color[c];
+            for (uint32_t i = 0; i < resolution; i++, v += 2) {
+                v[0] = render::Vertex2D(center + r * table[i], zero, col);
+                v[1] = render::Vertex2D(center + r * table[i + 1], zero, col);
+            }
+        }
+        submitBulkGeometry(state, vtxOffset, n * perCircle, 0, 0, render::PrimitiveType::Line);
+    }
+}
+
+void ofDrawRectangles(const oflike::ofVec2f* positions, const oflike::ofVec2f* sizes, size_t count,
+                      const oflike::ofColor* colors) {
+    if (!positions || !sizes || count == 0) {
+        return;
+    }
+
+    auto& state = getGraphicsState();
+    auto& drawList = Context::instance().getDrawList();
+    const BulkColors color = bulkColors(state, colors);
+    const uint32_t n = static_cast<uint32_t>(count);
+
+    // Corner order matches ofDrawRectangle: top-left, top-right, bottom-right, bottom-left
+    const simd_float2 corners[4] = {
+        simd_make_float2(0.0f, 0.0f), simd_make_float2(1.0f, 0.0f),
+        simd_make_float2(1.0f, 1.0f), simd_make_float2(0.0f, 1.0f)
+    };
+
+    if (state.fillEnabled) {
+        uint32_t vtxOffset = 0;
+        render::Vertex2D* v = drawList.allocateVertices2D(count * 4, vtxOffset);
+        for (size_t r = 0; r < count; r++, v += 4) {
+            const simd_float2 origin = toFloat2(positions[r]);
+            const simd_float2 size = toFloat2(sizes[r]);
+            const simd_float4 col = color[r];
+            for (int k = 0; k < 4; k++) {
+                v[k] = render::Vertex2D(origin + size * corners[k], corners[k], col);
+            }
+        }
+
+        uint32_t idxOffset = 0;
+        uint32_t* idx = drawList.allocateIndices(count * 6, idxOffset);
+        for (uint32_t r = 0; r < n; r++, idx += 6) {
+            const uint32_t base = r * 4;
+            idx[0] = base;
+            idx[1] = base + 1;
+            idx[2] = base + 2;
+            idx[3] = base;
+            idx[4] = base + 2;
+            idx[5] = base + 3;
+        }
+
+        submitBulkGeometry(state, vtxOffset, n * 4, idxOffset, n * 6, render::PrimitiveType::Triangle);
+    } else if (state.lineWidth > 1.0f) {
+        const render::StrokeSegment2D style = strokeStyle(state);
+        uint32_t offset = 0;
+        render::StrokeSegment2D* segments = drawList.allocateStrokeSegments(count * 4, offset);
+        for (size_t r = 0; r < count; r++, segments += 4) {
+            const simd_float2 origin = toFloat2(positions[r]);
+            const simd_float2 size = toFloat2(sizes[r]);
+            simd_float2 points[4];
+            for (int k = 0; k < 4; k++) {
+                points[k] = origin + size * corners[k];
+            }
+            writeClosedStroke(segments, points, 4, style, color[r]);
+        }
+        submitBulkStroke(state, offset, n * 4);
+    } else {
+        const simd_float2 zero = simd_make_float2(0.0f, 0.0f);
+        uint32_t vtxOffset = 0;
+        render::Vertex2D* v = drawList.allocateVertices2D(count * 8, vtxOffset);
+        for (size_t r = 0; r < count; r++) {
+            const simd_float2 origin = toFloat2(positions[r]);
+            const simd_float2 size = toFloat2(sizes[r]);
+            const simd_float4 col = color[r];
+            for (int k = 0; k < 4; k++, v += 2) {
+                v[0] = render::Vertex2D(origin + size * corners[k], zero, col);
+                v[1] = render::Vertex2D(origin + size * corners[(k + 1) % 4], zero, col);
+            }
+        }
+        submitBulkGeometry(state, vtxOffset, n * 8, 0, 0, render::PrimitiveType::Line);
+    }
+}
+
+void ofDrawLines(const oflike::ofVec2f* starts, const oflike::ofVec2f* ends, size_t count,
+                 const oflike::ofColor* colors) {
+    if (!starts || !ends || count == 0) {
+        return;
+    }
+
+    auto& state = getGraphicsState();
+    auto& drawList = Context::instance().getDrawList();
+    const BulkColors color = bulkColors(state, colors);
+
+    if (state.lineWidth <= 1.0f) {
+        const simd_float2 zero = simd_make_float2(0.0f, 0.0f);
+        uint32_t vtxOffset = 0;
+        render::Vertex2D* v = drawList.allocateVertices2D(count * 2, vtxOffset);
+        for (size_t i = 0; i < count; i++, v += 2) {
+            const simd_float4 col = color[i];
+            v[0] = render::Vertex2D(toFloat2(starts[i]), zero, col);
+            v[1] = render::Vertex2D(toFloat2(ends[i]), zero, col);
+        }
+        submitBulkGeometry(state, vtxOffset, static_cast<uint32_t>(count * 2), 0, 0,
+                           render::PrimitiveType::Line);
+        return;
+    }
+
+    // Zero-length segments have no direction; skip them like ofDrawLine does
+    uint32_t drawable = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!simd_equal(toFloat2(starts[i]), toFloat2(ends[i]))) {
+            drawable++;
+        }
+    }
+    if (drawable == 0) {
+        return;
+    }
+
+    if (state.sdfShapesEnabled) {
+        const float halfWidth = state.lineWidth * 0.5f;
+        uint32_t offset = 0;
+        render::ShapeInstance2D* shapes = drawList.allocateShapes(drawable, offset);
+        for (size_t i = 0; i < count; i++) {
+            const simd_float2 p1 = toFloat2(starts[i]);
+            const simd_float2 p2 = toFloat2(ends[i]);
+            if (simd_equal(p1, p2)) {
+                continue;
+            }
+            const float length = simd_length(p2 - p1);
+            render::ShapeInstance2D& shape = *shapes++;
+            shape = {};
+            shape.center = (p1 + p2) * 0.5f;
+            shape.axis = (p2 - p1) / length;
+            shape.halfSize = simd_make_float2(length * 0.5f, halfWidth);
+            shape.color = color[i];
+            shape.kind = render::ShapeKind2D::RoundedRect;
+        }
+        submitBulkShapes(state, offset, drawable);
+        return;
+    }
+
+    const render::StrokeSegment2D style = strokeStyle(state);
+    uint32_t offset = 0;
+    render::StrokeSegment2D* segments = drawList.allocateStrokeSegments(drawable, offset);
+    for (size_t i = 0; i < count; i++) {
+        const simd_float2 p1 = toFloat2(starts[i]);
+        const simd_float2 p2 = toFloat2(ends[i]);
+        if (simd_equal(p1, p2)) {
+            continue;
+        }
+        render::StrokeSegment2D& segment = *segments++;
+        segment = style;
+        segment.p0 = p1;
+        segment.p1 = p2;
+        segment.next = p2;
+        segment.color = color[i];
+    }
+    submitBulkStroke(state, offset, drawable);
+}
+
+void ofDrawPolylines(const oflike::ofPolyline* polylines, size_t count, const oflike::ofColor* colors) {
+    if (!polylines || count == 0) {
+        return;
+    }
+
+    auto& state = getGraphicsState();
+    auto& drawList = Context::instance().getDrawList();
+    const BulkColors color = bulkColors(state, colors);
+
+    if (state.lineWidth <= 1.0f) {
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+        for (size_t i = 0; i < count; i++) {
+            const size_t n = polylines[i].size();
+            if (n >= 2) {
+                vertexCount += n;
+                indexCount += polylineIndexCount(n, polylines[i].isClosed());
+            }
+        }
+        if (vertexCount == 0) {
+            return;
+        }
+
+        auto geometry = drawList.allocateGeometry2D(vertexCount, indexCount);
+        render::Vertex2D* v = geometry.vertices;
+        uint32_t* idx = geometry.indices;
+        uint32_t base = 0;
+        for (size_t i = 0; i < count; i++) {
+            const auto& points = polylines[i].getVertices();
+            const size_t n = points.size();
+            if (n < 2) {
+                continue;
+            }
+            const bool closed = polylines[i].isClosed();
+            writePolylineLines(v, idx, base, points.data(), n, closed, color[i]);
+            v += n;
+            idx += polylineIndexCount(n, closed);
+            base += static_cast<uint32_t>(n);
+        }
+        submitBulkGeometry(state, geometry.vertexOffset, static_cast<uint32_t>(vertexCount),
+                           geometry.indexOffset, static_cast<uint32_t>(indexCount),
+                           render::PrimitiveType::Line);
+        return;
+    }
+
+    // Wide: every polyline's stroke segments as one stroke draw
+    render::StrokeSegment2D style = strokeStyle(state);
+    auto& segments = state.strokeSegments;
+    segments.clear();
+    for (size_t i = 0; i < count; i++) {
+        const auto& points = polylines[i].getVertices();
+        style.color = color[i];
+        appendStrokeSegments(segments, points.data(), points.size(), polylines[i].isClosed(), style);
+    }
+    if (segments.empty()) {
+        return;
+    }
+    const uint32_t offset = drawList.addStrokeSegments(segments.data(), segments.size());
+    submitBulkStroke(state, offset, static_cast<uint32_t>(segments.size()));
+}
+
+void ofDrawTriangles(const oflike::ofVec3f* vertices, size_t vertexCount,
+                     const uint32_t* indices, size_t indexCount) {
+    if (!vertices || !indices || vertexCount == 0 || indexCount < 3) {
+        return;
+    }
+
+    auto& state = getGraphicsState();
+    auto& drawList = Context::instance().getDrawList();
+    const simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
+                                            state.currentColor[2], state.currentColor[3]);
+    const simd_float2 zero = simd_make_float2(0.0f, 0.0f);
+
+    uint32_t vtxOffset = 0;
+    render::Vertex2D* v = drawList.allocateVertices2D(vertexCount, vtxOffset);
+    for (size_t i = 0; i < vertexCount; i++) {
+        v[i] = render::Vertex2D(simd_make_float2(vertices[i].x, vertices[i].y), zero, color);
+    }
+    const size_t triangleIndices = indexCount - indexCount % 3;
+    uint32_t idxOffset = 0;
+    uint32_t* idx = drawList.allocateIndices(triangleIndices, idxOffset);
+    std::memcpy(idx, indices, triangleIndices * sizeof(uint32_t));
+
+    submitBulkGeometry(state, vtxOffset, static_cast<uint32_t>(vertexCount), idxOffset,
+                       static_cast<uint32_t>(triangleIndices), render::PrimitiveType::Triangle);
+}
+
+void ofDrawPathFill(const oflike::ofPolyline* contours, size_t count, ofPolyWindingMode mode) {
+    if (!contours || count == 0) {
+        return;
+    }
+
+    // One edge per contour point, the last closing the contour
+    size_t edgeCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (contours[i].size() >= 3) {
+            edgeCount += contours[i].size();
+        }
+    }
+    if (edgeCount == 0) {
+        return;
+    }
+
+    auto& state = getGraphicsState();
+    auto& drawList = Context::instance().getDrawList();
+
+    uint32_t segmentOffset = 0;
+    render::PathSegment2D* edge = drawList.allocatePathSegments(edgeCount, segmentOffset);
+    simd_float2 lo = simd_make_float2(FLT_MAX, FLT_MAX);
+    simd_float2 hi = simd_make_float2(-FLT_MAX, -FLT_MAX);
+    for (size_t i = 0; i < count; i++) {
+        const auto& points = contours[i].getVertices();
+        const size_t n = points.size();
+        if (n < 3) {
+            continue;
+        }
+        simd_float2 previous = simd_make_float2(points[n - 1].x, points[n - 1].y);
+        for (size_t j = 0; j < n; j++) {
+            const simd_float2 p = simd_make_float2(points[j].x, points[j].y);
+            edge->p0 = previous;
+            edge->p1 = p;
+            edge++;
+            lo = simd_min(lo, p);
+            hi = simd_max(hi, p);
+            previous = p;
+        }
+    }
+
+    render::PathInstance2D path = {};
+    path.boundsMin = lo;
+    path.boundsMax = hi;
+    path.color = colorToFloat4(state.currentColor[0], state.currentColor[1],
+                               state.currentColor[2], state.currentColor[3]);
+    path.segmentOffset = segmentOffset;
+    path.segmentCount = static_cast<uint32_t>(edgeCount);
+    path.fillRule = static_cast<uint32_t>(mode);
+
+    render::DrawCommand2DPaths cmd;
+    cmd.pathOffset = drawList.addPaths(&path, 1);
+    cmd.pathCount = 1;
+    cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
+    cmd.transform = getModelMatrix(state);
+
+    drawList.addCommand(cmd);
+}
+
+// ============================================================================
+// Curve Drawing
+// ============================================================================
+
+/**
+ * Evaluate Catmull-Rom spline at parameter t.
+ * Formula: P(t) = 0.5 * [2*P1 + (-P0 + P2)*t + (2*P0 - 5*P1 + 4*P2 - P3)*t^2 + (-P0 + 3*P1 - 3*P2 + P3)*t^3]
+ */
+namespace {
+    float catmullRomInterpolate(float p0, float p1, float p2, float p3, float t) {
+        float t2 = t * t;
+        float t3 = t2 * t;
+
+        return 0.5f * (
+            2.0f * p1 +
+            (-p0 + p2) * t +
+            (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
+            (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t3
+        );
+    }
+}
 
-        float x = catmullRomInterpolate(x0, x1, x2, x3, t);
-        float y = catmullRomInterpolate(y0, y1, y2, y3, t);
-        float z = catmullRomInterpolate(z0, z1, z2, z3, t);
+void ofDrawCurve(float x0, float y0, float x1, float y1, float x2, float y2, float x3, float y3) {
+    ofDrawCurve(x0, y0, 0.0f, x1, y1, 0.0f, x2, y2, 0.0f, x3, y3, 0.0f);
+}
 
-        ofDrawLine(prevX, prevY, prevZ, x, y, z);
+void ofDrawCurve(float x0, float y0, float z0, float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3) {
+    auto& state = getGraphicsState();
+    const uint32_t resolution = ofGetCurveSegments(oflike::ofVec3f(x0, y0, z0), oflike::ofVec3f(x1, y1, z1),
+                                                   oflike::ofVec3f(x2, y2, z2), oflike::ofVec3f(x3, y3, z3));
 
-        prevX = x;
-        prevY = y;
-        prevZ = z;
+    // Draw curve as one polyline
+    auto& points = state.curvePoints;
+    points.clear();
+    points.emplace_back(x1, y1, z1);
+    for (uint32_t i = 1; i <= resolution; i++) {
+        float t = static_cast<float>(i) / resolution;
+        points.emplace_back(catmullRomInterpolate(x0, x1, x2, x3, t),
+                            catmullRomInterpolate(y0, y1, y2, y3, t),
+                            catmullRomInterpolate(z0, z1, z2, z3, t));
     }
+    ofDrawPolyline(points.data(), points.size(), false);
 }
 
 /**
@@ -902,30 +1734,118 @@ void ofDrawBezier(float x0, float y0, float x1, float y1, float x2, float y2, fl
 
 void ofDrawBezier(float x0, float y0, float z0, float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3) {
     auto& state = getGraphicsState();
-    uint32_t resolution = state.curveResolution;
-
-    // Draw Bezier curve as a series of line segments
-    float prevX = x0, prevY = y0, prevZ = z0;
+    const uint32_t resolution = ofGetBezierSegments(oflike::ofVec3f(x0, y0, z0), oflike::ofVec3f(x1, y1, z1),
+                                                    oflike::ofVec3f(x2, y2, z2), oflike::ofVec3f(x3, y3, z3));
 
+    // Draw Bezier curve as one polyline
+    auto& points = state.curvePoints;
+    points.clear();
+    points.emplace_back(x0, y0, z0);
     for (uint32_t i = 1; i <= resolution; i++) {
         float t = static_cast<float>(i) / resolution;
-
-        float x = bezierInterpolate(x0, x1, x2, x3, t);
-        float y = bezierInterpolate(y0, y1, y2, y3, t);
-        float z = bezierInterpolate(z0, z1, z2, z3, t);
-
-        ofDrawLine(prevX, prevY, prevZ, x, y, z);
-
-        prevX = x;
-        prevY = y;
-        prevZ = z;
+        points.emplace_back(bezierInterpolate(x0, x1, x2, x3, t),
+                            bezierInterpolate(y0, y1, y2, y3, t),
+                            bezierInterpolate(z0, z1, z2, z3, t));
     }
+    ofDrawPolyline(points.data(), points.size(), false);
 }
 
 // ============================================================================
 // Shape API (Immediate Mode)
 // ============================================================================
 
+namespace {
+    // Static shapes repeat every frame; more distinct shapes than this means
+    // the sketch animates them, so drop the lot rather than grow without bound
+    constexpr size_t kMaxCachedShapes = 256;
+
+    // Everything that decides the tessellation: contours (positions and
+    // vertex kinds), close flag, winding rule and curve flattening resolution
+    void buildShapeKey(const GraphicsState& state, bool close, std::vector<float>& key) {
+        key.clear();
+        key.push_back(close ? 1.0f : 0.0f);
+        key.push_back(static_cast<float>(state.polyWindingMode));
+        key.push_back(static_cast<float>(state.curveResolution));
+        key.push_back(state.curveTolerance);
+        key.push_back(state.curveTolerance > 0.0f ? curveScale(state) : 0.0f);
+        for (const auto& contour : state.shapeContours) {
+            key.push_back(static_cast<float>(contour.size()));
+            for (const auto& vertex : contour) {
+                key.push_back(vertex.position.x);
+                key.push_back(vertex.position.y);
+                key.push_back(vertex.position.z);
+                key.push_back(static_cast<float>(vertex.type));
+            }
+        }
+    }
+
+    // FNV-1a over the key's bytes
+    uint64_t hashShapeKey(const std::vector<float>& key) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(key.data());
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < key.size() * sizeof(float); i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Cached fill for the shape being ended, tessellating path on a miss
+    const ShapeTessellation& getShapeTessellation(GraphicsState& state, const oflike::ofPath& path, bool close) {
+        buildShapeKey(state, close, state.shapeKey);
+        const uint64_t hash = hashShapeKey(state.shapeKey);
+
+        auto it = state.shapeCache.find(hash);
+        if (it != state.shapeCache.end() && it->second.key.size() == state.shapeKey.size() &&
+            std::memcmp(it->second.key.data(), state.shapeKey.data(),
+                        state.shapeKey.size() * sizeof(float)) == 0) {
+            return it->second;
+        }
+
+        if (state.shapeCache.size() >= kMaxCachedShapes) {
+            state.shapeCache.clear();
+        }
+
+        std::vector<oflike::ofVec3f> vertices;
+        ShapeTessellation entry;
+        entry.key = state.shapeKey;
+        path.getTessellation(vertices, entry.indices);
+        entry.vertices.reserve(vertices.size());
+        for (const auto& v : vertices) {
+            entry.vertices.push_back(simd_make_float2(v.x, v.y));
+        }
+
+        // A colliding entry is replaced; the key check above keeps hits exact
+        ShapeTessellation& slot = state.shapeCache[hash];
+        slot = std::move(entry);
+        return slot;
+    }
+
+    // One indexed command for a cached fill in the current color
+    void submitShapeFill(GraphicsState& state, const ShapeTessellation& fill) {
+        if (fill.indices.empty()) {
+            return;
+        }
+
+        auto& drawList = Context::instance().getDrawList();
+        const simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
+                                                state.currentColor[2], state.currentColor[3]);
+        const simd_float2 zero = simd_make_float2(0.0f, 0.0f);
+
+        uint32_t vtxOffset = 0;
+        render::Vertex2D* v = drawList.allocateVertices2D(fill.vertices.size(), vtxOffset);
+        for (size_t i = 0; i < fill.vertices.size(); i++) {
+            v[i] = render::Vertex2D(fill.vertices[i], zero, color);
+        }
+        uint32_t idxOffset = 0;
+        uint32_t* idx = drawList.allocateIndices(fill.indices.size(), idxOffset);
+        std::memcpy(idx, fill.indices.data(), fill.indices.size() * sizeof(uint32_t));
+
+        submitBulkGeometry(state, vtxOffset, static_cast<uint32_t>(fill.vertices.size()),
+                           idxOffset, static_cast<uint32_t>(fill.indices.size()),
+                           render::PrimitiveType::Triangle);
+    }
+}
+
 void ofBeginShape() {
     auto& state = getGraphicsState();
 
@@ -962,6 +1882,7 @@ void ofEndShape(bool close) {
     path.setStrokeWidth(state.lineWidth);
     path.setColor(state.currentColor[0], state.currentColor[1],
                   state.currentColor[2], state.currentColor[3]);
+    path.setPolyWindingMode(static_cast<ofPolyWindingMode>(state.polyWindingMode));
 
     // Process each contour
     for (size_t contourIdx = 0; contourIdx < state.shapeContours.size(); ++contourIdx) {
@@ -1029,6 +1950,13 @@ void ofEndShape(bool close) {
         }
     }
 
+    // Cached fill: reuse (or record) the tessellation, leaving the path
+    // to draw only its outline
+    if (state.shapeCacheEnabled && state.fillEnabled) {
+        submitShapeFill(state, getShapeTessellation(state, path, close));
+        path.setFilled(false);
+    }
+
     // Draw the completed path
     path.draw();
 
@@ -1120,6 +2048,32 @@ void ofNextContour() {
     }
 }
 
+void ofSetPolyMode(ofPolyWindingMode mode) {
+    getGraphicsState().polyWindingMode = mode;
+}
+
+ofPolyWindingMode ofGetPolyMode() {
+    return static_cast<ofPolyWindingMode>(getGraphicsState().polyWindingMode);
+}
+
+void ofEnableShapeCache() {
+    getGraphicsState().shapeCacheEnabled = true;
+}
+
+void ofDisableShapeCache() {
+    auto& state = getGraphicsState();
+    state.shapeCacheEnabled = false;
+    state.shapeCache.clear();
+}
+
+bool ofGetShapeCacheEnabled() {
+    return getGraphicsState().shapeCacheEnabled;
+}
+
+void ofClearShapeCache() {
+    getGraphicsState().shapeCache.clear();
+}
+
 // ============================================================================
 // Blend Mode
 // ============================================================================
@@ -1155,304 +2109,626 @@ void ofEnableBlendMode(int blendMode) {
 // 3D Primitives Implementation
 // ============================================================================
 
-void ofDrawBox(float x, float y, float z, float size) {
-    ofDrawBox(x, y, z, size, size, size);
-}
-
-void ofDrawBox(float x, float y, float z, float width, float height, float depth) {
+// Helper function to submit 3D geometry already in the DrawList (written in
+// place, see DrawList::allocateGeometry3D)
+static void submit3DGeometry(uint32_t vtxOffset, uint32_t vertexCount, uint32_t idxOffset, uint32_t indexCount,
+                             render::PrimitiveType primitive = render::PrimitiveType::Triangle) {
     auto& state = getGraphicsState();
+    auto& drawList = Context::instance().getDrawList();
 
-    float hw = width / 2.0f;
-    float hh = height / 2.0f;
-    float hd = depth / 2.0f;
+    render::DrawCommand3D cmd;
+    cmd.vertexOffset = vtxOffset;
+    cmd.vertexCount = vertexCount;
+    cmd.indexOffset = idxOffset;
+    cmd.indexCount = indexCount;
+    cmd.primitiveType = primitive;
+    cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
+    cmd.texture = nullptr;
 
-    simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
-                                       state.currentColor[2], state.currentColor[3]);
+    // Cached view * model; rebuilt only after the stack or camera changed
+    cmd.modelViewMatrix = getModelViewMatrix(state);
+    cmd.projectionMatrix = Context::instance().getProjectionMatrix();
 
-    // Box has 6 faces, each with 4 vertices (24 vertices total for proper normals)
-    // Each face has 2 triangles (6 indices per face, 36 indices total)
-
-    std::vector<render::Vertex3D> vertices;
-    std::vector<uint32_t> indices;
-    vertices.reserve(24);
-    indices.reserve(36);
-
-    auto addFace = [&](simd_float3 p0, simd_float3 p1, simd_float3 p2, simd_float3 p3, simd_float3 normal) {
-        uint32_t baseIdx = static_cast<uint32_t>(vertices.size());
-
-        // Add 4 vertices for this face
-        vertices.push_back(render::Vertex3D(p0.x, p0.y, p0.z, normal.x, normal.y, normal.z, 0, 0, color.x, color.y, color.z, color.w));
-        vertices.push_back(render::Vertex3D(p1.x, p1.y, p1.z, normal.x, normal.y, normal.z, 1, 0, color.x, color.y, color.z, color.w));
-        vertices.push_back(render::Vertex3D(p2.x, p2.y, p2.z, normal.x, normal.y, normal.z, 1, 1, color.x, color.y, color.z, color.w));
-        vertices.push_back(render::Vertex3D(p3.x, p3.y, p3.z, normal.x, normal.y, normal.z, 0, 1, color.x, color.y, color.z, color.w));
-
-        // Add 6 indices for 2 triangles (CCW winding)
-        indices.push_back(baseIdx + 0);
-        indices.push_back(baseIdx + 1);
-        indices.push_back(baseIdx + 2);
-        indices.push_back(baseIdx + 0);
-        indices.push_back(baseIdx + 2);
-        indices.push_back(baseIdx + 3);
-    };
+    cmd.depthTestEnabled = state.depthTestEnabled;
+    cmd.depthWriteEnabled = state.depthWriteEnabled;
+    cmd.cullBackFace = state.cullingEnabled;
+    cmd.orderIndependent = cmd.blendMode == render::BlendMode::Alpha && state.orderIndependentTransparency;
+    cmd.objectId = state.objectId;
 
-    // Define box corners (centered at x, y, z)
-    // Front face (z+)
-    addFace(simd_make_float3(x - hw, y - hh, z + hd),
-            simd_make_float3(x + hw, y - hh, z + hd),
-            simd_make_float3(x + hw, y + hh, z + hd),
-            simd_make_float3(x - hw, y + hh, z + hd),
-            simd_make_float3(0, 0, 1));
-
-    // Back face (z-)
-    addFace(simd_make_float3(x + hw, y - hh, z - hd),
-            simd_make_float3(x - hw, y - hh, z - hd),
-            simd_make_float3(x - hw, y + hh, z - hd),
-            simd_make_float3(x + hw, y + hh, z - hd),
-            simd_make_float3(0, 0, -1));
-
-    // Top face (y+)
-    addFace(simd_make_float3(x - hw, y + hh, z + hd),
-            simd_make_float3(x + hw, y + hh, z + hd),
-            simd_make_float3(x + hw, y + hh, z - hd),
-            simd_make_float3(x - hw, y + hh, z - hd),
-            simd_make_float3(0, 1, 0));
-
-    // Bottom face (y-)
-    addFace(simd_make_float3(x - hw, y - hh, z - hd),
-            simd_make_float3(x + hw, y - hh, z - hd),
-            simd_make_float3(x + hw, y - hh, z + hd),
-            simd_make_float3(x - hw, y - hh, z + hd),
-            simd_make_float3(0, -1, 0));
-
-    // Right face (x+)
-    addFace(simd_make_float3(x + hw, y - hh, z + hd),
-            simd_make_float3(x + hw, y - hh, z - hd),
-            simd_make_float3(x + hw, y + hh, z - hd),
-            simd_make_float3(x + hw, y + hh, z + hd),
-            simd_make_float3(1, 0, 0));
-
-    // Left face (x-)
-    addFace(simd_make_float3(x - hw, y - hh, z - hd),
-            simd_make_float3(x - hw, y - hh, z + hd),
-            simd_make_float3(x - hw, y + hh, z + hd),
-            simd_make_float3(x - hw, y + hh, z - hd),
-            simd_make_float3(-1, 0, 0));
+    // Capture lighting state at command creation time; only lit draws need
+    // a normal matrix (unlit ones keep identity, which also batches better).
+    // Lines and points have no surface to light.
+    Context& ctx = Context::instance();
+    cmd.useLighting = primitive == render::PrimitiveType::Triangle &&
+                      ctx.hasMaterial() && ctx.isLightingEnabled();
+    if (cmd.useLighting) {
+        cmd.lightingHandle = ctx.getLightingStateHandle();
+        cmd.normalMatrix = getNormalMatrix(state);
+    }
 
-    if (state.fillEnabled) {
-        // Add vertices and indices to DrawList
-        auto& drawList = Context::instance().getDrawList();
-        uint32_t vtxOffset = drawList.addVertices3D(vertices.data(), vertices.size());
-        uint32_t idxOffset = drawList.addIndices(indices.data(), indices.size());
+    drawList.addCommand(cmd);
+}
 
-        // Create 3D draw command
-        render::DrawCommand3D cmd;
-        cmd.vertexOffset = vtxOffset;
-        cmd.vertexCount = static_cast<uint32_t>(vertices.size());
-        cmd.indexOffset = idxOffset;
-        cmd.indexCount = static_cast<uint32_t>(indices.size());
-        cmd.primitiveType = render::PrimitiveType::Triangle;
-        cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
-        cmd.texture = nullptr;
+// Helper function to submit 3D geometry built on the CPU
+static void submit3DGeometry(const std::vector<render::Vertex3D>& vertices,
+                             const std::vector<uint32_t>& indices,
+                             render::PrimitiveType primitive = render::PrimitiveType::Triangle) {
+    auto& drawList = Context::instance().getDrawList();
+    uint32_t vtxOffset = drawList.addVertices3D(vertices.data(), vertices.size());
+    uint32_t idxOffset = drawList.addIndices(indices.data(), indices.size());
+    submit3DGeometry(vtxOffset, static_cast<uint32_t>(vertices.size()), idxOffset,
+                     static_cast<uint32_t>(indices.size()), primitive);
+}
 
-        // Get view matrix from Context (set by camera)
-        simd_float4x4 viewMatrix = Context::instance().getViewMatrix();
+// ============================================================================
+// Unit Primitive Cache
+// ============================================================================
 
-        // Model matrix from current transform
-        auto& m = state.currentMatrix;
-        simd_float4x4 modelMatrix = simd_matrix(
-            simd_make_float4(m(0,0), m(1,0), m(2,0), m(3,0)),
-            simd_make_float4(m(0,1), m(1,1), m(2,1), m(3,1)),
-            simd_make_float4(m(0,2), m(1,2), m(2,2), m(3,2)),
-            simd_make_float4(m(0,3), m(1,3), m(2,3), m(3,3))
-        );
+// Filled primitives are tessellated once per resolution at unit size in white,
+// recorded into each frame's DrawList once, and drawn as one instance each
+// (size/position/color in the InstanceData), so consecutive calls merge into a
+// single instanced draw in DrawList::optimize(). Where the renderer has mesh
+// shaders, spheres, cylinders and icospheres skip the tessellation and are
+// generated on the GPU instead (DrawMeshPrimitivesCommand).
 
-        // ModelView = View * Model
-        cmd.modelViewMatrix = simd_mul(viewMatrix, modelMatrix);
+namespace {
+    enum class UnitPrimitive : uint8_t {
+        Box,
+        Sphere,
+        Cone,
+        Cylinder,
+        IcoSphere
+    };
 
-        // Projection matrix from Context (set by camera)
-        cmd.projectionMatrix = Context::instance().getProjectionMatrix();
+    struct UnitGeometry {
+        std::vector<render::Vertex3D> vertices;
+        std::vector<uint32_t> indices;
 
-        // Normal matrix (upper-left 3x3 of modelView)
-        cmd.normalMatrix = simd_matrix(
-            simd_make_float3(cmd.modelViewMatrix.columns[0].x, cmd.modelViewMatrix.columns[0].y, cmd.modelViewMatrix.columns[0].z),
-            simd_make_float3(cmd.modelViewMatrix.columns[1].x, cmd.modelViewMatrix.columns[1].y, cmd.modelViewMatrix.columns[1].z),
-            simd_make_float3(cmd.modelViewMatrix.columns[2].x, cmd.modelViewMatrix.columns[2].y, cmd.modelViewMatrix.columns[2].z)
-        );
+        // Where the geometry was last recorded; re-recorded after the list resets
+        const render::DrawList* list = nullptr;
+        uint64_t generation = 0;
+        uint32_t vertexOffset = 0;
+        uint32_t indexOffset = 0;
+    };
 
-        cmd.depthTestEnabled = state.depthTestEnabled;
-        cmd.depthWriteEnabled = state.depthWriteEnabled;
-        cmd.cullBackFace = state.cullingEnabled;
-
-        // Capture lighting state at command creation time
-        Context& ctx = Context::instance();
-        cmd.useLighting = ctx.hasMaterial() && ctx.isLightingEnabled();
-        if (cmd.useLighting) {
-            cmd.lightCount = ctx.getLightCount();
-            auto matData = ctx.getMaterialData();
-            size_t matSize = std::min(matData.size(), size_t(16));
-            for (size_t i = 0; i < matSize; ++i) {
-                cmd.materialData[i] = matData[i];
-            }
-            auto lightData = ctx.getAllLightData();
-            size_t lightSize = std::min(lightData.size(), size_t(256));
-            for (size_t i = 0; i < lightSize; ++i) {
-                cmd.lightData[i] = lightData[i];
-            }
+    // Cones encode their slope in the normals, so each radius/height ratio is
+    // its own entry; the cache is dropped whenever it grows past this
+    constexpr size_t kMaxUnitPrimitives = 64;
+
+    // Per thread, like GraphicsState, since offsets refer to the thread's DrawList
+    std::map<uint64_t, UnitGeometry>& getUnitPrimitiveCache() {
+        thread_local std::map<uint64_t, UnitGeometry> cache;
+        return cache;
+    }
+
+    uint64_t unitPrimitiveKey(UnitPrimitive type, uint32_t resolution, uint32_t variant = 0) {
+        return (static_cast<uint64_t>(type) << 56) |
+               (static_cast<uint64_t>(resolution & 0xFFFFFF) << 32) |
+               variant;
+    }
+
+    const simd_float4 kUnitColor = simd_make_float4(1.0f, 1.0f, 1.0f, 1.0f);
+
+    // Unit cube centered at the origin (side 1), 24 vertices for flat normals
+    void buildUnitBox(UnitGeometry& unit) {
+        auto& vertices = unit.vertices;
+        auto& indices = unit.indices;
+        const simd_float4 color = kUnitColor;
+        vertices.reserve(24);
+        indices.reserve(36);
+
+        auto addFace = [&](simd_float3 p0, simd_float3 p1, simd_float3 p2, simd_float3 p3, simd_float3 normal) {
+            uint32_t baseIdx = static_cast<uint32_t>(vertices.size());
+
+            // Add 4 vertices for this face
+            vertices.push_back(render::Vertex3D(p0.x, p0.y, p0.z, normal.x, normal.y, normal.z, 0, 0, color.x, color.y, color.z, color.w));
+            vertices.push_back(render::Vertex3D(p1.x, p1.y, p1.z, normal.x, normal.y, normal.z, 1, 0, color.x, color.y, color.z, color.w));
+            vertices.push_back(render::Vertex3D(p2.x, p2.y, p2.z, normal.x, normal.y, normal.z, 1, 1, color.x, color.y, color.z, color.w));
+            vertices.push_back(render::Vertex3D(p3.x, p3.y, p3.z, normal.x, normal.y, normal.z, 0, 1, color.x, color.y, color.z, color.w));
+
+            // Add 6 indices for 2 triangles (CCW winding)
+            indices.push_back(baseIdx + 0);
+            indices.push_back(baseIdx + 1);
+            indices.push_back(baseIdx + 2);
+            indices.push_back(baseIdx + 0);
+            indices.push_back(baseIdx + 2);
+            indices.push_back(baseIdx + 3);
+        };
+
+        const float h = 0.5f;
+
+        // Front face (z+)
+        addFace(simd_make_float3(-h, -h,  h), simd_make_float3( h, -h,  h),
+                simd_make_float3( h,  h,  h), simd_make_float3(-h,  h,  h),
+                simd_make_float3(0, 0, 1));
+
+        // Back face (z-)
+        addFace(simd_make_float3( h, -h, -h), simd_make_float3(-h, -h, -h),
+                simd_make_float3(-h,  h, -h), simd_make_float3( h,  h, -h),
+                simd_make_float3(0, 0, -1));
+
+        // Top face (y+)
+        addFace(simd_make_float3(-h,  h,  h), simd_make_float3( h,  h,  h),
+                simd_make_float3( h,  h, -h), simd_make_float3(-h,  h, -h),
+                simd_make_float3(0, 1, 0));
+
+        // Bottom face (y-)
+        addFace(simd_make_float3(-h, -h, -h), simd_make_float3( h, -h, -h),
+                simd_make_float3( h, -h,  h), simd_make_float3(-h, -h,  h),
+                simd_make_float3(0, -1, 0));
+
+        // Right face (x+)
+        addFace(simd_make_float3( h, -h,  h), simd_make_float3( h, -h, -h),
+                simd_make_float3( h,  h, -h), simd_make_float3( h,  h,  h),
+                simd_make_float3(1, 0, 0));
+
+        // Left face (x-)
+        addFace(simd_make_float3(-h, -h, -h), simd_make_float3(-h, -h,  h),
+                simd_make_float3(-h,  h,  h), simd_make_float3(-h,  h, -h),
+                simd_make_float3(-1, 0, 0));
+    }
+
+    // Unit UV sphere (radius 1): latitude rings x longitude segments
+    void buildUnitSphere(UnitGeometry& unit, uint32_t resolution) {
+        auto& vertices = unit.vertices;
+        auto& indices = unit.indices;
+        const simd_float4 color = kUnitColor;
+
+        uint32_t latSegments = resolution;
+        uint32_t lonSegments = resolution * 2;
+        vertices.reserve((latSegments + 1) * (lonSegments + 1));
+        indices.reserve(latSegments * lonSegments * 6);
+
+        // Generate vertices
+        for (uint32_t lat = 0; lat <= latSegments; ++lat) {
+            float theta = lat * M_PI / latSegments;  // 0 to PI
+            float sinTheta = std::sin(theta);
+            float cosTheta = std::cos(theta);
+
+            for (uint32_t lon = 0; lon <= lonSegments; ++lon) {
+                float phi = lon * 2.0f * M_PI / lonSegments;  // 0 to 2*PI
+                float sinPhi = std::sin(phi);
+                float cosPhi = std::cos(phi);
+
+                // Normal and position coincide on the unit sphere
+                float nx = sinTheta * cosPhi;
+                float ny = cosTheta;
+                float nz = sinTheta * sinPhi;
+
+                // UV coordinates
+                float u = (float)lon / lonSegments;
+                float v = (float)lat / latSegments;
+
+                vertices.push_back(render::Vertex3D(nx, ny, nz, nx, ny, nz, u, v,
+                                                     color.x, color.y, color.z, color.w));
+            }
         }
 
-        drawList.addCommand(cmd);
-    } else {
-        // Wireframe mode: draw 12 edges
-        ofDrawLine(x - hw, y - hh, z + hd, x + hw, y - hh, z + hd);
-        ofDrawLine(x + hw, y - hh, z + hd, x + hw, y + hh, z + hd);
-        ofDrawLine(x + hw, y + hh, z + hd, x - hw, y + hh, z + hd);
-        ofDrawLine(x - hw, y + hh, z + hd, x - hw, y - hh, z + hd);
+        // Generate indices
+        for (uint32_t lat = 0; lat < latSegments; ++lat) {
+            for (uint32_t lon = 0; lon < lonSegments; ++lon) {
+                uint32_t first = lat * (lonSegments + 1) + lon;
+                uint32_t second = first + lonSegments + 1;
 
-        ofDrawLine(x - hw, y - hh, z - hd, x + hw, y - hh, z - hd);
-        ofDrawLine(x + hw, y - hh, z - hd, x + hw, y + hh, z - hd);
-        ofDrawLine(x + hw, y + hh, z - hd, x - hw, y + hh, z - hd);
-        ofDrawLine(x - hw, y + hh, z - hd, x - hw, y - hh, z - hd);
+                // Two triangles per quad
+                indices.push_back(first);
+                indices.push_back(second);
+                indices.push_back(first + 1);
 
-        ofDrawLine(x - hw, y - hh, z + hd, x - hw, y - hh, z - hd);
-        ofDrawLine(x + hw, y - hh, z + hd, x + hw, y - hh, z - hd);
-        ofDrawLine(x + hw, y + hh, z + hd, x + hw, y + hh, z - hd);
-        ofDrawLine(x - hw, y + hh, z + hd, x - hw, y + hh, z - hd);
+                indices.push_back(second);
+                indices.push_back(second + 1);
+                indices.push_back(first + 1);
+            }
+        }
     }
-}
 
-void ofDrawBox(float size) {
-    ofDrawBox(0.0f, 0.0f, 0.0f, size, size, size);
+    // Unit cone (radius 1, height 1, centered). Normals are built for the
+    // final radius/height ratio and pre-divided by the instance scale so the
+    // instance transform brings them back to the true surface normal.
+    void buildUnitCone(UnitGeometry& unit, uint32_t resolution, float radius, float height) {
+        auto& vertices = unit.vertices;
+        auto& indices = unit.indices;
+        const simd_float4 color = kUnitColor;
+
+        const float apexY = 0.5f;
+        const float baseY = -0.5f;
+
+        // Apex vertex (index 0)
+        vertices.push_back(render::Vertex3D(0, apexY, 0, 0, 1, 0, 0.5f, 0,
+                                             color.x, color.y, color.z, color.w));
+
+        // Side normal of the sized cone, divided by scale (radius, height, radius)
+        float slopeAngle = std::atan2(radius, height);
+        float normalY = std::cos(slopeAngle);
+        float normalXZScale = std::sin(slopeAngle);
+        float sx = radius != 0.0f ? 1.0f / radius : 1.0f;
+        float sy = height != 0.0f ? 1.0f / height : 1.0f;
+
+        for (uint32_t i = 0; i <= resolution; ++i) {
+            float angle = i * 2.0f * M_PI / resolution;
+            float cosA = std::cos(angle);
+            float sinA = std::sin(angle);
+
+            // Normal points outward along the cone surface
+            float nx = normalXZScale * cosA * sx;
+            float ny = normalY * sy;
+            float nz = normalXZScale * sinA * sx;
+            float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+            if (length > 0.0f) {
+                nx /= length;
+                ny /= length;
+                nz /= length;
+            }
+
+            float u = (float)i / resolution;
+            vertices.push_back(render::Vertex3D(cosA, baseY, sinA, nx, ny, nz, u, 1,
+                                                 color.x, color.y, color.z, color.w));
+        }
+
+        // Side triangles (triangle fan from apex)
+        for (uint32_t i = 0; i < resolution; ++i) {
+            indices.push_back(0);           // Apex
+            indices.push_back(i + 1);       // Current base vertex
+            indices.push_back(i + 2);       // Next base vertex
+        }
+
+        // Base center vertex
+        uint32_t baseCenterIdx = static_cast<uint32_t>(vertices.size());
+        vertices.push_back(render::Vertex3D(0, baseY, 0, 0, -1, 0, 0.5f, 0.5f,
+                                             color.x, color.y, color.z, color.w));
+
+        // Base circle vertices
+        uint32_t baseStartIdx = static_cast<uint32_t>(vertices.size());
+        for (uint32_t i = 0; i <= resolution; ++i) {
+            float angle = i * 2.0f * M_PI / resolution;
+            float cosA = std::cos(angle);
+            float sinA = std::sin(angle);
+
+            vertices.push_back(render::Vertex3D(cosA, baseY, sinA, 0, -1, 0,
+                                                 0.5f + 0.5f * cosA, 0.5f + 0.5f * sinA,
+                                                 color.x, color.y, color.z, color.w));
+        }
+
+        // Base triangles (reverse winding for bottom face)
+        for (uint32_t i = 0; i < resolution; ++i) {
+            indices.push_back(baseCenterIdx);
+            indices.push_back(baseStartIdx + i + 1);
+            indices.push_back(baseStartIdx + i);
+        }
+    }
+
+    // Unit cylinder (radius 1, height 1, centered)
+    void buildUnitCylinder(UnitGeometry& unit, uint32_t resolution) {
+        auto& vertices = unit.vertices;
+        auto& indices = unit.indices;
+        const simd_float4 color = kUnitColor;
+
+        const float topY = 0.5f;
+        const float bottomY = -0.5f;
+
+        // Side vertices (two rings)
+        for (uint32_t i = 0; i <= resolution; ++i) {
+            float angle = i * 2.0f * M_PI / resolution;
+            float cosA = std::cos(angle);
+            float sinA = std::sin(angle);
+            float u = (float)i / resolution;
+
+            // Top ring vertex (side)
+            vertices.push_back(render::Vertex3D(cosA, topY, sinA, cosA, 0, sinA, u, 0,
+                                                 color.x, color.y, color.z, color.w));
+            // Bottom ring vertex (side)
+            vertices.push_back(render::Vertex3D(cosA, bottomY, sinA, cosA, 0, sinA, u, 1,
+                                                 color.x, color.y, color.z, color.w));
+        }
+
+        // Side quads
+        for (uint32_t i = 0; i < resolution; ++i) {
+            uint32_t topLeft = i * 2;
+            uint32_t bottomLeft = i * 2 + 1;
+            uint32_t topRight = (i + 1) * 2;
+            uint32_t bottomRight = (i + 1) * 2 + 1;
+
+            // First triangle
+            indices.push_back(topLeft);
+            indices.push_back(bottomLeft);
+            indices.push_back(topRight);
+
+            // Second triangle
+            indices.push_back(topRight);
+            indices.push_back(bottomLeft);
+            indices.push_back(bottomRight);
+        }
+
+        // Caps: center plus ring, wound to face outward
+        auto addCap = [&](float capY, float normalY, bool reverse) {
+            uint32_t centerIdx = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(render::Vertex3D(0, capY, 0, 0, normalY, 0, 0.5f, 0.5f,
+                                                 color.x, color.y, color.z, color.w));
+
+            uint32_t capStart = static_cast<uint32_t>(vertices.size());
+            for (uint32_t i = 0; i <= resolution; ++i) {
+                float angle = i * 2.0f * M_PI / resolution;
+                float cosA = std::cos(angle);
+                float sinA = std::sin(angle);
+
+                vertices.push_back(render::Vertex3D(cosA, capY, sinA, 0, normalY, 0,
+                                                     0.5f + 0.5f * cosA, 0.5f + 0.5f * sinA,
+                                                     color.x, color.y, color.z, color.w));
+            }
+
+            for (uint32_t i = 0; i < resolution; ++i) {
+                indices.push_back(centerIdx);
+                indices.push_back(capStart + (reverse ? i + 1 : i));
+                indices.push_back(capStart + (reverse ? i : i + 1));
+            }
+        };
+
+        addCap(topY, 1.0f, false);
+        addCap(bottomY, -1.0f, true);
+    }
+
+    // Unit icosphere (radius 1) by midpoint subdivision
+    void buildUnitIcoSphere(UnitGeometry& unit, int subdivisions) {
+        // Golden ratio
+        const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;
+
+        // Icosahedron vertices (normalized)
+        std::vector<simd_float3> icoVertices = {
+            simd_normalize(simd_make_float3(-1,  t,  0)),
+            simd_normalize(simd_make_float3( 1,  t,  0)),
+            simd_normalize(simd_make_float3(-1, -t,  0)),
+            simd_normalize(simd_make_float3( 1, -t,  0)),
+            simd_normalize(simd_make_float3( 0, -1,  t)),
+            simd_normalize(simd_make_float3( 0,  1,  t)),
+            simd_normalize(simd_make_float3( 0, -1, -t)),
+            simd_normalize(simd_make_float3( 0,  1, -t)),
+            simd_normalize(simd_make_float3( t,  0, -1)),
+            simd_normalize(simd_make_float3( t,  0,  1)),
+            simd_normalize(simd_make_float3(-t,  0, -1)),
+            simd_normalize(simd_make_float3(-t,  0,  1))
+        };
+
+        // Icosahedron faces (20 triangles)
+        std::vector<std::array<uint32_t, 3>> faces = {
+            {0, 11, 5}, {0, 5, 1}, {0, 1, 7}, {0, 7, 10}, {0, 10, 11},
+            {1, 5, 9}, {5, 11, 4}, {11, 10, 2}, {10, 7, 6}, {7, 1, 8},
+            {3, 9, 4}, {3, 4, 2}, {3, 2, 6}, {3, 6, 8}, {3, 8, 9},
+            {4, 9, 5}, {2, 4, 11}, {6, 2, 10}, {8, 6, 7}, {9, 8, 1}
+        };
+
+        // Subdivide
+        for (int s = 0; s < subdivisions; ++s) {
+            std::vector<std::array<uint32_t, 3>> newFaces;
+            std::map<std::pair<uint32_t, uint32_t>, uint32_t> midpointCache;
+
+            auto getMidpoint = [&](uint32_t i1, uint32_t i2) -> uint32_t {
+                auto key = std::make_pair(std::min(i1, i2), std::max(i1, i2));
+                auto it = midpointCache.find(key);
+                if (it != midpointCache.end()) {
+                    return it->second;
+                }
+
+                simd_float3 mid = simd_normalize((icoVertices[i1] + icoVertices[i2]) * 0.5f);
+                uint32_t idx = static_cast<uint32_t>(icoVertices.size());
+                icoVertices.push_back(mid);
+                midpointCache[key] = idx;
+                return idx;
+            };
+
+            for (const auto& face : faces) {
+                uint32_t a = getMidpoint(face[0], face[1]);
+                uint32_t b = getMidpoint(face[1], face[2]);
+                uint32_t c = getMidpoint(face[2], face[0]);
+
+                newFaces.push_back({face[0], a, c});
+                newFaces.push_back({face[1], b, a});
+                newFaces.push_back({face[2], c, b});
+                newFaces.push_back({a, b, c});
+            }
+
+            faces = std::move(newFaces);
+        }
+
+        const simd_float4 color = kUnitColor;
+        unit.vertices.reserve(icoVertices.size());
+        for (const auto& v : icoVertices) {
+            // UV mapping (spherical)
+            float u = 0.5f + std::atan2(v.z, v.x) / (2.0f * M_PI);
+            float vCoord = 0.5f - std::asin(v.y) / M_PI;
+
+            unit.vertices.push_back(render::Vertex3D(v.x, v.y, v.z, v.x, v.y, v.z, u, vCoord,
+                                                     color.x, color.y, color.z, color.w));
+        }
+
+        unit.indices.reserve(faces.size() * 3);
+        for (const auto& face : faces) {
+            unit.indices.push_back(face[0]);
+            unit.indices.push_back(face[1]);
+            unit.indices.push_back(face[2]);
+        }
+    }
+
+    // Look up (or tessellate) a unit primitive
+    UnitGeometry& getUnitPrimitive(UnitPrimitive type, uint32_t resolution,
+                                   float radius = 1.0f, float height = 1.0f) {
+        uint32_t variant = 0;
+        if (type == UnitPrimitive::Cone) {
+            float ratio = height != 0.0f ? radius / height : 0.0f;
+            std::memcpy(&variant, &ratio, sizeof(variant));
+        }
+
+        auto& cache = getUnitPrimitiveCache();
+        const uint64_t key = unitPrimitiveKey(type, resolution, variant);
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            return it->second;
+        }
+
+        if (cache.size() >= kMaxUnitPrimitives) {
+            cache.clear();
+        }
+
+        UnitGeometry& unit = cache[key];
+        switch (type) {
+            case UnitPrimitive::Box:       buildUnitBox(unit); break;
+            case UnitPrimitive::Sphere:    buildUnitSphere(unit, resolution); break;
+            case UnitPrimitive::Cone:      buildUnitCone(unit, resolution, radius, height); break;
+            case UnitPrimitive::Cylinder:  buildUnitCylinder(unit, resolution); break;
+            case UnitPrimitive::IcoSphere: buildUnitIcoSphere(unit, static_cast<int>(resolution)); break;
+        }
+        return unit;
+    }
+
+    // Translate(x, y, z) * Scale(sx, sy, sz)
+    simd_float4x4 makeUnitTransform(float x, float y, float z, float sx, float sy, float sz) {
+        return simd_matrix(
+            simd_make_float4(sx, 0, 0, 0),
+            simd_make_float4(0, sy, 0, 0),
+            simd_make_float4(0, 0, sz, 0),
+            simd_make_float4(x, y, z, 1)
+        );
+    }
 }
 
-// Helper function to submit 3D geometry
-static void submit3DGeometry(const std::vector<render::Vertex3D>& vertices,
-                             const std::vector<uint32_t>& indices) {
+// Draw a cached unit primitive as one instance of the current DrawList's copy
+// State and the single instance of a unit primitive draw (vertex fields are
+// left to the caller)
+static void setupPrimitiveInstance(render::DrawCommand3DInstanced& cmd, const simd_float4x4& localTransform) {
     auto& state = getGraphicsState();
-
     auto& drawList = Context::instance().getDrawList();
-    uint32_t vtxOffset = drawList.addVertices3D(vertices.data(), vertices.size());
-    uint32_t idxOffset = drawList.addIndices(indices.data(), indices.size());
 
-    render::DrawCommand3D cmd;
-    cmd.vertexOffset = vtxOffset;
-    cmd.vertexCount = static_cast<uint32_t>(vertices.size());
-    cmd.indexOffset = idxOffset;
-    cmd.indexCount = static_cast<uint32_t>(indices.size());
+    // Size, placement and color travel per instance
+    render::InstanceData instance;
+    instance.modelMatrix = simd_mul(getModelMatrix(state), localTransform);
+    instance.color = colorToFloat4(state.currentColor[0], state.currentColor[1],
+                                   state.currentColor[2], state.currentColor[3]);
+    instance.userData = simd_make_float4(0, 0, 0, 0);
+
     cmd.primitiveType = render::PrimitiveType::Triangle;
     cmd.blendMode = static_cast<render::BlendMode>(state.blendMode);
     cmd.texture = nullptr;
 
-    // Get view matrix from Context
-    simd_float4x4 viewMatrix = Context::instance().getViewMatrix();
-
-    // Model matrix from current transform
-    auto& m = state.currentMatrix;
-    simd_float4x4 modelMatrix = simd_matrix(
-        simd_make_float4(m(0,0), m(1,0), m(2,0), m(3,0)),
-        simd_make_float4(m(0,1), m(1,1), m(2,1), m(3,1)),
-        simd_make_float4(m(0,2), m(1,2), m(2,2), m(3,2)),
-        simd_make_float4(m(0,3), m(1,3), m(2,3), m(3,3))
-    );
-
-    cmd.modelViewMatrix = simd_mul(viewMatrix, modelMatrix);
+    // Only the view is shared; the model matrix is in the instance
+    cmd.modelViewMatrix = Context::instance().getViewMatrix();
     cmd.projectionMatrix = Context::instance().getProjectionMatrix();
 
-    cmd.normalMatrix = simd_matrix(
-        simd_make_float3(cmd.modelViewMatrix.columns[0].x, cmd.modelViewMatrix.columns[0].y, cmd.modelViewMatrix.columns[0].z),
-        simd_make_float3(cmd.modelViewMatrix.columns[1].x, cmd.modelViewMatrix.columns[1].y, cmd.modelViewMatrix.columns[1].z),
-        simd_make_float3(cmd.modelViewMatrix.columns[2].x, cmd.modelViewMatrix.columns[2].y, cmd.modelViewMatrix.columns[2].z)
-    );
-
     cmd.depthTestEnabled = state.depthTestEnabled;
     cmd.depthWriteEnabled = state.depthWriteEnabled;
     cmd.cullBackFace = state.cullingEnabled;
+    cmd.orderIndependent = cmd.blendMode == render::BlendMode::Alpha && state.orderIndependentTransparency;
+    cmd.objectId = state.objectId;
 
     // Capture lighting state at command creation time
     Context& ctx = Context::instance();
     cmd.useLighting = ctx.hasMaterial() && ctx.isLightingEnabled();
     if (cmd.useLighting) {
-        cmd.lightCount = ctx.getLightCount();
-        // Copy material data
-        auto matData = ctx.getMaterialData();
-        size_t matSize = std::min(matData.size(), size_t(16));
-        for (size_t i = 0; i < matSize; ++i) {
-            cmd.materialData[i] = matData[i];
-        }
-        // Copy light data
-        auto lightData = ctx.getAllLightData();
-        size_t lightSize = std::min(lightData.size(), size_t(256));
-        for (size_t i = 0; i < lightSize; ++i) {
-            cmd.lightData[i] = lightData[i];
-        }
+        cmd.lightingHandle = ctx.getLightingStateHandle();
+
+        // The shader applies the instance model matrix first (rigid and
+        // uniform-scale transforms keep normals exact)
+        cmd.normalMatrix = upperLeft3x3(cmd.modelViewMatrix);
     }
 
-    drawList.addCommand(cmd);
+    // Records come from the list's instance stream (null instanceBuffer)
+    cmd.instanceBuffer = nullptr;
+    cmd.instanceOffset = drawList.addInstances(&instance, 1);
+    cmd.instanceCount = 1;
 }
 
-void ofDrawSphere(float x, float y, float z, float radius) {
-    auto& state = getGraphicsState();
-    uint32_t resolution = state.sphereResolution;
-    if (resolution < 4) resolution = 4;
+static void submitUnitPrimitive(UnitGeometry& unit, const simd_float4x4& localTransform) {
+    auto& drawList = Context::instance().getDrawList();
 
-    simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
-                                       state.currentColor[2], state.currentColor[3]);
+    // Record the tessellation once per list reset; later calls only add an instance
+    if (unit.list != &drawList || unit.generation != drawList.getGeneration()) {
+        unit.vertexOffset = drawList.addVertices3D(unit.vertices.data(), unit.vertices.size());
+        unit.indexOffset = drawList.addIndices(unit.indices.data(), unit.indices.size());
+        unit.list = &drawList;
+        unit.generation = drawList.getGeneration();
+    }
 
-    std::vector<render::Vertex3D> vertices;
-    std::vector<uint32_t> indices;
+    render::DrawCommand3DInstanced cmd;
+    cmd.vertexOffset = unit.vertexOffset;
+    cmd.vertexCount = static_cast<uint32_t>(unit.vertices.size());
+    cmd.indexOffset = unit.indexOffset;
+    cmd.indexCount = static_cast<uint32_t>(unit.indices.size());
+    setupPrimitiveInstance(cmd, localTransform);
+    drawList.addCommand(cmd);
+}
 
-    // UV sphere: latitude rings × longitude segments
-    uint32_t latSegments = resolution;
-    uint32_t lonSegments = resolution * 2;
+// Generate the primitive in the renderer's mesh shaders; false if the
+// renderer or list can't (the caller instances the tessellated mesh).
+// Order-independent transparency keeps the vertex path, whose accumulation
+// pipelines the mesh draws don't have.
+static bool submitMeshPrimitive(render::MeshPrimitive primitive, uint32_t resolution,
+                                const simd_float4x4& localTransform) {
+    auto& state = getGraphicsState();
+    auto& drawList = Context::instance().getDrawList();
+    auto* renderer = Context::instance().renderer();
+    if (!renderer || !renderer->supportsMeshPrimitives() || !drawList.isMeshPrimitivesEnabled() ||
+        (state.blendMode == OF_BLENDMODE_ALPHA && state.orderIndependentTransparency)) {
+        return false;
+    }
 
-    // Generate vertices
-    for (uint32_t lat = 0; lat <= latSegments; ++lat) {
-        float theta = lat * M_PI / latSegments;  // 0 to PI
-        float sinTheta = std::sin(theta);
-        float cosTheta = std::cos(theta);
+    render::DrawMeshPrimitivesCommand cmd;
+    cmd.primitive = primitive;
+    cmd.resolution = resolution;
+    setupPrimitiveInstance(cmd, localTransform);
+    drawList.addCommand(cmd);
+    return true;
+}
 
-        for (uint32_t lon = 0; lon <= lonSegments; ++lon) {
-            float phi = lon * 2.0f * M_PI / lonSegments;  // 0 to 2*PI
-            float sinPhi = std::sin(phi);
-            float cosPhi = std::cos(phi);
+void ofDrawBox(float x, float y, float z, float size) {
+    ofDrawBox(x, y, z, size, size, size);
+}
 
-            // Normal (unit sphere)
-            float nx = sinTheta * cosPhi;
-            float ny = cosTheta;
-            float nz = sinTheta * sinPhi;
+void ofDrawBox(float x, float y, float z, float width, float height, float depth) {
+    auto& state = getGraphicsState();
 
-            // Position
-            float px = x + radius * nx;
-            float py = y + radius * ny;
-            float pz = z + radius * nz;
+    float hw = width / 2.0f;
+    float hh = height / 2.0f;
+    float hd = depth / 2.0f;
 
-            // UV coordinates
-            float u = (float)lon / lonSegments;
-            float v = (float)lat / latSegments;
+    if (state.fillEnabled) {
+        // Axis-aligned face normals survive the non-uniform scale
+        submitUnitPrimitive(getUnitPrimitive(UnitPrimitive::Box, 0),
+                            makeUnitTransform(x, y, z, width, height, depth));
+    } else {
+        // Wireframe mode: draw 12 edges
+        ofDrawLine(x - hw, y - hh, z + hd, x + hw, y - hh, z + hd);
+        ofDrawLine(x + hw, y - hh, z + hd, x + hw, y + hh, z + hd);
+        ofDrawLine(x + hw, y + hh, z + hd, x - hw, y + hh, z + hd);
+        ofDrawLine(x - hw, y + hh, z + hd, x - hw, y - hh, z + hd);
 
-            vertices.push_back(render::Vertex3D(px, py, pz, nx, ny, nz, u, v,
-                                                 color.x, color.y, color.z, color.w));
-        }
+        ofDrawLine(x - hw, y - hh, z - hd, x + hw, y - hh, z - hd);
+        ofDrawLine(x + hw, y - hh, z - hd, x + hw, y + hh, z - hd);
+        ofDrawLine(x + hw, y + hh, z - hd, x - hw, y + hh, z - hd);
+        ofDrawLine(x - hw, y + hh, z - hd, x - hw, y - hh, z - hd);
+
+        ofDrawLine(x - hw, y - hh, z + hd, x - hw, y - hh, z - hd);
+        ofDrawLine(x + hw, y - hh, z + hd, x + hw, y - hh, z - hd);
+        ofDrawLine(x + hw, y + hh, z + hd, x + hw, y + hh, z - hd);
+        ofDrawLine(x - hw, y + hh, z + hd, x - hw, y + hh, z - hd);
     }
+}
 
-    // Generate indices
-    for (uint32_t lat = 0; lat < latSegments; ++lat) {
-        for (uint32_t lon = 0; lon < lonSegments; ++lon) {
-            uint32_t first = lat * (lonSegments + 1) + lon;
-            uint32_t second = first + lonSegments + 1;
+void ofDrawBox(float size) {
+    ofDrawBox(0.0f, 0.0f, 0.0f, size, size, size);
+}
 
-            // Two triangles per quad
-            indices.push_back(first);
-            indices.push_back(second);
-            indices.push_back(first + 1);
+void ofDrawSphere(float x, float y, float z, float radius) {
+    auto& state = getGraphicsState();
+    uint32_t resolution = state.sphereResolution;
+    if (resolution < 4) resolution = 4;
 
-            indices.push_back(second);
-            indices.push_back(second + 1);
-            indices.push_back(first + 1);
-        }
-    }
+    // UV sphere: latitude rings × longitude segments
+    uint32_t latSegments = resolution;
+    uint32_t lonSegments = resolution * 2;
 
     if (state.fillEnabled) {
-        submit3DGeometry(vertices, indices);
+        const simd_float4x4 transform = makeUnitTransform(x, y, z, radius, radius, radius);
+        if (!submitMeshPrimitive(render::MeshPrimitive::Sphere, resolution, transform)) {
+            submitUnitPrimitive(getUnitPrimitive(UnitPrimitive::Sphere, resolution), transform);
+        }
     } else {
         // Wireframe: draw latitude and longitude lines
         for (uint32_t lat = 0; lat <= latSegments; ++lat) {
@@ -1480,103 +2756,38 @@ void ofDrawSphere(float x, float y, float z, float radius) {
 
             for (uint32_t lat = 0; lat < latSegments; ++lat) {
                 float theta1 = lat * M_PI / latSegments;
-                float theta2 = (lat + 1) * M_PI / latSegments;
-
-                float x1 = x + radius * std::sin(theta1) * cosPhi;
-                float y1 = y + radius * std::cos(theta1);
-                float z1 = z + radius * std::sin(theta1) * sinPhi;
-
-                float x2 = x + radius * std::sin(theta2) * cosPhi;
-                float y2 = y + radius * std::cos(theta2);
-                float z2 = z + radius * std::sin(theta2) * sinPhi;
-
-                ofDrawLine(x1, y1, z1, x2, y2, z2);
-            }
-        }
-    }
-}
-
-void ofDrawSphere(float radius) {
-    ofDrawSphere(0.0f, 0.0f, 0.0f, radius);
-}
-
-void ofDrawCone(float x, float y, float z, float radius, float height) {
-    auto& state = getGraphicsState();
-    uint32_t resolution = state.circleResolution;
-    if (resolution < 3) resolution = 3;
-
-    simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
-                                       state.currentColor[2], state.currentColor[3]);
-
-    float halfHeight = height / 2.0f;
-    float apexY = y + halfHeight;
-    float baseY = y - halfHeight;
-
-    std::vector<render::Vertex3D> vertices;
-    std::vector<uint32_t> indices;
-
-    if (state.fillEnabled) {
-        // Apex vertex (index 0)
-        vertices.push_back(render::Vertex3D(x, apexY, z, 0, 1, 0, 0.5f, 0,
-                                             color.x, color.y, color.z, color.w));
-
-        // Side vertices (base circle for cone side)
-        float slopeAngle = std::atan2(radius, height);
-        float normalY = std::cos(slopeAngle);
-        float normalXZScale = std::sin(slopeAngle);
-
-        for (uint32_t i = 0; i <= resolution; ++i) {
-            float angle = i * 2.0f * M_PI / resolution;
-            float cosA = std::cos(angle);
-            float sinA = std::sin(angle);
-
-            float px = x + radius * cosA;
-            float pz = z + radius * sinA;
-
-            // Normal points outward along the cone surface
-            float nx = normalXZScale * cosA;
-            float nz = normalXZScale * sinA;
-
-            float u = (float)i / resolution;
-            vertices.push_back(render::Vertex3D(px, baseY, pz, nx, normalY, nz, u, 1,
-                                                 color.x, color.y, color.z, color.w));
-        }
-
-        // Side triangles (triangle fan from apex)
-        for (uint32_t i = 0; i < resolution; ++i) {
-            indices.push_back(0);           // Apex
-            indices.push_back(i + 1);       // Current base vertex
-            indices.push_back(i + 2);       // Next base vertex
-        }
-
-        // Base center vertex
-        uint32_t baseCenterIdx = static_cast<uint32_t>(vertices.size());
-        vertices.push_back(render::Vertex3D(x, baseY, z, 0, -1, 0, 0.5f, 0.5f,
-                                             color.x, color.y, color.z, color.w));
+                float theta2 = (lat + 1) * M_PI / latSegments;
 
-        // Base circle vertices
-        uint32_t baseStartIdx = static_cast<uint32_t>(vertices.size());
-        for (uint32_t i = 0; i <= resolution; ++i) {
-            float angle = i * 2.0f * M_PI / resolution;
-            float cosA = std::cos(angle);
-            float sinA = std::sin(angle);
+                float x1 = x + radius * std::sin(theta1) * cosPhi;
+                float y1 = y + radius * std::cos(theta1);
+                float z1 = z + radius * std::sin(theta1) * sinPhi;
 
-            float px = x + radius * cosA;
-            float pz = z + radius * sinA;
+                float x2 = x + radius * std::sin(theta2) * cosPhi;
+                float y2 = y + radius * std::cos(theta2);
+                float z2 = z + radius * std::sin(theta2) * sinPhi;
 
-            vertices.push_back(render::Vertex3D(px, baseY, pz, 0, -1, 0,
-                                                 0.5f + 0.5f * cosA, 0.5f + 0.5f * sinA,
-                                                 color.x, color.y, color.z, color.w));
+                ofDrawLine(x1, y1, z1, x2, y2, z2);
+            }
         }
+    }
+}
 
-        // Base triangles (reverse winding for bottom face)
-        for (uint32_t i = 0; i < resolution; ++i) {
-            indices.push_back(baseCenterIdx);
-            indices.push_back(baseStartIdx + i + 1);
-            indices.push_back(baseStartIdx + i);
-        }
+void ofDrawSphere(float radius) {
+    ofDrawSphere(0.0f, 0.0f, 0.0f, radius);
+}
 
-        submit3DGeometry(vertices, indices);
+void ofDrawCone(float x, float y, float z, float radius, float height) {
+    auto& state = getGraphicsState();
+    uint32_t resolution = state.circleResolution;
+    if (resolution < 3) resolution = 3;
+
+    float halfHeight = height / 2.0f;
+    float apexY = y + halfHeight;
+    float baseY = y - halfHeight;
+
+    if (state.fillEnabled) {
+        submitUnitPrimitive(getUnitPrimitive(UnitPrimitive::Cone, resolution, radius, height),
+                            makeUnitTransform(x, y, z, radius, height, radius));
     } else {
         // Wireframe mode
         // Draw base circle
@@ -1612,104 +2823,16 @@ void ofDrawCylinder(float x, float y, float z, float radius, float height) {
     uint32_t resolution = state.circleResolution;
     if (resolution < 3) resolution = 3;
 
-    simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
-                                       state.currentColor[2], state.currentColor[3]);
-
     float halfHeight = height / 2.0f;
     float topY = y + halfHeight;
     float bottomY = y - halfHeight;
 
-    std::vector<render::Vertex3D> vertices;
-    std::vector<uint32_t> indices;
-
     if (state.fillEnabled) {
-        // Side vertices (two rings)
-        for (uint32_t i = 0; i <= resolution; ++i) {
-            float angle = i * 2.0f * M_PI / resolution;
-            float cosA = std::cos(angle);
-            float sinA = std::sin(angle);
-
-            float px = x + radius * cosA;
-            float pz = z + radius * sinA;
-            float u = (float)i / resolution;
-
-            // Top ring vertex (side)
-            vertices.push_back(render::Vertex3D(px, topY, pz, cosA, 0, sinA, u, 0,
-                                                 color.x, color.y, color.z, color.w));
-            // Bottom ring vertex (side)
-            vertices.push_back(render::Vertex3D(px, bottomY, pz, cosA, 0, sinA, u, 1,
-                                                 color.x, color.y, color.z, color.w));
-        }
-
-        // Side quads
-        for (uint32_t i = 0; i < resolution; ++i) {
-            uint32_t topLeft = i * 2;
-            uint32_t bottomLeft = i * 2 + 1;
-            uint32_t topRight = (i + 1) * 2;
-            uint32_t bottomRight = (i + 1) * 2 + 1;
-
-            // First triangle
-            indices.push_back(topLeft);
-            indices.push_back(bottomLeft);
-            indices.push_back(topRight);
-
-            // Second triangle
-            indices.push_back(topRight);
-            indices.push_back(bottomLeft);
-            indices.push_back(bottomRight);
-        }
-
-        // Top cap
-        uint32_t topCenterIdx = static_cast<uint32_t>(vertices.size());
-        vertices.push_back(render::Vertex3D(x, topY, z, 0, 1, 0, 0.5f, 0.5f,
-                                             color.x, color.y, color.z, color.w));
-
-        uint32_t topCapStart = static_cast<uint32_t>(vertices.size());
-        for (uint32_t i = 0; i <= resolution; ++i) {
-            float angle = i * 2.0f * M_PI / resolution;
-            float cosA = std::cos(angle);
-            float sinA = std::sin(angle);
-
-            float px = x + radius * cosA;
-            float pz = z + radius * sinA;
-
-            vertices.push_back(render::Vertex3D(px, topY, pz, 0, 1, 0,
-                                                 0.5f + 0.5f * cosA, 0.5f + 0.5f * sinA,
-                                                 color.x, color.y, color.z, color.w));
-        }
-
-        for (uint32_t i = 0; i < resolution; ++i) {
-            indices.push_back(topCenterIdx);
-            indices.push_back(topCapStart + i);
-            indices.push_back(topCapStart + i + 1);
-        }
-
-        // Bottom cap
-        uint32_t bottomCenterIdx = static_cast<uint32_t>(vertices.size());
-        vertices.push_back(render::Vertex3D(x, bottomY, z, 0, -1, 0, 0.5f, 0.5f,
-                                             color.x, color.y, color.z, color.w));
-
-        uint32_t bottomCapStart = static_cast<uint32_t>(vertices.size());
-        for (uint32_t i = 0; i <= resolution; ++i) {
-            float angle = i * 2.0f * M_PI / resolution;
-            float cosA = std::cos(angle);
-            float sinA = std::sin(angle);
-
-            float px = x + radius * cosA;
-            float pz = z + radius * sinA;
-
-            vertices.push_back(render::Vertex3D(px, bottomY, pz, 0, -1, 0,
-                                                 0.5f + 0.5f * cosA, 0.5f + 0.5f * sinA,
-                                                 color.x, color.y, color.z, color.w));
+        // Side normals lie in XZ and the caps' along Y, so the scale keeps them exact
+        const simd_float4x4 transform = makeUnitTransform(x, y, z, radius, height, radius);
+        if (!submitMeshPrimitive(render::MeshPrimitive::Cylinder, resolution, transform)) {
+            submitUnitPrimitive(getUnitPrimitive(UnitPrimitive::Cylinder, resolution), transform);
         }
-
-        for (uint32_t i = 0; i < resolution; ++i) {
-            indices.push_back(bottomCenterIdx);
-            indices.push_back(bottomCapStart + i + 1);
-            indices.push_back(bottomCapStart + i);
-        }
-
-        submit3DGeometry(vertices, indices);
     } else {
         // Wireframe mode
         // Draw top and bottom circles
@@ -1751,29 +2874,25 @@ void ofDrawPlane(float x, float y, float z, float width, float height) {
     float hh = height / 2.0f;
 
     if (state.fillEnabled) {
-        std::vector<render::Vertex3D> vertices;
-        std::vector<uint32_t> indices;
+        auto geometry = Context::instance().getDrawList().allocateGeometry3D(4, 6);
+        render::Vertex3D* vertices = geometry.vertices;
 
         // Four corners of the plane (XZ plane, Y is up)
         // Normal pointing up (+Y)
-        vertices.push_back(render::Vertex3D(x - hw, y, z - hh, 0, 1, 0, 0, 0,
-                                             color.x, color.y, color.z, color.w));
-        vertices.push_back(render::Vertex3D(x + hw, y, z - hh, 0, 1, 0, 1, 0,
-                                             color.x, color.y, color.z, color.w));
-        vertices.push_back(render::Vertex3D(x + hw, y, z + hh, 0, 1, 0, 1, 1,
-                                             color.x, color.y, color.z, color.w));
-        vertices.push_back(render::Vertex3D(x - hw, y, z + hh, 0, 1, 0, 0, 1,
-                                             color.x, color.y, color.z, color.w));
+        vertices[0] = render::Vertex3D(x - hw, y, z - hh, 0, 1, 0, 0, 0,
+                                       color.x, color.y, color.z, color.w);
+        vertices[1] = render::Vertex3D(x + hw, y, z - hh, 0, 1, 0, 1, 0,
+                                       color.x, color.y, color.z, color.w);
+        vertices[2] = render::Vertex3D(x + hw, y, z + hh, 0, 1, 0, 1, 1,
+                                       color.x, color.y, color.z, color.w);
+        vertices[3] = render::Vertex3D(x - hw, y, z + hh, 0, 1, 0, 0, 1,
+                                       color.x, color.y, color.z, color.w);
 
         // Two triangles
-        indices.push_back(0);
-        indices.push_back(1);
-        indices.push_back(2);
-        indices.push_back(0);
-        indices.push_back(2);
-        indices.push_back(3);
+        const uint32_t indices[6] = {0, 1, 2, 0, 2, 3};
+        std::memcpy(geometry.indices, indices, sizeof(indices));
 
-        submit3DGeometry(vertices, indices);
+        submit3DGeometry(geometry.vertexOffset, 4, geometry.indexOffset, 6);
     } else {
         // Wireframe: draw rectangle outline
         ofDrawLine(x - hw, y, z - hh, x + hw, y, z - hh);
@@ -1790,157 +2909,287 @@ void ofDrawPlane(float width, float height) {
 void ofDrawIcoSphere(float x, float y, float z, float radius, int subdivisions) {
     auto& state = getGraphicsState();
 
-    simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
-                                       state.currentColor[2], state.currentColor[3]);
-
     if (subdivisions < 0) subdivisions = 0;
     if (subdivisions > 5) subdivisions = 5;  // Limit to prevent excessive geometry
 
-    // Golden ratio
-    const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;
-
-    // Icosahedron vertices (normalized)
-    std::vector<simd_float3> icoVertices = {
-        simd_normalize(simd_make_float3(-1,  t,  0)),
-        simd_normalize(simd_make_float3( 1,  t,  0)),
-        simd_normalize(simd_make_float3(-1, -t,  0)),
-        simd_normalize(simd_make_float3( 1, -t,  0)),
-        simd_normalize(simd_make_float3( 0, -1,  t)),
-        simd_normalize(simd_make_float3( 0,  1,  t)),
-        simd_normalize(simd_make_float3( 0, -1, -t)),
-        simd_normalize(simd_make_float3( 0,  1, -t)),
-        simd_normalize(simd_make_float3( t,  0, -1)),
-        simd_normalize(simd_make_float3( t,  0,  1)),
-        simd_normalize(simd_make_float3(-t,  0, -1)),
-        simd_normalize(simd_make_float3(-t,  0,  1))
-    };
+    if (state.fillEnabled) {
+        const simd_float4x4 transform = makeUnitTransform(x, y, z, radius, radius, radius);
+        if (!submitMeshPrimitive(render::MeshPrimitive::IcoSphere, static_cast<uint32_t>(subdivisions),
+                                 transform)) {
+            submitUnitPrimitive(getUnitPrimitive(UnitPrimitive::IcoSphere, static_cast<uint32_t>(subdivisions)),
+                                transform);
+        }
+    } else {
+        UnitGeometry& unit = getUnitPrimitive(UnitPrimitive::IcoSphere,
+                                              static_cast<uint32_t>(subdivisions));
 
-    // Icosahedron faces (20 triangles)
-    std::vector<std::array<uint32_t, 3>> faces = {
-        {0, 11, 5}, {0, 5, 1}, {0, 1, 7}, {0, 7, 10}, {0, 10, 11},
-        {1, 5, 9}, {5, 11, 4}, {11, 10, 2}, {10, 7, 6}, {7, 1, 8},
-        {3, 9, 4}, {3, 4, 2}, {3, 2, 6}, {3, 6, 8}, {3, 8, 9},
-        {4, 9, 5}, {2, 4, 11}, {6, 2, 10}, {8, 6, 7}, {9, 8, 1}
-    };
+        // Wireframe: draw edges of each triangle
+        auto point = [&](uint32_t index) {
+            const auto& p = unit.vertices[index].position;
+            return simd_make_float3(x + radius * p.x, y + radius * p.y, z + radius * p.z);
+        };
 
-    // Subdivide
-    for (int s = 0; s < subdivisions; ++s) {
-        std::vector<std::array<uint32_t, 3>> newFaces;
-        std::map<std::pair<uint32_t, uint32_t>, uint32_t> midpointCache;
+        for (size_t i = 0; i + 2 < unit.indices.size(); i += 3) {
+            simd_float3 v0 = point(unit.indices[i]);
+            simd_float3 v1 = point(unit.indices[i + 1]);
+            simd_float3 v2 = point(unit.indices[i + 2]);
 
-        auto getMidpoint = [&](uint32_t i1, uint32_t i2) -> uint32_t {
-            auto key = std::make_pair(std::min(i1, i2), std::max(i1, i2));
-            auto it = midpointCache.find(key);
-            if (it != midpointCache.end()) {
-                return it->second;
-            }
+            ofDrawLine(v0.x, v0.y, v0.z, v1.x, v1.y, v1.z);
+            ofDrawLine(v1.x, v1.y, v1.z, v2.x, v2.y, v2.z);
+            ofDrawLine(v2.x, v2.y, v2.z, v0.x, v0.y, v0.z);
+        }
+    }
+}
 
-            simd_float3 mid = simd_normalize((icoVertices[i1] + icoVertices[i2]) * 0.5f);
-            uint32_t idx = static_cast<uint32_t>(icoVertices.size());
-            icoVertices.push_back(mid);
-            midpointCache[key] = idx;
-            return idx;
-        };
+void ofDrawIcoSphere(float radius, int subdivisions) {
+    ofDrawIcoSphere(0.0f, 0.0f, 0.0f, radius, subdivisions);
+}
 
-        for (const auto& face : faces) {
-            uint32_t a = getMidpoint(face[0], face[1]);
-            uint32_t b = getMidpoint(face[1], face[2]);
-            uint32_t c = getMidpoint(face[2], face[0]);
+// ============================================================================
+// 3D Helper Functions Implementation
+// ============================================================================
+
+// Axes, grids and rotation axes are static line sets that debug views draw
+// every frame. Each parameter set is recorded once into a display list; the
+// renderer keeps its geometry resident, so a call costs one replay command.
+// Style that the recording bakes in (color, blend, depth, culling) is part of
+// the key.
+
+namespace {
+    enum class HelperGeometry : uint32_t {
+        Axis,
+        Grid,
+        GridPlane,
+        RotationAxes
+    };
 
-            newFaces.push_back({face[0], a, c});
-            newFaces.push_back({face[1], b, a});
-            newFaces.push_back({face[2], c, b});
-            newFaces.push_back({a, b, c});
+    // 4-byte fields only, so the key has no padding and compares with memcmp
+    struct HelperKey {
+        HelperGeometry kind;
+        float params[2];
+        uint32_t counts[2];
+        uint32_t flags;         // Per-helper options
+        uint32_t color;         // Current RGBA, packed
+        uint32_t blendMode;
+        uint32_t depthState;    // Depth test | depth write | culling bits
+
+        bool operator==(const HelperKey& other) const {
+            return std::memcmp(this, &other, sizeof(HelperKey)) == 0;
         }
+    };
 
-        faces = std::move(newFaces);
-    }
+    struct CachedHelper {
+        HelperKey key;
+        oflike::ofDisplayList list;
+        unsigned long long lastFrame = 0;
+    };
 
-    // Generate final vertices and indices
-    std::vector<render::Vertex3D> vertices;
-    std::vector<uint32_t> indices;
+    // Entries not drawn for this many frames may be replaced; frames still in
+    // flight can reference a list, so recently drawn ones are never dropped
+    constexpr size_t kMaxCachedHelpers = 32;
+    constexpr unsigned long long kHelperRetainFrames = 8;
 
-    for (const auto& v : icoVertices) {
-        float px = x + radius * v.x;
-        float py = y + radius * v.y;
-        float pz = z + radius * v.z;
+    // Per thread, like GraphicsState, since recording binds the thread's list
+    std::vector<CachedHelper>& getHelperCache() {
+        thread_local std::vector<CachedHelper> cache;
+        return cache;
+    }
 
-        // UV mapping (spherical)
-        float u = 0.5f + std::atan2(v.z, v.x) / (2.0f * M_PI);
-        float vCoord = 0.5f - std::asin(v.y) / M_PI;
+    HelperKey makeHelperKey(const GraphicsState& state, HelperGeometry kind) {
+        HelperKey key;
+        std::memset(&key, 0, sizeof(key));
+        key.kind = kind;
+        std::memcpy(&key.color, state.currentColor, sizeof(key.color));
+        key.blendMode = static_cast<uint32_t>(state.blendMode);
+        key.depthState = (state.depthTestEnabled ? 1u : 0u) | (state.depthWriteEnabled ? 2u : 0u) |
+                         (state.cullingEnabled ? 4u : 0u);
+        return key;
+    }
 
-        vertices.push_back(render::Vertex3D(px, py, pz, v.x, v.y, v.z, u, vCoord,
-                                             color.x, color.y, color.z, color.w));
+    render::Vertex3D helperVertex(float x, float y, float z, simd_float4 color) {
+        return render::Vertex3D(x, y, z, 0, 0, 0, 0, 0, color.x, color.y, color.z, color.w);
     }
 
-    for (const auto& face : faces) {
-        indices.push_back(face[0]);
-        indices.push_back(face[1]);
-        indices.push_back(face[2]);
+    void buildAxis(const HelperKey& key) {
+        const float size = key.params[0];
+        const simd_float4 red = simd_make_float4(1, 0, 0, 1);
+        const simd_float4 green = simd_make_float4(0, 1, 0, 1);
+        const simd_float4 blue = simd_make_float4(0, 0, 1, 1);
+        const std::vector<render::Vertex3D> vertices = {
+            helperVertex(0, 0, 0, red),   helperVertex(size, 0, 0, red),
+            helperVertex(0, 0, 0, green), helperVertex(0, size, 0, green),
+            helperVertex(0, 0, 0, blue),  helperVertex(0, 0, size, blue),
+        };
+        submit3DGeometry(vertices, {}, render::PrimitiveType::Line);
     }
 
-    if (state.fillEnabled) {
-        submit3DGeometry(vertices, indices);
-    } else {
-        // Wireframe: draw edges of each triangle
-        for (const auto& face : faces) {
-            const auto& v0 = vertices[face[0]];
-            const auto& v1 = vertices[face[1]];
-            const auto& v2 = vertices[face[2]];
+    // Grid on XZ: flags bit 0 = lines parallel to X, bit 1 = center lines,
+    // bit 2 = lines parallel to Z
+    void buildGrid(const HelperKey& key) {
+        const auto& state = getGraphicsState();
+        const simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
+                                                state.currentColor[2], state.currentColor[3]);
+        const float step = key.params[0];
+        const int steps = static_cast<int>(key.counts[0]);
+        const float half = step * steps;
 
-            ofDrawLine(v0.position.x, v0.position.y, v0.position.z,
-                       v1.position.x, v1.position.y, v1.position.z);
-            ofDrawLine(v1.position.x, v1.position.y, v1.position.z,
-                       v2.position.x, v2.position.y, v2.position.z);
-            ofDrawLine(v2.position.x, v2.position.y, v2.position.z,
-                       v0.position.x, v0.position.y, v0.position.z);
+        std::vector<render::Vertex3D> vertices;
+        vertices.reserve((2 * steps + 1) * 4);
+        for (int i = -steps; i <= steps; i++) {
+            const float offset = step * i;
+            const bool center = i == 0;
+            if (center ? (key.flags & 2u) : (key.flags & 1u)) {
+                vertices.push_back(helperVertex(-half, 0, offset, color));
+                vertices.push_back(helperVertex(half, 0, offset, color));
+            }
+            if (center ? (key.flags & 2u) : (key.flags & 4u)) {
+                vertices.push_back(helperVertex(offset, 0, -half, color));
+                vertices.push_back(helperVertex(offset, 0, half, color));
+            }
         }
+        submit3DGeometry(vertices, {}, render::PrimitiveType::Line);
     }
-}
 
-void ofDrawIcoSphere(float radius, int subdivisions) {
-    ofDrawIcoSphere(0.0f, 0.0f, 0.0f, radius, subdivisions);
-}
+    void buildGridPlane(const HelperKey& key) {
+        const auto& state = getGraphicsState();
+        const simd_float4 color = colorToFloat4(state.currentColor[0], state.currentColor[1],
+                                                state.currentColor[2], state.currentColor[3]);
+        const float width = key.params[0];
+        const float height = key.params[1];
+        const int columns = static_cast<int>(key.counts[0]);
+        const int rows = static_cast<int>(key.counts[1]);
+        const float halfWidth = width * 0.5f;
+        const float halfHeight = height * 0.5f;
 
-// ============================================================================
-// 3D Helper Functions Implementation
-// ============================================================================
+        std::vector<render::Vertex3D> vertices;
+        vertices.reserve((columns + rows + 2) * 2);
 
-void ofDrawAxis(float size) {
-    // TODO: Implement 3D axis drawing
-    // Draw three lines from origin:
-    // - X axis: Red line from (0,0,0) to (size,0,0)
-    // - Y axis: Green line from (0,0,0) to (0,size,0)
-    // - Z axis: Blue line from (0,0,0) to (0,0,size)
+        // Lines parallel to X axis (along Z direction)
+        for (int i = 0; i <= rows; i++) {
+            const float zPos = -halfHeight + i * (height / rows);
+            vertices.push_back(helperVertex(-halfWidth, 0, zPos, color));
+            vertices.push_back(helperVertex(halfWidth, 0, zPos, color));
+        }
 
-    // Save current color
-    auto& state = getGraphicsState();
-    uint8_t savedColor[4];
-    std::copy(state.currentColor, state.currentColor + 4, savedColor);
+        // Lines parallel to Z axis (along X direction)
+        for (int i = 0; i <= columns; i++) {
+            const float xPos = -halfWidth + i * (width / columns);
+            vertices.push_back(helperVertex(xPos, 0, -halfHeight, color));
+            vertices.push_back(helperVertex(xPos, 0, halfHeight, color));
+        }
+        submit3DGeometry(vertices, {}, render::PrimitiveType::Line);
+    }
+
+    // Each axis is a strip of two crossed quads (visible from any side) with
+    // a crossed triangle head, red/green/blue for X/Y/Z
+    void buildRotationAxes(const HelperKey& key) {
+        const float radius = key.params[0];
+        const float half = key.params[1] * 0.5f;
+        const float headLength = radius * 0.15f;
+        const float headHalf = std::max(half * 3.0f, radius * 0.03f);
+        const float shaft = radius - headLength;
+
+        std::vector<render::Vertex3D> vertices;
+        std::vector<uint32_t> indices;
+        vertices.reserve(3 * 14);
+        indices.reserve(3 * 18);
+        for (int axis = 0; axis < 3; axis++) {
+            simd_float4 color = simd_make_float4(0, 0, 0, 1);
+            color[axis] = 1.0f;
+
+            // Position along the axis and across the two perpendicular axes
+            auto point = [&](float along, float acrossA, float acrossB) {
+                float p[3];
+                p[axis] = along;
+                p[(axis + 1) % 3] = acrossA;
+                p[(axis + 2) % 3] = acrossB;
+                return helperVertex(p[0], p[1], p[2], color);
+            };
+            for (int plane = 0; plane < 2; plane++) {
+                float n[3] = {0, 0, 0};
+                n[(axis + 2 - plane) % 3] = 1.0f;
+                auto cross = [&](float along, float across) {
+                    render::Vertex3D v = plane == 0 ? point(along, across, 0) : point(along, 0, across);
+                    v.normal = simd_make_float3(n[0], n[1], n[2]);
+                    return v;
+                };
+                const uint32_t base = static_cast<uint32_t>(vertices.size());
+                vertices.push_back(cross(0, -half));
+                vertices.push_back(cross(shaft, -half));
+                vertices.push_back(cross(shaft, half));
+                vertices.push_back(cross(0, half));
+                vertices.push_back(cross(shaft, -headHalf));
+                vertices.push_back(cross(radius, 0));
+                vertices.push_back(cross(shaft, headHalf));
+                const uint32_t quad[9] = {0, 1, 2, 0, 2, 3, 4, 5, 6};
+                for (uint32_t index : quad) {
+                    indices.push_back(base + index);
+                }
+            }
+        }
 
-    // X axis - red
-    ofSetColor(255, 0, 0);
-    ofDrawLine(0.0f, 0.0f, 0.0f, size, 0.0f, 0.0f);
+        // Crossed planes face both ways
+        auto& state = getGraphicsState();
+        const bool culling = state.cullingEnabled;
+        state.cullingEnabled = false;
+        submit3DGeometry(vertices, indices);
+        state.cullingEnabled = culling;
+    }
+
+    // Replay the cached recording of a helper, recording it on first use
+    void drawHelper(const HelperKey& key, void (*build)(const HelperKey&)) {
+        auto& cache = getHelperCache();
+        const unsigned long long frame = Context::instance().getFrameNum();
+        for (CachedHelper& entry : cache) {
+            if (entry.key == key) {
+                entry.lastFrame = frame;
+                entry.list.draw();
+                return;
+            }
+        }
 
-    // Y axis - green
-    ofSetColor(0, 255, 0);
-    ofDrawLine(0.0f, 0.0f, 0.0f, 0.0f, size, 0.0f);
+        if (cache.size() >= kMaxCachedHelpers) {
+            cache.erase(std::remove_if(cache.begin(), cache.end(), [frame](const CachedHelper& entry) {
+                            return frame - entry.lastFrame > kHelperRetainFrames;
+                        }),
+                        cache.end());
+        }
+        if (cache.size() >= kMaxCachedHelpers) {
+            // Every entry is still in use; draw this one directly
+            build(key);
+            return;
+        }
 
-    // Z axis - blue
-    ofSetColor(0, 0, 255);
-    ofDrawLine(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, size);
+        cache.emplace_back();
+        CachedHelper& entry = cache.back();
+        entry.key = key;
+        entry.lastFrame = frame;
+        entry.list.begin();
+        build(key);
+        entry.list.end();
+        entry.list.draw();
+    }
+}
 
-    // Restore color
-    std::copy(savedColor, savedColor + 4, state.currentColor);
+void ofDrawAxis(float size) {
+    HelperKey key = makeHelperKey(getGraphicsState(), HelperGeometry::Axis);
+    key.color = 0;   // Fixed axis colors
+    key.params[0] = size;
+    drawHelper(key, buildAxis);
 }
 
 void ofDrawGrid(float stepSize, size_t numberOfSteps, bool labels, bool x, bool y, bool z) {
-    // TODO: Implement 3D grid drawing on XZ plane
-    // Grid extends from (-width/2, 0, -height/2) to (width/2, 0, height/2)
-    // where width = height = stepSize * numberOfSteps * 2
+    // Labels need text rendering in 3D, which the helpers don't do
+    (void)labels;
+    if (numberOfSteps == 0 || (!x && !y && !z)) {
+        return;
+    }
 
-    (void)stepSize; (void)numberOfSteps;
-    (void)labels; (void)x; (void)y; (void)z;
+    HelperKey key = makeHelperKey(getGraphicsState(), HelperGeometry::Grid);
+    key.params[0] = stepSize;
+    key.counts[0] = static_cast<uint32_t>(numberOfSteps);
+    key.flags = (x ? 1u : 0u) | (y ? 2u : 0u) | (z ? 4u : 0u);
+    drawHelper(key, buildGrid);
 }
 
 void ofDrawGrid(float stepSize, size_t numberOfSteps, bool labels) {
@@ -1948,36 +3197,23 @@ void ofDrawGrid(float stepSize, size_t numberOfSteps, bool labels) {
 }
 
 void ofDrawGrid(float x, float y, float z, float stepSize, size_t numberOfSteps, bool labels, bool xLines, bool yLines, bool zLines) {
-    // TODO: Implement 3D grid drawing at position
-    // Save current matrix, translate to (x,y,z), draw grid, restore matrix
-
-    (void)x; (void)y; (void)z;
-    (void)stepSize; (void)numberOfSteps;
-    (void)labels; (void)xLines; (void)yLines; (void)zLines;
+    ofPushMatrix();
+    ofTranslate(x, y, z);
+    ofDrawGrid(stepSize, numberOfSteps, labels, xLines, yLines, zLines);
+    ofPopMatrix();
 }
 
 void ofDrawGridPlane(float width, float height, int columns, int rows) {
-    // TODO: Implement simple grid plane on XZ
-    // Draw a grid with specified width/height and column/row divisions
-    // Grid lines parallel to X and Z axes
-
-    float columnStep = width / columns;
-    float rowStep = height / rows;
-
-    float halfWidth = width * 0.5f;
-    float halfHeight = height * 0.5f;
-
-    // Lines parallel to X axis (along Z direction)
-    for (int i = 0; i <= rows; i++) {
-        float zPos = -halfHeight + i * rowStep;
-        ofDrawLine(-halfWidth, 0.0f, zPos, halfWidth, 0.0f, zPos);
+    if (columns <= 0 || rows <= 0) {
+        return;
     }
 
-    // Lines parallel to Z axis (along X direction)
-    for (int i = 0; i <= columns; i++) {
-        float xPos = -halfWidth + i * columnStep;
-        ofDrawLine(xPos, 0.0f, -halfHeight, xPos, 0.0f, halfHeight);
-    }
+    HelperKey key = makeHelperKey(getGraphicsState(), HelperGeometry::GridPlane);
+    key.params[0] = width;
+    key.params[1] = height;
+    key.counts[0] = static_cast<uint32_t>(columns);
+    key.counts[1] = static_cast<uint32_t>(rows);
+    drawHelper(key, buildGridPlane);
 }
 
 void ofDrawGridPlane(int columns, int rows) {
@@ -2009,16 +3245,18 @@ void ofDrawArrow(const oflike::ofVec3f& start, const oflike::ofVec3f& end, float
 }
 
 void ofDrawRotationAxes(float radius, float stripWidth) {
-    // TODO: Implement rotation axes visualization
-    // Draw three colored arrows showing orientation:
-    // - Red arrow: X axis direction (1,0,0) transformed by current matrix
-    // - Green arrow: Y axis direction (0,1,0) transformed by current matrix
-    // - Blue arrow: Z axis direction (0,0,1) transformed by current matrix
+    HelperKey key = makeHelperKey(getGraphicsState(), HelperGeometry::RotationAxes);
+    key.color = 0;   // Fixed axis colors
+    key.params[0] = radius;
+    key.params[1] = stripWidth;
 
-    (void)radius; (void)stripWidth;
-
-    // For now, just draw standard axes
-    ofDrawAxis(radius);
+    // Lit strips follow the lights each frame instead of the recording
+    Context& ctx = Context::instance();
+    if (ctx.hasMaterial() && ctx.isLightingEnabled()) {
+        buildRotationAxes(key);
+        return;
+    }
+    drawHelper(key, buildRotationAxes);
 }
 
 // ============================================================================
@@ -2090,6 +3328,93 @@ void ofDisableCulling() {
     }
 }
 
+void ofEnableFrustumCulling() {
+    getGraphicsState().frustumCullingEnabled = true;
+}
+
+void ofDisableFrustumCulling() {
+    getGraphicsState().frustumCullingEnabled = false;
+}
+
+bool ofGetFrustumCullingEnabled() {
+    return getGraphicsState().frustumCullingEnabled;
+}
+
+void ofEnableOcclusionCulling() {
+    getGraphicsState().occlusionCullingEnabled = true;
+
+    auto* renderer = ctx().renderer();
+    if (renderer) {
+        renderer->setOcclusionCullingEnabled(true);
+    }
+}
+
+void ofDisableOcclusionCulling() {
+    getGraphicsState().occlusionCullingEnabled = false;
+
+    auto* renderer = ctx().renderer();
+    if (renderer) {
+        renderer->setOcclusionCullingEnabled(false);
+    }
+}
+
+bool ofGetOcclusionCullingEnabled() {
+    return getGraphicsState().occlusionCullingEnabled;
+}
+
+void ofSetTextureUploadBudget(size_t bytes) {
+    auto* renderer = ctx().renderer();
+    if (renderer) {
+        renderer->setTextureUploadBudget(bytes);
+    }
+}
+
+size_t ofGetTextureUploadBudget() {
+    auto* renderer = ctx().renderer();
+    return renderer ? renderer->getTextureUploadBudget() : 0;
+}
+
+void ofEnableOrderIndependentTransparency() {
+    getGraphicsState().orderIndependentTransparency = true;
+}
+
+void ofDisableOrderIndependentTransparency() {
+    getGraphicsState().orderIndependentTransparency = false;
+}
+
+bool ofGetOrderIndependentTransparencyEnabled() {
+    return getGraphicsState().orderIndependentTransparency;
+}
+
+void ofSetObjectId(uint32_t objectId) {
+    getGraphicsState().objectId = objectId;
+}
+
+uint32_t ofGetObjectId() {
+    return getGraphicsState().objectId;
+}
+
+void ofRequestObjectIdPick(float x, float y) {
+    auto* renderer = ctx().renderer();
+    const int width = ctx().getWidth();
+    const int height = ctx().getHeight();
+    if (renderer && width > 0 && height > 0) {
+        renderer->requestObjectIdPick(x / width, y / height);
+    }
+}
+
+bool ofGetObjectIdPick(uint32_t& objectId, uint64_t* frameSerial) {
+    auto* renderer = ctx().renderer();
+    uint64_t serial = 0;
+    if (!renderer || !renderer->getObjectIdPick(objectId, serial)) {
+        return false;
+    }
+    if (frameSerial) {
+        *frameSerial = serial;
+    }
+    return true;
+}
+
 // ============================================================================
 // Lighting Implementation
 // ============================================================================
@@ -2121,3 +3446,31 @@ void ofSetSmoothLighting(bool smooth) {
     // TODO: Update renderer state when shader integration is complete
     // This will switch between smooth (Phong) and flat shading
 }
+
+// ============================================================================
+// Batching
+// ============================================================================
+
+void ofEnableTransformBatching(uint32_t maxVertices) {
+    Context::instance().getDrawList().setTransformBaking(true, maxVertices);
+}
+
+void ofDisableTransformBatching() {
+    Context::instance().getDrawList().setTransformBaking(false);
+}
+
+void ofEnableTextureBatching() {
+    Context::instance().getDrawList().setTextureBatching(true);
+}
+
+void ofDisableTextureBatching() {
+    Context::instance().getDrawList().setTextureBatching(false);
+}
+
+void ofEnableVertexCompression() {
+    Context::instance().getDrawList().setVertexCompression(true);
+}
+
+void ofDisableVertexCompression() {
+    Context::instance().getDrawList().setVertexCompression(false);
+}
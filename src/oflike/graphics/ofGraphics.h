@@ -5,7 +5,11 @@
 
 // Forward declarations
 namespace oflike {
+    class ofVec2f;
     class ofVec3f;
+    class ofPolyline;
+    template<typename PixelType> class ofColor_;
+    using ofColor = ofColor_<uint8_t>;
 }
 
 // ============================================================================
@@ -26,6 +30,33 @@ enum {
     OF_BLENDMODE_DIFFERENCE = 10,   ///< Difference blending
 };
 
+// ============================================================================
+// Stroke Style Constants
+// ============================================================================
+
+/// Line join styles for strokes wider than one pixel
+enum ofStrokeJoin {
+    OF_STROKE_JOIN_MITER = 0,       ///< Sharp corners, beveled past the miter limit (default)
+    OF_STROKE_JOIN_ROUND = 1,       ///< Rounded corners
+    OF_STROKE_JOIN_BEVEL = 2,       ///< Cut-off corners
+};
+
+/// Line cap styles for the open ends of strokes wider than one pixel
+enum ofStrokeCap {
+    OF_STROKE_CAP_BUTT = 0,         ///< End exactly at the end point (default)
+    OF_STROKE_CAP_ROUND = 1,        ///< Half circle past the end point
+    OF_STROKE_CAP_SQUARE = 2,       ///< Half the line width past the end point
+};
+
+/// Fill rules for tessellated shapes (ofBeginShape/ofEndShape, ofPath)
+enum ofPolyWindingMode {
+    OF_POLY_WINDING_ODD = 0,        ///< Inside if crossed an odd number of times (default)
+    OF_POLY_WINDING_NONZERO = 1,    ///< Inside if the winding number is not zero
+    OF_POLY_WINDING_POSITIVE = 2,   ///< Inside if the winding number is positive
+    OF_POLY_WINDING_NEGATIVE = 3,   ///< Inside if the winding number is negative
+    OF_POLY_WINDING_ABS_GEQ_TWO = 4,///< Inside if |winding number| >= 2
+};
+
 // ============================================================================
 // ofGraphics - openFrameworks Compatible Graphics API
 // ============================================================================
@@ -176,6 +207,8 @@ bool ofGetFill();
 
 /**
  * Set the line width for stroke drawing.
+ * Widths above 1 are drawn by the GPU stroker: lines, polylines and shape
+ * outlines expand into quads with joins and caps in the vertex shader.
  * @param width Line width in pixels (default: 1.0)
  */
 void ofSetLineWidth(float width);
@@ -186,6 +219,38 @@ void ofSetLineWidth(float width);
  */
 float ofGetLineWidth();
 
+/**
+ * Set how wide strokes join at polyline corners.
+ * @param join OF_STROKE_JOIN_MITER, OF_STROKE_JOIN_ROUND or OF_STROKE_JOIN_BEVEL
+ */
+void ofSetStrokeJoin(ofStrokeJoin join);
+
+/**
+ * Get the current stroke join style.
+ * @return Current join style
+ */
+ofStrokeJoin ofGetStrokeJoin();
+
+/**
+ * Set how wide strokes end at open line ends.
+ * @param cap OF_STROKE_CAP_BUTT, OF_STROKE_CAP_ROUND or OF_STROKE_CAP_SQUARE
+ */
+void ofSetStrokeCap(ofStrokeCap cap);
+
+/**
+ * Get the current stroke cap style.
+ * @return Current cap style
+ */
+ofStrokeCap ofGetStrokeCap();
+
+/**
+ * Set the miter limit for OF_STROKE_JOIN_MITER.
+ * Corners whose miter would reach further than limit * (line width / 2)
+ * from the corner point are beveled instead.
+ * @param limit Miter limit (default: 4.0)
+ */
+void ofSetMiterLimit(float limit);
+
 /**
  * Set the circle resolution (number of segments).
  * Higher values = smoother circles, but slower rendering.
@@ -211,6 +276,43 @@ void ofSetCurveResolution(uint32_t resolution);
  */
 uint32_t ofGetCurveResolution();
 
+/**
+ * Flatten curves adaptively to a screen-space tolerance instead of a fixed
+ * resolution. Each Bezier or Catmull-Rom span then gets just enough
+ * segments to stay within the tolerance under the current transform's
+ * scale, so small curves get few vertices and large ones enough to look
+ * smooth. Applies to ofDrawBezier/ofDrawCurve and to ofPolyline/ofPath
+ * curves (flattened under the transform current when they are added).
+ * @param pixels Max distance from the true curve in pixels (0 = use ofSetCurveResolution, the default)
+ */
+void ofSetCurveTolerance(float pixels);
+
+/**
+ * Get the current curve flattening tolerance.
+ * @return Tolerance in pixels, 0 when the fixed curve resolution is used
+ */
+float ofGetCurveTolerance();
+
+/**
+ * Segments used to flatten a cubic Bezier span: the curve resolution, or
+ * with a curve tolerance set, the fewest keeping it within the tolerance.
+ * @param p0 Start point
+ * @param cp1 First control point
+ * @param cp2 Second control point
+ * @param p1 End point
+ * @return Number of line segments (at least 1)
+ */
+uint32_t ofGetBezierSegments(const oflike::ofVec3f& p0, const oflike::ofVec3f& cp1,
+                             const oflike::ofVec3f& cp2, const oflike::ofVec3f& p1);
+
+/**
+ * Segments used to flatten a Catmull-Rom span from p1 to p2 (see
+ * ofGetBezierSegments()).
+ * @return Number of line segments (at least 1)
+ */
+uint32_t ofGetCurveSegments(const oflike::ofVec3f& p0, const oflike::ofVec3f& p1,
+                            const oflike::ofVec3f& p2, const oflike::ofVec3f& p3);
+
 /**
  * Set the sphere resolution (lat/lon segments).
  * @param resolution Number of segments (default: 20)
@@ -223,6 +325,26 @@ void ofSetSphereResolution(uint32_t resolution);
  */
 uint32_t ofGetSphereResolution();
 
+/**
+ * Draw circles, ellipses, rounded rectangles and thick lines as analytic
+ * signed-distance shapes.
+ * Each shape becomes one quad whose anti-aliased coverage is computed per
+ * pixel, so edges stay smooth at any size and cost the same at any
+ * circle resolution. Outlines (ofNoFill) use the line width. Off by default.
+ */
+void ofEnableSDFShapes();
+
+/**
+ * Draw shapes as tessellated triangle fans and 1-pixel lines (default).
+ */
+void ofDisableSDFShapes();
+
+/**
+ * Check if SDF shape drawing is enabled.
+ * @return true if shapes are drawn as SDF quads
+ */
+bool ofGetSDFShapesEnabled();
+
 // ============================================================================
 // Drawing State Query
 // ============================================================================
@@ -389,6 +511,16 @@ void ofDrawLine(float x1, float y1, float x2, float y2);
  */
 void ofDrawLine(float x1, float y1, float z1, float x2, float y2, float z2);
 
+/**
+ * Draw connected line segments through a list of points.
+ * Wide lines (ofSetLineWidth > 1) are stroked with the current join and
+ * cap style as one draw; Z is ignored like in ofDrawLine.
+ * @param points Pointer to point array
+ * @param count Number of points
+ * @param closed Connect the last point back to the first
+ */
+void ofDrawPolyline(const oflike::ofVec3f* points, size_t count, bool closed = false);
+
 /**
  * Draw a rectangle.
  * @param x X coordinate of top-left corner
@@ -459,6 +591,80 @@ void ofDrawTriangle(float x1, float y1, float x2, float y2, float x3, float y3);
  */
 void ofDrawTriangle(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3);
 
+// ============================================================================
+// Bulk Shape Drawing
+// ============================================================================
+
+/**
+ * Draw many circles in one call.
+ * Equivalent to calling ofDrawCircle() per item with the current fill,
+ * line width and SDF settings, but state is read and the transform
+ * converted once, and all geometry is generated straight into the draw
+ * list as a single draw command.
+ * @param centers Pointer to count circle centers
+ * @param radii Pointer to count radii
+ * @param count Number of circles
+ * @param colors Optional per-circle colors (nullptr: current color)
+ */
+void ofDrawCircles(const oflike::ofVec2f* centers, const float* radii, size_t count,
+                   const oflike::ofColor* colors = nullptr);
+
+/**
+ * Draw many rectangles in one call (see ofDrawCircles()).
+ * @param positions Pointer to count top-left corners
+ * @param sizes Pointer to count sizes (width, height)
+ * @param count Number of rectangles
+ * @param colors Optional per-rectangle colors (nullptr: current color)
+ */
+void ofDrawRectangles(const oflike::ofVec2f* positions, const oflike::ofVec2f* sizes, size_t count,
+                      const oflike::ofColor* colors = nullptr);
+
+/**
+ * Draw many independent line segments in one call (see ofDrawCircles()).
+ * Wide lines use the current cap style; there are no joins between items.
+ * @param starts Pointer to count segment start points
+ * @param ends Pointer to count segment end points
+ * @param count Number of segments
+ * @param colors Optional per-segment colors (nullptr: current color)
+ */
+void ofDrawLines(const oflike::ofVec2f* starts, const oflike::ofVec2f* ends, size_t count,
+                 const oflike::ofColor* colors = nullptr);
+
+/**
+ * Draw many polylines in one call (see ofDrawCircles()).
+ * Thin lines become one indexed line list, wide ones one stroke draw with
+ * the current join and cap style; Z is ignored like in ofDrawPolyline.
+ * @param polylines Pointer to count polylines (closed ones are drawn closed)
+ * @param count Number of polylines
+ * @param colors Optional per-polyline colors (nullptr: current color)
+ */
+void ofDrawPolylines(const oflike::ofPolyline* polylines, size_t count,
+                     const oflike::ofColor* colors = nullptr);
+
+/**
+ * Draw an indexed triangle list in the current color as one command, for
+ * prebuilt fills such as ofPath tessellations. Z is ignored.
+ * @param vertices Pointer to vertexCount vertices
+ * @param vertexCount Number of vertices
+ * @param indices Pointer to indexCount indices into vertices, 3 per triangle
+ * @param indexCount Number of indices
+ */
+void ofDrawTriangles(const oflike::ofVec3f* vertices, size_t vertexCount,
+                     const uint32_t* indices, size_t indexCount);
+
+/**
+ * Fill the area enclosed by contours in the current color, with coverage
+ * computed on the GPU from the contours' edges under a winding rule.
+ * Nothing is triangulated, so contours may change every frame at the cost
+ * of flattening them; per-pixel cost grows with the number of edges, and
+ * consecutive fills share one draw. Every contour is closed; Z is ignored.
+ * @param contours Pointer to count contours of one shape
+ * @param count Number of contours
+ * @param mode Winding rule deciding which areas are inside
+ */
+void ofDrawPathFill(const oflike::ofPolyline* contours, size_t count,
+                    ofPolyWindingMode mode = OF_POLY_WINDING_ODD);
+
 // ============================================================================
 // Curve Drawing
 // ============================================================================
@@ -643,6 +849,43 @@ void ofBezierVertex(float cx1, float cy1, float cz1, float cx2, float cy2, float
  */
 void ofNextContour();
 
+/**
+ * Set the fill rule used when ofEndShape() tessellates filled shapes.
+ * @param mode Winding mode (default OF_POLY_WINDING_ODD)
+ */
+void ofSetPolyMode(ofPolyWindingMode mode);
+
+/**
+ * Get the current shape fill rule.
+ * @return Winding mode
+ */
+ofPolyWindingMode ofGetPolyMode();
+
+/**
+ * Cache ofEndShape() tessellations between calls.
+ * Filled shapes are keyed by their vertex/contour stream, close flag,
+ * winding mode and curve resolution; a repeat of the same shape (static
+ * logos, UI) reuses the cached triangles and index buffer instead of
+ * re-running the tessellator. Outlines are unaffected. Off by default.
+ */
+void ofEnableShapeCache();
+
+/**
+ * Stop caching ofEndShape() tessellations and free the cache.
+ */
+void ofDisableShapeCache();
+
+/**
+ * Check if ofEndShape() tessellations are cached.
+ * @return true if the shape cache is enabled
+ */
+bool ofGetShapeCacheEnabled();
+
+/**
+ * Drop all cached ofEndShape() tessellations (keeps the cache enabled).
+ */
+void ofClearShapeCache();
+
 // ============================================================================
 // Blend Mode
 // ============================================================================
@@ -797,6 +1040,10 @@ void ofDrawIcoSphere(float radius, int subdivisions = 2);
 // 3D Helper Functions
 // ============================================================================
 
+// Axes, grids and rotation axes are recorded once per parameter set (and
+// color/blend/depth state) and replayed from resident GPU geometry, so each
+// call costs one draw command per frame (see ofDisplayList).
+
 /**
  * Draw 3D coordinate axes at origin.
  * Draws three colored lines representing X (red), Y (green), and Z (blue) axes.
@@ -805,13 +1052,13 @@ void ofDrawIcoSphere(float radius, int subdivisions = 2);
 void ofDrawAxis(float size = 1.0f);
 
 /**
- * Draw a 3D grid on the XZ plane.
- * Grid extends from (-width/2, 0, -height/2) to (width/2, 0, height/2).
+ * Draw a 3D grid on the XZ plane in the current color.
+ * Grid extends stepSize * numberOfSteps from the center in X and Z.
  * @param stepSize Spacing between grid lines
  * @param numberOfSteps Number of steps in each direction from center
- * @param labels If true, draw axis labels (default: false)
+ * @param labels Accepted for compatibility; labels are not drawn
  * @param x If true, draw lines parallel to X axis (default: true)
- * @param y If true, draw horizontal center line (default: true)
+ * @param y If true, draw the center lines through the origin (default: true)
  * @param z If true, draw lines parallel to Z axis (default: true)
  */
 void ofDrawGrid(float stepSize = 1.0f, size_t numberOfSteps = 8, bool labels = false, bool x = true, bool y = true, bool z = true);
@@ -820,7 +1067,7 @@ void ofDrawGrid(float stepSize = 1.0f, size_t numberOfSteps = 8, bool labels = f
  * Draw a 3D grid on the XZ plane (simplified version).
  * @param stepSize Spacing between grid lines
  * @param numberOfSteps Number of steps in each direction from center
- * @param labels If true, draw axis labels (default: false)
+ * @param labels Accepted for compatibility; labels are not drawn
  */
 void ofDrawGrid(float stepSize, size_t numberOfSteps, bool labels);
 
@@ -831,15 +1078,15 @@ void ofDrawGrid(float stepSize, size_t numberOfSteps, bool labels);
  * @param z Z position of grid center
  * @param stepSize Spacing between grid lines
  * @param numberOfSteps Number of steps in each direction from center
- * @param labels If true, draw axis labels (default: false)
+ * @param labels Accepted for compatibility; labels are not drawn
  * @param xLines If true, draw lines parallel to X axis (default: true)
- * @param yLines If true, draw horizontal center line (default: true)
+ * @param yLines If true, draw the center lines through the origin (default: true)
  * @param zLines If true, draw lines parallel to Z axis (default: true)
  */
 void ofDrawGrid(float x, float y, float z, float stepSize, size_t numberOfSteps, bool labels = false, bool xLines = true, bool yLines = true, bool zLines = true);
 
 /**
- * Draw a simple grid plane on XZ plane.
+ * Draw a simple grid plane on XZ plane in the current color.
  * Convenience function for drawing a basic grid.
  * @param width Total width of grid (X dimension)
  * @param height Total depth of grid (Z dimension)
@@ -867,10 +1114,11 @@ void ofDrawArrow(const oflike::ofVec3f& start, const oflike::ofVec3f& end, float
 
 /**
  * Draw rotation axes showing current transformation orientation.
- * Draws three colored arrows (RGB for XYZ) at the specified position
- * showing the orientation of the current transformation matrix.
+ * Draws three colored arrows (RGB for XYZ) at the origin of the current
+ * transformation, showing its orientation. Drawn directly (not cached)
+ * while lighting is enabled, so the strips follow the current lights.
  * @param radius Length of each axis arrow
- * @param stripWidth Width of the axis lines (default: 0.01)
+ * @param stripWidth Width of the axis strips (default: 0.01)
  */
 void ofDrawRotationAxes(float radius, float stripWidth = 0.01f);
 
@@ -929,6 +1177,129 @@ void ofEnableCulling();
  */
 void ofDisableCulling();
 
+/**
+ * Enable view frustum culling of mesh draws.
+ * ofMesh, VboMesh and of3dPrimitive draws whose bounds lie entirely outside
+ * the current camera's view are skipped before they are recorded. Instanced
+ * and indirect VboMesh draws are not affected (see VboMesh::cullInstances).
+ * Default state: enabled.
+ */
+void ofEnableFrustumCulling();
+
+/**
+ * Disable view frustum culling.
+ * Needed when a vertex shader moves geometry outside its mesh bounds.
+ */
+void ofDisableFrustumCulling();
+
+/**
+ * Check if mesh draws are frustum-culled.
+ * @return true if frustum culling is enabled
+ */
+bool ofGetFrustumCullingEnabled();
+
+/**
+ * Enable occlusion culling of GPU-culled instances.
+ * At the end of each frame the screen's depth is reduced to a depth pyramid;
+ * VboMesh::cullInstances() then also drops instances hidden behind what the
+ * previous frame drew there. Culling a frame late can leave an instance
+ * missing for one frame when the view or its occluders move quickly.
+ * Needs single-sampled screen depth; other draws are not affected.
+ * Default state: disabled.
+ */
+void ofEnableOcclusionCulling();
+
+/**
+ * Disable occlusion culling.
+ * VboMesh::cullInstances() is frustum culling only again.
+ */
+void ofDisableOcclusionCulling();
+
+/**
+ * Check if GPU instance culling also tests occlusion.
+ * @return true if occlusion culling is enabled
+ */
+bool ofGetOcclusionCullingEnabled();
+
+/**
+ * Set the staging memory for texture uploads.
+ * Textures not in streaming mode live in GPU-only memory; their pixels are
+ * packed into staging batches of this size and copied by one blit before
+ * the frame's first pass. A batch that fills up is copied at once, so a
+ * frame uploading more than the budget issues more copies and more staging
+ * memory is in flight, but no upload waits for a later frame.
+ * Default: 32 MB (minimum 1 MB).
+ * @param bytes Staging batch size in bytes
+ */
+void ofSetTextureUploadBudget(size_t bytes);
+
+/**
+ * Get the staging batch size for texture uploads.
+ * @return Batch size in bytes, or 0 without a renderer
+ */
+size_t ofGetTextureUploadBudget();
+
+/**
+ * Enable order-independent transparency for 3D draws.
+ * Alpha-blended 3D draws recorded while enabled need no back-to-front
+ * sorting: they accumulate into weighted blended transparency targets and
+ * are composited over the pass before anything drawn over them (2D, draws
+ * without depth test, clears, target switches) and at the end of the frame.
+ * They test against the depth of the opaque geometry but never write it.
+ * Enable it only around transparent geometry: opaque alpha-mode draws inside
+ * the bracket are composited as transparent layers too.
+ * Default state: disabled.
+ */
+void ofEnableOrderIndependentTransparency();
+
+/**
+ * Disable order-independent transparency.
+ * Alpha-blended 3D draws blend in submission order again.
+ */
+void ofDisableOrderIndependentTransparency();
+
+/**
+ * Check if order-independent transparency is enabled.
+ * @return true if alpha-blended 3D draws are order-independent
+ */
+bool ofGetOrderIndependentTransparencyEnabled();
+
+/**
+ * Set the object ID stamped on the 3D draws that follow.
+ * On frames with a pick request (ofRequestObjectIdPick()) the screen's 3D
+ * draws are drawn again into an ID buffer with their IDs, so the object
+ * under the mouse is found on the GPU without a CPU ray cast. Instanced
+ * draws share one ID.
+ * Default: 0 (no object).
+ * @param objectId ID for the following meshes, VBOs and primitives
+ */
+void ofSetObjectId(uint32_t objectId);
+
+/**
+ * Get the object ID stamped on 3D draws.
+ * @return Current object ID
+ */
+uint32_t ofGetObjectId();
+
+/**
+ * Pick the object drawn at a window position in this frame.
+ * Only frames with a request pay for the ID buffer. The result appears in
+ * ofGetObjectIdPick() when the frame has finished on the GPU, typically
+ * a frame or two later; the CPU never waits for it.
+ * @param x Window x (same units as mouseX)
+ * @param y Window y (same units as mouseY)
+ */
+void ofRequestObjectIdPick(float x, float y);
+
+/**
+ * Get the result of the most recent completed pick.
+ * @param objectId Receives the frontmost object ID at the position, 0 if none
+ * @param frameSerial Optional: receives the serial of the frame it was
+ *        read from, to tell a new result from the previous one
+ * @return false until the first pick completes
+ */
+bool ofGetObjectIdPick(uint32_t& objectId, uint64_t* frameSerial = nullptr);
+
 // ============================================================================
 // Lighting
 // ============================================================================
@@ -960,3 +1331,58 @@ bool ofGetLightingEnabled();
  * @param smooth If true, use smooth shading; if false, use flat shading
  */
 void ofSetSmoothLighting(bool smooth);
+
+// ============================================================================
+// Batching
+// ============================================================================
+
+/**
+ * Enable transform batching for 2D shapes.
+ * Small shapes drawn under different 2D transforms (ofTranslate/ofRotateZ/
+ * ofScale per shape) are baked into world space on the CPU so that a run of
+ * them is submitted as a single draw call.
+ * Default state: disabled.
+ * @param maxVertices Largest shape (in vertices) that is baked
+ */
+void ofEnableTransformBatching(uint32_t maxVertices = 64);
+
+/**
+ * Disable transform batching.
+ * Only draws with identical transforms are merged.
+ */
+void ofDisableTransformBatching();
+
+/**
+ * Enable texture batching for 2D draws.
+ * Consecutive textured draws that differ only in their texture (e.g. many
+ * sprites with their own ofImage) share one draw call; up to 16 textures
+ * are bound together and each vertex samples its own. Draws must use the
+ * same blend mode and sampler settings.
+ * Default state: disabled.
+ */
+void ofEnableTextureBatching();
+
+/**
+ * Disable texture batching.
+ * Only draws with the same texture are merged.
+ */
+void ofDisableTextureBatching();
+
+/**
+ * Enable packed vertex formats.
+ * Draws whose colors and texture coordinates lie in 0-1 (and normals in
+ * -1..1 for lit 3D draws) are stored with 8-bit colors, 16-bit texture
+ * coordinates and 16-bit normals, roughly halving vertex memory and
+ * bandwidth; other draws keep full floats. Positions are never compressed.
+ * Geometry is then uploaded after the frame instead of being written in
+ * place, so enable it in setup(); display lists recorded while it is
+ * enabled are packed as well.
+ * Default state: disabled.
+ */
+void ofEnableVertexCompression();
+
+/**
+ * Disable packed vertex formats.
+ * All vertices keep full float precision.
+ */
+void ofDisableVertexCompression();
@@ -0,0 +1,36 @@
+#pragma once
+
+// oflike-metal ofGraphicsTransform - cached simd views of the matrix stack
+// For code that records draw commands (ofMesh, ofTexture, fonts, ...);
+// kept out of ofGraphics.h so sketches don't pull in <simd/simd.h>
+
+#include <simd/simd.h>
+
+// ============================================================================
+// Cached Transform Matrices
+// ============================================================================
+
+/**
+ * Get the current model matrix (ofPushMatrix/ofTranslate/ofRotate/... stack)
+ * as a simd matrix.
+ * Converted once after each change to the stack, not per draw.
+ * @return Reference valid until the next matrix stack call on this thread
+ */
+const simd_float4x4& ofGetCurrentModelMatrix();
+
+/**
+ * Get view * model for the current Context view matrix.
+ * Recomputed only when the matrix stack or the view matrix has changed
+ * since the last call.
+ * @return Reference valid until the next matrix stack call on this thread
+ */
+const simd_float4x4& ofGetCurrentModelViewMatrix();
+
+/**
+ * Get the normal matrix for the current model-view matrix: the inverse
+ * transpose of its upper-left 3x3, so normals stay perpendicular under
+ * non-uniform scale.
+ * Computed lazily on first use after a change; only lit draws need it.
+ * @return Reference valid until the next matrix stack call on this thread
+ */
+const simd_float3x3& ofGetCurrentNormalMatrix();
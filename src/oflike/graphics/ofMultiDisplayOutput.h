@@ -0,0 +1,153 @@
+#pragma once
+
+// oflike-metal ofMultiDisplayOutput - one scene across several displays
+// The scene is drawn once into an atlas; each display shows its slice of the
+// atlas, warped and edge-blended, presented with the main window's frame
+
+#include <memory>
+#include <vector>
+#include "ofFbo.h"
+#include "../math/ofVec2f.h"
+
+namespace oflike {
+
+/// \brief Atlas FBO shown in slices on extra displays (projector walls, domes)
+/// \details Draw every display's content into the atlas between begin() and
+/// end(); at the end of the frame the renderer draws each output's slice on
+/// its display in one pass, through an optional warp grid and with faded
+/// edges where projectors overlap. All outputs share the device, the atlas
+/// and the frame's command buffer, and present with the main window.
+///
+/// Features:
+/// - addDisplay() opens a borderless window covering an NSScreen;
+///   addLayer() uses a CAMetalLayer the app manages
+/// - Mesh warp: a grid of control points per output, bilinear per cell
+/// - Edge blend per side, with adjustable ramp and display gamma
+///
+/// Implementation:
+/// - The scene is encoded once; each output costs one textured pass
+/// - Drawables present together from one command buffer; each display
+///   still flips on its own refresh (no genlock)
+/// - One atlas per renderer: a second allocated ofMultiDisplayOutput
+///   replaces the first one's source
+/// - Thread-safety: Main thread only
+///
+/// Example:
+/// \code
+///     ofMultiDisplayOutput wall;
+///
+///     void setup() {
+///         // Two 1920x1080 projectors overlapping by 240 pixels
+///         wall.allocate(3600, 1080);
+///         int left = wall.addDisplay(1, 0, 0, 1920, 1080);
+///         int right = wall.addDisplay(2, 1680, 0, 1920, 1080);
+///         wall.setEdgeBlend(left, 0, 240.0f / 1920, 0, 0);
+///         wall.setEdgeBlend(right, 240.0f / 1920, 0, 0, 0);
+///     }
+///
+///     void draw() {
+///         wall.begin();
+///         ofClear(0);
+///         scene.draw();
+///         wall.end();
+///
+///         wall.getAtlas().draw(0, 0, ofGetWidth(), ofGetWidth() * 1080 / 3600);  // Preview
+///     }
+/// \endcode
+class ofMultiDisplayOutput {
+public:
+    ofMultiDisplayOutput();
+    ~ofMultiDisplayOutput();
+
+    ofMultiDisplayOutput(const ofMultiDisplayOutput&) = delete;
+    ofMultiDisplayOutput& operator=(const ofMultiDisplayOutput&) = delete;
+
+    // ========================================================================
+    // Allocation
+    // ========================================================================
+
+    /// \brief Allocate the atlas and make it the renderer's output source
+    /// \param width Atlas width in pixels
+    /// \param height Atlas height in pixels
+    /// \param useDepth Give the atlas a depth buffer (3D scenes)
+    /// \param numSamples MSAA samples of the atlas (0 = off)
+    /// \return false if the atlas couldn't be created
+    bool allocate(int width, int height, bool useDepth = true, int numSamples = 0);
+
+    /// \brief Check if allocated
+    bool isAllocated() const;
+
+    // ========================================================================
+    // Outputs
+    // ========================================================================
+
+    /// \brief Get the number of connected screens
+    static int getNumScreens();
+
+    /// \brief Show a slice of the atlas full-screen on a display
+    /// \details Opens a borderless window over the screen, above the menu bar,
+    /// drawn at the screen's native resolution.
+    /// \param screenIndex Index into the connected screens (0 = main screen)
+    /// \param x, y, width, height Slice in atlas pixels
+    /// \return Output ID, or -1 if the screen doesn't exist
+    int addDisplay(int screenIndex, float x, float y, float width, float height);
+
+    /// \brief Show a slice of the atlas in a CAMetalLayer the app manages
+    /// \details The layer's drawableSize is left to the app.
+    /// \param metalLayer CAMetalLayer to draw into
+    /// \param x, y, width, height Slice in atlas pixels
+    /// \return Output ID, or -1 on failure
+    int addLayer(void* metalLayer, float x, float y, float width, float height);
+
+    /// \brief Stop an output and close its window
+    void removeOutput(int output);
+
+    /// \brief Get the number of outputs
+    int getNumOutputs() const;
+
+    /// \brief Warp an output through a grid of control points
+    /// \param output Output ID
+    /// \param columns, rows Grid cells across and down
+    /// \param points (columns + 1) x (rows + 1) display positions, row by row
+    ///        from the top-left, 0-1 with a top-left origin
+    /// \return false for an unknown output or a wrong number of points
+    bool setWarp(int output, int columns, int rows, const std::vector<ofVec2f>& points);
+
+    /// \brief Fill the display with the slice again
+    void resetWarp(int output);
+
+    /// \brief Fade the slice's edges for projector overlap
+    /// \details The ramps of overlapping outputs sum to full brightness in
+    /// linear light when both use the same widths and curve.
+    /// \param left, right, top, bottom Blend widths as fractions of the slice
+    /// \param gamma Display gamma the ramp is encoded for (1 = none)
+    /// \param curve Ramp steepness (1 = linear)
+    void setEdgeBlend(int output, float left, float right, float top, float bottom,
+                      float gamma = 2.2f, float curve = 2.0f);
+
+    // ========================================================================
+    // Rendering
+    // ========================================================================
+
+    /// \brief Begin drawing into the atlas
+    void begin();
+
+    /// \brief End drawing into the atlas
+    void end();
+
+    /// \brief Get the atlas, e.g. to preview it on the main window
+    ofFbo& getAtlas();
+    const ofFbo& getAtlas() const;
+
+    /// \brief Remove every output and release the atlas
+    void close();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
+
+// Global namespace alias for openFrameworks compatibility
+using ofMultiDisplayOutput = oflike::ofMultiDisplayOutput;
@@ -0,0 +1,256 @@
+#import "ofMultiDisplayOutput.h"
+#import "../../core/Context.h"
+#import "../../render/IRenderer.h"
+#import "../utils/ofLog.h"
+#import <AppKit/AppKit.h>
+#import <QuartzCore/CAMetalLayer.h>
+#include <algorithm>
+#include <unordered_map>
+
+namespace oflike {
+
+// ============================================================================
+// ofMultiDisplayOutput::Impl
+// ============================================================================
+
+struct ofMultiDisplayOutput::Impl {
+    struct Output {
+        NSWindow* window = nil;         // Only for addDisplay() outputs
+        simd_float4 slice;              // Atlas pixels (x, y, width, height)
+        render::DisplayOutputConfig config;
+    };
+
+    ofFbo atlas;
+    int width = 0;
+    int height = 0;
+    std::unordered_map<int, Output> outputs;
+
+    // Push an output's slice (as fractions of the atlas) and settings
+    bool apply(int id, Output& output) {
+        auto* renderer = Context::instance().renderer();
+        if (!renderer) {
+            return false;
+        }
+        if (width > 0 && height > 0) {
+            output.config.source = output.slice / simd_make_float4(width, height, width, height);
+        }
+        return renderer->setDisplayOutputConfig(id, output.config);
+    }
+
+    int add(CAMetalLayer* layer, NSWindow* window, float x, float y, float w, float h) {
+        auto* renderer = Context::instance().renderer();
+        const int id = renderer ? renderer->addDisplayOutput((__bridge void*)layer) : -1;
+        if (id < 0) {
+            ofLogError("ofMultiDisplayOutput") << "The renderer has no display outputs";
+            [window close];
+            return -1;
+        }
+        Output& output = outputs[id];
+        output.window = window;
+        output.slice = simd_make_float4(x, y, w, h);
+        apply(id, output);
+        return id;
+    }
+
+    void remove(int id) {
+        auto it = outputs.find(id);
+        if (it == outputs.end()) {
+            return;
+        }
+        if (auto* renderer = Context::instance().renderer()) {
+            renderer->removeDisplayOutput(id);
+        }
+        [it->second.window close];
+        outputs.erase(it);
+    }
+};
+
+// ============================================================================
+// ofMultiDisplayOutput
+// ============================================================================
+
+ofMultiDisplayOutput::ofMultiDisplayOutput() : impl_(std::make_unique<Impl>()) {}
+
+ofMultiDisplayOutput::~ofMultiDisplayOutput() {
+    close();
+}
+
+bool ofMultiDisplayOutput::allocate(int width, int height, bool useDepth, int numSamples) {
+    auto* renderer = Context::instance().renderer();
+    if (!renderer || width <= 0 || height <= 0) {
+        ofLogError("ofMultiDisplayOutput") << "Cannot allocate " << width << "x" << height;
+        return false;
+    }
+
+    ofFboSettings settings;
+    settings.width = width;
+    settings.height = height;
+    settings.useDepth = useDepth;
+    settings.numSamples = numSamples;
+    impl_->atlas.allocateWithSettings(settings);
+    void* texture = impl_->atlas.getNativeTextureHandle();
+    if (!texture) {
+        ofLogError("ofMultiDisplayOutput") << "Failed to allocate the atlas";
+        return false;
+    }
+    renderer->setDisplayOutputSource(texture);
+
+    // Slices stay in atlas pixels
+    impl_->width = width;
+    impl_->height = height;
+    for (auto& entry : impl_->outputs) {
+        impl_->apply(entry.first, entry.second);
+    }
+    return true;
+}
+
+bool ofMultiDisplayOutput::isAllocated() const {
+    return impl_->atlas.isAllocated();
+}
+
+// ============================================================================
+// Outputs
+// ============================================================================
+
+int ofMultiDisplayOutput::getNumScreens() {
+    @autoreleasepool {
+        return static_cast<int>([NSScreen screens].count);
+    }
+}
+
+int ofMultiDisplayOutput::addDisplay(int screenIndex, float x, float y, float width, float height) {
+    @autoreleasepool {
+        NSArray<NSScreen*>* screens = [NSScreen screens];
+        if (screenIndex < 0 || screenIndex >= static_cast<int>(screens.count)) {
+            ofLogError("ofMultiDisplayOutput") << "No screen " << screenIndex << " (" << screens.count
+                                               << " connected)";
+            return -1;
+        }
+        NSScreen* screen = screens[screenIndex];
+        const NSRect frame = screen.frame;
+
+        NSWindow* window = [[NSWindow alloc] initWithContentRect:frame
+                                                       styleMask:NSWindowStyleMaskBorderless
+                                                         backing:NSBackingStoreBuffered
+                                                           defer:NO
+                                                          screen:screen];
+        window.releasedWhenClosed = NO;
+        window.level = NSMainMenuWindowLevel + 1;
+        window.backgroundColor = NSColor.blackColor;
+        window.collectionBehavior = NSWindowCollectionBehaviorCanJoinAllSpaces |
+                                    NSWindowCollectionBehaviorFullScreenAuxiliary;
+
+        // Native resolution of the screen; the renderer draws it every frame
+        CAMetalLayer* layer = [CAMetalLayer layer];
+        layer.pixelFormat = MTLPixelFormatBGRA8Unorm;
+        layer.framebufferOnly = YES;
+        layer.contentsScale = screen.backingScaleFactor;
+        layer.drawableSize = CGSizeMake(frame.size.width * screen.backingScaleFactor,
+                                        frame.size.height * screen.backingScaleFactor);
+        NSView* view = [[NSView alloc] initWithFrame:NSMakeRect(0, 0, frame.size.width, frame.size.height)];
+        view.wantsLayer = YES;
+        view.layer = layer;
+        window.contentView = view;
+        [window orderFrontRegardless];
+
+        return impl_->add(layer, window, x, y, width, height);
+    }
+}
+
+int ofMultiDisplayOutput::addLayer(void* metalLayer, float x, float y, float width, float height) {
+    CAMetalLayer* layer = (__bridge CAMetalLayer*)metalLayer;
+    if (!layer) {
+        return -1;
+    }
+    return impl_->add(layer, nil, x, y, width, height);
+}
+
+void ofMultiDisplayOutput::removeOutput(int output) {
+    @autoreleasepool {
+        impl_->remove(output);
+    }
+}
+
+int ofMultiDisplayOutput::getNumOutputs() const {
+    return static_cast<int>(impl_->outputs.size());
+}
+
+bool ofMultiDisplayOutput::setWarp(int output, int columns, int rows, const std::vector<ofVec2f>& points) {
+    auto it = impl_->outputs.find(output);
+    if (it == impl_->outputs.end() || columns <= 0 || rows <= 0 ||
+        points.size() != static_cast<size_t>(columns + 1) * (rows + 1)) {
+        ofLogWarning("ofMultiDisplayOutput") << "Invalid warp grid for output " << output;
+        return false;
+    }
+    render::DisplayOutputConfig& config = it->second.config;
+    config.warpColumns = static_cast<uint32_t>(columns);
+    config.warpRows = static_cast<uint32_t>(rows);
+    config.warpPoints.resize(points.size());
+    std::transform(points.begin(), points.end(), config.warpPoints.begin(),
+                   [](const ofVec2f& p) { return simd_make_float2(p.x, p.y); });
+    return impl_->apply(output, it->second);
+}
+
+void ofMultiDisplayOutput::resetWarp(int output) {
+    auto it = impl_->outputs.find(output);
+    if (it == impl_->outputs.end()) {
+        return;
+    }
+    render::DisplayOutputConfig& config = it->second.config;
+    config.warpColumns = 0;
+    config.warpRows = 0;
+    config.warpPoints.clear();
+    impl_->apply(output, it->second);
+}
+
+void ofMultiDisplayOutput::setEdgeBlend(int output, float left, float right, float top, float bottom,
+                                        float gamma, float curve) {
+    auto it = impl_->outputs.find(output);
+    if (it == impl_->outputs.end()) {
+        return;
+    }
+    render::DisplayOutputConfig& config = it->second.config;
+    config.blendWidth = simd_clamp(simd_make_float4(left, right, top, bottom), simd_make_float4(0.0f),
+                                   simd_make_float4(1.0f));
+    config.blendGamma = std::max(gamma, 0.01f);
+    config.blendCurve = std::max(curve, 0.01f);
+    impl_->apply(output, it->second);
+}
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+void ofMultiDisplayOutput::begin() {
+    impl_->atlas.begin();
+}
+
+void ofMultiDisplayOutput::end() {
+    impl_->atlas.end();
+}
+
+ofFbo& ofMultiDisplayOutput::getAtlas() {
+    return impl_->atlas;
+}
+
+const ofFbo& ofMultiDisplayOutput::getAtlas() const {
+    return impl_->atlas;
+}
+
+void ofMultiDisplayOutput::close() {
+    @autoreleasepool {
+        while (!impl_->outputs.empty()) {
+            impl_->remove(impl_->outputs.begin()->first);
+        }
+        if (impl_->atlas.isAllocated()) {
+            if (auto* renderer = Context::instance().renderer()) {
+                renderer->setDisplayOutputSource(nullptr);
+            }
+            impl_->atlas.clear();
+        }
+        impl_->width = 0;
+        impl_->height = 0;
+    }
+}
+
+} // namespace oflike
@@ -3,11 +3,95 @@
 #include "../math/ofMatrix4x4.h"
 #include "../math/ofMath.h"
 #include "../../third_party/tess2/Include/tesselator.h"
+#include <simd/simd.h>
+#include <dispatch/dispatch.h>
 #include <cmath>
 #include <algorithm>
 
 namespace oflike {
 
+namespace {
+    // Stroke miters longer than this many half widths are beveled (the SVG default)
+    constexpr float kStrokeMiterLimit = 4.0f;
+
+    // Append triangles covering a stroke of the given half width along a
+    // polyline: one quad per segment, plus a miter or bevel wedge on the
+    // outer side of every join
+    void appendStrokeMesh(const std::vector<ofVec3f>& input, bool closed, float halfWidth,
+                          std::vector<ofVec3f>& vertices, std::vector<uint32_t>& indices) {
+        // Repeated points have no direction; a closed polyline's last point
+        // repeats its first
+        std::vector<simd_float2> points;
+        points.reserve(input.size());
+        for (const auto& v : input) {
+            const simd_float2 p = simd_make_float2(v.x, v.y);
+            if (points.empty() || !simd_equal(p, points.back())) {
+                points.push_back(p);
+            }
+        }
+        if (points.size() > 1 && simd_equal(points.front(), points.back())) {
+            points.pop_back();
+            closed = true;
+        }
+
+        const size_t n = points.size();
+        if (n < 2) {
+            return;
+        }
+        const bool loop = closed && n > 2;
+        const size_t segmentCount = loop ? n : n - 1;
+
+        auto addVertex = [&](simd_float2 p) {
+            vertices.emplace_back(p.x, p.y, 0.0f);
+            return static_cast<uint32_t>(vertices.size() - 1);
+        };
+        // Left-hand unit normal of segment i -> i + 1
+        auto normalOf = [&](size_t i) {
+            const simd_float2 d = simd_normalize(points[(i + 1) % n] - points[i]);
+            return simd_make_float2(-d.y, d.x);
+        };
+
+        for (size_t i = 0; i < segmentCount; ++i) {
+            const simd_float2 a = points[i];
+            const simd_float2 b = points[(i + 1) % n];
+            const simd_float2 offset = normalOf(i) * halfWidth;
+            const uint32_t base = addVertex(a + offset);
+            addVertex(a - offset);
+            addVertex(b + offset);
+            addVertex(b - offset);
+            indices.insert(indices.end(), {base, base + 1, base + 2, base + 1, base + 3, base + 2});
+        }
+
+        const size_t firstJoin = loop ? 0 : 1;
+        const size_t lastJoin = loop ? n : n - 1;
+        for (size_t i = firstJoin; i < lastJoin; ++i) {
+            const simd_float2 n0 = normalOf((i + n - 1) % n);
+            const simd_float2 n1 = normalOf(i);
+            const float cross = n0.x * n1.y - n0.y * n1.x;
+            const simd_float2 sum = n0 + n1;
+            if (std::abs(cross) < 1e-6f || simd_length_squared(sum) < 1e-12f) {
+                continue;  // Straight on, or a full reversal
+            }
+
+            // The outer side is right of a left turn
+            const float side = cross > 0.0f ? -halfWidth : halfWidth;
+            const simd_float2 p = points[i];
+            const uint32_t pivot = addVertex(p);
+            const uint32_t c0 = addVertex(p + n0 * side);
+            const uint32_t c1 = addVertex(p + n1 * side);
+
+            const simd_float2 bisector = simd_normalize(sum);
+            const float cosHalf = simd_dot(bisector, n0);
+            if (cosHalf * kStrokeMiterLimit > 1.0f) {
+                const uint32_t miter = addVertex(p + bisector * (side / cosHalf));
+                indices.insert(indices.end(), {pivot, c0, miter, pivot, miter, c1});
+            } else {
+                indices.insert(indices.end(), {pivot, c0, c1});
+            }
+        }
+    }
+}
+
 // ============================================================================
 // Constructors & Destructors
 // ============================================================================
@@ -17,7 +101,10 @@ ofPath::ofPath()
     , hasCurrentPosition_(false)
     , filled_(true)
     , strokeWidth_(1.0f)
+    , windingMode_(OF_POLY_WINDING_ODD)
+    , gpuFill_(false)
     , tessellationDirty_(true)
+    , strokeDirty_(true)
 {
     // Default fill color: white
     fillColor_[0] = 255;
@@ -40,7 +127,10 @@ ofPath::ofPath(const ofPath& other)
     , hasCurrentPosition_(other.hasCurrentPosition_)
     , filled_(other.filled_)
     , strokeWidth_(other.strokeWidth_)
+    , windingMode_(other.windingMode_)
+    , gpuFill_(other.gpuFill_)
     , tessellationDirty_(true) // Always dirty on copy
+    , strokeDirty_(true)
 {
     std::copy(std::begin(other.fillColor_), std::end(other.fillColor_), fillColor_);
     std::copy(std::begin(other.strokeColor_), std::end(other.strokeColor_), strokeColor_);
@@ -53,10 +143,17 @@ ofPath& ofPath::operator=(const ofPath& other) {
         hasCurrentPosition_ = other.hasCurrentPosition_;
         filled_ = other.filled_;
         strokeWidth_ = other.strokeWidth_;
+        windingMode_ = other.windingMode_;
+        gpuFill_ = other.gpuFill_;
         std::copy(std::begin(other.fillColor_), std::end(other.fillColor_), fillColor_);
         std::copy(std::begin(other.strokeColor_), std::end(other.strokeColor_), strokeColor_);
         tessellationDirty_ = true;
         tessellationCache_.clear();
+        tessellationVertices_.clear();
+        tessellationIndices_.clear();
+        strokeDirty_ = true;
+        strokeVertices_.clear();
+        strokeIndices_.clear();
     }
     return *this;
 }
@@ -67,8 +164,15 @@ ofPath::ofPath(ofPath&& other) noexcept
     , hasCurrentPosition_(other.hasCurrentPosition_)
     , filled_(other.filled_)
     , strokeWidth_(other.strokeWidth_)
+    , windingMode_(other.windingMode_)
+    , gpuFill_(other.gpuFill_)
     , tessellationCache_(std::move(other.tessellationCache_))
+    , tessellationVertices_(std::move(other.tessellationVertices_))
+    , tessellationIndices_(std::move(other.tessellationIndices_))
     , tessellationDirty_(other.tessellationDirty_)
+    , strokeVertices_(std::move(other.strokeVertices_))
+    , strokeIndices_(std::move(other.strokeIndices_))
+    , strokeDirty_(other.strokeDirty_)
 {
     std::copy(std::begin(other.fillColor_), std::end(other.fillColor_), fillColor_);
     std::copy(std::begin(other.strokeColor_), std::end(other.strokeColor_), strokeColor_);
@@ -81,10 +185,17 @@ ofPath& ofPath::operator=(ofPath&& other) noexcept {
         hasCurrentPosition_ = other.hasCurrentPosition_;
         filled_ = other.filled_;
         strokeWidth_ = other.strokeWidth_;
+        windingMode_ = other.windingMode_;
+        gpuFill_ = other.gpuFill_;
         std::copy(std::begin(other.fillColor_), std::end(other.fillColor_), fillColor_);
         std::copy(std::begin(other.strokeColor_), std::end(other.strokeColor_), strokeColor_);
         tessellationCache_ = std::move(other.tessellationCache_);
+        tessellationVertices_ = std::move(other.tessellationVertices_);
+        tessellationIndices_ = std::move(other.tessellationIndices_);
         tessellationDirty_ = other.tessellationDirty_;
+        strokeVertices_ = std::move(other.strokeVertices_);
+        strokeIndices_ = std::move(other.strokeIndices_);
+        strokeDirty_ = other.strokeDirty_;
     }
     return *this;
 }
@@ -228,7 +339,10 @@ bool ofPath::isFilled() const {
 }
 
 void ofPath::setStrokeWidth(float width) {
-    strokeWidth_ = width;
+    if (width != strokeWidth_) {
+        strokeWidth_ = width;
+        strokeDirty_ = true;
+    }
 }
 
 float ofPath::getStrokeWidth() const {
@@ -305,36 +419,34 @@ void ofPath::draw(float x, float y) const {
         ofTranslate(x, y, 0);
     }
 
-    // Draw filled path
+    // Cached meshes (built now unless tessellateAll() got to them first)
+    prepareMeshes();
+
+    // Draw filled path as one indexed triangle command, or with coverage
+    // computed from the outline on the GPU
     if (filled_) {
         ofSetColor(fillColor_[0], fillColor_[1], fillColor_[2], fillColor_[3]);
         ofFill();
-
-        // Get tessellated geometry and draw triangles
-        auto tessellation = getTessellation();
-        if (!tessellation.empty()) {
-            // Draw triangles using basic triangle drawing
-            // For now, we'll use ofDrawTriangle for each triangle
-            for (size_t i = 0; i + 2 < tessellation.size(); i += 3) {
-                const auto& v0 = tessellation[i];
-                const auto& v1 = tessellation[i + 1];
-                const auto& v2 = tessellation[i + 2];
-                ofDrawTriangle(v0.x, v0.y, v0.z,
-                             v1.x, v1.y, v1.z,
-                             v2.x, v2.y, v2.z);
-            }
+        if (gpuFill_) {
+            ofDrawPathFill(polylines_.data(), polylines_.size(), windingMode_);
+        } else {
+            ofDrawTriangles(tessellationVertices_.data(), tessellationVertices_.size(),
+                            tessellationIndices_.data(), tessellationIndices_.size());
         }
     }
 
-    // Draw stroked path (outline)
-    if (strokeWidth_ > 0) {
+    // Draw stroked path (outline): wide strokes from the cached mesh, thin
+    // ones as lines
+    if (strokeWidth_ > 1.0f) {
+        ofSetColor(strokeColor_[0], strokeColor_[1], strokeColor_[2], strokeColor_[3]);
+        ofFill();
+        ofDrawTriangles(strokeVertices_.data(), strokeVertices_.size(),
+                        strokeIndices_.data(), strokeIndices_.size());
+    } else if (strokeWidth_ > 0) {
         ofSetColor(strokeColor_[0], strokeColor_[1], strokeColor_[2], strokeColor_[3]);
         ofNoFill();
         ofSetLineWidth(strokeWidth_);
-
-        for (const auto& polyline : polylines_) {
-            polyline.draw();
-        }
+        ofDrawPolylines(polylines_.data(), polylines_.size());
     }
 
     // Restore transformation
@@ -373,6 +485,83 @@ std::vector<ofVec3f> ofPath::getTessellation() const {
     return tessellationCache_;
 }
 
+void ofPath::getTessellation(std::vector<ofVec3f>& vertices, std::vector<uint32_t>& indices) const {
+    vertices.clear();
+    indices.clear();
+    if (!filled_) {
+        return;
+    }
+
+    if (tessellationDirty_) {
+        tessellate();
+    }
+    vertices = tessellationVertices_;
+    indices = tessellationIndices_;
+}
+
+void ofPath::getStrokeMesh(std::vector<ofVec3f>& vertices, std::vector<uint32_t>& indices) const {
+    if (strokeDirty_) {
+        buildStrokeMesh();
+    }
+    vertices = strokeVertices_;
+    indices = strokeIndices_;
+}
+
+void ofPath::getStrokeMesh(float width, std::vector<ofVec3f>& vertices, std::vector<uint32_t>& indices) const {
+    vertices.clear();
+    indices.clear();
+    if (width <= 0.0f) {
+        return;
+    }
+    for (const auto& polyline : polylines_) {
+        appendStrokeMesh(polyline.getVertices(), polyline.isClosed(), width * 0.5f, vertices, indices);
+    }
+}
+
+void ofPath::setPolyWindingMode(ofPolyWindingMode mode) {
+    if (mode != windingMode_) {
+        windingMode_ = mode;
+        invalidateTessellation();
+    }
+}
+
+ofPolyWindingMode ofPath::getPolyWindingMode() const {
+    return windingMode_;
+}
+
+void ofPath::setGpuFill(bool gpuFill) {
+    gpuFill_ = gpuFill;
+}
+
+bool ofPath::isGpuFill() const {
+    return gpuFill_;
+}
+
+// ============================================================================
+// Batch Tessellation
+// ============================================================================
+
+void ofPath::tessellateAll(const ofPath* paths, size_t count) {
+    if (!paths || count == 0) {
+        return;
+    }
+    if (count == 1) {
+        paths[0].prepareMeshes();
+        return;
+    }
+
+    // Each task touches only its own path's caches; tess2 tesselators
+    // are independent
+    dispatch_apply_f(count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0),
+                     const_cast<ofPath*>(paths), [](void* context, size_t i) {
+                         static_cast<const ofPath*>(context)[i].prepareMeshes();
+                     });
+}
+
+void ofPath::tessellateAll(const std::vector<ofPath>& paths) {
+    tessellateAll(paths.data(), paths.size());
+}
+
 // ============================================================================
 // Simplification
 // ============================================================================
@@ -497,6 +686,8 @@ const ofPolyline& ofPath::getCurrentPolyline() const {
 
 void ofPath::tessellate() const {
     tessellationCache_.clear();
+    tessellationVertices_.clear();
+    tessellationIndices_.clear();
     tessellationDirty_ = false;
 
     if (polylines_.empty()) {
@@ -530,23 +721,31 @@ void ofPath::tessellate() const {
     }
 
     // Perform tessellation
-    // TESS_WINDING_ODD for typical path winding
+    // ofPolyWindingMode values match TessWindingRule
     // TESS_POLYGONS to get triangles
-    if (tessTesselate(tess, TESS_WINDING_ODD, TESS_POLYGONS, 3, 2, nullptr)) {
+    if (tessTesselate(tess, static_cast<int>(windingMode_), TESS_POLYGONS, 3, 2, nullptr)) {
         const float* verts = tessGetVertices(tess);
+        const int nverts = tessGetVertexCount(tess);
         const int* elems = tessGetElements(tess);
         const int nelems = tessGetElementCount(tess);
 
-        // Convert to ofVec3f triangles
+        tessellationVertices_.reserve(nverts);
+        for (int i = 0; i < nverts; ++i) {
+            tessellationVertices_.emplace_back(verts[i * 2], verts[i * 2 + 1], 0.0f);
+        }
+
+        // Convert to ofVec3f triangles (and the indexed form alongside)
         tessellationCache_.reserve(nelems * 3);
+        tessellationIndices_.reserve(nelems * 3);
 
         for (int i = 0; i < nelems; ++i) {
             const int* tri = &elems[i * 3];
+            if (tri[0] == TESS_UNDEF || tri[1] == TESS_UNDEF || tri[2] == TESS_UNDEF) {
+                continue;
+            }
             for (int j = 0; j < 3; ++j) {
-                if (tri[j] != TESS_UNDEF) {
-                    const float* v = &verts[tri[j] * 2];
-                    tessellationCache_.emplace_back(v[0], v[1], 0.0f);
-                }
+                tessellationCache_.push_back(tessellationVertices_[tri[j]]);
+                tessellationIndices_.push_back(static_cast<uint32_t>(tri[j]));
             }
         }
     }
@@ -554,8 +753,33 @@ void ofPath::tessellate() const {
     tessDeleteTess(tess);
 }
 
+void ofPath::buildStrokeMesh() const {
+    strokeVertices_.clear();
+    strokeIndices_.clear();
+    strokeDirty_ = false;
+
+    if (strokeWidth_ <= 1.0f) {
+        return;
+    }
+
+    for (const auto& polyline : polylines_) {
+        appendStrokeMesh(polyline.getVertices(), polyline.isClosed(), strokeWidth_ * 0.5f,
+                         strokeVertices_, strokeIndices_);
+    }
+}
+
+void ofPath::prepareMeshes() const {
+    if (filled_ && !gpuFill_ && tessellationDirty_) {
+        tessellate();
+    }
+    if (strokeWidth_ > 1.0f && strokeDirty_) {
+        buildStrokeMesh();
+    }
+}
+
 void ofPath::invalidateTessellation() {
     tessellationDirty_ = true;
+    strokeDirty_ = true;
 }
 
 } // namespace oflike
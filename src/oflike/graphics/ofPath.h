@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../math/ofVec3f.h"
+#include "ofGraphics.h"
 #include "ofPolyline.h"
 #include <vector>
 #include <cstdint>
@@ -14,7 +15,11 @@ namespace oflike {
  * ofPath provides a high-level interface for creating complex 2D shapes
  * using path commands (moveTo, lineTo, curveTo, bezierTo, arc).
  * It supports both filled and stroked rendering, and uses tess2 for
- * polygon tessellation of filled shapes.
+ * polygon tessellation of filled shapes. The fill tessellation and the
+ * triangle mesh of wide strokes are cached until the path changes; use
+ * tessellateAll() to build them for many paths at once on worker threads.
+ * With setGpuFill(), fills skip tessellation and are rasterized from the
+ * outline on the GPU instead.
  *
  * Compatible with openFrameworks ofPath API.
  *
@@ -158,6 +163,58 @@ public:
     /// Only valid if the path is filled
     std::vector<ofVec3f> getTessellation() const;
 
+    /// Get the tessellated geometry as indexed triangles
+    /// Vertices are shared between triangles; every 3 indices form one
+    /// @param vertices Receives the unique tessellation vertices
+    /// @param indices Receives triangle indices into vertices
+    void getTessellation(std::vector<ofVec3f>& vertices, std::vector<uint32_t>& indices) const;
+
+    /// Get the triangle mesh of the stroke outline (miter joins, beveled
+    /// past a miter limit of 4, butt caps), cached like the fill
+    /// Empty unless the stroke width is greater than 1; thinner strokes
+    /// are drawn as lines
+    /// @param vertices Receives the mesh vertices
+    /// @param indices Receives triangle indices into vertices
+    void getStrokeMesh(std::vector<ofVec3f>& vertices, std::vector<uint32_t>& indices) const;
+
+    /// Get the stroke outline mesh at any width (built on each call)
+    /// For meshing thin strokes that draw() draws as lines
+    /// @param width Stroke width
+    /// @param vertices Receives the mesh vertices
+    /// @param indices Receives triangle indices into vertices
+    void getStrokeMesh(float width, std::vector<ofVec3f>& vertices, std::vector<uint32_t>& indices) const;
+
+    /// Set the fill rule used for tessellation (default OF_POLY_WINDING_ODD)
+    void setPolyWindingMode(ofPolyWindingMode mode);
+
+    /// Get the fill rule used for tessellation
+    ofPolyWindingMode getPolyWindingMode() const;
+
+    /// Fill on the GPU instead of from the cached tessellation (default off)
+    /// The fill's coverage is computed per pixel from the outline's edges
+    /// under the winding mode (see ofDrawPathFill), so nothing is
+    /// triangulated; suited to paths that change every frame.
+    void setGpuFill(bool gpuFill);
+
+    /// Check if the path is filled on the GPU
+    bool isGpuFill() const;
+
+    // ========================================================================
+    // Batch Tessellation
+    // ========================================================================
+
+    /// Build the cached fill and stroke meshes of many paths in parallel,
+    /// one path per task on the global dispatch queue
+    /// Call it after loading many paths, so their first draw doesn't
+    /// tessellate them one after another. The paths must not be modified
+    /// or drawn while it runs.
+    /// @param paths Pointer to count paths
+    /// @param count Number of paths
+    static void tessellateAll(const ofPath* paths, size_t count);
+
+    /// Build the cached fill and stroke meshes of every path in parallel
+    static void tessellateAll(const std::vector<ofPath>& paths);
+
     // ========================================================================
     // Simplification
     // ========================================================================
@@ -228,16 +285,27 @@ private:
     float strokeWidth_;
     uint8_t fillColor_[4];                    // RGBA
     uint8_t strokeColor_[4];                  // RGBA
+    ofPolyWindingMode windingMode_;
+    bool gpuFill_;                            // Fill with ofDrawPathFill()
 
     // Cached tessellation (mutable for lazy evaluation)
-    mutable std::vector<ofVec3f> tessellationCache_;
+    mutable std::vector<ofVec3f> tessellationCache_;     // Triangle list
+    mutable std::vector<ofVec3f> tessellationVertices_;  // Indexed form
+    mutable std::vector<uint32_t> tessellationIndices_;
     mutable bool tessellationDirty_;
 
+    // Cached wide-stroke mesh
+    mutable std::vector<ofVec3f> strokeVertices_;
+    mutable std::vector<uint32_t> strokeIndices_;
+    mutable bool strokeDirty_;
+
     // Helper methods
     void ensurePolyline();                    // Ensure we have a current polyline
     ofPolyline& getCurrentPolyline();         // Get or create current polyline
     const ofPolyline& getCurrentPolyline() const;
     void tessellate() const;                  // Perform tessellation using tess2
+    void buildStrokeMesh() const;             // Triangulate the stroke outline
+    void prepareMeshes() const;               // Build whichever meshes draw() uses
     void invalidateTessellation();            // Mark tessellation as dirty
 };
 
@@ -1,12 +1,195 @@
 #include "ofPolyline.h"
 #include "ofGraphics.h"
 #include "../math/ofMath.h"
+#include <Accelerate/Accelerate.h>
+#include <simd/simd.h>
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <numeric>
+#include <utility>
 
 namespace oflike {
 
+namespace {
+    // Polylines with more segments than this get a segment tree for queries
+    constexpr size_t kTreeMinSegments = 64;
+
+    // Segments per tree leaf
+    constexpr uint32_t kTreeLeafSize = 4;
+
+    inline simd_float3 toSimd(const ofVec3f& v) {
+        return simd_make_float3(v.x, v.y, v.z);
+    }
+
+    inline ofVec3f fromSimd(simd_float3 v) {
+        return ofVec3f(v.x, v.y, v.z);
+    }
+
+    // Closest point to p on the segment a-b
+    inline simd_float3 closestOnSegment(simd_float3 p, simd_float3 a, simd_float3 b) {
+        const simd_float3 ab = b - a;
+        const float length2 = simd_length_squared(ab);
+        if (length2 < 1e-12f) {
+            return a;  // Degenerate segment
+        }
+        const float t = simd_clamp(simd_dot(p - a, ab) / length2, 0.0f, 1.0f);
+        return a + ab * t;
+    }
+}
+
+// ============================================================================
+// Segment Tree
+// ============================================================================
+
+// Bounding volume hierarchy over the segments i -> i + 1, plus the closing
+// segment n - 1 -> 0 of a closed polyline. Built once per edit and never
+// modified, so copies of a polyline share it.
+struct ofPolyline::SegmentTree {
+    struct Node {
+        simd_float3 min;
+        simd_float3 max;
+        uint32_t first;  // Leaf: first entry of order; inner: left child (right is first + 1)
+        uint32_t count;  // Leaf: segment count; 0 for inner nodes
+    };
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> order;  // Segment indices, each leaf's contiguous
+
+    void build(const std::vector<ofVec3f>& v, bool closed) {
+        const uint32_t n = static_cast<uint32_t>(v.size());
+        const uint32_t segmentCount = closed ? n : n - 1;
+        std::vector<simd_float3> centers(segmentCount);
+        for (uint32_t i = 0; i < segmentCount; ++i) {
+            centers[i] = (toSimd(v[i]) + toSimd(v[(i + 1) % n])) * 0.5f;
+        }
+        order.resize(segmentCount);
+        std::iota(order.begin(), order.end(), 0u);
+
+        nodes.clear();
+        nodes.reserve(segmentCount / kTreeLeafSize * 2 + 1);
+        nodes.push_back(Node());
+        split(0, 0, segmentCount, v, centers);
+    }
+
+    // Bound a node's segments and split them at the median of their
+    // centers along the widest axis
+    void split(uint32_t node, uint32_t first, uint32_t count,
+               const std::vector<ofVec3f>& v, const std::vector<simd_float3>& centers) {
+        const uint32_t n = static_cast<uint32_t>(v.size());
+        simd_float3 lo = simd_make_float3(INFINITY, INFINITY, INFINITY);
+        simd_float3 hi = -lo;
+        simd_float3 centerLo = lo;
+        simd_float3 centerHi = hi;
+        for (uint32_t k = first; k < first + count; ++k) {
+            const uint32_t i = order[k];
+            const simd_float3 a = toSimd(v[i]);
+            const simd_float3 b = toSimd(v[(i + 1) % n]);
+            lo = simd_min(lo, simd_min(a, b));
+            hi = simd_max(hi, simd_max(a, b));
+            centerLo = simd_min(centerLo, centers[i]);
+            centerHi = simd_max(centerHi, centers[i]);
+        }
+        nodes[node].min = lo;
+        nodes[node].max = hi;
+
+        if (count <= kTreeLeafSize) {
+            nodes[node].first = first;
+            nodes[node].count = count;
+            return;
+        }
+
+        const simd_float3 extent = centerHi - centerLo;
+        const int axis = extent.x >= extent.y ? (extent.x >= extent.z ? 0 : 2) : (extent.y >= extent.z ? 1 : 2);
+        const uint32_t mid = first + count / 2;
+        std::nth_element(order.begin() + first, order.begin() + mid, order.begin() + first + count,
+                         [&](uint32_t a, uint32_t b) { return centers[a][axis] < centers[b][axis]; });
+
+        const uint32_t left = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(Node());
+        nodes.push_back(Node());
+        nodes[node].first = left;
+        nodes[node].count = 0;
+        split(left, first, mid - first, v, centers);
+        split(left + 1, mid, first + count - mid, v, centers);
+    }
+
+    static float boxDistance2(const Node& node, simd_float3 p) {
+        const simd_float3 d = simd_max(simd_max(node.min - p, p - node.max), simd_make_float3(0.0f, 0.0f, 0.0f));
+        return simd_length_squared(d);
+    }
+
+    // Closest point on any segment but skip; nearer subtrees first, and
+    // subtrees farther than the best so far are pruned
+    void closest(const std::vector<ofVec3f>& v, simd_float3 target, uint32_t skip,
+                 simd_float3& bestPoint, uint32_t& bestSegment) const {
+        const uint32_t n = static_cast<uint32_t>(v.size());
+        float bestDist2 = INFINITY;
+        uint32_t stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& node = nodes[stack[--top]];
+            if (boxDistance2(node, target) > bestDist2) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                    const uint32_t i = order[k];
+                    if (i == skip) continue;
+                    const simd_float3 p = closestOnSegment(target, toSimd(v[i]), toSimd(v[(i + 1) % n]));
+                    const float dist2 = simd_distance_squared(p, target);
+                    // Ties go to the first segment, as in a scan
+                    if (dist2 < bestDist2 || (dist2 == bestDist2 && i < bestSegment)) {
+                        bestDist2 = dist2;
+                        bestPoint = p;
+                        bestSegment = i;
+                    }
+                }
+                continue;
+            }
+            const uint32_t left = node.first;
+            const bool leftNearer = boxDistance2(nodes[left], target) <= boxDistance2(nodes[left + 1], target);
+            stack[top++] = leftNearer ? left + 1 : left;
+            stack[top++] = leftNearer ? left : left + 1;
+        }
+    }
+
+    // Crossings of the ray from p towards +x, as in inside()
+    int crossings(const std::vector<ofVec3f>& v, float x, float y) const {
+        const uint32_t n = static_cast<uint32_t>(v.size());
+        int count = 0;
+        uint32_t stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& node = nodes[stack[--top]];
+            // A crossing edge has one end above y and one at or below it,
+            // and crosses right of x
+            if (y < node.min.y || y >= node.max.y || x >= node.max.x) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (uint32_t k = node.first; k < node.first + node.count; ++k) {
+                    const uint32_t i = order[k];
+                    const ofVec3f& v1 = v[i];
+                    const ofVec3f& v2 = v[(i + 1) % n];
+                    if ((v1.y > y) != (v2.y > y)) {
+                        float xIntersect = v1.x + (y - v1.y) * (v2.x - v1.x) / (v2.y - v1.y);
+                        if (x < xIntersect) {
+                            count++;
+                        }
+                    }
+                }
+                continue;
+            }
+            stack[top++] = node.first;
+            stack[top++] = node.first + 1;
+        }
+        return count;
+    }
+};
+
 // ============================================================================
 // Constructors
 // ============================================================================
@@ -25,20 +208,25 @@ ofPolyline::ofPolyline(const std::vector<ofVec3f>& vertices)
 
 void ofPolyline::addVertex(float x, float y, float z) {
     vertices_.emplace_back(x, y, z);
+    flagChanged();
 }
 
 void ofPolyline::addVertex(const ofVec3f& p) {
     vertices_.push_back(p);
+    flagChanged();
 }
 
 void ofPolyline::addVertices(const std::vector<ofVec3f>& vertices) {
     vertices_.insert(vertices_.end(), vertices.begin(), vertices.end());
+    flagChanged();
 }
 
 void ofPolyline::addVertices(const float* vertices, size_t count) {
+    vertices_.reserve(vertices_.size() + count);
     for (size_t i = 0; i < count; ++i) {
         vertices_.emplace_back(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2]);
     }
+    flagChanged();
 }
 
 // ============================================================================
@@ -113,6 +301,7 @@ void ofPolyline::close() {
     if (!vertices_.empty() && vertices_.front() != vertices_.back()) {
         vertices_.push_back(vertices_.front());
     }
+    flagChanged();
 }
 
 bool ofPolyline::isClosed() const {
@@ -122,6 +311,7 @@ bool ofPolyline::isClosed() const {
 void ofPolyline::clear() {
     vertices_.clear();
     closed_ = false;
+    flagChanged();
 }
 
 // ============================================================================
@@ -133,12 +323,8 @@ void ofPolyline::draw() const {
         return;
     }
 
-    // Draw line segments between consecutive vertices
-    for (size_t i = 0; i < vertices_.size() - 1; ++i) {
-        const ofVec3f& v1 = vertices_[i];
-        const ofVec3f& v2 = vertices_[i + 1];
-        ofDrawLine(v1.x, v1.y, v1.z, v2.x, v2.y, v2.z);
-    }
+    // Wide lines are stroked with joins; thin ones draw as line segments
+    ofDrawPolyline(vertices_.data(), vertices_.size(), closed_);
 }
 
 // ============================================================================
@@ -150,6 +336,7 @@ const std::vector<ofVec3f>& ofPolyline::getVertices() const {
 }
 
 std::vector<ofVec3f>& ofPolyline::getVertices() {
+    flagChanged();  // The caller may edit them
     return vertices_;
 }
 
@@ -166,6 +353,7 @@ const ofVec3f& ofPolyline::operator[](size_t index) const {
 }
 
 ofVec3f& ofPolyline::operator[](size_t index) {
+    flagChanged();  // The caller may edit it
     return vertices_[index];
 }
 
@@ -178,11 +366,7 @@ float ofPolyline::getPerimeter() const {
         return 0.0f;
     }
 
-    float perimeter = 0.0f;
-    for (size_t i = 0; i < vertices_.size() - 1; ++i) {
-        perimeter += vertices_[i].distance(vertices_[i + 1]);
-    }
-
+    float perimeter = getLengths().back();
     if (closed_ && vertices_.size() > 2) {
         perimeter += vertices_.back().distance(vertices_.front());
     }
@@ -190,6 +374,14 @@ float ofPolyline::getPerimeter() const {
     return perimeter;
 }
 
+float ofPolyline::getLengthAtIndex(size_t index) const {
+    if (vertices_.empty()) {
+        return 0.0f;
+    }
+    const std::vector<float>& lengths = getLengths();
+    return lengths[std::min(index, lengths.size() - 1)];
+}
+
 float ofPolyline::getArea() const {
     if (!closed_ || vertices_.size() < 3) {
         return 0.0f;
@@ -231,19 +423,9 @@ ofRectangle ofPolyline::getBoundingBox() const {
         return ofRectangle(0, 0, 0, 0);
     }
 
-    float minX = vertices_[0].x;
-    float maxX = vertices_[0].x;
-    float minY = vertices_[0].y;
-    float maxY = vertices_[0].y;
-
-    for (const auto& v : vertices_) {
-        minX = std::min(minX, v.x);
-        maxX = std::max(maxX, v.x);
-        minY = std::min(minY, v.y);
-        maxY = std::max(maxY, v.y);
-    }
-
-    return ofRectangle(minX, minY, maxX - minX, maxY - minY);
+    updateBounds();
+    return ofRectangle(boundsMin_.x, boundsMin_.y,
+                       boundsMax_.x - boundsMin_.x, boundsMax_.y - boundsMin_.y);
 }
 
 // ============================================================================
@@ -260,40 +442,25 @@ ofVec3f ofPolyline::getClosestPoint(const ofVec3f& target, size_t* nearestIndex)
         return vertices_[0];
     }
 
-    float minDist = std::numeric_limits<float>::max();
-    ofVec3f closestPoint = vertices_[0];
-    size_t closestSegment = 0;
-
-    // Check each line segment
-    for (size_t i = 0; i < vertices_.size() - 1; ++i) {
-        const ofVec3f& p1 = vertices_[i];
-        const ofVec3f& p2 = vertices_[i + 1];
-
-        // Project target onto line segment
-        ofVec3f line = p2 - p1;
-        float lineLength = line.length();
-        if (lineLength < 1e-6f) {
-            // Degenerate segment
-            float dist = target.distance(p1);
-            if (dist < minDist) {
-                minDist = dist;
-                closestPoint = p1;
-                closestSegment = i;
-            }
-            continue;
-        }
-
-        ofVec3f lineNorm = line / lineLength;
-        float t = (target - p1).dot(lineNorm);
-        t = ofClamp(t, 0.0f, lineLength);
-
-        ofVec3f pointOnLine = p1 + lineNorm * t;
-        float dist = target.distance(pointOnLine);
+    const simd_float3 p = toSimd(target);
+    simd_float3 closestPoint = toSimd(vertices_[0]);
+    uint32_t closestSegment = 0;
 
-        if (dist < minDist) {
-            minDist = dist;
-            closestPoint = pointOnLine;
-            closestSegment = i;
+    if (const SegmentTree* tree = getQueryTree()) {
+        // The closing segment isn't part of the query
+        const uint32_t skip = closed_ ? static_cast<uint32_t>(vertices_.size() - 1) : UINT32_MAX;
+        tree->closest(vertices_, p, skip, closestPoint, closestSegment);
+    } else {
+        // Check each line segment
+        float minDist2 = std::numeric_limits<float>::max();
+        for (size_t i = 0; i < vertices_.size() - 1; ++i) {
+            const simd_float3 pointOnLine = closestOnSegment(p, toSimd(vertices_[i]), toSimd(vertices_[i + 1]));
+            const float dist2 = simd_distance_squared(p, pointOnLine);
+            if (dist2 < minDist2) {
+                minDist2 = dist2;
+                closestPoint = pointOnLine;
+                closestSegment = static_cast<uint32_t>(i);
+            }
         }
     }
 
@@ -301,7 +468,7 @@ ofVec3f ofPolyline::getClosestPoint(const ofVec3f& target, size_t* nearestIndex)
         *nearestIndex = closestSegment;
     }
 
-    return closestPoint;
+    return fromSimd(closestPoint);
 }
 
 bool ofPolyline::inside(float x, float y) const {
@@ -313,6 +480,16 @@ bool ofPolyline::inside(const ofVec3f& p) const {
         return false;
     }
 
+    // No edge crosses the ray of a point outside the bounds an odd number of times
+    updateBounds();
+    if (p.x < boundsMin_.x || p.x > boundsMax_.x || p.y < boundsMin_.y || p.y > boundsMax_.y) {
+        return false;
+    }
+
+    if (const SegmentTree* tree = getQueryTree()) {
+        return (tree->crossings(vertices_, p.x, p.y) % 2) == 1;
+    }
+
     // Ray casting algorithm for point-in-polygon test
     // Cast a ray from the point to the right and count intersections
     int intersections = 0;
@@ -344,21 +521,58 @@ void ofPolyline::simplify(float tolerance) {
         return;
     }
 
-    std::vector<bool> keepFlags(vertices_.size(), false);
-    keepFlags[0] = true;
-    keepFlags[vertices_.size() - 1] = true;
+    // Ramer-Douglas-Peucker with an explicit stack: long polylines would
+    // recurse deeply
+    const size_t n = vertices_.size();
+    const float tolerance2 = tolerance >= 0.0f ? tolerance * tolerance : -1.0f;
+    std::vector<uint8_t> keep(n, 0);
+    keep[0] = 1;
+    keep[n - 1] = 1;
+
+    std::vector<std::pair<size_t, size_t>> ranges;
+    ranges.emplace_back(0, n - 1);
+    while (!ranges.empty()) {
+        const auto [start, end] = ranges.back();
+        ranges.pop_back();
+        if (end - start < 2) {
+            continue;
+        }
 
-    simplifyDP(vertices_, tolerance, 0, vertices_.size() - 1, keepFlags);
+        const simd_float3 lineStart = toSimd(vertices_[start]);
+        const simd_float3 lineEnd = toSimd(vertices_[end]);
+        if (simd_length_squared(lineEnd - lineStart) < 1e-12f) {
+            continue;
+        }
 
-    // Build new vertex list
-    std::vector<ofVec3f> simplified;
-    for (size_t i = 0; i < vertices_.size(); ++i) {
-        if (keepFlags[i]) {
-            simplified.push_back(vertices_[i]);
+        // Find point with maximum distance from line segment
+        float maxDist2 = 0.0f;
+        size_t maxIndex = start;
+        for (size_t i = start + 1; i < end; ++i) {
+            const simd_float3 point = toSimd(vertices_[i]);
+            const float dist2 = simd_distance_squared(point, closestOnSegment(point, lineStart, lineEnd));
+            if (dist2 > maxDist2) {
+                maxDist2 = dist2;
+                maxIndex = i;
+            }
+        }
+
+        // If max distance is greater than tolerance, keep this point and split
+        if (maxDist2 > tolerance2) {
+            keep[maxIndex] = 1;
+            ranges.emplace_back(start, maxIndex);
+            ranges.emplace_back(maxIndex, end);
         }
     }
 
-    vertices_ = simplified;
+    // Compact the kept vertices in place
+    size_t kept = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (keep[i]) {
+            vertices_[kept++] = vertices_[i];
+        }
+    }
+    vertices_.resize(kept);
+    flagChanged();
 }
 
 ofPolyline ofPolyline::getResampledBySpacing(float spacing) const {
@@ -366,28 +580,26 @@ ofPolyline ofPolyline::getResampledBySpacing(float spacing) const {
         return *this;
     }
 
-    ofPolyline resampled;
-    resampled.vertices_.push_back(vertices_[0]);
-
-    float traveled = 0.0f;
+    // A point at every multiple of spacing along the polyline, found from
+    // the cumulative lengths in one pass
+    const std::vector<float>& lengths = getLengths();
+    const size_t n = vertices_.size();
+    const size_t steps = static_cast<size_t>(lengths.back() / spacing);
 
-    for (size_t i = 0; i < vertices_.size() - 1; ++i) {
-        ofVec3f p1 = vertices_[i];
-        ofVec3f p2 = vertices_[i + 1];
-        float segmentLength = p1.distance(p2);
-        ofVec3f direction = (p2 - p1).normalize();
-
-        while (traveled + segmentLength >= spacing) {
-            float remaining = spacing - traveled;
-            ofVec3f newPoint = p1 + direction * remaining;
-            resampled.vertices_.push_back(newPoint);
+    ofPolyline resampled;
+    resampled.vertices_.reserve(steps + 2);
 
-            p1 = newPoint;
-            segmentLength -= remaining;
-            traveled = 0.0f;
+    size_t segment = 0;
+    for (size_t k = 0; k <= steps; ++k) {
+        const float distance = static_cast<float>(k) * spacing;
+        while (segment + 2 < n && lengths[segment + 1] < distance) {
+            segment++;
         }
-
-        traveled += segmentLength;
+        const float segmentLength = lengths[segment + 1] - lengths[segment];
+        const float t = segmentLength > 0.0f
+            ? std::min((distance - lengths[segment]) / segmentLength, 1.0f) : 0.0f;
+        resampled.vertices_.push_back(fromSimd(simd_mix(toSimd(vertices_[segment]),
+                                                        toSimd(vertices_[segment + 1]), t)));
     }
 
     // Add last point if not already added
@@ -415,32 +627,57 @@ ofPolyline ofPolyline::getSmoothed(int smoothingSize, float smoothingShape) cons
         return *this;
     }
 
-    ofPolyline smoothed;
-    smoothed.vertices_.reserve(vertices_.size());
-
-    for (size_t i = 0; i < vertices_.size(); ++i) {
-        ofVec3f sum(0, 0, 0);
-        float weightSum = 0.0f;
+    const size_t n = vertices_.size();
+    const size_t size = static_cast<size_t>(smoothingSize);
 
-        for (int j = -smoothingSize; j <= smoothingSize; ++j) {
-            int idx = static_cast<int>(i) + j;
-            if (idx < 0 || idx >= static_cast<int>(vertices_.size())) {
-                continue;
-            }
+    // Gaussian-like weights for offsets -smoothingSize..smoothingSize
+    std::vector<float> weights(size * 2 + 1);
+    for (size_t k = 0; k < weights.size(); ++k) {
+        const float offset = std::abs(static_cast<float>(k) - static_cast<float>(size));
+        weights[k] = std::max(0.0f, 1.0f - (offset / static_cast<float>(size)) * smoothingShape);
+    }
 
-            // Gaussian-like weight
-            float weight = 1.0f - (std::abs(j) / static_cast<float>(smoothingSize)) * smoothingShape;
-            weight = std::max(0.0f, weight);
+    ofPolyline smoothed;
+    smoothed.vertices_.resize(n);
+
+    // Vertices with the whole window inside: one normalized convolution per
+    // channel over the interleaved xyz data
+    size_t interiorBegin = 0;
+    size_t interiorEnd = 0;
+    const float weightSum = std::accumulate(weights.begin(), weights.end(), 0.0f);
+    if (n >= weights.size() && weightSum > 0.0f) {
+        std::vector<float> kernel(weights);
+        for (float& w : kernel) {
+            w /= weightSum;
+        }
+        interiorBegin = size;
+        interiorEnd = n - size;
+        const float* in = &vertices_[0].x;
+        float* out = &smoothed.vertices_[interiorBegin].x;
+        for (int channel = 0; channel < 3; ++channel) {
+            vDSP_conv(in + channel, 3, kernel.data(), 1, out + channel, 3,
+                      interiorEnd - interiorBegin, kernel.size());
+        }
+    }
 
-            sum = sum + vertices_[idx] * weight;
-            weightSum += weight;
+    // Ends (and short polylines): the window is cut off and renormalized
+    for (size_t i = 0; i < n; ++i) {
+        if (i >= interiorBegin && i < interiorEnd) {
+            i = interiorEnd - 1;
+            continue;
         }
 
-        if (weightSum > 0.0f) {
-            smoothed.vertices_.push_back(sum / weightSum);
-        } else {
-            smoothed.vertices_.push_back(vertices_[i]);
+        simd_float3 sum = simd_make_float3(0.0f, 0.0f, 0.0f);
+        float sumWeights = 0.0f;
+        const size_t first = i >= size ? i - size : 0;
+        const size_t last = std::min(i + size, n - 1);
+        for (size_t j = first; j <= last; ++j) {
+            const float weight = weights[j + size - i];
+            sum += toSimd(vertices_[j]) * weight;
+            sumWeights += weight;
         }
+
+        smoothed.vertices_[i] = sumWeights > 0.0f ? fromSimd(sum / sumWeights) : vertices_[i];
     }
 
     smoothed.closed_ = closed_;
@@ -453,8 +690,8 @@ ofPolyline ofPolyline::getSmoothed(int smoothingSize, float smoothingShape) cons
 
 void ofPolyline::addCurveVertex(const ofVec3f& p0, const ofVec3f& p1,
                                 const ofVec3f& p2, const ofVec3f& p3) {
-    // Catmull-Rom curve interpolation
-    uint32_t resolution = ofGetCurveResolution();
+    // Catmull-Rom curve interpolation, fixed or adaptive resolution
+    uint32_t resolution = ofGetCurveSegments(p0, p1, p2, p3);
 
     for (uint32_t i = 1; i <= resolution; ++i) {
         float t = static_cast<float>(i) / static_cast<float>(resolution);
@@ -470,12 +707,13 @@ void ofPolyline::addCurveVertex(const ofVec3f& p0, const ofVec3f& p1,
         ofVec3f point = p0 * b0 + p1 * b1 + p2 * b2 + p3 * b3;
         vertices_.push_back(point);
     }
+    flagChanged();
 }
 
 void ofPolyline::addBezierVertex(const ofVec3f& p0, const ofVec3f& cp1,
                                  const ofVec3f& cp2, const ofVec3f& p1) {
-    // Cubic Bezier curve interpolation
-    uint32_t resolution = ofGetCurveResolution();
+    // Cubic Bezier curve interpolation, fixed or adaptive resolution
+    uint32_t resolution = ofGetBezierSegments(p0, cp1, cp2, p1);
 
     for (uint32_t i = 1; i <= resolution; ++i) {
         float t = static_cast<float>(i) / static_cast<float>(resolution);
@@ -490,6 +728,7 @@ void ofPolyline::addBezierVertex(const ofVec3f& p0, const ofVec3f& cp1,
                        cp2 * (3.0f * mt * t2) + p1 * t3;
         vertices_.push_back(point);
     }
+    flagChanged();
 }
 
 void ofPolyline::addArcVertices(float x, float y, float radius,
@@ -522,52 +761,69 @@ void ofPolyline::addArcVertices(float x, float y, float radius,
         float py = y + radius * std::sin(angle);
         vertices_.emplace_back(px, py, 0.0f);
     }
+    flagChanged();
 }
 
-void ofPolyline::simplifyDP(const std::vector<ofVec3f>& points,
-                           float tolerance,
-                           size_t start, size_t end,
-                           std::vector<bool>& keepFlags) const {
-    if (end - start < 2) {
-        return;
-    }
-
-    // Find point with maximum distance from line segment
-    float maxDist = 0.0f;
-    size_t maxIndex = start;
+// ============================================================================
+// Cached Derived Data
+// ============================================================================
 
-    ofVec3f lineStart = points[start];
-    ofVec3f lineEnd = points[end];
-    ofVec3f line = lineEnd - lineStart;
-    float lineLength = line.length();
+void ofPolyline::flagChanged() {
+    lengthsValid_ = false;
+    boundsValid_ = false;
+    tree_.reset();
+    queriesSinceEdit_ = 0;
+}
+
+const std::vector<float>& ofPolyline::getLengths() const {
+    if (!lengthsValid_) {
+        const size_t n = vertices_.size();
+        lengths_.resize(n);
+        float length = 0.0f;
+        for (size_t i = 0; i < n; ++i) {
+            if (i > 0) {
+                length += simd_distance(toSimd(vertices_[i - 1]), toSimd(vertices_[i]));
+            }
+            lengths_[i] = length;
+        }
+        lengthsValid_ = true;
+    }
+    return lengths_;
+}
 
-    if (lineLength < 1e-6f) {
+void ofPolyline::updateBounds() const {
+    if (boundsValid_ || vertices_.empty()) {
         return;
     }
+    const float* data = &vertices_[0].x;
+    const vDSP_Length count = vertices_.size();
+    vDSP_minv(data, 3, &boundsMin_.x, count);
+    vDSP_minv(data + 1, 3, &boundsMin_.y, count);
+    vDSP_minv(data + 2, 3, &boundsMin_.z, count);
+    vDSP_maxv(data, 3, &boundsMax_.x, count);
+    vDSP_maxv(data + 1, 3, &boundsMax_.y, count);
+    vDSP_maxv(data + 2, 3, &boundsMax_.z, count);
+    boundsValid_ = true;
+}
 
-    ofVec3f lineNorm = line / lineLength;
-
-    for (size_t i = start + 1; i < end; ++i) {
-        ofVec3f point = points[i];
-        ofVec3f toPoint = point - lineStart;
-        float projection = toPoint.dot(lineNorm);
-        projection = ofClamp(projection, 0.0f, lineLength);
-
-        ofVec3f closest = lineStart + lineNorm * projection;
-        float dist = point.distance(closest);
-
-        if (dist > maxDist) {
-            maxDist = dist;
-            maxIndex = i;
-        }
+const ofPolyline::SegmentTree* ofPolyline::getQueryTree() const {
+    if (tree_) {
+        return tree_.get();
+    }
+    if (vertices_.size() <= kTreeMinSegments) {
+        return nullptr;
     }
 
-    // If max distance is greater than tolerance, keep this point and recurse
-    if (maxDist > tolerance) {
-        keepFlags[maxIndex] = true;
-        simplifyDP(points, tolerance, start, maxIndex, keepFlags);
-        simplifyDP(points, tolerance, maxIndex, end, keepFlags);
+    // A single query after an edit is cheaper as a scan than a build
+    if (queriesSinceEdit_ == 0) {
+        queriesSinceEdit_ = 1;
+        return nullptr;
     }
+
+    auto tree = std::make_shared<SegmentTree>();
+    tree->build(vertices_, closed_);
+    tree_ = tree;
+    return tree_.get();
 }
 
 } // namespace oflike
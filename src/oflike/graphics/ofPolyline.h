@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../math/ofVec3f.h"
+#include <memory>
 #include <vector>
 #include <cstdint>
 
@@ -17,6 +18,13 @@ class ofRectangle;
  * arcs, and various geometric operations.
  *
  * Compatible with openFrameworks ofPolyline API.
+ *
+ * Cumulative lengths and bounds are cached on first use and dropped by any
+ * edit (including the non-const getVertices() and operator[]). Polylines of
+ * many segments also build a bounding volume hierarchy of their segments
+ * on the second getClosestPoint()/inside() query after an edit, so repeated
+ * queries cost O(log n) instead of O(n). Caches make const queries unsafe
+ * to call on one polyline from several threads at once.
  */
 class ofPolyline {
 public:
@@ -135,6 +143,10 @@ public:
     /// Get the total length (perimeter) of the polyline
     float getPerimeter() const;
 
+    /// Get the length along the polyline from the first vertex to a vertex
+    /// @param index Vertex index (clamped to the last vertex)
+    float getLengthAtIndex(size_t index) const;
+
     /// Get the area enclosed by the polyline (2D only, assumes XY plane)
     /// Returns 0 if polyline is not closed
     float getArea() const;
@@ -187,9 +199,30 @@ public:
     ofPolyline getSmoothed(int smoothingSize, float smoothingShape = 0.0f) const;
 
 private:
+    struct SegmentTree;
+
     std::vector<ofVec3f> vertices_;
     bool closed_;
 
+    // Derived data, rebuilt on demand after an edit
+    mutable std::vector<float> lengths_;                // Cumulative length at each vertex
+    mutable ofVec3f boundsMin_;
+    mutable ofVec3f boundsMax_;
+    mutable std::shared_ptr<const SegmentTree> tree_;   // Immutable, so copies may share it
+    mutable bool lengthsValid_ = false;
+    mutable bool boundsValid_ = false;
+    mutable uint8_t queriesSinceEdit_ = 0;
+
+    // Drop derived data after the vertices changed
+    void flagChanged();
+
+    const std::vector<float>& getLengths() const;
+    void updateBounds() const;
+
+    // Segment tree for queries, if the polyline is large enough and queried
+    // more than once since the last edit
+    const SegmentTree* getQueryTree() const;
+
     // Helper methods
     void addCurveVertex(const ofVec3f& p0, const ofVec3f& p1,
                        const ofVec3f& p2, const ofVec3f& p3);
@@ -197,12 +230,6 @@ private:
                         const ofVec3f& cp2, const ofVec3f& p1);
     void addArcVertices(float x, float y, float radius,
                        float angleBegin, float angleEnd, bool clockwise);
-
-    // Simplification helper (Ramer-Douglas-Peucker)
-    void simplifyDP(const std::vector<ofVec3f>& points,
-                   float tolerance,
-                   size_t start, size_t end,
-                   std::vector<bool>& keepFlags) const;
 };
 
 /**
@@ -0,0 +1,249 @@
+// ofPostProcessStack.cpp - post effects recorded as one fused command
+
+#include "ofPostProcessStack.h"
+#include "../image/ofTexture.h"
+#include "../utils/ofLog.h"
+#include "../../core/Context.h"
+#include "../../render/DrawList.h"
+#include "../../render/DrawCommand.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace oflike {
+
+static_assert(ofPostProcessStack::kMaxPasses == render::PostProcessCommand::kMaxPasses &&
+              ofPostProcessStack::kMaxPerPixelEffects == render::PostProcessCommand::kMaxStages &&
+              ofPostProcessStack::kMaxBloomLevels == render::PostProcessCommand::kMaxBloomLevels,
+              "ofPostProcessStack limits must match PostProcessCommand");
+
+// ============================================================================
+// Effects
+// ============================================================================
+
+namespace {
+
+enum class EffectKind {
+    PerPixel,
+    Blur,
+    Bloom
+};
+
+struct Effect {
+    EffectKind kind;
+    render::PostProcessStage stage;     // PerPixel
+    float a = 0.0f;                     // Blur sigma, bloom threshold
+    float b = 0.0f;                     // Bloom intensity
+    uint32_t levels = 0;                // Bloom
+};
+
+Effect makeStage(render::PostProcessOp op, float a, float b = 0.0f, float c = 0.0f) {
+    Effect effect;
+    effect.kind = EffectKind::PerPixel;
+    effect.stage.op = op;
+    effect.stage.a = a;
+    effect.stage.b = b;
+    effect.stage.c = c;
+    return effect;
+}
+
+/// Gaussian sigma of ofImageFilter::blur() for the same radius
+float blurSigma(float radius) {
+    int kernelSize = static_cast<int>(radius * 2.0f) | 1;
+    kernelSize = std::max(3, std::min(255, kernelSize));
+    return static_cast<float>(kernelSize) / (2.0f * std::sqrt(6.0f));
+}
+
+} // namespace
+
+// ============================================================================
+// ofPostProcessStack::Impl
+// ============================================================================
+
+struct ofPostProcessStack::Impl {
+    std::vector<Effect> effects;
+
+    void add(const Effect& effect) {
+        effects.push_back(effect);
+    }
+
+    // Passes of the command: one per run of per-pixel effects, blur or bloom
+    bool build(render::PostProcessCommand& cmd) const {
+        for (size_t i = 0; i < effects.size();) {
+            if (cmd.passCount == render::PostProcessCommand::kMaxPasses) {
+                return false;
+            }
+            render::PostProcessPass& pass = cmd.passes[cmd.passCount++];
+            const Effect& effect = effects[i];
+            switch (effect.kind) {
+                case EffectKind::PerPixel:
+                    pass.type = render::PostProcessPassType::Fused;
+                    pass.firstStage = cmd.stageCount;
+                    for (; i < effects.size() && effects[i].kind == EffectKind::PerPixel; i++) {
+                        if (cmd.stageCount == render::PostProcessCommand::kMaxStages) {
+                            return false;
+                        }
+                        cmd.stages[cmd.stageCount++] = effects[i].stage;
+                    }
+                    pass.stageCount = cmd.stageCount - pass.firstStage;
+                    continue;
+                case EffectKind::Blur:
+                    pass.type = render::PostProcessPassType::Blur;
+                    pass.params[0] = effect.a;
+                    break;
+                case EffectKind::Bloom:
+                    pass.type = render::PostProcessPassType::Bloom;
+                    pass.params[0] = effect.a;
+                    pass.params[1] = effect.b;
+                    pass.levels = effect.levels;
+                    break;
+            }
+            i++;
+        }
+        return cmd.passCount > 0;
+    }
+};
+
+// ============================================================================
+// Construction / Destruction
+// ============================================================================
+
+ofPostProcessStack::ofPostProcessStack()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ofPostProcessStack::~ofPostProcessStack() = default;
+
+ofPostProcessStack::ofPostProcessStack(ofPostProcessStack&& other) noexcept
+    : impl_(std::exchange(other.impl_, std::make_unique<Impl>())) {
+}
+
+ofPostProcessStack& ofPostProcessStack::operator=(ofPostProcessStack&& other) noexcept {
+    if (this != &other) {
+        impl_ = std::exchange(other.impl_, std::make_unique<Impl>());
+    }
+    return *this;
+}
+
+// ============================================================================
+// Per-Pixel Effects
+// ============================================================================
+
+ofPostProcessStack& ofPostProcessStack::exposure(float stops) {
+    impl_->add(makeStage(render::PostProcessOp::Exposure, std::exp2(stops)));
+    return *this;
+}
+
+ofPostProcessStack& ofPostProcessStack::contrast(float contrast, float pivot) {
+    impl_->add(makeStage(render::PostProcessOp::Contrast, contrast, pivot));
+    return *this;
+}
+
+ofPostProcessStack& ofPostProcessStack::saturation(float saturation) {
+    impl_->add(makeStage(render::PostProcessOp::Saturation, saturation));
+    return *this;
+}
+
+ofPostProcessStack& ofPostProcessStack::colorFilter(const ofFloatColor& color) {
+    impl_->add(makeStage(render::PostProcessOp::ColorFilter, color.r, color.g, color.b));
+    return *this;
+}
+
+ofPostProcessStack& ofPostProcessStack::vignette(float amount, float radius, float softness) {
+    impl_->add(makeStage(render::PostProcessOp::Vignette, std::max(0.0f, std::min(1.0f, amount)), radius,
+                         std::max(softness, 1e-3f)));
+    return *this;
+}
+
+ofPostProcessStack& ofPostProcessStack::tonemap(float exposure) {
+    impl_->add(makeStage(render::PostProcessOp::Tonemap, exposure));
+    return *this;
+}
+
+ofPostProcessStack& ofPostProcessStack::gamma(float gamma) {
+    if (gamma > 0.0f) {
+        impl_->add(makeStage(render::PostProcessOp::Gamma, 1.0f / gamma));
+    }
+    return *this;
+}
+
+// ============================================================================
+// Neighborhood Effects
+// ============================================================================
+
+ofPostProcessStack& ofPostProcessStack::blur(float radius) {
+    if (radius > 0.0f) {
+        Effect effect;
+        effect.kind = EffectKind::Blur;
+        effect.a = blurSigma(radius);
+        impl_->add(effect);
+    }
+    return *this;
+}
+
+ofPostProcessStack& ofPostProcessStack::bloom(float threshold, float intensity, int levels) {
+    Effect effect;
+    effect.kind = EffectKind::Bloom;
+    effect.a = std::max(0.0f, threshold);
+    effect.b = std::max(0.0f, intensity);
+    effect.levels = static_cast<uint32_t>(std::max(1, std::min(kMaxBloomLevels, levels)));
+    impl_->add(effect);
+    return *this;
+}
+
+// ============================================================================
+// Stack
+// ============================================================================
+
+void ofPostProcessStack::clear() {
+    impl_->effects.clear();
+}
+
+size_t ofPostProcessStack::getNumEffects() const {
+    return impl_->effects.size();
+}
+
+size_t ofPostProcessStack::getNumPasses() const {
+    const std::vector<Effect>& effects = impl_->effects;
+    size_t passes = 0;
+    for (size_t i = 0; i < effects.size(); i++) {
+        const bool runStart = effects[i].kind == EffectKind::PerPixel &&
+                              (i == 0 || effects[i - 1].kind != EffectKind::PerPixel);
+        const bool unfusedBloom = effects[i].kind == EffectKind::Bloom &&
+                                  (i + 1 == effects.size() || effects[i + 1].kind != EffectKind::PerPixel);
+        if (runStart || unfusedBloom || effects[i].kind == EffectKind::Blur) {
+            passes++;
+        }
+    }
+    return passes;
+}
+
+// ============================================================================
+// Apply
+// ============================================================================
+
+bool ofPostProcessStack::apply(const ofTexture& src, ofTexture& dst) {
+    auto& ctx = Context::instance();
+    if (&src == &dst || impl_->effects.empty() || !src.isAllocated() || src.isSubsection() ||
+        !src.getNativeHandle() || !ctx.isInitialized()) {
+        return false;
+    }
+
+    render::PostProcessCommand cmd;
+    if (!impl_->build(cmd)) {
+        ofLogError("ofPostProcessStack") << "More than " << kMaxPasses << " passes or "
+                                         << kMaxPerPixelEffects << " per-pixel effects";
+        return false;
+    }
+    if (!dst.allocateWritable(src.getWidth(), src.getHeight())) {
+        return false;
+    }
+
+    cmd.source = src.getNativeHandle();
+    cmd.destination = dst.getNativeHandle();
+    ctx.getDrawList().addCommand(cmd);
+    return true;
+}
+
+} // namespace oflike
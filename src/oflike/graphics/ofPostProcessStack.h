@@ -0,0 +1,146 @@
+#pragma once
+
+// oflike-metal ofPostProcessStack - post effects from one texture into another
+// Per-pixel effects fuse into one compute pass; blur and bloom run as compute
+// with transient intermediates the renderer aliases in a single heap
+
+#include <cstddef>
+#include <memory>
+#include "../types/ofColor.h"
+
+namespace oflike {
+
+class ofTexture;
+
+/// \brief Stack of post-processing effects applied with as few passes as possible
+/// \details Effects are recorded once and applied to a texture (typically an
+/// ofFbo's) each frame, in order. Instead of an ofFbo::begin()/end() and a
+/// full-screen draw per effect, the whole stack is one command in the frame:
+///
+/// - Runs of per-pixel effects (exposure, contrast, saturation, color
+///   filter, vignette, tonemap, gamma) are fused into a single compute pass
+///   that reads and writes every pixel once. Colors stay unclamped between
+///   them, so exposure and bloom above 1 tonemap instead of clipping.
+/// - Blur is a Gaussian pass of its own.
+/// - Bloom builds a half-size and smaller mip chain of the highlights; its
+///   composite is fused into the following per-pixel pass, so
+///   bloom().tonemap() costs one full-size pass plus the small chain.
+///
+/// Intermediates are not owned by the stack: they are transient RGBA16F
+/// textures aliased in one renderer heap, released after their last read,
+/// so any number of stacks share the memory of the largest one.
+///
+/// Example:
+/// \code
+///     ofFbo scene;
+///     ofTexture graded;
+///     ofPostProcessStack post;
+///     post.bloom(0.8f, 0.6f).exposure(0.5f).tonemap().vignette(0.4f);
+///
+///     void draw() {
+///         scene.begin();
+///         // ...
+///         scene.end();
+///         post.apply(scene.getTexture(), graded);   // 1 full-size pass
+///         graded.draw(0, 0);
+///     }
+/// \endcode
+class ofPostProcessStack {
+public:
+    static constexpr size_t kMaxPasses = 8;         // Fused runs, blurs and blooms
+    static constexpr size_t kMaxPerPixelEffects = 16;
+    static constexpr int kMaxBloomLevels = 8;
+
+    // ========================================================================
+    // Construction / Destruction
+    // ========================================================================
+
+    ofPostProcessStack();
+    ~ofPostProcessStack();
+
+    ofPostProcessStack(ofPostProcessStack&& other) noexcept;
+    ofPostProcessStack& operator=(ofPostProcessStack&& other) noexcept;
+
+    ofPostProcessStack(const ofPostProcessStack&) = delete;
+    ofPostProcessStack& operator=(const ofPostProcessStack&) = delete;
+
+    // ========================================================================
+    // Per-Pixel Effects (fused)
+    // ========================================================================
+
+    /// \brief Add an exposure change in stops (+1 doubles the light)
+    ofPostProcessStack& exposure(float stops);
+
+    /// \brief Add a contrast multiplier around a pivot (1 = unchanged)
+    ofPostProcessStack& contrast(float contrast, float pivot = 0.5f);
+
+    /// \brief Add a saturation multiplier (0 = grayscale, 1 = unchanged)
+    ofPostProcessStack& saturation(float saturation);
+
+    /// \brief Add a per-channel multiplier (tint)
+    ofPostProcessStack& colorFilter(const ofFloatColor& color);
+
+    /// \brief Add a vignette
+    /// \param amount Darkening in the corners (0-1)
+    /// \param radius Distance from the centre where it starts (0 = centre, 1 = corners)
+    /// \param softness Distance over which it reaches full strength
+    ofPostProcessStack& vignette(float amount, float radius = 0.5f, float softness = 0.5f);
+
+    /// \brief Add ACES filmic tonemapping of HDR colors into [0, 1]
+    /// \param exposure Multiplier applied before the curve
+    ofPostProcessStack& tonemap(float exposure = 1.0f);
+
+    /// \brief Add gamma correction, like ofImageFilter::gamma() (ignored if <= 0)
+    ofPostProcessStack& gamma(float gamma);
+
+    // ========================================================================
+    // Neighborhood Effects (compute)
+    // ========================================================================
+
+    /// \brief Add a Gaussian blur, like ofImageFilter::blur() (ignored if <= 0)
+    ofPostProcessStack& blur(float radius);
+
+    /// \brief Add bloom
+    /// \param threshold Brightness where highlights start to glow (0 = everything)
+    /// \param intensity Strength of the glow added back
+    /// \param levels Mip levels of the chain (1-8); more spread the glow wider
+    ofPostProcessStack& bloom(float threshold = 1.0f, float intensity = 1.0f, int levels = 5);
+
+    // ========================================================================
+    // Stack
+    // ========================================================================
+
+    /// \brief Remove all effects
+    void clear();
+
+    /// \brief Get the number of recorded effects
+    size_t getNumEffects() const;
+
+    /// \brief Get the number of full-size passes an apply() makes
+    /// \details Fused runs, blurs, and bloom composites with no per-pixel
+    /// effect after them; bloom chains run at half size and smaller.
+    size_t getNumPasses() const;
+
+    // ========================================================================
+    // Apply
+    // ========================================================================
+
+    /// \brief Apply the stack from one texture into another (GPU)
+    /// \details Recorded into the frame like the ofImageFilter texture
+    /// overloads: dst is allocated writable at the source size, 8 bits per
+    /// channel, so values above 1 clip unless the stack tonemaps them.
+    /// \param src Source texture (not a subsection), e.g. an ofFbo's
+    /// \param dst Destination texture (not src)
+    /// \return false without effects, with more than kMaxPasses passes or
+    /// kMaxPerPixelEffects per-pixel effects, or if nothing could be recorded
+    bool apply(const ofTexture& src, ofTexture& dst);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
+
+// Global namespace alias for openFrameworks compatibility
+using ofPostProcessStack = oflike::ofPostProcessStack;
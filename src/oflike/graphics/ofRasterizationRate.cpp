@@ -0,0 +1,66 @@
+#include "ofRasterizationRate.h"
+#include "../../core/Context.h"
+#include "../../render/IRenderer.h"
+#include <algorithm>
+#include <cmath>
+
+using oflike::ofRasterizationRate;
+
+namespace {
+    // Rate of each of count zones along an axis: 1 within radius of center,
+    // falling linearly to edgeRate at the farthest edge
+    std::vector<float> falloffZones(float center, float radius, float edgeRate, int count) {
+        const float reach = std::max(center, 1.0f - center);
+        std::vector<float> rates(count);
+        for (int i = 0; i < count; ++i) {
+            const float distance = std::fabs((i + 0.5f) / count - center);
+            const float t = reach > radius ? (distance - radius) / (reach - radius) : 0.0f;
+            rates[i] = 1.0f + (edgeRate - 1.0f) * std::clamp(t, 0.0f, 1.0f);
+        }
+        return rates;
+    }
+} // namespace
+
+ofRasterizationRate ofRasterizationRate::zones(const std::vector<float>& horizontal,
+                                               const std::vector<float>& vertical) {
+    ofRasterizationRate rate;
+    rate.rate_.horizontal = horizontal;
+    rate.rate_.vertical = vertical;
+    return rate;
+}
+
+ofRasterizationRate ofRasterizationRate::falloff(float radius, float edgeRate, float centerX, float centerY,
+                                                 int zonesPerAxis) {
+    const int count = std::max(zonesPerAxis, 1);
+    radius = std::clamp(radius, 0.0f, 1.0f);
+    edgeRate = std::clamp(edgeRate, render::kMinRasterizationRate, 1.0f);
+    centerX = std::clamp(centerX, 0.0f, 1.0f);
+    centerY = std::clamp(centerY, 0.0f, 1.0f);
+
+    ofRasterizationRate rate;
+    rate.rate_.horizontal = falloffZones(centerX, radius, edgeRate, count);
+    rate.rate_.vertical = falloffZones(centerY, radius, edgeRate, count);
+    return rate;
+}
+
+bool ofRasterizationRate::isFullRate() const {
+    auto full = [](const std::vector<float>& rates) {
+        return std::all_of(rates.begin(), rates.end(), [](float r) { return r >= 1.0f; });
+    };
+    return full(rate_.horizontal) && full(rate_.vertical);
+}
+
+bool ofSetRasterizationRate(const ofRasterizationRate& rate) {
+    auto* renderer = Context::instance().renderer();
+    if (!renderer) {
+        return false;
+    }
+    return renderer->setRasterizationRate(nullptr, rate.isFullRate() ? render::RasterizationRate() : rate.getRate());
+}
+
+void ofClearRasterizationRate() {
+    auto* renderer = Context::instance().renderer();
+    if (renderer) {
+        renderer->setRasterizationRate(nullptr, render::RasterizationRate());
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+// oflike-metal ofRasterizationRate - reduced shading resolution by screen region
+// Passes shade fewer pixels where detail isn't seen (dome periphery,
+// projector blend edges) and are resolved back to full size
+
+#include <vector>
+#include "../../render/RenderTypes.h"
+
+namespace oflike {
+
+/// \brief Shading rates across a render target, for the screen
+/// (ofSetRasterizationRate()) or an ofFbo (ofFbo::setRasterizationRate())
+/// \details The target is split into equal columns and rows, each shaded at
+/// a fraction of full resolution along its axis; a pixel in column c and
+/// row r costs horizontal[c] * vertical[r] of a full-rate one. Passes on the
+/// target rasterize through a Metal rasterization rate map into a smaller
+/// texture that is stretched back to full size when the target is read
+/// (bilinear within reduced zones).
+///
+/// - Savings scale with the fragment work: heavy 3D lighting and splats
+///   gain the most; the resolve costs one full-screen copy.
+/// - Rates are clamped to [1/16, 1]. A default-constructed rate is full
+///   resolution everywhere (off).
+/// - Fragment shaders see positions in the smaller texture, not target
+///   pixels; viewports, scissors and 2D coordinates are unchanged.
+/// - The resolve replaces the target's contents, so clear it each frame.
+/// - Multisampled targets and screens draw at full rate. The screen builds
+///   no occlusion pyramid while it has a rate.
+///
+/// Example:
+/// \code
+///     // Dome master: full rate within 60% of the center, a quarter at the rim
+///     ofSetRasterizationRate(ofRasterizationRate::falloff(0.6f, 0.25f));
+///
+///     // Projector with blend edges: half rate in the outer eighths
+///     ofRasterizationRate edges = ofRasterizationRate::zones(
+///         {0.5f, 1, 1, 1, 1, 1, 1, 0.5f}, {});
+///     output.setRasterizationRate(edges);
+/// \endcode
+class ofRasterizationRate {
+public:
+    /// \brief Full rate everywhere
+    ofRasterizationRate() = default;
+
+    /// \brief Rates per column and per row
+    /// \param horizontal Rate of each equal-width column, left to right (empty = full rate)
+    /// \param vertical Rate of each equal-height row, top to bottom (empty = full rate)
+    static ofRasterizationRate zones(const std::vector<float>& horizontal, const std::vector<float>& vertical);
+
+    /// \brief Full rate near a center, falling linearly to edgeRate at the edges
+    /// \details Each axis falls off on its own, so the full-rate region is
+    /// a rectangle. Distances are fractions of the target's size.
+    /// \param radius Distance from the center kept at full rate (0-1)
+    /// \param edgeRate Rate at the edge farthest from the center
+    /// \param centerX Horizontal center as a fraction of the width
+    /// \param centerY Vertical center as a fraction of the height
+    /// \param zonesPerAxis Columns and rows (more = smoother falloff)
+    static ofRasterizationRate falloff(float radius, float edgeRate,
+                                       float centerX = 0.5f, float centerY = 0.5f,
+                                       int zonesPerAxis = 16);
+
+    /// \brief Rates of the columns, left to right
+    const std::vector<float>& getHorizontal() const { return rate_.horizontal; }
+
+    /// \brief Rates of the rows, top to bottom
+    const std::vector<float>& getVertical() const { return rate_.vertical; }
+
+    /// \brief True if every zone is at full rate
+    bool isFullRate() const;
+
+    /// \brief Zones in renderer form
+    const render::RasterizationRate& getRate() const { return rate_; }
+
+private:
+    render::RasterizationRate rate_;
+};
+
+} // namespace oflike
+
+// Global namespace alias for openFrameworks compatibility
+using ofRasterizationRate = oflike::ofRasterizationRate;
+
+/// \brief Shade the screen at the given rates from the next pass on
+/// \return false if the GPU has no rasterization rate maps (the screen
+/// stays at full rate)
+bool ofSetRasterizationRate(const oflike::ofRasterizationRate& rate);
+
+/// \brief Shade the screen at full rate again
+void ofClearRasterizationRate();
@@ -23,9 +23,11 @@ class ofTexture;
 ///
 /// Features:
 /// - Load shaders from .metal source or .metallib
-/// - Set uniform values (float, vec, matrix, texture)
+/// - Set uniform values (float, vec, matrix, texture), by name or by location
 /// - begin/end for shader activation
-/// - Automatic uniform buffer management
+/// - Uniform layout reflected from the pipeline; each draw sees the values
+///   set before it (snapshots are suballocated from the frame's GPU ring)
+/// - Background compilation and source hot-reload that never stall a frame
 ///
 /// Note: Unlike OpenGL shaders, Metal shaders are compiled to .metallib at
 /// build time for optimal performance. Runtime compilation is also supported
@@ -42,6 +44,10 @@ class ofTexture;
 ///     shader.setUniformMatrix4f("modelMatrix", mesh.getTransformMatrix());
 ///     // Draw content here
 ///     shader.end();
+///
+///     // Live editing: recompile custom.metal whenever it is saved
+///     shader.loadAsync("shaders/custom");
+///     shader.setAutoReload(true);
 /// \endcode
 class ofShader {
 public:
@@ -96,6 +102,59 @@ public:
                         const std::string& vertexFunctionName = "vertex_main",
                         const std::string& fragmentFunctionName = "fragment_main");
 
+    /// \brief Compile a shader from file in the background
+    /// \details Looks up the same files as load() and compiles the library
+    /// and the pipeline without blocking the calling thread. The shader
+    /// keeps drawing with its current pipeline (or draws nothing if it has
+    /// none) until the compile finishes; the next begin() or update() then
+    /// swaps the new one in, carrying uniform values over by name. A failed
+    /// compile keeps the current pipeline and sets getCompileError(). A
+    /// newer load supersedes one still compiling.
+    /// \param shaderName Base name without extension
+    /// \param vertexFunctionName Name of vertex function in shader
+    /// \param fragmentFunctionName Name of fragment function in shader
+    /// \return false if there is no Metal device; compile errors arrive later
+    bool loadAsync(const std::string& shaderName,
+                   const std::string& vertexFunctionName = "vertex_main",
+                   const std::string& fragmentFunctionName = "fragment_main");
+
+    /// \brief Compile a shader from a source string in the background
+    /// \details As loadAsync().
+    /// \return false if there is no Metal device
+    bool loadFromSourceAsync(const std::string& source,
+                             const std::string& vertexFunctionName = "vertex_main",
+                             const std::string& fragmentFunctionName = "fragment_main");
+
+    /// \brief Swap in a background compile that has finished
+    /// \details begin() does this itself; call it to pick up the result (or
+    /// its error) without drawing. Does nothing while active.
+    /// \return true if a new pipeline was installed
+    bool update();
+
+    /// \brief Check if a background compile is in flight
+    bool isCompiling() const;
+
+    /// \brief Error from the last background compile that failed
+    /// \return Message, or empty once a compile succeeds
+    std::string getCompileError() const;
+
+    /// \brief Time the last successful load took to compile
+    /// \return Milliseconds for the library and pipeline together
+    float getLastCompileTime() const;
+
+    /// \brief Recompile the shader when its .metal source file changes
+    /// \details A background timer compares the file's modification time,
+    /// so saves that replace the file (as most editors do) are seen too.
+    /// A change compiles in the background as loadAsync() does and is
+    /// logged with its timings. Only shaders whose library was compiled
+    /// from a .metal file reload; metallibs and source strings don't.
+    /// \param enabled true to watch the file
+    /// \param interval Seconds between checks
+    void setAutoReload(bool enabled, float interval = 0.5f);
+
+    /// \brief Check if the source file is being watched
+    bool isAutoReloading() const;
+
     /// \brief Unload shader and free resources
     void unload();
 
@@ -243,6 +302,41 @@ public:
     /// \param count Number of vec4 elements
     void setUniform4fv(const std::string& name, const float* values, size_t count);
 
+    // ========================================================================
+    // Uniform Locations
+    // ========================================================================
+
+    /// \brief Get the location of a uniform for the location-based setters
+    /// \details Offsets are resolved once from the fragment function's
+    /// buffer(2) struct when the pipeline is created, so setting through a
+    /// location skips the name lookup. Nested struct members are named
+    /// "outer.inner". A shader whose buffer(2) isn't a struct packs names in
+    /// the order they are first set by name instead.
+    /// \param name Uniform name (struct member name in the shader)
+    /// \return Location, or -1 if the shader has no such uniform
+    int getUniformLocation(const std::string& name) const;
+
+    /// \brief Set float uniform by location
+    void setUniform1f(int location, float v);
+
+    /// \brief Set int uniform by location
+    void setUniform1i(int location, int v);
+
+    /// \brief Set vec2 uniform by location
+    void setUniform2f(int location, float x, float y);
+
+    /// \brief Set vec3 uniform by location
+    void setUniform3f(int location, float x, float y, float z);
+
+    /// \brief Set vec4 uniform by location
+    void setUniform4f(int location, float x, float y, float z, float w);
+
+    /// \brief Set vec4 uniform from color by location
+    void setUniform4f(int location, const ofFloatColor& c);
+
+    /// \brief Set mat4 uniform by location
+    void setUniformMatrix4f(int location, const ofMatrix4x4& m);
+
     // ========================================================================
     // Texture Setters
     // ========================================================================
@@ -2,15 +2,214 @@
 #import "../../core/Context.h"
 #import "../../render/DrawList.h"
 #import "../../render/DrawCommand.h"
+#import "../../render/IRenderer.h"
 #import "../image/ofTexture.h"
 #import <Metal/Metal.h>
 #import <Foundation/Foundation.h>
+#include <mach/mach_time.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include <cstring>
 
 namespace oflike {
 
+namespace {
+
+// Fragment buffer the renderer binds the uniform snapshot to
+constexpr NSUInteger kUniformBufferIndex = 2;
+
+// Size of the uniform block when the shader's layout can't be reflected
+constexpr size_t kUntypedUniformSize = 4096;
+
+double ticksToMs(uint64_t ticks) {
+    static const double msPerTick = [] {
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info(&timebase);
+        return static_cast<double>(timebase.numer) / timebase.denom / 1.0e6;
+    }();
+    return static_cast<double>(ticks) * msPerTick;
+}
+
+NSString* toNSString(const std::string& s) {
+    return [NSString stringWithUTF8String:s.c_str()];
+}
+
+std::string describe(NSError* error) {
+    return error ? error.localizedDescription.UTF8String : "unknown error";
+}
+
+MTLCompileOptions* compileOptions() {
+    MTLCompileOptions* options = [[MTLCompileOptions alloc] init];
+    options.fastMathEnabled = YES;
+    return options;
+}
+
+// Pipeline for standard BGRA output (matching MTKView) with alpha blending
+MTLRenderPipelineDescriptor* pipelineDescriptor(id<MTLFunction> vertexFunction, id<MTLFunction> fragmentFunction) {
+    MTLRenderPipelineDescriptor* desc = [[MTLRenderPipelineDescriptor alloc] init];
+    desc.vertexFunction = vertexFunction;
+    desc.fragmentFunction = fragmentFunction;
+
+    desc.colorAttachments[0].pixelFormat = MTLPixelFormatBGRA8Unorm;
+    desc.colorAttachments[0].blendingEnabled = YES;
+    desc.colorAttachments[0].sourceRGBBlendFactor = MTLBlendFactorSourceAlpha;
+    desc.colorAttachments[0].destinationRGBBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
+    desc.colorAttachments[0].sourceAlphaBlendFactor = MTLBlendFactorOne;
+    desc.colorAttachments[0].destinationAlphaBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
+
+    // Depth format (optional)
+    desc.depthAttachmentPixelFormat = MTLPixelFormatDepth32Float;
+    return desc;
+}
+
+// Modification time of a file in nanoseconds, 0 while it doesn't exist
+// (an editor's atomic save briefly removes it)
+uint64_t modificationTime(const std::string& path) {
+    struct stat info;
+    if (path.empty() || stat(path.c_str(), &info) != 0) {
+        return 0;
+    }
+    return (uint64_t)info.st_mtimespec.tv_sec * 1000000000ull + (uint64_t)info.st_mtimespec.tv_nsec;
+}
+
+// ============================================================================
+// Background Compilation
+// ============================================================================
+
+// Compiles requested off the render thread. Results wait here until the
+// render thread swaps them in; the blocks doing the work hold this (not the
+// shader), so a shader destroyed mid-compile just drops the result.
+struct AsyncCompile {
+    std::mutex mutex;
+    uint64_t generation = 0;        // Latest request; older results are dropped
+    bool compiling = false;
+
+    // Finished result of the latest request
+    bool ready = false;
+    id<MTLLibrary> library = nil;
+    id<MTLFunction> vertexFunction = nil;
+    id<MTLFunction> fragmentFunction = nil;
+    id<MTLRenderPipelineState> pipelineState = nil;
+    MTLRenderPipelineReflection* reflection = nil;
+    std::string error;              // Empty on success
+    std::string path;
+    std::string sourcePath;         // .metal file compiled, empty otherwise
+    std::string vertexFunctionName;
+    std::string fragmentFunctionName;
+    double libraryMs = 0.0;
+    double pipelineMs = 0.0;
+
+    // Source file the watcher recompiles when it changes
+    std::string watchedPath;
+    std::string watchedVertexName;
+    std::string watchedFragmentName;
+    uint64_t watchedTime = 0;
+};
+
+struct CompileRequest {
+    std::shared_ptr<AsyncCompile> state;
+    uint64_t generation = 0;
+    std::string path;
+    std::string sourcePath;
+    std::string vertexFunctionName;
+    std::string fragmentFunctionName;
+};
+
+// Start a request, superseding any in flight
+CompileRequest beginRequest(const std::shared_ptr<AsyncCompile>& state, const std::string& path,
+                            const std::string& sourcePath, const std::string& vertName, const std::string& fragName) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->compiling = true;
+    state->ready = false;
+    return {state, ++state->generation, path, sourcePath, vertName, fragName};
+}
+
+void finishRequest(const CompileRequest& request, id<MTLLibrary> library,
+                   id<MTLFunction> vertexFunction, id<MTLFunction> fragmentFunction,
+                   id<MTLRenderPipelineState> pipelineState, MTLRenderPipelineReflection* reflection,
+                   const std::string& error, double libraryMs, double pipelineMs) {
+    AsyncCompile& state = *request.state;
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (request.generation != state.generation) {
+        return;
+    }
+    state.compiling = false;
+    state.ready = true;
+    state.library = library;
+    state.vertexFunction = vertexFunction;
+    state.fragmentFunction = fragmentFunction;
+    state.pipelineState = pipelineState;
+    state.reflection = reflection;
+    state.error = error;
+    state.path = request.path;
+    state.sourcePath = request.sourcePath;
+    state.vertexFunctionName = request.vertexFunctionName;
+    state.fragmentFunctionName = request.fragmentFunctionName;
+    state.libraryMs = libraryMs;
+    state.pipelineMs = pipelineMs;
+}
+
+// Look up the functions and build the pipeline without waiting on either
+// compile; library is nil if compiling it failed with libraryError. Blocks
+// capture C++ references as references, so they capture copies.
+void linkAsync(id<MTLDevice> device, const CompileRequest& forRequest, id<MTLLibrary> library,
+               NSError* libraryError, double libraryMs) {
+    const CompileRequest request = forRequest;
+    if (!library) {
+        finishRequest(request, nil, nil, nil, nil, nil,
+                      "Compilation failed: " + describe(libraryError),
+                      libraryMs, 0.0);
+        return;
+    }
+    id<MTLFunction> vertexFunction = [library newFunctionWithName:toNSString(request.vertexFunctionName)];
+    id<MTLFunction> fragmentFunction = [library newFunctionWithName:toNSString(request.fragmentFunctionName)];
+    if (!vertexFunction || !fragmentFunction) {
+        const std::string& missing = vertexFunction ? request.fragmentFunctionName : request.vertexFunctionName;
+        finishRequest(request, nil, nil, nil, nil, nil, "Function '" + missing + "' not found", libraryMs, 0.0);
+        return;
+    }
+
+    const uint64_t start = mach_absolute_time();
+    [device newRenderPipelineStateWithDescriptor:pipelineDescriptor(vertexFunction, fragmentFunction)
+                                         options:MTLPipelineOptionBindingInfo
+                               completionHandler:^(id<MTLRenderPipelineState> pipelineState,
+                                                   MTLRenderPipelineReflection* reflection,
+                                                   NSError* error) {
+        const double pipelineMs = ticksToMs(mach_absolute_time() - start);
+        const std::string message = pipelineState ? std::string()
+            : "Pipeline creation failed: " + describe(error);
+        finishRequest(request, pipelineState ? library : nil, vertexFunction, fragmentFunction,
+                      pipelineState, reflection, message, libraryMs, pipelineMs);
+    }];
+}
+
+void compileSourceAsync(id<MTLDevice> device, const CompileRequest& forRequest, NSString* source) {
+    const CompileRequest request = forRequest;
+    const uint64_t start = mach_absolute_time();
+    [device newLibraryWithSource:source
+                         options:compileOptions()
+               completionHandler:^(id<MTLLibrary> library, NSError* error) {
+        linkAsync(device, request, library, error, ticksToMs(mach_absolute_time() - start));
+    }];
+}
+
+// Source of a .metal file, nil (with a message) if it can't be read
+NSString* readSource(const std::string& sourcePath, std::string& error) {
+    NSError* readError = nil;
+    NSString* source = [NSString stringWithContentsOfFile:toNSString(sourcePath)
+                                                 encoding:NSUTF8StringEncoding
+                                                    error:&readError];
+    if (!source) {
+        error = "Failed to read source: " + describe(readError);
+    }
+    return source;
+}
+
+} // namespace
+
 // ============================================================================
 // ofShader::Impl
 // ============================================================================
@@ -31,11 +230,33 @@ struct ofShader::Impl {
     id<MTLFunction> fragmentFunction = nil;
     id<MTLRenderPipelineState> pipelineState = nil;
 
-    // Uniform buffer data
-    std::unordered_map<std::string, size_t> uniformOffsets;
-    std::vector<uint8_t> uniformBuffer;
-    size_t uniformBufferSize = 0;
-    bool uniformsDirty = false;
+    // Background compiles and the source file watcher
+    std::shared_ptr<AsyncCompile> async = std::make_shared<AsyncCompile>();
+    dispatch_source_t watchTimer = nil;
+    std::string sourcePath;         // .metal file the library came from
+    std::string compileError;
+    double lastCompileMs = 0.0;
+
+    // Uniform layout, indexed by location; reflected from the fragment
+    // function's buffer(2) struct, or packed on first use without one
+    struct Uniform {
+        uint32_t offset = 0;
+        uint32_t size = 0;          // Bytes of one element
+        uint32_t stride = 0;        // Between array elements
+        uint32_t count = 1;         // Array length
+    };
+    std::vector<Uniform> uniforms;
+    std::unordered_map<std::string, int> uniformLocations;
+    std::vector<uint8_t> uniformBuffer;     // Current values, snapshotted per draw
+    bool reflected = false;
+
+    // Snapshot recorded by the last SetCustomShaderCommand while active; it
+    // is updated in place until a command follows it
+    render::DrawList* recordedList = nullptr;
+    uint64_t recordedGeneration = 0;
+    size_t recordedCommandCount = 0;
+    uint32_t recordedOffset = 0;
+    size_t recordedSize = 0;
 
     // Texture bindings
     struct TextureBinding {
@@ -51,28 +272,176 @@ struct ofShader::Impl {
     }
 
     Impl() {
-        // Reserve space for uniforms (4KB default)
-        uniformBuffer.resize(4096, 0);
-        uniformBufferSize = 4096;
+        resetUniforms();
     }
 
     ~Impl() {
+        setAutoReload(false, 0.0f);
         unload();
     }
 
     void unload() {
         @autoreleasepool {
+            cancelAsync();
+            sourcePath.clear();
+            compileError.clear();
             pipelineState = nil;
             vertexFunction = nil;
             fragmentFunction = nil;
             library = nil;
             loaded = false;
             active = false;
-            uniformOffsets.clear();
+            resetUniforms();
             textureBindings.clear();
         }
     }
 
+    void resetUniforms() {
+        uniforms.clear();
+        uniformLocations.clear();
+        uniformBuffer.assign(kUntypedUniformSize, 0);
+        reflected = false;
+        recordedList = nullptr;
+    }
+
+    // Resolve every uniform offset once from the pipeline reflection
+    void reflectUniforms(MTLRenderPipelineReflection* reflection) {
+        resetUniforms();
+        if (!reflection) {
+            return;
+        }
+        for (id<MTLBinding> binding in reflection.fragmentBindings) {
+            if (binding.type != MTLBindingTypeBuffer || binding.index != kUniformBufferIndex) {
+                continue;
+            }
+            id<MTLBufferBinding> buffer = (id<MTLBufferBinding>)binding;
+            if (!buffer.bufferStructType) {
+                return;     // Untyped pointer: keep packing on first use
+            }
+            uniformBuffer.assign(buffer.bufferDataSize, 0);
+            addMembers(buffer.bufferStructType, "", 0, (uint32_t)buffer.bufferDataSize);
+            reflected = true;
+            return;
+        }
+
+        // The fragment function reads no uniforms
+        uniformBuffer.clear();
+        reflected = true;
+    }
+
+    void addMembers(MTLStructType* type, const std::string& prefix, uint32_t base, uint32_t end) {
+        NSArray<MTLStructMember*>* members = type.members;
+        for (NSUInteger i = 0; i < members.count; i++) {
+            MTLStructMember* member = members[i];
+            const std::string name = prefix + member.name.UTF8String;
+            const uint32_t offset = base + (uint32_t)member.offset;
+            // A member extends to the next one (or the end of its struct)
+            const uint32_t next = i + 1 < members.count ? base + (uint32_t)members[i + 1].offset : end;
+
+            if (MTLStructType* nested = member.structType) {
+                addMembers(nested, name + ".", offset, next);
+                continue;
+            }
+            Uniform uniform;
+            uniform.offset = offset;
+            uniform.size = next - offset;
+            if (MTLArrayType* array = member.arrayType) {
+                uniform.stride = (uint32_t)array.stride;
+                uniform.count = (uint32_t)array.arrayLength;
+                uniform.size = uniform.stride;
+            }
+            uniformLocations[name] = (int)uniforms.size();
+            uniforms.push_back(uniform);
+        }
+    }
+
+    int getLocation(const std::string& name) const {
+        auto it = uniformLocations.find(name);
+        return it != uniformLocations.end() ? it->second : -1;
+    }
+
+    // Without a reflected layout a name gets 16-byte aligned space when first set
+    int locate(const std::string& name, size_t size, size_t count) {
+        int location = getLocation(name);
+        if (location >= 0 || reflected) {
+            return location;
+        }
+
+        size_t currentSize = 0;
+        for (const Uniform& uniform : uniforms) {
+            currentSize = std::max(currentSize, (size_t)uniform.offset + uniform.stride * (uniform.count - 1) + uniform.size);
+        }
+        Uniform uniform;
+        uniform.offset = (uint32_t)((currentSize + 15) & ~size_t(15));
+        uniform.size = (uint32_t)size;
+        uniform.stride = (uint32_t)((size + 15) & ~size_t(15));
+        uniform.count = (uint32_t)std::max<size_t>(count, 1);
+        const size_t end = (size_t)uniform.offset + (size_t)uniform.stride * uniform.count;
+        if (end > uniformBuffer.size()) {
+            uniformBuffer.resize(std::max(end, uniformBuffer.size() * 2), 0);
+        }
+
+        location = (int)uniforms.size();
+        uniformLocations[name] = location;
+        uniforms.push_back(uniform);
+        return location;
+    }
+
+    // Precompiled library holding both functions: the default library (shaders
+    // compiled into the app bundle), then {path}.metallib, then a bundled one
+    static id<MTLLibrary> findLibrary(id<MTLDevice> device, const std::string& path,
+                                      const std::string& vertName, const std::string& fragName) {
+        id<MTLLibrary> library = [device newDefaultLibrary];
+        if (library) {
+            // Check if the functions exist in the default library
+            id<MTLFunction> testVert = [library newFunctionWithName:toNSString(vertName)];
+            id<MTLFunction> testFrag = [library newFunctionWithName:toNSString(fragName)];
+            if (!testVert || !testFrag) {
+                // Functions not in default library, try other sources
+                library = nil;
+            }
+        }
+
+        // Try to load pre-compiled metallib first
+        if (!library) {
+            NSString* metallibPath = [NSString stringWithFormat:@"%s.metallib", path.c_str()];
+            if ([[NSFileManager defaultManager] fileExistsAtPath:metallibPath]) {
+                NSError* error = nil;
+                library = [device newLibraryWithFile:metallibPath error:&error];
+                if (!library) {
+                    NSLog(@"ofShader: Failed to load metallib: %@", error.localizedDescription);
+                }
+            }
+        }
+
+        // Try to load from bundle resources
+        if (!library) {
+            NSString* baseName = [toNSString(path) lastPathComponent];
+            NSString* bundlePath = [[NSBundle mainBundle] pathForResource:baseName ofType:@"metallib"];
+            if (bundlePath) {
+                NSError* error = nil;
+                library = [device newLibraryWithFile:bundlePath error:&error];
+                if (!library) {
+                    NSLog(@"ofShader: Failed to load bundled metallib: %@", error.localizedDescription);
+                }
+            }
+        }
+        return library;
+    }
+
+    // {path}.metal, or the bundled copy; empty if neither exists
+    static std::string findSource(const std::string& path) {
+        NSString* sourcePath = [NSString stringWithFormat:@"%s.metal", path.c_str()];
+        if (![[NSFileManager defaultManager] fileExistsAtPath:sourcePath]) {
+            NSString* baseName = [toNSString(path) lastPathComponent];
+            sourcePath = [[NSBundle mainBundle] pathForResource:baseName ofType:@"metal"];
+        }
+        if (!sourcePath || ![[NSFileManager defaultManager] fileExistsAtPath:sourcePath]) {
+            return std::string();
+        }
+        return sourcePath.UTF8String;
+    }
+
     bool loadFromFile(const std::string& path,
                       const std::string& vertName,
                       const std::string& fragName) {
@@ -89,82 +458,27 @@ struct ofShader::Impl {
             fragmentFunctionName = fragName;
             shaderPath = path;
 
-            // Try the default library first (shaders compiled into the app bundle)
-            library = [device newDefaultLibrary];
-            if (library) {
-                // Check if the functions exist in the default library
-                id<MTLFunction> testVert = [library newFunctionWithName:
-                    [NSString stringWithUTF8String:vertName.c_str()]];
-                id<MTLFunction> testFrag = [library newFunctionWithName:
-                    [NSString stringWithUTF8String:fragName.c_str()]];
-                if (!testVert || !testFrag) {
-                    // Functions not in default library, try other sources
-                    library = nil;
-                }
-            }
-
-            // Try to load pre-compiled metallib first
-            if (!library) {
-                NSString* metallibPath = [NSString stringWithFormat:@"%s.metallib",
-                                           path.c_str()];
-                if ([[NSFileManager defaultManager] fileExistsAtPath:metallibPath]) {
-                    NSError* error = nil;
-                    library = [device newLibraryWithFile:metallibPath error:&error];
-                    if (!library) {
-                        NSLog(@"ofShader: Failed to load metallib: %@",
-                              error.localizedDescription);
-                    }
-                }
-            }
-
-            // Try to load from bundle resources
-            if (!library) {
-                NSBundle* bundle = [NSBundle mainBundle];
-                NSString* baseName = [[NSString stringWithUTF8String:path.c_str()]
-                                       lastPathComponent];
-                NSString* bundlePath = [bundle pathForResource:baseName ofType:@"metallib"];
-                if (bundlePath) {
-                    NSError* error = nil;
-                    library = [device newLibraryWithFile:bundlePath error:&error];
-                    if (!library) {
-                        NSLog(@"ofShader: Failed to load bundled metallib: %@",
-                              error.localizedDescription);
-                    }
-                }
-            }
+            const uint64_t start = mach_absolute_time();
+            library = findLibrary(device, path, vertName, fragName);
 
             // Try to compile from source
             if (!library) {
-                NSString* sourcePath = [NSString stringWithFormat:@"%s.metal",
-                                         path.c_str()];
-                // Also check bundle
-                if (![[NSFileManager defaultManager] fileExistsAtPath:sourcePath]) {
-                    NSBundle* bundle = [NSBundle mainBundle];
-                    NSString* baseName = [[NSString stringWithUTF8String:path.c_str()]
-                                           lastPathComponent];
-                    sourcePath = [bundle pathForResource:baseName ofType:@"metal"];
-                }
-
-                if (sourcePath && [[NSFileManager defaultManager] fileExistsAtPath:sourcePath]) {
-                    NSError* readError = nil;
-                    NSString* source = [NSString stringWithContentsOfFile:sourcePath
-                                                                 encoding:NSUTF8StringEncoding
-                                                                    error:&readError];
-                    if (source) {
-                        MTLCompileOptions* options = [[MTLCompileOptions alloc] init];
-                        options.fastMathEnabled = YES;
-
+                const std::string source = findSource(path);
+                if (!source.empty()) {
+                    std::string readError;
+                    if (NSString* text = readSource(source, readError)) {
                         NSError* compileError = nil;
-                        library = [device newLibraryWithSource:source
-                                                       options:options
+                        library = [device newLibraryWithSource:text
+                                                       options:compileOptions()
                                                          error:&compileError];
-                        if (!library) {
+                        if (library) {
+                            sourcePath = source;
+                        } else {
                             NSLog(@"ofShader: Compilation failed: %@",
                                   compileError.localizedDescription);
                         }
                     } else {
-                        NSLog(@"ofShader: Failed to read source: %@",
-                              readError.localizedDescription);
+                        NSLog(@"ofShader: %s", readError.c_str());
                     }
                 }
             }
@@ -198,6 +512,8 @@ struct ofShader::Impl {
                 return false;
             }
 
+            lastCompileMs = ticksToMs(mach_absolute_time() - start);
+            watch(sourcePath, vertName, fragName);
             loaded = true;
             return true;
         }
@@ -220,12 +536,10 @@ struct ofShader::Impl {
             shaderPath = "<source>";
 
             // Compile source
-            MTLCompileOptions* options = [[MTLCompileOptions alloc] init];
-            options.fastMathEnabled = YES;
-
+            const uint64_t start = mach_absolute_time();
             NSError* error = nil;
-            library = [device newLibraryWithSource:[NSString stringWithUTF8String:source.c_str()]
-                                           options:options
+            library = [device newLibraryWithSource:toNSString(source)
+                                           options:compileOptions()
                                              error:&error];
             if (!library) {
                 NSLog(@"ofShader: Compilation failed: %@", error.localizedDescription);
@@ -250,6 +564,7 @@ struct ofShader::Impl {
                 return false;
             }
 
+            lastCompileMs = ticksToMs(mach_absolute_time() - start);
             loaded = true;
             return true;
         }
@@ -262,46 +577,235 @@ struct ofShader::Impl {
                 return false;
             }
 
-            MTLRenderPipelineDescriptor* desc = [[MTLRenderPipelineDescriptor alloc] init];
-            desc.vertexFunction = vertexFunction;
-            desc.fragmentFunction = fragmentFunction;
-
-            // Configure for standard BGRA output (matching MTKView)
-            desc.colorAttachments[0].pixelFormat = MTLPixelFormatBGRA8Unorm;
-            desc.colorAttachments[0].blendingEnabled = YES;
-            desc.colorAttachments[0].sourceRGBBlendFactor = MTLBlendFactorSourceAlpha;
-            desc.colorAttachments[0].destinationRGBBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
-            desc.colorAttachments[0].sourceAlphaBlendFactor = MTLBlendFactorOne;
-            desc.colorAttachments[0].destinationAlphaBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
-
-            // Depth format (optional)
-            desc.depthAttachmentPixelFormat = MTLPixelFormatDepth32Float;
+            MTLRenderPipelineDescriptor* desc = pipelineDescriptor(vertexFunction, fragmentFunction);
+
+            // Prefer the renderer's archive-backed cache so reloading the same
+            // shader on a later launch skips the backend compile
+            auto* renderer = Context::instance().renderer();
+            void* reflection = nullptr;
+            void* cached = renderer ? renderer->createRenderPipelineState((__bridge void*)desc, &reflection)
+                                    : nullptr;
+            if (cached) {
+                pipelineState = (__bridge_transfer id<MTLRenderPipelineState>)cached;
+                reflectUniforms((__bridge_transfer MTLRenderPipelineReflection*)reflection);
+                return true;
+            }
 
             NSError* error = nil;
-            pipelineState = [device newRenderPipelineStateWithDescriptor:desc error:&error];
+            MTLAutoreleasedRenderPipelineReflection reflected = nil;
+            pipelineState = [device newRenderPipelineStateWithDescriptor:desc
+                                                                 options:MTLPipelineOptionBindingInfo
+                                                              reflection:&reflected
+                                                                   error:&error];
 
             if (!pipelineState) {
                 NSLog(@"ofShader: Pipeline creation failed: %@", error.localizedDescription);
                 return false;
             }
 
+            reflectUniforms(reflected);
             return true;
         }
     }
 
-    void begin() {
-        if (!loaded || active) {
+    // ========================================================================
+    // Background Compilation
+    // ========================================================================
+
+    // Drop the result of any compile in flight
+    void cancelAsync() {
+        std::lock_guard<std::mutex> lock(async->mutex);
+        async->generation++;
+        async->compiling = false;
+        async->ready = false;
+        async->library = nil;
+        async->vertexFunction = nil;
+        async->fragmentFunction = nil;
+        async->pipelineState = nil;
+        async->reflection = nil;
+        async->watchedPath.clear();
+    }
+
+    bool loadAsync(const std::string& shaderName, const std::string& vertexName, const std::string& fragmentName) {
+        id<MTLDevice> device = getDevice();
+        if (!device) {
+            NSLog(@"ofShader: No Metal device available");
+            return false;
+        }
+
+        // Finding and reading the files happens off the render thread too
+        const std::string path = shaderName;
+        const std::string vertName = vertexName;
+        const std::string fragName = fragmentName;
+        const CompileRequest request = beginRequest(async, path, std::string(), vertName, fragName);
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            @autoreleasepool {
+                const uint64_t start = mach_absolute_time();
+                if (id<MTLLibrary> library = findLibrary(device, path, vertName, fragName)) {
+                    linkAsync(device, request, library, nil, ticksToMs(mach_absolute_time() - start));
+                    return;
+                }
+                CompileRequest fromSource = request;
+                fromSource.sourcePath = findSource(path);
+                std::string error = "Could not load shader from: " + path;
+                NSString* source = fromSource.sourcePath.empty() ? nil : readSource(fromSource.sourcePath, error);
+                if (!source) {
+                    finishRequest(request, nil, nil, nil, nil, nil, error, 0.0, 0.0);
+                    return;
+                }
+                compileSourceAsync(device, fromSource, source);
+            }
+        });
+        return true;
+    }
+
+    bool loadFromSourceAsync(const std::string& source, const std::string& vertName, const std::string& fragName) {
+        id<MTLDevice> device = getDevice();
+        if (!device) {
+            NSLog(@"ofShader: No Metal device available");
+            return false;
+        }
+        const CompileRequest request = beginRequest(async, "<source>", std::string(), vertName, fragName);
+        compileSourceAsync(device, request, toNSString(source));
+        return true;
+    }
+
+    bool isCompiling() const {
+        std::lock_guard<std::mutex> lock(async->mutex);
+        return async->compiling;
+    }
+
+    // Swap a finished compile in; on failure the current pipeline stays.
+    // Uniform values carry over by name into the new layout.
+    bool adoptCompiled() {
+        std::unique_lock<std::mutex> lock(async->mutex);
+        if (!async->ready || active) {
+            return false;
+        }
+        async->ready = false;
+        AsyncCompile result;
+        std::swap(result.library, async->library);
+        std::swap(result.vertexFunction, async->vertexFunction);
+        std::swap(result.fragmentFunction, async->fragmentFunction);
+        std::swap(result.pipelineState, async->pipelineState);
+        std::swap(result.reflection, async->reflection);
+        result.error = std::move(async->error);
+        result.path = std::move(async->path);
+        result.sourcePath = std::move(async->sourcePath);
+        result.vertexFunctionName = std::move(async->vertexFunctionName);
+        result.fragmentFunctionName = std::move(async->fragmentFunctionName);
+        result.libraryMs = async->libraryMs;
+        result.pipelineMs = async->pipelineMs;
+        lock.unlock();
+
+        if (!result.error.empty()) {
+            compileError = result.error;
+            NSLog(@"ofShader: %s (%s)", compileError.c_str(), result.path.c_str());
+            return false;
+        }
+
+        @autoreleasepool {
+            const std::vector<Uniform> oldUniforms = std::move(uniforms);
+            const std::unordered_map<std::string, int> oldLocations = std::move(uniformLocations);
+            const std::vector<uint8_t> oldValues = std::move(uniformBuffer);
+
+            library = result.library;
+            vertexFunction = result.vertexFunction;
+            fragmentFunction = result.fragmentFunction;
+            pipelineState = result.pipelineState;
+            reflectUniforms(result.reflection);
+            for (const auto& [name, oldLocation] : oldLocations) {
+                const Uniform& old = oldUniforms[oldLocation];
+                const int location = locate(name, old.size, old.count);
+                if (location < 0) {
+                    continue;
+                }
+                for (uint32_t element = 0; element < old.count; element++) {
+                    store(location, oldValues.data() + old.offset + element * old.stride, old.size, element);
+                }
+            }
+        }
+
+        shaderPath = result.path;
+        sourcePath = result.sourcePath;
+        vertexFunctionName = result.vertexFunctionName;
+        fragmentFunctionName = result.fragmentFunctionName;
+        compileError.clear();
+        lastCompileMs = result.libraryMs + result.pipelineMs;
+        if (loaded) {
+            NSLog(@"ofShader: Reloaded %s in %.1f ms (library %.1f, pipeline %.1f)", shaderPath.c_str(),
+                  lastCompileMs, result.libraryMs, result.pipelineMs);
+        }
+        watch(sourcePath, vertexFunctionName, fragmentFunctionName);
+        loaded = true;
+        return true;
+    }
+
+    // Point the watcher at the source file the library came from; a file it
+    // already watches keeps the time it was last seen at, so a save made
+    // while the previous one compiled still reloads
+    void watch(const std::string& path, const std::string& vertName, const std::string& fragName) {
+        std::lock_guard<std::mutex> lock(async->mutex);
+        if (path != async->watchedPath) {
+            async->watchedPath = path;
+            async->watchedTime = modificationTime(path);
+        }
+        async->watchedVertexName = vertName;
+        async->watchedFragmentName = fragName;
+    }
+
+    // Poll the source file's modification time on a background timer; a
+    // change starts a background compile that begin() swaps in when done
+    void setAutoReload(bool enabled, float interval) {
+        if (watchTimer) {
+            dispatch_source_cancel(watchTimer);
+            watchTimer = nil;
+        }
+        id<MTLDevice> device = getDevice();
+        if (!enabled || !device) {
             return;
         }
 
-        auto& ctx = Context::instance();
-        auto& drawList = ctx.getDrawList();
+        const uint64_t period = (uint64_t)(std::max(interval, 0.05f) * NSEC_PER_SEC);
+        std::shared_ptr<AsyncCompile> state = async;
+        watchTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0,
+                                            dispatch_get_global_queue(QOS_CLASS_UTILITY, 0));
+        dispatch_source_set_timer(watchTimer, dispatch_time(DISPATCH_TIME_NOW, period), period, period / 10);
+        dispatch_source_set_event_handler(watchTimer, ^{
+            std::unique_lock<std::mutex> lock(state->mutex);
+            const std::string path = state->watchedPath;
+            const uint64_t time = modificationTime(path);
+            if (time == 0 || time == state->watchedTime) {
+                return;
+            }
+            state->watchedTime = time;
+            const std::string vertName = state->watchedVertexName;
+            const std::string fragName = state->watchedFragmentName;
+            lock.unlock();
+
+            @autoreleasepool {
+                const CompileRequest request = beginRequest(state, path, path, vertName, fragName);
+                std::string error;
+                NSString* source = readSource(path, error);
+                if (!source) {
+                    finishRequest(request, nil, nil, nil, nil, nil, error, 0.0, 0.0);
+                    return;
+                }
+                compileSourceAsync(device, request, source);
+            }
+        });
+        dispatch_resume(watchTimer);
+    }
+
+    // Record the pipeline with a snapshot of the current uniforms; the
+    // draws that follow bind that snapshot, however the values change later
+    void recordState() {
+        render::DrawList& drawList = Context::instance().getDrawList();
 
-        // Add custom shader command
         render::SetCustomShaderCommand cmd;
         cmd.pipelineState = (__bridge void*)pipelineState;
-        cmd.uniformData = uniformBuffer.data();
-        cmd.uniformSize = uniformBuffer.size();
+        cmd.uniformOffset = drawList.addUniformData(uniformBuffer.data(), uniformBuffer.size());
+        cmd.uniformSize = (uint32_t)uniformBuffer.size();
 
         // Copy texture bindings
         for (const auto& [name, binding] : textureBindings) {
@@ -312,8 +816,31 @@ struct ofShader::Impl {
 
         drawList.addCommand(cmd);
 
+        recordedList = &drawList;
+        recordedGeneration = drawList.getGeneration();
+        recordedCommandCount = drawList.getCommandCount();
+        recordedOffset = cmd.uniformOffset;
+        recordedSize = uniformBuffer.size();
+    }
+
+    // Nothing has drawn with the recorded snapshot yet
+    bool snapshotPending() const {
+        render::DrawList& drawList = Context::instance().getDrawList();
+        return recordedList == &drawList && recordedGeneration == drawList.getGeneration() &&
+               recordedCommandCount == drawList.getCommandCount() && recordedSize == uniformBuffer.size();
+    }
+
+    void begin() {
+        if (active) {
+            return;
+        }
+        adoptCompiled();
+        if (!loaded) {
+            return;
+        }
+
+        recordState();
         active = true;
-        uniformsDirty = false;
     }
 
     void end() {
@@ -330,45 +857,69 @@ struct ofShader::Impl {
         drawList.addCommand(cmd);
 
         active = false;
+        recordedList = nullptr;
     }
 
     // Uniform setters
-    template<typename T>
-    void setUniform(const std::string& name, const T& value) {
-        // Find or allocate offset for this uniform
-        auto it = uniformOffsets.find(name);
-        size_t offset;
-
-        if (it == uniformOffsets.end()) {
-            // Align to 16 bytes for Metal requirements
-            size_t currentSize = 0;
-            for (const auto& [_, off] : uniformOffsets) {
-                currentSize = std::max(currentSize, off + sizeof(T));
-            }
-            offset = (currentSize + 15) & ~15;  // Align to 16
+    size_t store(int location, const void* data, size_t size, size_t element) {
+        if (location < 0 || (size_t)location >= uniforms.size()) {
+            return 0;
+        }
+        const Uniform& uniform = uniforms[location];
+        if (element >= uniform.count) {
+            return 0;
+        }
+        const size_t bytes = std::min(size, (size_t)uniform.size);
+        std::memcpy(uniformBuffer.data() + uniform.offset + element * uniform.stride, data, bytes);
+        return bytes;
+    }
 
-            // Grow buffer if needed
-            if (offset + sizeof(T) > uniformBufferSize) {
-                size_t newSize = uniformBufferSize * 2;
-                while (offset + sizeof(T) > newSize) {
-                    newSize *= 2;
-                }
-                uniformBuffer.resize(newSize, 0);
-                uniformBufferSize = newSize;
-            }
+    // While active, only the changed range of a pending snapshot is
+    // rewritten; once a draw has used it, later draws get a new one
+    void commit(int location, size_t first, size_t last) {
+        if (!active || location < 0 || (size_t)location >= uniforms.size()) {
+            return;
+        }
+        if (!snapshotPending()) {
+            recordState();
+            return;
+        }
+        const Uniform& uniform = uniforms[location];
+        const size_t begin = uniform.offset + first * uniform.stride;
+        const size_t end = uniform.offset + last * uniform.stride + uniform.size;
+        recordedList->updateUniformData(recordedOffset, begin, uniformBuffer.data() + begin,
+                                        std::min(end, uniformBuffer.size()) - begin);
+    }
 
-            uniformOffsets[name] = offset;
-        } else {
-            offset = it->second;
+    template<typename T>
+    void setUniform(int location, const T& value) {
+        if (store(location, &value, sizeof(T), 0) > 0) {
+            commit(location, 0, 0);
         }
+    }
+
+    template<typename T>
+    void setUniform(const std::string& name, const T& value) {
+        setUniform(locate(name, sizeof(T), 1), value);
+    }
 
-        // Copy value
-        std::memcpy(uniformBuffer.data() + offset, &value, sizeof(T));
-        uniformsDirty = true;
+    template<typename T>
+    void setUniformArray(const std::string& name, const T* values, size_t count) {
+        const int location = locate(name, sizeof(T), count);
+        size_t stored = 0;
+        while (stored < count && store(location, &values[stored], sizeof(T), stored) > 0) {
+            stored++;
+        }
+        if (stored > 0) {
+            commit(location, 0, stored - 1);
+        }
     }
 
     void setTexture(const std::string& name, void* texture, int index) {
         textureBindings[name] = {texture, index};
+        if (active) {
+            recordState();
+        }
     }
 };
 
@@ -411,6 +962,45 @@ bool ofShader::loadFromSource(const std::string& source,
     return impl_->loadFromSource(source, vertexFunctionName, fragmentFunctionName);
 }
 
+bool ofShader::loadAsync(const std::string& shaderName,
+                         const std::string& vertexFunctionName,
+                         const std::string& fragmentFunctionName) {
+    ensureImpl();
+    return impl_->loadAsync(shaderName, vertexFunctionName, fragmentFunctionName);
+}
+
+bool ofShader::loadFromSourceAsync(const std::string& source,
+                                   const std::string& vertexFunctionName,
+                                   const std::string& fragmentFunctionName) {
+    ensureImpl();
+    return impl_->loadFromSourceAsync(source, vertexFunctionName, fragmentFunctionName);
+}
+
+bool ofShader::update() {
+    return impl_ && impl_->adoptCompiled();
+}
+
+bool ofShader::isCompiling() const {
+    return impl_ && impl_->isCompiling();
+}
+
+std::string ofShader::getCompileError() const {
+    return impl_ ? impl_->compileError : "";
+}
+
+float ofShader::getLastCompileTime() const {
+    return impl_ ? (float)impl_->lastCompileMs : 0.0f;
+}
+
+void ofShader::setAutoReload(bool enabled, float interval) {
+    ensureImpl();
+    impl_->setAutoReload(enabled, interval);
+}
+
+bool ofShader::isAutoReloading() const {
+    return impl_ && impl_->watchTimer != nil;
+}
+
 void ofShader::unload() {
     if (impl_) {
         impl_->unload();
@@ -534,38 +1124,73 @@ void ofShader::setUniformMatrix4f(const std::string& name, const ofMatrix4x4& m)
 // Uniform setters - Arrays
 void ofShader::setUniform1fv(const std::string& name, const float* values, size_t count) {
     ensureImpl();
-    // Store as array in uniform buffer
-    for (size_t i = 0; i < count; ++i) {
-        std::string indexedName = name + "[" + std::to_string(i) + "]";
-        impl_->setUniform(indexedName, values[i]);
-    }
+    impl_->setUniformArray(name, values, count);
 }
 
 void ofShader::setUniform2fv(const std::string& name, const float* values, size_t count) {
     ensureImpl();
+    std::vector<simd_float2> v(count);
     for (size_t i = 0; i < count; ++i) {
-        std::string indexedName = name + "[" + std::to_string(i) + "]";
-        simd_float2 v = simd_make_float2(values[i*2], values[i*2+1]);
-        impl_->setUniform(indexedName, v);
+        v[i] = simd_make_float2(values[i*2], values[i*2+1]);
     }
+    impl_->setUniformArray(name, v.data(), count);
 }
 
 void ofShader::setUniform3fv(const std::string& name, const float* values, size_t count) {
     ensureImpl();
+    std::vector<simd_float3> v(count);
     for (size_t i = 0; i < count; ++i) {
-        std::string indexedName = name + "[" + std::to_string(i) + "]";
-        simd_float3 v = simd_make_float3(values[i*3], values[i*3+1], values[i*3+2]);
-        impl_->setUniform(indexedName, v);
+        v[i] = simd_make_float3(values[i*3], values[i*3+1], values[i*3+2]);
     }
+    impl_->setUniformArray(name, v.data(), count);
 }
 
 void ofShader::setUniform4fv(const std::string& name, const float* values, size_t count) {
     ensureImpl();
+    std::vector<simd_float4> v(count);
     for (size_t i = 0; i < count; ++i) {
-        std::string indexedName = name + "[" + std::to_string(i) + "]";
-        simd_float4 v = simd_make_float4(values[i*4], values[i*4+1], values[i*4+2], values[i*4+3]);
-        impl_->setUniform(indexedName, v);
+        v[i] = simd_make_float4(values[i*4], values[i*4+1], values[i*4+2], values[i*4+3]);
     }
+    impl_->setUniformArray(name, v.data(), count);
+}
+
+// Uniform locations
+int ofShader::getUniformLocation(const std::string& name) const {
+    return impl_ ? impl_->getLocation(name) : -1;
+}
+
+void ofShader::setUniform1f(int location, float v) {
+    ensureImpl();
+    impl_->setUniform(location, v);
+}
+
+void ofShader::setUniform1i(int location, int v) {
+    ensureImpl();
+    impl_->setUniform(location, v);
+}
+
+void ofShader::setUniform2f(int location, float x, float y) {
+    ensureImpl();
+    impl_->setUniform(location, simd_make_float2(x, y));
+}
+
+void ofShader::setUniform3f(int location, float x, float y, float z) {
+    ensureImpl();
+    impl_->setUniform(location, simd_make_float3(x, y, z));
+}
+
+void ofShader::setUniform4f(int location, float x, float y, float z, float w) {
+    ensureImpl();
+    impl_->setUniform(location, simd_make_float4(x, y, z, w));
+}
+
+void ofShader::setUniform4f(int location, const ofFloatColor& c) {
+    setUniform4f(location, c.r, c.g, c.b, c.a);
+}
+
+void ofShader::setUniformMatrix4f(int location, const ofMatrix4x4& m) {
+    ensureImpl();
+    impl_->setUniform(location, m.mat);
 }
 
 // Texture setters
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include "ofPath.h"  // Required for std::vector<ofPath> return type
+#include "../types/ofColor.h"
 
 // Simple rectangle structure (ofRectangle will be implemented in Phase 14)
 struct ofRectangle {
@@ -19,8 +20,9 @@ class ofTrueTypeFont {
 public:
     /// \brief Font rendering modes
     enum class RenderMode {
-        Texture,    ///< Bitmap texture (default, fast)
-        Shapes      ///< Vector shapes (slow, scalable)
+        Texture,       ///< Bitmap texture (default, fast)
+        Shapes,        ///< Vector shapes (slow, scalable)
+        DistanceField  ///< Distance field texture shared by all sizes of the face (fast, scalable)
     };
 
     ofTrueTypeFont();
@@ -60,6 +62,11 @@ public:
     /// \param y Y position (baseline)
     void drawString(const std::string& text, float x, float y) const;
 
+    /// \brief Draw text with a color per glyph (bitmap mode)
+    /// \param glyphColors Colors by character; characters past the end use the current color
+    void drawString(const std::string& text, float x, float y,
+                    const std::vector<oflike::ofColor>& glyphColors) const;
+
     /// \brief Draw text as vector shapes (slow, scalable)
     void drawStringAsShapes(const std::string& text, float x, float y) const;
 
@@ -1,7 +1,9 @@
 #include "ofTrueTypeFont.h"
 #include "ofPath.h"
 #include "ofGraphics.h"
+#include "ofGraphicsTransform.h"
 #include "../image/ofTexture.h"
+#include "../image/ofTextureAtlas.h"
 #include "../image/ofPixels.h"
 #include "../math/ofMatrix4x4.h"
 #include "../utils/ofLog.h"
@@ -10,9 +12,12 @@
 #include "../../render/DrawList.h"
 #include "../../render/RenderTypes.h"
 #include "../../render/DrawCommand.h"
+#include "../../render/IRenderer.h"
 #include <CoreText/CoreText.h>
 #include <CoreGraphics/CoreGraphics.h>
 #include <Foundation/Foundation.h>
+#include <algorithm>
+#include <cmath>
 #include <unordered_map>
 #include <codecvt>
 #include <locale>
@@ -34,6 +39,142 @@ namespace {
         return fontPath.find('.') == std::string::npos &&
                fontPath.find('/') == std::string::npos;
     }
+
+    // Atlas pages per font; when all are full the least recently drawn one
+    // is emptied for new glyphs
+    constexpr int kMaxAtlasPages = 4;
+
+    // Transparent border around bitmap glyphs
+    constexpr int kGlyphPadding = 2;
+
+    // Distance field glyphs: rasterized once at this size (pixels per em),
+    // with distances up to the spread (pixels) on both sides of the edge
+    constexpr float kDistanceFieldSize = 64.0f;
+    constexpr float kDistanceFieldSpread = 8.0f;
+    constexpr int kDistanceFieldPageSize = 2048;
+
+    // Laid out strings kept per font; the cache is emptied when full
+    constexpr size_t kMaxCachedLayouts = 256;
+
+    // Line segment of a flattened glyph outline, in glyph space (y up)
+    struct OutlineSegment {
+        float x0, y0, x1, y1;
+    };
+
+    // Flattens a CGPath into segments; open subpaths are closed, as a fill does
+    struct OutlineBuilder {
+        std::vector<OutlineSegment> segments;
+        CGPoint start = CGPointZero;
+        CGPoint current = CGPointZero;
+
+        void lineTo(CGPoint p) {
+            if (p.x != current.x || p.y != current.y) {
+                segments.push_back({(float)current.x, (float)current.y, (float)p.x, (float)p.y});
+            }
+            current = p;
+        }
+
+        void moveTo(CGPoint p) {
+            lineTo(start);
+            start = current = p;
+        }
+    };
+
+    std::vector<OutlineSegment> flattenGlyphOutline(CTFontRef font, CGGlyph glyph) {
+        OutlineBuilder builder;
+        CGPathRef path = CTFontCreatePathForGlyph(font, glyph, nullptr);
+        if (!path) {
+            return builder.segments;
+        }
+
+        CGPathApply(path, &builder, [](void* info, const CGPathElement* element) {
+            OutlineBuilder* b = static_cast<OutlineBuilder*>(info);
+            const CGPoint* pts = element->points;
+            const CGPoint p0 = b->current;
+            switch (element->type) {
+                case kCGPathElementMoveToPoint:
+                    b->moveTo(pts[0]);
+                    break;
+                case kCGPathElementAddLineToPoint:
+                    b->lineTo(pts[0]);
+                    break;
+                case kCGPathElementAddQuadCurveToPoint:
+                    for (int i = 1; i <= 8; ++i) {
+                        const CGFloat t = i / 8.0, u = 1.0 - t;
+                        b->lineTo(CGPointMake(u * u * p0.x + 2 * u * t * pts[0].x + t * t * pts[1].x,
+                                              u * u * p0.y + 2 * u * t * pts[0].y + t * t * pts[1].y));
+                    }
+                    break;
+                case kCGPathElementAddCurveToPoint:
+                    for (int i = 1; i <= 12; ++i) {
+                        const CGFloat t = i / 12.0, u = 1.0 - t;
+                        b->lineTo(CGPointMake(
+                            u * u * u * p0.x + 3 * u * u * t * pts[0].x + 3 * u * t * t * pts[1].x + t * t * t * pts[2].x,
+                            u * u * u * p0.y + 3 * u * u * t * pts[0].y + 3 * u * t * t * pts[1].y + t * t * t * pts[2].y));
+                    }
+                    break;
+                case kCGPathElementCloseSubpath:
+                    b->lineTo(b->start);
+                    break;
+            }
+        });
+        builder.lineTo(builder.start);
+
+        CGPathRelease(path);
+        return builder.segments;
+    }
+
+    // Signed distance field of an outline over its bounds plus the spread,
+    // as white RGBA with the field in alpha (0.5 on the edge, 1 inside).
+    // Exact distance to the nearest segment; inside by nonzero winding.
+    // quad receives the field's rectangle in glyph space (y up).
+    ofPixels rasterizeDistanceField(const std::vector<OutlineSegment>& segments,
+                                    const CGRect& bounds, ofRectangle& quad) {
+        const float spread = kDistanceFieldSpread;
+        const int left = (int)std::floor(CGRectGetMinX(bounds) - spread);
+        const int bottom = (int)std::floor(CGRectGetMinY(bounds) - spread);
+        const int right = (int)std::ceil(CGRectGetMaxX(bounds) + spread);
+        const int top = (int)std::ceil(CGRectGetMaxY(bounds) + spread);
+        const int width = right - left;
+        const int height = top - bottom;
+        quad = ofRectangle((float)left, (float)bottom, (float)width, (float)height);
+
+        ofPixels pixels;
+        pixels.allocate(width, height, 4);
+        unsigned char* dst = pixels.getData();
+        for (int row = 0; row < height; ++row) {
+            const float y = top - (row + 0.5f);  // Row 0 is the top
+            for (int col = 0; col < width; ++col, dst += 4) {
+                const float x = left + col + 0.5f;
+                float nearest = spread * spread;
+                int winding = 0;
+                for (const OutlineSegment& seg : segments) {
+                    const float dx = seg.x1 - seg.x0;
+                    const float dy = seg.y1 - seg.y0;
+                    const float px = x - seg.x0;
+                    const float py = y - seg.y0;
+                    const float length2 = dx * dx + dy * dy;
+                    const float t = length2 > 0.0f ? std::clamp((px * dx + py * dy) / length2, 0.0f, 1.0f) : 0.0f;
+                    const float ex = px - t * dx;
+                    const float ey = py - t * dy;
+                    nearest = std::min(nearest, ex * ex + ey * ey);
+
+                    // Crossings of the ray towards +x, signed by direction
+                    const float side = dx * py - px * dy;
+                    if (seg.y0 <= y) {
+                        if (seg.y1 > y && side > 0.0f) ++winding;
+                    } else if (seg.y1 <= y && side < 0.0f) {
+                        --winding;
+                    }
+                }
+                const float distance = winding != 0 ? std::sqrt(nearest) : -std::sqrt(nearest);
+                const float value = std::clamp(0.5f + distance / (2.0f * spread), 0.0f, 1.0f);
+                dst[0] = dst[1] = dst[2] = 255;
+                dst[3] = (unsigned char)(value * 255.0f + 0.5f);
+            }
+        }
+        return pixels;
+    }
 }
 
 // ============================================================
@@ -43,10 +184,75 @@ namespace {
 struct GlyphInfo {
     ofRectangle texCoords;  // UV coordinates in atlas (0-1)
     ofRectangle bounds;     // Glyph bounds in pixels
+    ofRectangle quad;       // Textured rectangle in pixels, border included (y up, as bounds)
     float advance;          // Horizontal advance
+    int page = -1;          // Atlas page, -1 for empty glyphs
     bool cached = false;
 };
 
+// Glyphs packed into atlas pages. New glyphs are written to the pages' CPU
+// copies and uploaded by flush(); when all pages are full the least
+// recently drawn one is emptied for new glyphs
+struct GlyphAtlas {
+    oflike::ofTextureAtlas atlas;
+    std::unordered_map<char32_t, GlyphInfo> glyphs;
+    std::vector<unsigned long long> pageLastUsed;  // Frame each page was last drawn in
+    uint64_t generation = 0;                       // Incremented when a page is evicted
+    int pageSize = 1024;
+
+    void setup(int size) {
+        pageSize = size;
+        atlas.setup(size, size, 1, kMaxAtlasPages);
+        atlas.setDeferredUploads(true);
+        glyphs.clear();
+        pageLastUsed.clear();
+    }
+
+    // Pack a glyph's pixels, setting info's texCoords and page
+    bool insert(const ofPixels& pixels, GlyphInfo& info);
+
+    // Record that a page is drawn this frame
+    void touchPage(int page);
+
+    // Empty the least recently drawn page and forget its glyphs; false if
+    // every page was drawn in a frame that may still be in flight
+    bool evictPage();
+};
+
+// A string's glyph quads relative to its origin, kept until the glyph atlas
+// evicts a page (its texture coordinates may then be stale)
+struct TextLayout {
+    struct Quad {
+        simd_float2 min, max;  // Pixels from the origin, y down
+        simd_float2 uv0, uv1;
+        int page;
+        uint32_t character;    // Index in the string's characters, for per-glyph colors
+    };
+    std::vector<Quad> quads;
+    int numPages = 0;
+    float width = 0.0f;        // As stringWidth()
+    uint64_t generation = 0;   // GlyphAtlas::generation laid out with
+};
+
+// Distance field glyphs of one face, rasterized once at kDistanceFieldSize
+// and shared by every font of the face whatever its size
+struct DistanceFieldFace {
+    CTFontRef font = nullptr;
+    GlyphAtlas glyphs;
+
+    ~DistanceFieldFace() {
+        if (font) {
+            CFRelease(font);
+        }
+    }
+
+    // Get or create a glyph, in pixels at kDistanceFieldSize
+    const GlyphInfo* getGlyph(char32_t ch);
+
+    // The face of a font, shared while any font of it is using it
+    static std::shared_ptr<DistanceFieldFace> acquire(CTFontRef font);
+};
+
 // ============================================================
 // Implementation
 // ============================================================
@@ -60,16 +266,18 @@ struct ofTrueTypeFont::Impl {
     bool loaded = false;
     RenderMode renderMode = RenderMode::Texture;
 
-    // Atlas
-    std::unique_ptr<ofTexture> atlasTexture;
-    int atlasWidth = 1024;
-    int atlasHeight = 1024;
-    int atlasCursorX = 0;
-    int atlasCursorY = 0;
-    int atlasRowHeight = 0;
+    // Bitmap glyphs at this font's size; uploaded once per drawString(),
+    // which draws with one command per page
+    GlyphAtlas bitmaps;
+
+    // Distance field glyphs (RenderMode::DistanceField), created on first use
+    std::shared_ptr<DistanceFieldFace> distanceField;
+
+    // Laid out strings by text, for the render mode and letter spacing
+    std::unordered_map<std::string, TextLayout> layouts;
 
-    // Glyph cache
-    std::unordered_map<char32_t, GlyphInfo> glyphCache;
+    // Vertices of each atlas page, reused by drawString()
+    std::vector<std::vector<render::Vertex2D>> pageVertices;
 
     ~Impl() {
         if (ctFont) {
@@ -87,6 +295,18 @@ struct ofTrueTypeFont::Impl {
     // Get or create glyph info
     const GlyphInfo* getGlyphInfo(char32_t ch);
 
+    // Glyphs of the render mode: bitmaps, or the face's distance fields
+    GlyphAtlas& currentGlyphs();
+
+    // Glyph of the render mode, in pixels at glyphScale() times this size
+    const GlyphInfo* getGlyph(char32_t ch);
+
+    // Scale from the render mode's glyphs to this font's size
+    float glyphScale() const;
+
+    // Cached layout of a string, laid out again after an atlas eviction
+    const TextLayout& getLayout(const std::string& text);
+
     // Render glyph to bitmap
     ofPixels renderGlyphBitmap(char32_t ch, ofRectangle& bounds, float& advance);
 
@@ -129,9 +349,10 @@ bool ofTrueTypeFont::Impl::loadFont(const std::string& fontPath, float size, flo
         fontSize = size;
         loaded = true;
 
-        // Initialize atlas texture
-        atlasTexture = std::make_unique<ofTexture>();
-        atlasTexture->allocate(atlasWidth, atlasHeight, 1);  // Single channel (alpha)
+        // Initialize atlas (pages are created as glyphs fill them)
+        bitmaps.setup(1024);
+        distanceField.reset();
+        layouts.clear();
 
         oflike::ofLogVerbose("ofTrueTypeFont") << "Loaded font: " << fontPath << " (" << size << "pt)";
         return true;
@@ -160,7 +381,7 @@ ofPixels ofTrueTypeFont::Impl::renderGlyphBitmap(char32_t ch, ofRectangle& bound
         CTFontGetBoundingRectsForGlyphs(ctFont, kCTFontOrientationHorizontal, &glyph, &glyphBounds, 1);
 
         // Add padding
-        int padding = 2;
+        int padding = kGlyphPadding;
         int width = (int)std::ceil(glyphBounds.size.width) + padding * 2;
         int height = (int)std::ceil(glyphBounds.size.height) + padding * 2;
 
@@ -229,7 +450,7 @@ ofPixels ofTrueTypeFont::Impl::renderGlyphBitmap(char32_t ch, ofRectangle& bound
 // ============================================================
 
 bool ofTrueTypeFont::Impl::cacheGlyph(char32_t ch) {
-    if (glyphCache.find(ch) != glyphCache.end()) {
+    if (bitmaps.glyphs.find(ch) != bitmaps.glyphs.end()) {
         return true;  // Already cached
     }
 
@@ -243,69 +464,256 @@ bool ofTrueTypeFont::Impl::cacheGlyph(char32_t ch) {
         info.bounds = bounds;
         info.advance = advance;
         info.cached = true;
-        glyphCache[ch] = info;
+        bitmaps.glyphs[ch] = info;
         return true;
     }
 
     int glyphWidth = glyphPixels.getWidth();
     int glyphHeight = glyphPixels.getHeight();
 
-    // Check if we need a new row
-    if (atlasCursorX + glyphWidth > atlasWidth) {
-        atlasCursorX = 0;
-        atlasCursorY += atlasRowHeight + 1;  // +1 for spacing
-        atlasRowHeight = 0;
+    // Expand coverage to white RGBA so the vertex color tints the glyph
+    ofPixels rgba;
+    rgba.allocate(glyphWidth, glyphHeight, 4);
+    const unsigned char* coverage = glyphPixels.getData();
+    unsigned char* dst = rgba.getData();
+    for (int i = 0; i < glyphWidth * glyphHeight; ++i) {
+        dst[i * 4 + 0] = 255;
+        dst[i * 4 + 1] = 255;
+        dst[i * 4 + 2] = 255;
+        dst[i * 4 + 3] = coverage[i];
     }
 
-    // Check if atlas is full
-    if (atlasCursorY + glyphHeight > atlasHeight) {
+    GlyphInfo info;
+    if (!bitmaps.insert(rgba, info)) {
         oflike::ofLogWarning("ofTrueTypeFont") << "Atlas texture full, cannot cache more glyphs";
         return false;
     }
-
-    // Upload glyph to atlas texture
-    // Note: This uses loadData which replaces the entire texture
-    // A proper implementation would use texture sub-region updates
-    // For Phase 12.1, we upload the glyph pixels as a full texture
-    // This will be optimized in Phase 12.2 with proper atlas packing
-    GlyphInfo info;
-    info.texCoords = ofRectangle(
-        (float)atlasCursorX / atlasWidth,
-        (float)atlasCursorY / atlasHeight,
-        (float)glyphWidth / atlasWidth,
-        (float)glyphHeight / atlasHeight
-    );
     info.bounds = bounds;
+    info.quad = ofRectangle(bounds.x - kGlyphPadding, bounds.y - kGlyphPadding,
+                            (float)glyphWidth, (float)glyphHeight);
     info.advance = advance;
     info.cached = true;
 
-    glyphCache[ch] = info;
+    bitmaps.glyphs[ch] = info;
+
+    return true;
+}
+
+// ============================================================
+// Glyph Atlas
+// ============================================================
+
+bool GlyphAtlas::insert(const ofPixels& pixels, GlyphInfo& info) {
+    oflike::ofTextureAtlasRegion region;
+    if (!atlas.insert(pixels, region)) {
+        const bool fitsPage = (int)pixels.getWidth() <= pageSize && (int)pixels.getHeight() <= pageSize;
+        if (!fitsPage || !evictPage() || !atlas.insert(pixels, region)) {
+            return false;
+        }
+    }
+    touchPage(region.page);
+
+    info.texCoords = ofRectangle(
+        region.u0,
+        region.v0,
+        region.u1 - region.u0,
+        region.v1 - region.v0
+    );
+    info.page = region.page;
+    return true;
+}
 
-    // Update cursor
-    atlasCursorX += glyphWidth + 1;  // +1 for spacing
-    atlasRowHeight = std::max(atlasRowHeight, glyphHeight);
+void GlyphAtlas::touchPage(int page) {
+    if (page < 0) {
+        return;
+    }
+    if (page >= static_cast<int>(pageLastUsed.size())) {
+        pageLastUsed.resize(page + 1, 0);
+    }
+    pageLastUsed[page] = ofGetFrameNum();
+}
 
+bool GlyphAtlas::evictPage() {
+    const unsigned long long frame = ofGetFrameNum();
+    int oldest = -1;
+    for (int page = 0; page < static_cast<int>(pageLastUsed.size()); ++page) {
+        if (frame - pageLastUsed[page] > render::kRetireFrames &&
+            (oldest < 0 || pageLastUsed[page] < pageLastUsed[oldest])) {
+            oldest = page;
+        }
+    }
+    if (oldest < 0) {
+        return false;
+    }
+
+    for (auto it = glyphs.begin(); it != glyphs.end();) {
+        it = it->second.page == oldest ? glyphs.erase(it) : std::next(it);
+    }
+    atlas.clearPage(oldest);
+    generation++;
+    oflike::ofLogVerbose("ofTrueTypeFont") << "Evicted atlas page " << oldest;
     return true;
 }
 
+// ============================================================
+// Distance Field Face
+// ============================================================
+
+std::shared_ptr<DistanceFieldFace> DistanceFieldFace::acquire(CTFontRef font) {
+    @autoreleasepool {
+        // By PostScript name: fonts of one face at any size share it
+        static std::unordered_map<std::string, std::weak_ptr<DistanceFieldFace>> faces;
+        NSString* name = (__bridge_transfer NSString*)CTFontCopyPostScriptName(font);
+        const std::string key = name ? std::string(name.UTF8String) : std::string();
+
+        auto& weak = faces[key];
+        if (std::shared_ptr<DistanceFieldFace> face = weak.lock()) {
+            return face;
+        }
+        auto face = std::make_shared<DistanceFieldFace>();
+        face->font = CTFontCreateCopyWithAttributes(font, kDistanceFieldSize, nullptr, nullptr);
+        face->glyphs.setup(kDistanceFieldPageSize);
+        weak = face;
+        return face;
+    }
+}
+
+const GlyphInfo* DistanceFieldFace::getGlyph(char32_t ch) {
+    auto it = glyphs.glyphs.find(ch);
+    if (it != glyphs.glyphs.end()) {
+        return &it->second;
+    }
+    if (!font) {
+        return nullptr;
+    }
+
+    CGGlyph glyph;
+    UniChar unichar = (UniChar)ch;
+    if (!CTFontGetGlyphsForCharacters(font, &unichar, &glyph, 1)) {
+        return nullptr;
+    }
+
+    CGSize glyphAdvance;
+    CTFontGetAdvancesForGlyphs(font, kCTFontOrientationHorizontal, &glyph, &glyphAdvance, 1);
+    CGRect glyphBounds;
+    CTFontGetBoundingRectsForGlyphs(font, kCTFontOrientationHorizontal, &glyph, &glyphBounds, 1);
+
+    GlyphInfo info;
+    info.bounds = ofRectangle(glyphBounds.origin.x, glyphBounds.origin.y,
+                              glyphBounds.size.width, glyphBounds.size.height);
+    info.advance = glyphAdvance.width;
+    info.cached = true;
+
+    // Spaces and other empty glyphs have no field
+    const std::vector<OutlineSegment> segments = flattenGlyphOutline(font, glyph);
+    if (!segments.empty() && glyphBounds.size.width > 0 && glyphBounds.size.height > 0) {
+        ofPixels field = rasterizeDistanceField(segments, glyphBounds, info.quad);
+        if (!glyphs.insert(field, info)) {
+            oflike::ofLogWarning("ofTrueTypeFont") << "Distance field atlas full, cannot cache more glyphs";
+            return nullptr;
+        }
+    }
+
+    return &(glyphs.glyphs[ch] = info);
+}
+
 // ============================================================
 // Get Glyph Info
 // ============================================================
 
 const GlyphInfo* ofTrueTypeFont::Impl::getGlyphInfo(char32_t ch) {
-    auto it = glyphCache.find(ch);
-    if (it != glyphCache.end()) {
+    auto it = bitmaps.glyphs.find(ch);
+    if (it != bitmaps.glyphs.end()) {
         return &it->second;
     }
 
     // Cache on demand
     if (cacheGlyph(ch)) {
-        return &glyphCache[ch];
+        return &bitmaps.glyphs[ch];
     }
 
     return nullptr;
 }
 
+GlyphAtlas& ofTrueTypeFont::Impl::currentGlyphs() {
+    if (renderMode != RenderMode::DistanceField || !ctFont) {
+        return bitmaps;
+    }
+    if (!distanceField) {
+        distanceField = DistanceFieldFace::acquire(ctFont);
+    }
+    return distanceField->glyphs;
+}
+
+const GlyphInfo* ofTrueTypeFont::Impl::getGlyph(char32_t ch) {
+    if (renderMode == RenderMode::DistanceField && ctFont) {
+        currentGlyphs();
+        return distanceField->getGlyph(ch);
+    }
+    return getGlyphInfo(ch);
+}
+
+float ofTrueTypeFont::Impl::glyphScale() const {
+    return renderMode == RenderMode::DistanceField ? fontSize / kDistanceFieldSize : 1.0f;
+}
+
+// ============================================================
+// Text Layout
+// ============================================================
+
+const TextLayout& ofTrueTypeFont::Impl::getLayout(const std::string& text) {
+    GlyphAtlas& glyphs = currentGlyphs();
+    auto it = layouts.find(text);
+    if (it != layouts.end() && it->second.generation == glyphs.generation) {
+        return it->second;
+    }
+    if (it == layouts.end()) {
+        if (layouts.size() >= kMaxCachedLayouts) {
+            layouts.clear();
+        }
+        it = layouts.emplace(text, TextLayout()).first;
+    }
+
+    TextLayout& layout = it->second;
+    layout.quads.clear();
+    layout.numPages = 0;
+    layout.width = 0.0f;
+
+    const std::u32string utf32 = utf8ToUtf32(text);
+    const float scale = glyphScale();
+    float cursorX = 0.0f;
+    for (size_t i = 0; i < utf32.size(); ++i) {
+        const GlyphInfo* info = getGlyph(utf32[i]);
+        if (!info) continue;
+
+        // Skip whitespace (no visual glyph)
+        if (info->page >= 0 && info->bounds.width > 0 && info->bounds.height > 0) {
+            // Drawn pages aren't evicted while the rest of the string is cached
+            glyphs.touchPage(info->page);
+
+            // Glyph space is y up from the baseline, the screen y down
+            TextLayout::Quad quad;
+            quad.min = simd_make_float2(cursorX + info->quad.x * scale,
+                                        -(info->quad.y + info->quad.height) * scale);
+            quad.max = quad.min + simd_make_float2(info->quad.width, info->quad.height) * scale;
+            quad.uv0 = simd_make_float2(info->texCoords.x, info->texCoords.y);
+            quad.uv1 = quad.uv0 + simd_make_float2(info->texCoords.width, info->texCoords.height);
+            quad.page = info->page;
+            quad.character = static_cast<uint32_t>(i);
+            layout.quads.push_back(quad);
+            layout.numPages = std::max(layout.numPages, info->page + 1);
+        }
+
+        cursorX += info->advance * scale;
+        layout.width = cursorX;
+        cursorX += letterSpacing;
+    }
+
+    // Evictions while laying out only emptied pages this string doesn't use
+    layout.generation = glyphs.generation;
+    return layout;
+}
+
 // ============================================================
 // Get Glyph Path (Vector)
 // ============================================================
@@ -403,6 +811,11 @@ bool ofTrueTypeFont::isLoaded() const {
 }
 
 void ofTrueTypeFont::drawString(const std::string& text, float x, float y) const {
+    drawString(text, x, y, {});
+}
+
+void ofTrueTypeFont::drawString(const std::string& text, float x, float y,
+                                const std::vector<oflike::ofColor>& glyphColors) const {
     if (!impl_->loaded) {
         oflike::ofLogWarning("ofTrueTypeFont") << "Font not loaded";
         return;
@@ -412,116 +825,111 @@ void ofTrueTypeFont::drawString(const std::string& text, float x, float y) const
         return;
     }
 
-    // Convert to UTF-32
-    std::u32string utf32 = utf8ToUtf32(text);
-    if (utf32.empty()) {
+    // Phase 12.2: Batch drawing optimization
+    // Collect the glyph quads of each atlas page and submit a draw call per page
+    const TextLayout& layout = impl_->getLayout(text);
+    if (layout.quads.empty()) {
         return;
     }
 
-    float cursorX = x;
-    float cursorY = y;
-
-    // Phase 12.2: Batch drawing optimization
-    // Collect all glyph quads and submit as a single draw call
-
-    if (!impl_->atlasTexture) {
-        oflike::ofLogWarning("ofTrueTypeFont") << "Atlas texture not initialized";
-        return;
+    // Bitmaps at this size, or distance fields scaled from the face's size
+    GlyphAtlas& glyphs = impl_->currentGlyphs();
+    for (const TextLayout::Quad& quad : layout.quads) {
+        glyphs.touchPage(quad.page);
     }
 
     // Get draw list from context
     auto& drawList = Context::instance().getDrawList();
 
-    // Collect vertices for all glyphs
-    std::vector<render::Vertex2D> vertices;
-    vertices.reserve(utf32.size() * 6);  // 6 vertices per glyph (2 triangles)
-
     // Get current color from graphics state
     uint8_t r, g, b, a;
     ofGetColor(r, g, b, a);
     simd_float4 color = simd_make_float4(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f);
 
-    for (char32_t ch : utf32) {
-        const GlyphInfo* info = impl_->getGlyphInfo(ch);
-        if (!info) continue;
+    // Under a 2D transform the vertices are written in world space, so
+    // strings drawn under different transforms still batch into one draw
+    const simd_float4x4& matrix = ofGetCurrentModelMatrix();
+    const bool affine2D = matrix.columns[0].z == 0.0f && matrix.columns[0].w == 0.0f &&
+                          matrix.columns[1].z == 0.0f && matrix.columns[1].w == 0.0f &&
+                          matrix.columns[3].z == 0.0f && matrix.columns[3].w == 1.0f;
+    simd_float2 axisX = simd_make_float2(1.0f, 0.0f);
+    simd_float2 axisY = simd_make_float2(0.0f, 1.0f);
+    simd_float2 origin = simd_make_float2(x, y);
+    if (affine2D) {
+        axisX = simd_make_float2(matrix.columns[0].x, matrix.columns[0].y);
+        axisY = simd_make_float2(matrix.columns[1].x, matrix.columns[1].y);
+        origin = axisX * x + axisY * y + simd_make_float2(matrix.columns[3].x, matrix.columns[3].y);
+    }
 
-        // Skip whitespace (no visual glyph)
-        if (info->bounds.width > 0 && info->bounds.height > 0) {
-            // Calculate glyph quad position
-            float glyphX = cursorX + info->bounds.x;
-            float glyphY = cursorY + info->bounds.y;
-            float glyphW = info->bounds.width;
-            float glyphH = info->bounds.height;
-
-            // UV coordinates from atlas
-            float u0 = info->texCoords.x;
-            float v0 = info->texCoords.y;
-            float u1 = u0 + info->texCoords.width;
-            float v1 = v0 + info->texCoords.height;
-
-            // Create 6 vertices for 2 triangles (quad)
-            // Triangle 1: top-left, top-right, bottom-right
-            vertices.push_back(render::Vertex2D(
-                simd_make_float2(glyphX, glyphY),
-                simd_make_float2(u0, v0),
-                color
-            ));
-            vertices.push_back(render::Vertex2D(
-                simd_make_float2(glyphX + glyphW, glyphY),
-                simd_make_float2(u1, v0),
-                color
-            ));
-            vertices.push_back(render::Vertex2D(
-                simd_make_float2(glyphX + glyphW, glyphY + glyphH),
-                simd_make_float2(u1, v1),
-                color
-            ));
-
-            // Triangle 2: top-left, bottom-right, bottom-left
-            vertices.push_back(render::Vertex2D(
-                simd_make_float2(glyphX, glyphY),
-                simd_make_float2(u0, v0),
-                color
-            ));
-            vertices.push_back(render::Vertex2D(
-                simd_make_float2(glyphX + glyphW, glyphY + glyphH),
-                simd_make_float2(u1, v1),
-                color
-            ));
-            vertices.push_back(render::Vertex2D(
-                simd_make_float2(glyphX, glyphY + glyphH),
-                simd_make_float2(u0, v1),
-                color
-            ));
+    // Collect vertices for all glyphs, by page
+    std::vector<std::vector<render::Vertex2D>>& pageVertices = impl_->pageVertices;
+    if (pageVertices.size() < static_cast<size_t>(layout.numPages)) {
+        pageVertices.resize(layout.numPages);
+    }
+    for (auto& vertices : pageVertices) {
+        vertices.clear();
+    }
+
+    for (const TextLayout::Quad& quad : layout.quads) {
+        std::vector<render::Vertex2D>& vertices = pageVertices[quad.page];
+
+        simd_float4 glyphColor = color;
+        if (quad.character < glyphColors.size()) {
+            const oflike::ofColor& c = glyphColors[quad.character];
+            glyphColor = simd_make_float4(c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f);
         }
 
-        // Advance cursor
-        cursorX += info->advance + impl_->letterSpacing;
+        // Quad corners
+        const simd_float2 topLeft = origin + axisX * quad.min.x + axisY * quad.min.y;
+        const simd_float2 topRight = origin + axisX * quad.max.x + axisY * quad.min.y;
+        const simd_float2 bottomRight = origin + axisX * quad.max.x + axisY * quad.max.y;
+        const simd_float2 bottomLeft = origin + axisX * quad.min.x + axisY * quad.max.y;
+
+        // Create 6 vertices for 2 triangles (quad)
+        // Triangle 1: top-left, top-right, bottom-right
+        vertices.push_back(render::Vertex2D(topLeft, quad.uv0, glyphColor));
+        vertices.push_back(render::Vertex2D(topRight, simd_make_float2(quad.uv1.x, quad.uv0.y), glyphColor));
+        vertices.push_back(render::Vertex2D(bottomRight, quad.uv1, glyphColor));
+
+        // Triangle 2: top-left, bottom-right, bottom-left
+        vertices.push_back(render::Vertex2D(topLeft, quad.uv0, glyphColor));
+        vertices.push_back(render::Vertex2D(bottomRight, quad.uv1, glyphColor));
+        vertices.push_back(render::Vertex2D(bottomLeft, simd_make_float2(quad.uv0.x, quad.uv1.y), glyphColor));
     }
 
-    // If we have vertices, submit as a single batched draw call
-    if (!vertices.empty()) {
+    // Upload the glyphs this string added, one region per page
+    glyphs.atlas.flush();
+
+    // Submit a batched draw call per page
+    for (int page = 0; page < layout.numPages; ++page) {
+        const std::vector<render::Vertex2D>& vertices = pageVertices[page];
+        if (vertices.empty()) {
+            continue;
+        }
+        const ofTexture& atlasTexture = glyphs.atlas.getPageTexture(page);
+
         // Add all vertices to draw list
         uint32_t vtxOffset = drawList.addVertices2D(vertices);
 
-        // Create draw command for the entire string
+        // Create draw command for the page's glyphs; consecutive strings on
+        // the same page merge into one draw in DrawList::optimize()
         render::DrawCommand2D cmd;
         cmd.vertexOffset = vtxOffset;
         cmd.vertexCount = static_cast<uint32_t>(vertices.size());
         cmd.primitiveType = render::PrimitiveType::Triangle;
         cmd.blendMode = render::BlendMode::Alpha;
-        cmd.texture = impl_->atlasTexture->getNativeHandle();
+        cmd.texture = atlasTexture.getNativeHandle();
+        cmd.samplerKey = atlasTexture.getSamplerKey();
+        cmd.distanceField = impl_->renderMode == RenderMode::DistanceField;
 
-        // Get current transform matrix from graphics state
-        oflike::ofMatrix4x4 mat = ofGetCurrentMatrix();
-        cmd.transform = mat.toSimd();
+        // Already applied to the vertices unless it isn't a 2D transform
+        cmd.transform = affine2D ? matrix_identity_float4x4 : matrix;
 
         // Add command to draw list
         drawList.addCommand(cmd);
 
-        oflike::ofLogVerbose("ofTrueTypeFont") << "Batched " << utf32.size()
-                                       << " glyphs into " << vertices.size()
-                                       << " vertices (single draw call)";
+        oflike::ofLogVerbose("ofTrueTypeFont") << "Batched " << vertices.size() / 6
+                                       << " glyphs of page " << page << " into one draw call";
     }
 }
 
@@ -597,22 +1005,24 @@ ofRectangle ofTrueTypeFont::getStringBoundingBox(const std::string& text, float
     float maxX = x;
     float maxY = y;
     float cursorX = x;
+    const float scale = impl_->glyphScale();
 
     for (char32_t ch : utf32) {
-        const GlyphInfo* info = impl_->getGlyphInfo(ch);
+        const GlyphInfo* info = impl_->getGlyph(ch);
         if (!info) continue;
 
-        float glyphMinX = cursorX + info->bounds.x;
-        float glyphMinY = y + info->bounds.y;
-        float glyphMaxX = glyphMinX + info->bounds.width;
-        float glyphMaxY = glyphMinY + info->bounds.height;
+        // Glyph bounds are y up from the baseline
+        float glyphMinX = cursorX + info->bounds.x * scale;
+        float glyphMinY = y - (info->bounds.y + info->bounds.height) * scale;
+        float glyphMaxX = glyphMinX + info->bounds.width * scale;
+        float glyphMaxY = glyphMinY + info->bounds.height * scale;
 
         minX = std::min(minX, glyphMinX);
         minY = std::min(minY, glyphMinY);
         maxX = std::max(maxX, glyphMaxX);
         maxY = std::max(maxY, glyphMaxY);
 
-        cursorX += info->advance + impl_->letterSpacing;
+        cursorX += info->advance * scale + impl_->letterSpacing;
     }
 
     return ofRectangle(minX, minY, maxX - minX, maxY - minY);
@@ -623,20 +1033,7 @@ float ofTrueTypeFont::stringWidth(const std::string& text) const {
         return 0.0f;
     }
 
-    std::u32string utf32 = utf8ToUtf32(text);
-    float width = 0.0f;
-
-    for (size_t i = 0; i < utf32.size(); ++i) {
-        const GlyphInfo* info = impl_->getGlyphInfo(utf32[i]);
-        if (!info) continue;
-
-        width += info->advance;
-        if (i < utf32.size() - 1) {
-            width += impl_->letterSpacing;
-        }
-    }
-
-    return width;
+    return impl_->getLayout(text).width;
 }
 
 float ofTrueTypeFont::stringHeight(const std::string& text) const {
@@ -664,6 +1061,9 @@ float ofTrueTypeFont::getLetterSpacing() const {
 }
 
 void ofTrueTypeFont::setLetterSpacing(float spacing) {
+    if (spacing != impl_->letterSpacing) {
+        impl_->layouts.clear();
+    }
     impl_->letterSpacing = spacing;
 }
 
@@ -691,6 +1091,9 @@ std::vector<oflike::ofPath> ofTrueTypeFont::getCharacterAsPoints(const std::stri
 }
 
 void ofTrueTypeFont::setRenderMode(RenderMode mode) {
+    if (mode != impl_->renderMode) {
+        impl_->layouts.clear();
+    }
     impl_->renderMode = mode;
 }
 
@@ -699,12 +1102,11 @@ ofTrueTypeFont::RenderMode ofTrueTypeFont::getRenderMode() const {
 }
 
 void* ofTrueTypeFont::getAtlasTexture() const {
-    if (impl_->atlasTexture) {
-        return impl_->atlasTexture->getNativeHandle();
-    }
-    return nullptr;
+    GlyphAtlas& glyphs = impl_->currentGlyphs();
+    glyphs.atlas.flush();
+    return glyphs.atlas.getPageTexture(0).getNativeHandle();
 }
 
 int ofTrueTypeFont::getNumGlyphsCached() const {
-    return (int)impl_->glyphCache.size();
+    return (int)impl_->currentGlyphs().glyphs.size();
 }
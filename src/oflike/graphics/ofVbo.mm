@@ -5,6 +5,7 @@
 #import "../../render/DrawList.h"
 #import "../../render/DrawCommand.h"
 #import "../../render/RenderTypes.h"
+#import "../../render/metal/MetalAllocations.h"
 #import <Metal/Metal.h>
 #import <simd/simd.h>
 #include <cstring>
@@ -59,10 +60,8 @@ struct ofVbo::Impl {
             // usage == 1 or GL_DYNAMIC_DRAW → shared memory with write combine
             MTLResourceOptions options = MTLResourceStorageModeShared;
 
-            id<MTLBuffer> buffer = [device newBufferWithBytes:data
-                                                       length:size
-                                                      options:options];
-            return buffer;
+            return render::metal::makeTrackedBuffer(device, data, size, options,
+                                                    ofGpuMemoryCategory::Meshes, "ofVbo");
         }
     }
 
@@ -412,6 +411,8 @@ void ofVbo::draw(int drawMode, int first, int total) const {
     cmd.projectionMatrix = ctx.getProjectionMatrix();
     cmd.depthTestEnabled = true;  // Default to enabled
     cmd.depthWriteEnabled = true; // Default to enabled
+    cmd.orderIndependent = ofGetOrderIndependentTransparencyEnabled();
+    cmd.objectId = ofGetObjectId();
 
     drawList.addCommand(cmd);
 }
@@ -494,6 +495,8 @@ void ofVbo::drawElements(int drawMode, int first, int total) const {
     cmd.projectionMatrix = ctx.getProjectionMatrix();
     cmd.depthTestEnabled = true;  // Default to enabled
     cmd.depthWriteEnabled = true; // Default to enabled
+    cmd.orderIndependent = ofGetOrderIndependentTransparencyEnabled();
+    cmd.objectId = ofGetObjectId();
 
     drawList.addCommand(cmd);
 }
@@ -0,0 +1,44 @@
+#pragma once
+
+// oflike-metal ImageDecoder - ImageIO decoding shared by the ofImage loaders
+// Decodes on any thread, runs background decodes through a bounded queue and
+// keeps recently decoded files in an LRU cache keyed by path and mtime, so
+// the same asset is never decoded twice while it is unchanged on disk
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include "ofPixels.h"
+
+namespace oflike {
+
+/// \brief Decode an image file to 8-bit pixels
+/// \details Thread-safe. Monochrome images decode to 1 channel, opaque color
+/// images to RGB and images with alpha to (premultiplied) RGBA, each drawn
+/// straight into its final layout. The result is shared with the decode
+/// cache: a file whose path, modification time and size match a cached
+/// entry isn't decoded again, and concurrent requests for the same file
+/// wait for a single decode.
+/// \param path Image file path
+/// \return Decoded pixels, or nullptr if the file can't be read or decoded
+///         (the reason is logged)
+std::shared_ptr<const ofPixels> decodeImageFile(const std::string& path);
+
+/// \brief Decode an image file on a worker thread
+/// \details Requests wait in a queue and at most one decode per CPU core runs
+/// at once, which bounds the memory held by decoded images in flight.
+/// \param path Image file path
+/// \param done Called on the worker thread with the result of decodeImageFile()
+void decodeImageFileAsync(const std::string& path,
+                          std::function<void(std::shared_ptr<const ofPixels>)> done);
+
+/// \brief Set the memory budget of the decode cache
+/// \details Least recently used entries are evicted beyond it; 0 disables
+/// caching. Defaults to 256 MB.
+void setImageDecodeCacheSize(size_t bytes);
+
+/// \brief Drop all cached decodes
+void clearImageDecodeCache();
+
+} // namespace oflike
@@ -0,0 +1,305 @@
+// ImageDecoder.mm - ImageIO decoding with a bounded queue and an LRU cache
+
+#import <Foundation/Foundation.h>
+#import <ImageIO/ImageIO.h>
+#import <Accelerate/Accelerate.h>
+
+#include "ImageDecoder.h"
+#include "../utils/ofLog.h"
+#include <dispatch/dispatch.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <future>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace oflike {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+static constexpr size_t kDefaultCacheBytes = 256 * 1024 * 1024;
+
+// ============================================================================
+// Decoding
+// ============================================================================
+
+namespace {
+
+using DecodedPixels = std::shared_ptr<const ofPixels>;
+
+/// Draw a CGImage into 8-bit pixels of its natural channel count
+bool DrawImage(CGImageRef cgImage, ofPixels& pixels) {
+    const size_t width = CGImageGetWidth(cgImage);
+    const size_t height = CGImageGetHeight(cgImage);
+
+    // Determine channel count from color space
+    size_t channels = 4;
+    if (CGColorSpaceGetModel(CGImageGetColorSpace(cgImage)) == kCGColorSpaceModelMonochrome) {
+        channels = 1;
+    } else {
+        CGImageAlphaInfo alphaInfo = CGImageGetAlphaInfo(cgImage);
+        if (alphaInfo == kCGImageAlphaNone || alphaInfo == kCGImageAlphaNoneSkipLast ||
+            alphaInfo == kCGImageAlphaNoneSkipFirst) {
+            channels = 3;
+        }
+    }
+
+    // Core Graphics has no 24-bit RGB contexts: opaque color is drawn as
+    // RGBX and packed afterwards
+    ofPixels rgbx;
+    ofPixels& target = channels == 3 ? rgbx : pixels;
+    const size_t drawChannels = channels == 3 ? 4 : channels;
+    target.allocate(width, height, drawChannels);
+
+    CGColorSpaceRef drawColorSpace = (channels == 1)
+        ? CGColorSpaceCreateDeviceGray()
+        : CGColorSpaceCreateDeviceRGB();
+
+    CGBitmapInfo bitmapInfo = kCGBitmapByteOrderDefault;
+    if (channels == 4) {
+        bitmapInfo |= kCGImageAlphaPremultipliedLast;
+    } else if (channels == 3) {
+        bitmapInfo |= kCGImageAlphaNoneSkipLast;
+    }
+
+    CGContextRef context = CGBitmapContextCreate(target.getData(), width, height, 8,
+                                                 target.getBytesStride(), drawColorSpace,
+                                                 bitmapInfo);
+    CGColorSpaceRelease(drawColorSpace);
+    if (!context) {
+        pixels.clear();
+        return false;
+    }
+
+    // Draw image into bitmap context (flips Y to top-left origin)
+    CGContextDrawImage(context, CGRectMake(0, 0, width, height), cgImage);
+    CGContextRelease(context);
+
+    if (channels == 3) {
+        pixels.allocate(width, height, 3);
+        vImage_Buffer src = {rgbx.getData(), static_cast<vImagePixelCount>(height),
+                             static_cast<vImagePixelCount>(width), rgbx.getBytesStride()};
+        vImage_Buffer dst = {pixels.getData(), static_cast<vImagePixelCount>(height),
+                             static_cast<vImagePixelCount>(width), pixels.getBytesStride()};
+        if (vImageConvert_RGBA8888toRGB888(&src, &dst, kvImageNoFlags) != kvImageNoError) {
+            pixels.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Decode a file, bypassing the cache
+DecodedPixels DecodeFile(const std::string& path) {
+    @autoreleasepool {
+        NSString* nsPath = [NSString stringWithUTF8String:path.c_str()];
+        NSURL* url = [NSURL fileURLWithPath:nsPath];
+
+        // Don't let ImageIO keep its own decoded copy; ours is cached
+        NSDictionary* options = @{(__bridge id)kCGImageSourceShouldCache: @NO};
+        CGImageSourceRef imageSource = CGImageSourceCreateWithURL((__bridge CFURLRef)url,
+                                                                  (__bridge CFDictionaryRef)options);
+        if (!imageSource) {
+            ofLogError("ofImage") << "Failed to create image source: " << path;
+            return nullptr;
+        }
+
+        CGImageRef cgImage = CGImageSourceCreateImageAtIndex(imageSource, 0,
+                                                             (__bridge CFDictionaryRef)options);
+        CFRelease(imageSource);
+        if (!cgImage) {
+            ofLogError("ofImage") << "Failed to decode image: " << path;
+            return nullptr;
+        }
+
+        auto pixels = std::make_shared<ofPixels>();
+        const bool drawn = DrawImage(cgImage, *pixels);
+        CGImageRelease(cgImage);
+        if (!drawn) {
+            ofLogError("ofImage") << "Failed to create bitmap context: " << path;
+            return nullptr;
+        }
+        return pixels;
+    }
+}
+
+// ============================================================================
+// Decode Cache
+// ============================================================================
+
+/// File identity on disk; a changed file gets a new stamp
+struct FileStamp {
+    long long mtimeSec = 0;
+    long long mtimeNsec = 0;
+    long long size = 0;
+
+    bool operator==(const FileStamp& other) const {
+        return mtimeSec == other.mtimeSec && mtimeNsec == other.mtimeNsec && size == other.size;
+    }
+};
+
+struct CacheEntry {
+    std::string path;
+    FileStamp stamp;
+    DecodedPixels pixels;
+    size_t bytes = 0;
+};
+
+struct InFlight {
+    FileStamp stamp;
+    std::shared_future<DecodedPixels> result;
+};
+
+struct DecodeCache {
+    std::mutex mutex;
+    std::list<CacheEntry> entries;  // Most recently used first
+    std::unordered_map<std::string, std::list<CacheEntry>::iterator> index;
+    std::unordered_map<std::string, InFlight> inFlight;
+    size_t bytes = 0;
+    size_t capacity = kDefaultCacheBytes;
+
+    // Callers hold the mutex
+    void erase(std::list<CacheEntry>::iterator it) {
+        bytes -= it->bytes;
+        index.erase(it->path);
+        entries.erase(it);
+    }
+
+    void trim() {
+        while (bytes > capacity && !entries.empty()) {
+            erase(std::prev(entries.end()));
+        }
+    }
+};
+
+DecodeCache& GetCache() {
+    static DecodeCache cache;
+    return cache;
+}
+
+bool GetFileStamp(const std::string& path, FileStamp& stamp) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+        return false;
+    }
+    stamp.mtimeSec = info.st_mtimespec.tv_sec;
+    stamp.mtimeNsec = info.st_mtimespec.tv_nsec;
+    stamp.size = info.st_size;
+    return true;
+}
+
+// ============================================================================
+// Decode Queue
+// ============================================================================
+
+struct DecodeQueue {
+    dispatch_queue_t feeder;       // Serial: admits requests in order
+    dispatch_semaphore_t slots;    // Decodes allowed to run at once
+
+    DecodeQueue() {
+        feeder = dispatch_queue_create("oflike.imageDecode", DISPATCH_QUEUE_SERIAL);
+        slots = dispatch_semaphore_create(
+            static_cast<long>(std::max<NSUInteger>(1, [[NSProcessInfo processInfo] activeProcessorCount])));
+    }
+};
+
+DecodeQueue& GetQueue() {
+    static DecodeQueue queue;
+    return queue;
+}
+
+} // namespace
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+std::shared_ptr<const ofPixels> decodeImageFile(const std::string& path) {
+    FileStamp stamp;
+    if (!GetFileStamp(path, stamp)) {
+        ofLogError("ofImage") << "File not found: " << path;
+        return nullptr;
+    }
+
+    DecodeCache& cache = GetCache();
+    std::promise<DecodedPixels> promise;
+    {
+        std::unique_lock<std::mutex> lock(cache.mutex);
+        auto cached = cache.index.find(path);
+        if (cached != cache.index.end()) {
+            if (cached->second->stamp == stamp) {
+                cache.entries.splice(cache.entries.begin(), cache.entries, cached->second);
+                return cache.entries.front().pixels;
+            }
+            cache.erase(cached->second);  // Changed on disk
+        }
+
+        auto pending = cache.inFlight.find(path);
+        if (pending != cache.inFlight.end() && pending->second.stamp == stamp) {
+            std::shared_future<DecodedPixels> result = pending->second.result;
+            lock.unlock();
+            return result.get();
+        }
+        cache.inFlight[path] = InFlight{stamp, promise.get_future().share()};
+    }
+
+    DecodedPixels pixels = DecodeFile(path);
+
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto pending = cache.inFlight.find(path);
+        if (pending != cache.inFlight.end() && pending->second.stamp == stamp) {
+            cache.inFlight.erase(pending);
+        }
+
+        const size_t bytes = pixels ? pixels->getTotalBytes() : 0;
+        if (pixels && bytes <= cache.capacity && cache.index.find(path) == cache.index.end()) {
+            cache.entries.push_front(CacheEntry{path, stamp, pixels, bytes});
+            cache.index[path] = cache.entries.begin();
+            cache.bytes += bytes;
+            cache.trim();
+        }
+    }
+
+    promise.set_value(pixels);
+    return pixels;
+}
+
+void decodeImageFileAsync(const std::string& path,
+                          std::function<void(std::shared_ptr<const ofPixels>)> done) {
+    DecodeQueue& queue = GetQueue();
+    dispatch_semaphore_t slots = queue.slots;
+
+    // The feeder waits for a free slot before starting each decode, so
+    // queued requests hold no decoded memory
+    dispatch_async(queue.feeder, ^{
+        dispatch_semaphore_wait(slots, DISPATCH_TIME_FOREVER);
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            std::shared_ptr<const ofPixels> pixels = decodeImageFile(path);
+            dispatch_semaphore_signal(slots);
+            if (done) {
+                done(std::move(pixels));
+            }
+        });
+    });
+}
+
+void setImageDecodeCacheSize(size_t bytes) {
+    DecodeCache& cache = GetCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.capacity = bytes;
+    cache.trim();
+}
+
+void clearImageDecodeCache() {
+    DecodeCache& cache = GetCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.entries.clear();
+    cache.index.clear();
+    cache.bytes = 0;
+}
+
+} // namespace oflike
@@ -0,0 +1,34 @@
+#pragma once
+
+// oflike-metal TextureReadback - asynchronous GPU to CPU texture copies
+// Shared by ofTexture and ofFbo: a readback is recorded into the current
+// DrawList like a draw, blitted into a pooled shared staging buffer when the
+// frame renders and handed over as ofPixels when the GPU has finished
+
+#include <future>
+#include "ofPixels.h"
+
+namespace oflike {
+
+/// \brief Queue an asynchronous readback of a texture
+/// \details The copy happens after everything recorded so far this frame
+/// has rendered, so it sees this frame's drawing (synchronous readToPixels()
+/// calls only see what earlier frames drew). The CPU never waits for the
+/// GPU; the future becomes ready from a Metal completion thread one or two
+/// frames later. Staging buffers are recycled between readbacks.
+///
+/// Readable formats are R8, RG8, RGBA8 and BGRA8 (delivered as RGBA).
+/// A readback whose frame is never rendered (for example one recorded into
+/// a display list that is never drawn) resolves to unallocated pixels when
+/// a readback recorded 240 frames later finds it still pending.
+/// \param texture id<MTLTexture> handle (not multisampled)
+/// \param width Width of the region to read, from the top-left corner
+/// \param height Height of the region to read
+/// \param channels Channels of the delivered pixels; RGBA texels read as
+///        3 channels drop alpha
+/// \return Future resolving to the pixels, or to unallocated pixels if the
+///         copy failed; an invalid future (valid() is false) if the texture
+///         can't be read back or nothing can be recorded right now
+std::future<ofPixels> readTextureAsync(void* texture, int width, int height, size_t channels);
+
+} // namespace oflike
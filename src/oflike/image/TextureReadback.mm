@@ -0,0 +1,184 @@
+// TextureReadback.mm - asynchronous GPU to CPU texture copies
+
+#import <Metal/Metal.h>
+#include "TextureReadback.h"
+#include "../../core/Context.h"
+#include "../../render/DrawList.h"
+#include "../../render/DrawCommand.h"
+#include "../../render/CopyTextureRegistry.h"
+#include "../../render/metal/MetalAllocations.h"
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace oflike {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+// Idle staging buffers kept for reuse
+static constexpr size_t kMaxIdleBuffers = 8;
+
+// ============================================================================
+// Staging Pool
+// ============================================================================
+
+namespace {
+
+struct Readback {
+    id<MTLBuffer> buffer = nil;
+    std::promise<ofPixels> promise;
+    int width = 0;
+    int height = 0;
+    size_t texelSize = 0;          // Bytes per texel in the buffer
+    size_t channels = 0;           // Channels delivered
+    bool swapRedBlue = false;      // BGRA texels
+};
+
+// Idle staging buffers. Readbacks complete on Metal threads, so they are
+// behind the mutex.
+struct StagingPool {
+    std::mutex mutex;
+    std::vector<id<MTLBuffer>> idle;
+
+    static StagingPool& instance() {
+        static StagingPool pool;
+        return pool;
+    }
+
+    // Smallest idle buffer that fits, or a new one (call with the lock held)
+    id<MTLBuffer> acquire(id<MTLDevice> device, NSUInteger length) {
+        size_t best = idle.size();
+        for (size_t i = 0; i < idle.size(); i++) {
+            if (idle[i].length >= length && (best == idle.size() || idle[i].length < idle[best].length)) {
+                best = i;
+            }
+        }
+        if (best < idle.size()) {
+            id<MTLBuffer> buffer = idle[best];
+            idle.erase(idle.begin() + best);
+            return buffer;
+        }
+        return render::metal::makeTrackedBuffer(device, length, MTLResourceStorageModeShared,
+                                                ofGpuMemoryCategory::Staging, "Texture Readback Staging");
+    }
+
+    // Call with the lock held
+    void release(id<MTLBuffer> buffer) {
+        if (buffer && idle.size() < kMaxIdleBuffers) {
+            idle.push_back(buffer);
+        }
+    }
+};
+
+// Unpack on the Metal completion thread; unallocated pixels if the copy
+// failed or its frame was never rendered
+void completeReadback(const std::shared_ptr<Readback>& readback, bool succeeded) {
+    StagingPool& pool = StagingPool::instance();
+    ofPixels pixels;
+    if (succeeded) {
+        const size_t count = static_cast<size_t>(readback->width) * readback->height;
+        const uint8_t* src = static_cast<const uint8_t*>([readback->buffer contents]);
+        pixels.allocate(readback->width, readback->height, readback->channels);
+        uint8_t* dst = pixels.getData();
+
+        if (readback->texelSize == readback->channels && !readback->swapRedBlue) {
+            std::memcpy(dst, src, count * readback->channels);
+        } else {
+            // RGBA/BGRA texels to RGBA or RGB pixels
+            for (size_t i = 0; i < count; i++) {
+                const uint8_t* texel = src + i * readback->texelSize;
+                uint8_t* pixel = dst + i * readback->channels;
+                pixel[0] = readback->swapRedBlue ? texel[2] : texel[0];
+                pixel[1] = texel[1];
+                pixel[2] = readback->swapRedBlue ? texel[0] : texel[2];
+                if (readback->channels == 4) {
+                    pixel[3] = texel[3];
+                }
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.release(readback->buffer);
+    }
+    readback->promise.set_value(std::move(pixels));
+}
+
+using ReadbackRegistry = render::CopyTextureRegistry<std::shared_ptr<Readback>, &completeReadback>;
+
+} // namespace
+
+// ============================================================================
+// Readback
+// ============================================================================
+
+std::future<ofPixels> readTextureAsync(void* texture, int width, int height, size_t channels) {
+    auto& ctx = Context::instance();
+    if (!texture || width <= 0 || height <= 0 || !ctx.isInitialized()) {
+        return std::future<ofPixels>();
+    }
+
+    id<MTLTexture> mtlTexture = (__bridge id<MTLTexture>)texture;
+    if (mtlTexture.sampleCount > 1 ||
+        static_cast<NSUInteger>(width) > mtlTexture.width ||
+        static_cast<NSUInteger>(height) > mtlTexture.height) {
+        return std::future<ofPixels>();
+    }
+
+    auto readback = std::make_shared<Readback>();
+    switch (mtlTexture.pixelFormat) {
+        case MTLPixelFormatR8Unorm:
+            readback->texelSize = 1;
+            readback->channels = 1;
+            break;
+        case MTLPixelFormatRG8Unorm:
+            readback->texelSize = 2;
+            readback->channels = 2;
+            break;
+        case MTLPixelFormatBGRA8Unorm:
+        case MTLPixelFormatBGRA8Unorm_sRGB:
+            readback->swapRedBlue = true;
+            readback->texelSize = 4;
+            readback->channels = channels == 3 ? 3 : 4;
+            break;
+        case MTLPixelFormatRGBA8Unorm:
+        case MTLPixelFormatRGBA8Unorm_sRGB:
+            readback->texelSize = 4;
+            readback->channels = channels == 3 ? 3 : 4;
+            break;
+        default:
+            return std::future<ofPixels>();
+    }
+    readback->width = width;
+    readback->height = height;
+
+    const NSUInteger bytesPerRow = static_cast<NSUInteger>(width) * readback->texelSize;
+    render::ReadbackTextureCommand cmd;
+    cmd.texture = texture;
+    cmd.bytesPerRow = static_cast<uint32_t>(bytesPerRow);
+    cmd.width = static_cast<uint32_t>(width);
+    cmd.height = static_cast<uint32_t>(height);
+
+    StagingPool& pool = StagingPool::instance();
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        readback->buffer = pool.acquire(mtlTexture.device, bytesPerRow * height);
+    }
+    if (!readback->buffer) {
+        return std::future<ofPixels>();
+    }
+    cmd.buffer = (__bridge void*)readback->buffer;
+    cmd.completion = &ReadbackRegistry::complete;
+
+    std::future<ofPixels> future = readback->promise.get_future();
+    cmd.readbackId = ReadbackRegistry::add(std::move(readback), nullptr, ctx.getFrameNum());
+
+    ctx.getDrawList().addCommand(cmd);
+    return future;
+}
+
+} // namespace oflike
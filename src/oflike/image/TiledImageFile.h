@@ -0,0 +1,101 @@
+#pragma once
+
+// oflike-metal TiledImageFile - tile pyramid files (.ofltiles)
+// Every level of the image halves the one before it and is cut into square
+// tiles, each encoded on its own, so a viewer decodes only what it shows
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace oflike {
+
+// ============================================================================
+// File Layout
+// ============================================================================
+
+/// Header at the start of every .ofltiles file
+/// \details Followed by tileCount TiledImageTile records at tableOffset:
+/// level 0 (full size) first, each level's tiles in rows from the top left.
+/// Level n is the full image halved n times, rounding up; the last level
+/// fits in one tile. Tiles are tileSize pixels square except on the right
+/// and bottom edges, and hold an encoded image (JPEG or PNG, see codec).
+/// Values are little-endian (the native order of every supported Mac).
+struct TiledImageHeader {
+    char magic[8];              ///< kTiledImageMagic
+    uint32_t version;           ///< kTiledImageVersion
+    uint32_t width;             ///< Full-size width in pixels
+    uint32_t height;            ///< Full-size height in pixels
+    uint32_t tileSize;          ///< Tile edge in pixels
+    uint32_t levelCount;
+    uint32_t codec;             ///< kTiledImageJPEG or kTiledImagePNG
+    uint64_t tileCount;
+    uint64_t tableOffset;       ///< Byte offset of the tile records
+};
+
+/// Encoded tile location
+struct TiledImageTile {
+    uint64_t offset;            ///< Byte offset of the encoded tile
+    uint32_t size;              ///< Encoded bytes
+    uint32_t reserved;
+};
+
+constexpr uint32_t kTiledImageJPEG = 0;     // Opaque sources
+constexpr uint32_t kTiledImagePNG = 1;      // Sources with alpha
+
+constexpr char kTiledImageMagic[8] = {'O', 'F', 'L', 'T', 'I', 'L', 'E', 'S'};
+constexpr uint32_t kTiledImageVersion = 1;
+constexpr uint32_t kTiledImageMaxLevels = 32;
+
+/// Size of a level along one axis: the full size halved level times, rounding up
+inline uint32_t tiledImageLevelSize(uint32_t size, uint32_t level) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(size) + (uint64_t(1) << level) - 1) >> level);
+}
+
+/// Tiles covering size pixels
+inline uint32_t tiledImageTilesAcross(uint32_t size, uint32_t tileSize) {
+    return (size + tileSize - 1) / tileSize;
+}
+
+/// Levels of a pyramid: halve until the image fits in one tile
+inline uint32_t tiledImageLevelCount(uint32_t width, uint32_t height, uint32_t tileSize) {
+    uint32_t levels = 1;
+    while (tiledImageLevelSize(width, levels - 1) > tileSize || tiledImageLevelSize(height, levels - 1) > tileSize) {
+        levels++;
+    }
+    return levels;
+}
+
+/// Tiles of all levels of a pyramid
+inline uint64_t tiledImageTileCount(uint32_t width, uint32_t height, uint32_t tileSize, uint32_t levelCount) {
+    uint64_t count = 0;
+    for (uint32_t level = 0; level < levelCount; level++) {
+        count += static_cast<uint64_t>(tiledImageTilesAcross(tiledImageLevelSize(width, level), tileSize)) *
+                 tiledImageTilesAcross(tiledImageLevelSize(height, level), tileSize);
+    }
+    return count;
+}
+
+/// Check that a header describes a pyramid whose tile records fit in a file of fileSize bytes
+inline bool isValidTiledImage(const TiledImageHeader& header, size_t fileSize) {
+    if (fileSize < sizeof(TiledImageHeader) ||
+        std::memcmp(header.magic, kTiledImageMagic, sizeof(kTiledImageMagic)) != 0 ||
+        header.version != kTiledImageVersion ||
+        header.width == 0 || header.height == 0 ||
+        header.tileSize < 16 || header.tileSize > 4096 ||
+        (header.codec != kTiledImageJPEG && header.codec != kTiledImagePNG)) {
+        return false;
+    }
+    const uint32_t levels = tiledImageLevelCount(header.width, header.height, header.tileSize);
+    if (header.levelCount != levels || levels > kTiledImageMaxLevels ||
+        header.tileCount != tiledImageTileCount(header.width, header.height, header.tileSize, levels)) {
+        return false;
+    }
+
+    const uint64_t size = fileSize;
+    return header.tileCount <= size / sizeof(TiledImageTile) &&
+           header.tableOffset <= size &&
+           header.tileCount * sizeof(TiledImageTile) <= size - header.tableOffset;
+}
+
+} // namespace oflike
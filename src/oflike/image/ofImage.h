@@ -5,6 +5,8 @@
 
 #include <string>
 #include <memory>
+#include <functional>
+#include <vector>
 #include "ofPixels.h"
 #include "ofTexture.h"
 
@@ -70,11 +72,47 @@ public:
 
     /// \brief Load image from file
     /// \details Supports formats: PNG, JPG, GIF, BMP, TIFF, and more (via ImageIO)
-    /// Uses MTKTextureLoader for direct GPU upload, falls back to ImageIO
+    /// Decodes through the shared decode cache, then uploads to the GPU
     /// \param fileName Path to image file (absolute or relative)
     /// \return true if successful, false otherwise
     bool load(const std::string& fileName);
 
+    /// \brief Load an image on a background thread
+    /// \details The file is decoded on a worker thread through the decode
+    /// queue; callback then runs on the main thread, between frames, with the
+    /// uploaded image to move from and whether it loaded:
+    /// \code
+    ///     ofImage::loadAsync("photo.jpg", [this](ofImage& image, bool loaded) {
+    ///         if (loaded) photo = std::move(image);
+    ///     });
+    /// \endcode
+    /// \param fileName Path to image file
+    /// \param callback Receives the image and the result on the main thread
+    static void loadAsync(const std::string& fileName,
+                          std::function<void(ofImage& image, bool loaded)> callback);
+
+    /// \brief Load many images on background threads
+    /// \details Decodes run concurrently, at most one per CPU core, in the
+    /// order given. callback runs on the main thread for each file as it
+    /// finishes (not necessarily in order), then finished once for all.
+    /// \param fileNames Paths to image files
+    /// \param callback Receives the file's index, the image and the result
+    /// \param finished Optional; called on the main thread after the last file
+    static void loadAsync(const std::vector<std::string>& fileNames,
+                          std::function<void(size_t index, ofImage& image, bool loaded)> callback,
+                          std::function<void()> finished = nullptr);
+
+    /// \brief Set the memory budget of the shared decode cache
+    /// \details load() and loadAsync() keep recently decoded files, keyed
+    /// by path and modification time, so loading an unchanged file again
+    /// skips decoding. Least recently used files are dropped beyond the
+    /// budget; 0 disables the cache. Defaults to 256 MB.
+    /// \param bytes Cache budget in bytes
+    static void setDecodeCacheSize(size_t bytes);
+
+    /// \brief Drop all decoded files from the shared decode cache
+    static void clearDecodeCache();
+
     /// \brief Save image to file
     /// \details Supported formats: PNG, JPG, TIFF
     /// Format is determined by file extension
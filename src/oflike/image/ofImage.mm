@@ -3,9 +3,11 @@
 #import <Accelerate/Accelerate.h>
 
 #include "ofImage.h"
+#include "ImageDecoder.h"
 #include "../../core/Context.h"
 #include "../utils/ofLog.h"
 #include <algorithm>
+#include <dispatch/dispatch.h>
 
 namespace oflike {
 
@@ -84,105 +86,96 @@ void ofImage::syncTextureFromPixels() {
 // ============================================================================
 
 bool ofImage::load(const std::string& fileName) {
-    @autoreleasepool {
-        ensureImpl();
-
-        NSString* nsPath = [NSString stringWithUTF8String:fileName.c_str()];
-        NSURL* url = [NSURL fileURLWithPath:nsPath];
-
-        if (![[NSFileManager defaultManager] fileExistsAtPath:nsPath]) {
-            ofLogError("ofImage") << "File not found: " << fileName;
-            return false;
-        }
-
-        // Strategy 1: Try MTKTextureLoader for direct GPU upload (fastest)
-        // TODO: This requires accessing MetalRenderer's device directly
-        // For now, use ImageIO path below
-        // Future: Add MetalRenderer::getDevice() method or use renderer->loadTexture()
+    ensureImpl();
 
-        // Strategy 2: Use ImageIO for CPU loading (always works)
-        CGImageSourceRef imageSource = CGImageSourceCreateWithURL((__bridge CFURLRef)url, NULL);
-        if (!imageSource) {
-            ofLogError("ofImage") << "Failed to create image source: " << fileName;
-            return false;
-        }
+    // Decoded (or taken from the decode cache) by ImageIO into the final layout
+    std::shared_ptr<const ofPixels> decoded = decodeImageFile(fileName);
+    if (!decoded) {
+        return false;
+    }
 
-        CGImageRef cgImage = CGImageSourceCreateImageAtIndex(imageSource, 0, NULL);
-        CFRelease(imageSource);
+    impl_->pixels = *decoded;
 
-        if (!cgImage) {
-            ofLogError("ofImage") << "Failed to decode image: " << fileName;
-            return false;
-        }
+    // Upload to GPU
+    impl_->pixelsDirty = true;
+    syncTextureFromPixels();
 
-        // Get image dimensions and properties
-        const size_t width = CGImageGetWidth(cgImage);
-        const size_t height = CGImageGetHeight(cgImage);
-        const size_t bitsPerComponent = 8;
+    ofLogVerbose("ofImage") << "Loaded image: " << fileName
+        << " (" << impl_->pixels.getWidth() << "x" << impl_->pixels.getHeight() << ", "
+        << impl_->pixels.getNumChannels() << " channels)";
 
-        // Determine channel count from color space
-        CGColorSpaceRef colorSpace = CGImageGetColorSpace(cgImage);
-        CGColorSpaceModel colorSpaceModel = CGColorSpaceGetModel(colorSpace);
+    return true;
+}
 
-        size_t channels = 4;  // Default to RGBA
-        if (colorSpaceModel == kCGColorSpaceModelMonochrome) {
-            channels = 1;  // Grayscale
-        } else {
-            CGImageAlphaInfo alphaInfo = CGImageGetAlphaInfo(cgImage);
-            if (alphaInfo == kCGImageAlphaNone || alphaInfo == kCGImageAlphaNoneSkipLast || alphaInfo == kCGImageAlphaNoneSkipFirst) {
-                channels = 3;  // RGB
-            } else {
-                channels = 4;  // RGBA
+void ofImage::loadAsync(const std::string& fileName,
+                        std::function<void(ofImage& image, bool loaded)> callback) {
+    decodeImageFileAsync(fileName, [fileName, callback = std::move(callback)](
+                                       std::shared_ptr<const ofPixels> decoded) mutable {
+        // Upload and hand the image over between frames, where setup()/update() run
+        struct Job {
+            std::string fileName;
+            std::function<void(ofImage&, bool)> callback;
+            std::shared_ptr<const ofPixels> decoded;
+        };
+        Job* job = new Job{std::move(fileName), std::move(callback), std::move(decoded)};
+
+        dispatch_async_f(dispatch_get_main_queue(), job, [](void* context) {
+            std::unique_ptr<Job> job(static_cast<Job*>(context));
+            ofImage image;
+            if (job->decoded) {
+                image.impl_->pixels = *job->decoded;
+                image.impl_->pixelsDirty = true;
+                image.syncTextureFromPixels();
+                ofLogVerbose("ofImage") << "Loaded image: " << job->fileName;
             }
-        }
-
-        // Allocate pixel buffer
-        impl_->pixels.allocate(width, height, channels);
-
-        // Create bitmap context for pixel extraction
-        CGColorSpaceRef drawColorSpace = (channels == 1)
-            ? CGColorSpaceCreateDeviceGray()
-            : CGColorSpaceCreateDeviceRGB();
-
-        CGBitmapInfo bitmapInfo = kCGBitmapByteOrderDefault;
-        if (channels == 4) {
-            bitmapInfo |= kCGImageAlphaPremultipliedLast;
-        } else if (channels == 3) {
-            bitmapInfo |= kCGImageAlphaNoneSkipLast;
-        }
-
-        CGContextRef context = CGBitmapContextCreate(
-            impl_->pixels.getData(),
-            width,
-            height,
-            bitsPerComponent,
-            channels * width,
-            drawColorSpace,
-            bitmapInfo
-        );
-
-        CGColorSpaceRelease(drawColorSpace);
+            if (job->callback) {
+                job->callback(image, job->decoded != nullptr);
+            }
+        });
+    });
+}
 
-        if (!context) {
-            CGImageRelease(cgImage);
-            ofLogError("ofImage") << "Failed to create bitmap context";
-            return false;
+void ofImage::loadAsync(const std::vector<std::string>& fileNames,
+                        std::function<void(size_t index, ofImage& image, bool loaded)> callback,
+                        std::function<void()> finished) {
+    if (fileNames.empty()) {
+        if (finished) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                finished();
+            });
         }
+        return;
+    }
 
-        // Draw image into bitmap context (flips Y to top-left origin)
-        CGContextDrawImage(context, CGRectMake(0, 0, width, height), cgImage);
-        CGContextRelease(context);
-        CGImageRelease(cgImage);
-
-        // Upload to GPU
-        impl_->pixelsDirty = true;
-        syncTextureFromPixels();
+    // Shared by the per-file callbacks, which all run on the main thread
+    struct Batch {
+        std::function<void(size_t, ofImage&, bool)> callback;
+        std::function<void()> finished;
+        size_t remaining = 0;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->callback = std::move(callback);
+    batch->finished = std::move(finished);
+    batch->remaining = fileNames.size();
+
+    for (size_t i = 0; i < fileNames.size(); ++i) {
+        loadAsync(fileNames[i], [batch, i](ofImage& image, bool loaded) {
+            if (batch->callback) {
+                batch->callback(i, image, loaded);
+            }
+            if (--batch->remaining == 0 && batch->finished) {
+                batch->finished();
+            }
+        });
+    }
+}
 
-        ofLogVerbose("ofImage") << "Loaded image: " << fileName
-            << " (" << width << "x" << height << ", " << channels << " channels)";
+void ofImage::setDecodeCacheSize(size_t bytes) {
+    setImageDecodeCacheSize(bytes);
+}
 
-        return true;
-    }
+void ofImage::clearDecodeCache() {
+    clearImageDecodeCache();
 }
 
 bool ofImage::save(const std::string& fileName, float quality) {
@@ -218,7 +211,7 @@ bool ofImage::save(const std::string& fileName, float quality) {
         const size_t height = impl_->pixels.getHeight();
         const size_t channels = impl_->pixels.getNumChannels();
         const size_t bitsPerComponent = 8;
-        const size_t bytesPerRow = channels * width;
+        const size_t bytesPerRow = impl_->pixels.getBytesStride();
 
         CGColorSpaceRef colorSpace = (channels == 1)
             ? CGColorSpaceCreateDeviceGray()
@@ -2,13 +2,16 @@
 
 // oflike-metal ofImageFilter - Image filtering operations
 // Provides blur, sharpen, contrast, and other image filters
-// Uses Accelerate framework (vImage) for CPU processing
+// Uses Accelerate framework (vImage) for CPU processing and Metal Performance
+// Shaders for texture to texture filtering on the GPU
 
 #include "ofPixels.h"
 #include <string>
 
 namespace oflike {
 
+class ofTexture;
+
 /// \brief Image filtering operations using Accelerate framework
 /// \details ofImageFilter provides various image processing operations
 /// optimized using the vImage API from Accelerate framework.
@@ -26,6 +29,14 @@ namespace oflike {
 ///
 /// All operations work in-place on ofPixels or return a new ofPixels.
 ///
+/// Blur, sharpen, Sobel, morphology, convolution and median also run on the
+/// GPU from one ofTexture into another, so live video can be filtered
+/// without leaving the GPU. The GPU filter is recorded into the frame like a
+/// draw and runs when the frame renders, after everything drawn before it;
+/// drawing the destination afterwards shows the result in the same frame.
+/// The destination is (re)allocated with ofTexture::allocateWritable() at the
+/// source size and holds RGBA8; its previous contents are replaced.
+///
 /// Example:
 /// \code
 ///     ofPixels pixels;
@@ -203,6 +214,52 @@ public:
     /// \return true on success
     static bool median(ofPixels& pixels, int radius);
 
+    // ========================================================================
+    // GPU Filters (ofTexture to ofTexture)
+    // ========================================================================
+
+    /// \brief Apply Gaussian blur on the GPU
+    /// \param src Source texture (not a subsection)
+    /// \param dst Destination texture (allocated writable as needed; not src)
+    /// \param radius Blur radius in pixels, spread like the CPU blur
+    /// \return false if the filter couldn't be recorded
+    static bool blur(const ofTexture& src, ofTexture& dst, float radius);
+
+    /// \brief Apply box blur on the GPU
+    /// \param radius Blur radius in pixels (kernel of 2 * radius + 1)
+    static bool boxBlur(const ofTexture& src, ofTexture& dst, int radius);
+
+    /// \brief Apply unsharp mask sharpening on the GPU
+    /// \param amount Sharpening amount (0.0 = none, 1.0 = normal, >1.0 = strong)
+    /// \param radius Blur radius for the unsharp mask
+    static bool sharpen(const ofTexture& src, ofTexture& dst, float amount, float radius = 1.0f);
+
+    /// \brief Apply Sobel edge detection on the GPU (luminance edges in gray)
+    static bool sobel(const ofTexture& src, ofTexture& dst);
+
+    /// \brief Apply dilation on the GPU
+    /// \param radius Dilation radius (kernel of 2 * radius + 1)
+    static bool dilate(const ofTexture& src, ofTexture& dst, int radius);
+
+    /// \brief Apply erosion on the GPU
+    /// \param radius Erosion radius (kernel of 2 * radius + 1)
+    static bool erode(const ofTexture& src, ofTexture& dst, int radius);
+
+    /// \brief Apply a custom convolution kernel on the GPU
+    /// \param kernel Convolution kernel data (row-major order)
+    /// \param kernelWidth Kernel width (odd, at most 9)
+    /// \param kernelHeight Kernel height (odd, at most 9)
+    /// \param divisor Divisor for normalization (sum of kernel values if 0)
+    static bool convolve(const ofTexture& src, ofTexture& dst,
+                         const float* kernel,
+                         int kernelWidth,
+                         int kernelHeight,
+                         float divisor = 0.0f);
+
+    /// \brief Apply median filter on the GPU
+    /// \param radius Filter radius (1 to 4)
+    static bool median(const ofTexture& src, ofTexture& dst, int radius);
+
 private:
     /// \brief Clamp value to byte range
     static inline unsigned char clampToByte(int value) {
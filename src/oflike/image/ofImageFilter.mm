@@ -1,8 +1,17 @@
 #import "ofImageFilter.h"
+#import "ofTexture.h"
+#import "../../core/Context.h"
+#import "../../render/DrawList.h"
+#import "../../render/DrawCommand.h"
 #import <Accelerate/Accelerate.h>
+#import <dispatch/dispatch.h>
 #import <cmath>
+#import <cstring>
 #import <cstdlib>
 #import <vector>
+#if defined(__ARM_NEON)
+#import <arm_neon.h>
+#endif
 
 namespace oflike {
 
@@ -16,7 +25,7 @@ static vImage_Buffer CreateBuffer(ofPixels& pixels) {
         .data = pixels.getData(),
         .height = static_cast<vImagePixelCount>(pixels.getHeight()),
         .width = static_cast<vImagePixelCount>(pixels.getWidth()),
-        .rowBytes = pixels.getWidth() * pixels.getNumChannels()
+        .rowBytes = pixels.getBytesStride()
     };
 }
 
@@ -26,15 +35,34 @@ static vImage_Buffer CreateBufferConst(const ofPixels& pixels) {
         .data = const_cast<unsigned char*>(pixels.getData()),
         .height = static_cast<vImagePixelCount>(pixels.getHeight()),
         .width = static_cast<vImagePixelCount>(pixels.getWidth()),
-        .rowBytes = pixels.getWidth() * pixels.getNumChannels()
+        .rowBytes = pixels.getBytesStride()
     };
 }
 
+/// Run a filter on a packed copy of pixels with padded rows (views over
+/// external buffers) and write the rows back; the filters index tightly
+/// packed pixels
+template <typename Filter>
+static bool FilterPacked(ofPixels& pixels, Filter&& filter) {
+    ofPixels packed = pixels;  // Copies are tightly packed
+    if (!filter(packed)) return false;
+
+    const size_t rowBytes = pixels.getWidth() * pixels.getBytesPerPixel();
+    for (size_t y = 0; y < pixels.getHeight(); ++y) {
+        std::memcpy(pixels.getRowData(y), packed.getRowData(y), rowBytes);
+    }
+    return true;
+}
+
 // ============================================================================
 // Blur Operations
 // ============================================================================
 
 bool ofImageFilter::blur(ofPixels& pixels, float radius) {
+    if (pixels.isAllocated() && !pixels.isContiguous()) {
+        return FilterPacked(pixels, [&](ofPixels& p) { return ofImageFilter::blur(p, radius); });
+    }
+
     if (!pixels.isAllocated() || radius <= 0) {
         return false;
     }
@@ -106,13 +134,16 @@ bool ofImageFilter::blur(ofPixels& pixels, float radius) {
 bool ofImageFilter::blur(const ofPixels& src, ofPixels& dst, float radius) {
     if (!src.isAllocated()) return false;
 
-    dst.allocate(src.getWidth(), src.getHeight(), src.getNumChannels());
-    std::memcpy(dst.getData(), src.getData(), src.getTotalBytes());
+    dst = src;
 
     return blur(dst, radius);
 }
 
 bool ofImageFilter::boxBlur(ofPixels& pixels, int radius) {
+    if (pixels.isAllocated() && !pixels.isContiguous()) {
+        return FilterPacked(pixels, [&](ofPixels& p) { return ofImageFilter::boxBlur(p, radius); });
+    }
+
     if (!pixels.isAllocated() || radius <= 0) {
         return false;
     }
@@ -151,6 +182,12 @@ bool ofImageFilter::boxBlur(ofPixels& pixels, int radius) {
 // ============================================================================
 
 bool ofImageFilter::sharpen(ofPixels& pixels, float amount, float radius) {
+    if (pixels.isAllocated() && !pixels.isContiguous()) {
+        return FilterPacked(pixels, [&](ofPixels& p) {
+            return ofImageFilter::sharpen(p, amount, radius);
+        });
+    }
+
     if (!pixels.isAllocated() || amount <= 0) {
         return true;  // No sharpening needed
     }
@@ -186,6 +223,12 @@ bool ofImageFilter::sharpen(ofPixels& pixels, float amount, float radius) {
 }
 
 bool ofImageFilter::sharpenHighPass(ofPixels& pixels, float strength) {
+    if (pixels.isAllocated() && !pixels.isContiguous()) {
+        return FilterPacked(pixels, [&](ofPixels& p) {
+            return ofImageFilter::sharpenHighPass(p, strength);
+        });
+    }
+
     if (!pixels.isAllocated()) return false;
 
     // High-pass sharpening kernel
@@ -203,98 +246,222 @@ bool ofImageFilter::sharpenHighPass(ofPixels& pixels, float strength) {
 }
 
 // ============================================================================
-// Color Adjustments
+// Point Operation Executor
 // ============================================================================
 
-bool ofImageFilter::contrast(ofPixels& pixels, float contrast) {
-    if (!pixels.isAllocated()) return false;
+/// Rows per band for ForEachRowBand() (about 64 KB of pixels each)
+static size_t RowsPerBand(const ofPixels& pixels) {
+    constexpr size_t kBandBytes = 64 * 1024;
+    const size_t rowBytes = std::max<size_t>(1, pixels.getWidth() * pixels.getBytesPerPixel());
+    return std::max<size_t>(1, kBandBytes / rowBytes);
+}
 
-    const size_t totalBytes = pixels.getTotalBytes();
-    const size_t channels = pixels.getNumChannels();
-    unsigned char* data = pixels.getData();
+/// Run body(y0, y1) over bands of rows on the global queue; images that fit
+/// in one band run on the calling thread
+template <typename Body>
+static void ForEachRowBand(const ofPixels& pixels, const Body& body) {
+    const size_t height = pixels.getHeight();
+    const size_t rowsPerBand = RowsPerBand(pixels);
+    const size_t bands = (height + rowsPerBand - 1) / rowsPerBand;
+    if (bands <= 1) {
+        body(0, height);
+        return;
+    }
+    const Body* bandBody = &body;
+    dispatch_apply(bands, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t band) {
+        const size_t y0 = band * rowsPerBand;
+        (*bandBody)(y0, std::min(height, y0 + rowsPerBand));
+    });
+}
 
-    // Contrast adjustment: (pixel - 128) * contrast + 128
-    for (size_t i = 0; i < totalBytes; ++i) {
-        // Skip alpha channel if RGBA
-        if (channels == 4 && (i % 4) == 3) continue;
+#if defined(__ARM_NEON)
+/// 256-entry table lookup of 16 bytes (four 64-entry TBL lookups; indices out
+/// of a quarter's range read 0, so the quarters OR together)
+static inline uint8x16_t LookupBytes(const uint8x16x4_t table[4], uint8x16_t index) {
+    const uint8x16_t quarter = vdupq_n_u8(64);
+    uint8x16_t result = vqtbl4q_u8(table[0], index);
+    index = vsubq_u8(index, quarter);
+    result = vorrq_u8(result, vqtbl4q_u8(table[1], index));
+    index = vsubq_u8(index, quarter);
+    result = vorrq_u8(result, vqtbl4q_u8(table[2], index));
+    index = vsubq_u8(index, quarter);
+    return vorrq_u8(result, vqtbl4q_u8(table[3], index));
+}
 
-        float value = static_cast<float>(data[i]);
-        value = (value - 128.0f) * contrast + 128.0f;
-        data[i] = clampToByte(value);
-    }
+/// Widen 16 bytes to four float vectors
+static inline void WidenToFloat(uint8x16_t bytes, float32x4_t out[4]) {
+    const uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+    const uint16x8_t hi = vmovl_u8(vget_high_u8(bytes));
+    out[0] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo)));
+    out[1] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo)));
+    out[2] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi)));
+    out[3] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi)));
+}
 
-    return true;
+/// Narrow four float vectors to 16 bytes, truncating and clamping to 0-255
+/// like clampToByte()
+static inline uint8x16_t NarrowToBytes(const float32x4_t in[4]) {
+    const uint16x8_t lo = vcombine_u16(vqmovn_u32(vcvtq_u32_f32(in[0])),
+                                       vqmovn_u32(vcvtq_u32_f32(in[1])));
+    const uint16x8_t hi = vcombine_u16(vqmovn_u32(vcvtq_u32_f32(in[2])),
+                                       vqmovn_u32(vcvtq_u32_f32(in[3])));
+    return vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi));
 }
+#endif
 
-bool ofImageFilter::brightness(ofPixels& pixels, float brightness) {
+/// Map every color byte through a 256-entry table (alpha of RGBA untouched),
+/// in row bands across cores
+static bool ApplyLUT(ofPixels& pixels, const unsigned char (&lut)[256]) {
     if (!pixels.isAllocated()) return false;
 
-    const size_t totalBytes = pixels.getTotalBytes();
     const size_t channels = pixels.getNumChannels();
-    unsigned char* data = pixels.getData();
-
-    for (size_t i = 0; i < totalBytes; ++i) {
-        // Skip alpha channel if RGBA
-        if (channels == 4 && (i % 4) == 3) continue;
-
-        int value = static_cast<int>(data[i]) + static_cast<int>(brightness);
-        data[i] = clampToByte(value);
-    }
+    const size_t rowBytes = pixels.getWidth() * channels;
+    const bool keepAlpha = channels == 4;
+
+    ForEachRowBand(pixels, [&](size_t y0, size_t y1) {
+#if defined(__ARM_NEON)
+        uint8x16x4_t table[4];
+        for (int q = 0; q < 4; ++q) {
+            table[q] = vld1q_u8_x4(lut + q * 64);
+        }
+        static const uint8_t kAlphaLanes[16] = {0, 0, 0, 0xFF, 0, 0, 0, 0xFF,
+                                                0, 0, 0, 0xFF, 0, 0, 0, 0xFF};
+        const uint8x16_t alphaMask = keepAlpha ? vld1q_u8(kAlphaLanes) : vdupq_n_u8(0);
+#endif
+        for (size_t y = y0; y < y1; ++y) {
+            unsigned char* row = pixels.getRowData(y);
+            size_t i = 0;
+#if defined(__ARM_NEON)
+            // 16 bytes is a whole number of RGBA pixels, so alpha lanes stay put
+            for (; i + 16 <= rowBytes; i += 16) {
+                const uint8x16_t src = vld1q_u8(row + i);
+                vst1q_u8(row + i, vbslq_u8(alphaMask, src, LookupBytes(table, src)));
+            }
+#endif
+            for (; i < rowBytes; ++i) {
+                if (keepAlpha && (i % 4) == 3) continue;
+                row[i] = lut[row[i]];
+            }
+        }
+    });
 
     return true;
 }
 
-bool ofImageFilter::brightnessContrast(ofPixels& pixels, float brightness, float contrast) {
+// ============================================================================
+// Color Adjustments
+// ============================================================================
+
+bool ofImageFilter::contrast(ofPixels& pixels, float contrast) {
     if (!pixels.isAllocated()) return false;
 
-    const size_t totalBytes = pixels.getTotalBytes();
-    const size_t channels = pixels.getNumChannels();
-    unsigned char* data = pixels.getData();
+    // Contrast adjustment: (pixel - 128) * contrast + 128
+    unsigned char lut[256];
+    for (int i = 0; i < 256; ++i) {
+        lut[i] = clampToByte((static_cast<float>(i) - 128.0f) * contrast + 128.0f);
+    }
+    return ApplyLUT(pixels, lut);
+}
 
-    for (size_t i = 0; i < totalBytes; ++i) {
-        // Skip alpha channel if RGBA
-        if (channels == 4 && (i % 4) == 3) continue;
+bool ofImageFilter::brightness(ofPixels& pixels, float brightness) {
+    if (!pixels.isAllocated()) return false;
 
-        float value = static_cast<float>(data[i]);
-        value = (value - 128.0f) * contrast + 128.0f + brightness;
-        data[i] = clampToByte(value);
+    unsigned char lut[256];
+    for (int i = 0; i < 256; ++i) {
+        lut[i] = clampToByte(i + static_cast<int>(brightness));
     }
+    return ApplyLUT(pixels, lut);
+}
 
-    return true;
+bool ofImageFilter::brightnessContrast(ofPixels& pixels, float brightness, float contrast) {
+    if (!pixels.isAllocated()) return false;
+
+    unsigned char lut[256];
+    for (int i = 0; i < 256; ++i) {
+        lut[i] = clampToByte((static_cast<float>(i) - 128.0f) * contrast + 128.0f + brightness);
+    }
+    return ApplyLUT(pixels, lut);
 }
 
 bool ofImageFilter::saturation(ofPixels& pixels, float saturation) {
     if (!pixels.isAllocated()) return false;
 
     const size_t width = pixels.getWidth();
-    const size_t height = pixels.getHeight();
     const size_t channels = pixels.getNumChannels();
 
     if (channels < 3) {
         return true;  // Can't adjust saturation on grayscale
     }
 
-    unsigned char* data = pixels.getData();
+    ForEachRowBand(pixels, [&](size_t y0, size_t y1) {
+#if defined(__ARM_NEON)
+        const float32x4_t amount = vdupq_n_f32(saturation);
+        const float32x4_t weightR = vdupq_n_f32(0.299f);
+        const float32x4_t weightG = vdupq_n_f32(0.587f);
+        const float32x4_t weightB = vdupq_n_f32(0.114f);
+#endif
+        for (size_t y = y0; y < y1; ++y) {
+            unsigned char* row = pixels.getRowData(y);
+            size_t x = 0;
+#if defined(__ARM_NEON)
+            // 16 pixels per step, deinterleaved into R, G, B (and A) vectors
+            for (; x + 16 <= width; x += 16) {
+                unsigned char* px = row + x * channels;
+                uint8x16x4_t rgba;
+                if (channels == 4) {
+                    rgba = vld4q_u8(px);
+                } else {
+                    const uint8x16x3_t rgb = vld3q_u8(px);
+                    rgba.val[0] = rgb.val[0];
+                    rgba.val[1] = rgb.val[1];
+                    rgba.val[2] = rgb.val[2];
+                }
 
-    for (size_t i = 0; i < width * height; ++i) {
-        size_t idx = i * channels;
+                float32x4_t r[4], g[4], b[4];
+                WidenToFloat(rgba.val[0], r);
+                WidenToFloat(rgba.val[1], g);
+                WidenToFloat(rgba.val[2], b);
+                for (int k = 0; k < 4; ++k) {
+                    // Interpolate between luminance and the original
+                    const float32x4_t gray = vmlaq_f32(vmlaq_f32(vmulq_f32(weightR, r[k]),
+                                                                 weightG, g[k]),
+                                                       weightB, b[k]);
+                    r[k] = vmlaq_f32(gray, amount, vsubq_f32(r[k], gray));
+                    g[k] = vmlaq_f32(gray, amount, vsubq_f32(g[k], gray));
+                    b[k] = vmlaq_f32(gray, amount, vsubq_f32(b[k], gray));
+                }
+                rgba.val[0] = NarrowToBytes(r);
+                rgba.val[1] = NarrowToBytes(g);
+                rgba.val[2] = NarrowToBytes(b);
+
+                if (channels == 4) {
+                    vst4q_u8(px, rgba);
+                } else {
+                    vst3q_u8(px, uint8x16x3_t{{rgba.val[0], rgba.val[1], rgba.val[2]}});
+                }
+            }
+#endif
+            for (; x < width; ++x) {
+                unsigned char* px = row + x * channels;
 
-        float r = static_cast<float>(data[idx + 0]);
-        float g = static_cast<float>(data[idx + 1]);
-        float b = static_cast<float>(data[idx + 2]);
+                float r = static_cast<float>(px[0]);
+                float g = static_cast<float>(px[1]);
+                float b = static_cast<float>(px[2]);
 
-        // Calculate luminance
-        float gray = 0.299f * r + 0.587f * g + 0.114f * b;
+                // Calculate luminance
+                float gray = 0.299f * r + 0.587f * g + 0.114f * b;
 
-        // Interpolate between gray and original
-        r = gray + saturation * (r - gray);
-        g = gray + saturation * (g - gray);
-        b = gray + saturation * (b - gray);
+                // Interpolate between gray and original
+                r = gray + saturation * (r - gray);
+                g = gray + saturation * (g - gray);
+                b = gray + saturation * (b - gray);
 
-        data[idx + 0] = clampToByte(r);
-        data[idx + 1] = clampToByte(g);
-        data[idx + 2] = clampToByte(b);
-    }
+                px[0] = clampToByte(r);
+                px[1] = clampToByte(g);
+                px[2] = clampToByte(b);
+            }
+        }
+    });
 
     return true;
 }
@@ -306,18 +473,11 @@ bool ofImageFilter::grayscale(ofPixels& pixels) {
 bool ofImageFilter::invert(ofPixels& pixels) {
     if (!pixels.isAllocated()) return false;
 
-    const size_t totalBytes = pixels.getTotalBytes();
-    const size_t channels = pixels.getNumChannels();
-    unsigned char* data = pixels.getData();
-
-    for (size_t i = 0; i < totalBytes; ++i) {
-        // Skip alpha channel if RGBA
-        if (channels == 4 && (i % 4) == 3) continue;
-
-        data[i] = 255 - data[i];
+    unsigned char lut[256];
+    for (int i = 0; i < 256; ++i) {
+        lut[i] = static_cast<unsigned char>(255 - i);
     }
-
-    return true;
+    return ApplyLUT(pixels, lut);
 }
 
 bool ofImageFilter::gamma(ofPixels& pixels, float gamma) {
@@ -332,19 +492,7 @@ bool ofImageFilter::gamma(ofPixels& pixels, float gamma) {
         float corrected = std::pow(normalized, invGamma);
         lut[i] = clampToByte(corrected * 255.0f);
     }
-
-    const size_t totalBytes = pixels.getTotalBytes();
-    const size_t channels = pixels.getNumChannels();
-    unsigned char* data = pixels.getData();
-
-    for (size_t i = 0; i < totalBytes; ++i) {
-        // Skip alpha channel if RGBA
-        if (channels == 4 && (i % 4) == 3) continue;
-
-        data[i] = lut[data[i]];
-    }
-
-    return true;
+    return ApplyLUT(pixels, lut);
 }
 
 // ============================================================================
@@ -352,6 +500,10 @@ bool ofImageFilter::gamma(ofPixels& pixels, float gamma) {
 // ============================================================================
 
 bool ofImageFilter::sobel(ofPixels& pixels) {
+    if (pixels.isAllocated() && !pixels.isContiguous()) {
+        return FilterPacked(pixels, [&](ofPixels& p) { return ofImageFilter::sobel(p); });
+    }
+
     if (!pixels.isAllocated()) return false;
 
     @autoreleasepool {
@@ -420,6 +572,10 @@ bool ofImageFilter::sobel(ofPixels& pixels) {
 }
 
 bool ofImageFilter::laplacian(ofPixels& pixels) {
+    if (pixels.isAllocated() && !pixels.isContiguous()) {
+        return FilterPacked(pixels, [&](ofPixels& p) { return ofImageFilter::laplacian(p); });
+    }
+
     if (!pixels.isAllocated()) return false;
 
     // Laplacian kernel
@@ -452,6 +608,10 @@ bool ofImageFilter::laplacian(ofPixels& pixels) {
 // ============================================================================
 
 bool ofImageFilter::dilate(ofPixels& pixels, int radius) {
+    if (pixels.isAllocated() && !pixels.isContiguous()) {
+        return FilterPacked(pixels, [&](ofPixels& p) { return ofImageFilter::dilate(p, radius); });
+    }
+
     if (!pixels.isAllocated() || radius <= 0) return false;
 
     @autoreleasepool {
@@ -482,6 +642,10 @@ bool ofImageFilter::dilate(ofPixels& pixels, int radius) {
 }
 
 bool ofImageFilter::erode(ofPixels& pixels, int radius) {
+    if (pixels.isAllocated() && !pixels.isContiguous()) {
+        return FilterPacked(pixels, [&](ofPixels& p) { return ofImageFilter::erode(p, radius); });
+    }
+
     if (!pixels.isAllocated() || radius <= 0) return false;
 
     @autoreleasepool {
@@ -520,6 +684,12 @@ bool ofImageFilter::convolve(ofPixels& pixels,
                              int kernelWidth,
                              int kernelHeight,
                              float divisor) {
+    if (pixels.isAllocated() && !pixels.isContiguous()) {
+        return FilterPacked(pixels, [&](ofPixels& p) {
+            return ofImageFilter::convolve(p, kernel, kernelWidth, kernelHeight, divisor);
+        });
+    }
+
     if (!pixels.isAllocated() || !kernel) return false;
     if (kernelWidth < 1 || kernelHeight < 1) return false;
     if ((kernelWidth % 2) == 0 || (kernelHeight % 2) == 0) return false;  // Must be odd
@@ -608,23 +778,22 @@ bool ofImageFilter::convolve(ofPixels& pixels,
 bool ofImageFilter::threshold(ofPixels& pixels, int threshold) {
     if (!pixels.isAllocated()) return false;
 
-    const size_t totalBytes = pixels.getTotalBytes();
-    const size_t channels = pixels.getNumChannels();
-    unsigned char* data = pixels.getData();
-
     threshold = std::max(0, std::min(255, threshold));
 
-    for (size_t i = 0; i < totalBytes; ++i) {
-        // Skip alpha channel if RGBA
-        if (channels == 4 && (i % 4) == 3) continue;
-
-        data[i] = (data[i] >= threshold) ? 255 : 0;
+    unsigned char lut[256];
+    for (int i = 0; i < 256; ++i) {
+        lut[i] = (i >= threshold) ? 255 : 0;
     }
-
-    return true;
+    return ApplyLUT(pixels, lut);
 }
 
 bool ofImageFilter::adaptiveThreshold(ofPixels& pixels, int blockSize, int constant) {
+    if (pixels.isAllocated() && !pixels.isContiguous()) {
+        return FilterPacked(pixels, [&](ofPixels& p) {
+            return ofImageFilter::adaptiveThreshold(p, blockSize, constant);
+        });
+    }
+
     if (!pixels.isAllocated()) return false;
     if (blockSize < 3) blockSize = 3;
     if ((blockSize % 2) == 0) blockSize++;  // Must be odd
@@ -665,24 +834,45 @@ bool ofImageFilter::addNoise(ofPixels& pixels, float amount) {
 
     amount = std::min(1.0f, amount) * 255.0f;
 
-    const size_t totalBytes = pixels.getTotalBytes();
     const size_t channels = pixels.getNumChannels();
-    unsigned char* data = pixels.getData();
-
-    for (size_t i = 0; i < totalBytes; ++i) {
-        // Skip alpha channel if RGBA
-        if (channels == 4 && (i % 4) == 3) continue;
-
-        // Random noise in range [-amount, amount]
-        float noise = (static_cast<float>(rand()) / RAND_MAX * 2.0f - 1.0f) * amount;
-        int value = static_cast<int>(data[i]) + static_cast<int>(noise);
-        data[i] = clampToByte(value);
+    const size_t rowBytes = pixels.getWidth() * channels;
+
+    // One xorshift generator per band, seeded from rand() up front so the
+    // result follows srand() and doesn't depend on thread scheduling
+    const size_t rowsPerBand = RowsPerBand(pixels);
+    std::vector<uint32_t> seeds((pixels.getHeight() + rowsPerBand - 1) / rowsPerBand);
+    for (uint32_t& seed : seeds) {
+        seed = static_cast<uint32_t>(rand()) | 1u;
     }
 
+    ForEachRowBand(pixels, [&](size_t y0, size_t y1) {
+        uint32_t state = seeds[y0 / rowsPerBand];
+        for (size_t y = y0; y < y1; ++y) {
+            unsigned char* row = pixels.getRowData(y);
+            for (size_t i = 0; i < rowBytes; ++i) {
+                // Skip alpha channel if RGBA
+                if (channels == 4 && (i % 4) == 3) continue;
+
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+
+                // Random noise in range [-amount, amount]
+                float noise = (static_cast<float>(state) / 4294967295.0f * 2.0f - 1.0f) * amount;
+                int value = static_cast<int>(row[i]) + static_cast<int>(noise);
+                row[i] = clampToByte(value);
+            }
+        }
+    });
+
     return true;
 }
 
 bool ofImageFilter::median(ofPixels& pixels, int radius) {
+    if (pixels.isAllocated() && !pixels.isContiguous()) {
+        return FilterPacked(pixels, [&](ofPixels& p) { return ofImageFilter::median(p, radius); });
+    }
+
     if (!pixels.isAllocated() || radius <= 0) return false;
 
     @autoreleasepool {
@@ -731,4 +921,117 @@ bool ofImageFilter::median(ofPixels& pixels, int radius) {
     }
 }
 
+// ============================================================================
+// GPU Filters
+// ============================================================================
+
+/// Record a filter from src into dst, allocating dst writable at src's size
+static bool RecordFilter(const ofTexture& src, ofTexture& dst, render::FilterTextureCommand& cmd) {
+    auto& ctx = Context::instance();
+    if (&src == &dst || !src.isAllocated() || src.isSubsection() || !src.getNativeHandle() ||
+        !ctx.isInitialized()) {
+        return false;
+    }
+    if (!dst.allocateWritable(src.getWidth(), src.getHeight())) {
+        return false;
+    }
+
+    cmd.source = src.getNativeHandle();
+    cmd.destination = dst.getNativeHandle();
+    ctx.getDrawList().addCommand(cmd);
+    return true;
+}
+
+/// Record a filter with a square kernel of 2 * radius + 1
+static bool RecordSquareFilter(const ofTexture& src, ofTexture& dst,
+                               render::ImageFilterType filter, int radius) {
+    if (radius <= 0) return false;
+
+    render::FilterTextureCommand cmd;
+    cmd.filter = filter;
+    cmd.kernelWidth = static_cast<uint32_t>(radius * 2 + 1);
+    cmd.kernelHeight = cmd.kernelWidth;
+    return RecordFilter(src, dst, cmd);
+}
+
+/// Gaussian sigma with the spread of the CPU blur's tent of the same radius
+static float BlurSigma(float radius) {
+    int kernelSize = static_cast<int>(radius * 2.0f) | 1;
+    if (kernelSize < 3) kernelSize = 3;
+    if (kernelSize > 255) kernelSize = 255;
+    return static_cast<float>(kernelSize) / (2.0f * std::sqrt(6.0f));
+}
+
+bool ofImageFilter::blur(const ofTexture& src, ofTexture& dst, float radius) {
+    if (radius <= 0) return false;
+
+    render::FilterTextureCommand cmd;
+    cmd.filter = render::ImageFilterType::GaussianBlur;
+    cmd.sigma = BlurSigma(radius);
+    return RecordFilter(src, dst, cmd);
+}
+
+bool ofImageFilter::boxBlur(const ofTexture& src, ofTexture& dst, int radius) {
+    return RecordSquareFilter(src, dst, render::ImageFilterType::BoxBlur, radius);
+}
+
+bool ofImageFilter::sharpen(const ofTexture& src, ofTexture& dst, float amount, float radius) {
+    if (radius <= 0) return false;
+
+    render::FilterTextureCommand cmd;
+    cmd.filter = render::ImageFilterType::Unsharp;
+    cmd.sigma = BlurSigma(radius);
+    cmd.amount = std::max(0.0f, amount);
+    return RecordFilter(src, dst, cmd);
+}
+
+bool ofImageFilter::sobel(const ofTexture& src, ofTexture& dst) {
+    render::FilterTextureCommand cmd;
+    cmd.filter = render::ImageFilterType::Sobel;
+    return RecordFilter(src, dst, cmd);
+}
+
+bool ofImageFilter::dilate(const ofTexture& src, ofTexture& dst, int radius) {
+    return RecordSquareFilter(src, dst, render::ImageFilterType::Dilate, radius);
+}
+
+bool ofImageFilter::erode(const ofTexture& src, ofTexture& dst, int radius) {
+    return RecordSquareFilter(src, dst, render::ImageFilterType::Erode, radius);
+}
+
+bool ofImageFilter::convolve(const ofTexture& src, ofTexture& dst,
+                             const float* kernel,
+                             int kernelWidth,
+                             int kernelHeight,
+                             float divisor) {
+    constexpr int kMaxKernelSize = static_cast<int>(render::FilterTextureCommand::kMaxKernelSize);
+    if (!kernel || kernelWidth < 1 || kernelHeight < 1) return false;
+    if ((kernelWidth % 2) == 0 || (kernelHeight % 2) == 0) return false;  // Must be odd
+    if (kernelWidth > kMaxKernelSize || kernelHeight > kMaxKernelSize) return false;
+
+    // Calculate divisor if not provided
+    if (divisor == 0.0f) {
+        for (int i = 0; i < kernelWidth * kernelHeight; ++i) {
+            divisor += kernel[i];
+        }
+        if (divisor == 0.0f) divisor = 1.0f;
+    }
+
+    render::FilterTextureCommand cmd;
+    cmd.filter = render::ImageFilterType::Convolve;
+    cmd.kernelWidth = static_cast<uint32_t>(kernelWidth);
+    cmd.kernelHeight = static_cast<uint32_t>(kernelHeight);
+    for (int i = 0; i < kernelWidth * kernelHeight; ++i) {
+        cmd.weights[i] = kernel[i] / divisor;
+    }
+    return RecordFilter(src, dst, cmd);
+}
+
+bool ofImageFilter::median(const ofTexture& src, ofTexture& dst, int radius) {
+    // The GPU median window is at most 9x9
+    const int maxRadius = static_cast<int>(render::FilterTextureCommand::kMaxKernelSize / 2);
+    if (radius <= 0 || radius > maxRadius) return false;
+    return RecordSquareFilter(src, dst, render::ImageFilterType::Median, radius);
+}
+
 } // namespace oflike
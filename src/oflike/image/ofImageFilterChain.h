@@ -0,0 +1,148 @@
+#pragma once
+
+// oflike-metal ofImageFilterChain - recorded ofImageFilter sequences
+// Consecutive per-pixel filters run fused in one pass (lookup tables on the
+// CPU, one kernel on the GPU); only neighborhood filters make extra passes
+
+#include <memory>
+#include <cstddef>
+#include "ofPixels.h"
+
+namespace oflike {
+
+class ofTexture;
+
+/// \brief Sequence of image filters applied with as few passes as possible
+/// \details Filters are recorded once and applied to pixels or textures any
+/// number of times, in order, with the same results as the matching
+/// ofImageFilter calls.
+///
+/// Runs of per-pixel filters (brightness, contrast, saturation, grayscale,
+/// invert, gamma, threshold) are fused into a single pass over the image:
+/// on the CPU the per-channel ones collapse into one 256-entry lookup table,
+/// on the GPU the whole run is one compute kernel. Neighborhood filters
+/// (blur, sharpen, edges, morphology, convolution, median) are passes of
+/// their own, so a chain costs one pass per neighborhood filter plus one per
+/// run of per-pixel filters between them.
+///
+/// Example:
+/// \code
+///     ofImageFilterChain chain;
+///     chain.brightnessContrast(10.0f, 1.2f).saturation(1.3f).gamma(0.9f).blur(3.0f);
+///
+///     chain.apply(pixels);                      // 2 passes instead of 4
+///     chain.apply(grabber.getTexture(), result); // Same chain on the GPU
+/// \endcode
+class ofImageFilterChain {
+public:
+    // ========================================================================
+    // Construction / Destruction
+    // ========================================================================
+
+    ofImageFilterChain();
+    ~ofImageFilterChain();
+
+    ofImageFilterChain(ofImageFilterChain&& other) noexcept;
+    ofImageFilterChain& operator=(ofImageFilterChain&& other) noexcept;
+
+    ofImageFilterChain(const ofImageFilterChain&) = delete;
+    ofImageFilterChain& operator=(const ofImageFilterChain&) = delete;
+
+    // ========================================================================
+    // Per-Pixel Filters (fused)
+    // ========================================================================
+
+    /// \brief Add a brightness offset (-255 to 255), see ofImageFilter::brightness()
+    ofImageFilterChain& brightness(float brightness);
+
+    /// \brief Add a contrast multiplier, see ofImageFilter::contrast()
+    ofImageFilterChain& contrast(float contrast);
+
+    /// \brief Add brightness and contrast, see ofImageFilter::brightnessContrast()
+    ofImageFilterChain& brightnessContrast(float brightness, float contrast);
+
+    /// \brief Add a saturation multiplier, see ofImageFilter::saturation()
+    ofImageFilterChain& saturation(float saturation);
+
+    /// \brief Add conversion to grayscale (keeps the channel count)
+    ofImageFilterChain& grayscale();
+
+    /// \brief Add color inversion
+    ofImageFilterChain& invert();
+
+    /// \brief Add gamma correction, see ofImageFilter::gamma() (ignored if <= 0)
+    ofImageFilterChain& gamma(float gamma);
+
+    /// \brief Add a threshold (0-255), see ofImageFilter::threshold()
+    ofImageFilterChain& threshold(int threshold);
+
+    // ========================================================================
+    // Neighborhood Filters (one pass each)
+    // ========================================================================
+
+    /// \brief Add a Gaussian blur, see ofImageFilter::blur()
+    ofImageFilterChain& blur(float radius);
+
+    /// \brief Add a box blur, see ofImageFilter::boxBlur()
+    ofImageFilterChain& boxBlur(int radius);
+
+    /// \brief Add unsharp mask sharpening, see ofImageFilter::sharpen()
+    ofImageFilterChain& sharpen(float amount, float radius = 1.0f);
+
+    /// \brief Add Sobel edge detection
+    ofImageFilterChain& sobel();
+
+    /// \brief Add dilation, see ofImageFilter::dilate()
+    ofImageFilterChain& dilate(int radius);
+
+    /// \brief Add erosion, see ofImageFilter::erode()
+    ofImageFilterChain& erode(int radius);
+
+    /// \brief Add a custom convolution, see ofImageFilter::convolve()
+    /// \details The kernel is copied.
+    ofImageFilterChain& convolve(const float* kernel, int kernelWidth, int kernelHeight,
+                                 float divisor = 0.0f);
+
+    /// \brief Add a median filter, see ofImageFilter::median()
+    ofImageFilterChain& median(int radius);
+
+    // ========================================================================
+    // Chain
+    // ========================================================================
+
+    /// \brief Remove all filters
+    void clear();
+
+    /// \brief Get the number of recorded filters
+    size_t getNumFilters() const;
+
+    /// \brief Get the number of passes over the image an apply() makes
+    size_t getNumPasses() const;
+
+    // ========================================================================
+    // Apply
+    // ========================================================================
+
+    /// \brief Apply the chain to pixels in place (CPU)
+    /// \return false if a filter failed (later filters are skipped)
+    bool apply(ofPixels& pixels);
+
+    /// \brief Apply the chain from one texture into another (GPU)
+    /// \details Recorded into the frame like the ofImageFilter texture
+    /// overloads: dst is allocated writable at the source size, and
+    /// intermediates between passes are textures the chain keeps for reuse.
+    /// Neighborhood filters have the GPU limits of ofImageFilter.
+    /// \param src Source texture (not a subsection)
+    /// \param dst Destination texture (not src)
+    /// \return false if a pass couldn't be recorded
+    bool apply(const ofTexture& src, ofTexture& dst);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
+
+// Global namespace alias for openFrameworks compatibility
+using ofImageFilterChain = oflike::ofImageFilterChain;
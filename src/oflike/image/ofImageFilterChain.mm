@@ -0,0 +1,508 @@
+// ofImageFilterChain.mm - recorded ofImageFilter sequences with fused passes
+
+#include "ofImageFilterChain.h"
+#include "ofImageFilter.h"
+#include "ofTexture.h"
+#include "../../core/Context.h"
+#include "../../render/DrawList.h"
+#include "../../render/DrawCommand.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace oflike {
+
+// ============================================================================
+// Filter Steps
+// ============================================================================
+
+namespace {
+
+enum class StepKind {
+    // Per-pixel
+    Brightness,
+    Contrast,
+    BrightnessContrast,
+    Saturation,
+    Invert,
+    Gamma,
+    Threshold,
+    // Neighborhood
+    Blur,
+    BoxBlur,
+    Sharpen,
+    Sobel,
+    Dilate,
+    Erode,
+    Convolve,
+    Median
+};
+
+struct Step {
+    StepKind kind;
+    float a = 0.0f;                 // Brightness, contrast, saturation, gamma, blur radius, amount
+    float b = 0.0f;                 // Contrast of BrightnessContrast, sharpen radius, divisor
+    int radius = 0;                 // Threshold value, integer radii
+    int kernelWidth = 0;
+    int kernelHeight = 0;
+    std::vector<float> kernel;      // Convolve
+};
+
+Step makeStep(StepKind kind, float a = 0.0f, float b = 0.0f) {
+    Step step;
+    step.kind = kind;
+    step.a = a;
+    step.b = b;
+    return step;
+}
+
+bool isPointStep(StepKind kind) {
+    return kind <= StepKind::Threshold;
+}
+
+unsigned char clampToByte(float value) {
+    return static_cast<unsigned char>(std::max(0.0f, std::min(255.0f, value)));
+}
+
+// Value of one channel after a per-channel step, with the arithmetic of the
+// matching ofImageFilter function
+unsigned char applyChannelStep(const Step& step, unsigned char v) {
+    switch (step.kind) {
+        case StepKind::Brightness:
+            return clampToByte(static_cast<float>(v + static_cast<int>(step.a)));
+        case StepKind::Contrast:
+            return clampToByte((static_cast<float>(v) - 128.0f) * step.a + 128.0f);
+        case StepKind::BrightnessContrast:
+            return clampToByte((static_cast<float>(v) - 128.0f) * step.b + 128.0f + step.a);
+        case StepKind::Invert:
+            return 255 - v;
+        case StepKind::Gamma:
+            return clampToByte(std::pow(static_cast<float>(v) / 255.0f, 1.0f / step.a) * 255.0f);
+        case StepKind::Threshold:
+            return v >= step.radius ? 255 : 0;
+        default:
+            return v;
+    }
+}
+
+// The GPU form of a per-pixel step, in [0, 1] units
+render::ImagePointStage pointStage(const Step& step) {
+    render::ImagePointStage stage;
+    switch (step.kind) {
+        case StepKind::Brightness:
+            stage.b = static_cast<float>(static_cast<int>(step.a)) / 255.0f;
+            break;
+        case StepKind::Contrast:
+            stage.a = step.a;
+            stage.b = 128.0f / 255.0f * (1.0f - step.a);
+            break;
+        case StepKind::BrightnessContrast:
+            stage.a = step.b;
+            stage.b = (128.0f * (1.0f - step.b) + step.a) / 255.0f;
+            break;
+        case StepKind::Saturation:
+            stage.op = render::ImagePointOp::Saturation;
+            stage.a = step.a;
+            break;
+        case StepKind::Invert:
+            stage.a = -1.0f;
+            stage.b = 1.0f;
+            break;
+        case StepKind::Gamma:
+            stage.op = render::ImagePointOp::Gamma;
+            stage.a = 1.0f / step.a;
+            break;
+        case StepKind::Threshold:
+            stage.op = render::ImagePointOp::Threshold;
+            stage.a = static_cast<float>(step.radius) / 255.0f;
+            break;
+        default:
+            break;
+    }
+    return stage;
+}
+
+// One operation of a fused CPU pass: a lookup table for any run of
+// per-channel steps, or a saturation mix
+struct PointOperation {
+    bool saturation = false;
+    float amount = 1.0f;
+    unsigned char lut[256];
+};
+
+} // namespace
+
+// ============================================================================
+// ofImageFilterChain::Impl
+// ============================================================================
+
+struct ofImageFilterChain::Impl {
+    std::vector<Step> steps;
+
+    // GPU intermediates between passes, alternated so a pass never reads
+    // the texture it writes
+    ofTexture intermediates[2];
+
+    // End of the run of per-pixel steps starting at begin
+    size_t pointRunEnd(size_t begin) const {
+        size_t end = begin;
+        while (end < steps.size() && isPointStep(steps[end].kind)) {
+            end++;
+        }
+        return end;
+    }
+
+    void add(Step step) {
+        steps.push_back(std::move(step));
+    }
+
+    bool applyPoints(ofPixels& pixels, size_t begin, size_t end) const;
+    bool applyNeighborhood(ofPixels& pixels, const Step& step) const;
+    bool recordPoints(const ofTexture& src, ofTexture& dst, size_t begin, size_t end) const;
+    bool recordNeighborhood(const ofTexture& src, ofTexture& dst, const Step& step) const;
+};
+
+bool ofImageFilterChain::Impl::applyPoints(ofPixels& pixels, size_t begin, size_t end) const {
+    const size_t channels = pixels.getNumChannels();
+
+    // Collapse consecutive per-channel steps into one table each
+    std::vector<PointOperation> operations;
+    for (size_t i = begin; i < end; i++) {
+        const Step& step = steps[i];
+        if (step.kind == StepKind::Saturation) {
+            if (channels >= 3) {  // Grayscale pixels are left alone
+                PointOperation operation;
+                operation.saturation = true;
+                operation.amount = step.a;
+                operations.push_back(operation);
+            }
+            continue;
+        }
+        if (operations.empty() || operations.back().saturation) {
+            PointOperation operation;
+            for (int v = 0; v < 256; v++) {
+                operation.lut[v] = static_cast<unsigned char>(v);
+            }
+            operations.push_back(operation);
+        }
+        unsigned char* lut = operations.back().lut;
+        for (int v = 0; v < 256; v++) {
+            lut[v] = applyChannelStep(step, lut[v]);
+        }
+    }
+    if (operations.empty()) {
+        return true;
+    }
+
+    // One pass: every operation per pixel while it is in registers
+    const size_t width = pixels.getWidth();
+    const size_t colorChannels = channels == 4 ? 3 : channels;  // Alpha is kept
+    for (size_t y = 0; y < pixels.getHeight(); y++) {
+        unsigned char* row = pixels.getRowData(y);
+        for (size_t x = 0; x < width; x++) {
+            unsigned char* pixel = row + x * channels;
+            for (const PointOperation& operation : operations) {
+                if (!operation.saturation) {
+                    for (size_t c = 0; c < colorChannels; c++) {
+                        pixel[c] = operation.lut[pixel[c]];
+                    }
+                    continue;
+                }
+                const float r = pixel[0];
+                const float g = pixel[1];
+                const float b = pixel[2];
+                const float gray = 0.299f * r + 0.587f * g + 0.114f * b;
+                pixel[0] = clampToByte(gray + operation.amount * (r - gray));
+                pixel[1] = clampToByte(gray + operation.amount * (g - gray));
+                pixel[2] = clampToByte(gray + operation.amount * (b - gray));
+            }
+        }
+    }
+    return true;
+}
+
+bool ofImageFilterChain::Impl::applyNeighborhood(ofPixels& pixels, const Step& step) const {
+    switch (step.kind) {
+        case StepKind::Blur:
+            return ofImageFilter::blur(pixels, step.a);
+        case StepKind::BoxBlur:
+            return ofImageFilter::boxBlur(pixels, step.radius);
+        case StepKind::Sharpen:
+            return ofImageFilter::sharpen(pixels, step.a, step.b);
+        case StepKind::Sobel:
+            return ofImageFilter::sobel(pixels);
+        case StepKind::Dilate:
+            return ofImageFilter::dilate(pixels, step.radius);
+        case StepKind::Erode:
+            return ofImageFilter::erode(pixels, step.radius);
+        case StepKind::Convolve:
+            return ofImageFilter::convolve(pixels, step.kernel.data(), step.kernelWidth,
+                                           step.kernelHeight, step.b);
+        case StepKind::Median:
+            return ofImageFilter::median(pixels, step.radius);
+        default:
+            return false;
+    }
+}
+
+bool ofImageFilterChain::Impl::recordPoints(const ofTexture& src, ofTexture& dst,
+                                            size_t begin, size_t end) const {
+    auto& ctx = Context::instance();
+    if (end - begin > render::FilterTextureCommand::kMaxPointStages || !src.isAllocated() ||
+        src.isSubsection() || !src.getNativeHandle() || !ctx.isInitialized()) {
+        return false;
+    }
+    if (!dst.allocateWritable(src.getWidth(), src.getHeight())) {
+        return false;
+    }
+
+    render::FilterTextureCommand cmd;
+    cmd.source = src.getNativeHandle();
+    cmd.destination = dst.getNativeHandle();
+    cmd.filter = render::ImageFilterType::Point;
+    for (size_t i = begin; i < end; i++) {
+        cmd.pointStages[cmd.pointStageCount++] = pointStage(steps[i]);
+    }
+    ctx.getDrawList().addCommand(cmd);
+    return true;
+}
+
+bool ofImageFilterChain::Impl::recordNeighborhood(const ofTexture& src, ofTexture& dst,
+                                                  const Step& step) const {
+    switch (step.kind) {
+        case StepKind::Blur:
+            return ofImageFilter::blur(src, dst, step.a);
+        case StepKind::BoxBlur:
+            return ofImageFilter::boxBlur(src, dst, step.radius);
+        case StepKind::Sharpen:
+            return ofImageFilter::sharpen(src, dst, step.a, step.b);
+        case StepKind::Sobel:
+            return ofImageFilter::sobel(src, dst);
+        case StepKind::Dilate:
+            return ofImageFilter::dilate(src, dst, step.radius);
+        case StepKind::Erode:
+            return ofImageFilter::erode(src, dst, step.radius);
+        case StepKind::Convolve:
+            return ofImageFilter::convolve(src, dst, step.kernel.data(), step.kernelWidth,
+                                           step.kernelHeight, step.b);
+        case StepKind::Median:
+            return ofImageFilter::median(src, dst, step.radius);
+        default:
+            return false;
+    }
+}
+
+// ============================================================================
+// Construction / Destruction
+// ============================================================================
+
+ofImageFilterChain::ofImageFilterChain()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ofImageFilterChain::~ofImageFilterChain() = default;
+
+ofImageFilterChain::ofImageFilterChain(ofImageFilterChain&& other) noexcept
+    : impl_(std::exchange(other.impl_, std::make_unique<Impl>())) {
+}
+
+ofImageFilterChain& ofImageFilterChain::operator=(ofImageFilterChain&& other) noexcept {
+    if (this != &other) {
+        impl_ = std::exchange(other.impl_, std::make_unique<Impl>());
+    }
+    return *this;
+}
+
+// ============================================================================
+// Per-Pixel Filters
+// ============================================================================
+
+ofImageFilterChain& ofImageFilterChain::brightness(float brightness) {
+    impl_->add(makeStep(StepKind::Brightness, brightness));
+    return *this;
+}
+
+ofImageFilterChain& ofImageFilterChain::contrast(float contrast) {
+    impl_->add(makeStep(StepKind::Contrast, contrast));
+    return *this;
+}
+
+ofImageFilterChain& ofImageFilterChain::brightnessContrast(float brightness, float contrast) {
+    impl_->add(makeStep(StepKind::BrightnessContrast, brightness, contrast));
+    return *this;
+}
+
+ofImageFilterChain& ofImageFilterChain::saturation(float saturation) {
+    impl_->add(makeStep(StepKind::Saturation, saturation));
+    return *this;
+}
+
+ofImageFilterChain& ofImageFilterChain::grayscale() {
+    return saturation(0.0f);
+}
+
+ofImageFilterChain& ofImageFilterChain::invert() {
+    impl_->add(makeStep(StepKind::Invert));
+    return *this;
+}
+
+ofImageFilterChain& ofImageFilterChain::gamma(float gamma) {
+    if (gamma > 0.0f) {
+        impl_->add(makeStep(StepKind::Gamma, gamma));
+    }
+    return *this;
+}
+
+ofImageFilterChain& ofImageFilterChain::threshold(int threshold) {
+    Step step = makeStep(StepKind::Threshold);
+    step.radius = std::max(0, std::min(255, threshold));
+    impl_->add(std::move(step));
+    return *this;
+}
+
+// ============================================================================
+// Neighborhood Filters
+// ============================================================================
+
+ofImageFilterChain& ofImageFilterChain::blur(float radius) {
+    impl_->add(makeStep(StepKind::Blur, radius));
+    return *this;
+}
+
+ofImageFilterChain& ofImageFilterChain::boxBlur(int radius) {
+    Step step = makeStep(StepKind::BoxBlur);
+    step.radius = radius;
+    impl_->add(std::move(step));
+    return *this;
+}
+
+ofImageFilterChain& ofImageFilterChain::sharpen(float amount, float radius) {
+    impl_->add(makeStep(StepKind::Sharpen, amount, radius));
+    return *this;
+}
+
+ofImageFilterChain& ofImageFilterChain::sobel() {
+    impl_->add(makeStep(StepKind::Sobel));
+    return *this;
+}
+
+ofImageFilterChain& ofImageFilterChain::dilate(int radius) {
+    Step step = makeStep(StepKind::Dilate);
+    step.radius = radius;
+    impl_->add(std::move(step));
+    return *this;
+}
+
+ofImageFilterChain& ofImageFilterChain::erode(int radius) {
+    Step step = makeStep(StepKind::Erode);
+    step.radius = radius;
+    impl_->add(std::move(step));
+    return *this;
+}
+
+ofImageFilterChain& ofImageFilterChain::convolve(const float* kernel, int kernelWidth, int kernelHeight,
+                                                 float divisor) {
+    Step step = makeStep(StepKind::Convolve);
+    step.b = divisor;
+    step.kernelWidth = kernelWidth;
+    step.kernelHeight = kernelHeight;
+    if (kernel && kernelWidth > 0 && kernelHeight > 0) {
+        step.kernel.assign(kernel, kernel + kernelWidth * kernelHeight);
+    }
+    impl_->add(std::move(step));
+    return *this;
+}
+
+ofImageFilterChain& ofImageFilterChain::median(int radius) {
+    Step step = makeStep(StepKind::Median);
+    step.radius = radius;
+    impl_->add(std::move(step));
+    return *this;
+}
+
+// ============================================================================
+// Chain
+// ============================================================================
+
+void ofImageFilterChain::clear() {
+    impl_->steps.clear();
+}
+
+size_t ofImageFilterChain::getNumFilters() const {
+    return impl_->steps.size();
+}
+
+size_t ofImageFilterChain::getNumPasses() const {
+    size_t passes = 0;
+    for (size_t i = 0; i < impl_->steps.size(); passes++) {
+        i = isPointStep(impl_->steps[i].kind) ? impl_->pointRunEnd(i) : i + 1;
+    }
+    return passes;
+}
+
+// ============================================================================
+// Apply
+// ============================================================================
+
+bool ofImageFilterChain::apply(ofPixels& pixels) {
+    if (!pixels.isAllocated()) {
+        return false;
+    }
+
+    const std::vector<Step>& steps = impl_->steps;
+    for (size_t i = 0; i < steps.size();) {
+        if (isPointStep(steps[i].kind)) {
+            const size_t end = impl_->pointRunEnd(i);
+            if (!impl_->applyPoints(pixels, i, end)) {
+                return false;
+            }
+            i = end;
+        } else {
+            if (!impl_->applyNeighborhood(pixels, steps[i])) {
+                return false;
+            }
+            i++;
+        }
+    }
+    return true;
+}
+
+bool ofImageFilterChain::apply(const ofTexture& src, ofTexture& dst) {
+    const std::vector<Step>& steps = impl_->steps;
+    if (&src == &dst || steps.empty()) {
+        return false;
+    }
+
+    // Passes as [begin, end) step ranges; a run of per-pixel steps longer
+    // than one kernel takes is split
+    struct Pass {
+        size_t begin;
+        size_t end;
+    };
+    std::vector<Pass> passes;
+    for (size_t i = 0; i < steps.size();) {
+        size_t end = i + 1;
+        if (isPointStep(steps[i].kind)) {
+            end = std::min(impl_->pointRunEnd(i), i + render::FilterTextureCommand::kMaxPointStages);
+        }
+        passes.push_back({i, end});
+        i = end;
+    }
+
+    const ofTexture* input = &src;
+    for (size_t p = 0; p < passes.size(); p++) {
+        ofTexture& output = p + 1 == passes.size() ? dst : impl_->intermediates[p % 2];
+        const Pass& pass = passes[p];
+        const bool recorded = isPointStep(steps[pass.begin].kind)
+            ? impl_->recordPoints(*input, output, pass.begin, pass.end)
+            : impl_->recordNeighborhood(*input, output, steps[pass.begin]);
+        if (!recorded) {
+            return false;
+        }
+        input = &output;
+    }
+    return true;
+}
+
+} // namespace oflike
@@ -0,0 +1,27 @@
+#pragma once
+
+// oflike-metal ofNoiseField - noise fields computed on the GPU
+// Fills a texture with the fractal noise ofNoiseField() computes on the CPU,
+// using the fillNoiseField kernel in shaders/Noise.metal
+
+#include "../math/ofNoise.h"
+
+namespace oflike {
+
+class ofTexture;
+
+/// \brief Fill a texture with a noise field on the GPU
+/// \details Texel (x, y) holds the value ofNoiseField() writes at index
+/// y * width + x, to float rounding, in RGB with alpha 1. Like the GPU
+/// ofImageFilter operations, the fill is recorded into the frame and runs
+/// when it renders, so drawing the texture afterwards in the same frame shows
+/// the new field. The texture is (re)allocated with allocateWritable() and
+/// holds RGBA8, which quantises the field to 1/255.
+/// \param dst Destination texture
+/// \param width Field width in texels
+/// \param height Field height in texels
+/// \param settings Noise type, coordinates and octaves
+/// \return false if the fill couldn't be recorded
+bool ofNoiseField(ofTexture& dst, int width, int height, const ofNoiseFieldSettings& settings = {});
+
+} // namespace oflike
@@ -0,0 +1,81 @@
+#import "ofNoiseField.h"
+#import "ofTexture.h"
+#import "../../core/Context.h"
+#import "../../render/DrawList.h"
+#import "../../render/DrawCommand.h"
+#import <algorithm>
+#import <cstring>
+
+namespace oflike {
+
+namespace {
+
+// Constants for the fillNoiseField kernel (matches NoiseFieldUniforms in Noise.metal)
+struct NoiseFieldUniforms {
+    uint32_t width;
+    uint32_t height;
+    uint32_t type;
+    uint32_t dimensions;
+    float originX;
+    float originY;
+    float frequency;
+    float z;
+    float w;
+    uint32_t octaves;
+    float lacunarity;
+    float gain;
+    float normalize;
+};
+
+static_assert(sizeof(NoiseFieldUniforms) <= render::DispatchComputeCommand::kMaxConstantsSize,
+              "NoiseFieldUniforms must fit in DispatchComputeCommand::constants");
+
+} // namespace
+
+bool ofNoiseField(ofTexture& dst, int width, int height, const ofNoiseFieldSettings& settings) {
+    auto& ctx = Context::instance();
+    auto* renderer = ctx.renderer();
+    if (width <= 0 || height <= 0 || !ctx.isInitialized() || !renderer) {
+        return false;
+    }
+
+    void* pipeline = renderer->getComputePipelineState("fillNoiseField");
+    if (!pipeline || !dst.allocateWritable(width, height)) {
+        return false;
+    }
+
+    NoiseFieldUniforms uniforms;
+    uniforms.width = static_cast<uint32_t>(width);
+    uniforms.height = static_cast<uint32_t>(height);
+    uniforms.type = settings.type == ofNoiseType::Perlin ? 1u : 0u;
+    uniforms.dimensions = static_cast<uint32_t>(std::min(std::max(settings.dimensions, 2), 4));
+    uniforms.originX = settings.originX;
+    uniforms.originY = settings.originY;
+    uniforms.frequency = settings.frequency;
+    uniforms.z = settings.z;
+    uniforms.w = settings.w;
+    uniforms.octaves = static_cast<uint32_t>(std::max(settings.octaves, 1));
+    uniforms.lacunarity = settings.lacunarity;
+    uniforms.gain = settings.gain;
+
+    // Same normalisation as the CPU field
+    float amplitudeSum = 0.0f;
+    float amplitude = 1.0f;
+    for (uint32_t octave = 0; octave < uniforms.octaves; ++octave) {
+        amplitudeSum += amplitude;
+        amplitude *= settings.gain;
+    }
+    uniforms.normalize = amplitudeSum > 0.0f ? 1.0f / amplitudeSum : 1.0f;
+
+    render::DispatchComputeCommand cmd;
+    cmd.pipelineState = pipeline;
+    cmd.textures[0] = dst.getNativeHandle();
+    cmd.textureCount = 1;
+    cmd.threadCount = uniforms.width * uniforms.height;
+    cmd.constantsSize = sizeof(NoiseFieldUniforms);
+    memcpy(cmd.constants, &uniforms, sizeof(NoiseFieldUniforms));
+    ctx.getDrawList().addCommand(cmd);
+    return true;
+}
+
+} // namespace oflike
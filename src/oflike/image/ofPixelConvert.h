@@ -0,0 +1,98 @@
+#pragma once
+
+// oflike-metal ofPixelConvert - channel layout conversions between pixel buffers
+// One vImage-backed path for the swizzles and expansions textures, video
+// frames and CV buffers need, with NEON fallbacks for layouts vImage lacks
+
+#include <cstddef>
+#include <cstdint>
+
+namespace oflike {
+
+/// \brief Channel layout conversions (RGB, RGBA, BGRA, gray) between buffers
+/// \details Every conversion takes row strides in bytes, so it reads and
+/// writes pixel buffers, ofPixelsView wraps and texture readbacks in place;
+/// a stride of 0 means tightly packed rows. Sources and destinations must
+/// not overlap, except for the swizzles marked in place.
+///
+/// Conversions run on vImage where it has the layout and on NEON (or plain
+/// loops) where it doesn't. Frames over about a megapixel are split into
+/// bands of rows converted in parallel on the global queue; smaller ones run
+/// on the calling thread.
+///
+/// Example:
+/// \code
+///     // BGRA camera frame into RGBA ofPixels
+///     CVPixelBufferLockBaseAddress(buffer, kCVPixelBufferLock_ReadOnly);
+///     pixels.allocate(w, h, 4);
+///     ofPixelConvert::bgraToRGBA(CVPixelBufferGetBaseAddress(buffer),
+///                                CVPixelBufferGetBytesPerRow(buffer),
+///                                pixels.getData(), pixels.getBytesStride(), w, h);
+///     CVPixelBufferUnlockBaseAddress(buffer, kCVPixelBufferLock_ReadOnly);
+/// \endcode
+class ofPixelConvert {
+public:
+    // ========================================================================
+    // Adding Alpha
+    // ========================================================================
+
+    /// \brief Expand RGB to RGBA with opaque alpha (255)
+    static void rgbToRGBA(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                          size_t width, size_t height);
+
+    /// \brief Expand 16-bit RGB to RGBA with opaque alpha (65535)
+    static void rgbToRGBA(const uint16_t* src, size_t srcStride, uint16_t* dst, size_t dstStride,
+                          size_t width, size_t height);
+
+    /// \brief Expand float RGB to RGBA with opaque alpha (1.0)
+    static void rgbToRGBA(const float* src, size_t srcStride, float* dst, size_t dstStride,
+                          size_t width, size_t height);
+
+    /// \brief Expand grayscale to gray RGBA with opaque alpha
+    static void grayToRGBA(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                           size_t width, size_t height);
+
+    /// \brief Expand grayscale + alpha to gray RGBA, keeping the alpha
+    static void grayAlphaToRGBA(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                                size_t width, size_t height);
+
+    // ========================================================================
+    // Dropping Alpha
+    // ========================================================================
+
+    /// \brief Drop the alpha of RGBA
+    static void rgbaToRGB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                          size_t width, size_t height);
+
+    /// \brief Drop the alpha of BGRA, swapping red and blue
+    static void bgraToRGB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                          size_t width, size_t height);
+
+    // ========================================================================
+    // Swizzles
+    // ========================================================================
+
+    /// \brief Swap red and blue of 4-channel pixels (BGRA to RGBA and back)
+    /// \details src and dst may be the same buffer with the same stride.
+    static void bgraToRGBA(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                           size_t width, size_t height);
+
+    /// \brief Same as bgraToRGBA(); swapping red and blue is its own inverse
+    static void rgbaToBGRA(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                           size_t width, size_t height) {
+        bgraToRGBA(src, srcStride, dst, dstStride, width, height);
+    }
+
+    // ========================================================================
+    // Copies
+    // ========================================================================
+
+    /// \brief Copy rows of rowBytes bytes between buffers of different strides
+    static void copyRows(const void* src, size_t srcStride, void* dst, size_t dstStride,
+                         size_t rowBytes, size_t height);
+};
+
+} // namespace oflike
+
+// Global namespace alias for openFrameworks compatibility
+using ofPixelConvert = oflike::ofPixelConvert;
@@ -0,0 +1,290 @@
+// ofPixelConvert.mm - channel layout conversions between pixel buffers
+
+#import "ofPixelConvert.h"
+#import <Accelerate/Accelerate.h>
+#import <dispatch/dispatch.h>
+#import <algorithm>
+#import <cstring>
+#import <type_traits>
+#if defined(__ARM_NEON)
+#import <arm_neon.h>
+#endif
+
+namespace oflike {
+
+namespace {
+
+// ============================================================================
+// Banding
+// ============================================================================
+
+// Frames of at least this many pixels are converted in parallel
+constexpr size_t kParallelPixels = 1024 * 1024;
+
+// Pixels per band of a parallel conversion
+constexpr size_t kBandPixels = 128 * 1024;
+
+/// Run body(y0, y1, flags) over bands of rows on the global queue; frames
+/// under kParallelPixels run on the calling thread. Bands pass
+/// kvImageDoNotTile so vImage doesn't split them again.
+template <typename Body>
+void ForEachBand(size_t width, size_t height, const Body& body) {
+    if (width == 0 || height == 0) {
+        return;
+    }
+    if (width * height < kParallelPixels) {
+        body(0, height, kvImageNoFlags);
+        return;
+    }
+    const size_t rowsPerBand = std::max<size_t>(1, kBandPixels / width);
+    const size_t bands = (height + rowsPerBand - 1) / rowsPerBand;
+    const Body* bandBody = &body;
+    dispatch_apply(bands, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t band) {
+        const size_t y0 = band * rowsPerBand;
+        (*bandBody)(y0, std::min(height, y0 + rowsPerBand), kvImageDoNotTile);
+    });
+}
+
+/// vImage buffer over rows [y0, y1) of a strided image
+vImage_Buffer Rows(const void* data, size_t stride, size_t width, size_t y0, size_t y1) {
+    return vImage_Buffer{
+        .data = const_cast<uint8_t*>(static_cast<const uint8_t*>(data) + y0 * stride),
+        .height = static_cast<vImagePixelCount>(y1 - y0),
+        .width = static_cast<vImagePixelCount>(width),
+        .rowBytes = stride
+    };
+}
+
+/// Row pointer of a strided image
+template <typename T>
+T* Row(T* data, size_t stride, size_t y) {
+    using Byte = std::conditional_t<std::is_const<T>::value, const uint8_t, uint8_t>;
+    return reinterpret_cast<T*>(reinterpret_cast<Byte*>(data) + y * stride);
+}
+
+// ============================================================================
+// Row Kernels
+// ============================================================================
+// Used where vImage has no conversion for the layout, and if it rejects a
+// buffer
+
+template <typename T>
+void ExpandRGBRows(const T* src, size_t srcStride, T* dst, size_t dstStride, size_t width,
+                   size_t y0, size_t y1, T alpha) {
+    for (size_t y = y0; y < y1; y++) {
+        const T* in = Row(src, srcStride, y);
+        T* out = Row(dst, dstStride, y);
+        for (size_t x = 0; x < width; x++) {
+            out[x * 4 + 0] = in[x * 3 + 0];
+            out[x * 4 + 1] = in[x * 3 + 1];
+            out[x * 4 + 2] = in[x * 3 + 2];
+            out[x * 4 + 3] = alpha;
+        }
+    }
+}
+
+// channels is 1 (gray) or 2 (gray + alpha)
+void ExpandGrayRows(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride, size_t width,
+                    size_t y0, size_t y1, size_t channels) {
+    for (size_t y = y0; y < y1; y++) {
+        const uint8_t* in = Row(src, srcStride, y);
+        uint8_t* out = Row(dst, dstStride, y);
+        size_t x = 0;
+#if defined(__ARM_NEON)
+        const uint8x16_t opaque = vdupq_n_u8(255);
+        for (; x + 16 <= width; x += 16) {
+            uint8x16x4_t rgba;
+            if (channels == 2) {
+                const uint8x16x2_t grayAlpha = vld2q_u8(in + x * 2);
+                rgba.val[0] = rgba.val[1] = rgba.val[2] = grayAlpha.val[0];
+                rgba.val[3] = grayAlpha.val[1];
+            } else {
+                rgba.val[0] = rgba.val[1] = rgba.val[2] = vld1q_u8(in + x);
+                rgba.val[3] = opaque;
+            }
+            vst4q_u8(out + x * 4, rgba);
+        }
+#endif
+        for (; x < width; x++) {
+            const uint8_t v = in[x * channels];
+            out[x * 4 + 0] = out[x * 4 + 1] = out[x * 4 + 2] = v;
+            out[x * 4 + 3] = channels == 2 ? in[x * 2 + 1] : 255;
+        }
+    }
+}
+
+// Four channels to three, optionally swapping red and blue (BGRA to RGB)
+void DropAlphaRows(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride, size_t width,
+                   size_t y0, size_t y1, bool swapRedBlue) {
+    const size_t r = swapRedBlue ? 2 : 0;
+    const size_t b = swapRedBlue ? 0 : 2;
+    for (size_t y = y0; y < y1; y++) {
+        const uint8_t* in = Row(src, srcStride, y);
+        uint8_t* out = Row(dst, dstStride, y);
+        for (size_t x = 0; x < width; x++) {
+            out[x * 3 + 0] = in[x * 4 + r];
+            out[x * 3 + 1] = in[x * 4 + 1];
+            out[x * 3 + 2] = in[x * 4 + b];
+        }
+    }
+}
+
+void SwapRedBlueRows(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride, size_t width,
+                     size_t y0, size_t y1) {
+    for (size_t y = y0; y < y1; y++) {
+        const uint8_t* in = Row(src, srcStride, y);
+        uint8_t* out = Row(dst, dstStride, y);
+        for (size_t x = 0; x < width; x++) {
+            const uint8_t red = in[x * 4 + 2];
+            const uint8_t blue = in[x * 4 + 0];
+            out[x * 4 + 0] = red;
+            out[x * 4 + 1] = in[x * 4 + 1];
+            out[x * 4 + 2] = blue;
+            out[x * 4 + 3] = in[x * 4 + 3];
+        }
+    }
+}
+
+size_t StrideOr(size_t stride, size_t packed) {
+    return stride != 0 ? stride : packed;
+}
+
+} // namespace
+
+// ============================================================================
+// Adding Alpha
+// ============================================================================
+
+void ofPixelConvert::rgbToRGBA(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                               size_t width, size_t height) {
+    srcStride = StrideOr(srcStride, width * 3);
+    dstStride = StrideOr(dstStride, width * 4);
+    ForEachBand(width, height, [&](size_t y0, size_t y1, vImage_Flags flags) {
+        vImage_Buffer in = Rows(src, srcStride, width, y0, y1);
+        vImage_Buffer out = Rows(dst, dstStride, width, y0, y1);
+        if (vImageConvert_RGB888toRGBA8888(&in, nullptr, 255, &out, false, flags) != kvImageNoError) {
+            ExpandRGBRows<uint8_t>(src, srcStride, dst, dstStride, width, y0, y1, 255);
+        }
+    });
+}
+
+void ofPixelConvert::rgbToRGBA(const uint16_t* src, size_t srcStride, uint16_t* dst, size_t dstStride,
+                               size_t width, size_t height) {
+    srcStride = StrideOr(srcStride, width * 3 * sizeof(uint16_t));
+    dstStride = StrideOr(dstStride, width * 4 * sizeof(uint16_t));
+    ForEachBand(width, height, [&](size_t y0, size_t y1, vImage_Flags flags) {
+        vImage_Buffer in = Rows(src, srcStride, width, y0, y1);
+        vImage_Buffer out = Rows(dst, dstStride, width, y0, y1);
+        if (vImageConvert_RGB16UtoRGBA16U(&in, nullptr, 65535, &out, false, flags) != kvImageNoError) {
+            ExpandRGBRows<uint16_t>(src, srcStride, dst, dstStride, width, y0, y1, 65535);
+        }
+    });
+}
+
+void ofPixelConvert::rgbToRGBA(const float* src, size_t srcStride, float* dst, size_t dstStride,
+                               size_t width, size_t height) {
+    srcStride = StrideOr(srcStride, width * 3 * sizeof(float));
+    dstStride = StrideOr(dstStride, width * 4 * sizeof(float));
+    ForEachBand(width, height, [&](size_t y0, size_t y1, vImage_Flags flags) {
+        vImage_Buffer in = Rows(src, srcStride, width, y0, y1);
+        vImage_Buffer out = Rows(dst, dstStride, width, y0, y1);
+        if (vImageConvert_RGBFFFtoRGBAFFFF(&in, nullptr, 1.0f, &out, false, flags) != kvImageNoError) {
+            ExpandRGBRows<float>(src, srcStride, dst, dstStride, width, y0, y1, 1.0f);
+        }
+    });
+}
+
+void ofPixelConvert::grayToRGBA(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                                size_t width, size_t height) {
+    srcStride = StrideOr(srcStride, width);
+    dstStride = StrideOr(dstStride, width * 4);
+    ForEachBand(width, height, [&](size_t y0, size_t y1, vImage_Flags flags) {
+        // BGRX with the gray plane as all three colors is gray RGBA
+        vImage_Buffer in = Rows(src, srcStride, width, y0, y1);
+        vImage_Buffer out = Rows(dst, dstStride, width, y0, y1);
+        if (vImageConvert_Planar8ToBGRX8888(&in, &in, &in, 255, &out, flags) != kvImageNoError) {
+            ExpandGrayRows(src, srcStride, dst, dstStride, width, y0, y1, 1);
+        }
+    });
+}
+
+void ofPixelConvert::grayAlphaToRGBA(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                                     size_t width, size_t height) {
+    // vImage has no two-channel interleaved expansion
+    srcStride = StrideOr(srcStride, width * 2);
+    dstStride = StrideOr(dstStride, width * 4);
+    ForEachBand(width, height, [&](size_t y0, size_t y1, vImage_Flags) {
+        ExpandGrayRows(src, srcStride, dst, dstStride, width, y0, y1, 2);
+    });
+}
+
+// ============================================================================
+// Dropping Alpha
+// ============================================================================
+
+void ofPixelConvert::rgbaToRGB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                               size_t width, size_t height) {
+    srcStride = StrideOr(srcStride, width * 4);
+    dstStride = StrideOr(dstStride, width * 3);
+    ForEachBand(width, height, [&](size_t y0, size_t y1, vImage_Flags flags) {
+        vImage_Buffer in = Rows(src, srcStride, width, y0, y1);
+        vImage_Buffer out = Rows(dst, dstStride, width, y0, y1);
+        if (vImageConvert_RGBA8888toRGB888(&in, &out, flags) != kvImageNoError) {
+            DropAlphaRows(src, srcStride, dst, dstStride, width, y0, y1, false);
+        }
+    });
+}
+
+void ofPixelConvert::bgraToRGB(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                               size_t width, size_t height) {
+    srcStride = StrideOr(srcStride, width * 4);
+    dstStride = StrideOr(dstStride, width * 3);
+    ForEachBand(width, height, [&](size_t y0, size_t y1, vImage_Flags flags) {
+        vImage_Buffer in = Rows(src, srcStride, width, y0, y1);
+        vImage_Buffer out = Rows(dst, dstStride, width, y0, y1);
+        if (vImageConvert_BGRA8888toRGB888(&in, &out, flags) != kvImageNoError) {
+            DropAlphaRows(src, srcStride, dst, dstStride, width, y0, y1, true);
+        }
+    });
+}
+
+// ============================================================================
+// Swizzles
+// ============================================================================
+
+void ofPixelConvert::bgraToRGBA(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride,
+                                size_t width, size_t height) {
+    srcStride = StrideOr(srcStride, width * 4);
+    dstStride = StrideOr(dstStride, width * 4);
+    ForEachBand(width, height, [&](size_t y0, size_t y1, vImage_Flags flags) {
+        static const uint8_t kSwapRedBlue[4] = {2, 1, 0, 3};
+        vImage_Buffer in = Rows(src, srcStride, width, y0, y1);
+        vImage_Buffer out = Rows(dst, dstStride, width, y0, y1);
+        if (vImagePermuteChannels_ARGB8888(&in, &out, kSwapRedBlue, flags) != kvImageNoError) {
+            SwapRedBlueRows(src, srcStride, dst, dstStride, width, y0, y1);
+        }
+    });
+}
+
+// ============================================================================
+// Copies
+// ============================================================================
+
+void ofPixelConvert::copyRows(const void* src, size_t srcStride, void* dst, size_t dstStride,
+                              size_t rowBytes, size_t height) {
+    srcStride = StrideOr(srcStride, rowBytes);
+    dstStride = StrideOr(dstStride, rowBytes);
+    if (srcStride == rowBytes && dstStride == rowBytes) {
+        std::memcpy(dst, src, rowBytes * height);
+        return;
+    }
+    // Bands are sized in bytes here: one "pixel" per byte
+    ForEachBand(rowBytes, height, [&](size_t y0, size_t y1, vImage_Flags) {
+        for (size_t y = y0; y < y1; y++) {
+            std::memcpy(Row(static_cast<uint8_t*>(dst), dstStride, y),
+                        Row(static_cast<const uint8_t*>(src), srcStride, y), rowBytes);
+        }
+    });
+}
+
+} // namespace oflike
@@ -19,7 +19,10 @@ enum ofImageType {
 
 /// \brief Template pixel buffer class for storing and manipulating image data
 /// \details ofPixels_ provides openFrameworks-compatible pixel buffer operations
-/// using a template for different pixel types (uint8_t, uint16_t, float)
+/// using a template for different pixel types (uint8_t, uint16_t, float).
+/// Allocated pixels are tightly packed; external pixels may have padded rows
+/// (getBytesStride()), so views over camera frames and GPU buffers need no
+/// copy. Copies of padded pixels are tightly packed.
 template<typename PixelType>
 class ofPixels_ {
 public:
@@ -33,6 +36,7 @@ public:
         , width_(0)
         , height_(0)
         , channels_(0)
+        , bytesStride_(0)
         , pixelsOwner_(true)
         , bAllocated_(false) {}
 
@@ -47,6 +51,7 @@ public:
         width_ = mom.width_;
         height_ = mom.height_;
         channels_ = mom.channels_;
+        bytesStride_ = mom.bytesStride_;
         pixelsOwner_ = mom.pixelsOwner_;
         bAllocated_ = mom.bAllocated_;
 
@@ -54,6 +59,7 @@ public:
         mom.width_ = 0;
         mom.height_ = 0;
         mom.channels_ = 0;
+        mom.bytesStride_ = 0;
         mom.pixelsOwner_ = false;
         mom.bAllocated_ = false;
     }
@@ -83,6 +89,7 @@ public:
             width_ = mom.width_;
             height_ = mom.height_;
             channels_ = mom.channels_;
+            bytesStride_ = mom.bytesStride_;
             pixelsOwner_ = mom.pixelsOwner_;
             bAllocated_ = mom.bAllocated_;
 
@@ -90,6 +97,7 @@ public:
             mom.width_ = 0;
             mom.height_ = 0;
             mom.channels_ = 0;
+            mom.bytesStride_ = 0;
             mom.pixelsOwner_ = false;
             mom.bAllocated_ = false;
         }
@@ -105,7 +113,8 @@ public:
     /// \param h Height in pixels
     /// \param channels Number of channels (1=grayscale, 3=RGB, 4=RGBA)
     void allocate(size_t w, size_t h, size_t channels) {
-        if (w == width_ && h == height_ && channels == channels_ && bAllocated_) {
+        if (w == width_ && h == height_ && channels == channels_ && bAllocated_ && pixelsOwner_ &&
+            isContiguous()) {
             return;  // Already allocated with same dimensions
         }
 
@@ -114,6 +123,7 @@ public:
         width_ = w;
         height_ = h;
         channels_ = channels;
+        bytesStride_ = w * channels * sizeof(PixelType);
 
         if (width_ > 0 && height_ > 0 && channels_ > 0) {
             const size_t totalSize = width_ * height_ * channels_;
@@ -138,6 +148,7 @@ public:
         width_ = 0;
         height_ = 0;
         channels_ = 0;
+        bytesStride_ = 0;
         pixelsOwner_ = false;
         bAllocated_ = false;
     }
@@ -161,6 +172,21 @@ public:
         return pixels_;
     }
 
+    /// \brief Get pointer to the first pixel of row y
+    PixelType* getRowData(size_t y) {
+        return reinterpret_cast<PixelType*>(reinterpret_cast<uint8_t*>(pixels_) + y * bytesStride_);
+    }
+
+    /// \brief Get const pointer to the first pixel of row y
+    const PixelType* getRowData(size_t y) const {
+        return reinterpret_cast<const PixelType*>(reinterpret_cast<const uint8_t*>(pixels_) + y * bytesStride_);
+    }
+
+    /// \brief Check if the pixels wrap memory they don't own
+    bool isExternal() const {
+        return bAllocated_ && !pixelsOwner_;
+    }
+
     /// \brief Get pixel value at index
     PixelType& operator[](size_t pos) {
         return pixels_[pos];
@@ -200,14 +226,26 @@ public:
         return sizeof(PixelType);
     }
 
+    /// \brief Get the distance between the starts of consecutive rows in bytes
+    /// \details getWidth() * getBytesPerPixel() unless the pixels wrap
+    /// external memory with padded rows.
+    size_t getBytesStride() const {
+        return bytesStride_;
+    }
+
+    /// \brief Check if rows are tightly packed (no padding between them)
+    bool isContiguous() const {
+        return bytesStride_ == width_ * channels_ * sizeof(PixelType);
+    }
+
     /// \brief Get total number of pixels
     size_t size() const {
         return width_ * height_;
     }
 
-    /// \brief Get total size in bytes
+    /// \brief Get total size in bytes, including any row padding
     size_t getTotalBytes() const {
-        return width_ * height_ * channels_ * sizeof(PixelType);
+        return bytesStride_ * height_;
     }
 
     // ========================================================================
@@ -215,8 +253,9 @@ public:
     // ========================================================================
 
     /// \brief Get index for pixel at (x, y)
+    /// \details Counts elements from getData(), row padding included.
     size_t getPixelIndex(size_t x, size_t y) const {
-        return (y * width_ + x) * channels_;
+        return y * (bytesStride_ / sizeof(PixelType)) + x * channels_;
     }
 
     /// \brief Get color at pixel (x, y)
@@ -306,11 +345,25 @@ public:
 
     /// \brief Use external pixel data (does not copy, does not own memory)
     void setFromExternalPixels(PixelType* newPixels, size_t w, size_t h, size_t channels) {
+        setFromExternalPixels(newPixels, w, h, channels, w * channels * sizeof(PixelType));
+    }
+
+    /// \brief Use external pixel data with padded rows (does not copy, does not own memory)
+    /// \details The memory must stay valid while the pixels refer to it.
+    /// \param newPixels First pixel of the first row
+    /// \param w Width in pixels
+    /// \param h Height in pixels
+    /// \param channels Number of channels
+    /// \param bytesStride Distance between row starts in bytes (at least
+    ///        w * channels * sizeof(PixelType), a multiple of sizeof(PixelType))
+    void setFromExternalPixels(PixelType* newPixels, size_t w, size_t h, size_t channels,
+                               size_t bytesStride) {
         clear();
         pixels_ = newPixels;
         width_ = w;
         height_ = h;
         channels_ = channels;
+        bytesStride_ = std::max(bytesStride, w * channels * sizeof(PixelType));
         pixelsOwner_ = false;  // Don't own this memory
         bAllocated_ = true;
     }
@@ -319,9 +372,11 @@ public:
     void swapRgb() {
         if (!pixels_ || channels_ < 3) return;
 
-        for (size_t i = 0; i < width_ * height_; ++i) {
-            const size_t idx = i * channels_;
-            std::swap(pixels_[idx], pixels_[idx + 2]);  // Swap R and B
+        for (size_t y = 0; y < height_; ++y) {
+            PixelType* row = getRowData(y);
+            for (size_t x = 0; x < width_; ++x) {
+                std::swap(row[x * channels_], row[x * channels_ + 2]);  // Swap R and B
+            }
         }
     }
 
@@ -361,7 +416,15 @@ private:
         if (mom.isAllocated()) {
             allocate(mom.width_, mom.height_, mom.channels_);
             if (pixels_ && mom.pixels_) {
-                std::memcpy(pixels_, mom.pixels_, getTotalBytes());
+                if (mom.isContiguous()) {
+                    std::memcpy(pixels_, mom.pixels_, getTotalBytes());
+                } else {
+                    // Pack padded rows
+                    const size_t rowBytes = width_ * channels_ * sizeof(PixelType);
+                    for (size_t y = 0; y < height_; ++y) {
+                        std::memcpy(getRowData(y), mom.getRowData(y), rowBytes);
+                    }
+                }
             }
         } else {
             clear();
@@ -376,6 +439,7 @@ private:
     size_t width_;           ///< Width in pixels
     size_t height_;          ///< Height in pixels
     size_t channels_;        ///< Number of channels (1, 3, or 4)
+    size_t bytesStride_;     ///< Bytes between row starts
     bool pixelsOwner_;       ///< True if we own the pixel memory
     bool bAllocated_;        ///< True if pixels are allocated
 };
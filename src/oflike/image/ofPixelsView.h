@@ -0,0 +1,111 @@
+#pragma once
+
+// oflike-metal ofPixelsView - non-owning ofPixels over system image buffers
+// Wraps a CVPixelBuffer, an IOSurface or a shared MTLBuffer in place, so
+// camera frames, Core ML outputs and GPU readbacks can be filtered, uploaded
+// or handed to OpenCV without copying them first
+
+#include <memory>
+#include <cstddef>
+#include "ofPixels.h"
+
+namespace oflike {
+
+/// \brief Zero-copy ofPixels view of a CVPixelBuffer, IOSurface or MTLBuffer
+/// \details The view keeps its source alive (retained) and, for pixel buffers
+/// and surfaces, locked for CPU access until release() or destruction.
+/// getPixels() refers to the source memory directly with the source's row
+/// stride, so writes through it (ofImageFilter, setColor()) change the
+/// source. Copies of the pixels (ofImage::setFromPixels(), assignment) are
+/// tightly packed and independent of the source.
+///
+/// Supported layouts are 8 bits per channel:
+/// - OneComponent8 (1 channel), TwoComponent8 (2), 24RGB (3), 32RGBA (4)
+/// - 32BGRA (4): left in BGRA order, see isBGRA()
+/// - Bi-planar 4:2:0 YCbCr (camera frames): plane 0 is luma (1 channel),
+///   plane 1 is interleaved chroma at half size (2 channels)
+///
+/// Example:
+/// \code
+///     ofPixelsView view;
+///     if (view.wrapPixelBuffer(pixelBuffer)) {
+///         ofImageFilter::blur(view.getPixels(), 4.0f);  // In place
+///         texture.loadData(view.getPixels());           // Strided upload
+///     }
+/// \endcode
+class ofPixelsView {
+public:
+    // ========================================================================
+    // Construction / Destruction
+    // ========================================================================
+
+    ofPixelsView();
+    ~ofPixelsView();
+
+    ofPixelsView(ofPixelsView&& other) noexcept;
+    ofPixelsView& operator=(ofPixelsView&& other) noexcept;
+
+    ofPixelsView(const ofPixelsView&) = delete;
+    ofPixelsView& operator=(const ofPixelsView&) = delete;
+
+    // ========================================================================
+    // Wrapping
+    // ========================================================================
+
+    /// \brief View a plane of a CVPixelBuffer
+    /// \param pixelBuffer CVPixelBufferRef; retained and locked by the view
+    /// \param plane Plane index for planar buffers (ignored otherwise)
+    /// \return False if the format is unsupported or the buffer can't be
+    ///         locked (the view is left empty)
+    bool wrapPixelBuffer(void* pixelBuffer, size_t plane = 0);
+
+    /// \brief View a plane of an IOSurface
+    /// \param surface IOSurfaceRef; retained and locked by the view
+    /// \param plane Plane index for planar surfaces (ignored otherwise)
+    /// \return False if the format is unsupported or the surface can't be
+    ///         locked (the view is left empty)
+    bool wrapIOSurface(void* surface, size_t plane = 0);
+
+    /// \brief View 8-bit pixels in an MTLBuffer
+    /// \details The buffer must use shared storage. The GPU must not be
+    /// writing the region while the view is read, e.g. wait for the command
+    /// buffer that filled it.
+    /// \param buffer id<MTLBuffer>; retained by the view
+    /// \param offset Byte offset of the first pixel
+    /// \param width Width in pixels
+    /// \param height Height in pixels
+    /// \param channels Channels per pixel (1-4)
+    /// \param bytesPerRow Distance between row starts (0 = tightly packed)
+    /// \return False if the buffer isn't shared or the region doesn't fit
+    bool wrapBuffer(void* buffer, size_t offset, size_t width, size_t height,
+                    size_t channels, size_t bytesPerRow = 0);
+
+    /// \brief Unlock and release the source; the pixels become unallocated
+    void release();
+
+    // ========================================================================
+    // Access
+    // ========================================================================
+
+    /// \brief Check if the view refers to a source
+    bool isValid() const;
+
+    /// \brief Get the pixels over the source memory
+    ofPixels& getPixels();
+
+    /// \brief Get the pixels over the source memory
+    const ofPixels& getPixels() const;
+
+    /// \brief Check if 4-channel pixels are in BGRA order (32BGRA sources)
+    /// \details Call getPixels().swapRgb() to reorder them in place.
+    bool isBGRA() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
+
+// Global namespace alias for openFrameworks compatibility
+using ofPixelsView = oflike::ofPixelsView;
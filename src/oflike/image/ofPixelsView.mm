@@ -0,0 +1,254 @@
+// ofPixelsView.mm - non-owning ofPixels over system image buffers
+
+#import <Metal/Metal.h>
+#import <CoreVideo/CoreVideo.h>
+#import <IOSurface/IOSurface.h>
+#include "ofPixelsView.h"
+#include <utility>
+
+namespace oflike {
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+namespace {
+
+// Channels of one plane of an 8-bit pixel format, 0 if unsupported
+size_t ChannelsOfPlane(OSType format, bool planar, size_t plane, bool& bgra) {
+    bgra = false;
+    if (planar) {
+        switch (format) {
+            case kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange:
+            case kCVPixelFormatType_420YpCbCr8BiPlanarFullRange:
+                return plane == 0 ? 1 : (plane == 1 ? 2 : 0);
+            default:
+                return 0;
+        }
+    }
+    switch (format) {
+        case kCVPixelFormatType_OneComponent8:
+            return 1;
+        case kCVPixelFormatType_TwoComponent8:
+            return 2;
+        case kCVPixelFormatType_24RGB:
+            return 3;
+        case kCVPixelFormatType_32RGBA:
+            return 4;
+        case kCVPixelFormatType_32BGRA:
+            bgra = true;
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// ofPixelsView::Impl
+// ============================================================================
+
+struct ofPixelsView::Impl {
+    enum class Source { None, PixelBuffer, Surface, Buffer };
+
+    ofPixels pixels;
+    Source source = Source::None;
+    CVPixelBufferRef pixelBuffer = nullptr;
+    IOSurfaceRef surface = nullptr;
+    id<MTLBuffer> buffer = nil;
+    bool bgra = false;
+
+    ~Impl() {
+        release();
+    }
+
+    void release() {
+        pixels.clear();
+        switch (source) {
+            case Source::PixelBuffer:
+                CVPixelBufferUnlockBaseAddress(pixelBuffer, 0);
+                CVPixelBufferRelease(pixelBuffer);
+                break;
+            case Source::Surface:
+                IOSurfaceUnlock(surface, 0, nullptr);
+                CFRelease(surface);
+                break;
+            case Source::Buffer:
+            case Source::None:
+                break;
+        }
+        pixelBuffer = nullptr;
+        surface = nullptr;
+        buffer = nil;
+        bgra = false;
+        source = Source::None;
+    }
+};
+
+// ============================================================================
+// Construction / Destruction
+// ============================================================================
+
+ofPixelsView::ofPixelsView()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ofPixelsView::~ofPixelsView() = default;
+
+ofPixelsView::ofPixelsView(ofPixelsView&& other) noexcept
+    : impl_(std::exchange(other.impl_, std::make_unique<Impl>())) {
+}
+
+ofPixelsView& ofPixelsView::operator=(ofPixelsView&& other) noexcept {
+    if (this != &other) {
+        impl_ = std::exchange(other.impl_, std::make_unique<Impl>());
+    }
+    return *this;
+}
+
+// ============================================================================
+// Wrapping
+// ============================================================================
+
+bool ofPixelsView::wrapPixelBuffer(void* pixelBuffer, size_t plane) {
+    impl_->release();
+    if (!pixelBuffer) {
+        return false;
+    }
+
+    CVPixelBufferRef cvPixelBuffer = static_cast<CVPixelBufferRef>(pixelBuffer);
+    const bool planar = CVPixelBufferIsPlanar(cvPixelBuffer);
+    if (planar && plane >= CVPixelBufferGetPlaneCount(cvPixelBuffer)) {
+        return false;
+    }
+
+    bool bgra = false;
+    const size_t channels = ChannelsOfPlane(CVPixelBufferGetPixelFormatType(cvPixelBuffer),
+                                            planar, plane, bgra);
+    if (channels == 0 || CVPixelBufferLockBaseAddress(cvPixelBuffer, 0) != kCVReturnSuccess) {
+        return false;
+    }
+
+    void* base = planar ? CVPixelBufferGetBaseAddressOfPlane(cvPixelBuffer, plane)
+                        : CVPixelBufferGetBaseAddress(cvPixelBuffer);
+    if (!base) {
+        CVPixelBufferUnlockBaseAddress(cvPixelBuffer, 0);
+        return false;
+    }
+
+    impl_->source = Impl::Source::PixelBuffer;
+    impl_->pixelBuffer = CVPixelBufferRetain(cvPixelBuffer);
+    impl_->bgra = bgra;
+    if (planar) {
+        impl_->pixels.setFromExternalPixels(static_cast<unsigned char*>(base),
+                                            CVPixelBufferGetWidthOfPlane(cvPixelBuffer, plane),
+                                            CVPixelBufferGetHeightOfPlane(cvPixelBuffer, plane),
+                                            channels,
+                                            CVPixelBufferGetBytesPerRowOfPlane(cvPixelBuffer, plane));
+    } else {
+        impl_->pixels.setFromExternalPixels(static_cast<unsigned char*>(base),
+                                            CVPixelBufferGetWidth(cvPixelBuffer),
+                                            CVPixelBufferGetHeight(cvPixelBuffer),
+                                            channels,
+                                            CVPixelBufferGetBytesPerRow(cvPixelBuffer));
+    }
+    return true;
+}
+
+bool ofPixelsView::wrapIOSurface(void* surface, size_t plane) {
+    impl_->release();
+    if (!surface) {
+        return false;
+    }
+
+    IOSurfaceRef ioSurface = static_cast<IOSurfaceRef>(surface);
+    const bool planar = IOSurfaceGetPlaneCount(ioSurface) > 0;
+    if (planar && plane >= IOSurfaceGetPlaneCount(ioSurface)) {
+        return false;
+    }
+
+    bool bgra = false;
+    const size_t channels = ChannelsOfPlane(IOSurfaceGetPixelFormat(ioSurface), planar, plane, bgra);
+    if (channels == 0 || IOSurfaceLock(ioSurface, 0, nullptr) != kIOReturnSuccess) {
+        return false;
+    }
+
+    void* base = planar ? IOSurfaceGetBaseAddressOfPlane(ioSurface, plane)
+                        : IOSurfaceGetBaseAddress(ioSurface);
+    if (!base) {
+        IOSurfaceUnlock(ioSurface, 0, nullptr);
+        return false;
+    }
+
+    impl_->source = Impl::Source::Surface;
+    impl_->surface = static_cast<IOSurfaceRef>(CFRetain(ioSurface));
+    impl_->bgra = bgra;
+    if (planar) {
+        impl_->pixels.setFromExternalPixels(static_cast<unsigned char*>(base),
+                                            IOSurfaceGetWidthOfPlane(ioSurface, plane),
+                                            IOSurfaceGetHeightOfPlane(ioSurface, plane),
+                                            channels,
+                                            IOSurfaceGetBytesPerRowOfPlane(ioSurface, plane));
+    } else {
+        impl_->pixels.setFromExternalPixels(static_cast<unsigned char*>(base),
+                                            IOSurfaceGetWidth(ioSurface),
+                                            IOSurfaceGetHeight(ioSurface),
+                                            channels,
+                                            IOSurfaceGetBytesPerRow(ioSurface));
+    }
+    return true;
+}
+
+bool ofPixelsView::wrapBuffer(void* buffer, size_t offset, size_t width, size_t height,
+                              size_t channels, size_t bytesPerRow) {
+    impl_->release();
+    if (!buffer || width == 0 || height == 0 || channels < 1 || channels > 4) {
+        return false;
+    }
+
+    id<MTLBuffer> mtlBuffer = (__bridge id<MTLBuffer>)buffer;
+    if (mtlBuffer.storageMode != MTLStorageModeShared) {
+        return false;
+    }
+
+    const size_t rowBytes = width * channels;
+    if (bytesPerRow == 0) {
+        bytesPerRow = rowBytes;
+    }
+    if (bytesPerRow < rowBytes || offset + bytesPerRow * (height - 1) + rowBytes > mtlBuffer.length) {
+        return false;
+    }
+
+    impl_->source = Impl::Source::Buffer;
+    impl_->buffer = mtlBuffer;
+    impl_->pixels.setFromExternalPixels(static_cast<unsigned char*>([mtlBuffer contents]) + offset,
+                                        width, height, channels, bytesPerRow);
+    return true;
+}
+
+void ofPixelsView::release() {
+    impl_->release();
+}
+
+// ============================================================================
+// Access
+// ============================================================================
+
+bool ofPixelsView::isValid() const {
+    return impl_->source != Impl::Source::None;
+}
+
+ofPixels& ofPixelsView::getPixels() {
+    return impl_->pixels;
+}
+
+const ofPixels& ofPixelsView::getPixels() const {
+    return impl_->pixels;
+}
+
+bool ofPixelsView::isBGRA() const {
+    return impl_->bgra;
+}
+
+} // namespace oflike
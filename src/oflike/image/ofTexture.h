@@ -3,6 +3,8 @@
 // oflike-metal ofTexture - openFrameworks API compatible texture
 // Provides GPU texture storage and rendering
 
+#include <cstdint>
+#include <future>
 #include <memory>
 #include <string>
 #include "ofPixels.h"
@@ -90,6 +92,19 @@ public:
     /// \param pix ofPixels to match dimensions and format
     void allocate(const ofPixels& pix);
 
+    /// \brief Allocate an RGBA texture that GPU filters can write
+    /// \details Creates the texture immediately (uninitialized). Used as the
+    /// destination of the ofImageFilter texture overloads; it draws and
+    /// accepts loadData() like any other texture. Keeps the current texture
+    /// if it is already writable and of this size.
+    /// \param w Width in pixels
+    /// \param h Height in pixels
+    /// \return false if the texture couldn't be created
+    bool allocateWritable(int w, int h);
+
+    /// \brief Check if GPU filters can write the texture (see allocateWritable())
+    bool isWritable() const;
+
     /// \brief Check if texture is allocated
     /// \return true if texture has been allocated, false otherwise
     bool isAllocated() const;
@@ -102,31 +117,127 @@ public:
     // ========================================================================
 
     /// \brief Upload pixel data to texture
+    /// \details Grayscale and grayscale + alpha pixels are stored as one and
+    /// two channel textures that sample as gray; RGB is expanded to RGBA.
     /// \param pix Pixel data to upload
     void loadData(const ofPixels& pix);
 
     /// \brief Upload pixel data to texture (16-bit)
+    /// \details Stored as a 16-bit normalized texture with the pixels' channels.
     void loadData(const ofShortPixels& pix);
 
     /// \brief Upload pixel data to texture (float)
+    /// \details Stored as a 32-bit float texture with the pixels' channels;
+    /// values outside [0, 1] are kept.
     void loadData(const ofFloatPixels& pix);
 
     /// \brief Upload raw pixel data to texture
+    /// \details Creates the texture on first use or when the size changes;
+    /// otherwise the existing texture is overwritten. Textures live in GPU-only
+    /// memory: the pixels are copied to a staging buffer and blitted in before
+    /// the frame's first pass, after frames already in flight. See
+    /// setStreaming() for textures updated every frame.
     /// \param data Pointer to pixel data
     /// \param w Width in pixels
     /// \param h Height in pixels
-    /// \param glFormat Image format (OF_IMAGE_GRAYSCALE, OF_IMAGE_COLOR, OF_IMAGE_COLOR_ALPHA)
+    /// \param glFormat Image format (OF_IMAGE_GRAYSCALE, OF_IMAGE_COLOR, OF_IMAGE_COLOR_ALPHA),
+    ///        or 2 for grayscale + alpha
     void loadData(const void* data, int w, int h, int glFormat);
 
+    /// \brief Upload pixel data into a sub-region of the texture
+    /// \details Updates only the target rectangle, leaving the rest of the
+    /// texture intact. The texture must have been created by loadData() first,
+    /// from pixels with the same channels or as an RGBA texture (the pixels are
+    /// then expanded to RGBA).
+    /// \param pix Pixel data to upload
+    /// \param x Left edge of the destination region in pixels
+    /// \param y Top edge of the destination region in pixels
+    /// \return true on success, false if not allocated, out of bounds or of
+    ///         an incompatible format
+    bool loadSubData(const ofPixels& pix, int x, int y);
+
+    // ========================================================================
+    // Compressed Textures
+    // ========================================================================
+
+    /// \brief Load a block-compressed texture from a KTX2 file
+    /// \details ASTC (square blocks, Apple GPUs), BC1, BC3 and BC7 data is
+    /// uploaded as stored, with its mip levels, at a fraction of the memory
+    /// of RGBA8 (BC1 1/8, ASTC 4x4, BC3 and BC7 1/4). The texture draws
+    /// like any other but can't be updated with loadSubData() or read back.
+    /// See ofLoadCompressedImage() to bake KTX2 files from images.
+    /// \param path Path to the .ktx2 file
+    /// \return false if the file can't be read, isn't a supported 2D
+    ///         texture, or the GPU can't sample its format
+    bool loadCompressed(const std::string& path);
+
+    /// \brief Check if the texture holds block-compressed data
+    bool isCompressed() const;
+
+    // ========================================================================
+    // Subsections (atlas views)
+    // ========================================================================
+
+    /// \brief Make this texture a view onto a rectangle of another texture
+    /// \details The view shares the source's GPU texture and draws with
+    /// texcoords limited to the rectangle, so draws of views onto the same
+    /// source batch into one command. The view does not own the GPU texture;
+    /// it stays valid for as long as the source does. Used by ofTextureAtlas.
+    /// \param source Texture to view
+    /// \param x Left edge of the rectangle in source pixels
+    /// \param y Top edge of the rectangle in source pixels
+    /// \param w Rectangle width in pixels (becomes getWidth())
+    /// \param h Rectangle height in pixels (becomes getHeight())
+    void setSubsection(const ofTexture& source, int x, int y, int w, int h);
+
+    /// \brief Check if this texture is a view onto another texture
+    /// \return true after setSubsection(), until the next loadData() or clear()
+    bool isSubsection() const;
+
+    // ========================================================================
+    // Streaming
+    // ========================================================================
+
+    /// \brief Cycle loadData() through several textures
+    /// \details For textures uploaded every frame (video, camera). Each frame's
+    /// loadData() writes a texture no frame in flight is sampling and makes it
+    /// the current one, so CPU writes never race the GPU. Streaming textures
+    /// stay in CPU-writable memory and skip the staging copy. Costs one texture
+    /// per frame in flight plus one instead of one. getNativeHandle() changes
+    /// with every upload, and views made with setSubsection() keep showing the
+    /// frame they were made from.
+    /// \param streaming true to enable, false to go back to a single texture
+    void setStreaming(bool streaming);
+
+    /// \brief setStreaming(true), then allocate()
+    /// \details For video and camera textures whose frames are uploaded from
+    /// the CPU every frame.
+    void allocateStreaming(int w, int h, int internalFormat);
+
+    /// \brief Check if streaming mode is enabled
+    /// \return true after setStreaming(true)
+    bool isStreaming() const;
+
     // ========================================================================
     // Data Readback
     // ========================================================================
 
     /// \brief Read pixel data from GPU texture to CPU memory
     /// \param pix Destination pixel buffer (will be allocated if needed)
-    /// \return true on success, false on failure
+    /// \return true on success, false on failure or for 16-bit and float textures
     bool readToPixels(ofPixels& pix) const;
 
+    /// \brief Read pixel data without waiting for the GPU
+    /// \details Records a copy of the texture into this frame's drawing: it
+    /// sees everything drawn into the texture so far this frame and resolves
+    /// one or two frames later, from a Metal completion thread. Poll with
+    /// wait_for(std::chrono::seconds(0)) rather than blocking in the frame
+    /// that recorded it, whose drawing only renders after draw() returns.
+    /// \return Future resolving to the pixels (unallocated if the copy
+    ///         failed); invalid (valid() is false) for views, 16-bit and float
+    ///         textures or when the texture isn't allocated
+    std::future<ofPixels> readToPixelsAsync() const;
+
     // ========================================================================
     // Drawing
     // ========================================================================
@@ -183,13 +294,22 @@ public:
     /// \param magFilter Magnification filter mode
     void setTextureMinMagFilter(ofTexFilterMode_t minFilter, ofTexFilterMode_t magFilter);
 
+    /// \brief Get packed sampler selection used by draw()
+    /// \details Combines wrap, min/mag/mip filter and anisotropy settings into a
+    /// render::SamplerKey. The renderer maps it to a cached sampler state.
+    /// \return Sampler key
+    uint16_t getSamplerKey() const;
+
     // ========================================================================
     // Mipmap (Phase 2)
     // ========================================================================
 
     /// \brief Enable mipmap generation for this texture
-    /// \details When enabled, mipmaps will be generated when texture data is loaded.
-    /// Must be called before allocate() or loadData().
+    /// \details When enabled, loadData() creates the texture with a full mip
+    /// chain and every loadData() and loadSubData() rebuilds it on the GPU, in
+    /// order with the frame's other commands. Sampling becomes trilinear
+    /// (see setMipmapFilter()). Takes effect at the next loadData(); streaming
+    /// textures and 32-bit float formats keep a single level.
     void enableMipmap();
 
     /// \brief Disable mipmap generation
@@ -200,8 +320,9 @@ public:
     bool hasMipmap() const;
 
     /// \brief Generate mipmaps for current texture data
-    /// \details Explicitly generates mipmaps. Called automatically if enabled
-    /// when loadData() is called. Requires texture to be allocated first.
+    /// \details Rebuilds the mip chain from level 0, in order with the frame's
+    /// other commands. Loads already do this; the texture must have been
+    /// loaded with mipmaps enabled.
     void generateMipmap();
 
     /// \brief Set mipmap filter mode
@@ -247,6 +368,17 @@ public:
     /// \return Metal texture handle (id<MTLTexture>), or nullptr if not allocated
     void* getNativeHandle() const;
 
+    /// \brief Draw a Metal texture owned elsewhere
+    /// \details Makes this texture draw an existing id<MTLTexture>, such as a
+    /// video frame wrapped by CVMetalTextureCache, without copying it. 8-bit
+    /// RGBA and BGRA textures both sample as RGBA. The owner keeps the texture
+    /// alive until frames that drew it have finished on the GPU; it is never
+    /// written, read back or released through this ofTexture. The next
+    /// loadData() or clear() stops using it.
+    /// \param nativeHandle id<MTLTexture> as a void pointer
+    /// \return false for a null handle
+    bool setNativeHandle(void* nativeHandle);
+
 private:
     // ========================================================================
     // pImpl Pattern
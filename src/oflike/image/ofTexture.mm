@@ -1,13 +1,19 @@
 #import "ofTexture.h"
+#import "TextureReadback.h"
+#import "ofPixelConvert.h"
 #import "../../render/DrawList.h"
 #import "../../render/DrawCommand.h"
 #import "../../render/RenderTypes.h"
 #import "../../render/IRenderer.h"
+#import "../../render/TextureCompression.h"
 #import "../../core/Context.h"
 #import "../graphics/ofGraphics.h"
+#import "../graphics/ofGraphicsTransform.h"
 #import "../math/ofMatrix4x4.h"
 #import <Metal/Metal.h>
 #import <Foundation/Foundation.h>
+#include <fstream>
+#include <iterator>
 #include <vector>
 
 namespace oflike {
@@ -47,6 +53,8 @@ static render::TextureFormat ImageTypeToTextureFormat(int imageType) {
     switch (imageType) {
         case OF_IMAGE_GRAYSCALE:
             return render::TextureFormat::R8;
+        case 2: // Grayscale + alpha (image types equal channel counts)
+            return render::TextureFormat::RG8;
         case OF_IMAGE_COLOR:
             return render::TextureFormat::RGBA8; // RGB stored as RGBA
         case OF_IMAGE_COLOR_ALPHA:
@@ -61,6 +69,8 @@ static render::TextureFormat ImageTypeToTextureFormat16(int imageType) {
     switch (imageType) {
         case OF_IMAGE_GRAYSCALE:
             return render::TextureFormat::R16;
+        case 2: // Grayscale + alpha (image types equal channel counts)
+            return render::TextureFormat::RG16;
         case OF_IMAGE_COLOR:
             return render::TextureFormat::RGBA16; // RGB stored as RGBA
         case OF_IMAGE_COLOR_ALPHA:
@@ -75,6 +85,8 @@ static render::TextureFormat ImageTypeToTextureFormat32F(int imageType) {
     switch (imageType) {
         case OF_IMAGE_GRAYSCALE:
             return render::TextureFormat::R32F;
+        case 2: // Grayscale + alpha (image types equal channel counts)
+            return render::TextureFormat::RG32F;
         case OF_IMAGE_COLOR:
             return render::TextureFormat::RGBA32F; // RGB stored as RGBA
         case OF_IMAGE_COLOR_ALPHA:
@@ -89,6 +101,8 @@ static size_t GetChannelsFromImageType(int imageType) {
     switch (imageType) {
         case OF_IMAGE_GRAYSCALE:
             return 1;
+        case 2:
+            return 2;
         case OF_IMAGE_COLOR:
             return 3;
         case OF_IMAGE_COLOR_ALPHA:
@@ -98,39 +112,46 @@ static size_t GetChannelsFromImageType(int imageType) {
     }
 }
 
-/// Convert RGB to RGBA (adds alpha channel) - 8-bit
-static void ConvertRGBToRGBA(const unsigned char* src, unsigned char* dst,
-                             size_t width, size_t height) {
-    for (size_t i = 0; i < width * height; ++i) {
-        dst[i * 4 + 0] = src[i * 3 + 0]; // R
-        dst[i * 4 + 1] = src[i * 3 + 1]; // G
-        dst[i * 4 + 2] = src[i * 3 + 2]; // B
-        dst[i * 4 + 3] = 255;            // A (opaque)
+// Lay pixel data out for its native texture format: only RGB is expanded
+// (to RGBA), everything else is uploaded as is
+template <typename T>
+static const T* PrepareUpload(const T* src, int w, int h, size_t channels, std::vector<T>& scratch) {
+    if (channels != 3) {
+        return src;
     }
+    scratch.resize(static_cast<size_t>(w) * h * 4);
+    ofPixelConvert::rgbToRGBA(src, 0, scratch.data(), 0, w, h);
+    return scratch.data();
 }
 
-/// Convert RGB to RGBA (adds alpha channel) - 16-bit
-static void ConvertRGBToRGBA16(const uint16_t* src, uint16_t* dst,
-                               size_t width, size_t height) {
-    for (size_t i = 0; i < width * height; ++i) {
-        dst[i * 4 + 0] = src[i * 3 + 0]; // R
-        dst[i * 4 + 1] = src[i * 3 + 1]; // G
-        dst[i * 4 + 2] = src[i * 3 + 2]; // B
-        dst[i * 4 + 3] = 65535;          // A (opaque, max 16-bit)
+// Expand 8-bit grayscale, grayscale + alpha or RGB pixels to RGBA8, for
+// writing them into an RGBA8 texture
+static const unsigned char* ExpandToRGBA8(const unsigned char* src, int w, int h, size_t channels,
+                                          std::vector<unsigned char>& scratch) {
+    if (channels == 4) {
+        return src;
     }
-}
-
-/// Convert RGB to RGBA (adds alpha channel) - float
-static void ConvertRGBToRGBAFloat(const float* src, float* dst,
-                                  size_t width, size_t height) {
-    for (size_t i = 0; i < width * height; ++i) {
-        dst[i * 4 + 0] = src[i * 3 + 0]; // R
-        dst[i * 4 + 1] = src[i * 3 + 1]; // G
-        dst[i * 4 + 2] = src[i * 3 + 2]; // B
-        dst[i * 4 + 3] = 1.0f;           // A (opaque)
+    if (channels == 3) {
+        return PrepareUpload(src, w, h, channels, scratch);
+    }
+    scratch.resize(static_cast<size_t>(w) * h * 4);
+    if (channels == 2) {
+        ofPixelConvert::grayAlphaToRGBA(src, 0, scratch.data(), 0, w, h);
+    } else {
+        ofPixelConvert::grayToRGBA(src, 0, scratch.data(), 0, w, h);
     }
+    return scratch.data();
 }
 
+// ============================================================================
+// Constants
+// ============================================================================
+
+// Textures a streaming texture cycles through. update() runs before the
+// renderer waits for a frame slot, so every frame in flight may still sample
+// its texture when the next one is written.
+static constexpr size_t kStreamingTextures = render::kMaxFramesInFlight + 1;
+
 // ============================================================================
 // ofTexture::Impl
 // ============================================================================
@@ -140,6 +161,7 @@ struct ofTexture::Impl {
     int width = 0;
     int height = 0;
     int internalFormat = OF_IMAGE_COLOR_ALPHA;
+    render::TextureFormat textureFormat = render::TextureFormat::RGBA8;
     bool bAllocated = false;
     render::TextureWrap wrapS = render::TextureWrap::Clamp;
     render::TextureWrap wrapT = render::TextureWrap::Clamp;
@@ -152,8 +174,165 @@ struct ofTexture::Impl {
     int numMipmapLevels = 1;
     int maxAnisotropy = 1;
 
+    // Packed sampler selection, refreshed whenever a sampler setting changes
+    render::SamplerKey samplerKey = render::kDefaultSamplerKey;
+
+    // Created by allocateWritable(); GPU filters may write it
+    bool writable = false;
+
+    // Loaded by loadCompressed(); blocks can't be updated or read back
+    bool compressed = false;
+
+    // Adopted through setNativeHandle(); the owner controls its lifetime
+    bool external = false;
+
+    // Created through createMipmappedTexture() (mipmapEnabled at upload);
+    // numMipmapLevels tells whether the format got more than one level
+    bool mipmapStorage = false;
+
+    // Subsection views share another texture's handle and draw a texcoord rect
+    bool ownsHandle = true;
+    float u0 = 0.0f;
+    float v0 = 0.0f;
+    float u1 = 1.0f;
+    float v1 = 1.0f;
+
+    // Streaming mode: loadData() writes the texture the GPU sampled longest
+    // ago and makes it textureHandle. streamFrames holds the frame each one
+    // was last written in.
+    bool streaming = false;
+    std::vector<void*> streamTextures;
+    std::vector<unsigned long long> streamFrames;
+    size_t streamIndex = 0;
+
+    void resetTexCoords() {
+        ownsHandle = true;
+        u0 = 0.0f;
+        v0 = 0.0f;
+        u1 = 1.0f;
+        v1 = 1.0f;
+    }
+
     Impl() = default;
 
+    // Release the owned texture(s); views only drop the reference
+    void releaseTextures(render::IRenderer* renderer) {
+        if (renderer) {
+            if (!streamTextures.empty()) {
+                for (void* texture : streamTextures) {
+                    renderer->destroyTexture(texture);
+                }
+            } else if (textureHandle && ownsHandle) {
+                renderer->destroyTexture(textureHandle);
+            }
+        }
+        streamTextures.clear();
+        streamFrames.clear();
+        streamIndex = 0;
+        textureHandle = nullptr;
+        writable = false;
+        compressed = false;
+        external = false;
+        mipmapStorage = false;
+        numMipmapLevels = 1;
+    }
+
+    // Rebuild the mip chain from level 0 after everything drawn so far,
+    // including the upload just made
+    void recordMipmaps() {
+        if (numMipmapLevels > 1 && textureHandle) {
+            Context::instance().getDrawList().addCommand(render::GenerateMipmapsCommand(textureHandle));
+        }
+    }
+
+    // Pick the streaming texture to write this frame, creating the ring on
+    // first use. Writes within one frame reuse the same texture: none of the
+    // frame's draws have been encoded yet.
+    void* acquireStreamTexture(render::IRenderer* renderer, int w, int h,
+                               render::TextureFormat format, unsigned long long frame) {
+        if (!streamTextures.empty() && streamFrames[streamIndex] == frame) {
+            return streamTextures[streamIndex];
+        }
+        if (streamTextures.size() < kStreamingTextures) {
+            void* texture = renderer->createStreamingTexture(w, h, format);
+            if (!texture) {
+                return nullptr;
+            }
+            streamTextures.push_back(texture);
+            streamFrames.push_back(frame);
+            streamIndex = streamTextures.size() - 1;
+            return texture;
+        }
+        streamIndex = (streamIndex + 1) % streamTextures.size();
+        streamFrames[streamIndex] = frame;
+        return streamTextures[streamIndex];
+    }
+
+    // Upload pixels of the given format, reusing the current texture when its
+    // size and format match. bytesPerRow 0 means tightly packed rows.
+    void upload(render::IRenderer* renderer, const void* data, int w, int h,
+                render::TextureFormat format, int imageType, size_t bytesPerRow = 0) {
+        const size_t packedBytesPerRow = static_cast<size_t>(w) * render::textureFormatBytesPerPixel(format);
+        if (bytesPerRow == 0) {
+            bytesPerRow = packedBytesPerRow;
+        }
+
+        // Streaming rings are rewritten every frame and keep a single level
+        const bool wantMipmaps = mipmapEnabled && !streaming;
+        const bool sameShape = textureHandle && ownsHandle && !compressed && width == w &&
+                               height == h && textureFormat == format && mipmapStorage == wantMipmaps;
+        const bool streamed = !streamTextures.empty();
+        if (!sameShape || streamed != streaming) {
+            // Release old texture if exists (views don't own theirs)
+            releaseTextures(renderer);
+        }
+        resetTexCoords();
+
+        // Update dimensions and format
+        width = w;
+        height = h;
+        internalFormat = imageType;
+        textureFormat = format;
+
+        if (streaming) {
+            textureHandle = acquireStreamTexture(renderer, w, h, format,
+                                                 Context::instance().getFrameNum());
+            bAllocated = textureHandle &&
+                         renderer->updateTexture(textureHandle, 0, 0, w, h, data, bytesPerRow);
+            return;
+        }
+
+        if (textureHandle &&
+            renderer->updateTexture(textureHandle, 0, 0, w, h, data, bytesPerRow)) {
+            bAllocated = true;
+            recordMipmaps();
+            return;
+        }
+
+        // Create texture through renderer; padded rows are written afterwards
+        const void* initialData = (bytesPerRow == packedBytesPerRow) ? data : nullptr;
+        textureHandle = wantMipmaps ? renderer->createMipmappedTexture(w, h, format, initialData)
+                                    : renderer->createTexture(w, h, format, initialData);
+        bAllocated = textureHandle &&
+                     (initialData || renderer->updateTexture(textureHandle, 0, 0, w, h, data, bytesPerRow));
+        if (bAllocated && wantMipmaps) {
+            // Formats the GPU can't filter come back with a single level
+            numMipmapLevels = static_cast<int>(((__bridge id<MTLTexture>)textureHandle).mipmapLevelCount);
+            mipmapStorage = true;
+            recordMipmaps();
+        }
+    }
+
+    void updateSamplerKey() {
+        render::TextureMipFilter mip = render::TextureMipFilter::None;
+        if (mipmapEnabled) {
+            mip = (mipmapFilter == render::TextureFilter::Linear)
+                ? render::TextureMipFilter::Linear : render::TextureMipFilter::Nearest;
+        }
+        samplerKey = render::makeSamplerKey(minFilter, magFilter, mip, wrapS, wrapT,
+                                            static_cast<uint32_t>(maxAnisotropy));
+    }
+
     ~Impl() {
         if (textureHandle) {
             // Release texture through Context/Renderer
@@ -209,18 +388,45 @@ void ofTexture::allocate(const ofPixels& pix) {
     );
 }
 
+bool ofTexture::allocateWritable(int w, int h) {
+    ensureImpl();
+
+    auto* renderer = Context::instance().renderer();
+    if (w <= 0 || h <= 0 || !renderer) {
+        return false;
+    }
+    if (impl_->writable && impl_->bAllocated && impl_->width == w && impl_->height == h) {
+        return true;
+    }
+
+    impl_->releaseTextures(renderer);
+    impl_->resetTexCoords();
+    impl_->textureHandle = renderer->createWritableTexture(w, h, render::TextureFormat::RGBA8);
+    impl_->width = w;
+    impl_->height = h;
+    impl_->internalFormat = OF_IMAGE_COLOR_ALPHA;
+    impl_->textureFormat = render::TextureFormat::RGBA8;
+    impl_->writable = impl_->textureHandle != nullptr;
+    impl_->bAllocated = impl_->writable;
+    return impl_->bAllocated;
+}
+
+bool ofTexture::isWritable() const {
+    return impl_ && impl_->writable;
+}
+
 bool ofTexture::isAllocated() const {
     return impl_ && impl_->bAllocated;
 }
 
 void ofTexture::clear() {
     if (impl_) {
-        // Release texture through Context/Renderer
-        // TODO: Implement proper texture release through Context
-        impl_->textureHandle = nullptr;
+        // Release owned textures through the renderer; views only drop the reference
+        impl_->releaseTextures(Context::instance().renderer());
         impl_->width = 0;
         impl_->height = 0;
         impl_->bAllocated = false;
+        impl_->resetTexCoords();
     }
 }
 
@@ -233,7 +439,25 @@ void ofTexture::loadData(const ofPixels& pix) {
     const int h = static_cast<int>(pix.getHeight());
     const int format = static_cast<int>(pix.getImageType());
 
-    loadData(pix.getData(), w, h, format);
+    if (pix.isContiguous()) {
+        loadData(pix.getData(), w, h, format);
+        return;
+    }
+
+    // Padded rows (views over external buffers): uploaded with their stride
+    // unless RGB has to be expanded, which needs packed rows
+    ensureImpl();
+    auto* renderer = Context::instance().renderer();
+    const size_t channels = pix.getNumChannels();
+    if (w <= 0 || h <= 0 || !pix.getData() || !renderer || channels < 1 || channels > 4) {
+        return;
+    }
+    if (channels == 3) {
+        loadData(ofPixels(pix));
+        return;
+    }
+    impl_->upload(renderer, pix.getData(), w, h, ImageTypeToTextureFormat(format), format,
+                  pix.getBytesStride());
 }
 
 void ofTexture::loadData(const ofShortPixels& pix) {
@@ -241,55 +465,23 @@ void ofTexture::loadData(const ofShortPixels& pix) {
 
     const int w = static_cast<int>(pix.getWidth());
     const int h = static_cast<int>(pix.getHeight());
-    const int channels = static_cast<int>(pix.getNumChannels());
+    const size_t channels = pix.getNumChannels();
 
-    if (w <= 0 || h <= 0 || !pix.getData()) {
+    auto* renderer = Context::instance().renderer();
+    if (w <= 0 || h <= 0 || !pix.getData() || !renderer || channels < 1 || channels > 4) {
         return;
     }
 
-    // Determine image type from channels
-    int imageType = OF_IMAGE_COLOR_ALPHA;
-    if (channels == 1) {
-        imageType = OF_IMAGE_GRAYSCALE;
-    } else if (channels == 3) {
-        imageType = OF_IMAGE_COLOR;
-    } else if (channels == 4) {
-        imageType = OF_IMAGE_COLOR_ALPHA;
-    }
-
-    // Convert 16-bit to 8-bit RGBA for Metal
-    std::vector<unsigned char> rgbaData(w * h * 4);
-    const uint16_t* srcData = pix.getData();
-
-    if (channels == 1) {
-        // Grayscale 16-bit to RGBA 8-bit
-        for (int i = 0; i < w * h; ++i) {
-            unsigned char v = static_cast<unsigned char>(srcData[i] >> 8);
-            rgbaData[i * 4 + 0] = v;
-            rgbaData[i * 4 + 1] = v;
-            rgbaData[i * 4 + 2] = v;
-            rgbaData[i * 4 + 3] = 255;
-        }
-    } else if (channels == 3) {
-        // RGB 16-bit to RGBA 8-bit
-        for (int i = 0; i < w * h; ++i) {
-            rgbaData[i * 4 + 0] = static_cast<unsigned char>(srcData[i * 3 + 0] >> 8);
-            rgbaData[i * 4 + 1] = static_cast<unsigned char>(srcData[i * 3 + 1] >> 8);
-            rgbaData[i * 4 + 2] = static_cast<unsigned char>(srcData[i * 3 + 2] >> 8);
-            rgbaData[i * 4 + 3] = 255;
-        }
-    } else {
-        // RGBA 16-bit to RGBA 8-bit
-        for (int i = 0; i < w * h; ++i) {
-            rgbaData[i * 4 + 0] = static_cast<unsigned char>(srcData[i * 4 + 0] >> 8);
-            rgbaData[i * 4 + 1] = static_cast<unsigned char>(srcData[i * 4 + 1] >> 8);
-            rgbaData[i * 4 + 2] = static_cast<unsigned char>(srcData[i * 4 + 2] >> 8);
-            rgbaData[i * 4 + 3] = static_cast<unsigned char>(srcData[i * 4 + 3] >> 8);
-        }
+    // 16-bit unorm texture: keeps the full precision of the pixels
+    const int imageType = static_cast<int>(channels);
+    if (!pix.isContiguous() && channels == 3) {
+        loadData(ofShortPixels(pix));  // RGB is expanded from packed rows
+        return;
     }
-
-    // Use the main loadData to upload
-    loadData(rgbaData.data(), w, h, OF_IMAGE_COLOR_ALPHA);
+    std::vector<uint16_t> scratch;
+    const uint16_t* uploadData = PrepareUpload(pix.getData(), w, h, channels, scratch);
+    impl_->upload(renderer, uploadData, w, h, ImageTypeToTextureFormat16(imageType), imageType,
+                  channels == 3 ? 0 : pix.getBytesStride());
 }
 
 void ofTexture::loadData(const ofFloatPixels& pix) {
@@ -297,121 +489,208 @@ void ofTexture::loadData(const ofFloatPixels& pix) {
 
     const int w = static_cast<int>(pix.getWidth());
     const int h = static_cast<int>(pix.getHeight());
-    const int channels = static_cast<int>(pix.getNumChannels());
+    const size_t channels = pix.getNumChannels();
 
-    if (w <= 0 || h <= 0 || !pix.getData()) {
+    auto* renderer = Context::instance().renderer();
+    if (w <= 0 || h <= 0 || !pix.getData() || !renderer || channels < 1 || channels > 4) {
         return;
     }
 
-    // Determine image type from channels
-    int imageType = OF_IMAGE_COLOR_ALPHA;
-    if (channels == 1) {
-        imageType = OF_IMAGE_GRAYSCALE;
-    } else if (channels == 3) {
-        imageType = OF_IMAGE_COLOR;
-    } else if (channels == 4) {
-        imageType = OF_IMAGE_COLOR_ALPHA;
-    }
-
-    // Convert float to 8-bit RGBA for Metal
-    std::vector<unsigned char> rgbaData(w * h * 4);
-    const float* srcData = pix.getData();
-
-    auto clampToByte = [](float v) -> unsigned char {
-        return static_cast<unsigned char>(std::max(0.0f, std::min(1.0f, v)) * 255.0f);
-    };
-
-    if (channels == 1) {
-        // Grayscale float to RGBA 8-bit
-        for (int i = 0; i < w * h; ++i) {
-            unsigned char v = clampToByte(srcData[i]);
-            rgbaData[i * 4 + 0] = v;
-            rgbaData[i * 4 + 1] = v;
-            rgbaData[i * 4 + 2] = v;
-            rgbaData[i * 4 + 3] = 255;
-        }
-    } else if (channels == 3) {
-        // RGB float to RGBA 8-bit
-        for (int i = 0; i < w * h; ++i) {
-            rgbaData[i * 4 + 0] = clampToByte(srcData[i * 3 + 0]);
-            rgbaData[i * 4 + 1] = clampToByte(srcData[i * 3 + 1]);
-            rgbaData[i * 4 + 2] = clampToByte(srcData[i * 3 + 2]);
-            rgbaData[i * 4 + 3] = 255;
-        }
-    } else {
-        // RGBA float to RGBA 8-bit
-        for (int i = 0; i < w * h; ++i) {
-            rgbaData[i * 4 + 0] = clampToByte(srcData[i * 4 + 0]);
-            rgbaData[i * 4 + 1] = clampToByte(srcData[i * 4 + 1]);
-            rgbaData[i * 4 + 2] = clampToByte(srcData[i * 4 + 2]);
-            rgbaData[i * 4 + 3] = clampToByte(srcData[i * 4 + 3]);
-        }
+    // 32-bit float texture: values outside [0, 1] survive for HDR use
+    const int imageType = static_cast<int>(channels);
+    if (!pix.isContiguous() && channels == 3) {
+        loadData(ofFloatPixels(pix));  // RGB is expanded from packed rows
+        return;
     }
-
-    // Use the main loadData to upload
-    loadData(rgbaData.data(), w, h, OF_IMAGE_COLOR_ALPHA);
+    std::vector<float> scratch;
+    const float* uploadData = PrepareUpload(pix.getData(), w, h, channels, scratch);
+    impl_->upload(renderer, uploadData, w, h, ImageTypeToTextureFormat32F(imageType), imageType,
+                  channels == 3 ? 0 : pix.getBytesStride());
 }
 
 void ofTexture::loadData(const void* data, int w, int h, int glFormat) {
     ensureImpl();
 
-    if (!data || w <= 0 || h <= 0) {
+    auto* renderer = Context::instance().renderer();
+    if (!data || w <= 0 || h <= 0 || !renderer) {
         return;
     }
 
-    // Release old texture if exists
-    if (impl_->textureHandle) {
-        auto* renderer = Context::instance().renderer();
-        if (renderer) {
-            renderer->destroyTexture(impl_->textureHandle);
-        }
-        impl_->textureHandle = nullptr;
+    // Image types equal channel counts; anything else is taken as RGBA
+    const int imageType = (glFormat >= 1 && glFormat <= 4) ? glFormat : OF_IMAGE_COLOR_ALPHA;
+    const size_t channels = static_cast<size_t>(imageType);
+
+    // Grayscale (+ alpha) is stored natively and swizzled on sampling; RGB is
+    // the only layout Metal can't store and is expanded to RGBA8
+    std::vector<unsigned char> scratch;
+    const unsigned char* uploadData =
+        PrepareUpload(static_cast<const unsigned char*>(data), w, h, channels, scratch);
+    impl_->upload(renderer, uploadData, w, h, ImageTypeToTextureFormat(imageType), imageType);
+}
+
+bool ofTexture::loadSubData(const ofPixels& pix, int x, int y) {
+    if (!impl_ || !impl_->textureHandle || !impl_->bAllocated || impl_->compressed || impl_->external ||
+        !pix.getData()) {
+        return false;
     }
 
-    // Update dimensions and format
-    impl_->width = w;
-    impl_->height = h;
-    impl_->internalFormat = glFormat;
-
-    // Determine number of channels from format
-    size_t channels = 4;  // Default to RGBA
-    if (glFormat == OF_IMAGE_GRAYSCALE || glFormat == 1) {
-        channels = 1;
-    } else if (glFormat == OF_IMAGE_COLOR || glFormat == 3) {
-        channels = 3;
-    } else if (glFormat == OF_IMAGE_COLOR_ALPHA || glFormat == 4) {
-        channels = 4;
-    }
-
-    // Prepare RGBA data for Metal (Metal requires RGBA8)
-    std::vector<unsigned char> rgbaData;
-    const unsigned char* uploadData = static_cast<const unsigned char*>(data);
-
-    if (channels == 1) {
-        // Convert grayscale to RGBA
-        rgbaData.resize(w * h * 4);
-        for (int i = 0; i < w * h; ++i) {
-            unsigned char v = uploadData[i];
-            rgbaData[i * 4 + 0] = v;
-            rgbaData[i * 4 + 1] = v;
-            rgbaData[i * 4 + 2] = v;
-            rgbaData[i * 4 + 3] = 255;
-        }
-        uploadData = rgbaData.data();
-    } else if (channels == 3) {
-        // Convert RGB to RGBA
-        rgbaData.resize(w * h * 4);
-        ConvertRGBToRGBA(static_cast<const unsigned char*>(data), rgbaData.data(), w, h);
-        uploadData = rgbaData.data();
+    const int w = static_cast<int>(pix.getWidth());
+    const int h = static_cast<int>(pix.getHeight());
+    if (x < 0 || y < 0 || w <= 0 || h <= 0) {
+        return false;
+    }
+    if (!pix.isContiguous()) {
+        return loadSubData(ofPixels(pix), x, y);  // Conversions need packed rows
+    }
+
+    auto* renderer = Context::instance().renderer();
+    if (!renderer) {
+        return false;
+    }
+
+    // Pixels are written in the texture's format: natively when they match
+    // it, expanded when the texture is RGBA8
+    const size_t channels = pix.getNumChannels();
+    const render::TextureFormat format = ImageTypeToTextureFormat(static_cast<int>(channels));
+    std::vector<unsigned char> scratch;
+    const unsigned char* uploadData = nullptr;
+    if (format == impl_->textureFormat) {
+        uploadData = PrepareUpload(pix.getData(), w, h, channels, scratch);
+    } else if (impl_->textureFormat == render::TextureFormat::RGBA8) {
+        uploadData = ExpandToRGBA8(pix.getData(), w, h, channels, scratch);
+    } else {
+        return false;
+    }
+
+    const size_t bytesPerRow = static_cast<size_t>(w) * render::textureFormatBytesPerPixel(impl_->textureFormat);
+    if (!renderer->updateTexture(impl_->textureHandle,
+                                 static_cast<uint32_t>(x), static_cast<uint32_t>(y),
+                                 static_cast<uint32_t>(w), static_cast<uint32_t>(h),
+                                 uploadData, bytesPerRow)) {
+        return false;
     }
-    // For channels == 4, use data directly
+    impl_->recordMipmaps();
+    return true;
+}
+
+// ============================================================================
+// Compressed Textures
+// ============================================================================
+
+bool ofTexture::loadCompressed(const std::string& path) {
+    ensureImpl();
 
-    // Create texture through renderer
     auto* renderer = Context::instance().renderer();
-    if (renderer) {
-        impl_->textureHandle = renderer->createTexture(w, h, uploadData);
-        impl_->bAllocated = (impl_->textureHandle != nullptr);
+    if (!renderer) {
+        return false;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        NSLog(@"ofTexture: Cannot open compressed texture %s", path.c_str());
+        return false;
+    }
+    const std::vector<uint8_t> contents((std::istreambuf_iterator<char>(file)),
+                                        std::istreambuf_iterator<char>());
+
+    render::CompressedTexture texture;
+    if (!render::readKTX2(contents.data(), contents.size(), texture)) {
+        NSLog(@"ofTexture: Unsupported KTX2 texture %s", path.c_str());
+        return false;
     }
+    if (!renderer->supportsCompressedTextureFormat(texture.format)) {
+        NSLog(@"ofTexture: GPU can't sample the block format of %s", path.c_str());
+        return false;
+    }
+
+    std::vector<const void*> levels;
+    for (const auto& level : texture.levels) {
+        levels.push_back(level.data());
+    }
+    void* handle = renderer->createCompressedTexture(texture.width, texture.height, texture.format,
+                                                     levels.data(), static_cast<uint32_t>(levels.size()));
+    if (!handle) {
+        return false;
+    }
+
+    impl_->releaseTextures(renderer);
+    impl_->resetTexCoords();
+    impl_->textureHandle = handle;
+    impl_->width = static_cast<int>(texture.width);
+    impl_->height = static_cast<int>(texture.height);
+    impl_->internalFormat = OF_IMAGE_COLOR_ALPHA;
+    impl_->textureFormat = render::TextureFormat::RGBA8;
+    impl_->numMipmapLevels = static_cast<int>(levels.size());
+    impl_->compressed = true;
+    impl_->bAllocated = true;
+    return true;
+}
+
+bool ofTexture::isCompressed() const {
+    return impl_ && impl_->compressed;
+}
+
+// ============================================================================
+// Subsections
+// ============================================================================
+
+void ofTexture::setSubsection(const ofTexture& source, int x, int y, int w, int h) {
+    ensureImpl();
+
+    if (!source.isAllocated() || source.getWidth() <= 0 || source.getHeight() <= 0) {
+        return;
+    }
+
+    // Release an owned texture before becoming a view
+    impl_->releaseTextures(Context::instance().renderer());
+
+    const Impl& src = *source.impl_;
+    const float sw = static_cast<float>(src.width);
+    const float sh = static_cast<float>(src.height);
+
+    impl_->textureHandle = src.textureHandle;
+    impl_->ownsHandle = false;
+    impl_->width = w;
+    impl_->height = h;
+    impl_->internalFormat = src.internalFormat;
+    impl_->bAllocated = true;
+    impl_->u0 = src.u0 + (src.u1 - src.u0) * (x / sw);
+    impl_->v0 = src.v0 + (src.v1 - src.v0) * (y / sh);
+    impl_->u1 = src.u0 + (src.u1 - src.u0) * ((x + w) / sw);
+    impl_->v1 = src.v0 + (src.v1 - src.v0) * ((y + h) / sh);
+
+    // Share sampling so views batch with each other and with the source
+    impl_->wrapS = src.wrapS;
+    impl_->wrapT = src.wrapT;
+    impl_->minFilter = src.minFilter;
+    impl_->magFilter = src.magFilter;
+    impl_->mipmapEnabled = src.mipmapEnabled;
+    impl_->mipmapFilter = src.mipmapFilter;
+    impl_->numMipmapLevels = src.numMipmapLevels;
+    impl_->maxAnisotropy = src.maxAnisotropy;
+    impl_->samplerKey = src.samplerKey;
+}
+
+bool ofTexture::isSubsection() const {
+    return impl_ && impl_->bAllocated && !impl_->ownsHandle && !impl_->external;
+}
+
+// ============================================================================
+// Streaming
+// ============================================================================
+
+void ofTexture::setStreaming(bool streaming) {
+    ensureImpl();
+    impl_->streaming = streaming;
+}
+
+void ofTexture::allocateStreaming(int w, int h, int internalFormat) {
+    setStreaming(true);
+    allocate(w, h, internalFormat);
+}
+
+bool ofTexture::isStreaming() const {
+    return impl_ && impl_->streaming;
 }
 
 // ============================================================================
@@ -436,12 +715,15 @@ void ofTexture::draw(float x, float y, float w, float h) const {
         ::ofGetColor(r, g, b, a);
         simd_float4 color = simd_make_float4(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f);
 
+        // Texcoords cover the whole texture, or the subsection rect for views
+        const float u0 = impl_->u0, v0 = impl_->v0, u1 = impl_->u1, v1 = impl_->v1;
+
         // Define quad vertices (2 triangles)
         std::vector<render::Vertex2D> vertices = {
-            render::Vertex2D(x,     y,     0.0f, 0.0f, color.x, color.y, color.z, color.w),  // Top-left
-            render::Vertex2D(x + w, y,     1.0f, 0.0f, color.x, color.y, color.z, color.w),  // Top-right
-            render::Vertex2D(x + w, y + h, 1.0f, 1.0f, color.x, color.y, color.z, color.w),  // Bottom-right
-            render::Vertex2D(x,     y + h, 0.0f, 1.0f, color.x, color.y, color.z, color.w),  // Bottom-left
+            render::Vertex2D(x,     y,     u0, v0, color.x, color.y, color.z, color.w),  // Top-left
+            render::Vertex2D(x + w, y,     u1, v0, color.x, color.y, color.z, color.w),  // Top-right
+            render::Vertex2D(x + w, y + h, u1, v1, color.x, color.y, color.z, color.w),  // Bottom-right
+            render::Vertex2D(x,     y + h, u0, v1, color.x, color.y, color.z, color.w),  // Bottom-left
         };
 
         // Define quad indices (2 triangles)
@@ -464,15 +746,10 @@ void ofTexture::draw(float x, float y, float w, float h) const {
         cmd.primitiveType = render::PrimitiveType::Triangle;
         cmd.blendMode = render::BlendMode::Alpha;
         cmd.texture = getNativeHandle();  // Texture handle
+        cmd.samplerKey = getSamplerKey();
 
         // Get current transform matrix
-        auto m = ::ofGetCurrentMatrix();
-        cmd.transform = simd_matrix(
-            simd_make_float4(m(0,0), m(1,0), m(2,0), m(3,0)),
-            simd_make_float4(m(0,1), m(1,1), m(2,1), m(3,1)),
-            simd_make_float4(m(0,2), m(1,2), m(2,2), m(3,2)),
-            simd_make_float4(m(0,3), m(1,3), m(2,3), m(3,3))
-        );
+        cmd.transform = ::ofGetCurrentModelMatrix();
 
         drawList.addCommand(cmd);
     }
@@ -498,29 +775,30 @@ void ofTexture::draw(float x, float y, float z, float w, float h) const {
         vertices.reserve(4);
 
         simd_float3 normal = simd_make_float3(0.0f, 0.0f, 1.0f);  // Facing forward
+        const float u0 = impl_->u0, v0 = impl_->v0, u1 = impl_->u1, v1 = impl_->v1;
 
         vertices.push_back(render::Vertex3D(
             simd_make_float3(x, y, z),           // Position
             normal,                              // Normal
-            simd_make_float2(0.0f, 0.0f),       // UV
+            simd_make_float2(u0, v0),           // UV
             color                                // Color
         ));
         vertices.push_back(render::Vertex3D(
             simd_make_float3(x + w, y, z),
             normal,
-            simd_make_float2(1.0f, 0.0f),
+            simd_make_float2(u1, v0),
             color
         ));
         vertices.push_back(render::Vertex3D(
             simd_make_float3(x + w, y + h, z),
             normal,
-            simd_make_float2(1.0f, 1.0f),
+            simd_make_float2(u1, v1),
             color
         ));
         vertices.push_back(render::Vertex3D(
             simd_make_float3(x, y + h, z),
             normal,
-            simd_make_float2(0.0f, 1.0f),
+            simd_make_float2(u0, v1),
             color
         ));
 
@@ -544,15 +822,10 @@ void ofTexture::draw(float x, float y, float z, float w, float h) const {
         cmd.primitiveType = render::PrimitiveType::Triangle;
         cmd.blendMode = render::BlendMode::Alpha;
         cmd.texture = getNativeHandle();
+        cmd.samplerKey = getSamplerKey();
 
         // Get current model-view matrix and projection
-        auto m = ::ofGetCurrentMatrix();
-        cmd.modelViewMatrix = simd_matrix(
-            simd_make_float4(m(0,0), m(1,0), m(2,0), m(3,0)),
-            simd_make_float4(m(0,1), m(1,1), m(2,1), m(3,1)),
-            simd_make_float4(m(0,2), m(1,2), m(2,2), m(3,2)),
-            simd_make_float4(m(0,3), m(1,3), m(2,3), m(3,3))
-        );
+        cmd.modelViewMatrix = ::ofGetCurrentModelMatrix();
 
         // TODO: Get proper projection matrix from camera system when available
         // For now, use identity (will be set by renderer)
@@ -600,11 +873,10 @@ void ofTexture::setTextureWrap(ofTexwrapMode_t wrapModeHorizontal,
         return;
     }
 
-    // Store texture settings for later application
+    // Store texture settings; draw() passes them on as a sampler key
     impl_->wrapS = ToRenderWrap(wrapModeHorizontal);
     impl_->wrapT = ToRenderWrap(wrapModeVertical);
-
-    // TODO: Apply texture wrap settings through Context/Renderer
+    impl_->updateSamplerKey();
 }
 
 void ofTexture::setTextureMinMagFilter(ofTexFilterMode_t minFilter,
@@ -613,11 +885,14 @@ void ofTexture::setTextureMinMagFilter(ofTexFilterMode_t minFilter,
         return;
     }
 
-    // Store filter settings for later application
+    // Store filter settings; draw() passes them on as a sampler key
     impl_->minFilter = ToRenderFilter(minFilter);
     impl_->magFilter = ToRenderFilter(magFilter);
+    impl_->updateSamplerKey();
+}
 
-    // TODO: Apply texture filter settings through Context/Renderer
+uint16_t ofTexture::getSamplerKey() const {
+    return impl_ ? impl_->samplerKey : render::kDefaultSamplerKey;
 }
 
 // ============================================================================
@@ -637,7 +912,16 @@ int ofTexture::getHeight() const {
 // ============================================================================
 
 bool ofTexture::readToPixels(ofPixels& pix) const {
-    if (!impl_ || !impl_->textureHandle || !impl_->bAllocated) {
+    // Views would read the source's top-left corner, not their subsection
+    if (!impl_ || !impl_->textureHandle || !impl_->bAllocated || !impl_->ownsHandle ||
+        impl_->compressed) {
+        return false;
+    }
+
+    // 16-bit and float textures don't fit 8-bit pixels
+    const render::TextureFormat format = impl_->textureFormat;
+    if (format != render::TextureFormat::R8 && format != render::TextureFormat::RG8 &&
+        format != render::TextureFormat::RGBA8) {
         return false;
     }
 
@@ -648,18 +932,29 @@ bool ofTexture::readToPixels(ofPixels& pix) const {
     // Allocate pixel buffer
     pix.allocate(w, h, channels);
 
-    // Calculate bytes per row
-    const size_t bytesPerRow = w * channels;
-
     // Read pixels from GPU texture through Context (respecting layer boundaries)
     auto& ctx = Context::instance();
-    return ctx.readTexturePixels(
-        impl_->textureHandle,
-        pix.getData(),
-        w,
-        h,
-        bytesPerRow
-    );
+    const size_t texelSize = render::textureFormatBytesPerPixel(format);
+    if (texelSize == channels) {
+        return ctx.readTexturePixels(impl_->textureHandle, pix.getData(), w, h, w * texelSize);
+    }
+
+    // RGB is stored as RGBA: read the texels and drop alpha
+    std::vector<unsigned char> rgba(static_cast<size_t>(w) * h * 4);
+    if (!ctx.readTexturePixels(impl_->textureHandle, rgba.data(), w, h, static_cast<size_t>(w) * 4)) {
+        return false;
+    }
+    ofPixelConvert::rgbaToRGB(rgba.data(), 0, pix.getData(), pix.getBytesStride(), w, h);
+    return true;
+}
+
+std::future<ofPixels> ofTexture::readToPixelsAsync() const {
+    if (!impl_ || !impl_->textureHandle || !impl_->bAllocated || !impl_->ownsHandle ||
+        impl_->compressed) {
+        return std::future<ofPixels>();
+    }
+    return readTextureAsync(impl_->textureHandle, impl_->width, impl_->height,
+                            GetChannelsFromImageType(impl_->internalFormat));
 }
 
 // ============================================================================
@@ -675,6 +970,28 @@ void* ofTexture::getNativeHandle() const {
     return impl_->textureHandle;
 }
 
+bool ofTexture::setNativeHandle(void* nativeHandle) {
+    if (!nativeHandle) {
+        return false;
+    }
+    ensureImpl();
+
+    // Like a view, the texture is only referenced; owned textures go first
+    impl_->releaseTextures(Context::instance().renderer());
+    impl_->resetTexCoords();
+
+    id<MTLTexture> texture = (__bridge id<MTLTexture>)nativeHandle;
+    impl_->textureHandle = nativeHandle;
+    impl_->ownsHandle = false;
+    impl_->external = true;
+    impl_->width = static_cast<int>(texture.width);
+    impl_->height = static_cast<int>(texture.height);
+    impl_->internalFormat = OF_IMAGE_COLOR_ALPHA;
+    impl_->textureFormat = render::TextureFormat::RGBA8;
+    impl_->bAllocated = true;
+    return true;
+}
+
 // ============================================================================
 // Mipmap (Phase 2)
 // ============================================================================
@@ -682,11 +999,13 @@ void* ofTexture::getNativeHandle() const {
 void ofTexture::enableMipmap() {
     ensureImpl();
     impl_->mipmapEnabled = true;
+    impl_->updateSamplerKey();
 }
 
 void ofTexture::disableMipmap() {
     if (impl_) {
         impl_->mipmapEnabled = false;
+        impl_->updateSamplerKey();
     }
 }
 
@@ -695,66 +1014,26 @@ bool ofTexture::hasMipmap() const {
 }
 
 void ofTexture::generateMipmap() {
-    if (!impl_ || !impl_->textureHandle || !impl_->bAllocated) {
+    // Compressed textures bring their own levels; blocks can't be filtered
+    if (!impl_ || !impl_->textureHandle || !impl_->bAllocated || !impl_->ownsHandle ||
+        impl_->compressed) {
         return;
     }
 
-    @autoreleasepool {
-        // Get Metal texture from handle
-        id<MTLTexture> texture = (__bridge id<MTLTexture>)impl_->textureHandle;
-        if (!texture) {
-            return;
-        }
-
-        // Check if texture supports mipmaps
-        if (texture.mipmapLevelCount <= 1) {
-            // Texture was not allocated with mipmap storage
-            // Note: Metal textures must be allocated with mipmap support at creation time
-            NSLog(@"ofTexture: Cannot generate mipmaps - texture not allocated with mipmap support");
-            return;
-        }
-
-        // Get command queue from context
-        void* devicePtr = Context::instance().getMetalDevice();
-        if (!devicePtr) {
-            return;
-        }
-
-        id<MTLDevice> device = (__bridge id<MTLDevice>)devicePtr;
-        id<MTLCommandQueue> commandQueue = [device newCommandQueue];
-        if (!commandQueue) {
-            return;
-        }
-
-        // Create command buffer and blit encoder for mipmap generation
-        id<MTLCommandBuffer> commandBuffer = [commandQueue commandBuffer];
-        if (!commandBuffer) {
-            return;
-        }
-
-        id<MTLBlitCommandEncoder> blitEncoder = [commandBuffer blitCommandEncoder];
-        if (!blitEncoder) {
-            return;
-        }
-
-        // Generate mipmaps
-        [blitEncoder generateMipmapsForTexture:texture];
-        [blitEncoder endEncoding];
-
-        // Commit and wait
-        [commandBuffer commit];
-        [commandBuffer waitUntilCompleted];
-
-        // Update mipmap level count
-        impl_->numMipmapLevels = static_cast<int>(texture.mipmapLevelCount);
+    // Metal textures get their mip storage at creation time
+    if (impl_->numMipmapLevels <= 1) {
+        NSLog(@"ofTexture: Cannot generate mipmaps - call enableMipmap() before loadData()");
+        return;
     }
+
+    // Encoded with the frame, after everything drawn into the texture so far
+    impl_->recordMipmaps();
 }
 
 void ofTexture::setMipmapFilter(ofTexFilterMode_t filter) {
     ensureImpl();
     impl_->mipmapFilter = ToRenderFilter(filter);
-
-    // TODO: Apply mipmap filter through Context/Renderer sampler state
+    impl_->updateSamplerKey();
 }
 
 int ofTexture::getNumMipmapLevels() const {
@@ -769,8 +1048,7 @@ void ofTexture::setMaxAnisotropy(int level) {
     ensureImpl();
     // Clamp to valid range (1-16)
     impl_->maxAnisotropy = std::max(1, std::min(16, level));
-
-    // TODO: Apply anisotropic filtering through Context/Renderer sampler state
+    impl_->updateSamplerKey();
 }
 
 int ofTexture::getMaxAnisotropy() const {
@@ -0,0 +1,291 @@
+#include "ofTextureAtlas.h"
+#include "ofImage.h"
+#include "../utils/ofLog.h"
+#include "../../render/AtlasPacker.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace oflike {
+
+// ============================================================================
+// ofTextureAtlas::Impl
+// ============================================================================
+
+struct ofTextureAtlas::Impl {
+    struct Page {
+        ofTexture texture;
+        render::SkylinePacker packer;
+
+        // Deferred uploads: CPU copy of the page and the rectangle of it
+        // changed since the last flush (empty when x0 >= x1)
+        ofPixels shadow;
+        int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+
+        bool isDeferred() const { return shadow.getData() != nullptr; }
+
+        void markDirty(int x, int y, int w, int h) {
+            if (x0 >= x1) {
+                x0 = x; y0 = y; x1 = x + w; y1 = y + h;
+                return;
+            }
+            x0 = std::min(x0, x);
+            y0 = std::min(y0, y);
+            x1 = std::max(x1, x + w);
+            y1 = std::max(y1, y + h);
+        }
+    };
+
+    int pageWidth = 2048;
+    int pageHeight = 2048;
+    int padding = 1;
+    int maxPages = 0;
+    bool deferred = false;
+    std::vector<std::unique_ptr<Page>> pages;
+
+    // Copy pixels into a deferred page's shadow, expanded to RGBA like
+    // ofTexture::loadSubData() does
+    static void writeShadow(Page& page, const ofPixels& pix, int x, int y) {
+        const int w = static_cast<int>(pix.getWidth());
+        const int h = static_cast<int>(pix.getHeight());
+        const size_t channels = pix.getNumChannels();
+        const size_t srcStride = pix.getBytesStride();
+        const size_t dstStride = page.shadow.getBytesStride();
+        const unsigned char* src = pix.getData();
+        unsigned char* dst = page.shadow.getData() + static_cast<size_t>(y) * dstStride + static_cast<size_t>(x) * 4;
+        for (int row = 0; row < h; row++) {
+            const unsigned char* s = src + row * srcStride;
+            unsigned char* d = dst + row * dstStride;
+            if (channels == 4) {
+                std::memcpy(d, s, static_cast<size_t>(w) * 4);
+                continue;
+            }
+            for (int i = 0; i < w; i++, s += channels, d += 4) {
+                if (channels >= 3) {
+                    d[0] = s[0];
+                    d[1] = s[1];
+                    d[2] = s[2];
+                    d[3] = 255;
+                } else {
+                    d[0] = d[1] = d[2] = s[0];
+                    d[3] = channels == 2 ? s[1] : 255;
+                }
+            }
+        }
+        page.markDirty(x, y, w, h);
+    }
+
+    Page* addPage() {
+        if (maxPages > 0 && static_cast<int>(pages.size()) >= maxPages) {
+            return nullptr;
+        }
+
+        // Pages start transparent so padding never samples garbage
+        std::vector<unsigned char> zeros(static_cast<size_t>(pageWidth) * pageHeight * 4, 0);
+        auto page = std::make_unique<Page>();
+        page->texture.loadData(zeros.data(), pageWidth, pageHeight, OF_IMAGE_COLOR_ALPHA);
+        if (!page->texture.isAllocated()) {
+            ofLogError("ofTextureAtlas") << "Failed to create " << pageWidth << "x" << pageHeight << " page";
+            return nullptr;
+        }
+        page->packer.reset(static_cast<uint32_t>(pageWidth), static_cast<uint32_t>(pageHeight));
+        if (deferred) {
+            page->shadow.allocate(pageWidth, pageHeight, 4);
+        }
+
+        pages.push_back(std::move(page));
+        return pages.back().get();
+    }
+};
+
+// ============================================================================
+// ofTextureAtlas Implementation
+// ============================================================================
+
+ofTextureAtlas::ofTextureAtlas()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ofTextureAtlas::~ofTextureAtlas() {
+    if (impl_) {
+        clear();
+    }
+}
+
+ofTextureAtlas::ofTextureAtlas(ofTextureAtlas&& other) noexcept = default;
+
+ofTextureAtlas& ofTextureAtlas::operator=(ofTextureAtlas&& other) noexcept = default;
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+void ofTextureAtlas::setup(int pageWidth, int pageHeight, int padding, int maxPages) {
+    clear();
+    impl_->pageWidth = std::max(pageWidth, 1);
+    impl_->pageHeight = std::max(pageHeight, 1);
+    impl_->padding = std::max(padding, 0);
+    impl_->maxPages = std::max(maxPages, 0);
+}
+
+void ofTextureAtlas::clear() {
+    for (auto& page : impl_->pages) {
+        page->texture.clear();
+    }
+    impl_->pages.clear();
+}
+
+void ofTextureAtlas::setDeferredUploads(bool deferred) {
+    impl_->deferred = deferred;
+}
+
+void ofTextureAtlas::flush() {
+    for (auto& page : impl_->pages) {
+        if (!page->isDeferred() || page->x0 >= page->x1) {
+            continue;
+        }
+        // The rectangle also covers images uploaded earlier, rewritten
+        // with the same values
+        ofPixels dirty;
+        dirty.setFromExternalPixels(
+            page->shadow.getData() + static_cast<size_t>(page->y0) * page->shadow.getBytesStride() +
+                static_cast<size_t>(page->x0) * 4,
+            page->x1 - page->x0, page->y1 - page->y0, 4, page->shadow.getBytesStride());
+        page->texture.loadSubData(dirty, page->x0, page->y0);
+        page->x0 = page->x1 = 0;
+    }
+}
+
+// ============================================================================
+// Packing
+// ============================================================================
+
+bool ofTextureAtlas::insert(const ofPixels& pix, ofTextureAtlasRegion& region) {
+    region = ofTextureAtlasRegion();
+
+    const int w = static_cast<int>(pix.getWidth());
+    const int h = static_cast<int>(pix.getHeight());
+    if (w <= 0 || h <= 0 || !pix.getData()) {
+        return false;
+    }
+
+    if (w > impl_->pageWidth || h > impl_->pageHeight) {
+        ofLogWarning("ofTextureAtlas") << w << "x" << h << " image is larger than the "
+                                       << impl_->pageWidth << "x" << impl_->pageHeight << " page";
+        return false;
+    }
+
+    // Padding goes on the right/bottom (the page edge covers left/top) and is
+    // clamped at the page edge so page-sized images still fit
+    const uint32_t fitW = static_cast<uint32_t>(std::min(w + impl_->padding, impl_->pageWidth));
+    const uint32_t fitH = static_cast<uint32_t>(std::min(h + impl_->padding, impl_->pageHeight));
+
+    render::AtlasRect rect;
+    int pageIndex = -1;
+    for (size_t i = 0; i < impl_->pages.size(); i++) {
+        if (impl_->pages[i]->packer.insert(fitW, fitH, rect)) {
+            pageIndex = static_cast<int>(i);
+            break;
+        }
+    }
+
+    if (pageIndex < 0) {
+        Impl::Page* page = impl_->addPage();
+        if (!page || !page->packer.insert(fitW, fitH, rect)) {
+            ofLogWarning("ofTextureAtlas") << "Atlas full, cannot pack " << w << "x" << h << " image";
+            return false;
+        }
+        pageIndex = static_cast<int>(impl_->pages.size()) - 1;
+    }
+
+    Impl::Page& page = *impl_->pages[pageIndex];
+    if (page.isDeferred()) {
+        Impl::writeShadow(page, pix, static_cast<int>(rect.x), static_cast<int>(rect.y));
+    } else if (!page.texture.loadSubData(pix, static_cast<int>(rect.x), static_cast<int>(rect.y))) {
+        return false;
+    }
+
+    const float pw = static_cast<float>(impl_->pageWidth);
+    const float ph = static_cast<float>(impl_->pageHeight);
+    region.page = pageIndex;
+    region.x = static_cast<int>(rect.x);
+    region.y = static_cast<int>(rect.y);
+    region.width = w;
+    region.height = h;
+    region.u0 = region.x / pw;
+    region.v0 = region.y / ph;
+    region.u1 = (region.x + w) / pw;
+    region.v1 = (region.y + h) / ph;
+    return true;
+}
+
+ofTexture ofTextureAtlas::add(const ofPixels& pix) {
+    ofTextureAtlasRegion region;
+    if (!insert(pix, region)) {
+        return ofTexture();
+    }
+    return getView(region);
+}
+
+ofTexture ofTextureAtlas::add(const ofImage& image) {
+    return add(image.getPixels());
+}
+
+ofTexture ofTextureAtlas::getView(const ofTextureAtlasRegion& region) const {
+    ofTexture view;
+    if (region.page < 0 || region.page >= getNumPages()) {
+        return view;
+    }
+    view.setSubsection(impl_->pages[region.page]->texture,
+                       region.x, region.y, region.width, region.height);
+    return view;
+}
+
+// ============================================================================
+// Pages
+// ============================================================================
+
+int ofTextureAtlas::getNumPages() const {
+    return static_cast<int>(impl_->pages.size());
+}
+
+const ofTexture& ofTextureAtlas::getPageTexture(int page) const {
+    static const ofTexture empty;
+    if (page < 0 || page >= getNumPages()) {
+        return empty;
+    }
+    return impl_->pages[page]->texture;
+}
+
+float ofTextureAtlas::getOccupancy(int page) const {
+    if (page < 0 || page >= getNumPages()) {
+        return 0.0f;
+    }
+    return impl_->pages[page]->packer.getOccupancy();
+}
+
+void ofTextureAtlas::clearPage(int page) {
+    if (page < 0 || page >= getNumPages()) {
+        return;
+    }
+    Impl::Page& p = *impl_->pages[page];
+    p.packer.reset(static_cast<uint32_t>(impl_->pageWidth), static_cast<uint32_t>(impl_->pageHeight));
+    if (p.isDeferred()) {
+        std::memset(p.shadow.getData(), 0, p.shadow.getBytesStride() * impl_->pageHeight);
+        p.markDirty(0, 0, impl_->pageWidth, impl_->pageHeight);
+        return;
+    }
+    ofPixels zeros;
+    zeros.allocate(impl_->pageWidth, impl_->pageHeight, 4);
+    p.texture.loadSubData(zeros, 0, 0);
+}
+
+int ofTextureAtlas::getPageWidth() const {
+    return impl_->pageWidth;
+}
+
+int ofTextureAtlas::getPageHeight() const {
+    return impl_->pageHeight;
+}
+
+} // namespace oflike
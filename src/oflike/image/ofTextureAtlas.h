@@ -0,0 +1,167 @@
+#pragma once
+
+// oflike-metal ofTextureAtlas - runtime texture atlas packing
+// Packs many small images into a few large textures so they batch
+
+#include <memory>
+#include "ofPixels.h"
+#include "ofTexture.h"
+
+namespace oflike {
+
+class ofImage;
+
+/// \brief Packed location of an image inside an ofTextureAtlas
+struct ofTextureAtlasRegion {
+    int page = -1;     ///< Page index, -1 if not packed
+    int x = 0;         ///< Left edge in page pixels
+    int y = 0;         ///< Top edge in page pixels
+    int width = 0;     ///< Width in pixels
+    int height = 0;    ///< Height in pixels
+    float u0 = 0.0f;   ///< Left texcoord (0-1)
+    float v0 = 0.0f;   ///< Top texcoord (0-1)
+    float u1 = 0.0f;   ///< Right texcoord (0-1)
+    float v1 = 0.0f;   ///< Bottom texcoord (0-1)
+
+    /// \brief Check if the region holds a packed image
+    bool isValid() const { return page >= 0; }
+};
+
+/// \brief Runtime texture atlas built from ofPixels/ofImage
+/// \details ofTextureAtlas packs images into large RGBA pages with a skyline
+/// packer (render::SkylinePacker) and hands back ofTexture subsection views.
+/// Every view onto the same page shares one GPU texture, so consecutive
+/// draws of atlas members merge into a single draw command in the DrawList
+/// instead of breaking the batch on each texture change.
+///
+/// Features:
+/// - Skyline bottom-left packing with configurable padding
+/// - Grows by adding pages when the current pages are full (optional cap)
+/// - Sub-region uploads; earlier members never move
+/// - Optional deferred uploads: one upload per page per flush()
+/// - Pages can be emptied and packed again (e.g. LRU glyph caches)
+/// - Views draw with ofTexture::draw() like any other texture
+///
+/// Implementation:
+/// - Pages are ordinary ofTextures owned by the atlas
+/// - Views don't own GPU memory; keep the atlas alive while they are used
+/// - Thread-safety: Main thread only (Metal requirement)
+///
+/// Example:
+/// \code
+///     ofTextureAtlas atlas;
+///     atlas.setup(2048, 2048);
+///     ofTexture icon = atlas.add(iconImage);
+///     ofTexture badge = atlas.add(badgeImage);
+///     icon.draw(10, 10);   // Both draws batch into one command
+///     badge.draw(80, 10);
+/// \endcode
+class ofTextureAtlas {
+public:
+    // ========================================================================
+    // Constructors & Destructor
+    // ========================================================================
+
+    /// \brief Default constructor (2048x2048 pages, 1px padding)
+    ofTextureAtlas();
+
+    /// \brief Destructor (releases all pages)
+    ~ofTextureAtlas();
+
+    /// \brief Move constructor
+    ofTextureAtlas(ofTextureAtlas&& other) noexcept;
+
+    /// \brief Move assignment
+    ofTextureAtlas& operator=(ofTextureAtlas&& other) noexcept;
+
+    ofTextureAtlas(const ofTextureAtlas&) = delete;
+    ofTextureAtlas& operator=(const ofTextureAtlas&) = delete;
+
+    // ========================================================================
+    // Setup
+    // ========================================================================
+
+    /// \brief Configure page size and packing
+    /// \details Clears any packed images. Pages are created lazily on first add().
+    /// \param pageWidth Page width in pixels
+    /// \param pageHeight Page height in pixels
+    /// \param padding Empty pixels kept between packed images (avoids filter bleed)
+    /// \param maxPages Maximum number of pages, 0 for unlimited
+    void setup(int pageWidth = 2048, int pageHeight = 2048, int padding = 1, int maxPages = 0);
+
+    /// \brief Release all pages and packed images, keeping the configuration
+    void clear();
+
+    /// \brief Collect uploads until flush()
+    /// \details While deferred, insert() writes into a CPU copy of its page
+    /// and flush() uploads each page's changed rectangle at once, so images
+    /// packed a few at a time cost one upload per page rather than one each.
+    /// Applies to pages created after the call, which then keep the copy
+    /// (4 bytes per pixel); call after setup(), before packing.
+    /// \param deferred true to defer uploads (default false)
+    void setDeferredUploads(bool deferred);
+
+    /// \brief Upload what deferred pages received since the last flush()
+    void flush();
+
+    // ========================================================================
+    // Packing
+    // ========================================================================
+
+    /// \brief Pack pixels and return a view onto their region
+    /// \param pix Pixels to pack (grayscale, RGB or RGBA)
+    /// \return Subsection texture, unallocated if the pixels don't fit
+    ofTexture add(const ofPixels& pix);
+
+    /// \brief Pack an image's pixels and return a view onto their region
+    /// \param image Loaded image
+    /// \return Subsection texture, unallocated if the image doesn't fit
+    ofTexture add(const ofImage& image);
+
+    /// \brief Pack pixels and report where they landed
+    /// \details Lower-level form of add() for callers that build their own
+    /// geometry from texcoords (e.g. glyph quads).
+    /// \param pix Pixels to pack
+    /// \param region Receives the packed location
+    /// \return true on success, false if the pixels don't fit
+    bool insert(const ofPixels& pix, ofTextureAtlasRegion& region);
+
+    /// \brief Create a view onto a packed region
+    /// \param region Region returned by insert()
+    /// \return Subsection texture, unallocated if the region is invalid
+    ofTexture getView(const ofTextureAtlasRegion& region) const;
+
+    // ========================================================================
+    // Pages
+    // ========================================================================
+
+    /// \brief Get number of pages created so far
+    int getNumPages() const;
+
+    /// \brief Get a page texture
+    /// \param page Page index
+    /// \return Page texture (unallocated if index is out of range)
+    const ofTexture& getPageTexture(int page) const;
+
+    /// \brief Fraction of a page covered by packed images (0-1)
+    float getOccupancy(int page) const;
+
+    /// \brief Empty a page so it can be packed again
+    /// \details Clears the page to transparent; regions and views onto it
+    /// are invalid afterwards. The caller must make sure no frame in flight
+    /// still samples it.
+    /// \param page Page index
+    void clearPage(int page);
+
+    /// \brief Get configured page width
+    int getPageWidth() const;
+
+    /// \brief Get configured page height
+    int getPageHeight() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
@@ -0,0 +1,161 @@
+#pragma once
+
+// oflike-metal ofTiledImage - gigapixel images streamed from tile pyramids
+// Only the tiles a view shows are decoded, on worker threads, into a fixed
+// tile cache texture, so memory stays bounded whatever the image size
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace oflike {
+
+/// \brief Image far larger than a texture, drawn with pan and zoom
+/// \details An ofImage decodes the whole file and can't exceed the largest
+/// texture (16384 pixels). ofTiledImage draws from a tile pyramid built once
+/// with build() (see TiledImageFile.h): the image and its halvings down to
+/// one tile, cut into 256-pixel tiles encoded separately.
+///
+/// - The file is memory-mapped; opening it reads only the tile table.
+/// - draw() picks, per region, the level whose pixels are closest to the
+///   screen's, and only the tiles that are in view.
+/// - Missing tiles are decoded on worker threads and uploaded into a cache
+///   texture in later frames; until then the nearest coarser tile that is
+///   resident stands in for them (the one-tile level always is).
+/// - The cache holds a fixed number of tiles and evicts the least recently
+///   drawn, never one drawn in the frames the GPU may still be rendering.
+///
+/// Memory is the cache texture (about 68 MB for the default 256 tiles) plus
+/// the decodes in flight, whether the image is 20 or 2,500 megapixels.
+///
+/// Example:
+/// \code
+///     // Once, offline or on first run
+///     ofTiledImage::build("scan.tif", "scan.ofltiles");
+///
+///     ofTiledImage scan;
+///     scan.load("scan.ofltiles");
+///
+///     void draw() {
+///         ofPushMatrix();
+///         ofTranslate(pan.x, pan.y);
+///         ofScale(zoom, zoom);
+///         scan.draw(0, 0);        // Full-size coordinates
+///         ofPopMatrix();
+///     }
+/// \endcode
+class ofTiledImage {
+public:
+    static constexpr int kDefaultTileSize = 256;
+    static constexpr int kDefaultCacheTiles = 256;
+
+    // ========================================================================
+    // Construction / Destruction
+    // ========================================================================
+
+    ofTiledImage();
+    ~ofTiledImage();
+
+    ofTiledImage(ofTiledImage&& other) noexcept;
+    ofTiledImage& operator=(ofTiledImage&& other) noexcept;
+
+    ofTiledImage(const ofTiledImage&) = delete;
+    ofTiledImage& operator=(const ofTiledImage&) = delete;
+
+    // ========================================================================
+    // Pyramid Files
+    // ========================================================================
+
+    /// \brief Build a tile pyramid file from an image file
+    /// \details Reads the source in bands of tile rows through ImageIO and
+    /// writes every level as it goes, keeping one band per level in memory.
+    /// Strip- and tile-organized TIFFs are decoded a band at a time; other
+    /// formats may be decoded whole by ImageIO first. Sources with alpha
+    /// store PNG tiles, opaque ones JPEG. Blocks; run it on a worker thread
+    /// or ahead of time for large images.
+    /// \param sourcePath Image file (TIFF, JPEG, PNG, ... anything ImageIO reads)
+    /// \param outputPath Pyramid file to write (.ofltiles)
+    /// \param tileSize Tile edge in pixels (16-4096)
+    /// \param quality JPEG quality (0-1)
+    /// \return false if the source can't be read or the file can't be written
+    static bool build(const std::string& sourcePath, const std::string& outputPath,
+                      int tileSize = kDefaultTileSize, float quality = 0.9f);
+
+    /// \brief Open a tile pyramid file
+    /// \details Maps the file and decodes the one-tile level; the rest is
+    /// decoded as draws need it. Closes any open file.
+    /// \param path Pyramid file written by build()
+    /// \return false if the file isn't a valid pyramid or no renderer is running
+    bool load(const std::string& path);
+
+    /// \brief Close the file and release the cache
+    void close();
+
+    /// \brief Check if a pyramid is open
+    bool isLoaded() const;
+
+    // ========================================================================
+    // Properties
+    // ========================================================================
+
+    /// \brief Get the full-size width in pixels
+    int getWidth() const;
+
+    /// \brief Get the full-size height in pixels
+    int getHeight() const;
+
+    /// \brief Get the number of levels (1 = the image fits in one tile)
+    int getNumLevels() const;
+
+    /// \brief Get the tile edge in pixels
+    int getTileSize() const;
+
+    // ========================================================================
+    // Tile Cache
+    // ========================================================================
+
+    /// \brief Set how many tiles the cache texture holds
+    /// \details Takes effect at the next load(). More tiles keep more of the
+    /// image sharp while panning back; the screen needs about
+    /// (width / tileSize + 2) * (height / tileSize + 2) to show sharply.
+    /// Limited by the largest texture. Default: 256.
+    void setCacheTiles(int tiles);
+    int getCacheTiles() const;
+
+    /// \brief Set how many decoded tiles draw() uploads per frame (default 16)
+    void setMaxUploadsPerFrame(int uploads);
+
+    /// \brief Set the detail bias in levels
+    /// \details Positive values pick coarser levels (fewer tiles), negative
+    /// ones finer. Default: 0, the level whose pixels are at least as dense
+    /// as the screen's.
+    void setLodBias(float levels);
+
+    /// \brief Get the number of tiles in the cache
+    size_t getNumResidentTiles() const;
+
+    /// \brief Get the number of tiles being decoded or waiting for upload
+    size_t getNumPendingTiles() const;
+
+    /// \brief Get the number of tiles the last draw() drew with a coarser stand-in
+    size_t getNumMissingTiles() const;
+
+    // ========================================================================
+    // Drawing
+    // ========================================================================
+
+    /// \brief Draw the image at full size
+    void draw(float x, float y) const;
+
+    /// \brief Draw the image into a rectangle with the current transform
+    void draw(float x, float y, float w, float h) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
+
+// Global namespace alias for openFrameworks compatibility
+using ofTiledImage = oflike::ofTiledImage;
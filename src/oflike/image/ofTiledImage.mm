@@ -0,0 +1,846 @@
+// ofTiledImage.mm - gigapixel images streamed from tile pyramids
+
+#import <Foundation/Foundation.h>
+#import <ImageIO/ImageIO.h>
+
+#include "ofTiledImage.h"
+#include "TiledImageFile.h"
+#include "ofPixels.h"
+#include "ofTexture.h"
+#include "../../core/Context.h"
+#include "../../render/IRenderer.h"
+#include "../graphics/ofGraphicsTransform.h"
+#include "../utils/ofLog.h"
+#include "../utils/ofUtils.h"
+#include <dispatch/dispatch.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace oflike {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+// Cache slots hold a tile and a one-pixel border copied from its edges, so
+// filtering never blends in a neighboring slot
+static constexpr int kSlotBorder = 1;
+
+static constexpr uint64_t kNoTile = UINT64_MAX;
+
+// ============================================================================
+// Tiles
+// ============================================================================
+
+namespace {
+
+uint64_t tileKey(uint32_t level, uint32_t tx, uint32_t ty) {
+    return (static_cast<uint64_t>(level) << 56) | (static_cast<uint64_t>(ty) << 28) | tx;
+}
+
+/// Draw a CGImage into premultiplied RGBA rows
+bool drawImageRGBA(CGImageRef image, uint8_t* data, size_t width, size_t height, size_t bytesPerRow) {
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(data, width, height, 8, bytesPerRow, colorSpace,
+                                                 kCGBitmapByteOrderDefault | kCGImageAlphaPremultipliedLast);
+    CGColorSpaceRelease(colorSpace);
+    if (!context) {
+        return false;
+    }
+    CGContextSetBlendMode(context, kCGBlendModeCopy);
+    CGContextDrawImage(context, CGRectMake(0, 0, width, height), image);
+    CGContextRelease(context);
+    return true;
+}
+
+/// Decode an encoded tile into a cache slot's pixels (tile plus border)
+bool decodeTile(const uint8_t* data, size_t size, uint32_t width, uint32_t height, ofPixels& slot) {
+    @autoreleasepool {
+        CFDataRef bytes = CFDataCreateWithBytesNoCopy(kCFAllocatorDefault, data, static_cast<CFIndex>(size),
+                                                      kCFAllocatorNull);
+        CGImageSourceRef source = bytes ? CGImageSourceCreateWithData(bytes, nullptr) : nullptr;
+        if (bytes) CFRelease(bytes);
+        CGImageRef image = source ? CGImageSourceCreateImageAtIndex(source, 0, nullptr) : nullptr;
+        if (source) CFRelease(source);
+        if (!image) {
+            return false;
+        }
+        if (CGImageGetWidth(image) != width || CGImageGetHeight(image) != height) {
+            CGImageRelease(image);
+            return false;
+        }
+
+        const size_t slotWidth = width + 2 * kSlotBorder;
+        const size_t slotHeight = height + 2 * kSlotBorder;
+        slot.allocate(slotWidth, slotHeight, 4);
+        uint8_t* pixels = slot.getData();
+        const size_t stride = slotWidth * 4;
+        const bool drawn = drawImageRGBA(image, pixels + kSlotBorder * stride + kSlotBorder * 4,
+                                         width, height, stride);
+        CGImageRelease(image);
+        if (!drawn) {
+            return false;
+        }
+
+        // Border: edge columns, then edge rows (corners included)
+        for (size_t y = kSlotBorder; y < slotHeight - kSlotBorder; y++) {
+            uint8_t* row = pixels + y * stride;
+            memcpy(row, row + 4, 4);
+            memcpy(row + (slotWidth - 1) * 4, row + (slotWidth - 2) * 4, 4);
+        }
+        memcpy(pixels, pixels + stride, stride);
+        memcpy(pixels + (slotHeight - 1) * stride, pixels + (slotHeight - 2) * stride, stride);
+        return true;
+    }
+}
+
+// ============================================================================
+// Pyramid Writer
+// ============================================================================
+
+/**
+ * Writes a pyramid from the full-size rows, top to bottom. Every level
+ * collects one band of tile rows and writes its tiles when the band is
+ * full; each pair of rows is averaged 2x2 into a row of the next level, so
+ * all levels are written in a single pass over the source.
+ */
+class PyramidWriter {
+public:
+    PyramidWriter(FILE* file, const TiledImageHeader& header, float quality)
+        : file_(file)
+        , tileSize_(header.tileSize)
+        , extension_(header.codec == kTiledImagePNG ? "tile.png" : "tile.jpg")
+        , quality_(quality)
+        , tiles_(header.tileCount) {
+        uint64_t firstTile = 0;
+        levels_.resize(header.levelCount);
+        for (uint32_t i = 0; i < header.levelCount; i++) {
+            Level& level = levels_[i];
+            level.width = tiledImageLevelSize(header.width, i);
+            level.height = tiledImageLevelSize(header.height, i);
+            level.tilesX = tiledImageTilesAcross(level.width, tileSize_);
+            level.firstTile = firstTile;
+            firstTile += static_cast<uint64_t>(level.tilesX) * tiledImageTilesAcross(level.height, tileSize_);
+            level.band.resize(static_cast<size_t>(level.width) * tileSize_ * 4);
+            if (i + 1 < header.levelCount) {
+                level.pending.resize(static_cast<size_t>(level.width) * 4);
+                level.half.resize(static_cast<size_t>(tiledImageLevelSize(header.width, i + 1)) * 4);
+            }
+        }
+    }
+
+    /// Add the next full-size row (premultiplied RGBA)
+    bool addRow(const uint8_t* row) {
+        return push(0, row);
+    }
+
+    /// Flush the odd last rows into the levels below; true if every level is complete
+    bool finish() {
+        for (size_t i = 0; i + 1 < levels_.size(); i++) {
+            Level& level = levels_[i];
+            if (level.hasPending) {
+                level.hasPending = false;
+                downsample(level, level.pending.data(), level.pending.data());
+                if (!push(i + 1, level.half.data())) {
+                    return false;
+                }
+            }
+        }
+        for (const Level& level : levels_) {
+            if (level.rows != level.height) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const std::vector<TiledImageTile>& getTiles() const {
+        return tiles_;
+    }
+
+private:
+    struct Level {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t tilesX = 0;
+        uint32_t rows = 0;                  // Rows received
+        uint64_t firstTile = 0;
+        std::vector<uint8_t> band;          // Up to tileSize rows
+        std::vector<uint8_t> pending;       // First row of the next pair
+        std::vector<uint8_t> half;          // Row of the next level
+        bool hasPending = false;
+    };
+
+    bool push(size_t index, const uint8_t* row) {
+        Level& level = levels_[index];
+        const size_t rowBytes = static_cast<size_t>(level.width) * 4;
+        const uint32_t bandRow = level.rows % tileSize_;
+        memcpy(level.band.data() + bandRow * rowBytes, row, rowBytes);
+        level.rows++;
+        if ((bandRow + 1 == tileSize_ || level.rows == level.height) && !writeBand(level, bandRow + 1)) {
+            return false;
+        }
+
+        if (index + 1 == levels_.size()) {
+            return true;
+        }
+        if (!level.hasPending) {
+            memcpy(level.pending.data(), row, rowBytes);
+            level.hasPending = true;
+            return true;
+        }
+        level.hasPending = false;
+        downsample(level, level.pending.data(), row);
+        return push(index + 1, level.half.data());
+    }
+
+    // 2x2 box of two rows; an odd last column pairs with itself
+    static void downsample(Level& level, const uint8_t* a, const uint8_t* b) {
+        const size_t halfWidth = level.half.size() / 4;
+        for (size_t x = 0; x < halfWidth; x++) {
+            const size_t x0 = 2 * x * 4;
+            const size_t x1 = std::min<size_t>(2 * x + 1, level.width - 1) * 4;
+            for (size_t c = 0; c < 4; c++) {
+                level.half[x * 4 + c] = static_cast<uint8_t>((a[x0 + c] + a[x1 + c] + b[x0 + c] + b[x1 + c] + 2) / 4);
+            }
+        }
+    }
+
+    bool writeBand(const Level& level, uint32_t rows) {
+        const uint32_t ty = (level.rows - 1) / tileSize_;
+        const size_t rowBytes = static_cast<size_t>(level.width) * 4;
+        ofPixels tile;
+        std::vector<uint8_t> encoded;
+        for (uint32_t tx = 0; tx < level.tilesX; tx++) {
+            const uint32_t x = tx * tileSize_;
+            const uint32_t width = std::min(tileSize_, level.width - x);
+            tile.allocate(width, rows, 4);
+            for (uint32_t y = 0; y < rows; y++) {
+                memcpy(tile.getData() + static_cast<size_t>(y) * width * 4,
+                       level.band.data() + y * rowBytes + static_cast<size_t>(x) * 4, static_cast<size_t>(width) * 4);
+            }
+            if (!ofEncodeImage(tile, encoded, extension_, quality_) || encoded.size() > UINT32_MAX) {
+                return false;
+            }
+
+            TiledImageTile& record = tiles_[level.firstTile + static_cast<uint64_t>(ty) * level.tilesX + tx];
+            record.offset = static_cast<uint64_t>(ftello(file_));
+            record.size = static_cast<uint32_t>(encoded.size());
+            record.reserved = 0;
+            if (fwrite(encoded.data(), 1, encoded.size(), file_) != encoded.size()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    FILE* file_;
+    uint32_t tileSize_;
+    std::string extension_;
+    float quality_;
+    std::vector<Level> levels_;
+    std::vector<TiledImageTile> tiles_;
+};
+
+// ============================================================================
+// Tile Source
+// ============================================================================
+
+/// Mapped pyramid file and the decodes coming back from worker threads;
+/// shared with them, so closing an image never unmaps tiles being decoded
+struct TileSource {
+    void* mapping = nullptr;
+    size_t length = 0;
+    const TiledImageTile* tiles = nullptr;
+
+    std::mutex mutex;
+    std::vector<std::pair<uint64_t, ofPixels>> ready;      // Empty pixels = failed
+
+    ~TileSource() {
+        if (mapping) {
+            munmap(mapping, length);
+        }
+    }
+
+    const uint8_t* tileData(uint64_t index, size_t& size) const {
+        const TiledImageTile& tile = tiles[index];
+        if (tile.offset > length || tile.size > length - tile.offset) {
+            size = 0;
+            return nullptr;
+        }
+        size = tile.size;
+        return static_cast<const uint8_t*>(mapping) + tile.offset;
+    }
+};
+
+} // namespace
+
+// ============================================================================
+// ofTiledImage::Impl
+// ============================================================================
+
+struct ofTiledImage::Impl {
+    struct Slot {
+        uint64_t key = kNoTile;
+        unsigned long long lastUsed = 0;
+        bool pinned = false;                // The one-tile level
+        ofTexture view;                     // Tile inside the cache texture
+    };
+
+    std::shared_ptr<TileSource> source;
+    TiledImageHeader header = {};
+    std::vector<uint64_t> levelFirstTile;
+    std::vector<uint32_t> levelTilesX;
+    std::vector<uint32_t> levelTilesY;
+
+    ofTexture cache;
+    std::vector<Slot> slots;
+    int slotSize = 0;
+    int slotsX = 0;
+    std::unordered_map<uint64_t, int> resident;
+    std::unordered_set<uint64_t> pending;
+    std::unordered_set<uint64_t> failed;
+
+    int cacheTiles = kDefaultCacheTiles;
+    int maxUploads = 16;
+    float lodBias = 0.0f;
+    size_t maxInFlight = 8;
+    size_t missing = 0;
+
+    // ------------------------------------------------------------------------
+    // Tile geometry
+    // ------------------------------------------------------------------------
+
+    uint32_t levelSize(uint32_t size, uint32_t level) const {
+        return tiledImageLevelSize(size, level);
+    }
+
+    uint32_t tileWidth(uint32_t level, uint32_t tx) const {
+        return std::min(header.tileSize, levelSize(header.width, level) - tx * header.tileSize);
+    }
+
+    uint32_t tileHeight(uint32_t level, uint32_t ty) const {
+        return std::min(header.tileSize, levelSize(header.height, level) - ty * header.tileSize);
+    }
+
+    uint64_t tileIndex(uint64_t key) const {
+        const uint32_t level = static_cast<uint32_t>(key >> 56);
+        const uint32_t ty = static_cast<uint32_t>(key >> 28) & 0xFFFFFFF;
+        const uint32_t tx = static_cast<uint32_t>(key) & 0xFFFFFFF;
+        return levelFirstTile[level] + static_cast<uint64_t>(ty) * levelTilesX[level] + tx;
+    }
+
+    // ------------------------------------------------------------------------
+    // Cache
+    // ------------------------------------------------------------------------
+
+    bool createCache() {
+        const int count = std::max(cacheTiles, 4);
+        slotSize = static_cast<int>(header.tileSize) + 2 * kSlotBorder;
+        slotsX = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+        const int slotsY = (count + slotsX - 1) / slotsX;
+        if (!cache.allocateWritable(slotsX * slotSize, slotsY * slotSize)) {
+            ofLogError("ofTiledImage") << "Failed to create a " << slotsX * slotSize << "x" << slotsY * slotSize
+                                       << " tile cache";
+            return false;
+        }
+        slots.clear();
+        slots.resize(static_cast<size_t>(count));
+        return true;
+    }
+
+    /// Free slot, or the least recently drawn one no frame in flight samples
+    int acquireSlot(unsigned long long frame) {
+        int best = -1;
+        for (int i = 0; i < static_cast<int>(slots.size()); i++) {
+            const Slot& slot = slots[i];
+            if (slot.key == kNoTile) {
+                return i;
+            }
+            if (!slot.pinned && slot.lastUsed + render::kRetireFrames < frame &&
+                (best < 0 || slot.lastUsed < slots[best].lastUsed)) {
+                best = i;
+            }
+        }
+        if (best >= 0) {
+            resident.erase(slots[best].key);
+            slots[best].key = kNoTile;
+        }
+        return best;
+    }
+
+    bool upload(uint64_t key, const ofPixels& pixels, unsigned long long frame, bool pinned) {
+        const int index = acquireSlot(frame);
+        if (index < 0) {
+            return false;
+        }
+        const int x = (index % slotsX) * slotSize;
+        const int y = (index / slotsX) * slotSize;
+        if (!cache.loadSubData(pixels, x, y)) {
+            return false;
+        }
+
+        Slot& slot = slots[index];
+        slot.key = key;
+        slot.lastUsed = frame;
+        slot.pinned = pinned;
+        slot.view.setSubsection(cache, x + kSlotBorder, y + kSlotBorder,
+                                static_cast<int>(pixels.getWidth()) - 2 * kSlotBorder,
+                                static_cast<int>(pixels.getHeight()) - 2 * kSlotBorder);
+        resident[key] = index;
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    // Decoding
+    // ------------------------------------------------------------------------
+
+    void request(uint64_t key, uint32_t width, uint32_t height) {
+        if (pending.size() >= maxInFlight || pending.count(key) || failed.count(key)) {
+            return;
+        }
+        pending.insert(key);
+
+        std::shared_ptr<TileSource> shared = source;
+        const uint64_t index = tileIndex(key);
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            ofPixels pixels;
+            size_t size = 0;
+            const uint8_t* data = shared->tileData(index, size);
+            if (!data || !decodeTile(data, size, width, height, pixels)) {
+                pixels.clear();
+            }
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            shared->ready.emplace_back(key, std::move(pixels));
+        });
+    }
+
+    void uploadReady(unsigned long long frame) {
+        std::vector<std::pair<uint64_t, ofPixels>> decoded;
+        {
+            std::lock_guard<std::mutex> lock(source->mutex);
+            const size_t count = std::min(source->ready.size(), static_cast<size_t>(std::max(maxUploads, 1)));
+            decoded.reserve(count);
+            std::move(source->ready.begin(), source->ready.begin() + count, std::back_inserter(decoded));
+            source->ready.erase(source->ready.begin(), source->ready.begin() + count);
+        }
+        for (auto& tile : decoded) {
+            pending.erase(tile.first);
+            if (!tile.second.isAllocated()) {
+                if (failed.insert(tile.first).second) {
+                    ofLogError("ofTiledImage") << "Failed to decode tile " << tileIndex(tile.first);
+                }
+                continue;
+            }
+            // No free slot: dropped, and requested again while it is in view
+            upload(tile.first, tile.second, frame, false);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Drawing
+    // ------------------------------------------------------------------------
+
+    struct View {
+        simd_float4x4 modelViewProjection;
+        float viewportWidth;
+        float viewportHeight;
+        float x, y, scaleX, scaleY;         // Draw rectangle per full-size pixel
+        float refineDensity;                // Screen pixels per tile pixel that refine
+        unsigned long long frame;
+    };
+
+    /// Screen bounds of a full-size rectangle; false if it is out of view
+    static bool screenBounds(const View& view, float x0, float y0, float x1, float y1, float& width, float& height) {
+        const float xs[2] = {view.x + x0 * view.scaleX, view.x + x1 * view.scaleX};
+        const float ys[2] = {view.y + y0 * view.scaleY, view.y + y1 * view.scaleY};
+        float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+        for (int i = 0; i < 4; i++) {
+            const simd_float4 clip = simd_mul(view.modelViewProjection, simd_make_float4(xs[i & 1], ys[i >> 1], 0.0f, 1.0f));
+            if (clip.w <= 1e-6f) {
+                // Behind the camera: keep it, at full detail
+                width = height = FLT_MAX;
+                return true;
+            }
+            const float sx = (clip.x / clip.w * 0.5f + 0.5f) * view.viewportWidth;
+            const float sy = (clip.y / clip.w * 0.5f + 0.5f) * view.viewportHeight;
+            minX = std::min(minX, sx);
+            maxX = std::max(maxX, sx);
+            minY = std::min(minY, sy);
+            maxY = std::max(maxY, sy);
+        }
+        width = maxX - minX;
+        height = maxY - minY;
+        return maxX >= 0.0f && minX <= view.viewportWidth && maxY >= 0.0f && minY <= view.viewportHeight;
+    }
+
+    void drawQuad(const ofTexture& texture, const View& view, float x0, float y0, float x1, float y1) const {
+        texture.draw(view.x + x0 * view.scaleX, view.y + y0 * view.scaleY,
+                     (x1 - x0) * view.scaleX, (y1 - y0) * view.scaleY);
+    }
+
+    /// Draw a tile, or the part of its nearest resident ancestor that covers it
+    void drawTile(const View& view, uint32_t level, uint32_t tx, uint32_t ty) {
+        const uint32_t ts = header.tileSize;
+        const uint32_t tw = tileWidth(level, tx);
+        const uint32_t th = tileHeight(level, ty);
+        const uint64_t key = tileKey(level, tx, ty);
+        const auto found = resident.find(key);
+        if (found != resident.end()) {
+            Slot& slot = slots[found->second];
+            slot.lastUsed = view.frame;
+            const float x0 = static_cast<float>(static_cast<uint64_t>(tx * ts) << level);
+            const float y0 = static_cast<float>(static_cast<uint64_t>(ty * ts) << level);
+            const float x1 = std::min(static_cast<float>(static_cast<uint64_t>(tx * ts + tw) << level),
+                                      static_cast<float>(header.width));
+            const float y1 = std::min(static_cast<float>(static_cast<uint64_t>(ty * ts + th) << level),
+                                      static_cast<float>(header.height));
+            drawQuad(slot.view, view, x0, y0, x1, y1);
+            return;
+        }
+
+        request(key, tw, th);
+        missing++;
+        for (uint32_t d = 1; level + d < header.levelCount; d++) {
+            const uint32_t ax = tx >> d, ay = ty >> d;
+            const auto ancestor = resident.find(tileKey(level + d, ax, ay));
+            if (ancestor == resident.end()) {
+                continue;
+            }
+
+            // The ancestor's pixels over this tile, widened to whole pixels
+            Slot& slot = slots[ancestor->second];
+            slot.lastUsed = view.frame;
+            const uint32_t aw = tileWidth(level + d, ax), ah = tileHeight(level + d, ay);
+            const uint32_t sx0 = std::min(((tx * ts) >> d) - ax * ts, aw - 1);
+            const uint32_t sy0 = std::min(((ty * ts) >> d) - ay * ts, ah - 1);
+            const uint32_t sx1 = std::min(((tx * ts + tw + (1u << d) - 1) >> d) - ax * ts, aw);
+            const uint32_t sy1 = std::min(((ty * ts + th + (1u << d) - 1) >> d) - ay * ts, ah);
+            const int cacheX = (ancestor->second % slotsX) * slotSize + kSlotBorder;
+            const int cacheY = (ancestor->second / slotsX) * slotSize + kSlotBorder;
+            ofTexture part;
+            part.setSubsection(cache, cacheX + static_cast<int>(sx0), cacheY + static_cast<int>(sy0),
+                               static_cast<int>(sx1 - sx0), static_cast<int>(sy1 - sy0));
+
+            const uint32_t shift = level + d;
+            const float x0 = static_cast<float>(static_cast<uint64_t>(ax * ts + sx0) << shift);
+            const float y0 = static_cast<float>(static_cast<uint64_t>(ay * ts + sy0) << shift);
+            const float x1 = std::min(static_cast<float>(static_cast<uint64_t>(ax * ts + sx1) << shift),
+                                      static_cast<float>(header.width));
+            const float y1 = std::min(static_cast<float>(static_cast<uint64_t>(ay * ts + sy1) << shift),
+                                      static_cast<float>(header.height));
+            drawQuad(part, view, x0, y0, x1, y1);
+            return;
+        }
+    }
+
+    /// Refine from a tile down to the level whose pixels match the screen's
+    void visit(const View& view, uint32_t level, uint32_t tx, uint32_t ty) {
+        const uint32_t ts = header.tileSize;
+        const uint32_t tw = tileWidth(level, tx);
+        const uint32_t th = tileHeight(level, ty);
+        const float x0 = static_cast<float>(static_cast<uint64_t>(tx * ts) << level);
+        const float y0 = static_cast<float>(static_cast<uint64_t>(ty * ts) << level);
+        const float x1 = std::min(static_cast<float>(static_cast<uint64_t>(tx * ts + tw) << level),
+                                  static_cast<float>(header.width));
+        const float y1 = std::min(static_cast<float>(static_cast<uint64_t>(ty * ts + th) << level),
+                                  static_cast<float>(header.height));
+        float screenWidth = 0.0f, screenHeight = 0.0f;
+        if (!screenBounds(view, x0, y0, x1, y1, screenWidth, screenHeight)) {
+            return;
+        }
+
+        const float density = std::max(screenWidth / tw, screenHeight / th);
+        if (level == 0 || density <= view.refineDensity) {
+            drawTile(view, level, tx, ty);
+            return;
+        }
+        for (uint32_t cy = 2 * ty; cy <= 2 * ty + 1 && cy < levelTilesY[level - 1]; cy++) {
+            for (uint32_t cx = 2 * tx; cx <= 2 * tx + 1 && cx < levelTilesX[level - 1]; cx++) {
+                visit(view, level - 1, cx, cy);
+            }
+        }
+    }
+};
+
+// ============================================================================
+// Construction / Destruction
+// ============================================================================
+
+ofTiledImage::ofTiledImage()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ofTiledImage::~ofTiledImage() = default;
+
+ofTiledImage::ofTiledImage(ofTiledImage&& other) noexcept
+    : impl_(std::exchange(other.impl_, std::make_unique<Impl>())) {
+}
+
+ofTiledImage& ofTiledImage::operator=(ofTiledImage&& other) noexcept {
+    if (this != &other) {
+        impl_ = std::exchange(other.impl_, std::make_unique<Impl>());
+    }
+    return *this;
+}
+
+// ============================================================================
+// Pyramid Files
+// ============================================================================
+
+bool ofTiledImage::build(const std::string& sourcePath, const std::string& outputPath, int tileSize, float quality) {
+    @autoreleasepool {
+        if (tileSize < 16 || tileSize > 4096) {
+            ofLogError("ofTiledImage") << "build(): tile size " << tileSize << " outside 16-4096";
+            return false;
+        }
+
+        NSURL* url = [NSURL fileURLWithPath:[NSString stringWithUTF8String:sourcePath.c_str()]];
+        CGImageSourceRef imageSource = CGImageSourceCreateWithURL((__bridge CFURLRef)url, nullptr);
+        CGImageRef image = imageSource ? CGImageSourceCreateImageAtIndex(imageSource, 0, nullptr) : nullptr;
+        if (imageSource) CFRelease(imageSource);
+        if (!image) {
+            ofLogError("ofTiledImage") << "build(): failed to read " << sourcePath;
+            return false;
+        }
+
+        const size_t width = CGImageGetWidth(image);
+        const size_t height = CGImageGetHeight(image);
+        const CGImageAlphaInfo alpha = CGImageGetAlphaInfo(image);
+        const bool opaque = alpha == kCGImageAlphaNone || alpha == kCGImageAlphaNoneSkipLast ||
+                            alpha == kCGImageAlphaNoneSkipFirst;
+        if (width == 0 || height == 0 || width > UINT32_MAX / 2 || height > UINT32_MAX / 2) {
+            CGImageRelease(image);
+            return false;
+        }
+
+        TiledImageHeader header = {};
+        memcpy(header.magic, kTiledImageMagic, sizeof(kTiledImageMagic));
+        header.version = kTiledImageVersion;
+        header.width = static_cast<uint32_t>(width);
+        header.height = static_cast<uint32_t>(height);
+        header.tileSize = static_cast<uint32_t>(tileSize);
+        header.levelCount = tiledImageLevelCount(header.width, header.height, header.tileSize);
+        header.codec = opaque ? kTiledImageJPEG : kTiledImagePNG;
+        header.tileCount = tiledImageTileCount(header.width, header.height, header.tileSize, header.levelCount);
+        header.tableOffset = sizeof(TiledImageHeader);
+
+        FILE* file = fopen(outputPath.c_str(), "wb");
+        if (!file) {
+            ofLogError("ofTiledImage") << "build(): failed to create " << outputPath;
+            CGImageRelease(image);
+            return false;
+        }
+
+        // Tiles follow the table, which is written once their offsets are known
+        PyramidWriter writer(file, header, quality);
+        bool success = fseeko(file, static_cast<off_t>(header.tableOffset + header.tileCount * sizeof(TiledImageTile)),
+                              SEEK_SET) == 0;
+
+        std::vector<uint8_t> band(width * static_cast<size_t>(tileSize) * 4);
+        for (size_t y = 0; success && y < height; y += static_cast<size_t>(tileSize)) {
+            @autoreleasepool {
+                const size_t rows = std::min(static_cast<size_t>(tileSize), height - y);
+                CGImageRef rect = CGImageCreateWithImageInRect(image, CGRectMake(0, y, width, rows));
+                success = rect && drawImageRGBA(rect, band.data(), width, rows, width * 4);
+                if (rect) CGImageRelease(rect);
+                for (size_t row = 0; success && row < rows; row++) {
+                    success = writer.addRow(band.data() + row * width * 4);
+                }
+            }
+        }
+        CGImageRelease(image);
+
+        success = success && writer.finish() && fseeko(file, 0, SEEK_SET) == 0 &&
+                  fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  fwrite(writer.getTiles().data(), sizeof(TiledImageTile), writer.getTiles().size(), file) ==
+                      writer.getTiles().size();
+        success = fclose(file) == 0 && success;
+        if (!success) {
+            ofLogError("ofTiledImage") << "build(): failed to write " << outputPath;
+            remove(outputPath.c_str());
+        }
+        return success;
+    }
+}
+
+bool ofTiledImage::load(const std::string& path) {
+    close();
+    if (!Context::instance().renderer()) {
+        return false;
+    }
+
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        ofLogError("ofTiledImage") << "Failed to open " << path;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(TiledImageHeader))) {
+        ::close(fd);
+        ofLogError("ofTiledImage") << "Not a tile pyramid: " << path;
+        return false;
+    }
+    auto source = std::make_shared<TileSource>();
+    source->length = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, source->length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        ofLogError("ofTiledImage") << "Failed to map " << path;
+        return false;
+    }
+    source->mapping = mapping;
+
+    Impl& impl = *impl_;
+    memcpy(&impl.header, mapping, sizeof(TiledImageHeader));
+    if (!isValidTiledImage(impl.header, source->length)) {
+        ofLogError("ofTiledImage") << "Not a valid tile pyramid: " << path;
+        impl.header = {};
+        return false;
+    }
+    source->tiles = reinterpret_cast<const TiledImageTile*>(static_cast<const uint8_t*>(mapping) +
+                                                            impl.header.tableOffset);
+
+    uint64_t firstTile = 0;
+    for (uint32_t level = 0; level < impl.header.levelCount; level++) {
+        impl.levelFirstTile.push_back(firstTile);
+        impl.levelTilesX.push_back(tiledImageTilesAcross(tiledImageLevelSize(impl.header.width, level), impl.header.tileSize));
+        impl.levelTilesY.push_back(tiledImageTilesAcross(tiledImageLevelSize(impl.header.height, level), impl.header.tileSize));
+        firstTile += static_cast<uint64_t>(impl.levelTilesX.back()) * impl.levelTilesY.back();
+    }
+    impl.source = source;
+    impl.maxInFlight = std::max<size_t>(2 * [NSProcessInfo processInfo].activeProcessorCount, 4);
+
+    // The one-tile level stands in for everything not decoded yet
+    const uint32_t top = impl.header.levelCount - 1;
+    const uint64_t key = tileKey(top, 0, 0);
+    size_t size = 0;
+    const uint8_t* data = source->tileData(impl.tileIndex(key), size);
+    ofPixels pixels;
+    if (!impl.createCache() || !data ||
+        !decodeTile(data, size, impl.tileWidth(top, 0), impl.tileHeight(top, 0), pixels) ||
+        !impl.upload(key, pixels, Context::instance().getFrameNum(), true)) {
+        ofLogError("ofTiledImage") << "Failed to decode the top level of " << path;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ofTiledImage::close() {
+    Impl& impl = *impl_;
+    impl.source.reset();
+    impl.header = {};
+    impl.levelFirstTile.clear();
+    impl.levelTilesX.clear();
+    impl.levelTilesY.clear();
+    impl.slots.clear();
+    impl.cache.clear();
+    impl.resident.clear();
+    impl.pending.clear();
+    impl.failed.clear();
+    impl.missing = 0;
+}
+
+bool ofTiledImage::isLoaded() const {
+    return impl_->source != nullptr;
+}
+
+// ============================================================================
+// Properties
+// ============================================================================
+
+int ofTiledImage::getWidth() const {
+    return static_cast<int>(impl_->header.width);
+}
+
+int ofTiledImage::getHeight() const {
+    return static_cast<int>(impl_->header.height);
+}
+
+int ofTiledImage::getNumLevels() const {
+    return static_cast<int>(impl_->header.levelCount);
+}
+
+int ofTiledImage::getTileSize() const {
+    return static_cast<int>(impl_->header.tileSize);
+}
+
+// ============================================================================
+// Tile Cache
+// ============================================================================
+
+void ofTiledImage::setCacheTiles(int tiles) {
+    impl_->cacheTiles = std::max(tiles, 4);
+}
+
+int ofTiledImage::getCacheTiles() const {
+    return impl_->cacheTiles;
+}
+
+void ofTiledImage::setMaxUploadsPerFrame(int uploads) {
+    impl_->maxUploads = std::max(uploads, 1);
+}
+
+void ofTiledImage::setLodBias(float levels) {
+    impl_->lodBias = levels;
+}
+
+size_t ofTiledImage::getNumResidentTiles() const {
+    return impl_->resident.size();
+}
+
+size_t ofTiledImage::getNumPendingTiles() const {
+    return impl_->pending.size();
+}
+
+size_t ofTiledImage::getNumMissingTiles() const {
+    return impl_->missing;
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+void ofTiledImage::draw(float x, float y) const {
+    draw(x, y, static_cast<float>(getWidth()), static_cast<float>(getHeight()));
+}
+
+void ofTiledImage::draw(float x, float y, float w, float h) const {
+    Impl& impl = *impl_;
+    impl.missing = 0;
+    if (!isLoaded() || w == 0.0f || h == 0.0f) {
+        return;
+    }
+
+    auto& ctx = Context::instance();
+    Impl::View view;
+    view.frame = ctx.getFrameNum();
+    impl.uploadReady(view.frame);
+
+    const simd_float4 viewport = ctx.getViewport();
+    view.modelViewProjection = simd_mul(ctx.getProjectionMatrix(), ofGetCurrentModelViewMatrix());
+    view.viewportWidth = viewport.z;
+    view.viewportHeight = viewport.w;
+    view.x = x;
+    view.y = y;
+    view.scaleX = w / static_cast<float>(impl.header.width);
+    view.scaleY = h / static_cast<float>(impl.header.height);
+    view.refineDensity = std::exp2(impl.lodBias);
+
+    impl.visit(view, impl.header.levelCount - 1, 0, 0);
+}
+
+} // namespace oflike
@@ -1,4 +1,5 @@
 #include "ofLight.h"
+#include "ofShadow.h"
 #include "../../core/Context.h"
 #include <vector>
 #include <algorithm>
@@ -22,6 +23,7 @@ ofLight::ofLight()
     , attenuationQuadratic_(0.0f)
     , spotCutoff_(45.0f)
     , spotConcentration_(0.0f)
+    , shadow_(std::make_shared<ofShadow>())
 {
 }
 
@@ -232,6 +234,34 @@ float ofLight::getSpotConcentration() const {
     return spotConcentration_;
 }
 
+// ============================================================================
+// Shadows
+// ============================================================================
+
+ofShadow& ofLight::getShadow() {
+    return *shadow_;
+}
+
+const ofShadow& ofLight::getShadow() const {
+    return *shadow_;
+}
+
+bool ofLight::shouldRenderShadowDepthPass() const {
+    return enabled_ && getNumShadowDepthPasses() > 0;
+}
+
+int ofLight::getNumShadowDepthPasses() const {
+    return shadow_->getNumPasses(*this);
+}
+
+bool ofLight::beginShadowDepthPass(int pass) {
+    return enabled_ && shadow_->beginDepthPass(*this, pass);
+}
+
+void ofLight::endShadowDepthPass(int pass) {
+    shadow_->endDepthPass(*this, pass);
+}
+
 // ============================================================================
 // Internal State
 // ============================================================================
@@ -3,12 +3,15 @@
 // oflike-metal ofLight - openFrameworks API compatible light class
 // Provides point, directional, and spot light sources for 3D rendering
 
+#include <memory>
 #include <vector>
 #include "../math/ofVec3f.h"
 #include "../types/ofColor.h"
 
 namespace oflike {
 
+class ofShadow;
+
 /// \brief Light type enumeration
 enum class ofLightType {
     Point,        ///< Point light (omnidirectional)
@@ -226,6 +229,38 @@ public:
     /// \return Concentration exponent
     float getSpotConcentration() const;
 
+    // ========================================================================
+    // Shadows
+    // ========================================================================
+
+    /// \brief Get the light's shadow map settings
+    /// \details Shadows are off until getShadow().setEnabled(true). Copies of
+    /// a light share its shadow.
+    /// \return The shadow (see ofShadow)
+    ofShadow& getShadow();
+
+    /// \brief Get the light's shadow map settings
+    const ofShadow& getShadow() const;
+
+    /// \brief Check if shadow depth passes should be drawn this frame
+    /// \return true if the light is enabled and casts shadows
+    bool shouldRenderShadowDepthPass() const;
+
+    /// \brief Get the number of shadow depth passes
+    /// \return Cascades for directional lights, 1 for spot lights, 0 for point lights
+    int getNumShadowDepthPasses() const;
+
+    /// \brief Start drawing the shadow casters of one depth pass
+    /// \details Call inside the camera's begin()/end(), then draw the casters
+    /// and call endShadowDepthPass() with the same index.
+    /// \param pass Pass index (0 to getNumShadowDepthPasses() - 1)
+    /// \return false if nothing is recorded for the pass
+    bool beginShadowDepthPass(int pass = 0);
+
+    /// \brief Finish a shadow depth pass
+    /// \param pass Index passed to beginShadowDepthPass()
+    void endShadowDepthPass(int pass = 0);
+
     // ========================================================================
     // Internal State
     // ========================================================================
@@ -264,6 +299,9 @@ private:
     // Last registered data (for updating Context when properties change)
     std::vector<float> lastRegisteredData_;
 
+    // Shadow map (shared by copies)
+    std::shared_ptr<ofShadow> shadow_;
+
     // Internal: update registration in Context if enabled
     void updateRegistration();
 };
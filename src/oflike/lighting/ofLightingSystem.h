@@ -1,7 +1,7 @@
 #pragma once
 
 // oflike-metal Lighting System - Global light array management
-// Manages up to 8 active lights and uniform buffer data
+// Manages up to 256 active lights and uniform buffer data
 
 #include "ofLight.h"
 #include <vector>
@@ -11,11 +11,14 @@ namespace oflike {
 
 /// \brief Global lighting system manager
 /// \details Manages active lights and provides uniform data for shaders.
-/// Supports up to 8 simultaneous lights (hardware typical limit).
+/// Supports up to 256 simultaneous lights. Draws under more than 8 lights
+/// are shaded with clustered lighting: a compute pass bins the lights into
+/// screen tiles and depth slices, and each fragment only evaluates the
+/// lights whose range reaches its cluster.
 class ofLightingSystem {
 public:
-    /// Maximum number of lights supported (typical GPU limit)
-    static constexpr int MAX_LIGHTS = 8;
+    /// Maximum number of lights supported (render::kMaxLights)
+    static constexpr int MAX_LIGHTS = 256;
 
     /// \brief Get the singleton instance
     /// \return Reference to the global lighting system
@@ -23,7 +26,7 @@ public:
 
     /// \brief Register a light with the system
     /// \param light Pointer to the light to register
-    /// \return Light ID (0-7) or -1 if no slots available
+    /// \return Light ID (0 to MAX_LIGHTS - 1) or -1 if no slots available
     int registerLight(ofLight* light);
 
     /// \brief Unregister a light from the system
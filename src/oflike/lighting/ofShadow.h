@@ -0,0 +1,154 @@
+#pragma once
+
+// oflike-metal ofShadow - shadow maps for spot and directional lights
+// Casters are recorded once per depth pass and rendered depth-only into a
+// shadow map that lit draws sample with PCF
+
+#include <memory>
+#include <cstddef>
+
+namespace oflike {
+
+class ofLight;
+
+/// \brief Shadow map of one light
+/// \details Owned by an ofLight (ofLight::getShadow()). Each frame the scene's
+/// shadow casters are drawn once per depth pass, between
+/// ofLight::beginShadowDepthPass() and ofLight::endShadowDepthPass(), inside
+/// the camera's begin()/end(). The draws are recorded under the light's view
+/// and rendered depth-only into the shadow map; every lit draw afterwards
+/// darkens the diffuse and specular light of fragments the map occludes.
+///
+/// Features:
+/// - Spot lights render one perspective map covering the cone
+/// - Directional lights render up to 4 cascades, split along the camera's
+///   view depth and fitted around each slice, so the texel density follows
+///   the camera; cascades are snapped to whole texels and don't shimmer
+/// - A depth pass whose recorded casters and light matrices are unchanged
+///   since the map was last rendered is not rendered again: a static scene
+///   under a static light and camera costs only the recording
+/// - 3x3 PCF with hardware depth comparison
+///
+/// Implementation:
+/// - Point lights cast no shadows (getNumPasses() is 0)
+/// - Up to 4 shadow-casting lights are sampled per draw
+/// - Only 3D draws cast shadows; 2D drawing in a depth pass is ignored
+/// - Caster geometry is compared by content; instances written by the GPU
+///   (indirect draws) are not visible to the comparison, so such passes are
+///   rendered every frame
+///
+/// Example:
+/// \code
+///     light.setDirectional();
+///     light.getShadow().setEnabled(true);
+///
+///     cam.begin();
+///     if (light.shouldRenderShadowDepthPass()) {
+///         for (int i = 0; i < light.getNumShadowDepthPasses(); i++) {
+///             light.beginShadowDepthPass(i);
+///             drawScene();
+///             light.endShadowDepthPass(i);
+///         }
+///     }
+///     drawScene();
+///     cam.end();
+/// \endcode
+class ofShadow {
+public:
+    // ========================================================================
+    // Construction / Destruction
+    // ========================================================================
+
+    ofShadow();
+    ~ofShadow();
+
+    ofShadow(const ofShadow&) = delete;
+    ofShadow& operator=(const ofShadow&) = delete;
+
+    // ========================================================================
+    // Settings
+    // ========================================================================
+
+    /// \brief Enable or disable the shadow
+    /// \details Disabling releases the map and stops lit draws from sampling it.
+    void setEnabled(bool enabled);
+
+    /// \brief Check if the shadow is enabled
+    bool getIsEnabled() const;
+
+    /// \brief Set the shadow map size in texels (square, default 2048)
+    void setResolution(int resolution);
+
+    /// \brief Get the shadow map size in texels
+    int getResolution() const;
+
+    /// \brief Set the number of cascades of a directional light (1-4, default 3)
+    void setNumCascades(int cascades);
+
+    /// \brief Get the number of cascades of a directional light
+    int getNumCascades() const;
+
+    /// \brief Set how far from the camera a directional light casts shadows
+    /// \details The cascades split this distance (clamped to the camera's far
+    /// plane). Default 1000.
+    void setShadowDistance(float distance);
+
+    /// \brief Get the shadow distance of a directional light
+    float getShadowDistance() const;
+
+    /// \brief Set the depth range of a spot light's map (default 1 to 2000)
+    void setNearFar(float nearClip, float farClip);
+
+    /// \brief Set how dark shadows are (0 = invisible, 1 = no direct light, default 1)
+    void setStrength(float strength);
+
+    /// \brief Get the shadow strength
+    float getStrength() const;
+
+    /// \brief Set the depth biases against shadow acne
+    /// \param bias Subtracted from a fragment's shadow map depth before the
+    ///        comparison (default 0.0005)
+    /// \param slopeBias Slope-scaled bias applied while rendering the map
+    ///        (default 2)
+    void setBias(float bias, float slopeBias = 2.0f);
+
+    // ========================================================================
+    // Depth Passes
+    // ========================================================================
+
+    /// \brief Get the number of depth passes the light needs
+    /// \return Cascades for directional lights, 1 for spot lights, 0 otherwise
+    int getNumPasses(const ofLight& light) const;
+
+    /// \brief Start recording the casters of one depth pass
+    /// \details Call inside the camera's begin()/end(): directional cascades
+    /// are fitted to the current view and projection. Until endDepthPass() the
+    /// view and projection are the light's and draws are recorded instead of
+    /// drawn.
+    /// \param light Light casting the shadow
+    /// \param pass Pass index (0 to getNumPasses() - 1)
+    /// \return False if the pass can't be recorded (nothing is recorded)
+    bool beginDepthPass(const ofLight& light, int pass);
+
+    /// \brief Finish a depth pass started by beginDepthPass()
+    /// \details Adds the shadow map render to the frame unless the recording
+    /// matches what the map already holds.
+    void endDepthPass(const ofLight& light, int pass);
+
+    /// \brief Get the number of depth passes last rendered from cache
+    /// \details Counts passes of the most recent frame that were skipped
+    /// because their casters and light were unchanged.
+    int getNumCachedPasses() const;
+
+    /// \brief Discard the map contents; every pass renders again
+    void invalidate();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
+
+// Global namespace alias for openFrameworks compatibility
+using ofShadow = oflike::ofShadow;
@@ -0,0 +1,494 @@
+// ofShadow.mm - shadow maps for spot and directional lights
+
+#import <Metal/Metal.h>
+#include "ofShadow.h"
+#include "ofLight.h"
+#include "../graphics/ofDisplayList.h"
+#include "../math/ofMatrix4x4.h"
+#include "../../core/Context.h"
+#include "../../render/DrawList.h"
+#include "../../render/DrawCommand.h"
+#include "../../render/metal/MetalAllocations.h"
+#include <simd/simd.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace oflike {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+static constexpr int kDefaultResolution = 2048;
+static constexpr int kMaxResolution = 8192;
+
+// Blend between logarithmic and uniform cascade splits (practical split scheme)
+static constexpr float kSplitLambda = 0.75f;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+namespace {
+
+// FNV-1a over the parts of a recording that affect depth
+struct Hasher {
+    uint64_t value = 1469598103934665603ull;
+
+    void add(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++) {
+            value = (value ^ bytes[i]) * 1099511628211ull;
+        }
+    }
+
+    template <typename T>
+    void add(const T& v) {
+        add(&v, sizeof(T));
+    }
+
+    void add(const simd_float3& v) {
+        const float xyz[3] = {v.x, v.y, v.z};  // The fourth lane is padding
+        add(xyz, sizeof(xyz));
+    }
+};
+
+// Hash what the depth pass would render: draw ranges, transforms and
+// positions. Returns false if the casters can't be compared because the GPU
+// writes their instances or arguments.
+bool hashCasters(const render::DrawList& list, Hasher& hasher) {
+    for (render::CommandRef cmd : list.getCommands()) {
+        hasher.add(cmd.type);
+        switch (cmd.type) {
+            case render::CommandType::Draw3DIndirect:
+                return false;
+            case render::CommandType::Draw3D:
+            case render::CommandType::Draw3DInstanced: {
+                const render::DrawCommand3D& draw = cmd.as<render::DrawCommand3D>();
+                hasher.add(draw.vertexOffset);
+                hasher.add(draw.vertexCount);
+                hasher.add(draw.indexOffset);
+                hasher.add(draw.indexCount);
+                hasher.add(draw.primitiveType);
+                hasher.add(draw.modelViewMatrix);
+                hasher.add(draw.cullBackFace);
+                hasher.add(draw.vertexBuffer);
+                hasher.add(draw.indexBuffer);
+                if (cmd.type == render::CommandType::Draw3DInstanced) {
+                    const auto& instanced = cmd.as<render::DrawCommand3DInstanced>();
+                    if (instanced.instanceBuffer) {
+                        return false;
+                    }
+                    hasher.add(instanced.instanceOffset);
+                    hasher.add(instanced.instanceCount);
+                }
+                break;
+            }
+            case render::CommandType::DrawDisplayList: {
+                const auto& replay = cmd.as<render::DrawDisplayListCommand>();
+                hasher.add(replay.listId);
+                hasher.add(replay.transform3D);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    for (const render::Vertex3D& vertex : list.getVertices3D()) {
+        hasher.add(vertex.position);
+    }
+    hasher.add(list.getIndices().data(), list.getIndices().size() * sizeof(uint32_t));
+    const render::InstanceData* instances = list.getInstanceData();
+    for (size_t i = 0; i < list.getInstanceCount(); i++) {
+        hasher.add(instances[i].modelMatrix);
+    }
+    return true;
+}
+
+simd_float4x4 lightView(const simd_float3& eye, const simd_float3& direction) {
+    const simd_float3 up = std::abs(direction.y) > 0.99f ? simd_make_float3(0.0f, 0.0f, 1.0f)
+                                                          : simd_make_float3(0.0f, 1.0f, 0.0f);
+    const simd_float3 center = eye + direction;
+    return ofMatrix4x4::newLookAtMatrix(ofVec3f(eye.x, eye.y, eye.z), ofVec3f(center.x, center.y, center.z),
+                                        ofVec3f(up.x, up.y, up.z)).toSimd();
+}
+
+// Projections with Metal's [0, 1] depth range, as ofCamera builds them
+simd_float4x4 perspectiveProjection(float fovY, float nearClip, float farClip) {
+    const float yScale = 1.0f / std::tan(fovY * 0.5f * (float)M_PI / 180.0f);
+    simd_float4x4 m = {};
+    m.columns[0] = simd_make_float4(yScale, 0.0f, 0.0f, 0.0f);
+    m.columns[1] = simd_make_float4(0.0f, yScale, 0.0f, 0.0f);
+    m.columns[2] = simd_make_float4(0.0f, 0.0f, farClip / (nearClip - farClip), -1.0f);
+    m.columns[3] = simd_make_float4(0.0f, 0.0f, nearClip * farClip / (nearClip - farClip), 0.0f);
+    return m;
+}
+
+simd_float4x4 orthoProjection(float left, float right, float bottom, float top, float nearClip, float farClip) {
+    simd_float4x4 m = {};
+    m.columns[0] = simd_make_float4(2.0f / (right - left), 0.0f, 0.0f, 0.0f);
+    m.columns[1] = simd_make_float4(0.0f, 2.0f / (top - bottom), 0.0f, 0.0f);
+    m.columns[2] = simd_make_float4(0.0f, 0.0f, -1.0f / (farClip - nearClip), 0.0f);
+    m.columns[3] = simd_make_float4(-(right + left) / (right - left), -(top + bottom) / (top - bottom),
+                                    -nearClip / (farClip - nearClip), 1.0f);
+    return m;
+}
+
+// Point at view depth on the ray through an NDC point
+simd_float3 frustumPoint(const simd_float4x4& inverseProjection, float x, float y, float depth) {
+    const simd_float4 a = simd_mul(inverseProjection, simd_make_float4(x, y, 0.0f, 1.0f));
+    const simd_float4 b = simd_mul(inverseProjection, simd_make_float4(x, y, 1.0f, 1.0f));
+    const simd_float3 p0 = simd_make_float3(a) / a.w;
+    const simd_float3 p1 = simd_make_float3(b) / b.w;
+    const float t = (-depth - p0.z) / (p1.z - p0.z);
+    return p0 + t * (p1 - p0);
+}
+
+}  // namespace
+
+// ============================================================================
+// ofShadow::Impl
+// ============================================================================
+
+struct ofShadow::Impl {
+    struct Pass {
+        render::DrawList lists[2];          // Recorded casters; the one not in use records next
+        int current = 0;                    // List the map was last rendered from
+        uint64_t listId = 0;                // Its recording id, 0 = map slice not rendered
+        uint64_t hash = 0;
+        bool comparable = false;
+        simd_float4x4 view = matrix_identity_float4x4;
+        simd_float4x4 projection = matrix_identity_float4x4;
+    };
+
+    bool enabled = false;
+    int resolution = kDefaultResolution;
+    int cascades = 3;
+    float shadowDistance = 1000.0f;
+    float nearClip = 1.0f;
+    float farClip = 2000.0f;
+    float strength = 1.0f;
+    float bias = 0.0005f;
+    float slopeBias = 2.0f;
+
+    id<MTLTexture> shadowMap = nil;
+    Pass passes[render::kMaxShadowCascades];
+    unsigned long long preparedFrame = ~0ull;
+    int passCount = 0;
+
+    // Recording state
+    int recordingPass = -1;
+    render::DrawList* previousList = nullptr;
+
+    int cachedPasses = 0;
+
+    ~Impl() {
+        if (Context::instance().isInitialized()) {
+            Context::instance().clearLightShadow(this);
+        }
+    }
+
+    void invalidate() {
+        for (Pass& pass : passes) {
+            pass.listId = 0;
+        }
+    }
+
+    void release() {
+        Context::instance().clearLightShadow(this);
+        shadowMap = nil;
+        preparedFrame = ~0ull;
+        invalidate();
+    }
+
+    bool ensureShadowMap(int slices) {
+        if (shadowMap && (int)shadowMap.width == resolution && (int)shadowMap.arrayLength == slices) {
+            return true;
+        }
+
+        id<MTLDevice> device = (__bridge id<MTLDevice>)Context::instance().getMetalDevice();
+        if (!device) {
+            return false;
+        }
+        MTLTextureDescriptor* desc = [MTLTextureDescriptor
+            texture2DDescriptorWithPixelFormat:MTLPixelFormatDepth32Float
+                                         width:resolution
+                                        height:resolution
+                                     mipmapped:NO];
+        desc.textureType = MTLTextureType2DArray;
+        desc.arrayLength = slices;
+        desc.usage = MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead;
+        desc.storageMode = MTLStorageModePrivate;
+        shadowMap = render::metal::makeTrackedTexture(device, desc, ofGpuMemoryCategory::RenderTargets,
+                                                      "ShadowMap");
+        if (!shadowMap) {
+            return false;
+        }
+        invalidate();
+        return true;
+    }
+
+    // Fit the light matrices of every pass for this frame and register the map
+    bool prepare(const ofLight& light, int count) {
+        auto& ctx = Context::instance();
+        if (preparedFrame == ctx.getFrameNum() && passCount == count && shadowMap) {
+            return true;
+        }
+        if (!ensureShadowMap(count)) {
+            return false;
+        }
+
+        const ofVec3f position = light.getPosition();
+        ofVec3f direction = light.getDirection();
+        if (direction.length() < 1e-6f) {
+            direction.set(0.0f, 0.0f, -1.0f);
+        }
+        const simd_float3 dir = simd_normalize(simd_make_float3(direction.x, direction.y, direction.z));
+
+        render::ShadowLight shadow = {};
+        shadow.cascadeCount = count;
+        shadow.bias = bias;
+        shadow.strength = strength;
+        shadow.texelSize = 1.0f / resolution;
+
+        if (light.getLightType() == ofLightType::Spot) {
+            Pass& pass = passes[0];
+            const float fov = std::clamp(light.getSpotlightCutOff() * 2.0f, 1.0f, 170.0f);
+            pass.view = lightView(simd_make_float3(position.x, position.y, position.z), dir);
+            pass.projection = perspectiveProjection(fov, nearClip, farClip);
+            shadow.matrices[0] = simd_mul(pass.projection, pass.view);
+            shadow.splits = simd_make_float4(FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX);
+        } else {
+            // Cascades split the camera's view depth; each is an ortho box
+            // around the bounding sphere of its frustum slice, so its size
+            // doesn't change as the camera turns, moved in whole texels
+            const simd_float4x4 inverseView = simd_inverse(ctx.getViewMatrix());
+            const simd_float4x4 inverseProjection = simd_inverse(ctx.getProjectionMatrix());
+            auto depthAt = [&](float ndcZ) {
+                const simd_float4 p = simd_mul(inverseProjection, simd_make_float4(0.0f, 0.0f, ndcZ, 1.0f));
+                return -p.z / p.w;
+            };
+            const float nearZ = std::max(depthAt(0.0f), 1e-3f);
+            float farZ = depthAt(1.0f);
+            if (!std::isfinite(farZ) || farZ <= nearZ) {
+                farZ = nearZ + shadowDistance;
+            }
+            farZ = std::min(farZ, nearZ + shadowDistance);
+
+            const simd_float4x4 rotation = lightView(simd_make_float3(0.0f, 0.0f, 0.0f), dir);
+            float splitStart = nearZ;
+            for (int i = 0; i < count; i++) {
+                const float t = float(i + 1) / count;
+                const float logSplit = nearZ * std::pow(farZ / nearZ, t);
+                const float uniformSplit = nearZ + (farZ - nearZ) * t;
+                const float splitEnd = kSplitLambda * logSplit + (1.0f - kSplitLambda) * uniformSplit;
+
+                simd_float3 corners[8];
+                simd_float3 center = simd_make_float3(0.0f, 0.0f, 0.0f);
+                for (int c = 0; c < 8; c++) {
+                    const float x = (c & 1) ? 1.0f : -1.0f;
+                    const float y = (c & 2) ? 1.0f : -1.0f;
+                    const simd_float3 p = frustumPoint(inverseProjection, x, y, (c & 4) ? splitEnd : splitStart);
+                    corners[c] = simd_make_float3(simd_mul(inverseView, simd_make_float4(p, 1.0f)));
+                    center += corners[c] / 8.0f;
+                }
+                float radius = 0.0f;
+                for (const simd_float3& corner : corners) {
+                    radius = std::max(radius, simd_distance(corner, center));
+                }
+                radius = std::ceil(radius * 16.0f) / 16.0f;
+
+                const float texel = 2.0f * radius / resolution;
+                simd_float3 lightCenter = simd_make_float3(simd_mul(rotation, simd_make_float4(center, 1.0f)));
+                lightCenter.x = std::floor(lightCenter.x / texel) * texel;
+                lightCenter.y = std::floor(lightCenter.y / texel) * texel;
+
+                // Casters up to shadowDistance towards the light still shadow the slice
+                Pass& pass = passes[i];
+                pass.view = rotation;
+                pass.projection = orthoProjection(lightCenter.x - radius, lightCenter.x + radius,
+                                                  lightCenter.y - radius, lightCenter.y + radius,
+                                                  -lightCenter.z - radius - shadowDistance,
+                                                  -lightCenter.z + radius);
+                shadow.matrices[i] = simd_mul(pass.projection, pass.view);
+                shadow.splits[i] = splitEnd;
+                splitStart = splitEnd;
+            }
+            for (int i = count; i < (int)render::kMaxShadowCascades; i++) {
+                shadow.splits[i] = FLT_MAX;
+            }
+        }
+
+        ctx.setLightShadow(this, light.getUniformData(), (__bridge void*)shadowMap, shadow);
+        if (preparedFrame != ctx.getFrameNum()) {
+            cachedPasses = 0;
+        }
+        preparedFrame = ctx.getFrameNum();
+        passCount = count;
+        return true;
+    }
+};
+
+// ============================================================================
+// ofShadow Implementation
+// ============================================================================
+
+ofShadow::ofShadow()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ofShadow::~ofShadow() = default;
+
+// ============================================================================
+// Settings
+// ============================================================================
+
+void ofShadow::setEnabled(bool enabled) {
+    if (impl_->enabled && !enabled) {
+        impl_->release();
+    }
+    impl_->enabled = enabled;
+}
+
+bool ofShadow::getIsEnabled() const {
+    return impl_->enabled;
+}
+
+void ofShadow::setResolution(int resolution) {
+    impl_->resolution = std::clamp(resolution, 16, kMaxResolution);
+}
+
+int ofShadow::getResolution() const {
+    return impl_->resolution;
+}
+
+void ofShadow::setNumCascades(int cascades) {
+    impl_->cascades = std::clamp(cascades, 1, (int)render::kMaxShadowCascades);
+}
+
+int ofShadow::getNumCascades() const {
+    return impl_->cascades;
+}
+
+void ofShadow::setShadowDistance(float distance) {
+    impl_->shadowDistance = std::max(distance, 1e-3f);
+}
+
+float ofShadow::getShadowDistance() const {
+    return impl_->shadowDistance;
+}
+
+void ofShadow::setNearFar(float nearClip, float farClip) {
+    impl_->nearClip = std::max(nearClip, 1e-3f);
+    impl_->farClip = std::max(farClip, impl_->nearClip + 1e-3f);
+}
+
+void ofShadow::setStrength(float strength) {
+    impl_->strength = std::clamp(strength, 0.0f, 1.0f);
+}
+
+float ofShadow::getStrength() const {
+    return impl_->strength;
+}
+
+void ofShadow::setBias(float bias, float slopeBias) {
+    impl_->bias = bias;
+    impl_->slopeBias = slopeBias;
+}
+
+// ============================================================================
+// Depth Passes
+// ============================================================================
+
+int ofShadow::getNumPasses(const ofLight& light) const {
+    if (!impl_->enabled) {
+        return 0;
+    }
+    switch (light.getLightType()) {
+        case ofLightType::Directional:
+            return impl_->cascades;
+        case ofLightType::Spot:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+bool ofShadow::beginDepthPass(const ofLight& light, int pass) {
+    const int count = getNumPasses(light);
+    auto& ctx = Context::instance();
+    if (pass < 0 || pass >= count || impl_->recordingPass >= 0 || !ctx.isInitialized()) {
+        return false;
+    }
+    if (!impl_->prepare(light, count)) {
+        return false;
+    }
+
+    Impl::Pass& state = impl_->passes[pass];
+    render::DrawList& list = state.lists[state.current ^ 1];
+    list.reset();
+    list.setVertexCompression(ctx.getDrawList().isVertexCompressionEnabled());
+    list.setMeshPrimitives(false);  // Caster hashes read the vertices
+    impl_->previousList = ctx.getThreadDrawList();
+    ctx.bindThreadDrawList(&list);
+    impl_->recordingPass = pass;
+
+    ctx.pushView();
+    ctx.setViewMatrix(state.view);
+    ctx.setProjectionMatrix(state.projection);
+    return true;
+}
+
+void ofShadow::endDepthPass(const ofLight& light, int pass) {
+    (void)light;
+    if (impl_->recordingPass != pass) {
+        return;
+    }
+
+    auto& ctx = Context::instance();
+    ctx.popView();
+    ctx.bindThreadDrawList(impl_->previousList);
+    impl_->previousList = nullptr;
+    impl_->recordingPass = -1;
+
+    Impl::Pass& state = impl_->passes[pass];
+    const int next = state.current ^ 1;
+    render::DrawList& list = state.lists[next];
+
+    Hasher hasher;
+    const bool comparable = hashCasters(list, hasher);
+    hasher.add(state.view);
+    hasher.add(state.projection);
+    if (comparable && state.comparable && state.listId != 0 && hasher.value == state.hash) {
+        // The map slice already holds this depth
+        impl_->cachedPasses++;
+        return;
+    }
+
+    list.optimize();
+    render::RenderShadowMapCommand cmd;
+    cmd.casters = &list;
+    cmd.listId = allocateDisplayListId();
+    cmd.replacesListId = state.listId;
+    cmd.shadowMap = (__bridge void*)impl_->shadowMap;
+    cmd.slice = static_cast<uint32_t>(pass);
+    cmd.projectionMatrix = state.projection;
+    cmd.slopeBias = impl_->slopeBias;
+    ctx.getDrawList().addCommand(cmd);
+
+    state.current = next;
+    state.listId = cmd.listId;
+    state.hash = hasher.value;
+    state.comparable = comparable;
+}
+
+int ofShadow::getNumCachedPasses() const {
+    return impl_->cachedPasses;
+}
+
+void ofShadow::invalidate() {
+    impl_->invalidate();
+}
+
+} // namespace oflike
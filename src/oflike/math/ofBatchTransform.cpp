@@ -0,0 +1,162 @@
+#include "ofBatchTransform.h"
+#include <algorithm>
+#include <cmath>
+#include <simd/simd.h>
+#include <dispatch/dispatch.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+using oflike::ofMatrix4x4;
+using oflike::ofVec3f;
+
+namespace {
+    // The kernels read and write ofVec3f arrays as interleaved float triples
+    static_assert(sizeof(ofVec3f) == 3 * sizeof(float), "ofVec3f must be three packed floats");
+
+    constexpr size_t kParallelCount = 65536;    // Smaller arrays stay on the calling thread
+    constexpr size_t kChunk = 16384;            // Points per task
+
+    // Run body(begin, end) over chunks of [0, count), on the global queue for large counts
+    template <typename Body>
+    void parallelChunks(size_t count, const Body& body) {
+        if (count < kParallelCount) {
+            body(0, count);
+            return;
+        }
+        struct Job {
+            const Body* body;
+            size_t count;
+        } job = {&body, count};
+        dispatch_apply_f((count + kChunk - 1) / kChunk, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0),
+                         &job, [](void* context, size_t chunk) {
+                             const Job* job = static_cast<const Job*>(context);
+                             const size_t begin = chunk * kChunk;
+                             (*job->body)(begin, std::min(job->count, begin + kChunk));
+                         });
+    }
+
+    // Each kernel transforms one vector, and with NEON four at once with
+    // x, y and z in separate registers (vld3q/vst3q deinterleave the triples)
+
+    struct PointKernel {
+        simd_float4x4 m;
+
+        ofVec3f operator()(const ofVec3f& v) const {
+            const simd_float4 p = m.columns[0] * v.x + m.columns[1] * v.y + m.columns[2] * v.z + m.columns[3];
+            return ofVec3f(p.x, p.y, p.z);
+        }
+
+#if defined(__ARM_NEON)
+        float32x4x3_t operator()(const float32x4x3_t& v) const {
+            float32x4x3_t r;
+            for (int row = 0; row < 3; ++row) {
+                float32x4_t t = vdupq_n_f32(m.columns[3][row]);
+                t = vfmaq_n_f32(t, v.val[0], m.columns[0][row]);
+                t = vfmaq_n_f32(t, v.val[1], m.columns[1][row]);
+                r.val[row] = vfmaq_n_f32(t, v.val[2], m.columns[2][row]);
+            }
+            return r;
+        }
+#endif
+    };
+
+    struct ProjectKernel {
+        simd_float4x4 m;
+
+        ofVec3f operator()(const ofVec3f& v) const {
+            const simd_float4 p = m.columns[0] * v.x + m.columns[1] * v.y + m.columns[2] * v.z + m.columns[3];
+            const float w = p.w != 0.0f ? p.w : 1.0f;
+            return ofVec3f(p.x / w, p.y / w, p.z / w);
+        }
+
+#if defined(__ARM_NEON)
+        float32x4x3_t operator()(const float32x4x3_t& v) const {
+            float32x4_t rows[4];
+            for (int row = 0; row < 4; ++row) {
+                float32x4_t t = vdupq_n_f32(m.columns[3][row]);
+                t = vfmaq_n_f32(t, v.val[0], m.columns[0][row]);
+                t = vfmaq_n_f32(t, v.val[1], m.columns[1][row]);
+                rows[row] = vfmaq_n_f32(t, v.val[2], m.columns[2][row]);
+            }
+            const float32x4_t w = vbslq_f32(vceqzq_f32(rows[3]), vdupq_n_f32(1.0f), rows[3]);
+            float32x4x3_t r;
+            r.val[0] = vdivq_f32(rows[0], w);
+            r.val[1] = vdivq_f32(rows[1], w);
+            r.val[2] = vdivq_f32(rows[2], w);
+            return r;
+        }
+#endif
+    };
+
+    struct NormalKernel {
+        simd_float3x3 m;
+        bool normalize;
+
+        ofVec3f operator()(const ofVec3f& v) const {
+            simd_float3 n = m.columns[0] * v.x + m.columns[1] * v.y + m.columns[2] * v.z;
+            if (normalize) {
+                const float length2 = simd_length_squared(n);
+                n = length2 > 0.0f ? n / sqrtf(length2) : n;
+            }
+            return ofVec3f(n.x, n.y, n.z);
+        }
+
+#if defined(__ARM_NEON)
+        float32x4x3_t operator()(const float32x4x3_t& v) const {
+            float32x4x3_t r;
+            for (int row = 0; row < 3; ++row) {
+                float32x4_t t = vmulq_n_f32(v.val[0], m.columns[0][row]);
+                t = vfmaq_n_f32(t, v.val[1], m.columns[1][row]);
+                r.val[row] = vfmaq_n_f32(t, v.val[2], m.columns[2][row]);
+            }
+            if (normalize) {
+                float32x4_t length2 = vmulq_f32(r.val[0], r.val[0]);
+                length2 = vfmaq_f32(length2, r.val[1], r.val[1]);
+                length2 = vfmaq_f32(length2, r.val[2], r.val[2]);
+                const float32x4_t length = vbslq_f32(vceqzq_f32(length2), vdupq_n_f32(1.0f), vsqrtq_f32(length2));
+                r.val[0] = vdivq_f32(r.val[0], length);
+                r.val[1] = vdivq_f32(r.val[1], length);
+                r.val[2] = vdivq_f32(r.val[2], length);
+            }
+            return r;
+        }
+#endif
+    };
+
+    template <typename Kernel>
+    void transformArray(const Kernel& kernel, const ofVec3f* in, ofVec3f* out, size_t count) {
+        if (!in || !out || count == 0) {
+            return;
+        }
+        parallelChunks(count, [&](size_t begin, size_t end) {
+            size_t i = begin;
+#if defined(__ARM_NEON)
+            // Each block is loaded before it is stored, so in == out is safe
+            for (; i + 4 <= end; i += 4) {
+                vst3q_f32(&out[i].x, kernel(vld3q_f32(&in[i].x)));
+            }
+#endif
+            for (; i < end; ++i) {
+                out[i] = kernel(in[i]);
+            }
+        });
+    }
+} // namespace
+
+void ofTransformPoints(const ofMatrix4x4& matrix, const ofVec3f* in, ofVec3f* out, size_t count) {
+    transformArray(PointKernel{matrix.toSimd()}, in, out, count);
+}
+
+void ofTransformNormals(const ofMatrix4x4& matrix, const ofVec3f* in, ofVec3f* out, size_t count, bool normalize) {
+    const simd_float4x4 m = matrix.toSimd();
+    const simd_float3x3 linear = simd_matrix(simd_make_float3(m.columns[0].x, m.columns[0].y, m.columns[0].z),
+                                             simd_make_float3(m.columns[1].x, m.columns[1].y, m.columns[1].z),
+                                             simd_make_float3(m.columns[2].x, m.columns[2].y, m.columns[2].z));
+    transformArray(NormalKernel{simd_transpose(simd_inverse(linear)), normalize}, in, out, count);
+}
+
+void ofProjectPoints(const ofMatrix4x4& matrix, const ofVec3f* in, ofVec3f* out, size_t count) {
+    transformArray(ProjectKernel{matrix.toSimd()}, in, out, count);
+}
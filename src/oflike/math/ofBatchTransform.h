@@ -0,0 +1,50 @@
+#pragma once
+
+// oflike-metal ofBatchTransform - transform arrays of points and normals
+// Four vectors per SIMD step, split across cores for large arrays, instead
+// of one matrix * vector call per element
+
+#include <cstddef>
+#include <vector>
+#include "ofMatrix4x4.h"
+#include "ofVec3f.h"
+
+/// \brief Transform points by an affine matrix (w = 1, no perspective divide)
+/// \details Arrays of 64K points and more are split across cores. in and out
+/// may be the same array but must not otherwise overlap.
+/// \param matrix Transform (its bottom row is ignored)
+/// \param in Source points
+/// \param out Receives count transformed points
+/// \param count Number of points
+void ofTransformPoints(const oflike::ofMatrix4x4& matrix, const oflike::ofVec3f* in, oflike::ofVec3f* out,
+                       size_t count);
+
+/// \brief Transform normals by the inverse transpose of the matrix's upper 3x3
+/// \details Correct under non-uniform scale; translation is ignored. Same
+/// aliasing rules as ofTransformPoints().
+/// \param normalize Rescale the results to unit length (zero normals stay zero)
+void ofTransformNormals(const oflike::ofMatrix4x4& matrix, const oflike::ofVec3f* in, oflike::ofVec3f* out,
+                        size_t count, bool normalize = true);
+
+/// \brief Transform points by a projective matrix and divide by w
+/// \details For model-view-projection matrices: the results are normalized
+/// device coordinates. Points with w = 0 are not divided. Same aliasing
+/// rules as ofTransformPoints().
+void ofProjectPoints(const oflike::ofMatrix4x4& matrix, const oflike::ofVec3f* in, oflike::ofVec3f* out,
+                     size_t count);
+
+/// \brief Transform points in place
+inline void ofTransformPoints(const oflike::ofMatrix4x4& matrix, std::vector<oflike::ofVec3f>& points) {
+    ofTransformPoints(matrix, points.data(), points.data(), points.size());
+}
+
+/// \brief Transform normals in place
+inline void ofTransformNormals(const oflike::ofMatrix4x4& matrix, std::vector<oflike::ofVec3f>& normals,
+                               bool normalize = true) {
+    ofTransformNormals(matrix, normals.data(), normals.data(), normals.size(), normalize);
+}
+
+/// \brief Project points in place
+inline void ofProjectPoints(const oflike::ofMatrix4x4& matrix, std::vector<oflike::ofVec3f>& points) {
+    ofProjectPoints(matrix, points.data(), points.data(), points.size());
+}
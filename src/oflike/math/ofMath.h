@@ -3,14 +3,17 @@
 #include <cmath>
 #include <random>
 #include <algorithm>
+#include "ofNoise.h"
+#include "ofRandom.h"
 
 /// openFrameworks-compatible math utility functions
 /// Provides random numbers, noise, mapping, clamping, interpolation, distance, and angle conversion
 ///
 /// Phase 3.7: Math utility functions
-/// - ofRandom() / ofRandomf() / ofRandomuf() - random number generation
-/// - ofSeedRandom() - seed random generator
-/// - ofNoise() / ofSignedNoise() - Perlin noise (simplified)
+/// - ofRandom() / ofRandomf() / ofRandomuf() - random number generation (ofRandom.h)
+/// - ofSeedRandom() - seed the calling thread's generator
+/// - ofRandomFill() / ofRandomStream - bulk and seedable random numbers
+/// - ofNoise() / ofSignedNoise() - simplex noise, ofPerlinNoise() - Perlin noise (ofNoise.h)
 /// - ofMap() - map value from one range to another
 /// - ofClamp() - constrain value to range
 /// - ofLerp() - linear interpolation
@@ -26,165 +29,6 @@ constexpr float HALF_PI = PI * 0.5f;
 constexpr float DEG_TO_RAD = PI / 180.0f;
 constexpr float RAD_TO_DEG = 180.0f / PI;
 
-// MARK: - Random Number Generation
-
-/// Generate random float in range [0, max)
-/// @param max Upper bound (exclusive)
-/// @return Random float in [0, max)
-inline float ofRandom(float max) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> dis(0.0f, max);
-    return dis(gen);
-}
-
-/// Generate random float in range [min, max)
-/// @param min Lower bound (inclusive)
-/// @param max Upper bound (exclusive)
-/// @return Random float in [min, max)
-inline float ofRandom(float min, float max) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> dis(min, max);
-    return dis(gen);
-}
-
-/// Generate random float in range [0.0, 1.0)
-/// @return Random float in [0.0, 1.0)
-inline float ofRandomf() {
-    return ofRandom(0.0f, 1.0f);
-}
-
-/// Generate random float in range [0.0, 1.0)
-/// Alias for ofRandomf()
-/// @return Random float in [0.0, 1.0)
-inline float ofRandomuf() {
-    return ofRandomf();
-}
-
-/// Seed random number generator
-/// @param seed Seed value
-inline void ofSeedRandom(int seed) {
-    static std::mt19937 gen;
-    gen.seed(seed);
-}
-
-// MARK: - Noise Functions
-
-/// Simple Perlin noise implementation
-/// Returns value in range [0, 1]
-/// @param x Input coordinate
-/// @return Noise value in [0, 1]
-inline float ofNoise(float x) {
-    // Simplified 1D Perlin noise approximation using sin
-    // This is a basic implementation; for production use, consider a proper Perlin noise library
-    float i = std::floor(x);
-    float f = x - i;
-    float u = f * f * (3.0f - 2.0f * f);
-
-    auto hash = [](float n) -> float {
-        return std::fmod(std::sin(n) * 43758.5453f, 1.0f);
-    };
-
-    float v1 = hash(i);
-    float v2 = hash(i + 1.0f);
-    return (v1 + (v2 - v1) * u) * 0.5f + 0.5f;
-}
-
-/// Simple 2D Perlin noise
-/// Returns value in range [0, 1]
-/// @param x Input x coordinate
-/// @param y Input y coordinate
-/// @return Noise value in [0, 1]
-inline float ofNoise(float x, float y) {
-    auto hash2 = [](float x, float y) -> float {
-        return std::fmod(std::sin(x * 12.9898f + y * 78.233f) * 43758.5453f, 1.0f);
-    };
-
-    float ix = std::floor(x);
-    float iy = std::floor(y);
-    float fx = x - ix;
-    float fy = y - iy;
-
-    float ux = fx * fx * (3.0f - 2.0f * fx);
-    float uy = fy * fy * (3.0f - 2.0f * fy);
-
-    float a = hash2(ix, iy);
-    float b = hash2(ix + 1.0f, iy);
-    float c = hash2(ix, iy + 1.0f);
-    float d = hash2(ix + 1.0f, iy + 1.0f);
-
-    float v1 = a + (b - a) * ux;
-    float v2 = c + (d - c) * ux;
-    return (v1 + (v2 - v1) * uy) * 0.5f + 0.5f;
-}
-
-/// Simple 3D Perlin noise
-/// Returns value in range [0, 1]
-/// @param x Input x coordinate
-/// @param y Input y coordinate
-/// @param z Input z coordinate
-/// @return Noise value in [0, 1]
-inline float ofNoise(float x, float y, float z) {
-    auto hash3 = [](float x, float y, float z) -> float {
-        return std::fmod(std::sin(x * 12.9898f + y * 78.233f + z * 37.719f) * 43758.5453f, 1.0f);
-    };
-
-    float ix = std::floor(x);
-    float iy = std::floor(y);
-    float iz = std::floor(z);
-    float fx = x - ix;
-    float fy = y - iy;
-    float fz = z - iz;
-
-    float ux = fx * fx * (3.0f - 2.0f * fx);
-    float uy = fy * fy * (3.0f - 2.0f * fy);
-    float uz = fz * fz * (3.0f - 2.0f * fz);
-
-    float a = hash3(ix, iy, iz);
-    float b = hash3(ix + 1.0f, iy, iz);
-    float c = hash3(ix, iy + 1.0f, iz);
-    float d = hash3(ix + 1.0f, iy + 1.0f, iz);
-    float e = hash3(ix, iy, iz + 1.0f);
-    float f = hash3(ix + 1.0f, iy, iz + 1.0f);
-    float g = hash3(ix, iy + 1.0f, iz + 1.0f);
-    float h = hash3(ix + 1.0f, iy + 1.0f, iz + 1.0f);
-
-    float k0 = a + (b - a) * ux;
-    float k1 = c + (d - c) * ux;
-    float k2 = e + (f - e) * ux;
-    float k3 = g + (h - g) * ux;
-
-    float k4 = k0 + (k1 - k0) * uy;
-    float k5 = k2 + (k3 - k2) * uy;
-
-    return (k4 + (k5 - k4) * uz) * 0.5f + 0.5f;
-}
-
-/// Signed noise - returns value in range [-1, 1]
-/// @param x Input coordinate
-/// @return Noise value in [-1, 1]
-inline float ofSignedNoise(float x) {
-    return ofNoise(x) * 2.0f - 1.0f;
-}
-
-/// Signed 2D noise - returns value in range [-1, 1]
-/// @param x Input x coordinate
-/// @param y Input y coordinate
-/// @return Noise value in [-1, 1]
-inline float ofSignedNoise(float x, float y) {
-    return ofNoise(x, y) * 2.0f - 1.0f;
-}
-
-/// Signed 3D noise - returns value in range [-1, 1]
-/// @param x Input x coordinate
-/// @param y Input y coordinate
-/// @param z Input z coordinate
-/// @return Noise value in [-1, 1]
-inline float ofSignedNoise(float x, float y, float z) {
-    return ofNoise(x, y, z) * 2.0f - 1.0f;
-}
-
 // MARK: - Mapping and Clamping
 
 /// Map value from one range to another
@@ -0,0 +1,734 @@
+#pragma once
+
+// oflike-metal ofNoise - gradient Perlin and simplex noise in 1-4D
+// Scalar calls, batches evaluated four points at a time with simd_float4,
+// and noise fields; shaders/Noise.metal computes the same noise on the GPU
+
+#include <simd/simd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/// Noise algorithm
+/// Perlin noise is 0 at integer coordinates and repeats every 256 units
+/// along each axis; simplex noise has no grid-aligned artefacts or period
+/// and is cheaper in 3D and 4D.
+enum class ofNoiseType {
+    Simplex,    ///< Gustavson's simplex noise, as openFrameworks' ofNoise()
+    Perlin      ///< Perlin's improved gradient noise
+};
+
+namespace oflike {
+namespace detail {
+
+// ============================================================================
+// Tables (copied into shaders/Noise.metal; keep them in sync)
+// ============================================================================
+
+/// Ken Perlin's reference permutation
+inline constexpr uint8_t kNoisePerm[256] = {
+    151, 160, 137, 91, 90, 15, 131, 13, 201, 95, 96, 53, 194, 233, 7, 225,
+    140, 36, 103, 30, 69, 142, 8, 99, 37, 240, 21, 10, 23, 190, 6, 148,
+    247, 120, 234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32,
+    57, 177, 33, 88, 237, 149, 56, 87, 174, 20, 125, 136, 171, 168, 68, 175,
+    74, 165, 71, 134, 139, 48, 27, 166, 77, 146, 158, 231, 83, 111, 229, 122,
+    60, 211, 133, 230, 220, 105, 92, 41, 55, 46, 245, 40, 244, 102, 143, 54,
+    65, 25, 63, 161, 1, 216, 80, 73, 209, 76, 132, 187, 208, 89, 18, 169,
+    200, 196, 135, 130, 116, 188, 159, 86, 164, 100, 109, 198, 173, 186, 3, 64,
+    52, 217, 226, 250, 124, 123, 5, 202, 38, 147, 118, 126, 255, 82, 85, 212,
+    207, 206, 59, 227, 47, 16, 58, 17, 182, 189, 28, 42, 223, 183, 170, 213,
+    119, 248, 152, 2, 44, 154, 163, 70, 221, 153, 101, 155, 167, 43, 172, 9,
+    129, 22, 39, 253, 19, 98, 108, 110, 79, 113, 224, 232, 178, 185, 112, 104,
+    218, 246, 97, 228, 251, 34, 242, 193, 238, 210, 144, 12, 191, 179, 162, 241,
+    81, 51, 145, 235, 249, 14, 239, 107, 49, 192, 214, 31, 181, 199, 106, 157,
+    184, 84, 204, 176, 115, 121, 50, 45, 127, 4, 150, 254, 138, 236, 205, 93,
+    222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66, 215, 61, 156, 180,
+};
+
+/// 1D gradients: +-1..8, indexed by hash & 15
+inline constexpr float kNoiseGrad1[16] = {
+    1, 2, 3, 4, 5, 6, 7, 8, -1, -2, -3, -4, -5, -6, -7, -8,
+};
+
+/// 2D gradients, indexed by hash & 7
+inline constexpr float kNoiseGrad2[8][2] = {
+    {1, 2}, {-1, 2}, {1, -2}, {-1, -2}, {2, 1}, {2, -1}, {-2, 1}, {-2, -1},
+};
+
+/// 3D gradients: the 12 cube edge midpoints, 4 repeated; indexed by hash & 15
+inline constexpr float kNoiseGrad3[16][3] = {
+    {1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0},
+    {1, 0, 1}, {-1, 0, 1}, {1, 0, -1}, {-1, 0, -1},
+    {0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1},
+    {1, 1, 0}, {0, -1, 1}, {-1, 1, 0}, {0, -1, -1},
+};
+
+/// 4D gradients: the 32 hypercube edge midpoints, indexed by hash & 31
+inline constexpr float kNoiseGrad4[32][4] = {
+    {1, 1, 1, 0}, {-1, 1, 1, 0}, {1, -1, 1, 0}, {-1, -1, 1, 0},
+    {1, 1, -1, 0}, {-1, 1, -1, 0}, {1, -1, -1, 0}, {-1, -1, -1, 0},
+    {1, 1, 0, 1}, {-1, 1, 0, 1}, {1, -1, 0, 1}, {-1, -1, 0, 1},
+    {1, 1, 0, -1}, {-1, 1, 0, -1}, {1, -1, 0, -1}, {-1, -1, 0, -1},
+    {1, 0, 1, 1}, {-1, 0, 1, 1}, {1, 0, -1, 1}, {-1, 0, -1, 1},
+    {1, 0, 1, -1}, {-1, 0, 1, -1}, {1, 0, -1, -1}, {-1, 0, -1, -1},
+    {0, 1, 1, 1}, {0, -1, 1, 1}, {0, 1, -1, 1}, {0, -1, -1, 1},
+    {0, 1, 1, -1}, {0, -1, 1, -1}, {0, 1, -1, -1}, {0, -1, -1, -1},
+};
+
+// Scales that bring each noise into [-1, 1]
+inline constexpr float kPerlinScale1 = 0.25f;
+inline constexpr float kPerlinScale2 = 0.66f;
+inline constexpr float kPerlinScale3 = 0.936f;
+inline constexpr float kPerlinScale4 = 0.87f;
+inline constexpr float kSimplexScale1 = 0.395f;
+inline constexpr float kSimplexScale2 = 45.23f;
+inline constexpr float kSimplexScale3 = 32.0f;
+inline constexpr float kSimplexScale4 = 27.0f;
+
+// ============================================================================
+// Lanes
+// ============================================================================
+//
+// The noise functions below are written once for F = float (one point) and
+// F = simd_float4 (four points). Lattice hashes and gradient lookups are
+// gathers done lane by lane; everything else is plain vector arithmetic.
+
+template <typename F> struct NoiseLanes;
+template <> struct NoiseLanes<float> { static constexpr int count = 1; };
+template <> struct NoiseLanes<simd_float4> { static constexpr int count = 4; };
+
+inline float noiseLane(float v, int) { return v; }
+inline float noiseLane(simd_float4 v, int lane) { return v[lane]; }
+
+template <typename F> F noiseSplat(float v);
+template <> inline float noiseSplat<float>(float v) { return v; }
+template <> inline simd_float4 noiseSplat<simd_float4>(float v) { return simd_make_float4(v, v, v, v); }
+
+/// Build F from one float per lane
+template <typename F> F noiseGather(const float* values);
+template <> inline float noiseGather<float>(const float* values) { return values[0]; }
+template <> inline simd_float4 noiseGather<simd_float4>(const float* values) {
+    return simd_make_float4(values[0], values[1], values[2], values[3]);
+}
+
+inline float noiseFloor(float v) { return std::floor(v); }
+inline simd_float4 noiseFloor(simd_float4 v) {
+    return simd_make_float4(std::floor(v[0]), std::floor(v[1]), std::floor(v[2]), std::floor(v[3]));
+}
+
+inline float noiseMax0(float v) { return v > 0.0f ? v : 0.0f; }
+inline simd_float4 noiseMax0(simd_float4 v) {
+    return simd_make_float4(noiseMax0(v[0]), noiseMax0(v[1]), noiseMax0(v[2]), noiseMax0(v[3]));
+}
+
+/// 1 where a > b, else 0
+inline float noiseGreater(float a, float b) { return a > b ? 1.0f : 0.0f; }
+inline simd_float4 noiseGreater(simd_float4 a, simd_float4 b) {
+    return simd_make_float4(noiseGreater(a[0], b[0]), noiseGreater(a[1], b[1]),
+                            noiseGreater(a[2], b[2]), noiseGreater(a[3], b[3]));
+}
+
+/// Lattice coordinate of each lane, wrapped to the 256 period
+template <typename F>
+inline void noiseCells(F v, int* cells) {
+    for (int lane = 0; lane < NoiseLanes<F>::count; ++lane) {
+        cells[lane] = static_cast<int>(noiseLane(v, lane)) & 255;
+    }
+}
+
+inline int noiseHash(int i) { return kNoisePerm[i & 255]; }
+inline int noiseHash(int i, int j) { return kNoisePerm[(i + noiseHash(j)) & 255]; }
+inline int noiseHash(int i, int j, int k) { return kNoisePerm[(i + noiseHash(j, k)) & 255]; }
+inline int noiseHash(int i, int j, int k, int l) { return kNoisePerm[(i + noiseHash(j, k, l)) & 255]; }
+
+// Gradient dot offset for every lane, with the lattice corner cell + offset
+template <typename F>
+inline F noiseGrad(const int* i, const int* di, F x) {
+    float g[4];
+    for (int lane = 0; lane < NoiseLanes<F>::count; ++lane) {
+        g[lane] = kNoiseGrad1[noiseHash(i[lane] + di[lane]) & 15];
+    }
+    return noiseGather<F>(g) * x;
+}
+
+template <typename F>
+inline F noiseGrad(const int* i, const int* di, const int* j, const int* dj, F x, F y) {
+    float gx[4], gy[4];
+    for (int lane = 0; lane < NoiseLanes<F>::count; ++lane) {
+        const float* g = kNoiseGrad2[noiseHash(i[lane] + di[lane], j[lane] + dj[lane]) & 7];
+        gx[lane] = g[0];
+        gy[lane] = g[1];
+    }
+    return noiseGather<F>(gx) * x + noiseGather<F>(gy) * y;
+}
+
+template <typename F>
+inline F noiseGrad(const int* i, const int* di, const int* j, const int* dj,
+                   const int* k, const int* dk, F x, F y, F z) {
+    float gx[4], gy[4], gz[4];
+    for (int lane = 0; lane < NoiseLanes<F>::count; ++lane) {
+        const float* g = kNoiseGrad3[noiseHash(i[lane] + di[lane], j[lane] + dj[lane], k[lane] + dk[lane]) & 15];
+        gx[lane] = g[0];
+        gy[lane] = g[1];
+        gz[lane] = g[2];
+    }
+    return noiseGather<F>(gx) * x + noiseGather<F>(gy) * y + noiseGather<F>(gz) * z;
+}
+
+template <typename F>
+inline F noiseGrad(const int* i, const int* di, const int* j, const int* dj,
+                   const int* k, const int* dk, const int* l, const int* dl, F x, F y, F z, F w) {
+    float gx[4], gy[4], gz[4], gw[4];
+    for (int lane = 0; lane < NoiseLanes<F>::count; ++lane) {
+        const float* g = kNoiseGrad4[noiseHash(i[lane] + di[lane], j[lane] + dj[lane],
+                                               k[lane] + dk[lane], l[lane] + dl[lane]) & 31];
+        gx[lane] = g[0];
+        gy[lane] = g[1];
+        gz[lane] = g[2];
+        gw[lane] = g[3];
+    }
+    return noiseGather<F>(gx) * x + noiseGather<F>(gy) * y + noiseGather<F>(gz) * z + noiseGather<F>(gw) * w;
+}
+
+/// Integer offsets of each lane's simplex corner
+template <typename F>
+inline void noiseOffsets(F v, int* offsets) {
+    for (int lane = 0; lane < NoiseLanes<F>::count; ++lane) {
+        offsets[lane] = static_cast<int>(noiseLane(v, lane));
+    }
+}
+
+inline constexpr int kNoiseZero[4] = {0, 0, 0, 0};
+inline constexpr int kNoiseOne[4] = {1, 1, 1, 1};
+
+// ============================================================================
+// Perlin
+// ============================================================================
+
+template <typename F>
+inline F noiseFade(F t) {
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+template <typename F>
+inline F noiseLerp(F t, F a, F b) {
+    return a + t * (b - a);
+}
+
+template <typename F>
+inline F perlin(F x) {
+    const F fx = noiseFloor(x);
+    int i[4];
+    noiseCells(fx, i);
+    const F x0 = x - fx;
+    const F x1 = x0 - 1.0f;
+    const F n0 = noiseGrad(i, kNoiseZero, x0);
+    const F n1 = noiseGrad(i, kNoiseOne, x1);
+    return kPerlinScale1 * noiseLerp(noiseFade(x0), n0, n1);
+}
+
+template <typename F>
+inline F perlin(F x, F y) {
+    const F fx = noiseFloor(x), fy = noiseFloor(y);
+    int i[4], j[4];
+    noiseCells(fx, i);
+    noiseCells(fy, j);
+    const F x0 = x - fx, y0 = y - fy;
+    const F x1 = x0 - 1.0f, y1 = y0 - 1.0f;
+    const F u = noiseFade(x0), v = noiseFade(y0);
+    const int* o = kNoiseZero;
+    const int* l = kNoiseOne;
+
+    const F n00 = noiseGrad(i, o, j, o, x0, y0);
+    const F n10 = noiseGrad(i, l, j, o, x1, y0);
+    const F n01 = noiseGrad(i, o, j, l, x0, y1);
+    const F n11 = noiseGrad(i, l, j, l, x1, y1);
+    return kPerlinScale2 * noiseLerp(v, noiseLerp(u, n00, n10), noiseLerp(u, n01, n11));
+}
+
+template <typename F>
+inline F perlin(F x, F y, F z) {
+    const F fx = noiseFloor(x), fy = noiseFloor(y), fz = noiseFloor(z);
+    int i[4], j[4], k[4];
+    noiseCells(fx, i);
+    noiseCells(fy, j);
+    noiseCells(fz, k);
+    const F x0 = x - fx, y0 = y - fy, z0 = z - fz;
+    const F x1 = x0 - 1.0f, y1 = y0 - 1.0f, z1 = z0 - 1.0f;
+    const F u = noiseFade(x0), v = noiseFade(y0), w = noiseFade(z0);
+    const int* o = kNoiseZero;
+    const int* l = kNoiseOne;
+
+    const F n000 = noiseGrad(i, o, j, o, k, o, x0, y0, z0);
+    const F n100 = noiseGrad(i, l, j, o, k, o, x1, y0, z0);
+    const F n010 = noiseGrad(i, o, j, l, k, o, x0, y1, z0);
+    const F n110 = noiseGrad(i, l, j, l, k, o, x1, y1, z0);
+    const F n001 = noiseGrad(i, o, j, o, k, l, x0, y0, z1);
+    const F n101 = noiseGrad(i, l, j, o, k, l, x1, y0, z1);
+    const F n011 = noiseGrad(i, o, j, l, k, l, x0, y1, z1);
+    const F n111 = noiseGrad(i, l, j, l, k, l, x1, y1, z1);
+
+    const F n0 = noiseLerp(v, noiseLerp(u, n000, n100), noiseLerp(u, n010, n110));
+    const F n1 = noiseLerp(v, noiseLerp(u, n001, n101), noiseLerp(u, n011, n111));
+    return kPerlinScale3 * noiseLerp(w, n0, n1);
+}
+
+template <typename F>
+inline F perlin(F x, F y, F z, F w) {
+    const F fx = noiseFloor(x), fy = noiseFloor(y), fz = noiseFloor(z), fw = noiseFloor(w);
+    int i[4], j[4], k[4], m[4];
+    noiseCells(fx, i);
+    noiseCells(fy, j);
+    noiseCells(fz, k);
+    noiseCells(fw, m);
+    const F x0 = x - fx, y0 = y - fy, z0 = z - fz, w0 = w - fw;
+    const F x1 = x0 - 1.0f, y1 = y0 - 1.0f, z1 = z0 - 1.0f, w1 = w0 - 1.0f;
+    const F fadeX = noiseFade(x0), fadeY = noiseFade(y0), fadeZ = noiseFade(z0), fadeW = noiseFade(w0);
+
+    // Blend the 16 corners of each w slice, then the two slices
+    F slice[2];
+    for (int dw = 0; dw < 2; ++dw) {
+        const int* ow = dw ? kNoiseOne : kNoiseZero;
+        const F pw = dw ? w1 : w0;
+        F layer[2];
+        for (int dz = 0; dz < 2; ++dz) {
+            const int* oz = dz ? kNoiseOne : kNoiseZero;
+            const F pz = dz ? z1 : z0;
+            const F n00 = noiseGrad(i, kNoiseZero, j, kNoiseZero, k, oz, m, ow, x0, y0, pz, pw);
+            const F n10 = noiseGrad(i, kNoiseOne, j, kNoiseZero, k, oz, m, ow, x1, y0, pz, pw);
+            const F n01 = noiseGrad(i, kNoiseZero, j, kNoiseOne, k, oz, m, ow, x0, y1, pz, pw);
+            const F n11 = noiseGrad(i, kNoiseOne, j, kNoiseOne, k, oz, m, ow, x1, y1, pz, pw);
+            layer[dz] = noiseLerp(fadeY, noiseLerp(fadeX, n00, n10), noiseLerp(fadeX, n01, n11));
+        }
+        slice[dw] = noiseLerp(fadeZ, layer[0], layer[1]);
+    }
+    return kPerlinScale4 * noiseLerp(fadeW, slice[0], slice[1]);
+}
+
+// ============================================================================
+// Simplex
+// ============================================================================
+
+/// Falloff of one simplex corner: (r2 - |d|^2)^4, 0 outside the radius
+template <typename F>
+inline F simplexFalloff(float r2, F d2) {
+    F t = noiseMax0(r2 - d2);
+    t = t * t;
+    return t * t;
+}
+
+template <typename F>
+inline F simplex(F x) {
+    const F fx = noiseFloor(x);
+    int i[4];
+    noiseCells(fx, i);
+    const F x0 = x - fx;
+    const F x1 = x0 - 1.0f;
+    const F n0 = simplexFalloff(1.0f, x0 * x0) * noiseGrad(i, kNoiseZero, x0);
+    const F n1 = simplexFalloff(1.0f, x1 * x1) * noiseGrad(i, kNoiseOne, x1);
+    return kSimplexScale1 * (n0 + n1);
+}
+
+template <typename F>
+inline F simplex(F x, F y) {
+    constexpr float F2 = 0.366025403f;  // (sqrt(3) - 1) / 2
+    constexpr float G2 = 0.211324865f;  // (3 - sqrt(3)) / 6
+
+    const F s = (x + y) * F2;
+    const F fx = noiseFloor(x + s), fy = noiseFloor(y + s);
+    const F t = (fx + fy) * G2;
+    const F x0 = x - (fx - t), y0 = y - (fy - t);
+    int i[4], j[4];
+    noiseCells(fx, i);
+    noiseCells(fy, j);
+
+    // Lower or upper triangle of the skewed cell
+    const F step = noiseGreater(x0, y0);
+    int i1[4], j1[4];
+    noiseOffsets(step, i1);
+    noiseOffsets(1.0f - step, j1);
+
+    const F x1 = x0 - step + G2, y1 = y0 - (1.0f - step) + G2;
+    const F x2 = x0 - 1.0f + 2.0f * G2, y2 = y0 - 1.0f + 2.0f * G2;
+
+    const F n0 = simplexFalloff(0.5f, x0 * x0 + y0 * y0) * noiseGrad(i, kNoiseZero, j, kNoiseZero, x0, y0);
+    const F n1 = simplexFalloff(0.5f, x1 * x1 + y1 * y1) * noiseGrad(i, i1, j, j1, x1, y1);
+    const F n2 = simplexFalloff(0.5f, x2 * x2 + y2 * y2) * noiseGrad(i, kNoiseOne, j, kNoiseOne, x2, y2);
+    return kSimplexScale2 * (n0 + n1 + n2);
+}
+
+template <typename F>
+inline F simplex(F x, F y, F z) {
+    constexpr float F3 = 1.0f / 3.0f;
+    constexpr float G3 = 1.0f / 6.0f;
+
+    const F s = (x + y + z) * F3;
+    const F fx = noiseFloor(x + s), fy = noiseFloor(y + s), fz = noiseFloor(z + s);
+    const F t = (fx + fy + fz) * G3;
+    const F x0 = x - (fx - t), y0 = y - (fy - t), z0 = z - (fz - t);
+    int i[4], j[4], k[4];
+    noiseCells(fx, i);
+    noiseCells(fy, j);
+    noiseCells(fz, k);
+
+    // Rank the offsets; the largest steps first along the simplex edges
+    const F xy = noiseGreater(x0, y0), xz = noiseGreater(x0, z0), yz = noiseGreater(y0, z0);
+    const F rankX = xy + xz;
+    const F rankY = (1.0f - xy) + yz;
+    const F rankZ = (1.0f - xz) + (1.0f - yz);
+
+    const F a1 = noiseGreater(rankX, noiseSplat<F>(1.5f)), a2 = noiseGreater(rankX, noiseSplat<F>(0.5f));
+    const F b1 = noiseGreater(rankY, noiseSplat<F>(1.5f)), b2 = noiseGreater(rankY, noiseSplat<F>(0.5f));
+    const F c1 = noiseGreater(rankZ, noiseSplat<F>(1.5f)), c2 = noiseGreater(rankZ, noiseSplat<F>(0.5f));
+    int i1[4], j1[4], k1[4], i2[4], j2[4], k2[4];
+    noiseOffsets(a1, i1);
+    noiseOffsets(b1, j1);
+    noiseOffsets(c1, k1);
+    noiseOffsets(a2, i2);
+    noiseOffsets(b2, j2);
+    noiseOffsets(c2, k2);
+
+    const F x1 = x0 - a1 + G3, y1 = y0 - b1 + G3, z1 = z0 - c1 + G3;
+    const F x2 = x0 - a2 + 2.0f * G3, y2 = y0 - b2 + 2.0f * G3, z2 = z0 - c2 + 2.0f * G3;
+    const F x3 = x0 - 1.0f + 3.0f * G3, y3 = y0 - 1.0f + 3.0f * G3, z3 = z0 - 1.0f + 3.0f * G3;
+
+    const F n0 = simplexFalloff(0.6f, x0 * x0 + y0 * y0 + z0 * z0) *
+                 noiseGrad(i, kNoiseZero, j, kNoiseZero, k, kNoiseZero, x0, y0, z0);
+    const F n1 = simplexFalloff(0.6f, x1 * x1 + y1 * y1 + z1 * z1) * noiseGrad(i, i1, j, j1, k, k1, x1, y1, z1);
+    const F n2 = simplexFalloff(0.6f, x2 * x2 + y2 * y2 + z2 * z2) * noiseGrad(i, i2, j, j2, k, k2, x2, y2, z2);
+    const F n3 = simplexFalloff(0.6f, x3 * x3 + y3 * y3 + z3 * z3) *
+                 noiseGrad(i, kNoiseOne, j, kNoiseOne, k, kNoiseOne, x3, y3, z3);
+    return kSimplexScale3 * (n0 + n1 + n2 + n3);
+}
+
+template <typename F>
+inline F simplex(F x, F y, F z, F w) {
+    constexpr float F4 = 0.309016994f;  // (sqrt(5) - 1) / 4
+    constexpr float G4 = 0.138196601f;  // (5 - sqrt(5)) / 20
+
+    const F s = (x + y + z + w) * F4;
+    const F fx = noiseFloor(x + s), fy = noiseFloor(y + s), fz = noiseFloor(z + s), fw = noiseFloor(w + s);
+    const F t = (fx + fy + fz + fw) * G4;
+    const F x0 = x - (fx - t), y0 = y - (fy - t), z0 = z - (fz - t), w0 = w - (fw - t);
+    int i[4], j[4], k[4], m[4];
+    noiseCells(fx, i);
+    noiseCells(fy, j);
+    noiseCells(fz, k);
+    noiseCells(fw, m);
+
+    const F xy = noiseGreater(x0, y0), xz = noiseGreater(x0, z0), xw = noiseGreater(x0, w0);
+    const F yz = noiseGreater(y0, z0), yw = noiseGreater(y0, w0), zw = noiseGreater(z0, w0);
+    const F rank[4] = {
+        xy + xz + xw,
+        (1.0f - xy) + yz + yw,
+        (1.0f - xz) + (1.0f - yz) + zw,
+        (1.0f - xw) + (1.0f - yw) + (1.0f - zw),
+    };
+
+    // Corners 1-3 step along the axes ranked 3, then >= 2, then >= 1
+    F step[3][4];
+    int offsets[3][4][4];
+    for (int corner = 0; corner < 3; ++corner) {
+        const F threshold = noiseSplat<F>(2.5f - static_cast<float>(corner));
+        for (int axis = 0; axis < 4; ++axis) {
+            step[corner][axis] = noiseGreater(rank[axis], threshold);
+            noiseOffsets(step[corner][axis], offsets[corner][axis]);
+        }
+    }
+
+    const F n0 = simplexFalloff(0.6f, x0 * x0 + y0 * y0 + z0 * z0 + w0 * w0) *
+                 noiseGrad(i, kNoiseZero, j, kNoiseZero, k, kNoiseZero, m, kNoiseZero, x0, y0, z0, w0);
+    F sum = n0;
+    for (int corner = 0; corner < 3; ++corner) {
+        const float g = static_cast<float>(corner + 1) * G4;
+        const F px = x0 - step[corner][0] + g, py = y0 - step[corner][1] + g;
+        const F pz = z0 - step[corner][2] + g, pw = w0 - step[corner][3] + g;
+        sum = sum + simplexFalloff(0.6f, px * px + py * py + pz * pz + pw * pw) *
+                    noiseGrad(i, offsets[corner][0], j, offsets[corner][1],
+                              k, offsets[corner][2], m, offsets[corner][3], px, py, pz, pw);
+    }
+    const F x4 = x0 - 1.0f + 4.0f * G4, y4 = y0 - 1.0f + 4.0f * G4;
+    const F z4 = z0 - 1.0f + 4.0f * G4, w4 = w0 - 1.0f + 4.0f * G4;
+    sum = sum + simplexFalloff(0.6f, x4 * x4 + y4 * y4 + z4 * z4 + w4 * w4) *
+                noiseGrad(i, kNoiseOne, j, kNoiseOne, k, kNoiseOne, m, kNoiseOne, x4, y4, z4, w4);
+    return kSimplexScale4 * sum;
+}
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+template <typename F>
+inline F noiseClamp(F v) {
+    if constexpr (NoiseLanes<F>::count == 1) {
+        return std::min(std::max(v, -1.0f), 1.0f);
+    } else {
+        return simd_clamp(v, simd_make_float4(-1.0f, -1.0f, -1.0f, -1.0f), simd_make_float4(1.0f, 1.0f, 1.0f, 1.0f));
+    }
+}
+
+template <typename F, typename... Coords>
+inline F signedNoise(ofNoiseType type, Coords... coords) {
+    return noiseClamp<F>(type == ofNoiseType::Perlin ? perlin<F>(coords...) : simplex<F>(coords...));
+}
+
+/// Evaluate count points four at a time; load(index) returns simd_float4
+/// coordinates from the caller's layout, and remaining points go one by one
+template <int Dimensions, typename Load>
+inline void signedNoiseBatch(ofNoiseType type, float* out, size_t count, float bias, float scale, Load load) {
+    size_t index = 0;
+    for (; index + 4 <= count; index += 4) {
+        simd_float4 c[4];
+        for (int lane = 0; lane < 4; ++lane) {
+            const simd_float4 p = load(index + lane);
+            c[0][lane] = p[0];
+            c[1][lane] = p[1];
+            c[2][lane] = p[2];
+            c[3][lane] = p[3];
+        }
+        simd_float4 n;
+        if constexpr (Dimensions == 1) n = signedNoise<simd_float4>(type, c[0]);
+        else if constexpr (Dimensions == 2) n = signedNoise<simd_float4>(type, c[0], c[1]);
+        else if constexpr (Dimensions == 3) n = signedNoise<simd_float4>(type, c[0], c[1], c[2]);
+        else n = signedNoise<simd_float4>(type, c[0], c[1], c[2], c[3]);
+        n = n * scale + bias;
+        out[index + 0] = n[0];
+        out[index + 1] = n[1];
+        out[index + 2] = n[2];
+        out[index + 3] = n[3];
+    }
+    for (; index < count; ++index) {
+        const simd_float4 p = load(index);
+        float n;
+        if constexpr (Dimensions == 1) n = signedNoise<float>(type, p[0]);
+        else if constexpr (Dimensions == 2) n = signedNoise<float>(type, p[0], p[1]);
+        else if constexpr (Dimensions == 3) n = signedNoise<float>(type, p[0], p[1], p[2]);
+        else n = signedNoise<float>(type, p[0], p[1], p[2], p[3]);
+        out[index] = n * scale + bias;
+    }
+}
+
+} // namespace detail
+} // namespace oflike
+
+// MARK: - Noise Functions
+
+/// Signed simplex noise, as openFrameworks' ofSignedNoise()
+/// @return Noise value in [-1, 1]
+inline float ofSignedNoise(float x) {
+    return oflike::detail::signedNoise<float>(ofNoiseType::Simplex, x);
+}
+
+/// Signed 2D simplex noise
+/// @return Noise value in [-1, 1]
+inline float ofSignedNoise(float x, float y) {
+    return oflike::detail::signedNoise<float>(ofNoiseType::Simplex, x, y);
+}
+
+/// Signed 3D simplex noise
+/// @return Noise value in [-1, 1]
+inline float ofSignedNoise(float x, float y, float z) {
+    return oflike::detail::signedNoise<float>(ofNoiseType::Simplex, x, y, z);
+}
+
+/// Signed 4D simplex noise, e.g. a 3D field animated along w
+/// @return Noise value in [-1, 1]
+inline float ofSignedNoise(float x, float y, float z, float w) {
+    return oflike::detail::signedNoise<float>(ofNoiseType::Simplex, x, y, z, w);
+}
+
+/// Simplex noise in [0, 1], as openFrameworks' ofNoise()
+/// @param x Input coordinate
+/// @return Noise value in [0, 1]
+inline float ofNoise(float x) {
+    return ofSignedNoise(x) * 0.5f + 0.5f;
+}
+
+/// 2D simplex noise in [0, 1]
+/// @return Noise value in [0, 1]
+inline float ofNoise(float x, float y) {
+    return ofSignedNoise(x, y) * 0.5f + 0.5f;
+}
+
+/// 3D simplex noise in [0, 1]
+/// @return Noise value in [0, 1]
+inline float ofNoise(float x, float y, float z) {
+    return ofSignedNoise(x, y, z) * 0.5f + 0.5f;
+}
+
+/// 4D simplex noise in [0, 1]
+/// @return Noise value in [0, 1]
+inline float ofNoise(float x, float y, float z, float w) {
+    return ofSignedNoise(x, y, z, w) * 0.5f + 0.5f;
+}
+
+/// Signed Perlin (improved gradient) noise; 0 at integer coordinates
+/// @return Noise value in [-1, 1]
+inline float ofSignedPerlinNoise(float x) {
+    return oflike::detail::signedNoise<float>(ofNoiseType::Perlin, x);
+}
+
+inline float ofSignedPerlinNoise(float x, float y) {
+    return oflike::detail::signedNoise<float>(ofNoiseType::Perlin, x, y);
+}
+
+inline float ofSignedPerlinNoise(float x, float y, float z) {
+    return oflike::detail::signedNoise<float>(ofNoiseType::Perlin, x, y, z);
+}
+
+inline float ofSignedPerlinNoise(float x, float y, float z, float w) {
+    return oflike::detail::signedNoise<float>(ofNoiseType::Perlin, x, y, z, w);
+}
+
+/// Perlin noise in [0, 1]
+/// @return Noise value in [0, 1]
+inline float ofPerlinNoise(float x) {
+    return ofSignedPerlinNoise(x) * 0.5f + 0.5f;
+}
+
+inline float ofPerlinNoise(float x, float y) {
+    return ofSignedPerlinNoise(x, y) * 0.5f + 0.5f;
+}
+
+inline float ofPerlinNoise(float x, float y, float z) {
+    return ofSignedPerlinNoise(x, y, z) * 0.5f + 0.5f;
+}
+
+inline float ofPerlinNoise(float x, float y, float z, float w) {
+    return ofSignedPerlinNoise(x, y, z, w) * 0.5f + 0.5f;
+}
+
+// MARK: - Batch Noise
+
+/// Signed noise at many points, evaluated four at a time
+/// Results match the scalar functions of the same type to float rounding.
+/// @param x Coordinates (1D)
+/// @param out count results in [-1, 1]; may alias the input
+/// @param count Number of points
+/// @param type Noise algorithm
+inline void ofSignedNoiseBatch(const float* x, float* out, size_t count,
+                               ofNoiseType type = ofNoiseType::Simplex) {
+    oflike::detail::signedNoiseBatch<1>(type, out, count, 0.0f, 1.0f, [x](size_t i) {
+        return simd_make_float4(x[i], 0.0f, 0.0f, 0.0f);
+    });
+}
+
+inline void ofSignedNoiseBatch(const simd_float2* points, float* out, size_t count,
+                               ofNoiseType type = ofNoiseType::Simplex) {
+    oflike::detail::signedNoiseBatch<2>(type, out, count, 0.0f, 1.0f, [points](size_t i) {
+        return simd_make_float4(points[i].x, points[i].y, 0.0f, 0.0f);
+    });
+}
+
+inline void ofSignedNoiseBatch(const simd_float3* points, float* out, size_t count,
+                               ofNoiseType type = ofNoiseType::Simplex) {
+    oflike::detail::signedNoiseBatch<3>(type, out, count, 0.0f, 1.0f, [points](size_t i) {
+        return simd_make_float4(points[i].x, points[i].y, points[i].z, 0.0f);
+    });
+}
+
+inline void ofSignedNoiseBatch(const simd_float4* points, float* out, size_t count,
+                               ofNoiseType type = ofNoiseType::Simplex) {
+    oflike::detail::signedNoiseBatch<4>(type, out, count, 0.0f, 1.0f, [points](size_t i) {
+        return points[i];
+    });
+}
+
+/// Noise in [0, 1] at many points, evaluated four at a time
+/// @param out count results in [0, 1]
+inline void ofNoiseBatch(const float* x, float* out, size_t count,
+                         ofNoiseType type = ofNoiseType::Simplex) {
+    oflike::detail::signedNoiseBatch<1>(type, out, count, 0.5f, 0.5f, [x](size_t i) {
+        return simd_make_float4(x[i], 0.0f, 0.0f, 0.0f);
+    });
+}
+
+inline void ofNoiseBatch(const simd_float2* points, float* out, size_t count,
+                         ofNoiseType type = ofNoiseType::Simplex) {
+    oflike::detail::signedNoiseBatch<2>(type, out, count, 0.5f, 0.5f, [points](size_t i) {
+        return simd_make_float4(points[i].x, points[i].y, 0.0f, 0.0f);
+    });
+}
+
+inline void ofNoiseBatch(const simd_float3* points, float* out, size_t count,
+                         ofNoiseType type = ofNoiseType::Simplex) {
+    oflike::detail::signedNoiseBatch<3>(type, out, count, 0.5f, 0.5f, [points](size_t i) {
+        return simd_make_float4(points[i].x, points[i].y, points[i].z, 0.0f);
+    });
+}
+
+inline void ofNoiseBatch(const simd_float4* points, float* out, size_t count,
+                         ofNoiseType type = ofNoiseType::Simplex) {
+    oflike::detail::signedNoiseBatch<4>(type, out, count, 0.5f, 0.5f, [points](size_t i) {
+        return points[i];
+    });
+}
+
+// MARK: - Noise Fields
+
+/// A grid of noise samples, optionally summed over octaves (fractal noise)
+/// Sample (x, y) of the grid is at (originX + x * frequency,
+/// originY + y * frequency[, z[, w]]) in noise space.
+struct ofNoiseFieldSettings {
+    ofNoiseType type = ofNoiseType::Simplex;
+    int dimensions = 2;         ///< 2, 3 (adds z) or 4 (adds z and w)
+    float originX = 0.0f;
+    float originY = 0.0f;
+    float frequency = 0.01f;    ///< Noise units between neighbouring samples
+    float z = 0.0f;             ///< Slice through 3D and 4D noise
+    float w = 0.0f;             ///< Fourth coordinate of 4D noise, e.g. time
+    int octaves = 1;            ///< Layers summed, each at lacunarity times the frequency
+    float lacunarity = 2.0f;
+    float gain = 0.5f;          ///< Amplitude of each octave relative to the last
+};
+
+/// Fill width * height floats, row by row, with noise in [0, 1]
+/// ofNoiseField(ofTexture&, ...) computes the same field on the GPU.
+/// @param out Destination of width * height values
+inline void ofNoiseField(float* out, int width, int height, const ofNoiseFieldSettings& settings = {}) {
+    if (!out || width <= 0 || height <= 0) return;
+    const int octaves = std::max(settings.octaves, 1);
+    const int dimensions = std::min(std::max(settings.dimensions, 2), 4);
+
+    // Normalise so the octaves together stay within [-1, 1]
+    float amplitudeSum = 0.0f;
+    float amplitude = 1.0f;
+    for (int octave = 0; octave < octaves; ++octave) {
+        amplitudeSum += amplitude;
+        amplitude *= settings.gain;
+    }
+    const float normalize = amplitudeSum > 0.0f ? 1.0f / amplitudeSum : 1.0f;
+
+    for (int y = 0; y < height; ++y) {
+        float* row = out + static_cast<size_t>(y) * width;
+        for (int x0 = 0; x0 < width; x0 += 4) {
+            const simd_float4 lanes = simd_make_float4(0.0f, 1.0f, 2.0f, 3.0f) + static_cast<float>(x0);
+            const simd_float4 px = settings.originX + lanes * settings.frequency;
+            const simd_float4 py = simd_make_float4(1.0f, 1.0f, 1.0f, 1.0f) *
+                                   (settings.originY + static_cast<float>(y) * settings.frequency);
+
+            simd_float4 sum = simd_make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+            float scale = 1.0f;
+            amplitude = 1.0f;
+            for (int octave = 0; octave < octaves; ++octave) {
+                const simd_float4 ox = px * scale, oy = py * scale;
+                const simd_float4 oz = simd_make_float4(1.0f, 1.0f, 1.0f, 1.0f) * (settings.z * scale);
+                const simd_float4 ow = simd_make_float4(1.0f, 1.0f, 1.0f, 1.0f) * (settings.w * scale);
+                simd_float4 n;
+                if (dimensions == 2) n = oflike::detail::signedNoise<simd_float4>(settings.type, ox, oy);
+                else if (dimensions == 3) n = oflike::detail::signedNoise<simd_float4>(settings.type, ox, oy, oz);
+                else n = oflike::detail::signedNoise<simd_float4>(settings.type, ox, oy, oz, ow);
+                sum = sum + n * amplitude;
+                scale *= settings.lacunarity;
+                amplitude *= settings.gain;
+            }
+
+            const simd_float4 value = sum * (0.5f * normalize) + 0.5f;
+            const int lanesLeft = std::min(4, width - x0);
+            for (int lane = 0; lane < lanesLeft; ++lane) {
+                row[x0 + lane] = value[lane];
+            }
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+// oflike-metal ofOneEuroFilter - jitter filter for irregularly sampled signals
+// Used to smooth tracking results (poses, detections) between ML frames
+
+#include <algorithm>
+#include <cmath>
+
+namespace oflike {
+
+/// \brief One-Euro filter (Casiez et al., CHI 2012) for a noisy scalar signal.
+/// \details Low-pass filters each sample with a cutoff frequency that rises
+/// with the signal's speed: strong smoothing while the signal rests, little
+/// lag while it moves. Samples may arrive at any rate. The filtered speed is
+/// kept too, so the value can be interpolated or predicted between samples,
+/// e.g. to draw 15 Hz tracking results at the display's frame rate.
+class ofOneEuroFilter {
+public:
+    // ========================================================================
+    // Constructors
+    // ========================================================================
+
+    /// \brief Construct with the filter parameters
+    /// \param minCutoff Cutoff frequency at rest, in Hz (lower = less jitter)
+    /// \param beta Cutoff increase per unit/second of speed (higher = less lag)
+    /// \param derivativeCutoff Cutoff frequency of the speed estimate, in Hz
+    explicit ofOneEuroFilter(float minCutoff = 1.0f, float beta = 0.0f, float derivativeCutoff = 1.0f)
+        : minCutoff_(minCutoff), beta_(beta), derivativeCutoff_(derivativeCutoff) {}
+
+    // ========================================================================
+    // Parameters
+    // ========================================================================
+
+    /// \brief Change the filter parameters; the filtered state is kept
+    void setParameters(float minCutoff, float beta, float derivativeCutoff = 1.0f) {
+        minCutoff_ = minCutoff;
+        beta_ = beta;
+        derivativeCutoff_ = derivativeCutoff;
+    }
+
+    float getMinCutoff() const { return minCutoff_; }
+    float getBeta() const { return beta_; }
+    float getDerivativeCutoff() const { return derivativeCutoff_; }
+
+    // ========================================================================
+    // Filtering
+    // ========================================================================
+
+    /// \brief Filter a sample taken at timestamp (seconds)
+    /// \details The first sample is passed through. Samples not newer than
+    /// the last one are ignored.
+    /// \return The filtered value
+    float filter(float value, double timestamp) {
+        if (!hasValue_) {
+            value_ = previousValue_ = value;
+            speed_ = 0.0f;
+            timestamp_ = previousTimestamp_ = timestamp;
+            hasValue_ = true;
+            return value_;
+        }
+
+        const double dt = timestamp - timestamp_;
+        if (dt <= 0.0) {
+            return value_;
+        }
+
+        const float rawSpeed = static_cast<float>((value - value_) / dt);
+        speed_ += (rawSpeed - speed_) * alpha(derivativeCutoff_, dt);
+
+        const float cutoff = minCutoff_ + beta_ * std::abs(speed_);
+        previousValue_ = value_;
+        previousTimestamp_ = timestamp_;
+        value_ += (value - value_) * alpha(cutoff, dt);
+        timestamp_ = timestamp;
+        return value_;
+    }
+
+    /// \brief Filtered value at a time (seconds)
+    /// \details Between the last two samples the value is interpolated;
+    /// after the last one it is extrapolated with the filtered speed for at
+    /// most maxPrediction seconds, then held.
+    /// \return 0 before the first sample
+    float getValueAt(double time, double maxPrediction = 0.1) const {
+        if (!hasValue_) {
+            return 0.0f;
+        }
+        if (time >= timestamp_) {
+            const double lead = std::min(time - timestamp_, std::max(maxPrediction, 0.0));
+            return value_ + speed_ * static_cast<float>(lead);
+        }
+        if (time <= previousTimestamp_ || timestamp_ <= previousTimestamp_) {
+            return previousValue_;
+        }
+        const float amount = static_cast<float>((time - previousTimestamp_) / (timestamp_ - previousTimestamp_));
+        return previousValue_ + (value_ - previousValue_) * amount;
+    }
+
+    /// \brief Forget all samples
+    void reset() {
+        hasValue_ = false;
+        value_ = previousValue_ = speed_ = 0.0f;
+        timestamp_ = previousTimestamp_ = 0.0;
+    }
+
+    // ========================================================================
+    // State
+    // ========================================================================
+
+    /// \brief Whether a sample has been filtered since construction or reset()
+    bool hasValue() const { return hasValue_; }
+
+    /// \brief Filtered value at the last sample
+    float getValue() const { return value_; }
+
+    /// \brief Filtered speed at the last sample, in units per second
+    float getSpeed() const { return speed_; }
+
+    /// \brief Timestamp of the last sample, in seconds
+    double getTimestamp() const { return timestamp_; }
+
+private:
+    // Smoothing factor of a first-order low-pass filter for a sample interval
+    static float alpha(float cutoff, double dt) {
+        const double tau = 1.0 / (2.0 * 3.14159265358979323846 * std::max(cutoff, 1e-6f));
+        return static_cast<float>(1.0 / (1.0 + tau / dt));
+    }
+
+    float minCutoff_;
+    float beta_;
+    float derivativeCutoff_;
+
+    bool hasValue_ = false;
+    float value_ = 0.0f;
+    float previousValue_ = 0.0f;
+    float speed_ = 0.0f;
+    double timestamp_ = 0.0;
+    double previousTimestamp_ = 0.0;
+};
+
+} // namespace oflike
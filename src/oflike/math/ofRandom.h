@@ -0,0 +1,246 @@
+#pragma once
+
+// oflike-metal ofRandom - fast, seedable random number streams
+// xoshiro128** run as four interleaved generators in simd_uint4 lanes, so
+// bulk fills produce four values per step; ofRandom() draws from a stream
+// owned by the calling thread
+
+#include <simd/simd.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/// \brief A deterministic stream of random numbers
+/// \details The same seed and stream index always give the same sequence,
+/// on any machine, so offline renders and simulations can be replayed.
+/// Streams of one seed with different indices are independent, e.g. one per
+/// worker thread or per frame. A stream is not thread-safe; give each thread
+/// its own. Satisfies UniformRandomBitGenerator, so it also drives the
+/// <random> distributions.
+///
+/// Example:
+/// \code
+///     ofRandomStream rng(1234);
+///     float jitter = rng.random(-1.0f, 1.0f);
+///
+///     std::vector<float> sizes(10000);
+///     rng.fill(sizes.data(), sizes.size(), 2.0f, 8.0f);
+/// \endcode
+class ofRandomStream {
+public:
+    using result_type = uint32_t;
+
+    /// \param seed Seed value
+    /// \param stream Independent sub-stream of the seed
+    explicit ofRandomStream(uint64_t seed = 0, uint64_t stream = 0) {
+        setSeed(seed, stream);
+    }
+
+    /// Restart the sequence of a seed and sub-stream
+    void setSeed(uint64_t seed, uint64_t stream = 0) {
+        // Expand the seed into 16 state words with splitmix64
+        uint64_t z = seed ^ (stream * 0xD1B54A32D192ED03ull);
+        uint32_t words[16];
+        for (int i = 0; i < 16; i += 2) {
+            z += 0x9E3779B97F4A7C15ull;
+            uint64_t v = z;
+            v = (v ^ (v >> 30)) * 0xBF58476D1CE4E5B9ull;
+            v = (v ^ (v >> 27)) * 0x94D049BB133111EBull;
+            v ^= v >> 31;
+            words[i] = static_cast<uint32_t>(v);
+            words[i + 1] = static_cast<uint32_t>(v >> 32);
+        }
+        for (int lane = 0; lane < 4; ++lane) {
+            s0_[lane] = words[lane];
+            s1_[lane] = words[4 + lane];
+            s2_[lane] = words[8 + lane];
+            s3_[lane] = words[12 + lane];
+            // An all-zero xoshiro state only produces zeros
+            if ((words[lane] | words[4 + lane] | words[8 + lane] | words[12 + lane]) == 0) {
+                s0_[lane] = 1;
+            }
+        }
+        available_ = 0;
+    }
+
+    // ========================================================================
+    // Single values
+    // ========================================================================
+
+    /// Next 32 random bits
+    uint32_t nextUInt() {
+        if (available_ == 0) {
+            results_ = step();
+            available_ = 4;
+        }
+        return results_[4 - available_--];
+    }
+
+    /// Random integer in [0, bound); 0 if bound is 0
+    uint32_t nextUInt(uint32_t bound) {
+        // Lemire's multiply-shift; the bias is below 2^-32 * bound
+        return static_cast<uint32_t>((static_cast<uint64_t>(nextUInt()) * bound) >> 32);
+    }
+
+    /// Random float in [0, 1)
+    float nextFloat() {
+        return static_cast<float>(nextUInt() >> 8) * 0x1.0p-24f;
+    }
+
+    /// Random float in [0, max)
+    float random(float max) {
+        return nextFloat() * max;
+    }
+
+    /// Random float in [min, max)
+    float random(float min, float max) {
+        return min + nextFloat() * (max - min);
+    }
+
+    // ========================================================================
+    // Bulk
+    // ========================================================================
+
+    /// Fill an array with random floats in [min, max)
+    /// Produces the values count calls to random(min, max) would, four per step.
+    void fill(float* out, size_t count, float min = 0.0f, float max = 1.0f) {
+        const float range = max - min;
+        size_t i = 0;
+        for (; i < count && available_ > 0; ++i) {
+            out[i] = random(min, max);
+        }
+        for (; i + 4 <= count; i += 4) {
+            const simd_float4 f = __builtin_convertvector(step() >> 8, simd_float4) * 0x1.0p-24f;
+            const simd_float4 v = min + f * range;
+            out[i + 0] = v[0];
+            out[i + 1] = v[1];
+            out[i + 2] = v[2];
+            out[i + 3] = v[3];
+        }
+        for (; i < count; ++i) {
+            out[i] = random(min, max);
+        }
+    }
+
+    /// Fill an array with random bits, as count calls to nextUInt()
+    void fill(uint32_t* out, size_t count) {
+        size_t i = 0;
+        for (; i < count && available_ > 0; ++i) {
+            out[i] = nextUInt();
+        }
+        for (; i + 4 <= count; i += 4) {
+            const simd_uint4 v = step();
+            out[i + 0] = v[0];
+            out[i + 1] = v[1];
+            out[i + 2] = v[2];
+            out[i + 3] = v[3];
+        }
+        for (; i < count; ++i) {
+            out[i] = nextUInt();
+        }
+    }
+
+    // ========================================================================
+    // UniformRandomBitGenerator
+    // ========================================================================
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+    result_type operator()() { return nextUInt(); }
+
+private:
+    static simd_uint4 rotl(simd_uint4 x, int k) {
+        return (x << k) | (x >> (32 - k));
+    }
+
+    /// Advance the four generators; one xoshiro128** output per lane
+    simd_uint4 step() {
+        const simd_uint4 result = rotl(s1_ * 5u, 7) * 9u;
+        const simd_uint4 t = s1_ << 9;
+        s2_ ^= s0_;
+        s3_ ^= s1_;
+        s1_ ^= s2_;
+        s0_ ^= s3_;
+        s2_ ^= t;
+        s3_ = rotl(s3_, 11);
+        return result;
+    }
+
+    simd_uint4 s0_, s1_, s2_, s3_;
+    simd_uint4 results_;
+    int available_ = 0;     // Unread lanes of results_, taken lane 0 first
+};
+
+namespace oflike {
+namespace detail {
+
+/// Seed for a thread's stream: OS entropy, distinct per thread
+inline uint64_t randomThreadSeed() {
+    static std::atomic<uint64_t> threadCount{0};
+    std::random_device device;
+    const uint64_t entropy = (static_cast<uint64_t>(device()) << 32) ^ device();
+    return entropy ^ (threadCount.fetch_add(1, std::memory_order_relaxed) * 0x9E3779B97F4A7C15ull);
+}
+
+} // namespace detail
+} // namespace oflike
+
+// MARK: - Random Number Generation
+
+/// The calling thread's stream, used by ofRandom()
+/// Each thread's stream starts from OS entropy, so worker threads never share
+/// state or lock. For results that replay, seed it with ofSeedRandom() or use
+/// an ofRandomStream of your own.
+inline ofRandomStream& ofGetRandomStream() {
+    thread_local ofRandomStream stream(oflike::detail::randomThreadSeed());
+    return stream;
+}
+
+/// Generate random float in range [0, max)
+/// @param max Upper bound (exclusive)
+/// @return Random float in [0, max)
+inline float ofRandom(float max) {
+    return ofGetRandomStream().random(max);
+}
+
+/// Generate random float in range [min, max)
+/// @param min Lower bound (inclusive)
+/// @param max Upper bound (exclusive)
+/// @return Random float in [min, max)
+inline float ofRandom(float min, float max) {
+    return ofGetRandomStream().random(min, max);
+}
+
+/// Generate random float in range [0.0, 1.0)
+/// @return Random float in [0.0, 1.0)
+inline float ofRandomf() {
+    return ofGetRandomStream().nextFloat();
+}
+
+/// Generate random float in range [0.0, 1.0)
+/// Alias for ofRandomf()
+/// @return Random float in [0.0, 1.0)
+inline float ofRandomuf() {
+    return ofRandomf();
+}
+
+/// Seed the calling thread's random number generator
+/// Other threads keep their own streams.
+/// @param seed Seed value
+inline void ofSeedRandom(int seed) {
+    ofGetRandomStream().setSeed(static_cast<uint64_t>(static_cast<uint32_t>(seed)));
+}
+
+/// Fill an array with random floats in [min, max) from the calling thread's stream
+/// @param out Destination of count values
+/// @param count Number of values
+inline void ofRandomFill(float* out, size_t count, float min = 0.0f, float max = 1.0f) {
+    ofGetRandomStream().fill(out, count, min, max);
+}
+
+/// Fill every element of a vector with random floats in [min, max)
+inline void ofRandomFill(std::vector<float>& values, float min = 0.0f, float max = 1.0f) {
+    ofRandomFill(values.data(), values.size(), min, max);
+}
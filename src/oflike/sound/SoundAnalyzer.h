@@ -0,0 +1,79 @@
+#pragma once
+
+// oflike-metal SoundAnalyzer - spectrum and onset analysis of the sound engine
+// Objective-C++ only: taps the engine's main mixer, runs vDSP FFTs on the
+// tap thread and hands results to the main thread without locks
+
+#import <AVFoundation/AVFoundation.h>
+#import <Accelerate/Accelerate.h>
+#include <atomic>
+#include <cstdint>
+
+namespace oflike {
+
+/// Analysis of everything the sound engine plays. The tap side takes no
+/// locks and allocates nothing: it works in buffers set up at construction
+/// and publishes each frame by swapping it with a shared slot, like
+/// FrameTripleBuffer, so neither side ever waits for the other.
+class SoundAnalyzer {
+public:
+    static constexpr int kFFTSize = 2048;
+    static constexpr int kBins = kFFTSize / 2;
+    static constexpr int kHop = 512;            // Samples between analysis frames
+
+    /// One analysis frame
+    struct Frame {
+        float magnitudes[kBins] = {};   // Linear bins, 1.0 = full-scale sine
+        float flux = 0.0f;              // Spectral flux (summed rise over the previous frame)
+        uint64_t onsets = 0;            // Onsets detected since the tap was installed
+    };
+
+    static SoundAnalyzer& instance();
+
+    /// Main thread: install the tap on the engine's main mixer if needed
+    /// \return false if the engine could not start
+    bool attach();
+
+    /// Main thread: the newest published frame
+    const Frame& latest();
+
+private:
+    SoundAnalyzer();
+    ~SoundAnalyzer();
+
+    // Tap thread
+    void process(AVAudioPCMBuffer* buffer);
+    void analyze();
+
+    bool attached_ = false;
+
+    // Tap thread state, all preallocated
+    FFTSetup fftSetup_ = nullptr;
+    float window_[kFFTSize];
+    float windowScale_ = 1.0f;
+    float history_[kFFTSize] = {};      // Ring of the latest mono samples
+    int writePos_ = 0;
+    int pending_ = 0;                   // Samples since the last frame
+    float windowed_[kFFTSize];
+    float real_[kBins];
+    float imag_[kBins];
+    float previous_[kBins] = {};
+
+    static constexpr int kFluxHistory = 43;    // About half a second of frames
+    float fluxHistory_[kFluxHistory] = {};
+    int fluxIndex_ = 0;
+    float lastFlux_ = 0.0f;
+    int hopsSinceOnset_ = 0;
+    uint64_t onsets_ = 0;
+
+    // Three slots: the tap fills its back slot and swaps it with the shared
+    // one; the main thread swaps its front slot for a fresh shared one
+    static constexpr uint8_t kFresh = 0x4;
+    static constexpr uint8_t kIndexMask = 0x3;
+    Frame slots_[3];
+    uint8_t back_ = 0;
+    uint8_t front_ = 1;
+    std::atomic<uint8_t> shared_{2};
+};
+
+} // namespace oflike
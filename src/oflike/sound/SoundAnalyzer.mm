@@ -0,0 +1,137 @@
+#import "SoundAnalyzer.h"
+#import "SoundEngine.h"
+#include <algorithm>
+#include <cmath>
+
+namespace oflike {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+static constexpr int kLog2FFTSize = 11;
+static_assert((1 << kLog2FFTSize) == SoundAnalyzer::kFFTSize, "FFT size must match its log2");
+
+// A frame is an onset when its flux exceeds the recent mean by this factor
+static constexpr float kOnsetThreshold = 1.5f;
+
+// Flux below this is silence, never an onset
+static constexpr float kOnsetFloor = 0.01f;
+
+// Frames between onsets at least (about 50 ms at 48 kHz)
+static constexpr int kMinOnsetHops = 5;
+
+// ============================================================================
+// SoundAnalyzer
+// ============================================================================
+
+SoundAnalyzer& SoundAnalyzer::instance() {
+    static SoundAnalyzer analyzer;
+    return analyzer;
+}
+
+SoundAnalyzer::SoundAnalyzer() {
+    fftSetup_ = vDSP_create_fftsetup(kLog2FFTSize, FFT_RADIX2);
+    vDSP_hann_window(window_, kFFTSize, vDSP_HANN_NORM);
+
+    // zrip doubles its output, and one-sided bins carry half the power:
+    // dividing by the window sum makes a full-scale sine read 1.0
+    float sum = 0.0f;
+    vDSP_sve(window_, 1, &sum, kFFTSize);
+    windowScale_ = sum > 0.0f ? 1.0f / sum : 1.0f;
+}
+
+SoundAnalyzer::~SoundAnalyzer() {
+    if (fftSetup_) {
+        vDSP_destroy_fftsetup(fftSetup_);
+    }
+}
+
+bool SoundAnalyzer::attach() {
+    if (attached_) return true;
+
+    SoundEngine& engine = SoundEngine::instance();
+    if (!engine.start() || !fftSetup_) {
+        return false;
+    }
+
+    @autoreleasepool {
+        AVAudioMixerNode* mixer = engine.getEngine().mainMixerNode;
+        [mixer installTapOnBus:0 bufferSize:kHop * 2 format:nil
+                         block:^(AVAudioPCMBuffer* buffer, AVAudioTime*) {
+                             SoundAnalyzer::instance().process(buffer);
+                         }];
+    }
+    attached_ = true;
+    return true;
+}
+
+const SoundAnalyzer::Frame& SoundAnalyzer::latest() {
+    if (shared_.load(std::memory_order_relaxed) & kFresh) {
+        front_ = shared_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+    }
+    return slots_[front_];
+}
+
+void SoundAnalyzer::process(AVAudioPCMBuffer* buffer) {
+    const AVAudioChannelCount channels = buffer.format.channelCount;
+    const AVAudioFrameCount frames = buffer.frameLength;
+    float* const* data = buffer.floatChannelData;
+    if (!data || channels == 0) return;
+
+    const float gain = 1.0f / static_cast<float>(channels);
+    for (AVAudioFrameCount i = 0; i < frames; i++) {
+        float mono = 0.0f;
+        for (AVAudioChannelCount c = 0; c < channels; c++) {
+            mono += data[c][i];
+        }
+        history_[writePos_] = mono * gain;
+        writePos_ = (writePos_ + 1) % kFFTSize;
+
+        if (++pending_ == kHop) {
+            pending_ = 0;
+            analyze();
+        }
+    }
+}
+
+void SoundAnalyzer::analyze() {
+    // Oldest sample first, windowed
+    const int tail = kFFTSize - writePos_;
+    vDSP_vmul(history_ + writePos_, 1, window_, 1, windowed_, 1, tail);
+    vDSP_vmul(history_, 1, window_ + tail, 1, windowed_ + tail, 1, writePos_);
+
+    DSPSplitComplex split = {real_, imag_};
+    vDSP_ctoz(reinterpret_cast<const DSPComplex*>(windowed_), 2, &split, 1, kBins);
+    vDSP_fft_zrip(fftSetup_, &split, 1, kLog2FFTSize, FFT_FORWARD);
+    imag_[0] = 0.0f;    // Packed Nyquist term
+
+    Frame& frame = slots_[back_];
+    vDSP_zvabs(&split, 1, frame.magnitudes, 1, kBins);
+    vDSP_vsmul(frame.magnitudes, 1, &windowScale_, frame.magnitudes, 1, kBins);
+
+    // Spectral flux: how much the spectrum rose since the previous frame
+    float flux = 0.0f;
+    for (int i = 0; i < kBins; i++) {
+        flux += std::max(0.0f, frame.magnitudes[i] - previous_[i]);
+    }
+    std::copy(frame.magnitudes, frame.magnitudes + kBins, previous_);
+
+    float mean = 0.0f;
+    vDSP_meanv(fluxHistory_, 1, &mean, kFluxHistory);
+    hopsSinceOnset_++;
+    if (flux > kOnsetFloor && flux > mean * kOnsetThreshold && flux > lastFlux_ &&
+        hopsSinceOnset_ >= kMinOnsetHops) {
+        onsets_++;
+        hopsSinceOnset_ = 0;
+    }
+    fluxHistory_[fluxIndex_] = flux;
+    fluxIndex_ = (fluxIndex_ + 1) % kFluxHistory;
+    lastFlux_ = flux;
+
+    frame.flux = flux;
+    frame.onsets = onsets_;
+    back_ = shared_.exchange(back_ | kFresh, std::memory_order_acq_rel) & kIndexMask;
+}
+
+} // namespace oflike
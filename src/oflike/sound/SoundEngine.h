@@ -0,0 +1,129 @@
+#pragma once
+
+// oflike-metal SoundEngine - the AVAudioEngine shared by every ofSoundPlayer
+// Objective-C++ only: decodes samples once into buffers shared by all
+// players, and plays them on a pool of player nodes attached to one engine
+
+#import <AVFoundation/AVFoundation.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oflike {
+
+// ============================================================================
+// Samples & Voices
+// ============================================================================
+
+/// A sound decoded into the engine's format (stereo float at its sample
+/// rate), shared by every player that loaded the same file
+struct SoundSample {
+    AVAudioPCMBuffer* buffer = nil;
+
+    AVAudioFrameCount getLength() const { return buffer ? buffer.frameLength : 0; }
+    double getSampleRate() const { return buffer ? buffer.format.sampleRate : 0.0; }
+};
+
+/// A pooled player node (with varispeed for speed changes) playing one
+/// trigger of a sample. Owned by the engine; players borrow voices per
+/// trigger and may lose them to voice stealing, which bumps generation.
+struct SoundVoice {
+    AVAudioPlayerNode* node = nil;
+    AVAudioUnitVarispeed* varispeed = nil;
+
+    // Main thread
+    const void* owner = nullptr;    // Player using the voice, null when free
+    uint64_t generation = 0;        // Bumped on every trigger
+    double startedAt = 0.0;         // Trigger time (host seconds), for stealing the oldest
+    AVAudioFramePosition startFrame = 0;   // Sample frame the trigger started at
+    AVAudioFrameCount length = 0;   // Frames of the sample
+    bool looping = false;
+    bool paused = false;
+
+    // Latest generation that finished playing; set on the audio thread
+    std::atomic<uint64_t> finishedGeneration{0};
+
+    /// Check if the voice still plays (or waits to play) its trigger
+    bool isActive() const {
+        return owner && finishedGeneration.load(std::memory_order_acquire) != generation;
+    }
+
+    /// Audio thread: mark a trigger finished
+    void finish(uint64_t triggerGeneration) {
+        uint64_t previous = finishedGeneration.load(std::memory_order_relaxed);
+        while (previous < triggerGeneration &&
+               !finishedGeneration.compare_exchange_weak(previous, triggerGeneration,
+                                                         std::memory_order_acq_rel)) {
+        }
+    }
+};
+
+// ============================================================================
+// SoundEngine
+// ============================================================================
+
+/// The process-wide audio engine (main thread)
+class SoundEngine {
+public:
+    /// Voices mixed at once; the oldest is stolen beyond this
+    static constexpr size_t kMaxVoices = 64;
+
+    static SoundEngine& instance();
+
+    /// Start the engine if needed
+    /// \return false if no output is available
+    bool start();
+
+    AVAudioEngine* getEngine() const { return engine_; }
+
+    /// Format of decoded samples and voices (stereo float)
+    AVAudioFormat* getFormat() const { return format_; }
+
+    /// Decode a file, or share the buffer of an earlier load of it
+    std::shared_ptr<SoundSample> loadSample(NSURL* url);
+
+    /// Borrow a voice for a new trigger: a free one, a new one while the
+    /// pool grows, or the oldest playing one
+    SoundVoice* acquireVoice(const void* owner);
+
+    /// Stop and free every voice of a player
+    void releaseVoices(const void* owner);
+
+    /// Voices currently borrowed by a player
+    void getVoices(const void* owner, std::vector<SoundVoice*>& voices);
+
+    /// Attach a node chain playing a format of its own (streamed files)
+    void attachStream(AVAudioPlayerNode* node, AVAudioUnitVarispeed* varispeed, AVAudioFormat* format);
+
+    /// Detach a chain attached with attachStream()
+    void detachStream(AVAudioPlayerNode* node, AVAudioUnitVarispeed* varispeed);
+
+    /// Engine time for a host time, or nil (as soon as possible) for one that passed
+    static AVAudioTime* timeAt(double hostSeconds);
+
+    /// Current host time in seconds (CACurrentMediaTime())
+    static double now();
+
+    /// Output volume of the whole engine (applied once it starts)
+    void setMasterVolume(float volume);
+
+private:
+    SoundEngine() = default;
+
+    void configurationChanged();
+
+    AVAudioEngine* engine_ = nil;
+    AVAudioFormat* format_ = nil;
+    id observer_ = nil;
+    float masterVolume_ = 1.0f;
+    std::vector<std::unique_ptr<SoundVoice>> voices_;
+
+    std::mutex samplesMutex_;
+    std::unordered_map<std::string, std::weak_ptr<SoundSample>> samples_;
+};
+
+} // namespace oflike
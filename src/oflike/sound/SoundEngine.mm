@@ -0,0 +1,231 @@
+#import "SoundEngine.h"
+#import <QuartzCore/QuartzCore.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace oflike {
+
+// ============================================================================
+// SoundEngine
+// ============================================================================
+
+SoundEngine& SoundEngine::instance() {
+    static SoundEngine engine;
+    return engine;
+}
+
+bool SoundEngine::start() {
+    @autoreleasepool {
+        if (!engine_) {
+            engine_ = [[AVAudioEngine alloc] init];
+
+            // Samples decode to the output rate, so voices never resample
+            const double sampleRate = [engine_.outputNode outputFormatForBus:0].sampleRate;
+            format_ = [[AVAudioFormat alloc] initStandardFormatWithSampleRate:sampleRate > 0.0 ? sampleRate : 48000.0
+                                                                     channels:2];
+            [engine_ connect:engine_.mainMixerNode to:engine_.outputNode format:nil];
+            engine_.mainMixerNode.outputVolume = masterVolume_;
+
+            observer_ = [[NSNotificationCenter defaultCenter]
+                addObserverForName:AVAudioEngineConfigurationChangeNotification
+                            object:engine_
+                             queue:[NSOperationQueue mainQueue]
+                        usingBlock:^(NSNotification*) {
+                            SoundEngine::instance().configurationChanged();
+                        }];
+        }
+
+        if (!engine_.isRunning) {
+            [engine_ prepare];
+            NSError* error = nil;
+            if (![engine_ startAndReturnError:&error]) {
+                NSLog(@"SoundEngine: Failed to start: %@", error.localizedDescription);
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+void SoundEngine::configurationChanged() {
+    // The output device changed and the engine stopped; voices keep their
+    // connections and the mixer converts to the new rate
+    NSLog(@"SoundEngine: Output changed, restarting");
+    for (const auto& voice : voices_) {
+        if (voice->owner) {
+            voice->finish(voice->generation);
+            [voice->node stop];
+        }
+    }
+    start();
+}
+
+std::shared_ptr<SoundSample> SoundEngine::loadSample(NSURL* url) {
+    @autoreleasepool {
+        const std::string key = url.path.UTF8String;
+        {
+            std::lock_guard<std::mutex> lock(samplesMutex_);
+            auto it = samples_.find(key);
+            if (it != samples_.end()) {
+                if (std::shared_ptr<SoundSample> shared = it->second.lock()) {
+                    return shared;
+                }
+            }
+        }
+
+        NSError* error = nil;
+        AVAudioFile* file = [[AVAudioFile alloc] initForReading:url error:&error];
+        if (!file) {
+            NSLog(@"SoundEngine: Failed to open %@: %@", url.path, error.localizedDescription);
+            return nullptr;
+        }
+
+        AVAudioFormat* fileFormat = file.processingFormat;
+        const AVAudioFrameCount fileFrames = static_cast<AVAudioFrameCount>(file.length);
+        AVAudioPCMBuffer* decoded = [[AVAudioPCMBuffer alloc] initWithPCMFormat:fileFormat frameCapacity:fileFrames];
+        if (!decoded || ![file readIntoBuffer:decoded error:&error]) {
+            NSLog(@"SoundEngine: Failed to decode %@: %@", url.path, error.localizedDescription);
+            return nullptr;
+        }
+
+        // To the engine's rate; mono is converted as is and duplicated below
+        const AVAudioChannelCount channels = fileFormat.channelCount == 1 ? 1 : 2;
+        AVAudioFormat* target = [[AVAudioFormat alloc] initStandardFormatWithSampleRate:format_.sampleRate
+                                                                               channels:channels];
+        AVAudioPCMBuffer* converted = decoded;
+        if (![fileFormat isEqual:target]) {
+            AVAudioConverter* converter = [[AVAudioConverter alloc] initFromFormat:fileFormat toFormat:target];
+            converter.downmix = YES;
+            const AVAudioFrameCount capacity = static_cast<AVAudioFrameCount>(
+                std::ceil(fileFrames * target.sampleRate / fileFormat.sampleRate)) + 1;
+            converted = [[AVAudioPCMBuffer alloc] initWithPCMFormat:target frameCapacity:capacity];
+
+            __block bool supplied = false;
+            AVAudioConverterOutputStatus status =
+                [converter convertToBuffer:converted error:&error
+                        withInputFromBlock:^AVAudioBuffer*(AVAudioPacketCount, AVAudioConverterInputStatus* inputStatus) {
+                            if (supplied) {
+                                *inputStatus = AVAudioConverterInputStatus_EndOfStream;
+                                return nil;
+                            }
+                            supplied = true;
+                            *inputStatus = AVAudioConverterInputStatus_HaveData;
+                            return decoded;
+                        }];
+            if (status == AVAudioConverterOutputStatus_Error) {
+                NSLog(@"SoundEngine: Failed to convert %@: %@", url.path, error.localizedDescription);
+                return nullptr;
+            }
+        }
+
+        auto sample = std::make_shared<SoundSample>();
+        if (channels == 1) {
+            sample->buffer = [[AVAudioPCMBuffer alloc] initWithPCMFormat:format_ frameCapacity:converted.frameLength];
+            sample->buffer.frameLength = converted.frameLength;
+            const size_t bytes = sizeof(float) * converted.frameLength;
+            std::memcpy(sample->buffer.floatChannelData[0], converted.floatChannelData[0], bytes);
+            std::memcpy(sample->buffer.floatChannelData[1], converted.floatChannelData[0], bytes);
+        } else {
+            sample->buffer = converted;
+        }
+
+        std::lock_guard<std::mutex> lock(samplesMutex_);
+        samples_[key] = sample;
+        return sample;
+    }
+}
+
+SoundVoice* SoundEngine::acquireVoice(const void* owner) {
+    if (!start()) {
+        return nullptr;
+    }
+
+    SoundVoice* voice = nullptr;
+    for (const auto& candidate : voices_) {
+        if (!candidate->isActive()) {
+            voice = candidate.get();
+            break;
+        }
+    }
+
+    if (!voice && voices_.size() < kMaxVoices) {
+        auto added = std::make_unique<SoundVoice>();
+        added->node = [[AVAudioPlayerNode alloc] init];
+        added->varispeed = [[AVAudioUnitVarispeed alloc] init];
+        [engine_ attachNode:added->node];
+        [engine_ attachNode:added->varispeed];
+        [engine_ connect:added->node to:added->varispeed format:format_];
+        [engine_ connect:added->varispeed to:engine_.mainMixerNode format:format_];
+        voice = added.get();
+        voices_.push_back(std::move(added));
+    }
+
+    if (!voice) {
+        // Every voice plays: steal the oldest trigger
+        voice = std::min_element(voices_.begin(), voices_.end(),
+                                 [](const auto& a, const auto& b) { return a->startedAt < b->startedAt; })->get();
+    }
+
+    voice->finish(voice->generation);
+    [voice->node stop];
+    voice->owner = owner;
+    voice->generation++;
+    voice->startedAt = now();
+    voice->paused = false;
+    return voice;
+}
+
+void SoundEngine::releaseVoices(const void* owner) {
+    for (const auto& voice : voices_) {
+        if (voice->owner == owner) {
+            voice->finish(voice->generation);
+            [voice->node stop];
+            voice->owner = nullptr;
+        }
+    }
+}
+
+void SoundEngine::getVoices(const void* owner, std::vector<SoundVoice*>& voices) {
+    voices.clear();
+    for (const auto& voice : voices_) {
+        if (voice->owner == owner && voice->isActive()) {
+            voices.push_back(voice.get());
+        }
+    }
+}
+
+void SoundEngine::attachStream(AVAudioPlayerNode* node, AVAudioUnitVarispeed* varispeed, AVAudioFormat* format) {
+    if (!start()) return;
+    [engine_ attachNode:node];
+    [engine_ attachNode:varispeed];
+    [engine_ connect:node to:varispeed format:format];
+    [engine_ connect:varispeed to:engine_.mainMixerNode format:format];
+}
+
+void SoundEngine::detachStream(AVAudioPlayerNode* node, AVAudioUnitVarispeed* varispeed) {
+    if (!engine_) return;
+    [node stop];
+    [engine_ detachNode:node];
+    [engine_ detachNode:varispeed];
+}
+
+AVAudioTime* SoundEngine::timeAt(double hostSeconds) {
+    if (hostSeconds <= now()) {
+        return nil;
+    }
+    return [AVAudioTime timeWithHostTime:[AVAudioTime hostTimeForSeconds:hostSeconds]];
+}
+
+double SoundEngine::now() {
+    return CACurrentMediaTime();
+}
+
+void SoundEngine::setMasterVolume(float volume) {
+    masterVolume_ = volume;
+    if (engine_) {
+        engine_.mainMixerNode.outputVolume = volume;
+    }
+}
+
+} // namespace oflike
@@ -12,7 +12,13 @@ enum ofLoopType {
     OF_LOOP_PALINDROME = 2  // Not supported for audio, treated as LOOP_NORMAL
 };
 
-/// Sound player for audio file playback using AVFoundation
+/// Sound player for audio file playback using AVAudioEngine
+///
+/// All players share one engine. Short sounds are decoded once into a buffer
+/// shared by every player of the file and play on a pool of voices, so
+/// overlapping triggers in multi-play mode cost neither file loads nor
+/// memory. Long sounds stream from disk. Triggers can be scheduled on the
+/// host clock with playAt(), which lines them up to the sample.
 class ofSoundPlayer {
 public:
     ofSoundPlayer();
@@ -32,7 +38,8 @@ public:
 
     /// Load a sound file
     /// @param path Path to the audio file (relative to app bundle or absolute)
-    /// @param stream If true, stream the audio instead of loading entirely into memory
+    /// @param stream If true, stream the audio instead of loading entirely into memory.
+    ///        Files longer than 30 seconds always stream; streamed sounds play one at a time
     /// @return true if loaded successfully
     bool load(const std::string& path, bool stream = false);
 
@@ -49,6 +56,11 @@ public:
     /// Start playing the sound
     void play();
 
+    /// Start playing the sound at a time on the host clock (ofSoundGetTime())
+    /// Triggers given the same time start on the same sample; times already
+    /// passed play as soon as possible
+    void playAt(double hostTime);
+
     /// Stop playing
     void stop();
 
@@ -91,7 +103,7 @@ public:
     // Speed & Pitch
     // ========================================
 
-    /// Set the playback speed (1.0 = normal, 0.5 = half speed, 2.0 = double speed)
+    /// Set the playback speed (1.0 = normal, 0.5 = half speed, 2.0 = double speed; 0.25 - 4.0)
     void setSpeed(float speed);
 
     /// Get the current playback speed
@@ -118,6 +130,8 @@ public:
     // ========================================
 
     /// Enable multi-play mode (allows overlapping plays)
+    /// Up to 64 voices play at once across all players; beyond that the
+    /// oldest trigger is cut
     void setMultiPlay(bool multiPlay);
 
     /// Check if multi-play is enabled
@@ -143,4 +157,24 @@ void ofSoundStopAll();
 /// Update the sound system (call once per frame)
 void ofSoundUpdate();
 
+/// Current time on the host clock in seconds (CACurrentMediaTime()), for playAt()
+double ofSoundGetTime();
+
+// ========================================
+// Sound Analysis
+// ========================================
+
+/// Get the spectrum of everything currently playing
+/// Analysis starts on the first call; FFTs of 2048 samples run on the audio
+/// engine's tap every 512 samples
+/// @param nBands Number of linear frequency bands (1 - 1024)
+/// @return nBands magnitudes (1.0 = full-scale sine), valid until the next call
+float* ofSoundGetSpectrum(int nBands);
+
+/// Get the spectral flux of the latest analysis frame (how much the spectrum rose)
+float ofSoundGetSpectralFlux();
+
+/// Check if an onset (a beat or attack) was detected since the last call
+bool ofSoundGetOnset();
+
 } // namespace oflike
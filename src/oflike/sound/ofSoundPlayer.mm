@@ -1,6 +1,9 @@
 #import "ofSoundPlayer.h"
+#import "SoundEngine.h"
+#import "SoundAnalyzer.h"
 #import <AVFoundation/AVFoundation.h>
 #import <Foundation/Foundation.h>
+#import <algorithm>
 #import <vector>
 #import <mutex>
 
@@ -11,25 +14,58 @@ static float globalVolume = 1.0f;
 static std::vector<ofSoundPlayer*> activePlayers;
 static std::mutex playersMutex;
 
+// Files longer than this stream from disk even when loaded without streaming
+static constexpr double kStreamAboveSeconds = 30.0;
+
+// ============================================================================
+// Stream Scheduling
+// ============================================================================
+
+// Queue a file segment on a streaming voice. A looping stream keeps one pass
+// queued ahead: each pass the player finishes reading queues the next.
+// Handlers hold the voice, as they may run after the player unloaded.
+static void scheduleStream(const std::shared_ptr<SoundVoice>& voice, AVAudioFile* file,
+                           AVAudioFramePosition from, bool looping, uint64_t generation) {
+    const AVAudioFrameCount frames = static_cast<AVAudioFrameCount>(std::max<AVAudioFramePosition>(0, file.length - from));
+    if (looping) {
+        [voice->node scheduleSegment:file startingFrame:from frameCount:frames atTime:nil
+              completionCallbackType:AVAudioPlayerNodeCompletionDataConsumed
+                   completionHandler:^(AVAudioPlayerNodeCompletionCallbackType) {
+                       if (voice->finishedGeneration.load(std::memory_order_acquire) < generation) {
+                           scheduleStream(voice, file, 0, true, generation);
+                       }
+                   }];
+    } else {
+        [voice->node scheduleSegment:file startingFrame:from frameCount:frames atTime:nil
+              completionCallbackType:AVAudioPlayerNodeCompletionDataPlayedBack
+                   completionHandler:^(AVAudioPlayerNodeCompletionCallbackType) {
+                       voice->finish(generation);
+                   }];
+    }
+}
+
 // ============================================================================
 // ofSoundPlayer::Impl
 // ============================================================================
 
 struct ofSoundPlayer::Impl {
-    AVAudioPlayer* player = nil;
-    NSMutableArray<AVAudioPlayer*>* multiPlayers = nil;  // For multi-play mode
+    // In-memory sounds play on pooled voices with the shared decoded sample
+    std::shared_ptr<SoundSample> sample;
+
+    // Streamed sounds play from the file on a voice of their own
+    AVAudioFile* streamFile = nil;
+    std::shared_ptr<SoundVoice> stream;
 
     std::string filePath;
     bool loaded = false;
     bool multiPlay = false;
+    bool paused = false;
     float volume = 1.0f;
     float pan = 0.0f;
     float speed = 1.0f;
     bool looping = false;
 
-    Impl() {
-        multiPlayers = [[NSMutableArray alloc] init];
-    }
+    std::vector<SoundVoice*> voices;   // Scratch for engine queries
 
     ~Impl() {
         unload();
@@ -37,192 +73,308 @@ struct ofSoundPlayer::Impl {
 
     void unload() {
         @autoreleasepool {
-            if (player) {
-                [player stop];
-                player = nil;
-            }
-
-            for (AVAudioPlayer* p in multiPlayers) {
-                [p stop];
+            stop();
+            if (stream) {
+                SoundEngine::instance().detachStream(stream->node, stream->varispeed);
+                stream.reset();
             }
-            [multiPlayers removeAllObjects];
+            streamFile = nil;
+            sample.reset();
 
             loaded = false;
             filePath.clear();
         }
     }
 
-    bool load(const std::string& path, bool stream) {
+    bool load(const std::string& path, bool streamFromDisk) {
         @autoreleasepool {
             unload();
 
             // Resolve path
             NSString* nsPath = [NSString stringWithUTF8String:path.c_str()];
-            NSURL* url = nil;
-
-            // Check if it's a URL
             if ([nsPath hasPrefix:@"http://"] || [nsPath hasPrefix:@"https://"]) {
-                url = [NSURL URLWithString:nsPath];
-            } else {
-                // Handle relative paths
-                if (![nsPath hasPrefix:@"/"]) {
-                    NSString* bundlePath = [[NSBundle mainBundle] resourcePath];
-                    nsPath = [bundlePath stringByAppendingPathComponent:nsPath];
-                }
-                url = [NSURL fileURLWithPath:nsPath];
-            }
-
-            if (!url) {
-                NSLog(@"ofSoundPlayer: Invalid path: %s", path.c_str());
+                NSLog(@"ofSoundPlayer: Remote files are not supported: %s", path.c_str());
                 return false;
             }
+            if (![nsPath hasPrefix:@"/"]) {
+                NSString* bundlePath = [[NSBundle mainBundle] resourcePath];
+                nsPath = [bundlePath stringByAppendingPathComponent:nsPath];
+            }
+            NSURL* url = [NSURL fileURLWithPath:nsPath];
 
             // Check if file exists
-            if ([url isFileURL] && ![[NSFileManager defaultManager] fileExistsAtPath:[url path]]) {
+            if (![[NSFileManager defaultManager] fileExistsAtPath:[url path]]) {
                 NSLog(@"ofSoundPlayer: File not found: %@", [url path]);
                 return false;
             }
 
-            // Create player
-            NSError* error = nil;
-            player = [[AVAudioPlayer alloc] initWithContentsOfURL:url error:&error];
-
-            if (error || !player) {
-                NSLog(@"ofSoundPlayer: Failed to load: %@ - %@",
-                      [url path], error ? [error localizedDescription] : @"Unknown error");
+            SoundEngine& engine = SoundEngine::instance();
+            if (!engine.start()) {
                 return false;
             }
 
-            // Prepare for playback
-            [player prepareToPlay];
-
-            // Apply current settings
-            player.volume = volume * globalVolume;
-            player.pan = pan;
-            player.enableRate = YES;
-            player.rate = speed;
-            player.numberOfLoops = looping ? -1 : 0;
+            NSError* error = nil;
+            AVAudioFile* file = [[AVAudioFile alloc] initForReading:url error:&error];
+            if (!file) {
+                NSLog(@"ofSoundPlayer: Failed to load: %@ - %@", [url path], [error localizedDescription]);
+                return false;
+            }
+            const double duration = file.length / file.processingFormat.sampleRate;
+
+            if (streamFromDisk || duration > kStreamAboveSeconds) {
+                streamFile = file;
+                stream = std::make_shared<SoundVoice>();
+                stream->node = [[AVAudioPlayerNode alloc] init];
+                stream->varispeed = [[AVAudioUnitVarispeed alloc] init];
+                engine.attachStream(stream->node, stream->varispeed, file.processingFormat);
+            } else {
+                // Decoded once; every player of the file shares the buffer
+                sample = engine.loadSample(url);
+                if (!sample) {
+                    return false;
+                }
+            }
 
             filePath = path;
             loaded = true;
 
-            NSLog(@"ofSoundPlayer: Loaded %s (%.2f sec)", path.c_str(), player.duration);
+            NSLog(@"ofSoundPlayer: Loaded %s (%.2f sec%s)", path.c_str(), duration, stream ? ", streaming" : "");
             return true;
         }
     }
 
-    void play() {
-        if (!loaded || !player) return;
+    // ========================================================================
+    // Voices
+    // ========================================================================
 
-        @autoreleasepool {
-            if (multiPlay) {
-                // Create a new player instance for overlapping playback
-                NSError* error = nil;
-                AVAudioPlayer* newPlayer = [[AVAudioPlayer alloc]
-                    initWithContentsOfURL:[NSURL fileURLWithPath:
-                        [NSString stringWithUTF8String:filePath.c_str()]]
-                    error:&error];
-
-                if (newPlayer) {
-                    newPlayer.volume = volume * globalVolume;
-                    newPlayer.pan = pan;
-                    newPlayer.enableRate = YES;
-                    newPlayer.numberOfLoops = 0;  // Multi-play sounds don't loop
-                    [newPlayer prepareToPlay];
-                    newPlayer.rate = speed;  // Set rate after prepareToPlay
-                    [newPlayer play];
-                    [multiPlayers addObject:newPlayer];
-
-                    // Clean up finished players
-                    NSMutableArray* toRemove = [[NSMutableArray alloc] init];
-                    for (AVAudioPlayer* p in multiPlayers) {
-                        if (!p.isPlaying) {
-                            [toRemove addObject:p];
-                        }
-                    }
-                    [multiPlayers removeObjectsInArray:toRemove];
+    // Voices of this player still playing or waiting to play
+    std::vector<SoundVoice*>& activeVoices() {
+        voices.clear();
+        if (stream) {
+            if (stream->isActive()) {
+                voices.push_back(stream.get());
+            }
+        } else {
+            SoundEngine::instance().getVoices(this, voices);
+        }
+        return voices;
+    }
+
+    // Most recent trigger, which position queries refer to
+    SoundVoice* latestVoice() {
+        SoundVoice* latest = nullptr;
+        for (SoundVoice* voice : activeVoices()) {
+            if (!latest || voice->startedAt > latest->startedAt) {
+                latest = voice;
+            }
+        }
+        return latest;
+    }
+
+    void applySettings(SoundVoice* voice) const {
+        voice->node.volume = volume;
+        voice->node.pan = pan;
+        voice->varispeed.rate = speed;
+    }
+
+    // Start a trigger from a frame at a host time (0: as soon as possible)
+    void trigger(AVAudioFramePosition from, double hostTime) {
+        SoundVoice* voice = nullptr;
+        if (stream) {
+            stopStream();
+            voice = stream.get();
+            voice->owner = this;
+            voice->generation++;
+            voice->startedAt = SoundEngine::now();
+        } else {
+            voice = SoundEngine::instance().acquireVoice(this);
+        }
+        if (!voice) return;
+
+        voice->length = static_cast<AVAudioFrameCount>(stream ? streamFile.length : sample->getLength());
+        if (voice->length == 0) {
+            voice->finish(voice->generation);
+            return;
+        }
+        voice->startFrame = std::clamp<AVAudioFramePosition>(from, 0, voice->length - 1);
+        voice->looping = looping;
+        voice->paused = false;
+        applySettings(voice);
+
+        const uint64_t generation = voice->generation;
+        if (stream) {
+            scheduleStream(stream, streamFile, voice->startFrame, looping, generation);
+            if (looping) {
+                // A second pass queued ahead keeps the loop gapless
+                scheduleStream(stream, streamFile, 0, true, generation);
+            }
+        } else {
+            AVAudioPCMBuffer* buffer = sample->buffer;
+            if (voice->startFrame > 0) {
+                buffer = remainder(voice->startFrame);
+            }
+            if (looping) {
+                if (voice->startFrame > 0) {
+                    [voice->node scheduleBuffer:buffer completionHandler:nil];
                 }
+                [voice->node scheduleBuffer:sample->buffer atTime:nil options:AVAudioPlayerNodeBufferLoops
+                          completionHandler:nil];
             } else {
-                // Normal single-play mode
-                player.currentTime = 0;
-                player.rate = speed;  // Ensure rate is applied
-                [player play];
+                SoundVoice* target = voice;
+                [voice->node scheduleBuffer:buffer atTime:nil options:0
+                     completionCallbackType:AVAudioPlayerNodeCompletionDataPlayedBack
+                          completionHandler:^(AVAudioPlayerNodeCompletionCallbackType) {
+                              target->finish(generation);
+                          }];
             }
         }
+
+        // Starting on a host time lines triggers up to the sample
+        [voice->node playAtTime:SoundEngine::timeAt(hostTime)];
+        paused = false;
     }
 
-    void stop() {
+    // The sample from a frame on, for triggers that don't start at the top
+    AVAudioPCMBuffer* remainder(AVAudioFramePosition from) const {
+        const AVAudioFrameCount frames = sample->getLength() - static_cast<AVAudioFrameCount>(from);
+        AVAudioPCMBuffer* buffer = [[AVAudioPCMBuffer alloc] initWithPCMFormat:sample->buffer.format frameCapacity:frames];
+        buffer.frameLength = frames;
+        for (AVAudioChannelCount channel = 0; channel < buffer.format.channelCount; channel++) {
+            std::copy_n(sample->buffer.floatChannelData[channel] + from, frames, buffer.floatChannelData[channel]);
+        }
+        return buffer;
+    }
+
+    void stopStream() {
+        if (stream && stream->owner) {
+            stream->finish(stream->generation);
+            [stream->node stop];
+            stream->owner = nullptr;
+        }
+    }
+
+    // Frame a voice is playing, in the sample's (or file's) frames
+    AVAudioFramePosition framePosition(SoundVoice* voice) const {
+        AVAudioTime* nodeTime = voice->node.lastRenderTime;
+        AVAudioTime* playerTime = nodeTime ? [voice->node playerTimeForNodeTime:nodeTime] : nil;
+        AVAudioFramePosition frame = voice->startFrame;
+        if (playerTime && playerTime.sampleTimeValid) {
+            frame += std::max<AVAudioFramePosition>(0, playerTime.sampleTime);
+        }
+        if (voice->length == 0) return 0;
+        return voice->looping ? frame % voice->length : std::min<AVAudioFramePosition>(frame, voice->length);
+    }
+
+    double sampleRate() const {
+        if (stream) return streamFile.processingFormat.sampleRate;
+        return sample ? sample->getSampleRate() : 0.0;
+    }
+
+    double lengthFrames() const {
+        if (stream) return static_cast<double>(streamFile.length);
+        return sample ? sample->getLength() : 0.0;
+    }
+
+    // Restart the latest trigger from a frame, keeping it paused if it was
+    void seek(AVAudioFramePosition frame) {
+        SoundVoice* latest = latestVoice();
+        if (!latest) return;
+        const bool wasPaused = paused;
+        if (!stream) {
+            latest->finish(latest->generation);
+            [latest->node stop];
+            latest->owner = nullptr;
+        }
+        trigger(frame, 0.0);
+        if (wasPaused) {
+            pause();
+        }
+    }
+
+    // ========================================================================
+    // Playback
+    // ========================================================================
+
+    void play() {
+        if (!loaded) return;
+
         @autoreleasepool {
-            if (player) {
-                [player stop];
-                player.currentTime = 0;
+            if (paused) {
+                // Resume where pause() left off
+                for (SoundVoice* voice : activeVoices()) {
+                    voice->paused = false;
+                    [voice->node play];
+                }
+                paused = false;
+                return;
             }
+            playAt(0.0);
+        }
+    }
 
-            for (AVAudioPlayer* p in multiPlayers) {
-                [p stop];
+    void playAt(double hostTime) {
+        if (!loaded) return;
+
+        @autoreleasepool {
+            // One trigger at a time unless multi-play overlaps them
+            if (!multiPlay || stream) {
+                stop();
             }
-            [multiPlayers removeAllObjects];
+            trigger(0, hostTime);
+        }
+    }
+
+    void stop() {
+        @autoreleasepool {
+            stopStream();
+            SoundEngine::instance().releaseVoices(this);
+            paused = false;
         }
     }
 
     void pause() {
         @autoreleasepool {
-            if (player) {
-                [player pause];
+            for (SoundVoice* voice : activeVoices()) {
+                voice->paused = true;
+                [voice->node pause];
             }
+            paused = !voices.empty();
         }
     }
 
-    bool isPlaying() const {
-        if (player && player.isPlaying) return true;
-
-        for (AVAudioPlayer* p in multiPlayers) {
-            if (p.isPlaying) return true;
-        }
-        return false;
+    bool isPlaying() {
+        return !paused && !activeVoices().empty();
     }
 
     void setVolume(float vol) {
         volume = std::max(0.0f, std::min(1.0f, vol));
-        @autoreleasepool {
-            if (player) {
-                player.volume = volume * globalVolume;
-            }
-            for (AVAudioPlayer* p in multiPlayers) {
-                p.volume = volume * globalVolume;
-            }
+        for (SoundVoice* voice : activeVoices()) {
+            applySettings(voice);
         }
     }
 
     void setPan(float p) {
         pan = std::max(-1.0f, std::min(1.0f, p));
-        @autoreleasepool {
-            if (player) {
-                player.pan = pan;
-            }
-            for (AVAudioPlayer* pl in multiPlayers) {
-                pl.pan = pan;
-            }
+        for (SoundVoice* voice : activeVoices()) {
+            applySettings(voice);
         }
     }
 
     void setSpeed(float s) {
-        speed = std::max(0.5f, std::min(2.0f, s));  // AVAudioPlayer range
-        @autoreleasepool {
-            if (player) {
-                player.rate = speed;
-            }
-            for (AVAudioPlayer* p in multiPlayers) {
-                p.rate = speed;
-            }
+        speed = std::max(0.25f, std::min(4.0f, s));  // Varispeed range
+        for (SoundVoice* voice : activeVoices()) {
+            applySettings(voice);
         }
     }
 
     void setLoop(bool loop) {
+        if (looping == loop) return;
         looping = loop;
-        @autoreleasepool {
-            if (player) {
-                player.numberOfLoops = looping ? -1 : 0;
+
+        // Reschedule the current trigger with the new loop state
+        if (!multiPlay) {
+            if (SoundVoice* voice = latestVoice()) {
+                seek(framePosition(voice));
             }
         }
     }
@@ -230,28 +382,26 @@ struct ofSoundPlayer::Impl {
     void setPosition(float pct) {
         pct = std::max(0.0f, std::min(1.0f, pct));
         @autoreleasepool {
-            if (player) {
-                player.currentTime = pct * player.duration;
-            }
+            seek(static_cast<AVAudioFramePosition>(pct * lengthFrames()));
         }
     }
 
-    float getPosition() const {
-        if (!player || player.duration <= 0) return 0.0f;
-        return static_cast<float>(player.currentTime / player.duration);
+    float getPosition() {
+        SoundVoice* voice = latestVoice();
+        if (!voice || lengthFrames() <= 0.0) return 0.0f;
+        return static_cast<float>(framePosition(voice) / lengthFrames());
     }
 
     void setPositionMS(int ms) {
         @autoreleasepool {
-            if (player) {
-                player.currentTime = std::max(0.0, std::min(static_cast<double>(ms) / 1000.0, player.duration));
-            }
+            seek(static_cast<AVAudioFramePosition>(std::max(0, ms) / 1000.0 * sampleRate()));
         }
     }
 
-    int getPositionMS() const {
-        if (!player) return 0;
-        return static_cast<int>(player.currentTime * 1000.0);
+    int getPositionMS() {
+        SoundVoice* voice = latestVoice();
+        if (!voice || sampleRate() <= 0.0) return 0;
+        return static_cast<int>(framePosition(voice) / sampleRate() * 1000.0);
     }
 };
 
@@ -301,6 +451,10 @@ void ofSoundPlayer::play() {
     if (impl_) impl_->play();
 }
 
+void ofSoundPlayer::playAt(double hostTime) {
+    if (impl_) impl_->playAt(hostTime);
+}
+
 void ofSoundPlayer::stop() {
     if (impl_) impl_->stop();
 }
@@ -383,13 +537,7 @@ bool ofSoundPlayer::isMultiPlay() const {
 
 void ofSoundSetVolume(float volume) {
     globalVolume = std::max(0.0f, std::min(1.0f, volume));
-
-    std::lock_guard<std::mutex> lock(playersMutex);
-    for (ofSoundPlayer* player : activePlayers) {
-        if (player->isLoaded()) {
-            player->setVolume(player->getVolume());  // Trigger volume update
-        }
-    }
+    SoundEngine::instance().setMasterVolume(globalVolume);
 }
 
 void ofSoundStopAll() {
@@ -400,8 +548,56 @@ void ofSoundStopAll() {
 }
 
 void ofSoundUpdate() {
-    // Currently no-op, but can be used for future features
-    // like FFT analysis or automatic cleanup
+    // Voices free themselves when they finish; nothing to poll
+}
+
+double ofSoundGetTime() {
+    return SoundEngine::now();
+}
+
+// ============================================================================
+// Sound Analysis
+// ============================================================================
+
+float* ofSoundGetSpectrum(int nBands) {
+    static float bands[SoundAnalyzer::kBins];
+    nBands = std::max(1, std::min(nBands, SoundAnalyzer::kBins));
+    std::fill(bands, bands + nBands, 0.0f);
+
+    SoundAnalyzer& analyzer = SoundAnalyzer::instance();
+    if (!analyzer.attach()) {
+        return bands;
+    }
+
+    // Average the bins falling into each band
+    const SoundAnalyzer::Frame& frame = analyzer.latest();
+    for (int band = 0; band < nBands; band++) {
+        const int first = band * SoundAnalyzer::kBins / nBands;
+        const int last = (band + 1) * SoundAnalyzer::kBins / nBands;
+        float sum = 0.0f;
+        for (int bin = first; bin < last; bin++) {
+            sum += frame.magnitudes[bin];
+        }
+        bands[band] = sum / static_cast<float>(last - first);
+    }
+    return bands;
+}
+
+float ofSoundGetSpectralFlux() {
+    SoundAnalyzer& analyzer = SoundAnalyzer::instance();
+    return analyzer.attach() ? analyzer.latest().flux : 0.0f;
+}
+
+bool ofSoundGetOnset() {
+    static uint64_t seen = 0;
+    SoundAnalyzer& analyzer = SoundAnalyzer::instance();
+    if (!analyzer.attach()) {
+        return false;
+    }
+    const uint64_t onsets = analyzer.latest().onsets;
+    const bool detected = onsets != seen;
+    seen = onsets;
+    return detected;
 }
 
 } // namespace oflike
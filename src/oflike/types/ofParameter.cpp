@@ -1,6 +1,90 @@
 #include "ofParameter.h"
 #include <algorithm>
 
+// MARK: - Deferred notifications
+
+namespace {
+
+// Parameters with a change to deliver at the next flush; a parameter
+// destroyed while queued leaves a null slot
+std::vector<ofAbstractParameter*>& pendingNotifications() {
+    static std::vector<ofAbstractParameter*> pending;
+    return pending;
+}
+
+// Parameters changed inside the open batches, same convention
+std::vector<ofAbstractParameter*>& batchedNotifications() {
+    static std::vector<ofAbstractParameter*> batched;
+    return batched;
+}
+
+int batchDepth = 0;
+
+} // namespace
+
+ofAbstractParameter::~ofAbstractParameter() {
+    if (notificationQueued_) {
+        auto& pending = pendingNotifications();
+        std::replace(pending.begin(), pending.end(), this, static_cast<ofAbstractParameter*>(nullptr));
+    }
+    if (batchQueued_) {
+        auto& batched = batchedNotifications();
+        std::replace(batched.begin(), batched.end(), this, static_cast<ofAbstractParameter*>(nullptr));
+    }
+}
+
+void ofAbstractParameter::queueNotification() {
+    if (notificationQueued_) return;
+    notificationQueued_ = true;
+    pendingNotifications().push_back(this);
+}
+
+void ofAbstractParameter::queueBatchNotification() {
+    if (batchQueued_) return;
+    batchQueued_ = true;
+    batchedNotifications().push_back(this);
+}
+
+bool ofAbstractParameter::isBatching() {
+    return batchDepth > 0;
+}
+
+// MARK: - ofParameterBatch
+
+ofParameterBatch::ofParameterBatch() {
+    batchDepth++;
+}
+
+ofParameterBatch::~ofParameterBatch() {
+    if (--batchDepth > 0) return;
+
+    // Listeners run outside the batch: their own changes notify at once
+    auto& batched = batchedNotifications();
+    for (size_t i = 0; i < batched.size(); ++i) {
+        ofAbstractParameter* param = batched[i];
+        if (!param) continue;
+        batched[i] = nullptr;
+        param->batchQueued_ = false;
+        param->deliverNotification();
+    }
+    batched.clear();
+}
+
+void ofFlushParameterNotifications() {
+    auto& pending = pendingNotifications();
+
+    // Changes made by these listeners are delivered at the next flush
+    const size_t count = pending.size();
+    for (size_t i = 0; i < count; ++i) {
+        ofAbstractParameter* param = pending[i];
+        if (!param) continue;
+        pending[i] = nullptr;
+        param->notificationQueued_ = false;
+        param->deliverNotification();
+    }
+    pending.erase(pending.begin(), pending.begin() + count);
+}
+
 // MARK: - ofParameterGroup::Impl
 
 class ofParameterGroup::Impl {
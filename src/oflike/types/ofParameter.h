@@ -3,6 +3,7 @@
 // ofParameter - Value container with change callbacks
 // Used for GUI and OSC parameter synchronization
 
+#include <cstdint>
 #include <string>
 #include <functional>
 #include <memory>
@@ -11,14 +12,49 @@
 // Forward declarations
 class ofAbstractParameter;
 template<typename T> class ofParameter;
+template<typename T> class ofParameterListener;
 class ofParameterGroup;
 
+/// How a parameter tells its listeners that its value changed
+enum class ofParameterNotify {
+    Immediate,  ///< From inside every set() that changes the value
+    Deferred    ///< Once per frame, with the final value, from ofFlushParameterNotifications()
+};
+
+/// Run the listeners of deferred parameters changed since the last call
+/// Called by the app loop after update(); main thread only
+void ofFlushParameterNotifications();
+
+/// Holds back the listeners of Immediate parameters changed while it lives
+/// When the outermost batch ends, each changed parameter notifies once,
+/// after every value is set, so listeners never see half a preset:
+/// \code
+///     {
+///         ofParameterBatch batch;
+///         for (auto& [param, value] : preset) param->set(value);
+///     }   // Listeners run here
+/// \endcode
+/// Main thread only; Deferred parameters still wait for the next flush.
+class ofParameterBatch {
+public:
+    ofParameterBatch();
+    ~ofParameterBatch();
+
+    ofParameterBatch(const ofParameterBatch&) = delete;
+    ofParameterBatch& operator=(const ofParameterBatch&) = delete;
+};
+
 // MARK: - ofAbstractParameter
 
 /// Base class for all parameters
 class ofAbstractParameter {
 public:
-    virtual ~ofAbstractParameter() = default;
+    ofAbstractParameter() = default;
+    virtual ~ofAbstractParameter();
+
+    // A copy is not queued for notification
+    ofAbstractParameter(const ofAbstractParameter&) {}
+    ofAbstractParameter& operator=(const ofAbstractParameter&) { return *this; }
 
     virtual std::string getName() const = 0;
     virtual void setName(const std::string& name) = 0;
@@ -27,6 +63,95 @@ public:
     virtual void setFromString(const std::string& value) = 0;
 
     virtual std::string getType() const = 0;
+
+protected:
+    /// Have the next ofFlushParameterNotifications() call
+    /// deliverNotification(), once however often this is called before it
+    void queueNotification();
+
+    /// Have the end of the outermost ofParameterBatch call
+    /// deliverNotification(), once however often this is called before it
+    void queueBatchNotification();
+
+    /// True while an ofParameterBatch lives
+    static bool isBatching();
+
+    virtual void deliverNotification() {}
+
+private:
+    friend void ofFlushParameterNotifications();
+    friend class ofParameterBatch;
+    bool notificationQueued_ = false;
+    bool batchQueued_ = false;
+};
+
+// MARK: - ofParameterListener<T>
+
+/// A listener linked into one parameter's list of listeners
+/// Adding and removing neither allocate nor search, and a listener unlinks
+/// itself when destroyed, so one kept as a member stops with its owner:
+/// \code
+///     ofParameterListener<float> speedListener;
+///     speedListener.listen<&ofApp::speedChanged>(speed, this);
+/// \endcode
+template<typename T>
+class ofParameterListener {
+public:
+    using Function = void (*)(void* context, T& value);
+
+    ofParameterListener() = default;
+    ~ofParameterListener() { remove(); }
+
+    ofParameterListener(const ofParameterListener&) = delete;
+    ofParameterListener& operator=(const ofParameterListener&) = delete;
+
+    /// Call function(context, value) on changes; replaces an earlier listen()
+    void listen(ofParameter<T>& param, Function function, void* context) {
+        remove();
+        function_ = function;
+        context_ = context;
+        callback_ = nullptr;
+        param.link(*this);
+    }
+
+    /// Call callback(value) on changes; replaces an earlier listen()
+    void listen(ofParameter<T>& param, std::function<void(T&)> callback) {
+        remove();
+        function_ = nullptr;
+        callback_ = std::move(callback);
+        param.link(*this);
+    }
+
+    /// Call (object->*Method)(value) on changes, without a std::function
+    template<auto Method, typename C>
+    void listen(ofParameter<T>& param, C* object) {
+        listen(param, [](void* context, T& value) { (static_cast<C*>(context)->*Method)(value); }, object);
+    }
+
+    /// Stop listening
+    void remove() {
+        if (owner_) owner_->unlink(*this);
+    }
+
+    bool isListening() const { return owner_ != nullptr; }
+
+private:
+    friend class ofParameter<T>;
+
+    void invoke(T& value) {
+        if (function_) {
+            function_(context_, value);
+        } else if (callback_) {
+            callback_(value);
+        }
+    }
+
+    ofParameter<T>* owner_ = nullptr;
+    ofParameterListener* prev_ = nullptr;
+    ofParameterListener* next_ = nullptr;
+    Function function_ = nullptr;
+    void* context_ = nullptr;
+    std::function<void(T&)> callback_;
 };
 
 // MARK: - ofParameter<T>
@@ -43,16 +168,68 @@ public:
     ofParameter(const std::string& name, T value, T min, T max)
         : value_(value), min_(min), max_(max), name_(name) {}
 
+    /// Copies the value and the listeners added with addListener(), not
+    /// the ofParameterListeners linked to other
+    ofParameter(const ofParameter& other)
+        : ofAbstractParameter(other), value_(other.value_), min_(other.min_), max_(other.max_),
+          name_(other.name_), version_(other.version_), notify_(other.notify_) {
+        copyOwnedListeners(other);
+    }
+
+    ofParameter& operator=(const ofParameter& other) {
+        if (this != &other) {
+            value_ = other.value_;
+            min_ = other.min_;
+            max_ = other.max_;
+            name_ = other.name_;
+            version_ = other.version_;
+            notify_ = other.notify_;
+            owned_.clear();
+            copyOwnedListeners(other);
+        }
+        return *this;
+    }
+
+    ~ofParameter() override {
+        // Listeners outliving the parameter find themselves unlinked
+        for (ofParameterListener<T>* node = head_; node;) {
+            ofParameterListener<T>* next = node->next_;
+            node->owner_ = nullptr;
+            node->prev_ = node->next_ = nullptr;
+            node = next;
+        }
+        head_ = nullptr;
+    }
+
     // Value access
     T get() const { return value_; }
 
+    /// Set the value; listeners hear of it only if it changed
     void set(T value) {
-        if (value_ != value) {
-            value_ = value;
+        if (value_ == value) return;
+        value_ = value;
+        version_++;
+        if (!head_) return;
+
+        if (notify_ == ofParameterNotify::Deferred) {
+            queueNotification();
+        } else if (isBatching()) {
+            queueBatchNotification();
+        } else {
             notifyListeners();
         }
     }
 
+    /// Change counter: incremented each time set() changes the value, so
+    /// a change is noticed by comparing with a version seen earlier. Poll it
+    /// instead of listening where changes are handled once per frame.
+    uint64_t getVersion() const { return version_; }
+
+    /// Notify listeners from every set(), or once per frame with the final
+    /// value (for values dragged or received many times a frame)
+    void setNotifyMode(ofParameterNotify mode) { notify_ = mode; }
+    ofParameterNotify getNotifyMode() const { return notify_; }
+
     T getMin() const { return min_; }
     T getMax() const { return max_; }
 
@@ -78,18 +255,59 @@ public:
     }
 
     // Change listeners
+
+    /// Add a listener owned by the parameter, removed by removeListeners()
     void addListener(std::function<void(T&)> listener) {
-        listeners_.push_back(listener);
+        owned_.push_back(std::make_unique<ofParameterListener<T>>());
+        owned_.back()->listen(*this, std::move(listener));
     }
 
+    /// Remove every listener, owned or linked
     void removeListeners() {
-        listeners_.clear();
+        owned_.clear();
+        while (head_) {
+            unlink(*head_);
+        }
     }
 
+    bool hasListeners() const { return head_ != nullptr; }
+
+protected:
+    void deliverNotification() override { notifyListeners(); }
+
 private:
+    friend class ofParameterListener<T>;
+
+    void link(ofParameterListener<T>& node) {
+        node.owner_ = this;
+        node.prev_ = tail_;
+        node.next_ = nullptr;
+        (tail_ ? tail_->next_ : head_) = &node;
+        tail_ = &node;
+    }
+
+    void unlink(ofParameterListener<T>& node) {
+        if (notifyNext_ == &node) notifyNext_ = node.next_;
+        (node.prev_ ? node.prev_->next_ : head_) = node.next_;
+        (node.next_ ? node.next_->prev_ : tail_) = node.prev_;
+        node.owner_ = nullptr;
+        node.prev_ = node.next_ = nullptr;
+    }
+
     void notifyListeners() {
-        for (auto& listener : listeners_) {
-            listener(value_);
+        // Listeners may remove themselves or others while being notified;
+        // the next one to call is kept where unlink() can step past it
+        ofParameterListener<T>* outer = notifyNext_;
+        for (ofParameterListener<T>* node = head_; node; node = notifyNext_) {
+            notifyNext_ = node->next_;
+            node->invoke(value_);
+        }
+        notifyNext_ = outer;
+    }
+
+    void copyOwnedListeners(const ofParameter& other) {
+        for (const auto& listener : other.owned_) {
+            addListener(listener->callback_);
         }
     }
 
@@ -97,7 +315,12 @@ private:
     T min_;
     T max_;
     std::string name_;
-    std::vector<std::function<void(T&)>> listeners_;
+    uint64_t version_ = 0;
+    ofParameterNotify notify_ = ofParameterNotify::Immediate;
+    ofParameterListener<T>* head_ = nullptr;
+    ofParameterListener<T>* tail_ = nullptr;
+    ofParameterListener<T>* notifyNext_ = nullptr;
+    std::vector<std::unique_ptr<ofParameterListener<T>>> owned_;
 };
 
 // MARK: - ofParameterGroup
@@ -0,0 +1,348 @@
+#include "ofParameterPreset.h"
+#include "../../core/Context.h"
+#include "../utils/ofAsyncIO.h"
+#include "../utils/ofBuffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// File layout: the header, then one 32-bit slot per parameter
+constexpr char kPresetMagic[4] = {'O', 'F', 'P', 'S'};
+constexpr uint32_t kPresetVersion = 1;
+
+struct PresetHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+    uint64_t layout;
+};
+static_assert(sizeof(PresetHeader) == 24, "PresetHeader is written as is");
+
+enum class SlotType : uint8_t {
+    Float,
+    Int,
+    Bool
+};
+
+// A registered parameter
+struct Slot {
+    SlotType type;
+    ofAbstractParameter* param;
+};
+
+uint32_t encode(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float decodeFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// FNV-1a, continued over each name and type
+uint64_t hashLayout(uint64_t hash, const std::string& name, SlotType type) {
+    constexpr uint64_t kPrime = 1099511628211ull;
+    for (unsigned char c : name) {
+        hash = (hash ^ c) * kPrime;
+    }
+    return (hash ^ (static_cast<uint64_t>(type) + 1)) * kPrime;
+}
+
+constexpr uint64_t kLayoutSeed = 14695981039346656037ull;
+
+bool parsePreset(const char* data, size_t size, uint64_t layout, size_t count,
+                 ofParameterSnapshot& snapshot, std::string& error) {
+    PresetHeader header;
+    if (!data || size < sizeof(header)) {
+        error = "Preset file is missing or truncated";
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kPresetMagic, sizeof(kPresetMagic)) != 0 || header.version != kPresetVersion) {
+        error = "Not a preset file";
+        return false;
+    }
+    if (header.layout != layout || header.count != count) {
+        error = "Preset was saved with other parameters";
+        return false;
+    }
+    if (size < sizeof(header) + count * sizeof(uint32_t)) {
+        error = "Preset file is truncated";
+        return false;
+    }
+
+    snapshot.layout = layout;
+    snapshot.values.resize(count);
+    std::memcpy(snapshot.values.data(), data + sizeof(header), count * sizeof(uint32_t));
+    return true;
+}
+
+} // namespace
+
+// MARK: - ofParameterPreset::Impl
+
+class ofParameterPreset::Impl {
+public:
+    std::vector<Slot> slots;
+    uint64_t layout = kLayoutSeed;
+
+    // Group members, kept alive while registered
+    std::vector<std::shared_ptr<ofAbstractParameter>> retained;
+
+    // Transition in progress
+    bool transitioning = false;
+    ofParameterSnapshot from;
+    ofParameterSnapshot to;
+    double start = 0.0;         // Context elapsed time, so manual clocks apply
+    double duration = 0.0;
+
+    bool hasError = false;
+    std::string lastError;
+
+    void add(SlotType type, ofAbstractParameter& param) {
+        slots.push_back({type, &param});
+        layout = hashLayout(layout, param.getName(), type);
+        transitioning = false;
+    }
+
+    bool fail(const std::string& error) {
+        hasError = true;
+        lastError = error;
+        return false;
+    }
+
+    bool matches(const ofParameterSnapshot& snapshot) const {
+        return snapshot.layout == layout && snapshot.values.size() == slots.size();
+    }
+
+    // Set one slot; skipped by set() if unchanged
+    static void store(const Slot& slot, uint32_t value) {
+        switch (slot.type) {
+            case SlotType::Float:
+                static_cast<ofParameter<float>*>(slot.param)->set(decodeFloat(value));
+                break;
+            case SlotType::Int:
+                static_cast<ofParameter<int>*>(slot.param)->set(static_cast<int32_t>(value));
+                break;
+            case SlotType::Bool:
+                static_cast<ofParameter<bool>*>(slot.param)->set(value != 0);
+                break;
+        }
+    }
+
+    static uint32_t blend(SlotType type, uint32_t a, uint32_t b, float t) {
+        switch (type) {
+            case SlotType::Float: {
+                const float x = decodeFloat(a);
+                return encode(x + (decodeFloat(b) - x) * t);
+            }
+            case SlotType::Int: {
+                const double x = static_cast<int32_t>(a);
+                const double y = static_cast<int32_t>(b);
+                return static_cast<uint32_t>(static_cast<int32_t>(std::lround(x + (y - x) * t)));
+            }
+            case SlotType::Bool:
+                return t < 0.5f ? a : b;
+        }
+        return a;
+    }
+};
+
+// MARK: - ofParameterPreset
+
+ofParameterPreset::ofParameterPreset()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ofParameterPreset::~ofParameterPreset() = default;
+
+void ofParameterPreset::add(ofParameter<float>& param) {
+    impl_->add(SlotType::Float, param);
+}
+
+void ofParameterPreset::add(ofParameter<int>& param) {
+    impl_->add(SlotType::Int, param);
+}
+
+void ofParameterPreset::add(ofParameter<bool>& param) {
+    impl_->add(SlotType::Bool, param);
+}
+
+void ofParameterPreset::add(ofParameterGroup& group) {
+    for (size_t i = 0; i < group.size(); ++i) {
+        std::shared_ptr<ofAbstractParameter> param = group.get(i);
+        if (auto p = std::dynamic_pointer_cast<ofParameter<float>>(param)) {
+            add(*p);
+        } else if (auto p = std::dynamic_pointer_cast<ofParameter<int>>(param)) {
+            add(*p);
+        } else if (auto p = std::dynamic_pointer_cast<ofParameter<bool>>(param)) {
+            add(*p);
+        } else if (auto p = std::dynamic_pointer_cast<ofParameterGroup>(param)) {
+            add(*p);
+        } else {
+            continue;
+        }
+        impl_->retained.push_back(param);
+    }
+}
+
+size_t ofParameterPreset::size() const {
+    return impl_->slots.size();
+}
+
+void ofParameterPreset::clear() {
+    impl_->slots.clear();
+    impl_->retained.clear();
+    impl_->layout = kLayoutSeed;
+    impl_->transitioning = false;
+}
+
+uint64_t ofParameterPreset::getLayout() const {
+    return impl_->layout;
+}
+
+ofParameterSnapshot ofParameterPreset::capture() const {
+    ofParameterSnapshot snapshot;
+    snapshot.layout = impl_->layout;
+    snapshot.values.reserve(impl_->slots.size());
+    for (const Slot& slot : impl_->slots) {
+        switch (slot.type) {
+            case SlotType::Float:
+                snapshot.values.push_back(encode(static_cast<ofParameter<float>*>(slot.param)->get()));
+                break;
+            case SlotType::Int:
+                snapshot.values.push_back(static_cast<uint32_t>(static_cast<ofParameter<int>*>(slot.param)->get()));
+                break;
+            case SlotType::Bool:
+                snapshot.values.push_back(static_cast<ofParameter<bool>*>(slot.param)->get() ? 1u : 0u);
+                break;
+        }
+    }
+    return snapshot;
+}
+
+bool ofParameterPreset::apply(const ofParameterSnapshot& snapshot) {
+    if (!impl_->matches(snapshot)) {
+        return impl_->fail("Snapshot was taken with other parameters");
+    }
+
+    ofParameterBatch batch;
+    for (size_t i = 0; i < impl_->slots.size(); ++i) {
+        Impl::store(impl_->slots[i], snapshot.values[i]);
+    }
+    return true;
+}
+
+bool ofParameterPreset::apply(const ofParameterSnapshot& from, const ofParameterSnapshot& to, float t) {
+    if (!impl_->matches(from) || !impl_->matches(to)) {
+        return impl_->fail("Snapshot was taken with other parameters");
+    }
+
+    t = std::clamp(t, 0.0f, 1.0f);
+    ofParameterBatch batch;
+    for (size_t i = 0; i < impl_->slots.size(); ++i) {
+        const Slot& slot = impl_->slots[i];
+        Impl::store(slot, Impl::blend(slot.type, from.values[i], to.values[i], t));
+    }
+    return true;
+}
+
+bool ofParameterPreset::save(const std::string& path) const {
+    return save(path, capture());
+}
+
+bool ofParameterPreset::save(const std::string& path, const ofParameterSnapshot& snapshot) const {
+    if (!impl_->matches(snapshot)) {
+        return impl_->fail("Snapshot was taken with other parameters");
+    }
+
+    PresetHeader header{};
+    std::memcpy(header.magic, kPresetMagic, sizeof(kPresetMagic));
+    header.version = kPresetVersion;
+    header.count = static_cast<uint32_t>(snapshot.values.size());
+    header.layout = snapshot.layout;
+
+    oflike::ofBuffer buffer;
+    buffer.allocate(sizeof(header) + snapshot.values.size() * sizeof(uint32_t));
+    std::memcpy(buffer.getData(), &header, sizeof(header));
+    std::memcpy(buffer.getData() + sizeof(header), snapshot.values.data(), snapshot.values.size() * sizeof(uint32_t));
+    if (!buffer.writeTo(path)) {
+        return impl_->fail("Failed to write " + path);
+    }
+    return true;
+}
+
+bool ofParameterPreset::load(const std::string& path, ofParameterSnapshot& snapshot) const {
+    const oflike::ofBuffer buffer = oflike::ofBufferMapFile(path);
+    std::string error;
+    if (!parsePreset(buffer.getData(), buffer.size(), impl_->layout, impl_->slots.size(), snapshot, error)) {
+        return impl_->fail(error + ": " + path);
+    }
+    return true;
+}
+
+void ofParameterPreset::loadAsync(const std::string& path, ofParameterSnapshotCallback done) const {
+    // Checked against the registry as it is now, which may be gone by then
+    const uint64_t layout = impl_->layout;
+    const size_t count = impl_->slots.size();
+    oflike::ofReadFileAsync(path, [layout, count, done = std::move(done)](bool ok, oflike::ofBuffer& buffer) {
+        ofParameterSnapshot snapshot;
+        std::string error;
+        ok = ok && parsePreset(buffer.getData(), buffer.size(), layout, count, snapshot, error);
+        if (done) {
+            done(ok, snapshot);
+        }
+    }, oflike::ofIOPriority::High);
+}
+
+bool ofParameterPreset::transitionTo(const ofParameterSnapshot& target, float seconds) {
+    if (!impl_->matches(target)) {
+        return impl_->fail("Snapshot was taken with other parameters");
+    }
+    if (seconds <= 0.0f) {
+        impl_->transitioning = false;
+        return apply(target);
+    }
+
+    // From wherever a running transition has got to
+    impl_->from = capture();
+    impl_->to = target;
+    impl_->start = Context::instance().getElapsedTime();
+    impl_->duration = seconds;
+    impl_->transitioning = true;
+    return true;
+}
+
+void ofParameterPreset::update() {
+    if (!impl_->transitioning) return;
+
+    const float t = static_cast<float>((Context::instance().getElapsedTime() - impl_->start) / impl_->duration);
+    if (t >= 1.0f) {
+        impl_->transitioning = false;
+        apply(impl_->to);
+        return;
+    }
+    apply(impl_->from, impl_->to, t);
+}
+
+bool ofParameterPreset::isTransitioning() const {
+    return impl_->transitioning;
+}
+
+void ofParameterPreset::stopTransition() {
+    impl_->transitioning = false;
+}
+
+bool ofParameterPreset::hasError() const {
+    return impl_->hasError;
+}
+
+std::string ofParameterPreset::getLastError() const {
+    return impl_->lastError;
+}
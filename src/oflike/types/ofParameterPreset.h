@@ -0,0 +1,125 @@
+#pragma once
+
+// ofParameterPreset - Binary parameter snapshots for fast preset switching
+// A registry of parameters whose values are captured as one flat array, in
+// registry order. Snapshots save to a small binary file (a header and one
+// 32-bit slot per parameter) that loads by mapping, with no parsing or name
+// lookups, and apply in one batch: every value is set before any listener
+// runs. Two snapshots can also be blended, once or over time, for smooth
+// transitions between presets.
+//
+// Usage:
+//   ofParameterPreset presets;
+//   presets.add(speed);
+//   presets.add(count);
+//   presets.save("show/a.preset");                // Current values
+//
+//   ofParameterSnapshot a;
+//   presets.load("show/a.preset", a);
+//   presets.apply(a);                             // One batch
+//
+//   presets.loadAsync("show/b.preset", [this](bool ok, ofParameterSnapshot& b) {
+//       if (ok) presets.transitionTo(b, 2.0f);    // Blended in update()
+//   });
+
+#include "ofParameter.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Values of a registry's parameters at one moment, in registry order
+/// Each slot holds a float's bits, an int, or 0/1 for a bool.
+struct ofParameterSnapshot {
+    uint64_t layout = 0;            ///< ofParameterPreset::getLayout() of the registry it came from
+    std::vector<uint32_t> values;   ///< One slot per parameter
+
+    bool isEmpty() const { return values.empty(); }
+};
+
+/// Called on the main thread with whether a load succeeded and the snapshot
+using ofParameterSnapshotCallback = std::function<void(bool ok, ofParameterSnapshot& snapshot)>;
+
+/// Registry of parameters saved, loaded and blended as snapshots
+/// Parameters are referenced, not copied, and must outlive the registry.
+/// Main thread only.
+class ofParameterPreset {
+public:
+    ofParameterPreset();
+    ~ofParameterPreset();
+
+    ofParameterPreset(const ofParameterPreset&) = delete;
+    ofParameterPreset& operator=(const ofParameterPreset&) = delete;
+
+    // Registry
+
+    /// Add a parameter; snapshots taken before no longer apply
+    void add(ofParameter<float>& param);
+    void add(ofParameter<int>& param);
+    void add(ofParameter<bool>& param);
+
+    /// Add the float, int and bool parameters of a group, recursively
+    /// The group holds copies of the parameters added to it, so these are
+    /// the ones set: read them through the group.
+    void add(ofParameterGroup& group);
+
+    size_t size() const;
+    void clear();
+
+    /// Hash of the parameters' names and types in order; files saved by a
+    /// registry with another layout are rejected
+    uint64_t getLayout() const;
+
+    // Snapshots
+
+    /// The current values
+    ofParameterSnapshot capture() const;
+
+    /// Set every parameter, notifying once each after all are set
+    /// @return false if the snapshot is of another layout
+    bool apply(const ofParameterSnapshot& snapshot);
+
+    /// Set every parameter between two snapshots: floats interpolate, ints
+    /// round, bools switch halfway; notifies like apply()
+    /// @param t 0 = from, 1 = to
+    bool apply(const ofParameterSnapshot& from, const ofParameterSnapshot& to, float t);
+
+    // Files
+
+    /// Save the current values
+    bool save(const std::string& path) const;
+
+    /// Save a snapshot
+    bool save(const std::string& path, const ofParameterSnapshot& snapshot) const;
+
+    /// Load a snapshot by mapping the file
+    /// @return false if the file is missing, truncated or of another layout
+    bool load(const std::string& path, ofParameterSnapshot& snapshot) const;
+
+    /// Load a snapshot in the background; done runs at the start of a later update()
+    void loadAsync(const std::string& path, ofParameterSnapshotCallback done) const;
+
+    // Transitions
+
+    /// Blend from the current values to target over seconds (0 = at once)
+    /// Timed by ofGetElapsedTimef(), so a manual clock gives the same blend
+    /// on every run.
+    bool transitionTo(const ofParameterSnapshot& target, float seconds);
+
+    /// Advance the transition; call once per frame
+    void update();
+
+    bool isTransitioning() const;
+
+    /// Stop where the transition is
+    void stopTransition();
+
+    // Error handling
+    bool hasError() const;
+    std::string getLastError() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+// oflike-metal FlightRecorderRing - the event ring behind ofFlightRecorder
+// Log lines and GPU allocations from any thread overwrite the oldest events;
+// a dump copies out what's still there, oldest first
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace oflike {
+
+enum class FlightEventKind : uint8_t {
+    Log,
+    Allocation
+};
+
+struct FlightEvent {
+    int64_t time = 0;           // steady_clock nanoseconds
+    FlightEventKind kind = FlightEventKind::Log;
+    uint8_t code = 0;           // Log level or GPU memory category
+    int64_t bytes = 0;          // Allocations: released if negative
+    char module[32];
+    char text[200];             // Log message or allocation label
+};
+
+// Writers on any thread claim a slot each; a slot's sequence is odd while
+// it is written, so a snapshot skips slots overwritten under it
+class FlightEventRing {
+public:
+    static constexpr size_t kSlots = 4096;     // Power of two
+
+    template <typename Fill>
+    void push(Fill&& fill) {
+        const uint64_t index = head_.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots_[index & (kSlots - 1)];
+        slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        fill(slot.event);
+        slot.sequence.store(index * 2 + 2, std::memory_order_release);
+    }
+
+    // Events still in the ring since the last clear(), oldest first
+    void snapshot(std::vector<FlightEvent>& events) const {
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        const uint64_t first = std::max(head > kSlots ? head - kSlots : 0,
+                                        start_.load(std::memory_order_relaxed));
+        events.reserve(head - std::min(first, head));
+        for (uint64_t index = first; index < head; ++index) {
+            const Slot& slot = slots_[index & (kSlots - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != index * 2 + 2) {
+                continue;
+            }
+            FlightEvent event = slot.event;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == index * 2 + 2) {
+                events.push_back(event);
+            }
+        }
+    }
+
+    void clear() {
+        start_.store(head_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        FlightEvent event;
+    };
+
+    Slot slots_[kSlots];
+    std::atomic<uint64_t> head_{0};
+    std::atomic<uint64_t> start_{0};
+};
+
+} // namespace oflike
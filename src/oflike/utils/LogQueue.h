@@ -0,0 +1,130 @@
+#pragma once
+
+// oflike-metal LogQueue - the queue and repeat filter behind ofLog's writer
+// Logging threads push preformatted records; the writer thread pops them in
+// order and collapses consecutive repeats before they reach os_log
+
+#include "ofLog.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace oflike {
+
+constexpr size_t kLogQueueSlots = 1024;     // Power of two
+constexpr size_t kLogModuleSize = 32;
+constexpr size_t kLogTextSize = 472;        // Longer messages are written synchronously
+
+// A preformatted message
+struct LogRecord {
+    ofLogLevel level = OF_LOG_NOTICE;
+    uint32_t length = 0;
+    char module[kLogModuleSize];
+    char text[kLogTextSize];
+};
+
+// Bounded lock-free queue of records (Vyukov): producers claim a slot by
+// bumping the tail, and each slot's sequence tells whether it is free or
+// filled, so neither side takes a lock
+class LogQueue {
+public:
+    LogQueue() {
+        for (size_t i = 0; i < kLogQueueSlots; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Fills a free slot through fill; false when the queue is full
+    template<typename Fill>
+    bool push(Fill&& fill) {
+        size_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[position & (kLogQueueSlots - 1)];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = (intptr_t)sequence - (intptr_t)position;
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    fill(slot.record);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Copies the oldest record out; false when the queue is empty
+    bool pop(LogRecord& out) {
+        size_t position = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[position & (kLogQueueSlots - 1)];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = (intptr_t)sequence - (intptr_t)(position + 1);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    out = slot.record;
+                    slot.sequence.store(position + kLogQueueSlots, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    Slot slots_[kLogQueueSlots];
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) std::atomic<size_t> head_{0};
+};
+
+// Consecutive identical messages are written as one plus a count.
+// emit is called as emit(level, module, text). One thread only.
+class LogRepeatFilter {
+public:
+    template<typename Emit>
+    void write(const LogRecord& record, Emit&& emit) {
+        if (hasLast_ && record.level == last_.level && record.length == last_.length &&
+            std::strcmp(record.module, last_.module) == 0 &&
+            std::memcmp(record.text, last_.text, record.length) == 0) {
+            repeats_++;
+            return;
+        }
+        writeRepeats(emit);
+        emit(record.level, record.module, record.text);
+        last_ = record;
+        hasLast_ = true;
+    }
+
+    // Writes the pending repeat count, if any
+    template<typename Emit>
+    void writeRepeats(Emit&& emit) {
+        if (repeats_ == 0) {
+            return;
+        }
+        std::string note = "(last message repeated " + std::to_string(repeats_) + " times)";
+        emit(last_.level, last_.module, note.c_str());
+        repeats_ = 0;
+    }
+
+    uint32_t getRepeats() const { return repeats_; }
+
+private:
+    LogRecord last_;
+    bool hasLast_ = false;
+    uint32_t repeats_ = 0;
+};
+
+} // namespace oflike
@@ -0,0 +1,222 @@
+#pragma once
+
+// oflike-metal ofAssetManager - manifest-driven background asset preloading
+// Loads run on worker threads a few at a time; finished assets are uploaded
+// by update() within a per-frame byte budget, and unreferenced assets are
+// evicted, least recently used first, to stay under a memory budget
+//
+// Usage:
+//   // assets.txt - one asset per line: type name path [priority]
+//   //   image  logo  images/logo.png  10
+//   //   mesh   scan  models/scan.ply
+//
+//   ofAssetManager assets;
+//   assets.loadManifest("assets.txt");
+//   assets.preload();
+//
+//   void update() {
+//       assets.update();
+//       if (auto logo = assets.getImage("logo")) { ... }
+//   }
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <typeindex>
+
+namespace oflike {
+
+class ofImage;
+class ofMesh;
+
+/// Where an asset is in its load
+enum class ofAssetState {
+    Unknown,     ///< No asset of that name
+    Unloaded,    ///< Not requested yet, or evicted
+    Queued,      ///< Waiting for a free load slot
+    Loading,     ///< Loading on a worker thread
+    Uploading,   ///< Loaded, waiting for upload budget
+    Ready,
+    Failed
+};
+
+/// Memory held by an asset
+struct ofAssetMemory {
+    size_t cpuBytes = 0;
+    size_t gpuBytes = 0;
+};
+
+/// Progress of the requested assets
+struct ofAssetProgress {
+    size_t requested = 0;   ///< Assets preloaded or asked for
+    size_t ready = 0;
+    size_t failed = 0;
+    ofAssetMemory memory;   ///< Held by ready assets
+
+    /// Fraction of the requested assets that finished, ready or failed
+    float getFraction() const {
+        return requested == 0 ? 1.0f : static_cast<float>(ready + failed) / static_cast<float>(requested);
+    }
+};
+
+/// How to load one type of asset
+/// @tparam T Asset class, returned by ofAssetManager::get<T>()
+template <typename T>
+struct ofAssetLoader {
+    /// Worker thread: read and decode the file; nullptr on failure
+    std::function<std::shared_ptr<T>(const std::string& path)> load;
+
+    /// Main thread, once loaded: create GPU resources (optional)
+    std::function<void(T& asset)> upload;
+
+    /// Memory the asset holds once uploaded (optional); its gpuBytes are
+    /// charged to the upload budget
+    std::function<ofAssetMemory(const T& asset)> memory;
+};
+
+/// Preloads the assets of a manifest and keeps them under a memory budget
+/// Built-in types are "image" (ofImage) and "mesh" (ofMesh); addons add more
+/// with registerLoader(). All methods are for the main thread.
+class ofAssetManager {
+public:
+    ofAssetManager();
+    ~ofAssetManager();
+
+    ofAssetManager(const ofAssetManager&) = delete;
+    ofAssetManager& operator=(const ofAssetManager&) = delete;
+
+    // ========================================================================
+    // Loaders
+    // ========================================================================
+
+    /// Register (or replace) the loader of a type of asset
+    /// @param type Type name used in manifests
+    /// @param loader Load, upload and memory functions
+    template <typename T>
+    void registerLoader(const std::string& type, ofAssetLoader<T> loader) {
+        ErasedLoader erased;
+        erased.type = std::type_index(typeid(T));
+        erased.load = [load = std::move(loader.load)](const std::string& path) -> std::shared_ptr<void> {
+            return load ? load(path) : nullptr;
+        };
+        if (loader.upload) {
+            erased.upload = [upload = std::move(loader.upload)](void* asset) {
+                upload(*static_cast<T*>(asset));
+            };
+        }
+        if (loader.memory) {
+            erased.memory = [memory = std::move(loader.memory)](const void* asset) {
+                return memory(*static_cast<const T*>(asset));
+            };
+        }
+        registerErasedLoader(type, std::move(erased));
+    }
+
+    // ========================================================================
+    // Manifest
+    // ========================================================================
+
+    /// Add the assets listed in a manifest file
+    /// Each line is "type name path [priority]"; blank lines and lines
+    /// starting with '#' are skipped. Relative paths are relative to the
+    /// manifest. Nothing loads until preload() or get().
+    /// @param path Manifest file path
+    /// @return false if the file can't be read or a line is malformed
+    bool loadManifest(const std::string& path);
+
+    /// Add one asset
+    /// @param type Registered type name
+    /// @param name Unique name to get it by; replaces an asset of that name
+    /// @param path File path
+    /// @param priority Higher loads first; ties load in the order added
+    /// @return false if the type has no loader
+    bool add(const std::string& type, const std::string& name, const std::string& path, int priority = 0);
+
+    /// Request every asset
+    void preload();
+
+    /// Request one asset
+    void preload(const std::string& name);
+
+    // ========================================================================
+    // Access
+    // ========================================================================
+
+    /// Get a ready asset, or nullptr while it loads
+    /// Requests the asset if it isn't loaded yet (or was evicted) and marks
+    /// it as recently used.
+    /// @tparam T The asset class its loader returns
+    template <typename T>
+    std::shared_ptr<T> get(const std::string& name) {
+        return std::static_pointer_cast<T>(getErased(name, std::type_index(typeid(T))));
+    }
+
+    std::shared_ptr<ofImage> getImage(const std::string& name) { return get<ofImage>(name); }
+    std::shared_ptr<ofMesh> getMesh(const std::string& name) { return get<ofMesh>(name); }
+
+    ofAssetState getState(const std::string& name) const;
+
+    /// True once every requested asset is ready or failed
+    bool isDone() const;
+
+    ofAssetProgress getProgress() const;
+
+    // ========================================================================
+    // Reference counts
+    // ========================================================================
+
+    /// Keep an asset loaded: retained assets and those whose shared_ptr is
+    /// still held are never evicted. Requests the asset.
+    void retain(const std::string& name);
+
+    /// Undo one retain()
+    void release(const std::string& name);
+
+    int getRefCount(const std::string& name) const;
+
+    /// Drop an asset's data now unless it is in use; it loads again on request
+    void unload(const std::string& name);
+
+    /// Remove every asset (loads in flight are discarded)
+    void clear();
+
+    // ========================================================================
+    // Budgets
+    // ========================================================================
+
+    /// Loads running at once (default: CPU cores, at most 4)
+    void setMaxConcurrentLoads(size_t count);
+
+    /// Memory kept by ready assets; 0 means unlimited (the default)
+    void setMemoryBudget(size_t cpuBytes, size_t gpuBytes);
+
+    /// GPU bytes uploaded per update(); at least one asset uploads each
+    /// frame, however large. Defaults to 32 MB.
+    void setUploadBudget(size_t bytesPerFrame);
+
+    // ========================================================================
+    // Per frame
+    // ========================================================================
+
+    /// Take finished loads, upload within the budget, evict over the memory
+    /// budget and start queued loads. Call once per frame from update().
+    void update();
+
+private:
+    struct ErasedLoader {
+        std::type_index type = std::type_index(typeid(void));
+        std::function<std::shared_ptr<void>(const std::string&)> load;
+        std::function<void(void*)> upload;
+        std::function<ofAssetMemory(const void*)> memory;
+    };
+
+    void registerErasedLoader(const std::string& type, ErasedLoader loader);
+    std::shared_ptr<void> getErased(const std::string& name, std::type_index type);
+
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
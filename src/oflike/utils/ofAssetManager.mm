@@ -0,0 +1,440 @@
+#include "ofAssetManager.h"
+#include "ofBuffer.h"
+#include "ofFilePath.h"
+#include "ofLog.h"
+#include "../image/ImageDecoder.h"
+#include "../image/ofImage.h"
+#include "../3d/ofMesh.h"
+#import <Foundation/Foundation.h>
+#include <dispatch/dispatch.h>
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace oflike {
+
+namespace {
+
+constexpr size_t kDefaultUploadBudget = 32 * 1024 * 1024;
+
+// A load finished on a worker thread, for update() to pick up
+struct LoadResult {
+    size_t entry;
+    uint64_t generation;
+    std::shared_ptr<void> asset;
+};
+
+// Shared with worker threads, which may outlive the manager
+struct LoadResults {
+    std::mutex mutex;
+    std::vector<LoadResult> results;
+};
+
+ofAssetMemory imageMemory(const ofImage& image) {
+    const ofPixels& pixels = image.getPixels();
+    ofAssetMemory memory;
+    memory.cpuBytes = pixels.getTotalBytes();
+    // Textures of color images are stored with four channels
+    const size_t channels = pixels.getNumChannels() >= 3 ? 4 : pixels.getNumChannels();
+    memory.gpuBytes = pixels.getWidth() * pixels.getHeight() * channels;
+    return memory;
+}
+
+ofAssetMemory meshMemory(const ofMesh& mesh) {
+    ofAssetMemory memory;
+    memory.cpuBytes = mesh.getVertices().size() * sizeof(ofVec3f) +
+                      mesh.getNormals().size() * sizeof(ofVec3f) +
+                      mesh.getTexCoords().size() * sizeof(ofVec2f) +
+                      mesh.getColors().size() * sizeof(ofColor) +
+                      mesh.getIndices().size() * sizeof(uint32_t);
+    return memory;
+}
+
+} // namespace
+
+// ============================================================================
+// Impl
+// ============================================================================
+
+class ofAssetManager::Impl {
+public:
+    struct Entry {
+        std::string name;
+        std::string type;
+        std::string path;
+        int priority = 0;
+        size_t order = 0;               // Position added, for ties
+        ofAssetState state = ofAssetState::Unloaded;
+        bool requested = false;
+        int refCount = 0;
+        uint64_t generation = 0;        // Bumped to discard a load in flight
+        uint64_t lastUsed = 0;          // Frame of the last get()
+        std::shared_ptr<void> asset;
+        ofAssetMemory memory;
+    };
+
+    std::unordered_map<std::string, ErasedLoader> loaders;
+    std::vector<Entry> entries;         // Only shrinks in clear(), so indices stay valid
+    std::unordered_map<std::string, size_t> byName;
+    std::vector<size_t> queue;          // Queued entries, highest priority last
+    std::vector<size_t> uploads;        // Loaded entries, in arrival order
+    std::shared_ptr<LoadResults> results = std::make_shared<LoadResults>();
+
+    size_t maxLoads = 4;
+    size_t loadsInFlight = 0;
+    size_t cpuBudget = 0;
+    size_t gpuBudget = 0;
+    size_t uploadBudget = kDefaultUploadBudget;
+    ofAssetMemory used;
+    uint64_t frame = 0;
+
+    Entry* find(const std::string& name) {
+        auto it = byName.find(name);
+        return it == byName.end() ? nullptr : &entries[it->second];
+    }
+
+    const Entry* find(const std::string& name) const {
+        auto it = byName.find(name);
+        return it == byName.end() ? nullptr : &entries[it->second];
+    }
+
+    void request(size_t index) {
+        Entry& entry = entries[index];
+        entry.requested = true;
+        if (entry.state != ofAssetState::Unloaded) return;
+
+        entry.state = ofAssetState::Queued;
+        queue.push_back(index);
+        std::stable_sort(queue.begin(), queue.end(), [this](size_t a, size_t b) {
+            const Entry& ea = entries[a];
+            const Entry& eb = entries[b];
+            if (ea.priority != eb.priority) return ea.priority < eb.priority;
+            return ea.order > eb.order;
+        });
+    }
+
+    // Drop an entry's data and discard any load in flight
+    void drop(Entry& entry) {
+        if (entry.state == ofAssetState::Ready) {
+            used.cpuBytes -= entry.memory.cpuBytes;
+            used.gpuBytes -= entry.memory.gpuBytes;
+        }
+        entry.asset.reset();
+        entry.memory = ofAssetMemory();
+        entry.generation++;
+        entry.state = ofAssetState::Unloaded;
+    }
+
+    bool inUse(const Entry& entry) const {
+        return entry.refCount > 0 || entry.asset.use_count() > 1;
+    }
+
+    bool overBudget() const {
+        return (cpuBudget > 0 && used.cpuBytes > cpuBudget) ||
+               (gpuBudget > 0 && used.gpuBytes > gpuBudget);
+    }
+
+    // Evict ready, unused entries, least recently used first, until under
+    // budget; false if the budget can't be met
+    bool evict() {
+        while (overBudget()) {
+            Entry* oldest = nullptr;
+            for (Entry& entry : entries) {
+                if (entry.state != ofAssetState::Ready || inUse(entry)) continue;
+                if (!oldest || entry.lastUsed < oldest->lastUsed) {
+                    oldest = &entry;
+                }
+            }
+            if (!oldest) return false;
+            ofLogVerbose("ofAssetManager") << "Evicting " << oldest->name;
+            drop(*oldest);
+        }
+        return true;
+    }
+
+    void collectResults() {
+        std::vector<LoadResult> finished;
+        {
+            std::lock_guard<std::mutex> lock(results->mutex);
+            finished.swap(results->results);
+        }
+        for (LoadResult& result : finished) {
+            loadsInFlight--;
+            Entry& entry = entries[result.entry];
+            if (result.generation != entry.generation) continue;  // Unloaded meanwhile
+
+            if (!result.asset) {
+                ofLogError("ofAssetManager") << "Failed to load " << entry.name << ": " << entry.path;
+                entry.state = ofAssetState::Failed;
+                continue;
+            }
+            entry.asset = std::move(result.asset);
+            entry.state = ofAssetState::Uploading;
+            uploads.push_back(result.entry);
+        }
+    }
+
+    void uploadWithinBudget() {
+        size_t spent = 0;
+        size_t done = 0;
+        for (; done < uploads.size(); ++done) {
+            Entry& entry = entries[uploads[done]];
+            if (entry.state != ofAssetState::Uploading) continue;  // Unloaded meanwhile
+
+            const ErasedLoader& loader = loaders[entry.type];
+            const ofAssetMemory memory = loader.memory ? loader.memory(entry.asset.get()) : ofAssetMemory();
+            if (spent > 0 && spent + memory.gpuBytes > uploadBudget) break;
+
+            if (loader.upload) {
+                loader.upload(entry.asset.get());
+            }
+            spent += memory.gpuBytes;
+            entry.memory = memory;
+            used.cpuBytes += memory.cpuBytes;
+            used.gpuBytes += memory.gpuBytes;
+            entry.lastUsed = frame;
+            entry.state = ofAssetState::Ready;
+        }
+        uploads.erase(uploads.begin(), uploads.begin() + done);
+    }
+
+    void startLoads() {
+        while (loadsInFlight < maxLoads && !queue.empty()) {
+            // Wait for memory rather than load what would be evicted
+            if (overBudget()) return;
+
+            const size_t index = queue.back();
+            queue.pop_back();
+            Entry& entry = entries[index];
+            if (entry.state != ofAssetState::Queued) continue;
+
+            entry.state = ofAssetState::Loading;
+            loadsInFlight++;
+
+            std::function<std::shared_ptr<void>(const std::string&)> load = loaders[entry.type].load;
+            std::shared_ptr<LoadResults> shared = results;
+            const std::string path = entry.path;
+            const uint64_t generation = entry.generation;
+            dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+                std::shared_ptr<void> asset;
+                @autoreleasepool {
+                    asset = load(path);
+                }
+                std::lock_guard<std::mutex> lock(shared->mutex);
+                shared->results.push_back(LoadResult{index, generation, std::move(asset)});
+            });
+        }
+    }
+};
+
+// ============================================================================
+// ofAssetManager
+// ============================================================================
+
+ofAssetManager::ofAssetManager()
+    : impl_(std::make_unique<Impl>()) {
+    const size_t cores = std::max<NSUInteger>(1, [[NSProcessInfo processInfo] activeProcessorCount]);
+    impl_->maxLoads = std::min<size_t>(cores, 4);
+
+    // Images decode through the shared decode cache; the texture is
+    // uploaded by update()
+    ofAssetLoader<ofImage> images;
+    images.load = [](const std::string& path) -> std::shared_ptr<ofImage> {
+        std::shared_ptr<const ofPixels> decoded = decodeImageFile(path);
+        if (!decoded) return nullptr;
+        auto image = std::make_shared<ofImage>();
+        image->getPixels() = *decoded;
+        return image;
+    };
+    images.upload = [](ofImage& image) { image.update(); };
+    images.memory = imageMemory;
+    registerLoader("image", std::move(images));
+
+    ofAssetLoader<ofMesh> meshes;
+    meshes.load = [](const std::string& path) -> std::shared_ptr<ofMesh> {
+        auto mesh = std::make_shared<ofMesh>();
+        return mesh->load(path) ? mesh : nullptr;
+    };
+    meshes.memory = meshMemory;
+    registerLoader("mesh", std::move(meshes));
+}
+
+// Loads in flight finish into the shared results and are dropped with them
+ofAssetManager::~ofAssetManager() = default;
+
+void ofAssetManager::registerErasedLoader(const std::string& type, ErasedLoader loader) {
+    impl_->loaders[type] = std::move(loader);
+}
+
+bool ofAssetManager::loadManifest(const std::string& path) {
+    const ofBuffer manifest = ofBufferFromFile(path);
+    if (!manifest.isAllocated()) {
+        ofLogError("ofAssetManager") << "Failed to read manifest: " << path;
+        return false;
+    }
+
+    const std::string directory = ofFilePath::getEnclosingDirectory(path);
+    bool ok = true;
+    size_t lineNumber = 0;
+    for (std::string_view line : manifest.getLines()) {
+        lineNumber++;
+        std::istringstream fields{std::string(line)};
+        std::string type, name, file;
+        if (!(fields >> type) || type[0] == '#') continue;
+
+        int priority = 0;
+        if (!(fields >> name >> file)) {
+            ofLogError("ofAssetManager") << path << ":" << lineNumber << ": expected type, name and path";
+            ok = false;
+            continue;
+        }
+        fields >> priority;
+
+        if (!ofFilePath::isAbsolute(file)) {
+            file = ofFilePath::join(directory, file);
+        }
+        ok = add(type, name, file, priority) && ok;
+    }
+    return ok;
+}
+
+bool ofAssetManager::add(const std::string& type, const std::string& name, const std::string& path, int priority) {
+    if (impl_->loaders.find(type) == impl_->loaders.end()) {
+        ofLogError("ofAssetManager") << "No loader for asset type '" << type << "' (" << name << ")";
+        return false;
+    }
+
+    Impl::Entry* entry = impl_->find(name);
+    if (entry) {
+        impl_->drop(*entry);
+        entry->requested = false;
+    } else {
+        impl_->byName[name] = impl_->entries.size();
+        impl_->entries.emplace_back();
+        entry = &impl_->entries.back();
+        entry->name = name;
+        entry->order = impl_->entries.size() - 1;
+    }
+    entry->type = type;
+    entry->path = path;
+    entry->priority = priority;
+    return true;
+}
+
+void ofAssetManager::preload() {
+    for (size_t i = 0; i < impl_->entries.size(); ++i) {
+        impl_->request(i);
+    }
+}
+
+void ofAssetManager::preload(const std::string& name) {
+    auto it = impl_->byName.find(name);
+    if (it != impl_->byName.end()) {
+        impl_->request(it->second);
+    }
+}
+
+std::shared_ptr<void> ofAssetManager::getErased(const std::string& name, std::type_index type) {
+    auto it = impl_->byName.find(name);
+    if (it == impl_->byName.end()) {
+        return nullptr;
+    }
+    Impl::Entry& entry = impl_->entries[it->second];
+    if (impl_->loaders[entry.type].type != type) {
+        ofLogError("ofAssetManager") << "Asset " << name << " is not of the requested type";
+        return nullptr;
+    }
+    if (entry.state != ofAssetState::Ready) {
+        impl_->request(it->second);
+        return nullptr;
+    }
+    entry.lastUsed = impl_->frame;
+    return entry.asset;
+}
+
+ofAssetState ofAssetManager::getState(const std::string& name) const {
+    const Impl::Entry* entry = impl_->find(name);
+    return entry ? entry->state : ofAssetState::Unknown;
+}
+
+bool ofAssetManager::isDone() const {
+    const ofAssetProgress progress = getProgress();
+    return progress.ready + progress.failed == progress.requested;
+}
+
+ofAssetProgress ofAssetManager::getProgress() const {
+    ofAssetProgress progress;
+    for (const Impl::Entry& entry : impl_->entries) {
+        if (!entry.requested) continue;
+        progress.requested++;
+        if (entry.state == ofAssetState::Ready) progress.ready++;
+        if (entry.state == ofAssetState::Failed) progress.failed++;
+    }
+    progress.memory = impl_->used;
+    return progress;
+}
+
+void ofAssetManager::retain(const std::string& name) {
+    auto it = impl_->byName.find(name);
+    if (it == impl_->byName.end()) return;
+    impl_->entries[it->second].refCount++;
+    impl_->request(it->second);
+}
+
+void ofAssetManager::release(const std::string& name) {
+    Impl::Entry* entry = impl_->find(name);
+    if (entry && entry->refCount > 0) {
+        entry->refCount--;
+    }
+}
+
+int ofAssetManager::getRefCount(const std::string& name) const {
+    const Impl::Entry* entry = impl_->find(name);
+    return entry ? entry->refCount : 0;
+}
+
+void ofAssetManager::unload(const std::string& name) {
+    Impl::Entry* entry = impl_->find(name);
+    if (!entry || impl_->inUse(*entry)) return;
+    impl_->drop(*entry);
+    entry->requested = false;
+}
+
+void ofAssetManager::clear() {
+    // Loads in flight report to the old results, which nobody reads
+    for (Impl::Entry& entry : impl_->entries) {
+        impl_->drop(entry);
+    }
+    impl_->entries.clear();
+    impl_->byName.clear();
+    impl_->queue.clear();
+    impl_->uploads.clear();
+    impl_->used = ofAssetMemory();
+    impl_->results = std::make_shared<LoadResults>();
+    impl_->loadsInFlight = 0;
+}
+
+void ofAssetManager::setMaxConcurrentLoads(size_t count) {
+    impl_->maxLoads = std::max<size_t>(count, 1);
+}
+
+void ofAssetManager::setMemoryBudget(size_t cpuBytes, size_t gpuBytes) {
+    impl_->cpuBudget = cpuBytes;
+    impl_->gpuBudget = gpuBytes;
+}
+
+void ofAssetManager::setUploadBudget(size_t bytesPerFrame) {
+    impl_->uploadBudget = bytesPerFrame;
+}
+
+void ofAssetManager::update() {
+    impl_->frame++;
+    impl_->collectResults();
+    impl_->uploadWithinBudget();
+    impl_->evict();
+    impl_->startLoads();
+}
+
+} // namespace oflike
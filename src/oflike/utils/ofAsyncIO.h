@@ -0,0 +1,83 @@
+#pragma once
+
+// oflike-metal ofAsyncIO - file reads and writes off the main thread
+// Reads, writes and image encodes run on dispatch_io channels; their callbacks
+// are queued and run on the main thread at the start of the next update()
+//
+// Usage:
+//   ofReadFileAsync("scene.json", [this](bool ok, ofBuffer& buffer) {
+//       if (ok) parseScene(buffer.getView());
+//   });
+//
+//   ofBufferToFileAsync("preset.json", ofBuffer(json));
+//
+//   ofPixels screen;
+//   grabScreen(screen);
+//   ofSaveImageAsync(screen, "frame.png", [](bool ok) { ... });
+
+#include "ofBuffer.h"
+#include "../image/ofPixels.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace oflike {
+
+/// Priority of an asynchronous operation, as the QoS class it runs at
+enum class ofIOPriority {
+    Low,      ///< Utility: saves and caches nobody waits for
+    Normal,   ///< Default
+    High      ///< User initiated: assets needed on screen soon
+};
+
+/// Called on the main thread with whether a read succeeded and the file's
+/// contents; the buffer may be moved from
+using ofAsyncReadCallback = std::function<void(bool ok, ofBuffer& buffer)>;
+
+/// Called on the main thread with whether a write succeeded
+using ofAsyncWriteCallback = std::function<void(bool ok)>;
+
+/// Read a whole file in the background
+/// @param path File path
+/// @param done Callback run at the start of a later update()
+/// @param priority Scheduling priority
+void ofReadFileAsync(const std::string& path, ofAsyncReadCallback done,
+                     ofIOPriority priority = ofIOPriority::Normal);
+
+/// Write a buffer to a file in the background
+/// The data goes to a temporary file next to the target, which is renamed
+/// over it once complete, so the target never holds a partial write.
+/// @param path File path
+/// @param buffer Data to write; moved in, so pass std::move() to avoid a copy
+/// @param done Callback run at the start of a later update(), or nullptr
+/// @param priority Scheduling priority
+void ofBufferToFileAsync(const std::string& path, ofBuffer buffer,
+                         ofAsyncWriteCallback done = nullptr,
+                         ofIOPriority priority = ofIOPriority::Normal);
+
+/// Encode and save pixels to an image file in the background
+/// The pixels are copied before returning; encoding (as ofSaveImage(), by
+/// extension) and writing happen off the main thread.
+/// @param pixels Source pixels
+/// @param path Path to save image file (extension determines format)
+/// @param done Callback run at the start of a later update(), or nullptr
+/// @param quality JPEG quality 0.0-1.0, ignored for PNG/TIFF
+/// @param priority Scheduling priority
+/// @return false if the pixels are not allocated (nothing is queued)
+bool ofSaveImageAsync(const ofPixels& pixels, const std::string& path,
+                      ofAsyncWriteCallback done = nullptr, float quality = 0.9f,
+                      ofIOPriority priority = ofIOPriority::Low);
+
+/// Number of operations whose callbacks have not run yet
+size_t ofGetAsyncIOPending();
+
+/// Run the callbacks of finished operations
+/// Called by the app loop before update(); callbacks queued while these run
+/// wait for the next call.
+void ofDispatchAsyncIOCompletions();
+
+/// Block until every operation has finished, then run their callbacks
+/// Called by the app loop after exit(), so saves made there reach the disk.
+void ofWaitForAsyncIO();
+
+} // namespace oflike
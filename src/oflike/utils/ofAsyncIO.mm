@@ -0,0 +1,217 @@
+#include "ofAsyncIO.h"
+#include "ofUtils.h"
+#include "ofLog.h"
+#import <Foundation/Foundation.h>
+#include <dispatch/dispatch.h>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace oflike {
+
+namespace {
+
+// Finished operations waiting for the main thread. Leaked so that I/O still
+// in flight during static destruction has somewhere to post.
+struct AsyncIOState {
+    std::mutex mutex;
+    std::vector<std::function<void()>> completions;
+    std::atomic<size_t> pending{0};         // Callbacks not run yet
+    std::atomic<uint64_t> nextTemp{0};      // Suffix of temporary write files
+    dispatch_group_t group = dispatch_group_create();  // Operations still doing I/O
+};
+
+AsyncIOState& state() {
+    static AsyncIOState* instance = new AsyncIOState();
+    return *instance;
+}
+
+dispatch_queue_t queueFor(ofIOPriority priority) {
+    switch (priority) {
+        case ofIOPriority::Low:  return dispatch_get_global_queue(QOS_CLASS_UTILITY, 0);
+        case ofIOPriority::High: return dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+        default:                 return dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0);
+    }
+}
+
+// An operation is begun on the calling thread and finished on the I/O queue
+// once its callback is queued for the main thread
+void beginOperation() {
+    state().pending.fetch_add(1, std::memory_order_relaxed);
+    dispatch_group_enter(state().group);
+}
+
+void finishOperation(std::function<void()> completion) {
+    AsyncIOState& io = state();
+    {
+        std::lock_guard<std::mutex> lock(io.mutex);
+        io.completions.push_back(std::move(completion));
+    }
+    dispatch_group_leave(io.group);
+}
+
+void finishWrite(const ofAsyncWriteCallback& done, bool ok) {
+    finishOperation([done, ok]() {
+        if (done) done(ok);
+    });
+}
+
+// Write data to a temporary file beside path, then rename it into place
+void writeData(const std::string& path, dispatch_data_t data, ofAsyncWriteCallback done, dispatch_queue_t queue) {
+    const std::string temp = path + ".part" + std::to_string(state().nextTemp.fetch_add(1, std::memory_order_relaxed));
+    const int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        ofLogError("ofAsyncIO") << "Failed to open " << temp << ": " << std::strerror(errno);
+        finishWrite(done, false);
+        return;
+    }
+
+    dispatch_io_t channel = dispatch_io_create(DISPATCH_IO_STREAM, fd, queue, ^(int) {
+        ::close(fd);
+    });
+    dispatch_io_write(channel, 0, data, queue, ^(bool finished, dispatch_data_t, int error) {
+        if (!finished) return;
+        dispatch_io_close(channel, 0);
+
+        bool ok = error == 0;
+        if (!ok) {
+            ofLogError("ofAsyncIO") << "Failed to write " << path << ": " << std::strerror(error);
+            std::remove(temp.c_str());
+        } else if (std::rename(temp.c_str(), path.c_str()) != 0) {
+            ofLogError("ofAsyncIO") << "Failed to replace " << path << ": " << std::strerror(errno);
+            std::remove(temp.c_str());
+            ok = false;
+        }
+        finishWrite(done, ok);
+    });
+}
+
+} // namespace
+
+// ============================================================================
+// Reads and writes
+// ============================================================================
+
+void ofReadFileAsync(const std::string& path, ofAsyncReadCallback done, ofIOPriority priority) {
+    beginOperation();
+    dispatch_queue_t queue = queueFor(priority);
+
+    auto fail = [done]() {
+        finishOperation([done]() {
+            ofBuffer empty;
+            if (done) done(false, empty);
+        });
+    };
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        ofLogError("ofAsyncIO") << "Failed to open " << path << ": " << std::strerror(errno);
+        fail();
+        return;
+    }
+
+    dispatch_io_t channel = dispatch_io_create(DISPATCH_IO_STREAM, fd, queue, ^(int) {
+        ::close(fd);
+    });
+    __block dispatch_data_t contents = dispatch_data_empty;
+    dispatch_io_read(channel, 0, SIZE_MAX, queue, ^(bool finished, dispatch_data_t data, int error) {
+        if (data) {
+            contents = dispatch_data_create_concat(contents, data);
+        }
+        if (!finished) return;
+        dispatch_io_close(channel, 0);
+
+        if (error != 0) {
+            ofLogError("ofAsyncIO") << "Failed to read " << path << ": " << std::strerror(error);
+            fail();
+            return;
+        }
+
+        // One copy out of the chunks the channel read
+        auto buffer = std::make_shared<ofBuffer>();
+        buffer->allocate(dispatch_data_get_size(contents));
+        char* out = buffer->getData();
+        dispatch_data_apply(contents, ^bool(dispatch_data_t, size_t offset, const void* bytes, size_t size) {
+            std::memcpy(out + offset, bytes, size);
+            return true;
+        });
+        contents = nil;
+
+        finishOperation([done, buffer]() {
+            if (done) done(true, *buffer);
+        });
+    });
+}
+
+void ofBufferToFileAsync(const std::string& path, ofBuffer buffer, ofAsyncWriteCallback done, ofIOPriority priority) {
+    beginOperation();
+
+    // The dispatch data reads the buffer in place and releases it when written
+    auto owned = std::make_shared<ofBuffer>(std::move(buffer));
+    dispatch_queue_t queue = queueFor(priority);
+    dispatch_data_t data = dispatch_data_create(owned->getData(), owned->size(), queue, ^{
+        (void)owned;
+    });
+    writeData(path, data, std::move(done), queue);
+}
+
+bool ofSaveImageAsync(const ofPixels& pixels, const std::string& path, ofAsyncWriteCallback done, float quality, ofIOPriority priority) {
+    if (!pixels.isAllocated()) {
+        ofLogError("ofSaveImageAsync") << "Pixels not allocated";
+        return false;
+    }
+    beginOperation();
+
+    auto source = std::make_shared<ofPixels>(pixels);
+    dispatch_queue_t queue = queueFor(priority);
+    dispatch_async(queue, ^{
+        auto encoded = std::make_shared<std::vector<uint8_t>>();
+        if (!ofEncodeImage(*source, *encoded, path, quality)) {
+            finishWrite(done, false);
+            return;
+        }
+        dispatch_data_t data = dispatch_data_create(encoded->data(), encoded->size(), queue, ^{
+            (void)encoded;
+        });
+        writeData(path, data, done, queue);
+    });
+    return true;
+}
+
+// ============================================================================
+// Completions
+// ============================================================================
+
+size_t ofGetAsyncIOPending() {
+    return state().pending.load(std::memory_order_relaxed);
+}
+
+void ofDispatchAsyncIOCompletions() {
+    AsyncIOState& io = state();
+    std::vector<std::function<void()>> ready;
+    {
+        std::lock_guard<std::mutex> lock(io.mutex);
+        if (io.completions.empty()) return;
+        ready.swap(io.completions);
+    }
+    for (auto& completion : ready) {
+        completion();
+    }
+    io.pending.fetch_sub(ready.size(), std::memory_order_relaxed);
+}
+
+void ofWaitForAsyncIO() {
+    // Callbacks may start more operations, so wait until none are left
+    while (ofGetAsyncIOPending() > 0) {
+        dispatch_group_wait(state().group, DISPATCH_TIME_FOREVER);
+        ofDispatchAsyncIOCompletions();
+    }
+}
+
+} // namespace oflike
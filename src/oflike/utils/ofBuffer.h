@@ -10,17 +10,90 @@
 //
 //   ofBuffer loaded = ofBufferFromFile("input.txt");
 //   std::string text = loaded.getText();
+//
+//   // Large files: read-only pages of the file, no copy
+//   ofBuffer mapped = ofBufferMapFile("points.ply");
+//   for (std::string_view line : mapped.getLines()) { ... }
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
 #include <memory>
 
 namespace oflike {
 
 /// Binary buffer class for file I/O (openFrameworks compatible)
+/// A buffer from ofBufferMapFile() reads the file's pages in place; the
+/// first write through a mutable accessor copies it into owned memory.
 class ofBuffer {
 public:
+    /// Lines of a buffer as views into it, split at '\n' with a trailing
+    /// '\r' removed; nothing is allocated while iterating. Converts to a
+    /// vector of strings for code that keeps the lines.
+    class Lines {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string_view*;
+            using reference = const std::string_view&;
+
+            iterator() = default;
+            iterator(const char* begin, const char* end) : next_(begin), end_(end) { advance(); }
+
+            reference operator*() const { return line_; }
+            pointer operator->() const { return &line_; }
+            iterator& operator++() { advance(); return *this; }
+            iterator operator++(int) { iterator copy = *this; advance(); return copy; }
+            bool operator==(const iterator& other) const { return start_ == other.start_; }
+            bool operator!=(const iterator& other) const { return start_ != other.start_; }
+
+        private:
+            void advance() {
+                if (next_ == end_) {
+                    start_ = nullptr;   // Past the last line
+                    line_ = std::string_view();
+                    return;
+                }
+                start_ = next_;
+                const char* newline = static_cast<const char*>(std::memchr(next_, '\n', end_ - next_));
+                const char* stop = newline ? newline : end_;
+                next_ = newline ? newline + 1 : end_;
+                if (stop > start_ && stop[-1] == '\r') {
+                    stop--;
+                }
+                line_ = std::string_view(start_, static_cast<std::size_t>(stop - start_));
+            }
+
+            const char* next_ = nullptr;
+            const char* end_ = nullptr;
+            const char* start_ = nullptr;
+            std::string_view line_;
+        };
+
+        Lines(const char* begin, const char* end) : begin_(begin), end_(end) {}
+
+        iterator begin() const { return iterator(begin_, end_); }
+        iterator end() const { return iterator(); }
+
+        operator std::vector<std::string>() const {
+            std::vector<std::string> lines;
+            for (std::string_view line : *this) {
+                lines.emplace_back(line);
+            }
+            return lines;
+        }
+
+    private:
+        const char* begin_;
+        const char* end_;
+    };
+
     ofBuffer();
     ofBuffer(const char* data, std::size_t size);
     ofBuffer(const std::string& text);
@@ -64,9 +137,20 @@ public:
     const char* getData() const;
 
     /// Get buffer data pointer (mutable)
+    /// Copies a mapped buffer into owned memory first
     /// @return Pointer to data
     char* getData();
 
+    /// Get the buffer as a view of its bytes, without copying
+    /// @return View valid while the buffer lives and isn't modified
+    std::string_view getView() const;
+
+    /// First byte, for range-for and algorithms over a view of the data
+    const char* begin() const;
+
+    /// One past the last byte
+    const char* end() const;
+
     /// Get buffer size
     /// @return Size in bytes
     std::size_t size() const;
@@ -76,8 +160,9 @@ public:
     std::string getText() const;
 
     /// Get buffer as lines
-    /// @return Vector of lines
-    std::vector<std::string> getLines() const;
+    /// @return Views of each line, valid while the buffer lives and isn't
+    ///         modified (assign to std::vector<std::string> to keep them)
+    Lines getLines() const;
 
     /// Write buffer to file
     /// @param path File path
@@ -88,7 +173,13 @@ public:
     /// @return True if buffer has data
     bool isAllocated() const;
 
+    /// Check if buffer reads a file mapping in place
+    /// @return True while the data is the file's read-only pages
+    bool isMapped() const;
+
 private:
+    friend ofBuffer ofBufferMapFile(const std::string& path, bool sequential);
+
     struct Impl;
     std::unique_ptr<Impl> impl_;
 };
@@ -98,4 +189,14 @@ private:
 /// @return Buffer containing file data
 ofBuffer ofBufferFromFile(const std::string& path);
 
+/// Map a file into a buffer instead of reading it
+/// The buffer reads the file's pages as they are touched, so large assets
+/// are parsed without being copied first. Falls back to
+/// ofBufferFromFile() for files that can't be mapped.
+/// @param path File path
+/// @param sequential Hint that the data is read front to back (readahead);
+///                   false for random access such as offset tables
+/// @return Buffer viewing the file data
+ofBuffer ofBufferMapFile(const std::string& path, bool sequential = true);
+
 } // namespace oflike
@@ -2,13 +2,20 @@
 #import <Foundation/Foundation.h>
 #include <cstring>
 #include <algorithm>
-#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace oflike {
 
 struct ofBuffer::Impl {
     std::vector<char> data;
 
+    // Read-only file mapping (ofBufferMapFile); data stays empty meanwhile
+    const char* mapped = nullptr;
+    std::size_t mappedSize = 0;
+
     Impl() = default;
 
     Impl(const char* ptr, std::size_t size) {
@@ -20,6 +27,39 @@ struct ofBuffer::Impl {
     Impl(const std::string& text) {
         data.assign(text.begin(), text.end());
     }
+
+    // Copies own their data; the mapping stays with the original
+    Impl(const Impl& other)
+        : data(other.mapped ? std::vector<char>(other.mapped, other.mapped + other.mappedSize) : other.data) {}
+
+    ~Impl() {
+        unmap();
+    }
+
+    const char* bytes() const {
+        if (mapped) return mapped;
+        return data.empty() ? nullptr : data.data();
+    }
+
+    std::size_t size() const {
+        return mapped ? mappedSize : data.size();
+    }
+
+    void unmap() {
+        if (mapped) {
+            ::munmap(const_cast<char*>(mapped), mappedSize);
+            mapped = nullptr;
+            mappedSize = 0;
+        }
+    }
+
+    // Before a write: the pages are read-only, so take a private copy
+    void detach() {
+        if (mapped) {
+            data.assign(mapped, mapped + mappedSize);
+            unmap();
+        }
+    }
 };
 
 ofBuffer::ofBuffer() : impl_(std::make_unique<Impl>()) {}
@@ -46,6 +86,7 @@ ofBuffer& ofBuffer::operator=(const ofBuffer& other) {
 }
 
 void ofBuffer::set(const char* data, std::size_t size) {
+    impl_->unmap();
     impl_->data.clear();
     if (data && size > 0) {
         impl_->data.assign(data, data + size);
@@ -53,68 +94,70 @@ void ofBuffer::set(const char* data, std::size_t size) {
 }
 
 void ofBuffer::set(const std::string& text) {
+    impl_->unmap();
     impl_->data.clear();
     impl_->data.assign(text.begin(), text.end());
 }
 
 void ofBuffer::append(const char* data, std::size_t size) {
     if (data && size > 0) {
+        impl_->detach();
         impl_->data.insert(impl_->data.end(), data, data + size);
     }
 }
 
 void ofBuffer::append(const std::string& text) {
+    impl_->detach();
     impl_->data.insert(impl_->data.end(), text.begin(), text.end());
 }
 
 void ofBuffer::clear() {
+    impl_->unmap();
     impl_->data.clear();
 }
 
 void ofBuffer::allocate(std::size_t size) {
+    impl_->detach();
     impl_->data.resize(size);
 }
 
 const char* ofBuffer::getData() const {
-    return impl_->data.empty() ? nullptr : impl_->data.data();
+    return impl_->bytes();
 }
 
 char* ofBuffer::getData() {
+    impl_->detach();
     return impl_->data.empty() ? nullptr : impl_->data.data();
 }
 
-std::size_t ofBuffer::size() const {
-    return impl_->data.size();
+std::string_view ofBuffer::getView() const {
+    return std::string_view(impl_->bytes(), impl_->size());
 }
 
-std::string ofBuffer::getText() const {
-    if (impl_->data.empty()) return "";
-    return std::string(impl_->data.begin(), impl_->data.end());
+const char* ofBuffer::begin() const {
+    return impl_->bytes();
 }
 
-std::vector<std::string> ofBuffer::getLines() const {
-    std::vector<std::string> lines;
-    if (impl_->data.empty()) return lines;
+const char* ofBuffer::end() const {
+    return impl_->bytes() + impl_->size();
+}
 
-    std::string text = getText();
-    std::istringstream stream(text);
-    std::string line;
+std::size_t ofBuffer::size() const {
+    return impl_->size();
+}
 
-    while (std::getline(stream, line)) {
-        // Remove trailing \r if present (Windows line endings)
-        if (!line.empty() && line.back() == '\r') {
-            line.pop_back();
-        }
-        lines.push_back(line);
-    }
+std::string ofBuffer::getText() const {
+    return std::string(getView());
+}
 
-    return lines;
+ofBuffer::Lines ofBuffer::getLines() const {
+    return Lines(begin(), end());
 }
 
 bool ofBuffer::writeTo(const std::string& path) const {
     @autoreleasepool {
         NSString* nsPath = [NSString stringWithUTF8String:path.c_str()];
-        NSData* nsData = [NSData dataWithBytes:getData() length:size()];
+        NSData* nsData = [NSData dataWithBytes:impl_->bytes() length:size()];
 
         NSError* error = nil;
         BOOL success = [nsData writeToFile:nsPath options:NSDataWritingAtomic error:&error];
@@ -129,7 +172,11 @@ bool ofBuffer::writeTo(const std::string& path) const {
 }
 
 bool ofBuffer::isAllocated() const {
-    return !impl_->data.empty();
+    return impl_->size() > 0;
+}
+
+bool ofBuffer::isMapped() const {
+    return impl_->mapped != nullptr;
 }
 
 ofBuffer ofBufferFromFile(const std::string& path) {
@@ -150,4 +197,30 @@ ofBuffer ofBufferFromFile(const std::string& path) {
     }
 }
 
+ofBuffer ofBufferMapFile(const std::string& path, bool sequential) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        NSLog(@"ofBufferMapFile failed: cannot open %s", path.c_str());
+        return ofBuffer();
+    }
+
+    struct stat info;
+    void* pages = MAP_FAILED;
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        pages = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (pages == MAP_FAILED) {
+        // Empty files, pipes and the like are read normally
+        return ofBufferFromFile(path);
+    }
+
+    ::madvise(pages, static_cast<size_t>(info.st_size), sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+
+    ofBuffer buffer;
+    buffer.impl_->mapped = static_cast<const char*>(pages);
+    buffer.impl_->mappedSize = static_cast<std::size_t>(info.st_size);
+    return buffer;
+}
+
 } // namespace oflike
@@ -0,0 +1,49 @@
+#include "ofDebugStats.h"
+#include <mutex>
+#include <utility>
+
+namespace oflike {
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::pair<int, ofDebugStats::Source>> sources;
+    int nextId = 1;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+} // namespace
+
+int ofDebugStats::addSource(Source source) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    const int id = r.nextId++;
+    r.sources.emplace_back(id, std::move(source));
+    return id;
+}
+
+void ofDebugStats::removeSource(int id) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto it = r.sources.begin(); it != r.sources.end(); ++it) {
+        if (it->first == id) {
+            r.sources.erase(it);
+            return;
+        }
+    }
+}
+
+void ofDebugStats::collect(std::vector<ofDebugStat>& stats) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto& [id, source] : r.sources) {
+        source(stats);
+    }
+}
+
+} // namespace oflike
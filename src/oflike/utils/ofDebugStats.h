@@ -0,0 +1,40 @@
+#pragma once
+
+// oflike-metal ofDebugStats - named values shown by the debug overlay
+// Lets subsystems and addons publish counters to the performance monitor
+// without the platform layer knowing about them
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace oflike {
+
+/// \brief One row of the debug overlay
+struct ofDebugStat {
+    std::string group;   ///< Rows of a group are shown together
+    std::string name;
+    std::string value;   ///< Formatted for display
+};
+
+/// \brief Registry of the sources of the debug overlay's rows
+/// \details A source appends its current rows when the overlay refreshes
+/// (a few times a second, on the main thread). Sources are called under the
+/// registry's lock, so once removeSource() returns, its source is not called
+/// again and whatever it reads may be destroyed.
+class ofDebugStats {
+public:
+    using Source = std::function<void(std::vector<ofDebugStat>& stats)>;
+
+    /// \brief Add a source
+    /// \return Id for removeSource()
+    static int addSource(Source source);
+
+    /// \brief Remove a source; ids not registered are ignored
+    static void removeSource(int id);
+
+    /// \brief Append every source's rows, in the order sources were added
+    static void collect(std::vector<ofDebugStat>& stats);
+};
+
+} // namespace oflike
@@ -13,11 +13,17 @@
 //   }
 //
 //   dir.create();  // Create directory
+//
+//   ofDirectory frames("frames");
+//   frames.allowExt("png");
+//   frames.listDir();              // One pass: names, types, sizes, mtimes
+//   uint64_t bytes = frames.getSize(0);
 
 #include <string>
 #include <vector>
 #include <memory>
 #include <cstddef>
+#include <cstdint>
 
 namespace oflike {
 
@@ -68,6 +74,9 @@ public:
     bool remove(bool recursive = false);
 
     /// List directory contents
+    /// Entries are read in bulk with getattrlistbulk(), their type, size and
+    /// modification time included, and filtered by extension before any path
+    /// is built, so large folders list without a stat() per entry.
     /// @return True if successful
     bool listDir();
 
@@ -103,6 +112,16 @@ public:
     /// @return True if file
     bool isFile(std::size_t index) const;
 
+    /// Get size of entry at index, as listed
+    /// @param index Entry index
+    /// @return Size in bytes (0 for directories)
+    uint64_t getSize(std::size_t index) const;
+
+    /// Get modification time of entry at index, as listed
+    /// @param index Entry index
+    /// @return Seconds since 1970
+    double getModificationTime(std::size_t index) const;
+
     /// Get ofFile for entry at index
     /// @param index Entry index
     /// @return ofFile object
@@ -3,14 +3,61 @@
 #include "ofFilePath.h"
 #import <Foundation/Foundation.h>
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/attr.h>
+#include <sys/stat.h>
+#include <sys/vnode.h>
+#include <unistd.h>
 
 namespace oflike {
 
+namespace {
+
+// getattrlistbulk() output buffer; a few thousand entries per call
+constexpr size_t kBulkBufferSize = 256 * 1024;
+
+// Extension of a file name, without the dot ("" for ".hidden")
+std::string_view extensionOf(std::string_view name) {
+    const size_t dot = name.rfind('.');
+    if (dot == std::string_view::npos || dot == 0) {
+        return std::string_view();
+    }
+    return name.substr(dot + 1);
+}
+
+template<typename T>
+T readField(const char*& field) {
+    T value;
+    std::memcpy(&value, field, sizeof(T));
+    field += sizeof(T);
+    return value;
+}
+
+} // namespace
+
 struct ofDirectory::Impl {
+    // A listed entry, with the attributes read alongside its name
+    struct Entry {
+        std::string path;
+        uint64_t size = 0;
+        double modified = 0.0;
+        bool directory = false;
+    };
+
     std::string path;
-    std::vector<std::string> entries;
+    std::vector<Entry> entries;
     std::vector<std::string> allowedExtensions;
 
+    bool allows(std::string_view name) const {
+        if (allowedExtensions.empty()) return true;
+        const std::string_view ext = extensionOf(name);
+        return std::any_of(allowedExtensions.begin(), allowedExtensions.end(),
+                           [ext](const std::string& allowed) { return ext == allowed; });
+    }
+
     Impl() = default;
     explicit Impl(const std::string& p) : path(p) {}
 };
@@ -100,43 +147,91 @@ bool ofDirectory::remove(bool recursive) {
 bool ofDirectory::listDir() {
     impl_->entries.clear();
 
-    @autoreleasepool {
-        NSString* nsPath = [NSString stringWithUTF8String:impl_->path.c_str()];
-        NSError* error = nil;
+    const int fd = ::open(impl_->path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        NSLog(@"ofDirectory::listDir failed: %s: %s", impl_->path.c_str(), std::strerror(errno));
+        return false;
+    }
 
-        NSArray* contents = [[NSFileManager defaultManager]
-            contentsOfDirectoryAtPath:nsPath
-            error:&error];
+    // Name, type and modification time of every entry, size of files
+    struct attrlist request = {};
+    request.bitmapcount = ATTR_BIT_MAP_COUNT;
+    request.commonattr = ATTR_CMN_RETURNED_ATTRS | ATTR_CMN_NAME | ATTR_CMN_ERROR |
+                         ATTR_CMN_OBJTYPE | ATTR_CMN_MODTIME;
+    request.fileattr = ATTR_FILE_DATALENGTH;
 
-        if (error || !contents) {
-            NSLog(@"ofDirectory::listDir failed: %@", error.localizedDescription);
-            return false;
-        }
-
-        for (NSString* item in contents) {
-            std::string itemName = std::string([item UTF8String]);
-            std::string fullPath = ofFilePath::join(impl_->path, itemName);
+    std::string directory = impl_->path;
+    if (!directory.empty() && directory.back() != '/') {
+        directory += '/';
+    }
 
-            // Apply extension filter if set
-            if (!impl_->allowedExtensions.empty()) {
-                std::string ext = ofFilePath::getFileExt(fullPath);
-                bool allowed = false;
+    std::vector<char> buffer(kBulkBufferSize);
+    bool success = true;
+    for (;;) {
+        const int count = getattrlistbulk(fd, &request, buffer.data(), buffer.size(), 0);
+        if (count < 0) {
+            NSLog(@"ofDirectory::listDir failed: %s: %s", impl_->path.c_str(), std::strerror(errno));
+            success = false;
+            break;
+        }
+        if (count == 0) break;
+
+        // Each entry holds the returned attributes in request order
+        const char* entry = buffer.data();
+        for (int i = 0; i < count; ++i) {
+            const char* field = entry;
+            const uint32_t length = readField<uint32_t>(field);
+            const attribute_set_t returned = readField<attribute_set_t>(field);
+            entry += length;
+
+            if ((returned.commonattr & ATTR_CMN_ERROR) && readField<uint32_t>(field) != 0) {
+                continue;
+            }
+            if (!(returned.commonattr & ATTR_CMN_NAME)) continue;
+            const char* nameField = field;
+            const attrreference_t nameRef = readField<attrreference_t>(field);
+            const std::string_view name(nameField + nameRef.attr_dataoffset,
+                                        nameRef.attr_length > 0 ? nameRef.attr_length - 1 : 0);
+
+            // Filtered before any allocation
+            if (!impl_->allows(name)) continue;
+
+            Impl::Entry listed;
+            listed.path.reserve(directory.size() + name.size());
+            listed.path.append(directory).append(name);
+
+            fsobj_type_t type = VNON;
+            if (returned.commonattr & ATTR_CMN_OBJTYPE) {
+                type = readField<fsobj_type_t>(field);
+            }
+            if (returned.commonattr & ATTR_CMN_MODTIME) {
+                const timespec modified = readField<timespec>(field);
+                listed.modified = modified.tv_sec + modified.tv_nsec * 1e-9;
+            }
+            if (returned.fileattr & ATTR_FILE_DATALENGTH) {
+                listed.size = static_cast<uint64_t>(readField<off_t>(field));
+            }
 
-                for (const auto& allowedExt : impl_->allowedExtensions) {
-                    if (ext == allowedExt) {
-                        allowed = true;
-                        break;
-                    }
+            listed.directory = type == VDIR;
+            if (type == VLNK) {
+                // Links report on their target, as before
+                struct stat target;
+                if (::stat(listed.path.c_str(), &target) == 0) {
+                    listed.directory = S_ISDIR(target.st_mode);
+                    listed.size = listed.directory ? 0 : static_cast<uint64_t>(target.st_size);
+                    listed.modified = target.st_mtimespec.tv_sec + target.st_mtimespec.tv_nsec * 1e-9;
                 }
-
-                if (!allowed) continue;
             }
 
-            impl_->entries.push_back(fullPath);
+            impl_->entries.push_back(std::move(listed));
         }
+    }
 
-        return true;
+    ::close(fd);
+    if (!success) {
+        impl_->entries.clear();
     }
+    return success;
 }
 
 std::size_t ofDirectory::size() const {
@@ -145,24 +240,31 @@ std::size_t ofDirectory::size() const {
 
 std::string ofDirectory::getPath(std::size_t index) const {
     if (index >= impl_->entries.size()) return "";
-    return impl_->entries[index];
+    return impl_->entries[index].path;
 }
 
 std::string ofDirectory::getName(std::size_t index) const {
     if (index >= impl_->entries.size()) return "";
-    return ofFilePath::getFileName(impl_->entries[index]);
+    return ofFilePath::getFileName(impl_->entries[index].path);
 }
 
 std::vector<std::string> ofDirectory::getPaths() const {
-    return impl_->entries;
+    std::vector<std::string> paths;
+    paths.reserve(impl_->entries.size());
+
+    for (const auto& entry : impl_->entries) {
+        paths.push_back(entry.path);
+    }
+
+    return paths;
 }
 
 std::vector<std::string> ofDirectory::getNames() const {
     std::vector<std::string> names;
     names.reserve(impl_->entries.size());
 
-    for (const auto& path : impl_->entries) {
-        names.push_back(ofFilePath::getFileName(path));
+    for (const auto& entry : impl_->entries) {
+        names.push_back(ofFilePath::getFileName(entry.path));
     }
 
     return names;
@@ -170,33 +272,32 @@ std::vector<std::string> ofDirectory::getNames() const {
 
 bool ofDirectory::isDirectory(std::size_t index) const {
     if (index >= impl_->entries.size()) return false;
-
-    @autoreleasepool {
-        NSString* nsPath = [NSString stringWithUTF8String:impl_->entries[index].c_str()];
-        BOOL isDir = NO;
-        BOOL exists = [[NSFileManager defaultManager] fileExistsAtPath:nsPath isDirectory:&isDir];
-        return exists && isDir;
-    }
+    return impl_->entries[index].directory;
 }
 
 bool ofDirectory::isFile(std::size_t index) const {
     if (index >= impl_->entries.size()) return false;
+    return !impl_->entries[index].directory;
+}
 
-    @autoreleasepool {
-        NSString* nsPath = [NSString stringWithUTF8String:impl_->entries[index].c_str()];
-        BOOL isDir = NO;
-        BOOL exists = [[NSFileManager defaultManager] fileExistsAtPath:nsPath isDirectory:&isDir];
-        return exists && !isDir;
-    }
+uint64_t ofDirectory::getSize(std::size_t index) const {
+    if (index >= impl_->entries.size()) return 0;
+    return impl_->entries[index].size;
+}
+
+double ofDirectory::getModificationTime(std::size_t index) const {
+    if (index >= impl_->entries.size()) return 0.0;
+    return impl_->entries[index].modified;
 }
 
 ofFile ofDirectory::getFile(std::size_t index) const {
     if (index >= impl_->entries.size()) return ofFile();
-    return ofFile(impl_->entries[index]);
+    return ofFile(impl_->entries[index].path);
 }
 
 void ofDirectory::sort() {
-    std::sort(impl_->entries.begin(), impl_->entries.end());
+    std::sort(impl_->entries.begin(), impl_->entries.end(),
+              [](const Impl::Entry& a, const Impl::Entry& b) { return a.path < b.path; });
 }
 
 void ofDirectory::allowExt(const std::string& extension) {
@@ -0,0 +1,83 @@
+#pragma once
+
+// oflike-metal ofDirectoryWatcher - change notifications for a directory
+// FSEvents reports files created, removed, modified and renamed under a
+// directory; the changes are batched over a short latency and handed to a
+// callback on the main thread, so apps stop rescanning folders for new files.
+//
+// Usage:
+//   ofDirectoryWatcher watcher;
+//   watcher.allowExt("png");
+//   watcher.start("frames", [this](const std::vector<ofDirectoryEvent>& events) {
+//       for (const auto& event : events) {
+//           if (event.change == ofDirectoryChange::Created) queueFrame(event.path);
+//       }
+//   });
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace oflike {
+
+/// Kind of change reported by ofDirectoryWatcher
+enum class ofDirectoryChange {
+    Created,    ///< Entry appeared
+    Removed,    ///< Entry was deleted
+    Modified,   ///< Contents or metadata changed
+    Renamed,    ///< Entry moved; reported for both old and new path
+    Rescan      ///< Events were dropped; list the directory again (path is the directory)
+};
+
+/// One change to an entry of a watched directory
+struct ofDirectoryEvent {
+    ofDirectoryChange change;
+    std::string path;           ///< Absolute path, symbolic links resolved
+    bool isDirectory;
+};
+
+/// Called on the main thread with the changes of one batch, in order
+using ofDirectoryWatcherCallback = std::function<void(const std::vector<ofDirectoryEvent>& events)>;
+
+/// Watches a directory with FSEvents
+class ofDirectoryWatcher {
+public:
+    ofDirectoryWatcher();
+    ~ofDirectoryWatcher();
+
+    ofDirectoryWatcher(const ofDirectoryWatcher&) = delete;
+    ofDirectoryWatcher& operator=(const ofDirectoryWatcher&) = delete;
+
+    /// Start watching, replacing an earlier start()
+    /// Events are reported from this call on; list the directory first for
+    /// what is already there.
+    /// @param path Directory path
+    /// @param callback Called on the main thread with each batch
+    /// @param recursive Report changes in subdirectories too
+    /// @param latency Seconds changes are gathered for before a batch is sent
+    /// @return False if the directory doesn't exist or can't be watched
+    bool start(const std::string& path, ofDirectoryWatcherCallback callback,
+               bool recursive = true, float latency = 0.1f);
+
+    /// Stop watching; batches not delivered yet are dropped
+    void stop();
+
+    bool isWatching() const;
+
+    /// Get watched directory (absolute, links resolved)
+    std::string getPath() const;
+
+    /// Only report files with an extension (without dot); directories and
+    /// Rescan events are always reported. Applies from the next start().
+    void allowExt(const std::string& extension);
+
+    /// Clear extension filters
+    void clearExtFilters();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
@@ -0,0 +1,224 @@
+#include "ofDirectoryWatcher.h"
+#import <Foundation/Foundation.h>
+#import <CoreServices/CoreServices.h>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <mutex>
+#include <string_view>
+#include <sys/stat.h>
+
+namespace oflike {
+
+namespace {
+
+// Shared with the FSEvents queue and batches on their way to the main
+// thread, either of which may outlive the watcher
+struct WatchState {
+    std::string root;
+    bool recursive = true;
+    std::vector<std::string> extensions;
+    ofDirectoryWatcherCallback callback;
+    std::atomic<bool> active{true};
+};
+
+std::string_view extensionOf(std::string_view path) {
+    const size_t slash = path.rfind('/');
+    const size_t dot = path.rfind('.');
+    if (dot == std::string_view::npos || (slash != std::string_view::npos && dot <= slash + 1)) {
+        return std::string_view();
+    }
+    return path.substr(dot + 1);
+}
+
+bool exists(const std::string& path) {
+    struct stat info;
+    return ::lstat(path.c_str(), &info) == 0;
+}
+
+// Flags of changes in quick succession are merged; the entry's current
+// state decides between a removal and a creation
+bool classify(FSEventStreamEventFlags flags, const std::string& path, ofDirectoryChange& change) {
+    if (flags & kFSEventStreamEventFlagItemRenamed) {
+        change = ofDirectoryChange::Renamed;
+    } else if ((flags & kFSEventStreamEventFlagItemRemoved) && !exists(path)) {
+        change = ofDirectoryChange::Removed;
+    } else if (flags & kFSEventStreamEventFlagItemCreated) {
+        change = ofDirectoryChange::Created;
+    } else if (flags & (kFSEventStreamEventFlagItemModified | kFSEventStreamEventFlagItemInodeMetaMod |
+                        kFSEventStreamEventFlagItemChangeOwner | kFSEventStreamEventFlagItemXattrMod)) {
+        change = ofDirectoryChange::Modified;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void deliver(std::weak_ptr<WatchState> weak, std::vector<ofDirectoryEvent> events) {
+    // Handed over between frames, like ofImage::loadAsync()
+    struct Batch {
+        std::weak_ptr<WatchState> state;
+        std::vector<ofDirectoryEvent> events;
+    };
+    Batch* batch = new Batch{std::move(weak), std::move(events)};
+
+    dispatch_async_f(dispatch_get_main_queue(), batch, [](void* context) {
+        std::unique_ptr<Batch> batch(static_cast<Batch*>(context));
+        std::shared_ptr<WatchState> state = batch->state.lock();
+        if (state && state->active && state->callback) {
+            state->callback(batch->events);
+        }
+    });
+}
+
+void streamCallback(ConstFSEventStreamRef, void* info, size_t count, void* eventPaths,
+                    const FSEventStreamEventFlags flags[], const FSEventStreamEventId[]) {
+    auto& state = *static_cast<std::shared_ptr<WatchState>*>(info);
+    if (!state->active) return;
+
+    const char* const* paths = static_cast<const char* const*>(eventPaths);
+    std::vector<ofDirectoryEvent> events;
+    events.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const FSEventStreamEventFlags flag = flags[i];
+        if (flag & (kFSEventStreamEventFlagMustScanSubDirs | kFSEventStreamEventFlagUserDropped |
+                    kFSEventStreamEventFlagKernelDropped | kFSEventStreamEventFlagRootChanged)) {
+            events.push_back({ofDirectoryChange::Rescan, state->root, true});
+            continue;
+        }
+
+        std::string path = paths[i];
+        if (path == state->root) continue;
+        if (!state->recursive) {
+            const size_t slash = path.rfind('/');
+            if (slash == std::string::npos || std::string_view(path).substr(0, slash) != state->root) {
+                continue;
+            }
+        }
+
+        const bool directory = (flag & kFSEventStreamEventFlagItemIsDir) != 0;
+        if (!directory && !state->extensions.empty()) {
+            const std::string_view ext = extensionOf(path);
+            if (std::none_of(state->extensions.begin(), state->extensions.end(),
+                             [ext](const std::string& allowed) { return ext == allowed; })) {
+                continue;
+            }
+        }
+
+        ofDirectoryChange change;
+        if (classify(flag, path, change)) {
+            events.push_back({change, std::move(path), directory});
+        }
+    }
+
+    if (!events.empty()) {
+        deliver(state, std::move(events));
+    }
+}
+
+void releaseInfo(const void* info) {
+    delete static_cast<const std::shared_ptr<WatchState>*>(info);
+}
+
+} // namespace
+
+struct ofDirectoryWatcher::Impl {
+    std::shared_ptr<WatchState> state;
+    std::vector<std::string> extensions;
+    FSEventStreamRef stream = nullptr;
+    dispatch_queue_t queue = nil;
+
+    void stop() {
+        if (state) {
+            state->active = false;
+            state.reset();
+        }
+        if (stream) {
+            FSEventStreamStop(stream);
+            FSEventStreamInvalidate(stream);
+            FSEventStreamRelease(stream);
+            stream = nullptr;
+        }
+        queue = nil;
+    }
+};
+
+ofDirectoryWatcher::ofDirectoryWatcher() : impl_(std::make_unique<Impl>()) {}
+
+ofDirectoryWatcher::~ofDirectoryWatcher() {
+    impl_->stop();
+}
+
+bool ofDirectoryWatcher::start(const std::string& path, ofDirectoryWatcherCallback callback,
+                               bool recursive, float latency) {
+    impl_->stop();
+
+    // FSEvents reports real paths
+    char resolved[PATH_MAX];
+    struct stat info;
+    if (!::realpath(path.c_str(), resolved) || ::stat(resolved, &info) != 0 || !S_ISDIR(info.st_mode)) {
+        NSLog(@"ofDirectoryWatcher::start failed: %s is not a directory", path.c_str());
+        return false;
+    }
+
+    auto state = std::make_shared<WatchState>();
+    state->root = resolved;
+    state->recursive = recursive;
+    state->extensions = impl_->extensions;
+    state->callback = std::move(callback);
+
+    @autoreleasepool {
+        FSEventStreamContext context = {};
+        context.info = new std::shared_ptr<WatchState>(state);
+        context.release = releaseInfo;
+
+        NSArray* paths = @[[NSString stringWithUTF8String:resolved]];
+        FSEventStreamRef stream = FSEventStreamCreate(kCFAllocatorDefault, streamCallback, &context,
+                                                      (__bridge CFArrayRef)paths, kFSEventStreamEventIdSinceNow,
+                                                      std::max(latency, 0.0f),
+                                                      kFSEventStreamCreateFlagFileEvents |
+                                                      kFSEventStreamCreateFlagWatchRoot);
+        if (!stream) {
+            releaseInfo(context.info);
+            NSLog(@"ofDirectoryWatcher::start failed: can't watch %s", resolved);
+            return false;
+        }
+
+        impl_->queue = dispatch_queue_create("com.oflike.directoryWatcher", DISPATCH_QUEUE_SERIAL);
+        FSEventStreamSetDispatchQueue(stream, impl_->queue);
+        if (!FSEventStreamStart(stream)) {
+            FSEventStreamInvalidate(stream);
+            FSEventStreamRelease(stream);
+            impl_->queue = nil;
+            NSLog(@"ofDirectoryWatcher::start failed: can't watch %s", resolved);
+            return false;
+        }
+
+        impl_->stream = stream;
+        impl_->state = std::move(state);
+        return true;
+    }
+}
+
+void ofDirectoryWatcher::stop() {
+    impl_->stop();
+}
+
+bool ofDirectoryWatcher::isWatching() const {
+    return impl_->stream != nullptr;
+}
+
+std::string ofDirectoryWatcher::getPath() const {
+    return impl_->state ? impl_->state->root : std::string();
+}
+
+void ofDirectoryWatcher::allowExt(const std::string& extension) {
+    impl_->extensions.push_back(extension);
+}
+
+void ofDirectoryWatcher::clearExtFilters() {
+    impl_->extensions.clear();
+}
+
+} // namespace oflike
@@ -104,8 +104,9 @@ public:
     bool remove();
 
     /// Read entire file as buffer
+    /// @param mapped Map the file instead of copying it (see ofBufferMapFile())
     /// @return Buffer containing file data
-    ofBuffer readToBuffer() const;
+    ofBuffer readToBuffer(bool mapped = false) const;
 
     /// Write buffer to file
     /// @param buffer Buffer to write
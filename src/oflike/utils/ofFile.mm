@@ -181,8 +181,8 @@ bool ofFile::remove() {
     }
 }
 
-ofBuffer ofFile::readToBuffer() const {
-    return ofBufferFromFile(impl_->path);
+ofBuffer ofFile::readToBuffer(bool mapped) const {
+    return mapped ? ofBufferMapFile(impl_->path) : ofBufferFromFile(impl_->path);
 }
 
 bool ofFile::writeFromBuffer(const ofBuffer& buffer) {
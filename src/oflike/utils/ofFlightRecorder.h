@@ -0,0 +1,80 @@
+#pragma once
+
+// oflike-metal ofFlightRecorder - the seconds before a frame spike, on disk
+// While enabled, every frame's profiler scopes (ofProfiler is turned on) and
+// renderer statistics, and the log lines and GPU allocations of any thread,
+// go into fixed-size rings. A frame slower than the threshold dumps the
+// last seconds of them to a JSON file, formatted and written in the
+// background, and can start a draw list capture of the frames that follow
+// (ofCaptureFrames()) to replay the scene. Shows run with it on; each hitch
+// leaves a file to read afterwards.
+//
+// Usage:
+//   ofFlightRecorder::setThreshold(50.0f);          // ms
+//   ofFlightRecorder::setDirectory("spikes");
+//   ofFlightRecorder::setCaptureFrames(5);          // Optional
+//   ofFlightRecorder::setEnabled(true);
+
+#include "ofLog.h"
+#include "ofGpuMemory.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace oflike {
+
+/// \brief Ring buffers of recent frames, dumped when a frame is slow
+/// \details Frames are recorded by the app loop (endFrame()); log lines and
+/// allocations are recorded lock-free from any thread into a ring of 4096
+/// events, each log line cut to 200 characters. Dumps hold the frames and
+/// events of the last getDuration() seconds, oldest first, with times
+/// relative to the end of the slow frame. Settings are main thread only.
+class ofFlightRecorder {
+public:
+    /// \brief Start or stop recording; starting clears the rings
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /// \brief Seconds kept (default 10); takes effect at the next setEnabled(true)
+    static void setDuration(float seconds);
+    static float getDuration();
+
+    /// \brief Frame time that triggers a dump (default 50 ms)
+    static void setThreshold(float milliseconds);
+    static float getThreshold();
+
+    /// \brief Minimum seconds between automatic dumps (default 5), so one
+    /// hitch made of several slow frames writes one file
+    static void setCooldown(float seconds);
+
+    /// \brief Directory dumps are written to (default "flight-recorder"),
+    /// created when needed
+    static void setDirectory(const std::string& directory);
+    static std::string getDirectory();
+
+    /// \brief Frames of draw lists to capture after a spike (default 0: none)
+    /// \details Written next to the dump as "<dump name>.ofldl" for
+    /// tests/performance/gpu_benchmark --replay. Capturing slows the frames.
+    static void setCaptureFrames(int frames);
+
+    /// \brief Dump the rings now
+    /// \param reason Stored in the file
+    /// \return Path of the file being written, empty if not recording
+    static std::string dump(const std::string& reason = "manual");
+
+    /// \brief Dumps started since launch
+    static size_t getDumpCount();
+
+    /// \brief Record the frame that just ended; called by the app loop after
+    /// ofProfiler::endFrame()
+    static void endFrame();
+
+    /// \brief Record a log line (called by ofLogSubmit())
+    static void recordLog(ofLogLevel level, const char* module, const char* message);
+
+    /// \brief Record an allocation, or a release with negative bytes
+    /// (called by ofGpuMemory)
+    static void recordAllocation(ofGpuMemoryCategory category, const std::string& label, int64_t bytes);
+};
+
+} // namespace oflike
@@ -0,0 +1,424 @@
+#include "ofFlightRecorder.h"
+#include "FlightRecorderRing.h"
+#include "ofAsyncIO.h"
+#include "ofBuffer.h"
+#include "ofDirectory.h"
+#include "ofFrameCapture.h"
+#include "ofProfiler.h"
+#include "ofUtils.h"
+#include "../../core/Context.h"
+#include "../../render/IRenderer.h"
+#include <dispatch/dispatch.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace oflike {
+
+namespace {
+
+std::atomic<bool> recording{false};
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Leaked so that threads logging during static destruction are safe
+FlightEventRing& events() {
+    static FlightEventRing* ring = new FlightEventRing();
+    return *ring;
+}
+
+void copyText(char* target, size_t size, const char* text) {
+    std::strncpy(target, text ? text : "", size - 1);
+    target[size - 1] = '\0';
+}
+
+// ============================================================================
+// Frames
+// ============================================================================
+
+struct FrameRecord {
+    uint64_t frameNumber = 0;
+    int64_t end = 0;            // nowNs()
+    double ms = 0.0;
+    double gpuMs = 0.0;
+    uint32_t drawCalls = 0;
+    uint32_t vertices = 0;
+    ofProfileFrame profile;
+};
+
+// Frames in the duration at up to this rate fit the ring
+constexpr float kMaxFrameRate = 240.0f;
+
+struct RecorderState {
+    // Settings
+    float duration = 10.0f;
+    float threshold = 50.0f;
+    float cooldown = 5.0f;
+    std::string directory = "flight-recorder";
+    int captureFrames = 0;
+
+    // Frame ring, reused slot by slot
+    std::vector<FrameRecord> frames;
+    size_t frameHead = 0;
+    size_t frameCount = 0;
+    uint64_t frameNumber = 0;
+    int64_t lastFrame = 0;
+    int64_t lastDump = 0;
+    size_t dumps = 0;
+    bool enabledProfiler = false;
+};
+
+RecorderState& state() {
+    static RecorderState instance;
+    return instance;
+}
+
+// What a dump holds, handed to the formatting queue
+struct Snapshot {
+    std::string reason;
+    int64_t time = 0;
+    float duration = 0.0f;
+    float threshold = 0.0f;
+    std::vector<FrameRecord> frames;
+    std::vector<FlightEvent> events;
+};
+
+// ============================================================================
+// JSON
+// ============================================================================
+
+void appendEscaped(std::string& out, const char* text) {
+    out += '"';
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(*c));
+                    out += escaped;
+                } else {
+                    out += *c;
+                }
+        }
+    }
+    out += '"';
+}
+
+void appendNumber(std::string& out, double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f", value);
+    out += text;
+}
+
+// Seconds before the dump's time, negative
+double relative(const Snapshot& snapshot, int64_t time) {
+    return static_cast<double>(time - snapshot.time) * 1e-9;
+}
+
+const char* levelName(uint8_t level) {
+    switch (static_cast<ofLogLevel>(level)) {
+        case OF_LOG_VERBOSE: return "verbose";
+        case OF_LOG_NOTICE: return "notice";
+        case OF_LOG_WARNING: return "warning";
+        case OF_LOG_ERROR: return "error";
+        case OF_LOG_FATAL_ERROR: return "fatal";
+        default: return "notice";
+    }
+}
+
+std::string formatSnapshot(const Snapshot& snapshot) {
+    std::string out;
+    out.reserve(256 * (snapshot.frames.size() + snapshot.events.size()));
+
+    out += "{\n  \"reason\": ";
+    appendEscaped(out, snapshot.reason.c_str());
+    out += ",\n  \"durationSeconds\": ";
+    appendNumber(out, snapshot.duration);
+    out += ",\n  \"thresholdMs\": ";
+    appendNumber(out, snapshot.threshold);
+
+    out += ",\n  \"frames\": [";
+    for (size_t i = 0; i < snapshot.frames.size(); ++i) {
+        const FrameRecord& frame = snapshot.frames[i];
+        out += i == 0 ? "\n    {" : ",\n    {";
+        out += "\"frame\": " + std::to_string(frame.frameNumber);
+        out += ", \"time\": ";
+        appendNumber(out, relative(snapshot, frame.end));
+        out += ", \"ms\": ";
+        appendNumber(out, frame.ms);
+        out += ", \"gpuMs\": ";
+        appendNumber(out, frame.gpuMs);
+        out += ", \"drawCalls\": " + std::to_string(frame.drawCalls);
+        out += ", \"vertices\": " + std::to_string(frame.vertices);
+        out += ", \"threads\": [";
+        for (size_t t = 0; t < frame.profile.threads.size(); ++t) {
+            const ofProfileThread& thread = frame.profile.threads[t];
+            out += t == 0 ? "{\"name\": " : ", {\"name\": ";
+            appendEscaped(out, thread.name.c_str());
+            out += ", \"ms\": ";
+            appendNumber(out, thread.totalMs);
+            out += ", \"scopes\": [";
+            for (size_t n = 0; n < thread.nodes.size(); ++n) {
+                const ofProfileNode& node = thread.nodes[n];
+                out += n == 0 ? "{\"name\": " : ", {\"name\": ";
+                appendEscaped(out, node.name.c_str());
+                out += ", \"depth\": " + std::to_string(node.depth);
+                out += ", \"ms\": ";
+                appendNumber(out, node.totalMs);
+                out += ", \"calls\": " + std::to_string(node.calls) + "}";
+            }
+            out += "]}";
+        }
+        out += "]}";
+    }
+    out += "\n  ],\n  \"events\": [";
+
+    bool first = true;
+    const int64_t start = snapshot.time - static_cast<int64_t>(snapshot.duration * 1e9);
+    for (const FlightEvent& event : snapshot.events) {
+        if (event.time < start) {
+            continue;
+        }
+        out += first ? "\n    {" : ",\n    {";
+        first = false;
+        out += "\"time\": ";
+        appendNumber(out, relative(snapshot, event.time));
+        if (event.kind == FlightEventKind::Log) {
+            out += ", \"type\": \"log\", \"level\": \"";
+            out += levelName(event.code);
+            out += "\", \"module\": ";
+            appendEscaped(out, event.module);
+            out += ", \"message\": ";
+        } else {
+            out += ", \"type\": \"allocation\", \"category\": ";
+            appendEscaped(out, ofGpuMemoryCategoryName(static_cast<ofGpuMemoryCategory>(event.code)));
+            out += ", \"bytes\": " + std::to_string(event.bytes);
+            out += ", \"label\": ";
+        }
+        appendEscaped(out, event.text);
+        out += "}";
+    }
+    out += "\n  ]\n}\n";
+    return out;
+}
+
+// ============================================================================
+// Dumps
+// ============================================================================
+
+std::string startDump(RecorderState& s, const std::string& reason, int64_t now) {
+    ofDirectory directory(s.directory);
+    if (!directory.exists() && !directory.create(true)) {
+        ofLogError("ofFlightRecorder") << "Can't create " << s.directory;
+        return std::string();
+    }
+
+    // The frame number tells dumps of the same second apart
+    const std::string base = s.directory + "/spike-" + ofGetTimestampString("%Y%m%d-%H%M%S") +
+                             "-" + std::to_string(s.frameNumber);
+    const std::string path = base + ".json";
+
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->reason = reason;
+    snapshot->time = now;
+    snapshot->duration = s.duration;
+    snapshot->threshold = s.threshold;
+
+    // Copied here, formatted off the main thread
+    const int64_t start = now - static_cast<int64_t>(s.duration * 1e9);
+    const size_t capacity = s.frames.size();
+    snapshot->frames.reserve(s.frameCount);
+    for (size_t i = 0; i < s.frameCount; ++i) {
+        const FrameRecord& frame = s.frames[(s.frameHead + capacity - s.frameCount + i) % capacity];
+        if (frame.end >= start) {
+            snapshot->frames.push_back(frame);
+        }
+    }
+    events().snapshot(snapshot->events);
+
+    if (s.captureFrames > 0 && !ofIsCapturingFrames()) {
+        ofCaptureFrames(base + ".ofldl", s.captureFrames);
+    }
+
+    ++s.dumps;
+    s.lastDump = now;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        ofBufferToFileAsync(path, ofBuffer(formatSnapshot(*snapshot)), [path](bool ok) {
+            if (ok) {
+                ofLogNotice("ofFlightRecorder") << "Wrote " << path;
+            } else {
+                ofLogError("ofFlightRecorder") << "Failed to write " << path;
+            }
+        }, ofIOPriority::Low);
+    });
+    return path;
+}
+
+} // namespace
+
+// ============================================================================
+// ofFlightRecorder
+// ============================================================================
+
+void ofFlightRecorder::setEnabled(bool enabled) {
+    RecorderState& s = state();
+    if (enabled == recording.load()) {
+        return;
+    }
+
+    if (enabled) {
+        const size_t capacity = std::max<size_t>(1, static_cast<size_t>(s.duration * kMaxFrameRate));
+        s.frames.assign(capacity, FrameRecord());
+        s.frameHead = 0;
+        s.frameCount = 0;
+        s.lastFrame = 0;
+        events().clear();
+
+        // Scopes are what a dump is read for
+        s.enabledProfiler = !ofProfiler::isEnabled();
+        if (s.enabledProfiler) {
+            ofProfiler::setEnabled(true);
+        }
+    } else {
+        std::vector<FrameRecord>().swap(s.frames);
+        s.frameCount = 0;
+        if (s.enabledProfiler) {
+            ofProfiler::setEnabled(false);
+            s.enabledProfiler = false;
+        }
+    }
+    recording.store(enabled);
+}
+
+bool ofFlightRecorder::isEnabled() {
+    return recording.load(std::memory_order_relaxed);
+}
+
+void ofFlightRecorder::setDuration(float seconds) {
+    state().duration = std::max(seconds, 0.1f);
+}
+
+float ofFlightRecorder::getDuration() {
+    return state().duration;
+}
+
+void ofFlightRecorder::setThreshold(float milliseconds) {
+    state().threshold = milliseconds;
+}
+
+float ofFlightRecorder::getThreshold() {
+    return state().threshold;
+}
+
+void ofFlightRecorder::setCooldown(float seconds) {
+    state().cooldown = std::max(seconds, 0.0f);
+}
+
+void ofFlightRecorder::setDirectory(const std::string& directory) {
+    state().directory = directory;
+}
+
+std::string ofFlightRecorder::getDirectory() {
+    return state().directory;
+}
+
+void ofFlightRecorder::setCaptureFrames(int frames) {
+    state().captureFrames = std::max(frames, 0);
+}
+
+std::string ofFlightRecorder::dump(const std::string& reason) {
+    if (!recording.load()) {
+        return std::string();
+    }
+    return startDump(state(), reason, nowNs());
+}
+
+size_t ofFlightRecorder::getDumpCount() {
+    return state().dumps;
+}
+
+void ofFlightRecorder::endFrame() {
+    if (!recording.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    RecorderState& s = state();
+    const int64_t now = nowNs();
+    if (s.lastFrame == 0) {
+        s.lastFrame = now;
+        return;
+    }
+
+    FrameRecord& frame = s.frames[s.frameHead];
+    s.frameHead = (s.frameHead + 1) % s.frames.size();
+    s.frameCount = std::min(s.frameCount + 1, s.frames.size());
+
+    frame.frameNumber = ++s.frameNumber;
+    frame.end = now;
+    frame.ms = static_cast<double>(now - s.lastFrame) * 1e-6;
+    s.lastFrame = now;
+
+    // Assigned over the slot's previous frame, reusing its storage
+    if (!ofProfiler::getLastFrame(frame.profile)) {
+        frame.profile.threads.clear();
+    }
+    frame.gpuMs = 0.0;
+    frame.drawCalls = 0;
+    frame.vertices = 0;
+    if (render::IRenderer* renderer = Context::instance().renderer()) {
+        renderer->getStatistics(frame.drawCalls, frame.vertices);
+        frame.gpuMs = renderer->getLastGPUTime();
+    }
+
+    if (frame.ms >= s.threshold &&
+        (s.dumps == 0 || now - s.lastDump >= static_cast<int64_t>(s.cooldown * 1e9))) {
+        char reason[64];
+        std::snprintf(reason, sizeof(reason), "Frame %llu took %.1f ms",
+                      static_cast<unsigned long long>(frame.frameNumber), frame.ms);
+        startDump(s, reason, now);
+    }
+}
+
+void ofFlightRecorder::recordLog(ofLogLevel level, const char* module, const char* message) {
+    if (!recording.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const int64_t now = nowNs();
+    events().push([&](FlightEvent& event) {
+        event.time = now;
+        event.kind = FlightEventKind::Log;
+        event.code = static_cast<uint8_t>(level);
+        event.bytes = 0;
+        copyText(event.module, sizeof(event.module), module);
+        copyText(event.text, sizeof(event.text), message);
+    });
+}
+
+void ofFlightRecorder::recordAllocation(ofGpuMemoryCategory category, const std::string& label, int64_t bytes) {
+    if (!recording.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const int64_t now = nowNs();
+    events().push([&](FlightEvent& event) {
+        event.time = now;
+        event.kind = FlightEventKind::Allocation;
+        event.code = static_cast<uint8_t>(category);
+        event.bytes = bytes;
+        event.module[0] = '\0';
+        copyText(event.text, sizeof(event.text), label.c_str());
+    });
+}
+
+} // namespace oflike
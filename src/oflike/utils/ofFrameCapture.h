@@ -0,0 +1,41 @@
+#pragma once
+
+// oflike-metal ofFrameCapture - record frames' draw lists for offline replay
+// The next frames' draw lists, with the geometry, textures and buffers they
+// use, are written to a file that tests/performance/gpu_benchmark --replay
+// renders again without the app, so renderer changes can be measured and
+// profiled on a real scene
+//
+// Usage:
+//   void keyPressed(int key) {
+//       if (key == 'c') ofCaptureFrames("scene.ofldl", 30);   // Next 30 frames
+//   }
+
+#include <cstddef>
+#include <string>
+
+namespace render {
+class DrawList;
+}
+
+namespace oflike {
+
+/// \brief Capture the draw lists of the next frames into a file
+/// \details Frames are written as the renderer receives them, after
+/// optimize(). Each texture and buffer is stored once, with its contents
+/// when it is first drawn; compute dispatches and custom shader pipelines
+/// are not captured (see render::metal::DrawListCapture). Capturing reads
+/// textures back from the GPU, so captured frames run slower.
+/// \param path File to write, replaced if it exists
+/// \param frameCount Frames to record
+/// \return false if a capture is already running or the file can't be created
+bool ofCaptureFrames(const std::string& path, int frameCount = 1);
+
+/// \brief True while frames are being captured
+bool ofIsCapturingFrames();
+
+/// \brief Record one frame's lists if a capture is running
+/// Called by the app loop with the optimized lists of each frame.
+void ofCaptureFrameDrawLists(const render::DrawList* const* lists, size_t count);
+
+} // namespace oflike
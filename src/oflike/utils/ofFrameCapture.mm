@@ -0,0 +1,81 @@
+#include "ofFrameCapture.h"
+#include "ofLog.h"
+#include "../../core/Context.h"
+#include "../../render/IRenderer.h"
+#include "../../render/metal/DrawListCapture.h"
+#include <memory>
+
+namespace oflike {
+
+namespace {
+
+// Frame capture in progress (main thread, or render thread when pipelined)
+struct FrameCapture {
+    std::unique_ptr<render::metal::DrawListCapture> capture;
+    std::string path;
+    int remaining = 0;
+};
+
+FrameCapture& frameCapture() {
+    static FrameCapture state;
+    return state;
+}
+
+void finishCapture(FrameCapture& state) {
+    if (state.capture->close()) {
+        ofLogNotice("ofFrameCapture") << "Captured " << state.capture->getFrameCount()
+                                      << " frames to " << state.path;
+    } else {
+        ofLogError("ofFrameCapture") << "Failed to write " << state.path;
+    }
+    if (state.capture->getSkippedCommandCount() > 0) {
+        ofLogWarning("ofFrameCapture") << "Left out " << state.capture->getSkippedCommandCount()
+                                       << " compute dispatches";
+    }
+    state.capture.reset();
+    state.remaining = 0;
+}
+
+} // namespace
+
+bool ofCaptureFrames(const std::string& path, int frameCount) {
+    FrameCapture& state = frameCapture();
+    if (state.capture) {
+        ofLogError("ofFrameCapture") << "Already capturing to " << state.path;
+        return false;
+    }
+    render::IRenderer* renderer = Context::instance().renderer();
+    if (!renderer || frameCount <= 0) {
+        return false;
+    }
+
+    auto capture = std::make_unique<render::metal::DrawListCapture>(renderer->getDevice());
+    if (!capture->open(path)) {
+        ofLogError("ofFrameCapture") << "Failed to create " << path;
+        return false;
+    }
+    state.capture = std::move(capture);
+    state.path = path;
+    state.remaining = frameCount;
+    return true;
+}
+
+bool ofIsCapturingFrames() {
+    return frameCapture().capture != nullptr;
+}
+
+void ofCaptureFrameDrawLists(const render::DrawList* const* lists, size_t count) {
+    FrameCapture& state = frameCapture();
+    if (!state.capture) {
+        return;
+    }
+    render::IRenderer* renderer = Context::instance().renderer();
+    const bool ok = state.capture->captureFrame(lists, count,
+                                                renderer ? renderer->getViewportWidth() : 0,
+                                                renderer ? renderer->getViewportHeight() : 0);
+    if (!ok || --state.remaining == 0) {
+        finishCapture(state);
+    }
+}
+
+} // namespace oflike
@@ -0,0 +1,77 @@
+#pragma once
+
+// oflike-metal ofGpuMemory - accounting of the GPU memory the library holds
+// Buffers and textures created through the Metal allocation helpers
+// (render/metal/MetalAllocations.h) are counted per category and label
+// until they are released. The debug overlay shows the totals next to the
+// device's own figure, and whatever is still allocated at exit is logged.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace oflike {
+
+/// \brief What an allocation is for
+enum class ofGpuMemoryCategory {
+    Textures,           ///< Sampled textures: images, font atlases, video
+    RenderTargets,      ///< FBO attachments, depth and MSAA buffers, shadow maps
+    Meshes,             ///< Vertex, index and instance buffers, display lists
+    Streaming,          ///< Per-frame buffers the renderer refills
+    Staging,            ///< Upload and readback buffers
+    Splats,             ///< Gaussian splat buffers (ofxSharp)
+    Other,
+};
+
+constexpr size_t kNumGpuMemoryCategories = static_cast<size_t>(ofGpuMemoryCategory::Other) + 1;
+
+const char* ofGpuMemoryCategoryName(ofGpuMemoryCategory category);
+
+/// \brief Totals of one category
+struct ofGpuMemoryUsage {
+    ofGpuMemoryCategory category = ofGpuMemoryCategory::Other;
+    size_t count = 0;           ///< Live allocations
+    uint64_t bytes = 0;
+    uint64_t peakBytes = 0;     ///< Highest bytes since launch
+};
+
+/// \brief Live allocations sharing a label
+struct ofGpuAllocation {
+    std::string label;
+    ofGpuMemoryCategory category = ofGpuMemoryCategory::Other;
+    size_t count = 0;
+    uint64_t bytes = 0;
+};
+
+/// \brief Registry of tracked GPU allocations, safe to use from any thread
+/// \details Sizes are the resources' allocatedSize, so they include
+/// alignment and padding. Pipelines, drawables and resources created
+/// without the helpers are only in getDeviceAllocatedBytes().
+class ofGpuMemory {
+public:
+    /// \brief Count an allocation (called by the allocation helpers)
+    static void track(ofGpuMemoryCategory category, const std::string& label, uint64_t bytes);
+
+    /// \brief Forget an allocation counted by track()
+    static void untrack(ofGpuMemoryCategory category, const std::string& label, uint64_t bytes);
+
+    /// \brief Totals of every category, in category order
+    static void getUsage(std::vector<ofGpuMemoryUsage>& usage);
+
+    /// \brief Sum of the tracked allocations
+    static uint64_t getTrackedBytes();
+
+    /// \brief MTLDevice.currentAllocatedSize: all the app's GPU memory
+    /// \return 0 without a renderer
+    static uint64_t getDeviceAllocatedBytes();
+
+    /// \brief Live allocations grouped by label, largest first
+    static void getAllocations(std::vector<ofGpuAllocation>& allocations);
+
+    /// \brief Log the allocations still alive (called after the renderer shuts down)
+    /// \return Number of allocations reported
+    static size_t logLeaks();
+};
+
+} // namespace oflike
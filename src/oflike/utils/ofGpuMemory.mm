@@ -0,0 +1,194 @@
+#include "ofGpuMemory.h"
+#include "ofDebugStats.h"
+#include "ofFlightRecorder.h"
+#include "ofLog.h"
+#include "../../core/Context.h"
+#include "../../render/IRenderer.h"
+#import <Metal/Metal.h>
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace oflike {
+
+namespace {
+
+struct LabelTotals {
+    size_t count = 0;
+    uint64_t bytes = 0;
+};
+
+struct Tracker {
+    std::mutex mutex;
+    ofGpuMemoryUsage categories[kNumGpuMemoryCategories];
+    std::map<std::pair<ofGpuMemoryCategory, std::string>, LabelTotals> labels;
+};
+
+Tracker& tracker() {
+    static Tracker* instance = [] {
+        // Resources released during static destruction still untrack
+        auto* t = new Tracker();
+        for (size_t i = 0; i < kNumGpuMemoryCategories; ++i) {
+            t->categories[i].category = static_cast<ofGpuMemoryCategory>(i);
+        }
+        return t;
+    }();
+    return *instance;
+}
+
+std::string formatBytes(uint64_t bytes) {
+    char text[32];
+    if (bytes >= (1ull << 30)) {
+        std::snprintf(text, sizeof(text), "%.2f GB", bytes / double(1ull << 30));
+    } else if (bytes >= (1ull << 20)) {
+        std::snprintf(text, sizeof(text), "%.1f MB", bytes / double(1ull << 20));
+    } else {
+        std::snprintf(text, sizeof(text), "%.1f KB", bytes / 1024.0);
+    }
+    return text;
+}
+
+void collectRows(std::vector<ofDebugStat>& rows) {
+    std::vector<ofGpuMemoryUsage> usage;
+    ofGpuMemory::getUsage(usage);
+    uint64_t tracked = 0;
+    uint64_t peak = 0;
+    for (const ofGpuMemoryUsage& category : usage) {
+        tracked += category.bytes;
+        peak += category.peakBytes;
+        if (category.count > 0) {
+            rows.push_back({"GPU Memory", ofGpuMemoryCategoryName(category.category),
+                            formatBytes(category.bytes) + " (" + std::to_string(category.count) + ")"});
+        }
+    }
+    rows.push_back({"GPU Memory", "Tracked", formatBytes(tracked) + " (peaks " + formatBytes(peak) + ")"});
+
+    const uint64_t device = ofGpuMemory::getDeviceAllocatedBytes();
+    if (device > 0) {
+        rows.push_back({"GPU Memory", "Device", formatBytes(device)});
+        rows.push_back({"GPU Memory", "Untracked", formatBytes(device > tracked ? device - tracked : 0)});
+    }
+}
+
+// The overlay rows exist from the first allocation on
+void showInOverlay() {
+    static const int overlayId = ofDebugStats::addSource(collectRows);
+    (void)overlayId;
+}
+
+} // namespace
+
+const char* ofGpuMemoryCategoryName(ofGpuMemoryCategory category) {
+    switch (category) {
+        case ofGpuMemoryCategory::Textures: return "Textures";
+        case ofGpuMemoryCategory::RenderTargets: return "Render Targets";
+        case ofGpuMemoryCategory::Meshes: return "Meshes";
+        case ofGpuMemoryCategory::Streaming: return "Streaming";
+        case ofGpuMemoryCategory::Staging: return "Staging";
+        case ofGpuMemoryCategory::Splats: return "Splats";
+        case ofGpuMemoryCategory::Other: return "Other";
+    }
+    return "Other";
+}
+
+// ============================================================================
+// ofGpuMemory
+// ============================================================================
+
+void ofGpuMemory::track(ofGpuMemoryCategory category, const std::string& label, uint64_t bytes) {
+    showInOverlay();
+    ofFlightRecorder::recordAllocation(category, label, static_cast<int64_t>(bytes));
+    Tracker& t = tracker();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    ofGpuMemoryUsage& usage = t.categories[static_cast<size_t>(category)];
+    usage.count += 1;
+    usage.bytes += bytes;
+    usage.peakBytes = std::max(usage.peakBytes, usage.bytes);
+    LabelTotals& totals = t.labels[{category, label}];
+    totals.count += 1;
+    totals.bytes += bytes;
+}
+
+void ofGpuMemory::untrack(ofGpuMemoryCategory category, const std::string& label, uint64_t bytes) {
+    ofFlightRecorder::recordAllocation(category, label, -static_cast<int64_t>(bytes));
+    Tracker& t = tracker();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    ofGpuMemoryUsage& usage = t.categories[static_cast<size_t>(category)];
+    usage.count -= std::min<size_t>(usage.count, 1);
+    usage.bytes -= std::min(usage.bytes, bytes);
+    auto it = t.labels.find({category, label});
+    if (it != t.labels.end()) {
+        it->second.count -= std::min<size_t>(it->second.count, 1);
+        it->second.bytes -= std::min(it->second.bytes, bytes);
+        if (it->second.count == 0) {
+            t.labels.erase(it);
+        }
+    }
+}
+
+void ofGpuMemory::getUsage(std::vector<ofGpuMemoryUsage>& usage) {
+    Tracker& t = tracker();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    usage.assign(t.categories, t.categories + kNumGpuMemoryCategories);
+}
+
+uint64_t ofGpuMemory::getTrackedBytes() {
+    Tracker& t = tracker();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    uint64_t bytes = 0;
+    for (const ofGpuMemoryUsage& usage : t.categories) {
+        bytes += usage.bytes;
+    }
+    return bytes;
+}
+
+uint64_t ofGpuMemory::getDeviceAllocatedBytes() {
+    render::IRenderer* renderer = Context::instance().renderer();
+    if (!renderer || !renderer->getDevice()) {
+        return 0;
+    }
+    id<MTLDevice> device = (__bridge id<MTLDevice>)renderer->getDevice();
+    return device.currentAllocatedSize;
+}
+
+void ofGpuMemory::getAllocations(std::vector<ofGpuAllocation>& allocations) {
+    Tracker& t = tracker();
+    {
+        std::lock_guard<std::mutex> lock(t.mutex);
+        allocations.clear();
+        allocations.reserve(t.labels.size());
+        for (const auto& [key, totals] : t.labels) {
+            allocations.push_back(ofGpuAllocation{key.second, key.first, totals.count, totals.bytes});
+        }
+    }
+    std::sort(allocations.begin(), allocations.end(),
+              [](const ofGpuAllocation& a, const ofGpuAllocation& b) { return a.bytes > b.bytes; });
+}
+
+size_t ofGpuMemory::logLeaks() {
+    std::vector<ofGpuAllocation> allocations;
+    getAllocations(allocations);
+    size_t count = 0;
+    uint64_t bytes = 0;
+    for (const ofGpuAllocation& allocation : allocations) {
+        count += allocation.count;
+        bytes += allocation.bytes;
+    }
+    if (count == 0) {
+        ofLogVerbose("ofGpuMemory") << "No GPU allocations left at exit";
+        return 0;
+    }
+
+    ofLogWarning("ofGpuMemory") << count << " GPU allocations (" << formatBytes(bytes)
+                                << ") still alive at exit:";
+    for (const ofGpuAllocation& allocation : allocations) {
+        ofLogWarning("ofGpuMemory") << "  " << ofGpuMemoryCategoryName(allocation.category) << " / "
+                                    << (allocation.label.empty() ? "(unlabeled)" : allocation.label)
+                                    << ": " << allocation.count << " x, " << formatBytes(allocation.bytes);
+    }
+    return count;
+}
+
+} // namespace oflike
@@ -0,0 +1,356 @@
+#include "ofJobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <pthread.h>
+#include <sys/sysctl.h>
+
+namespace oflike {
+
+// A job waits on `blockers` (its unfinished dependencies, plus one while it
+// is being launched) and is queued when they reach zero
+struct ofJob::State {
+    ofJobSystem::Function function;
+    void* owner = nullptr;                  // ofJobSystem::Impl that runs it
+    std::atomic<int> blockers{1};
+    std::atomic<bool> done{false};
+    std::mutex mutex;                       // Guards dependents against done
+    std::vector<std::shared_ptr<State>> dependents;
+};
+
+bool ofJob::isDone() const {
+    return !state_ || state_->done.load();
+}
+
+namespace {
+
+using JobPtr = std::shared_ptr<ofJob::State>;
+
+// Owner pushes and pops at the back; other threads steal from the front
+struct JobQueue {
+    std::mutex mutex;
+    std::deque<JobPtr> jobs;
+};
+
+// The pool and queue of the current thread, if it is a worker
+thread_local const void* workerPool = nullptr;
+thread_local size_t workerIndex = 0;
+
+size_t sysctlCount(const char* name) {
+    int value = 0;
+    size_t size = sizeof(value);
+    if (sysctlbyname(name, &value, &size, nullptr, 0) != 0 || value <= 0) {
+        return 0;
+    }
+    return static_cast<size_t>(value);
+}
+
+} // namespace
+
+// ============================================================================
+// Impl
+// ============================================================================
+
+class ofJobSystem::Impl {
+public:
+    explicit Impl(size_t workerCount) {
+        // Outside threads spread their jobs over the workers' queues; a pool
+        // without workers keeps one queue for its waiting threads to run
+        const size_t queueCount = std::max<size_t>(workerCount, 1);
+        for (size_t i = 0; i < queueCount; ++i) {
+            queues.push_back(std::make_unique<JobQueue>());
+        }
+        for (size_t i = 0; i < workerCount; ++i) {
+            threads.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // Queue a job whose dependencies have finished
+    void schedule(JobPtr job) {
+        size_t index;
+        if (workerPool == this) {
+            index = workerIndex;
+        } else {
+            index = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        }
+        {
+            std::lock_guard<std::mutex> lock(queues[index]->mutex);
+            queues[index]->jobs.push_back(std::move(job));
+        }
+        queued.fetch_add(1);
+
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wake.notify_one();
+        if (waiters.load() > 0) {
+            progress.notify_all();
+        }
+    }
+
+    // Take a job: the newest of the thread's own queue, else the oldest of
+    // another's
+    JobPtr take() {
+        if (queued.load(std::memory_order_relaxed) == 0) {
+            return nullptr;
+        }
+        const bool worker = workerPool == this;
+        const size_t start = worker ? workerIndex : nextQueue.load(std::memory_order_relaxed);
+        const size_t count = queues.size();
+        for (size_t k = 0; k < count; ++k) {
+            JobQueue& queue = *queues[(start + k) % count];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.jobs.empty()) {
+                continue;
+            }
+            JobPtr job;
+            if (worker && k == 0) {
+                job = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+            } else {
+                job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+            }
+            queued.fetch_sub(1);
+            return job;
+        }
+        return nullptr;
+    }
+
+    void execute(const JobPtr& job) {
+        job->function();
+        job->function = nullptr;    // Release captures before dependents run
+
+        std::vector<JobPtr> dependents;
+        {
+            std::lock_guard<std::mutex> lock(job->mutex);
+            job->done.store(true);
+            dependents.swap(job->dependents);
+        }
+        for (JobPtr& dependent : dependents) {
+            if (dependent->blockers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                static_cast<Impl*>(dependent->owner)->schedule(std::move(dependent));
+            }
+        }
+
+        pending.fetch_sub(1);
+        if (waiters.load() > 0) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            progress.notify_all();
+        }
+    }
+
+    // Run queued jobs until done() holds, sleeping while there are none
+    template <typename Done>
+    void helpUntil(Done done) {
+        while (!done()) {
+            if (JobPtr job = take()) {
+                execute(job);
+                continue;
+            }
+            waiters.fetch_add(1);
+            {
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                progress.wait(lock, [&] { return done() || queued.load() > 0; });
+            }
+            waiters.fetch_sub(1);
+        }
+    }
+
+    void workerLoop(size_t index) {
+        workerPool = this;
+        workerIndex = index;
+        pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
+        pthread_setname_np(("oflike.jobs." + std::to_string(index)).c_str());
+
+        for (;;) {
+            if (JobPtr job = take()) {
+                execute(job);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+            if (stopping && queued.load() == 0) {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<JobQueue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> queued{0};          // Jobs in the queues
+    std::atomic<size_t> pending{0};         // Jobs launched and not finished
+    std::atomic<size_t> nextQueue{0};
+    std::atomic<int> waiters{0};            // Threads asleep in helpUntil()
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;           // Workers: a job was queued, or stop
+    std::condition_variable progress;       // Waiters: a job finished or was queued
+    bool stopping = false;
+};
+
+// ============================================================================
+// ofJobSystem
+// ============================================================================
+
+ofJobSystem::ofJobSystem(size_t workers) {
+    if (workers == 0) {
+        const size_t cores = ofGetPerformanceCoreCount();
+        workers = cores > 1 ? cores - 1 : 0;
+    }
+    impl_ = std::make_unique<Impl>(workers);
+}
+
+ofJobSystem::~ofJobSystem() {
+    waitAll();
+}
+
+ofJobSystem& ofJobSystem::shared() {
+    // Leaked so that jobs still running during static destruction finish
+    static ofJobSystem* instance = new ofJobSystem();
+    return *instance;
+}
+
+ofJob ofJobSystem::launch(Function function, std::initializer_list<ofJob> dependencies) {
+    return launchWith(std::move(function), dependencies.begin(), dependencies.size());
+}
+
+ofJob ofJobSystem::launch(Function function, const std::vector<ofJob>& dependencies) {
+    return launchWith(std::move(function), dependencies.data(), dependencies.size());
+}
+
+ofJob ofJobSystem::launchWith(Function function, const ofJob* dependencies, size_t count) {
+    auto state = std::make_shared<ofJob::State>();
+    state->function = std::move(function);
+    state->owner = impl_.get();
+    impl_->pending.fetch_add(1);
+
+    for (size_t i = 0; i < count; ++i) {
+        const std::shared_ptr<ofJob::State>& dependency = dependencies[i].state_;
+        if (!dependency) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(dependency->mutex);
+        if (!dependency->done.load(std::memory_order_relaxed)) {
+            state->blockers.fetch_add(1, std::memory_order_relaxed);
+            dependency->dependents.push_back(state);
+        }
+    }
+
+    ofJob job;
+    job.state_ = state;
+    if (state->blockers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        impl_->schedule(std::move(state));
+    }
+    return job;
+}
+
+void ofJobSystem::wait(const ofJob& job) {
+    impl_->helpUntil([&job] { return job.isDone(); });
+}
+
+void ofJobSystem::waitAll() {
+    Impl& impl = *impl_;
+    impl.helpUntil([&impl] { return impl.pending.load() == 0; });
+}
+
+void ofJobSystem::parallelFor(size_t begin, size_t end, size_t grain,
+                              const std::function<void(size_t begin, size_t end)>& fn) {
+    if (end <= begin || !fn) {
+        return;
+    }
+    const size_t count = end - begin;
+    const size_t workers = impl_->threads.size();
+    if (grain == 0) {
+        grain = std::max<size_t>(count / ((workers + 1) * 4), 1);
+    }
+    const size_t chunks = (count - 1) / grain + 1;
+
+    std::atomic<size_t> next{0};
+    auto body = [&] {
+        for (size_t chunk; (chunk = next.fetch_add(1, std::memory_order_relaxed)) < chunks;) {
+            const size_t first = begin + chunk * grain;
+            fn(first, first + std::min(grain, end - first));
+        }
+    };
+
+    // Helpers take chunks as they come free; any that start after the
+    // caller has taken the last chunk return at once
+    const size_t helpers = std::min(workers, chunks - 1);
+    std::vector<ofJob> jobs;
+    jobs.reserve(helpers);
+    for (size_t i = 0; i < helpers; ++i) {
+        jobs.push_back(launch(body));
+    }
+    body();
+    for (const ofJob& job : jobs) {
+        wait(job);
+    }
+}
+
+size_t ofJobSystem::getWorkerCount() const {
+    return impl_->threads.size();
+}
+
+size_t ofJobSystem::getPendingCount() const {
+    return impl_->pending.load();
+}
+
+// ============================================================================
+// Shared pool
+// ============================================================================
+
+namespace {
+std::atomic<bool> sharedPoolUsed{false};
+
+ofJobSystem& sharedPool() {
+    sharedPoolUsed.store(true, std::memory_order_relaxed);
+    return ofJobSystem::shared();
+}
+} // namespace
+
+size_t ofGetPerformanceCoreCount() {
+    // Apple silicon lists its core types as perflevels, fastest first
+    static const size_t count = [] {
+        size_t cores = sysctlCount("hw.perflevel0.logicalcpu");
+        if (cores == 0) cores = sysctlCount("hw.logicalcpu");
+        if (cores == 0) cores = std::thread::hardware_concurrency();
+        return std::max<size_t>(cores, 1);
+    }();
+    return count;
+}
+
+ofJob ofLaunchJob(ofJobSystem::Function function, std::initializer_list<ofJob> dependencies) {
+    return sharedPool().launch(std::move(function), dependencies);
+}
+
+void ofParallelFor(size_t begin, size_t end, size_t grain,
+                   const std::function<void(size_t begin, size_t end)>& fn) {
+    sharedPool().parallelFor(begin, end, grain, fn);
+}
+
+void ofParallelFor(size_t begin, size_t end, const std::function<void(size_t begin, size_t end)>& fn) {
+    sharedPool().parallelFor(begin, end, 0, fn);
+}
+
+void ofWaitForJobs() {
+    // Apps that never launch a job don't start the pool
+    if (sharedPoolUsed.load(std::memory_order_relaxed)) {
+        ofJobSystem::shared().waitAll();
+    }
+}
+
+} // namespace oflike
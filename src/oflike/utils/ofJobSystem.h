@@ -0,0 +1,140 @@
+#pragma once
+
+// oflike-metal ofJobSystem - work-stealing job threads and parallel loops
+// Jobs launched in update() run on worker threads sized to the performance
+// cores; the app loop joins them after update() returns, before draw()
+//
+// Usage:
+//   void update() {
+//       ofParallelFor(0, particles.size(), 4096, [&](size_t begin, size_t end) {
+//           for (size_t i = begin; i < end; ++i) particles[i].update(dt);
+//       });
+//
+//       ofJob forces = ofLaunchJob([&] { computeForces(); });
+//       ofLaunchJob([&] { integrate(); }, {forces});   // Runs after forces
+//   }                                                  // Both done before draw()
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace oflike {
+
+class ofJobSystem;
+
+/// \brief Handle to a launched job
+/// \details Copies refer to the same job. A default-constructed handle
+/// refers to no job and counts as finished.
+class ofJob {
+public:
+    ofJob() = default;
+
+    /// \brief True once the job has run
+    bool isDone() const;
+
+    /// \brief True if the handle refers to a job
+    bool isValid() const { return state_ != nullptr; }
+
+    struct State;   ///< Opaque, defined by ofJobSystem
+
+private:
+    friend class ofJobSystem;
+    std::shared_ptr<State> state_;
+};
+
+/// \brief Work-stealing pool of job threads
+/// \details Each worker keeps its own queue: it runs its newest job first
+/// and, when it runs out, steals the oldest job of another worker. A job
+/// starts once all of its dependencies have finished. Threads that wait, on
+/// a job or for the pool to drain, run queued jobs meanwhile, so jobs may
+/// launch and wait for other jobs. Jobs must not throw.
+///
+/// The shared pool has one worker per performance core, less one for the
+/// main thread, which helps while it waits. macOS doesn't let threads be
+/// pinned to cores; the workers run at the user-interactive QoS class,
+/// which the scheduler keeps on performance cores while they are free.
+class ofJobSystem {
+public:
+    using Function = std::function<void()>;
+
+    /// \brief Start a pool
+    /// \param workers Worker threads; 0 for one per performance core, less one
+    explicit ofJobSystem(size_t workers = 0);
+
+    /// \brief Wait for every job, then stop the workers
+    ~ofJobSystem();
+
+    ofJobSystem(const ofJobSystem&) = delete;
+    ofJobSystem& operator=(const ofJobSystem&) = delete;
+
+    /// \brief The pool used by ofLaunchJob() and ofParallelFor()
+    static ofJobSystem& shared();
+
+    // ========================================================================
+    // Jobs
+    // ========================================================================
+
+    /// \brief Launch a job
+    /// \param function Work to run on a worker thread
+    /// \param dependencies Jobs that must finish first
+    /// \return Handle to wait on or to depend on
+    ofJob launch(Function function, std::initializer_list<ofJob> dependencies = {});
+
+    /// \brief Launch a job after a list of dependencies built at runtime
+    ofJob launch(Function function, const std::vector<ofJob>& dependencies);
+
+    /// \brief Block until a job has run, running queued jobs meanwhile
+    void wait(const ofJob& job);
+
+    /// \brief Block until every job launched so far has run
+    void waitAll();
+
+    // ========================================================================
+    // Loops
+    // ========================================================================
+
+    /// \brief Run fn over [begin, end) in chunks of grain, across the workers
+    /// \details The calling thread works on chunks too and returns once all
+    /// of them have run. Chunks run in no particular order.
+    /// \param grain Indices per chunk; 0 picks about four chunks per thread
+    /// \param fn Called with each chunk's [begin, end)
+    void parallelFor(size_t begin, size_t end, size_t grain,
+                     const std::function<void(size_t begin, size_t end)>& fn);
+
+    // ========================================================================
+    // Info
+    // ========================================================================
+
+    size_t getWorkerCount() const;
+
+    /// \brief Jobs launched and not finished yet
+    size_t getPendingCount() const;
+
+private:
+    ofJob launchWith(Function function, const ofJob* dependencies, size_t count);
+
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/// \brief Performance cores of this machine (all cores where they don't differ)
+size_t ofGetPerformanceCoreCount();
+
+/// \brief Launch a job on the shared pool; joined before draw()
+ofJob ofLaunchJob(ofJobSystem::Function function, std::initializer_list<ofJob> dependencies = {});
+
+/// \brief Run fn over [begin, end) in chunks of grain on the shared pool
+/// \see ofJobSystem::parallelFor()
+void ofParallelFor(size_t begin, size_t end, size_t grain,
+                   const std::function<void(size_t begin, size_t end)>& fn);
+
+/// \brief Like ofParallelFor() with a grain picked from the thread count
+void ofParallelFor(size_t begin, size_t end, const std::function<void(size_t begin, size_t end)>& fn);
+
+/// \brief Block until every job of the shared pool has run
+/// Called by the app loop after update() and after exit().
+void ofWaitForJobs();
+
+} // namespace oflike
@@ -19,7 +19,16 @@
 //
 // Logs are sent to os_log and can be viewed in Console.app
 // Log subsystem: com.oflike.metal
-
+//
+// Messages are written by a background thread: the calling thread formats
+// the message and pushes it onto a lock-free queue, so logging from render
+// loops doesn't wait on os_log. Consecutive repeats of a message are
+// written once with a repeat count. Below the log level nothing is
+// formatted; OF_LOG() also skips evaluating the streamed values:
+//   OF_LOG(OF_LOG_VERBOSE, "Mesh") << expensiveSummary();
+
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <sstream>
 
@@ -60,12 +69,14 @@ public:
     // Template for other types
     template<typename T>
     ofLogStream& operator<<(const T& value) {
-        getStream() << value;
+        if (impl_) {
+            getStream() << value;
+        }
         return *this;
     }
 
 private:
-    ofLogStreamImpl* impl_;
+    ofLogStreamImpl* impl_;     // nullptr when the level is filtered out
     std::ostringstream& getStream();
 };
 
@@ -126,4 +137,56 @@ void ofSetLogLevel(ofLogLevel level);
 /// @return Current minimum log level
 ofLogLevel ofGetLogLevel();
 
+/// Check whether messages of a level are written at the current log level
+/// @param level Log level to test
+/// @return true if a message of this level would be logged
+bool ofLogEnabled(ofLogLevel level);
+
+/// Write messages on the background thread (default) or synchronously on
+/// the calling thread
+/// @param async false to write every message before the log call returns
+void ofSetLogAsync(bool async);
+
+/// Wait until every message logged so far has been written
+/// Called at exit and before a fatal error aborts
+void ofLogFlush();
+
+/// Log an already formatted message (for printf-style wrappers)
+/// @param level Log level
+/// @param module Module name, "" for none
+/// @param message Message text
+/// @param suppressed Similar messages held back by an ofLogRateLimiter,
+///                   noted after the text when not 0
+void ofLogSubmit(ofLogLevel level, const char* module, const char* message, uint32_t suppressed = 0);
+
+/// Number of messages lost because the background queue was full
+uint64_t ofGetLogDropCount();
+
+// Rate limiting
+
+/// Per-call-site limit for messages that may repeat every frame
+/// The first kBurst messages pass, then one per second; allow() reports
+/// how many were held back since the last one that passed. Keep one as a
+/// static at the call site.
+class ofLogRateLimiter {
+public:
+    static constexpr uint32_t kBurst = 8;
+
+    /// @param suppressed Receives the messages held back since the last allowed one
+    /// @return true if this message should be logged
+    bool allow(uint32_t& suppressed);
+
+private:
+    std::atomic<uint32_t> passed_{0};
+    std::atomic<uint32_t> held_{0};
+    std::atomic<uint64_t> nextAllowed_{0};     // Monotonic nanoseconds
+};
+
 } // namespace oflike
+
+/// Stream a log message only when its level is enabled; unlike ofLog(),
+/// the values streamed after it are not evaluated otherwise
+/// @param level ofLogLevel of the message
+/// @param module Module name ("" for none)
+#define OF_LOG(level, module) \
+    if (!::oflike::ofLogEnabled(level)) {} else ::oflike::ofLogStream(level, module)
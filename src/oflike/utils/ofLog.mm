@@ -1,11 +1,20 @@
 #include "ofLog.h"
+#include "LogQueue.h"
+#include "ofFlightRecorder.h"
 #import <os/log.h>
+#include <dispatch/dispatch.h>
+#include <chrono>
+#include <cstdarg>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
 
 namespace oflike {
 
 // Global log level state
-static ofLogLevel g_currentLogLevel = OF_LOG_VERBOSE;
+static std::atomic<int> g_currentLogLevel{OF_LOG_VERBOSE};
+static std::atomic<bool> g_logAsync{true};
 
 // Get os_log for the framework
 static os_log_t getOfLog() {
@@ -13,67 +22,248 @@ static os_log_t getOfLog() {
     return log;
 }
 
-// Internal implementation class for os_log integration
-class ofLogStreamImpl {
+// Write one message to os_log at the level's os_log type
+static void emitLog(ofLogLevel level, const char* module, const char* message) {
+    @autoreleasepool {
+        os_log_t log = getOfLog();
+        const char* msg_cstr = message;
+
+        // Add module prefix if specified
+        std::string fullMessage;
+        if (module && module[0] != '\0') {
+            fullMessage = "[" + std::string(module) + "] " + message;
+            msg_cstr = fullMessage.c_str();
+        }
+
+        // Map ofLogLevel to os_log_type_t
+        switch (level) {
+            case OF_LOG_VERBOSE:
+                os_log_debug(log, "%{public}s", msg_cstr);
+                break;
+
+            case OF_LOG_NOTICE:
+                os_log_info(log, "%{public}s", msg_cstr);
+                break;
+
+            case OF_LOG_WARNING:
+                os_log(log, "%{public}s", msg_cstr);
+                break;
+
+            case OF_LOG_ERROR:
+                os_log_error(log, "%{public}s", msg_cstr);
+                break;
+
+            case OF_LOG_FATAL_ERROR:
+                os_log_fault(log, "%{public}s", msg_cstr);
+                break;
+
+            default:
+                os_log_info(log, "%{public}s", msg_cstr);
+                break;
+        }
+    }
+}
+
+// ============================================================================
+// Background writer
+// ============================================================================
+
+namespace {
+
+// The writer thread and its queue; never destroyed, so messages logged
+// from static destructors still have somewhere to go
+class LogWriter {
 public:
-    ofLogStreamImpl(ofLogLevel level, const char* module)
-        : level_(level), module_(module) {}
+    static LogWriter& instance() {
+        static LogWriter* writer = [] {
+            LogWriter* created = new LogWriter();
+            std::atexit([] { ofLogFlush(); });
+            return created;
+        }();
+        return *writer;
+    }
 
-    ~ofLogStreamImpl() {
-        // Check if this log level should be displayed
-        if (level_ < g_currentLogLevel || level_ >= OF_LOG_SILENT) {
-            return;
+    bool submit(ofLogLevel level, const char* module, const char* text, size_t length) {
+        const bool queued = queue_.push([&](LogRecord& record) {
+            record.level = level;
+            record.length = (uint32_t)length;
+            std::strncpy(record.module, module ? module : "", kLogModuleSize - 1);
+            record.module[kLogModuleSize - 1] = '\0';
+            std::memcpy(record.text, text, length);
+            record.text[length] = '\0';
+        });
+        if (!queued) {
+            drops_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        submitted_.fetch_add(1, std::memory_order_release);
+        if (sleeping_.load(std::memory_order_acquire)) {
+            dispatch_semaphore_signal(wake_);
         }
+        return true;
+    }
 
-        std::string message = stream_.str();
-        if (message.empty()) return;
+    // Waits until the writer has caught up with every message submitted so far
+    void flush() {
+        const uint64_t target = submitted_.load(std::memory_order_acquire);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (written_.load(std::memory_order_acquire) < target &&
+               std::chrono::steady_clock::now() < deadline) {
+            dispatch_semaphore_signal(wake_);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
 
-        @autoreleasepool {
-            os_log_t log = getOfLog();
-            const char* msg_cstr = message.c_str();
+    uint64_t getDrops() const { return drops_.load(std::memory_order_relaxed); }
 
-            // Add module prefix if specified
-            std::string fullMessage;
-            if (module_ && module_[0] != '\0') {
-                fullMessage = "[" + std::string(module_) + "] " + message;
-                msg_cstr = fullMessage.c_str();
+private:
+    LogWriter() : wake_(dispatch_semaphore_create(0)) {
+        std::thread([this] { run(); }).detach();
+    }
+
+    void run() {
+        LogRecord record;
+        for (;;) {
+            bool wrote = false;
+            while (queue_.pop(record)) {
+                write(record);
+                written_.fetch_add(1, std::memory_order_release);
+                wrote = true;
+            }
+            reportDrops();
+            if (wrote) {
+                continue;
             }
 
-            // Map ofLogLevel to os_log_type_t
-            switch (level_) {
-                case OF_LOG_VERBOSE:
-                    os_log_debug(log, "%{public}s", msg_cstr);
-                    break;
-
-                case OF_LOG_NOTICE:
-                    os_log_info(log, "%{public}s", msg_cstr);
-                    break;
-
-                case OF_LOG_WARNING:
-                    os_log(log, "%{public}s", msg_cstr);
-                    break;
-
-                case OF_LOG_ERROR:
-                    os_log_error(log, "%{public}s", msg_cstr);
-                    break;
-
-                case OF_LOG_FATAL_ERROR:
-                    os_log_fault(log, "%{public}s", msg_cstr);
-                    // Fatal errors should terminate the program
-                    std::abort();
-                    break;
-
-                default:
-                    os_log_info(log, "%{public}s", msg_cstr);
-                    break;
+            // Idle: a pending repeat count is written rather than held
+            // until the next different message
+            sleeping_.store(true, std::memory_order_release);
+            const long timedOut = dispatch_semaphore_wait(
+                wake_, dispatch_time(DISPATCH_TIME_NOW, 250 * NSEC_PER_MSEC));
+            sleeping_.store(false, std::memory_order_release);
+            if (timedOut) {
+                writeRepeats();
             }
         }
     }
 
-    template<typename T>
-    ofLogStreamImpl& operator<<(const T& value) {
-        stream_ << value;
-        return *this;
+    void write(const LogRecord& record) {
+        repeats_.write(record, emitLog);
+    }
+
+    void writeRepeats() {
+        repeats_.writeRepeats(emitLog);
+    }
+
+    void reportDrops() {
+        const uint64_t drops = drops_.load(std::memory_order_relaxed);
+        if (drops == reportedDrops_) {
+            return;
+        }
+        writeRepeats();
+        std::string note = "ofLog: " + std::to_string(drops - reportedDrops_) +
+                           " messages dropped (log queue full)";
+        emitLog(OF_LOG_WARNING, "", note.c_str());
+        reportedDrops_ = drops;
+    }
+
+    LogQueue queue_;
+    dispatch_semaphore_t wake_;
+    std::atomic<bool> sleeping_{false};
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> drops_{0};
+
+    // Writer thread only
+    LogRepeatFilter repeats_;
+    uint64_t reportedDrops_ = 0;
+};
+
+} // namespace
+
+void ofLogSubmit(ofLogLevel level, const char* module, const char* message, uint32_t suppressed) {
+    if (!ofLogEnabled(level) || !message) {
+        return;
+    }
+
+    std::string noted;
+    if (suppressed > 0) {
+        noted = std::string(message) + " (" + std::to_string(suppressed) + " similar messages suppressed)";
+        message = noted.c_str();
+    }
+    const size_t length = std::strlen(message);
+    if (length == 0) {
+        return;
+    }
+    ofFlightRecorder::recordLog(level, module, message);
+
+    // Fatal errors are written before abort(); so are messages too long
+    // for a queue slot, after the ones already queued
+    if (level == OF_LOG_FATAL_ERROR) {
+        ofLogFlush();
+        emitLog(level, module, message);
+        std::abort();
+    }
+    if (!g_logAsync.load(std::memory_order_relaxed) || length >= kLogTextSize) {
+        ofLogFlush();
+        emitLog(level, module, message);
+        return;
+    }
+    LogWriter::instance().submit(level, module, message, length);
+}
+
+void ofLogFlush() {
+    LogWriter::instance().flush();
+}
+
+uint64_t ofGetLogDropCount() {
+    return LogWriter::instance().getDrops();
+}
+
+void ofSetLogAsync(bool async) {
+    if (!async) {
+        ofLogFlush();
+    }
+    g_logAsync.store(async, std::memory_order_relaxed);
+}
+
+bool ofLogEnabled(ofLogLevel level) {
+    return level < OF_LOG_SILENT && (int)level >= g_currentLogLevel.load(std::memory_order_relaxed);
+}
+
+// ============================================================================
+// Rate limiting
+// ============================================================================
+
+bool ofLogRateLimiter::allow(uint32_t& suppressed) {
+    suppressed = 0;
+    if (passed_.load(std::memory_order_relaxed) < kBurst) {
+        if (passed_.fetch_add(1, std::memory_order_relaxed) < kBurst) {
+            return true;
+        }
+    }
+
+    const uint64_t now = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    uint64_t next = nextAllowed_.load(std::memory_order_relaxed);
+    if (now >= next &&
+        nextAllowed_.compare_exchange_strong(next, now + 1000000000ull, std::memory_order_relaxed)) {
+        suppressed = held_.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+    held_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+// Internal implementation class: the message being streamed, handed to
+// the writer when the statement ends
+class ofLogStreamImpl {
+public:
+    ofLogStreamImpl(ofLogLevel level, const char* module)
+        : level_(level), module_(module) {}
+
+    ~ofLogStreamImpl() {
+        ofLogSubmit(level_, module_, stream_.str().c_str());
     }
 
     // String stream getter for ofLogStream wrapper
@@ -86,8 +276,9 @@ private:
 };
 
 // ofLogStream implementation - wraps ofLogStreamImpl
+// Nothing is allocated or formatted for filtered levels
 ofLogStream::ofLogStream(ofLogLevel level, const char* module)
-    : impl_(new ofLogStreamImpl(level, module)) {}
+    : impl_(ofLogEnabled(level) ? new ofLogStreamImpl(level, module) : nullptr) {}
 
 ofLogStream::~ofLogStream() {
     delete impl_;
@@ -98,67 +289,67 @@ std::ostringstream& ofLogStream::getStream() {
 }
 
 ofLogStream& ofLogStream::operator<<(const std::string& value) {
-    impl_->getStream() << value;
+    if (impl_) impl_->getStream() << value;
     return *this;
 }
 
 ofLogStream& ofLogStream::operator<<(const char* value) {
-    impl_->getStream() << value;
+    if (impl_) impl_->getStream() << value;
     return *this;
 }
 
 ofLogStream& ofLogStream::operator<<(int value) {
-    impl_->getStream() << value;
+    if (impl_) impl_->getStream() << value;
     return *this;
 }
 
 ofLogStream& ofLogStream::operator<<(unsigned int value) {
-    impl_->getStream() << value;
+    if (impl_) impl_->getStream() << value;
     return *this;
 }
 
 ofLogStream& ofLogStream::operator<<(long value) {
-    impl_->getStream() << value;
+    if (impl_) impl_->getStream() << value;
     return *this;
 }
 
 ofLogStream& ofLogStream::operator<<(unsigned long value) {
-    impl_->getStream() << value;
+    if (impl_) impl_->getStream() << value;
     return *this;
 }
 
 ofLogStream& ofLogStream::operator<<(long long value) {
-    impl_->getStream() << value;
+    if (impl_) impl_->getStream() << value;
     return *this;
 }
 
 ofLogStream& ofLogStream::operator<<(unsigned long long value) {
-    impl_->getStream() << value;
+    if (impl_) impl_->getStream() << value;
     return *this;
 }
 
 ofLogStream& ofLogStream::operator<<(float value) {
-    impl_->getStream() << value;
+    if (impl_) impl_->getStream() << value;
     return *this;
 }
 
 ofLogStream& ofLogStream::operator<<(double value) {
-    impl_->getStream() << value;
+    if (impl_) impl_->getStream() << value;
     return *this;
 }
 
 ofLogStream& ofLogStream::operator<<(bool value) {
-    impl_->getStream() << (value ? "true" : "false");
+    if (impl_) impl_->getStream() << (value ? "true" : "false");
     return *this;
 }
 
 // Global log level control
 void ofSetLogLevel(ofLogLevel level) {
-    g_currentLogLevel = level;
+    g_currentLogLevel.store(level, std::memory_order_relaxed);
 }
 
 ofLogLevel ofGetLogLevel() {
-    return g_currentLogLevel;
+    return static_cast<ofLogLevel>(g_currentLogLevel.load(std::memory_order_relaxed));
 }
 
 } // namespace oflike
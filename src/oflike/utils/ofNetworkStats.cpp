@@ -0,0 +1,191 @@
+#include "ofNetworkStats.h"
+#include "ofDebugStats.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace oflike {
+
+namespace {
+
+// Counts and byte sizes with order of magnitude suffixes
+std::string formatMagnitude(uint64_t value, const char* separator, const char* unit) {
+    char text[32];
+    const double v = static_cast<double>(value);
+    if (value >= 1000000000ull) {
+        std::snprintf(text, sizeof(text), "%.2f%sG%s", v * 1e-9, separator, unit);
+    } else if (value >= 1000000ull) {
+        std::snprintf(text, sizeof(text), "%.2f%sM%s", v * 1e-6, separator, unit);
+    } else if (value >= 1000ull) {
+        std::snprintf(text, sizeof(text), "%.1f%sK%s", v * 1e-3, separator, unit);
+    } else {
+        std::snprintf(text, sizeof(text), "%llu%s%s", static_cast<unsigned long long>(value), separator, unit);
+    }
+    return text;
+}
+
+std::string formatTraffic(uint64_t packets, uint64_t bytes) {
+    return formatMagnitude(packets, "", "") + " packets, " + formatMagnitude(bytes, " ", "B");
+}
+
+std::string formatLatency(const ofLatencyStats& stats) {
+    char text[64];
+    std::snprintf(text, sizeof(text), "%.2f / %.2f / %.2f ms",
+                  stats.p50 * 1e3, stats.p99 * 1e3, stats.max * 1e3);
+    return text;
+}
+
+} // namespace
+
+// ============================================================================
+// ofLatencyHistogram
+// ============================================================================
+
+void ofLatencyHistogram::add(double seconds) {
+    const uint64_t micros = seconds > 0.0 ? static_cast<uint64_t>(seconds * 1e6) : 0;
+    size_t bucket = 0;
+    for (uint64_t v = micros >> 1; v != 0 && bucket + 1 < kNumBuckets; v >>= 1) {
+        bucket++;
+    }
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sumMicros_.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t max = maxMicros_.load(std::memory_order_relaxed);
+    while (micros > max && !maxMicros_.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {
+    }
+}
+
+double ofLatencyHistogram::getBucketStart(size_t index) {
+    return index == 0 ? 0.0 : std::ldexp(1e-6, static_cast<int>(index));
+}
+
+double ofLatencyHistogram::getPercentile(double fraction) const {
+    uint64_t counts[kNumBuckets];
+    uint64_t total = 0;
+    for (size_t i = 0; i < kNumBuckets; i++) {
+        counts[i] = getBucket(i);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0.0;
+    }
+
+    const double rank = std::clamp(fraction, 0.0, 1.0) * static_cast<double>(total);
+    double below = 0.0;
+    for (size_t i = 0; i < kNumBuckets; i++) {
+        if (counts[i] == 0) {
+            continue;
+        }
+        if (below + static_cast<double>(counts[i]) >= rank || i + 1 == kNumBuckets) {
+            // The last bucket is open-ended: its end is the largest latency.
+            // Interpolating may pass it in any bucket, so it caps the result
+            const double max = static_cast<double>(maxMicros_.load(std::memory_order_relaxed)) * 1e-6;
+            const double start = getBucketStart(i);
+            const double end = i + 1 < kNumBuckets ? getBucketStart(i + 1) : std::max(start, max);
+            const double within = std::clamp((rank - below) / static_cast<double>(counts[i]), 0.0, 1.0);
+            return std::min(start + (end - start) * within, max);
+        }
+        below += static_cast<double>(counts[i]);
+    }
+    return 0.0;
+}
+
+ofLatencyStats ofLatencyHistogram::getStats() const {
+    ofLatencyStats stats;
+    stats.count = getCount();
+    if (stats.count == 0) {
+        return stats;
+    }
+    stats.mean = static_cast<double>(sumMicros_.load(std::memory_order_relaxed)) * 1e-6 /
+                 static_cast<double>(stats.count);
+    stats.max = static_cast<double>(maxMicros_.load(std::memory_order_relaxed)) * 1e-6;
+    stats.p50 = getPercentile(0.5);
+    stats.p99 = getPercentile(0.99);
+    return stats;
+}
+
+void ofLatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sumMicros_.store(0, std::memory_order_relaxed);
+    maxMicros_.store(0, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// ofNetworkCounters
+// ============================================================================
+
+ofNetworkCounters::~ofNetworkCounters() {
+    hide();
+}
+
+uint64_t ofNetworkCounters::timestamp() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void ofNetworkCounters::addQueueDepth(int64_t delta) {
+    const int64_t depth = queueDepth_.fetch_add(delta, std::memory_order_relaxed) + delta;
+    int64_t highWater = queueHighWater_.load(std::memory_order_relaxed);
+    while (depth > highWater &&
+           !queueHighWater_.compare_exchange_weak(highWater, depth, std::memory_order_relaxed)) {
+    }
+}
+
+ofNetworkStats ofNetworkCounters::getStats() const {
+    ofNetworkStats stats;
+    stats.packetsIn = packetsIn_.load(std::memory_order_relaxed);
+    stats.bytesIn = bytesIn_.load(std::memory_order_relaxed);
+    stats.packetsOut = packetsOut_.load(std::memory_order_relaxed);
+    stats.bytesOut = bytesOut_.load(std::memory_order_relaxed);
+    stats.drops = drops_.load(std::memory_order_relaxed);
+    // A reset while packets are queued can leave the depth briefly negative
+    stats.queueDepth = static_cast<size_t>(std::max<int64_t>(queueDepth_.load(std::memory_order_relaxed), 0));
+    stats.queueHighWater = static_cast<size_t>(queueHighWater_.load(std::memory_order_relaxed));
+    stats.latency = latency_.getStats();
+    stats.transit = transit_.getStats();
+    return stats;
+}
+
+void ofNetworkCounters::reset() {
+    packetsIn_.store(0, std::memory_order_relaxed);
+    bytesIn_.store(0, std::memory_order_relaxed);
+    packetsOut_.store(0, std::memory_order_relaxed);
+    bytesOut_.store(0, std::memory_order_relaxed);
+    drops_.store(0, std::memory_order_relaxed);
+    // The depth is what's queued now, not a count since the last reset
+    queueHighWater_.store(queueDepth_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    latency_.reset();
+    transit_.reset();
+}
+
+void ofNetworkCounters::show(const std::string& name) {
+    hide();
+    overlayId_ = ofDebugStats::addSource([this, name](std::vector<ofDebugStat>& rows) {
+        const ofNetworkStats stats = getStats();
+        rows.push_back({name, "In", formatTraffic(stats.packetsIn, stats.bytesIn)});
+        rows.push_back({name, "Out", formatTraffic(stats.packetsOut, stats.bytesOut)});
+        rows.push_back({name, "Drops", std::to_string(stats.drops)});
+        rows.push_back({name, "Queue", std::to_string(stats.queueDepth) + " (max " +
+                                           std::to_string(stats.queueHighWater) + ")"});
+        if (stats.latency.count > 0) {
+            rows.push_back({name, "Latency p50/p99/max", formatLatency(stats.latency)});
+        }
+        if (stats.transit.count > 0) {
+            rows.push_back({name, "Transit p50/p99/max", formatLatency(stats.transit)});
+        }
+    });
+}
+
+void ofNetworkCounters::hide() {
+    if (overlayId_ != 0) {
+        ofDebugStats::removeSource(overlayId_);
+        overlayId_ = 0;
+    }
+}
+
+} // namespace oflike
@@ -0,0 +1,137 @@
+#pragma once
+
+// oflike-metal ofNetworkStats - always-on traffic counters for network addons
+// Counted from receive threads and the main thread alike with relaxed atomics,
+// so they cost a few uncontended increments per packet
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace oflike {
+
+/// \brief Summary of a latency histogram, in seconds
+struct ofLatencyStats {
+    uint64_t count = 0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+/// \brief Lock-free histogram of latencies with power-of-two buckets
+/// \details Bucket i counts latencies of [2^i, 2^(i+1)) microseconds (the
+/// first also those under a microsecond, the last everything longer).
+/// Percentiles are interpolated within their bucket, capped at the largest
+/// latency.
+class ofLatencyHistogram {
+public:
+    static constexpr size_t kNumBuckets = 24;  // The last starts at about 8 s
+
+    ofLatencyHistogram() = default;
+    ofLatencyHistogram(const ofLatencyHistogram&) = delete;
+    ofLatencyHistogram& operator=(const ofLatencyHistogram&) = delete;
+
+    void add(double seconds);
+
+    uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t getBucket(size_t index) const { return buckets_[index].load(std::memory_order_relaxed); }
+
+    /// \brief Lower bound of a bucket in seconds
+    static double getBucketStart(size_t index);
+
+    /// \param fraction 0 to 1 (0.99 for the 99th percentile)
+    double getPercentile(double fraction) const;
+
+    ofLatencyStats getStats() const;
+
+    void reset();
+
+private:
+    std::atomic<uint64_t> buckets_[kNumBuckets] = {};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sumMicros_{0};
+    std::atomic<uint64_t> maxMicros_{0};
+};
+
+/// \brief Snapshot of a network endpoint's counters
+struct ofNetworkStats {
+    uint64_t packetsIn = 0;
+    uint64_t bytesIn = 0;
+    uint64_t packetsOut = 0;
+    uint64_t bytesOut = 0;
+    uint64_t drops = 0;            ///< Packets lost to full queues or buffers
+    size_t queueDepth = 0;         ///< Received packets (bytes on TCP) waiting to be dequeued
+    size_t queueHighWater = 0;     ///< Largest queueDepth seen
+    ofLatencyStats latency;        ///< Receive to dequeue
+    ofLatencyStats transit;        ///< Send to receive, from OSC time tags (count 0 without them)
+};
+
+/// \brief The counters behind ofNetworkStats, safe to update from any thread
+class ofNetworkCounters {
+public:
+    ofNetworkCounters() = default;
+    ~ofNetworkCounters();
+
+    ofNetworkCounters(const ofNetworkCounters&) = delete;
+    ofNetworkCounters& operator=(const ofNetworkCounters&) = delete;
+
+    /// \brief Current time in microseconds of a monotonic clock, for latencies
+    static uint64_t timestamp();
+
+    void addIn(size_t bytes) {
+        packetsIn_.fetch_add(1, std::memory_order_relaxed);
+        bytesIn_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void addOut(size_t bytes) {
+        packetsOut_.fetch_add(1, std::memory_order_relaxed);
+        bytesOut_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void addDrops(uint64_t count = 1) {
+        drops_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    /// \brief Add to (or, with a negative delta, take from) the queue depth
+    void addQueueDepth(int64_t delta);
+
+    /// \brief Record the latency of a packet received at timestamp()
+    void addLatencySince(uint64_t receivedAt) {
+        latency_.add(static_cast<double>(timestamp() - receivedAt) * 1e-6);
+    }
+
+    void addTransit(double seconds) { transit_.add(seconds); }
+
+    uint64_t getDrops() const { return drops_.load(std::memory_order_relaxed); }
+
+    const ofLatencyHistogram& getLatency() const { return latency_; }
+    const ofLatencyHistogram& getTransit() const { return transit_; }
+
+    ofNetworkStats getStats() const;
+
+    /// \brief Zero the counts and histograms; the queue depth is kept
+    void reset();
+
+    /// \brief Show the counters in the debug overlay, as a group of rows
+    /// \param name Group name (e.g. "UDP :9000"); replaces an earlier one
+    void show(const std::string& name);
+
+    /// \brief Remove the counters from the debug overlay
+    void hide();
+
+private:
+    std::atomic<uint64_t> packetsIn_{0};
+    std::atomic<uint64_t> bytesIn_{0};
+    std::atomic<uint64_t> packetsOut_{0};
+    std::atomic<uint64_t> bytesOut_{0};
+    std::atomic<uint64_t> drops_{0};
+    std::atomic<int64_t> queueDepth_{0};
+    std::atomic<int64_t> queueHighWater_{0};
+    ofLatencyHistogram latency_;
+    ofLatencyHistogram transit_;
+    int overlayId_ = 0;
+};
+
+} // namespace oflike
@@ -0,0 +1,164 @@
+#pragma once
+
+// oflike-metal ofProfiler - named scopes on the Instruments timeline and in-app
+// OF_PROFILE_SCOPE marks the rest of the enclosing block as an os_signpost
+// interval, shown by the Points of Interest instrument, so a trace lays out
+// where each frame's time goes. While ofProfiler is enabled the scopes are
+// also timed into per-thread ring buffers and summed per frame, for the
+// debug overlay's profiler table. Scopes nest and may run on any thread.
+// Builds defining OF_DISABLE_PROFILING (MinSizeRel, or CMake option
+// OFLIKE_ENABLE_PROFILING=OFF) compile them out.
+//
+// Usage:
+//   void ParticleSystem::update() {
+//       OF_PROFILE_SCOPE("Particles update");
+//       ...
+//   }
+//
+//   ofProfiler::setEnabled(true);             // Or the overlay's Scope Profiler toggle
+//   ofProfileFrame worst;
+//   ofProfiler::getWorstFrame(worst);         // Slowest of the last 120 frames
+//
+// Startup is timed separately: OF_STARTUP_SCOPE phases (context, renderer,
+// shader library, ofApp::setup...) are kept from process launch until the
+// first frame is presented, then logged as one timeline.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace oflike {
+
+/// \brief Signpost interval from construction to destruction
+/// \details Costs two flag checks while neither Instruments nor ofProfiler
+/// records. name must outlive the scope; string literals do.
+class ofProfileScope {
+public:
+    explicit ofProfileScope(const char* name);
+    ~ofProfileScope();
+
+    ofProfileScope(const ofProfileScope&) = delete;
+    ofProfileScope& operator=(const ofProfileScope&) = delete;
+
+private:
+    const char* name_;
+    uint64_t begin_;        // Recording start, 0 if not recorded in-app
+    bool active_;           // Signposted
+};
+
+/// \brief True while a tool (Instruments) records the scopes
+bool ofIsProfiling();
+
+/// \brief Time spent in one scope during a frame, summed over its calls
+struct ofProfileNode {
+    std::string name;
+    int depth = 0;          ///< Nesting below the thread's outermost scopes
+    double totalMs = 0.0;
+    uint32_t calls = 0;
+};
+
+/// \brief Scopes one thread finished during a frame
+struct ofProfileThread {
+    std::string name;
+    double totalMs = 0.0;               ///< Sum of the outermost scopes
+    std::vector<ofProfileNode> nodes;   ///< Depth-first: each scope before its children
+};
+
+/// \brief Scopes finished between two frame boundaries
+struct ofProfileFrame {
+    uint64_t frameNumber = 0;
+    double durationMs = 0.0;            ///< Wall time since the previous frame
+    std::vector<ofProfileThread> threads;
+};
+
+/// \brief One phase of startup
+struct ofStartupPhase {
+    std::string name;
+    int depth = 0;              ///< Nesting below the calling thread's outermost phases
+    double startMs = 0.0;       ///< Since process launch
+    double durationMs = 0.0;
+    bool mainThread = true;     ///< False for phases run in parallel on a worker
+};
+
+/// \brief Startup phase interval from construction to destruction
+/// \details Also a profile scope. Phases ending after markFirstFrame() are
+/// not recorded.
+class ofStartupScope {
+public:
+    explicit ofStartupScope(const char* name);
+    ~ofStartupScope();
+
+    ofStartupScope(const ofStartupScope&) = delete;
+    ofStartupScope& operator=(const ofStartupScope&) = delete;
+
+private:
+    ofProfileScope scope_;
+    const char* name_;
+    uint64_t begin_;
+    int depth_;
+};
+
+/// \brief In-app scope profiler fed by OF_PROFILE_SCOPE
+/// \details Disabled, a scope records nothing. Enabled, each thread writes
+/// its finished scopes into a ring buffer of its own without locking; the
+/// app loop gathers them once per frame (endFrame()) into a table of
+/// scopes per thread and keeps the last frames for the overlay. A thread
+/// that finishes more scopes in a frame than its buffer holds loses the
+/// oldest ones (getDroppedCount()). Scopes that span a frame boundary count
+/// in the frame they end in.
+class ofProfiler {
+public:
+    /// \brief Start or stop recording; stopping clears the history
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /// \brief Frames kept for getWorstFrame() (default 120)
+    static void setHistorySize(size_t frames);
+    static size_t getHistorySize();
+
+    /// \brief Close the current frame; called by the app loop before update()
+    static void endFrame();
+
+    /// \brief The last closed frame
+    /// \return false if no frame was recorded yet
+    static bool getLastFrame(ofProfileFrame& frame);
+
+    /// \brief The longest frame of the history
+    static bool getWorstFrame(ofProfileFrame& frame);
+
+    /// \brief Durations of the frames in the history, oldest first (ms)
+    static void getFrameDurations(std::vector<double>& durations);
+
+    /// \brief Scopes lost to full thread buffers since recording started
+    static uint64_t getDroppedCount();
+
+    /// \brief End the startup timeline and log it; called by the app loop
+    /// after the first frame. Later calls do nothing.
+    static void markFirstFrame();
+
+    /// \brief Startup phases in the order they began
+    static void getStartupTimeline(std::vector<ofStartupPhase>& phases);
+
+    /// \brief Time from process launch to the end of the first frame (ms),
+    /// 0 before markFirstFrame()
+    static double getTimeToFirstFrame();
+};
+
+} // namespace oflike
+
+#define OF_PROFILE_CONCAT_(a, b) a##b
+#define OF_PROFILE_CONCAT(a, b) OF_PROFILE_CONCAT_(a, b)
+
+/// Time the rest of the enclosing block as a startup phase; kept in builds
+/// without profiling, as startup runs once
+#define OF_STARTUP_SCOPE(name) \
+    ::oflike::ofStartupScope OF_PROFILE_CONCAT(ofStartupScope_, __LINE__)(name)
+
+#if defined(OF_DISABLE_PROFILING)
+#define OF_PROFILE_SCOPE(name) ((void)0)
+#else
+/// Profile the rest of the enclosing block as name
+#define OF_PROFILE_SCOPE(name) \
+    ::oflike::ofProfileScope OF_PROFILE_CONCAT(ofProfileScope_, __LINE__)(name)
+#endif
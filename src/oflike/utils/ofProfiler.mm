@@ -0,0 +1,482 @@
+#include "ofProfiler.h"
+#include "ofLog.h"
+#include <os/log.h>
+#include <os/signpost.h>
+#include <dispatch/dispatch.h>
+#include <mach/mach_time.h>
+#include <pthread.h>
+#include <sys/sysctl.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+namespace oflike {
+
+namespace {
+
+// Points of Interest is the category Instruments shows without configuration
+os_log_t profileLog() {
+    static os_log_t log = os_log_create("com.oflike.metal", OS_LOG_CATEGORY_POINTS_OF_INTEREST);
+    return log;
+}
+
+double ticksToMs(uint64_t ticks) {
+    static const double msPerTick = [] {
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info(&timebase);
+        return static_cast<double>(timebase.numer) / timebase.denom / 1.0e6;
+    }();
+    return static_cast<double>(ticks) * msPerTick;
+}
+
+std::atomic<bool> recording{false};
+
+// ============================================================================
+// Thread Buffers
+// ============================================================================
+
+struct ScopeEvent {
+    const char* name;
+    uint64_t begin;             // mach_absolute_time()
+    uint64_t end;
+    uint32_t depth;             // Scopes open around it on its thread
+};
+
+// Finished scopes of one thread. The thread appends and publishes head;
+// the collector reads behind it. A thread that laps the collector
+// overwrites the oldest events, which the collector detects and drops.
+struct ThreadBuffer {
+    static constexpr size_t kCapacity = 8192;   // Power of two
+
+    std::unique_ptr<ScopeEvent[]> events{new ScopeEvent[kCapacity]};
+    std::atomic<uint64_t> head{0};      // Events written (owner thread)
+    uint64_t tail = 0;                  // Events read (collector, under the state lock)
+    uint32_t depth = 0;                 // Recorded scopes open (owner thread)
+    std::string name;
+    std::atomic<bool> retired{false};   // Thread exited; removed once drained
+};
+
+struct ProfilerState {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> threads;
+    std::deque<ofProfileFrame> history;
+    size_t historySize = 120;
+    uint64_t frameNumber = 0;
+    uint64_t frameStart = 0;
+    uint64_t dropped = 0;
+    size_t unnamedThreads = 0;
+};
+
+// Leaked so that threads still running scopes during static destruction are safe
+ProfilerState& state() {
+    static ProfilerState* instance = new ProfilerState();
+    return *instance;
+}
+
+std::string currentThreadName(size_t index) {
+    if (pthread_main_np()) {
+        return "main";
+    }
+    char name[64] = {};
+    if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0 && name[0] != '\0') {
+        return name;
+    }
+    const char* queue = dispatch_queue_get_label(DISPATCH_CURRENT_QUEUE_LABEL);
+    if (queue && queue[0] != '\0') {
+        return queue;
+    }
+    return "thread " + std::to_string(index);
+}
+
+struct ThreadHandle {
+    std::shared_ptr<ThreadBuffer> buffer;
+
+    ~ThreadHandle() {
+        if (buffer) {
+            buffer->retired.store(true);
+        }
+    }
+};
+
+ThreadBuffer& threadBuffer() {
+    thread_local ThreadHandle handle;
+    if (!handle.buffer) {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        ProfilerState& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        buffer->name = currentThreadName(++s.unnamedThreads);
+        s.threads.push_back(buffer);
+        handle.buffer = std::move(buffer);
+    }
+    return *handle.buffer;
+}
+
+// Take the events a thread finished since the last call
+void drain(ThreadBuffer& buffer, std::vector<ScopeEvent>& events, uint64_t& dropped) {
+    const uint64_t head = buffer.head.load(std::memory_order_acquire);
+    uint64_t start = buffer.tail;
+    if (head - start > ThreadBuffer::kCapacity) {
+        dropped += head - start - ThreadBuffer::kCapacity;
+        start = head - ThreadBuffer::kCapacity;
+    }
+    events.clear();
+    for (uint64_t i = start; i < head; ++i) {
+        events.push_back(buffer.events[i & (ThreadBuffer::kCapacity - 1)]);
+    }
+
+    // Slots the thread reused while they were copied hold newer events
+    const uint64_t after = buffer.head.load(std::memory_order_acquire);
+    if (after > ThreadBuffer::kCapacity && after - ThreadBuffer::kCapacity > start) {
+        const size_t lost = static_cast<size_t>(
+            std::min<uint64_t>(after - ThreadBuffer::kCapacity - start, events.size()));
+        events.erase(events.begin(), events.begin() + lost);
+        dropped += lost;
+    }
+    buffer.tail = head;
+}
+
+// ============================================================================
+// Frame Aggregation
+// ============================================================================
+
+// Sum a thread's events into one node per call path, depth-first
+ofProfileThread aggregate(const std::string& name, std::vector<ScopeEvent>& events) {
+    struct Node {
+        const char* name;
+        double totalMs = 0.0;
+        uint32_t calls = 0;
+        std::vector<size_t> children;
+    };
+    std::vector<Node> nodes;
+    std::vector<size_t> roots;
+
+    // Parents begin before their children; events are stored as they end
+    std::sort(events.begin(), events.end(), [](const ScopeEvent& a, const ScopeEvent& b) {
+        return a.begin != b.begin ? a.begin < b.begin : a.depth < b.depth;
+    });
+
+    std::vector<std::pair<uint32_t, size_t>> open;    // (depth, node) of enclosing scopes
+    for (const ScopeEvent& event : events) {
+        while (!open.empty() && open.back().first >= event.depth) {
+            open.pop_back();
+        }
+        // Scopes whose parent ends in a later frame become roots
+        std::vector<size_t>& siblings = open.empty() ? roots : nodes[open.back().second].children;
+        size_t index = nodes.size();
+        for (size_t sibling : siblings) {
+            if (std::strcmp(nodes[sibling].name, event.name) == 0) {
+                index = sibling;
+                break;
+            }
+        }
+        if (index == nodes.size()) {
+            siblings.push_back(index);
+            nodes.push_back(Node{event.name, 0.0, 0, {}});
+        }
+        nodes[index].totalMs += ticksToMs(event.end - event.begin);
+        nodes[index].calls += 1;
+        open.emplace_back(event.depth, index);
+    }
+
+    ofProfileThread thread;
+    thread.name = name;
+    std::vector<std::pair<size_t, int>> pending;      // (node, depth), depth-first
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it) {
+        pending.emplace_back(*it, 0);
+        thread.totalMs += nodes[*it].totalMs;
+    }
+    while (!pending.empty()) {
+        const auto [index, depth] = pending.back();
+        pending.pop_back();
+        const Node& node = nodes[index];
+        thread.nodes.push_back(ofProfileNode{node.name, depth, node.totalMs, node.calls});
+        for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) {
+            pending.emplace_back(*it, depth + 1);
+        }
+    }
+    return thread;
+}
+
+// Forget events recorded so far (under the state lock)
+void discardPending(ProfilerState& s) {
+    for (const auto& buffer : s.threads) {
+        buffer->tail = buffer->head.load(std::memory_order_acquire);
+    }
+}
+
+// ============================================================================
+// Startup Timeline
+// ============================================================================
+
+struct StartupState {
+    std::mutex mutex;
+    bool open = true;               // Until markFirstFrame()
+    std::vector<ofStartupPhase> phases;
+    double timeToFirstFrame = 0.0;
+};
+
+StartupState& startupState() {
+    static StartupState* instance = new StartupState();
+    return *instance;
+}
+
+std::atomic<bool> startupOpen{true};
+thread_local int startupDepth = 0;
+
+// Process launch on the mach_absolute_time() clock (ms): the kernel records
+// the start as wall time, so its distance from now is carried over. Without
+// it the timeline starts at the first phase.
+double launchMs() {
+    static const double launch = [] {
+        const double now = ticksToMs(mach_absolute_time());
+        int mib[4] = {CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid()};
+        struct kinfo_proc info;
+        size_t size = sizeof(info);
+        struct timeval wall;
+        if (sysctl(mib, 4, &info, &size, nullptr, 0) != 0 || gettimeofday(&wall, nullptr) != 0) {
+            return now;
+        }
+        const struct timeval& start = info.kp_proc.p_starttime;
+        const double sinceLaunch = (wall.tv_sec - start.tv_sec) * 1000.0 +
+                                   (wall.tv_usec - start.tv_usec) / 1000.0;
+        return now - std::max(sinceLaunch, 0.0);
+    }();
+    return launch;
+}
+
+void logStartup(double total, const std::vector<ofStartupPhase>& phases) {
+    ofLogNotice("ofStartup") << std::fixed << std::setprecision(1)
+                             << "First frame " << total << " ms after launch";
+    for (const ofStartupPhase& phase : phases) {
+        ofLogNotice("ofStartup") << std::fixed << std::setprecision(1)
+                                 << std::string(static_cast<size_t>(phase.depth) * 2, ' ')
+                                 << phase.name << ": " << phase.durationMs << " ms (at "
+                                 << phase.startMs << (phase.mainThread ? ")" : ", worker)");
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// ofProfileScope
+// ============================================================================
+
+// Every interval is named "Scope" (signpost names must be literals) and
+// labelled with the scope's name; its address tells nested and concurrent
+// intervals apart
+
+ofProfileScope::ofProfileScope(const char* name)
+    : name_(name)
+    , begin_(0)
+    , active_(os_signpost_enabled(profileLog())) {
+    if (active_) {
+        os_log_t log = profileLog();
+        os_signpost_interval_begin(log, os_signpost_id_make_with_pointer(log, this),
+                                   "Scope", "%{public}s", name_);
+    }
+    if (recording.load(std::memory_order_relaxed)) {
+        ++threadBuffer().depth;
+        begin_ = mach_absolute_time();
+    }
+}
+
+ofProfileScope::~ofProfileScope() {
+    if (begin_ != 0) {
+        const uint64_t end = mach_absolute_time();
+        ThreadBuffer& buffer = threadBuffer();
+        --buffer.depth;
+        const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+        buffer.events[head & (ThreadBuffer::kCapacity - 1)] = ScopeEvent{name_, begin_, end, buffer.depth};
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+    if (active_) {
+        os_log_t log = profileLog();
+        os_signpost_interval_end(log, os_signpost_id_make_with_pointer(log, this),
+                                 "Scope", "%{public}s", name_);
+    }
+}
+
+// ============================================================================
+// ofStartupScope
+// ============================================================================
+
+ofStartupScope::ofStartupScope(const char* name)
+    : scope_(name)
+    , name_(name)
+    , begin_(0)
+    , depth_(0) {
+    if (startupOpen.load(std::memory_order_relaxed)) {
+        launchMs();
+        depth_ = startupDepth++;
+        begin_ = mach_absolute_time();
+    }
+}
+
+ofStartupScope::~ofStartupScope() {
+    if (begin_ == 0) {
+        return;
+    }
+    const uint64_t end = mach_absolute_time();
+    --startupDepth;
+
+    StartupState& s = startupState();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (s.open) {
+        s.phases.push_back(ofStartupPhase{name_, depth_, ticksToMs(begin_) - launchMs(),
+                                          ticksToMs(end - begin_), pthread_main_np() != 0});
+    }
+}
+
+bool ofIsProfiling() {
+    return os_signpost_enabled(profileLog());
+}
+
+// ============================================================================
+// ofProfiler
+// ============================================================================
+
+void ofProfiler::setEnabled(bool enabled) {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (enabled == recording.load()) {
+        return;
+    }
+    discardPending(s);
+    s.history.clear();
+    s.dropped = 0;
+    s.frameStart = mach_absolute_time();
+    recording.store(enabled);
+}
+
+bool ofProfiler::isEnabled() {
+    return recording.load(std::memory_order_relaxed);
+}
+
+void ofProfiler::setHistorySize(size_t frames) {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.historySize = std::max<size_t>(frames, 1);
+    while (s.history.size() > s.historySize) {
+        s.history.pop_front();
+    }
+}
+
+size_t ofProfiler::getHistorySize() {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.historySize;
+}
+
+void ofProfiler::endFrame() {
+    if (!recording.load(std::memory_order_relaxed)) {
+        return;
+    }
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    const uint64_t now = mach_absolute_time();
+    ofProfileFrame frame;
+    frame.frameNumber = ++s.frameNumber;
+    frame.durationMs = ticksToMs(now - s.frameStart);
+    s.frameStart = now;
+
+    std::vector<ScopeEvent> events;
+    for (auto it = s.threads.begin(); it != s.threads.end();) {
+        ThreadBuffer& buffer = **it;
+        const bool retired = buffer.retired.load();     // Before draining: no events follow
+        drain(buffer, events, s.dropped);
+        if (!events.empty()) {
+            frame.threads.push_back(aggregate(buffer.name, events));
+        }
+        it = retired ? s.threads.erase(it) : it + 1;
+    }
+
+    s.history.push_back(std::move(frame));
+    while (s.history.size() > s.historySize) {
+        s.history.pop_front();
+    }
+}
+
+bool ofProfiler::getLastFrame(ofProfileFrame& frame) {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (s.history.empty()) {
+        return false;
+    }
+    frame = s.history.back();
+    return true;
+}
+
+bool ofProfiler::getWorstFrame(ofProfileFrame& frame) {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (s.history.empty()) {
+        return false;
+    }
+    auto worst = std::max_element(s.history.begin(), s.history.end(),
+                                  [](const ofProfileFrame& a, const ofProfileFrame& b) {
+                                      return a.durationMs < b.durationMs;
+                                  });
+    frame = *worst;
+    return true;
+}
+
+void ofProfiler::getFrameDurations(std::vector<double>& durations) {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    durations.clear();
+    durations.reserve(s.history.size());
+    for (const ofProfileFrame& frame : s.history) {
+        durations.push_back(frame.durationMs);
+    }
+}
+
+uint64_t ofProfiler::getDroppedCount() {
+    ProfilerState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.dropped;
+}
+
+void ofProfiler::markFirstFrame() {
+    if (!startupOpen.exchange(false)) {
+        return;
+    }
+
+    StartupState& s = startupState();
+    std::vector<ofStartupPhase> phases;
+    double total;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.open = false;
+        s.timeToFirstFrame = ticksToMs(mach_absolute_time()) - launchMs();
+        total = s.timeToFirstFrame;
+    }
+    getStartupTimeline(phases);
+    logStartup(total, phases);
+}
+
+void ofProfiler::getStartupTimeline(std::vector<ofStartupPhase>& phases) {
+    StartupState& s = startupState();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        phases = s.phases;
+    }
+    // Recorded as they end, so children come before their parents
+    std::stable_sort(phases.begin(), phases.end(), [](const ofStartupPhase& a, const ofStartupPhase& b) {
+        return a.startMs < b.startMs;
+    });
+}
+
+double ofProfiler::getTimeToFirstFrame() {
+    StartupState& s = startupState();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.timeToFirstFrame;
+}
+
+} // namespace oflike
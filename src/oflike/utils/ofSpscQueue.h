@@ -0,0 +1,97 @@
+#pragma once
+
+// oflike-metal ofSpscQueue - lock-free slot queue between two threads
+// Used to hand network input from receive threads to update() without locks
+// or per-message allocation
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace oflike {
+
+/// \brief Bounded single-producer, single-consumer queue of reusable slots
+/// \details Slots are allocated once and filled in place. The producer fills
+/// the slot returned by beginWrite() and publishes it with commitWrite(); the
+/// consumer takes slots in order with read(). Slots the consumer has read
+/// stay untouched until it calls release(), so it can hand out pointers into
+/// them until its next batch. One thread may produce and one consume.
+template <typename T>
+class ofSpscQueue {
+public:
+    // ========================================================================
+    // Allocation (while neither side is running)
+    // ========================================================================
+
+    /// \brief Allocate slots, rounded up to a power of two; empties the queue
+    void allocate(size_t capacity) {
+        size_t count = 1;
+        while (count < capacity) {
+            count <<= 1;
+        }
+        slots_.assign(count, T{});
+        mask_ = count - 1;
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+        read_ = 0;
+    }
+
+    /// \brief Number of slots; 0 before allocate()
+    size_t capacity() const { return slots_.size(); }
+
+    /// \brief Slot by index, to set slots up after allocate()
+    T& slot(size_t index) { return slots_[index]; }
+
+    // ========================================================================
+    // Producer
+    // ========================================================================
+
+    /// \brief Next free slot to fill, or nullptr if every slot is in use
+    T* beginWrite() {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        if (slots_.empty() || head - tail_.load(std::memory_order_acquire) > mask_) {
+            return nullptr;
+        }
+        return &slots_[head & mask_];
+    }
+
+    /// \brief Publish the slot returned by beginWrite()
+    void commitWrite() {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // ========================================================================
+    // Consumer
+    // ========================================================================
+
+    /// \brief Next published slot, or nullptr if none is waiting
+    /// \details The slot stays valid until release().
+    const T* read() {
+        if (read_ == head_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &slots_[read_++ & mask_];
+    }
+
+    /// \brief Hand the slots read so far back to the producer
+    void release() {
+        tail_.store(read_, std::memory_order_release);
+    }
+
+    /// \brief Number of published slots not read yet
+    size_t size() const {
+        return static_cast<size_t>(head_.load(std::memory_order_acquire) - read_);
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    std::vector<T> slots_;
+    uint64_t mask_ = 0;
+    alignas(64) std::atomic<uint64_t> head_{0};  // Written by the producer
+    alignas(64) std::atomic<uint64_t> tail_{0};  // Written by the consumer
+    alignas(64) uint64_t read_ = 0;              // Consumer only
+};
+
+} // namespace oflike
@@ -0,0 +1,353 @@
+#include "ofTelemetry.h"
+#include "ofGpuMemory.h"
+#include "../../core/Context.h"
+#include "../../render/IRenderer.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <unistd.h>
+
+namespace oflike {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::atomic<bool> collecting{false};
+
+struct TelemetryState {
+    // Main thread
+    float interval = 1.0f;
+    std::string prefix;
+    ofTelemetry::Exporter exporter;
+    std::vector<std::pair<int, ofTelemetry::Source>> sources;
+    int nextSourceId = 1;
+    uint64_t sequence = 0;
+
+    // Current interval, fed by endFrame()
+    Clock::time_point intervalStart;
+    Clock::time_point lastFrame;
+    bool frameStarted = false;
+    std::vector<float> frameMs;         // Cleared, not freed, between intervals
+    uint32_t frames = 0;
+    uint64_t drawCalls = 0;
+    uint32_t maxDrawCalls = 0;
+    uint64_t vertices = 0;
+    uint32_t maxVertices = 0;
+    double gpuMs = 0.0;
+    double maxGpuMs = 0.0;
+    uint32_t gpuFrames = 0;
+
+    // Any thread registers timers
+    std::mutex timerMutex;
+    std::vector<ofTelemetryTimer*> timers;
+};
+
+// Leaked so that timers destroyed during static destruction are safe
+TelemetryState& state() {
+    static TelemetryState* instance = new TelemetryState();
+    return *instance;
+}
+
+// Host name with the dots metric paths use as separators replaced
+std::string defaultPrefix() {
+    char host[256] = {};
+    if (::gethostname(host, sizeof(host) - 1) != 0 || host[0] == '\0') {
+        return "oflike";
+    }
+    std::string prefix = host;
+    std::replace(prefix.begin(), prefix.end(), '.', '_');
+    return prefix;
+}
+
+// "Render Targets" -> "render_targets"
+std::string metricName(const char* label) {
+    std::string name;
+    for (const char* c = label; *c; ++c) {
+        name.push_back(*c == ' ' ? '_' : static_cast<char>(std::tolower(static_cast<unsigned char>(*c))));
+    }
+    return name;
+}
+
+void appendLatency(std::vector<ofTelemetryMetric>& metrics, const std::string& name,
+                   const ofLatencyHistogram& histogram) {
+    const ofLatencyStats stats = histogram.getStats();
+    metrics.push_back({name + ".count", static_cast<double>(stats.count), ofTelemetryKind::Counter});
+    metrics.push_back({name + ".ms.p50", stats.p50 * 1e3});
+    metrics.push_back({name + ".ms.p99", stats.p99 * 1e3});
+    metrics.push_back({name + ".ms.max", stats.max * 1e3});
+}
+
+// Nearest-rank percentile of the frame times; reorders them
+float percentile(std::vector<float>& values, double fraction) {
+    const size_t rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(values.size())));
+    const size_t index = std::min(rank > 0 ? rank - 1 : 0, values.size() - 1);
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return values[index];
+}
+
+void resetInterval(TelemetryState& s, Clock::time_point now) {
+    s.intervalStart = now;
+    s.frameMs.clear();
+    s.frames = 0;
+    s.drawCalls = 0;
+    s.maxDrawCalls = 0;
+    s.vertices = 0;
+    s.maxVertices = 0;
+    s.gpuMs = 0.0;
+    s.maxGpuMs = 0.0;
+    s.gpuFrames = 0;
+}
+
+void exportBatch(TelemetryState& s, Clock::time_point now) {
+    ofTelemetryBatch batch;
+    batch.prefix = s.prefix.empty() ? defaultPrefix() : s.prefix;
+    batch.sequence = ++s.sequence;
+    batch.seconds = std::chrono::duration<double>(now - s.intervalStart).count();
+    std::vector<ofTelemetryMetric>& metrics = batch.metrics;
+
+    // Frames; exact percentiles, as power-of-two buckets would put every
+    // frame of a steady 60 fps in one 16-33 ms bucket
+    const size_t frameCount = s.frameMs.size();
+    metrics.push_back({"frame.count", static_cast<double>(frameCount), ofTelemetryKind::Counter});
+    if (frameCount > 0) {
+        metrics.push_back({"frame.fps", batch.seconds > 0.0 ? frameCount / batch.seconds : 0.0});
+        metrics.push_back({"frame.ms.p50", percentile(s.frameMs, 0.5)});
+        metrics.push_back({"frame.ms.p95", percentile(s.frameMs, 0.95)});
+        metrics.push_back({"frame.ms.p99", percentile(s.frameMs, 0.99)});
+        metrics.push_back({"frame.ms.max", *std::max_element(s.frameMs.begin(), s.frameMs.end())});
+    }
+    if (s.gpuFrames > 0) {
+        metrics.push_back({"gpu.ms.mean", s.gpuMs / s.gpuFrames});
+        metrics.push_back({"gpu.ms.max", s.maxGpuMs});
+    }
+    if (s.frames > 0) {
+        metrics.push_back({"draw_calls.mean", static_cast<double>(s.drawCalls) / s.frames});
+        metrics.push_back({"draw_calls.max", static_cast<double>(s.maxDrawCalls)});
+        metrics.push_back({"vertices.mean", static_cast<double>(s.vertices) / s.frames});
+        metrics.push_back({"vertices.max", static_cast<double>(s.maxVertices)});
+    }
+
+    // GPU memory
+    std::vector<ofGpuMemoryUsage> usage;
+    ofGpuMemory::getUsage(usage);
+    for (const ofGpuMemoryUsage& category : usage) {
+        metrics.push_back({"gpu.memory." + metricName(ofGpuMemoryCategoryName(category.category)),
+                           static_cast<double>(category.bytes)});
+    }
+    const uint64_t device = ofGpuMemory::getDeviceAllocatedBytes();
+    if (device > 0) {
+        metrics.push_back({"gpu.memory.device", static_cast<double>(device)});
+    }
+
+    // Timers; a sample added while its histogram is read may land in either interval
+    {
+        std::lock_guard<std::mutex> lock(s.timerMutex);
+        for (ofTelemetryTimer* timer : s.timers) {
+            if (timer->getHistogram().getCount() > 0) {
+                appendLatency(metrics, timer->getName(), timer->getHistogram());
+                timer->reset();
+            }
+        }
+    }
+
+    for (const auto& source : s.sources) {
+        source.second(metrics);
+    }
+
+    resetInterval(s, now);
+    if (s.exporter) {
+        s.exporter(batch);
+    }
+}
+
+void appendNumber(std::string& line, double value) {
+    char text[32];
+    // Whole numbers (counts, bytes) without a fraction
+    if (value == static_cast<double>(static_cast<int64_t>(value))) {
+        std::snprintf(text, sizeof(text), "%lld", static_cast<long long>(value));
+    } else {
+        std::snprintf(text, sizeof(text), "%.3f", value);
+    }
+    line += text;
+}
+
+} // namespace
+
+// ============================================================================
+// ofTelemetryTimer
+// ============================================================================
+
+ofTelemetryTimer::ofTelemetryTimer(const std::string& name)
+    : name_(name) {
+    TelemetryState& s = state();
+    std::lock_guard<std::mutex> lock(s.timerMutex);
+    s.timers.push_back(this);
+}
+
+ofTelemetryTimer::~ofTelemetryTimer() {
+    TelemetryState& s = state();
+    std::lock_guard<std::mutex> lock(s.timerMutex);
+    s.timers.erase(std::remove(s.timers.begin(), s.timers.end(), this), s.timers.end());
+}
+
+void ofTelemetryTimer::add(double seconds) {
+    if (collecting.load(std::memory_order_relaxed)) {
+        histogram_.add(seconds);
+    }
+}
+
+// ============================================================================
+// ofTelemetry
+// ============================================================================
+
+void ofTelemetry::setEnabled(bool enabled) {
+    if (enabled == collecting.load()) {
+        return;
+    }
+    TelemetryState& s = state();
+    if (enabled) {
+        resetInterval(s, Clock::now());
+        s.frameStarted = false;
+        std::lock_guard<std::mutex> lock(s.timerMutex);
+        for (ofTelemetryTimer* timer : s.timers) {
+            timer->reset();
+        }
+    }
+    collecting.store(enabled);
+}
+
+bool ofTelemetry::isEnabled() {
+    return collecting.load(std::memory_order_relaxed);
+}
+
+void ofTelemetry::setInterval(float seconds) {
+    state().interval = std::max(seconds, 0.01f);
+}
+
+float ofTelemetry::getInterval() {
+    return state().interval;
+}
+
+void ofTelemetry::setPrefix(const std::string& prefix) {
+    state().prefix = prefix;
+}
+
+std::string ofTelemetry::getPrefix() {
+    const TelemetryState& s = state();
+    return s.prefix.empty() ? defaultPrefix() : s.prefix;
+}
+
+void ofTelemetry::setExporter(Exporter exporter) {
+    state().exporter = std::move(exporter);
+}
+
+int ofTelemetry::addSource(Source source) {
+    TelemetryState& s = state();
+    const int id = s.nextSourceId++;
+    s.sources.emplace_back(id, std::move(source));
+    return id;
+}
+
+void ofTelemetry::removeSource(int id) {
+    auto& sources = state().sources;
+    sources.erase(std::remove_if(sources.begin(), sources.end(),
+                                 [id](const auto& source) { return source.first == id; }),
+                  sources.end());
+}
+
+void ofTelemetry::endFrame() {
+    if (!collecting.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    TelemetryState& s = state();
+    const Clock::time_point now = Clock::now();
+    if (s.frameStarted) {
+        s.frameMs.push_back(std::chrono::duration<float, std::milli>(now - s.lastFrame).count());
+    }
+    s.lastFrame = now;
+    s.frameStarted = true;
+
+    // The renderer's figures describe the frame that just ended
+    if (render::IRenderer* renderer = Context::instance().renderer()) {
+        uint32_t drawCalls = 0;
+        uint32_t vertices = 0;
+        renderer->getStatistics(drawCalls, vertices);
+        ++s.frames;
+        s.drawCalls += drawCalls;
+        s.maxDrawCalls = std::max(s.maxDrawCalls, drawCalls);
+        s.vertices += vertices;
+        s.maxVertices = std::max(s.maxVertices, vertices);
+
+        const double gpuMs = renderer->getLastGPUTime();
+        if (gpuMs > 0.0) {
+            ++s.gpuFrames;
+            s.gpuMs += gpuMs;
+            s.maxGpuMs = std::max(s.maxGpuMs, gpuMs);
+        }
+    }
+
+    if (now - s.intervalStart >= std::chrono::duration<float>(s.interval)) {
+        exportBatch(s, now);
+    }
+}
+
+void ofTelemetry::flush() {
+    if (collecting.load(std::memory_order_relaxed)) {
+        exportBatch(state(), Clock::now());
+    }
+}
+
+void ofTelemetry::appendNetworkStats(std::vector<ofTelemetryMetric>& metrics, const std::string& name,
+                                     const ofNetworkStats& stats) {
+    // Traffic as totals since setup; collectors derive rates
+    metrics.push_back({name + ".queue", static_cast<double>(stats.queueDepth)});
+    metrics.push_back({name + ".queue.max", static_cast<double>(stats.queueHighWater)});
+    metrics.push_back({name + ".drops", static_cast<double>(stats.drops)});
+    metrics.push_back({name + ".packets_in", static_cast<double>(stats.packetsIn)});
+    metrics.push_back({name + ".bytes_in", static_cast<double>(stats.bytesIn)});
+    metrics.push_back({name + ".packets_out", static_cast<double>(stats.packetsOut)});
+    metrics.push_back({name + ".bytes_out", static_cast<double>(stats.bytesOut)});
+    if (stats.latency.count > 0) {
+        metrics.push_back({name + ".latency.ms.p50", stats.latency.p50 * 1e3});
+        metrics.push_back({name + ".latency.ms.p99", stats.latency.p99 * 1e3});
+    }
+}
+
+void ofTelemetry::formatStatsd(const ofTelemetryBatch& batch, std::vector<std::string>& packets,
+                               size_t maxPacketSize) {
+    packets.clear();
+    std::string packet;
+    std::string line;
+    for (const ofTelemetryMetric& metric : batch.metrics) {
+        line.clear();
+        if (!batch.prefix.empty()) {
+            line += batch.prefix;
+            line += '.';
+        }
+        line += metric.name;
+        line += ':';
+        appendNumber(line, metric.value);
+        line += metric.kind == ofTelemetryKind::Counter ? "|c" : "|g";
+
+        // A line longer than a packet goes alone
+        if (!packet.empty() && packet.size() + 1 + line.size() > maxPacketSize) {
+            packets.push_back(std::move(packet));
+            packet.clear();
+        }
+        if (!packet.empty()) {
+            packet += '\n';
+        }
+        packet += line;
+    }
+    if (!packet.empty()) {
+        packets.push_back(std::move(packet));
+    }
+}
+
+} // namespace oflike
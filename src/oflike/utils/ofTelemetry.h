@@ -0,0 +1,132 @@
+#pragma once
+
+// oflike-metal ofTelemetry - periodic metric batches for central monitoring
+// While enabled, the app loop feeds frame times, GPU time and draw counts
+// into the current interval; at its end (every second by default) they are
+// summarized with GPU memory per category, the timers (ML inference...) and
+// any sources the app added into one batch, which goes to the exporter.
+// ofxOscSendTelemetry() (ofxOsc) and ofxUdpSendTelemetry() (ofxNetwork, as
+// statsd lines) send batches to a collector. Disabled, the app loop's call
+// and every timer cost one flag check.
+//
+// Usage:
+//   ofxUdpManager udp;
+//   udp.connect("metrics.local", 8125);
+//   ofTelemetry::setExporter([&udp](const ofTelemetryBatch& batch) {
+//       ofxUdpSendTelemetry(udp, batch);
+//   });
+//   ofTelemetry::addSource([this](std::vector<ofTelemetryMetric>& metrics) {
+//       ofTelemetry::appendNetworkStats(metrics, "osc.in", receiver.getStats());
+//   });
+//   ofTelemetry::setEnabled(true);
+
+#include "ofNetworkStats.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace oflike {
+
+/// \brief How a collector should aggregate a metric
+enum class ofTelemetryKind {
+    Gauge,      ///< Value at the end of the interval (statsd "g")
+    Counter     ///< Events during the interval (statsd "c")
+};
+
+/// \brief One value of a batch
+struct ofTelemetryMetric {
+    std::string name;       ///< Dotted, e.g. "frame.ms.p99"
+    double value = 0.0;
+    ofTelemetryKind kind = ofTelemetryKind::Gauge;
+};
+
+/// \brief Metrics of one interval
+struct ofTelemetryBatch {
+    std::string prefix;         ///< Machine name, see ofTelemetry::setPrefix()
+    uint64_t sequence = 0;      ///< Counts batches from 1; gaps mean batches were lost
+    double seconds = 0.0;       ///< Length of the interval
+    std::vector<ofTelemetryMetric> metrics;
+};
+
+/// \brief Latency histogram reported with every batch
+/// \details add() is lock-free and may be called from any thread. A batch
+/// reports the count, p50, p99 and max in milliseconds as
+/// "<name>.count", "<name>.ms.p50"... and starts the next interval empty.
+/// Timers with no samples in an interval are left out.
+class ofTelemetryTimer {
+public:
+    explicit ofTelemetryTimer(const std::string& name);
+    ~ofTelemetryTimer();
+
+    ofTelemetryTimer(const ofTelemetryTimer&) = delete;
+    ofTelemetryTimer& operator=(const ofTelemetryTimer&) = delete;
+
+    /// \brief Record one duration; ignored while telemetry is disabled
+    void add(double seconds);
+
+    const std::string& getName() const { return name_; }
+
+    /// \brief Samples of the current interval
+    const ofLatencyHistogram& getHistogram() const { return histogram_; }
+
+    /// \brief Discard the current interval's samples (done by each batch)
+    void reset() { histogram_.reset(); }
+
+private:
+    std::string name_;
+    ofLatencyHistogram histogram_;
+};
+
+/// \brief Collects metrics and hands them out in batches
+/// \details Main thread only, except ofTelemetryTimer::add().
+class ofTelemetry {
+public:
+    using Exporter = std::function<void(const ofTelemetryBatch& batch)>;
+    using Source = std::function<void(std::vector<ofTelemetryMetric>& metrics)>;
+
+    /// \brief Start or stop collecting; starting begins a new interval
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /// \brief Seconds per batch (default 1)
+    static void setInterval(float seconds);
+    static float getInterval();
+
+    /// \brief Name the batches carry (default the host name, dots replaced)
+    static void setPrefix(const std::string& prefix);
+    static std::string getPrefix();
+
+    /// \brief Receiver of each batch, called on the main thread
+    static void setExporter(Exporter exporter);
+
+    /// \brief Add a source of metrics, asked for them once per batch
+    /// \return Id for removeSource()
+    static int addSource(Source source);
+
+    /// \brief Remove a source; ids not registered are ignored
+    static void removeSource(int id);
+
+    /// \brief Close the current frame; called by the app loop before update()
+    /// \details Exports a batch when the interval is over.
+    static void endFrame();
+
+    /// \brief Export the current interval now
+    static void flush();
+
+    /// \brief Append an endpoint's queue depth, traffic and latency
+    /// \param name Metric prefix, e.g. "osc.in"
+    static void appendNetworkStats(std::vector<ofTelemetryMetric>& metrics, const std::string& name,
+                                   const ofNetworkStats& stats);
+
+    /// \brief Format a batch as statsd lines ("<prefix>.<name>:<value>|g")
+    /// \param packets Receives the lines, newline-separated, in packets of
+    /// at most maxPacketSize bytes
+    /// \param maxPacketSize Bytes per packet (default 1432, which fits a
+    /// 1500-byte MTU with IPv6 and UDP headers)
+    static void formatStatsd(const ofTelemetryBatch& batch, std::vector<std::string>& packets,
+                             size_t maxPacketSize = 1432);
+};
+
+} // namespace oflike
@@ -24,6 +24,50 @@ void ofSetFrameRate(float targetRate) {
     ctx().setFrameRate(targetRate);
 }
 
+void ofSetFramePipelining(bool enabled) {
+    ctx().setPipelinedFrames(enabled);
+}
+
+bool ofGetFramePipelining() {
+    return ctx().isPipelinedFrames();
+}
+
+void ofSetFramePacing(ofFramePacing pacing) {
+    switch (pacing) {
+        case OF_FRAME_PACING_LOW_LATENCY:
+            ctx().setFramePacing(Context::FramePacing::LowLatency);
+            break;
+        case OF_FRAME_PACING_ADAPTIVE:
+            ctx().setFramePacing(Context::FramePacing::Adaptive);
+            break;
+        default:
+            ctx().setFramePacing(Context::FramePacing::Throughput);
+            break;
+    }
+}
+
+ofFramePacing ofGetFramePacing() {
+    switch (ctx().getFramePacing()) {
+        case Context::FramePacing::LowLatency: return OF_FRAME_PACING_LOW_LATENCY;
+        case Context::FramePacing::Adaptive: return OF_FRAME_PACING_ADAPTIVE;
+        default: return OF_FRAME_PACING_THROUGHPUT;
+    }
+}
+
+void ofSetFrameRateRange(float minFps, float maxFps) {
+    ctx().setFrameRateRange(minFps, maxFps);
+}
+
+ofFrameLatency ofGetFrameLatency() {
+    const Context::FrameLatency latency = ctx().getFrameLatency();
+    ofFrameLatency result;
+    result.lastMs = latency.lastMs;
+    result.averageMs = latency.averageMs;
+    result.maxMs = latency.maxMs;
+    result.framesMeasured = latency.framesMeasured;
+    return result;
+}
+
 // MARK: - Keyboard State Functions
 
 bool ofGetKeyPressed(int key) {
@@ -52,6 +96,18 @@ bool ofGetMousePressed(int button) {
     return EventDispatcher::instance().getMousePressed(button);
 }
 
+void ofSetMouseCoalescing(bool coalesce) {
+    EventDispatcher::instance().setCoalesceMotion(coalesce);
+}
+
+bool ofGetMouseCoalescing() {
+    return EventDispatcher::instance().getCoalesceMotion();
+}
+
+const std::vector<ofMouseSample>& ofGetMousePath() {
+    return EventDispatcher::instance().getMousePath();
+}
+
 // MARK: - Window Functions
 
 int ofGetWidth() {
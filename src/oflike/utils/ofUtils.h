@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -12,6 +13,8 @@
 /// - ofGetFrameNum() - current frame number
 /// - ofGetFrameRate() - current frame rate (FPS)
 /// - ofSetFrameRate() - set target frame rate
+/// - ofSetFramePipelining() - overlap recording and encoding
+/// - ofSetFramePacing() - trade latency for throughput
 
 // MARK: - Time Functions
 
@@ -35,6 +38,51 @@ float ofGetFrameRate();
 /// @param targetRate Target frames per second (0 = unlimited)
 void ofSetFrameRate(float targetRate);
 
+/// Overlap recording of the next frame with encoding of the current one
+/// Moves command encoding to a render thread at the cost of one frame of latency
+/// @param enabled true to enable pipelined frames
+void ofSetFramePipelining(bool enabled);
+
+/// Check whether pipelined frames are enabled
+/// @return true if pipelined frames are enabled
+bool ofGetFramePipelining();
+
+/// Frame pacing modes
+enum ofFramePacing {
+    OF_FRAME_PACING_THROUGHPUT,     ///< Up to three frames in flight (default)
+    OF_FRAME_PACING_LOW_LATENCY,    ///< One frame in flight, late input sampling
+    OF_FRAME_PACING_ADAPTIVE,       ///< ProMotion refresh within ofSetFrameRateRange()
+};
+
+/// Set how frames are queued and presented
+/// Low latency keeps a single frame in flight, samples input just before
+/// update() and presents at the ofSetFrameRate() rate; it disables frame
+/// pipelining while active. Adaptive lets ProMotion displays refresh
+/// anywhere in the frame rate range.
+/// @param pacing Pacing mode
+void ofSetFramePacing(ofFramePacing pacing);
+
+/// Get the frame pacing mode
+/// @return Current pacing mode
+ofFramePacing ofGetFramePacing();
+
+/// Set the refresh rates the adaptive pacing mode may use
+/// @param minFps Lowest refresh rate (default: 30)
+/// @param maxFps Highest and preferred refresh rate (default: 120)
+void ofSetFrameRateRange(float minFps, float maxFps);
+
+/// Input-to-photon estimate, from the newest input event to presentation
+struct ofFrameLatency {
+    double lastMs = 0.0;
+    double averageMs = 0.0;
+    double maxMs = 0.0;
+    uint64_t framesMeasured = 0;
+};
+
+/// Get the input-to-photon estimate of recent frames
+/// @return Latency in milliseconds (all zero until a frame is presented)
+ofFrameLatency ofGetFrameLatency();
+
 // MARK: - Image Loading Functions
 
 // Forward declarations
@@ -80,6 +128,27 @@ bool ofLoadImage(ofFloatPixels& pixels, const std::string& path);
 /// @return true if successful, false otherwise
 bool ofLoadImage(ofTexture& texture, const std::string& path);
 
+/// Load image from file into ofTexture as block-compressed data
+/// .ktx2 files (ASTC, BC1, BC3, BC7) are loaded as stored. Other images are
+/// transcoded on first load to BC1 (opaque) or BC3 (with alpha) with a full
+/// mip chain, and the result is cached as a KTX2 file keyed by the source's
+/// path, modification time and size; later loads read the cache and skip
+/// decoding. Falls back to an uncompressed upload when the GPU can't sample
+/// BC formats or the cache can't be written.
+/// @param texture Target ofTexture object to load into
+/// @param path Path to image file
+/// @return true if the texture was loaded, compressed or not
+bool ofLoadCompressedImage(ofTexture& texture, const std::string& path);
+
+/// Set the directory ofLoadCompressedImage() caches transcoded textures in
+/// Defaults to oflike-metal/textures in the user's caches directory
+/// @param directory Cache directory (created on demand)
+void ofSetCompressedTextureCacheDirectory(const std::string& directory);
+
+/// Get the directory ofLoadCompressedImage() caches transcoded textures in
+/// @return Cache directory path
+std::string ofGetCompressedTextureCacheDirectory();
+
 // MARK: - Image Saving Functions
 
 /// Save ofPixels to image file
@@ -91,6 +160,14 @@ bool ofLoadImage(ofTexture& texture, const std::string& path);
 /// @return true if successful, false otherwise
 bool ofSaveImage(const ofPixels& pixels, const std::string& path, float quality = 0.9f);
 
+/// Encode ofPixels to image file data in memory
+/// @param pixels Source ofPixels object to encode
+/// @param encoded Receives the encoded file contents
+/// @param path File name whose extension picks the format, as ofSaveImage()
+/// @param quality JPEG quality 0.0-1.0 (default 0.9), ignored for PNG/TIFF
+/// @return true if successful, false otherwise
+bool ofEncodeImage(const ofPixels& pixels, std::vector<uint8_t>& encoded, const std::string& path, float quality = 0.9f);
+
 /// Save ofShortPixels to image file (16-bit)
 /// @param pixels Source ofShortPixels object to save
 /// @param path Path to save image file
@@ -114,6 +191,14 @@ bool ofGetKeyPressed(int key);
 
 // MARK: - Mouse State Functions (Phase 13.5)
 
+/// One mouse, trackpad or pen position reported by the system
+struct ofMouseSample {
+    float x = 0.0f;             ///< Position in pixels, sub-pixel where the device reports it
+    float y = 0.0f;
+    int button = -1;            ///< Button held while dragging; -1 for plain motion
+    double timestamp = 0.0;     ///< Seconds since system start-up, as NSEvent timestamps
+};
+
 /// Get current mouse x position (in pixels)
 /// @return Current mouse x position
 int ofGetMouseX();
@@ -135,6 +220,22 @@ int ofGetPreviousMouseY();
 /// @return true if the button is pressed, false otherwise
 bool ofGetMousePressed(int button = 0);
 
+/// Deliver mouseMoved/mouseDragged at most once per frame
+/// Off by default. While on, high-rate motion is queued and delivered before
+/// update() at its latest position; ofGetMousePath() holds the full path, for
+/// brushes and gesture tracking that need every sample.
+/// @param coalesce true to coalesce motion events
+void ofSetMouseCoalescing(bool coalesce);
+
+/// @return true if motion events are coalesced
+bool ofGetMouseCoalescing();
+
+/// Samples behind the latest mouseMoved/mouseDragged call, oldest first
+/// Holds every sample since the last frame with coalescing on, otherwise the
+/// latest one; empty after a frame without motion.
+/// @return Positions with timestamps
+const std::vector<ofMouseSample>& ofGetMousePath();
+
 // MARK: - Window Functions (Phase 14.1)
 
 /// Get window width in pixels
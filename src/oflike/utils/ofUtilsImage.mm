@@ -5,10 +5,18 @@
 #include "../image/ofPixels.h"
 #include "../image/ofTexture.h"
 #include "../../core/Context.h"
+#include "../image/ImageDecoder.h"
 #include "../../render/IRenderer.h"
+#include "../../render/TextureCompression.h"
 #include "ofLog.h"
+#include <dispatch/dispatch.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <climits>
+#include <mutex>
 
 using oflike::ofLogError;
+using oflike::ofLogWarning;
 using oflike::ofImageType;
 
 // ============================================================================
@@ -357,10 +365,278 @@ bool ofLoadImage(ofTexture& texture, const std::string& path) {
     }
 }
 
+// ============================================================================
+// Image Loading - compressed ofTexture variant (baked KTX2 cache)
+// ============================================================================
+
+namespace {
+
+// Bump when the encoder changes so stale bakes are ignored
+constexpr uint32_t kBakeVersion = 1;
+
+std::mutex gCompressedCacheMutex;
+std::string gCompressedCacheDirectory;
+
+// Cache file of a source image: its name plus a hash of what identifies it
+std::string CompressedCachePath(const std::string& path, const struct stat& info) {
+    char resolved[PATH_MAX];
+    const std::string source = realpath(path.c_str(), resolved) ? resolved : path;
+
+    // FNV-1a over the absolute path, mtime, size and encoder version
+    uint64_t hash = 0xCBF29CE484222325ull;
+    const auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        }
+    };
+    const long long stamp[4] = {static_cast<long long>(info.st_mtimespec.tv_sec),
+                                static_cast<long long>(info.st_mtimespec.tv_nsec),
+                                static_cast<long long>(info.st_size), kBakeVersion};
+    mix(source.data(), source.size());
+    mix(stamp, sizeof(stamp));
+
+    NSString* name = [[NSString stringWithUTF8String:source.c_str()].lastPathComponent
+        stringByDeletingPathExtension];
+    char suffix[24];
+    snprintf(suffix, sizeof(suffix), "-%016llx.ktx2", static_cast<unsigned long long>(hash));
+    return ofGetCompressedTextureCacheDirectory() + "/" + (name ? name.UTF8String : "texture") + suffix;
+}
+
+// Expand 8-bit pixels to RGBA8 rows
+std::vector<uint8_t> ToRGBA(const ofPixels& pixels, bool& hasAlpha) {
+    const size_t width = pixels.getWidth();
+    const size_t height = pixels.getHeight();
+    const size_t channels = pixels.getNumChannels();
+    std::vector<uint8_t> rgba(width * height * 4);
+    hasAlpha = false;
+    for (size_t y = 0; y < height; ++y) {
+        const unsigned char* src = pixels.getRowData(y);
+        uint8_t* dst = rgba.data() + y * width * 4;
+        for (size_t x = 0; x < width; ++x, src += channels, dst += 4) {
+            dst[0] = src[0];
+            dst[1] = channels >= 3 ? src[1] : src[0];
+            dst[2] = channels >= 3 ? src[2] : src[0];
+            dst[3] = channels == 4 ? src[3] : (channels == 2 ? src[1] : 255);
+            hasAlpha |= dst[3] != 255;
+        }
+    }
+    return rgba;
+}
+
+// Next mip level: average of 2x2 texels (edges reuse the last row/column)
+std::vector<uint8_t> Downsample(const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height) {
+    const uint32_t w = std::max(1u, width / 2);
+    const uint32_t h = std::max(1u, height / 2);
+    std::vector<uint8_t> result(static_cast<size_t>(w) * h * 4);
+    for (uint32_t y = 0; y < h; ++y) {
+        const uint32_t y0 = std::min(y * 2, height - 1);
+        const uint32_t y1 = std::min(y * 2 + 1, height - 1);
+        for (uint32_t x = 0; x < w; ++x) {
+            const uint32_t x0 = std::min(x * 2, width - 1);
+            const uint32_t x1 = std::min(x * 2 + 1, width - 1);
+            for (uint32_t c = 0; c < 4; ++c) {
+                const uint32_t sum = rgba[(static_cast<size_t>(y0) * width + x0) * 4 + c] +
+                                     rgba[(static_cast<size_t>(y0) * width + x1) * 4 + c] +
+                                     rgba[(static_cast<size_t>(y1) * width + x0) * 4 + c] +
+                                     rgba[(static_cast<size_t>(y1) * width + x1) * 4 + c];
+                result[(static_cast<size_t>(y) * w + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+    return result;
+}
+
+// Encode pixels and their mip chain as BC1/BC3, rows of blocks in parallel
+render::CompressedTexture Bake(const ofPixels& pixels) {
+    bool hasAlpha = false;
+    std::vector<uint8_t> rgba = ToRGBA(pixels, hasAlpha);
+
+    render::CompressedTexture texture;
+    texture.width = static_cast<uint32_t>(pixels.getWidth());
+    texture.height = static_cast<uint32_t>(pixels.getHeight());
+    texture.format = hasAlpha ? render::CompressedTextureFormat::BC3 : render::CompressedTextureFormat::BC1;
+
+    uint32_t width = texture.width;
+    uint32_t height = texture.height;
+    while (true) {
+        std::vector<uint8_t> blocks(render::compressedLevelBytes(texture.format, width, height));
+        const uint32_t blockRows = (height + 3) / 4;
+        const size_t rowBytes = blocks.size() / blockRows;
+        const uint8_t* src = rgba.data();
+        uint8_t* dst = blocks.data();
+        const render::CompressedTextureFormat format = texture.format;
+        const uint32_t levelWidth = width;
+        const uint32_t levelHeight = height;
+        dispatch_apply(blockRows, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t row) {
+            render::encodeBCBlockRow(format, src, levelWidth, levelHeight, levelWidth * 4,
+                                     static_cast<uint32_t>(row), dst + row * rowBytes);
+        });
+        texture.levels.push_back(std::move(blocks));
+
+        if (width == 1 && height == 1) {
+            break;
+        }
+        rgba = Downsample(rgba, width, height);
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+    }
+    return texture;
+}
+
+// Write a file atomically, creating its directory
+bool WriteCacheFile(const std::string& path, const std::vector<uint8_t>& contents) {
+    NSString* nsPath = [NSString stringWithUTF8String:path.c_str()];
+    [[NSFileManager defaultManager] createDirectoryAtPath:[nsPath stringByDeletingLastPathComponent]
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:nil];
+    NSData* data = [NSData dataWithBytesNoCopy:const_cast<uint8_t*>(contents.data())
+                                        length:contents.size()
+                                  freeWhenDone:NO];
+    return [data writeToFile:nsPath atomically:YES];
+}
+
+} // namespace
+
+bool ofLoadCompressedImage(ofTexture& texture, const std::string& path) {
+    @autoreleasepool {
+        NSString* extension = [[NSString stringWithUTF8String:path.c_str()] pathExtension].lowercaseString;
+        if ([extension isEqualToString:@"ktx2"]) {
+            return texture.loadCompressed(path);
+        }
+
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) {
+            ofLogError("ofLoadCompressedImage") << "File not found: " << path;
+            return false;
+        }
+
+        // Baked earlier and unchanged since
+        const std::string cachePath = CompressedCachePath(path, info);
+        struct stat cacheInfo;
+        if (stat(cachePath.c_str(), &cacheInfo) == 0 && texture.loadCompressed(cachePath)) {
+            return true;
+        }
+
+        std::shared_ptr<const ofPixels> pixels = oflike::decodeImageFile(path);
+        if (!pixels) {
+            return false;
+        }
+
+        auto* renderer = ctx().renderer();
+        const bool bcSupported = renderer &&
+            renderer->supportsCompressedTextureFormat(render::CompressedTextureFormat::BC1) &&
+            renderer->supportsCompressedTextureFormat(render::CompressedTextureFormat::BC3);
+        if (bcSupported) {
+            const std::vector<uint8_t> file = render::writeKTX2(Bake(*pixels));
+            if (!file.empty() && WriteCacheFile(cachePath, file) && texture.loadCompressed(cachePath)) {
+                return true;
+            }
+            ofLogWarning("ofLoadCompressedImage") << "Couldn't cache " << cachePath
+                << ", loading uncompressed";
+        }
+
+        texture.loadData(*pixels);
+        return texture.isAllocated();
+    }
+}
+
+void ofSetCompressedTextureCacheDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(gCompressedCacheMutex);
+    gCompressedCacheDirectory = directory;
+}
+
+std::string ofGetCompressedTextureCacheDirectory() {
+    std::lock_guard<std::mutex> lock(gCompressedCacheMutex);
+    if (gCompressedCacheDirectory.empty()) {
+        @autoreleasepool {
+            NSString* caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+            NSString* directory = [(caches ?: NSTemporaryDirectory()) stringByAppendingPathComponent:@"oflike-metal/textures"];
+            gCompressedCacheDirectory = directory.UTF8String;
+        }
+    }
+    return gCompressedCacheDirectory;
+}
+
 // ============================================================================
 // Image Saving - ofPixels variant (CGImageDestination)
 // ============================================================================
 
+namespace {
+
+// Image format for a path's extension: JPEG, TIFF or (by default) PNG
+CFStringRef ImageTypeForPath(NSString* nsPath) {
+    NSString* extension = [nsPath pathExtension].lowercaseString;
+    if ([extension isEqualToString:@"jpg"] || [extension isEqualToString:@"jpeg"]) {
+        return kUTTypeJPEG;
+    }
+    if ([extension isEqualToString:@"tif"] || [extension isEqualToString:@"tiff"]) {
+        return kUTTypeTIFF;
+    }
+    return kUTTypePNG;
+}
+
+// Add the pixels to a destination and finalize it
+bool WriteImage(const ofPixels& pixels, CGImageDestinationRef destination, CFStringRef imageType, float quality) {
+    // Create color space
+    size_t channels = pixels.getNumChannels();
+    CGColorSpaceRef colorSpace;
+
+    if (channels == 1) {
+        colorSpace = CGColorSpaceCreateDeviceGray();
+    } else {
+        colorSpace = CGColorSpaceCreateDeviceRGB();
+    }
+
+    // Create CGImage from pixel data
+    size_t bytesPerRow = pixels.getWidth() * pixels.getBytesPerPixel();
+    CGContextRef context = CGBitmapContextCreate(
+        const_cast<unsigned char*>(pixels.getData()),
+        pixels.getWidth(),
+        pixels.getHeight(),
+        8,  // bits per component
+        bytesPerRow,
+        colorSpace,
+        channels == 4 ? kCGImageAlphaPremultipliedLast : kCGImageAlphaNoneSkipLast
+    );
+
+    if (!context) {
+        ofLogError("ofSaveImage") << "Failed to create bitmap context";
+        CGColorSpaceRelease(colorSpace);
+        return false;
+    }
+
+    CGImageRef cgImage = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+
+    if (!cgImage) {
+        ofLogError("ofSaveImage") << "Failed to create CGImage";
+        CGColorSpaceRelease(colorSpace);
+        return false;
+    }
+
+    // Set quality for JPEG
+    NSDictionary* properties = nil;
+    if (imageType == kUTTypeJPEG) {
+        properties = @{
+            (__bridge id)kCGImageDestinationLossyCompressionQuality: @(quality)
+        };
+    }
+
+    // Add image to destination
+    CGImageDestinationAddImage(destination, cgImage, (__bridge CFDictionaryRef)properties);
+
+    // Finalize
+    bool success = CGImageDestinationFinalize(destination);
+
+    CGImageRelease(cgImage);
+    CGColorSpaceRelease(colorSpace);
+    return success;
+}
+
+} // namespace
+
 bool ofSaveImage(const ofPixels& pixels, const std::string& path, float quality) {
     @autoreleasepool {
         if (!pixels.isAllocated()) {
@@ -372,14 +648,7 @@ bool ofSaveImage(const ofPixels& pixels, const std::string& path, float quality)
         NSURL* url = [NSURL fileURLWithPath:nsPath];
 
         // Determine format from extension
-        NSString* extension = [nsPath pathExtension].lowercaseString;
-        CFStringRef imageType = kUTTypePNG;  // Default to PNG
-        
-        if ([extension isEqualToString:@"jpg"] || [extension isEqualToString:@"jpeg"]) {
-            imageType = kUTTypeJPEG;
-        } else if ([extension isEqualToString:@"tif"] || [extension isEqualToString:@"tiff"]) {
-            imageType = kUTTypeTIFF;
-        }
+        CFStringRef imageType = ImageTypeForPath(nsPath);
 
         // Create image destination
         CGImageDestinationRef destination = CGImageDestinationCreateWithURL(
@@ -394,69 +663,47 @@ bool ofSaveImage(const ofPixels& pixels, const std::string& path, float quality)
             return false;
         }
 
-        // Create color space
-        size_t channels = pixels.getNumChannels();
-        CGColorSpaceRef colorSpace;
-        
-        if (channels == 1) {
-            colorSpace = CGColorSpaceCreateDeviceGray();
-        } else {
-            colorSpace = CGColorSpaceCreateDeviceRGB();
-        }
-
-        // Create CGImage from pixel data
-        size_t bytesPerRow = pixels.getWidth() * pixels.getBytesPerPixel();
-        CGContextRef context = CGBitmapContextCreate(
-            const_cast<unsigned char*>(pixels.getData()),
-            pixels.getWidth(),
-            pixels.getHeight(),
-            8,  // bits per component
-            bytesPerRow,
-            colorSpace,
-            channels == 4 ? kCGImageAlphaPremultipliedLast : kCGImageAlphaNoneSkipLast
-        );
+        bool success = WriteImage(pixels, destination, imageType, quality);
+        CFRelease(destination);
 
-        if (!context) {
-            ofLogError("ofSaveImage") << "Failed to create bitmap context";
-            CGColorSpaceRelease(colorSpace);
-            CFRelease(destination);
+        if (!success) {
+            ofLogError("ofSaveImage") << "Failed to write image: " << path;
             return false;
         }
 
-        CGImageRef cgImage = CGBitmapContextCreateImage(context);
-        CGContextRelease(context);
+        return true;
+    }
+}
 
-        if (!cgImage) {
-            ofLogError("ofSaveImage") << "Failed to create CGImage";
-            CGColorSpaceRelease(colorSpace);
-            CFRelease(destination);
+bool ofEncodeImage(const ofPixels& pixels, std::vector<uint8_t>& encoded, const std::string& path, float quality) {
+    @autoreleasepool {
+        if (!pixels.isAllocated()) {
+            ofLogError("ofEncodeImage") << "Pixels not allocated";
             return false;
         }
 
-        // Set quality for JPEG
-        NSDictionary* properties = nil;
-        if (imageType == kUTTypeJPEG) {
-            properties = @{
-                (__bridge id)kCGImageDestinationLossyCompressionQuality: @(quality)
-            };
-        }
-
-        // Add image to destination
-        CGImageDestinationAddImage(destination, cgImage, (__bridge CFDictionaryRef)properties);
+        NSString* nsPath = [NSString stringWithUTF8String:path.c_str()];
+        CFStringRef imageType = ImageTypeForPath(nsPath);
 
-        // Finalize
-        bool success = CGImageDestinationFinalize(destination);
+        CFMutableDataRef data = CFDataCreateMutable(kCFAllocatorDefault, 0);
+        CGImageDestinationRef destination = CGImageDestinationCreateWithData(data, imageType, 1, NULL);
+        if (!destination) {
+            ofLogError("ofEncodeImage") << "Failed to create image destination: " << path;
+            CFRelease(data);
+            return false;
+        }
 
-        CGImageRelease(cgImage);
-        CGColorSpaceRelease(colorSpace);
+        bool success = WriteImage(pixels, destination, imageType, quality);
         CFRelease(destination);
 
-        if (!success) {
-            ofLogError("ofSaveImage") << "Failed to write image: " << path;
-            return false;
+        if (success) {
+            const UInt8* bytes = CFDataGetBytePtr(data);
+            encoded.assign(bytes, bytes + CFDataGetLength(data));
+        } else {
+            ofLogError("ofEncodeImage") << "Failed to encode image: " << path;
         }
-
-        return true;
+        CFRelease(data);
+        return success;
     }
 }
 
@@ -0,0 +1,134 @@
+#pragma once
+
+// oflike-metal CaptureSupport - camera plumbing shared by the grabbers
+// Objective-C++ only: finds and configures capture devices, opens one
+// session per camera and hands frames from the capture queue to the main
+// thread without locks
+
+#import <AVFoundation/AVFoundation.h>
+#import <CoreVideo/CoreVideo.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace oflike {
+
+// ============================================================================
+// Frame Handoff
+// ============================================================================
+
+/// A captured frame and its capture time in seconds on the host clock
+struct CaptureFrame {
+    CVPixelBufferRef buffer = nullptr;
+    double captureTime = 0.0;
+};
+
+/// Latest-frame-wins handoff from the capture queue to update() without
+/// locks. The writer fills its own slot and swaps it with the shared one;
+/// the reader swaps its slot for the shared one when that holds a new
+/// frame. Each slot keeps its buffer until the writer reuses the slot.
+class FrameTripleBuffer {
+public:
+    ~FrameTripleBuffer() {
+        for (CaptureFrame& slot : slots_) {
+            if (slot.buffer) {
+                CVPixelBufferRelease(slot.buffer);
+            }
+        }
+    }
+
+    /// Capture queue: publish a frame, replacing one not taken yet
+    void publish(CVPixelBufferRef buffer, double captureTime) {
+        CaptureFrame& slot = slots_[back_];
+        if (slot.buffer) {
+            CVPixelBufferRelease(slot.buffer);  // Taken already, or replaced
+        }
+        slot.buffer = CVPixelBufferRetain(buffer);
+        slot.captureTime = captureTime;
+
+        const uint8_t previous = shared_.exchange(back_ | kFresh, std::memory_order_acq_rel);
+        back_ = previous & kIndexMask;
+        captured_.fetch_add(1, std::memory_order_relaxed);
+        if (previous & kFresh) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// Main thread: take the latest frame if one arrived since the last
+    /// take. The buffer stays valid until the next take.
+    bool take(CaptureFrame& frame) {
+        if (!(shared_.load(std::memory_order_relaxed) & kFresh)) {
+            return false;
+        }
+        front_ = shared_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+        frame = slots_[front_];
+        return true;
+    }
+
+    uint64_t captured() const { return captured_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFresh = 0x4;     // Shared slot holds an untaken frame
+
+    CaptureFrame slots_[3];
+    std::atomic<uint8_t> shared_{1};
+    std::atomic<uint64_t> captured_{0};
+    std::atomic<uint64_t> dropped_{0};
+    uint8_t back_ = 0;                         // Writer's slot
+    uint8_t front_ = 2;                        // Reader's slot
+};
+
+} // namespace oflike
+
+// ============================================================================
+// Capture Delegate
+// ============================================================================
+
+/// Publishes camera frames from the capture queue for update()
+@interface OflikeCaptureDelegate : NSObject <AVCaptureVideoDataOutputSampleBufferDelegate>
+
+/// Session clock of the sample buffer timestamps (host clock if NULL)
+@property (nonatomic, assign) CMClockRef clock;
+
+- (oflike::FrameTripleBuffer*)frames;
+
+@end
+
+
+namespace oflike {
+
+// ============================================================================
+// Capture Streams
+// ============================================================================
+
+/// \brief Find a camera by unique ID, else by index in the device list
+/// \return The device, the default camera as a fallback, or nil
+AVCaptureDevice* findCaptureDevice(int deviceID, const std::string& uniqueID);
+
+/// \brief Pick the device format closest to a size that supports a frame rate
+/// \param outWidth Receives the chosen width (unchanged if none was set)
+/// \param outHeight Receives the chosen height (unchanged if none was set)
+void configureCaptureDevice(AVCaptureDevice* device, int width, int height, float frameRate,
+                            int& outWidth, int& outHeight);
+
+/// One camera's session, from device input to frame handoff
+struct CaptureStream {
+    AVCaptureSession* session = nil;
+    AVCaptureDeviceInput* input = nil;
+    AVCaptureVideoDataOutput* output = nil;
+    OflikeCaptureDelegate* delegate = nil;
+};
+
+/// \brief Open a session delivering bi-planar 4:2:0 frames where the camera
+/// offers them (BGRA otherwise) to a new delegate
+/// \details Not started; the reason for a failure is logged.
+/// \param queue Serial queue the delegate runs on; may be shared by streams
+/// \return false if the session can't be built
+bool openCaptureStream(AVCaptureDevice* device, dispatch_queue_t queue, CaptureStream& stream);
+
+/// \brief Stop a session and release it
+void closeCaptureStream(CaptureStream& stream);
+
+} // namespace oflike
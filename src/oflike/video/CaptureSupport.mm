@@ -0,0 +1,216 @@
+// CaptureSupport.mm - Camera sessions and lock-free frame handoff
+
+#import "CaptureSupport.h"
+#include <cmath>
+
+// ============================================================================
+// Capture Delegate
+// ============================================================================
+
+@implementation OflikeCaptureDelegate {
+    oflike::FrameTripleBuffer _frames;
+}
+
+- (oflike::FrameTripleBuffer*)frames {
+    return &_frames;
+}
+
+- (void)captureOutput:(AVCaptureOutput*)captureOutput
+didOutputSampleBuffer:(CMSampleBufferRef)sampleBuffer
+       fromConnection:(AVCaptureConnection*)connection {
+
+    (void)captureOutput;
+    (void)connection;
+
+    CVImageBufferRef imageBuffer = CMSampleBufferGetImageBuffer(sampleBuffer);
+    if (!imageBuffer) {
+        return;
+    }
+
+    // Capture time on the host clock, which presentation times also use
+    CMClockRef hostClock = CMClockGetHostTimeClock();
+    CMTime captureTime = CMSampleBufferGetPresentationTimeStamp(sampleBuffer);
+    if (_clock && CMTIME_IS_VALID(captureTime)) {
+        captureTime = CMSyncConvertTime(captureTime, _clock, hostClock);
+    } else {
+        captureTime = CMClockGetTime(hostClock);
+    }
+
+    // Frames stay in their capture buffers
+    _frames.publish(imageBuffer, CMTimeGetSeconds(captureTime));
+}
+
+@end
+
+namespace oflike {
+
+// ============================================================================
+// Capture Streams
+// ============================================================================
+
+AVCaptureDevice* findCaptureDevice(int deviceID, const std::string& uniqueID) {
+    AVCaptureDevice* device = nil;
+
+    if (!uniqueID.empty()) {
+        // Find by unique ID
+        device = [AVCaptureDevice deviceWithUniqueID:[NSString stringWithUTF8String:uniqueID.c_str()]];
+    } else {
+        // Find by index
+        AVCaptureDeviceDiscoverySession* discoverySession = [AVCaptureDeviceDiscoverySession
+            discoverySessionWithDeviceTypes:@[
+                AVCaptureDeviceTypeBuiltInWideAngleCamera,
+                AVCaptureDeviceTypeExternalUnknown
+            ]
+            mediaType:AVMediaTypeVideo
+            position:AVCaptureDevicePositionUnspecified];
+
+        NSArray<AVCaptureDevice*>* devices = [discoverySession devices];
+
+        if (deviceID >= 0 && deviceID < static_cast<int>([devices count])) {
+            device = devices[deviceID];
+        } else if ([devices count] > 0) {
+            device = devices[0];
+        }
+    }
+
+    if (!device) {
+        // Fall back to default device
+        device = [AVCaptureDevice defaultDeviceWithMediaType:AVMediaTypeVideo];
+    }
+    return device;
+}
+
+void configureCaptureDevice(AVCaptureDevice* device, int width, int height, float frameRate,
+                            int& outWidth, int& outHeight) {
+    NSError* error = nil;
+    if (![device lockForConfiguration:&error]) {
+        NSLog(@"ofVideoGrabber: Failed to lock device for configuration: %@", error);
+        return;
+    }
+
+    // Find best matching format
+    AVCaptureDeviceFormat* bestFormat = nil;
+    Float64 bestScore = INFINITY;
+
+    for (AVCaptureDeviceFormat* format in [device formats]) {
+        CMVideoDimensions dimensions = CMVideoFormatDescriptionGetDimensions(format.formatDescription);
+
+        // Calculate score (prefer closest to requested size)
+        Float64 widthDiff = std::abs(dimensions.width - width);
+        Float64 heightDiff = std::abs(dimensions.height - height);
+        Float64 score = widthDiff + heightDiff;
+
+        // Check if format supports desired frame rate
+        for (AVFrameRateRange* range in format.videoSupportedFrameRateRanges) {
+            if (range.minFrameRate <= frameRate && range.maxFrameRate >= frameRate) {
+                // Bonus for supporting desired frame rate
+                score -= 1000;
+            }
+        }
+
+        if (score < bestScore) {
+            bestScore = score;
+            bestFormat = format;
+        }
+    }
+
+    if (bestFormat) {
+        device.activeFormat = bestFormat;
+
+        // Set frame rate
+        CMTime frameDuration = CMTimeMake(1, static_cast<int32_t>(frameRate));
+        for (AVFrameRateRange* range in bestFormat.videoSupportedFrameRateRanges) {
+            if (range.minFrameRate <= frameRate && range.maxFrameRate >= frameRate) {
+                device.activeVideoMinFrameDuration = frameDuration;
+                device.activeVideoMaxFrameDuration = frameDuration;
+                break;
+            }
+        }
+
+        CMVideoDimensions dims = CMVideoFormatDescriptionGetDimensions(bestFormat.formatDescription);
+        outWidth = dims.width;
+        outHeight = dims.height;
+    }
+
+    [device unlockForConfiguration];
+}
+
+bool openCaptureStream(AVCaptureDevice* device, dispatch_queue_t queue, CaptureStream& stream) {
+    NSError* error = nil;
+
+    // Create capture session
+    stream.session = [[AVCaptureSession alloc] init];
+    if (!stream.session) {
+        NSLog(@"ofVideoGrabber: Failed to create capture session");
+        return false;
+    }
+
+    // Create input
+    stream.input = [AVCaptureDeviceInput deviceInputWithDevice:device error:&error];
+    if (!stream.input) {
+        NSLog(@"ofVideoGrabber: Failed to create capture input: %@", error);
+        stream = CaptureStream();
+        return false;
+    }
+
+    if (![stream.session canAddInput:stream.input]) {
+        NSLog(@"ofVideoGrabber: Cannot add capture input to session");
+        stream = CaptureStream();
+        return false;
+    }
+    [stream.session addInput:stream.input];
+
+    // Create output
+    stream.output = [[AVCaptureVideoDataOutput alloc] init];
+    if (!stream.output) {
+        NSLog(@"ofVideoGrabber: Failed to create capture output");
+        [stream.session removeInput:stream.input];
+        stream = CaptureStream();
+        return false;
+    }
+
+    // Prefer the camera's native bi-planar 4:2:0 output (half the
+    // bandwidth of BGRA, converted on the GPU); BGRA otherwise
+    NSArray<NSNumber*>* formats = stream.output.availableVideoCVPixelFormatTypes;
+    OSType pixelFormat = kCVPixelFormatType_32BGRA;
+    if ([formats containsObject:@(kCVPixelFormatType_420YpCbCr8BiPlanarFullRange)]) {
+        pixelFormat = kCVPixelFormatType_420YpCbCr8BiPlanarFullRange;
+    } else if ([formats containsObject:@(kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange)]) {
+        pixelFormat = kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange;
+    }
+    stream.output.videoSettings = @{
+        (id)kCVPixelBufferPixelFormatTypeKey: @(pixelFormat),
+        (id)kCVPixelBufferMetalCompatibilityKey: @YES
+    };
+    stream.output.alwaysDiscardsLateVideoFrames = YES;
+
+    // Create delegate
+    stream.delegate = [[OflikeCaptureDelegate alloc] init];
+    stream.delegate.clock = stream.session.synchronizationClock;
+    [stream.output setSampleBufferDelegate:stream.delegate queue:queue];
+
+    if (![stream.session canAddOutput:stream.output]) {
+        NSLog(@"ofVideoGrabber: Cannot add capture output to session");
+        [stream.session removeInput:stream.input];
+        stream = CaptureStream();
+        return false;
+    }
+    [stream.session addOutput:stream.output];
+    return true;
+}
+
+void closeCaptureStream(CaptureStream& stream) {
+    if (stream.session) {
+        [stream.session stopRunning];
+
+        if (stream.input) {
+            [stream.session removeInput:stream.input];
+        }
+        if (stream.output) {
+            [stream.session removeOutput:stream.output];
+        }
+    }
+    stream = CaptureStream();
+}
+
+} // namespace oflike
@@ -0,0 +1,90 @@
+#pragma once
+
+// oflike-metal HapFrame - HAP video frames decoded to GPU texture blocks
+// HAP frames hold DXT/BPTC texture data behind an optional Snappy stage;
+// decoding undoes only that stage, so frames reach the GPU still compressed
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "../image/ofTexture.h"
+#include "../../render/RenderTypes.h"
+
+namespace oflike {
+
+// ============================================================================
+// Frame Decoding
+// ============================================================================
+
+/// HAP variant of a video track
+enum class HapCodec : uint8_t {
+    None,           ///< Not a HAP track
+    Hap,            ///< 'Hap1': RGB in BC1 (DXT1)
+    HapAlpha,       ///< 'Hap5': RGBA in BC3 (DXT5)
+    HapQ,           ///< 'HapY': scaled YCoCg in BC3, converted to RGB on the GPU
+    HapQAlpha,      ///< 'HapM': HapQ plus a BC4 alpha texture
+    HapAlphaOnly,   ///< 'HapA': BC4 alpha, drawn as gray
+    HapR,           ///< 'Hap7': RGBA in BC7 (BPTC)
+};
+
+/// HAP variant of a codec FourCC (CMFormatDescriptionGetMediaSubType), None for other codecs
+HapCodec hapCodecFromFourCC(uint32_t fourCC);
+
+/// Number of textures in a frame: 2 for HapQAlpha, otherwise 1
+uint32_t hapTextureCount(HapCodec codec);
+
+/// Block format of a frame's texture (index 1 is HapQAlpha's alpha)
+render::CompressedTextureFormat hapTextureFormat(HapCodec codec, uint32_t index);
+
+/// Bytes of a frame's decoded textures, back to back
+size_t hapFrameBytes(HapCodec codec, uint32_t width, uint32_t height);
+
+/// \brief Decode a frame's texture blocks
+/// \details Parses the frame's sections and undoes their Snappy stage; the
+/// chunks of chunked frames are decompressed in parallel on the global
+/// queue. Blocks cover the frame rounded up to 4 pixels and are written
+/// back to back in texture order.
+/// \param data Frame as stored in the track (one sample)
+/// \param size Sample size in bytes
+/// \param output hapFrameBytes() bytes
+/// \return false for malformed frames or frames that don't match the codec and size
+bool decodeHapFrame(const uint8_t* data, size_t size, HapCodec codec, uint32_t width, uint32_t height,
+                    uint8_t* output);
+
+// ============================================================================
+// HapFrameTexture
+// ============================================================================
+
+/// \brief Decoded HAP frames drawn through an ofTexture
+/// \details Blocks are uploaded as they are into compressed textures that
+/// are reused from frame to frame; the uploads are ordered with the frames
+/// in flight, so one texture per plane suffices. HAP, HAP Alpha and HAP R
+/// draw straight from their block textures; HAP Q is converted from YCoCg
+/// into a writable RGBA texture in order with the frame's draws.
+class HapFrameTexture {
+public:
+    HapFrameTexture();
+    ~HapFrameTexture();
+
+    HapFrameTexture(const HapFrameTexture&) = delete;
+    HapFrameTexture& operator=(const HapFrameTexture&) = delete;
+
+    /// \brief Check if the GPU samples a variant's block formats
+    static bool isSupported(HapCodec codec);
+
+    /// \brief Show a decoded frame
+    /// \details Call on the main thread.
+    /// \param blocks hapFrameBytes() bytes from decodeHapFrame()
+    /// \param texture Texture that draws the frame
+    /// \return false if the textures could not be created
+    bool setFrame(HapCodec codec, uint32_t width, uint32_t height, const uint8_t* blocks, ofTexture& texture);
+
+    /// \brief Release the block textures
+    void clear();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
@@ -0,0 +1,534 @@
+// HapFrame.mm - HAP frame parsing, Snappy decompression and block texture upload
+
+#import <Foundation/Foundation.h>
+#import <Metal/Metal.h>
+#include <dispatch/dispatch.h>
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "HapFrame.h"
+#include "../../core/Context.h"
+#include "../../render/DrawCommand.h"
+#include "../../render/DrawList.h"
+#include "../../render/IRenderer.h"
+
+namespace oflike {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+namespace {
+
+// Section types: the high nibble of a texture section is its second-stage
+// compressor, the low nibble its texture format
+constexpr uint8_t kSectionMultipleImages = 0x0D;
+constexpr uint8_t kSectionDecodeInstructions = 0x01;
+constexpr uint8_t kSectionChunkCompressors = 0x02;
+constexpr uint8_t kSectionChunkSizes = 0x03;
+constexpr uint8_t kSectionChunkOffsets = 0x04;
+
+constexpr uint8_t kCompressorNone = 0x0A;
+constexpr uint8_t kCompressorSnappy = 0x0B;
+constexpr uint8_t kCompressorComplex = 0x0C;
+
+constexpr uint8_t kFormatRGBDXT1 = 0x0B;
+constexpr uint8_t kFormatRGBADXT5 = 0x0E;
+constexpr uint8_t kFormatYCoCgDXT5 = 0x0F;
+constexpr uint8_t kFormatRGBABPTC = 0x0C;
+constexpr uint8_t kFormatAlphaRGTC1 = 0x01;
+
+constexpr uint32_t fourCC(char a, char b, char c, char d) {
+    return (static_cast<uint32_t>(a) << 24) | (static_cast<uint32_t>(b) << 16) |
+           (static_cast<uint32_t>(c) << 8) | static_cast<uint32_t>(d);
+}
+
+// ============================================================================
+// Sections
+// ============================================================================
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+struct Section {
+    uint8_t type = 0;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t total = 0;       // Header and data
+};
+
+/// Section at the start of size bytes: a 24-bit size and a type, or a zero
+/// size followed by a 32-bit one
+bool readSection(const uint8_t* p, size_t size, Section& section) {
+    if (size < 4) {
+        return false;
+    }
+    size_t header = 4;
+    size_t length = static_cast<size_t>(p[0]) | (static_cast<size_t>(p[1]) << 8) |
+                    (static_cast<size_t>(p[2]) << 16);
+    if (length == 0) {
+        if (size < 8) {
+            return false;
+        }
+        length = readU32(p + 4);
+        header = 8;
+    }
+    if (length > size - header) {
+        return false;
+    }
+    section.type = p[3];
+    section.data = p + header;
+    section.size = length;
+    section.total = header + length;
+    return true;
+}
+
+uint8_t textureSectionFormat(HapCodec codec, uint32_t index) {
+    switch (codec) {
+        case HapCodec::Hap:          return kFormatRGBDXT1;
+        case HapCodec::HapAlpha:     return kFormatRGBADXT5;
+        case HapCodec::HapQ:         return kFormatYCoCgDXT5;
+        case HapCodec::HapQAlpha:    return index == 0 ? kFormatYCoCgDXT5 : kFormatAlphaRGTC1;
+        case HapCodec::HapAlphaOnly: return kFormatAlphaRGTC1;
+        case HapCodec::HapR:         return kFormatRGBABPTC;
+        case HapCodec::None:         break;
+    }
+    return 0;
+}
+
+// ============================================================================
+// Snappy
+// ============================================================================
+
+/// Length in the varint preamble of a Snappy block
+bool snappyLength(const uint8_t* p, size_t size, size_t& length, size_t& preamble) {
+    length = 0;
+    for (size_t i = 0; i < size && i < 5; ++i) {
+        length |= static_cast<size_t>(p[i] & 0x7F) << (7 * i);
+        if (!(p[i] & 0x80)) {
+            preamble = i + 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Decompress a raw Snappy block that expands to exactly outputSize bytes
+bool snappyDecompress(const uint8_t* p, size_t size, uint8_t* output, size_t outputSize) {
+    size_t length = 0;
+    size_t preamble = 0;
+    if (!snappyLength(p, size, length, preamble) || length != outputSize) {
+        return false;
+    }
+
+    const uint8_t* in = p + preamble;
+    const uint8_t* end = p + size;
+    uint8_t* out = output;
+    uint8_t* outEnd = output + outputSize;
+    while (in < end) {
+        const uint8_t tag = *in++;
+        size_t count = 0;
+        size_t offset = 0;
+        switch (tag & 3) {
+            case 0: {
+                // Literal: the length is in the tag, or in up to 4 bytes after it
+                count = tag >> 2;
+                if (count >= 60) {
+                    const size_t bytes = count - 59;
+                    if (static_cast<size_t>(end - in) < bytes) {
+                        return false;
+                    }
+                    count = 0;
+                    for (size_t i = 0; i < bytes; ++i) {
+                        count |= static_cast<size_t>(in[i]) << (8 * i);
+                    }
+                    in += bytes;
+                }
+                count += 1;
+                if (static_cast<size_t>(end - in) < count || static_cast<size_t>(outEnd - out) < count) {
+                    return false;
+                }
+                std::memcpy(out, in, count);
+                in += count;
+                out += count;
+                continue;
+            }
+            case 1:
+                if (in >= end) {
+                    return false;
+                }
+                count = ((tag >> 2) & 7) + 4;
+                offset = (static_cast<size_t>(tag >> 5) << 8) | *in++;
+                break;
+            case 2:
+                if (end - in < 2) {
+                    return false;
+                }
+                count = (tag >> 2) + 1;
+                offset = static_cast<size_t>(in[0]) | (static_cast<size_t>(in[1]) << 8);
+                in += 2;
+                break;
+            default:
+                if (end - in < 4) {
+                    return false;
+                }
+                count = (tag >> 2) + 1;
+                offset = readU32(in);
+                in += 4;
+                break;
+        }
+
+        // Copy from earlier output; copies may overlap themselves (runs)
+        if (offset == 0 || offset > static_cast<size_t>(out - output) ||
+            static_cast<size_t>(outEnd - out) < count) {
+            return false;
+        }
+        const uint8_t* from = out - offset;
+        if (offset >= count) {
+            std::memcpy(out, from, count);
+            out += count;
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                *out++ = from[i];
+            }
+        }
+    }
+    return out == outEnd;
+}
+
+// ============================================================================
+// Textures
+// ============================================================================
+
+/// Chunked texture: decode instructions, then the chunks. Chunks expand to
+/// consecutive ranges of the texture and are decompressed in parallel.
+bool decodeChunks(const uint8_t* p, size_t size, uint8_t* output, size_t outputSize) {
+    Section instructions;
+    if (!readSection(p, size, instructions) || instructions.type != kSectionDecodeInstructions) {
+        return false;
+    }
+
+    const uint8_t* compressors = nullptr;
+    const uint8_t* sizes = nullptr;
+    const uint8_t* offsets = nullptr;
+    size_t chunkCount = 0;
+    size_t sizeCount = 0;
+    size_t offsetCount = 0;
+    for (size_t at = 0; at < instructions.size;) {
+        Section table;
+        if (!readSection(instructions.data + at, instructions.size - at, table)) {
+            return false;
+        }
+        if (table.type == kSectionChunkCompressors) {
+            compressors = table.data;
+            chunkCount = table.size;
+        } else if (table.type == kSectionChunkSizes) {
+            sizes = table.data;
+            sizeCount = table.size / 4;
+        } else if (table.type == kSectionChunkOffsets) {
+            offsets = table.data;
+            offsetCount = table.size / 4;
+        }
+        at += table.total;
+    }
+    if (!compressors || !sizes || chunkCount == 0 || sizeCount < chunkCount ||
+        (offsets && offsetCount < chunkCount)) {
+        return false;
+    }
+
+    // Chunk sources and destinations; sizes after decompression come from
+    // the chunks themselves
+    const uint8_t* frameData = p + instructions.total;
+    const size_t frameSize = size - instructions.total;
+    struct Chunk {
+        const uint8_t* data;
+        size_t size;
+        size_t outputOffset;
+        size_t outputSize;
+        bool snappy;
+    };
+    std::vector<Chunk> chunks(chunkCount);
+    size_t position = 0;
+    size_t outputPosition = 0;
+    for (size_t i = 0; i < chunkCount; ++i) {
+        Chunk& chunk = chunks[i];
+        const size_t chunkOffset = offsets ? readU32(offsets + 4 * i) : position;
+        chunk.size = readU32(sizes + 4 * i);
+        if (chunkOffset > frameSize || chunk.size > frameSize - chunkOffset) {
+            return false;
+        }
+        chunk.data = frameData + chunkOffset;
+        chunk.snappy = compressors[i] == kCompressorSnappy;
+        if (chunk.snappy) {
+            size_t preamble = 0;
+            if (!snappyLength(chunk.data, chunk.size, chunk.outputSize, preamble)) {
+                return false;
+            }
+        } else if (compressors[i] == kCompressorNone) {
+            chunk.outputSize = chunk.size;
+        } else {
+            return false;
+        }
+        chunk.outputOffset = outputPosition;
+        outputPosition += chunk.outputSize;
+        position = chunkOffset + chunk.size;
+    }
+    if (outputPosition != outputSize) {
+        return false;
+    }
+
+    std::atomic<bool> ok{true};
+    std::atomic<bool>* result = &ok;
+    Chunk* chunkData = chunks.data();
+    dispatch_apply(chunkCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        const Chunk& chunk = chunkData[i];
+        uint8_t* destination = output + chunk.outputOffset;
+        if (chunk.snappy) {
+            if (!snappyDecompress(chunk.data, chunk.size, destination, chunk.outputSize)) {
+                *result = false;
+            }
+        } else {
+            std::memcpy(destination, chunk.data, chunk.size);
+        }
+    });
+    return ok;
+}
+
+/// Undo a texture section's second stage into exactly outputSize bytes
+bool decodeTexture(const Section& section, uint8_t* output, size_t outputSize) {
+    switch (section.type >> 4) {
+        case kCompressorNone:
+            if (section.size != outputSize) {
+                return false;
+            }
+            std::memcpy(output, section.data, outputSize);
+            return true;
+        case kCompressorSnappy:
+            return snappyDecompress(section.data, section.size, output, outputSize);
+        case kCompressorComplex:
+            return decodeChunks(section.data, section.size, output, outputSize);
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Frame Decoding
+// ============================================================================
+
+HapCodec hapCodecFromFourCC(uint32_t code) {
+    switch (code) {
+        case fourCC('H', 'a', 'p', '1'): return HapCodec::Hap;
+        case fourCC('H', 'a', 'p', '5'): return HapCodec::HapAlpha;
+        case fourCC('H', 'a', 'p', 'Y'): return HapCodec::HapQ;
+        case fourCC('H', 'a', 'p', 'M'): return HapCodec::HapQAlpha;
+        case fourCC('H', 'a', 'p', 'A'): return HapCodec::HapAlphaOnly;
+        case fourCC('H', 'a', 'p', '7'): return HapCodec::HapR;
+        default:                         return HapCodec::None;
+    }
+}
+
+uint32_t hapTextureCount(HapCodec codec) {
+    return codec == HapCodec::HapQAlpha ? 2 : 1;
+}
+
+render::CompressedTextureFormat hapTextureFormat(HapCodec codec, uint32_t index) {
+    switch (textureSectionFormat(codec, index)) {
+        case kFormatRGBDXT1:    return render::CompressedTextureFormat::BC1;
+        case kFormatRGBABPTC:   return render::CompressedTextureFormat::BC7;
+        case kFormatAlphaRGTC1: return render::CompressedTextureFormat::BC4;
+        default:                return render::CompressedTextureFormat::BC3;
+    }
+}
+
+size_t hapFrameBytes(HapCodec codec, uint32_t width, uint32_t height) {
+    size_t bytes = 0;
+    for (uint32_t i = 0; i < hapTextureCount(codec); ++i) {
+        bytes += render::compressedLevelBytes(hapTextureFormat(codec, i), width, height);
+    }
+    return bytes;
+}
+
+bool decodeHapFrame(const uint8_t* data, size_t size, HapCodec codec, uint32_t width, uint32_t height,
+                    uint8_t* output) {
+    if (!data || !output || codec == HapCodec::None) {
+        return false;
+    }
+    Section frame;
+    if (!readSection(data, size, frame)) {
+        return false;
+    }
+
+    // Texture sections: the frame itself, or those in a multiple-image section
+    Section textures[2];
+    uint32_t textureCount = 0;
+    if (frame.type == kSectionMultipleImages) {
+        for (size_t at = 0; at < frame.size && textureCount < 2;) {
+            if (!readSection(frame.data + at, frame.size - at, textures[textureCount])) {
+                return false;
+            }
+            at += textures[textureCount].total;
+            ++textureCount;
+        }
+    } else {
+        textures[0] = frame;
+        textureCount = 1;
+    }
+    if (textureCount != hapTextureCount(codec)) {
+        return false;
+    }
+
+    // Written in the codec's texture order, whatever the order of the sections
+    for (uint32_t i = 0; i < textureCount; ++i) {
+        const uint8_t format = textureSectionFormat(codec, i);
+        const Section* section = nullptr;
+        for (uint32_t j = 0; j < textureCount; ++j) {
+            if ((textures[j].type & 0x0F) == format) {
+                section = &textures[j];
+            }
+        }
+        const size_t bytes = render::compressedLevelBytes(hapTextureFormat(codec, i), width, height);
+        if (!section || !decodeTexture(*section, output, bytes)) {
+            return false;
+        }
+        output += bytes;
+    }
+    return true;
+}
+
+// ============================================================================
+// HapFrameTexture::Impl
+// ============================================================================
+
+struct HapFrameTexture::Impl {
+    HapCodec codec = HapCodec::None;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    void* textures[2] = {nullptr, nullptr};    // Block textures, owned
+    id<MTLTexture> grayView = nil;             // HapAlphaOnly: alpha sampled as gray
+
+    ~Impl() {
+        clear();
+    }
+
+    void clear() {
+        grayView = nil;
+        auto* renderer = Context::instance().renderer();
+        for (void*& texture : textures) {
+            if (texture && renderer) {
+                renderer->destroyTexture(texture);
+            }
+            texture = nullptr;
+        }
+        codec = HapCodec::None;
+        width = 0;
+        height = 0;
+    }
+
+    /// Upload the blocks, creating the textures on the first frame of a shape
+    bool upload(render::IRenderer* renderer, HapCodec newCodec, uint32_t w, uint32_t h, const uint8_t* blocks) {
+        const bool reuse = codec == newCodec && width == w && height == h && textures[0];
+        if (!reuse) {
+            clear();
+        }
+        for (uint32_t i = 0; i < hapTextureCount(newCodec); ++i) {
+            const render::CompressedTextureFormat format = hapTextureFormat(newCodec, i);
+            if (reuse) {
+                const size_t bytesPerRow = ((w + 3) / 4) * render::compressedBlockBytes(format);
+                if (!renderer->updateTexture(textures[i], 0, 0, w, h, blocks, bytesPerRow)) {
+                    return false;
+                }
+            } else {
+                const void* level = blocks;
+                textures[i] = renderer->createCompressedTexture(w, h, format, &level, 1);
+                if (!textures[i]) {
+                    clear();
+                    return false;
+                }
+            }
+            blocks += render::compressedLevelBytes(format, w, h);
+        }
+        codec = newCodec;
+        width = w;
+        height = h;
+        return true;
+    }
+
+    bool show(ofTexture& texture) {
+        switch (codec) {
+            case HapCodec::HapQ:
+            case HapCodec::HapQAlpha: {
+                if (!texture.allocateWritable(static_cast<int>(width), static_cast<int>(height))) {
+                    return false;
+                }
+                render::ConvertYCoCgCommand cmd;
+                cmd.color = textures[0];
+                cmd.alpha = codec == HapCodec::HapQAlpha ? textures[1] : nullptr;
+                cmd.destination = texture.getNativeHandle();
+                Context::instance().getDrawList().addCommand(cmd);
+                return true;
+            }
+            case HapCodec::HapAlphaOnly:
+                if (!grayView) {
+                    id<MTLTexture> blocks = (__bridge id<MTLTexture>)textures[0];
+                    const MTLTextureSwizzleChannels gray = MTLTextureSwizzleChannelsMake(
+                        MTLTextureSwizzleRed, MTLTextureSwizzleRed, MTLTextureSwizzleRed, MTLTextureSwizzleOne);
+                    grayView = [blocks newTextureViewWithPixelFormat:blocks.pixelFormat
+                                                         textureType:MTLTextureType2D
+                                                              levels:NSMakeRange(0, 1)
+                                                              slices:NSMakeRange(0, 1)
+                                                             swizzle:gray];
+                }
+                return grayView && texture.setNativeHandle((__bridge void*)grayView);
+            default:
+                return texture.setNativeHandle(textures[0]);
+        }
+    }
+};
+
+// ============================================================================
+// HapFrameTexture
+// ============================================================================
+
+HapFrameTexture::HapFrameTexture()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+HapFrameTexture::~HapFrameTexture() = default;
+
+bool HapFrameTexture::isSupported(HapCodec codec) {
+    auto* renderer = Context::instance().renderer();
+    if (!renderer || codec == HapCodec::None) {
+        return false;
+    }
+    for (uint32_t i = 0; i < hapTextureCount(codec); ++i) {
+        if (!renderer->supportsCompressedTextureFormat(hapTextureFormat(codec, i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool HapFrameTexture::setFrame(HapCodec codec, uint32_t width, uint32_t height, const uint8_t* blocks,
+                               ofTexture& texture) {
+    auto* renderer = Context::instance().renderer();
+    if (!renderer || !blocks || codec == HapCodec::None || width == 0 || height == 0) {
+        return false;
+    }
+
+    @autoreleasepool {
+        return impl_->upload(renderer, codec, width, height, blocks) && impl_->show(texture);
+    }
+}
+
+void HapFrameTexture::clear() {
+    impl_->clear();
+}
+
+} // namespace oflike
@@ -0,0 +1,56 @@
+#pragma once
+
+// oflike-metal VideoFrameTexture - decoded video frames drawn through an ofTexture
+// Shared by the video players and grabbers, which all wrap their frames
+// through one process-wide CVMetalTextureCache. BGRA frames are sampled straight
+// from their IOSurfaces and bi-planar 4:2:0 YCbCr frames (420v/420f) are
+// converted to RGBA on the GPU, so frames never pass through the CPU; RGBA
+// pixels are only made when asked for. One-component buffers (masks and
+// depth maps from Vision and Core ML) are sampled in place as grayscale
+
+#include <cstdint>
+#include <memory>
+#include "../image/ofTexture.h"
+#include "../image/ofPixels.h"
+
+namespace oflike {
+
+class VideoFrameTexture {
+public:
+    VideoFrameTexture();
+    ~VideoFrameTexture();
+
+    VideoFrameTexture(const VideoFrameTexture&) = delete;
+    VideoFrameTexture& operator=(const VideoFrameTexture&) = delete;
+
+    /// \brief Show a new frame
+    /// \details Call on the main thread. The buffer is retained until the next
+    /// frame or clear(), and wrapped frames stay alive while frames in flight
+    /// may sample them. YCbCr frames are converted into a writable texture in
+    /// order with the frame's draws. Buffers Metal can't wrap are converted
+    /// and uploaded on the CPU instead.
+    /// \param pixelBuffer CVPixelBufferRef in a format isSupportedFormat() accepts
+    /// \param texture Texture that draws the frame
+    void setFrame(void* pixelBuffer, ofTexture& texture);
+
+    /// \brief Check if setFrame() takes buffers of a pixel format
+    /// \details 32BGRA, 420YpCbCr8BiPlanar (video or full range) and
+    /// OneComponent8/16Half/32Float. Float components keep their values:
+    /// they are neither normalized nor clamped when sampled.
+    /// \param pixelFormat CoreVideo pixel format (OSType)
+    static bool isSupportedFormat(uint32_t pixelFormat);
+
+    /// \brief RGBA pixels of the current frame
+    /// \details Converted on the CPU on the first call after each frame;
+    /// empty before the first frame.
+    ofPixels& getPixels();
+
+    /// \brief Release the current frame and the wrapped textures
+    void clear();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
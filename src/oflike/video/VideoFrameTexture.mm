@@ -0,0 +1,365 @@
+// VideoFrameTexture.mm - Zero-copy video frames through CVMetalTextureCache
+
+#import <Foundation/Foundation.h>
+#import <CoreVideo/CoreVideo.h>
+#import <Metal/Metal.h>
+#import <Accelerate/Accelerate.h>
+
+#include <vector>
+
+#include "VideoFrameTexture.h"
+#include "../image/ofPixelConvert.h"
+#include "../../core/Context.h"
+#include "../../render/DrawCommand.h"
+#include "../../render/DrawList.h"
+
+namespace oflike {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+// Wrapped frames kept alive: the one drawn now plus those the frames in
+// flight may still be sampling
+static constexpr size_t kFrameTextures = 4;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+namespace {
+
+bool IsBiPlanarYCbCr(OSType format) {
+    return format == kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange ||
+           format == kCVPixelFormatType_420YpCbCr8BiPlanarFullRange;
+}
+
+/// Metal format of a one-component buffer, Invalid for other buffers
+MTLPixelFormat OneComponentFormat(OSType format) {
+    switch (format) {
+        case kCVPixelFormatType_OneComponent8:
+            return MTLPixelFormatR8Unorm;
+        case kCVPixelFormatType_OneComponent16Half:
+            return MTLPixelFormatR16Float;
+        case kCVPixelFormatType_OneComponent32Float:
+            return MTLPixelFormatR32Float;
+        default:
+            return MTLPixelFormatInvalid;
+    }
+}
+
+/// Color matrix tagged on the buffer; untagged frames follow the usual
+/// SD/HD convention
+render::YCbCrMatrix GetYCbCrMatrix(CVPixelBufferRef buffer) {
+    render::YCbCrMatrix matrix = CVPixelBufferGetHeight(buffer) >= 720
+        ? render::YCbCrMatrix::BT709 : render::YCbCrMatrix::BT601;
+    CFTypeRef tag = CVBufferCopyAttachment(buffer, kCVImageBufferYCbCrMatrixKey, nullptr);
+    if (tag) {
+        if (CFEqual(tag, kCVImageBufferYCbCrMatrix_ITU_R_709_2)) {
+            matrix = render::YCbCrMatrix::BT709;
+        } else if (CFEqual(tag, kCVImageBufferYCbCrMatrix_ITU_R_601_4)) {
+            matrix = render::YCbCrMatrix::BT601;
+        }
+        CFRelease(tag);
+    }
+    return matrix;
+}
+
+/// One texture cache for every player, grabber and clip: the wrapped
+/// textures of all their frames come from and return to the same pool.
+/// Main thread only.
+CVMetalTextureCacheRef SharedTextureCache() {
+    static CVMetalTextureCacheRef cache = nullptr;
+    static bool unavailable = false;
+    if (cache || unavailable) {
+        return cache;
+    }
+    void* devicePtr = Context::instance().getMetalDevice();
+    if (!devicePtr) {
+        return nullptr;    // Retried once the renderer exists
+    }
+    if (CVMetalTextureCacheCreate(kCFAllocatorDefault, nil, (__bridge id<MTLDevice>)devicePtr, nil,
+                                  &cache) != kCVReturnSuccess) {
+        cache = nullptr;
+        unavailable = true;
+        NSLog(@"VideoFrameTexture: Metal texture cache unavailable, copying frames");
+    }
+    return cache;
+}
+
+} // namespace
+
+// ============================================================================
+// VideoFrameTexture::Impl
+// ============================================================================
+
+struct VideoFrameTexture::Impl {
+    CVMetalTextureCacheRef textureCache = nullptr;    // Shared, not owned
+
+    // Per frame: the BGRA texture, or the luma and chroma planes; and the
+    // grayscale view of a one-component frame
+    CVMetalTextureRef frameTextures[kFrameTextures][2] = {};
+    id<MTLTexture> frameViews[kFrameTextures] = {};
+    size_t frameIndex = 0;
+
+    CVPixelBufferRef currentBuffer = nullptr;
+    ofPixels pixels;
+    bool pixelsDirty = false;
+
+    ~Impl() {
+        clear();
+    }
+
+    void clear() {
+        for (auto& frame : frameTextures) {
+            for (CVMetalTextureRef& plane : frame) {
+                if (plane) {
+                    CFRelease(plane);
+                    plane = nullptr;
+                }
+            }
+        }
+        for (id<MTLTexture>& view : frameViews) {
+            view = nil;
+        }
+        frameIndex = 0;
+        if (currentBuffer) {
+            CVPixelBufferRelease(currentBuffer);
+            currentBuffer = nullptr;
+        }
+        pixels.clear();
+        pixelsDirty = false;
+    }
+
+    bool ensureCache() {
+        if (!textureCache) {
+            textureCache = SharedTextureCache();
+        }
+        return textureCache != nullptr;
+    }
+
+    CVMetalTextureRef wrapPlane(CVPixelBufferRef buffer, size_t plane, MTLPixelFormat format) {
+        const bool planar = CVPixelBufferIsPlanar(buffer);
+        CVMetalTextureRef texture = nullptr;
+        CVReturn status = CVMetalTextureCacheCreateTextureFromImage(
+            kCFAllocatorDefault, textureCache, buffer, nil, format,
+            planar ? CVPixelBufferGetWidthOfPlane(buffer, plane) : CVPixelBufferGetWidth(buffer),
+            planar ? CVPixelBufferGetHeightOfPlane(buffer, plane) : CVPixelBufferGetHeight(buffer),
+            plane, &texture);
+        if (status != kCVReturnSuccess || !texture) {
+            return nullptr;
+        }
+        if (!CVMetalTextureGetTexture(texture)) {
+            CFRelease(texture);
+            return nullptr;
+        }
+        return texture;
+    }
+
+    // Keep a frame's textures until kFrameTextures newer frames have replaced them
+    void keepFrame(CVMetalTextureRef first, CVMetalTextureRef second, id<MTLTexture> view = nil) {
+        frameIndex = (frameIndex + 1) % kFrameTextures;
+        for (CVMetalTextureRef& plane : frameTextures[frameIndex]) {
+            if (plane) {
+                CFRelease(plane);
+            }
+        }
+        frameTextures[frameIndex][0] = first;
+        frameTextures[frameIndex][1] = second;
+        frameViews[frameIndex] = view;
+        CVMetalTextureCacheFlush(textureCache, 0);
+    }
+
+    // BGRA textures sample as RGBA; the frame is drawn in place
+    bool showBGRA(CVPixelBufferRef buffer, ofTexture& texture) {
+        CVMetalTextureRef frame = wrapPlane(buffer, 0, MTLPixelFormatBGRA8Unorm);
+        if (!frame) {
+            return false;
+        }
+        if (!texture.setNativeHandle((__bridge void*)CVMetalTextureGetTexture(frame))) {
+            CFRelease(frame);
+            return false;
+        }
+        keepFrame(frame, nullptr);
+        return true;
+    }
+
+    // One-component frames are drawn in place through a view that samples
+    // the component as gray, like grayscale ofTextures
+    bool showOneComponent(CVPixelBufferRef buffer, ofTexture& texture) {
+        const MTLPixelFormat format = OneComponentFormat(CVPixelBufferGetPixelFormatType(buffer));
+        CVMetalTextureRef frame = wrapPlane(buffer, 0, format);
+        if (!frame) {
+            return false;
+        }
+        const MTLTextureSwizzleChannels gray = MTLTextureSwizzleChannelsMake(
+            MTLTextureSwizzleRed, MTLTextureSwizzleRed, MTLTextureSwizzleRed, MTLTextureSwizzleOne);
+        id<MTLTexture> view = [CVMetalTextureGetTexture(frame) newTextureViewWithPixelFormat:format
+                                                                                 textureType:MTLTextureType2D
+                                                                                      levels:NSMakeRange(0, 1)
+                                                                                      slices:NSMakeRange(0, 1)
+                                                                                     swizzle:gray];
+        if (!view || !texture.setNativeHandle((__bridge void*)view)) {
+            CFRelease(frame);
+            return false;
+        }
+        keepFrame(frame, nullptr, view);
+        return true;
+    }
+
+    // Luma (R8) and chroma (RG8) planes are converted into the texture
+    bool showYCbCr(CVPixelBufferRef buffer, ofTexture& texture) {
+        CVMetalTextureRef luma = wrapPlane(buffer, 0, MTLPixelFormatR8Unorm);
+        CVMetalTextureRef chroma = luma ? wrapPlane(buffer, 1, MTLPixelFormatRG8Unorm) : nullptr;
+        const int w = static_cast<int>(CVPixelBufferGetWidth(buffer));
+        const int h = static_cast<int>(CVPixelBufferGetHeight(buffer));
+        if (!chroma || !texture.allocateWritable(w, h)) {
+            if (luma) CFRelease(luma);
+            if (chroma) CFRelease(chroma);
+            return false;
+        }
+
+        render::ConvertYCbCrCommand cmd;
+        cmd.luma = (__bridge void*)CVMetalTextureGetTexture(luma);
+        cmd.chroma = (__bridge void*)CVMetalTextureGetTexture(chroma);
+        cmd.destination = texture.getNativeHandle();
+        cmd.matrix = GetYCbCrMatrix(buffer);
+        cmd.fullRange = CVPixelBufferGetPixelFormatType(buffer) == kCVPixelFormatType_420YpCbCr8BiPlanarFullRange;
+        Context::instance().getDrawList().addCommand(cmd);
+
+        keepFrame(luma, chroma);
+        return true;
+    }
+
+    // Convert the current frame into RGBA pixels
+    void readPixels() {
+        if (!pixelsDirty || !currentBuffer) {
+            return;
+        }
+        pixelsDirty = false;
+
+        CVPixelBufferLockBaseAddress(currentBuffer, kCVPixelBufferLock_ReadOnly);
+        const size_t w = CVPixelBufferGetWidth(currentBuffer);
+        const size_t h = CVPixelBufferGetHeight(currentBuffer);
+        if (pixels.getWidth() != w || pixels.getHeight() != h || pixels.getNumChannels() != 4) {
+            pixels.allocate(w, h, 4);
+        }
+        vImage_Buffer dst = {pixels.getData(), static_cast<vImagePixelCount>(h),
+                             static_cast<vImagePixelCount>(w), pixels.getBytesStride()};
+
+        const OSType format = CVPixelBufferGetPixelFormatType(currentBuffer);
+        if (IsBiPlanarYCbCr(format)) {
+            const bool fullRange = format == kCVPixelFormatType_420YpCbCr8BiPlanarFullRange;
+            vImage_YpCbCrPixelRange range = fullRange
+                ? vImage_YpCbCrPixelRange{0, 128, 255, 255, 255, 1, 255, 0}
+                : vImage_YpCbCrPixelRange{16, 128, 235, 240, 235, 16, 240, 16};
+            const vImage_YpCbCrToARGBMatrix* matrix = GetYCbCrMatrix(currentBuffer) == render::YCbCrMatrix::BT709
+                ? kvImage_YpCbCrToARGBMatrix_ITU_R_709_2 : kvImage_YpCbCrToARGBMatrix_ITU_R_601_4;
+            vImage_YpCbCrToARGB info;
+            vImage_Buffer luma = {CVPixelBufferGetBaseAddressOfPlane(currentBuffer, 0),
+                                  static_cast<vImagePixelCount>(CVPixelBufferGetHeightOfPlane(currentBuffer, 0)),
+                                  static_cast<vImagePixelCount>(CVPixelBufferGetWidthOfPlane(currentBuffer, 0)),
+                                  CVPixelBufferGetBytesPerRowOfPlane(currentBuffer, 0)};
+            vImage_Buffer chroma = {CVPixelBufferGetBaseAddressOfPlane(currentBuffer, 1),
+                                    static_cast<vImagePixelCount>(CVPixelBufferGetHeightOfPlane(currentBuffer, 1)),
+                                    static_cast<vImagePixelCount>(CVPixelBufferGetWidthOfPlane(currentBuffer, 1)),
+                                    CVPixelBufferGetBytesPerRowOfPlane(currentBuffer, 1)};
+            const uint8_t argbToRgba[4] = {1, 2, 3, 0};
+            if (vImageConvert_YpCbCrToARGB_GenerateConversion(matrix, &range, &info, kvImage420Yp8_CbCr8,
+                                                              kvImageARGB8888, kvImageNoFlags) == kvImageNoError) {
+                vImageConvert_420Yp8_CbCr8ToARGB8888(&luma, &chroma, &dst, &info, argbToRgba, 255,
+                                                     kvImageNoFlags);
+            }
+        } else if (OneComponentFormat(format) != MTLPixelFormatInvalid) {
+            readOneComponent(format, dst);
+        } else {
+            ofPixelConvert::bgraToRGBA(static_cast<const uint8_t*>(CVPixelBufferGetBaseAddress(currentBuffer)),
+                                       CVPixelBufferGetBytesPerRow(currentBuffer),
+                                       static_cast<uint8_t*>(dst.data), dst.rowBytes, w, h);
+        }
+
+        CVPixelBufferUnlockBaseAddress(currentBuffer, kCVPixelBufferLock_ReadOnly);
+    }
+
+    // Gray RGBA from the locked one-component buffer; floats are clamped to 0-1
+    void readOneComponent(OSType format, const vImage_Buffer& dst) {
+        const size_t w = CVPixelBufferGetWidth(currentBuffer);
+        const size_t h = CVPixelBufferGetHeight(currentBuffer);
+        vImage_Buffer src = {CVPixelBufferGetBaseAddress(currentBuffer), static_cast<vImagePixelCount>(h),
+                             static_cast<vImagePixelCount>(w), CVPixelBufferGetBytesPerRow(currentBuffer)};
+        std::vector<uint8_t> gray;
+        if (format != kCVPixelFormatType_OneComponent8) {
+            gray.resize(w * h);
+            vImage_Buffer planar = {gray.data(), static_cast<vImagePixelCount>(h),
+                                    static_cast<vImagePixelCount>(w), w};
+            if (format == kCVPixelFormatType_OneComponent16Half) {
+                vImageConvert_Planar16FtoPlanar8(&src, &planar, kvImageNoFlags);
+            } else {
+                vImageConvert_PlanarFtoPlanar8(&src, &planar, 1.0f, 0.0f, kvImageNoFlags);
+            }
+            src = planar;
+        }
+        ofPixelConvert::grayToRGBA(static_cast<const uint8_t*>(src.data), src.rowBytes,
+                                   static_cast<uint8_t*>(dst.data), dst.rowBytes, w, h);
+    }
+};
+
+// ============================================================================
+// VideoFrameTexture
+// ============================================================================
+
+VideoFrameTexture::VideoFrameTexture()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+VideoFrameTexture::~VideoFrameTexture() = default;
+
+void VideoFrameTexture::setFrame(void* pixelBuffer, ofTexture& texture) {
+    if (!pixelBuffer) {
+        return;
+    }
+
+    @autoreleasepool {
+        CVPixelBufferRef buffer = static_cast<CVPixelBufferRef>(pixelBuffer);
+        CVPixelBufferRetain(buffer);
+        if (impl_->currentBuffer) {
+            CVPixelBufferRelease(impl_->currentBuffer);
+        }
+        impl_->currentBuffer = buffer;
+        impl_->pixelsDirty = true;
+
+        const OSType format = CVPixelBufferGetPixelFormatType(buffer);
+        bool shown = false;
+        if (impl_->ensureCache()) {
+            if (format == kCVPixelFormatType_32BGRA) {
+                shown = impl_->showBGRA(buffer, texture);
+            } else if (IsBiPlanarYCbCr(format)) {
+                shown = impl_->showYCbCr(buffer, texture);
+            } else if (OneComponentFormat(format) != MTLPixelFormatInvalid) {
+                shown = impl_->showOneComponent(buffer, texture);
+            }
+        }
+
+        // Fallback: convert and upload the frame
+        if (!shown) {
+            impl_->readPixels();
+            texture.loadData(impl_->pixels);
+        }
+    }
+}
+
+bool VideoFrameTexture::isSupportedFormat(uint32_t pixelFormat) {
+    return pixelFormat == kCVPixelFormatType_32BGRA || IsBiPlanarYCbCr(pixelFormat) ||
+           OneComponentFormat(pixelFormat) != MTLPixelFormatInvalid;
+}
+
+ofPixels& VideoFrameTexture::getPixels() {
+    impl_->readPixels();
+    return impl_->pixels;
+}
+
+void VideoFrameTexture::clear() {
+    impl_->clear();
+}
+
+} // namespace oflike
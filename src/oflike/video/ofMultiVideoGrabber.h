@@ -0,0 +1,126 @@
+#pragma once
+
+// oflike-metal ofMultiVideoGrabber - several cameras delivering matched frames
+// Captures from multiple cameras at once and hands update() one frame per
+// camera, picked so that their capture times are as close as possible
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "../image/ofTexture.h"
+#include "../image/ofPixels.h"
+
+namespace oflike {
+
+/// \brief Synchronized capture from several cameras
+/// \details Each camera runs its own capture session; all of them deliver
+/// frames on one shared serial queue, and frames reach update() through a
+/// lock-free handoff per camera. update() keeps the last few frames of each
+/// camera and forms a set around the newest time every camera has reached,
+/// taking from each the frame captured closest to it, so a set never mixes
+/// a fresh frame from one camera with a stale one from another.
+///
+/// Frames are drawn from their capture buffers like ofVideoGrabber's
+/// (YCbCr converted on the GPU), so no frame passes through the CPU unless
+/// getPixels() asks for it.
+///
+/// Example:
+/// \code
+///     ofMultiVideoGrabber cameras;
+///     cameras.addDevice(0);
+///     cameras.addDevice(1);
+///     cameras.setup(1280, 720);
+///
+///     // In update()
+///     cameras.update();
+///
+///     // In draw()
+///     cameras.draw(0, 0, 0);
+///     cameras.draw(1, 640, 0);
+/// \endcode
+class ofMultiVideoGrabber {
+public:
+    ofMultiVideoGrabber();
+    ~ofMultiVideoGrabber();
+
+    ofMultiVideoGrabber(const ofMultiVideoGrabber&) = delete;
+    ofMultiVideoGrabber& operator=(const ofMultiVideoGrabber&) = delete;
+
+    // ========================================================================
+    // Setup & Configuration
+    // ========================================================================
+
+    /// \brief Add a camera by index (from ofVideoGrabber::listDevices())
+    /// \details Takes effect on the next setup().
+    void addDevice(int deviceID);
+
+    /// \brief Add a camera by unique ID
+    void addDevice(const std::string& uniqueID);
+
+    /// \brief Set the frame rate requested from every camera
+    void setDesiredFrameRate(float framerate);
+
+    /// \brief Open and start every added camera
+    /// \param w Requested width (each camera picks its closest format)
+    /// \param h Requested height
+    /// \return true if all cameras started; on failure none are left running
+    bool setup(int w, int h);
+
+    /// \brief Stop all cameras and release their frames
+    void close();
+
+    /// \brief Check if the cameras are running
+    bool isInitialized() const;
+
+    /// \brief Number of cameras added
+    size_t getNumCameras() const;
+
+    // ========================================================================
+    // Frame Update
+    // ========================================================================
+
+    /// \brief Collect new frames and pick the best matched set
+    /// \details Must be called every frame. A set forms once every camera
+    /// has delivered a frame.
+    void update();
+
+    /// \brief Check if update() picked a new set
+    bool isFrameNew() const;
+
+    /// \brief Capture time of a camera's frame in the current set
+    /// \return Seconds on the host clock (CACurrentMediaTime()), or 0
+    double getFrameTimestamp(size_t camera) const;
+
+    /// \brief Spread of capture times within the current set
+    /// \return Milliseconds between the earliest and latest frame
+    float getSyncSpreadMs() const;
+
+    // ========================================================================
+    // Drawing & Access
+    // ========================================================================
+
+    /// \brief Draw a camera's frame at position
+    void draw(size_t camera, float x, float y) const;
+
+    /// \brief Draw a camera's frame at position with size
+    void draw(size_t camera, float x, float y, float w, float h) const;
+
+    /// \brief Texture showing a camera's frame of the current set
+    /// \details Out-of-range cameras get an empty texture.
+    ofTexture& getTexture(size_t camera);
+
+    /// \brief RGBA pixels of a camera's frame, converted on the CPU on first use
+    ofPixels& getPixels(size_t camera);
+
+    /// \brief Capture width of a camera
+    float getWidth(size_t camera) const;
+
+    /// \brief Capture height of a camera
+    float getHeight(size_t camera) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
@@ -0,0 +1,310 @@
+#import "ofMultiVideoGrabber.h"
+#import <AVFoundation/AVFoundation.h>
+#import <CoreVideo/CoreVideo.h>
+#import "CaptureSupport.h"
+#import "VideoFrameTexture.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace oflike {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+// Recent frames kept per camera to match against. Each one holds a buffer
+// from the camera's pool, so this stays small.
+static constexpr size_t kFrameHistory = 3;
+
+// ============================================================================
+// ofMultiVideoGrabber::Impl
+// ============================================================================
+
+struct ofMultiVideoGrabber::Impl {
+    struct Camera {
+        int deviceID = -1;
+        std::string uniqueID;
+
+        AVCaptureDevice* device = nil;
+        CaptureStream stream;
+
+        // Retained recent frames, oldest first
+        CaptureFrame history[kFrameHistory];
+        size_t historyCount = 0;
+
+        // Frame of the current set (pools recycle buffers, so the capture
+        // time tells frames apart)
+        CVPixelBufferRef shown = nullptr;
+        double shownTime = 0.0;
+
+        ofTexture texture;
+        VideoFrameTexture frames;
+        int width = 0;
+        int height = 0;
+
+        void remember(const CaptureFrame& frame) {
+            if (historyCount == kFrameHistory) {
+                CVPixelBufferRelease(history[0].buffer);
+                std::move(history + 1, history + kFrameHistory, history);
+                historyCount--;
+            }
+            history[historyCount++] = {CVPixelBufferRetain(frame.buffer), frame.captureTime};
+        }
+
+        void forget() {
+            for (size_t i = 0; i < historyCount; ++i) {
+                CVPixelBufferRelease(history[i].buffer);
+                history[i] = CaptureFrame();
+            }
+            historyCount = 0;
+            shown = nullptr;
+            shownTime = 0.0;
+        }
+    };
+
+    std::vector<std::unique_ptr<Camera>> cameras;
+    dispatch_queue_t captureQueue = nullptr;
+    float desiredFrameRate = 30.0f;
+
+    bool initialized = false;
+    bool frameNew = false;
+    float syncSpreadMs = 0.0f;
+
+    ofTexture emptyTexture;
+    ofPixels emptyPixels;
+
+    ~Impl() {
+        close();
+    }
+
+    void close() {
+        @autoreleasepool {
+            for (auto& entry : cameras) {
+                Camera& camera = *entry;
+                closeCaptureStream(camera.stream);
+                camera.device = nil;
+                camera.forget();
+                camera.texture.clear();
+                camera.frames.clear();
+                camera.width = 0;
+                camera.height = 0;
+            }
+            initialized = false;
+            frameNew = false;
+            syncSpreadMs = 0.0f;
+        }
+    }
+
+    // Pick each camera's frame closest to the newest time all have reached
+    void matchFrames() {
+        double reference = INFINITY;
+        for (const auto& camera : cameras) {
+            if (camera->historyCount == 0) {
+                return;
+            }
+            reference = std::min(reference, camera->history[camera->historyCount - 1].captureTime);
+        }
+
+        double earliest = INFINITY;
+        double latest = -INFINITY;
+        for (auto& entry : cameras) {
+            Camera& camera = *entry;
+            const CaptureFrame* best = &camera.history[0];
+            for (size_t i = 1; i < camera.historyCount; ++i) {
+                if (std::abs(camera.history[i].captureTime - reference) <
+                    std::abs(best->captureTime - reference)) {
+                    best = &camera.history[i];
+                }
+            }
+
+            if (best->buffer != camera.shown || best->captureTime != camera.shownTime) {
+                camera.shown = best->buffer;
+                camera.shownTime = best->captureTime;
+                camera.frames.setFrame(best->buffer, camera.texture);
+                camera.width = static_cast<int>(CVPixelBufferGetWidth(best->buffer));
+                camera.height = static_cast<int>(CVPixelBufferGetHeight(best->buffer));
+                frameNew = true;
+            }
+            earliest = std::min(earliest, camera.shownTime);
+            latest = std::max(latest, camera.shownTime);
+        }
+        syncSpreadMs = static_cast<float>((latest - earliest) * 1000.0);
+    }
+
+    Camera* camera(size_t index) {
+        return index < cameras.size() ? cameras[index].get() : nullptr;
+    }
+
+    const Camera* camera(size_t index) const {
+        return index < cameras.size() ? cameras[index].get() : nullptr;
+    }
+};
+
+// ============================================================================
+// ofMultiVideoGrabber Implementation
+// ============================================================================
+
+ofMultiVideoGrabber::ofMultiVideoGrabber()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ofMultiVideoGrabber::~ofMultiVideoGrabber() = default;
+
+// ============================================================================
+// Setup & Configuration
+// ============================================================================
+
+void ofMultiVideoGrabber::addDevice(int deviceID) {
+    impl_->cameras.push_back(std::make_unique<Impl::Camera>());
+    impl_->cameras.back()->deviceID = deviceID;
+}
+
+void ofMultiVideoGrabber::addDevice(const std::string& uniqueID) {
+    impl_->cameras.push_back(std::make_unique<Impl::Camera>());
+    impl_->cameras.back()->uniqueID = uniqueID;
+}
+
+void ofMultiVideoGrabber::setDesiredFrameRate(float framerate) {
+    impl_->desiredFrameRate = std::max(1.0f, framerate);
+}
+
+bool ofMultiVideoGrabber::setup(int w, int h) {
+    close();
+
+    if (impl_->cameras.empty()) {
+        NSLog(@"ofMultiVideoGrabber: No cameras added");
+        return false;
+    }
+
+    @autoreleasepool {
+        // One queue for every camera, so deliveries are serialized and
+        // arrive in capture order across cameras
+        if (!impl_->captureQueue) {
+            impl_->captureQueue = dispatch_queue_create("com.oflike.multiCapture", DISPATCH_QUEUE_SERIAL);
+        }
+
+        for (size_t i = 0; i < impl_->cameras.size(); ++i) {
+            Impl::Camera& camera = *impl_->cameras[i];
+
+            camera.device = findCaptureDevice(camera.deviceID, camera.uniqueID);
+            for (size_t j = 0; camera.device && j < i; ++j) {
+                if ([impl_->cameras[j]->device.uniqueID isEqualToString:camera.device.uniqueID]) {
+                    camera.device = nil;    // Fallback picked a camera already in use
+                }
+            }
+            if (!camera.device) {
+                NSLog(@"ofMultiVideoGrabber: Camera %zu not available", i);
+                impl_->close();
+                return false;
+            }
+
+            camera.width = w;
+            camera.height = h;
+            configureCaptureDevice(camera.device, w, h, impl_->desiredFrameRate, camera.width, camera.height);
+
+            if (!openCaptureStream(camera.device, impl_->captureQueue, camera.stream)) {
+                NSLog(@"ofMultiVideoGrabber: Failed to open camera %zu", i);
+                impl_->close();
+                return false;
+            }
+
+            camera.texture.allocateStreaming(camera.width, camera.height, OF_IMAGE_COLOR_ALPHA);
+        }
+
+        for (const auto& camera : impl_->cameras) {
+            [camera->stream.session startRunning];
+            NSLog(@"ofMultiVideoGrabber: Started capture %dx%d from %@",
+                  camera->width, camera->height, [camera->device localizedName]);
+        }
+        impl_->initialized = true;
+        return true;
+    }
+}
+
+void ofMultiVideoGrabber::close() {
+    impl_->close();
+}
+
+bool ofMultiVideoGrabber::isInitialized() const {
+    return impl_->initialized;
+}
+
+size_t ofMultiVideoGrabber::getNumCameras() const {
+    return impl_->cameras.size();
+}
+
+// ============================================================================
+// Frame Update
+// ============================================================================
+
+void ofMultiVideoGrabber::update() {
+    if (!impl_->initialized) return;
+
+    impl_->frameNew = false;
+
+    @autoreleasepool {
+        bool arrived = false;
+        for (const auto& camera : impl_->cameras) {
+            CaptureFrame frame;
+            if (camera->stream.delegate && [camera->stream.delegate frames]->take(frame)) {
+                camera->remember(frame);
+                arrived = true;
+            }
+        }
+        if (arrived) {
+            impl_->matchFrames();
+        }
+    }
+}
+
+bool ofMultiVideoGrabber::isFrameNew() const {
+    return impl_->frameNew;
+}
+
+double ofMultiVideoGrabber::getFrameTimestamp(size_t camera) const {
+    const Impl::Camera* c = impl_->camera(camera);
+    return c ? c->shownTime : 0.0;
+}
+
+float ofMultiVideoGrabber::getSyncSpreadMs() const {
+    return impl_->syncSpreadMs;
+}
+
+// ============================================================================
+// Drawing & Access
+// ============================================================================
+
+void ofMultiVideoGrabber::draw(size_t camera, float x, float y) const {
+    const Impl::Camera* c = impl_->camera(camera);
+    if (!impl_->initialized || !c) return;
+    c->texture.draw(x, y);
+}
+
+void ofMultiVideoGrabber::draw(size_t camera, float x, float y, float w, float h) const {
+    const Impl::Camera* c = impl_->camera(camera);
+    if (!impl_->initialized || !c) return;
+    c->texture.draw(x, y, w, h);
+}
+
+ofTexture& ofMultiVideoGrabber::getTexture(size_t camera) {
+    Impl::Camera* c = impl_->camera(camera);
+    return c ? c->texture : impl_->emptyTexture;
+}
+
+ofPixels& ofMultiVideoGrabber::getPixels(size_t camera) {
+    Impl::Camera* c = impl_->camera(camera);
+    return c ? c->frames.getPixels() : impl_->emptyPixels;
+}
+
+float ofMultiVideoGrabber::getWidth(size_t camera) const {
+    const Impl::Camera* c = impl_->camera(camera);
+    return c ? static_cast<float>(c->width) : 0.0f;
+}
+
+float ofMultiVideoGrabber::getHeight(size_t camera) const {
+    const Impl::Camera* c = impl_->camera(camera);
+    return c ? static_cast<float>(c->height) : 0.0f;
+}
+
+} // namespace oflike
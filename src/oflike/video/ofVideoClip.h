@@ -0,0 +1,216 @@
+#pragma once
+
+// oflike-metal ofVideoClip - frame-accurate clip playback for VJ and playback rigs
+// Decodes ahead of the playhead with AVAssetReader on a background queue, so
+// many clips can play, seek, scrub and run backwards at once
+
+#include <string>
+#include <memory>
+#include "ofVideoPlayer.h"
+#include "../image/ofTexture.h"
+#include "../image/ofPixels.h"
+
+namespace oflike {
+
+/// \brief Silent video clip with a decode-ahead frame queue
+/// \details ofVideoClip complements ofVideoPlayer for setups that drive many
+/// clips at once. Instead of an AVPlayer per clip, each clip reads its video
+/// track with AVAssetReader on its own background queue and keeps a window of
+/// decoded frames around the playhead:
+/// - Up to queue depth frames are decoded ahead in the playing direction, and
+///   as many frames behind the playhead are kept, so scrubbing back and forth
+///   over recent frames never decodes again
+/// - Forward playback reads the track sequentially with a single reader;
+///   reverse playback decodes a queue depth of frames per reader, so each
+///   group of pictures is decoded once per chunk rather than once per frame
+/// - Every frame is addressed by its presentation time, so setFrame() shows
+///   exactly that frame
+///
+/// Frames are drawn from the decoder's IOSurfaces (YCbCr converted on the
+/// GPU) through the texture cache shared by all players, so decoded frames
+/// never pass through the CPU. Audio is not played; use ofVideoPlayer for
+/// clips with sound.
+///
+/// HAP clips (HAP, HAP Alpha, HAP Q, HAP Q Alpha, HAP Alpha-Only, HAP R) skip
+/// the system decoder: samples are read as stored, their Snappy stage is
+/// undone on worker threads, and the DXT/BPTC blocks are uploaded into
+/// compressed textures as they are. No RGBA frame is ever made, so many 4K
+/// clips play at a fraction of the CPU time and bandwidth of H.264; HAP Q
+/// is converted from YCoCg on the GPU. Needs a GPU with BC texture support.
+///
+/// Example:
+/// \code
+///     ofVideoClip clip;
+///     clip.setQueueDepth(12);
+///     clip.load("loop.mov");
+///     clip.setLoopState(OF_LOOP_NORMAL);
+///     clip.play();
+///
+///     // In update()
+///     clip.update();
+///
+///     // In draw()
+///     clip.draw(0, 0);
+/// \endcode
+class ofVideoClip {
+public:
+    ofVideoClip();
+    ~ofVideoClip();
+
+    ofVideoClip(const ofVideoClip&) = delete;
+    ofVideoClip& operator=(const ofVideoClip&) = delete;
+
+    // ========================================================================
+    // Loading
+    // ========================================================================
+
+    /// \brief Load a local video file
+    /// \param path Path to video file (relative to the resources, or absolute)
+    /// \return true if the file has a readable video track
+    bool load(const std::string& path);
+
+    /// \brief Stop decoding and release the clip
+    void close();
+
+    /// \brief Check if a clip is loaded
+    bool isLoaded() const;
+
+    /// \brief Set how many frames are decoded ahead of the playhead
+    /// \details As many frames are kept behind it, so a clip holds up to
+    /// twice this many decoded frames. Clamped to 2...120; defaults to 8.
+    void setQueueDepth(int frames);
+
+    /// \brief Get the decode-ahead depth in frames
+    int getQueueDepth() const;
+
+    // ========================================================================
+    // Playback Control
+    // ========================================================================
+
+    /// \brief Start playback
+    void play();
+
+    /// \brief Pause playback, keeping the current frame
+    void pause();
+
+    /// \brief Stop playback and return to the first frame
+    void stop();
+
+    /// \brief Pause or resume playback
+    void setPaused(bool paused);
+
+    /// \brief Check if playing
+    bool isPlaying() const;
+
+    /// \brief Check if paused
+    bool isPaused() const;
+
+    /// \brief Check if playback reached an end of the clip (without looping)
+    bool isFinished() const;
+
+    /// \brief Set loop mode
+    /// \param loopType OF_LOOP_NONE, OF_LOOP_NORMAL, or OF_LOOP_PALINDROME
+    void setLoopState(ofLoopType loopType);
+
+    /// \brief Get current loop mode
+    ofLoopType getLoopState() const;
+
+    /// \brief Set playback speed
+    /// \param speed Frames per clip frame duration; negative plays backwards
+    void setSpeed(float speed);
+
+    /// \brief Get playback speed
+    float getSpeed() const;
+
+    // ========================================================================
+    // Position & Seeking
+    // ========================================================================
+
+    /// \brief Move the playhead to a frame
+    /// \details Shown on the next update() if it is already decoded, or as
+    /// soon as the decoder delivers it; until then the previous frame stays.
+    /// \param frame Frame number (clamped to the clip)
+    void setFrame(int frame);
+
+    /// \brief Get the frame at the playhead
+    int getCurrentFrame() const;
+
+    /// \brief Move the playhead to a time
+    /// \param seconds Time from the start of the clip
+    void setTime(float seconds);
+
+    /// \brief Get the playhead time in seconds
+    float getCurrentTime() const;
+
+    /// \brief Move the playhead to a fraction of the clip
+    /// \param pct Position (0.0 = first frame, 1.0 = last frame)
+    void setPosition(float pct);
+
+    /// \brief Get the playhead as a fraction of the clip
+    float getPosition() const;
+
+    /// \brief Step one frame forward
+    void nextFrame();
+
+    /// \brief Step one frame back
+    void previousFrame();
+
+    // ========================================================================
+    // Frame Update
+    // ========================================================================
+
+    /// \brief Advance the playhead and show its frame
+    /// \details Must be called every frame. The playhead follows the time
+    /// between calls; frames the decoder hasn't delivered yet are skipped
+    /// rather than waited for.
+    void update();
+
+    /// \brief Check if update() showed a different frame
+    bool isFrameNew() const;
+
+    /// \brief Get the frame currently shown
+    /// \return Frame number, or -1 before the first frame is decoded
+    int getDisplayedFrame() const;
+
+    // ========================================================================
+    // Drawing & Access
+    // ========================================================================
+
+    /// \brief Draw the clip at position
+    void draw(float x, float y) const;
+
+    /// \brief Draw the clip at position with size
+    void draw(float x, float y, float w, float h) const;
+
+    /// \brief Texture showing the current frame
+    ofTexture& getTexture();
+
+    /// \brief RGBA pixels of the current frame, converted on the CPU on first use
+    /// \details Empty for HAP clips, whose frames only exist as texture blocks.
+    ofPixels& getPixels();
+
+    // ========================================================================
+    // Clip Properties
+    // ========================================================================
+
+    /// \brief Get frame width in pixels
+    float getWidth() const;
+
+    /// \brief Get frame height in pixels
+    float getHeight() const;
+
+    /// \brief Get clip duration in seconds
+    float getDuration() const;
+
+    /// \brief Get number of frames
+    int getTotalNumFrames() const;
+
+    /// \brief Get the frame rate
+    float getFrameRate() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace oflike
@@ -0,0 +1,854 @@
+#import "ofVideoClip.h"
+#import <AVFoundation/AVFoundation.h>
+#import <CoreMedia/CoreMedia.h>
+#import <CoreVideo/CoreVideo.h>
+#import <QuartzCore/QuartzCore.h>
+#import "VideoFrameTexture.h"
+#import "HapFrame.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace oflike {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+static constexpr int kDefaultQueueDepth = 8;
+static constexpr int kMinQueueDepth = 2;
+static constexpr int kMaxQueueDepth = 120;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+namespace {
+
+/// Decoder output: bi-planar 4:2:0 in IOSurfaces, which Metal samples in
+/// place and converts on the GPU
+NSDictionary* DecodedFrameAttributes() {
+    return @{
+        (id)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange),
+        (id)kCVPixelBufferMetalCompatibilityKey: @YES,
+        (id)kCVPixelBufferIOSurfacePropertiesKey: @{}
+    };
+}
+
+} // namespace
+
+// ============================================================================
+// ofVideoClip::Impl
+// ============================================================================
+
+struct ofVideoClip::Impl {
+    AVAsset* asset = nil;
+    AVAssetTrack* track = nil;
+    CMTime trackStart = kCMTimeZero;
+    CMTime frameDuration = kCMTimeInvalid;
+
+    int width = 0;
+    int height = 0;
+    int totalFrames = 0;
+    float frameRate = 30.0f;
+    float duration = 0.0f;
+    bool loaded = false;
+
+    // HAP tracks are read as stored and decoded to texture blocks; other
+    // codecs go through the system decoder
+    HapCodec hap = HapCodec::None;
+    uint32_t hapWidth = 0;                  // Encoded frame size
+    uint32_t hapHeight = 0;
+
+    // Shared with the decode queue, guarded by mutex. Frames are kept
+    // within depth of the wanted frame and decoded up to depth ahead of it:
+    // CVPixelBuffers, or CFData blocks for HAP tracks.
+    std::mutex mutex;
+    std::map<int, CFTypeRef> decoded;
+    int wantedFrame = 0;
+    int direction = 1;
+    int depth = kDefaultQueueDepth;
+    bool wrap = false;
+    bool decodeScheduled = false;
+    bool stopping = false;
+    dispatch_queue_t decodeQueue = nullptr;
+
+    // Decode queue only: the forward reader stays open between passes so
+    // playback reads the track once, front to back
+    AVAssetReader* reader = nil;
+    AVAssetReaderTrackOutput* readerOutput = nil;
+    int readerNext = -1;                    // Frame the reader reaches next
+    CFTypeRef readerLast = nullptr;         // Last frame it delivered
+
+    // Main thread
+    ofTexture texture;
+    VideoFrameTexture frames;
+    HapFrameTexture hapFrames;
+    int currentFrame = 0;
+    int shownFrame = -1;
+    double phase = 0.0;                     // Fraction of a frame toward the next
+    double lastUpdateTime = 0.0;
+    bool playing = false;
+    bool paused = false;
+    bool finished = false;
+    bool frameNew = false;
+    bool reversed = false;                  // On the return leg of a palindrome
+    ofLoopType loopType = OF_LOOP_NONE;
+    float speed = 1.0f;
+
+    Impl() {
+        decodeQueue = dispatch_queue_create(
+            "com.oflike.videoClip",
+            dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0));
+    }
+
+    ~Impl() {
+        close();
+    }
+
+    void close() {
+        @autoreleasepool {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            // Wait for a running pass, then drop the reader on its queue
+            dispatch_sync(decodeQueue, ^{
+                closeReader();
+            });
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (auto& entry : decoded) {
+                    CFRelease(entry.second);
+                }
+                decoded.clear();
+                wantedFrame = 0;
+                direction = 1;
+                decodeScheduled = false;
+                stopping = false;
+            }
+
+            asset = nil;
+            track = nil;
+            texture.clear();
+            frames.clear();
+            hapFrames.clear();
+            hap = HapCodec::None;
+            hapWidth = 0;
+            hapHeight = 0;
+
+            width = 0;
+            height = 0;
+            totalFrames = 0;
+            frameRate = 30.0f;
+            duration = 0.0f;
+            loaded = false;
+
+            currentFrame = 0;
+            shownFrame = -1;
+            phase = 0.0;
+            lastUpdateTime = 0.0;
+            playing = false;
+            paused = false;
+            finished = false;
+            frameNew = false;
+            reversed = false;
+        }
+    }
+
+    CMTime timeOfFrame(int frame) const {
+        return CMTimeAdd(trackStart, CMTimeMultiply(frameDuration, frame));
+    }
+
+    int frameAtTime(CMTime time) const {
+        const double seconds = CMTimeGetSeconds(CMTimeSubtract(time, trackStart));
+        return static_cast<int>(std::floor(seconds / CMTimeGetSeconds(frameDuration) + 0.5));
+    }
+
+    // ========================================================================
+    // Frame Window (callers hold mutex)
+    // ========================================================================
+
+    /// Frames from the wanted one, the short way round when looping
+    int offsetFromWanted(int frame) const {
+        int offset = frame - wantedFrame;
+        if (wrap && totalFrames > 0) {
+            offset = ((offset % totalFrames) + totalFrames) % totalFrames;
+            if (offset > totalFrames / 2) {
+                offset -= totalFrames;
+            }
+        }
+        return offset;
+    }
+
+    bool inWindow(int frame) const {
+        return std::abs(offsetFromWanted(frame)) <= depth;
+    }
+
+    void evict() {
+        for (auto it = decoded.begin(); it != decoded.end();) {
+            if (inWindow(it->first)) {
+                ++it;
+            } else {
+                CFRelease(it->second);
+                it = decoded.erase(it);
+            }
+        }
+    }
+
+    /// First frame of the decode-ahead window that isn't decoded, or -1
+    int nextMissing() const {
+        for (int i = 0; i < depth; ++i) {
+            int frame = wantedFrame + (direction < 0 ? -i : i);
+            if (wrap) {
+                frame = ((frame % totalFrames) + totalFrames) % totalFrames;
+            } else if (frame < 0 || frame >= totalFrames) {
+                break;
+            }
+            if (decoded.find(frame) == decoded.end()) {
+                return frame;
+            }
+        }
+        return -1;
+    }
+
+    void store(int frame, CFTypeRef buffer) {
+        if (frame < 0 || frame >= totalFrames || !inWindow(frame) || decoded.count(frame)) {
+            return;
+        }
+        decoded[frame] = CFRetain(buffer);
+    }
+
+    // ========================================================================
+    // Decoding (decode queue)
+    // ========================================================================
+
+    AVAssetReader* openReader(CMTime start, CMTime length, AVAssetReaderTrackOutput*& output) {
+        NSError* error = nil;
+        AVAssetReader* newReader = [AVAssetReader assetReaderWithAsset:asset error:&error];
+        if (!newReader) {
+            NSLog(@"ofVideoClip: Failed to create reader: %@", error);
+            return nil;
+        }
+
+        // HAP samples are passed through undecoded
+        output = [AVAssetReaderTrackOutput assetReaderTrackOutputWithTrack:track
+                                                            outputSettings:hap != HapCodec::None
+                                                                               ? nil : DecodedFrameAttributes()];
+        output.alwaysCopiesSampleData = NO;
+        if (![newReader canAddOutput:output]) {
+            NSLog(@"ofVideoClip: Cannot add reader output");
+            output = nil;
+            return nil;
+        }
+        [newReader addOutput:output];
+        newReader.timeRange = CMTimeRangeMake(start, length);
+
+        if (![newReader startReading]) {
+            NSLog(@"ofVideoClip: Failed to start reading: %@", newReader.error);
+            output = nil;
+            return nil;
+        }
+        return newReader;
+    }
+
+    void closeReader() {
+        if (reader) {
+            [reader cancelReading];
+            reader = nil;
+        }
+        readerOutput = nil;
+        readerNext = -1;
+        if (readerLast) {
+            CFRelease(readerLast);
+            readerLast = nullptr;
+        }
+    }
+
+    /// Store a decoded frame. Frames it skipped over (variable frame rates,
+    /// rounding) show the frame before them; next and last carry that state.
+    void deliver(int frame, CFTypeRef buffer, int& next, CFTypeRef& last) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (frame >= next) {
+            for (int gap = next; gap < frame; ++gap) {
+                store(gap, last ? last : buffer);
+            }
+            next = frame + 1;
+            CFRetain(buffer);
+            if (last) {
+                CFRelease(last);
+            }
+            last = buffer;
+        }
+        store(frame, buffer);
+    }
+
+    /// The last frame delivered holds until the end of the track
+    void deliverEnd(int to, int next, CFTypeRef last) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int frame = next; last && frame <= to; ++frame) {
+            store(frame, last);
+        }
+    }
+
+    /// Texture blocks of a HAP sample, or null for samples that don't decode
+    CFMutableDataRef decodeHap(CMSampleBufferRef sample) {
+        CMBlockBufferRef block = CMSampleBufferGetDataBuffer(sample);
+        const size_t size = block ? CMBlockBufferGetDataLength(block) : 0;
+        if (size == 0) {
+            return nullptr;
+        }
+
+        // Samples are usually contiguous; others are gathered first
+        char* data = nullptr;
+        size_t contiguous = 0;
+        std::vector<uint8_t> gathered;
+        if (CMBlockBufferGetDataPointer(block, 0, &contiguous, nullptr, &data) != kCMBlockBufferNoErr ||
+            contiguous < size) {
+            gathered.resize(size);
+            if (CMBlockBufferCopyDataBytes(block, 0, size, gathered.data()) != kCMBlockBufferNoErr) {
+                return nullptr;
+            }
+            data = reinterpret_cast<char*>(gathered.data());
+        }
+
+        const size_t bytes = hapFrameBytes(hap, hapWidth, hapHeight);
+        CFMutableDataRef blocks = CFDataCreateMutable(kCFAllocatorDefault, static_cast<CFIndex>(bytes));
+        CFDataSetLength(blocks, static_cast<CFIndex>(bytes));
+        if (!decodeHapFrame(reinterpret_cast<const uint8_t*>(data), size, hap, hapWidth, hapHeight,
+                            CFDataGetMutableBytePtr(blocks))) {
+            NSLog(@"ofVideoClip: Malformed HAP frame");
+            CFRelease(blocks);
+            return nullptr;
+        }
+        return blocks;
+    }
+
+    /// Next decoded frame and its number, or false at the end of the range.
+    /// The frame is retained for the caller.
+    bool readFrame(AVAssetReaderTrackOutput* output, int& frame, CFTypeRef& buffer) {
+        CMSampleBufferRef sample = nullptr;
+        while ((sample = [output copyNextSampleBuffer])) {
+            if (hap != HapCodec::None) {
+                buffer = decodeHap(sample);
+            } else {
+                CVImageBufferRef image = CMSampleBufferGetImageBuffer(sample);
+                buffer = image ? CFRetain(image) : nullptr;
+            }
+            if (buffer) {
+                frame = frameAtTime(CMSampleBufferGetPresentationTimeStamp(sample));
+                CFRelease(sample);
+                return true;
+            }
+            CFRelease(sample);
+        }
+        return false;
+    }
+
+    bool isStopping() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stopping;
+    }
+
+    /// Playing forward: continue the open reader or start one at the frame,
+    /// and read up to the end of the window
+    bool readForward(int from, int to) {
+        if (!reader || readerNext != from || reader.status != AVAssetReaderStatusReading) {
+            closeReader();
+            reader = openReader(timeOfFrame(from), kCMTimePositiveInfinity, readerOutput);
+            if (!reader) {
+                return false;
+            }
+            readerNext = from;
+        }
+
+        int frame = 0;
+        CFTypeRef buffer = nullptr;
+        while (readFrame(readerOutput, frame, buffer)) {
+            deliver(frame, buffer, readerNext, readerLast);
+            CFRelease(buffer);
+            if (frame >= to || isStopping()) {
+                return true;
+            }
+        }
+
+        // End of the track
+        const bool delivered = readerLast != nullptr;
+        deliverEnd(to, readerNext, readerLast);
+        closeReader();
+        return delivered;
+    }
+
+    /// Playing backward: decode a chunk ending at the frame in one pass, so
+    /// the chunk's keyframe is decoded once rather than for every frame
+    bool readChunk(int from, int to) {
+        AVAssetReaderTrackOutput* output = nil;
+        AVAssetReader* chunkReader = openReader(timeOfFrame(from),
+                                                CMTimeMultiply(frameDuration, to - from + 1), output);
+        if (!chunkReader) {
+            return false;
+        }
+
+        int next = from;
+        CFTypeRef last = nullptr;
+        int frame = 0;
+        CFTypeRef buffer = nullptr;
+        while (readFrame(output, frame, buffer)) {
+            deliver(frame, buffer, next, last);
+            CFRelease(buffer);
+            if (isStopping()) {
+                break;
+            }
+        }
+        [chunkReader cancelReading];
+
+        const bool delivered = last != nullptr;
+        deliverEnd(to, next, last);
+        if (last) {
+            CFRelease(last);
+        }
+        return delivered;
+    }
+
+    /// Fill the window around the wanted frame until it is complete
+    void decodeAhead() {
+        for (;;) {
+            @autoreleasepool {
+                int from = 0;
+                int to = 0;
+                bool forward = true;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    evict();
+                    const int missing = stopping ? -1 : nextMissing();
+                    if (missing < 0) {
+                        decodeScheduled = false;
+                        return;
+                    }
+                    forward = direction >= 0;
+                    from = forward ? missing : std::max(0, missing - depth + 1);
+                    to = forward ? std::min(totalFrames - 1, missing + depth - 1) : missing;
+                }
+
+                if (!(forward ? readForward(from, to) : readChunk(from, to))) {
+                    // Retried when the playhead next moves
+                    std::lock_guard<std::mutex> lock(mutex);
+                    decodeScheduled = false;
+                    return;
+                }
+            }
+        }
+    }
+
+    // ========================================================================
+    // Playback (main thread)
+    // ========================================================================
+
+    int playDirection() const {
+        return (speed < 0.0f) != reversed ? -1 : 1;
+    }
+
+    /// Move the decode window to the playhead
+    void requestFrames() {
+        if (!loaded) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        wantedFrame = currentFrame;
+        direction = playDirection();
+        wrap = loopType == OF_LOOP_NORMAL;
+        if (!decodeScheduled && !stopping) {
+            decodeScheduled = true;
+            dispatch_async(decodeQueue, ^{
+                decodeAhead();
+            });
+        }
+    }
+
+    void seek(int frame) {
+        currentFrame = std::clamp(frame, 0, std::max(0, totalFrames - 1));
+        phase = 0.0;
+        finished = false;
+        requestFrames();
+    }
+
+    void advance(int steps) {
+        const int last = totalFrames - 1;
+        int target = currentFrame + steps;
+
+        if (loopType == OF_LOOP_NORMAL) {
+            target = ((target % totalFrames) + totalFrames) % totalFrames;
+        } else if (loopType == OF_LOOP_PALINDROME && last > 0) {
+            // Bounce off the ends
+            while (target < 0 || target > last) {
+                target = target > last ? 2 * last - target : -target;
+                reversed = !reversed;
+                phase = -phase;
+            }
+        } else if (target < 0 || target > last) {
+            target = std::clamp(target, 0, last);
+            finished = true;
+            playing = false;
+            phase = 0.0;
+        }
+
+        currentFrame = target;
+        requestFrames();
+    }
+
+    void showCurrentFrame() {
+        CFTypeRef buffer = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = decoded.find(currentFrame);
+            if (it != decoded.end() && currentFrame != shownFrame) {
+                buffer = CFRetain(it->second);
+            }
+        }
+        if (!buffer) {
+            return;
+        }
+
+        if (hap != HapCodec::None) {
+            hapFrames.setFrame(hap, hapWidth, hapHeight, CFDataGetBytePtr(static_cast<CFDataRef>(buffer)), texture);
+        } else {
+            CVPixelBufferRef image = (CVPixelBufferRef)buffer;
+            frames.setFrame(image, texture);
+            width = static_cast<int>(CVPixelBufferGetWidth(image));
+            height = static_cast<int>(CVPixelBufferGetHeight(image));
+        }
+        CFRelease(buffer);
+        shownFrame = currentFrame;
+        frameNew = true;
+    }
+};
+
+// ============================================================================
+// ofVideoClip Implementation
+// ============================================================================
+
+ofVideoClip::ofVideoClip()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ofVideoClip::~ofVideoClip() = default;
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+bool ofVideoClip::load(const std::string& path) {
+    close();
+
+    @autoreleasepool {
+        // Handle relative paths
+        NSString* nsPath = [NSString stringWithUTF8String:path.c_str()];
+        if (![nsPath hasPrefix:@"/"]) {
+            NSString* bundlePath = [[NSBundle mainBundle] resourcePath];
+            nsPath = [bundlePath stringByAppendingPathComponent:nsPath];
+        }
+        if (![[NSFileManager defaultManager] fileExistsAtPath:nsPath]) {
+            NSLog(@"ofVideoClip: File not found: %@", nsPath);
+            return false;
+        }
+
+        // Precise timing: every frame is addressed by its presentation time
+        AVURLAsset* asset = [AVURLAsset URLAssetWithURL:[NSURL fileURLWithPath:nsPath]
+                                                options:@{AVURLAssetPreferPreciseDurationAndTimingKey: @YES}];
+
+        // Wait for asset to load
+        dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+        __block bool loadSuccess = false;
+
+        [asset loadValuesAsynchronouslyForKeys:@[@"tracks", @"duration"]
+                             completionHandler:^{
+            NSError* error = nil;
+            AVKeyValueStatus tracksStatus = [asset statusOfValueForKey:@"tracks" error:&error];
+            AVKeyValueStatus durationStatus = [asset statusOfValueForKey:@"duration" error:&error];
+
+            loadSuccess = (tracksStatus == AVKeyValueStatusLoaded && durationStatus == AVKeyValueStatusLoaded);
+            dispatch_semaphore_signal(semaphore);
+        }];
+
+        // Wait with timeout (5 seconds)
+        dispatch_time_t timeout = dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC);
+        if (dispatch_semaphore_wait(semaphore, timeout) != 0 || !loadSuccess) {
+            NSLog(@"ofVideoClip: Failed to load asset tracks");
+            return false;
+        }
+
+        AVAssetTrack* track = [[asset tracksWithMediaType:AVMediaTypeVideo] firstObject];
+        if (!track) {
+            NSLog(@"ofVideoClip: No video track found");
+            return false;
+        }
+
+        Impl& clip = *impl_;
+        clip.asset = asset;
+        clip.track = track;
+        clip.trackStart = track.timeRange.start;
+
+        clip.frameRate = track.nominalFrameRate > 0 ? track.nominalFrameRate : 30.0f;
+        clip.frameDuration = track.minFrameDuration;
+        if (!CMTIME_IS_NUMERIC(clip.frameDuration) || CMTimeGetSeconds(clip.frameDuration) <= 0) {
+            clip.frameDuration = CMTimeMakeWithSeconds(1.0 / clip.frameRate, 600000);
+        }
+
+        clip.duration = static_cast<float>(CMTimeGetSeconds(track.timeRange.duration));
+        clip.totalFrames = std::max(1, static_cast<int>(std::floor(
+            CMTimeGetSeconds(track.timeRange.duration) / CMTimeGetSeconds(clip.frameDuration) + 0.5)));
+
+        CGSize size = track.naturalSize;
+        clip.width = static_cast<int>(size.width);
+        clip.height = static_cast<int>(size.height);
+
+        // HAP frames are texture blocks of the encoded size
+        CMFormatDescriptionRef format = (__bridge CMFormatDescriptionRef)track.formatDescriptions.firstObject;
+        clip.hap = format ? hapCodecFromFourCC(CMFormatDescriptionGetMediaSubType(format)) : HapCodec::None;
+        if (clip.hap != HapCodec::None) {
+            if (!HapFrameTexture::isSupported(clip.hap)) {
+                NSLog(@"ofVideoClip: GPU can't sample the texture format of this HAP clip");
+                clip.asset = nil;
+                clip.track = nil;
+                clip.hap = HapCodec::None;
+                return false;
+            }
+            const CMVideoDimensions dimensions = CMVideoFormatDescriptionGetDimensions(format);
+            clip.hapWidth = static_cast<uint32_t>(dimensions.width);
+            clip.hapHeight = static_cast<uint32_t>(dimensions.height);
+            clip.width = dimensions.width;
+            clip.height = dimensions.height;
+        } else {
+            clip.texture.allocateStreaming(clip.width, clip.height, OF_IMAGE_COLOR_ALPHA);
+        }
+
+        clip.loaded = true;
+        clip.requestFrames();
+
+        NSLog(@"ofVideoClip: Loaded %sclip %dx%d @ %.2f fps, %d frames",
+              clip.hap != HapCodec::None ? "HAP " : "", clip.width, clip.height, clip.frameRate, clip.totalFrames);
+        return true;
+    }
+}
+
+void ofVideoClip::close() {
+    impl_->close();
+}
+
+bool ofVideoClip::isLoaded() const {
+    return impl_->loaded;
+}
+
+void ofVideoClip::setQueueDepth(int frames) {
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        impl_->depth = std::clamp(frames, kMinQueueDepth, kMaxQueueDepth);
+    }
+    impl_->requestFrames();
+}
+
+int ofVideoClip::getQueueDepth() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->depth;
+}
+
+// ============================================================================
+// Playback Control
+// ============================================================================
+
+void ofVideoClip::play() {
+    if (!impl_->loaded) return;
+
+    if (impl_->finished) {
+        // Start over from the end playback runs from
+        impl_->reversed = false;
+        impl_->seek(impl_->speed < 0.0f ? impl_->totalFrames - 1 : 0);
+    }
+    impl_->playing = true;
+    impl_->paused = false;
+    impl_->lastUpdateTime = 0.0;
+}
+
+void ofVideoClip::pause() {
+    if (!impl_->loaded) return;
+    impl_->playing = false;
+    impl_->paused = true;
+}
+
+void ofVideoClip::stop() {
+    if (!impl_->loaded) return;
+    impl_->playing = false;
+    impl_->paused = false;
+    impl_->reversed = false;
+    impl_->seek(0);
+}
+
+void ofVideoClip::setPaused(bool paused) {
+    if (paused) {
+        pause();
+    } else {
+        play();
+    }
+}
+
+bool ofVideoClip::isPlaying() const {
+    return impl_->playing;
+}
+
+bool ofVideoClip::isPaused() const {
+    return impl_->paused;
+}
+
+bool ofVideoClip::isFinished() const {
+    return impl_->finished;
+}
+
+void ofVideoClip::setLoopState(ofLoopType loopType) {
+    impl_->loopType = loopType;
+    if (loopType != OF_LOOP_PALINDROME) {
+        impl_->reversed = false;
+    }
+    impl_->requestFrames();
+}
+
+ofLoopType ofVideoClip::getLoopState() const {
+    return impl_->loopType;
+}
+
+void ofVideoClip::setSpeed(float speed) {
+    impl_->speed = speed;
+    impl_->requestFrames();
+}
+
+float ofVideoClip::getSpeed() const {
+    return impl_->speed;
+}
+
+// ============================================================================
+// Position & Seeking
+// ============================================================================
+
+void ofVideoClip::setFrame(int frame) {
+    if (!impl_->loaded) return;
+    impl_->seek(frame);
+}
+
+int ofVideoClip::getCurrentFrame() const {
+    return impl_->currentFrame;
+}
+
+void ofVideoClip::setTime(float seconds) {
+    if (!impl_->loaded) return;
+    // The frame on screen at that time
+    impl_->seek(static_cast<int>(std::floor(seconds / CMTimeGetSeconds(impl_->frameDuration) + 1e-6)));
+}
+
+float ofVideoClip::getCurrentTime() const {
+    if (!impl_->loaded) return 0.0f;
+    return static_cast<float>(impl_->currentFrame * CMTimeGetSeconds(impl_->frameDuration));
+}
+
+void ofVideoClip::setPosition(float pct) {
+    if (!impl_->loaded) return;
+    pct = std::max(0.0f, std::min(1.0f, pct));
+    impl_->seek(static_cast<int>(std::lround(pct * (impl_->totalFrames - 1))));
+}
+
+float ofVideoClip::getPosition() const {
+    if (!impl_->loaded || impl_->totalFrames <= 1) return 0.0f;
+    return static_cast<float>(impl_->currentFrame) / static_cast<float>(impl_->totalFrames - 1);
+}
+
+void ofVideoClip::nextFrame() {
+    if (!impl_->loaded) return;
+    impl_->seek(impl_->currentFrame + 1);
+}
+
+void ofVideoClip::previousFrame() {
+    if (!impl_->loaded) return;
+    impl_->seek(impl_->currentFrame - 1);
+}
+
+// ============================================================================
+// Frame Update
+// ============================================================================
+
+void ofVideoClip::update() {
+    if (!impl_->loaded) return;
+
+    impl_->frameNew = false;
+
+    const double now = CACurrentMediaTime();
+    if (impl_->playing) {
+        const double elapsed = impl_->lastUpdateTime > 0.0 ? now - impl_->lastUpdateTime : 0.0;
+        impl_->phase += elapsed * impl_->speed * impl_->frameRate * (impl_->reversed ? -1.0 : 1.0);
+        const int steps = static_cast<int>(impl_->phase);
+        if (steps != 0) {
+            impl_->phase -= steps;
+            impl_->advance(steps);
+        }
+    }
+    impl_->lastUpdateTime = now;
+
+    @autoreleasepool {
+        impl_->showCurrentFrame();
+    }
+}
+
+bool ofVideoClip::isFrameNew() const {
+    return impl_->frameNew;
+}
+
+int ofVideoClip::getDisplayedFrame() const {
+    return impl_->shownFrame;
+}
+
+// ============================================================================
+// Drawing & Access
+// ============================================================================
+
+void ofVideoClip::draw(float x, float y) const {
+    if (!impl_->loaded) return;
+    impl_->texture.draw(x, y);
+}
+
+void ofVideoClip::draw(float x, float y, float w, float h) const {
+    if (!impl_->loaded) return;
+    impl_->texture.draw(x, y, w, h);
+}
+
+ofTexture& ofVideoClip::getTexture() {
+    return impl_->texture;
+}
+
+ofPixels& ofVideoClip::getPixels() {
+    return impl_->frames.getPixels();
+}
+
+// ============================================================================
+// Clip Properties
+// ============================================================================
+
+float ofVideoClip::getWidth() const {
+    return static_cast<float>(impl_->width);
+}
+
+float ofVideoClip::getHeight() const {
+    return static_cast<float>(impl_->height);
+}
+
+float ofVideoClip::getDuration() const {
+    return impl_->duration;
+}
+
+int ofVideoClip::getTotalNumFrames() const {
+    return impl_->totalFrames;
+}
+
+float ofVideoClip::getFrameRate() const {
+    return impl_->frameRate;
+}
+
+} // namespace oflike
@@ -3,6 +3,7 @@
 // oflike-metal ofVideoGrabber - openFrameworks API compatible camera input
 // Provides camera capture using AVFoundation and Metal textures
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -19,6 +20,16 @@ struct ofVideoDevice {
     bool isDefault = false;
 };
 
+/// \brief Capture latency and frame statistics
+struct ofVideoGrabberLatency {
+    float lastMs = 0.0f;            ///< Capture to display of the latest measured frame
+    float averageMs = 0.0f;         ///< Running average over about 30 frames
+    float maxMs = 0.0f;             ///< Worst since setup()
+    uint64_t framesMeasured = 0;    ///< Frames whose display was seen
+    uint64_t framesCaptured = 0;    ///< Frames delivered by the camera
+    uint64_t framesDropped = 0;     ///< Frames replaced by newer ones before update() took them
+};
+
 /// \brief Camera capture with AVFoundation backend
 /// \details ofVideoGrabber provides openFrameworks-compatible camera capture
 /// using AVCaptureSession for input and Metal textures for rendering.
@@ -32,7 +43,9 @@ struct ofVideoDevice {
 /// Implementation:
 /// - Uses AVCaptureSession for capture
 /// - Uses AVCaptureVideoDataOutput for frame access
-/// - Uses Metal textures for GPU rendering
+/// - Captures bi-planar YCbCr 4:2:0 where the camera offers it and converts
+///   to RGB on the GPU, sampling capture buffers in place; CPU pixels are
+///   only made on getPixels()
 /// - pImpl pattern to hide Objective-C++ details
 ///
 /// Example:
@@ -126,6 +139,19 @@ public:
     /// \return true if a new frame arrived since last update
     bool isFrameNew() const;
 
+    /// \brief Get when the current frame was captured
+    /// \return Capture time in seconds on the host clock (CACurrentMediaTime()),
+    ///         or 0 before the first frame
+    double getFrameTimestamp() const;
+
+    /// \brief Get capture-to-display latency
+    /// \details Measured from the camera's capture timestamp to the moment
+    /// the first app frame drawing it reached the screen. update() always takes
+    /// the newest frame; older ones waiting since the last update() count as
+    /// dropped.
+    /// \return Latency and frame statistics since setup()
+    ofVideoGrabberLatency getLatency() const;
+
     // ========================================================================
     // Drawing
     // ========================================================================
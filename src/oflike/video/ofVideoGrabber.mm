@@ -1,90 +1,12 @@
 #import "ofVideoGrabber.h"
 #import <AVFoundation/AVFoundation.h>
 #import <CoreVideo/CoreVideo.h>
+#import "CaptureSupport.h"
+#import "VideoFrameTexture.h"
 #import "../../core/Context.h"
-
-// ============================================================================
-// AVCaptureVideoDataOutputSampleBufferDelegate Implementation
-// ============================================================================
-
-@interface OflikeCaptureDelegate : NSObject <AVCaptureVideoDataOutputSampleBufferDelegate>
-
-@property (nonatomic, assign) oflike::ofPixels* pixels;
-@property (nonatomic, assign) oflike::ofTexture* texture;
-@property (nonatomic, assign) bool frameNew;
-@property (nonatomic, assign) int width;
-@property (nonatomic, assign) int height;
-@property (nonatomic, strong) dispatch_queue_t processingQueue;
-
-@end
-
-@implementation OflikeCaptureDelegate
-
-- (instancetype)init {
-    self = [super init];
-    if (self) {
-        _pixels = nullptr;
-        _texture = nullptr;
-        _frameNew = false;
-        _width = 0;
-        _height = 0;
-        _processingQueue = dispatch_queue_create("com.oflike.capture", DISPATCH_QUEUE_SERIAL);
-    }
-    return self;
-}
-
-- (void)captureOutput:(AVCaptureOutput*)captureOutput
-didOutputSampleBuffer:(CMSampleBufferRef)sampleBuffer
-       fromConnection:(AVCaptureConnection*)connection {
-
-    (void)captureOutput;
-    (void)connection;
-
-    if (!_pixels || !_texture) {
-        return;
-    }
-
-    CVImageBufferRef imageBuffer = CMSampleBufferGetImageBuffer(sampleBuffer);
-    if (!imageBuffer) {
-        return;
-    }
-
-    CVPixelBufferLockBaseAddress(imageBuffer, kCVPixelBufferLock_ReadOnly);
-
-    size_t width = CVPixelBufferGetWidth(imageBuffer);
-    size_t height = CVPixelBufferGetHeight(imageBuffer);
-    size_t bytesPerRow = CVPixelBufferGetBytesPerRow(imageBuffer);
-    void* baseAddress = CVPixelBufferGetBaseAddress(imageBuffer);
-
-    // Update dimensions if changed
-    if (_pixels->getWidth() != width || _pixels->getHeight() != height) {
-        _pixels->allocate(width, height, 4);
-        _width = static_cast<int>(width);
-        _height = static_cast<int>(height);
-    }
-
-    // Convert BGRA to RGBA
-    unsigned char* srcData = static_cast<unsigned char*>(baseAddress);
-    unsigned char* dstData = _pixels->getData();
-
-    for (size_t y = 0; y < height; ++y) {
-        unsigned char* srcRow = srcData + y * bytesPerRow;
-        unsigned char* dstRow = dstData + y * width * 4;
-
-        for (size_t x = 0; x < width; ++x) {
-            dstRow[x * 4 + 0] = srcRow[x * 4 + 2]; // R from B
-            dstRow[x * 4 + 1] = srcRow[x * 4 + 1]; // G
-            dstRow[x * 4 + 2] = srcRow[x * 4 + 0]; // B from R
-            dstRow[x * 4 + 3] = srcRow[x * 4 + 3]; // A
-        }
-    }
-
-    CVPixelBufferUnlockBaseAddress(imageBuffer, kCVPixelBufferLock_ReadOnly);
-
-    _frameNew = true;
-}
-
-@end
+#import "../../render/IRenderer.h"
+#import "../utils/ofProfiler.h"
+#include <algorithm>
 
 namespace oflike {
 
@@ -93,14 +15,14 @@ namespace oflike {
 // ============================================================================
 
 struct ofVideoGrabber::Impl {
-    AVCaptureSession* captureSession = nil;
     AVCaptureDevice* captureDevice = nil;
-    AVCaptureDeviceInput* captureInput = nil;
-    AVCaptureVideoDataOutput* captureOutput = nil;
-    OflikeCaptureDelegate* captureDelegate = nil;
+    CaptureStream stream;
 
     ofTexture texture;
-    ofPixels pixels;
+
+    // Camera frames are drawn from their capture buffers; CPU pixels are
+    // made only when getPixels() asks for them
+    VideoFrameTexture frames;
 
     int width = 0;
     int height = 0;
@@ -116,6 +38,40 @@ struct ofVideoGrabber::Impl {
     bool frameNew = false;
     bool textureNeedsUpdate = false;
 
+    // Capture time of the current frame, and frames handed to the renderer
+    // whose presentation hasn't been seen yet (renderer frame serial and
+    // capture time)
+    double frameTimestamp = 0.0;
+    static constexpr size_t kPendingFrames = 8;
+    std::pair<uint64_t, double> pendingFrames[kPendingFrames] = {};
+    size_t pendingCount = 0;
+    ofVideoGrabberLatency latency;
+
+    // Record latencies of handed-off frames that have reached the screen
+    void measureLatency(render::IRenderer* renderer) {
+        uint64_t presentedSerial = 0;
+        double presentedTime = 0.0;
+        if (pendingCount == 0 || !renderer ||
+            !renderer->getLastPresentedFrame(presentedSerial, presentedTime)) {
+            return;
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < pendingCount; ++i) {
+            const auto& pending = pendingFrames[i];
+            if (pending.first > presentedSerial) {
+                pendingFrames[kept++] = pending;
+                continue;
+            }
+            const float ms = static_cast<float>((presentedTime - pending.second) * 1000.0);
+            latency.lastMs = ms;
+            latency.averageMs = latency.framesMeasured == 0 ? ms : latency.averageMs + (ms - latency.averageMs) / 30.0f;
+            latency.maxMs = std::max(latency.maxMs, ms);
+            latency.framesMeasured++;
+        }
+        pendingCount = kept;
+    }
+
     Impl() = default;
 
     ~Impl() {
@@ -124,32 +80,20 @@ struct ofVideoGrabber::Impl {
 
     void close() {
         @autoreleasepool {
-            if (captureSession) {
-                [captureSession stopRunning];
-
-                if (captureInput) {
-                    [captureSession removeInput:captureInput];
-                }
-                if (captureOutput) {
-                    [captureSession removeOutput:captureOutput];
-                }
-
-                captureSession = nil;
-            }
-
+            closeCaptureStream(stream);
             captureDevice = nil;
-            captureInput = nil;
-            captureOutput = nil;
-            captureDelegate = nil;
 
             texture.clear();
-            pixels.clear();
+            frames.clear();
 
             width = 0;
             height = 0;
             initialized = false;
             frameNew = false;
             textureNeedsUpdate = false;
+            frameTimestamp = 0.0;
+            pendingCount = 0;
+            latency = ofVideoGrabberLatency();
         }
     }
 };
@@ -244,36 +188,7 @@ bool ofVideoGrabber::setup(int w, int h) {
 
     @autoreleasepool {
         // Find the requested device
-        AVCaptureDevice* device = nil;
-
-        if (!impl_->deviceUniqueID.empty()) {
-            // Find by unique ID
-            NSString* uniqueID = [NSString stringWithUTF8String:impl_->deviceUniqueID.c_str()];
-            device = [AVCaptureDevice deviceWithUniqueID:uniqueID];
-        } else {
-            // Find by index
-            AVCaptureDeviceDiscoverySession* discoverySession = [AVCaptureDeviceDiscoverySession
-                discoverySessionWithDeviceTypes:@[
-                    AVCaptureDeviceTypeBuiltInWideAngleCamera,
-                    AVCaptureDeviceTypeExternalUnknown
-                ]
-                mediaType:AVMediaTypeVideo
-                position:AVCaptureDevicePositionUnspecified];
-
-            NSArray<AVCaptureDevice*>* devices = [discoverySession devices];
-
-            if (impl_->deviceID >= 0 && impl_->deviceID < static_cast<int>([devices count])) {
-                device = devices[impl_->deviceID];
-            } else if ([devices count] > 0) {
-                device = devices[0];
-            }
-        }
-
-        if (!device) {
-            // Fall back to default device
-            device = [AVCaptureDevice defaultDeviceWithMediaType:AVMediaTypeVideo];
-        }
-
+        AVCaptureDevice* device = findCaptureDevice(impl_->deviceID, impl_->deviceUniqueID);
         if (!device) {
             NSLog(@"ofVideoGrabber: No camera device available");
             return false;
@@ -282,125 +197,22 @@ bool ofVideoGrabber::setup(int w, int h) {
         impl_->captureDevice = device;
 
         // Configure device for best matching format
-        NSError* error = nil;
-        if ([device lockForConfiguration:&error]) {
-            // Find best matching format
-            AVCaptureDeviceFormat* bestFormat = nil;
-            Float64 bestScore = INFINITY;
-
-            for (AVCaptureDeviceFormat* format in [device formats]) {
-                CMVideoDimensions dimensions = CMVideoFormatDescriptionGetDimensions(format.formatDescription);
-
-                // Calculate score (prefer closest to requested size)
-                Float64 widthDiff = std::abs(dimensions.width - w);
-                Float64 heightDiff = std::abs(dimensions.height - h);
-                Float64 score = widthDiff + heightDiff;
-
-                // Check if format supports desired frame rate
-                for (AVFrameRateRange* range in format.videoSupportedFrameRateRanges) {
-                    if (range.minFrameRate <= impl_->desiredFrameRate &&
-                        range.maxFrameRate >= impl_->desiredFrameRate) {
-                        // Bonus for supporting desired frame rate
-                        score -= 1000;
-                    }
-                }
-
-                if (score < bestScore) {
-                    bestScore = score;
-                    bestFormat = format;
-                }
-            }
-
-            if (bestFormat) {
-                device.activeFormat = bestFormat;
-
-                // Set frame rate
-                CMTime frameDuration = CMTimeMake(1, static_cast<int32_t>(impl_->desiredFrameRate));
-                for (AVFrameRateRange* range in bestFormat.videoSupportedFrameRateRanges) {
-                    if (range.minFrameRate <= impl_->desiredFrameRate &&
-                        range.maxFrameRate >= impl_->desiredFrameRate) {
-                        device.activeVideoMinFrameDuration = frameDuration;
-                        device.activeVideoMaxFrameDuration = frameDuration;
-                        break;
-                    }
-                }
-
-                CMVideoDimensions dims = CMVideoFormatDescriptionGetDimensions(bestFormat.formatDescription);
-                impl_->width = dims.width;
-                impl_->height = dims.height;
-            }
-
-            [device unlockForConfiguration];
-        } else {
-            NSLog(@"ofVideoGrabber: Failed to lock device for configuration: %@", error);
-        }
-
-        // Create capture session
-        impl_->captureSession = [[AVCaptureSession alloc] init];
-        if (!impl_->captureSession) {
-            NSLog(@"ofVideoGrabber: Failed to create capture session");
-            return false;
-        }
-
-        // Create input
-        impl_->captureInput = [AVCaptureDeviceInput deviceInputWithDevice:device error:&error];
-        if (!impl_->captureInput) {
-            NSLog(@"ofVideoGrabber: Failed to create capture input: %@", error);
-            impl_->captureSession = nil;
-            return false;
-        }
-
-        if (![impl_->captureSession canAddInput:impl_->captureInput]) {
-            NSLog(@"ofVideoGrabber: Cannot add capture input to session");
-            impl_->captureInput = nil;
-            impl_->captureSession = nil;
-            return false;
-        }
-        [impl_->captureSession addInput:impl_->captureInput];
-
-        // Create output
-        impl_->captureOutput = [[AVCaptureVideoDataOutput alloc] init];
-        if (!impl_->captureOutput) {
-            NSLog(@"ofVideoGrabber: Failed to create capture output");
-            [impl_->captureSession removeInput:impl_->captureInput];
-            impl_->captureInput = nil;
-            impl_->captureSession = nil;
-            return false;
-        }
-
-        // Configure output for BGRA format (Metal compatible)
-        impl_->captureOutput.videoSettings = @{
-            (id)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA)
-        };
-        impl_->captureOutput.alwaysDiscardsLateVideoFrames = YES;
-
-        // Create delegate
-        impl_->captureDelegate = [[OflikeCaptureDelegate alloc] init];
-        impl_->captureDelegate.pixels = &impl_->pixels;
-        impl_->captureDelegate.texture = &impl_->texture;
+        configureCaptureDevice(device, w, h, impl_->desiredFrameRate, impl_->width, impl_->height);
 
         dispatch_queue_t captureQueue = dispatch_queue_create("com.oflike.captureQueue", DISPATCH_QUEUE_SERIAL);
-        [impl_->captureOutput setSampleBufferDelegate:impl_->captureDelegate queue:captureQueue];
-
-        if (![impl_->captureSession canAddOutput:impl_->captureOutput]) {
-            NSLog(@"ofVideoGrabber: Cannot add capture output to session");
-            [impl_->captureSession removeInput:impl_->captureInput];
-            impl_->captureInput = nil;
-            impl_->captureOutput = nil;
-            impl_->captureSession = nil;
+        if (!openCaptureStream(device, captureQueue, impl_->stream)) {
+            impl_->captureDevice = nil;
             return false;
         }
-        [impl_->captureSession addOutput:impl_->captureOutput];
 
-        // Allocate texture and pixels
+        // Allocate texture
         if (impl_->width <= 0) impl_->width = w;
         if (impl_->height <= 0) impl_->height = h;
 
-        impl_->texture.allocate(impl_->width, impl_->height, OF_IMAGE_COLOR_ALPHA);
-        impl_->pixels.allocate(impl_->width, impl_->height, 4);
+        impl_->texture.allocateStreaming(impl_->width, impl_->height, OF_IMAGE_COLOR_ALPHA);
 
         // Start capture
-        [impl_->captureSession startRunning];
+        [impl_->stream.session startRunning];
 
         impl_->initialized = true;
 
@@ -437,20 +249,34 @@ float ofVideoGrabber::getFrameRate() const {
 
 void ofVideoGrabber::update() {
     if (!impl_ || !impl_->initialized) return;
+    OF_PROFILE_SCOPE("ofVideoGrabber::update");
 
     impl_->frameNew = false;
 
     @autoreleasepool {
-        if (impl_->captureDelegate.frameNew) {
-            // Update texture from pixels on main thread
-            impl_->texture.loadData(impl_->pixels);
+        render::IRenderer* renderer = Context::instance().renderer();
+        CaptureFrame frame;
+        if ([impl_->stream.delegate frames]->take(frame)) {
+            impl_->frames.setFrame(frame.buffer, impl_->texture);
             impl_->frameNew = true;
-            impl_->captureDelegate.frameNew = false;
+            impl_->frameTimestamp = frame.captureTime;
 
             // Update actual dimensions
-            impl_->width = impl_->captureDelegate.width;
-            impl_->height = impl_->captureDelegate.height;
+            impl_->width = static_cast<int>(CVPixelBufferGetWidth(frame.buffer));
+            impl_->height = static_cast<int>(CVPixelBufferGetHeight(frame.buffer));
+
+            // Oldest frames give way when presentation isn't reported
+            if (renderer) {
+                if (impl_->pendingCount == Impl::kPendingFrames) {
+                    std::move(impl_->pendingFrames + 1, impl_->pendingFrames + Impl::kPendingFrames,
+                              impl_->pendingFrames);
+                    impl_->pendingCount--;
+                }
+                impl_->pendingFrames[impl_->pendingCount++] = {renderer->getRecordingFrameSerial(),
+                                                               frame.captureTime};
+            }
         }
+        impl_->measureLatency(renderer);
     }
 }
 
@@ -458,6 +284,23 @@ bool ofVideoGrabber::isFrameNew() const {
     return impl_ && impl_->frameNew;
 }
 
+double ofVideoGrabber::getFrameTimestamp() const {
+    return impl_ ? impl_->frameTimestamp : 0.0;
+}
+
+ofVideoGrabberLatency ofVideoGrabber::getLatency() const {
+    if (!impl_) {
+        return ofVideoGrabberLatency();
+    }
+    ofVideoGrabberLatency latency = impl_->latency;
+    if (impl_->stream.delegate) {
+        FrameTripleBuffer* frames = [impl_->stream.delegate frames];
+        latency.framesCaptured = frames->captured();
+        latency.framesDropped = frames->dropped();
+    }
+    return latency;
+}
+
 // ============================================================================
 // Drawing
 // ============================================================================
@@ -487,11 +330,11 @@ const ofTexture& ofVideoGrabber::getTexture() const {
 
 ofPixels& ofVideoGrabber::getPixels() {
     ensureImpl();
-    return impl_->pixels;
+    return impl_->frames.getPixels();
 }
 
 const ofPixels& ofVideoGrabber::getPixels() const {
-    return impl_->pixels;
+    return impl_->frames.getPixels();
 }
 
 // ============================================================================
@@ -39,9 +39,14 @@ enum ofVideoState {
 /// Implementation:
 /// - Uses AVPlayer for playback
 /// - Uses AVPlayerItemVideoOutput for frame access
-/// - Uses Metal textures for GPU rendering
+/// - Decodes to bi-planar YCbCr 4:2:0 and converts to RGB on the GPU,
+///   sampling the decoder's IOSurfaces in place (CVMetalTextureCache);
+///   CPU pixels are only made on getPixels()
 /// - pImpl pattern to hide Objective-C++ details
 ///
+/// Rigs driving many silent clips with frame-accurate seeking and reverse
+/// playback should use ofVideoClip instead.
+///
 /// Example:
 /// \code
 ///     ofVideoPlayer video;
@@ -240,6 +245,8 @@ public:
     const ofTexture& getTexture() const;
 
     /// \brief Get pixel data from current frame
+    /// \details Frames are drawn straight from the decoder's buffers; the
+    /// first call after a new frame converts it to RGBA pixels on the CPU.
     /// \return Reference to ofPixels containing frame data
     ofPixels& getPixels();
 
@@ -2,7 +2,9 @@
 #import <AVFoundation/AVFoundation.h>
 #import <CoreMedia/CoreMedia.h>
 #import <CoreVideo/CoreVideo.h>
+#import "VideoFrameTexture.h"
 #import "../../core/Context.h"
+#import "../utils/ofProfiler.h"
 
 namespace oflike {
 
@@ -17,7 +19,10 @@ struct ofVideoPlayer::Impl {
     AVAsset* asset = nil;
 
     ofTexture texture;
-    ofPixels pixels;
+
+    // Decoded frames are drawn from their IOSurfaces; CPU pixels are made
+    // only when getPixels() asks for them
+    VideoFrameTexture frames;
 
     int width = 0;
     int height = 0;
@@ -65,7 +70,7 @@ struct ofVideoPlayer::Impl {
             asset = nil;
 
             texture.clear();
-            pixels.clear();
+            frames.clear();
 
             width = 0;
             height = 0;
@@ -208,10 +213,12 @@ bool ofVideoPlayer::load(const std::string& path) {
         NSArray* audioTracks = [impl_->asset tracksWithMediaType:AVMediaTypeAudio];
         impl_->hasAudioTrack = [audioTracks count] > 0;
 
-        // Create video output with pixel format
+        // Bi-planar 4:2:0 output takes half the bandwidth of BGRA and is
+        // converted on the GPU; IOSurface backing lets Metal sample it in place
         NSDictionary* pixelBufferAttributes = @{
-            (id)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
-            (id)kCVPixelBufferMetalCompatibilityKey: @YES
+            (id)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange),
+            (id)kCVPixelBufferMetalCompatibilityKey: @YES,
+            (id)kCVPixelBufferIOSurfacePropertiesKey: @{}
         };
 
         impl_->videoOutput = [[AVPlayerItemVideoOutput alloc]
@@ -274,9 +281,8 @@ bool ofVideoPlayer::load(const std::string& path) {
                 }
             }];
 
-        // Allocate texture and pixels
-        impl_->texture.allocate(impl_->width, impl_->height, OF_IMAGE_COLOR_ALPHA);
-        impl_->pixels.allocate(impl_->width, impl_->height, 4);
+        // Allocate texture
+        impl_->texture.allocateStreaming(impl_->width, impl_->height, OF_IMAGE_COLOR_ALPHA);
 
         impl_->loaded = true;
         impl_->finished = false;
@@ -488,6 +494,7 @@ void ofVideoPlayer::setVolume(float volume) {
 
 void ofVideoPlayer::update() {
     if (!impl_ || !impl_->loaded) return;
+    OF_PROFILE_SCOPE("ofVideoPlayer::update");
 
     impl_->frameNew = false;
 
@@ -498,43 +505,8 @@ void ofVideoPlayer::update() {
             CVPixelBufferRef pixelBuffer = [impl_->videoOutput copyPixelBufferForItemTime:currentTime
                                                                        itemTimeForDisplay:nil];
             if (pixelBuffer) {
-                // Lock the pixel buffer
-                CVPixelBufferLockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
-
-                // Get pixel data
-                size_t width = CVPixelBufferGetWidth(pixelBuffer);
-                size_t height = CVPixelBufferGetHeight(pixelBuffer);
-                size_t bytesPerRow = CVPixelBufferGetBytesPerRow(pixelBuffer);
-                void* baseAddress = CVPixelBufferGetBaseAddress(pixelBuffer);
-
-                // Update pixels (BGRA format)
-                if (impl_->pixels.getWidth() != width || impl_->pixels.getHeight() != height) {
-                    impl_->pixels.allocate(width, height, 4);
-                }
-
-                // Convert BGRA to RGBA
-                unsigned char* srcData = static_cast<unsigned char*>(baseAddress);
-                unsigned char* dstData = impl_->pixels.getData();
-
-                for (size_t y = 0; y < height; ++y) {
-                    unsigned char* srcRow = srcData + y * bytesPerRow;
-                    unsigned char* dstRow = dstData + y * width * 4;
-
-                    for (size_t x = 0; x < width; ++x) {
-                        dstRow[x * 4 + 0] = srcRow[x * 4 + 2]; // R from B
-                        dstRow[x * 4 + 1] = srcRow[x * 4 + 1]; // G
-                        dstRow[x * 4 + 2] = srcRow[x * 4 + 0]; // B from R
-                        dstRow[x * 4 + 3] = srcRow[x * 4 + 3]; // A
-                    }
-                }
-
-                // Unlock pixel buffer
-                CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+                impl_->frames.setFrame(pixelBuffer, impl_->texture);
                 CVPixelBufferRelease(pixelBuffer);
-
-                // Update texture
-                impl_->texture.loadData(impl_->pixels);
-
                 impl_->frameNew = true;
             }
         }
@@ -574,11 +546,11 @@ const ofTexture& ofVideoPlayer::getTexture() const {
 
 ofPixels& ofVideoPlayer::getPixels() {
     ensureImpl();
-    return impl_->pixels;
+    return impl_->frames.getPixels();
 }
 
 const ofPixels& ofVideoPlayer::getPixels() const {
-    return impl_->pixels;
+    return impl_->frames.getPixels();
 }
 
 // ============================================================================
@@ -0,0 +1,140 @@
+#pragma once
+
+// oflike-metal ofVideoRecorder - hardware-encoded recording of FBOs and the screen
+// Copies frames on the GPU into the encoder's own pixel buffers and encodes
+// them with VideoToolbox in the background, so recording never reads pixels
+// back to the CPU or waits in the render loop
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include "../image/ofTexture.h"
+
+namespace oflike {
+
+class ofFbo;
+
+/// \brief Codec of an ofVideoRecorder file
+enum ofVideoCodec {
+    OF_VIDEO_CODEC_H264 = 0,
+    OF_VIDEO_CODEC_HEVC = 1,
+    OF_VIDEO_CODEC_PRORES_422 = 2,
+    OF_VIDEO_CODEC_PRORES_4444 = 3     ///< Keeps alpha with keepAlpha
+};
+
+/// \brief Recording settings
+struct ofVideoRecorderSettings {
+    int width = 0;                  ///< Video width; 0 uses the viewport at start()
+    int height = 0;                 ///< Video height; 0 uses the viewport at start()
+    float frameRate = 60.0f;        ///< Nominal rate; with realtime off, each frame lasts 1 / frameRate
+    ofVideoCodec codec = OF_VIDEO_CODEC_HEVC;
+    float bitrateMbps = 0.0f;       ///< H.264/HEVC only; 0 picks one from size and frame rate
+    bool realtime = true;           ///< Timestamp frames by the clock and drop those the encoder can't take
+    bool keepAlpha = false;         ///< Record alpha (ProRes 4444); otherwise frames are opaque
+};
+
+/// \brief Records FBOs, textures or the screen into a movie file
+/// \details Each addFrame() takes a BGRA buffer from the writer's pixel
+/// buffer pool, wraps it as a Metal texture (CVMetalTextureCache) and
+/// records a GPU copy of the source into it, scaled to the video size.
+/// When the frame's command buffer completes, the buffer is handed to the
+/// hardware encoder on a background queue. The render loop never waits:
+/// when the encoder falls behind and every pooled buffer is in flight, the
+/// frame is dropped and counted instead.
+///
+/// In realtime mode frames are timestamped by the clock when they are added,
+/// which suits screen recordings; otherwise frame n is stamped n / frameRate
+/// and accepted frames are never dropped after the copy.
+///
+/// Example:
+/// \code
+///     ofVideoRecorder recorder;
+///     ofVideoRecorderSettings settings;
+///     settings.width = 1920;
+///     settings.height = 1080;
+///     recorder.setup(settings);
+///     recorder.start("/tmp/capture.mov");
+///
+///     // In draw(), after drawing into fbo
+///     recorder.addFrame(fbo);
+///
+///     // Later: finishes in the background once the last frames are encoded
+///     recorder.stop([](bool ok) { ofLogNotice() << "Saved: " << ok; });
+/// \endcode
+class ofVideoRecorder {
+public:
+    ofVideoRecorder();
+    ~ofVideoRecorder();
+
+    ofVideoRecorder(const ofVideoRecorder&) = delete;
+    ofVideoRecorder& operator=(const ofVideoRecorder&) = delete;
+
+    // ========================================================================
+    // Setup & Control
+    // ========================================================================
+
+    /// \brief Set the settings of the next recording
+    /// \return false if the settings can't be recorded (the reason is logged)
+    bool setup(const ofVideoRecorderSettings& settings);
+
+    /// \brief Get the recording settings
+    const ofVideoRecorderSettings& getSettings() const;
+
+    /// \brief Start recording into a file, replacing any file at the path
+    /// \param path .mov, or .mp4/.m4v for H.264 and HEVC
+    /// \return true if the writer started
+    bool start(const std::string& path);
+
+    /// \brief Stop recording
+    /// \details Returns at once. Frames already added are encoded, then the
+    /// file is finished in the background.
+    /// \param onFinished Called on a background queue with whether the file
+    ///        was written
+    void stop(std::function<void(bool)> onFinished = nullptr);
+
+    /// \brief Abort recording and delete the file
+    void cancel();
+
+    /// \brief Check if frames are being accepted
+    bool isRecording() const;
+
+    /// \brief Check if a stopped recording is still being written
+    bool isFinishing() const;
+
+    // ========================================================================
+    // Frames
+    // ========================================================================
+
+    /// \brief Record an FBO's color texture as it looks after this frame's
+    /// drawing so far
+    /// \return false if the frame was dropped
+    bool addFrame(const ofFbo& fbo);
+
+    /// \brief Record a texture as it looks after this frame's drawing so far
+    /// \return false if the frame was dropped
+    bool addFrame(const ofTexture& texture);
+
+    /// \brief Record the screen as drawn so far this frame
+    /// \details Call at the end of draw() to capture the full frame.
+    /// \return false if the frame was dropped
+    bool addScreenFrame();
+
+    // ========================================================================
+    // Statistics
+    // ========================================================================
+
+    /// \brief Frames handed to the encoder since start()
+    uint64_t getFramesRecorded() const;
+
+    /// \brief Frames dropped since start() (encoder behind or GPU copy failed)
+    uint64_t getFramesDropped() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+
+    bool addFrame(void* source);
+};
+
+} // namespace oflike
@@ -0,0 +1,485 @@
+#import "ofVideoRecorder.h"
+#import <AVFoundation/AVFoundation.h>
+#import <CoreVideo/CoreVideo.h>
+#import <Metal/Metal.h>
+#import <QuartzCore/QuartzCore.h>
+#import <VideoToolbox/VideoToolbox.h>
+#include "../graphics/ofFbo.h"
+#include "../../core/Context.h"
+#include "../../render/DrawList.h"
+#include "../../render/DrawCommand.h"
+#include "../../render/IRenderer.h"
+#include "../../render/CopyTextureRegistry.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace oflike {
+
+// ============================================================================
+// Constants
+// ============================================================================
+
+// Pixel buffers the writer's pool may hand out at once: frames being copied
+// on the GPU plus frames waiting for the encoder. Beyond this, frames drop.
+static constexpr int kMaxFramesInFlight = 6;
+
+// Timescale of realtime and fixed-rate timestamps
+static constexpr int32_t kTimescale = 600000;
+
+// ============================================================================
+// Recording Session
+// ============================================================================
+
+namespace {
+
+// One recording, shared with the frames still in flight so stop() can
+// return while they finish
+struct Session {
+    AVAssetWriter* writer = nil;
+    AVAssetWriterInput* input = nil;
+    AVAssetWriterInputPixelBufferAdaptor* adaptor = nil;
+    CVMetalTextureCacheRef textureCache = nullptr;
+    dispatch_queue_t queue = nullptr;
+    NSURL* url = nil;
+    bool realtime = true;
+
+    std::atomic<uint64_t> recorded{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> done{false};
+
+    // Session queue only
+    int inFlight = 0;
+    bool stopping = false;
+    bool cancelled = false;
+    bool finishing = false;
+    CMTime lastTime = kCMTimeNegativeInfinity;
+    std::function<void(bool)> onFinished;
+
+    ~Session() {
+        if (textureCache) {
+            CFRelease(textureCache);
+        }
+    }
+};
+
+struct Capture {
+    std::shared_ptr<Session> session;
+    CVPixelBufferRef buffer = nullptr;
+    CVMetalTextureRef texture = nullptr;   // Keeps the GPU's view of buffer alive
+    CMTime time = kCMTimeInvalid;
+};
+
+void finishSession(const std::shared_ptr<Session>& session) {
+    if (session->finishing) return;
+    session->finishing = true;
+
+    if (session->cancelled || session->writer.status != AVAssetWriterStatusWriting) {
+        if (!session->cancelled) {
+            NSLog(@"ofVideoRecorder: Writer failed: %@", session->writer.error.localizedDescription);
+        }
+        if (session->onFinished) session->onFinished(false);
+        session->done = true;
+        return;
+    }
+
+    [session->input markAsFinished];
+    std::shared_ptr<Session> keep = session;
+    [session->writer finishWritingWithCompletionHandler:^{
+        const bool ok = keep->writer.status == AVAssetWriterStatusCompleted;
+        if (ok) {
+            NSLog(@"ofVideoRecorder: Wrote %llu frames (%llu dropped) to %@",
+                  keep->recorded.load(), keep->dropped.load(), keep->url.path);
+        } else {
+            NSLog(@"ofVideoRecorder: Failed to finish %@: %@",
+                  keep->url.path, keep->writer.error.localizedDescription);
+        }
+        if (keep->onFinished) keep->onFinished(ok);
+        keep->done = true;
+    }];
+}
+
+// Hand a copied frame to the encoder (session queue)
+void encodeCapture(const Capture& capture, bool succeeded) {
+    Session& session = *capture.session;
+
+    if (!session.cancelled) {
+        bool appended = false;
+        if (succeeded && session.writer.status == AVAssetWriterStatusWriting &&
+            CMTimeCompare(capture.time, session.lastTime) > 0) {
+            // Fixed-rate frames are never dropped here: wait for the encoder,
+            // which only holds up this queue
+            while (!session.realtime && !session.input.readyForMoreMediaData &&
+                   session.writer.status == AVAssetWriterStatusWriting) {
+                [NSThread sleepForTimeInterval:0.001];
+            }
+            if (session.input.readyForMoreMediaData &&
+                [session.adaptor appendPixelBuffer:capture.buffer withPresentationTime:capture.time]) {
+                session.lastTime = capture.time;
+                appended = true;
+            }
+        }
+        (appended ? session.recorded : session.dropped)++;
+    }
+
+    if (capture.texture) CFRelease(capture.texture);
+    CVPixelBufferRelease(capture.buffer);
+
+    session.inFlight--;
+    if (session.stopping && session.inFlight == 0) {
+        finishSession(capture.session);
+    }
+}
+
+using CaptureRegistry = render::CopyTextureRegistry<Capture, &encodeCapture>;
+
+bool isMPEG4Path(NSString* path) {
+    NSString* ext = path.pathExtension.lowercaseString;
+    return [ext isEqualToString:@"mp4"] || [ext isEqualToString:@"m4v"];
+}
+
+} // namespace
+
+// ============================================================================
+// ofVideoRecorder::Impl
+// ============================================================================
+
+struct ofVideoRecorder::Impl {
+    ofVideoRecorderSettings settings;
+    std::shared_ptr<Session> session;
+    bool stopped = true;           // No frames accepted (before start or after stop)
+
+    int width = 0;
+    int height = 0;
+    double startTime = 0.0;
+    uint64_t frameIndex = 0;       // Fixed-rate timestamp of the next frame
+    NSDictionary* auxAttributes = nil;
+
+    ~Impl() {
+        // An unfinished recording is completed in the background
+        if (session && !stopped) {
+            stop(nullptr);
+        }
+    }
+
+    NSDictionary* videoSettings() const {
+        NSMutableDictionary* video = [NSMutableDictionary dictionary];
+        video[AVVideoWidthKey] = @(width);
+        video[AVVideoHeightKey] = @(height);
+
+        switch (settings.codec) {
+            case OF_VIDEO_CODEC_H264:
+            case OF_VIDEO_CODEC_HEVC: {
+                video[AVVideoCodecKey] = settings.codec == OF_VIDEO_CODEC_H264
+                    ? AVVideoCodecTypeH264 : AVVideoCodecTypeHEVC;
+
+                // 0.2 bits per pixel unless asked for
+                const double mbps = settings.bitrateMbps > 0.0f
+                    ? settings.bitrateMbps
+                    : static_cast<double>(width) * height * 0.2 * settings.frameRate / 1000000.0;
+
+                NSMutableDictionary* compression = [NSMutableDictionary dictionary];
+                compression[AVVideoAverageBitRateKey] = @(mbps * 1000000.0);
+                compression[AVVideoExpectedSourceFrameRateKey] = @(settings.frameRate);
+                compression[AVVideoMaxKeyFrameIntervalKey] = @(static_cast<int>(std::ceil(settings.frameRate)));
+                if (settings.codec == OF_VIDEO_CODEC_H264) {
+                    compression[AVVideoProfileLevelKey] = AVVideoProfileLevelH264HighAutoLevel;
+                }
+                // Without a free hardware session the file would silently
+                // encode in software, far too slow for realtime
+                compression[AVVideoEncoderSpecificationKey] = @{
+                    (__bridge NSString*)kVTVideoEncoderSpecification_EnableHardwareAcceleratedVideoEncoder: @YES
+                };
+                video[AVVideoCompressionPropertiesKey] = compression;
+                break;
+            }
+            case OF_VIDEO_CODEC_PRORES_422:
+                video[AVVideoCodecKey] = AVVideoCodecTypeAppleProRes422;
+                break;
+            case OF_VIDEO_CODEC_PRORES_4444:
+                video[AVVideoCodecKey] = AVVideoCodecTypeAppleProRes4444;
+                break;
+        }
+        return video;
+    }
+
+    bool start(const std::string& path) {
+        auto& ctx = Context::instance();
+        if (!ctx.isInitialized()) {
+            NSLog(@"ofVideoRecorder: Context not initialized");
+            return false;
+        }
+
+        width = settings.width;
+        height = settings.height;
+        if (width <= 0 || height <= 0) {
+            width = static_cast<int>(ctx.renderer()->getViewportWidth());
+            height = static_cast<int>(ctx.renderer()->getViewportHeight());
+        }
+        if (settings.codec == OF_VIDEO_CODEC_H264 || settings.codec == OF_VIDEO_CODEC_HEVC) {
+            // 4:2:0 needs even dimensions
+            width &= ~1;
+            height &= ~1;
+        }
+        if (width <= 0 || height <= 0) {
+            NSLog(@"ofVideoRecorder: Invalid size %dx%d", width, height);
+            return false;
+        }
+
+        auto next = std::make_shared<Session>();
+        next->realtime = settings.realtime;
+        next->url = [NSURL fileURLWithPath:[NSString stringWithUTF8String:path.c_str()]];
+
+        const bool mpeg4 = isMPEG4Path(next->url.path);
+        if (mpeg4 && (settings.codec == OF_VIDEO_CODEC_PRORES_422 || settings.codec == OF_VIDEO_CODEC_PRORES_4444)) {
+            NSLog(@"ofVideoRecorder: ProRes needs a .mov file");
+            return false;
+        }
+        [[NSFileManager defaultManager] removeItemAtURL:next->url error:nil];
+
+        NSError* error = nil;
+        next->writer = [[AVAssetWriter alloc] initWithURL:next->url
+                                                 fileType:mpeg4 ? AVFileTypeMPEG4 : AVFileTypeQuickTimeMovie
+                                                    error:&error];
+        if (!next->writer) {
+            NSLog(@"ofVideoRecorder: Failed to create writer: %@", error.localizedDescription);
+            return false;
+        }
+
+        next->input = [[AVAssetWriterInput alloc] initWithMediaType:AVMediaTypeVideo
+                                                     outputSettings:videoSettings()];
+        next->input.expectsMediaDataInRealTime = settings.realtime;
+
+        // Metal-compatible IOSurface buffers, so the GPU copies straight into them
+        NSDictionary* bufferAttributes = @{
+            (NSString*)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
+            (NSString*)kCVPixelBufferWidthKey: @(width),
+            (NSString*)kCVPixelBufferHeightKey: @(height),
+            (NSString*)kCVPixelBufferMetalCompatibilityKey: @YES,
+            (NSString*)kCVPixelBufferIOSurfacePropertiesKey: @{},
+        };
+        next->adaptor = [[AVAssetWriterInputPixelBufferAdaptor alloc]
+                         initWithAssetWriterInput:next->input
+                         sourcePixelBufferAttributes:bufferAttributes];
+
+        if (![next->writer canAddInput:next->input]) {
+            NSLog(@"ofVideoRecorder: Codec not supported for %@", next->url.lastPathComponent);
+            return false;
+        }
+        [next->writer addInput:next->input];
+
+        // The copy kernel writes the buffers, so the textures need write usage
+        NSDictionary* textureAttributes = @{
+            (NSString*)kCVMetalTextureUsage: @(MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite),
+        };
+        id<MTLDevice> device = (__bridge id<MTLDevice>)ctx.getMetalDevice();
+        if (CVMetalTextureCacheCreate(kCFAllocatorDefault, nil, device,
+                                      (__bridge CFDictionaryRef)textureAttributes,
+                                      &next->textureCache) != kCVReturnSuccess) {
+            NSLog(@"ofVideoRecorder: Failed to create texture cache");
+            return false;
+        }
+
+        if (![next->writer startWriting]) {
+            NSLog(@"ofVideoRecorder: Failed to start writing: %@", next->writer.error.localizedDescription);
+            return false;
+        }
+        [next->writer startSessionAtSourceTime:kCMTimeZero];
+
+        next->queue = dispatch_queue_create("com.oflike.videoRecorder", DISPATCH_QUEUE_SERIAL);
+        auxAttributes = @{
+            (NSString*)kCVPixelBufferPoolAllocationThresholdKey: @(kMaxFramesInFlight),
+        };
+
+        session = std::move(next);
+        stopped = false;
+        startTime = CACurrentMediaTime();
+        frameIndex = 0;
+
+        NSLog(@"ofVideoRecorder: Recording %dx%d to %@", width, height, session->url.path);
+        return true;
+    }
+
+    bool addFrame(void* source) {
+        if (!session || stopped) return false;
+
+        CMTime time = settings.realtime
+            ? CMTimeMakeWithSeconds(CACurrentMediaTime() - startTime, kTimescale)
+            : CMTimeMakeWithSeconds(frameIndex / static_cast<double>(settings.frameRate), kTimescale);
+
+        CVPixelBufferPoolRef pool = session->adaptor.pixelBufferPool;
+        CVPixelBufferRef buffer = nullptr;
+        if (!pool || CVPixelBufferPoolCreatePixelBufferWithAuxAttributes(
+                kCFAllocatorDefault, pool, (__bridge CFDictionaryRef)auxAttributes, &buffer) != kCVReturnSuccess) {
+            // Every buffer is still in flight: the encoder is behind
+            session->dropped++;
+            return false;
+        }
+
+        CVMetalTextureRef texture = nullptr;
+        if (CVMetalTextureCacheCreateTextureFromImage(kCFAllocatorDefault, session->textureCache, buffer, nil,
+                                                      MTLPixelFormatBGRA8Unorm, width, height, 0,
+                                                      &texture) != kCVReturnSuccess) {
+            CVPixelBufferRelease(buffer);
+            session->dropped++;
+            return false;
+        }
+
+        auto& ctx = Context::instance();
+        Capture capture;
+        capture.session = session;
+        capture.buffer = buffer;
+        capture.texture = texture;
+        capture.time = time;
+
+        render::CopyTextureCommand cmd;
+        cmd.source = source;
+        cmd.destination = (__bridge void*)CVMetalTextureGetTexture(texture);
+        cmd.opaque = !settings.keepAlpha;
+        CaptureRegistry::add(cmd, std::move(capture), session->queue, ctx.getFrameNum());
+
+        std::shared_ptr<Session> counted = session;
+        dispatch_async(session->queue, ^{
+            counted->inFlight++;
+        });
+
+        ctx.getDrawList().addCommand(cmd);
+        CVMetalTextureCacheFlush(session->textureCache, 0);
+        frameIndex++;
+        return true;
+    }
+
+    void stop(std::function<void(bool)> onFinished) {
+        if (!session || stopped) {
+            if (onFinished) onFinished(false);
+            return;
+        }
+        stopped = true;
+
+        CaptureRegistry::abandon(Context::instance().getFrameNum());
+
+        std::shared_ptr<Session> ending = session;
+        dispatch_async(ending->queue, ^{
+            ending->onFinished = onFinished;
+            ending->stopping = true;
+            if (ending->inFlight == 0) {
+                finishSession(ending);
+            }
+        });
+    }
+
+    void cancel() {
+        if (!session) return;
+        stopped = true;
+
+        std::shared_ptr<Session> ending = session;
+        dispatch_async(ending->queue, ^{
+            if (ending->finishing) return;     // Already being written out
+            ending->cancelled = true;
+            ending->stopping = true;
+            if (ending->writer.status == AVAssetWriterStatusWriting) {
+                [ending->writer cancelWriting];
+            }
+            [[NSFileManager defaultManager] removeItemAtURL:ending->url error:nil];
+            if (ending->inFlight == 0) {
+                finishSession(ending);
+            }
+        });
+        session.reset();
+    }
+};
+
+// ============================================================================
+// ofVideoRecorder Implementation
+// ============================================================================
+
+ofVideoRecorder::ofVideoRecorder()
+    : impl_(std::make_unique<Impl>()) {
+}
+
+ofVideoRecorder::~ofVideoRecorder() = default;
+
+// ============================================================================
+// Setup & Control
+// ============================================================================
+
+bool ofVideoRecorder::setup(const ofVideoRecorderSettings& settings) {
+    if (settings.frameRate <= 0.0f) {
+        NSLog(@"ofVideoRecorder: Invalid frame rate %.2f", settings.frameRate);
+        return false;
+    }
+    if (settings.keepAlpha && settings.codec != OF_VIDEO_CODEC_PRORES_4444) {
+        NSLog(@"ofVideoRecorder: Only ProRes 4444 keeps alpha");
+        return false;
+    }
+    impl_->settings = settings;
+    return true;
+}
+
+const ofVideoRecorderSettings& ofVideoRecorder::getSettings() const {
+    return impl_->settings;
+}
+
+bool ofVideoRecorder::start(const std::string& path) {
+    if (isRecording()) {
+        stop();
+    }
+    @autoreleasepool {
+        return impl_->start(path);
+    }
+}
+
+void ofVideoRecorder::stop(std::function<void(bool)> onFinished) {
+    impl_->stop(std::move(onFinished));
+}
+
+void ofVideoRecorder::cancel() {
+    impl_->cancel();
+}
+
+bool ofVideoRecorder::isRecording() const {
+    return impl_->session && !impl_->stopped;
+}
+
+bool ofVideoRecorder::isFinishing() const {
+    return impl_->session && impl_->stopped && !impl_->session->done;
+}
+
+// ============================================================================
+// Frames
+// ============================================================================
+
+bool ofVideoRecorder::addFrame(const ofFbo& fbo) {
+    // The FBO's ofTexture wrappers carry no Metal texture; use its attachment
+    void* handle = fbo.getNativeTextureHandle(0);
+    return handle ? addFrame(handle) : false;
+}
+
+bool ofVideoRecorder::addFrame(const ofTexture& texture) {
+    void* handle = texture.getNativeHandle();
+    return handle ? addFrame(handle) : false;
+}
+
+bool ofVideoRecorder::addScreenFrame() {
+    return addFrame(static_cast<void*>(nullptr));
+}
+
+bool ofVideoRecorder::addFrame(void* source) {
+    @autoreleasepool {
+        return impl_->addFrame(source);
+    }
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+uint64_t ofVideoRecorder::getFramesRecorded() const {
+    return impl_->session ? impl_->session->recorded.load() : 0;
+}
+
+uint64_t ofVideoRecorder::getFramesDropped() const {
+    return impl_->session ? impl_->session->dropped.load() : 0;
+}
+
+} // namespace oflike
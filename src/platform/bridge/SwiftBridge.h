@@ -61,8 +61,12 @@ typedef ofBaseApp* (*OfAppFactoryFunc)();
 - (void)windowResizedWidth:(float)width height:(float)height;
 
 /// Mouse events
-- (void)mouseMovedX:(float)x y:(float)y;
-- (void)mouseDraggedX:(float)x y:(float)y button:(int)button;
+/// Motion carries the NSEvent timestamp (seconds since system start-up) so
+/// coalesced paths keep the device's own timing
+- (void)mouseMovedX:(float)x y:(float)y timestamp:(double)timestamp;
+- (void)mouseDraggedX:(float)x y:(float)y button:(int)button timestamp:(double)timestamp;
+- (void)mouseMovedX:(float)x y:(float)y;                            // Stamped on arrival
+- (void)mouseDraggedX:(float)x y:(float)y button:(int)button;       // Stamped on arrival
 - (void)mousePressedX:(float)x y:(float)y button:(int)button;
 - (void)mouseReleasedX:(float)x y:(float)y button:(int)button;
 - (void)mouseScrolledX:(float)x y:(float)y scrollX:(float)scrollX scrollY:(float)scrollY;
@@ -106,4 +110,33 @@ typedef ofBaseApp* (*OfAppFactoryFunc)();
                    vertices:(uint32_t*)outVertices
                     gpuTime:(double*)outGPUTime;
 
+/// Get the per-pass GPU timeline of the last completed frame
+/// @return Array of dictionaries with keys "name" (NSString), "start" and
+///         "duration" (NSNumber, milliseconds); empty if the GPU cannot time passes
+- (NSArray<NSDictionary<NSString*, id>*>*)getGPUTimeline;
+
+/// Get the rows published through ofDebugStats (e.g. network counters)
+/// @return Array of dictionaries with keys "group", "name" and "value" (NSString)
+- (NSArray<NSDictionary<NSString*, NSString*>*>*)getDebugStats;
+
+/// Get the frame pacing mode set with ofSetFramePacing()
+/// @return 0 = throughput, 1 = low latency, 2 = adaptive
+- (int)getFramePacing;
+
+/// Get the frame rate set with ofSetFrameRate()
+- (float)getTargetFrameRate;
+
+/// Get the refresh rate range of the adaptive pacing mode
+- (void)getFrameRateRangeMin:(float*)outMin max:(float*)outMax;
+
+/// Start or stop recording OF_PROFILE_SCOPE timings in-app (ofProfiler)
+- (void)setProfilerEnabled:(bool)enabled;
+
+/// Get the scope profile of recent frames
+/// @return Dictionary with "enabled", "dropped", "durations" (ms per frame, oldest first)
+///         and, once a frame was recorded, "last" and "worst": dictionaries with "frame",
+///         "duration" (ms) and "rows" (keys "thread", "name", "depth", "ms", "calls"),
+///         rows depth-first per thread
+- (NSDictionary<NSString*, id>*)getProfile;
+
 @end
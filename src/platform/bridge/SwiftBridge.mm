@@ -1,10 +1,23 @@
 #import "SwiftBridge.h"
+#import <QuartzCore/QuartzCore.h>
+#include <cstdio>
 #include <memory>
 #include <iostream>
+#include <vector>
 #include "../../core/TestApp.h"
 #include "../../core/Context.h"
 #include "../../core/EventDispatcher.h"
 #include "../../render/metal/MetalRenderer.h"  // Phase 16.2: For performance stats
+#include "../../oflike/utils/ofDebugStats.h"
+#include "../../oflike/utils/ofAsyncIO.h"
+#include "../../oflike/utils/ofFlightRecorder.h"
+#include "../../oflike/utils/ofFrameCapture.h"
+#include "../../oflike/utils/ofGpuMemory.h"
+#include "../../oflike/utils/ofJobSystem.h"
+#include "../../oflike/utils/ofProfiler.h"
+#include "../../oflike/utils/ofTelemetry.h"
+#include "../../oflike/utils/ofUtils.h"
+#include "../../oflike/types/ofParameter.h"
 
 #ifdef __cplusplus
 extern "C" ofBaseApp* ofCreateApp(void);
@@ -19,9 +32,66 @@ extern "C" ofBaseApp* ofCreateApp(void);
     OfAppFactoryFunc appFactory_;
 
     bool isSetup_;
+
+    // Pipelined frames: serial render thread and a one-frame encode slot
+    dispatch_queue_t renderQueue_;
+    dispatch_semaphore_t encodeSlot_;
+
+    // Frame pacing last handed to the renderer, and its overlay rows
+    uint32_t appliedFramesInFlight_;
+    double appliedPresentDuration_;
+    int pacingStatsId_;
 }
 @end
 
+namespace {
+// Frames the renderer may queue outside the low-latency mode (its maximum)
+constexpr uint32_t kThroughputFramesInFlight = 3;
+
+const char* framePacingName(Context::FramePacing pacing) {
+    switch (pacing) {
+        case Context::FramePacing::LowLatency: return "Low Latency";
+        case Context::FramePacing::Adaptive: return "Adaptive";
+        default: return "Throughput";
+    }
+}
+
+void collectPacingRows(std::vector<oflike::ofDebugStat>& rows) {
+    Context& context = Context::instance();
+    rows.push_back({"Frame Pacing", "Mode", framePacingName(context.getFramePacing())});
+    if (auto* renderer = context.renderer()) {
+        rows.push_back({"Frame Pacing", "Frames in Flight", std::to_string(renderer->getMaxFramesInFlight())});
+    }
+    const Context::FrameLatency latency = context.getFrameLatency();
+    if (latency.framesMeasured > 0) {
+        char text[64];
+        std::snprintf(text, sizeof(text), "%.1f ms (avg %.1f, max %.1f)",
+                      latency.lastMs, latency.averageMs, latency.maxMs);
+        rows.push_back({"Frame Pacing", "Input to Photon", text});
+    }
+}
+
+// Optimize, execute and reset one frame's draw lists
+bool encodeDrawLists(render::IRenderer* renderer, const std::vector<render::DrawList*>& drawLists) {
+    OF_PROFILE_SCOPE("encodeDrawLists");
+
+    // Merge compatible consecutive draws before submission
+    for (render::DrawList* list : drawLists) {
+        list->optimize();
+    }
+    oflike::ofCaptureFrameDrawLists(drawLists.data(), drawLists.size());
+
+    bool executed = renderer->executeDrawLists(drawLists.data(), drawLists.size());
+    for (render::DrawList* list : drawLists) {
+        list->reset();
+    }
+    if (!executed) {
+        std::cerr << "[OFLBridge] executeDrawLists() failed" << std::endl;
+    }
+    return executed;
+}
+}  // namespace
+
 @implementation OFLBridge
 
 - (instancetype)init {
@@ -29,6 +99,11 @@ extern "C" ofBaseApp* ofCreateApp(void);
     if (self) {
         isSetup_ = false;
         appFactory_ = nullptr;
+        renderQueue_ = nil;
+        encodeSlot_ = nil;
+        appliedFramesInFlight_ = kThroughputFramesInFlight;
+        appliedPresentDuration_ = 0.0;
+        pacingStatsId_ = -1;
         std::cout << "[OFLBridge] Initialized" << std::endl;
     }
     return self;
@@ -81,6 +156,7 @@ extern "C" ofBaseApp* ofCreateApp(void);
             return;
         }
 
+        OF_STARTUP_SCOPE("App setup");
         std::cout << "[OFLBridge] Setup called" << std::endl;
 
         // Phase 2.1: Create user app via factory
@@ -100,7 +176,11 @@ extern "C" ofBaseApp* ofCreateApp(void);
         // Phase 13.4: Register app with EventDispatcher
         EventDispatcher::instance().setApp(userApp_.get());
 
-        userApp_->setup();
+        {
+            OF_STARTUP_SCOPE("ofApp::setup");
+            userApp_->setup();
+        }
+        pacingStatsId_ = oflike::ofDebugStats::addSource(collectPacingRows);
 
         isSetup_ = true;
         std::cout << "[OFLBridge] Setup complete" << std::endl;
@@ -112,14 +192,81 @@ extern "C" ofBaseApp* ofCreateApp(void);
         if (!isSetup_) {
             return;
         }
+        // Scopes recorded in-app since the last update form the previous frame
+        oflike::ofProfiler::endFrame();
+        oflike::ofTelemetry::endFrame();
+        oflike::ofFlightRecorder::endFrame();
+        OF_PROFILE_SCOPE("update");
 
         // Phase 2.1: Increment frame counter in context
         Context::instance().incrementFrame();
 
+        // Callbacks of file I/O finished since the last frame
+        oflike::ofDispatchAsyncIOCompletions();
+
+        // In low-latency mode this waits for the GPU, so input is read after it
+        [self applyFramePacing];
+
+        // Motion coalesced since the last frame, one callback per drag
+        EventDispatcher::instance().dispatchCoalescedMotion();
+
+        // The frame recorded now answers the newest input sample
+        const std::vector<ofMouseSample>& mousePath = EventDispatcher::instance().getMousePath();
+        Context::instance().sampleInputLatency(mousePath.empty() ? CACurrentMediaTime()
+                                                                 : mousePath.back().timestamp);
+
         // Phase 2.1: Update user app
         if (userApp_) {
+            OF_PROFILE_SCOPE("ofApp::update");
             userApp_->update();
         }
+
+        // Jobs launched in update() finish before draw() reads their results
+        {
+            OF_PROFILE_SCOPE("ofWaitForJobs");
+            oflike::ofWaitForJobs();
+        }
+
+        // Deferred parameters report this frame's final values before draw()
+        ofFlushParameterNotifications();
+    }
+}
+
+- (void)applyFramePacing {
+    Context& context = Context::instance();
+    render::IRenderer* renderer = context.renderer();
+    if (!renderer) {
+        return;
+    }
+
+    const Context::FramePacing pacing = context.getFramePacing();
+    float minFps = 0.0f;
+    float maxFps = 0.0f;
+    context.getFrameRateRange(minFps, maxFps);
+
+    // Low latency holds frames on screen for the target period instead of
+    // queueing more; adaptive keeps ProMotion from exceeding the range
+    uint32_t framesInFlight = kThroughputFramesInFlight;
+    double presentDuration = 0.0;
+    if (pacing == Context::FramePacing::LowLatency) {
+        framesInFlight = 1;
+        presentDuration = 1.0 / context.getTargetFrameRate();
+    } else if (pacing == Context::FramePacing::Adaptive) {
+        presentDuration = 1.0 / maxFps;
+    }
+
+    // The render thread must be idle while the renderer's pacing changes
+    if (framesInFlight != appliedFramesInFlight_ || presentDuration != appliedPresentDuration_) {
+        [self waitForPipelinedFrame];
+        renderer->setMaxFramesInFlight(framesInFlight);
+        renderer->setPresentMinimumDuration(presentDuration);
+        appliedFramesInFlight_ = framesInFlight;
+        appliedPresentDuration_ = presentDuration;
+    }
+
+    if (pacing == Context::FramePacing::LowLatency) {
+        OF_PROFILE_SCOPE("waitForFrameSlot");
+        renderer->acquireFrameSlot();
     }
 }
 
@@ -131,6 +278,7 @@ extern "C" ofBaseApp* ofCreateApp(void);
 
         // Phase 2.1: Draw user app
         if (userApp_) {
+            OF_PROFILE_SCOPE("ofApp::draw");
             userApp_->draw();
         }
     }
@@ -140,6 +288,8 @@ extern "C" ofBaseApp* ofCreateApp(void);
     renderPassDescriptor:(id)renderPassDescriptor
            commandQueue:(id)commandQueue {
     @autoreleasepool {
+        OF_PROFILE_SCOPE("renderFrame");
+
         // Phase 3.2: Execute rendering through MetalRenderer
         auto* renderer = Context::instance().renderer();
         if (!renderer) {
@@ -147,31 +297,117 @@ extern "C" ofBaseApp* ofCreateApp(void);
             return;
         }
 
+        // Low latency cannot afford the extra frame pipelining adds
+        if (Context::instance().isPipelinedFrames() &&
+            Context::instance().getFramePacing() != Context::FramePacing::LowLatency) {
+            [self renderFramePipelined:drawable renderPassDescriptor:renderPassDescriptor];
+            return;
+        }
+
+        // Leaving pipelined mode: let the last encoded frame finish first
+        [self waitForPipelinedFrame];
+
+        // Display link frames bring their own drawable; the view's is used otherwise
+        if (auto* metalRenderer = dynamic_cast<render::metal::MetalRenderer*>(renderer)) {
+            metalRenderer->setFrameTarget((__bridge void*)drawable, (__bridge void*)renderPassDescriptor);
+        }
+
         // Begin frame
         if (!renderer->beginFrame()) {
             std::cerr << "[OFLBridge] beginFrame() failed" << std::endl;
             return;
         }
 
+        // Let the DrawList write geometry straight into this frame's GPU buffers
+        render::DrawList& drawList = Context::instance().getDrawList();
+        renderer->bindFrameStorage(drawList);
+
         // Populate DrawList from user app before executing it
         if (userApp_) {
+            OF_PROFILE_SCOPE("ofApp::draw");
             userApp_->draw();
         }
 
-        // Execute DrawList (populated by user app's draw() calls)
-        render::DrawList& drawList = Context::instance().getDrawList();
-        if (!renderer->executeDrawList(drawList)) {
-            std::cerr << "[OFLBridge] executeDrawList() failed" << std::endl;
+        // Main list plus any lists workers submitted, in deterministic layer order
+        std::vector<render::DrawList*> drawLists;
+        Context::instance().collectDrawLists(drawLists);
+
+        if (!encodeDrawLists(renderer, drawLists)) {
             renderer->endFrame();
             return;
         }
-        drawList.reset();
 
         // End frame (submits command buffer and presents)
         if (!renderer->endFrame()) {
             std::cerr << "[OFLBridge] endFrame() failed" << std::endl;
             return;
         }
+        oflike::ofProfiler::markFirstFrame();
+    }
+}
+
+- (void)renderFramePipelined:(id)drawable renderPassDescriptor:(id)renderPassDescriptor {
+    if (!renderQueue_) {
+        renderQueue_ = dispatch_queue_create("oflike.render", DISPATCH_QUEUE_SERIAL);
+        encodeSlot_ = dispatch_semaphore_create(1);
+    }
+
+    // Record frame N+1 while the render thread may still be encoding frame N.
+    // No mapped storage here: the GPU ring belongs to the frame being encoded.
+    if (userApp_) {
+        OF_PROFILE_SCOPE("ofApp::draw");
+        userApp_->draw();
+    }
+
+    std::vector<render::DrawList*> drawLists;
+    Context::instance().collectDrawLists(drawLists);
+
+    // Bound latency to one frame: the other main list must be encoded (and
+    // reset) before the app may record into it
+    {
+        OF_PROFILE_SCOPE("waitForEncodeSlot");
+        dispatch_semaphore_wait(encodeSlot_, DISPATCH_TIME_FOREVER);
+    }
+    Context::instance().swapDrawLists();
+
+    // The view's drawable is only valid during this call; hand it over
+    auto* renderer = Context::instance().renderer();
+    auto* metalRenderer = dynamic_cast<render::metal::MetalRenderer*>(renderer);
+    dispatch_semaphore_t slot = encodeSlot_;
+    dispatch_async(renderQueue_, ^{
+        @autoreleasepool {
+            OF_PROFILE_SCOPE("renderFrame (render thread)");
+            if (metalRenderer) {
+                metalRenderer->setFrameTarget((__bridge void*)drawable,
+                                              (__bridge void*)renderPassDescriptor);
+            }
+
+            // beginFrame() blocks on GPU frame slots here, off the main thread
+            if (renderer->beginFrame()) {
+                if (encodeDrawLists(renderer, drawLists)) {
+                    if (renderer->endFrame()) {
+                        oflike::ofProfiler::markFirstFrame();
+                    } else {
+                        std::cerr << "[OFLBridge] endFrame() failed" << std::endl;
+                    }
+                } else {
+                    renderer->endFrame();
+                }
+            } else {
+                std::cerr << "[OFLBridge] beginFrame() failed" << std::endl;
+                for (render::DrawList* list : drawLists) {
+                    list->reset();
+                }
+            }
+            dispatch_semaphore_signal(slot);
+        }
+    });
+}
+
+- (void)waitForPipelinedFrame {
+    if (encodeSlot_) {
+        dispatch_semaphore_wait(encodeSlot_, DISPATCH_TIME_FOREVER);
+        dispatch_semaphore_signal(encodeSlot_);
     }
 }
 
@@ -183,18 +419,33 @@ extern "C" ofBaseApp* ofCreateApp(void);
 
         std::cout << "[OFLBridge] Exit called" << std::endl;
 
+        // Let an in-flight pipelined frame finish encoding before teardown
+        [self waitForPipelinedFrame];
+
         // Phase 2.1: Cleanup user app
         if (userApp_) {
             userApp_->exit();
+            oflike::ofWaitForJobs();
+
+            // Saves started in exit() finish, and report, while the app lives
+            oflike::ofWaitForAsyncIO();
             userApp_.reset();
         }
 
         // Phase 13.4: Clear EventDispatcher app reference
         EventDispatcher::instance().setApp(nullptr);
 
+        if (pacingStatsId_ >= 0) {
+            oflike::ofDebugStats::removeSource(pacingStatsId_);
+            pacingStatsId_ = -1;
+        }
+
         // Phase 2.1: Shutdown global context
         Context::instance().shutdown();
 
+        // With the app and the renderer gone, whatever is left was leaked
+        oflike::ofGpuMemory::logLeaks();
+
         isSetup_ = false;
     }
 }
@@ -222,28 +473,35 @@ extern "C" ofBaseApp* ofCreateApp(void);
 
 // MARK: - Mouse Events
 
-- (void)mouseMovedX:(float)x y:(float)y {
+- (void)mouseMovedX:(float)x y:(float)y timestamp:(double)timestamp {
     @autoreleasepool {
         if (!isSetup_) {
             return;
         }
 
-        // Phase 13.4: Dispatch through EventDispatcher
-        EventDispatcher::instance().dispatchMouseMoved((int)x, (int)y);
+        // Delivered at once, or queued for the frame when coalescing is on
+        EventDispatcher::instance().postMouseMoved(x, y, timestamp);
     }
 }
 
-- (void)mouseDraggedX:(float)x y:(float)y button:(int)button {
+- (void)mouseDraggedX:(float)x y:(float)y button:(int)button timestamp:(double)timestamp {
     @autoreleasepool {
         if (!isSetup_) {
             return;
         }
 
-        // Phase 13.4: Dispatch through EventDispatcher
-        EventDispatcher::instance().dispatchMouseDragged((int)x, (int)y, button);
+        EventDispatcher::instance().postMouseDragged(x, y, button, timestamp);
     }
 }
 
+- (void)mouseMovedX:(float)x y:(float)y {
+    [self mouseMovedX:x y:y timestamp:[NSProcessInfo processInfo].systemUptime];
+}
+
+- (void)mouseDraggedX:(float)x y:(float)y button:(int)button {
+    [self mouseDraggedX:x y:y button:button timestamp:[NSProcessInfo processInfo].systemUptime];
+}
+
 - (void)mousePressedX:(float)x y:(float)y button:(int)button {
     @autoreleasepool {
         if (!isSetup_) {
@@ -398,4 +656,120 @@ extern "C" ofBaseApp* ofCreateApp(void);
     }
 }
 
+- (NSArray<NSDictionary<NSString*, id>*>*)getGPUTimeline {
+    @autoreleasepool {
+        auto* renderer = Context::instance().renderer();
+        if (!renderer) {
+            return @[];
+        }
+
+        render::GPUPassTiming passes[32];
+        const size_t count = renderer->getGPUTimeline(passes, 32);
+        NSMutableArray<NSDictionary<NSString*, id>*>* timeline = [NSMutableArray arrayWithCapacity:count];
+        for (size_t i = 0; i < count; i++) {
+            [timeline addObject:@{
+                @"name": @(passes[i].name),
+                @"start": @(passes[i].startMs),
+                @"duration": @(passes[i].durationMs)
+            }];
+        }
+        return timeline;
+    }
+}
+
+- (NSArray<NSDictionary<NSString*, NSString*>*>*)getDebugStats {
+    @autoreleasepool {
+        std::vector<oflike::ofDebugStat> stats;
+        oflike::ofDebugStats::collect(stats);
+        NSMutableArray<NSDictionary<NSString*, NSString*>*>* rows = [NSMutableArray arrayWithCapacity:stats.size()];
+        for (const oflike::ofDebugStat& stat : stats) {
+            [rows addObject:@{
+                @"group": @(stat.group.c_str()),
+                @"name": @(stat.name.c_str()),
+                @"value": @(stat.value.c_str())
+            }];
+        }
+        return rows;
+    }
+}
+
+// MARK: - Scope Profiler
+
+- (int)getFramePacing {
+    switch (Context::instance().getFramePacing()) {
+        case Context::FramePacing::LowLatency: return 1;
+        case Context::FramePacing::Adaptive: return 2;
+        default: return 0;
+    }
+}
+
+- (float)getTargetFrameRate {
+    return Context::instance().getTargetFrameRate();
+}
+
+- (void)getFrameRateRangeMin:(float*)outMin max:(float*)outMax {
+    float minFps = 0.0f;
+    float maxFps = 0.0f;
+    Context::instance().getFrameRateRange(minFps, maxFps);
+    if (outMin) {
+        *outMin = minFps;
+    }
+    if (outMax) {
+        *outMax = maxFps;
+    }
+}
+
+- (void)setProfilerEnabled:(bool)enabled {
+    oflike::ofProfiler::setEnabled(enabled);
+}
+
+namespace {
+
+NSDictionary<NSString*, id>* profileFrameDictionary(const oflike::ofProfileFrame& frame) {
+    NSMutableArray<NSDictionary<NSString*, id>*>* rows = [NSMutableArray array];
+    for (const oflike::ofProfileThread& thread : frame.threads) {
+        for (const oflike::ofProfileNode& node : thread.nodes) {
+            [rows addObject:@{
+                @"thread": @(thread.name.c_str()),
+                @"name": @(node.name.c_str()),
+                @"depth": @(node.depth),
+                @"ms": @(node.totalMs),
+                @"calls": @(node.calls)
+            }];
+        }
+    }
+    return @{
+        @"frame": @(frame.frameNumber),
+        @"duration": @(frame.durationMs),
+        @"rows": rows
+    };
+}
+
+} // namespace
+
+- (NSDictionary<NSString*, id>*)getProfile {
+    @autoreleasepool {
+        NSMutableDictionary<NSString*, id>* profile = [NSMutableDictionary dictionary];
+        profile[@"enabled"] = @(oflike::ofProfiler::isEnabled());
+        profile[@"dropped"] = @(oflike::ofProfiler::getDroppedCount());
+
+        oflike::ofProfileFrame frame;
+        if (oflike::ofProfiler::getLastFrame(frame)) {
+            profile[@"last"] = profileFrameDictionary(frame);
+        }
+        if (oflike::ofProfiler::getWorstFrame(frame)) {
+            profile[@"worst"] = profileFrameDictionary(frame);
+        }
+
+        std::vector<double> durations;
+        oflike::ofProfiler::getFrameDurations(durations);
+        NSMutableArray<NSNumber*>* history = [NSMutableArray arrayWithCapacity:durations.size()];
+        for (double duration : durations) {
+            [history addObject:@(duration)];
+        }
+        profile[@"durations"] = history;
+        return profile;
+    }
+}
+
 @end
@@ -4,3 +4,4 @@
 //
 
 #import "SwiftBridge.h"
+#import "../../../addons/core/ofxGui/ofxGuiParameterBlock.h"
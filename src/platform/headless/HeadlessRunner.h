@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include "../../core/AppBase.h"
+#include "../../oflike/image/ofPixels.h"
+
+/// Runs an ofBaseApp without a window
+/// Headless counterpart of the SwiftUI bridge for render farms, batch
+/// rendering and benchmarks: frames render into the context's offscreen
+/// texture (Context::initializeHeadless()) as fast as the GPU allows, and
+/// time advances by a fixed step per frame, so every run of the same app
+/// produces the same frames.
+///
+/// Each frame runs the bridge's sequence: update() with async I/O
+/// completions, jobs and deferred parameter notifications, then draw()
+/// straight into the frame's GPU storage. There are no input events.
+///
+/// Example:
+///     HeadlessRunner runner(std::make_unique<MyApp>());
+///     if (runner.setup()) {
+///         oflike::ofPixels pixels;
+///         for (int i = 0; i < 300; i++) {
+///             runner.renderFrame(&pixels);
+///             oflike::ofSaveImageAsync(pixels, "frame_" + std::to_string(i) + ".png");
+///         }
+///     }
+///     runner.exit();
+class HeadlessRunner {
+public:
+    struct Settings {
+        int width = 1920;                       ///< Offscreen target size (also the window size)
+        int height = 1080;
+        double frameDuration = 1.0 / 60.0;      ///< Clock step per frame; 0 keeps the wall clock
+    };
+
+    explicit HeadlessRunner(std::unique_ptr<ofBaseApp> app);
+    HeadlessRunner(std::unique_ptr<ofBaseApp> app, const Settings& settings);
+    ~HeadlessRunner();
+
+    HeadlessRunner(const HeadlessRunner&) = delete;
+    HeadlessRunner& operator=(const HeadlessRunner&) = delete;
+
+    /// Create the headless context on the default Metal device and set up the app
+    /// @return false without a Metal device or if the context couldn't be created
+    bool setup();
+
+    /// Update, draw and render one frame
+    /// @param capture If given, waits for the GPU and receives the frame (RGBA)
+    /// @return false if the frame couldn't be rendered or read back
+    bool renderFrame(oflike::ofPixels* capture = nullptr);
+
+    /// Render frames back to back, then wait for the GPU
+    /// @param frames Number of frames
+    /// @return false if any frame failed
+    bool run(uint64_t frames);
+
+    /// Wait for the GPU, exit the app and shut the context down
+    /// Also called by the destructor.
+    void exit();
+
+    /// Check whether setup() succeeded and exit() hasn't been called
+    bool isRunning() const { return running_; }
+
+private:
+    std::unique_ptr<ofBaseApp> app_;
+    Settings settings_;
+    bool running_ = false;
+};
@@ -0,0 +1,175 @@
+#import <Metal/Metal.h>
+#include "HeadlessRunner.h"
+#include <climits>
+#include <future>
+#include <iostream>
+#include <vector>
+#include "../../core/Context.h"
+#include "../../core/EventDispatcher.h"
+#include "../../render/DrawList.h"
+#include "../../render/IRenderer.h"
+#include "../../oflike/image/TextureReadback.h"
+#include "../../oflike/utils/ofAsyncIO.h"
+#include "../../oflike/utils/ofFlightRecorder.h"
+#include "../../oflike/utils/ofFrameCapture.h"
+#include "../../oflike/utils/ofGpuMemory.h"
+#include "../../oflike/utils/ofJobSystem.h"
+#include "../../oflike/utils/ofProfiler.h"
+#include "../../oflike/utils/ofTelemetry.h"
+#include "../../oflike/types/ofParameter.h"
+
+HeadlessRunner::HeadlessRunner(std::unique_ptr<ofBaseApp> app)
+    : HeadlessRunner(std::move(app), Settings()) {}
+
+HeadlessRunner::HeadlessRunner(std::unique_ptr<ofBaseApp> app, const Settings& settings)
+    : app_(std::move(app))
+    , settings_(settings) {}
+
+HeadlessRunner::~HeadlessRunner() {
+    exit();
+}
+
+bool HeadlessRunner::setup() {
+    @autoreleasepool {
+        if (running_ || !app_) {
+            return running_;
+        }
+
+        id<MTLDevice> device = MTLCreateSystemDefaultDevice();
+        if (!device) {
+            std::cerr << "[HeadlessRunner] No Metal device available" << std::endl;
+            return false;
+        }
+
+        Context& context = Context::instance();
+        context.setManualClock(settings_.frameDuration > 0.0);
+        if (!context.initializeHeadless((__bridge void*)device, settings_.width, settings_.height)) {
+            std::cerr << "[HeadlessRunner] Headless context initialization failed" << std::endl;
+            context.shutdown();
+            return false;
+        }
+
+        EventDispatcher::instance().setApp(app_.get());
+        {
+            OF_STARTUP_SCOPE("ofApp::setup");
+            app_->setup();
+        }
+        running_ = true;
+        return true;
+    }
+}
+
+bool HeadlessRunner::renderFrame(oflike::ofPixels* capture) {
+    @autoreleasepool {
+        if (!running_) {
+            return false;
+        }
+        Context& context = Context::instance();
+        render::IRenderer* renderer = context.renderer();
+
+        // Same update sequence as the bridge; time steps once per frame
+        oflike::ofProfiler::endFrame();
+        oflike::ofTelemetry::endFrame();
+        oflike::ofFlightRecorder::endFrame();
+        {
+            OF_PROFILE_SCOPE("update");
+            context.advanceClock(settings_.frameDuration);
+            context.incrementFrame();
+            oflike::ofDispatchAsyncIOCompletions();
+            {
+                OF_PROFILE_SCOPE("ofApp::update");
+                app_->update();
+            }
+            oflike::ofWaitForJobs();
+            ofFlushParameterNotifications();
+        }
+
+        OF_PROFILE_SCOPE("renderFrame");
+        if (!context.beginHeadlessFrame()) {
+            std::cerr << "[HeadlessRunner] beginFrame() failed" << std::endl;
+            return false;
+        }
+        render::DrawList& drawList = context.getDrawList();
+        renderer->bindFrameStorage(drawList);
+        {
+            OF_PROFILE_SCOPE("ofApp::draw");
+            app_->draw();
+        }
+
+        // Recorded last, after any worker lists, so it sees the whole frame
+        render::DrawList captureList;
+        std::future<oflike::ofPixels> pixels;
+        if (capture) {
+            Context::ScopedDrawList scoped(captureList);
+            pixels = oflike::readTextureAsync(context.getHeadlessTexture(), context.getWindowWidth(),
+                                              context.getWindowHeight(), 4);
+            context.submitDrawList(&captureList, INT32_MAX);
+        }
+
+        std::vector<render::DrawList*> drawLists;
+        context.collectDrawLists(drawLists);
+        bool executed;
+        {
+            OF_PROFILE_SCOPE("encodeDrawLists");
+            for (render::DrawList* list : drawLists) {
+                list->optimize();
+            }
+            oflike::ofCaptureFrameDrawLists(drawLists.data(), drawLists.size());
+            executed = renderer->executeDrawLists(drawLists.data(), drawLists.size());
+            for (render::DrawList* list : drawLists) {
+                list->reset();
+            }
+        }
+        if (!executed) {
+            std::cerr << "[HeadlessRunner] executeDrawLists() failed" << std::endl;
+        }
+        const bool ended = renderer->endFrame();
+        if (ended) {
+            oflike::ofProfiler::markFirstFrame();
+        } else {
+            std::cerr << "[HeadlessRunner] endFrame() failed" << std::endl;
+        }
+
+        if (capture) {
+            if (!pixels.valid()) {
+                return false;
+            }
+            *capture = pixels.get();    // Resolves once the GPU has finished the frame
+            if (!capture->isAllocated()) {
+                return false;
+            }
+        }
+        return executed && ended;
+    }
+}
+
+bool HeadlessRunner::run(uint64_t frames) {
+    bool ok = true;
+    for (uint64_t i = 0; i < frames && running_; ++i) {
+        ok = renderFrame() && ok;
+    }
+    Context::instance().waitForHeadlessFrames();
+    return ok && running_;
+}
+
+void HeadlessRunner::exit() {
+    @autoreleasepool {
+        if (!running_) {
+            return;
+        }
+        Context& context = Context::instance();
+        context.waitForHeadlessFrames();
+
+        app_->exit();
+        oflike::ofWaitForJobs();
+        oflike::ofWaitForAsyncIO();
+        app_.reset();
+
+        EventDispatcher::instance().setApp(nullptr);
+        context.shutdown();
+        context.setManualClock(false);
+
+        oflike::ofGpuMemory::logLeaks();
+        running_ = false;
+    }
+}
@@ -132,6 +132,66 @@ class DebugParameterStore: ObservableObject {
     }
 }
 
+// MARK: - Scope Profiler Store
+
+/// One node of a frame's scope tree (ofProfiler), depth-first per thread
+struct ProfileRow: Identifiable {
+    let id: Int          // Depth-first order
+    let thread: String
+    let name: String
+    let depth: Int
+    let ms: Double       // Total over the frame's calls
+    let calls: Int
+}
+
+/// A frame recorded by ofProfiler
+struct ProfileFrame {
+    let number: UInt64
+    let duration: Double // milliseconds, update to update
+    let rows: [ProfileRow]
+}
+
+/// In-app OF_PROFILE_SCOPE timings, refreshed from the bridge while enabled
+class ProfilerStore: ObservableObject {
+    static let shared = ProfilerStore()
+
+    /// Requested recording state; MetalView passes it to the bridge
+    @Published var isEnabled = false
+    @Published var last: ProfileFrame?
+    @Published var worst: ProfileFrame?
+    @Published var durations: [Double] = []   // Oldest first
+    @Published var dropped: UInt64 = 0
+
+    private init() {}
+
+    /// Update from OFLBridge.getProfile()
+    func update(_ profile: [String: Any]) {
+        last = ProfilerStore.frame(profile["last"])
+        worst = ProfilerStore.frame(profile["worst"])
+        durations = (profile["durations"] as? [NSNumber])?.map { $0.doubleValue } ?? []
+        dropped = (profile["dropped"] as? NSNumber)?.uint64Value ?? 0
+    }
+
+    private static func frame(_ value: Any?) -> ProfileFrame? {
+        guard let entry = value as? [String: Any] else { return nil }
+        let rows = (entry["rows"] as? [[String: Any]] ?? []).enumerated().map { index, row in
+            ProfileRow(
+                id: index,
+                thread: row["thread"] as? String ?? "",
+                name: row["name"] as? String ?? "",
+                depth: (row["depth"] as? NSNumber)?.intValue ?? 0,
+                ms: (row["ms"] as? NSNumber)?.doubleValue ?? 0.0,
+                calls: (row["calls"] as? NSNumber)?.intValue ?? 0
+            )
+        }
+        return ProfileFrame(
+            number: (entry["frame"] as? NSNumber)?.uint64Value ?? 0,
+            duration: (entry["duration"] as? NSNumber)?.doubleValue ?? 0.0,
+            rows: rows
+        )
+    }
+}
+
 // MARK: - Debug Overlay View
 
 /// SwiftUI Debug Overlay for runtime parameter adjustment
@@ -231,6 +291,10 @@ struct DebugOverlay: View {
                     .padding(12)
                 }
                 .frame(maxHeight: 400)
+
+                Divider()
+
+                ProfilerSection()
             }
         }
         .frame(minWidth: 280, maxWidth: 320)
@@ -361,6 +425,107 @@ private struct ColorParameterView: View {
     }
 }
 
+// MARK: - Profiler View
+
+/// Scope profile of the latest or the worst recent frame, with the
+/// durations of the recent frames (worst in red)
+private struct ProfilerSection: View {
+    @ObservedObject var store = ProfilerStore.shared
+    @State private var showWorst = false
+
+    var body: some View {
+        VStack(alignment: .leading, spacing: 8) {
+            Toggle("Scope Profiler", isOn: $store.isEnabled)
+                .font(.system(size: 12, weight: .medium))
+
+            if store.isEnabled {
+                Picker("", selection: $showWorst) {
+                    Text("Latest").tag(false)
+                    Text("Worst of \(store.durations.count)").tag(true)
+                }
+                .pickerStyle(.segmented)
+                .labelsHidden()
+
+                durationStrip
+
+                if let frame = showWorst ? store.worst : store.last {
+                    Text(String(format: "Frame %llu  %.2f ms", frame.number, frame.duration))
+                        .font(.system(size: 11, design: .monospaced))
+                        .foregroundColor(showWorst ? .red : .secondary)
+
+                    ScrollView {
+                        VStack(alignment: .leading, spacing: 2) {
+                            ForEach(frame.rows) { row in
+                                if row.depth == 0 && (row.id == 0 || frame.rows[row.id - 1].thread != row.thread) {
+                                    Text(row.thread)
+                                        .font(.system(size: 11, weight: .semibold))
+                                        .padding(.top, 4)
+                                }
+                                ProfileRowView(row: row)
+                            }
+                        }
+                    }
+                    .frame(maxHeight: 240)
+                } else {
+                    Text("Waiting for a frame")
+                        .font(.system(size: 12))
+                        .foregroundColor(.secondary)
+                }
+
+                if store.dropped > 0 {
+                    Text("\(store.dropped) scopes dropped")
+                        .font(.system(size: 11))
+                        .foregroundColor(.orange)
+                }
+            }
+        }
+        .padding(12)
+    }
+
+    // Bars of the recent frame durations, scaled to the worst one
+    private var durationStrip: some View {
+        let durations = store.durations
+        let worst = durations.max() ?? 0.0
+        let worstIndex = durations.firstIndex(of: worst)
+        return GeometryReader { geometry in
+            HStack(alignment: .bottom, spacing: 0) {
+                ForEach(durations.indices, id: \.self) { index in
+                    Rectangle()
+                        .fill(index == worstIndex ? Color.red : Color.blue.opacity(0.6))
+                        .frame(
+                            width: geometry.size.width / CGFloat(max(durations.count, 1)),
+                            height: worst > 0 ? geometry.size.height * CGFloat(durations[index] / worst) : 0
+                        )
+                }
+            }
+            .frame(width: geometry.size.width, height: geometry.size.height, alignment: .bottomLeading)
+        }
+        .frame(height: 32)
+    }
+}
+
+/// One scope of the profile, indented by depth
+private struct ProfileRowView: View {
+    let row: ProfileRow
+
+    var body: some View {
+        HStack(spacing: 4) {
+            Text(row.name)
+                .font(.system(size: 11))
+                .lineLimit(1)
+                .padding(.leading, CGFloat(row.depth) * 10)
+            Spacer()
+            if row.calls > 1 {
+                Text("×\(row.calls)")
+                    .font(.system(size: 11, design: .monospaced))
+                    .foregroundColor(.secondary)
+            }
+            Text(String(format: "%.2f ms", row.ms))
+                .font(.system(size: 11, design: .monospaced))
+        }
+    }
+}
+
 // MARK: - Preview
 
 #if DEBUG
@@ -121,7 +121,7 @@ private class MouseTrackingMTKView: MTKView {
         let location = convert(event.locationInWindow, from: nil)
         // Convert to oF convention: Y=0 at top, Y increases downward
         let ofY = bounds.size.height - location.y
-        mouseEventReceiver?.mouseMoved(x: Float(location.x), y: Float(ofY))
+        mouseEventReceiver?.mouseMoved(x: Float(location.x), y: Float(ofY), timestamp: event.timestamp)
     }
 
     override func mouseEntered(with event: NSEvent) {
@@ -146,7 +146,8 @@ private class MouseTrackingMTKView: MTKView {
         // NSEvent: 0=left, 1=right, 2=middle
         // oF uses same convention: 0=left, 1=right, 2=middle
         let button = Int(event.buttonNumber)
-        mouseEventReceiver?.mouseDragged(x: Float(location.x), y: Float(ofY), button: button)
+        mouseEventReceiver?.mouseDragged(x: Float(location.x), y: Float(ofY), button: button,
+                                         timestamp: event.timestamp)
     }
 
     override func mouseDown(with event: NSEvent) {
@@ -249,8 +250,8 @@ private class MouseTrackingMTKView: MTKView {
 
 /// Protocol for receiving mouse and keyboard events from MouseTrackingMTKView
 protocol MouseEventReceiver: AnyObject {
-    func mouseMoved(x: Float, y: Float)
-    func mouseDragged(x: Float, y: Float, button: Int)
+    func mouseMoved(x: Float, y: Float, timestamp: TimeInterval)
+    func mouseDragged(x: Float, y: Float, button: Int, timestamp: TimeInterval)
     func mousePressed(x: Float, y: Float, button: Int)
     func mouseReleased(x: Float, y: Float, button: Int)
     func mouseScrolled(x: Float, y: Float, scrollX: Float, scrollY: Float)
@@ -276,6 +277,16 @@ class MetalViewCoordinator: NSObject, MTKViewDelegate, ObservableObject, MouseEv
     private var lastFPSUpdate: CFTimeInterval = 0
     private var framesSinceLastUpdate: Int = 0
 
+    // Debug overlay rows published through ofDebugStats
+    private var lastDebugStatsUpdate: CFTimeInterval = 0
+    private let debugStatsInterval: CFTimeInterval = 0.5
+    private var profilerEnabled = false
+
+    // Frame pacing (ofSetFramePacing) last applied to the view
+    private weak var metalView: MTKView?
+    private var pacingConfig: FramePacingConfig?
+    private var displayLinkDriver: AnyObject?    // DisplayLinkDriver, macOS 14+
+
     // Phase 14.1: Window state
     @Published var windowTitle: String = "oflike-metal"
     @Published var isFullscreen: Bool = false
@@ -295,6 +306,7 @@ class MetalViewCoordinator: NSObject, MTKViewDelegate, ObservableObject, MouseEv
     func setup(device: MTLDevice, view: MTKView) {
         // Phase 5.2: Create command queue for renderFrame
         self.commandQueue = device.makeCommandQueue()
+        self.metalView = view
 
         // Phase 3: Initialize global context with Metal device
         bridge?.initializeContext(withDevice: device)
@@ -328,6 +340,11 @@ class MetalViewCoordinator: NSObject, MTKViewDelegate, ObservableObject, MouseEv
         // Render frame
         render(view: view)
 
+        frameFinished(view: view)
+    }
+
+    /// Per-frame bookkeeping shared by the view's and the display link's frames
+    private func frameFinished(view: MTKView) {
         // Phase 1.5: Update frame count and FPS
         frameCount += 1
         framesSinceLastUpdate += 1
@@ -344,6 +361,9 @@ class MetalViewCoordinator: NSObject, MTKViewDelegate, ObservableObject, MouseEv
 
         // Phase 16.2: Update performance statistics
         updatePerformanceStats()
+
+        // Settings changed in setup() or update() take effect from the next frame
+        updateFramePacing(view: view)
     }
 
     // MARK: - Frame Loop
@@ -373,6 +393,68 @@ class MetalViewCoordinator: NSObject, MTKViewDelegate, ObservableObject, MouseEv
         }
     }
 
+    // MARK: - Frame Pacing
+
+    /// Follow ofSetFramePacing(), ofSetFrameRate() and ofSetFrameRateRange():
+    /// the view's refresh rate, or a CAMetalDisplayLink with a frame rate
+    /// range for the adaptive mode where available
+    private func updateFramePacing(view: MTKView) {
+        guard let bridge = bridge else { return }
+        var minFps: Float = 0
+        var maxFps: Float = 0
+        bridge.getFrameRateRangeMin(&minFps, max: &maxFps)
+        let config = FramePacingConfig(
+            mode: bridge.getFramePacing(),
+            targetFps: bridge.getTargetFrameRate(),
+            minFps: minFps,
+            maxFps: maxFps
+        )
+        guard config != pacingConfig else { return }
+        pacingConfig = config
+
+        if #available(macOS 14.0, *) {
+            (displayLinkDriver as? DisplayLinkDriver)?.stop()
+        }
+        displayLinkDriver = nil
+        view.isPaused = false
+
+        guard config.mode == FramePacingConfig.adaptive else {
+            view.preferredFramesPerSecond = max(Int(config.targetFps.rounded()), 1)
+            return
+        }
+
+        // Before macOS 14 the view runs at the top of the range
+        view.preferredFramesPerSecond = max(Int(config.maxFps.rounded()), 1)
+        if #available(macOS 14.0, *),
+           let layer = view.layer as? CAMetalLayer,
+           let device = view.device {
+            let range = CAFrameRateRange(minimum: config.minFps, maximum: config.maxFps,
+                                         preferred: config.maxFps)
+            let driver = DisplayLinkDriver(layer: layer, device: device,
+                                           depthFormat: view.depthStencilPixelFormat,
+                                           clearColor: view.clearColor,
+                                           frameRateRange: range) { [weak self] drawable, renderPass in
+                self?.displayLinkFrame(drawable: drawable, renderPassDescriptor: renderPass)
+            }
+            // The display link drives the frames now
+            view.isPaused = true
+            driver.start()
+            displayLinkDriver = driver
+        }
+    }
+
+    /// One frame on the display link's drawable
+    private func displayLinkFrame(drawable: CAMetalDrawable, renderPassDescriptor: MTLRenderPassDescriptor) {
+        guard let view = metalView, let commandQueue = commandQueue else { return }
+        update()
+        autoreleasepool {
+            bridge?.renderFrame(drawable,
+                               renderPassDescriptor: renderPassDescriptor,
+                               commandQueue: commandQueue)
+        }
+        frameFinished(view: view)
+    }
+
     // MARK: - Public API
 
     func getFrameCount() -> UInt64 {
@@ -385,14 +467,14 @@ class MetalViewCoordinator: NSObject, MTKViewDelegate, ObservableObject, MouseEv
 
     // MARK: - MouseEventReceiver (Phase 13.1)
 
-    func mouseMoved(x: Float, y: Float) {
+    func mouseMoved(x: Float, y: Float, timestamp: TimeInterval) {
         // Forward to C++ bridge
-        bridge?.mouseMovedX(x, y: y)
+        bridge?.mouseMovedX(x, y: y, timestamp: timestamp)
     }
 
-    func mouseDragged(x: Float, y: Float, button: Int) {
+    func mouseDragged(x: Float, y: Float, button: Int, timestamp: TimeInterval) {
         // Forward to C++ bridge
-        bridge?.mouseDraggedX(x, y: y, button: Int32(button))
+        bridge?.mouseDraggedX(x, y: y, button: Int32(button), timestamp: timestamp)
     }
 
     func mousePressed(x: Float, y: Float, button: Int) {
@@ -500,12 +582,124 @@ class MetalViewCoordinator: NSObject, MTKViewDelegate, ObservableObject, MouseEv
 
             bridge?.getPerformanceStats(&drawCalls, vertices: &vertices, gpuTime: &gpuTime)
 
+            let timeline = bridge?.getGPUTimeline() ?? []
+            let passes = timeline.enumerated().map { index, entry in
+                GPUPassTiming(
+                    id: index,
+                    name: entry["name"] as? String ?? "Pass",
+                    start: (entry["start"] as? NSNumber)?.doubleValue ?? 0.0,
+                    duration: (entry["duration"] as? NSNumber)?.doubleValue ?? 0.0
+                )
+            }
+
             // Phase 11.2: Update global PerformanceStats
             PerformanceStats.shared.updateFrame(
                 drawCalls: drawCalls,
                 vertices: vertices,
-                gpuTime: gpuTime
+                gpuTime: gpuTime,
+                gpuPasses: passes
             )
+
+            // Published rows are formatted strings: refreshed a few times a second
+            let now = CACurrentMediaTime()
+            if now - lastDebugStatsUpdate >= debugStatsInterval {
+                lastDebugStatsUpdate = now
+                let rows = (bridge?.getDebugStats() ?? []).enumerated().map { index, entry in
+                    DebugStatRow(
+                        id: index,
+                        group: entry["group"] ?? "",
+                        name: entry["name"] ?? "",
+                        value: entry["value"] ?? ""
+                    )
+                }
+                PerformanceStats.shared.updateDebugStats(rows)
+
+                // Scope profile (DebugOverlay): recorded only while the toggle is on
+                let profiler = ProfilerStore.shared
+                if profiler.isEnabled != profilerEnabled {
+                    profilerEnabled = profiler.isEnabled
+                    bridge?.setProfilerEnabled(profilerEnabled)
+                }
+                if profilerEnabled, let profile = bridge?.getProfile() {
+                    profiler.update(profile)
+                }
+            }
         }
     }
 }
+
+// MARK: - Frame Pacing
+
+/// Pacing settings read from the C++ context
+private struct FramePacingConfig: Equatable {
+    static let adaptive: Int32 = 2     // OFLBridge getFramePacing()
+
+    var mode: Int32
+    var targetFps: Float
+    var minFps: Float
+    var maxFps: Float
+}
+
+/// Drives frames from a CAMetalDisplayLink so ProMotion displays can vary
+/// their refresh rate within a range; the MTKView is paused meanwhile
+@available(macOS 14.0, *)
+private final class DisplayLinkDriver: NSObject, CAMetalDisplayLinkDelegate {
+    typealias FrameHandler = (CAMetalDrawable, MTLRenderPassDescriptor) -> Void
+
+    private let displayLink: CAMetalDisplayLink
+    private let device: MTLDevice
+    private let depthFormat: MTLPixelFormat
+    private let clearColor: MTLClearColor
+    private let onFrame: FrameHandler
+    private var depthTexture: MTLTexture?
+
+    init(layer: CAMetalLayer, device: MTLDevice, depthFormat: MTLPixelFormat,
+         clearColor: MTLClearColor, frameRateRange: CAFrameRateRange,
+         onFrame: @escaping FrameHandler) {
+        self.displayLink = CAMetalDisplayLink(metalLayer: layer)
+        self.device = device
+        self.depthFormat = depthFormat
+        self.clearColor = clearColor
+        self.onFrame = onFrame
+        super.init()
+        displayLink.preferredFrameRateRange = frameRateRange
+        displayLink.delegate = self
+    }
+
+    func start() {
+        displayLink.add(to: .main, forMode: .common)
+    }
+
+    func stop() {
+        displayLink.invalidate()
+    }
+
+    func metalDisplayLink(_ link: CAMetalDisplayLink, needsUpdate update: CAMetalDisplayLink.Update) {
+        let drawable = update.drawable
+        let texture = drawable.texture
+
+        // Same attachments as the view's own render pass descriptor
+        let renderPass = MTLRenderPassDescriptor()
+        renderPass.colorAttachments[0].texture = texture
+        renderPass.colorAttachments[0].loadAction = .clear
+        renderPass.colorAttachments[0].clearColor = clearColor
+        renderPass.colorAttachments[0].storeAction = .store
+
+        if depthFormat != .invalid {
+            if depthTexture?.width != texture.width || depthTexture?.height != texture.height {
+                let descriptor = MTLTextureDescriptor.texture2DDescriptor(
+                    pixelFormat: depthFormat, width: texture.width, height: texture.height,
+                    mipmapped: false)
+                descriptor.usage = .renderTarget
+                descriptor.storageMode = .private
+                depthTexture = device.makeTexture(descriptor: descriptor)
+            }
+            renderPass.depthAttachment.texture = depthTexture
+            renderPass.depthAttachment.loadAction = .clear
+            renderPass.depthAttachment.clearDepth = 1.0
+            renderPass.depthAttachment.storeAction = .dontCare
+        }
+
+        onFrame(drawable, renderPass)
+    }
+}
@@ -1,6 +1,26 @@
 import SwiftUI
 import QuartzCore
 
+// MARK: - GPU Timeline
+
+/// GPU timing of one pass in the last completed frame
+struct GPUPassTiming: Identifiable {
+    let id: Int          // Submission order
+    let name: String
+    let start: Double    // milliseconds from the frame's first pass
+    let duration: Double // milliseconds
+}
+
+// MARK: - Debug Stats
+
+/// A row published by C++ through ofDebugStats (e.g. network counters)
+struct DebugStatRow: Identifiable {
+    let id: Int          // Order of publication
+    let group: String
+    let name: String
+    let value: String
+}
+
 // MARK: - Performance Statistics
 
 /// Performance statistics for monitoring rendering performance
@@ -12,6 +32,8 @@ class PerformanceStats: ObservableObject {
     @Published var drawCalls: UInt32 = 0
     @Published var vertexCount: UInt32 = 0
     @Published var gpuTime: Double = 0.0    // milliseconds
+    @Published var gpuPasses: [GPUPassTiming] = []
+    @Published var debugStats: [DebugStatRow] = []
 
     private var lastUpdateTime: CFTimeInterval = 0
     private var frameCount: Int = 0
@@ -22,8 +44,12 @@ class PerformanceStats: ObservableObject {
         lastUpdateTime = CACurrentMediaTime()
     }
 
+    /// Frame budget for 60 FPS (milliseconds)
+    static let frameBudget: Double = 1000.0 / 60.0
+
     /// Update frame statistics (called every frame)
-    func updateFrame(drawCalls: UInt32, vertices: UInt32, gpuTime: Double) {
+    func updateFrame(drawCalls: UInt32, vertices: UInt32, gpuTime: Double,
+                     gpuPasses: [GPUPassTiming] = []) {
         let currentTime = CACurrentMediaTime()
         let deltaTime = currentTime - lastUpdateTime
 
@@ -48,6 +74,21 @@ class PerformanceStats: ObservableObject {
         self.drawCalls = drawCalls
         self.vertexCount = vertices
         self.gpuTime = gpuTime
+        self.gpuPasses = gpuPasses
+    }
+
+    /// Update the rows published through ofDebugStats
+    func updateDebugStats(_ rows: [DebugStatRow]) {
+        self.debugStats = rows
+    }
+
+    /// Groups of debugStats, in order of publication
+    var debugStatGroups: [String] {
+        var groups: [String] = []
+        for row in debugStats where !groups.contains(row.group) {
+            groups.append(row.group)
+        }
+        return groups
     }
 
     /// Reset all statistics
@@ -57,6 +98,8 @@ class PerformanceStats: ObservableObject {
         drawCalls = 0
         vertexCount = 0
         gpuTime = 0.0
+        gpuPasses = []
+        debugStats = []
         frameCount = 0
         fpsAccumulator = 0.0
         lastUpdateTime = CACurrentMediaTime()
@@ -153,6 +196,43 @@ struct PerformanceMonitor: View {
                             .font(.system(size: 12, design: .monospaced))
                             .foregroundColor(.secondary)
                     }
+
+                    // Per-pass GPU timeline
+                    ForEach(stats.gpuPasses) { pass in
+                        HStack {
+                            Text(pass.name)
+                                .font(.system(size: 11))
+                                .lineLimit(1)
+                            Spacer()
+                            Text(String(format: "%.2f ms", pass.duration))
+                                .font(.system(size: 11, design: .monospaced))
+                                .foregroundColor(passColor(pass))
+                        }
+                        .padding(.leading, 8)
+                    }
+
+                    // Rows published by C++ (network counters and the like)
+                    ForEach(stats.debugStatGroups, id: \.self) { group in
+                        Divider()
+                            .padding(.vertical, 4)
+
+                        Text(group)
+                            .font(.system(size: 12, weight: .medium))
+
+                        ForEach(stats.debugStats.filter { $0.group == group }) { row in
+                            HStack {
+                                Text(row.name)
+                                    .font(.system(size: 11))
+                                    .lineLimit(1)
+                                Spacer()
+                                Text(row.value)
+                                    .font(.system(size: 11, design: .monospaced))
+                                    .foregroundColor(.secondary)
+                                    .lineLimit(1)
+                            }
+                            .padding(.leading, 8)
+                        }
+                    }
                 }
                 .padding(12)
             }
@@ -188,6 +268,17 @@ struct PerformanceMonitor: View {
         }
     }
 
+    // Color coding for GPU passes: red once a pass ends past the frame budget
+    private func passColor(_ pass: GPUPassTiming) -> Color {
+        if pass.start + pass.duration > PerformanceStats.frameBudget {
+            return .red
+        } else if pass.duration > PerformanceStats.frameBudget * 0.5 {
+            return .orange
+        } else {
+            return .secondary
+        }
+    }
+
     // Color coding for draw calls
     private var drawCallsColor: Color {
         if stats.drawCalls < 300 {
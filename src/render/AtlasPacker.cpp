@@ -0,0 +1,121 @@
+#include "AtlasPacker.h"
+#include <limits>
+
+namespace render {
+
+// ============================================================================
+// SkylinePacker Implementation
+// ============================================================================
+
+SkylinePacker::SkylinePacker(uint32_t width, uint32_t height) {
+    reset(width, height);
+}
+
+void SkylinePacker::reset(uint32_t width, uint32_t height) {
+    width_ = width;
+    height_ = height;
+    usedArea_ = 0;
+    skyline_.clear();
+    if (width > 0) {
+        skyline_.push_back({0, 0, width});
+    }
+}
+
+bool SkylinePacker::fit(size_t index, uint32_t width, uint32_t height, uint32_t& y) const {
+    const uint32_t x = skyline_[index].x;
+    if (x + width > width_) {
+        return false;
+    }
+
+    // The rectangle rests on the highest segment it spans
+    int64_t remaining = width;
+    y = 0;
+    for (size_t i = index; remaining > 0; i++) {
+        if (i >= skyline_.size()) {
+            return false;
+        }
+        if (skyline_[i].y > y) {
+            y = skyline_[i].y;
+        }
+        if (y + height > height_) {
+            return false;
+        }
+        remaining -= skyline_[i].width;
+    }
+    return true;
+}
+
+bool SkylinePacker::insert(uint32_t width, uint32_t height, AtlasRect& out) {
+    if (width == 0 || height == 0 || width > width_ || height > height_) {
+        return false;
+    }
+
+    size_t bestIndex = skyline_.size();
+    uint32_t bestTop = std::numeric_limits<uint32_t>::max();
+    uint32_t bestWidth = std::numeric_limits<uint32_t>::max();
+    uint32_t bestY = 0;
+
+    for (size_t i = 0; i < skyline_.size(); i++) {
+        uint32_t y = 0;
+        if (!fit(i, width, height, y)) {
+            continue;
+        }
+        const uint32_t top = y + height;
+        if (top < bestTop || (top == bestTop && skyline_[i].width < bestWidth)) {
+            bestIndex = i;
+            bestTop = top;
+            bestWidth = skyline_[i].width;
+            bestY = y;
+        }
+    }
+
+    if (bestIndex == skyline_.size()) {
+        return false;
+    }
+
+    out.x = skyline_[bestIndex].x;
+    out.y = bestY;
+    out.width = width;
+    out.height = height;
+
+    // Raise the skyline under the new rectangle and trim the segments it covers
+    skyline_.insert(skyline_.begin() + bestIndex, Segment{out.x, bestY + height, width});
+    for (size_t i = bestIndex + 1; i < skyline_.size();) {
+        const Segment& prev = skyline_[i - 1];
+        const uint32_t prevEnd = prev.x + prev.width;
+        Segment& seg = skyline_[i];
+        if (seg.x >= prevEnd) {
+            break;
+        }
+        const uint32_t overlap = prevEnd - seg.x;
+        if (seg.width <= overlap) {
+            skyline_.erase(skyline_.begin() + i);
+            continue;
+        }
+        seg.x += overlap;
+        seg.width -= overlap;
+        break;
+    }
+    merge();
+
+    usedArea_ += static_cast<uint64_t>(width) * height;
+    return true;
+}
+
+void SkylinePacker::merge() {
+    for (size_t i = 0; i + 1 < skyline_.size();) {
+        if (skyline_[i].y == skyline_[i + 1].y) {
+            skyline_[i].width += skyline_[i + 1].width;
+            skyline_.erase(skyline_.begin() + i + 1);
+        } else {
+            i++;
+        }
+    }
+}
+
+float SkylinePacker::getOccupancy() const {
+    const uint64_t area = static_cast<uint64_t>(width_) * height_;
+    return area > 0 ? static_cast<float>(usedArea_) / static_cast<float>(area) : 0.0f;
+}
+
+} // namespace render
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace render {
+
+// ============================================================================
+// AtlasRect - Packed rectangle in atlas pixel space
+// ============================================================================
+
+struct AtlasRect {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+// ============================================================================
+// SkylinePacker - Online rectangle packing for texture atlases
+// ============================================================================
+
+/**
+ * SkylinePacker places rectangles into a fixed-size page using the
+ * skyline bottom-left heuristic.
+ *
+ * The packed area is tracked as a list of horizontal segments (the
+ * "skyline"). Each insert picks the position whose top edge ends lowest,
+ * breaking ties on the narrower segment, so rows of mixed heights fill
+ * in without the wasted space of plain shelf packing. Inserts are O(n)
+ * in the number of skyline segments and never move earlier rectangles,
+ * so packed texcoords stay valid for the lifetime of the page.
+ *
+ * Padding between rectangles is the caller's responsibility; pack
+ * (w + padding, h + padding) and use the top-left w x h.
+ *
+ * Usage:
+ *   SkylinePacker packer(1024, 1024);
+ *   AtlasRect rect;
+ *   if (packer.insert(64, 32, rect)) {
+ *       // upload pixels to (rect.x, rect.y)
+ *   }
+ */
+class SkylinePacker {
+public:
+    SkylinePacker() = default;
+    SkylinePacker(uint32_t width, uint32_t height);
+
+    /**
+     * Empty the page and set its size.
+     */
+    void reset(uint32_t width, uint32_t height);
+
+    /**
+     * Pack a rectangle.
+     * @param width Rectangle width in pixels
+     * @param height Rectangle height in pixels
+     * @param out Receives the packed position on success
+     * @return false when the rectangle does not fit in the remaining space
+     */
+    bool insert(uint32_t width, uint32_t height, AtlasRect& out);
+
+    uint32_t getWidth() const { return width_; }
+    uint32_t getHeight() const { return height_; }
+
+    /** Sum of packed rectangle areas in pixels. */
+    uint64_t getUsedArea() const { return usedArea_; }
+
+    /** Fraction of the page covered by packed rectangles (0-1). */
+    float getOccupancy() const;
+
+private:
+    struct Segment {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+    };
+
+    // Lowest y at which a width x height rectangle fits starting at segment index
+    bool fit(size_t index, uint32_t width, uint32_t height, uint32_t& y) const;
+    void merge();
+
+    std::vector<Segment> skyline_;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    uint64_t usedArea_ = 0;
+};
+
+} // namespace render
@@ -0,0 +1,133 @@
+#pragma once
+
+// oflike-metal CopyTextureRegistry - pending GPU copies by id
+// Owners that copy frames on the GPU for CPU or background work (texture
+// readback, video recording, streaming, optical flow) record each copy here,
+// optionally with the queue that consumes it. The command's completion, on
+// a Metal thread, looks the copy up by id and finishes it; copies whose frame
+// was never rendered are failed instead. Objective-C++ only (dispatch blocks).
+
+#include "DrawCommand.h"
+#include <dispatch/dispatch.h>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace render {
+
+/// \brief Copies of one capture type recorded but not yet completed
+/// \tparam Capture What the owner needs to finish a copy; copied into the
+/// block that finishes it when there is a queue
+/// \tparam Finish Runs once per recorded copy; succeeded is false if the
+/// copy failed or was given up on
+/// \details Each instantiation is one process-wide registry. Thread-safe.
+template <typename Capture, void (*Finish)(const Capture& capture, bool succeeded)>
+class CopyTextureRegistry {
+public:
+    /// Frames after which a copy that never completed is given up on; far
+    /// beyond the frames in flight, so it can no longer be running
+    static constexpr unsigned long long kAbandonFrames = 240;
+
+    /// \brief Record a copy
+    /// \param queue Serial queue Finish runs on, or nullptr to run it on the
+    /// Metal completion thread (or, for a copy given up on, the recording one)
+    /// \param frame Frame the command is recorded in
+    /// \return Id to pass back to complete(), the command's completion
+    static uint64_t add(Capture capture, dispatch_queue_t queue, unsigned long long frame) {
+        CopyTextureRegistry& registry = instance();
+        std::vector<Entry> stale;
+        uint64_t id = 0;
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex_);
+            registry.takeStale(frame, stale);
+            id = registry.nextId_++;
+            registry.pending_.emplace(id, Entry{std::move(capture), queue, frame});
+        }
+        finishStale(stale);
+        return id;
+    }
+
+    /// \brief Record a copy and point cmd's completion at it
+    static void add(CopyTextureCommand& cmd, Capture capture, dispatch_queue_t queue, unsigned long long frame) {
+        cmd.completion = &complete;
+        cmd.copyId = add(std::move(capture), queue, frame);
+    }
+
+    /// \brief Fail copies recorded more than kAbandonFrames before frame
+    static void abandon(unsigned long long frame) {
+        CopyTextureRegistry& registry = instance();
+        std::vector<Entry> stale;
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex_);
+            registry.takeStale(frame, stale);
+        }
+        finishStale(stale);
+    }
+
+    /// \brief Command completion for the ids add() returns
+    static void complete(uint64_t copyId, bool succeeded) {
+        CopyTextureRegistry& registry = instance();
+        Entry entry;
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex_);
+            auto it = registry.pending_.find(copyId);
+            if (it == registry.pending_.end()) {
+                // Replayed again or already given up on
+                return;
+            }
+            entry = std::move(it->second);
+            registry.pending_.erase(it);
+        }
+        finish(entry, succeeded);
+    }
+
+private:
+    struct Entry {
+        Capture capture;
+        dispatch_queue_t queue = nullptr;
+        unsigned long long frame = 0;
+    };
+
+    static CopyTextureRegistry& instance() {
+        static CopyTextureRegistry registry;
+        return registry;
+    }
+
+    // Outside the lock: Finish may take milliseconds, or record new copies
+    static void finish(Entry& entry, bool succeeded) {
+        if (!entry.queue) {
+            Finish(entry.capture, succeeded);
+            return;
+        }
+        Capture capture = std::move(entry.capture);
+        dispatch_async(entry.queue, ^{
+            Finish(capture, succeeded);
+        });
+    }
+
+    static void finishStale(std::vector<Entry>& stale) {
+        for (Entry& entry : stale) {
+            finish(entry, false);
+        }
+    }
+
+    // Call with the lock held
+    void takeStale(unsigned long long frame, std::vector<Entry>& stale) {
+        for (auto it = pending_.begin(); it != pending_.end();) {
+            if (it->second.frame + kAbandonFrames < frame) {
+                stale.push_back(std::move(it->second));
+                it = pending_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    std::unordered_map<uint64_t, Entry> pending_;
+    uint64_t nextId_ = 1;
+};
+
+} // namespace render
@@ -4,76 +4,71 @@
 namespace render {
 
 // ============================================================================
-// DrawCommand Implementation
+// CommandStream Implementation
 // ============================================================================
 
-DrawCommand::DrawCommand(const DrawCommand& other)
-    : type(other.type) {
-    // Copy union data based on type
+size_t commandSize(CommandType type) {
     switch (type) {
         case CommandType::Draw2D:
-            draw2D = other.draw2D;
-            break;
+            return sizeof(DrawCommand2D);
         case CommandType::Draw3D:
-            draw3D = other.draw3D;
-            break;
+            return sizeof(DrawCommand3D);
+        case CommandType::Draw3DInstanced:
+            return sizeof(DrawCommand3DInstanced);
+        case CommandType::Draw3DIndirect:
+            return sizeof(DrawCommand3DIndirect);
+        case CommandType::Draw2DShapes:
+            return sizeof(DrawCommand2DShapes);
+        case CommandType::Draw2DStroke:
+            return sizeof(DrawCommand2DStroke);
+        case CommandType::Draw2DPaths:
+            return sizeof(DrawCommand2DPaths);
+        case CommandType::DrawPointCloud:
+            return sizeof(DrawPointCloudCommand);
+        case CommandType::DrawDisplayList:
+            return sizeof(DrawDisplayListCommand);
+        case CommandType::RenderShadowMap:
+            return sizeof(RenderShadowMapCommand);
+        case CommandType::DrawMeshPrimitives:
+            return sizeof(DrawMeshPrimitivesCommand);
         case CommandType::SetViewport:
-            viewport = other.viewport;
-            break;
+            return sizeof(SetViewportCommand);
         case CommandType::SetScissor:
-            scissor = other.scissor;
-            break;
+            return sizeof(SetScissorCommand);
         case CommandType::Clear:
-            clear = other.clear;
-            break;
+            return sizeof(SetClearCommand);
         case CommandType::SetRenderTarget:
-            renderTarget = other.renderTarget;
-            break;
+            return sizeof(SetRenderTargetCommand);
         case CommandType::SetCustomShader:
-            customShader = other.customShader;
-            break;
+            return sizeof(SetCustomShaderCommand);
+        case CommandType::DispatchCompute:
+            return sizeof(DispatchComputeCommand);
+        case CommandType::ReadbackTexture:
+            return sizeof(ReadbackTextureCommand);
+        case CommandType::FilterTexture:
+            return sizeof(FilterTextureCommand);
+        case CommandType::GenerateMipmaps:
+            return sizeof(GenerateMipmapsCommand);
+        case CommandType::ConvertYCbCr:
+            return sizeof(ConvertYCbCrCommand);
+        case CommandType::ConvertYCoCg:
+            return sizeof(ConvertYCoCgCommand);
+        case CommandType::CopyTexture:
+            return sizeof(CopyTextureCommand);
+        case CommandType::PostProcess:
+            return sizeof(PostProcessCommand);
         default:
-            break;
+            // State-change tags without payload structs are stored as the bare tag
+            return sizeof(CommandType);
     }
 }
 
-DrawCommand& DrawCommand::operator=(const DrawCommand& other) {
-    if (this != &other) {
-        type = other.type;
-
-        // Copy union data based on type
-        switch (type) {
-            case CommandType::Draw2D:
-                draw2D = other.draw2D;
-                break;
-            case CommandType::Draw3D:
-                draw3D = other.draw3D;
-                break;
-            case CommandType::SetViewport:
-                viewport = other.viewport;
-                break;
-            case CommandType::SetScissor:
-                scissor = other.scissor;
-                break;
-            case CommandType::Clear:
-                clear = other.clear;
-                break;
-            case CommandType::SetRenderTarget:
-                renderTarget = other.renderTarget;
-                break;
-            case CommandType::SetCustomShader:
-                customShader = other.customShader;
-                break;
-            default:
-                break;
-        }
-    }
-    return *this;
-}
-
-DrawCommand::~DrawCommand() {
-    // No dynamic memory to clean up in current implementation
-    // Texture handles are managed externally
+void CommandStream::push(const CommandRef& ref) {
+    const size_t size = commandSize(ref.type);
+    const size_t offset = bytes_;
+    grow(alignedSize(size));
+    std::memcpy(data() + offset, ref.data, size);
+    offsets_.push_back(static_cast<uint32_t>(offset));
 }
 
 } // namespace render
@@ -5,6 +5,9 @@
 #include <cstdint>
 #include <cstring>
 #include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
 
 namespace render {
 
@@ -23,6 +26,15 @@ enum class CommandType : uint32_t {
     // Drawing commands
     Draw2D,                 // Draw 2D vertices
     Draw3D,                 // Draw 3D vertices
+    Draw3DInstanced,        // Draw 3D vertices once per instance
+    Draw3DIndirect,         // Draw 3D vertices with GPU-written arguments
+    Draw2DShapes,           // Draw SDF shape quads (circles, rounded rects, thick lines)
+    Draw2DStroke,           // Draw stroke segments expanded on the GPU
+    Draw2DPaths,            // Fill paths with analytic coverage computed on the GPU
+    DrawPointCloud,         // Draw a range of a resident point cloud as point sprites
+    DrawDisplayList,        // Replay a recorded DrawList (retained display list)
+    RenderShadowMap,        // Render recorded casters into a shadow map (splits the render pass)
+    DrawMeshPrimitives,     // Generate unit primitives per instance in object/mesh shaders
 
     // State commands
     SetViewport,            // Set viewport rectangle
@@ -30,6 +42,14 @@ enum class CommandType : uint32_t {
     Clear,                  // Clear render target
     SetRenderTarget,        // Change render target
     SetCustomShader,        // Use custom shader pipeline
+    DispatchCompute,        // Run a compute kernel (splits the render pass)
+    ReadbackTexture,        // Copy a texture into a CPU-visible buffer (splits the render pass)
+    FilterTexture,          // Run an image filter from one texture into another (splits the render pass)
+    GenerateMipmaps,        // Rebuild a texture's mip chain from its base level (splits the render pass)
+    ConvertYCbCr,           // Convert a bi-planar YCbCr video frame to RGBA (splits the render pass)
+    ConvertYCoCg,           // Convert a scaled YCoCg (HAP Q) video frame to RGBA (splits the render pass)
+    CopyTexture,            // Scale a texture or the screen into another texture (splits the render pass)
+    PostProcess,            // Run a post-processing stack from one texture into another (splits the render pass)
 
     // State changes
     SetBlendMode,           // Change blend mode
@@ -69,6 +89,106 @@ struct ClearCommand {
         , clearStencil(false) {}
 };
 
+// ============================================================================
+// Side Table State
+// ============================================================================
+
+/// Sentinel for "no lighting state" (16-bit handle space)
+constexpr uint16_t kInvalidLightingHandle = 0xFFFFu;
+
+/// Floats per light (ofLight::getUniformData() order, LightData in Lighting.metal)
+constexpr size_t kLightFloats = 22;
+
+/// Lights one LightingState can reference
+constexpr size_t kMaxLights = 256;
+
+/// Sentinel for "no shadows" (16-bit handle space)
+constexpr uint16_t kInvalidShadowHandle = 0xFFFFu;
+
+/// Shadow-casting lights one lit draw samples
+constexpr size_t kMaxShadowLights = 4;
+
+/// Cascades of one directional light's shadow map
+constexpr size_t kMaxShadowCascades = 4;
+
+/// Shadow map of one light as the lighting shaders read it (matches
+/// ShadowLight in Lighting.metal)
+struct ShadowLight {
+    simd_float4x4 matrices[kMaxShadowCascades]; // View space -> shadow map clip space, per cascade
+    simd_float4 splits;                 // Far view depth of each cascade
+    int32_t lightIndex;                 // Light within the draw's lights
+    int32_t cascadeCount;               // Slices of the shadow map in use (1 for spot lights)
+    float bias;                         // Receiver depth bias (shadow map depth units)
+    float strength;                     // 0 = unshadowed, 1 = fully shadowed
+    float texelSize;                    // 1 / shadow map resolution (PCF step)
+    float padding[3];
+};
+
+/// Shadow uniforms of a lit draw at fragment buffer(6) (matches
+/// ShadowUniforms in Lighting.metal)
+struct ShadowUniforms {
+    int32_t count;                      // Lights with a shadow map
+    int32_t padding[3];
+    ShadowLight lights[kMaxShadowLights];
+};
+
+/// Shadows sampled by lit 3D draws.
+/// Stored in DrawList's side table and referenced by
+/// LightingState::shadowHandle; Context builds one per lighting block while
+/// shadow maps are registered (ofShadow), with the matrices already
+/// relative to the view the draws were recorded under.
+struct ShadowState {
+    void* shadowMaps[kMaxShadowLights]; // id<MTLTexture> depth 2D arrays, by light
+    ShadowUniforms uniforms;
+
+    ShadowState() : shadowMaps(), uniforms() {}
+};
+
+/// Lighting + material uniforms shared by lit 3D draws.
+/// Stored once per unique block in DrawList's side table; DrawCommand3D
+/// refers to it by a 16-bit handle so the command itself stays small.
+/// Context interns blocks by version, so consecutive draws under unchanged
+/// lights/material share one entry. The lights themselves live in the
+/// list's light pool (DrawList::allocateLights), so a material change does
+/// not copy them again.
+struct LightingState {
+    int lightCount;                     // Number of lights
+    uint32_t firstLight;                // First light in DrawList::getLightData()
+    float materialData[16];             // Material uniform data (13 floats + padding)
+    uint16_t shadowHandle;              // DrawList::getShadowState(), kInvalidShadowHandle = none
+
+    LightingState() : lightCount(0), firstLight(0), shadowHandle(kInvalidShadowHandle) {
+        std::memset(materialData, 0, sizeof(materialData));
+    }
+};
+
+/// Sentinel for "no texture batch" (16-bit handle space)
+constexpr uint16_t kInvalidTextureBatch = 0xFFFFu;
+
+/// Textures of a 2D batch that optimize() merged across textures
+/// (DrawList::setTextureBatching). The ranges partition the batch's
+/// vertices and indices in draw order, each sampling one texture slot; the
+/// renderer binds the slots as a texture array and the vertex shader maps
+/// vertex_id to its slot, so the whole batch is one draw.
+struct TextureBatch2D {
+    static constexpr uint32_t kMaxTextures = 16;
+    static constexpr uint32_t kMaxRanges = 64;
+
+    void* textures[kMaxTextures];       // id<MTLTexture> handles by slot
+    uint32_t textureCount;
+    uint32_t rangeCount;
+    uint32_t vertexEnd[kMaxRanges];     // Exclusive range ends, relative to the batch
+    uint32_t indexEnd[kMaxRanges];      // Same for indices (indexed batches)
+    uint8_t slot[kMaxRanges];           // Texture slot of each range
+
+    TextureBatch2D() : textureCount(0), rangeCount(0) {
+        std::memset(textures, 0, sizeof(textures));
+        std::memset(vertexEnd, 0, sizeof(vertexEnd));
+        std::memset(indexEnd, 0, sizeof(indexEnd));
+        std::memset(slot, 0, sizeof(slot));
+    }
+};
+
 // ============================================================================
 // Draw Commands
 // ============================================================================
@@ -91,6 +211,10 @@ struct DrawCommand2D {
 
     // Texture (optional, nullptr = no texture)
     void* texture;              // id<MTLTexture> handle
+    SamplerKey samplerKey;      // Filter/wrap selection for texture
+    uint16_t textureBatch;      // DrawList texture batch (kInvalidTextureBatch = texture only)
+    VertexFormat vertexFormat;  // Stream holding the vertex range (set by optimize())
+    bool distanceField;         // Texture alpha is a distance field (0.5 on the edge)
 
     // Transformation matrix (2D projection + model-view)
     simd_float4x4 transform;
@@ -103,6 +227,77 @@ struct DrawCommand2D {
         , primitiveType(PrimitiveType::Triangle)
         , blendMode(BlendMode::Alpha)
         , texture(nullptr)
+        , samplerKey(kDefaultSamplerKey)
+        , textureBatch(kInvalidTextureBatch)
+        , vertexFormat(VertexFormat::Float)
+        , distanceField(false)
+        , transform(matrix_identity_float4x4) {}
+};
+
+/// 2D SDF shape command
+/// Draws shapeCount records of the DrawList's shape stream (addShapes) as
+/// one instanced quad each; the fragment shader computes anti-aliased
+/// coverage from the shape's signed distance, so vertex cost is constant
+/// regardless of circle resolution.
+struct DrawCommand2DShapes {
+    CommandType type = CommandType::Draw2DShapes;
+
+    uint32_t shapeOffset;       // First record in the shape stream
+    uint32_t shapeCount;        // Number of shapes
+    BlendMode blendMode;
+
+    // Transformation matrix (2D model-view, as DrawCommand2D)
+    simd_float4x4 transform;
+
+    DrawCommand2DShapes()
+        : shapeOffset(0)
+        , shapeCount(0)
+        , blendMode(BlendMode::Alpha)
+        , transform(matrix_identity_float4x4) {}
+};
+
+/// 2D stroke command
+/// Draws segmentCount records of the DrawList's stroke stream
+/// (addStrokeSegments). The vertex shader expands every segment into its
+/// body quad, join and caps, so wide lines and polylines cost one record
+/// per segment on the CPU. Segments of many polylines share one draw.
+struct DrawCommand2DStroke {
+    CommandType type = CommandType::Draw2DStroke;
+
+    uint32_t segmentOffset;     // First record in the stroke stream
+    uint32_t segmentCount;      // Number of segments
+    BlendMode blendMode;
+
+    // Transformation matrix (2D model-view, as DrawCommand2D)
+    simd_float4x4 transform;
+
+    DrawCommand2DStroke()
+        : segmentOffset(0)
+        , segmentCount(0)
+        , blendMode(BlendMode::Alpha)
+        , transform(matrix_identity_float4x4) {}
+};
+
+/// 2D path fill command
+/// Draws pathCount records of the DrawList's path stream (addPaths) as one
+/// instanced quad each. The fragment shader counts the winding of the
+/// path's edges (addPathSegments) under every pixel, applying the path's
+/// fill rule, so dynamic vector art is filled without CPU triangulation.
+/// Per-pixel cost grows with the path's edge count.
+struct DrawCommand2DPaths {
+    CommandType type = CommandType::Draw2DPaths;
+
+    uint32_t pathOffset;        // First record in the path stream
+    uint32_t pathCount;         // Number of paths
+    BlendMode blendMode;
+
+    // Transformation matrix (2D model-view, as DrawCommand2D)
+    simd_float4x4 transform;
+
+    DrawCommand2DPaths()
+        : pathOffset(0)
+        , pathCount(0)
+        , blendMode(BlendMode::Alpha)
         , transform(matrix_identity_float4x4) {}
 };
 
@@ -124,6 +319,7 @@ struct DrawCommand3D {
 
     // Texture (optional, nullptr = no texture)
     void* texture;              // id<MTLTexture> handle
+    SamplerKey samplerKey;      // Filter/wrap selection for texture
 
     // 3D Matrices
     simd_float4x4 modelViewMatrix;      // Model-view transformation
@@ -135,11 +331,23 @@ struct DrawCommand3D {
     bool depthWriteEnabled;
     bool cullBackFace;
 
+    // Weighted blended transparency: drawn in any order into accumulation
+    // targets and composited over the pass when it ends (never writes depth)
+    bool orderIndependent;
+
+    // Written to the object ID target on frames with a pick request
+    // (0 = no object; instanced draws share it)
+    uint32_t objectId;
+
     // Lighting state (captured at command creation time)
     bool useLighting;                   // Whether to use lighting pipeline
-    int lightCount;                     // Number of lights
-    float materialData[16];             // Material uniform data (13 floats + padding)
-    float lightData[256];               // Light uniform data (up to 8 lights, 23 floats each)
+    uint16_t lightingHandle;            // Handle into DrawList lighting side table
+    VertexFormat vertexFormat;          // Stream holding the vertex range (set by optimize())
+
+    // Resident geometry (optional, nullptr = this DrawList's streams)
+    void* vertexBuffer;         // id<MTLBuffer> of Vertex3D records; vertexOffset indexes it
+    void* indexBuffer;          // id<MTLBuffer> of indices; indexOffset indexes it
+    IndexType indexType;        // Element width of indexBuffer
 
     DrawCommand3D()
         : vertexOffset(0)
@@ -149,19 +357,524 @@ struct DrawCommand3D {
         , primitiveType(PrimitiveType::Triangle)
         , blendMode(BlendMode::Alpha)
         , texture(nullptr)
+        , samplerKey(kDefaultSamplerKey)
         , modelViewMatrix(matrix_identity_float4x4)
         , projectionMatrix(matrix_identity_float4x4)
         , normalMatrix(matrix_identity_float3x3)
         , depthTestEnabled(false)
         , depthWriteEnabled(false)
         , cullBackFace(false)
+        , orderIndependent(false)
+        , objectId(0)
         , useLighting(false)
-        , lightCount(0) {
-        std::memset(materialData, 0, sizeof(materialData));
-        std::memset(lightData, 0, sizeof(lightData));
+        , lightingHandle(kInvalidLightingHandle)
+        , vertexFormat(VertexFormat::Float)
+        , vertexBuffer(nullptr)
+        , indexBuffer(nullptr)
+        , indexType(IndexType::UInt32) {}
+};
+
+/// Instanced 3D draw command
+/// Draws the geometry instanceCount times in one draw call. The instanced
+/// vertex shaders read InstanceData records starting at instanceOffset
+/// from instanceBuffer and apply them before modelViewMatrix. A null
+/// instanceBuffer selects the DrawList's own instance stream (addInstances).
+struct DrawCommand3DInstanced : DrawCommand3D {
+    void* instanceBuffer;       // id<MTLBuffer> of InstanceData records, nullptr = DrawList stream
+    uint32_t instanceOffset;    // First instance record
+    uint32_t instanceCount;     // Number of instances
+
+    DrawCommand3DInstanced()
+        : instanceBuffer(nullptr)
+        , instanceOffset(0)
+        , instanceCount(0) {
+        type = CommandType::Draw3DInstanced;
+    }
+};
+
+/// Indirect 3D draw command
+/// Indexed draw whose index count, instance count, first index, base vertex
+/// and base instance come from a GPU buffer (MTLDrawIndexedPrimitivesIndirectArguments
+/// layout, e.g. written by a culling kernel). indexOffset/indexCount still
+/// locate the recorded indices; the arguments select a range within them.
+struct DrawCommand3DIndirect : DrawCommand3D {
+    void* argumentBuffer;       // id<MTLBuffer> with the draw arguments
+    uint32_t argumentOffset;    // Byte offset of the arguments
+    void* instanceBuffer;       // InstanceData records, or nullptr (not instanced)
+
+    DrawCommand3DIndirect()
+        : argumentBuffer(nullptr)
+        , argumentOffset(0)
+        , instanceBuffer(nullptr) {
+        type = CommandType::Draw3DIndirect;
+    }
+};
+
+/// Unit primitive built by DrawMeshPrimitivesCommand
+enum class MeshPrimitive : uint32_t {
+    Sphere,         // resolution = latitude segments (2x around)
+    Cylinder,       // resolution = segments around, with both caps
+    IcoSphere,      // resolution = subdivisions (0-5)
+};
+
+/// Largest meshlet lattice (segments per side) of a mesh primitive
+constexpr uint32_t kMeshletSegments = 8;
+
+/// Mesh-shader primitive draw command
+/// Draws the unit primitive (as ofDrawSphere/ofDrawCylinder/ofDrawIcoSphere
+/// tessellate it) once per InstanceData record without vertex data: an
+/// object shader splits the surface into meshlets of up to kMeshletSegments
+/// segments per side, drops those outside the frustum and picks each one's
+/// tessellation from its projected size; a mesh shader emits the triangles.
+/// The vertex fields of the base command are unused. Requires
+/// IRenderer::supportsMeshPrimitives().
+struct DrawMeshPrimitivesCommand : DrawCommand3DInstanced {
+    MeshPrimitive primitive;    // Surface to generate
+    uint32_t resolution;        // Finest tessellation (rounded up to whole meshlets)
+
+    DrawMeshPrimitivesCommand()
+        : primitive(MeshPrimitive::Sphere)
+        , resolution(0) {
+        type = CommandType::DrawMeshPrimitives;
     }
 };
 
+/// Point cloud draw command
+/// Draws pointCount records of a resident PointCloudPoint buffer, from
+/// firstPoint, as round point sprites. Positions are decoded with the
+/// PointCloudChunk of each record (record index / kPointCloudChunkSize).
+/// Sprites are pointSize pixels wide, or pointSize model units projected
+/// with the point's depth when sizeAttenuation is set.
+struct DrawPointCloudCommand {
+    CommandType type = CommandType::DrawPointCloud;
+
+    void* pointBuffer;                  // id<MTLBuffer> of PointCloudPoint records
+    void* chunkBuffer;                  // id<MTLBuffer> of PointCloudChunk records
+    uint32_t firstPoint;
+    uint32_t pointCount;
+
+    simd_float4x4 modelViewMatrix;
+    simd_float4x4 projectionMatrix;
+
+    float pointSize;                    // Pixels, or view-space units when attenuated
+    bool sizeAttenuation;
+    bool depthTestEnabled;              // Tests and writes depth
+    BlendMode blendMode;
+
+    DrawPointCloudCommand()
+        : pointBuffer(nullptr)
+        , chunkBuffer(nullptr)
+        , firstPoint(0)
+        , pointCount(0)
+        , modelViewMatrix(matrix_identity_float4x4)
+        , projectionMatrix(matrix_identity_float4x4)
+        , pointSize(1.0f)
+        , sizeAttenuation(false)
+        , depthTestEnabled(true)
+        , blendMode(BlendMode::Alpha) {}
+};
+
+// ============================================================================
+// Display List Commands
+// ============================================================================
+
+class DrawList;
+
+/// Display list replay command
+/// Executes the commands of a recorded DrawList (ofDisplayList) in place of
+/// this one. The renderer keeps the recorded streams in a resident buffer
+/// keyed by listId, so a replay costs this record on the CPU and no
+/// geometry upload. Recorded 2D transforms are premultiplied by transform2D,
+/// recorded 3D model-view matrices by transform3D (normals by its inverse
+/// transpose), and projectionMatrix replaces the recorded projection.
+struct DrawDisplayListCommand {
+    CommandType type = CommandType::DrawDisplayList;
+
+    const DrawList* displayList;        // Recorded list (unchanged until the frame is rendered)
+    uint64_t listId;                    // Unique per recording, 0 = none
+
+    simd_float4x4 transform2D;          // Applied before recorded 2D transforms
+    simd_float4x4 transform3D;          // Applied before recorded model-view matrices
+    simd_float4x4 projectionMatrix;     // Projection for recorded 3D draws
+
+    DrawDisplayListCommand()
+        : displayList(nullptr)
+        , listId(0)
+        , transform2D(matrix_identity_float4x4)
+        , transform3D(matrix_identity_float4x4)
+        , projectionMatrix(matrix_identity_float4x4) {}
+};
+
+// ============================================================================
+// Shadow Commands
+// ============================================================================
+
+/// Shadow map render command
+/// Renders the 3D draws of a recorded caster list (ofShadow) depth-only
+/// into one slice of a shadow map, between the draws of the frame. The
+/// casters were recorded under the light's view, so only their projection
+/// is given here; 2D draws and state commands in the list are ignored.
+/// Like a display list the casters are kept resident by listId;
+/// replacesListId names the recording this one supersedes so its copy is
+/// released now instead of when it ages out. A map whose casters did not
+/// change is simply not rendered again and keeps its contents.
+struct RenderShadowMapCommand {
+    CommandType type = CommandType::RenderShadowMap;
+
+    const DrawList* casters;            // Recorded casters (unchanged until the frame is rendered)
+    uint64_t listId;                    // Unique per recording, 0 = none
+    uint64_t replacesListId;            // Earlier recording of this slice, 0 = none
+
+    void* shadowMap;                    // id<MTLTexture> depth 2D array
+    uint32_t slice;                     // Array slice (cascade) to render
+
+    simd_float4x4 projectionMatrix;     // Light projection for the recorded draws
+    float depthBias;                    // Constant depth bias applied while rendering
+    float slopeBias;                    // Slope-scaled depth bias
+
+    RenderShadowMapCommand()
+        : casters(nullptr)
+        , listId(0)
+        , replacesListId(0)
+        , shadowMap(nullptr)
+        , slice(0)
+        , projectionMatrix(matrix_identity_float4x4)
+        , depthBias(0.0f)
+        , slopeBias(0.0f) {}
+};
+
+// ============================================================================
+// Compute Commands
+// ============================================================================
+
+/// Compute dispatch command
+/// Runs a grid of threadCount x gridHeight x gridDepth threads between draws
+/// of the same frame, in whole threadgroups (kernels bounds-check against
+/// the grid). Buffers are bound at buffer(0..bufferCount-1) and the inline
+/// constants at buffer(bufferCount); textures at texture(0..textureCount-1).
+/// Resources are hazard-tracked, so passes recorded after the dispatch see
+/// its writes. Record dispatches before drawing where possible: one in the
+/// middle of a pass ends the render encoder and reloads its attachments.
+struct DispatchComputeCommand {
+    static constexpr uint32_t kMaxBuffers = 8;
+    static constexpr uint32_t kMaxTextures = 4;
+    static constexpr uint32_t kMaxConstantsSize = 128;
+
+    CommandType type = CommandType::DispatchCompute;
+    void* pipelineState;                    // id<MTLComputePipelineState>
+    void* buffers[kMaxBuffers];             // id<MTLBuffer> handles
+    uint32_t bufferOffsets[kMaxBuffers];    // Byte offsets
+    uint32_t bufferCount;
+    void* textures[kMaxTextures];           // id<MTLTexture> handles
+    uint32_t textureCount;
+    uint32_t threadCount;                   // Grid width (threads)
+    uint32_t gridHeight;                    // Grid height (1 for 1D grids)
+    uint32_t gridDepth;                     // Grid depth (1 for 1D/2D grids)
+    uint32_t threadgroupSize[3];            // Threads per group; 0 = chosen from the pipeline
+    uint32_t constantsSize;                 // Bytes used in constants
+    alignas(16) uint8_t constants[kMaxConstantsSize];
+
+    DispatchComputeCommand()
+        : pipelineState(nullptr)
+        , bufferCount(0)
+        , textureCount(0)
+        , threadCount(0)
+        , gridHeight(1)
+        , gridDepth(1)
+        , threadgroupSize{0, 0, 0}
+        , constantsSize(0) {
+        for (uint32_t i = 0; i < kMaxBuffers; ++i) {
+            buffers[i] = nullptr;
+            bufferOffsets[i] = 0;
+        }
+        for (uint32_t i = 0; i < kMaxTextures; ++i) {
+            textures[i] = nullptr;
+        }
+        std::memset(constants, 0, sizeof(constants));
+    }
+};
+
+// ============================================================================
+// Readback Commands
+// ============================================================================
+
+/// Readback completion callback, called once per executed readback from a
+/// Metal completion thread. succeeded is false if the copy could not be
+/// encoded or the frame's GPU work failed.
+using ReadbackCompletion = void (*)(uint64_t readbackId, bool succeeded);
+
+/// Texture readback command
+/// Copies a region of a texture into a buffer once everything recorded
+/// before it has rendered, without waiting for the GPU. The buffer must be
+/// CPU-visible and stay alive until completion is called, which happens
+/// when the frame's command buffer has finished. Readbacks of multisampled
+/// textures fail. A readback replayed from a display list completes once
+/// per replay.
+struct ReadbackTextureCommand {
+    CommandType type = CommandType::ReadbackTexture;
+    void* texture;                      // id<MTLTexture> to read
+    void* buffer;                       // id<MTLBuffer> receiving the texels
+    uint32_t bufferOffset;              // Byte offset of the first row
+    uint32_t bytesPerRow;               // Destination row pitch
+    uint32_t x, y;                      // Region origin in texels
+    uint32_t width, height;             // Region size in texels
+    ReadbackCompletion completion;
+    uint64_t readbackId;                // Passed back to completion
+
+    ReadbackTextureCommand()
+        : texture(nullptr)
+        , buffer(nullptr)
+        , bufferOffset(0)
+        , bytesPerRow(0)
+        , x(0), y(0)
+        , width(0), height(0)
+        , completion(nullptr)
+        , readbackId(0) {}
+};
+
+// ============================================================================
+// Image Filter Commands
+// ============================================================================
+
+/// GPU image filter of a FilterTextureCommand
+enum class ImageFilterType : uint8_t {
+    GaussianBlur,   // sigma
+    BoxBlur,        // kernelWidth x kernelHeight mean
+    Unsharp,        // source + amount * (source - Gaussian(sigma))
+    Sobel,          // Edge magnitude of the luminance
+    Dilate,         // kernelWidth x kernelHeight maximum
+    Erode,          // kernelWidth x kernelHeight minimum
+    Convolve,       // kernelWidth x kernelHeight weights
+    Median,         // kernelWidth x kernelWidth median
+    Point           // pointStages applied per pixel in one pass
+};
+
+/// Per-pixel operation of an ImagePointStage, applied to RGB in [0, 1]
+/// (alpha is kept) and clamped after each stage like 8-bit pixels
+enum class ImagePointOp : uint32_t {
+    Linear,         // v * a + b (brightness, contrast, invert)
+    Saturation,     // luma + a * (v - luma)
+    Gamma,          // pow(v, a)
+    Threshold       // v >= a ? 1 : 0
+};
+
+/// One stage of a fused per-pixel filter (matches PointStage in ImageFilter.metal)
+struct ImagePointStage {
+    ImagePointOp op = ImagePointOp::Linear;
+    float a = 1.0f;
+    float b = 0.0f;
+};
+
+/// Texture filter command
+/// Filters a texture into another one once everything recorded before it
+/// has rendered, entirely on the GPU. The destination must be a different,
+/// shader-writable texture (IRenderer::createWritableTexture()); the
+/// filter writes the region of the destination that overlaps the source.
+/// Pixels outside the source repeat its edge.
+struct FilterTextureCommand {
+    static constexpr uint32_t kMaxKernelSize = 9;  // Convolve and Median diameter limit
+    static constexpr uint32_t kMaxPointStages = 8;  // Point stages per pass
+
+    CommandType type = CommandType::FilterTexture;
+    void* source;                       // id<MTLTexture> to read
+    void* destination;                  // id<MTLTexture> to write
+    ImageFilterType filter;
+    uint32_t kernelWidth;               // Odd; BoxBlur, Dilate, Erode, Convolve, Median
+    uint32_t kernelHeight;              // Odd; BoxBlur, Dilate, Erode, Convolve
+    float sigma;                        // GaussianBlur, Unsharp
+    float amount;                       // Unsharp
+    float weights[kMaxKernelSize * kMaxKernelSize];  // Convolve, row-major
+    uint32_t pointStageCount;           // Point
+    ImagePointStage pointStages[kMaxPointStages];
+
+    FilterTextureCommand()
+        : source(nullptr)
+        , destination(nullptr)
+        , filter(ImageFilterType::GaussianBlur)
+        , kernelWidth(3)
+        , kernelHeight(3)
+        , sigma(1.0f)
+        , amount(1.0f)
+        , pointStageCount(0) {
+        for (uint32_t i = 0; i < kMaxKernelSize * kMaxKernelSize; ++i) {
+            weights[i] = 0.0f;
+        }
+    }
+};
+
+// ============================================================================
+// Post-Processing Commands
+// ============================================================================
+
+/// Pass of a PostProcessCommand
+enum class PostProcessPassType : uint32_t {
+    Fused,          // Stages applied per pixel in one pass
+    Blur,           // params[0] = sigma
+    Bloom           // params[0] = threshold, params[1] = intensity, levels mips
+};
+
+/// Per-pixel operation of a PostProcessStage. Colors stay unclamped (HDR)
+/// between stages; only the final write to the destination clamps.
+enum class PostProcessOp : uint32_t {
+    Exposure,       // rgb * a
+    Contrast,       // (rgb - b) * a + b, around pivot b
+    Saturation,     // luma + a * (rgb - luma)
+    ColorFilter,    // rgb * (a, b, c)
+    Vignette,       // rgb * (1 - a * smoothstep(b, b + c, distance from centre))
+    Tonemap,        // ACES filmic curve of rgb * a
+    Gamma           // pow(rgb, a)
+};
+
+/// One stage of a fused post-processing pass (matches PostStage in PostProcess.metal)
+struct PostProcessStage {
+    PostProcessOp op = PostProcessOp::Exposure;
+    float a = 1.0f;
+    float b = 0.0f;
+    float c = 0.0f;
+};
+
+/// One pass of a PostProcessCommand
+struct PostProcessPass {
+    PostProcessPassType type = PostProcessPassType::Fused;
+    uint32_t firstStage = 0;            // Fused: range in PostProcessCommand::stages
+    uint32_t stageCount = 0;
+    float params[2] = {0.0f, 0.0f};
+    uint32_t levels = 0;                // Bloom: half-size and smaller mips
+};
+
+/// Post-processing command
+/// Runs a stack of effects from a texture into another once everything
+/// recorded before it has rendered. Fused passes apply their stages per
+/// pixel in one compute pass; a bloom pass builds its mip chain from the
+/// current image and is composited by the next fused pass (an empty one is
+/// added if none follows). Intermediates are transient RGBA16F textures
+/// aliased in one renderer-owned heap. The destination must be a
+/// different, shader-writable texture (IRenderer::createWritableTexture());
+/// the overlap with the source is written.
+struct PostProcessCommand {
+    static constexpr uint32_t kMaxPasses = 8;
+    static constexpr uint32_t kMaxStages = 16;
+    static constexpr uint32_t kMaxBloomLevels = 8;
+
+    CommandType type = CommandType::PostProcess;
+    void* source;                       // id<MTLTexture> to read
+    void* destination;                  // id<MTLTexture> to write
+    uint32_t passCount;
+    PostProcessPass passes[kMaxPasses];
+    uint32_t stageCount;
+    PostProcessStage stages[kMaxStages];
+
+    PostProcessCommand()
+        : source(nullptr)
+        , destination(nullptr)
+        , passCount(0)
+        , stageCount(0) {}
+};
+
+// ============================================================================
+// Video Commands
+// ============================================================================
+
+/// Color matrix of a ConvertYCbCrCommand
+enum class YCbCrMatrix : uint8_t {
+    BT601,          // SD video and most webcams
+    BT709           // HD video
+};
+
+/// Bi-planar YCbCr conversion command
+/// Converts a 4:2:0 video frame (a full-size luma plane and a half-size
+/// interleaved chroma plane, as decoders and cameras output it) into an
+/// RGBA texture once everything recorded before it has rendered. Chroma is
+/// upsampled bilinearly. The destination must be shader-writable
+/// (IRenderer::createWritableTexture()); the overlap with the luma plane is
+/// written.
+struct ConvertYCbCrCommand {
+    CommandType type = CommandType::ConvertYCbCr;
+    void* luma;                         // id<MTLTexture>, R8 Y plane
+    void* chroma;                       // id<MTLTexture>, RG8 CbCr plane
+    void* destination;                  // id<MTLTexture> to write
+    YCbCrMatrix matrix;
+    bool fullRange;                     // 0-255 levels (420f) rather than 16-235 (420v)
+
+    ConvertYCbCrCommand()
+        : luma(nullptr)
+        , chroma(nullptr)
+        , destination(nullptr)
+        , matrix(YCbCrMatrix::BT709)
+        , fullRange(false) {}
+};
+
+/// Scaled YCoCg conversion command
+/// Converts a HAP Q frame (scaled YCoCg in a DXT5/BC3 texture, with the
+/// optional BC4 alpha plane of HAP Q Alpha) into an RGBA texture once
+/// everything recorded before it has rendered. The destination must be
+/// shader-writable (IRenderer::createWritableTexture()); the overlap with
+/// the color texture is written.
+struct ConvertYCoCgCommand {
+    CommandType type = CommandType::ConvertYCoCg;
+    void* color;                        // id<MTLTexture>, BC3: Co, Cg, scale, Y
+    void* alpha;                        // id<MTLTexture>, BC4 alpha, or null for opaque
+    void* destination;                  // id<MTLTexture> to write
+
+    ConvertYCoCgCommand()
+        : color(nullptr)
+        , alpha(nullptr)
+        , destination(nullptr) {}
+};
+
+/// How a texture copy resamples
+enum class CopyTextureFilter : uint32_t {
+    Bilinear,       // One bilinear tap per destination pixel
+    Upscale,        // MetalFX spatial upscaler; Bilinear where unsupported (see CopyTextureCommand)
+};
+
+/// Texture copy command
+/// Scales a texture, or the screen when source is null, into a shader-
+/// writable destination once everything recorded before it has rendered.
+/// Sampling is bilinear and any pixel formats convert, so frames can be
+/// captured straight into encoder buffers (BGRA CVPixelBuffers wrapped as
+/// textures). A source region scales only the source's top-left corner,
+/// as in dynamic resolution rendering. The optional completion runs on a
+/// Metal thread once the frame holding the copy has finished.
+struct CopyTextureCommand {
+    CommandType type = CommandType::CopyTexture;
+    void* source;                       // id<MTLTexture> to read, or null for the screen
+    void* destination;                  // id<MTLTexture> to write
+    bool opaque;                        // Write alpha as 1
+    ReadbackCompletion completion;      // Optional
+    uint64_t copyId;                    // Passed back to completion
+    uint32_t sourceWidth;               // Region at the source's top-left; 0 = whole width
+    uint32_t sourceHeight;              // 0 = whole height
+    CopyTextureFilter filter;
+
+    CopyTextureCommand()
+        : source(nullptr)
+        , destination(nullptr)
+        , opaque(false)
+        , completion(nullptr)
+        , copyId(0)
+        , sourceWidth(0)
+        , sourceHeight(0)
+        , filter(CopyTextureFilter::Bilinear) {}
+};
+
+// ============================================================================
+// Mipmap Commands
+// ============================================================================
+
+/// Mipmap generation command
+/// Downsamples a texture's base level into its other mip levels once
+/// everything recorded before it has rendered, so uploads and render-to-
+/// texture passes earlier in the frame are included. Textures without mip
+/// storage (IRenderer::createMipmappedTexture()) are left untouched.
+struct GenerateMipmapsCommand {
+    CommandType type = CommandType::GenerateMipmaps;
+    void* texture;                      // id<MTLTexture> to rebuild
+
+    GenerateMipmapsCommand() : texture(nullptr) {}
+    explicit GenerateMipmapsCommand(void* tex) : texture(tex) {}
+};
+
 // ============================================================================
 // State Commands
 // ============================================================================
@@ -201,25 +914,35 @@ struct SetClearCommand {
 struct SetRenderTargetCommand {
     CommandType type = CommandType::SetRenderTarget;
     void* renderTarget;         // id<MTLTexture> handle or nullptr for screen
+    uint32_t sampleCount;       // MSAA samples resolved into renderTarget (1 = off)
 
     SetRenderTargetCommand()
-        : renderTarget(nullptr) {}
+        : renderTarget(nullptr)
+        , sampleCount(1) {}
 
-    explicit SetRenderTargetCommand(void* target)
-        : renderTarget(target) {}
+    explicit SetRenderTargetCommand(void* target, uint32_t samples = 1)
+        : renderTarget(target)
+        , sampleCount(samples) {}
 };
 
+/// Alignment of uniform snapshots in a DrawList's uniform stream
+/// (constant buffer offsets must be 256-byte aligned on macOS)
+constexpr size_t kUniformAlignment = 256;
+
 /// Custom shader command
+/// Following 2D draws bind the snapshot at fragment buffer(2) by offset into
+/// the list's uniform stream (DrawList::addUniformData()), so every draw sees
+/// the uniforms that were set when it was recorded.
 struct SetCustomShaderCommand {
     CommandType type = CommandType::SetCustomShader;
     void* pipelineState;        // id<MTLRenderPipelineState> handle or nullptr for default
-    void* uniformData;          // Uniform buffer data
-    size_t uniformSize;         // Size of uniform buffer
+    uint32_t uniformOffset;     // Byte offset of the snapshot in the uniform stream
+    uint32_t uniformSize;       // Size of the snapshot (0 = no uniforms)
     void* textures[16];         // Texture bindings (max 16 texture units)
 
     SetCustomShaderCommand()
         : pipelineState(nullptr)
-        , uniformData(nullptr)
+        , uniformOffset(0)
         , uniformSize(0) {
         for (int i = 0; i < 16; ++i) {
             textures[i] = nullptr;
@@ -228,54 +951,129 @@ struct SetCustomShaderCommand {
 };
 
 // ============================================================================
-// Generic Command Container
+// Packed Command Stream
 // ============================================================================
 
-/// Union-like container for all command types
-/// This allows storing different command types in a single list
-struct DrawCommand {
+/// Size in bytes of the command struct for a given type.
+size_t commandSize(CommandType type);
+
+/// Lightweight view of one command record inside a CommandStream.
+struct CommandRef {
     CommandType type;
+    const void* data;
 
-    union {
-        DrawCommand2D draw2D;
-        DrawCommand3D draw3D;
-        SetViewportCommand viewport;
-        SetScissorCommand scissor;
-        SetClearCommand clear;
-        SetRenderTargetCommand renderTarget;
-        SetCustomShaderCommand customShader;
-    };
+    template <typename T>
+    const T& as() const { return *static_cast<const T*>(data); }
+};
 
-    // Constructors for different command types
-    DrawCommand() : type(CommandType::Draw2D), draw2D() {}
+/**
+ * Tagged byte arena holding commands back to back at their own size.
+ *
+ * Each record is the command struct itself (its first member is the
+ * CommandType tag), padded to 16 bytes so simd matrices stay aligned.
+ * A SetViewportCommand therefore costs 32 bytes instead of the size of
+ * the largest command. Iteration walks the arena linearly; operator[]
+ * goes through a small offset table used by optimize()/sortCommands().
+ */
+class CommandStream {
+public:
+    static constexpr size_t kAlignment = 16;
 
-    explicit DrawCommand(const DrawCommand2D& cmd)
-        : type(CommandType::Draw2D), draw2D(cmd) {}
+    CommandStream() = default;
 
-    explicit DrawCommand(const DrawCommand3D& cmd)
-        : type(CommandType::Draw3D), draw3D(cmd) {}
+    /// Append a command (any of the *Command / DrawCommand* structs).
+    template <typename T>
+    void push(const T& cmd) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Commands must be trivially copyable");
+        static_assert(alignof(T) <= kAlignment, "Command alignment too large");
+        const size_t offset = bytes_;
+        grow(alignedSize(sizeof(T)));
+        std::memcpy(data() + offset, &cmd, sizeof(T));
+        offsets_.push_back(static_cast<uint32_t>(offset));
+    }
 
-    explicit DrawCommand(const SetViewportCommand& cmd)
-        : type(CommandType::SetViewport), viewport(cmd) {}
+    /// Append a record copied from another stream.
+    void push(const CommandRef& ref);
 
-    explicit DrawCommand(const SetScissorCommand& cmd)
-        : type(CommandType::SetScissor), scissor(cmd) {}
+    size_t size() const { return offsets_.size(); }
+    bool empty() const { return offsets_.empty(); }
 
-    explicit DrawCommand(const SetClearCommand& cmd)
-        : type(CommandType::Clear), clear(cmd) {}
+    /// Bytes used by the arena (for statistics).
+    size_t byteSize() const { return bytes_; }
 
-    explicit DrawCommand(const SetRenderTargetCommand& cmd)
-        : type(CommandType::SetRenderTarget), renderTarget(cmd) {}
+    /// Random access (through the offset table).
+    CommandRef operator[](size_t index) const {
+        const uint8_t* p = base() + offsets_[index];
+        return CommandRef{*reinterpret_cast<const CommandType*>(p), p};
+    }
 
-    explicit DrawCommand(const SetCustomShaderCommand& cmd)
-        : type(CommandType::SetCustomShader), customShader(cmd) {}
+    /// Mutable access to a record of known type.
+    template <typename T>
+    T& get(size_t index) {
+        return *reinterpret_cast<T*>(data() + offsets_[index]);
+    }
+
+    void clear() {
+        bytes_ = 0;
+        offsets_.clear();
+    }
+
+    void reserve(size_t commandCount, size_t byteCount) {
+        offsets_.reserve(commandCount);
+        storage_.reserve((byteCount + kAlignment - 1) / kAlignment);
+    }
+
+    void swap(CommandStream& other) {
+        storage_.swap(other.storage_);
+        offsets_.swap(other.offsets_);
+        std::swap(bytes_, other.bytes_);
+    }
 
-    // Copy constructor and assignment
-    DrawCommand(const DrawCommand& other);
-    DrawCommand& operator=(const DrawCommand& other);
+    /// Forward iterator that walks the arena linearly using per-type sizes.
+    class const_iterator {
+    public:
+        const_iterator(const uint8_t* p) : p_(p) {}
+        CommandRef operator*() const {
+            return CommandRef{*reinterpret_cast<const CommandType*>(p_), p_};
+        }
+        const_iterator& operator++() {
+            p_ += alignedSize(commandSize(*reinterpret_cast<const CommandType*>(p_)));
+            return *this;
+        }
+        bool operator!=(const const_iterator& other) const { return p_ != other.p_; }
+        bool operator==(const const_iterator& other) const { return p_ == other.p_; }
+    private:
+        const uint8_t* p_;
+    };
+
+    const_iterator begin() const { return const_iterator(base()); }
+    const_iterator end() const { return const_iterator(base() + bytes_); }
+
+    static constexpr size_t alignedSize(size_t size) {
+        return (size + kAlignment - 1) & ~(kAlignment - 1);
+    }
+
+private:
+    struct alignas(16) Block {
+        uint8_t bytes[16];
+    };
+
+    uint8_t* data() { return reinterpret_cast<uint8_t*>(storage_.data()); }
+    const uint8_t* base() const { return reinterpret_cast<const uint8_t*>(storage_.data()); }
+
+    void grow(size_t amount) {
+        bytes_ += amount;
+        const size_t blocks = bytes_ / kAlignment;
+        if (blocks > storage_.size()) {
+            // Geometric growth; storage is kept across clear() so steady-state frames never allocate
+            storage_.resize(std::max(blocks, storage_.size() * 2));
+        }
+    }
 
-    // Destructor
-    ~DrawCommand();
+    std::vector<Block> storage_;
+    std::vector<uint32_t> offsets_;
+    size_t bytes_ = 0;
 };
 
 } // namespace render
@@ -1,5 +1,8 @@
 #include "DrawList.h"
+#include "../oflike/utils/ofProfiler.h"
 #include <algorithm>
+#include <cstring>
+#include <unordered_map>
 
 namespace render {
 
@@ -9,7 +12,7 @@ namespace render {
 
 DrawList::DrawList() {
     // Reserve reasonable default capacity to avoid frequent reallocations
-    commands_.reserve(128);
+    commands_.reserve(128, 128 * sizeof(DrawCommand2D));
     vertices2D_.reserve(1024);
     vertices3D_.reserve(512);
     indices_.reserve(2048);
@@ -24,31 +27,237 @@ DrawList::~DrawList() {
 // ============================================================================
 
 void DrawList::addCommand(const DrawCommand2D& cmd) {
-    commands_.emplace_back(cmd);
+    commands_.push(cmd);
 }
 
 void DrawList::addCommand(const DrawCommand3D& cmd) {
-    commands_.emplace_back(cmd);
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const DrawCommand3DInstanced& cmd) {
+    if (cmd.instanceCount == 0) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const DrawCommand3DIndirect& cmd) {
+    if (!cmd.argumentBuffer) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const DrawMeshPrimitivesCommand& cmd) {
+    if (cmd.instanceCount == 0) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const DrawCommand2DShapes& cmd) {
+    if (cmd.shapeCount == 0) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const DrawCommand2DStroke& cmd) {
+    if (cmd.segmentCount == 0) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const DrawCommand2DPaths& cmd) {
+    if (cmd.pathCount == 0) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const DrawPointCloudCommand& cmd) {
+    if (!cmd.pointBuffer || !cmd.chunkBuffer || cmd.pointCount == 0) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const DrawDisplayListCommand& cmd) {
+    if (!cmd.displayList || cmd.listId == 0 || cmd.displayList == this) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const RenderShadowMapCommand& cmd) {
+    if (!cmd.casters || cmd.listId == 0 || !cmd.shadowMap || cmd.casters == this) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const DispatchComputeCommand& cmd) {
+    if (cmd.threadCount == 0 || cmd.gridHeight == 0 || cmd.gridDepth == 0 || !cmd.pipelineState) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const ReadbackTextureCommand& cmd) {
+    if (!cmd.texture || !cmd.buffer || !cmd.completion || cmd.width == 0 || cmd.height == 0) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const FilterTextureCommand& cmd) {
+    if (!cmd.source || !cmd.destination || cmd.source == cmd.destination) {
+        return;
+    }
+
+    // Kernel sizes are odd; convolution weights and the median window are bounded
+    bool sized = cmd.kernelWidth % 2 == 1 && cmd.kernelHeight % 2 == 1;
+    switch (cmd.filter) {
+        case ImageFilterType::Convolve:
+            sized = sized && cmd.kernelWidth <= FilterTextureCommand::kMaxKernelSize &&
+                    cmd.kernelHeight <= FilterTextureCommand::kMaxKernelSize;
+            break;
+        case ImageFilterType::Median:
+            sized = sized && cmd.kernelWidth >= 3 && cmd.kernelWidth <= FilterTextureCommand::kMaxKernelSize;
+            break;
+        case ImageFilterType::GaussianBlur:
+        case ImageFilterType::Unsharp:
+            sized = cmd.sigma > 0.0f;
+            break;
+        case ImageFilterType::Sobel:
+            sized = true;
+            break;
+        case ImageFilterType::Point:
+            sized = cmd.pointStageCount > 0 && cmd.pointStageCount <= FilterTextureCommand::kMaxPointStages;
+            break;
+        default:
+            break;
+    }
+    if (!sized) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const GenerateMipmapsCommand& cmd) {
+    if (!cmd.texture) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const ConvertYCbCrCommand& cmd) {
+    if (!cmd.luma || !cmd.chroma || !cmd.destination || cmd.luma == cmd.chroma ||
+        cmd.destination == cmd.luma || cmd.destination == cmd.chroma) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const ConvertYCoCgCommand& cmd) {
+    if (!cmd.color || !cmd.destination || cmd.destination == cmd.color || cmd.destination == cmd.alpha ||
+        cmd.alpha == cmd.color) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const CopyTextureCommand& cmd) {
+    if (!cmd.destination || cmd.source == cmd.destination) {
+        return;
+    }
+    commands_.push(cmd);
+}
+
+void DrawList::addCommand(const PostProcessCommand& cmd) {
+    if (!cmd.source || !cmd.destination || cmd.source == cmd.destination || cmd.passCount == 0 ||
+        cmd.passCount > PostProcessCommand::kMaxPasses || cmd.stageCount > PostProcessCommand::kMaxStages) {
+        return;
+    }
+    for (uint32_t i = 0; i < cmd.passCount; ++i) {
+        const PostProcessPass& pass = cmd.passes[i];
+        bool valid = true;
+        switch (pass.type) {
+            case PostProcessPassType::Fused:
+                valid = pass.firstStage + pass.stageCount <= cmd.stageCount;
+                break;
+            case PostProcessPassType::Blur:
+                valid = pass.params[0] > 0.0f;
+                break;
+            case PostProcessPassType::Bloom:
+                valid = pass.levels >= 1 && pass.levels <= PostProcessCommand::kMaxBloomLevels;
+                break;
+        }
+        if (!valid) {
+            return;
+        }
+    }
+    commands_.push(cmd);
 }
 
 void DrawList::addCommand(const SetViewportCommand& cmd) {
-    commands_.emplace_back(cmd);
+    commands_.push(cmd);
 }
 
 void DrawList::addCommand(const SetScissorCommand& cmd) {
-    commands_.emplace_back(cmd);
+    commands_.push(cmd);
 }
 
 void DrawList::addCommand(const SetClearCommand& cmd) {
-    commands_.emplace_back(cmd);
+    commands_.push(cmd);
 }
 
 void DrawList::addCommand(const SetRenderTargetCommand& cmd) {
-    commands_.emplace_back(cmd);
+    // The screen's sample count is the view's
+    SetRenderTargetCommand target = cmd;
+    if (!target.renderTarget || target.sampleCount == 0) {
+        target.sampleCount = 1;
+    }
+    commands_.push(target);
 }
 
 void DrawList::addCommand(const SetCustomShaderCommand& cmd) {
-    commands_.emplace_back(cmd);
+    commands_.push(cmd);
+}
+
+// ============================================================================
+// Side Tables
+// ============================================================================
+
+uint16_t DrawList::addLightingState(const LightingState& state) {
+    if (lightingStates_.size() >= kInvalidLightingHandle) {
+        return kInvalidLightingHandle;
+    }
+
+    uint16_t handle = static_cast<uint16_t>(lightingStates_.size());
+    lightingStates_.push_back(state);
+    return handle;
+}
+
+uint16_t DrawList::addShadowState(const ShadowState& state) {
+    if (shadowStates_.size() >= kInvalidShadowHandle) {
+        return kInvalidShadowHandle;
+    }
+
+    uint16_t handle = static_cast<uint16_t>(shadowStates_.size());
+    shadowStates_.push_back(state);
+    return handle;
+}
+
+float* DrawList::allocateLights(size_t count, uint32_t& firstLight) {
+    firstLight = static_cast<uint32_t>(lightData_.size() / kLightFloats);
+    if (count == 0) {
+        return nullptr;
+    }
+
+    lightData_.resize(lightData_.size() + count * kLightFloats, 0.0f);
+    return lightData_.data() + (size_t)firstLight * kLightFloats;
 }
 
 // ============================================================================
@@ -56,29 +265,49 @@ void DrawList::addCommand(const SetCustomShaderCommand& cmd) {
 // ============================================================================
 
 uint32_t DrawList::addVertex2D(const Vertex2D& vertex) {
-    uint32_t offset = static_cast<uint32_t>(vertices2D_.size());
-    vertices2D_.push_back(vertex);
-    return offset;
+    return addVertices2D(&vertex, 1);
 }
 
 uint32_t DrawList::addVertices2D(const Vertex2D* vertices, size_t count) {
+    uint32_t offset = static_cast<uint32_t>(getVertex2DCount());
     if (count == 0 || vertices == nullptr) {
-        return static_cast<uint32_t>(vertices2D_.size());
+        return offset;
+    }
+
+    if (mapped_.vertices2D) {
+        if (mappedCount2D_ + count <= mapped_.capacity2D) {
+            std::memcpy(mapped_.vertices2D + mappedCount2D_, vertices, count * sizeof(Vertex2D));
+            mappedCount2D_ += count;
+            return offset;
+        }
+        spillMappedStorage();
     }
 
-    uint32_t offset = static_cast<uint32_t>(vertices2D_.size());
     vertices2D_.insert(vertices2D_.end(), vertices, vertices + count);
     return offset;
 }
 
 uint32_t DrawList::addVertices2D(const std::vector<Vertex2D>& vertices) {
-    if (vertices.empty()) {
-        return static_cast<uint32_t>(vertices2D_.size());
+    return addVertices2D(vertices.data(), vertices.size());
+}
+
+Vertex2D* DrawList::allocateVertices2D(size_t count, uint32_t& offset) {
+    offset = static_cast<uint32_t>(getVertex2DCount());
+    if (count == 0) {
+        return nullptr;
     }
 
-    uint32_t offset = static_cast<uint32_t>(vertices2D_.size());
-    vertices2D_.insert(vertices2D_.end(), vertices.begin(), vertices.end());
-    return offset;
+    if (mapped_.vertices2D) {
+        if (mappedCount2D_ + count <= mapped_.capacity2D) {
+            Vertex2D* out = mapped_.vertices2D + mappedCount2D_;
+            mappedCount2D_ += count;
+            return out;
+        }
+        spillMappedStorage();
+    }
+
+    vertices2D_.resize(vertices2D_.size() + count);
+    return vertices2D_.data() + offset;
 }
 
 // ============================================================================
@@ -86,29 +315,49 @@ uint32_t DrawList::addVertices2D(const std::vector<Vertex2D>& vertices) {
 // ============================================================================
 
 uint32_t DrawList::addVertex3D(const Vertex3D& vertex) {
-    uint32_t offset = static_cast<uint32_t>(vertices3D_.size());
-    vertices3D_.push_back(vertex);
-    return offset;
+    return addVertices3D(&vertex, 1);
 }
 
 uint32_t DrawList::addVertices3D(const Vertex3D* vertices, size_t count) {
+    uint32_t offset = static_cast<uint32_t>(getVertex3DCount());
     if (count == 0 || vertices == nullptr) {
-        return static_cast<uint32_t>(vertices3D_.size());
+        return offset;
+    }
+
+    if (mapped_.vertices2D) {
+        if (mappedCount3D_ + count <= mapped_.capacity3D) {
+            std::memcpy(mapped_.vertices3D + mappedCount3D_, vertices, count * sizeof(Vertex3D));
+            mappedCount3D_ += count;
+            return offset;
+        }
+        spillMappedStorage();
     }
 
-    uint32_t offset = static_cast<uint32_t>(vertices3D_.size());
     vertices3D_.insert(vertices3D_.end(), vertices, vertices + count);
     return offset;
 }
 
 uint32_t DrawList::addVertices3D(const std::vector<Vertex3D>& vertices) {
-    if (vertices.empty()) {
-        return static_cast<uint32_t>(vertices3D_.size());
+    return addVertices3D(vertices.data(), vertices.size());
+}
+
+Vertex3D* DrawList::allocateVertices3D(size_t count, uint32_t& offset) {
+    offset = static_cast<uint32_t>(getVertex3DCount());
+    if (count == 0) {
+        return nullptr;
     }
 
-    uint32_t offset = static_cast<uint32_t>(vertices3D_.size());
-    vertices3D_.insert(vertices3D_.end(), vertices.begin(), vertices.end());
-    return offset;
+    if (mapped_.vertices2D) {
+        if (mappedCount3D_ + count <= mapped_.capacity3D) {
+            Vertex3D* out = mapped_.vertices3D + mappedCount3D_;
+            mappedCount3D_ += count;
+            return out;
+        }
+        spillMappedStorage();
+    }
+
+    vertices3D_.resize(vertices3D_.size() + count);
+    return vertices3D_.data() + offset;
 }
 
 // ============================================================================
@@ -116,42 +365,275 @@ uint32_t DrawList::addVertices3D(const std::vector<Vertex3D>& vertices) {
 // ============================================================================
 
 uint32_t DrawList::addIndex(uint32_t index) {
-    uint32_t offset = static_cast<uint32_t>(indices_.size());
-    indices_.push_back(index);
-    return offset;
+    return addIndices(&index, 1);
 }
 
 uint32_t DrawList::addIndices(const uint32_t* indices, size_t count) {
+    uint32_t offset = static_cast<uint32_t>(getIndexCount());
     if (count == 0 || indices == nullptr) {
-        return static_cast<uint32_t>(indices_.size());
+        return offset;
+    }
+
+    if (mapped_.vertices2D) {
+        if (mappedIndexCount_ + count <= mapped_.capacityIndices) {
+            std::memcpy(mapped_.indices + mappedIndexCount_, indices, count * sizeof(uint32_t));
+            mappedIndexCount_ += count;
+            return offset;
+        }
+        spillMappedStorage();
     }
 
-    uint32_t offset = static_cast<uint32_t>(indices_.size());
     indices_.insert(indices_.end(), indices, indices + count);
     return offset;
 }
 
 uint32_t DrawList::addIndices(const std::vector<uint32_t>& indices) {
-    if (indices.empty()) {
-        return static_cast<uint32_t>(indices_.size());
+    return addIndices(indices.data(), indices.size());
+}
+
+uint32_t* DrawList::allocateIndices(size_t count, uint32_t& offset) {
+    offset = static_cast<uint32_t>(getIndexCount());
+    if (count == 0) {
+        return nullptr;
+    }
+
+    if (mapped_.vertices2D) {
+        if (mappedIndexCount_ + count <= mapped_.capacityIndices) {
+            uint32_t* out = mapped_.indices + mappedIndexCount_;
+            mappedIndexCount_ += count;
+            return out;
+        }
+        spillMappedStorage();
+    }
+
+    indices_.resize(indices_.size() + count);
+    return indices_.data() + offset;
+}
+
+// ============================================================================
+// In-Place Geometry
+// ============================================================================
+
+DrawList::GeometryAllocation<Vertex2D> DrawList::allocateGeometry2D(size_t vertexCount, size_t indexCount) {
+    // Spill first if the mapping can't take both, so neither range moves
+    if (mapped_.vertices2D && (mappedCount2D_ + vertexCount > mapped_.capacity2D ||
+                               mappedIndexCount_ + indexCount > mapped_.capacityIndices)) {
+        spillMappedStorage();
+    }
+
+    GeometryAllocation<Vertex2D> geometry;
+    geometry.vertices = allocateVertices2D(vertexCount, geometry.vertexOffset);
+    geometry.indices = allocateIndices(indexCount, geometry.indexOffset);
+    return geometry;
+}
+
+DrawList::GeometryAllocation<Vertex3D> DrawList::allocateGeometry3D(size_t vertexCount, size_t indexCount) {
+    if (mapped_.vertices2D && (mappedCount3D_ + vertexCount > mapped_.capacity3D ||
+                               mappedIndexCount_ + indexCount > mapped_.capacityIndices)) {
+        spillMappedStorage();
+    }
+
+    GeometryAllocation<Vertex3D> geometry;
+    geometry.vertices = allocateVertices3D(vertexCount, geometry.vertexOffset);
+    geometry.indices = allocateIndices(indexCount, geometry.indexOffset);
+    return geometry;
+}
+
+// ============================================================================
+// Instance Management
+// ============================================================================
+
+uint32_t DrawList::addInstances(const InstanceData* instances, size_t count) {
+    uint32_t offset = static_cast<uint32_t>(instances_.size());
+    if (count == 0 || instances == nullptr) {
+        return offset;
+    }
+
+    instances_.insert(instances_.end(), instances, instances + count);
+    return offset;
+}
+
+// ============================================================================
+// Shape Management
+// ============================================================================
+
+uint32_t DrawList::addShapes(const ShapeInstance2D* shapes, size_t count) {
+    uint32_t offset = static_cast<uint32_t>(shapes_.size());
+    if (count == 0 || shapes == nullptr) {
+        return offset;
     }
 
-    uint32_t offset = static_cast<uint32_t>(indices_.size());
-    indices_.insert(indices_.end(), indices.begin(), indices.end());
+    shapes_.insert(shapes_.end(), shapes, shapes + count);
     return offset;
 }
 
+ShapeInstance2D* DrawList::allocateShapes(size_t count, uint32_t& offset) {
+    offset = static_cast<uint32_t>(shapes_.size());
+    if (count == 0) {
+        return nullptr;
+    }
+
+    shapes_.resize(shapes_.size() + count);
+    return shapes_.data() + offset;
+}
+
+// ============================================================================
+// Stroke Management
+// ============================================================================
+
+uint32_t DrawList::addStrokeSegments(const StrokeSegment2D* segments, size_t count) {
+    uint32_t offset = static_cast<uint32_t>(strokeSegments_.size());
+    if (count == 0 || segments == nullptr) {
+        return offset;
+    }
+
+    strokeSegments_.insert(strokeSegments_.end(), segments, segments + count);
+    return offset;
+}
+
+StrokeSegment2D* DrawList::allocateStrokeSegments(size_t count, uint32_t& offset) {
+    offset = static_cast<uint32_t>(strokeSegments_.size());
+    if (count == 0) {
+        return nullptr;
+    }
+
+    strokeSegments_.resize(strokeSegments_.size() + count);
+    return strokeSegments_.data() + offset;
+}
+
+// ============================================================================
+// Path Management
+// ============================================================================
+
+uint32_t DrawList::addPaths(const PathInstance2D* paths, size_t count) {
+    uint32_t offset = static_cast<uint32_t>(paths_.size());
+    if (count == 0 || paths == nullptr) {
+        return offset;
+    }
+
+    paths_.insert(paths_.end(), paths, paths + count);
+    return offset;
+}
+
+PathSegment2D* DrawList::allocatePathSegments(size_t count, uint32_t& offset) {
+    offset = static_cast<uint32_t>(pathSegments_.size());
+    if (count == 0) {
+        return nullptr;
+    }
+
+    pathSegments_.resize(pathSegments_.size() + count);
+    return pathSegments_.data() + offset;
+}
+
+// ============================================================================
+// Uniform Snapshots
+// ============================================================================
+
+uint32_t DrawList::addUniformData(const void* data, size_t size) {
+    const size_t offset = (uniformData_.size() + kUniformAlignment - 1) & ~(kUniformAlignment - 1);
+    if (size == 0 || data == nullptr) {
+        return static_cast<uint32_t>(offset);
+    }
+
+    uniformData_.resize(offset + size);
+    std::memcpy(uniformData_.data() + offset, data, size);
+    return static_cast<uint32_t>(offset);
+}
+
+bool DrawList::updateUniformData(uint32_t offset, size_t byteOffset, const void* data, size_t size) {
+    if (!data || (size_t)offset + byteOffset + size > uniformData_.size()) {
+        return false;
+    }
+
+    std::memcpy(uniformData_.data() + offset + byteOffset, data, size);
+    return true;
+}
+
+// ============================================================================
+// Mapped Storage (zero-copy upload)
+// ============================================================================
+
+bool DrawList::bindMappedStorage(const MappedStorage& storage) {
+    if (!storage.vertices2D || !storage.vertices3D || !storage.indices) {
+        return false;
+    }
+
+    // Anything recorded before the mapping was available must fit as well
+    if (mapped_.vertices2D ||
+        vertices2D_.size() > storage.capacity2D ||
+        vertices3D_.size() > storage.capacity3D ||
+        indices_.size() > storage.capacityIndices) {
+        return false;
+    }
+
+    mapped_ = storage;
+    mappedCount2D_ = vertices2D_.size();
+    mappedCount3D_ = vertices3D_.size();
+    mappedIndexCount_ = indices_.size();
+    mappedOverflow_ = false;
+
+    if (mappedCount2D_) {
+        std::memcpy(mapped_.vertices2D, vertices2D_.data(), mappedCount2D_ * sizeof(Vertex2D));
+    }
+    if (mappedCount3D_) {
+        std::memcpy(mapped_.vertices3D, vertices3D_.data(), mappedCount3D_ * sizeof(Vertex3D));
+    }
+    if (mappedIndexCount_) {
+        std::memcpy(mapped_.indices, indices_.data(), mappedIndexCount_ * sizeof(uint32_t));
+    }
+    vertices2D_.clear();
+    vertices3D_.clear();
+    indices_.clear();
+    return true;
+}
+
+void DrawList::spillMappedStorage() {
+    vertices2D_.assign(mapped_.vertices2D, mapped_.vertices2D + mappedCount2D_);
+    vertices3D_.assign(mapped_.vertices3D, mapped_.vertices3D + mappedCount3D_);
+    indices_.assign(mapped_.indices, mapped_.indices + mappedIndexCount_);
+
+    mapped_ = MappedStorage();
+    mappedCount2D_ = 0;
+    mappedCount3D_ = 0;
+    mappedIndexCount_ = 0;
+    mappedOverflow_ = true;
+}
+
 // ============================================================================
 // Lifecycle Management
 // ============================================================================
 
 void DrawList::reset() {
     commands_.clear();
+    lightingStates_.clear();
+    lightData_.clear();
+    shadowStates_.clear();
+    textureBatches_.clear();
     vertices2D_.clear();
     vertices3D_.clear();
+    packedVertices2D_.clear();
+    packedVertices3D_.clear();
     indices_.clear();
+    instances_.clear();
+    shapes_.clear();
+    strokeSegments_.clear();
+    paths_.clear();
+    pathSegments_.clear();
+    uniformData_.clear();
+    arena_.reset();
+    mapped_ = MappedStorage();
+    mappedCount2D_ = 0;
+    mappedCount3D_ = 0;
+    mappedIndexCount_ = 0;
+    mappedOverflow_ = false;
     batchCount_ = 0;
     originalCommandCount_ = 0;
+    coalescedCommandCount_ = 0;
+    packedCommandCount_ = 0;
+    culledDrawCount_ = 0;
+    orderedRanges_.clear();
+    openOrderedRegions_.clear();
+    generation_++;
 }
 
 // ============================================================================
@@ -178,12 +660,23 @@ bool DrawList::matricesEqual3x3(const simd_float3x3& a, const simd_float3x3& b)
     return true;
 }
 
-bool DrawList::canBatch2D(const DrawCommand2D& a, const DrawCommand2D& b) const {
-    // Can only batch if all render state matches
+// Strips can't be concatenated without connecting the last and first primitive
+static bool isListPrimitive(PrimitiveType type) {
+    return type != PrimitiveType::LineStrip && type != PrimitiveType::TriangleStrip;
+}
+
+bool DrawList::canBatch2D(const DrawCommand2D& a, const DrawCommand2D& b,
+                          bool compareTransform, bool compareTexture) const {
+    // Can only batch if all render state matches; without compareTexture
+    // both sides must still agree on being textured (different pipelines)
     if (a.primitiveType != b.primitiveType) return false;
+    if (!isListPrimitive(a.primitiveType)) return false;
     if (a.blendMode != b.blendMode) return false;
-    if (a.texture != b.texture) return false;
-    if (!matricesEqual(a.transform, b.transform)) return false;
+    if (a.vertexFormat != b.vertexFormat) return false;
+    if (compareTexture ? a.texture != b.texture : (a.texture == nullptr) != (b.texture == nullptr)) return false;
+    if (a.texture && a.samplerKey != b.samplerKey) return false;
+    if (a.distanceField != b.distanceField) return false;
+    if (compareTransform && !matricesEqual(a.transform, b.transform)) return false;
 
     // Both must use indices or both must not use indices
     bool aHasIndices = (a.indexCount > 0);
@@ -204,8 +697,14 @@ bool DrawList::canBatch2D(const DrawCommand2D& a, const DrawCommand2D& b) const
 bool DrawList::canBatch3D(const DrawCommand3D& a, const DrawCommand3D& b) const {
     // Can only batch if all render state matches
     if (a.primitiveType != b.primitiveType) return false;
+    if (!isListPrimitive(a.primitiveType)) return false;
     if (a.blendMode != b.blendMode) return false;
+    if (a.vertexFormat != b.vertexFormat) return false;
+    if (a.vertexBuffer || b.vertexBuffer) return false;   // Resident ranges aren't in the streams
     if (a.texture != b.texture) return false;
+    if (a.texture && a.samplerKey != b.samplerKey) return false;
+    if (a.useLighting != b.useLighting) return false;
+    if (a.useLighting && a.lightingHandle != b.lightingHandle) return false;
     if (!matricesEqual(a.modelViewMatrix, b.modelViewMatrix)) return false;
     if (!matricesEqual(a.projectionMatrix, b.projectionMatrix)) return false;
     if (!matricesEqual3x3(a.normalMatrix, b.normalMatrix)) return false;
@@ -214,6 +713,8 @@ bool DrawList::canBatch3D(const DrawCommand3D& a, const DrawCommand3D& b) const
     if (a.depthTestEnabled != b.depthTestEnabled) return false;
     if (a.depthWriteEnabled != b.depthWriteEnabled) return false;
     if (a.cullBackFace != b.cullBackFace) return false;
+    if (a.orderIndependent != b.orderIndependent) return false;
+    if (a.objectId != b.objectId) return false;
 
     // Both must use indices or both must not use indices
     bool aHasIndices = (a.indexCount > 0);
@@ -231,69 +732,659 @@ bool DrawList::canBatch3D(const DrawCommand3D& a, const DrawCommand3D& b) const
     return true;
 }
 
+bool DrawList::canBatchMeshPrimitives(const DrawMeshPrimitivesCommand& a,
+                                      const DrawMeshPrimitivesCommand& b) const {
+    // Same surface at the same resolution, then the instanced rules
+    if (a.primitive != b.primitive || a.resolution != b.resolution) return false;
+    return canBatchInstanced(a, b);
+}
+
+bool DrawList::canBatchInstanced(const DrawCommand3DInstanced& a,
+                                 const DrawCommand3DInstanced& b) const {
+    // Same geometry drawn for the next run of instances in the same buffer
+    if (a.instanceBuffer != b.instanceBuffer) return false;
+    if (a.instanceOffset + a.instanceCount != b.instanceOffset) return false;
+    if (a.vertexOffset != b.vertexOffset || a.vertexCount != b.vertexCount) return false;
+    if (a.vertexFormat != b.vertexFormat) return false;
+    if (a.indexOffset != b.indexOffset || a.indexCount != b.indexCount) return false;
+    if (a.vertexBuffer != b.vertexBuffer || a.indexBuffer != b.indexBuffer) return false;
+
+    // All render state and uniforms must match
+    if (a.primitiveType != b.primitiveType) return false;
+    if (a.blendMode != b.blendMode) return false;
+    if (a.texture != b.texture) return false;
+    if (a.texture && a.samplerKey != b.samplerKey) return false;
+    if (a.useLighting != b.useLighting) return false;
+    if (a.useLighting && a.lightingHandle != b.lightingHandle) return false;
+    if (!matricesEqual(a.modelViewMatrix, b.modelViewMatrix)) return false;
+    if (!matricesEqual(a.projectionMatrix, b.projectionMatrix)) return false;
+    if (!matricesEqual3x3(a.normalMatrix, b.normalMatrix)) return false;
+    if (a.depthTestEnabled != b.depthTestEnabled) return false;
+    if (a.depthWriteEnabled != b.depthWriteEnabled) return false;
+    if (a.orderIndependent != b.orderIndependent) return false;
+    if (a.objectId != b.objectId) return false;
+    return a.cullBackFace == b.cullBackFace;
+}
+
+bool DrawList::canBatchShapes(const DrawCommand2DShapes& a,
+                              const DrawCommand2DShapes& b) const {
+    // The next run of the shape stream under the same state
+    if (a.shapeOffset + a.shapeCount != b.shapeOffset) return false;
+    if (a.blendMode != b.blendMode) return false;
+    return matricesEqual(a.transform, b.transform);
+}
+
+bool DrawList::canBatchStroke(const DrawCommand2DStroke& a,
+                              const DrawCommand2DStroke& b) const {
+    // The next run of the stroke stream under the same state
+    if (a.segmentOffset + a.segmentCount != b.segmentOffset) return false;
+    if (a.blendMode != b.blendMode) return false;
+    return matricesEqual(a.transform, b.transform);
+}
+
+bool DrawList::canBatchPaths(const DrawCommand2DPaths& a,
+                             const DrawCommand2DPaths& b) const {
+    // The next run of the path stream under the same state
+    if (a.pathOffset + a.pathCount != b.pathOffset) return false;
+    if (a.blendMode != b.blendMode) return false;
+    return matricesEqual(a.transform, b.transform);
+}
+
+bool DrawList::canAppendTexture(const DrawCommand2D& batch, const DrawCommand2D& next) const {
+    if (batch.textureBatch == kInvalidTextureBatch) {
+        // A new batch starts with two textures and two ranges at most
+        return textureBatches_.size() < kInvalidTextureBatch;
+    }
+    const TextureBatch2D& textures = textureBatches_[batch.textureBatch];
+    for (uint32_t slot = 0; slot < textures.textureCount; slot++) {
+        if (textures.textures[slot] == next.texture) {
+            return slot == textures.slot[textures.rangeCount - 1] ||
+                   textures.rangeCount < TextureBatch2D::kMaxRanges;
+        }
+    }
+    return textures.textureCount < TextureBatch2D::kMaxTextures &&
+           textures.rangeCount < TextureBatch2D::kMaxRanges;
+}
+
+void DrawList::appendTexture(DrawCommand2D& batch, const DrawCommand2D& next) {
+    // Called before batch's counts grow by next's
+    if (batch.textureBatch == kInvalidTextureBatch) {
+        TextureBatch2D textures;
+        textures.textures[0] = batch.texture;
+        textures.textureCount = 1;
+        textures.rangeCount = 1;
+        textures.vertexEnd[0] = batch.vertexCount;
+        textures.indexEnd[0] = batch.indexCount;
+        textures.slot[0] = 0;
+        batch.textureBatch = static_cast<uint16_t>(textureBatches_.size());
+        textureBatches_.push_back(textures);
+    }
+
+    TextureBatch2D& textures = textureBatches_[batch.textureBatch];
+    uint32_t slot = 0;
+    while (slot < textures.textureCount && textures.textures[slot] != next.texture) {
+        slot++;
+    }
+    if (slot == textures.textureCount) {
+        textures.textures[textures.textureCount++] = next.texture;
+    }
+
+    // Same texture as the last range: extend it
+    uint32_t range = textures.rangeCount - 1;
+    if (textures.slot[range] != slot) {
+        range = textures.rangeCount++;
+        textures.slot[range] = static_cast<uint8_t>(slot);
+    }
+    textures.vertexEnd[range] = batch.vertexCount + next.vertexCount;
+    textures.indexEnd[range] = batch.indexCount + next.indexCount;
+}
+
+bool DrawList::canBakeTransform2D(const DrawCommand2D& cmd) const {
+    if (cmd.vertexCount > bakeMaxVertices_ || cmd.vertexFormat != VertexFormat::Float) {
+        return false;
+    }
+
+    // Only XY affine transforms: baking must not change z/w of the result
+    const simd_float4x4& m = cmd.transform;
+    return m.columns[0].z == 0.0f && m.columns[0].w == 0.0f &&
+           m.columns[1].z == 0.0f && m.columns[1].w == 0.0f &&
+           m.columns[3].z == 0.0f && m.columns[3].w == 1.0f;
+}
+
+void DrawList::bakeTransform2D(DrawCommand2D& cmd) {
+    Vertex2D* vertices = mapped_.vertices2D ? mapped_.vertices2D : vertices2D_.data();
+    const simd_float4x4& m = cmd.transform;
+    const simd_float2 col0 = simd_make_float2(m.columns[0].x, m.columns[0].y);
+    const simd_float2 col1 = simd_make_float2(m.columns[1].x, m.columns[1].y);
+    const simd_float2 col3 = simd_make_float2(m.columns[3].x, m.columns[3].y);
+
+    Vertex2D* v = vertices + cmd.vertexOffset;
+    for (uint32_t i = 0; i < cmd.vertexCount; i++) {
+        v[i].position = col0 * v[i].position.x + col1 * v[i].position.y + col3;
+    }
+    cmd.transform = matrix_identity_float4x4;
+    bakedCommandCount_++;
+}
+
+void DrawList::rebaseIndices(uint32_t indexOffset, uint32_t indexCount, uint32_t delta) {
+    uint32_t* indices = mapped_.indices ? mapped_.indices : indices_.data();
+    for (uint32_t i = 0; i < indexCount; i++) {
+        indices[indexOffset + i] += delta;
+    }
+}
+
 void DrawList::optimize() {
     if (commands_.empty()) {
         return;
     }
+    OF_PROFILE_SCOPE("DrawList::optimize");
 
     originalCommandCount_ = commands_.size();
     batchCount_ = 0;
+    bakedCommandCount_ = 0;
+    packedCommandCount_ = 0;
+
+    // Fewer passes first: merged passes let draws batch across former breaks
+    coalescedCommandCount_ = coalescePasses();
 
-    std::vector<DrawCommand> optimized;
-    optimized.reserve(commands_.size());
+    CommandStream optimized;
+    optimized.reserve(commands_.size(), commands_.byteSize());
 
     size_t i = 0;
     while (i < commands_.size()) {
-        DrawCommand cmd = commands_[i];
+        CommandRef ref = commands_[i];
 
         // Try to batch consecutive draw commands
-        if (cmd.type == CommandType::Draw2D) {
+        if (ref.type == CommandType::Draw2D) {
+            DrawCommand2D cmd = ref.as<DrawCommand2D>();
+
             // Look ahead and merge consecutive batchable 2D draws
             size_t j = i + 1;
             while (j < commands_.size() && commands_[j].type == CommandType::Draw2D) {
-                if (canBatch2D(cmd.draw2D, commands_[j].draw2D)) {
-                    // Merge command j into cmd
-                    cmd.draw2D.vertexCount += commands_[j].draw2D.vertexCount;
-                    if (cmd.draw2D.indexCount > 0) {
-                        cmd.draw2D.indexCount += commands_[j].draw2D.indexCount;
+                DrawCommand2D next = commands_[j].as<DrawCommand2D>();
+
+                // Different textures (or an existing texture batch) need a
+                // free slot and range in the batch; the batch shader samples
+                // color, so distance fields draw a texture per command
+                const bool textureRange = cmd.textureBatch != kInvalidTextureBatch ||
+                                          cmd.texture != next.texture;
+                const bool textureOK = !textureRange ||
+                                       (batchTextures_ && !cmd.distanceField &&
+                                        next.textureBatch == kInvalidTextureBatch &&
+                                        canAppendTexture(cmd, next));
+                bool mergeable = textureOK && canBatch2D(cmd, next, true, false);
+
+                // Different transforms: bake both sides into world space
+                if (!mergeable && textureOK && bakeTransforms_ && canBatch2D(cmd, next, false, false)) {
+                    bool cmdIdentity = matricesEqual(cmd.transform, matrix_identity_float4x4);
+                    bool nextIdentity = matricesEqual(next.transform, matrix_identity_float4x4);
+                    if ((cmdIdentity || canBakeTransform2D(cmd)) &&
+                        (nextIdentity || canBakeTransform2D(next))) {
+                        if (!cmdIdentity) bakeTransform2D(cmd);
+                        if (!nextIdentity) bakeTransform2D(next);
+                        mergeable = true;
+                    }
+                }
+
+                if (mergeable) {
+                    if (textureRange) {
+                        appendTexture(cmd, next);
                     }
+
+                    // Merge command j into cmd; its indices are relative to its own
+                    // vertexOffset and must be rebased onto the merged command's
+                    if (cmd.indexCount > 0) {
+                        rebaseIndices(next.indexOffset, next.indexCount,
+                                      next.vertexOffset - cmd.vertexOffset);
+                        cmd.indexCount += next.indexCount;
+                    }
+                    cmd.vertexCount += next.vertexCount;
                     batchCount_++;
                     j++;
                 } else {
                     break;
                 }
             }
-            optimized.push_back(cmd);
+            optimized.push(cmd);
             i = j;
         }
-        else if (cmd.type == CommandType::Draw3D) {
+        else if (ref.type == CommandType::Draw3D) {
+            DrawCommand3D cmd = ref.as<DrawCommand3D>();
+
             // Look ahead and merge consecutive batchable 3D draws
             size_t j = i + 1;
             while (j < commands_.size() && commands_[j].type == CommandType::Draw3D) {
-                if (canBatch3D(cmd.draw3D, commands_[j].draw3D)) {
-                    // Merge command j into cmd
-                    cmd.draw3D.vertexCount += commands_[j].draw3D.vertexCount;
-                    if (cmd.draw3D.indexCount > 0) {
-                        cmd.draw3D.indexCount += commands_[j].draw3D.indexCount;
+                const DrawCommand3D& next = commands_[j].as<DrawCommand3D>();
+                if (canBatch3D(cmd, next)) {
+                    // Merge command j into cmd (rebasing its local indices)
+                    if (cmd.indexCount > 0) {
+                        rebaseIndices(next.indexOffset, next.indexCount,
+                                      next.vertexOffset - cmd.vertexOffset);
+                        cmd.indexCount += next.indexCount;
                     }
+                    cmd.vertexCount += next.vertexCount;
                     batchCount_++;
                     j++;
                 } else {
                     break;
                 }
             }
-            optimized.push_back(cmd);
+            optimized.push(cmd);
+            i = j;
+        }
+        else if (ref.type == CommandType::Draw3DInstanced) {
+            DrawCommand3DInstanced cmd = ref.as<DrawCommand3DInstanced>();
+
+            // Consecutive instance ranges of the same mesh become one draw
+            size_t j = i + 1;
+            while (j < commands_.size() && commands_[j].type == CommandType::Draw3DInstanced &&
+                   canBatchInstanced(cmd, commands_[j].as<DrawCommand3DInstanced>())) {
+                cmd.instanceCount += commands_[j].as<DrawCommand3DInstanced>().instanceCount;
+                batchCount_++;
+                j++;
+            }
+            optimized.push(cmd);
+            i = j;
+        }
+        else if (ref.type == CommandType::DrawMeshPrimitives) {
+            DrawMeshPrimitivesCommand cmd = ref.as<DrawMeshPrimitivesCommand>();
+
+            // Consecutive instances of the same primitive become one draw
+            size_t j = i + 1;
+            while (j < commands_.size() && commands_[j].type == CommandType::DrawMeshPrimitives &&
+                   canBatchMeshPrimitives(cmd, commands_[j].as<DrawMeshPrimitivesCommand>())) {
+                cmd.instanceCount += commands_[j].as<DrawMeshPrimitivesCommand>().instanceCount;
+                batchCount_++;
+                j++;
+            }
+            optimized.push(cmd);
+            i = j;
+        }
+        else if (ref.type == CommandType::Draw2DShapes) {
+            DrawCommand2DShapes cmd = ref.as<DrawCommand2DShapes>();
+
+            // Consecutive shape ranges become one instanced quad draw
+            size_t j = i + 1;
+            while (j < commands_.size() && commands_[j].type == CommandType::Draw2DShapes &&
+                   canBatchShapes(cmd, commands_[j].as<DrawCommand2DShapes>())) {
+                cmd.shapeCount += commands_[j].as<DrawCommand2DShapes>().shapeCount;
+                batchCount_++;
+                j++;
+            }
+            optimized.push(cmd);
+            i = j;
+        }
+        else if (ref.type == CommandType::Draw2DStroke) {
+            DrawCommand2DStroke cmd = ref.as<DrawCommand2DStroke>();
+
+            // Segments of consecutive strokes (many polylines) share one draw
+            size_t j = i + 1;
+            while (j < commands_.size() && commands_[j].type == CommandType::Draw2DStroke &&
+                   canBatchStroke(cmd, commands_[j].as<DrawCommand2DStroke>())) {
+                cmd.segmentCount += commands_[j].as<DrawCommand2DStroke>().segmentCount;
+                batchCount_++;
+                j++;
+            }
+            optimized.push(cmd);
+            i = j;
+        }
+        else if (ref.type == CommandType::Draw2DPaths) {
+            DrawCommand2DPaths cmd = ref.as<DrawCommand2DPaths>();
+
+            // Consecutive path fills share one instanced draw
+            size_t j = i + 1;
+            while (j < commands_.size() && commands_[j].type == CommandType::Draw2DPaths &&
+                   canBatchPaths(cmd, commands_[j].as<DrawCommand2DPaths>())) {
+                cmd.pathCount += commands_[j].as<DrawCommand2DPaths>().pathCount;
+                batchCount_++;
+                j++;
+            }
+            optimized.push(cmd);
             i = j;
         }
         else {
             // Non-draw commands are not batched (viewport, scissor, clear, etc.)
-            optimized.push_back(cmd);
+            optimized.push(ref);
             i++;
         }
     }
 
-    // Replace commands with optimized version
-    commands_ = std::move(optimized);
+    // Replace commands with optimized version (indices no longer match the
+    // ordered regions, which only matter to reorderForState())
+    commands_.swap(optimized);
+    orderedRanges_.clear();
+    openOrderedRegions_.clear();
+
+    // Last: merging above needs the float ranges to stay adjacent
+    if (compressVertices_ && !isMapped()) {
+        packVertices();
+    }
+}
+
+// ============================================================================
+// Vertex Compression
+// ============================================================================
+
+namespace {
+
+// Encodings decoded by the *Packed vertex shaders (Common.h)
+uint32_t packUnorm16x2(simd_float2 v) {
+    const uint32_t x = (uint32_t)(std::clamp(v.x, 0.0f, 1.0f) * 65535.0f + 0.5f);
+    const uint32_t y = (uint32_t)(std::clamp(v.y, 0.0f, 1.0f) * 65535.0f + 0.5f);
+    return x | (y << 16);
+}
+
+uint32_t packSnorm16x2(float x, float y) {
+    auto snorm = [](float v) {
+        const float scaled = std::clamp(v, -1.0f, 1.0f) * 32767.0f;
+        return (uint32_t)(uint16_t)(int16_t)(scaled + (scaled < 0.0f ? -0.5f : 0.5f));
+    };
+    return snorm(x) | (snorm(y) << 16);
+}
+
+uint32_t packUnorm8x4(simd_float4 c) {
+    auto unorm = [](float v) { return (uint32_t)(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    return unorm(c.x) | (unorm(c.y) << 8) | (unorm(c.z) << 16) | (unorm(c.w) << 24);
+}
+
+PackedVertex2D packVertex(const Vertex2D& v) {
+    PackedVertex2D packed;
+    packed.position = v.position;
+    packed.texCoord = packUnorm16x2(v.texCoord);
+    packed.color = packUnorm8x4(v.color);
+    return packed;
+}
+
+PackedVertex3D packVertex(const Vertex3D& v) {
+    PackedVertex3D packed;
+    packed.position[0] = v.position.x;
+    packed.position[1] = v.position.y;
+    packed.position[2] = v.position.z;
+    packed.normalXY = packSnorm16x2(v.normal.x, v.normal.y);
+    packed.normalZ = packSnorm16x2(v.normal.z, 0.0f);
+    packed.texCoord = packUnorm16x2(v.texCoord);
+    packed.color = packUnorm8x4(v.color);
+    return packed;
+}
+
+// Range checks fail for NaN as well
+bool inUnitRange(float v) { return v >= 0.0f && v <= 1.0f; }
+bool inSignedUnitRange(float v) { return v >= -1.0f && v <= 1.0f; }
+
+bool colorFits(simd_float4 c) {
+    return inUnitRange(c.x) && inUnitRange(c.y) && inUnitRange(c.z) && inUnitRange(c.w);
+}
+
+bool texCoordFits(simd_float2 uv) {
+    return inUnitRange(uv.x) && inUnitRange(uv.y);
+}
+
+// Key of a source vertex range; draws of one unit mesh share a range
+uint64_t rangeKey(uint32_t offset, uint32_t count) {
+    return ((uint64_t)offset << 32) | count;
+}
+
+// Append src[offset, offset + count) to dst once per distinct range
+template <typename Dst, typename Src, typename Convert>
+uint32_t relocateRange(std::unordered_map<uint64_t, uint32_t>& moved, std::vector<Dst>& dst,
+                       const Src* src, uint32_t offset, uint32_t count, Convert convert) {
+    auto it = moved.find(rangeKey(offset, count));
+    if (it != moved.end()) {
+        return it->second;
+    }
+    const uint32_t target = static_cast<uint32_t>(dst.size());
+    for (uint32_t i = 0; i < count; ++i) {
+        dst.push_back(convert(src[offset + i]));
+    }
+    moved.emplace(rangeKey(offset, count), target);
+    return target;
+}
+
+} // namespace
+
+bool DrawList::canPack2D(const DrawCommand2D& cmd, const Vertex2D* vertices) const {
+    // Untextured draws never read their texture coordinates
+    const bool textured = cmd.texture || cmd.textureBatch != kInvalidTextureBatch;
+    const Vertex2D* v = vertices + cmd.vertexOffset;
+    for (uint32_t i = 0; i < cmd.vertexCount; i++) {
+        if (!colorFits(v[i].color) || (textured && !texCoordFits(v[i].texCoord))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DrawList::canPack3D(const DrawCommand3D& cmd, const Vertex3D* vertices) const {
+    // Normals only matter to the lit shaders
+    const bool textured = cmd.texture != nullptr;
+    const Vertex3D* v = vertices + cmd.vertexOffset;
+    for (uint32_t i = 0; i < cmd.vertexCount; i++) {
+        if (!colorFits(v[i].color) || (textured && !texCoordFits(v[i].texCoord))) {
+            return false;
+        }
+        if (cmd.useLighting && !(inSignedUnitRange(v[i].normal.x) && inSignedUnitRange(v[i].normal.y) &&
+                                 inSignedUnitRange(v[i].normal.z))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DrawList::packVertices() {
+    // Every range is rewritten below; a bad one would leave its command
+    // pointing into the discarded streams, so such lists stay as recorded
+    for (CommandRef ref : commands_) {
+        if (ref.type == CommandType::Draw2D) {
+            const DrawCommand2D& cmd = ref.as<DrawCommand2D>();
+            const size_t size = cmd.vertexFormat == VertexFormat::Packed ? packedVertices2D_.size()
+                                                                         : vertices2D_.size();
+            if ((size_t)cmd.vertexOffset + cmd.vertexCount > size) {
+                return;
+            }
+        } else if (ref.type == CommandType::Draw3D || ref.type == CommandType::Draw3DInstanced ||
+                   ref.type == CommandType::Draw3DIndirect) {
+            const DrawCommand3D& cmd = ref.as<DrawCommand3D>();
+            const size_t size = cmd.vertexFormat == VertexFormat::Packed ? packedVertices3D_.size()
+                                                                         : vertices3D_.size();
+            if (!cmd.vertexBuffer && (size_t)cmd.vertexOffset + cmd.vertexCount > size) {
+                return;
+            }
+        }
+    }
+
+    // Rebuild the four streams from the commands: eligible float ranges are
+    // converted, the rest copied and packed ranges (an earlier optimize())
+    // kept. Vertices no command refers to are dropped.
+    scratchVertices2D_.clear();
+    scratchVertices3D_.clear();
+    scratchPacked2D_.clear();
+    scratchPacked3D_.clear();
+    std::unordered_map<uint64_t, uint32_t> kept2D, converted2D, repacked2D;
+    std::unordered_map<uint64_t, uint32_t> kept3D, converted3D, repacked3D;
+    auto copy = [](const auto& v) { return v; };
+    auto convert = [](const auto& v) { return packVertex(v); };
+
+    bool customShader = false;
+    for (size_t i = 0; i < commands_.size(); ++i) {
+        const CommandType type = commands_[i].type;
+        if (type == CommandType::SetCustomShader) {
+            customShader = commands_[i].as<SetCustomShaderCommand>().pipelineState != nullptr;
+        } else if (type == CommandType::Draw2D) {
+            DrawCommand2D& cmd = commands_.get<DrawCommand2D>(i);
+            if (cmd.vertexFormat == VertexFormat::Packed) {
+                cmd.vertexOffset = relocateRange(repacked2D, scratchPacked2D_, packedVertices2D_.data(),
+                                                 cmd.vertexOffset, cmd.vertexCount, copy);
+            } else if (!customShader && canPack2D(cmd, vertices2D_.data())) {
+                cmd.vertexOffset = relocateRange(converted2D, scratchPacked2D_, vertices2D_.data(),
+                                                 cmd.vertexOffset, cmd.vertexCount, convert);
+                cmd.vertexFormat = VertexFormat::Packed;
+                packedCommandCount_++;
+            } else {
+                cmd.vertexOffset = relocateRange(kept2D, scratchVertices2D_, vertices2D_.data(),
+                                                 cmd.vertexOffset, cmd.vertexCount, copy);
+            }
+        } else if (type == CommandType::Draw3D || type == CommandType::Draw3DInstanced ||
+                   type == CommandType::Draw3DIndirect) {
+            // The derived commands start with their DrawCommand3D part
+            DrawCommand3D& cmd = commands_.get<DrawCommand3D>(i);
+            if (cmd.vertexBuffer) {
+                continue;   // Resident geometry stays where it is
+            }
+            if (cmd.vertexFormat == VertexFormat::Packed) {
+                cmd.vertexOffset = relocateRange(repacked3D, scratchPacked3D_, packedVertices3D_.data(),
+                                                 cmd.vertexOffset, cmd.vertexCount, copy);
+            } else if (canPack3D(cmd, vertices3D_.data())) {
+                cmd.vertexOffset = relocateRange(converted3D, scratchPacked3D_, vertices3D_.data(),
+                                                 cmd.vertexOffset, cmd.vertexCount, convert);
+                cmd.vertexFormat = VertexFormat::Packed;
+                packedCommandCount_++;
+            } else {
+                cmd.vertexOffset = relocateRange(kept3D, scratchVertices3D_, vertices3D_.data(),
+                                                 cmd.vertexOffset, cmd.vertexCount, copy);
+            }
+        }
+    }
+
+    // The previous streams become next frame's scratch space
+    vertices2D_.swap(scratchVertices2D_);
+    vertices3D_.swap(scratchVertices3D_);
+    packedVertices2D_.swap(scratchPacked2D_);
+    packedVertices3D_.swap(scratchPacked3D_);
+}
+
+size_t DrawList::coalescePasses() {
+    const size_t count = commands_.size();
+    if (count < 2) {
+        return 0;
+    }
+
+    const CommandStream& stream = commands_;
+
+    // Commands that need an encoder on the current target
+    auto isPassWork = [](CommandType type) {
+        return type == CommandType::Draw2D || type == CommandType::Draw3D ||
+               type == CommandType::Draw3DInstanced || type == CommandType::Draw3DIndirect ||
+               type == CommandType::DrawMeshPrimitives ||
+               type == CommandType::Draw2DShapes || type == CommandType::Draw2DStroke ||
+               type == CommandType::Draw2DPaths || type == CommandType::DrawPointCloud ||
+               type == CommandType::DrawDisplayList || type == CommandType::RenderShadowMap ||
+               type == CommandType::Clear || type == CommandType::DispatchCompute;
+    };
+
+    std::vector<uint8_t> dropped(count, 0);
+
+    // Switches whose pass does no work; the open pass at the end is kept
+    size_t openSwitch = count;
+    bool work = false;
+    for (size_t i = 0; i < count; i++) {
+        CommandType type = stream[i].type;
+        if (type == CommandType::SetRenderTarget) {
+            if (openSwitch < count && !work) {
+                dropped[openSwitch] = 1;
+            }
+            openSwitch = i;
+            work = false;
+        } else if (isPassWork(type)) {
+            work = true;
+        }
+    }
+
+    // Switches to the target that is already bound continue its pass
+    // (the target bound before the list, or after a replayed display list
+    // that may switch targets itself, is unknown)
+    bool targetKnown = false;
+    SetRenderTargetCommand target;
+    for (size_t i = 0; i < count; i++) {
+        if (stream[i].type == CommandType::DrawDisplayList) {
+            targetKnown = false;
+            continue;
+        }
+        if (dropped[i] || stream[i].type != CommandType::SetRenderTarget) {
+            continue;
+        }
+        const SetRenderTargetCommand& next = stream[i].as<SetRenderTargetCommand>();
+        if (targetKnown && next.renderTarget == target.renderTarget &&
+            next.sampleCount == target.sampleCount) {
+            dropped[i] = 1;
+        }
+        targetKnown = true;
+        target = next;
+    }
+
+    // Clears with only state commands between them become one clear
+    std::vector<std::pair<size_t, ClearCommand>> folded;
+    for (size_t i = 0; i < count; i++) {
+        if (dropped[i] || stream[i].type != CommandType::Clear) {
+            continue;
+        }
+        ClearCommand merged = stream[i].as<SetClearCommand>().clearData;
+        bool mergedAny = false;
+        for (size_t j = i + 1; j < count; j++) {
+            if (dropped[j]) {
+                continue;
+            }
+            CommandType type = stream[j].type;
+            if (type == CommandType::Clear) {
+                const ClearCommand& next = stream[j].as<SetClearCommand>().clearData;
+                if (next.clearColor) {
+                    merged.clearColor = true;
+                    merged.color = next.color;
+                }
+                if (next.clearDepth) {
+                    merged.clearDepth = true;
+                    merged.depth = next.depth;
+                }
+                if (next.clearStencil) {
+                    merged.clearStencil = true;
+                    merged.stencil = next.stencil;
+                }
+                dropped[j] = 1;
+                mergedAny = true;
+            } else if (isPassWork(type) || type == CommandType::SetRenderTarget) {
+                break;
+            }
+        }
+        if (mergedAny) {
+            folded.push_back({i, merged});
+        }
+    }
+
+    size_t removed = 0;
+    for (uint8_t d : dropped) {
+        removed += d;
+    }
+    if (removed == 0) {
+        return 0;
+    }
+
+    // Rebuild once; newIndex maps old positions for the ordered regions
+    std::vector<uint32_t> newIndex(count + 1);
+    CommandStream coalesced;
+    coalesced.reserve(count - removed, commands_.byteSize());
+    size_t nextFolded = 0;
+    for (size_t i = 0; i < count; i++) {
+        newIndex[i] = static_cast<uint32_t>(coalesced.size());
+        if (dropped[i]) {
+            continue;
+        }
+        if (nextFolded < folded.size() && folded[nextFolded].first == i) {
+            coalesced.push(SetClearCommand(folded[nextFolded].second));
+            nextFolded++;
+        } else {
+            coalesced.push(stream[i]);
+        }
+    }
+    newIndex[count] = static_cast<uint32_t>(coalesced.size());
+
+    for (OrderedRange& range : orderedRanges_) {
+        range.first = newIndex[std::min<size_t>(range.first, count)];
+        if (range.last != UINT32_MAX) {
+            range.last = newIndex[std::min<size_t>(range.last, count)];
+        }
+    }
+
+    commands_.swap(coalesced);
+    return removed;
 }
 
 void DrawList::sortCommands() {
@@ -305,65 +1396,222 @@ void DrawList::sortCommands() {
         return;
     }
 
+    // Sort a permutation of record indices, then rebuild the packed stream once
+    std::vector<uint32_t> order(commands_.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = static_cast<uint32_t>(i);
+    }
+
+    const CommandStream& stream = commands_;
+    auto less = [&stream](uint32_t ia, uint32_t ib) {
+        CommandRef a = stream[ia];
+        CommandRef b = stream[ib];
+
+        // Sort by type first (2D before 3D)
+        if (a.type != b.type) {
+            return a.type < b.type;
+        }
+
+        // Sort 2D commands
+        if (a.type == CommandType::Draw2D) {
+            const DrawCommand2D& da = a.as<DrawCommand2D>();
+            const DrawCommand2D& db = b.as<DrawCommand2D>();
+            // Sort by texture (nullptr < valid texture, then by pointer value)
+            if (da.texture != db.texture) {
+                return da.texture < db.texture;
+            }
+            if (da.samplerKey != db.samplerKey) {
+                return da.samplerKey < db.samplerKey;
+            }
+            // Then by blend mode
+            if (da.blendMode != db.blendMode) {
+                return da.blendMode < db.blendMode;
+            }
+            // Then by primitive type
+            return da.primitiveType < db.primitiveType;
+        }
+
+        // Sort 3D commands
+        if (a.type == CommandType::Draw3D) {
+            const DrawCommand3D& da = a.as<DrawCommand3D>();
+            const DrawCommand3D& db = b.as<DrawCommand3D>();
+            // Sort by texture
+            if (da.texture != db.texture) {
+                return da.texture < db.texture;
+            }
+            if (da.samplerKey != db.samplerKey) {
+                return da.samplerKey < db.samplerKey;
+            }
+            // Then by depth test (enabled first for early-z)
+            if (da.depthTestEnabled != db.depthTestEnabled) {
+                return da.depthTestEnabled > db.depthTestEnabled;
+            }
+            // Then by blend mode
+            if (da.blendMode != db.blendMode) {
+                return da.blendMode < db.blendMode;
+            }
+            // Then by primitive type
+            return da.primitiveType < db.primitiveType;
+        }
+
+        return false;
+    };
+
     // Find ranges between state commands and sort within each range
     size_t rangeStart = 0;
 
-    for (size_t i = 0; i <= commands_.size(); i++) {
+    for (size_t i = 0; i <= order.size(); i++) {
         // Check if we hit a state command or end of list
-        bool isStateCmd = (i < commands_.size()) &&
-                         (commands_[i].type != CommandType::Draw2D &&
-                          commands_[i].type != CommandType::Draw3D);
+        bool isStateCmd = (i < order.size()) &&
+                         (stream[i].type != CommandType::Draw2D &&
+                          stream[i].type != CommandType::Draw3D);
 
-        if (isStateCmd || i == commands_.size()) {
+        if (isStateCmd || i == order.size()) {
             // Sort the range [rangeStart, i) of draw commands
             if (i > rangeStart) {
-                std::sort(commands_.begin() + rangeStart, commands_.begin() + i,
-                         [](const DrawCommand& a, const DrawCommand& b) {
-                    // Sort by type first (2D before 3D)
-                    if (a.type != b.type) {
-                        return a.type < b.type;
-                    }
-
-                    // Sort 2D commands
-                    if (a.type == CommandType::Draw2D) {
-                        // Sort by texture (nullptr < valid texture, then by pointer value)
-                        if (a.draw2D.texture != b.draw2D.texture) {
-                            return a.draw2D.texture < b.draw2D.texture;
-                        }
-                        // Then by blend mode
-                        if (a.draw2D.blendMode != b.draw2D.blendMode) {
-                            return a.draw2D.blendMode < b.draw2D.blendMode;
-                        }
-                        // Then by primitive type
-                        return a.draw2D.primitiveType < b.draw2D.primitiveType;
-                    }
-
-                    // Sort 3D commands
-                    if (a.type == CommandType::Draw3D) {
-                        // Sort by texture
-                        if (a.draw3D.texture != b.draw3D.texture) {
-                            return a.draw3D.texture < b.draw3D.texture;
-                        }
-                        // Then by depth test (enabled first for early-z)
-                        if (a.draw3D.depthTestEnabled != b.draw3D.depthTestEnabled) {
-                            return a.draw3D.depthTestEnabled > b.draw3D.depthTestEnabled;
-                        }
-                        // Then by blend mode
-                        if (a.draw3D.blendMode != b.draw3D.blendMode) {
-                            return a.draw3D.blendMode < b.draw3D.blendMode;
-                        }
-                        // Then by primitive type
-                        return a.draw3D.primitiveType < b.draw3D.primitiveType;
-                    }
-
-                    return false;
-                });
+                std::sort(order.begin() + rangeStart, order.begin() + i, less);
             }
 
             // Move to next range (skip the state command)
             rangeStart = i + 1;
         }
     }
+
+    CommandStream sorted;
+    sorted.reserve(commands_.size(), commands_.byteSize());
+    for (uint32_t index : order) {
+        sorted.push(stream[index]);
+    }
+    commands_.swap(sorted);
+
+    // Unconditional sort: ordered regions no longer describe the stream
+    orderedRanges_.clear();
+    openOrderedRegions_.clear();
+}
+
+// ============================================================================
+// State-Sorted Reordering
+// ============================================================================
+
+void DrawList::beginOrderedRegion() {
+    openOrderedRegions_.push_back(orderedRanges_.size());
+    orderedRanges_.push_back({static_cast<uint32_t>(commands_.size()), UINT32_MAX});
+}
+
+void DrawList::endOrderedRegion() {
+    if (openOrderedRegions_.empty()) {
+        return;
+    }
+    orderedRanges_[openOrderedRegions_.back()].last = static_cast<uint32_t>(commands_.size());
+    openOrderedRegions_.pop_back();
+}
+
+bool DrawList::isReorderable3D(const DrawCommand3D& cmd, const ReorderOptions& options) const {
+    // Order-independent draws are composited after the pass's opaque draws
+    if (cmd.orderIndependent) {
+        return true;
+    }
+
+    // Without depth test/write, draw order decides visibility
+    if (!cmd.depthTestEnabled || !cmd.depthWriteEnabled) {
+        return false;
+    }
+    if (cmd.blendMode == BlendMode::Disabled) {
+        return true;
+    }
+    return options.alphaBlendIsOpaque && cmd.blendMode == BlendMode::Alpha;
+}
+
+size_t DrawList::reorderForState(const ReorderOptions& options) {
+    const size_t count = commands_.size();
+    if (count < 2) {
+        return 0;
+    }
+
+    const CommandStream& stream = commands_;
+
+    // Commands inside ordered regions are pinned
+    std::vector<uint8_t> pinned(count, 0);
+    for (const OrderedRange& range : orderedRanges_) {
+        size_t last = std::min<size_t>(range.last, count);
+        for (size_t i = range.first; i < last; i++) {
+            pinned[i] = 1;
+        }
+    }
+
+    auto reorderable = [&](size_t i) {
+        CommandRef ref = stream[i];
+        return !pinned[i] && ref.type == CommandType::Draw3D &&
+               isReorderable3D(ref.as<DrawCommand3D>(), options);
+    };
+
+    const bool frontToBack = options.frontToBack;
+    auto less = [&stream, frontToBack](uint32_t ia, uint32_t ib) {
+        const DrawCommand3D& a = stream[ia].as<DrawCommand3D>();
+        const DrawCommand3D& b = stream[ib].as<DrawCommand3D>();
+        // Pipeline: lit/unlit variant and blend mode, then culling
+        if (a.useLighting != b.useLighting) {
+            return a.useLighting < b.useLighting;
+        }
+        if (a.blendMode != b.blendMode) {
+            return a.blendMode < b.blendMode;
+        }
+        if (a.cullBackFace != b.cullBackFace) {
+            return a.cullBackFace < b.cullBackFace;
+        }
+        // Texture and sampler
+        if (a.texture != b.texture) {
+            return a.texture < b.texture;
+        }
+        if (a.samplerKey != b.samplerKey) {
+            return a.samplerKey < b.samplerKey;
+        }
+        // Lighting/material block
+        if (a.lightingHandle != b.lightingHandle) {
+            return a.lightingHandle < b.lightingHandle;
+        }
+        // Nearest first: view space looks down -Z, so larger z is closer
+        if (frontToBack) {
+            return a.modelViewMatrix.columns[3].z > b.modelViewMatrix.columns[3].z;
+        }
+        return false;
+    };
+
+    std::vector<uint32_t> order(count);
+    for (size_t i = 0; i < count; i++) {
+        order[i] = static_cast<uint32_t>(i);
+    }
+
+    // Sort each run of reorderable draws; everything else is a barrier
+    size_t runStart = 0;
+    for (size_t i = 0; i <= count; i++) {
+        if (i < count && reorderable(i)) {
+            continue;
+        }
+        if (i - runStart > 1) {
+            std::stable_sort(order.begin() + runStart, order.begin() + i, less);
+        }
+        runStart = i + 1;
+    }
+
+    size_t moved = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (order[i] != i) {
+            moved++;
+        }
+    }
+    if (moved == 0) {
+        return 0;
+    }
+
+    // Barriers keep their indices, so ordered regions stay valid
+    CommandStream sorted;
+    sorted.reserve(count, commands_.byteSize());
+    for (uint32_t index : order) {
+        sorted.push(stream[index]);
+    }
+    commands_.swap(sorted);
+    return moved;
 }
 
 } // namespace render
@@ -2,11 +2,17 @@
 
 #include "DrawCommand.h"
 #include "RenderTypes.h"
+#include "FrameArena.h"
 #include <vector>
 #include <cstdint>
 
 namespace render {
 
+namespace metal {
+class DrawListCapture;
+class DrawListReplay;
+}
+
 // ============================================================================
 // DrawList - Command and Vertex Buffer Manager
 // ============================================================================
@@ -51,6 +57,118 @@ public:
      */
     void addCommand(const DrawCommand3D& cmd);
 
+    /**
+     * Add an instanced 3D draw command to the list.
+     * @param cmd The instanced draw command to add (ignored if instanceCount is 0)
+     */
+    void addCommand(const DrawCommand3DInstanced& cmd);
+
+    /**
+     * Add an indirect 3D draw command to the list.
+     * @param cmd The indirect draw command to add (ignored without an argument buffer)
+     */
+    void addCommand(const DrawCommand3DIndirect& cmd);
+
+    /**
+     * Add a mesh-shader primitive draw command to the list.
+     * @param cmd The primitive command to add (ignored if instanceCount is 0)
+     */
+    void addCommand(const DrawMeshPrimitivesCommand& cmd);
+
+    /**
+     * Add an SDF shape draw command to the list.
+     * @param cmd The shape command to add (ignored if shapeCount is 0)
+     */
+    void addCommand(const DrawCommand2DShapes& cmd);
+
+    /**
+     * Add a stroke draw command to the list.
+     * @param cmd The stroke command to add (ignored if segmentCount is 0)
+     */
+    void addCommand(const DrawCommand2DStroke& cmd);
+
+    /**
+     * Add a path fill command to the list.
+     * @param cmd The path command to add (ignored if pathCount is 0)
+     */
+    void addCommand(const DrawCommand2DPaths& cmd);
+
+    /**
+     * Add a point cloud draw to the list.
+     * @param cmd The point cloud command to add (ignored without point and
+     *            chunk buffers, or if pointCount is 0)
+     */
+    void addCommand(const DrawPointCloudCommand& cmd);
+
+    /**
+     * Add a display list replay to the list.
+     * @param cmd The replay command to add (ignored without a recorded list,
+     *            or if it would replay this list into itself)
+     */
+    void addCommand(const DrawDisplayListCommand& cmd);
+
+    /**
+     * Add a shadow map render to the list.
+     * @param cmd The shadow map command to add (ignored without recorded
+     *            casters or a shadow map, or if the casters are this list)
+     */
+    void addCommand(const RenderShadowMapCommand& cmd);
+
+    /**
+     * Add a compute dispatch to the list.
+     * @param cmd The dispatch to add (ignored if the grid is empty)
+     */
+    void addCommand(const DispatchComputeCommand& cmd);
+
+    /**
+     * Add a texture readback to the list.
+     * @param cmd The readback to add (ignored without a texture, buffer or
+     *            completion callback, or for an empty region)
+     */
+    void addCommand(const ReadbackTextureCommand& cmd);
+
+    /**
+     * Add a texture filter command to the list.
+     * @param cmd The filter to add (ignored without distinct source and
+     *            destination textures or with an invalid kernel size)
+     */
+    void addCommand(const FilterTextureCommand& cmd);
+
+    /**
+     * Add a mipmap generation command to the list.
+     * @param cmd The command to add (ignored without a texture)
+     */
+    void addCommand(const GenerateMipmapsCommand& cmd);
+
+    /**
+     * Add a YCbCr conversion command to the list.
+     * @param cmd The conversion to add (ignored without distinct luma,
+     *            chroma and destination textures)
+     */
+    void addCommand(const ConvertYCbCrCommand& cmd);
+
+    /**
+     * Add a YCoCg conversion command to the list.
+     * @param cmd The conversion to add (ignored without distinct color and
+     *            destination textures, or an alpha texture shared with either)
+     */
+    void addCommand(const ConvertYCoCgCommand& cmd);
+
+    /**
+     * Add a texture copy command to the list.
+     * @param cmd The copy to add (ignored without a destination, or when
+     *            it copies a texture onto itself)
+     */
+    void addCommand(const CopyTextureCommand& cmd);
+
+    /**
+     * Add a post-processing command to the list.
+     * @param cmd The stack to add (ignored without distinct source and
+     *            destination textures, without passes, or with a stage
+     *            range or bloom level count out of bounds)
+     */
+    void addCommand(const PostProcessCommand& cmd);
+
     /**
      * Add a viewport command to the list.
      * @param cmd The viewport command to add
@@ -83,9 +201,9 @@ public:
 
     /**
      * Get all commands in the list.
-     * @return Const reference to the command vector
+     * @return Const reference to the packed command stream
      */
-    const std::vector<DrawCommand>& getCommands() const { return commands_; }
+    const CommandStream& getCommands() const { return commands_; }
 
     /**
      * Get the number of commands in the list.
@@ -93,6 +211,104 @@ public:
      */
     size_t getCommandCount() const { return commands_.size(); }
 
+    /**
+     * Get the size of the packed command stream in bytes.
+     * @return Command arena size in bytes
+     */
+    size_t getCommandDataSize() const { return commands_.byteSize(); }
+
+    // ========================================================================
+    // Side Tables
+    // ========================================================================
+
+    /**
+     * Add a lighting/material block to the side table.
+     * Store the returned handle in DrawCommand3D::lightingHandle.
+     * Callers normally go through Context::getLightingStateHandle(), which
+     * only adds a block when lights or material changed.
+     * @param state Lighting state to add
+     * @return Handle of the added state, or kInvalidLightingHandle if the table is full
+     */
+    uint16_t addLightingState(const LightingState& state);
+
+    /**
+     * Get a lighting/material block by handle.
+     * @param handle Handle returned by addLightingState()
+     * @return Pointer to the state, or nullptr if the handle is invalid
+     */
+    const LightingState* getLightingState(uint16_t handle) const {
+        return handle < lightingStates_.size() ? &lightingStates_[handle] : nullptr;
+    }
+
+    /**
+     * Reserve lights in the light pool.
+     * Fill the returned kLightFloats * count floats and store the offset in
+     * LightingState::firstLight; lighting states of one light setup share
+     * one range. Callers normally go through Context::getLightingStateHandle().
+     * @param count Number of lights
+     * @param firstLight Receives the index of the first reserved light
+     * @return Pointer to the reserved floats, or nullptr if count is 0
+     */
+    float* allocateLights(size_t count, uint32_t& firstLight);
+
+    /**
+     * Get the light pool (kLightFloats floats per light, for GPU upload).
+     * @return Const reference to the light pool
+     */
+    const std::vector<float>& getLightData() const { return lightData_; }
+
+    /**
+     * Add a shadow block to the side table.
+     * Store the returned handle in LightingState::shadowHandle. Callers
+     * normally go through Context::getLightingStateHandle().
+     * @param state Shadow maps and uniforms to add
+     * @return Handle of the added state, or kInvalidShadowHandle if the table is full
+     */
+    uint16_t addShadowState(const ShadowState& state);
+
+    /**
+     * Get a shadow block by handle.
+     * @param handle LightingState::shadowHandle
+     * @return Pointer to the state, or nullptr if the handle is invalid
+     */
+    const ShadowState* getShadowState(uint16_t handle) const {
+        return handle < shadowStates_.size() ? &shadowStates_[handle] : nullptr;
+    }
+
+    /**
+     * Get all shadow blocks (for one-shot GPU upload).
+     * @return Const reference to the shadow side table
+     */
+    const std::vector<ShadowState>& getShadowStates() const { return shadowStates_; }
+
+    /**
+     * Get a texture batch by handle (see setTextureBatching()).
+     * @param handle DrawCommand2D::textureBatch
+     * @return Pointer to the batch, or nullptr if the handle is invalid
+     */
+    const TextureBatch2D* getTextureBatch(uint16_t handle) const {
+        return handle < textureBatches_.size() ? &textureBatches_[handle] : nullptr;
+    }
+
+    /**
+     * Get all lighting states (for one-shot GPU upload).
+     * @return Const reference to the lighting side table
+     */
+    const std::vector<LightingState>& getLightingStates() const { return lightingStates_; }
+
+    /**
+     * Get the reset generation of this list.
+     * Incremented by reset(); lets callers caching handles detect a new frame.
+     * @return Generation counter
+     */
+    uint64_t getGeneration() const { return generation_; }
+
+    /**
+     * Get the number of lighting states in the side table.
+     * @return Number of lighting states
+     */
+    size_t getLightingStateCount() const { return lightingStates_.size(); }
+
     // ========================================================================
     // Vertex Management (2D)
     // ========================================================================
@@ -120,7 +336,20 @@ public:
     uint32_t addVertices2D(const std::vector<Vertex2D>& vertices);
 
     /**
-     * Get all 2D vertices in the buffer.
+     * Append count 2D vertices for the caller to fill in place.
+     * Bulk producers write straight into the vertex arena (mapped GPU memory
+     * when bound) instead of staging a copy. Contents are unspecified until
+     * written. Fill the range before the next add/allocate call on this
+     * list: a later call may move it (e.g. when mapped storage spills).
+     * @param count Number of vertices to append
+     * @param offset Receives the offset of the first vertex
+     * @return Pointer to the first vertex, or nullptr if count is 0
+     */
+    Vertex2D* allocateVertices2D(size_t count, uint32_t& offset);
+
+    /**
+     * Get all 2D vertices in the CPU-side buffer.
+     * Empty while mapped storage is bound; use getVertex2DData() instead.
      * @return Const reference to the 2D vertex vector
      */
     const std::vector<Vertex2D>& getVertices2D() const { return vertices2D_; }
@@ -129,13 +358,19 @@ public:
      * Get the number of 2D vertices in the buffer.
      * @return Number of 2D vertices
      */
-    size_t getVertex2DCount() const { return vertices2D_.size(); }
+    size_t getVertex2DCount() const {
+        return mapped_.vertices2D ? mappedCount2D_ : vertices2D_.size();
+    }
 
     /**
      * Get raw pointer to 2D vertex data (for GPU upload).
+     * Points into the mapped GPU buffer when mapped storage is bound.
      * @return Pointer to vertex data, or nullptr if empty
      */
     const Vertex2D* getVertex2DData() const {
+        if (mapped_.vertices2D) {
+            return mappedCount2D_ ? mapped_.vertices2D : nullptr;
+        }
         return vertices2D_.empty() ? nullptr : vertices2D_.data();
     }
 
@@ -144,7 +379,7 @@ public:
      * @return Size in bytes
      */
     size_t getVertex2DDataSize() const {
-        return vertices2D_.size() * sizeof(Vertex2D);
+        return getVertex2DCount() * sizeof(Vertex2D);
     }
 
     // ========================================================================
@@ -174,7 +409,17 @@ public:
     uint32_t addVertices3D(const std::vector<Vertex3D>& vertices);
 
     /**
-     * Get all 3D vertices in the buffer.
+     * Append count 3D vertices for the caller to fill in place.
+     * Same contract as allocateVertices2D().
+     * @param count Number of vertices to append
+     * @param offset Receives the offset of the first vertex
+     * @return Pointer to the first vertex, or nullptr if count is 0
+     */
+    Vertex3D* allocateVertices3D(size_t count, uint32_t& offset);
+
+    /**
+     * Get all 3D vertices in the CPU-side buffer.
+     * Empty while mapped storage is bound; use getVertex3DData() instead.
      * @return Const reference to the 3D vertex vector
      */
     const std::vector<Vertex3D>& getVertices3D() const { return vertices3D_; }
@@ -183,13 +428,19 @@ public:
      * Get the number of 3D vertices in the buffer.
      * @return Number of 3D vertices
      */
-    size_t getVertex3DCount() const { return vertices3D_.size(); }
+    size_t getVertex3DCount() const {
+        return mapped_.vertices3D ? mappedCount3D_ : vertices3D_.size();
+    }
 
     /**
      * Get raw pointer to 3D vertex data (for GPU upload).
+     * Points into the mapped GPU buffer when mapped storage is bound.
      * @return Pointer to vertex data, or nullptr if empty
      */
     const Vertex3D* getVertex3DData() const {
+        if (mapped_.vertices3D) {
+            return mappedCount3D_ ? mapped_.vertices3D : nullptr;
+        }
         return vertices3D_.empty() ? nullptr : vertices3D_.data();
     }
 
@@ -198,7 +449,57 @@ public:
      * @return Size in bytes
      */
     size_t getVertex3DDataSize() const {
-        return vertices3D_.size() * sizeof(Vertex3D);
+        return getVertex3DCount() * sizeof(Vertex3D);
+    }
+
+    // ========================================================================
+    // Packed Vertices (setVertexCompression)
+    // ========================================================================
+
+    /**
+     * Get the number of packed 2D vertices written by the last optimize().
+     * @return Number of PackedVertex2D records
+     */
+    size_t getPackedVertex2DCount() const { return packedVertices2D_.size(); }
+
+    /**
+     * Get raw pointer to packed 2D vertex data (for GPU upload).
+     * Draws with VertexFormat::Packed index this stream instead of the
+     * Vertex2D one.
+     * @return Pointer to vertex data, or nullptr if empty
+     */
+    const PackedVertex2D* getPackedVertex2DData() const {
+        return packedVertices2D_.empty() ? nullptr : packedVertices2D_.data();
+    }
+
+    /**
+     * Get size of packed 2D vertex data in bytes.
+     * @return Size in bytes
+     */
+    size_t getPackedVertex2DDataSize() const {
+        return packedVertices2D_.size() * sizeof(PackedVertex2D);
+    }
+
+    /**
+     * Get the number of packed 3D vertices written by the last optimize().
+     * @return Number of PackedVertex3D records
+     */
+    size_t getPackedVertex3DCount() const { return packedVertices3D_.size(); }
+
+    /**
+     * Get raw pointer to packed 3D vertex data (for GPU upload).
+     * @return Pointer to vertex data, or nullptr if empty
+     */
+    const PackedVertex3D* getPackedVertex3DData() const {
+        return packedVertices3D_.empty() ? nullptr : packedVertices3D_.data();
+    }
+
+    /**
+     * Get size of packed 3D vertex data in bytes.
+     * @return Size in bytes
+     */
+    size_t getPackedVertex3DDataSize() const {
+        return packedVertices3D_.size() * sizeof(PackedVertex3D);
     }
 
     // ========================================================================
@@ -228,7 +529,17 @@ public:
     uint32_t addIndices(const std::vector<uint32_t>& indices);
 
     /**
-     * Get all indices in the buffer.
+     * Append count indices for the caller to fill in place.
+     * Same contract as allocateVertices2D().
+     * @param count Number of indices to append
+     * @param offset Receives the offset of the first index
+     * @return Pointer to the first index, or nullptr if count is 0
+     */
+    uint32_t* allocateIndices(size_t count, uint32_t& offset);
+
+    /**
+     * Get all indices in the CPU-side buffer.
+     * Empty while mapped storage is bound; use getIndexData() instead.
      * @return Const reference to the index vector
      */
     const std::vector<uint32_t>& getIndices() const { return indices_; }
@@ -237,13 +548,19 @@ public:
      * Get the number of indices in the buffer.
      * @return Number of indices
      */
-    size_t getIndexCount() const { return indices_.size(); }
+    size_t getIndexCount() const {
+        return mapped_.indices ? mappedIndexCount_ : indices_.size();
+    }
 
     /**
      * Get raw pointer to index data (for GPU upload).
+     * Points into the mapped GPU buffer when mapped storage is bound.
      * @return Pointer to index data, or nullptr if empty
      */
     const uint32_t* getIndexData() const {
+        if (mapped_.indices) {
+            return mappedIndexCount_ ? mapped_.indices : nullptr;
+        }
         return indices_.empty() ? nullptr : indices_.data();
     }
 
@@ -252,16 +569,342 @@ public:
      * @return Size in bytes
      */
     size_t getIndexDataSize() const {
-        return indices_.size() * sizeof(uint32_t);
+        return getIndexCount() * sizeof(uint32_t);
+    }
+
+    // ========================================================================
+    // In-Place Geometry
+    // ========================================================================
+
+    /**
+     * Vertex and index ranges reserved together by allocateGeometry2D/3D().
+     * Indices are relative to the list's whole vertex buffer, so shapes
+     * write vertexOffset + i (or draw with cmd.vertexOffset = vertexOffset
+     * and local indices, as ofGraphics does).
+     */
+    template <typename VertexT>
+    struct GeometryAllocation {
+        VertexT* vertices = nullptr;     // nullptr if vertexCount is 0
+        uint32_t* indices = nullptr;     // nullptr if indexCount is 0
+        uint32_t vertexOffset = 0;
+        uint32_t indexOffset = 0;
+    };
+
+    /**
+     * Append vertices and indices of one shape for the caller to fill in place.
+     * Unlike separate allocateVertices2D() / allocateIndices() calls, both
+     * ranges stay valid together: if mapped storage can't hold both, it
+     * spills before either is handed out. Fill them before the next
+     * add/allocate call on this list.
+     * @param vertexCount Number of 2D vertices
+     * @param indexCount Number of indices
+     * @return The two ranges and their offsets
+     */
+    GeometryAllocation<Vertex2D> allocateGeometry2D(size_t vertexCount, size_t indexCount);
+
+    /**
+     * Append vertices and indices of one 3D shape for the caller to fill in place.
+     * Same contract as allocateGeometry2D().
+     * @param vertexCount Number of 3D vertices
+     * @param indexCount Number of indices
+     * @return The two ranges and their offsets
+     */
+    GeometryAllocation<Vertex3D> allocateGeometry3D(size_t vertexCount, size_t indexCount);
+
+    // ========================================================================
+    // Frame Scratch
+    // ========================================================================
+
+    /**
+     * Allocate scratch memory that lives until reset().
+     * For temporary data built while recording (outline points, geometry
+     * whose size isn't known up front) - not part of the frame's buffers.
+     * Ranges never move, whatever is allocated after them.
+     * @param count Number of elements (trivially destructible)
+     * @return Uninitialized elements, or nullptr if count is 0
+     */
+    template <typename T>
+    T* allocateTransient(size_t count) {
+        return arena_.template allocate<T>(count);
+    }
+
+    /**
+     * Get the scratch arena reset with the list.
+     * @return The frame arena
+     */
+    FrameArena& getFrameArena() { return arena_; }
+    const FrameArena& getFrameArena() const { return arena_; }
+
+    // ========================================================================
+    // Instance Management
+    // ========================================================================
+
+    /**
+     * Add per-instance records to the list's instance stream.
+     * Instanced draws with a null instanceBuffer read their records from
+     * this stream (see DrawCommand3DInstanced).
+     * @param instances Pointer to instance array
+     * @param count Number of instances to add
+     * @return Offset of the first added record
+     */
+    uint32_t addInstances(const InstanceData* instances, size_t count);
+
+    /**
+     * Get the number of records in the instance stream.
+     * @return Number of instances
+     */
+    size_t getInstanceCount() const { return instances_.size(); }
+
+    /**
+     * Get raw pointer to instance data (for GPU upload).
+     * @return Pointer to instance data, or nullptr if empty
+     */
+    const InstanceData* getInstanceData() const {
+        return instances_.empty() ? nullptr : instances_.data();
+    }
+
+    /**
+     * Get size of instance data in bytes.
+     * @return Size in bytes
+     */
+    size_t getInstanceDataSize() const {
+        return instances_.size() * sizeof(InstanceData);
+    }
+
+    // ========================================================================
+    // Shape Management
+    // ========================================================================
+
+    /**
+     * Add SDF shape records to the list's shape stream.
+     * DrawCommand2DShapes draws ranges of this stream.
+     * @param shapes Pointer to shape array
+     * @param count Number of shapes to add
+     * @return Offset of the first added record
+     */
+    uint32_t addShapes(const ShapeInstance2D* shapes, size_t count);
+
+    /**
+     * Append count shape records for the caller to fill in place.
+     * Same contract as allocateVertices2D().
+     */
+    ShapeInstance2D* allocateShapes(size_t count, uint32_t& offset);
+
+    /**
+     * Get the number of records in the shape stream.
+     * @return Number of shapes
+     */
+    size_t getShapeCount() const { return shapes_.size(); }
+
+    /**
+     * Get raw pointer to shape data (for GPU upload).
+     * @return Pointer to shape data, or nullptr if empty
+     */
+    const ShapeInstance2D* getShapeData() const {
+        return shapes_.empty() ? nullptr : shapes_.data();
+    }
+
+    /**
+     * Get size of shape data in bytes.
+     * @return Size in bytes
+     */
+    size_t getShapeDataSize() const {
+        return shapes_.size() * sizeof(ShapeInstance2D);
+    }
+
+    // ========================================================================
+    // Stroke Management
+    // ========================================================================
+
+    /**
+     * Add stroke segment records to the list's stroke stream.
+     * DrawCommand2DStroke draws ranges of this stream.
+     * @param segments Pointer to segment array
+     * @param count Number of segments to add
+     * @return Offset of the first added record
+     */
+    uint32_t addStrokeSegments(const StrokeSegment2D* segments, size_t count);
+
+    /**
+     * Append count stroke segment records for the caller to fill in place.
+     * Same contract as allocateVertices2D().
+     */
+    StrokeSegment2D* allocateStrokeSegments(size_t count, uint32_t& offset);
+
+    /**
+     * Get the number of records in the stroke stream.
+     * @return Number of segments
+     */
+    size_t getStrokeSegmentCount() const { return strokeSegments_.size(); }
+
+    /**
+     * Get raw pointer to stroke data (for GPU upload).
+     * @return Pointer to stroke data, or nullptr if empty
+     */
+    const StrokeSegment2D* getStrokeSegmentData() const {
+        return strokeSegments_.empty() ? nullptr : strokeSegments_.data();
+    }
+
+    /**
+     * Get size of stroke data in bytes.
+     * @return Size in bytes
+     */
+    size_t getStrokeSegmentDataSize() const {
+        return strokeSegments_.size() * sizeof(StrokeSegment2D);
     }
 
+    // ========================================================================
+    // Path Management
+    // ========================================================================
+
+    /**
+     * Add path records to the list's path stream.
+     * DrawCommand2DPaths draws ranges of this stream; each record names its
+     * edges in the path segment stream (addPathSegments).
+     * @param paths Pointer to path array
+     * @param count Number of paths to add
+     * @return Offset of the first added record
+     */
+    uint32_t addPaths(const PathInstance2D* paths, size_t count);
+
+    /**
+     * Append count path edge records for the caller to fill in place.
+     * Same contract as allocateVertices2D().
+     */
+    PathSegment2D* allocatePathSegments(size_t count, uint32_t& offset);
+
+    /**
+     * Get the number of records in the path stream.
+     * @return Number of paths
+     */
+    size_t getPathCount() const { return paths_.size(); }
+
+    /**
+     * Get the number of records in the path segment stream.
+     * @return Number of edges
+     */
+    size_t getPathSegmentCount() const { return pathSegments_.size(); }
+
+    /**
+     * Get raw pointer to path data (for GPU upload).
+     * @return Pointer to path data, or nullptr if empty
+     */
+    const PathInstance2D* getPathData() const {
+        return paths_.empty() ? nullptr : paths_.data();
+    }
+
+    /**
+     * Get size of path data in bytes.
+     * @return Size in bytes
+     */
+    size_t getPathDataSize() const {
+        return paths_.size() * sizeof(PathInstance2D);
+    }
+
+    /**
+     * Get raw pointer to path edge data (for GPU upload).
+     * @return Pointer to edge data, or nullptr if empty
+     */
+    const PathSegment2D* getPathSegmentData() const {
+        return pathSegments_.empty() ? nullptr : pathSegments_.data();
+    }
+
+    /**
+     * Get size of path edge data in bytes.
+     * @return Size in bytes
+     */
+    size_t getPathSegmentDataSize() const {
+        return pathSegments_.size() * sizeof(PathSegment2D);
+    }
+
+    // ========================================================================
+    // Uniform Snapshots
+    // ========================================================================
+
+    /**
+     * Append a snapshot of custom shader uniforms to the uniform stream.
+     * Snapshots start at kUniformAlignment boundaries; store the returned
+     * offset in SetCustomShaderCommand::uniformOffset.
+     * @param data Uniform bytes
+     * @param size Size in bytes
+     * @return Byte offset of the snapshot
+     */
+    uint32_t addUniformData(const void* data, size_t size);
+
+    /**
+     * Overwrite part of a snapshot recorded earlier this frame.
+     * Used when uniforms change before any draw has used the snapshot.
+     * @param offset Offset returned by addUniformData()
+     * @param byteOffset Start of the changed range within the snapshot
+     * @param data Changed bytes
+     * @param size Size of the changed range
+     * @return false if the range lies outside the stream
+     */
+    bool updateUniformData(uint32_t offset, size_t byteOffset, const void* data, size_t size);
+
+    /**
+     * Get raw pointer to the uniform stream (for GPU upload).
+     * @return Pointer to uniform data, or nullptr if empty
+     */
+    const uint8_t* getUniformData() const {
+        return uniformData_.empty() ? nullptr : uniformData_.data();
+    }
+
+    /**
+     * Get size of the uniform stream in bytes.
+     * @return Size in bytes
+     */
+    size_t getUniformDataSize() const { return uniformData_.size(); }
+
+    // ========================================================================
+    // Mapped Storage (zero-copy upload)
+    // ========================================================================
+
+    /**
+     * Persistently mapped GPU memory the list can write geometry into.
+     * Provided by the renderer for the in-flight frame (MTLBuffer contents).
+     */
+    struct MappedStorage {
+        Vertex2D* vertices2D = nullptr;
+        size_t capacity2D = 0;           // In vertices
+        Vertex3D* vertices3D = nullptr;
+        size_t capacity3D = 0;           // In vertices
+        uint32_t* indices = nullptr;
+        size_t capacityIndices = 0;      // In indices
+    };
+
+    /**
+     * Write vertices and indices directly into mapped GPU memory.
+     * Geometry already recorded this frame is moved into the mapping.
+     * If the mapping runs out of space the list spills back to its CPU
+     * vectors (see hasMappedOverflow()) and the renderer copies as before.
+     * The binding is dropped by reset().
+     * @param storage Mapped buffers for the current frame
+     * @return true if the storage was bound
+     */
+    bool bindMappedStorage(const MappedStorage& storage);
+
+    /**
+     * Check whether geometry is currently written to mapped storage.
+     * @return true if mapped storage is bound
+     */
+    bool isMapped() const { return mapped_.vertices2D != nullptr; }
+
+    /**
+     * Check whether mapped storage overflowed this frame.
+     * Renderers use this to grow their per-frame buffers.
+     * @return true if the list spilled back to CPU vectors
+     */
+    bool hasMappedOverflow() const { return mappedOverflow_; }
+
     // ========================================================================
     // Lifecycle Management
     // ========================================================================
 
     /**
      * Reset the draw list for a new frame.
-     * Clears all commands, vertices, and indices.
+     * Clears all commands, vertices, and indices, and releases the
+     * frame's transient allocations.
      * Call this after submitting the frame to the renderer.
      */
     void reset();
@@ -271,8 +914,8 @@ public:
      * @return True if no commands, vertices, or indices are present
      */
     bool isEmpty() const {
-        return commands_.empty() && vertices2D_.empty() &&
-               vertices3D_.empty() && indices_.empty();
+        return commands_.empty() && getVertex2DCount() == 0 &&
+               getVertex3DCount() == 0 && getIndexCount() == 0;
     }
 
     /**
@@ -280,7 +923,7 @@ public:
      * @param count Expected number of commands
      */
     void reserveCommands(size_t count) {
-        commands_.reserve(count);
+        commands_.reserve(count, count * sizeof(DrawCommand2D));
     }
 
     /**
@@ -311,6 +954,19 @@ public:
     // Optimization (Phase 18.1)
     // ========================================================================
 
+    /**
+     * Options for reorderForState().
+     */
+    struct ReorderOptions {
+        /// Within equal state, sort by view-space depth (nearest first) for early-Z
+        bool frontToBack = false;
+
+        /// Treat depth-tested, depth-writing BlendMode::Alpha draws as opaque.
+        /// oF-style code blends by default even for solid geometry; enable this
+        /// when such draws are known not to rely on blending order.
+        bool alphaBlendIsOpaque = false;
+    };
+
     /**
      * Optimize the command list by batching consecutive similar commands.
      * This reduces draw calls by merging commands with identical render state.
@@ -320,6 +976,21 @@ public:
      */
     void optimize();
 
+    /**
+     * Remove render pass breaks that do no work.
+     * - A render target switch whose pass has no draws, clears or dispatches
+     *   before the next switch is dropped (the list's last switch is kept;
+     *   it sets the target later lists draw into).
+     * - A switch to the target that is already bound is dropped, so
+     *   back-to-back passes on one target share an encoder.
+     * - Consecutive clears with no work between them fold into one clear,
+     *   i.e. a single loadAction = Clear; later values win per attachment.
+     *
+     * Called by optimize(). Ordered regions are remapped to the new indices.
+     * @return Number of commands removed
+     */
+    size_t coalescePasses();
+
     /**
      * Sort commands to minimize state changes.
      * Groups commands by texture, blend mode, and other state to reduce
@@ -330,12 +1001,143 @@ public:
      */
     void sortCommands();
 
+    /**
+     * Reorder opaque 3D draws to minimize encoder state changes.
+     * Sorts by pipeline (lighting, blend, culling) -> texture -> sampler ->
+     * lighting/material handle, optionally front-to-back. Only runs of
+     * reorderable draws are sorted; these act as barriers and never move:
+     * state commands (render target, clear, viewport, scissor, shader),
+     * 2D draws, blended or non-depth-tested 3D draws, and anything inside
+     * an ordered region. Order-independent draws (weighted blended
+     * transparency) sort with the opaque ones.
+     *
+     * Call before optimize(); optimize() consumes the ordered regions.
+     * @param options Reorder options
+     * @return Number of commands that changed position
+     */
+    size_t reorderForState(const ReorderOptions& options);
+
+    /**
+     * Reorder with default options (state sort only, blended draws are barriers).
+     * @return Number of commands that changed position
+     */
+    size_t reorderForState() { return reorderForState(ReorderOptions()); }
+
+    /**
+     * Begin a region whose commands must keep submission order.
+     * reorderForState() treats every command recorded until the matching
+     * endOrderedRegion() as a barrier. Regions may nest.
+     */
+    void beginOrderedRegion();
+
+    /**
+     * End the innermost ordered region.
+     */
+    void endOrderedRegion();
+
+    /**
+     * Let optimize() merge 2D draws whose transforms differ.
+     * Small shapes with a 2D affine transform (translate/rotate/scale in XY)
+     * are baked into world space on the CPU and their transform reset to
+     * identity, so runs of per-shape ofPushMatrix/ofTranslate draws become
+     * one draw call. Persists across reset().
+     * @param enabled Enable transform baking
+     * @param maxVertices Largest command (in vertices) that is baked
+     */
+    void setTransformBaking(bool enabled, uint32_t maxVertices = 64) {
+        bakeTransforms_ = enabled;
+        bakeMaxVertices_ = maxVertices;
+    }
+
+    /**
+     * Let optimize() merge textured 2D draws whose textures differ.
+     * Up to TextureBatch2D::kMaxTextures textures (same sampler, blend mode
+     * and primitive type) share one draw; the merged command refers to a
+     * texture batch describing which vertices sample which texture.
+     * Persists across reset().
+     * @param enabled Enable texture batching
+     */
+    void setTextureBatching(bool enabled) { batchTextures_ = enabled; }
+
+    /**
+     * Check whether texture batching is enabled.
+     */
+    bool isTextureBatchingEnabled() const { return batchTextures_; }
+
+    /**
+     * Let optimize() store eligible draws in packed vertex formats.
+     * Draws whose values survive the encoding (colors in 0-1, texture
+     * coordinates in 0-1 when textured, normals in -1..1 when lit) move to
+     * the PackedVertex2D/PackedVertex3D streams, about half the vertex
+     * bandwidth and buffer space; the float streams keep the rest. 2D draws
+     * under a custom shader stay full precision. Packing reads the vertices back on
+     * the CPU, so it is skipped while mapped storage is bound.
+     * Persists across reset().
+     * @param enabled Enable vertex compression
+     */
+    void setVertexCompression(bool enabled) { compressVertices_ = enabled; }
+
+    /**
+     * Check whether vertex compression is enabled.
+     */
+    bool isVertexCompressionEnabled() const { return compressVertices_; }
+
+    /**
+     * Let ofDrawSphere/ofDrawCylinder/ofDrawIcoSphere record
+     * DrawMeshPrimitivesCommand when the renderer supports mesh shaders,
+     * instead of instancing a tessellated unit mesh. Lists replayed outside
+     * the frame they were recorded in (display lists, shadow casters)
+     * turn it off. Persists across reset().
+     * @param enabled Enable mesh-shader primitives
+     */
+    void setMeshPrimitives(bool enabled) { meshPrimitives_ = enabled; }
+
+    /**
+     * Check whether mesh-shader primitives are enabled.
+     */
+    bool isMeshPrimitivesEnabled() const { return meshPrimitives_; }
+
+    /**
+     * Get the number of commands stored packed by the last optimize().
+     */
+    size_t getPackedCommandCount() const { return packedCommandCount_; }
+
+    /**
+     * Check whether transform baking is enabled.
+     */
+    bool isTransformBakingEnabled() const { return bakeTransforms_; }
+
+    /**
+     * Get the largest command (in vertices) baked by optimize().
+     */
+    uint32_t getTransformBakingMaxVertices() const { return bakeMaxVertices_; }
+
+    /**
+     * Get the number of commands baked into world space by the last optimize().
+     */
+    size_t getBakedCommandCount() const { return bakedCommandCount_; }
+
     /**
      * Get statistics about batching effectiveness.
      * @return Number of commands that were batched together
      */
     size_t getBatchCount() const { return batchCount_; }
 
+    /**
+     * Get the number of commands removed by pass coalescing in the last optimize().
+     */
+    size_t getCoalescedCommandCount() const { return coalescedCommandCount_; }
+
+    /**
+     * Count a draw that was skipped before recording (outside the view frustum).
+     */
+    void addCulledDraw() { culledDrawCount_++; }
+
+    /**
+     * Get the number of draws culled since the last reset().
+     */
+    size_t getCulledDrawCount() const { return culledDrawCount_; }
+
     /**
      * Get the number of commands before optimization.
      * @return Original command count
@@ -343,23 +1145,116 @@ public:
     size_t getOriginalCommandCount() const { return originalCommandCount_; }
 
 private:
-    // Command buffer
-    std::vector<DrawCommand> commands_;
+    // Capture files read and rebuild every stream and side table
+    friend class metal::DrawListCapture;
+    friend class metal::DrawListReplay;
+
+    // Command buffer (packed, variable-size records)
+    CommandStream commands_;
+
+    // Side tables referenced by index from commands
+    std::vector<LightingState> lightingStates_;
+    std::vector<float> lightData_;          // Light pool referenced by lightingStates_
+    std::vector<ShadowState> shadowStates_; // Referenced by lightingStates_
+    std::vector<TextureBatch2D> textureBatches_;
 
     // Vertex buffers
     std::vector<Vertex2D> vertices2D_;
     std::vector<Vertex3D> vertices3D_;
 
+    // Packed vertex streams (VertexFormat::Packed commands, see packVertices)
+    std::vector<PackedVertex2D> packedVertices2D_;
+    std::vector<PackedVertex3D> packedVertices3D_;
+
+    // Streams replaced by packVertices(), kept for their capacity
+    std::vector<Vertex2D> scratchVertices2D_;
+    std::vector<Vertex3D> scratchVertices3D_;
+    std::vector<PackedVertex2D> scratchPacked2D_;
+    std::vector<PackedVertex3D> scratchPacked3D_;
+
     // Index buffer (shared between 2D and 3D)
     std::vector<uint32_t> indices_;
 
+    // Instance records for instanced draws without their own buffer
+    std::vector<InstanceData> instances_;
+
+    // SDF shape records for DrawCommand2DShapes
+    std::vector<ShapeInstance2D> shapes_;
+
+    // Stroke segment records for DrawCommand2DStroke
+    std::vector<StrokeSegment2D> strokeSegments_;
+
+    // Path records and their edges for DrawCommand2DPaths
+    std::vector<PathInstance2D> paths_;
+    std::vector<PathSegment2D> pathSegments_;
+
+    // Custom shader uniform snapshots, kUniformAlignment apart
+    std::vector<uint8_t> uniformData_;
+
+    // Scratch memory for the frame being recorded (see allocateTransient)
+    FrameArena arena_;
+
+    // Mapped GPU storage (zero-copy mode)
+    MappedStorage mapped_;
+    size_t mappedCount2D_ = 0;
+    size_t mappedCount3D_ = 0;
+    size_t mappedIndexCount_ = 0;
+    bool mappedOverflow_ = false;
+
+    // Incremented on reset() (invalidates cached side table handles)
+    uint64_t generation_ = 0;
+
+    // Ordered regions as [first, last) command indices; last is open while
+    // the region is active (see beginOrderedRegion)
+    struct OrderedRange {
+        uint32_t first;
+        uint32_t last;
+    };
+    std::vector<OrderedRange> orderedRanges_;
+    std::vector<size_t> openOrderedRegions_;
+
     // Optimization statistics
     size_t batchCount_ = 0;
     size_t originalCommandCount_ = 0;
+    size_t bakedCommandCount_ = 0;
+    size_t coalescedCommandCount_ = 0;
+    size_t packedCommandCount_ = 0;
+    size_t culledDrawCount_ = 0;
+
+    // Transform baking (optimize() merges across 2D transforms)
+    bool bakeTransforms_ = false;
+    uint32_t bakeMaxVertices_ = 64;
+
+    // Texture batching (optimize() merges across 2D textures)
+    bool batchTextures_ = false;
+
+    // Vertex compression (optimize() packs eligible vertex ranges)
+    bool compressVertices_ = false;
+
+    // Mesh-shader primitives (ofDrawSphere and friends)
+    bool meshPrimitives_ = true;
+
+    // Copy mapped geometry back to the CPU vectors and unbind the mapping
+    void spillMappedStorage();
 
     // Helper methods for optimization
-    bool canBatch2D(const DrawCommand2D& a, const DrawCommand2D& b) const;
+    bool canBatch2D(const DrawCommand2D& a, const DrawCommand2D& b,
+                    bool compareTransform = true, bool compareTexture = true) const;
+    bool canAppendTexture(const DrawCommand2D& batch, const DrawCommand2D& next) const;
+    void appendTexture(DrawCommand2D& batch, const DrawCommand2D& next);
+    bool canBakeTransform2D(const DrawCommand2D& cmd) const;
+    void bakeTransform2D(DrawCommand2D& cmd);
+    void rebaseIndices(uint32_t indexOffset, uint32_t indexCount, uint32_t delta);
     bool canBatch3D(const DrawCommand3D& a, const DrawCommand3D& b) const;
+    bool canBatchInstanced(const DrawCommand3DInstanced& a, const DrawCommand3DInstanced& b) const;
+    bool canBatchMeshPrimitives(const DrawMeshPrimitivesCommand& a, const DrawMeshPrimitivesCommand& b) const;
+    bool canBatchShapes(const DrawCommand2DShapes& a, const DrawCommand2DShapes& b) const;
+    bool canBatchStroke(const DrawCommand2DStroke& a, const DrawCommand2DStroke& b) const;
+    bool canBatchPaths(const DrawCommand2DPaths& a, const DrawCommand2DPaths& b) const;
+    bool canPack2D(const DrawCommand2D& cmd, const Vertex2D* vertices) const;
+    bool canPack3D(const DrawCommand3D& cmd, const Vertex3D* vertices) const;
+    void packVertices();
+    bool isReorderable3D(const DrawCommand3D& cmd, const ReorderOptions& options) const;
     bool matricesEqual(const simd_float4x4& a, const simd_float4x4& b) const;
     bool matricesEqual3x3(const simd_float3x3& a, const simd_float3x3& b) const;
 };
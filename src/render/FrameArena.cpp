@@ -0,0 +1,64 @@
+#include "FrameArena.h"
+#include <algorithm>
+
+namespace render {
+
+// ============================================================================
+// FrameArena Implementation
+// ============================================================================
+
+FrameArena::FrameArena(size_t blockSize)
+    : blockSize_(std::max<size_t>(blockSize, 256)) {
+}
+
+void* FrameArena::bump(size_t index, size_t bytes, size_t alignment) {
+    Block& block = blocks_[index];
+    const size_t start = index == current_ ? offset_ : 0;
+    const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+    const uintptr_t aligned = (base + start + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    const size_t end = static_cast<size_t>(aligned - base) + bytes;
+    if (end > block.size) {
+        return nullptr;
+    }
+
+    used_ += end - start;
+    current_ = index;
+    offset_ = end;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    if (bytes == 0) {
+        return nullptr;
+    }
+
+    // The current block, then blocks kept from earlier frames, then a new one
+    for (size_t i = current_; i < blocks_.size(); i++) {
+        if (void* p = bump(i, bytes, alignment)) {
+            return p;
+        }
+    }
+
+    Block block;
+    block.size = std::max(blockSize_, bytes + alignment);
+    block.data.reset(new uint8_t[block.size]);
+    capacity_ += block.size;
+    blocks_.push_back(std::move(block));
+    return bump(blocks_.size() - 1, bytes, alignment);
+}
+
+void FrameArena::reset() {
+    if (blocks_.size() > 1) {
+        // One block that holds what the frame used
+        Block block;
+        block.size = capacity_;
+        block.data.reset(new uint8_t[block.size]);
+        blocks_.clear();
+        blocks_.push_back(std::move(block));
+    }
+    current_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
+
+} // namespace render
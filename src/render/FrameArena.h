@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace render {
+
+// ============================================================================
+// FrameArena - Bump allocator for per-frame scratch memory
+// ============================================================================
+
+/**
+ * FrameArena hands out memory that lives until the next reset(), for
+ * scratch data built while recording a frame (outline points, temporary
+ * geometry) that would otherwise be a heap allocation per call.
+ *
+ * Allocations bump a pointer through large blocks and never move, so a
+ * range stays valid while later ones are made. reset() frees nothing; when
+ * a frame needed more than one block, the blocks are replaced by a single
+ * one of their combined size, so a steady workload settles on one block
+ * and stops allocating.
+ *
+ * Only trivially destructible types: nothing is destroyed on reset().
+ *
+ * Usage:
+ *   simd_float2* points = arena.allocate<simd_float2>(count);
+ *   // ... fill and use until the end of the frame ...
+ *   arena.reset();
+ */
+class FrameArena {
+public:
+    static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+    explicit FrameArena(size_t blockSize = kDefaultBlockSize);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    FrameArena(FrameArena&&) noexcept = default;
+    FrameArena& operator=(FrameArena&&) noexcept = default;
+
+    /**
+     * Allocate uninitialized bytes.
+     * @param bytes Size in bytes
+     * @param alignment Power of two
+     * @return Pointer valid until reset(), or nullptr if bytes is 0
+     */
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * Allocate an uninitialized array of count T.
+     * @param count Number of elements
+     * @return Pointer valid until reset(), or nullptr if count is 0
+     */
+    template <typename T>
+    T* allocate(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Arena memory is released without running destructors");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * Release every allocation, keeping the memory for the next frame.
+     */
+    void reset();
+
+    /**
+     * Get the bytes handed out since the last reset (including alignment).
+     * @return Used bytes
+     */
+    size_t getUsedBytes() const { return used_; }
+
+    /**
+     * Get the bytes held in blocks.
+     * @return Capacity in bytes
+     */
+    size_t getCapacity() const { return capacity_; }
+
+private:
+    struct Block {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size = 0;
+    };
+
+    std::vector<Block> blocks_;
+    size_t blockSize_;
+    size_t current_ = 0;    // Block being bumped
+    size_t offset_ = 0;     // Bytes used in the current block
+    size_t used_ = 0;
+    size_t capacity_ = 0;
+
+    // Bump within block index, or return nullptr if it doesn't fit
+    void* bump(size_t index, size_t bytes, size_t alignment);
+};
+
+} // namespace render
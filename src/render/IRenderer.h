@@ -6,6 +6,25 @@
 
 namespace render {
 
+/**
+ * GPU timing of one pass (encoder) in the last completed frame.
+ * Passes are in submission order; startMs is relative to the first pass.
+ */
+struct GPUPassTiming {
+    char name[32];          ///< e.g. "Screen", "RenderTarget 512x512", "Sharp Sort"
+    double startMs;
+    double durationMs;
+};
+
+/// Most frames a renderer queues on the GPU at once (triple buffering);
+/// IRenderer::setMaxFramesInFlight() may lower it
+constexpr uint32_t kMaxFramesInFlight = 3;
+
+/// Frames after the one a command was recorded in during which the GPU may
+/// still read what the command references. A resource replaced in frame f
+/// can be released once the current frame is past f + kRetireFrames.
+constexpr unsigned long long kRetireFrames = kMaxFramesInFlight;
+
 // ============================================================================
 // IRenderer - Abstract Renderer Interface
 // ============================================================================
@@ -73,6 +92,34 @@ public:
      */
     virtual uint32_t getCurrentFrameIndex() const = 0;
 
+    /**
+     * Limit how many frames may be queued on the GPU at once.
+     * Fewer frames in flight cut latency; more keep the GPU busy.
+     * Call between frames; blocks until enough queued frames complete.
+     * @param frames 1 to the renderer's maximum; clamped
+     */
+    virtual void setMaxFramesInFlight(uint32_t frames) { (void)frames; }
+
+    /**
+     * Get the limit set by setMaxFramesInFlight().
+     * @return Frames that may be queued on the GPU at once
+     */
+    virtual uint32_t getMaxFramesInFlight() const { return 1; }
+
+    /**
+     * Wait for a free frame slot ahead of beginFrame(), which then starts
+     * at once: work done in between (input sampling, update()) happens as
+     * late as possible before the frame is recorded.
+     */
+    virtual void acquireFrameSlot() {}
+
+    /**
+     * Keep each presented frame on screen for at least this long, so frames
+     * are paced evenly on variable refresh rate displays.
+     * @param seconds Minimum duration, 0 to present as soon as possible
+     */
+    virtual void setPresentMinimumDuration(double seconds) { (void)seconds; }
+
     // ========================================================================
     // DrawList Execution
     // ========================================================================
@@ -84,6 +131,117 @@ public:
      */
     virtual bool executeDrawList(const DrawList& drawList) = 0;
 
+    /**
+     * Execute several DrawLists (e.g. recorded on worker threads) in order.
+     * The result is identical to calling executeDrawList() on each list in
+     * sequence; renderers may encode the lists in parallel.
+     * @param drawLists Lists in encode order
+     * @param count Number of lists
+     * @return true on success
+     */
+    virtual bool executeDrawLists(const DrawList* const* drawLists, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!executeDrawList(*drawLists[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Let a DrawList write geometry straight into this frame's GPU buffers.
+     * Call after beginFrame() and before recording draw calls. When bound,
+     * executeDrawList() skips its vertex/index upload entirely.
+     * @param drawList The DrawList to bind
+     * @return true if zero-copy storage was bound
+     */
+    virtual bool bindFrameStorage(DrawList& drawList) { (void)drawList; return false; }
+
+    /**
+     * Create built-in pipeline variants ahead of their first draw.
+     * Variants are otherwise compiled on demand, which can hitch the frame
+     * that first uses a blend mode or target format; call this during a
+     * loading screen with the variants the app draws with.
+     * @param variants Variants to create
+     * @param count Number of variants
+     * @return Number of variants available afterwards
+     */
+    virtual size_t prewarm(const PipelineVariant* variants, size_t count) {
+        (void)variants; (void)count; return 0;
+    }
+
+    /**
+     * Create a render pipeline through the renderer's pipeline cache.
+     * Compiled pipelines are kept in a binary archive persisted across
+     * launches, so later creations of the same descriptor skip compilation.
+     * Safe to call from any thread.
+     * @param descriptor Native pipeline descriptor (MTLRenderPipelineDescriptor*)
+     * @param reflection If given, receives the retained pipeline reflection
+     *        (MTLRenderPipelineReflection*, with binding info), or nullptr
+     * @return Retained native pipeline handle (id<MTLRenderPipelineState>), or nullptr
+     *         on failure; the caller takes ownership (e.g. __bridge_transfer)
+     */
+    virtual void* createRenderPipelineState(void* descriptor, void** reflection = nullptr) {
+        (void)descriptor;
+        if (reflection) *reflection = nullptr;
+        return nullptr;
+    }
+
+    /**
+     * Get a compute pipeline for a kernel in the renderer's shader library.
+     * Pipelines are created on first use and cached; use the handle in
+     * DispatchComputeCommand::pipelineState.
+     * @param functionName Kernel function name
+     * @return Native pipeline handle (id<MTLComputePipelineState>), or nullptr if unavailable
+     */
+    virtual void* getComputePipelineState(const char* functionName) { (void)functionName; return nullptr; }
+
+    /**
+     * Build an occlusion pyramid from the screen's depth at the end of each frame.
+     * Keeps the view's depth stored after its last pass; multisampled and
+     * memoryless screen depth builds none.
+     * @param enabled true to build the pyramid
+     */
+    virtual void setOcclusionCullingEnabled(bool enabled) { (void)enabled; }
+
+    /**
+     * Get the occlusion pyramid built at the end of the previous frame.
+     * Level 0 is the screen's depth at full resolution (top-left origin);
+     * each texel of a smaller level holds the farthest depth of the level 0
+     * texels it covers.
+     * @return Native texture (id<MTLTexture>, R32Float, mipmapped), or nullptr
+     *         if occlusion culling is off or the last frame built none
+     */
+    virtual void* getOcclusionPyramid() const { return nullptr; }
+
+    /**
+     * Read the object ID drawn at a point of the screen in the frame being
+     * recorded. That frame's screen 3D draws are replayed into an ID target
+     * with their DrawCommand3D::objectId, and the texel is copied out when
+     * the frame ends; the result is available once the frame completes.
+     * @param x Horizontal position as a fraction of the screen (0 = left)
+     * @param y Vertical position as a fraction of the screen (0 = top)
+     */
+    virtual void requestObjectIdPick(float x, float y) { (void)x; (void)y; }
+
+    /**
+     * Get the result of the most recent completed pick.
+     * @param outObjectId Receives the frontmost object ID at the point (0 = none)
+     * @param outFrameSerial Receives the serial of the frame it was read from
+     *        (see getRecordingFrameSerial())
+     * @return false before the first pick completes or if unsupported
+     */
+    virtual bool getObjectIdPick(uint32_t& outObjectId, uint64_t& outFrameSerial) const {
+        (void)outObjectId; (void)outFrameSerial;
+        return false;
+    }
+
+    /**
+     * Check whether DrawMeshPrimitivesCommand can be drawn (object and mesh
+     * shaders). Without it, ofDrawSphere and friends instance a tessellated mesh.
+     */
+    virtual bool supportsMeshPrimitives() const { return false; }
+
     // ========================================================================
     // Render State
     // ========================================================================
@@ -164,6 +322,65 @@ public:
      */
     virtual void* getDefaultRenderTarget() const = 0;
 
+    /**
+     * Shade a render target at reduced resolution away from where detail matters.
+     * Its passes rasterize through a rate map into a smaller physical
+     * texture, resolved to full size when the target's contents are next
+     * needed (switching targets, copies and readbacks, the end of the
+     * frame). Viewports and scissors stay in target pixels, but fragment
+     * positions are physical; the resolve replaces the target's contents,
+     * so clear it on every begin(). Multisampled targets and screens draw
+     * at full rate; the screen builds no occlusion pyramid while it has a rate.
+     * @param renderTarget Handle to render target (MTLTexture), or nullptr for screen
+     * @param rate Zones to shade at each rate; empty = full rate
+     * @return false if the GPU has no rate maps (the target draws at full rate)
+     */
+    virtual bool setRasterizationRate(void* renderTarget, const RasterizationRate& rate) {
+        (void)renderTarget; (void)rate;
+        return false;
+    }
+
+    // ========================================================================
+    // Display Outputs
+    // ========================================================================
+
+    /**
+     * Show part of the display output source on another display.
+     * At the end of every frame each output takes a drawable from its
+     * layer, draws its slice of the source warped and edge-blended in one
+     * pass, and presents it from the frame's command buffer with the view's
+     * drawable, so every display shows the same frame. The scene is
+     * rendered once, into the source.
+     * @param metalLayer CAMetalLayer of the display's window; its device is
+     *        set to the renderer's and its drawableSize is left as is
+     * @return Output ID (> 0), or -1 if unsupported
+     */
+    virtual int addDisplayOutput(void* metalLayer) { (void)metalLayer; return -1; }
+
+    /**
+     * Stop drawing an output; its layer is no longer referenced.
+     * @param output ID from addDisplayOutput()
+     */
+    virtual void removeDisplayOutput(int output) { (void)output; }
+
+    /**
+     * Set an output's slice, warp and edge blend.
+     * @param output ID from addDisplayOutput()
+     * @param config Slice of the source and how it is drawn
+     * @return false for an unknown output or a warp grid of the wrong size
+     */
+    virtual bool setDisplayOutputConfig(int output, const DisplayOutputConfig& config) {
+        (void)output; (void)config;
+        return false;
+    }
+
+    /**
+     * Set the texture the outputs slice, typically an atlas FBO drawn
+     * every frame; nullptr draws no outputs.
+     * @param texture Handle to the texture (MTLTexture)
+     */
+    virtual void setDisplayOutputSource(void* texture) { (void)texture; }
+
     // ========================================================================
     // Texture Management
     // ========================================================================
@@ -177,6 +394,121 @@ public:
      */
     virtual void* createTexture(uint32_t width, uint32_t height, const void* data) = 0;
 
+    /**
+     * Create a texture in a given format.
+     * Single-channel formats sample as grayscale (r, r, r, 1) and two-channel
+     * formats as grayscale + alpha (r, r, r, g), so they draw like RGBA.
+     * @param width Texture width in pixels
+     * @param height Texture height in pixels
+     * @param format Texel format; data is tightly packed in this format
+     * @param data Pixel data, or nullptr for uninitialized contents
+     * @return Handle to the created texture, or nullptr on failure
+     */
+    virtual void* createTexture(uint32_t width, uint32_t height, TextureFormat format, const void* data) {
+        return format == TextureFormat::RGBA8 ? createTexture(width, height, data) : nullptr;
+    }
+
+    /**
+     * Create a texture with storage for a full mip chain.
+     * Only the base level is initialized; record a GenerateMipmapsCommand
+     * after each upload to fill the others. Formats the GPU can't filter get
+     * a single level.
+     * @param width Base level width in pixels
+     * @param height Base level height in pixels
+     * @param format Texel format; data is tightly packed in this format
+     * @param data Base level pixel data, or nullptr for uninitialized contents
+     * @return Handle to the created texture, or nullptr on failure
+     */
+    virtual void* createMipmappedTexture(uint32_t width, uint32_t height, TextureFormat format, const void* data) {
+        return createTexture(width, height, format, data);
+    }
+
+    /**
+     * Create a texture that GPU image filters and compute kernels can write.
+     * Sampled and updated like any other texture.
+     * @param width Texture width in pixels
+     * @param height Texture height in pixels
+     * @param format Texel format (RGBA8, RGBA16, RGBA16F or RGBA32F)
+     * @return Handle to the created texture (uninitialized contents), or
+     *         nullptr on failure or for other formats
+     */
+    virtual void* createWritableTexture(uint32_t width, uint32_t height, TextureFormat format) {
+        (void)width; (void)height; (void)format;
+        return nullptr;
+    }
+
+    /**
+     * Create a texture for contents replaced every frame or so (video, camera,
+     * dynamic images). Textures from the other create functions may live in
+     * GPU-only memory, their uploads copied in ahead of the next frame's
+     * passes; a streaming texture stays CPU-writable so updates land in place.
+     * @param width Texture width in pixels
+     * @param height Texture height in pixels
+     * @param format Texel format
+     * @return Handle to the created texture (uninitialized contents), or nullptr on failure
+     */
+    virtual void* createStreamingTexture(uint32_t width, uint32_t height, TextureFormat format) {
+        return createTexture(width, height, format, nullptr);
+    }
+
+    /**
+     * Set the staging memory for uploads into GPU-only textures.
+     * Uploads are packed into batches of this size; each fills before it is
+     * copied, and a full batch is copied at once rather than at the next
+     * frame, so larger budgets mean fewer copy submissions.
+     * @param bytes Batch size in bytes
+     */
+    virtual void setTextureUploadBudget(size_t bytes) { (void)bytes; }
+
+    /**
+     * Get the staging batch size for texture uploads.
+     * @return Batch size in bytes (0 if uploads are not staged)
+     */
+    virtual size_t getTextureUploadBudget() const { return 0; }
+
+    /**
+     * Check if the GPU can sample a block-compressed format.
+     * @param format Block format
+     * @return true if createCompressedTexture() accepts the format
+     */
+    virtual bool supportsCompressedTextureFormat(CompressedTextureFormat format) const {
+        (void)format;
+        return false;
+    }
+
+    /**
+     * Create a block-compressed texture from pre-encoded mip levels.
+     * @param width Base level width in pixels
+     * @param height Base level height in pixels
+     * @param format Block format
+     * @param levels Block data of each mip level, base level first; level i
+     *        holds compressedLevelBytes() of its size (max(1, width >> i) ...)
+     * @param levelCount Number of mip levels (1 to the full chain)
+     * @return Handle to the created texture, or nullptr on failure or for
+     *         formats the GPU can't sample
+     */
+    virtual void* createCompressedTexture(uint32_t width, uint32_t height, CompressedTextureFormat format,
+                                          const void* const* levels, uint32_t levelCount) {
+        (void)width; (void)height; (void)format; (void)levels; (void)levelCount;
+        return nullptr;
+    }
+
+    /**
+     * Upload pixel data into a sub-region of an existing texture.
+     * @param texture Handle to the texture
+     * @param x Region left edge in pixels
+     * @param y Region top edge in pixels
+     * @param width Region width in pixels
+     * @param height Region height in pixels
+     * @param data Pixel data in the texture's format; for block-compressed
+     *        textures, rows of blocks, with the region starting on a block
+     *        and ending on one or at the texture's edge
+     * @param bytesPerRow Bytes per source row (of blocks when compressed)
+     * @return true on success, false if the region falls outside the texture
+     */
+    virtual bool updateTexture(void* texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+                               const void* data, size_t bytesPerRow) = 0;
+
     /**
      * Load a texture from file.
      * @param path File path
@@ -240,11 +572,78 @@ public:
      */
     virtual void getStatistics(uint32_t& outDrawCalls, uint32_t& outVertices) const = 0;
 
+    /**
+     * Get rendering statistics for the last frame, including state filtering.
+     * @param outDrawCalls Number of draw calls
+     * @param outVertices Number of vertices rendered
+     * @param outSkippedStateChanges Encoder calls skipped because the state was already bound
+     */
+    virtual void getStatistics(uint32_t& outDrawCalls, uint32_t& outVertices,
+                               uint32_t& outSkippedStateChanges) const {
+        getStatistics(outDrawCalls, outVertices);
+        outSkippedStateChanges = 0;
+    }
+
+    /**
+     * Get rendering statistics for the last frame, including culling.
+     * @param outDrawCalls Number of draw calls
+     * @param outVertices Number of vertices rendered
+     * @param outSkippedStateChanges Encoder calls skipped because the state was already bound
+     * @param outCulledDraws Mesh draws skipped as outside the view frustum
+     */
+    virtual void getStatistics(uint32_t& outDrawCalls, uint32_t& outVertices,
+                               uint32_t& outSkippedStateChanges, uint32_t& outCulledDraws) const {
+        getStatistics(outDrawCalls, outVertices, outSkippedStateChanges);
+        outCulledDraws = 0;
+    }
+
     /**
      * Get the last GPU frame time in milliseconds.
      * @return GPU time in ms, or 0.0 if unsupported
      */
     virtual double getLastGPUTime() const { return 0.0; }
+
+    /**
+     * Get the serial of the frame that will show work recorded now: the
+     * frame between beginFrame() and endFrame(), or else the next one.
+     * Serials count frames from 1.
+     * @return Frame serial, or 0 if unsupported
+     */
+    virtual uint64_t getRecordingFrameSerial() const { return 0; }
+
+    /**
+     * Get when the most recently displayed frame reached the screen.
+     * @param outFrameSerial Receives its serial (see getRecordingFrameSerial())
+     * @param outPresentedTime Receives its presentation time in seconds on
+     *        the host clock (CACurrentMediaTime())
+     * @return false before the first presentation or if unsupported
+     */
+    virtual bool getLastPresentedFrame(uint64_t& outFrameSerial, double& outPresentedTime) const {
+        (void)outFrameSerial; (void)outPresentedTime;
+        return false;
+    }
+
+    /**
+     * Get the per-pass GPU timeline of the last completed frame.
+     * Requires stage-boundary counter sampling (Apple GPUs); empty otherwise.
+     * @param outPasses Receives up to maxPasses entries
+     * @param maxPasses Capacity of outPasses
+     * @return Number of entries written
+     */
+    virtual size_t getGPUTimeline(GPUPassTiming* outPasses, size_t maxPasses) const {
+        (void)outPasses; (void)maxPasses; return 0;
+    }
+
+    /**
+     * Add timestamps for an externally encoded pass to the frame timeline.
+     * Call before creating the encoder from the descriptor, during the frame.
+     * @param passDescriptor MTLRenderPassDescriptor* or MTLComputePassDescriptor*
+     * @param name Timeline label (truncated to 31 characters)
+     * @return true if the pass will be timed
+     */
+    virtual bool attachGPUTimestamps(void* passDescriptor, const char* name) {
+        (void)passDescriptor; (void)name; return false;
+    }
 };
 
 } // namespace render
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <simd/simd.h>
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace render {
 
@@ -60,6 +62,144 @@ struct Vertex3D {
         , color(simd_make_float4(r, g, b, a)) {}
 };
 
+/// Encoding of a draw command's vertex range
+enum class VertexFormat : uint8_t {
+    Float   = 0,    // Vertex2D / Vertex3D
+    Packed  = 1,    // PackedVertex2D / PackedVertex3D
+};
+
+/// Compressed 2D vertex (16 bytes instead of 32; matches PackedVertex2D in
+/// Common.h). Position stays full float; texture coordinates are unorm16
+/// and color is unorm8 RGBA. DrawList::setVertexCompression() moves draws
+/// whose values fit these ranges into this format.
+struct PackedVertex2D {
+    simd_float2 position;
+    uint32_t texCoord;      // unorm16 u | v << 16
+    uint32_t color;         // unorm8 RGBA, r in the low byte
+};
+
+/// Compressed 3D vertex (28 bytes instead of 64; matches PackedVertex3D in
+/// Common.h). Position stays full float; the normal is snorm16, texture
+/// coordinates unorm16 and color unorm8 RGBA.
+struct PackedVertex3D {
+    float position[3];
+    uint32_t normalXY;      // snorm16 x | y << 16
+    uint32_t normalZ;       // snorm16 z, high half zero
+    uint32_t texCoord;      // unorm16 u | v << 16
+    uint32_t color;         // unorm8 RGBA, r in the low byte
+};
+
+/// Per-instance record read by the instanced 3D vertex shaders
+/// (matches InstanceData in Common.h and VboInstanceData)
+struct InstanceData {
+    simd_float4x4 modelMatrix;  // Instance transform, applied before model-view
+    simd_float4 color;          // Multiplied with the vertex color
+    simd_float4 userData;       // Not read by the built-in shaders
+};
+
+/// Analytic shape evaluated by the SDF shape shader
+enum class ShapeKind2D : uint32_t {
+    Ellipse         = 0,    // Circles and ellipses (halfSize = radii)
+    RoundedRect     = 1,    // Boxes with optional corner radius (thick lines too)
+};
+
+/// Per-shape record read by the SDF shape shaders (matches ShapeInstance2D
+/// in Common.h). The shape is drawn as one quad in its own frame: centered
+/// on center, x along axis, y along its perpendicular.
+struct ShapeInstance2D {
+    simd_float2 center;         // Shape center
+    simd_float2 axis;           // Unit x axis of the shape frame, (1, 0) = axis aligned
+    simd_float2 halfSize;       // Half extents along the frame axes
+    float cornerRadius;         // RoundedRect corner radius
+    float strokeWidth;          // Outline width centered on the edge, 0 = filled
+    simd_float4 color;          // RGBA color (0.0-1.0 range)
+    ShapeKind2D kind;
+    uint32_t padding[3];
+};
+
+/// Join drawn where a stroke segment meets the next one
+enum class StrokeJoin2D : uint32_t {
+    Miter           = 0,    // Sharp corner, beveled past the miter limit
+    Round           = 1,    // Circular arc
+    Bevel           = 2,    // Straight cut across the corner
+};
+
+/// Cap drawn at the open ends of a stroke
+enum class StrokeCap2D : uint32_t {
+    Butt            = 0,    // Ends exactly at the end point
+    Round           = 1,    // Half circle past the end point
+    Square          = 2,    // Half a width past the end point
+};
+
+/// Flags of StrokeSegment2D
+constexpr uint32_t kStrokeHasPrevious = 1u << 0;   // Another segment ends at p0 (no start cap)
+constexpr uint32_t kStrokeHasNext = 1u << 1;       // next continues the stroke (join, no end cap)
+
+/// Arc triangles per round join/cap; each segment expands to a fixed
+/// kStrokeVerticesPerSegment vertices (body quad, end piece, start cap)
+/// and unused triangles collapse to a point
+constexpr uint32_t kStrokeArcTriangles = 8;
+constexpr uint32_t kStrokeVerticesPerSegment = 6 + 2 * 3 * kStrokeArcTriangles;
+
+/// Per-segment record read by the stroke vertex shader (matches
+/// StrokeSegment2D in Common.h). Each segment owns the join at its end,
+/// toward next; neighbours never repeat geometry, so translucent strokes
+/// only overlap on the inside of corners.
+struct StrokeSegment2D {
+    simd_float2 p0;             // Segment start
+    simd_float2 p1;             // Segment end
+    simd_float2 next;           // Point after p1 (kStrokeHasNext)
+    float halfWidth;            // Half the line width
+    uint32_t flags;             // kStrokeHasPrevious | kStrokeHasNext
+    simd_float4 color;          // RGBA color (0.0-1.0 range)
+    StrokeJoin2D join;
+    StrokeCap2D cap;
+    float miterLimit;           // Max miter length / half width before beveling
+    uint32_t padding;
+};
+
+/// Per-path record read by the path coverage shaders (matches
+/// PathInstance2D in Common.h). The path is drawn as one quad over its
+/// bounds; the fragment shader computes coverage from the winding number of
+/// segmentCount edges of the path segment stream, so fills need no CPU
+/// triangulation.
+struct PathInstance2D {
+    simd_float2 boundsMin;      // Bounds of the edges, in model space
+    simd_float2 boundsMax;
+    simd_float4 color;          // RGBA color (0.0-1.0 range)
+    uint32_t segmentOffset;     // First edge in the path segment stream
+    uint32_t segmentCount;      // Number of edges
+    uint32_t fillRule;          // ofPolyWindingMode value (0 = odd, 1 = nonzero, ...)
+    uint32_t padding;
+};
+
+/// One edge of a filled path (matches PathSegment2D in Common.h); contours
+/// are closed, so every contour contributes its closing edge too
+struct PathSegment2D {
+    simd_float2 p0;
+    simd_float2 p1;
+};
+
+/// Points sharing one PointCloudChunk's bounds
+constexpr uint32_t kPointCloudChunkSize = 256;
+
+/// One point of a resident point cloud, 10 bytes (matches PointCloudPoint
+/// in PointCloud.metal). The position is unorm16 within the bounds of the
+/// chunk of kPointCloudChunkSize points it belongs to, like the compressed
+/// Gaussian splats of ofxSharp.
+struct PointCloudPoint {
+    uint16_t position[3];       // Unorm16 within the chunk's bounds
+    uint8_t color[4];           // Unorm8 RGBA
+};
+static_assert(sizeof(PointCloudPoint) == 10, "PointCloudPoint must stay tightly packed");
+
+/// Bounds of kPointCloudChunkSize consecutive points (matches
+/// PointCloudChunk in PointCloud.metal)
+struct PointCloudChunk {
+    float positionMin[3];
+    float positionExtent[3];    // max - min, 0 on flat axes
+};
+
 // ============================================================================
 // Primitive Type
 // ============================================================================
@@ -73,6 +213,27 @@ enum class PrimitiveType : uint32_t {
     TriangleStrip   = 4,    // MTLPrimitiveTypeTriangleStrip
 };
 
+// ============================================================================
+// Index Type
+// ============================================================================
+
+/// Index element width (compatible with Metal MTLIndexType)
+enum class IndexType : uint32_t {
+    UInt16          = 0,    // MTLIndexTypeUInt16
+    UInt32          = 1,    // MTLIndexTypeUInt32
+};
+
+/// Narrowest index type that addresses vertexCount vertices. 0xFFFF is the
+/// 16-bit primitive restart value for strips, so it is never used as an index.
+inline IndexType indexTypeForVertexCount(size_t vertexCount) {
+    return vertexCount <= 0xFFFF ? IndexType::UInt16 : IndexType::UInt32;
+}
+
+/// Size in bytes of one index
+inline size_t indexSize(IndexType type) {
+    return type == IndexType::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
 // ============================================================================
 // Blend Mode
 // ============================================================================
@@ -102,19 +263,20 @@ enum class BlendMode : uint32_t {
     PremultipliedAlpha = 6,
 
     // Overlay blending: combines multiply and screen
-    // Note: Hardware approximation using screen blend
+    // Note: Blended in the fragment shader (framebuffer fetch) on Apple GPUs;
+    // hardware approximation using screen blend elsewhere
     Overlay         = 7,
 
     // Soft light blending: subtle lightening/darkening
-    // Note: Hardware approximation
+    // Note: Fragment shader on Apple GPUs; hardware approximation elsewhere
     SoftLight       = 8,
 
     // Hard light blending: similar to overlay with swapped src/dst roles
-    // Note: Hardware approximation using multiply blend
+    // Note: Fragment shader on Apple GPUs; multiply blend elsewhere
     HardLight       = 9,
 
     // Difference blending: abs(src - dst)
-    // Note: Hardware approximation using max blend operation
+    // Note: Fragment shader on Apple GPUs; max blend operation elsewhere
     Difference      = 10,
 };
 
@@ -139,6 +301,114 @@ struct BlendConfig {
     static BlendConfig forMode(BlendMode mode);
 };
 
+// ============================================================================
+// Variable Rasterization Rate
+// ============================================================================
+
+/// Shading resolution across a render target, for IRenderer::setRasterizationRate
+/// The target is split into equal columns and rows; horizontal[c] is the
+/// fraction of full resolution column c is shaded at along x, vertical[r]
+/// the fraction row r is shaded at along y (1 = every pixel, 0.5 = every
+/// other one). Rates are clamped to [kMinRasterizationRate, 1]; an empty
+/// axis is shaded at full rate, and an empty rate turns the map off.
+struct RasterizationRate {
+    std::vector<float> horizontal;
+    std::vector<float> vertical;
+
+    bool empty() const { return horizontal.empty() && vertical.empty(); }
+};
+
+/// Lowest rate a zone is shaded at
+constexpr float kMinRasterizationRate = 1.0f / 16.0f;
+
+// ============================================================================
+// Display Outputs
+// ============================================================================
+
+/// How one display shows its part of the display output source, for
+/// IRenderer::setDisplayOutputConfig
+/// The source (an atlas holding every display's content) is sliced, the
+/// slice drawn through a warp grid, and its edges faded for projector overlap.
+struct DisplayOutputConfig {
+    /// Slice of the source as fractions of its size (x, y, width, height)
+    simd_float4 source = {0.0f, 0.0f, 1.0f, 1.0f};
+
+    /// Warp grid of (warpColumns + 1) x (warpRows + 1) points, row by row
+    /// from the top-left: where slice position (c / warpColumns, r / warpRows)
+    /// lands on the display (0-1, top-left origin). Cells interpolate
+    /// bilinearly; no points = the slice fills the display.
+    uint32_t warpColumns = 0;
+    uint32_t warpRows = 0;
+    std::vector<simd_float2> warpPoints;
+
+    /// Edge blend widths as fractions of the slice (left, right, top, bottom)
+    simd_float4 blendWidth = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    /// Blend ramp steepness (1 = linear; overlapping ramps sum to 1 in
+    /// linear light for any value)
+    float blendCurve = 2.0f;
+
+    /// Display gamma the blend is encoded for (1 = none)
+    float blendGamma = 2.2f;
+};
+
+// ============================================================================
+// Pipeline Variants
+// ============================================================================
+
+/// Built-in shader programs; each implies its vertex layout
+enum class PipelineShader : uint32_t {
+    Solid2D         = 0,    // Vertex2D, vertex color
+    Textured2D      = 1,    // Vertex2D, texture * vertex color
+    Basic3D         = 2,    // Vertex3D, unlit
+    Lit3D           = 3,    // Vertex3D, Phong lighting
+    Instanced3D     = 4,    // Vertex3D + InstanceData, unlit
+    LitInstanced3D  = 5,    // Vertex3D + InstanceData, Phong lighting
+    TextureBatch2D  = 6,    // Vertex2D, per-range texture from a bound texture array
+    Shapes2D        = 7,    // ShapeInstance2D quads, analytic SDF coverage
+    Stroke2D        = 8,    // StrokeSegment2D expanded to quads, joins and caps
+    ShadowDepth     = 9,    // Vertex3D, depth only (shadow maps)
+    ShadowDepthInstanced = 10, // Vertex3D + InstanceData, depth only
+    DistanceField2D = 11,   // Vertex2D, coverage from a distance field texture's alpha
+    Path2D          = 12,   // PathInstance2D quads, coverage from the winding number of path edges
+    Transparent3D   = 13,   // Vertex3D, unlit, weighted blended transparency accumulation
+    LitTransparent3D = 14,  // Vertex3D, Phong lighting, transparency accumulation
+    TransparentInstanced3D = 15,    // Vertex3D + InstanceData, unlit, transparency accumulation
+    LitTransparentInstanced3D = 16, // Vertex3D + InstanceData, Phong lighting, transparency accumulation
+    TransparencyComposite = 17,     // Full-screen resolve of the accumulation over the pass
+    Retained3D      = 18,   // Vertex3D, unlit, encoded into display list indirect command buffers
+    RetainedInstanced3D = 19,       // Vertex3D + InstanceData, unlit, indirect command buffers
+    PointCloud      = 20,   // PointCloudPoint sprites, sized in pixels or attenuated with depth
+    ObjectId3D      = 21,   // Vertex3D, the draw's object ID (GPU picking)
+    ObjectIdInstanced3D = 22,       // Vertex3D + InstanceData, the draw's object ID
+    MeshPrimitive3D = 23,           // Object/mesh-shader unit primitives + InstanceData, unlit
+    LitMeshPrimitive3D = 24,        // Object/mesh-shader unit primitives + InstanceData, Phong lighting
+    ShadowDepthMeshPrimitive = 25,  // Object/mesh-shader unit primitives, depth only
+    ObjectIdMeshPrimitive3D = 26,   // Object/mesh-shader unit primitives, the draw's object ID
+};
+
+/// Identity of one built-in pipeline variant, used to prewarm the renderer's
+/// pipeline cache. Formats are native pixel formats (MTLPixelFormat); 0 means
+/// the screen's format. vertexFormat selects the packed vertex record for
+/// the Vertex2D/Vertex3D shaders and is ignored by Shapes2D, Stroke2D,
+/// Path2D, PointCloud and the mesh primitive shaders (no vertex records).
+/// Mesh primitive variants fail to compile without mesh shader support
+/// (IRenderer::supportsMeshPrimitives()).
+/// The shadow depth shaders have no color attachment; they ignore
+/// colorFormat and blendMode. The transparency accumulation shaders draw
+/// into their own RGBA16Float and R16Float attachments and also ignore both;
+/// depthFormat and sampleCount are the pass's. The object ID shaders draw
+/// into an R32Uint and Depth32Float target of their own and ignore every
+/// format and the blend mode.
+struct PipelineVariant {
+    PipelineShader shader = PipelineShader::Solid2D;
+    BlendMode blendMode = BlendMode::Alpha;
+    uint32_t colorFormat = 0;
+    uint32_t depthFormat = 0;
+    uint32_t sampleCount = 1;
+    VertexFormat vertexFormat = VertexFormat::Float;
+};
+
 // ============================================================================
 // Texture Types (API-agnostic)
 // ============================================================================
@@ -156,6 +426,43 @@ enum class TextureFilter : uint32_t {
     Linear  = 1,    // Linear interpolation
 };
 
+/// Mipmap filter mode
+enum class TextureMipFilter : uint32_t {
+    None    = 0,    // Not mipmapped (sample level 0)
+    Nearest = 1,    // Nearest mip level
+    Linear  = 2,    // Blend between mip levels (trilinear)
+};
+
+/// Packed sampler selection carried by draw commands.
+/// Bits: 0 min filter, 1 mag filter, 2-3 mip filter, 4-5 wrap S, 6-7 wrap T,
+/// 8-10 log2(max anisotropy). The renderer maps each key to a cached sampler.
+using SamplerKey = uint16_t;
+
+constexpr uint32_t kSamplerKeyCount = 1u << 11;
+
+/// Build a sampler key (anisotropy is rounded down to a power of two, 1-16)
+constexpr SamplerKey makeSamplerKey(TextureFilter minFilter, TextureFilter magFilter,
+                                    TextureMipFilter mipFilter,
+                                    TextureWrap wrapS, TextureWrap wrapT,
+                                    uint32_t maxAnisotropy = 1) {
+    uint32_t anisoLog2 = 0;
+    while (anisoLog2 < 4 && (2u << anisoLog2) <= maxAnisotropy) {
+        anisoLog2++;
+    }
+    return static_cast<SamplerKey>(
+        static_cast<uint32_t>(minFilter) |
+        (static_cast<uint32_t>(magFilter) << 1) |
+        (static_cast<uint32_t>(mipFilter) << 2) |
+        (static_cast<uint32_t>(wrapS) << 4) |
+        (static_cast<uint32_t>(wrapT) << 6) |
+        (anisoLog2 << 8));
+}
+
+/// Default sampler: linear, not mipmapped, clamp to edge
+constexpr SamplerKey kDefaultSamplerKey =
+    makeSamplerKey(TextureFilter::Linear, TextureFilter::Linear, TextureMipFilter::None,
+                   TextureWrap::Clamp, TextureWrap::Clamp);
+
 /// Texture format (API-agnostic)
 enum class TextureFormat : uint32_t {
     R8       = 0,    // 8-bit single channel (grayscale)
@@ -166,6 +473,72 @@ enum class TextureFormat : uint32_t {
     RGBA32F  = 5,    // 32-bit float RGBA
     R16      = 6,    // 16-bit unsigned integer single channel
     RGBA16   = 7,    // 16-bit unsigned integer RGBA
+    RG8      = 8,    // 8-bit two channel (grayscale + alpha)
+    RG16     = 9,    // 16-bit unsigned integer two channel
+    RG32F    = 10,   // 32-bit float two channel
 };
 
+/// Size in bytes of one texel
+inline size_t textureFormatBytesPerPixel(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::R8:      return 1;
+        case TextureFormat::RG8:     return 2;
+        case TextureFormat::R16:     return 2;
+        case TextureFormat::R16F:    return 2;
+        case TextureFormat::RGBA8:   return 4;
+        case TextureFormat::RG16:    return 4;
+        case TextureFormat::R32F:    return 4;
+        case TextureFormat::RGBA16:  return 8;
+        case TextureFormat::RGBA16F: return 8;
+        case TextureFormat::RG32F:   return 8;
+        case TextureFormat::RGBA32F: return 16;
+    }
+    return 4;
+}
+
+/// Block-compressed texture format (API-agnostic)
+/// Each format stores fixed-size blocks of texels; ASTC needs an Apple GPU,
+/// BC a Mac GPU (Apple silicon or discrete)
+enum class CompressedTextureFormat : uint32_t {
+    ASTC4x4   = 0,    // 8 bits per texel
+    ASTC5x5   = 1,    // 5.12 bits per texel
+    ASTC6x6   = 2,    // 3.56 bits per texel
+    ASTC8x8   = 3,    // 2 bits per texel
+    ASTC10x10 = 4,    // 1.28 bits per texel
+    ASTC12x12 = 5,    // 0.89 bits per texel
+    BC1       = 6,    // RGB (1-bit alpha), 4 bits per texel
+    BC3       = 7,    // RGBA, 8 bits per texel
+    BC7       = 8,    // RGBA, 8 bits per texel
+    BC4       = 9,    // Single channel (RGTC1), 4 bits per texel
+};
+
+/// Width and height in texels of one block
+inline uint32_t compressedBlockSize(CompressedTextureFormat format) {
+    switch (format) {
+        case CompressedTextureFormat::ASTC4x4:   return 4;
+        case CompressedTextureFormat::ASTC5x5:   return 5;
+        case CompressedTextureFormat::ASTC6x6:   return 6;
+        case CompressedTextureFormat::ASTC8x8:   return 8;
+        case CompressedTextureFormat::ASTC10x10: return 10;
+        case CompressedTextureFormat::ASTC12x12: return 12;
+        case CompressedTextureFormat::BC1:
+        case CompressedTextureFormat::BC3:
+        case CompressedTextureFormat::BC7:
+        case CompressedTextureFormat::BC4:       return 4;
+    }
+    return 4;
+}
+
+/// Size in bytes of one block
+inline size_t compressedBlockBytes(CompressedTextureFormat format) {
+    return (format == CompressedTextureFormat::BC1 || format == CompressedTextureFormat::BC4) ? 8 : 16;
+}
+
+/// Size in bytes of one mip level of the given texel size
+inline size_t compressedLevelBytes(CompressedTextureFormat format, uint32_t width, uint32_t height) {
+    const uint32_t block = compressedBlockSize(format);
+    return static_cast<size_t>((width + block - 1) / block) *
+           ((height + block - 1) / block) * compressedBlockBytes(format);
+}
+
 } // namespace render
@@ -0,0 +1,424 @@
+#include "TextureCompression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace render {
+
+// ============================================================================
+// KTX2 Constants
+// ============================================================================
+
+namespace {
+
+constexpr uint8_t kKTX2Identifier[12] = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+};
+
+constexpr size_t kHeaderBytes = 80;      // Identifier, header and index
+constexpr size_t kLevelIndexBytes = 24;  // byteOffset, byteLength, uncompressedByteLength
+constexpr size_t kLevelAlignment = 16;   // Multiple of every block size
+
+// Khronos data format descriptor color models and channels
+constexpr uint8_t kModelBC1A = 128;
+constexpr uint8_t kModelBC3 = 130;
+constexpr uint8_t kModelBC7 = 134;
+constexpr uint8_t kModelASTC = 162;
+constexpr uint8_t kChannelColor = 0;
+constexpr uint8_t kChannelBC3Alpha = 15;
+
+struct VkFormatMapping {
+    uint32_t vkFormat;
+    CompressedTextureFormat format;
+};
+
+// UNORM and SRGB Vulkan formats of each block format; the first is written
+constexpr VkFormatMapping kVkFormats[] = {
+    {157, CompressedTextureFormat::ASTC4x4},   {158, CompressedTextureFormat::ASTC4x4},
+    {161, CompressedTextureFormat::ASTC5x5},   {162, CompressedTextureFormat::ASTC5x5},
+    {165, CompressedTextureFormat::ASTC6x6},   {166, CompressedTextureFormat::ASTC6x6},
+    {171, CompressedTextureFormat::ASTC8x8},   {172, CompressedTextureFormat::ASTC8x8},
+    {179, CompressedTextureFormat::ASTC10x10}, {180, CompressedTextureFormat::ASTC10x10},
+    {183, CompressedTextureFormat::ASTC12x12}, {184, CompressedTextureFormat::ASTC12x12},
+    {133, CompressedTextureFormat::BC1},       {131, CompressedTextureFormat::BC1},
+    {132, CompressedTextureFormat::BC1},       {134, CompressedTextureFormat::BC1},
+    {137, CompressedTextureFormat::BC3},       {138, CompressedTextureFormat::BC3},
+    {145, CompressedTextureFormat::BC7},       {146, CompressedTextureFormat::BC7},
+};
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t readU64(const uint8_t* p) {
+    return static_cast<uint64_t>(readU32(p)) | (static_cast<uint64_t>(readU32(p + 4)) << 32);
+}
+
+void writeU32(uint8_t* p, uint32_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+    p[2] = static_cast<uint8_t>(value >> 16);
+    p[3] = static_cast<uint8_t>(value >> 24);
+}
+
+void writeU64(uint8_t* p, uint64_t value) {
+    writeU32(p, static_cast<uint32_t>(value));
+    writeU32(p + 4, static_cast<uint32_t>(value >> 32));
+}
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+uint32_t levelExtent(uint32_t size, size_t level) {
+    return std::max(1u, size >> level);
+}
+
+} // namespace
+
+// ============================================================================
+// KTX2 Container
+// ============================================================================
+
+bool readKTX2(const uint8_t* data, size_t size, CompressedTexture& out) {
+    if (!data || size < kHeaderBytes || std::memcmp(data, kKTX2Identifier, 12) != 0) {
+        return false;
+    }
+
+    const uint32_t vkFormat = readU32(data + 12);
+    const uint32_t typeSize = readU32(data + 16);
+    const uint32_t width = readU32(data + 20);
+    const uint32_t height = readU32(data + 24);
+    const uint32_t depth = readU32(data + 28);
+    const uint32_t layerCount = readU32(data + 32);
+    const uint32_t faceCount = readU32(data + 36);
+    const uint32_t levelCount = std::max(1u, readU32(data + 40));
+    const uint32_t supercompression = readU32(data + 44);
+
+    const VkFormatMapping* mapping = std::find_if(
+        std::begin(kVkFormats), std::end(kVkFormats),
+        [vkFormat](const VkFormatMapping& m) { return m.vkFormat == vkFormat; });
+    if (mapping == std::end(kVkFormats)) {
+        return false;
+    }
+
+    // 2D, one layer, one face, stored uncompressed
+    if (typeSize != 1 || width == 0 || height == 0 || depth > 1 || layerCount > 1 ||
+        faceCount != 1 || supercompression != 0) {
+        return false;
+    }
+
+    uint32_t maxLevels = 1;
+    while ((std::max(width, height) >> maxLevels) > 0) {
+        maxLevels++;
+    }
+    if (levelCount > maxLevels || size < kHeaderBytes + levelCount * kLevelIndexBytes) {
+        return false;
+    }
+
+    CompressedTexture texture;
+    texture.width = width;
+    texture.height = height;
+    texture.format = mapping->format;
+    texture.levels.resize(levelCount);
+
+    for (uint32_t i = 0; i < levelCount; ++i) {
+        const uint8_t* entry = data + kHeaderBytes + i * kLevelIndexBytes;
+        const uint64_t offset = readU64(entry);
+        const uint64_t length = readU64(entry + 8);
+        const size_t expected = compressedLevelBytes(texture.format, levelExtent(width, i),
+                                                     levelExtent(height, i));
+        if (length != expected || offset > size || length > size - offset) {
+            return false;
+        }
+        texture.levels[i].assign(data + offset, data + offset + length);
+    }
+
+    out = std::move(texture);
+    return true;
+}
+
+std::vector<uint8_t> writeKTX2(const CompressedTexture& texture) {
+    if (texture.width == 0 || texture.height == 0 || texture.levels.empty()) {
+        return {};
+    }
+    for (size_t i = 0; i < texture.levels.size(); ++i) {
+        if (texture.levels[i].size() != compressedLevelBytes(texture.format,
+                                                             levelExtent(texture.width, i),
+                                                             levelExtent(texture.height, i))) {
+            return {};
+        }
+    }
+
+    const uint32_t levelCount = static_cast<uint32_t>(texture.levels.size());
+    const uint32_t vkFormat = std::find_if(
+        std::begin(kVkFormats), std::end(kVkFormats),
+        [&](const VkFormatMapping& m) { return m.format == texture.format; })->vkFormat;
+
+    // Basic data format descriptor: block shape and how samples map to channels
+    uint8_t colorModel = kModelASTC;
+    uint32_t sampleCount = 1;
+    switch (texture.format) {
+        case CompressedTextureFormat::BC1: colorModel = kModelBC1A; break;
+        case CompressedTextureFormat::BC3: colorModel = kModelBC3; sampleCount = 2; break;
+        case CompressedTextureFormat::BC7: colorModel = kModelBC7; break;
+        default: break;
+    }
+    const uint32_t blockSize = compressedBlockSize(texture.format);
+    const uint32_t blockBytes = static_cast<uint32_t>(compressedBlockBytes(texture.format));
+    const uint32_t descriptorBytes = 24 + 16 * sampleCount;
+    const uint32_t dfdBytes = 4 + descriptorBytes;
+
+    const size_t dfdOffset = kHeaderBytes + levelCount * kLevelIndexBytes;
+    size_t dataOffset = alignUp(dfdOffset + dfdBytes, kLevelAlignment);
+
+    // Level data goes smallest first
+    std::vector<size_t> levelOffsets(levelCount);
+    for (uint32_t i = levelCount; i-- > 0;) {
+        levelOffsets[i] = dataOffset;
+        dataOffset = alignUp(dataOffset + texture.levels[i].size(), kLevelAlignment);
+    }
+
+    std::vector<uint8_t> file(levelOffsets[0] + texture.levels[0].size(), 0);
+    uint8_t* p = file.data();
+    std::memcpy(p, kKTX2Identifier, 12);
+    writeU32(p + 12, vkFormat);
+    writeU32(p + 16, 1);                 // typeSize
+    writeU32(p + 20, texture.width);
+    writeU32(p + 24, texture.height);
+    writeU32(p + 28, 0);                 // pixelDepth
+    writeU32(p + 32, 0);                 // layerCount
+    writeU32(p + 36, 1);                 // faceCount
+    writeU32(p + 40, levelCount);
+    writeU32(p + 44, 0);                 // supercompressionScheme
+    writeU32(p + 48, static_cast<uint32_t>(dfdOffset));
+    writeU32(p + 52, dfdBytes);
+    // No key/value data or supercompression global data (offsets 56-79 stay 0)
+
+    for (uint32_t i = 0; i < levelCount; ++i) {
+        uint8_t* entry = p + kHeaderBytes + i * kLevelIndexBytes;
+        writeU64(entry, levelOffsets[i]);
+        writeU64(entry + 8, texture.levels[i].size());
+        writeU64(entry + 16, texture.levels[i].size());
+        std::memcpy(p + levelOffsets[i], texture.levels[i].data(), texture.levels[i].size());
+    }
+
+    uint8_t* dfd = p + dfdOffset;
+    writeU32(dfd, dfdBytes);
+    writeU32(dfd + 4, 0);                          // Khronos vendor, basic descriptor
+    writeU32(dfd + 8, 2u | (descriptorBytes << 16));  // Version 2
+    dfd[12] = colorModel;
+    dfd[13] = 1;                                   // BT.709 primaries
+    dfd[14] = 1;                                   // Linear transfer
+    dfd[15] = 0;                                   // Straight alpha
+    dfd[16] = static_cast<uint8_t>(blockSize - 1);
+    dfd[17] = static_cast<uint8_t>(blockSize - 1);
+    dfd[20] = static_cast<uint8_t>(blockBytes);    // bytesPlane0
+
+    const uint32_t sampleBits = sampleCount == 2 ? 64 : blockBytes * 8;
+    for (uint32_t s = 0; s < sampleCount; ++s) {
+        uint8_t* sample = dfd + 28 + s * 16;
+        const uint8_t channel = (sampleCount == 2 && s == 0) ? kChannelBC3Alpha : kChannelColor;
+        writeU32(sample, (s * 64) | ((sampleBits - 1) << 16) | (static_cast<uint32_t>(channel) << 24));
+        writeU32(sample + 8, 0);                   // sampleLower
+        writeU32(sample + 12, 0xFFFFFFFFu);        // sampleUpper
+    }
+
+    return file;
+}
+
+// ============================================================================
+// BC Encoding
+// ============================================================================
+
+namespace {
+
+uint16_t packRGB565(const float c[3]) {
+    const auto channel = [](float v, float maxValue) {
+        return static_cast<uint32_t>(std::clamp(std::lround(v * maxValue / 255.0f), 0L,
+                                                static_cast<long>(maxValue)));
+    };
+    return static_cast<uint16_t>((channel(c[0], 31.0f) << 11) | (channel(c[1], 63.0f) << 5) |
+                                 channel(c[2], 31.0f));
+}
+
+void unpackRGB565(uint16_t c, int out[3]) {
+    const int r = (c >> 11) & 31;
+    const int g = (c >> 5) & 63;
+    const int b = c & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+// 4-color BC1 block from 16 RGBA texels
+void encodeColorBlock(const uint8_t texels[16][4], uint8_t out[8]) {
+    float mean[3] = {0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            mean[c] += texels[i][c];
+        }
+    }
+    for (float& m : mean) {
+        m /= 16.0f;
+    }
+
+    // Principal axis of the colors by power iteration on their covariance
+    float cov[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};  // rr rg rb gg gb bb
+    float lo[3] = {255.0f, 255.0f, 255.0f};
+    float hi[3] = {0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < 16; ++i) {
+        const float d[3] = {texels[i][0] - mean[0], texels[i][1] - mean[1], texels[i][2] - mean[2]};
+        cov[0] += d[0] * d[0]; cov[1] += d[0] * d[1]; cov[2] += d[0] * d[2];
+        cov[3] += d[1] * d[1]; cov[4] += d[1] * d[2]; cov[5] += d[2] * d[2];
+        for (int c = 0; c < 3; ++c) {
+            lo[c] = std::min(lo[c], static_cast<float>(texels[i][c]));
+            hi[c] = std::max(hi[c], static_cast<float>(texels[i][c]));
+        }
+    }
+    float axis[3] = {hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]};
+    for (int iteration = 0; iteration < 4; ++iteration) {
+        const float next[3] = {
+            cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+            cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+            cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2],
+        };
+        const float length = std::max({std::fabs(next[0]), std::fabs(next[1]), std::fabs(next[2])});
+        if (length <= 0.0f) {
+            break;
+        }
+        for (int c = 0; c < 3; ++c) {
+            axis[c] = next[c] / length;
+        }
+    }
+
+    // Endpoints at the extreme projections onto the axis
+    const float axisLength2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    float minT = 0.0f;
+    float maxT = 0.0f;
+    if (axisLength2 > 0.0f) {
+        for (int i = 0; i < 16; ++i) {
+            const float t = ((texels[i][0] - mean[0]) * axis[0] + (texels[i][1] - mean[1]) * axis[1] +
+                             (texels[i][2] - mean[2]) * axis[2]) / axisLength2;
+            minT = std::min(minT, t);
+            maxT = std::max(maxT, t);
+        }
+    }
+    float end0[3], end1[3];
+    for (int c = 0; c < 3; ++c) {
+        end0[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+        end1[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+    }
+
+    uint16_t c0 = packRGB565(end0);
+    uint16_t c1 = packRGB565(end1);
+    if (c0 < c1) {
+        std::swap(c0, c1);  // c0 > c1 selects the 4-color mode
+    }
+
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        int palette[4][3];
+        unpackRGB565(c0, palette[0]);
+        unpackRGB565(c1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestError = 0x7FFFFFFF;
+            for (int k = 0; k < 4; ++k) {
+                int error = 0;
+                for (int c = 0; c < 3; ++c) {
+                    const int d = texels[i][c] - palette[k][c];
+                    error += d * d;
+                }
+                if (error < bestError) {
+                    bestError = error;
+                    best = k;
+                }
+            }
+            indices |= static_cast<uint32_t>(best) << (2 * i);
+        }
+    }
+
+    out[0] = static_cast<uint8_t>(c0);
+    out[1] = static_cast<uint8_t>(c0 >> 8);
+    out[2] = static_cast<uint8_t>(c1);
+    out[3] = static_cast<uint8_t>(c1 >> 8);
+    writeU32(out + 4, indices);
+}
+
+// 8-value BC3 alpha block from 16 RGBA texels
+void encodeAlphaBlock(const uint8_t texels[16][4], uint8_t out[8]) {
+    int a0 = 0;
+    int a1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        a0 = std::max(a0, static_cast<int>(texels[i][3]));
+        a1 = std::min(a1, static_cast<int>(texels[i][3]));
+    }
+
+    uint64_t indices = 0;
+    if (a0 != a1) {
+        int values[8] = {a0, a1};
+        for (int k = 1; k < 7; ++k) {
+            values[k + 1] = ((7 - k) * a0 + k * a1) / 7;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestError = 256;
+            for (int k = 0; k < 8; ++k) {
+                const int error = std::abs(texels[i][3] - values[k]);
+                if (error < bestError) {
+                    bestError = error;
+                    best = k;
+                }
+            }
+            indices |= static_cast<uint64_t>(best) << (3 * i);
+        }
+    }
+
+    out[0] = static_cast<uint8_t>(a0);
+    out[1] = static_cast<uint8_t>(a1);
+    for (int b = 0; b < 6; ++b) {
+        out[2 + b] = static_cast<uint8_t>(indices >> (8 * b));
+    }
+}
+
+} // namespace
+
+bool encodeBCBlockRow(CompressedTextureFormat format, const uint8_t* rgba,
+                      uint32_t width, uint32_t height, size_t bytesPerRow,
+                      uint32_t blockRow, uint8_t* out) {
+    if ((format != CompressedTextureFormat::BC1 && format != CompressedTextureFormat::BC3) ||
+        !rgba || !out || width == 0 || height == 0) {
+        return false;
+    }
+
+    const uint32_t blocksWide = (width + 3) / 4;
+    const size_t blockBytes = compressedBlockBytes(format);
+    uint8_t texels[16][4];
+    for (uint32_t bx = 0; bx < blocksWide; ++bx) {
+        for (uint32_t y = 0; y < 4; ++y) {
+            const uint32_t sy = std::min(blockRow * 4 + y, height - 1);
+            const uint8_t* row = rgba + sy * bytesPerRow;
+            for (uint32_t x = 0; x < 4; ++x) {
+                const uint32_t sx = std::min(bx * 4 + x, width - 1);
+                std::memcpy(texels[y * 4 + x], row + sx * 4, 4);
+            }
+        }
+
+        uint8_t* block = out + bx * blockBytes;
+        if (format == CompressedTextureFormat::BC3) {
+            encodeAlphaBlock(texels, block);
+            encodeColorBlock(texels, block + 8);
+        } else {
+            encodeColorBlock(texels, block);
+        }
+    }
+    return true;
+}
+
+} // namespace render
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "RenderTypes.h"
+
+namespace render {
+
+// ============================================================================
+// CompressedTexture - Block-compressed mip chain
+// ============================================================================
+
+/**
+ * A block-compressed 2D texture as stored in a KTX2 file: one buffer of
+ * blocks per mip level, base level first. Each level holds
+ * compressedLevelBytes(format, max(1, width >> i), max(1, height >> i)).
+ */
+struct CompressedTexture {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    CompressedTextureFormat format = CompressedTextureFormat::BC3;
+    std::vector<std::vector<uint8_t>> levels;
+};
+
+// ============================================================================
+// KTX2 Container
+// ============================================================================
+
+/**
+ * Parse a KTX2 file held in memory.
+ * Supports single-layer, single-face 2D textures without supercompression
+ * in the ASTC (square block), BC1, BC3 and BC7 formats; sRGB variants load
+ * as their linear formats, like the renderer's other texture loads.
+ * @param data File contents
+ * @param size File size in bytes
+ * @param out Receives the texture on success
+ * @return false for malformed files or unsupported layouts and formats
+ */
+bool readKTX2(const uint8_t* data, size_t size, CompressedTexture& out);
+
+/**
+ * Serialize a texture as a KTX2 file (with the basic data format
+ * descriptor it requires).
+ * @param texture Texture whose level sizes match its format and size
+ * @return File contents, or an empty vector if the levels don't match
+ */
+std::vector<uint8_t> writeKTX2(const CompressedTexture& texture);
+
+// ============================================================================
+// BC Encoding
+// ============================================================================
+
+/**
+ * Encode a row of RGBA8 blocks as BC1 (colors only) or BC3 (colors and
+ * alpha). Endpoints are fit along the principal axis of each block's
+ * colors; texels past the right and bottom edges repeat the last column
+ * and row. Rows of blocks are independent, so callers may encode them in
+ * parallel.
+ * @param format BC1 or BC3
+ * @param rgba Source texels (4 bytes each)
+ * @param width Source width in texels
+ * @param height Source height in texels
+ * @param bytesPerRow Distance between source rows in bytes
+ * @param blockRow Row of 4x4 blocks to encode
+ * @param out Destination for (width + 3) / 4 blocks
+ * @return false for formats other than BC1 and BC3
+ */
+bool encodeBCBlockRow(CompressedTextureFormat format, const uint8_t* rgba,
+                      uint32_t width, uint32_t height, size_t bytesPerRow,
+                      uint32_t blockRow, uint8_t* out);
+
+} // namespace render
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace render {
+
+class DrawList;
+
+namespace metal {
+
+// ============================================================================
+// DrawListCapture - Frame Recording for Offline Replay
+// ============================================================================
+
+/**
+ * Writes the DrawLists of whole frames to a file, with everything they
+ * reference, so a frame can be replayed without the app that drew it.
+ *
+ * Captured per frame, as executeDrawLists() receives them (after optimize()):
+ * - Command records, their vertex, index, instance, shape, stroke and path
+ *   streams, and their lighting, shadow and texture batch side tables
+ * - Display lists and shadow casters the commands replay, once per listId
+ * - Textures and buffers the commands reference, read back from the GPU the
+ *   first time each is seen (later changes to their contents are not recorded)
+ *
+ * Not captured: compute dispatches and custom shader pipelines, which are
+ * app code. Dispatches are dropped and custom shaders replay with the
+ * built-in pipelines; readback and copy completions are not called on replay.
+ * Texture contents are kept for common uncompressed formats only, and level 0
+ * only (mipmapped textures regenerate their chain on load).
+ *
+ * Implementation:
+ * - Uses pImpl pattern to hide Objective-C++ Metal code
+ * - Thread-safety: one thread at a time (the thread that encodes frames)
+ *
+ * Usage:
+ *   DrawListCapture capture(device);
+ *   capture.open("show.ofldl");
+ *   capture.captureFrame(lists.data(), lists.size(), width, height);   // Per frame
+ *   capture.close();
+ */
+class DrawListCapture {
+public:
+    /**
+     * Constructor.
+     * @param device Metal device (id<MTLDevice>) the captured resources live on
+     */
+    explicit DrawListCapture(void* device);
+    ~DrawListCapture();
+
+    DrawListCapture(const DrawListCapture&) = delete;
+    DrawListCapture& operator=(const DrawListCapture&) = delete;
+
+    /**
+     * Start a capture file, replacing any existing file.
+     * @return false if the file could not be created
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Append one frame.
+     * @param lists The frame's lists in submission order
+     * @param count Number of lists
+     * @param width Frame width in pixels (viewport)
+     * @param height Frame height in pixels
+     * @return false on a write error (the capture is closed)
+     */
+    bool captureFrame(const DrawList* const* lists, size_t count, uint32_t width, uint32_t height);
+
+    /**
+     * Finish the file.
+     * @return false if it could not be written completely
+     */
+    bool close();
+
+    bool isOpen() const;
+
+    /// Frames written so far
+    size_t getFrameCount() const;
+
+    /// Commands left out because they can't be replayed (compute dispatches)
+    size_t getSkippedCommandCount() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+// ============================================================================
+// DrawListReplay - Captured Frames Loaded for Execution
+// ============================================================================
+
+/**
+ * Loads a DrawListCapture file: recreates its textures and buffers on a
+ * device and rebuilds its DrawLists, ready for IRenderer::executeDrawLists().
+ * The lists are already optimized; pass them to the renderer as they are,
+ * without optimize() or reset(), as often as needed.
+ *
+ * Usage:
+ *   DrawListReplay replay(device);
+ *   replay.load("show.ofldl");
+ *   const auto& lists = replay.getFrame(i);
+ *   renderer->executeDrawLists(lists.data(), lists.size());
+ */
+class DrawListReplay {
+public:
+    /**
+     * Constructor.
+     * @param device Metal device (id<MTLDevice>) to create resources on
+     */
+    explicit DrawListReplay(void* device);
+    ~DrawListReplay();
+
+    DrawListReplay(const DrawListReplay&) = delete;
+    DrawListReplay& operator=(const DrawListReplay&) = delete;
+
+    /**
+     * Load a capture, replacing anything loaded before.
+     * @return false if the file is missing, truncated or of another version
+     */
+    bool load(const std::string& path);
+
+    size_t getFrameCount() const;
+
+    /// Lists of a frame in submission order
+    const std::vector<const DrawList*>& getFrame(size_t index) const;
+
+    /// Size of a frame as captured
+    uint32_t getFrameWidth(size_t index) const;
+    uint32_t getFrameHeight(size_t index) const;
+
+    /// Textures and buffers recreated by load()
+    size_t getResourceCount() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace metal
+} // namespace render
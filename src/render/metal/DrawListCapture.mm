@@ -0,0 +1,911 @@
+#import "DrawListCapture.h"
+#import "MetalLog.h"
+#import <Metal/Metal.h>
+#include "../DrawList.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+namespace render {
+namespace metal {
+
+// ============================================================================
+// File Format
+// ============================================================================
+//
+// "OFLDLCAP", u32 version, then chunks of {u32 tag, u64 size, payload}.
+// Chunks only refer to chunks before them:
+//   TEXR  texture: description, then level 0 of every slice (or no contents)
+//   BUFR  buffer: length, then contents
+//   LIST  draw list: command records with their pointers replaced by
+//         resource and list ids, then every stream and side table
+//   FRAM  frame: width, height, top-level list ids in submission order
+// Ids start at 1; 0 stands for a null pointer.
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'F', 'L', 'D', 'L', 'C', 'A', 'P'};
+constexpr uint32_t kVersion = 10;    // Records are raw command structs: bump when one changes
+
+constexpr uint32_t makeTag(char a, char b, char c, char d) {
+    return uint32_t(uint8_t(a)) | uint32_t(uint8_t(b)) << 8 |
+           uint32_t(uint8_t(c)) << 16 | uint32_t(uint8_t(d)) << 24;
+}
+
+constexpr uint32_t kTagTexture = makeTag('T', 'E', 'X', 'R');
+constexpr uint32_t kTagBuffer = makeTag('B', 'U', 'F', 'R');
+constexpr uint32_t kTagList = makeTag('L', 'I', 'S', 'T');
+constexpr uint32_t kTagFrame = makeTag('F', 'R', 'A', 'M');
+
+// Texel size of the formats whose contents are captured; filterable ones
+// can regenerate their mip chain after loading
+struct FormatInfo {
+    uint32_t bytesPerPixel;
+    bool filterable;
+};
+
+FormatInfo formatInfo(MTLPixelFormat format) {
+    switch (format) {
+        case MTLPixelFormatR8Unorm:             return {1, true};
+        case MTLPixelFormatR8Uint:              return {1, false};
+        case MTLPixelFormatRG8Unorm:            return {2, true};
+        case MTLPixelFormatR16Float:            return {2, true};
+        case MTLPixelFormatR16Unorm:            return {2, true};
+        case MTLPixelFormatR16Uint:             return {2, false};
+        case MTLPixelFormatRGBA8Unorm:
+        case MTLPixelFormatRGBA8Unorm_sRGB:
+        case MTLPixelFormatBGRA8Unorm:
+        case MTLPixelFormatBGRA8Unorm_sRGB:
+        case MTLPixelFormatRG16Float:
+        case MTLPixelFormatRG16Unorm:
+        case MTLPixelFormatRGB10A2Unorm:        return {4, true};
+        case MTLPixelFormatR32Float:
+        case MTLPixelFormatR32Uint:
+        case MTLPixelFormatDepth32Float:        return {4, false};
+        case MTLPixelFormatRGBA16Float:
+        case MTLPixelFormatRGBA16Unorm:         return {8, true};
+        case MTLPixelFormatRG32Float:           return {8, false};
+        case MTLPixelFormatRGBA32Float:         return {16, false};
+        default:                                return {0, false};
+    }
+}
+
+// Images at level 0: slices of arrays and cubes, depth of 3D textures
+uint32_t imageCount(id<MTLTexture> texture) {
+    switch (texture.textureType) {
+        case MTLTextureType2DArray:     return static_cast<uint32_t>(texture.arrayLength);
+        case MTLTextureTypeCube:        return 6;
+        case MTLTextureTypeCubeArray:   return static_cast<uint32_t>(texture.arrayLength) * 6;
+        case MTLTextureType3D:          return static_cast<uint32_t>(texture.depth);
+        default:                        return 1;
+    }
+}
+
+// Largest command record
+constexpr size_t kMaxRecordSize = std::max({
+    sizeof(DrawCommand2D), sizeof(DrawCommand2DShapes), sizeof(DrawCommand2DStroke),
+    sizeof(DrawCommand2DPaths), sizeof(DrawCommand3D), sizeof(DrawCommand3DInstanced),
+    sizeof(DrawCommand3DIndirect), sizeof(DrawPointCloudCommand), sizeof(DrawDisplayListCommand),
+    sizeof(RenderShadowMapCommand), sizeof(SetViewportCommand), sizeof(SetScissorCommand),
+    sizeof(SetClearCommand), sizeof(SetRenderTargetCommand), sizeof(SetCustomShaderCommand),
+    sizeof(DispatchComputeCommand), sizeof(ReadbackTextureCommand), sizeof(FilterTextureCommand),
+    sizeof(GenerateMipmapsCommand), sizeof(ConvertYCbCrCommand), sizeof(ConvertYCoCgCommand),
+    sizeof(CopyTextureCommand), sizeof(PostProcessCommand)});
+
+void noReadbackCompletion(uint64_t, bool) {}
+
+// Calls the visitor for every pointer of a command record.
+// Returns false for records that can't be captured.
+template <typename Visitor>
+bool visitPointers(CommandType type, uint8_t* record, Visitor& visitor) {
+    switch (type) {
+        case CommandType::Draw2D: {
+            auto& cmd = *reinterpret_cast<DrawCommand2D*>(record);
+            visitor.texture(cmd.texture);
+            return true;
+        }
+        case CommandType::Draw3D: {
+            auto& cmd = *reinterpret_cast<DrawCommand3D*>(record);
+            visitor.texture(cmd.texture);
+            visitor.buffer(cmd.vertexBuffer);
+            visitor.buffer(cmd.indexBuffer);
+            return true;
+        }
+        case CommandType::Draw3DInstanced: {
+            auto& cmd = *reinterpret_cast<DrawCommand3DInstanced*>(record);
+            visitor.texture(cmd.texture);
+            visitor.buffer(cmd.vertexBuffer);
+            visitor.buffer(cmd.indexBuffer);
+            visitor.buffer(cmd.instanceBuffer);
+            return true;
+        }
+        case CommandType::DrawMeshPrimitives: {
+            auto& cmd = *reinterpret_cast<DrawMeshPrimitivesCommand*>(record);
+            visitor.buffer(cmd.instanceBuffer);
+            return true;
+        }
+        case CommandType::Draw3DIndirect: {
+            auto& cmd = *reinterpret_cast<DrawCommand3DIndirect*>(record);
+            visitor.texture(cmd.texture);
+            visitor.buffer(cmd.vertexBuffer);
+            visitor.buffer(cmd.indexBuffer);
+            visitor.buffer(cmd.argumentBuffer);
+            visitor.buffer(cmd.instanceBuffer);
+            return true;
+        }
+        case CommandType::DrawPointCloud: {
+            auto& cmd = *reinterpret_cast<DrawPointCloudCommand*>(record);
+            visitor.buffer(cmd.pointBuffer);
+            visitor.buffer(cmd.chunkBuffer);
+            return true;
+        }
+        case CommandType::DrawDisplayList: {
+            auto& cmd = *reinterpret_cast<DrawDisplayListCommand*>(record);
+            visitor.list(cmd.displayList, cmd.listId);
+            return true;
+        }
+        case CommandType::RenderShadowMap: {
+            auto& cmd = *reinterpret_cast<RenderShadowMapCommand*>(record);
+            visitor.texture(cmd.shadowMap);
+            visitor.list(cmd.casters, cmd.listId);
+            return true;
+        }
+        case CommandType::SetRenderTarget: {
+            auto& cmd = *reinterpret_cast<SetRenderTargetCommand*>(record);
+            visitor.texture(cmd.renderTarget);
+            return true;
+        }
+        case CommandType::SetCustomShader: {
+            // App pipelines and uniforms aren't captured; the draws fall
+            // back to the built-in pipelines
+            auto& cmd = *reinterpret_cast<SetCustomShaderCommand*>(record);
+            cmd.pipelineState = nullptr;
+            cmd.uniformOffset = 0;
+            cmd.uniformSize = 0;
+            for (void*& texture : cmd.textures) {
+                visitor.texture(texture);
+            }
+            return true;
+        }
+        case CommandType::DispatchCompute:
+            return false;
+        case CommandType::ReadbackTexture: {
+            auto& cmd = *reinterpret_cast<ReadbackTextureCommand*>(record);
+            visitor.texture(cmd.texture);
+            visitor.buffer(cmd.buffer);
+            cmd.completion = &noReadbackCompletion;   // Required by the renderer
+            return true;
+        }
+        case CommandType::FilterTexture: {
+            auto& cmd = *reinterpret_cast<FilterTextureCommand*>(record);
+            visitor.texture(cmd.source);
+            visitor.texture(cmd.destination);
+            return true;
+        }
+        case CommandType::GenerateMipmaps: {
+            auto& cmd = *reinterpret_cast<GenerateMipmapsCommand*>(record);
+            visitor.texture(cmd.texture);
+            return true;
+        }
+        case CommandType::ConvertYCbCr: {
+            auto& cmd = *reinterpret_cast<ConvertYCbCrCommand*>(record);
+            visitor.texture(cmd.luma);
+            visitor.texture(cmd.chroma);
+            visitor.texture(cmd.destination);
+            return true;
+        }
+        case CommandType::ConvertYCoCg: {
+            auto& cmd = *reinterpret_cast<ConvertYCoCgCommand*>(record);
+            visitor.texture(cmd.color);
+            visitor.texture(cmd.alpha);
+            visitor.texture(cmd.destination);
+            return true;
+        }
+        case CommandType::CopyTexture: {
+            auto& cmd = *reinterpret_cast<CopyTextureCommand*>(record);
+            visitor.texture(cmd.source);
+            visitor.texture(cmd.destination);
+            cmd.completion = nullptr;
+            return true;
+        }
+        case CommandType::PostProcess: {
+            auto& cmd = *reinterpret_cast<PostProcessCommand*>(record);
+            visitor.texture(cmd.source);
+            visitor.texture(cmd.destination);
+            return true;
+        }
+        default:
+            return true;    // No pointers
+    }
+}
+
+void* idToPointer(uint32_t handle) {
+    return reinterpret_cast<void*>(static_cast<uintptr_t>(handle));
+}
+
+uint32_t pointerToId(const void* pointer) {
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(pointer));
+}
+
+// Little-endian payload builder
+struct Writer {
+    std::vector<uint8_t> bytes;
+
+    void raw(const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        bytes.insert(bytes.end(), p, p + size);
+    }
+    void u32(uint32_t value) { raw(&value, sizeof(value)); }
+    void u64(uint64_t value) { raw(&value, sizeof(value)); }
+
+    template <typename T>
+    void stream(const T* data, size_t count) {
+        u32(static_cast<uint32_t>(sizeof(T)));
+        u64(count);
+        if (count > 0) {
+            raw(data, count * sizeof(T));
+        }
+    }
+};
+
+// Bounds-checked payload reader; fails once and stays failed
+struct Reader {
+    const uint8_t* data;
+    size_t size;
+    size_t offset = 0;
+    bool ok = true;
+
+    bool raw(void* out, size_t count) {
+        if (!ok || count > size - offset) {
+            ok = false;
+            return false;
+        }
+        std::memcpy(out, data + offset, count);
+        offset += count;
+        return true;
+    }
+    uint32_t u32() { uint32_t v = 0; raw(&v, sizeof(v)); return v; }
+    uint64_t u64() { uint64_t v = 0; raw(&v, sizeof(v)); return v; }
+
+    const uint8_t* skip(size_t count) {
+        if (!ok || count > size - offset) {
+            ok = false;
+            return nullptr;
+        }
+        const uint8_t* p = data + offset;
+        offset += count;
+        return p;
+    }
+
+    template <typename T>
+    bool stream(std::vector<T>& out) {
+        const uint32_t elementSize = u32();
+        const uint64_t count = u64();
+        if (!ok || elementSize != sizeof(T) || count > (size - offset) / sizeof(T)) {
+            ok = false;     // Truncated, or written by a build with other layouts
+            return false;
+        }
+        out.resize(static_cast<size_t>(count));
+        return count == 0 || raw(out.data(), out.size() * sizeof(T));
+    }
+};
+
+} // namespace
+
+// ============================================================================
+// DrawListCapture
+// ============================================================================
+
+struct DrawListCapture::Impl {
+    id<MTLDevice> device = nil;
+    id<MTLCommandQueue> queue = nil;    // Readbacks, apart from the renderer's queue
+    std::FILE* file = nullptr;
+    std::string path;
+
+    std::unordered_map<const void*, uint32_t> resources;    // Texture/buffer -> id
+    std::unordered_map<uint64_t, uint32_t> recordedLists;   // listId -> list id
+    uint32_t nextResource = 1;
+    uint32_t nextList = 1;
+    size_t frameCount = 0;
+    size_t skippedCommands = 0;
+    bool failed = false;
+
+    bool writeChunk(uint32_t tag, const Writer& payload) {
+        const uint64_t size = payload.bytes.size();
+        if (std::fwrite(&tag, sizeof(tag), 1, file) != 1 ||
+            std::fwrite(&size, sizeof(size), 1, file) != 1 ||
+            (size > 0 && std::fwrite(payload.bytes.data(), size, 1, file) != 1)) {
+            failed = true;
+        }
+        return !failed;
+    }
+
+    // Copy level 0 of every image of a texture into a shared buffer
+    id<MTLBuffer> readTexture(id<MTLTexture> texture, uint32_t bytesPerRow, uint32_t images) {
+        const NSUInteger imageBytes = NSUInteger(bytesPerRow) * texture.height;
+        id<MTLBuffer> staging = [device newBufferWithLength:imageBytes * images
+                                                    options:MTLResourceStorageModeShared];
+        id<MTLCommandBuffer> commandBuffer = [queue commandBuffer];
+        id<MTLBlitCommandEncoder> blit = [commandBuffer blitCommandEncoder];
+        if (!staging || !blit) {
+            return nil;
+        }
+        const bool volume = texture.textureType == MTLTextureType3D;
+        const MTLSize size = MTLSizeMake(texture.width, texture.height, volume ? texture.depth : 1);
+        const uint32_t slices = volume ? 1 : images;
+        for (uint32_t slice = 0; slice < slices; ++slice) {
+            [blit copyFromTexture:texture
+                      sourceSlice:slice
+                      sourceLevel:0
+                     sourceOrigin:MTLOriginMake(0, 0, 0)
+                       sourceSize:size
+                         toBuffer:staging
+                destinationOffset:imageBytes * slice
+           destinationBytesPerRow:bytesPerRow
+         destinationBytesPerImage:imageBytes];
+        }
+        [blit endEncoding];
+        [commandBuffer commit];
+        [commandBuffer waitUntilCompleted];
+        return commandBuffer.status == MTLCommandBufferStatusCompleted ? staging : nil;
+    }
+
+    uint32_t captureTexture(id<MTLTexture> texture) {
+        const FormatInfo info = formatInfo(texture.pixelFormat);
+        const bool readable = info.bytesPerPixel > 0 && texture.sampleCount == 1 &&
+                              !texture.framebufferOnly &&
+                              texture.storageMode != MTLStorageModeMemoryless;
+        const uint32_t images = imageCount(texture);
+        const uint32_t bytesPerRow = static_cast<uint32_t>(texture.width) * info.bytesPerPixel;
+
+        id<MTLBuffer> contents = readable ? readTexture(texture, bytesPerRow, images) : nil;
+        if (readable && !contents) {
+            METAL_LOG_ERROR(@"DrawListCapture: Failed to read back a %lux%lu texture; captured without contents",
+                            (unsigned long)texture.width, (unsigned long)texture.height);
+        }
+
+        const uint32_t handle = nextResource++;
+        Writer payload;
+        payload.u32(handle);
+        payload.u32(static_cast<uint32_t>(texture.textureType));
+        payload.u32(static_cast<uint32_t>(texture.pixelFormat));
+        payload.u32(static_cast<uint32_t>(texture.width));
+        payload.u32(static_cast<uint32_t>(texture.height));
+        payload.u32(static_cast<uint32_t>(texture.depth));
+        payload.u32(static_cast<uint32_t>(texture.arrayLength));
+        payload.u32(static_cast<uint32_t>(texture.mipmapLevelCount));
+        payload.u32(static_cast<uint32_t>(texture.sampleCount));
+        payload.u32(static_cast<uint32_t>(texture.usage));
+        payload.u32(contents ? bytesPerRow : 0);
+        payload.u32(images);
+        payload.u64(contents ? contents.length : 0);
+        if (contents) {
+            payload.raw(contents.contents, contents.length);
+        }
+        return writeChunk(kTagTexture, payload) ? handle : 0;
+    }
+
+    uint32_t captureBuffer(id<MTLBuffer> buffer) {
+        id<MTLBuffer> source = buffer;
+        if (buffer.storageMode == MTLStorageModePrivate) {
+            source = [device newBufferWithLength:buffer.length options:MTLResourceStorageModeShared];
+            id<MTLCommandBuffer> commandBuffer = [queue commandBuffer];
+            id<MTLBlitCommandEncoder> blit = [commandBuffer blitCommandEncoder];
+            if (source && blit) {
+                [blit copyFromBuffer:buffer sourceOffset:0 toBuffer:source destinationOffset:0 size:buffer.length];
+                [blit endEncoding];
+                [commandBuffer commit];
+                [commandBuffer waitUntilCompleted];
+            }
+            if (!source || !blit || commandBuffer.status != MTLCommandBufferStatusCompleted) {
+                METAL_LOG_ERROR(@"DrawListCapture: Failed to read back a %lu byte buffer; captured as zeros",
+                                (unsigned long)buffer.length);
+                source = nil;
+            }
+        }
+
+        const uint32_t handle = nextResource++;
+        Writer payload;
+        payload.u32(handle);
+        payload.u64(buffer.length);
+        if (source) {
+            payload.raw(source.contents, buffer.length);
+        } else {
+            payload.bytes.resize(payload.bytes.size() + buffer.length, 0);
+        }
+        return writeChunk(kTagBuffer, payload) ? handle : 0;
+    }
+
+    // Replaces pointers with ids, writing what they refer to on first sight
+    struct Patcher {
+        Impl& impl;
+
+        void texture(void*& pointer) {
+            if (pointer) {
+                pointer = idToPointer(impl.resourceId(pointer, true));
+            }
+        }
+        void buffer(void*& pointer) {
+            if (pointer) {
+                pointer = idToPointer(impl.resourceId(pointer, false));
+            }
+        }
+        void list(const DrawList*& list, uint64_t listId) {
+            if (list) {
+                list = static_cast<const DrawList*>(idToPointer(impl.nestedListId(*list, listId)));
+            }
+        }
+    };
+
+    uint32_t resourceId(void* pointer, bool isTexture) {
+        auto it = resources.find(pointer);
+        if (it != resources.end()) {
+            return it->second;
+        }
+        const uint32_t handle = isTexture ? captureTexture((__bridge id<MTLTexture>)pointer)
+                                          : captureBuffer((__bridge id<MTLBuffer>)pointer);
+        resources.emplace(pointer, handle);
+        return handle;
+    }
+
+    // Display lists and casters don't change while their listId is in use
+    uint32_t nestedListId(const DrawList& list, uint64_t listId) {
+        if (listId != 0) {
+            auto it = recordedLists.find(listId);
+            if (it != recordedLists.end()) {
+                return it->second;
+            }
+        }
+        const uint32_t handle = writeList(list);
+        if (listId != 0) {
+            recordedLists.emplace(listId, handle);
+        }
+        return handle;
+    }
+
+    uint32_t writeList(const DrawList& list) {
+        Patcher patcher{*this};
+
+        // Records first: writing them may write the chunks they refer to
+        Writer records;
+        uint32_t recordCount = 0;
+        alignas(16) uint8_t scratch[kMaxRecordSize];
+        for (CommandRef ref : list.getCommands()) {
+            const size_t size = commandSize(ref.type);
+            if (size > sizeof(scratch)) {
+                ++skippedCommands;
+                continue;
+            }
+            std::memcpy(scratch, ref.data, size);
+            if (!visitPointers(ref.type, scratch, patcher)) {
+                ++skippedCommands;
+                continue;
+            }
+            records.u32(static_cast<uint32_t>(ref.type));
+            records.u32(static_cast<uint32_t>(size));
+            records.raw(scratch, size);
+            ++recordCount;
+        }
+
+        std::vector<ShadowState> shadowStates = list.shadowStates_;
+        for (ShadowState& state : shadowStates) {
+            for (void*& map : state.shadowMaps) {
+                patcher.texture(map);
+            }
+        }
+        std::vector<TextureBatch2D> textureBatches = list.textureBatches_;
+        for (TextureBatch2D& batch : textureBatches) {
+            for (void*& texture : batch.textures) {
+                patcher.texture(texture);
+            }
+        }
+        if (failed) {
+            return 0;
+        }
+
+        const uint32_t handle = nextList++;
+        Writer payload;
+        payload.u32(handle);
+        payload.u32(recordCount);
+        payload.raw(records.bytes.data(), records.bytes.size());
+        payload.stream(list.getVertex2DData(), list.getVertex2DCount());
+        payload.stream(list.getVertex3DData(), list.getVertex3DCount());
+        payload.stream(list.packedVertices2D_.data(), list.packedVertices2D_.size());
+        payload.stream(list.packedVertices3D_.data(), list.packedVertices3D_.size());
+        payload.stream(list.getIndexData(), list.getIndexCount());
+        payload.stream(list.instances_.data(), list.instances_.size());
+        payload.stream(list.shapes_.data(), list.shapes_.size());
+        payload.stream(list.strokeSegments_.data(), list.strokeSegments_.size());
+        payload.stream(list.paths_.data(), list.paths_.size());
+        payload.stream(list.pathSegments_.data(), list.pathSegments_.size());
+        payload.stream(list.lightingStates_.data(), list.lightingStates_.size());
+        payload.stream(list.lightData_.data(), list.lightData_.size());
+        payload.stream(shadowStates.data(), shadowStates.size());
+        payload.stream(textureBatches.data(), textureBatches.size());
+        return writeChunk(kTagList, payload) ? handle : 0;
+    }
+};
+
+DrawListCapture::DrawListCapture(void* device) : impl_(std::make_unique<Impl>()) {
+    impl_->device = (__bridge id<MTLDevice>)device;
+}
+
+DrawListCapture::~DrawListCapture() {
+    close();
+}
+
+bool DrawListCapture::open(const std::string& path) {
+    close();
+    if (!impl_->device) {
+        METAL_LOG_ERROR(@"DrawListCapture: No Metal device");
+        return false;
+    }
+    if (!impl_->queue) {
+        impl_->queue = [impl_->device newCommandQueue];
+        impl_->queue.label = @"oflike.drawListCapture";
+    }
+
+    impl_->file = std::fopen(path.c_str(), "wb");
+    if (!impl_->file) {
+        METAL_LOG_ERROR(@"DrawListCapture: Failed to create %s: %s", path.c_str(), std::strerror(errno));
+        return false;
+    }
+    impl_->path = path;
+    impl_->failed = std::fwrite(kMagic, sizeof(kMagic), 1, impl_->file) != 1 ||
+                    std::fwrite(&kVersion, sizeof(kVersion), 1, impl_->file) != 1;
+    if (impl_->failed) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool DrawListCapture::captureFrame(const DrawList* const* lists, size_t count,
+                                   uint32_t width, uint32_t height) {
+    if (!impl_->file) {
+        return false;
+    }
+
+    @autoreleasepool {
+        Writer payload;
+        payload.u32(width);
+        payload.u32(height);
+        payload.u32(static_cast<uint32_t>(count));
+        for (size_t i = 0; i < count && !impl_->failed; ++i) {
+            payload.u32(impl_->writeList(*lists[i]));
+        }
+        if (impl_->failed || !impl_->writeChunk(kTagFrame, payload)) {
+            METAL_LOG_ERROR(@"DrawListCapture: Failed to write %s", impl_->path.c_str());
+            close();
+            return false;
+        }
+    }
+    ++impl_->frameCount;
+    return true;
+}
+
+bool DrawListCapture::close() {
+    if (!impl_->file) {
+        return !impl_->failed;
+    }
+    const bool ok = std::fclose(impl_->file) == 0 && !impl_->failed;
+    impl_->file = nullptr;
+    impl_->resources.clear();
+    impl_->recordedLists.clear();
+    impl_->nextResource = 1;
+    impl_->nextList = 1;
+    return ok;
+}
+
+bool DrawListCapture::isOpen() const {
+    return impl_->file != nullptr;
+}
+
+size_t DrawListCapture::getFrameCount() const {
+    return impl_->frameCount;
+}
+
+size_t DrawListCapture::getSkippedCommandCount() const {
+    return impl_->skippedCommands;
+}
+
+// ============================================================================
+// DrawListReplay
+// ============================================================================
+
+struct DrawListReplay::Impl {
+    struct Frame {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<const DrawList*> lists;
+    };
+
+    id<MTLDevice> device = nil;
+    id<MTLCommandQueue> queue = nil;    // Uploads
+    std::unordered_map<uint32_t, id> resources;
+    std::unordered_map<uint32_t, std::unique_ptr<DrawList>> lists;
+    std::vector<Frame> frames;
+
+    // Replaces ids with the recreated objects
+    struct Resolver {
+        Impl& impl;
+        bool ok = true;
+
+        void* resolve(void* pointer) {
+            if (!pointer) {
+                return nullptr;
+            }
+            auto it = impl.resources.find(pointerToId(pointer));
+            if (it == impl.resources.end()) {
+                ok = false;
+                return nullptr;
+            }
+            return (__bridge void*)it->second;
+        }
+        void texture(void*& pointer) { pointer = resolve(pointer); }
+        void buffer(void*& pointer) { pointer = resolve(pointer); }
+        void list(const DrawList*& list, uint64_t) {
+            if (list) {
+                auto it = impl.lists.find(pointerToId(list));
+                if (it == impl.lists.end()) {
+                    ok = false;
+                    list = nullptr;
+                } else {
+                    list = it->second.get();
+                }
+            }
+        }
+    };
+
+    bool loadTexture(Reader& reader) {
+        const uint32_t handle = reader.u32();
+        MTLTextureDescriptor* desc = [[MTLTextureDescriptor alloc] init];
+        desc.textureType = static_cast<MTLTextureType>(reader.u32());
+        desc.pixelFormat = static_cast<MTLPixelFormat>(reader.u32());
+        desc.width = reader.u32();
+        desc.height = reader.u32();
+        desc.depth = reader.u32();
+        desc.arrayLength = reader.u32();
+        desc.mipmapLevelCount = reader.u32();
+        desc.sampleCount = reader.u32();
+        desc.usage = static_cast<MTLTextureUsage>(reader.u32());
+        desc.storageMode = MTLStorageModePrivate;
+        const uint32_t bytesPerRow = reader.u32();
+        const uint32_t images = reader.u32();
+        const uint64_t size = reader.u64();
+        const uint8_t* contents = reader.skip(static_cast<size_t>(size));
+        if (!reader.ok) {
+            return false;
+        }
+
+        id<MTLTexture> texture = [device newTextureWithDescriptor:desc];
+        if (!texture) {
+            METAL_LOG_ERROR(@"DrawListReplay: Failed to create a %lux%lu texture",
+                            (unsigned long)desc.width, (unsigned long)desc.height);
+            return false;
+        }
+        resources[handle] = texture;
+
+        const NSUInteger imageBytes = NSUInteger(bytesPerRow) * desc.height;
+        if (bytesPerRow == 0 || size != uint64_t(imageBytes) * images) {
+            return true;    // Captured without contents
+        }
+        id<MTLBuffer> staging = [device newBufferWithBytes:contents
+                                                    length:size
+                                                   options:MTLResourceStorageModeShared];
+        id<MTLCommandBuffer> commandBuffer = [queue commandBuffer];
+        id<MTLBlitCommandEncoder> blit = [commandBuffer blitCommandEncoder];
+        if (!staging || !blit) {
+            return false;
+        }
+        const bool volume = desc.textureType == MTLTextureType3D;
+        const MTLSize region = MTLSizeMake(desc.width, desc.height, volume ? desc.depth : 1);
+        const uint32_t slices = volume ? 1 : images;
+        for (uint32_t slice = 0; slice < slices; ++slice) {
+            [blit copyFromBuffer:staging
+                    sourceOffset:imageBytes * slice
+               sourceBytesPerRow:bytesPerRow
+             sourceBytesPerImage:imageBytes
+                      sourceSize:region
+                       toTexture:texture
+                destinationSlice:slice
+                destinationLevel:0
+               destinationOrigin:MTLOriginMake(0, 0, 0)];
+        }
+        if (desc.mipmapLevelCount > 1 && formatInfo(desc.pixelFormat).filterable) {
+            [blit generateMipmapsForTexture:texture];
+        }
+        [blit endEncoding];
+        [commandBuffer commit];
+        return true;
+    }
+
+    bool loadBuffer(Reader& reader) {
+        const uint32_t handle = reader.u32();
+        const uint64_t length = reader.u64();
+        const uint8_t* contents = reader.skip(static_cast<size_t>(length));
+        if (!reader.ok) {
+            return false;
+        }
+        id<MTLBuffer> buffer = length > 0
+            ? [device newBufferWithBytes:contents length:length options:MTLResourceStorageModeShared]
+            : [device newBufferWithLength:16 options:MTLResourceStorageModeShared];
+        if (!buffer) {
+            METAL_LOG_ERROR(@"DrawListReplay: Failed to create a %llu byte buffer", (unsigned long long)length);
+            return false;
+        }
+        resources[handle] = buffer;
+        return true;
+    }
+
+    bool loadList(Reader& reader) {
+        const uint32_t handle = reader.u32();
+        const uint32_t recordCount = reader.u32();
+        auto list = std::make_unique<DrawList>();
+        Resolver resolver{*this};
+
+        alignas(16) uint8_t scratch[kMaxRecordSize];
+        for (uint32_t i = 0; i < recordCount && reader.ok; ++i) {
+            const CommandType type = static_cast<CommandType>(reader.u32());
+            const uint32_t size = reader.u32();
+            if (!reader.ok || size != commandSize(type) || size > sizeof(scratch)) {
+                return false;
+            }
+            reader.raw(scratch, size);
+            visitPointers(type, scratch, resolver);
+            list->commands_.push(CommandRef{type, scratch});
+        }
+
+        reader.stream(list->vertices2D_);
+        reader.stream(list->vertices3D_);
+        reader.stream(list->packedVertices2D_);
+        reader.stream(list->packedVertices3D_);
+        reader.stream(list->indices_);
+        reader.stream(list->instances_);
+        reader.stream(list->shapes_);
+        reader.stream(list->strokeSegments_);
+        reader.stream(list->paths_);
+        reader.stream(list->pathSegments_);
+        reader.stream(list->lightingStates_);
+        reader.stream(list->lightData_);
+        reader.stream(list->shadowStates_);
+        reader.stream(list->textureBatches_);
+        for (ShadowState& state : list->shadowStates_) {
+            for (void*& map : state.shadowMaps) {
+                resolver.texture(map);
+            }
+        }
+        for (TextureBatch2D& batch : list->textureBatches_) {
+            for (void*& texture : batch.textures) {
+                resolver.texture(texture);
+            }
+        }
+        if (!reader.ok || !resolver.ok) {
+            return false;
+        }
+        lists[handle] = std::move(list);
+        return true;
+    }
+
+    bool loadFrame(Reader& reader) {
+        Frame frame;
+        frame.width = reader.u32();
+        frame.height = reader.u32();
+        const uint32_t count = reader.u32();
+        for (uint32_t i = 0; i < count && reader.ok; ++i) {
+            auto it = lists.find(reader.u32());
+            if (it == lists.end()) {
+                return false;
+            }
+            frame.lists.push_back(it->second.get());
+        }
+        if (!reader.ok) {
+            return false;
+        }
+        frames.push_back(std::move(frame));
+        return true;
+    }
+
+    void clear() {
+        frames.clear();
+        lists.clear();
+        resources.clear();
+    }
+};
+
+DrawListReplay::DrawListReplay(void* device) : impl_(std::make_unique<Impl>()) {
+    impl_->device = (__bridge id<MTLDevice>)device;
+}
+
+DrawListReplay::~DrawListReplay() = default;
+
+bool DrawListReplay::load(const std::string& path) {
+    impl_->clear();
+    if (!impl_->device) {
+        METAL_LOG_ERROR(@"DrawListReplay: No Metal device");
+        return false;
+    }
+    if (!impl_->queue) {
+        impl_->queue = [impl_->device newCommandQueue];
+        impl_->queue.label = @"oflike.drawListReplay";
+    }
+
+    @autoreleasepool {
+        NSData* data = [NSData dataWithContentsOfFile:[NSString stringWithUTF8String:path.c_str()]
+                                              options:NSDataReadingMappedIfSafe
+                                                error:nil];
+        if (!data) {
+            METAL_LOG_ERROR(@"DrawListReplay: Failed to read %s", path.c_str());
+            return false;
+        }
+
+        Reader file{static_cast<const uint8_t*>(data.bytes), data.length};
+        char magic[sizeof(kMagic)] = {};
+        file.raw(magic, sizeof(magic));
+        const uint32_t version = file.u32();
+        if (!file.ok || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion) {
+            METAL_LOG_ERROR(@"DrawListReplay: %s is not a version %u capture", path.c_str(), kVersion);
+            return false;
+        }
+
+        while (file.ok && file.offset < file.size) {
+            const uint32_t tag = file.u32();
+            const uint64_t size = file.u64();
+            const uint8_t* payload = file.skip(static_cast<size_t>(size));
+            if (!file.ok) {
+                break;
+            }
+            Reader chunk{payload, static_cast<size_t>(size)};
+            bool loaded = true;
+            if (tag == kTagTexture) {
+                loaded = impl_->loadTexture(chunk);
+            } else if (tag == kTagBuffer) {
+                loaded = impl_->loadBuffer(chunk);
+            } else if (tag == kTagList) {
+                loaded = impl_->loadList(chunk);
+            } else if (tag == kTagFrame) {
+                loaded = impl_->loadFrame(chunk);
+            }   // Unknown chunks are skipped
+            if (!loaded) {
+                file.ok = false;
+            }
+        }
+
+        // Uploads finish before the first replay; the queue is serial
+        id<MTLCommandBuffer> fence = [impl_->queue commandBuffer];
+        [fence commit];
+        [fence waitUntilCompleted];
+
+        if (!file.ok) {
+            METAL_LOG_ERROR(@"DrawListReplay: %s is truncated or damaged", path.c_str());
+            impl_->clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t DrawListReplay::getFrameCount() const {
+    return impl_->frames.size();
+}
+
+const std::vector<const DrawList*>& DrawListReplay::getFrame(size_t index) const {
+    return impl_->frames[index].lists;
+}
+
+uint32_t DrawListReplay::getFrameWidth(size_t index) const {
+    return impl_->frames[index].width;
+}
+
+uint32_t DrawListReplay::getFrameHeight(size_t index) const {
+    return impl_->frames[index].height;
+}
+
+size_t DrawListReplay::getResourceCount() const {
+    return impl_->resources.size();
+}
+
+} // namespace metal
+} // namespace render
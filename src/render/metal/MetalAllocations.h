@@ -0,0 +1,36 @@
+#pragma once
+
+// oflike-metal MetalAllocations - labeled buffer and texture creation
+// Every buffer and texture the library creates goes through these helpers,
+// which name the resource and count it in ofGpuMemory until it's released.
+
+#import <Metal/Metal.h>
+#include "../../oflike/utils/ofGpuMemory.h"
+
+namespace render {
+namespace metal {
+
+/// Buffer of length bytes; nil if the device can't allocate it
+id<MTLBuffer> makeTrackedBuffer(id<MTLDevice> device, NSUInteger length, MTLResourceOptions options,
+                                oflike::ofGpuMemoryCategory category, const char* label);
+
+/// Buffer initialized with a copy of bytes
+id<MTLBuffer> makeTrackedBuffer(id<MTLDevice> device, const void* bytes, NSUInteger length,
+                                MTLResourceOptions options,
+                                oflike::ofGpuMemoryCategory category, const char* label);
+
+/// Texture for desc; nil if the device can't allocate it
+id<MTLTexture> makeTrackedTexture(id<MTLDevice> device, MTLTextureDescriptor* desc,
+                                  oflike::ofGpuMemoryCategory category, const char* label);
+
+/// Heap for desc; nil if the device can't allocate it. Resources made
+/// from the heap are part of its size and are not counted again.
+id<MTLHeap> makeTrackedHeap(id<MTLDevice> device, MTLHeapDescriptor* desc,
+                            oflike::ofGpuMemoryCategory category, const char* label);
+
+/// Count a resource created another way (MTKTextureLoader, no-copy buffers).
+/// Tracking a resource again replaces its earlier category and label.
+void trackResource(id<MTLResource> resource, oflike::ofGpuMemoryCategory category, const char* label);
+
+} // namespace metal
+} // namespace render
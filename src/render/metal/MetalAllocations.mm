@@ -0,0 +1,98 @@
+#import "MetalAllocations.h"
+#import <objc/runtime.h>
+#include <string>
+
+// Attached to a tracked resource; untracks it when the resource is freed
+@interface OFLGpuAllocation : NSObject
+- (instancetype)initWithCategory:(oflike::ofGpuMemoryCategory)category
+                           label:(const char*)label
+                           bytes:(uint64_t)bytes;
+@end
+
+@implementation OFLGpuAllocation {
+    oflike::ofGpuMemoryCategory category_;
+    std::string label_;
+    uint64_t bytes_;
+}
+
+- (instancetype)initWithCategory:(oflike::ofGpuMemoryCategory)category
+                           label:(const char*)label
+                           bytes:(uint64_t)bytes {
+    self = [super init];
+    if (self) {
+        category_ = category;
+        label_ = label ? label : "";
+        bytes_ = bytes;
+        oflike::ofGpuMemory::track(category_, label_, bytes_);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    oflike::ofGpuMemory::untrack(category_, label_, bytes_);
+}
+
+@end
+
+namespace render {
+namespace metal {
+
+namespace {
+
+char kAllocationKey;
+
+} // namespace
+
+void trackResource(id<MTLResource> resource, oflike::ofGpuMemoryCategory category, const char* label) {
+    if (!resource) {
+        return;
+    }
+    if (label && label[0] != '\0' && !resource.label) {
+        resource.label = @(label);
+    }
+    OFLGpuAllocation* allocation = [[OFLGpuAllocation alloc] initWithCategory:category
+                                                                        label:label
+                                                                        bytes:resource.allocatedSize];
+    objc_setAssociatedObject(resource, &kAllocationKey, allocation, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+}
+
+id<MTLBuffer> makeTrackedBuffer(id<MTLDevice> device, NSUInteger length, MTLResourceOptions options,
+                                oflike::ofGpuMemoryCategory category, const char* label) {
+    id<MTLBuffer> buffer = [device newBufferWithLength:length options:options];
+    trackResource(buffer, category, label);
+    return buffer;
+}
+
+id<MTLBuffer> makeTrackedBuffer(id<MTLDevice> device, const void* bytes, NSUInteger length,
+                                MTLResourceOptions options,
+                                oflike::ofGpuMemoryCategory category, const char* label) {
+    id<MTLBuffer> buffer = [device newBufferWithBytes:bytes length:length options:options];
+    trackResource(buffer, category, label);
+    return buffer;
+}
+
+id<MTLTexture> makeTrackedTexture(id<MTLDevice> device, MTLTextureDescriptor* desc,
+                                  oflike::ofGpuMemoryCategory category, const char* label) {
+    id<MTLTexture> texture = [device newTextureWithDescriptor:desc];
+    trackResource(texture, category, label);
+    return texture;
+}
+
+id<MTLHeap> makeTrackedHeap(id<MTLDevice> device, MTLHeapDescriptor* desc,
+                            oflike::ofGpuMemoryCategory category, const char* label) {
+    id<MTLHeap> heap = [device newHeapWithDescriptor:desc];
+    if (!heap) {
+        return nil;
+    }
+    if (label && label[0] != '\0') {
+        heap.label = @(label);
+    }
+    OFLGpuAllocation* allocation = [[OFLGpuAllocation alloc] initWithCategory:category
+                                                                        label:label
+                                                                        bytes:heap.size];
+    objc_setAssociatedObject(heap, &kAllocationKey, allocation, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    return heap;
+}
+
+} // namespace metal
+} // namespace render
@@ -172,6 +172,13 @@ public:
      */
     void resetFrame(uint32_t frameIndex);
 
+    /**
+     * Deallocate available (not acquired) buffers smaller than minSize.
+     * Used to drop chunks that can no longer satisfy any request.
+     * @param minSize Minimum size in bytes to keep
+     */
+    void trim(size_t minSize);
+
     /**
      * Clear the pool and deallocate all buffers.
      */
@@ -197,5 +204,134 @@ private:
     std::unique_ptr<Impl> impl_;
 };
 
+// ============================================================================
+// MetalRingAllocator - Chunked Per-Frame Ring Allocator
+// ============================================================================
+
+/**
+ * A sub-allocation from MetalRingAllocator.
+ * buffer is an id<MTLBuffer>; bind it at byte offset `offset`.
+ */
+struct RingAllocation {
+    void* buffer = nullptr;    ///< MTLBuffer handle (id<MTLBuffer>)
+    void* contents = nullptr;  ///< CPU pointer to the first byte of the allocation
+    size_t offset = 0;         ///< Byte offset within buffer
+    size_t size = 0;           ///< Allocation size in bytes
+
+    explicit operator bool() const { return buffer != nullptr; }
+};
+
+/**
+ * Bump allocator over shared-storage chunks drawn from a MetalBufferPool.
+ *
+ * Features:
+ * - Linear sub-allocation within the current chunk
+ * - New chunks are added on overflow, so a frame never runs out of space
+ * - Chunks go back to the pool once the GPU has finished the frame
+ * - Tracks the per-frame high-water mark and presizes the first chunk to it,
+ *   so steady-state frames use a single chunk
+ *
+ * Implementation:
+ * - Uses pImpl pattern
+ * - beginFrame()/allocate(): main thread only
+ * - retireFrame(): thread-safe, meant for MTLCommandBuffer completion handlers
+ *
+ * Usage:
+ *   MetalRingAllocator ring(device, 4 * 1024 * 1024);
+ *   ring.beginFrame(frameIndex);
+ *   RingAllocation a = ring.allocate(size);
+ *   std::memcpy(a.contents, myData, size);
+ *   [cmdBuffer addCompletedHandler:^(id<MTLCommandBuffer>) { ring.retireFrame(frameIndex); }];
+ */
+class MetalRingAllocator {
+public:
+    /**
+     * Constructor.
+     * @param device Metal device (id<MTLDevice>)
+     * @param chunkSize Initial chunk size in bytes
+     * @param maxFramesInFlight Number of frames in flight (default: 3)
+     */
+    MetalRingAllocator(void* device, size_t chunkSize, uint32_t maxFramesInFlight = 3);
+
+    ~MetalRingAllocator();
+
+    // Disable copy and move
+    MetalRingAllocator(const MetalRingAllocator&) = delete;
+    MetalRingAllocator& operator=(const MetalRingAllocator&) = delete;
+    MetalRingAllocator(MetalRingAllocator&&) = delete;
+    MetalRingAllocator& operator=(MetalRingAllocator&&) = delete;
+
+    // ========================================================================
+    // Frame Lifecycle
+    // ========================================================================
+
+    /**
+     * Start allocating for a frame slot.
+     * Returns retired chunks to the pool. The caller must guarantee the GPU
+     * is done with this slot (e.g. it has waited on the frame semaphore).
+     * @param frameIndex Frame index (0 to maxFramesInFlight-1)
+     */
+    void beginFrame(uint32_t frameIndex);
+
+    /**
+     * Mark a frame slot's chunks as no longer in use by the GPU.
+     * Safe to call from any thread.
+     * @param frameIndex Frame index (0 to maxFramesInFlight-1)
+     */
+    void retireFrame(uint32_t frameIndex);
+
+    // ========================================================================
+    // Allocation
+    // ========================================================================
+
+    /**
+     * Allocate space in the current frame.
+     * Starts a new chunk when the current one is full.
+     * @param size Size in bytes
+     * @param alignment Offset alignment in bytes (power of two, default 256)
+     * @return Allocation, or an empty allocation on failure
+     */
+    RingAllocation allocate(size_t size, size_t alignment = 256);
+
+    // ========================================================================
+    // Statistics
+    // ========================================================================
+
+    /**
+     * Get bytes allocated so far in the current frame.
+     */
+    size_t getFrameBytes() const;
+
+    /**
+     * Get the largest number of bytes any frame has allocated.
+     */
+    size_t getHighWaterMark() const;
+
+    /**
+     * Get number of chunks used by the current frame.
+     */
+    size_t getFrameChunkCount() const;
+
+    /**
+     * Get the current chunk size (grows towards the high-water mark).
+     */
+    size_t getChunkSize() const;
+
+    /**
+     * Set a minimum chunk size, e.g. from a recorded high-water mark.
+     * @param size Chunk size in bytes
+     */
+    void reserve(size_t size);
+
+    /**
+     * Release all chunks. The GPU must be idle.
+     */
+    void clear();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
 } // namespace metal
 } // namespace render
@@ -1,7 +1,11 @@
 #import "MetalBuffer.h"
+#import "MetalLog.h"
+#import "MetalAllocations.h"
 #import <Metal/Metal.h>
 #import <Foundation/Foundation.h>
 #import <vector>
+#import <algorithm>
+#import <mutex>
 
 namespace render {
 namespace metal {
@@ -27,8 +31,8 @@ struct MetalBuffer::Impl {
             // Allocate initial buffers
             for (uint32_t i = 0; i < maxFramesInFlight; i++) {
                 if (initialSize > 0) {
-                    buffers[i] = [device newBufferWithLength:initialSize
-                                                     options:MTLResourceStorageModeShared];
+                    buffers[i] = makeTrackedBuffer(device, initialSize, MTLResourceStorageModeShared,
+                                                   oflike::ofGpuMemoryCategory::Streaming, "MetalBuffer");
                     if (buffers[i]) {
                         sizes[i] = initialSize;
                         buffers[i].label = [NSString stringWithFormat:@"MetalBuffer_%u", i];
@@ -66,10 +70,10 @@ void* MetalBuffer::allocate(size_t size, uint32_t frameIndex) {
             // Grow buffer with some overhead (1.5x growth factor)
             size_t newSize = size + (size / 2);
 
-            id<MTLBuffer> newBuffer = [impl_->device newBufferWithLength:newSize
-                                                                 options:MTLResourceStorageModeShared];
+            id<MTLBuffer> newBuffer = makeTrackedBuffer(impl_->device, newSize, MTLResourceStorageModeShared,
+                                                        oflike::ofGpuMemoryCategory::Streaming, "MetalBuffer");
             if (!newBuffer) {
-                NSLog(@"MetalBuffer: Failed to allocate buffer of size %zu", newSize);
+                METAL_LOG_ERROR(@"MetalBuffer: Failed to allocate buffer of size %zu", newSize);
                 return nullptr;
             }
 
@@ -222,6 +226,30 @@ void MetalBufferPool::resetFrame(uint32_t frameIndex) {
     }
 }
 
+void MetalBufferPool::trim(size_t minSize) {
+    if (!impl_) {
+        return;
+    }
+
+    @autoreleasepool {
+        auto& available = impl_->availableBuffers;
+        for (auto it = available.begin(); it != available.end();) {
+            MetalBuffer* buffer = *it;
+            if (buffer->getSize(0) >= minSize) {
+                ++it;
+                continue;
+            }
+            it = available.erase(it);
+            impl_->allBuffers.erase(
+                std::remove_if(impl_->allBuffers.begin(), impl_->allBuffers.end(),
+                               [buffer](const std::unique_ptr<MetalBuffer>& owned) {
+                                   return owned.get() == buffer;
+                               }),
+                impl_->allBuffers.end());
+        }
+    }
+}
+
 void MetalBufferPool::clear() {
     if (!impl_) {
         return;
@@ -255,5 +283,168 @@ size_t MetalBufferPool::getAvailableCount() const {
     return impl_->availableBuffers.size();
 }
 
+// ============================================================================
+// MetalRingAllocator Implementation
+// ============================================================================
+
+struct MetalRingAllocator::Impl {
+    // Chunks are single-slot MetalBuffers; the ring tracks frame ownership itself
+    MetalBufferPool pool;
+    uint32_t maxFramesInFlight = 3;
+    size_t chunkSize = 0;
+
+    // Chunks owned by each frame slot until the GPU retires it
+    std::vector<std::vector<MetalBuffer*>> frameChunks;
+
+    // Slots retired by completion handlers (guarded by retireMutex)
+    std::mutex retireMutex;
+    std::vector<bool> retired;
+
+    // Current frame
+    uint32_t frameIndex = 0;
+    MetalBuffer* currentChunk = nullptr;
+    size_t cursor = 0;
+    size_t frameBytes = 0;
+    size_t highWaterMark = 0;
+
+    Impl(id<MTLDevice> dev, size_t size, uint32_t maxFrames)
+        : pool((__bridge void*)dev, 1)
+        , maxFramesInFlight(maxFrames)
+        , chunkSize(size) {
+        frameChunks.resize(maxFramesInFlight);
+        retired.resize(maxFramesInFlight, false);
+    }
+
+    void releaseSlot(uint32_t slot) {
+        for (MetalBuffer* chunk : frameChunks[slot]) {
+            pool.release(chunk);
+        }
+        frameChunks[slot].clear();
+    }
+};
+
+MetalRingAllocator::MetalRingAllocator(void* device, size_t chunkSize, uint32_t maxFramesInFlight)
+    : impl_(std::make_unique<Impl>((__bridge id<MTLDevice>)device, chunkSize, maxFramesInFlight)) {
+}
+
+MetalRingAllocator::~MetalRingAllocator() = default;
+
+void MetalRingAllocator::beginFrame(uint32_t frameIndex) {
+    if (!impl_ || frameIndex >= impl_->maxFramesInFlight) {
+        return;
+    }
+
+    // Collect slots the GPU has finished with since the last frame
+    std::vector<uint32_t> retiredSlots;
+    {
+        std::lock_guard<std::mutex> lock(impl_->retireMutex);
+        for (uint32_t i = 0; i < impl_->maxFramesInFlight; i++) {
+            if (impl_->retired[i] || i == frameIndex) {
+                retiredSlots.push_back(i);
+                impl_->retired[i] = false;
+            }
+        }
+    }
+    for (uint32_t slot : retiredSlots) {
+        impl_->releaseSlot(slot);
+    }
+
+    // A frame that needed several chunks means the chunk size is too small:
+    // grow it to the high-water mark and drop chunks that can never be reused
+    if (impl_->highWaterMark > impl_->chunkSize) {
+        size_t newSize = impl_->chunkSize ? impl_->chunkSize : 4096;
+        while (newSize < impl_->highWaterMark) {
+            newSize *= 2;
+        }
+        impl_->chunkSize = newSize;
+        impl_->pool.trim(newSize);
+    }
+
+    impl_->frameIndex = frameIndex;
+    impl_->currentChunk = nullptr;
+    impl_->cursor = 0;
+    impl_->frameBytes = 0;
+}
+
+void MetalRingAllocator::retireFrame(uint32_t frameIndex) {
+    if (!impl_ || frameIndex >= impl_->maxFramesInFlight) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(impl_->retireMutex);
+    impl_->retired[frameIndex] = true;
+}
+
+RingAllocation MetalRingAllocator::allocate(size_t size, size_t alignment) {
+    RingAllocation result;
+    if (!impl_ || size == 0) {
+        return result;
+    }
+
+    @autoreleasepool {
+        size_t offset = (impl_->cursor + alignment - 1) & ~(alignment - 1);
+        size_t capacity = impl_->currentChunk ? impl_->currentChunk->getSize(0) : 0;
+
+        if (!impl_->currentChunk || offset + size > capacity) {
+            // Start a new chunk; oversized requests get a chunk of their own
+            MetalBuffer* chunk = impl_->pool.acquire(std::max(impl_->chunkSize, size), 0);
+            if (!chunk || !chunk->getBuffer(0)) {
+                METAL_LOG_ERROR(@"MetalRingAllocator: Failed to allocate chunk of size %zu",
+                      std::max(impl_->chunkSize, size));
+                return result;
+            }
+            impl_->frameChunks[impl_->frameIndex].push_back(chunk);
+            impl_->currentChunk = chunk;
+            offset = 0;
+        }
+
+        result.buffer = impl_->currentChunk->getBuffer(0);
+        result.contents = (uint8_t*)impl_->currentChunk->getContents(0) + offset;
+        result.offset = offset;
+        result.size = size;
+
+        impl_->cursor = offset + size;
+        impl_->frameBytes += size;
+        impl_->highWaterMark = std::max(impl_->highWaterMark, impl_->frameBytes);
+        return result;
+    }
+}
+
+size_t MetalRingAllocator::getFrameBytes() const {
+    return impl_ ? impl_->frameBytes : 0;
+}
+
+size_t MetalRingAllocator::getHighWaterMark() const {
+    return impl_ ? impl_->highWaterMark : 0;
+}
+
+size_t MetalRingAllocator::getFrameChunkCount() const {
+    return impl_ ? impl_->frameChunks[impl_->frameIndex].size() : 0;
+}
+
+size_t MetalRingAllocator::getChunkSize() const {
+    return impl_ ? impl_->chunkSize : 0;
+}
+
+void MetalRingAllocator::reserve(size_t size) {
+    if (impl_ && size > impl_->chunkSize) {
+        impl_->chunkSize = size;
+    }
+}
+
+void MetalRingAllocator::clear() {
+    if (!impl_) {
+        return;
+    }
+
+    for (auto& chunks : impl_->frameChunks) {
+        chunks.clear();
+    }
+    impl_->currentChunk = nullptr;
+    impl_->cursor = 0;
+    impl_->frameBytes = 0;
+    impl_->pool.clear();
+}
+
 } // namespace metal
 } // namespace render
@@ -0,0 +1,28 @@
+#pragma once
+
+// oflike-metal MetalLog - renderer messages through the ofLog writer thread
+// Same format strings as NSLog (%@ included), but nothing is formatted below
+// the log level, each call site is rate-limited (see ofLogRateLimiter), and
+// the message is written off the render thread instead of by NSLog.
+
+#import <Foundation/Foundation.h>
+#include "../../oflike/utils/ofLog.h"
+
+#define METAL_LOG(level, format, ...) \
+    do { \
+        static ::oflike::ofLogRateLimiter metalLogLimiter; \
+        uint32_t metalLogSuppressed = 0; \
+        if (::oflike::ofLogEnabled(level) && metalLogLimiter.allow(metalLogSuppressed)) { \
+            NSString* metalLogMessage = [NSString stringWithFormat:format, ##__VA_ARGS__]; \
+            ::oflike::ofLogSubmit(level, "", metalLogMessage.UTF8String, metalLogSuppressed); \
+        } \
+    } while (0)
+
+/// Failures (os_log error)
+#define METAL_LOG_ERROR(format, ...) METAL_LOG(::oflike::OF_LOG_ERROR, format, ##__VA_ARGS__)
+
+/// Setup progress and one-off events (os_log info)
+#define METAL_LOG_NOTICE(format, ...) METAL_LOG(::oflike::OF_LOG_NOTICE, format, ##__VA_ARGS__)
+
+/// Per-frame state changes worth tracing when debugging (os_log debug)
+#define METAL_LOG_VERBOSE(format, ...) METAL_LOG(::oflike::OF_LOG_VERBOSE, format, ##__VA_ARGS__)
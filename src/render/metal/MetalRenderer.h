@@ -65,6 +65,16 @@ public:
 
     // DrawList Execution
     bool executeDrawList(const DrawList& drawList) override;
+    bool executeDrawLists(const DrawList* const* drawLists, size_t count) override;
+    size_t prewarm(const PipelineVariant* variants, size_t count) override;
+    void* createRenderPipelineState(void* descriptor, void** reflection = nullptr) override;
+    void* getComputePipelineState(const char* functionName) override;
+    void setOcclusionCullingEnabled(bool enabled) override;
+    void* getOcclusionPyramid() const override;
+    void requestObjectIdPick(float x, float y) override;
+    bool getObjectIdPick(uint32_t& outObjectId, uint64_t& outFrameSerial) const override;
+    bool supportsMeshPrimitives() const override;
+    bool bindFrameStorage(DrawList& drawList) override;
 
     // Render State
     void setViewport(float x, float y, float width, float height) override;
@@ -80,9 +90,28 @@ public:
     // Render Target Management
     bool setRenderTarget(void* renderTarget) override;
     void* getDefaultRenderTarget() const override;
+    bool setRasterizationRate(void* renderTarget, const RasterizationRate& rate) override;
+
+    // Display Outputs
+    int addDisplayOutput(void* metalLayer) override;
+    void removeDisplayOutput(int output) override;
+    bool setDisplayOutputConfig(int output, const DisplayOutputConfig& config) override;
+    void setDisplayOutputSource(void* texture) override;
 
     // Texture Management
     void* createTexture(uint32_t width, uint32_t height, const void* data) override;
+    void* createTexture(uint32_t width, uint32_t height, render::TextureFormat format, const void* data) override;
+    void* createMipmappedTexture(uint32_t width, uint32_t height, render::TextureFormat format,
+                                 const void* data) override;
+    void* createWritableTexture(uint32_t width, uint32_t height, render::TextureFormat format) override;
+    void* createStreamingTexture(uint32_t width, uint32_t height, render::TextureFormat format) override;
+    void setTextureUploadBudget(size_t bytes) override;
+    size_t getTextureUploadBudget() const override;
+    bool supportsCompressedTextureFormat(render::CompressedTextureFormat format) const override;
+    void* createCompressedTexture(uint32_t width, uint32_t height, render::CompressedTextureFormat format,
+                                  const void* const* levels, uint32_t levelCount) override;
+    bool updateTexture(void* texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+                       const void* data, size_t bytesPerRow) override;
     void* loadTexture(const char* path) override;
     void destroyTexture(void* texture) override;
     bool readTexturePixels(void* texture, void* data, uint32_t width, uint32_t height, size_t bytesPerRow) const override;
@@ -92,10 +121,53 @@ public:
     uint32_t getViewportWidth() const override;
     uint32_t getViewportHeight() const override;
     void getStatistics(uint32_t& outDrawCalls, uint32_t& outVertices) const override;
+    void getStatistics(uint32_t& outDrawCalls, uint32_t& outVertices,
+                       uint32_t& outSkippedStateChanges) const override;
+    void getStatistics(uint32_t& outDrawCalls, uint32_t& outVertices,
+                       uint32_t& outSkippedStateChanges, uint32_t& outCulledDraws) const override;
 
     // Performance monitoring
     double getLastGPUTime() const;  // Returns GPU time in milliseconds
 
+    /**
+     * Block until every committed frame has completed on the GPU.
+     * Afterwards getLastGPUTime() and getGPUTimeline() describe the last
+     * frame committed; used by the benchmark harness to time frames one by one.
+     */
+    void waitForFrames();
+    size_t getGPUTimeline(GPUPassTiming* outPasses, size_t maxPasses) const override;
+    uint64_t getRecordingFrameSerial() const override;
+    bool getLastPresentedFrame(uint64_t& outFrameSerial, double& outPresentedTime) const override;
+    void setMaxFramesInFlight(uint32_t frames) override;
+    uint32_t getMaxFramesInFlight() const override;
+    void acquireFrameSlot() override;
+    void setPresentMinimumDuration(double seconds) override;
+    bool attachGPUTimestamps(void* passDescriptor, const char* name) override;
+
+    /**
+     * Get geometry ring buffer usage.
+     * @param outFrameBytes Bytes allocated by the current frame
+     * @param outHighWaterMark Largest per-frame allocation seen so far
+     * @param outChunkCount Chunks used by the current frame (1 when presized)
+     */
+    void getGeometryBufferStatistics(size_t& outFrameBytes, size_t& outHighWaterMark,
+                                     size_t& outChunkCount) const;
+
+    /**
+     * Presize the geometry ring's chunks, e.g. from a recorded high-water mark.
+     * @param bytes Minimum chunk size in bytes
+     */
+    void reserveGeometryBytes(size_t bytes);
+
+    /**
+     * Use a drawable and render pass captured elsewhere for the next frame.
+     * Needed when frames are encoded off the main thread, where the view's
+     * currentDrawable is no longer valid. Cleared by endFrame().
+     * @param drawable CAMetalDrawable cast to void*
+     * @param renderPassDescriptor MTLRenderPassDescriptor cast to void*
+     */
+    void setFrameTarget(void* drawable, void* renderPassDescriptor);
+
     // Device Access (Phase 3.3)
     /**
      * Get the Metal device used by this renderer.
@@ -1,14 +1,29 @@
 #import <Foundation/Foundation.h>
 #import <Metal/Metal.h>
 #import <MetalKit/MetalKit.h>
+#import <MetalPerformanceShaders/MetalPerformanceShaders.h>
+#import <MetalFX/MetalFX.h>
 #import <simd/simd.h>
 
 #include "MetalRenderer.h"
+#include "MetalAllocations.h"
+#include "MetalBuffer.h"
+#include "MetalLog.h"
+#include "../../oflike/utils/ofProfiler.h"
 #include "../DrawCommand.h"
 #include "../../core/Context.h"
 #include <vector>
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <cstdio>
 #include <cstring>
 #include <cstdlib>
+#include <initializer_list>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
 
 namespace render {
 namespace metal {
@@ -17,10 +32,73 @@ namespace metal {
 // Constants
 // ============================================================================
 
-constexpr uint32_t kMaxFramesInFlight = 3;  // Triple buffering
-constexpr uint32_t kMaxVertices2D = 65536;   // Max 2D vertices per frame
-constexpr uint32_t kMaxVertices3D = 32768;   // Max 3D vertices per frame
-constexpr uint32_t kMaxIndices = 98304;      // Max indices per frame
+// Geometry lives in a chunked ring that grows on demand; these only size the
+// first chunk and the zero-copy mapping before any high-water mark is known
+constexpr uint32_t kInitialVertices2D = 65536;
+constexpr uint32_t kInitialVertices3D = 32768;
+constexpr uint32_t kInitialIndices = 98304;
+constexpr size_t kGeometryAlignment = 256;
+constexpr size_t kInitialGeometryChunkSize =
+    kInitialVertices2D * sizeof(Vertex2D) + kInitialVertices3D * sizeof(Vertex3D) +
+    kInitialIndices * sizeof(uint32_t) + 3 * kGeometryAlignment;
+
+// Texture uploads into private storage are packed into shared staging
+// batches of the upload budget; a batch that fills up is submitted at once
+constexpr size_t kDefaultTextureUploadBudget = 32 * 1024 * 1024;
+constexpr size_t kTextureUploadAlignment = 256;   // Multiple of every texel and block size
+
+// Lighting blocks: one 256-byte material block per unique LightingState
+// (constant buffer offsets must be 256-byte aligned on macOS), followed by
+// the list's light pool
+constexpr size_t kLightingBlockStride = 256;
+static_assert(sizeof(LightingState::materialData) <= kLightingBlockStride,
+              "Material data must fit in a lighting block");
+
+// Shadow blocks follow the material blocks: an empty block for draws
+// without shadows, then one per ShadowState (fragment buffer(6))
+constexpr size_t kShadowBlockStride = (sizeof(ShadowUniforms) + 255) & ~size_t(255);
+
+// Clustered lighting (matches Lighting.metal): draws with more lights than
+// the threshold shade only the lights binned into their cluster. A grid
+// holds a count per cluster followed by kMaxLightsPerCluster indices each.
+constexpr int kClusteredLightThreshold = 8;
+constexpr uint32_t kClusterTilesX = 16;
+constexpr uint32_t kClusterTilesY = 8;
+constexpr uint32_t kClusterSlices = 24;
+constexpr uint32_t kClusterCount = kClusterTilesX * kClusterTilesY * kClusterSlices;
+constexpr uint32_t kMaxLightsPerCluster = 64;
+constexpr size_t kClusterCountsBytes = kClusterCount * sizeof(uint32_t);
+constexpr size_t kClusterGridBytes = kClusterCountsBytes + kClusterCount * kMaxLightsPerCluster * sizeof(uint16_t);
+constexpr size_t kMaxLightClusterGrids = 4;    // Per list; further projections loop over all lights
+static_assert(kClusterCountsBytes % 256 == 0 && kClusterGridBytes % 256 == 0,
+              "Cluster grid sections must stay 256-byte aligned");
+
+// GPU timeline: two timestamps (start, end) per timed pass
+constexpr uint32_t kMaxTimelinePasses = 32;
+
+// Resident display list buffers not replayed for this many frames are
+// released (well past kMaxFramesInFlight, so the GPU is done with them)
+constexpr uint64_t kDisplayListRetainFrames = 120;
+constexpr uint32_t kMaxDisplayListDepth = 8;   // Nested replays (guards against cycles)
+
+// Static unlit display lists with at least this many draws are encoded once
+// into indirect command buffers; smaller ones replay through the encoder
+constexpr size_t kMinRetainedDraws = 16;
+constexpr size_t kRetainedUniformStride = 256;  // Per-draw Uniforms3D and per-frame replay slots
+
+// Function constant of the *Blend fragment variants' blend mode
+// (PROGRAMMABLE_BLEND_MODE_INDEX in BlendModes.h)
+constexpr NSUInteger kProgrammableBlendModeIndex = 8;
+
+// Each display output warp cell is drawn as this many quads per side, so the
+// bilinear warp stays smooth
+constexpr uint32_t kDisplayWarpSubdivisions = 8;
+
+// Mesh primitives (MeshPrimitives.metal): meshlets per object threadgroup,
+// mesh threadgroup size, and the projected length each segment aims for
+constexpr NSUInteger kMeshletsPerObject = 32;
+constexpr NSUInteger kMeshletThreads = 128;
+constexpr float kMeshletEdgePixels = 8.0f;
 
 namespace {
 bool isMetalDebugEnabled() {
@@ -39,9 +117,9 @@ void logMetalLibraryProbe() {
     NSBundle* bundle = [NSBundle mainBundle];
     NSString* resourcePath = [bundle resourcePath];
     if (resourcePath) {
-        NSLog(@"MetalRenderer: Bundle resources path: %@", resourcePath);
+        METAL_LOG_NOTICE(@"MetalRenderer: Bundle resources path: %@", resourcePath);
     } else {
-        NSLog(@"MetalRenderer: Bundle resources path not available");
+        METAL_LOG_ERROR(@"MetalRenderer: Bundle resources path not available");
     }
 
     NSString* defaultLibPath = [bundle pathForResource:@"default" ofType:@"metallib"];
@@ -51,13 +129,13 @@ void logMetalLibraryProbe() {
                                                                                error:&attrsError];
         if (attrs) {
             NSNumber* size = attrs[NSFileSize];
-            NSLog(@"MetalRenderer: default.metallib found (%@ bytes)", size);
+            METAL_LOG_NOTICE(@"MetalRenderer: default.metallib found (%@ bytes)", size);
         } else {
             NSString* errorText = attrsError ? attrsError.localizedDescription : @"unknown error";
-            NSLog(@"MetalRenderer: default.metallib found but attributes failed: %@", errorText);
+            METAL_LOG_ERROR(@"MetalRenderer: default.metallib found but attributes failed: %@", errorText);
         }
     } else {
-        NSLog(@"MetalRenderer: default.metallib not found in bundle resources");
+        METAL_LOG(::oflike::OF_LOG_WARNING, @"MetalRenderer: default.metallib not found in bundle resources");
     }
 
     if (resourcePath) {
@@ -73,9 +151,9 @@ void logMetalLibraryProbe() {
                     break;
                 }
             }
-            NSLog(@"MetalRenderer: Bundle debug data files (.dat/.dia): %@", hasDebugData ? @"present" : @"none");
+            METAL_LOG_NOTICE(@"MetalRenderer: Bundle debug data files (.dat/.dia): %@", hasDebugData ? @"present" : @"none");
         } else if (contentsError) {
-            NSLog(@"MetalRenderer: Failed to read bundle resources: %@", contentsError.localizedDescription);
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to read bundle resources: %@", contentsError.localizedDescription);
         }
     }
 }
@@ -91,10 +169,188 @@ id<MTLLibrary> loadBundledLibrary(id<MTLDevice> device) {
     id<MTLLibrary> library = [device newLibraryWithFile:defaultLibPath error:&fileError];
     if (!library && isMetalDebugEnabled()) {
         NSString* errorText = fileError ? fileError.localizedDescription : @"unknown error";
-        NSLog(@"MetalRenderer: Failed to load default.metallib: %@", errorText);
+        METAL_LOG_ERROR(@"MetalRenderer: Failed to load default.metallib: %@", errorText);
     }
     return library;
 }
+
+// Attachment formats of a resolved variant (depth/stencil formats also set the stencil format)
+template <typename Descriptor>
+void applyAttachmentFormats(Descriptor* desc, const PipelineVariant& variant) {
+    const MTLPixelFormat depthFormat = (MTLPixelFormat)variant.depthFormat;
+    desc.colorAttachments[0].pixelFormat = (MTLPixelFormat)variant.colorFormat;
+    desc.depthAttachmentPixelFormat = depthFormat;
+    if (depthFormat == MTLPixelFormatDepth32Float_Stencil8 || depthFormat == MTLPixelFormatDepth24Unorm_Stencil8) {
+        desc.stencilAttachmentPixelFormat = depthFormat;
+    }
+    desc.rasterSampleCount = variant.sampleCount;
+}
+
+// Fixed-function blending of a resolved variant (off without a color attachment)
+template <typename Descriptor>
+void applyBlendConfig(Descriptor* desc, const PipelineVariant& variant) {
+    BlendConfig blendConfig = BlendConfig::forMode(variant.blendMode);
+    if (variant.colorFormat == (uint32_t)MTLPixelFormatInvalid) {
+        blendConfig.blendingEnabled = false;
+    }
+    desc.colorAttachments[0].blendingEnabled = blendConfig.blendingEnabled;
+    desc.colorAttachments[0].rgbBlendOperation = (MTLBlendOperation)blendConfig.rgbBlendOperation;
+    desc.colorAttachments[0].alphaBlendOperation = (MTLBlendOperation)blendConfig.alphaBlendOperation;
+    desc.colorAttachments[0].sourceRGBBlendFactor = (MTLBlendFactor)blendConfig.sourceRGBBlendFactor;
+    desc.colorAttachments[0].destinationRGBBlendFactor = (MTLBlendFactor)blendConfig.destinationRGBBlendFactor;
+    desc.colorAttachments[0].sourceAlphaBlendFactor = (MTLBlendFactor)blendConfig.sourceAlphaBlendFactor;
+    desc.colorAttachments[0].destinationAlphaBlendFactor = (MTLBlendFactor)blendConfig.destinationAlphaBlendFactor;
+}
+
+// Pipeline archive location: OFL_PIPELINE_ARCHIVE overrides the path ("0"
+// disables the archive), otherwise a per-GPU file in the app's caches folder
+NSURL* pipelineArchiveURL(id<MTLDevice> device) {
+    const char* value = std::getenv("OFL_PIPELINE_ARCHIVE");
+    if (value && value[0] != '\0') {
+        if (std::strcmp(value, "0") == 0) {
+            return nil;
+        }
+        return [NSURL fileURLWithPath:@(value)];
+    }
+
+    NSURL* caches = [[[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory
+                                                            inDomains:NSUserDomainMask] firstObject];
+    if (!caches) {
+        return nil;
+    }
+    NSString* appName = [[NSBundle mainBundle] bundleIdentifier];
+    if (!appName) {
+        appName = [[NSProcessInfo processInfo] processName];
+    }
+
+    // Archives only hold binaries for the GPU they were built on
+    NSURL* directory = [caches URLByAppendingPathComponent:appName isDirectory:YES];
+    NSString* fileName = [NSString stringWithFormat:@"PipelineArchive-%llx.metallib", device.registryID];
+    return [directory URLByAppendingPathComponent:fileName];
+}
+
+// Index range of a command that draws recorded indices
+bool commandIndexRange(CommandRef cmd, uint32_t& offset, uint32_t& count, uint32_t& vertices) {
+    switch (cmd.type) {
+        case CommandType::Draw2D: {
+            const DrawCommand2D& draw = cmd.as<DrawCommand2D>();
+            offset = draw.indexOffset;
+            count = draw.indexCount;
+            vertices = draw.vertexCount;
+            return count > 0;
+        }
+        case CommandType::Draw3D:
+        case CommandType::Draw3DInstanced:
+        case CommandType::Draw3DIndirect: {
+            const DrawCommand3D& draw = cmd.as<DrawCommand3D>();
+            offset = draw.indexOffset;
+            count = draw.indexCount;
+            vertices = draw.vertexCount;
+            return count > 0 && !draw.vertexBuffer;     // Resident indices live with the mesh
+        }
+        default:
+            return false;
+    }
+}
+
+MTLPrimitiveType metalPrimitiveType(PrimitiveType type) {
+    switch (type) {
+        case PrimitiveType::Point:
+            return MTLPrimitiveTypePoint;
+        case PrimitiveType::Line:
+            return MTLPrimitiveTypeLine;
+        case PrimitiveType::LineStrip:
+            return MTLPrimitiveTypeLineStrip;
+        case PrimitiveType::TriangleStrip:
+            return MTLPrimitiveTypeTriangleStrip;
+        case PrimitiveType::Triangle:
+        default:
+            return MTLPrimitiveTypeTriangle;
+    }
+}
+
+simd_float3x3 upperLeft3x3(const simd_float4x4& m) {
+    return simd_matrix(
+        simd_make_float3(m.columns[0].x, m.columns[0].y, m.columns[0].z),
+        simd_make_float3(m.columns[1].x, m.columns[1].y, m.columns[1].z),
+        simd_make_float3(m.columns[2].x, m.columns[2].y, m.columns[2].z)
+    );
+}
+
+// Warp mesh vertex (matches DisplayOutputVertex in DisplayOutput.metal)
+struct DisplayOutputVertex {
+    simd_float2 position;
+    simd_float2 slice;
+};
+
+// Per-output parameters (matches DisplayOutputUniforms in DisplayOutput.metal)
+struct DisplayOutputUniforms {
+    simd_float4 source;
+    simd_float4 blendWidth;
+    float blendCurve;
+    float blendGamma;
+};
+
+// Meshlet layout of a mesh primitive draw (matches MeshPrimitiveParams in
+// MeshPrimitives.metal). Meshlets are square (or triangular) lattices of
+// segments per side, a power of two up to kMeshletSegments, chosen so none
+// spans more than a quarter turn; the resolution is rounded up to whole
+// meshlets.
+struct MeshPrimitiveParams {
+    uint32_t primitive;
+    uint32_t segments;
+    uint32_t columns;           // Around (sphere, cylinder) or per face edge (icosphere)
+    uint32_t rows;              // Pole to pole (sphere)
+    uint32_t meshletCount;      // Per instance
+    float edgePixels;
+    simd_float2 viewportSize;
+};
+
+MeshPrimitiveParams meshPrimitiveLayout(MeshPrimitive primitive, uint32_t resolution, float width, float height) {
+    auto powerOfTwoBelow = [](uint32_t value) {
+        uint32_t p = 1;
+        while (p * 2 <= value) {
+            p *= 2;
+        }
+        return p;
+    };
+    auto divideUp = [](uint32_t a, uint32_t b) { return (a + b - 1) / b; };
+
+    MeshPrimitiveParams params = {};
+    params.primitive = (uint32_t)primitive;
+    params.edgePixels = kMeshletEdgePixels;
+    params.viewportSize = simd_make_float2(width, height);
+    switch (primitive) {
+        case MeshPrimitive::Sphere: {
+            // resolution rings, twice as many segments around (as buildUnitSphere)
+            const uint32_t rings = std::max(resolution, 4u);
+            params.segments = std::clamp(powerOfTwoBelow(rings / 2), 1u, kMeshletSegments);
+            params.columns = divideUp(rings * 2, params.segments);
+            params.rows = divideUp(rings, params.segments);
+            params.meshletCount = params.columns * params.rows;
+            break;
+        }
+        case MeshPrimitive::Cylinder: {
+            // Side, top cap and bottom cap, one row of meshlets each
+            const uint32_t around = std::max(resolution, 3u);
+            params.segments = std::clamp(powerOfTwoBelow(around / 4), 1u, kMeshletSegments);
+            params.columns = std::max(divideUp(around, params.segments), 4u);
+            params.rows = 1;
+            params.meshletCount = params.columns * 3;
+            break;
+        }
+        case MeshPrimitive::IcoSphere: {
+            // Each face edge split 2^subdivisions times, as repeated midpoint subdivision
+            const uint32_t edge = 1u << std::min(resolution, 5u);
+            params.segments = std::min(edge, kMeshletSegments);
+            params.columns = edge / params.segments;
+            params.rows = params.columns;
+            params.meshletCount = 20 * params.columns * params.columns;
+            break;
+        }
+    }
+    return params;
+}
 }  // namespace
 
 // ============================================================================
@@ -106,32 +362,259 @@ struct MetalRenderer::Impl {
     id<MTLDevice> device = nil;
     id<MTLCommandQueue> commandQueue = nil;
     MTKView* view = nil;
-    MTKTextureLoader* textureLoader = nil;
+    MTKTextureLoader* textureLoader = nil;     // Created by getTextureLoader() on first use
+    std::mutex textureLoaderMutex;
 
-    // Pipeline states (cached by blend mode)
-    id<MTLRenderPipelineState> pipeline2D[11] = {nil};  // One per BlendMode (0-10)
-    id<MTLRenderPipelineState> pipeline2DTextured[11] = {nil};  // One per BlendMode (textured)
-    id<MTLRenderPipelineState> pipeline3D[11] = {nil};  // One per BlendMode
-    id<MTLRenderPipelineState> pipeline3DLit[11] = {nil};  // 3D with Phong lighting
+    // Pipeline variants, created on first use and cached by pipelineKey()
+    // (shader, blend mode, attachment formats, sample count); nil entries
+    // record variants that failed so they are not retried every draw
+    std::shared_mutex pipelineMutex;
+    std::unordered_map<uint64_t, id<MTLRenderPipelineState>> pipelines;
+
+    // Attachment formats of currentRenderPass, selecting the variant per draw
+    MTLPixelFormat passColorFormat = MTLPixelFormatBGRA8Unorm;
+    MTLPixelFormat passDepthFormat = MTLPixelFormatDepth32Float;
+    NSUInteger passSampleCount = 1;
 
     // Depth/stencil states
     id<MTLDepthStencilState> depthEnabledState = nil;
     id<MTLDepthStencilState> depthDisabledState = nil;
-
-    // Triple buffering
+    id<MTLDepthStencilState> depthTestOnlyState = nil;     // Tests, never writes (transparency)
+
+    // Binary archive of compiled pipelines, reloaded on the next launch so
+    // pipeline creation skips the backend compiler
+    id<MTLBinaryArchive> pipelineArchive = nil;
+    NSURL* pipelineArchiveFile = nil;
+    std::mutex pipelineArchiveMutex;
+    bool pipelineArchiveDirty = false;   // Functions added since the last save
+    dispatch_group_t pipelineArchiveSaves = dispatch_group_create();  // Background saves
+
+    // Shader library (kept for compute pipelines created on demand)
+    id<MTLLibrary> shaderLibrary = nil;
+    std::mutex computeMutex;
+    std::unordered_map<std::string, id<MTLComputePipelineState>> computePipelines;
+
+    // GPU image filters: one MPS kernel per filter type, rebuilt when its
+    // parameters change, and the blurred intermediate of unsharp masking
+    struct FilterKernel {
+        MPSUnaryImageKernel* kernel = nil;
+        uint32_t kernelWidth = 0;
+        uint32_t kernelHeight = 0;
+        float sigma = 0.0f;
+        std::vector<float> weights;
+    };
+    static constexpr size_t kFilterTypeCount = static_cast<size_t>(ImageFilterType::Median) + 1;
+    FilterKernel filterKernels[kFilterTypeCount];
+    id<MTLTexture> filterScratch = nil;
+
+    // Post-processing intermediates: transient textures made aliasable after
+    // their last use, so every stack in the frame shares one heap
+    id<MTLHeap> postHeap = nil;
+
+    // MetalFX scaler of CopyTextureFilter::Upscale, rebuilt when its texture sizes or formats change
+    id<MTLFXSpatialScaler> spatialScaler = nil;
+
+    // Sampler states (indexed by SamplerKey; anisotropic variants created on first use)
+    id<MTLSamplerState> samplerStates[kSamplerKeyCount] = {nil};
+
+    // Triple buffering; frames past the in-flight limit hold their
+    // semaphore counts back, and acquireFrameSlot() may take one early
     uint32_t currentFrameIndex = 0;
     dispatch_semaphore_t frameSemaphore;
-
-    // Vertex buffers (triple buffered)
-    id<MTLBuffer> vertexBuffer2D[kMaxFramesInFlight] = {nil, nil, nil};
-    id<MTLBuffer> vertexBuffer3D[kMaxFramesInFlight] = {nil, nil, nil};
-    id<MTLBuffer> indexBuffer[kMaxFramesInFlight] = {nil, nil, nil};
+    uint32_t framesInFlight = kMaxFramesInFlight;
+    bool slotAcquired = false;
+    double presentMinimumDuration = 0.0;  // Seconds; 0 presents at once
+
+    // Vertex/index storage: chunked ring, chunks recycled when a frame completes
+    std::unique_ptr<MetalRingAllocator> geometryRing;
+    RingAllocation frameVertices2D;  // This frame's 2D vertices
+    RingAllocation frameVertices3D;  // This frame's 3D vertices
+    RingAllocation framePacked2D;    // Executing list's PackedVertex2D stream
+    RingAllocation framePacked3D;    // Executing list's PackedVertex3D stream
+    RingAllocation frameIndices;     // This frame's indices
+    RingAllocation frameInstances;   // Executing list's instance stream
+    RingAllocation frameShapes;      // Executing list's SDF shape stream
+    RingAllocation frameStrokes;     // Executing list's stroke segment stream
+    RingAllocation framePaths;       // Executing list's path stream
+    RingAllocation framePathSegments; // Executing list's path edge stream
+    RingAllocation frameUniforms;    // Executing list's custom shader uniform snapshots
+
+    // Where each command of the uploading list finds its indices; indices
+    // are local to each command's vertices, so a batch whose vertices fit is
+    // narrowed to 16-bit indices
+    struct IndexRange {
+        uint32_t byteOffset = 0;     // Into frameIndices
+        IndexType type = IndexType::UInt32;
+    };
+    std::vector<IndexRange> indexRanges;
+
+    // Recorded display lists, uploaded once into their own buffer and
+    // replayed from it (keyed by DrawDisplayListCommand::listId)
+    struct ResidentDisplayList {
+        id<MTLBuffer> buffer = nil;
+        RingAllocation vertices2D, vertices3D, packed2D, packed3D, indices, instances, shapes, strokes;
+        RingAllocation paths, pathSegments, uniforms;
+        std::vector<IndexRange> indexRanges;
+        uint64_t lastUsedFrame = 0;
+
+        // Indirect replay of static unlit 3D lists: every draw is encoded
+        // once per frame slot, with its recorded uniforms resident in
+        // retainedUniforms and the replay transform in a per-frame slot after
+        // them. A slot is re-encoded only when the pass formats change.
+        bool retainedChecked = false;
+        bool retainedEligible = false;
+        id<MTLBuffer> retainedUniforms = nil;
+        id<MTLIndirectCommandBuffer> retainedCommands[kMaxFramesInFlight] = {nil, nil, nil};
+        uint64_t retainedPassKey[kMaxFramesInFlight] = {0, 0, 0};
+        uint64_t retainedFrame = UINT64_MAX;        // frameSerial of the last indirect replay
+        std::vector<id<MTLResource>> retainedResources;  // Buffers the commands read
+        size_t retainedDraws = 0;
+        uint32_t retainedVertices = 0;
+    };
+    std::unordered_map<uint64_t, ResidentDisplayList> residentDisplayLists;
+    uint64_t frameSerial = 0;   // Frames begun, for display list eviction
+    uint32_t displayListDepth = 0;
+
+    // Per-stream high-water marks (element counts), used to size the mapping
+    size_t peakVertices2D = kInitialVertices2D;
+    size_t peakVertices3D = kInitialVertices3D;
+    size_t peakIndices = kInitialIndices;
+
+    // Lighting/material blocks (triple buffered, grown on demand)
+    id<MTLBuffer> lightingBuffer[kMaxFramesInFlight] = {nil, nil, nil};
+    size_t lightingBytesUsed = 0;   // Bytes written to this frame's buffer so far
+    size_t lightingListOffset = 0;  // Start of the executing list's blocks
+    size_t lightingLightsOffset = 0;  // Start of the executing list's light pool
+    size_t lightingShadowsOffset = 0; // Start of the executing list's shadow blocks
+
+    // Shadow map rendering: while a pass is active only 3D draws run, depth-only
+    bool shadowPassActive = false;
+    id<MTLTexture> emptyShadowMap = nil;    // Bound for lights without a map
+
+    // Weighted blended transparency: order-independent 3D draws wait in
+    // transparentDraws (copies, with the viewport they were recorded under)
+    // until something must draw over them, then accumulate in a pass of
+    // their own and are composited over the executing pass
+    struct TransparentDrawState {
+        size_t index = 0;                   // Command in executingList (index ranges)
+        MTLViewport viewport;
+        MTLScissorRect scissor;
+        bool scissorEnabled = false;
+    };
+    CommandStream transparentDraws;
+    std::vector<TransparentDrawState> transparentDrawStates;
+    bool replayingTransparency = false;     // Executing transparentDraws
+    bool transparencyPassActive = false;    // ... into the accumulation targets
+    id<MTLTexture> transparencyAccumulation = nil;      // RGBA16Float, weighted premultiplied color
+    id<MTLTexture> transparencyRevealage = nil;         // R16Float, product of (1 - alpha)
+    id<MTLTexture> transparencyAccumulationMsaa = nil;  // Multisampled, resolved into the above
+    id<MTLTexture> transparencyRevealageMsaa = nil;
+
+    // Occlusion pyramid: the screen's depth at the end of a frame, reduced to
+    // the farthest depth per texel of each mip level, for the next frame's
+    // culling kernels (see VboMesh::cullInstances)
+    bool occlusionCullingEnabled = false;
+    id<MTLTexture> screenDepthTexture = nil;        // Depth attachment of this frame's screen passes
+    id<MTLTexture> occlusionDepthCopy = nil;        // Shader-readable copy of screenDepthTexture
+    id<MTLTexture> occlusionPyramid = nil;          // R32Float, level 0 at full resolution
+    std::vector<id<MTLTexture>> occlusionLevels;    // Single-level views written by the reduction
+    bool occlusionPyramidValid = false;
+
+    // Object ID picking: on frames with a pick request each list's screen 3D
+    // draws replay into an R32Uint target with their objectId; the texel at
+    // the request is copied out at the end of the frame and read when the
+    // frame completes, so nothing waits for the GPU
+    bool objectIdPickPending = false;       // Requested for the frame being recorded
+    float objectIdPickX = 0.0f;             // Fraction of the screen, top-left origin
+    float objectIdPickY = 0.0f;
+    bool objectIdPassActive = false;        // Replaying into the ID target
+    bool objectIdRendered = false;          // ID target holds this frame's draws
+    id<MTLTexture> objectIdTexture = nil;   // R32Uint, screen size, 0 = no object
+    id<MTLTexture> objectIdDepth = nil;     // Its own Depth32Float
+    id<MTLBuffer> objectIdReadback[kMaxFramesInFlight] = {nil, nil, nil};
+    mutable std::mutex objectIdMutex;       // Guards the result (completed handlers)
+    uint32_t objectIdResult = 0;
+    uint64_t objectIdResultSerial = 0;
+
+    // Variable rasterization rate: passes on a target with a rate draw into a
+    // smaller physical texture through a rate map, resolved to the target (or
+    // the drawable) at full size when its contents are next needed
+    struct RateTarget {
+        RasterizationRate rate;
+        id<MTLRasterizationRateMap> map = nil;  // Built for width x height
+        id<MTLBuffer> parameters = nil;         // Map data for the resolve shader
+        id<MTLTexture> physical = nil;          // Color at the map's physical size
+        id<MTLTexture> depth = nil;             // Screen only; FBOs use targetDepthTexture
+        NSUInteger width = 0;
+        NSUInteger height = 0;
+        bool drawn = false;                     // Physical holds draws not yet resolved
+    };
+    std::unordered_map<void*, RateTarget> rateTargets;  // By target texture, nullptr = screen
+    bool rateMapsSupported = false;
+    bool meshShadersSupported = false;         // Object/mesh pipelines (Metal 3 GPUs)
+    MTLRenderPassDescriptor* rateScreenPass = nil;      // This frame's screen pass with a rate
+    std::unordered_map<NSUInteger, id<MTLRenderPipelineState>> rateResolvePipelines;  // By pixel format
+
+    // Display outputs: layers on other displays that show slices of one
+    // source texture, warped and edge-blended at the end of each frame and
+    // presented from its command buffer with the view's drawable
+    struct DisplayOutput {
+        CAMetalLayer* layer = nil;
+        DisplayOutputConfig config;
+        id<MTLBuffer> mesh = nil;               // DisplayOutputVertex triangles
+        NSUInteger vertexCount = 0;
+        bool meshDirty = true;
+    };
+    std::mutex displayOutputMutex;              // Outputs change on the main thread, draw at endFrame
+    std::unordered_map<int, DisplayOutput> displayOutputs;
+    int nextDisplayOutput = 1;
+    id<MTLTexture> displayOutputSource = nil;
+    std::unordered_map<NSUInteger, id<MTLRenderPipelineState>> displayOutputPipelines;  // By pixel format
+
+    // Light cluster grids (triple buffered, grown on demand), written by the
+    // buildLightClusters kernel; one grid per light set and projection
+    struct LightClusterGrid {
+        uint32_t firstLight = 0;
+        int lightCount = 0;
+        simd_float4x4 projection;
+        id<MTLBuffer> buffer = nil;
+        size_t offset = 0;
+        float nearZ = 0.0f;
+        float scale = 0.0f;                 // kClusterSlices / log(far / near)
+    };
+    id<MTLBuffer> clusterBuffer[kMaxFramesInFlight] = {nil, nil, nil};
+    size_t clusterBytesUsed = 0;
+    std::vector<LightClusterGrid> lightClusterGrids;  // Grids of the executing list
+
+    // Shadow of the state bound on currentEncoder. Calls that would rebind the
+    // same value are skipped; reset whenever the encoder ends.
+    struct EncoderStateCache {
+        id<MTLRenderPipelineState> pipeline = nil;
+        id<MTLDepthStencilState> depthStencil = nil;
+        int cullMode = -1;                       // MTLCullMode, -1 = unknown
+        id<MTLBuffer> vertexBuffer = nil;
+        NSUInteger vertexBufferOffset = 0;
+        id<MTLTexture> fragmentTextures[16] = {nil};
+        id<MTLSamplerState> fragmentSampler = nil;
+        uint16_t lightingHandle = kInvalidLightingHandle;
+        int lightClusterGrid = -1;               // Grid bound with lightingHandle
+        uint8_t vertexUniforms[256];             // Last setVertexBytes at buffer(1)
+        size_t vertexUniformsSize = 0;
+        uint8_t fragmentUniforms[256];           // Last setFragmentBytes at buffer(1)
+        size_t fragmentUniformsSize = 0;
+    };
+    EncoderStateCache encoderState;
 
     // Current frame state
     id<MTLCommandBuffer> currentCommandBuffer = nil;
     id<MTLRenderCommandEncoder> currentEncoder = nil;
     MTLRenderPassDescriptor* currentRenderPass = nil;
 
+    // Screen target captured by the caller for the next frame (pipelined mode);
+    // nil = query the view when the frame needs it
+    id<CAMetalDrawable> frameDrawable = nil;
+    MTLRenderPassDescriptor* frameRenderPass = nil;
+
     // Current render state
     BlendMode currentBlendMode = BlendMode::Alpha;
     bool depthTestEnabled = false;
@@ -145,18 +628,76 @@ struct MetalRenderer::Impl {
     // Render target state
     id<MTLTexture> currentRenderTarget = nil;  // nil = render to view (default)
     id<MTLTexture> depthTarget = nil;          // Depth buffer for current render target
+    id<MTLTexture> transientDepthTarget = nil; // Memoryless depth for targets that never reload it
+    id<MTLTexture> msaaTarget = nil;           // Multisample color resolved into the render target
+    id<MTLTexture> transientMsaaTarget = nil;  // Memoryless multisample color, resolved per pass
+    uint32_t targetSampleCount = 1;            // MSAA samples of the current render target
+    bool memorylessSupported = false;          // Apple GPUs only (tile memory)
+    bool framebufferFetchSupported = false;    // Apple GPUs only ([[color(0)]] fragment inputs)
+
+    // Load/store planning: depth survives an encoder only if a later one
+    // loads it, and contents are cleared rather than loaded when stale
+    const DrawList* executingList = nullptr;   // List being encoded (nullptr = none / parallel)
+    size_t executingIndex = 0;                 // Command being executed in executingList
+    bool listsFollow = true;                   // More recorded work after executingList
+    bool screenStarted = false;                // A screen encoder already ran this frame
+    bool screenDepthValid = false;             // View depth holds this frame's contents
+    bool targetDepthValid = false;             // FBO depth holds this begin()'s contents
+    bool targetSamplesValid = false;           // FBO multisample color holds this begin()'s contents
 
     // Custom shader state
     id<MTLRenderPipelineState> customPipelineState = nil;  // nil = use default pipeline
-    std::vector<uint8_t> customUniformBuffer;
+    uint32_t customUniformOffset = 0;   // Snapshot in frameUniforms
+    uint32_t customUniformSize = 0;     // 0 = no uniforms
     id<MTLTexture> customTextures[16] = {nil};
 
+    // Per-pass GPU timeline; each frame slot owns a counter sample buffer
+    // holding start/end timestamps of its passes in submission order
+    struct TimelineFrame {
+        id<MTLCounterSampleBuffer> samples = nil;
+        uint32_t passCount = 0;
+        char names[kMaxTimelinePasses][32] = {};
+        MTLTimestamp cpuStart = 0;   // CPU/GPU clock correlation at beginFrame
+        MTLTimestamp gpuStart = 0;
+    };
+    TimelineFrame timelineFrames[kMaxFramesInFlight];
+    mutable std::mutex timelineMutex;     // Guards passCount and lastTimeline
+    std::vector<GPUPassTiming> lastTimeline;
+
     // Statistics
     uint32_t frameDrawCalls = 0;
     uint32_t frameVertices = 0;
+    uint32_t frameSkippedStateChanges = 0;  // Encoder calls filtered by encoderState
+    uint32_t frameCulledDraws = 0;          // Draws frustum-culled while recording
     double lastGPUTime = 0.0;  // Last measured GPU time in milliseconds
     CFTimeInterval frameStartTime = 0.0;  // CPU frame start time
 
+    // Staged texture uploads: CPU data for private-storage textures waits in
+    // a shared batch buffer until one blit encoder copies it ahead of the
+    // frame's passes. Batches are recycled once their command buffer completes.
+    struct TextureUpload {
+        id<MTLTexture> texture = nil;
+        MTLRegion region;
+        NSUInteger level = 0;
+        NSUInteger offset = 0;        // In the batch buffer
+        NSUInteger bytesPerRow = 0;
+        NSUInteger bytesPerImage = 0;
+    };
+    struct UploadBatch {
+        id<MTLBuffer> buffer = nil;
+        size_t used = 0;
+        std::vector<TextureUpload> uploads;
+    };
+    std::mutex uploadMutex;               // Guards the members below (any thread uploads)
+    UploadBatch openUploads;
+    std::vector<id<MTLBuffer>> freeStagingBuffers;
+    size_t textureUploadBudget = kDefaultTextureUploadBudget;
+
+    // Latest frame seen on screen (drawable presented handlers)
+    mutable std::mutex presentMutex;
+    uint64_t presentedSerial = 0;
+    CFTimeInterval presentedTime = 0.0;
+
     // Initialization flag
     bool initialized = false;
 
@@ -168,36 +709,179 @@ struct MetalRenderer::Impl {
 
     ~Impl() {
         shutdown();
+        dispatch_group_wait(pipelineArchiveSaves, DISPATCH_TIME_FOREVER);
     }
 
     bool initialize();
     void shutdown();
     bool createPipelines();
+    void openPipelineArchive();
+    void savePipelineArchive();
+    id<MTLRenderPipelineState> newPipelineState(MTLRenderPipelineDescriptor* descriptor, NSError** error,
+                                                MTLAutoreleasedRenderPipelineReflection* reflection = nullptr);
     id<MTLRenderPipelineState> createPipelineVariant(id<MTLLibrary> library, const char* vertexFunc,
-                                                       const char* fragmentFunc, BlendMode blendMode);
+                                                       const char* fragmentFunc, const PipelineVariant& variant);
     id<MTLRenderPipelineState> createProgrammableBlendPipeline(id<MTLLibrary> library, const char* vertexFunc,
-                                                                 const char* fragmentFunc);
+                                                                 const char* fragmentFunc,
+                                                                 const PipelineVariant& variant);
+    id<MTLRenderPipelineState> createMeshPipelineVariant(id<MTLLibrary> library, const char* fragmentFunc,
+                                                           const PipelineVariant& variant);
+    static uint64_t pipelineKey(const PipelineVariant& variant);
+    PipelineVariant resolveVariant(const PipelineVariant& variant) const;
+    id<MTLRenderPipelineState> createPipeline(const PipelineVariant& variant);
+    id<MTLRenderPipelineState> getPipeline(const PipelineVariant& variant);
+    id<MTLRenderPipelineState> getPassPipeline(PipelineShader shader, BlendMode blendMode,
+                                               VertexFormat vertexFormat = VertexFormat::Float);
+    size_t prewarm(const PipelineVariant* variants, size_t count);
     bool createBuffers();
+    bool uploadGeometry(const DrawList& drawList);
+    bool uploadIndices(const DrawList& drawList);
+    const IndexRange* currentIndexRange(const DrawList& drawList) const;
     bool createDepthStencilStates();
+    bool createSamplerStates();
+    void createTimestampBuffers();
+    int32_t reserveTimelinePass(const char* name);
+    bool attachTimestamps(MTLRenderPassDescriptor* pass, const char* name);
+    bool attachTimestamps(MTLComputePassDescriptor* pass, const char* name);
+    void resolveTimeline(uint32_t frameIndex);
+    id<MTLRenderCommandEncoder> beginRenderEncoder(MTLRenderPassDescriptor* pass,
+                                                   bool clearColor = false, bool clearDepth = false);
+    void configureLoadStore(MTLRenderPassDescriptor* pass, bool clearColor, bool clearDepth);
+    bool laterPassLoadsDepth() const;
+    void buildOcclusionPyramid();
+    bool executeObjectIdPass(const DrawList& drawList, bool onScreen);
+    void readObjectIdPick();
+    bool targetReloads(bool depth) const;
+    id<MTLTexture> targetDepthTexture(NSUInteger width, NSUInteger height, NSUInteger samples, bool memoryless);
+    id<MTLTexture> targetMultisampleTexture(id<MTLTexture> target, NSUInteger samples, bool memoryless);
+    RateTarget* findRateTarget(void* key);
+    bool prepareRateTarget(RateTarget& target, MTLPixelFormat format, NSUInteger width, NSUInteger height,
+                           MTLPixelFormat depthFormat);
+    MTLRenderPassDescriptor* rateScreenPassDescriptor(MTLRenderPassDescriptor* screenPass);
+    bool resolveRasterizationRate(void* key);
+    void resolveRasterizationRates();
+    bool buildDisplayOutputMesh(DisplayOutput& output);
+    id<MTLRenderPipelineState> getDisplayOutputPipeline(MTLPixelFormat format);
+    void encodeDisplayOutputs();
+    const char* currentPassName() const;
+    id<MTLSamplerState> createSamplerState(SamplerKey key);
+    id<MTLSamplerState> getSamplerState(SamplerKey key);
+    MTKTextureLoader* getTextureLoader();
+    bool uploadLightingStates(const DrawList& drawList);
+    static bool needsLightClusters(const DrawList& drawList);
+    bool buildLightClusters(const DrawList& drawList, const simd_float4x4* projectionOverride = nullptr);
+    const LightClusterGrid* findLightClusterGrid(const LightingState& lighting,
+                                                 const simd_float4x4& projection) const;
+    bool uploadDrawList(const DrawList& drawList);
+    bool executeCommands(const DrawList& drawList);
+    bool executeParallel(const DrawList* const* drawLists, size_t count);
+    static bool isParallelEncodable(const DrawList& drawList);
 
     // Frame management
     bool beginFrame();
     bool endFrame();
 
     // Command execution
-    bool executeCommand(const DrawCommand& cmd, const DrawList& drawList);
+    bool executeCommand(const CommandRef& cmd, const DrawList& drawList);
     bool executeDraw2D(const DrawCommand2D& cmd, const DrawList& drawList);
-    bool executeDraw3D(const DrawCommand3D& cmd, const DrawList& drawList);
+    // Instanced 2D draw whose vertex shader expands records of a list stream
+    // (SDF shapes, stroke segments, path fills)
+    struct Instanced2DDraw {
+        const char* name = "";                // For log messages
+        PipelineShader shader = PipelineShader::Shapes2D;
+        const RingAllocation* records = nullptr;
+        size_t recordSize = 0;
+        const RingAllocation* fragmentRecords = nullptr;  // Whole stream at fragment buffer(0), nullptr = none
+        uint32_t first = 0;
+        uint32_t count = 0;
+        uint32_t verticesPerRecord = 0;
+        MTLPrimitiveType primitive = MTLPrimitiveTypeTriangle;
+        BlendMode blendMode = BlendMode::Alpha;
+        simd_float4x4 transform = matrix_identity_float4x4;
+    };
+    bool executeDraw2DInstanced(const Instanced2DDraw& draw);
+    bool executeDrawPointCloud(const DrawPointCloudCommand& cmd);
+    // Per-draw instancing/indirect parameters for executeDraw3D
+    struct InstancedDraw {
+        id<MTLBuffer> instanceBuffer = nil;   // InstanceData at vertex buffer(2), nil = none
+        NSUInteger instanceOffset = 0;        // First record
+        NSUInteger instanceBase = 0;          // Byte offset of record 0 in instanceBuffer
+        NSUInteger instanceCount = 1;
+        id<MTLBuffer> argumentBuffer = nil;   // Indirect arguments, nil = direct draw
+        NSUInteger argumentOffset = 0;
+        const DrawMeshPrimitivesCommand* meshPrimitives = nullptr;  // Object/mesh-shader draw, no vertices
+    };
+    bool executeDraw3D(const DrawCommand3D& cmd, const DrawList& drawList,
+                       const InstancedDraw* instancing = nullptr);
+    bool executeDispatchCompute(const DispatchComputeCommand& cmd);
+    bool executeReadbackTexture(const ReadbackTextureCommand& cmd);
+    bool executeFilterTexture(const FilterTextureCommand& cmd);
+    bool executeGenerateMipmaps(const GenerateMipmapsCommand& cmd);
+    bool executeConvertYCbCr(const ConvertYCbCrCommand& cmd);
+    bool executeConvertYCoCg(const ConvertYCoCgCommand& cmd);
+    bool executeCopyTexture(const CopyTextureCommand& cmd);
+    bool encodeSpatialUpscale(id<MTLTexture> source, id<MTLTexture> destination,
+                              NSUInteger width, NSUInteger height);
+    MPSUnaryImageKernel* getFilterKernel(const FilterTextureCommand& cmd, ImageFilterType filter);
+    bool encodeImageKernel(const char* functionName, const std::initializer_list<id<MTLTexture>>& textures,
+                           const void* bytes, size_t length, NSUInteger width, NSUInteger height);
+    void dispatchImageKernel(id<MTLComputeCommandEncoder> encoder, id<MTLComputePipelineState> pipeline,
+                             const std::initializer_list<id<MTLTexture>>& textures,
+                             const void* bytes, size_t length, NSUInteger width, NSUInteger height);
+    bool executePostProcess(const PostProcessCommand& cmd);
+    bool encodePostFused(const PostProcessCommand& cmd, const PostProcessPass* pass, id<MTLTexture> input,
+                         id<MTLTexture> bloom, float bloomIntensity, id<MTLTexture> output,
+                         NSUInteger width, NSUInteger height);
+    id<MTLTexture> encodeBloom(const PostProcessPass& pass, id<MTLTexture> input, NSUInteger width, NSUInteger height);
+    bool reservePostHeap(NSUInteger size);
+    id<MTLTexture> newPostTexture(NSUInteger width, NSUInteger height);
+    id<MTLComputePipelineState> getComputePipeline(const char* functionName);
     bool executeSetViewport(const SetViewportCommand& cmd);
     bool executeSetScissor(const SetScissorCommand& cmd);
     bool executeClear(const SetClearCommand& cmd);
     bool executeSetRenderTarget(const SetRenderTargetCommand& cmd);
     bool executeSetCustomShader(const SetCustomShaderCommand& cmd);
+    bool executeDisplayList(const DrawDisplayListCommand& cmd);
+    bool executeRenderShadowMap(const RenderShadowMapCommand& cmd);
+    static bool castsShadow(CommandType type);
+    static bool isOrderIndependent(const CommandRef& cmd);
+    static bool drawsUnderTransparency(const CommandRef& cmd);
+    void deferTransparentDraw(const CommandRef& cmd);
+    bool resolveTransparency();
+    MTLRenderPassDescriptor* transparencyPassDescriptor(MTLRenderPassDescriptor* renderPass);
+    bool ensureTransparencyTargets(NSUInteger width, NSUInteger height, NSUInteger samples);
+    id<MTLRenderPipelineState> createTransparencyPipeline(id<MTLLibrary> library, const char* vertexFunc,
+                                                          const char* fragmentFunc, const PipelineVariant& variant);
+    id<MTLTexture> getEmptyShadowMap();
+    ResidentDisplayList* getResidentDisplayList(uint64_t listId, const DrawList& drawList);
+    static bool isRetainable(const DrawList& drawList);
+    bool encodeRetainedCommands(ResidentDisplayList& resident, const DrawList& drawList);
+    bool executeRetainedDisplayList(const DrawDisplayListCommand& cmd, ResidentDisplayList& resident);
 
     // State management
     void applyBlendMode(BlendMode mode);
     void applyDepthState(bool enabled);
 
+    // Encoder binding through the shadow state (skip redundant calls)
+    void bindPipeline(id<MTLRenderPipelineState> pipeline);
+    void bindDepthStencilState(id<MTLDepthStencilState> state);
+    void bindVertexBuffer(id<MTLBuffer> buffer, NSUInteger offset);
+    void bindVertexUniforms(const void* bytes, size_t length);
+    void bindFragmentUniforms(const void* bytes, size_t length);
+    void bindFragmentTexture(id<MTLTexture> texture, uint32_t index);
+    void bindFragmentSampler(id<MTLSamplerState> sampler);
+    void bindCullMode(MTLCullMode mode);
+
+    // Texture uploads
+    bool writeTexture(id<MTLTexture> texture, MTLRegion region, NSUInteger level, const void* data,
+                      size_t bytesPerRow, size_t rowBytes, size_t rows);
+    bool stageTextureUpload(id<MTLTexture> texture, MTLRegion region, NSUInteger level, const void* data,
+                            size_t bytesPerRow, size_t rowBytes, size_t rows);
+    bool writeBaseLevel(id<MTLTexture> texture, const void* data);
+    void encodeTextureUploads(id<MTLCommandBuffer> commandBuffer, UploadBatch& batch);
+    bool submitTextureUploads(UploadBatch& batch);
+    void flushTextureUploads();
+
     // Helper functions
     void endCurrentEncoder();
     MTLRenderPassDescriptor* getCurrentRenderPassDescriptor();
@@ -216,28 +900,52 @@ bool MetalRenderer::Impl::initialize() {
         // Create command queue
         commandQueue = [device newCommandQueue];
         if (!commandQueue) {
-            NSLog(@"MetalRenderer: Failed to create command queue");
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create command queue");
             return false;
         }
 
-        // Create texture loader
-        textureLoader = [[MTKTextureLoader alloc] initWithDevice:device];
-
-        // Create pipelines
-        if (!createPipelines()) {
-            return false;
+        // Loading the shader library and compiling the default pipelines is
+        // most of startup; it runs on a worker, as do the GPU timeline's
+        // counter buffers, while the rest is created here. The texture
+        // loader and most sampler states wait for first use.
+        __block bool pipelinesCreated = false;
+        dispatch_group_t startup = dispatch_group_create();
+        dispatch_queue_t workers = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+        dispatch_group_async(startup, workers, ^{
+            OF_STARTUP_SCOPE("Shader library and default pipelines");
+            pipelinesCreated = createPipelines();
+        });
+        // GPU timeline (optional; not every GPU samples at stage boundaries)
+        dispatch_group_async(startup, workers, ^{
+            OF_STARTUP_SCOPE("GPU timeline buffers");
+            createTimestampBuffers();
+        });
+
+        // Buffers, depth/stencil and sampler states
+        bool statesCreated;
+        {
+            OF_STARTUP_SCOPE("Renderer states");
+            statesCreated = createBuffers() && createDepthStencilStates() && createSamplerStates();
         }
 
-        // Create buffers
-        if (!createBuffers()) {
-            return false;
+        {
+            OF_STARTUP_SCOPE("Wait for pipelines");
+            dispatch_group_wait(startup, DISPATCH_TIME_FOREVER);
         }
-
-        // Create depth/stencil states
-        if (!createDepthStencilStates()) {
+        if (!pipelinesCreated || !statesCreated) {
             return false;
         }
 
+        // Tile-memory depth for render targets that never reload it
+        memorylessSupported = [device supportsFamily:MTLGPUFamilyApple1];
+        framebufferFetchSupported = memorylessSupported;
+        rateMapsSupported = [device supportsRasterizationRateMapWithLayerCount:1];
+
+        // Mesh primitives need the GPU family and the functions (absent
+        // from the source fallback library)
+        meshShadersSupported = [device supportsFamily:MTLGPUFamilyMetal3] &&
+                               [shaderLibrary.functionNames containsObject:@"meshPrimitive"];
+
         // Set initial viewport to view size
         currentViewport.originX = 0;
         currentViewport.originY = 0;
@@ -247,7 +955,7 @@ bool MetalRenderer::Impl::initialize() {
         currentViewport.zfar = 1.0;
 
         initialized = true;
-        NSLog(@"MetalRenderer: Initialized successfully");
+        METAL_LOG_NOTICE(@"MetalRenderer: Initialized successfully");
         return true;
     }
 }
@@ -259,78 +967,152 @@ void MetalRenderer::Impl::shutdown() {
 
     @autoreleasepool {
         // Wait for all frames to complete
-        for (uint32_t i = 0; i < kMaxFramesInFlight; i++) {
+        for (uint32_t i = slotAcquired ? 1 : 0; i < framesInFlight; i++) {
             dispatch_semaphore_wait(frameSemaphore, DISPATCH_TIME_FOREVER);
         }
         // Restore semaphore count before teardown to avoid libdispatch dealloc trap.
         for (uint32_t i = 0; i < kMaxFramesInFlight; i++) {
             dispatch_semaphore_signal(frameSemaphore);
         }
+        framesInFlight = kMaxFramesInFlight;
+        slotAcquired = false;
 
         // Release buffers
+        frameVertices2D = RingAllocation();
+        frameVertices3D = RingAllocation();
+        framePacked2D = RingAllocation();
+        framePacked3D = RingAllocation();
+        frameIndices = RingAllocation();
+        frameInstances = RingAllocation();
+        frameShapes = RingAllocation();
+        frameStrokes = RingAllocation();
+        framePaths = RingAllocation();
+        framePathSegments = RingAllocation();
+        frameUniforms = RingAllocation();
+        geometryRing.reset();
+        residentDisplayLists.clear();
+        emptyShadowMap = nil;
         for (uint32_t i = 0; i < kMaxFramesInFlight; i++) {
-            vertexBuffer2D[i] = nil;
-            vertexBuffer3D[i] = nil;
-            indexBuffer[i] = nil;
+            lightingBuffer[i] = nil;
         }
 
         // Release pipeline variants
-        for (int i = 0; i < 11; i++) {
-            pipeline2D[i] = nil;
-            pipeline2DTextured[i] = nil;
-            pipeline3D[i] = nil;
-            pipeline3DLit[i] = nil;
+        {
+            std::unique_lock<std::shared_mutex> lock(pipelineMutex);
+            pipelines.clear();
+        }
+        {
+            std::lock_guard<std::mutex> lock(computeMutex);
+            computePipelines.clear();
+        }
+        shaderLibrary = nil;
+        for (FilterKernel& filterKernel : filterKernels) {
+            filterKernel = FilterKernel();
+        }
+        filterScratch = nil;
+        postHeap = nil;
+        transparentDraws.clear();
+        transparentDrawStates.clear();
+        transparencyAccumulation = nil;
+        transparencyRevealage = nil;
+        transparencyAccumulationMsaa = nil;
+        transparencyRevealageMsaa = nil;
+        screenDepthTexture = nil;
+        occlusionDepthCopy = nil;
+        occlusionPyramid = nil;
+        occlusionLevels.clear();
+        occlusionPyramidValid = false;
+        rateTargets.clear();
+        rateScreenPass = nil;
+        rateResolvePipelines.clear();
+        {
+            std::lock_guard<std::mutex> lock(displayOutputMutex);
+            displayOutputs.clear();
+            displayOutputSource = nil;
+        }
+        displayOutputPipelines.clear();
+
+        // Keeps custom shader pipelines added after startup
+        dispatch_group_wait(pipelineArchiveSaves, DISPATCH_TIME_FOREVER);
+        savePipelineArchive();
+        pipelineArchive = nil;
+        pipelineArchiveFile = nil;
+
+        for (uint32_t i = 0; i < kMaxFramesInFlight; i++) {
+            timelineFrames[i].samples = nil;
         }
 
         depthEnabledState = nil;
         depthDisabledState = nil;
-        textureLoader = nil;
+        depthTestOnlyState = nil;
+        for (uint32_t i = 0; i < kSamplerKeyCount; i++) {
+            samplerStates[i] = nil;
+        }
+        {
+            std::lock_guard<std::mutex> lock(textureLoaderMutex);
+            textureLoader = nil;
+        }
         commandQueue = nil;
 
         // Release render target state
         currentRenderTarget = nil;
         depthTarget = nil;
+        transientDepthTarget = nil;
+        msaaTarget = nil;
+        transientMsaaTarget = nil;
 
         initialized = false;
-        NSLog(@"MetalRenderer: Shutdown complete");
+        METAL_LOG_NOTICE(@"MetalRenderer: Shutdown complete");
     }
 }
 
 id<MTLRenderPipelineState> MetalRenderer::Impl::createPipelineVariant(id<MTLLibrary> library,
                                                                         const char* vertexFunc,
                                                                         const char* fragmentFunc,
-                                                                        BlendMode blendMode) {
+                                                                        const PipelineVariant& variant) {
+    // Blend modes without a fixed-function equivalent blend in the fragment
+    // shader where the GPU can read the attachment; elsewhere they use the
+    // hardware approximation of BlendConfig::forMode()
+    const BlendMode mode = variant.blendMode;
+    if (fragmentFunc && mode >= BlendMode::Overlay && mode <= BlendMode::Difference &&
+        variant.colorFormat != (uint32_t)MTLPixelFormatInvalid && framebufferFetchSupported) {
+        id<MTLRenderPipelineState> pipeline = createProgrammableBlendPipeline(library, vertexFunc, fragmentFunc,
+                                                                              variant);
+        if (pipeline) {
+            return pipeline;
+        }
+        METAL_LOG_ERROR(@"MetalRenderer: Programmable blend not available for %s (mode %d), using hardware fallback",
+                        fragmentFunc, (int)mode);
+    }
+
     @autoreleasepool {
         NSError* error = nil;
 
+        // No fragment function: depth-only pipeline (shadow maps)
         id<MTLFunction> vertFunc = [library newFunctionWithName:@(vertexFunc)];
-        id<MTLFunction> fragFunc = [library newFunctionWithName:@(fragmentFunc)];
+        id<MTLFunction> fragFunc = fragmentFunc ? [library newFunctionWithName:@(fragmentFunc)] : nil;
 
-        if (!vertFunc || !fragFunc) {
-            NSLog(@"MetalRenderer: Failed to find shader functions: %s / %s", vertexFunc, fragmentFunc);
+        if (!vertFunc || (fragmentFunc && !fragFunc)) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to find shader functions: %s / %s", vertexFunc,
+                  fragmentFunc ? fragmentFunc : "(none)");
             return nil;
         }
 
         MTLRenderPipelineDescriptor* pipelineDesc = [[MTLRenderPipelineDescriptor alloc] init];
-        pipelineDesc.label = [NSString stringWithFormat:@"Pipeline_%s_Blend%d", vertexFunc, (int)blendMode];
+        const BlendMode blendMode = variant.blendMode;
+        pipelineDesc.label = [NSString stringWithFormat:@"Pipeline_%s_Blend%d_Fmt%u_%u_x%u", vertexFunc,
+                              (int)blendMode, variant.colorFormat, variant.depthFormat, variant.sampleCount];
         pipelineDesc.vertexFunction = vertFunc;
         pipelineDesc.fragmentFunction = fragFunc;
-        pipelineDesc.colorAttachments[0].pixelFormat = MTLPixelFormatBGRA8Unorm;
-        pipelineDesc.depthAttachmentPixelFormat = MTLPixelFormatDepth32Float;
-
-        // Apply blend configuration
-        BlendConfig blendConfig = BlendConfig::forMode(blendMode);
-        pipelineDesc.colorAttachments[0].blendingEnabled = blendConfig.blendingEnabled;
-        pipelineDesc.colorAttachments[0].rgbBlendOperation = (MTLBlendOperation)blendConfig.rgbBlendOperation;
-        pipelineDesc.colorAttachments[0].alphaBlendOperation = (MTLBlendOperation)blendConfig.alphaBlendOperation;
-        pipelineDesc.colorAttachments[0].sourceRGBBlendFactor = (MTLBlendFactor)blendConfig.sourceRGBBlendFactor;
-        pipelineDesc.colorAttachments[0].destinationRGBBlendFactor = (MTLBlendFactor)blendConfig.destinationRGBBlendFactor;
-        pipelineDesc.colorAttachments[0].sourceAlphaBlendFactor = (MTLBlendFactor)blendConfig.sourceAlphaBlendFactor;
-        pipelineDesc.colorAttachments[0].destinationAlphaBlendFactor = (MTLBlendFactor)blendConfig.destinationAlphaBlendFactor;
-
-        id<MTLRenderPipelineState> pipeline = [device newRenderPipelineStateWithDescriptor:pipelineDesc error:&error];
+        pipelineDesc.supportIndirectCommandBuffers = variant.shader == PipelineShader::Retained3D ||
+                                                     variant.shader == PipelineShader::RetainedInstanced3D;
+        applyAttachmentFormats(pipelineDesc, variant);
+
+        applyBlendConfig(pipelineDesc, variant);
+
+        id<MTLRenderPipelineState> pipeline = newPipelineState(pipelineDesc, &error);
         if (!pipeline) {
-            NSLog(@"MetalRenderer: Failed to create pipeline %s (blend %d): %@",
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create pipeline %s (blend %d): %@",
                   vertexFunc, (int)blendMode, error.localizedDescription);
             return nil;
         }
@@ -341,37 +1123,506 @@ id<MTLRenderPipelineState> MetalRenderer::Impl::createPipelineVariant(id<MTLLibr
 
 id<MTLRenderPipelineState> MetalRenderer::Impl::createProgrammableBlendPipeline(id<MTLLibrary> library,
                                                                                    const char* vertexFunc,
-                                                                                   const char* fragmentFunc) {
+                                                                                   const char* fragmentFunc,
+                                                                                   const PipelineVariant& variant) {
     @autoreleasepool {
         NSError* error = nil;
 
+        // The {fragmentFunc}Blend variant, specialized for the mode (BlendModes.h)
+        const uint32_t mode = (uint32_t)variant.blendMode;
+        MTLFunctionConstantValues* constants = [[MTLFunctionConstantValues alloc] init];
+        [constants setConstantValue:&mode type:MTLDataTypeUInt atIndex:kProgrammableBlendModeIndex];
+        NSString* blendFunc = [NSString stringWithFormat:@"%sBlend", fragmentFunc];
+
         id<MTLFunction> vertFunc = [library newFunctionWithName:@(vertexFunc)];
-        id<MTLFunction> fragFunc = [library newFunctionWithName:@(fragmentFunc)];
+        id<MTLFunction> fragFunc = [library newFunctionWithName:blendFunc constantValues:constants error:&error];
 
         if (!vertFunc || !fragFunc) {
-            NSLog(@"MetalRenderer: Failed to find programmable blend functions: %s / %s", vertexFunc, fragmentFunc);
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to find programmable blend functions: %s / %@", vertexFunc, blendFunc);
             return nil;
         }
 
         MTLRenderPipelineDescriptor* pipelineDesc = [[MTLRenderPipelineDescriptor alloc] init];
-        pipelineDesc.label = [NSString stringWithFormat:@"ProgrammableBlend_%s", fragmentFunc];
+        pipelineDesc.label = [NSString stringWithFormat:@"ProgrammableBlend_%@%u_%s_Fmt%u_%u_x%u", blendFunc, mode,
+                              vertexFunc, variant.colorFormat, variant.depthFormat, variant.sampleCount];
         pipelineDesc.vertexFunction = vertFunc;
         pipelineDesc.fragmentFunction = fragFunc;
-        pipelineDesc.colorAttachments[0].pixelFormat = MTLPixelFormatBGRA8Unorm;
-        pipelineDesc.depthAttachmentPixelFormat = MTLPixelFormatDepth32Float;
+        applyAttachmentFormats(pipelineDesc, variant);
 
         // Programmable blending: disable hardware blending (shader handles it)
         pipelineDesc.colorAttachments[0].blendingEnabled = NO;
 
-        id<MTLRenderPipelineState> pipeline = [device newRenderPipelineStateWithDescriptor:pipelineDesc error:&error];
+        id<MTLRenderPipelineState> pipeline = newPipelineState(pipelineDesc, &error);
+        if (!pipeline) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create programmable blend pipeline %@: %@",
+                  blendFunc, error.localizedDescription);
+            return nil;
+        }
+
+        return pipeline;
+    }
+}
+
+id<MTLRenderPipelineState> MetalRenderer::Impl::createMeshPipelineVariant(id<MTLLibrary> library,
+                                                                            const char* fragmentFunc,
+                                                                            const PipelineVariant& variant) {
+    // Blend modes 7-10 use the hardware approximation (no *Blend variants
+    // for mesh primitives); pipelines aren't archived
+    if (!meshShadersSupported) {
+        return nil;
+    }
+
+    @autoreleasepool {
+        NSError* error = nil;
+
+        id<MTLFunction> objectFunc = [library newFunctionWithName:@"objectMeshPrimitive"];
+        id<MTLFunction> meshFunc = [library newFunctionWithName:@"meshPrimitive"];
+        id<MTLFunction> fragFunc = fragmentFunc ? [library newFunctionWithName:@(fragmentFunc)] : nil;
+        if (!objectFunc || !meshFunc || (fragmentFunc && !fragFunc)) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to find mesh primitive functions: %s",
+                  fragmentFunc ? fragmentFunc : "(none)");
+            return nil;
+        }
+
+        MTLMeshRenderPipelineDescriptor* pipelineDesc = [[MTLMeshRenderPipelineDescriptor alloc] init];
+        pipelineDesc.label = [NSString stringWithFormat:@"MeshPrimitive_%s_Blend%d_Fmt%u_%u_x%u",
+                              fragmentFunc ? fragmentFunc : "depth", (int)variant.blendMode, variant.colorFormat,
+                              variant.depthFormat, variant.sampleCount];
+        pipelineDesc.objectFunction = objectFunc;
+        pipelineDesc.meshFunction = meshFunc;
+        pipelineDesc.fragmentFunction = fragFunc;
+        pipelineDesc.payloadMemoryLength = sizeof(uint32_t) * (1 + kMeshletsPerObject);  // MeshPrimitivePayload
+        pipelineDesc.maxTotalThreadsPerObjectThreadgroup = kMeshletsPerObject;
+        pipelineDesc.maxTotalThreadsPerMeshThreadgroup = kMeshletThreads;
+        pipelineDesc.maxTotalThreadgroupsPerMeshGrid = kMeshletsPerObject;
+        applyAttachmentFormats(pipelineDesc, variant);
+        applyBlendConfig(pipelineDesc, variant);
+
+        id<MTLRenderPipelineState> pipeline = [device newRenderPipelineStateWithMeshDescriptor:pipelineDesc
+                                                                                       options:MTLPipelineOptionNone
+                                                                                    reflection:nil
+                                                                                         error:&error];
+        if (!pipeline) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create mesh primitive pipeline (blend %d): %@",
+                  (int)variant.blendMode, error.localizedDescription);
+            return nil;
+        }
+
+        return pipeline;
+    }
+}
+
+id<MTLRenderPipelineState> MetalRenderer::Impl::createTransparencyPipeline(id<MTLLibrary> library,
+                                                                             const char* vertexFunc,
+                                                                             const char* fragmentFunc,
+                                                                             const PipelineVariant& variant) {
+    @autoreleasepool {
+        NSError* error = nil;
+
+        id<MTLFunction> vertFunc = [library newFunctionWithName:@(vertexFunc)];
+        id<MTLFunction> fragFunc = [library newFunctionWithName:@(fragmentFunc)];
+        if (!vertFunc || !fragFunc) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to find transparency functions: %s / %s", vertexFunc, fragmentFunc);
+            return nil;
+        }
+
+        MTLRenderPipelineDescriptor* pipelineDesc = [[MTLRenderPipelineDescriptor alloc] init];
+        pipelineDesc.label = [NSString stringWithFormat:@"Transparency_%s_%s_Fmt%u_x%u", vertexFunc, fragmentFunc,
+                              variant.depthFormat, variant.sampleCount];
+        pipelineDesc.vertexFunction = vertFunc;
+        pipelineDesc.fragmentFunction = fragFunc;
+        PipelineVariant formats = variant;
+        formats.colorFormat = (uint32_t)MTLPixelFormatRGBA16Float;
+        applyAttachmentFormats(pipelineDesc, formats);
+
+        // Accumulation: sum of weighted premultiplied color and alpha
+        MTLRenderPipelineColorAttachmentDescriptor* accumulation = pipelineDesc.colorAttachments[0];
+        accumulation.blendingEnabled = YES;
+        accumulation.rgbBlendOperation = MTLBlendOperationAdd;
+        accumulation.alphaBlendOperation = MTLBlendOperationAdd;
+        accumulation.sourceRGBBlendFactor = MTLBlendFactorOne;
+        accumulation.destinationRGBBlendFactor = MTLBlendFactorOne;
+        accumulation.sourceAlphaBlendFactor = MTLBlendFactorOne;
+        accumulation.destinationAlphaBlendFactor = MTLBlendFactorOne;
+
+        // Revealage: dst * (1 - alpha) for every layer
+        MTLRenderPipelineColorAttachmentDescriptor* revealage = pipelineDesc.colorAttachments[1];
+        revealage.pixelFormat = MTLPixelFormatR16Float;
+        revealage.blendingEnabled = YES;
+        revealage.rgbBlendOperation = MTLBlendOperationAdd;
+        revealage.alphaBlendOperation = MTLBlendOperationAdd;
+        revealage.sourceRGBBlendFactor = MTLBlendFactorZero;
+        revealage.destinationRGBBlendFactor = MTLBlendFactorOneMinusSourceColor;
+        revealage.sourceAlphaBlendFactor = MTLBlendFactorZero;
+        revealage.destinationAlphaBlendFactor = MTLBlendFactorOneMinusSourceAlpha;
+
+        id<MTLRenderPipelineState> pipeline = newPipelineState(pipelineDesc, &error);
         if (!pipeline) {
-            NSLog(@"MetalRenderer: Failed to create programmable blend pipeline %s: %@",
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create transparency pipeline %s: %@",
                   fragmentFunc, error.localizedDescription);
             return nil;
         }
+        return pipeline;
+    }
+}
+
+void MetalRenderer::Impl::openPipelineArchive() {
+    @autoreleasepool {
+        pipelineArchiveFile = pipelineArchiveURL(device);
+        if (!pipelineArchiveFile) {
+            return;
+        }
+
+        // Load the previous launch's archive; a stale or corrupt file (driver
+        // update, other GPU) is replaced by an empty archive
+        MTLBinaryArchiveDescriptor* desc = [[MTLBinaryArchiveDescriptor alloc] init];
+        NSError* error = nil;
+        if ([[NSFileManager defaultManager] fileExistsAtPath:pipelineArchiveFile.path]) {
+            desc.url = pipelineArchiveFile;
+            pipelineArchive = [device newBinaryArchiveWithDescriptor:desc error:&error];
+            if (!pipelineArchive) {
+                METAL_LOG_ERROR(@"MetalRenderer: Discarding pipeline archive: %@", error.localizedDescription);
+                desc.url = nil;
+            }
+        }
+        if (!pipelineArchive) {
+            pipelineArchive = [device newBinaryArchiveWithDescriptor:desc error:&error];
+            if (!pipelineArchive) {
+                METAL_LOG_ERROR(@"MetalRenderer: Pipeline archive unavailable: %@", error.localizedDescription);
+                pipelineArchiveFile = nil;
+                return;
+            }
+        }
+        pipelineArchiveDirty = false;
+    }
+}
+
+void MetalRenderer::Impl::savePipelineArchive() {
+    std::lock_guard<std::mutex> lock(pipelineArchiveMutex);
+    if (!pipelineArchive || !pipelineArchiveFile || !pipelineArchiveDirty) {
+        return;
+    }
+
+    @autoreleasepool {
+        NSError* error = nil;
+        NSURL* directory = [pipelineArchiveFile URLByDeletingLastPathComponent];
+        [[NSFileManager defaultManager] createDirectoryAtURL:directory
+                                 withIntermediateDirectories:YES
+                                                  attributes:nil
+                                                       error:nil];
+        if ([pipelineArchive serializeToURL:pipelineArchiveFile error:&error]) {
+            pipelineArchiveDirty = false;
+            if (isMetalDebugEnabled()) {
+                METAL_LOG_NOTICE(@"MetalRenderer: Saved pipeline archive to %@", pipelineArchiveFile.path);
+            }
+        } else {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to save pipeline archive: %@", error.localizedDescription);
+        }
+    }
+}
+
+id<MTLRenderPipelineState> MetalRenderer::Impl::newPipelineState(MTLRenderPipelineDescriptor* descriptor,
+                                                                  NSError** error,
+                                                                  MTLAutoreleasedRenderPipelineReflection* reflection) {
+    const MTLPipelineOption reflect = reflection ? MTLPipelineOptionBindingInfo : MTLPipelineOptionNone;
+    if (!pipelineArchive) {
+        return [device newRenderPipelineStateWithDescriptor:descriptor options:reflect
+                                                 reflection:reflection error:error];
+    }
 
+    // Archive hit: no backend compile
+    descriptor.binaryArchives = @[pipelineArchive];
+    id<MTLRenderPipelineState> pipeline =
+        [device newRenderPipelineStateWithDescriptor:descriptor
+                                             options:MTLPipelineOptionFailOnBinaryArchiveMiss | reflect
+                                          reflection:reflection
+                                               error:nil];
+    if (pipeline) {
         return pipeline;
     }
+
+    // Miss: compile into the archive, then create from it
+    {
+        std::lock_guard<std::mutex> lock(pipelineArchiveMutex);
+        NSError* addError = nil;
+        if ([pipelineArchive addRenderPipelineFunctionsWithDescriptor:descriptor error:&addError]) {
+            pipelineArchiveDirty = true;
+        } else if (isMetalDebugEnabled()) {
+            METAL_LOG_ERROR(@"MetalRenderer: Pipeline not archived: %@", addError.localizedDescription);
+        }
+    }
+    return [device newRenderPipelineStateWithDescriptor:descriptor options:reflect
+                                             reflection:reflection error:error];
+}
+
+uint64_t MetalRenderer::Impl::pipelineKey(const PipelineVariant& variant) {
+    // Shaders fit in 8 bits, blend modes in 4, pixel formats in 16, sample counts in 8
+    return ((uint64_t)variant.shader & 0xFFu) |
+           ((uint64_t)variant.blendMode << 8) |
+           ((uint64_t)(variant.colorFormat & 0xFFFFu) << 12) |
+           ((uint64_t)(variant.depthFormat & 0xFFFFu) << 28) |
+           ((uint64_t)(variant.sampleCount & 0xFFu) << 44) |
+           ((uint64_t)variant.vertexFormat << 52);
+}
+
+PipelineVariant MetalRenderer::Impl::resolveVariant(const PipelineVariant& variant) const {
+    PipelineVariant resolved = variant;
+    if (resolved.shader == PipelineShader::ShadowDepth || resolved.shader == PipelineShader::ShadowDepthInstanced ||
+        resolved.shader == PipelineShader::ShadowDepthMeshPrimitive) {
+        // Depth-only: no color attachment to resolve
+        resolved.colorFormat = (uint32_t)MTLPixelFormatInvalid;
+        resolved.blendMode = BlendMode::Alpha;
+        resolved.sampleCount = 1;
+        if (resolved.depthFormat == 0) {
+            resolved.depthFormat = (uint32_t)MTLPixelFormatDepth32Float;
+        }
+        return resolved;
+    }
+    if (resolved.colorFormat == 0) {
+        resolved.colorFormat = view ? (uint32_t)view.colorPixelFormat : (uint32_t)MTLPixelFormatBGRA8Unorm;
+    }
+    if (resolved.depthFormat == 0) {
+        resolved.depthFormat = view ? (uint32_t)view.depthStencilPixelFormat : (uint32_t)MTLPixelFormatDepth32Float;
+    }
+    if (resolved.sampleCount == 0) {
+        resolved.sampleCount = 1;
+    }
+    if ((uint32_t)resolved.blendMode > 10) {
+        resolved.blendMode = BlendMode::Alpha;
+    }
+    if (resolved.shader == PipelineShader::Shapes2D || resolved.shader == PipelineShader::Stroke2D ||
+        resolved.shader == PipelineShader::Path2D || resolved.shader == PipelineShader::TransparencyComposite ||
+        resolved.shader == PipelineShader::PointCloud || resolved.shader == PipelineShader::MeshPrimitive3D ||
+        resolved.shader == PipelineShader::LitMeshPrimitive3D ||
+        resolved.shader == PipelineShader::ObjectIdMeshPrimitive3D) {
+        resolved.vertexFormat = VertexFormat::Float;  // Own record types (or none)
+    }
+    if (resolved.shader >= PipelineShader::Transparent3D &&
+        resolved.shader <= PipelineShader::LitTransparentInstanced3D) {
+        // Accumulation targets; blending is fixed by the technique
+        resolved.colorFormat = (uint32_t)MTLPixelFormatRGBA16Float;
+        resolved.blendMode = BlendMode::Alpha;
+    }
+    if (resolved.shader == PipelineShader::TransparencyComposite) {
+        resolved.blendMode = BlendMode::Alpha;
+    }
+    if (resolved.shader == PipelineShader::ObjectId3D || resolved.shader == PipelineShader::ObjectIdInstanced3D ||
+        resolved.shader == PipelineShader::ObjectIdMeshPrimitive3D) {
+        // The ID target and its depth; integer formats don't blend
+        resolved.colorFormat = (uint32_t)MTLPixelFormatR32Uint;
+        resolved.depthFormat = (uint32_t)MTLPixelFormatDepth32Float;
+        resolved.sampleCount = 1;
+        resolved.blendMode = BlendMode::Disabled;
+    }
+    return resolved;
+}
+
+id<MTLRenderPipelineState> MetalRenderer::Impl::createPipeline(const PipelineVariant& variant) {
+    // Modes 7-10 blend in the fragment shader where supported, for every
+    // shader (see createPipelineVariant())
+    id<MTLLibrary> library = shaderLibrary;
+    if (!library) {
+        return nil;
+    }
+
+    const int mode = (int)variant.blendMode;
+    PipelineVariant fallback = variant;
+    id<MTLRenderPipelineState> pipeline = nil;
+
+    // Packed variants run the *Packed entry point of the same shader
+    const bool packed = variant.vertexFormat == VertexFormat::Packed;
+    auto vertexFunction = [packed](const char* name) {
+        return packed ? std::string(name) + "Packed" : std::string(name);
+    };
+
+    switch (variant.shader) {
+        case PipelineShader::Solid2D:
+        case PipelineShader::Textured2D: {
+            const bool textured = variant.shader == PipelineShader::Textured2D;
+            const char* fragmentFunc = textured ? "fragment2DTextured" : "fragment2D";
+            return createPipelineVariant(library, vertexFunction("vertex2D").c_str(), fragmentFunc, variant);
+        }
+
+        case PipelineShader::TextureBatch2D:
+            return createPipelineVariant(library, vertexFunction("vertex2DTextureBatch").c_str(),
+                                         "fragment2DTextureBatch", variant);
+
+        case PipelineShader::DistanceField2D:
+            pipeline = createPipelineVariant(library, vertexFunction("vertex2D").c_str(),
+                                             "fragment2DDistanceField", variant);
+            if (!pipeline) {
+                METAL_LOG_ERROR(@"MetalRenderer: Distance field pipeline not available for blend mode %d", mode);
+            }
+            return pipeline;
+
+        case PipelineShader::Shapes2D:
+            pipeline = createPipelineVariant(library, "vertex2DShape", "fragment2DShape", variant);
+            if (!pipeline) {
+                METAL_LOG_ERROR(@"MetalRenderer: SDF shape pipeline not available for blend mode %d", mode);
+            }
+            return pipeline;
+
+        case PipelineShader::Stroke2D:
+            // Solid fill of the expanded geometry
+            pipeline = createPipelineVariant(library, "vertex2DStroke", "fragment2D", variant);
+            if (!pipeline) {
+                METAL_LOG_ERROR(@"MetalRenderer: Stroke pipeline not available for blend mode %d", mode);
+            }
+            return pipeline;
+
+        case PipelineShader::Path2D:
+            // Coverage from the path's edges
+            pipeline = createPipelineVariant(library, "vertex2DPath", "fragment2DPath", variant);
+            if (!pipeline) {
+                METAL_LOG_ERROR(@"MetalRenderer: Path fill pipeline not available for blend mode %d", mode);
+            }
+            return pipeline;
+
+        case PipelineShader::Basic3D:
+            return createPipelineVariant(library, vertexFunction("vertex3D").c_str(), "fragment3D", variant);
+
+        case PipelineShader::Lit3D:
+            pipeline = createPipelineVariant(library, vertexFunction("vertexLighting").c_str(),
+                                             "fragmentPhongLighting", variant);
+            if (!pipeline) {
+                // Lighting shaders may not be available in fallback mode - use basic 3D pipeline
+                METAL_LOG_ERROR(@"MetalRenderer: Lighting pipeline not available for blend mode %d, using basic 3D", mode);
+                fallback.shader = PipelineShader::Basic3D;
+                pipeline = getPipeline(fallback);
+            }
+            return pipeline;
+
+        case PipelineShader::Instanced3D:
+            pipeline = createPipelineVariant(library, vertexFunction("vertex3DInstanced").c_str(),
+                                             "fragment3D", variant);
+            if (!pipeline) {
+                METAL_LOG_ERROR(@"MetalRenderer: Instanced 3D pipeline not available for blend mode %d", mode);
+            }
+            return pipeline;
+
+        case PipelineShader::LitInstanced3D:
+            // Lit falls back to unlit instancing
+            pipeline = createPipelineVariant(library, vertexFunction("vertexLightingInstanced").c_str(),
+                                             "fragmentPhongLighting", variant);
+            if (!pipeline) {
+                fallback.shader = PipelineShader::Instanced3D;
+                pipeline = getPipeline(fallback);
+            }
+            return pipeline;
+
+        case PipelineShader::ShadowDepth:
+            // Unlit vertex stage, no fragment stage: only depth is written
+            return createPipelineVariant(library, vertexFunction("vertex3D").c_str(), nullptr, variant);
+
+        case PipelineShader::ShadowDepthInstanced:
+            return createPipelineVariant(library, vertexFunction("vertex3DInstanced").c_str(), nullptr, variant);
+
+        case PipelineShader::Transparent3D:
+            return createTransparencyPipeline(library, vertexFunction("vertex3D").c_str(), "fragment3DTransparent",
+                                              variant);
+
+        case PipelineShader::LitTransparent3D:
+            return createTransparencyPipeline(library, vertexFunction("vertexLighting").c_str(),
+                                              "fragmentPhongLightingTransparent", variant);
+
+        case PipelineShader::TransparentInstanced3D:
+            return createTransparencyPipeline(library, vertexFunction("vertex3DInstanced").c_str(),
+                                              "fragment3DTransparent", variant);
+
+        case PipelineShader::LitTransparentInstanced3D:
+            return createTransparencyPipeline(library, vertexFunction("vertexLightingInstanced").c_str(),
+                                              "fragmentPhongLightingTransparent", variant);
+
+        case PipelineShader::TransparencyComposite:
+            // Blended over the pass with the variant's blend mode (Alpha)
+            return createPipelineVariant(library, "vertexTransparencyComposite", "fragmentTransparencyComposite",
+                                         variant);
+
+        case PipelineShader::Retained3D:
+            return createPipelineVariant(library, vertexFunction("vertex3DRetained").c_str(), "fragment3D", variant);
+
+        case PipelineShader::RetainedInstanced3D:
+            return createPipelineVariant(library, vertexFunction("vertex3DInstancedRetained").c_str(), "fragment3D",
+                                         variant);
+
+        case PipelineShader::PointCloud:
+            pipeline = createPipelineVariant(library, "vertexPointCloud", "fragmentPointCloud", variant);
+            if (!pipeline) {
+                METAL_LOG_ERROR(@"MetalRenderer: Point cloud pipeline not available for blend mode %d", mode);
+            }
+            return pipeline;
+
+        case PipelineShader::ObjectId3D:
+            return createPipelineVariant(library, vertexFunction("vertex3D").c_str(), "fragmentObjectId", variant);
+
+        case PipelineShader::ObjectIdInstanced3D:
+            return createPipelineVariant(library, vertexFunction("vertex3DInstanced").c_str(), "fragmentObjectId",
+                                         variant);
+
+        case PipelineShader::MeshPrimitive3D:
+            return createMeshPipelineVariant(library, "fragment3D", variant);
+
+        case PipelineShader::LitMeshPrimitive3D:
+            return createMeshPipelineVariant(library, "fragmentPhongLighting", variant);
+
+        case PipelineShader::ShadowDepthMeshPrimitive:
+            return createMeshPipelineVariant(library, nullptr, variant);
+
+        case PipelineShader::ObjectIdMeshPrimitive3D:
+            return createMeshPipelineVariant(library, "fragmentObjectId", variant);
+    }
+    return nil;
+}
+
+id<MTLRenderPipelineState> MetalRenderer::Impl::getPipeline(const PipelineVariant& variant) {
+    // Variant must be resolved (explicit formats); see resolveVariant()
+    const uint64_t key = pipelineKey(variant);
+    {
+        std::shared_lock<std::shared_mutex> lock(pipelineMutex);
+        auto it = pipelines.find(key);
+        if (it != pipelines.end()) {
+            return it->second;
+        }
+    }
+
+    // Compile outside the lock; a racing thread's result wins the insert
+    id<MTLRenderPipelineState> pipeline = createPipeline(variant);
+
+    std::unique_lock<std::shared_mutex> lock(pipelineMutex);
+    return pipelines.emplace(key, pipeline).first->second;
+}
+
+id<MTLRenderPipelineState> MetalRenderer::Impl::getPassPipeline(PipelineShader shader, BlendMode blendMode,
+                                                                 VertexFormat vertexFormat) {
+    PipelineVariant variant;
+    variant.shader = shader;
+    variant.vertexFormat = vertexFormat;
+    variant.blendMode = (uint32_t)blendMode > 10 ? BlendMode::Alpha : blendMode;
+    variant.colorFormat = (uint32_t)passColorFormat;
+    variant.depthFormat = (uint32_t)passDepthFormat;
+    variant.sampleCount = (uint32_t)passSampleCount;
+    return getPipeline(variant);
+}
+
+size_t MetalRenderer::Impl::prewarm(const PipelineVariant* variants, size_t count) {
+    if (!variants || count == 0) {
+        return 0;
+    }
+
+    // Variants are independent, so they compile in parallel
+    std::atomic<size_t> available{0};
+    std::atomic<size_t>* availableCount = &available;
+    dispatch_apply(count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        if (getPipeline(resolveVariant(variants[i]))) {
+            availableCount->fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    // Persist newly compiled variants off the calling thread
+    dispatch_group_async(pipelineArchiveSaves, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        savePipelineArchive();
+    });
+    return available.load();
 }
 
 bool MetalRenderer::Impl::createPipelines() {
@@ -385,13 +1636,13 @@ bool MetalRenderer::Impl::createPipelines() {
         if (!library) {
             library = [device newDefaultLibrary];
             if (isMetalDebugEnabled()) {
-                NSLog(@"MetalRenderer: newDefaultLibrary %s", library ? "succeeded" : "returned nil");
+                METAL_LOG_ERROR(@"MetalRenderer: newDefaultLibrary %s", library ? "succeeded" : "returned nil");
             }
         }
 
         // If default library not found, compile shaders from source
         if (!library) {
-            NSLog(@"MetalRenderer: Default library not found, compiling shaders from source...");
+            METAL_LOG_NOTICE(@"MetalRenderer: Default library not found, compiling shaders from source...");
 
             // Embedded shader source (Common.h + Basic2D.metal combined)
             NSString* shaderSource = @R"(
@@ -412,6 +1663,37 @@ struct Vertex3D {
     float4 color    [[attribute(3)]];
 };
 
+struct PackedVertex2D {
+    float2 position;
+    uint texCoord;
+    uint color;
+};
+
+struct PackedVertex3D {
+    packed_float3 position;
+    uint normalXY;
+    uint normalZ;
+    uint texCoord;
+    uint color;
+};
+
+inline Vertex2D unpackVertex(PackedVertex2D in) {
+    Vertex2D out;
+    out.position = in.position;
+    out.texCoord = unpack_unorm2x16_to_float(in.texCoord);
+    out.color = unpack_unorm4x8_to_float(in.color);
+    return out;
+}
+
+inline Vertex3D unpackVertex(PackedVertex3D in) {
+    Vertex3D out;
+    out.position = float3(in.position);
+    out.normal = float3(unpack_snorm2x16_to_float(in.normalXY), unpack_snorm2x16_to_float(in.normalZ).x);
+    out.texCoord = unpack_unorm2x16_to_float(in.texCoord);
+    out.color = unpack_unorm4x8_to_float(in.color);
+    return out;
+}
+
 // Uniform Buffers
 struct Uniforms2D {
     float4x4 projectionMatrix;
@@ -424,6 +1706,12 @@ struct Uniforms3D {
     float4x4 normalMatrix;
 };
 
+struct InstanceData {
+    float4x4 modelMatrix;
+    float4 color;
+    float4 userData;
+};
+
 // Rasterizer Data
 struct RasterizerData2D {
     float4 position [[position]];
@@ -439,14 +1727,9 @@ struct RasterizerData3D {
     float3 worldPosition;
 };
 
-// 2D Vertex Shader
-vertex RasterizerData2D vertex2D(
-    uint vertexID [[vertex_id]],
-    constant Vertex2D* vertices [[buffer(0)]],
-    constant Uniforms2D& uniforms [[buffer(1)]]
-) {
+// 2D Vertex Shaders
+static RasterizerData2D transformVertex2D(Vertex2D in, constant Uniforms2D& uniforms) {
     RasterizerData2D out;
-    Vertex2D in = vertices[vertexID];
     float4 position = float4(in.position, 0.0, 1.0);
     out.position = uniforms.projectionMatrix * uniforms.modelViewMatrix * position;
     out.texCoord = in.texCoord;
@@ -454,6 +1737,22 @@ vertex RasterizerData2D vertex2D(
     return out;
 }
 
+vertex RasterizerData2D vertex2D(
+    uint vertexID [[vertex_id]],
+    constant Vertex2D* vertices [[buffer(0)]],
+    constant Uniforms2D& uniforms [[buffer(1)]]
+) {
+    return transformVertex2D(vertices[vertexID], uniforms);
+}
+
+vertex RasterizerData2D vertex2DPacked(
+    uint vertexID [[vertex_id]],
+    constant PackedVertex2D* vertices [[buffer(0)]],
+    constant Uniforms2D& uniforms [[buffer(1)]]
+) {
+    return transformVertex2D(unpackVertex(vertices[vertexID]), uniforms);
+}
+
 // 2D Fragment Shader (solid color)
 fragment float4 fragment2D(RasterizerData2D in [[stage_in]]) {
     return in.color;
@@ -469,14 +1768,9 @@ fragment float4 fragment2DTextured(
     return texColor * in.color;
 }
 
-// 3D Vertex Shader
-vertex RasterizerData3D vertex3D(
-    uint vertexID [[vertex_id]],
-    constant Vertex3D* vertices [[buffer(0)]],
-    constant Uniforms3D& uniforms [[buffer(1)]]
-) {
+// 3D Vertex Shaders
+static RasterizerData3D transformVertex3D(Vertex3D in, constant Uniforms3D& uniforms) {
     RasterizerData3D out;
-    Vertex3D in = vertices[vertexID];
     float4 position = float4(in.position, 1.0);
     out.position = uniforms.projectionMatrix * uniforms.modelViewMatrix * position;
     out.worldPosition = in.position;
@@ -486,146 +1780,238 @@ vertex RasterizerData3D vertex3D(
     return out;
 }
 
-// 3D Fragment Shader (solid color)
-fragment float4 fragment3D(RasterizerData3D in [[stage_in]]) {
-    return in.color;
-}
-)";
-
-            MTLCompileOptions* options = [[MTLCompileOptions alloc] init];
+vertex RasterizerData3D vertex3D(
+    uint vertexID [[vertex_id]],
+    constant Vertex3D* vertices [[buffer(0)]],
+    constant Uniforms3D& uniforms [[buffer(1)]]
+) {
+    return transformVertex3D(vertices[vertexID], uniforms);
+}
+
+vertex RasterizerData3D vertex3DPacked(
+    uint vertexID [[vertex_id]],
+    constant PackedVertex3D* vertices [[buffer(0)]],
+    constant Uniforms3D& uniforms [[buffer(1)]]
+) {
+    return transformVertex3D(unpackVertex(vertices[vertexID]), uniforms);
+}
+
+// 3D Instanced Vertex Shaders
+static RasterizerData3D transformVertex3DInstanced(Vertex3D in, InstanceData instance,
+                                                   constant Uniforms3D& uniforms) {
+    RasterizerData3D out;
+    float4 viewPosition = uniforms.modelViewMatrix * (instance.modelMatrix * float4(in.position, 1.0));
+    out.position = uniforms.projectionMatrix * viewPosition;
+    out.worldPosition = viewPosition.xyz;
+    out.normal = (uniforms.normalMatrix * (instance.modelMatrix * float4(in.normal, 0.0))).xyz;
+    out.texCoord = in.texCoord;
+    out.color = in.color * instance.color;
+    return out;
+}
+
+vertex RasterizerData3D vertex3DInstanced(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    constant Vertex3D* vertices [[buffer(0)]],
+    constant Uniforms3D& uniforms [[buffer(1)]],
+    constant InstanceData* instances [[buffer(2)]]
+) {
+    return transformVertex3DInstanced(vertices[vertexID], instances[instanceID], uniforms);
+}
+
+vertex RasterizerData3D vertex3DInstancedPacked(
+    uint vertexID [[vertex_id]],
+    uint instanceID [[instance_id]],
+    constant PackedVertex3D* vertices [[buffer(0)]],
+    constant Uniforms3D& uniforms [[buffer(1)]],
+    constant InstanceData* instances [[buffer(2)]]
+) {
+    return transformVertex3DInstanced(unpackVertex(vertices[vertexID]), instances[instanceID], uniforms);
+}
+
+// 3D Fragment Shader (solid color)
+fragment float4 fragment3D(RasterizerData3D in [[stage_in]]) {
+    return in.color;
+}
+)";
+
+            MTLCompileOptions* options = [[MTLCompileOptions alloc] init];
             options.languageVersion = MTLLanguageVersion2_4;
 
             library = [device newLibraryWithSource:shaderSource options:options error:&error];
             if (!library) {
-                NSLog(@"MetalRenderer: Failed to compile shaders: %@", error.localizedDescription);
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to compile shaders: %@", error.localizedDescription);
                 return false;
             }
-            NSLog(@"MetalRenderer: Shaders compiled successfully from source");
+            METAL_LOG_NOTICE(@"MetalRenderer: Shaders compiled successfully from source");
         }
 
-        // Create pipeline variants for all blend modes
-        // Modes 0-6: Standard hardware blending
-        // Modes 7-10: Programmable blending (shader-based) for accurate results
+        // Default variants (alpha blend, screen formats) are required; modes
+        // 7-10 use programmable blending when their variants are created
 
-        NSLog(@"MetalRenderer: Creating pipeline variants...");
+        METAL_LOG_NOTICE(@"MetalRenderer: Creating default pipeline variants...");
+        openPipelineArchive();
 
-        // Programmable blend shader function names
-        const char* progBlendFragFuncs[] = {
-            "fragment_blend_overlay",      // 7: Overlay
-            "fragment_blend_soft_light",   // 8: SoftLight
-            "fragment_blend_hard_light",   // 9: HardLight
-            "fragment_blend_difference"    // 10: Difference
-        };
-        const char* progBlendFragFuncsTextured[] = {
-            "fragment_blend_overlay_textured",
-            "fragment_blend_soft_light_textured",
-            "fragment_blend_hard_light_textured",
-            "fragment_blend_difference_textured"
-        };
+        shaderLibrary = library;
 
-        // Create 2D pipeline variants for all blend modes (0-10)
-        for (int i = 0; i <= 10; i++) {
-            BlendMode mode = (BlendMode)i;
-            if (i >= 7 && i <= 10) {
-                // Programmable blending for advanced blend modes
-                pipeline2D[i] = createProgrammableBlendPipeline(library, "vertex_blend", progBlendFragFuncs[i - 7]);
-                if (!pipeline2D[i]) {
-                    // Fallback to hardware approximation
-                    NSLog(@"MetalRenderer: Programmable blend not available for mode %d, using hardware fallback", i);
-                    pipeline2D[i] = createPipelineVariant(library, "vertex2D", "fragment2D", mode);
-                }
-            } else {
-                pipeline2D[i] = createPipelineVariant(library, "vertex2D", "fragment2D", mode);
-            }
-            if (!pipeline2D[i]) {
-                NSLog(@"MetalRenderer: Failed to create 2D pipeline variant for blend mode %d", i);
-                return false;
-            }
+        // Everything else is created on first use or through prewarm()
+        PipelineVariant defaults[3];
+        defaults[0].shader = PipelineShader::Solid2D;
+        defaults[1].shader = PipelineShader::Textured2D;
+        defaults[2].shader = PipelineShader::Basic3D;
+        if (prewarm(defaults, 3) != 3) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create default pipeline variants");
+            return false;
         }
 
-        // Create 2D textured pipeline variants for all blend modes (0-10)
-        for (int i = 0; i <= 10; i++) {
-            BlendMode mode = (BlendMode)i;
-            if (i >= 7 && i <= 10) {
-                // Programmable blending for advanced blend modes
-                pipeline2DTextured[i] = createProgrammableBlendPipeline(library, "vertex_blend", progBlendFragFuncsTextured[i - 7]);
-                if (!pipeline2DTextured[i]) {
-                    // Fallback to hardware approximation
-                    NSLog(@"MetalRenderer: Programmable blend (textured) not available for mode %d, using hardware fallback", i);
-                    pipeline2DTextured[i] = createPipelineVariant(library, "vertex2D", "fragment2DTextured", mode);
-                }
-            } else {
-                pipeline2DTextured[i] = createPipelineVariant(library, "vertex2D", "fragment2DTextured", mode);
-            }
-            if (!pipeline2DTextured[i]) {
-                NSLog(@"MetalRenderer: Failed to create 2D textured pipeline variant for blend mode %d", i);
-                return false;
-            }
-        }
+        METAL_LOG_NOTICE(@"MetalRenderer: Default pipeline variants created successfully");
+        return true;
+    }
+}
 
-        // Create 3D pipeline variants for all blend modes (0-10)
-        // Note: 3D uses hardware blending for now (programmable blend for 3D would need separate shaders)
-        for (int i = 0; i <= 10; i++) {
-            BlendMode mode = (BlendMode)i;
-            pipeline3D[i] = createPipelineVariant(library, "vertex3D", "fragment3D", mode);
-            if (!pipeline3D[i]) {
-                NSLog(@"MetalRenderer: Failed to create 3D pipeline variant for blend mode %d", i);
-                return false;
-            }
-        }
+bool MetalRenderer::Impl::createBuffers() {
+    @autoreleasepool {
+        // Geometry ring; chunks are allocated lazily on first use
+        geometryRing = std::make_unique<MetalRingAllocator>(
+            (__bridge void*)device, kInitialGeometryChunkSize, kMaxFramesInFlight);
 
-        // Create 3D lit pipeline variants (with Phong lighting)
-        // These use vertexLighting/fragmentPhongLighting from Lighting.metal
-        for (int i = 0; i <= 10; i++) {
-            BlendMode mode = (BlendMode)i;
-            pipeline3DLit[i] = createPipelineVariant(library, "vertexLighting", "fragmentPhongLighting", mode);
-            if (!pipeline3DLit[i]) {
-                // Lighting shaders may not be available in fallback mode - use basic 3D pipeline
-                NSLog(@"MetalRenderer: Lighting pipeline not available for blend mode %d, using basic 3D", i);
-                pipeline3DLit[i] = pipeline3D[i];
-            }
+        METAL_LOG_NOTICE(@"MetalRenderer: Buffers created successfully");
+        return true;
+    }
+}
+
+bool MetalRenderer::Impl::uploadGeometry(const DrawList& drawList) {
+    // Copy one stream into the ring unless the list already wrote it in place
+    // (bindFrameStorage); a spilled mapping is simply replaced
+    auto upload = [this](RingAllocation& target, const void* data, size_t dataSize) {
+        if (dataSize == 0) {
+            return true;
+        }
+        if (target && data == target.contents && dataSize <= target.size) {
+            return true;
+        }
+        target = geometryRing->allocate(dataSize, kGeometryAlignment);
+        if (!target) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to allocate %zu bytes of geometry", dataSize);
+            return false;
         }
+        std::memcpy(target.contents, data, dataSize);
+        return true;
+    };
+
+    peakVertices2D = std::max(peakVertices2D, drawList.getVertex2DCount());
+    peakVertices3D = std::max(peakVertices3D, drawList.getVertex3DCount());
+    peakIndices = std::max(peakIndices, drawList.getIndexCount());
+
+    // A list without packed vertices, instances, shapes, strokes or paths
+    // must not see the previous list's streams
+    framePacked2D = RingAllocation();
+    framePacked3D = RingAllocation();
+    frameInstances = RingAllocation();
+    frameShapes = RingAllocation();
+    frameStrokes = RingAllocation();
+    framePaths = RingAllocation();
+    framePathSegments = RingAllocation();
+    frameUniforms = RingAllocation();
+
+    return upload(frameVertices2D, drawList.getVertex2DData(), drawList.getVertex2DDataSize()) &&
+           upload(frameVertices3D, drawList.getVertex3DData(), drawList.getVertex3DDataSize()) &&
+           upload(framePacked2D, drawList.getPackedVertex2DData(), drawList.getPackedVertex2DDataSize()) &&
+           upload(framePacked3D, drawList.getPackedVertex3DData(), drawList.getPackedVertex3DDataSize()) &&
+           upload(frameInstances, drawList.getInstanceData(), drawList.getInstanceDataSize()) &&
+           upload(frameShapes, drawList.getShapeData(), drawList.getShapeDataSize()) &&
+           upload(frameStrokes, drawList.getStrokeSegmentData(), drawList.getStrokeSegmentDataSize()) &&
+           upload(framePaths, drawList.getPathData(), drawList.getPathDataSize()) &&
+           upload(framePathSegments, drawList.getPathSegmentData(), drawList.getPathSegmentDataSize()) &&
+           upload(frameUniforms, drawList.getUniformData(), drawList.getUniformDataSize()) &&
+           uploadIndices(drawList);
+}
 
-        NSLog(@"MetalRenderer: All pipeline variants created successfully");
+bool MetalRenderer::Impl::uploadIndices(const DrawList& drawList) {
+    const CommandStream& commands = drawList.getCommands();
+    const uint32_t* indices = drawList.getIndexData();
+    const size_t indexCount = drawList.getIndexCount();
+    indexRanges.assign(commands.size(), IndexRange());
+    if (indexCount == 0) {
         return true;
     }
-}
 
-bool MetalRenderer::Impl::createBuffers() {
-    @autoreleasepool {
-        // Create triple-buffered vertex and index buffers
-        for (uint32_t i = 0; i < kMaxFramesInFlight; i++) {
-            // 2D vertex buffer
-            vertexBuffer2D[i] = [device newBufferWithLength:kMaxVertices2D * sizeof(Vertex2D)
-                                                   options:MTLResourceStorageModeShared];
-            if (!vertexBuffer2D[i]) {
-                NSLog(@"MetalRenderer: Failed to create 2D vertex buffer %u", i);
-                return false;
-            }
-            vertexBuffer2D[i].label = [NSString stringWithFormat:@"VertexBuffer2D_%u", i];
+    // Written in place (bindFrameStorage): compact within the mapping, which
+    // is safe front to back while ranges ascend without overlap
+    const bool mapped = frameIndices && indices == frameIndices.contents &&
+                        indexCount * sizeof(uint32_t) <= frameIndices.size;
+    bool ascending = true;
+    size_t previousEnd = 0;
+    size_t bytes = 0;
+    for (size_t i = 0; i < commands.size(); ++i) {
+        uint32_t offset, count, vertices;
+        if (!commandIndexRange(commands[i], offset, count, vertices)) {
+            continue;
+        }
+        if ((size_t)offset + count > indexCount) {
+            METAL_LOG_ERROR(@"MetalRenderer: Index range exceeds index data (%u + %u > %zu)",
+                  offset, count, indexCount);
+            return false;
+        }
+        ascending = ascending && offset >= previousEnd;
+        previousEnd = (size_t)offset + count;
+
+        IndexRange& range = indexRanges[i];
+        // macOS requires index buffer offsets to be 4-byte aligned
+        range.type = indexTypeForVertexCount(vertices);
+        bytes = (bytes + 3) & ~size_t(3);
+        range.byteOffset = static_cast<uint32_t>(bytes);
+        bytes += (size_t)count * indexSize(range.type);
+    }
 
-            // 3D vertex buffer
-            vertexBuffer3D[i] = [device newBufferWithLength:kMaxVertices3D * sizeof(Vertex3D)
-                                                   options:MTLResourceStorageModeShared];
-            if (!vertexBuffer3D[i]) {
-                NSLog(@"MetalRenderer: Failed to create 3D vertex buffer %u", i);
-                return false;
+    if (mapped && !ascending) {
+        // Reordered ranges would overwrite each other; keep the 32-bit stream
+        for (size_t i = 0; i < commands.size(); ++i) {
+            uint32_t offset, count, vertices;
+            if (commandIndexRange(commands[i], offset, count, vertices)) {
+                indexRanges[i] = {offset * (uint32_t)sizeof(uint32_t), IndexType::UInt32};
             }
-            vertexBuffer3D[i].label = [NSString stringWithFormat:@"VertexBuffer3D_%u", i];
+        }
+        return true;
+    }
+    if (bytes == 0) {
+        return true;
+    }
 
-            // Index buffer
-            indexBuffer[i] = [device newBufferWithLength:kMaxIndices * sizeof(uint32_t)
-                                                options:MTLResourceStorageModeShared];
-            if (!indexBuffer[i]) {
-                NSLog(@"MetalRenderer: Failed to create index buffer %u", i);
-                return false;
+    if (!mapped) {
+        frameIndices = geometryRing->allocate(bytes, kGeometryAlignment);
+        if (!frameIndices) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to allocate %zu bytes of geometry", bytes);
+            return false;
+        }
+    }
+
+    uint8_t* dst = (uint8_t*)frameIndices.contents;
+    for (size_t i = 0; i < commands.size(); ++i) {
+        uint32_t offset, count, vertices;
+        if (!commandIndexRange(commands[i], offset, count, vertices)) {
+            continue;
+        }
+        const IndexRange& range = indexRanges[i];
+        const uint32_t* src = indices + offset;
+        if (range.type == IndexType::UInt16) {
+            uint16_t* out = (uint16_t*)(dst + range.byteOffset);
+            for (uint32_t k = 0; k < count; ++k) {
+                out[k] = (uint16_t)src[k];
             }
-            indexBuffer[i].label = [NSString stringWithFormat:@"IndexBuffer_%u", i];
+        } else if ((const void*)(dst + range.byteOffset) != (const void*)src) {
+            std::memmove(dst + range.byteOffset, src, (size_t)count * sizeof(uint32_t));
         }
+    }
+    return true;
+}
 
-        NSLog(@"MetalRenderer: Buffers created successfully");
-        return true;
+const MetalRenderer::Impl::IndexRange* MetalRenderer::Impl::currentIndexRange(const DrawList& drawList) const {
+    // Ranges are laid out per command by uploadIndices()
+    if (executingList != &drawList || executingIndex >= indexRanges.size()) {
+        return nullptr;
     }
+    return &indexRanges[executingIndex];
 }
 
 bool MetalRenderer::Impl::createDepthStencilStates() {
@@ -636,7 +2022,7 @@ bool MetalRenderer::Impl::createDepthStencilStates() {
         depthEnabledDesc.depthWriteEnabled = YES;
         depthEnabledState = [device newDepthStencilStateWithDescriptor:depthEnabledDesc];
         if (!depthEnabledState) {
-            NSLog(@"MetalRenderer: Failed to create depth enabled state");
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create depth enabled state");
             return false;
         }
 
@@ -646,13 +2032,452 @@ bool MetalRenderer::Impl::createDepthStencilStates() {
         depthDisabledDesc.depthWriteEnabled = NO;
         depthDisabledState = [device newDepthStencilStateWithDescriptor:depthDisabledDesc];
         if (!depthDisabledState) {
-            NSLog(@"MetalRenderer: Failed to create depth disabled state");
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create depth disabled state");
+            return false;
+        }
+
+        // Depth test without writes (transparency accumulation)
+        MTLDepthStencilDescriptor* depthTestOnlyDesc = [[MTLDepthStencilDescriptor alloc] init];
+        depthTestOnlyDesc.depthCompareFunction = MTLCompareFunctionLess;
+        depthTestOnlyDesc.depthWriteEnabled = NO;
+        depthTestOnlyState = [device newDepthStencilStateWithDescriptor:depthTestOnlyDesc];
+        if (!depthTestOnlyState) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create depth test-only state");
+            return false;
+        }
+
+        METAL_LOG_NOTICE(@"MetalRenderer: Depth/stencil states created");
+        return true;
+    }
+}
+
+id<MTLSamplerState> MetalRenderer::Impl::createSamplerState(SamplerKey key) {
+    auto toFilter = [](uint32_t bit) {
+        return bit ? MTLSamplerMinMagFilterLinear : MTLSamplerMinMagFilterNearest;
+    };
+    auto toAddress = [](uint32_t wrap) {
+        switch (static_cast<TextureWrap>(wrap)) {
+            case TextureWrap::Repeat: return MTLSamplerAddressModeRepeat;
+            case TextureWrap::Mirror: return MTLSamplerAddressModeMirrorRepeat;
+            case TextureWrap::Clamp:
+            default:                  return MTLSamplerAddressModeClampToEdge;
+        }
+    };
+
+    MTLSamplerDescriptor* samplerDesc = [[MTLSamplerDescriptor alloc] init];
+    samplerDesc.minFilter = toFilter(key & 0x1u);
+    samplerDesc.magFilter = toFilter((key >> 1) & 0x1u);
+    switch (static_cast<TextureMipFilter>((key >> 2) & 0x3u)) {
+        case TextureMipFilter::Nearest: samplerDesc.mipFilter = MTLSamplerMipFilterNearest; break;
+        case TextureMipFilter::Linear:  samplerDesc.mipFilter = MTLSamplerMipFilterLinear; break;
+        default:                        samplerDesc.mipFilter = MTLSamplerMipFilterNotMipmapped; break;
+    }
+    samplerDesc.sAddressMode = toAddress((key >> 4) & 0x3u);
+    samplerDesc.tAddressMode = toAddress((key >> 6) & 0x3u);
+    samplerDesc.maxAnisotropy = 1u << ((key >> 8) & 0x7u);
+
+    return [device newSamplerStateWithDescriptor:samplerDesc];
+}
+
+bool MetalRenderer::Impl::createSamplerStates() {
+    @autoreleasepool {
+        // Only the default, which getSamplerState() falls back to; the other
+        // combinations are created as draws first use them
+        samplerStates[kDefaultSamplerKey] = createSamplerState(kDefaultSamplerKey);
+        if (!samplerStates[kDefaultSamplerKey]) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create default sampler state");
             return false;
         }
 
-        NSLog(@"MetalRenderer: Depth/stencil states created");
+        METAL_LOG_NOTICE(@"MetalRenderer: Sampler states created");
+        return true;
+    }
+}
+
+id<MTLSamplerState> MetalRenderer::Impl::getSamplerState(SamplerKey key) {
+    if (key >= kSamplerKeyCount) {
+        key = kDefaultSamplerKey;
+    }
+    if (!samplerStates[key]) {
+        samplerStates[key] = createSamplerState(key);
+        if (!samplerStates[key]) {
+            return samplerStates[kDefaultSamplerKey];
+        }
+    }
+    return samplerStates[key];
+}
+
+MTKTextureLoader* MetalRenderer::Impl::getTextureLoader() {
+    // Textures may load from any thread
+    std::lock_guard<std::mutex> lock(textureLoaderMutex);
+    if (!textureLoader) {
+        textureLoader = [[MTKTextureLoader alloc] initWithDevice:device];
+    }
+    return textureLoader;
+}
+
+// ============================================================================
+// GPU Timeline
+// ============================================================================
+
+void MetalRenderer::Impl::createTimestampBuffers() {
+    @autoreleasepool {
+        if (![device supportsCounterSampling:MTLCounterSamplingPointAtStageBoundary]) {
+            METAL_LOG_ERROR(@"MetalRenderer: GPU timeline unavailable (no stage boundary counter sampling)");
+            return;
+        }
+
+        id<MTLCounterSet> timestampSet = nil;
+        for (id<MTLCounterSet> set in device.counterSets) {
+            if ([set.name isEqualToString:MTLCommonCounterSetTimestamp]) {
+                timestampSet = set;
+                break;
+            }
+        }
+        if (!timestampSet) {
+            METAL_LOG_ERROR(@"MetalRenderer: GPU timeline unavailable (no timestamp counter set)");
+            return;
+        }
+
+        MTLCounterSampleBufferDescriptor* desc = [[MTLCounterSampleBufferDescriptor alloc] init];
+        desc.counterSet = timestampSet;
+        desc.storageMode = MTLStorageModeShared;
+        desc.sampleCount = kMaxTimelinePasses * 2;
+        for (uint32_t i = 0; i < kMaxFramesInFlight; i++) {
+            desc.label = [NSString stringWithFormat:@"TimelineSamples_%u", i];
+            NSError* error = nil;
+            timelineFrames[i].samples = [device newCounterSampleBufferWithDescriptor:desc error:&error];
+            if (!timelineFrames[i].samples) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create timeline sample buffer: %@", error.localizedDescription);
+                for (uint32_t j = 0; j < kMaxFramesInFlight; j++) {
+                    timelineFrames[j].samples = nil;
+                }
+                return;
+            }
+        }
+    }
+}
+
+int32_t MetalRenderer::Impl::reserveTimelinePass(const char* name) {
+    TimelineFrame& frame = timelineFrames[currentFrameIndex];
+    std::lock_guard<std::mutex> lock(timelineMutex);
+    if (!frame.samples || !currentCommandBuffer || frame.passCount >= kMaxTimelinePasses) {
+        return -1;
+    }
+    std::strncpy(frame.names[frame.passCount], name ? name : "Pass", sizeof(frame.names[0]) - 1);
+    frame.names[frame.passCount][sizeof(frame.names[0]) - 1] = '\0';
+    return (int32_t)frame.passCount++;
+}
+
+bool MetalRenderer::Impl::attachTimestamps(MTLRenderPassDescriptor* pass, const char* name) {
+    const int32_t slot = reserveTimelinePass(name);
+    if (slot < 0) {
+        return false;
+    }
+    // Vertex stage start to fragment stage end covers the whole pass
+    MTLRenderPassSampleBufferAttachmentDescriptor* attachment = pass.sampleBufferAttachments[0];
+    attachment.sampleBuffer = timelineFrames[currentFrameIndex].samples;
+    attachment.startOfVertexSampleIndex = (NSUInteger)slot * 2;
+    attachment.endOfVertexSampleIndex = MTLCounterDontSample;
+    attachment.startOfFragmentSampleIndex = MTLCounterDontSample;
+    attachment.endOfFragmentSampleIndex = (NSUInteger)slot * 2 + 1;
+    return true;
+}
+
+bool MetalRenderer::Impl::attachTimestamps(MTLComputePassDescriptor* pass, const char* name) {
+    const int32_t slot = reserveTimelinePass(name);
+    if (slot < 0) {
+        return false;
+    }
+    MTLComputePassSampleBufferAttachmentDescriptor* attachment = pass.sampleBufferAttachments[0];
+    attachment.sampleBuffer = timelineFrames[currentFrameIndex].samples;
+    attachment.startOfEncoderSampleIndex = (NSUInteger)slot * 2;
+    attachment.endOfEncoderSampleIndex = (NSUInteger)slot * 2 + 1;
+    return true;
+}
+
+const char* MetalRenderer::Impl::currentPassName() const {
+    if (!currentRenderTarget) {
+        return "Screen";
+    }
+    static thread_local char name[32];
+    std::snprintf(name, sizeof(name), "RenderTarget %lux%lu",
+                  (unsigned long)currentRenderTarget.width, (unsigned long)currentRenderTarget.height);
+    return name;
+}
+
+bool MetalRenderer::Impl::laterPassLoadsDepth() const {
+    // Depth written by this encoder is needed only if a later encoder on the
+    // same attachment resumes without clearing it. Render target depth lives
+    // for one begin()/end(); the view's depth spans all screen passes.
+    // Deferred transparent draws test against it in a pass of their own;
+    // the occlusion pyramid is built from the screen's final depth.
+    if (!transparentDraws.empty()) {
+        return true;
+    }
+    if (occlusionCullingEnabled && !currentRenderTarget) {
+        return true;
+    }
+    if (executingList) {
+        const CommandStream& commands = executingList->getCommands();
+        bool onTarget = true;
+        bool resumed = false;
+        for (size_t i = executingIndex + 1; i < commands.size(); ++i) {
+            CommandRef cmd = commands[i];
+            switch (cmd.type) {
+                case CommandType::SetRenderTarget:
+                    if (currentRenderTarget) {
+                        return false;
+                    }
+                    onTarget = cmd.as<SetRenderTargetCommand>().renderTarget == nullptr;
+                    resumed = resumed || onTarget;
+                    break;
+                case CommandType::Clear:
+                    if (onTarget) {
+                        return !cmd.as<SetClearCommand>().clearData.clearDepth;
+                    }
+                    break;
+                case CommandType::DispatchCompute:
+                case CommandType::ReadbackTexture:
+                case CommandType::FilterTexture:
+                case CommandType::GenerateMipmaps:
+                case CommandType::ConvertYCbCr:
+                case CommandType::ConvertYCoCg:
+                case CommandType::CopyTexture:
+                case CommandType::PostProcess:
+                case CommandType::RenderShadowMap:
+                case CommandType::DrawDisplayList:   // May clear or dispatch; keep depth
+                    if (onTarget) {
+                        return true;
+                    }
+                    break;
+                case CommandType::Draw2D:
+                case CommandType::Draw2DShapes:
+                case CommandType::Draw2DStroke:
+                case CommandType::Draw2DPaths:
+                case CommandType::Draw3D:
+                case CommandType::Draw3DInstanced:
+                case CommandType::Draw3DIndirect:
+                case CommandType::DrawMeshPrimitives:
+                case CommandType::DrawPointCloud:
+                    if (onTarget && (resumed || isOrderIndependent(cmd))) {
+                        return true;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    return listsFollow;
+}
+
+bool MetalRenderer::Impl::targetReloads(bool depth) const {
+    // Any encoder break before the target is switched away resumes with
+    // depth (or multisample color) loaded, which tile memory cannot provide;
+    // resolving deferred transparency is one
+    if (!transparentDraws.empty()) {
         return true;
     }
+    if (executingList) {
+        const CommandStream& commands = executingList->getCommands();
+        for (size_t i = executingIndex + 1; i < commands.size(); ++i) {
+            CommandRef cmd = commands[i];
+            if (cmd.type == CommandType::SetRenderTarget) {
+                return false;
+            }
+            if (cmd.type == CommandType::DispatchCompute || cmd.type == CommandType::DrawDisplayList ||
+                cmd.type == CommandType::RenderShadowMap || cmd.type == CommandType::ReadbackTexture ||
+                cmd.type == CommandType::FilterTexture || cmd.type == CommandType::GenerateMipmaps ||
+                cmd.type == CommandType::ConvertYCbCr || cmd.type == CommandType::ConvertYCoCg ||
+                cmd.type == CommandType::CopyTexture || cmd.type == CommandType::PostProcess ||
+                isOrderIndependent(cmd) ||
+                (cmd.type == CommandType::Clear &&
+                 !(depth ? cmd.as<SetClearCommand>().clearData.clearDepth
+                         : cmd.as<SetClearCommand>().clearData.clearColor))) {
+                return true;
+            }
+        }
+    }
+    return listsFollow;
+}
+
+id<MTLTexture> MetalRenderer::Impl::targetDepthTexture(NSUInteger width, NSUInteger height,
+                                                       NSUInteger samples, bool memoryless) {
+    id<MTLTexture>& texture = memoryless ? transientDepthTarget : depthTarget;
+    if (texture && texture.width == width && texture.height == height && texture.sampleCount == samples) {
+        return texture;
+    }
+
+    MTLTextureDescriptor* depthDesc = [MTLTextureDescriptor
+        texture2DDescriptorWithPixelFormat:MTLPixelFormatDepth32Float
+        width:width
+        height:height
+        mipmapped:NO];
+    if (samples > 1) {
+        depthDesc.textureType = MTLTextureType2DMultisample;
+        depthDesc.sampleCount = samples;
+    }
+    depthDesc.usage = MTLTextureUsageRenderTarget;
+    depthDesc.storageMode = memoryless ? MTLStorageModeMemoryless : MTLStorageModePrivate;
+
+    texture = makeTrackedTexture(device, depthDesc, oflike::ofGpuMemoryCategory::RenderTargets, "FBO Depth");
+    if (!texture) {
+        METAL_LOG_ERROR(@"MetalRenderer: Failed to create depth buffer for FBO");
+        // Continue without depth buffer
+    }
+    return texture;
+}
+
+id<MTLTexture> MetalRenderer::Impl::targetMultisampleTexture(id<MTLTexture> target, NSUInteger samples,
+                                                             bool memoryless) {
+    // Like depth, one multisample color buffer serves every target of the
+    // same size, format and sample count; its samples live for one begin()
+    id<MTLTexture>& texture = memoryless ? transientMsaaTarget : msaaTarget;
+    if (texture && texture.width == target.width && texture.height == target.height &&
+        texture.pixelFormat == target.pixelFormat && texture.sampleCount == samples) {
+        return texture;
+    }
+
+    MTLTextureDescriptor* msaaDesc = [MTLTextureDescriptor
+        texture2DDescriptorWithPixelFormat:target.pixelFormat
+        width:target.width
+        height:target.height
+        mipmapped:NO];
+    msaaDesc.textureType = MTLTextureType2DMultisample;
+    msaaDesc.sampleCount = samples;
+    msaaDesc.usage = MTLTextureUsageRenderTarget;
+    msaaDesc.storageMode = memoryless ? MTLStorageModeMemoryless : MTLStorageModePrivate;
+
+    texture = makeTrackedTexture(device, msaaDesc, oflike::ofGpuMemoryCategory::RenderTargets, "FBO MSAA");
+    if (!texture) {
+        METAL_LOG_ERROR(@"MetalRenderer: Failed to create %lux MSAA buffer for FBO", (unsigned long)samples);
+    }
+    return texture;
+}
+
+void MetalRenderer::Impl::configureLoadStore(MTLRenderPassDescriptor* pass, bool clearColor, bool clearDepth) {
+    // Color: the frame's first screen pass keeps the view's clear; every
+    // other pass resumes what earlier encoders drew
+    const bool onScreen = currentRenderTarget == nil;
+    if (clearColor || (onScreen && !screenStarted)) {
+        pass.colorAttachments[0].loadAction = MTLLoadActionClear;
+    } else {
+        pass.colorAttachments[0].loadAction = MTLLoadActionLoad;
+    }
+    if (onScreen) {
+        screenStarted = true;
+    }
+
+    // Rate-mapped passes leave their target to resolve
+    if (pass.rasterizationRateMap) {
+        if (RateTarget* rate = findRateTarget(onScreen ? nullptr : (__bridge void*)currentRenderTarget)) {
+            rate->drawn = true;
+        }
+    }
+
+    // Multisampled targets resolve at the end of every encoder; samples are
+    // stored only for a later encoder of the same begin() to load. A begin()
+    // that starts without a clear has no samples and starts transparent.
+    id<MTLTexture> msaaTexture = pass.colorAttachments[0].texture;
+    if (!onScreen && pass.colorAttachments[0].resolveTexture) {
+        if (!clearColor && !targetSamplesValid) {
+            pass.colorAttachments[0].loadAction = MTLLoadActionClear;
+            pass.colorAttachments[0].clearColor = MTLClearColorMake(0, 0, 0, 0);
+        }
+        targetSamplesValid = msaaTexture.storageMode != MTLStorageModeMemoryless && targetReloads(false);
+        pass.colorAttachments[0].storeAction = targetSamplesValid ? MTLStoreActionStoreAndMultisampleResolve
+                                                                  : MTLStoreActionMultisampleResolve;
+    }
+
+    // Depth: load only contents a previous encoder stored, store only what a
+    // later encoder loads
+    id<MTLTexture> depthTexture = pass.depthAttachment.texture;
+    if (!depthTexture) {
+        return;
+    }
+    bool& depthValid = onScreen ? screenDepthValid : targetDepthValid;
+    if (clearDepth) {
+        pass.depthAttachment.loadAction = MTLLoadActionClear;
+    } else if (depthValid) {
+        pass.depthAttachment.loadAction = MTLLoadActionLoad;
+    } else {
+        pass.depthAttachment.loadAction = MTLLoadActionClear;
+        pass.depthAttachment.clearDepth = 1.0;
+    }
+    depthValid = depthTexture.storageMode != MTLStorageModeMemoryless && laterPassLoadsDepth();
+    pass.depthAttachment.storeAction = depthValid ? MTLStoreActionStore : MTLStoreActionDontCare;
+}
+
+id<MTLRenderCommandEncoder> MetalRenderer::Impl::beginRenderEncoder(MTLRenderPassDescriptor* pass,
+                                                                    bool clearColor, bool clearDepth) {
+    configureLoadStore(pass, clearColor, clearDepth);
+
+    // Descriptors are reused across encoders (view pass, resumed passes), so
+    // the sample attachment is only set while this encoder is created
+    const bool timed = attachTimestamps(pass, currentPassName());
+    id<MTLRenderCommandEncoder> encoder = [currentCommandBuffer renderCommandEncoderWithDescriptor:pass];
+    if (timed) {
+        pass.sampleBufferAttachments[0].sampleBuffer = nil;
+    }
+    return encoder;
+}
+
+void MetalRenderer::Impl::resolveTimeline(uint32_t frameIndex) {
+    // Called from the completion handler; the slot is not reused until the
+    // frame semaphore is signaled afterwards
+    TimelineFrame& frame = timelineFrames[frameIndex];
+    uint32_t passCount;
+    {
+        std::lock_guard<std::mutex> lock(timelineMutex);
+        passCount = frame.passCount;
+    }
+    if (!frame.samples || passCount == 0) {
+        std::lock_guard<std::mutex> lock(timelineMutex);
+        lastTimeline.clear();
+        return;
+    }
+
+    @autoreleasepool {
+        NSData* data = [frame.samples resolveCounterRange:NSMakeRange(0, passCount * 2)];
+        if (!data || data.length < passCount * 2 * sizeof(MTLCounterResultTimestamp)) {
+            return;
+        }
+        const MTLCounterResultTimestamp* stamps = (const MTLCounterResultTimestamp*)data.bytes;
+
+        // GPU ticks to milliseconds via the CPU clock (nanoseconds)
+        MTLTimestamp cpuEnd = 0;
+        MTLTimestamp gpuEnd = 0;
+        [device sampleTimestamps:&cpuEnd gpuTimestamp:&gpuEnd];
+        const double gpuTicks = (double)(gpuEnd - frame.gpuStart);
+        const double msPerTick = gpuTicks > 0.0 ? (double)(cpuEnd - frame.cpuStart) / gpuTicks / 1.0e6 : 0.0;
+
+        std::vector<GPUPassTiming> timeline;
+        timeline.reserve(passCount);
+        uint64_t origin = 0;
+        for (uint32_t i = 0; i < passCount; i++) {
+            const uint64_t start = stamps[i * 2].timestamp;
+            const uint64_t end = stamps[i * 2 + 1].timestamp;
+            // Passes reserved but never encoded, or not sampled, are skipped
+            if (start == 0 || end < start || start == MTLCounterErrorValue || end == MTLCounterErrorValue) {
+                continue;
+            }
+            if (origin == 0 || start < origin) {
+                origin = start;
+            }
+            GPUPassTiming pass;
+            std::memcpy(pass.name, frame.names[i], sizeof(pass.name));
+            pass.startMs = (double)start;
+            pass.durationMs = (double)(end - start) * msPerTick;
+            timeline.push_back(pass);
+        }
+        for (GPUPassTiming& pass : timeline) {
+            pass.startMs = (pass.startMs - (double)origin) * msPerTick;
+        }
+
+        std::lock_guard<std::mutex> lock(timelineMutex);
+        lastTimeline = std::move(timeline);
+    }
 }
 
 // ============================================================================
@@ -666,28 +2491,76 @@ bool MetalRenderer::Impl::beginFrame() {
 
     @autoreleasepool {
         // Wait for a frame slot to be available
-        dispatch_semaphore_wait(frameSemaphore, DISPATCH_TIME_FOREVER);
+        if (slotAcquired) {
+            slotAcquired = false;
+        } else {
+            dispatch_semaphore_wait(frameSemaphore, DISPATCH_TIME_FOREVER);
+        }
 
         // Reset frame statistics
         frameDrawCalls = 0;
         frameVertices = 0;
+        frameSkippedStateChanges = 0;
+        frameCulledDraws = 0;
         frameStartTime = CACurrentMediaTime();
 
         // Create command buffer
         currentCommandBuffer = [commandQueue commandBuffer];
         if (!currentCommandBuffer) {
-            NSLog(@"MetalRenderer: Failed to create command buffer");
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create command buffer");
             dispatch_semaphore_signal(frameSemaphore);
             return false;
         }
         currentCommandBuffer.label = @"FrameCommandBuffer";
 
+        // The semaphore guarantees this slot's geometry chunks are free again
+        geometryRing->beginFrame(currentFrameIndex);
+        frameVertices2D = RingAllocation();
+        frameVertices3D = RingAllocation();
+        framePacked2D = RingAllocation();
+        framePacked3D = RingAllocation();
+        frameIndices = RingAllocation();
+        frameInstances = RingAllocation();
+        frameShapes = RingAllocation();
+        frameStrokes = RingAllocation();
+        framePaths = RingAllocation();
+        framePathSegments = RingAllocation();
+        frameUniforms = RingAllocation();
+        lightingBytesUsed = 0;
+        lightingListOffset = 0;
+        lightingLightsOffset = 0;
+        lightingShadowsOffset = 0;
+        clusterBytesUsed = 0;
+        lightClusterGrids.clear();
+
+        // Release display lists that stopped being replayed
+        frameSerial++;
+        for (auto it = residentDisplayLists.begin(); it != residentDisplayLists.end();) {
+            if (frameSerial - it->second.lastUsedFrame > kDisplayListRetainFrames) {
+                it = residentDisplayLists.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        // Fresh timeline for this slot
+        {
+            std::lock_guard<std::mutex> lock(timelineMutex);
+            timelineFrames[currentFrameIndex].passCount = 0;
+        }
+        if (timelineFrames[currentFrameIndex].samples) {
+            [device sampleTimestamps:&timelineFrames[currentFrameIndex].cpuStart
+                        gpuTimestamp:&timelineFrames[currentFrameIndex].gpuStart];
+        }
+
         // Capture GPU timing info
         __block double* gpuTimePtr = &lastGPUTime;
         __block CFTimeInterval startTime = frameStartTime;
 
-        // Signal semaphore when frame completes
+        // Retire ring chunks and signal semaphore when frame completes
         __block dispatch_semaphore_t blockSemaphore = frameSemaphore;
+        MetalRingAllocator* ring = geometryRing.get();
+        uint32_t frameIndex = currentFrameIndex;
         [currentCommandBuffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
             // Calculate GPU time (kernel + GPU time)
             CFTimeInterval gpuStart = buffer.GPUStartTime;
@@ -696,7 +2569,9 @@ bool MetalRenderer::Impl::beginFrame() {
             if (gpuStart > 0 && gpuEnd > 0) {
                 *gpuTimePtr = (gpuEnd - gpuStart) * 1000.0;  // Convert to milliseconds
             }
+            resolveTimeline(frameIndex);
 
+            ring->retireFrame(frameIndex);
             dispatch_semaphore_signal(blockSemaphore);
         }];
 
@@ -713,10 +2588,42 @@ bool MetalRenderer::Impl::endFrame() {
         // End current encoder if active
         endCurrentEncoder();
 
+        // Bring rate-mapped targets (and the screen) to full size
+        resolveRasterizationRates();
+
+        // Uploads made after the last list are in place for the next frame
+        flushTextureUploads();
+
+        // Reduce this frame's depth for the next frame's occlusion culling
+        buildOcclusionPyramid();
+
+        // Copy out the pick requested for this frame
+        readObjectIdPick();
+
+        // Other displays show their slices of this frame
+        encodeDisplayOutputs();
+
         // Present drawable
-        id<CAMetalDrawable> drawable = view ? view.currentDrawable : nil;
+        id<CAMetalDrawable> drawable = frameDrawable ? frameDrawable
+                                                     : (view ? view.currentDrawable : nil);
         if (drawable && currentCommandBuffer) {
-            [currentCommandBuffer presentDrawable:drawable];
+            // Presentation times let callers measure latency to the screen
+            const uint64_t serial = frameSerial;
+            Impl* impl = this;
+            [drawable addPresentedHandler:^(id<MTLDrawable> presented) {
+                if (presented.presentedTime > 0.0) {
+                    std::lock_guard<std::mutex> lock(impl->presentMutex);
+                    if (serial > impl->presentedSerial) {
+                        impl->presentedSerial = serial;
+                        impl->presentedTime = presented.presentedTime;
+                    }
+                }
+            }];
+            if (presentMinimumDuration > 0.0) {
+                [currentCommandBuffer presentDrawable:drawable afterMinimumDuration:presentMinimumDuration];
+            } else {
+                [currentCommandBuffer presentDrawable:drawable];
+            }
         }
 
         // Commit command buffer
@@ -731,9 +2638,18 @@ bool MetalRenderer::Impl::endFrame() {
         currentCommandBuffer = nil;
         currentEncoder = nil;
         currentRenderPass = nil;
+        frameDrawable = nil;
+        frameRenderPass = nil;
+        rateScreenPass = nil;
 
         // Reset render target state to default (screen)
         currentRenderTarget = nil;
+        screenStarted = false;
+        screenDepthValid = false;
+        screenDepthTexture = nil;
+        targetDepthValid = false;
+        targetSampleCount = 1;
+        targetSamplesValid = false;
         // Keep depthTarget allocated for reuse in next frame
 
         return true;
@@ -745,37 +2661,406 @@ void MetalRenderer::Impl::endCurrentEncoder() {
         [currentEncoder endEncoding];
         currentEncoder = nil;
     }
+    encoderState = EncoderStateCache();
 }
 
-MTLRenderPassDescriptor* MetalRenderer::Impl::getCurrentRenderPassDescriptor() {
-    if (currentRenderPass) {
-        return currentRenderPass;
+bool MetalRenderer::Impl::uploadLightingStates(const DrawList& drawList) {
+    const auto& states = drawList.getLightingStates();
+    if (states.empty()) {
+        return true;
     }
 
     @autoreleasepool {
-        // Check if rendering to a custom render target (FBO) or the view
-        if (currentRenderTarget) {
-            // Create render pass for custom render target (FBO)
-            currentRenderPass = [MTLRenderPassDescriptor renderPassDescriptor];
-
-            // Set color attachment
-            currentRenderPass.colorAttachments[0].texture = currentRenderTarget;
-            currentRenderPass.colorAttachments[0].loadAction = MTLLoadActionLoad;
-            currentRenderPass.colorAttachments[0].storeAction = MTLStoreActionStore;
-
-            // Set depth attachment if available
-            if (depthTarget) {
-                currentRenderPass.depthAttachment.texture = depthTarget;
-                currentRenderPass.depthAttachment.loadAction = MTLLoadActionLoad;
-                currentRenderPass.depthAttachment.storeAction = MTLStoreActionStore;
+        // Blocks of every list executed this frame share one buffer; each list
+        // appends after the previous one so earlier bindings stay valid
+        const std::vector<float>& lights = drawList.getLightData();
+        const std::vector<ShadowState>& shadows = drawList.getShadowStates();
+        const size_t blocksBytes = states.size() * kLightingBlockStride;
+        const size_t shadowsBytes = shadows.empty() ? 0 : (shadows.size() + 1) * kShadowBlockStride;
+        const size_t lightsBytes = (lights.size() * sizeof(float) + 255) & ~size_t(255);
+        const size_t required = lightingBytesUsed + blocksBytes + shadowsBytes + lightsBytes;
+        id<MTLBuffer> buffer = lightingBuffer[currentFrameIndex];
+        if (!buffer || buffer.length < required) {
+            size_t capacity = buffer ? buffer.length : kLightingBlockStride * 16;
+            while (capacity < required) {
+                capacity *= 2;
             }
-        } else {
-            // Get default render pass from view (render to screen)
-            currentRenderPass = view.currentRenderPassDescriptor;
-            if (!currentRenderPass) {
-                NSLog(@"MetalRenderer: No render pass descriptor available");
-                return nil;
+            id<MTLBuffer> grown = makeTrackedBuffer(device, capacity, MTLResourceStorageModeShared,
+                                                     oflike::ofGpuMemoryCategory::Streaming, "LightingBuffer");
+            if (!grown) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create lighting buffer (%zu bytes)", capacity);
+                return false;
+            }
+            grown.label = [NSString stringWithFormat:@"LightingBuffer_%u", currentFrameIndex];
+            // Already-encoded lists keep referencing the old buffer
+            if (buffer && lightingBytesUsed > 0) {
+                std::memcpy([grown contents], [buffer contents], lightingBytesUsed);
+            }
+            buffer = grown;
+            lightingBuffer[currentFrameIndex] = buffer;
+        }
+
+        // Upload each unique block once, then the shadows and lights they reference
+        lightingListOffset = lightingBytesUsed;
+        lightingShadowsOffset = lightingListOffset + blocksBytes;
+        lightingLightsOffset = lightingShadowsOffset + shadowsBytes;
+        uint8_t* dst = (uint8_t*)[buffer contents] + lightingListOffset;
+        for (const LightingState& state : states) {
+            std::memcpy(dst, state.materialData, sizeof(state.materialData));
+            dst += kLightingBlockStride;
+        }
+        if (!shadows.empty()) {
+            std::memset(dst, 0, kShadowBlockStride);
+            dst += kShadowBlockStride;
+            for (const ShadowState& state : shadows) {
+                std::memcpy(dst, &state.uniforms, sizeof(state.uniforms));
+                dst += kShadowBlockStride;
+            }
+        }
+        if (!lights.empty()) {
+            std::memcpy(dst, lights.data(), lights.size() * sizeof(float));
+        }
+        lightingBytesUsed = required;
+
+        // Handles are per list; force a rebind for the first lit draw
+        encoderState.lightingHandle = kInvalidLightingHandle;
+        return true;
+    }
+}
+
+bool MetalRenderer::Impl::needsLightClusters(const DrawList& drawList) {
+    for (const LightingState& state : drawList.getLightingStates()) {
+        if (state.lightCount > kClusteredLightThreshold) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const MetalRenderer::Impl::LightClusterGrid* MetalRenderer::Impl::findLightClusterGrid(
+    const LightingState& lighting, const simd_float4x4& projection) const {
+    for (const LightClusterGrid& grid : lightClusterGrids) {
+        if (grid.firstLight == lighting.firstLight && grid.lightCount == lighting.lightCount &&
+            std::memcmp(&grid.projection, &projection, sizeof(projection)) == 0) {
+            return &grid;
+        }
+    }
+    return nullptr;
+}
+
+bool MetalRenderer::Impl::buildLightClusters(const DrawList& drawList,
+                                             const simd_float4x4* projectionOverride) {
+    lightClusterGrids.clear();
+    // Shadow passes draw depth only, and compute would end their encoder
+    if (shadowPassActive || !needsLightClusters(drawList)) {
+        return true;
+    }
+
+    // One grid per light set and projection used by a lit draw with many lights
+    for (CommandRef cmd : drawList.getCommands()) {
+        if (cmd.type != CommandType::Draw3D && cmd.type != CommandType::Draw3DInstanced &&
+            cmd.type != CommandType::Draw3DIndirect && cmd.type != CommandType::DrawMeshPrimitives) {
+            continue;
+        }
+        const DrawCommand3D& draw = cmd.as<DrawCommand3D>();
+        const LightingState* lighting = draw.useLighting ? drawList.getLightingState(draw.lightingHandle) : nullptr;
+        if (!lighting || lighting->lightCount <= kClusteredLightThreshold) {
+            continue;
+        }
+        const simd_float4x4& projection = projectionOverride ? *projectionOverride : draw.projectionMatrix;
+        if (findLightClusterGrid(*lighting, projection)) {
+            continue;
+        }
+        if (lightClusterGrids.size() == kMaxLightClusterGrids) {
+            break;
+        }
+
+        // Depth range covered by the slices; the GL near plane (NDC -1) lies
+        // in front of the Metal one (NDC 0) whenever it is valid
+        const simd_float4x4 inverse = simd_inverse(projection);
+        auto depthAt = [&](float ndcZ) {
+            const simd_float4 p = simd_mul(inverse, simd_make_float4(0.0f, 0.0f, ndcZ, 1.0f));
+            return -p.z / p.w;
+        };
+        const float glNear = depthAt(-1.0f);
+        const float metalNear = depthAt(0.0f);
+        const float nearZ = glNear > 0.0f && glNear < metalNear ? glNear : metalNear;
+        const float farZ = depthAt(1.0f);
+        if (!std::isfinite(nearZ) || !std::isfinite(farZ) || nearZ <= 0.0f || farZ <= nearZ) {
+            continue;   // e.g. orthographic with a near plane behind the eye
+        }
+
+        LightClusterGrid grid;
+        grid.firstLight = lighting->firstLight;
+        grid.lightCount = lighting->lightCount;
+        grid.projection = projection;
+        grid.nearZ = nearZ;
+        grid.scale = kClusterSlices / std::log(farZ / nearZ);
+        lightClusterGrids.push_back(grid);
+    }
+    if (lightClusterGrids.empty()) {
+        return true;
+    }
+
+    @autoreleasepool {
+        id<MTLComputePipelineState> pipeline = getComputePipeline("buildLightClusters");
+        if (!pipeline) {
+            lightClusterGrids.clear();  // Draws fall back to looping over every light
+            return true;
+        }
+
+        // Grids of earlier lists stay in the buffer they were written to
+        const size_t required = clusterBytesUsed + lightClusterGrids.size() * kClusterGridBytes;
+        id<MTLBuffer> buffer = clusterBuffer[currentFrameIndex];
+        if (!buffer || buffer.length < required) {
+            size_t capacity = buffer ? buffer.length : kClusterGridBytes * 2;
+            while (capacity < required) {
+                capacity *= 2;
+            }
+            buffer = makeTrackedBuffer(device, capacity, MTLResourceStorageModePrivate,
+                                       oflike::ofGpuMemoryCategory::Streaming, "LightClusterBuffer");
+            if (!buffer) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create light cluster buffer (%zu bytes)", capacity);
+                lightClusterGrids.clear();
+                return true;
+            }
+            buffer.label = [NSString stringWithFormat:@"LightClusterBuffer_%u", currentFrameIndex];
+            clusterBuffer[currentFrameIndex] = buffer;
+            clusterBytesUsed = 0;
+        }
+
+        // Light cluster build uniforms (matches LightClusterUniforms in Lighting.metal)
+        struct LightClusterUniforms {
+            simd_float4x4 inverseProjection;
+            float nearZ;
+            float farZ;
+            uint32_t firstLight;
+            uint32_t lightCount;
+        };
+
+        // Compute cannot run inside a render encoder; the next encoder on the
+        // pass resumes with its attachments loaded
+        endCurrentEncoder();
+
+        MTLComputePassDescriptor* computePass = [MTLComputePassDescriptor computePassDescriptor];
+        attachTimestamps(computePass, "Light Clusters");
+        id<MTLComputeCommandEncoder> encoder = [currentCommandBuffer computeCommandEncoderWithDescriptor:computePass];
+        if (!encoder) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create light cluster encoder");
+            lightClusterGrids.clear();
+            return true;
+        }
+
+        [encoder setComputePipelineState:pipeline];
+        [encoder setBuffer:lightingBuffer[currentFrameIndex] offset:lightingLightsOffset atIndex:0];
+        const NSUInteger width = pipeline.threadExecutionWidth;
+        const NSUInteger groups = (kClusterCount + width - 1) / width;
+        for (LightClusterGrid& grid : lightClusterGrids) {
+            grid.buffer = buffer;
+            grid.offset = clusterBytesUsed;
+            clusterBytesUsed += kClusterGridBytes;
+
+            LightClusterUniforms uniforms;
+            uniforms.inverseProjection = simd_inverse(grid.projection);
+            uniforms.nearZ = grid.nearZ;
+            uniforms.farZ = grid.nearZ * std::exp(kClusterSlices / grid.scale);
+            uniforms.firstLight = grid.firstLight;
+            uniforms.lightCount = static_cast<uint32_t>(grid.lightCount);
+
+            [encoder setBuffer:buffer offset:grid.offset atIndex:1];
+            [encoder setBuffer:buffer offset:grid.offset + kClusterCountsBytes atIndex:2];
+            [encoder setBytes:&uniforms length:sizeof(uniforms) atIndex:3];
+            [encoder dispatchThreadgroups:MTLSizeMake(groups, 1, 1)
+                    threadsPerThreadgroup:MTLSizeMake(width, 1, 1)];
+        }
+        [encoder endEncoding];
+        return true;
+    }
+}
+
+bool MetalRenderer::Impl::uploadDrawList(const DrawList& drawList) {
+    // Upload vertex/index data (skipped for streams written in place)
+    if (!uploadGeometry(drawList)) {
+        return false;
+    }
+
+    // Upload unique lighting/material blocks once for the whole list, then
+    // bin its lights for draws with many of them
+    return uploadLightingStates(drawList) && buildLightClusters(drawList);
+}
+
+bool MetalRenderer::Impl::executeCommands(const DrawList& drawList) {
+    // Linear walk over the packed stream; the position lets pass setup look
+    // ahead at what the rest of the list does with the attachments
+    const CommandStream& commands = drawList.getCommands();
+    const DrawList* previousList = executingList;
+    executingList = &drawList;
+    bool success = true;
+    for (size_t i = 0; i < commands.size() && success; ++i) {
+        executingIndex = i;
+        if (!executeCommand(commands[i], drawList)) {
+            METAL_LOG_ERROR(@"MetalRenderer: Command execution failed");
+            success = false;
+        }
+    }
+
+    // Deferred transparent draws read this list's streams
+    if (!resolveTransparency()) {
+        success = false;
+    }
+    executingList = previousList;
+    return success;
+}
+
+bool MetalRenderer::Impl::isParallelEncodable(const DrawList& drawList) {
+    // Sub-encoders share one render pass: no target switches, clears or
+    // compute (including the light cluster build)
+    if (needsLightClusters(drawList)) {
+        return false;
+    }
+    for (CommandRef cmd : drawList.getCommands()) {
+        if (cmd.type == CommandType::SetRenderTarget || cmd.type == CommandType::Clear ||
+            cmd.type == CommandType::DispatchCompute || cmd.type == CommandType::RenderShadowMap ||
+            cmd.type == CommandType::ReadbackTexture || cmd.type == CommandType::FilterTexture ||
+            cmd.type == CommandType::GenerateMipmaps || cmd.type == CommandType::ConvertYCbCr ||
+            cmd.type == CommandType::ConvertYCoCg || cmd.type == CommandType::CopyTexture ||
+            cmd.type == CommandType::PostProcess || isOrderIndependent(cmd)) {
+            return false;
+        }
+        if (cmd.type == CommandType::DrawDisplayList &&
+            !isParallelEncodable(*cmd.as<DrawDisplayListCommand>().displayList)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MetalRenderer::Impl::executeParallel(const DrawList* const* drawLists, size_t count) {
+    @autoreleasepool {
+        endCurrentEncoder();
+
+        MTLRenderPassDescriptor* renderPass = getCurrentRenderPassDescriptor();
+        if (!renderPass) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to get render pass for parallel encoding");
+            return false;
+        }
+
+        // Continuing a pass (e.g. after the main list's clear) keeps its contents
+        configureLoadStore(renderPass, false, false);
+
+        const bool timed = attachTimestamps(renderPass, currentPassName());
+        id<MTLParallelRenderCommandEncoder> parallelEncoder =
+            [currentCommandBuffer parallelRenderCommandEncoderWithDescriptor:renderPass];
+        if (timed) {
+            renderPass.sampleBufferAttachments[0].sampleBuffer = nil;
+        }
+        if (!parallelEncoder) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create parallel render encoder");
+            return false;
+        }
+
+        // Sub-encoders execute on the GPU in creation order, which is the
+        // caller's list order regardless of how the lists were recorded
+        bool success = true;
+        for (size_t i = 0; i < count && success; ++i) {
+            const DrawList& drawList = *drawLists[i];
+            frameCulledDraws += static_cast<uint32_t>(drawList.getCulledDrawCount());
+            if (drawList.getCommandCount() == 0) {
+                continue;
+            }
+            if (!uploadDrawList(drawList)) {
+                success = false;
+                break;
+            }
+
+            currentEncoder = [parallelEncoder renderCommandEncoder];
+            if (!currentEncoder) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create parallel sub-encoder");
+                success = false;
+                break;
+            }
+            encoderState = EncoderStateCache();
+            [currentEncoder setViewport:currentViewport];
+            if (scissorEnabled) {
+                [currentEncoder setScissorRect:currentScissor];
+            }
+            applyDepthState(depthTestEnabled);
+
+            success = executeCommands(drawList);
+            endCurrentEncoder();
+        }
+
+        [parallelEncoder endEncoding];
+        return success;
+    }
+}
+
+MTLRenderPassDescriptor* MetalRenderer::Impl::getCurrentRenderPassDescriptor() {
+    if (currentRenderPass) {
+        return currentRenderPass;
+    }
+
+    @autoreleasepool {
+        // Check if rendering to a custom render target (FBO) or the view
+        if (currentRenderTarget) {
+            // Create render pass for custom render target (FBO)
+            currentRenderPass = [MTLRenderPassDescriptor renderPassDescriptor];
+
+            // Set color attachment; multisampled targets draw into tile
+            // memory when no later encoder reloads the samples and resolve
+            // into the target in the same pass
+            currentRenderPass.colorAttachments[0].texture = currentRenderTarget;
+            currentRenderPass.colorAttachments[0].loadAction = MTLLoadActionLoad;
+            currentRenderPass.colorAttachments[0].storeAction = MTLStoreActionStore;
+            NSUInteger samples = 1;
+            if (targetSampleCount > 1) {
+                id<MTLTexture> msaaTexture = targetMultisampleTexture(
+                    currentRenderTarget, targetSampleCount, memorylessSupported && !targetReloads(false));
+                if (msaaTexture) {
+                    currentRenderPass.colorAttachments[0].texture = msaaTexture;
+                    currentRenderPass.colorAttachments[0].resolveTexture = currentRenderTarget;
+                    samples = targetSampleCount;
+                }
+            }
+
+            // Single-sampled targets with a rate draw at the map's physical size
+            RateTarget* rate = samples == 1 ? findRateTarget((__bridge void*)currentRenderTarget) : nullptr;
+            if (rate && prepareRateTarget(*rate, currentRenderTarget.pixelFormat, currentRenderTarget.width,
+                                          currentRenderTarget.height, MTLPixelFormatInvalid)) {
+                currentRenderPass.colorAttachments[0].texture = rate->physical;
+                currentRenderPass.rasterizationRateMap = rate->map;
+            }
+
+            // Depth that no later encoder reloads can stay in tile memory;
+            // load/store actions are set per encoder
+            id<MTLTexture> colorTexture = currentRenderPass.colorAttachments[0].texture;
+            const bool memoryless = memorylessSupported && !targetReloads(true);
+            id<MTLTexture> depthTexture = targetDepthTexture(colorTexture.width, colorTexture.height,
+                                                             samples, memoryless);
+            if (depthTexture) {
+                currentRenderPass.depthAttachment.texture = depthTexture;
+            }
+        } else {
+            // Get default render pass from view (render to screen)
+            currentRenderPass = frameRenderPass ? frameRenderPass : view.currentRenderPassDescriptor;
+            if (!currentRenderPass) {
+                METAL_LOG_ERROR(@"MetalRenderer: No render pass descriptor available");
+                return nil;
             }
+            if (MTLRenderPassDescriptor* ratePass = rateScreenPassDescriptor(currentRenderPass)) {
+                currentRenderPass = ratePass;
+            }
+        }
+
+        // Pipelines must match the pass attachments exactly
+        id<MTLTexture> colorTexture = currentRenderPass.colorAttachments[0].texture;
+        id<MTLTexture> depthTexture = currentRenderPass.depthAttachment.texture;
+        passColorFormat = colorTexture ? colorTexture.pixelFormat : view.colorPixelFormat;
+        passSampleCount = colorTexture ? colorTexture.sampleCount : 1;
+        passDepthFormat = depthTexture ? depthTexture.pixelFormat : MTLPixelFormatInvalid;
+        if (!currentRenderTarget) {
+            // The pyramid is built in screen pixels; rate-mapped depth is physical
+            screenDepthTexture = currentRenderPass.rasterizationRateMap ? nil : depthTexture;
         }
 
         return currentRenderPass;
@@ -786,31 +3071,180 @@ MTLRenderPassDescriptor* MetalRenderer::Impl::getCurrentRenderPassDescriptor() {
 // DrawList Execution
 // ============================================================================
 
-bool MetalRenderer::Impl::executeCommand(const DrawCommand& cmd, const DrawList& drawList) {
+bool MetalRenderer::Impl::executeCommand(const CommandRef& cmd, const DrawList& drawList) {
+    // Casters draw into the shadow map only; everything else in them is
+    // skipped (the object ID pass replays the same draws)
+    if ((shadowPassActive || objectIdPassActive) && !castsShadow(cmd.type)) {
+        return true;
+    }
+
+    // Order-independent draws wait for the end of the pass; anything that must
+    // draw over them composites them first
+    if (!shadowPassActive && !objectIdPassActive && !replayingTransparency) {
+        if (isOrderIndependent(cmd)) {
+            deferTransparentDraw(cmd);
+            return true;
+        }
+        if (!transparentDraws.empty() && !drawsUnderTransparency(cmd) && !resolveTransparency()) {
+            return false;
+        }
+    }
+
     switch (cmd.type) {
         case CommandType::Draw2D:
-            return executeDraw2D(cmd.draw2D, drawList);
+            return executeDraw2D(cmd.as<DrawCommand2D>(), drawList);
 
         case CommandType::Draw3D:
-            return executeDraw3D(cmd.draw3D, drawList);
+            return executeDraw3D(cmd.as<DrawCommand3D>(), drawList);
+
+        case CommandType::Draw3DInstanced: {
+            const DrawCommand3DInstanced& instanced = cmd.as<DrawCommand3DInstanced>();
+            InstancedDraw instancing;
+            instancing.instanceBuffer = (__bridge id<MTLBuffer>)instanced.instanceBuffer;
+            instancing.instanceOffset = instanced.instanceOffset;
+            instancing.instanceCount = instanced.instanceCount;
+            if (!instancing.instanceBuffer) {
+                // Records recorded into the list itself (DrawList::addInstances)
+                const size_t end = ((size_t)instanced.instanceOffset + instanced.instanceCount) *
+                                   sizeof(InstanceData);
+                if (!frameInstances || end > frameInstances.size) {
+                    METAL_LOG_ERROR(@"MetalRenderer: Instanced draw3D without instance data");
+                    return false;
+                }
+                instancing.instanceBuffer = (__bridge id<MTLBuffer>)frameInstances.buffer;
+                instancing.instanceBase = frameInstances.offset;
+            }
+            return executeDraw3D(instanced, drawList, &instancing);
+        }
+
+        case CommandType::DrawMeshPrimitives: {
+            const DrawMeshPrimitivesCommand& primitives = cmd.as<DrawMeshPrimitivesCommand>();
+            InstancedDraw instancing;
+            instancing.instanceBuffer = (__bridge id<MTLBuffer>)primitives.instanceBuffer;
+            instancing.instanceOffset = primitives.instanceOffset;
+            instancing.instanceCount = primitives.instanceCount;
+            instancing.meshPrimitives = &primitives;
+            if (!instancing.instanceBuffer) {
+                const size_t end = ((size_t)primitives.instanceOffset + primitives.instanceCount) *
+                                   sizeof(InstanceData);
+                if (!frameInstances || end > frameInstances.size) {
+                    METAL_LOG_ERROR(@"MetalRenderer: Mesh primitive draw without instance data");
+                    return false;
+                }
+                instancing.instanceBuffer = (__bridge id<MTLBuffer>)frameInstances.buffer;
+                instancing.instanceBase = frameInstances.offset;
+            }
+            return executeDraw3D(primitives, drawList, &instancing);
+        }
+
+        case CommandType::Draw3DIndirect: {
+            const DrawCommand3DIndirect& indirect = cmd.as<DrawCommand3DIndirect>();
+            InstancedDraw instancing;
+            instancing.instanceBuffer = (__bridge id<MTLBuffer>)indirect.instanceBuffer;
+            instancing.argumentBuffer = (__bridge id<MTLBuffer>)indirect.argumentBuffer;
+            instancing.argumentOffset = indirect.argumentOffset;
+            return executeDraw3D(indirect, drawList, &instancing);
+        }
+
+        case CommandType::Draw2DShapes: {
+            const DrawCommand2DShapes& shapes = cmd.as<DrawCommand2DShapes>();
+            Instanced2DDraw draw;
+            draw.name = "draw2D shapes";
+            draw.shader = PipelineShader::Shapes2D;
+            draw.records = &frameShapes;
+            draw.recordSize = sizeof(ShapeInstance2D);
+            draw.first = shapes.shapeOffset;
+            draw.count = shapes.shapeCount;
+            draw.verticesPerRecord = 4;     // One quad per shape
+            draw.primitive = MTLPrimitiveTypeTriangleStrip;
+            draw.blendMode = shapes.blendMode;
+            draw.transform = shapes.transform;
+            return executeDraw2DInstanced(draw);
+        }
+
+        case CommandType::Draw2DStroke: {
+            const DrawCommand2DStroke& stroke = cmd.as<DrawCommand2DStroke>();
+            Instanced2DDraw draw;
+            draw.name = "draw2D stroke";
+            draw.shader = PipelineShader::Stroke2D;
+            draw.records = &frameStrokes;
+            draw.recordSize = sizeof(StrokeSegment2D);
+            draw.first = stroke.segmentOffset;
+            draw.count = stroke.segmentCount;
+            draw.verticesPerRecord = kStrokeVerticesPerSegment;
+            draw.primitive = MTLPrimitiveTypeTriangle;
+            draw.blendMode = stroke.blendMode;
+            draw.transform = stroke.transform;
+            return executeDraw2DInstanced(draw);
+        }
+
+        case CommandType::Draw2DPaths: {
+            const DrawCommand2DPaths& paths = cmd.as<DrawCommand2DPaths>();
+            Instanced2DDraw draw;
+            draw.name = "draw2D paths";
+            draw.shader = PipelineShader::Path2D;
+            draw.records = &framePaths;
+            draw.recordSize = sizeof(PathInstance2D);
+            draw.fragmentRecords = &framePathSegments;
+            draw.first = paths.pathOffset;
+            draw.count = paths.pathCount;
+            draw.verticesPerRecord = 4;     // One quad per path
+            draw.primitive = MTLPrimitiveTypeTriangleStrip;
+            draw.blendMode = paths.blendMode;
+            draw.transform = paths.transform;
+            return executeDraw2DInstanced(draw);
+        }
+
+        case CommandType::DrawPointCloud:
+            return executeDrawPointCloud(cmd.as<DrawPointCloudCommand>());
+
+        case CommandType::DrawDisplayList:
+            return executeDisplayList(cmd.as<DrawDisplayListCommand>());
+
+        case CommandType::RenderShadowMap:
+            return executeRenderShadowMap(cmd.as<RenderShadowMapCommand>());
 
         case CommandType::SetViewport:
-            return executeSetViewport(cmd.viewport);
+            return executeSetViewport(cmd.as<SetViewportCommand>());
 
         case CommandType::SetScissor:
-            return executeSetScissor(cmd.scissor);
+            return executeSetScissor(cmd.as<SetScissorCommand>());
 
         case CommandType::Clear:
-            return executeClear(cmd.clear);
+            return executeClear(cmd.as<SetClearCommand>());
 
         case CommandType::SetRenderTarget:
-            return executeSetRenderTarget(cmd.renderTarget);
+            return executeSetRenderTarget(cmd.as<SetRenderTargetCommand>());
 
         case CommandType::SetCustomShader:
-            return executeSetCustomShader(cmd.customShader);
+            return executeSetCustomShader(cmd.as<SetCustomShaderCommand>());
+
+        case CommandType::DispatchCompute:
+            return executeDispatchCompute(cmd.as<DispatchComputeCommand>());
+
+        case CommandType::ReadbackTexture:
+            return executeReadbackTexture(cmd.as<ReadbackTextureCommand>());
+
+        case CommandType::FilterTexture:
+            return executeFilterTexture(cmd.as<FilterTextureCommand>());
+
+        case CommandType::GenerateMipmaps:
+            return executeGenerateMipmaps(cmd.as<GenerateMipmapsCommand>());
+
+        case CommandType::ConvertYCbCr:
+            return executeConvertYCbCr(cmd.as<ConvertYCbCrCommand>());
+
+        case CommandType::ConvertYCoCg:
+            return executeConvertYCoCg(cmd.as<ConvertYCoCgCommand>());
+
+        case CommandType::CopyTexture:
+            return executeCopyTexture(cmd.as<CopyTextureCommand>());
+
+        case CommandType::PostProcess:
+            return executePostProcess(cmd.as<PostProcessCommand>());
 
         default:
-            NSLog(@"MetalRenderer: Unknown command type %u", (uint32_t)cmd.type);
+            METAL_LOG_ERROR(@"MetalRenderer: Unknown command type %u", (uint32_t)cmd.type);
             return false;
     }
 }
@@ -821,13 +3255,13 @@ bool MetalRenderer::Impl::executeDraw2D(const DrawCommand2D& cmd, const DrawList
         if (!currentEncoder) {
             MTLRenderPassDescriptor* renderPass = getCurrentRenderPassDescriptor();
             if (!renderPass) {
-                NSLog(@"MetalRenderer: Failed to get render pass for draw2D");
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to get render pass for draw2D");
                 return false;
             }
 
-            currentEncoder = [currentCommandBuffer renderCommandEncoderWithDescriptor:renderPass];
+            currentEncoder = beginRenderEncoder(renderPass);
             if (!currentEncoder) {
-                NSLog(@"MetalRenderer: Failed to create render encoder for draw2D");
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create render encoder for draw2D");
                 return false;
             }
 
@@ -839,42 +3273,69 @@ bool MetalRenderer::Impl::executeDraw2D(const DrawCommand2D& cmd, const DrawList
             applyDepthState(depthTestEnabled);
         }
 
-        // Upload vertex data to buffer
-        const Vertex2D* vertices = drawList.getVertex2DData();
-        if (!vertices || cmd.vertexCount == 0) {
-            NSLog(@"MetalRenderer: No vertices to draw in draw2D");
+        // Validate vertex data (packed draws read the PackedVertex2D stream)
+        const bool packed = cmd.vertexFormat == VertexFormat::Packed;
+        const RingAllocation& vertexStream = packed ? framePacked2D : frameVertices2D;
+        if (!vertexStream || cmd.vertexCount == 0) {
+            METAL_LOG_ERROR(@"MetalRenderer: No vertices to draw in draw2D");
             return false;
         }
 
-        const size_t vertexDataSize = cmd.vertexCount * sizeof(Vertex2D);
-        const size_t bufferOffset = cmd.vertexOffset * sizeof(Vertex2D);
+        const size_t vertexStride = packed ? sizeof(PackedVertex2D) : sizeof(Vertex2D);
+        const size_t vertexDataSize = cmd.vertexCount * vertexStride;
+        const size_t bufferOffset = cmd.vertexOffset * vertexStride;
 
         // Check buffer bounds
-        if (bufferOffset + vertexDataSize > kMaxVertices2D * sizeof(Vertex2D)) {
-            NSLog(@"MetalRenderer: Vertex data exceeds buffer size in draw2D");
+        if (bufferOffset + vertexDataSize > vertexStream.size) {
+            METAL_LOG_ERROR(@"MetalRenderer: Vertex data exceeds buffer size in draw2D");
             return false;
         }
 
-        // Copy vertex data into current frame's buffer
-        id<MTLBuffer> currentBuffer = vertexBuffer2D[currentFrameIndex];
-        uint8_t* bufferPtr = (uint8_t*)[currentBuffer contents];
-        memcpy(bufferPtr + bufferOffset, vertices + cmd.vertexOffset, vertexDataSize);
+        // Vertex data is already in this frame's ring allocation (uploaded once in
+        // executeDrawList, or written in place through bindFrameStorage)
+        id<MTLBuffer> currentBuffer = (__bridge id<MTLBuffer>)vertexStream.buffer;
+
+        // Texture batches sample a bound texture array; custom shaders draw
+        // the ranges one by one
+        const TextureBatch2D* textureBatch = nullptr;
+        if (cmd.textureBatch != kInvalidTextureBatch) {
+            textureBatch = drawList.getTextureBatch(cmd.textureBatch);
+            if (!textureBatch || textureBatch->rangeCount == 0) {
+                METAL_LOG_ERROR(@"MetalRenderer: Invalid texture batch %u in draw2D", cmd.textureBatch);
+                return false;
+            }
+        }
+        bool textureArray = false;
 
-        // Set pipeline (use custom if set, otherwise select variant based on blend mode)
-        if (customPipelineState) {
-            [currentEncoder setRenderPipelineState:customPipelineState];
+        // Set pipeline (use custom if set, otherwise select variant based on blend mode).
+        // Custom shaders read Vertex2D; the only packed draws they meet are
+        // display list replays, which keep the built-in shaders
+        if (customPipelineState && !packed) {
+            bindPipeline(customPipelineState);
         } else {
-            uint32_t blendIndex = (uint32_t)cmd.blendMode;
-            if (blendIndex > 10) blendIndex = 1; // Default to Alpha if out of range
-            if (cmd.texture) {
-                [currentEncoder setRenderPipelineState:pipeline2DTextured[blendIndex]];
-            } else {
-                [currentEncoder setRenderPipelineState:pipeline2D[blendIndex]];
+            id<MTLRenderPipelineState> pipeline = nil;
+            if (textureBatch) {
+                pipeline = getPassPipeline(PipelineShader::TextureBatch2D, cmd.blendMode, cmd.vertexFormat);
+                textureArray = pipeline != nil;
+            }
+            if (!pipeline && cmd.texture && cmd.distanceField) {
+                // Without it (embedded shader source) the field draws as a
+                // soft alpha mask through the textured pipeline below
+                pipeline = getPassPipeline(PipelineShader::DistanceField2D, cmd.blendMode, cmd.vertexFormat);
+            }
+            if (!pipeline) {
+                pipeline = getPassPipeline(cmd.texture ? PipelineShader::Textured2D : PipelineShader::Solid2D,
+                                           cmd.blendMode, cmd.vertexFormat);
+            }
+            if (!pipeline) {
+                METAL_LOG_ERROR(@"MetalRenderer: No pipeline for draw2D (blend %d)", (int)cmd.blendMode);
+                return false;
             }
+            bindPipeline(pipeline);
         }
 
         // Set vertex buffer
-        [currentEncoder setVertexBuffer:currentBuffer offset:bufferOffset atIndex:0];
+        bindVertexBuffer(currentBuffer, vertexStream.offset + bufferOffset);
 
         // Set uniforms (projection + modelView matrices)
         struct Uniforms2D {
@@ -900,118 +3361,139 @@ bool MetalRenderer::Impl::executeDraw2D(const DrawCommand2D& cmd, const DrawList
         uniforms.projectionMatrix = projection;
         uniforms.modelViewMatrix = cmd.transform;
 
-        [currentEncoder setVertexBytes:&uniforms length:sizeof(Uniforms2D) atIndex:1];
+        bindVertexUniforms(&uniforms, sizeof(Uniforms2D));
 
-        // If custom shader, pass custom uniforms to fragment shader at buffer(2)
-        if (customPipelineState && !customUniformBuffer.empty()) {
-            [currentEncoder setFragmentBytes:customUniformBuffer.data()
-                                      length:customUniformBuffer.size()
-                                     atIndex:2];
+        // If custom shader, bind this draw's uniform snapshot at buffer(2)
+        if (customPipelineState && !packed && customUniformSize > 0 && frameUniforms &&
+            (size_t)customUniformOffset + customUniformSize <= frameUniforms.size) {
+            [currentEncoder setFragmentBuffer:(__bridge id<MTLBuffer>)frameUniforms.buffer
+                                       offset:frameUniforms.offset + customUniformOffset
+                                      atIndex:2];
+            encoderState.lightingHandle = kInvalidLightingHandle;  // buffer(2) overwritten
 
             // Bind custom textures
-            for (int i = 0; i < 16; i++) {
+            for (uint32_t i = 0; i < 16; i++) {
                 if (customTextures[i]) {
-                    [currentEncoder setFragmentTexture:customTextures[i] atIndex:i];
+                    bindFragmentTexture(customTextures[i], i);
                 }
             }
         }
 
         // Set texture if present
-        if (cmd.texture) {
-            id<MTLTexture> texture = (__bridge id<MTLTexture>)cmd.texture;
-            [currentEncoder setFragmentTexture:texture atIndex:0];
+        if (textureArray) {
+            // Matches TextureRanges2D in Basic2D.metal
+            struct TextureRanges2D {
+                uint32_t count;
+                uint32_t vertexEnd[TextureBatch2D::kMaxRanges];
+                uint32_t slot[TextureBatch2D::kMaxRanges];
+            } ranges;
+            ranges.count = textureBatch->rangeCount;
+            for (uint32_t i = 0; i < textureBatch->rangeCount; i++) {
+                ranges.vertexEnd[i] = textureBatch->vertexEnd[i];
+                ranges.slot[i] = textureBatch->slot[i];
+            }
+            [currentEncoder setVertexBytes:&ranges length:sizeof(ranges) atIndex:2];
 
-            // Create sampler state (linear filtering, clamp to edge)
-            MTLSamplerDescriptor* samplerDesc = [[MTLSamplerDescriptor alloc] init];
-            samplerDesc.minFilter = MTLSamplerMinMagFilterLinear;
-            samplerDesc.magFilter = MTLSamplerMinMagFilterLinear;
-            samplerDesc.sAddressMode = MTLSamplerAddressModeClampToEdge;
-            samplerDesc.tAddressMode = MTLSamplerAddressModeClampToEdge;
-            samplerDesc.mipFilter = MTLSamplerMipFilterNotMipmapped;
+            // Unused slots repeat slot 0 so the whole array is bound
+            for (uint32_t i = 0; i < TextureBatch2D::kMaxTextures; i++) {
+                void* texture = textureBatch->textures[i < textureBatch->textureCount ? i : 0];
+                bindFragmentTexture((__bridge id<MTLTexture>)texture, i);
+            }
+            bindFragmentSampler(getSamplerState(cmd.samplerKey));
+        } else if (cmd.texture) {
+            bindFragmentTexture((__bridge id<MTLTexture>)cmd.texture, 0);
 
-            id<MTLSamplerState> sampler = [device newSamplerStateWithDescriptor:samplerDesc];
-            [currentEncoder setFragmentSamplerState:sampler atIndex:0];
+            // Cached sampler for the command's filter/wrap selection
+            bindFragmentSampler(getSamplerState(cmd.samplerKey));
         }
 
         // Convert PrimitiveType to MTLPrimitiveType
-        MTLPrimitiveType mtlPrimitive;
-        switch (cmd.primitiveType) {
-            case PrimitiveType::Point:
-                mtlPrimitive = MTLPrimitiveTypePoint;
-                break;
-            case PrimitiveType::Line:
-                mtlPrimitive = MTLPrimitiveTypeLine;
-                break;
-            case PrimitiveType::LineStrip:
-                mtlPrimitive = MTLPrimitiveTypeLineStrip;
-                break;
-            case PrimitiveType::Triangle:
-                mtlPrimitive = MTLPrimitiveTypeTriangle;
-                break;
-            case PrimitiveType::TriangleStrip:
-                mtlPrimitive = MTLPrimitiveTypeTriangleStrip;
-                break;
-            default:
-                mtlPrimitive = MTLPrimitiveTypeTriangle;
-                break;
-        }
+        const MTLPrimitiveType mtlPrimitive = metalPrimitiveType(cmd.primitiveType);
 
         // Execute draw call
+        id<MTLBuffer> currentIndexBuffer = nil;
+        NSUInteger indexBufferOffset = 0;
+        MTLIndexType indexType = MTLIndexTypeUInt32;
+        size_t indexStride = sizeof(uint32_t);
         if (cmd.indexCount > 0) {
             // Indexed draw
             const uint32_t* indices = drawList.getIndexData();
             if (!indices) {
-                NSLog(@"MetalRenderer: No indices for indexed draw2D");
+                METAL_LOG_ERROR(@"MetalRenderer: No indices for indexed draw2D");
                 return false;
             }
 
-            const size_t indexDataSize = cmd.indexCount * sizeof(uint32_t);
-            const size_t indexBufferOffset = cmd.indexOffset * sizeof(uint32_t);
+            const IndexRange* range = currentIndexRange(drawList);
+            if (!range) {
+                METAL_LOG_ERROR(@"MetalRenderer: No index range for indexed draw2D");
+                return false;
+            }
+            indexType = (MTLIndexType)range->type;
+            indexStride = indexSize(range->type);
+            const size_t indexDataSize = cmd.indexCount * indexStride;
 
             // Check buffer bounds
-            if (indexBufferOffset + indexDataSize > kMaxIndices * sizeof(uint32_t)) {
-                NSLog(@"MetalRenderer: Index data exceeds buffer size in draw2D");
+            if (range->byteOffset + indexDataSize > frameIndices.size) {
+                METAL_LOG_ERROR(@"MetalRenderer: Index data exceeds buffer size in draw2D");
                 return false;
             }
 
-            // Copy index data into current frame's buffer
-            id<MTLBuffer> currentIndexBuffer = indexBuffer[currentFrameIndex];
-            uint8_t* indexBufferPtr = (uint8_t*)[currentIndexBuffer contents];
-            memcpy(indexBufferPtr + indexBufferOffset, indices + cmd.indexOffset, indexDataSize);
+            // Index data is already in this frame's ring allocation
+            currentIndexBuffer = (__bridge id<MTLBuffer>)frameIndices.buffer;
+            indexBufferOffset = frameIndices.offset + range->byteOffset;
+        }
 
-            [currentEncoder drawIndexedPrimitives:mtlPrimitive
-                                       indexCount:cmd.indexCount
-                                        indexType:MTLIndexTypeUInt32
-                                      indexBuffer:currentIndexBuffer
-                                indexBufferOffset:indexBufferOffset];
+        auto drawRange = [&](uint32_t vertexStart, uint32_t vertexCount,
+                             uint32_t indexStart, uint32_t indexCount) {
+            if (currentIndexBuffer) {
+                [currentEncoder drawIndexedPrimitives:mtlPrimitive
+                                           indexCount:indexCount
+                                            indexType:indexType
+                                          indexBuffer:currentIndexBuffer
+                                    indexBufferOffset:indexBufferOffset + indexStart * indexStride];
+            } else {
+                // Non-indexed draw
+                [currentEncoder drawPrimitives:mtlPrimitive
+                                   vertexStart:vertexStart
+                                   vertexCount:vertexCount];
+            }
+            frameDrawCalls++;
+        };
+
+        if (textureBatch && !textureArray) {
+            uint32_t vertexStart = 0;
+            uint32_t indexStart = 0;
+            for (uint32_t i = 0; i < textureBatch->rangeCount; i++) {
+                bindFragmentTexture((__bridge id<MTLTexture>)textureBatch->textures[textureBatch->slot[i]], 0);
+                drawRange(vertexStart, textureBatch->vertexEnd[i] - vertexStart,
+                          indexStart, textureBatch->indexEnd[i] - indexStart);
+                vertexStart = textureBatch->vertexEnd[i];
+                indexStart = textureBatch->indexEnd[i];
+            }
         } else {
-            // Non-indexed draw
-            [currentEncoder drawPrimitives:mtlPrimitive
-                               vertexStart:0
-                               vertexCount:cmd.vertexCount];
+            drawRange(0, cmd.vertexCount, 0, cmd.indexCount);
         }
 
         // Update statistics
-        frameDrawCalls++;
         frameVertices += cmd.vertexCount;
 
         return true;
     }
 }
 
-bool MetalRenderer::Impl::executeDraw3D(const DrawCommand3D& cmd, const DrawList& drawList) {
+bool MetalRenderer::Impl::executeDraw2DInstanced(const Instanced2DDraw& draw) {
     @autoreleasepool {
         // Ensure we have an encoder
         if (!currentEncoder) {
             MTLRenderPassDescriptor* renderPass = getCurrentRenderPassDescriptor();
             if (!renderPass) {
-                NSLog(@"MetalRenderer: Failed to get render pass for draw3D");
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to get render pass for %s", draw.name);
                 return false;
             }
 
-            currentEncoder = [currentCommandBuffer renderCommandEncoderWithDescriptor:renderPass];
+            currentEncoder = beginRenderEncoder(renderPass);
             if (!currentEncoder) {
-                NSLog(@"MetalRenderer: Failed to create render encoder for draw3D");
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create render encoder for %s", draw.name);
                 return false;
             }
 
@@ -1020,61 +3502,220 @@ bool MetalRenderer::Impl::executeDraw3D(const DrawCommand3D& cmd, const DrawList
             if (scissorEnabled) {
                 [currentEncoder setScissorRect:currentScissor];
             }
+            applyDepthState(depthTestEnabled);
         }
 
-        // Upload vertex data to buffer
-        const Vertex3D* vertices = drawList.getVertex3DData();
-        if (!vertices || cmd.vertexCount == 0) {
-            NSLog(@"MetalRenderer: No vertices to draw in draw3D");
+        // Records live in this frame's copy of one of the list's streams
+        const size_t end = ((size_t)draw.first + draw.count) * draw.recordSize;
+        if (!draw.records || end > draw.records->size) {
+            METAL_LOG_ERROR(@"MetalRenderer: Record data exceeds buffer size in %s", draw.name);
             return false;
         }
 
-        const size_t vertexDataSize = cmd.vertexCount * sizeof(Vertex3D);
-        const size_t bufferOffset = cmd.vertexOffset * sizeof(Vertex3D);
-
-        // Check buffer bounds
-        if (bufferOffset + vertexDataSize > kMaxVertices3D * sizeof(Vertex3D)) {
-            NSLog(@"MetalRenderer: Vertex data exceeds buffer size in draw3D");
+        // Custom shaders expect Vertex2D input, so these always use their own pipeline
+        id<MTLRenderPipelineState> pipeline = getPassPipeline(draw.shader, draw.blendMode);
+        if (!pipeline) {
+            METAL_LOG_ERROR(@"MetalRenderer: No pipeline for %s (blend %d)", draw.name, (int)draw.blendMode);
             return false;
         }
+        bindPipeline(pipeline);
+
+        bindVertexBuffer((__bridge id<MTLBuffer>)draw.records->buffer,
+                         draw.records->offset + draw.first * draw.recordSize);
+        if (draw.fragmentRecords) {
+            // Records index this stream from its start
+            if (!draw.fragmentRecords->buffer) {
+                METAL_LOG_ERROR(@"MetalRenderer: Missing fragment records in %s", draw.name);
+                return false;
+            }
+            [currentEncoder setFragmentBuffer:(__bridge id<MTLBuffer>)draw.fragmentRecords->buffer
+                                       offset:draw.fragmentRecords->offset
+                                      atIndex:0];
+        }
 
-        // Copy vertex data into current frame's buffer
-        id<MTLBuffer> currentBuffer = vertexBuffer3D[currentFrameIndex];
-        uint8_t* bufferPtr = (uint8_t*)[currentBuffer contents];
-        memcpy(bufferPtr + bufferOffset, vertices + cmd.vertexOffset, vertexDataSize);
+        // Same uniforms as executeDraw2D (matches Uniforms2D in Common.h)
+        struct Uniforms2D {
+            simd_float4x4 projectionMatrix;
+            simd_float4x4 modelViewMatrix;
+        };
 
-        // Use lighting state captured at command creation time
-        bool useLighting = cmd.useLighting;
-        int lightCount = cmd.lightCount;
+        float width = currentViewport.width;
+        float height = currentViewport.height;
+        simd_float4x4 projection = {
+            simd_make_float4(2.0f / width,  0.0f,            0.0f, 0.0f),
+            simd_make_float4(0.0f,         -2.0f / height,   0.0f, 0.0f),
+            simd_make_float4(0.0f,          0.0f,            1.0f, 0.0f),
+            simd_make_float4(-1.0f,         1.0f,            0.0f, 1.0f)
+        };
 
-        // Set pipeline (select variant based on blend mode and lighting)
-        uint32_t blendIndex = (uint32_t)cmd.blendMode;
-        if (blendIndex > 10) blendIndex = 1; // Default to Alpha if out of range
+        Uniforms2D uniforms;
+        uniforms.projectionMatrix = projection;
+        uniforms.modelViewMatrix = draw.transform;
+        bindVertexUniforms(&uniforms, sizeof(Uniforms2D));
+
+        // The vertex shader expands each record from vertex_id
+        [currentEncoder drawPrimitives:draw.primitive
+                           vertexStart:0
+                           vertexCount:draw.verticesPerRecord
+                         instanceCount:draw.count];
+        frameDrawCalls++;
+        frameVertices += draw.count * draw.verticesPerRecord;
 
-        if (useLighting) {
-            [currentEncoder setRenderPipelineState:pipeline3DLit[blendIndex]];
-        } else {
-            [currentEncoder setRenderPipelineState:pipeline3D[blendIndex]];
-        }
+        return true;
+    }
+}
 
-        // Set vertex buffer
-        [currentEncoder setVertexBuffer:currentBuffer offset:bufferOffset atIndex:0];
+bool MetalRenderer::Impl::executeDraw3D(const DrawCommand3D& cmd, const DrawList& drawList,
+                                        const InstancedDraw* instancing) {
+    @autoreleasepool {
+        // Ensure we have an encoder
+        if (!currentEncoder) {
+            MTLRenderPassDescriptor* renderPass = getCurrentRenderPassDescriptor();
+            if (!renderPass) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to get render pass for draw3D");
+                return false;
+            }
 
-        if (useLighting) {
-            // Lighting uniforms (matches LightingUniforms in Lighting.metal)
-            struct LightingUniforms {
-                simd_float4x4 projectionMatrix;
-                simd_float4x4 modelViewMatrix;
-                simd_float4x4 normalMatrix;
-                simd_float3 cameraPosition;
-                int numLights;
-                int lightingEnabled;
-                int smoothShading;
-            };
+            currentEncoder = beginRenderEncoder(renderPass);
+            if (!currentEncoder) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create render encoder for draw3D");
+                return false;
+            }
 
-            LightingUniforms uniforms;
-            uniforms.projectionMatrix = cmd.projectionMatrix;
-            uniforms.modelViewMatrix = cmd.modelViewMatrix;
+            // Apply current viewport and scissor state
+            [currentEncoder setViewport:currentViewport];
+            if (scissorEnabled) {
+                [currentEncoder setScissorRect:currentScissor];
+            }
+        }
+
+        // Validate vertex data (packed draws read the PackedVertex3D stream,
+        // resident draws the mesh's own buffer; mesh primitives have none)
+        const DrawMeshPrimitivesCommand* meshPrimitives = instancing ? instancing->meshPrimitives : nullptr;
+        const bool packed = cmd.vertexFormat == VertexFormat::Packed;
+        RingAllocation vertexStream = packed ? framePacked3D : frameVertices3D;
+        if (cmd.vertexBuffer) {
+            id<MTLBuffer> resident = (__bridge id<MTLBuffer>)cmd.vertexBuffer;
+            vertexStream = RingAllocation();
+            vertexStream.buffer = cmd.vertexBuffer;
+            vertexStream.size = resident.length;
+        }
+        if (!meshPrimitives && (!vertexStream || cmd.vertexCount == 0)) {
+            METAL_LOG_ERROR(@"MetalRenderer: No vertices to draw in draw3D");
+            return false;
+        }
+
+        const size_t vertexStride = packed ? sizeof(PackedVertex3D) : sizeof(Vertex3D);
+        const size_t vertexDataSize = cmd.vertexCount * vertexStride;
+        const size_t bufferOffset = cmd.vertexOffset * vertexStride;
+
+        // Check buffer bounds
+        if (bufferOffset + vertexDataSize > vertexStream.size) {
+            METAL_LOG_ERROR(@"MetalRenderer: Vertex data exceeds buffer size in draw3D");
+            return false;
+        }
+
+        // Vertex data is already in this frame's ring allocation (or resident)
+        id<MTLBuffer> currentBuffer = (__bridge id<MTLBuffer>)vertexStream.buffer;
+
+        // Use lighting state captured at command creation time (side table);
+        // shadow passes write depth only, the object ID pass IDs only
+        const LightingState* lighting = cmd.useLighting && !shadowPassActive && !objectIdPassActive
+            ? drawList.getLightingState(cmd.lightingHandle) : nullptr;
+        bool useLighting = (lighting != nullptr);
+        int lightCount = lighting ? lighting->lightCount : 0;
+
+        // Set pipeline (select variant based on blend mode, lighting and pass formats)
+        const bool perInstanceData = instancing && instancing->instanceBuffer;
+        PipelineShader shader;
+        if (meshPrimitives) {
+            // Never order-independent, so never in the transparency pass
+            if (shadowPassActive) {
+                shader = PipelineShader::ShadowDepthMeshPrimitive;
+            } else if (objectIdPassActive) {
+                shader = PipelineShader::ObjectIdMeshPrimitive3D;
+            } else {
+                shader = useLighting ? PipelineShader::LitMeshPrimitive3D : PipelineShader::MeshPrimitive3D;
+            }
+        } else if (shadowPassActive) {
+            shader = perInstanceData ? PipelineShader::ShadowDepthInstanced : PipelineShader::ShadowDepth;
+        } else if (objectIdPassActive) {
+            shader = perInstanceData ? PipelineShader::ObjectIdInstanced3D : PipelineShader::ObjectId3D;
+        } else if (transparencyPassActive) {
+            if (perInstanceData) {
+                shader = useLighting ? PipelineShader::LitTransparentInstanced3D : PipelineShader::TransparentInstanced3D;
+            } else {
+                shader = useLighting ? PipelineShader::LitTransparent3D : PipelineShader::Transparent3D;
+            }
+        } else if (perInstanceData) {
+            shader = useLighting ? PipelineShader::LitInstanced3D : PipelineShader::Instanced3D;
+        } else {
+            shader = useLighting ? PipelineShader::Lit3D : PipelineShader::Basic3D;
+        }
+        const BlendMode blendMode = shadowPassActive || objectIdPassActive ? BlendMode::Alpha : cmd.blendMode;
+        id<MTLRenderPipelineState> pipeline = getPassPipeline(shader, blendMode, cmd.vertexFormat);
+        if (!pipeline) {
+            METAL_LOG_ERROR(@"MetalRenderer: No pipeline for draw3D (shader %d, blend %d)", (int)shader, (int)cmd.blendMode);
+            return false;
+        }
+        bindPipeline(pipeline);
+
+        // Instance records at buffer(2) of the vertex stage (object and
+        // mesh stages for mesh primitives, which read no vertex buffer)
+        const NSUInteger instanceCount = instancing ? instancing->instanceCount : 1;
+        if (meshPrimitives) {
+            const NSUInteger offset = instancing->instanceBase + instancing->instanceOffset * sizeof(InstanceData);
+            [currentEncoder setObjectBuffer:instancing->instanceBuffer offset:offset atIndex:2];
+            [currentEncoder setMeshBuffer:instancing->instanceBuffer offset:offset atIndex:2];
+        } else {
+            bindVertexBuffer(currentBuffer, vertexStream.offset + bufferOffset);
+            if (perInstanceData) {
+                [currentEncoder setVertexBuffer:instancing->instanceBuffer
+                                         offset:instancing->instanceBase +
+                                                instancing->instanceOffset * sizeof(InstanceData)
+                                        atIndex:2];
+            }
+        }
+
+        // Matrices at buffer(1) of the geometry stages
+        auto bindGeometryUniforms = [&](const void* bytes, size_t length) {
+            if (meshPrimitives) {
+                [currentEncoder setObjectBytes:bytes length:length atIndex:1];
+                [currentEncoder setMeshBytes:bytes length:length atIndex:1];
+            } else {
+                bindVertexUniforms(bytes, length);
+            }
+        };
+
+        // Indirect draws are always indexed; counts come from the GPU
+        const bool indirectDraw = instancing && instancing->argumentBuffer;
+        if (indirectDraw && cmd.indexCount == 0) {
+            METAL_LOG_ERROR(@"MetalRenderer: Indirect draw3D requires indices");
+            return false;
+        }
+
+        if (useLighting) {
+            // Lighting uniforms (matches LightingUniforms in Lighting.metal)
+            struct LightingUniforms {
+                simd_float4x4 projectionMatrix;
+                simd_float4x4 modelViewMatrix;
+                simd_float4x4 normalMatrix;
+                simd_float3 cameraPosition;
+                int numLights;
+                int lightingEnabled;
+                int smoothShading;
+                int firstLight;
+                int clustered;
+                float clusterNear;
+                float clusterScale;
+            };
+            static_assert(sizeof(LightingUniforms) <= sizeof(EncoderStateCache::vertexUniforms),
+                          "LightingUniforms must fit the uniform cache");
+
+            LightingUniforms uniforms;
+            std::memset(&uniforms, 0, sizeof(uniforms));  // Padding is compared by bindVertexUniforms
+            uniforms.projectionMatrix = cmd.projectionMatrix;
+            uniforms.modelViewMatrix = cmd.modelViewMatrix;
 
             // Convert 3x3 normal matrix to 4x4
             simd_float4x4 normalMatrix4x4 = {
@@ -1088,20 +3729,61 @@ bool MetalRenderer::Impl::executeDraw3D(const DrawCommand3D& cmd, const DrawList
             uniforms.numLights = lightCount;
             uniforms.lightingEnabled = 1;
             uniforms.smoothShading = 1;  // Phong (smooth) shading
+            uniforms.firstLight = static_cast<int>(lighting->firstLight);
+
+            // Many lights: shade from the cluster lists built for this projection
+            const LightClusterGrid* grid = lightCount > kClusteredLightThreshold
+                ? findLightClusterGrid(*lighting, cmd.projectionMatrix) : nullptr;
+            const int gridIndex = grid ? static_cast<int>(grid - lightClusterGrids.data()) : -1;
+            if (grid) {
+                uniforms.clustered = 1;
+                uniforms.clusterNear = grid->nearZ;
+                uniforms.clusterScale = grid->scale;
+            }
 
-            [currentEncoder setVertexBytes:&uniforms length:sizeof(LightingUniforms) atIndex:1];
+            bindGeometryUniforms(&uniforms, sizeof(LightingUniforms));
 
             // Fragment shader also needs uniforms at buffer(1)
-            [currentEncoder setFragmentBytes:&uniforms length:sizeof(LightingUniforms) atIndex:1];
-
-            // Material data from command (captured at draw time) at buffer(2)
-            [currentEncoder setFragmentBytes:cmd.materialData length:13 * sizeof(float) atIndex:2];
-
-            // Light data from command (captured at draw time) at buffer(3)
-            // Each light is 22 floats (packed format)
-            if (lightCount > 0) {
-                size_t lightDataSize = lightCount * 22 * sizeof(float);
-                [currentEncoder setFragmentBytes:cmd.lightData length:lightDataSize atIndex:3];
+            bindFragmentUniforms(&uniforms, sizeof(LightingUniforms));
+
+            // Material (buffer 2), the light pool (buffer 3), the cluster
+            // lists (buffers 4 and 5) and the shadows (buffer 6, maps at
+            // textures 1-4) come from per-frame buffers; rebind only when the
+            // block or grid changes. Unclustered draws never read the lists,
+            // so the lighting buffer stands in for them.
+            if (cmd.lightingHandle == encoderState.lightingHandle &&
+                gridIndex == encoderState.lightClusterGrid) {
+                frameSkippedStateChanges += 5;
+            } else {
+                id<MTLBuffer> lights = lightingBuffer[currentFrameIndex];
+                const size_t blockOffset = lightingListOffset +
+                                           (size_t)cmd.lightingHandle * kLightingBlockStride;
+                [currentEncoder setFragmentBuffer:lights offset:blockOffset atIndex:2];
+                [currentEncoder setFragmentBuffer:lights offset:lightingLightsOffset atIndex:3];
+                [currentEncoder setFragmentBuffer:grid ? grid->buffer : lights
+                                           offset:grid ? grid->offset : 0
+                                          atIndex:4];
+                [currentEncoder setFragmentBuffer:grid ? grid->buffer : lights
+                                           offset:grid ? grid->offset + kClusterCountsBytes : 0
+                                          atIndex:5];
+
+                // Block 0 of the shadow region is empty; without shadow
+                // blocks in the list, zeroed uniforms are bound instead
+                const ShadowState* shadows = drawList.getShadowState(lighting->shadowHandle);
+                if (!drawList.getShadowStates().empty()) {
+                    const size_t shadowOffset = lightingShadowsOffset +
+                        (shadows ? (size_t)lighting->shadowHandle + 1 : 0) * kShadowBlockStride;
+                    [currentEncoder setFragmentBuffer:lights offset:shadowOffset atIndex:6];
+                } else {
+                    static const ShadowUniforms noShadows = {};
+                    [currentEncoder setFragmentBytes:&noShadows length:sizeof(noShadows) atIndex:6];
+                }
+                for (size_t i = 0; i < kMaxShadowLights; i++) {
+                    id<MTLTexture> map = shadows ? (__bridge id<MTLTexture>)shadows->shadowMaps[i] : nil;
+                    bindFragmentTexture(map ? map : getEmptyShadowMap(), static_cast<uint32_t>(1 + i));
+                }
+                encoderState.lightingHandle = cmd.lightingHandle;
+                encoderState.lightClusterGrid = gridIndex;
             }
         } else {
             // Standard 3D uniforms (no lighting)
@@ -1124,98 +3806,213 @@ bool MetalRenderer::Impl::executeDraw3D(const DrawCommand3D& cmd, const DrawList
             };
             uniforms.normalMatrix = normalMatrix4x4;
 
-            [currentEncoder setVertexBytes:&uniforms length:sizeof(Uniforms3D) atIndex:1];
+            bindGeometryUniforms(&uniforms, sizeof(Uniforms3D));
         }
 
-        // Apply depth state
-        applyDepthState(cmd.depthTestEnabled);
+        // Apply depth state (shadow maps always test and write depth;
+        // accumulated transparency tests against the opaque depth only)
+        if (transparencyPassActive) {
+            bindDepthStencilState(cmd.depthTestEnabled ? depthTestOnlyState : depthDisabledState);
+        } else {
+            applyDepthState(cmd.depthTestEnabled || shadowPassActive);
+        }
 
         // Apply culling mode
-        if (cmd.cullBackFace) {
-            [currentEncoder setCullMode:MTLCullModeBack];
-        } else {
-            [currentEncoder setCullMode:MTLCullModeNone];
+        bindCullMode(cmd.cullBackFace ? MTLCullModeBack : MTLCullModeNone);
+
+        // The object ID pass writes the draw's ID for every fragment
+        if (objectIdPassActive) {
+            [currentEncoder setFragmentBytes:&cmd.objectId length:sizeof(cmd.objectId) atIndex:0];
         }
 
         // Set texture if present
-        if (cmd.texture) {
-            id<MTLTexture> texture = (__bridge id<MTLTexture>)cmd.texture;
-            [currentEncoder setFragmentTexture:texture atIndex:0];
+        if (cmd.texture && !shadowPassActive && !objectIdPassActive) {
+            bindFragmentTexture((__bridge id<MTLTexture>)cmd.texture, 0);
 
-            // Create sampler state (linear filtering, clamp to edge)
-            MTLSamplerDescriptor* samplerDesc = [[MTLSamplerDescriptor alloc] init];
-            samplerDesc.minFilter = MTLSamplerMinMagFilterLinear;
-            samplerDesc.magFilter = MTLSamplerMinMagFilterLinear;
-            samplerDesc.sAddressMode = MTLSamplerAddressModeClampToEdge;
-            samplerDesc.tAddressMode = MTLSamplerAddressModeClampToEdge;
-            samplerDesc.mipFilter = MTLSamplerMipFilterNotMipmapped;
+            // Cached sampler for the command's filter/wrap selection
+            bindFragmentSampler(getSamplerState(cmd.samplerKey));
+        }
 
-            id<MTLSamplerState> sampler = [device newSamplerStateWithDescriptor:samplerDesc];
-            [currentEncoder setFragmentSamplerState:sampler atIndex:0];
+        // Mesh primitives: one object threadgroup per 32 meshlets of each
+        // instance; each visible meshlet becomes one mesh threadgroup
+        if (meshPrimitives) {
+            const MeshPrimitiveParams params = meshPrimitiveLayout(meshPrimitives->primitive,
+                                                                   meshPrimitives->resolution,
+                                                                   (float)currentViewport.width,
+                                                                   (float)currentViewport.height);
+            [currentEncoder setObjectBytes:&params length:sizeof(params) atIndex:3];
+            [currentEncoder setMeshBytes:&params length:sizeof(params) atIndex:3];
+            [currentEncoder drawMeshThreadgroups:MTLSizeMake((params.meshletCount + kMeshletsPerObject - 1) /
+                                                                 kMeshletsPerObject,
+                                                             instanceCount, 1)
+                     threadsPerObjectThreadgroup:MTLSizeMake(kMeshletsPerObject, 1, 1)
+                       threadsPerMeshThreadgroup:MTLSizeMake(kMeshletThreads, 1, 1)];
+            frameDrawCalls++;
+            return true;    // Vertex count is only known on the GPU
         }
 
         // Convert PrimitiveType to MTLPrimitiveType
-        MTLPrimitiveType mtlPrimitive;
-        switch (cmd.primitiveType) {
-            case PrimitiveType::Point:
-                mtlPrimitive = MTLPrimitiveTypePoint;
-                break;
-            case PrimitiveType::Line:
-                mtlPrimitive = MTLPrimitiveTypeLine;
-                break;
-            case PrimitiveType::LineStrip:
-                mtlPrimitive = MTLPrimitiveTypeLineStrip;
-                break;
-            case PrimitiveType::Triangle:
-                mtlPrimitive = MTLPrimitiveTypeTriangle;
-                break;
-            case PrimitiveType::TriangleStrip:
-                mtlPrimitive = MTLPrimitiveTypeTriangleStrip;
-                break;
-            default:
-                mtlPrimitive = MTLPrimitiveTypeTriangle;
-                break;
-        }
+        const MTLPrimitiveType mtlPrimitive = metalPrimitiveType(cmd.primitiveType);
 
         // Execute draw call
-        if (cmd.indexCount > 0) {
+        if (cmd.indexCount > 0 && cmd.vertexBuffer) {
+            // Indexed draw from the mesh's resident index buffer
+            id<MTLBuffer> residentIndices = (__bridge id<MTLBuffer>)cmd.indexBuffer;
+            const size_t indexBufferOffset = cmd.indexOffset * indexSize(cmd.indexType);
+            if (!residentIndices ||
+                indexBufferOffset + cmd.indexCount * indexSize(cmd.indexType) > residentIndices.length) {
+                METAL_LOG_ERROR(@"MetalRenderer: Index data exceeds resident buffer in draw3D");
+                return false;
+            }
+
+            if (indirectDraw) {
+                [currentEncoder drawIndexedPrimitives:mtlPrimitive
+                                            indexType:(MTLIndexType)cmd.indexType
+                                          indexBuffer:residentIndices
+                                    indexBufferOffset:indexBufferOffset
+                                       indirectBuffer:instancing->argumentBuffer
+                                 indirectBufferOffset:instancing->argumentOffset];
+                frameDrawCalls++;
+                return true;
+            }
+
+            [currentEncoder drawIndexedPrimitives:mtlPrimitive
+                                       indexCount:cmd.indexCount
+                                        indexType:(MTLIndexType)cmd.indexType
+                                      indexBuffer:residentIndices
+                                indexBufferOffset:indexBufferOffset
+                                    instanceCount:instanceCount];
+        } else if (cmd.indexCount > 0) {
             // Indexed draw
             const uint32_t* indices = drawList.getIndexData();
             if (!indices) {
-                NSLog(@"MetalRenderer: No indices for indexed draw3D");
+                METAL_LOG_ERROR(@"MetalRenderer: No indices for indexed draw3D");
                 return false;
             }
 
-            const size_t indexDataSize = cmd.indexCount * sizeof(uint32_t);
-            const size_t indexBufferOffset = cmd.indexOffset * sizeof(uint32_t);
+            const IndexRange* range = currentIndexRange(drawList);
+            if (!range) {
+                METAL_LOG_ERROR(@"MetalRenderer: No index range for indexed draw3D");
+                return false;
+            }
+            const MTLIndexType indexType = (MTLIndexType)range->type;
+            const size_t indexDataSize = cmd.indexCount * indexSize(range->type);
+            const size_t indexBufferOffset = range->byteOffset;
 
             // Check buffer bounds
-            if (indexBufferOffset + indexDataSize > kMaxIndices * sizeof(uint32_t)) {
-                NSLog(@"MetalRenderer: Index data exceeds buffer size in draw3D");
+            if (indexBufferOffset + indexDataSize > frameIndices.size) {
+                METAL_LOG_ERROR(@"MetalRenderer: Index data exceeds buffer size in draw3D");
                 return false;
             }
 
-            // Copy index data into current frame's buffer
-            id<MTLBuffer> currentIndexBuffer = indexBuffer[currentFrameIndex];
-            uint8_t* indexBufferPtr = (uint8_t*)[currentIndexBuffer contents];
-            memcpy(indexBufferPtr + indexBufferOffset, indices + cmd.indexOffset, indexDataSize);
+            // Index data is already in this frame's ring allocation
+            id<MTLBuffer> currentIndexBuffer = (__bridge id<MTLBuffer>)frameIndices.buffer;
+
+            if (indirectDraw) {
+                [currentEncoder drawIndexedPrimitives:mtlPrimitive
+                                            indexType:indexType
+                                          indexBuffer:currentIndexBuffer
+                                    indexBufferOffset:frameIndices.offset + indexBufferOffset
+                                       indirectBuffer:instancing->argumentBuffer
+                                 indirectBufferOffset:instancing->argumentOffset];
+                frameDrawCalls++;
+                return true;  // Vertex count is only known on the GPU
+            }
 
             [currentEncoder drawIndexedPrimitives:mtlPrimitive
                                        indexCount:cmd.indexCount
-                                        indexType:MTLIndexTypeUInt32
+                                        indexType:indexType
                                       indexBuffer:currentIndexBuffer
-                                indexBufferOffset:indexBufferOffset];
+                                indexBufferOffset:frameIndices.offset + indexBufferOffset
+                                    instanceCount:instanceCount];
         } else {
             // Non-indexed draw
             [currentEncoder drawPrimitives:mtlPrimitive
                                vertexStart:0
-                               vertexCount:cmd.vertexCount];
+                               vertexCount:cmd.vertexCount
+                             instanceCount:instanceCount];
         }
 
         // Update statistics
         frameDrawCalls++;
-        frameVertices += cmd.vertexCount;
+        frameVertices += cmd.vertexCount * (uint32_t)instanceCount;
+
+        return true;
+    }
+}
+
+bool MetalRenderer::Impl::executeDrawPointCloud(const DrawPointCloudCommand& cmd) {
+    @autoreleasepool {
+        // Ensure we have an encoder
+        if (!currentEncoder) {
+            MTLRenderPassDescriptor* renderPass = getCurrentRenderPassDescriptor();
+            if (!renderPass) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to get render pass for point cloud");
+                return false;
+            }
 
+            currentEncoder = beginRenderEncoder(renderPass);
+            if (!currentEncoder) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create render encoder for point cloud");
+                return false;
+            }
+
+            // Apply current viewport and scissor state
+            [currentEncoder setViewport:currentViewport];
+            if (scissorEnabled) {
+                [currentEncoder setScissorRect:currentScissor];
+            }
+        }
+
+        id<MTLBuffer> points = (__bridge id<MTLBuffer>)cmd.pointBuffer;
+        id<MTLBuffer> chunks = (__bridge id<MTLBuffer>)cmd.chunkBuffer;
+        const size_t end = (size_t)cmd.firstPoint + cmd.pointCount;
+        const size_t chunkEnd = (end + kPointCloudChunkSize - 1) / kPointCloudChunkSize;
+        if (end * sizeof(PointCloudPoint) > points.length || chunkEnd * sizeof(PointCloudChunk) > chunks.length) {
+            METAL_LOG_ERROR(@"MetalRenderer: Point range exceeds buffer size in point cloud");
+            return false;
+        }
+
+        id<MTLRenderPipelineState> pipeline = getPassPipeline(PipelineShader::PointCloud, cmd.blendMode);
+        if (!pipeline) {
+            METAL_LOG_ERROR(@"MetalRenderer: No pipeline for point cloud (blend %d)", (int)cmd.blendMode);
+            return false;
+        }
+        bindPipeline(pipeline);
+
+        // Records are indexed from the buffer start (vertex_id selects the chunk)
+        bindVertexBuffer(points, 0);
+        [currentEncoder setVertexBuffer:chunks offset:0 atIndex:2];
+
+        // Matches PointCloudUniforms in PointCloud.metal; the projected size
+        // of one unit at clip w = 1 is P[1][1] * half the viewport height
+        struct PointCloudUniforms {
+            simd_float4x4 projectionMatrix;
+            simd_float4x4 modelViewMatrix;
+            float pointSize;
+            float pixelScale;
+            float maxPointSize;
+            float padding;
+        };
+        PointCloudUniforms uniforms;
+        uniforms.projectionMatrix = cmd.projectionMatrix;
+        uniforms.modelViewMatrix = cmd.modelViewMatrix;
+        uniforms.pointSize = cmd.pointSize;
+        uniforms.pixelScale = cmd.sizeAttenuation
+            ? 0.5f * std::abs(cmd.projectionMatrix.columns[1].y) * (float)currentViewport.height
+            : 0.0f;
+        uniforms.maxPointSize = 511.0f;     // Apple GPU limit of [[point_size]]
+        uniforms.padding = 0.0f;
+        bindVertexUniforms(&uniforms, sizeof(PointCloudUniforms));
+
+        applyDepthState(cmd.depthTestEnabled);
+        bindCullMode(MTLCullModeNone);
+
+        [currentEncoder drawPrimitives:MTLPrimitiveTypePoint
+                           vertexStart:cmd.firstPoint
+                           vertexCount:cmd.pointCount];
+        frameDrawCalls++;
+        frameVertices += cmd.pointCount;
         return true;
     }
 }
@@ -1261,28 +4058,23 @@ bool MetalRenderer::Impl::executeClear(const SetClearCommand& cmd) {
             return false;
         }
 
-        // Configure clear operation
+        // Configure clear values; load actions follow from the clear flags
         if (cmd.clearData.clearColor) {
-            renderPass.colorAttachments[0].loadAction = MTLLoadActionClear;
             renderPass.colorAttachments[0].clearColor = MTLClearColorMake(
                 cmd.clearData.color.x,
                 cmd.clearData.color.y,
                 cmd.clearData.color.z,
                 cmd.clearData.color.w
             );
-        } else {
-            renderPass.colorAttachments[0].loadAction = MTLLoadActionLoad;
         }
-
         if (cmd.clearData.clearDepth && renderPass.depthAttachment.texture) {
-            renderPass.depthAttachment.loadAction = MTLLoadActionClear;
             renderPass.depthAttachment.clearDepth = cmd.clearData.depth;
         }
 
         // Create new encoder with clear
-        currentEncoder = [currentCommandBuffer renderCommandEncoderWithDescriptor:renderPass];
+        currentEncoder = beginRenderEncoder(renderPass, cmd.clearData.clearColor, cmd.clearData.clearDepth);
         if (!currentEncoder) {
-            NSLog(@"MetalRenderer: Failed to create render encoder for clear");
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create render encoder for clear");
             return false;
         }
 
@@ -1302,6 +4094,11 @@ bool MetalRenderer::Impl::executeSetRenderTarget(const SetRenderTargetCommand& c
         // End current encoder - switching render targets requires a new encoder
         endCurrentEncoder();
 
+        // The target being left is sampled from here on at full size
+        if (currentRenderTarget) {
+            resolveRasterizationRate((__bridge void*)currentRenderTarget);
+        }
+
         // Clear current render pass descriptor - will be recreated with new target
         currentRenderPass = nil;
 
@@ -1311,39 +4108,30 @@ bool MetalRenderer::Impl::executeSetRenderTarget(const SetRenderTargetCommand& c
             id<MTLTexture> targetTexture = (__bridge id<MTLTexture>)cmd.renderTarget;
             currentRenderTarget = targetTexture;
 
-            // Try to find or create a matching depth buffer
-            // For now, we'll check if there's a depth texture with matching dimensions
-            // This is a simplified approach; a full implementation would maintain
-            // a depth buffer pool or allow explicit depth buffer specification
+            // Unsupported sample counts fall back to plain rendering
+            targetSampleCount = cmd.sampleCount > 1 ? cmd.sampleCount : 1;
+            if (targetSampleCount > 1 && ![device supportsTextureSampleCount:targetSampleCount]) {
+                METAL_LOG_ERROR(@"MetalRenderer: %ux MSAA not supported, rendering without",
+                      (unsigned)targetSampleCount);
+                targetSampleCount = 1;
+            }
+            targetSamplesValid = false;
+
+            // Depth is shared by all targets of the same size and starts
+            // cleared on every begin(); the descriptor picks private or
+            // memoryless storage once it knows whether depth is reloaded
             NSUInteger width = targetTexture.width;
             NSUInteger height = targetTexture.height;
+            targetDepthValid = false;
 
-            // Check if we need to create a depth buffer
-            if (!depthTarget || depthTarget.width != width || depthTarget.height != height) {
-                // Create depth texture matching the render target dimensions
-                MTLTextureDescriptor* depthDesc = [MTLTextureDescriptor
-                    texture2DDescriptorWithPixelFormat:MTLPixelFormatDepth32Float
-                    width:width
-                    height:height
-                    mipmapped:NO];
-                depthDesc.usage = MTLTextureUsageRenderTarget;
-                depthDesc.storageMode = MTLStorageModePrivate;
-
-                depthTarget = [device newTextureWithDescriptor:depthDesc];
-                if (!depthTarget) {
-                    NSLog(@"MetalRenderer: Failed to create depth buffer for FBO");
-                    // Continue without depth buffer
-                }
-            }
-
-            NSLog(@"MetalRenderer: Switched to FBO render target (%lu x %lu)",
+            METAL_LOG_VERBOSE(@"MetalRenderer: Switched to FBO render target (%lu x %lu)",
                   (unsigned long)width, (unsigned long)height);
         } else {
             // Render to screen (default)
-            currentRenderTarget = nil;
-            depthTarget = nil;  // View provides its own depth buffer
+            currentRenderTarget = nil;  // View provides its own depth buffer
+            targetSampleCount = 1;
 
-            NSLog(@"MetalRenderer: Switched to screen render target");
+            METAL_LOG_VERBOSE(@"MetalRenderer: Switched to screen render target");
         }
 
         return true;
@@ -1356,11 +4144,9 @@ bool MetalRenderer::Impl::executeSetCustomShader(const SetCustomShaderCommand& c
             // Set custom pipeline state
             customPipelineState = (__bridge id<MTLRenderPipelineState>)cmd.pipelineState;
 
-            // Copy uniform data if provided
-            if (cmd.uniformData && cmd.uniformSize > 0) {
-                customUniformBuffer.resize(cmd.uniformSize);
-                std::memcpy(customUniformBuffer.data(), cmd.uniformData, cmd.uniformSize);
-            }
+            // The snapshot stays in the list's uniform stream; draws bind it by offset
+            customUniformOffset = cmd.uniformOffset;
+            customUniformSize = cmd.uniformSize;
 
             // Copy texture bindings
             for (int i = 0; i < 16; i++) {
@@ -1373,7 +4159,8 @@ bool MetalRenderer::Impl::executeSetCustomShader(const SetCustomShaderCommand& c
         } else {
             // Restore default pipeline
             customPipelineState = nil;
-            customUniformBuffer.clear();
+            customUniformOffset = 0;
+            customUniformSize = 0;
             for (int i = 0; i < 16; i++) {
                 customTextures[i] = nil;
             }
@@ -1384,115 +4171,2542 @@ bool MetalRenderer::Impl::executeSetCustomShader(const SetCustomShaderCommand& c
 }
 
 // ============================================================================
-// State Management
+// Display Lists
 // ============================================================================
 
-void MetalRenderer::Impl::applyBlendMode(BlendMode mode) {
-    currentBlendMode = mode;
-    // Blend mode is applied via pipeline state selection in executeDraw2D/3D
-    // No runtime state change needed - Metal requires blend state in PSO
+MetalRenderer::Impl::ResidentDisplayList*
+MetalRenderer::Impl::getResidentDisplayList(uint64_t listId, const DrawList& drawList) {
+    auto found = residentDisplayLists.find(listId);
+    if (found != residentDisplayLists.end()) {
+        found->second.lastUsedFrame = frameSerial;
+        return &found->second;
+    }
+
+    @autoreleasepool {
+        const CommandStream& commands = drawList.getCommands();
+        const uint32_t* indices = drawList.getIndexData();
+        const size_t indexCount = drawList.getIndexCount();
+
+        // Index ranges are laid out as uploadIndices() does, narrowed per command
+        ResidentDisplayList resident;
+        resident.indexRanges.assign(commands.size(), IndexRange());
+        size_t indexBytes = 0;
+        for (size_t i = 0; i < commands.size(); ++i) {
+            uint32_t offset, count, vertices;
+            if (!commandIndexRange(commands[i], offset, count, vertices)) {
+                continue;
+            }
+            if ((size_t)offset + count > indexCount) {
+                METAL_LOG_ERROR(@"MetalRenderer: Display list index range exceeds index data");
+                return nullptr;
+            }
+            IndexRange& range = resident.indexRanges[i];
+            range.type = indexTypeForVertexCount(vertices);
+            indexBytes = (indexBytes + 3) & ~size_t(3);
+            range.byteOffset = static_cast<uint32_t>(indexBytes);
+            indexBytes += (size_t)count * indexSize(range.type);
+        }
+
+        // One shared buffer holds every stream at aligned offsets
+        auto aligned = [](size_t bytes) {
+            return (bytes + kGeometryAlignment - 1) & ~(kGeometryAlignment - 1);
+        };
+        const size_t total = aligned(drawList.getVertex2DDataSize()) + aligned(drawList.getVertex3DDataSize()) +
+                             aligned(drawList.getPackedVertex2DDataSize()) +
+                             aligned(drawList.getPackedVertex3DDataSize()) + aligned(indexBytes) + aligned(drawList.getInstanceDataSize()) +
+                             aligned(drawList.getShapeDataSize()) + aligned(drawList.getStrokeSegmentDataSize()) +
+                             aligned(drawList.getPathDataSize()) + aligned(drawList.getPathSegmentDataSize()) +
+                             aligned(drawList.getUniformDataSize());
+        if (total > 0) {
+            resident.buffer = makeTrackedBuffer(device, total, MTLResourceStorageModeShared,
+                                                oflike::ofGpuMemoryCategory::Meshes, "DisplayList");
+            if (!resident.buffer) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create display list buffer (%zu bytes)", total);
+                return nullptr;
+            }
+            resident.buffer.label = [NSString stringWithFormat:@"DisplayList_%llu", (unsigned long long)listId];
+        }
+
+        uint8_t* base = resident.buffer ? (uint8_t*)[resident.buffer contents] : nullptr;
+        size_t cursor = 0;
+        auto place = [&](RingAllocation& target, size_t size) -> uint8_t* {
+            if (size == 0) {
+                return nullptr;
+            }
+            target.buffer = (__bridge void*)resident.buffer;
+            target.offset = cursor;
+            target.contents = base + cursor;
+            target.size = size;
+            cursor += aligned(size);
+            return (uint8_t*)target.contents;
+        };
+        auto copy = [&](RingAllocation& target, const void* data, size_t size) {
+            if (uint8_t* dst = place(target, size)) {
+                std::memcpy(dst, data, size);
+            }
+        };
+        copy(resident.vertices2D, drawList.getVertex2DData(), drawList.getVertex2DDataSize());
+        copy(resident.vertices3D, drawList.getVertex3DData(), drawList.getVertex3DDataSize());
+        copy(resident.packed2D, drawList.getPackedVertex2DData(), drawList.getPackedVertex2DDataSize());
+        copy(resident.packed3D, drawList.getPackedVertex3DData(), drawList.getPackedVertex3DDataSize());
+        copy(resident.instances, drawList.getInstanceData(), drawList.getInstanceDataSize());
+        copy(resident.shapes, drawList.getShapeData(), drawList.getShapeDataSize());
+        copy(resident.strokes, drawList.getStrokeSegmentData(), drawList.getStrokeSegmentDataSize());
+        copy(resident.paths, drawList.getPathData(), drawList.getPathDataSize());
+        copy(resident.pathSegments, drawList.getPathSegmentData(), drawList.getPathSegmentDataSize());
+        copy(resident.uniforms, drawList.getUniformData(), drawList.getUniformDataSize());
+
+        if (uint8_t* dst = place(resident.indices, indexBytes)) {
+            for (size_t i = 0; i < commands.size(); ++i) {
+                uint32_t offset, count, vertices;
+                if (!commandIndexRange(commands[i], offset, count, vertices)) {
+                    continue;
+                }
+                const IndexRange& range = resident.indexRanges[i];
+                const uint32_t* src = indices + offset;
+                if (range.type == IndexType::UInt16) {
+                    uint16_t* out = (uint16_t*)(dst + range.byteOffset);
+                    for (uint32_t k = 0; k < count; ++k) {
+                        out[k] = (uint16_t)src[k];
+                    }
+                } else {
+                    std::memcpy(dst + range.byteOffset, src, (size_t)count * sizeof(uint32_t));
+                }
+            }
+        }
+
+        resident.lastUsedFrame = frameSerial;
+        return &residentDisplayLists.emplace(listId, std::move(resident)).first->second;
+    }
 }
 
-void MetalRenderer::Impl::applyDepthState(bool enabled) {
-    depthTestEnabled = enabled;
-    if (currentEncoder) {
-        if (enabled) {
-            [currentEncoder setDepthStencilState:depthEnabledState];
-        } else {
-            [currentEncoder setDepthStencilState:depthDisabledState];
+bool MetalRenderer::Impl::executeDisplayList(const DrawDisplayListCommand& cmd) {
+    if (displayListDepth >= kMaxDisplayListDepth) {
+        METAL_LOG_ERROR(@"MetalRenderer: Display lists nested too deeply");
+        return false;
+    }
+    // Each list's deferred transparent draws read its own streams
+    if (!resolveTransparency()) {
+        return false;
+    }
+    const DrawList& drawList = *cmd.displayList;
+    ResidentDisplayList* resident = getResidentDisplayList(cmd.listId, drawList);
+    if (!resident) {
+        return false;
+    }
+
+    // Static unlit scenes execute their pre-encoded commands; shadow,
+    // transparency and object ID passes draw with their own pipelines
+    if (!resident->retainedChecked) {
+        resident->retainedChecked = true;
+        resident->retainedEligible = isRetainable(drawList);
+    }
+    if (resident->retainedEligible && !shadowPassActive && !objectIdPassActive && !replayingTransparency &&
+        resident->retainedFrame != frameSerial) {
+        return executeRetainedDisplayList(cmd, *resident);
+    }
+
+    // Lighting blocks are a few KB and are appended per replay; the
+    // executing list's blocks and cluster grids stay where they are. The
+    // replay draws under its own projection, so its grids are built for it.
+    const size_t previousLightingOffset = lightingListOffset;
+    const size_t previousLightsOffset = lightingLightsOffset;
+    const size_t previousShadowsOffset = lightingShadowsOffset;
+    std::vector<LightClusterGrid> previousGrids;
+    previousGrids.swap(lightClusterGrids);
+    if (!uploadLightingStates(drawList) || !buildLightClusters(drawList, &cmd.projectionMatrix)) {
+        lightingListOffset = previousLightingOffset;
+        lightingLightsOffset = previousLightsOffset;
+        lightingShadowsOffset = previousShadowsOffset;
+        lightClusterGrids.swap(previousGrids);
+        return false;
+    }
+
+    // Execute the recorded commands against the resident streams
+    const RingAllocation previousStreams[11] = {
+        frameVertices2D, frameVertices3D, framePacked2D, framePacked3D,
+        frameIndices, frameInstances, frameShapes, frameStrokes,
+        framePaths, framePathSegments, frameUniforms
+    };
+    frameVertices2D = resident->vertices2D;
+    frameVertices3D = resident->vertices3D;
+    framePacked2D = resident->packed2D;
+    framePacked3D = resident->packed3D;
+    frameIndices = resident->indices;
+    frameInstances = resident->instances;
+    frameShapes = resident->shapes;
+    frameStrokes = resident->strokes;
+    framePaths = resident->paths;
+    framePathSegments = resident->pathSegments;
+    frameUniforms = resident->uniforms;
+    indexRanges.swap(resident->indexRanges);
+
+    // Lookahead past the end of the recorded list can't see the rest of the
+    // executing list, so assume more work follows
+    const DrawList* previousList = executingList;
+    const size_t previousIndex = executingIndex;
+    const bool previousFollow = listsFollow;
+    executingList = &drawList;
+    listsFollow = true;
+
+    const simd_float3x3 normalTransform = simd_transpose(simd_inverse(upperLeft3x3(cmd.transform3D)));
+    auto replay2D = [&](auto draw) {
+        draw.transform = simd_mul(cmd.transform2D, draw.transform);
+        return executeCommand(CommandRef{draw.type, &draw}, drawList);
+    };
+    auto replay3D = [&](auto draw) {
+        draw.modelViewMatrix = simd_mul(cmd.transform3D, draw.modelViewMatrix);
+        draw.normalMatrix = simd_mul(normalTransform, draw.normalMatrix);
+        draw.projectionMatrix = cmd.projectionMatrix;
+        return executeCommand(CommandRef{draw.type, &draw}, drawList);
+    };
+
+    const CommandStream& commands = drawList.getCommands();
+    bool success = true;
+    displayListDepth++;
+    for (size_t i = 0; i < commands.size() && success; ++i) {
+        executingIndex = i;
+        CommandRef recorded = commands[i];
+        switch (recorded.type) {
+            case CommandType::Draw2D:
+                success = replay2D(recorded.as<DrawCommand2D>());
+                break;
+            case CommandType::Draw2DShapes:
+                success = replay2D(recorded.as<DrawCommand2DShapes>());
+                break;
+            case CommandType::Draw2DStroke:
+                success = replay2D(recorded.as<DrawCommand2DStroke>());
+                break;
+            case CommandType::Draw2DPaths:
+                success = replay2D(recorded.as<DrawCommand2DPaths>());
+                break;
+            case CommandType::Draw3D:
+                success = replay3D(recorded.as<DrawCommand3D>());
+                break;
+            case CommandType::Draw3DInstanced:
+                success = replay3D(recorded.as<DrawCommand3DInstanced>());
+                break;
+            case CommandType::Draw3DIndirect:
+                success = replay3D(recorded.as<DrawCommand3DIndirect>());
+                break;
+            case CommandType::DrawPointCloud: {
+                DrawPointCloudCommand draw = recorded.as<DrawPointCloudCommand>();
+                draw.modelViewMatrix = simd_mul(cmd.transform3D, draw.modelViewMatrix);
+                draw.projectionMatrix = cmd.projectionMatrix;
+                success = executeCommand(CommandRef{draw.type, &draw}, drawList);
+                break;
+            }
+            case CommandType::DrawDisplayList: {
+                // Nested lists compose with this replay's transforms
+                DrawDisplayListCommand nested = recorded.as<DrawDisplayListCommand>();
+                nested.transform2D = simd_mul(cmd.transform2D, nested.transform2D);
+                nested.transform3D = simd_mul(cmd.transform3D, nested.transform3D);
+                nested.projectionMatrix = cmd.projectionMatrix;
+                success = executeDisplayList(nested);
+                break;
+            }
+            default:
+                success = executeCommand(recorded, drawList);
+                break;
         }
     }
+    if (!resolveTransparency()) {
+        success = false;
+    }
+    displayListDepth--;
+    if (!success) {
+        METAL_LOG_ERROR(@"MetalRenderer: Display list command execution failed");
+    }
+
+    indexRanges.swap(resident->indexRanges);
+    frameVertices2D = previousStreams[0];
+    frameVertices3D = previousStreams[1];
+    framePacked2D = previousStreams[2];
+    framePacked3D = previousStreams[3];
+    frameIndices = previousStreams[4];
+    frameInstances = previousStreams[5];
+    frameShapes = previousStreams[6];
+    frameStrokes = previousStreams[7];
+    framePaths = previousStreams[8];
+    framePathSegments = previousStreams[9];
+    frameUniforms = previousStreams[10];
+    executingList = previousList;
+    executingIndex = previousIndex;
+    listsFollow = previousFollow;
+
+    // Handles of the executing list index its own blocks again
+    lightingListOffset = previousLightingOffset;
+    lightingLightsOffset = previousLightsOffset;
+    lightingShadowsOffset = previousShadowsOffset;
+    lightClusterGrids.swap(previousGrids);
+    encoderState.lightingHandle = kInvalidLightingHandle;
+    return success;
 }
 
 // ============================================================================
-// MetalRenderer Public Interface
+// Retained Display Lists (indirect command buffers)
 // ============================================================================
 
-MetalRenderer::MetalRenderer(void* device, void* view)
-    : impl_(std::make_unique<Impl>(device, view))
-{}
+bool MetalRenderer::Impl::isRetainable(const DrawList& drawList) {
+    // Draws whose whole state can be encoded once: no lighting (cluster grids
+    // and blocks are per frame), textures (not settable in an indirect
+    // command) or programmable blending, and one depth/cull state, which the
+    // commands inherit from the encoder
+    const CommandStream& commands = drawList.getCommands();
+    if (commands.size() < kMinRetainedDraws) {
+        return false;
+    }
+    const DrawCommand3D* first = nullptr;
+    for (CommandRef cmd : commands) {
+        if (cmd.type != CommandType::Draw3D && cmd.type != CommandType::Draw3DInstanced) {
+            return false;
+        }
+        const DrawCommand3D& draw = cmd.as<DrawCommand3D>();
+        if (draw.useLighting || draw.texture || draw.orderIndependent || draw.blendMode >= BlendMode::Overlay ||
+            draw.vertexCount == 0 || (draw.indexCount > 0 && draw.vertexBuffer && !draw.indexBuffer)) {
+            return false;
+        }
+        if (cmd.type == CommandType::Draw3DInstanced && cmd.as<DrawCommand3DInstanced>().instanceCount == 0) {
+            return false;
+        }
+        if (!first) {
+            first = &draw;
+        } else if (draw.depthTestEnabled != first->depthTestEnabled || draw.cullBackFace != first->cullBackFace) {
+            return false;
+        }
+    }
+    return true;
+}
 
-MetalRenderer::~MetalRenderer() = default;
+bool MetalRenderer::Impl::encodeRetainedCommands(ResidentDisplayList& resident, const DrawList& drawList) {
+    @autoreleasepool {
+        const CommandStream& commands = drawList.getCommands();
+        const size_t count = commands.size();
+        if (!resident.retainedUniforms) {
+            // Recorded uniforms, then one replay slot per frame in flight
+            const size_t size = (count + kMaxFramesInFlight) * kRetainedUniformStride;
+            resident.retainedUniforms = makeTrackedBuffer(device, size, MTLResourceStorageModeShared,
+                                                          oflike::ofGpuMemoryCategory::Meshes, "RetainedUniforms");
+            if (!resident.retainedUniforms) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create retained uniforms (%zu bytes)", size);
+                return false;
+            }
+
+            struct Uniforms3D {
+                simd_float4x4 projectionMatrix;
+                simd_float4x4 modelViewMatrix;
+                simd_float4x4 normalMatrix;
+            };
+            uint8_t* base = (uint8_t*)[resident.retainedUniforms contents];
+            resident.retainedResources.clear();
+            resident.retainedResources.push_back(resident.retainedUniforms);
+            if (resident.buffer) {
+                resident.retainedResources.push_back(resident.buffer);
+            }
+            resident.retainedVertices = 0;
+            for (size_t i = 0; i < count; ++i) {
+                const DrawCommand3D& draw = commands[i].as<DrawCommand3D>();
+                Uniforms3D uniforms;
+                uniforms.projectionMatrix = draw.projectionMatrix;
+                uniforms.modelViewMatrix = draw.modelViewMatrix;
+                uniforms.normalMatrix = simd_matrix(simd_make_float4(draw.normalMatrix.columns[0], 0.0f),
+                                                    simd_make_float4(draw.normalMatrix.columns[1], 0.0f),
+                                                    simd_make_float4(draw.normalMatrix.columns[2], 0.0f),
+                                                    simd_make_float4(0.0f, 0.0f, 0.0f, 1.0f));
+                std::memcpy(base + i * kRetainedUniformStride, &uniforms, sizeof(uniforms));
+
+                // Mesh and instance buffers outside the list are read in place
+                for (void* external : {draw.vertexBuffer, draw.indexBuffer,
+                                       commands[i].type == CommandType::Draw3DInstanced
+                                           ? commands[i].as<DrawCommand3DInstanced>().instanceBuffer
+                                           : nullptr}) {
+                    if (external) {
+                        resident.retainedResources.push_back((__bridge id<MTLBuffer>)external);
+                    }
+                }
+                resident.retainedVertices += draw.vertexCount;
+            }
+            resident.retainedDraws = count;
+        }
+
+        // One command buffer per frame slot, so each replay slot's transform
+        // is written while the GPU may still read the other frames'
+        const uint64_t passKey = (uint64_t)passColorFormat | ((uint64_t)passDepthFormat << 16) |
+                                 ((uint64_t)passSampleCount << 32);
+        id<MTLIndirectCommandBuffer>& icb = resident.retainedCommands[currentFrameIndex];
+        if (icb && resident.retainedPassKey[currentFrameIndex] == passKey) {
+            return true;
+        }
+
+        MTLIndirectCommandBufferDescriptor* desc = [[MTLIndirectCommandBufferDescriptor alloc] init];
+        desc.commandTypes = MTLIndirectCommandTypeDraw | MTLIndirectCommandTypeDrawIndexed;
+        desc.inheritPipelineState = NO;
+        desc.inheritBuffers = NO;
+        desc.maxVertexBufferBindCount = 4;      // Vertices, uniforms, instances, replay
+        desc.maxFragmentBufferBindCount = 0;
+        icb = [device newIndirectCommandBufferWithDescriptor:desc
+                                             maxCommandCount:count
+                                                     options:MTLResourceStorageModeShared];
+        if (!icb) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create indirect command buffer (%zu draws)", count);
+            return false;
+        }
+        icb.label = [NSString stringWithFormat:@"RetainedDisplayList_%u", currentFrameIndex];
+        resident.retainedPassKey[currentFrameIndex] = passKey;
+
+        const NSUInteger replayOffset = (count + currentFrameIndex) * kRetainedUniformStride;
+        for (size_t i = 0; i < count; ++i) {
+            CommandRef ref = commands[i];
+            const DrawCommand3D& draw = ref.as<DrawCommand3D>();
+            const bool packed = draw.vertexFormat == VertexFormat::Packed;
+
+            // Instance records: the mesh's own buffer or the list's stream
+            id<MTLBuffer> instanceBuffer = nil;
+            NSUInteger instanceOffset = 0;
+            NSUInteger instanceCount = 1;
+            if (ref.type == CommandType::Draw3DInstanced) {
+                const DrawCommand3DInstanced& instanced = ref.as<DrawCommand3DInstanced>();
+                instanceCount = instanced.instanceCount;
+                if (instanced.instanceBuffer) {
+                    instanceBuffer = (__bridge id<MTLBuffer>)instanced.instanceBuffer;
+                    instanceOffset = instanced.instanceOffset * sizeof(InstanceData);
+                } else {
+                    const size_t end = ((size_t)instanced.instanceOffset + instanced.instanceCount) *
+                                       sizeof(InstanceData);
+                    if (!resident.instances || end > resident.instances.size) {
+                        METAL_LOG_ERROR(@"MetalRenderer: Retained draw without instance data");
+                        return false;
+                    }
+                    instanceBuffer = (__bridge id<MTLBuffer>)resident.instances.buffer;
+                    instanceOffset = resident.instances.offset + instanced.instanceOffset * sizeof(InstanceData);
+                }
+            }
+
+            const PipelineShader shader = instanceBuffer ? PipelineShader::RetainedInstanced3D
+                                                         : PipelineShader::Retained3D;
+            id<MTLRenderPipelineState> pipeline = getPassPipeline(shader, draw.blendMode, draw.vertexFormat);
+            if (!pipeline) {
+                METAL_LOG_ERROR(@"MetalRenderer: No retained pipeline (blend %d)", (int)draw.blendMode);
+                return false;
+            }
+
+            // Vertices: the mesh's resident buffer or the list's stream
+            const size_t vertexStride = packed ? sizeof(PackedVertex3D) : sizeof(Vertex3D);
+            RingAllocation vertexStream = packed ? resident.packed3D : resident.vertices3D;
+            if (draw.vertexBuffer) {
+                vertexStream = RingAllocation();
+                vertexStream.buffer = draw.vertexBuffer;
+                vertexStream.size = ((__bridge id<MTLBuffer>)draw.vertexBuffer).length;
+            }
+            const size_t vertexOffset = (size_t)draw.vertexOffset * vertexStride;
+            if (!vertexStream || vertexOffset + (size_t)draw.vertexCount * vertexStride > vertexStream.size) {
+                METAL_LOG_ERROR(@"MetalRenderer: Retained draw exceeds its vertex data");
+                return false;
+            }
+
+            id<MTLIndirectRenderCommand> command = [icb indirectRenderCommandAtIndex:i];
+            [command setRenderPipelineState:pipeline];
+            [command setVertexBuffer:(__bridge id<MTLBuffer>)vertexStream.buffer
+                              offset:vertexStream.offset + vertexOffset
+                             atIndex:0];
+            [command setVertexBuffer:resident.retainedUniforms offset:i * kRetainedUniformStride atIndex:1];
+            if (instanceBuffer) {
+                [command setVertexBuffer:instanceBuffer offset:instanceOffset atIndex:2];
+            }
+            [command setVertexBuffer:resident.retainedUniforms offset:replayOffset atIndex:3];
+
+            const MTLPrimitiveType primitive = metalPrimitiveType(draw.primitiveType);
+            if (draw.indexCount > 0 && draw.vertexBuffer) {
+                id<MTLBuffer> indices = (__bridge id<MTLBuffer>)draw.indexBuffer;
+                const size_t indexOffset = (size_t)draw.indexOffset * indexSize(draw.indexType);
+                if (indexOffset + (size_t)draw.indexCount * indexSize(draw.indexType) > indices.length) {
+                    METAL_LOG_ERROR(@"MetalRenderer: Retained draw exceeds its index buffer");
+                    return false;
+                }
+                [command drawIndexedPrimitives:primitive
+                                    indexCount:draw.indexCount
+                                     indexType:(MTLIndexType)draw.indexType
+                                   indexBuffer:indices
+                             indexBufferOffset:indexOffset
+                                 instanceCount:instanceCount
+                                    baseVertex:0
+                                  baseInstance:0];
+            } else if (draw.indexCount > 0) {
+                const IndexRange& range = resident.indexRanges[i];
+                if (!resident.indices ||
+                    range.byteOffset + (size_t)draw.indexCount * indexSize(range.type) > resident.indices.size) {
+                    METAL_LOG_ERROR(@"MetalRenderer: Retained draw exceeds its index data");
+                    return false;
+                }
+                [command drawIndexedPrimitives:primitive
+                                    indexCount:draw.indexCount
+                                     indexType:(MTLIndexType)range.type
+                                   indexBuffer:(__bridge id<MTLBuffer>)resident.indices.buffer
+                             indexBufferOffset:resident.indices.offset + range.byteOffset
+                                 instanceCount:instanceCount
+                                    baseVertex:0
+                                  baseInstance:0];
+            } else {
+                [command drawPrimitives:primitive
+                            vertexStart:0
+                            vertexCount:draw.vertexCount
+                          instanceCount:instanceCount
+                           baseInstance:0];
+            }
+        }
+        return true;
+    }
+}
+
+bool MetalRenderer::Impl::executeRetainedDisplayList(const DrawDisplayListCommand& cmd,
+                                                     ResidentDisplayList& resident) {
+    @autoreleasepool {
+        if (!currentEncoder) {
+            MTLRenderPassDescriptor* renderPass = getCurrentRenderPassDescriptor();
+            if (!renderPass) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to get render pass for retained display list");
+                return false;
+            }
+            currentEncoder = beginRenderEncoder(renderPass);
+            if (!currentEncoder) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create render encoder for retained display list");
+                return false;
+            }
+            [currentEncoder setViewport:currentViewport];
+            if (scissorEnabled) {
+                [currentEncoder setScissorRect:currentScissor];
+            }
+        }
+
+        // Encoded on the slot's first replay and again only when the pass
+        // formats differ from its last encode (FBO vs screen); lists that
+        // can't be encoded replay through the encoder from now on
+        if (!encodeRetainedCommands(resident, *cmd.displayList)) {
+            resident.retainedEligible = false;
+            return executeDisplayList(cmd);
+        }
+
+        // The only per-frame data: this replay's transform and projection.
+        // A list drawn again in the same frame replays through the encoder.
+        struct RetainedReplay3D {
+            simd_float4x4 projectionMatrix;
+            simd_float4x4 transform;
+        };
+        RetainedReplay3D replay;
+        replay.projectionMatrix = cmd.projectionMatrix;
+        replay.transform = cmd.transform3D;
+        uint8_t* base = (uint8_t*)[resident.retainedUniforms contents];
+        std::memcpy(base + (resident.retainedDraws + currentFrameIndex) * kRetainedUniformStride, &replay,
+                    sizeof(replay));
+        resident.retainedFrame = frameSerial;
+
+        const DrawCommand3D& first = cmd.displayList->getCommands()[0].as<DrawCommand3D>();
+        applyDepthState(first.depthTestEnabled);
+        bindCullMode(first.cullBackFace ? MTLCullModeBack : MTLCullModeNone);
+        [currentEncoder useResources:resident.retainedResources.data()
+                               count:resident.retainedResources.size()
+                               usage:MTLResourceUsageRead
+                              stages:MTLRenderStageVertex];
+        [currentEncoder executeCommandsInBuffer:resident.retainedCommands[currentFrameIndex]
+                                      withRange:NSMakeRange(0, resident.retainedDraws)];
+
+        // The commands leave pipeline and buffer bindings undefined
+        id<MTLDepthStencilState> depthStencil = encoderState.depthStencil;
+        const int cullMode = encoderState.cullMode;
+        encoderState = EncoderStateCache();
+        encoderState.depthStencil = depthStencil;
+        encoderState.cullMode = cullMode;
+
+        frameDrawCalls += static_cast<uint32_t>(resident.retainedDraws);
+        frameVertices += resident.retainedVertices;
+        return true;
+    }
+}
+
+bool MetalRenderer::Impl::castsShadow(CommandType type) {
+    return type == CommandType::Draw3D || type == CommandType::Draw3DInstanced ||
+           type == CommandType::Draw3DIndirect || type == CommandType::DrawMeshPrimitives ||
+           type == CommandType::DrawDisplayList;
+}
+
+id<MTLTexture> MetalRenderer::Impl::getEmptyShadowMap() {
+    if (!emptyShadowMap) {
+        MTLTextureDescriptor* desc = [MTLTextureDescriptor
+            texture2DDescriptorWithPixelFormat:MTLPixelFormatDepth32Float width:1 height:1 mipmapped:NO];
+        desc.textureType = MTLTextureType2DArray;
+        desc.arrayLength = 1;
+        desc.usage = MTLTextureUsageShaderRead;
+        desc.storageMode = MTLStorageModePrivate;
+        emptyShadowMap = makeTrackedTexture(device, desc, oflike::ofGpuMemoryCategory::RenderTargets, "EmptyShadowMap");
+    }
+    return emptyShadowMap;
+}
+
+bool MetalRenderer::Impl::executeRenderShadowMap(const RenderShadowMapCommand& cmd) {
+    if (shadowPassActive) {
+        METAL_LOG_ERROR(@"MetalRenderer: Shadow map render inside a shadow pass");
+        return false;
+    }
+    id<MTLTexture> shadowMap = (__bridge id<MTLTexture>)cmd.shadowMap;
+    if (!shadowMap || cmd.slice >= shadowMap.arrayLength) {
+        METAL_LOG_ERROR(@"MetalRenderer: Invalid shadow map");
+        return false;
+    }
+
+    // The superseded recording will not be replayed again
+    if (cmd.replacesListId != 0) {
+        residentDisplayLists.erase(cmd.replacesListId);
+    }
+
+    @autoreleasepool {
+        // Depth-only pass on the map slice; like compute, it splits the
+        // current pass, which resumes with its attachments loaded
+        endCurrentEncoder();
+
+        MTLRenderPassDescriptor* pass = [MTLRenderPassDescriptor renderPassDescriptor];
+        pass.depthAttachment.texture = shadowMap;
+        pass.depthAttachment.slice = cmd.slice;
+        pass.depthAttachment.loadAction = MTLLoadActionClear;
+        pass.depthAttachment.storeAction = MTLStoreActionStore;
+        pass.depthAttachment.clearDepth = 1.0;
+        attachTimestamps(pass, "Shadow Map");
+        currentEncoder = [currentCommandBuffer renderCommandEncoderWithDescriptor:pass];
+        if (!currentEncoder) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create shadow map encoder");
+            return false;
+        }
+
+        MTLViewport viewport = {0.0, 0.0, (double)shadowMap.width, (double)shadowMap.height, 0.0, 1.0};
+        [currentEncoder setViewport:viewport];
+        [currentEncoder setDepthBias:cmd.depthBias slopeScale:cmd.slopeBias clamp:0.0f];
+
+        // Pipelines are picked for the map's formats while the casters replay
+        const MTLPixelFormat previousColorFormat = passColorFormat;
+        const MTLPixelFormat previousDepthFormat = passDepthFormat;
+        const NSUInteger previousSampleCount = passSampleCount;
+        const bool previousDepthTest = depthTestEnabled;
+        passColorFormat = MTLPixelFormatInvalid;
+        passDepthFormat = shadowMap.pixelFormat;
+        passSampleCount = 1;
+        shadowPassActive = true;
+
+        DrawDisplayListCommand replay;
+        replay.displayList = cmd.casters;
+        replay.listId = cmd.listId;
+        replay.projectionMatrix = cmd.projectionMatrix;
+        const bool success = executeDisplayList(replay);
+
+        shadowPassActive = false;
+        endCurrentEncoder();
+        passColorFormat = previousColorFormat;
+        passDepthFormat = previousDepthFormat;
+        passSampleCount = previousSampleCount;
+        depthTestEnabled = previousDepthTest;
+        if (!success) {
+            METAL_LOG_ERROR(@"MetalRenderer: Shadow map render failed");
+        }
+        return success;
+    }
+}
+
+// ============================================================================
+// Object ID Picking
+// ============================================================================
+
+bool MetalRenderer::Impl::executeObjectIdPass(const DrawList& drawList, bool onScreen) {
+    // Only the 3D draws that reached the screen are replayed
+    const CommandStream& commands = drawList.getCommands();
+    bool drawsOnScreen = false;
+    bool screen = onScreen;
+    for (size_t i = 0; i < commands.size() && !drawsOnScreen; ++i) {
+        const CommandRef cmd = commands[i];
+        if (cmd.type == CommandType::SetRenderTarget) {
+            screen = cmd.as<SetRenderTargetCommand>().renderTarget == nullptr;
+        } else {
+            drawsOnScreen = screen && castsShadow(cmd.type);
+        }
+    }
+    if (!drawsOnScreen) {
+        return true;
+    }
+
+    @autoreleasepool {
+        // Reallocated with the drawable size
+        MTLRenderPassDescriptor* screenPass = frameRenderPass ? frameRenderPass : view.currentRenderPassDescriptor;
+        id<MTLTexture> screenColor = screenPass.colorAttachments[0].texture;
+        if (!screenColor) {
+            return true;
+        }
+        const NSUInteger width = screenColor.width;
+        const NSUInteger height = screenColor.height;
+        if (!objectIdTexture || objectIdTexture.width != width || objectIdTexture.height != height) {
+            auto makeTarget = [&](MTLPixelFormat format, const char* name) {
+                MTLTextureDescriptor* desc = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:format
+                                                                                                width:width
+                                                                                               height:height
+                                                                                            mipmapped:NO];
+                desc.usage = MTLTextureUsageRenderTarget;
+                desc.storageMode = MTLStorageModePrivate;
+                return makeTrackedTexture(device, desc, oflike::ofGpuMemoryCategory::RenderTargets, name);
+            };
+            objectIdTexture = makeTarget(MTLPixelFormatR32Uint, "Object IDs");
+            objectIdDepth = makeTarget(MTLPixelFormatDepth32Float, "Object ID Depth");
+            if (!objectIdTexture || !objectIdDepth) {
+                objectIdTexture = nil;
+                objectIdDepth = nil;
+                return false;
+            }
+            objectIdRendered = false;
+        }
+
+        // Like a shadow map render, the ID pass splits the current pass,
+        // which resumes with its attachments loaded. The frame's first
+        // replay clears the target, later lists draw over it.
+        endCurrentEncoder();
+
+        MTLRenderPassDescriptor* pass = [MTLRenderPassDescriptor renderPassDescriptor];
+        const MTLLoadAction load = objectIdRendered ? MTLLoadActionLoad : MTLLoadActionClear;
+        pass.colorAttachments[0].texture = objectIdTexture;
+        pass.colorAttachments[0].loadAction = load;
+        pass.colorAttachments[0].storeAction = MTLStoreActionStore;
+        pass.colorAttachments[0].clearColor = MTLClearColorMake(0.0, 0.0, 0.0, 0.0);
+        pass.depthAttachment.texture = objectIdDepth;
+        pass.depthAttachment.loadAction = load;
+        pass.depthAttachment.storeAction = MTLStoreActionStore;
+        pass.depthAttachment.clearDepth = 1.0;
+        attachTimestamps(pass, "Object IDs");
+        currentEncoder = [currentCommandBuffer renderCommandEncoderWithDescriptor:pass];
+        if (!currentEncoder) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create object ID encoder");
+            return false;
+        }
+        objectIdRendered = true;
+
+        MTLViewport viewport = {0.0, 0.0, (double)width, (double)height, 0.0, 1.0};
+        [currentEncoder setViewport:viewport];
+
+        const MTLPixelFormat previousColorFormat = passColorFormat;
+        const MTLPixelFormat previousDepthFormat = passDepthFormat;
+        const NSUInteger previousSampleCount = passSampleCount;
+        const bool previousDepthTest = depthTestEnabled;
+        passColorFormat = MTLPixelFormatR32Uint;
+        passDepthFormat = MTLPixelFormatDepth32Float;
+        passSampleCount = 1;
+        objectIdPassActive = true;
+
+        // Same list, same positions: index ranges and streams stay valid
+        const DrawList* previousList = executingList;
+        executingList = &drawList;
+        bool success = true;
+        screen = onScreen;
+        for (size_t i = 0; i < commands.size() && success; ++i) {
+            const CommandRef cmd = commands[i];
+            if (cmd.type == CommandType::SetRenderTarget) {
+                screen = cmd.as<SetRenderTargetCommand>().renderTarget == nullptr;
+                continue;
+            }
+            if (screen && castsShadow(cmd.type)) {
+                executingIndex = i;
+                success = executeCommand(cmd, drawList);
+            }
+        }
+        executingList = previousList;
+
+        objectIdPassActive = false;
+        endCurrentEncoder();
+        passColorFormat = previousColorFormat;
+        passDepthFormat = previousDepthFormat;
+        passSampleCount = previousSampleCount;
+        depthTestEnabled = previousDepthTest;
+        if (!success) {
+            METAL_LOG_ERROR(@"MetalRenderer: Object ID pass failed");
+        }
+        return success;
+    }
+}
+
+void MetalRenderer::Impl::readObjectIdPick() {
+    const bool rendered = objectIdRendered;
+    objectIdRendered = false;
+    if (!objectIdPickPending) {
+        return;
+    }
+    objectIdPickPending = false;
+
+    const uint64_t serial = frameSerial;
+    if (!rendered) {
+        // Nothing 3D on the screen this frame
+        std::lock_guard<std::mutex> lock(objectIdMutex);
+        objectIdResult = 0;
+        objectIdResultSerial = serial;
+        return;
+    }
+
+    @autoreleasepool {
+        // One texel per frame slot; the slot is free again by the time it's reused
+        id<MTLBuffer> readback = objectIdReadback[currentFrameIndex];
+        if (!readback) {
+            readback = makeTrackedBuffer(device, sizeof(uint32_t), MTLResourceStorageModeShared,
+                                         oflike::ofGpuMemoryCategory::RenderTargets, "Object ID Readback");
+            objectIdReadback[currentFrameIndex] = readback;
+        }
+        id<MTLBlitCommandEncoder> blit = readback ? [currentCommandBuffer blitCommandEncoder] : nil;
+        if (!blit) {
+            return;
+        }
+        const NSUInteger width = objectIdTexture.width;
+        const NSUInteger height = objectIdTexture.height;
+        const NSUInteger x = std::min((NSUInteger)(objectIdPickX * (float)width), width - 1);
+        const NSUInteger y = std::min((NSUInteger)(objectIdPickY * (float)height), height - 1);
+        blit.label = @"Object ID Readback";
+        [blit copyFromTexture:objectIdTexture
+                  sourceSlice:0
+                  sourceLevel:0
+                 sourceOrigin:MTLOriginMake(x, y, 0)
+                   sourceSize:MTLSizeMake(1, 1, 1)
+                     toBuffer:readback
+            destinationOffset:0
+       destinationBytesPerRow:sizeof(uint32_t)
+     destinationBytesPerImage:sizeof(uint32_t)];
+        [blit endEncoding];
+
+        Impl* impl = this;
+        [currentCommandBuffer addCompletedHandler:^(id<MTLCommandBuffer> commandBuffer) {
+            if (commandBuffer.status != MTLCommandBufferStatusCompleted) {
+                return;
+            }
+            const uint32_t objectId = *static_cast<const uint32_t*>(readback.contents);
+            std::lock_guard<std::mutex> lock(impl->objectIdMutex);
+            if (serial > impl->objectIdResultSerial) {
+                impl->objectIdResult = objectId;
+                impl->objectIdResultSerial = serial;
+            }
+        }];
+    }
+}
+
+// ============================================================================
+// Order-Independent Transparency
+// ============================================================================
+
+bool MetalRenderer::Impl::isOrderIndependent(const CommandRef& cmd) {
+    return (cmd.type == CommandType::Draw3D || cmd.type == CommandType::Draw3DInstanced ||
+            cmd.type == CommandType::Draw3DIndirect) &&
+           cmd.as<DrawCommand3D>().orderIndependent;
+}
+
+bool MetalRenderer::Impl::drawsUnderTransparency(const CommandRef& cmd) {
+    // Depth-tested 3D draws are hidden or revealed by the transparent layers
+    // wherever they land; state changes apply to the draws that follow them.
+    // Everything else draws over the layers (or leaves the pass), which
+    // composites them first.
+    switch (cmd.type) {
+        case CommandType::Draw3D:
+        case CommandType::Draw3DInstanced:
+        case CommandType::Draw3DIndirect:
+        case CommandType::DrawMeshPrimitives:
+            return cmd.as<DrawCommand3D>().depthTestEnabled;
+        case CommandType::DrawPointCloud:
+            return cmd.as<DrawPointCloudCommand>().depthTestEnabled;
+        case CommandType::SetViewport:
+        case CommandType::SetScissor:
+        case CommandType::SetCustomShader:
+        case CommandType::SetBlendMode:
+        case CommandType::SetDepthTest:
+        case CommandType::SetCullMode:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void MetalRenderer::Impl::deferTransparentDraw(const CommandRef& cmd) {
+    TransparentDrawState state;
+    state.index = executingIndex;
+    state.viewport = currentViewport;
+    state.scissor = currentScissor;
+    state.scissorEnabled = scissorEnabled;
+    transparentDraws.push(cmd);
+    transparentDrawStates.push_back(state);
+}
+
+bool MetalRenderer::Impl::ensureTransparencyTargets(NSUInteger width, NSUInteger height, NSUInteger samples) {
+    auto matches = [&](id<MTLTexture> texture, NSUInteger sampleCount) {
+        return texture && texture.width == width && texture.height == height && texture.sampleCount == sampleCount;
+    };
+    auto makeTarget = [&](MTLPixelFormat format, NSUInteger sampleCount, bool memoryless, const char* name) {
+        MTLTextureDescriptor* desc = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:format
+                                                                                        width:width
+                                                                                       height:height
+                                                                                    mipmapped:NO];
+        if (sampleCount > 1) {
+            desc.textureType = MTLTextureType2DMultisample;
+            desc.sampleCount = sampleCount;
+            desc.usage = MTLTextureUsageRenderTarget;
+        } else {
+            desc.usage = MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead;
+        }
+        desc.storageMode = memoryless ? MTLStorageModeMemoryless : MTLStorageModePrivate;
+        return makeTrackedTexture(device, desc, oflike::ofGpuMemoryCategory::RenderTargets, name);
+    };
+
+    if (!matches(transparencyAccumulation, 1) || !matches(transparencyRevealage, 1)) {
+        transparencyAccumulation = makeTarget(MTLPixelFormatRGBA16Float, 1, false, "Transparency Accumulation");
+        transparencyRevealage = makeTarget(MTLPixelFormatR16Float, 1, false, "Transparency Revealage");
+    }
+    if (samples > 1) {
+        // Samples only live until the pass resolves them
+        if (!matches(transparencyAccumulationMsaa, samples) || !matches(transparencyRevealageMsaa, samples)) {
+            transparencyAccumulationMsaa = makeTarget(MTLPixelFormatRGBA16Float, samples, memorylessSupported,
+                                                      "Transparency Accumulation MSAA");
+            transparencyRevealageMsaa = makeTarget(MTLPixelFormatR16Float, samples, memorylessSupported,
+                                                   "Transparency Revealage MSAA");
+        }
+        if (!transparencyAccumulationMsaa || !transparencyRevealageMsaa) {
+            return false;
+        }
+    }
+    return transparencyAccumulation && transparencyRevealage;
+}
+
+MTLRenderPassDescriptor* MetalRenderer::Impl::transparencyPassDescriptor(MTLRenderPassDescriptor* renderPass) {
+    id<MTLTexture> depthTexture = renderPass.depthAttachment.texture;
+    id<MTLTexture> colorTexture = renderPass.colorAttachments[0].texture;
+    const NSUInteger width = colorTexture ? colorTexture.width : (NSUInteger)view.drawableSize.width;
+    const NSUInteger height = colorTexture ? colorTexture.height : (NSUInteger)view.drawableSize.height;
+    if (!ensureTransparencyTargets(width, height, passSampleCount)) {
+        return nil;
+    }
+
+    // Accumulation starts at 0, revealage at 1 (nothing covers the pixel)
+    MTLRenderPassDescriptor* pass = [MTLRenderPassDescriptor renderPassDescriptor];
+    const bool multisampled = passSampleCount > 1;
+    id<MTLTexture> targets[2] = {transparencyAccumulation, transparencyRevealage};
+    id<MTLTexture> samples[2] = {transparencyAccumulationMsaa, transparencyRevealageMsaa};
+    for (NSUInteger i = 0; i < 2; i++) {
+        pass.colorAttachments[i].texture = multisampled ? samples[i] : targets[i];
+        pass.colorAttachments[i].resolveTexture = multisampled ? targets[i] : nil;
+        pass.colorAttachments[i].loadAction = MTLLoadActionClear;
+        pass.colorAttachments[i].storeAction = multisampled ? MTLStoreActionMultisampleResolve : MTLStoreActionStore;
+    }
+    pass.colorAttachments[0].clearColor = MTLClearColorMake(0, 0, 0, 0);
+    pass.colorAttachments[1].clearColor = MTLClearColorMake(1, 0, 0, 0);
+    pass.rasterizationRateMap = renderPass.rasterizationRateMap;   // Layers land where the pass's pixels do
+
+    // Layers test against the opaque depth the pass stored and leave it as is
+    if (depthTexture) {
+        const bool depthValid = currentRenderTarget ? targetDepthValid : screenDepthValid;
+        pass.depthAttachment.texture = depthTexture;
+        pass.depthAttachment.loadAction = depthValid ? MTLLoadActionLoad : MTLLoadActionClear;
+        pass.depthAttachment.clearDepth = 1.0;
+        pass.depthAttachment.storeAction = depthValid ? MTLStoreActionStore : MTLStoreActionDontCare;
+        if (renderPass.stencilAttachment.texture) {
+            pass.stencilAttachment.texture = renderPass.stencilAttachment.texture;
+            pass.stencilAttachment.loadAction = MTLLoadActionDontCare;
+            pass.stencilAttachment.storeAction = MTLStoreActionDontCare;
+        }
+    }
+    return pass;
+}
+
+bool MetalRenderer::Impl::resolveTransparency() {
+    if (transparentDraws.empty()) {
+        return true;
+    }
+
+    @autoreleasepool {
+        MTLRenderPassDescriptor* renderPass = getCurrentRenderPassDescriptor();
+        if (!renderPass) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to get render pass for transparency");
+            transparentDraws.clear();
+            transparentDrawStates.clear();
+            return false;
+        }
+
+        // End the opaque encoder while draws are pending, so it stores its
+        // depth (and samples) for the layers and the composite; an encoder
+        // that never started still applies the pass's clears
+        if (!currentEncoder) {
+            currentEncoder = beginRenderEncoder(renderPass);
+            if (!currentEncoder) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create render encoder for transparency");
+                transparentDraws.clear();
+                transparentDrawStates.clear();
+                return false;
+            }
+        }
+        endCurrentEncoder();
+
+        CommandStream draws;
+        std::vector<TransparentDrawState> states;
+        draws.swap(transparentDraws);
+        states.swap(transparentDrawStates);
+
+        const size_t previousIndex = executingIndex;
+        const MTLViewport previousViewport = currentViewport;
+        const MTLScissorRect previousScissor = currentScissor;
+        const bool previousScissorEnabled = scissorEnabled;
+        auto replay = [&]() {
+            bool success = true;
+            for (size_t i = 0; i < draws.size() && success; ++i) {
+                executingIndex = states[i].index;
+                currentViewport = states[i].viewport;
+                currentScissor = states[i].scissor;
+                scissorEnabled = states[i].scissorEnabled;
+                if (currentEncoder) {
+                    [currentEncoder setViewport:currentViewport];
+                    if (scissorEnabled) {
+                        [currentEncoder setScissorRect:currentScissor];
+                    }
+                }
+                success = executeCommand(draws[i], *executingList);
+            }
+            executingIndex = previousIndex;
+            currentViewport = previousViewport;
+            currentScissor = previousScissor;
+            scissorEnabled = previousScissorEnabled;
+            return success;
+        };
+
+        id<MTLRenderPipelineState> composite = getPassPipeline(PipelineShader::TransparencyComposite,
+                                                               BlendMode::Alpha, VertexFormat::Float);
+        MTLRenderPassDescriptor* layersPass = composite ? transparencyPassDescriptor(renderPass) : nil;
+        if (!layersPass) {
+            // Without the targets the layers blend in submission order
+            METAL_LOG_ERROR(@"MetalRenderer: Transparency targets unavailable, blending in draw order");
+            replayingTransparency = true;
+            const bool success = replay();
+            replayingTransparency = false;
+            return success;
+        }
+
+        // Accumulate every layer in a pass of its own
+        const bool timed = attachTimestamps(layersPass, "Transparency");
+        currentEncoder = [currentCommandBuffer renderCommandEncoderWithDescriptor:layersPass];
+        if (timed) {
+            layersPass.sampleBufferAttachments[0].sampleBuffer = nil;
+        }
+        if (!currentEncoder) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create transparency encoder");
+            return false;
+        }
+        const MTLPixelFormat previousColorFormat = passColorFormat;
+        const bool previousDepthTest = depthTestEnabled;
+        passColorFormat = MTLPixelFormatRGBA16Float;
+        replayingTransparency = true;
+        transparencyPassActive = true;
+        bool success = replay();
+        transparencyPassActive = false;
+        replayingTransparency = false;
+        passColorFormat = previousColorFormat;
+        depthTestEnabled = previousDepthTest;
+        endCurrentEncoder();
+        if (!success) {
+            METAL_LOG_ERROR(@"MetalRenderer: Transparency accumulation failed");
+            return false;
+        }
+
+        // Composite over the pass, which resumes with its attachments loaded
+        currentEncoder = beginRenderEncoder(renderPass);
+        if (!currentEncoder) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create transparency composite encoder");
+            return false;
+        }
+        // Rate-mapped passes take viewports in screen pixels
+        const MTLSize covered = renderPass.rasterizationRateMap
+                                    ? renderPass.rasterizationRateMap.screenSize
+                                    : MTLSizeMake(transparencyAccumulation.width, transparencyAccumulation.height, 1);
+        MTLViewport fullscreen = {0.0, 0.0, (double)covered.width, (double)covered.height, 0.0, 1.0};
+        [currentEncoder setViewport:fullscreen];
+        bindPipeline(composite);
+        bindDepthStencilState(depthDisabledState);
+        bindCullMode(MTLCullModeNone);
+        bindFragmentTexture(transparencyAccumulation, 0);
+        bindFragmentTexture(transparencyRevealage, 1);
+        [currentEncoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:3];
+        frameDrawCalls++;
+
+        [currentEncoder setViewport:currentViewport];
+        if (scissorEnabled) {
+            [currentEncoder setScissorRect:currentScissor];
+        }
+        applyDepthState(depthTestEnabled);
+        return true;
+    }
+}
+
+// ============================================================================
+// Variable Rasterization Rate
+// ============================================================================
+
+MetalRenderer::Impl::RateTarget* MetalRenderer::Impl::findRateTarget(void* key) {
+    if (rateTargets.empty()) {
+        return nullptr;
+    }
+    auto it = rateTargets.find(key);
+    return it != rateTargets.end() ? &it->second : nullptr;
+}
+
+bool MetalRenderer::Impl::prepareRateTarget(RateTarget& target, MTLPixelFormat format, NSUInteger width,
+                                            NSUInteger height, MTLPixelFormat depthFormat) {
+    const MTLPixelFormat currentDepthFormat = target.depth ? target.depth.pixelFormat : MTLPixelFormatInvalid;
+    if (target.map && target.width == width && target.height == height &&
+        target.physical.pixelFormat == format && currentDepthFormat == depthFormat) {
+        return true;
+    }
+    target.map = nil;
+    target.parameters = nil;
+    target.physical = nil;
+    target.depth = nil;
+    target.drawn = false;
+    if (!rateMapsSupported || width == 0 || height == 0) {
+        return false;
+    }
+
+    @autoreleasepool {
+        // One zone per rate on each axis; an empty axis is one full-rate zone
+        auto zones = [](const std::vector<float>& rates) {
+            return rates.empty() ? NSUInteger(1) : NSUInteger(rates.size());
+        };
+        auto fill = [](float* storage, const std::vector<float>& rates) {
+            storage[0] = 1.0f;
+            for (size_t i = 0; i < rates.size(); ++i) {
+                storage[i] = std::clamp(rates[i], kMinRasterizationRate, 1.0f);
+            }
+        };
+        MTLRasterizationRateLayerDescriptor* layer = [[MTLRasterizationRateLayerDescriptor alloc]
+            initWithSampleCount:MTLSizeMake(zones(target.rate.horizontal), zones(target.rate.vertical), 0)];
+        if (!layer) {
+            METAL_LOG_ERROR(@"MetalRenderer: Too many rasterization rate zones (%zu x %zu)",
+                            target.rate.horizontal.size(), target.rate.vertical.size());
+            return false;
+        }
+        fill(layer.horizontalSampleStorage, target.rate.horizontal);
+        fill(layer.verticalSampleStorage, target.rate.vertical);
+
+        MTLRasterizationRateMapDescriptor* desc = [MTLRasterizationRateMapDescriptor
+            rasterizationRateMapDescriptorWithScreenSize:MTLSizeMake(width, height, 0)
+                                                   layer:layer];
+        desc.label = @"Rasterization Rate Map";
+        id<MTLRasterizationRateMap> map = [device newRasterizationRateMapWithDescriptor:desc];
+        if (!map) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create rasterization rate map (%lu x %lu)",
+                            (unsigned long)width, (unsigned long)height);
+            return false;
+        }
+
+        // Passes draw into textures of the map's physical size
+        const MTLSize physicalSize = [map physicalSizeForLayer:0];
+        auto makeTexture = [&](MTLPixelFormat pixelFormat, MTLTextureUsage usage, const char* name) {
+            MTLTextureDescriptor* textureDesc = [MTLTextureDescriptor
+                texture2DDescriptorWithPixelFormat:pixelFormat
+                width:physicalSize.width
+                height:physicalSize.height
+                mipmapped:NO];
+            textureDesc.usage = usage;
+            textureDesc.storageMode = MTLStorageModePrivate;
+            return makeTrackedTexture(device, textureDesc, oflike::ofGpuMemoryCategory::RenderTargets, name);
+        };
+        id<MTLTexture> physical = makeTexture(format, MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead,
+                                              "Rate Map Color");
+        id<MTLTexture> depth = depthFormat != MTLPixelFormatInvalid
+                                   ? makeTexture(depthFormat, MTLTextureUsageRenderTarget, "Rate Map Depth")
+                                   : nil;
+        id<MTLBuffer> parameters = makeTrackedBuffer(device, map.parameterBufferSizeAndAlign.size,
+                                                     MTLResourceStorageModeShared,
+                                                     oflike::ofGpuMemoryCategory::RenderTargets,
+                                                     "RateMapParameters");
+        if (!physical || (depthFormat != MTLPixelFormatInvalid && !depth) || !parameters) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create rasterization rate targets (%lu x %lu)",
+                            (unsigned long)physicalSize.width, (unsigned long)physicalSize.height);
+            return false;
+        }
+        [map copyParameterDataToBuffer:parameters offset:0];
+
+        target.map = map;
+        target.parameters = parameters;
+        target.physical = physical;
+        target.depth = depth;
+        target.width = width;
+        target.height = height;
+        return true;
+    }
+}
+
+MTLRenderPassDescriptor* MetalRenderer::Impl::rateScreenPassDescriptor(MTLRenderPassDescriptor* screenPass) {
+    RateTarget* rate = findRateTarget(nullptr);
+    id<MTLTexture> drawable = screenPass.colorAttachments[0].texture;
+    if (!rate || !drawable || screenPass.colorAttachments[0].resolveTexture) {
+        return nil;     // No rate, or a multisampled view
+    }
+    id<MTLTexture> viewDepth = screenPass.depthAttachment.texture;
+    if (!prepareRateTarget(*rate, drawable.pixelFormat, drawable.width, drawable.height,
+                           viewDepth ? viewDepth.pixelFormat : MTLPixelFormatInvalid)) {
+        return nil;
+    }
+    if (rateScreenPass && rateScreenPass.colorAttachments[0].texture == rate->physical) {
+        return rateScreenPass;
+    }
+
+    // Stands in for the view's pass with its clears; load/store actions are
+    // set per encoder like the view's
+    MTLRenderPassDescriptor* pass = [MTLRenderPassDescriptor renderPassDescriptor];
+    pass.colorAttachments[0].texture = rate->physical;
+    pass.colorAttachments[0].clearColor = screenPass.colorAttachments[0].clearColor;
+    pass.colorAttachments[0].storeAction = MTLStoreActionStore;
+    if (rate->depth) {
+        pass.depthAttachment.texture = rate->depth;
+        pass.depthAttachment.clearDepth = screenPass.depthAttachment.clearDepth;
+        if (screenPass.stencilAttachment.texture == viewDepth) {
+            pass.stencilAttachment.texture = rate->depth;
+            pass.stencilAttachment.clearStencil = screenPass.stencilAttachment.clearStencil;
+            pass.stencilAttachment.loadAction = screenPass.stencilAttachment.loadAction;
+            pass.stencilAttachment.storeAction = screenPass.stencilAttachment.storeAction;
+        }
+    }
+    pass.rasterizationRateMap = rate->map;
+    rateScreenPass = pass;
+    return pass;
+}
+
+bool MetalRenderer::Impl::resolveRasterizationRate(void* key) {
+    RateTarget* rate = findRateTarget(key);
+    if (!rate || !rate->drawn || !currentCommandBuffer) {
+        return true;
+    }
+    rate->drawn = false;
+
+    @autoreleasepool {
+        id<MTLTexture> destination = nil;
+        if (key) {
+            destination = (__bridge id<MTLTexture>)key;
+        } else {
+            MTLRenderPassDescriptor* screenPass = frameRenderPass ? frameRenderPass : view.currentRenderPassDescriptor;
+            destination = screenPass.colorAttachments[0].texture;
+        }
+        if (!destination || !rate->map || destination.width != rate->width || destination.height != rate->height) {
+            METAL_LOG_ERROR(@"MetalRenderer: Rasterization rate target changed size before its resolve");
+            return false;
+        }
+
+        id<MTLRenderPipelineState>& pipeline = rateResolvePipelines[destination.pixelFormat];
+        if (!pipeline) {
+            id<MTLFunction> vertexFunction = [shaderLibrary newFunctionWithName:@"vertexRateMapResolve"];
+            id<MTLFunction> fragmentFunction = [shaderLibrary newFunctionWithName:@"fragmentRateMapResolve"];
+            if (!vertexFunction || !fragmentFunction) {
+                METAL_LOG_ERROR(@"MetalRenderer: Rasterization rate resolve shaders not found");
+                return false;
+            }
+            MTLRenderPipelineDescriptor* desc = [[MTLRenderPipelineDescriptor alloc] init];
+            desc.label = @"Rasterization Rate Resolve";
+            desc.vertexFunction = vertexFunction;
+            desc.fragmentFunction = fragmentFunction;
+            desc.colorAttachments[0].pixelFormat = destination.pixelFormat;
+            NSError* error = nil;
+            pipeline = [device newRenderPipelineStateWithDescriptor:desc error:&error];
+            if (!pipeline) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create rasterization rate resolve: %@",
+                                error.localizedDescription);
+                return false;
+            }
+        }
+
+        // Every destination pixel is written; the next encoder on the pass
+        // resumes with its physical attachments loaded
+        endCurrentEncoder();
+        MTLRenderPassDescriptor* pass = [MTLRenderPassDescriptor renderPassDescriptor];
+        pass.colorAttachments[0].texture = destination;
+        pass.colorAttachments[0].loadAction = MTLLoadActionDontCare;
+        pass.colorAttachments[0].storeAction = MTLStoreActionStore;
+        const bool timed = attachTimestamps(pass, "Rate Resolve");
+        id<MTLRenderCommandEncoder> encoder = [currentCommandBuffer renderCommandEncoderWithDescriptor:pass];
+        if (timed) {
+            pass.sampleBufferAttachments[0].sampleBuffer = nil;
+        }
+        if (!encoder) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create rasterization rate resolve encoder");
+            return false;
+        }
+        encoder.label = @"Rasterization Rate Resolve";
+        [encoder setRenderPipelineState:pipeline];
+        [encoder setFragmentBuffer:rate->parameters offset:0 atIndex:0];
+        [encoder setFragmentTexture:rate->physical atIndex:0];
+        [encoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:3];
+        [encoder endEncoding];
+        frameDrawCalls++;
+        return true;
+    }
+}
+
+void MetalRenderer::Impl::resolveRasterizationRates() {
+    for (auto& entry : rateTargets) {
+        if (entry.second.drawn) {
+            resolveRasterizationRate(entry.first);
+        }
+    }
+}
+
+// ============================================================================
+// Display Outputs
+// ============================================================================
+
+bool MetalRenderer::Impl::buildDisplayOutputMesh(DisplayOutput& output) {
+    // Subdivided grid cells; each vertex is the bilinear blend of its cell's
+    // control points, so the warp stays smooth across the triangles
+    const DisplayOutputConfig& config = output.config;
+    const bool warped = !config.warpPoints.empty();
+    const uint32_t columns = warped ? config.warpColumns : 1;
+    const uint32_t rows = warped ? config.warpRows : 1;
+    const uint32_t steps = warped ? kDisplayWarpSubdivisions : 1;
+    auto point = [&](uint32_t column, uint32_t row) {
+        return warped ? config.warpPoints[row * (columns + 1) + column]
+                      : simd_make_float2((float)column, (float)row);
+    };
+    auto vertexAt = [&](uint32_t x, uint32_t y) {
+        // x, y in subdivided steps across the whole grid
+        const uint32_t column = std::min(x / steps, columns - 1);
+        const uint32_t row = std::min(y / steps, rows - 1);
+        const float u = (float)(x - column * steps) / steps;
+        const float v = (float)(y - row * steps) / steps;
+        const simd_float2 top = simd_mix(point(column, row), point(column + 1, row), u);
+        const simd_float2 bottom = simd_mix(point(column, row + 1), point(column + 1, row + 1), u);
+        DisplayOutputVertex vertex;
+        vertex.position = simd_mix(top, bottom, v);
+        vertex.slice = simd_make_float2((float)x / (columns * steps), (float)y / (rows * steps));
+        return vertex;
+    };
+
+    std::vector<DisplayOutputVertex> vertices;
+    vertices.reserve((size_t)columns * rows * steps * steps * 6);
+    for (uint32_t y = 0; y < rows * steps; ++y) {
+        for (uint32_t x = 0; x < columns * steps; ++x) {
+            const DisplayOutputVertex a = vertexAt(x, y);
+            const DisplayOutputVertex b = vertexAt(x + 1, y);
+            const DisplayOutputVertex c = vertexAt(x, y + 1);
+            const DisplayOutputVertex d = vertexAt(x + 1, y + 1);
+            vertices.insert(vertices.end(), {a, b, c, b, d, c});
+        }
+    }
+
+    output.mesh = makeTrackedBuffer(device, vertices.data(), vertices.size() * sizeof(DisplayOutputVertex),
+                                    MTLResourceStorageModeShared, oflike::ofGpuMemoryCategory::Meshes,
+                                    "DisplayOutputMesh");
+    output.vertexCount = output.mesh ? vertices.size() : 0;
+    output.meshDirty = output.mesh == nil;
+    return output.mesh != nil;
+}
+
+id<MTLRenderPipelineState> MetalRenderer::Impl::getDisplayOutputPipeline(MTLPixelFormat format) {
+    id<MTLRenderPipelineState>& pipeline = displayOutputPipelines[format];
+    if (pipeline) {
+        return pipeline;
+    }
+    @autoreleasepool {
+        id<MTLFunction> vertexFunction = [shaderLibrary newFunctionWithName:@"vertexDisplayOutput"];
+        id<MTLFunction> fragmentFunction = [shaderLibrary newFunctionWithName:@"fragmentDisplayOutput"];
+        if (!vertexFunction || !fragmentFunction) {
+            METAL_LOG_ERROR(@"MetalRenderer: Display output shaders not found");
+            return nil;
+        }
+        MTLRenderPipelineDescriptor* desc = [[MTLRenderPipelineDescriptor alloc] init];
+        desc.label = @"Display Output";
+        desc.vertexFunction = vertexFunction;
+        desc.fragmentFunction = fragmentFunction;
+        desc.colorAttachments[0].pixelFormat = format;
+        NSError* error = nil;
+        pipeline = [device newRenderPipelineStateWithDescriptor:desc error:&error];
+        if (!pipeline) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create display output pipeline: %@",
+                            error.localizedDescription);
+        }
+        return pipeline;
+    }
+}
+
+void MetalRenderer::Impl::encodeDisplayOutputs() {
+    std::lock_guard<std::mutex> lock(displayOutputMutex);
+    if (displayOutputs.empty() || !displayOutputSource || !currentCommandBuffer) {
+        return;
+    }
+
+    @autoreleasepool {
+        for (auto& entry : displayOutputs) {
+            DisplayOutput& output = entry.second;
+            if (output.meshDirty && !buildDisplayOutputMesh(output)) {
+                continue;
+            }
+            if (output.layer.drawableSize.width < 1.0 || output.layer.drawableSize.height < 1.0) {
+                continue;
+            }
+
+            // Waits if the display still shows all of its drawables
+            id<CAMetalDrawable> drawable = [output.layer nextDrawable];
+            id<MTLRenderPipelineState> pipeline = drawable ? getDisplayOutputPipeline(drawable.texture.pixelFormat)
+                                                           : nil;
+            if (!pipeline) {
+                continue;
+            }
+
+            // Black outside the warped slice
+            MTLRenderPassDescriptor* pass = [MTLRenderPassDescriptor renderPassDescriptor];
+            pass.colorAttachments[0].texture = drawable.texture;
+            pass.colorAttachments[0].loadAction = MTLLoadActionClear;
+            pass.colorAttachments[0].clearColor = MTLClearColorMake(0, 0, 0, 1);
+            pass.colorAttachments[0].storeAction = MTLStoreActionStore;
+            const bool timed = attachTimestamps(pass, "Display Output");
+            id<MTLRenderCommandEncoder> encoder = [currentCommandBuffer renderCommandEncoderWithDescriptor:pass];
+            if (timed) {
+                pass.sampleBufferAttachments[0].sampleBuffer = nil;
+            }
+            if (!encoder) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create display output encoder");
+                continue;
+            }
+            encoder.label = @"Display Output";
+
+            DisplayOutputUniforms uniforms;
+            uniforms.source = output.config.source;
+            uniforms.blendWidth = output.config.blendWidth;
+            uniforms.blendCurve = std::max(output.config.blendCurve, 0.01f);
+            uniforms.blendGamma = std::max(output.config.blendGamma, 0.01f);
+            [encoder setRenderPipelineState:pipeline];
+            [encoder setVertexBuffer:output.mesh offset:0 atIndex:0];
+            [encoder setFragmentBytes:&uniforms length:sizeof(uniforms) atIndex:0];
+            [encoder setFragmentTexture:displayOutputSource atIndex:0];
+            [encoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:output.vertexCount];
+            [encoder endEncoding];
+            frameDrawCalls++;
+
+            // Every output presents when this command buffer completes
+            [currentCommandBuffer presentDrawable:drawable];
+        }
+    }
+}
+
+// ============================================================================
+// Occlusion Pyramid
+// ============================================================================
+
+void MetalRenderer::Impl::buildOcclusionPyramid() {
+    occlusionPyramidValid = false;
+    id<MTLTexture> depth = screenDepthTexture;
+    if (!occlusionCullingEnabled || !screenDepthValid || !depth || depth.sampleCount != 1 ||
+        depth.pixelFormat != MTLPixelFormatDepth32Float) {
+        return;     // Nothing drawn with stored depth, or multisampled depth
+    }
+
+    @autoreleasepool {
+        id<MTLComputePipelineState> fromDepth = getComputePipeline("occlusionReduceDepth");
+        id<MTLComputePipelineState> reduce = getComputePipeline("occlusionReduce");
+        if (!fromDepth || !reduce) {
+            return;
+        }
+
+        // Reallocated with the drawable size; levels down to 1x1
+        const NSUInteger width = depth.width;
+        const NSUInteger height = depth.height;
+        if (!occlusionPyramid || occlusionPyramid.width != width || occlusionPyramid.height != height) {
+            auto makeTexture = [&](MTLPixelFormat format, BOOL mipmapped, MTLTextureUsage usage, const char* name) {
+                MTLTextureDescriptor* desc = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:format
+                                                                                                width:width
+                                                                                               height:height
+                                                                                            mipmapped:mipmapped];
+                desc.usage = usage;
+                desc.storageMode = MTLStorageModePrivate;
+                return makeTrackedTexture(device, desc, oflike::ofGpuMemoryCategory::RenderTargets, name);
+            };
+            occlusionLevels.clear();
+            occlusionDepthCopy = makeTexture(MTLPixelFormatDepth32Float, NO, MTLTextureUsageShaderRead,
+                                             "Occlusion Depth");
+            occlusionPyramid = makeTexture(MTLPixelFormatR32Float, YES,
+                                           MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite,
+                                           "Occlusion Pyramid");
+            if (!occlusionDepthCopy || !occlusionPyramid) {
+                occlusionDepthCopy = nil;
+                occlusionPyramid = nil;
+                return;
+            }
+            for (NSUInteger level = 0; level < occlusionPyramid.mipmapLevelCount; ++level) {
+                occlusionLevels.push_back([occlusionPyramid newTextureViewWithPixelFormat:MTLPixelFormatR32Float
+                                                                              textureType:MTLTextureType2D
+                                                                                   levels:NSMakeRange(level, 1)
+                                                                                   slices:NSMakeRange(0, 1)]);
+            }
+        }
+
+        // The view's depth is a render target only; copy it to sample it
+        id<MTLBlitCommandEncoder> blit = [currentCommandBuffer blitCommandEncoder];
+        if (!blit) {
+            return;
+        }
+        [blit copyFromTexture:depth toTexture:occlusionDepthCopy];
+        [blit endEncoding];
+
+        // One serial encoder: each level reads the one written before it
+        MTLComputePassDescriptor* computePass = [MTLComputePassDescriptor computePassDescriptor];
+        attachTimestamps(computePass, "Occlusion Pyramid");
+        id<MTLComputeCommandEncoder> encoder = [currentCommandBuffer computeCommandEncoderWithDescriptor:computePass];
+        if (!encoder) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create compute encoder");
+            return;
+        }
+        dispatchImageKernel(encoder, fromDepth, {occlusionDepthCopy, occlusionLevels[0]}, nullptr, 0,
+                            width, height);
+        for (size_t level = 1; level < occlusionLevels.size(); ++level) {
+            id<MTLTexture> destination = occlusionLevels[level];
+            dispatchImageKernel(encoder, reduce, {occlusionLevels[level - 1], destination}, nullptr, 0,
+                                destination.width, destination.height);
+        }
+        [encoder endEncoding];
+        occlusionPyramidValid = true;
+    }
+}
+
+// ============================================================================
+// State Management
+// ============================================================================
+
+bool MetalRenderer::Impl::executeDispatchCompute(const DispatchComputeCommand& cmd) {
+    @autoreleasepool {
+        id<MTLComputePipelineState> pipeline = (__bridge id<MTLComputePipelineState>)cmd.pipelineState;
+        if (!pipeline || cmd.bufferCount > DispatchComputeCommand::kMaxBuffers ||
+            cmd.textureCount > DispatchComputeCommand::kMaxTextures ||
+            cmd.constantsSize > DispatchComputeCommand::kMaxConstantsSize) {
+            METAL_LOG_ERROR(@"MetalRenderer: Invalid compute dispatch");
+            return false;
+        }
+
+        // Compute cannot run inside a render encoder; the next encoder on the
+        // pass resumes with its attachments loaded instead of cleared again
+        endCurrentEncoder();
+
+        MTLComputePassDescriptor* computePass = [MTLComputePassDescriptor computePassDescriptor];
+        attachTimestamps(computePass, pipeline.label ? pipeline.label.UTF8String : "Compute");
+        id<MTLComputeCommandEncoder> encoder = [currentCommandBuffer computeCommandEncoderWithDescriptor:computePass];
+        if (!encoder) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create compute encoder");
+            return false;
+        }
+
+        [encoder setComputePipelineState:pipeline];
+        for (uint32_t i = 0; i < cmd.bufferCount; i++) {
+            [encoder setBuffer:(__bridge id<MTLBuffer>)cmd.buffers[i]
+                        offset:cmd.bufferOffsets[i]
+                       atIndex:i];
+        }
+        for (uint32_t i = 0; i < cmd.textureCount; i++) {
+            [encoder setTexture:(__bridge id<MTLTexture>)cmd.textures[i] atIndex:i];
+        }
+        if (cmd.constantsSize > 0) {
+            [encoder setBytes:cmd.constants length:cmd.constantsSize atIndex:cmd.bufferCount];
+        }
+
+        // Whole threadgroups; kernels bounds-check against their own count.
+        // 1D grids run a SIMD-group wide, 2D/3D grids fill the group in y
+        MTLSize group = MTLSizeMake(cmd.threadgroupSize[0], std::max(cmd.threadgroupSize[1], 1u),
+                                    std::max(cmd.threadgroupSize[2], 1u));
+        if (group.width == 0) {
+            group.width = pipeline.threadExecutionWidth;
+            group.height = cmd.gridHeight > 1 || cmd.gridDepth > 1
+                ? std::max<NSUInteger>(pipeline.maxTotalThreadsPerThreadgroup / group.width, 1)
+                : 1;
+            group.depth = 1;
+        }
+        if (group.width * group.height * group.depth > pipeline.maxTotalThreadsPerThreadgroup) {
+            METAL_LOG_ERROR(@"MetalRenderer: Threadgroup of %lu threads exceeds the pipeline limit of %lu",
+                            (unsigned long)(group.width * group.height * group.depth),
+                            (unsigned long)pipeline.maxTotalThreadsPerThreadgroup);
+            [encoder endEncoding];
+            return false;
+        }
+        const MTLSize groups = MTLSizeMake((cmd.threadCount + group.width - 1) / group.width,
+                                           (cmd.gridHeight + group.height - 1) / group.height,
+                                           (cmd.gridDepth + group.depth - 1) / group.depth);
+        [encoder dispatchThreadgroups:groups threadsPerThreadgroup:group];
+        [encoder endEncoding];
+        return true;
+    }
+}
+
+bool MetalRenderer::Impl::executeReadbackTexture(const ReadbackTextureCommand& cmd) {
+    @autoreleasepool {
+        id<MTLTexture> texture = (__bridge id<MTLTexture>)cmd.texture;
+        id<MTLBuffer> buffer = (__bridge id<MTLBuffer>)cmd.buffer;
+        const uint64_t readbackId = cmd.readbackId;
+        resolveRasterizationRate(cmd.texture);
+        const ReadbackCompletion completion = cmd.completion;
+
+        const uint64_t bytes = static_cast<uint64_t>(cmd.bytesPerRow) * cmd.height;
+        if (texture.sampleCount > 1 || cmd.x + cmd.width > texture.width ||
+            cmd.y + cmd.height > texture.height || cmd.bufferOffset + bytes > buffer.length) {
+            METAL_LOG_ERROR(@"MetalRenderer: Invalid texture readback");
+            completion(readbackId, false);
+            return false;
+        }
+
+        // Blits cannot run inside a render encoder; the next encoder on the
+        // pass resumes with its attachments loaded
+        endCurrentEncoder();
+
+        id<MTLBlitCommandEncoder> encoder = [currentCommandBuffer blitCommandEncoder];
+        if (!encoder) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create blit encoder");
+            completion(readbackId, false);
+            return false;
+        }
+        encoder.label = @"Texture Readback";
+        [encoder copyFromTexture:texture
+                     sourceSlice:0
+                     sourceLevel:0
+                    sourceOrigin:MTLOriginMake(cmd.x, cmd.y, 0)
+                      sourceSize:MTLSizeMake(cmd.width, cmd.height, 1)
+                        toBuffer:buffer
+               destinationOffset:cmd.bufferOffset
+          destinationBytesPerRow:cmd.bytesPerRow
+        destinationBytesPerImage:bytes];
+        [encoder endEncoding];
+
+        // The buffer holds the texels once the whole frame has finished
+        [currentCommandBuffer addCompletedHandler:^(id<MTLCommandBuffer> commandBuffer) {
+            completion(readbackId, commandBuffer.status == MTLCommandBufferStatusCompleted);
+        }];
+        return true;
+    }
+}
+
+bool MetalRenderer::Impl::executeGenerateMipmaps(const GenerateMipmapsCommand& cmd) {
+    @autoreleasepool {
+        id<MTLTexture> texture = (__bridge id<MTLTexture>)cmd.texture;
+        if (texture.mipmapLevelCount <= 1) {
+            return true;  // No mip storage: nothing to rebuild, keep the pass
+        }
+
+        endCurrentEncoder();
+
+        id<MTLBlitCommandEncoder> encoder = [currentCommandBuffer blitCommandEncoder];
+        if (!encoder) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create blit encoder");
+            return false;
+        }
+        encoder.label = @"Generate Mipmaps";
+        [encoder generateMipmapsForTexture:texture];
+        [encoder endEncoding];
+        return true;
+    }
+}
+
+bool MetalRenderer::Impl::executeConvertYCbCr(const ConvertYCbCrCommand& cmd) {
+    @autoreleasepool {
+        id<MTLTexture> luma = (__bridge id<MTLTexture>)cmd.luma;
+        id<MTLTexture> chroma = (__bridge id<MTLTexture>)cmd.chroma;
+        id<MTLTexture> destination = (__bridge id<MTLTexture>)cmd.destination;
+        if (!(destination.usage & MTLTextureUsageShaderWrite)) {
+            METAL_LOG_ERROR(@"MetalRenderer: Invalid YCbCr conversion");
+            return false;
+        }
+
+        // Levels are expanded to [0, 1] (video range: luma 16-235, chroma
+        // 16-240) and centred chroma is mixed by the matrix, all folded into
+        // one affine transform per channel (YCbCrUniforms in ImageFilter.metal)
+        const float lumaScale = cmd.fullRange ? 1.0f : 255.0f / 219.0f;
+        const float lumaBias = cmd.fullRange ? 0.0f : -16.0f / 219.0f;
+        const float chromaScale = cmd.fullRange ? 1.0f : 255.0f / 224.0f;
+        const float chromaBias = -128.0f / 255.0f * chromaScale;
+        const bool bt709 = cmd.matrix == YCbCrMatrix::BT709;
+        const float crToR = bt709 ? 1.5748f : 1.402f;
+        const float cbToG = bt709 ? -0.187324f : -0.344136f;
+        const float crToG = bt709 ? -0.468124f : -0.714136f;
+        const float cbToB = bt709 ? 1.8556f : 1.772f;
+
+        struct {
+            simd_float4 r, g, b;  // Dotted with (y, cb, cr, 1)
+        } uniforms;
+        uniforms.r = simd_make_float4(lumaScale, 0.0f, crToR * chromaScale,
+                                      lumaBias + crToR * chromaBias);
+        uniforms.g = simd_make_float4(lumaScale, cbToG * chromaScale, crToG * chromaScale,
+                                      lumaBias + (cbToG + crToG) * chromaBias);
+        uniforms.b = simd_make_float4(lumaScale, cbToB * chromaScale, 0.0f,
+                                      lumaBias + cbToB * chromaBias);
+
+        // The kernel encodes its own compute pass; the next encoder on the
+        // pass resumes with its attachments loaded
+        endCurrentEncoder();
+        return encodeImageKernel("ycbcrToRGB", {luma, chroma, destination}, &uniforms, sizeof(uniforms),
+                                 std::min(luma.width, destination.width),
+                                 std::min(luma.height, destination.height));
+    }
+}
+
+bool MetalRenderer::Impl::executeConvertYCoCg(const ConvertYCoCgCommand& cmd) {
+    @autoreleasepool {
+        id<MTLTexture> color = (__bridge id<MTLTexture>)cmd.color;
+        id<MTLTexture> alpha = (__bridge id<MTLTexture>)cmd.alpha;
+        id<MTLTexture> destination = (__bridge id<MTLTexture>)cmd.destination;
+        if (!(destination.usage & MTLTextureUsageShaderWrite)) {
+            METAL_LOG_ERROR(@"MetalRenderer: Invalid YCoCg conversion");
+            return false;
+        }
+
+        // Without an alpha plane the color texture fills the slot unread
+        const uint32_t hasAlpha = alpha ? 1 : 0;
+        endCurrentEncoder();
+        return encodeImageKernel("ycocgToRGB", {color, alpha ?: color, destination}, &hasAlpha, sizeof(hasAlpha),
+                                 std::min(color.width, destination.width),
+                                 std::min(color.height, destination.height));
+    }
+}
+
+bool MetalRenderer::Impl::executeCopyTexture(const CopyTextureCommand& cmd) {
+    @autoreleasepool {
+        id<MTLTexture> source = (__bridge id<MTLTexture>)cmd.source;
+        id<MTLTexture> destination = (__bridge id<MTLTexture>)cmd.destination;
+        const uint64_t copyId = cmd.copyId;
+        const ReadbackCompletion completion = cmd.completion;
+        resolveRasterizationRate(cmd.source);
+        if (!source) {
+            // The screen as drawn so far this frame
+            MTLRenderPassDescriptor* screenPass = frameRenderPass ? frameRenderPass : view.currentRenderPassDescriptor;
+            source = screenPass.colorAttachments[0].resolveTexture ?: screenPass.colorAttachments[0].texture;
+        }
+        if (!source || source.sampleCount > 1 || !(source.usage & MTLTextureUsageShaderRead) ||
+            !(destination.usage & MTLTextureUsageShaderWrite)) {
+            METAL_LOG_ERROR(@"MetalRenderer: Invalid texture copy");
+            if (completion) {
+                completion(copyId, false);
+            }
+            return false;
+        }
+
+        const NSUInteger width = cmd.sourceWidth ? std::min<NSUInteger>(cmd.sourceWidth, source.width)
+                                                 : source.width;
+        const NSUInteger height = cmd.sourceHeight ? std::min<NSUInteger>(cmd.sourceHeight, source.height)
+                                                   : source.height;
+
+        // Both paths encode their own pass; the next encoder on the pass
+        // resumes with its attachments loaded. MetalFX keeps source alpha.
+        endCurrentEncoder();
+        const bool upscaled = cmd.filter == CopyTextureFilter::Upscale && !cmd.opaque &&
+                              encodeSpatialUpscale(source, destination, width, height);
+
+        // CopyUniforms in ImageFilter.metal
+        struct {
+            uint32_t opaque;
+            simd_float2 sourceScale;
+        } uniforms;
+        uniforms.opaque = cmd.opaque ? 1 : 0;
+        uniforms.sourceScale = simd_make_float2(static_cast<float>(width) / source.width,
+                                                static_cast<float>(height) / source.height);
+        if (!upscaled && !encodeImageKernel("copyTexture", {source, destination}, &uniforms, sizeof(uniforms),
+                                            destination.width, destination.height)) {
+            if (completion) {
+                completion(copyId, false);
+            }
+            return false;
+        }
+
+        if (completion) {
+            [currentCommandBuffer addCompletedHandler:^(id<MTLCommandBuffer> commandBuffer) {
+                completion(copyId, commandBuffer.status == MTLCommandBufferStatusCompleted);
+            }];
+        }
+        return true;
+    }
+}
+
+bool MetalRenderer::Impl::encodeSpatialUpscale(id<MTLTexture> source, id<MTLTexture> destination,
+                                               NSUInteger width, NSUInteger height) {
+    // The scaler writes private render targets only
+    if (![MTLFXSpatialScalerDescriptor supportsDevice:device] ||
+        destination.storageMode != MTLStorageModePrivate) {
+        return false;
+    }
+
+    // Content size changes per frame; the textures it lives in rarely do
+    if (!spatialScaler || spatialScaler.inputWidth != source.width || spatialScaler.inputHeight != source.height ||
+        spatialScaler.outputWidth != destination.width || spatialScaler.outputHeight != destination.height ||
+        spatialScaler.colorTextureFormat != source.pixelFormat ||
+        spatialScaler.outputTextureFormat != destination.pixelFormat) {
+        MTLFXSpatialScalerDescriptor* desc = [[MTLFXSpatialScalerDescriptor alloc] init];
+        desc.inputWidth = source.width;
+        desc.inputHeight = source.height;
+        desc.outputWidth = destination.width;
+        desc.outputHeight = destination.height;
+        desc.colorTextureFormat = source.pixelFormat;
+        desc.outputTextureFormat = destination.pixelFormat;
+        desc.colorProcessingMode = MTLFXSpatialScalerColorProcessingModePerceptual;
+        spatialScaler = [desc newSpatialScalerWithDevice:device];
+        if (!spatialScaler) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create MetalFX spatial scaler");
+            return false;
+        }
+    }
+    if ((source.usage & spatialScaler.colorTextureUsage) != spatialScaler.colorTextureUsage ||
+        (destination.usage & spatialScaler.outputTextureUsage) != spatialScaler.outputTextureUsage) {
+        return false;
+    }
+
+    spatialScaler.colorTexture = source;
+    spatialScaler.outputTexture = destination;
+    spatialScaler.inputContentWidth = width;
+    spatialScaler.inputContentHeight = height;
+    [spatialScaler encodeToCommandBuffer:currentCommandBuffer];
+    return true;
+}
+
+bool MetalRenderer::Impl::executeFilterTexture(const FilterTextureCommand& cmd) {
+    @autoreleasepool {
+        id<MTLTexture> source = (__bridge id<MTLTexture>)cmd.source;
+        id<MTLTexture> destination = (__bridge id<MTLTexture>)cmd.destination;
+        if (!MPSSupportsMTLDevice(device) || source.sampleCount > 1 ||
+            !(destination.usage & MTLTextureUsageShaderWrite)) {
+            METAL_LOG_ERROR(@"MetalRenderer: Invalid texture filter");
+            return false;
+        }
+
+        // Filters encode their own compute passes; the next encoder on the
+        // pass resumes with its attachments loaded
+        endCurrentEncoder();
+
+        const NSUInteger width = std::min(source.width, destination.width);
+        const NSUInteger height = std::min(source.height, destination.height);
+        if (cmd.filter == ImageFilterType::Point) {
+            // Fused per-pixel stages (PointUniforms in ImageFilter.metal)
+            struct {
+                uint32_t stageCount;
+                ImagePointStage stages[FilterTextureCommand::kMaxPointStages];
+            } uniforms;
+            uniforms.stageCount = cmd.pointStageCount;
+            std::copy(cmd.pointStages, cmd.pointStages + FilterTextureCommand::kMaxPointStages, uniforms.stages);
+            return encodeImageKernel("pointFilter", {source, destination}, &uniforms, sizeof(uniforms),
+                                     width, height);
+        }
+
+        if (cmd.filter != ImageFilterType::Unsharp) {
+            MPSUnaryImageKernel* kernel = getFilterKernel(cmd, cmd.filter);
+            if (!kernel) {
+                return false;
+            }
+            [kernel encodeToCommandBuffer:currentCommandBuffer
+                            sourceTexture:source
+                       destinationTexture:destination];
+            return true;
+        }
+
+        // Unsharp mask: blur into the scratch texture, then combine
+        MPSUnaryImageKernel* blur = getFilterKernel(cmd, ImageFilterType::GaussianBlur);
+        if (!blur) {
+            return false;
+        }
+        if (!filterScratch || filterScratch.width != source.width || filterScratch.height != source.height) {
+            MTLTextureDescriptor* desc = [MTLTextureDescriptor
+                texture2DDescriptorWithPixelFormat:MTLPixelFormatRGBA16Float
+                width:source.width
+                height:source.height
+                mipmapped:NO];
+            desc.usage = MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite;
+            desc.storageMode = MTLStorageModePrivate;
+            filterScratch = makeTrackedTexture(device, desc, oflike::ofGpuMemoryCategory::RenderTargets, "Filter Scratch");
+            if (!filterScratch) {
+                return false;
+            }
+        }
+        [blur encodeToCommandBuffer:currentCommandBuffer
+                      sourceTexture:source
+                 destinationTexture:filterScratch];
+
+        const float amount = cmd.amount;
+        return encodeImageKernel("unsharpMask", {source, filterScratch, destination}, &amount, sizeof(amount),
+                                 width, height);
+    }
+}
+
+bool MetalRenderer::Impl::encodeImageKernel(const char* functionName,
+                                            const std::initializer_list<id<MTLTexture>>& textures,
+                                            const void* bytes, size_t length,
+                                            NSUInteger width, NSUInteger height) {
+    id<MTLComputePipelineState> pipeline = getComputePipeline(functionName);
+    if (!pipeline) {
+        return false;
+    }
+
+    MTLComputePassDescriptor* computePass = [MTLComputePassDescriptor computePassDescriptor];
+    attachTimestamps(computePass, functionName);
+    id<MTLComputeCommandEncoder> encoder = [currentCommandBuffer computeCommandEncoderWithDescriptor:computePass];
+    if (!encoder) {
+        METAL_LOG_ERROR(@"MetalRenderer: Failed to create compute encoder");
+        return false;
+    }
+    dispatchImageKernel(encoder, pipeline, textures, bytes, length, width, height);
+    [encoder endEncoding];
+    return true;
+}
+
+void MetalRenderer::Impl::dispatchImageKernel(id<MTLComputeCommandEncoder> encoder,
+                                              id<MTLComputePipelineState> pipeline,
+                                              const std::initializer_list<id<MTLTexture>>& textures,
+                                              const void* bytes, size_t length,
+                                              NSUInteger width, NSUInteger height) {
+    [encoder setComputePipelineState:pipeline];
+    NSUInteger index = 0;
+    for (id<MTLTexture> texture : textures) {
+        [encoder setTexture:texture atIndex:index++];
+    }
+    if (bytes) {
+        [encoder setBytes:bytes length:length atIndex:0];
+    }
+
+    // Whole threadgroups over width x height; kernels bounds-check
+    const NSUInteger groupWidth = pipeline.threadExecutionWidth;
+    const NSUInteger groupHeight = std::max<NSUInteger>(1, pipeline.maxTotalThreadsPerThreadgroup / groupWidth);
+    [encoder dispatchThreadgroups:MTLSizeMake((width + groupWidth - 1) / groupWidth,
+                                              (height + groupHeight - 1) / groupHeight, 1)
+            threadsPerThreadgroup:MTLSizeMake(groupWidth, groupHeight, 1)];
+}
+
+MPSUnaryImageKernel* MetalRenderer::Impl::getFilterKernel(const FilterTextureCommand& cmd, ImageFilterType filter) {
+    FilterKernel& cached = filterKernels[static_cast<size_t>(filter)];
+    const bool usesWeights = filter == ImageFilterType::Convolve;
+    const size_t weightCount = usesWeights ? cmd.kernelWidth * cmd.kernelHeight : 0;
+    if (cached.kernel && cached.kernelWidth == cmd.kernelWidth && cached.kernelHeight == cmd.kernelHeight &&
+        cached.sigma == cmd.sigma && cached.weights.size() == weightCount &&
+        std::equal(cached.weights.begin(), cached.weights.end(), cmd.weights)) {
+        return cached.kernel;
+    }
+
+    MPSUnaryImageKernel* kernel = nil;
+    switch (filter) {
+        case ImageFilterType::GaussianBlur:
+        case ImageFilterType::Unsharp:
+            kernel = [[MPSImageGaussianBlur alloc] initWithDevice:device sigma:cmd.sigma];
+            break;
+        case ImageFilterType::BoxBlur:
+            kernel = [[MPSImageBox alloc] initWithDevice:device
+                                             kernelWidth:cmd.kernelWidth
+                                            kernelHeight:cmd.kernelHeight];
+            break;
+        case ImageFilterType::Sobel:
+            kernel = [[MPSImageSobel alloc] initWithDevice:device];
+            break;
+        case ImageFilterType::Dilate:
+            kernel = [[MPSImageAreaMax alloc] initWithDevice:device
+                                                 kernelWidth:cmd.kernelWidth
+                                                kernelHeight:cmd.kernelHeight];
+            break;
+        case ImageFilterType::Erode:
+            kernel = [[MPSImageAreaMin alloc] initWithDevice:device
+                                                 kernelWidth:cmd.kernelWidth
+                                                kernelHeight:cmd.kernelHeight];
+            break;
+        case ImageFilterType::Convolve:
+            kernel = [[MPSImageConvolution alloc] initWithDevice:device
+                                                     kernelWidth:cmd.kernelWidth
+                                                    kernelHeight:cmd.kernelHeight
+                                                         weights:cmd.weights];
+            break;
+        case ImageFilterType::Median:
+            kernel = [[MPSImageMedian alloc] initWithDevice:device kernelDiameter:cmd.kernelWidth];
+            break;
+        case ImageFilterType::Point:
+            break;  // Custom kernel, see executeFilterTexture()
+    }
+    if (!kernel) {
+        METAL_LOG_ERROR(@"MetalRenderer: Failed to create image filter %u", (uint32_t)filter);
+        return nil;
+    }
+    kernel.edgeMode = MPSImageEdgeModeClamp;
+
+    cached.kernel = kernel;
+    cached.kernelWidth = cmd.kernelWidth;
+    cached.kernelHeight = cmd.kernelHeight;
+    cached.sigma = cmd.sigma;
+    cached.weights.assign(cmd.weights, cmd.weights + weightCount);
+    return kernel;
+}
+
+bool MetalRenderer::Impl::executePostProcess(const PostProcessCommand& cmd) {
+    @autoreleasepool {
+        id<MTLTexture> source = (__bridge id<MTLTexture>)cmd.source;
+        id<MTLTexture> destination = (__bridge id<MTLTexture>)cmd.destination;
+        if (source.sampleCount > 1 || !(destination.usage & MTLTextureUsageShaderWrite)) {
+            METAL_LOG_ERROR(@"MetalRenderer: Invalid post-processing textures");
+            return false;
+        }
+
+        // Passes encode their own compute passes; the next encoder on the
+        // pass resumes with its attachments loaded
+        endCurrentEncoder();
+
+        const NSUInteger width = std::min(source.width, destination.width);
+        const NSUInteger height = std::min(source.height, destination.height);
+
+        // Worst case live at once: two full-size images and one bloom chain
+        // (down and up levels); aliasing keeps the heap at that across passes
+        // and stacks
+        auto heapBytes = [this](NSUInteger w, NSUInteger h) {
+            MTLTextureDescriptor* desc = [MTLTextureDescriptor
+                texture2DDescriptorWithPixelFormat:MTLPixelFormatRGBA16Float width:w height:h mipmapped:NO];
+            desc.usage = MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite;
+            desc.storageMode = MTLStorageModePrivate;
+            const MTLSizeAndAlign sizeAndAlign = [device heapTextureSizeAndAlignWithDescriptor:desc];
+            return (sizeAndAlign.size + sizeAndAlign.align - 1) / sizeAndAlign.align * sizeAndAlign.align;
+        };
+        NSUInteger bloomSize = 0;
+        for (uint32_t i = 0; i < cmd.passCount; ++i) {
+            if (cmd.passes[i].type == PostProcessPassType::Bloom) {
+                NSUInteger chain = 0;
+                for (uint32_t level = 1; level <= cmd.passes[i].levels; ++level) {
+                    chain += 2 * heapBytes(std::max<NSUInteger>(1, width >> level),
+                                           std::max<NSUInteger>(1, height >> level));
+                }
+                bloomSize = std::max(bloomSize, chain);
+            }
+        }
+        if (!reservePostHeap(2 * heapBytes(width, height) + bloomSize)) {
+            return false;
+        }
+
+        id<MTLTexture> current = source;
+        id<MTLTexture> bloom = nil;
+        float bloomIntensity = 0.0f;
+        auto release = [&source](id<MTLTexture> texture) {
+            if (texture && texture != source) {
+                [texture makeAliasable];
+            }
+        };
+
+        for (uint32_t i = 0; i < cmd.passCount; ++i) {
+            const PostProcessPass& pass = cmd.passes[i];
+            const bool last = i + 1 == cmd.passCount;
+            if (pass.type == PostProcessPassType::Bloom) {
+                release(bloom);
+                bloom = encodeBloom(pass, current, width, height);
+                if (!bloom) {
+                    return false;
+                }
+                bloomIntensity = pass.params[1] / static_cast<float>(pass.levels);  // Levels add up
+                if (!last && cmd.passes[i + 1].type == PostProcessPassType::Fused) {
+                    continue;   // Composited by the next fused pass
+                }
+
+                // Nothing to fuse the composite into
+                id<MTLTexture> output = last ? destination : newPostTexture(width, height);
+                if (!output || !encodePostFused(cmd, nullptr, current, bloom, bloomIntensity, output, width, height)) {
+                    return false;
+                }
+                release(bloom);
+                bloom = nil;
+                release(current);
+                current = output;
+                continue;
+            }
+
+            id<MTLTexture> output = last ? destination : newPostTexture(width, height);
+            if (!output) {
+                return false;
+            }
+            if (pass.type == PostProcessPassType::Fused) {
+                if (!encodePostFused(cmd, &pass, current, bloom, bloomIntensity, output, width, height)) {
+                    return false;
+                }
+                release(bloom);
+                bloom = nil;
+            } else {
+                FilterTextureCommand blurSettings;
+                blurSettings.sigma = pass.params[0];
+                MPSUnaryImageKernel* blur = MPSSupportsMTLDevice(device)
+                    ? getFilterKernel(blurSettings, ImageFilterType::GaussianBlur) : nil;
+                if (!blur) {
+                    return false;
+                }
+                [blur encodeToCommandBuffer:currentCommandBuffer sourceTexture:current destinationTexture:output];
+            }
+            release(current);
+            current = output;
+        }
+        return true;
+    }
+}
+
+bool MetalRenderer::Impl::encodePostFused(const PostProcessCommand& cmd, const PostProcessPass* pass,
+                                          id<MTLTexture> input, id<MTLTexture> bloom, float bloomIntensity,
+                                          id<MTLTexture> output, NSUInteger width, NSUInteger height) {
+    // PostFusedUniforms in PostProcess.metal
+    struct {
+        uint32_t stageCount;
+        float bloomIntensity;
+        PostProcessStage stages[PostProcessCommand::kMaxStages];
+    } uniforms;
+    uniforms.stageCount = pass ? pass->stageCount : 0;
+    uniforms.bloomIntensity = bloom ? bloomIntensity : 0.0f;
+    if (pass) {
+        std::copy(cmd.stages + pass->firstStage, cmd.stages + pass->firstStage + pass->stageCount, uniforms.stages);
+    }
+    return encodeImageKernel("postFused", {input, bloom ? bloom : input, output}, &uniforms, sizeof(uniforms),
+                             width, height);
+}
+
+id<MTLTexture> MetalRenderer::Impl::encodeBloom(const PostProcessPass& pass, id<MTLTexture> input,
+                                                NSUInteger width, NSUInteger height) {
+    id<MTLComputePipelineState> downsample = getComputePipeline("bloomDownsample");
+    id<MTLComputePipelineState> upsample = getComputePipeline("bloomUpsample");
+    if (!downsample || !upsample) {
+        return nil;
+    }
+
+    // No levels below one pixel
+    uint32_t levels = 1;
+    while (levels < pass.levels && (std::min(width, height) >> (levels + 1)) > 0) {
+        levels++;
+    }
+    id<MTLTexture> down[PostProcessCommand::kMaxBloomLevels] = {nil};
+    for (uint32_t level = 0; level < levels; ++level) {
+        down[level] = newPostTexture(std::max<NSUInteger>(1, width >> (level + 1)),
+                                     std::max<NSUInteger>(1, height >> (level + 1)));
+        if (!down[level]) {
+            return nil;
+        }
+    }
+
+    // One serial encoder: Metal orders the dispatches by their textures
+    MTLComputePassDescriptor* computePass = [MTLComputePassDescriptor computePassDescriptor];
+    attachTimestamps(computePass, "bloom");
+    id<MTLComputeCommandEncoder> encoder = [currentCommandBuffer computeCommandEncoderWithDescriptor:computePass];
+    if (!encoder) {
+        METAL_LOG_ERROR(@"MetalRenderer: Failed to create compute encoder");
+        return nil;
+    }
+
+    // BloomDownsampleUniforms in PostProcess.metal; the input may be larger
+    // than the region
+    struct {
+        float sourceScale[2];
+        float threshold;
+        float padding;
+    } uniforms = {{static_cast<float>(width) / input.width, static_cast<float>(height) / input.height},
+                  std::max(0.0f, pass.params[0]), 0.0f};
+    id<MTLTexture> from = input;
+    for (uint32_t level = 0; level < levels; ++level) {
+        dispatchImageKernel(encoder, downsample, {from, down[level]}, &uniforms, sizeof(uniforms),
+                            down[level].width, down[level].height);
+        from = down[level];
+        uniforms.sourceScale[0] = uniforms.sourceScale[1] = 1.0f;
+        uniforms.threshold = 0.0f;
+    }
+
+    // Back up the chain, each level into a new texture; levels are released
+    // as soon as the next one up has read them
+    id<MTLTexture> result = down[levels - 1];
+    for (uint32_t level = levels - 1; level-- > 0;) {
+        id<MTLTexture> up = newPostTexture(down[level].width, down[level].height);
+        if (!up) {
+            [encoder endEncoding];
+            return nil;
+        }
+        dispatchImageKernel(encoder, upsample, {result, down[level], up}, nullptr, 0, up.width, up.height);
+        [result makeAliasable];
+        [down[level] makeAliasable];
+        result = up;
+    }
+    [encoder endEncoding];
+    return result;
+}
+
+bool MetalRenderer::Impl::reservePostHeap(NSUInteger size) {
+    if (postHeap && postHeap.size >= size) {
+        return true;
+    }
+
+    // Earlier heaps stay alive while their textures are in flight.
+    // Tracked, so Metal orders aliased textures by their use.
+    MTLHeapDescriptor* desc = [[MTLHeapDescriptor alloc] init];
+    desc.size = size;
+    desc.storageMode = MTLStorageModePrivate;
+    desc.hazardTrackingMode = MTLHazardTrackingModeTracked;
+    postHeap = makeTrackedHeap(device, desc, oflike::ofGpuMemoryCategory::RenderTargets, "Post-Processing Heap");
+    if (!postHeap) {
+        METAL_LOG_ERROR(@"MetalRenderer: Failed to create a %lu byte post-processing heap", (unsigned long)size);
+        return false;
+    }
+    return true;
+}
+
+id<MTLTexture> MetalRenderer::Impl::newPostTexture(NSUInteger width, NSUInteger height) {
+    MTLTextureDescriptor* desc = [MTLTextureDescriptor
+        texture2DDescriptorWithPixelFormat:MTLPixelFormatRGBA16Float width:width height:height mipmapped:NO];
+    desc.usage = MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite;
+    desc.storageMode = MTLStorageModePrivate;
+    id<MTLTexture> texture = [postHeap newTextureWithDescriptor:desc];
+    if (!texture) {
+        // Fragmented: continue in a heap twice the size
+        if (!reservePostHeap(postHeap.size * 2)) {
+            return nil;
+        }
+        texture = [postHeap newTextureWithDescriptor:desc];
+    }
+    if (!texture) {
+        METAL_LOG_ERROR(@"MetalRenderer: Failed to allocate a post-processing texture");
+    }
+    return texture;
+}
+
+id<MTLComputePipelineState> MetalRenderer::Impl::getComputePipeline(const char* functionName) {
+    std::lock_guard<std::mutex> lock(computeMutex);
+
+    // Failures are cached too, so a missing kernel is only looked up once
+    auto it = computePipelines.find(functionName);
+    if (it != computePipelines.end()) {
+        return it->second;
+    }
+
+    id<MTLComputePipelineState> pipeline = nil;
+    @autoreleasepool {
+        id<MTLFunction> function = shaderLibrary ? [shaderLibrary newFunctionWithName:@(functionName)] : nil;
+        if (function) {
+            NSError* error = nil;
+            // Labeled so compute passes are named in the GPU timeline
+            MTLComputePipelineDescriptor* desc = [[MTLComputePipelineDescriptor alloc] init];
+            desc.computeFunction = function;
+            desc.label = @(functionName);
+            pipeline = [device newComputePipelineStateWithDescriptor:desc
+                                                             options:MTLPipelineOptionNone
+                                                          reflection:nil
+                                                               error:&error];
+            if (!pipeline) {
+                METAL_LOG_ERROR(@"MetalRenderer: Failed to create compute pipeline %s: %@",
+                      functionName, error.localizedDescription);
+            }
+        } else {
+            METAL_LOG_ERROR(@"MetalRenderer: Compute function %s not found", functionName);
+        }
+    }
+    computePipelines[functionName] = pipeline;
+    return pipeline;
+}
+
+void MetalRenderer::Impl::applyBlendMode(BlendMode mode) {
+    currentBlendMode = mode;
+    // Blend mode is applied via pipeline state selection in executeDraw2D/3D
+    // No runtime state change needed - Metal requires blend state in PSO
+}
+
+void MetalRenderer::Impl::applyDepthState(bool enabled) {
+    depthTestEnabled = enabled;
+    if (currentEncoder) {
+        bindDepthStencilState(enabled ? depthEnabledState : depthDisabledState);
+    }
+}
+
+// ============================================================================
+// Encoder Shadow State
+// ============================================================================
+
+void MetalRenderer::Impl::bindPipeline(id<MTLRenderPipelineState> pipeline) {
+    if (pipeline == encoderState.pipeline) {
+        frameSkippedStateChanges++;
+        return;
+    }
+    [currentEncoder setRenderPipelineState:pipeline];
+    encoderState.pipeline = pipeline;
+}
+
+void MetalRenderer::Impl::bindDepthStencilState(id<MTLDepthStencilState> state) {
+    if (state == encoderState.depthStencil) {
+        frameSkippedStateChanges++;
+        return;
+    }
+    [currentEncoder setDepthStencilState:state];
+    encoderState.depthStencil = state;
+}
+
+void MetalRenderer::Impl::bindVertexBuffer(id<MTLBuffer> buffer, NSUInteger offset) {
+    if (buffer == encoderState.vertexBuffer) {
+        if (offset == encoderState.vertexBufferOffset) {
+            frameSkippedStateChanges++;
+            return;
+        }
+        // Same buffer, new batch: only move the offset
+        [currentEncoder setVertexBufferOffset:offset atIndex:0];
+    } else {
+        [currentEncoder setVertexBuffer:buffer offset:offset atIndex:0];
+        encoderState.vertexBuffer = buffer;
+    }
+    encoderState.vertexBufferOffset = offset;
+}
+
+void MetalRenderer::Impl::bindVertexUniforms(const void* bytes, size_t length) {
+    if (length == encoderState.vertexUniformsSize &&
+        std::memcmp(bytes, encoderState.vertexUniforms, length) == 0) {
+        frameSkippedStateChanges++;
+        return;
+    }
+    [currentEncoder setVertexBytes:bytes length:length atIndex:1];
+    if (length <= sizeof(encoderState.vertexUniforms)) {
+        std::memcpy(encoderState.vertexUniforms, bytes, length);
+        encoderState.vertexUniformsSize = length;
+    } else {
+        encoderState.vertexUniformsSize = 0;
+    }
+}
+
+void MetalRenderer::Impl::bindFragmentUniforms(const void* bytes, size_t length) {
+    if (length == encoderState.fragmentUniformsSize &&
+        std::memcmp(bytes, encoderState.fragmentUniforms, length) == 0) {
+        frameSkippedStateChanges++;
+        return;
+    }
+    [currentEncoder setFragmentBytes:bytes length:length atIndex:1];
+    if (length <= sizeof(encoderState.fragmentUniforms)) {
+        std::memcpy(encoderState.fragmentUniforms, bytes, length);
+        encoderState.fragmentUniformsSize = length;
+    } else {
+        encoderState.fragmentUniformsSize = 0;
+    }
+}
+
+void MetalRenderer::Impl::bindFragmentTexture(id<MTLTexture> texture, uint32_t index) {
+    if (index >= 16) {
+        return;
+    }
+    if (texture == encoderState.fragmentTextures[index]) {
+        frameSkippedStateChanges++;
+        return;
+    }
+    [currentEncoder setFragmentTexture:texture atIndex:index];
+    encoderState.fragmentTextures[index] = texture;
+}
+
+void MetalRenderer::Impl::bindFragmentSampler(id<MTLSamplerState> sampler) {
+    if (sampler == encoderState.fragmentSampler) {
+        frameSkippedStateChanges++;
+        return;
+    }
+    [currentEncoder setFragmentSamplerState:sampler atIndex:0];
+    encoderState.fragmentSampler = sampler;
+}
+
+void MetalRenderer::Impl::bindCullMode(MTLCullMode mode) {
+    if ((int)mode == encoderState.cullMode) {
+        frameSkippedStateChanges++;
+        return;
+    }
+    [currentEncoder setCullMode:mode];
+    encoderState.cullMode = (int)mode;
+}
+
+// ============================================================================
+// MetalRenderer Public Interface
+// ============================================================================
+
+MetalRenderer::MetalRenderer(void* device, void* view)
+    : impl_(std::make_unique<Impl>(device, view))
+{}
+
+MetalRenderer::~MetalRenderer() = default;
+
+bool MetalRenderer::initialize() {
+    return impl_->initialize();
+}
+
+void MetalRenderer::shutdown() {
+    impl_->shutdown();
+}
+
+bool MetalRenderer::isInitialized() const {
+    return impl_->initialized;
+}
+
+bool MetalRenderer::beginFrame() {
+    if (!impl_) return false;
+    OF_PROFILE_SCOPE("beginFrame");     // Includes the wait for a free frame slot
+    return impl_->beginFrame();
+}
+
+bool MetalRenderer::endFrame() {
+    if (!impl_) return false;
+    OF_PROFILE_SCOPE("endFrame");
+    return impl_->endFrame();
+}
+
+uint32_t MetalRenderer::getCurrentFrameIndex() const {
+    return impl_->currentFrameIndex;
+}
+
+bool MetalRenderer::executeDrawList(const DrawList& drawList) {
+    if (!impl_->initialized) {
+        return false;
+    }
+
+    @autoreleasepool {
+        OF_PROFILE_SCOPE("executeDrawList");
+        impl_->flushTextureUploads();
+        impl_->frameCulledDraws += static_cast<uint32_t>(drawList.getCulledDrawCount());
+        {
+            OF_PROFILE_SCOPE("uploadDrawList");
+            if (!impl_->uploadDrawList(drawList)) {
+                return false;
+            }
+        }
+
+        // Frames with a pick request replay the list's screen draws with their IDs
+        const bool startsOnScreen = !impl_->currentRenderTarget;
+        if (!impl_->executeCommands(drawList)) {
+            return false;
+        }
+        return !impl_->objectIdPickPending || impl_->executeObjectIdPass(drawList, startsOnScreen);
+    }
+}
+
+bool MetalRenderer::executeDrawLists(const DrawList* const* drawLists, size_t count) {
+    if (!impl_->initialized || !impl_->currentCommandBuffer) {
+        return false;
+    }
+
+    // Attachments written by the frame's last list are not reloaded, so its
+    // final passes may discard depth
+    impl_->flushTextureUploads();
+    bool success = true;
+
+    // The first list may clear or switch targets; the rest share its final pass
+    size_t first = 0;
+    while (success && first < count && !Impl::isParallelEncodable(*drawLists[first])) {
+        impl_->listsFollow = first + 1 < count;
+        success = executeDrawList(*drawLists[first]);
+        ++first;
+    }
+
+    size_t parallelCount = 0;
+    for (size_t i = first; i < count; ++i) {
+        if (drawLists[i]->getCommandCount() > 0) {
+            ++parallelCount;
+        }
+    }
+
+    // A parallel encoder only pays off with several lists; a list that
+    // switches targets midway falls back to serial encoding for the remainder.
+    // Pick frames encode serially so each list replays into the ID target.
+    bool parallelOK = success && parallelCount > 1 && !impl_->objectIdPickPending;
+    for (size_t i = first; i < count && parallelOK; ++i) {
+        parallelOK = Impl::isParallelEncodable(*drawLists[i]);
+    }
+    if (parallelOK) {
+        impl_->listsFollow = false;
+        success = impl_->executeParallel(drawLists + first, count - first);
+        first = count;
+    }
+
+    for (size_t i = first; i < count && success; ++i) {
+        impl_->listsFollow = i + 1 < count;
+        success = executeDrawList(*drawLists[i]);
+    }
+
+    // Direct calls after this point still draw into the frame
+    impl_->listsFollow = true;
+    return success;
+}
 
-bool MetalRenderer::initialize() {
-    return impl_->initialize();
+size_t MetalRenderer::prewarm(const PipelineVariant* variants, size_t count) {
+    if (!impl_->initialized) {
+        return 0;
+    }
+    return impl_->prewarm(variants, count);
 }
 
-void MetalRenderer::shutdown() {
-    impl_->shutdown();
+void* MetalRenderer::createRenderPipelineState(void* descriptor, void** reflection) {
+    if (reflection) {
+        *reflection = nullptr;
+    }
+    if (!impl_->initialized || !descriptor) {
+        return nullptr;
+    }
+
+    NSError* error = nil;
+    __autoreleasing MTLRenderPipelineReflection* reflected = nil;
+    id<MTLRenderPipelineState> pipeline =
+        impl_->newPipelineState((__bridge MTLRenderPipelineDescriptor*)descriptor, &error,
+                                reflection ? &reflected : nullptr);
+    if (!pipeline) {
+        METAL_LOG_ERROR(@"MetalRenderer: Failed to create render pipeline: %@", error.localizedDescription);
+        return nullptr;
+    }
+    if (reflection && reflected) {
+        *reflection = (__bridge_retained void*)reflected;
+    }
+    return (__bridge_retained void*)pipeline;
 }
 
-bool MetalRenderer::isInitialized() const {
-    return impl_->initialized;
+void* MetalRenderer::getComputePipelineState(const char* functionName) {
+    if (!impl_->initialized || !functionName) {
+        return nullptr;
+    }
+    return (__bridge void*)impl_->getComputePipeline(functionName);
 }
 
-bool MetalRenderer::beginFrame() {
-    if (!impl_) return false;
-    return impl_->beginFrame();
+void MetalRenderer::setOcclusionCullingEnabled(bool enabled) {
+    impl_->occlusionCullingEnabled = enabled;
+    if (!enabled) {
+        impl_->occlusionPyramidValid = false;
+    }
 }
 
-bool MetalRenderer::endFrame() {
-    if (!impl_) return false;
-    return impl_->endFrame();
+void* MetalRenderer::getOcclusionPyramid() const {
+    return impl_->occlusionCullingEnabled && impl_->occlusionPyramidValid
+               ? (__bridge void*)impl_->occlusionPyramid
+               : nullptr;
 }
 
-uint32_t MetalRenderer::getCurrentFrameIndex() const {
-    return impl_->currentFrameIndex;
+void MetalRenderer::requestObjectIdPick(float x, float y) {
+    impl_->objectIdPickPending = true;
+    impl_->objectIdPickX = std::clamp(x, 0.0f, 1.0f);
+    impl_->objectIdPickY = std::clamp(y, 0.0f, 1.0f);
 }
 
-bool MetalRenderer::executeDrawList(const DrawList& drawList) {
-    if (!impl_->initialized) {
+bool MetalRenderer::getObjectIdPick(uint32_t& outObjectId, uint64_t& outFrameSerial) const {
+    std::lock_guard<std::mutex> lock(impl_->objectIdMutex);
+    if (impl_->objectIdResultSerial == 0) {
         return false;
     }
+    outObjectId = impl_->objectIdResult;
+    outFrameSerial = impl_->objectIdResultSerial;
+    return true;
+}
 
-    @autoreleasepool {
-        // Upload vertex data to GPU buffers
-        uint32_t frameIdx = impl_->currentFrameIndex;
-
-        // Upload 2D vertices
-        if (drawList.getVertex2DCount() > 0) {
-            size_t dataSize = drawList.getVertex2DDataSize();
-            if (dataSize > kMaxVertices2D * sizeof(Vertex2D)) {
-                NSLog(@"MetalRenderer: 2D vertex count exceeds buffer size");
-                return false;
-            }
-            void* bufferData = [impl_->vertexBuffer2D[frameIdx] contents];
-            std::memcpy(bufferData, drawList.getVertex2DData(), dataSize);
-        }
+bool MetalRenderer::supportsMeshPrimitives() const {
+    return impl_->meshShadersSupported;
+}
 
-        // Upload 3D vertices
-        if (drawList.getVertex3DCount() > 0) {
-            size_t dataSize = drawList.getVertex3DDataSize();
-            if (dataSize > kMaxVertices3D * sizeof(Vertex3D)) {
-                NSLog(@"MetalRenderer: 3D vertex count exceeds buffer size");
-                return false;
-            }
-            void* bufferData = [impl_->vertexBuffer3D[frameIdx] contents];
-            std::memcpy(bufferData, drawList.getVertex3DData(), dataSize);
-        }
+void MetalRenderer::setFrameTarget(void* drawable, void* renderPassDescriptor) {
+    impl_->frameDrawable = (__bridge id<CAMetalDrawable>)drawable;
+    impl_->frameRenderPass = (__bridge MTLRenderPassDescriptor*)renderPassDescriptor;
+}
 
-        // Upload indices
-        if (drawList.getIndexCount() > 0) {
-            size_t dataSize = drawList.getIndexDataSize();
-            if (dataSize > kMaxIndices * sizeof(uint32_t)) {
-                NSLog(@"MetalRenderer: Index count exceeds buffer size");
-                return false;
-            }
-            void* bufferData = [impl_->indexBuffer[frameIdx] contents];
-            std::memcpy(bufferData, drawList.getIndexData(), dataSize);
-        }
+bool MetalRenderer::bindFrameStorage(DrawList& drawList) {
+    if (!impl_->initialized || !impl_->currentCommandBuffer) {
+        return false;
+    }
 
-        // Execute all commands
-        const auto& commands = drawList.getCommands();
-        for (const auto& cmd : commands) {
-            if (!impl_->executeCommand(cmd, drawList)) {
-                NSLog(@"MetalRenderer: Command execution failed");
-                return false;
-            }
-        }
+    // Packing needs the vertices on the CPU; the packed streams are uploaded instead
+    if (drawList.isVertexCompressionEnabled()) {
+        return false;
+    }
 
-        return true;
+    // Carve this frame's mapping out of the ring, sized to the largest frame
+    // seen so far; beginFrame() already recycled the chunks the GPU finished
+    Impl& impl = *impl_;
+    impl.frameVertices2D = impl.geometryRing->allocate(impl.peakVertices2D * sizeof(Vertex2D), kGeometryAlignment);
+    impl.frameVertices3D = impl.geometryRing->allocate(impl.peakVertices3D * sizeof(Vertex3D), kGeometryAlignment);
+    impl.frameIndices = impl.geometryRing->allocate(impl.peakIndices * sizeof(uint32_t), kGeometryAlignment);
+    if (!impl.frameVertices2D || !impl.frameVertices3D || !impl.frameIndices) {
+        return false;
     }
+
+    DrawList::MappedStorage storage;
+    storage.vertices2D = (Vertex2D*)impl.frameVertices2D.contents;
+    storage.capacity2D = impl.peakVertices2D;
+    storage.vertices3D = (Vertex3D*)impl.frameVertices3D.contents;
+    storage.capacity3D = impl.peakVertices3D;
+    storage.indices = (uint32_t*)impl.frameIndices.contents;
+    storage.capacityIndices = impl.peakIndices;
+    return drawList.bindMappedStorage(storage);
 }
 
 void MetalRenderer::setViewport(float x, float y, float width, float height) {
@@ -1536,7 +6750,9 @@ void MetalRenderer::setBlendMode(BlendMode mode) {
 }
 
 void MetalRenderer::setDepthTestEnabled(bool enabled) {
-    impl_->applyDepthState(enabled);
+    // Recorded only: draws carry their own depth state, and this may be called
+    // from the recording thread while another thread encodes (pipelined frames)
+    impl_->depthTestEnabled = enabled;
 }
 
 void MetalRenderer::setDepthWriteEnabled(bool enabled) {
@@ -1561,34 +6777,494 @@ bool MetalRenderer::setRenderTarget(void* renderTarget) {
 }
 
 void* MetalRenderer::getDefaultRenderTarget() const {
+    if (impl_->frameDrawable) {
+        return (__bridge void*)impl_->frameDrawable.texture;
+    }
     return (__bridge void*)impl_->view.currentDrawable.texture;
 }
 
+bool MetalRenderer::setRasterizationRate(void* renderTarget, const RasterizationRate& rate) {
+    // Maps are built by the target's next pass, at its size then
+    if (rate.empty() || !impl_->initialized || !impl_->rateMapsSupported) {
+        impl_->rateTargets.erase(renderTarget);
+        return rate.empty();
+    }
+    Impl::RateTarget& target = impl_->rateTargets[renderTarget];
+    target.rate = rate;
+    target.map = nil;
+    return true;
+}
+
+int MetalRenderer::addDisplayOutput(void* metalLayer) {
+    CAMetalLayer* layer = (__bridge CAMetalLayer*)metalLayer;
+    if (!layer || !impl_->initialized) {
+        return -1;
+    }
+    layer.device = impl_->device;
+    std::lock_guard<std::mutex> lock(impl_->displayOutputMutex);
+    const int id = impl_->nextDisplayOutput++;
+    impl_->displayOutputs[id].layer = layer;
+    return id;
+}
+
+void MetalRenderer::removeDisplayOutput(int output) {
+    std::lock_guard<std::mutex> lock(impl_->displayOutputMutex);
+    impl_->displayOutputs.erase(output);
+}
+
+bool MetalRenderer::setDisplayOutputConfig(int output, const DisplayOutputConfig& config) {
+    const bool warped = !config.warpPoints.empty();
+    if (warped && (config.warpColumns == 0 || config.warpRows == 0 ||
+                   config.warpPoints.size() != (size_t)(config.warpColumns + 1) * (config.warpRows + 1))) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(impl_->displayOutputMutex);
+    auto it = impl_->displayOutputs.find(output);
+    if (it == impl_->displayOutputs.end()) {
+        return false;
+    }
+    it->second.config = config;
+    it->second.meshDirty = true;
+    return true;
+}
+
+void MetalRenderer::setDisplayOutputSource(void* texture) {
+    std::lock_guard<std::mutex> lock(impl_->displayOutputMutex);
+    impl_->displayOutputSource = (__bridge id<MTLTexture>)texture;
+}
+
 void* MetalRenderer::createTexture(uint32_t width, uint32_t height, const void* data) {
+    return createTexture(width, height, render::TextureFormat::RGBA8, data);
+}
+
+// Sampled texture in a CPU upload format, optionally with a full mip chain.
+// Private storage is filled by staged blits; the default (shared or
+// managed) storage takes CPU writes directly, for textures streamed often.
+static id<MTLTexture> makeSampledTexture(id<MTLDevice> device, uint32_t width, uint32_t height,
+                                         render::TextureFormat format, bool mipmapped, bool privateStorage) {
+    MTLPixelFormat pixelFormat = MTLPixelFormatRGBA8Unorm;
+    switch (format) {
+        case render::TextureFormat::R8:      pixelFormat = MTLPixelFormatR8Unorm; break;
+        case render::TextureFormat::RG8:     pixelFormat = MTLPixelFormatRG8Unorm; break;
+        case render::TextureFormat::RGBA8:   pixelFormat = MTLPixelFormatRGBA8Unorm; break;
+        case render::TextureFormat::R16:     pixelFormat = MTLPixelFormatR16Unorm; break;
+        case render::TextureFormat::RG16:    pixelFormat = MTLPixelFormatRG16Unorm; break;
+        case render::TextureFormat::RGBA16:  pixelFormat = MTLPixelFormatRGBA16Unorm; break;
+        case render::TextureFormat::R16F:    pixelFormat = MTLPixelFormatR16Float; break;
+        case render::TextureFormat::RGBA16F: pixelFormat = MTLPixelFormatRGBA16Float; break;
+        case render::TextureFormat::R32F:    pixelFormat = MTLPixelFormatR32Float; break;
+        case render::TextureFormat::RG32F:   pixelFormat = MTLPixelFormatRG32Float; break;
+        case render::TextureFormat::RGBA32F: pixelFormat = MTLPixelFormatRGBA32Float; break;
+    }
+
+    MTLTextureDescriptor* desc = [MTLTextureDescriptor
+        texture2DDescriptorWithPixelFormat:pixelFormat
+        width:width
+        height:height
+        mipmapped:mipmapped ? YES : NO];
+    desc.usage = MTLTextureUsageShaderRead;
+    if (privateStorage) {
+        desc.storageMode = MTLStorageModePrivate;
+    }
+
+    // Grayscale (+ alpha) formats are swizzled on sampling, so shaders
+    // and blending see RGBA without a CPU expansion
+    switch (format) {
+        case render::TextureFormat::R8:
+        case render::TextureFormat::R16:
+        case render::TextureFormat::R16F:
+        case render::TextureFormat::R32F:
+            desc.swizzle = MTLTextureSwizzleChannelsMake(MTLTextureSwizzleRed, MTLTextureSwizzleRed,
+                                                         MTLTextureSwizzleRed, MTLTextureSwizzleOne);
+            break;
+        case render::TextureFormat::RG8:
+        case render::TextureFormat::RG16:
+        case render::TextureFormat::RG32F:
+            desc.swizzle = MTLTextureSwizzleChannelsMake(MTLTextureSwizzleRed, MTLTextureSwizzleRed,
+                                                         MTLTextureSwizzleRed, MTLTextureSwizzleGreen);
+            break;
+        default:
+            break;
+    }
+
+    return makeTrackedTexture(device, desc, oflike::ofGpuMemoryCategory::Textures, "Texture");
+}
+
+// ============================================================================
+// Texture Uploads
+// ============================================================================
+
+// Bytes per texel of the uncompressed formats textures are created in
+static size_t texelBytes(MTLPixelFormat format) {
+    switch (format) {
+        case MTLPixelFormatR8Unorm:
+            return 1;
+        case MTLPixelFormatRG8Unorm:
+        case MTLPixelFormatR16Unorm:
+        case MTLPixelFormatR16Float:
+            return 2;
+        case MTLPixelFormatRGBA16Unorm:
+        case MTLPixelFormatRGBA16Float:
+        case MTLPixelFormatRG32Float:
+            return 8;
+        case MTLPixelFormatRGBA32Float:
+            return 16;
+        default:
+            return 4;
+    }
+}
+
+bool MetalRenderer::Impl::writeTexture(id<MTLTexture> texture, MTLRegion region, NSUInteger level,
+                                       const void* data, size_t bytesPerRow, size_t rowBytes, size_t rows) {
+    if (texture.storageMode == MTLStorageModePrivate) {
+        return stageTextureUpload(texture, region, level, data, bytesPerRow, rowBytes, rows);
+    }
+
+    OF_PROFILE_SCOPE("texture upload");
+    [texture replaceRegion:region mipmapLevel:level withBytes:data bytesPerRow:bytesPerRow];
+    return true;
+}
+
+bool MetalRenderer::Impl::stageTextureUpload(id<MTLTexture> texture, MTLRegion region, NSUInteger level,
+                                             const void* data, size_t bytesPerRow, size_t rowBytes,
+                                             size_t rows) {
+    OF_PROFILE_SCOPE("texture upload");
+    const size_t bytes = rowBytes * rows;
+    std::lock_guard<std::mutex> lock(uploadMutex);
+
+    size_t offset = (openUploads.used + kTextureUploadAlignment - 1) & ~(kTextureUploadAlignment - 1);
+    if (openUploads.buffer && offset + bytes > openUploads.buffer.length) {
+        // Full: copy what the batch holds now rather than grow past the budget.
+        // Frame command buffers commit later, so queue order keeps the copies
+        // ahead of every draw recorded after them.
+        if (!submitTextureUploads(openUploads)) {
+            return false;
+        }
+        offset = 0;
+    }
+
+    if (!openUploads.buffer) {
+        if (bytes > textureUploadBudget) {
+            // A single upload larger than the budget gets a batch of its own
+            openUploads.buffer = makeTrackedBuffer(device, bytes, MTLResourceStorageModeShared,
+                                                   oflike::ofGpuMemoryCategory::Streaming, "TextureStaging");
+        } else if (!freeStagingBuffers.empty()) {
+            openUploads.buffer = freeStagingBuffers.back();
+            freeStagingBuffers.pop_back();
+        } else {
+            openUploads.buffer = makeTrackedBuffer(device, textureUploadBudget, MTLResourceStorageModeShared,
+                                                   oflike::ofGpuMemoryCategory::Streaming, "TextureStaging");
+        }
+        if (!openUploads.buffer) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to create texture staging buffer (%zu bytes)",
+                            std::max(bytes, textureUploadBudget));
+            return false;
+        }
+        openUploads.buffer.label = @"TextureStaging";
+        offset = 0;
+    }
+
+    // Rows are packed tightly, whatever the source stride
+    uint8_t* dst = static_cast<uint8_t*>([openUploads.buffer contents]) + offset;
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    if (bytesPerRow == rowBytes) {
+        std::memcpy(dst, src, bytes);
+    } else {
+        for (size_t row = 0; row < rows; ++row) {
+            std::memcpy(dst + row * rowBytes, src + row * bytesPerRow, rowBytes);
+        }
+    }
+
+    TextureUpload upload;
+    upload.texture = texture;
+    upload.region = region;
+    upload.level = level;
+    upload.offset = offset;
+    upload.bytesPerRow = rowBytes;
+    upload.bytesPerImage = bytes;
+    openUploads.uploads.push_back(upload);
+    openUploads.used = offset + bytes;
+    return true;
+}
+
+void MetalRenderer::Impl::encodeTextureUploads(id<MTLCommandBuffer> commandBuffer, UploadBatch& batch) {
+    id<MTLBlitCommandEncoder> encoder = [commandBuffer blitCommandEncoder];
+    encoder.label = @"Texture Uploads";
+    for (const TextureUpload& upload : batch.uploads) {
+        [encoder copyFromBuffer:batch.buffer
+                   sourceOffset:upload.offset
+              sourceBytesPerRow:upload.bytesPerRow
+            sourceBytesPerImage:upload.bytesPerImage
+                     sourceSize:upload.region.size
+                      toTexture:upload.texture
+               destinationSlice:0
+               destinationLevel:upload.level
+              destinationOrigin:upload.region.origin];
+    }
+    [encoder endEncoding];
+
+    // Budget-sized buffers return to the pool once the copies are done;
+    // oversized ones are released
+    id<MTLBuffer> buffer = batch.buffer;
+    if (buffer.length == textureUploadBudget) {
+        Impl* impl = this;
+        [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer>) {
+            std::lock_guard<std::mutex> lock(impl->uploadMutex);
+            if (buffer.length == impl->textureUploadBudget) {
+                impl->freeStagingBuffers.push_back(buffer);
+            }
+        }];
+    }
+    batch = UploadBatch();
+}
+
+// Copy a batch in a command buffer of its own (uploadMutex held)
+bool MetalRenderer::Impl::submitTextureUploads(UploadBatch& batch) {
+    id<MTLCommandBuffer> commandBuffer = [commandQueue commandBuffer];
+    if (!commandBuffer) {
+        METAL_LOG_ERROR(@"MetalRenderer: Failed to create texture upload command buffer");
+        return false;
+    }
+    commandBuffer.label = @"TextureUploads";
+    encodeTextureUploads(commandBuffer, batch);
+    [commandBuffer commit];
+    return true;
+}
+
+// Copy pending uploads ahead of everything encoded next: into the frame's
+// command buffer between passes, otherwise on their own
+void MetalRenderer::Impl::flushTextureUploads() {
+    std::lock_guard<std::mutex> lock(uploadMutex);
+    if (openUploads.uploads.empty()) {
+        return;
+    }
+    OF_PROFILE_SCOPE("flushTextureUploads");
+    if (currentCommandBuffer && !currentEncoder) {
+        encodeTextureUploads(currentCommandBuffer, openUploads);
+    } else {
+        submitTextureUploads(openUploads);
+    }
+}
+
+void MetalRenderer::setTextureUploadBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(impl_->uploadMutex);
+    bytes = std::max(bytes, size_t(1024 * 1024));
+    if (bytes != impl_->textureUploadBudget) {
+        impl_->textureUploadBudget = bytes;
+        impl_->freeStagingBuffers.clear();
+    }
+}
+
+size_t MetalRenderer::getTextureUploadBudget() const {
+    std::lock_guard<std::mutex> lock(impl_->uploadMutex);
+    return impl_->textureUploadBudget;
+}
+
+// Tightly packed upload of a new texture's base level
+bool MetalRenderer::Impl::writeBaseLevel(id<MTLTexture> texture, const void* data) {
+    const size_t rowBytes = texture.width * texelBytes(texture.pixelFormat);
+    return writeTexture(texture, MTLRegionMake2D(0, 0, texture.width, texture.height), 0, data,
+                        rowBytes, rowBytes, texture.height);
+}
+
+void* MetalRenderer::createTexture(uint32_t width, uint32_t height, render::TextureFormat format, const void* data) {
+    @autoreleasepool {
+        id<MTLTexture> texture = makeSampledTexture(impl_->device, width, height, format, false, true);
+        if (!texture || (data && !impl_->writeBaseLevel(texture, data))) {
+            return nullptr;
+        }
+        return (__bridge_retained void*)texture;
+    }
+}
+
+void* MetalRenderer::createStreamingTexture(uint32_t width, uint32_t height, render::TextureFormat format) {
+    @autoreleasepool {
+        id<MTLTexture> texture = makeSampledTexture(impl_->device, width, height, format, false, false);
+        return texture ? (__bridge_retained void*)texture : nullptr;
+    }
+}
+
+void* MetalRenderer::createMipmappedTexture(uint32_t width, uint32_t height, render::TextureFormat format,
+                                            const void* data) {
     @autoreleasepool {
+        // Blit mipmap generation needs filterable formats; 32-bit float
+        // filtering is optional, so those keep a single level
+        bool mipmapped = true;
+        switch (format) {
+            case render::TextureFormat::R32F:
+            case render::TextureFormat::RG32F:
+            case render::TextureFormat::RGBA32F:
+                mipmapped = false;
+                break;
+            default:
+                break;
+        }
+        id<MTLTexture> texture = makeSampledTexture(impl_->device, width, height, format, mipmapped, true);
+        if (!texture || (data && !impl_->writeBaseLevel(texture, data))) {
+            return nullptr;
+        }
+        return (__bridge_retained void*)texture;
+    }
+}
+
+void* MetalRenderer::createWritableTexture(uint32_t width, uint32_t height, render::TextureFormat format) {
+    @autoreleasepool {
+        // RGBA only: writable textures can't carry the grayscale swizzles
+        MTLPixelFormat pixelFormat = MTLPixelFormatInvalid;
+        switch (format) {
+            case render::TextureFormat::RGBA8:   pixelFormat = MTLPixelFormatRGBA8Unorm; break;
+            case render::TextureFormat::RGBA16:  pixelFormat = MTLPixelFormatRGBA16Unorm; break;
+            case render::TextureFormat::RGBA16F: pixelFormat = MTLPixelFormatRGBA16Float; break;
+            case render::TextureFormat::RGBA32F: pixelFormat = MTLPixelFormatRGBA32Float; break;
+            default:
+                return nullptr;
+        }
+        if (width == 0 || height == 0) {
+            return nullptr;
+        }
+
         MTLTextureDescriptor* desc = [MTLTextureDescriptor
-            texture2DDescriptorWithPixelFormat:MTLPixelFormatRGBA8Unorm
+            texture2DDescriptorWithPixelFormat:pixelFormat
             width:width
             height:height
             mipmapped:NO];
+        desc.usage = MTLTextureUsageShaderRead | MTLTextureUsageShaderWrite;
+        desc.storageMode = MTLStorageModePrivate;
+
+        id<MTLTexture> texture = makeTrackedTexture(impl_->device, desc, oflike::ofGpuMemoryCategory::Textures,
+                                                    "Writable Texture");
+        if (!texture) {
+            return nullptr;
+        }
+        return (__bridge_retained void*)texture;
+    }
+}
+
+// Metal pixel format of a block-compressed format
+static MTLPixelFormat compressedPixelFormat(render::CompressedTextureFormat format) {
+    switch (format) {
+        case render::CompressedTextureFormat::ASTC4x4:   return MTLPixelFormatASTC_4x4_LDR;
+        case render::CompressedTextureFormat::ASTC5x5:   return MTLPixelFormatASTC_5x5_LDR;
+        case render::CompressedTextureFormat::ASTC6x6:   return MTLPixelFormatASTC_6x6_LDR;
+        case render::CompressedTextureFormat::ASTC8x8:   return MTLPixelFormatASTC_8x8_LDR;
+        case render::CompressedTextureFormat::ASTC10x10: return MTLPixelFormatASTC_10x10_LDR;
+        case render::CompressedTextureFormat::ASTC12x12: return MTLPixelFormatASTC_12x12_LDR;
+        case render::CompressedTextureFormat::BC1:       return MTLPixelFormatBC1_RGBA;
+        case render::CompressedTextureFormat::BC3:       return MTLPixelFormatBC3_RGBA;
+        case render::CompressedTextureFormat::BC7:       return MTLPixelFormatBC7_RGBAUnorm;
+        case render::CompressedTextureFormat::BC4:       return MTLPixelFormatBC4_RUnorm;
+    }
+    return MTLPixelFormatInvalid;
+}
+
+// Block format of a Metal pixel format; false for uncompressed formats
+static bool compressedFormatOf(MTLPixelFormat pixelFormat, render::CompressedTextureFormat& format) {
+    for (uint32_t i = 0; i <= static_cast<uint32_t>(render::CompressedTextureFormat::BC4); ++i) {
+        format = static_cast<render::CompressedTextureFormat>(i);
+        if (compressedPixelFormat(format) == pixelFormat) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MetalRenderer::supportsCompressedTextureFormat(render::CompressedTextureFormat format) const {
+    if (!impl_->device) {
+        return false;
+    }
+    switch (format) {
+        case render::CompressedTextureFormat::BC1:
+        case render::CompressedTextureFormat::BC3:
+        case render::CompressedTextureFormat::BC4:
+        case render::CompressedTextureFormat::BC7:
+            return impl_->device.supportsBCTextureCompression;
+        default:
+            // ASTC is sampled by Apple GPUs only
+            return [impl_->device supportsFamily:MTLGPUFamilyApple2];
+    }
+}
+
+void* MetalRenderer::createCompressedTexture(uint32_t width, uint32_t height, render::CompressedTextureFormat format,
+                                             const void* const* levels, uint32_t levelCount) {
+    if (width == 0 || height == 0 || !levels || levelCount == 0 ||
+        !supportsCompressedTextureFormat(format)) {
+        return nullptr;
+    }
+
+    @autoreleasepool {
+        MTLTextureDescriptor* desc = [MTLTextureDescriptor
+            texture2DDescriptorWithPixelFormat:compressedPixelFormat(format)
+            width:width
+            height:height
+            mipmapped:levelCount > 1];
+        if (levelCount > desc.mipmapLevelCount) {
+            return nullptr;
+        }
+        desc.mipmapLevelCount = levelCount;
         desc.usage = MTLTextureUsageShaderRead;
+        desc.storageMode = MTLStorageModePrivate;
 
-        id<MTLTexture> texture = [impl_->device newTextureWithDescriptor:desc];
+        id<MTLTexture> texture = makeTrackedTexture(impl_->device, desc, oflike::ofGpuMemoryCategory::Textures,
+                                                    "Compressed Texture");
         if (!texture) {
             return nullptr;
         }
 
-        if (data) {
-            [texture replaceRegion:MTLRegionMake2D(0, 0, width, height)
-                       mipmapLevel:0
-                         withBytes:data
-                       bytesPerRow:width * 4];
+        // Compressed rows are rows of blocks
+        const uint32_t blockSize = render::compressedBlockSize(format);
+        for (uint32_t level = 0; level < levelCount; ++level) {
+            const uint32_t levelWidth = std::max(1u, width >> level);
+            const uint32_t levelHeight = std::max(1u, height >> level);
+            const size_t bytesPerRow = ((levelWidth + blockSize - 1) / blockSize) *
+                                       render::compressedBlockBytes(format);
+            const size_t blockRows = (levelHeight + blockSize - 1) / blockSize;
+            if (!impl_->writeTexture(texture, MTLRegionMake2D(0, 0, levelWidth, levelHeight), level,
+                                     levels[level], bytesPerRow, bytesPerRow, blockRows)) {
+                return nullptr;
+            }
         }
 
+        texture.label = @"Compressed Texture";
         return (__bridge_retained void*)texture;
     }
 }
 
+bool MetalRenderer::updateTexture(void* texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+                                  const void* data, size_t bytesPerRow) {
+    if (!texture || !data || width == 0 || height == 0) {
+        return false;
+    }
+
+    @autoreleasepool {
+        id<MTLTexture> mtlTexture = (__bridge id<MTLTexture>)texture;
+        if (x + width > mtlTexture.width || y + height > mtlTexture.height) {
+            METAL_LOG_ERROR(@"MetalRenderer: Texture update region out of bounds");
+            return false;
+        }
+
+        // Compressed data is rows of whole blocks: the region starts on a
+        // block and ends on one or at the texture's edge
+        size_t rowBytes = static_cast<size_t>(width) * texelBytes(mtlTexture.pixelFormat);
+        size_t rows = height;
+        render::CompressedTextureFormat blockFormat;
+        if (compressedFormatOf(mtlTexture.pixelFormat, blockFormat)) {
+            const uint32_t block = render::compressedBlockSize(blockFormat);
+            if (x % block != 0 || y % block != 0 ||
+                (width % block != 0 && x + width != mtlTexture.width) ||
+                (height % block != 0 && y + height != mtlTexture.height)) {
+                METAL_LOG_ERROR(@"MetalRenderer: Compressed texture update not aligned to blocks");
+                return false;
+            }
+            rowBytes = ((width + block - 1) / block) * render::compressedBlockBytes(blockFormat);
+            rows = (height + block - 1) / block;
+        }
+
+        // Private textures queue the copy; streamed ones are written in place
+        return impl_->writeTexture(mtlTexture, MTLRegionMake2D(x, y, width, height), 0, data,
+                                   bytesPerRow, rowBytes, rows);
+    }
+}
+
 void* MetalRenderer::loadTexture(const char* path) {
     @autoreleasepool {
         NSString* nsPath = [NSString stringWithUTF8String:path];
@@ -1600,15 +7276,16 @@ void* MetalRenderer::loadTexture(const char* path) {
             MTKTextureLoaderOptionGenerateMipmaps: @YES
         };
 
-        id<MTLTexture> texture = [impl_->textureLoader
+        id<MTLTexture> texture = [impl_->getTextureLoader()
             newTextureWithContentsOfURL:url
             options:options
             error:&error];
 
         if (error) {
-            NSLog(@"MetalRenderer: Failed to load texture: %@", error.localizedDescription);
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to load texture: %@", error.localizedDescription);
             return nullptr;
         }
+        trackResource(texture, oflike::ofGpuMemoryCategory::Textures, nsPath.lastPathComponent.UTF8String);
 
         return (__bridge_retained void*)texture;
     }
@@ -1634,11 +7311,47 @@ bool MetalRenderer::readTexturePixels(void* texture, void* data, uint32_t width,
 
         // Read pixels from GPU texture to CPU memory
         MTLRegion region = MTLRegionMake2D(0, 0, width, height);
-        [mtlTexture getBytes:data
-                 bytesPerRow:bytesPerRow
-                  fromRegion:region
-                 mipmapLevel:0];
+        if (mtlTexture.storageMode != MTLStorageModePrivate) {
+            [mtlTexture getBytes:data
+                     bytesPerRow:bytesPerRow
+                      fromRegion:region
+                     mipmapLevel:0];
+            return true;
+        }
 
+        // Private storage: submit pending uploads (queue order runs them
+        // first), then copy through a shared buffer
+        {
+            std::lock_guard<std::mutex> lock(impl_->uploadMutex);
+            if (!impl_->openUploads.uploads.empty() && !impl_->submitTextureUploads(impl_->openUploads)) {
+                return false;
+            }
+        }
+        const size_t bytes = bytesPerRow * height;
+        id<MTLBuffer> readback = [impl_->device newBufferWithLength:bytes options:MTLResourceStorageModeShared];
+        id<MTLCommandBuffer> commandBuffer = [impl_->commandQueue commandBuffer];
+        if (!readback || !commandBuffer) {
+            METAL_LOG_ERROR(@"MetalRenderer: Failed to read back texture (%zu bytes)", bytes);
+            return false;
+        }
+        commandBuffer.label = @"TextureReadback";
+        id<MTLBlitCommandEncoder> encoder = [commandBuffer blitCommandEncoder];
+        [encoder copyFromTexture:mtlTexture
+                     sourceSlice:0
+                     sourceLevel:0
+                    sourceOrigin:region.origin
+                      sourceSize:region.size
+                        toBuffer:readback
+               destinationOffset:0
+          destinationBytesPerRow:bytesPerRow
+        destinationBytesPerImage:bytes];
+        [encoder endEncoding];
+        [commandBuffer commit];
+        [commandBuffer waitUntilCompleted];
+        if (commandBuffer.status != MTLCommandBufferStatusCompleted) {
+            return false;
+        }
+        std::memcpy(data, [readback contents], bytes);
         return true;
     }
 }
@@ -1660,10 +7373,117 @@ void MetalRenderer::getStatistics(uint32_t& outDrawCalls, uint32_t& outVertices)
     outVertices = impl_->frameVertices;
 }
 
+void MetalRenderer::getStatistics(uint32_t& outDrawCalls, uint32_t& outVertices,
+                                  uint32_t& outSkippedStateChanges) const {
+    getStatistics(outDrawCalls, outVertices);
+    outSkippedStateChanges = impl_->frameSkippedStateChanges;
+}
+
+void MetalRenderer::getStatistics(uint32_t& outDrawCalls, uint32_t& outVertices,
+                                  uint32_t& outSkippedStateChanges, uint32_t& outCulledDraws) const {
+    getStatistics(outDrawCalls, outVertices, outSkippedStateChanges);
+    outCulledDraws = impl_->frameCulledDraws;
+}
+
+void MetalRenderer::getGeometryBufferStatistics(size_t& outFrameBytes, size_t& outHighWaterMark,
+                                                size_t& outChunkCount) const {
+    const MetalRingAllocator* ring = impl_->geometryRing.get();
+    outFrameBytes = ring ? ring->getFrameBytes() : 0;
+    outHighWaterMark = ring ? ring->getHighWaterMark() : 0;
+    outChunkCount = ring ? ring->getFrameChunkCount() : 0;
+}
+
+void MetalRenderer::reserveGeometryBytes(size_t bytes) {
+    if (impl_->geometryRing) {
+        impl_->geometryRing->reserve(bytes);
+    }
+}
+
 double MetalRenderer::getLastGPUTime() const {
     return impl_->lastGPUTime;
 }
 
+void MetalRenderer::waitForFrames() {
+    if (!impl_->initialized || impl_->currentCommandBuffer) {
+        return;
+    }
+    // Completion handlers record GPU time before they free their slot
+    const uint32_t slots = impl_->framesInFlight - (impl_->slotAcquired ? 1 : 0);
+    for (uint32_t i = 0; i < slots; i++) {
+        dispatch_semaphore_wait(impl_->frameSemaphore, DISPATCH_TIME_FOREVER);
+    }
+    for (uint32_t i = 0; i < slots; i++) {
+        dispatch_semaphore_signal(impl_->frameSemaphore);
+    }
+}
+
+void MetalRenderer::setMaxFramesInFlight(uint32_t frames) {
+    frames = std::clamp<uint32_t>(frames, 1, kMaxFramesInFlight);
+    // Lowering the limit waits for the frames above it to complete
+    while (impl_->framesInFlight > frames) {
+        dispatch_semaphore_wait(impl_->frameSemaphore, DISPATCH_TIME_FOREVER);
+        impl_->framesInFlight--;
+    }
+    while (impl_->framesInFlight < frames) {
+        dispatch_semaphore_signal(impl_->frameSemaphore);
+        impl_->framesInFlight++;
+    }
+}
+
+uint32_t MetalRenderer::getMaxFramesInFlight() const {
+    return impl_->framesInFlight;
+}
+
+void MetalRenderer::acquireFrameSlot() {
+    if (!impl_->initialized || impl_->slotAcquired || impl_->currentCommandBuffer) {
+        return;
+    }
+    dispatch_semaphore_wait(impl_->frameSemaphore, DISPATCH_TIME_FOREVER);
+    impl_->slotAcquired = true;
+}
+
+void MetalRenderer::setPresentMinimumDuration(double seconds) {
+    impl_->presentMinimumDuration = std::max(seconds, 0.0);
+}
+
+uint64_t MetalRenderer::getRecordingFrameSerial() const {
+    return impl_->currentCommandBuffer ? impl_->frameSerial : impl_->frameSerial + 1;
+}
+
+bool MetalRenderer::getLastPresentedFrame(uint64_t& outFrameSerial, double& outPresentedTime) const {
+    std::lock_guard<std::mutex> lock(impl_->presentMutex);
+    if (impl_->presentedSerial == 0) {
+        return false;
+    }
+    outFrameSerial = impl_->presentedSerial;
+    outPresentedTime = impl_->presentedTime;
+    return true;
+}
+
+size_t MetalRenderer::getGPUTimeline(GPUPassTiming* outPasses, size_t maxPasses) const {
+    if (!outPasses) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(impl_->timelineMutex);
+    const size_t count = std::min(maxPasses, impl_->lastTimeline.size());
+    std::copy_n(impl_->lastTimeline.begin(), count, outPasses);
+    return count;
+}
+
+bool MetalRenderer::attachGPUTimestamps(void* passDescriptor, const char* name) {
+    if (!impl_->initialized || !passDescriptor) {
+        return false;
+    }
+    id descriptor = (__bridge id)passDescriptor;
+    if ([descriptor isKindOfClass:[MTLRenderPassDescriptor class]]) {
+        return impl_->attachTimestamps((MTLRenderPassDescriptor*)descriptor, name);
+    }
+    if ([descriptor isKindOfClass:[MTLComputePassDescriptor class]]) {
+        return impl_->attachTimestamps((MTLComputePassDescriptor*)descriptor, name);
+    }
+    return false;
+}
+
 void* MetalRenderer::getDevice() const {
     return (__bridge void*)impl_->device;
 }
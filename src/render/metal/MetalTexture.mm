@@ -1,4 +1,6 @@
 #import "MetalTexture.h"
+#import "MetalLog.h"
+#import "MetalAllocations.h"
 #import <Metal/Metal.h>
 #import <MetalKit/MetalKit.h>
 #import <Foundation/Foundation.h>
@@ -127,9 +129,9 @@ bool MetalTexture::create(uint32_t width, uint32_t height, TextureFormat format,
         desc.usage = MTLTextureUsageShaderRead;
         desc.storageMode = MTLStorageModeShared;
 
-        impl_->texture = [impl_->device newTextureWithDescriptor:desc];
+        impl_->texture = makeTrackedTexture(impl_->device, desc, oflike::ofGpuMemoryCategory::Textures, "MetalTexture");
         if (!impl_->texture) {
-            NSLog(@"MetalTexture: Failed to create texture %ux%u", width, height);
+            METAL_LOG_ERROR(@"MetalTexture: Failed to create texture %ux%u", width, height);
             return false;
         }
 
@@ -174,9 +176,10 @@ bool MetalTexture::loadFromFile(const char* path) {
                                                        error:&error];
 
         if (!impl_->texture || error) {
-            NSLog(@"MetalTexture: Failed to load texture from %s: %@", path, error);
+            METAL_LOG_ERROR(@"MetalTexture: Failed to load texture from %s: %@", path, error);
             return false;
         }
+        trackResource(impl_->texture, oflike::ofGpuMemoryCategory::Textures, nsPath.lastPathComponent.UTF8String);
 
         impl_->width = (uint32_t)impl_->texture.width;
         impl_->height = (uint32_t)impl_->texture.height;
@@ -340,7 +343,7 @@ MetalTexture* MetalTextureCache::load(const char* path) {
         // Load new texture
         auto texture = std::make_unique<MetalTexture>((__bridge void*)impl_->device);
         if (!texture->loadFromFile(path)) {
-            NSLog(@"MetalTextureCache: Failed to load texture: %s", path);
+            METAL_LOG_ERROR(@"MetalTextureCache: Failed to load texture: %s", path);
             return nullptr;
         }
 
@@ -360,7 +363,7 @@ MetalTexture* MetalTextureCache::create(uint32_t width, uint32_t height,
         // Create non-cached texture
         auto texture = std::make_unique<MetalTexture>((__bridge void*)impl_->device);
         if (!texture->create(width, height, format, data)) {
-            NSLog(@"MetalTextureCache: Failed to create texture %ux%u", width, height);
+            METAL_LOG_ERROR(@"MetalTextureCache: Failed to create texture %ux%u", width, height);
             return nullptr;
         }
 
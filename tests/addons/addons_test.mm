@@ -0,0 +1,359 @@
+// Addon Tests for oflike-metal
+// Tests the addon code that needs Apple frameworks (Foundation, dispatch,
+// simd) but no GPU
+
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include "ofxTcpStream.h"
+#include "SharpCameraPath.h"
+#include <simd/simd.h>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+// ANSI color codes for output
+#define GREEN "\033[32m"
+#define RED "\033[31m"
+#define YELLOW "\033[33m"
+#define RESET "\033[0m"
+
+// Test result tracking
+int g_totalTests = 0;
+int g_passedTests = 0;
+int g_failedTests = 0;
+
+// Floating point comparison tolerance
+const float EPSILON = 1e-5f;
+
+bool floatEquals(float a, float b, float epsilon = EPSILON) {
+    return std::abs(a - b) < epsilon;
+}
+
+void TEST_START(const char* name) {
+    std::cout << "\n[TEST] " << name << "\n";
+    g_totalTests++;
+}
+
+void TEST_PASS() {
+    std::cout << GREEN << "  ✓ PASS" << RESET << "\n";
+    g_passedTests++;
+}
+
+void TEST_FAIL(const char* message) {
+    std::cout << RED << "  ✗ FAIL: " << message << RESET << "\n";
+    g_failedTests++;
+}
+
+void REQUIRE(bool condition, const char* message) {
+    if (!condition) {
+        TEST_FAIL(message);
+        throw std::runtime_error(message);
+    }
+}
+
+void CHECK(bool condition, const char* message) {
+    if (condition) {
+        TEST_PASS();
+    } else {
+        TEST_FAIL(message);
+    }
+}
+
+// ============================================================
+// ofxTcpStream Tests
+// ============================================================
+
+// One received chunk, as the connection's queue hands it over
+static void appendChunk(ofxTcpStream& stream, const std::string& bytes) {
+    stream.append(dispatch_data_create(bytes.data(), bytes.size(), nullptr, DISPATCH_DATA_DESTRUCTOR_DEFAULT));
+}
+
+static std::string lengthPrefixed(const std::string& message) {
+    char header[4];
+    ofxTcpStream::writeLength(header, static_cast<uint32_t>(message.size()));
+    return std::string(header, 4) + message;
+}
+
+void test_ofxTcpStream_delimiter() {
+    TEST_START("ofxTcpStream Delimited Messages");
+
+    ofxTcpStream stream;
+    std::string_view message;
+    appendChunk(stream, "hel");
+    CHECK(!stream.next(ofxTcpFraming::Delimiter, "\r\n", message), "No delimiter yet");
+    appendChunk(stream, "lo\r");
+    CHECK(!stream.next(ofxTcpFraming::Delimiter, "\r\n", message), "Half a delimiter is not one");
+    appendChunk(stream, "\nwor");
+    REQUIRE(stream.next(ofxTcpFraming::Delimiter, "\r\n", message), "A delimiter straddling two appends");
+    CHECK(message == "hello", "The message without its delimiter");
+    CHECK(!stream.next(ofxTcpFraming::Delimiter, "\r\n", message), "The rest waits for its delimiter");
+    CHECK(stream.available() == 3, "Its bytes are still unconsumed");
+
+    appendChunk(stream, "ld\r");
+    appendChunk(stream, "\n\r\nlast");
+    std::vector<std::string_view> messages;
+    CHECK(stream.drain(ofxTcpFraming::Delimiter, "\r\n", messages) == 2, "drain() returns every complete message");
+    CHECK(messages.size() == 2 && messages[0] == "world" && messages[1].empty(), "Including an empty one");
+    CHECK(stream.readAll() == "last", "readAll() returns the incomplete tail");
+    CHECK(stream.available() == 0, "Nothing is left");
+
+    // A three-byte delimiter split one byte from its end
+    appendChunk(stream, "xEN");
+    CHECK(!stream.next(ofxTcpFraming::Delimiter, "END", message), "Two bytes of the delimiter");
+    appendChunk(stream, "DyEND");
+    REQUIRE(stream.next(ofxTcpFraming::Delimiter, "END", message), "Found once its last byte arrives");
+    CHECK(message == "x", "First message");
+    REQUIRE(stream.next(ofxTcpFraming::Delimiter, "END", message), "Second message in the same chunk");
+    CHECK(message == "y", "Second message");
+}
+
+void test_ofxTcpStream_lengthPrefixed() {
+    TEST_START("ofxTcpStream Length-Prefixed Messages");
+
+    ofxTcpStream stream;
+    std::string_view message;
+    const std::string bytes = lengthPrefixed("hello") + lengthPrefixed("") + lengthPrefixed("abc");
+    CHECK(bytes.size() == 4 + 5 + 4 + 4 + 3, "Four bytes of length before each message");
+
+    // The first length prefix, split across chunks
+    appendChunk(stream, bytes.substr(0, 2));
+    CHECK(!stream.next(ofxTcpFraming::LengthPrefixed, {}, message), "Half a length prefix");
+    appendChunk(stream, bytes.substr(2, 2));
+    CHECK(!stream.next(ofxTcpFraming::LengthPrefixed, {}, message), "A length prefix without its message");
+    appendChunk(stream, bytes.substr(4, 3));
+    CHECK(!stream.next(ofxTcpFraming::LengthPrefixed, {}, message), "Part of the message");
+
+    // The rest of the message, the empty one and one byte of the next prefix
+    appendChunk(stream, bytes.substr(7, 7));
+    REQUIRE(stream.next(ofxTcpFraming::LengthPrefixed, {}, message), "The first message once complete");
+    CHECK(message == "hello", "First message");
+    REQUIRE(stream.next(ofxTcpFraming::LengthPrefixed, {}, message), "An empty message");
+    CHECK(message.empty(), "Empty message");
+    CHECK(!stream.next(ofxTcpFraming::LengthPrefixed, {}, message), "One byte of the next length prefix");
+
+    appendChunk(stream, bytes.substr(14));
+    REQUIRE(stream.next(ofxTcpFraming::LengthPrefixed, {}, message), "A prefix split three bytes from its end");
+    CHECK(message == "abc", "Last message");
+    CHECK(stream.available() == 0 && !stream.hasFramingError(), "Everything consumed, no error");
+}
+
+void test_ofxTcpStream_framingError() {
+    TEST_START("ofxTcpStream Framing Errors");
+
+    oflike::ofNetworkCounters counters;
+    ofxTcpStream stream;
+    stream.setCounters(&counters);
+    std::string_view message;
+
+    // A length of exactly kMaxMessageSize is allowed
+    char header[4];
+    ofxTcpStream::writeLength(header, static_cast<uint32_t>(ofxTcpStream::kMaxMessageSize));
+    appendChunk(stream, std::string(header, 4) + "partial");
+    CHECK(!stream.next(ofxTcpFraming::LengthPrefixed, {}, message), "A 64 MB message waits for its bytes");
+    CHECK(!stream.hasFramingError() && stream.available() == 11, "kMaxMessageSize is not an error");
+    stream.clear();
+    CHECK(counters.getStats().queueDepth == 0, "clear() leaves nothing queued");
+
+    ofxTcpStream::writeLength(header, static_cast<uint32_t>(ofxTcpStream::kMaxMessageSize + 1));
+    appendChunk(stream, std::string(header, 4) + "garbage");
+    CHECK(!stream.next(ofxTcpFraming::LengthPrefixed, {}, message), "A longer length is not a message");
+    CHECK(stream.hasFramingError(), "It is a framing error");
+    CHECK(stream.available() == 0, "The stream is cleared");
+    const oflike::ofNetworkStats stats = counters.getStats();
+    CHECK(stats.drops == 1 && stats.queueDepth == 0, "The discarded bytes count as a drop");
+
+    appendChunk(stream, lengthPrefixed("ok"));
+    REQUIRE(stream.next(ofxTcpFraming::LengthPrefixed, {}, message), "Messages after the error still parse");
+    CHECK(message == "ok" && stream.hasFramingError(), "The error stays set until clear()");
+    stream.clear();
+    CHECK(!stream.hasFramingError(), "clear() resets it");
+}
+
+// ============================================================
+// Sharp::CameraPath Tests
+// ============================================================
+
+// Distance moved between each pair of consecutive samples
+static std::vector<float> stepDistances(const std::vector<Sharp::CameraPathSample>& samples) {
+    std::vector<float> steps;
+    for (size_t i = 1; i < samples.size(); ++i) {
+        steps.push_back(simd_distance(samples[i - 1].position, samples[i].position));
+    }
+    return steps;
+}
+
+static std::vector<Sharp::CameraPathSample> sampleEvenly(const Sharp::CameraPath& path, size_t steps) {
+    std::vector<float> times(steps + 1);
+    for (size_t i = 0; i <= steps; ++i) {
+        times[i] = path.getDuration() * static_cast<float>(i) / static_cast<float>(steps);
+    }
+    std::vector<Sharp::CameraPathSample> samples(times.size());
+    path.evaluate(times.data(), times.size(), samples.data());
+    return samples;
+}
+
+// Hinted and unhinted lookups may round differently at a boundary
+static bool sameSample(const Sharp::CameraPathSample& a, const Sharp::CameraPathSample& b) {
+    return simd_distance(a.position, b.position) < 1e-5f && simd_distance(a.target, b.target) < 1e-5f &&
+           floatEquals(a.fov, b.fov);
+}
+
+void test_CameraPath_constantSpeed() {
+    TEST_START("Sharp::CameraPath Constant Speed");
+
+    // 1 unit in the first second, 9 in the next two
+    Sharp::CameraPath path;
+    path.setInterpolationMode(Sharp::InterpolationMode::Linear);
+    path.addKeyframe(0.0f, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f});
+    path.addKeyframe(1.0f, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f});
+    path.addKeyframe(3.0f, {10.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f});
+
+    std::vector<float> steps = stepDistances(sampleEvenly(path, 30));
+    CHECK(floatEquals(steps.front(), 0.1f, 1e-4f) && floatEquals(steps.back(), 0.45f, 1e-4f),
+          "Without constant speed each segment has its own speed");
+
+    path.setConstantSpeed(true);
+    std::vector<Sharp::CameraPathSample> samples = sampleEvenly(path, 30);
+    steps = stepDistances(samples);
+    bool equal = true;
+    for (float step : steps) equal = equal && floatEquals(step, 10.0f / 30.0f, 1e-3f);
+    CHECK(equal, "Equal times travel equal distances");
+    CHECK(floatEquals(samples.front().position.x, 0.0f) && floatEquals(samples.back().position.x, 10.0f, 1e-4f),
+          "The path still starts and ends at its first and last keyframes");
+    CHECK(floatEquals(path.evaluate(1.5f).position.x, 5.0f, 1e-3f), "Halfway in time is halfway along");
+    CHECK(samples[15].time == 1.5f, "Samples keep the time asked for");
+
+    // A curve with uneven keyframe spacing, whose speed varies ninefold;
+    // what's left is the arc table's interpolation, relative to short steps
+    Sharp::CameraPath curve;
+    curve.setInterpolationMode(Sharp::InterpolationMode::CatmullRom);
+    curve.addKeyframe(0.0f, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f});
+    curve.addKeyframe(0.5f, {4.0f, 2.0f, 0.0f}, {0.0f, 0.0f, 0.0f});
+    curve.addKeyframe(3.0f, {6.0f, -1.0f, 1.0f}, {0.0f, 0.0f, 0.0f});
+    curve.addKeyframe(4.0f, {0.0f, -3.0f, 2.0f}, {0.0f, 0.0f, 0.0f});
+    steps = stepDistances(sampleEvenly(curve, 100));
+    auto [shortest, longest] = std::minmax_element(steps.begin(), steps.end());
+    CHECK(*longest > 4.0f * *shortest, "Without constant speed the spline's steps vary");
+    curve.setConstantSpeed(true);
+    steps = stepDistances(sampleEvenly(curve, 100));
+    std::tie(shortest, longest) = std::minmax_element(steps.begin(), steps.end());
+    CHECK(*longest - *shortest < 0.03f * *longest, "A Catmull-Rom spline is travelled at constant speed");
+
+    // Dolly segments share the duration evenly, whatever their lengths
+    Sharp::CameraPath dolly;
+    dolly.setDollyPath({{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {5.0f, 0.0f, 0.0f}}, 2.0f);
+    CHECK(floatEquals(dolly.evaluate(1.0f).position.x, 1.0f, 1e-4f), "A dolly reaches its middle point at half time");
+    dolly.setConstantSpeed(true);
+    CHECK(floatEquals(dolly.evaluate(1.0f).position.x, 2.5f, 1e-3f), "With constant speed, half its length");
+}
+
+void test_CameraPath_segmentLookup() {
+    TEST_START("Sharp::CameraPath Keyframe Segment Lookup");
+
+    // Added out of order; kept sorted by time
+    Sharp::CameraPath path;
+    path.setInterpolationMode(Sharp::InterpolationMode::Linear);
+    const float keyTimes[] = {2.0f, 0.0f, 4.0f, 1.0f, 3.0f};
+    for (float t : keyTimes) {
+        path.addKeyframe(t, {t, t * t, 0.0f}, {0.0f, t, 0.0f}, 40.0f + t);
+    }
+    CHECK(floatEquals(path.evaluate(0.5f).position.y, 0.5f), "Times between the first two keyframes");
+    CHECK(floatEquals(path.evaluate(3.5f).position.y, 12.5f), "Times between the last two keyframes");
+
+    bool atKeyframes = true;
+    for (float t : keyTimes) {
+        const Sharp::CameraPathSample sample = path.evaluate(t);
+        atKeyframes = atKeyframes && sample.position.x == t && sample.position.y == t * t && sample.fov == 40.0f + t;
+    }
+    CHECK(atKeyframes, "Keyframe times give the keyframes exactly");
+    CHECK(path.evaluate(-1.0f).position.x == 0.0f && path.evaluate(9.0f).position.x == 4.0f,
+          "Times outside the path hold the first or last keyframe");
+
+    // Batches reuse the previous sample's segment as a hint; any order
+    // must match sampling each time alone
+    std::vector<float> ascending;
+    for (int i = 0; i <= 80; ++i) ascending.push_back(4.0f * i / 80.0f);
+    std::vector<float> descending(ascending.rbegin(), ascending.rend());
+    std::vector<float> jumping = {3.9f, 0.1f, 2.0f, 2.0f, 1.99f, 4.0f, 0.0f, 3.0f, 1.0f, 2.5f};
+
+    for (const std::vector<float>* times : {&ascending, &descending, &jumping}) {
+        std::vector<Sharp::CameraPathSample> batch(times->size());
+        path.evaluate(times->data(), times->size(), batch.data());
+        bool same = true;
+        for (size_t i = 0; i < times->size(); ++i) {
+            same = same && sameSample(batch[i], path.evaluate((*times)[i]));
+        }
+        CHECK(same, times == &ascending ? "Ascending times match single samples"
+                  : times == &descending ? "Descending times match single samples"
+                                         : "Jumping times match single samples");
+    }
+
+    path.setConstantSpeed(true);
+    std::vector<Sharp::CameraPathSample> batch(jumping.size());
+    path.evaluate(jumping.data(), jumping.size(), batch.data());
+    bool same = true;
+    for (size_t i = 0; i < jumping.size(); ++i) {
+        same = same && sameSample(batch[i], path.evaluate(jumping[i]));
+    }
+    CHECK(same, "The arc table hint is also only a hint");
+
+    const std::vector<Sharp::CameraPathSample> frames = path.sampleFrames(9, 2.0f);
+    CHECK(frames.size() == 9 && sameSample(frames[5], path.evaluate(2.5f)), "sampleFrames() at the frame times");
+}
+
+// ============================================================
+// Main Test Runner
+// ============================================================
+
+void printSummary() {
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "ADDON TEST SUMMARY\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << "Total Tests:  " << g_totalTests << "\n";
+    std::cout << GREEN << "Passed:       " << g_passedTests << RESET << "\n";
+    if (g_failedTests > 0) {
+        std::cout << RED << "Failed:       " << g_failedTests << RESET << "\n";
+    } else {
+        std::cout << "Failed:       " << g_failedTests << "\n";
+    }
+
+    float percentage = (float)g_passedTests / (float)(g_passedTests + g_failedTests) * 100.0f;
+    std::cout << "\nSuccess Rate: " << percentage << "%\n";
+
+    if (g_failedTests == 0) {
+        std::cout << GREEN << "\n✓ ALL TESTS PASSED!\n" << RESET;
+    } else {
+        std::cout << RED << "\n✗ SOME TESTS FAILED\n" << RESET;
+    }
+    std::cout << std::string(60, '=') << "\n";
+}
+
+int main() {
+    std::cout << "\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << "OFLIKE-METAL ADDON TESTS\n";
+    std::cout << std::string(60, '=') << "\n";
+
+    try {
+        // ofxTcpStream Tests
+        std::cout << "\n" << YELLOW << "=== ofxTcpStream Tests ===" << RESET;
+        test_ofxTcpStream_delimiter();
+        test_ofxTcpStream_lengthPrefixed();
+        test_ofxTcpStream_framingError();
+
+        // Sharp::CameraPath Tests
+        std::cout << "\n" << YELLOW << "=== Sharp::CameraPath Tests ===" << RESET;
+        test_CameraPath_constantSpeed();
+        test_CameraPath_segmentLookup();
+
+    } catch (const std::exception& e) {
+        std::cout << RED << "\nException caught: " << e.what() << RESET << "\n";
+    }
+
+    printSummary();
+
+    return (g_failedTests == 0) ? 0 : 1;
+}
@@ -1,5 +1,6 @@
 // Math Library Tests for oflike-metal
-// Tests all components of the math library (Phase 3)
+// Tests all components of the math library (Phase 3), and the other
+// platform-independent code that runs without a GPU
 
 #include <iostream>
 #include <cmath>
@@ -10,6 +11,29 @@
 #include "ofMatrix4x4.h"
 #include "ofQuaternion.h"
 #include "ofMath.h"
+#include "ofOneEuroFilter.h"
+#include "ofxOscRouter.h"
+#include "LogQueue.h"
+#include "ofJobSystem.h"
+#include "ofMeshBVH.h"
+#include "ofParameterPreset.h"
+#include "ofNetworkStats.h"
+#include "ofTelemetry.h"
+#include "FlightRecorderRing.h"
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
 
 // Use oflike namespace
 using namespace oflike;
@@ -322,6 +346,56 @@ void test_ofMath_random() {
 
     float r4 = ofRandomuf();
     CHECK(r4 >= 0.0f && r4 <= 1.0f, "ofRandomuf() in range [0,1]");
+
+    ofSeedRandom(777);
+    float first = ofRandom(10.0f);
+    ofSeedRandom(777);
+    CHECK(floatEquals(ofRandom(10.0f), first), "ofSeedRandom() replays ofRandom()");
+}
+
+void test_ofRandomStream() {
+    TEST_START("ofRandomStream");
+
+    ofRandomStream a(99), b(99), c(99, 1);
+    bool same = true;
+    bool independent = false;
+    for (int i = 0; i < 64; ++i) {
+        uint32_t value = a.nextUInt();
+        same = same && value == b.nextUInt();
+        independent = independent || value != c.nextUInt();
+    }
+    CHECK(same, "same seed gives the same sequence");
+    CHECK(independent, "sub-streams differ");
+
+    // An odd count and a partly used block cover the scalar edges of fill()
+    ofRandomStream filled(5), single(5);
+    filled.nextFloat();
+    single.nextFloat();
+    float values[37];
+    filled.fill(values, 37, -2.0f, 3.0f);
+    bool matches = true;
+    bool inRange = true;
+    for (float v : values) {
+        matches = matches && v == single.random(-2.0f, 3.0f);
+        inRange = inRange && v >= -2.0f && v < 3.0f;
+    }
+    CHECK(matches, "fill() matches repeated random()");
+    CHECK(inRange, "fill() in range [min,max)");
+
+    std::vector<float> bulk(16, -1.0f);
+    ofRandomFill(bulk, 0.0f, 1.0f);
+    bool bulkInRange = true;
+    for (float v : bulk) {
+        bulkInRange = bulkInRange && v >= 0.0f && v < 1.0f;
+    }
+    CHECK(bulkInRange, "ofRandomFill() in range");
+
+    ofRandomStream bounded(3);
+    bool below = true;
+    for (int i = 0; i < 100; ++i) {
+        below = below && bounded.nextUInt(6) < 6;
+    }
+    CHECK(below, "nextUInt(bound) below bound");
 }
 
 void test_ofMath_noise() {
@@ -338,6 +412,63 @@ void test_ofMath_noise() {
 
     float sn1 = ofSignedNoise(0.5f);
     CHECK(sn1 >= -1.0f && sn1 <= 1.0f, "ofSignedNoise() in range [-1,1]");
+
+    float n4 = ofNoise(0.5f, 0.7f, 0.9f, 1.1f);
+    CHECK(n4 >= 0.0f && n4 <= 1.0f, "ofNoise(x,y,z,w) in range");
+
+    CHECK(floatEquals(ofSignedPerlinNoise(3.0f, -2.0f, 7.0f), 0.0f), "Perlin noise is 0 at lattice points");
+    CHECK(floatEquals(ofNoise(1.3f, 2.7f), ofNoise(1.3f, 2.7f)), "ofNoise() is deterministic");
+    CHECK(floatEquals(ofPerlinNoise(1.3f, 2.7f), ofPerlinNoise(1.3f + 256.0f, 2.7f), 1e-4f),
+          "ofPerlinNoise() repeats every 256 units");
+
+    bool varies = false;
+    for (int i = 1; i < 16 && !varies; ++i) {
+        varies = std::fabs(ofNoise(i * 0.37f, 0.5f) - ofNoise(0.0f, 0.5f)) > 0.01f;
+    }
+    CHECK(varies, "ofNoise() varies across space");
+}
+
+void test_ofMath_noise_batch() {
+    TEST_START("ofMath Batch Noise");
+
+    // An odd count exercises both the four-wide and the remainder paths
+    const size_t count = 23;
+    simd_float3 points[count];
+    float out[count];
+    for (size_t i = 0; i < count; ++i) {
+        points[i] = simd_make_float3(i * 0.61f - 5.0f, i * 0.17f, 3.0f - i * 0.43f);
+    }
+
+    bool simplexMatches = true;
+    ofNoiseBatch(points, out, count);
+    for (size_t i = 0; i < count; ++i) {
+        simplexMatches = simplexMatches && floatEquals(out[i], ofNoise(points[i].x, points[i].y, points[i].z));
+    }
+    CHECK(simplexMatches, "ofNoiseBatch() matches ofNoise()");
+
+    bool perlinMatches = true;
+    ofSignedNoiseBatch(points, out, count, ofNoiseType::Perlin);
+    for (size_t i = 0; i < count; ++i) {
+        perlinMatches = perlinMatches &&
+                        floatEquals(out[i], ofSignedPerlinNoise(points[i].x, points[i].y, points[i].z));
+    }
+    CHECK(perlinMatches, "ofSignedNoiseBatch() matches ofSignedPerlinNoise()");
+
+    // Rows of the field are the batch results at the grid points
+    ofNoiseFieldSettings settings;
+    settings.frequency = 0.25f;
+    float field[9 * 2];
+    ofNoiseField(field, 9, 2, settings);
+    CHECK(floatEquals(field[9 + 5], ofNoise(5 * 0.25f, 0.25f)), "ofNoiseField() samples the grid");
+
+    settings.octaves = 5;
+    settings.dimensions = 4;
+    ofNoiseField(field, 9, 2, settings);
+    bool inRange = true;
+    for (float v : field) {
+        inRange = inRange && v >= 0.0f && v <= 1.0f;
+    }
+    CHECK(inRange, "ofNoiseField() octaves stay in [0,1]");
 }
 
 void test_ofMath_mapping() {
@@ -388,6 +519,1188 @@ void test_ofMath_angles() {
     CHECK(wrappedRad >= -M_PI && wrappedRad <= M_PI, "ofWrapRadians() in range");
 }
 
+void test_ofOneEuroFilter() {
+    TEST_START("ofOneEuroFilter");
+
+    ofOneEuroFilter still(1.0f, 0.0f);
+    CHECK(floatEquals(still.filter(2.0f, 0.0), 2.0f), "First sample passes through");
+    for (int i = 1; i <= 30; i++) {
+        still.filter(2.0f, i / 30.0);
+    }
+    CHECK(floatEquals(still.getValue(), 2.0f), "Constant signal stays constant");
+    CHECK(floatEquals(still.getSpeed(), 0.0f), "Constant signal has no speed");
+
+    // A step is smoothed, then converges
+    ofOneEuroFilter step(1.0f, 0.0f);
+    step.filter(0.0f, 0.0);
+    float first = step.filter(1.0f, 1.0 / 30.0);
+    CHECK(first > 0.0f && first < 0.5f, "Step is smoothed at rest");
+    for (int i = 2; i <= 300; i++) {
+        step.filter(1.0f, i / 30.0);
+    }
+    CHECK(floatEquals(step.getValue(), 1.0f, 1e-3f), "Step converges");
+
+    // Higher beta follows fast motion with less lag
+    ofOneEuroFilter slow(1.0f, 0.0f);
+    ofOneEuroFilter fast(1.0f, 10.0f);
+    for (int i = 0; i <= 15; i++) {
+        slow.filter(i / 15.0f, i / 15.0);
+        fast.filter(i / 15.0f, i / 15.0);
+    }
+    CHECK(fast.getValue() > slow.getValue(), "Beta reduces lag");
+
+    // Prediction from the filtered speed, clamped to maxPrediction
+    double t = fast.getTimestamp();
+    float predicted = fast.getValueAt(t + 0.05, 0.1);
+    CHECK(predicted > fast.getValue(), "Predicts forward along motion");
+    CHECK(floatEquals(fast.getValueAt(t + 1.0, 0.1), fast.getValueAt(t + 0.1, 0.1)),
+          "Prediction held after maxPrediction");
+    float between = fast.getValueAt(t - 1.0 / 30.0, 0.1);
+    CHECK(between < fast.getValue(), "Interpolates between the last two samples");
+
+    fast.reset();
+    CHECK(!fast.hasValue(), "reset() forgets samples");
+    CHECK(floatEquals(fast.getValueAt(1.0), 0.0f), "No value before the first sample");
+}
+
+// ============================================================
+// ofxOscRouter Tests
+// ============================================================
+
+void test_ofxOscRouter_matchPart() {
+    TEST_START("ofxOscRouter Pattern Matching");
+
+    struct Case {
+        const char* pattern;
+        const char* part;
+        bool matches;
+    };
+    const Case cases[] = {
+        {"freq", "freq", true},
+        {"freq", "fre", false},
+        {"freq", "freqs", false},
+        {"?", "a", true},
+        {"?", "", false},
+        {"f?eq", "freq", true},
+        {"f?eq", "fq", false},
+        {"*", "", true},
+        {"*", "anything", true},
+        {"fader*", "fader12", true},
+        {"fader*", "fade", false},
+        {"*q", "freq", true},
+        {"*q", "freqs", false},
+        {"f*r*q", "fxxrxxq", true},
+        {"f*r*q", "fxxq", false},
+        {"[abc]", "b", true},
+        {"[abc]", "d", false},
+        {"[a-z]", "m", true},
+        {"[a-z]", "M", false},
+        {"[1-8]", "8", true},
+        {"[1-8]", "9", false},
+        {"[!abc]", "d", true},
+        {"[!abc]", "a", false},
+        {"[!0-9]x", "ax", true},
+        {"[!0-9]x", "5x", false},
+        {"[ab", "a", false},
+        {"{play,stop}", "play", true},
+        {"{play,stop}", "stop", true},
+        {"{play,stop}", "pause", false},
+        {"{a,ab}c", "abc", true},
+        {"{a,ab}c", "ac", true},
+        {"{a,ab}c", "abbc", false},
+        {"{foo", "foo", false},
+        {"*[0-9]{x,y}", "fader7y", true},
+        {"*[0-9]{x,y}", "fader7z", false},
+    };
+
+    bool passed = true;
+    for (const Case& c : cases) {
+        if (ofxOscRouter::matchPart(c.pattern, c.part) != c.matches) {
+            std::cout << "    \"" << c.pattern << "\" vs \"" << c.part << "\" should "
+                      << (c.matches ? "match" : "not match") << "\n";
+            passed = false;
+        }
+    }
+    CHECK(passed, "Every pattern case matches as listed");
+}
+
+void test_ofxOscRouter_dispatch() {
+    TEST_START("ofxOscRouter Dispatch");
+
+    ofxOscRouter router;
+    std::vector<std::string> calls;
+    auto record = [&calls](const char* name) {
+        return [&calls, name](const ofxOscMessageView&) { calls.push_back(name); };
+    };
+    CHECK(router.add("/synth/*/freq", record("freq")), "Adds a wildcard route");
+    CHECK(router.add("/synth/1/freq", record("literal")), "Adds a literal route");
+    CHECK(router.add("/fader/[1-8]", record("fader")), "Adds a range route");
+    CHECK(!router.add("synth", record("bad")), "Rejects a pattern without '/'");
+    CHECK(router.size() == 3, "Counts registered handlers");
+
+    CHECK(router.dispatch(ofxOscMessageView("/synth/1/freq", nullptr, 0)) == 2,
+          "Calls every matching handler");
+    CHECK(router.dispatch(ofxOscMessageView("/synth/2/freq", nullptr, 0)) == 1,
+          "Wildcard part matches another address");
+    CHECK(router.dispatch(ofxOscMessageView("/synth/2/gain", nullptr, 0)) == 0,
+          "Last part must match too");
+    CHECK(router.dispatch(ofxOscMessageView("/synth/2", nullptr, 0)) == 0,
+          "Shorter address doesn't match");
+    CHECK(router.matches("/fader/3") && !router.matches("/fader/9"), "matches() follows the range");
+
+    router.clear();
+    CHECK(router.size() == 0 && !router.matches("/synth/1/freq"), "clear() removes every route");
+}
+
+void test_ofxOscRouter_coalesce() {
+    TEST_START("ofxOscRouter Coalescing");
+
+    ofxOscRouter router;
+    std::vector<std::pair<std::string, int32_t>> calls;
+    router.add("/*", [&calls](const ofxOscMessageView& message) {
+        calls.emplace_back(std::string(message.getAddress()), message.getArgAsInt32(0));
+    });
+
+    // Three addresses, each sent several times; values count up
+    const char* addresses[] = {"/a", "/b", "/a", "/c", "/b", "/a"};
+    ofxOscArgView args[6];
+    ofxOscMessageView batch[6];
+    for (int i = 0; i < 6; i++) {
+        args[i].type = ofxOscMessage::OFX_OSC_TYPE_INT32;
+        args[i].asInt32 = i;
+        batch[i] = ofxOscMessageView(addresses[i], &args[i], 1);
+    }
+
+    CHECK(router.dispatch(batch, 6, false) == 6, "Without coalescing every message is dispatched");
+
+    calls.clear();
+    CHECK(router.dispatch(batch, 6, true) == 3, "Coalescing dispatches one message per address");
+    const std::vector<std::pair<std::string, int32_t>> expected = {{"/c", 3}, {"/b", 4}, {"/a", 5}};
+    CHECK(calls == expected, "The last value of each address, in batch order");
+
+    // Scratch space is reused by a larger batch
+    std::vector<ofxOscArgView> manyArgs(100);
+    std::vector<ofxOscMessageView> many(100);
+    std::vector<std::string> manyAddresses(100);
+    for (int i = 0; i < 100; i++) {
+        manyAddresses[i] = "/n" + std::to_string(i % 40);
+        manyArgs[i].type = ofxOscMessage::OFX_OSC_TYPE_INT32;
+        manyArgs[i].asInt32 = i;
+        many[i] = ofxOscMessageView(manyAddresses[i], &manyArgs[i], 1);
+    }
+    calls.clear();
+    CHECK(router.dispatch(many.data(), many.size(), true) == 40, "Coalesces a larger batch");
+    bool latest = calls.size() == 40;
+    for (const auto& call : calls) {
+        latest = latest && call.second >= 60;
+    }
+    CHECK(latest, "Only each address's last value survives");
+}
+
+// ============================================================
+// ofLog Tests
+// ============================================================
+
+LogRecord makeLogRecord(ofLogLevel level, const char* module, const char* text) {
+    LogRecord record;
+    record.level = level;
+    record.length = static_cast<uint32_t>(std::strlen(text));
+    std::strncpy(record.module, module, kLogModuleSize - 1);
+    record.module[kLogModuleSize - 1] = '\0';
+    std::strncpy(record.text, text, kLogTextSize - 1);
+    record.text[kLogTextSize - 1] = '\0';
+    return record;
+}
+
+void test_LogQueue_producers() {
+    TEST_START("LogQueue Multiple Producers");
+
+    // Producers retry while the queue is full, so nothing may be lost
+    constexpr int kProducers = 4;
+    constexpr uint32_t kPerProducer = 20000;
+    LogQueue queue;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; p++) {
+        producers.emplace_back([&queue, p] {
+            for (uint32_t i = 0; i < kPerProducer; i++) {
+                while (!queue.push([&](LogRecord& record) {
+                    record.level = static_cast<ofLogLevel>(p);
+                    record.length = i;
+                })) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<uint32_t> next(kProducers, 0);
+    bool ordered = true;
+    uint32_t received = 0;
+    LogRecord record;
+    while (received < kProducers * kPerProducer) {
+        if (!queue.pop(record)) {
+            std::this_thread::yield();
+            continue;
+        }
+        const int p = static_cast<int>(record.level);
+        ordered = ordered && p >= 0 && p < kProducers && record.length == next[p];
+        if (p >= 0 && p < kProducers) {
+            next[p] = record.length + 1;
+        }
+        received++;
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    bool complete = true;
+    for (uint32_t count : next) {
+        complete = complete && count == kPerProducer;
+    }
+    CHECK(ordered, "Each producer's records arrive in the order pushed");
+    CHECK(complete, "Every record arrives exactly once");
+    CHECK(!queue.pop(record), "Queue is empty afterwards");
+}
+
+void test_LogQueue_full() {
+    TEST_START("LogQueue Capacity");
+
+    LogQueue queue;
+    auto fill = [](LogRecord& record) { record.length = 1; };
+    bool accepted = true;
+    for (size_t i = 0; i < kLogQueueSlots; i++) {
+        accepted = accepted && queue.push(fill);
+    }
+    CHECK(accepted, "Fills every slot");
+    CHECK(!queue.push(fill), "Rejects a record when full");
+
+    LogRecord record;
+    CHECK(queue.pop(record) && queue.push(fill), "Accepts again once a slot is popped");
+}
+
+void test_LogRepeatFilter() {
+    TEST_START("ofLog Repeat Collapsing");
+
+    std::vector<std::string> written;
+    auto emit = [&written](ofLogLevel, const char* module, const char* text) {
+        written.push_back(std::string(module) + ":" + text);
+    };
+
+    LogRepeatFilter filter;
+    const LogRecord a = makeLogRecord(OF_LOG_WARNING, "Mesh", "slow upload");
+    const LogRecord b = makeLogRecord(OF_LOG_WARNING, "Mesh", "slow download");
+    filter.write(a, emit);
+    filter.write(a, emit);
+    filter.write(a, emit);
+    CHECK(written.size() == 1 && filter.getRepeats() == 2, "Repeats are held back and counted");
+
+    filter.write(b, emit);
+    const std::vector<std::string> expected = {
+        "Mesh:slow upload", "Mesh:(last message repeated 2 times)", "Mesh:slow download"};
+    CHECK(written == expected, "A different message writes the count first");
+
+    written.clear();
+    filter.write(makeLogRecord(OF_LOG_ERROR, "Mesh", "slow download"), emit);
+    filter.write(makeLogRecord(OF_LOG_ERROR, "Font", "slow download"), emit);
+    filter.write(makeLogRecord(OF_LOG_ERROR, "Font", "slow download!"), emit);
+    CHECK(written.size() == 3, "Level, module and text must all match to collapse");
+
+    written.clear();
+    filter.writeRepeats(emit);
+    CHECK(written.empty(), "No count is written without repeats");
+    filter.write(makeLogRecord(OF_LOG_ERROR, "Font", "slow download!"), emit);
+    filter.writeRepeats(emit);
+    filter.writeRepeats(emit);
+    CHECK(written.size() == 1 && written[0] == "Font:(last message repeated 1 times)",
+          "A pending count is written once");
+}
+
+void test_ofLogRateLimiter() {
+    TEST_START("ofLogRateLimiter");
+
+    ofLogRateLimiter limiter;
+    uint32_t suppressed = 0;
+    bool burst = true;
+    for (uint32_t i = 0; i < ofLogRateLimiter::kBurst; i++) {
+        burst = burst && limiter.allow(suppressed) && suppressed == 0;
+    }
+    CHECK(burst, "The first kBurst messages pass");
+    CHECK(limiter.allow(suppressed) && suppressed == 0, "Then one passes per second");
+
+    bool held = true;
+    for (int i = 0; i < 5; i++) {
+        held = held && !limiter.allow(suppressed);
+    }
+    CHECK(held, "Messages within the second are held back");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1050));
+    CHECK(limiter.allow(suppressed) && suppressed == 5, "The next one reports how many were held back");
+    CHECK(!limiter.allow(suppressed), "And starts a new second");
+}
+
+// ============================================================
+// ofJobSystem Tests
+// ============================================================
+
+void test_ofJobSystem_parallelFor() {
+    TEST_START("ofJobSystem parallelFor");
+
+    ofJobSystem pool(3);
+    constexpr size_t kCount = 100003;
+    std::vector<std::atomic<int>> visits(kCount);
+
+    auto coveredOnce = [&](size_t begin, size_t end) {
+        for (size_t i = 0; i < kCount; i++) {
+            if (visits[i].load() != (i >= begin && i < end ? 1 : 0)) return false;
+        }
+        return true;
+    };
+    auto reset = [&] {
+        for (auto& visit : visits) visit.store(0);
+    };
+    auto count = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) visits[i].fetch_add(1);
+    };
+
+    pool.parallelFor(0, kCount, 97, count);
+    CHECK(coveredOnce(0, kCount), "Every index runs exactly once (grain 97)");
+
+    reset();
+    pool.parallelFor(0, kCount, 0, count);
+    CHECK(coveredOnce(0, kCount), "Every index runs exactly once (automatic grain)");
+
+    reset();
+    pool.parallelFor(10, 5000, kCount, count);
+    CHECK(coveredOnce(10, 5000), "A grain larger than the range runs it as one chunk");
+
+    reset();
+    pool.parallelFor(500, 500, 16, count);
+    CHECK(coveredOnce(0, 0), "An empty range runs nothing");
+}
+
+void test_ofJobSystem_dependencies() {
+    TEST_START("ofJobSystem Dependencies");
+
+    ofJobSystem pool(4);
+    bool ordered = true;
+    for (int round = 0; round < 50; round++) {
+        // Diamond: a before b and c, both before d
+        std::atomic<int> step{0};
+        std::atomic<int> aAt{-1}, bAt{-1}, cAt{-1}, dAt{-1};
+        ofJob a = pool.launch([&] {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            aAt = step++;
+        });
+        ofJob b = pool.launch([&] { bAt = step++; }, {a});
+        ofJob c = pool.launch([&] { cAt = step++; }, {a});
+        ofJob d = pool.launch([&] { dAt = step++; }, std::vector<ofJob>{b, c});
+        pool.wait(d);
+
+        ordered = ordered && a.isDone() && b.isDone() && c.isDone() &&
+                  aAt < bAt && aAt < cAt && bAt < dAt && cAt < dAt;
+    }
+    CHECK(ordered, "A job runs only after all of its dependencies");
+
+    // A dependency that finished before the launch doesn't hold the job back
+    ofJob done = pool.launch([] {});
+    pool.wait(done);
+    std::atomic<bool> ran{false};
+    ofJob after = pool.launch([&] { ran = true; }, {done, ofJob()});
+    pool.waitAll();
+    CHECK(after.isDone() && ran.load(), "Finished and empty dependencies are satisfied");
+    CHECK(pool.getPendingCount() == 0, "waitAll() leaves nothing pending");
+}
+
+void test_ofJobSystem_waitFromWorker() {
+    TEST_START("ofJobSystem Waiting On A Worker");
+
+    // One worker: a job that waits for another must run it itself. The main
+    // thread polls instead of waiting, so it never runs the inner job. The
+    // pool is leaked if the wait deadlocks, rather than hanging in its
+    // destructor.
+    ofJobSystem* pool = new ofJobSystem(1);
+    std::atomic<bool> innerRan{false};
+    std::atomic<size_t> nestedSum{0};
+    ofJob outer = pool->launch([pool, &innerRan, &nestedSum] {
+        ofJob inner = pool->launch([&innerRan] { innerRan = true; });
+        pool->wait(inner);
+        pool->parallelFor(0, 1000, 10, [&nestedSum](size_t begin, size_t end) {
+            nestedSum += end - begin;
+        });
+    });
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!outer.isDone() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(outer.isDone(), "wait() on a worker runs queued jobs instead of blocking");
+    CHECK(innerRan.load() && nestedSum.load() == 1000, "Nested job and parallelFor ran on the worker");
+    if (outer.isDone()) {
+        delete pool;
+    }
+}
+
+// ============================================================
+// ofMeshBVH Tests
+// ============================================================
+
+// Triangles scattered through a box, a unit or so across, as a triangle soup
+static void makeTriangleSoup(std::mt19937& rng, size_t count,
+                             std::vector<ofVec3f>& vertices, std::vector<uint32_t>& indices) {
+    std::uniform_real_distribution<float> position(-5.0f, 5.0f);
+    std::uniform_real_distribution<float> offset(-0.7f, 0.7f);
+    vertices.clear();
+    indices.clear();
+    for (size_t t = 0; t < count; t++) {
+        const ofVec3f center(position(rng), position(rng), position(rng));
+        for (int k = 0; k < 3; k++) {
+            indices.push_back((uint32_t)vertices.size());
+            vertices.push_back(center + ofVec3f(offset(rng), offset(rng), offset(rng)));
+        }
+    }
+}
+
+// Two-sided ray/triangle test; t is in units of dir
+static bool rayTriangle(const ofVec3f& origin, const ofVec3f& dir,
+                        const ofVec3f& v0, const ofVec3f& v1, const ofVec3f& v2, float& t) {
+    const ofVec3f e1 = v1 - v0;
+    const ofVec3f e2 = v2 - v0;
+    const ofVec3f p = dir.cross(e2);
+    const float det = e1.dot(p);
+    if (std::fabs(det) < 1e-12f) return false;
+    const ofVec3f s = origin - v0;
+    const float u = s.dot(p) / det;
+    if (u < 0.0f || u > 1.0f) return false;
+    const ofVec3f q = s.cross(e1);
+    const float v = dir.dot(q) / det;
+    if (v < 0.0f || u + v > 1.0f) return false;
+    t = e2.dot(q) / det;
+    return t >= 0.0f;
+}
+
+// Closest point on a triangle (Ericson, Real-Time Collision Detection 5.1.5)
+static ofVec3f closestOnTriangle(const ofVec3f& p, const ofVec3f& a, const ofVec3f& b, const ofVec3f& c) {
+    const ofVec3f ab = b - a, ac = c - a, ap = p - a;
+    const float d1 = ab.dot(ap), d2 = ac.dot(ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+    const ofVec3f bp = p - b;
+    const float d3 = ab.dot(bp), d4 = ac.dot(bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+    const ofVec3f cp = p - c;
+    const float d5 = ab.dot(cp), d6 = ac.dot(cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+    const float denom = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+// Nearest hit distance in world units over every triangle; FLT_MAX if none
+static float bruteRaycast(const std::vector<ofVec3f>& vertices, const std::vector<uint32_t>& indices,
+                          const ofVec3f& origin, const ofVec3f& dir) {
+    float best = FLT_MAX;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        float t = 0.0f;
+        if (rayTriangle(origin, dir, vertices[indices[i]], vertices[indices[i + 1]],
+                        vertices[indices[i + 2]], t)) {
+            best = std::min(best, t * dir.length());
+        }
+    }
+    return best;
+}
+
+// Distance from p to each triangle
+static std::vector<float> bruteDistances(const std::vector<ofVec3f>& vertices,
+                                         const std::vector<uint32_t>& indices, const ofVec3f& p) {
+    std::vector<float> distances;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        distances.push_back(p.distance(closestOnTriangle(p, vertices[indices[i]], vertices[indices[i + 1]],
+                                                         vertices[indices[i + 2]])));
+    }
+    return distances;
+}
+
+// Rays and closest points against a brute-force scan of the same triangles
+static bool matchesBruteForce(const ofMeshBVH& bvh, const std::vector<ofVec3f>& vertices,
+                              const std::vector<uint32_t>& indices, std::mt19937& rng) {
+    std::uniform_real_distribution<float> position(-7.0f, 7.0f);
+    bool matched = true;
+    int hits = 0;
+    for (int i = 0; i < 300; i++) {
+        const ofVec3f origin(position(rng), position(rng), position(rng));
+        const ofVec3f target(position(rng) * 0.5f, position(rng) * 0.5f, position(rng) * 0.5f);
+        const ofVec3f dir = (target - origin) * 0.25f;
+        const float expected = bruteRaycast(vertices, indices, origin, dir);
+        const ofMeshHit hit = bvh.raycast(origin, dir);
+        if (expected == FLT_MAX) {
+            matched = matched && !hit;
+        } else {
+            hits++;
+            matched = matched && hit && floatEquals(hit.distance, expected, 1e-3f);
+        }
+
+        const std::vector<float> distances = bruteDistances(vertices, indices, origin);
+        const float nearest = *std::min_element(distances.begin(), distances.end());
+        const ofMeshHit closest = bvh.closestPoint(origin);
+        matched = matched && closest && floatEquals(closest.distance, nearest, 1e-3f) &&
+                  floatEquals(closest.position.distance(origin), nearest, 1e-3f);
+    }
+    return matched && hits > 0;
+}
+
+void test_ofMeshBVH_raycast() {
+    TEST_START("ofMeshBVH Raycast");
+
+    // A unit right triangle at z = 0 and the same at z = -2
+    const std::vector<ofVec3f> vertices = {
+        ofVec3f(0, 0, 0), ofVec3f(1, 0, 0), ofVec3f(0, 1, 0),
+        ofVec3f(0, 0, -2), ofVec3f(1, 0, -2), ofVec3f(0, 1, -2),
+    };
+    ofMeshBVH bvh;
+    REQUIRE(bvh.build(vertices.data(), vertices.size(), nullptr, 0), "build() accepts unindexed triangles");
+    CHECK(bvh.getNumTriangles() == 2, "Two triangles built");
+
+    ofMeshHit hit = bvh.raycast(ofVec3f(0.25f, 0.25f, 5), ofVec3f(0, 0, -2));
+    CHECK(hit && hit.triangle == 0, "A ray from above hits the nearer triangle");
+    CHECK(floatEquals(hit.distance, 5.0f), "Distance is in world units, not direction lengths");
+    CHECK(hit.position.match(ofVec3f(0.25f, 0.25f, 0)), "Hit position on the triangle");
+    CHECK(floatEquals(hit.u, 0.25f) && floatEquals(hit.v, 0.25f), "Barycentric coordinates");
+    CHECK(hit.normal.match(ofVec3f(0, 0, 1)), "Unit face normal");
+
+    hit = bvh.raycast(ofVec3f(0.25f, 0.25f, -5), ofVec3f(0, 0, 1));
+    CHECK(hit && hit.triangle == 1 && floatEquals(hit.distance, 3.0f), "Back faces are hit too");
+
+    CHECK(!bvh.raycast(ofVec3f(0.25f, 0.25f, 5), ofVec3f(0, 0, -1), 4.0f), "Hits past maxDistance are ignored");
+    CHECK(!bvh.raycast(ofVec3f(0.75f, 0.75f, 5), ofVec3f(0, 0, -1)), "A ray past the hypotenuse misses");
+    CHECK(!bvh.raycast(ofVec3f(0.25f, 0.25f, 5), ofVec3f(0, 0, 1)), "A ray pointing away misses");
+    CHECK(!bvh.raycast(ofVec3f(0.25f, 0.25f, 1), ofVec3f(1, 0, 0)), "A ray parallel to the triangles misses");
+
+    CHECK(bvh.intersects(ofVec3f(0.25f, 0.25f, 5), ofVec3f(0, 0, -1), 6.0f), "intersects() within maxDistance");
+    CHECK(!bvh.intersects(ofVec3f(0.25f, 0.25f, 5), ofVec3f(0, 0, -1), 4.0f), "intersects() past maxDistance");
+
+    hit = bvh.intersectSegment(ofVec3f(0.25f, 0.25f, 1), ofVec3f(0.25f, 0.25f, -3));
+    CHECK(hit && hit.triangle == 0 && floatEquals(hit.distance, 1.0f), "Segment hit nearest its start");
+    CHECK(!bvh.intersectSegment(ofVec3f(0.25f, 0.25f, 1), ofVec3f(0.25f, 0.25f, 0.5f)),
+          "A segment ending short of the triangle misses");
+
+    // Many triangles, so the rays descend a real tree
+    std::mt19937 rng(7);
+    std::vector<ofVec3f> soup;
+    std::vector<uint32_t> indices;
+    makeTriangleSoup(rng, 500, soup, indices);
+    REQUIRE(bvh.build(soup.data(), soup.size(), indices.data(), indices.size()), "build() indexed triangles");
+    CHECK(bvh.getNumNodes() > 1, "Several nodes built");
+    CHECK(matchesBruteForce(bvh, soup, indices, rng), "Rays and closest points match a brute-force scan");
+}
+
+void test_ofMeshBVH_sphere() {
+    TEST_START("ofMeshBVH Sphere Queries");
+
+    std::mt19937 rng(11);
+    std::vector<ofVec3f> vertices;
+    std::vector<uint32_t> indices;
+    makeTriangleSoup(rng, 400, vertices, indices);
+    ofMeshBVH bvh;
+    REQUIRE(bvh.build(vertices.data(), vertices.size(), indices.data(), indices.size()), "build()");
+
+    std::uniform_real_distribution<float> position(-5.0f, 5.0f);
+    std::uniform_real_distribution<float> radius(0.2f, 2.5f);
+    bool sameTriangles = true;
+    bool sameDistance = true;
+    bool missesOutside = true;
+    std::vector<size_t> found;
+    for (int i = 0; i < 100; i++) {
+        const ofVec3f center(position(rng), position(rng), position(rng));
+        const float r = radius(rng);
+        const std::vector<float> distances = bruteDistances(vertices, indices, center);
+
+        // Triangles within a hair of the surface may go either way
+        bvh.querySphere(center, r, found);
+        std::vector<bool> inQuery(distances.size(), false);
+        for (size_t t : found) inQuery[t] = true;
+        for (size_t t = 0; t < distances.size(); t++) {
+            if (distances[t] < r - 1e-4f && !inQuery[t]) sameTriangles = false;
+            if (distances[t] > r + 1e-4f && inQuery[t]) sameTriangles = false;
+        }
+
+        const float nearest = *std::min_element(distances.begin(), distances.end());
+        const ofMeshHit closest = bvh.closestPoint(center, nearest + 0.01f);
+        sameDistance = sameDistance && closest && floatEquals(closest.distance, nearest, 1e-4f) &&
+                       floatEquals(distances[closest.triangle], nearest, 1e-4f);
+        missesOutside = missesOutside && !bvh.closestPoint(center, nearest * 0.99f - 1e-4f);
+    }
+    CHECK(sameTriangles, "querySphere() finds exactly the triangles within the radius");
+    CHECK(sameDistance, "closestPoint() distance matches the nearest triangle");
+    CHECK(missesOutside, "closestPoint() misses when every triangle is outside the radius");
+
+    CHECK(bvh.querySphere(ofVec3f(100, 100, 100), 1.0f, found) == 0 && found.empty(),
+          "A sphere away from the mesh finds nothing");
+}
+
+void test_ofMeshBVH_refit() {
+    TEST_START("ofMeshBVH Refit");
+
+    std::mt19937 rng(23);
+    std::vector<ofVec3f> vertices;
+    std::vector<uint32_t> indices;
+    makeTriangleSoup(rng, 400, vertices, indices);
+    ofMeshBVH bvh;
+    REQUIRE(bvh.build(vertices.data(), vertices.size(), indices.data(), indices.size()), "build()");
+    const size_t nodes = bvh.getNumNodes();
+
+    // Move every vertex: a wave, then stretch along x
+    for (ofVec3f& v : vertices) {
+        v = ofVec3f(v.x * 1.5f, v.y + std::sin(v.x) * 2.0f, v.z - std::cos(v.y));
+    }
+    REQUIRE(bvh.refit(vertices.data(), vertices.size()), "refit() with the same vertex count");
+    CHECK(bvh.getNumNodes() == nodes, "refit() keeps the tree");
+
+    ofVec3f min, max;
+    bvh.getBounds(min, max);
+    ofVec3f expectedMin(FLT_MAX, FLT_MAX, FLT_MAX), expectedMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (const ofVec3f& v : vertices) {
+        for (int k = 0; k < 3; k++) {
+            expectedMin[k] = std::min(expectedMin[k], v[k]);
+            expectedMax[k] = std::max(expectedMax[k], v[k]);
+        }
+    }
+    CHECK(min.match(expectedMin) && max.match(expectedMax), "Bounds follow the moved vertices");
+    CHECK(matchesBruteForce(bvh, vertices, indices, rng), "Queries after refit() match a brute-force scan");
+
+    CHECK(!bvh.refit(vertices.data(), vertices.size() - 3), "refit() rejects a different vertex count");
+}
+
+// ============================================================
+// ofParameterPreset Tests
+// ============================================================
+
+static std::string presetTestPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static std::vector<char> readPresetFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void writePresetFile(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), (std::streamsize)bytes.size());
+}
+
+void test_ofParameterPreset_roundTrip() {
+    TEST_START("ofParameterPreset Save/Load Round Trip");
+
+    ofParameter<float> speed("speed", 1.5f);
+    ofParameter<int> count("count", 7);
+    ofParameter<bool> enabled("enabled", true);
+    ofParameterPreset presets;
+    presets.add(speed);
+    presets.add(count);
+    presets.add(enabled);
+    CHECK(presets.size() == 3, "Three parameters registered");
+
+    const std::string path = presetTestPath("math_test_round_trip.preset");
+    REQUIRE(presets.save(path), "save() writes the current values");
+    CHECK(readPresetFile(path).size() == 24 + 3 * 4, "A 24-byte header and one slot per parameter");
+
+    speed = -3.25f;
+    count = -42;
+    enabled = false;
+
+    // Each listener sees every value already loaded, and runs once
+    int speedCalls = 0;
+    int countCalls = 0;
+    bool sawLoaded = true;
+    speed.addListener([&](float&) {
+        speedCalls++;
+        sawLoaded = sawLoaded && count.get() == 7 && enabled.get();
+    });
+    count.addListener([&](int&) {
+        countCalls++;
+        sawLoaded = sawLoaded && speed.get() == 1.5f && enabled.get();
+    });
+
+    ofParameterSnapshot snapshot;
+    REQUIRE(presets.load(path, snapshot), "load() reads the file back");
+    CHECK(snapshot.layout == presets.getLayout() && snapshot.values.size() == 3, "Snapshot of this registry");
+    CHECK(speed.get() == -3.25f && count.get() == -42 && !enabled.get(), "load() alone changes nothing");
+
+    REQUIRE(presets.apply(snapshot), "apply() the loaded snapshot");
+    CHECK(speed.get() == 1.5f && count.get() == 7 && enabled.get(), "Every value restored exactly");
+    CHECK(sawLoaded, "Listeners run after every value is set");
+    CHECK(speedCalls == 1 && countCalls == 1, "Each listener is notified once");
+
+    std::filesystem::remove(path);
+}
+
+void test_ofParameterPreset_rejection() {
+    TEST_START("ofParameterPreset Rejects Other Files");
+
+    ofParameter<float> speed("speed", 2.0f);
+    ofParameter<int> count("count", 3);
+    ofParameterPreset presets;
+    presets.add(speed);
+    presets.add(count);
+
+    const std::string path = presetTestPath("math_test_rejection.preset");
+    const std::string patched = presetTestPath("math_test_rejection_patched.preset");
+    REQUIRE(presets.save(path), "save()");
+    const std::vector<char> bytes = readPresetFile(path);
+    REQUIRE(bytes.size() == 24 + 2 * 4, "Saved file size");
+
+    ofParameterSnapshot snapshot;
+    CHECK(!presets.load(presetTestPath("math_test_missing.preset"), snapshot), "A missing file is rejected");
+    CHECK(presets.hasError(), "The failure is reported");
+
+    // Same types, another name: another layout
+    ofParameter<float> renamed("velocity", 2.0f);
+    ofParameter<int> otherCount("count", 3);
+    ofParameterPreset other;
+    other.add(renamed);
+    other.add(otherCount);
+    CHECK(other.getLayout() != presets.getLayout(), "Names are part of the layout");
+    CHECK(!other.load(path, snapshot), "A file saved with other names is rejected");
+
+    ofParameter<bool> extra("extra", false);
+    ofParameterPreset longer;
+    longer.add(speed);
+    longer.add(count);
+    longer.add(extra);
+    CHECK(!longer.load(path, snapshot), "A file saved with fewer parameters is rejected");
+
+    std::vector<char> corrupt = bytes;
+    corrupt[4] = 2;
+    writePresetFile(patched, corrupt);
+    CHECK(!presets.load(patched, snapshot), "Another version is rejected");
+
+    corrupt = bytes;
+    corrupt[0] = 'X';
+    writePresetFile(patched, corrupt);
+    CHECK(!presets.load(patched, snapshot), "Another magic is rejected");
+
+    writePresetFile(patched, std::vector<char>(bytes.begin(), bytes.end() - 4));
+    CHECK(!presets.load(patched, snapshot), "A file missing a slot is rejected");
+
+    writePresetFile(patched, std::vector<char>(bytes.begin(), bytes.begin() + 10));
+    CHECK(!presets.load(patched, snapshot), "A file cut inside the header is rejected");
+
+    REQUIRE(presets.load(path, snapshot), "The untouched file still loads");
+    CHECK(!other.apply(snapshot), "apply() rejects a snapshot of another registry");
+    CHECK(renamed.get() == 2.0f && otherCount.get() == 3, "A rejected snapshot changes nothing");
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(patched);
+}
+
+void test_ofParameterPreset_blend() {
+    TEST_START("ofParameterPreset Blending");
+
+    ofParameter<float> speed("speed", 0.0f);
+    ofParameter<int> count("count", 0);
+    ofParameter<bool> enabled("enabled", false);
+    ofParameterPreset presets;
+    presets.add(speed);
+    presets.add(count);
+    presets.add(enabled);
+
+    const ofParameterSnapshot from = presets.capture();
+    speed = 10.0f;
+    count = 5;
+    enabled = true;
+    const ofParameterSnapshot to = presets.capture();
+
+    REQUIRE(presets.apply(from, to, 0.0f), "apply() at t = 0");
+    CHECK(speed.get() == 0.0f && count.get() == 0 && !enabled.get(), "t = 0 gives the first snapshot");
+
+    REQUIRE(presets.apply(from, to, 0.5f), "apply() at t = 0.5");
+    CHECK(floatEquals(speed.get(), 5.0f), "Floats interpolate");
+    CHECK(count.get() == 3, "Ints round half away from zero (2.5 -> 3)");
+    CHECK(enabled.get(), "Bools switch at t = 0.5");
+
+    REQUIRE(presets.apply(from, to, 0.25f), "apply() at t = 0.25");
+    CHECK(floatEquals(speed.get(), 2.5f) && count.get() == 1 && !enabled.get(), "t = 0.25");
+
+    REQUIRE(presets.apply(from, to, 1.0f), "apply() at t = 1");
+    CHECK(speed.get() == 10.0f && count.get() == 5 && enabled.get(), "t = 1 gives the second snapshot");
+
+    REQUIRE(presets.apply(to, from, 2.0f), "apply() past t = 1");
+    CHECK(speed.get() == 0.0f && count.get() == 0 && !enabled.get(), "t is clamped to [0, 1]");
+}
+
+// ============================================================
+// ofParameter Tests
+// ============================================================
+
+struct ParameterListenerProbe {
+    ofParameterListener<int> listener;
+    ofParameterListener<int>* removeOnNotify = nullptr;
+    std::vector<int>* calls = nullptr;
+    int id = 0;
+
+    void changed(int&) {
+        calls->push_back(id);
+        if (removeOnNotify) removeOnNotify->remove();
+    }
+};
+
+void test_ofParameter_removeDuringNotify() {
+    TEST_START("ofParameter Listeners Removed While Notifying");
+
+    ofParameter<int> value("value", 0);
+    std::vector<int> calls;
+    ParameterListenerProbe probes[4];
+    for (int i = 0; i < 4; ++i) {
+        probes[i].id = i;
+        probes[i].calls = &calls;
+        probes[i].listener.listen<&ParameterListenerProbe::changed>(value, &probes[i]);
+    }
+
+    // 0 removes itself, 1 removes 2, the next node to be called
+    probes[0].removeOnNotify = &probes[0].listener;
+    probes[1].removeOnNotify = &probes[2].listener;
+    value = 1;
+    CHECK((calls == std::vector<int>{0, 1, 3}), "A removed next listener is skipped, the rest still run");
+    CHECK(!probes[0].listener.isListening() && !probes[2].listener.isListening(), "Both removed listeners are unlinked");
+
+    calls.clear();
+    probes[1].removeOnNotify = nullptr;
+    value = 2;
+    CHECK((calls == std::vector<int>{1, 3}), "Later changes reach only the remaining listeners");
+
+    // Removing the last listener while it runs ends the walk cleanly
+    calls.clear();
+    probes[3].removeOnNotify = &probes[3].listener;
+    value = 3;
+    CHECK((calls == std::vector<int>{1, 3}) && !probes[3].listener.isListening(), "The last listener removes itself");
+    CHECK(value.hasListeners(), "The parameter keeps its other listener");
+}
+
+void test_ofParameter_listenerLifetime() {
+    TEST_START("ofParameter Listener Lifetime");
+
+    ofParameterListener<int> outliving;
+    int calls = 0;
+    {
+        ofParameter<int> value("value", 0);
+        outliving.listen(value, [&](int&) { calls++; });
+        value = 1;
+        CHECK(calls == 1 && outliving.isListening(), "The listener hears its parameter");
+    }
+    CHECK(!outliving.isListening(), "Destroying the parameter unlinks its listeners");
+    outliving.remove();
+    CHECK(!outliving.isListening(), "remove() after the parameter is gone does nothing");
+
+    // A listener destroyed first leaves the parameter's list
+    ofParameter<int> value("value", 0);
+    {
+        ofParameterListener<int> scoped;
+        scoped.listen(value, [&](int&) { calls++; });
+    }
+    CHECK(!value.hasListeners(), "A destroyed listener unlinks itself");
+    value = 2;
+    CHECK(calls == 1, "Nothing is called after");
+}
+
+void test_ofParameter_deferred() {
+    TEST_START("ofParameter Deferred Notifications");
+
+    ofFlushParameterNotifications();
+
+    ofParameter<float> speed("speed", 0.0f);
+    speed.setNotifyMode(ofParameterNotify::Deferred);
+    std::vector<float> heard;
+    speed.addListener([&](float& v) { heard.push_back(v); });
+
+    speed = 1.0f;
+    speed = 2.0f;
+    speed = 3.0f;
+    CHECK(heard.empty(), "set() in Deferred mode does not notify");
+    ofFlushParameterNotifications();
+    CHECK(heard.size() == 1 && heard[0] == 3.0f, "One notification per flush, with the final value");
+    ofFlushParameterNotifications();
+    CHECK(heard.size() == 1, "Nothing more until the next change");
+
+    speed = 4.0f;
+    speed = 3.0f;
+    ofFlushParameterNotifications();
+    CHECK(heard.size() == 2 && heard[1] == 3.0f, "Each flush delivers that frame's changes");
+
+    // A parameter destroyed while queued is skipped by the flush
+    int droppedCalls = 0;
+    {
+        ofParameter<int> dropped("dropped", 0);
+        dropped.setNotifyMode(ofParameterNotify::Deferred);
+        dropped.addListener([&](int&) { droppedCalls++; });
+        dropped = 1;
+        speed = 5.0f;
+    }
+    ofFlushParameterNotifications();
+    CHECK(droppedCalls == 0, "A destroyed parameter is never notified");
+    CHECK(heard.size() == 3 && heard[2] == 5.0f, "Parameters queued around it still are");
+
+    // Changes made by a listener wait for the next flush
+    ofParameter<int> echo("echo", 0);
+    echo.setNotifyMode(ofParameterNotify::Deferred);
+    int echoCalls = 0;
+    echo.addListener([&](int& v) {
+        echoCalls++;
+        if (v < 2) echo = v + 1;
+    });
+    echo = 1;
+    ofFlushParameterNotifications();
+    CHECK(echoCalls == 1 && echo.get() == 2, "A listener's own change is not delivered in the same flush");
+    ofFlushParameterNotifications();
+    CHECK(echoCalls == 2, "It is delivered by the next one");
+}
+
+// ============================================================
+// ofLatencyHistogram Tests
+// ============================================================
+
+void test_ofLatencyHistogram_buckets() {
+    TEST_START("ofLatencyHistogram Buckets");
+
+    CHECK(ofLatencyHistogram::getBucketStart(0) == 0.0, "The first bucket starts at 0");
+    CHECK(floatEquals((float)(ofLatencyHistogram::getBucketStart(1) * 1e6), 2.0f, 1e-4f), "Bucket 1 starts at 2 us");
+    CHECK(floatEquals((float)(ofLatencyHistogram::getBucketStart(10) * 1e6), 1024.0f, 1e-3f), "Bucket 10 starts at 1024 us");
+
+    ofLatencyHistogram histogram;
+    histogram.add(-1.0);        // Clock steps backwards count as 0
+    histogram.add(0.5e-6);
+    histogram.add(1.5e-6);
+    histogram.add(2.5e-6);
+    histogram.add(3.5e-6);
+    histogram.add(5e-6);
+    histogram.add(1500e-6);
+    histogram.add(100.0);       // Past the last bucket's start
+    CHECK(histogram.getCount() == 8, "Every sample is counted");
+    CHECK(histogram.getBucket(0) == 3, "[0, 2) us, including negative and sub-microsecond samples");
+    CHECK(histogram.getBucket(1) == 2, "[2, 4) us");
+    CHECK(histogram.getBucket(2) == 1, "[4, 8) us");
+    CHECK(histogram.getBucket(10) == 1, "[1024, 2048) us");
+    CHECK(histogram.getBucket(ofLatencyHistogram::kNumBuckets - 1) == 1, "The last bucket is open-ended");
+
+    histogram.reset();
+    uint64_t total = 0;
+    for (size_t i = 0; i < ofLatencyHistogram::kNumBuckets; ++i) total += histogram.getBucket(i);
+    CHECK(histogram.getCount() == 0 && total == 0, "reset() empties every bucket");
+    CHECK(histogram.getPercentile(0.5) == 0.0 && histogram.getStats().count == 0, "An empty histogram reports zeros");
+}
+
+void test_ofLatencyHistogram_percentiles() {
+    TEST_START("ofLatencyHistogram Percentiles");
+
+    // Half at 3 us, half at 1.5 ms
+    ofLatencyHistogram histogram;
+    for (int i = 0; i < 50; ++i) {
+        histogram.add(3e-6);
+        histogram.add(1500e-6);
+    }
+    auto micros = [&](double fraction) { return (float)(histogram.getPercentile(fraction) * 1e6); };
+    CHECK(floatEquals(micros(0.25), 3.0f, 1e-3f), "p25 is halfway through [2, 4) us");
+    CHECK(floatEquals(micros(0.5), 4.0f, 1e-3f), "p50 is the end of the first half's bucket");
+    CHECK(floatEquals(micros(0.6), 1228.8f, 1e-2f), "p60 is a fifth through [1024, 2048) us");
+    CHECK(floatEquals(micros(0.99), 1500.0f, 1.0f), "p99 is capped at the largest sample");
+    CHECK(micros(0.75) <= micros(0.99) + 1e-3f, "Percentiles never decrease");
+
+    const ofLatencyStats stats = histogram.getStats();
+    CHECK(stats.count == 100, "Stats count");
+    CHECK(floatEquals((float)(stats.mean * 1e6), 751.5f, 1.0f), "Stats mean from the exact sum");
+    CHECK(floatEquals((float)(stats.max * 1e6), 1500.0f, 1.0f), "Stats max is the largest sample");
+    CHECK(floatEquals((float)(stats.p50 * 1e6), 4.0f, 1e-3f) && stats.p99 <= stats.max, "Stats p50 and p99");
+
+    // The open-ended last bucket interpolates up to the largest sample
+    ofLatencyHistogram slow;
+    slow.add(10.0);
+    slow.add(20.0);
+    const double lastStart = ofLatencyHistogram::getBucketStart(ofLatencyHistogram::kNumBuckets - 1);
+    CHECK(floatEquals((float)slow.getPercentile(1.0), 20.0f, 1e-4f), "p100 is the largest sample");
+    CHECK(floatEquals((float)slow.getPercentile(0.5), (float)(lastStart + (20.0 - lastStart) * 0.5), 1e-4f),
+          "p50 is halfway from the last bucket's start to the largest sample");
+}
+
+// ============================================================
+// ofTelemetry Tests
+// ============================================================
+
+void test_ofTelemetry_statsdLines() {
+    TEST_START("ofTelemetry statsd Lines");
+
+    ofTelemetryBatch batch;
+    batch.prefix = "stage1";
+    batch.metrics.push_back({"frame.count", 60.0, ofTelemetryKind::Counter});
+    batch.metrics.push_back({"frame.ms.p99", 16.6667, ofTelemetryKind::Gauge});
+    batch.metrics.push_back({"gpu.memory.bytes", 268435456.0, ofTelemetryKind::Gauge});
+    batch.metrics.push_back({"clock.offset", -2.0, ofTelemetryKind::Gauge});
+    batch.metrics.push_back({"clock.drift", -0.25, ofTelemetryKind::Gauge});
+
+    std::vector<std::string> packets;
+    ofTelemetry::formatStatsd(batch, packets);
+    REQUIRE(packets.size() == 1, "A small batch fits one packet");
+    CHECK(packets[0] ==
+          "stage1.frame.count:60|c\n"
+          "stage1.frame.ms.p99:16.667|g\n"
+          "stage1.gpu.memory.bytes:268435456|g\n"
+          "stage1.clock.offset:-2|g\n"
+          "stage1.clock.drift:-0.250|g",
+          "Counters end in |c, gauges in |g; whole numbers have no fraction, others three digits");
+
+    batch.prefix.clear();
+    batch.metrics.resize(1);
+    ofTelemetry::formatStatsd(batch, packets);
+    CHECK(packets.size() == 1 && packets[0] == "frame.count:60|c", "No prefix, no leading dot");
+
+    batch.metrics.clear();
+    ofTelemetry::formatStatsd(batch, packets);
+    CHECK(packets.empty(), "An empty batch gives no packets");
+}
+
+void test_ofTelemetry_statsdPackets() {
+    TEST_START("ofTelemetry statsd Packet Splitting");
+
+    // Each line is "m<digit>:1|g", 6 bytes; two with the newline are 13
+    ofTelemetryBatch batch;
+    for (int i = 0; i < 5; ++i) {
+        batch.metrics.push_back({"m" + std::to_string(i), 1.0, ofTelemetryKind::Gauge});
+    }
+
+    std::vector<std::string> packets;
+    ofTelemetry::formatStatsd(batch, packets, 13);
+    REQUIRE(packets.size() == 3, "Two lines per 13-byte packet");
+    CHECK(packets[0] == "m0:1|g\nm1:1|g" && packets[0].size() == 13, "A packet may be exactly maxPacketSize");
+    CHECK(packets[1] == "m2:1|g\nm3:1|g" && packets[2] == "m4:1|g", "Lines are never split or reordered");
+
+    ofTelemetry::formatStatsd(batch, packets, 12);
+    CHECK(packets.size() == 5, "One byte less and each line goes alone");
+
+    // A line longer than a packet is still sent, by itself
+    batch.metrics.insert(batch.metrics.begin() + 1, {std::string(40, 'x'), 1.0, ofTelemetryKind::Gauge});
+    ofTelemetry::formatStatsd(batch, packets, 13);
+    REQUIRE(packets.size() == 4, "The long line gets its own packet");
+    CHECK(packets[0] == "m0:1|g" && packets[1] == std::string(40, 'x') + ":1|g", "Lines around it are unchanged");
+    CHECK(packets[2] == "m1:1|g\nm2:1|g", "Packing resumes after it");
+
+    size_t lines = 0;
+    for (const std::string& packet : packets) {
+        lines += (size_t)std::count(packet.begin(), packet.end(), '\n') + 1;
+    }
+    CHECK(lines == batch.metrics.size(), "Every metric is sent once");
+}
+
+// ============================================================
+// ofFlightRecorder Tests
+// ============================================================
+
+static void pushFlightEvent(FlightEventRing& ring, int64_t value) {
+    ring.push([&](FlightEvent& event) {
+        event.time = value;
+        event.kind = FlightEventKind::Allocation;
+        event.bytes = value;
+        std::snprintf(event.text, sizeof(event.text), "allocation %lld", (long long)value);
+    });
+}
+
+// Values value, value + 1... in order
+static bool holdsSequence(const std::vector<FlightEvent>& events, int64_t value) {
+    for (const FlightEvent& event : events) {
+        if (event.bytes != value++) return false;
+    }
+    return true;
+}
+
+void test_FlightEventRing_wrap() {
+    TEST_START("FlightEventRing Wrap and Clear");
+
+    const int64_t slots = (int64_t)FlightEventRing::kSlots;
+    auto ring = std::make_unique<FlightEventRing>();
+    std::vector<FlightEvent> events;
+    ring->snapshot(events);
+    CHECK(events.empty(), "A new ring is empty");
+
+    for (int64_t i = 0; i < 10; ++i) pushFlightEvent(*ring, i);
+    ring->snapshot(events);
+    CHECK(events.size() == 10 && holdsSequence(events, 0), "Before wrapping, every event oldest first");
+    CHECK(std::strcmp(events[3].text, "allocation 3") == 0, "Events are copied whole");
+
+    for (int64_t i = 10; i < slots + 100; ++i) pushFlightEvent(*ring, i);
+    events.clear();
+    ring->snapshot(events);
+    CHECK((int64_t)events.size() == slots, "A wrapped ring holds kSlots events");
+    CHECK(holdsSequence(events, 100), "The oldest were overwritten, the rest stay in order");
+
+    ring->clear();
+    events.clear();
+    ring->snapshot(events);
+    CHECK(events.empty(), "clear() empties the ring");
+    for (int64_t i = 0; i < 3; ++i) pushFlightEvent(*ring, 1000 + i);
+    ring->snapshot(events);
+    CHECK(events.size() == 3 && holdsSequence(events, 1000), "Only events since clear()");
+
+    for (int64_t i = 3; i < slots + 5; ++i) pushFlightEvent(*ring, 1000 + i);
+    events.clear();
+    ring->snapshot(events);
+    CHECK((int64_t)events.size() == slots && holdsSequence(events, 1005), "Wrapping past clear() keeps the newest");
+}
+
+void test_FlightEventRing_concurrent() {
+    TEST_START("FlightEventRing Concurrent Writers");
+
+    // Each writer's events carry its id and a count in both fields; a
+    // snapshot must never show them mismatched or out of order
+    constexpr int kWriters = 4;
+    constexpr int64_t kPerWriter = 20000;
+    auto ring = std::make_unique<FlightEventRing>();
+    std::atomic<int> running{kWriters};
+    std::vector<std::thread> writers;
+    for (int w = 0; w < kWriters; ++w) {
+        writers.emplace_back([&, w] {
+            for (int64_t i = 0; i < kPerWriter; ++i) {
+                ring->push([&](FlightEvent& event) {
+                    event.code = (uint8_t)w;
+                    event.time = i;
+                    event.bytes = i * kWriters + w;
+                });
+            }
+            running.fetch_sub(1);
+        });
+    }
+
+    bool consistent = true;
+    bool ordered = true;
+    size_t snapshots = 0;
+    std::vector<FlightEvent> events;
+    do {
+        events.clear();
+        ring->snapshot(events);
+        snapshots++;
+        consistent = consistent && events.size() <= FlightEventRing::kSlots;
+        int64_t last[kWriters];
+        std::fill(last, last + kWriters, (int64_t)-1);
+        for (const FlightEvent& event : events) {
+            consistent = consistent && event.code < kWriters && event.bytes == event.time * kWriters + event.code;
+            if (event.code < kWriters) {
+                ordered = ordered && event.time > last[event.code];
+                last[event.code] = event.time;
+            }
+        }
+    } while (running.load() > 0);
+    for (auto& writer : writers) writer.join();
+
+    CHECK(snapshots > 0 && consistent, "Snapshots never hold half-written events");
+    CHECK(ordered, "Each writer's events appear in the order pushed");
+
+    events.clear();
+    ring->snapshot(events);
+    CHECK(events.size() == FlightEventRing::kSlots, "Afterwards the ring is full");
+}
+
 // ============================================================
 // Main Test Runner
 // ============================================================
@@ -455,11 +1768,69 @@ int main() {
         // ofMath Functions Tests
         std::cout << "\n" << YELLOW << "=== ofMath Functions Tests ===" << RESET;
         test_ofMath_random();
+        test_ofRandomStream();
         test_ofMath_noise();
+        test_ofMath_noise_batch();
         test_ofMath_mapping();
         test_ofMath_distance();
         test_ofMath_angles();
 
+        // ofOneEuroFilter Tests
+        std::cout << "\n" << YELLOW << "=== ofOneEuroFilter Tests ===" << RESET;
+        test_ofOneEuroFilter();
+
+        // ofxOscRouter Tests
+        std::cout << "\n" << YELLOW << "=== ofxOscRouter Tests ===" << RESET;
+        test_ofxOscRouter_matchPart();
+        test_ofxOscRouter_dispatch();
+        test_ofxOscRouter_coalesce();
+
+        // ofLog Tests
+        std::cout << "\n" << YELLOW << "=== ofLog Tests ===" << RESET;
+        test_LogQueue_producers();
+        test_LogQueue_full();
+        test_LogRepeatFilter();
+        test_ofLogRateLimiter();
+
+        // ofJobSystem Tests
+        std::cout << "\n" << YELLOW << "=== ofJobSystem Tests ===" << RESET;
+        test_ofJobSystem_parallelFor();
+        test_ofJobSystem_dependencies();
+        test_ofJobSystem_waitFromWorker();
+
+        // ofMeshBVH Tests
+        std::cout << "\n" << YELLOW << "=== ofMeshBVH Tests ===" << RESET;
+        test_ofMeshBVH_raycast();
+        test_ofMeshBVH_sphere();
+        test_ofMeshBVH_refit();
+
+        // ofParameterPreset Tests
+        std::cout << "\n" << YELLOW << "=== ofParameterPreset Tests ===" << RESET;
+        test_ofParameterPreset_roundTrip();
+        test_ofParameterPreset_rejection();
+        test_ofParameterPreset_blend();
+
+        // ofParameter Tests
+        std::cout << "\n" << YELLOW << "=== ofParameter Tests ===" << RESET;
+        test_ofParameter_removeDuringNotify();
+        test_ofParameter_listenerLifetime();
+        test_ofParameter_deferred();
+
+        // ofLatencyHistogram Tests
+        std::cout << "\n" << YELLOW << "=== ofLatencyHistogram Tests ===" << RESET;
+        test_ofLatencyHistogram_buckets();
+        test_ofLatencyHistogram_percentiles();
+
+        // ofTelemetry Tests
+        std::cout << "\n" << YELLOW << "=== ofTelemetry Tests ===" << RESET;
+        test_ofTelemetry_statsdLines();
+        test_ofTelemetry_statsdPackets();
+
+        // ofFlightRecorder Tests
+        std::cout << "\n" << YELLOW << "=== ofFlightRecorder Tests ===" << RESET;
+        test_FlightEventRing_wrap();
+        test_FlightEventRing_concurrent();
+
     } catch (const std::exception& e) {
         std::cout << RED << "\nException caught: " << e.what() << RESET << "\n";
     }
@@ -0,0 +1,722 @@
+// GPU Benchmarks for oflike-metal
+// Renders standard scenes headless into an offscreen texture and times each
+// frame end to end: CPU recording, CPU encoding and submission, GPU execution.
+// Results can be stored as a JSON baseline and later runs compared against it.
+//
+// Usage:
+//   gpu_benchmark                                   Run every scene, print results
+//   gpu_benchmark --write-baseline gpu_baseline.json
+//   gpu_benchmark --baseline gpu_baseline.json --threshold 0.15
+//   gpu_benchmark --replay scene.ofldl             Replay frames captured by ofCaptureFrames()
+//
+// Options:
+//   --frames N          Measured frames per scene (default 300)
+//   --warmup N          Unmeasured frames first (default 30)
+//   --size WxH          Offscreen target size (default 1920x1080)
+//   --scene NAME        Run one scene only
+//   --video PATH        Play a movie in the video scene instead of streamed frames
+//   --replay PATH       Run only the captured frames of PATH, looped, as scene "replay"
+//                       (target size defaults to the captured size)
+//   --baseline PATH     Compare with a stored baseline; exit 1 on regression
+//   --threshold F       Allowed slowdown as a fraction (default 0.15)
+//   --write-baseline PATH   Store this run's results
+
+#import <Foundation/Foundation.h>
+#import <Metal/Metal.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/Context.h"
+#include "render/DrawList.h"
+#include "render/metal/MetalRenderer.h"
+#include "render/metal/DrawListCapture.h"
+#include "oflike/graphics/ofGraphics.h"
+#include "oflike/graphics/ofTrueTypeFont.h"
+#include "oflike/image/ofPixels.h"
+#include "oflike/image/ofTexture.h"
+#include "oflike/3d/ofMesh.h"
+#include "oflike/3d/VboMesh.h"
+#include "oflike/3d/of3dPrimitive.h"
+#include "oflike/3d/ofCamera.h"
+#include "oflike/video/ofVideoPlayer.h"
+#include "oflike/math/ofRandom.h"
+
+using namespace oflike;
+
+// ANSI color codes for output
+#define GREEN "\033[32m"
+#define RED "\033[31m"
+#define YELLOW "\033[33m"
+#define CYAN "\033[36m"
+#define RESET "\033[0m"
+
+namespace {
+
+// Regressions smaller than this are timer noise, whatever the ratio
+constexpr double kMinRegressionMs = 0.05;
+
+// ============================================================
+// Options
+// ============================================================
+
+struct Options {
+    int frames = 300;
+    int warmup = 30;
+    int width = 1920;
+    int height = 1080;
+    std::string scene;
+    std::string video;
+    std::string replay;
+    bool sizeGiven = false;
+    std::string baseline;
+    std::string writeBaseline;
+    double threshold = 0.15;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--warmup" && hasValue) {
+            options.warmup = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--size" && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2 ||
+                options.width <= 0 || options.height <= 0) {
+                std::cerr << "Invalid --size, expected WxH" << std::endl;
+                return false;
+            }
+            options.sizeGiven = true;
+        } else if (arg == "--scene" && hasValue) {
+            options.scene = argv[++i];
+        } else if (arg == "--video" && hasValue) {
+            options.video = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            options.replay = argv[++i];
+        } else if (arg == "--baseline" && hasValue) {
+            options.baseline = argv[++i];
+        } else if (arg == "--threshold" && hasValue) {
+            options.threshold = std::atof(argv[++i]);
+        } else if (arg == "--write-baseline" && hasValue) {
+            options.writeBaseline = argv[++i];
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================
+// Metrics
+// ============================================================
+
+struct FrameTimings {
+    std::vector<double> record_ms;      // Scene draw(): DrawList recording
+    std::vector<double> encode_ms;      // executeDrawLists() + endFrame(): encoding and commit
+    std::vector<double> gpu_ms;         // Command buffer GPUStartTime to GPUEndTime
+    std::vector<double> frame_ms;       // beginFrame() to GPU completion
+
+    void reserve(size_t count) {
+        record_ms.reserve(count);
+        encode_ms.reserve(count);
+        gpu_ms.reserve(count);
+        frame_ms.reserve(count);
+    }
+};
+
+// Nearest-rank percentile
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * values.size()));
+    return values[std::min(values.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+// Stored and compared metrics, by JSON key
+using SceneResult = std::map<std::string, double>;
+
+SceneResult summarize(const FrameTimings& t) {
+    return {
+        {"record_p50_ms", percentile(t.record_ms, 50)},
+        {"encode_p50_ms", percentile(t.encode_ms, 50)},
+        {"encode_p99_ms", percentile(t.encode_ms, 99)},
+        {"gpu_p50_ms", percentile(t.gpu_ms, 50)},
+        {"gpu_p99_ms", percentile(t.gpu_ms, 99)},
+        {"frame_p50_ms", percentile(t.frame_ms, 50)},
+        {"frame_p99_ms", percentile(t.frame_ms, 99)},
+    };
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// ============================================================
+// Offscreen Target
+// ============================================================
+
+struct Offscreen {
+    id<MTLTexture> color;
+    id<MTLTexture> depth;
+    MTLRenderPassDescriptor* pass;
+
+    bool create(id<MTLDevice> device, int width, int height) {
+        MTLTextureDescriptor* desc =
+            [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:MTLPixelFormatBGRA8Unorm
+                                                               width:width
+                                                              height:height
+                                                           mipmapped:NO];
+        desc.usage = MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead;
+        desc.storageMode = MTLStorageModePrivate;
+        color = [device newTextureWithDescriptor:desc];
+
+        desc.pixelFormat = MTLPixelFormatDepth32Float;
+        desc.usage = MTLTextureUsageRenderTarget;
+        depth = [device newTextureWithDescriptor:desc];
+        if (!color || !depth) {
+            return false;
+        }
+
+        pass = [MTLRenderPassDescriptor renderPassDescriptor];
+        pass.colorAttachments[0].texture = color;
+        pass.colorAttachments[0].loadAction = MTLLoadActionClear;
+        pass.colorAttachments[0].storeAction = MTLStoreActionStore;
+        pass.colorAttachments[0].clearColor = MTLClearColorMake(0, 0, 0, 1);
+        pass.depthAttachment.texture = depth;
+        pass.depthAttachment.loadAction = MTLLoadActionClear;
+        pass.depthAttachment.storeAction = MTLStoreActionDontCare;
+        pass.depthAttachment.clearDepth = 1.0;
+        return true;
+    }
+};
+
+// ============================================================
+// Scenes
+// ============================================================
+
+struct Scene {
+    std::string name;
+    std::function<bool()> setup;        // false: skipped on this machine
+    std::function<void(int frame)> draw;
+    std::function<void()> teardown;
+
+    // Prebuilt, already optimized lists rendered instead of draw()'s
+    std::function<const std::vector<const render::DrawList*>&(int frame)> lists;
+};
+
+Scene makeSpritesScene(const Options& options) {
+    struct State {
+        ofTexture texture;
+        std::vector<float> x, y;
+        std::vector<uint8_t> tint;
+    };
+    auto state = std::make_shared<State>();
+    const size_t count = 10000;
+
+    Scene scene;
+    scene.name = "sprites_10k";
+    scene.setup = [state, count, options] {
+        ofPixels pixels;
+        pixels.allocate(32, 32, 4);
+        for (size_t i = 0; i < 32 * 32; ++i) {
+            const float dx = (i % 32) - 15.5f, dy = (i / 32) - 15.5f;
+            const uint8_t a = static_cast<uint8_t>(std::max(0.0f, 255.0f - std::sqrt(dx * dx + dy * dy) * 16.0f));
+            uint8_t* p = pixels.getData() + i * 4;
+            p[0] = p[1] = p[2] = 255;
+            p[3] = a;
+        }
+        state->texture.loadData(pixels);
+
+        ofRandomStream rng(1);
+        state->x.resize(count);
+        state->y.resize(count);
+        state->tint.resize(count);
+        rng.fill(state->x.data(), count, 0.0f, static_cast<float>(options.width));
+        rng.fill(state->y.data(), count, 0.0f, static_cast<float>(options.height));
+        for (uint8_t& t : state->tint) {
+            t = static_cast<uint8_t>(rng.nextUInt(256));
+        }
+        return state->texture.isAllocated();
+    };
+    scene.draw = [state, count](int frame) {
+        ofEnableAlphaBlending();
+        const float wobble = std::sin(frame * 0.05f) * 8.0f;
+        for (size_t i = 0; i < count; ++i) {
+            ofSetColor(255, state->tint[i], 255 - state->tint[i]);
+            state->texture.draw(state->x[i] + wobble, state->y[i], 16.0f, 16.0f);
+        }
+    };
+    scene.teardown = [state] { state->texture.clear(); };
+    return scene;
+}
+
+Scene makeInstancesScene(const Options&) {
+    struct State {
+        VboMesh mesh;
+        ofCamera camera;
+    };
+    auto state = std::make_shared<State>();
+    const size_t count = 100000;
+
+    Scene scene;
+    scene.name = "instances_100k";
+    scene.setup = [state, count] {
+        ofBoxPrimitive box(0.6f);
+        if (!state->mesh.setMesh(box.getMesh(), VboUsageHint::Static)) {
+            return false;
+        }
+        // 100 x 100 x 10 grid of cubes
+        std::vector<VboInstanceData> instances(count);
+        for (size_t i = 0; i < count; ++i) {
+            const float x = static_cast<float>(i % 100) - 49.5f;
+            const float y = static_cast<float>((i / 100) % 100) - 49.5f;
+            const float z = -static_cast<float>(i / 10000) * 2.0f;
+            simd_float4x4 m = matrix_identity_float4x4;
+            m.columns[3] = simd_make_float4(x, y, z, 1.0f);
+            instances[i] = VboInstanceData(m, simd_make_float4(0.5f + x / 100.0f, 0.5f + y / 100.0f, 0.8f, 1.0f));
+        }
+        state->mesh.setInstances(instances.data(), count);
+        state->camera.setNearClip(1.0f);
+        state->camera.setFarClip(1000.0f);
+        return true;
+    };
+    scene.draw = [state, count](int frame) {
+        const float angle = frame * 0.01f;
+        state->camera.setPosition(std::sin(angle) * 40.0f, 20.0f, 90.0f);
+        state->camera.lookAt(ofVec3f(0, 0, -10));
+        state->camera.begin();
+        ofEnableDepthTest();
+        state->mesh.drawInstanced(count);
+        ofDisableDepthTest();
+        state->camera.end();
+    };
+    scene.teardown = [state] { state->mesh.clear(); };
+    return scene;
+}
+
+// Splats drawn as additive colored points; the core has no splat renderer
+Scene makeSplatsScene(const Options&) {
+    struct State {
+        VboMesh mesh;
+        ofCamera camera;
+    };
+    auto state = std::make_shared<State>();
+    const size_t count = 1000000;
+
+    Scene scene;
+    scene.name = "splats_1m";
+    scene.setup = [state, count] {
+        ofMesh points;
+        points.setMode(OF_PRIMITIVE_POINTS);
+        ofRandomStream rng(2);
+        for (size_t i = 0; i < count; ++i) {
+            // Gaussian-ish ball: sum of three uniforms per axis
+            float p[3];
+            for (float& c : p) {
+                c = (rng.nextFloat() + rng.nextFloat() + rng.nextFloat() - 1.5f) * 40.0f;
+            }
+            points.addVertex(ofVec3f(p[0], p[1], p[2]));
+            points.addColor(ofColor(static_cast<uint8_t>(128 + p[0] * 2), 96,
+                                    static_cast<uint8_t>(128 - p[1] * 2), 24));
+        }
+        return state->mesh.setMesh(points, VboUsageHint::Static);
+    };
+    scene.draw = [state](int frame) {
+        const float angle = frame * 0.01f;
+        state->camera.setPosition(std::sin(angle) * 150.0f, 0.0f, std::cos(angle) * 150.0f);
+        state->camera.lookAt(ofVec3f(0, 0, 0));
+        state->camera.begin();
+        ofEnableBlendMode(OF_BLENDMODE_ADD);
+        state->mesh.draw();
+        ofEnableAlphaBlending();
+        state->camera.end();
+    };
+    scene.teardown = [state] { state->mesh.clear(); };
+    return scene;
+}
+
+Scene makeTextScene(const Options& options) {
+    auto font = std::make_shared<ofTrueTypeFont>();
+    auto lines = std::make_shared<std::vector<std::string>>();
+
+    Scene scene;
+    scene.name = "text_wall";
+    scene.setup = [font, lines, options] {
+        if (!font->load("Helvetica", 12)) {
+            return false;
+        }
+        const std::string alphabet =
+            "The quick brown fox jumps over the lazy dog 0123456789 ";
+        const int rows = options.height / 16;
+        for (int r = 0; r < rows; ++r) {
+            std::string line;
+            while (line.size() < 200) {
+                line += alphabet.substr(r % alphabet.size()) + alphabet;
+            }
+            lines->push_back(line.substr(0, 200));
+        }
+        return true;
+    };
+    scene.draw = [font, lines](int frame) {
+        ofSetColor(230, 230, 230);
+        for (size_t r = 0; r < lines->size(); ++r) {
+            font->drawString((*lines)[r], 8.0f - (frame % 16), 16.0f * (r + 1));
+        }
+    };
+    scene.teardown = [font] { *font = ofTrueTypeFont(); };
+    return scene;
+}
+
+// Without --video, frames are streamed into a texture as a decoder would
+Scene makeVideoScene(const Options& options) {
+    struct State {
+        ofVideoPlayer player;
+        ofTexture texture;
+        ofPixels pixels;
+    };
+    auto state = std::make_shared<State>();
+
+    Scene scene;
+    scene.name = "video_playback";
+    scene.setup = [state, options] {
+        if (!options.video.empty()) {
+            if (!state->player.load(options.video)) {
+                return false;
+            }
+            state->player.setLoopState(OF_LOOP_NORMAL);
+            state->player.play();
+            return true;
+        }
+        state->pixels.allocate(1920, 1080, 4);
+        std::fill(state->pixels.getData(), state->pixels.getData() + 1920 * 1080 * 4, 64);
+        state->texture.setStreaming(true);
+        state->texture.loadData(state->pixels);
+        return state->texture.isAllocated();
+    };
+    scene.draw = [state, options](int frame) {
+        const float w = static_cast<float>(options.width);
+        const float h = static_cast<float>(options.height);
+        ofSetColor(255);
+        if (!options.video.empty()) {
+            state->player.update();
+            state->player.draw(0, 0, w, h);
+            return;
+        }
+        // A moving band keeps each upload different
+        uint8_t* row = state->pixels.getData() + static_cast<size_t>(frame % 1080) * 1920 * 4;
+        std::fill(row, row + 1920 * 4, static_cast<uint8_t>(frame * 7));
+        state->texture.loadData(state->pixels);
+        state->texture.draw(0, 0, w, h);
+    };
+    scene.teardown = [state] {
+        state->player.close();
+        state->texture.clear();
+    };
+    return scene;
+}
+
+// Frames captured with ofCaptureFrames(), looped; recording cost is not part
+// of a replay, so only encoding and GPU time are measured
+Scene makeReplayScene(std::shared_ptr<render::metal::DrawListReplay> replay) {
+    Scene scene;
+    scene.name = "replay";
+    scene.setup = [replay] { return replay->getFrameCount() > 0; };
+    scene.draw = [](int) {};
+    scene.teardown = [] {};
+    scene.lists = [replay](int frame) -> const std::vector<const render::DrawList*>& {
+        return replay->getFrame(static_cast<size_t>(frame) % replay->getFrameCount());
+    };
+    return scene;
+}
+
+// ============================================================
+// Frame Loop
+// ============================================================
+
+bool renderFrame(render::metal::MetalRenderer& renderer, const Offscreen& target,
+                 Scene& scene, int frame, FrameTimings* timings) {
+    using clock = std::chrono::steady_clock;
+    Context& context = Context::instance();
+    context.incrementFrame();
+
+    const auto begin = clock::now();
+    if (!renderer.beginFrame()) {
+        return false;
+    }
+    renderer.setFrameTarget(nullptr, (__bridge void*)target.pass);
+
+    bool executed;
+    auto recorded = begin;
+    if (scene.lists) {
+        const std::vector<const render::DrawList*>& lists = scene.lists(frame);
+        recorded = clock::now();
+        executed = renderer.executeDrawLists(lists.data(), lists.size());
+    } else {
+        render::DrawList& drawList = context.getDrawList();
+        renderer.bindFrameStorage(drawList);
+
+        scene.draw(frame);
+        recorded = clock::now();
+
+        std::vector<render::DrawList*> drawLists;
+        context.collectDrawLists(drawLists);
+        for (render::DrawList* list : drawLists) {
+            list->optimize();
+        }
+        executed = renderer.executeDrawLists(drawLists.data(), drawLists.size());
+        for (render::DrawList* list : drawLists) {
+            list->reset();
+        }
+    }
+    const bool ended = renderer.endFrame();
+    const auto encoded = clock::now();
+
+    renderer.waitForFrames();
+    const auto completed = clock::now();
+
+    if (timings) {
+        timings->record_ms.push_back(elapsedMs(begin, recorded));
+        timings->encode_ms.push_back(elapsedMs(recorded, encoded));
+        timings->gpu_ms.push_back(renderer.getLastGPUTime());
+        timings->frame_ms.push_back(elapsedMs(begin, completed));
+    }
+    return executed && ended;
+}
+
+// ============================================================
+// Baseline
+// ============================================================
+
+bool writeBaseline(const std::string& path, const std::map<std::string, SceneResult>& results,
+                   const Options& options, id<MTLDevice> device) {
+    NSMutableDictionary* scenes = [NSMutableDictionary dictionary];
+    for (const auto& [name, result] : results) {
+        NSMutableDictionary* metrics = [NSMutableDictionary dictionary];
+        for (const auto& [key, value] : result) {
+            metrics[@(key.c_str())] = @(value);
+        }
+        scenes[@(name.c_str())] = metrics;
+    }
+    NSDictionary* root = @{
+        @"device" : device.name,
+        @"width" : @(options.width),
+        @"height" : @(options.height),
+        @"frames" : @(options.frames),
+        @"scenes" : scenes,
+    };
+
+    NSError* error = nil;
+    NSData* data = [NSJSONSerialization dataWithJSONObject:root
+                                                   options:NSJSONWritingPrettyPrinted | NSJSONWritingSortedKeys
+                                                     error:&error];
+    if (!data || ![data writeToFile:@(path.c_str()) atomically:YES]) {
+        std::cerr << RED << "Failed to write baseline " << path << RESET << std::endl;
+        return false;
+    }
+    std::cout << "Baseline written to " << path << "\n";
+    return true;
+}
+
+// @return Number of metrics slower than the baseline allows, or -1 if unreadable
+int compareBaseline(const std::string& path, const std::map<std::string, SceneResult>& results,
+                    const Options& options, id<MTLDevice> device) {
+    NSData* data = [NSData dataWithContentsOfFile:@(path.c_str())];
+    NSDictionary* root = data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:nil] : nil;
+    NSDictionary* scenes = [root isKindOfClass:[NSDictionary class]] ? root[@"scenes"] : nil;
+    if (![scenes isKindOfClass:[NSDictionary class]]) {
+        std::cerr << RED << "Failed to read baseline " << path << RESET << std::endl;
+        return -1;
+    }
+
+    NSString* baselineDevice = root[@"device"];
+    if ([baselineDevice isKindOfClass:[NSString class]] && ![baselineDevice isEqualToString:device.name]) {
+        std::cout << YELLOW << "Baseline was recorded on " << baselineDevice.UTF8String
+                  << "; timings may not be comparable" << RESET << "\n";
+    }
+    if ([root[@"width"] intValue] != options.width || [root[@"height"] intValue] != options.height) {
+        std::cout << YELLOW << "Baseline was recorded at " << [root[@"width"] intValue] << "x"
+                  << [root[@"height"] intValue] << RESET << "\n";
+    }
+
+    std::cout << "\n" << YELLOW << "Baseline comparison (threshold +"
+              << options.threshold * 100.0 << "%):" << RESET << "\n";
+    int regressions = 0;
+    for (const auto& [name, result] : results) {
+        NSDictionary* stored = scenes[@(name.c_str())];
+        if (![stored isKindOfClass:[NSDictionary class]]) {
+            std::cout << "  " << name << ": not in baseline\n";
+            continue;
+        }
+        for (const auto& [key, value] : result) {
+            NSNumber* number = stored[@(key.c_str())];
+            if (![number isKindOfClass:[NSNumber class]]) {
+                continue;
+            }
+            const double reference = number.doubleValue;
+            const double limit = std::max(reference * (1.0 + options.threshold), reference + kMinRegressionMs);
+            const bool regressed = value > limit;
+            if (regressed) {
+                ++regressions;
+            }
+            const double change = reference > 0.0 ? (value / reference - 1.0) * 100.0 : 0.0;
+            std::cout << "  " << (regressed ? RED "✗ " : GREEN "✓ ") << name << "." << key << ": "
+                      << value << " ms (baseline " << reference << " ms, "
+                      << (change >= 0 ? "+" : "") << change << "%)" << RESET << "\n";
+        }
+    }
+    return regressions;
+}
+
+} // namespace
+
+// ============================================================
+// Main Benchmark Runner
+// ============================================================
+
+int main(int argc, char** argv) {
+    @autoreleasepool {
+        Options options;
+        if (!parseOptions(argc, argv, options)) {
+            return 2;
+        }
+
+        std::cout << "\n" << std::string(70, '=') << "\n";
+        std::cout << "OFLIKE-METAL GPU BENCHMARKS\n";
+        std::cout << std::string(70, '=') << "\n";
+
+        id<MTLDevice> device = MTLCreateSystemDefaultDevice();
+        if (!device) {
+            std::cout << YELLOW << "No Metal device available; GPU benchmarks skipped" << RESET << "\n";
+            return 0;
+        }
+        // Captured frames render at their own size unless --size is given
+        auto replay = std::make_shared<render::metal::DrawListReplay>((__bridge void*)device);
+        if (!options.replay.empty()) {
+            if (!replay->load(options.replay) || replay->getFrameCount() == 0) {
+                std::cerr << RED << "Failed to load capture " << options.replay << RESET << std::endl;
+                return 1;
+            }
+            if (!options.sizeGiven && replay->getFrameWidth(0) > 0 && replay->getFrameHeight(0) > 0) {
+                options.width = static_cast<int>(replay->getFrameWidth(0));
+                options.height = static_cast<int>(replay->getFrameHeight(0));
+            }
+            std::cout << "Replaying " << replay->getFrameCount() << " frames, "
+                      << replay->getResourceCount() << " textures and buffers from " << options.replay << "\n";
+        }
+
+        std::cout << "Device: " << device.name.UTF8String << ", target "
+                  << options.width << "x" << options.height << ", "
+                  << options.frames << " frames per scene\n";
+
+        // Headless: a renderer without a view draws into the offscreen pass
+        Context& context = Context::instance();
+        context.initialize((__bridge void*)device);
+        context.initializeRenderer((__bridge void*)device, nullptr);
+        auto* renderer = dynamic_cast<render::metal::MetalRenderer*>(context.renderer());
+        if (!renderer) {
+            std::cerr << RED << "Renderer initialization failed" << RESET << std::endl;
+            return 1;
+        }
+        context.setWindowSize(options.width, options.height);
+        renderer->setViewport(0, 0, static_cast<float>(options.width), static_cast<float>(options.height));
+
+        Offscreen target;
+        if (!target.create(device, options.width, options.height)) {
+            std::cerr << RED << "Failed to create offscreen target" << RESET << std::endl;
+            return 1;
+        }
+
+        std::vector<Scene> scenes;
+        if (!options.replay.empty()) {
+            scenes.push_back(makeReplayScene(replay));
+        } else {
+            scenes = {
+                makeSpritesScene(options),
+                makeInstancesScene(options),
+                makeSplatsScene(options),
+                makeTextScene(options),
+                makeVideoScene(options),
+            };
+        }
+
+        std::map<std::string, SceneResult> results;
+        bool failed = false;
+        for (Scene& scene : scenes) {
+            if (!options.scene.empty() && scene.name != options.scene) {
+                continue;
+            }
+            std::cout << "\n" << CYAN << "[BENCHMARK] " << scene.name << RESET << "\n";
+            if (!scene.setup()) {
+                std::cout << YELLOW << "  Skipped: scene setup failed" << RESET << "\n";
+                continue;
+            }
+
+            bool ok = true;
+            for (int i = 0; i < options.warmup && ok; ++i) {
+                @autoreleasepool {
+                    ok = renderFrame(*renderer, target, scene, i, nullptr);
+                }
+            }
+            FrameTimings timings;
+            timings.reserve(options.frames);
+            for (int i = 0; i < options.frames && ok; ++i) {
+                @autoreleasepool {
+                    ok = renderFrame(*renderer, target, scene, options.warmup + i, &timings);
+                }
+            }
+            scene.teardown();
+            if (!ok) {
+                std::cout << RED << "  Failed: frame did not render" << RESET << "\n";
+                failed = true;
+                continue;
+            }
+
+            const SceneResult result = summarize(timings);
+            results[scene.name] = result;
+            std::cout << "  CPU record p50:  " << result.at("record_p50_ms") << " ms\n";
+            std::cout << "  CPU encode p50:  " << result.at("encode_p50_ms") << " ms"
+                      << "  p99: " << result.at("encode_p99_ms") << " ms\n";
+            std::cout << "  GPU p50:         " << result.at("gpu_p50_ms") << " ms"
+                      << "  p99: " << result.at("gpu_p99_ms") << " ms\n";
+            std::cout << GREEN << "  Frame p50:       " << result.at("frame_p50_ms") << " ms"
+                      << "  p99: " << result.at("frame_p99_ms") << " ms" << RESET << "\n";
+        }
+
+        int regressions = 0;
+        if (!options.baseline.empty()) {
+            regressions = compareBaseline(options.baseline, results, options, device);
+        }
+        if (!options.writeBaseline.empty() && !writeBaseline(options.writeBaseline, results, options, device)) {
+            failed = true;
+        }
+
+        context.shutdown();
+
+        std::cout << "\n" << std::string(70, '=') << "\n";
+        if (failed || regressions != 0) {
+            if (regressions < 0) {
+                std::cout << RED << "✗ BASELINE UNREADABLE" << RESET << "\n";
+            } else if (regressions > 0) {
+                std::cout << RED << "✗ " << regressions << " METRIC(S) REGRESSED" << RESET << "\n";
+            } else {
+                std::cout << RED << "✗ BENCHMARK FAILED" << RESET << "\n";
+            }
+            return 1;
+        }
+        std::cout << GREEN << "✓ GPU BENCHMARKS COMPLETE" << RESET << "\n";
+        std::cout << std::string(70, '=') << "\n";
+        return 0;
+    }
+}
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <string>
 #include <cmath>
+#include <stdexcept>
 
 // Include all graphics headers
 #include "ofGraphics.h"
@@ -14,6 +15,7 @@
 #include "ofMatrix4x4.h"
 #include "ofPath.h"
 #include "ofPolyline.h"
+#include "ofDisplayList.h"
 
 // Use oflike namespace for simpler syntax
 using namespace oflike;
@@ -123,6 +125,46 @@ void test_path_api() {
         // Tessellation
         std::vector<ofPolyline> outline = path.getOutline();
 
+        // Indexed tessellation matches the triangle list (two triangles)
+        ofPath square;
+        square.setPolyWindingMode(OF_POLY_WINDING_NONZERO);
+        square.moveTo(0, 0);
+        square.lineTo(10, 0);
+        square.lineTo(10, 10);
+        square.lineTo(0, 10);
+        square.close();
+        std::vector<ofVec3f> vertices;
+        std::vector<uint32_t> indices;
+        square.getTessellation(vertices, indices);
+        if (vertices.size() < 4 || indices.size() != 6 || square.getTessellation().size() != 6) {
+            TEST_FAIL("Indexed tessellation mismatch");
+            return;
+        }
+
+        // Batch tessellation fills every path's caches; an open square
+        // stroke is three quads plus two miter wedges
+        std::vector<ofPath> paths(8, square);
+        paths[1].setStrokeWidth(4.0f);
+        paths[1].setFilled(false);
+        paths[2].clear();
+        paths[2].setStrokeWidth(4.0f);
+        paths[2].moveTo(0, 0);
+        paths[2].lineTo(10, 0);
+        paths[2].lineTo(10, 10);
+        paths[2].lineTo(0, 10);
+        ofPath::tessellateAll(paths);
+        paths[0].getTessellation(vertices, indices);
+        std::vector<ofVec3f> strokeVertices;
+        std::vector<uint32_t> strokeIndices;
+        paths[2].getStrokeMesh(strokeVertices, strokeIndices);
+        std::vector<ofVec3f> thinVertices;
+        std::vector<uint32_t> thinIndices;
+        square.getStrokeMesh(thinVertices, thinIndices);
+        if (indices.size() != 6 || strokeIndices.size() != 3 * 6 + 2 * 6 || !thinIndices.empty()) {
+            TEST_FAIL("Batch tessellation or stroke mesh mismatch");
+            return;
+        }
+
         TEST_PASS("Path API works");
     } catch (const std::exception& e) {
         TEST_FAIL(e.what());
@@ -180,6 +222,107 @@ void test_polyline_api() {
     }
 }
 
+void test_polyline_queries() {
+    TEST_START("ofPolyline cached lengths and segment tree queries");
+
+    try {
+        // A closed wavy ring, large enough for the segment tree
+        ofPolyline ring;
+        const int count = 1000;
+        for (int i = 0; i < count; ++i) {
+            float angle = 6.2831853f * i / count;
+            float radius = 100.0f + 10.0f * std::sin(angle * 17.0f);
+            ring.addVertex(radius * std::cos(angle), radius * std::sin(angle));
+        }
+        ring.close();
+
+        // Queries answered by the tree match a scan of every segment
+        const std::vector<ofVec3f>& vertices = ring.getVertices();
+        bool matches = true;
+        for (int q = 0; q < 200; ++q) {
+            ofVec3f target(std::fmod(q * 37.0f, 260.0f) - 130.0f, std::fmod(q * 53.0f, 260.0f) - 130.0f, 0.0f);
+
+            float bestDist = 1e30f;
+            bool inside = false;
+            for (size_t i = 0, n = vertices.size(); i < n; ++i) {
+                const ofVec3f& a = vertices[i];
+                const ofVec3f& b = vertices[(i + 1) % n];
+                if (i + 1 < n) {
+                    ofVec3f ab = b - a;
+                    float t = std::max(0.0f, std::min(1.0f, (target - a).dot(ab) / std::max(ab.lengthSquared(), 1e-12f)));
+                    bestDist = std::min(bestDist, (a + ab * t).distance(target));
+                }
+                if ((a.y > target.y) != (b.y > target.y) &&
+                    target.x < a.x + (target.y - a.y) * (b.x - a.x) / (b.y - a.y)) {
+                    inside = !inside;
+                }
+            }
+
+            if (std::abs(ring.getClosestPoint(target).distance(target) - bestDist) > 1e-3f ||
+                ring.inside(target.x, target.y) != inside) {
+                matches = false;
+            }
+        }
+
+        // Cached lengths follow edits
+        ofPolyline line;
+        line.addVertex(0, 0);
+        line.addVertex(3, 4);
+        float before = line.getPerimeter();
+        line.addVertex(3, 10);
+        float after = line.getPerimeter();
+
+        if (!matches) {
+            TEST_FAIL("Segment tree queries differ from a scan");
+        } else if (std::abs(before - 5.0f) > 1e-4f || std::abs(after - 11.0f) > 1e-4f ||
+                   std::abs(line.getLengthAtIndex(1) - 5.0f) > 1e-4f) {
+            TEST_FAIL("Cached lengths not updated after an edit");
+        } else {
+            TEST_PASS("Tree queries match a scan, lengths follow edits");
+        }
+    } catch (const std::exception& e) {
+        TEST_FAIL(e.what());
+    }
+}
+
+void test_curve_tolerance() {
+    TEST_START("Adaptive curve flattening");
+
+    try {
+        // Vertices added by one bezierTo from the origin
+        auto flatten = [](float size) {
+            ofPolyline poly;
+            poly.addVertex(0, 0);
+            poly.bezierTo(0, size, 0, size, size, 0, size, 0, 0);
+            return poly.size() - 1;
+        };
+
+        ofSetCurveResolution(20);
+        size_t fixedSmall = flatten(2.0f);
+        size_t fixedLarge = flatten(2000.0f);
+
+        ofSetCurveTolerance(0.25f);
+        size_t adaptiveSmall = flatten(2.0f);
+        size_t adaptiveLarge = flatten(2000.0f);
+        ofPushMatrix();
+        ofScale(100.0f, 100.0f);
+        size_t adaptiveScaled = flatten(2.0f);     // 200 pixels on screen
+        ofPopMatrix();
+        ofSetCurveTolerance(0.0f);
+
+        if (fixedSmall != 20 || fixedLarge != 20) {
+            TEST_FAIL("Fixed resolution changed without a tolerance");
+        } else if (adaptiveSmall >= fixedSmall || adaptiveLarge <= fixedLarge ||
+                   adaptiveScaled <= adaptiveSmall) {
+            TEST_FAIL("Segment counts do not follow on-screen size");
+        } else {
+            TEST_PASS("Segments follow on-screen size under a tolerance");
+        }
+    } catch (const std::exception& e) {
+        TEST_FAIL(e.what());
+    }
+}
+
 // ============================================================
 // Graphics State API Tests
 // ============================================================
@@ -266,6 +409,19 @@ void test_drawing_api() {
         ofDrawArrow(ofVec3f(0, 0, 0), ofVec3f(50, 50, 0), 5);
         ofDrawRotationAxes(50);
 
+        // Display list: record once, replay translated
+        ofDisplayList background;
+        ofBeginDisplayList(background);
+        ofDrawRectangle(0, 0, 50, 50);
+        ofDrawCircle(25, 25, 10);
+        ofEndDisplayList();
+        if (background.isRecording() || !background.isRecorded()) {
+            throw std::runtime_error("display list recording failed");
+        }
+        background.draw();
+        background.draw(100, 0);
+        ofDrawDisplayList(background);
+
         TEST_PASS("Drawing functions are callable");
     } catch (const std::exception& e) {
         TEST_FAIL(e.what());
@@ -345,6 +501,19 @@ void test_shape_api() {
         ofVertex(25, 75);
         ofEndShape(true);
 
+        // Cached tessellation: the repeat reuses the first fill
+        ofSetPolyMode(OF_POLY_WINDING_NONZERO);
+        ofEnableShapeCache();
+        for (int i = 0; i < 2; ++i) {
+            ofBeginShape();
+            ofVertex(0, 0);
+            ofVertex(100, 0);
+            ofVertex(50, 100);
+            ofEndShape(true);
+        }
+        ofDisableShapeCache();
+        ofSetPolyMode(OF_POLY_WINDING_ODD);
+
         TEST_PASS("Shape building API works");
     } catch (const std::exception& e) {
         TEST_FAIL(e.what());
@@ -407,6 +576,8 @@ int main(int argc, char** argv) {
         std::cout << "\n" << YELLOW << "=== Path & Polyline API Tests ===" << RESET;
         test_path_api();
         test_polyline_api();
+        test_polyline_queries();
+        test_curve_tolerance();
 
         // Graphics State Tests
         std::cout << "\n" << YELLOW << "=== Graphics State API Tests ===" << RESET;
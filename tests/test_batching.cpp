@@ -2,8 +2,11 @@
 
 #include "render/DrawList.h"
 #include "render/RenderTypes.h"
+#include "render/AtlasPacker.h"
+#include "render/TextureCompression.h"
 #include <iostream>
 #include <cassert>
+#include <cstring>
 
 using namespace render;
 
@@ -61,7 +64,7 @@ void testBasic2DBatching() {
 
     if (passed) {
         const auto& commands = list.getCommands();
-        const DrawCommand2D& merged = commands[0].draw2D;
+        const DrawCommand2D& merged = commands[0].as<DrawCommand2D>();
         assert(merged.vertexCount == 9); // 3 triangles * 3 vertices
         std::cout << "  - Batched 3 commands into 1 (9 vertices total)" << std::endl;
     }
@@ -150,13 +153,13 @@ void testIndexedBatching() {
         list.addVertex2D(v3);
         list.addVertex2D(v4);
 
-        // Add 6 indices for 2 triangles
-        uint32_t idxOffset = list.addIndex(vtxOffset + 0);
-        list.addIndex(vtxOffset + 1);
-        list.addIndex(vtxOffset + 2);
-        list.addIndex(vtxOffset + 0);
-        list.addIndex(vtxOffset + 2);
-        list.addIndex(vtxOffset + 3);
+        // Add 6 indices for 2 triangles (relative to the command's vertexOffset)
+        uint32_t idxOffset = list.addIndex(0);
+        list.addIndex(1);
+        list.addIndex(2);
+        list.addIndex(0);
+        list.addIndex(2);
+        list.addIndex(3);
 
         DrawCommand2D cmd;
         cmd.vertexOffset = vtxOffset;
@@ -175,12 +178,16 @@ void testIndexedBatching() {
     list.optimize();
     size_t optimizedCount = list.getCommandCount();
 
-    bool passed = (originalCount == 2) && (optimizedCount == 1);
+    // The second quad's indices must be rebased onto the merged command
+    bool rebased = list.getIndexCount() == 12 &&
+                   list.getIndexData()[6] == 4 && list.getIndexData()[11] == 7;
+
+    bool passed = (originalCount == 2) && (optimizedCount == 1) && rebased;
     printTestResult("Indexed Batching", passed);
 
     if (passed) {
         const auto& commands = list.getCommands();
-        const DrawCommand2D& merged = commands[0].draw2D;
+        const DrawCommand2D& merged = commands[0].as<DrawCommand2D>();
         assert(merged.vertexCount == 8); // 2 quads * 4 vertices
         assert(merged.indexCount == 12); // 2 quads * 6 indices
         std::cout << "  - Batched 2 indexed quads into 1 (8 vertices, 12 indices)" << std::endl;
@@ -223,9 +230,9 @@ void testCommandSorting() {
     const auto& commands = list.getCommands();
 
     // After sorting, should be ordered: nullptr < 0x1000 < 0x2000
-    bool passed = (commands[0].draw2D.texture == nullptr) &&
-                  (commands[1].draw2D.texture == texture1) &&
-                  (commands[2].draw2D.texture == texture2);
+    bool passed = (commands[0].as<DrawCommand2D>().texture == nullptr) &&
+                  (commands[1].as<DrawCommand2D>().texture == texture1) &&
+                  (commands[2].as<DrawCommand2D>().texture == texture2);
 
     printTestResult("Command Sorting", passed);
 
@@ -326,6 +333,1925 @@ void testStateCommands() {
     }
 }
 
+// Test 8: Packed command stream stores records at their own size
+void testPackedCommandStream() {
+    DrawList list;
+
+    SetViewportCommand vp;
+    vp.viewport = Rect(0, 0, 800, 600);
+    list.addCommand(vp);
+
+    DrawCommand3D cmd3D;
+    cmd3D.vertexCount = 3;
+    cmd3D.useLighting = true;
+    LightingState lighting;
+    lighting.lightCount = 2;
+    float* lights = list.allocateLights(2, lighting.firstLight);
+    lights[kLightFloats] = 0.5f;   // Second light's type
+    cmd3D.lightingHandle = list.addLightingState(lighting);
+    list.addCommand(cmd3D);
+
+    list.addCommand(vp);
+
+    const auto& commands = list.getCommands();
+
+    // Linear walk must visit the records in order with the right tags
+    size_t visited = 0;
+    CommandType expected[3] = {CommandType::SetViewport, CommandType::Draw3D, CommandType::SetViewport};
+    bool orderOk = true;
+    for (CommandRef ref : commands) {
+        if (visited >= 3 || ref.type != expected[visited]) {
+            orderOk = false;
+        }
+        visited++;
+    }
+
+    const DrawCommand3D& stored = commands[1].as<DrawCommand3D>();
+    const LightingState* storedLighting = list.getLightingState(stored.lightingHandle);
+
+    size_t expectedBytes = CommandStream::alignedSize(sizeof(SetViewportCommand)) * 2 +
+                           CommandStream::alignedSize(sizeof(DrawCommand3D));
+
+    bool passed = orderOk && (visited == 3) &&
+                  (list.getCommandDataSize() == expectedBytes) &&
+                  storedLighting && (storedLighting->lightCount == 2) &&
+                  (list.getLightData().size() == 2 * kLightFloats) &&
+                  (list.getLightData()[(storedLighting->firstLight + 1) * kLightFloats] == 0.5f);
+    printTestResult("Packed Command Stream", passed);
+
+    if (passed) {
+        std::cout << "  - 3 commands in " << list.getCommandDataSize()
+                  << " bytes (viewport record: "
+                  << CommandStream::alignedSize(sizeof(SetViewportCommand)) << " bytes)" << std::endl;
+    }
+}
+
+// ============================================================================
+// Test 9: Mapped (zero-copy) storage
+// ============================================================================
+
+void testMappedStorage() {
+    DrawList list;
+
+    // Geometry recorded before binding must be carried into the mapping
+    list.addVertex2D(Vertex2D(0, 0, 0, 0, 1, 1, 1, 1));
+
+    // Stand-in for the renderer's persistently mapped frame buffers
+    Vertex2D mapped2D[4];
+    Vertex3D mapped3D[4];
+    uint32_t mappedIndices[4];
+
+    DrawList::MappedStorage storage;
+    storage.vertices2D = mapped2D;
+    storage.capacity2D = 4;
+    storage.vertices3D = mapped3D;
+    storage.capacity3D = 4;
+    storage.indices = mappedIndices;
+    storage.capacityIndices = 4;
+
+    bool bound = list.bindMappedStorage(storage);
+    list.addVertex2D(Vertex2D(1, 0, 0, 0, 1, 1, 1, 1));
+    list.addIndex(7);
+
+    bool writesInPlace = bound && list.isMapped() &&
+                         (list.getVertex2DData() == mapped2D) &&
+                         (list.getVertex2DCount() == 2) &&
+                         (mapped2D[1].position.x == 1.0f) &&
+                         (list.getIndexData() == mappedIndices) &&
+                         (mappedIndices[0] == 7);
+
+    // Overflowing the mapping spills everything back into owned memory
+    for (int i = 0; i < 3; ++i) {
+        list.addVertex2D(Vertex2D(float(i + 2), 0, 0, 0, 1, 1, 1, 1));
+    }
+    bool spilled = !list.isMapped() && list.hasMappedOverflow() &&
+                   (list.getVertex2DCount() == 5) &&
+                   (list.getVertex2DData() != mapped2D) &&
+                   (list.getVertex2DData()[4].position.x == 4.0f) &&
+                   (list.getIndexCount() == 1) && (list.getIndexData()[0] == 7);
+
+    list.reset();
+    bool resetOk = !list.isMapped() && !list.hasMappedOverflow() && list.isEmpty();
+
+    bool passed = writesInPlace && spilled && resetOk;
+    printTestResult("Mapped Storage", passed);
+}
+
+// ============================================================================
+// Test 10: Sampler key is part of batch compatibility
+// ============================================================================
+
+void testSamplerKeyBoundary() {
+    DrawList list;
+    int dummyTexture = 0;
+
+    for (int i = 0; i < 3; ++i) {
+        uint32_t offset = list.addVertex2D(Vertex2D(float(i), 0, 0, 0, 1, 1, 1, 1));
+        DrawCommand2D cmd;
+        cmd.vertexOffset = offset;
+        cmd.vertexCount = 1;
+        cmd.primitiveType = PrimitiveType::Point;
+        cmd.texture = &dummyTexture;
+        if (i == 2) {
+            cmd.samplerKey = makeSamplerKey(TextureFilter::Nearest, TextureFilter::Nearest,
+                                            TextureMipFilter::None,
+                                            TextureWrap::Repeat, TextureWrap::Repeat);
+        }
+        list.addCommand(cmd);
+    }
+
+    list.optimize();
+
+    // First two share the default sampler and merge; the third must stay separate
+    bool passed = (list.getCommandCount() == 2) &&
+                  (list.getCommands()[0].as<DrawCommand2D>().vertexCount == 2) &&
+                  (list.getCommands()[1].as<DrawCommand2D>().samplerKey != kDefaultSamplerKey);
+    printTestResult("Sampler Key Boundary", passed);
+}
+
+// ============================================================================
+// Test 11: State-sorted reordering with barriers
+// ============================================================================
+
+void testReorderForState() {
+    DrawList list;
+    int textureA = 0;
+    int textureB = 0;
+    void* a = &textureA < &textureB ? (void*)&textureA : (void*)&textureB;
+    void* b = &textureA < &textureB ? (void*)&textureB : (void*)&textureA;
+
+    auto opaque = [](void* texture) {
+        DrawCommand3D cmd;
+        cmd.vertexCount = 3;
+        cmd.blendMode = BlendMode::Disabled;
+        cmd.depthTestEnabled = true;
+        cmd.depthWriteEnabled = true;
+        cmd.texture = texture;
+        return cmd;
+    };
+
+    // Segment 1: B, A, B -> A, B, B
+    list.addCommand(opaque(b));     // 0
+    list.addCommand(opaque(a));     // 1
+    list.addCommand(opaque(b));     // 2
+
+    // Blended draw is a barrier
+    DrawCommand3D blended = opaque(a);
+    blended.blendMode = BlendMode::Alpha;
+    list.addCommand(blended);       // 3
+
+    // Ordered region keeps submission order
+    list.beginOrderedRegion();
+    list.addCommand(opaque(b));     // 4
+    list.addCommand(opaque(a));     // 5
+    list.endOrderedRegion();
+
+    size_t moved = list.reorderForState();
+    const auto& commands = list.getCommands();
+
+    bool segmentSorted = commands[0].as<DrawCommand3D>().texture == a &&
+                         commands[1].as<DrawCommand3D>().texture == b &&
+                         commands[2].as<DrawCommand3D>().texture == b;
+    bool barrierKept = commands[3].as<DrawCommand3D>().blendMode == BlendMode::Alpha;
+    bool regionKept = commands[4].as<DrawCommand3D>().texture == b &&
+                      commands[5].as<DrawCommand3D>().texture == a;
+
+    // Front-to-back: same state, nearer (larger view-space z) first
+    DrawList depthList;
+    DrawCommand3D far = opaque(a);
+    far.modelViewMatrix.columns[3].z = -10.0f;
+    DrawCommand3D nearCmd = opaque(a);
+    nearCmd.modelViewMatrix.columns[3].z = -1.0f;
+    depthList.addCommand(far);
+    depthList.addCommand(nearCmd);
+    DrawList::ReorderOptions options;
+    options.frontToBack = true;
+    depthList.reorderForState(options);
+    bool depthSorted = depthList.getCommands()[0].as<DrawCommand3D>().modelViewMatrix.columns[3].z == -1.0f;
+
+    bool passed = (moved == 2) && segmentSorted && barrierKept && regionKept && depthSorted;
+    printTestResult("Reorder For State", passed);
+}
+
+// ============================================================================
+// Test 12: Transform baking merges differently translated shapes
+// ============================================================================
+
+void testTransformBaking() {
+    auto record = [](DrawList& list) {
+        for (int i = 0; i < 3; ++i) {
+            uint32_t offset = list.addVertex2D(Vertex2D(1, 1, 0, 0, 1, 1, 1, 1));
+            DrawCommand2D cmd;
+            cmd.vertexOffset = offset;
+            cmd.vertexCount = 1;
+            cmd.primitiveType = PrimitiveType::Point;
+            cmd.transform = makeTransform2D(float(i * 10), 0);
+            list.addCommand(cmd);
+        }
+        // Strip draws never merge
+        for (int i = 0; i < 2; ++i) {
+            uint32_t offset = list.addVertex2D(Vertex2D(0, 0, 0, 0, 1, 1, 1, 1));
+            list.addVertex2D(Vertex2D(1, 0, 0, 0, 1, 1, 1, 1));
+            DrawCommand2D cmd;
+            cmd.vertexOffset = offset;
+            cmd.vertexCount = 2;
+            cmd.primitiveType = PrimitiveType::LineStrip;
+            list.addCommand(cmd);
+        }
+    };
+
+    DrawList plain;
+    record(plain);
+    plain.optimize();
+
+    DrawList baked;
+    baked.setTransformBaking(true);
+    record(baked);
+    baked.optimize();
+
+    const DrawCommand2D& merged = baked.getCommands()[0].as<DrawCommand2D>();
+    const Vertex2D* vertices = baked.getVertex2DData();
+    bool passed = (plain.getCommandCount() == 5) &&
+                  (baked.getCommandCount() == 3) &&
+                  (merged.vertexCount == 3) &&
+                  (baked.getBakedCommandCount() == 2) &&  // first shape is already identity
+                  (vertices[0].position.x == 1.0f) &&
+                  (vertices[2].position.x == 21.0f) &&
+                  (merged.transform.columns[3].x == 0.0f);
+    printTestResult("Transform Baking", passed);
+}
+
+// ============================================================================
+// Test 13: Instanced draws merge contiguous instance ranges
+// ============================================================================
+
+void testInstancedBatching() {
+    DrawList list;
+    int bufferA = 0;
+    int bufferB = 0;
+
+    auto instanced = [](void* buffer, uint32_t first, uint32_t count) {
+        DrawCommand3DInstanced cmd;
+        cmd.vertexOffset = 0;
+        cmd.vertexCount = 36;
+        cmd.instanceBuffer = buffer;
+        cmd.instanceOffset = first;
+        cmd.instanceCount = count;
+        return cmd;
+    };
+
+    list.addCommand(instanced(&bufferA, 0, 100));
+    list.addCommand(instanced(&bufferA, 100, 50));   // Contiguous: merges
+    list.addCommand(instanced(&bufferA, 200, 10));   // Gap: new draw
+    list.addCommand(instanced(&bufferB, 210, 10));   // Other buffer: new draw
+    list.addCommand(instanced(&bufferB, 0, 0));      // Empty: dropped
+
+    DrawCommand3D plain;
+    plain.vertexCount = 36;
+    list.addCommand(plain);                          // Never merges with instanced
+
+    bool recorded = list.getCommandCount() == 5 &&
+                    list.getCommands()[0].type == CommandType::Draw3DInstanced;
+
+    list.optimize();
+    const auto& commands = list.getCommands();
+
+    bool merged = list.getCommandCount() == 4 &&
+                  commands[0].as<DrawCommand3DInstanced>().instanceCount == 150 &&
+                  commands[1].as<DrawCommand3DInstanced>().instanceOffset == 200 &&
+                  commands[2].as<DrawCommand3DInstanced>().instanceBuffer == &bufferB &&
+                  commands[3].type == CommandType::Draw3D;
+
+    // Linear iteration steps over the larger records correctly
+    size_t walked = 0;
+    for (CommandRef ref : commands) {
+        (void)ref;
+        walked++;
+    }
+
+    bool passed = recorded && merged && walked == 4;
+    printTestResult("Instanced Batching", passed);
+}
+
+// ============================================================================
+// Test 14: Indirect draws and compute dispatches act as ordering barriers
+// ============================================================================
+
+void testIndirectAndCompute() {
+    DrawList list;
+    int pipeline = 0;
+    int instances = 0;
+    int visible = 0;
+    int args = 0;
+
+    DrawCommand3D plain;
+    plain.vertexCount = 36;
+    plain.indexCount = 36;
+
+    DispatchComputeCommand cull;
+    cull.pipelineState = &pipeline;
+    cull.buffers[0] = &instances;
+    cull.buffers[1] = &visible;
+    cull.buffers[2] = &args;
+    cull.bufferCount = 3;
+    cull.threadCount = 1000;
+    cull.constantsSize = 16;
+
+    DrawCommand3DIndirect indirect;
+    indirect.vertexCount = 36;
+    indirect.indexCount = 36;
+    indirect.argumentBuffer = &args;
+    indirect.instanceBuffer = &visible;
+
+    DispatchComputeCommand empty = cull;
+    empty.threadCount = 0;                     // Dropped
+    DrawCommand3DIndirect noArgs = indirect;
+    noArgs.argumentBuffer = nullptr;           // Dropped
+
+    list.addCommand(plain);
+    list.addCommand(cull);
+    list.addCommand(indirect);
+    list.addCommand(indirect);                 // GPU counts: never merged
+    list.addCommand(plain);
+    list.addCommand(empty);
+    list.addCommand(noArgs);
+
+    bool recorded = list.getCommandCount() == 5;
+
+    list.optimize();
+    const auto& commands = list.getCommands();
+
+    // The two plain draws must not merge across the dispatch
+    bool ordered = list.getCommandCount() == 5 &&
+                   commands[0].type == CommandType::Draw3D &&
+                   commands[1].type == CommandType::DispatchCompute &&
+                   commands[2].type == CommandType::Draw3DIndirect &&
+                   commands[3].type == CommandType::Draw3DIndirect &&
+                   commands[4].type == CommandType::Draw3D;
+
+    bool payload = ordered &&
+                   commands[1].as<DispatchComputeCommand>().bufferCount == 3 &&
+                   commands[1].as<DispatchComputeCommand>().buffers[2] == &args &&
+                   commands[2].as<DrawCommand3DIndirect>().argumentBuffer == &args;
+
+    bool passed = recorded && ordered && payload;
+    printTestResult("Indirect And Compute Commands", passed);
+}
+
+// ============================================================================
+// Test 15: Pass coalescing drops empty passes and folds clears
+// ============================================================================
+
+void testPassCoalescing() {
+    DrawList list;
+    int fboA = 0;
+    int fboB = 0;
+
+    DrawCommand2D draw;
+    draw.vertexCount = 3;
+    draw.primitiveType = PrimitiveType::Triangle;
+    draw.transform = matrix_identity_float4x4;
+
+    SetClearCommand background;
+    background.clearData.color = simd_make_float4(1, 0, 0, 1);
+    SetClearCommand clearDepth;
+    clearDepth.clearData.clearColor = false;
+    clearDepth.clearData.clearDepth = true;
+    clearDepth.clearData.depth = 0.5f;
+
+    SetViewportCommand vp;
+    vp.viewport = Rect(0, 0, 256, 256);
+
+    list.addCommand(SetRenderTargetCommand(&fboA));
+    list.addCommand(background);
+    list.addCommand(vp);                       // State only: clears still fold
+    list.addCommand(clearDepth);
+    list.addCommand(draw);
+    list.addCommand(SetRenderTargetCommand(nullptr));   // Empty screen pass
+    list.addCommand(SetRenderTargetCommand(&fboA));     // Same target again
+    draw.vertexOffset = 3;                              // Contiguous with the first draw
+    list.addCommand(draw);
+    list.addCommand(SetRenderTargetCommand(&fboB));     // Empty but last: kept
+
+    list.optimize();
+    const auto& commands = list.getCommands();
+
+    bool structure = list.getCommandCount() == 5 &&
+                     commands[0].type == CommandType::SetRenderTarget &&
+                     commands[1].type == CommandType::Clear &&
+                     commands[2].type == CommandType::SetViewport &&
+                     commands[3].type == CommandType::Draw2D &&
+                     commands[4].type == CommandType::SetRenderTarget &&
+                     commands[4].as<SetRenderTargetCommand>().renderTarget == &fboB;
+
+    bool merged = false;
+    if (structure) {
+        const ClearCommand& clear = commands[1].as<SetClearCommand>().clearData;
+        merged = clear.clearColor && clear.color.x == 1.0f &&
+                 clear.clearDepth && clear.depth == 0.5f;
+    }
+
+    // Both draws end up in one pass and batch together
+    bool batched = structure && commands[3].as<DrawCommand2D>().vertexCount == 6;
+
+    bool passed = structure && merged && batched && list.getCoalescedCommandCount() == 3;
+    printTestResult("Pass Coalescing", passed);
+}
+
+// ============================================================================
+// Test 16: Texture batching merges draws across textures
+// ============================================================================
+
+void testTextureBatching() {
+    int texA = 0;
+    int texB = 0;
+    int texC = 0;
+    void* textures[4] = {&texA, &texB, &texA, &texC};
+
+    auto record = [&](DrawList& list) {
+        for (uint32_t i = 0; i < 4; i++) {
+            DrawCommand2D cmd;
+            cmd.vertexOffset = i * 6;
+            cmd.vertexCount = 6;
+            cmd.primitiveType = PrimitiveType::Triangle;
+            cmd.texture = textures[i];
+            cmd.transform = matrix_identity_float4x4;
+            list.addCommand(cmd);
+        }
+    };
+
+    DrawList plain;
+    record(plain);
+    plain.optimize();
+    bool separate = plain.getCommandCount() == 4 &&
+                    plain.getCommands()[0].as<DrawCommand2D>().textureBatch == kInvalidTextureBatch;
+
+    DrawList batched;
+    batched.setTextureBatching(true);
+    record(batched);
+    batched.optimize();
+
+    bool merged = false;
+    if (batched.getCommandCount() == 1) {
+        const DrawCommand2D& cmd = batched.getCommands()[0].as<DrawCommand2D>();
+        const TextureBatch2D* batch = batched.getTextureBatch(cmd.textureBatch);
+        merged = cmd.vertexCount == 24 && batch &&
+                 batch->textureCount == 3 && batch->rangeCount == 4 &&
+                 batch->vertexEnd[0] == 6 && batch->vertexEnd[3] == 24 &&
+                 batch->slot[0] == 0 && batch->slot[1] == 1 &&
+                 batch->slot[2] == 0 && batch->slot[3] == 2 &&
+                 batch->textures[2] == &texC;
+    }
+
+    // The setting survives reset(); the batches do not
+    batched.reset();
+    bool cleared = batched.isTextureBatchingEnabled() && !batched.getTextureBatch(0);
+
+    bool passed = separate && merged && cleared;
+    printTestResult("Texture Batching", passed);
+}
+
+// ============================================================================
+// Test 17: Skyline atlas packing keeps rects disjoint and in bounds
+// ============================================================================
+
+void testAtlasPacking() {
+    SkylinePacker packer(64, 64);
+
+    // Mixed sizes whose areas sum to exactly one 64x64 page
+    const uint32_t sizes[][2] = {
+        {32, 16}, {32, 16}, {16, 32}, {16, 32}, {32, 32},
+        {16, 16}, {16, 16}, {16, 16}, {16, 16}
+    };
+    std::vector<AtlasRect> rects;
+    bool allFit = true;
+    for (const auto& size : sizes) {
+        AtlasRect rect;
+        allFit = allFit && packer.insert(size[0], size[1], rect);
+        rects.push_back(rect);
+    }
+
+    bool inBounds = true;
+    bool disjoint = true;
+    for (size_t i = 0; i < rects.size(); i++) {
+        const AtlasRect& a = rects[i];
+        inBounds = inBounds && a.x + a.width <= 64 && a.y + a.height <= 64;
+        for (size_t j = i + 1; j < rects.size(); j++) {
+            const AtlasRect& b = rects[j];
+            bool overlap = a.x < b.x + b.width && b.x < a.x + a.width &&
+                           a.y < b.y + b.height && b.y < a.y + a.height;
+            disjoint = disjoint && !overlap;
+        }
+    }
+
+    // The skyline fills the page exactly, so nothing more fits
+    AtlasRect extra;
+    bool full = packer.getOccupancy() == 1.0f && !packer.insert(1, 1, extra);
+
+    // Oversized rects are rejected outright; reset empties the page
+    packer.reset(64, 64);
+    bool oversized = !packer.insert(65, 8, extra) && packer.insert(64, 64, extra) &&
+                     extra.x == 0 && extra.y == 0;
+
+    bool passed = allFit && inBounds && disjoint && full && oversized;
+    printTestResult("Atlas Packing", passed);
+}
+
+// ============================================================================
+// Test 18: DrawList instance stream feeds merged instanced draws
+// ============================================================================
+
+void testInstanceStream() {
+    DrawList list;
+
+    // Shared unit geometry recorded once, one instance per call
+    uint32_t geometryIndex = list.addIndices(std::vector<uint32_t>(36, 0).data(), 36);
+
+    auto unitDraw = [&](float x) {
+        InstanceData instance;
+        instance.modelMatrix = matrix_identity_float4x4;
+        instance.modelMatrix.columns[3] = simd_make_float4(x, 0, 0, 1);
+        instance.color = simd_make_float4(1, 1, 1, 1);
+        instance.userData = simd_make_float4(0, 0, 0, 0);
+
+        DrawCommand3DInstanced cmd;
+        cmd.vertexCount = 24;
+        cmd.indexOffset = geometryIndex;
+        cmd.indexCount = 36;
+        cmd.instanceBuffer = nullptr;
+        cmd.instanceOffset = list.addInstances(&instance, 1);
+        cmd.instanceCount = 1;
+        return cmd;
+    };
+
+    for (int i = 0; i < 3; i++) {
+        list.addCommand(unitDraw(static_cast<float>(i)));
+    }
+
+    bool stored = list.getInstanceCount() == 3 &&
+                  list.getInstanceDataSize() == 3 * sizeof(InstanceData) &&
+                  list.getInstanceData()[2].modelMatrix.columns[3].x == 2.0f;
+
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool merged = list.getCommandCount() == 1 &&
+                  commands[0].as<DrawCommand3DInstanced>().instanceOffset == 0 &&
+                  commands[0].as<DrawCommand3DInstanced>().instanceCount == 3;
+
+    // Reset empties the stream and offsets restart at zero
+    list.reset();
+    InstanceData instance;
+    bool cleared = list.getInstanceCount() == 0 && list.getInstanceData() == nullptr &&
+                   list.addInstances(&instance, 1) == 0;
+
+    bool passed = stored && merged && cleared;
+    printTestResult("Instance Stream", passed);
+}
+
+// ============================================================================
+// Test 19: SDF shape ranges merge into one instanced quad draw
+// ============================================================================
+
+void testShapeBatching() {
+    DrawList list;
+
+    auto circle = [&](float x, BlendMode blend) {
+        ShapeInstance2D shape = {};
+        shape.center = simd_make_float2(x, 0);
+        shape.axis = simd_make_float2(1, 0);
+        shape.halfSize = simd_make_float2(10, 10);
+        shape.kind = ShapeKind2D::Ellipse;
+
+        DrawCommand2DShapes cmd;
+        cmd.shapeOffset = list.addShapes(&shape, 1);
+        cmd.shapeCount = 1;
+        cmd.blendMode = blend;
+        return cmd;
+    };
+
+    for (int i = 0; i < 4; i++) {
+        list.addCommand(circle(static_cast<float>(i), BlendMode::Alpha));
+    }
+    list.addCommand(circle(4, BlendMode::Add));      // Blend change: new draw
+
+    DrawCommand2DShapes empty;
+    list.addCommand(empty);                          // No shapes: dropped
+
+    bool stored = list.getCommandCount() == 5 && list.getShapeCount() == 5 &&
+                  list.getShapeDataSize() == 5 * sizeof(ShapeInstance2D) &&
+                  list.getShapeData()[3].center.x == 3.0f;
+
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool merged = list.getCommandCount() == 2 &&
+                  commands[0].as<DrawCommand2DShapes>().shapeCount == 4 &&
+                  commands[1].as<DrawCommand2DShapes>().shapeOffset == 4;
+
+    list.reset();
+    bool cleared = list.getShapeCount() == 0 && list.getShapeData() == nullptr;
+
+    bool passed = sizeof(ShapeInstance2D) == 64 && stored && merged && cleared;
+    printTestResult("Shape Batching", passed);
+}
+
+// ============================================================================
+// Test 20: Stroke segments from consecutive polylines merge into one draw
+// ============================================================================
+
+void testStrokeBatching() {
+    DrawList list;
+
+    auto polyline = [&](float y, uint32_t segments, BlendMode blend) {
+        std::vector<StrokeSegment2D> records(segments);
+        for (uint32_t i = 0; i < segments; i++) {
+            records[i].p0 = simd_make_float2(static_cast<float>(i), y);
+            records[i].p1 = simd_make_float2(static_cast<float>(i + 1), y);
+            records[i].halfWidth = 2.0f;
+            records[i].join = StrokeJoin2D::Round;
+        }
+
+        DrawCommand2DStroke cmd;
+        cmd.segmentOffset = list.addStrokeSegments(records.data(), records.size());
+        cmd.segmentCount = segments;
+        cmd.blendMode = blend;
+        return cmd;
+    };
+
+    list.addCommand(polyline(0, 3, BlendMode::Alpha));
+    list.addCommand(polyline(1, 2, BlendMode::Alpha));
+    list.addCommand(polyline(2, 4, BlendMode::Add));    // Blend change: new draw
+
+    DrawCommand2DStroke empty;
+    list.addCommand(empty);                             // No segments: dropped
+
+    bool stored = list.getCommandCount() == 3 && list.getStrokeSegmentCount() == 9 &&
+                  list.getStrokeSegmentDataSize() == 9 * sizeof(StrokeSegment2D) &&
+                  list.getStrokeSegmentData()[4].p0.y == 1.0f;
+
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool merged = list.getCommandCount() == 2 &&
+                  commands[0].as<DrawCommand2DStroke>().segmentCount == 5 &&
+                  commands[1].as<DrawCommand2DStroke>().segmentOffset == 5;
+
+    list.reset();
+    bool cleared = list.getStrokeSegmentCount() == 0 && list.getStrokeSegmentData() == nullptr;
+
+    bool passed = sizeof(StrokeSegment2D) == 64 && stored && merged && cleared;
+    printTestResult("Stroke Batching", passed);
+}
+
+// ============================================================================
+// Test 21: Bulk allocation writes in place, including into mapped storage
+// ============================================================================
+
+void testBulkAllocation() {
+    DrawList list;
+    list.addVertex2D(Vertex2D(0, 0, 0, 0, 1, 1, 1, 1));
+
+    uint32_t vtxOffset = 0;
+    Vertex2D* v = list.allocateVertices2D(3, vtxOffset);
+    for (int i = 0; i < 3; i++) {
+        v[i] = Vertex2D(float(i + 1), 0, 0, 0, 1, 1, 1, 1);
+    }
+    uint32_t idxOffset = 0;
+    uint32_t* idx = list.allocateIndices(2, idxOffset);
+    idx[0] = 5;
+    idx[1] = 6;
+
+    uint32_t unused = 99;
+    bool owned = vtxOffset == 1 && idxOffset == 0 && list.getVertex2DCount() == 4 &&
+                 list.getVertex2DData()[3].position.x == 3.0f && list.getIndexData()[1] == 6 &&
+                 list.allocateVertices2D(0, unused) == nullptr && unused == 4;
+
+    uint32_t shapeOffset = 0, strokeOffset = 0;
+    list.allocateShapes(2, shapeOffset)[1].halfSize = simd_make_float2(3, 3);
+    list.allocateStrokeSegments(1, strokeOffset)[0].halfWidth = 2.0f;
+    bool streams = list.getShapeCount() == 2 && list.getShapeData()[1].halfSize.x == 3.0f &&
+                   list.getStrokeSegmentCount() == 1 && list.getStrokeSegmentData()[0].halfWidth == 2.0f;
+
+    // Mapped: ranges land in the mapping, overflow spills what was written
+    list.reset();
+    Vertex2D mapped2D[4];
+    Vertex3D mapped3D[1];
+    uint32_t mappedIndices[4];
+    DrawList::MappedStorage storage;
+    storage.vertices2D = mapped2D;
+    storage.capacity2D = 4;
+    storage.vertices3D = mapped3D;
+    storage.capacity3D = 1;
+    storage.indices = mappedIndices;
+    storage.capacityIndices = 4;
+    list.bindMappedStorage(storage);
+
+    v = list.allocateVertices2D(2, vtxOffset);
+    v[1] = Vertex2D(7, 0, 0, 0, 1, 1, 1, 1);
+    bool inPlace = v == mapped2D && list.getVertex2DData()[1].position.x == 7.0f;
+
+    v = list.allocateVertices2D(4, vtxOffset);
+    v[3] = Vertex2D(9, 0, 0, 0, 1, 1, 1, 1);
+    bool spilled = !list.isMapped() && vtxOffset == 2 && list.getVertex2DCount() == 6 &&
+                   list.getVertex2DData()[1].position.x == 7.0f &&
+                   list.getVertex2DData()[5].position.x == 9.0f;
+
+    bool passed = owned && streams && inPlace && spilled;
+    printTestResult("Bulk Allocation", passed);
+}
+
+// ============================================================================
+// Test 22: Display list replays are recorded as one barrier command
+// ============================================================================
+
+void testDisplayListCommand() {
+    DrawList recorded;
+    DrawCommand2D draw;
+    draw.vertexCount = 3;
+    draw.primitiveType = PrimitiveType::Triangle;
+    draw.transform = matrix_identity_float4x4;
+    recorded.addCommand(draw);
+
+    DrawDisplayListCommand replay;
+    replay.displayList = &recorded;
+    replay.listId = 7;
+    replay.transform2D = makeTransform2D(10, 0);
+
+    // Unrecorded lists and self-replays are ignored
+    DrawDisplayListCommand unrecorded = replay;
+    unrecorded.listId = 0;
+    recorded.addCommand(replay);
+    bool rejected = recorded.getCommandCount() == 1;
+
+    // Draws around a replay must not merge across it
+    int fbo = 0;
+    DrawList list;
+    list.addCommand(unrecorded);
+    list.addCommand(SetRenderTargetCommand(&fbo));
+    list.addCommand(draw);
+    list.addCommand(replay);
+    list.addCommand(SetRenderTargetCommand(&fbo));      // Replay may have switched: kept
+    draw.vertexOffset = 3;
+    list.addCommand(draw);
+    list.optimize();
+    const auto& commands = list.getCommands();
+
+    bool structure = rejected && list.getCommandCount() == 5 &&
+                     commands[1].type == CommandType::Draw2D &&
+                     commands[2].type == CommandType::DrawDisplayList &&
+                     commands[3].type == CommandType::SetRenderTarget &&
+                     commands[4].type == CommandType::Draw2D;
+
+    bool payload = structure &&
+                   commands[2].as<DrawDisplayListCommand>().displayList == &recorded &&
+                   commands[2].as<DrawDisplayListCommand>().listId == 7 &&
+                   commands[2].as<DrawDisplayListCommand>().transform2D.columns[3].x == 10.0f;
+
+    // A pass whose only work is a replay is not empty
+    DrawList passes;
+    passes.addCommand(SetRenderTargetCommand(&fbo));
+    passes.addCommand(replay);
+    passes.addCommand(SetRenderTargetCommand(nullptr));
+    bool kept = passes.coalescePasses() == 0 && passes.getCommandCount() == 3;
+
+    bool passed = structure && payload && kept;
+    printTestResult("Display List Command", passed);
+}
+
+// ============================================================================
+// Test 23: Vertex compression moves eligible draws to the packed streams
+// ============================================================================
+
+void testVertexCompression() {
+    DrawList list;
+    list.setVertexCompression(true);
+
+    // Untextured 2D: texture coordinates are ignored, colors fit unorm8
+    Vertex2D solid[3] = {
+        Vertex2D(0, 0, 5, -3, 1, 0, 0, 1),
+        Vertex2D(1, 0, 5, -3, 0, 1, 0, 0.5f),
+        Vertex2D(0, 1, 5, -3, 0, 0, 1, 0)
+    };
+    DrawCommand2D draw;
+    draw.vertexOffset = list.addVertices2D(solid, 3);
+    draw.vertexCount = 3;
+    list.addCommand(draw);
+
+    // Textured 2D with repeating coordinates keeps full floats
+    int texture = 0;
+    DrawCommand2D repeated = draw;
+    repeated.texture = &texture;
+    Vertex2D tiled[3] = {solid[0], solid[1], solid[2]};
+    tiled[0].texCoord = simd_make_float2(0.0f, 0.0f);
+    tiled[1].texCoord = simd_make_float2(2.0f, 0.0f);
+    tiled[2].texCoord = simd_make_float2(0.0f, 1.0f);
+    tiled[0].color = simd_make_float4(1, 1, 1, 1);
+    tiled[1].color = simd_make_float4(1, 1, 1, 1);
+    tiled[2].color = simd_make_float4(1, 1, 1, 1);
+    repeated.vertexOffset = list.addVertices2D(tiled, 3);
+    list.addCommand(repeated);
+
+    // Custom shaders read Vertex2D
+    int pipeline = 0;
+    SetCustomShaderCommand shader;
+    shader.pipelineState = &pipeline;
+    list.addCommand(shader);
+    DrawCommand2D custom = draw;
+    custom.vertexOffset = list.addVertices2D(solid, 3);
+    list.addCommand(custom);
+    list.addCommand(SetCustomShaderCommand());
+
+    // Lit 3D: unit normals pack, two instanced draws share one range
+    Vertex3D cube[3] = {
+        Vertex3D(0, 0, 0, 0, 0, 1, 0.25f, 0.75f, 1, 1, 1, 1),
+        Vertex3D(1, 0, 0, 0, -1, 0, 0, 0, 1, 1, 1, 1),
+        Vertex3D(0, 1, 0, 1, 0, 0, 1, 1, 1, 1, 1, 1)
+    };
+    DrawCommand3DInstanced instanced;
+    instanced.vertexOffset = list.addVertices3D(cube, 3);
+    instanced.vertexCount = 3;
+    instanced.useLighting = true;
+    instanced.instanceCount = 4;
+    list.addCommand(instanced);
+    DrawCommand3D between;
+    between.vertexOffset = list.addVertices3D(cube, 3);
+    between.vertexCount = 3;
+    between.useLighting = true;
+    between.blendMode = BlendMode::Add;
+    list.addCommand(between);
+    instanced.instanceOffset = 4;
+    list.addCommand(instanced);
+
+    // Unnormalized normals of a lit draw keep full floats
+    Vertex3D scaled = cube[0];
+    scaled.normal = simd_make_float3(0.0f, 0.0f, 2.0f);
+    DrawCommand3D unnormalized;
+    unnormalized.vertexOffset = list.addVertex3D(scaled);
+    unnormalized.vertexCount = 1;
+    unnormalized.useLighting = true;
+    unnormalized.primitiveType = PrimitiveType::Point;
+    list.addCommand(unnormalized);
+
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool structure = list.getCommandCount() == 9 &&
+                     commands[0].type == CommandType::Draw2D &&
+                     commands[5].type == CommandType::Draw3DInstanced &&
+                     commands[8].type == CommandType::Draw3D;
+
+    bool formats = structure &&
+                   commands[0].as<DrawCommand2D>().vertexFormat == VertexFormat::Packed &&
+                   commands[1].as<DrawCommand2D>().vertexFormat == VertexFormat::Float &&
+                   commands[3].as<DrawCommand2D>().vertexFormat == VertexFormat::Float &&
+                   commands[5].as<DrawCommand3D>().vertexFormat == VertexFormat::Packed &&
+                   commands[6].as<DrawCommand3D>().vertexFormat == VertexFormat::Packed &&
+                   commands[7].as<DrawCommand3D>().vertexFormat == VertexFormat::Packed &&
+                   commands[8].as<DrawCommand3D>().vertexFormat == VertexFormat::Float &&
+                   list.getPackedCommandCount() == 4;
+
+    // Float streams are compacted; the shared instanced range is packed once
+    bool streams = formats &&
+                   list.getVertex2DCount() == 6 && list.getPackedVertex2DCount() == 3 &&
+                   list.getVertex3DCount() == 1 && list.getPackedVertex3DCount() == 6 &&
+                   commands[1].as<DrawCommand2D>().vertexOffset == 0 &&
+                   commands[3].as<DrawCommand2D>().vertexOffset == 3 &&
+                   commands[5].as<DrawCommand3D>().vertexOffset == 0 &&
+                   commands[6].as<DrawCommand3D>().vertexOffset == 3 &&
+                   commands[7].as<DrawCommand3D>().vertexOffset == 0 &&
+                   commands[8].as<DrawCommand3D>().vertexOffset == 0 &&
+                   list.getVertex2DData()[1].texCoord.x == 2.0f &&
+                   list.getVertex3DData()[0].normal.z == 2.0f;
+
+    // Encodings match the shaders' unpack_* functions
+    bool encoded = streams &&
+                   sizeof(PackedVertex2D) == 16 && sizeof(PackedVertex3D) == 28 &&
+                   list.getPackedVertex2DData()[0].position.x == 0.0f &&
+                   list.getPackedVertex2DData()[0].color == 0xFF0000FFu &&
+                   list.getPackedVertex2DData()[1].color == 0x8000FF00u &&
+                   list.getPackedVertex2DData()[0].texCoord == 0xFFFFu &&
+                   list.getPackedVertex3DData()[0].normalZ == 0x7FFFu &&
+                   list.getPackedVertex3DData()[0].texCoord == (0x4000u | (0xBFFFu << 16)) &&
+                   list.getPackedVertex3DData()[1].normalXY == 0x80010000u &&
+                   list.getPackedVertex3DData()[2].position[1] == 1.0f;
+
+    // Disabled (the default): nothing moves
+    DrawList plain;
+    draw.vertexOffset = plain.addVertices2D(solid, 3);
+    plain.addCommand(draw);
+    plain.optimize();
+    bool untouched = plain.getPackedVertex2DCount() == 0 && plain.getVertex2DCount() == 3 &&
+                     plain.getCommands()[0].as<DrawCommand2D>().vertexFormat == VertexFormat::Float;
+
+    bool passed = encoded && untouched;
+    printTestResult("Vertex Compression", passed);
+}
+
+// ============================================================================
+// Test 24: Resident geometry stays out of the DrawList streams
+// ============================================================================
+
+void testResidentGeometry() {
+    DrawList list;
+    list.setVertexCompression(true);
+
+    // Streamed draw ahead of the resident ones
+    Vertex3D triangle[3] = {
+        Vertex3D(0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1),
+        Vertex3D(1, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1),
+        Vertex3D(0, 1, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1)
+    };
+    DrawCommand3D streamed;
+    streamed.vertexOffset = list.addVertices3D(triangle, 3);
+    streamed.vertexCount = 3;
+    list.addCommand(streamed);
+
+    // Two tinted draws of one resident mesh become one two-instance draw
+    int vertexBuffer = 0, indexBuffer = 0, otherBuffer = 0;
+    InstanceData tint;
+    tint.modelMatrix = matrix_identity_float4x4;
+    tint.color = simd_make_float4(1, 0, 0, 1);
+    tint.userData = simd_make_float4(0, 0, 0, 0);
+    DrawCommand3DInstanced mesh;
+    mesh.vertexBuffer = &vertexBuffer;
+    mesh.vertexCount = 300;
+    mesh.indexBuffer = &indexBuffer;
+    mesh.indexType = IndexType::UInt16;
+    mesh.indexCount = 900;
+    mesh.instanceCount = 1;
+    mesh.instanceOffset = list.addInstances(&tint, 1);
+    list.addCommand(mesh);
+    mesh.instanceOffset = list.addInstances(&tint, 1);
+    list.addCommand(mesh);
+
+    // A different mesh at the next instance stays separate
+    DrawCommand3DInstanced other = mesh;
+    other.vertexBuffer = &otherBuffer;
+    other.instanceOffset = list.addInstances(&tint, 1);
+    list.addCommand(other);
+
+    // Adjacent ranges of a resident buffer aren't merged as stream ranges
+    DrawCommand3D first;
+    first.vertexBuffer = &vertexBuffer;
+    first.vertexCount = 3;
+    DrawCommand3D second = first;
+    second.vertexOffset = 3;
+    list.addCommand(first);
+    list.addCommand(second);
+
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool structure = list.getCommandCount() == 5 &&
+                     commands[1].type == CommandType::Draw3DInstanced &&
+                     commands[1].as<DrawCommand3DInstanced>().instanceCount == 2 &&
+                     commands[2].as<DrawCommand3DInstanced>().vertexBuffer == &otherBuffer;
+
+    // Only the streamed draw is packed; resident ranges are left as recorded
+    bool untouched = structure &&
+                     commands[0].as<DrawCommand3D>().vertexFormat == VertexFormat::Packed &&
+                     commands[1].as<DrawCommand3D>().vertexFormat == VertexFormat::Float &&
+                     commands[4].as<DrawCommand3D>().vertexFormat == VertexFormat::Float &&
+                     commands[4].as<DrawCommand3D>().vertexOffset == 3 &&
+                     list.getPackedVertex3DCount() == 3 && list.getVertex3DCount() == 0 &&
+                     list.getIndexCount() == 0;
+
+    printTestResult("Resident Geometry", untouched);
+}
+
+// ============================================================================
+// Test 25: Culled draws are counted per list until reset
+// ============================================================================
+
+void testCulledDrawCount() {
+    DrawList list;
+    list.addCulledDraw();
+    list.addCulledDraw();
+
+    // Culled draws record nothing, but still count after optimize()
+    list.optimize();
+    bool counted = list.getCulledDrawCount() == 2 && list.getCommandCount() == 0;
+
+    list.reset();
+    bool cleared = list.getCulledDrawCount() == 0;
+
+    printTestResult("Culled Draw Count", counted && cleared);
+}
+
+// ============================================================================
+// Test 26: Shadow map renders and shadow blocks
+// ============================================================================
+
+void testShadowMapCommand() {
+    DrawList casters;
+    DrawCommand3D draw;
+    draw.vertexCount = 3;
+    casters.addCommand(draw);
+
+    int map = 0;
+    RenderShadowMapCommand render;
+    render.casters = &casters;
+    render.listId = 9;
+    render.replacesListId = 8;
+    render.shadowMap = &map;
+    render.slice = 2;
+
+    // Renders without casters, a recording or a map are ignored
+    DrawList list;
+    RenderShadowMapCommand invalid = render;
+    invalid.shadowMap = nullptr;
+    list.addCommand(invalid);
+    invalid = render;
+    invalid.listId = 0;
+    list.addCommand(invalid);
+    casters.addCommand(render);
+    bool rejected = list.getCommandCount() == 0 && casters.getCommandCount() == 1;
+
+    // Draws around a shadow map render don't merge across it, and a pass
+    // whose only work is one is kept
+    int fbo = 0;
+    list.addCommand(SetRenderTargetCommand(&fbo));
+    list.addCommand(draw);
+    list.addCommand(render);
+    draw.vertexOffset = 3;
+    list.addCommand(draw);
+    list.addCommand(SetRenderTargetCommand(nullptr));
+    list.addCommand(render);
+    list.addCommand(SetRenderTargetCommand(&fbo));
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool structure = list.getCommandCount() == 7 &&
+                     commands[1].type == CommandType::Draw3D &&
+                     commands[2].type == CommandType::RenderShadowMap &&
+                     commands[3].type == CommandType::Draw3D &&
+                     commands[5].type == CommandType::RenderShadowMap;
+    bool payload = structure &&
+                   commands[2].as<RenderShadowMapCommand>().casters == &casters &&
+                   commands[2].as<RenderShadowMapCommand>().replacesListId == 8 &&
+                   commands[2].as<RenderShadowMapCommand>().slice == 2;
+
+    // Shadow blocks are a side table referenced from lighting states
+    ShadowState shadows;
+    shadows.shadowMaps[0] = &map;
+    shadows.uniforms.count = 1;
+    shadows.uniforms.lights[0].cascadeCount = 3;
+    LightingState lighting;
+    bool unshadowed = lighting.shadowHandle == kInvalidShadowHandle &&
+                      list.getShadowState(0) == nullptr;
+    lighting.shadowHandle = list.addShadowState(shadows);
+    const ShadowState* stored = list.getShadowState(lighting.shadowHandle);
+    bool table = unshadowed && lighting.shadowHandle == 0 && stored &&
+                 stored->shadowMaps[0] == &map && stored->shadowMaps[1] == nullptr &&
+                 stored->uniforms.lights[0].cascadeCount == 3 &&
+                 stored->uniforms.lights[1].cascadeCount == 0;
+    list.reset();
+    bool cleared = list.getShadowStates().empty();
+
+    printTestResult("Shadow Map Command", rejected && structure && payload && table && cleared);
+}
+
+// ============================================================================
+// Test 27: Texture readbacks
+// ============================================================================
+
+static void testReadbackCompletion(uint64_t, bool) {}
+
+void testReadbackCommand() {
+    int texture = 0, buffer = 0;
+    ReadbackTextureCommand readback;
+    readback.texture = &texture;
+    readback.buffer = &buffer;
+    readback.bytesPerRow = 64 * 4;
+    readback.width = 64;
+    readback.height = 32;
+    readback.completion = &testReadbackCompletion;
+    readback.readbackId = 7;
+
+    // Readbacks without a texture, buffer, callback or region are ignored
+    DrawList list;
+    ReadbackTextureCommand invalid = readback;
+    invalid.buffer = nullptr;
+    list.addCommand(invalid);
+    invalid = readback;
+    invalid.completion = nullptr;
+    list.addCommand(invalid);
+    invalid = readback;
+    invalid.height = 0;
+    list.addCommand(invalid);
+    bool rejected = list.getCommandCount() == 0;
+
+    // Draws on either side of a readback stay apart, so the copy sees
+    // exactly what was drawn before it
+    DrawCommand2D draw;
+    draw.vertexCount = 6;
+    draw.texture = &texture;
+    list.addCommand(draw);
+    list.addCommand(readback);
+    draw.vertexOffset = 6;
+    list.addCommand(draw);
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool structure = list.getCommandCount() == 3 &&
+                     commands[0].type == CommandType::Draw2D &&
+                     commands[1].type == CommandType::ReadbackTexture &&
+                     commands[2].type == CommandType::Draw2D;
+    bool payload = structure &&
+                   commands[1].as<ReadbackTextureCommand>().readbackId == 7 &&
+                   commands[1].as<ReadbackTextureCommand>().height == 32;
+
+    printTestResult("Readback Command", rejected && structure && payload);
+}
+
+// ============================================================================
+// Test 28: GPU texture filters
+// ============================================================================
+
+void testFilterTextureCommand() {
+    int source = 0, destination = 0;
+    FilterTextureCommand filter;
+    filter.source = &source;
+    filter.destination = &destination;
+    filter.filter = ImageFilterType::Convolve;
+    filter.kernelWidth = 5;
+    filter.kernelHeight = 3;
+    filter.weights[14] = 0.5f;
+
+    // In-place filters, even or oversized kernels and a zero sigma are ignored
+    DrawList list;
+    FilterTextureCommand invalid = filter;
+    invalid.destination = &source;
+    list.addCommand(invalid);
+    invalid = filter;
+    invalid.kernelWidth = 4;
+    list.addCommand(invalid);
+    invalid = filter;
+    invalid.kernelHeight = FilterTextureCommand::kMaxKernelSize + 2;
+    list.addCommand(invalid);
+    invalid = filter;
+    invalid.filter = ImageFilterType::Median;
+    invalid.kernelWidth = 1;
+    list.addCommand(invalid);
+    invalid = filter;
+    invalid.filter = ImageFilterType::GaussianBlur;
+    invalid.sigma = 0.0f;
+    list.addCommand(invalid);
+    invalid = filter;
+    invalid.filter = ImageFilterType::Point;
+    list.addCommand(invalid);
+    invalid.pointStageCount = FilterTextureCommand::kMaxPointStages + 1;
+    list.addCommand(invalid);
+    bool rejected = list.getCommandCount() == 0;
+
+    // A filter separates the draws around it: the first reads its
+    // destination as a texture before the filter writes it
+    DrawCommand2D draw;
+    draw.vertexCount = 6;
+    draw.texture = &destination;
+    list.addCommand(draw);
+    list.addCommand(filter);
+    draw.vertexOffset = 6;
+    list.addCommand(draw);
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool structure = list.getCommandCount() == 3 &&
+                     commands[0].type == CommandType::Draw2D &&
+                     commands[1].type == CommandType::FilterTexture &&
+                     commands[2].type == CommandType::Draw2D;
+    bool payload = structure &&
+                   commands[1].as<FilterTextureCommand>().kernelWidth == 5 &&
+                   commands[1].as<FilterTextureCommand>().weights[14] == 0.5f;
+
+    // Fused per-pixel stages travel with the command
+    list.reset();
+    FilterTextureCommand point = filter;
+    point.filter = ImageFilterType::Point;
+    point.pointStageCount = 2;
+    point.pointStages[1].op = ImagePointOp::Gamma;
+    point.pointStages[1].a = 0.5f;
+    list.addCommand(point);
+    bool stages = list.getCommandCount() == 1 &&
+                  list.getCommands()[0].as<FilterTextureCommand>().pointStageCount == 2 &&
+                  list.getCommands()[0].as<FilterTextureCommand>().pointStages[1].op == ImagePointOp::Gamma;
+
+    printTestResult("Filter Texture Command", rejected && structure && payload && stages);
+}
+
+// Test 29: KTX2 round trip and BC block encoding
+void testTextureCompression() {
+    // Level sizes round partial blocks up
+    bool sizes = compressedLevelBytes(CompressedTextureFormat::BC1, 5, 4) == 16 &&
+                 compressedLevelBytes(CompressedTextureFormat::ASTC6x6, 13, 6) == 48 &&
+                 compressedLevelBytes(CompressedTextureFormat::BC3, 1, 1) == 16;
+
+    // A solid block encodes its exact 565 color with all indices 0
+    uint8_t rgba[8 * 4 * 4];
+    for (int i = 0; i < 8 * 4; ++i) {
+        rgba[i * 4 + 0] = 255;
+        rgba[i * 4 + 1] = 0;
+        rgba[i * 4 + 2] = 0;
+        rgba[i * 4 + 3] = (i % 8) < 4 ? 255 : 0;  // Left block opaque, right clear
+    }
+    uint8_t bc1[16] = {};
+    uint8_t bc3[32] = {};
+    bool encoded = encodeBCBlockRow(CompressedTextureFormat::BC1, rgba, 8, 4, 8 * 4, 0, bc1) &&
+                   encodeBCBlockRow(CompressedTextureFormat::BC3, rgba, 8, 4, 8 * 4, 0, bc3) &&
+                   !encodeBCBlockRow(CompressedTextureFormat::BC7, rgba, 8, 4, 8 * 4, 0, bc1);
+    bool solid = bc1[0] == 0x00 && bc1[1] == 0xF8 && bc1[4] == 0 && bc1[7] == 0;
+    bool alpha = bc3[0] == 255 && bc3[16] == 0 && bc3[8] == 0x00 && bc3[9] == 0xF8;
+
+    // Write and read back a two-level texture
+    CompressedTexture texture;
+    texture.width = 8;
+    texture.height = 4;
+    texture.format = CompressedTextureFormat::BC3;
+    texture.levels.push_back(std::vector<uint8_t>(bc3, bc3 + 32));
+    texture.levels.push_back(std::vector<uint8_t>(bc3, bc3 + 16));
+    std::vector<uint8_t> file = writeKTX2(texture);
+    CompressedTexture loaded;
+    bool roundTrip = !file.empty() && readKTX2(file.data(), file.size(), loaded) &&
+                     loaded.width == 8 && loaded.height == 4 &&
+                     loaded.format == CompressedTextureFormat::BC3 &&
+                     loaded.levels.size() == 2 && loaded.levels[0] == texture.levels[0] &&
+                     loaded.levels[1] == texture.levels[1];
+
+    // Mismatched levels and truncated files are rejected
+    texture.levels[1].pop_back();
+    bool rejected = writeKTX2(texture).empty() &&
+                    !readKTX2(file.data(), file.size() - 1, loaded) &&
+                    !readKTX2(file.data(), 40, loaded);
+
+    printTestResult("Texture Compression", sizes && encoded && solid && alpha && roundTrip && rejected);
+}
+
+// ============================================================================
+// Test 30: Mipmap generation
+// ============================================================================
+
+void testGenerateMipmapsCommand() {
+    // Commands without a texture are ignored
+    DrawList list;
+    list.addCommand(GenerateMipmapsCommand());
+    bool rejected = list.getCommandCount() == 0;
+
+    // Draws sampling the texture before and after the rebuild stay apart,
+    // so later draws see the new levels
+    int texture = 0;
+    DrawCommand2D draw;
+    draw.vertexCount = 6;
+    draw.texture = &texture;
+    draw.samplerKey = makeSamplerKey(TextureFilter::Linear, TextureFilter::Linear,
+                                     TextureMipFilter::Linear, TextureWrap::Clamp, TextureWrap::Clamp, 1);
+    list.addCommand(draw);
+    list.addCommand(GenerateMipmapsCommand(&texture));
+    draw.vertexOffset = 6;
+    list.addCommand(draw);
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool structure = list.getCommandCount() == 3 &&
+                     commands[0].type == CommandType::Draw2D &&
+                     commands[1].type == CommandType::GenerateMipmaps &&
+                     commands[2].type == CommandType::Draw2D;
+    bool payload = structure && commands[1].as<GenerateMipmapsCommand>().texture == &texture;
+
+    printTestResult("Generate Mipmaps Command", rejected && structure && payload);
+}
+
+// ============================================================================
+// Test 31: YCbCr video conversion
+// ============================================================================
+
+void testConvertYCbCrCommand() {
+    int luma = 0, chroma = 0, destination = 0;
+    ConvertYCbCrCommand convert;
+    convert.luma = &luma;
+    convert.chroma = &chroma;
+    convert.destination = &destination;
+    convert.matrix = YCbCrMatrix::BT601;
+    convert.fullRange = true;
+
+    // Conversions without three distinct textures are ignored
+    DrawList list;
+    ConvertYCbCrCommand invalid = convert;
+    invalid.chroma = nullptr;
+    list.addCommand(invalid);
+    invalid = convert;
+    invalid.destination = &luma;
+    list.addCommand(invalid);
+    bool rejected = list.getCommandCount() == 0;
+
+    // Draws of the converted frame come after the conversion
+    DrawCommand2D draw;
+    draw.vertexCount = 6;
+    draw.texture = &destination;
+    list.addCommand(draw);
+    list.addCommand(convert);
+    draw.vertexOffset = 6;
+    list.addCommand(draw);
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool structure = list.getCommandCount() == 3 &&
+                     commands[0].type == CommandType::Draw2D &&
+                     commands[1].type == CommandType::ConvertYCbCr &&
+                     commands[2].type == CommandType::Draw2D;
+    bool payload = structure &&
+                   commands[1].as<ConvertYCbCrCommand>().matrix == YCbCrMatrix::BT601 &&
+                   commands[1].as<ConvertYCbCrCommand>().fullRange &&
+                   commands[1].as<ConvertYCbCrCommand>().chroma == &chroma;
+
+    printTestResult("Convert YCbCr Command", rejected && structure && payload);
+}
+
+// ============================================================================
+// Test 32: Texture copies for frame capture
+// ============================================================================
+
+void captureCompleted(uint64_t, bool) {}
+
+void testCopyTextureCommand() {
+    int source = 0, destination = 0;
+
+    // Copies without a destination or onto their source are ignored
+    DrawList list;
+    CopyTextureCommand invalid;
+    invalid.source = &source;
+    list.addCommand(invalid);
+    invalid.destination = &source;
+    list.addCommand(invalid);
+    bool rejected = list.getCommandCount() == 0;
+
+    // A null source captures the screen; draws stay on either side
+    CopyTextureCommand copy;
+    copy.destination = &destination;
+    copy.opaque = true;
+    copy.completion = &captureCompleted;
+    copy.copyId = 7;
+    DrawCommand2D draw;
+    draw.vertexCount = 6;
+    list.addCommand(draw);
+    list.addCommand(copy);
+    draw.vertexOffset = 6;
+    list.addCommand(draw);
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool structure = list.getCommandCount() == 3 &&
+                     commands[0].type == CommandType::Draw2D &&
+                     commands[1].type == CommandType::CopyTexture &&
+                     commands[2].type == CommandType::Draw2D;
+    bool payload = structure &&
+                   commands[1].as<CopyTextureCommand>().source == nullptr &&
+                   commands[1].as<CopyTextureCommand>().opaque &&
+                   commands[1].as<CopyTextureCommand>().completion == &captureCompleted &&
+                   commands[1].as<CopyTextureCommand>().copyId == 7;
+
+    printTestResult("Copy Texture Command", rejected && structure && payload);
+}
+
+// ============================================================================
+// Test 33: Multisampled render target switches
+// ============================================================================
+
+void testMultisampleTargets() {
+    int fbo = 0;
+
+    DrawCommand2D draw;
+    draw.vertexCount = 6;
+    draw.primitiveType = PrimitiveType::Triangle;
+    draw.transform = matrix_identity_float4x4;
+
+    // The same texture at another sample count is another pass; at the same
+    // count the pass continues. The screen always takes the view's samples.
+    DrawList list;
+    list.addCommand(SetRenderTargetCommand(&fbo, 4));
+    list.addCommand(draw);
+    list.addCommand(SetRenderTargetCommand(&fbo, 1));
+    draw.vertexOffset = 6;
+    list.addCommand(draw);
+    list.addCommand(SetRenderTargetCommand(&fbo, 1));
+    draw.vertexOffset = 12;
+    list.addCommand(draw);
+    list.addCommand(SetRenderTargetCommand(nullptr, 4));
+    draw.vertexOffset = 18;
+    list.addCommand(draw);
+
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool structure = list.getCommandCount() == 6 &&
+                     commands[0].type == CommandType::SetRenderTarget &&
+                     commands[2].type == CommandType::SetRenderTarget &&
+                     commands[3].type == CommandType::Draw2D &&
+                     commands[4].type == CommandType::SetRenderTarget;
+    bool samples = structure &&
+                   commands[0].as<SetRenderTargetCommand>().sampleCount == 4 &&
+                   commands[2].as<SetRenderTargetCommand>().sampleCount == 1 &&
+                   commands[4].as<SetRenderTargetCommand>().renderTarget == nullptr &&
+                   commands[4].as<SetRenderTargetCommand>().sampleCount == 1;
+    bool continued = structure && commands[3].as<DrawCommand2D>().vertexCount == 12;
+
+    printTestResult("Multisample Targets", structure && samples && continued);
+}
+
+// ============================================================================
+// Test 34: Text from several drawString() calls
+// ============================================================================
+
+void testTextBatching() {
+    DrawList list;
+    int atlasPage = 0;
+
+    // Three strings on one atlas page, vertices already in world space (as
+    // drawString() writes them under 2D transforms); the last is a distance field
+    for (int i = 0; i < 3; ++i) {
+        std::vector<Vertex2D> quad(6, Vertex2D(float(i), 0, 0, 0, 1, 1, 1, 1));
+        DrawCommand2D cmd;
+        cmd.vertexOffset = list.addVertices2D(quad);
+        cmd.vertexCount = 6;
+        cmd.primitiveType = PrimitiveType::Triangle;
+        cmd.texture = &atlasPage;
+        cmd.distanceField = (i == 2);
+        list.addCommand(cmd);
+    }
+
+    list.optimize();
+
+    // The bitmap strings merge; coverage from a distance field needs its own draw
+    const auto& commands = list.getCommands();
+    bool passed = list.getCommandCount() == 2 &&
+                  commands[0].as<DrawCommand2D>().vertexCount == 12 &&
+                  !commands[0].as<DrawCommand2D>().distanceField &&
+                  commands[1].as<DrawCommand2D>().distanceField;
+    printTestResult("Text Batching", passed);
+}
+
+// ============================================================================
+// Test 35: Path fills from consecutive paths merge into one draw
+// ============================================================================
+
+void testPathBatching() {
+    DrawList list;
+
+    // A square per path: four edges, the last closing the contour
+    auto square = [&](float x, BlendMode blend) {
+        const simd_float2 corners[4] = {
+            simd_make_float2(x, 0), simd_make_float2(x + 1, 0),
+            simd_make_float2(x + 1, 1), simd_make_float2(x, 1)
+        };
+        uint32_t segmentOffset = 0;
+        PathSegment2D* edges = list.allocatePathSegments(4, segmentOffset);
+        for (int i = 0; i < 4; i++) {
+            edges[i].p0 = corners[i];
+            edges[i].p1 = corners[(i + 1) % 4];
+        }
+
+        PathInstance2D path = {};
+        path.boundsMin = corners[0];
+        path.boundsMax = corners[2];
+        path.segmentOffset = segmentOffset;
+        path.segmentCount = 4;
+
+        DrawCommand2DPaths cmd;
+        cmd.pathOffset = list.addPaths(&path, 1);
+        cmd.pathCount = 1;
+        cmd.blendMode = blend;
+        return cmd;
+    };
+
+    list.addCommand(square(0, BlendMode::Alpha));
+    list.addCommand(square(2, BlendMode::Alpha));
+    list.addCommand(square(4, BlendMode::Add));         // Blend change: new draw
+
+    DrawCommand2DPaths empty;
+    list.addCommand(empty);                             // No paths: dropped
+
+    bool stored = list.getCommandCount() == 3 && list.getPathCount() == 3 &&
+                  list.getPathSegmentCount() == 12 &&
+                  list.getPathData()[2].segmentOffset == 8 &&
+                  list.getPathSegmentData()[7].p1.x == 2.0f;
+
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool merged = list.getCommandCount() == 2 &&
+                  commands[0].as<DrawCommand2DPaths>().pathCount == 2 &&
+                  commands[1].as<DrawCommand2DPaths>().pathOffset == 2;
+
+    list.reset();
+    bool cleared = list.getPathCount() == 0 && list.getPathSegmentData() == nullptr;
+
+    bool passed = sizeof(PathInstance2D) == 48 && sizeof(PathSegment2D) == 16 &&
+                  stored && merged && cleared;
+    printTestResult("Path Batching", passed);
+}
+
+// ============================================================================
+// Test 36: Custom shader uniforms snapshotted per draw
+// ============================================================================
+
+void testUniformSnapshots() {
+    DrawList list;
+
+    // Two draws under one custom shader, the uniform changed in between
+    auto shader = [&](float value) {
+        SetCustomShaderCommand cmd;
+        cmd.pipelineState = reinterpret_cast<void*>(0x1);
+        cmd.uniformOffset = list.addUniformData(&value, sizeof(value));
+        cmd.uniformSize = sizeof(value);
+        list.addCommand(cmd);
+        return cmd.uniformOffset;
+    };
+    auto triangle = [&]() {
+        Vertex2D v;
+        DrawCommand2D cmd;
+        cmd.vertexOffset = list.addVertex2D(v);
+        list.addVertex2D(v);
+        list.addVertex2D(v);
+        cmd.vertexCount = 3;
+        cmd.transform = makeTransform2D(0, 0);
+        list.addCommand(cmd);
+    };
+
+    const uint32_t first = shader(1.0f);
+    triangle();
+    const uint32_t second = shader(2.0f);
+    triangle();
+
+    // Rewriting a snapshot leaves the other one alone
+    const float updated = 3.0f;
+    bool updatedInPlace = list.updateUniformData(second, 0, &updated, sizeof(updated)) &&
+                          !list.updateUniformData(second, 4, &updated, sizeof(updated));
+
+    const uint8_t* data = list.getUniformData();
+    float a = 0.0f, b = 0.0f;
+    std::memcpy(&a, data + first, sizeof(a));
+    std::memcpy(&b, data + second, sizeof(b));
+    bool stored = first == 0 && second == kUniformAlignment &&
+                  list.getUniformDataSize() == kUniformAlignment + sizeof(float) &&
+                  a == 1.0f && b == 3.0f;
+
+    // The draws must not merge across the second snapshot
+    list.optimize();
+    bool separate = list.getCommandCount() == 4 &&
+                    list.getCommands()[2].as<SetCustomShaderCommand>().uniformOffset == second;
+
+    list.reset();
+    bool cleared = list.getUniformDataSize() == 0 && list.getUniformData() == nullptr;
+
+    bool passed = updatedInPlace && stored && separate && cleared;
+    printTestResult("Uniform Snapshots", passed);
+}
+
+// ============================================================================
+// Test 37: Post-processing stacks
+// ============================================================================
+
+void testPostProcessCommand() {
+    int source = 0, destination = 0;
+
+    // Bloom into a fused pass that composites it and grades
+    PostProcessCommand post;
+    post.source = &source;
+    post.destination = &destination;
+    post.passCount = 2;
+    post.passes[0].type = PostProcessPassType::Bloom;
+    post.passes[0].params[0] = 1.0f;
+    post.passes[0].params[1] = 0.5f;
+    post.passes[0].levels = 5;
+    post.passes[1].type = PostProcessPassType::Fused;
+    post.passes[1].stageCount = 2;
+    post.stageCount = 2;
+    post.stages[0].op = PostProcessOp::Exposure;
+    post.stages[0].a = 2.0f;
+    post.stages[1].op = PostProcessOp::Tonemap;
+
+    // Invalid stacks are ignored
+    DrawList list;
+    PostProcessCommand invalid = post;
+    invalid.destination = &source;
+    list.addCommand(invalid);
+    invalid = post;
+    invalid.passCount = 0;
+    list.addCommand(invalid);
+    invalid = post;
+    invalid.passes[1].stageCount = 3;   // Past the stages
+    list.addCommand(invalid);
+    invalid = post;
+    invalid.passes[0].levels = PostProcessCommand::kMaxBloomLevels + 1;
+    list.addCommand(invalid);
+    invalid = post;
+    invalid.passes[1].type = PostProcessPassType::Blur;     // sigma 0
+    list.addCommand(invalid);
+    bool rejected = list.getCommandCount() == 0;
+
+    DrawCommand2D draw;
+    draw.vertexCount = 6;
+    list.addCommand(draw);
+    list.addCommand(post);
+    draw.vertexOffset = 6;
+    list.addCommand(draw);
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool structure = list.getCommandCount() == 3 &&
+                     commands[1].type == CommandType::PostProcess;
+    bool payload = structure &&
+                   commands[1].as<PostProcessCommand>().passes[0].levels == 5 &&
+                   commands[1].as<PostProcessCommand>().stages[1].op == PostProcessOp::Tonemap &&
+                   commandSize(CommandType::PostProcess) == sizeof(PostProcessCommand);
+
+    printTestResult("Post-Process Command", rejected && structure && payload);
+}
+
+// ============================================================================
+// Test 38: Order-independent transparency
+// ============================================================================
+
+void testOrderIndependentTransparency() {
+    auto draw = [](BlendMode blend, bool orderIndependent) {
+        DrawCommand3D cmd;
+        cmd.vertexCount = 3;
+        cmd.blendMode = blend;
+        cmd.depthTestEnabled = true;
+        cmd.depthWriteEnabled = !orderIndependent;
+        cmd.orderIndependent = orderIndependent;
+        return cmd;
+    };
+
+    // Sorted alpha draws are barriers; order-independent ones sort with the opaque draws
+    DrawList list;
+    list.addCommand(draw(BlendMode::Alpha, true));
+    list.addCommand(draw(BlendMode::Disabled, false));
+    list.addCommand(draw(BlendMode::Alpha, true));
+    list.addCommand(draw(BlendMode::Disabled, false));
+    size_t moved = list.reorderForState();
+    const auto& commands = list.getCommands();
+    bool sorted = moved > 0 &&
+                  !commands[0].as<DrawCommand3D>().orderIndependent &&
+                  !commands[1].as<DrawCommand3D>().orderIndependent &&
+                  commands[2].as<DrawCommand3D>().orderIndependent &&
+                  commands[3].as<DrawCommand3D>().orderIndependent;
+
+    DrawList barrier;
+    barrier.addCommand(draw(BlendMode::Alpha, false));
+    barrier.addCommand(draw(BlendMode::Disabled, false));
+    bool barrierKept = barrier.reorderForState() == 0;
+
+    // Only draws of the same kind merge
+    DrawList merged;
+    DrawCommand3D sorted3D = draw(BlendMode::Alpha, false);
+    sorted3D.depthWriteEnabled = true;
+    DrawCommand3D oit = draw(BlendMode::Alpha, true);
+    oit.depthWriteEnabled = true;
+    merged.addCommand(sorted3D);
+    oit.vertexOffset = 3;
+    merged.addCommand(oit);
+    oit.vertexOffset = 6;
+    merged.addCommand(oit);
+    merged.optimize();
+    bool batched = merged.getCommandCount() == 2 &&
+                   merged.getCommands()[1].as<DrawCommand3D>().vertexCount == 6;
+
+    printTestResult("Order-Independent Transparency", sorted && barrierKept && batched);
+}
+
+// ============================================================================
+// Test 39: Point cloud draws
+// ============================================================================
+
+void testPointCloudCommand() {
+    int points = 0, chunks = 0;
+
+    DrawPointCloudCommand cloud;
+    cloud.pointBuffer = &points;
+    cloud.chunkBuffer = &chunks;
+    cloud.firstPoint = 16384;
+    cloud.pointCount = 4096;
+    cloud.pointSize = 0.02f;
+    cloud.sizeAttenuation = true;
+
+    // Draws without buffers or points are ignored
+    DrawList list;
+    DrawPointCloudCommand invalid = cloud;
+    invalid.chunkBuffer = nullptr;
+    list.addCommand(invalid);
+    invalid = cloud;
+    invalid.pointCount = 0;
+    list.addCommand(invalid);
+    bool rejected = list.getCommandCount() == 0;
+
+    // Ranges of one cloud stay separate draws in submission order
+    list.addCommand(cloud);
+    cloud.firstPoint = 65536;
+    list.addCommand(cloud);
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool structure = list.getCommandCount() == 2 &&
+                     commands[0].type == CommandType::DrawPointCloud &&
+                     commands[0].as<DrawPointCloudCommand>().firstPoint == 16384 &&
+                     commands[1].as<DrawPointCloudCommand>().firstPoint == 65536;
+    bool payload = structure &&
+                   commands[1].as<DrawPointCloudCommand>().sizeAttenuation &&
+                   commands[1].as<DrawPointCloudCommand>().pointSize == 0.02f &&
+                   commandSize(CommandType::DrawPointCloud) == sizeof(DrawPointCloudCommand) &&
+                   sizeof(PointCloudPoint) == 10;
+
+    printTestResult("Point Cloud Command", rejected && structure && payload);
+}
+
+// ============================================================================
+// Test 40: YCoCg (HAP Q) video conversion
+// ============================================================================
+
+void testConvertYCoCgCommand() {
+    int color = 0, alpha = 0, destination = 0;
+    ConvertYCoCgCommand convert;
+    convert.color = &color;
+    convert.destination = &destination;
+
+    // Conversions without distinct color and destination, or sharing the
+    // alpha plane with either, are ignored
+    DrawList list;
+    ConvertYCoCgCommand invalid = convert;
+    invalid.color = nullptr;
+    list.addCommand(invalid);
+    invalid = convert;
+    invalid.destination = &color;
+    list.addCommand(invalid);
+    invalid = convert;
+    invalid.alpha = &destination;
+    list.addCommand(invalid);
+    bool rejected = list.getCommandCount() == 0;
+
+    // Opaque and alpha frames convert in order with the draws around them
+    DrawCommand2D draw;
+    draw.vertexCount = 6;
+    draw.texture = &destination;
+    list.addCommand(draw);
+    list.addCommand(convert);
+    convert.alpha = &alpha;
+    list.addCommand(convert);
+    draw.vertexOffset = 6;
+    list.addCommand(draw);
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool structure = list.getCommandCount() == 4 &&
+                     commands[0].type == CommandType::Draw2D &&
+                     commands[1].type == CommandType::ConvertYCoCg &&
+                     commands[2].type == CommandType::ConvertYCoCg &&
+                     commands[3].type == CommandType::Draw2D;
+    bool payload = structure &&
+                   commands[1].as<ConvertYCoCgCommand>().alpha == nullptr &&
+                   commands[2].as<ConvertYCoCgCommand>().alpha == &alpha &&
+                   commands[2].as<ConvertYCoCgCommand>().color == &color;
+
+    printTestResult("Convert YCoCg Command", rejected && structure && payload);
+}
+
+// ============================================================================
+// Test 41: Shape geometry in place and frame scratch memory
+// ============================================================================
+
+void testFrameScratch() {
+    // Both ranges of a shape are handed out together: when mapped storage
+    // can't take the indices, it spills before the vertices are written
+    DrawList list;
+    Vertex2D mapped2D[8];
+    Vertex3D mapped3D[4];
+    uint32_t mappedIndices[3];
+    DrawList::MappedStorage storage;
+    storage.vertices2D = mapped2D;
+    storage.capacity2D = 8;
+    storage.vertices3D = mapped3D;
+    storage.capacity3D = 4;
+    storage.indices = mappedIndices;
+    storage.capacityIndices = 3;
+    list.bindMappedStorage(storage);
+
+    auto fits = list.allocateGeometry2D(3, 3);
+    fits.vertices[2] = Vertex2D(1, 0, 0, 0, 1, 1, 1, 1);
+    fits.indices[2] = 2;
+    bool mapped = list.isMapped() && fits.vertices == mapped2D && fits.indices == mappedIndices;
+
+    auto spills = list.allocateGeometry2D(4, 6);
+    spills.vertices[3] = Vertex2D(5, 0, 0, 0, 1, 1, 1, 1);
+    spills.indices[5] = 3;
+    bool together = !list.isMapped() && spills.vertexOffset == 3 && spills.indexOffset == 3 &&
+                    list.getVertex2DData()[2].position.x == 1.0f &&
+                    list.getVertex2DData()[6].position.x == 5.0f &&
+                    list.getIndexData()[2] == 2 && list.getIndexData()[8] == 3;
+
+    auto solid = list.allocateGeometry3D(2, 0);
+    solid.vertices[1].position = simd_make_float3(0, 7, 0);
+    bool solid3D = solid.vertexOffset == 0 && solid.indices == nullptr && solid.indexOffset == 9 &&
+                   list.getVertex3DCount() == 2 && list.getVertex3DData()[1].position.y == 7.0f;
+
+    // Scratch ranges don't move as more is allocated, and reset() keeps
+    // the memory for the next frame in one block
+    float* first = list.allocateTransient<float>(4);
+    first[3] = 2.5f;
+    for (int i = 0; i < 64; i++) {
+        list.allocateTransient<simd_float2>(1024);
+    }
+    bool stable = first[3] == 2.5f && list.allocateTransient<float>(0) == nullptr &&
+                  list.getFrameArena().getUsedBytes() >= 64 * 1024 * sizeof(simd_float2);
+    const size_t capacity = list.getFrameArena().getCapacity();
+    list.reset();
+    for (int i = 0; i < 64; i++) {
+        list.allocateTransient<simd_float2>(1024);
+    }
+    bool reused = list.getFrameArena().getCapacity() == capacity;
+    list.reset();
+    bool released = list.getFrameArena().getUsedBytes() == 0;
+
+    printTestResult("Frame Scratch", mapped && together && solid3D && stable && reused && released);
+}
+
+// ============================================================================
+// Test 42: Object IDs for GPU picking
+// ============================================================================
+
+void testObjectIdBatching() {
+    DrawCommand3D defaults;
+    bool noObject = defaults.objectId == 0;
+
+    // Consecutive draws merge only under the same ID
+    DrawList list;
+    DrawCommand3D cmd;
+    cmd.vertexCount = 3;
+    cmd.objectId = 1;
+    list.addCommand(cmd);
+    cmd.vertexOffset = 3;
+    list.addCommand(cmd);
+    cmd.vertexOffset = 6;
+    cmd.objectId = 2;
+    list.addCommand(cmd);
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool split = list.getCommandCount() == 2 &&
+                 commands[0].as<DrawCommand3D>().vertexCount == 6 &&
+                 commands[0].as<DrawCommand3D>().objectId == 1 &&
+                 commands[1].as<DrawCommand3D>().objectId == 2;
+
+    // Instanced runs too
+    int buffer = 0;
+    DrawList instanced;
+    DrawCommand3DInstanced run;
+    run.vertexCount = 3;
+    run.instanceBuffer = &buffer;
+    run.instanceCount = 4;
+    run.objectId = 1;
+    instanced.addCommand(run);
+    run.instanceOffset = 4;
+    run.objectId = 2;
+    instanced.addCommand(run);
+    run.instanceOffset = 8;
+    instanced.addCommand(run);
+    instanced.optimize();
+    bool instancesSplit = instanced.getCommandCount() == 2 &&
+                          instanced.getCommands()[1].as<DrawCommand3DInstanced>().instanceCount == 8;
+
+    printTestResult("Object IDs", noObject && split && instancesSplit);
+}
+
+// ============================================================================
+// Test 43: Mesh-shader primitives
+// ============================================================================
+
+void testMeshPrimitivesCommand() {
+    // Lists generate primitives by default; the setting survives reset()
+    DrawList list;
+    bool defaultOn = list.isMeshPrimitivesEnabled();
+    list.setMeshPrimitives(false);
+    list.reset();
+    bool persists = !list.isMeshPrimitivesEnabled();
+    list.setMeshPrimitives(true);
+
+    // No instances, no command
+    DrawMeshPrimitivesCommand sphere;
+    sphere.primitive = MeshPrimitive::Sphere;
+    sphere.resolution = 20;
+    list.addCommand(sphere);
+    bool emptyIgnored = list.getCommandCount() == 0 &&
+                        commandSize(CommandType::DrawMeshPrimitives) == sizeof(DrawMeshPrimitivesCommand);
+
+    // Consecutive instances of one primitive merge; another resolution or
+    // primitive starts a new draw
+    sphere.instanceCount = 1;
+    for (uint32_t i = 0; i < 3; i++) {
+        sphere.instanceOffset = i;
+        list.addCommand(sphere);
+    }
+    sphere.instanceOffset = 3;
+    sphere.resolution = 32;
+    list.addCommand(sphere);
+    DrawMeshPrimitivesCommand cylinder = sphere;
+    cylinder.primitive = MeshPrimitive::Cylinder;
+    cylinder.instanceOffset = 4;
+    list.addCommand(cylinder);
+    list.optimize();
+    const auto& commands = list.getCommands();
+    bool merged = list.getCommandCount() == 3 &&
+                  commands[0].type == CommandType::DrawMeshPrimitives &&
+                  commands[0].as<DrawMeshPrimitivesCommand>().instanceCount == 3 &&
+                  commands[1].as<DrawMeshPrimitivesCommand>().resolution == 32 &&
+                  commands[2].as<DrawMeshPrimitivesCommand>().primitive == MeshPrimitive::Cylinder &&
+                  list.getBatchCount() == 2;
+
+    printTestResult("Mesh primitives", defaultOn && persists && emptyIgnored && merged);
+}
+
 int main() {
     std::cout << "\n=== DrawList Batching Optimization Tests (Phase 18.1) ===\n" << std::endl;
 
@@ -336,6 +2262,42 @@ int main() {
     testSortThenBatch();
     testEmptyList();
     testStateCommands();
+    testPackedCommandStream();
+    testMappedStorage();
+    testSamplerKeyBoundary();
+    testReorderForState();
+    testTransformBaking();
+    testInstancedBatching();
+    testIndirectAndCompute();
+    testPassCoalescing();
+    testTextureBatching();
+    testAtlasPacking();
+    testInstanceStream();
+    testShapeBatching();
+    testStrokeBatching();
+    testBulkAllocation();
+    testDisplayListCommand();
+    testVertexCompression();
+    testResidentGeometry();
+    testCulledDrawCount();
+    testShadowMapCommand();
+    testReadbackCommand();
+    testFilterTextureCommand();
+    testTextureCompression();
+    testGenerateMipmapsCommand();
+    testConvertYCbCrCommand();
+    testCopyTextureCommand();
+    testMultisampleTargets();
+    testTextBatching();
+    testPathBatching();
+    testUniformSnapshots();
+    testPostProcessCommand();
+    testOrderIndependentTransparency();
+    testPointCloudCommand();
+    testConvertYCoCgCommand();
+    testFrameScratch();
+    testObjectIdBatching();
+    testMeshPrimitivesCommand();
 
     std::cout << "\n=== All tests completed ===\n" << std::endl;
 